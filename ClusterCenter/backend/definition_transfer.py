@@ -0,0 +1,97 @@
+"""
+Definition Transfer - Flow / 任务定义的分块、可续传下发（NodeAgent DefinitionTransfer 的发送端）
+
+按内容 SHA-256 寻址：先发 begin，UAV 已缓存同一内容时回复 cached 并直接部署，不传输任何分块；
+否则回复 need 与缺少的分块序号，发送端只补发这些分块（断链重连后再次 begin 即可续传）。
+消息经 TCP 以 "XFER:" 前缀（建议使用长度前缀帧）或 MQTT {prefix}/{uav_id}/transfers 主题下发。
+"""
+
+import base64
+import hashlib
+import json
+from typing import Dict, List, Optional, Union
+
+DEFAULT_CHUNK_SIZE = 64 * 1024
+
+
+class DefinitionTransfer:
+    """单个定义的传输状态机：begin_message() 开始，handle_status() 处理 UAV 回复的 transfer_status"""
+
+    def __init__(self, kind: str, definition: Union[Dict, str, bytes],
+                 chunk_size: int = DEFAULT_CHUNK_SIZE, request_id: Optional[str] = None,
+                 max_restarts: int = 3):
+        if kind not in ("flow", "mission"):
+            raise ValueError(f"unknown definition kind: {kind}")
+        if isinstance(definition, dict):
+            definition = json.dumps(definition, separators=(",", ":"))
+        if isinstance(definition, str):
+            definition = definition.encode("utf-8")
+        self.kind = kind
+        self.content: bytes = definition
+        self.chunk_size = chunk_size
+        self.request_id = request_id
+        self.sha256 = hashlib.sha256(self.content).hexdigest()
+        self.chunk_count = (len(self.content) + chunk_size - 1) // chunk_size
+        self.max_restarts = max_restarts
+        self.restarts = 0
+        self.state = "pending"  # pending / sending / cached / complete / failed
+        self.error: Optional[str] = None
+
+    @property
+    def done(self) -> bool:
+        return self.state in ("cached", "complete", "failed")
+
+    def begin_message(self) -> Dict:
+        msg = {
+            "op": "begin",
+            "sha256": self.sha256,
+            "kind": self.kind,
+            "size": len(self.content),
+            "chunk_size": self.chunk_size,
+        }
+        if self.request_id:
+            msg["requestId"] = self.request_id
+        self.state = "sending"
+        return msg
+
+    def chunk_message(self, index: int) -> Dict:
+        data = self.content[index * self.chunk_size:(index + 1) * self.chunk_size]
+        return {
+            "op": "chunk",
+            "sha256": self.sha256,
+            "index": index,
+            "chunk_sha256": hashlib.sha256(data).hexdigest(),
+            "data": base64.b64encode(data).decode("ascii"),
+        }
+
+    def abort_message(self) -> Dict:
+        return {"op": "abort", "sha256": self.sha256}
+
+    def handle_status(self, status: Dict) -> List[Dict]:
+        """处理 transfer_status，返回接下来需要发送的消息"""
+        if status.get("sha256") != self.sha256 or self.done:
+            return []
+        state = status.get("state")
+        if state == "need":
+            # 单条 need 最多列出部分缺失分块，全部补发后 UAV 仍缺时再 begin 查询
+            missing = status.get("missing", [])
+            messages = [self.chunk_message(i) for i in missing if 0 <= i < self.chunk_count]
+            if len(missing) < status.get("chunks", 0) - status.get("received", 0):
+                messages.append(self.begin_message())
+            return messages
+        if state in ("cached", "complete"):
+            self.state = state
+            return []
+        if state == "failed":
+            self.error = status.get("error")
+            if self.restarts < self.max_restarts:
+                self.restarts += 1
+                return [self.begin_message()]
+            self.state = "failed"
+        return []
+
+    @staticmethod
+    def encode_tcp(message: Dict) -> bytes:
+        """TCP 下行：XFER: 消息封装为长度前缀帧（0xFC | u32 小端长度 | 消息）"""
+        body = b"XFER:" + json.dumps(message, separators=(",", ":")).encode("utf-8")
+        return bytes([0xFC]) + len(body).to_bytes(4, "little") + body
@@ -1140,6 +1140,14 @@ if LONG_TERM_FEATURES_AVAILABLE:
         await monitoring_system.record_metric(metric)
         return {"status": "ok"}
     
+    @app.post("/api/monitoring/rollups")
+    async def ingest_metrics_rollup(rollup: dict):
+        """接收 UAV 机载指标窗口汇总（NodeAgent "metrics_rollup" 消息）"""
+        if not monitoring_system:
+            raise HTTPException(status_code=503, detail="Monitoring system not available")
+        recorded = await monitoring_system.ingest_rollup(rollup)
+        return {"status": "ok", "recorded": recorded}
+    
     @app.post("/api/monitoring/alerts/rules")
     async def add_alert_rule(rule_data: dict):
         """添加告警规则"""
@@ -12,6 +12,7 @@ from enum import Enum
 from collections import deque
 import statistics
 import json
+import math
 
 logger = logging.getLogger(__name__)
 
@@ -99,6 +100,55 @@ class AlertRule:
     enabled: bool = True
 
 
+class RollupSketch:
+    """
+    DDSketch 桶（与 FalconMindSDK core::QuantileSketch 一致）：第 i 桶覆盖 (γ^(i-1), γ^i]，γ = (1+α)/(1-α)
+    同 α 的桶可直接相加，用于把各 UAV 上报的草图合并为全机群分位数
+    """
+
+    def __init__(self, alpha: float):
+        self.alpha = alpha
+        self.gamma = (1.0 + alpha) / (1.0 - alpha)
+        self.zero = 0
+        self.bins: Dict[int, int] = {}
+
+    @classmethod
+    def from_rollup(cls, alpha: float, encoded: List[int]) -> "RollupSketch":
+        """encoded 为汇总 "k" 中的 [零桶, minIndex, 桶...]"""
+        sketch = cls(alpha)
+        sketch.zero = int(encoded[0])
+        base = int(encoded[1])
+        for offset, count in enumerate(encoded[2:]):
+            if count:
+                sketch.bins[base + offset] = int(count)
+        return sketch
+
+    def count(self) -> int:
+        return self.zero + sum(self.bins.values())
+
+    def merge(self, other: "RollupSketch") -> bool:
+        if abs(other.alpha - self.alpha) > 1e-12:
+            return False
+        self.zero += other.zero
+        for index, count in other.bins.items():
+            self.bins[index] = self.bins.get(index, 0) + count
+        return True
+
+    def quantile(self, q: float) -> Optional[float]:
+        total = self.count()
+        if total == 0:
+            return None
+        rank = min(max(q, 0.0), 1.0) * (total - 1)
+        seen = self.zero
+        if seen > rank:
+            return 0.0
+        for index in sorted(self.bins):
+            seen += self.bins[index]
+            if seen > rank:
+                return 2.0 * self.gamma ** index / (self.gamma + 1.0)
+        return None
+
+
 class MetricsCollector:
     """指标收集器"""
     
@@ -391,10 +441,62 @@ class MonitoringSystem:
     def __init__(self):
         self.metrics_collector = MetricsCollector()
         self.alert_manager = AlertManager(self.metrics_collector)
+        # 摘要名 -> uav_id -> 该 UAV 最近一个窗口的草图（汇总附带 "k" 时）
+        self.fleet_sketches: Dict[str, Dict[str, RollupSketch]] = {}
     
     async def record_metric(self, metric: Metric):
         """记录指标"""
         await self.metrics_collector.record_metric(metric)
+
+    async def ingest_rollup(self, rollup: Dict) -> int:
+        """
+        接收 NodeAgent 上报的机载指标窗口汇总（"metrics_rollup" 消息，见 SDK core::toJson(MetricsRollup)）
+        计数器增量 / 仪表最新值 / 摘要分位数展开为带 uav_id 标签的指标，告警规则可直接引用；
+        摘要另记 <name>_count 与 <name>_max。返回记录的指标条数
+        """
+        uav_id = str(rollup.get("uavId", ""))
+        t1 = rollup.get("t1")
+        timestamp = datetime.utcfromtimestamp(t1 / 1e9) if t1 else None
+        labels = {"uav_id": uav_id}
+        metrics: List[Metric] = []
+
+        for name, delta in rollup.get("c", {}).items():
+            metrics.append(Metric(name, float(delta), dict(labels), timestamp, MetricType.COUNTER))
+        for name, (last, _low, _high) in rollup.get("g", {}).items():
+            metrics.append(Metric(name, float(last), dict(labels), timestamp, MetricType.GAUGE))
+        quantiles = rollup.get("q", [])
+        for name, values in rollup.get("s", {}).items():
+            count, _sum, _low, high = values[:4]
+            metrics.append(Metric(f"{name}_count", float(count), dict(labels), timestamp, MetricType.COUNTER))
+            metrics.append(Metric(f"{name}_max", float(high), dict(labels), timestamp, MetricType.SUMMARY))
+            for q, value in zip(quantiles, values[4:]):
+                metrics.append(Metric(name, float(value), {**labels, "quantile": str(q)}, timestamp, MetricType.SUMMARY))
+
+        alpha = rollup.get("a")
+        if alpha:
+            for name, encoded in rollup.get("k", {}).items():
+                self.fleet_sketches.setdefault(name, {})[uav_id] = RollupSketch.from_rollup(alpha, encoded)
+
+        for metric in metrics:
+            await self.metrics_collector.record_metric(metric)
+        return len(metrics)
+
+    def fleet_quantiles(self, name: str, quantiles: List[float] = (0.5, 0.9, 0.99)) -> Optional[Dict]:
+        """合并各 UAV 最近一个窗口的草图，得到全机群分位数（误差仍不超过 α）"""
+        per_uav = self.fleet_sketches.get(name)
+        if not per_uav:
+            return None
+        merged: Optional[RollupSketch] = None
+        for sketch in per_uav.values():
+            if merged is None:
+                merged = RollupSketch(sketch.alpha)
+            if not merged.merge(sketch):
+                logger.warning(f"Skipping sketch for {name} with mismatched accuracy")
+        return {
+            "uavs": len(per_uav),
+            "count": merged.count(),
+            "quantiles": {str(q): merged.quantile(q) for q in quantiles},
+        }
     
     def add_alert_rule(self, rule: AlertRule):
         """添加告警规则"""
@@ -423,8 +525,11 @@ class MonitoringSystem:
             stats = await self.metrics_collector.get_metric_statistics(metric_name)
             dashboard_metrics[metric_name] = stats
         
+        fleet = {name: self.fleet_quantiles(name) for name in self.fleet_sketches}
+
         return {
             "metrics": dashboard_metrics,
+            "fleet_quantiles": fleet,
             "active_alerts": [a.to_dict() for a in self.alert_manager.get_active_alerts()],
             "alert_statistics": self.alert_manager.get_statistics()
         }
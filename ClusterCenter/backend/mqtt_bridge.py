@@ -9,6 +9,8 @@ from typing import Dict, Callable, Optional
 from datetime import datetime
 import logging
 
+from telemetry_codec import SUPPORTED_ENCODINGS, TelemetryCodecError, TelemetryDeltaMerger, decode_payload, is_binary_frame
+
 try:
     import paho.mqtt.client as mqtt
     MQTT_AVAILABLE = True
@@ -44,6 +46,9 @@ class MqttBridge:
         self.telemetry_handler: Optional[Callable] = None
         self.mission_status_handler: Optional[Callable] = None
         self.event_handler: Optional[Callable] = None
+
+        # 二进制遥测（含增量帧）按 UAV 合入最近状态后再交给 telemetry_handler
+        self.telemetry_merger = TelemetryDeltaMerger()
     
     def connect(self) -> bool:
         """连接到 MQTT broker"""
@@ -93,10 +98,23 @@ class MqttBridge:
         self.client.subscribe(event_topic, qos=1)
         logger.info(f"Subscribed to: {event_topic}")
     
+    def _publish_capabilities(self):
+        """
+        发布保留（retained）的能力声明，NodeAgent 连接后读取以协商遥测编码
+        （支持 proto1 时改为发送 FalconMindSDK/proto/telemetry.proto 二进制帧）
+        """
+        if not self.client:
+            return
+        topic = f"{self.topic_prefix}/_bridge/capabilities"
+        payload = json.dumps({"telemetry_encodings": SUPPORTED_ENCODINGS})
+        self.client.publish(topic, payload, qos=1, retain=True)
+        logger.info(f"Published capabilities to {topic}: {SUPPORTED_ENCODINGS}")
+
     def _on_connect(self, client, userdata, flags, rc):
         """MQTT 连接回调"""
         if rc == 0:
             self.connected = True
+            self._publish_capabilities()
             logger.info("MQTT Bridge connected successfully")
         else:
             logger.error(f"MQTT Bridge connection failed with code {rc}")
@@ -110,7 +128,6 @@ class MqttBridge:
         """MQTT 消息回调"""
         try:
             topic = msg.topic
-            payload = msg.payload.decode('utf-8')
             
             # 解析主题：uav/{uavId}/{messageType}
             parts = topic.split('/')
@@ -121,11 +138,19 @@ class MqttBridge:
             uav_id = parts[1]
             message_type = parts[2]
             
-            # 解析 JSON payload
-            try:
-                data = json.loads(payload)
-            except json.JSONDecodeError as e:
-                logger.error(f"Failed to parse JSON payload: {e}")
+            # 解析 payload：二进制遥测帧（首字节 0xFB）或 JSON，按消息自动识别
+            if message_type == "telemetry" and is_binary_frame(msg.payload):
+                try:
+                    data = self.telemetry_merger.feed(msg.payload)
+                except TelemetryCodecError as e:
+                    logger.error(f"Failed to decode telemetry frame on {topic}: {e}")
+                    return
+                if data is None:
+                    return  # 尚未收到该 UAV 的关键帧
+            else:
+                data = decode_payload(msg.payload)
+            if data is None:
+                logger.error(f"Failed to decode payload on {topic}")
                 return
             
             # 根据消息类型分发
@@ -186,6 +211,24 @@ class MqttBridge:
             logger.error(f"Error publishing mission: {e}")
             return False
     
+    def publish_transfer(self, uav_id: str, message: Dict) -> bool:
+        """发布 Flow / 任务定义分块传输消息（见 definition_transfer.DefinitionTransfer）"""
+        if not self.client or not self.connected:
+            logger.error("MQTT client not connected")
+            return False
+
+        topic = f"{self.topic_prefix}/{uav_id}/transfers"
+        try:
+            result = self.client.publish(topic, json.dumps(message, separators=(",", ":")), qos=1)
+            if result.rc == mqtt.MQTT_ERR_SUCCESS:
+                logger.debug(f"Published transfer {message.get('op')} to {topic}")
+                return True
+            logger.error(f"Failed to publish transfer: {result.rc}")
+            return False
+        except Exception as e:
+            logger.error(f"Error publishing transfer: {e}")
+            return False
+
     def set_telemetry_handler(self, handler: Callable):
         """设置遥测消息处理器"""
         self.telemetry_handler = handler
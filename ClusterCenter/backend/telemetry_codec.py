@@ -0,0 +1,318 @@
+"""
+Telemetry Codec - NodeAgent 上行遥测二进制编解码
+字段表与 FalconMindSDK/proto/telemetry.proto 一致（protobuf 线格式，纯 Python 实现，不依赖 protobuf 包）
+
+链路帧：0xFB | version(1) | body 长度（u16 小端）| body
+解码结果与 NodeAgent JSON 遥测行的结构相同，上层处理器无需区分编码
+增量帧（proto1-delta）只携带 group_mask 选中的字段组，需经 TelemetryDeltaMerger 合入各 UAV 的最近状态
+"""
+
+import json
+import struct
+import time
+from typing import Dict, Optional, Tuple
+
+ENCODING_NAME = "proto1"
+DELTA_ENCODING_NAME = "proto1-delta"
+SUPPORTED_ENCODINGS = [DELTA_ENCODING_NAME, ENCODING_NAME, "json"]
+
+FRAME_MAGIC = 0xFB
+FRAME_VERSION = 1
+FRAME_HEADER_BYTES = 4
+
+_VARINT = 0
+_FIXED64 = 1
+_LENGTH_DELIMITED = 2
+_FIXED32 = 5
+
+# 字段编号 -> (平铺字段名, 线类型, 解码方式)
+_FIELDS = {
+    1: ("uav_id", _LENGTH_DELIMITED, "string"),
+    2: ("timestamp_ns", _FIXED64, "sfixed64"),
+    3: ("lat", _FIXED64, "double"),
+    4: ("lon", _FIXED64, "double"),
+    5: ("alt", _FIXED32, "float"),
+    6: ("roll", _FIXED32, "float"),
+    7: ("pitch", _FIXED32, "float"),
+    8: ("yaw", _FIXED32, "float"),
+    9: ("vx", _FIXED32, "float"),
+    10: ("vy", _FIXED32, "float"),
+    11: ("vz", _FIXED32, "float"),
+    12: ("battery_percent", _FIXED32, "float"),
+    13: ("battery_voltage_mv", _VARINT, "int32"),
+    14: ("gps_fix_type", _VARINT, "int32"),
+    15: ("num_sat", _VARINT, "int32"),
+    16: ("link_quality", _FIXED32, "float"),
+    17: ("flight_mode", _LENGTH_DELIMITED, "string"),
+}
+
+# 增量帧元数据字段（不属于遥测内容）
+_META_FIELDS = {
+    18: "group_mask",
+    19: "keyframe",
+    20: "seq",
+}
+
+# 字段组位 -> 平铺字段名（与 TelemetryFieldGroup 一致）
+TELEMETRY_GROUPS = {
+    0x01: ("lat", "lon", "alt"),
+    0x02: ("roll", "pitch", "yaw"),
+    0x04: ("vx", "vy", "vz"),
+    0x08: ("battery_percent", "battery_voltage_mv"),
+    0x10: ("gps_fix_type", "num_sat"),
+    0x20: ("link_quality",),
+    0x40: ("flight_mode",),
+}
+ALL_GROUPS = 0x7F
+
+
+class TelemetryCodecError(ValueError):
+    """帧格式错误"""
+
+
+def is_binary_frame(payload: bytes) -> bool:
+    """载荷是否为二进制遥测帧（JSON 总以 '{' 开头）"""
+    return len(payload) > 0 and payload[0] == FRAME_MAGIC
+
+
+def frame_length(data: bytes) -> int:
+    """
+    流中以 data 开头的完整帧长度：数据不足返回 0，帧头非法抛出 TelemetryCodecError
+    用于 TCP 流中与 JSON 行混合时的拆帧
+    """
+    if len(data) >= 1 and data[0] != FRAME_MAGIC:
+        raise TelemetryCodecError("bad frame magic")
+    if len(data) >= 2 and data[1] != FRAME_VERSION:
+        raise TelemetryCodecError(f"unsupported frame version {data[1]}")
+    if len(data) < FRAME_HEADER_BYTES:
+        return 0
+    total = FRAME_HEADER_BYTES + (data[2] | (data[3] << 8))
+    return total if len(data) >= total else 0
+
+
+def _read_varint(data: bytes, pos: int) -> Tuple[int, int]:
+    value = 0
+    shift = 0
+    while pos < len(data) and shift < 64:
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if not b & 0x80:
+            return value, pos
+        shift += 7
+    raise TelemetryCodecError("truncated varint")
+
+
+def _write_varint(value: int) -> bytes:
+    value &= (1 << 64) - 1
+    out = bytearray()
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+    return bytes(out)
+
+
+def decode_flat(frame: bytes) -> Dict:
+    """解码一帧为平铺字段字典（缺省字段取 proto3 默认值）"""
+    return decode_frame(frame)[0]
+
+
+def decode_frame(frame: bytes) -> Tuple[Dict, Dict]:
+    """
+    解码一帧，返回 (平铺字段, 帧信息)；帧信息为 {"delta", "groups", "keyframe", "seq"}
+    完整帧（无 group_mask）视为包含全部字段组的关键帧
+    """
+    if frame_length(frame) != len(frame) or len(frame) < FRAME_HEADER_BYTES:
+        raise TelemetryCodecError("incomplete frame")
+    meta: Dict = {}
+    fields: Dict = {}
+    for name, _, kind in _FIELDS.values():
+        fields[name] = "" if kind == "string" else (0.0 if kind in ("float", "double") else 0)
+
+    data = memoryview(frame)[FRAME_HEADER_BYTES:].tobytes()
+    pos = 0
+    while pos < len(data):
+        key, pos = _read_varint(data, pos)
+        field, wire = key >> 3, key & 0x7
+        if wire == _VARINT:
+            raw, pos = _read_varint(data, pos)
+        elif wire == _FIXED64:
+            if pos + 8 > len(data):
+                raise TelemetryCodecError("truncated fixed64")
+            raw = data[pos:pos + 8]
+            pos += 8
+        elif wire == _FIXED32:
+            if pos + 4 > len(data):
+                raise TelemetryCodecError("truncated fixed32")
+            raw = data[pos:pos + 4]
+            pos += 4
+        elif wire == _LENGTH_DELIMITED:
+            length, pos = _read_varint(data, pos)
+            if pos + length > len(data):
+                raise TelemetryCodecError("truncated bytes")
+            raw = data[pos:pos + length]
+            pos += length
+        else:
+            raise TelemetryCodecError(f"unsupported wire type {wire}")
+
+        if field in _META_FIELDS and wire == _VARINT:
+            meta[_META_FIELDS[field]] = raw
+            continue
+        spec = _FIELDS.get(field)
+        if spec is None or spec[1] != wire:
+            continue  # 未知字段：新版发送端追加的字段
+        name, _, kind = spec
+        if kind == "string":
+            fields[name] = raw.decode("utf-8", errors="replace")
+        elif kind == "double":
+            fields[name] = struct.unpack("<d", raw)[0]
+        elif kind == "float":
+            fields[name] = struct.unpack("<f", raw)[0]
+        elif kind == "sfixed64":
+            fields[name] = struct.unpack("<q", raw)[0]
+        elif kind == "int32":
+            raw &= 0xFFFFFFFF
+            fields[name] = raw - (1 << 32) if raw & 0x80000000 else raw
+
+    delta = "group_mask" in meta
+    info = {
+        "delta": delta,
+        "groups": (meta["group_mask"] & ALL_GROUPS) if delta else ALL_GROUPS,
+        "keyframe": bool(meta.get("keyframe", 0)) or not delta,
+        "seq": meta.get("seq", 0) & 0xFFFFFFFF,
+    }
+    return fields, info
+
+
+def _nest(f: Dict) -> Dict:
+    return {
+        "uav_id": f["uav_id"],
+        "timestamp_ns": f["timestamp_ns"],
+        "position": {"lat": f["lat"], "lon": f["lon"], "alt": f["alt"]},
+        "attitude": {"roll": f["roll"], "pitch": f["pitch"], "yaw": f["yaw"]},
+        "velocity": {"vx": f["vx"], "vy": f["vy"], "vz": f["vz"]},
+        "battery": {"percent": f["battery_percent"], "voltage_mv": f["battery_voltage_mv"]},
+        "gps": {"fix_type": f["gps_fix_type"], "num_sat": f["num_sat"]},
+        "link_quality": f["link_quality"],
+        "flight_mode": f["flight_mode"],
+    }
+
+
+def decode_telemetry(frame: bytes) -> Dict:
+    """解码一帧为与 NodeAgent JSON 遥测相同的嵌套结构（增量帧中未携带的字段组为默认值）"""
+    return _nest(decode_flat(frame))
+
+
+class TelemetryDeltaMerger:
+    """
+    按 uav_id 保存最近状态，把完整帧 / 增量帧还原为完整遥测
+    收到某 UAV 的首个关键帧之前，其增量帧无法还原，被丢弃（发送端按 keyframe 间隔重发关键帧）
+    """
+
+    def __init__(self):
+        self._states: Dict[str, Dict] = {}
+        self._last_seq: Dict[str, int] = {}
+        self.dropped = 0  # 缺少关键帧而丢弃的增量帧
+        self.gaps = 0     # 检测到的 seq 跳变（丢帧）次数
+
+    def feed(self, frame: bytes) -> Optional[Dict]:
+        """解码并合入一帧，返回嵌套结构的完整遥测；帧无法还原时返回 None，帧格式错误抛出 TelemetryCodecError"""
+        fields, info = decode_frame(frame)
+        uav_id = fields["uav_id"]
+        state = self._states.get(uav_id)
+        if info["keyframe"]:
+            state = dict(fields)
+            self._states[uav_id] = state
+        elif state is None:
+            self.dropped += 1
+            return None
+        else:
+            for bit, names in TELEMETRY_GROUPS.items():
+                if info["groups"] & bit:
+                    for name in names:
+                        state[name] = fields[name]
+            state["timestamp_ns"] = fields["timestamp_ns"]
+        if info["delta"]:
+            last = self._last_seq.get(uav_id)
+            if last is not None and info["seq"] != (last + 1) & 0xFFFFFFFF and not info["keyframe"]:
+                self.gaps += 1
+            self._last_seq[uav_id] = info["seq"]
+        return _nest(state)
+
+    def reset(self, uav_id: Optional[str] = None):
+        if uav_id is None:
+            self._states.clear()
+            self._last_seq.clear()
+        else:
+            self._states.pop(uav_id, None)
+            self._last_seq.pop(uav_id, None)
+
+
+def encode_telemetry(data: Dict) -> bytes:
+    """按嵌套 JSON 结构编码一帧（测试 / 回放工具使用；NodeAgent 端为 C++ 实现）"""
+    flat = {
+        "uav_id": data.get("uav_id", ""),
+        "timestamp_ns": data.get("timestamp_ns", 0),
+        "flight_mode": data.get("flight_mode", ""),
+        "link_quality": data.get("link_quality", 0.0),
+    }
+    for group, keys in (("position", ("lat", "lon", "alt")), ("attitude", ("roll", "pitch", "yaw")),
+                        ("velocity", ("vx", "vy", "vz"))):
+        for k in keys:
+            flat[k] = data.get(group, {}).get(k, 0.0)
+    flat["battery_percent"] = data.get("battery", {}).get("percent", 0.0)
+    flat["battery_voltage_mv"] = data.get("battery", {}).get("voltage_mv", 0)
+    flat["gps_fix_type"] = data.get("gps", {}).get("fix_type", 0)
+    flat["num_sat"] = data.get("gps", {}).get("num_sat", 0)
+
+    body = bytearray()
+    for field, (name, wire, kind) in sorted(_FIELDS.items()):
+        value = flat[name]
+        if not value:
+            continue  # proto3 默认值不编码
+        body += _write_varint((field << 3) | wire)
+        if kind == "string":
+            raw = value.encode("utf-8")
+            body += _write_varint(len(raw)) + raw
+        elif kind == "double":
+            body += struct.pack("<d", value)
+        elif kind == "float":
+            body += struct.pack("<f", value)
+        elif kind == "sfixed64":
+            body += struct.pack("<q", value)
+        else:
+            body += _write_varint(int(value))
+    if len(body) > 0xFFFF:
+        raise TelemetryCodecError("telemetry body too large")
+    return bytes([FRAME_MAGIC, FRAME_VERSION, len(body) & 0xFF, len(body) >> 8]) + bytes(body)
+
+
+def decode_payload(payload: bytes) -> Optional[Dict]:
+    """MQTT 载荷：二进制帧或 JSON；无法解析时返回 None"""
+    try:
+        if is_binary_frame(payload):
+            return decode_telemetry(payload)
+        return json.loads(payload.decode("utf-8"))
+    except (TelemetryCodecError, UnicodeDecodeError, json.JSONDecodeError):
+        return None
+
+
+def hello_reply(hello: Dict) -> str:
+    """
+    TCP 连接协商：根据 NodeAgent 的 {"type":"hello","telemetry_encodings":[...]} 选择编码，
+    返回应答行 HELLO:{"telemetry_encoding":...}\\n
+    """
+    offered = hello.get("telemetry_encodings", [])
+    encoding = next((e for e in SUPPORTED_ENCODINGS if e in offered), "json")
+    return "HELLO:" + json.dumps({"telemetry_encoding": encoding}, separators=(",", ":")) + "\n"
+
+
+def time_sync_reply(probe: Dict, received_ns: int, now_ns: Optional[int] = None) -> str:
+    """
+    时钟同步：NodeAgent 在 Control 通道发送 {"type":"time_sync","seq":N,"t1":...}，
+    received_ns 为读到该行的时刻（t2，尽量在解析前取得），返回下行应答行 ACK:tsync:<seq>:<t2>:<t3>\\n。
+    探测中的 offset_ns / rtt_ns / uplink_latency_ns / downlink_latency_ns 为 NodeAgent 当前的估计，可直接用于延迟看板
+    """
+    sent_ns = time.time_ns() if now_ns is None else now_ns
+    return "ACK:tsync:%d:%d:%d\n" % (int(probe["seq"]), received_ns, sent_ns)
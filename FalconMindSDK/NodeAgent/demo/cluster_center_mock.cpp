@@ -1,17 +1,25 @@
 // Cluster Center Mock - 简单的 TCP 服务器，接收 NodeAgent 上报的 Telemetry
 // 支持 ACK 响应机制
 // 支持将 Telemetry 转发到 Viewer 后端
+// 支持 hello 协商与 proto/telemetry.proto 二进制 Telemetry 帧（与 JSON 行混合），转发前还原为 JSON；
+// 增量帧（proto1-delta）按 uavId 合入最近状态，收到首个关键帧之前的增量帧被丢弃
 
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <string>
 #include <nlohmann/json.hpp>
 #include <thread>
 #include <atomic>
+#include <map>
+#include <fstream>
+#include <sstream>
+
+#include "falconmind/sdk/telemetry/TelemetryCodec.h"
 
 #ifndef NO_CURL
 #include <curl/curl.h>
@@ -25,6 +33,8 @@ void sendAckIfNeeded(int clientFd, const std::string& message) {
         payload = message.substr(4);
     } else if (message.find("MISSION:") == 0) {
         payload = message.substr(8);
+    } else if (message.find("FLOW:") == 0) {
+        payload = message.substr(5);
     } else {
         return;  // 不是下行消息
     }
@@ -57,6 +67,73 @@ void sendAckIfNeeded(int clientFd, const std::string& message) {
     }
 }
 
+// 以长度前缀帧发送下行消息（与 DownlinkClient 一致：0xFC | u32 小端长度 | 消息），载荷可含换行
+bool sendFramed(int clientFd, const std::string& message) {
+    const auto length = static_cast<std::uint32_t>(message.size());
+    std::string frame;
+    frame.reserve(5 + message.size());
+    frame.push_back(static_cast<char>(0xFC));
+    for (int i = 0; i < 4; ++i) {
+        frame.push_back(static_cast<char>((length >> (8 * i)) & 0xFF));
+    }
+    frame += message;
+    std::size_t offset = 0;
+    while (offset < frame.size()) {
+        ssize_t sent = send(clientFd, frame.data() + offset, frame.size() - offset, 0);
+        if (sent <= 0) {
+            return false;
+        }
+        offset += static_cast<std::size_t>(sent);
+    }
+    return true;
+}
+
+// 二进制帧还原为与 UplinkClient JSON 行相同结构的 JSON
+std::string telemetryToJson(const falconmind::sdk::telemetry::TelemetryMessage& msg) {
+    nlohmann::json json;
+    json["uav_id"] = msg.uavId;
+    json["timestamp_ns"] = msg.timestampNs;
+    json["position"] = {{"lat", msg.lat}, {"lon", msg.lon}, {"alt", msg.alt}};
+    json["attitude"] = {{"roll", msg.roll}, {"pitch", msg.pitch}, {"yaw", msg.yaw}};
+    json["velocity"] = {{"vx", msg.vx}, {"vy", msg.vy}, {"vz", msg.vz}};
+    json["battery"] = {{"percent", msg.batteryPercent}, {"voltage_mv", msg.batteryVoltageMv}};
+    json["gps"] = {{"fix_type", msg.gpsFixType}, {"num_sat", msg.numSat}};
+    json["link_quality"] = msg.linkQuality;
+    json["flight_mode"] = msg.flightMode;
+    return json.dump();
+}
+
+// 应答 NodeAgent 的 hello 行；返回 false 表示该行不是 hello
+bool replyHelloIfNeeded(int clientFd, const std::string& line, bool binaryEnabled) {
+    if (line.empty() || line[0] != '{') {
+        return false;
+    }
+    try {
+        auto json = nlohmann::json::parse(line);
+        if (json.value("type", std::string()) != "hello") {
+            return false;
+        }
+        std::string encoding = "json";
+        if (binaryEnabled && json.contains("telemetry_encodings") && json["telemetry_encodings"].is_array()) {
+            for (const auto& e : json["telemetry_encodings"]) {
+                if (!e.is_string()) continue;
+                const std::string name = e.get<std::string>();
+                if (name == falconmind::sdk::telemetry::kTelemetryDeltaEncoding) {
+                    encoding = name;
+                } else if (name == falconmind::sdk::telemetry::kTelemetryBinaryEncoding && encoding == "json") {
+                    encoding = name;
+                }
+            }
+        }
+        const std::string reply = "HELLO:" + nlohmann::json{{"telemetry_encoding", encoding}}.dump() + "\n";
+        send(clientFd, reply.c_str(), reply.length(), 0);
+        std::cout << "[cluster_center_mock] Negotiated telemetry encoding: " << encoding << std::endl;
+        return true;
+    } catch (const nlohmann::json::parse_error&) {
+        return false;
+    }
+}
+
 #ifndef NO_CURL
 // HTTP POST 回调函数（用于 libcurl）
 size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
@@ -111,6 +188,7 @@ int main(int argc, char* argv[]) {
     int port = 8888;
     std::string viewerUrl = "http://127.0.0.1:9000/ingress/telemetry";
     bool forwardToViewer = true;
+    bool binaryEnabled = true;  // 是否在 hello 协商中接受二进制 Telemetry
 
     if (argc >= 2) {
         port = std::stoi(argv[1]);
@@ -121,6 +199,9 @@ int main(int argc, char* argv[]) {
     if (argc >= 4) {
         forwardToViewer = (std::string(argv[3]) == "true" || std::string(argv[3]) == "1");
     }
+    if (argc >= 5) {
+        binaryEnabled = (std::string(argv[4]) == "true" || std::string(argv[4]) == "1");
+    }
 
 #ifndef NO_CURL
     // 初始化 libcurl
@@ -182,6 +263,7 @@ int main(int argc, char* argv[]) {
     // 使用 select 实现双向通信（接收 Telemetry + 发送命令）
     fd_set readFds;
     std::string messageBuffer;
+    std::map<std::string, falconmind::sdk::telemetry::TelemetryMessage> uavStates;  // 增量帧合入的各 UAV 最新遥测
     char buffer[4096];
     int telemetryCount = 0;
     bool ackEnabled = true;  // ACK 响应开关
@@ -220,17 +302,50 @@ int main(int argc, char* argv[]) {
             // 优化：使用二进制方式接收，避免 '\0' 截断问题
             messageBuffer.append(buffer, n);
 
-            // 处理完整的消息（以换行符分隔）
+            // 处理完整的消息：以 0xFB 开头的是二进制 Telemetry 帧，其余为换行分隔的 JSON 行
             // 优化：由于 JSON 现在是单行格式，可以简单地通过换行符识别完整消息
-            size_t pos;
-            while ((pos = messageBuffer.find('\n')) != std::string::npos) {
-                std::string message = messageBuffer.substr(0, pos);
-                messageBuffer.erase(0, pos + 1);
+            while (!messageBuffer.empty()) {
+                std::string message;
+                const auto* data = reinterpret_cast<const std::uint8_t*>(messageBuffer.data());
+                if (data[0] == falconmind::sdk::telemetry::kTelemetryFrameMagic) {
+                    const std::size_t frameLen = falconmind::sdk::telemetry::telemetryFrameLength(data, messageBuffer.size());
+                    if (frameLen == 0) {
+                        break;  // 帧未收完
+                    }
+                    falconmind::sdk::telemetry::TelemetryMessage decoded;
+                    falconmind::sdk::telemetry::TelemetryFrameInfo info;
+                    if (frameLen == SIZE_MAX ||
+                        !falconmind::sdk::telemetry::decodeTelemetryFrame(data, frameLen, decoded, &info)) {
+                        std::cerr << "[cluster_center_mock] Invalid binary telemetry frame, dropping buffer" << std::endl;
+                        messageBuffer.clear();
+                        break;
+                    }
+                    messageBuffer.erase(0, frameLen);
+                    auto it = uavStates.find(decoded.uavId);
+                    if (info.keyframe) {
+                        uavStates[decoded.uavId] = decoded;
+                    } else if (it == uavStates.end()) {
+                        continue;  // 尚未收到该 UAV 的关键帧，增量无法还原
+                    } else {
+                        falconmind::sdk::telemetry::mergeTelemetryGroups(decoded, info.groups, it->second);
+                    }
+                    message = telemetryToJson(uavStates[decoded.uavId]);
+                } else {
+                    size_t pos = messageBuffer.find('\n');
+                    if (pos == std::string::npos) {
+                        break;
+                    }
+                    message = messageBuffer.substr(0, pos);
+                    messageBuffer.erase(0, pos + 1);
+                }
 
                 // 跳过空消息和下行消息（CMD:/MISSION:）
                 if (message.empty() || message.find("CMD:") == 0 || message.find("MISSION:") == 0) {
                     continue;
                 }
+                if (replyHelloIfNeeded(clientFd, message, binaryEnabled)) {
+                    continue;
+                }
 
                 // 优化：按完整 JSON 消息打印（一次性打印整个 JSON）
                 // 可选：格式化 JSON 以便阅读（当前是单行压缩格式）
@@ -272,6 +387,28 @@ int main(int argc, char* argv[]) {
                 } else {
                     std::cerr << "[cluster_center_mock] Failed to send message" << std::endl;
                 }
+            } else if (input.find("sendfile ") == 0) {
+                // 文件内容为完整消息（如 FLOW:{...}），以长度前缀帧发送，适合大型 Flow / 任务
+                std::ifstream file(input.substr(9), std::ios::binary);
+                if (!file) {
+                    std::cerr << "[cluster_center_mock] Cannot open " << input.substr(9) << std::endl;
+                    continue;
+                }
+                std::ostringstream content;
+                content << file.rdbuf();
+                std::string message = content.str();
+                while (!message.empty() && (message.back() == '\n' || message.back() == '\r')) {
+                    message.pop_back();
+                }
+                if (sendFramed(clientFd, message)) {
+                    std::cout << "[cluster_center_mock] Sent framed downlink message (" << message.size()
+                              << " bytes)" << std::endl;
+                    if (ackEnabled) {
+                        sendAckIfNeeded(clientFd, message);
+                    }
+                } else {
+                    std::cerr << "[cluster_center_mock] Failed to send message" << std::endl;
+                }
             } else if (input == "ack") {
                 ackEnabled = true;
                 std::cout << "[cluster_center_mock] ACK responses enabled" << std::endl;
@@ -282,7 +419,7 @@ int main(int argc, char* argv[]) {
                 break;
             } else {
                 std::cout << "[cluster_center_mock] Unknown command. Use 'send CMD:<json>' or 'send MISSION:<json>'" << std::endl;
-                std::cout << "[cluster_center_mock] Commands: 'ack', 'noack', 'quit', 'exit'" << std::endl;
+                std::cout << "[cluster_center_mock] Commands: 'sendfile <path>', 'ack', 'noack', 'quit', 'exit'" << std::endl;
             }
         }
     }
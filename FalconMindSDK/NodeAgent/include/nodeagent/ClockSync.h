@@ -0,0 +1,100 @@
+// NodeAgent - NTP-style clock offset / RTT estimation against Cluster Center
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace nodeagent {
+
+struct ClockSyncConfig {
+    bool enabled{true};
+    int probeIntervalMs{5000};   // 稳定后的探测间隔
+    int burstProbes{4};          // 每次连接建立后连续发送的探测数（尽快得到首个估计）
+    int burstIntervalMs{250};
+    std::size_t windowSize{8};   // 参与时钟滤波的最近样本数（取其中 RTT 最小者的偏移）
+    int maxRttMs{3000};          // 超过时丢弃样本；未应答的探测在该时间后视为丢失
+    bool correctTimestamps{true};  // 已同步时把上行遥测时间戳与 JSON 消息的 center_ts_ns 换算为 Cluster Center 时钟
+};
+
+struct ClockSyncStats {
+    bool synced{false};
+    std::int64_t offsetNs{0};          // Cluster Center 时钟 - 本地时钟（system_clock）
+    std::int64_t rttNs{0};             // 被选样本的往返时延（网络部分，不含对端处理时间）
+    std::int64_t lastRttNs{0};
+    std::int64_t uplinkLatencyNs{0};   // 最近一次探测的单向时延：本节点 → Cluster Center
+    std::int64_t downlinkLatencyNs{0}; // 最近一次应答的单向时延：Cluster Center → 本节点
+    std::uint64_t probesSent{0};
+    std::uint64_t samples{0};          // 有效应答
+    std::uint64_t rejected{0};         // RTT 为负 / 超过 maxRttMs / 无对应探测的应答
+    std::uint64_t lost{0};             // 超时未应答的探测
+};
+
+/**
+ * ClockSync - 在现有链路上以 NTP 式四时间戳交换估计与 Cluster Center 的时钟偏移和 RTT
+ *
+ * 探测走上行 Control 通道：{"type":"time_sync","seq":N,"t1":<本地发送时刻>, ...}（同时带上当前估计，
+ * 供 Cluster Center 的延迟看板使用）；应答走下行 ACK 路径：ACK:tsync:<seq>:<t2>:<t3>，
+ * t2 / t3 为 Cluster Center 收到探测与发出应答的时刻（Unix 纳秒）。本地收到应答的时刻为 t4：
+ *   offset = ((t2 - t1) + (t3 - t4)) / 2，rtt = (t4 - t1) - (t3 - t2)
+ * t4 由 t1 加上单调时钟测得的间隔得到，交换期间本地 system_clock 被调整也不影响样本。
+ * 时钟滤波：排队、重传造成的非对称时延使偏移误差可达 rtt / 2，取最近 windowSize 个样本中 RTT 最小者的偏移。
+ * 单向时延以选定偏移计算最近一次交换的两个方向（上行 t2 - t1 - offset，下行 t4 - t3 + offset）。
+ * 线程安全：探测在更新线程生成，应答在下行接收线程处理
+ */
+class ClockSync {
+public:
+    static constexpr std::string_view kReplyPrefix{"tsync:"};  // ACK 消息 ID 的前缀
+
+    ClockSync();
+    explicit ClockSync(const ClockSyncConfig& config);
+
+    // 新连接建立：丢弃未应答的探测与滤波窗口（路径可能已变化），保留当前偏移直到新样本到达，并开始一轮连续探测
+    void restart(std::int64_t steadyNs);
+
+    // 是否到了发送下一个探测的时刻（同时把超时的探测计为丢失）
+    bool probeDue(std::int64_t steadyNs);
+    // 生成探测消息并登记为待应答
+    std::string makeProbe(std::int64_t systemNs, std::int64_t steadyNs);
+    // 处理 ACK 消息 ID；不是时钟同步应答时返回 false（交给普通 ACK 处理）
+    bool handleReply(std::string_view ackId, std::int64_t steadyNs);
+
+    bool synced() const;
+    // 本地 system_clock 时间戳换算为 Cluster Center 时钟；未同步时原样返回
+    std::int64_t toCenterTime(std::int64_t localNs) const;
+    ClockSyncStats stats() const;
+    const ClockSyncConfig& config() const noexcept { return config_; }
+
+private:
+    struct Pending {
+        std::uint32_t seq{0};
+        std::int64_t t1Ns{0};      // system_clock
+        std::int64_t t1SteadyNs{0};
+        bool active{false};
+    };
+    struct Sample {
+        std::int64_t offsetNs{0};
+        std::int64_t rttNs{0};
+    };
+    static constexpr std::size_t kMaxPending = 8;
+    static constexpr std::size_t kMaxWindow = 64;
+
+    void expirePendingLocked(std::int64_t steadyNs);
+    void selectLocked();
+
+    ClockSyncConfig config_;
+    mutable std::mutex mutex_;
+    std::array<Pending, kMaxPending> pending_{};
+    std::array<Sample, kMaxWindow> window_{};
+    std::size_t windowCount_{0};
+    std::size_t windowNext_{0};
+    std::uint32_t nextSeq_{1};
+    int burstRemaining_{0};
+    std::int64_t nextProbeSteadyNs_{0};
+    ClockSyncStats stats_;
+};
+
+} // namespace nodeagent
@@ -5,30 +5,96 @@
 #include "falconmind/sdk/flight/FlightTypes.h"
 #include "falconmind/sdk/flight/FlightConnectionService.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <vector>
 
 namespace nodeagent {
 
+// 幂等窗口：最近 capacity 个已执行的 requestId（只存 64 位哈希），超过 ttlNs 的记录视为过期。
+// 开放寻址（线性探测，删除时后移）+ FIFO 淘汰，表在构造时一次分配，查询与插入不分配内存。非线程安全
+class RequestIdWindow {
+public:
+    RequestIdWindow(std::size_t capacity, std::int64_t ttlNs);
+
+    // 窗口中有未过期的同一 requestId
+    bool contains(std::string_view requestId, std::int64_t nowNs) const;
+    // 记录一次执行；已存在时刷新时间
+    void insert(std::string_view requestId, std::int64_t nowNs);
+    std::size_t size() const noexcept { return count_; }
+    std::size_t capacity() const noexcept { return order_.size(); }
+
+private:
+    struct Slot {
+        std::uint64_t hash{0};  // 0 为空槽
+        std::int64_t insertedNs{0};
+    };
+
+    static std::uint64_t hashOf(std::string_view requestId) noexcept;
+    std::size_t find(std::uint64_t hash) const noexcept;  // 未找到返回 table_.size()
+    void erase(std::uint64_t hash) noexcept;
+
+    std::vector<Slot> table_;           // 2 的幂，不小于 2 × capacity
+    std::vector<std::uint64_t> order_;  // 插入顺序环形缓冲，满时淘汰最早的记录
+    std::size_t head_{0};
+    std::size_t count_{0};
+    std::int64_t ttlNs_;
+};
+
+struct CommandHandlerStats {
+    std::uint64_t received{0};
+    std::uint64_t executed{0};     // 已交给飞控链路
+    std::uint64_t duplicates{0};   // 幂等窗口命中，未重复执行
+    std::uint64_t parseErrors{0};
+    std::uint64_t failed{0};       // 未连接或发送失败
+    // 命令到 MAVLink 发出的时延（handleCommand 入口到 COMMAND_LONG 写出链路，微秒）
+    std::uint64_t lastLatencyUs{0};
+    std::uint64_t maxLatencyUs{0};
+    std::uint64_t totalLatencyUs{0};  // 除以 executed 得平均值
+};
+
 // 命令处理器：将下行 Command 消息转换为 SDK FlightCommand 并执行
+// 快速路径：SAX 只解析顶层 type / targetAlt / requestId 直接填入 FlightCommand（不构建 DOM），
+// 类型按表大小写不敏感匹配；在下行接收线程中直接编码并写出 COMMAND_LONG（FlightConnectionService 的发送
+// 对多线程安全，无需再经队列交给其它线程）。Cluster Center 重传或 MessageAckManager 重试同一 requestId 的命令时
+// 命中幂等窗口，不重复执行、视为已处理。载荷中没有 requestId 的命令不去重（信封中的 ID 为本地生成）。
+// 日志在发出之后输出，不计入时延。handleCommand 可由多个线程调用
 class CommandHandler {
 public:
+    struct Config {
+        std::size_t dedupCapacity{256};   // 幂等窗口容量
+        int dedupWindowMs{120000};        // 幂等窗口时长（不短于 Cluster Center 重传的总时长）
+    };
+
     CommandHandler();
+    explicit CommandHandler(const Config& config);
     ~CommandHandler();
 
     // 设置 FlightConnectionService（用于发送命令）
     void setFlightConnectionService(std::shared_ptr<falconmind::sdk::flight::FlightConnectionService> service);
 
     // 处理下行命令消息
-    // 返回：是否成功处理
+    // 返回：是否成功处理（重复的命令返回 true）
     bool handleCommand(const DownlinkMessage& msg);
 
-private:
-    // 解析 JSON payload 并转换为 FlightCommand
-    // 支持格式：{"type":"ARM","uavId":"uav0","targetAlt":10.0}
-    bool parseCommandJson(const std::string& jsonPayload, falconmind::sdk::flight::FlightCommand& cmd);
+    CommandHandlerStats stats() const;
 
+    // 解析命令载荷（仅顶层字段）；requestId 为空表示载荷中没有
+    // 支持格式：{"type":"ARM","uavId":"uav0","targetAlt":10.0,"requestId":"..."}
+    static bool parseCommand(std::string_view jsonPayload, falconmind::sdk::flight::FlightCommand& cmd,
+                             std::string& requestId);
+
+private:
+    Config config_;
     std::shared_ptr<falconmind::sdk::flight::FlightConnectionService> flightService_;
+
+    mutable std::mutex mutex_;  // 保护以下成员；发送期间持有，使同一 requestId 的并发重试只执行一次
+    RequestIdWindow executed_;
+    CommandHandlerStats stats_;
 };
 
 } // namespace nodeagent
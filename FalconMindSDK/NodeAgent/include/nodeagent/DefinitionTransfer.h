@@ -0,0 +1,125 @@
+// NodeAgent - Chunked, resumable transfer and content-addressed cache for flow/mission definitions
+#pragma once
+
+#include "nodeagent/DownlinkClient.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace nodeagent {
+
+enum class DefinitionKind : std::uint8_t {
+    Flow,
+    Mission,
+};
+
+const char* definitionKindName(DefinitionKind kind) noexcept;
+
+struct DefinitionTransferConfig {
+    std::string directory;                   // 缓存目录（objects/ 与 partial/）；为空时不启用
+    std::size_t maxObjectBytes{16u << 20};   // 单个定义的大小上限
+    std::size_t maxChunkBytes{256u << 10};   // 单个分块（解码后）的大小上限
+    std::size_t maxCacheBytes{64u << 20};    // objects/ 总大小上限，超过时按最近使用时间淘汰
+};
+
+struct DefinitionTransferStats {
+    std::uint64_t begins{0};          // 收到的 begin
+    std::uint64_t cacheHits{0};       // begin 命中内容缓存，未传输分块
+    std::uint64_t resumed{0};         // begin 从已有的部分传输继续
+    std::uint64_t chunksReceived{0};  // 校验通过并写入的分块
+    std::uint64_t chunksRejected{0};  // 长度 / 哈希 / 编码错误被拒绝的分块
+    std::uint64_t completed{0};       // 整体哈希校验通过并入库
+    std::uint64_t failed{0};          // 整体哈希不符等导致放弃的传输
+    std::uint64_t evicted{0};         // 因容量淘汰的缓存对象
+};
+
+// 上报给 Cluster Center 的传输状态
+struct DefinitionTransferStatus {
+    std::string sha256;
+    DefinitionKind kind{DefinitionKind::Flow};
+    std::string state;                   // need / cached / complete / failed
+    std::vector<std::uint32_t> missing;  // state == need 时仍缺少的分块序号
+    std::uint32_t received{0};
+    std::uint32_t chunks{0};
+    bool deployed{false};                // cached / complete 时是否已交给 Flow / 任务处理器
+    std::string requestId;
+    std::string error;
+};
+
+/**
+ * DefinitionTransfer
+ *
+ * 下行的 XFER 消息（TCP "XFER:" 前缀，MQTT ".../transfers" 主题）按内容 SHA-256 分块传输 Flow / 任务定义：
+ *   {"op":"begin","sha256":..,"kind":"flow"|"mission","size":N,"chunk_size":C,"requestId":..}
+ *   {"op":"chunk","sha256":..,"index":i,"chunk_sha256":..,"data":"<base64>"}
+ *   {"op":"abort","sha256":..}
+ * begin 时若 objects/<sha256> 已存在则直接部署并回复 cached（重复下发同一定义只是一次哈希检查）；
+ * 否则回复 need 与缺少的分块。分块写入 partial/<sha256>.part 的对应偏移，并在 .map 中记录已收到，
+ * 断链或进程重启后再次 begin 即从已收到的部分继续。全部收齐后校验整体哈希，入库并部署，回复 complete。
+ * 线程安全（内部互斥锁；部署回调在锁外调用）。
+ */
+class DefinitionTransfer {
+public:
+    // 部署已入库的定义；content 为完整定义（与 FLOW: / MISSION: 载荷相同）
+    using DeployFn = std::function<bool(DefinitionKind kind, const std::string& sha256, std::string content,
+                                        const DownlinkMessage& request)>;
+    using StatusFn = std::function<void(const DefinitionTransferStatus& status)>;
+
+    // 打开（必要时创建）缓存目录；目录不可用时返回 nullptr
+    static std::unique_ptr<DefinitionTransfer> open(const DefinitionTransferConfig& config);
+    ~DefinitionTransfer();
+
+    DefinitionTransfer(const DefinitionTransfer&) = delete;
+    DefinitionTransfer& operator=(const DefinitionTransfer&) = delete;
+
+    void setDeployCallback(DeployFn callback);
+    void setStatusCallback(StatusFn callback);
+
+    // 处理一条 XFER 消息；格式错误时返回 false
+    bool handleMessage(const DownlinkMessage& msg);
+
+    bool hasObject(const std::string& sha256) const;
+    bool loadObject(const std::string& sha256, std::string& content) const;
+
+    DefinitionTransferStats stats() const;
+    const DefinitionTransferConfig& config() const noexcept { return config_; }
+
+private:
+    struct Partial;
+    struct Request;
+
+    explicit DefinitionTransfer(const DefinitionTransferConfig& config);
+
+    bool handleBegin(const DownlinkMessage& msg, const Request& request);
+    bool handleChunk(const DownlinkMessage& msg, const Request& request);
+    void handleAbort(const Request& request);
+
+    // 以下要求持有 mutex_
+    Partial* findPartial(const std::string& sha256);
+    Partial* openPartial(const std::string& sha256, DefinitionKind kind, std::size_t size, std::size_t chunkSize);
+    void discardPartial(const std::string& sha256);
+    bool commitPartial(const std::string& sha256, Partial& partial, std::string& content, std::string& error);
+    void evictObjects(const std::string& keep);
+    void fillStatus(const Partial& partial, DefinitionTransferStatus& status) const;
+
+    void deployAndReport(DefinitionTransferStatus status, std::string content, const DownlinkMessage& request);
+    void report(const DefinitionTransferStatus& status);
+
+    std::string objectPath(const std::string& sha256) const;
+    std::string partialPath(const std::string& sha256, const char* suffix) const;
+
+    DefinitionTransferConfig config_;
+    DeployFn deployCallback_;
+    StatusFn statusCallback_;
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<Partial>> partials_;
+    DefinitionTransferStats stats_;
+};
+
+} // namespace nodeagent
@@ -4,18 +4,32 @@
 #include "nodeagent/IDownlinkClient.h"
 
 #include <string>
+#include <string_view>
 #include <functional>
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
 
 namespace nodeagent {
 
+class PayloadCodec;
+
 // 下行消息类型
 enum class DownlinkMessageType {
     Command,    // 单机命令（ARM/DISARM/TAKEOFF/LAND/RTL 等）
     Mission,    // 任务载荷（MissionPayload）
-    Flow        // Flow定义（用于零代码动态执行）
+    Flow,       // Flow定义（用于零代码动态执行）
+    Transfer    // Flow / 任务定义的分块传输（DefinitionTransfer）
+};
+
+// 下行消息优先级
+enum class DownlinkPriority {
+    Normal,
+    Urgent,  // RTL / LAND / DISARM / ABORT 命令，或命令带 "priority":"urgent"：同一批到达时先于任务等载荷分发
 };
 
 // 下行消息结构（简化版，后续可扩展为完整 Proto）
@@ -24,10 +38,24 @@ struct DownlinkMessage {
     std::string uavId;
     std::string payload;  // JSON 格式的命令/任务数据
     std::string requestId;  // 请求 ID，用于回执关联
+    std::string contentHash;  // 经分块传输入库的定义：内容 SHA-256（十六进制），直接下发时为空
+    DownlinkPriority priority{DownlinkPriority::Normal};
 };
 
+// 长度前缀帧：magic | u32 小端长度 | 消息（与文本行相同的 "CMD:" / "MISSION:" / "FLOW:" / "XFER:" / "ACK:" 前缀，不带换行）。
+// magic 不会出现在文本行首，两种分帧可在同一连接中混用；载荷可包含换行，适合大型任务 / Flow。
+// 长度最高位为 compressed 标志：载荷是 zstd 帧（PayloadCodec），解开后为同样带前缀的消息；上行压缩帧格式相同
+constexpr std::uint8_t kDownlinkFrameMagic = 0xFC;
+constexpr std::size_t kDownlinkFrameHeaderBytes = 5;
+constexpr std::uint32_t kFrameCompressedFlag = 0x80000000u;
+
 // 下行客户端：从 Cluster Center 接收命令/任务
 // 当前使用简单的 TCP 双向通信，后续可升级为 gRPC/MQTT
+// 接收缓冲按偏移消费：数据直接 recv 到缓冲尾部，换行只扫描新到达的部分，消息以 string_view 原地解析，
+// 仅在缓冲需要空间时整体前移未消费的数据，一次突发的多条消息或数百 KB 的单条消息都是线性开销
+// 一次读取中的完整消息先收集再分发：紧急命令（及排在它之前的命令，命令之间保持原顺序）先于同批的
+// 任务 / Flow / 传输载荷分发，RTL 不必等待前面的大型任务解析部署完成。
+// 尚未收全的大帧仍会挡住其后的消息（TCP 字节流的队头阻塞），需对端把大载荷分块（XFER）下发
 class DownlinkClient : public IDownlinkClient {
 public:
     // 使用基类的 MessageHandler 和 AckHandler 类型
@@ -37,6 +65,7 @@ public:
     struct Config {
         std::string centerAddress{"127.0.0.1"};
         int centerPort{8888};
+        std::size_t maxMessageBytes{4u << 20};  // 单条消息上限；超过时视为协议错误并断开
     };
 
     DownlinkClient(const Config& config);
@@ -54,6 +83,17 @@ public:
     // TCP 专用：获取 socket fd（用于复用连接）
     int getSocketFd() const { return socketFd_; }
 
+    // 事件循环模式（不调用 startReceiving）：socket 可读时由 EventLoop 调用，
+    // 读取一次并分发其中完整的消息；返回 false 表示对端关闭或读取出错
+    bool readAvailable();
+
+    // 交给解析器一段按序到达的字节（不经 socket，如 QUIC 下行流），分发其中完整的消息；
+    // 消息超过 maxMessageBytes 或帧头非法时清空缓冲并返回 false
+    bool feed(const void* data, std::size_t size);
+
+    // 解开压缩帧所用的字典（与 UplinkClient 共用同一个 PayloadCodec）；未设置时压缩帧被丢弃并记录日志
+    void setPayloadCodec(std::shared_ptr<PayloadCodec> codec) { codec_ = std::move(codec); }
+
 private:
     Config config_;
     bool connected_{false};
@@ -61,9 +101,27 @@ private:
     std::atomic<bool> receiving_{false};
     std::thread receiveThread_;
 
+    // 接收缓冲：[rxHead_, rxTail_) 为未消费的数据，[rxHead_, rxScan_) 已确认不含换行
+    std::vector<char> rxBuffer_;
+    std::size_t rxHead_{0};
+    std::size_t rxTail_{0};
+    std::size_t rxScan_{0};
+    std::vector<std::string_view> rxBatch_;   // 本次读取中完整的消息（指向 rxBuffer_，分发完成前缓冲不移动）
+    std::vector<std::uint8_t> rxBatchClass_;  // 与 rxBatch_ 对应：0 其它 / 1 命令 / 2 紧急命令
+    std::deque<std::string> rxInflated_;      // 本批中解压出的消息（rxBatch_ 指向其中，deque 追加不移动元素）
+    std::shared_ptr<PayloadCodec> codec_;
+
     void receiveLoop();
-    void parseAndHandleMessage(const std::string& jsonMessage);
-    void handleAckMessage(const std::string& ackMessage);
+    void resetBuffer();
+    // 保证缓冲尾部至少有 minFree 字节可写
+    void reserveTail(std::size_t minFree);
+    // 分发缓冲中所有完整的消息；消息超过 maxMessageBytes 或帧头非法时返回 false
+    bool processBuffered();
+    // 分发 rxBatch_：紧急命令及其之前的命令先分发，其余按到达顺序
+    void dispatchBatch();
+    void dispatchMessage(std::string_view message);
+    void parseAndHandleMessage(std::string_view message);
+    void handleAckMessage(std::string_view ackMessage);
 
     MessageHandler messageHandler_;
     AckHandler ackHandler_;
@@ -2,102 +2,90 @@
 #pragma once
 
 #include "nodeagent/ErrorCodes.h"
+#include "falconmind/sdk/core/SeqLock.h"
 
-#include <map>
-#include <mutex>
-#include <chrono>
+#include <array>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
 #include <string>
 
 namespace nodeagent {
 
-// 错误统计信息（简化版，用于返回，不包含 mutex）
+// 错误统计信息（快照）
 struct ErrorStatsSummary {
     int64_t count;
     int64_t lastOccurrence;
     std::string lastMessage;
 };
 
-// 错误统计信息（内部使用，包含 mutex）
-struct ErrorStats {
-    std::atomic<int64_t> count{0};  // 错误计数
-    std::atomic<int64_t> lastOccurrence{0};  // 最后发生时间（Unix 时间戳，秒）
-    std::string lastMessage;  // 最后一条错误消息
-    std::mutex messageMutex;  // 保护 lastMessage
-};
-
-// 错误统计管理器
+/**
+ * ErrorStatistics - 错误统计管理器
+ *
+ * 错误码按类别（高 4 位）与序号（低 12 位中的前 16 个）映射到定长数组的槽位，
+ * 超出范围的错误码计入 UnknownError。计数按线程分片（每个线程固定落在一个分片的
+ * 原子计数上，分片之间不共享缓存行），读取时对分片求和；recordError 全程无锁，
+ * 在重连风暴中大量线程同时出错也不会相互争用。
+ * 错误消息按采样保留：同一错误码每秒最多更新一次（首次总会保留），截断到 kMaxMessageBytes，
+ * 存放在顺序锁槽位中，读者无锁且不会读到撕裂的消息。
+ */
 class ErrorStatistics {
 public:
+    static constexpr std::size_t kMaxMessageBytes = 119;
+
     static ErrorStatistics& instance() {
         static ErrorStatistics stats;
         return stats;
     }
 
     // 记录错误
-    void recordError(ErrorCode code, const std::string& message = "") {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto& stats = errorStats_[code];
-        stats.count++;
-        stats.lastOccurrence = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
-        
-        if (!message.empty()) {
-            std::lock_guard<std::mutex> msgLock(stats.messageMutex);
-            stats.lastMessage = message;
-        }
-    }
+    void recordError(ErrorCode code, const std::string& message = "");
 
     // 获取错误统计
-    int64_t getErrorCount(ErrorCode code) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = errorStats_.find(code);
-        if (it != errorStats_.end()) {
-            return it->second.count.load();
-        }
-        return 0;
-    }
+    int64_t getErrorCount(ErrorCode code) const;
 
-    // 获取所有错误统计（返回简化版本，避免复制 mutex）
-    std::map<ErrorCode, ErrorStatsSummary> getAllStats() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        std::map<ErrorCode, ErrorStatsSummary> result;
-        for (const auto& [code, stats] : errorStats_) {
-            ErrorStatsSummary summary;
-            summary.count = stats.count.load();
-            summary.lastOccurrence = stats.lastOccurrence.load();
-            {
-                // 注意：const_cast 是安全的，因为我们只是读取 lastMessage
-                std::lock_guard<std::mutex> msgLock(
-                    const_cast<std::mutex&>(stats.messageMutex));
-                summary.lastMessage = stats.lastMessage;
-            }
-            result[code] = summary;
-        }
-        return result;
-    }
+    // 获取所有错误统计（仅包含计数非零的错误码）
+    std::map<ErrorCode, ErrorStatsSummary> getAllStats() const;
 
-    // 重置统计
-    void reset() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        errorStats_.clear();
-    }
+    // 重置统计（与并发的 recordError 之间不保证原子性）
+    void reset();
 
     // 获取总错误数
-    int64_t getTotalErrorCount() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        int64_t total = 0;
-        for (const auto& [code, stats] : errorStats_) {
-            total += stats.count.load();
-        }
-        return total;
-    }
+    int64_t getTotalErrorCount() const;
 
 private:
+    static constexpr std::size_t kCategories = 16;
+    static constexpr std::size_t kCodesPerCategory = 16;
+    static constexpr std::size_t kSlots = kCategories * kCodesPerCategory;
+    static constexpr std::size_t kShards = 8;
+    static constexpr int64_t kMessageSampleSec = 1;
+
+    struct MessageSample {
+        uint32_t length;
+        char text[kMaxMessageBytes + 1];
+    };
+
+    struct Slot {
+        std::atomic<int64_t> lastOccurrence{0};  // 最后发生时间（Unix 时间戳，秒）
+        std::atomic<int64_t> lastSampleSec{0};   // 最近一次保留消息的时间
+        std::atomic<bool> writing{false};        // 消息槽位的单写者标记
+        falconmind::sdk::core::SeqLock<MessageSample> message;
+    };
+
+    struct alignas(64) Shard {
+        std::array<std::atomic<int64_t>, kSlots> counts{};
+    };
+
     ErrorStatistics() = default;
-    mutable std::mutex mutex_;
-    std::map<ErrorCode, ErrorStats> errorStats_;
+
+    static std::size_t slotOf(ErrorCode code) noexcept;
+    static ErrorCode codeOf(std::size_t slot) noexcept;
+    static std::size_t shardOfThisThread() noexcept;
+    int64_t countOf(std::size_t slot) const noexcept;
+
+    std::array<Shard, kShards> shards_{};
+    std::array<Slot, kSlots> slots_{};
 };
 
 } // namespace nodeagent
@@ -0,0 +1,84 @@
+// NodeAgent - Single-threaded epoll reactor with timerfd timers
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace nodeagent {
+
+/**
+ * EventLoop
+ *
+ * epoll 事件循环：fd 可读 / 可写回调、timerfd 定时器、跨线程投递任务（eventfd 唤醒）。
+ * 回调全部在调用 run() / runOnce() 的线程中执行。线程安全的接口：post()、armTimer()、
+ * disarmTimer()、runSync()、stop()；其余（addFd / removeFd / addTimer / removeTimer）只能在循环线程中
+ * 或循环启动前调用（循环由多个 NodeAgent 共享时经 runSync 调用）。level-triggered：回调未读完的数据会在下一轮再次通知。
+ */
+class EventLoop {
+public:
+    using FdCallback = std::function<void(std::uint32_t events)>;  // events 为 EPOLLIN / EPOLLOUT / EPOLLHUP / EPOLLERR 组合
+    using TimerCallback = std::function<void()>;
+    using Task = std::function<void()>;
+
+    EventLoop();
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    bool valid() const noexcept { return epollFd_ >= 0 && wakeFd_ >= 0; }
+
+    bool addFd(int fd, std::uint32_t events, FdCallback callback);
+    bool modifyFd(int fd, std::uint32_t events);
+    void removeFd(int fd);
+
+    // 创建定时器（初始未启动），返回 id；失败返回 -1
+    int addTimer(TimerCallback callback);
+    // 启动 / 重新设置定时器：delayMs 后首次触发，intervalMs > 0 时之后周期触发；可在任意线程调用
+    bool armTimer(int timerId, int delayMs, int intervalMs = 0);
+    void disarmTimer(int timerId);
+    void removeTimer(int timerId);
+
+    // 投递任务到循环线程执行（任意线程）；队列由空变非空时写一次 eventfd
+    void post(Task task);
+    // 在循环线程中执行并等待完成；已在循环线程中或循环未运行时直接执行。
+    // 循环须在任务完成前保持运行（不要与 stop() 并发调用）
+    void runSync(const Task& task);
+
+    // 处理一轮就绪事件，timeoutMs < 0 表示一直等待；返回处理的事件数，出错返回 -1
+    int runOnce(int timeoutMs);
+    // 循环直到 stop()
+    void run();
+    void stop();
+
+    bool isInLoopThread() const noexcept { return loopThread_.load() == std::this_thread::get_id(); }
+    bool running() const noexcept { return running_.load(); }
+
+private:
+    struct Handler {
+        FdCallback callback;
+        bool timer{false};
+    };
+
+    void wake();
+    void runPosted();
+
+    int epollFd_{-1};
+    int wakeFd_{-1};
+    std::atomic<bool> stopped_{false};
+    std::atomic<bool> running_{false};  // run() 进行中
+    std::atomic<std::thread::id> loopThread_{};
+    // fd -> 回调；shared_ptr 使回调执行期间被 removeFd 也安全
+    std::unordered_map<int, std::shared_ptr<Handler>> handlers_;
+
+    std::mutex postMutex_;
+    std::vector<Task> posted_;
+};
+
+} // namespace nodeagent
@@ -9,6 +9,9 @@
 #include <memory>
 #include <functional>
 #include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
 
 namespace nodeagent {
 
@@ -18,6 +21,8 @@ using FlowStatusCallback = std::function<void(const std::string& flow_id,
                                                const std::string& error_msg)>;
 
 // Flow处理器：接收Flow定义，使用FlowExecutor执行，上报状态
+// 可同时运行多个 Flow（每个 Flow 一个 FlowExecutor）：各 Flow 开启资源共享，同一相机等设备只打开一次，
+// NPU/GPU 推理按 Flow 定义中的 priority 分配时间片
 class FlowHandler {
 public:
     FlowHandler();
@@ -29,35 +34,76 @@ public:
     // 设置状态上报回调（用于上报Flow执行状态到Cluster Center）
     void setStatusCallback(FlowStatusCallback callback);
 
+    // 执行计划缓存目录（空为关闭）：每次成功启动的 Flow 编译为二进制计划写入该目录，并记录为“上一次的 Flow”
+    void setPlanCacheDirectory(const std::string& directory);
+
+    // 快速启动：从计划缓存恢复上一次成功启动的 Flow 并启动（不上报状态，由调用方在连接后上报）
+    // 未设置缓存目录、无记录或计划失效时返回 false；记录中的内容哈希随之恢复，中心重复下发时不重启
+    bool resumeLastFlow();
+
     // 处理Flow定义消息（从Cluster Center接收）
     // 消息格式：{"type":"flow","flow_id":"flow_001","flow_definition":{...}}
     // 或：{"type":"flow","flow_id":"flow_001","builder_url":"http://...","project_id":"...","flow_id":"..."}
+    // msg.contentHash 与某个正在运行的 Flow 相同时不重新解析加载，只上报 RUNNING。
+    // 默认停止全部正在运行的 Flow 后启动新 Flow；消息含 "concurrent": true 时与其余 Flow 同时运行，
+    // 只替换 flow_id 相同的 Flow
     bool handleFlow(const DownlinkMessage& msg);
 
-    // 更新Flow执行（每帧调用）
+    // 更新Flow执行（每帧调用）：检查各 Flow 是否仍在运行，并上报看门狗事件
+    // （卡死 / 超出 SLO / 恢复动作为 DEGRADED，恢复健康为 RUNNING，error 字段为事件 JSON）
     void update();
 
-    // 停止当前Flow
+    // 停止全部正在运行的Flow
     void stopCurrentFlow();
 
-    // 获取当前Flow ID
-    std::string getCurrentFlowId() const { return current_flow_id_; }
+    // 停止指定Flow；未在运行返回 false
+    bool stopFlow(const std::string& flow_id);
+
+    // 获取当前Flow ID（最近启动的 Flow；它停止后为其余运行中的任一 Flow）
+    std::string getCurrentFlowId() const;
+
+    // 当前Flow的内容哈希（经分块传输部署时非空）
+    std::string getCurrentContentHash() const;
 
     // 检查是否有Flow正在运行
-    bool isFlowRunning() const { return executor_ && executor_->isRunning(); }
+    bool isFlowRunning() const;
+
+    // 正在运行的全部 Flow ID
+    std::vector<std::string> runningFlowIds() const;
 
 private:
-    // 从JSON消息解析Flow定义
-    bool parseFlowMessage(const std::string& json_payload, std::string& flow_id, std::string& flow_json);
+    struct RunningFlow {
+        std::shared_ptr<falconmind::sdk::core::FlowExecutor> executor;
+        std::string content_hash;
+    };
+
+    // 从JSON消息解析Flow定义（concurrent：是否与其余 Flow 同时运行）
+    bool parseFlowMessage(const std::string& json_payload, std::string& flow_id, std::string& flow_json,
+                          bool& concurrent);
+
+    // 为 flow_id 创建 FlowExecutor（计划缓存、资源共享、看门狗事件收集）
+    std::shared_ptr<falconmind::sdk::core::FlowExecutor> makeExecutor(const std::string& flow_id);
+    // 以下须持有 flow_mutex_
+    bool anyFlowRunning() const;
+    void stopFlowLocked(const std::string& flow_id);
+    void stopAllFlowsLocked();
 
     // 上报Flow状态
     void reportStatus(const std::string& flow_id, const std::string& status, const std::string& error_msg = "");
 
-    std::shared_ptr<falconmind::sdk::core::FlowExecutor> executor_;
+    // 在计划缓存目录中记录当前 Flow（flow_id / version / 内容哈希）；快速启动只恢复最近启动的 Flow
+    void saveLastFlowRecord();
+
+    std::map<std::string, RunningFlow> flows_;
     std::shared_ptr<falconmind::sdk::flight::FlightConnectionService> flight_service_;
     FlowStatusCallback status_callback_;
     std::string current_flow_id_;
-    std::atomic<bool> flow_active_{false};
+    std::string plan_cache_dir_;
+    // 快速启动恢复、下发的 Flow 与 update() 可能来自不同线程（连接期间已开始接收下行）
+    mutable std::mutex flow_mutex_;
+    // 看门狗线程产生的事件（flow_id, 事件），由 update() 在调用方线程上报
+    std::mutex watchdog_mutex_;
+    std::vector<std::pair<std::string, falconmind::sdk::core::WatchdogEvent>> watchdog_events_;
 };
 
 } // namespace nodeagent
@@ -3,10 +3,29 @@
 
 #include "falconmind/sdk/telemetry/TelemetryTypes.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace nodeagent {
 
+// 上行遥测编码
+enum class TelemetryEncoding {
+    Json,    // 单行 JSON（旧版 Cluster Center 唯一支持的格式）
+    Binary,  // proto/telemetry.proto 二进制帧，不协商（确知对端支持时使用）
+    BinaryDelta,  // 二进制增量帧（字段组掩码 + 变化值 + 周期关键帧），不协商
+    Auto,    // 每次连接时协商：按增量帧、二进制、JSON 的顺序选择对端支持的编码
+};
+
+// 上行消息优先级：决定共用一条连接时的发送顺序（UplinkClient 的分通道调度）
+enum class UplinkPriority : std::uint8_t {
+    Control = 0,    // 协商 / 命令回执等控制消息：严格优先，不等待写合并
+    Event = 1,      // Flow / 传输状态、障碍等事件
+    Telemetry = 2,  // 实时遥测
+    Bulk = 3,       // 断链缓存补发、日志等批量数据
+};
+constexpr std::size_t kUplinkPriorityCount = 4;
+
 // 上行客户端抽象接口
 class IUplinkClient {
 public:
@@ -26,6 +45,19 @@ public:
     
     // 发送通用消息（JSON字符串）
     virtual bool sendMessage(const std::string& message) = 0;
+
+    // 按优先级发送通用消息；不区分优先级的实现（如 MQTT）直接按 sendMessage 发送
+    virtual bool sendMessage(const std::string& message, UplinkPriority priority) {
+        (void)priority;
+        return sendMessage(message);
+    }
+
+    // 补发断链期间缓存的历史遥测：始终为完整 JSON（带 "replay": true），不经过增量编码，
+    // 对端据此只写入历史轨迹而不覆盖实时状态
+    virtual bool sendReplayedTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg) = 0;
+
+    // 当前连接实际使用的遥测编码（Auto 协商后的结果）
+    virtual TelemetryEncoding activeTelemetryEncoding() const { return TelemetryEncoding::Json; }
 };
 
 } // namespace nodeagent
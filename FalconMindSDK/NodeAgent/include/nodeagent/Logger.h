@@ -1,13 +1,11 @@
 // NodeAgent - Logging system with levels
 #pragma once
 
+#include "falconmind/sdk/core/Log.h"
+
+#include <atomic>
 #include <string>
-#include <iostream>
-#include <sstream>
-#include <mutex>
-#include <memory>
-#include <chrono>
-#include <iomanip>
+#include <utility>
 
 namespace nodeagent {
 
@@ -20,7 +18,8 @@ enum class LogLevel {
     FATAL = 4
 };
 
-// 日志系统（单例）
+// 日志系统（单例）：转发到 SDK 的异步日志（falconmind::sdk::core::AsyncLogger），
+// 与 SDK 节点共用级别和写线程。调用线程只复制组件名与消息入队，时间戳格式化与写出在后台完成
 class Logger {
 public:
     static Logger& instance() {
@@ -30,106 +29,82 @@ public:
 
     // 设置日志级别
     void setLevel(LogLevel level) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        level_ = level;
+        backend().setLevel(static_cast<falconmind::sdk::core::LogSeverity>(level));
     }
 
     LogLevel getLevel() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return level_;
+        return static_cast<LogLevel>(backend().level());
     }
 
     // 设置是否输出到控制台
     void setConsoleOutput(bool enable) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        consoleOutput_ = enable;
+        consoleOutput_.store(enable, std::memory_order_relaxed);
     }
 
-    // 日志输出
-    void log(LogLevel level, const std::string& component, const std::string& message) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        if (level < level_) {
-            return;  // 低于当前日志级别，不输出
-        }
+    // 该级别当前是否输出（LOG_* 宏据此跳过消息拼接）
+    bool enabled(LogLevel level) const {
+        return consoleOutput_.load(std::memory_order_relaxed) &&
+               backend().enabled(static_cast<falconmind::sdk::core::LogSeverity>(level));
+    }
 
-        if (!consoleOutput_) {
-            return;  // 控制台输出已禁用
+    // 日志输出
+    void log(LogLevel level, const std::string& component, std::string message) {
+        if (!enabled(level)) {
+            return;  // 低于当前日志级别或控制台输出已禁用
         }
-
-        // 获取当前时间
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()) % 1000;
-
-        // 格式化时间戳
-        std::tm tm_buf;
-#ifdef _WIN32
-        localtime_s(&tm_buf, &time);
-#else
-        localtime_r(&time, &tm_buf);
-#endif
-        
-        std::ostringstream oss;
-        oss << std::put_time(&tm_buf, "%Y-%m-%d %H:%M:%S");
-        oss << "." << std::setfill('0') << std::setw(3) << ms.count();
-
-        // 选择输出流
-        std::ostream& stream = (level >= LogLevel::ERROR) ? std::cerr : std::cout;
-
-        // 输出日志
-        stream << "[" << oss.str() << "] "
-               << "[" << levelToString(level) << "] "
-               << "[" << component << "] "
-               << message << std::endl;
+        backend().write(static_cast<falconmind::sdk::core::LogSeverity>(level), component, std::move(message));
     }
 
     // 便捷方法
-    void debug(const std::string& component, const std::string& message) {
-        log(LogLevel::DEBUG, component, message);
+    void debug(const std::string& component, std::string message) {
+        log(LogLevel::DEBUG, component, std::move(message));
+    }
+
+    void info(const std::string& component, std::string message) {
+        log(LogLevel::INFO, component, std::move(message));
     }
 
-    void info(const std::string& component, const std::string& message) {
-        log(LogLevel::INFO, component, message);
+    void warn(const std::string& component, std::string message) {
+        log(LogLevel::WARN, component, std::move(message));
     }
 
-    void warn(const std::string& component, const std::string& message) {
-        log(LogLevel::WARN, component, message);
+    void error(const std::string& component, std::string message) {
+        log(LogLevel::ERROR, component, std::move(message));
     }
 
-    void error(const std::string& component, const std::string& message) {
-        log(LogLevel::ERROR, component, message);
+    void fatal(const std::string& component, std::string message) {
+        log(LogLevel::FATAL, component, std::move(message));
     }
 
-    void fatal(const std::string& component, const std::string& message) {
-        log(LogLevel::FATAL, component, message);
+    // 等待已入队的日志写出
+    void flush() {
+        backend().flush();
     }
 
 private:
-    Logger() : level_(LogLevel::INFO), consoleOutput_(true) {}
-
-    static const char* levelToString(LogLevel level) {
-        switch (level) {
-            case LogLevel::DEBUG: return "DEBUG";
-            case LogLevel::INFO: return "INFO ";
-            case LogLevel::WARN: return "WARN ";
-            case LogLevel::ERROR: return "ERROR";
-            case LogLevel::FATAL: return "FATAL";
-            default: return "UNKNOWN";
-        }
+    Logger() = default;
+
+    static falconmind::sdk::core::AsyncLogger& backend() {
+        return falconmind::sdk::core::AsyncLogger::instance();
     }
 
-    LogLevel level_;
-    bool consoleOutput_;
-    mutable std::mutex mutex_;
+    std::atomic<bool> consoleOutput_{true};
 };
 
-// 便捷宏定义
-#define LOG_DEBUG(component, msg) nodeagent::Logger::instance().debug(component, msg)
-#define LOG_INFO(component, msg) nodeagent::Logger::instance().info(component, msg)
-#define LOG_WARN(component, msg) nodeagent::Logger::instance().warn(component, msg)
-#define LOG_ERROR(component, msg) nodeagent::Logger::instance().error(component, msg)
-#define LOG_FATAL(component, msg) nodeagent::Logger::instance().fatal(component, msg)
+// 便捷宏定义：级别未开启时不求值 msg（调用处的字符串拼接一并跳过）；
+// 低于 FALCONMIND_LOG_MIN_LEVEL 的级别在编译期移除
+#define NODEAGENT_LOG(level, component, msg)                                                    \
+    do {                                                                                        \
+        if constexpr (static_cast<int>(level) >= FALCONMIND_LOG_MIN_LEVEL) {                    \
+            auto& naLogger_ = nodeagent::Logger::instance();                                    \
+            if (naLogger_.enabled(level)) naLogger_.log(level, component, msg);                 \
+        }                                                                                       \
+    } while (0)
+
+#define LOG_DEBUG(component, msg) NODEAGENT_LOG(nodeagent::LogLevel::DEBUG, component, msg)
+#define LOG_INFO(component, msg) NODEAGENT_LOG(nodeagent::LogLevel::INFO, component, msg)
+#define LOG_WARN(component, msg) NODEAGENT_LOG(nodeagent::LogLevel::WARN, component, msg)
+#define LOG_ERROR(component, msg) NODEAGENT_LOG(nodeagent::LogLevel::ERROR, component, msg)
+#define LOG_FATAL(component, msg) NODEAGENT_LOG(nodeagent::LogLevel::FATAL, component, msg)
 
 } // namespace nodeagent
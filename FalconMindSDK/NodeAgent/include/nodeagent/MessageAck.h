@@ -2,13 +2,16 @@
 #pragma once
 
 #include "nodeagent/DownlinkClient.h"
+#include "falconmind/sdk/core/PipelineClock.h"
 
-#include <string>
-#include <map>
-#include <mutex>
+#include <array>
 #include <chrono>
-#include <atomic>
-#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace nodeagent {
 
@@ -19,20 +22,36 @@ enum class AckStatus {
     Timeout     // 超时
 };
 
-// 待确认消息记录
-struct PendingMessage {
-    DownlinkMessage message;
-    std::chrono::steady_clock::time_point sendTime;
-    int retryCount{0};
-    AckStatus status{AckStatus::Pending};
+struct MessageAckStats {
+    std::uint64_t registered{0};
+    std::uint64_t acknowledged{0};
+    std::uint64_t retries{0};
+    std::uint64_t timeouts{0};      // 超过最大重试次数后放弃
+    std::uint64_t unknownAcks{0};   // 确认了未跟踪（已确认 / 已超时 / 从未注册）的消息
+    std::uint64_t overflow{0};      // 待确认数达到 maxPending 时未被跟踪的消息
+    std::size_t pending{0};
 };
 
-// 消息确认管理器：跟踪下行消息的确认状态，支持超时重传
+/**
+ * MessageAckManager
+ *
+ * 消息确认管理器：跟踪下行消息的确认状态，支持超时重传。
+ * 待确认消息存放在容量固定（maxPending）的槽位数组中，按 messageId 的哈希经开放寻址表（线性探测，
+ * 删除时回移）定位槽位；超时由哈希时间轮驱动：每个槽位挂在其截止 tick 对应的桶链表中，
+ * update() 只访问自上次以来经过的桶，确认时 O(1) 摘链并立即回收槽位。
+ * 已确认 / 已超时消息的最终状态保留在一个小的环形缓冲中供 getMessageStatus 查询。
+ * 线程安全（下行线程注册 / 确认，主循环 update；重传回调在锁外调用）。
+ */
 class MessageAckManager {
 public:
+    // 超时计时随 PipelineClock：虚拟时钟下重传与超时按虚拟时刻触发
+    using Clock = falconmind::sdk::core::PipelineSteadyClock;
+
     struct Config {
         int maxRetries{3};  // 最大重试次数
         std::chrono::milliseconds timeoutMs{5000};  // 超时时间（毫秒）
+        std::chrono::milliseconds tickMs{50};  // 时间轮精度：超时最多晚一个 tick 触发
+        std::size_t maxPending{1024};  // 同时跟踪的待确认消息上限
     };
 
     explicit MessageAckManager(const Config& config);
@@ -47,23 +66,61 @@ public:
 
     // 更新：检查超时并重传
     void update();
+    void update(Clock::time_point now);
 
-    // 获取消息状态
+    // 获取消息状态（未跟踪且不在最近结果中的消息返回 Pending）
     AckStatus getMessageStatus(const std::string& messageId) const;
 
     // 设置重传回调（当需要重传时调用）
     using RetryCallback = std::function<void(const DownlinkMessage&)>;
     void setRetryCallback(RetryCallback callback);
 
+    MessageAckStats stats() const;
+
 private:
+    static constexpr std::uint32_t kNil = 0xFFFFFFFFu;
+    static constexpr std::size_t kWheelSlots = 512;
+    static constexpr std::size_t kRecentOutcomes = 256;
+
+    struct Entry {
+        DownlinkMessage message;
+        std::uint64_t hash{0};
+        std::int64_t deadlineTick{0};
+        int retryCount{0};
+        std::uint32_t prev{kNil};
+        std::uint32_t next{kNil};
+    };
+
+    struct Outcome {
+        std::uint64_t hash{0};
+        std::string messageId;
+        AckStatus status{AckStatus::Pending};
+    };
+
     Config config_;
-    std::map<std::string, PendingMessage> pendingMessages_;
     mutable std::mutex mutex_;
     RetryCallback retryCallback_;
-    std::atomic<int> messageIdCounter_{0};
+    std::uint64_t messageIdCounter_{0};
+
+    std::vector<Entry> entries_;           // 槽位，容量 maxPending
+    std::vector<std::uint32_t> freeSlots_;
+    std::vector<std::uint32_t> index_;     // 开放寻址表：槽位号 + 1，0 为空；容量为 2 的幂且 ≥ 2 × maxPending
+    std::array<std::uint32_t, kWheelSlots> wheel_{};  // 各桶链表头
+    Clock::time_point epoch_;
+    std::int64_t processedTick_{0};
+    std::array<Outcome, kRecentOutcomes> recent_{};
+    std::size_t recentNext_{0};
+    MessageAckStats stats_;
 
     std::string generateMessageId();
-    void checkTimeouts();
+    std::int64_t deadlineFor(Clock::time_point now) const;
+    std::int64_t tickOf(Clock::time_point now) const;
+    std::uint32_t find(const std::string& messageId, std::uint64_t hash) const;
+    void insertIndex(std::uint32_t slot);
+    void eraseIndex(std::uint32_t slot);
+    void link(std::uint32_t slot);
+    void unlink(std::uint32_t slot);
+    void release(std::uint32_t slot, AckStatus outcome);
 };
 
 } // namespace nodeagent
@@ -3,10 +3,17 @@
 
 #include "nodeagent/DownlinkClient.h"
 #include "falconmind/sdk/mission/BehaviorTree.h"
+#include "falconmind/sdk/mission/BehaviorTreeDefinition.h"
 #include "falconmind/sdk/flight/FlightConnectionService.h"
 
+#include <nlohmann/json_fwd.hpp>
+
+#include <atomic>
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
 
 namespace nodeagent {
 
@@ -23,17 +30,46 @@ public:
     // 返回：是否成功处理
     bool handleMission(const DownlinkMessage& msg);
 
-    // 更新任务执行（每帧调用）
+    // 回收已结束的任务线程（可每帧调用）；行为树本身在独立线程中事件驱动执行
     void update();
 
+    // 唤醒任务线程立即重新评估行为树（外部状态变化时调用）
+    void notify();
+    bool missionActive() const { return missionActive_.load(); }
+
+    // 设置任务黑板（行为树中的黑板条件节点从此读取）；未设置时含黑板条件的树实例化失败
+    void setBlackboard(falconmind::sdk::mission::MissionBlackboardPtr blackboard) { blackboard_ = std::move(blackboard); }
+
 private:
     // 解析 JSON payload 并创建行为树
-    // 支持格式：{"id":"mission1","task":"takeoff_and_hover","params":{...}}
+    // 支持格式：
+    // - 预置任务：{"id":"mission1","task":"takeoff_and_hover","params":{...}}
+    // - 通用行为树：{"id":"mission2","treeId":"patrol","tree":{"type":"sequence","children":[...]}}，
+    //   treeId 可选；带 treeId 编译过的树之后可只下发 {"treeId":"patrol"} 复用
     std::shared_ptr<falconmind::sdk::mission::BehaviorNode> parseMissionJson(const std::string& jsonPayload);
+    falconmind::sdk::mission::BehaviorTreeDefinitionPtr resolveTreeDefinition(const nlohmann::json& json);
+    falconmind::sdk::mission::BehaviorTreeDefinitionPtr legacyTaskDefinition(const nlohmann::json& json);
 
     std::shared_ptr<falconmind::sdk::flight::FlightConnectionService> flightService_;
+    // 停止并等待当前任务线程退出（调用方持有 lifecycleMutex_）
+    void stopMission();
+
+    // handleMission（下行线程）与 update（主循环）都会启停任务线程
+    std::mutex lifecycleMutex_;
     std::shared_ptr<falconmind::sdk::mission::BehaviorTreeExecutor> executor_;
-    bool missionActive_{false};
+    std::thread missionThread_;
+    std::atomic<bool> missionActive_{false};
+    std::atomic<bool> stopRequested_{false};
+
+    // 已编译的树定义（键为 treeId，未给出时为树 JSON 文本），同一定义可被多次任务直接实例化
+    struct CachedDefinition {
+        std::string source;
+        falconmind::sdk::mission::BehaviorTreeDefinitionPtr definition;
+    };
+    static constexpr std::size_t kMaxCachedDefinitions = 32;
+    std::mutex definitionMutex_;
+    std::unordered_map<std::string, CachedDefinition> treeDefinitions_;
+    falconmind::sdk::mission::MissionBlackboardPtr blackboard_;
 };
 
 } // namespace nodeagent
@@ -54,6 +54,7 @@ private:
     void onMessageReceived(const std::string& topic, const std::string& payload);
     std::string buildCommandTopic(const std::string& uavId);
     std::string buildMissionTopic(const std::string& uavId);
+    std::string buildTransferTopic(const std::string& uavId);
 };
 
 } // namespace nodeagent
@@ -2,9 +2,15 @@
 #pragma once
 
 #include "nodeagent/IUplinkClient.h"
+#include "nodeagent/TelemetryDeltaEncoder.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #ifdef NODEAGENT_MQTT_ENABLED
 #include <mqtt/async_client.h>
@@ -14,6 +20,22 @@
 namespace nodeagent {
 
 // MQTT 上行客户端：使用 MQTT 协议发送 Telemetry
+// 二进制编码时 uav/{uavId}/telemetry 的载荷为一个 proto/telemetry.proto 帧（首字节 0xFB，JSON 载荷以 '{' 开头）。
+// Auto 协商：连接后读取桥接端保留（retained）的 {topicPrefix}/_bridge/capabilities 消息，
+// 其 telemetry_encodings 含 "proto1-delta" / "proto1" 时使用增量 / 完整二进制帧，超时未收到则使用 JSON
+// 流水线发布（pipelined）：不逐条等待 delivery token，由完成回调维护在途计数；在途达到 maxInflight 时
+// 遥测直接丢弃（下一帧会覆盖），事件 / 补发消息等待窗口空出。每个 UAV 的遥测主题只构建一次，
+// MQTT 5 下 broker 允许时分配主题别名，首条消息建立别名后以空主题 + 别名发布
+struct MqttPublishStats {
+    std::uint64_t published{0};      // 已交给客户端库的消息
+    std::uint64_t completed{0};      // 完成回调成功（QoS 0 为已写出，QoS 1 为收到 PUBACK）
+    std::uint64_t failed{0};         // 发布异常或完成回调失败
+    std::uint64_t droppedFull{0};    // 在途窗口已满而丢弃的遥测
+    std::uint64_t aliasedPublishes{0};  // 以主题别名（空主题）发布的消息
+    int inflight{0};
+    int inflightPeak{0};
+};
+
 class MqttUplinkClient : public IUplinkClient {
 public:
     struct Config {
@@ -22,6 +44,18 @@ public:
         std::string clientId{"nodeagent"};
         std::string topicPrefix{"uav"};  // 主题前缀：uav/{uavId}/telemetry
         int qos{0};  // QoS 级别：0=最多一次，1=至少一次，2=恰好一次
+        TelemetryEncoding telemetryEncoding{TelemetryEncoding::Auto};
+        int negotiateTimeoutMs{500};  // Auto 模式等待 capabilities 保留消息的时间
+        TelemetryDeltaConfig delta;   // 增量帧策略（QoS 0 可能丢帧，关键帧间隔宜短）
+
+        bool pipelined{true};         // false 时每次发布等待完成（旧行为）
+        int maxInflight{64};          // 在途消息窗口（同时设置为连接的 max inflight）
+        int publishTimeoutMs{2000};   // 事件消息等待窗口空出的最长时间
+        bool mqttV5{true};            // MQTT 5：会话过期与主题别名
+        bool useTopicAliases{true};   // 仅在 broker 的 CONNACK 声明 Topic Alias Maximum > 0 时生效
+        bool persistentSession{false};  // 持久会话：clientId 需固定，重连后 broker 保留会话中的 QoS 1 消息
+        int sessionExpirySec{3600};   // MQTT 5 持久会话的过期时间
+        std::string persistenceDir;   // 非空时在途 QoS 1 消息写入该目录（进程重启后继续投递），否则仅在内存中
     };
 
     MqttUplinkClient(const Config& config);
@@ -32,17 +66,59 @@ public:
     void disconnect() override;
     bool isConnected() const override { return connected_; }
     bool sendTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg) override;
+    using IUplinkClient::sendMessage;
     bool sendMessage(const std::string& message) override;
+    bool sendReplayedTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg) override;
+    TelemetryEncoding activeTelemetryEncoding() const override { return activeEncoding_; }
+
+    MqttPublishStats publishStats() const;
 
 private:
     Config config_;
     bool connected_{false};
+    TelemetryEncoding activeEncoding_{TelemetryEncoding::Json};
+    TelemetryDeltaEncoder delta_;
+
+    // 在途窗口与统计（完成回调在客户端库线程中执行）
+    mutable std::mutex inflightMutex_;
+    std::condition_variable inflightCv_;
+    MqttPublishStats stats_;
+    int topicAliasMax_{0};  // 本次连接 broker 允许的主题别名数
+
 #ifdef NODEAGENT_MQTT_ENABLED
+    class PublishListener : public mqtt::iaction_listener {
+    public:
+        explicit PublishListener(MqttUplinkClient& owner) : owner_(owner) {}
+        void on_success(const mqtt::token&) override { owner_.onPublishDone(true); }
+        void on_failure(const mqtt::token&) override { owner_.onPublishDone(false); }
+
+    private:
+        MqttUplinkClient& owner_;
+    };
+
+    // 每个 UAV 的遥测主题：预先构建的共享主题字符串与别名状态
+    struct TopicState {
+        mqtt::string_ref topic;
+        int alias{0};              // 0 表示未分配
+        bool aliasEstablished{false};
+    };
+
+    PublishListener publishListener_{*this};  // 先于客户端声明：客户端析构时仍可能回调
     std::unique_ptr<mqtt::async_client> mqttClient_;
     mqtt::connect_options connectOptions_;
+    std::mutex topicMutex_;
+    std::unordered_map<std::string, TopicState> telemetryTopics_;
+    int nextAlias_{1};
+
+    TopicState& telemetryTopic(const std::string& uavId);
+    mqtt::message_ptr makeTelemetryMessage(const std::string& uavId, const void* data, std::size_t size);
+    // 发布一条消息：pipelined 时不等待完成；窗口已满时 dropWhenFull 的消息丢弃，其余等待最多 publishTimeoutMs
+    bool publish(mqtt::message_ptr msg, bool dropWhenFull);
+    void onPublishDone(bool ok);
+    TelemetryEncoding negotiateEncoding();
 #endif
 
-    std::string serializeTelemetryToJson(const falconmind::sdk::telemetry::TelemetryMessage& msg);
+    std::string serializeTelemetryToJson(const falconmind::sdk::telemetry::TelemetryMessage& msg, bool replay = false);
     std::string buildTopic(const std::string& uavId);
 };
 
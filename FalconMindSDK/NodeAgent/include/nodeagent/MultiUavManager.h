@@ -3,27 +3,55 @@
 
 #include "nodeagent/NodeAgent.h"
 #include "falconmind/sdk/flight/FlightConnectionService.h"
+#include "falconmind/sdk/flight/MavlinkRouter.h"
 
+#include <atomic>
 #include <string>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 namespace nodeagent {
 
-// 多 UAV 管理器：管理多个 UAV 的 NodeAgent 实例
+class EventLoop;
+
+/**
+ * MultiUavManager - 同进程托管多个 UAV 的 NodeAgent（集群仿真 / 压测）
+ *
+ * 所有 TCP 事件循环模式的 NodeAgent 按轮询分配到少量共享的 EventLoop 上（每个循环一个线程），
+ * 单个 UAV 只占用 socket 与定时器 fd，不再各自拥有循环线程；遥测订阅按 uavId 路由，
+ * 每条遥测只交给对应 UAV 的 NodeAgent。UAV 表的锁只保护增删查，启动 / 停止在锁外进行，
+ * startAll 用 startConcurrency 个线程并发连接与协商。
+ * 每架约占 5 个 fd（socket + 4 个 timerfd），托管数百架时需相应提高 RLIMIT_NOFILE。
+ */
 class MultiUavManager {
 public:
+    struct Config {
+        int ioThreads{0};  // 共享事件循环个数（每个一个线程）；≤ 0 表示 min(硬件线程数, 4)
+        int startConcurrency{0};  // startAll 并发启动的线程数；≤ 0 与 ioThreads 相同
+        // 各 UAV 的 NodeAgent 配置模板：uavId / centerAddress / centerPort 由 UavConfig 覆盖，
+        // routeTelemetryByUavId 总是开启
+        NodeAgent::Config agentDefaults;
+    };
+
     struct UavConfig {
         std::string uavId;
         std::string centerAddress{"127.0.0.1"};
         int centerPort{8888};
         std::shared_ptr<falconmind::sdk::flight::FlightConnectionService> flightService;
+        // 设置了共享路由器且未给出 flightService 时，按该 sysid 创建挂接到路由器的飞控服务（0 表示不创建）
+        std::uint8_t sysid{0};
     };
 
-    MultiUavManager();
+    MultiUavManager();  // 使用默认配置
+    explicit MultiUavManager(const Config& config);
     ~MultiUavManager();
 
+    // 集群共用的 MAVLink 路由器（一个 socket / 一个 I/O 线程服务所有飞机），需在 addUav 之前设置
+    void setRouter(std::shared_ptr<falconmind::sdk::flight::MavlinkRouter> router);
+
     // 添加 UAV
     bool addUav(const UavConfig& config);
 
@@ -48,15 +76,30 @@ public:
     // 检查 UAV 是否运行
     bool isUavRunning(const std::string& uavId) const;
 
+    // 共享事件循环个数
+    std::size_t ioThreadCount() const { return loops_.size(); }
+
 private:
     struct UavEntry {
         UavConfig config;
         std::unique_ptr<NodeAgent> agent;
-        bool running{false};
+        std::mutex lifecycleMutex;  // 串行化本 UAV 的 start / stop
+        std::atomic<bool> running{false};
     };
 
-    std::map<std::string, UavEntry> uavs_;
-    mutable std::mutex mutex_;
+    std::shared_ptr<UavEntry> find(const std::string& uavId) const;
+    std::vector<std::shared_ptr<UavEntry>> entries() const;
+    static bool startEntry(UavEntry& entry);
+    static void stopEntry(UavEntry& entry);
+
+    Config config_;
+    std::vector<std::shared_ptr<EventLoop>> loops_;
+    std::vector<std::thread> loopThreads_;
+    std::size_t nextLoop_{0};
+
+    std::map<std::string, std::shared_ptr<UavEntry>> uavs_;
+    std::shared_ptr<falconmind::sdk::flight::MavlinkRouter> router_;
+    mutable std::mutex mutex_;  // 保护 uavs_ / router_ / nextLoop_
 };
 
 } // namespace nodeagent
@@ -1,26 +1,43 @@
 // NodeAgent - Main agent class for SDK ↔ Cluster Center communication
 #pragma once
 
+#include "nodeagent/IUplinkClient.h"
+#include "nodeagent/ClockSync.h"
+#include "nodeagent/DefinitionTransfer.h"
+#include "nodeagent/PayloadCompression.h"
+#include "nodeagent/ReconnectManager.h"
+#include "nodeagent/SwarmLink.h"
+#include "nodeagent/TelemetryDeltaEncoder.h"
+#include "nodeagent/TelemetrySpool.h"
+#include "falconmind/sdk/telemetry/MetricsRollupPublisher.h"
+
 #include <string>
 #include <memory>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <thread>
 #include <functional>
+#include <vector>
 
 // 前向声明
 namespace falconmind::sdk::flight {
     class FlightConnectionService;
 }
+namespace falconmind::sdk::perception {
+    class PerceptionPluginManager;
+}
 
 namespace nodeagent {
 
-class IUplinkClient;
 class IDownlinkClient;
 class CommandHandler;
 class MissionHandler;
 class FlowHandler;
 class MessageAckManager;
-class ReconnectManager;
+class EventLoop;
 
 // 下行消息处理器类型
 struct DownlinkMessage;
@@ -31,7 +48,8 @@ class NodeAgent {
 public:
     enum class Protocol {
         TCP,   // TCP Socket + JSON
-        MQTT   // MQTT
+        MQTT,  // MQTT
+        QUIC   // QUIC（msquic）：按优先级分流、数据报遥测、0-RTT 恢复与连接迁移，适合丢包的电台链路
     };
 
     struct Config {
@@ -47,19 +65,75 @@ public:
         int mqttBrokerPort{1883};
         std::string mqttClientId{"nodeagent"};
         std::string mqttTopicPrefix{"uav"};  // 主题前缀：uav/{uavId}/telemetry
+
+        // QUIC 配置（服务端地址使用 centerAddress）
+        int quicPort{8889};
+        std::string quicServerName;       // TLS SNI / 证书校验名；空时使用 centerAddress
+        bool quicVerifyCertificate{true};
+        std::string quicCaFile;
+        std::string quicLocalAddress;     // 非空时从该本地地址（指定的调制解调器）发起连接
+        std::string quicTicketPath;       // 会话票据文件：进程重启后仍可 0-RTT 恢复
+        bool quicTelemetryOverDatagrams{true};  // 遥测以不可靠数据报发送（只保留最新状态）
         
         int telemetryIntervalMs{1000};  // Telemetry 上报间隔（毫秒）
+        // Telemetry 编码：Auto 时每次连接与 Cluster Center 协商，旧版对端回退 JSON
+        TelemetryEncoding telemetryEncoding{TelemetryEncoding::Auto};
+        // 协商为增量编码时各字段组的发送频率、关键帧间隔与链路自适应策略
+        TelemetryDeltaConfig telemetryDelta;
+        // 断链缓存：spool.directory 非空时启用，断链期间的事件 / 检测 / 抽样遥测写入磁盘，重连后限速补发
+        TelemetrySpoolConfig spool;
+        // Flow / 任务定义分块传输：definitionCache.directory 非空时启用 XFER 消息与按内容 SHA-256 寻址的定义缓存
+        DefinitionTransferConfig definitionCache;
+        // 时钟同步：经上行 Control 通道探测、下行 ACK 应答估计与 Cluster Center 的时钟偏移、RTT 与单向时延；
+        // 同步后上行遥测时间戳换算为 Cluster Center 时钟，JSON 消息附带 center_ts_ns
+        ClockSyncConfig clockSync;
+        // 机间链路：swarm.enabled 时经 UDP 组播 / mesh 单播与其它 UAV 直接交换位置、角色与目标认领，
+        // 写入 SDK SwarmStateRegistry（ClusterStateSourceNode members_source=swarm），不经 Cluster Center
+        SwarmLinkConfig swarm;
+        // 载荷压缩（TCP）：compression.enabled 时按连接与 Cluster Center 协商，JSON 上下行消息以按消息类型
+        // 预训练的 zstd 字典压缩（dictionaryDirectory），对端不支持时保持文本 JSON
+        PayloadCompressionConfig compression;
+        // 机载指标汇总：metricsRollup.windowMs > 0 时按窗口汇总 SDK MetricsAggregator::instance() 的计数器 / 仪表 /
+        // 分位数摘要，以紧凑的 "metrics_rollup" 消息上报（每窗口几百字节，断链时写入断链缓存）；0 关闭。
+        // 聚合器为进程内共享，同进程托管多个 UAV 时只在一个 NodeAgent 上开启
+        falconmind::sdk::telemetry::MetricsRollupConfig metricsRollup{0, {}};
+
+        // 快速启动：上电后不等 Cluster Center 下发，start() 中与连接并行地从计划缓存恢复上一次运行的 Flow
+        //（跳过 JSON 解析与参数校验），并在后台预加载 preloadDetectors（需 setPerceptionPluginManager）；
+        // 连接后中心重新下发相同内容的 Flow 时不重启。planCacheDirectory 同时作为 FlowHandler 的计划缓存目录
+        struct FastBoot {
+            bool enabled{false};
+            std::string planCacheDirectory;
+            std::vector<std::string> preloadDetectors;
+        } fastBoot;
+        // 启动时间线：非空时开启 SDK BootProfiler，首个 Flow 进入 RUNNING 时写出 Chrome trace JSON 到该路径
+        //（也可用环境变量 FALCONMIND_BOOT_TRACE）
+        std::string bootTracePath;
+
+        // TCP 协议：下行接收、遥测上报、写合并、定时更新与重连共用一个 epoll 事件循环线程；
+        // false 时使用各自独立的线程（接收线程、遥测分发线程、写合并线程、重连线程）
+        bool useEventLoop{true};
+        int updateIntervalMs{100};  // 任务 / Flow / 消息确认 / 断链补发的更新周期
+        // 只上报 uavId 与本节点相同的遥测（TelemetryPublisher 按 uavId 路由）；同进程托管多个 UAV 时开启，
+        // false 时上报进程内发布的全部遥测（单机部署中发布方的 uavId 可能与本节点配置不一致）
+        bool routeTelemetryByUavId{false};
         
         // 错误处理和重连配置
         bool enableAutoReconnect{true};  // 启用自动重连
         int maxReconnectRetries{5};  // 最大重连次数
-        int reconnectInitialDelayMs{1000};  // 初始重连延迟（毫秒）
+        int reconnectInitialDelayMs{250};  // 退避下限（毫秒）：各次等待在 [下限, 上一次 × 3] 内随机抖动，机群不会同时重连
+        bool reconnectFastRetry{true};  // 已建立的连接中断后先立即重试一次（瞬断亚秒内恢复）
+        double reconnectPoorLinkThreshold{0.2};  // 遥测 linkQuality 低于该值时视为电台衰落，只低频探测（≤ 0 关闭）
+        int connectTimeoutMs{3000};  // 事件循环模式：非阻塞连接的超时（毫秒）
         
         // 日志配置（使用完整命名空间，避免循环依赖）
         int logLevel{1};  // 日志级别：0=DEBUG, 1=INFO, 2=WARN, 3=ERROR, 4=FATAL
     };
 
     NodeAgent(const Config& config);
+    // 运行在共享的事件循环上（TCP 事件循环模式）：不创建自己的循环线程，循环由调用方（如 MultiUavManager）
+    // 驱动且须比本对象活得久；其它模式下忽略 sharedLoop
+    NodeAgent(const Config& config, std::shared_ptr<EventLoop> sharedLoop);
     ~NodeAgent();
 
     // 启动 NodeAgent（开始订阅 SDK Telemetry 并上报，同时接收下行消息）
@@ -74,9 +148,24 @@ public:
     // 设置下行消息处理器（当收到 Cluster Center 的命令/任务时调用）
     void setDownlinkMessageHandler(DownlinkMessageHandler handler);
 
+    // 发送上行消息（JSON 字符串）；未连接或发送失败时按 cls 写入断链缓存，返回是否已发送或已缓存
+    bool sendUplinkMessage(const std::string& message, SpoolClass cls = SpoolClass::Event);
+
+    // 断链缓存统计（未启用时为全 0）
+    TelemetrySpoolStats spoolStats() const;
+
+    // 时钟同步状态与时延指标（未启用时为全 0）
+    ClockSyncStats clockSyncStats() const;
+
+    // 机间链路收发统计（未启用时为全 0）
+    SwarmLinkStats swarmLinkStats() const;
+
     // 设置 FlightConnectionService（用于执行命令和任务）
     void setFlightConnectionService(std::shared_ptr<falconmind::sdk::flight::FlightConnectionService> service);
 
+    // 快速启动预加载检测模型所用的管理器（须在 start() 之前设置）
+    void setPerceptionPluginManager(std::shared_ptr<falconmind::sdk::perception::PerceptionPluginManager> manager);
+
 private:
     Config config_;
     std::unique_ptr<IUplinkClient> uplinkClient_;
@@ -86,14 +175,72 @@ private:
     std::unique_ptr<FlowHandler> flowHandler_;
     std::unique_ptr<MessageAckManager> ackManager_;
     std::unique_ptr<ReconnectManager> reconnectManager_;
+    std::unique_ptr<TelemetrySpool> spool_;
+    std::unique_ptr<DefinitionTransfer> definitionTransfer_;
+    std::unique_ptr<ClockSync> clockSync_;
+    std::unique_ptr<SwarmLink> swarmLink_;
+    std::unique_ptr<falconmind::sdk::telemetry::MetricsRollupPublisher> metricsRollup_;
+    int rollupSubId_{-1};
+    std::shared_ptr<falconmind::sdk::perception::PerceptionPluginManager> perceptionPlugins_;
+    std::int64_t lastSpooledTelemetryNs_{0};  // 遥测发送线程独占（异步订阅分发线程或事件循环线程）
     std::atomic<bool> running_{false};
     std::thread workerThread_;
-
+    std::mutex workerMutex_;               // 线程模式主循环的周期等待（stop() 唤醒）
+    std::condition_variable workerCv_;
+
+    // 事件循环模式（仅循环线程访问，start() 中启动循环前的初始化除外）
+    std::shared_ptr<EventLoop> loop_;
+    bool sharedLoop_{false};
+    int telemetrySubId_{-1};
+    int updateTimer_{-1};
+    int flushTimer_{-1};
+    int reconnectTimer_{-1};
+    int downlinkFd_{-1};  // 已注册到事件循环的下行 socket
+    bool reconnecting_{false};
+    int reconnectAttempts_{0};
+    ReconnectBackoff backoff_;
+    int connectTimer_{-1};
+    int connectingFd_{-1};  // 非阻塞连接进行中的 socket（等待可写）
+    // 遥测发布线程 → 事件循环：有界队列，满时丢弃最旧的一条
+    std::mutex telemetryMutex_;
+    std::deque<falconmind::sdk::telemetry::TelemetryMessage> telemetryQueue_;
+
+    // 连接上行与下行（TCP 复用上行 socket），并开始接收下行消息
+    bool connectTransport();
+    // 上行已连接后建立下行（TCP 复用上行 socket）
+    bool attachDownlink();
     void workerLoop();
+    void runEventLoop();
+    // 在循环线程中：订阅遥测并启动更新定时器 / 停止定时器并取消订阅
+    void beginLoopMode();
+    void endLoopMode();
+    void updateHandlers();
+    void enqueueTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg);
+    void sendQueuedTelemetry();
+    // 事件循环线程：拆除连接并（若启用）按指数退避调度重连
+    void handleConnectionLost(const std::string& reason);
+    void attemptReconnect();
+    void onReconnectSucceeded();
+    void scheduleReconnect();
+    // 发送遥测（已同步时时间戳换算为 Cluster Center 时钟）
+    bool sendTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg);
+    bool sendReplayedTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg);
+    // 已同步时在 JSON 对象末尾附加 center_ts_ns（Cluster Center 时钟的当前时刻）
+    std::string stampMessage(const std::string& message) const;
+    // 新连接：重新开始时钟同步探测；更新周期中到时发送探测
+    void restartClockSync();
+    void sendClockProbe();
+    void spoolTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg);
+    void drainSpool();
     void handleDownlinkMessage(const DownlinkMessage& msg);
     
     // 上报Flow状态到Cluster Center
     void reportFlowStatus(const std::string& flow_id, const std::string& status, const std::string& error_msg = "");
+
+    // 分块传输入库（或命中缓存）的定义交给 FlowHandler / MissionHandler
+    bool deployDefinition(DefinitionKind kind, const std::string& sha256, std::string content,
+                          const DownlinkMessage& request);
+    void reportTransferStatus(const DefinitionTransferStatus& status);
 };
 
 } // namespace nodeagent
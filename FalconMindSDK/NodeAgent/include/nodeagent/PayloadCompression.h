@@ -0,0 +1,108 @@
+// NodeAgent - zstd dictionary compression for JSON payloads on the Cluster Center connection
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace nodeagent {
+
+// 协商时使用的压缩算法名（hello 的 "compression" 列表 / HELLO 应答的 "compression" 字段）
+constexpr const char* kPayloadCompressionZstd = "zstd";
+
+struct PayloadCompressionConfig {
+    bool enabled{false};
+    // 预训练字典目录：<消息类型>.zdict（zstd --train 产出，须带字典 ID），如 flow.zdict / mission.zdict /
+    // flow_status.zdict；类型取 JSON 顶层 "type" 或下行文本前缀（FLOW: → flow），无对应字典时用 default.zdict，
+    // 仍没有则不带字典压缩。两端部署同一批字典文件
+    std::string dictionaryDirectory;
+    int level{3};               // ARM 伴随计算机上 3 级约 100 MB/s 以上，配合字典已能压到 1/5～1/10
+    std::size_t minBytes{128};  // 更短的消息不压缩（帧头与 zstd 帧头开销抵消收益）
+};
+
+struct PayloadCompressionStats {
+    std::uint64_t compressed{0};    // 以压缩帧发送的消息
+    std::uint64_t rawBytes{0};      // 其压缩前字节数
+    std::uint64_t frameBytes{0};    // 其压缩帧字节数（含帧头）
+    std::uint64_t skipped{0};       // 过短或压缩后不更小，按原格式发送
+    std::uint64_t decompressed{0};  // 解开的压缩帧
+    std::uint64_t errors{0};        // 压缩失败 / 解压失败（缺字典、数据损坏、超出长度上限）
+};
+
+/**
+ * PayloadCodec
+ *
+ * 文本 JSON 仍在上下行连接上传输时（Flow / 任务定义、检测、状态事件）的可选压缩：每种消息类型一个预训练
+ * zstd 字典，短小而重复的 JSON 也能压缩 5～10 倍。字典在 create() 时一次性建立 CDict / DDict，
+ * 之后每条消息只做一次 zstd 调用，不重新加载字典。
+ *
+ * 线格式复用 DownlinkClient 的长度前缀帧：magic | u32 小端长度 | 载荷，长度最高位（kFrameCompressedFlag）
+ * 置位表示载荷为 zstd 帧，解开后即原本的一条消息（上行 JSON 行去掉换行 / 下行 "FLOW:..." 等文本）。
+ * zstd 帧头自带字典 ID 与原始长度，解压端据此选字典并在解压前检查长度上限。
+ *
+ * 按连接协商（UplinkClient 的 hello）：本端通告 "compression":["zstd"] 与持有的字典 ID，对端应答其中
+ * 双方都有的字典；只有对端应答后才发送压缩帧，压缩时只使用对端持有的字典。未编入 zstd 时 available()
+ * 为 false，create() 返回 nullptr，连接保持原有格式。线程安全（压缩 / 解压各一个上下文，分别加锁）。
+ */
+class PayloadCodec {
+public:
+    ~PayloadCodec();
+    PayloadCodec(const PayloadCodec&) = delete;
+    PayloadCodec& operator=(const PayloadCodec&) = delete;
+
+    // 是否编入了 zstd（NODEAGENT_ZSTD_ENABLED）
+    static bool available() noexcept;
+    // 加载字典目录（为空时不使用字典）；未编入 zstd、未启用或目录不可读时返回 nullptr
+    static std::shared_ptr<PayloadCodec> create(const PayloadCompressionConfig& config);
+
+    // 本端持有的字典 ID（hello 中通告）
+    std::vector<std::uint32_t> dictionaryIds() const;
+
+    // 把一条消息压缩为完整的压缩帧追加到 out；peerDictionaries 为对端持有的字典 ID（协商结果）。
+    // 消息短于 minBytes 或压缩帧不比原格式（消息 + 换行）更小时返回 false，out 不变，调用方按原格式发送
+    bool compressFrame(std::string_view message, const std::vector<std::uint32_t>& peerDictionaries,
+                       std::string& out);
+    // 解开压缩帧的载荷（不含帧头），结果写入 out；原始长度超过 maxBytes、缺字典或数据损坏时返回 false
+    bool decompress(const void* data, std::size_t size, std::size_t maxBytes, std::string& out);
+
+    // 从抓取的同类型消息样本训练字典，写入 <directory>/<type>.zdict（部署前离线生成；样本宜数百条以上）。
+    // 未编入 zstd、样本不足或写入失败时返回 false
+    static bool trainDictionary(const std::string& directory, const std::string& type,
+                                const std::vector<std::string>& samples, std::size_t dictBytes = 16 * 1024);
+
+    // 消息类型（选字典用）：下行文本前缀（CMD: / MISSION: / FLOW: / XFER: / ACK:）或 JSON 顶层 "type" 字段；
+    // 只扫描到第一个 "type" 键，不解析整条消息。未识别时返回空
+    static std::string_view messageType(std::string_view message) noexcept;
+
+    PayloadCompressionStats stats() const noexcept;
+
+private:
+    struct Dictionary;
+    struct Contexts;
+
+    explicit PayloadCodec(const PayloadCompressionConfig& config);
+    const Dictionary* dictionaryFor(std::string_view type, const std::vector<std::uint32_t>& peerDictionaries) const;
+
+    PayloadCompressionConfig config_;
+    std::vector<std::unique_ptr<Dictionary>> dictionaries_;
+    std::unordered_map<std::string, const Dictionary*> byType_;
+    std::unordered_map<std::uint32_t, const Dictionary*> byId_;
+    std::unique_ptr<Contexts> contexts_;
+    std::mutex compressMutex_;
+    std::mutex decompressMutex_;
+
+    std::atomic<std::uint64_t> compressed_{0};
+    std::atomic<std::uint64_t> rawBytes_{0};
+    std::atomic<std::uint64_t> frameBytes_{0};
+    std::atomic<std::uint64_t> skipped_{0};
+    std::atomic<std::uint64_t> decompressed_{0};
+    std::atomic<std::uint64_t> errors_{0};
+};
+
+} // namespace nodeagent
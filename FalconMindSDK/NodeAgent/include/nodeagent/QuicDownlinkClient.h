@@ -0,0 +1,61 @@
+// NodeAgent - QUIC-based downlink client (alternative to TCP for lossy radio links)
+#pragma once
+
+#include "nodeagent/DownlinkClient.h"
+#include "nodeagent/QuicSession.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace nodeagent {
+
+// QUIC 下行客户端：Cluster Center 在 QuicSession 上打开的每条单向流各自分帧（与 TCP 下行相同的
+// 文本行 / 长度前缀帧），命令与大型任务载荷走不同的流时，尚未收全的任务不会挡住后到的 RTL。
+// 同一条流内仍按 DownlinkClient 的规则分发（紧急命令先于同批载荷）。
+// 回调在 msquic 工作线程中调用；按流的解析器由 mutex 保护，不同流上的消息不会并发分发
+class QuicDownlinkClient : public IDownlinkClient {
+public:
+    using MessageHandler = IDownlinkClient::MessageHandler;
+    using AckHandler = IDownlinkClient::AckHandler;
+
+    struct Config {
+        std::size_t maxMessageBytes{4u << 20};  // 单条消息上限；超过时丢弃该流上的剩余数据
+    };
+
+    explicit QuicDownlinkClient(std::shared_ptr<QuicSession> session);
+    QuicDownlinkClient(std::shared_ptr<QuicSession> session, const Config& config);
+    ~QuicDownlinkClient();
+
+    // 实现 IDownlinkClient 接口（existingSocketFd 不适用于 QUIC）
+    bool connect(int existingSocketFd = -1) override;
+    void disconnect() override;
+    bool isConnected() const override { return session_->isConnected(); }
+    void setMessageHandler(MessageHandler handler) override;
+    void setAckHandler(AckHandler handler) override;
+    bool startReceiving(const std::string& uavId = "") override;
+    void stopReceiving() override;
+
+    // 一条下行流上按序到达的字节 / 流关闭（QuicSession 的回调，也可直接调用）
+    void onStreamData(std::uint64_t streamKey, const void* data, std::size_t size);
+    void onStreamClosed(std::uint64_t streamKey);
+
+    std::size_t activeStreams() const;
+
+private:
+    std::shared_ptr<QuicSession> session_;
+    Config config_;
+    MessageHandler messageHandler_;
+    AckHandler ackHandler_;
+    bool receiving_{false};
+
+    mutable std::mutex streamsMutex_;
+    std::unordered_map<std::uint64_t, std::unique_ptr<DownlinkClient>> streams_;  // 仅作解析器，不连接 socket
+    std::unordered_set<std::uint64_t> failedStreams_;  // 协议错误的流：丢弃剩余数据直到关闭
+};
+
+} // namespace nodeagent
@@ -0,0 +1,104 @@
+// NodeAgent - QUIC connection shared by QuicUplinkClient / QuicDownlinkClient
+#pragma once
+
+#include "nodeagent/IUplinkClient.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace nodeagent {
+
+struct QuicSessionStats {
+    std::uint64_t connects{0};
+    std::uint64_t resumedConnects{0};   // 以会话票据恢复（0-RTT）的连接
+    std::uint64_t handshakeFailures{0};
+    std::array<std::uint64_t, kUplinkPriorityCount> streamMessages{};  // 按 UplinkPriority 下标
+    std::array<std::uint64_t, kUplinkPriorityCount> streamBytes{};
+    std::uint64_t bulkRejected{0};      // Bulk 流在途数据已满被拒绝的消息
+    std::uint64_t datagramsSent{0};
+    std::uint64_t datagramsLost{0};     // 协议栈判定丢失 / 取消（不重传）
+    std::uint64_t datagramsDropped{0};  // 待发数据报已达上限，未交给协议栈
+    std::uint64_t migrations{0};        // 主动切换本地地址（换用另一个调制解调器）
+};
+
+/**
+ * QuicSession - 到 Cluster Center 的一条 QUIC 连接（msquic），上行与下行共用
+ *
+ * 上行每个 UplinkPriority 一条单向流（Control / Event / Telemetry / Bulk），流之间没有队头阻塞：
+ * 一条流上的丢包重传不会推迟其它流的数据；流调度优先级按 Control > Event > Telemetry > Bulk 设置。
+ * 下行由 Cluster Center 打开单向流（命令与任务载荷可分流），收到的字节按流交给 ReceiveHandler。
+ * 不可靠数据报（RFC 9221）承载只关心最新值的遥测：丢失的数据报不重传，不会推迟更新的状态。
+ *
+ * 0-RTT：保存服务端下发的会话票据（可写入 resumptionTicketPath 跨进程保留），重连时随首个报文发出遥测，
+ * connect() 不等待握手完成。0-RTT 数据可被重放，只有遥测流与数据报带 ALLOW_0_RTT，
+ * 事件 / 命令回执 / 补发数据由协议栈在握手完成后发送。
+ * 连接迁移：QUIC 以连接 ID 标识连接，NAT 重绑定或本地地址变化时连接保持；migrate() 主动换到另一个
+ * 本地地址（另一块调制解调器），在途数据在新路径上继续。
+ *
+ * 未以 NODEAGENT_QUIC_ENABLED 编译（未找到 msquic）时 connect() 总是失败。
+ * send / sendDatagram 可由多个线程调用；connect / disconnect / migrate 由同一线程调用
+ */
+class QuicSession {
+public:
+    struct Config {
+        std::string serverAddress{"127.0.0.1"};
+        int serverPort{8889};
+        std::string serverName;          // TLS SNI 与证书校验名；空时使用 serverAddress
+        std::string alpn{"falconmind-v1"};
+        bool verifyCertificate{true};
+        std::string caFile;              // 非空时以该 CA 证书校验服务端（自建 Cluster Center）
+        std::string localAddress;        // 非空时从该本地地址发起（绑定到指定调制解调器）
+        int connectTimeoutMs{3000};      // 无会话票据时等待握手完成的时间
+        int idleTimeoutMs{15000};
+        int keepAliveIntervalMs{1000};   // 保活，同时使链路中断能在数秒内被发现
+        bool enableDatagrams{true};
+        bool enableZeroRtt{true};
+        std::string resumptionTicketPath;  // 空时会话票据只保存在内存中
+        std::size_t maxBulkInflightBytes{256u << 10};  // Bulk 流尚未确认的数据上限，超过时 send 返回 false
+        int maxPendingDatagrams{4};      // 尚未发出的数据报上限：拥塞时丢弃新数据报，不排队
+    };
+
+    // streamKey 标识一条下行流（流关闭后可能被复用），data 为该流上按序到达的字节
+    using ReceiveHandler = std::function<void(std::uint64_t streamKey, const std::uint8_t* data, std::size_t size)>;
+    using StreamClosedHandler = std::function<void(std::uint64_t streamKey)>;
+
+    QuicSession();
+    explicit QuicSession(const Config& config);
+    ~QuicSession();
+    QuicSession(const QuicSession&) = delete;
+    QuicSession& operator=(const QuicSession&) = delete;
+
+    // 是否以 msquic 编译
+    static bool available() noexcept;
+
+    bool connect();
+    void disconnect();
+    bool isConnected() const;
+    // 本连接是否以会话票据恢复（握手完成后有效）
+    bool resumed() const;
+
+    // 在 priority 对应的流上发送一条消息（newline 为 true 时追加换行分隔）
+    bool send(UplinkPriority priority, const void* data, std::size_t size, bool newline);
+    // 发送一个不可靠数据报；数据报不可用（对端未启用 / 超过路径 MTU / 握手未完成）时返回 false，
+    // 待发数据报已满时丢弃并返回 true（下一次状态会覆盖）
+    bool sendDatagram(const void* data, std::size_t size);
+    // 迁移到另一个本地地址（IP 字符串）
+    bool migrate(const std::string& localAddress);
+
+    // 需在 connect() 之前设置；回调在 msquic 工作线程中调用
+    void setReceiveHandler(ReceiveHandler handler);
+    void setStreamClosedHandler(StreamClosedHandler handler);
+
+    const Config& config() const noexcept;
+    QuicSessionStats stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace nodeagent
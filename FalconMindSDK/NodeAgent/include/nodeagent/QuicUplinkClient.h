@@ -0,0 +1,53 @@
+// NodeAgent - QUIC-based uplink client (alternative to TCP for lossy radio links)
+#pragma once
+
+#include "nodeagent/IUplinkClient.h"
+#include "nodeagent/QuicSession.h"
+#include "nodeagent/TelemetryDeltaEncoder.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace nodeagent {
+
+// QUIC 上行客户端：每个 UplinkPriority 发往 QuicSession 中各自的流，一条流上的重传不阻塞其它流。
+// telemetryOverDatagrams 时遥测以完整二进制帧作为不可靠数据报发送：每帧自包含，丢失不重传、不推迟更新的状态；
+// 数据报不可用（对端未启用 / 帧超过路径 MTU）时退回遥测流上的完整二进制帧。
+// 遥测流可靠有序，关闭数据报时可使用增量帧。ALPN 即表示对端支持二进制帧，Auto 不再协商，按 BinaryDelta
+// （数据报模式下按 Binary）处理
+class QuicUplinkClient : public IUplinkClient {
+public:
+    struct Config {
+        TelemetryEncoding telemetryEncoding{TelemetryEncoding::Auto};
+        TelemetryDeltaConfig delta;
+        bool telemetryOverDatagrams{true};
+    };
+
+    explicit QuicUplinkClient(std::shared_ptr<QuicSession> session);
+    QuicUplinkClient(std::shared_ptr<QuicSession> session, const Config& config);
+
+    // 实现 IUplinkClient 接口（连接由共用的 QuicSession 管理）
+    bool connect() override;
+    void disconnect() override;
+    bool isConnected() const override { return session_->isConnected(); }
+    bool sendTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg) override;
+    bool sendMessage(const std::string& message) override;  // Event 流
+    bool sendMessage(const std::string& message, UplinkPriority priority) override;
+    bool sendReplayedTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg) override;
+    TelemetryEncoding activeTelemetryEncoding() const override { return activeEncoding_; }
+    const TelemetryDeltaStats& deltaStats() const { return delta_.stats(); }
+
+    const std::shared_ptr<QuicSession>& session() const { return session_; }
+
+private:
+    std::shared_ptr<QuicSession> session_;
+    Config config_;
+    TelemetryEncoding activeEncoding_{TelemetryEncoding::Json};
+    std::mutex deltaMutex_;  // 增量编码器状态须与遥测流上的发送顺序一致
+    TelemetryDeltaEncoder delta_;
+
+    std::string serializeTelemetryToJson(const falconmind::sdk::telemetry::TelemetryMessage& msg, bool replay = false);
+};
+
+} // namespace nodeagent
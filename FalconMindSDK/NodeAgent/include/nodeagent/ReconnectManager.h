@@ -6,28 +6,84 @@
 #include <thread>
 #include <mutex>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <random>
 
 namespace nodeagent {
 
-// 自动重连管理器
+/**
+ * ReconnectBackoff - 重连等待策略（非线程安全，由调用方串行化）
+ *
+ * 两级：已建立的连接中断（对端 RST、发送失败等瞬断）后几乎立即重试一次；之后按去相关抖动退避，
+ * 下一次等待 = min(maxDelay, 均匀分布[initialDelay, 上一次等待 × multiplier])，
+ * 机群中同时断链的节点重连时刻自然错开，不会一起冲击 Cluster Center。
+ * 链路感知：linkQuality（0..1，>1 按百分比换算，≤0 视为未知）低于 poorLinkThreshold 时认为电台处于衰落，
+ * 期间只按 fadeProbeDelay 低频探测；质量恢复时 updateLinkQuality 返回 true，调用方应立即重试并重置退避，
+ * 短暂衰落结束后亚秒内即可重连。
+ */
+class ReconnectBackoff {
+public:
+    struct Config {
+        std::chrono::milliseconds initialDelay{250};
+        std::chrono::milliseconds maxDelay{30000};
+        double multiplier{3.0};          // 去相关抖动的上界倍数
+        bool fastRetry{true};            // 连接中断后几乎立即重试一次
+        double poorLinkThreshold{0.2};   // ≤ 0 关闭链路感知
+        std::chrono::milliseconds fadeProbeDelay{2000};
+    };
+
+    ReconnectBackoff();  // 使用默认配置
+    explicit ReconnectBackoff(const Config& config);
+    ReconnectBackoff(const Config& config, std::uint64_t seed);
+
+    // 新一轮重连：返回首次尝试前的等待，在 [0, initialDelay] 内抖动（transient 且启用 fastRetry 时不超过 initialDelay / 4）
+    std::chrono::milliseconds begin(bool transient);
+    // 一次尝试失败：返回下一次尝试前的等待
+    std::chrono::milliseconds next();
+    // 重置退避（连接成功或链路恢复）
+    void reset();
+
+    // 更新链路质量；由衰落恢复时返回 true
+    bool updateLinkQuality(double quality);
+    bool linkPoor() const noexcept { return linkPoor_; }
+
+private:
+    std::chrono::milliseconds jittered();
+
+    Config config_;
+    std::mt19937_64 rng_;
+    std::chrono::milliseconds prev_{0};
+    bool linkPoor_{false};
+};
+
+// 自动重连管理器（线程模式）：在独立线程中按 ReconnectBackoff 调度重连，等待可被 stop() / 链路恢复打断
 class ReconnectManager {
 public:
     using ReconnectCallback = std::function<bool()>;  // 返回 true 表示重连成功
 
     struct Config {
         bool enabled;  // 是否启用自动重连
-        int maxRetries;  // 最大重试次数（-1 表示无限重试）
-        std::chrono::milliseconds initialDelay;  // 初始延迟（毫秒）
+        int maxRetries;  // 最大重试次数（-1 表示无限重试；链路衰落期间的探测不计入）
+        std::chrono::milliseconds initialDelay;  // 退避下限（毫秒）
         std::chrono::milliseconds maxDelay;  // 最大延迟（毫秒）
-        double backoffMultiplier;  // 退避倍数
+        double backoffMultiplier;  // 去相关抖动的上界倍数
+        bool fastRetry;  // 连接中断后先立即重试一次
+        double poorLinkThreshold;  // 链路质量低于该值时视为衰落（≤ 0 关闭）
+        std::chrono::milliseconds fadeProbeDelay;  // 衰落期间的探测间隔
         
         Config() 
             : enabled(true)
             , maxRetries(5)
-            , initialDelay(std::chrono::milliseconds(1000))
+            , initialDelay(std::chrono::milliseconds(250))
             , maxDelay(std::chrono::milliseconds(30000))
-            , backoffMultiplier(2.0) {
+            , backoffMultiplier(3.0)
+            , fastRetry(true)
+            , poorLinkThreshold(0.2)
+            , fadeProbeDelay(std::chrono::milliseconds(2000)) {
         }
+
+        ReconnectBackoff::Config backoff() const;
     };
 
     ReconnectManager(const Config& config = Config{});
@@ -36,8 +92,11 @@ public:
     // 设置重连回调
     void setReconnectCallback(ReconnectCallback callback);
 
-    // 触发重连（当检测到连接断开时调用）
-    void triggerReconnect();
+    // 触发重连（当检测到连接断开时调用）；transient 表示已建立的连接中断，可先快速重试
+    void triggerReconnect(bool transient = false);
+
+    // 链路质量输入（如遥测中的 linkQuality）；衰落恢复时立即唤醒等待中的重连
+    void updateLinkQuality(double quality);
 
     // 停止重连
     void stop();
@@ -52,7 +111,7 @@ public:
     void reset();
 
 private:
-    void reconnectLoop();
+    void reconnectLoop(bool transient);
 
     Config config_;
     ReconnectCallback reconnectCallback_;
@@ -60,7 +119,13 @@ private:
     std::atomic<bool> shouldStop_{false};
     std::atomic<int> retryCount_{0};
     std::thread reconnectThread_;
-    mutable std::mutex mutex_;
+    mutable std::mutex mutex_;  // 保护回调
+
+    // 退避状态与等待（与回调锁分开：重连进行中也能及时更新链路质量）
+    std::mutex waitMutex_;
+    std::condition_variable waitCv_;
+    ReconnectBackoff backoff_;
+    bool wakeRequested_{false};
 };
 
 } // namespace nodeagent
@@ -0,0 +1,36 @@
+// NodeAgent - SHA-256 digest for transfer integrity and content addressing
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace nodeagent {
+
+// FIPS 180-4 SHA-256，增量计算；不依赖 OpenSSL（NodeAgent 可在无 OpenSSL 的环境编译）
+class Sha256 {
+public:
+    using Digest = std::array<std::uint8_t, 32>;
+
+    Sha256() { reset(); }
+
+    void reset();
+    void update(const void* data, std::size_t size);
+    Digest finish();
+
+    // 一次性计算，返回 64 位小写十六进制
+    static std::string hex(std::string_view data);
+    static std::string toHex(const Digest& digest);
+
+private:
+    void compress(const std::uint8_t* block);
+
+    std::array<std::uint32_t, 8> state_{};
+    std::array<std::uint8_t, 64> buffer_{};
+    std::size_t buffered_{0};
+    std::uint64_t totalBytes_{0};
+};
+
+} // namespace nodeagent
@@ -0,0 +1,114 @@
+// NodeAgent - Edge-to-edge swarm state gossip over UDP multicast / mesh unicast
+#pragma once
+
+#include "falconmind/sdk/cluster/SwarmState.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::telemetry {
+    struct TelemetryMessage;
+}
+
+namespace nodeagent {
+
+struct SwarmLinkConfig {
+    bool enabled{false};
+    std::string group{"239.255.77.1"};  // 组播组；为空时只向 peers 单播
+    int port{14600};
+    std::string interfaceAddress;       // 组播收发使用的本地接口地址（IP）；空时由路由表决定
+    int ttl{1};                         // 组播 TTL：默认不跨路由器
+    bool multicastLoopback{false};      // 同机多进程仿真时开启；自己发出的报文按 ID 过滤
+    std::vector<std::string> peers;     // "host:port"：不支持组播的 mesh 电台上逐个单播
+    int rateHz{10};                     // 本机状态广播频率
+};
+
+struct SwarmLinkStats {
+    std::uint64_t sent{0};          // 发出的状态报文（每个目的地址计一次）
+    std::uint64_t sendErrors{0};
+    std::uint64_t received{0};      // 写入 SwarmStateRegistry 的对端状态
+    std::uint64_t decodeErrors{0};  // 魔数 / 版本 / 长度不符
+    std::uint64_t stale{0};         // 乱序 / 重复 / 自己发出的报文
+};
+
+// 机间状态报文（小端）：
+//   "FS" | u8 版本 | u8 保留 | u32 序号 | i64 发送时刻（Unix ns）
+//   | i32 纬度 ×1e7 | i32 经度 ×1e7 | i32 高度 mm | i16 vx / vy / vz cm/s
+//   | u8 ID 长度 + ID | u8 角色长度 + 角色 | u8 认领数 + 认领数 × (u32 目标 ID | u16 score ×65535)
+//   [版本 2：| u8 目标数（>= 1）+ 目标数 × (i32 纬度 ×1e7 | i32 经度 ×1e7 | u16 类别指纹 | u8 置信度 ×255)]
+// 不带目标记录的报文仍按版本 1 编码，未升级的对端照常解码位置与认领
+constexpr std::uint8_t kSwarmWireVersion = 1;
+constexpr std::uint8_t kSwarmWireVersionTargets = 2;
+constexpr std::size_t kSwarmHeaderBytes = 34;
+constexpr std::size_t kSwarmMaxIdBytes = 63;
+constexpr std::size_t kSwarmMaxClaims = 16;
+constexpr std::size_t kSwarmMaxTargets = 16;
+constexpr std::size_t kSwarmTargetRecordBytes = 11;
+constexpr std::size_t kSwarmMaxPacketBytes = kSwarmHeaderBytes + 2 * (1 + kSwarmMaxIdBytes) + 1 + kSwarmMaxClaims * 6 +
+                                             1 + kSwarmMaxTargets * kSwarmTargetRecordBytes;
+
+/**
+ * SwarmLink - 机间直连的集群状态交换，不经 Cluster Center
+ *
+ * 按 rateHz 把本机状态（SwarmStateRegistry::localState：遥测位置 / 速度、SDK 写入的角色与目标认领）
+ * 连同 SwarmTargetRegistry 轮转取出的一批已确认目标（至多 kSwarmMaxTargets 条）
+ * 编码为紧凑的二进制报文，发往组播组与 peers 中的各地址；收到的对端报文写入 SwarmStateRegistry，
+ * ClusterStateSourceNode（members_source=swarm）、编队与目标交接逻辑据此在本机以 10–20 Hz 响应。
+ * 报文为 UDP 单个数据报，丢失不重传，下一次广播即覆盖；乱序报文按序号丢弃。
+ * 本机位置来自 SDK TelemetryPublisher（routeByUavId 为 true 时只取本 uavId 的遥测）。
+ * start / stop 由同一线程调用
+ */
+class SwarmLink {
+public:
+    SwarmLink(const SwarmLinkConfig& config, const std::string& selfId, bool routeByUavId = false);
+    ~SwarmLink();
+    SwarmLink(const SwarmLink&) = delete;
+    SwarmLink& operator=(const SwarmLink&) = delete;
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running_; }
+    // 实际绑定的 UDP 端口（port 配置为 0 时由系统分配）；未启动时返回 -1
+    int localPort() const;
+
+    // 用一条遥测更新本机位置 / 速度（start() 后亦由 TelemetryPublisher 订阅自动调用）
+    void updateOwnState(const falconmind::sdk::telemetry::TelemetryMessage& msg);
+
+    SwarmLinkStats stats() const;
+
+    // 编码一条状态报文；out 至少 kSwarmMaxPacketBytes 字节，ID / 角色超长截断，
+    // 认领 / 目标记录超过 kSwarmMaxClaims / kSwarmMaxTargets 时只取前面的
+    static std::size_t encode(const falconmind::sdk::cluster::SwarmPeerState& state, std::uint8_t* out);
+    // 解码一条状态报文；格式不符时返回 false
+    static bool decode(const std::uint8_t* data, std::size_t size, falconmind::sdk::cluster::SwarmPeerState& out);
+
+private:
+    struct Destination;
+
+    SwarmLinkConfig config_;
+    std::string selfId_;
+    bool routeByUavId_;
+    int socketFd_{-1};
+    int wakeFd_{-1};
+    int telemetrySubId_{-1};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    std::uint32_t seq_{0};
+    std::vector<Destination> destinations_;
+
+    mutable std::mutex statsMutex_;
+    SwarmLinkStats stats_;
+
+    bool openSocket();
+    void closeSocket();
+    void run();
+    void broadcast();
+    void receiveAvailable();
+};
+
+} // namespace nodeagent
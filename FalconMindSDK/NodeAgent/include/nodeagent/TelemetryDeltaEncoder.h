@@ -0,0 +1,97 @@
+// NodeAgent - Delta / field-masked telemetry encoder with per-group adaptive rates
+#pragma once
+
+#include "falconmind/sdk/telemetry/TelemetryCodec.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace nodeagent {
+
+// 单个字段组的发送策略
+struct TelemetryGroupPolicy {
+    double rateHz{1.0};    // 最高发送频率；<= 0 表示只随关键帧发送
+    double deadband{0.0};  // 与上次发送值的差异低于该阈值视为未变化（单位见各组说明），0 为任意变化即发送
+};
+
+struct TelemetryDeltaConfig {
+    // 各组策略，下标为 TelemetryFieldGroup 的位序号（位置、姿态、速度、电池、GPS、链路质量、飞行模式）。
+    // 差异度量：位置为米（水平 + 垂直），姿态为弧度（最大分量），速度为 m/s（矢量差），
+    // 电池为百分点（电压按 100 mV 折算 1 个百分点），链路质量为 0~1；GPS 与飞行模式任意变化即发送
+    std::array<TelemetryGroupPolicy, falconmind::sdk::telemetry::kTelemetryGroupCount> groups{{
+        {10.0, 0.2},   // 位置 10 Hz
+        {10.0, 0.01},  // 姿态
+        {5.0, 0.05},   // 速度
+        {0.2, 0.5},    // 电池 0.2 Hz
+        {1.0, 0.0},    // GPS（定位状态、卫星数）
+        {0.5, 0.05},   // 链路质量
+        {5.0, 0.0},    // 飞行模式：变化后尽快发送
+    }};
+    double keyframeIntervalSec{5.0};   // 关键帧（全部字段组）间隔；接收端以此纠正丢失的增量
+    double heartbeatIntervalSec{1.0};  // 无任何字段组需要发送时，至少按该间隔发送仅含时间戳的帧
+
+    // 链路自适应：连续量字段组（位置 / 姿态 / 速度 / 电池 / 链路质量）的频率乘以
+    // clamp(linkQuality, minRateScale, 1)；linkQuality 取消息自身的 linkQuality（<= 0 视为未知，不缩放）
+    bool adaptToLinkQuality{true};
+    double minRateScale{0.1};
+    // 上行字节预算（字节/秒，令牌桶，突发上限 1 秒）；0 为不限。预算耗尽时推迟连续量字段组，
+    // 关键帧、GPS、飞行模式与心跳不受限制
+    double maxBytesPerSec{0.0};
+};
+
+struct TelemetryDeltaStats {
+    std::uint64_t inputs{0};      // encode 调用次数
+    std::uint64_t frames{0};      // 产生的帧
+    std::uint64_t keyframes{0};
+    std::uint64_t heartbeats{0};  // 掩码为 0 的帧
+    std::uint64_t bytes{0};
+    std::uint64_t deferred{0};    // 因字节预算推迟的字段组次数
+    std::uint64_t encodeFailures{0};  // 字符串超长等无法编码的消息
+    std::array<std::uint64_t, falconmind::sdk::telemetry::kTelemetryGroupCount> groupsSent{};
+};
+
+/**
+ * TelemetryDeltaEncoder
+ *
+ * 对每条 TelemetryMessage 决定本次需要发送的字段组：字段组与上次发送值的差异超过死区、
+ * 且距上次发送已满 1 / 频率，或到达关键帧间隔；然后按 proto/telemetry.proto 编码为增量帧。
+ * 什么都不需要发送时返回 0（心跳间隔内）。状态按 uavId 分别保存（MultiUavManager 共用一个上行时）。
+ * 非线程安全：由 UplinkClient 在单一发送线程中调用；重连后调用 reset() 使下一帧为关键帧。
+ */
+class TelemetryDeltaEncoder {
+public:
+    explicit TelemetryDeltaEncoder(const TelemetryDeltaConfig& config = {});
+
+    // nowNs 为 steady_clock 纳秒；返回帧长度，0 表示本条无需发送（或编码失败，见 encodeFailures）
+    std::size_t encode(const falconmind::sdk::telemetry::TelemetryMessage& msg, std::int64_t nowNs,
+                       std::uint8_t* out, std::size_t capacity);
+
+    void reset();
+
+    const TelemetryDeltaConfig& config() const noexcept { return config_; }
+    const TelemetryDeltaStats& stats() const noexcept { return stats_; }
+
+private:
+    struct UavState {
+        falconmind::sdk::telemetry::TelemetryMessage sent;  // 各字段组最近一次发送的值
+        std::array<std::int64_t, falconmind::sdk::telemetry::kTelemetryGroupCount> lastSentNs{};
+        std::int64_t lastKeyframeNs{0};
+        std::int64_t lastFrameNs{0};
+        std::uint32_t seq{0};
+        bool primed{false};  // 已发送过关键帧
+    };
+
+    double rateScale(const falconmind::sdk::telemetry::TelemetryMessage& msg) const noexcept;
+    void refillBudget(std::int64_t nowNs) noexcept;
+
+    TelemetryDeltaConfig config_;
+    std::unordered_map<std::string, UavState> uavs_;
+    TelemetryDeltaStats stats_;
+    double budgetBytes_{0.0};
+    std::int64_t budgetNs_{0};
+};
+
+} // namespace nodeagent
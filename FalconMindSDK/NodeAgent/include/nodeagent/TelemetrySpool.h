@@ -0,0 +1,95 @@
+// NodeAgent - Store-and-forward spool for uplink messages during link outages
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace nodeagent {
+
+// 缓存优先级：数值越小越重要；超出容量时从最不重要的类别开始淘汰，补发时从最重要的类别开始
+enum class SpoolClass : std::uint8_t {
+    Event = 0,      // 任务 / Flow 状态等事件
+    Detection = 1,  // 检测结果
+    Telemetry = 2,  // 常规遥测
+};
+
+constexpr std::size_t kSpoolClassCount = 3;
+
+const char* spoolClassName(SpoolClass cls) noexcept;
+
+struct TelemetrySpoolConfig {
+    std::string directory;               // 段文件目录；为空时不启用缓存
+    std::size_t segmentBytes{1u << 20};  // 单个段文件大小（预分配并 mmap）
+    std::size_t maxBytes{64u << 20};     // 全部段文件的总大小上限
+    double drainBytesPerSec{32 * 1024};  // 重连后补发速率（令牌桶），为实时数据保留链路带宽
+    std::size_t drainBurstBytes{8 * 1024};  // 令牌桶容量：单次 drain 最多补发的字节
+    int telemetrySampleIntervalMs{1000};    // 断链期间常规遥测按该间隔抽样写入，0 为全部写入
+};
+
+struct TelemetrySpoolStats {
+    std::array<std::uint64_t, kSpoolClassCount> appended{};  // 写入的记录
+    std::array<std::uint64_t, kSpoolClassCount> drained{};   // 已补发的记录
+    std::array<std::uint64_t, kSpoolClassCount> evicted{};   // 因容量淘汰的记录
+    std::array<std::uint64_t, kSpoolClassCount> pending{};   // 尚未补发的记录
+    std::uint64_t recovered{0};  // 启动时从已有段文件恢复的记录
+    std::uint64_t corrupt{0};    // 恢复时因校验失败截断的段
+    std::uint64_t bytesOnDisk{0};
+};
+
+/**
+ * TelemetrySpool
+ *
+ * 每个类别一串追加写的段文件（<directory>/<class>-<seq>.spool），段文件预分配后 mmap，
+ * 记录为 长度 + CRC32 + 时间戳 + 原始载荷，段头中保存已提交的写位置与已补发的读位置，
+ * 进程重启后从读位置继续（写位置之后或校验失败的记录被丢弃）。总大小超过 maxBytes 时按
+ * 遥测 → 检测 → 事件的顺序删除最旧的段。drain() 按令牌桶限速、按优先级顺序取出记录交给
+ * 发送回调，回调失败（链路再次中断）时记录保留。线程安全（内部互斥锁，写入只在断链期间发生）。
+ */
+class TelemetrySpool {
+public:
+    // 返回值：true 表示已发送（记录出队），false 表示发送失败（停止本次补发）
+    using SendFn = std::function<bool(SpoolClass cls, const std::uint8_t* data, std::size_t size,
+                                      std::int64_t timestampNs)>;
+
+    // 打开（必要时创建）目录并恢复已有段文件；目录不可用时返回 nullptr
+    static std::unique_ptr<TelemetrySpool> open(const TelemetrySpoolConfig& config);
+    ~TelemetrySpool();
+
+    TelemetrySpool(const TelemetrySpool&) = delete;
+    TelemetrySpool& operator=(const TelemetrySpool&) = delete;
+
+    // 追加一条记录；载荷大于段容量时返回 false
+    bool append(SpoolClass cls, const void* data, std::size_t size, std::int64_t timestampNs);
+
+    // 按补发速率取出记录并调用 send；nowNs 为 steady_clock 纳秒。返回本次补发的记录数
+    std::size_t drain(std::int64_t nowNs, const SendFn& send);
+
+    bool empty() const;
+    TelemetrySpoolStats stats() const;
+    const TelemetrySpoolConfig& config() const noexcept { return config_; }
+
+private:
+    struct Segment;
+
+    explicit TelemetrySpool(const TelemetrySpoolConfig& config);
+    bool recover();
+    Segment* writableSegment(SpoolClass cls, std::size_t recordBytes);
+    void removeFront(SpoolClass cls);
+    void enforceLimit();
+
+    TelemetrySpoolConfig config_;
+    mutable std::mutex mutex_;
+    std::array<std::deque<std::unique_ptr<Segment>>, kSpoolClassCount> segments_;
+    std::array<std::uint64_t, kSpoolClassCount> nextSeq_{};
+    TelemetrySpoolStats stats_;
+    double budgetBytes_{0.0};
+    std::int64_t budgetNs_{0};
+};
+
+} // namespace nodeagent
@@ -2,41 +2,185 @@
 #pragma once
 
 #include "nodeagent/IUplinkClient.h"
+#include "nodeagent/TelemetryDeltaEncoder.h"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <string>
 #include <memory>
+#include <thread>
+#include <vector>
+
+struct iovec;
+struct sockaddr_in;
 
 namespace nodeagent {
 
+class PayloadCodec;
+
 // 上行客户端：将 SDK Telemetry 序列化并发送到 Cluster Center
-// 当前使用简单的 JSON over TCP，后续可升级为 gRPC/MQTT
+// TCP 上传输换行分隔的 JSON 行；协商成功后 Telemetry 改为 proto/telemetry.proto 二进制帧（与 JSON 行混合）。
+// 增量编码时由 TelemetryDeltaEncoder 决定每条消息发送哪些字段组，无需发送的消息直接跳过（返回 true）。
+// 协商：连接后发送 {"type":"hello","telemetry_encodings":[...]} 行，对端以 HELLO:{"telemetry_encoding":...} 行应答；
+// 超时或对端首先发来其它数据（旧版 Cluster Center）时回退 JSON，且不消费这些数据（留给 DownlinkClient）
+//
+// 写合并：消息追加到发送缓冲，累计达到 coalesceBytes 时由调用线程写出，否则由后台线程在最早一条
+// 等满 maxCoalesceDelayMs 时写出；每条消息保留自身分隔（JSON 行 / 自带长度的二进制帧），一次写出即一批。
+// 大消息不进缓冲，与已缓冲数据一起以 sendmsg 分散 / 聚集写出；部分写入会继续写完剩余部分。
+// 缓冲写出失败在下一次调用时以返回 false 体现（连接已关闭）。sendTelemetry / sendMessage 可由多个线程调用
+// 设置 FlushScheduler 后不启动后台线程：缓冲由空变非空时请求调度方在 delayMs 后调用 flushDue()（如 EventLoop 定时器）
+//
+// 分通道调度：发送缓冲按 UplinkPriority 分为四个通道，每批最多 maxBatchBytes，批与批之间重新选择通道：
+// Control 严格优先（且不等待合并），其余通道按 laneWeights 做赤字轮询（DRR），补发缓存等批量数据再多也只占
+// 按权重分到的带宽。抢占发生在消息边界：已开始写出的消息总是完整写完（线路格式不支持消息分片）。
+// 正在写出时其它线程追加的消息由当前写线程在下一批带走，调用方不阻塞；TCP_NOTSENT_LOWAT 限制内核中未发出的
+// 数据量，使积压留在可重新排序的通道中，而不是排在 socket 发送缓冲里。
+// 同一通道内的消息保持提交顺序；Bulk 通道积压超过 maxBulkQueuedBytes 时拒绝（返回 false，不断开连接），
+// 调用方（断链缓存）保留数据稍后重试
+//
+// 压缩：设置 PayloadCodec 后 hello 同时通告 zstd 与本端字典，对端应答 "compression":"zstd" 时本连接的
+// JSON 消息 / JSON 遥测改为压缩帧（见 PayloadCodec）；二进制遥测帧与 hello 本身不压缩
+struct UplinkStats {
+    std::uint64_t messages{0};       // 进入发送路径的消息（含直接写出的大消息）
+    std::uint64_t bytes{0};
+    std::uint64_t writes{0};         // sendmsg 调用次数
+    std::uint64_t partialWrites{0};  // 只写出一部分、需要继续写的次数
+    std::uint64_t sizeFlushes{0};    // 因累计达到 coalesceBytes 写出
+    std::uint64_t timerFlushes{0};   // 因等待达到 maxCoalesceDelayMs 写出
+    std::uint64_t preemptions{0};    // Control 消息越过其它通道已排队的数据写出
+    std::uint64_t bulkRejected{0};   // Bulk 通道积压已满被拒绝的消息
+    std::uint64_t combinedWrites{0}; // 由正在写出的线程代为写出、调用方未等待的消息
+    std::array<std::uint64_t, kUplinkPriorityCount> laneMessages{};  // 按 UplinkPriority 下标
+    std::array<std::uint64_t, kUplinkPriorityCount> laneBytes{};
+};
+
 class UplinkClient : public IUplinkClient {
 public:
     struct Config {
         std::string centerAddress{"127.0.0.1"};
         int centerPort{8888};
+        TelemetryEncoding telemetryEncoding{TelemetryEncoding::Auto};
+        int negotiateTimeoutMs{300};  // Auto 模式等待 HELLO 应答的时间
+        TelemetryDeltaConfig delta;   // 增量帧的字段组频率 / 关键帧 / 链路自适应策略
+        int maxCoalesceDelayMs{10};   // 消息在发送缓冲中的最长等待；0 关闭合并，每条消息立即写出
+        std::size_t coalesceBytes{1400};  // 累计达到（约一个 MSS）即写出；不小于该值的消息直接写出
+        int sendTimeoutMs{2000};      // 单次写阻塞上限（SO_SNDTIMEO），超时且无进展视为链路失效
+        // Event / Telemetry / Bulk 的 DRR 权重（下标为 UplinkPriority；Control 严格优先，不使用权重）
+        std::array<int, kUplinkPriorityCount> laneWeights{0, 8, 4, 1};
+        std::size_t laneQuantumBytes{1400};     // DRR 每轮额度 = laneQuantumBytes × 权重
+        std::size_t maxBatchBytes{16384};       // 每批写出上限：高优先级消息最多等待一批
+        std::size_t notSentLowatBytes{16384};  // TCP_NOTSENT_LOWAT；0 不设置
+        std::size_t maxBulkQueuedBytes{256u << 10};  // Bulk 通道积压上限
+        std::size_t maxQueuedBytes{1u << 20};  // 总积压超过时调用方等待写出（反压），不再交给写线程代写
     };
 
+    using FlushScheduler = std::function<void(int delayMs)>;
+
     UplinkClient(const Config& config);
     ~UplinkClient();
 
     // 实现 IUplinkClient 接口
     bool connect() override;
     void disconnect() override;
-    bool isConnected() const override { return connected_; }
+    bool isConnected() const override { return connected_.load(std::memory_order_acquire); }
     bool sendTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg) override;
-    bool sendMessage(const std::string& message) override;
+    bool sendMessage(const std::string& message) override;  // Event 优先级
+    bool sendMessage(const std::string& message, UplinkPriority priority) override;
+    bool sendReplayedTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg) override;
+    TelemetryEncoding activeTelemetryEncoding() const override { return activeEncoding_; }
+    const TelemetryDeltaStats& deltaStats() const { return delta_.stats(); }
+    UplinkStats stats() const;
+
+    // 立即写出发送缓冲中的消息
+    bool flush();
+
+    // 由外部定时器写出缓冲（需在 connect 之前设置，可由任意线程回调）
+    void setFlushScheduler(FlushScheduler scheduler) { flushScheduler_ = std::move(scheduler); }
+    // 调度的等待到期：写出缓冲，计入 timerFlushes
+    bool flushDue();
+
+    // 非阻塞连接（供事件循环使用）：InProgress 时待 socket 可写后调用 finishConnect()，
+    // 超时或放弃时调用 abortConnect()；连接完成后 socket 恢复为阻塞模式
+    enum class ConnectProgress { Connected, InProgress, Failed };
+    ConnectProgress beginConnect();
+    bool finishConnect();
+    void abortConnect();
+
+    // 载荷压缩（需在 connect 之前设置；与 DownlinkClient 共用）
+    void setPayloadCodec(std::shared_ptr<PayloadCodec> codec) { codec_ = std::move(codec); }
+    // 当前连接是否已协商压缩
+    bool compressionActive() const { return compressionActive_.load(std::memory_order_acquire); }
 
     // 获取 socket fd（用于 DownlinkClient 复用连接，TCP 专用）
     int getSocketFd() const { return socketFd_; }
 
 private:
     Config config_;
-    bool connected_{false};
+    std::atomic<bool> connected_{false};
     int socketFd_{-1};
+    TelemetryEncoding activeEncoding_{TelemetryEncoding::Json};
+    TelemetryDeltaEncoder delta_;
+    std::shared_ptr<PayloadCodec> codec_;
+    std::vector<std::uint32_t> peerDictionaries_;  // 协商结果：对端持有的字典；compressionActive_ 置位前写好
+    std::atomic<bool> compressionActive_{false};
+
+    // 一个优先级通道：[head, data.size()) 为排队中的消息，frames 为各条消息的长度（含分隔）
+    struct Lane {
+        std::string data;
+        std::size_t head{0};
+        std::deque<std::uint32_t> frames;
+        std::size_t deficit{0};  // DRR 剩余额度
+    };
+
+    // 锁顺序：writeMutex_（串行化 socket 写、保持消息顺序）先于 bufferMutex_（只保护发送缓冲）
+    std::mutex writeMutex_;
+    std::string inflight_;  // 正在写出的一批（writeMutex_ 保护）
+    mutable std::mutex bufferMutex_;
+    std::condition_variable bufferCv_;
+    std::array<Lane, kUplinkPriorityCount> lanes_;  // bufferMutex_ 保护，下同
+    std::size_t queuedBytes_{0};
+    std::size_t rrLane_{1};  // DRR 当前通道（Event..Bulk）
+    bool writing_{false};    // 有线程正在（或即将）写出通道中的数据
+    std::chrono::steady_clock::time_point pendingSince_;
+    bool stopFlusher_{false};
+    std::thread flusher_;
+    FlushScheduler flushScheduler_;
+    UplinkStats stats_;  // bufferMutex_ 保护
+
+    bool openSocket(struct sockaddr_in* serverAddr);
+    void failConnect(int err);
+    // 连接建立后的设置：发送超时、编码协商、写合并线程
+    bool completeConnect();
+    // 发送 hello 并等待应答，返回本连接使用的编码
+    TelemetryEncoding negotiateEncoding();
+    // 发送一条文本消息：已协商压缩且值得时以压缩帧发送，否则为换行分隔的文本行
+    bool sendText(UplinkPriority priority, const std::string& text, const char* what);
+    // 追加一条消息（newline 为 true 时追加换行分隔）；按合并策略与优先级缓冲或写出
+    bool enqueue(UplinkPriority priority, const void* data, std::size_t size, bool newline, const char* what);
+    // 直接写出大消息：先带上调度出的一批缓冲数据，同通道无积压时消息本身不拷贝；调用时持有 writeMutex_
+    bool writeDirectLocked(std::size_t lane, const void* data, std::size_t size, bool newline, const char* what);
+    // 按调度顺序逐批写出全部通道，调用时持有 writeMutex_
+    bool drainLocked(const char* what);
+    // 以下调用时持有 bufferMutex_
+    void appendFrameLocked(std::size_t lane, const void* data, std::size_t size, bool newline);
+    // 按 Control 优先 + DRR 取出一批（至少一条消息，不超过 maxBatchBytes），追加到 out
+    void takeBatchLocked(std::string& out);
+    int nextLaneLocked();
+    void clearLanesLocked();
+    bool writeAllLocked(iovec* iov, int count, const char* what);
+    void closeSocketLocked();
+    void flusherLoop();
+    void stopFlusher();
 
     // 简单的 JSON 序列化（占位，后续可用 nlohmann/json 等库）
-    std::string serializeTelemetryToJson(const falconmind::sdk::telemetry::TelemetryMessage& msg);
+    std::string serializeTelemetryToJson(const falconmind::sdk::telemetry::TelemetryMessage& msg, bool replay = false);
 };
 
 } // namespace nodeagent
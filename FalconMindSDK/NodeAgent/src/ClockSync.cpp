@@ -0,0 +1,170 @@
+#include "nodeagent/ClockSync.h"
+
+#include <algorithm>
+#include <charconv>
+
+namespace nodeagent {
+
+namespace {
+
+constexpr std::int64_t kNsPerMs = 1000000;
+
+// 读取一个以 ':' 结尾（或到末尾）的十进制整数，成功时 text 前移到分隔符之后
+template <typename T>
+bool takeNumber(std::string_view& text, T& out) {
+    const char* end = text.data() + text.size();
+    const auto [ptr, ec] = std::from_chars(text.data(), end, out);
+    if (ec != std::errc() || (ptr != end && *ptr != ':')) {
+        return false;
+    }
+    text.remove_prefix(static_cast<std::size_t>(ptr - text.data()) + (ptr != end ? 1 : 0));
+    return true;
+}
+
+} // namespace
+
+ClockSync::ClockSync() : ClockSync(ClockSyncConfig{}) {}
+
+ClockSync::ClockSync(const ClockSyncConfig& config) : config_(config) {
+    config_.windowSize = std::clamp<std::size_t>(config_.windowSize, 1, kMaxWindow);
+}
+
+void ClockSync::restart(std::int64_t steadyNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Pending& p : pending_) {
+        p.active = false;
+    }
+    windowCount_ = 0;
+    windowNext_ = 0;
+    burstRemaining_ = std::max(config_.burstProbes, 1);
+    nextProbeSteadyNs_ = steadyNs;
+}
+
+bool ClockSync::probeDue(std::int64_t steadyNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    expirePendingLocked(steadyNs);
+    return config_.enabled && steadyNs >= nextProbeSteadyNs_;
+}
+
+std::string ClockSync::makeProbe(std::int64_t systemNs, std::int64_t steadyNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // 待应答表满时覆盖最早的探测（它多半已经丢失）
+    Pending* slot = &pending_[0];
+    for (Pending& p : pending_) {
+        if (!p.active) {
+            slot = &p;
+            break;
+        }
+        if (p.t1SteadyNs < slot->t1SteadyNs) {
+            slot = &p;
+        }
+    }
+    if (slot->active) {
+        ++stats_.lost;
+    }
+    *slot = Pending{nextSeq_++, systemNs, steadyNs, true};
+    ++stats_.probesSent;
+
+    const bool burst = burstRemaining_ > 0;
+    if (burst) {
+        --burstRemaining_;
+    }
+    nextProbeSteadyNs_ = steadyNs + static_cast<std::int64_t>(burst && burstRemaining_ > 0 ? config_.burstIntervalMs
+                                                                                          : config_.probeIntervalMs) *
+                                        kNsPerMs;
+
+    // 手工拼接：探测在每个更新周期内可能生成，不经过 JSON DOM
+    std::string probe = "{\"type\":\"time_sync\",\"seq\":" + std::to_string(slot->seq) +
+                        ",\"t1\":" + std::to_string(systemNs);
+    if (stats_.synced) {
+        probe += ",\"offset_ns\":" + std::to_string(stats_.offsetNs) + ",\"rtt_ns\":" + std::to_string(stats_.rttNs) +
+                 ",\"uplink_latency_ns\":" + std::to_string(stats_.uplinkLatencyNs) +
+                 ",\"downlink_latency_ns\":" + std::to_string(stats_.downlinkLatencyNs);
+    }
+    probe += '}';
+    return probe;
+}
+
+bool ClockSync::handleReply(std::string_view ackId, std::int64_t steadyNs) {
+    if (ackId.substr(0, kReplyPrefix.size()) != kReplyPrefix) {
+        return false;
+    }
+    std::string_view rest = ackId.substr(kReplyPrefix.size());
+    std::uint32_t seq = 0;
+    std::int64_t t2 = 0;
+    std::int64_t t3 = 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!takeNumber(rest, seq) || !takeNumber(rest, t2) || !takeNumber(rest, t3) || !rest.empty()) {
+        ++stats_.rejected;
+        return true;
+    }
+    Pending* match = nullptr;
+    for (Pending& p : pending_) {
+        if (p.active && p.seq == seq) {
+            match = &p;
+            break;
+        }
+    }
+    if (!match) {
+        ++stats_.rejected;  // 重复或已超时的应答
+        return true;
+    }
+    match->active = false;
+
+    const std::int64_t t1 = match->t1Ns;
+    const std::int64_t t4 = t1 + (steadyNs - match->t1SteadyNs);
+    const std::int64_t rtt = (t4 - t1) - (t3 - t2);
+    if (rtt < 0 || rtt > static_cast<std::int64_t>(config_.maxRttMs) * kNsPerMs) {
+        ++stats_.rejected;
+        return true;
+    }
+    window_[windowNext_] = Sample{((t2 - t1) + (t3 - t4)) / 2, rtt};
+    windowNext_ = (windowNext_ + 1) % config_.windowSize;
+    windowCount_ = std::min(windowCount_ + 1, config_.windowSize);
+    ++stats_.samples;
+    stats_.lastRttNs = rtt;
+    selectLocked();
+    stats_.uplinkLatencyNs = t2 - t1 - stats_.offsetNs;
+    stats_.downlinkLatencyNs = t4 - t3 + stats_.offsetNs;
+    return true;
+}
+
+bool ClockSync::synced() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_.synced;
+}
+
+std::int64_t ClockSync::toCenterTime(std::int64_t localNs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_.synced ? localNs + stats_.offsetNs : localNs;
+}
+
+ClockSyncStats ClockSync::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void ClockSync::expirePendingLocked(std::int64_t steadyNs) {
+    const std::int64_t timeoutNs = static_cast<std::int64_t>(config_.maxRttMs) * kNsPerMs;
+    for (Pending& p : pending_) {
+        if (p.active && steadyNs - p.t1SteadyNs > timeoutNs) {
+            p.active = false;
+            ++stats_.lost;
+        }
+    }
+}
+
+void ClockSync::selectLocked() {
+    const Sample* best = &window_[0];
+    for (std::size_t i = 1; i < windowCount_; ++i) {
+        if (window_[i].rttNs < best->rttNs) {
+            best = &window_[i];
+        }
+    }
+    stats_.synced = true;
+    stats_.offsetNs = best->offsetNs;
+    stats_.rttNs = best->rttNs;
+}
+
+} // namespace nodeagent
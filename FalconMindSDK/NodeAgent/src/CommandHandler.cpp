@@ -4,12 +4,191 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <cctype>
+#include <chrono>
 
 namespace nodeagent {
 
 using namespace falconmind::sdk::flight;
 
-CommandHandler::CommandHandler() {
+namespace {
+
+std::int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::toupper(static_cast<unsigned char>(x)) == std::toupper(static_cast<unsigned char>(y));
+    });
+}
+
+struct CommandName {
+    std::string_view name;
+    FlightCommandType type;
+};
+
+constexpr CommandName kCommandNames[] = {
+    {"ARM", FlightCommandType::Arm},
+    {"DISARM", FlightCommandType::Disarm},
+    {"TAKEOFF", FlightCommandType::Takeoff},
+    {"LAND", FlightCommandType::Land},
+    {"RTL", FlightCommandType::ReturnToLaunch},
+    {"RETURN_TO_LAUNCH", FlightCommandType::ReturnToLaunch},
+    {"OFFBOARD", FlightCommandType::Offboard},
+};
+
+// 命令载荷的 SAX 处理器：只取顶层 type / targetAlt / requestId，嵌套值跳过
+class CommandSax : public nlohmann::json_sax<nlohmann::json> {
+public:
+    std::string type;
+    std::string requestId;
+    double targetAlt{0.0};
+    bool hasType{false};
+    bool error{false};
+    std::string errorMessage;
+
+    bool null() override { return value(); }
+    bool boolean(bool) override { return value(); }
+    bool number_integer(number_integer_t val) override { return number(static_cast<double>(val)); }
+    bool number_unsigned(number_unsigned_t val) override { return number(static_cast<double>(val)); }
+    bool number_float(number_float_t val, const string_t&) override { return number(val); }
+    bool binary(binary_t&) override { return value(); }
+    bool string(string_t& val) override {
+        if (depth_ == 1 && key_ == Key::Type) {
+            type.swap(val);
+            hasType = true;
+        } else if (depth_ == 1 && key_ == Key::RequestId) {
+            requestId.swap(val);
+        }
+        return value();
+    }
+    bool start_object(std::size_t) override { return open(); }
+    bool end_object() override { return close(); }
+    bool start_array(std::size_t) override { return open(); }
+    bool end_array() override { return close(); }
+    bool key(string_t& val) override {
+        key_ = Key::Other;
+        if (depth_ == 1) {
+            if (val == "type") key_ = Key::Type;
+            else if (val == "targetAlt") key_ = Key::TargetAlt;
+            else if (val == "requestId") key_ = Key::RequestId;
+        }
+        return true;
+    }
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        error = true;
+        errorMessage = ex.what();
+        return false;
+    }
+
+private:
+    enum class Key { Other, Type, TargetAlt, RequestId };
+
+    bool number(double val) {
+        if (depth_ == 1 && key_ == Key::TargetAlt) {
+            targetAlt = val;
+        }
+        return value();
+    }
+    bool value() {
+        key_ = Key::Other;
+        return true;
+    }
+    bool open() {
+        key_ = Key::Other;
+        ++depth_;
+        return true;
+    }
+    bool close() {
+        --depth_;
+        return true;
+    }
+
+    int depth_{0};
+    Key key_{Key::Other};
+};
+
+} // namespace
+
+RequestIdWindow::RequestIdWindow(std::size_t capacity, std::int64_t ttlNs)
+    : order_(std::max<std::size_t>(capacity, 1)), ttlNs_(ttlNs) {
+    std::size_t tableSize = 1;
+    while (tableSize < order_.size() * 2) {
+        tableSize <<= 1;
+    }
+    table_.resize(tableSize);
+}
+
+std::uint64_t RequestIdWindow::hashOf(std::string_view requestId) noexcept {
+    // FNV-1a；0 保留为空槽标记
+    std::uint64_t h = 1469598103934665603ull;
+    for (char c : requestId) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    return h != 0 ? h : 1;
+}
+
+std::size_t RequestIdWindow::find(std::uint64_t hash) const noexcept {
+    const std::size_t mask = table_.size() - 1;
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+        if (table_[i].hash == hash) return i;
+        if (table_[i].hash == 0) return table_.size();
+    }
+}
+
+bool RequestIdWindow::contains(std::string_view requestId, std::int64_t nowNs) const {
+    const std::size_t i = find(hashOf(requestId));
+    return i < table_.size() && nowNs - table_[i].insertedNs <= ttlNs_;
+}
+
+void RequestIdWindow::insert(std::string_view requestId, std::int64_t nowNs) {
+    const std::uint64_t hash = hashOf(requestId);
+    const std::size_t existing = find(hash);
+    if (existing < table_.size()) {
+        table_[existing].insertedNs = nowNs;
+        return;
+    }
+    if (count_ == order_.size()) {
+        erase(order_[head_]);
+        head_ = (head_ + 1) % order_.size();
+        --count_;
+    }
+    const std::size_t mask = table_.size() - 1;
+    std::size_t i = hash & mask;
+    while (table_[i].hash != 0) {
+        i = (i + 1) & mask;
+    }
+    table_[i] = Slot{hash, nowNs};
+    order_[(head_ + count_) % order_.size()] = hash;
+    ++count_;
+}
+
+void RequestIdWindow::erase(std::uint64_t hash) noexcept {
+    std::size_t hole = find(hash);
+    if (hole >= table_.size()) {
+        return;
+    }
+    // 后移删除：把探测链上本该位于空洞之前的记录移入空洞，保持线性探测的可达性
+    const std::size_t mask = table_.size() - 1;
+    for (std::size_t j = (hole + 1) & mask; table_[j].hash != 0; j = (j + 1) & mask) {
+        const std::size_t home = table_[j].hash & mask;
+        const bool movable = hole <= j ? (home <= hole || home > j) : (home <= hole && home > j);
+        if (movable) {
+            table_[hole] = table_[j];
+            hole = j;
+        }
+    }
+    table_[hole] = Slot{};
+}
+
+CommandHandler::CommandHandler() : CommandHandler(Config{}) {}
+
+CommandHandler::CommandHandler(const Config& config)
+    : config_(config)
+    , executed_(config.dedupCapacity, static_cast<std::int64_t>(config.dedupWindowMs) * 1000000) {
 }
 
 CommandHandler::~CommandHandler() {
@@ -19,87 +198,93 @@ void CommandHandler::setFlightConnectionService(std::shared_ptr<FlightConnection
     flightService_ = service;
 }
 
+CommandHandlerStats CommandHandler::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
 bool CommandHandler::handleCommand(const DownlinkMessage& msg) {
+    const std::int64_t startNs = steadyNowNs();
+    FlightCommand cmd;
+    std::string requestId;
+    const bool parsed = parseCommand(msg.payload, cmd, requestId);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++stats_.received;
+    if (!parsed) {
+        ++stats_.parseErrors;
+        lock.unlock();
+        std::cerr << "[CommandHandler] Failed to parse command JSON: " << msg.payload << std::endl;
+        return false;
+    }
+    if (!requestId.empty() && executed_.contains(requestId, startNs)) {
+        ++stats_.duplicates;
+        lock.unlock();
+        std::cout << "[CommandHandler] Duplicate command ignored (requestId=" << requestId << ")" << std::endl;
+        return true;
+    }
+
     if (!flightService_) {
+        ++stats_.failed;
+        lock.unlock();
         std::cerr << "[CommandHandler] FlightConnectionService not set" << std::endl;
         return false;
     }
 
     if (!flightService_->isConnected()) {
+        ++stats_.failed;
+        lock.unlock();
         std::cerr << "[CommandHandler] FlightConnectionService not connected" << std::endl;
         return false;
     }
 
-    FlightCommand cmd;
-    if (!parseCommandJson(msg.payload, cmd)) {
-        std::cerr << "[CommandHandler] Failed to parse command JSON: " << msg.payload << std::endl;
-        return false;
+    const bool success = flightService_->sendCommand(cmd);
+    const auto latencyUs = static_cast<std::uint64_t>((steadyNowNs() - startNs) / 1000);
+    if (success) {
+        if (!requestId.empty()) {
+            executed_.insert(requestId, startNs);
+        }
+        ++stats_.executed;
+        stats_.lastLatencyUs = latencyUs;
+        stats_.maxLatencyUs = std::max(stats_.maxLatencyUs, latencyUs);
+        stats_.totalLatencyUs += latencyUs;
+    } else {
+        ++stats_.failed;  // 未记入窗口：重传的同一命令会再次尝试
     }
+    lock.unlock();
 
-    std::cout << "[CommandHandler] Executing command: "
-              << static_cast<int>(cmd.type) << " (targetAlt=" << cmd.targetAlt << ")" << std::endl;
-
-    bool success = flightService_->sendCommand(cmd);
     if (success) {
-        std::cout << "[CommandHandler] Command sent successfully" << std::endl;
+        std::cout << "[CommandHandler] Command " << static_cast<int>(cmd.type) << " (targetAlt=" << cmd.targetAlt
+                  << ") sent in " << latencyUs << " us" << std::endl;
     } else {
         std::cerr << "[CommandHandler] Failed to send command" << std::endl;
     }
-
     return success;
 }
 
-bool CommandHandler::parseCommandJson(const std::string& jsonPayload, FlightCommand& cmd) {
-    try {
-        // 使用 nlohmann/json 解析 JSON
-        auto json = nlohmann::json::parse(jsonPayload);
-
-        // 提取 type 字段
-        std::string typeStr;
-        if (json.contains("type") && json["type"].is_string()) {
-            typeStr = json["type"].get<std::string>();
-        } else {
-            std::cerr << "[CommandHandler] Missing or invalid 'type' field" << std::endl;
-            return false;
-        }
-
-        // 提取 targetAlt 字段（可选）
-        double targetAlt = 0.0;
-        if (json.contains("targetAlt") && json["targetAlt"].is_number()) {
-            targetAlt = json["targetAlt"].get<double>();
-        }
-
-        // 转换为 FlightCommandType（支持大小写不敏感）
-        std::string typeUpper = typeStr;
-        std::transform(typeUpper.begin(), typeUpper.end(), typeUpper.begin(), ::toupper);
-
-        if (typeUpper == "ARM") {
-            cmd.type = FlightCommandType::Arm;
-        } else if (typeUpper == "DISARM") {
-            cmd.type = FlightCommandType::Disarm;
-        } else if (typeUpper == "TAKEOFF") {
-            cmd.type = FlightCommandType::Takeoff;
-            cmd.targetAlt = targetAlt;
-        } else if (typeUpper == "LAND") {
-            cmd.type = FlightCommandType::Land;
-        } else if (typeUpper == "RTL" || typeUpper == "RETURN_TO_LAUNCH") {
-            cmd.type = FlightCommandType::ReturnToLaunch;
-        } else {
-            std::cerr << "[CommandHandler] Unknown command type: " << typeStr << std::endl;
-            return false;
-        }
-
-        return true;
-    } catch (const nlohmann::json::parse_error& e) {
-        std::cerr << "[CommandHandler] JSON parse error: " << e.what() << std::endl;
+bool CommandHandler::parseCommand(std::string_view jsonPayload, FlightCommand& cmd, std::string& requestId) {
+    CommandSax sax;
+    nlohmann::json::sax_parse(jsonPayload.data(), jsonPayload.data() + jsonPayload.size(), &sax);
+    if (sax.error) {
+        std::cerr << "[CommandHandler] JSON parse error: " << sax.errorMessage << std::endl;
         return false;
-    } catch (const nlohmann::json::type_error& e) {
-        std::cerr << "[CommandHandler] JSON type error: " << e.what() << std::endl;
+    }
+    if (!sax.hasType) {
+        std::cerr << "[CommandHandler] Missing or invalid 'type' field" << std::endl;
         return false;
-    } catch (const std::exception& e) {
-        std::cerr << "[CommandHandler] Error parsing command JSON: " << e.what() << std::endl;
+    }
+
+    // 转换为 FlightCommandType（支持大小写不敏感）
+    const auto it = std::find_if(std::begin(kCommandNames), std::end(kCommandNames),
+                                 [&](const CommandName& entry) { return equalsIgnoreCase(entry.name, sax.type); });
+    if (it == std::end(kCommandNames)) {
+        std::cerr << "[CommandHandler] Unknown command type: " << sax.type << std::endl;
         return false;
     }
+    cmd.type = it->type;
+    cmd.targetAlt = cmd.type == FlightCommandType::Takeoff ? sax.targetAlt : 0.0;
+    requestId = std::move(sax.requestId);
+    return true;
 }
 
 } // namespace nodeagent
@@ -0,0 +1,553 @@
+#include "nodeagent/DefinitionTransfer.h"
+#include "nodeagent/Logger.h"
+#include "nodeagent/Sha256.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace nodeagent {
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+// partial/<sha256>.map：固定头 + 每个分块一个字节（1 表示已写入 .part）
+constexpr char kMapMagic[4] = {'F', 'M', 'D', 'T'};
+constexpr std::size_t kMapHeaderBytes = 24;  // magic(4) | kind(1) | 保留(3) | size(u64) | chunkSize(u64)
+constexpr std::uint32_t kMaxChunks = 65536;
+constexpr std::size_t kMaxMissingReported = 1024;  // 单条 need 状态最多列出的缺失分块
+
+bool isHexDigest(const std::string& s) {
+    return s.size() == 64 && std::all_of(s.begin(), s.end(), [](char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+    });
+}
+
+std::string lowercase(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+bool base64Decode(const std::string& in, std::string& out) {
+    static const auto table = []() {
+        std::array<std::int8_t, 256> t{};
+        t.fill(-1);
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; ++i) {
+            t[static_cast<unsigned char>(alphabet[i])] = static_cast<std::int8_t>(i);
+        }
+        return t;
+    }();
+    if (in.size() % 4 != 0) {
+        return false;
+    }
+    out.clear();
+    out.reserve(in.size() / 4 * 3);
+    for (std::size_t i = 0; i < in.size(); i += 4) {
+        std::uint32_t v = 0;
+        int pad = 0;
+        for (std::size_t j = 0; j < 4; ++j) {
+            const char c = in[i + j];
+            if (c == '=' && i + 4 == in.size() && j >= 2) {
+                ++pad;
+                v <<= 6;
+                continue;
+            }
+            const std::int8_t d = table[static_cast<unsigned char>(c)];
+            if (d < 0 || pad > 0) {
+                return false;
+            }
+            v = (v << 6) | static_cast<std::uint32_t>(d);
+        }
+        out.push_back(static_cast<char>((v >> 16) & 0xFF));
+        if (pad < 2) out.push_back(static_cast<char>((v >> 8) & 0xFF));
+        if (pad < 1) out.push_back(static_cast<char>(v & 0xFF));
+    }
+    return true;
+}
+
+bool preadAll(int fd, char* data, std::size_t size, off_t offset) {
+    while (size > 0) {
+        const ssize_t n = ::pread(fd, data, size, offset);
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+        offset += n;
+    }
+    return true;
+}
+
+bool pwriteAll(int fd, const char* data, std::size_t size, off_t offset) {
+    while (size > 0) {
+        const ssize_t n = ::pwrite(fd, data, size, offset);
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+        offset += n;
+    }
+    return true;
+}
+
+bool readFile(const std::string& path, std::string& content) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    const off_t size = ::lseek(fd, 0, SEEK_END);
+    bool ok = size >= 0;
+    if (ok) {
+        content.resize(static_cast<std::size_t>(size));
+        ok = preadAll(fd, content.data(), content.size(), 0);
+    }
+    ::close(fd);
+    return ok;
+}
+
+void putU64(char* p, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    }
+}
+
+std::uint64_t getU64(const char* p) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) {
+        v |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return v;
+}
+
+} // namespace
+
+const char* definitionKindName(DefinitionKind kind) noexcept {
+    return kind == DefinitionKind::Mission ? "mission" : "flow";
+}
+
+struct DefinitionTransfer::Partial {
+    DefinitionKind kind{DefinitionKind::Flow};
+    std::size_t size{0};
+    std::size_t chunkSize{0};
+    std::uint32_t chunkCount{0};
+    std::vector<std::uint8_t> received;
+    std::uint32_t receivedCount{0};
+    int dataFd{-1};
+    int mapFd{-1};
+
+    ~Partial() {
+        if (dataFd >= 0) ::close(dataFd);
+        if (mapFd >= 0) ::close(mapFd);
+    }
+
+    std::size_t chunkLength(std::uint32_t index) const {
+        const std::size_t offset = static_cast<std::size_t>(index) * chunkSize;
+        return std::min(chunkSize, size - offset);
+    }
+};
+
+struct DefinitionTransfer::Request {
+    std::string op;
+    std::string sha256;
+    std::string kind;
+    std::size_t size{0};
+    std::size_t chunkSize{0};
+    std::int64_t index{-1};
+    std::string chunkSha256;
+    std::string data;
+};
+
+std::unique_ptr<DefinitionTransfer> DefinitionTransfer::open(const DefinitionTransferConfig& config) {
+    if (config.directory.empty()) {
+        return nullptr;
+    }
+    std::error_code ec;
+    fs::create_directories(fs::path(config.directory) / "objects", ec);
+    fs::create_directories(fs::path(config.directory) / "partial", ec);
+    if (ec || !fs::is_directory(fs::path(config.directory) / "partial", ec)) {
+        LOG_ERROR("DefinitionTransfer", "Cannot create cache directory: " + config.directory);
+        return nullptr;
+    }
+    return std::unique_ptr<DefinitionTransfer>(new DefinitionTransfer(config));
+}
+
+DefinitionTransfer::DefinitionTransfer(const DefinitionTransferConfig& config) : config_(config) {}
+
+DefinitionTransfer::~DefinitionTransfer() = default;
+
+void DefinitionTransfer::setDeployCallback(DeployFn callback) {
+    deployCallback_ = std::move(callback);
+}
+
+void DefinitionTransfer::setStatusCallback(StatusFn callback) {
+    statusCallback_ = std::move(callback);
+}
+
+bool DefinitionTransfer::handleMessage(const DownlinkMessage& msg) {
+    Request request;
+    try {
+        const json j = json::parse(msg.payload);
+        request.op = j.value("op", std::string());
+        request.sha256 = lowercase(j.value("sha256", std::string()));
+        request.kind = j.value("kind", std::string("flow"));
+        request.size = j.value("size", static_cast<std::size_t>(0));
+        request.chunkSize = j.value("chunk_size", static_cast<std::size_t>(0));
+        request.index = j.value("index", static_cast<std::int64_t>(-1));
+        request.chunkSha256 = lowercase(j.value("chunk_sha256", std::string()));
+        request.data = j.value("data", std::string());
+    } catch (const std::exception& e) {
+        LOG_WARN("DefinitionTransfer", "Invalid transfer message: " + std::string(e.what()));
+        return false;
+    }
+    if (!isHexDigest(request.sha256)) {
+        LOG_WARN("DefinitionTransfer", "Transfer message without a valid sha256");
+        return false;
+    }
+
+    if (request.op == "begin") {
+        return handleBegin(msg, request);
+    }
+    if (request.op == "chunk") {
+        return handleChunk(msg, request);
+    }
+    if (request.op == "abort") {
+        handleAbort(request);
+        return true;
+    }
+    LOG_WARN("DefinitionTransfer", "Unknown transfer op: " + request.op);
+    return false;
+}
+
+bool DefinitionTransfer::handleBegin(const DownlinkMessage& msg, const Request& request) {
+    DefinitionTransferStatus status;
+    status.sha256 = request.sha256;
+    status.requestId = msg.requestId;
+    if (request.kind == "mission") {
+        status.kind = DefinitionKind::Mission;
+    } else if (request.kind != "flow") {
+        status.state = "failed";
+        status.error = "unknown kind: " + request.kind;
+        report(status);
+        return false;
+    }
+
+    const std::size_t chunkCount =
+        request.chunkSize == 0 ? 0 : (request.size + request.chunkSize - 1) / request.chunkSize;
+    if (request.size == 0 || request.size > config_.maxObjectBytes || request.chunkSize == 0 ||
+        request.chunkSize > config_.maxChunkBytes || chunkCount > kMaxChunks) {
+        status.state = "failed";
+        status.error = "size or chunk_size out of range";
+        report(status);
+        return false;
+    }
+
+    std::string content;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.begins;
+
+        // 内容已在缓存中：不传输分块，直接部署
+        const std::string path = objectPath(request.sha256);
+        if (readFile(path, content)) {
+            std::error_code ec;
+            fs::last_write_time(path, fs::file_time_type::clock::now(), ec);  // 淘汰按最近使用时间
+            ++stats_.cacheHits;
+            status.state = "cached";
+            status.chunks = status.received = static_cast<std::uint32_t>(chunkCount);
+        } else {
+            Partial* partial = openPartial(request.sha256, status.kind, request.size, request.chunkSize);
+            if (!partial) {
+                status.state = "failed";
+                status.error = "cannot create partial transfer";
+            } else if (partial->receivedCount == partial->chunkCount) {
+                // 分块已全部落盘但入库前中断（如进程重启）
+                fillStatus(*partial, status);
+                if (commitPartial(request.sha256, *partial, content, status.error)) {
+                    status.state = "complete";
+                } else {
+                    status.state = "failed";
+                }
+            } else {
+                if (partial->receivedCount > 0) {
+                    ++stats_.resumed;
+                }
+                fillStatus(*partial, status);
+                status.state = "need";
+            }
+        }
+    }
+
+    if (status.state == "cached" || status.state == "complete") {
+        deployAndReport(std::move(status), std::move(content), msg);
+    } else {
+        report(status);
+    }
+    return status.state != "failed";
+}
+
+bool DefinitionTransfer::handleChunk(const DownlinkMessage& msg, const Request& request) {
+    DefinitionTransferStatus status;
+    status.sha256 = request.sha256;
+    status.requestId = msg.requestId;
+    std::string content;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Partial* partial = findPartial(request.sha256);
+        if (!partial) {
+            std::error_code ec;
+            if (fs::exists(objectPath(request.sha256), ec)) {
+                return true;  // 已入库后迟到的重复分块
+            }
+            status.state = "failed";
+            status.error = "unknown transfer, send begin";
+            ++stats_.chunksRejected;
+        } else if (request.index < 0 || request.index >= static_cast<std::int64_t>(partial->chunkCount)) {
+            ++stats_.chunksRejected;
+            return false;
+        } else {
+            const auto index = static_cast<std::uint32_t>(request.index);
+            status.kind = partial->kind;
+            if (partial->received[index]) {
+                return true;  // 重传的分块
+            }
+
+            std::string data;
+            const bool valid = base64Decode(request.data, data) && data.size() == partial->chunkLength(index) &&
+                               Sha256::hex(data) == request.chunkSha256;
+            const off_t offset = static_cast<off_t>(index) * static_cast<off_t>(partial->chunkSize);
+            const char mark = 1;
+            if (!valid) {
+                ++stats_.chunksRejected;
+                fillStatus(*partial, status);
+                status.state = "need";
+                status.error = "chunk " + std::to_string(index) + " rejected";
+            } else if (!pwriteAll(partial->dataFd, data.data(), data.size(), offset) ||
+                       !pwriteAll(partial->mapFd, &mark, 1, static_cast<off_t>(kMapHeaderBytes + index))) {
+                ++stats_.chunksRejected;
+                fillStatus(*partial, status);
+                status.state = "need";
+                status.error = "cannot write chunk " + std::to_string(index);
+            } else {
+                partial->received[index] = 1;
+                ++partial->receivedCount;
+                ++stats_.chunksReceived;
+                if (partial->receivedCount < partial->chunkCount) {
+                    return true;  // 其余分块到达前不逐块回复
+                }
+                fillStatus(*partial, status);
+                status.state = commitPartial(request.sha256, *partial, content, status.error) ? "complete" : "failed";
+            }
+        }
+    }
+
+    if (status.state == "complete") {
+        deployAndReport(std::move(status), std::move(content), msg);
+        return true;
+    }
+    report(status);
+    return status.state != "failed";
+}
+
+void DefinitionTransfer::handleAbort(const Request& request) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    discardPartial(request.sha256);
+}
+
+bool DefinitionTransfer::hasObject(const std::string& sha256) const {
+    std::error_code ec;
+    return isHexDigest(sha256) && fs::exists(objectPath(sha256), ec);
+}
+
+bool DefinitionTransfer::loadObject(const std::string& sha256, std::string& content) const {
+    return isHexDigest(sha256) && readFile(objectPath(sha256), content);
+}
+
+DefinitionTransferStats DefinitionTransfer::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+DefinitionTransfer::Partial* DefinitionTransfer::findPartial(const std::string& sha256) {
+    auto it = partials_.find(sha256);
+    if (it != partials_.end()) {
+        return it->second.get();
+    }
+
+    // 进程重启后从磁盘恢复部分传输
+    auto partial = std::make_unique<Partial>();
+    partial->mapFd = ::open(partialPath(sha256, ".map").c_str(), O_RDWR | O_CLOEXEC);
+    partial->dataFd = ::open(partialPath(sha256, ".part").c_str(), O_RDWR | O_CLOEXEC);
+    if (partial->mapFd < 0 || partial->dataFd < 0) {
+        return nullptr;
+    }
+    char header[kMapHeaderBytes];
+    if (!preadAll(partial->mapFd, header, sizeof(header), 0) || std::memcmp(header, kMapMagic, 4) != 0) {
+        return nullptr;
+    }
+    partial->kind = header[4] == 1 ? DefinitionKind::Mission : DefinitionKind::Flow;
+    partial->size = static_cast<std::size_t>(getU64(header + 8));
+    partial->chunkSize = static_cast<std::size_t>(getU64(header + 16));
+    if (partial->size == 0 || partial->size > config_.maxObjectBytes || partial->chunkSize == 0 ||
+        partial->chunkSize > config_.maxChunkBytes) {
+        return nullptr;
+    }
+    partial->chunkCount = static_cast<std::uint32_t>((partial->size + partial->chunkSize - 1) / partial->chunkSize);
+    partial->received.assign(partial->chunkCount, 0);
+    if (!preadAll(partial->mapFd, reinterpret_cast<char*>(partial->received.data()), partial->chunkCount,
+                  static_cast<off_t>(kMapHeaderBytes))) {
+        return nullptr;
+    }
+    partial->receivedCount =
+        static_cast<std::uint32_t>(std::count_if(partial->received.begin(), partial->received.end(),
+                                                 [](std::uint8_t b) { return b != 0; }));
+    Partial* raw = partial.get();
+    partials_[sha256] = std::move(partial);
+    return raw;
+}
+
+DefinitionTransfer::Partial* DefinitionTransfer::openPartial(const std::string& sha256, DefinitionKind kind,
+                                                             std::size_t size, std::size_t chunkSize) {
+    Partial* existing = findPartial(sha256);
+    if (existing && existing->kind == kind && existing->size == size && existing->chunkSize == chunkSize) {
+        return existing;
+    }
+    discardPartial(sha256);  // 参数不同：重新开始
+
+    auto partial = std::make_unique<Partial>();
+    partial->kind = kind;
+    partial->size = size;
+    partial->chunkSize = chunkSize;
+    partial->chunkCount = static_cast<std::uint32_t>((size + chunkSize - 1) / chunkSize);
+    partial->received.assign(partial->chunkCount, 0);
+    partial->dataFd = ::open(partialPath(sha256, ".part").c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    partial->mapFd = ::open(partialPath(sha256, ".map").c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (partial->dataFd < 0 || partial->mapFd < 0 || ::ftruncate(partial->dataFd, static_cast<off_t>(size)) != 0) {
+        LOG_ERROR("DefinitionTransfer", "Cannot create partial transfer for " + sha256 + ": " + std::strerror(errno));
+        return nullptr;
+    }
+    std::vector<char> map(kMapHeaderBytes + partial->chunkCount, 0);
+    std::memcpy(map.data(), kMapMagic, 4);
+    map[4] = kind == DefinitionKind::Mission ? 1 : 0;
+    putU64(map.data() + 8, size);
+    putU64(map.data() + 16, chunkSize);
+    if (!pwriteAll(partial->mapFd, map.data(), map.size(), 0)) {
+        LOG_ERROR("DefinitionTransfer", "Cannot write chunk map for " + sha256);
+        return nullptr;
+    }
+    Partial* raw = partial.get();
+    partials_[sha256] = std::move(partial);
+    return raw;
+}
+
+void DefinitionTransfer::discardPartial(const std::string& sha256) {
+    partials_.erase(sha256);
+    std::error_code ec;
+    fs::remove(partialPath(sha256, ".part"), ec);
+    fs::remove(partialPath(sha256, ".map"), ec);
+}
+
+bool DefinitionTransfer::commitPartial(const std::string& sha256, Partial& partial, std::string& content,
+                                       std::string& error) {
+    content.resize(partial.size);
+    const bool read = preadAll(partial.dataFd, content.data(), content.size(), 0);
+    if (!read || Sha256::hex(content) != sha256) {
+        error = read ? "sha256 mismatch" : "cannot read partial transfer";
+        LOG_WARN("DefinitionTransfer", "Transfer " + sha256 + " failed: " + error);
+        ++stats_.failed;
+        content.clear();
+        discardPartial(sha256);
+        return false;
+    }
+
+    std::error_code ec;
+    fs::rename(partialPath(sha256, ".part"), objectPath(sha256), ec);
+    if (ec) {
+        // 无法入库时仍部署本次收到的内容，下次 begin 重新传输
+        LOG_WARN("DefinitionTransfer", "Cannot store object " + sha256 + ": " + ec.message());
+    }
+    discardPartial(sha256);
+    ++stats_.completed;
+    evictObjects(sha256);
+    return true;
+}
+
+void DefinitionTransfer::evictObjects(const std::string& keep) {
+    struct Entry {
+        fs::file_time_type mtime;
+        std::uintmax_t size;
+        fs::path path;
+    };
+    std::vector<Entry> entries;
+    std::uintmax_t total = 0;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(fs::path(config_.directory) / "objects", ec)) {
+        if (!entry.is_regular_file(ec)) {
+            continue;
+        }
+        Entry e{entry.last_write_time(ec), entry.file_size(ec), entry.path()};
+        total += e.size;
+        if (e.path.filename() != keep) {
+            entries.push_back(std::move(e));
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+    for (const auto& e : entries) {
+        if (total <= config_.maxCacheBytes) {
+            break;
+        }
+        if (fs::remove(e.path, ec)) {
+            total -= e.size;
+            ++stats_.evicted;
+        }
+    }
+}
+
+void DefinitionTransfer::fillStatus(const Partial& partial, DefinitionTransferStatus& status) const {
+    status.kind = partial.kind;
+    status.chunks = partial.chunkCount;
+    status.received = partial.receivedCount;
+    status.missing.clear();
+    for (std::uint32_t i = 0; i < partial.chunkCount && status.missing.size() < kMaxMissingReported; ++i) {
+        if (!partial.received[i]) {
+            status.missing.push_back(i);
+        }
+    }
+}
+
+void DefinitionTransfer::deployAndReport(DefinitionTransferStatus status, std::string content,
+                                         const DownlinkMessage& request) {
+    if (deployCallback_) {
+        status.deployed = deployCallback_(status.kind, status.sha256, std::move(content), request);
+    }
+    LOG_INFO("DefinitionTransfer", std::string(definitionKindName(status.kind)) + " " + status.sha256.substr(0, 12) +
+                                       " " + status.state + (status.deployed ? ", deployed" : ""));
+    report(status);
+}
+
+void DefinitionTransfer::report(const DefinitionTransferStatus& status) {
+    if (statusCallback_) {
+        statusCallback_(status);
+    }
+}
+
+std::string DefinitionTransfer::objectPath(const std::string& sha256) const {
+    return (fs::path(config_.directory) / "objects" / sha256).string();
+}
+
+std::string DefinitionTransfer::partialPath(const std::string& sha256, const char* suffix) const {
+    return (fs::path(config_.directory) / "partial" / (sha256 + suffix)).string();
+}
+
+} // namespace nodeagent
@@ -1,9 +1,13 @@
 #include "nodeagent/DownlinkClient.h"
+#include "nodeagent/PayloadCompression.h"
 #include <nlohmann/json.hpp>
 
 #include <sys/socket.h>
 #include <sys/select.h>
 #include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
 #include <cstring>
 #include <iostream>
 #include <sstream>
@@ -11,6 +15,127 @@
 
 namespace nodeagent {
 
+namespace {
+
+constexpr std::size_t kReceiveChunkBytes = 16 * 1024;  // 每次 recv 至少预留的空间
+constexpr std::size_t kLogPayloadBytes = 256;          // 日志中最多打印的载荷长度
+
+bool startsWith(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+// 只提取顶层 uavId / requestId 的 SAX 处理器：两者都拿到后立即停止，不为大型载荷构建 DOM
+// （载荷由 CommandHandler / MissionHandler / FlowHandler 按各自的结构再解析）
+// 命令（commandFields 为 true）另外提取顶层 type / priority 用于判断优先级；命令很小，解析完整个对象
+class EnvelopeSax : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit EnvelopeSax(bool commandFields = false) : commandFields_(commandFields) {}
+
+    std::string uavId;
+    std::string requestId;
+    std::string commandType;
+    std::string priority;
+    bool hasUavId{false};
+    bool hasRequestId{false};
+    bool error{false};
+    std::string errorMessage;
+
+    bool done() const { return hasUavId && hasRequestId && !commandFields_; }
+
+    bool null() override { return value(); }
+    bool boolean(bool) override { return value(); }
+    bool number_integer(number_integer_t) override { return value(); }
+    bool number_unsigned(number_unsigned_t) override { return value(); }
+    bool number_float(number_float_t, const string_t&) override { return value(); }
+    bool binary(binary_t&) override { return value(); }
+    bool string(string_t& val) override {
+        if (depth_ == 1 && key_ == Key::UavId) {
+            uavId = val;
+            hasUavId = true;
+        } else if (depth_ == 1 && key_ == Key::RequestId) {
+            requestId = val;
+            hasRequestId = true;
+        } else if (depth_ == 1 && key_ == Key::Type) {
+            commandType = val;
+        } else if (depth_ == 1 && key_ == Key::Priority) {
+            priority = val;
+        }
+        return value();
+    }
+    bool start_object(std::size_t) override { return open(); }
+    bool end_object() override { return close(); }
+    bool start_array(std::size_t) override { return open(); }
+    bool end_array() override { return close(); }
+    bool key(string_t& val) override {
+        key_ = Key::Other;
+        if (depth_ == 1) {
+            if (val == "uavId") key_ = Key::UavId;
+            else if (val == "requestId") key_ = Key::RequestId;
+            else if (commandFields_ && val == "type") key_ = Key::Type;
+            else if (commandFields_ && val == "priority") key_ = Key::Priority;
+        }
+        return true;
+    }
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        error = true;
+        errorMessage = ex.what();
+        return false;
+    }
+
+private:
+    enum class Key { Other, UavId, RequestId, Type, Priority };
+
+    bool value() {
+        key_ = Key::Other;
+        return !done();  // 返回 false 结束解析
+    }
+    bool open() {
+        key_ = Key::Other;
+        ++depth_;
+        return true;
+    }
+    bool close() {
+        --depth_;
+        return true;
+    }
+
+    bool commandFields_;
+    int depth_{0};
+    Key key_{Key::Other};
+};
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::toupper(static_cast<unsigned char>(x)) == std::toupper(static_cast<unsigned char>(y));
+    });
+}
+
+bool isUrgentCommand(const EnvelopeSax& envelope) {
+    if (equalsIgnoreCase(envelope.priority, "urgent")) {
+        return true;
+    }
+    static constexpr std::string_view kUrgentTypes[] = {"RTL", "RETURN_TO_LAUNCH", "LAND", "DISARM", "ABORT"};
+    for (std::string_view type : kUrgentTypes) {
+        if (equalsIgnoreCase(envelope.commandType, type)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 0 其它消息 / 1 命令 / 2 紧急命令
+std::uint8_t messageClass(std::string_view message) {
+    if (!startsWith(message, "CMD:")) {
+        return 0;
+    }
+    const std::string_view payload = message.substr(4);
+    EnvelopeSax envelope(true);
+    nlohmann::json::sax_parse(payload.data(), payload.data() + payload.size(), &envelope);
+    return isUrgentCommand(envelope) ? 2 : 1;
+}
+
+} // namespace
+
 DownlinkClient::DownlinkClient(const Config& config)
     : config_(config) {
 }
@@ -28,6 +153,7 @@ bool DownlinkClient::connect(int existingSocketFd) {
     if (existingSocketFd >= 0) {
         // 复用现有 socket（双向通信）
         socketFd_ = existingSocketFd;
+        resetBuffer();
         connected_ = true;
         std::cout << "[DownlinkClient] Reusing existing socket for downlink" << std::endl;
         return true;
@@ -87,9 +213,6 @@ void DownlinkClient::stopReceiving() {
 }
 
 void DownlinkClient::receiveLoop() {
-    char buffer[4096];
-    std::string messageBuffer;
-
     while (receiving_ && connected_ && socketFd_ >= 0) {
         // 使用 select 或非阻塞 recv 来避免无限等待
         fd_set readFds;
@@ -108,109 +231,270 @@ void DownlinkClient::receiveLoop() {
             continue;  // 超时，继续循环
         }
 
-        if (FD_ISSET(socketFd_, &readFds)) {
-            ssize_t n = recv(socketFd_, buffer, sizeof(buffer) - 1, 0);
-            if (n <= 0) {
-                if (n == 0) {
-                    std::cout << "[DownlinkClient] Server closed connection" << std::endl;
-                }
+        if (FD_ISSET(socketFd_, &readFds) && !readAvailable()) {
+            break;
+        }
+    }
+}
+
+bool DownlinkClient::readAvailable() {
+    if (!connected_ || socketFd_ < 0) {
+        return false;
+    }
+
+    reserveTail(kReceiveChunkBytes);
+    ssize_t n = recv(socketFd_, rxBuffer_.data() + rxTail_, rxBuffer_.size() - rxTail_, MSG_DONTWAIT);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        return true;  // 虚假唤醒
+    }
+    if (n <= 0) {
+        if (n == 0) {
+            std::cout << "[DownlinkClient] Server closed connection" << std::endl;
+        }
+        resetBuffer();
+        return false;
+    }
+
+    rxTail_ += static_cast<std::size_t>(n);
+    if (!processBuffered()) {
+        resetBuffer();
+        return false;
+    }
+    return true;
+}
+
+bool DownlinkClient::feed(const void* data, std::size_t size) {
+    if (size == 0) {
+        return true;
+    }
+    reserveTail(size);
+    std::memcpy(rxBuffer_.data() + rxTail_, data, size);
+    rxTail_ += size;
+    if (!processBuffered()) {
+        resetBuffer();
+        return false;
+    }
+    return true;
+}
+
+void DownlinkClient::resetBuffer() {
+    rxHead_ = 0;
+    rxTail_ = 0;
+    rxScan_ = 0;
+}
+
+void DownlinkClient::reserveTail(std::size_t minFree) {
+    if (rxBuffer_.size() - rxTail_ >= minFree) {
+        return;
+    }
+    // 先把未消费的数据移到缓冲头部（只移动未完成的一条消息），仍不够时再扩容
+    if (rxHead_ > 0) {
+        std::memmove(rxBuffer_.data(), rxBuffer_.data() + rxHead_, rxTail_ - rxHead_);
+        rxTail_ -= rxHead_;
+        rxScan_ -= rxHead_;
+        rxHead_ = 0;
+    }
+    if (rxBuffer_.size() - rxTail_ < minFree) {
+        rxBuffer_.resize(std::max(rxBuffer_.size() * 2, rxTail_ + minFree));
+    }
+}
+
+bool DownlinkClient::processBuffered() {
+    const char* base = rxBuffer_.data();
+    rxBatch_.clear();
+    std::size_t frameShortfall = 0;  // 未收全的帧还差的字节数
+    bool ok = true;
+    while (rxHead_ < rxTail_) {
+        const std::size_t available = rxTail_ - rxHead_;
+        if (static_cast<std::uint8_t>(base[rxHead_]) == kDownlinkFrameMagic) {
+            // 长度前缀帧
+            if (available < kDownlinkFrameHeaderBytes) {
                 break;
             }
+            const auto* header = reinterpret_cast<const std::uint8_t*>(base + rxHead_);
+            const std::uint32_t field = static_cast<std::uint32_t>(header[1]) |
+                                        (static_cast<std::uint32_t>(header[2]) << 8) |
+                                        (static_cast<std::uint32_t>(header[3]) << 16) |
+                                        (static_cast<std::uint32_t>(header[4]) << 24);
+            const bool compressed = (field & kFrameCompressedFlag) != 0;
+            const std::size_t length = field & ~kFrameCompressedFlag;
+            if (length > config_.maxMessageBytes) {
+                std::cerr << "[DownlinkClient] Frame of " << length << " bytes exceeds limit ("
+                          << config_.maxMessageBytes << "), dropping connection" << std::endl;
+                ok = false;
+                break;
+            }
+            if (available < kDownlinkFrameHeaderBytes + length) {
+                frameShortfall = kDownlinkFrameHeaderBytes + length - available;
+                break;
+            }
+            rxHead_ += kDownlinkFrameHeaderBytes + length;
+            rxScan_ = rxHead_;
+            if (!compressed) {
+                rxBatch_.emplace_back(base + rxHead_ - length, length);
+                continue;
+            }
+            // 压缩帧：解压失败只丢弃这一条（分帧仍然完整），不断开连接
+            std::string message;
+            if (!codec_ || !codec_->decompress(base + rxHead_ - length, length, config_.maxMessageBytes, message)) {
+                std::cerr << "[DownlinkClient] Dropping undecodable compressed frame (" << length << " bytes)"
+                          << std::endl;
+                continue;
+            }
+            rxInflated_.push_back(std::move(message));
+            rxBatch_.emplace_back(rxInflated_.back());
+            continue;
+        }
 
-            buffer[n] = '\0';
-            messageBuffer += buffer;
-
-            // 处理完整的消息（以换行符分隔）
-            size_t pos;
-            while ((pos = messageBuffer.find('\n')) != std::string::npos) {
-                std::string message = messageBuffer.substr(0, pos);
-                messageBuffer.erase(0, pos + 1);
-
-                if (!message.empty()) {
-                    // 检查是否是下行消息（以 "CMD:" 或 "MISSION:" 开头）
-                    if (message.find("CMD:") == 0 || message.find("MISSION:") == 0) {
-                        parseAndHandleMessage(message);
-                    }
-                    // 检查是否是 ACK 响应（以 "ACK:" 开头）
-                    else if (message.find("ACK:") == 0) {
-                        handleAckMessage(message);
-                    }
-                    // 否则忽略（可能是上行 Telemetry 的响应）
-                }
+        // 换行分隔的文本行：从上次扫描结束处继续查找
+        const std::size_t from = std::max(rxScan_, rxHead_);
+        const void* newline = std::memchr(base + from, '\n', rxTail_ - from);
+        if (!newline) {
+            rxScan_ = rxTail_;
+            if (available > config_.maxMessageBytes) {
+                std::cerr << "[DownlinkClient] Line exceeds " << config_.maxMessageBytes
+                          << " bytes without newline, dropping connection" << std::endl;
+                ok = false;
             }
+            break;
+        }
+        const std::size_t pos = static_cast<std::size_t>(static_cast<const char*>(newline) - base);
+        std::string_view line(base + rxHead_, pos - rxHead_);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        rxHead_ = pos + 1;
+        rxScan_ = rxHead_;
+        if (!line.empty()) {
+            rxBatch_.push_back(line);
+        }
+    }
+    dispatchBatch();
+    rxInflated_.clear();
+    if (!ok) {
+        return false;
+    }
+    // 分发完成后才能移动缓冲
+    if (rxHead_ == rxTail_) {
+        resetBuffer();
+    } else if (frameShortfall > 0) {
+        // 一次预留整帧所需空间，避免大帧在接收过程中反复扩容
+        reserveTail(frameShortfall);
+    }
+    return true;
+}
+
+void DownlinkClient::dispatchBatch() {
+    if (rxBatch_.size() <= 1) {
+        if (!rxBatch_.empty()) {
+            dispatchMessage(rxBatch_.front());
+        }
+        return;
+    }
+    rxBatchClass_.resize(rxBatch_.size());
+    std::size_t lastUrgent = rxBatch_.size();
+    for (std::size_t i = 0; i < rxBatch_.size(); ++i) {
+        rxBatchClass_[i] = messageClass(rxBatch_[i]);
+        if (rxBatchClass_[i] == 2) {
+            lastUrgent = i;
+        }
+    }
+    if (lastUrgent == rxBatch_.size()) {
+        for (std::string_view message : rxBatch_) {
+            dispatchMessage(message);
+        }
+        return;
+    }
+    // 先分发最后一条紧急命令及其之前的所有命令（命令之间不换序，如 ARM 之后的 DISARM 仍在 ARM 之后），
+    // 再按到达顺序分发被越过的载荷与其后的消息
+    for (std::size_t i = 0; i <= lastUrgent; ++i) {
+        if (rxBatchClass_[i] != 0) {
+            dispatchMessage(rxBatch_[i]);
+        }
+    }
+    for (std::size_t i = 0; i < rxBatch_.size(); ++i) {
+        if (i > lastUrgent || rxBatchClass_[i] == 0) {
+            dispatchMessage(rxBatch_[i]);
         }
     }
 }
 
-void DownlinkClient::parseAndHandleMessage(const std::string& message) {
+void DownlinkClient::dispatchMessage(std::string_view message) {
+    if (message.empty()) {
+        return;
+    }
+    // 检查是否是下行消息（以 "CMD:" / "MISSION:" / "FLOW:" / "XFER:" 开头）
+    if (startsWith(message, "CMD:") || startsWith(message, "MISSION:") || startsWith(message, "FLOW:") ||
+        startsWith(message, "XFER:")) {
+        parseAndHandleMessage(message);
+    }
+    // 检查是否是 ACK 响应（以 "ACK:" 开头）
+    else if (startsWith(message, "ACK:")) {
+        handleAckMessage(message);
+    }
+    // 否则忽略（可能是上行 Telemetry 的响应）
+}
+
+void DownlinkClient::parseAndHandleMessage(std::string_view message) {
     if (!messageHandler_) {
         return;
     }
 
     DownlinkMessage msg;
-    
+    std::string_view payload;
+
     // 解析消息类型和载荷
-    if (message.find("CMD:") == 0) {
+    if (startsWith(message, "CMD:")) {
         msg.type = DownlinkMessageType::Command;
-        msg.payload = message.substr(4);  // 跳过 "CMD:" 前缀
-    } else if (message.find("MISSION:") == 0) {
+        payload = message.substr(4);  // 跳过 "CMD:" 前缀
+    } else if (startsWith(message, "MISSION:")) {
         msg.type = DownlinkMessageType::Mission;
-        msg.payload = message.substr(8);  // 跳过 "MISSION:" 前缀
-    } else if (message.find("FLOW:") == 0) {
+        payload = message.substr(8);  // 跳过 "MISSION:" 前缀
+    } else if (startsWith(message, "FLOW:")) {
         msg.type = DownlinkMessageType::Flow;
-        msg.payload = message.substr(5);  // 跳过 "FLOW:" 前缀
+        payload = message.substr(5);  // 跳过 "FLOW:" 前缀
+    } else if (startsWith(message, "XFER:")) {
+        msg.type = DownlinkMessageType::Transfer;
+        payload = message.substr(5);  // 跳过 "XFER:" 前缀
     } else {
         return;
     }
 
-    // 使用 nlohmann/json 解析 payload 中的 uavId 和 requestId
-    try {
-        auto json = nlohmann::json::parse(msg.payload);
-        
-        if (json.contains("uavId") && json["uavId"].is_string()) {
-            msg.uavId = json["uavId"].get<std::string>();
-        } else {
-            msg.uavId = "uav0";  // 默认值
-        }
-
-        if (json.contains("requestId") && json["requestId"].is_string()) {
-            msg.requestId = json["requestId"].get<std::string>();
-        } else {
-            // 如果没有 requestId，生成一个
-            msg.requestId = "req_" + std::to_string(time(nullptr));
-        }
-    } catch (const nlohmann::json::parse_error& e) {
+    // 原地扫描 payload 中的 uavId 和 requestId（命令另取 type / priority）
+    EnvelopeSax envelope(msg.type == DownlinkMessageType::Command);
+    nlohmann::json::sax_parse(payload.data(), payload.data() + payload.size(), &envelope);
+    if (envelope.error) {
         // JSON 解析失败，使用默认值
-        std::cerr << "[DownlinkClient] Failed to parse JSON payload: " << e.what() << std::endl;
-        msg.uavId = "uav0";
-        msg.requestId = "req_" + std::to_string(time(nullptr));
+        std::cerr << "[DownlinkClient] Failed to parse JSON payload: " << envelope.errorMessage << std::endl;
+    }
+    msg.uavId = envelope.hasUavId ? envelope.uavId : "uav0";  // 默认值
+    // 如果没有 requestId，生成一个
+    msg.requestId = envelope.hasRequestId ? envelope.requestId : "req_" + std::to_string(time(nullptr));
+    msg.payload.assign(payload.data(), payload.size());
+    if (msg.type == DownlinkMessageType::Command && isUrgentCommand(envelope)) {
+        msg.priority = DownlinkPriority::Urgent;
     }
 
     std::string typeStr = (msg.type == DownlinkMessageType::Command ? "Command" : 
-                          (msg.type == DownlinkMessageType::Mission ? "Mission" : "Flow"));
+                          (msg.type == DownlinkMessageType::Mission ? "Mission" :
+                          (msg.type == DownlinkMessageType::Flow ? "Flow" : "Transfer")));
     std::cout << "[DownlinkClient] Received " << typeStr
-              << " message (uavId=" << msg.uavId << ", requestId=" << msg.requestId << "): " 
-              << msg.payload << std::endl;
+              << " message (uavId=" << msg.uavId << ", requestId=" << msg.requestId << ", "
+              << payload.size() << " bytes): "
+              << payload.substr(0, kLogPayloadBytes) << (payload.size() > kLogPayloadBytes ? "..." : "")
+              << std::endl;
 
     messageHandler_(msg);
 }
 
-void DownlinkClient::handleAckMessage(const std::string& ackMessage) {
+void DownlinkClient::handleAckMessage(std::string_view ackMessage) {
     if (!ackHandler_) {
         return;
     }
 
-    // 解析 ACK 消息：ACK:{messageId}
-    if (ackMessage.find("ACK:") == 0) {
-        std::string messageId = ackMessage.substr(4);  // 跳过 "ACK:" 前缀
-        
-        // 移除可能的换行符
-        if (!messageId.empty() && messageId.back() == '\n') {
-            messageId.pop_back();
-        }
-        if (!messageId.empty() && messageId.back() == '\r') {
-            messageId.pop_back();
-        }
+    // 解析 ACK 消息：ACK:{messageId}（行尾换行与回车已在分帧时去除）
+    if (startsWith(ackMessage, "ACK:")) {
+        std::string messageId(ackMessage.substr(4));  // 跳过 "ACK:" 前缀
 
         std::cout << "[DownlinkClient] Received ACK: " << messageId << std::endl;
         ackHandler_(messageId);
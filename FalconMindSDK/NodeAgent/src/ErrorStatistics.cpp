@@ -1,7 +1,127 @@
 #include "nodeagent/ErrorStatistics.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
 namespace nodeagent {
 
-// ErrorStatistics 实现已在头文件中完成（单例模式）
+namespace {
+
+int64_t nowSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+std::size_t ErrorStatistics::slotOf(ErrorCode code) noexcept {
+    const auto value = static_cast<uint32_t>(code);
+    const uint32_t category = value >> 12;
+    const uint32_t index = value & 0xFFFu;
+    if (category >= kCategories || index >= kCodesPerCategory) {
+        return static_cast<std::size_t>(ErrorCode::UnknownError);
+    }
+    return category * kCodesPerCategory + index;
+}
+
+ErrorCode ErrorStatistics::codeOf(std::size_t slot) noexcept {
+    return static_cast<ErrorCode>(((slot / kCodesPerCategory) << 12) | (slot % kCodesPerCategory));
+}
+
+std::size_t ErrorStatistics::shardOfThisThread() noexcept {
+    static std::atomic<std::size_t> nextShard{0};
+    thread_local const std::size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return shard;
+}
+
+int64_t ErrorStatistics::countOf(std::size_t slot) const noexcept {
+    int64_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += shard.counts[slot].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void ErrorStatistics::recordError(ErrorCode code, const std::string& message) {
+    const std::size_t index = slotOf(code);
+    shards_[shardOfThisThread()].counts[index].fetch_add(1, std::memory_order_relaxed);
+
+    Slot& slot = slots_[index];
+    const int64_t now = nowSeconds();
+    // 秒级时间戳大多未变：只读不写，避免出错线程之间反复争抢同一缓存行
+    if (slot.lastOccurrence.load(std::memory_order_relaxed) != now) {
+        slot.lastOccurrence.store(now, std::memory_order_relaxed);
+    }
+
+    if (message.empty()) {
+        return;
+    }
+    int64_t lastSample = slot.lastSampleSec.load(std::memory_order_relaxed);
+    if (lastSample != 0 && now - lastSample < kMessageSampleSec) {
+        return;  // 本周期已有采样
+    }
+    if (!slot.lastSampleSec.compare_exchange_strong(lastSample, now, std::memory_order_relaxed)) {
+        return;  // 其他线程赢得了本周期的采样
+    }
+    if (slot.writing.exchange(true, std::memory_order_acquire)) {
+        return;
+    }
+    MessageSample sample{};
+    sample.length = static_cast<uint32_t>(std::min(message.size(), kMaxMessageBytes));
+    std::memcpy(sample.text, message.data(), sample.length);
+    slot.message.store(sample);
+    slot.writing.store(false, std::memory_order_release);
+}
+
+int64_t ErrorStatistics::getErrorCount(ErrorCode code) const {
+    return countOf(slotOf(code));
+}
+
+std::map<ErrorCode, ErrorStatsSummary> ErrorStatistics::getAllStats() const {
+    std::map<ErrorCode, ErrorStatsSummary> result;
+    for (std::size_t i = 0; i < kSlots; ++i) {
+        const int64_t count = countOf(i);
+        if (count == 0) {
+            continue;
+        }
+        const Slot& slot = slots_[i];
+        ErrorStatsSummary summary;
+        summary.count = count;
+        summary.lastOccurrence = slot.lastOccurrence.load(std::memory_order_relaxed);
+        if (slot.message.version() > 0) {
+            const MessageSample sample = slot.message.load();
+            summary.lastMessage.assign(sample.text, std::min<std::size_t>(sample.length, kMaxMessageBytes));
+        }
+        result[codeOf(i)] = std::move(summary);
+    }
+    return result;
+}
+
+void ErrorStatistics::reset() {
+    for (Shard& shard : shards_) {
+        for (auto& count : shard.counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (Slot& slot : slots_) {
+        slot.lastOccurrence.store(0, std::memory_order_relaxed);
+        slot.lastSampleSec.store(0, std::memory_order_relaxed);
+        if (!slot.writing.exchange(true, std::memory_order_acquire)) {
+            slot.message.store(MessageSample{});
+            slot.writing.store(false, std::memory_order_release);
+        }
+    }
+}
+
+int64_t ErrorStatistics::getTotalErrorCount() const {
+    int64_t total = 0;
+    for (const Shard& shard : shards_) {
+        for (const auto& count : shard.counts) {
+            total += count.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
 
 } // namespace nodeagent
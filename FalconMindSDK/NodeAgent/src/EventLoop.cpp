@@ -0,0 +1,248 @@
+#include "nodeagent/EventLoop.h"
+
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace nodeagent {
+
+namespace {
+
+constexpr int kMaxEvents = 32;
+
+itimerspec toTimerSpec(int delayMs, int intervalMs) {
+    itimerspec spec{};
+    // it_value 全 0 表示停止定时器，delayMs <= 0 时按 1 ns 立即触发
+    if (delayMs > 0) {
+        spec.it_value.tv_sec = delayMs / 1000;
+        spec.it_value.tv_nsec = static_cast<long>(delayMs % 1000) * 1000000L;
+    } else {
+        spec.it_value.tv_nsec = 1;
+    }
+    if (intervalMs > 0) {
+        spec.it_interval.tv_sec = intervalMs / 1000;
+        spec.it_interval.tv_nsec = static_cast<long>(intervalMs % 1000) * 1000000L;
+    }
+    return spec;
+}
+
+} // namespace
+
+EventLoop::EventLoop() {
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd_ < 0 || wakeFd_ < 0) {
+        std::cerr << "[EventLoop] Failed to create epoll/eventfd: " << std::strerror(errno) << std::endl;
+        return;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = wakeFd_;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &ev) < 0) {
+        std::cerr << "[EventLoop] Failed to register eventfd: " << std::strerror(errno) << std::endl;
+    }
+}
+
+EventLoop::~EventLoop() {
+    for (const auto& entry : handlers_) {
+        if (entry.second->timer) {
+            ::close(entry.first);
+        }
+    }
+    handlers_.clear();
+    if (wakeFd_ >= 0) ::close(wakeFd_);
+    if (epollFd_ >= 0) ::close(epollFd_);
+}
+
+bool EventLoop::addFd(int fd, std::uint32_t events, FdCallback callback) {
+    if (!valid() || fd < 0 || !callback) {
+        return false;
+    }
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        std::cerr << "[EventLoop] epoll_ctl ADD fd " << fd << " failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    auto handler = std::make_shared<Handler>();
+    handler->callback = std::move(callback);
+    handlers_[fd] = std::move(handler);
+    return true;
+}
+
+bool EventLoop::modifyFd(int fd, std::uint32_t events) {
+    if (handlers_.find(fd) == handlers_.end()) {
+        return false;
+    }
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = fd;
+    return epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &ev) == 0;
+}
+
+void EventLoop::removeFd(int fd) {
+    auto it = handlers_.find(fd);
+    if (it == handlers_.end()) {
+        return;
+    }
+    // fd 可能已被调用方关闭（内核已自动移出 epoll），EBADF / ENOENT 忽略
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+    handlers_.erase(it);
+}
+
+int EventLoop::addTimer(TimerCallback callback) {
+    if (!valid() || !callback) {
+        return -1;
+    }
+    const int tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (tfd < 0) {
+        std::cerr << "[EventLoop] timerfd_create failed: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+    auto onExpire = [tfd, cb = std::move(callback)](std::uint32_t) {
+        std::uint64_t expirations = 0;
+        if (::read(tfd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            return;  // 已被 disarm / 重新设置
+        }
+        cb();  // 周期定时器错过多次时只回调一次
+    };
+    if (!addFd(tfd, EPOLLIN, std::move(onExpire))) {
+        ::close(tfd);
+        return -1;
+    }
+    handlers_[tfd]->timer = true;
+    return tfd;
+}
+
+bool EventLoop::armTimer(int timerId, int delayMs, int intervalMs) {
+    if (timerId < 0) {
+        return false;
+    }
+    const itimerspec spec = toTimerSpec(delayMs, intervalMs);
+    return timerfd_settime(timerId, 0, &spec, nullptr) == 0;
+}
+
+void EventLoop::disarmTimer(int timerId) {
+    if (timerId < 0) {
+        return;
+    }
+    const itimerspec spec{};
+    timerfd_settime(timerId, 0, &spec, nullptr);
+}
+
+void EventLoop::removeTimer(int timerId) {
+    auto it = handlers_.find(timerId);
+    if (it == handlers_.end() || !it->second->timer) {
+        return;
+    }
+    removeFd(timerId);
+    ::close(timerId);
+}
+
+void EventLoop::post(Task task) {
+    if (!task) {
+        return;
+    }
+    bool wasEmpty = false;
+    {
+        std::lock_guard<std::mutex> lock(postMutex_);
+        wasEmpty = posted_.empty();
+        posted_.push_back(std::move(task));
+    }
+    if (wasEmpty) {
+        wake();
+    }
+}
+
+void EventLoop::runSync(const Task& task) {
+    if (!task) {
+        return;
+    }
+    if (!running_.load() || isInLoopThread()) {
+        task();
+        return;
+    }
+    std::promise<void> done;
+    std::future<void> finished = done.get_future();
+    post([&task, &done]() {
+        task();
+        done.set_value();
+    });
+    finished.wait();
+}
+
+void EventLoop::wake() {
+    const std::uint64_t one = 1;
+    // eventfd 计数溢出前不会失败；EAGAIN 说明已有未处理的唤醒
+    ssize_t n = ::write(wakeFd_, &one, sizeof(one));
+    (void)n;
+}
+
+void EventLoop::runPosted() {
+    std::uint64_t counter = 0;
+    ssize_t n = ::read(wakeFd_, &counter, sizeof(counter));
+    (void)n;
+    std::vector<Task> tasks;
+    {
+        std::lock_guard<std::mutex> lock(postMutex_);
+        tasks.swap(posted_);
+    }
+    for (auto& task : tasks) {
+        task();
+    }
+}
+
+int EventLoop::runOnce(int timeoutMs) {
+    if (!valid()) {
+        return -1;
+    }
+    loopThread_.store(std::this_thread::get_id());
+    epoll_event events[kMaxEvents];
+    const int n = epoll_wait(epollFd_, events, kMaxEvents, timeoutMs);
+    if (n < 0) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        std::cerr << "[EventLoop] epoll_wait failed: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+    for (int i = 0; i < n; ++i) {
+        const int fd = events[i].data.fd;
+        if (fd == wakeFd_) {
+            runPosted();
+            continue;
+        }
+        auto it = handlers_.find(fd);
+        if (it == handlers_.end()) {
+            continue;  // 本轮前面的回调已移除
+        }
+        std::shared_ptr<Handler> handler = it->second;
+        handler->callback(events[i].events);
+    }
+    return n;
+}
+
+void EventLoop::run() {
+    // 在 run() 之前调用的 stop() 同样生效
+    running_.store(true);
+    while (!stopped_.load()) {
+        if (runOnce(-1) < 0) {
+            break;
+        }
+    }
+    running_.store(false);
+    stopped_.store(false);
+}
+
+void EventLoop::stop() {
+    stopped_.store(true);
+    wake();
+}
+
+} // namespace nodeagent
@@ -1,19 +1,38 @@
 #include "nodeagent/FlowHandler.h"
+#include "falconmind/sdk/core/BootProfiler.h"
 #include <nlohmann/json.hpp>
+#include <fstream>
 #include <iostream>
 
 namespace nodeagent {
 
 using json = nlohmann::json;
+using falconmind::sdk::core::BootSpan;
 
-FlowHandler::FlowHandler() {
-    executor_ = std::make_shared<falconmind::sdk::core::FlowExecutor>();
+namespace {
+constexpr const char* kLastFlowFile = "/last_flow.json";
 }
 
+FlowHandler::FlowHandler() = default;
+
 FlowHandler::~FlowHandler() {
     stopCurrentFlow();
 }
 
+std::shared_ptr<falconmind::sdk::core::FlowExecutor> FlowHandler::makeExecutor(const std::string& flow_id) {
+    auto executor = std::make_shared<falconmind::sdk::core::FlowExecutor>();
+    if (!plan_cache_dir_.empty()) {
+        executor->setPlanCacheDirectory(plan_cache_dir_);
+    }
+    // 同时运行的 Flow 共用相机等设备；只有一个 Flow 时亦经共享代理取帧，之后启动的 Flow 可直接复用
+    executor->setResourceSharing(true);
+    executor->setWatchdogCallback([this, flow_id](const falconmind::sdk::core::WatchdogEvent& event) {
+        std::lock_guard<std::mutex> lock(watchdog_mutex_);
+        watchdog_events_.emplace_back(flow_id, event);
+    });
+    return executor;
+}
+
 void FlowHandler::setFlightConnectionService(std::shared_ptr<falconmind::sdk::flight::FlightConnectionService> service) {
     flight_service_ = service;
     // 注意：FlowExecutor中的节点如果需要FlightConnectionService，应该通过NodeFactory配置
@@ -24,23 +43,128 @@ void FlowHandler::setStatusCallback(FlowStatusCallback callback) {
     status_callback_ = callback;
 }
 
+void FlowHandler::setPlanCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    plan_cache_dir_ = directory;
+    for (auto& entry : flows_) {
+        entry.second.executor->setPlanCacheDirectory(directory);
+    }
+}
+
+std::string FlowHandler::getCurrentFlowId() const {
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    return current_flow_id_;
+}
+
+std::string FlowHandler::getCurrentContentHash() const {
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    auto it = flows_.find(current_flow_id_);
+    return it != flows_.end() ? it->second.content_hash : std::string();
+}
+
+bool FlowHandler::isFlowRunning() const {
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    return anyFlowRunning();
+}
+
+std::vector<std::string> FlowHandler::runningFlowIds() const {
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    std::vector<std::string> ids;
+    for (const auto& entry : flows_) {
+        if (entry.second.executor->isRunning()) ids.push_back(entry.first);
+    }
+    return ids;
+}
+
+bool FlowHandler::anyFlowRunning() const {
+    for (const auto& entry : flows_) {
+        if (entry.second.executor->isRunning()) return true;
+    }
+    return false;
+}
+
+bool FlowHandler::resumeLastFlow() {
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    BootSpan span("FlowHandler::resumeLastFlow", "agent");
+    if (plan_cache_dir_.empty() || anyFlowRunning()) {
+        return false;
+    }
+    std::ifstream in(plan_cache_dir_ + kLastFlowFile);
+    if (!in.is_open()) {
+        return false;
+    }
+    json record = json::parse(in, nullptr, false);
+    if (!record.is_object() || !record.contains("flow_id") || !record["flow_id"].is_string()) {
+        std::cerr << "[FlowHandler] Invalid last flow record in " << plan_cache_dir_ << std::endl;
+        return false;
+    }
+    const std::string flow_id = record["flow_id"].get<std::string>();
+    const std::string version = record.value("version", "1.0");
+    auto executor = makeExecutor(flow_id);
+    if (!executor->loadFlowFromCache(flow_id, version)) {
+        std::cerr << "[FlowHandler] No cached plan for last flow: " << flow_id << " v" << version << std::endl;
+        return false;
+    }
+    if (!executor->start()) {
+        std::cerr << "[FlowHandler] Failed to start cached flow: " << flow_id << std::endl;
+        return false;
+    }
+    flows_[flow_id] = RunningFlow{executor, record.value("content_hash", "")};
+    current_flow_id_ = flow_id;
+    std::cout << "[FlowHandler] Fast boot: resumed cached flow " << flow_id << " v" << version << std::endl;
+    return true;
+}
+
+void FlowHandler::saveLastFlowRecord() {
+    auto it = flows_.find(current_flow_id_);
+    if (plan_cache_dir_.empty() || it == flows_.end()) {
+        return;
+    }
+    json record = {{"flow_id", current_flow_id_},
+                   {"version", it->second.executor->getPlan().version},
+                   {"content_hash", it->second.content_hash}};
+    std::ofstream out(plan_cache_dir_ + kLastFlowFile, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "[FlowHandler] Cannot write last flow record to " << plan_cache_dir_ << std::endl;
+        return;
+    }
+    out << record.dump() << std::endl;
+}
+
 bool FlowHandler::handleFlow(const DownlinkMessage& msg) {
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    BootSpan span("FlowHandler::handleFlow", "agent");
+    // 重复下发的同一定义：已在运行，无需再解析
+    if (!msg.contentHash.empty()) {
+        for (const auto& entry : flows_) {
+            if (entry.second.content_hash == msg.contentHash && entry.second.executor->isRunning()) {
+                std::cout << "[FlowHandler] Flow already running: " << entry.first << std::endl;
+                reportStatus(entry.first, "RUNNING");
+                return true;
+            }
+        }
+    }
+
     std::string flow_id;
     std::string flow_json;
+    bool concurrent = false;
 
     // 解析消息
-    if (!parseFlowMessage(msg.payload, flow_id, flow_json)) {
+    if (!parseFlowMessage(msg.payload, flow_id, flow_json, concurrent)) {
         std::cerr << "[FlowHandler] Failed to parse flow message: " << msg.payload << std::endl;
         reportStatus(flow_id, "FAILED", "Failed to parse flow message");
         return false;
     }
 
-    // 停止当前Flow（如果有）
-    if (flow_active_ && executor_) {
-        stopCurrentFlow();
+    // 停止被替换的Flow（如果有）：同时运行时只替换同一 flow_id
+    if (concurrent) {
+        stopFlowLocked(flow_id);
+    } else {
+        stopAllFlowsLocked();
     }
 
     // 加载Flow定义
+    auto executor = makeExecutor(flow_id);
     bool load_success = false;
     try {
         // 检查消息中是否包含flow_definition字段（直接包含Flow定义）
@@ -49,15 +173,15 @@ bool FlowHandler::handleFlow(const DownlinkMessage& msg) {
         if (msg_json.contains("flow_definition") && msg_json["flow_definition"].is_object()) {
             // 直接使用flow_definition字段
             flow_json = msg_json["flow_definition"].dump();
-            load_success = executor_->loadFlow(flow_json);
+            load_success = executor->loadFlow(flow_json);
         } else if (msg_json.contains("builder_url") && msg_json.contains("project_id")) {
             // 从Builder API加载
             std::string builder_url = msg_json["builder_url"].get<std::string>();
             std::string project_id = msg_json["project_id"].get<std::string>();
-            load_success = executor_->loadFlowFromBuilder(builder_url, project_id, flow_id);
+            load_success = executor->loadFlowFromBuilder(builder_url, project_id, flow_id);
         } else {
             // 尝试直接解析payload作为Flow定义
-            load_success = executor_->loadFlow(msg.payload);
+            load_success = executor->loadFlow(msg.payload);
         }
     } catch (const std::exception& e) {
         std::cerr << "[FlowHandler] Error loading flow: " << e.what() << std::endl;
@@ -72,49 +196,96 @@ bool FlowHandler::handleFlow(const DownlinkMessage& msg) {
     }
 
     // 启动Flow执行
-    if (!executor_->start()) {
+    if (!executor->start()) {
         std::cerr << "[FlowHandler] Failed to start flow: " << flow_id << std::endl;
         reportStatus(flow_id, "FAILED", "Failed to start flow execution");
         return false;
     }
 
+    flows_[flow_id] = RunningFlow{executor, msg.contentHash};
     current_flow_id_ = flow_id;
-    flow_active_ = true;
+    saveLastFlowRecord();
     
-    std::cout << "[FlowHandler] Flow started: " << flow_id << std::endl;
+    std::cout << "[FlowHandler] Flow started: " << flow_id << " (priority " << executor->getPriority()
+              << ", " << flows_.size() << " running)" << std::endl;
     reportStatus(flow_id, "RUNNING");
 
     return true;
 }
 
 void FlowHandler::update() {
-    if (!flow_active_ || !executor_) {
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    if (flows_.empty()) {
         return;
     }
 
-    // 检查Flow是否还在运行
-    if (!executor_->isRunning()) {
+    std::vector<std::pair<std::string, falconmind::sdk::core::WatchdogEvent>> events;
+    {
+        std::lock_guard<std::mutex> events_lock(watchdog_mutex_);
+        events.swap(watchdog_events_);
+    }
+    for (const auto& [flow_id, event] : events) {
+        const bool recovered = event.kind == falconmind::sdk::core::WatchdogEventKind::Recovered;
+        reportStatus(flow_id, recovered ? "RUNNING" : "DEGRADED", falconmind::sdk::core::toJson(event));
+    }
+
+    // 检查各Flow是否还在运行
+    for (auto it = flows_.begin(); it != flows_.end();) {
+        if (it->second.executor->isRunning()) {
+            ++it;
+            continue;
+        }
         // Flow已停止
-        std::string flow_id = current_flow_id_;
+        std::string flow_id = it->first;
         std::cout << "[FlowHandler] Flow stopped: " << flow_id << std::endl;
         reportStatus(flow_id, "COMPLETED");
-        flow_active_ = false;
-        current_flow_id_.clear();
+        it = flows_.erase(it);
+        if (flow_id == current_flow_id_) {
+            current_flow_id_ = flows_.empty() ? std::string() : flows_.rbegin()->first;
+        }
     }
 }
 
 void FlowHandler::stopCurrentFlow() {
-    if (executor_ && executor_->isRunning()) {
-        std::string flow_id = current_flow_id_;
-        executor_->stop();
-        flow_active_ = false;
-        current_flow_id_.clear();
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    stopAllFlowsLocked();
+}
+
+bool FlowHandler::stopFlow(const std::string& flow_id) {
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    auto it = flows_.find(flow_id);
+    if (it == flows_.end() || !it->second.executor->isRunning()) {
+        return false;
+    }
+    stopFlowLocked(flow_id);
+    return true;
+}
+
+void FlowHandler::stopFlowLocked(const std::string& flow_id) {
+    auto it = flows_.find(flow_id);
+    if (it == flows_.end()) {
+        return;
+    }
+    const bool was_running = it->second.executor->isRunning();
+    it->second.executor->stop();
+    flows_.erase(it);
+    if (flow_id == current_flow_id_) {
+        current_flow_id_ = flows_.empty() ? std::string() : flows_.rbegin()->first;
+    }
+    if (was_running) {
         reportStatus(flow_id, "STOPPED");
         std::cout << "[FlowHandler] Flow stopped: " << flow_id << std::endl;
     }
 }
 
-bool FlowHandler::parseFlowMessage(const std::string& json_payload, std::string& flow_id, std::string& flow_json) {
+void FlowHandler::stopAllFlowsLocked() {
+    while (!flows_.empty()) {
+        stopFlowLocked(flows_.begin()->first);
+    }
+}
+
+bool FlowHandler::parseFlowMessage(const std::string& json_payload, std::string& flow_id, std::string& flow_json,
+                                   bool& concurrent) {
     try {
         json msg_json = json::parse(json_payload);
 
@@ -126,6 +297,8 @@ bool FlowHandler::parseFlowMessage(const std::string& json_payload, std::string&
             return false;
         }
 
+        concurrent = msg_json.value("concurrent", false);
+
         // flow_json将在handleFlow中根据消息类型确定
         return true;
     } catch (const json::parse_error& e) {
@@ -1,23 +1,55 @@
 #include "nodeagent/MessageAck.h"
+#include "nodeagent/Logger.h"
 
-#include <iostream>
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
+#include <cstdio>
 
 namespace nodeagent {
 
+namespace {
+
+std::uint64_t hashId(const std::string& id) {
+    std::uint64_t h = 1469598103934665603ULL;  // FNV-1a
+    for (unsigned char c : id) {
+        h = (h ^ c) * 1099511628211ULL;
+    }
+    return h;
+}
+
+std::size_t indexCapacity(std::size_t maxPending) {
+    std::size_t cap = 16;
+    while (cap < 2 * maxPending) {
+        cap <<= 1;
+    }
+    return cap;
+}
+
+} // namespace
+
 MessageAckManager::MessageAckManager(const Config& config)
-    : config_(config) {
+    : config_(config), epoch_(Clock::now()) {
+    config_.maxPending = std::max<std::size_t>(1, config_.maxPending);
+    if (config_.tickMs.count() <= 0) {
+        config_.tickMs = std::chrono::milliseconds(1);
+    }
+    entries_.resize(config_.maxPending);
+    freeSlots_.reserve(config_.maxPending);
+    for (std::size_t i = config_.maxPending; i-- > 0;) {
+        freeSlots_.push_back(static_cast<std::uint32_t>(i));
+    }
+    index_.assign(indexCapacity(config_.maxPending), 0);
+    wheel_.fill(kNil);
 }
 
 MessageAckManager::MessageAckManager()
-    : config_() {  // 使用默认值
+    : MessageAckManager(Config{}) {  // 使用默认值
 }
 
 MessageAckManager::~MessageAckManager() {
 }
 
 std::string MessageAckManager::registerPendingMessage(const DownlinkMessage& msg) {
+    const auto now = Clock::now();
     std::lock_guard<std::mutex> lock(mutex_);
 
     // 使用消息中的 requestId 作为 messageId，如果没有则生成一个
@@ -25,102 +57,215 @@ std::string MessageAckManager::registerPendingMessage(const DownlinkMessage& msg
     if (msgId.empty()) {
         msgId = generateMessageId();
     }
+    const std::uint64_t hash = hashId(msgId);
+    ++stats_.registered;
 
-    PendingMessage pending;
-    pending.message = msg;
-    pending.message.requestId = msgId;  // 确保 requestId 已设置
-    pending.sendTime = std::chrono::steady_clock::now();
-    pending.status = AckStatus::Pending;
-
-    pendingMessages_[msgId] = pending;
+    // 同一 ID 重复下发：更新内容并重新计时
+    std::uint32_t slot = find(msgId, hash);
+    if (slot != kNil) {
+        unlink(slot);
+    } else if (freeSlots_.empty()) {
+        ++stats_.overflow;
+        return msgId;
+    } else {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+        entries_[slot].hash = hash;
+        insertIndex(slot);
+    }
 
-    std::cout << "[MessageAckManager] Registered pending message: " << msgId << std::endl;
+    Entry& entry = entries_[slot];
+    entry.message = msg;
+    entry.message.requestId = msgId;  // 确保 requestId 已设置
+    entry.retryCount = 0;
+    entry.deadlineTick = deadlineFor(now);
+    link(slot);
     return msgId;
 }
 
 bool MessageAckManager::acknowledgeMessage(const std::string& messageId) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    auto it = pendingMessages_.find(messageId);
-    if (it == pendingMessages_.end()) {
-        std::cerr << "[MessageAckManager] Message not found: " << messageId << std::endl;
+    const std::uint32_t slot = find(messageId, hashId(messageId));
+    if (slot == kNil) {
+        ++stats_.unknownAcks;
         return false;
     }
-
-    it->second.status = AckStatus::Acknowledged;
-    std::cout << "[MessageAckManager] Message acknowledged: " << messageId << std::endl;
-
-    // 可选：立即移除已确认的消息（或保留一段时间用于统计）
-    // pendingMessages_.erase(it);
-
+    ++stats_.acknowledged;
+    unlink(slot);
+    release(slot, AckStatus::Acknowledged);
     return true;
 }
 
 void MessageAckManager::update() {
-    checkTimeouts();
+    update(Clock::now());
+}
+
+void MessageAckManager::update(Clock::time_point now) {
+    std::vector<DownlinkMessage> retries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::int64_t target = tickOf(now);
+        // 超过一整圈未更新时，每个桶只需访问一次（截止 tick ≤ target 的条目都在这一圈内被访问到）
+        processedTick_ = std::max(processedTick_, target - static_cast<std::int64_t>(kWheelSlots));
+
+        while (processedTick_ < target) {
+            ++processedTick_;
+            std::uint32_t slot = wheel_[static_cast<std::size_t>(processedTick_) & (kWheelSlots - 1)];
+            while (slot != kNil) {
+                Entry& entry = entries_[slot];
+                const std::uint32_t next = entry.next;
+                if (entry.deadlineTick <= processedTick_) {
+                    unlink(slot);
+                    if (entry.retryCount < config_.maxRetries) {
+                        ++entry.retryCount;
+                        ++stats_.retries;
+                        entry.deadlineTick = deadlineFor(now);
+                        link(slot);  // 插入桶头：若落在当前桶，本轮遍历不会再访问到
+                        retries.push_back(entry.message);
+                    } else {
+                        // 超过最大重试次数，标记为超时
+                        ++stats_.timeouts;
+                        LOG_WARN("MessageAckManager", "Message timeout: " + entry.message.requestId);
+                        release(slot, AckStatus::Timeout);
+                    }
+                }
+                slot = next;
+            }
+        }
+    }
+
+    if (retryCallback_) {
+        for (const auto& msg : retries) {
+            retryCallback_(msg);
+        }
+    }
 }
 
 AckStatus MessageAckManager::getMessageStatus(const std::string& messageId) const {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    auto it = pendingMessages_.find(messageId);
-    if (it == pendingMessages_.end()) {
-        return AckStatus::Pending;  // 默认返回 Pending
+    const std::uint64_t hash = hashId(messageId);
+    if (find(messageId, hash) != kNil) {
+        return AckStatus::Pending;
     }
-
-    return it->second.status;
+    // 从最新的结果往回找
+    for (std::size_t i = 0; i < kRecentOutcomes; ++i) {
+        const Outcome& outcome = recent_[(recentNext_ + kRecentOutcomes - 1 - i) % kRecentOutcomes];
+        if (outcome.hash == hash && outcome.messageId == messageId) {
+            return outcome.status;
+        }
+    }
+    return AckStatus::Pending;  // 默认返回 Pending
 }
 
 void MessageAckManager::setRetryCallback(RetryCallback callback) {
     retryCallback_ = callback;
 }
 
+MessageAckStats MessageAckManager::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MessageAckStats stats = stats_;
+    stats.pending = config_.maxPending - freeSlots_.size();
+    return stats;
+}
+
 std::string MessageAckManager::generateMessageId() {
-    int id = messageIdCounter_.fetch_add(1);
-    std::ostringstream oss;
-    oss << "msg_" << std::setfill('0') << std::setw(8) << id;
-    return oss.str();
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "msg_%08llu", static_cast<unsigned long long>(messageIdCounter_++));
+    return buf;
 }
 
-void MessageAckManager::checkTimeouts() {
-    std::lock_guard<std::mutex> lock(mutex_);
+std::int64_t MessageAckManager::tickOf(Clock::time_point now) const {
+    return (now - epoch_) / config_.tickMs;
+}
 
-    auto now = std::chrono::steady_clock::now();
-    std::vector<std::string> toRemove;
+std::int64_t MessageAckManager::deadlineFor(Clock::time_point now) const {
+    // 向上取整，保证不会早于 timeoutMs 触发
+    const auto due = now - epoch_ + config_.timeoutMs;
+    const auto tick = std::chrono::duration_cast<std::chrono::nanoseconds>(config_.tickMs);
+    const std::int64_t deadline = (std::chrono::duration_cast<std::chrono::nanoseconds>(due) + tick -
+                                   std::chrono::nanoseconds(1)) / tick;
+    return std::max(deadline, processedTick_ + 1);
+}
 
-    for (auto& [msgId, pending] : pendingMessages_) {
-        if (pending.status == AckStatus::Acknowledged) {
-            // 已确认的消息可以移除（或保留用于统计）
-            continue;
+std::uint32_t MessageAckManager::find(const std::string& messageId, std::uint64_t hash) const {
+    const std::size_t mask = index_.size() - 1;
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+        const std::uint32_t v = index_[i];
+        if (v == 0) {
+            return kNil;
         }
+        const Entry& entry = entries_[v - 1];
+        if (entry.hash == hash && entry.message.requestId == messageId) {
+            return v - 1;
+        }
+    }
+}
 
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - pending.sendTime);
-
-        if (elapsed >= config_.timeoutMs) {
-            if (pending.retryCount < config_.maxRetries) {
-                // 重传
-                pending.retryCount++;
-                pending.sendTime = now;  // 重置发送时间
-                std::cout << "[MessageAckManager] Retrying message: " << msgId
-                          << " (attempt " << pending.retryCount << "/" << config_.maxRetries << ")" << std::endl;
+void MessageAckManager::insertIndex(std::uint32_t slot) {
+    const std::size_t mask = index_.size() - 1;
+    std::size_t i = entries_[slot].hash & mask;
+    while (index_[i] != 0) {
+        i = (i + 1) & mask;
+    }
+    index_[i] = slot + 1;
+}
 
-                if (retryCallback_) {
-                    retryCallback_(pending.message);
-                }
-            } else {
-                // 超过最大重试次数，标记为超时
-                pending.status = AckStatus::Timeout;
-                std::cerr << "[MessageAckManager] Message timeout: " << msgId << std::endl;
-                toRemove.push_back(msgId);
-            }
+void MessageAckManager::eraseIndex(std::uint32_t slot) {
+    const std::size_t mask = index_.size() - 1;
+    std::size_t i = entries_[slot].hash & mask;
+    while (index_[i] != slot + 1) {
+        i = (i + 1) & mask;
+    }
+    // 回移删除：把后续探测链上可以前移的条目填入空位，不留墓碑
+    for (std::size_t j = (i + 1) & mask; index_[j] != 0; j = (j + 1) & mask) {
+        const std::size_t home = entries_[index_[j] - 1].hash & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            index_[i] = index_[j];
+            i = j;
         }
     }
+    index_[i] = 0;
+}
 
-    // 移除超时的消息
-    for (const auto& msgId : toRemove) {
-        pendingMessages_.erase(msgId);
+void MessageAckManager::link(std::uint32_t slot) {
+    Entry& entry = entries_[slot];
+    std::uint32_t& head = wheel_[static_cast<std::size_t>(entry.deadlineTick) & (kWheelSlots - 1)];
+    entry.prev = kNil;
+    entry.next = head;
+    if (head != kNil) {
+        entries_[head].prev = slot;
     }
+    head = slot;
+}
+
+void MessageAckManager::unlink(std::uint32_t slot) {
+    Entry& entry = entries_[slot];
+    if (entry.prev != kNil) {
+        entries_[entry.prev].next = entry.next;
+    } else {
+        wheel_[static_cast<std::size_t>(entry.deadlineTick) & (kWheelSlots - 1)] = entry.next;
+    }
+    if (entry.next != kNil) {
+        entries_[entry.next].prev = entry.prev;
+    }
+    entry.prev = entry.next = kNil;
+}
+
+// 槽位须已从时间轮摘下
+void MessageAckManager::release(std::uint32_t slot, AckStatus outcome) {
+    Entry& entry = entries_[slot];
+    eraseIndex(slot);
+
+    Outcome& recent = recent_[recentNext_];
+    recentNext_ = (recentNext_ + 1) % kRecentOutcomes;
+    recent.hash = entry.hash;
+    recent.messageId.swap(entry.message.requestId);
+    recent.status = outcome;
+
+    entry.message = DownlinkMessage{};  // 释放载荷
+    freeSlots_.push_back(slot);
 }
 
 } // namespace nodeagent
@@ -1,5 +1,4 @@
 #include "nodeagent/MissionHandler.h"
-#include "falconmind/sdk/mission/FlightActions.h"
 #include <nlohmann/json.hpp>
 
 #include <iostream>
@@ -16,6 +15,8 @@ MissionHandler::MissionHandler() {
 }
 
 MissionHandler::~MissionHandler() {
+    std::lock_guard<std::mutex> lock(lifecycleMutex_);
+    stopMission();
 }
 
 void MissionHandler::setFlightConnectionService(std::shared_ptr<FlightConnectionService> service) {
@@ -39,25 +40,54 @@ bool MissionHandler::handleMission(const DownlinkMessage& msg) {
         return false;
     }
 
+    // 新任务替换正在执行的任务
+    std::lock_guard<std::mutex> lock(lifecycleMutex_);
+    stopMission();
+
     executor_ = std::make_shared<BehaviorTreeExecutor>(root);
     missionActive_ = true;
+    stopRequested_ = false;
+
+    // 行为树在独立线程中执行：节点等待的事件 / 定时到来时才 tick，不再依赖主循环的 100ms 轮询
+    auto executor = executor_;
+    missionThread_ = std::thread([this, executor] {
+        auto status = executor->run([this] { return !stopRequested_.load(); });
+        if (status == NodeStatus::Success || status == NodeStatus::Failure) {
+            std::cout << "[MissionHandler] Mission completed with status: "
+                      << (status == NodeStatus::Success ? "Success" : "Failure") << std::endl;
+        }
+        missionActive_ = false;
+    });
 
     std::cout << "[MissionHandler] Mission started: " << msg.payload << std::endl;
     return true;
 }
 
 void MissionHandler::update() {
-    if (!missionActive_ || !executor_) {
-        return;
+    std::lock_guard<std::mutex> lock(lifecycleMutex_);
+    if (!missionActive_ && missionThread_.joinable()) {
+        missionThread_.join();
+        executor_.reset();
     }
+}
 
-    auto status = executor_->tick();
-    if (status == NodeStatus::Success || status == NodeStatus::Failure) {
-        std::cout << "[MissionHandler] Mission completed with status: "
-                  << (status == NodeStatus::Success ? "Success" : "Failure") << std::endl;
-        missionActive_ = false;
-        executor_.reset();
+void MissionHandler::notify() {
+    std::lock_guard<std::mutex> lock(lifecycleMutex_);
+    if (executor_) {
+        executor_->notify();
+    }
+}
+
+void MissionHandler::stopMission() {
+    stopRequested_ = true;
+    if (executor_) {
+        executor_->notify();
+    }
+    if (missionThread_.joinable()) {
+        missionThread_.join();
     }
+    executor_.reset();
+    missionActive_ = false;
 }
 
 std::shared_ptr<BehaviorNode> MissionHandler::parseMissionJson(const std::string& jsonPayload) {
@@ -65,62 +95,20 @@ std::shared_ptr<BehaviorNode> MissionHandler::parseMissionJson(const std::string
         // 使用 nlohmann/json 解析 JSON
         auto json = nlohmann::json::parse(jsonPayload);
 
-        // 提取 task 字段
-        std::string taskStr;
-        if (json.contains("task") && json["task"].is_string()) {
-            taskStr = json["task"].get<std::string>();
+        BehaviorTreeDefinitionPtr definition;
+        if (json.contains("tree") || json.contains("treeId")) {
+            definition = resolveTreeDefinition(json);
         } else {
-            std::cerr << "[MissionHandler] Missing or invalid 'task' field" << std::endl;
-            return nullptr;
+            definition = legacyTaskDefinition(json);
         }
-
-        // 提取可选参数
-        double takeoffAlt = 10.0;  // 默认高度
-        if (json.contains("params") && json["params"].is_object()) {
-            auto params = json["params"];
-            if (params.contains("takeoffAlt") && params["takeoffAlt"].is_number()) {
-                takeoffAlt = params["takeoffAlt"].get<double>();
-            }
-        }
-
-        int hoverDuration = 5;  // 默认悬停时间（秒）
-        if (json.contains("params") && json["params"].is_object()) {
-            auto params = json["params"];
-            if (params.contains("hoverDuration") && params["hoverDuration"].is_number()) {
-                hoverDuration = params["hoverDuration"].get<int>();
-            }
-        }
-
-        // 根据 task 类型创建行为树（支持大小写不敏感）
-        std::string taskUpper = taskStr;
-        std::transform(taskUpper.begin(), taskUpper.end(), taskUpper.begin(), ::toupper);
-
-        auto sequence = std::make_shared<SequenceNode>();
-
-        if (taskUpper == "TAKEOFF_AND_HOVER") {
-            // 创建：Arm -> Takeoff -> Hover -> RTL
-            auto arm = std::make_shared<ArmAction>(*flightService_);
-            auto takeoff = std::make_shared<TakeoffAction>(*flightService_, takeoffAlt);
-            auto hover = std::make_shared<HoverAction>(std::chrono::seconds(hoverDuration));
-            auto rtl = std::make_shared<RtlAction>(*flightService_);
-
-            sequence->addChild(arm);
-            sequence->addChild(takeoff);
-            sequence->addChild(hover);
-            sequence->addChild(rtl);
-        } else if (taskUpper == "SIMPLE_TAKEOFF") {
-            // 创建：Arm -> Takeoff
-            auto arm = std::make_shared<ArmAction>(*flightService_);
-            auto takeoff = std::make_shared<TakeoffAction>(*flightService_, takeoffAlt);
-
-            sequence->addChild(arm);
-            sequence->addChild(takeoff);
-        } else {
-            std::cerr << "[MissionHandler] Unknown task type: " << taskStr << std::endl;
+        if (!definition) {
             return nullptr;
         }
 
-        return sequence;
+        BtBuildContext ctx;
+        ctx.flight = flightService_.get();
+        ctx.blackboard = blackboard_;
+        return definition->instantiate(ctx);
     } catch (const nlohmann::json::parse_error& e) {
         std::cerr << "[MissionHandler] JSON parse error: " << e.what() << std::endl;
         return nullptr;
@@ -133,4 +121,98 @@ std::shared_ptr<BehaviorNode> MissionHandler::parseMissionJson(const std::string
     }
 }
 
+BehaviorTreeDefinitionPtr MissionHandler::resolveTreeDefinition(const nlohmann::json& json) {
+    // {"treeId":"patrol","tree":{...}} 编译并以 treeId 缓存；之后只带 treeId 即可复用已编译的定义
+    std::string treeId;
+    if (json.contains("treeId")) {
+        if (!json["treeId"].is_string()) {
+            std::cerr << "[MissionHandler] Invalid 'treeId' field" << std::endl;
+            return nullptr;
+        }
+        treeId = json["treeId"].get<std::string>();
+    }
+
+    if (!json.contains("tree")) {
+        std::lock_guard<std::mutex> lock(definitionMutex_);
+        auto it = treeDefinitions_.find(treeId);
+        if (treeId.empty() || it == treeDefinitions_.end()) {
+            std::cerr << "[MissionHandler] Unknown treeId: " << treeId << std::endl;
+            return nullptr;
+        }
+        return it->second.definition;
+    }
+
+    std::string text = json["tree"].dump();
+    const std::string key = treeId.empty() ? text : treeId;
+    {
+        std::lock_guard<std::mutex> lock(definitionMutex_);
+        auto it = treeDefinitions_.find(key);
+        if (it != treeDefinitions_.end() && it->second.source == text) {
+            return it->second.definition;
+        }
+    }
+
+    std::string error;
+    auto definition = BehaviorTreeDefinition::compile(text, &error);
+    if (!definition) {
+        std::cerr << "[MissionHandler] Failed to compile mission tree: " << error << std::endl;
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(definitionMutex_);
+    if (treeDefinitions_.size() >= kMaxCachedDefinitions) {
+        treeDefinitions_.clear();
+    }
+    treeDefinitions_[key] = CachedDefinition{std::move(text), definition};
+    return definition;
+}
+
+BehaviorTreeDefinitionPtr MissionHandler::legacyTaskDefinition(const nlohmann::json& json) {
+    // 提取 task 字段
+    std::string taskStr;
+    if (json.contains("task") && json["task"].is_string()) {
+        taskStr = json["task"].get<std::string>();
+    } else {
+        std::cerr << "[MissionHandler] Missing or invalid 'task' field" << std::endl;
+        return nullptr;
+    }
+
+    // 提取可选参数
+    double takeoffAlt = 10.0;  // 默认高度
+    int hoverDuration = 5;     // 默认悬停时间（秒）
+    if (json.contains("params") && json["params"].is_object()) {
+        const auto& params = json["params"];
+        if (params.contains("takeoffAlt") && params["takeoffAlt"].is_number()) {
+            takeoffAlt = params["takeoffAlt"].get<double>();
+        }
+        if (params.contains("hoverDuration") && params["hoverDuration"].is_number()) {
+            hoverDuration = params["hoverDuration"].get<int>();
+        }
+    }
+
+    // 预置任务同样表示为行为树定义（支持大小写不敏感）
+    std::string taskUpper = taskStr;
+    std::transform(taskUpper.begin(), taskUpper.end(), taskUpper.begin(), ::toupper);
+
+    nlohmann::json tree;
+    if (taskUpper == "TAKEOFF_AND_HOVER") {
+        // 创建：Arm -> Takeoff -> Hover -> RTL
+        tree = {{"type", "sequence"},
+                {"children",
+                 {{{"type", "arm"}},
+                  {{"type", "takeoff"}, {"params", {{"alt", takeoffAlt}}}},
+                  {{"type", "hover"}, {"params", {{"seconds", hoverDuration}}}},
+                  {{"type", "rtl"}}}}};
+    } else if (taskUpper == "SIMPLE_TAKEOFF") {
+        // 创建：Arm -> Takeoff
+        tree = {{"type", "sequence"},
+                {"children", {{{"type", "arm"}}, {{"type", "takeoff"}, {"params", {{"alt", takeoffAlt}}}}}}};
+    } else {
+        std::cerr << "[MissionHandler] Unknown task type: " << taskStr << std::endl;
+        return nullptr;
+    }
+
+    nlohmann::json wrapped{{"tree", tree}};
+    return resolveTreeDefinition(wrapped);
+}
+
 } // namespace nodeagent
@@ -126,6 +126,7 @@ bool MqttDownlinkClient::startReceiving(const std::string& uavId) {
     try {
         std::string cmdTopic = buildCommandTopic(uavId);
         std::string missionTopic = buildMissionTopic(uavId);
+        std::string transferTopic = buildTransferTopic(uavId);
 
         // 订阅命令主题
         mqtt::token_ptr subCmdTok = mqttClient_->subscribe(cmdTopic, config_.qos);
@@ -135,10 +136,13 @@ bool MqttDownlinkClient::startReceiving(const std::string& uavId) {
         mqtt::token_ptr subMissionTok = mqttClient_->subscribe(missionTopic, config_.qos);
         subMissionTok->wait();
 
+        // 订阅 Flow / 任务定义分块传输主题
+        mqttClient_->subscribe(transferTopic, config_.qos)->wait();
+
         currentUavId_ = uavId;
         receiving_ = true;
         std::cout << "[MqttDownlinkClient] Subscribed to topics: " << cmdTopic 
-                  << ", " << missionTopic << std::endl;
+                  << ", " << missionTopic << ", " << transferTopic << std::endl;
         return true;
     } catch (const mqtt::exception& e) {
         std::cerr << "[MqttDownlinkClient] Subscribe failed: " << e.what() << std::endl;
@@ -167,6 +171,7 @@ void MqttDownlinkClient::stopReceiving() {
             // 取消订阅
             mqttClient_->unsubscribe(cmdTopic)->wait();
             mqttClient_->unsubscribe(missionTopic)->wait();
+            mqttClient_->unsubscribe(buildTransferTopic(currentUavId_))->wait();
         }
     } catch (const std::exception& e) {
         std::cerr << "[MqttDownlinkClient] Unsubscribe error: " << e.what() << std::endl;
@@ -192,6 +197,8 @@ void MqttDownlinkClient::onMessageReceived(const std::string& topic, const std::
         msg.type = DownlinkMessageType::Mission;
     } else if (topic.find("/flows") != std::string::npos) {
         msg.type = DownlinkMessageType::Flow;
+    } else if (topic.find("/transfers") != std::string::npos) {
+        msg.type = DownlinkMessageType::Transfer;
     } else {
         return;
     }
@@ -237,4 +244,8 @@ std::string MqttDownlinkClient::buildMissionTopic(const std::string& uavId) {
     return config_.topicPrefix + "/" + uavId + "/missions";
 }
 
+std::string MqttDownlinkClient::buildTransferTopic(const std::string& uavId) {
+    return config_.topicPrefix + "/" + uavId + "/transfers";
+}
+
 } // namespace nodeagent
@@ -1,6 +1,11 @@
 #include "nodeagent/MqttUplinkClient.h"
+#include "falconmind/sdk/telemetry/TelemetryCodec.h"
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -8,18 +13,43 @@
 namespace nodeagent {
 
 MqttUplinkClient::MqttUplinkClient(const Config& config)
-    : config_(config) {
+    : config_(config)
+    , delta_(config.delta) {
 #ifdef NODEAGENT_MQTT_ENABLED
     // 构建 MQTT broker URI
     std::string brokerUri = "tcp://" + config_.brokerAddress + ":" + std::to_string(config_.brokerPort);
     
-    // 创建异步 MQTT 客户端
-    mqttClient_ = std::make_unique<mqtt::async_client>(brokerUri, config_.clientId);
-    
+    // 创建异步 MQTT 客户端（MQTT 5 需在创建时声明协议版本；persistenceDir 非空时在途消息写入磁盘）
+    const mqtt::create_options createOpts(config_.mqttV5 ? MQTTVERSION_5 : MQTTVERSION_DEFAULT);
+    if (config_.persistenceDir.empty()) {
+        mqttClient_ = std::make_unique<mqtt::async_client>(brokerUri, config_.clientId, createOpts);
+    } else {
+        mqttClient_ = std::make_unique<mqtt::async_client>(brokerUri, config_.clientId, createOpts,
+                                                           config_.persistenceDir);
+    }
+
     // 配置连接选项
-    connectOptions_.set_clean_session(true);
     connectOptions_.set_automatic_reconnect(true);
     connectOptions_.set_keep_alive_interval(20);
+    connectOptions_.set_max_inflight(config_.maxInflight);
+    if (config_.mqttV5) {
+        connectOptions_.set_mqtt_version(MQTTVERSION_5);
+        connectOptions_.set_clean_start(!config_.persistentSession);
+        if (config_.persistentSession) {
+            connectOptions_.set_properties(mqtt::properties{
+                mqtt::property(mqtt::property::SESSION_EXPIRY_INTERVAL, config_.sessionExpirySec)});
+        }
+    } else {
+        connectOptions_.set_clean_session(!config_.persistentSession);
+    }
+
+    // 主题别名只在单次连接内有效：（自动）重连后重新建立
+    mqttClient_->set_connected_handler([this](const std::string&) {
+        std::lock_guard<std::mutex> lock(topicMutex_);
+        for (auto& entry : telemetryTopics_) {
+            entry.second.aliasEstablished = false;
+        }
+    });
 #endif
 }
 
@@ -37,10 +67,38 @@ bool MqttUplinkClient::connect() {
         // 连接到 MQTT broker
         mqtt::token_ptr conntok = mqttClient_->connect(connectOptions_);
         conntok->wait();  // 等待连接完成
-        
+
+        // CONNACK 中 broker 允许的主题别名数（未声明时为 0，不使用别名）
+        int aliasMax = 0;
+        if (config_.mqttV5 && config_.useTopicAliases) {
+            const mqtt::connect_response rsp = conntok->get_connect_response();
+            const mqtt::properties& props = rsp.get_properties();
+            if (props.contains(mqtt::property::TOPIC_ALIAS_MAXIMUM)) {
+                aliasMax = mqtt::get<int>(props, mqtt::property::TOPIC_ALIAS_MAXIMUM);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(topicMutex_);
+            topicAliasMax_ = aliasMax;
+            telemetryTopics_.clear();
+            nextAlias_ = 1;
+        }
+
         connected_ = true;
+        delta_.reset();
+        activeEncoding_ = TelemetryEncoding::Json;
+        if (config_.telemetryEncoding == TelemetryEncoding::Binary ||
+            config_.telemetryEncoding == TelemetryEncoding::BinaryDelta) {
+            activeEncoding_ = config_.telemetryEncoding;
+        } else if (config_.telemetryEncoding == TelemetryEncoding::Auto) {
+            activeEncoding_ = negotiateEncoding();
+        }
         std::cout << "[MqttUplinkClient] Connected to MQTT broker at "
-                  << config_.brokerAddress << ":" << config_.brokerPort << std::endl;
+                  << config_.brokerAddress << ":" << config_.brokerPort << " (telemetry encoding: "
+                  << (activeEncoding_ == TelemetryEncoding::BinaryDelta ? "binary-delta"
+                      : activeEncoding_ == TelemetryEncoding::Binary    ? "binary"
+                                                                        : "json")
+                  << ", topic aliases: " << aliasMax << ")" << std::endl;
         return true;
     } catch (const mqtt::exception& e) {
         std::cerr << "[MqttUplinkClient] Connection failed: " << e.what() << std::endl;
@@ -83,18 +141,36 @@ bool MqttUplinkClient::sendTelemetry(const falconmind::sdk::telemetry::Telemetry
 
 #ifdef NODEAGENT_MQTT_ENABLED
     try {
-        std::string json = serializeTelemetryToJson(msg);
-        std::string topic = buildTopic(msg.uavId);
-
-        // 创建 MQTT 消息
-        mqtt::message_ptr pubmsg = mqtt::make_message(topic, json);
-        pubmsg->set_qos(config_.qos);
+        // 同一连接上的遥测串行发布：别名建立消息必须先于只带别名的消息，增量编码器也非线程安全
+        std::lock_guard<std::mutex> lock(topicMutex_);
 
-        // 发布消息（异步）
-        mqtt::delivery_token_ptr pubtok = mqttClient_->publish(pubmsg);
-        pubtok->wait();  // 等待发布完成
+        // 创建 MQTT 消息：二进制帧无法编码（字符串超长）时退回 JSON
+        mqtt::message_ptr pubmsg;
+        if (activeEncoding_ == TelemetryEncoding::BinaryDelta) {
+            std::array<std::uint8_t, falconmind::sdk::telemetry::kTelemetryFrameMaxBytes> frame;
+            const std::uint64_t failures = delta_.stats().encodeFailures;
+            const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            const std::size_t size = delta_.encode(msg, nowNs, frame.data(), frame.size());
+            if (size > 0) {
+                pubmsg = makeTelemetryMessage(msg.uavId, frame.data(), size);
+            } else if (delta_.stats().encodeFailures == failures) {
+                return true;  // 没有需要发送的字段组
+            }
+        } else if (activeEncoding_ == TelemetryEncoding::Binary) {
+            std::array<std::uint8_t, falconmind::sdk::telemetry::kTelemetryFrameMaxBytes> frame;
+            const std::size_t size = falconmind::sdk::telemetry::encodeTelemetryFrame(msg, frame.data(), frame.size());
+            if (size > 0) {
+                pubmsg = makeTelemetryMessage(msg.uavId, frame.data(), size);
+            }
+        }
+        if (!pubmsg) {
+            const std::string json = serializeTelemetryToJson(msg);
+            pubmsg = makeTelemetryMessage(msg.uavId, json.data(), json.size());
+        }
 
-        return true;
+        // 窗口已满时丢弃本帧：遥测只关心最新值，不让一个慢 ACK 卡住后续发布
+        return publish(pubmsg, true);
     } catch (const mqtt::exception& e) {
         std::cerr << "[MqttUplinkClient] Publish failed: " << e.what() << std::endl;
         return false;
@@ -136,15 +212,10 @@ bool MqttUplinkClient::sendMessage(const std::string& message) {
             topic = config_.topicPrefix + "/default/message";
         }
 
-        // 创建 MQTT 消息
+        // 创建 MQTT 消息并发布（事件不丢弃：窗口已满时等待）
         mqtt::message_ptr pubmsg = mqtt::make_message(topic, message);
         pubmsg->set_qos(config_.qos);
-
-        // 发布消息（异步）
-        mqtt::delivery_token_ptr pubtok = mqttClient_->publish(pubmsg);
-        pubtok->wait();  // 等待发布完成
-
-        return true;
+        return publish(pubmsg, false);
     } catch (const mqtt::exception& e) {
         std::cerr << "[MqttUplinkClient] Publish failed: " << e.what() << std::endl;
         return false;
@@ -158,7 +229,27 @@ bool MqttUplinkClient::sendMessage(const std::string& message) {
 #endif
 }
 
-std::string MqttUplinkClient::serializeTelemetryToJson(const falconmind::sdk::telemetry::TelemetryMessage& msg) {
+bool MqttUplinkClient::sendReplayedTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg) {
+    if (!connected_) {
+        return false;
+    }
+
+#ifdef NODEAGENT_MQTT_ENABLED
+    try {
+        mqtt::message_ptr pubmsg = mqtt::make_message(buildTopic(msg.uavId), serializeTelemetryToJson(msg, true));
+        pubmsg->set_qos(config_.qos);
+        return publish(pubmsg, false);
+    } catch (const mqtt::exception& e) {
+        std::cerr << "[MqttUplinkClient] Publish failed: " << e.what() << std::endl;
+        return false;
+    }
+#else
+    std::cerr << "[MqttUplinkClient] MQTT support not enabled" << std::endl;
+    return false;
+#endif
+}
+
+std::string MqttUplinkClient::serializeTelemetryToJson(const falconmind::sdk::telemetry::TelemetryMessage& msg, bool replay) {
     try {
         // 使用 nlohmann/json 进行序列化（与 TCP 版本保持一致）
         nlohmann::json json;
@@ -186,6 +277,9 @@ std::string MqttUplinkClient::serializeTelemetryToJson(const falconmind::sdk::te
 
         json["link_quality"] = msg.linkQuality;
         json["flight_mode"] = msg.flightMode;
+        if (replay) {
+            json["replay"] = true;
+        }
 
         return json.dump();
     } catch (const std::exception& e) {
@@ -194,6 +288,125 @@ std::string MqttUplinkClient::serializeTelemetryToJson(const falconmind::sdk::te
     }
 }
 
+MqttPublishStats MqttUplinkClient::publishStats() const {
+    std::lock_guard<std::mutex> lock(inflightMutex_);
+    return stats_;
+}
+
+#ifdef NODEAGENT_MQTT_ENABLED
+MqttUplinkClient::TopicState& MqttUplinkClient::telemetryTopic(const std::string& uavId) {
+    auto it = telemetryTopics_.find(uavId);
+    if (it == telemetryTopics_.end()) {
+        TopicState state;
+        state.topic = mqtt::string_ref(buildTopic(uavId));
+        // 别名用于 QoS 0：QoS 1 消息可能在重连后重传，而别名不跨连接
+        if (config_.qos == 0 && nextAlias_ <= topicAliasMax_) {
+            state.alias = nextAlias_++;
+        }
+        it = telemetryTopics_.emplace(uavId, std::move(state)).first;
+    }
+    return it->second;
+}
+
+mqtt::message_ptr MqttUplinkClient::makeTelemetryMessage(const std::string& uavId, const void* data, std::size_t size) {
+    static const mqtt::string_ref kAliasOnlyTopic{std::string()};
+    TopicState& state = telemetryTopic(uavId);
+    if (state.alias == 0) {
+        return mqtt::make_message(state.topic, data, size, config_.qos, false);
+    }
+    // 首条消息同时携带主题与别名以建立映射，之后只带别名
+    const bool aliasOnly = state.aliasEstablished;
+    mqtt::message_ptr msg = mqtt::make_message(aliasOnly ? kAliasOnlyTopic : state.topic, data, size, config_.qos, false);
+    msg->set_properties(mqtt::properties{mqtt::property(mqtt::property::TOPIC_ALIAS, state.alias)});
+    state.aliasEstablished = true;
+    if (aliasOnly) {
+        std::lock_guard<std::mutex> lock(inflightMutex_);
+        ++stats_.aliasedPublishes;
+    }
+    return msg;
+}
+
+bool MqttUplinkClient::publish(mqtt::message_ptr msg, bool dropWhenFull) {
+    if (!config_.pipelined) {
+        mqttClient_->publish(msg)->wait();  // 等待发布完成
+        std::lock_guard<std::mutex> lock(inflightMutex_);
+        ++stats_.published;
+        ++stats_.completed;
+        return true;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(inflightMutex_);
+        if (stats_.inflight >= config_.maxInflight) {
+            if (dropWhenFull) {
+                ++stats_.droppedFull;
+                return true;
+            }
+            if (!inflightCv_.wait_for(lock, std::chrono::milliseconds(config_.publishTimeoutMs),
+                                      [this]() { return stats_.inflight < config_.maxInflight; })) {
+                ++stats_.failed;
+                return false;
+            }
+        }
+        ++stats_.inflight;
+        ++stats_.published;
+        stats_.inflightPeak = std::max(stats_.inflightPeak, stats_.inflight);
+    }
+    try {
+        mqttClient_->publish(msg, nullptr, publishListener_);
+    } catch (...) {
+        onPublishDone(false);
+        throw;
+    }
+    return true;
+}
+
+void MqttUplinkClient::onPublishDone(bool ok) {
+    {
+        std::lock_guard<std::mutex> lock(inflightMutex_);
+        --stats_.inflight;
+        if (ok) {
+            ++stats_.completed;
+        } else {
+            ++stats_.failed;
+        }
+    }
+    inflightCv_.notify_one();
+}
+
+TelemetryEncoding MqttUplinkClient::negotiateEncoding() {
+    const std::string topic = config_.topicPrefix + "/_bridge/capabilities";
+    TelemetryEncoding result = TelemetryEncoding::Json;
+    try {
+        mqttClient_->start_consuming();
+        mqttClient_->subscribe(topic, 1)->wait();
+        mqtt::const_message_ptr caps;
+        if (mqttClient_->try_consume_message_for(&caps, std::chrono::milliseconds(config_.negotiateTimeoutMs)) &&
+            caps) {
+            auto json = nlohmann::json::parse(caps->to_string());
+            if (json.contains("telemetry_encodings") && json["telemetry_encodings"].is_array()) {
+                for (const auto& e : json["telemetry_encodings"]) {
+                    if (!e.is_string()) continue;
+                    const std::string name = e.get<std::string>();
+                    if (name == falconmind::sdk::telemetry::kTelemetryDeltaEncoding) {
+                        result = TelemetryEncoding::BinaryDelta;
+                    } else if (name == falconmind::sdk::telemetry::kTelemetryBinaryEncoding &&
+                               result == TelemetryEncoding::Json) {
+                        result = TelemetryEncoding::Binary;
+                    }
+                }
+            }
+        }
+        mqttClient_->unsubscribe(topic)->wait();
+        mqttClient_->stop_consuming();
+    } catch (const std::exception& e) {
+        std::cerr << "[MqttUplinkClient] Encoding negotiation failed, using JSON: " << e.what() << std::endl;
+        return TelemetryEncoding::Json;
+    }
+    return result;
+}
+#endif
+
 std::string MqttUplinkClient::buildTopic(const std::string& uavId) {
     return config_.topicPrefix + "/" + uavId + "/telemetry";
 }
@@ -1,14 +1,57 @@
 #include "nodeagent/MultiUavManager.h"
+#include "nodeagent/EventLoop.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace nodeagent {
 
-MultiUavManager::MultiUavManager() {
+MultiUavManager::MultiUavManager()
+    : MultiUavManager(Config{}) {  // 使用默认值
+}
+
+MultiUavManager::MultiUavManager(const Config& config)
+    : config_(config) {
+    int ioThreads = config_.ioThreads;
+    if (ioThreads <= 0) {
+        ioThreads = static_cast<int>(std::min(std::max(1u, std::thread::hardware_concurrency()), 4u));
+    }
+    if (config_.startConcurrency <= 0) {
+        config_.startConcurrency = ioThreads;
+    }
+    config_.agentDefaults.routeTelemetryByUavId = true;
+
+    const bool useLoops = config_.agentDefaults.useEventLoop &&
+                          config_.agentDefaults.protocol == NodeAgent::Protocol::TCP;
+    for (int i = 0; useLoops && i < ioThreads; ++i) {
+        auto loop = std::make_shared<EventLoop>();
+        if (!loop->valid()) {
+            std::cerr << "[MultiUavManager] Failed to create shared event loop" << std::endl;
+            break;
+        }
+        loopThreads_.emplace_back([loop]() { loop->run(); });
+        loops_.push_back(std::move(loop));
+    }
 }
 
 MultiUavManager::~MultiUavManager() {
     stopAll();
+    {
+        // NodeAgent 析构时需要在共享循环上注销定时器，须在循环停止前销毁
+        std::lock_guard<std::mutex> lock(mutex_);
+        uavs_.clear();
+    }
+    for (auto& loop : loops_) {
+        loop->stop();
+    }
+    for (auto& thread : loopThreads_) {
+        thread.join();
+    }
+}
+
+void MultiUavManager::setRouter(std::shared_ptr<falconmind::sdk::flight::MavlinkRouter> router) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    router_ = std::move(router);
 }
 
 bool MultiUavManager::addUav(const UavConfig& config) {
@@ -19,17 +62,31 @@ bool MultiUavManager::addUav(const UavConfig& config) {
         return false;
     }
 
-    UavEntry entry;
-    entry.config = config;
+    auto entry = std::make_shared<UavEntry>();
+    entry->config = config;
+    if (!entry->config.flightService && router_ && config.sysid != 0) {
+        auto svc = std::make_shared<falconmind::sdk::flight::FlightConnectionService>();
+        if (!svc->connect(router_, config.sysid)) {
+            std::cerr << "[MultiUavManager] Failed to attach UAV " << config.uavId << " to router (sysid "
+                      << static_cast<int>(config.sysid) << ")" << std::endl;
+            return false;
+        }
+        entry->config.flightService = std::move(svc);
+    }
 
-    NodeAgent::Config agentConfig;
+    NodeAgent::Config agentConfig = config_.agentDefaults;
     agentConfig.uavId = config.uavId;
     agentConfig.centerAddress = config.centerAddress;
     agentConfig.centerPort = config.centerPort;
 
-    entry.agent = std::make_unique<NodeAgent>(agentConfig);
-    if (config.flightService) {
-        entry.agent->setFlightConnectionService(config.flightService);
+    // 轮询分配共享事件循环
+    std::shared_ptr<EventLoop> loop;
+    if (!loops_.empty()) {
+        loop = loops_[nextLoop_++ % loops_.size()];
+    }
+    entry->agent = std::make_unique<NodeAgent>(agentConfig, std::move(loop));
+    if (entry->config.flightService) {
+        entry->agent->setFlightConnectionService(entry->config.flightService);
     }
 
     uavs_[config.uavId] = std::move(entry);
@@ -39,96 +96,81 @@ bool MultiUavManager::addUav(const UavConfig& config) {
 }
 
 bool MultiUavManager::removeUav(const std::string& uavId) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = uavs_.find(uavId);
-    if (it == uavs_.end()) {
-        std::cerr << "[MultiUavManager] UAV not found: " << uavId << std::endl;
-        return false;
-    }
-
-    if (it->second.running) {
-        it->second.agent->stop();
+    std::shared_ptr<UavEntry> entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = uavs_.find(uavId);
+        if (it == uavs_.end()) {
+            std::cerr << "[MultiUavManager] UAV not found: " << uavId << std::endl;
+            return false;
+        }
+        entry = std::move(it->second);
+        uavs_.erase(it);
     }
 
-    uavs_.erase(it);
+    stopEntry(*entry);
     std::cout << "[MultiUavManager] Removed UAV: " << uavId << std::endl;
     return true;
 }
 
 bool MultiUavManager::startAll() {
-    std::lock_guard<std::mutex> lock(mutex_);
+    const auto all = entries();
+    if (all.empty()) {
+        return true;
+    }
 
-    bool allSuccess = true;
-    for (auto& [uavId, entry] : uavs_) {
-        if (!entry.running) {
-            if (entry.agent->start()) {
-                entry.running = true;
-                std::cout << "[MultiUavManager] Started UAV: " << uavId << std::endl;
-            } else {
-                std::cerr << "[MultiUavManager] Failed to start UAV: " << uavId << std::endl;
+    // 连接与编码协商是阻塞的：多个线程并发启动，避免数百架依次等待
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> allSuccess{true};
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < all.size(); i = next++) {
+            if (!startEntry(*all[i])) {
                 allSuccess = false;
             }
         }
+    };
+    const std::size_t workers = std::min<std::size_t>(static_cast<std::size_t>(config_.startConcurrency), all.size());
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < workers; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
     }
 
     return allSuccess;
 }
 
 void MultiUavManager::stopAll() {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    for (auto& [uavId, entry] : uavs_) {
-        if (entry.running) {
-            entry.agent->stop();
-            entry.running = false;
-            std::cout << "[MultiUavManager] Stopped UAV: " << uavId << std::endl;
-        }
+    for (const auto& entry : entries()) {
+        stopEntry(*entry);
     }
 }
 
 bool MultiUavManager::startUav(const std::string& uavId) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = uavs_.find(uavId);
-    if (it == uavs_.end()) {
+    auto entry = find(uavId);
+    if (!entry) {
         std::cerr << "[MultiUavManager] UAV not found: " << uavId << std::endl;
         return false;
     }
-
-    if (it->second.running) {
-        return true;  // 已经在运行
-    }
-
-    if (it->second.agent->start()) {
-        it->second.running = true;
-        std::cout << "[MultiUavManager] Started UAV: " << uavId << std::endl;
-        return true;
-    }
-
-    return false;
+    return startEntry(*entry);
 }
 
 void MultiUavManager::stopUav(const std::string& uavId) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = uavs_.find(uavId);
-    if (it == uavs_.end()) {
+    auto entry = find(uavId);
+    if (!entry) {
         std::cerr << "[MultiUavManager] UAV not found: " << uavId << std::endl;
         return;
     }
-
-    if (it->second.running) {
-        it->second.agent->stop();
-        it->second.running = false;
-        std::cout << "[MultiUavManager] Stopped UAV: " << uavId << std::endl;
-    }
+    stopEntry(*entry);
 }
 
 std::vector<std::string> MultiUavManager::getUavList() const {
     std::lock_guard<std::mutex> lock(mutex_);
 
     std::vector<std::string> list;
+    list.reserve(uavs_.size());
     for (const auto& [uavId, entry] : uavs_) {
         list.push_back(uavId);
     }
@@ -137,14 +179,47 @@ std::vector<std::string> MultiUavManager::getUavList() const {
 }
 
 bool MultiUavManager::isUavRunning(const std::string& uavId) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = find(uavId);
+    return entry && entry->running.load();
+}
 
+std::shared_ptr<MultiUavManager::UavEntry> MultiUavManager::find(const std::string& uavId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
     auto it = uavs_.find(uavId);
-    if (it == uavs_.end()) {
+    return it == uavs_.end() ? nullptr : it->second;
+}
+
+std::vector<std::shared_ptr<MultiUavManager::UavEntry>> MultiUavManager::entries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::shared_ptr<UavEntry>> all;
+    all.reserve(uavs_.size());
+    for (const auto& [uavId, entry] : uavs_) {
+        all.push_back(entry);
+    }
+    return all;
+}
+
+bool MultiUavManager::startEntry(UavEntry& entry) {
+    std::lock_guard<std::mutex> lock(entry.lifecycleMutex);
+    if (entry.running) {
+        return true;  // 已经在运行
+    }
+    if (!entry.agent->start()) {
+        std::cerr << "[MultiUavManager] Failed to start UAV: " << entry.config.uavId << std::endl;
         return false;
     }
+    entry.running = true;
+    std::cout << "[MultiUavManager] Started UAV: " << entry.config.uavId << std::endl;
+    return true;
+}
 
-    return it->second.running;
+void MultiUavManager::stopEntry(UavEntry& entry) {
+    std::lock_guard<std::mutex> lock(entry.lifecycleMutex);
+    if (entry.running) {
+        entry.agent->stop();
+        entry.running = false;
+        std::cout << "[MultiUavManager] Stopped UAV: " << entry.config.uavId << std::endl;
+    }
 }
 
 } // namespace nodeagent
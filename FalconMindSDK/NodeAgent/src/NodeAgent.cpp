@@ -3,6 +3,9 @@
 #include "nodeagent/DownlinkClient.h"
 #include "nodeagent/MqttUplinkClient.h"
 #include "nodeagent/MqttDownlinkClient.h"
+#include "nodeagent/QuicSession.h"
+#include "nodeagent/QuicUplinkClient.h"
+#include "nodeagent/QuicDownlinkClient.h"
 #include "nodeagent/CommandHandler.h"
 #include "nodeagent/MissionHandler.h"
 #include "nodeagent/FlowHandler.h"
@@ -11,47 +14,184 @@
 #include "nodeagent/ErrorCodes.h"
 #include "nodeagent/ErrorStatistics.h"
 #include "nodeagent/ReconnectManager.h"
+#include "nodeagent/EventLoop.h"
+#include "nodeagent/SwarmLink.h"
+#include "falconmind/sdk/core/BootProfiler.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/core/Trace.h"
+#include "falconmind/sdk/perception/PerceptionPluginManager.h"
 #include "falconmind/sdk/telemetry/TelemetryPublisher.h"
+#include "falconmind/sdk/telemetry/TelemetryCodec.h"
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <chrono>
 #include <thread>
+#include <sys/epoll.h>
 
 namespace nodeagent {
 
 using namespace falconmind::sdk::telemetry;
+using falconmind::sdk::core::BootProfiler;
+using falconmind::sdk::core::BootSpan;
+
+namespace {
+
+// 遥测发布线程交给事件循环的队列容量（与原异步订阅的队列深度一致）
+constexpr std::size_t kTelemetryQueueDepth = 8;
+
+ReconnectManager::Config reconnectConfig(const NodeAgent::Config& config) {
+    ReconnectManager::Config cfg;
+    cfg.enabled = config.enableAutoReconnect;
+    cfg.maxRetries = config.maxReconnectRetries;
+    cfg.initialDelay = std::chrono::milliseconds(config.reconnectInitialDelayMs);
+    cfg.fastRetry = config.reconnectFastRetry;
+    cfg.poorLinkThreshold = config.reconnectPoorLinkThreshold;
+    return cfg;
+}
+
+} // namespace
 
 NodeAgent::NodeAgent(const Config& config)
-    : config_(config) {
+    : NodeAgent(config, nullptr) {
+}
+
+NodeAgent::NodeAgent(const Config& config, std::shared_ptr<EventLoop> sharedLoop)
+    : config_(config), backoff_(reconnectConfig(config).backoff()) {
     // 设置日志级别（将 int 转换为 LogLevel）
     LogLevel level = static_cast<LogLevel>(config.logLevel);
     if (level < LogLevel::DEBUG) level = LogLevel::DEBUG;
     if (level > LogLevel::FATAL) level = LogLevel::FATAL;
     Logger::instance().setLevel(level);
+    if (!config.bootTracePath.empty()) {
+        BootProfiler::instance().enable(config.bootTracePath);
+    }
     
+    // TCP 事件循环模式：下行接收、写合并与重连都由循环线程调度，不需要 ReconnectManager 线程
+    if (config.useEventLoop && config.protocol == Protocol::TCP) {
+        if (sharedLoop && sharedLoop->valid()) {
+            loop_ = std::move(sharedLoop);
+            sharedLoop_ = true;
+        } else {
+            loop_ = std::make_shared<EventLoop>();
+        }
+        if (!loop_->valid()) {
+            LOG_WARN("NodeAgent", "Event loop unavailable, falling back to threaded I/O");
+            loop_.reset();
+        }
+    }
+
     // 创建重连管理器
-    if (config.enableAutoReconnect) {
-        ReconnectManager::Config reconnectCfg;
-        reconnectCfg.enabled = true;
-        reconnectCfg.maxRetries = config.maxReconnectRetries;
-        reconnectCfg.initialDelay = std::chrono::milliseconds(config.reconnectInitialDelayMs);
-        reconnectManager_ = std::make_unique<ReconnectManager>(reconnectCfg);
+    if (config.enableAutoReconnect && !loop_) {
+        reconnectManager_ = std::make_unique<ReconnectManager>(reconnectConfig(config));
     }
     
-    UplinkClient::Config uplinkCfg;
-    uplinkCfg.centerAddress = config.centerAddress;
-    uplinkCfg.centerPort = config.centerPort;
-    uplinkClient_ = std::make_unique<UplinkClient>(uplinkCfg);
+    std::shared_ptr<QuicSession> quicSession;
+    std::shared_ptr<PayloadCodec> payloadCodec;  // TCP 上下行共用
+    if (config.protocol == Protocol::QUIC) {
+        // 上行与下行共用一条 QUIC 连接；连接、收发回调由 msquic 工作线程驱动，使用线程模式
+        QuicSession::Config sessionCfg;
+        sessionCfg.serverAddress = config.centerAddress;
+        sessionCfg.serverPort = config.quicPort;
+        sessionCfg.serverName = config.quicServerName;
+        sessionCfg.verifyCertificate = config.quicVerifyCertificate;
+        sessionCfg.caFile = config.quicCaFile;
+        sessionCfg.localAddress = config.quicLocalAddress;
+        sessionCfg.connectTimeoutMs = config.connectTimeoutMs;
+        sessionCfg.enableDatagrams = config.quicTelemetryOverDatagrams;
+        sessionCfg.resumptionTicketPath = config.quicTicketPath;
+        quicSession = std::make_shared<QuicSession>(sessionCfg);
+        if (!QuicSession::available()) {
+            LOG_WARN("NodeAgent", "QUIC protocol selected but NodeAgent was built without msquic");
+        }
+        QuicUplinkClient::Config quicUplinkCfg;
+        quicUplinkCfg.telemetryEncoding = config.telemetryEncoding;
+        quicUplinkCfg.delta = config.telemetryDelta;
+        quicUplinkCfg.telemetryOverDatagrams = config.quicTelemetryOverDatagrams;
+        uplinkClient_ = std::make_unique<QuicUplinkClient>(quicSession, quicUplinkCfg);
+    } else {
+        UplinkClient::Config uplinkCfg;
+        uplinkCfg.centerAddress = config.centerAddress;
+        uplinkCfg.centerPort = config.centerPort;
+        uplinkCfg.telemetryEncoding = config.telemetryEncoding;
+        uplinkCfg.delta = config.telemetryDelta;
+        auto uplink = std::make_unique<UplinkClient>(uplinkCfg);
+        payloadCodec = PayloadCodec::create(config.compression);
+        uplink->setPayloadCodec(payloadCodec);
+        if (loop_) {
+            // 写合并的等待由循环中的 timerfd 计时，替代 UplinkClient 的后台线程；
+            // 共享循环可能已在运行，定时器在循环线程中注册
+            UplinkClient* tcpUplink = uplink.get();
+            loop_->runSync([&]() {
+                flushTimer_ = loop_->addTimer([this, tcpUplink]() {
+                    if (!tcpUplink->flushDue()) {
+                        handleConnectionLost("Uplink write failed");
+                    }
+                });
+                uplink->setFlushScheduler([this](int delayMs) { loop_->armTimer(flushTimer_, delayMs); });
+                updateTimer_ = loop_->addTimer([this]() {
+                    updateHandlers();
+                    if (downlinkFd_ >= 0 && !uplinkClient_->isConnected()) {
+                        handleConnectionLost("Uplink client disconnected");
+                    }
+                });
+                reconnectTimer_ = loop_->addTimer([this]() { attemptReconnect(); });
+                connectTimer_ = loop_->addTimer([this, tcpUplink]() {
+                    // 非阻塞连接超时：放弃本次尝试并按退避重试
+                    if (connectingFd_ < 0) {
+                        return;
+                    }
+                    loop_->removeFd(connectingFd_);
+                    connectingFd_ = -1;
+                    tcpUplink->abortConnect();
+                    LOG_WARN("NodeAgent", "Connect timed out after " + std::to_string(config_.connectTimeoutMs) + "ms");
+                    scheduleReconnect();
+                });
+            });
+        }
+        uplinkClient_ = std::move(uplink);
+    }
+
+    if (!config.spool.directory.empty()) {
+        spool_ = TelemetrySpool::open(config.spool);
+        if (!spool_) {
+            LOG_WARN("NodeAgent", "Store-and-forward spool disabled: cannot open " + config.spool.directory);
+        }
+    }
+
+    if (!config.definitionCache.directory.empty()) {
+        definitionTransfer_ = DefinitionTransfer::open(config.definitionCache);
+        if (!definitionTransfer_) {
+            LOG_WARN("NodeAgent", "Definition transfer disabled: cannot open " + config.definitionCache.directory);
+        } else {
+            definitionTransfer_->setDeployCallback([this](DefinitionKind kind, const std::string& sha256,
+                                                          std::string content, const DownlinkMessage& request) {
+                return deployDefinition(kind, sha256, std::move(content), request);
+            });
+            definitionTransfer_->setStatusCallback(
+                [this](const DefinitionTransferStatus& status) { reportTransferStatus(status); });
+        }
+    }
 
     DownlinkClient::Config downlinkCfg;
     downlinkCfg.centerAddress = config.centerAddress;
     downlinkCfg.centerPort = config.centerPort;
-    downlinkClient_ = std::make_unique<DownlinkClient>(downlinkCfg);
+    if (quicSession) {
+        downlinkClient_ = std::make_unique<QuicDownlinkClient>(quicSession);
+    } else {
+        auto downlink = std::make_unique<DownlinkClient>(downlinkCfg);
+        downlink->setPayloadCodec(payloadCodec);
+        downlinkClient_ = std::move(downlink);
+    }
 
     commandHandler_ = std::make_unique<CommandHandler>();
     missionHandler_ = std::make_unique<MissionHandler>();
     flowHandler_ = std::make_unique<FlowHandler>();
+    if (!config.fastBoot.planCacheDirectory.empty()) {
+        flowHandler_->setPlanCacheDirectory(config.fastBoot.planCacheDirectory);
+    }
     ackManager_ = std::make_unique<MessageAckManager>(MessageAckManager::Config{});
     
     // 设置FlowHandler的状态上报回调（通过UplinkClient上报）
@@ -74,8 +214,27 @@ NodeAgent::NodeAgent(const Config& config)
         handleDownlinkMessage(msg);
     });
 
-    // 设置 ACK 处理器
+    if (config.clockSync.enabled) {
+        clockSync_ = std::make_unique<ClockSync>(config.clockSync);
+    }
+    if (config.swarm.enabled) {
+        swarmLink_ = std::make_unique<SwarmLink>(config.swarm, config.uavId, config.routeTelemetryByUavId);
+    }
+    if (config.metricsRollup.windowMs > 0) {
+        metricsRollup_ = std::make_unique<MetricsRollupPublisher>(
+            falconmind::sdk::core::MetricsAggregator::instance(), TelemetryPublisher::instance(), config.uavId,
+            config.metricsRollup);
+    }
+
+    // 设置 ACK 处理器（时钟同步应答也经 ACK 路径返回）
     downlinkClient_->setAckHandler([this](const std::string& messageId) {
+        if (clockSync_) {
+            const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            if (clockSync_->handleReply(messageId, nowNs)) {
+                return;
+            }
+        }
         if (ackManager_) {
             ackManager_->acknowledgeMessage(messageId);
         }
@@ -85,39 +244,12 @@ NodeAgent::NodeAgent(const Config& config)
     if (reconnectManager_) {
         reconnectManager_->setReconnectCallback([this]() {
             LOG_INFO("NodeAgent", "Attempting to reconnect...");
-            // 尝试重新连接上行和下行客户端
-            bool uplinkOk = uplinkClient_->connect();
-            if (!uplinkOk) {
-                return false;
-            }
-            
-            // 根据协议类型连接下行
-            if (config_.protocol == Protocol::TCP) {
-                auto* tcpUplink = dynamic_cast<UplinkClient*>(uplinkClient_.get());
-                auto* tcpDownlink = dynamic_cast<DownlinkClient*>(downlinkClient_.get());
-                if (tcpUplink && tcpDownlink) {
-                    if (!tcpDownlink->connect(tcpUplink->getSocketFd())) {
-                        uplinkClient_->disconnect();
-                        return false;
-                    }
-                } else {
-                    uplinkClient_->disconnect();
-                    return false;
-                }
-            } else {
-                if (!downlinkClient_->connect()) {
-                    uplinkClient_->disconnect();
-                    return false;
-                }
-            }
-            
-            // 重新启动接收
-            if (!downlinkClient_->startReceiving(config_.uavId)) {
-                downlinkClient_->disconnect();
-                uplinkClient_->disconnect();
+            // 回收上一连接已退出的接收线程，再重新连接上行和下行客户端
+            downlinkClient_->stopReceiving();
+            downlinkClient_->disconnect();
+            if (!connectTransport()) {
                 return false;
             }
-            
             LOG_INFO("NodeAgent", "Reconnection successful");
             return true;
         });
@@ -126,6 +258,14 @@ NodeAgent::NodeAgent(const Config& config)
 
 NodeAgent::~NodeAgent() {
     stop();
+    if (sharedLoop_) {
+        // 共享循环比本对象活得久：移除注册在其上的定时器（同时执行完此前投递的遥测任务）
+        loop_->runSync([this]() {
+            for (int timerId : {flushTimer_, updateTimer_, reconnectTimer_, connectTimer_}) {
+                loop_->removeTimer(timerId);
+            }
+        });
+    }
 }
 
 bool NodeAgent::start() {
@@ -133,10 +273,64 @@ bool NodeAgent::start() {
         LOG_WARN("NodeAgent", "Already running");
         return false;
     }
+    BootSpan span("NodeAgent::start", "agent");
 
-    // 连接到 Cluster Center（上行）
-    if (!uplinkClient_->connect()) {
-        LOG_ERROR("NodeAgent", "Failed to connect to Cluster Center at " + 
+    // 快速启动：计划缓存中的上一个 Flow 与模型预加载不依赖 Cluster Center，与连接并行进行
+    std::thread resumeThread;
+    bool resumed = false;
+    if (config_.fastBoot.enabled) {
+        if (perceptionPlugins_) {
+            for (const auto& detectorId : config_.fastBoot.preloadDetectors) {
+                perceptionPlugins_->preloadDetector(detectorId);
+            }
+        } else if (!config_.fastBoot.preloadDetectors.empty()) {
+            LOG_WARN("NodeAgent", "Fast boot: preloadDetectors ignored, no PerceptionPluginManager set");
+        }
+        resumeThread = std::thread([this, &resumed]() { resumed = flowHandler_->resumeLastFlow(); });
+    }
+
+    // 机间链路不依赖 Cluster Center：中心不可达（重连中）时编队与目标交接仍在本地进行
+    if (swarmLink_ && !swarmLink_->isRunning() && !swarmLink_->start()) {
+        LOG_WARN("NodeAgent", "Swarm link failed to start, continuing without peer-to-peer state");
+    }
+    // 指标汇总同样不依赖连接：未连接时的汇总写入断链缓存，重连后补发
+    if (metricsRollup_ && !metricsRollup_->isRunning()) {
+        rollupSubId_ = TelemetryPublisher::instance().subscribeRollup([this](const MetricsRollupMessage& msg) {
+            if (msg.uavId == config_.uavId) {
+                sendUplinkMessage(falconmind::sdk::core::toJson(msg.rollup, msg.uavId), SpoolClass::Telemetry);
+            }
+        });
+        metricsRollup_->start();
+    }
+
+    // 连接到 Cluster Center（上行 + 下行）
+    bool connected = false;
+    const std::int64_t connectStartNs = BootProfiler::nowNs();
+    if (sharedLoop_) {
+        // 阻塞的连接与编码协商在调用线程进行，不占用共享循环；下行注册与订阅在循环线程中一次完成
+        if (uplinkClient_->connect()) {
+            loop_->runSync([this, &connected]() {
+                connected = attachDownlink();
+                if (connected) {
+                    running_ = true;
+                    beginLoopMode();
+                }
+            });
+        }
+    } else {
+        connected = connectTransport();
+    }
+    BootProfiler::instance().record(connected ? "NodeAgent::connect" : "NodeAgent::connect (failed)", "agent",
+                                    connectStartNs, BootProfiler::nowNs());
+    if (resumeThread.joinable()) {
+        resumeThread.join();
+    }
+    if (resumed) {
+        // 连接失败时状态写入断链缓存（若启用），重连后补发
+        reportFlowStatus(flowHandler_->getCurrentFlowId(), "RUNNING");
+    }
+    if (!connected) {
+        LOG_ERROR("NodeAgent", "Failed to connect to Cluster Center at " +
                   config_.centerAddress + ":" + std::to_string(config_.centerPort));
         if (reconnectManager_) {
             reconnectManager_->triggerReconnect();
@@ -144,30 +338,67 @@ bool NodeAgent::start() {
         return false;
     }
 
+    if (!sharedLoop_) {
+        running_ = true;
+        workerThread_ = std::thread(&NodeAgent::workerLoop, this);
+    }
+
+    LOG_INFO("NodeAgent", "Started (uavId=" + config_.uavId +
+             ", center=" + config_.centerAddress + ":" + std::to_string(config_.centerPort) +
+             ", protocol=" + (config_.protocol == Protocol::TCP    ? "TCP"
+                              : config_.protocol == Protocol::QUIC ? "QUIC"
+                                                                   : "MQTT") +
+             (sharedLoop_ ? ", io=shared-event-loop" : loop_ ? ", io=event-loop" : ", io=threaded") + ")");
+    return true;
+}
+
+bool NodeAgent::connectTransport() {
+    if (!uplinkClient_->connect()) {
+        return false;
+    }
+    return attachDownlink();
+}
+
+bool NodeAgent::attachDownlink() {
     // 连接下行客户端
     // TCP 协议：复用上行连接的 socket（双向通信）
     // MQTT 协议：独立连接
+    // QUIC 协议：与上行共用 QuicSession，connect() 复用已建立的连接
     if (config_.protocol == Protocol::TCP) {
         // 需要将 IUplinkClient 转换为 UplinkClient 以获取 socket fd
         auto* tcpUplink = dynamic_cast<UplinkClient*>(uplinkClient_.get());
         auto* tcpDownlink = dynamic_cast<DownlinkClient*>(downlinkClient_.get());
-        if (tcpUplink && tcpDownlink) {
-            if (!tcpDownlink->connect(tcpUplink->getSocketFd())) {
-                LOG_ERROR("NodeAgent", "Failed to setup downlink client");
-                uplinkClient_->disconnect();
-                return false;
-            }
-        } else {
+        if (!tcpUplink || !tcpDownlink) {
             LOG_ERROR("NodeAgent", "Invalid client type for TCP protocol");
+            uplinkClient_->disconnect();
             return false;
         }
-    } else {
-        // MQTT 协议：下行客户端独立连接
-        if (!downlinkClient_->connect()) {
-            LOG_ERROR("NodeAgent", "Failed to connect downlink client");
+        if (!tcpDownlink->connect(tcpUplink->getSocketFd())) {
+            LOG_ERROR("NodeAgent", "Failed to setup downlink client");
             uplinkClient_->disconnect();
             return false;
         }
+        if (loop_) {
+            // 事件循环模式：socket 可读时在循环线程中读取并分发，不启动接收线程
+            const int fd = tcpUplink->getSocketFd();
+            const bool added = loop_->addFd(fd, EPOLLIN | EPOLLRDHUP, [this, tcpDownlink](std::uint32_t) {
+                if (!tcpDownlink->readAvailable()) {
+                    handleConnectionLost("Downlink connection closed");
+                }
+            });
+            if (!added) {
+                downlinkClient_->disconnect();
+                uplinkClient_->disconnect();
+                return false;
+            }
+            downlinkFd_ = fd;
+            restartClockSync();
+            return true;
+        }
+    } else if (!downlinkClient_->connect()) {
+        LOG_ERROR("NodeAgent", "Failed to connect downlink client");
+        uplinkClient_->disconnect();
+        return false;
     }
 
     // 启动下行消息接收
@@ -179,22 +410,31 @@ bool NodeAgent::start() {
         uplinkClient_->disconnect();
         return false;
     }
-
-    running_ = true;
-    workerThread_ = std::thread(&NodeAgent::workerLoop, this);
-
-    LOG_INFO("NodeAgent", "Started (uavId=" + config_.uavId + 
-             ", center=" + config_.centerAddress + ":" + std::to_string(config_.centerPort) + 
-             ", protocol=" + (config_.protocol == Protocol::TCP ? "TCP" : "MQTT") + ")");
+    restartClockSync();
     return true;
 }
 
 void NodeAgent::stop() {
+    if (swarmLink_) {
+        swarmLink_->stop();
+    }
+    if (metricsRollup_ && metricsRollup_->isRunning()) {
+        metricsRollup_->stop();  // 最后一个未满窗口在此发布
+        TelemetryPublisher::instance().unsubscribe(rollupSubId_);
+        rollupSubId_ = -1;
+    }
     if (!running_) {
         return;
     }
 
-    running_ = false;
+    {
+        std::lock_guard<std::mutex> lock(workerMutex_);
+        running_ = false;
+    }
+    workerCv_.notify_all();
+    if (loop_ && !sharedLoop_) {
+        loop_->stop();
+    }
     if (workerThread_.joinable()) {
         workerThread_.join();
     }
@@ -203,7 +443,20 @@ void NodeAgent::stop() {
     if (reconnectManager_) {
         reconnectManager_->stop();
     }
-    
+    if (loop_) {
+        // 自有循环已停止时直接执行
+        loop_->runSync([this]() {
+            if (sharedLoop_) {
+                endLoopMode();
+            }
+            if (downlinkFd_ >= 0) {
+                loop_->removeFd(downlinkFd_);
+                downlinkFd_ = -1;
+            }
+            reconnecting_ = false;
+        });
+    }
+
     downlinkClient_->stopReceiving();
     downlinkClient_->disconnect();
     uplinkClient_->disconnect();
@@ -234,45 +487,60 @@ void NodeAgent::setFlightConnectionService(std::shared_ptr<falconmind::sdk::flig
     }
 }
 
+void NodeAgent::setPerceptionPluginManager(
+    std::shared_ptr<falconmind::sdk::perception::PerceptionPluginManager> manager) {
+    perceptionPlugins_ = std::move(manager);
+}
+
 void NodeAgent::workerLoop() {
-    // 订阅 SDK TelemetryPublisher
-    int subId = TelemetryPublisher::instance().subscribe(
-        [this](const TelemetryMessage& msg) {
+    if (loop_) {
+        runEventLoop();
+        return;
+    }
+
+    // 订阅 SDK TelemetryPublisher：异步订阅，上行 send() 阻塞时只在本订阅队列中合并旧遥测，不阻塞发布线程
+    AsyncSubscribeOptions subOptions;
+    subOptions.queueDepth = kTelemetryQueueDepth;
+    subOptions.conflate = true;
+    auto onTelemetry = [this](const TelemetryMessage& msg) {
             // 将 Telemetry 发送到 Cluster Center
             if (uplinkClient_->isConnected()) {
-                if (!uplinkClient_->sendTelemetry(msg)) {
+                if (!sendTelemetry(msg)) {
+                    spoolTelemetry(msg);
                     // 发送失败，触发重连
                     if (reconnectManager_ && !reconnectManager_->isReconnecting()) {
                         LOG_WARN("NodeAgent", "Telemetry send failed, triggering reconnect");
-                        reconnectManager_->triggerReconnect();
+                        reconnectManager_->triggerReconnect(true);
                     }
                 }
             } else {
+                spoolTelemetry(msg);
                 // 未连接，触发重连
                 if (reconnectManager_ && !reconnectManager_->isReconnecting()) {
                     LOG_WARN("NodeAgent", "Uplink client disconnected, triggering reconnect");
-                    reconnectManager_->triggerReconnect();
+                    reconnectManager_->triggerReconnect(true);
                 }
             }
-        });
+            if (reconnectManager_) {
+                reconnectManager_->updateLinkQuality(msg.linkQuality);
+            }
+        };
+    int subId = config_.routeTelemetryByUavId
+                    ? TelemetryPublisher::instance().subscribeAsync(config_.uavId, onTelemetry, subOptions)
+                    : TelemetryPublisher::instance().subscribeAsync(onTelemetry, subOptions);
 
     LOG_INFO("NodeAgent", "Subscribed to SDK TelemetryPublisher (id=" + std::to_string(subId) + ")");
 
     // 主循环：等待 Telemetry 事件（实际由订阅回调处理），并更新任务执行和消息确认
     while (running_) {
-        // 更新任务执行（如果任务正在运行）
-        if (missionHandler_) {
-            missionHandler_->update();
-        }
-        // 更新Flow执行（如果Flow正在运行）
-        if (flowHandler_) {
-            flowHandler_->update();
-        }
-        // 更新消息确认管理器（检查超时和重传）
-        if (ackManager_) {
-            ackManager_->update();
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        updateHandlers();
+        // 按 PipelineClock 计时：虚拟时钟下周期在虚拟时刻到期，测试不必等待墙钟
+        using falconmind::sdk::core::PipelineClock;
+        std::unique_lock<std::mutex> lock(workerMutex_);
+        PipelineClock::waitUntil(
+            workerCv_, lock,
+            PipelineClock::nowNs() + std::chrono::nanoseconds(std::chrono::milliseconds(config_.updateIntervalMs)).count(),
+            [this] { return !running_; });
     }
 
     // 取消订阅
@@ -280,6 +548,189 @@ void NodeAgent::workerLoop() {
     LOG_INFO("NodeAgent", "Unsubscribed from SDK TelemetryPublisher");
 }
 
+void NodeAgent::runEventLoop() {
+    beginLoopMode();
+    loop_->run();
+    endLoopMode();
+}
+
+void NodeAgent::beginLoopMode() {
+    // 同步订阅：发布线程只把消息放入有界队列并在队列由空变非空时唤醒循环，发送在循环线程中进行
+    auto onTelemetry = [this](const TelemetryMessage& msg) { enqueueTelemetry(msg); };
+    telemetrySubId_ = config_.routeTelemetryByUavId
+                          ? TelemetryPublisher::instance().subscribe(config_.uavId, onTelemetry)
+                          : TelemetryPublisher::instance().subscribe(onTelemetry);
+    LOG_INFO("NodeAgent", "Subscribed to SDK TelemetryPublisher (id=" + std::to_string(telemetrySubId_) + ", event loop)");
+
+    loop_->armTimer(updateTimer_, config_.updateIntervalMs, config_.updateIntervalMs);
+}
+
+void NodeAgent::endLoopMode() {
+    loop_->disarmTimer(updateTimer_);
+    loop_->disarmTimer(reconnectTimer_);
+    loop_->disarmTimer(connectTimer_);
+    if (connectingFd_ >= 0) {
+        loop_->removeFd(connectingFd_);
+        connectingFd_ = -1;
+    }
+
+    TelemetryPublisher::instance().unsubscribe(telemetrySubId_);
+    telemetrySubId_ = -1;
+    LOG_INFO("NodeAgent", "Unsubscribed from SDK TelemetryPublisher");
+}
+
+void NodeAgent::updateHandlers() {
+    // 回收已结束的任务（行为树在 MissionHandler 的任务线程中事件驱动执行）
+    if (missionHandler_) {
+        missionHandler_->update();
+    }
+    // 更新Flow执行（如果Flow正在运行）
+    if (flowHandler_) {
+        flowHandler_->update();
+    }
+    // 更新消息确认管理器（检查超时和重传）
+    if (ackManager_) {
+        ackManager_->update();
+    }
+    // 重连后限速补发断链期间缓存的消息
+    drainSpool();
+    sendClockProbe();
+}
+
+void NodeAgent::enqueueTelemetry(const TelemetryMessage& msg) {
+    bool wasEmpty = false;
+    {
+        std::lock_guard<std::mutex> lock(telemetryMutex_);
+        wasEmpty = telemetryQueue_.empty();
+        if (telemetryQueue_.size() >= kTelemetryQueueDepth) {
+            telemetryQueue_.pop_front();  // 循环线程阻塞在发送上时合并旧遥测
+        }
+        telemetryQueue_.push_back(msg);
+    }
+    if (wasEmpty) {
+        loop_->post([this]() { sendQueuedTelemetry(); });
+    }
+}
+
+void NodeAgent::sendQueuedTelemetry() {
+    std::deque<TelemetryMessage> batch;
+    {
+        std::lock_guard<std::mutex> lock(telemetryMutex_);
+        batch.swap(telemetryQueue_);
+    }
+    for (const TelemetryMessage& msg : batch) {
+        // 电台衰落结束：不等退避到期，立即重连
+        if (backoff_.updateLinkQuality(msg.linkQuality) && reconnecting_ && connectingFd_ < 0) {
+            LOG_INFO("NodeAgent", "Link quality recovered, reconnecting now");
+            loop_->armTimer(reconnectTimer_, 0);
+        }
+        // 将 Telemetry 发送到 Cluster Center；重连期间直接写入断链缓存
+        if (downlinkFd_ >= 0 && uplinkClient_->isConnected() && sendTelemetry(msg)) {
+            continue;
+        }
+        spoolTelemetry(msg);
+        handleConnectionLost(uplinkClient_->isConnected() ? "Telemetry send failed" : "Uplink client disconnected");
+    }
+}
+
+void NodeAgent::handleConnectionLost(const std::string& reason) {
+    const bool transient = downlinkFd_ >= 0;  // 已建立的连接中断（而非启动时连不上）
+    if (downlinkFd_ >= 0) {
+        LOG_WARN("NodeAgent", reason);
+        loop_->removeFd(downlinkFd_);
+        downlinkFd_ = -1;
+        downlinkClient_->disconnect();
+        uplinkClient_->disconnect();
+    }
+    if (!config_.enableAutoReconnect || reconnecting_ || !running_) {
+        return;
+    }
+    // 与 ReconnectManager 相同的策略：瞬断先快速重试一次，之后按抖动退避等待
+    reconnecting_ = true;
+    reconnectAttempts_ = 0;
+    loop_->armTimer(reconnectTimer_, static_cast<int>(backoff_.begin(transient).count()));
+}
+
+void NodeAgent::attemptReconnect() {
+    if (!reconnecting_ || !running_) {
+        reconnecting_ = false;
+        return;
+    }
+    if (connectingFd_ >= 0) {
+        return;  // 上一次非阻塞连接尚未完成
+    }
+    auto* tcpUplink = dynamic_cast<UplinkClient*>(uplinkClient_.get());
+    if (!tcpUplink) {
+        LOG_ERROR("NodeAgent", "Invalid client type for TCP protocol");
+        reconnecting_ = false;
+        return;
+    }
+
+    // 电台衰落期间的低频探测不计入重试次数
+    const bool probing = backoff_.linkPoor();
+    if (!probing) {
+        ++reconnectAttempts_;
+    }
+    const int maxRetries = config_.maxReconnectRetries;
+    LOG_INFO("NodeAgent", (probing ? std::string("Link fading, probe attempt ") : std::string("Reconnection attempt ")) +
+             std::to_string(reconnectAttempts_) + (maxRetries >= 0 ? "/" + std::to_string(maxRetries) : ""));
+
+    // 非阻塞连接：等待握手期间循环继续处理遥测缓存、定时器等
+    switch (tcpUplink->beginConnect()) {
+        case UplinkClient::ConnectProgress::Connected:
+            if (attachDownlink()) {
+                onReconnectSucceeded();
+            } else {
+                scheduleReconnect();
+            }
+            return;
+        case UplinkClient::ConnectProgress::Failed:
+            scheduleReconnect();
+            return;
+        case UplinkClient::ConnectProgress::InProgress:
+            break;
+    }
+
+    const int fd = tcpUplink->getSocketFd();
+    const bool added = loop_->addFd(fd, EPOLLOUT, [this, tcpUplink](std::uint32_t) {
+        loop_->removeFd(connectingFd_);
+        connectingFd_ = -1;
+        loop_->disarmTimer(connectTimer_);
+        if (tcpUplink->finishConnect() && attachDownlink()) {
+            onReconnectSucceeded();
+        } else {
+            scheduleReconnect();
+        }
+    });
+    if (!added) {
+        tcpUplink->abortConnect();
+        scheduleReconnect();
+        return;
+    }
+    connectingFd_ = fd;
+    loop_->armTimer(connectTimer_, config_.connectTimeoutMs);
+}
+
+void NodeAgent::onReconnectSucceeded() {
+    LOG_INFO("NodeAgent", "Reconnection successful after " + std::to_string(reconnectAttempts_) + " attempts");
+    reconnecting_ = false;
+    reconnectAttempts_ = 0;
+    backoff_.reset();
+}
+
+void NodeAgent::scheduleReconnect() {
+    const int maxRetries = config_.maxReconnectRetries;
+    if (!backoff_.linkPoor() && maxRetries >= 0 && reconnectAttempts_ >= maxRetries) {
+        LOG_ERROR("NodeAgent", "Max retry count (" + std::to_string(maxRetries) + ") reached. Giving up.");
+        reconnecting_ = false;
+        return;
+    }
+
+    const auto delay = backoff_.next();
+    LOG_WARN("NodeAgent", "Reconnection failed. Retrying in " + std::to_string(delay.count()) + "ms");
+    loop_->armTimer(reconnectTimer_, static_cast<int>(delay.count()));
+}
+
 void NodeAgent::handleDownlinkMessage(const DownlinkMessage& msg) {
     if (msg.type == DownlinkMessageType::Command) {
         if (commandHandler_) {
@@ -293,12 +744,70 @@ void NodeAgent::handleDownlinkMessage(const DownlinkMessage& msg) {
         if (flowHandler_) {
             flowHandler_->handleFlow(msg);
         }
+    } else if (msg.type == DownlinkMessageType::Transfer) {
+        if (definitionTransfer_) {
+            definitionTransfer_->handleMessage(msg);
+        } else {
+            LOG_WARN("NodeAgent", "Ignoring definition transfer: definitionCache.directory not configured");
+        }
+    }
+}
+
+bool NodeAgent::deployDefinition(DefinitionKind kind, const std::string& sha256, std::string content,
+                                 const DownlinkMessage& request) {
+    DownlinkMessage msg;
+    msg.type = kind == DefinitionKind::Mission ? DownlinkMessageType::Mission : DownlinkMessageType::Flow;
+    msg.uavId = request.uavId;
+    msg.payload = std::move(content);
+    msg.requestId = request.requestId;
+    msg.contentHash = sha256;
+    if (kind == DefinitionKind::Mission) {
+        return missionHandler_ && missionHandler_->handleMission(msg);
+    }
+    return flowHandler_ && flowHandler_->handleFlow(msg);
+}
+
+void NodeAgent::reportTransferStatus(const DefinitionTransferStatus& status) {
+    try {
+        nlohmann::json status_msg;
+        status_msg["type"] = "transfer_status";
+        status_msg["uav_id"] = config_.uavId;
+        status_msg["sha256"] = status.sha256;
+        status_msg["kind"] = definitionKindName(status.kind);
+        status_msg["state"] = status.state;
+        status_msg["received"] = status.received;
+        status_msg["chunks"] = status.chunks;
+        if (status.state == "need") {
+            status_msg["missing"] = status.missing;
+        }
+        if (status.state == "cached" || status.state == "complete") {
+            status_msg["deployed"] = status.deployed;
+        }
+        if (!status.requestId.empty()) {
+            status_msg["requestId"] = status.requestId;
+        }
+        if (!status.error.empty()) {
+            status_msg["error"] = status.error;
+        }
+        // need 只对当前连接有意义（重连后 Cluster Center 会重新 begin），不写入断链缓存
+        const std::string status_json = status_msg.dump();
+        const bool sent = status.state == "need"
+            ? uplinkClient_->isConnected() && uplinkClient_->sendMessage(stampMessage(status_json))
+            : sendUplinkMessage(status_json, SpoolClass::Event);
+        if (!sent) {
+            LOG_WARN("NodeAgent", "Cannot report transfer status: uplink client not connected");
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("NodeAgent", "Failed to report transfer status: " + std::string(e.what()));
     }
 }
 
 void NodeAgent::reportFlowStatus(const std::string& flow_id, const std::string& status, const std::string& error_msg) {
-    if (!uplinkClient_ || !uplinkClient_->isConnected()) {
-        LOG_WARN("NodeAgent", "Cannot report flow status: uplink client not connected");
+    if (status == "RUNNING") {
+        // 首个 Flow 进入运行即“感知就绪”：写出启动时间线（仅第一次）
+        BootProfiler::instance().finish("flow_running: " + flow_id);
+    }
+    if (!uplinkClient_) {
         return;
     }
 
@@ -315,9 +824,12 @@ void NodeAgent::reportFlowStatus(const std::string& flow_id, const std::string&
         status_msg["timestamp"] = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now().time_since_epoch()).count();
 
-        // 通过UplinkClient发送状态消息
+        // 通过UplinkClient发送状态消息（断链时写入缓存，重连后补发）
         std::string status_json = status_msg.dump();
-        uplinkClient_->sendMessage(status_json);
+        if (!sendUplinkMessage(status_json, SpoolClass::Event)) {
+            LOG_WARN("NodeAgent", "Cannot report flow status: uplink client not connected");
+            return;
+        }
         
         LOG_INFO("NodeAgent", "Flow status reported: " + flow_id + " -> " + status);
     } catch (const std::exception& e) {
@@ -325,4 +837,135 @@ void NodeAgent::reportFlowStatus(const std::string& flow_id, const std::string&
     }
 }
 
+bool NodeAgent::sendUplinkMessage(const std::string& message, SpoolClass cls) {
+    FM_TRACE_SCOPE("agent", "uplink.send");
+    // 在产生时打上时间戳：写入断链缓存的消息补发时仍带有原始时刻
+    const std::string stamped = stampMessage(message);
+    if (uplinkClient_->isConnected() && uplinkClient_->sendMessage(stamped, UplinkPriority::Event)) {
+        return true;
+    }
+    if (!spool_) {
+        return false;
+    }
+    const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return spool_->append(cls, stamped.data(), stamped.size(), nowNs);
+}
+
+ClockSyncStats NodeAgent::clockSyncStats() const {
+    return clockSync_ ? clockSync_->stats() : ClockSyncStats{};
+}
+
+SwarmLinkStats NodeAgent::swarmLinkStats() const {
+    return swarmLink_ ? swarmLink_->stats() : SwarmLinkStats{};
+}
+
+bool NodeAgent::sendTelemetry(const TelemetryMessage& msg) {
+    FM_TRACE_SCOPE("agent", "uplink.telemetry");
+    if (!clockSync_ || !config_.clockSync.correctTimestamps || !clockSync_->synced()) {
+        return uplinkClient_->sendTelemetry(msg);
+    }
+    TelemetryMessage corrected = msg;
+    corrected.timestampNs = clockSync_->toCenterTime(msg.timestampNs);
+    return uplinkClient_->sendTelemetry(corrected);
+}
+
+bool NodeAgent::sendReplayedTelemetry(const TelemetryMessage& msg) {
+    if (!clockSync_ || !config_.clockSync.correctTimestamps || !clockSync_->synced()) {
+        return uplinkClient_->sendReplayedTelemetry(msg);
+    }
+    // 缓存中保存的是本地时钟（断链期间的偏移变化远小于补发轨迹的时间分辨率）
+    TelemetryMessage corrected = msg;
+    corrected.timestampNs = clockSync_->toCenterTime(msg.timestampNs);
+    return uplinkClient_->sendReplayedTelemetry(corrected);
+}
+
+std::string NodeAgent::stampMessage(const std::string& message) const {
+    if (!clockSync_ || !config_.clockSync.correctTimestamps || message.size() < 2 || message.front() != '{' ||
+        message.back() != '}' || !clockSync_->synced()) {
+        return message;
+    }
+    const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::string stamped = message;
+    stamped.pop_back();
+    if (stamped.size() > 1) {
+        stamped.push_back(',');
+    }
+    stamped += "\"center_ts_ns\":" + std::to_string(clockSync_->toCenterTime(nowNs)) + "}";
+    return stamped;
+}
+
+void NodeAgent::restartClockSync() {
+    if (clockSync_) {
+        clockSync_->restart(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+}
+
+void NodeAgent::sendClockProbe() {
+    if (!clockSync_ || !uplinkClient_->isConnected()) {
+        return;
+    }
+    const auto steadyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (!clockSync_->probeDue(steadyNs)) {
+        return;
+    }
+    const auto systemNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    // Control 通道严格优先且不等待写合并，探测不会排在批量数据之后（否则 RTT 包含本地排队时间）
+    uplinkClient_->sendMessage(clockSync_->makeProbe(systemNs, steadyNs), UplinkPriority::Control);
+}
+
+TelemetrySpoolStats NodeAgent::spoolStats() const {
+    return spool_ ? spool_->stats() : TelemetrySpoolStats{};
+}
+
+void NodeAgent::spoolTelemetry(const TelemetryMessage& msg) {
+    if (!spool_) {
+        return;
+    }
+    // 常规遥测按间隔抽样，断链较久时缓存只保留稀疏轨迹，为事件与检测留出空间
+    const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    const std::int64_t intervalNs = static_cast<std::int64_t>(config_.spool.telemetrySampleIntervalMs) * 1000000;
+    if (lastSpooledTelemetryNs_ != 0 && nowNs - lastSpooledTelemetryNs_ < intervalNs) {
+        return;
+    }
+    // 以完整二进制帧保存（约为 JSON 的 1/3）；补发时还原为带 replay 标记的 JSON
+    std::array<std::uint8_t, kTelemetryFrameMaxBytes> frame;
+    const std::size_t size = encodeTelemetryFrame(msg, frame.data(), frame.size());
+    if (size > 0 && spool_->append(SpoolClass::Telemetry, frame.data(), size, msg.timestampNs)) {
+        lastSpooledTelemetryNs_ = nowNs;
+    }
+}
+
+void NodeAgent::drainSpool() {
+    if (!spool_ || !uplinkClient_->isConnected() || spool_->empty()) {
+        return;
+    }
+    const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    const std::size_t sent = spool_->drain(nowNs, [this](SpoolClass cls, const std::uint8_t* data, std::size_t size,
+                                                         std::int64_t) {
+        if (cls != SpoolClass::Telemetry) {
+            // 补发走 Bulk 通道：积压再多也不挡住实时事件与遥测；通道满时返回 false，记录留待下次补发
+            return uplinkClient_->sendMessage(std::string(reinterpret_cast<const char*>(data), size),
+                                              UplinkPriority::Bulk);
+        }
+        TelemetryMessage msg;
+        if (!decodeTelemetryFrame(data, size, msg)) {
+            return true;  // 损坏的记录直接丢弃
+        }
+        return sendReplayedTelemetry(msg);
+    });
+    if (sent > 0 && spool_->empty()) {
+        const TelemetrySpoolStats stats = spool_->stats();
+        LOG_INFO("NodeAgent", "Spool drained (events=" + std::to_string(stats.drained[0]) +
+                 ", detections=" + std::to_string(stats.drained[1]) +
+                 ", telemetry=" + std::to_string(stats.drained[2]) + ")");
+    }
+}
+
 } // namespace nodeagent
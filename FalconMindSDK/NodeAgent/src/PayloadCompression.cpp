@@ -0,0 +1,330 @@
+#include "nodeagent/PayloadCompression.h"
+#include "nodeagent/DownlinkClient.h"
+#include "nodeagent/Logger.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#ifdef NODEAGENT_ZSTD_ENABLED
+#include <zdict.h>
+#include <zstd.h>
+#endif
+
+namespace nodeagent {
+
+namespace {
+
+constexpr const char* kDictionarySuffix = ".zdict";
+constexpr const char* kDefaultDictionary = "default";
+
+bool startsWith(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+void writeFrameHeader(char* header, std::size_t length) {
+    const std::uint32_t field = static_cast<std::uint32_t>(length) | kFrameCompressedFlag;
+    header[0] = static_cast<char>(kDownlinkFrameMagic);
+    for (int i = 0; i < 4; ++i) {
+        header[1 + i] = static_cast<char>((field >> (8 * i)) & 0xFF);
+    }
+}
+
+} // namespace
+
+#ifdef NODEAGENT_ZSTD_ENABLED
+
+struct PayloadCodec::Dictionary {
+    std::string type;
+    std::uint32_t id{0};
+    ZSTD_CDict* cdict{nullptr};
+    ZSTD_DDict* ddict{nullptr};
+
+    ~Dictionary() {
+        ZSTD_freeCDict(cdict);
+        ZSTD_freeDDict(ddict);
+    }
+};
+
+struct PayloadCodec::Contexts {
+    ZSTD_CCtx* cctx{ZSTD_createCCtx()};
+    ZSTD_DCtx* dctx{ZSTD_createDCtx()};
+
+    ~Contexts() {
+        ZSTD_freeCCtx(cctx);
+        ZSTD_freeDCtx(dctx);
+    }
+};
+
+#else
+
+struct PayloadCodec::Dictionary {
+    std::string type;
+    std::uint32_t id{0};
+};
+
+struct PayloadCodec::Contexts {};
+
+#endif
+
+PayloadCodec::PayloadCodec(const PayloadCompressionConfig& config) : config_(config) {}
+
+PayloadCodec::~PayloadCodec() = default;
+
+bool PayloadCodec::available() noexcept {
+#ifdef NODEAGENT_ZSTD_ENABLED
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::shared_ptr<PayloadCodec> PayloadCodec::create(const PayloadCompressionConfig& config) {
+    if (!config.enabled) {
+        return nullptr;
+    }
+#ifdef NODEAGENT_ZSTD_ENABLED
+    std::shared_ptr<PayloadCodec> codec(new PayloadCodec(config));
+    codec->contexts_ = std::make_unique<Contexts>();
+    if (!codec->contexts_->cctx || !codec->contexts_->dctx) {
+        return nullptr;
+    }
+    if (config.dictionaryDirectory.empty()) {
+        return codec;
+    }
+
+    std::error_code ec;
+    std::filesystem::directory_iterator it(config.dictionaryDirectory, ec);
+    if (ec) {
+        LOG_WARN("PayloadCodec", "Cannot read dictionary directory " + config.dictionaryDirectory + ": " +
+                                     ec.message());
+        return nullptr;
+    }
+    for (const auto& entry : it) {
+        const auto& path = entry.path();
+        if (!entry.is_regular_file(ec) || path.extension() != kDictionarySuffix) {
+            continue;
+        }
+        std::ifstream in(path, std::ios::binary);
+        const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        // 只接受带字典 ID 的训练字典：解压端靠 zstd 帧头中的 ID 选字典
+        const unsigned id = content.empty() ? 0 : ZSTD_getDictID_fromDict(content.data(), content.size());
+        if (id == 0) {
+            LOG_WARN("PayloadCodec", "Ignoring " + path.string() + ": not a trained zstd dictionary");
+            continue;
+        }
+        const std::string type = path.stem().string();
+        if (codec->byId_.count(id) || codec->byType_.count(type)) {
+            LOG_WARN("PayloadCodec", "Ignoring " + path.string() + ": duplicate dictionary id or type");
+            continue;
+        }
+        auto dict = std::make_unique<Dictionary>();
+        dict->type = type;
+        dict->id = id;
+        dict->cdict = ZSTD_createCDict(content.data(), content.size(), config.level);
+        dict->ddict = ZSTD_createDDict(content.data(), content.size());
+        if (!dict->cdict || !dict->ddict) {
+            LOG_WARN("PayloadCodec", "Failed to load dictionary " + path.string());
+            continue;
+        }
+        codec->byType_[type] = dict.get();
+        codec->byId_[id] = dict.get();
+        codec->dictionaries_.push_back(std::move(dict));
+    }
+    LOG_INFO("PayloadCodec", "Loaded " + std::to_string(codec->dictionaries_.size()) + " zstd dictionaries from " +
+                                 config.dictionaryDirectory);
+    return codec;
+#else
+    LOG_WARN("PayloadCodec", "Payload compression requested but NodeAgent was built without zstd");
+    return nullptr;
+#endif
+}
+
+std::vector<std::uint32_t> PayloadCodec::dictionaryIds() const {
+    std::vector<std::uint32_t> ids;
+    ids.reserve(dictionaries_.size());
+    for (const auto& dict : dictionaries_) {
+        ids.push_back(dict->id);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+const PayloadCodec::Dictionary* PayloadCodec::dictionaryFor(std::string_view type,
+                                                            const std::vector<std::uint32_t>& peerDictionaries) const {
+    auto usable = [&](const Dictionary* dict) {
+        return std::find(peerDictionaries.begin(), peerDictionaries.end(), dict->id) != peerDictionaries.end();
+    };
+    if (!type.empty()) {
+        auto it = byType_.find(std::string(type));
+        if (it != byType_.end() && usable(it->second)) {
+            return it->second;
+        }
+    }
+    auto it = byType_.find(kDefaultDictionary);
+    if (it != byType_.end() && usable(it->second)) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+bool PayloadCodec::compressFrame(std::string_view message, const std::vector<std::uint32_t>& peerDictionaries,
+                                 std::string& out) {
+#ifdef NODEAGENT_ZSTD_ENABLED
+    if (message.size() < config_.minBytes) {
+        skipped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    const Dictionary* dict = dictionaryFor(messageType(message), peerDictionaries);
+    const std::size_t start = out.size();
+    const std::size_t bound = ZSTD_compressBound(message.size());
+    out.resize(start + kDownlinkFrameHeaderBytes + bound);
+    char* dst = &out[start + kDownlinkFrameHeaderBytes];
+    std::size_t n;
+    {
+        std::lock_guard<std::mutex> lock(compressMutex_);
+        n = dict ? ZSTD_compress_usingCDict(contexts_->cctx, dst, bound, message.data(), message.size(), dict->cdict)
+                 : ZSTD_compressCCtx(contexts_->cctx, dst, bound, message.data(), message.size(), config_.level);
+    }
+    if (ZSTD_isError(n)) {
+        out.resize(start);
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // 原格式为消息 + 换行分隔（或同样 5 字节的帧头），压缩帧须严格更小才值得
+    if (kDownlinkFrameHeaderBytes + n > message.size()) {
+        out.resize(start);
+        skipped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    writeFrameHeader(&out[start], n);
+    out.resize(start + kDownlinkFrameHeaderBytes + n);
+    compressed_.fetch_add(1, std::memory_order_relaxed);
+    rawBytes_.fetch_add(message.size(), std::memory_order_relaxed);
+    frameBytes_.fetch_add(kDownlinkFrameHeaderBytes + n, std::memory_order_relaxed);
+    return true;
+#else
+    (void)message;
+    (void)peerDictionaries;
+    (void)out;
+    return false;
+#endif
+}
+
+bool PayloadCodec::decompress(const void* data, std::size_t size, std::size_t maxBytes, std::string& out) {
+#ifdef NODEAGENT_ZSTD_ENABLED
+    const unsigned long long content = ZSTD_getFrameContentSize(data, size);
+    if (content == ZSTD_CONTENTSIZE_ERROR || content == ZSTD_CONTENTSIZE_UNKNOWN || content > maxBytes) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    const Dictionary* dict = nullptr;
+    if (const unsigned id = ZSTD_getDictID_fromFrame(data, size)) {
+        auto it = byId_.find(id);
+        if (it == byId_.end()) {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        dict = it->second;
+    }
+    out.resize(static_cast<std::size_t>(content));
+    std::size_t n;
+    {
+        std::lock_guard<std::mutex> lock(decompressMutex_);
+        n = dict ? ZSTD_decompress_usingDDict(contexts_->dctx, &out[0], out.size(), data, size, dict->ddict)
+                 : ZSTD_decompressDCtx(contexts_->dctx, &out[0], out.size(), data, size);
+    }
+    if (ZSTD_isError(n) || n != out.size()) {
+        out.clear();
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    decompressed_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+#else
+    (void)data;
+    (void)size;
+    (void)maxBytes;
+    (void)out;
+    return false;
+#endif
+}
+
+bool PayloadCodec::trainDictionary(const std::string& directory, const std::string& type,
+                                   const std::vector<std::string>& samples, std::size_t dictBytes) {
+#ifdef NODEAGENT_ZSTD_ENABLED
+    std::string joined;
+    std::vector<std::size_t> sizes;
+    sizes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        joined += sample;
+        sizes.push_back(sample.size());
+    }
+    std::string dict(dictBytes, '\0');
+    const std::size_t n = ZDICT_trainFromBuffer(&dict[0], dict.size(), joined.data(), sizes.data(),
+                                                static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(n)) {
+        LOG_WARN("PayloadCodec", "Dictionary training for " + type + " failed: " + ZDICT_getErrorName(n));
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    std::ofstream out(std::filesystem::path(directory) / (type + kDictionarySuffix), std::ios::binary | std::ios::trunc);
+    out.write(dict.data(), static_cast<std::streamsize>(n));
+    return static_cast<bool>(out);
+#else
+    (void)directory;
+    (void)type;
+    (void)samples;
+    (void)dictBytes;
+    return false;
+#endif
+}
+
+std::string_view PayloadCodec::messageType(std::string_view message) noexcept {
+    static constexpr std::pair<std::string_view, std::string_view> kPrefixes[] = {
+        {"CMD:", "command"}, {"MISSION:", "mission"}, {"FLOW:", "flow"}, {"XFER:", "transfer"}, {"ACK:", "ack"},
+    };
+    for (const auto& [prefix, type] : kPrefixes) {
+        if (startsWith(message, prefix)) {
+            return type;
+        }
+    }
+    const std::size_t key = message.find("\"type\"");
+    if (key == std::string_view::npos) {
+        return {};
+    }
+    std::size_t pos = key + 6;
+    auto skipSpace = [&]() {
+        while (pos < message.size() && (message[pos] == ' ' || message[pos] == '\t' || message[pos] == '\n')) ++pos;
+    };
+    skipSpace();
+    if (pos >= message.size() || message[pos] != ':') {
+        return {};
+    }
+    ++pos;
+    skipSpace();
+    if (pos >= message.size() || message[pos] != '"') {
+        return {};
+    }
+    const std::size_t begin = ++pos;
+    const std::size_t end = message.find('"', begin);
+    if (end == std::string_view::npos) {
+        return {};
+    }
+    return message.substr(begin, end - begin);
+}
+
+PayloadCompressionStats PayloadCodec::stats() const noexcept {
+    PayloadCompressionStats s;
+    s.compressed = compressed_.load(std::memory_order_relaxed);
+    s.rawBytes = rawBytes_.load(std::memory_order_relaxed);
+    s.frameBytes = frameBytes_.load(std::memory_order_relaxed);
+    s.skipped = skipped_.load(std::memory_order_relaxed);
+    s.decompressed = decompressed_.load(std::memory_order_relaxed);
+    s.errors = errors_.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace nodeagent
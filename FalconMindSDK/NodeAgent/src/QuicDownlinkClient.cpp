@@ -0,0 +1,104 @@
+#include "nodeagent/QuicDownlinkClient.h"
+#include "nodeagent/Logger.h"
+#include "nodeagent/ErrorCodes.h"
+#include "nodeagent/ErrorStatistics.h"
+
+namespace nodeagent {
+
+QuicDownlinkClient::QuicDownlinkClient(std::shared_ptr<QuicSession> session)
+    : QuicDownlinkClient(std::move(session), Config{}) {}
+
+QuicDownlinkClient::QuicDownlinkClient(std::shared_ptr<QuicSession> session, const Config& config)
+    : session_(std::move(session))
+    , config_(config) {
+    // 须在 QuicSession::connect() 之前注册；receiving_ 为 false 时到达的数据被丢弃
+    session_->setReceiveHandler([this](std::uint64_t key, const std::uint8_t* data, std::size_t size) {
+        onStreamData(key, data, size);
+    });
+    session_->setStreamClosedHandler([this](std::uint64_t key) { onStreamClosed(key); });
+}
+
+QuicDownlinkClient::~QuicDownlinkClient() {
+    // 会话的接收回调指向本对象：先关闭连接（等待回调结束），共用该会话的上行也随之断开
+    session_->disconnect();
+    stopReceiving();
+}
+
+bool QuicDownlinkClient::connect(int existingSocketFd) {
+    (void)existingSocketFd;
+    // 与上行共用一条连接：已由 QuicUplinkClient 建立时直接复用
+    return session_->isConnected() || session_->connect();
+}
+
+void QuicDownlinkClient::disconnect() {
+    stopReceiving();
+    session_->disconnect();
+}
+
+void QuicDownlinkClient::setMessageHandler(MessageHandler handler) {
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+    messageHandler_ = std::move(handler);
+}
+
+void QuicDownlinkClient::setAckHandler(AckHandler handler) {
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+    ackHandler_ = std::move(handler);
+}
+
+bool QuicDownlinkClient::startReceiving(const std::string& uavId) {
+    (void)uavId;
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+    receiving_ = true;
+    return true;
+}
+
+void QuicDownlinkClient::stopReceiving() {
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+    receiving_ = false;
+    streams_.clear();
+    failedStreams_.clear();
+}
+
+void QuicDownlinkClient::onStreamData(std::uint64_t streamKey, const void* data, std::size_t size) {
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+    if (!receiving_ || failedStreams_.count(streamKey) != 0) {
+        return;
+    }
+    auto it = streams_.find(streamKey);
+    if (it == streams_.end()) {
+        DownlinkClient::Config parserConfig;
+        parserConfig.maxMessageBytes = config_.maxMessageBytes;
+        auto parser = std::make_unique<DownlinkClient>(parserConfig);
+        // 处理器在 streamsMutex_ 下调用，读取成员时无需再加锁
+        parser->setMessageHandler([this](const DownlinkMessage& message) {
+            if (messageHandler_) messageHandler_(message);
+        });
+        parser->setAckHandler([this](const std::string& messageId) {
+            if (ackHandler_) ackHandler_(messageId);
+        });
+        it = streams_.emplace(streamKey, std::move(parser)).first;
+    }
+    if (!it->second->feed(data, size)) {
+        // 该流的分帧已无法恢复；其它流不受影响
+        ErrorStatistics::instance().recordError(ErrorCode::ReceiveFailed,
+            "Malformed or oversized message on QUIC downlink stream");
+        LOG_ERROR("QuicDownlinkClient", "Malformed or oversized message on downlink stream " +
+                  std::to_string(streamKey) + ", discarding the rest of the stream");
+        streams_.erase(it);
+        failedStreams_.insert(streamKey);
+    }
+}
+
+void QuicDownlinkClient::onStreamClosed(std::uint64_t streamKey) {
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+    // 流结束时不完整的尾部消息一并丢弃（对端中止了该流）
+    streams_.erase(streamKey);
+    failedStreams_.erase(streamKey);
+}
+
+std::size_t QuicDownlinkClient::activeStreams() const {
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+    return streams_.size();
+}
+
+} // namespace nodeagent
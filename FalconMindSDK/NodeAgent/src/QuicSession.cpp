@@ -0,0 +1,601 @@
+#include "nodeagent/QuicSession.h"
+#include "nodeagent/Logger.h"
+#include "nodeagent/ErrorCodes.h"
+#include "nodeagent/ErrorStatistics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+#ifdef NODEAGENT_QUIC_ENABLED
+#include <msquic.h>
+#endif
+
+namespace nodeagent {
+
+namespace {
+#ifdef NODEAGENT_QUIC_ENABLED
+// msquic 流优先级：值越大越先调度
+constexpr std::uint16_t kStreamPriority[kUplinkPriorityCount] = {0xFFFF, 0xC000, 0x8000, 0x1000};
+constexpr std::size_t kDatagramLane = kUplinkPriorityCount;  // SendContext::lane 取该值表示数据报
+constexpr int kShutdownWaitMs = 1000;
+
+std::string statusText(QUIC_STATUS status) {
+    return "0x" + [](unsigned long v) {
+        static const char kHex[] = "0123456789abcdef";
+        std::string out;
+        do {
+            out.insert(out.begin(), kHex[v & 0xF]);
+            v >>= 4;
+        } while (v != 0);
+        return out;
+    }(static_cast<unsigned long>(status));
+}
+#endif
+} // namespace
+
+struct QuicSession::Impl {
+    Config cfg;
+    ReceiveHandler onReceive;
+    StreamClosedHandler onStreamClosed;
+
+    std::mutex controlMutex;  // 串行化 connect / disconnect / migrate（句柄的创建与释放）
+    mutable std::mutex mutex;  // 保护以下状态；持有时只调用异步的 msquic API（StreamSend / DatagramSend）
+    std::condition_variable cv;
+    std::atomic<bool> connected{false};
+    bool handshakeDone{false};
+    bool shutdownComplete{true};
+    bool resumed{false};
+    bool datagramSendEnabled{false};
+    std::size_t maxDatagramBytes{0};
+    int pendingDatagrams{0};
+    std::array<std::size_t, kUplinkPriorityCount> inflightBytes{};
+    std::vector<std::uint8_t> ticket;
+    QuicSessionStats stats;
+
+    explicit Impl(const Config& config) : cfg(config) {}
+
+#ifdef NODEAGENT_QUIC_ENABLED
+    // 一次发送的缓冲：须存活到 SEND_COMPLETE / 数据报的最终状态
+    struct SendContext {
+        std::size_t lane;
+        std::string data;
+        QUIC_BUFFER buffer;
+    };
+
+    const QUIC_API_TABLE* api{nullptr};
+    HQUIC registration{nullptr};
+    HQUIC configuration{nullptr};
+    HQUIC connection{nullptr};
+    std::array<HQUIC, kUplinkPriorityCount> streams{};
+
+    ~Impl() {
+        if (configuration) api->ConfigurationClose(configuration);
+        if (registration) api->RegistrationClose(registration);
+        if (api) MsQuicClose(api);
+    }
+
+    bool openLibrary() {
+        if (configuration) {
+            return true;
+        }
+        QUIC_STATUS status = MsQuicOpen2(&api);
+        if (QUIC_FAILED(status)) {
+            api = nullptr;
+            LOG_ERROR("QuicSession", "MsQuicOpen2 failed: " + statusText(status));
+            return false;
+        }
+        const QUIC_REGISTRATION_CONFIG regConfig = {"nodeagent", QUIC_EXECUTION_PROFILE_LOW_LATENCY};
+        status = api->RegistrationOpen(&regConfig, &registration);
+        if (QUIC_FAILED(status)) {
+            LOG_ERROR("QuicSession", "RegistrationOpen failed: " + statusText(status));
+            return false;
+        }
+
+        QUIC_SETTINGS settings;
+        std::memset(&settings, 0, sizeof(settings));
+        settings.IdleTimeoutMs = static_cast<std::uint64_t>(cfg.idleTimeoutMs);
+        settings.IsSet.IdleTimeoutMs = TRUE;
+        settings.HandshakeIdleTimeoutMs = static_cast<std::uint64_t>(cfg.connectTimeoutMs);
+        settings.IsSet.HandshakeIdleTimeoutMs = TRUE;
+        settings.KeepAliveIntervalMs = static_cast<std::uint32_t>(cfg.keepAliveIntervalMs);
+        settings.IsSet.KeepAliveIntervalMs = TRUE;
+        settings.PeerUnidiStreamCount = 16;  // Cluster Center 打开的下行流（命令 / 任务 / 传输）
+        settings.IsSet.PeerUnidiStreamCount = TRUE;
+        settings.DatagramReceiveEnabled = cfg.enableDatagrams ? TRUE : FALSE;
+        settings.IsSet.DatagramReceiveEnabled = TRUE;
+        const QUIC_BUFFER alpn = {static_cast<std::uint32_t>(cfg.alpn.size()),
+                                  reinterpret_cast<std::uint8_t*>(const_cast<char*>(cfg.alpn.data()))};
+        status = api->ConfigurationOpen(registration, &alpn, 1, &settings, sizeof(settings), nullptr, &configuration);
+        if (QUIC_FAILED(status)) {
+            LOG_ERROR("QuicSession", "ConfigurationOpen failed: " + statusText(status));
+            return false;
+        }
+
+        QUIC_CREDENTIAL_CONFIG credential;
+        std::memset(&credential, 0, sizeof(credential));
+        credential.Type = QUIC_CREDENTIAL_TYPE_NONE;
+        credential.Flags = QUIC_CREDENTIAL_FLAG_CLIENT;
+        if (!cfg.verifyCertificate) {
+            credential.Flags = static_cast<QUIC_CREDENTIAL_FLAGS>(credential.Flags | QUIC_CREDENTIAL_FLAG_NO_CERTIFICATE_VALIDATION);
+        } else if (!cfg.caFile.empty()) {
+            credential.Flags = static_cast<QUIC_CREDENTIAL_FLAGS>(credential.Flags | QUIC_CREDENTIAL_FLAG_SET_CA_CERTIFICATE_FILE);
+            credential.CaCertificateFile = cfg.caFile.c_str();
+        }
+        status = api->ConfigurationLoadCredential(configuration, &credential);
+        if (QUIC_FAILED(status)) {
+            LOG_ERROR("QuicSession", "ConfigurationLoadCredential failed: " + statusText(status));
+            api->ConfigurationClose(configuration);
+            configuration = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    void loadTicket() {
+        if (!ticket.empty() || cfg.resumptionTicketPath.empty()) {
+            return;
+        }
+        std::ifstream in(cfg.resumptionTicketPath, std::ios::binary);
+        ticket.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void saveTicket(const std::uint8_t* data, std::uint32_t length) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ticket.assign(data, data + length);
+        if (!cfg.resumptionTicketPath.empty()) {
+            const std::string tmp = cfg.resumptionTicketPath + ".tmp";
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(data), length);
+            out.close();
+            if (out) {
+                std::rename(tmp.c_str(), cfg.resumptionTicketPath.c_str());
+            }
+        }
+    }
+
+    void closeConnection() {
+        if (!connection) {
+            return;
+        }
+        connected = false;
+        api->ConnectionShutdown(connection, QUIC_CONNECTION_SHUTDOWN_FLAG_NONE, 0);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait_for(lock, std::chrono::milliseconds(kShutdownWaitMs), [this]() { return shutdownComplete; });
+        }
+        api->ConnectionClose(connection);  // 阻塞到本连接的回调全部结束
+        connection = nullptr;
+        std::lock_guard<std::mutex> lock(mutex);
+        streams.fill(nullptr);
+        inflightBytes.fill(0);
+        datagramSendEnabled = false;
+    }
+
+    static QUIC_STATUS QUIC_API connectionCallback(HQUIC, void* context, QUIC_CONNECTION_EVENT* event) {
+        static_cast<Impl*>(context)->onConnectionEvent(event);
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS QUIC_API uplinkStreamCallback(HQUIC stream, void* context, QUIC_STREAM_EVENT* event) {
+        auto* self = static_cast<Impl*>(context);
+        switch (event->Type) {
+        case QUIC_STREAM_EVENT_SEND_COMPLETE: {
+            auto* send = static_cast<SendContext*>(event->SEND_COMPLETE.ClientContext);
+            {
+                std::lock_guard<std::mutex> lock(self->mutex);
+                std::size_t& inflight = self->inflightBytes[send->lane];
+                inflight -= std::min(inflight, send->data.size());
+            }
+            delete send;
+            break;
+        }
+        case QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE: {
+            {
+                std::lock_guard<std::mutex> lock(self->mutex);
+                for (HQUIC& s : self->streams) {
+                    if (s == stream) s = nullptr;
+                }
+            }
+            if (!event->SHUTDOWN_COMPLETE.AppCloseInProgress) {
+                self->api->StreamClose(stream);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS QUIC_API downlinkStreamCallback(HQUIC stream, void* context, QUIC_STREAM_EVENT* event) {
+        auto* self = static_cast<Impl*>(context);
+        const auto key = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(stream));
+        switch (event->Type) {
+        case QUIC_STREAM_EVENT_RECEIVE:
+            if (self->onReceive) {
+                for (std::uint32_t i = 0; i < event->RECEIVE.BufferCount; ++i) {
+                    self->onReceive(key, event->RECEIVE.Buffers[i].Buffer, event->RECEIVE.Buffers[i].Length);
+                }
+            }
+            break;
+        case QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE:
+            if (self->onStreamClosed) {
+                self->onStreamClosed(key);
+            }
+            if (!event->SHUTDOWN_COMPLETE.AppCloseInProgress) {
+                self->api->StreamClose(stream);
+            }
+            break;
+        default:
+            break;
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    void onConnectionEvent(QUIC_CONNECTION_EVENT* event) {
+        switch (event->Type) {
+        case QUIC_CONNECTION_EVENT_CONNECTED: {
+            std::lock_guard<std::mutex> lock(mutex);
+            handshakeDone = true;
+            resumed = event->CONNECTED.SessionResumed;
+            if (resumed) {
+                ++stats.resumedConnects;
+            }
+            cv.notify_all();
+            break;
+        }
+        case QUIC_CONNECTION_EVENT_SHUTDOWN_INITIATED_BY_TRANSPORT:
+            connected = false;
+            ErrorStatistics::instance().recordError(ErrorCode::ConnectionLost,
+                "QUIC connection shut down by transport: " + statusText(event->SHUTDOWN_INITIATED_BY_TRANSPORT.Status));
+            LOG_WARN("QuicSession", "Connection shut down by transport: " +
+                     statusText(event->SHUTDOWN_INITIATED_BY_TRANSPORT.Status));
+            break;
+        case QUIC_CONNECTION_EVENT_SHUTDOWN_INITIATED_BY_PEER:
+            connected = false;
+            LOG_WARN("QuicSession", "Connection closed by Cluster Center (error " +
+                     std::to_string(event->SHUTDOWN_INITIATED_BY_PEER.ErrorCode) + ")");
+            break;
+        case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE: {
+            connected = false;
+            std::lock_guard<std::mutex> lock(mutex);
+            shutdownComplete = true;
+            cv.notify_all();
+            break;
+        }
+        case QUIC_CONNECTION_EVENT_RESUMPTION_TICKET_RECEIVED:
+            saveTicket(event->RESUMPTION_TICKET_RECEIVED.ResumptionTicket,
+                       event->RESUMPTION_TICKET_RECEIVED.ResumptionTicketLength);
+            break;
+        case QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED:
+            api->SetCallbackHandler(event->PEER_STREAM_STARTED.Stream,
+                                    reinterpret_cast<void*>(&Impl::downlinkStreamCallback), this);
+            break;
+        case QUIC_CONNECTION_EVENT_DATAGRAM_STATE_CHANGED: {
+            std::lock_guard<std::mutex> lock(mutex);
+            datagramSendEnabled = event->DATAGRAM_STATE_CHANGED.SendEnabled;
+            maxDatagramBytes = event->DATAGRAM_STATE_CHANGED.MaxSendLength;
+            break;
+        }
+        case QUIC_CONNECTION_EVENT_DATAGRAM_SEND_STATE_CHANGED: {
+            const QUIC_DATAGRAM_SEND_STATE state = event->DATAGRAM_SEND_STATE_CHANGED.State;
+            if (!QUIC_DATAGRAM_SEND_STATE_IS_FINAL(state)) {
+                break;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --pendingDatagrams;
+                if (state == QUIC_DATAGRAM_SEND_LOST_DISCARDED || state == QUIC_DATAGRAM_SEND_CANCELED) {
+                    ++stats.datagramsLost;
+                }
+            }
+            delete static_cast<SendContext*>(event->DATAGRAM_SEND_STATE_CHANGED.ClientContext);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+#endif
+};
+
+QuicSession::QuicSession() : QuicSession(Config{}) {}
+
+QuicSession::QuicSession(const Config& config) : impl_(std::make_unique<Impl>(config)) {}
+
+QuicSession::~QuicSession() {
+    disconnect();
+}
+
+bool QuicSession::available() noexcept {
+#ifdef NODEAGENT_QUIC_ENABLED
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool QuicSession::connect() {
+#ifdef NODEAGENT_QUIC_ENABLED
+    Impl& d = *impl_;
+    std::lock_guard<std::mutex> control(d.controlMutex);
+    if (d.connected) {
+        return true;
+    }
+    d.closeConnection();  // 上一连接遗留的句柄
+    if (!d.openLibrary()) {
+        return false;
+    }
+    QUIC_STATUS status = d.api->ConnectionOpen(d.registration, &Impl::connectionCallback, &d, &d.connection);
+    if (QUIC_FAILED(status)) {
+        d.connection = nullptr;
+        LOG_ERROR("QuicSession", "ConnectionOpen failed: " + statusText(status));
+        return false;
+    }
+
+    bool zeroRtt = false;
+    {
+        std::lock_guard<std::mutex> lock(d.mutex);
+        d.handshakeDone = false;
+        d.shutdownComplete = false;
+        d.resumed = false;
+        d.datagramSendEnabled = false;
+        d.inflightBytes.fill(0);
+    }
+    if (d.cfg.enableZeroRtt) {
+        d.loadTicket();
+        if (!d.ticket.empty()) {
+            status = d.api->SetParam(d.connection, QUIC_PARAM_CONN_RESUMPTION_TICKET,
+                                     static_cast<std::uint32_t>(d.ticket.size()), d.ticket.data());
+            zeroRtt = QUIC_SUCCEEDED(status);
+            if (!zeroRtt) {
+                d.ticket.clear();  // 票据过期或与本配置不符：完整握手后会收到新票据
+            }
+        }
+    }
+    if (!d.cfg.localAddress.empty()) {
+        QUIC_ADDR local;
+        std::memset(&local, 0, sizeof(local));
+        if (QuicAddrFromString(d.cfg.localAddress.c_str(), 0, &local)) {
+            d.api->SetParam(d.connection, QUIC_PARAM_CONN_LOCAL_ADDRESS, sizeof(local), &local);
+        } else {
+            LOG_WARN("QuicSession", "Ignoring invalid local address: " + d.cfg.localAddress);
+        }
+    }
+    const std::string serverName = d.cfg.serverName.empty() ? d.cfg.serverAddress : d.cfg.serverName;
+    if (!d.cfg.serverName.empty()) {
+        // SNI 与连接地址不同：显式设置远端地址，serverName 只用于 TLS
+        QUIC_ADDR remote;
+        std::memset(&remote, 0, sizeof(remote));
+        if (QuicAddrFromString(d.cfg.serverAddress.c_str(), static_cast<std::uint16_t>(d.cfg.serverPort), &remote)) {
+            d.api->SetParam(d.connection, QUIC_PARAM_CONN_REMOTE_ADDRESS, sizeof(remote), &remote);
+        }
+    }
+
+    // 流在握手之前打开：有会话票据时遥测流上的首批数据随 0-RTT 报文发出
+    for (std::size_t lane = 0; lane < kUplinkPriorityCount; ++lane) {
+        HQUIC stream = nullptr;
+        status = d.api->StreamOpen(d.connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL, &Impl::uplinkStreamCallback, &d,
+                                   &stream);
+        if (QUIC_SUCCEEDED(status)) {
+            const std::uint16_t priority = kStreamPriority[lane];
+            d.api->SetParam(stream, QUIC_PARAM_STREAM_PRIORITY, sizeof(priority), &priority);
+            status = d.api->StreamStart(stream, QUIC_STREAM_START_FLAG_NONE);
+            if (QUIC_FAILED(status)) {
+                d.api->StreamClose(stream);
+                stream = nullptr;
+            }
+        }
+        if (!stream) {
+            LOG_ERROR("QuicSession", "Failed to open uplink stream: " + statusText(status));
+            d.closeConnection();
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(d.mutex);
+        d.streams[lane] = stream;
+    }
+
+    status = d.api->ConnectionStart(d.connection, d.configuration, QUIC_ADDRESS_FAMILY_UNSPEC, serverName.c_str(),
+                                    static_cast<std::uint16_t>(d.cfg.serverPort));
+    if (QUIC_FAILED(status)) {
+        ErrorStatistics::instance().recordError(ErrorCode::ConnectionFailed,
+            "QUIC ConnectionStart failed: " + statusText(status));
+        LOG_ERROR("QuicSession", "ConnectionStart failed: " + statusText(status));
+        d.closeConnection();
+        return false;
+    }
+    d.connected = true;
+    {
+        std::lock_guard<std::mutex> lock(d.mutex);
+        ++d.stats.connects;
+    }
+    if (zeroRtt) {
+        // 0-RTT：不等待握手；票据被拒时协议栈以 1-RTT 重发，握手失败时连接关闭、后续发送返回 false
+        LOG_INFO("QuicSession", "Resuming QUIC session to " + d.cfg.serverAddress + ":" +
+                 std::to_string(d.cfg.serverPort) + " (0-RTT)");
+        return true;
+    }
+    bool handshakeDone = false;
+    {
+        std::unique_lock<std::mutex> lock(d.mutex);
+        d.cv.wait_for(lock, std::chrono::milliseconds(d.cfg.connectTimeoutMs),
+                      [&d]() { return d.handshakeDone || d.shutdownComplete; });
+        handshakeDone = d.handshakeDone;
+        if (!handshakeDone) {
+            ++d.stats.handshakeFailures;
+        }
+    }
+    if (!handshakeDone) {
+        ErrorStatistics::instance().recordError(ErrorCode::ConnectionFailed,
+            "QUIC handshake with " + d.cfg.serverAddress + ":" + std::to_string(d.cfg.serverPort) + " failed");
+        LOG_ERROR("QuicSession", "QUIC handshake with " + d.cfg.serverAddress + ":" +
+                  std::to_string(d.cfg.serverPort) + " failed or timed out");
+        d.closeConnection();
+        return false;
+    }
+    LOG_INFO("QuicSession", "Connected to Cluster Center at " + d.cfg.serverAddress + ":" +
+             std::to_string(d.cfg.serverPort) + " over QUIC");
+    return true;
+#else
+    ErrorStatistics::instance().recordError(ErrorCode::OperationNotSupported,
+        "QUIC transport not compiled (msquic not found)");
+    LOG_ERROR("QuicSession", "QUIC transport not compiled (msquic not found)");
+    return false;
+#endif
+}
+
+void QuicSession::disconnect() {
+#ifdef NODEAGENT_QUIC_ENABLED
+    Impl& d = *impl_;
+    std::lock_guard<std::mutex> control(d.controlMutex);
+    if (d.connection) {
+        d.closeConnection();
+        LOG_INFO("QuicSession", "Disconnected");
+    }
+#endif
+}
+
+bool QuicSession::isConnected() const {
+    return impl_->connected.load(std::memory_order_acquire);
+}
+
+bool QuicSession::resumed() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->resumed;
+}
+
+bool QuicSession::send(UplinkPriority priority, const void* data, std::size_t size, bool newline) {
+#ifdef NODEAGENT_QUIC_ENABLED
+    Impl& d = *impl_;
+    if (!d.connected) {
+        return false;
+    }
+    const auto lane = static_cast<std::size_t>(priority);
+    auto* send = new Impl::SendContext{lane, std::string(static_cast<const char*>(data), size), QUIC_BUFFER{}};
+    if (newline) {
+        send->data.push_back('\n');
+    }
+    send->buffer.Buffer = reinterpret_cast<std::uint8_t*>(send->data.data());
+    send->buffer.Length = static_cast<std::uint32_t>(send->data.size());
+    // 0-RTT 数据可被重放：只有遥测（幂等，接收端按时间戳取新）可在握手完成前发出
+    const QUIC_SEND_FLAGS flags =
+        priority == UplinkPriority::Telemetry ? QUIC_SEND_FLAG_ALLOW_0_RTT : QUIC_SEND_FLAG_NONE;
+
+    std::lock_guard<std::mutex> lock(d.mutex);
+    HQUIC stream = d.streams[lane];
+    std::size_t& inflight = d.inflightBytes[lane];
+    if (priority == UplinkPriority::Bulk && inflight > 0 && inflight + send->data.size() > d.cfg.maxBulkInflightBytes) {
+        ++d.stats.bulkRejected;
+        delete send;
+        return false;
+    }
+    const QUIC_STATUS status = stream ? d.api->StreamSend(stream, &send->buffer, 1, flags, send) : QUIC_STATUS_INVALID_STATE;
+    if (QUIC_FAILED(status)) {
+        delete send;
+        LOG_ERROR("QuicSession", "StreamSend failed: " + statusText(status));
+        return false;
+    }
+    inflight += send->buffer.Length;
+    ++d.stats.streamMessages[lane];
+    d.stats.streamBytes[lane] += send->buffer.Length;
+    return true;
+#else
+    (void)priority;
+    (void)data;
+    (void)size;
+    (void)newline;
+    return false;
+#endif
+}
+
+bool QuicSession::sendDatagram(const void* data, std::size_t size) {
+#ifdef NODEAGENT_QUIC_ENABLED
+    Impl& d = *impl_;
+    if (!d.connected || !d.cfg.enableDatagrams) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(d.mutex);
+    if (!d.datagramSendEnabled || size > d.maxDatagramBytes || !d.connection) {
+        return false;
+    }
+    if (d.pendingDatagrams >= d.cfg.maxPendingDatagrams) {
+        // 已发出的旧状态无法撤回，拥塞时丢弃新状态：下一条遥测比排队更快到达
+        ++d.stats.datagramsDropped;
+        return true;
+    }
+    auto* send = new Impl::SendContext{kDatagramLane, std::string(static_cast<const char*>(data), size), QUIC_BUFFER{}};
+    send->buffer.Buffer = reinterpret_cast<std::uint8_t*>(send->data.data());
+    send->buffer.Length = static_cast<std::uint32_t>(send->data.size());
+    const QUIC_STATUS status = d.api->DatagramSend(d.connection, &send->buffer, 1, QUIC_SEND_FLAG_ALLOW_0_RTT, send);
+    if (QUIC_FAILED(status)) {
+        delete send;
+        return false;
+    }
+    ++d.pendingDatagrams;
+    ++d.stats.datagramsSent;
+    return true;
+#else
+    (void)data;
+    (void)size;
+    return false;
+#endif
+}
+
+bool QuicSession::migrate(const std::string& localAddress) {
+#ifdef NODEAGENT_QUIC_ENABLED
+    Impl& d = *impl_;
+    std::lock_guard<std::mutex> control(d.controlMutex);
+    if (!d.connection || !d.connected) {
+        return false;
+    }
+    QUIC_ADDR local;
+    std::memset(&local, 0, sizeof(local));
+    if (!QuicAddrFromString(localAddress.c_str(), 0, &local)) {
+        LOG_ERROR("QuicSession", "Invalid local address for migration: " + localAddress);
+        return false;
+    }
+    // SetParam 同步等待工作线程处理，不能持有 mutex（回调需要它）
+    const QUIC_STATUS status = d.api->SetParam(d.connection, QUIC_PARAM_CONN_LOCAL_ADDRESS, sizeof(local), &local);
+    if (QUIC_FAILED(status)) {
+        LOG_WARN("QuicSession", "Migration to " + localAddress + " failed: " + statusText(status));
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(d.mutex);
+        ++d.stats.migrations;
+    }
+    d.cfg.localAddress = localAddress;  // 重连时沿用新地址
+    LOG_INFO("QuicSession", "Migrated connection to local address " + localAddress);
+    return true;
+#else
+    (void)localAddress;
+    return false;
+#endif
+}
+
+void QuicSession::setReceiveHandler(ReceiveHandler handler) {
+    impl_->onReceive = std::move(handler);
+}
+
+void QuicSession::setStreamClosedHandler(StreamClosedHandler handler) {
+    impl_->onStreamClosed = std::move(handler);
+}
+
+const QuicSession::Config& QuicSession::config() const noexcept {
+    return impl_->cfg;
+}
+
+QuicSessionStats QuicSession::stats() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->stats;
+}
+
+} // namespace nodeagent
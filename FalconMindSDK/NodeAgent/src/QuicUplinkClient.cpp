@@ -0,0 +1,147 @@
+#include "nodeagent/QuicUplinkClient.h"
+#include "nodeagent/Logger.h"
+#include "nodeagent/ErrorCodes.h"
+#include "nodeagent/ErrorStatistics.h"
+#include "falconmind/sdk/telemetry/TelemetryCodec.h"
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace nodeagent {
+
+QuicUplinkClient::QuicUplinkClient(std::shared_ptr<QuicSession> session)
+    : QuicUplinkClient(std::move(session), Config{}) {}
+
+QuicUplinkClient::QuicUplinkClient(std::shared_ptr<QuicSession> session, const Config& config)
+    : session_(std::move(session))
+    , config_(config)
+    , delta_(config.delta) {
+}
+
+bool QuicUplinkClient::connect() {
+    if (!session_->connect()) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(deltaMutex_);
+        delta_.reset();  // 新连接：对端无状态，下一帧为关键帧
+    }
+    switch (config_.telemetryEncoding) {
+    case TelemetryEncoding::Json:
+        activeEncoding_ = TelemetryEncoding::Json;
+        break;
+    case TelemetryEncoding::Binary:
+        activeEncoding_ = TelemetryEncoding::Binary;
+        break;
+    case TelemetryEncoding::BinaryDelta:
+    case TelemetryEncoding::Auto:
+        // 数据报可能丢失或乱序，增量帧依赖前一帧：数据报模式只发完整帧
+        activeEncoding_ = config_.telemetryOverDatagrams ? TelemetryEncoding::Binary : TelemetryEncoding::BinaryDelta;
+        break;
+    }
+    LOG_INFO("QuicUplinkClient", std::string("Telemetry encoding: ") +
+             (activeEncoding_ == TelemetryEncoding::BinaryDelta ? "binary-delta"
+              : activeEncoding_ == TelemetryEncoding::Binary    ? "binary"
+                                                                : "json") +
+             (config_.telemetryOverDatagrams && activeEncoding_ != TelemetryEncoding::Json ? " (datagrams)" : ""));
+    return true;
+}
+
+void QuicUplinkClient::disconnect() {
+    session_->disconnect();
+}
+
+bool QuicUplinkClient::sendTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg) {
+    if (!session_->isConnected()) {
+        return false;
+    }
+
+    std::array<std::uint8_t, falconmind::sdk::telemetry::kTelemetryFrameMaxBytes> frame;
+    if (activeEncoding_ == TelemetryEncoding::BinaryDelta) {
+        std::lock_guard<std::mutex> lock(deltaMutex_);
+        const std::uint64_t failures = delta_.stats().encodeFailures;
+        const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        const std::size_t size = delta_.encode(msg, nowNs, frame.data(), frame.size());
+        if (size > 0) {
+            return session_->send(UplinkPriority::Telemetry, frame.data(), size, false);
+        }
+        if (delta_.stats().encodeFailures == failures) {
+            return true;  // 没有需要发送的字段组
+        }
+    } else if (activeEncoding_ == TelemetryEncoding::Binary) {
+        const std::size_t size = falconmind::sdk::telemetry::encodeTelemetryFrame(msg, frame.data(), frame.size());
+        if (size > 0) {
+            if (config_.telemetryOverDatagrams && session_->sendDatagram(frame.data(), size)) {
+                return true;
+            }
+            return session_->send(UplinkPriority::Telemetry, frame.data(), size, false);
+        }
+    }
+    // 字符串超长等无法编码的消息退回 JSON 行
+    const std::string json = serializeTelemetryToJson(msg);
+    return session_->send(UplinkPriority::Telemetry, json.data(), json.size(), true);
+}
+
+bool QuicUplinkClient::sendMessage(const std::string& message) {
+    return sendMessage(message, UplinkPriority::Event);
+}
+
+bool QuicUplinkClient::sendMessage(const std::string& message, UplinkPriority priority) {
+    if (!session_->isConnected()) {
+        return false;
+    }
+    return session_->send(priority, message.data(), message.size(), true);
+}
+
+bool QuicUplinkClient::sendReplayedTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg) {
+    if (!session_->isConnected()) {
+        return false;
+    }
+    const std::string json = serializeTelemetryToJson(msg, true);
+    return session_->send(UplinkPriority::Bulk, json.data(), json.size(), true);
+}
+
+std::string QuicUplinkClient::serializeTelemetryToJson(const falconmind::sdk::telemetry::TelemetryMessage& msg, bool replay) {
+    try {
+        nlohmann::json json;
+
+        json["uav_id"] = msg.uavId;
+        json["timestamp_ns"] = msg.timestampNs;
+
+        json["position"]["lat"] = msg.lat;
+        json["position"]["lon"] = msg.lon;
+        json["position"]["alt"] = msg.alt;
+
+        json["attitude"]["roll"] = msg.roll;
+        json["attitude"]["pitch"] = msg.pitch;
+        json["attitude"]["yaw"] = msg.yaw;
+
+        json["velocity"]["vx"] = msg.vx;
+        json["velocity"]["vy"] = msg.vy;
+        json["velocity"]["vz"] = msg.vz;
+
+        json["battery"]["percent"] = msg.batteryPercent;
+        json["battery"]["voltage_mv"] = msg.batteryVoltageMv;
+
+        json["gps"]["fix_type"] = msg.gpsFixType;
+        json["gps"]["num_sat"] = msg.numSat;
+
+        json["link_quality"] = msg.linkQuality;
+        json["flight_mode"] = msg.flightMode;
+        if (replay) {
+            json["replay"] = true;
+        }
+
+        return json.dump();
+    } catch (const std::exception& e) {
+        ErrorStatistics::instance().recordError(ErrorCode::MessageSerializeError,
+            "Error serializing telemetry to JSON: " + std::string(e.what()));
+        LOG_ERROR("QuicUplinkClient", "Error serializing telemetry to JSON: " + std::string(e.what()));
+        return "{}";
+    }
+}
+
+} // namespace nodeagent
@@ -1,13 +1,100 @@
 #include "nodeagent/ReconnectManager.h"
 #include "nodeagent/Logger.h"
 
-#include <iostream>
+#include "falconmind/sdk/core/PipelineClock.h"
+
+#include <algorithm>
 #include <cmath>
 
 namespace nodeagent {
 
+namespace {
+
+std::uint64_t defaultSeed() {
+    // random_device 在部分嵌入式平台上是确定的，混入时钟避免整个机群抖动序列相同
+    std::random_device rd;
+    const auto now = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    return (static_cast<std::uint64_t>(rd()) << 32) ^ rd() ^ now;
+}
+
+} // namespace
+
+ReconnectBackoff::ReconnectBackoff()
+    : ReconnectBackoff(Config{}) {  // 使用默认值
+}
+
+ReconnectBackoff::ReconnectBackoff(const Config& config)
+    : ReconnectBackoff(config, defaultSeed()) {
+}
+
+ReconnectBackoff::ReconnectBackoff(const Config& config, std::uint64_t seed)
+    : config_(config), rng_(seed) {
+    config_.initialDelay = std::max(config_.initialDelay, std::chrono::milliseconds(1));
+    config_.maxDelay = std::max(config_.maxDelay, config_.initialDelay);
+    config_.multiplier = std::max(config_.multiplier, 1.0);
+    prev_ = config_.initialDelay;
+}
+
+std::chrono::milliseconds ReconnectBackoff::begin(bool transient) {
+    reset();
+    if (linkPoor_) {
+        return config_.fadeProbeDelay;
+    }
+    // 首次尝试只在很小的窗口内抖动：同一时刻断链的节点不会在同一毫秒到达
+    const auto window = (transient && config_.fastRetry) ? config_.initialDelay.count() / 4
+                                                         : config_.initialDelay.count();
+    std::uniform_int_distribution<std::int64_t> dist(0, window);
+    return std::chrono::milliseconds(dist(rng_));
+}
+
+std::chrono::milliseconds ReconnectBackoff::next() {
+    if (linkPoor_) {
+        return config_.fadeProbeDelay;  // 衰落期间不放大退避，低频探测即可
+    }
+    return jittered();
+}
+
+void ReconnectBackoff::reset() {
+    prev_ = config_.initialDelay;
+}
+
+bool ReconnectBackoff::updateLinkQuality(double quality) {
+    if (config_.poorLinkThreshold <= 0.0 || !(quality > 0.0)) {
+        return false;  // 未启用或质量未知
+    }
+    if (quality > 1.0) {
+        quality /= 100.0;  // 百分比
+    }
+    const bool poor = quality < config_.poorLinkThreshold;
+    const bool recovered = linkPoor_ && !poor;
+    linkPoor_ = poor;
+    if (recovered) {
+        reset();
+    }
+    return recovered;
+}
+
+std::chrono::milliseconds ReconnectBackoff::jittered() {
+    const auto lo = config_.initialDelay.count();
+    const auto hi = std::max<std::int64_t>(lo, static_cast<std::int64_t>(prev_.count() * config_.multiplier));
+    std::uniform_int_distribution<std::int64_t> dist(lo, hi);
+    prev_ = std::min(config_.maxDelay, std::chrono::milliseconds(dist(rng_)));
+    return prev_;
+}
+
+ReconnectBackoff::Config ReconnectManager::Config::backoff() const {
+    ReconnectBackoff::Config cfg;
+    cfg.initialDelay = initialDelay;
+    cfg.maxDelay = maxDelay;
+    cfg.multiplier = backoffMultiplier;
+    cfg.fastRetry = fastRetry;
+    cfg.poorLinkThreshold = poorLinkThreshold;
+    cfg.fadeProbeDelay = fadeProbeDelay;
+    return cfg;
+}
+
 ReconnectManager::ReconnectManager(const Config& config)
-    : config_(config) {
+    : config_(config), backoff_(config.backoff()) {
 }
 
 ReconnectManager::~ReconnectManager() {
@@ -19,22 +106,35 @@ void ReconnectManager::setReconnectCallback(ReconnectCallback callback) {
     reconnectCallback_ = callback;
 }
 
-void ReconnectManager::triggerReconnect() {
+void ReconnectManager::triggerReconnect(bool transient) {
     if (!config_.enabled) {
         return;
     }
 
     bool expected = false;
     if (reconnecting_.compare_exchange_strong(expected, true)) {
-        // 启动重连线程
-        if (!reconnectThread_.joinable()) {
-            reconnectThread_ = std::thread(&ReconnectManager::reconnectLoop, this);
+        // 启动重连线程；上一次重连结束后线程已退出但未回收，先 join，否则再次断链时不会重连
+        if (reconnectThread_.joinable()) {
+            reconnectThread_.join();
         }
+        reconnectThread_ = std::thread(&ReconnectManager::reconnectLoop, this, transient);
+    }
+}
+
+void ReconnectManager::updateLinkQuality(double quality) {
+    std::lock_guard<std::mutex> lock(waitMutex_);
+    if (backoff_.updateLinkQuality(quality) && reconnecting_) {
+        wakeRequested_ = true;
+        waitCv_.notify_one();
     }
 }
 
 void ReconnectManager::stop() {
-    shouldStop_ = true;
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        shouldStop_ = true;
+    }
+    waitCv_.notify_all();
     if (reconnectThread_.joinable()) {
         reconnectThread_.join();
     }
@@ -46,21 +146,40 @@ void ReconnectManager::reset() {
     shouldStop_ = false;
 }
 
-void ReconnectManager::reconnectLoop() {
+void ReconnectManager::reconnectLoop(bool transient) {
     retryCount_ = 0;
-    auto delay = config_.initialDelay;
+    std::chrono::milliseconds delay;
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        delay = backoff_.begin(transient);
+        wakeRequested_ = false;
+    }
 
     while (!shouldStop_ && reconnecting_) {
-        if (config_.maxRetries >= 0 && retryCount_ >= config_.maxRetries) {
-            LOG_ERROR("ReconnectManager", 
-                "Max retry count (" + std::to_string(config_.maxRetries) + ") reached. Giving up.");
-            reconnecting_ = false;
+        bool probing = false;
+        {
+            // 等待可被 stop() 或链路恢复打断
+            std::unique_lock<std::mutex> lock(waitMutex_);
+            if (delay.count() > 0) {
+                // 按 PipelineClock 计时：虚拟时钟下退避在虚拟时刻到期
+                using falconmind::sdk::core::PipelineClock;
+                PipelineClock::waitUntil(waitCv_, lock,
+                                         PipelineClock::nowNs() + std::chrono::nanoseconds(delay).count(),
+                                         [this]() { return shouldStop_.load() || wakeRequested_; });
+            }
+            wakeRequested_ = false;
+            probing = backoff_.linkPoor();
+        }
+        if (shouldStop_) {
             break;
         }
 
-        retryCount_++;
+        if (!probing) {
+            retryCount_++;
+        }
         LOG_INFO("ReconnectManager", 
-            "Reconnection attempt " + std::to_string(retryCount_) + 
+            (probing ? std::string("Link fading, probe attempt ") : std::string("Reconnection attempt ")) +
+            std::to_string(retryCount_) +
             (config_.maxRetries >= 0 ? "/" + std::to_string(config_.maxRetries) : ""));
 
         // 执行重连回调
@@ -77,21 +196,25 @@ void ReconnectManager::reconnectLoop() {
                 std::to_string(retryCount_) + " attempts");
             reconnecting_ = false;
             retryCount_ = 0;
+            std::lock_guard<std::mutex> lock(waitMutex_);
+            backoff_.reset();
             break;
         }
 
-        // 重连失败，等待后重试
-        LOG_WARN("ReconnectManager", 
-            "Reconnection failed. Retrying in " + std::to_string(delay.count()) + "ms");
-
-        std::this_thread::sleep_for(delay);
+        if (!probing && config_.maxRetries >= 0 && retryCount_ >= config_.maxRetries) {
+            LOG_ERROR("ReconnectManager", 
+                "Max retry count (" + std::to_string(config_.maxRetries) + ") reached. Giving up.");
+            reconnecting_ = false;
+            break;
+        }
 
-        // 指数退避
-        delay = std::chrono::milliseconds(
-            static_cast<int64_t>(delay.count() * config_.backoffMultiplier));
-        if (delay > config_.maxDelay) {
-            delay = config_.maxDelay;
+        // 重连失败，按去相关抖动（或衰落期间的探测间隔）等待后重试
+        {
+            std::lock_guard<std::mutex> lock(waitMutex_);
+            delay = backoff_.next();
         }
+        LOG_WARN("ReconnectManager", 
+            "Reconnection failed. Retrying in " + std::to_string(delay.count()) + "ms");
     }
 }
 
@@ -0,0 +1,407 @@
+#include "nodeagent/SwarmLink.h"
+#include "nodeagent/ErrorStatistics.h"
+#include "nodeagent/Logger.h"
+
+#include "falconmind/sdk/telemetry/TelemetryPublisher.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace nodeagent {
+
+using falconmind::sdk::cluster::SwarmPeerState;
+using falconmind::sdk::cluster::SwarmStateRegistry;
+using falconmind::sdk::cluster::SwarmTargetClaim;
+using falconmind::sdk::cluster::SwarmTargetRecord;
+using falconmind::sdk::telemetry::TelemetryMessage;
+using falconmind::sdk::telemetry::TelemetryPublisher;
+
+struct SwarmLink::Destination {
+    sockaddr_in addr{};
+};
+
+namespace {
+
+constexpr std::uint8_t kMagic0 = 'F';
+constexpr std::uint8_t kMagic1 = 'S';
+
+template <typename T>
+void put(std::uint8_t*& p, T value) {
+    using U = std::make_unsigned_t<T>;
+    U u = static_cast<U>(value);
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        *p++ = static_cast<std::uint8_t>(u >> (8 * i));
+    }
+}
+
+template <typename T>
+T get(const std::uint8_t*& p) {
+    using U = std::make_unsigned_t<T>;
+    U u = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        u |= static_cast<U>(static_cast<U>(*p++) << (8 * i));
+    }
+    return static_cast<T>(u);
+}
+
+template <typename T>
+T quantize(double value, double scale) {
+    const double v = std::round(value * scale);
+    const double lo = static_cast<double>(std::numeric_limits<T>::min());
+    const double hi = static_cast<double>(std::numeric_limits<T>::max());
+    return static_cast<T>(std::clamp(std::isfinite(v) ? v : 0.0, lo, hi));
+}
+
+void putString(std::uint8_t*& p, const std::string& s) {
+    const std::size_t n = std::min(s.size(), kSwarmMaxIdBytes);
+    *p++ = static_cast<std::uint8_t>(n);
+    std::memcpy(p, s.data(), n);
+    p += n;
+}
+
+bool getString(const std::uint8_t*& p, const std::uint8_t* end, std::string& out) {
+    if (p >= end) return false;
+    const std::size_t n = *p++;
+    if (n > kSwarmMaxIdBytes || static_cast<std::size_t>(end - p) < n) return false;
+    out.assign(reinterpret_cast<const char*>(p), n);
+    p += n;
+    return true;
+}
+
+bool parseHostPort(const std::string& text, sockaddr_in& addr) {
+    const auto colon = text.rfind(':');
+    if (colon == std::string::npos) return false;
+    int port = 0;
+    try {
+        port = std::stoi(text.substr(colon + 1));
+    } catch (...) {
+        return false;
+    }
+    if (port <= 0 || port > 65535) return false;
+    addr = sockaddr_in{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<std::uint16_t>(port));
+    return inet_pton(AF_INET, text.substr(0, colon).c_str(), &addr.sin_addr) == 1;
+}
+
+std::int64_t systemNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+std::size_t SwarmLink::encode(const SwarmPeerState& state, std::uint8_t* out) {
+    std::uint8_t* p = out;
+    *p++ = kMagic0;
+    *p++ = kMagic1;
+    const std::size_t targets = std::min(state.targets.size(), kSwarmMaxTargets);
+    *p++ = targets > 0 ? kSwarmWireVersionTargets : kSwarmWireVersion;
+    *p++ = 0;
+    put<std::uint32_t>(p, state.seq);
+    put<std::int64_t>(p, state.sentNs);
+    put<std::int32_t>(p, quantize<std::int32_t>(state.lat, 1e7));
+    put<std::int32_t>(p, quantize<std::int32_t>(state.lon, 1e7));
+    put<std::int32_t>(p, quantize<std::int32_t>(state.alt, 1e3));
+    put<std::int16_t>(p, quantize<std::int16_t>(state.vx, 100.0));
+    put<std::int16_t>(p, quantize<std::int16_t>(state.vy, 100.0));
+    put<std::int16_t>(p, quantize<std::int16_t>(state.vz, 100.0));
+    putString(p, state.id);
+    putString(p, state.role);
+    const std::size_t claims = std::min(state.claims.size(), kSwarmMaxClaims);
+    *p++ = static_cast<std::uint8_t>(claims);
+    for (std::size_t i = 0; i < claims; ++i) {
+        put<std::uint32_t>(p, state.claims[i].targetId);
+        put<std::uint16_t>(p, quantize<std::uint16_t>(std::clamp(state.claims[i].score, 0.0f, 1.0f), 65535.0));
+    }
+    if (targets > 0) {
+        *p++ = static_cast<std::uint8_t>(targets);
+        for (std::size_t i = 0; i < targets; ++i) {
+            const SwarmTargetRecord& t = state.targets[i];
+            put<std::int32_t>(p, quantize<std::int32_t>(t.lat, 1e7));
+            put<std::int32_t>(p, quantize<std::int32_t>(t.lon, 1e7));
+            put<std::uint16_t>(p, t.classKey);
+            put<std::uint8_t>(p, quantize<std::uint8_t>(std::clamp(t.confidence, 0.0f, 1.0f), 255.0));
+        }
+    }
+    return static_cast<std::size_t>(p - out);
+}
+
+bool SwarmLink::decode(const std::uint8_t* data, std::size_t size, SwarmPeerState& out) {
+    if (size < kSwarmHeaderBytes + 3 || data[0] != kMagic0 || data[1] != kMagic1 ||
+        (data[2] != kSwarmWireVersion && data[2] != kSwarmWireVersionTargets)) {
+        return false;
+    }
+    const bool withTargets = data[2] == kSwarmWireVersionTargets;
+    const std::uint8_t* p = data + 4;
+    const std::uint8_t* end = data + size;
+    out = SwarmPeerState{};
+    out.seq = get<std::uint32_t>(p);
+    out.sentNs = get<std::int64_t>(p);
+    out.lat = get<std::int32_t>(p) / 1e7;
+    out.lon = get<std::int32_t>(p) / 1e7;
+    out.alt = get<std::int32_t>(p) / 1e3;
+    out.vx = get<std::int16_t>(p) / 100.0f;
+    out.vy = get<std::int16_t>(p) / 100.0f;
+    out.vz = get<std::int16_t>(p) / 100.0f;
+    if (!getString(p, end, out.id) || out.id.empty() || !getString(p, end, out.role) || p >= end) {
+        return false;
+    }
+    const std::size_t claims = *p++;
+    if (claims > kSwarmMaxClaims) return false;
+    if (withTargets ? static_cast<std::size_t>(end - p) < claims * 6 + 1
+                    : static_cast<std::size_t>(end - p) != claims * 6) {
+        return false;
+    }
+    out.claims.resize(claims);
+    for (auto& c : out.claims) {
+        c.targetId = get<std::uint32_t>(p);
+        c.score = get<std::uint16_t>(p) / 65535.0f;
+    }
+    if (!withTargets) return true;
+    const std::size_t targets = *p++;
+    if (targets == 0 || targets > kSwarmMaxTargets ||
+        static_cast<std::size_t>(end - p) != targets * kSwarmTargetRecordBytes) {
+        return false;
+    }
+    out.targets.resize(targets);
+    for (auto& t : out.targets) {
+        t.lat = get<std::int32_t>(p) / 1e7;
+        t.lon = get<std::int32_t>(p) / 1e7;
+        t.classKey = get<std::uint16_t>(p);
+        t.confidence = get<std::uint8_t>(p) / 255.0f;
+    }
+    return true;
+}
+
+SwarmLink::SwarmLink(const SwarmLinkConfig& config, const std::string& selfId, bool routeByUavId)
+    : config_(config), selfId_(selfId), routeByUavId_(routeByUavId) {
+    config_.rateHz = std::clamp(config_.rateHz, 1, 100);
+}
+
+SwarmLink::~SwarmLink() {
+    stop();
+}
+
+bool SwarmLink::openSocket() {
+    socketFd_ = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (socketFd_ < 0) {
+        ErrorStatistics::instance().recordError(ErrorCode::SocketError, "SwarmLink socket() failed");
+        LOG_ERROR("SwarmLink", std::string("Failed to create socket: ") + std::strerror(errno));
+        return false;
+    }
+    const int one = 1;
+    setsockopt(socketFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    // 同机多个进程（仿真）监听同一组播端口
+    setsockopt(socketFd_, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+
+    sockaddr_in bindAddr{};
+    bindAddr.sin_family = AF_INET;
+    bindAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+    bindAddr.sin_port = htons(static_cast<std::uint16_t>(config_.port));
+    if (bind(socketFd_, reinterpret_cast<sockaddr*>(&bindAddr), sizeof(bindAddr)) != 0) {
+        ErrorStatistics::instance().recordError(ErrorCode::SocketError, "SwarmLink bind() failed");
+        LOG_ERROR("SwarmLink", "Failed to bind port " + std::to_string(config_.port) + ": " + std::strerror(errno));
+        closeSocket();
+        return false;
+    }
+
+    in_addr iface{};
+    iface.s_addr = htonl(INADDR_ANY);
+    if (!config_.interfaceAddress.empty() &&
+        inet_pton(AF_INET, config_.interfaceAddress.c_str(), &iface) != 1) {
+        ErrorStatistics::instance().recordError(ErrorCode::InvalidAddress,
+                                                "SwarmLink interface: " + config_.interfaceAddress);
+        LOG_ERROR("SwarmLink", "Invalid interface address: " + config_.interfaceAddress);
+        closeSocket();
+        return false;
+    }
+
+    if (!config_.group.empty()) {
+        Destination dest;
+        dest.addr.sin_family = AF_INET;
+        dest.addr.sin_port = htons(static_cast<std::uint16_t>(config_.port));
+        if (inet_pton(AF_INET, config_.group.c_str(), &dest.addr.sin_addr) != 1) {
+            ErrorStatistics::instance().recordError(ErrorCode::InvalidAddress, "SwarmLink group: " + config_.group);
+            LOG_ERROR("SwarmLink", "Invalid multicast group: " + config_.group);
+            closeSocket();
+            return false;
+        }
+        ip_mreq mreq{};
+        mreq.imr_multiaddr = dest.addr.sin_addr;
+        mreq.imr_interface = iface;
+        if (setsockopt(socketFd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0) {
+            // 无组播路由（如仅有回环接口）时仍可走 peers 单播
+            LOG_WARN("SwarmLink", "Failed to join " + config_.group + ": " + std::strerror(errno));
+        }
+        const unsigned char ttl = static_cast<unsigned char>(std::clamp(config_.ttl, 0, 255));
+        const unsigned char loop = config_.multicastLoopback ? 1 : 0;
+        setsockopt(socketFd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+        setsockopt(socketFd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+        if (!config_.interfaceAddress.empty()) {
+            setsockopt(socketFd_, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface));
+        }
+        destinations_.push_back(dest);
+    }
+    for (const auto& peer : config_.peers) {
+        Destination dest;
+        if (!parseHostPort(peer, dest.addr)) {
+            LOG_WARN("SwarmLink", "Ignoring invalid peer address: " + peer);
+            continue;
+        }
+        destinations_.push_back(dest);
+    }
+    if (destinations_.empty()) {
+        LOG_WARN("SwarmLink", "No multicast group or peers configured, receiving only");
+    }
+
+    wakeFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd_ < 0) {
+        ErrorStatistics::instance().recordError(ErrorCode::SocketError, "SwarmLink eventfd() failed");
+        closeSocket();
+        return false;
+    }
+    return true;
+}
+
+void SwarmLink::closeSocket() {
+    if (socketFd_ >= 0) {
+        close(socketFd_);
+        socketFd_ = -1;
+    }
+    if (wakeFd_ >= 0) {
+        close(wakeFd_);
+        wakeFd_ = -1;
+    }
+    destinations_.clear();
+}
+
+int SwarmLink::localPort() const {
+    if (socketFd_ < 0) return -1;
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (getsockname(socketFd_, reinterpret_cast<sockaddr*>(&addr), &len) != 0) return -1;
+    return ntohs(addr.sin_port);
+}
+
+bool SwarmLink::start() {
+    if (running_) return true;
+    if (!openSocket()) return false;
+
+    SwarmStateRegistry::instance().setLocalId(selfId_);
+    auto onTelemetry = [this](const TelemetryMessage& msg) { updateOwnState(msg); };
+    telemetrySubId_ = routeByUavId_ ? TelemetryPublisher::instance().subscribe(selfId_, onTelemetry)
+                                    : TelemetryPublisher::instance().subscribe(onTelemetry);
+
+    running_ = true;
+    thread_ = std::thread(&SwarmLink::run, this);
+    LOG_INFO("SwarmLink", "Started (id=" + selfId_ + ", port=" + std::to_string(localPort()) +
+                              ", destinations=" + std::to_string(destinations_.size()) +
+                              ", rate=" + std::to_string(config_.rateHz) + " Hz)");
+    return true;
+}
+
+void SwarmLink::stop() {
+    if (!running_.exchange(false)) return;
+    const std::uint64_t one = 1;
+    if (write(wakeFd_, &one, sizeof(one)) < 0) {
+        // 循环线程最迟在下一次广播时刻检查 running_
+    }
+    if (thread_.joinable()) thread_.join();
+    TelemetryPublisher::instance().unsubscribe(telemetrySubId_);
+    telemetrySubId_ = -1;
+    closeSocket();
+    LOG_INFO("SwarmLink", "Stopped");
+}
+
+void SwarmLink::updateOwnState(const TelemetryMessage& msg) {
+    SwarmStateRegistry::instance().setLocalPosition(msg.lat, msg.lon, msg.alt, static_cast<float>(msg.vx),
+                                                    static_cast<float>(msg.vy), static_cast<float>(msg.vz));
+}
+
+SwarmLinkStats SwarmLink::stats() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return stats_;
+}
+
+void SwarmLink::run() {
+    using Clock = std::chrono::steady_clock;
+    const auto interval = std::chrono::microseconds(1000000 / config_.rateHz);
+    auto nextSend = Clock::now();
+    pollfd fds[2] = {{socketFd_, POLLIN, 0}, {wakeFd_, POLLIN, 0}};
+    while (running_) {
+        const auto now = Clock::now();
+        if (now >= nextSend) {
+            broadcast();
+            nextSend += interval;
+            if (nextSend < now) nextSend = now + interval;  // 长时间阻塞后不补发
+        }
+        const auto waitMs = std::chrono::duration_cast<std::chrono::milliseconds>(nextSend - Clock::now()).count();
+        const int ready = poll(fds, 2, static_cast<int>(std::max<long long>(waitMs, 0) + 1));
+        if (ready < 0 && errno != EINTR) {
+            LOG_ERROR("SwarmLink", std::string("poll() failed: ") + std::strerror(errno));
+            break;
+        }
+        if (ready > 0 && (fds[0].revents & POLLIN)) {
+            receiveAvailable();
+        }
+    }
+}
+
+void SwarmLink::broadcast() {
+    if (destinations_.empty()) return;
+    auto& registry = SwarmStateRegistry::instance();
+    SwarmPeerState local = registry.localState();
+    local.id = selfId_;
+    local.targets = registry.targetRegistry()->nextBroadcast(kSwarmMaxTargets);
+    local.seq = ++seq_;
+    local.sentNs = systemNowNs();
+    std::uint8_t packet[kSwarmMaxPacketBytes];
+    const std::size_t size = encode(local, packet);
+
+    std::uint64_t sent = 0;
+    std::uint64_t errors = 0;
+    for (const auto& dest : destinations_) {
+        const ssize_t n = sendto(socketFd_, packet, size, 0, reinterpret_cast<const sockaddr*>(&dest.addr),
+                                 sizeof(dest.addr));
+        if (n == static_cast<ssize_t>(size)) {
+            ++sent;
+        } else {
+            ++errors;
+        }
+    }
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    stats_.sent += sent;
+    stats_.sendErrors += errors;
+}
+
+void SwarmLink::receiveAvailable() {
+    std::uint8_t buffer[2048];
+    auto& registry = SwarmStateRegistry::instance();
+    for (;;) {
+        const ssize_t n = recv(socketFd_, buffer, sizeof(buffer), 0);
+        if (n < 0) break;  // EAGAIN：已读完
+        SwarmPeerState state;
+        if (!decode(buffer, static_cast<std::size_t>(n), state)) {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            ++stats_.decodeErrors;
+            continue;
+        }
+        const bool accepted = state.id != selfId_ && registry.updatePeer(std::move(state));
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        ++(accepted ? stats_.received : stats_.stale);
+    }
+}
+
+} // namespace nodeagent
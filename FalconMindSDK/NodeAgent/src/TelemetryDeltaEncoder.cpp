@@ -0,0 +1,167 @@
+#include "nodeagent/TelemetryDeltaEncoder.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace nodeagent {
+
+using falconmind::sdk::telemetry::TelemetryFrameInfo;
+using falconmind::sdk::telemetry::TelemetryMessage;
+namespace tlm = falconmind::sdk::telemetry;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kMetersPerDegree = 111320.0;
+
+// 离散量字段组：任意变化即发送，不随链路质量降频、不受字节预算限制
+constexpr std::uint32_t kDiscreteGroups = tlm::TelemetryGroupGps | tlm::TelemetryGroupMode;
+
+double angleDiff(double a, double b) {
+    double d = std::fmod(a - b, 2.0 * kPi);
+    if (d > kPi) d -= 2.0 * kPi;
+    if (d < -kPi) d += 2.0 * kPi;
+    return std::fabs(d);
+}
+
+// 字段组与上次发送值的差异（单位见 TelemetryDeltaConfig 说明）
+double groupChange(std::size_t group, const TelemetryMessage& m, const TelemetryMessage& s) {
+    switch (1u << group) {
+    case tlm::TelemetryGroupPosition: {
+        const double dn = (m.lat - s.lat) * kMetersPerDegree;
+        const double de = (m.lon - s.lon) * kMetersPerDegree * std::cos(m.lat * kPi / 180.0);
+        const double du = m.alt - s.alt;
+        return std::sqrt(dn * dn + de * de + du * du);
+    }
+    case tlm::TelemetryGroupAttitude:
+        return std::max({angleDiff(m.roll, s.roll), angleDiff(m.pitch, s.pitch), angleDiff(m.yaw, s.yaw)});
+    case tlm::TelemetryGroupVelocity:
+        return std::sqrt((m.vx - s.vx) * (m.vx - s.vx) + (m.vy - s.vy) * (m.vy - s.vy) + (m.vz - s.vz) * (m.vz - s.vz));
+    case tlm::TelemetryGroupBattery:
+        return std::max(std::fabs(m.batteryPercent - s.batteryPercent),
+                        std::abs(m.batteryVoltageMv - s.batteryVoltageMv) / 100.0);
+    case tlm::TelemetryGroupGps:
+        return (m.gpsFixType != s.gpsFixType || m.numSat != s.numSat) ? 1.0 : 0.0;
+    case tlm::TelemetryGroupLink:
+        return std::fabs(m.linkQuality - s.linkQuality);
+    case tlm::TelemetryGroupMode:
+        return m.flightMode != s.flightMode ? 1.0 : 0.0;
+    default:
+        return 0.0;
+    }
+}
+
+int popcount(std::uint32_t v) {
+    int n = 0;
+    for (; v; v &= v - 1) ++n;
+    return n;
+}
+
+} // namespace
+
+TelemetryDeltaEncoder::TelemetryDeltaEncoder(const TelemetryDeltaConfig& config)
+    : config_(config) {
+}
+
+void TelemetryDeltaEncoder::reset() {
+    uavs_.clear();
+    budgetBytes_ = 0.0;
+    budgetNs_ = 0;
+}
+
+double TelemetryDeltaEncoder::rateScale(const TelemetryMessage& msg) const noexcept {
+    if (!config_.adaptToLinkQuality || msg.linkQuality <= 0.0) {
+        return 1.0;
+    }
+    return std::clamp(msg.linkQuality, std::max(config_.minRateScale, 1e-3), 1.0);
+}
+
+void TelemetryDeltaEncoder::refillBudget(std::int64_t nowNs) noexcept {
+    if (budgetNs_ == 0) {
+        budgetBytes_ = config_.maxBytesPerSec;  // 起始允许 1 秒突发
+    } else if (nowNs > budgetNs_) {
+        budgetBytes_ = std::min(config_.maxBytesPerSec,
+                                budgetBytes_ + config_.maxBytesPerSec * (nowNs - budgetNs_) * 1e-9);
+    }
+    budgetNs_ = nowNs;
+}
+
+std::size_t TelemetryDeltaEncoder::encode(const TelemetryMessage& msg, std::int64_t nowNs, std::uint8_t* out,
+                                          std::size_t capacity) {
+    ++stats_.inputs;
+    UavState& st = uavs_[msg.uavId];
+    const bool keyframe = !st.primed || (config_.keyframeIntervalSec > 0.0 &&
+                                         (nowNs - st.lastKeyframeNs) * 1e-9 >= config_.keyframeIntervalSec);
+
+    std::uint32_t mask = 0;
+    if (keyframe) {
+        mask = tlm::kTelemetryAllGroups;
+    } else {
+        const double scale = rateScale(msg);
+        for (std::size_t g = 0; g < tlm::kTelemetryGroupCount; ++g) {
+            const std::uint32_t bit = 1u << g;
+            const TelemetryGroupPolicy& policy = config_.groups[g];
+            if (policy.rateHz <= 0.0) continue;
+            const double rate = (bit & kDiscreteGroups) ? policy.rateHz : policy.rateHz * scale;
+            if ((nowNs - st.lastSentNs[g]) * 1e-9 < 1.0 / rate) continue;
+            if (groupChange(g, msg, st.sent) <= policy.deadband) continue;
+            mask |= bit;
+        }
+    }
+
+    if (mask == 0 && !keyframe && (nowNs - st.lastFrameNs) * 1e-9 < config_.heartbeatIntervalSec) {
+        return 0;
+    }
+
+    TelemetryFrameInfo info;
+    info.delta = true;
+    info.groups = mask;
+    info.keyframe = keyframe;
+    info.seq = st.seq + 1;
+    std::size_t n = tlm::encodeTelemetryDeltaFrame(msg, info, out, capacity);
+    if (n > 0 && config_.maxBytesPerSec > 0.0 && !keyframe) {
+        refillBudget(nowNs);
+        const std::uint32_t continuous = mask & ~kDiscreteGroups;
+        if (static_cast<double>(n) > budgetBytes_ && continuous != 0) {
+            // 预算不足：推迟连续量字段组（下次仍会因差异超过死区而发送），离散量照常
+            stats_.deferred += static_cast<std::uint64_t>(popcount(continuous));
+            mask &= kDiscreteGroups;
+            if (mask == 0 && (nowNs - st.lastFrameNs) * 1e-9 < config_.heartbeatIntervalSec) {
+                return 0;
+            }
+            info.groups = mask;
+            n = tlm::encodeTelemetryDeltaFrame(msg, info, out, capacity);
+        }
+    }
+    if (n == 0) {
+        ++stats_.encodeFailures;
+        return 0;
+    }
+
+    tlm::mergeTelemetryGroups(msg, mask, st.sent);
+    for (std::size_t g = 0; g < tlm::kTelemetryGroupCount; ++g) {
+        if (mask & (1u << g)) {
+            st.lastSentNs[g] = nowNs;
+            ++stats_.groupsSent[g];
+        }
+    }
+    if (keyframe) {
+        st.lastKeyframeNs = nowNs;
+        st.primed = true;
+        ++stats_.keyframes;
+    }
+    if (mask == 0) {
+        ++stats_.heartbeats;
+    }
+    st.lastFrameNs = nowNs;
+    st.seq = info.seq;
+    if (config_.maxBytesPerSec > 0.0) {
+        if (keyframe) refillBudget(nowNs);
+        budgetBytes_ -= static_cast<double>(n);
+    }
+    ++stats_.frames;
+    stats_.bytes += n;
+    return n;
+}
+
+} // namespace nodeagent
@@ -0,0 +1,416 @@
+#include "nodeagent/TelemetrySpool.h"
+#include "nodeagent/Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace nodeagent {
+
+namespace {
+
+constexpr char kSpoolMagic[4] = {'F', 'M', 'S', 'P'};
+constexpr std::uint32_t kSpoolVersion = 1;
+constexpr std::size_t kSegmentHeaderBytes = 64;
+constexpr std::size_t kAlign = 8;
+constexpr std::size_t kMinSegmentBytes = 4096;
+constexpr std::size_t kMaxPayloadBytes = 0xFFFFFFFFu;
+
+struct RecordHeader {
+    std::uint32_t size;
+    std::uint32_t crc;
+    std::int64_t timestampNs;
+};
+static_assert(sizeof(RecordHeader) == 16, "record header layout");
+
+constexpr std::size_t alignUp(std::size_t n, std::size_t a) noexcept { return (n + a - 1) / a * a; }
+constexpr std::size_t recordBytes(std::size_t payload) noexcept { return alignUp(sizeof(RecordHeader) + payload, kAlign); }
+
+// CRC-32（IEEE 802.3，反射多项式 0xEDB88320）
+struct CrcTable {
+    std::uint32_t v[256];
+    CrcTable() {
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            v[i] = c;
+        }
+    }
+};
+
+std::uint32_t crc32(const std::uint8_t* data, std::size_t size) noexcept {
+    static const CrcTable table;
+    std::uint32_t c = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < size; ++i) c = table.v[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+    return c ^ 0xFFFFFFFFu;
+}
+
+std::string segmentName(SpoolClass cls, std::uint64_t seq) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s-%020llu.spool", spoolClassName(cls), static_cast<unsigned long long>(seq));
+    return name;
+}
+
+} // namespace
+
+// 段文件头（映射在文件开头）；writeOffset / readOffset 为数据区内偏移，发布顺序保证进程崩溃后可恢复
+struct SegmentFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t cls;
+    std::uint32_t reserved;
+    std::uint64_t seq;
+    std::uint64_t capacity;  // 数据区字节数
+    std::atomic<std::uint64_t> writeOffset;
+    std::atomic<std::uint64_t> readOffset;
+};
+static_assert(sizeof(SegmentFileHeader) <= kSegmentHeaderBytes, "segment header must fit");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "segment header atomics must be lock free");
+
+struct TelemetrySpool::Segment {
+    std::string path;
+    int fd{-1};
+    std::uint8_t* map{nullptr};
+    std::size_t mapBytes{0};
+    SegmentFileHeader* header{nullptr};
+    std::uint64_t pending{0};  // 未补发的记录数
+
+    std::uint8_t* data() const noexcept { return map + kSegmentHeaderBytes; }
+    std::size_t capacity() const noexcept { return mapBytes - kSegmentHeaderBytes; }
+    std::size_t fileBytes() const noexcept { return mapBytes; }
+
+    ~Segment() {
+        if (map) {
+            ::msync(map, mapBytes, MS_ASYNC);
+            ::munmap(map, mapBytes);
+        }
+        if (fd >= 0) ::close(fd);
+    }
+
+    // 创建并预分配新段；失败返回 nullptr
+    static std::unique_ptr<Segment> create(const std::string& path, SpoolClass cls, std::uint64_t seq,
+                                           std::size_t bytes) {
+        auto seg = std::make_unique<Segment>();
+        seg->path = path;
+        seg->fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (seg->fd < 0) {
+            LOG_ERROR("TelemetrySpool", "open " + path + " failed: " + std::strerror(errno));
+            return nullptr;
+        }
+        // 预分配：磁盘满只会在创建段时发现，而不是在写映射页时（SIGBUS）
+        const int rc = ::posix_fallocate(seg->fd, 0, static_cast<off_t>(bytes));
+        if (rc != 0) {
+            LOG_ERROR("TelemetrySpool", "preallocate " + path + " failed: " + std::strerror(rc));
+            ::unlink(path.c_str());
+            return nullptr;
+        }
+        if (!seg->mapFile(bytes)) {
+            ::unlink(path.c_str());
+            return nullptr;
+        }
+        seg->header = new (seg->map) SegmentFileHeader{};
+        std::memcpy(seg->header->magic, kSpoolMagic, sizeof(kSpoolMagic));
+        seg->header->version = kSpoolVersion;
+        seg->header->cls = static_cast<std::uint32_t>(cls);
+        seg->header->seq = seq;
+        seg->header->capacity = seg->capacity();
+        return seg;
+    }
+
+    // 打开已有段；文件头不匹配时返回 nullptr
+    static std::unique_ptr<Segment> load(const std::string& path, SpoolClass cls) {
+        auto seg = std::make_unique<Segment>();
+        seg->path = path;
+        seg->fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+        if (seg->fd < 0) {
+            return nullptr;
+        }
+        const off_t size = ::lseek(seg->fd, 0, SEEK_END);
+        if (size <= static_cast<off_t>(kSegmentHeaderBytes) || !seg->mapFile(static_cast<std::size_t>(size))) {
+            return nullptr;
+        }
+        seg->header = reinterpret_cast<SegmentFileHeader*>(seg->map);
+        if (std::memcmp(seg->header->magic, kSpoolMagic, sizeof(kSpoolMagic)) != 0 ||
+            seg->header->version != kSpoolVersion || seg->header->cls != static_cast<std::uint32_t>(cls) ||
+            seg->header->capacity != seg->capacity()) {
+            return nullptr;
+        }
+        return seg;
+    }
+
+    bool mapFile(std::size_t bytes) {
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            LOG_ERROR("TelemetrySpool", "mmap " + path + " failed: " + std::strerror(errno));
+            return false;
+        }
+        map = static_cast<std::uint8_t*>(p);
+        mapBytes = bytes;
+        return true;
+    }
+
+    // 校验 [readOffset, writeOffset) 内的记录，截断到最后一条完整记录；返回是否发现损坏
+    bool validate() {
+        std::uint64_t read = header->readOffset.load(std::memory_order_acquire);
+        std::uint64_t write = header->writeOffset.load(std::memory_order_acquire);
+        bool corrupt = false;
+        if (write > capacity() || read > write) {
+            corrupt = true;
+            read = std::min<std::uint64_t>(read, capacity());
+            write = std::min<std::uint64_t>(write, capacity());
+            if (read > write) read = write;
+        }
+        std::uint64_t pos = read;
+        pending = 0;
+        while (pos + sizeof(RecordHeader) <= write) {
+            RecordHeader rh;
+            std::memcpy(&rh, data() + pos, sizeof(rh));
+            const std::size_t bytes = recordBytes(rh.size);
+            if (pos + bytes > write || crc32(data() + pos + sizeof(rh), rh.size) != rh.crc) {
+                corrupt = true;
+                break;
+            }
+            pos += bytes;
+            ++pending;
+        }
+        if (pos != write) corrupt = true;
+        header->readOffset.store(read, std::memory_order_relaxed);
+        header->writeOffset.store(pos, std::memory_order_release);
+        return corrupt;
+    }
+
+    bool fits(std::size_t bytes) const noexcept {
+        return header->writeOffset.load(std::memory_order_relaxed) + bytes <= capacity();
+    }
+    bool drained() const noexcept {
+        return header->readOffset.load(std::memory_order_relaxed) == header->writeOffset.load(std::memory_order_relaxed);
+    }
+};
+
+const char* spoolClassName(SpoolClass cls) noexcept {
+    switch (cls) {
+        case SpoolClass::Event: return "event";
+        case SpoolClass::Detection: return "detection";
+        case SpoolClass::Telemetry: return "telemetry";
+    }
+    return "unknown";
+}
+
+TelemetrySpool::TelemetrySpool(const TelemetrySpoolConfig& config) : config_(config) {
+    const long page = ::sysconf(_SC_PAGESIZE);
+    config_.segmentBytes =
+        alignUp(std::max(config_.segmentBytes, kMinSegmentBytes), page > 0 ? static_cast<std::size_t>(page) : 4096);
+    config_.maxBytes = std::max(config_.maxBytes, config_.segmentBytes * kSpoolClassCount);
+}
+
+TelemetrySpool::~TelemetrySpool() = default;
+
+std::unique_ptr<TelemetrySpool> TelemetrySpool::open(const TelemetrySpoolConfig& config) {
+    if (config.directory.empty()) {
+        return nullptr;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(config.directory, ec);
+    if (ec || !std::filesystem::is_directory(config.directory, ec)) {
+        LOG_ERROR("TelemetrySpool", "Spool directory unavailable: " + config.directory);
+        return nullptr;
+    }
+    std::unique_ptr<TelemetrySpool> spool(new TelemetrySpool(config));
+    if (!spool->recover()) {
+        return nullptr;
+    }
+    return spool;
+}
+
+bool TelemetrySpool::recover() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::array<std::map<std::uint64_t, std::string>, kSpoolClassCount> found;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(config_.directory, ec)) {
+        const std::string name = entry.path().filename().string();
+        for (std::size_t c = 0; c < kSpoolClassCount; ++c) {
+            const std::string prefix = std::string(spoolClassName(static_cast<SpoolClass>(c))) + "-";
+            unsigned long long seq = 0;
+            if (name.compare(0, prefix.size(), prefix) == 0 &&
+                std::sscanf(name.c_str() + prefix.size(), "%llu.spool", &seq) == 1) {
+                found[c][seq] = entry.path().string();
+            }
+        }
+    }
+    if (ec) {
+        LOG_ERROR("TelemetrySpool", "Cannot list spool directory " + config_.directory + ": " + ec.message());
+        return false;
+    }
+
+    for (std::size_t c = 0; c < kSpoolClassCount; ++c) {
+        for (const auto& [seq, path] : found[c]) {
+            nextSeq_[c] = std::max(nextSeq_[c], seq + 1);
+            auto seg = Segment::load(path, static_cast<SpoolClass>(c));
+            if (!seg) {
+                LOG_WARN("TelemetrySpool", "Discarding unreadable spool segment " + path);
+                ++stats_.corrupt;
+                ::unlink(path.c_str());
+                continue;
+            }
+            if (seg->validate()) {
+                LOG_WARN("TelemetrySpool", "Truncated damaged records in spool segment " + path);
+                ++stats_.corrupt;
+            }
+            if (seg->pending == 0 && seg->drained() && !seg->fits(recordBytes(0))) {
+                ::unlink(path.c_str());  // 写满且已全部补发
+                continue;
+            }
+            stats_.recovered += seg->pending;
+            stats_.pending[c] += seg->pending;
+            stats_.bytesOnDisk += seg->fileBytes();
+            segments_[c].push_back(std::move(seg));
+        }
+    }
+    if (stats_.recovered > 0) {
+        LOG_INFO("TelemetrySpool", "Recovered " + std::to_string(stats_.recovered) + " spooled records from " +
+                 config_.directory);
+    }
+    enforceLimit();
+    return true;
+}
+
+TelemetrySpool::Segment* TelemetrySpool::writableSegment(SpoolClass cls, std::size_t bytes) {
+    auto& list = segments_[static_cast<std::size_t>(cls)];
+    if (!list.empty() && list.back()->fits(bytes)) {
+        return list.back().get();
+    }
+    const std::uint64_t seq = nextSeq_[static_cast<std::size_t>(cls)]++;
+    const std::string path = (std::filesystem::path(config_.directory) / segmentName(cls, seq)).string();
+    auto seg = Segment::create(path, cls, seq, config_.segmentBytes);
+    if (!seg) {
+        return nullptr;
+    }
+    stats_.bytesOnDisk += seg->fileBytes();
+    list.push_back(std::move(seg));
+    enforceLimit();
+    // enforceLimit 不会删除刚创建的段（每类至少保留最新一段）
+    return list.back().get();
+}
+
+void TelemetrySpool::removeFront(SpoolClass cls) {
+    auto& list = segments_[static_cast<std::size_t>(cls)];
+    if (list.empty()) {
+        return;
+    }
+    const std::size_t c = static_cast<std::size_t>(cls);
+    stats_.pending[c] -= list.front()->pending;
+    stats_.bytesOnDisk -= list.front()->fileBytes();
+    const std::string path = list.front()->path;
+    list.pop_front();
+    ::unlink(path.c_str());
+}
+
+void TelemetrySpool::enforceLimit() {
+    // 从最不重要的类别开始删除最旧的段；每类保留正在写入的最新一段
+    for (std::size_t c = kSpoolClassCount; c-- > 0 && stats_.bytesOnDisk > config_.maxBytes;) {
+        auto& list = segments_[c];
+        while (list.size() > 1 && stats_.bytesOnDisk > config_.maxBytes) {
+            const std::uint64_t lost = list.front()->pending;
+            if (lost > 0) {
+                stats_.evicted[c] += lost;
+                LOG_WARN("TelemetrySpool", "Spool full, dropped " + std::to_string(lost) + " oldest " +
+                         spoolClassName(static_cast<SpoolClass>(c)) + " records");
+            }
+            removeFront(static_cast<SpoolClass>(c));
+        }
+    }
+}
+
+bool TelemetrySpool::append(SpoolClass cls, const void* data, std::size_t size, std::int64_t timestampNs) {
+    const std::size_t bytes = recordBytes(size);
+    if (size > kMaxPayloadBytes || bytes > config_.segmentBytes - kSegmentHeaderBytes) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Segment* seg = writableSegment(cls, bytes);
+    if (!seg) {
+        return false;
+    }
+    const std::uint64_t pos = seg->header->writeOffset.load(std::memory_order_relaxed);
+    std::uint8_t* dst = seg->data() + pos;
+    const RecordHeader rh{static_cast<std::uint32_t>(size), crc32(static_cast<const std::uint8_t*>(data), size),
+                          timestampNs};
+    std::memcpy(dst, &rh, sizeof(rh));
+    std::memcpy(dst + sizeof(rh), data, size);
+    // 记录内容先于写位置发布：崩溃后写位置之内的记录总是完整的
+    seg->header->writeOffset.store(pos + bytes, std::memory_order_release);
+    ++seg->pending;
+    const std::size_t c = static_cast<std::size_t>(cls);
+    ++stats_.appended[c];
+    ++stats_.pending[c];
+    return true;
+}
+
+std::size_t TelemetrySpool::drain(std::int64_t nowNs, const SendFn& send) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const double burst = static_cast<double>(std::max<std::size_t>(config_.drainBurstBytes, 1));
+    if (budgetNs_ == 0) {
+        budgetBytes_ = burst;
+    } else if (nowNs > budgetNs_) {
+        budgetBytes_ = std::min(burst, budgetBytes_ + config_.drainBytesPerSec * (nowNs - budgetNs_) * 1e-9);
+    }
+    budgetNs_ = nowNs;
+
+    std::size_t sent = 0;
+    for (std::size_t c = 0; c < kSpoolClassCount; ++c) {
+        auto& list = segments_[c];
+        while (!list.empty()) {
+            Segment* seg = list.front().get();
+            const std::uint64_t read = seg->header->readOffset.load(std::memory_order_relaxed);
+            const std::uint64_t write = seg->header->writeOffset.load(std::memory_order_acquire);
+            if (read >= write) {
+                if (list.size() == 1) break;  // 当前写入段，保留
+                removeFront(static_cast<SpoolClass>(c));
+                continue;
+            }
+            RecordHeader rh;
+            std::memcpy(&rh, seg->data() + read, sizeof(rh));
+            // 令牌不足时停止；预算为满桶时总允许一条（大于桶容量的记录也能补发）
+            if (static_cast<double>(rh.size) > budgetBytes_ && budgetBytes_ < burst) {
+                return sent;
+            }
+            if (!send(static_cast<SpoolClass>(c), seg->data() + read + sizeof(rh), rh.size, rh.timestampNs)) {
+                return sent;
+            }
+            budgetBytes_ -= static_cast<double>(rh.size);
+            seg->header->readOffset.store(read + recordBytes(rh.size), std::memory_order_release);
+            --seg->pending;
+            --stats_.pending[c];
+            ++stats_.drained[c];
+            ++sent;
+            if (budgetBytes_ <= 0.0) {
+                return sent;
+            }
+        }
+    }
+    return sent;
+}
+
+bool TelemetrySpool::empty() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::uint64_t p : stats_.pending) {
+        if (p > 0) return false;
+    }
+    return true;
+}
+
+TelemetrySpoolStats TelemetrySpool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace nodeagent
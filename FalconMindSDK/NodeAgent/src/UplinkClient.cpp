@@ -2,21 +2,41 @@
 #include "nodeagent/Logger.h"
 #include "nodeagent/ErrorCodes.h"
 #include "nodeagent/ErrorStatistics.h"
+#include "nodeagent/PayloadCompression.h"
+#include "falconmind/sdk/telemetry/TelemetryCodec.h"
 #include <nlohmann/json.hpp>
 
+#include <fcntl.h>
+#include <poll.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <cstring>
 #include <sstream>
 #include <iomanip>
 #include <iostream>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
 
 namespace nodeagent {
 
+namespace {
+constexpr const char* kHelloReplyPrefix = "HELLO:";
+constexpr std::size_t kHelloReplyMaxBytes = 1024;  // 应答中带字典 ID 列表
+constexpr std::size_t kControlLane = static_cast<std::size_t>(UplinkPriority::Control);
+constexpr std::size_t kBulkLane = static_cast<std::size_t>(UplinkPriority::Bulk);
+constexpr std::size_t kLaneCompactBytes = 64 * 1024;  // 通道已写出部分超过该值且过半时前移剩余数据
+} // namespace
+
 UplinkClient::UplinkClient(const Config& config)
-    : config_(config) {
+    : config_(config)
+    , delta_(config.delta) {
 }
 
 UplinkClient::~UplinkClient() {
@@ -27,19 +47,91 @@ bool UplinkClient::connect() {
     if (connected_) {
         return true;
     }
+    struct sockaddr_in serverAddr;
+    if (!openSocket(&serverAddr)) {
+        return false;
+    }
+    if (::connect(socketFd_, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) < 0) {
+        failConnect(errno);
+        return false;
+    }
+    return completeConnect();
+}
+
+UplinkClient::ConnectProgress UplinkClient::beginConnect() {
+    if (connected_) {
+        return ConnectProgress::Connected;
+    }
+    struct sockaddr_in serverAddr;
+    if (!openSocket(&serverAddr)) {
+        return ConnectProgress::Failed;
+    }
+    const int flags = fcntl(socketFd_, F_GETFL, 0);
+    if (flags < 0 || fcntl(socketFd_, F_SETFL, flags | O_NONBLOCK) < 0) {
+        failConnect(errno);
+        return ConnectProgress::Failed;
+    }
+    if (::connect(socketFd_, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) == 0) {
+        return finishConnect() ? ConnectProgress::Connected : ConnectProgress::Failed;  // 本机对端可能立即完成
+    }
+    if (errno != EINPROGRESS) {
+        failConnect(errno);
+        return ConnectProgress::Failed;
+    }
+    return ConnectProgress::InProgress;
+}
+
+bool UplinkClient::finishConnect() {
+    if (socketFd_ < 0) {
+        return false;
+    }
+    int err = 0;
+    socklen_t len = sizeof(err);
+    if (getsockopt(socketFd_, SOL_SOCKET, SO_ERROR, &err, &len) < 0) {
+        err = errno;
+    }
+    if (err != 0) {
+        failConnect(err);
+        return false;
+    }
+    // 连接建立后恢复阻塞模式：发送路径依赖 SO_SNDTIMEO 限定阻塞时间
+    const int flags = fcntl(socketFd_, F_GETFL, 0);
+    if (flags >= 0) {
+        fcntl(socketFd_, F_SETFL, flags & ~O_NONBLOCK);
+    }
+    return completeConnect();
+}
+
+void UplinkClient::abortConnect() {
+    if (!connected_) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        closeSocketLocked();
+    }
+}
+
+bool UplinkClient::openSocket(struct sockaddr_in* serverAddr) {
+    stopFlusher();  // 上一连接写失败后遗留的后台线程
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        closeSocketLocked();  // 未完成的非阻塞连接
+    }
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        clearLanesLocked();
+        stopFlusher_ = false;
+    }
 
-    socketFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    socketFd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
     if (socketFd_ < 0) {
         ErrorStatistics::instance().recordError(ErrorCode::SocketError, "Failed to create socket");
         LOG_ERROR("UplinkClient", "Failed to create socket");
         return false;
     }
 
-    struct sockaddr_in serverAddr;
-    std::memset(&serverAddr, 0, sizeof(serverAddr));
-    serverAddr.sin_family = AF_INET;
-    serverAddr.sin_port = htons(config_.centerPort);
-    if (inet_pton(AF_INET, config_.centerAddress.c_str(), &serverAddr.sin_addr) <= 0) {
+    std::memset(serverAddr, 0, sizeof(*serverAddr));
+    serverAddr->sin_family = AF_INET;
+    serverAddr->sin_port = htons(config_.centerPort);
+    if (inet_pton(AF_INET, config_.centerAddress.c_str(), &serverAddr->sin_addr) <= 0) {
         ErrorStatistics::instance().recordError(ErrorCode::InvalidAddress, 
             "Invalid address: " + config_.centerAddress);
         LOG_ERROR("UplinkClient", "Invalid address: " + config_.centerAddress);
@@ -47,71 +139,559 @@ bool UplinkClient::connect() {
         socketFd_ = -1;
         return false;
     }
+    return true;
+}
 
-    if (::connect(socketFd_, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) < 0) {
-        ErrorStatistics::instance().recordError(ErrorCode::ConnectionFailed,
-            "Failed to connect to " + config_.centerAddress + ":" + std::to_string(config_.centerPort));
-        LOG_ERROR("UplinkClient", "Failed to connect to " + config_.centerAddress + 
-                  ":" + std::to_string(config_.centerPort));
-        close(socketFd_);
-        socketFd_ = -1;
-        return false;
+void UplinkClient::failConnect(int err) {
+    ErrorStatistics::instance().recordError(ErrorCode::ConnectionFailed,
+        "Failed to connect to " + config_.centerAddress + ":" + std::to_string(config_.centerPort));
+    LOG_ERROR("UplinkClient", "Failed to connect to " + config_.centerAddress + 
+              ":" + std::to_string(config_.centerPort) + ": " + std::strerror(err));
+    close(socketFd_);
+    socketFd_ = -1;
+}
+
+bool UplinkClient::completeConnect() {
+    if (config_.sendTimeoutMs > 0) {
+        struct timeval tv;
+        tv.tv_sec = config_.sendTimeoutMs / 1000;
+        tv.tv_usec = (config_.sendTimeoutMs % 1000) * 1000;
+        setsockopt(socketFd_, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    }
+    if (config_.notSentLowatBytes > 0) {
+        // 内核只保留少量未发出的数据，其余积压留在通道中，后到的高优先级消息仍可排到前面
+        const int lowat = static_cast<int>(config_.notSentLowatBytes);
+        setsockopt(socketFd_, IPPROTO_TCP, TCP_NOTSENT_LOWAT, &lowat, sizeof(lowat));
     }
 
+    compressionActive_.store(false, std::memory_order_relaxed);
+    peerDictionaries_.clear();
     connected_ = true;
+    delta_.reset();  // 新连接：对端无状态，下一帧为关键帧
+    activeEncoding_ = TelemetryEncoding::Json;
+    if (config_.telemetryEncoding == TelemetryEncoding::Binary ||
+        config_.telemetryEncoding == TelemetryEncoding::BinaryDelta) {
+        activeEncoding_ = config_.telemetryEncoding;
+    }
+    // 固定编码时仍需 hello 协商压缩；应答中的遥测编码只在 Auto 时采用
+    if (config_.telemetryEncoding == TelemetryEncoding::Auto || codec_) {
+        const TelemetryEncoding negotiated = negotiateEncoding();
+        if (!connected_) {
+            return false;  // hello 发送失败
+        }
+        if (config_.telemetryEncoding == TelemetryEncoding::Auto) {
+            activeEncoding_ = negotiated;
+        }
+    }
+    if (config_.maxCoalesceDelayMs > 0 && !flushScheduler_) {
+        flusher_ = std::thread(&UplinkClient::flusherLoop, this);
+    }
     LOG_INFO("UplinkClient", "Connected to Cluster Center at " + config_.centerAddress + 
-             ":" + std::to_string(config_.centerPort));
+             ":" + std::to_string(config_.centerPort) + " (telemetry encoding: " +
+             (activeEncoding_ == TelemetryEncoding::BinaryDelta ? "binary-delta"
+              : activeEncoding_ == TelemetryEncoding::Binary    ? "binary"
+                                                                : "json") +
+             (compressionActive_.load(std::memory_order_relaxed) ? ", zstd payload compression" : "") + ")");
     return true;
 }
 
+TelemetryEncoding UplinkClient::negotiateEncoding() {
+    nlohmann::json hello;
+    hello["type"] = "hello";
+    switch (config_.telemetryEncoding) {
+        case TelemetryEncoding::Binary:
+            hello["telemetry_encodings"] = {falconmind::sdk::telemetry::kTelemetryBinaryEncoding};
+            break;
+        case TelemetryEncoding::BinaryDelta:
+            hello["telemetry_encodings"] = {falconmind::sdk::telemetry::kTelemetryDeltaEncoding};
+            break;
+        case TelemetryEncoding::Json:
+            hello["telemetry_encodings"] = {"json"};
+            break;
+        case TelemetryEncoding::Auto:
+            hello["telemetry_encodings"] = {falconmind::sdk::telemetry::kTelemetryDeltaEncoding,
+                                            falconmind::sdk::telemetry::kTelemetryBinaryEncoding, "json"};
+            break;
+    }
+    if (codec_) {
+        hello["compression"] = {kPayloadCompressionZstd};
+        hello["zstd_dictionaries"] = codec_->dictionaryIds();
+    }
+    const std::string line = hello.dump() + "\n";
+    if (!enqueue(UplinkPriority::Control, line.data(), line.size(), false, "hello") || !flush()) {
+        return TelemetryEncoding::Json;
+    }
+
+    // 只窥视（MSG_PEEK）接收缓冲区，确认是 HELLO 应答后才消费，其它数据原样留给下行处理
+    const std::string prefix = kHelloReplyPrefix;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(config_.negotiateTimeoutMs);
+    std::array<char, kHelloReplyMaxBytes> peek{};
+    for (;;) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0) {
+            LOG_INFO("UplinkClient", "No HELLO reply from Cluster Center, using JSON telemetry");
+            return TelemetryEncoding::Json;
+        }
+        struct pollfd pfd{socketFd_, POLLIN, 0};
+        if (poll(&pfd, 1, static_cast<int>(remaining)) <= 0) {
+            continue;
+        }
+        const ssize_t n = recv(socketFd_, peek.data(), peek.size(), MSG_PEEK | MSG_DONTWAIT);
+        if (n <= 0) {
+            return TelemetryEncoding::Json;  // 对端关闭或出错，交由后续收发处理
+        }
+        const std::string data(peek.data(), static_cast<std::size_t>(n));
+        const std::size_t k = std::min(data.size(), prefix.size());
+        if (data.compare(0, k, prefix, 0, k) != 0) {
+            return TelemetryEncoding::Json;  // 旧版对端的下行数据
+        }
+        const auto eol = data.find('\n');
+        if (eol == std::string::npos) {
+            if (data.size() >= peek.size()) {
+                return TelemetryEncoding::Json;
+            }
+            continue;  // 应答行尚未完整到达
+        }
+        // 消费应答行
+        std::array<char, kHelloReplyMaxBytes> discard{};
+        if (recv(socketFd_, discard.data(), eol + 1, 0) != static_cast<ssize_t>(eol + 1)) {
+            return TelemetryEncoding::Json;
+        }
+        try {
+            auto reply = nlohmann::json::parse(data.substr(prefix.size(), eol - prefix.size()));
+            if (codec_ && reply.value("compression", std::string()) == kPayloadCompressionZstd) {
+                // 对端应答双方都有的字典；先写好字典列表再发布标志，其它线程的 sendText 只在标志置位后读取
+                auto dicts = reply.find("zstd_dictionaries");
+                if (dicts != reply.end() && dicts->is_array()) {
+                    peerDictionaries_ = dicts->get<std::vector<std::uint32_t>>();
+                }
+                compressionActive_.store(true, std::memory_order_release);
+            }
+            const std::string encoding = reply.value("telemetry_encoding", std::string("json"));
+            if (encoding == falconmind::sdk::telemetry::kTelemetryDeltaEncoding) {
+                return TelemetryEncoding::BinaryDelta;
+            }
+            if (encoding == falconmind::sdk::telemetry::kTelemetryBinaryEncoding) {
+                return TelemetryEncoding::Binary;
+            }
+        } catch (const std::exception& e) {
+            LOG_WARN("UplinkClient", "Malformed HELLO reply: " + std::string(e.what()));
+        }
+        return TelemetryEncoding::Json;
+    }
+}
+
 void UplinkClient::disconnect() {
+    stopFlusher();
+    std::lock_guard<std::mutex> lock(writeMutex_);
     if (connected_ && socketFd_ >= 0) {
-        close(socketFd_);
-        socketFd_ = -1;
-        connected_ = false;
+        drainLocked("buffered messages");  // 尽力写出缓冲中的消息
+        closeSocketLocked();
         LOG_INFO("UplinkClient", "Disconnected");
+    } else {
+        closeSocketLocked();
     }
 }
 
+UplinkStats UplinkClient::stats() const {
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    return stats_;
+}
+
+bool UplinkClient::flush() {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return drainLocked("buffered messages");
+}
+
 bool UplinkClient::sendTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg) {
     if (!connected_ || socketFd_ < 0) {
         return false;
     }
 
-    std::string json = serializeTelemetryToJson(msg);
-    json += "\n";  // 添加换行符作为消息分隔符
+    if (activeEncoding_ == TelemetryEncoding::BinaryDelta) {
+        std::array<std::uint8_t, falconmind::sdk::telemetry::kTelemetryFrameMaxBytes> frame;
+        const std::uint64_t failures = delta_.stats().encodeFailures;
+        const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        const std::size_t size = delta_.encode(msg, nowNs, frame.data(), frame.size());
+        if (size > 0) {
+            return enqueue(UplinkPriority::Telemetry, frame.data(), size, false, "telemetry");
+        }
+        if (delta_.stats().encodeFailures == failures) {
+            return true;  // 没有需要发送的字段组
+        }
+    } else if (activeEncoding_ == TelemetryEncoding::Binary) {
+        std::array<std::uint8_t, falconmind::sdk::telemetry::kTelemetryFrameMaxBytes> frame;
+        const std::size_t size = falconmind::sdk::telemetry::encodeTelemetryFrame(msg, frame.data(), frame.size());
+        if (size > 0) {
+            return enqueue(UplinkPriority::Telemetry, frame.data(), size, false, "telemetry");
+        }
+    }
+    // 字符串超长等无法编码的消息退回 JSON 行（对端各种格式都能解析）
+    const std::string json = serializeTelemetryToJson(msg);
+    return sendText(UplinkPriority::Telemetry, json, "telemetry");
+}
+
+bool UplinkClient::sendMessage(const std::string& message) {
+    return sendMessage(message, UplinkPriority::Event);
+}
+
+bool UplinkClient::sendMessage(const std::string& message, UplinkPriority priority) {
+    if (!connected_ || socketFd_ < 0) {
+        return false;
+    }
+
+    return sendText(priority, message, "message");
+}
 
-    ssize_t sent = send(socketFd_, json.c_str(), json.length(), 0);
-    if (sent < 0) {
-        ErrorStatistics::instance().recordError(ErrorCode::SendFailed, "Failed to send telemetry");
-        LOG_ERROR("UplinkClient", "Failed to send telemetry");
-        disconnect();
+bool UplinkClient::sendReplayedTelemetry(const falconmind::sdk::telemetry::TelemetryMessage& msg) {
+    if (!connected_ || socketFd_ < 0) {
         return false;
     }
+    const std::string json = serializeTelemetryToJson(msg, true);
+    return sendText(UplinkPriority::Bulk, json, "replayed telemetry");
+}
+
+bool UplinkClient::sendText(UplinkPriority priority, const std::string& text, const char* what) {
+    if (codec_ && compressionActive_.load(std::memory_order_acquire)) {
+        std::string frame;
+        if (codec_->compressFrame(text, peerDictionaries_, frame)) {
+            return enqueue(priority, frame.data(), frame.size(), false, what);
+        }
+    }
+    return enqueue(priority, text.data(), text.size(), true, what);
+}
 
+bool UplinkClient::enqueue(UplinkPriority priority, const void* data, std::size_t size, bool newline,
+                           const char* what) {
+    if (!connected_) {
+        return false;
+    }
+    const std::size_t lane = static_cast<std::size_t>(priority);
+    const std::size_t total = size + (newline ? 1 : 0);
+    const bool large = config_.maxCoalesceDelayMs <= 0 || total >= config_.coalesceBytes;
+    bool direct = false;
+    bool write = false;
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        Lane& queue = lanes_[lane];
+        if (lane == kBulkLane && !queue.frames.empty() &&
+            queue.data.size() - queue.head + total > config_.maxBulkQueuedBytes) {
+            ++stats_.bulkRejected;
+            return false;
+        }
+        ++stats_.messages;
+        stats_.bytes += total;
+        ++stats_.laneMessages[lane];
+        stats_.laneBytes[lane] += total;
+        if (large && !writing_) {
+            // 直接写出：与调度出的一批缓冲数据一起一次 sendmsg，消息本身与换行不再拷贝
+            writing_ = true;
+            direct = true;
+        } else {
+            const bool wasEmpty = queuedBytes_ == 0;
+            appendFrameLocked(lane, data, size, newline);
+            bool urgent = large || lane == kControlLane;
+            if (!urgent && queuedBytes_ >= config_.coalesceBytes) {
+                ++stats_.sizeFlushes;
+                urgent = true;
+            }
+            if (urgent) {
+                // 已有线程在写：由它在下一批带走（积压过多时调用方自己等待写出，形成反压）
+                if (writing_ && queuedBytes_ <= config_.maxQueuedBytes) {
+                    ++stats_.combinedWrites;
+                } else {
+                    write = true;
+                }
+            } else if (wasEmpty) {
+                pendingSince_ = std::chrono::steady_clock::now();
+                bufferCv_.notify_one();
+                schedule = static_cast<bool>(flushScheduler_);
+            }
+        }
+    }
+    if (direct) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        return writeDirectLocked(lane, data, size, newline, what);
+    }
+    if (write) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        return drainLocked(what);
+    }
+    if (schedule) {
+        flushScheduler_(config_.maxCoalesceDelayMs);
+    }
     return true;
 }
 
-bool UplinkClient::sendMessage(const std::string& message) {
-    if (!connected_ || socketFd_ < 0) {
+bool UplinkClient::flushDue() {
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        if (queuedBytes_ == 0) {
+            return connected_;  // 已因写满由调用线程写出
+        }
+        ++stats_.timerFlushes;
+    }
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    return drainLocked("buffered messages");
+}
+
+bool UplinkClient::writeDirectLocked(std::size_t lane, const void* data, std::size_t size, bool newline,
+                                     const char* what) {
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        inflight_.clear();
+        takeBatchLocked(inflight_);
+        if (!lanes_[lane].frames.empty()) {
+            // 同通道还有未写出的消息：排到其后，保持通道内顺序
+            appendFrameLocked(lane, data, size, newline);
+            queued = true;
+        }
+    }
+    static const char kNewline = '\n';
+    iovec iov[3];
+    int count = 0;
+    if (!inflight_.empty()) {
+        iov[count].iov_base = inflight_.data();
+        iov[count].iov_len = inflight_.size();
+        ++count;
+    }
+    if (!queued) {
+        iov[count].iov_base = const_cast<void*>(data);
+        iov[count].iov_len = size;
+        ++count;
+        if (newline) {
+            iov[count].iov_base = const_cast<char*>(&kNewline);
+            iov[count].iov_len = 1;
+            ++count;
+        }
+    }
+    if (!writeAllLocked(iov, count, what)) {
+        inflight_.clear();
+        closeSocketLocked();
         return false;
     }
+    return drainLocked(what);  // 写出期间其它线程追加的消息
+}
+
+bool UplinkClient::drainLocked(const char* what) {
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(bufferMutex_);
+            inflight_.clear();
+            takeBatchLocked(inflight_);
+            if (inflight_.empty()) {
+                writing_ = false;  // 此后追加的调用方自己写出
+                return true;
+            }
+            writing_ = true;
+        }
+        iovec iov;
+        iov.iov_base = inflight_.data();
+        iov.iov_len = inflight_.size();
+        if (!writeAllLocked(&iov, 1, what)) {
+            inflight_.clear();
+            closeSocketLocked();
+            return false;
+        }
+    }
+}
+
+void UplinkClient::appendFrameLocked(std::size_t lane, const void* data, std::size_t size, bool newline) {
+    Lane& queue = lanes_[lane];
+    queue.data.append(static_cast<const char*>(data), size);
+    if (newline) {
+        queue.data.push_back('\n');
+    }
+    const std::size_t total = size + (newline ? 1 : 0);
+    queue.frames.push_back(static_cast<std::uint32_t>(total));
+    queuedBytes_ += total;
+}
+
+void UplinkClient::takeBatchLocked(std::string& out) {
+    const std::size_t budget = std::max<std::size_t>(config_.maxBatchBytes, 1);
+    for (;;) {
+        const int next = nextLaneLocked();
+        if (next < 0) {
+            break;
+        }
+        Lane& lane = lanes_[static_cast<std::size_t>(next)];
+        const std::size_t length = lane.frames.front();
+        if (!out.empty() && out.size() + length > budget) {
+            break;
+        }
+        if (next == static_cast<int>(kControlLane) && queuedBytes_ > lane.data.size() - lane.head) {
+            ++stats_.preemptions;
+        }
+        out.append(lane.data, lane.head, length);
+        lane.head += length;
+        lane.frames.pop_front();
+        queuedBytes_ -= length;
+        lane.deficit -= std::min(lane.deficit, length);
+        if (lane.frames.empty()) {
+            lane.data.clear();
+            lane.head = 0;
+            lane.deficit = 0;
+        } else if (lane.head >= kLaneCompactBytes && lane.head * 2 >= lane.data.size()) {
+            lane.data.erase(0, lane.head);
+            lane.head = 0;
+        }
+    }
+}
+
+int UplinkClient::nextLaneLocked() {
+    if (!lanes_[kControlLane].frames.empty()) {
+        return static_cast<int>(kControlLane);
+    }
+    int active = 0;
+    int only = -1;
+    for (std::size_t i = kControlLane + 1; i < kUplinkPriorityCount; ++i) {
+        if (!lanes_[i].frames.empty()) {
+            ++active;
+            only = static_cast<int>(i);
+        }
+    }
+    if (active <= 1) {
+        return only;  // 只有一个通道有数据时无需轮询
+    }
+    // DRR：每轮到一个通道补充 laneQuantumBytes × 权重的额度，额度够写出队首消息时选中，否则轮到下一个通道
+    const std::size_t quantum = std::max<std::size_t>(config_.laneQuantumBytes, 1);
+    for (;;) {
+        Lane& lane = lanes_[rrLane_];
+        if (lane.frames.empty()) {
+            lane.deficit = 0;
+        } else if (lane.deficit >= lane.frames.front()) {
+            return static_cast<int>(rrLane_);
+        }
+        rrLane_ = rrLane_ % (kUplinkPriorityCount - 1) + 1;
+        Lane& next = lanes_[rrLane_];
+        if (!next.frames.empty()) {
+            next.deficit += quantum * static_cast<std::size_t>(std::max(config_.laneWeights[rrLane_], 1));
+        }
+    }
+}
 
-    std::string msg = message;
-    msg += "\n";  // 添加换行符作为消息分隔符
+void UplinkClient::clearLanesLocked() {
+    for (Lane& lane : lanes_) {
+        lane.data.clear();
+        lane.head = 0;
+        lane.frames.clear();
+        lane.deficit = 0;
+    }
+    queuedBytes_ = 0;
+    writing_ = false;
+}
 
-    ssize_t sent = send(socketFd_, msg.c_str(), msg.length(), 0);
-    if (sent < 0) {
-        ErrorStatistics::instance().recordError(ErrorCode::SendFailed, "Failed to send message");
-        LOG_ERROR("UplinkClient", "Failed to send message");
-        disconnect();
+bool UplinkClient::writeAllLocked(iovec* iov, int count, const char* what) {
+    if (socketFd_ < 0) {
         return false;
     }
+    std::size_t remaining = 0;
+    for (int i = 0; i < count; ++i) {
+        remaining += iov[i].iov_len;
+    }
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = static_cast<std::size_t>(count);
 
+    std::uint64_t writes = 0;
+    std::uint64_t partial = 0;
+    int error = 0;
+    while (remaining > 0) {
+        const ssize_t n = sendmsg(socketFd_, &msg, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error = errno;
+            break;
+        }
+        ++writes;
+        std::size_t written = static_cast<std::size_t>(n);
+        remaining -= written;
+        if (remaining == 0) {
+            break;
+        }
+        // 部分写入：跳过已写出的 iovec，调整当前 iovec 的起点后继续
+        ++partial;
+        while (written > 0 && written >= msg.msg_iov->iov_len) {
+            written -= msg.msg_iov->iov_len;
+            ++msg.msg_iov;
+            --msg.msg_iovlen;
+        }
+        msg.msg_iov->iov_base = static_cast<char*>(msg.msg_iov->iov_base) + written;
+        msg.msg_iov->iov_len -= written;
+    }
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        stats_.writes += writes;
+        stats_.partialWrites += partial;
+    }
+    if (error != 0) {
+        const std::string reason = (error == EAGAIN || error == EWOULDBLOCK) ? " (send timeout)"
+                                                                              : std::string(" (") + std::strerror(error) + ")";
+        ErrorStatistics::instance().recordError(ErrorCode::SendFailed, std::string("Failed to send ") + what + reason);
+        LOG_ERROR("UplinkClient", std::string("Failed to send ") + what + reason);
+        closeSocketLocked();
+        return false;
+    }
     return true;
 }
 
-std::string UplinkClient::serializeTelemetryToJson(const falconmind::sdk::telemetry::TelemetryMessage& msg) {
+void UplinkClient::closeSocketLocked() {
+    if (socketFd_ >= 0) {
+        close(socketFd_);
+        socketFd_ = -1;
+    }
+    connected_ = false;
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    clearLanesLocked();
+    bufferCv_.notify_all();
+}
+
+void UplinkClient::flusherLoop() {
+    const auto delay = std::chrono::milliseconds(config_.maxCoalesceDelayMs);
+    std::unique_lock<std::mutex> lock(bufferMutex_);
+    while (!stopFlusher_ && connected_) {
+        if (queuedBytes_ == 0) {
+            bufferCv_.wait(lock);
+            continue;
+        }
+        const auto deadline = pendingSince_ + delay;
+        if (std::chrono::steady_clock::now() < deadline) {
+            bufferCv_.wait_until(lock, deadline);
+            continue;  // 重新检查：可能已被写满时的调用线程写出
+        }
+        ++stats_.timerFlushes;
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> writeLock(writeMutex_);
+            drainLocked("buffered messages");
+        }
+        lock.lock();
+    }
+}
+
+void UplinkClient::stopFlusher() {
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        stopFlusher_ = true;
+    }
+    bufferCv_.notify_all();
+    if (flusher_.joinable()) {
+        if (flusher_.get_id() == std::this_thread::get_id()) {
+            flusher_.detach();
+        } else {
+            flusher_.join();
+        }
+    }
+}
+
+std::string UplinkClient::serializeTelemetryToJson(const falconmind::sdk::telemetry::TelemetryMessage& msg, bool replay) {
     try {
         // 使用 nlohmann/json 进行序列化
         nlohmann::json json;
@@ -145,6 +725,9 @@ std::string UplinkClient::serializeTelemetryToJson(const falconmind::sdk::teleme
         // 链路质量和飞行模式
         json["link_quality"] = msg.linkQuality;
         json["flight_mode"] = msg.flightMode;
+        if (replay) {
+            json["replay"] = true;
+        }
 
         // 使用 dump() 生成紧凑的单行 JSON（无换行符）
         return json.dump();
@@ -0,0 +1,146 @@
+// NodeAgent - ClockSync offset / RTT estimation tests
+#include <gtest/gtest.h>
+#include "nodeagent/ClockSync.h"
+
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <string>
+
+using namespace nodeagent;
+
+void registerClockSyncTests() {
+    // Tests are registered via TEST macros
+}
+
+namespace {
+
+constexpr std::int64_t kMs = 1000000;
+
+// 模拟一次交换：Cluster Center 时钟 = 本地 + centerOffset；上下行时延与对端处理时间分别给定
+struct Exchange {
+    std::int64_t localNs;    // 本地 system_clock 发送时刻
+    std::int64_t steadyNs;   // 对应的单调时钟
+    std::int64_t upNs;
+    std::int64_t downNs;
+    std::int64_t processNs{1 * kMs};
+};
+
+bool exchange(ClockSync& sync, std::int64_t centerOffset, const Exchange& e, std::string* probeOut = nullptr) {
+    const std::string probe = sync.makeProbe(e.localNs, e.steadyNs);
+    if (probeOut) *probeOut = probe;
+    const auto json = nlohmann::json::parse(probe);
+    const std::int64_t t2 = e.localNs + e.upNs + centerOffset;
+    const std::int64_t t3 = t2 + e.processNs;
+    const std::string reply = "tsync:" + std::to_string(json["seq"].get<std::uint32_t>()) + ":" +
+                              std::to_string(t2) + ":" + std::to_string(t3);
+    return sync.handleReply(reply, e.steadyNs + e.upNs + e.processNs + e.downNs);
+}
+
+} // namespace
+
+TEST(ClockSyncTest, SymmetricExchangeRecoversOffsetAndRtt) {
+    ClockSync sync;
+    sync.restart(0);
+    ASSERT_TRUE(sync.probeDue(0));
+    EXPECT_FALSE(sync.synced());
+    EXPECT_EQ(sync.toCenterTime(123), 123);
+
+    const std::int64_t offset = 2500 * kMs;  // Cluster Center 快 2.5 s
+    ASSERT_TRUE(exchange(sync, offset, {1'000'000'000'000, 10 * kMs, 40 * kMs, 40 * kMs}));
+    const ClockSyncStats stats = sync.stats();
+    EXPECT_TRUE(stats.synced);
+    EXPECT_EQ(stats.offsetNs, offset);
+    EXPECT_EQ(stats.rttNs, 80 * kMs);  // 不含对端处理时间
+    EXPECT_EQ(stats.uplinkLatencyNs, 40 * kMs);
+    EXPECT_EQ(stats.downlinkLatencyNs, 40 * kMs);
+    EXPECT_EQ(sync.toCenterTime(5 * kMs), 5 * kMs + offset);
+}
+
+TEST(ClockSyncTest, MinimumRttSampleWinsOverQueuedSamples) {
+    ClockSync sync;
+    sync.restart(0);
+    const std::int64_t offset = -700 * kMs;
+    // 上行排队造成的非对称样本：单独使用时偏移误差为 (up - down) / 2
+    ASSERT_TRUE(exchange(sync, offset, {1'000'000'000'000, 0, 300 * kMs, 20 * kMs}));
+    EXPECT_EQ(sync.stats().offsetNs, offset + 140 * kMs);
+    ASSERT_TRUE(exchange(sync, offset, {1'000'500'000'000, 500 * kMs, 20 * kMs, 20 * kMs}));
+    ASSERT_TRUE(exchange(sync, offset, {1'001'000'000'000, 1000 * kMs, 250 * kMs, 30 * kMs}));
+
+    const ClockSyncStats stats = sync.stats();
+    EXPECT_EQ(stats.samples, 3u);
+    EXPECT_EQ(stats.offsetNs, offset);
+    EXPECT_EQ(stats.rttNs, 40 * kMs);
+    EXPECT_EQ(stats.lastRttNs, 280 * kMs);
+    // 以选定偏移计算的最近一次交换的单向时延
+    EXPECT_EQ(stats.uplinkLatencyNs, 250 * kMs);
+    EXPECT_EQ(stats.downlinkLatencyNs, 30 * kMs);
+}
+
+TEST(ClockSyncTest, RejectsUnknownMalformedAndSlowReplies) {
+    ClockSyncConfig config;
+    config.maxRttMs = 500;
+    ClockSync sync(config);
+    sync.restart(0);
+
+    EXPECT_FALSE(sync.handleReply("msg-42", 0));  // 普通 ACK
+    EXPECT_TRUE(sync.handleReply("tsync:99:1:2", 0));  // 无对应探测
+    EXPECT_TRUE(sync.handleReply("tsync:abc", 0));
+    EXPECT_TRUE(exchange(sync, 0, {1'000'000'000'000, 0, 400 * kMs, 400 * kMs}));  // RTT 超过上限
+    EXPECT_FALSE(sync.synced());
+    EXPECT_EQ(sync.stats().rejected, 3u);
+
+    // 重复应答只计一次有效样本
+    const std::string probe = sync.makeProbe(2'000'000'000'000, kMs);
+    const auto seq = nlohmann::json::parse(probe)["seq"].get<std::uint32_t>();
+    const std::string reply = "tsync:" + std::to_string(seq) + ":2000000010000000:2000000010000000";
+    EXPECT_TRUE(sync.handleReply(reply, 21 * kMs));
+    EXPECT_TRUE(sync.handleReply(reply, 22 * kMs));
+    EXPECT_EQ(sync.stats().samples, 1u);
+    EXPECT_EQ(sync.stats().rejected, 4u);
+}
+
+TEST(ClockSyncTest, BurstThenSteadyScheduleAndLostProbes) {
+    ClockSyncConfig config;
+    config.burstProbes = 3;
+    config.burstIntervalMs = 100;
+    config.probeIntervalMs = 5000;
+    config.maxRttMs = 1000;
+    ClockSync sync(config);
+    sync.restart(0);
+
+    std::int64_t now = 0;
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(sync.probeDue(now));
+        sync.makeProbe(now, now);
+        now += 100 * kMs;
+    }
+    // 连续探测结束后按稳定间隔
+    EXPECT_FALSE(sync.probeDue(now));
+    EXPECT_FALSE(sync.probeDue(4000 * kMs));
+    EXPECT_TRUE(sync.probeDue(5200 * kMs));
+    const ClockSyncStats stats = sync.stats();
+    EXPECT_EQ(stats.probesSent, 3u);
+    EXPECT_EQ(stats.lost, 3u);  // 均未应答，超过 maxRttMs 后计为丢失
+}
+
+TEST(ClockSyncTest, ProbeCarriesCurrentEstimate) {
+    ClockSync sync;
+    sync.restart(0);
+    std::string first;
+    ASSERT_TRUE(exchange(sync, 50 * kMs, {1'000'000'000'000, 0, 10 * kMs, 10 * kMs}, &first));
+    const auto before = nlohmann::json::parse(first);
+    EXPECT_EQ(before["type"], "time_sync");
+    EXPECT_EQ(before["t1"].get<std::int64_t>(), 1'000'000'000'000);
+    EXPECT_FALSE(before.contains("offset_ns"));
+
+    const auto after = nlohmann::json::parse(sync.makeProbe(1'001'000'000'000, 1000 * kMs));
+    EXPECT_EQ(after["offset_ns"].get<std::int64_t>(), 50 * kMs);
+    EXPECT_EQ(after["rtt_ns"].get<std::int64_t>(), 20 * kMs);
+    EXPECT_EQ(after["uplink_latency_ns"].get<std::int64_t>(), 10 * kMs);
+
+    // 新连接：保留偏移，丢弃未应答的探测
+    sync.restart(2000 * kMs);
+    EXPECT_TRUE(sync.synced());
+    EXPECT_TRUE(sync.handleReply("tsync:" + std::to_string(after["seq"].get<std::uint32_t>()) + ":1:1", 2000 * kMs));
+    EXPECT_EQ(sync.stats().samples, 1u);
+}
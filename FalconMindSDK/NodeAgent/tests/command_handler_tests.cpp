@@ -6,6 +6,12 @@
 #include "falconmind/sdk/flight/FlightConnectionService.h"
 #include "falconmind/sdk/flight/FlightTypes.h"
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 #include <memory>
 #include <thread>
 #include <chrono>
@@ -114,3 +120,96 @@ TEST(CommandHandlerTest, HandleUnknownCommandType) {
     // Should fail for unknown command type
     EXPECT_FALSE(result);
 }
+
+TEST(CommandHandlerTest, ParseCommandExtractsTopLevelFieldsOnly) {
+    FlightCommand cmd;
+    std::string requestId;
+    ASSERT_TRUE(CommandHandler::parseCommand(
+        R"({"meta":{"type":"LAND","targetAlt":1,"requestId":"inner"},"type":"takeoff","targetAlt":12.5,)"
+        R"("requestId":"r-1","extra":[1,{"a":"b"}]})",
+        cmd, requestId));
+    EXPECT_EQ(cmd.type, FlightCommandType::Takeoff);
+    EXPECT_DOUBLE_EQ(cmd.targetAlt, 12.5);
+    EXPECT_EQ(requestId, "r-1");
+
+    ASSERT_TRUE(CommandHandler::parseCommand(R"({"type":"Return_To_Launch","targetAlt":30})", cmd, requestId));
+    EXPECT_EQ(cmd.type, FlightCommandType::ReturnToLaunch);
+    EXPECT_DOUBLE_EQ(cmd.targetAlt, 0.0);  // 只有起飞使用目标高度
+    EXPECT_TRUE(requestId.empty());
+
+    EXPECT_FALSE(CommandHandler::parseCommand(R"({"type":7})", cmd, requestId));
+    EXPECT_FALSE(CommandHandler::parseCommand(R"({"type":"ARM")", cmd, requestId));
+}
+
+TEST(CommandHandlerTest, RequestIdWindowEvictsOldestAndExpires) {
+    RequestIdWindow window(4, 1000);
+    for (int i = 0; i < 4; ++i) {
+        window.insert("req-" + std::to_string(i), i);
+    }
+    EXPECT_EQ(window.size(), 4u);
+    EXPECT_TRUE(window.contains("req-0", 10));
+    window.insert("req-4", 10);  // 满：淘汰最早的 req-0
+    EXPECT_EQ(window.size(), 4u);
+    EXPECT_FALSE(window.contains("req-0", 10));
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_TRUE(window.contains("req-" + std::to_string(i), 10)) << i;
+    }
+    EXPECT_FALSE(window.contains("req-1", 1002));  // 过期
+    EXPECT_TRUE(window.contains("req-4", 1002));
+
+    // 持续淘汰后探测链仍完整
+    RequestIdWindow churn(64, 1000000);
+    for (int i = 0; i < 5000; ++i) {
+        churn.insert("id" + std::to_string(i), i);
+    }
+    for (int i = 5000 - 64; i < 5000; ++i) {
+        ASSERT_TRUE(churn.contains("id" + std::to_string(i), 5000)) << i;
+    }
+    EXPECT_FALSE(churn.contains("id" + std::to_string(5000 - 65), 5000));
+}
+
+TEST(CommandHandlerTest, RetransmittedCommandExecutesOnce) {
+    // 本地 UDP socket 扮演飞控，统计收到的 COMMAND_LONG 帧
+    const int autopilot = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(autopilot, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(bind(autopilot, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    socklen_t len = sizeof(addr);
+    getsockname(autopilot, reinterpret_cast<sockaddr*>(&addr), &len);
+
+    auto service = std::make_shared<FlightConnectionService>();
+    FlightConnectionConfig cfg;
+    cfg.remoteAddress = "127.0.0.1";
+    cfg.remotePort = ntohs(addr.sin_port);
+    ASSERT_TRUE(service->connect(cfg));
+    CommandHandler handler;
+    handler.setFlightConnectionService(service);
+
+    DownlinkMessage msg;
+    msg.type = DownlinkMessageType::Command;
+    msg.payload = R"({"type":"RTL","uavId":"uav0","requestId":"cmd-42"})";
+    EXPECT_TRUE(handler.handleCommand(msg));
+    EXPECT_TRUE(handler.handleCommand(msg));  // Cluster Center 重传
+    msg.payload = R"({"type":"LAND","uavId":"uav0"})";  // 无 requestId：不去重
+    EXPECT_TRUE(handler.handleCommand(msg));
+    EXPECT_TRUE(handler.handleCommand(msg));
+
+    int frames = 0;
+    char buf[512];
+    pollfd pfd{autopilot, POLLIN, 0};
+    while (poll(&pfd, 1, 100) > 0 && recv(autopilot, buf, sizeof(buf), 0) > 0) {
+        ++frames;
+    }
+    EXPECT_EQ(frames, 3);
+
+    const CommandHandlerStats stats = handler.stats();
+    EXPECT_EQ(stats.received, 4u);
+    EXPECT_EQ(stats.executed, 3u);
+    EXPECT_EQ(stats.duplicates, 1u);
+    EXPECT_GE(stats.maxLatencyUs, stats.lastLatencyUs);
+    EXPECT_GE(stats.totalLatencyUs, stats.maxLatencyUs);
+    service->disconnect();
+    close(autopilot);
+}
@@ -0,0 +1,264 @@
+// NodeAgent - Chunked definition transfer and content-addressed cache tests
+#include <gtest/gtest.h>
+#include "nodeagent/DefinitionTransfer.h"
+#include "nodeagent/Sha256.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace nodeagent;
+
+void registerDefinitionTransferTests() {
+    // Tests are registered via TEST macros
+}
+
+namespace {
+
+class TempDir {
+public:
+    TempDir() {
+        char tmpl[] = "/tmp/nodeagent_xfer_XXXXXX";
+        const char* p = mkdtemp(tmpl);
+        path_ = p ? p : "";
+    }
+    ~TempDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+std::string base64(const std::string& in) {
+    static const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (std::size_t i = 0; i < in.size(); i += 3) {
+        std::uint32_t v = static_cast<std::uint8_t>(in[i]) << 16;
+        if (i + 1 < in.size()) v |= static_cast<std::uint8_t>(in[i + 1]) << 8;
+        if (i + 2 < in.size()) v |= static_cast<std::uint8_t>(in[i + 2]);
+        out.push_back(alphabet[(v >> 18) & 0x3F]);
+        out.push_back(alphabet[(v >> 12) & 0x3F]);
+        out.push_back(i + 1 < in.size() ? alphabet[(v >> 6) & 0x3F] : '=');
+        out.push_back(i + 2 < in.size() ? alphabet[v & 0x3F] : '=');
+    }
+    return out;
+}
+
+DownlinkMessage xfer(const std::string& json) {
+    DownlinkMessage msg;
+    msg.type = DownlinkMessageType::Transfer;
+    msg.uavId = "uav1";
+    msg.payload = json;
+    msg.requestId = "req-1";
+    return msg;
+}
+
+// 扮演 Cluster Center：按定义内容生成 begin / chunk 消息
+struct Sender {
+    std::string content;
+    std::size_t chunkSize;
+    std::string sha;
+
+    Sender(std::string c, std::size_t cs) : content(std::move(c)), chunkSize(cs), sha(Sha256::hex(content)) {}
+
+    std::size_t chunks() const { return (content.size() + chunkSize - 1) / chunkSize; }
+
+    DownlinkMessage begin(const std::string& kind = "flow") const {
+        return xfer("{\"op\":\"begin\",\"sha256\":\"" + sha + "\",\"kind\":\"" + kind + "\",\"size\":" +
+                    std::to_string(content.size()) + ",\"chunk_size\":" + std::to_string(chunkSize) + "}");
+    }
+    DownlinkMessage chunk(std::size_t index, bool corrupt = false) const {
+        std::string data = content.substr(index * chunkSize, chunkSize);
+        const std::string chunkSha = Sha256::hex(data);
+        if (corrupt) data[0] ^= 0x55;
+        return xfer("{\"op\":\"chunk\",\"sha256\":\"" + sha + "\",\"index\":" + std::to_string(index) +
+                    ",\"chunk_sha256\":\"" + chunkSha + "\",\"data\":\"" + base64(data) + "\"}");
+    }
+};
+
+struct Harness {
+    explicit Harness(const std::string& dir, std::size_t maxCacheBytes = 1u << 20) {
+        DefinitionTransferConfig cfg;
+        cfg.directory = dir;
+        cfg.maxCacheBytes = maxCacheBytes;
+        transfer = DefinitionTransfer::open(cfg);
+        transfer->setStatusCallback([this](const DefinitionTransferStatus& s) { statuses.push_back(s); });
+        transfer->setDeployCallback([this](DefinitionKind kind, const std::string& sha, std::string content,
+                                           const DownlinkMessage& request) {
+            EXPECT_EQ(request.requestId, "req-1");
+            deployed.push_back({kind, sha, std::move(content)});
+            return true;
+        });
+    }
+
+    struct Deployed {
+        DefinitionKind kind;
+        std::string sha;
+        std::string content;
+    };
+    std::unique_ptr<DefinitionTransfer> transfer;
+    std::vector<DefinitionTransferStatus> statuses;
+    std::vector<Deployed> deployed;
+};
+
+std::string sampleFlow(std::size_t bytes) {
+    std::string nodes;
+    while (nodes.size() < bytes) {
+        nodes += "{\"id\":\"n" + std::to_string(nodes.size()) + "\",\"type\":\"waypoint\"},";
+    }
+    nodes.pop_back();
+    return "{\"flow_id\":\"f1\",\"nodes\":[" + nodes + "]}";
+}
+
+} // namespace
+
+TEST(Sha256Test, KnownVectors) {
+    EXPECT_EQ(Sha256::hex(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(Sha256::hex("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(Sha256::hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    // 增量输入跨越块边界
+    Sha256 sha;
+    const std::string block(1000, 'a');
+    for (int i = 0; i < 1000; ++i) {
+        sha.update(block.data(), i % 2 ? block.size() : 7);
+        if (i % 2 == 0) sha.update(block.data() + 7, block.size() - 7);
+    }
+    EXPECT_EQ(Sha256::toHex(sha.finish()), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST(DefinitionTransferTest, ChunkedTransferVerifiesAndDeploys) {
+    TempDir dir;
+    Harness h(dir.path());
+    const Sender sender(sampleFlow(10000), 1024);
+
+    ASSERT_TRUE(h.transfer->handleMessage(sender.begin()));
+    ASSERT_EQ(h.statuses.size(), 1u);
+    EXPECT_EQ(h.statuses[0].state, "need");
+    EXPECT_EQ(h.statuses[0].chunks, sender.chunks());
+    EXPECT_EQ(h.statuses[0].missing.size(), sender.chunks());
+
+    // 乱序到达，中间夹一个重复分块
+    for (std::size_t i = sender.chunks(); i-- > 0;) {
+        ASSERT_TRUE(h.transfer->handleMessage(sender.chunk(i)));
+        if (i == 3) ASSERT_TRUE(h.transfer->handleMessage(sender.chunk(i)));
+    }
+    ASSERT_EQ(h.statuses.size(), 2u);  // 中间分块不逐块回复
+    EXPECT_EQ(h.statuses[1].state, "complete");
+    EXPECT_TRUE(h.statuses[1].deployed);
+    ASSERT_EQ(h.deployed.size(), 1u);
+    EXPECT_EQ(h.deployed[0].content, sender.content);
+    EXPECT_EQ(h.deployed[0].sha, sender.sha);
+    EXPECT_TRUE(h.transfer->hasObject(sender.sha));
+    EXPECT_FALSE(std::filesystem::exists(dir.path() + "/partial/" + sender.sha + ".part"));
+    EXPECT_EQ(h.transfer->stats().chunksReceived, sender.chunks());
+}
+
+TEST(DefinitionTransferTest, RepeatedBeginIsACacheHit) {
+    TempDir dir;
+    Harness h(dir.path());
+    const Sender sender(sampleFlow(3000), 512);
+    h.transfer->handleMessage(sender.begin("mission"));
+    for (std::size_t i = 0; i < sender.chunks(); ++i) {
+        h.transfer->handleMessage(sender.chunk(i));
+    }
+    ASSERT_EQ(h.deployed.size(), 1u);
+    EXPECT_EQ(h.deployed[0].kind, DefinitionKind::Mission);
+
+    // 重新下发同一定义：不再需要任何分块
+    ASSERT_TRUE(h.transfer->handleMessage(sender.begin("mission")));
+    EXPECT_EQ(h.statuses.back().state, "cached");
+    ASSERT_EQ(h.deployed.size(), 2u);
+    EXPECT_EQ(h.deployed[1].content, sender.content);
+    EXPECT_EQ(h.transfer->stats().cacheHits, 1u);
+    EXPECT_EQ(h.transfer->stats().chunksReceived, sender.chunks());
+}
+
+TEST(DefinitionTransferTest, ResumesPartialTransferAfterRestart) {
+    TempDir dir;
+    const Sender sender(sampleFlow(8000), 1000);
+    {
+        Harness h(dir.path());
+        h.transfer->handleMessage(sender.begin());
+        for (std::size_t i = 0; i < sender.chunks(); i += 2) {
+            h.transfer->handleMessage(sender.chunk(i));
+        }
+        EXPECT_TRUE(h.deployed.empty());
+    }
+
+    Harness h(dir.path());
+    ASSERT_TRUE(h.transfer->handleMessage(sender.begin()));
+    ASSERT_EQ(h.statuses.size(), 1u);
+    EXPECT_EQ(h.statuses[0].state, "need");
+    EXPECT_EQ(h.statuses[0].received, (sender.chunks() + 1) / 2);
+    for (std::uint32_t index : h.statuses[0].missing) {
+        EXPECT_EQ(index % 2, 1u);
+    }
+    EXPECT_EQ(h.transfer->stats().resumed, 1u);
+
+    const std::vector<std::uint32_t> missing = h.statuses[0].missing;
+    for (std::uint32_t index : missing) {
+        h.transfer->handleMessage(sender.chunk(index));
+    }
+    EXPECT_EQ(h.statuses.back().state, "complete");
+    ASSERT_EQ(h.deployed.size(), 1u);
+    EXPECT_EQ(h.deployed[0].content, sender.content);
+}
+
+TEST(DefinitionTransferTest, RejectsCorruptChunksAndHashMismatch) {
+    TempDir dir;
+    Harness h(dir.path());
+    const Sender sender(sampleFlow(2000), 1024);
+    h.transfer->handleMessage(sender.begin());
+
+    // 分块哈希不符：拒绝并回复仍缺少的分块
+    h.transfer->handleMessage(sender.chunk(0, true));
+    EXPECT_EQ(h.statuses.back().state, "need");
+    EXPECT_EQ(h.statuses.back().missing.front(), 0u);
+    EXPECT_EQ(h.transfer->stats().chunksRejected, 1u);
+
+    // 分块各自正确但整体与声明的 sha256 不符
+    std::string other = sender.content;
+    other[10] = 'X';
+    Sender actual(other, 1024);
+    actual.sha = sender.sha;
+    for (std::size_t i = 0; i < actual.chunks(); ++i) {
+        h.transfer->handleMessage(actual.chunk(i));
+    }
+    EXPECT_EQ(h.statuses.back().state, "failed");
+    EXPECT_TRUE(h.deployed.empty());
+    EXPECT_FALSE(h.transfer->hasObject(sender.sha));
+    EXPECT_EQ(h.transfer->stats().failed, 1u);
+
+    // 未 begin 的分块要求重新 begin
+    h.transfer->handleMessage(sender.chunk(0));
+    EXPECT_EQ(h.statuses.back().state, "failed");
+    EXPECT_FALSE(h.transfer->handleMessage(xfer("{\"op\":\"begin\",\"sha256\":\"../../etc\"}")));
+}
+
+TEST(DefinitionTransferTest, EvictsLeastRecentlyUsedObjects) {
+    TempDir dir;
+    Harness h(dir.path(), 2500);
+    std::vector<Sender> senders;
+    for (int i = 0; i < 3; ++i) {
+        senders.emplace_back("{\"flow_id\":\"f" + std::to_string(i) + "\",\"pad\":\"" + std::string(1000, 'a' + i) + "\"}",
+                             4096);
+    }
+    for (int i = 0; i < 3; ++i) {
+        h.transfer->handleMessage(senders[i].begin());
+        h.transfer->handleMessage(senders[i].chunk(0));
+        if (i == 1) {
+            h.transfer->handleMessage(senders[0].begin());  // 命中缓存刷新 senders[0] 的使用时间
+        }
+    }
+    EXPECT_TRUE(h.transfer->hasObject(senders[0].sha));
+    EXPECT_FALSE(h.transfer->hasObject(senders[1].sha));
+    EXPECT_TRUE(h.transfer->hasObject(senders[2].sha));
+    EXPECT_EQ(h.transfer->stats().evicted, 1u);
+}
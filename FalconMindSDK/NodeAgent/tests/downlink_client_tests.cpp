@@ -0,0 +1,251 @@
+// NodeAgent - DownlinkClient framing tests
+#include <gtest/gtest.h>
+#include "nodeagent/DownlinkClient.h"
+#include "nodeagent/PayloadCompression.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace nodeagent;
+
+void registerDownlinkClientTests() {
+    // Tests are registered via TEST macros
+}
+
+namespace {
+
+// socketpair 一端交给 DownlinkClient，另一端扮演 Cluster Center
+class DownlinkFixture {
+public:
+    explicit DownlinkFixture(DownlinkClient::Config config = {}) : client(config) {
+        socketpair(AF_UNIX, SOCK_STREAM, 0, fds_);
+        client.connect(fds_[0]);
+        client.setMessageHandler([this](const DownlinkMessage& msg) { messages.push_back(msg); });
+        client.setAckHandler([this](const std::string& id) { acks.push_back(id); });
+    }
+    ~DownlinkFixture() {
+        client.disconnect();
+        close(fds_[0]);
+        if (fds_[1] >= 0) close(fds_[1]);
+    }
+
+    // 发送方线程写入（可能超过 socket 缓冲），本线程读取直到对端写完且数据全部消费
+    bool deliver(const std::string& bytes) {
+        std::thread writer([&]() {
+            std::size_t offset = 0;
+            while (offset < bytes.size()) {
+                ssize_t n = send(fds_[1], bytes.data() + offset, bytes.size() - offset, 0);
+                if (n <= 0) break;
+                offset += static_cast<std::size_t>(n);
+            }
+        });
+        bool ok = true;
+        for (;;) {
+            pollfd pfd{fds_[0], POLLIN, 0};
+            if (poll(&pfd, 1, 50) <= 0) break;
+            if (!client.readAvailable()) {
+                ok = false;
+                break;
+            }
+        }
+        writer.join();
+        return ok;
+    }
+    void closePeer() {
+        close(fds_[1]);
+        fds_[1] = -1;
+    }
+
+    DownlinkClient client;
+    std::vector<DownlinkMessage> messages;
+    std::vector<std::string> acks;
+
+private:
+    int fds_[2]{-1, -1};
+};
+
+std::string framed(const std::string& message) {
+    std::string frame(1, static_cast<char>(kDownlinkFrameMagic));
+    const auto length = static_cast<std::uint32_t>(message.size());
+    for (int i = 0; i < 4; ++i) {
+        frame.push_back(static_cast<char>((length >> (8 * i)) & 0xFF));
+    }
+    return frame + message;
+}
+
+} // namespace
+
+TEST(DownlinkClientTest, DispatchesCommandMissionAndFlowLines) {
+    DownlinkFixture f;
+    ASSERT_TRUE(f.deliver("CMD:{\"uavId\":\"uav2\",\"requestId\":\"c1\"}\n"
+                          "MISSION:{\"requestId\":\"m1\",\"uavId\":\"uav3\"}\r\n"
+                          "FLOW:{\"flow_id\":\"f1\",\"nodes\":[{\"requestId\":\"inner\"}],\"requestId\":\"f1-req\"}\n"
+                          "ACK:msg-1\r\n"
+                          "IGNORED:xyz\n"));
+    ASSERT_EQ(f.messages.size(), 3u);
+    EXPECT_EQ(f.messages[0].type, DownlinkMessageType::Command);
+    EXPECT_EQ(f.messages[0].uavId, "uav2");
+    EXPECT_EQ(f.messages[0].requestId, "c1");
+    EXPECT_EQ(f.messages[1].type, DownlinkMessageType::Mission);
+    EXPECT_EQ(f.messages[1].uavId, "uav3");
+    EXPECT_EQ(f.messages[1].payload, "{\"requestId\":\"m1\",\"uavId\":\"uav3\"}");
+    EXPECT_EQ(f.messages[2].type, DownlinkMessageType::Flow);
+    EXPECT_EQ(f.messages[2].requestId, "f1-req");  // 只取顶层字段
+    EXPECT_EQ(f.messages[2].uavId, "uav0");
+    ASSERT_EQ(f.acks.size(), 1u);
+    EXPECT_EQ(f.acks[0], "msg-1");
+}
+
+TEST(DownlinkClientTest, MalformedJsonUsesDefaults) {
+    DownlinkFixture f;
+    ASSERT_TRUE(f.deliver("CMD:{not json\n"));
+    ASSERT_EQ(f.messages.size(), 1u);
+    EXPECT_EQ(f.messages[0].uavId, "uav0");
+    EXPECT_EQ(f.messages[0].requestId.rfind("req_", 0), 0u);
+    EXPECT_EQ(f.messages[0].payload, "{not json");
+}
+
+TEST(DownlinkClientTest, BurstOfSmallMessages) {
+    DownlinkFixture f;
+    std::string burst;
+    for (int i = 0; i < 20000; ++i) {
+        burst += "ACK:m" + std::to_string(i) + "\n";
+    }
+    ASSERT_TRUE(f.deliver(burst));
+    ASSERT_EQ(f.acks.size(), 20000u);
+    EXPECT_EQ(f.acks.front(), "m0");
+    EXPECT_EQ(f.acks.back(), "m19999");
+}
+
+TEST(DownlinkClientTest, LargeFlowLineArrivingInChunks) {
+    DownlinkFixture f;
+    std::string nodes;
+    while (nodes.size() < 600 * 1024) {
+        nodes += "{\"id\":\"n" + std::to_string(nodes.size()) + "\",\"type\":\"waypoint\"},";
+    }
+    nodes.pop_back();
+    const std::string payload = "{\"uavId\":\"uav1\",\"requestId\":\"big\",\"nodes\":[" + nodes + "]}";
+
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(f.deliver("FLOW:" + payload + "\nACK:after\n"));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_EQ(f.messages.size(), 1u);
+    EXPECT_EQ(f.messages[0].type, DownlinkMessageType::Flow);
+    EXPECT_EQ(f.messages[0].requestId, "big");
+    EXPECT_EQ(f.messages[0].payload.size(), payload.size());
+    ASSERT_EQ(f.acks.size(), 1u);
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+}
+
+TEST(DownlinkClientTest, LengthPrefixedFramesMixWithLines) {
+    DownlinkFixture f;
+    const std::string flow = "FLOW:{\"requestId\":\"framed\",\n  \"nodes\": []\n}";  // 载荷含换行
+    std::string stream = "CMD:{\"requestId\":\"a\"}\n" + framed(flow) + "ACK:x\n" + framed("ACK:y");
+    // 帧头被拆开到达
+    ASSERT_TRUE(f.deliver(stream.substr(0, 25)));
+    ASSERT_TRUE(f.deliver(stream.substr(25)));
+    ASSERT_EQ(f.messages.size(), 2u);
+    EXPECT_EQ(f.messages[0].requestId, "a");
+    EXPECT_EQ(f.messages[1].type, DownlinkMessageType::Flow);
+    EXPECT_EQ(f.messages[1].requestId, "framed");
+    EXPECT_EQ(f.messages[1].payload, flow.substr(5));
+    ASSERT_EQ(f.acks.size(), 2u);
+    EXPECT_EQ(f.acks[0], "x");
+    EXPECT_EQ(f.acks[1], "y");
+}
+
+TEST(DownlinkClientTest, OversizedMessageDropsConnection) {
+    DownlinkClient::Config cfg;
+    cfg.maxMessageBytes = 1024;
+    DownlinkFixture lines(cfg);
+    EXPECT_FALSE(lines.deliver("CMD:" + std::string(4096, 'x')));
+
+    DownlinkFixture frames(cfg);
+    EXPECT_FALSE(frames.deliver(framed("FLOW:" + std::string(2048, 'x'))));
+    EXPECT_TRUE(frames.messages.empty());
+}
+
+TEST(DownlinkClientTest, PeerCloseReportsDisconnect) {
+    DownlinkFixture f;
+    ASSERT_TRUE(f.deliver("ACK:last\n"));
+    f.closePeer();
+    EXPECT_FALSE(f.client.readAvailable());
+    EXPECT_EQ(f.acks.size(), 1u);
+}
+
+TEST(DownlinkClientTest, UrgentCommandOvertakesQueuedPayloads) {
+    DownlinkFixture f;
+    const std::string mission = "MISSION:{\"uavId\":\"uav1\",\"requestId\":\"m1\",\"steps\":[\"" +
+                                std::string(4000, 'w') + "\"]}";
+    const std::string burst = framed(mission) + "CMD:{\"uavId\":\"uav1\",\"requestId\":\"c1\",\"type\":\"ARM\"}\n" +
+                              "FLOW:{\"uavId\":\"uav1\",\"requestId\":\"f1\"}\n" +
+                              "CMD:{\"uavId\":\"uav1\",\"requestId\":\"c2\",\"type\":\"rtl\"}\n" +
+                              "MISSION:{\"uavId\":\"uav1\",\"requestId\":\"m2\"}\n" +
+                              "CMD:{\"uavId\":\"uav1\",\"requestId\":\"c3\",\"type\":\"TAKEOFF\"}\n";
+    ASSERT_TRUE(f.deliver(burst));
+    ASSERT_EQ(f.messages.size(), 6u);
+    // 紧急命令及其之前的命令先分发（命令之间不换序），其余按到达顺序
+    const char* expected[] = {"c1", "c2", "m1", "f1", "m2", "c3"};
+    for (std::size_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(f.messages[i].requestId, expected[i]);
+    }
+    EXPECT_EQ(f.messages[0].priority, DownlinkPriority::Normal);
+    EXPECT_EQ(f.messages[1].priority, DownlinkPriority::Urgent);
+    EXPECT_EQ(f.messages[2].priority, DownlinkPriority::Normal);
+}
+
+TEST(DownlinkClientTest, ExplicitUrgentPriorityOnCommand) {
+    DownlinkFixture f;
+    ASSERT_TRUE(f.deliver("MISSION:{\"uavId\":\"uav1\",\"requestId\":\"m1\",\"priority\":\"urgent\"}\n"
+                          "CMD:{\"uavId\":\"uav1\",\"requestId\":\"c1\",\"type\":\"HOLD\",\"priority\":\"urgent\"}\n"));
+    ASSERT_EQ(f.messages.size(), 2u);
+    EXPECT_EQ(f.messages[0].requestId, "c1");
+    EXPECT_EQ(f.messages[0].priority, DownlinkPriority::Urgent);
+    EXPECT_EQ(f.messages[1].requestId, "m1");
+    EXPECT_EQ(f.messages[1].priority, DownlinkPriority::Normal);  // 只有命令可以提升优先级
+}
+
+TEST(DownlinkClientTest, CompressedFramesInflateInPlaceOfText) {
+    if (!PayloadCodec::available()) {
+        GTEST_SKIP() << "built without zstd";
+    }
+    PayloadCompressionConfig config;
+    config.enabled = true;
+    auto codec = PayloadCodec::create(config);
+    ASSERT_TRUE(codec);
+    std::string steps;
+    for (int i = 0; i < 200; ++i) {
+        steps += "{\"type\":\"waypoint\",\"lat\":31.2" + std::to_string(i) + ",\"lon\":121.4,\"alt\":80},";
+    }
+    const std::string mission = "MISSION:{\"uavId\":\"uav1\",\"requestId\":\"m1\",\"steps\":[" + steps + "{}]}";
+    std::string compressed;
+    ASSERT_TRUE(codec->compressFrame(mission, {}, compressed));
+    EXPECT_LT(compressed.size() * 5, mission.size());
+
+    // 未设置 codec：压缩帧被丢弃，前后的消息照常分发，连接保持
+    {
+        DownlinkFixture f;
+        ASSERT_TRUE(f.deliver("CMD:{\"requestId\":\"a\"}\n" + compressed + "ACK:x\n"));
+        ASSERT_EQ(f.messages.size(), 1u);
+        EXPECT_EQ(f.acks.size(), 1u);
+    }
+
+    DownlinkFixture f;
+    f.client.setPayloadCodec(codec);
+    const std::string stream = "CMD:{\"requestId\":\"a\"}\n" + compressed + framed("ACK:y");
+    ASSERT_TRUE(f.deliver(stream.substr(0, 30)));  // 压缩帧分两次到达
+    ASSERT_TRUE(f.deliver(stream.substr(30)));
+    ASSERT_EQ(f.messages.size(), 2u);
+    EXPECT_EQ(f.messages[1].type, DownlinkMessageType::Mission);
+    EXPECT_EQ(f.messages[1].requestId, "m1");
+    EXPECT_EQ(f.messages[1].payload, mission.substr(8));
+    ASSERT_EQ(f.acks.size(), 1u);
+    EXPECT_EQ(codec->stats().decompressed, 1u);
+}
@@ -113,3 +113,37 @@ TEST(ErrorStatisticsTest, ThreadSafety) {
     int64_t count = stats.getErrorCount(ErrorCode::ConnectionFailed);
     EXPECT_EQ(count, 100);  // 10 threads * 10 errors
 }
+
+TEST(ErrorStatisticsTest, SamplesAndTruncatesMessages) {
+    ErrorStatistics& stats = ErrorStatistics::instance();
+    stats.reset();
+
+    const auto before = std::chrono::system_clock::now();
+    for (int i = 0; i < 100; i++) {
+        stats.recordError(ErrorCode::SendFailed, "send error " + std::to_string(i));
+    }
+    const auto after = std::chrono::system_clock::now();
+
+    auto allStats = stats.getAllStats();
+    ASSERT_EQ(allStats.size(), 1u);
+    EXPECT_EQ(allStats[ErrorCode::SendFailed].count, 100);
+    // 同一秒内只保留首条消息
+    if (std::chrono::duration_cast<std::chrono::seconds>(before.time_since_epoch()) ==
+        std::chrono::duration_cast<std::chrono::seconds>(after.time_since_epoch())) {
+        EXPECT_EQ(allStats[ErrorCode::SendFailed].lastMessage, "send error 0");
+    }
+
+    stats.recordError(ErrorCode::ConnectionLost, std::string(500, 'x'));
+    EXPECT_EQ(stats.getAllStats()[ErrorCode::ConnectionLost].lastMessage.size(), ErrorStatistics::kMaxMessageBytes);
+}
+
+TEST(ErrorStatisticsTest, UnmappedCodesCountAsUnknown) {
+    ErrorStatistics& stats = ErrorStatistics::instance();
+    stats.reset();
+
+    stats.recordError(static_cast<ErrorCode>(0x10FF));
+    stats.recordError(ErrorCode::UavStopFailed);
+    EXPECT_EQ(stats.getErrorCount(ErrorCode::UnknownError), 1);
+    EXPECT_EQ(stats.getErrorCount(ErrorCode::UavStopFailed), 1);
+    EXPECT_EQ(stats.getTotalErrorCount(), 2);
+}
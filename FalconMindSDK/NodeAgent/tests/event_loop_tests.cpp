@@ -0,0 +1,312 @@
+// NodeAgent - EventLoop reactor and event-driven downlink tests
+#include <gtest/gtest.h>
+#include "nodeagent/EventLoop.h"
+#include "nodeagent/DownlinkClient.h"
+#include "nodeagent/NodeAgent.h"
+#include "falconmind/sdk/telemetry/TelemetryPublisher.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace nodeagent;
+using falconmind::sdk::telemetry::TelemetryMessage;
+using falconmind::sdk::telemetry::TelemetryPublisher;
+
+void registerEventLoopTests() {
+    // Tests are registered via TEST macros
+}
+
+namespace {
+
+class SocketPair {
+public:
+    SocketPair() { socketpair(AF_UNIX, SOCK_STREAM, 0, fds_); }
+    ~SocketPair() {
+        closeLocal();
+        closePeer();
+    }
+    int local() const { return fds_[0]; }
+    int peer() const { return fds_[1]; }
+    void write(const std::string& text) { ::send(fds_[1], text.data(), text.size(), 0); }
+    void closeLocal() {
+        if (fds_[0] >= 0) ::close(fds_[0]);
+        fds_[0] = -1;
+    }
+    void closePeer() {
+        if (fds_[1] >= 0) ::close(fds_[1]);
+        fds_[1] = -1;
+    }
+
+private:
+    int fds_[2]{-1, -1};
+};
+
+// 在后台线程运行事件循环，析构时停止
+class LoopThread {
+public:
+    explicit LoopThread(EventLoop& loop) : loop_(loop), thread_([this]() { loop_.run(); }) {}
+    ~LoopThread() {
+        loop_.stop();
+        thread_.join();
+    }
+
+private:
+    EventLoop& loop_;
+    std::thread thread_;
+};
+
+template <typename Pred>
+bool waitFor(Pred pred, int timeoutMs = 1000) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(EventLoopTest, PostedTasksRunOnLoopThread) {
+    EventLoop loop;
+    ASSERT_TRUE(loop.valid());
+    std::atomic<int> ran{0};
+    std::atomic<bool> onLoopThread{false};
+    {
+        LoopThread runner(loop);
+        for (int i = 0; i < 100; ++i) {
+            loop.post([&]() {
+                onLoopThread = loop.isInLoopThread();
+                ++ran;
+            });
+        }
+        EXPECT_TRUE(waitFor([&]() { return ran.load() == 100; }));
+    }
+    EXPECT_TRUE(onLoopThread.load());
+    EXPECT_FALSE(loop.isInLoopThread());
+}
+
+TEST(EventLoopTest, StopBeforeRunReturnsImmediately) {
+    EventLoop loop;
+    loop.stop();
+    loop.run();
+    SUCCEED();
+}
+
+TEST(EventLoopTest, ReadableFdDispatchesPromptly) {
+    EventLoop loop;
+    SocketPair pair;
+    std::atomic<int> received{0};
+    ASSERT_TRUE(loop.addFd(pair.local(), EPOLLIN, [&](std::uint32_t) {
+        char buf[64];
+        if (::recv(pair.local(), buf, sizeof(buf), 0) > 0) ++received;
+    }));
+    LoopThread runner(loop);
+
+    // 逐条往返测量收到数据到回调的延迟：事件驱动分发不应有轮询周期带来的等待
+    std::vector<double> latenciesUs;
+    for (int i = 0; i < 50; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        pair.write("x");
+        ASSERT_TRUE(waitFor([&]() { return received.load() == i + 1; }));
+        latenciesUs.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    EXPECT_LT(latenciesUs[latenciesUs.size() / 2], 5000.0);
+}
+
+TEST(EventLoopTest, RemoveFdInsideCallbackStopsNotifications) {
+    EventLoop loop;
+    SocketPair pair;
+    int calls = 0;
+    ASSERT_TRUE(loop.addFd(pair.local(), EPOLLIN, [&](std::uint32_t) {
+        ++calls;
+        loop.removeFd(pair.local());  // 数据未读：level-triggered 下若未移除会再次通知
+    }));
+    pair.write("hello");
+    EXPECT_EQ(loop.runOnce(100), 1);
+    EXPECT_EQ(loop.runOnce(20), 0);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(EventLoopTest, PeriodicTimerFires) {
+    EventLoop loop;
+    std::atomic<int> ticks{0};
+    const int timer = loop.addTimer([&]() { ++ticks; });
+    ASSERT_GE(timer, 0);
+    ASSERT_TRUE(loop.armTimer(timer, 10, 10));
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(105);
+    while (std::chrono::steady_clock::now() < deadline) {
+        loop.runOnce(5);
+    }
+    EXPECT_GE(ticks.load(), 8);
+    EXPECT_LE(ticks.load(), 11);
+
+    loop.disarmTimer(timer);
+    const int before = ticks.load();
+    loop.runOnce(30);
+    EXPECT_EQ(ticks.load(), before);
+    loop.removeTimer(timer);
+}
+
+TEST(EventLoopTest, OneShotTimerArmedFromAnotherThread) {
+    EventLoop loop;
+    std::atomic<int> fired{0};
+    const int timer = loop.addTimer([&]() { ++fired; });
+    ASSERT_GE(timer, 0);
+    LoopThread runner(loop);
+
+    std::thread other([&]() { loop.armTimer(timer, 20); });
+    other.join();
+    EXPECT_TRUE(waitFor([&]() { return fired.load() == 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(fired.load(), 1);
+
+    // 重新设置覆盖尚未到期的定时
+    loop.armTimer(timer, 1000);
+    loop.armTimer(timer, 10);
+    EXPECT_TRUE(waitFor([&]() { return fired.load() == 2; }, 500));
+}
+
+TEST(DownlinkClientEventLoopTest, DispatchesMessagesFromLoop) {
+    EventLoop loop;
+    SocketPair pair;
+    DownlinkClient client(DownlinkClient::Config{});
+    ASSERT_TRUE(client.connect(pair.local()));
+
+    std::atomic<int> commands{0};
+    std::atomic<int> acks{0};
+    std::atomic<bool> closed{false};
+    std::string lastRequestId;
+    client.setMessageHandler([&](const DownlinkMessage& msg) {
+        EXPECT_EQ(msg.type, DownlinkMessageType::Command);
+        lastRequestId = msg.requestId;
+        ++commands;
+    });
+    client.setAckHandler([&](const std::string& id) {
+        EXPECT_EQ(id, "msg-7");
+        ++acks;
+    });
+    ASSERT_TRUE(loop.addFd(pair.local(), EPOLLIN | EPOLLRDHUP, [&](std::uint32_t) {
+        if (!client.readAvailable()) {
+            loop.removeFd(pair.local());
+            closed = true;
+        }
+    }));
+
+    {
+        LoopThread runner(loop);
+        // 一条消息被拆成两段到达，另一段同时带有 ACK
+        pair.write("CMD:{\"uavId\":\"uav1\",\"requestId\":\"r1\",");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        EXPECT_EQ(commands.load(), 0);
+        pair.write("\"command\":\"ARM\"}\nACK:msg-7\n");
+        EXPECT_TRUE(waitFor([&]() { return commands.load() == 1 && acks.load() == 1; }));
+
+        pair.closePeer();
+        EXPECT_TRUE(waitFor([&]() { return closed.load(); }));
+    }
+    EXPECT_EQ(lastRequestId, "r1");
+    client.disconnect();
+}
+
+TEST(NodeAgentEventLoopTest, CommandsAndTelemetryShareOneLoop) {
+    const int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    ASSERT_EQ(listen(listenFd, 1), 0);
+    socklen_t len = sizeof(addr);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+
+    NodeAgent::Config cfg;
+    cfg.centerPort = ntohs(addr.sin_port);
+    cfg.telemetryEncoding = TelemetryEncoding::Json;
+    cfg.enableAutoReconnect = false;
+    cfg.logLevel = 3;
+    NodeAgent agent(cfg);
+    std::atomic<int> commands{0};
+    std::chrono::steady_clock::time_point handledAt;
+    agent.setDownlinkMessageHandler([&](const DownlinkMessage&) {
+        handledAt = std::chrono::steady_clock::now();
+        ++commands;
+    });
+    ASSERT_TRUE(agent.start());
+    const int center = ::accept(listenFd, nullptr, nullptr);
+    ASSERT_GE(center, 0);
+
+    // 下行命令在循环线程中随 socket 可读立即分发
+    const std::string cmd = "CMD:{\"uavId\":\"uav0\",\"requestId\":\"r9\",\"command\":\"ARM\"}\n";
+    const auto sentAt = std::chrono::steady_clock::now();
+    ::send(center, cmd.data(), cmd.size(), 0);
+    ASSERT_TRUE(waitFor([&]() { return commands.load() == 1; }));
+    EXPECT_LT(handledAt - sentAt, std::chrono::milliseconds(50));
+
+    // 遥测经队列交给循环线程发送，写合并由循环中的定时器写出
+    TelemetryMessage msg;
+    msg.uavId = "uav0";
+    msg.lat = 31.0;
+    TelemetryPublisher::instance().publish(msg);
+    std::string received;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (received.find("\"uav_id\"") == std::string::npos && std::chrono::steady_clock::now() < deadline) {
+        pollfd pfd{center, POLLIN, 0};
+        if (poll(&pfd, 1, 100) <= 0) continue;
+        char chunk[1024];
+        const ssize_t n = ::recv(center, chunk, sizeof(chunk), 0);
+        if (n <= 0) break;
+        received.append(chunk, static_cast<std::size_t>(n));
+    }
+    EXPECT_NE(received.find("\"uav_id\":\"uav0\""), std::string::npos);
+
+    agent.stop();
+    EXPECT_FALSE(agent.isRunning());
+    ::close(center);
+    ::close(listenFd);
+}
+
+TEST(NodeAgentEventLoopTest, ReconnectsQuicklyAfterTransientDrop) {
+    const int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    ASSERT_EQ(listen(listenFd, 2), 0);
+    socklen_t len = sizeof(addr);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+
+    NodeAgent::Config cfg;
+    cfg.centerPort = ntohs(addr.sin_port);
+    cfg.telemetryEncoding = TelemetryEncoding::Json;
+    cfg.reconnectInitialDelayMs = 1000;
+    cfg.logLevel = 3;
+    NodeAgent agent(cfg);
+    ASSERT_TRUE(agent.start());
+    const int first = ::accept(listenFd, nullptr, nullptr);
+    ASSERT_GE(first, 0);
+
+    // Cluster Center 侧断开：循环读到 EOF 后快速重试（非阻塞连接），不等待完整的退避下限
+    const auto droppedAt = std::chrono::steady_clock::now();
+    ::close(first);
+    pollfd pfd{listenFd, POLLIN, 0};
+    ASSERT_EQ(poll(&pfd, 1, 2000), 1);
+    const int second = ::accept(listenFd, nullptr, nullptr);
+    ASSERT_GE(second, 0);
+    EXPECT_LT(std::chrono::steady_clock::now() - droppedAt, std::chrono::milliseconds(cfg.reconnectInitialDelayMs));
+
+    agent.stop();
+    ::close(second);
+    ::close(listenFd);
+}
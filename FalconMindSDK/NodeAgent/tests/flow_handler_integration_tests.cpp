@@ -14,6 +14,8 @@
 #include <atomic>
 #include <thread>
 #include <chrono>
+#include <filesystem>
+#include <vector>
 
 using namespace nodeagent;
 using namespace falconmind::sdk::core;
@@ -418,4 +420,56 @@ TEST(FlowHandlerIntegrationTest, FlowHotUpdate) {
     handler.stopCurrentFlow();
 }
 
+// 测试快速启动：成功启动的 Flow 写入计划缓存与“上一次的 Flow”记录，新 FlowHandler 由缓存直接恢复
+TEST(FlowHandlerIntegrationTest, FastBootResumeFromPlanCache) {
+    if (NodeFactory::getRegisteredTypes().empty()) {
+        NodeFactory::initializeDefaultTypes();
+    }
+    const std::string cacheDir = "/tmp/nodeagent_fast_boot_test";
+    std::filesystem::remove_all(cacheDir);
+    std::filesystem::create_directories(cacheDir);
+
+    DownlinkMessage msg;
+    msg.type = DownlinkMessageType::Flow;
+    msg.contentHash = "abc123";
+    msg.payload = R"({
+        "flow_id": "test_flow_fast_boot",
+        "flow_definition": {
+            "flow_id": "test_flow_fast_boot",
+            "version": "3.1",
+            "nodes": [
+                {"node_id": "node_planner", "template_id": "search_path_planner", "parameters": {}}
+            ],
+            "edges": []
+        }
+    })";
+    {
+        FlowHandler handler;
+        EXPECT_FALSE(handler.resumeLastFlow());  // 未设置缓存目录
+        handler.setPlanCacheDirectory(cacheDir);
+        EXPECT_FALSE(handler.resumeLastFlow());  // 尚无记录
+        ASSERT_TRUE(handler.handleFlow(msg));
+        handler.stopCurrentFlow();
+    }
+
+    FlowHandler rebooted;
+    rebooted.setPlanCacheDirectory(cacheDir);
+    ASSERT_TRUE(rebooted.resumeLastFlow());
+    EXPECT_TRUE(rebooted.isFlowRunning());
+    EXPECT_EQ(rebooted.getCurrentFlowId(), "test_flow_fast_boot");
+    EXPECT_EQ(rebooted.getCurrentContentHash(), "abc123");
+    EXPECT_FALSE(rebooted.resumeLastFlow());  // 已在运行
+
+    // 中心重新下发相同内容：不重启
+    std::vector<std::string> statuses;
+    rebooted.setStatusCallback([&statuses](const std::string&, const std::string& status, const std::string&) {
+        statuses.push_back(status);
+    });
+    EXPECT_TRUE(rebooted.handleFlow(msg));
+    ASSERT_EQ(statuses.size(), 1u);
+    EXPECT_EQ(statuses[0], "RUNNING");
+    rebooted.stopCurrentFlow();
+    std::filesystem::remove_all(cacheDir);
+}
+
 } // namespace
@@ -5,6 +5,8 @@
 
 #include <thread>
 #include <chrono>
+#include <string>
+#include <vector>
 
 using namespace nodeagent;
 
@@ -126,3 +128,113 @@ TEST(MessageAckManagerTest, UpdateWithoutPendingMessages) {
     manager.update();
     EXPECT_TRUE(true);
 }
+
+TEST(MessageAckManagerTest, AcknowledgedMessagesAreReclaimed) {
+    MessageAckManager::Config config;
+    config.maxPending = 64;
+    MessageAckManager manager(config);
+
+    // 远多于容量的消息依次注册并确认：槽位被回收，内存不随消息数增长
+    for (int i = 0; i < 10000; ++i) {
+        DownlinkMessage msg;
+        msg.requestId = "req" + std::to_string(i);
+        manager.registerPendingMessage(msg);
+        ASSERT_TRUE(manager.acknowledgeMessage(msg.requestId));
+    }
+    const MessageAckStats stats = manager.stats();
+    EXPECT_EQ(stats.pending, 0u);
+    EXPECT_EQ(stats.acknowledged, 10000u);
+    EXPECT_EQ(stats.overflow, 0u);
+    EXPECT_EQ(manager.getMessageStatus("req9999"), AckStatus::Acknowledged);
+    EXPECT_FALSE(manager.acknowledgeMessage("req9999"));  // 重复确认
+    EXPECT_EQ(manager.stats().unknownAcks, 1u);
+}
+
+TEST(MessageAckManagerTest, TimerWheelRetriesOnlyUnacknowledged) {
+    MessageAckManager::Config config;
+    config.maxRetries = 1;
+    config.timeoutMs = std::chrono::milliseconds(1000);
+    config.tickMs = std::chrono::milliseconds(10);
+    config.maxPending = 2048;
+    MessageAckManager manager(config);
+
+    std::vector<std::string> retried;
+    manager.setRetryCallback([&](const DownlinkMessage& msg) { retried.push_back(msg.requestId); });
+
+    const auto start = MessageAckManager::Clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        DownlinkMessage msg;
+        msg.requestId = "m" + std::to_string(i);
+        manager.registerPendingMessage(msg);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        manager.acknowledgeMessage("m" + std::to_string(i));
+    }
+
+    manager.update(start + std::chrono::milliseconds(500));
+    EXPECT_TRUE(retried.empty());
+
+    // 超时后只重传未确认的一半
+    manager.update(start + std::chrono::milliseconds(1100));
+    ASSERT_EQ(retried.size(), 500u);
+    for (const auto& id : retried) {
+        EXPECT_EQ(std::stoi(id.substr(1)) % 2, 1);
+    }
+    EXPECT_EQ(manager.getMessageStatus("m1"), AckStatus::Pending);
+
+    // 长时间未调用 update（超过时间轮一圈）后重试耗尽，全部超时并回收
+    manager.update(start + std::chrono::seconds(60));
+    EXPECT_EQ(retried.size(), 500u);
+    const MessageAckStats stats = manager.stats();
+    EXPECT_EQ(stats.timeouts, 500u);
+    EXPECT_EQ(stats.pending, 0u);
+    EXPECT_EQ(manager.getMessageStatus("m999"), AckStatus::Timeout);
+}
+
+TEST(MessageAckManagerTest, PendingSetIsBounded) {
+    MessageAckManager::Config config;
+    config.maxPending = 8;
+    MessageAckManager manager(config);
+    for (int i = 0; i < 20; ++i) {
+        DownlinkMessage msg;
+        msg.requestId = "r" + std::to_string(i);
+        EXPECT_EQ(manager.registerPendingMessage(msg), msg.requestId);
+    }
+    // 重复下发已跟踪的 ID 不占用新槽位
+    DownlinkMessage again;
+    again.requestId = "r3";
+    manager.registerPendingMessage(again);
+
+    const MessageAckStats stats = manager.stats();
+    EXPECT_EQ(stats.pending, 8u);
+    EXPECT_EQ(stats.overflow, 12u);
+    EXPECT_TRUE(manager.acknowledgeMessage("r3"));
+    EXPECT_FALSE(manager.acknowledgeMessage("r15"));
+}
+
+TEST(MessageAckManagerTest, TimeoutFollowsVirtualClock) {
+    using falconmind::sdk::core::PipelineClock;
+    PipelineClock::enableVirtual(1'000'000'000);
+    MessageAckManager::Config config;
+    config.maxRetries = 1;
+    config.timeoutMs = std::chrono::milliseconds(5000);
+    config.tickMs = std::chrono::milliseconds(10);
+    MessageAckManager manager(config);
+    int retries = 0;
+    manager.setRetryCallback([&](const DownlinkMessage&) { ++retries; });
+
+    DownlinkMessage msg;
+    msg.requestId = "v1";
+    manager.registerPendingMessage(msg);
+    // 墙钟流逝不影响：只有推进虚拟时钟才触发重传 / 超时
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    manager.update();
+    EXPECT_EQ(retries, 0);
+    PipelineClock::advanceVirtualTo(1'000'000'000 + 5'100'000'000);
+    manager.update();
+    EXPECT_EQ(retries, 1);
+    PipelineClock::advanceVirtualTo(1'000'000'000 + 10'200'000'000);
+    manager.update();
+    EXPECT_EQ(manager.getMessageStatus("v1"), AckStatus::Timeout);
+    PipelineClock::disableVirtual();
+}
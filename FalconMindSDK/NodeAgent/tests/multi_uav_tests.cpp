@@ -2,6 +2,17 @@
 #include <gtest/gtest.h>
 #include "nodeagent/MultiUavManager.h"
 #include "nodeagent/NodeAgent.h"
+#include "falconmind/sdk/telemetry/TelemetryPublisher.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
 
 using namespace nodeagent;
 
@@ -114,3 +125,74 @@ TEST(MultiUavManagerTest, GetUavListWhenEmpty) {
     auto uavList = manager.getUavList();
     EXPECT_TRUE(uavList.empty());
 }
+
+TEST(MultiUavManagerTest, SharedLoopsRouteTelemetryPerUav) {
+    const int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    ASSERT_EQ(listen(listenFd, 64), 0);
+    socklen_t len = sizeof(addr);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+
+    constexpr int kUavs = 24;
+    MultiUavManager::Config managerCfg;
+    managerCfg.ioThreads = 2;
+    managerCfg.agentDefaults.telemetryEncoding = TelemetryEncoding::Json;
+    managerCfg.agentDefaults.enableAutoReconnect = false;
+    managerCfg.agentDefaults.logLevel = 3;
+    MultiUavManager manager(managerCfg);
+    EXPECT_EQ(manager.ioThreadCount(), 2u);
+
+    for (int i = 0; i < kUavs; ++i) {
+        MultiUavManager::UavConfig config;
+        config.uavId = "uav" + std::to_string(i);
+        config.centerPort = ntohs(addr.sin_port);
+        ASSERT_TRUE(manager.addUav(config));
+    }
+    ASSERT_TRUE(manager.startAll());
+    std::vector<int> centers;
+    for (int i = 0; i < kUavs; ++i) {
+        const int fd = ::accept(listenFd, nullptr, nullptr);
+        ASSERT_GE(fd, 0);
+        centers.push_back(fd);
+    }
+    EXPECT_TRUE(manager.isUavRunning("uav7"));
+
+    // 一条 uav7 的遥测只应由 uav7 的连接上报
+    falconmind::sdk::telemetry::TelemetryMessage msg;
+    msg.uavId = "uav7";
+    msg.lat = 31.0;
+    falconmind::sdk::telemetry::TelemetryPublisher::instance().publish(msg);
+
+    std::vector<std::string> received(centers.size());
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::vector<pollfd> pfds;
+        for (int fd : centers) pfds.push_back({fd, POLLIN, 0});
+        if (poll(pfds.data(), pfds.size(), 50) <= 0) continue;
+        for (std::size_t i = 0; i < pfds.size(); ++i) {
+            if (!(pfds[i].revents & POLLIN)) continue;
+            char chunk[1024];
+            const ssize_t n = ::recv(centers[i], chunk, sizeof(chunk), 0);
+            if (n > 0) received[i].append(chunk, static_cast<std::size_t>(n));
+        }
+    }
+    int reporting = 0;
+    for (const auto& data : received) {
+        // 每条连接都会发送时钟同步探测，只统计带遥测的连接
+        if (data.find("\"uav_id\"") != std::string::npos) {
+            ++reporting;
+            EXPECT_NE(data.find("\"uav_id\":\"uav7\""), std::string::npos);
+        }
+    }
+    EXPECT_EQ(reporting, 1);
+
+    manager.stopAll();
+    EXPECT_FALSE(manager.isUavRunning("uav7"));
+    EXPECT_TRUE(manager.removeUav("uav3"));
+    EXPECT_EQ(manager.getUavList().size(), static_cast<std::size_t>(kUavs - 1));
+    for (int fd : centers) ::close(fd);
+    ::close(listenFd);
+}
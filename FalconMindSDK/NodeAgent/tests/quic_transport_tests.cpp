@@ -0,0 +1,151 @@
+// NodeAgent - QUIC transport tests (per-stream downlink framing; msquic-independent parts)
+#include <gtest/gtest.h>
+#include "nodeagent/DownlinkClient.h"
+#include "nodeagent/QuicDownlinkClient.h"
+#include "nodeagent/QuicSession.h"
+#include "nodeagent/QuicUplinkClient.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace nodeagent;
+
+void registerQuicTransportTests() {
+    // Tests are registered via TEST macros
+}
+
+namespace {
+
+// 不连接网络：直接以 onStreamData 模拟 Cluster Center 打开的下行流
+class QuicDownlinkFixture {
+public:
+    QuicDownlinkFixture() : session(std::make_shared<QuicSession>()), client(session) {
+        client.setMessageHandler([this](const DownlinkMessage& msg) { messages.push_back(msg); });
+        client.setAckHandler([this](const std::string& id) { acks.push_back(id); });
+        client.startReceiving("uav0");
+    }
+
+    void deliver(std::uint64_t stream, const std::string& bytes) {
+        client.onStreamData(stream, bytes.data(), bytes.size());
+    }
+
+    std::shared_ptr<QuicSession> session;
+    QuicDownlinkClient client;
+    std::vector<DownlinkMessage> messages;
+    std::vector<std::string> acks;
+};
+
+std::string framed(const std::string& message) {
+    std::string frame(1, static_cast<char>(kDownlinkFrameMagic));
+    const auto length = static_cast<std::uint32_t>(message.size());
+    for (int i = 0; i < 4; ++i) {
+        frame.push_back(static_cast<char>((length >> (8 * i)) & 0xFF));
+    }
+    return frame + message;
+}
+
+} // namespace
+
+TEST(QuicTransportTest, DownlinkFeedParsesMessagesSplitAcrossCalls) {
+    DownlinkClient parser(DownlinkClient::Config{});
+    std::vector<DownlinkMessage> messages;
+    parser.setMessageHandler([&](const DownlinkMessage& msg) { messages.push_back(msg); });
+
+    const std::string bytes = "CMD:{\"uavId\":\"uav1\",\"requestId\":\"c1\"}\n" +
+                              framed("MISSION:{\"requestId\":\"m1\"}");
+    for (char c : bytes) {
+        ASSERT_TRUE(parser.feed(&c, 1));
+    }
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[0].requestId, "c1");
+    EXPECT_EQ(messages[1].type, DownlinkMessageType::Mission);
+    EXPECT_EQ(messages[1].requestId, "m1");
+    EXPECT_FALSE(parser.isConnected());
+}
+
+TEST(QuicTransportTest, PartialMissionOnOneStreamDoesNotBlockCommandOnAnother) {
+    QuicDownlinkFixture f;
+    std::string waypoints;
+    while (waypoints.size() < 256 * 1024) {
+        waypoints += "{\"lat\":1.0,\"lon\":2.0},";
+    }
+    waypoints.pop_back();
+    const std::string mission = framed("MISSION:{\"requestId\":\"m1\",\"waypoints\":[" + waypoints + "]}");
+
+    // 任务流只到达一半：TCP 上这会挡住其后的所有消息
+    f.deliver(1, mission.substr(0, mission.size() / 2));
+    f.deliver(2, "CMD:{\"requestId\":\"rtl\",\"type\":\"RTL\"}\n");
+    ASSERT_EQ(f.messages.size(), 1u);
+    EXPECT_EQ(f.messages[0].requestId, "rtl");
+    EXPECT_EQ(f.messages[0].priority, DownlinkPriority::Urgent);
+    EXPECT_EQ(f.client.activeStreams(), 2u);
+
+    f.deliver(1, mission.substr(mission.size() / 2));
+    ASSERT_EQ(f.messages.size(), 2u);
+    EXPECT_EQ(f.messages[1].type, DownlinkMessageType::Mission);
+    EXPECT_EQ(f.messages[1].requestId, "m1");
+}
+
+TEST(QuicTransportTest, MalformedStreamIsDiscardedWithoutAffectingOthers) {
+    QuicDownlinkFixture f;
+    std::string badHeader(1, static_cast<char>(kDownlinkFrameMagic));
+    badHeader += std::string("\xff\xff\xff\x7f", 4);  // 超过 maxMessageBytes
+    f.deliver(7, badHeader);
+    f.deliver(7, "CMD:{\"requestId\":\"after-error\"}\n");  // 同一流上的后续数据被丢弃
+    f.deliver(8, "ACK:ok\n");
+    EXPECT_TRUE(f.messages.empty());
+    ASSERT_EQ(f.acks.size(), 1u);
+    EXPECT_EQ(f.acks[0], "ok");
+
+    // 流关闭后其标识可被新流复用
+    f.client.onStreamClosed(7);
+    f.deliver(7, "CMD:{\"requestId\":\"reused\"}\n");
+    ASSERT_EQ(f.messages.size(), 1u);
+    EXPECT_EQ(f.messages[0].requestId, "reused");
+}
+
+TEST(QuicTransportTest, ClosedStreamDropsIncompleteTail) {
+    QuicDownlinkFixture f;
+    f.deliver(3, "CMD:{\"requestId\":\"c1\"}\nCMD:{\"requestId\":\"cut");
+    f.client.onStreamClosed(3);
+    EXPECT_EQ(f.client.activeStreams(), 0u);
+    f.deliver(3, "\n");
+    ASSERT_EQ(f.messages.size(), 1u);
+    EXPECT_EQ(f.messages[0].requestId, "c1");
+}
+
+TEST(QuicTransportTest, DataBeforeStartReceivingIsIgnored) {
+    auto session = std::make_shared<QuicSession>();
+    QuicDownlinkClient client(session);
+    int count = 0;
+    client.setMessageHandler([&](const DownlinkMessage&) { ++count; });
+    const std::string line = "CMD:{\"requestId\":\"early\"}\n";
+    client.onStreamData(1, line.data(), line.size());
+    EXPECT_EQ(count, 0);
+    client.startReceiving();
+    client.onStreamData(1, line.data(), line.size());
+    EXPECT_EQ(count, 1);
+    client.stopReceiving();
+    EXPECT_EQ(client.activeStreams(), 0u);
+}
+
+TEST(QuicTransportTest, UplinkRejectsSendsWhenNotConnected) {
+    auto session = std::make_shared<QuicSession>();
+    QuicUplinkClient uplink(session);
+    EXPECT_FALSE(uplink.isConnected());
+    falconmind::sdk::telemetry::TelemetryMessage msg;
+    msg.uavId = "uav0";
+    EXPECT_FALSE(uplink.sendTelemetry(msg));
+    EXPECT_FALSE(uplink.sendMessage("{\"type\":\"event\"}", UplinkPriority::Control));
+    EXPECT_FALSE(uplink.sendReplayedTelemetry(msg));
+    EXPECT_FALSE(session->sendDatagram("x", 1));
+    if (!QuicSession::available()) {
+        EXPECT_FALSE(uplink.connect());
+        EXPECT_FALSE(session->migrate("127.0.0.1"));
+    }
+    const QuicSessionStats stats = session->stats();
+    EXPECT_EQ(stats.connects, 0u);
+    EXPECT_EQ(stats.datagramsSent, 0u);
+}
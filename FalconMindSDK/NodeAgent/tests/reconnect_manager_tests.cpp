@@ -6,6 +6,8 @@
 #include <thread>
 #include <chrono>
 #include <atomic>
+#include <cstdint>
+#include <set>
 
 using namespace nodeagent;
 
@@ -157,3 +159,84 @@ TEST(ReconnectManagerTest, DisabledReconnect) {
     // Should not start reconnecting if disabled
     EXPECT_FALSE(manager.isReconnecting());
 }
+
+TEST(ReconnectBackoffTest, JitterStaysWithinBounds) {
+    ReconnectBackoff::Config config;
+    config.initialDelay = std::chrono::milliseconds(100);
+    config.maxDelay = std::chrono::milliseconds(2000);
+
+    std::set<long long> firstDelays;
+    for (std::uint64_t seed = 1; seed <= 20; ++seed) {
+        ReconnectBackoff backoff(config, seed);
+        EXPECT_LE(backoff.begin(false), config.initialDelay);
+        auto prev = config.initialDelay;
+        for (int i = 0; i < 20; ++i) {
+            const auto delay = backoff.next();
+            EXPECT_GE(delay, config.initialDelay);
+            EXPECT_LE(delay, config.maxDelay);
+            EXPECT_LE(delay.count(), static_cast<long long>(prev.count() * config.multiplier));
+            if (i == 0) {
+                firstDelays.insert(delay.count());
+            }
+            prev = delay;
+        }
+    }
+    // 不同种子的等待序列应当错开
+    EXPECT_GT(firstDelays.size(), 5u);
+}
+
+TEST(ReconnectBackoffTest, FastRetryForTransientDrop) {
+    ReconnectBackoff::Config config;
+    config.initialDelay = std::chrono::milliseconds(400);
+    ReconnectBackoff fast(config, 7);
+    EXPECT_LE(fast.begin(true), std::chrono::milliseconds(100));
+
+    config.fastRetry = false;
+    ReconnectBackoff slow(config, 7);
+    EXPECT_LE(slow.begin(true), config.initialDelay);
+}
+
+TEST(ReconnectBackoffTest, PoorLinkProbesAndRecovers) {
+    ReconnectBackoff::Config config;
+    config.fadeProbeDelay = std::chrono::milliseconds(1500);
+    ReconnectBackoff backoff(config, 3);
+
+    EXPECT_FALSE(backoff.updateLinkQuality(0.0));  // 未知
+    EXPECT_FALSE(backoff.linkPoor());
+    EXPECT_FALSE(backoff.updateLinkQuality(10.0));  // 百分比：10%
+    EXPECT_TRUE(backoff.linkPoor());
+    EXPECT_EQ(backoff.begin(true), config.fadeProbeDelay);
+    EXPECT_EQ(backoff.next(), config.fadeProbeDelay);
+
+    EXPECT_TRUE(backoff.updateLinkQuality(0.9));
+    EXPECT_FALSE(backoff.linkPoor());
+    EXPECT_FALSE(backoff.updateLinkQuality(0.9));
+    EXPECT_LE(backoff.next(), config.initialDelay * 3);
+}
+
+TEST(ReconnectManagerTest, LinkRecoveryWakesReconnect) {
+    ReconnectManager::Config config;
+    config.maxRetries = 3;
+    config.fadeProbeDelay = std::chrono::milliseconds(5000);
+
+    ReconnectManager manager(config);
+    std::atomic<int> attempts{0};
+    manager.setReconnectCallback([&attempts]() {
+        attempts++;
+        return true;
+    });
+
+    manager.updateLinkQuality(0.05);
+    manager.triggerReconnect(true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(attempts.load(), 0);  // 衰落期间等待探测间隔
+
+    const auto start = std::chrono::steady_clock::now();
+    manager.updateLinkQuality(0.8);
+    while (manager.isReconnecting() && std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(attempts.load(), 1);
+    EXPECT_FALSE(manager.isReconnecting());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+}
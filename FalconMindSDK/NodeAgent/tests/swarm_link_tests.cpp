@@ -0,0 +1,232 @@
+// NodeAgent - SwarmLink wire codec and peer-to-peer state exchange tests
+#include <gtest/gtest.h>
+#include "nodeagent/SwarmLink.h"
+#include "falconmind/sdk/cluster/ClusterStateSourceNode.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/telemetry/TelemetryTypes.h"
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace nodeagent;
+using falconmind::sdk::cluster::ClusterStatePacket;
+using falconmind::sdk::cluster::ClusterStateSourceNode;
+using falconmind::sdk::cluster::SwarmPeerState;
+using falconmind::sdk::cluster::SwarmStateRegistry;
+
+void registerSwarmLinkTests() {
+    // Tests are registered via TEST macros
+}
+
+namespace {
+
+constexpr std::int64_t kSecond = 1000000000ll;
+
+SwarmPeerState makePeer(const std::string& id, std::uint32_t seq) {
+    SwarmPeerState s;
+    s.id = id;
+    s.role = "follower";
+    s.lat = 31.2304567;
+    s.lon = 121.4737012;
+    s.alt = 52.125;
+    s.vx = 3.5f;
+    s.vy = -1.25f;
+    s.vz = 0.1f;
+    s.claims = {{7, 0.75f}, {42, 0.2f}};
+    s.seq = seq;
+    s.sentNs = 1700000000123456789ll;
+    return s;
+}
+
+// 在 127.0.0.1 上绑定一个临时端口的 UDP socket
+int openUdp(int& port) {
+    const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) return -1;
+    socklen_t len = sizeof(addr);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    port = ntohs(addr.sin_port);
+    timeval tv{2, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    return fd;
+}
+
+} // namespace
+
+TEST(SwarmLinkTest, CodecRoundTripsCompactState) {
+    const SwarmPeerState in = makePeer("uav_7", 99);
+    std::uint8_t buf[kSwarmMaxPacketBytes];
+    const std::size_t size = SwarmLink::encode(in, buf);
+    EXPECT_EQ(size, kSwarmHeaderBytes + 1 + 5 + 1 + 8 + 1 + 2 * 6);
+    EXPECT_LT(size, 80u);
+
+    SwarmPeerState out;
+    ASSERT_TRUE(SwarmLink::decode(buf, size, out));
+    EXPECT_EQ(out.id, "uav_7");
+    EXPECT_EQ(out.role, "follower");
+    EXPECT_EQ(out.seq, 99u);
+    EXPECT_EQ(out.sentNs, in.sentNs);
+    EXPECT_NEAR(out.lat, in.lat, 1e-7);
+    EXPECT_NEAR(out.lon, in.lon, 1e-7);
+    EXPECT_NEAR(out.alt, in.alt, 1e-3);
+    EXPECT_NEAR(out.vx, in.vx, 0.01);
+    EXPECT_NEAR(out.vy, in.vy, 0.01);
+    ASSERT_EQ(out.claims.size(), 2u);
+    EXPECT_EQ(out.claims[0].targetId, 7u);
+    EXPECT_NEAR(out.claims[0].score, 0.75f, 1e-4);
+
+    // 截断、魔数错误与尾部多余字节均拒绝
+    EXPECT_FALSE(SwarmLink::decode(buf, size - 1, out));
+    buf[size] = 0;
+    EXPECT_FALSE(SwarmLink::decode(buf, size + 1, out));
+    buf[0] = 'X';
+    EXPECT_FALSE(SwarmLink::decode(buf, size, out));
+}
+
+TEST(SwarmLinkTest, CodecCarriesTargetRecords) {
+    SwarmPeerState in = makePeer("uav_7", 100);
+    in.targets = {{31.2301234, 121.4701234, 0x1234, 0.8f}, {31.2311234, 121.4711234, 0, 1.0f}};
+    std::uint8_t buf[kSwarmMaxPacketBytes];
+    const std::size_t size = SwarmLink::encode(in, buf);
+    EXPECT_EQ(buf[2], kSwarmWireVersionTargets);
+    EXPECT_EQ(size, kSwarmHeaderBytes + 1 + 5 + 1 + 8 + 1 + 2 * 6 + 1 + 2 * kSwarmTargetRecordBytes);
+
+    SwarmPeerState out;
+    ASSERT_TRUE(SwarmLink::decode(buf, size, out));
+    ASSERT_EQ(out.claims.size(), 2u);
+    ASSERT_EQ(out.targets.size(), 2u);
+    EXPECT_NEAR(out.targets[0].lat, 31.2301234, 1e-7);
+    EXPECT_NEAR(out.targets[0].lon, 121.4701234, 1e-7);
+    EXPECT_EQ(out.targets[0].classKey, 0x1234);
+    EXPECT_NEAR(out.targets[0].confidence, 0.8f, 1.0f / 255);
+    EXPECT_EQ(out.targets[1].classKey, 0);
+    SwarmPeerState truncated;
+    EXPECT_FALSE(SwarmLink::decode(buf, size - 1, truncated));
+
+    // 不带目标记录时仍为版本 1，未升级的对端可以解码
+    in.targets.clear();
+    SwarmLink::encode(in, buf);
+    EXPECT_EQ(buf[2], kSwarmWireVersion);
+
+    // 对端报文中的目标并入本机的集群目标表
+    auto& registry = SwarmStateRegistry::instance();
+    registry.clear();
+    registry.setLocalId("uav_a");
+    ASSERT_TRUE(registry.updatePeer(out));
+    EXPECT_EQ(registry.targetRegistry()->size(), 2u);
+    registry.clear();
+}
+
+TEST(SwarmLinkTest, RegistryDropsStalePeersAndResolvesClaims) {
+    auto& registry = SwarmStateRegistry::instance();
+    registry.clear();
+    registry.setLocalId("uav_a");
+    registry.setLocalClaims({{7, 0.75f}});
+
+    EXPECT_FALSE(registry.updatePeer(makePeer("uav_a", 1)));  // 自己的回环报文
+    EXPECT_TRUE(registry.updatePeer(makePeer("uav_c", 5)));
+    EXPECT_FALSE(registry.updatePeer(makePeer("uav_c", 5)));  // 重复
+    EXPECT_FALSE(registry.updatePeer(makePeer("uav_c", 4)));  // 乱序
+    EXPECT_TRUE(registry.updatePeer(makePeer("uav_b", 1)));
+
+    const auto peers = registry.peers(kSecond);
+    ASSERT_EQ(peers.size(), 2u);
+    EXPECT_EQ(peers[0].id, "uav_b");
+    EXPECT_EQ(peers[1].id, "uav_c");
+
+    // 目标 7：三方同分时 ID 最小者负责；目标 42 只有对端认领
+    EXPECT_EQ(registry.claimOwner(7, kSecond), "uav_a");
+    registry.setLocalClaims({{7, 0.5f}});
+    EXPECT_EQ(registry.claimOwner(7, kSecond), "uav_b");
+    EXPECT_EQ(registry.claimOwner(42, kSecond), "uav_b");
+    EXPECT_EQ(registry.claimOwner(1000, kSecond), "");
+
+    // 离线的对端不再参与成员与认领
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_TRUE(registry.peers(10 * 1000000ll).empty());
+    EXPECT_EQ(registry.claimOwner(42, 10 * 1000000ll), "");
+    registry.clear();
+}
+
+TEST(SwarmLinkTest, ExchangesStateWithPeersAndFeedsClusterState) {
+    auto& registry = SwarmStateRegistry::instance();
+    registry.clear();
+
+    int peerPort = 0;
+    const int peerFd = openUdp(peerPort);
+    ASSERT_GE(peerFd, 0);
+
+    SwarmLinkConfig config;
+    config.enabled = true;
+    config.group.clear();  // 沙箱中不依赖组播路由：经 mesh 单播交换
+    config.port = 0;
+    config.rateHz = 20;
+    config.peers = {"127.0.0.1:" + std::to_string(peerPort)};
+    SwarmLink link(config, "uav_a");
+    ASSERT_TRUE(link.start());
+    const int linkPort = link.localPort();
+    ASSERT_GT(linkPort, 0);
+
+    falconmind::sdk::telemetry::TelemetryMessage telemetry;
+    telemetry.lat = 30.5;
+    telemetry.lon = 120.25;
+    telemetry.alt = 80.0;
+    link.updateOwnState(telemetry);
+    registry.setLocalRole("leader");
+
+    // 本机状态按 rateHz 单播给对端
+    std::uint8_t buf[kSwarmMaxPacketBytes];
+    SwarmPeerState got;
+    bool received = false;
+    for (int i = 0; i < 10 && !received; ++i) {
+        const ssize_t n = recv(peerFd, buf, sizeof(buf), 0);
+        ASSERT_GT(n, 0);
+        received = SwarmLink::decode(buf, static_cast<std::size_t>(n), got) && got.role == "leader";
+    }
+    ASSERT_TRUE(received);
+    EXPECT_EQ(got.id, "uav_a");
+    EXPECT_NEAR(got.lat, 30.5, 1e-7);
+    EXPECT_NEAR(got.alt, 80.0, 1e-3);
+
+    // 对端状态写入 registry，集群状态源据此生成成员列表与角色
+    sockaddr_in dest{};
+    dest.sin_family = AF_INET;
+    dest.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    dest.sin_port = htons(static_cast<std::uint16_t>(linkPort));
+    const std::size_t size = SwarmLink::encode(makePeer("uav_0", 1), buf);
+    ASSERT_EQ(sendto(peerFd, buf, size, 0, reinterpret_cast<sockaddr*>(&dest), sizeof(dest)),
+              static_cast<ssize_t>(size));
+    for (int i = 0; i < 200 && registry.peers(kSecond).empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(registry.peers(kSecond).size(), 1u);
+    EXPECT_EQ(link.stats().received, 1u);
+    EXPECT_GT(link.stats().sent, 0u);
+
+    ClusterStateSourceNode node;
+    ASSERT_TRUE(node.configure({{"self_id", "uav_a"}, {"role", "auto"}, {"members_source", "swarm"}}));
+    auto sink = std::make_shared<falconmind::sdk::core::Pad>("in", falconmind::sdk::core::PadType::Sink);
+    ClusterStatePacket state{};
+    sink->setDataCallback([&state](const void* data, std::size_t size) {
+        if (size == sizeof(ClusterStatePacket)) std::memcpy(&state, data, size);
+    });
+    ASSERT_TRUE(node.getPad("cluster_state_out")->connectTo(sink, "sink", "in"));
+    ASSERT_TRUE(node.start());
+    node.process();
+    EXPECT_EQ(state.num_members, 2);
+    EXPECT_STREQ(state.member_ids[0], "uav_0");
+    EXPECT_STREQ(state.member_ids[1], "uav_a");
+    EXPECT_STREQ(state.role, "follower");  // uav_0 的 ID 更小，为 leader
+
+    link.stop();
+    close(peerFd);
+    registry.clear();
+}
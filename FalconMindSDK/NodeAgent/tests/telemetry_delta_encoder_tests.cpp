@@ -0,0 +1,242 @@
+// NodeAgent - TelemetryDeltaEncoder tests
+#include <gtest/gtest.h>
+#include "nodeagent/TelemetryDeltaEncoder.h"
+
+#include <cstdint>
+
+using namespace nodeagent;
+using namespace falconmind::sdk::telemetry;
+
+void registerTelemetryDeltaEncoderTests() {
+    // Tests are registered via TEST macros
+}
+
+namespace {
+
+constexpr std::int64_t kMs = 1000000;
+constexpr std::int64_t kStart = 1000 * kMs;
+
+TelemetryMessage sample() {
+    TelemetryMessage msg;
+    msg.uavId = "uav1";
+    msg.lat = 31.0;
+    msg.lon = 121.0;
+    msg.alt = 50.0;
+    msg.yaw = 0.5;
+    msg.batteryPercent = 90.0;
+    msg.batteryVoltageMv = 16000;
+    msg.gpsFixType = 3;
+    msg.numSat = 12;
+    msg.linkQuality = 1.0f;
+    msg.flightMode = "AUTO.MISSION";
+    return msg;
+}
+
+// 编码一条并解码帧信息；返回 false 表示本条无需发送
+bool encodeOne(TelemetryDeltaEncoder& enc, const TelemetryMessage& msg, std::int64_t nowNs,
+               TelemetryFrameInfo* info = nullptr, TelemetryMessage* decoded = nullptr) {
+    std::uint8_t buf[kTelemetryFrameMaxBytes];
+    const std::size_t n = enc.encode(msg, nowNs, buf, sizeof(buf));
+    if (n == 0) {
+        return false;
+    }
+    TelemetryMessage out;
+    TelemetryFrameInfo frameInfo;
+    EXPECT_TRUE(decodeTelemetryFrame(buf, n, out, &frameInfo));
+    if (info) *info = frameInfo;
+    if (decoded) *decoded = out;
+    return true;
+}
+
+} // namespace
+
+TEST(TelemetryDeltaEncoderTest, FirstFrameIsKeyframe) {
+    TelemetryDeltaEncoder enc;
+    TelemetryFrameInfo info;
+    TelemetryMessage out;
+    ASSERT_TRUE(encodeOne(enc, sample(), kStart, &info, &out));
+    EXPECT_TRUE(info.delta);
+    EXPECT_TRUE(info.keyframe);
+    EXPECT_EQ(info.groups, kTelemetryAllGroups);
+    EXPECT_EQ(info.seq, 1u);
+    EXPECT_EQ(out.flightMode, "AUTO.MISSION");
+    EXPECT_EQ(enc.stats().keyframes, 1u);
+}
+
+TEST(TelemetryDeltaEncoderTest, UnchangedInputOnlySendsHeartbeat) {
+    TelemetryDeltaEncoder enc;
+    const TelemetryMessage msg = sample();
+    ASSERT_TRUE(encodeOne(enc, msg, kStart));
+    EXPECT_FALSE(encodeOne(enc, msg, kStart + 100 * kMs));
+    EXPECT_FALSE(encodeOne(enc, msg, kStart + 900 * kMs));
+
+    TelemetryFrameInfo info;
+    ASSERT_TRUE(encodeOne(enc, msg, kStart + 1000 * kMs, &info));
+    EXPECT_FALSE(info.keyframe);
+    EXPECT_EQ(info.groups, 0u);
+    EXPECT_EQ(info.seq, 2u);
+    EXPECT_EQ(enc.stats().heartbeats, 1u);
+    EXPECT_EQ(enc.stats().inputs, 4u);
+    EXPECT_EQ(enc.stats().frames, 2u);
+}
+
+TEST(TelemetryDeltaEncoderTest, PositionIsRateLimitedAndDeadbanded) {
+    TelemetryDeltaConfig cfg;
+    cfg.keyframeIntervalSec = 0.0;
+    TelemetryDeltaEncoder enc(cfg);
+    TelemetryMessage msg = sample();
+    ASSERT_TRUE(encodeOne(enc, msg, kStart));
+
+    // 50 Hz 输入、每次移动约 1 m：位置组最多 10 Hz
+    int positionFrames = 0;
+    for (int i = 1; i <= 50; ++i) {
+        msg.lat += 1e-5;
+        TelemetryFrameInfo info;
+        if (encodeOne(enc, msg, kStart + i * 20 * kMs, &info)) {
+            EXPECT_EQ(info.groups, static_cast<std::uint32_t>(TelemetryGroupPosition));
+            ++positionFrames;
+        }
+    }
+    EXPECT_GE(positionFrames, 9);
+    EXPECT_LE(positionFrames, 10);
+
+    // 死区内的抖动（约 1 cm）不发送（距上一帧不足心跳间隔）
+    msg.lat += 1e-7;
+    EXPECT_FALSE(encodeOne(enc, msg, kStart + 1200 * kMs));
+}
+
+TEST(TelemetryDeltaEncoderTest, BatteryFollowsSlowRate) {
+    TelemetryDeltaConfig cfg;
+    cfg.keyframeIntervalSec = 0.0;
+    TelemetryDeltaEncoder enc(cfg);
+    TelemetryMessage msg = sample();
+    ASSERT_TRUE(encodeOne(enc, msg, kStart));
+
+    // 10 s 内电量每 100 ms 下降 1%：0.2 Hz 只发送约 2 次
+    for (int i = 1; i <= 100; ++i) {
+        msg.batteryPercent -= 0.5;
+        encodeOne(enc, msg, kStart + i * 100 * kMs);
+    }
+    const std::uint64_t batterySent = enc.stats().groupsSent[3] - 1;  // 扣除首个关键帧
+    EXPECT_GE(batterySent, 1u);
+    EXPECT_LE(batterySent, 2u);
+}
+
+TEST(TelemetryDeltaEncoderTest, ModeChangeIsSentPromptly) {
+    TelemetryDeltaEncoder enc;
+    TelemetryMessage msg = sample();
+    ASSERT_TRUE(encodeOne(enc, msg, kStart));
+    msg.flightMode = "AUTO.RTL";
+    TelemetryFrameInfo info;
+    TelemetryMessage out;
+    ASSERT_TRUE(encodeOne(enc, msg, kStart + 250 * kMs, &info, &out));
+    EXPECT_EQ(info.groups, static_cast<std::uint32_t>(TelemetryGroupMode));
+    EXPECT_EQ(out.flightMode, "AUTO.RTL");
+}
+
+TEST(TelemetryDeltaEncoderTest, LowLinkQualityLowersContinuousRates) {
+    TelemetryDeltaConfig cfg;
+    cfg.keyframeIntervalSec = 0.0;
+    TelemetryDeltaEncoder enc(cfg);
+    TelemetryMessage msg = sample();
+    msg.linkQuality = 0.2f;  // 位置组 10 Hz × 0.2 = 2 Hz
+    ASSERT_TRUE(encodeOne(enc, msg, kStart));
+
+    for (int i = 1; i <= 100; ++i) {
+        msg.lat += 1e-5;
+        encodeOne(enc, msg, kStart + i * 20 * kMs);
+    }
+    const std::uint64_t positionSent = enc.stats().groupsSent[0] - 1;
+    EXPECT_GE(positionSent, 3u);
+    EXPECT_LE(positionSent, 4u);
+}
+
+TEST(TelemetryDeltaEncoderTest, ByteBudgetDefersContinuousGroups) {
+    TelemetryDeltaConfig cfg;
+    cfg.keyframeIntervalSec = 0.0;
+    cfg.maxBytesPerSec = 200.0;
+    TelemetryDeltaEncoder enc(cfg);
+    TelemetryMessage msg = sample();
+    ASSERT_TRUE(encodeOne(enc, msg, kStart));
+
+    for (int i = 1; i <= 300; ++i) {
+        msg.lat += 1e-5;
+        msg.yaw += 0.05;
+        msg.vx = (i % 2) ? 1.0 : 2.0;
+        encodeOne(enc, msg, kStart + i * 10 * kMs);
+    }
+    const TelemetryDeltaStats& stats = enc.stats();
+    EXPECT_GT(stats.deferred, 0u);
+    // 3 s 内：1 秒突发 + 3 秒预算，外加不受限的心跳
+    EXPECT_LE(stats.bytes, 200u * 4 + 3 * 16);
+
+    // 离散量不受预算限制
+    msg.flightMode = "AUTO.LAND";
+    TelemetryFrameInfo info;
+    ASSERT_TRUE(encodeOne(enc, msg, kStart + 3010 * kMs, &info));
+    EXPECT_TRUE(info.groups & TelemetryGroupMode);
+}
+
+TEST(TelemetryDeltaEncoderTest, KeyframeIntervalAndReset) {
+    TelemetryDeltaConfig cfg;
+    cfg.keyframeIntervalSec = 2.0;
+    TelemetryDeltaEncoder enc(cfg);
+    const TelemetryMessage msg = sample();
+    ASSERT_TRUE(encodeOne(enc, msg, kStart));
+
+    TelemetryFrameInfo info;
+    ASSERT_TRUE(encodeOne(enc, msg, kStart + 2000 * kMs, &info));
+    EXPECT_TRUE(info.keyframe);
+
+    enc.reset();
+    ASSERT_TRUE(encodeOne(enc, msg, kStart + 2100 * kMs, &info));
+    EXPECT_TRUE(info.keyframe);
+    EXPECT_EQ(info.seq, 1u);
+}
+
+TEST(TelemetryDeltaEncoderTest, StateIsTrackedPerUav) {
+    TelemetryDeltaEncoder enc;
+    TelemetryMessage a = sample();
+    TelemetryMessage b = sample();
+    b.uavId = "uav2";
+    TelemetryFrameInfo info;
+    ASSERT_TRUE(encodeOne(enc, a, kStart, &info));
+    EXPECT_TRUE(info.keyframe);
+    ASSERT_TRUE(encodeOne(enc, b, kStart + kMs, &info));
+    EXPECT_TRUE(info.keyframe);
+    EXPECT_FALSE(encodeOne(enc, a, kStart + 2 * kMs));
+}
+
+TEST(TelemetryDeltaEncoderTest, ReceiverReconstructsStream) {
+    TelemetryDeltaEncoder enc;
+    TelemetryMessage msg = sample();
+    TelemetryMessage state;
+    bool primed = false;
+    auto feed = [&](std::int64_t nowNs) {
+        TelemetryFrameInfo info;
+        TelemetryMessage out;
+        if (!encodeOne(enc, msg, nowNs, &info, &out)) return;
+        if (info.keyframe) {
+            state = out;
+            primed = true;
+        } else {
+            ASSERT_TRUE(primed);
+            mergeTelemetryGroups(out, info.groups, state);
+        }
+    };
+    // 6 s、50 Hz：中途经过一次关键帧（5 s）
+    for (int i = 0; i < 300; ++i) {
+        msg.lat += 2e-6 * (i % 7);
+        msg.roll = 0.001 * i;
+        msg.batteryPercent -= 0.01;
+        if (i == 120) msg.flightMode = "AUTO.RTL";
+        feed(kStart + i * 20 * kMs);
+    }
+    feed(kStart + 6200 * kMs);  // 输入停止后，各连续量组在各自间隔内追上最新值
+
+    // 接收端状态与发送端源数据的差异不超过各组死区
+    EXPECT_EQ(state.flightMode, "AUTO.RTL");
+    EXPECT_NEAR(state.lat, msg.lat, 0.2 / 111320.0);
+    EXPECT_NEAR(state.roll, msg.roll, 0.01);
+    EXPECT_NEAR(state.batteryPercent, msg.batteryPercent, 0.5 + 1e-3);
+}
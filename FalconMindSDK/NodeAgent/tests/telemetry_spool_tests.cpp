@@ -0,0 +1,223 @@
+// NodeAgent - TelemetrySpool store-and-forward tests
+#include <gtest/gtest.h>
+#include "nodeagent/TelemetrySpool.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace nodeagent;
+
+void registerTelemetrySpoolTests() {
+    // Tests are registered via TEST macros
+}
+
+namespace {
+
+constexpr std::int64_t kSec = 1000000000LL;
+
+class TempDir {
+public:
+    TempDir() {
+        char tmpl[] = "/tmp/nodeagent_spool_XXXXXX";
+        const char* p = mkdtemp(tmpl);
+        path_ = p ? p : "";
+    }
+    ~TempDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+TelemetrySpoolConfig spoolConfig(const std::string& dir) {
+    TelemetrySpoolConfig cfg;
+    cfg.directory = dir;
+    cfg.segmentBytes = 4096;
+    cfg.maxBytes = 1u << 20;
+    cfg.drainBytesPerSec = 1e9;
+    cfg.drainBurstBytes = 1u << 20;
+    return cfg;
+}
+
+bool appendText(TelemetrySpool& spool, SpoolClass cls, const std::string& text, std::int64_t ts = 0) {
+    return spool.append(cls, text.data(), text.size(), ts);
+}
+
+// 取出当前可补发的全部记录
+std::vector<std::pair<SpoolClass, std::string>> drainAll(TelemetrySpool& spool, std::int64_t nowNs = kSec) {
+    std::vector<std::pair<SpoolClass, std::string>> out;
+    spool.drain(nowNs, [&](SpoolClass cls, const std::uint8_t* data, std::size_t size, std::int64_t) {
+        out.emplace_back(cls, std::string(reinterpret_cast<const char*>(data), size));
+        return true;
+    });
+    return out;
+}
+
+std::size_t spoolFileCount(const std::string& dir) {
+    std::size_t n = 0;
+    for (const auto& e : std::filesystem::directory_iterator(dir)) {
+        if (e.path().extension() == ".spool") ++n;
+    }
+    return n;
+}
+
+} // namespace
+
+TEST(TelemetrySpoolTest, DisabledWithoutDirectory) {
+    EXPECT_EQ(TelemetrySpool::open(TelemetrySpoolConfig{}), nullptr);
+}
+
+TEST(TelemetrySpoolTest, DrainsInPriorityOrder) {
+    TempDir dir;
+    auto spool = TelemetrySpool::open(spoolConfig(dir.path()));
+    ASSERT_NE(spool, nullptr);
+    EXPECT_TRUE(spool->empty());
+    ASSERT_TRUE(appendText(*spool, SpoolClass::Telemetry, "t1"));
+    ASSERT_TRUE(appendText(*spool, SpoolClass::Event, "e1"));
+    ASSERT_TRUE(appendText(*spool, SpoolClass::Detection, "d1"));
+    ASSERT_TRUE(appendText(*spool, SpoolClass::Event, "e2"));
+    ASSERT_TRUE(appendText(*spool, SpoolClass::Telemetry, "t2"));
+    EXPECT_FALSE(spool->empty());
+
+    const auto out = drainAll(*spool);
+    ASSERT_EQ(out.size(), 5u);
+    EXPECT_EQ(out[0].second, "e1");
+    EXPECT_EQ(out[1].second, "e2");
+    EXPECT_EQ(out[2].second, "d1");
+    EXPECT_EQ(out[3].second, "t1");
+    EXPECT_EQ(out[4].second, "t2");
+    EXPECT_EQ(out[2].first, SpoolClass::Detection);
+    EXPECT_TRUE(spool->empty());
+    const TelemetrySpoolStats stats = spool->stats();
+    EXPECT_EQ(stats.appended[0], 2u);
+    EXPECT_EQ(stats.drained[2], 2u);
+}
+
+TEST(TelemetrySpoolTest, DrainIsRateLimited) {
+    TempDir dir;
+    TelemetrySpoolConfig cfg = spoolConfig(dir.path());
+    cfg.drainBytesPerSec = 1000;
+    cfg.drainBurstBytes = 1000;
+    auto spool = TelemetrySpool::open(cfg);
+    ASSERT_NE(spool, nullptr);
+    const std::string payload(100, 'x');
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(appendText(*spool, SpoolClass::Telemetry, payload));
+    }
+    EXPECT_EQ(drainAll(*spool, 10 * kSec).size(), 10u);           // 满桶突发
+    EXPECT_EQ(drainAll(*spool, 10 * kSec).size(), 0u);            // 令牌耗尽
+    EXPECT_EQ(drainAll(*spool, 10 * kSec + kSec / 2).size(), 5u);  // 0.5 s 补充 500 字节
+    EXPECT_EQ(spool->stats().pending[2], 85u);
+}
+
+TEST(TelemetrySpoolTest, FailedSendKeepsRecord) {
+    TempDir dir;
+    auto spool = TelemetrySpool::open(spoolConfig(dir.path()));
+    ASSERT_NE(spool, nullptr);
+    ASSERT_TRUE(appendText(*spool, SpoolClass::Event, "mission_done"));
+    int calls = 0;
+    EXPECT_EQ(spool->drain(kSec, [&](SpoolClass, const std::uint8_t*, std::size_t, std::int64_t) {
+                  ++calls;
+                  return false;
+              }),
+              0u);
+    EXPECT_EQ(calls, 1);
+    const auto out = drainAll(*spool, 2 * kSec);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0].second, "mission_done");
+}
+
+TEST(TelemetrySpoolTest, RecoversPendingRecordsAfterRestart) {
+    TempDir dir;
+    {
+        auto spool = TelemetrySpool::open(spoolConfig(dir.path()));
+        ASSERT_NE(spool, nullptr);
+        for (int i = 0; i < 60; ++i) {  // 跨越多个 4 KiB 段
+            ASSERT_TRUE(appendText(*spool, SpoolClass::Event, "event-" + std::to_string(i) + std::string(100, '.')));
+        }
+        std::size_t taken = 0;
+        spool->drain(kSec, [&](SpoolClass, const std::uint8_t*, std::size_t, std::int64_t) { return ++taken <= 20; });
+        EXPECT_EQ(spool->stats().pending[0], 40u);
+    }
+    auto spool = TelemetrySpool::open(spoolConfig(dir.path()));
+    ASSERT_NE(spool, nullptr);
+    EXPECT_EQ(spool->stats().recovered, 40u);
+    EXPECT_EQ(spool->stats().corrupt, 0u);
+    const auto out = drainAll(*spool);
+    ASSERT_EQ(out.size(), 40u);
+    EXPECT_EQ(out.front().second.substr(0, 9), "event-20.");
+    EXPECT_EQ(out.back().second.substr(0, 9), "event-59.");
+    // 追加继续写在恢复的段之后
+    ASSERT_TRUE(appendText(*spool, SpoolClass::Event, "after"));
+    EXPECT_EQ(drainAll(*spool, 2 * kSec).at(0).second, "after");
+}
+
+TEST(TelemetrySpoolTest, TruncatesDamagedRecordsOnRecovery) {
+    TempDir dir;
+    std::string segment;
+    {
+        auto spool = TelemetrySpool::open(spoolConfig(dir.path()));
+        ASSERT_NE(spool, nullptr);
+        ASSERT_TRUE(appendText(*spool, SpoolClass::Detection, "first"));
+        ASSERT_TRUE(appendText(*spool, SpoolClass::Detection, "second"));
+        ASSERT_TRUE(appendText(*spool, SpoolClass::Detection, "third"));
+    }
+    for (const auto& e : std::filesystem::directory_iterator(dir.path())) {
+        segment = e.path().string();
+    }
+    ASSERT_FALSE(segment.empty());
+    // 破坏第二条记录的载荷（数据区从 64 字节开始，每条记录 16 字节头 + 载荷按 8 字节对齐）
+    {
+        std::fstream f(segment, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(64 + 24 + 16);
+        f.put('X');
+    }
+    auto spool = TelemetrySpool::open(spoolConfig(dir.path()));
+    ASSERT_NE(spool, nullptr);
+    EXPECT_EQ(spool->stats().corrupt, 1u);
+    const auto out = drainAll(*spool);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0].second, "first");
+}
+
+TEST(TelemetrySpoolTest, EvictsRoutineTelemetryBeforeEvents) {
+    TempDir dir;
+    TelemetrySpoolConfig cfg = spoolConfig(dir.path());
+    cfg.maxBytes = 3 * 4096;
+    auto spool = TelemetrySpool::open(cfg);
+    ASSERT_NE(spool, nullptr);
+    const std::string frame(120, 't');
+    ASSERT_TRUE(appendText(*spool, SpoolClass::Event, "takeoff"));
+    for (int i = 0; i < 300; ++i) {
+        ASSERT_TRUE(appendText(*spool, SpoolClass::Telemetry, frame));
+    }
+    ASSERT_TRUE(appendText(*spool, SpoolClass::Event, "landed"));
+
+    const TelemetrySpoolStats stats = spool->stats();
+    EXPECT_LE(stats.bytesOnDisk, cfg.maxBytes);
+    EXPECT_GT(stats.evicted[2], 0u);
+    EXPECT_EQ(stats.evicted[0], 0u);
+    EXPECT_EQ(stats.pending[2] + stats.evicted[2], 300u);
+    EXPECT_LE(spoolFileCount(dir.path()), 3u);
+
+    const auto out = drainAll(*spool);
+    ASSERT_GE(out.size(), 2u);
+    EXPECT_EQ(out[0].second, "takeoff");
+    EXPECT_EQ(out[1].second, "landed");
+}
+
+TEST(TelemetrySpoolTest, RejectsRecordLargerThanSegment) {
+    TempDir dir;
+    auto spool = TelemetrySpool::open(spoolConfig(dir.path()));
+    ASSERT_NE(spool, nullptr);
+    EXPECT_FALSE(appendText(*spool, SpoolClass::Event, std::string(8192, 'x')));
+    EXPECT_TRUE(spool->empty());
+}
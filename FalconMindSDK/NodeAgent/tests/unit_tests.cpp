@@ -9,6 +9,16 @@ extern void registerMultiUavTests();
 extern void registerLoggerTests();
 extern void registerErrorStatisticsTests();
 extern void registerReconnectManagerTests();
+extern void registerUplinkClientTests();
+extern void registerTelemetryDeltaEncoderTests();
+extern void registerTelemetrySpoolTests();
+extern void registerEventLoopTests();
+extern void registerDownlinkClientTests();
+extern void registerDefinitionTransferTests();
+extern void registerQuicTransportTests();
+extern void registerClockSyncTests();
+extern void registerSwarmLinkTests();
+extern void registerPayloadCompressionTests();
 
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -21,6 +31,16 @@ int main(int argc, char** argv) {
     registerLoggerTests();
     registerErrorStatisticsTests();
     registerReconnectManagerTests();
+    registerUplinkClientTests();
+    registerTelemetryDeltaEncoderTests();
+    registerTelemetrySpoolTests();
+    registerEventLoopTests();
+    registerDownlinkClientTests();
+    registerDefinitionTransferTests();
+    registerQuicTransportTests();
+    registerClockSyncTests();
+    registerSwarmLinkTests();
+    registerPayloadCompressionTests();
     
     return RUN_ALL_TESTS();
 }
@@ -0,0 +1,515 @@
+// NodeAgent - UplinkClient telemetry encoding negotiation tests
+#include <gtest/gtest.h>
+#include "nodeagent/UplinkClient.h"
+#include "nodeagent/DownlinkClient.h"
+#include "nodeagent/PayloadCompression.h"
+#include "falconmind/sdk/telemetry/TelemetryCodec.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace nodeagent;
+using falconmind::sdk::telemetry::TelemetryMessage;
+
+void registerUplinkClientTests() {
+    // Tests are registered via TEST macros
+}
+
+namespace {
+
+// 单连接的本地 TCP 服务端，扮演 Cluster Center
+class LocalServer {
+public:
+    LocalServer() {
+        listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+        int opt = 1;
+        setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listenFd_, 1);
+        socklen_t len = sizeof(addr);
+        getsockname(listenFd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+    }
+    ~LocalServer() {
+        if (clientFd_ >= 0) close(clientFd_);
+        close(listenFd_);
+    }
+
+    int port() const { return port_; }
+    int accept() {
+        clientFd_ = ::accept(listenFd_, nullptr, nullptr);
+        return clientFd_;
+    }
+    void sendText(const std::string& text) { send(clientFd_, text.data(), text.size(), 0); }
+
+    // 读取直到缓冲区中至少有 count 字节（或超时）
+    std::string readAtLeast(std::size_t count, int timeoutMs = 1000) {
+        while (buffer_.size() < count) {
+            pollfd pfd{clientFd_, POLLIN, 0};
+            if (poll(&pfd, 1, timeoutMs) <= 0) break;
+            char chunk[1024];
+            ssize_t n = recv(clientFd_, chunk, sizeof(chunk), 0);
+            if (n <= 0) break;
+            buffer_.append(chunk, static_cast<std::size_t>(n));
+        }
+        return buffer_;
+    }
+    std::string readLine(int timeoutMs = 1000) {
+        for (;;) {
+            auto pos = buffer_.find('\n');
+            if (pos != std::string::npos) {
+                std::string line = buffer_.substr(0, pos);
+                buffer_.erase(0, pos + 1);
+                return line;
+            }
+            const std::size_t before = buffer_.size();
+            readAtLeast(before + 1, timeoutMs);
+            if (buffer_.size() == before) return {};
+        }
+    }
+    std::string& buffer() { return buffer_; }
+
+private:
+    int listenFd_{-1};
+    int clientFd_{-1};
+    int port_{0};
+    std::string buffer_;
+};
+
+TelemetryMessage sampleTelemetry() {
+    TelemetryMessage msg;
+    msg.uavId = "uav3";
+    msg.timestampNs = 1700000000123456789LL;
+    msg.lat = 31.2304;
+    msg.lon = 121.4737;
+    msg.alt = 120.5;
+    msg.roll = 0.02;
+    msg.pitch = -0.05;
+    msg.yaw = 1.57;
+    msg.vx = 5.0;
+    msg.vy = -1.0;
+    msg.vz = 0.2;
+    msg.batteryPercent = 76.0;
+    msg.batteryVoltageMv = 22800;
+    msg.gpsFixType = 3;
+    msg.numSat = 17;
+    msg.linkQuality = 0.9;
+    msg.flightMode = "AUTO.MISSION";
+    return msg;
+}
+
+UplinkClient::Config clientConfig(int port, TelemetryEncoding encoding, int timeoutMs = 300) {
+    UplinkClient::Config cfg;
+    cfg.centerAddress = "127.0.0.1";
+    cfg.centerPort = port;
+    cfg.telemetryEncoding = encoding;
+    cfg.negotiateTimeoutMs = timeoutMs;
+    return cfg;
+}
+
+} // namespace
+
+TEST(UplinkClientTest, NegotiatesBinaryTelemetry) {
+    LocalServer server;
+    std::string hello;
+    std::thread peer([&]() {
+        ASSERT_GE(server.accept(), 0);
+        hello = server.readLine();
+        server.sendText("HELLO:{\"telemetry_encoding\":\"proto1\"}\n");
+    });
+    UplinkClient client(clientConfig(server.port(), TelemetryEncoding::Auto));
+    ASSERT_TRUE(client.connect());
+    peer.join();
+    EXPECT_NE(hello.find("\"hello\""), std::string::npos);
+    EXPECT_NE(hello.find("proto1"), std::string::npos);
+    EXPECT_EQ(client.activeTelemetryEncoding(), TelemetryEncoding::Binary);
+
+    const TelemetryMessage sent = sampleTelemetry();
+    ASSERT_TRUE(client.sendTelemetry(sent));
+    using falconmind::sdk::telemetry::kTelemetryFrameHeaderBytes;
+    server.readAtLeast(kTelemetryFrameHeaderBytes);
+    ASSERT_GE(server.buffer().size(), kTelemetryFrameHeaderBytes);
+    const auto* header = reinterpret_cast<const std::uint8_t*>(server.buffer().data());
+    ASSERT_EQ(header[0], falconmind::sdk::telemetry::kTelemetryFrameMagic);
+    const std::size_t frameLen = kTelemetryFrameHeaderBytes + (header[2] | (header[3] << 8));
+    server.readAtLeast(frameLen);
+    ASSERT_EQ(falconmind::sdk::telemetry::telemetryFrameLength(
+                  reinterpret_cast<const std::uint8_t*>(server.buffer().data()), server.buffer().size()),
+              frameLen);
+    // 同样内容的 JSON 行约 400 字节
+    EXPECT_LT(frameLen, 120u);
+
+    TelemetryMessage received;
+    ASSERT_TRUE(falconmind::sdk::telemetry::decodeTelemetryFrame(
+        reinterpret_cast<const std::uint8_t*>(server.buffer().data()), frameLen, received));
+    EXPECT_EQ(received.uavId, sent.uavId);
+    EXPECT_EQ(received.timestampNs, sent.timestampNs);
+    EXPECT_DOUBLE_EQ(received.lat, sent.lat);
+    EXPECT_NEAR(received.alt, sent.alt, 1e-4);
+    EXPECT_EQ(received.batteryVoltageMv, sent.batteryVoltageMv);
+    EXPECT_EQ(received.flightMode, sent.flightMode);
+
+    // 通用消息仍为 JSON 行
+    server.buffer().erase(0, frameLen);
+    ASSERT_TRUE(client.sendMessage("{\"type\":\"flow_status\"}"));
+    EXPECT_EQ(server.readLine(), "{\"type\":\"flow_status\"}");
+}
+
+TEST(UplinkClientTest, NegotiatesPayloadCompression) {
+    if (!PayloadCodec::available()) {
+        GTEST_SKIP() << "built without zstd";
+    }
+    PayloadCompressionConfig config;
+    config.enabled = true;
+    auto codec = PayloadCodec::create(config);
+    ASSERT_TRUE(codec);
+    std::string events;
+    for (int i = 0; i < 40; ++i) {
+        events += "{\"class\":\"person\",\"score\":0.9,\"track_id\":" + std::to_string(i) + "},";
+    }
+    const std::string message = "{\"type\":\"detection\",\"detections\":[" + events + "{}]}";
+
+    // 固定 JSON 遥测编码时也发送 hello，但只通告 json
+    LocalServer server;
+    std::string hello;
+    std::thread peer([&]() {
+        ASSERT_GE(server.accept(), 0);
+        hello = server.readLine();
+        server.sendText("HELLO:{\"telemetry_encoding\":\"json\",\"compression\":\"zstd\",\"zstd_dictionaries\":[]}\n");
+    });
+    UplinkClient client(clientConfig(server.port(), TelemetryEncoding::Json));
+    client.setPayloadCodec(codec);
+    ASSERT_TRUE(client.connect());
+    peer.join();
+    EXPECT_NE(hello.find("\"compression\":[\"zstd\"]"), std::string::npos);
+    EXPECT_EQ(hello.find("proto1"), std::string::npos);
+    EXPECT_TRUE(client.compressionActive());
+    EXPECT_EQ(client.activeTelemetryEncoding(), TelemetryEncoding::Json);
+
+    ASSERT_TRUE(client.sendMessage(message));
+    ASSERT_TRUE(client.sendMessage("{\"type\":\"ping\"}"));  // 短消息仍为文本行
+    server.readAtLeast(kDownlinkFrameHeaderBytes);
+    ASSERT_GE(server.buffer().size(), kDownlinkFrameHeaderBytes);
+    const auto* header = reinterpret_cast<const std::uint8_t*>(server.buffer().data());
+    ASSERT_EQ(header[0], kDownlinkFrameMagic);
+    const std::uint32_t field = header[1] | (header[2] << 8) | (header[3] << 16) | (static_cast<std::uint32_t>(header[4]) << 24);
+    ASSERT_TRUE(field & kFrameCompressedFlag);
+    const std::size_t length = field & ~kFrameCompressedFlag;
+    EXPECT_LT(length * 5, message.size());
+    server.readAtLeast(kDownlinkFrameHeaderBytes + length);
+    std::string inflated;
+    ASSERT_TRUE(codec->decompress(server.buffer().data() + kDownlinkFrameHeaderBytes, length, 1 << 20, inflated));
+    EXPECT_EQ(inflated, message);
+    server.buffer().erase(0, kDownlinkFrameHeaderBytes + length);
+    EXPECT_EQ(server.readLine(), "{\"type\":\"ping\"}");
+}
+
+TEST(UplinkClientTest, KeepsTextWhenPeerDeclinesCompression) {
+    PayloadCompressionConfig config;
+    config.enabled = true;
+    auto codec = PayloadCodec::create(config);
+    LocalServer server;
+    std::thread peer([&]() {
+        ASSERT_GE(server.accept(), 0);
+        server.readLine();
+        server.sendText("HELLO:{\"telemetry_encoding\":\"proto1\"}\n");  // 旧版 Cluster Center
+    });
+    UplinkClient client(clientConfig(server.port(), TelemetryEncoding::Auto));
+    client.setPayloadCodec(codec);
+    ASSERT_TRUE(client.connect());
+    peer.join();
+    EXPECT_FALSE(client.compressionActive());
+    EXPECT_EQ(client.activeTelemetryEncoding(), TelemetryEncoding::Binary);
+    const std::string message = "{\"type\":\"flow_status\",\"detail\":\"" + std::string(600, 'x') + "\"}";
+    ASSERT_TRUE(client.sendMessage(message));
+    EXPECT_EQ(server.readLine(), message);
+}
+
+TEST(UplinkClientTest, FallsBackToJsonWithoutHelloReply) {
+    LocalServer server;
+    std::thread peer([&]() { ASSERT_GE(server.accept(), 0); });
+    UplinkClient client(clientConfig(server.port(), TelemetryEncoding::Auto, 100));
+    ASSERT_TRUE(client.connect());
+    peer.join();
+    EXPECT_EQ(client.activeTelemetryEncoding(), TelemetryEncoding::Json);
+
+    ASSERT_TRUE(client.sendTelemetry(sampleTelemetry()));
+    EXPECT_NE(server.readLine().find("\"hello\""), std::string::npos);
+    const std::string line = server.readLine();
+    ASSERT_FALSE(line.empty());
+    EXPECT_EQ(line[0], '{');
+    EXPECT_NE(line.find("\"uav3\""), std::string::npos);
+}
+
+TEST(UplinkClientTest, LeavesLegacyDownlinkDataUnread) {
+    LocalServer server;
+    std::thread peer([&]() {
+        ASSERT_GE(server.accept(), 0);
+        server.sendText("CMD:{\"type\":\"arm\"}\n");
+    });
+    UplinkClient client(clientConfig(server.port(), TelemetryEncoding::Auto, 500));
+    ASSERT_TRUE(client.connect());
+    peer.join();
+    EXPECT_EQ(client.activeTelemetryEncoding(), TelemetryEncoding::Json);
+
+    // 下行数据未被协商过程消费，DownlinkClient 复用同一 socket 仍能读到
+    char buf[64] = {};
+    pollfd pfd{client.getSocketFd(), POLLIN, 0};
+    ASSERT_GT(poll(&pfd, 1, 1000), 0);
+    ssize_t n = recv(client.getSocketFd(), buf, sizeof(buf) - 1, 0);
+    ASSERT_GT(n, 0);
+    EXPECT_EQ(std::string(buf, static_cast<std::size_t>(n)), "CMD:{\"type\":\"arm\"}\n");
+}
+
+TEST(UplinkClientTest, JsonEncodingSkipsNegotiation) {
+    LocalServer server;
+    std::thread peer([&]() { ASSERT_GE(server.accept(), 0); });
+    UplinkClient client(clientConfig(server.port(), TelemetryEncoding::Json));
+    ASSERT_TRUE(client.connect());
+    peer.join();
+    ASSERT_TRUE(client.sendTelemetry(sampleTelemetry()));
+    const std::string line = server.readLine();
+    EXPECT_EQ(line.find("\"hello\""), std::string::npos);
+    EXPECT_NE(line.find("\"timestamp_ns\""), std::string::npos);
+}
+
+TEST(UplinkClientTest, CoalescesSmallMessagesIntoFewWrites) {
+    LocalServer server;
+    std::thread peer([&]() { ASSERT_GE(server.accept(), 0); });
+    UplinkClient::Config cfg = clientConfig(server.port(), TelemetryEncoding::Json);
+    cfg.maxCoalesceDelayMs = 50;
+    UplinkClient client(cfg);
+    ASSERT_TRUE(client.connect());
+    peer.join();
+
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_TRUE(client.sendMessage("{\"seq\":" + std::to_string(i) + "}"));
+    }
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(server.readLine(), "{\"seq\":" + std::to_string(i) + "}");
+    }
+    const UplinkStats stats = client.stats();
+    EXPECT_EQ(stats.messages, 20u);
+    EXPECT_LE(stats.writes, 2u);
+    EXPECT_EQ(stats.partialWrites, 0u);
+}
+
+TEST(UplinkClientTest, LatencyCapFlushesLoneMessage) {
+    LocalServer server;
+    std::thread peer([&]() { ASSERT_GE(server.accept(), 0); });
+    UplinkClient::Config cfg = clientConfig(server.port(), TelemetryEncoding::Json);
+    cfg.maxCoalesceDelayMs = 20;
+    UplinkClient client(cfg);
+    ASSERT_TRUE(client.connect());
+    peer.join();
+
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(client.sendMessage("{\"type\":\"flow_status\"}"));
+    EXPECT_EQ(server.readLine(), "{\"type\":\"flow_status\"}");
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+    EXPECT_EQ(client.stats().timerFlushes, 1u);
+}
+
+TEST(UplinkClientTest, ExternalFlushSchedulerReplacesFlusherThread) {
+    LocalServer server;
+    std::thread peer([&]() { ASSERT_GE(server.accept(), 0); });
+    UplinkClient::Config cfg = clientConfig(server.port(), TelemetryEncoding::Json);
+    cfg.maxCoalesceDelayMs = 20;
+    UplinkClient client(cfg);
+    std::vector<int> requests;
+    client.setFlushScheduler([&](int delayMs) { requests.push_back(delayMs); });
+    ASSERT_TRUE(client.connect());
+    peer.join();
+
+    // 缓冲由空变非空时只请求一次调度；到期前没有后台线程写出
+    ASSERT_TRUE(client.sendMessage("{\"seq\":1}"));
+    ASSERT_TRUE(client.sendMessage("{\"seq\":2}"));
+    ASSERT_EQ(requests.size(), 1u);
+    EXPECT_EQ(requests[0], 20);
+    EXPECT_EQ(server.readLine(60), "");
+
+    ASSERT_TRUE(client.flushDue());
+    EXPECT_EQ(server.readLine(), "{\"seq\":1}");
+    EXPECT_EQ(server.readLine(), "{\"seq\":2}");
+    EXPECT_EQ(client.stats().timerFlushes, 1u);
+    EXPECT_EQ(client.stats().writes, 1u);
+
+    ASSERT_TRUE(client.sendMessage("{\"seq\":3}"));
+    EXPECT_EQ(requests.size(), 2u);
+    client.disconnect();
+}
+
+TEST(UplinkClientTest, LargeMessageWrittenWithBufferedDataInOrder) {
+    LocalServer server;
+    std::thread peer([&]() { ASSERT_GE(server.accept(), 0); });
+    UplinkClient::Config cfg = clientConfig(server.port(), TelemetryEncoding::Json);
+    cfg.maxCoalesceDelayMs = 1000;
+    UplinkClient client(cfg);
+    ASSERT_TRUE(client.connect());
+    peer.join();
+
+    const std::string large = "{\"blob\":\"" + std::string(8000, 'x') + "\"}";
+    ASSERT_TRUE(client.sendMessage("{\"first\":1}"));
+    ASSERT_TRUE(client.sendMessage(large));
+    EXPECT_EQ(server.readLine(), "{\"first\":1}");
+    EXPECT_EQ(server.readLine(), large);
+    const UplinkStats stats = client.stats();
+    EXPECT_EQ(stats.writes, 1u);  // 缓冲数据与大消息一次 sendmsg
+    EXPECT_EQ(stats.timerFlushes, 0u);
+}
+
+TEST(UplinkClientTest, PartialWritesAreCompleted) {
+    LocalServer server;
+    std::thread peer([&]() { ASSERT_GE(server.accept(), 0); });
+    UplinkClient::Config cfg = clientConfig(server.port(), TelemetryEncoding::Json);
+    cfg.sendTimeoutMs = 50;  // 接收端读得慢：每次 sendmsg 超时返回已写出的部分
+    UplinkClient client(cfg);
+    ASSERT_TRUE(client.connect());
+    peer.join();
+    int sndbuf = 64 * 1024;
+    setsockopt(client.getSocketFd(), SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+
+    std::string large(2u << 20, 'a');
+    for (std::size_t i = 0; i < large.size(); i += 4096) {
+        large[i] = static_cast<char>('a' + (i / 4096) % 26);
+    }
+    std::string received;
+    std::thread reader([&]() {
+        while (received.size() < large.size() + 1) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            const std::size_t before = server.buffer().size();
+            server.readAtLeast(std::min(before + 16 * 1024, large.size() + 1), 2000);
+            if (server.buffer().size() == before) break;
+            received = server.buffer();
+        }
+    });
+    const bool ok = client.sendMessage(large);
+    reader.join();
+    ASSERT_TRUE(ok);
+    ASSERT_EQ(received.size(), large.size() + 1);
+    EXPECT_TRUE(received.compare(0, large.size(), large) == 0);
+    EXPECT_EQ(received.back(), '\n');
+    EXPECT_GT(client.stats().partialWrites, 0u);
+}
+
+namespace {
+
+// 合并阈值足够大且不启动后台线程：消息只在 Control 到达、flush() 或 flushDue() 时写出，便于观察调度顺序
+UplinkClient::Config laneConfig(int port) {
+    UplinkClient::Config cfg = clientConfig(port, TelemetryEncoding::Json);
+    cfg.coalesceBytes = 1u << 20;
+    cfg.maxCoalesceDelayMs = 1000;
+    return cfg;
+}
+
+// 99 字节载荷 + 换行 = 100 字节的一条消息
+std::string laneMessage(char tag, int seq) {
+    std::string msg = std::string("{\"l\":\"") + tag + "\",\"s\":" + std::to_string(seq) + ",\"p\":\"";
+    msg.append(99 - msg.size() - 2, 'x');
+    return msg + "\"}";
+}
+
+} // namespace
+
+TEST(UplinkClientTest, ControlMessagePreemptsQueuedBulkData) {
+    LocalServer server;
+    std::thread peer([&]() { ASSERT_GE(server.accept(), 0); });
+    UplinkClient client(laneConfig(server.port()));
+    client.setFlushScheduler([](int) {});
+    ASSERT_TRUE(client.connect());
+    peer.join();
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(client.sendMessage(laneMessage('B', i), UplinkPriority::Bulk));
+    }
+    ASSERT_TRUE(client.sendMessage("{\"type\":\"command_ack\"}", UplinkPriority::Control));
+    EXPECT_EQ(server.readLine(), "{\"type\":\"command_ack\"}");
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(server.readLine(), laneMessage('B', i));
+    }
+    const UplinkStats stats = client.stats();
+    EXPECT_EQ(stats.preemptions, 1u);
+    EXPECT_EQ(stats.laneMessages[static_cast<std::size_t>(UplinkPriority::Bulk)], 10u);
+    EXPECT_EQ(stats.laneMessages[static_cast<std::size_t>(UplinkPriority::Control)], 1u);
+}
+
+TEST(UplinkClientTest, WeightedLanesShareBandwidth) {
+    LocalServer server;
+    std::thread peer([&]() { ASSERT_GE(server.accept(), 0); });
+    UplinkClient::Config cfg = laneConfig(server.port());
+    cfg.laneQuantumBytes = 100;
+    cfg.laneWeights = {0, 3, 1, 1};
+    UplinkClient client(cfg);
+    client.setFlushScheduler([](int) {});
+    ASSERT_TRUE(client.connect());
+    peer.join();
+
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_TRUE(client.sendMessage(laneMessage('B', i), UplinkPriority::Bulk));
+    }
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_TRUE(client.sendMessage(laneMessage('E', i), UplinkPriority::Event));
+    }
+    ASSERT_TRUE(client.flush());
+
+    // 每轮 Event 写 3 条、Bulk 写 1 条；各通道内保持提交顺序
+    std::string order;
+    int nextEvent = 0;
+    int nextBulk = 0;
+    for (int i = 0; i < 12; ++i) {
+        const std::string line = server.readLine();
+        ASSERT_FALSE(line.empty());
+        const char tag = line[6];
+        order.push_back(tag);
+        EXPECT_EQ(line, laneMessage(tag, tag == 'E' ? nextEvent++ : nextBulk++));
+    }
+    EXPECT_EQ(order, "BEEEBEEEBBBB");
+}
+
+TEST(UplinkClientTest, FullBulkLaneRejectsWithoutDisconnecting) {
+    LocalServer server;
+    std::thread peer([&]() { ASSERT_GE(server.accept(), 0); });
+    UplinkClient::Config cfg = laneConfig(server.port());
+    cfg.maxBulkQueuedBytes = 300;
+    UplinkClient client(cfg);
+    client.setFlushScheduler([](int) {});
+    ASSERT_TRUE(client.connect());
+    peer.join();
+
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(client.sendMessage(laneMessage('B', i), UplinkPriority::Bulk));
+    }
+    EXPECT_FALSE(client.sendMessage(laneMessage('B', 3), UplinkPriority::Bulk));
+    EXPECT_TRUE(client.isConnected());
+    EXPECT_TRUE(client.sendMessage(laneMessage('E', 0), UplinkPriority::Event));  // 其它通道不受影响
+    EXPECT_EQ(client.stats().bulkRejected, 1u);
+
+    ASSERT_TRUE(client.flush());
+    int nextBulk = 0;
+    int events = 0;
+    for (int i = 0; i < 4; ++i) {
+        const std::string line = server.readLine();
+        if (line == laneMessage('E', 0)) {
+            ++events;
+        } else {
+            EXPECT_EQ(line, laneMessage('B', nextBulk++));
+        }
+    }
+    EXPECT_EQ(events, 1);
+    EXPECT_TRUE(client.sendMessage(laneMessage('B', 3), UplinkPriority::Bulk));
+}
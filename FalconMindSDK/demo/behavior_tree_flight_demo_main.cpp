@@ -36,9 +36,9 @@ int main() {
               << std::endl;
 
     while (true) {
-        NodeStatus status = executor.tick();
+        // 悬停等节点声明了唤醒时刻，执行器在此期间休眠而不是固定间隔轮询
+        NodeStatus status = executor.spinOnce();
         if (status == NodeStatus::Running) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
             continue;
         }
 
@@ -49,7 +49,7 @@ int main() {
         return 1;
     }
 
-    // 4. 配置并启动各个节点
+    // 4. 配置各个节点（start()/process() 由 Pipeline 调度器负责）
     std::unordered_map<std::string, std::string> camParams{
         {"device", "/dev/video0"}
     };
@@ -57,21 +57,20 @@ int main() {
     detNode->configure({{"modelName", "dummy-yolo"}});
     logNode->configure({{"prefix", "[DetectionLog]"}});
 
-    camNode->start();
-    detNode->start();
-    logNode->start();
+    // 相机按 fps 采集；检测、日志节点在收到数据后由线程池调度
+    pipeline.scheduler().setNodePeriod(camNode->id(), std::chrono::microseconds(
+        static_cast<long long>(1e6 / vcfg.fps)));
 
     pipeline.setState(core::PipelineState::Ready);
-    pipeline.setState(core::PipelineState::Playing);
-
-    // 5. 简单循环调用 process，模拟若干帧的处理
-    for (int i = 0; i < 3; ++i) {
-        camNode->process(); // 模拟采集一帧
-        detNode->process(); // 模拟检测一帧
-        logNode->process(); // 打印一条日志
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    if (!pipeline.setState(core::PipelineState::Playing)) {
+        std::cerr << "[camera_detection_demo] Failed to start pipeline" << std::endl;
+        return 1;
     }
 
+    // 5. 运行一段时间后停止
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    pipeline.setState(core::PipelineState::Null);
+
     std::cout << "[camera_detection_demo] Finished." << std::endl;
     return 0;
 }
@@ -56,22 +56,16 @@ int main() {
     detNode->configure({{"modelName", "dummy-yolo"}});
     logNode->configure({{"prefix", "[TrackingLog]"}});
 
-    camNode->start();
-    detNode->start();
-    trackNode->start();
-    logNode->start();
-
+    // 节点 start()/process() 由 Pipeline 调度器驱动
     pipeline.setState(core::PipelineState::Ready);
-    pipeline.setState(core::PipelineState::Playing);
-
-    for (int i = 0; i < 3; ++i) {
-        camNode->process();
-        detNode->process();
-        trackNode->process();
-        logNode->process();
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    if (!pipeline.setState(core::PipelineState::Playing)) {
+        std::cerr << "[tracking_demo] Failed to start pipeline" << std::endl;
+        return 1;
     }
 
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    pipeline.setState(core::PipelineState::Null);
+
     std::cout << "[tracking_demo] Finished." << std::endl;
     return 0;
 }
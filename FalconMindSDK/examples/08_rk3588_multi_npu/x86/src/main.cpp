@@ -1,11 +1,41 @@
-
+#include <chrono>
 #include <iostream>
+#include <vector>
+#include "falconmind/sdk/perception/DetectorDispatcher.h"
 #include "falconmind/sdk/perception/RknnDetectorBackend.h"
 using namespace falconmind::sdk;
-int main(){
+
+int main(int argc, char** argv){
     std::cout<<"===08 RK3588多NPU==="<<std::endl;
-    perception::RknnDetectorBackend backend;
-    backend.setCoreMask(0x7);
-    std::cout<<"3核心模式启用"<<std::endl;
+    // 参数：RKNN 模型路径。三个上下文共享权重，各绑一个 NPU 核（core0/1/2）
+    perception::DetectorDescriptor desc;
+    desc.modelPath = argc > 1 ? argv[1] : "yolo11n.rknn";
+    desc.npuContexts = 3;
+    auto backend = std::make_shared<perception::RknnDetectorBackend>();
+    if (!backend->load(desc)) return 1;
+    std::cout<<"并发上下文: "<<backend->maxConcurrentRuns()<<std::endl;
+
+    // 灰色 640x640 RGB 测试帧；调度器轮流分发，结果按提交顺序取回
+    std::vector<std::uint8_t> pixels(640 * 640 * 3, 114);
+    perception::DetectorDispatcher dispatcher(backend);
+    const int frames = 90;
+    int submitted = 0, done = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    while (done < frames) {
+        perception::ImageView view;
+        view.data = pixels.data();
+        view.width = view.height = 640;
+        view.format = core::PixelFormat::RGB8;
+        view.frameIndex = static_cast<std::uint32_t>(submitted);
+        if (submitted < frames && dispatcher.submit(view)) {
+            ++submitted;
+            continue;
+        }
+        perception::DetectionResult result;
+        if (dispatcher.wait(result)) ++done;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout<<frames<<" 帧, "<<frames / seconds<<" fps"<<std::endl;
+    backend->unload();
     return 0;
 }
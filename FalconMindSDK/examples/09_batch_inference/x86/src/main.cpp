@@ -1,10 +1,58 @@
-
+#include <atomic>
+#include <chrono>
 #include <iostream>
-#include "falconmind/sdk/perception/BatchDetector.h"
+#include <thread>
+#include <vector>
+#include "falconmind/sdk/perception/DetectionBatcher.h"
+#include "falconmind/sdk/perception/OnnxRuntimeDetectorBackend.h"
 using namespace falconmind::sdk;
-int main(){
+
+int main(int argc, char** argv){
     std::cout<<"===09 批量推理==="<<std::endl;
-    perception::BatchDetector detector;
-    std::cout<<"批量检测器创建"<<std::endl;
+    // 参数：动态 batch 的 ONNX 模型（导出时 batch 维为 -1）。四路相机的帧攒成 batch 4 一次推理
+    perception::DetectorDescriptor desc;
+    desc.modelPath = argc > 1 ? argv[1] : "yolo11n_dynamic.onnx";
+    desc.maxBatch = 4;
+    auto backend = std::make_shared<perception::OnnxRuntimeDetectorBackend>();
+    if (!backend->load(desc)) return 1;
+    std::cout<<"最大 batch: "<<backend->maxBatchSize()<<std::endl;
+
+    std::atomic<int> done{0};
+    perception::DetectionBatcher::Config cfg;
+    cfg.maxWait = std::chrono::milliseconds(10);  // 某路掉帧时最多多等 10 ms
+    perception::DetectionBatcher batcher(backend, cfg,
+        [&](std::size_t stream, const perception::ImageView& image, perception::DetectionResult& r, bool ok) {
+            if (ok && image.frameIndex % 30 == 0) {
+                std::cout<<"cam"<<stream<<" frame "<<image.frameIndex<<": "<<r.detections.size()<<" 个目标"<<std::endl;
+            }
+            ++done;
+        });
+
+    // 四路 640x480 灰色 RGB 测试帧，各 30 fps
+    const int cameras = 4, framesPerCamera = 90;
+    std::vector<std::uint8_t> pixels(640 * 480 * 3, 114);
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int cam = 0; cam < cameras; ++cam) {
+        threads.emplace_back([&, cam] {
+            for (int i = 0; i < framesPerCamera; ++i) {
+                perception::ImageView view;
+                view.data = pixels.data();
+                view.width = 640;
+                view.height = 480;
+                view.format = core::PixelFormat::RGB8;
+                view.frameIndex = static_cast<std::uint32_t>(i);
+                batcher.submit(static_cast<std::size_t>(cam), view);
+                std::this_thread::sleep_until(t0 + std::chrono::milliseconds(33 * (i + 1)));
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    while (done + static_cast<int>(batcher.drops()) < cameras * framesPerCamera) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout<<done<<" 帧 / "<<batcher.batches()<<" 批, 丢帧 "<<batcher.drops()<<", "<<done / seconds<<" fps"<<std::endl;
+    backend->unload();
     return 0;
 }
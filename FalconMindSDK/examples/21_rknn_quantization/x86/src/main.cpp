@@ -1,8 +1,33 @@
 #include <iostream>
-#include "falconmind/sdk/sdk.h"
-int main(){
+#include <string>
+#include "falconmind/sdk/perception/Int8Calibration.h"
+using namespace falconmind::sdk;
+
+int main(int argc, char** argv){
     std::cout<<"=== 21_rknn_quantization ==="<<std::endl;
-    std::cout<<"API: RKNN quantization"<<std::endl;
-    std::cout<<"测试完成"<<std::endl;
-    return 0;
+    // 参数：输出目录 录制文件...（CaptureRecorderNode 录下的相机帧）
+    if (argc < 3) {
+        std::cout<<"用法: "<<argv[0]<<" <输出目录> <capture.fmcap>..."<<std::endl;
+        return 1;
+    }
+    // 与机载 RknnDetectorBackend 相同的描述：输入尺寸、letterbox 与 mean/std 决定校准张量
+    perception::DetectorDescriptor desc;
+    desc.detectorId = "yolo11n";
+    desc.backendType = perception::DetectionBackendType::Rknn;
+    desc.precision = perception::ModelPrecision::INT8;
+    desc.inputWidth = 640;
+    desc.inputHeight = 640;
+
+    perception::CalibrationOptions options;
+    options.maxFrames = 200;
+    perception::Int8CalibrationDataset dataset(desc, options);
+    for (int i = 2; i < argc; ++i) {
+        std::cout<<argv[i]<<": "<<dataset.addCapture(argv[i])<<" 帧候选"<<std::endl;
+    }
+    std::size_t written = dataset.write(argv[1]);
+    std::cout<<"写出 "<<written<<" 帧校准数据"<<std::endl;
+    // rknn-toolkit2：rknn.config(mean_values/std_values 取 calibration.json) 后
+    // rknn.build(do_quantization=True, dataset='<输出目录>/dataset.txt')
+    std::cout<<"dataset: "<<argv[1]<<"/dataset.txt"<<std::endl;
+    return written > 0 ? 0 : 1;
 }
@@ -1,8 +1,32 @@
+#include <chrono>
+#include <cstring>
 #include <iostream>
-#include "falconmind/sdk/sdk.h"
-int main(){
+#include <thread>
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/sensors/MultiCameraSourceNode.h"
+
+using namespace falconmind::sdk;
+
+int main(int argc, char** argv){
     std::cout<<"=== 22_multi_camera_sync ==="<<std::endl;
-    std::cout<<"API: CameraSync::sync"<<std::endl;
-    std::cout<<"测试完成"<<std::endl;
+    std::string devices = argc > 1 ? argv[1] : "/dev/video0,/dev/video2";
+    sensors::MultiCameraSourceNode stereo;
+    stereo.setId("stereo");
+    if (!stereo.configure({{"devices", devices}, {"width", "1280"}, {"height", "720"},
+                           {"fps", "30"}, {"max_skew_ms", "2"}})) {
+        return 1;
+    }
+    auto sink = std::make_shared<core::Pad>("in", core::PadType::Sink);
+    sink->setBufferCallback([](const core::BufferRef& b) {
+        sensors::MultiCameraFramePacket header{};
+        std::memcpy(&header, b.data(), sizeof(header));
+        std::cout<<"set "<<header.setIndex<<": "<<header.count<<" frames, skew "
+                 <<header.skewNs / 1000<<"us"<<std::endl;
+    });
+    stereo.getPad("frames_out")->connectTo(sink, "printer", "in");
+    if (!stereo.start()) return 1;
+    std::this_thread::sleep_for(std::chrono::seconds(3));
+    stereo.stop();
+    std::cout<<"frame sets: "<<stereo.frameSets()<<", unmatched drops: "<<stereo.unmatchedDrops()<<std::endl;
     return 0;
 }
@@ -1,8 +1,32 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
-#include "falconmind/sdk/sdk.h"
-int main(){
+#include "falconmind/sdk/sensors/ImuSourceNode.h"
+
+using namespace falconmind::sdk;
+
+int main(int argc, char** argv){
     std::cout<<"=== 24_vio_visual_inertial ==="<<std::endl;
-    std::cout<<"API: VIO::estimate"<<std::endl;
-    std::cout<<"测试完成"<<std::endl;
+    // 参数：IMU 回放文件（每行 timestamp_ns gx gy gz ax ay az），缺省为模拟数据（100 Hz）
+    sensors::ImuSourceNode imu;
+    imu.setId("imu");
+    if (!imu.configure({{"uri", argc > 1 ? argv[1] : "sim"}, {"history_size", "8192"}})) return 1;
+    if (!imu.start()) return 1;
+    for (int i = 0; i < 200; ++i) imu.process();
+
+    // 视觉前端在相邻两帧之间查询运动先验：不订阅 imu_out，也不自行缓存 IMU 流
+    const auto& history = imu.history();
+    const std::uint64_t frameIntervalNs = 33'333'333;  // 30 fps
+    sensors::ImuSample newest;
+    if (!history->latest(newest)) return 1;
+    for (std::uint64_t t1 = newest.timestampNs; t1 >= 5 * frameIntervalNs && t1 > newest.timestampNs - 5 * frameIntervalNs;
+         t1 -= frameIntervalNs) {
+        sensors::ImuPreintegration pre;
+        if (!history->integrate(t1 - frameIntervalNs, t1, pre)) break;
+        double angle = 2.0 * std::acos(std::min(1.0, std::fabs(pre.dq[0])));
+        std::cout<<"frame @"<<t1 / 1'000'000<<"ms: rotation "<<angle * 180.0 / M_PI<<" deg, dv_z "<<pre.dv[2]
+                 <<" m/s from "<<pre.samples<<" samples"<<std::endl;
+    }
+    std::cout<<"history: "<<history->size()<<"/"<<history->capacity()<<" samples"<<std::endl;
     return 0;
 }
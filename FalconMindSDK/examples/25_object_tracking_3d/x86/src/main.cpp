@@ -1,8 +1,43 @@
+#include <cmath>
+#include <cstdint>
 #include <iostream>
-#include "falconmind/sdk/sdk.h"
+#include <vector>
+#include "falconmind/sdk/perception/Tracker3D.h"
+
+using namespace falconmind::sdk;
+
 int main(){
     std::cout<<"=== 25_object_tracking_3d ==="<<std::endl;
-    std::cout<<"API: Tracker3D::track"<<std::endl;
+    // 两个地面目标：一辆车向东 6 m/s，一人静止；观测来自地理投影 / 深度抬升，带 0.5 m 量级噪声
+    perception::Tracker3D tracker;
+    tracker.setOrigin(30.0, 120.0, 0.0);
+    perception::Tracking3DResult out;
+    const std::uint64_t periodNs = 100'000'000;
+    for (int k = 0; k < 50; ++k) {
+        const double t = k * 0.1;
+        const double noise = 0.5 * std::sin(k * 2.3);
+        std::vector<perception::Detection3D> dets(2);
+        dets[0].north = 20.0 + noise;
+        dets[0].east = -50.0 + 6.0 * t - noise;
+        dets[0].classId = 2;
+        dets[0].className = "car";
+        dets[1].north = -15.0 - noise;
+        dets[1].east = 10.0 + noise;
+        dets[1].classId = 0;
+        dets[1].className = "person";
+        tracker.track(static_cast<std::uint64_t>(k) * periodNs, dets, out);
+    }
+    for (const auto& track : out.tracks) {
+        std::cout<<"track "<<track.trackId<<" "<<track.className<<" "<<track.status
+                 <<" pos(n,e,d)=("<<track.north<<", "<<track.east<<", "<<track.down<<") m"
+                 <<" vel(n,e)=("<<track.velNorth<<", "<<track.velEast<<") m/s"
+                 <<" lat/lon="<<track.lat<<"/"<<track.lon<<" std="<<track.posStdM<<" m"<<std::endl;
+    }
+    // 跟随：取 2 s 后的提前量位置
+    perception::Track3D lead;
+    if (!out.tracks.empty() && tracker.extrapolate(out.tracks[0].trackId, out.timestampNs + 2'000'000'000, lead)) {
+        std::cout<<"lead point for track "<<lead.trackId<<": ("<<lead.north<<", "<<lead.east<<") m"<<std::endl;
+    }
     std::cout<<"测试完成"<<std::endl;
     return 0;
 }
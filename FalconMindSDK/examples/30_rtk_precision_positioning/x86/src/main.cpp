@@ -1,8 +1,40 @@
+#include <chrono>
 #include <iostream>
-#include "falconmind/sdk/sdk.h"
-int main(){
+#include <thread>
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/sensors/GnssSourceNode.h"
+
+using namespace falconmind::sdk;
+
+int main(int argc, char** argv){
     std::cout<<"=== 30_rtk_precision_positioning ==="<<std::endl;
-    std::cout<<"API: RTK::position"<<std::endl;
-    std::cout<<"测试完成"<<std::endl;
+    // 参数：RTK 接收机串口（如 /dev/ttyACM0，输出 UBX NAV-PVT 10~25 Hz）或录制的原始字节流文件
+    sensors::GnssSourceNode gnss;
+    gnss.setId("gnss");
+    if (!gnss.configure({{"uri", argc > 1 ? argv[1] : "sim"}, {"baud", argc > 2 ? argv[2] : "460800"}})) return 1;
+
+    int fixed = 0, total = 0;
+    auto sink = std::make_shared<core::Pad>("in", core::PadType::Sink);
+    sink->setDataCallback([&](const void* data, size_t size) {
+        if (size != sizeof(sensors::GnssSample)) return;
+        const auto* s = static_cast<const sensors::GnssSample*>(data);
+        ++total;
+        if (s->fixQuality == 4) ++fixed;  // RTK 固定解
+        if (total % 10 == 1) {
+            std::cout<<"fix q="<<int(s->fixQuality)<<" lat="<<s->latitude<<" lon="<<s->longitude
+                     <<" hAcc="<<s->horizontalAccuracyM<<"m sats="<<s->numSatellites<<std::endl;
+        }
+    });
+    gnss.getPad("gnss_out")->connectTo(sink, "rtk", "in");
+    if (!gnss.start()) return 1;
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < until) {
+        gnss.process();  // 串口：读空缓冲中的全部定位
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    gnss.stop();
+    const auto& st = gnss.parserStats();
+    std::cout<<"fixes "<<total<<" (rtk fixed "<<fixed<<"), nmea "<<st.nmeaSentences<<", ubx "<<st.ubxMessages
+             <<", checksum errors "<<st.checksumErrors<<std::endl;
     return 0;
 }
@@ -1,8 +1,63 @@
+#include <cmath>
+#include <cstring>
 #include <iostream>
-#include "falconmind/sdk/sdk.h"
+#include "falconmind/sdk/cluster/ClusterStateSourceNode.h"
+#include "falconmind/sdk/cluster/SwarmState.h"
+#include "falconmind/sdk/core/Pad.h"
+
+// 编队示例：成员与对端位置来自机间链路（NodeAgent SwarmLink 写入 SwarmStateRegistry），
+// 本机在 20 Hz 的集群状态中找到领机与自身序号，按纵队计算跟随目标点，不经 Cluster Center。
+// 独立运行时以两个模拟对端代替 SwarmLink 收到的报文。
+using namespace falconmind::sdk;
+
 int main(){
     std::cout<<"=== 32_formation_flying ==="<<std::endl;
-    std::cout<<"API: Formation::coordinate"<<std::endl;
+    auto& registry = cluster::SwarmStateRegistry::instance();
+    registry.setLocalId("uav_2");
+    registry.setLocalPosition(31.23000, 121.47000, 50.0, 0.0f, 0.0f, 0.0f);
+    const char* ids[] = {"uav_1", "uav_3"};
+    for (int i = 0; i < 2; ++i) {
+        cluster::SwarmPeerState peer;
+        peer.id = ids[i];
+        peer.role = i == 0 ? "leader" : "follower";
+        peer.lat = 31.23000 + 0.0001 * (1 - i);
+        peer.lon = 121.47000;
+        peer.alt = 50.0;
+        peer.vy = 5.0f;  // 向北 5 m/s
+        peer.seq = 1;
+        registry.updatePeer(peer);
+    }
+
+    cluster::ClusterStateSourceNode node;
+    node.configure({{"self_id", "uav_2"}, {"role", "auto"}, {"members_source", "swarm"},
+                    {"peer_timeout_ms", "500"}, {"rate_hz", "20"}});
+
+    cluster::ClusterStatePacket state{};
+    cluster::SwarmPeersPacket peers{};
+    auto stateIn = std::make_shared<core::Pad>("state_in", core::PadType::Sink);
+    auto peersIn = std::make_shared<core::Pad>("peers_in", core::PadType::Sink);
+    stateIn->setDataCallback([&](const void* d, size_t n) { if (n == sizeof(state)) std::memcpy(&state, d, n); });
+    peersIn->setDataCallback([&](const void* d, size_t n) { if (n == sizeof(peers)) std::memcpy(&peers, d, n); });
+    node.getPad("cluster_state_out")->connectTo(stateIn, "formation", "state_in");
+    node.getPad("swarm_peers_out")->connectTo(peersIn, "formation", "peers_in");
+    node.start();
+    node.process();
+
+    std::cout<<"role="<<state.role<<" members="<<state.num_members<<std::endl;
+    int slot = 0;
+    for (int i = 0; i < state.num_members; ++i) {
+        if (std::strcmp(state.member_ids[i], state.self_id) == 0) slot = i;
+    }
+    // 领机为成员列表中 ID 最小者；纵队间隔 10 m，沿领机航向向后排列
+    const auto& leader = peers.peers[0];
+    const double spacingM = 10.0 * slot;
+    const double heading = std::atan2(leader.vx, leader.vy);  // ENU：vx 东 / vy 北
+    const double northM = -spacingM * std::cos(heading);
+    const double eastM = -spacingM * std::sin(heading);
+    const double targetLat = leader.lat + northM / 111320.0;
+    const double targetLon = leader.lon + eastM / (111320.0 * std::cos(leader.lat * M_PI / 180.0));
+    std::cout<<"leader="<<leader.id<<" age_ms="<<leader.age_ms<<" slot="<<slot
+             <<" target=("<<targetLat<<", "<<targetLon<<")"<<std::endl;
     std::cout<<"测试完成"<<std::endl;
     return 0;
 }
@@ -1,8 +1,90 @@
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <iostream>
-#include "falconmind/sdk/sdk.h"
+#include <memory>
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/perception/FiducialDetectionNode.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+
+using namespace falconmind::sdk;
+
+namespace {
+
+// 模拟下视相机 NV12 帧：灰色地面上的 tag16h5 标记（1 格白边），随下降逐帧变大并缓慢漂移
+core::BufferRef renderFrame(int width, int height, std::uint64_t code, double cx, double cy, double sizePx,
+                            std::uint64_t index) {
+    const int stride = width;
+    auto frame = core::BufferRef::allocate(sizeof(sensors::CameraFramePacket) + stride * height * 3 / 2);
+    auto* h = reinterpret_cast<sensors::CameraFramePacket*>(frame.mutableData());
+    *h = sensors::CameraFramePacket{};
+    h->width = width;
+    h->height = height;
+    h->stride = stride;
+    h->frameIndex = index;
+    h->captureTimestampNs = index * 16'666'667ULL;
+    std::strncpy(h->format, "NV12", sizeof(h->format) - 1);
+    std::uint8_t* y = sensors::cameraFramePacketDataWritable(h);
+    const double cell = sizePx / 6.0;
+    for (int r = 0; r < height; ++r) {
+        for (int c = 0; c < width; ++c) {
+            const double u = (c - cx) / cell + 3.0, v = (r - cy) / cell + 3.0;
+            std::uint8_t val = static_cast<std::uint8_t>(95 + (c * 7 + r * 3) % 17);
+            if (u >= -1.0 && v >= -1.0 && u < 7.0 && v < 7.0) {
+                val = 215;
+                if (u >= 0.0 && v >= 0.0 && u < 6.0 && v < 6.0) {
+                    const int gc = static_cast<int>(u), gr = static_cast<int>(v);
+                    const bool border = gr == 0 || gc == 0 || gr == 5 || gc == 5;
+                    const bool white = !border && ((code >> (15 - ((gr - 1) * 4 + gc - 1))) & 1ULL);
+                    val = white ? 215 : 35;
+                }
+            }
+            y[r * stride + c] = val;
+        }
+    }
+    std::memset(y + stride * height, 128, stride * height / 2);  // UV 平面
+    return frame;
+}
+
+} // namespace
+
 int main(){
     std::cout<<"=== 34_precision_landing ==="<<std::endl;
-    std::cout<<"API: Landing::precision"<<std::endl;
-    std::cout<<"测试完成"<<std::endl;
+    const int width = 640, height = 480;
+    perception::FiducialDetectionNode node;
+    node.setId("landing_tag");
+    // 0.4 m 标记，640×480 下视相机（水平视场约 70°）
+    if (!node.configure({{"family", "tag16h5"}, {"target_id", "3"}, {"tag_size_m", "0.4"},
+                         {"fx", "457"}, {"cx", "320"}, {"cy", "240"}})) return 1;
+    if (!node.start()) return 1;
+    auto camera = std::make_shared<core::Pad>("camera", core::PadType::Source);
+    camera->connectTo(node.getPad("video_in"), node.id(), "video_in");
+
+    perception::FiducialTargetPacket target;
+    auto sink = std::make_shared<core::Pad>("target", core::PadType::Sink);
+    sink->setDataCallback([&target](const void* data, size_t size) {
+        if (size == sizeof(target)) std::memcpy(&target, data, size);
+    });
+    node.getPad("target_out")->connectTo(sink, "landing_controller", "target");
+
+    const std::uint64_t code = perception::FiducialFamily::tag16h5().codes[3];
+    double totalUs = 0.;
+    int roiFrames = 0;
+    for (int i = 0; i < 120; ++i) {  // 60 fps 下 2 s：标记由 40 px 增大到 160 px
+        const double size = 40.0 + i;
+        camera->pushBuffer(renderFrame(width, height, code, 260.0 + i * 0.6, 200.0 + i * 0.3, size, i));
+        node.process();
+        totalUs += target.processingUs;
+        roiFrames += target.roiSearch;
+        if (i % 20 == 0 && target.found) {
+            std::cout<<"frame "<<i<<" id="<<target.id<<" center=("<<target.center[0]<<", "<<target.center[1]
+                     <<") pos=("<<target.position[0]<<", "<<target.position[1]<<", "<<target.position[2]
+                     <<") m yaw="<<target.yaw * 180.0 / M_PI<<" deg roi="<<int(target.roiSearch)
+                     <<" "<<target.processingUs<<" us"<<std::endl;
+        }
+    }
+    std::cout<<"kernel "<<perception::FiducialDetector::kernelName()<<", roi frames "<<roiFrames
+             <<"/120, avg "<<totalUs / 120.0<<" us/frame"<<std::endl;
     return 0;
 }
@@ -4,11 +4,14 @@
 # 在QEMU虚拟机中编译和测试所有examples
 #
 # 用法:
-#   ./run-qemu-test.sh <platform> [--build] [--run] [--all]
+#   ./run-qemu-test.sh <platform> [--build] [--run] [--all] [--flight-load]
 #
 # 示例:
 #   ./run-qemu-test.sh rk3576 --all    # 完整测试流程
 #   ./run-qemu-test.sh rk3588 --build  # 仅编译
+#   ./run-qemu-test.sh rk3588 --flight-load  # 飞控链路负载基准，报告写到 examples/flight_load_<platform>.json
+#   FLIGHT_LOAD_BASELINE=flight_load_x86.json ./run-qemu-test.sh rk3588 --flight-load  # 与基线对比
+#   FLIGHT_LOAD_ARGS="--vehicles 32 --rate 8000" ./run-qemu-test.sh x86 --flight-load   # 自定义负载参数
 #
 
 set -e
@@ -134,6 +137,30 @@ run_tests_vm() {
     exec_in_vm "$platform" "$run_cmd"
 }
 
+# 飞控链路负载基准：在虚拟机中编译 SDK 的 falconmind_flight_load_benchmark 并运行，
+# 报告写入共享的 examples 目录，便于在宿主机上对比 x86 / arm64 或不同版本
+run_flight_load_vm() {
+    local platform="$1"
+    local report="flight_load_${platform}.json"
+    local baseline_arg=""
+    if [[ -n "${FLIGHT_LOAD_BASELINE:-}" ]]; then
+        baseline_arg="--baseline ~/examples/${FLIGHT_LOAD_BASELINE}"
+    fi
+
+    print_info "运行飞控链路负载基准..."
+
+    local bench_cmd='
+        cd ~
+        cmake -S . -B build-bench -DCMAKE_BUILD_TYPE=Release -DFALCONMINDSDK_BUILD_TESTS=ON > /dev/null &&
+        cmake --build build-bench --target falconmind_flight_load_benchmark -j$(nproc) > /dev/null &&
+        ./build-bench/falconmind_flight_load_benchmark --label '"$platform"' '"${FLIGHT_LOAD_ARGS:-}"' \
+            --output ~/examples/'"$report"' '"$baseline_arg"'
+    '
+
+    exec_in_vm "$platform" "$bench_cmd"
+    print_info "报告: ${SCRIPT_DIR}/${report}"
+}
+
 # 启动QEMU
 start_qemu() {
     local platform="$1"
@@ -181,6 +208,7 @@ main() {
     local DO_BUILD="false"
     local DO_RUN="false"
     local DO_ALL="false"
+    local DO_FLIGHT_LOAD="false"
 
     while [[ $# -gt 0 ]]; do
         case "$1" in
@@ -192,6 +220,10 @@ main() {
                 DO_RUN="true"
                 shift
                 ;;
+            --flight-load)
+                DO_FLIGHT_LOAD="true"
+                shift
+                ;;
             --all)
                 DO_BUILD="true"
                 DO_RUN="true"
@@ -213,7 +245,9 @@ main() {
         exit 1
     fi
 
-    if [[ "$DO_ALL" == "true" ]]; then
+    if [[ "$DO_FLIGHT_LOAD" == "true" ]]; then
+        run_flight_load_vm "$platform"
+    elif [[ "$DO_ALL" == "true" ]]; then
         full_test "$platform"
     elif [[ "$DO_BUILD" == "true" && "$DO_RUN" == "true" ]]; then
         local port="${SSH_PORTS[$platform]}"
@@ -226,7 +260,7 @@ main() {
     elif [[ "$DO_RUN" == "true" ]]; then
         run_tests_vm "$platform"
     else
-        print_info "用法: $0 <platform> [--build] [--run] [--all]"
+        print_info "用法: $0 <platform> [--build] [--run] [--all] [--flight-load]"
         print_info "示例: $0 rk3576 --all"
     fi
 
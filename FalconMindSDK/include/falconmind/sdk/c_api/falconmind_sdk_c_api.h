@@ -15,6 +15,12 @@ typedef struct FMPipeline FMPipeline;
 /** 不透明句柄：FlowExecutor */
 typedef struct FMFlowExecutor FMFlowExecutor;
 
+/** 不透明句柄：引用计数的数据缓冲（帧 / 检测结果包等），数据位于 SDK 内存中 */
+typedef struct FMBuffer FMBuffer;
+
+/** 不透明句柄：本机遥测广播通道的读端 */
+typedef struct FMLocalTelemetryReader FMLocalTelemetryReader;
+
 /** Pipeline 状态：0=Null, 1=Ready, 2=Playing, 3=Paused */
 typedef int FMPipelineState;
 #define FM_PIPELINE_STATE_NULL    0
@@ -44,6 +50,100 @@ int fm_pipeline_set_state(FMPipeline* p, FMPipelineState state);
 /** 获取当前状态 */
 FMPipelineState fm_pipeline_get_state(FMPipeline* p);
 
+/**
+ * 获取运行时指标（节点 process() 次数/耗时分位数/队列积压，连接帧率/字节率/丢帧）的 JSON。
+ * 按 snprintf 语义写入 buf（总是以 '\0' 结尾，buf 可为 NULL 用于查询长度），
+ * 返回完整 JSON 的长度（不含 '\0'）；p 为 NULL 返回 0。
+ */
+size_t fm_pipeline_get_metrics_json(FMPipeline* p, char* buf, size_t buf_size);
+
+// ---------- Pad 数据出口（零拷贝） ----------
+
+/**
+ * Pad 出口回调：buffer 只在回调期间有效（借用，不得 release）；需在回调返回后继续使用时
+ * 以 fm_buffer_retain 增加引用并在用完后 fm_buffer_release。
+ * 持有期间生产者不会复用该缓冲（相机池缓冲被占用时改为分配新缓冲），应尽快释放
+ */
+typedef void (*FMPadTapCallback)(const FMBuffer* buffer, void* user_data);
+
+/**
+ * 在 node_id.pad_name（Source Pad）上挂接回调，数据不拷贝、不序列化。
+ * queue_depth 为 0 时回调在生产者线程同步调用；> 0 时经该容量的队列（满时丢弃最旧）在调度线程调用，
+ * 慢速消费者不阻塞生产者。user_data 须在移除出口或销毁 Pipeline 前保持有效。
+ * 同一 Pad 只能挂接一个出口。返回 1 成功，0 失败。
+ */
+int fm_pipeline_add_pad_tap(FMPipeline* p, const char* node_id, const char* pad_name,
+    FMPadTapCallback callback, void* user_data, int queue_depth);
+
+/** 移除出口；须在 Pipeline 非 Playing 状态调用。返回 1 成功，0 失败。 */
+int fm_pipeline_remove_pad_tap(FMPipeline* p, const char* node_id, const char* pad_name);
+
+/** 增加引用：返回新的句柄（与 buffer 共享数据），调用方负责 fm_buffer_release；buffer 为 NULL 返回 NULL */
+FMBuffer* fm_buffer_retain(const FMBuffer* buffer);
+
+/** 释放 fm_buffer_retain 返回的句柄；最后一个引用释放时缓冲归还生产者 */
+void fm_buffer_release(FMBuffer* buffer);
+
+/** 缓冲数据（只读，指向 SDK 内存）与字节数 */
+const uint8_t* fm_buffer_data(const FMBuffer* buffer);
+size_t fm_buffer_size(const FMBuffer* buffer);
+
+/** 缓冲元数据：时间戳为 CLOCK_MONOTONIC 纳秒（0 表示未知） */
+typedef struct FMBufferMeta {
+    int64_t  timestamp_ns;
+    uint64_t frame_index;
+    int32_t  dmabuf_fd;   /* 数据所在的 DMABUF，-1 表示无；持有缓冲期间有效，不转移所有权 */
+} FMBufferMeta;
+
+/** 读取元数据。返回 1 成功，0 失败（buffer 或 out 为 NULL） */
+int fm_buffer_get_meta(const FMBuffer* buffer, FMBufferMeta* out);
+
+/** 相机帧视图（camera_source 等节点输出的帧包），指针指向缓冲内部 */
+typedef struct FMFrameView {
+    int32_t        width;
+    int32_t        height;
+    int32_t        stride;        /* 每行字节数 */
+    const char*    format;        /* "RGB8" / "BGR8" / "YUYV" / "NV12" 等 */
+    int64_t        timestamp_ns;  /* 采集时间戳 */
+    uint64_t       frame_index;
+    const uint8_t* pixels;
+    size_t         pixels_size;
+} FMFrameView;
+
+/** 把缓冲解析为帧视图（不拷贝）。返回 1 成功，0 表示不是帧包或长度不足 */
+int fm_buffer_as_frame(const FMBuffer* buffer, FMFrameView* out);
+
+/** 单条检测，与检测结果包 v2 的条目布局一致（32 字节） */
+typedef struct FMDetection {
+    float    x;
+    float    y;
+    float    width;
+    float    height;
+    float    score;
+    int32_t  class_id;
+    int32_t  track_id;           /* -1 表示未跟踪 */
+    uint16_t class_name_index;   /* 0xFFFF 表示无类别名 */
+    uint16_t reserved;
+} FMDetection;
+
+/** 检测结果视图（detection_out 等 Pad 输出的 v2 包），指针指向缓冲内部 */
+typedef struct FMDetectionView {
+    uint32_t           frame_index;
+    uint64_t           timestamp_ns;  /* 源帧采集时间戳 */
+    uint32_t           flags;         /* 1：超出时延预算；2：本帧由跟踪器外推 */
+    uint32_t           count;
+    const FMDetection* items;
+    uint32_t           num_class_names;
+    const uint32_t*    name_offsets;  /* num_class_names + 1 项 */
+    const char*        names;
+} FMDetectionView;
+
+/** 把缓冲解析为检测结果视图（不拷贝）。返回 1 成功，0 表示不是 v2 检测结果包 */
+int fm_buffer_as_detections(const FMBuffer* buffer, FMDetectionView* out);
+
+/** 第 i 条检测的类别名（以 '\0' 结尾，指向缓冲内部）；无类别名或越界返回 NULL */
+const char* fm_detection_class_name(const FMDetectionView* view, uint32_t i);
+
 // ---------- FlowExecutor（零代码 Flow 执行） ----------
 
 /** 创建 FlowExecutor。调用方负责 fm_flow_executor_destroy。 */
@@ -67,6 +167,83 @@ void fm_flow_executor_stop(FMFlowExecutor* e);
 /** 是否正在运行：1 是，0 否 */
 int fm_flow_executor_is_running(FMFlowExecutor* e);
 
+/** 在当前 Flow Pipeline 的 node_id.pad_name 上挂接出口，语义同 fm_pipeline_add_pad_tap；须在 load 之后调用 */
+int fm_flow_executor_add_pad_tap(FMFlowExecutor* e, const char* node_id, const char* pad_name,
+    FMPadTapCallback callback, void* user_data, int queue_depth);
+
+/** 移除出口；须在 Flow 停止后调用 */
+int fm_flow_executor_remove_pad_tap(FMFlowExecutor* e, const char* node_id, const char* pad_name);
+
+/** 获取当前 Flow Pipeline 的运行时指标 JSON，语义同 fm_pipeline_get_metrics_json；未加载 Flow 返回 0 */
+size_t fm_flow_executor_get_metrics_json(FMFlowExecutor* e, char* buf, size_t buf_size);
+
+// ---------- 本机遥测广播（共享内存，同机进程读取） ----------
+
+/** 飞行状态快照，与 telemetry::LocalFlightState 布局一致；字符串以 '\0' 结尾 */
+typedef struct FMLocalFlightState {
+    int64_t  timestamp_ns;
+    double   lat;
+    double   lon;
+    double   alt;
+    double   roll;
+    double   pitch;
+    double   yaw;
+    double   vx;
+    double   vy;
+    double   vz;
+    double   battery_percent;
+    double   link_quality;
+    int32_t  battery_voltage_mv;
+    int32_t  gps_fix_type;
+    int32_t  num_sat;
+    uint32_t reserved;
+    char     flight_mode[16];
+    char     uav_id[16];
+} FMLocalFlightState;
+
+/** 检测事件，与 telemetry::LocalDetectionEvent 布局一致（一帧的每条检测一个事件） */
+typedef struct FMLocalDetectionEvent {
+    uint64_t sequence;      /* 写端序号，从 0 连续递增 */
+    uint64_t timestamp_ns;  /* 源帧采集时间戳 */
+    uint32_t frame_index;
+    int32_t  class_id;
+    int32_t  track_id;      /* -1 表示未跟踪 */
+    float    score;
+    float    x;
+    float    y;
+    float    width;
+    float    height;
+    uint32_t flags;         /* 1：超出时延预算；2：本帧由跟踪器外推 */
+    uint32_t reserved;
+    char     class_name[32];
+} FMLocalDetectionEvent;
+
+/** 打开 local_telemetry 节点创建的通道（channel 参数，默认 "falconmind_telemetry"）；通道不存在返回 NULL，可稍后重试 */
+FMLocalTelemetryReader* fm_local_telemetry_open(const char* channel);
+
+/** 关闭读端 */
+void fm_local_telemetry_close(FMLocalTelemetryReader* r);
+
+/** 读取最新飞行状态（无锁，不进入内核）。返回 1 成功，0 表示尚未发布或参数为 NULL */
+int fm_local_telemetry_latest_state(const FMLocalTelemetryReader* r, FMLocalFlightState* out);
+
+/** 已发布的状态次数，与上次比较即可判断是否有新状态 */
+uint64_t fm_local_telemetry_state_version(const FMLocalTelemetryReader* r);
+
+/**
+ * 从 *cursor 起按序读取至多 max_count 条检测事件并推进 *cursor，返回条数。
+ * 首次传 0 读取环内全部历史，或传 fm_local_telemetry_events_published() 只读新事件；
+ * 落后超过环容量而被覆盖的事件数累加到 *dropped（可为 NULL）
+ */
+size_t fm_local_telemetry_poll_events(const FMLocalTelemetryReader* r, uint64_t* cursor,
+    FMLocalDetectionEvent* out, size_t max_count, uint64_t* dropped);
+
+/** 累计发布的事件数 */
+uint64_t fm_local_telemetry_events_published(const FMLocalTelemetryReader* r);
+
+/** 写端是否已关闭：1 是（应关闭后重新 open），0 否 */
+int fm_local_telemetry_closed(const FMLocalTelemetryReader* r);
+
 #ifdef __cplusplus
 }
 #endif
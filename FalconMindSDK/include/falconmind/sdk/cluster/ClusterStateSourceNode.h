@@ -1,9 +1,11 @@
 // FalconMindSDK - 集群状态源节点（PRD 3.1.2.2 集群与协同模块）
 // 输出当前节点的集群状态（本机 ID、角色、成员列表），供下游或 NodeAgent 使用；可配置或对接集群中间件。
+// members_source=swarm 时成员与对端状态来自 NodeAgent 机间链路（SwarmStateRegistry），不经 Cluster Center。
 #pragma once
 
 #include "falconmind/sdk/core/Node.h"
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -18,7 +20,27 @@ struct ClusterStatePacket {
     char     role[kMaxIdLen]{};  // "leader" / "follower" / "standalone"
     int32_t  num_members{0};
     char     member_ids[kMaxMemberIds][kMaxIdLen]{};
-    int64_t  timestamp_ns{0};
+    int64_t  timestamp_ns{0};  // 发布时刻（PipelineClock 时基）
+};
+
+/** 经 swarm_peers_out 推送的存活对端状态（二进制，仅 members_source=swarm） */
+struct SwarmPeersPacket {
+    static constexpr int kMaxPeers = ClusterStatePacket::kMaxMemberIds;
+    static constexpr int kMaxIdLen = ClusterStatePacket::kMaxIdLen;
+    struct Peer {
+        char     id[kMaxIdLen]{};
+        char     role[kMaxIdLen]{};
+        double   lat{0.0};
+        double   lon{0.0};
+        double   alt{0.0};
+        float    vx{0.0f};
+        float    vy{0.0f};
+        float    vz{0.0f};
+        int32_t  age_ms{0};  // 距最近一次收到该对端状态的时间
+    };
+    int32_t  num_peers{0};
+    Peer     peers[kMaxPeers]{};
+    int64_t  timestamp_ns{0};  // PipelineClock 时基
 };
 
 class ClusterStateSourceNode : public core::Node {
@@ -34,13 +56,21 @@ public:
     void setMemberIds(const std::vector<std::string>& ids);
 
 private:
+    core::Pad* outPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
+    core::Pad* peersPad_{nullptr};
     void pushState();
+    // 从 SwarmStateRegistry 刷新成员列表与自动角色，并推送对端状态
+    void refreshFromSwarm();
 
     bool started_{false};
     std::string selfId_{"node_0"};
     std::string role_{"standalone"};
     std::vector<std::string> memberIds_;
-    int64_t timestampNs_{0};
+    bool fromSwarm_{false};        // members_source=swarm
+    bool autoRole_{false};         // role=auto：存活成员中 ID 最小者为 leader，其余为 follower
+    int64_t peerTimeoutNs_{1000000000ll};
+    int64_t minIntervalNs_{0};     // rate_hz > 0 时的最小发布间隔
+    int64_t lastPushNs_{0};
 };
 
 } // namespace falconmind::sdk::cluster
@@ -0,0 +1,79 @@
+// FalconMindSDK - 机间共享的集群状态（位置、角色、目标认领），由 NodeAgent 的机间链路写入
+#pragma once
+
+#include "falconmind/sdk/cluster/SwarmTargetRegistry.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::cluster {
+
+// 对一个目标的认领：score 越高越适合接手（距离、剩余电量等由认领方折算，范围 [0, 1]）
+struct SwarmTargetClaim {
+    std::uint32_t targetId{0};
+    float score{0.0f};
+};
+
+struct SwarmPeerState {
+    std::string id;
+    std::string role;            // "leader" / "follower" / "standalone"
+    double lat{0.0};             // WGS84
+    double lon{0.0};
+    double alt{0.0};
+    float vx{0.0f};              // m/s，ENU
+    float vy{0.0f};
+    float vz{0.0f};
+    std::vector<SwarmTargetClaim> claims;
+    std::vector<SwarmTargetRecord> targets;  // 报文携带的一批已确认目标（SwarmTargetRegistry 轮转取出）
+    std::uint32_t seq{0};        // 发送方递增的序号
+    std::int64_t sentNs{0};      // 发送方时钟（Unix epoch 纳秒），仅用于诊断
+    std::int64_t updatedNs{0};   // 本机收到 / 更新的时刻（PipelineClock 时基）
+};
+
+/**
+ * SwarmStateRegistry - 进程内的集群状态表
+ *
+ * 本机状态（local）：位置由 NodeAgent 的 SwarmLink 从遥测写入，角色与目标认领由 SDK 节点写入，
+ * SwarmLink 按固定频率广播；对端状态（peers）由 SwarmLink 收到的机间报文写入。
+ * ClusterStateSourceNode（members_source=swarm）与目标交接逻辑从这里读取存活成员，不经 Cluster Center。
+ * 对端超过 maxAgeNs 未更新视为离线；序号不比已有状态新的报文（乱序 / 重复）丢弃，
+ * 离线后重新出现的对端（重启后序号归零）直接接受。接受的对端报文中的目标记录并入 targetRegistry()。所有方法线程安全
+ */
+class SwarmStateRegistry {
+public:
+    static SwarmStateRegistry& instance();
+
+    void setLocalId(const std::string& id);
+    void setLocalRole(const std::string& role);
+    void setLocalPosition(double lat, double lon, double alt, float vx, float vy, float vz);
+    void setLocalClaims(const std::vector<SwarmTargetClaim>& claims);
+    SwarmPeerState localState() const;
+
+    // 写入一条对端状态；乱序 / 重复或与本机同 ID 时返回 false
+    bool updatePeer(SwarmPeerState state);
+    // maxAgeNs 内更新过的对端，按 ID 排序
+    std::vector<SwarmPeerState> peers(std::int64_t maxAgeNs) const;
+    // 目标的当前负责方（本机与存活对端中 score 最高者，相同时取 ID 较小者）；无人认领时返回空
+    std::string claimOwner(std::uint32_t targetId, std::int64_t maxAgeNs) const;
+    // 每次本机或对端状态变化时递增
+    std::uint64_t version() const;
+    // 集群已确认目标表（本机认领由 EventReporterNode 写入，SwarmLink 广播；对端记录在 updatePeer 中并入）
+    const std::shared_ptr<SwarmTargetRegistry>& targetRegistry() const noexcept { return targets_; }
+
+    void clear();
+
+private:
+    SwarmStateRegistry() = default;
+
+    mutable std::mutex mutex_;
+    SwarmPeerState local_;
+    std::unordered_map<std::string, SwarmPeerState> peers_;
+    std::uint64_t version_{0};
+    std::shared_ptr<SwarmTargetRegistry> targets_{std::make_shared<SwarmTargetRegistry>()};
+};
+
+} // namespace falconmind::sdk::cluster
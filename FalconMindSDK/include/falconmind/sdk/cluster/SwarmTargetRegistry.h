@@ -0,0 +1,104 @@
+// FalconMindSDK - 机间共享的已确认目标表：均匀空间哈希索引，经 SwarmLink 以紧凑记录同步，机上抑制其他 UAV 已上报的目标
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::cluster {
+
+// 一条目标认领（机间报文中 11 字节）：位置量化到 1e-7 度，类别为类名的 16 位指纹（0 为任意类别）
+struct SwarmTargetRecord {
+    double lat{0.0};
+    double lon{0.0};
+    std::uint16_t classKey{0};
+    float confidence{0.0f};
+};
+
+struct SwarmTargetRegistryConfig {
+    double radiusM{15.0};                   // 同类认领相距不超过此值视为同一目标（宜与 EventAggregatorConfig::radiusM 一致）
+    std::int64_t ttlNs{120'000'000'000};    // 超过此时长未刷新的认领过期（对端离开该区域、本机不再观测）
+    std::size_t maxTargets{4096};           // 超出时淘汰最久未刷新的认领
+};
+
+struct SwarmTargetRegistryStats {
+    std::uint64_t localClaims{0};   // 新建的本机认领
+    std::uint64_t peerRecords{0};   // 合并的对端记录
+    std::uint64_t suppressed{0};    // peerOwner() 命中（本机不再上报）的次数
+    std::uint64_t expired{0};
+};
+
+/**
+ * SwarmTargetRegistry - 集群已确认目标的认领表
+ *
+ * 本机确认的目标以 claimLocal 登记，SwarmLink 每次广播经 nextBroadcast 轮转取出一批附在机间状态报文中，
+ * 对端收到后 mergePeer 写入本表；认领在 ttlNs 内未刷新即过期。查找按均匀网格（纬向边长 radiusM，
+ * 经向按纬度扩大搜索的格数）分桶，只访问常数个桶，与全集群目标数无关。
+ * peerOwner 判断一次观测是否已被其他 UAV 认领：相邻条带重复拍到的同一目标只由先认领的 UAV 上报，
+ * 上行事件与 ClusterCenter 侧的去重都随之减少。双方在同步之前各自认领的同一目标，由 ID 较小者继续上报。
+ * 线程安全。
+ */
+class SwarmTargetRegistry {
+public:
+    SwarmTargetRegistry() : SwarmTargetRegistry(SwarmTargetRegistryConfig{}) {}
+    explicit SwarmTargetRegistry(const SwarmTargetRegistryConfig& cfg);
+
+    // 替换参数（清空已有认领）
+    void setConfig(const SwarmTargetRegistryConfig& cfg);
+    SwarmTargetRegistryConfig config() const;
+    void setLocalId(const std::string& id);
+
+    // 本机确认的目标：并入 radiusM 内的同类本机认领（刷新位置与时刻），否则新建；返回是否新建。nowNs 为 PipelineClock 时基
+    bool claimLocal(double lat, double lon, const std::string& className, float confidence, std::int64_t nowNs);
+    // 对端 owner 广播的记录：并入该对端 radiusM 内的同类认领，否则新建
+    void mergePeer(const std::string& owner, const std::vector<SwarmTargetRecord>& records, std::int64_t nowNs);
+    // 该观测是否已被其他 UAV 认领：返回认领方 ID，未认领时返回空
+    std::string peerOwner(double lat, double lon, const std::string& className, std::int64_t nowNs);
+    // 下一批要广播的本机认领（至多 max 条）；认领多于一个报文时轮转，连续的广播覆盖全部认领
+    std::vector<SwarmTargetRecord> nextBroadcast(std::size_t max);
+
+    void expire(std::int64_t nowNs);
+    void clear();
+
+    std::size_t size() const;
+    std::size_t localCount() const;
+    SwarmTargetRegistryStats stats() const;
+
+    // 类名的 16 位指纹；空类名为 0（与任意类别匹配）
+    static std::uint16_t classKey(const std::string& className) noexcept;
+
+private:
+    struct Entry {
+        SwarmTargetRecord record;
+        std::string owner;         // 空为本机
+        std::int64_t updatedNs{0};
+        std::uint64_t cell{0};
+    };
+
+    std::uint64_t cellOf(double lat, double lon) const noexcept;
+    // radiusM 内满足 accept 的最近认领；没有时返回 0
+    template <typename Accept>
+    std::uint64_t findNearest(double lat, double lon, std::uint16_t classKey, Accept accept) const;
+    std::uint64_t insert(const SwarmTargetRecord& record, const std::string& owner, std::int64_t nowNs);
+    void move(Entry& e, std::uint64_t id, const SwarmTargetRecord& record);
+    void erase(std::uint64_t id);
+    void expireLocked(std::int64_t nowNs);
+    void evictOldest();
+
+    SwarmTargetRegistryConfig cfg_;
+    double cellDeg_{0.0};
+    mutable std::mutex mutex_;
+    std::string localId_;
+    std::uint64_t nextId_{1};
+    std::unordered_map<std::uint64_t, Entry> entries_;
+    std::unordered_multimap<std::uint64_t, std::uint64_t> cells_;  // 网格键 → 认领
+    std::vector<std::uint64_t> localOrder_;                          // 本机认领的广播轮转顺序
+    std::size_t cursor_{0};
+    std::int64_t lastExpireNs_{0};
+    SwarmTargetRegistryStats stats_;
+};
+
+} // namespace falconmind::sdk::cluster
@@ -0,0 +1,136 @@
+// FalconMindSDK - 加速器仲裁：多个 Flow 共用 NPU / GPU 时按 Flow 优先级分配推理时间片
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace falconmind::sdk::core {
+
+class AcceleratorArbiter;
+class AcceleratorClient;
+
+struct AcceleratorClientStats {
+    std::uint64_t grants{0};   // 已获得的时间片数
+    std::uint64_t busyNs{0};   // 持有时间片的累计时长
+    std::uint64_t waitNs{0};   // 等待时间片的累计时长
+};
+
+/**
+ * AcceleratorLease - 一次推理占用的加速器上下文（RAII，析构时归还并计入使用时长）
+ * 默认构造的 Lease 不占用任何上下文（未接入仲裁）
+ */
+class AcceleratorLease {
+public:
+    AcceleratorLease() = default;
+    ~AcceleratorLease() { release(); }
+    AcceleratorLease(AcceleratorLease&& other) noexcept;
+    AcceleratorLease& operator=(AcceleratorLease&& other) noexcept;
+    AcceleratorLease(const AcceleratorLease&) = delete;
+    AcceleratorLease& operator=(const AcceleratorLease&) = delete;
+
+    void release();
+
+private:
+    friend class AcceleratorClient;
+    AcceleratorLease(std::shared_ptr<AcceleratorClient> client, std::int64_t grantedNs)
+        : client_(std::move(client)), grantedNs_(grantedNs) {}
+
+    std::shared_ptr<AcceleratorClient> client_;
+    std::int64_t grantedNs_{0};
+};
+
+/**
+ * AcceleratorClient - 某个 Flow 在一个加速器设备上的登记（AcceleratorArbiter::client 创建，析构时注销）
+ * acquire() 阻塞到获得一个上下文；可在多个推理线程并发调用
+ */
+class AcceleratorClient : public std::enable_shared_from_this<AcceleratorClient> {
+public:
+    ~AcceleratorClient();
+    AcceleratorClient(const AcceleratorClient&) = delete;
+    AcceleratorClient& operator=(const AcceleratorClient&) = delete;
+
+    AcceleratorLease acquire();
+
+    const std::string& device() const noexcept { return device_; }
+    const std::string& owner() const noexcept { return owner_; }
+    int priority() const noexcept { return priority_; }
+    AcceleratorClientStats stats() const;
+
+private:
+    friend class AcceleratorArbiter;
+    friend class AcceleratorLease;
+    struct Device;
+    AcceleratorClient(std::shared_ptr<Device> device, std::string name, std::string owner, int priority);
+    void release(std::int64_t grantedNs);
+
+    std::shared_ptr<Device> dev_;
+    std::string device_;
+    std::string owner_;
+    int priority_;
+    // 以下由设备锁保护
+    double weight_{1.0};
+    double vtime_{0.0};  // 累计使用时长（ns）÷ 权重
+    std::uint32_t held_{0};     // 持有中的时间片数
+    std::uint32_t waiting_{0};  // 等待中的请求数
+    std::int64_t lastReleaseNs_{0};
+    AcceleratorClientStats stats_;
+};
+
+/**
+ * AcceleratorArbiter - 进程级加速器仲裁
+ *
+ * 每个设备（如 "npu"、"gpu"）有固定数量的上下文（setContexts，默认 1）。只有一个客户端登记时不做仲裁，
+ * 获得时间片不等待（与未接入时一致）；多个 Flow 同时登记后按步幅调度（stride scheduling）分配空闲上下文：
+ * 各客户端按 使用时长 ÷ 权重 累计虚拟时间，虚拟时间最小的等待者先获得，权重为 Flow 优先级 + 1，
+ * 因此长期看各 Flow 占用加速器的时间与优先级成比例，低优先级 Flow 不会饿死。
+ * 刚归还时间片且虚拟时间更小的客户端在 0.5ms 内为其保留上下文（推理循环紧接着再次请求，
+ * 否则被唤醒的其它等待者总能抢先，份额退化为轮流）。新登记的客户端从当前最小虚拟时间开始计；空闲的客户端至多积累 20ms 占用时长的份额，
+ * 不会因此前未使用而长时间连续占用。
+ */
+class AcceleratorArbiter {
+public:
+    static AcceleratorArbiter& instance();
+
+    // 设备的并发上下文数（如 RK3588 三个 NPU 核心为 3）；在客户端登记前设置
+    void setContexts(const std::string& device, std::size_t contexts);
+    std::size_t contexts(const std::string& device) const;
+
+    // priority 0~100；返回的客户端在析构时注销
+    std::shared_ptr<AcceleratorClient> client(const std::string& device, const std::string& owner, int priority);
+    // 设备当前登记的客户端数
+    std::size_t clientCount(const std::string& device) const;
+
+private:
+    AcceleratorArbiter() = default;
+    std::shared_ptr<AcceleratorClient::Device> deviceFor(const std::string& device);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<AcceleratorClient::Device>> devices_;
+};
+
+/**
+ * AcceleratorUser - 在加速器上推理的节点实现此接口（FlowExecutor 按 Flow 优先级为其登记客户端）
+ * acceleratorDevice() 为空表示不需要仲裁（如 CPU 后端）；客户端为空时 acquireAccelerator() 不占用上下文
+ */
+class AcceleratorUser {
+public:
+    virtual ~AcceleratorUser() = default;
+    virtual std::string acceleratorDevice() const = 0;
+
+    void setAcceleratorClient(std::shared_ptr<AcceleratorClient> client);
+    std::shared_ptr<AcceleratorClient> acceleratorClient() const;
+
+protected:
+    AcceleratorLease acquireAccelerator() const;
+
+private:
+    mutable std::mutex clientMutex_;
+    std::shared_ptr<AcceleratorClient> client_;
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,66 @@
+// FalconMindSDK - AsyncLoop：单线程事件循环（epoll + 定时器 + 投递任务），承载异步节点的 I/O 等待
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace falconmind::sdk::core {
+
+/**
+ * AsyncLoop - 事件循环（由 PipelineScheduler 在存在 AsyncNode 时创建）
+ *
+ * 全部回调在循环线程上执行，回调不应阻塞。大量逻辑等待（RPC 应答、上行 socket、定时重试）只占用这一个线程，
+ * 不再各自阻塞一个工作线程。等待都是一次性的：触发后即注销，需要时再次登记。
+ *
+ * stop() 之后（以及 stop() 期间）登记均失败；stop() 会在调用线程上以“已取消”结果回调所有未触发的等待
+ * （定时器 fired=false，fd 等待 revents=0），并执行已投递的任务，使挂起的协程都能收尾。
+ */
+class AsyncLoop {
+public:
+    using Task = std::function<void()>;
+    using TimerCallback = std::function<void(bool fired)>;
+    using FdCallback = std::function<void(std::uint32_t revents)>;
+    using TimerId = std::uint64_t;  // 0 为无效
+
+    AsyncLoop();
+    ~AsyncLoop();
+
+    AsyncLoop(const AsyncLoop&) = delete;
+    AsyncLoop& operator=(const AsyncLoop&) = delete;
+
+    // threadName 须为字面量或 Tracer::intern() 指针
+    bool start(const char* threadName = "async");
+    // 不可在循环线程内调用
+    void stop();
+    bool running() const noexcept;
+    bool inLoopThread() const noexcept;
+
+    // 在循环线程执行 task；未运行时返回 false
+    bool post(Task task);
+    // delay 后回调 callback(true)；取消或停止时 callback(false)。未运行时返回 0 且不回调
+    TimerId after(std::chrono::nanoseconds delay, TimerCallback callback);
+    // 取消定时器（在循环线程回调 fired=false）；已触发或未知 id 返回 false
+    bool cancel(TimerId id);
+
+    /**
+     * fd 就绪（events 为 EPOLLIN / EPOLLOUT 等）时回调一次 callback(revents)，含 EPOLLERR / EPOLLHUP
+     * @return 未运行、该 fd 已有等待或 fd 不支持 epoll（如普通文件）时返回 false 且不回调
+     */
+    bool watch(int fd, std::uint32_t events, FdCallback callback);
+    // 取消 fd 等待（在循环线程回调 revents=0）；fd 须在回调之前保持打开
+    bool unwatch(int fd);
+
+    // 未触发的定时器与 fd 等待数
+    std::size_t pendingWaits() const;
+
+private:
+    struct State;
+    void loop();
+    void drainCancelled();
+
+    std::unique_ptr<State> state_;
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,200 @@
+// FalconMindSDK - 异步节点：I/O 密集节点在调度器的事件循环上以回调 / 协程等待 Pad 数据、定时器与 socket
+#pragma once
+
+#include "falconmind/sdk/core/AsyncLoop.h"
+#include "falconmind/sdk/core/Buffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include "falconmind/sdk/core/Log.h"
+
+#include <coroutine>
+#include <exception>
+
+#include <sys/epoll.h>
+#define FALCONMIND_HAS_COROUTINES 1
+#else
+#define FALCONMIND_HAS_COROUTINES 0
+#endif
+
+namespace falconmind::sdk::core {
+
+class Node;
+class Pad;
+
+/**
+ * AsyncContext - 异步节点在事件循环上的运行环境（PipelineScheduler 为每个 AsyncNode 创建，Pipeline 停止时关闭）
+ *
+ * 节点的全部输入 Pad 由上下文接管：到达的缓冲进入每个 Pad 的小积压队列（满则丢最旧），
+ * 经 read() / tryRead() 在循环线程取得；节点不应再自行设置这些 Pad 的数据回调。
+ * 关闭后登记均失败，挂起的 read() 以空 BufferRef 回调。
+ */
+class AsyncContext {
+public:
+    using ReadCallback = std::function<void(BufferRef buffer)>;  // 上下文关闭时 buffer 无效
+
+    static constexpr std::size_t kReadBacklog = 8;  // 每个输入 Pad 的积压上限
+
+    AsyncContext(AsyncLoop& loop, Node& node);
+    ~AsyncContext();
+
+    AsyncContext(const AsyncContext&) = delete;
+    AsyncContext& operator=(const AsyncContext&) = delete;
+
+    Node& node() const noexcept { return node_; }
+    AsyncLoop& loop() const noexcept { return loop_; }
+    bool closed() const noexcept { return closed_.load(std::memory_order_acquire); }
+
+    bool post(AsyncLoop::Task task);
+    AsyncLoop::TimerId after(std::chrono::nanoseconds delay, AsyncLoop::TimerCallback callback);
+    bool watch(int fd, std::uint32_t events, AsyncLoop::FdCallback callback);
+
+    // 取出 pad 积压的最早一个缓冲；pad 不是本节点的输入 Pad 或无积压时返回 false
+    bool tryRead(Pad& pad, BufferRef& out);
+    /**
+     * 等待 pad 的下一个缓冲，到达后在循环线程回调一次（已有积压时下一轮循环即回调）
+     * @return 上下文已关闭、pad 不是输入 Pad 或该 Pad 已有未完成的 read() 时返回 false 且不回调
+     */
+    bool read(Pad& pad, ReadCallback callback);
+    // 积压队列满而丢弃的缓冲数
+    std::uint64_t droppedReads() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    // 由 PipelineScheduler 调用：输入 Pad 的到达通知（任意线程）与停止时关闭
+    void notifyArrival();
+    void close();
+
+private:
+    struct Inbox {
+        Pad* pad{nullptr};
+        std::deque<BufferRef> items;
+        ReadCallback waiter;
+    };
+    Inbox* inbox(const Pad& pad);
+    void drainAndDispatch();
+
+    AsyncLoop& loop_;
+    Node& node_;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Inbox>> inboxes_;  // 构造时建立，之后不增删
+    std::atomic<bool> closed_{false};
+    std::atomic<bool> dispatchPosted_{false};
+    std::atomic<std::uint64_t> dropped_{0};
+};
+
+/**
+ * AsyncNode - 以事件驱动方式运行的节点实现此接口（如 RPC 客户端、上行 socket、网络流源）
+ *
+ * 实现此接口的节点不再由调度器调用 process()，也不占用 Source 线程或工作线程；Pipeline 进入 Playing 后
+ * 在事件循环线程上调用一次 startAsync()，节点在其中登记等待（或启动协程），之后全部逻辑由回调推进。
+ * 暂停（pause()）不影响异步节点。Pipeline 停止时先关闭上下文（取消全部等待），再调用 stopAsync()。
+ */
+class AsyncNode {
+public:
+    virtual ~AsyncNode() = default;
+    virtual void startAsync(AsyncContext& ctx) = 0;
+    // 上下文关闭之后、节点 stop() 之前调用（调度器线程）
+    virtual void stopAsync() {}
+};
+
+#if FALCONMIND_HAS_COROUTINES
+
+/**
+ * AsyncTask - 即发即弃的协程（C++20 编译单元可用）：调用即开始执行，完成后自行销毁
+ * 在 startAsync() 中启动，全部 co_await 在事件循环线程恢复；等待结果为“已取消”时应尽快 co_return
+ *
+ *   AsyncTask run(AsyncContext& ctx) {
+ *       while (BufferRef frame = co_await nextBuffer(ctx, *inPad)) { ... co_await waitWritable(ctx, fd); ... }
+ *   }
+ */
+class AsyncTask {
+public:
+    struct promise_type {
+        AsyncTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+            try {
+                throw;
+            } catch (const std::exception& e) {
+                FM_LOG_ERROR("AsyncTask", "coroutine threw: ", e.what());
+            } catch (...) {
+                FM_LOG_ERROR("AsyncTask", "coroutine threw unknown exception");
+            }
+        }
+    };
+};
+
+// co_await sleepFor(ctx, d)：到时为 true，上下文关闭为 false
+struct SleepAwaiter {
+    AsyncContext& ctx;
+    std::chrono::nanoseconds delay;
+    bool fired{false};
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> h) {
+        return ctx.after(delay, [this, h](bool f) {
+            fired = f;
+            h.resume();
+        }) != 0;
+    }
+    bool await_resume() const noexcept { return fired; }
+};
+
+// co_await waitReadable / waitWritable：返回就绪事件（EPOLLIN 等），关闭或无法等待时为 0
+struct FdAwaiter {
+    AsyncContext& ctx;
+    int fd;
+    std::uint32_t events;
+    std::uint32_t revents{0};
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> h) {
+        return ctx.watch(fd, events, [this, h](std::uint32_t r) {
+            revents = r;
+            h.resume();
+        });
+    }
+    std::uint32_t await_resume() const noexcept { return revents; }
+};
+
+// co_await nextBuffer(ctx, pad)：返回下一个缓冲，上下文关闭时为无效 BufferRef
+struct ReadAwaiter {
+    AsyncContext& ctx;
+    Pad& pad;
+    BufferRef buffer;
+
+    bool await_ready() { return ctx.tryRead(pad, buffer); }
+    bool await_suspend(std::coroutine_handle<> h) {
+        return ctx.read(pad, [this, h](BufferRef b) {
+            buffer = std::move(b);
+            h.resume();
+        });
+    }
+    BufferRef await_resume() noexcept { return std::move(buffer); }
+};
+
+inline SleepAwaiter sleepFor(AsyncContext& ctx, std::chrono::nanoseconds delay) {
+    return SleepAwaiter{ctx, delay};
+}
+inline FdAwaiter waitReadable(AsyncContext& ctx, int fd) {
+    return FdAwaiter{ctx, fd, EPOLLIN | EPOLLRDHUP};
+}
+inline FdAwaiter waitWritable(AsyncContext& ctx, int fd) {
+    return FdAwaiter{ctx, fd, EPOLLOUT};
+}
+inline ReadAwaiter nextBuffer(AsyncContext& ctx, Pad& pad) {
+    return ReadAwaiter{ctx, pad, {}};
+}
+
+#endif // FALCONMIND_HAS_COROUTINES
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,57 @@
+// FalconMindSDK - 在专用线程中按批调用外部处理函数的节点（供 Python 等解释器实现节点逻辑）
+#pragma once
+
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/PadTapNode.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+/**
+ * BatchCallbackNode - Sink Pad "in" 收到的缓冲进入有界队列（满时丢弃最旧），专用线程每次取出至多
+ * batchSize 条交给 handler，handler 追加到 outputs 的缓冲经 Source Pad "out" 推送（零拷贝）。
+ *
+ * 调度器线程只做入队，从不调用 handler：handler 需要获取解释器锁（Python GIL）时只阻塞本节点的线程，
+ * 不阻塞其它 C++ 节点；积压时一批处理多条，锁的获取次数按批而非按帧计。
+ * handler 只在专用线程中调用（start 之后、stop 返回之前）
+ */
+class BatchCallbackNode : public Node {
+public:
+    using BatchHandler = std::function<void(std::vector<BufferRef>& inputs, std::vector<BufferRef>& outputs)>;
+
+    struct Config {
+        std::size_t batchSize{8};
+        std::size_t queueCapacity{16};
+    };
+
+    explicit BatchCallbackNode(BatchHandler handler);
+    BatchCallbackNode(BatchHandler handler, const Config& config);
+    ~BatchCallbackNode() override;
+
+    bool start() override;
+    void stop() override;
+
+    std::uint64_t batches() const noexcept { return batches_.load(std::memory_order_relaxed); }
+    std::uint64_t processed() const noexcept { return processed_.load(std::memory_order_relaxed); }
+    std::uint64_t dropped() const noexcept { return queue_.dropped(); }
+
+private:
+    void workerLoop();
+
+    BatchHandler handler_;
+    Config config_;
+    PadTapQueue queue_;
+    Pad* outPad_{nullptr};
+    std::atomic<bool> running_{false};
+    std::thread worker_;
+    std::atomic<std::uint64_t> batches_{0};
+    std::atomic<std::uint64_t> processed_{0};
+};
+
+} // namespace falconmind::sdk::core
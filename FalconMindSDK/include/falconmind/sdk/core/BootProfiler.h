@@ -0,0 +1,86 @@
+// FalconMindSDK - BootProfiler：上电到“感知就绪”的启动时间线，导出 Chrome trace JSON
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+struct BootSpanRecord {
+    std::string name;
+    std::string category;
+    std::int64_t startNs{0};     // CLOCK_BOOTTIME（自上电起）
+    std::int64_t durationNs{0};  // < 0 为瞬时事件
+    std::uint32_t threadId{0};
+};
+
+/**
+ * BootProfiler - 启动阶段的耗时区间记录（进程内单例）
+ *
+ * 时基为 CLOCK_BOOTTIME，trace 中的时间即自上电起的时刻；enable() 时补记进程创建时刻（process_start），
+ * 可直接看出内核与 init 占用的部分。记录在 NodeAgent 连接、Flow 下发/加载/启动、节点 start（V4L2 初始化）、
+ * 模型 load() 与预热处插入（BootSpan）。只用于低频的启动路径：每条记录加锁追加，总数上限 kMaxSpans。
+ *
+ * 环境变量 FALCONMIND_BOOT_TRACE=文件路径 时首次 instance() 即开启；finish() 记录就绪时刻、写出 trace
+ * 并停止记录（之后的热更新不再计入）。Chrome trace 可在 chrome://tracing 或 ui.perfetto.dev 打开。
+ */
+class BootProfiler {
+public:
+    static constexpr std::size_t kMaxSpans = 4096;
+
+    static BootProfiler& instance();
+
+    // 开启记录；outputPath 非空时 finish() 写入该文件
+    void enable(const std::string& outputPath = {});
+    void disable();
+    bool enabled() const noexcept;
+    void reset();
+
+    static std::int64_t nowNs() noexcept;  // CLOCK_BOOTTIME
+
+    void record(std::string name, const char* category, std::int64_t startNs, std::int64_t endNs);
+    // 瞬时事件（如“已连接”“首帧”）
+    void mark(std::string name, const char* category = "boot");
+
+    /**
+     * 记录就绪事件并写出 trace（仅第一次调用生效），随后停止记录
+     * @return 本次写出了 trace 文件时返回 true
+     */
+    bool finish(const std::string& readyName = "ready");
+
+    std::vector<BootSpanRecord> spans() const;
+    std::string toChromeTrace() const;
+    bool writeChromeTrace(const std::string& path) const;
+
+private:
+    BootProfiler();
+
+    mutable std::mutex mutex_;
+    bool enabled_{false};
+    bool finished_{false};
+    std::string outputPath_;
+    std::vector<BootSpanRecord> spans_;
+};
+
+/**
+ * BootSpan - 作用域计时：构造到析构记为一条区间；BootProfiler 未开启时不计时、不分配
+ */
+class BootSpan {
+public:
+    explicit BootSpan(const char* name, const char* category = "boot");
+    BootSpan(std::string name, const char* category);
+    ~BootSpan();
+
+    BootSpan(const BootSpan&) = delete;
+    BootSpan& operator=(const BootSpan&) = delete;
+
+private:
+    std::string name_;
+    const char* category_;
+    std::int64_t startNs_{-1};  // -1 表示未记录
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,52 @@
+// FalconMindSDK - 分支开关接口：GateNode / SelectorNode 截断某一输出时通知 Pipeline，让该分支下游释放缓冲
+#pragma once
+
+#include <functional>
+#include <mutex>
+
+namespace falconmind::sdk::core {
+
+class Pad;
+
+/**
+ * BranchSwitch - 可在运行中截断某一输出的路由节点（GateNode、SelectorNode）实现此接口
+ *
+ * 输出从导通变为截断时调用 branchClosed(output)。Pipeline 进入 Playing 时为开关节点安装回调：
+ * 找出只经由该输出供数的下游节点（多路输入中另有来源的节点不算），请调度器在这些节点各自的调度上下文中
+ * 调用 BranchIdleSink::releaseIdleBuffers()。回调可在任意线程触发（切换开关的线程或推送线程）。
+ */
+class BranchSwitch {
+public:
+    using ClosedCallback = std::function<void(Pad* output)>;
+
+    virtual ~BranchSwitch() = default;
+
+    // 由 Pipeline 设置 / 清除
+    void setBranchClosedCallback(ClosedCallback callback) {
+        std::lock_guard<std::mutex> lock(closedMutex_);
+        closed_ = std::move(callback);
+    }
+
+protected:
+    void branchClosed(Pad* output) {
+        std::lock_guard<std::mutex> lock(closedMutex_);
+        if (closed_) closed_(output);
+    }
+
+private:
+    std::mutex closedMutex_;
+    ClosedCallback closed_;
+};
+
+/**
+ * BranchIdleSink - 持有帧缓冲池 / 缓存帧的节点实现此接口
+ * 上游开关截断本节点所在分支后调用一次：释放缓冲池的空闲缓冲与暂存的帧，分支重新导通时按需再分配。
+ * 由调度器在本节点 process() 之后调用，不与 process() 并发
+ */
+class BranchIdleSink {
+public:
+    virtual ~BranchIdleSink() = default;
+    virtual void releaseIdleBuffers() = 0;
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,135 @@
+// FalconMindSDK - 引用计数的零拷贝数据缓冲（BufferRef），用于 Pad 间传递帧数据
+#pragma once
+
+#include "falconmind/sdk/core/Caps.h"
+#include "falconmind/sdk/core/DeviceMemory.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+// 帧在源图像（传感器全幅）中的位置：生产者输出裁剪窗口（如跟踪 ROI）时填写，下游据此把结果换算回全幅坐标
+struct FrameRegion {
+    std::int32_t x{0};
+    std::int32_t y{0};
+    std::int32_t sourceWidth{0};   // 0 表示整帧（未裁剪）
+    std::int32_t sourceHeight{0};
+
+    bool cropped() const noexcept { return sourceWidth > 0; }
+};
+
+// 随缓冲一起传递的元数据
+struct BufferMeta {
+    std::int64_t timestampNs{0};   // 采集时间戳（PipelineClock 时基；0 表示未知），下游转发时原样保留
+    std::uint64_t frameIndex{0};   // 生产者内单调递增的帧序号
+    VideoCaps video;               // 视频帧格式（生产者按协商结果填写；Any 表示未知）
+    int dmabufFd{-1};              // 数据所在的 DMABUF（如 V4L2 导出的采集缓冲；-1 表示无），持有缓冲期间有效，
+                                   // 不转移所有权；写时复制出私有副本后清为 -1
+    FrameRegion region;            // 裁剪输出在源图像中的位置（未裁剪时为默认值）
+};
+
+struct BufferDomainState;
+
+/**
+ * 缓冲存储：自有内存（owned）或外部内存（external 持有其生命周期，如 mmap/DMABUF/缓冲池），
+ * 或设备内存（device 非空：data 为 nullptr，owned 只保存帧头的 host 副本，像素的 host 视图按需生成）
+ */
+struct BufferStorage {
+    std::uint8_t* data{nullptr};
+    std::size_t size{0};
+    std::vector<std::uint8_t> owned;
+    std::shared_ptr<void> external;
+    const void* owner{nullptr};  // 分配者标记：缓冲池/连接队列据此识别可回收复用的自有缓冲
+    bool readOnly{false};        // 外部内存不可写（如只读 mmap）：mutableData() 总是先复制
+    BufferMeta meta;
+    std::shared_ptr<DeviceMemory> device;
+    std::shared_ptr<BufferDomainState> domainState;  // 缓存的 host 视图 / 其它域视图（首次需要时创建）
+};
+
+/**
+ * BufferRef - 共享所有权的缓冲句柄
+ *
+ * - 拷贝 BufferRef 只增加引用计数，不拷贝数据；下游可持有帧而无需 assign 拷贝
+ * - mutableData()/mutableMeta() 为写时复制：若缓冲被多个持有者共享，先复制一份私有副本再返回
+ * - 最后一个引用释放时存储随之释放（外部内存由 external 的删除器负责归还）
+ * - 设备缓冲（wrapDevice）的 data() 首次调用时才迁移到 host（映射或复制，结果缓存在存储上）；
+ *   设备节点经 deviceView() 取得数据，设备到设备的链路不经过 CPU
+ */
+class BufferRef {
+public:
+    // 为 host 缓冲生成目标域视图（如 cudaMemcpy 到设备、导入为 rknn_tensor_mem）；失败返回 nullptr
+    using DeviceImporter = std::function<std::shared_ptr<DeviceMemory>(const BufferRef& buffer)>;
+
+    BufferRef() = default;
+    explicit BufferRef(std::shared_ptr<BufferStorage> storage) : storage_(std::move(storage)) {}
+
+    // 分配 size 字节的自有缓冲（内容未初始化为特定值）
+    static BufferRef allocate(std::size_t size);
+    // 拷贝 data/size 构造自有缓冲
+    static BufferRef copyFrom(const void* data, std::size_t size);
+    // 包装外部内存；holder 在最后一个引用释放时析构（可用于归还 V4L2/池缓冲）
+    static BufferRef wrap(std::uint8_t* data, std::size_t size, std::shared_ptr<void> holder);
+    // 包装只读外部内存：mutableData() 复制出私有副本；mutableMeta() 不复制数据
+    static BufferRef wrapReadOnly(const std::uint8_t* data, std::size_t size, std::shared_ptr<void> holder);
+    /**
+     * 包装设备内存：缓冲内容为 header（host 上的帧头，如 CameraFramePacket）后接 memory 的 size() 字节。
+     * 与 V4L2 导出缓冲相同，memory 的 fd / 句柄只覆盖帧头之后的像素；无帧头时 host 视图可零拷贝映射
+     */
+    static BufferRef wrapDevice(std::shared_ptr<DeviceMemory> memory, const void* header = nullptr,
+                                std::size_t headerSize = 0);
+
+    bool valid() const noexcept { return storage_ != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+
+    // host 可读的数据；设备缓冲在这里迁移（失败返回 nullptr）
+    const std::uint8_t* data() const noexcept {
+        return storage_ ? (storage_->data ? storage_->data : hostView()) : nullptr;
+    }
+    std::size_t size() const noexcept { return storage_ ? storage_->size : 0; }
+    const BufferMeta& meta() const;
+
+    /**
+     * 读取开头 bytes 字节（帧头）而不迁移设备缓冲：host 缓冲同 data()；设备缓冲返回 wrapDevice() 的帧头，
+     * 帧头不足 bytes 时才退回 data()
+     */
+    const std::uint8_t* headerData(std::size_t bytes) const noexcept;
+
+    MemoryDomain domain() const noexcept {
+        return storage_ && storage_->device ? storage_->device->domain() : MemoryDomain::Host;
+    }
+    // 数据已可由 host 直接读取（host 缓冲，或设备缓冲已生成 host 视图）
+    bool hostResident() const noexcept;
+    const std::shared_ptr<DeviceMemory>& deviceMemory() const noexcept;
+    // 数据所在的 dma-buf fd：设备内存的 fd，否则为 meta().dmabufFd
+    int dmabufFd() const noexcept;
+
+    /**
+     * 取得 target 域中的数据视图
+     * - 数据已在 target 域：返回缓冲自身的设备内存（帧头之后的部分）
+     * - host 缓冲带 meta().dmabufFd 而 target 为 DmaBuf：返回借用该 fd 的 DmaBufMemory
+     * - 否则调用 import 生成视图并缓存在存储上，同一缓冲后续请求直接命中；import 为空或失败返回 nullptr
+     */
+    std::shared_ptr<DeviceMemory> deviceView(MemoryDomain target, const DeviceImporter& import = {}) const;
+
+    // 写时复制访问
+    std::uint8_t* mutableData();
+    BufferMeta& mutableMeta();
+
+    bool unique() const noexcept { return storage_ && storage_.use_count() == 1; }
+    long useCount() const noexcept { return storage_ ? storage_.use_count() : 0; }
+    void reset() noexcept { storage_.reset(); }
+
+    const std::shared_ptr<BufferStorage>& storage() const noexcept { return storage_; }
+
+private:
+    void makeUnique(bool writeData);
+    const std::uint8_t* hostView() const noexcept;
+
+    std::shared_ptr<BufferStorage> storage_;
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,80 @@
+// FalconMindSDK - 帧缓冲池：按 (width, height, format) 复用固定大小的 BufferRef 存储
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/MemoryBudget.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+struct BufferPoolKey {
+    std::int32_t width{0};
+    std::int32_t height{0};
+    std::string format;
+
+    bool operator==(const BufferPoolKey& other) const noexcept {
+        return width == other.width && height == other.height && format == other.format;
+    }
+};
+
+struct BufferPoolKeyHash {
+    std::size_t operator()(const BufferPoolKey& key) const noexcept;
+};
+
+struct BufferPoolConfig {
+    // 每个 key 最多由池管理的缓冲数（在途 + 空闲）；超出时临时分配，不归还池
+    std::size_t maxBuffersPerKey{8};
+};
+
+struct BufferPoolStats {
+    std::uint64_t allocations{0};          // 池内新分配次数
+    std::uint64_t reuses{0};               // 从空闲列表复用次数
+    std::uint64_t overflowAllocations{0};  // 超出 maxBuffersPerKey 的临时分配次数
+    std::size_t freeBuffers{0};            // 当前空闲缓冲数（所有 key）
+    std::size_t outstandingBuffers{0};     // 当前在途（被 BufferRef 持有）的池缓冲数
+    std::size_t pooledBytes{0};            // 池管理的缓冲字节数（空闲 + 在途，不含临时分配）
+};
+
+/**
+ * BufferPool - 帧缓冲池
+ *
+ * - acquire() 返回独占的 BufferRef；最后一个引用释放时内存自动归还对应 key 的空闲列表
+ * - 池先于缓冲析构是安全的：此时归还的缓冲直接释放
+ * - 对共享缓冲调用 mutableData() 的写时复制副本不属于池
+ * - 设置 MemoryAccount 后池缓冲与临时分配均计入该账户（通常为所属节点的 MemoryBudgetSink::memoryAccount()）
+ */
+class BufferPool {
+public:
+    explicit BufferPool(const BufferPoolConfig& cfg = {});
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    // 获取 size 字节的缓冲（内容为上次使用残留，调用方负责完整写入）
+    BufferRef acquire(const BufferPoolKey& key, std::size_t size);
+
+    // 释放全部空闲缓冲（在途缓冲归还时仍会进入空闲列表）
+    void clear();
+
+    // 记账账户；已持有的池缓冲随之转入新账户，nullptr 为不记账
+    void setMemoryAccount(std::shared_ptr<MemoryAccount> account);
+    // 调整每个 key 的缓冲数上限：超出部分的空闲缓冲立即释放，在途缓冲归还时释放
+    void setMaxBuffersPerKey(std::size_t maxBuffers);
+    std::size_t maxBuffersPerKey() const;
+
+    BufferPoolStats stats() const;
+
+private:
+    struct Shared;
+    std::shared_ptr<Shared> shared_;
+};
+
+} // namespace falconmind::sdk::core
@@ -1,31 +1,126 @@
-// FalconMindSDK - Bus skeleton for events/logs between nodes and pipeline
+// FalconMindSDK - Bus: events/logs between nodes and pipeline (thread-safe pub/sub)
 #pragma once
 
+#include "falconmind/sdk/core/BoundedQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace falconmind::sdk::core {
 
+/**
+ * BusCategory - 驻留（interned）的消息类别
+ * 同名类别全局共享同一个 id，消息只携带 4 字节 id；id 0 表示空类别。
+ * 从字符串构造需查全局表（加锁），热路径应缓存，如 static const BusCategory kDetection("detection");
+ */
+class BusCategory {
+public:
+    using Id = std::uint32_t;
+
+    BusCategory() = default;
+    BusCategory(const char* name);         // NOLINT(google-explicit-constructor)：允许 BusMessage{"cat", "text"}
+    BusCategory(const std::string& name);  // NOLINT(google-explicit-constructor)
+
+    static BusCategory fromId(Id id) noexcept;
+
+    Id id() const noexcept { return id_; }
+    const std::string& name() const;
+
+    bool operator==(const BusCategory& o) const noexcept { return id_ == o.id_; }
+    bool operator!=(const BusCategory& o) const noexcept { return id_ != o.id_; }
+    bool operator==(const std::string& s) const { return name() == s; }
+    bool operator!=(const std::string& s) const { return name() != s; }
+    bool operator==(const char* s) const { return name() == s; }
+
+private:
+    Id id_{0};
+};
+
 struct BusMessage {
-    std::string category;
+    BusCategory category;
     std::string text;
 };
 
+struct BusConfig {
+    // postAsync 队列容量（向上取整为 2 的幂）；队列满时丢弃新消息并计数
+    std::size_t asyncQueueCapacity{1024};
+};
+
+/**
+ * Bus - 线程安全的发布/订阅总线
+ *
+ * - subscribe/unsubscribe 可在任意线程调用；订阅表写时复制，分发路径不加锁
+ * - post：在调用线程同步分发
+ * - postAsync：无锁入队后立即返回，由专用分发线程（首次 postAsync 时启动）依序投递，
+ *   适合在 Node::process() 等热路径上报事件，不受慢速处理函数（如日志落盘）影响
+ * - unsubscribe 返回后，并发进行中的一次分发仍可能调用到该处理函数
+ */
 class Bus {
 public:
     using Handler = std::function<void(const BusMessage&)>;
 
+    explicit Bus(const BusConfig& cfg = {});
+    ~Bus();
+
+    Bus(const Bus&) = delete;
+    Bus& operator=(const Bus&) = delete;
+
+    // 订阅全部类别
     int subscribe(const Handler& handler);
+    // 只订阅指定类别
+    int subscribe(const BusCategory& category, const Handler& handler);
     void unsubscribe(int id);
 
     void post(const BusMessage& msg);
+    // 非阻塞投递；队列满时返回 false（消息丢弃，计入 droppedCount）
+    bool postAsync(BusMessage msg);
+
+    // 等待此前 postAsync 的消息分发完毕；超时返回 false
+    bool flush(std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+    std::uint64_t droppedCount() const noexcept { return dropped_.load(std::memory_order_relaxed); }
 
 private:
+    struct Subscription {
+        int id;
+        Handler handler;
+    };
+    struct Subscribers {
+        std::vector<Subscription> all;
+        std::vector<std::vector<Subscription>> byCategory;  // 下标为 BusCategory::Id
+    };
+
+    std::shared_ptr<const Subscribers> snapshot() const;
+    void dispatch(const BusMessage& msg) const;
+    void ensureDispatcher();
+    void dispatchLoop();
+
+    BusConfig config_;
+
+    std::mutex subscribeMutex_;  // 仅串行化订阅表的修改
     int nextId_{1};
-    std::unordered_map<int, Handler> handlers_;
+    std::shared_ptr<const Subscribers> subscribers_;  // 通过 std::atomic_load/atomic_store 访问
+
+    BoundedQueue<BusMessage> queue_;
+    std::atomic<std::uint64_t> enqueued_{0};
+    std::atomic<std::uint64_t> dispatched_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    std::once_flag dispatcherOnce_;
+    std::thread dispatcher_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> idle_{false};  // 分发线程即将休眠，生产者需唤醒
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
 };
 
 } // namespace falconmind::sdk::core
-
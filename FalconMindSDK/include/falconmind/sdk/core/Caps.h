@@ -1,11 +1,93 @@
-// FalconMindSDK - Caps (capabilities) skeleton
+// FalconMindSDK - Caps (capabilities)：Pad 能力描述与连接时格式协商
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace falconmind::sdk::core {
 
+// 视频像素格式（协商在 link 时完成，逐帧处理只比较枚举）
+enum class PixelFormat : std::uint8_t {
+    Any = 0,  // 未指定 / 接受任意格式
+    RGB8,
+    BGR8,
+    NV12,
+    YUYV
+};
+
+// "RGB8"/"BGR8"/"NV12"/"YUYV"（大小写不敏感）→ PixelFormat；无法识别返回 Any
+PixelFormat parsePixelFormat(const std::string& name);
+const char* pixelFormatName(PixelFormat format) noexcept;
+// 紧凑排列（stride = 最小行宽）时一帧的字节数；Any 或尺寸无效返回 0
+std::size_t pixelFormatFrameBytes(PixelFormat format, std::int32_t width, std::int32_t height) noexcept;
+// 紧凑排列时的行字节数（NV12 为 Y 平面行宽）
+std::int32_t pixelFormatMinStride(PixelFormat format, std::int32_t width) noexcept;
+
+/**
+ * PixelFormatTraits - 编译期像素格式属性，供按格式特化的像素内核使用
+ *
+ * 内核以 PixelFormat 为模板参数实例化，协商完成后按枚举选择一次实例；
+ * 内层循环中的通道下标、每像素字节数均为常量，不再按格式分支
+ */
+template <PixelFormat F>
+struct PixelFormatTraits;
+
+template <>
+struct PixelFormatTraits<PixelFormat::RGB8> {
+    static constexpr int bytesPerPixel = 3;
+    static constexpr bool rgbLike = true;
+    static constexpr bool yuv = false;
+    static constexpr int rIndex = 0;
+    static constexpr int bIndex = 2;
+};
+
+template <>
+struct PixelFormatTraits<PixelFormat::BGR8> {
+    static constexpr int bytesPerPixel = 3;
+    static constexpr bool rgbLike = true;
+    static constexpr bool yuv = false;
+    static constexpr int rIndex = 2;
+    static constexpr int bIndex = 0;
+};
+
+// NV12 的 bytesPerPixel 为 Y 平面每像素字节数
+template <>
+struct PixelFormatTraits<PixelFormat::NV12> {
+    static constexpr int bytesPerPixel = 1;
+    static constexpr bool rgbLike = false;
+    static constexpr bool yuv = true;
+};
+
+template <>
+struct PixelFormatTraits<PixelFormat::YUYV> {
+    static constexpr int bytesPerPixel = 2;
+    static constexpr bool rgbLike = false;
+    static constexpr bool yuv = true;
+};
+
+// 单个视频格式描述；数值字段为 0 表示不限
+struct VideoCaps {
+    PixelFormat format{PixelFormat::Any};
+    std::int32_t width{0};
+    std::int32_t height{0};
+    std::int32_t fps{0};
+
+    bool isFixed() const noexcept {
+        return format != PixelFormat::Any && width > 0 && height > 0;
+    }
+    // 两个描述是否存在交集
+    bool intersects(const VideoCaps& other) const noexcept;
+    // 取交集（调用前应确认 intersects）：未限定的字段取对方的值
+    VideoCaps intersect(const VideoCaps& other) const noexcept;
+
+    bool operator==(const VideoCaps& o) const noexcept {
+        return format == o.format && width == o.width && height == o.height && fps == o.fps;
+    }
+};
+
 class Caps {
 public:
     Caps() = default;
@@ -13,9 +95,22 @@ public:
     void set(const std::string& key, const std::string& value);
     const std::unordered_map<std::string, std::string>& properties() const noexcept { return props_; }
 
+    // 视频格式列表，按偏好顺序排列；为空表示该 Pad 不参与视频格式协商
+    void addVideo(const VideoCaps& caps) { video_.push_back(caps); }
+    void clearVideo() noexcept { video_.clear(); }
+    const std::vector<VideoCaps>& video() const noexcept { return video_; }
+    bool hasVideo() const noexcept { return !video_.empty(); }
+
 private:
     std::unordered_map<std::string, std::string> props_;
+    std::vector<VideoCaps> video_;
 };
 
-} // namespace falconmind::sdk::core
+/**
+ * 连接时协商：按下游（消费者）偏好顺序查找上游可提供的格式
+ * 一侧未声明视频能力时视为接受任意格式，直接采用另一侧的首选项。
+ * @return 无公共格式返回 false
+ */
+bool negotiateVideoCaps(const Caps& upstream, const Caps& downstream, VideoCaps& out);
 
+} // namespace falconmind::sdk::core
@@ -0,0 +1,164 @@
+// FalconMindSDK - 录制/回放：把任意 Pad 的缓冲连同时间戳写入带索引的追加式文件，并以 mmap 零拷贝回放
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/PipelineScheduler.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+/**
+ * 捕获文件格式（本机字节序，所有记录 8 字节对齐，回放时可直接把 mmap 内的负载作为帧缓冲）：
+ *
+ *   FileHeader | Record 0 | Record 1 | ... | [Index | Footer]
+ *
+ * - Record：记录头（大小、时间戳、帧序号、视频格式）+ 负载 + 对齐填充
+ * - Index/Footer 在正常 close() 时追加；进程崩溃留下的无索引文件在打开时顺序扫描重建，末尾残缺的记录被忽略
+ */
+class CaptureWriter {
+public:
+    ~CaptureWriter();
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    // 新建（覆盖已有文件）；失败返回 nullptr
+    static std::unique_ptr<CaptureWriter> create(const std::string& path);
+
+    // 追加一条记录（线程安全）
+    bool append(const void* data, std::size_t size, const BufferMeta& meta);
+    bool append(const BufferRef& buffer) { return append(buffer.data(), buffer.size(), buffer.meta()); }
+    // 写入索引并关闭；析构时自动调用
+    bool close();
+
+    const std::string& path() const noexcept { return path_; }
+    std::uint64_t records() const noexcept { return records_.load(std::memory_order_relaxed); }
+    std::uint64_t bytes() const noexcept { return bytes_.load(std::memory_order_relaxed); }
+
+private:
+    CaptureWriter(std::string path, int fd);
+
+    std::string path_;
+    int fd_{-1};
+    std::mutex mutex_;
+    std::uint64_t offset_{0};
+    std::vector<std::uint64_t> index_;  // 各记录头的文件偏移
+    std::atomic<std::uint64_t> records_{0};
+    std::atomic<std::uint64_t> bytes_{0};
+};
+
+struct CaptureRecord {
+    const std::uint8_t* data{nullptr};  // 指向 mmap 区域
+    std::size_t size{0};
+    BufferMeta meta;  // 录制时的元数据（timestampNs 为原始采集时间）
+};
+
+// 只读 mmap 捕获文件；reader 与由其产生的 BufferRef 共享映射，最后一个释放时解除映射
+class CaptureReader : public std::enable_shared_from_this<CaptureReader> {
+public:
+    ~CaptureReader();
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    // 文件不存在或不是捕获文件时返回 nullptr
+    static std::shared_ptr<CaptureReader> open(const std::string& path);
+    // 只检查文件头魔数（用于区分捕获文件与原始数据文件）
+    static bool isCaptureFile(const std::string& path);
+
+    std::size_t size() const noexcept { return records_.size(); }
+    bool empty() const noexcept { return records_.empty(); }
+    const CaptureRecord& record(std::size_t index) const { return records_[index]; }
+    // 零拷贝：返回指向映射的 BufferRef（meta 为录制时的元数据，可按需修改，不影响文件）
+    BufferRef buffer(std::size_t index) const;
+    // 文件带有完整索引（false 表示由顺序扫描恢复）
+    bool indexed() const noexcept { return indexed_; }
+    const std::string& path() const noexcept { return path_; }
+
+private:
+    CaptureReader() = default;
+    bool load();
+    bool loadIndex();
+    void scan();
+
+    std::string path_;
+    std::uint8_t* base_{nullptr};
+    std::size_t length_{0};
+    bool indexed_{false};
+    std::vector<CaptureRecord> records_;
+};
+
+/**
+ * CaptureRecorderNode - 把 Sink Pad "in" 收到的缓冲写入捕获文件（start 时创建，stop 时写索引关闭）
+ * 参数：path
+ */
+class CaptureRecorderNode : public Node {
+public:
+    explicit CaptureRecorderNode(std::string path = {});
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void stop() override;
+
+    const std::string& path() const noexcept { return path_; }
+    std::uint64_t recorded() const noexcept;
+
+private:
+    std::string path_;
+    std::shared_ptr<CaptureWriter> writer_;  // 仅在 start/stop 时替换；写入在投递线程
+    std::atomic<std::uint64_t> lastRecorded_{0};
+};
+
+/**
+ * ReplaySourceNode - mmap 捕获文件并经 Source Pad "out" 零拷贝回放
+ *
+ * - speed > 0：按录制时间间隔回放（1 为原速，2 为两倍速）；每次 process() 推送所有已到期的记录，
+ *   时间戳改写为回放时刻，下游时延统计保持有效
+ * - speed = 0：尽快回放，每次 process() 推送 batch 条（配合 PipelineScheduler::setNodePeriod(id, 0)）
+ * - 作为 TimedSource：手动步进的调度器（ReplayRunner）按下一条记录的到期时刻调用 process()，
+ *   以虚拟时钟回放时不等待、时间戳与按原速回放一致
+ * 参数：path、speed（"original"/"max" 或倍数）、loop、batch
+ */
+class ReplaySourceNode : public Node, public TimedSource {
+public:
+    explicit ReplaySourceNode(std::string path = {});
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void stop() override;
+    void pause() override;
+    void resume() override;
+    void process() override;
+    // speed = 0 时总是到期；未启动、已暂停或回放完毕时为 kNever
+    std::int64_t nextDueNs() const override;
+
+    const std::string& path() const noexcept { return path_; }
+    std::uint64_t replayed() const noexcept { return replayed_.load(std::memory_order_relaxed); }
+    bool finished() const noexcept { return finished_.load(std::memory_order_relaxed); }
+
+private:
+    void restartClock(std::int64_t nowNs);
+
+    Pad* outPad_{nullptr};
+    std::string path_;
+    double speed_{1.0};
+    bool loop_{false};
+    std::uint32_t batch_{1};
+    std::shared_ptr<CaptureReader> reader_;
+    std::size_t next_{0};
+    std::int64_t replayStartNs_{0};   // 回放时钟起点（对应 next_ 处记录的录制时间 recordStartNs_）
+    std::int64_t recordStartNs_{0};
+    std::int64_t pausedAtNs_{0};
+    std::uint64_t frameIndex_{0};
+    std::atomic<std::uint64_t> replayed_{0};
+    std::atomic<bool> finished_{false};
+    bool started_{false};
+};
+
+} // namespace falconmind::sdk::core
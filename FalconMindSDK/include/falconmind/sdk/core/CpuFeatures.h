@@ -0,0 +1,56 @@
+// FalconMindSDK - CPU 指令集检测与内核分发级别（x86 CPUID / arm64 HWCAP）
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace falconmind::sdk::core {
+
+// 内核分发级别，同一架构内后者包含前者
+enum class CpuIsa : std::uint8_t {
+    Scalar = 0,
+    Sse41,   // x86：SSE4.1
+    Avx2,    // x86：AVX2 + FMA + F16C
+    Avx512,  // x86：AVX-512 F/BW/VL
+    Neon,    // arm64：ASIMD（基线）
+    Sve      // arm64：SVE
+};
+
+const char* cpuIsaName(CpuIsa isa) noexcept;
+// "scalar" / "sse4.1" / "avx2" / "avx512" / "neon" / "sve"（大小写不敏感）
+bool parseCpuIsa(const std::string& name, CpuIsa& out);
+
+/**
+ * CpuFeatures - 运行时可用的指令集扩展
+ *
+ * 首次调用时检测一次。各向量内核在编译期以 target 属性单独生成 SSE4.1 / AVX2 / AVX-512 版本，
+ * 运行时据此选择，同一份二进制在不同板卡上使用各自最快的实现。
+ * 环境变量 FALCONMIND_CPU_ISA（如 "avx2"、"scalar"）可把分发级别压低到指定级别，
+ * 用于复现其他板卡上的行为或排查向量内核；高于硬件能力的取值不生效
+ */
+struct CpuFeatures {
+    bool sse41{false};
+    bool avx{false};
+    bool avx2{false};
+    bool fma{false};
+    bool f16c{false};
+    bool avx512f{false};
+    bool avx512bw{false};
+    bool avx512vl{false};
+    bool neon{false};
+    bool sve{false};
+
+    // 满足 isa 级别所需的全部扩展
+    bool supports(CpuIsa isa) const noexcept;
+    // 可用的最高分发级别
+    CpuIsa best() const noexcept;
+};
+
+// 已按 FALCONMIND_CPU_ISA 压低后的特性
+const CpuFeatures& cpuFeatures() noexcept;
+// 硬件检测结果（不受环境变量影响）
+CpuFeatures detectCpuFeatures() noexcept;
+// 日志 / 基准输出用："avx2 (sse4.1 avx avx2 fma f16c)"
+std::string cpuFeatureSummary();
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,30 @@
+// FalconMindSDK - 按依赖关系并行执行一次性任务（节点构造/启动等慢操作）
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+enum class DependencyTaskState : std::uint8_t {
+    NotRun,     // 因依赖失败或已有任务失败而未执行
+    Succeeded,
+    Failed
+};
+
+/**
+ * 在至多 maxThreads 个线程上并行执行 task(0..count-1)
+ * - task i 在 prerequisites[i] 中的任务全部成功后才开始（prerequisites 为空表示无依赖，须无环）
+ * - 任一任务失败（返回 false 或抛出异常）后不再开始新任务，已在执行的任务照常完成
+ * - maxThreads 为 0 时每个任务一个线程（任务多为 I/O 等待）；为 1 时在调用线程按依赖顺序串行执行
+ * @return 每个任务的执行结果
+ */
+std::vector<DependencyTaskState> runWithDependencies(
+    std::size_t count,
+    const std::vector<std::vector<std::size_t>>& prerequisites,
+    std::size_t maxThreads,
+    const std::function<bool(std::size_t)>& task);
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,90 @@
+// FalconMindSDK - 设备内存：缓冲的内存域（host / DMABUF / CUDA / NPU）与按需生成的 host 视图
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace falconmind::sdk::core {
+
+// 缓冲数据所在的内存域
+enum class MemoryDomain : std::uint8_t {
+    Host,
+    DmaBuf,  // dma-buf fd（V4L2 导出、DMA heap、RGA / 编码器输出）
+    Cuda,    // CUDA 设备内存（TensorRT / VPI）
+    Npu,     // NPU 内存（如 rknn_tensor_mem）
+};
+
+const char* memoryDomainName(MemoryDomain domain) noexcept;
+
+/**
+ * DeviceMemory - 位于非 host 内存中的一段数据，由产生它的后端实现（RGA / VPI / TensorRT / RKNN 等，
+ * 随各自的可选依赖编译）。BufferRef 持有它时数据留在设备上，只有 host 节点读取像素时才经
+ * mapHost()（零拷贝映射）或 download()（复制）生成 host 视图，视图缓存在缓冲上，同一帧只迁移一次
+ */
+class DeviceMemory {
+public:
+    virtual ~DeviceMemory() = default;
+
+    virtual MemoryDomain domain() const noexcept = 0;
+    virtual std::size_t size() const noexcept = 0;
+    // dma-buf fd（DmaBuf，或可导出为 dma-buf 的 NPU 内存）；没有时为 -1。fd 归本对象所有
+    virtual int fd() const noexcept { return -1; }
+    // 设备侧句柄：CUDA 设备指针、rknn_tensor_mem* 等；DmaBuf 为 nullptr
+    virtual void* handle() const noexcept { return nullptr; }
+    // 可直接映射到 host 时返回映射地址（size() 字节，有效期同本对象，由实现缓存）；不可映射返回 nullptr
+    virtual const std::uint8_t* mapHost() { return nullptr; }
+    // 不可映射时把全部内容复制到 dst（size() 字节）
+    virtual bool download(std::uint8_t* dst) = 0;
+};
+
+/**
+ * DmaBufMemory - dma-buf fd 上的设备内存；mapHost() 在首次调用时 mmap 并以 DMA_BUF_IOCTL_SYNC 开始 CPU 读，
+ * 析构时结束同步并解除映射。ownsFd 为 false 时不关闭 fd（如借用 V4L2 导出缓冲，由其持有者保证有效）
+ */
+class DmaBufMemory : public DeviceMemory {
+public:
+    DmaBufMemory(int fd, std::size_t size, bool ownsFd = true);
+    ~DmaBufMemory() override;
+
+    DmaBufMemory(const DmaBufMemory&) = delete;
+    DmaBufMemory& operator=(const DmaBufMemory&) = delete;
+
+    /**
+     * 从 DMA heap（/dev/dma_heap/system 等）分配 size 字节的 dma-buf
+     * @return 设备或权限不可用时返回 nullptr
+     */
+    static std::shared_ptr<DmaBufMemory> allocate(std::size_t size, const char* heap = "/dev/dma_heap/system");
+
+    MemoryDomain domain() const noexcept override { return MemoryDomain::DmaBuf; }
+    std::size_t size() const noexcept override { return size_; }
+    int fd() const noexcept override { return fd_; }
+    const std::uint8_t* mapHost() override;
+    bool download(std::uint8_t* dst) override;
+
+    // 可写映射（生产者填写帧头 / 像素），须在 mapHost() 之前调用（已有只读映射时返回 nullptr）；与 mapHost() 共用同一映射
+    std::uint8_t* mapWritable();
+
+private:
+    std::uint8_t* map(bool write);
+
+    int fd_;
+    std::size_t size_;
+    bool ownsFd_;
+    std::mutex mutex_;
+    std::uint8_t* mapped_{nullptr};
+    bool syncWrite_{false};
+};
+
+// 进程内的内存域迁移计数（relaxed 原子累加），用于确认设备链路上没有隐式回到 CPU
+struct MemoryDomainStats {
+    std::uint64_t hostMaps{0};       // 设备缓冲经 mapHost() 生成 host 视图（无帧头时零拷贝）
+    std::uint64_t hostDownloads{0};  // 设备缓冲经 download() 复制到 host
+    std::uint64_t deviceImports{0};  // deviceView() 调用导入函数生成的设备视图（host → 设备或跨域）
+    std::uint64_t viewCacheHits{0};  // deviceView() 命中缓存
+};
+
+MemoryDomainStats memoryDomainStats() noexcept;
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,152 @@
+// FalconMindSDK - 编译期定尺寸小矩阵（栈上存储、无堆分配），供卡尔曼滤波等固定维度估计使用
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace falconmind::sdk::core {
+
+/**
+ * Matrix<T, R, C> - 行主序定尺寸矩阵
+ *
+ * 维度在编译期检查，运算结果同样是定尺寸值类型；循环边界为常量，编译器可完全展开。
+ * 只提供状态估计需要的基本运算：加减、乘法、转置、分块读写与对称正定矩阵的 Cholesky 求逆。
+ */
+template <typename T, std::size_t R, std::size_t C>
+struct Matrix {
+    static constexpr std::size_t kRows = R;
+    static constexpr std::size_t kCols = C;
+
+    std::array<T, R * C> data{};
+
+    T& operator()(std::size_t r, std::size_t c) noexcept { return data[r * C + c]; }
+    const T& operator()(std::size_t r, std::size_t c) const noexcept { return data[r * C + c]; }
+    // 列向量（C == 1）按下标访问
+    T& operator[](std::size_t i) noexcept { return data[i]; }
+    const T& operator[](std::size_t i) const noexcept { return data[i]; }
+
+    static Matrix zero() noexcept { return Matrix{}; }
+
+    static Matrix identity() noexcept {
+        static_assert(R == C, "identity() requires a square matrix");
+        Matrix m{};
+        for (std::size_t i = 0; i < R; ++i) m(i, i) = T(1);
+        return m;
+    }
+
+    // 对角矩阵：d 为对角元素
+    static Matrix diagonal(const std::array<T, R>& d) noexcept {
+        static_assert(R == C, "diagonal() requires a square matrix");
+        Matrix m{};
+        for (std::size_t i = 0; i < R; ++i) m(i, i) = d[i];
+        return m;
+    }
+
+    Matrix<T, C, R> transpose() const noexcept {
+        Matrix<T, C, R> t;
+        for (std::size_t r = 0; r < R; ++r)
+            for (std::size_t c = 0; c < C; ++c) t(c, r) = (*this)(r, c);
+        return t;
+    }
+
+    // 从 (r0, c0) 起读取 BR×BC 子块
+    template <std::size_t BR, std::size_t BC>
+    Matrix<T, BR, BC> block(std::size_t r0, std::size_t c0) const noexcept {
+        static_assert(BR <= R && BC <= C, "block larger than matrix");
+        Matrix<T, BR, BC> b;
+        for (std::size_t r = 0; r < BR; ++r)
+            for (std::size_t c = 0; c < BC; ++c) b(r, c) = (*this)(r0 + r, c0 + c);
+        return b;
+    }
+
+    template <std::size_t BR, std::size_t BC>
+    void setBlock(std::size_t r0, std::size_t c0, const Matrix<T, BR, BC>& b) noexcept {
+        static_assert(BR <= R && BC <= C, "block larger than matrix");
+        for (std::size_t r = 0; r < BR; ++r)
+            for (std::size_t c = 0; c < BC; ++c) (*this)(r0 + r, c0 + c) = b(r, c);
+    }
+
+    Matrix& operator+=(const Matrix& o) noexcept {
+        for (std::size_t i = 0; i < R * C; ++i) data[i] += o.data[i];
+        return *this;
+    }
+    Matrix& operator-=(const Matrix& o) noexcept {
+        for (std::size_t i = 0; i < R * C; ++i) data[i] -= o.data[i];
+        return *this;
+    }
+    Matrix& operator*=(T s) noexcept {
+        for (auto& v : data) v *= s;
+        return *this;
+    }
+};
+
+template <typename T, std::size_t R, std::size_t C>
+Matrix<T, R, C> operator+(Matrix<T, R, C> a, const Matrix<T, R, C>& b) noexcept {
+    return a += b;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+Matrix<T, R, C> operator-(Matrix<T, R, C> a, const Matrix<T, R, C>& b) noexcept {
+    return a -= b;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+Matrix<T, R, C> operator*(Matrix<T, R, C> a, T s) noexcept {
+    return a *= s;
+}
+
+template <typename T, std::size_t R, std::size_t K, std::size_t C>
+Matrix<T, R, C> operator*(const Matrix<T, R, K>& a, const Matrix<T, K, C>& b) noexcept {
+    Matrix<T, R, C> m{};
+    for (std::size_t r = 0; r < R; ++r) {
+        for (std::size_t k = 0; k < K; ++k) {
+            const T v = a(r, k);
+            for (std::size_t c = 0; c < C; ++c) m(r, c) += v * b(k, c);
+        }
+    }
+    return m;
+}
+
+template <typename T, std::size_t N>
+using Vector = Matrix<T, N, 1>;
+
+/**
+ * 对称正定矩阵求逆（Cholesky 分解 A = L L^T）。A 非正定时返回 false，out 不变。
+ */
+template <typename T, std::size_t N>
+bool choleskyInverse(const Matrix<T, N, N>& a, Matrix<T, N, N>& out) noexcept {
+    Matrix<T, N, N> l{};
+    for (std::size_t j = 0; j < N; ++j) {
+        T d = a(j, j);
+        for (std::size_t k = 0; k < j; ++k) d -= l(j, k) * l(j, k);
+        if (!(d > T(0))) return false;
+        l(j, j) = std::sqrt(d);
+        for (std::size_t i = j + 1; i < N; ++i) {
+            T s = a(i, j);
+            for (std::size_t k = 0; k < j; ++k) s -= l(i, k) * l(j, k);
+            l(i, j) = s / l(j, j);
+        }
+    }
+    // L^-1（下三角），A^-1 = L^-T L^-1
+    Matrix<T, N, N> li{};
+    for (std::size_t i = 0; i < N; ++i) {
+        li(i, i) = T(1) / l(i, i);
+        for (std::size_t j = 0; j < i; ++j) {
+            T s = T(0);
+            for (std::size_t k = j; k < i; ++k) s -= l(i, k) * li(k, j);
+            li(i, j) = s / l(i, i);
+        }
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            T s = T(0);
+            for (std::size_t k = i; k < N; ++k) s += li(k, i) * li(k, j);
+            out(i, j) = s;
+            out(j, i) = s;
+        }
+    }
+    return true;
+}
+
+} // namespace falconmind::sdk::core
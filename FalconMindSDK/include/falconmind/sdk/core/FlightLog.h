@@ -0,0 +1,198 @@
+// FalconMindSDK - 机载飞行日志：每线程无锁暂存 + 后台写线程 + 预分配 mmap 环形文件，附只读解析与索引
+#pragma once
+
+#include "falconmind/sdk/core/Node.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+struct FlightLogFileHeader;  // 文件头布局（FlightLog.cpp）
+
+enum class LogRecordType : std::uint16_t {
+    Padding = 0,        // 环尾填充，读者跳过
+    MavlinkRx = 1,      // 收到的原始 MAVLink 数据（UDP 数据报 / 串口读批次）
+    MavlinkTx = 2,      // 发出的完整 MAVLink 帧
+    PipelineEvent = 3,  // 节点启停、错误、调度事件等
+    Detection = 4,      // 检测 / 跟踪结果（DetectionResultPacket 等二进制布局）
+    FlightState = 5,    // flight::FlightState 快照
+    Text = 6,           // UTF-8 文本
+    User = 0x100,       // 应用自定义类型从这里开始
+};
+
+const char* logRecordTypeName(LogRecordType type) noexcept;
+
+struct FlightLogConfig {
+    std::string path;
+    std::size_t fileBytes{64u << 20};     // 环形数据区大小（向上取整到页）；写满后覆盖最旧的记录
+    std::size_t stagingBytes{256u << 10}; // 每个记录线程的暂存区（向上取整到 2 的幂）
+    int flushIntervalMs{5};               // 写线程搬运暂存区的周期
+    int syncIntervalMs{1000};             // msync(MS_ASYNC) 周期，0 表示只在 close 时同步
+};
+
+struct FlightLogStats {
+    std::uint64_t records{0};      // 已写入文件的记录
+    std::uint64_t bytes{0};        // 已写入文件的负载字节
+    std::uint64_t dropped{0};      // 暂存区满或记录过大而丢弃的记录
+    std::uint64_t overwritten{0};  // 环形文件写满后被覆盖的旧记录
+    std::size_t threads{0};        // 注册过暂存区的线程数
+};
+
+/**
+ * FlightLogRecorder
+ *
+ * 文件格式（本机字节序）：4 KiB 文件头 + 环形数据区。记录 = 16 字节记录头（类型、线程号、负载长度、
+ * steady_clock 纳秒时间戳）+ 负载，按 16 字节对齐且不跨越环尾（放不下时以 Padding 记录填满到环尾再回绕）。
+ * 文件头中的 head / tail 为单调递增的逻辑偏移：[tail, head) 内总是完整记录——写线程先推进 tail 越过将被覆盖的
+ * 旧记录、再拷贝新记录、最后发布 head，进程崩溃后页缓存中的文件仍可按 head / tail 完整解析。
+ *
+ * 热路径 record()：按线程缓存的暂存区（单生产者单消费者字节环）写入记录头与负载后发布写位置——
+ * 不加锁、无系统调用、不分配；暂存区满时丢弃并计数，从不阻塞实时线程。每个线程首次记录时加锁注册一个暂存区。
+ * 写线程每 flushIntervalMs 把各暂存区搬进映射的环形文件，按 syncIntervalMs 异步 msync。
+ * 同一线程交替写入多个 recorder 时每次切换都会走注册查找，建议进程内只用一个 recorder。
+ */
+class FlightLogRecorder {
+public:
+    static constexpr std::size_t kMaxThreads = 64;
+    static constexpr std::size_t kRecordHeaderBytes = 16;
+
+    ~FlightLogRecorder();
+    FlightLogRecorder(const FlightLogRecorder&) = delete;
+    FlightLogRecorder& operator=(const FlightLogRecorder&) = delete;
+
+    // 新建并预分配日志文件（覆盖已有文件）、启动写线程；失败返回 nullptr
+    static std::unique_ptr<FlightLogRecorder> create(const FlightLogConfig& config);
+
+    // 任意线程调用；返回 false 表示已关闭、线程数超限或暂存区满（记录被丢弃）
+    bool record(LogRecordType type, const void* data, std::size_t size) noexcept;
+    bool record(LogRecordType type, const void* data, std::size_t size, std::int64_t timestampNs) noexcept;
+
+    // 阻塞直到调用前已暂存的记录全部写入映射文件
+    void flush();
+    // 搬运剩余记录、同步并关闭文件；之后的 record() 返回 false。析构时自动调用
+    void close();
+
+    const std::string& path() const noexcept { return config_.path; }
+    std::size_t capacity() const noexcept { return capacity_; }
+    FlightLogStats stats() const noexcept;
+
+private:
+    struct Staging;
+
+    explicit FlightLogRecorder(const FlightLogConfig& config);
+    bool open();
+    Staging* registerThread() noexcept;
+    void writerLoop();
+    // 把所有暂存区当前内容写入文件（仅写线程 / close 调用）
+    void drainAll();
+    void writeRecord(const std::uint8_t* header, const std::uint8_t* payload, std::size_t size);
+
+    FlightLogConfig config_;
+    std::uint64_t generation_{0};  // 进程内唯一，线程缓存据此识别 recorder（避免地址复用）
+    int fd_{-1};
+    std::uint8_t* map_{nullptr};
+    std::size_t mapBytes_{0};
+    FlightLogFileHeader* header_{nullptr};
+    std::uint8_t* ring_{nullptr};
+    std::size_t capacity_{0};
+
+    std::mutex registerMutex_;
+    std::array<std::unique_ptr<Staging>, kMaxThreads> staging_{};
+    std::atomic<std::size_t> stagingCount_{0};  // 写线程按此读取已发布的暂存区
+
+    std::atomic<bool> open_{false};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> records_{0};      // 以下三项只由写线程更新
+    std::atomic<std::uint64_t> bytes_{0};
+    std::atomic<std::uint64_t> overwritten_{0};
+
+    std::mutex writerMutex_;
+    std::condition_variable writerCv_;
+    std::condition_variable flushedCv_;
+    std::uint64_t flushRequests_{0};  // writerMutex_ 保护
+    std::uint64_t flushesDone_{0};
+    bool stopWriter_{false};
+    std::mutex drainMutex_;  // 写线程与 close() 的最终搬运互斥
+    std::thread writer_;
+};
+
+struct LogRecordView {
+    LogRecordType type{LogRecordType::Padding};
+    std::uint16_t thread{0};          // 记录线程的暂存区编号
+    std::int64_t timestampNs{0};
+    std::uint64_t fileOffset{0};      // 记录头在文件中的偏移
+    const std::uint8_t* data{nullptr};  // 指向 reader 的映射
+    std::uint32_t size{0};
+};
+
+// 只读 mmap 日志文件，按写入顺序（tail → head）解析仍在环中的记录
+class FlightLogReader {
+public:
+    ~FlightLogReader();
+    FlightLogReader(const FlightLogReader&) = delete;
+    FlightLogReader& operator=(const FlightLogReader&) = delete;
+
+    // 文件不存在或不是飞行日志时返回 nullptr
+    static std::unique_ptr<FlightLogReader> open(const std::string& path);
+
+    std::size_t size() const noexcept { return records_.size(); }
+    const LogRecordView& record(std::size_t index) const { return records_[index]; }
+    const std::vector<LogRecordView>& records() const noexcept { return records_; }
+    // 正常 close() 过（false 表示进程在记录中途退出，内容截至最后一次发布的 head）
+    bool clean() const noexcept { return clean_; }
+    // 写入期间被覆盖的旧记录数（由文件头记录）
+    std::uint64_t overwritten() const noexcept { return overwritten_; }
+    // 解析时遇到损坏的记录头而提前停止
+    bool truncated() const noexcept { return truncated_; }
+
+private:
+    FlightLogReader() = default;
+    bool load(const std::string& path);
+
+    std::uint8_t* base_{nullptr};
+    std::size_t length_{0};
+    bool clean_{false};
+    bool truncated_{false};
+    std::uint64_t overwritten_{0};
+    std::vector<LogRecordView> records_;
+};
+
+// 离线索引：按时间戳排序的 {时间戳, 文件偏移, 长度, 类型, 线程}，供分析工具按时间段 / 类型快速定位
+struct FlightLogIndexEntry {
+    std::int64_t timestampNs;
+    std::uint64_t fileOffset;
+    std::uint32_t size;
+    std::uint16_t type;
+    std::uint16_t thread;
+};
+static_assert(sizeof(FlightLogIndexEntry) == 24, "index entry layout is part of the file format");
+
+bool writeFlightLogIndex(const FlightLogReader& reader, const std::string& indexPath);
+bool readFlightLogIndex(const std::string& indexPath, std::vector<FlightLogIndexEntry>& entries);
+
+/**
+ * FlightLogNode - 把 Sink Pad "in" 收到的数据按指定类型写入飞行日志（如检测结果、管线事件）
+ * 记录在推送线程中同步完成（即 record() 热路径），recorder 由调用方共享持有。
+ */
+class FlightLogNode : public Node {
+public:
+    FlightLogNode(std::shared_ptr<FlightLogRecorder> recorder, LogRecordType type);
+
+    std::uint64_t logged() const noexcept { return logged_.load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<FlightLogRecorder> recorder_;
+    LogRecordType type_;
+    std::atomic<std::uint64_t> logged_{0};
+};
+
+} // namespace falconmind::sdk::core
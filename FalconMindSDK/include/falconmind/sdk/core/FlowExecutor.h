@@ -3,8 +3,14 @@
 
 #include "falconmind/sdk/core/Pipeline.h"
 #include "falconmind/sdk/core/NodeFactory.h"
+#include "falconmind/sdk/core/FlowPlan.h"
+#include "falconmind/sdk/core/MemoryBudget.h"
+#include "falconmind/sdk/core/NodeWatchdog.h"
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -37,6 +43,15 @@ public:
      */
     bool loadFlowFromFile(const std::string& file_path);
     
+    /**
+     * 选择 loadFlow / loadFlowFromFile 的解析方式（默认按需解析）
+     * 按需解析：文件经 mmap 读取，JsonCursor 只解码需要的字段（flow_id/name/version/latency_budget_ms/memory_budget_mb/priority、
+     * 节点 node_id/template_id/parameters、边的端点与 queue/backpressure），其余字段（Builder 布局等）
+     * 只做括号级跳过，parameters 对象单独解析为 DOM；false 时先构建整份 nlohmann::json DOM 再提取
+     */
+    void setOnDemandParsing(bool enabled) { on_demand_parsing_ = enabled; }
+    bool onDemandParsing() const noexcept { return on_demand_parsing_; }
+    
     /**
      * 从Builder API加载Flow定义
      * @param builder_url Builder服务URL（如 "http://localhost:8000"）
@@ -50,6 +65,34 @@ public:
                             const std::string& project_id,
                             const std::string& flow_id);
     
+    /**
+     * 设置执行计划缓存目录（空字符串关闭缓存）
+     * 开启后每次成功解析且完整的 Flow 定义都会编译为二进制计划写入该目录，键为 flow_id + version
+     */
+    void setPlanCacheDirectory(const std::string& directory);
+    
+    /**
+     * 从计划缓存加载 Flow（跳过 JSON 解析与参数校验，用于上电快速启动）
+     * @param flow_id Flow ID
+     * @param version Flow 版本（与定义中的 "version" 一致）
+     * @return 缓存未开启、无对应计划或计划无效时返回 false
+     */
+    bool loadFlowFromCache(const std::string& flow_id, const std::string& version);
+    
+    /**
+     * 获取当前编译后的执行计划（用于调试）
+     */
+    const FlowPlan& getPlan() const { return plan_; }
+    
+    /**
+     * 部署前校验 Flow 中各节点的 parameters（声明了 Schema 的模板按类型与范围检查，另含 placement 与
+     * search_path_planner 的校验），不创建节点
+     * @param flow_json Flow定义JSON字符串
+     * @param errors 每个不合法节点一条 "node_id: 原因"
+     * @return 全部合法时返回 true；JSON 无法解析或缺少 nodes 数组时返回 false
+     */
+    static bool validateFlowParameters(const std::string& flow_json, std::vector<std::string>& errors);
+    
     /**
      * 启动Flow执行
      * @return 是否启动成功
@@ -66,6 +109,15 @@ public:
      * @return 是否正在运行
      */
     bool isRunning() const;
+
+    /**
+     * 暂停/恢复Flow：暂停时调度器停止调用 process()，节点保持启动（相机不关流、模型不卸载），
+     * 恢复只需唤醒调度器。暂停期间的热更新修改拓扑后保持暂停，恢复时启动新增节点
+     * @return 是否成功（未运行时返回 false）
+     */
+    bool pause();
+    bool resume();
+    bool isPaused() const { return paused_; }
     
     /**
      * 获取Pipeline实例（用于监控和调试）
@@ -75,6 +127,9 @@ public:
     
     /**
      * 更新Flow（热更新）
+     * 运行中且 flow_id 不变时与当前定义做差异比较：仅重建模板变化/被删除的节点、就地重新配置参数变化的节点，
+     * 并只重连受影响的边，其余节点保持运行（相机不重开、模型不重载）。
+     * 未运行、flow_id 变化或差异应用失败时退回为完整重建。
      * @param flow_json 新的Flow定义JSON
      * @return 是否更新成功
      */
@@ -92,6 +147,59 @@ public:
      */
     const std::string& getFlowName() const { return flow_name_; }
 
+    /**
+     * Flow 级端到端时延预算（Flow 定义顶层可选字段 "latency_budget_ms"），
+     * 应用于全部 LatencySink 节点（检测、跟踪等）；0 表示不检查
+     */
+    std::int64_t getLatencyBudgetNs() const { return latency_budget_ns_; }
+
+    /**
+     * Flow 级缓冲内存预算（Flow 定义顶层可选字段 "memory_budget_mb"），0 表示不检查。
+     * start() 在节点 link 之前汇总 MemoryBudgetSink 节点的估算，超出时先减少在途帧、再降分辨率，
+     * 仍超出则启动失败；热更新新建的节点不参与重新分配
+     */
+    std::size_t getMemoryBudgetBytes() const { return memory_budget_bytes_; }
+    // 最近一次 start() 的预算分配结果（估算、降级步骤）
+    const MemoryBudgetReport& memoryBudgetReport() const { return memory_report_; }
+
+    /**
+     * 进程内数据出口（C API / 语言绑定）：每次 start() 创建 Pipeline 时以 Pipeline::addPadTap 挂接到
+     * nodeId.padName，handler 收到的 BufferRef 不拷贝。须在未运行时调用；热更新重建被挂接的节点后，
+     * 出口在下一次 start() 时恢复
+     * @return 未运行且该 Pad 尚未挂接时返回 true
+     */
+    bool addPadTap(const std::string& nodeId, const std::string& padName, Pad::BufferCallback handler,
+                   const LinkQueueConfig& queue = {});
+    bool removePadTap(const std::string& nodeId, const std::string& padName);
+
+    /**
+     * 节点看门狗（节点 parameters.watchdog）：运行期间存在启用了策略的节点时，start() / 热更新后创建 NodeWatchdog
+     * 监视这些节点，事件经 callback 在看门狗线程上报。callback 须在 start() 之前设置
+     */
+    void setWatchdogCallback(NodeWatchdog::EventCallback callback) { watchdog_callback_ = std::move(callback); }
+    // 当前的看门狗（未运行或没有受监视节点时为 nullptr）
+    NodeWatchdog* watchdog() const { return watchdog_.get(); }
+
+    /**
+     * Flow 优先级（Flow 定义顶层可选字段 "priority"，0~100，默认 50）：节点在 NPU/GPU 上推理时
+     * 向 AcceleratorArbiter 登记的权重，多个 Flow 共用加速器时按优先级分配时间片
+     */
+    int getPriority() const { return priority_; }
+
+    /**
+     * 进程内多 Flow 共享设备源（默认关闭）：开启后 start() / 热更新把实现 SharableSource 的节点替换为
+     * SharedSourceRegistry 中按设备去重的代理，同一设备只打开一次。须在 start() 之前设置
+     */
+    void setResourceSharing(bool enabled) { resource_sharing_ = enabled; }
+    bool resourceSharing() const { return resource_sharing_; }
+
+    /**
+     * 调度器配置：start() 创建 Pipeline 后应用，须在 start() 之前设置。
+     * manual 为 true 时 Flow 不创建调度线程，由 ReplayRunner 以虚拟时钟步进（无头回放仿真）
+     */
+    void setSchedulerConfig(const PipelineSchedulerConfig& config) { scheduler_config_ = config; }
+    const PipelineSchedulerConfig& schedulerConfig() const { return scheduler_config_; }
+
 private:
     /**
      * 解析Flow定义
@@ -101,8 +209,8 @@ private:
     bool parseFlowDefinition(const json& flow_json_obj);
     
     /**
-     * 创建所有节点
-     * @return 是否创建成功
+     * 创建所有节点（并行构造，失败时汇总列出全部失败节点）
+     * @return 是否全部创建成功
      */
     bool createNodes();
     
@@ -112,6 +220,30 @@ private:
      */
     bool connectNodes();
     
+    /**
+     * 由当前定义编译执行计划（解析 creator、预解析参数、边转为节点下标）
+     * @return 计划是否完整（模板均已注册且边两端节点均存在）
+     */
+    bool compilePlan();
+    
+    // parameters.placement → NodePlacement（cpus/priority/npu_core_mask），取值非法时返回 false
+    static bool parsePlacement(const json& placement_json, NodePlacement& out, std::string& error);
+    // parameters.watchdog → WatchdogPolicy（stall_ms/slo_ms/violations/ladder），取值非法时返回 false
+    static bool parseWatchdog(const json& watchdog_json, WatchdogPolicy& out, std::string& error);
+    
+    /**
+     * 校验并预解析节点参数到 out（out.paramsValid/paramsError 记录校验结果）
+     * @return 参数是否有效
+     */
+    static bool compileNodeParams(const std::string& template_id,
+                                  const json& params_json,
+                                  FlowPlanNode& out);
+    
+    // 将预解析参数应用到节点；失败原因写入 error（可并发调用）
+    static bool applyNodeParams(const std::shared_ptr<Node>& node, const FlowPlanNode& plan_node,
+                                std::string& error);
+    static bool applyNodeParams(const std::shared_ptr<Node>& node, const FlowPlanNode& plan_node);
+    
     /**
      * 配置节点参数
      * @param node Node实例
@@ -130,6 +262,20 @@ private:
     std::string flow_id_;
     std::string flow_name_;
     std::string flow_version_;
+    std::int64_t latency_budget_ns_{0};
+    std::size_t memory_budget_bytes_{0};
+    int priority_{50};
+    bool resource_sharing_{false};
+    PipelineSchedulerConfig scheduler_config_;
+    MemoryBudgetReport memory_report_;
+
+    struct PadTap {
+        std::string nodeId;
+        std::string padName;
+        Pad::BufferCallback handler;
+        LinkQueueConfig queue;
+    };
+    std::vector<PadTap> pad_taps_;
     json flow_definition_json_;  // JSON对象
     
     // 节点定义列表（从JSON解析）
@@ -137,6 +283,7 @@ private:
         std::string node_id;
         std::string template_id;
         json parameters_json;  // 使用json对象而不是字符串
+        std::string parameters_text;  // 按需解析时保留的 parameters 原文，编译计划时免去 dump()
     };
     std::vector<NodeDefinition> node_definitions_;
     
@@ -147,10 +294,56 @@ private:
         std::string from_port;
         std::string to_node_id;
         std::string to_port;
+        LinkQueueConfig queue;  // 可选 "queue": {"capacity":4,"policy":"drop_oldest|drop_newest|block","block_timeout_ms":100}
     };
     std::vector<EdgeDefinition> edge_definitions_;
+
+    // 按需解析 Flow 文本（不建立整份 DOM）；成功时替换当前定义并编译计划
+    bool parseFlowText(std::string_view text);
+    // 边的可选 queue / backpressure
+    static void parseEdgeOptions(const json& edge_json, EdgeDefinition& edge_def);
+    // 定义解析完成后：打印摘要、编译计划并写入缓存
+    void finishFlowDefinition();
+    bool on_demand_parsing_{true};
+
+    /**
+     * 将当前（已解析的新）定义相对 old_nodes/old_edges 的差异应用到运行中的 Pipeline
+     * @return 是否全部应用成功
+     */
+    bool applyFlowDiff(const std::vector<NodeDefinition>& old_nodes,
+                       const std::vector<EdgeDefinition>& old_edges);
+    // 按定义创建、配置节点并加入 nodes_（优先使用已编译计划中的同名节点）
+    bool createNode(const NodeDefinition& node_def);
+    // 按计划节点创建并应用参数，加入 nodes_
+    bool instantiateNode(const FlowPlanNode& plan_node);
+    // 创建并应用参数（不修改 nodes_，日志写入 log；可在工作线程并发调用）
+    static std::shared_ptr<Node> constructNode(const FlowPlanNode& plan_node, std::string& log);
+    const FlowPlanNode* findPlanNode(const std::string& node_id) const;
+    // 由 plan_ 还原 node_definitions_/edge_definitions_（从缓存加载后热更新时使用）
+    void restoreDefinitionsFromPlan();
+
+    static constexpr std::uint32_t kUnresolvedNode = std::numeric_limits<std::uint32_t>::max();
+    FlowPlan plan_;
+    std::unique_ptr<FlowPlanCache> plan_cache_;
+    // 将 latency_budget_ns_ 设置到 nodes_ 中的全部 LatencySink 节点
+    void applyLatencyBudget();
+    // 把搜索规划节点的 search_params.detection_classes 下发给 ClassOfInterestSink 节点
+    void applyDetectionClasses();
+    // 对 nodes_ 中的 MemoryBudgetSink 节点执行 fitMemoryBudget；超出预算返回 false
+    bool enforceMemoryBudget();
+    // 完整重建：停止并丢弃当前 Pipeline，按当前定义重新启动
+    bool rebuildFlow();
+    // 开启资源共享时返回可共享源节点的代理，否则原样返回（节点加入 Pipeline 之前调用）
+    std::shared_ptr<Node> shareSource(const std::shared_ptr<Node>& node) const;
+    // 为 nodes_ 中的 AcceleratorUser 按 flow_id_ / priority_ 登记加速器客户端（已一致的保持不变）
+    void bindAccelerators();
+    // 按 plan_ 中的看门狗策略重新创建并启动 watchdog_（无受监视节点时为空）
+    void armWatchdog();
+    NodeWatchdog::EventCallback watchdog_callback_;
+    std::unique_ptr<NodeWatchdog> watchdog_;
     
     bool running_;
+    bool paused_{false};
 };
 
 } // namespace falconmind::sdk::core
@@ -0,0 +1,87 @@
+// FalconMindSDK - 预编译 Flow 执行计划（校验后的紧凑表示，可按 flow_id + version 缓存到磁盘）
+#pragma once
+
+#include "falconmind/sdk/core/NodeFactory.h"
+#include "falconmind/sdk/core/NodeParams.h"
+#include "falconmind/sdk/core/NodePlacement.h"
+#include "falconmind/sdk/core/NodeWatchdog.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/mission/SearchTypes.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+// search_path_planner 预解析参数
+struct PlannerPlanParams {
+    bool hasArea{false};
+    mission::SearchArea area{};
+    bool hasParams{false};
+    mission::SearchParams params{};
+};
+
+struct FlowPlanNode {
+    std::string nodeId;
+    std::string templateId;
+    NodeFactory::NodeCreator creator;  // 编译/加载时解析（不序列化）
+    bool paramsValid{true};            // 参数校验结果；无效时节点照常创建但不应用参数
+    std::string paramsError;
+    PlannerPlanParams planner;
+    bool hasTypedParams{false};        // 模板声明了参数 Schema：typedParams 为校验后的取值，创建时经 Node::applyParams 应用
+    NodeParams typedParams;
+    NodePlacement placement;           // parameters.placement（所有模板通用）
+    WatchdogPolicy watchdog;           // parameters.watchdog（所有模板通用，未启用时不监视）
+    std::string parametersJson;        // 原始 parameters（序列化文本），热更新比较差异时使用
+};
+
+// 边：两端节点以 FlowPlan::nodes 下标表示
+struct FlowPlanEdge {
+    std::uint32_t from{0};
+    std::uint32_t to{0};
+    std::string edgeId;
+    std::string fromPort;
+    std::string toPort;
+    LinkQueueConfig queue;
+};
+
+struct FlowPlan {
+    std::string flowId;
+    std::string flowName;
+    std::string version;
+    std::int64_t latencyBudgetNs{0};  // Flow 级端到端时延预算（0 表示不检查）
+    std::uint64_t memoryBudgetBytes{0};  // Flow 级缓冲内存预算（0 表示不检查）
+    std::int32_t priority{50};           // Flow 优先级（0~100，多个 Flow 共用加速器时的份额）
+    std::vector<FlowPlanNode> nodes;
+    std::vector<FlowPlanEdge> edges;
+
+    // 按 templateId 解析 creator；存在未注册模板时返回 false
+    bool resolveCreators();
+
+    // 二进制序列化（含格式版本与校验和）；反序列化失败（格式不符/数据损坏）返回 false
+    std::string serialize() const;
+    static bool deserialize(const std::string& data, FlowPlan& out);
+};
+
+/**
+ * FlowPlanCache - 磁盘计划缓存，文件名由 flow_id 与 version 生成
+ * 同一 flow_id + version 视为内容相同：修改 Flow 定义时需同时更新 version。
+ */
+class FlowPlanCache {
+public:
+    explicit FlowPlanCache(std::string directory);
+
+    const std::string& directory() const noexcept { return directory_; }
+    std::string pathFor(const std::string& flowId, const std::string& version) const;
+
+    // 读取并解析 creator；文件不存在、损坏或模板未注册时返回 false
+    bool load(const std::string& flowId, const std::string& version, FlowPlan& out) const;
+    // 目录不存在时自动创建；先写临时文件再重命名，避免掉电留下半个文件
+    bool store(const FlowPlan& plan) const;
+
+private:
+    std::string directory_;
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,47 @@
+// FalconMindSDK - GateNode：按开关转发或截断数据流（零拷贝），用于按需启停下游的昂贵节点
+#pragma once
+
+#include "falconmind/sdk/core/BranchSwitch.h"
+#include "falconmind/sdk/core/Node.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace falconmind::sdk::core {
+
+/**
+ * GateNode - Sink Pad "in" 收到的缓冲在开启时原样经 Source Pad "out" 推送（共享 BufferRef，不拷贝），
+ * 关闭时直接丢弃，下游节点收不到数据即不再做推理 / 计算。
+ * 开关可在任意线程切换（如 EnvironmentDetectionNode 的模式回调）；也可设置条件函数（如读取任务黑板，
+ * 见 mission/BranchRouting.h），每个缓冲到达时求值，与 setOpen 的开关同时满足才放行。
+ * 由导通变为截断时通知 BranchSwitch 回调，下游分支释放缓冲。参数：open（默认 true）
+ */
+class GateNode : public Node, public BranchSwitch {
+public:
+    using Condition = std::function<bool()>;
+
+    explicit GateNode(bool open = true);
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+
+    void setOpen(bool open);
+    bool isOpen() const noexcept { return open_.load(std::memory_order_acquire); }
+    // 须在 Pipeline 进入 Playing 之前设置；条件函数在推送线程执行，应只做无锁读取
+    void setCondition(Condition condition) { condition_ = std::move(condition); }
+
+    std::uint64_t passed() const noexcept { return passed_.load(std::memory_order_relaxed); }
+    std::uint64_t blocked() const noexcept { return blocked_.load(std::memory_order_relaxed); }
+
+private:
+    Pad* outPad_{nullptr};
+    std::atomic<bool> open_;
+    std::atomic<bool> flowing_;  // 最近一次判定为导通（用于识别导通 → 截断的边沿）
+    Condition condition_;
+    std::atomic<std::uint64_t> passed_{0};
+    std::atomic<std::uint64_t> blocked_{0};
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,94 @@
+// FalconMindSDK - 现场诊断用的内嵌 HTTP 端点：运行中 Pipeline 的拓扑、节点 / 连接指标、trace 导出与内存占用
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+class Pipeline;
+
+struct IntrospectionServerConfig {
+    // 默认只监听本机；现场经机载网络访问时设为 0.0.0.0（端点无鉴权，只读，不应暴露到机外网络）
+    std::string bindAddress{"127.0.0.1"};
+    int port{8090};              // 0 为随机端口，见 IntrospectionServer::port()
+    int sampleIntervalMs{1000};  // 采样周期
+    // 采样与 HTTP 线程的 nice 值：19 为最低优先级，CPU 满载时仍能分到少量时间片（不用 SCHED_IDLE，
+    // 否则恰好在需要排查的满载场景下完全得不到调度）
+    int niceness{19};
+    bool allowTraceControl{true};  // 允许 POST /trace/start、/trace/stop
+};
+
+/**
+ * IntrospectionServer - 只读诊断端点（cpp-httplib，FALCONMINDSDK_WITH_HTTP 构建时可用）
+ *
+ * 采样线程按周期调用各 Pipeline::metrics()（热路径只有 relaxed 原子计数，采样不加锁于数据路径），
+ * 把 JSON / DOT 文本预先生成为不可变快照并原子替换；HTTP 线程只读取当前快照指针，请求处理
+ * 不访问 Pipeline。两类线程都以低优先级运行，HTTP 只用一个工作线程。
+ *
+ *   GET  /                         端点列表
+ *   GET  /pipelines                已登记的 Pipeline 与采样时间
+ *   GET  /pipelines/<id>/graph     拓扑（节点按拓扑序、连接及其帧率 / 丢帧），?format=dot 输出 Graphviz
+ *   GET  /pipelines/<id>/metrics   完整指标快照（同 toJson(PipelineMetrics)）
+ *   GET  /memory                   进程 RSS / 峰值与各 Pipeline 的内存预算与节点占用
+ *   GET  /trace                    Tracer 当前环形缓冲的 Chrome trace JSON（按请求生成）
+ *   POST /trace/start, /trace/stop 开关运行期追踪
+ *
+ * 注意 metrics() 的速率为相对上一次调用的区间平均：其它代码同时调用 metrics() 时两边看到的区间会变短。
+ */
+class IntrospectionServer {
+public:
+    explicit IntrospectionServer(IntrospectionServerConfig config = {});
+    ~IntrospectionServer();
+    IntrospectionServer(const IntrospectionServer&) = delete;
+    IntrospectionServer& operator=(const IntrospectionServer&) = delete;
+
+    // 是否编入了 HTTP 服务端（cpp-httplib）
+    static bool available() noexcept;
+
+    // 只保存弱引用：Pipeline 析构后自动从快照中消失；同 ID 重复登记时替换
+    void addPipeline(const std::shared_ptr<Pipeline>& pipeline);
+    void removePipeline(const std::string& pipelineId);
+
+    // 绑定端口并启动采样与 HTTP 线程；未编入 HTTP 或绑定失败返回 false
+    bool start();
+    void stop();
+    bool isRunning() const noexcept { return running_.load(); }
+    int port() const noexcept { return boundPort_.load(); }
+
+    // 立即采样一次（测试与首次请求前使用；通常由采样线程调用）
+    void sampleNow();
+    std::uint64_t samples() const noexcept { return samples_.load(std::memory_order_relaxed); }
+
+    struct Snapshot;
+
+private:
+    struct Http;
+
+    void removePipelineLocked(const std::string& pipelineId);
+    void sampleLoop();
+    std::shared_ptr<const Snapshot> snapshot() const;
+
+    IntrospectionServerConfig config_;
+    std::mutex pipelinesMutex_;
+    std::vector<std::weak_ptr<Pipeline>> pipelines_;
+    std::mutex sampleMutex_;  // 串行化 sampleNow()
+
+    std::shared_ptr<const Snapshot> snapshot_;  // 通过 std::atomic_load/atomic_store 访问
+    std::unique_ptr<Http> http_;
+    std::atomic<bool> running_{false};
+    std::atomic<int> boundPort_{0};
+    std::atomic<std::uint64_t> samples_{0};
+    std::thread sampleThread_;
+    std::thread httpThread_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+};
+
+} // namespace falconmind::sdk::core
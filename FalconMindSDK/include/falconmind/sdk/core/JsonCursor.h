@@ -0,0 +1,69 @@
+// FalconMindSDK - 按需（on-demand）JSON 读取：在连续文本上前向扫描，只解码调用方读取的字段
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+/**
+ * JsonCursor - 不建立 DOM 的前向 JSON 读取器
+ *
+ * 用于大 Flow 定义的加载：数据通常是 mmap 的文件，只解码需要的字段，其余值由 skipValue() 跳过
+ * （只检查括号配对、字符串与字面量，不做完整语法校验）；需要完整 DOM 的子对象可用 rawValue()
+ * 取出原文切片再交给 nlohmann::json 解析。
+ *
+ * 用法：beginObject() 后循环 nextField(key)，每个字段的值须恰好读取一次（readXxx / skipValue / rawValue）；
+ * 数组同理用 beginArray() + nextElement()。出错后所有调用返回 false，error() 给出原因与偏移
+ */
+class JsonCursor {
+public:
+    explicit JsonCursor(std::string_view text);
+
+    bool failed() const noexcept { return !error_.empty(); }
+    const std::string& error() const noexcept { return error_; }
+    std::size_t offset() const noexcept { return static_cast<std::size_t>(p_ - begin_); }
+
+    // 下一个值的首字符（已跳过空白）：'{' '[' '"' 't' 'f' 'n' 或数字；到达末尾或已出错返回 '\0'
+    char peek();
+
+    bool beginObject();
+    // 读取下一个字段名；对象结束（或出错）时返回 false
+    bool nextField(std::string& key);
+    bool beginArray();
+    // 定位到下一个元素；数组结束（或出错）时返回 false
+    bool nextElement();
+
+    bool readString(std::string& out);
+    bool readNumber(double& out);
+    bool readBool(bool& out);
+    bool skipValue();
+    // 跳过一个值并返回其原文
+    bool rawValue(std::string_view& out);
+
+    // 根值之后只允许空白
+    bool finish();
+
+private:
+    struct Scope {
+        char closer;
+        bool first;
+    };
+
+    bool fail(const char* what);
+    void skipWhitespace();
+    bool expect(char c);
+    bool skipString();
+    bool skipLiteral(const char* word, std::size_t length);
+    bool skipNumber();
+
+    const char* begin_;
+    const char* p_;
+    const char* end_;
+    std::vector<Scope> scopes_;
+    std::string error_;
+};
+
+} // namespace falconmind::sdk::core
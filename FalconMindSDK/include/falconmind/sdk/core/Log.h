@@ -0,0 +1,213 @@
+// FalconMindSDK - 异步日志：调用线程只把参数按值写入本线程的无锁环形缓冲，格式化与写出在后台线程
+#pragma once
+
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// 编译期最低级别（0=Debug 1=Info 2=Warn 3=Error 4=Fatal）：低于该级别的 FM_LOG_* 调用连同参数求值一起被编译掉
+#ifndef FALCONMIND_LOG_MIN_LEVEL
+#define FALCONMIND_LOG_MIN_LEVEL 0
+#endif
+
+namespace falconmind::sdk::core {
+
+enum class LogSeverity : std::uint8_t {
+    Debug = 0,
+    Info = 1,
+    Warn = 2,
+    Error = 3,
+    Fatal = 4,
+};
+
+struct LogStats {
+    std::uint64_t written{0};   // 已写出的记录
+    std::uint64_t dropped{0};   // 线程缓冲已满而丢弃的记录
+    std::uint64_t threads{0};   // 当前已注册的线程缓冲
+};
+
+namespace logdetail {
+
+// 一条日志记录（定长槽位）：参数按值构造在 args 中，format 负责格式化并析构它们
+struct Record {
+    static constexpr std::size_t kBytes = 256;
+    using FormatFn = void (*)(void* args, std::string& out);
+
+    std::int64_t timestampNs;  // system_clock
+    FormatFn format;
+    LogSeverity severity;
+    alignas(16) unsigned char args[kBytes - 32];
+};
+static_assert(sizeof(Record) == Record::kBytes, "log record must stay one fixed-size slot");
+
+// 字符数组（通常是字面量）按值复制，不依赖其生命周期
+template <std::size_t N>
+struct CapturedChars {
+    char data[N];
+};
+
+template <typename T>
+struct AlwaysFalse : std::false_type {};
+
+// 参数的捕获形式：字符串复制，数值 / 枚举按值；不支持的类型在编译期报错
+template <typename T>
+auto capture(T&& value) {
+    using D = std::remove_cv_t<std::remove_reference_t<T>>;
+    if constexpr (std::is_array_v<D>) {
+        static_assert(std::is_same_v<std::remove_cv_t<std::remove_extent_t<D>>, char>,
+                      "only char arrays can be logged");
+        CapturedChars<std::extent_v<D>> chars;
+        std::memcpy(chars.data, value, sizeof(chars.data));
+        return chars;
+    } else if constexpr (std::is_same_v<std::decay_t<T>, const char*> || std::is_same_v<std::decay_t<T>, char*>) {
+        return std::string(value ? value : "(null)");
+    } else if constexpr (std::is_convertible_v<T, std::string_view>) {
+        return std::string(std::forward<T>(value));
+    } else if constexpr (std::is_enum_v<D>) {
+        return static_cast<std::underlying_type_t<D>>(value);
+    } else if constexpr (std::is_arithmetic_v<D>) {
+        return static_cast<D>(value);
+    } else {
+        static_assert(AlwaysFalse<T>::value, "unsupported log argument type");
+    }
+}
+
+void appendFloat(std::string& out, double value);
+
+inline void append(std::string& out, const std::string& value) {
+    out += value;
+}
+
+template <std::size_t N>
+void append(std::string& out, const CapturedChars<N>& value) {
+    out.append(value.data, ::strnlen(value.data, N));
+}
+
+template <typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+void append(std::string& out, T value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        out += value ? "true" : "false";
+    } else if constexpr (std::is_same_v<T, char>) {
+        out.push_back(value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        appendFloat(out, static_cast<double>(value));
+    } else {
+        char buf[24];
+        const auto res = std::to_chars(buf, buf + sizeof(buf), value);
+        out.append(buf, res.ptr);
+    }
+}
+
+// 输出 "[component] " 后依次追加各参数，随后析构捕获的参数
+template <typename Tuple>
+void formatRecord(void* args, std::string& out) {
+    Tuple& captured = *std::launder(static_cast<Tuple*>(args));
+    std::apply(
+        [&out](const auto& component, const auto&... rest) {
+            out += '[';
+            append(out, component);
+            out += "] ";
+            (append(out, rest), ...);
+        },
+        captured);
+    captured.~Tuple();
+}
+
+} // namespace logdetail
+
+/**
+ * AsyncLogger - 进程级异步日志
+ *
+ * write() 在调用线程中只取时间戳、把参数按值构造进本线程的 SPSC 环形缓冲（首次调用时注册，之后无锁），
+ * 不做任何格式化；后台写线程轮询各线程缓冲，按时间戳合并后格式化为
+ * "[YYYY-mm-dd HH:MM:SS.mmm] [LEVEL] [component] message"，Error 及以上写 stderr、其余写 stdout，
+ * 每批只 flush 一次。缓冲已满时丢弃并计数（写线程随后输出一条丢弃汇总），调用线程永不阻塞。
+ * Error 及以上会尽快唤醒写线程，Fatal 在返回前等待写出。
+ * 进程退出（atexit）或 shutdown() 后转为在调用线程同步写出。
+ */
+class AsyncLogger {
+public:
+    using Sink = std::function<void(LogSeverity severity, std::string_view line)>;
+
+    static AsyncLogger& instance();
+
+    void setLevel(LogSeverity level) noexcept { level_.store(static_cast<std::uint8_t>(level), std::memory_order_relaxed); }
+    LogSeverity level() const noexcept { return static_cast<LogSeverity>(level_.load(std::memory_order_relaxed)); }
+    bool enabled(LogSeverity severity) const noexcept {
+        return static_cast<std::uint8_t>(severity) >= level_.load(std::memory_order_relaxed);
+    }
+
+    // 替换输出目标（在写线程中按行调用，line 不含换行）；传空恢复 stdout / stderr
+    void setSink(Sink sink);
+
+    // 阻塞直到本调用之前入队的记录都已写出
+    void flush();
+    // 写出剩余记录并停止写线程，之后的日志同步写出
+    void shutdown();
+
+    LogStats stats() const;
+
+    template <typename Component, typename... Args>
+    void write(LogSeverity severity, Component&& component, Args&&... args) {
+        using Tuple = std::tuple<decltype(logdetail::capture(std::declval<Component>())),
+                                 decltype(logdetail::capture(std::declval<Args>()))...>;
+        if constexpr (sizeof(Tuple) <= sizeof(logdetail::Record::args) && alignof(Tuple) <= 16) {
+            logdetail::Record* record = acquire();
+            if (!record) {
+                return;  // 本线程缓冲已满
+            }
+            new (record->args) Tuple(logdetail::capture(std::forward<Component>(component)),
+                                     logdetail::capture(std::forward<Args>(args))...);
+            record->format = &logdetail::formatRecord<Tuple>;
+            record->severity = severity;
+            commit(record);
+        } else {
+            // 参数放不进一个槽位：当场拼成字符串再入队
+            std::string name;
+            logdetail::append(name, logdetail::capture(std::forward<Component>(component)));
+            std::string message;
+            (logdetail::append(message, logdetail::capture(std::forward<Args>(args))), ...);
+            write(severity, std::move(name), std::move(message));
+        }
+    }
+
+private:
+    struct ThreadBuffer;
+    struct State;
+
+    AsyncLogger();
+    ~AsyncLogger() = delete;  // 有意泄漏：静态析构期间的日志仍然可用
+
+    logdetail::Record* acquire() noexcept;
+    void commit(logdetail::Record* record);
+    void run();
+
+    std::atomic<std::uint8_t> level_{static_cast<std::uint8_t>(LogSeverity::Info)};
+    std::unique_ptr<State> state_;
+};
+
+} // namespace falconmind::sdk::core
+
+#define FM_LOG(severity, component, ...)                                                         \
+    do {                                                                                         \
+        if constexpr (static_cast<int>(severity) >= FALCONMIND_LOG_MIN_LEVEL) {                  \
+            auto& fmLogger_ = ::falconmind::sdk::core::AsyncLogger::instance();                  \
+            if (fmLogger_.enabled(severity)) fmLogger_.write(severity, component, __VA_ARGS__); \
+        }                                                                                        \
+    } while (0)
+
+#define FM_LOG_DEBUG(component, ...) FM_LOG(::falconmind::sdk::core::LogSeverity::Debug, component, __VA_ARGS__)
+#define FM_LOG_INFO(component, ...) FM_LOG(::falconmind::sdk::core::LogSeverity::Info, component, __VA_ARGS__)
+#define FM_LOG_WARN(component, ...) FM_LOG(::falconmind::sdk::core::LogSeverity::Warn, component, __VA_ARGS__)
+#define FM_LOG_ERROR(component, ...) FM_LOG(::falconmind::sdk::core::LogSeverity::Error, component, __VA_ARGS__)
+#define FM_LOG_FATAL(component, ...) FM_LOG(::falconmind::sdk::core::LogSeverity::Fatal, component, __VA_ARGS__)
@@ -0,0 +1,75 @@
+// FalconMindSDK - 内存记账：按节点标记的缓冲占用、Flow 级内存预算与超预算降级
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+/**
+ * MemoryAccount - 一个节点持有的缓冲内存计数（字节）
+ * charge()/release() 只做 relaxed 原子操作，可在分配路径调用。缓冲可能晚于节点释放（下游仍持有引用），
+ * 记账方（BufferPool 等）以 shared_ptr 共享本对象
+ */
+class MemoryAccount {
+public:
+    void charge(std::size_t bytes) noexcept;
+    void release(std::size_t bytes) noexcept;
+    std::size_t bytes() const noexcept;
+    std::size_t peakBytes() const noexcept;
+
+private:
+    std::atomic<std::int64_t> bytes_{0};
+    std::atomic<std::int64_t> peak_{0};
+};
+
+// 超出预算时的降级步骤，按声明顺序尝试：先减少在途帧，仍超出再降分辨率
+enum class MemoryDegradation : std::uint8_t {
+    FewerInFlight,    // 缓冲池上限、V4L2 缓冲数减半
+    LowerResolution,  // 输出宽高减半
+};
+
+const char* memoryDegradationName(MemoryDegradation step) noexcept;
+
+/**
+ * MemoryBudgetSink - 持有大块帧缓冲的节点（相机源、图像变换等）实现此接口
+ * 节点把自己的缓冲池挂到 memoryAccount()，Pipeline::metrics() 汇总实际占用；FlowExecutor::start
+ * 在节点启动前按 estimateMemoryBytes() 检查 Flow 的 memory_budget_mb，超出时请求 degradeMemory()
+ */
+class MemoryBudgetSink {
+public:
+    virtual ~MemoryBudgetSink() = default;
+
+    const std::shared_ptr<MemoryAccount>& memoryAccount() const noexcept { return memoryAccount_; }
+
+    // 按当前配置估算的缓冲占用上限（字节）；start() 之前调用，未知的尺寸按节点默认值估算
+    virtual std::size_t estimateMemoryBytes() const = 0;
+    // 执行一步降级（须在 start() 之前）；已到下限或不支持该步骤时返回 false
+    virtual bool degradeMemory(MemoryDegradation step) = 0;
+
+protected:
+    std::shared_ptr<MemoryAccount> memoryAccount_{std::make_shared<MemoryAccount>()};
+};
+
+struct MemoryBudgetReport {
+    std::size_t budgetBytes{0};
+    std::size_t requestedBytes{0};  // 降级前估算
+    std::size_t plannedBytes{0};    // 降级后估算
+    std::vector<std::string> degradations;  // 每步一条 "node_id: fewer_in_flight"
+    bool withinBudget{true};
+};
+
+/**
+ * 在预算内安排各节点的缓冲：估算总和超出 budgetBytes 时，按 MemoryDegradation 顺序逐步降级，
+ * 每一轮从估算最大的节点开始，直到总和不超出预算或所有节点都无法再降。budgetBytes 为 0 时只估算
+ * @param sinks (node_id, 节点) 列表
+ */
+MemoryBudgetReport fitMemoryBudget(std::size_t budgetBytes,
+                                   const std::vector<std::pair<std::string, MemoryBudgetSink*>>& sinks);
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,182 @@
+// FalconMindSDK - 机载指标聚合：计数器 / 仪表 / 分位数摘要按窗口汇总，上报紧凑的汇总而非原始样本
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+/**
+ * QuantileSketch - DDSketch（相对误差分位数草图）
+ * 正值 v 落入桶 i = ceil(log_γ v)，γ = (1+α)/(1-α)；桶代表值 2γ^i/(γ+1) 与桶内任意值的相对误差不超过 α。
+ * 桶存放为从 minIndex 起的连续计数数组，超过 maxBins 时并入最低的桶（只损失低分位的精度）。
+ * ≤ 0 的值计入零桶，分位数落在零桶时返回 0。α 相同的草图可无损合并：
+ * 机群侧把各 UAV 的桶相加即得全机群分位数。非线程安全。
+ */
+class QuantileSketch {
+public:
+    explicit QuantileSketch(double relativeAccuracy = 0.01, std::size_t maxBins = 2048);
+
+    void add(double value) noexcept;
+    // α 不同返回 false
+    bool merge(const QuantileSketch& other);
+    // q ∈ [0, 1]；结果夹在 [min, max] 内，无样本返回 0
+    double quantile(double q) const noexcept;
+    // 清空样本，保留已分配的桶数组
+    void clear() noexcept;
+
+    bool empty() const noexcept { return count_ == 0; }
+    std::uint64_t count() const noexcept { return count_; }
+    double sum() const noexcept { return sum_; }
+    double min() const noexcept { return count_ ? min_ : 0.0; }
+    double max() const noexcept { return count_ ? max_ : 0.0; }
+
+    double relativeAccuracy() const noexcept { return relativeAccuracy_; }
+    std::uint64_t zeroCount() const noexcept { return zeroCount_; }
+    std::int32_t minIndex() const noexcept { return minIndex_; }
+    const std::vector<std::uint64_t>& bins() const noexcept { return bins_; }
+
+private:
+    std::size_t slotFor(std::int32_t index);
+    double binValue(std::int32_t index) const noexcept;
+
+    double relativeAccuracy_;
+    double gamma_;
+    double logGamma_;
+    std::size_t maxBins_;
+    std::int32_t minIndex_{0};
+    std::vector<std::uint64_t> bins_;
+    std::uint64_t zeroCount_{0};
+    std::uint64_t count_{0};
+    double sum_{0.0};
+    double min_{0.0};
+    double max_{0.0};
+};
+
+// 一个窗口的汇总；值的单位由指标名约定（如 detect.infer_us）
+struct MetricsRollup {
+    std::int64_t windowStartNs{0};  // Unix epoch nanoseconds
+    std::int64_t windowEndNs{0};
+    std::vector<double> quantiles;  // 各摘要 values 对应的分位点
+
+    struct CounterValue {
+        std::string name;
+        std::uint64_t delta{0};  // 本窗口增量
+    };
+    struct GaugeValue {
+        std::string name;
+        double last{0.0};
+        double min{0.0};  // 本窗口内设置过的最小 / 最大值（窗口内未设置时等于 last）
+        double max{0.0};
+    };
+    struct SummaryValue {
+        std::string name;
+        std::uint64_t count{0};
+        double sum{0.0};
+        double min{0.0};
+        double max{0.0};
+        std::vector<double> values;  // 与 quantiles 一一对应
+        // 草图桶（MetricsRollupOptions::includeSketches 时填写）
+        std::uint64_t sketchZeroCount{0};
+        std::int32_t sketchMinIndex{0};
+        std::vector<std::uint64_t> sketchBins;
+    };
+
+    std::vector<CounterValue> counters;
+    std::vector<GaugeValue> gauges;
+    std::vector<SummaryValue> summaries;
+    double relativeAccuracy{0.0};  // 草图 α（includeSketches 时有效）
+
+    bool empty() const noexcept { return counters.empty() && gauges.empty() && summaries.empty(); }
+};
+
+struct MetricsRollupOptions {
+    std::vector<double> quantiles{0.5, 0.9, 0.99};
+    // 附带草图桶，机群侧可合并出全机群分位数；每个摘要多几十到一两百字节
+    bool includeSketches{false};
+    // 本窗口无增量的计数器、未设置的仪表、无样本的摘要不写入汇总
+    bool skipIdle{true};
+};
+
+/**
+ * MetricsAggregator - 机载指标注册表
+ *
+ * counter / gauge / summary 按名字创建并返回引用（与聚合器同生命周期，可在热路径缓存）：
+ *   - Counter::add 为一次 relaxed 原子累加
+ *   - Gauge::set / Summary::record 各自持有一把小锁（不同指标之间不竞争），不分配内存（摘要的桶数组扩展除外）
+ * rollup() 结束当前窗口：汇总计数器增量、仪表的最新 / 最小 / 最大值与摘要分位数，并清空窗口。
+ * 汇总由 telemetry::MetricsRollupPublisher 按固定窗口经 TelemetryPublisher 发布。
+ */
+class MetricsAggregator {
+public:
+    class Counter {
+    public:
+        void add(std::uint64_t n = 1) noexcept { total_.fetch_add(n, std::memory_order_relaxed); }
+        std::uint64_t total() const noexcept { return total_.load(std::memory_order_relaxed); }
+
+    private:
+        friend class MetricsAggregator;
+        std::atomic<std::uint64_t> total_{0};
+        std::uint64_t reported_{0};  // 上一窗口结束时的累计值（聚合器锁保护）
+    };
+
+    class Gauge {
+    public:
+        void set(double value) noexcept;
+        double value() const noexcept;
+
+    private:
+        friend class MetricsAggregator;
+        mutable std::mutex mutex_;
+        bool everSet_{false};
+        bool setInWindow_{false};
+        double last_{0.0};
+        double min_{0.0};
+        double max_{0.0};
+    };
+
+    class Summary {
+    public:
+        Summary(double relativeAccuracy, std::size_t maxBins) : sketch_(relativeAccuracy, maxBins) {}
+        void record(double value) noexcept;
+
+    private:
+        friend class MetricsAggregator;
+        std::mutex mutex_;
+        QuantileSketch sketch_;
+    };
+
+    explicit MetricsAggregator(double relativeAccuracy = 0.01, std::size_t maxBins = 2048);
+
+    Counter& counter(const std::string& name);
+    Gauge& gauge(const std::string& name);
+    Summary& summary(const std::string& name);
+
+    // 结束当前窗口（[上次 rollup 或构造时刻, nowNs)）并开始下一个；指标按名字排序
+    MetricsRollup rollup(std::int64_t nowNs, const MetricsRollupOptions& options = {});
+
+    // 进程内共享实例（α = 1%）
+    static MetricsAggregator& instance();
+
+private:
+    double relativeAccuracy_;
+    std::size_t maxBins_;
+    std::mutex mutex_;  // 注册表与窗口边界
+    std::int64_t windowStartNs_;
+    std::map<std::string, std::unique_ptr<Counter>> counters_;
+    std::map<std::string, std::unique_ptr<Gauge>> gauges_;
+    std::map<std::string, std::unique_ptr<Summary>> summaries_;
+};
+
+// 紧凑 JSON（上行 "metrics_rollup" 消息）：数值保留 4 位有效数字，
+//   {"type":"metrics_rollup","uavId","t0","t1","q":[...],"c":{名:增量},"g":{名:[last,min,max]},
+//    "s":{名:[count,sum,min,max,分位值...]}[,"a":α,"k":{名:[零桶,minIndex,桶...]}]}
+std::string toJson(const MetricsRollup& rollup, const std::string& uavId);
+
+} // namespace falconmind::sdk::core
@@ -1,6 +1,10 @@
 // FalconMindSDK - Node base interface (week1 skeleton)
 #pragma once
 
+#include "falconmind/sdk/core/NodePlacement.h"
+
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -8,6 +12,7 @@
 
 namespace falconmind::sdk::core {
 
+class NodeParams;
 class Pad;
 
 class Node {
@@ -19,22 +24,46 @@ public:
     void setId(const std::string& newId) { id_ = newId; }
 
     virtual bool configure(const std::unordered_map<std::string, std::string>& params);
+    // 按模板参数 Schema（NodeParamRegistry）校验后的类型化参数，由 FlowExecutor 在创建节点时调用；
+    // 默认实现把显式给出的字段转为字符串交给 configure()，声明了 Schema 的节点应重写以直接读取类型化取值
+    virtual bool applyParams(const NodeParams& params);
 
     virtual bool start();
     virtual void stop();
 
+    // Pipeline 进入/离开 Paused 时调用（调度器已停止调用 process()）：只应暂停数据产生，
+    // 不释放模型、设备等资源，以便快速恢复；例如相机在 resume() 时丢弃暂停期间积压的旧帧
+    virtual void pause();
+    virtual void resume();
+
     // 简化：先只提供一个“无类型”处理入口，后续再按 Caps/Buffer 抽象细化
     virtual void process();
 
+    // 执行位置提示（Flow JSON parameters.placement），需在 Pipeline 进入 Playing 前设置
+    void setPlacement(const NodePlacement& placement) { placement_ = placement; }
+    const NodePlacement& placement() const noexcept { return placement_; }
+
+    // 按名称查找（需哈希字符串）：用于建立连接等低频路径；process() 等逐帧路径应使用 addPad 返回的 Pad* 或 pad(index)
     std::shared_ptr<Pad> getPad(const std::string& name);
     const std::unordered_map<std::string, std::shared_ptr<Pad>>& pads() const noexcept { return pads_; }
 
+    // Pad 下标按 addPad 顺序分配，节点生命周期内不变
+    using PadIndex = std::uint32_t;
+    static constexpr PadIndex kInvalidPadIndex = std::numeric_limits<PadIndex>::max();
+    PadIndex padIndex(const std::string& name) const;
+    Pad* pad(PadIndex index) const noexcept { return index < padList_.size() ? padList_[index].get() : nullptr; }
+    std::size_t padCount() const noexcept { return padList_.size(); }
+
 protected:
-    void addPad(const std::shared_ptr<Pad>& pad);
+    // 返回的指针在节点生命周期内有效，子类可缓存以避免逐帧按名称查找；重名 Pad 被忽略并返回已有 Pad
+    Pad* addPad(const std::shared_ptr<Pad>& pad);
 
 private:
     std::string id_;
+    NodePlacement placement_;
     std::unordered_map<std::string, std::shared_ptr<Pad>> pads_;
+    std::vector<std::shared_ptr<Pad>> padList_;
+    std::unordered_map<std::string, PadIndex> padIndices_;
 };
 
 } // namespace falconmind::sdk::core
@@ -6,14 +6,20 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <mutex>
 #include <atomic>
+#include <type_traits>
 
 namespace falconmind::sdk::core {
 
 /**
  * NodeFactory - 用于动态创建Node实例
  * 支持通过模板ID（template_id）动态创建对应的Node
+ *
+ * 线程安全：注册表为不可变快照，注册（低频）在写锁下复制并发布新快照；
+ * createNode/findCreator 等读路径只做一次原子读取，不加锁，可与插件注册并发。
+ * 节点类型可在静态初始化阶段用 FALCONMIND_REGISTER_NODE 自注册（早于 initializeDefaultTypes 也安全）。
  */
 class NodeFactory {
 public:
@@ -21,7 +27,7 @@ public:
     using NodeCreator = std::function<std::shared_ptr<Node>(const std::string& node_id, const void* params)>;
     
     /**
-     * 注册Node类型
+     * 注册Node类型（同名类型被替换）
      * @param template_id 模板ID（如 "search_path_planner"）
      * @param creator 创建函数
      */
@@ -38,6 +44,13 @@ public:
                                            const std::string& node_id,
                                            const void* params = nullptr);
     
+    /**
+     * 查找模板对应的创建函数（供 FlowPlan 预先解析，避免每次创建都按字符串查表）
+     * @param template_id 模板ID
+     * @return 创建函数；未注册时为空
+     */
+    static NodeCreator findCreator(const std::string& template_id);
+    
     /**
      * 检查Node类型是否已注册
      * @param template_id 模板ID
@@ -52,17 +65,53 @@ public:
     static std::vector<std::string> getRegisteredTypes();
     
     /**
-     * 初始化默认Node类型（在SDK初始化时调用）
-     * 阶段4优化：使用call_once确保线程安全，只初始化一次
+     * 初始化默认Node类型（在SDK初始化时调用；读接口首次使用时也会自动调用）
+     * 只初始化一次；已由插件/自注册占用的模板ID不被默认类型覆盖
      */
     static void initializeDefaultTypes();
     
 private:
-    static std::unordered_map<std::string, NodeCreator> creators_;
-    
-    // 阶段4优化：线程安全的初始化控制
+    using Registry = std::unordered_map<std::string, NodeCreator>;
+
+    static void ensureInitialized();
+    // 当前快照（尚无注册时为 nullptr）；读端无锁
+    static const Registry* snapshot() noexcept;
+    // 在写锁下基于当前快照构造新快照并发布；overwrite 为 false 时不替换已有模板
+    static void publish(const Registry& additions, bool overwrite);
+
+    // 常量初始化：其它编译单元的静态自注册可以先于本文件的动态初始化执行
+    static std::atomic<const Registry*> registry_;
+    static std::mutex write_mutex_;
     static std::mutex init_mutex_;
     static std::atomic<bool> initialized_;
 };
 
+/**
+ * NodeRegistrar - 静态初始化时注册无参构造的节点类型（通常通过 FALCONMIND_REGISTER_NODE 使用）
+ * 创建的节点 ID 由 setId(node_id) 设置
+ */
+template <typename NodeT>
+class NodeRegistrar {
+public:
+    explicit NodeRegistrar(const char* template_id) {
+        static_assert(std::is_base_of<Node, NodeT>::value, "NodeRegistrar requires a Node subclass");
+        NodeFactory::registerNodeType(template_id,
+            [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+                auto node = std::make_shared<NodeT>();
+                node->setId(node_id);
+                return node;
+            });
+    }
+};
+
 } // namespace falconmind::sdk::core
+
+#define FALCONMIND_NODE_REGISTRAR_CONCAT_(a, b) a##b
+#define FALCONMIND_NODE_REGISTRAR_NAME_(line) FALCONMIND_NODE_REGISTRAR_CONCAT_(falconmind_node_registrar_, line)
+
+/**
+ * 在命名空间作用域自注册节点类型，例如 FALCONMIND_REGISTER_NODE("my_filter", MyFilterNode);
+ * 注意：静态库中未被引用的目标文件可能被链接器丢弃，插件应以共享库或 --whole-archive 方式链接
+ */
+#define FALCONMIND_REGISTER_NODE(template_id, NodeClass) \
+    static const ::falconmind::sdk::core::NodeRegistrar<NodeClass> FALCONMIND_NODE_REGISTRAR_NAME_(__LINE__){template_id}
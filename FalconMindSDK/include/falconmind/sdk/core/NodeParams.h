@@ -0,0 +1,144 @@
+// FalconMindSDK - 节点参数 Schema（类型 / 范围 / 默认值），Flow 加载时一次校验并转为类型化参数
+#pragma once
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+enum class ParamType : std::uint8_t {
+    Bool = 0,
+    Int,
+    Double,
+    String
+};
+
+// 取值下标与 ParamType 一致
+using ParamValue = std::variant<bool, std::int64_t, double, std::string>;
+
+const char* paramTypeName(ParamType type) noexcept;
+
+struct ParamSpec {
+    std::string name;
+    ParamType type{ParamType::String};
+    ParamValue defaultValue{std::string{}};
+    bool hasRange{false};               // Int / Double 的闭区间 [min, max]
+    double min{0.0};
+    double max{0.0};
+    std::vector<std::string> choices;   // String 的允许取值（为空不限制）
+    std::string description;
+};
+
+/**
+ * NodeParams - 按 Schema 校验后的参数
+ *
+ * 包含 Schema 中的全部字段：Flow 未给出的取默认值，has() 区分是否显式给出。
+ * 取值已是声明的类型，节点直接读取，不再解析字符串
+ */
+class NodeParams {
+public:
+    struct Entry {
+        std::string name;
+        ParamValue value;
+        bool explicitlySet{false};
+    };
+
+    bool empty() const noexcept { return entries_.empty(); }
+    const std::vector<Entry>& entries() const noexcept { return entries_; }
+
+    // 是否在参数中显式给出
+    bool has(const std::string& name) const;
+    // 字段不存在或类型不符时返回 fallback
+    bool getBool(const std::string& name, bool fallback = false) const;
+    std::int64_t getInt(const std::string& name, std::int64_t fallback = 0) const;
+    double getDouble(const std::string& name, double fallback = 0.0) const;
+    std::string getString(const std::string& name, const std::string& fallback = {}) const;
+
+    // 显式给出时写入 field（按 field 的类型转换），返回是否写入；未给出的字段保持节点原有配置
+    template <typename T>
+    bool assign(const std::string& name, T& field) const {
+        const Entry* e = find(name);
+        if (!e || !e->explicitlySet) return false;
+        if constexpr (std::is_same_v<T, std::string>) {
+            if (const auto* s = std::get_if<std::string>(&e->value)) field = *s;
+            else return false;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            if (const auto* b = std::get_if<bool>(&e->value)) field = *b;
+            else return false;
+        } else {
+            static_assert(std::is_arithmetic_v<T>, "NodeParams::assign requires bool, arithmetic or std::string");
+            if (const auto* i = std::get_if<std::int64_t>(&e->value)) field = static_cast<T>(*i);
+            else if (const auto* d = std::get_if<double>(&e->value)) field = static_cast<T>(*d);
+            else return false;
+        }
+        return true;
+    }
+
+    void set(const std::string& name, ParamValue value, bool explicitlySet);
+    // 显式给出的字段转为字符串参数（供只实现 configure(map) 的节点）
+    std::unordered_map<std::string, std::string> toStringMap() const;
+
+private:
+    const Entry* find(const std::string& name) const;
+
+    std::vector<Entry> entries_;
+};
+
+/**
+ * ParamSchema - 一个节点模板的参数声明
+ *
+ * 链式声明字段：schema.integer("width", 0, 0, 16384).number("fps", 0.0, 0.0, 1000.0)...
+ * parse() 校验类型与范围并填入默认值；Schema 之外的键（placement 等通用字段）忽略。
+ * JSON 中数值可写为数字或数字字符串，布尔可写为 true/false、"true"/"false"、"1"/"0"
+ */
+class ParamSchema {
+public:
+    ParamSchema& boolean(const std::string& name, bool defaultValue, const std::string& description = {});
+    ParamSchema& integer(const std::string& name, std::int64_t defaultValue, std::int64_t min, std::int64_t max,
+                         const std::string& description = {});
+    ParamSchema& number(const std::string& name, double defaultValue, double min, double max,
+                        const std::string& description = {});
+    ParamSchema& string(const std::string& name, const std::string& defaultValue,
+                        std::vector<std::string> choices = {}, const std::string& description = {});
+
+    const std::vector<ParamSpec>& specs() const noexcept { return specs_; }
+    const ParamSpec* find(const std::string& name) const;
+
+    // Flow JSON 的 parameters 对象；失败时 error 为首个不合法字段的说明
+    bool parse(const nlohmann::json& params, NodeParams& out, std::string& error) const;
+    // Node::configure 的字符串参数
+    bool parse(const std::unordered_map<std::string, std::string>& params, NodeParams& out,
+               std::string& error) const;
+
+    // 供 Builder 部署前校验 / 生成表单：[{"name","type","default","min","max","choices","description"}]
+    std::string toJson() const;
+
+private:
+    NodeParams defaults() const;
+
+    std::vector<ParamSpec> specs_;
+};
+
+/**
+ * NodeParamRegistry - 模板 ID → 参数 Schema
+ *
+ * 默认节点类型的 Schema 在 NodeFactory::initializeDefaultTypes 中注册；插件可自行注册。
+ * 注册与查找为低频操作（Flow 编译时），加锁即可
+ */
+class NodeParamRegistry {
+public:
+    static void registerSchema(const std::string& templateId, std::shared_ptr<const ParamSchema> schema);
+    // 未注册时返回空
+    static std::shared_ptr<const ParamSchema> find(const std::string& templateId);
+    static std::vector<std::string> templates();
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,58 @@
+// FalconMindSDK - 节点放置提示（CPU 亲和性、实时优先级、NPU 核掩码、调度类别与截止时间）
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+/**
+ * NodePlacement - 节点执行位置提示（Flow JSON 节点 parameters.placement）
+ *
+ *   "placement": { "cpus": [4, 5], "priority": 50, "npu_core_mask": 3 }
+ *   "placement": { "class": "critical", "deadline_ms": 20, "period_ms": 33.3 }
+ *
+ * - cpus：执行该节点 process() 的线程绑定到这些 CPU（如 RK3588 大核 4-7 / 小核 0-3）
+ * - priority：1-99 时该线程使用 SCHED_FIFO 及该优先级（需 CAP_SYS_NICE），0 为普通调度
+ * - npuCoreMask：NPU 核位掩码（bit0 = core0 ...，0 为由驱动自动选择），由检测节点传给后端
+ * - schedClass：critical 的下游节点由调度器的预留实时线程按最早截止时间优先（EDF）执行，
+ *   不与 best_effort 节点（编码、日志等）争用共享线程池；critical Source 线程未设 priority 时也提升为 SCHED_FIFO
+ * - deadline：数据到达（Source 为周期起点）到 process() 完成的相对截止时间，超出计入 NodeMetrics::deadlineMisses；
+ *   未设置时取 period
+ * - period：Source 节点的调度周期（覆盖 PipelineSchedulerConfig::sourcePeriod，setNodePeriod 优先）
+ * 设置了 cpus 或 priority 的非 Source 节点由调度器分配专用线程，不在共享线程池中迁移
+ */
+enum class SchedClass : std::uint8_t {
+    BestEffort = 0,
+    Critical,
+};
+
+struct NodePlacement {
+    std::vector<int> cpus;
+    int priority{0};
+    std::uint32_t npuCoreMask{0};
+    SchedClass schedClass{SchedClass::BestEffort};
+    std::chrono::microseconds deadline{0};  // 0 为取 period
+    std::chrono::microseconds period{0};    // 0 为不指定
+
+    bool empty() const noexcept {
+        return cpus.empty() && priority == 0 && npuCoreMask == 0 && schedClass == SchedClass::BestEffort &&
+               deadline.count() == 0 && period.count() == 0;
+    }
+    bool critical() const noexcept { return schedClass == SchedClass::Critical; }
+    // 生效的相对截止时间（deadline，否则 period；0 为不检查）
+    std::chrono::microseconds effectiveDeadline() const noexcept {
+        return deadline.count() > 0 ? deadline : period;
+    }
+    // 是否需要专用线程（线程级设置）
+    bool pinsThread() const noexcept { return !cpus.empty() || priority > 0; }
+    // 取值范围检查；失败时 error 为原因
+    bool validate(std::string& error) const;
+};
+
+// 把 cpus/priority 应用到调用线程；失败（权限不足、CPU 不存在）时打印警告并返回 false，线程照常运行
+bool applyThreadPlacement(const NodePlacement& placement, const std::string& owner);
+
+} // namespace falconmind::sdk::core
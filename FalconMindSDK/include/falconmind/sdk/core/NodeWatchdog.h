@@ -0,0 +1,169 @@
+// FalconMindSDK - 节点看门狗：卡死 / 时延 SLO 检测、自动恢复与降级
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+class Node;
+class PipelineScheduler;
+
+// 恢复 / 降级动作，按 WatchdogPolicy::ladder 的顺序逐级尝试
+enum class WatchdogAction : std::uint8_t {
+    Restart,          // 重启节点（stop() + start()）
+    FallbackBackend,  // 切换到备用后端（如 RKNN → CPU）
+    LowerResolution,  // 降低输出分辨率
+    LowerRate,        // 降低处理频率
+};
+
+const char* watchdogActionName(WatchdogAction action) noexcept;
+bool parseWatchdogAction(const std::string& name, WatchdogAction& out) noexcept;
+
+/**
+ * WatchdogPolicy - 单个节点的看门狗配置（Flow JSON 节点 parameters.watchdog）
+ *
+ *   "watchdog": { "stall_ms": 500, "slo_ms": 80, "violations": 3,
+ *                 "ladder": ["restart", "fallback_backend", "lower_resolution", "lower_rate"] }
+ *
+ * - stallTimeout：process() 单次执行或节点内部最早的在途工作（WatchdogTarget::pendingWorkAgeNs）超过该时长判定为卡死
+ * - latencySlo：一个检查周期内观测到的最大耗时超过该值记一次违约，连续 violations 次触发下一级动作
+ * - ladder：逐级尝试的动作，每项执行一次，节点不支持的动作直接跳过；未给出时为全部动作按声明顺序。
+ *   可重复列出同一动作（如多次 lower_rate 逐次减半频率，至多 1/8）
+ * stallTimeout 与 latencySlo 均为 0 时不监视该节点
+ */
+struct WatchdogPolicy {
+    std::chrono::milliseconds stallTimeout{0};
+    std::chrono::milliseconds latencySlo{0};
+    std::uint32_t violations{3};
+    std::vector<WatchdogAction> ladder{WatchdogAction::Restart, WatchdogAction::FallbackBackend,
+                                       WatchdogAction::LowerResolution, WatchdogAction::LowerRate};
+
+    bool enabled() const noexcept { return stallTimeout.count() > 0 || latencySlo.count() > 0; }
+    // 取值范围检查；失败时 error 为原因
+    bool validate(std::string& error) const;
+};
+
+/**
+ * WatchdogTarget - 可被看门狗观测与恢复的节点实现此接口（均可选）
+ * 在看门狗线程调用，可能与卡住的 process() / 节点内部线程并发，实现须自行保证线程安全
+ */
+class WatchdogTarget {
+public:
+    virtual ~WatchdogTarget() = default;
+
+    // 节点内部异步工作（推理线程等）中最早一项已等待的时长（纳秒，steady_clock），无在途工作返回 0
+    virtual std::int64_t pendingWorkAgeNs(std::int64_t nowNs) const {
+        (void)nowNs;
+        return 0;
+    }
+    // 执行一步恢复 / 降级；不支持或已到下限返回 false（看门狗改试下一级）。
+    // 未处理 Restart 时由看门狗暂停调度后调用 stop()/start()，未处理 LowerRate 时由调度器降频
+    virtual bool applyWatchdogAction(WatchdogAction action) {
+        (void)action;
+        return false;
+    }
+};
+
+enum class WatchdogEventKind : std::uint8_t {
+    Stalled,      // 判定为卡死
+    SloViolated,  // 连续超出时延 SLO
+    ActionTaken,  // 已执行一级恢复 / 降级（action 有效）
+    Exhausted,    // ladder 已用尽，节点仍不健康
+    Recovered,    // 恢复健康
+};
+
+const char* watchdogEventKindName(WatchdogEventKind kind) noexcept;
+
+struct WatchdogEvent {
+    std::string nodeId;
+    WatchdogEventKind kind{WatchdogEventKind::Stalled};
+    WatchdogAction action{WatchdogAction::Restart};  // 仅 ActionTaken 有效
+    double observedMs{0.0};  // 触发时观测到的卡住时长 / 最大耗时
+    std::size_t level{0};    // 已执行的动作级数
+    std::int64_t timestampNs{0};  // Unix epoch nanoseconds
+};
+
+// 序列化为 JSON 字符串（上报使用）
+std::string toJson(const WatchdogEvent& event);
+
+struct NodeWatchdogConfig {
+    std::chrono::milliseconds checkInterval{100};
+};
+
+/**
+ * NodeWatchdog - 周期检查受监视节点，按策略逐级恢复 / 降级并通过回调上报事件
+ *
+ * 每个检查周期经 PipelineScheduler::takeActivity 取节点当前 process() 已执行时长与周期内最大耗时，
+ * 并合并 WatchdogTarget::pendingWorkAgeNs（process() 立即返回、实际工作在内部线程的节点如 DetectionNode）：
+ * - 卡死：判定后执行下一级动作；仍未恢复时每经过一个 stallTimeout 再升一级
+ * - SLO：连续 violations 个周期超出时执行下一级动作，之后重新计数
+ * - 不支持的动作跳过；全部用尽时上报一次 Exhausted；由不健康转为健康时上报 Recovered（已执行的降级保持不变）
+ * Restart 的默认实现暂停调度（等待正在执行的 process() 至多 1s）后 stop()/start() 节点再恢复；
+ * process() 或节点内部工作卡住时不执行（stop() 会等待它完成），直接改试下一级。
+ * 回调在看门狗线程执行，应尽快返回。
+ */
+class NodeWatchdog {
+public:
+    using EventCallback = std::function<void(const WatchdogEvent& event)>;
+
+    explicit NodeWatchdog(PipelineScheduler& scheduler, const NodeWatchdogConfig& cfg = {});
+    ~NodeWatchdog();
+
+    NodeWatchdog(const NodeWatchdog&) = delete;
+    NodeWatchdog& operator=(const NodeWatchdog&) = delete;
+
+    // 须在 start() 之前调用；策略未启用时忽略
+    void watch(std::shared_ptr<Node> node, const WatchdogPolicy& policy);
+    void setEventCallback(EventCallback callback) { callback_ = std::move(callback); }
+    std::size_t watchedCount() const noexcept { return nodes_.size(); }
+
+    void start();
+    void stop();
+
+    // 执行一次检查（start() 的线程按 checkInterval 调用；测试可直接调用）
+    void check();
+
+    // 节点已执行的动作级数（未监视返回 0）
+    std::size_t level(const std::string& nodeId) const;
+
+private:
+    struct Watched {
+        std::shared_ptr<Node> node;
+        WatchdogTarget* target{nullptr};
+        WatchdogPolicy policy;
+        std::size_t level{0};            // 下一级动作在 ladder 中的下标
+        std::uint32_t violations{0};     // 连续违约周期数
+        bool stalled{false};
+        bool unhealthy{false};
+        bool exhausted{false};
+        std::int64_t lastActionNs{0};
+        std::uint64_t lastProcessCount{0};
+    };
+
+    void loop();
+    // stuck：节点当前卡住（默认 Restart 不可用）
+    void escalate(Watched& w, bool stuck, std::int64_t nowNs, double observedMs);
+    bool apply(Watched& w, WatchdogAction action, bool stuck);
+    void emit(const Watched& w, WatchdogEventKind kind, double observedMs, WatchdogAction action = {});
+
+    PipelineScheduler& scheduler_;
+    NodeWatchdogConfig config_;
+    std::vector<Watched> nodes_;
+    EventCallback callback_;
+    mutable std::mutex mutex_;  // 保护 nodes_ 的运行时状态（check() 与 level() 之间）
+    std::vector<WatchdogEvent>* pending_{nullptr};  // check() 期间收集的事件，解锁后再回调
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+    bool running_{false};
+    std::thread thread_;
+};
+
+} // namespace falconmind::sdk::core
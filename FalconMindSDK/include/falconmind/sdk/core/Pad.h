@@ -1,6 +1,14 @@
 // FalconMindSDK - Pad interface (week1 skeleton)
 #pragma once
 
+#include "falconmind/sdk/core/BoundedQueue.h"
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/Caps.h"
+#include "falconmind/sdk/core/PipelineMetrics.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <functional>
@@ -17,11 +25,81 @@ enum class PadType {
 // 前向声明
 class Pad;
 
-// Pad连接信息
+// 连接队列满时的处理策略
+enum class LinkQueuePolicy {
+    DropOldest,  // 丢弃队首最旧数据，保证下游拿到最新帧（默认，适合视频流）
+    DropNewest,  // 丢弃本次推送的数据
+    Block        // 等待队列有空位（最长 blockTimeout，超时后丢弃本次数据）
+};
+
+// 慢消费者背压策略（连接级）
+enum class LinkBackpressure {
+    None,            // 按 enabled/capacity/policy 原样处理
+    KeepLatest,      // 队列容量 1 + DropOldest：消费者总拿到最新帧，被覆盖的帧计入 drops
+    SkipN,           // 生产者侧抽帧：每 skipFrames + 1 帧只投递 1 帧，跳过的帧计入 skipped
+    AdaptSourceRate  // 同 KeepLatest，并按消费速率反馈上游（RateAdaptable）降低采集帧率
+};
+
+// 连接（link）级队列配置
+struct LinkQueueConfig {
+    bool enabled{false};  // false：同步直连，在生产者线程内调用 Sink 的 DataCallback
+    std::size_t capacity{4};
+    LinkQueuePolicy policy{LinkQueuePolicy::DropOldest};
+    std::chrono::milliseconds blockTimeout{100};
+    LinkBackpressure backpressure{LinkBackpressure::None};
+    std::uint32_t skipFrames{0};  // SkipN：每投递 1 帧后跳过的帧数
+    double minSourceFps{1.0};     // AdaptSourceRate：反馈给上游的最低帧率
+};
+
+// 按背压策略修正队列配置（KeepLatest/AdaptSourceRate 强制容量 1 的 DropOldest 队列）
+LinkQueueConfig effectiveQueueConfig(const LinkQueueConfig& cfg);
+
+class LinkRateController;
+
+/**
+ * LinkQueue - 连接级有界无锁队列
+ * pushBuffer 推送的 BufferRef 直接入队（零拷贝）；原始 data/size 推送时拷贝一份入队（缓冲区循环复用）。
+ * 由消费者线程（PipelineScheduler 或手动调用 Pad::drainQueued）出队并在消费者线程投递回调，
+ * 使慢速下游不再阻塞生产者。
+ */
+class LinkQueue {
+public:
+    explicit LinkQueue(const LinkQueueConfig& cfg);
+
+    // 入队；返回 false 表示数据（本次或最旧的一条）被丢弃
+    bool push(const void* data, size_t size);
+    bool push(const BufferRef& buffer);
+    // 出队到 out；队列为空返回 false
+    bool pop(BufferRef& out);
+    // 消费完毕后归还：由本队列拷贝分配且无其它持有者的缓冲会被回收复用
+    void recycle(BufferRef&& buffer);
+
+    const LinkQueueConfig& config() const noexcept { return config_; }
+    std::size_t depth() const noexcept { return items_.sizeApprox(); }
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    std::uint64_t pushed() const noexcept { return pushed_.load(std::memory_order_relaxed); }
+    std::uint64_t popped() const noexcept { return popped_.load(std::memory_order_relaxed); }
+
+private:
+    bool enqueue(BufferRef&& buffer);
+
+    LinkQueueConfig config_;
+    BoundedQueue<BufferRef> items_;
+    BoundedQueue<BufferRef> spare_;  // 回收的缓冲区，避免每帧重新分配
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> pushed_{0};
+    std::atomic<std::uint64_t> popped_{0};
+};
+
+// Pad连接信息：目标在 connectTo 时解析为 Pad 引用，逐帧推送不访问名称字段
 struct PadConnection {
     std::weak_ptr<Pad> targetPad;  // 目标Pad（弱引用，避免循环引用）
-    std::string targetNodeId;      // 目标节点ID
-    std::string targetPadName;     // 目标Pad名称
+    std::shared_ptr<LinkQueue> queue;  // 非空表示异步队列连接
+    std::shared_ptr<LinkCounters> counters;  // 推送帧数/字节数（connectTo 时创建）
+    std::uint32_t skipFrames{0};             // SkipN 抽帧间隔（0 为不抽帧）
+    std::shared_ptr<LinkRateController> rate;  // AdaptSourceRate 时非空
+    std::string targetNodeId;      // 目标节点ID（仅用于诊断）
+    std::string targetPadName;     // 目标Pad名称（仅用于诊断）
 };
 
 class Pad {
@@ -32,8 +110,12 @@ public:
     PadType type() const noexcept { return type_; }
     
     // 连接管理
-    bool connectTo(std::shared_ptr<Pad> targetPad, const std::string& targetNodeId, const std::string& targetPadName);
+    bool connectTo(std::shared_ptr<Pad> targetPad, const std::string& targetNodeId, const std::string& targetPadName,
+                   const LinkQueueConfig& queue = {});
     bool disconnect();
+    // 仅断开到 targetPad 的连接（其余连接保持）；未连接返回 false
+    bool disconnect(const std::shared_ptr<Pad>& targetPad);
+    // 连接列表（仅供 link/unlink、诊断与指标等低频路径；推送使用 connectTo/disconnect 时重建的只读投递表）
     const std::vector<PadConnection>& connections() const noexcept { return connections_; }
     bool isConnected() const noexcept { return !connections_.empty(); }
     
@@ -42,14 +124,75 @@ public:
     void setDataCallback(DataCallback callback) { dataCallback_ = callback; }
     DataCallback getDataCallback() const { return dataCallback_; }
 
-    /** Source Pad：将 data/size 推送到所有已连接的 Sink Pad 的 DataCallback；非 Source 或 data 为空则忽略 */
+    // 零拷贝缓冲回调：优先于 DataCallback；设置后接收方可直接持有 BufferRef 而无需拷贝
+    using BufferCallback = std::function<void(const BufferRef& buffer)>;
+    void setBufferCallback(BufferCallback callback) { bufferCallback_ = std::move(callback); }
+
+    // 数据到达通知（由 PipelineScheduler 设置）：Sink Pad 的 DataCallback 执行后调用，用于唤醒下游节点 process()
+    using ArrivalCallback = std::function<void()>;
+    void setArrivalCallback(ArrivalCallback callback) { arrivalCallback_ = std::move(callback); }
+
+    // 能力声明（节点在 link 前设置）；未声明视频格式的 Pad 不参与协商
+    void setCaps(const Caps& caps) { caps_ = caps; }
+    const Caps& caps() const noexcept { return caps_; }
+
+    // 协商结果（由 Pipeline::link 写入两端 Pad）；未协商时 format 为 Any
+    using CapsCallback = std::function<void(const VideoCaps& caps)>;
+    void setCapsCallback(CapsCallback callback) { capsCallback_ = std::move(callback); }
+    void setNegotiatedCaps(const VideoCaps& caps);
+    const VideoCaps& negotiatedCaps() const noexcept { return negotiated_; }
+
+    // 并行投递执行器（由 PipelineScheduler 设置）：同步直连的目标数不少于 minTargets 时，各目标的回调经
+    // executor(count, task) 并行执行 task(0..count-1)，executor 返回前须全部完成；为空时在推送线程依次投递
+    using FanOutExecutor = std::function<void(std::size_t count, const std::function<void(std::size_t)>& task)>;
+    void setFanOutExecutor(FanOutExecutor executor, std::size_t minTargets = 2);
+
+    /** Source Pad：将 data/size 推送到所有已连接的 Sink Pad 的 DataCallback（队列连接则入队）；非 Source 或 data 为空则忽略 */
     void pushToConnections(const void* data, size_t size) const;
 
+    /** Source Pad：零拷贝推送 BufferRef；对只设置 DataCallback 的接收方以 data()/size() 兼容投递 */
+    void pushBuffer(const BufferRef& buffer) const;
+
+    /** Sink Pad：从每个入站队列各取至多 maxPerQueue 条数据并调用 DataCallback，返回投递条数（须在单一消费者线程调用） */
+    size_t drainQueued(size_t maxPerQueue = 1);
+    bool hasQueuedData() const noexcept;
+    // Sink Pad：全部入站队列当前积压条数
+    size_t queuedDepth() const noexcept;
+
 private:
     std::string name_;
+    const char* traceName_;  // "push:<name>"，Tracer::intern() 结果；推送区间嵌套在推送方节点的 process 区间内
     PadType type_;
     std::vector<PadConnection> connections_;  // 连接列表（Source Pad可以有多个连接）
+
+    // 投递表：连接变化时整体重建并原子替换，推送时只读；目标以裸指针访问，
+    // 存活检查只读弱引用计数（不做加减引用），避免逐连接 weak_ptr::lock
+    struct FanOutTarget {
+        PadConnection conn;
+        Pad* pad{nullptr};
+    };
+    struct FanOut {
+        std::vector<FanOutTarget> targets;
+        std::size_t syncTargets{0};  // 同步直连（非队列）目标数
+    };
+    static constexpr std::size_t kMaxParallelTargets = 16;  // 超出部分在推送线程依次投递
+    std::shared_ptr<const FanOut> fanOut_;
+    FanOutExecutor fanOutExecutor_;
+    std::size_t fanOutMin_{2};
+    void rebuildFanOut();
+    // buffer 为空时按 data/size 推送（需要 BufferRef 的接收方共享一次拷贝）
+    void dispatch(const BufferRef* buffer, const void* data, size_t size) const;
+
+    void deliver(const BufferRef& buffer) const;
+    static bool skipFrame(const PadConnection& conn);  // SkipN：本帧是否跳过（并计数）
+
     DataCallback dataCallback_;  // 数据传递回调
+    BufferCallback bufferCallback_;  // 零拷贝缓冲回调
+    ArrivalCallback arrivalCallback_;  // 数据到达通知
+    CapsCallback capsCallback_;  // 协商结果通知
+    Caps caps_;
+    VideoCaps negotiated_;
+    std::vector<std::shared_ptr<LinkQueue>> inboundQueues_;  // 入站队列（Sink Pad）
 };
 
 } // namespace falconmind::sdk::core
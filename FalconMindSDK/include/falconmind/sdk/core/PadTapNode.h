@@ -0,0 +1,64 @@
+// FalconMindSDK - 把任意 Source Pad 的输出以 BufferRef 交给进程内的回调（C API / 语言绑定的数据出口）
+#pragma once
+
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/Pad.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+/**
+ * PadTapNode - Sink Pad "in" 收到的缓冲原样交给 handler（不拷贝：pushBuffer 推送的帧即生产者的池缓冲，
+ * handler 持有 BufferRef 期间缓冲不会被复用）；由 Pipeline::addPadTap 插入，ID 见 Pipeline::padTapId()。
+ * 同步直连时 handler 在生产者线程调用，队列连接时在调度线程调用；handler 应尽快返回
+ */
+class PadTapNode : public Node {
+public:
+    explicit PadTapNode(Pad::BufferCallback handler);
+
+    std::uint64_t delivered() const noexcept { return delivered_.load(std::memory_order_relaxed); }
+
+private:
+    Pad::BufferCallback handler_;
+    std::atomic<std::uint64_t> delivered_{0};
+};
+
+/**
+ * PadTapQueue - 出口回调与消费线程之间的有界缓冲队列（语言绑定在其中等待数据，等待期间不持有解释器锁）
+ * 满时丢弃最旧的缓冲；只保存 BufferRef，不拷贝数据。close() 唤醒全部等待者，之后 pop 立即返回 false
+ */
+class PadTapQueue {
+public:
+    explicit PadTapQueue(std::size_t capacity = 4);
+
+    void push(const BufferRef& buffer);
+    // timeout 为负时一直等待；超时或已关闭返回 false
+    bool pop(BufferRef& out, std::chrono::milliseconds timeout);
+    // 等待至少一条，然后取出至多 max 条追加到 out；返回取出条数（超时或已关闭且为空时为 0）
+    std::size_t popBatch(std::vector<BufferRef>& out, std::size_t max, std::chrono::milliseconds timeout);
+    void close();
+    void reopen();
+
+    std::size_t size() const;
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    bool waitLocked(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout);
+
+    std::size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<BufferRef> items_;
+    bool closed_{false};
+    std::atomic<std::uint64_t> dropped_{0};
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,74 @@
+// FalconMindSDK - 硬件性能计数器（Linux perf_event）：周期、指令、L1D/LLC 缺失、分支预测失败、上下文切换
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace falconmind::sdk::core {
+
+enum class PerfCounter : std::uint8_t {
+    Cycles = 0,
+    Instructions,
+    L1dMisses,        // L1 数据缓存读缺失
+    LlcMisses,        // 末级缓存缺失（A55 等无 LLC 事件的核上不可用）
+    BranchMisses,
+    ContextSwitches,  // 软件事件，QEMU / 禁用硬件计数器的容器中仍可用
+    Count
+};
+
+const char* perfCounterName(PerfCounter counter) noexcept;
+
+// 一组计数器的累计值；available 按位标记 (1 << PerfCounter) 已成功打开的计数器，不可用的计数保持 0
+struct PerfCounterValues {
+    std::uint64_t value[static_cast<std::size_t>(PerfCounter::Count)]{};
+    std::uint32_t available{0};
+
+    std::uint64_t operator[](PerfCounter c) const noexcept { return value[static_cast<std::size_t>(c)]; }
+    bool has(PerfCounter c) const noexcept { return (available >> static_cast<unsigned>(c)) & 1u; }
+    // 每周期指令数；周期或指令不可用时返回 -1
+    double ipc() const noexcept;
+
+    PerfCounterValues& operator+=(const PerfCounterValues& other) noexcept;
+    // 逐项相减（计数器单调递增，用于区间差值）；available 取两者交集
+    PerfCounterValues operator-(const PerfCounterValues& earlier) const noexcept;
+};
+
+/**
+ * PerfCounterGroup - 统计调用线程（open 时的线程）用户态事件的 perf_event 计数器组
+ *
+ * 各事件单独尝试打开，内核 / 核型不支持的事件跳过（如 QEMU TCG 无硬件事件、A55 无 LLC 事件），
+ * 其余作为同一组一起启停，read() 一次系统调用读出全部。组被复用（多路复用）时按运行时间比例缩放。
+ * 需要 perf_event_paranoid ≤ 2（统计本线程用户态事件的默认要求）；非 Linux 平台 open() 返回 false。
+ * 非线程安全：只在 open 的线程读取。
+ */
+class PerfCounterGroup {
+public:
+    PerfCounterGroup() = default;
+    ~PerfCounterGroup();
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    // 为调用线程打开计数器；一个都打不开时返回 false
+    bool open();
+    void close();
+    bool isOpen() const noexcept { return leader_ >= 0; }
+    std::uint32_t available() const noexcept { return available_; }
+
+    // 当前累计值（自 open 起）；失败时返回 false
+    bool read(PerfCounterValues& out) const;
+
+    // 调用线程的计数器组（thread_local，首次调用时打开，线程退出时关闭）；打不开时返回 nullptr
+    static PerfCounterGroup* forCurrentThread();
+
+private:
+    int leader_{-1};
+    int fds_[static_cast<std::size_t>(PerfCounter::Count)]{-1, -1, -1, -1, -1, -1};
+    PerfCounter order_[static_cast<std::size_t>(PerfCounter::Count)]{};  // 组内读取顺序
+    std::size_t opened_{0};
+    std::uint32_t available_{0};
+};
+
+// 日志 / 基准输出用："cycles instructions l1d_misses ..."（当前线程可用的事件），均不可用时为 "none"
+std::string perfCounterSummary();
+
+} // namespace falconmind::sdk::core
@@ -1,7 +1,14 @@
 // FalconMindSDK - Pipeline core interface (week1 skeleton)
 #pragma once
 
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineMetrics.h"
+#include "falconmind/sdk/core/PipelineScheduler.h"
+
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -10,7 +17,7 @@
 namespace falconmind::sdk::core {
 
 class Node;
-class Pad;
+struct ShmChannelConfig;
 
 enum class PipelineState {
     Null,
@@ -23,6 +30,13 @@ struct PipelineConfig {
     std::string pipelineId;
     std::string name;
     std::string description;
+    // 进入 Playing 时并行启动节点的线程数上限：0 为不限（每个可启动节点一个线程），1 为串行
+    std::size_t startThreads{0};
+    // Flow 内存预算（字节，0 为未设置），仅随 metrics() 上报；预算检查与降级由 FlowExecutor::start 完成
+    std::size_t memoryBudgetBytes{0};
+    // 进入 Playing 时把一对一相连的逐像素节点（颜色转换 → 低照度查表 → 裁剪缩放）融合为单趟逐行内核
+    //（见 sensors::FusablePixelStage）；关闭时各节点逐帧独立处理
+    bool fusePixelStages{true};
 };
 
 class Pipeline {
@@ -33,18 +47,68 @@ public:
     const std::string& id() const noexcept { return config_.pipelineId; }
 
     bool addNode(const std::shared_ptr<Node>& node);
+    // 断开节点的全部连接（含自动插入的转换节点）并移除；已启动的节点会先 stop()。
+    // 须在调度器未运行时调用（Null/Ready/Paused），Paused 期间新增的节点在恢复 Playing 时启动
+    bool removeNode(const std::string& nodeId);
+    // queue.enabled 为 true 时该连接使用有界无锁队列异步投递（见 LinkQueueConfig）；
+    // queue.backpressure 选择慢消费者策略，AdaptSourceRate 要求上游节点实现 RateAdaptable
+    // 两端 Pad 声明了视频能力时在此协商格式；无公共格式但可转换时自动插入 VideoConvertNode
+    //（节点 ID 见 converterId()，queue 配置用于上游到转换节点的一段）
     bool link(const std::string& srcNodeId,
               const std::string& srcPadName,
               const std::string& dstNodeId,
-              const std::string& dstPadName);
+              const std::string& dstPadName,
+              const LinkQueueConfig& queue = {});
     
     bool unlink(const std::string& srcNodeId,
                 const std::string& srcPadName,
                 const std::string& dstNodeId,
                 const std::string& dstPadName);
 
+    // 跨进程连接：把 srcNodeId.srcPadName 的输出写入共享内存通道（插入 ID 为 remoteSinkId(channel.name) 的 ShmSinkNode），
+    // 另一进程的 Pipeline 用 addRemoteSource 以同名通道接收；queue 配置用于上游到 ShmSinkNode 的一段
+    bool linkRemote(const std::string& srcNodeId,
+                    const std::string& srcPadName,
+                    const ShmChannelConfig& channel,
+                    const LinkQueueConfig& queue = {});
+    // 添加从共享内存通道接收的 ShmSourceNode（Source Pad "out"），之后按普通节点 link 到下游
+    bool addRemoteSource(const std::string& nodeId, const std::string& channelName);
+    static std::string remoteSinkId(const std::string& channelName) { return "__shm_sink__" + channelName; }
+
+    // 录制：把 srcNodeId.srcPadName 的输出连同时间戳写入捕获文件（插入 ID 为 tapId() 的 CaptureRecorderNode，
+    // 进入 Playing 时创建文件，Ready/Null 时写索引关闭）；用 ReplaySourceNode 或相机/点云节点的文件模式回放
+    bool tapToFile(const std::string& srcNodeId, const std::string& srcPadName, const std::string& path,
+                   const LinkQueueConfig& queue = {});
+    static std::string tapId(const std::string& srcNodeId, const std::string& srcPadName) {
+        return "__capture__" + srcNodeId + "." + srcPadName;
+    }
+
+    // 进程内数据出口：把 srcNodeId.srcPadName 的输出以 BufferRef 交给 handler（插入 ID 为 padTapId() 的 PadTapNode，
+    // 不拷贝数据）；queue.enabled 时 handler 在调度线程调用，慢速消费者不阻塞生产者。
+    // removePadTap 与 removeNode 相同，须在调度器未运行时调用
+    bool addPadTap(const std::string& srcNodeId, const std::string& srcPadName, Pad::BufferCallback handler,
+                   const LinkQueueConfig& queue = {});
+    bool removePadTap(const std::string& srcNodeId, const std::string& srcPadName);
+    static std::string padTapId(const std::string& srcNodeId, const std::string& srcPadName) {
+        return "__tap__" + srcNodeId + "." + srcPadName;
+    }
+
+    // Playing：启动节点并启动调度器；Paused：暂停调度并调用节点 pause()（节点保持启动，不释放资源）；
+    // Ready/Null：停止调度并停止节点。Paused 期间拓扑未变时恢复 Playing 只唤醒调度器，不重建调度
+    // 节点在其全部下游节点启动成功后启动，互不依赖的节点并行启动（见 PipelineConfig::startThreads）；
+    // 任一节点失败时已启动的节点全部回滚，失败节点见 startFailures()
     bool setState(PipelineState newState);
+    const std::vector<std::string>& startFailures() const noexcept { return startFailures_; }
+    // 最近一次进入 Playing 时建立的像素融合链（每条为按数据流顺序的节点 ID）
+    const std::vector<std::vector<std::string>>& fusedPixelChains() const noexcept { return fusedChains_; }
     PipelineState state() const noexcept { return state_; }
+
+    // 调度器（可在进入 Playing 前调整线程数与 Source 周期）
+    PipelineScheduler& scheduler() noexcept { return *scheduler_; }
+    const PipelineScheduler& scheduler() const noexcept { return *scheduler_; }
+
+    // 按连接关系计算节点拓扑序（同层按节点 ID 排序，结果稳定）；存在环时返回 false
+    bool topologicalOrder(std::vector<std::string>& order) const;
     
     // 获取节点
     std::shared_ptr<Node> getNode(const std::string& nodeId);
@@ -58,11 +122,73 @@ public:
     };
     std::vector<LinkInfo> getLinks() const;
 
+    /**
+     * 运行时指标快照：节点按拓扑序，连接按 ID 排序。计数器在热路径只做 relaxed 原子累加，可常开；
+     * 本调用读取计数并计算相对上一次调用的帧率/字节率（首次调用速率为 0）。
+     */
+    PipelineMetrics metrics();
+
+    // link 自动插入的转换节点 ID
+    static std::string converterId(const std::string& srcNodeId, const std::string& srcPadName,
+                                   const std::string& dstNodeId, const std::string& dstPadName);
+
 private:
     PipelineConfig config_;
     PipelineState state_{PipelineState::Null};
 
     std::unordered_map<std::string, std::shared_ptr<Node>> nodes_;
+    std::unique_ptr<PipelineScheduler> scheduler_;
+    std::vector<std::shared_ptr<Node>> startedNodes_;  // 已调用 start() 的节点（按拓扑序）
+    std::vector<std::string> startFailures_;            // 最近一次启动失败的节点 ID
+    std::vector<std::vector<std::string>> fusedChains_;
+
+    // 开关节点（BranchSwitch）各输出截断时需释放缓冲的下游节点；回调可在任意线程执行，
+    // scheduler 在调度器运行期间非空，由 mutex 与 clearBranchSwitches() 交接
+    struct BranchRoutes {
+        std::mutex mutex;
+        PipelineScheduler* scheduler{nullptr};
+        std::unordered_map<const Pad*, std::vector<std::string>> idleNodes;
+    };
+    std::shared_ptr<BranchRoutes> branchRoutes_;
+
+    bool buildSchedule(std::vector<std::shared_ptr<Node>>& ordered, std::vector<bool>& isSource) const;
+
+    struct LinkKey;
+    // 拓扑的紧凑表示：节点以下标表示（按 ID 排序），下游关系为 CSR 邻接数组，连接两端 Pad 已解析为指针。
+    // 在图变化（增删节点/连接）后首次使用时重建，拓扑序、调度构建与指标采样均不再按字符串查表
+    struct Topology {
+        std::vector<std::shared_ptr<Node>> nodes;
+        std::unordered_map<const Node*, std::uint32_t> indexOf;
+        std::vector<std::uint32_t> downstreamOffsets;  // nodes.size() + 1 项
+        std::vector<std::uint32_t> downstream;         // 去重后的下游节点下标
+        std::vector<bool> hasUpstream;
+        std::vector<std::uint32_t> order;              // 拓扑序（同层按 ID）
+        bool acyclic{true};
+        struct Link {
+            std::uint32_t src;
+            std::uint32_t dst;
+            Pad* srcPad;
+            Pad* dstPad;
+            const LinkKey* key;  // 指向 links_ 中的元素（重建前有效）
+        };
+        std::vector<Link> links;
+    };
+    std::shared_ptr<const Topology> topology() const;
+    void invalidateTopology();
+    mutable std::mutex topologyMutex_;
+    std::uint64_t topologyVersion_{0};   // 每次拓扑变化递增
+    std::uint64_t scheduledVersion_{0};  // 调度器启动时的拓扑版本
+    mutable std::shared_ptr<const Topology> topology_;
+    bool startNodes(const std::vector<std::shared_ptr<Node>>& ordered);
+    void stopNodes();
+    void stopNodes(const std::vector<std::shared_ptr<Node>>& nodes);  // 仅停止列表中已启动的节点
+    bool startPlaying();  // 重建调度：启动尚未启动的节点并启动调度器
+    // 调度器未运行时调用：按当前拓扑重建 / 清除像素融合链
+    void planPixelFusion();
+    void clearPixelFusion();
+    // 调度器启动后 / 停止前调用：为开关节点安装 / 清除分支截断回调
+    void planBranchSwitches();
+    void clearBranchSwitches();
     
     // 存储连接信息（用于快速查找和验证）
     struct LinkKey {
@@ -89,6 +215,22 @@ private:
     };
     
     std::unordered_set<LinkKey, LinkKeyHash> links_;  // 存储所有连接
+    std::unordered_map<LinkKey, std::string, LinkKeyHash> converters_;  // 原始连接 → 自动插入的转换节点 ID
+
+    // metrics() 速率计算用的上一次采样
+    struct LinkSample {
+        std::uint64_t frames{0};
+        std::uint64_t bytes{0};
+    };
+    std::mutex metricsMutex_;
+    std::chrono::steady_clock::time_point lastMetricsAt_{};
+    std::unordered_map<LinkKey, LinkSample, LinkKeyHash> lastLinkSamples_;
+
+    // AdaptSourceRate：把连接的速率控制器反馈接到上游 RateAdaptable 节点
+    void installRateFeedback(const LinkKey& key, const std::shared_ptr<Node>& srcNode, const Pad& srcPad,
+                             const std::shared_ptr<Pad>& dstPad);
+    bool linkWithConverter(const LinkKey& key, const std::shared_ptr<Pad>& srcPad,
+                           const std::shared_ptr<Pad>& dstPad, const LinkQueueConfig& queue);
 };
 
 } // namespace falconmind::sdk::core
@@ -0,0 +1,165 @@
+// FalconMindSDK - 管线时钟与端到端时延（采集 → 检测/汇点）统计
+#pragma once
+
+#include "falconmind/sdk/core/PipelineMetrics.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+/**
+ * PipelineClock - 全管线统一时基：CLOCK_MONOTONIC 纳秒
+ * 与 V4L2 默认的缓冲时间戳（V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC）同一时基，
+ * 采集节点可直接写入驱动时间戳，下游用 nowNs() 相减即得 glass-to-X 时延。
+ *
+ * 虚拟时钟（无头回放仿真，见 ReplayRunner）：enableVirtual 后 nowNs() 返回由 advanceVirtualTo 推进的时刻，
+ * 不再读系统时钟；进程内全局，只应由驱动仿真的一方推进。未启用时 nowNs() 只多一次 relaxed 读。
+ * 需要按时间休眠 / 超时等待的模块（调度器、行为树、指令 ACK 超时、重连退避）经 waitUntil 等待：
+ * 虚拟时钟下等待只在虚拟时刻到达（或被条件唤醒）时结束，与墙钟无关，测试因此可确定性地快速推进。
+ */
+struct PipelineClock {
+    // 虚拟时钟下等待者复查虚拟时刻的墙钟间隔
+    static constexpr std::chrono::milliseconds kVirtualWaitSlice{1};
+
+    static std::int64_t nowNs() noexcept;
+    // 启用虚拟时钟并置为 startNs
+    static void enableVirtual(std::int64_t startNs) noexcept;
+    static void disableVirtual() noexcept;
+    static bool isVirtual() noexcept;
+    // 推进虚拟时钟（只增不减；未启用时忽略）
+    static void advanceVirtualTo(std::int64_t ns) noexcept;
+
+    // 在 cv 上等到 pred 成立或到达 deadlineNs，返回 pred()（同 condition_variable::wait_until）
+    template <class Predicate>
+    static bool waitUntil(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, std::int64_t deadlineNs,
+                          Predicate pred) {
+        if (!isVirtual()) {
+            // nowNs 与 steady_clock 同为 CLOCK_MONOTONIC
+            return cv.wait_until(lock, std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadlineNs)),
+                                 pred);
+        }
+        while (!pred()) {
+            if (nowNs() >= deadlineNs) return false;
+            cv.wait_for(lock, kVirtualWaitSlice);
+        }
+        return true;
+    }
+
+    static std::int64_t fromTimeval(std::int64_t sec, std::int64_t usec) noexcept {
+        return sec * 1000000000ll + usec * 1000ll;
+    }
+};
+
+/**
+ * PipelineSteadyClock - PipelineClock 的 std::chrono 时钟适配（满足 Clock 要求，is_steady）
+ * 以 time_point 表达定时的模块（行为树定时与超时、悬停等动作）以此为时钟，随 PipelineClock 进入虚拟时间。
+ */
+struct PipelineSteadyClock {
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<PipelineSteadyClock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept { return time_point(duration(PipelineClock::nowNs())); }
+    static std::int64_t toNs(time_point t) noexcept { return t.time_since_epoch().count(); }
+};
+
+// 端到端时延快照
+struct LatencyStats {
+    std::uint64_t count{0};       // 有效采集时间戳的帧数
+    std::uint64_t overBudget{0};  // 超出预算的帧数
+    std::int64_t budgetNs{0};     // 0 表示未设置预算
+    double p50Ms{0.0};
+    double p99Ms{0.0};
+    double maxMs{0.0};
+};
+
+/**
+ * LatencyTracker - 记录每帧 (now - 采集时间戳)，超出预算时计数
+ * record() 只做 relaxed 原子操作，可在每帧调用；budget 可在运行时修改。
+ */
+class LatencyTracker {
+public:
+    void setBudgetNs(std::int64_t budgetNs) noexcept { budgetNs_.store(budgetNs, std::memory_order_relaxed); }
+    std::int64_t budgetNs() const noexcept { return budgetNs_.load(std::memory_order_relaxed); }
+
+    /**
+     * 记录一帧；captureNs 为 0（未打时间戳）时忽略
+     * @return 超出预算时返回累计超限帧序号（从 1 开始，便于调用方限频告警），否则返回 0
+     */
+    std::uint64_t record(std::int64_t captureNs, std::int64_t nowNs = PipelineClock::nowNs()) noexcept;
+    LatencyStats stats() const noexcept;
+
+private:
+    LatencyHistogram histogram_;
+    std::atomic<std::int64_t> budgetNs_{0};
+    std::atomic<std::uint64_t> overBudget_{0};
+};
+
+/**
+ * LatencySink - 可统计端到端时延的节点（检测、跟踪等汇点）实现此接口
+ * FlowExecutor 按 Flow 定义的 latency_budget_ms 为其设置预算，Pipeline::metrics() 汇总其统计。
+ */
+class LatencySink {
+public:
+    virtual ~LatencySink() = default;
+    LatencyTracker& latencyTracker() noexcept { return latencyTracker_; }
+    const LatencyTracker& latencyTracker() const noexcept { return latencyTracker_; }
+
+protected:
+    LatencyTracker latencyTracker_;
+};
+
+/**
+ * StageProfiler - 节点内部各阶段耗时与设备利用率统计
+ * 阶段名在构造时固定（至多 kMaxStages 个）；recordUs()/recordUtilization() 只做 relaxed 原子操作，可在每帧调用。
+ */
+class StageProfiler {
+public:
+    static constexpr std::size_t kMaxStages = 6;
+
+    explicit StageProfiler(std::vector<std::string> stages = {});
+
+    const std::vector<std::string>& stageNames() const noexcept { return names_; }
+    // 越界的阶段号忽略
+    void recordUs(std::size_t stage, std::uint64_t us) noexcept;
+    // utilization ∈ [0, 1]，负值（不可用）忽略
+    void recordUtilization(double utilization) noexcept;
+
+    // 有样本的阶段按构造顺序输出
+    std::vector<StageMetrics> stats() const;
+    // 平均利用率；无样本返回 -1
+    double utilization() const noexcept;
+
+private:
+    std::vector<std::string> names_;
+    std::array<LatencyHistogram, kMaxStages> histograms_;
+    std::array<std::atomic<std::uint64_t>, kMaxStages> sumUs_{};
+    std::atomic<std::uint64_t> utilizationPpm_{0};  // 累计（百万分之一）
+    std::atomic<std::uint64_t> utilizationSamples_{0};
+};
+
+/**
+ * StageProfileSink - 可报告分阶段耗时的节点（如 DetectionNode）实现此接口，Pipeline::metrics() 汇总其统计
+ */
+class StageProfileSink {
+public:
+    explicit StageProfileSink(std::vector<std::string> stages) : stageProfiler_(std::move(stages)) {}
+    virtual ~StageProfileSink() = default;
+    StageProfiler& stageProfiler() noexcept { return stageProfiler_; }
+    const StageProfiler& stageProfiler() const noexcept { return stageProfiler_; }
+
+protected:
+    StageProfiler stageProfiler_;
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,116 @@
+// FalconMindSDK - Pipeline 运行时指标（节点 process() 耗时、连接吞吐与丢帧）
+#pragma once
+
+#include "falconmind/sdk/core/PerfCounters.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+/**
+ * LatencyHistogram - 无锁对数直方图（纳秒）
+ * 每个 2 的幂区间再分 4 个子桶（分位数相对误差 < 25%），覆盖 0 ~ 2^40 ns，更大的样本计入最后一个桶。
+ * record() 只做 relaxed 原子累加，可在热路径常开；读取为近似快照。
+ */
+class LatencyHistogram {
+public:
+    void record(std::uint64_t ns) noexcept;
+    // q ∈ [0, 1]；返回样本所在桶的上界（不超过最大样本），无样本返回 0
+    std::uint64_t percentile(double q) const noexcept;
+    std::uint64_t count() const noexcept;
+    std::uint64_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t kSubBuckets = 4;
+    static constexpr std::size_t kBuckets = 40 * kSubBuckets;
+
+    static std::size_t bucketIndex(std::uint64_t ns) noexcept;
+    static std::uint64_t bucketUpperBound(std::size_t index) noexcept;
+
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+// 连接级累计计数（由 Source Pad 推送时累加）
+struct LinkCounters {
+    std::atomic<std::uint64_t> frames{0};
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::uint64_t> skipped{0};  // SkipN 抽帧跳过的帧数
+};
+
+// 节点内部单个阶段的耗时快照（StageProfiler，如检测的 preprocess / infer / decode / nms）
+struct StageMetrics {
+    std::string name;
+    std::uint64_t count{0};
+    double meanUs{0.0};
+    double p50Us{0.0};
+    double p99Us{0.0};
+    double maxUs{0.0};
+};
+
+// 单个节点指标快照
+struct NodeMetrics {
+    std::string nodeId;
+    std::uint64_t processCount{0};  // 调度器启动以来 process() 调用次数
+    double p50Us{0.0};              // process() 墙钟耗时分位数（微秒）
+    double p99Us{0.0};
+    double maxUs{0.0};
+    double cpuMs{0.0};              // process() 累计线程 CPU 时间（毫秒；需开启 PipelineSchedulerConfig::cpuAccounting）
+    PerfCounterValues perf;         // process() 累计性能计数（需开启 PipelineSchedulerConfig::perfCounters；available 为 0 表示无）
+    std::size_t queueDepth{0};      // 入站队列当前积压条数
+    // 截止时间统计，仅关键节点（NodePlacement::critical）填写
+    bool hasDeadline{false};
+    double deadlineMs{0.0};         // 相对截止时间
+    std::uint64_t deadlineMisses{0};  // process() 完成晚于截止时间的次数
+    double maxLatenessMs{0.0};      // 最大超时量
+    // 端到端时延（采集时间戳 → 本节点），仅 LatencySink 节点填写
+    bool hasLatency{false};
+    double latencyP50Ms{0.0};
+    double latencyP99Ms{0.0};
+    double latencyMaxMs{0.0};
+    double latencyBudgetMs{0.0};    // 0 表示未设置预算
+    std::uint64_t overBudget{0};    // 超出预算的帧数
+    // 分阶段耗时与设备（NPU/GPU）平均利用率 0~1，仅 StageProfileSink 节点填写；利用率 < 0 为不可用
+    std::vector<StageMetrics> stages;
+    double deviceUtilization{-1.0};
+    // 缓冲内存占用（字节），仅 MemoryBudgetSink 节点填写
+    bool hasMemory{false};
+    std::size_t memoryBytes{0};
+    std::size_t memoryPeakBytes{0};
+    std::size_t memoryEstimateBytes{0};  // 按当前配置（含降级）估算的上限
+};
+
+// 单条连接指标快照；速率为相对上一次 Pipeline::metrics() 调用的区间平均值
+struct LinkMetrics {
+    std::string srcNodeId;
+    std::string srcPadName;
+    std::string dstNodeId;
+    std::string dstPadName;
+    std::uint64_t frames{0};  // 连接建立以来累计推送帧数
+    std::uint64_t bytes{0};
+    std::uint64_t drops{0};   // 队列连接因满被丢弃的帧数（直连恒为 0）
+    std::uint64_t skipped{0}; // SkipN 抽帧跳过的帧数
+    double sourceFpsLimit{0.0};  // AdaptSourceRate 当前反馈给上游的帧率上限（0 为不限）
+    std::size_t queueDepth{0};
+    double framesPerSec{0.0};
+    double bytesPerSec{0.0};
+};
+
+struct PipelineMetrics {
+    std::string pipelineId;
+    std::int64_t timestampNs{0};  // 采样时间（Unix epoch nanoseconds）
+    std::vector<NodeMetrics> nodes;
+    std::vector<LinkMetrics> links;
+    std::size_t memoryBudgetBytes{0};  // Flow 内存预算（0 表示未设置）
+    std::size_t memoryBytes{0};        // 各节点 memoryBytes 之和
+};
+
+// 序列化为 JSON 字符串（C API / Telemetry 上报使用）
+std::string toJson(const PipelineMetrics& metrics);
+
+} // namespace falconmind::sdk::core
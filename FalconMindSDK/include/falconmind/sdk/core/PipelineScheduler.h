@@ -0,0 +1,264 @@
+// FalconMindSDK - Pipeline scheduler (drives Node::process() on worker threads)
+#pragma once
+
+#include "falconmind/sdk/core/NodePlacement.h"
+#include "falconmind/sdk/core/PipelineMetrics.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+class AsyncContext;
+class AsyncLoop;
+class AsyncNode;
+class BranchIdleSink;
+class Node;
+class Pad;
+
+// 节点运行状态采样（NodeWatchdog 使用）
+struct NodeActivity {
+    std::uint64_t processCount{0};
+    std::int64_t runningForNs{0};   // 当前 process() 已执行的时长，空闲为 0
+    std::uint64_t windowMaxNs{0};   // 上次采样以来 process() 的最大耗时
+};
+
+struct PipelineSchedulerConfig {
+    // 下游节点共享的工作线程数；0 表示使用 std::thread::hardware_concurrency()
+    std::size_t workerThreads{0};
+    // Source 节点默认调度周期（最小间隔）；0 表示连续调用（适用于 process() 内部阻塞等待数据的源，如 V4L2）
+    std::chrono::microseconds sourcePeriod{33333};
+    // 统计每个节点 process() 的线程 CPU 时间（NodeMetrics::cpuMs）；每次调用多两次 clock_gettime，默认关闭
+    bool cpuAccounting{false};
+    // 以 perf_event 统计每个节点 process() 期间执行线程的周期、指令、缓存 / 分支缺失与上下文切换
+    // （NodeMetrics::perf）；每次调用多两次 read 系统调用，默认关闭。计数器不可用时静默跳过
+    bool perfCounters{false};
+    // Source Pad 的同步直连目标不少于该值时，在线程池上并行投递各目标的回调（推送线程参与执行并等待全部完成）；
+    // 0 表示关闭（按连接顺序在推送线程依次投递）
+    std::size_t parallelFanOutMin{0};
+    // 关键节点（NodePlacement::critical）预留的工作线程数：按最早截止时间优先（EDF）只执行关键下游节点；
+    // 0 时关键节点进入共享线程池队首（仍统计截止时间）
+    std::size_t criticalWorkers{1};
+    // 预留线程及关键 Source / 专用线程（未自设 priority 时）的 SCHED_FIFO 优先级，0 为普通调度；
+    // 需要 CAP_SYS_NICE，失败时告警后以普通调度运行
+    int criticalPriority{50};
+    // 预留线程绑定的 CPU；非空时共享线程池绑定到其余 CPU，尽力而为的节点不与关键节点争用这些核
+    std::vector<int> criticalCpus;
+    // 手动步进（无头回放仿真，见 ReplayRunner）：start() 不创建 Source / 工作线程，由调用方以 runOnce() 驱动，
+    // Source 周期按 PipelineClock（可为虚拟时钟）计时；线程放置、关键节点 EDF 与并行扇出不生效
+    bool manual{false};
+};
+
+/**
+ * TimedSource - 知道下一条数据到期时刻的 Source 节点（如按录制时间回放的 ReplaySourceNode）实现此接口
+ * 手动步进时调度器在 PipelineClock 到达 nextDueNs() 时调用其 process()（忽略调度周期），
+ * ReplayRunner 据此把虚拟时钟直接推进到下一事件，而不是按固定步长空转
+ */
+class TimedSource {
+public:
+    static constexpr std::int64_t kNever = INT64_MAX;
+
+    virtual ~TimedSource() = default;
+    // 下一条数据的到期时刻（PipelineClock 时基）；没有更多数据时返回 kNever
+    virtual std::int64_t nextDueNs() const = 0;
+};
+
+/**
+ * PipelineScheduler - Pipeline 调度器
+ *
+ * - Source 节点（无上游连接）：每个节点一个专用线程，按 sourcePeriod（或 setNodePeriod 覆盖值）循环调用 process()
+ * - 下游节点：其 Sink Pad 收到数据后投递到共享线程池执行 process()；
+ *   同一节点的 process() 不会并发执行，处理期间到达的多次数据合并为一次补调度
+ * - 队列连接（LinkQueueConfig::enabled）：每次 process() 前在工作线程从每个入站队列取一条数据投递给
+ *   DataCallback，队列未取空则继续调度，保证逐条处理
+ *
+ * - 节点放置提示（Node::placement）：Source 线程按其设置绑核/提权；设置了 cpus 或 priority 的下游节点
+ *   使用绑定后的专用线程，不进入共享线程池
+ * - parallelFanOutMin：一个 Source Pad 挂多个同步直连下游时，各下游回调在工作线程并行执行
+ * - 调度类别（NodePlacement::schedClass）：关键下游节点在数据到达时以“到达时间 + deadline”为绝对截止时间进入
+ *   EDF 队列，由预留实时线程执行，CPU 被编码、日志等尽力而为节点占满时时延仍有界；关键节点每次 process()
+ *   完成晚于截止时间计一次 NodeMetrics::deadlineMisses（Source 以周期起点为到达时间）
+ * - pause()：Source 线程与工作线程原地休眠（不退出、不 join），期间到达的数据在 resume() 后处理
+ * - 异步节点（AsyncNode）：不调用 process()，由一个共享的事件循环线程（AsyncLoop）驱动其回调 / 协程，
+ *   输入 Pad 的数据经 AsyncContext 交给节点；不受 pause() 影响
+ *
+ * 注意：直连（非队列）连接的数据回调仍在生产者线程同步执行，节点需自行保证回调与 process() 之间的数据交接安全。
+ */
+class PipelineScheduler {
+public:
+    explicit PipelineScheduler(const PipelineSchedulerConfig& cfg = {});
+    ~PipelineScheduler();
+
+    PipelineScheduler(const PipelineScheduler&) = delete;
+    PipelineScheduler& operator=(const PipelineScheduler&) = delete;
+
+    void setConfig(const PipelineSchedulerConfig& cfg) { config_ = cfg; }
+    const PipelineSchedulerConfig& config() const noexcept { return config_; }
+
+    // 覆盖某个 Source 节点的调度周期（需在 start() 前设置）
+    void setNodePeriod(const std::string& nodeId, std::chrono::microseconds period);
+
+    /**
+     * 启动调度
+     * @param orderedNodes 按拓扑序排列的节点
+     * @param isSource 与 orderedNodes 一一对应，true 表示该节点无上游连接
+     */
+    bool start(const std::vector<std::shared_ptr<Node>>& orderedNodes,
+               const std::vector<bool>& isSource);
+    void stop();
+    // 运行中（含已暂停）
+    bool isRunning() const noexcept { return running_.load(); }
+
+    // 暂停调度：不再调用 process()，返回前等待正在执行的 process() 完成（至多 timeout，超时返回 false 但保持暂停）
+    bool pause(std::chrono::milliseconds timeout = std::chrono::milliseconds(2000));
+    // 恢复调度：唤醒休眠线程并补调度暂停期间积压了数据的节点
+    void resume();
+    bool isPaused() const noexcept { return paused_.load(); }
+
+    // 请求在该节点的调度上下文中（本次 process() 之后）调用一次 BranchIdleSink::releaseIdleBuffers()；
+    // 可在任意线程调用（与 start()/stop() 之间由调用方保证先后）；未运行、未知节点、Source 节点或
+    // 节点未实现 BranchIdleSink 时忽略
+    void requestIdleRelease(const std::string& nodeId);
+
+    // 手动步进（PipelineSchedulerConfig::manual）：执行 nowNs 时已到期的 Source，再依次执行因此收到数据的下游节点
+    // 直至没有待处理数据；返回本次的 process() 次数。须在同一线程调用，未运行、已暂停或非手动模式时返回 0
+    std::size_t runOnce(std::int64_t nowNs);
+    // 手动步进：最早的 Source 到期时刻（周期为 0 的 Source 总是到期）；没有可到期的 Source 时返回 TimedSource::kNever
+    std::int64_t nextSourceDueNs() const;
+    // 手动步进：存在 TimedSource 且全部已无数据
+    bool timedSourcesFinished() const;
+
+    // 存在异步节点时的事件循环（其余时候为 nullptr）
+    AsyncLoop* asyncLoop() const noexcept { return asyncLoop_.get(); }
+
+    // 指定节点 process() 已被调度执行的次数（未知节点返回 0）
+    std::uint64_t processCount(const std::string& nodeId) const;
+    // 指定节点的 process() 次数、耗时分位数与入站队列积压（自最近一次 start() 起累计）；未知节点返回 false
+    bool nodeMetrics(const std::string& nodeId, NodeMetrics& out) const;
+    // 采样节点运行状态并重新开始 windowMaxNs 的统计窗口；未知节点返回 false
+    bool takeActivity(const std::string& nodeId, NodeActivity& out);
+    // 降频：下游节点每 divisor 次调度只执行一次 process()，其余次只取走入站队列数据（丢弃）；
+    // 1 为不降频。可在运行中任意线程调用；未知节点或 Source 节点返回 false
+    bool setRateDivisor(const std::string& nodeId, std::uint32_t divisor);
+    std::uint32_t rateDivisor(const std::string& nodeId) const;
+
+private:
+    struct Entry {
+        std::shared_ptr<Node> node;
+        const char* traceName{nullptr};  // 节点 id（Tracer::intern），process() 区间名
+        std::vector<std::shared_ptr<Pad>> inputs;  // Sink/Both Pad
+        bool isSource{false};
+        std::chrono::microseconds period{0};
+        BranchIdleSink* idleSink{nullptr};
+        std::atomic<bool> idleRequested{false};
+        AsyncNode* async{nullptr};  // 非空时由事件循环驱动
+        TimedSource* timed{nullptr};  // 手动步进时按其到期时刻调度
+        std::int64_t nextDueNs{0};    // 手动步进：周期性 Source 的下次到期时刻（0 为立即）
+        std::unique_ptr<AsyncContext> asyncContext;
+        // 0: 空闲, 1: 已排队/执行中, 2: 执行中且有新数据到达（需补调度）
+        std::atomic<int> state{0};
+        std::atomic<std::uint64_t> processCount{0};
+        LatencyHistogram latency;  // process() 墙钟耗时（含入站队列投递）
+        std::atomic<std::uint64_t> cpuNs{0};  // process() 累计线程 CPU 时间（cpuAccounting 开启时）
+        // process() 累计性能计数（perfCounters 开启时），下标为 PerfCounter；perfAvailable 为各执行线程可用事件的并集
+        std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(PerfCounter::Count)> perf{};
+        std::atomic<std::uint32_t> perfAvailable{0};
+        std::atomic<std::int64_t> processStartNs{0};  // 执行中的 process() 开始时间（steady_clock），空闲为 0
+        std::atomic<std::uint64_t> windowMaxNs{0};
+        std::atomic<std::uint32_t> rateDivisor{1};
+        std::uint32_t skipped{0};  // 降频计数（仅执行该节点的线程访问）
+        // 设置了线程级放置提示（NodePlacement::pinsThread）的下游节点使用专用线程
+        bool dedicated{false};
+        // 关键节点：edf 表示由预留线程按截止时间执行；deadlineNs 为相对截止时间（0 为不检查）
+        bool critical{false};
+        bool edf{false};
+        std::int64_t deadlineNs{0};
+        std::atomic<std::int64_t> releaseNs{0};      // 本次执行对应数据的到达时间（steady_clock）
+        std::atomic<std::int64_t> nextReleaseNs{0};  // 执行期间首个新数据的到达时间（补调度时使用）
+        std::atomic<std::uint64_t> deadlineMisses{0};
+        std::atomic<std::int64_t> maxLatenessNs{0};
+        std::mutex wakeMutex;
+        std::condition_variable wakeCv;
+        bool wakeup{false};
+    };
+
+    void notify(std::size_t index);
+    void runNode(Entry& entry);  // 调用方须先登记 busy_，返回前注销
+    void leaveProcess();
+    static bool hasQueuedInput(const Entry& entry);
+    void sourceLoop(std::size_t index);
+    void workerLoop(NodePlacement placement);
+    void dedicatedLoop(std::size_t index);
+    void criticalLoop();
+    // 关键节点的线程放置：未自设 priority 时使用 criticalPriority
+    NodePlacement threadPlacement(const Entry& entry) const;
+    void pushEdf(std::size_t index);  // 以 releaseNs + deadlineNs 入 EDF 队列
+    void recordDeadline(Entry& entry);
+    void releaseNext(Entry& entry);   // 补调度前更新 releaseNs
+    void wakeDedicated();
+    // 执行已出队的节点直至无待处理数据；registered 表示调用方已登记本次 busy_
+    void runScheduled(std::size_t index, bool registered);
+    void installArrivalHooks(bool install);
+    void installFanOut(bool install);
+    void stopAsync();
+
+    // 并行投递任务：推送线程与空闲工作线程按下标认领，推送线程等待全部完成
+    struct FanOutJob {
+        std::size_t count{0};
+        const std::function<void(std::size_t)>* task{nullptr};
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    void runFanOut(std::size_t count, const std::function<void(std::size_t)>& task);
+    static void helpFanOut(FanOutJob& job);
+
+    PipelineSchedulerConfig config_;
+    std::unordered_map<std::string, std::chrono::microseconds> nodePeriods_;
+
+    std::vector<std::unique_ptr<Entry>> entries_;
+    std::unordered_map<std::string, std::size_t> indexById_;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> paused_{false};
+    std::atomic<int> busy_{0};  // 正在执行的 process() 数
+    std::mutex idleMutex_;
+    std::condition_variable idleCv_;
+    std::mutex queueMutex_;
+    std::condition_variable queueCv_;
+    std::deque<std::size_t> readyQueue_;
+    std::deque<std::shared_ptr<FanOutJob>> fanOutQueue_;  // 受 queueMutex_ 保护，优先于 readyQueue_
+    struct EdfItem {
+        std::int64_t deadlineNs{0};
+        std::uint64_t seq{0};  // 截止时间相同时先到先执行
+        std::size_t index{0};
+        bool operator>(const EdfItem& other) const noexcept {
+            return deadlineNs != other.deadlineNs ? deadlineNs > other.deadlineNs : seq > other.seq;
+        }
+    };
+    std::vector<EdfItem> edfQueue_;  // 受 queueMutex_ 保护，按绝对截止时间的小顶堆
+    std::uint64_t edfSeq_{0};
+    std::condition_variable criticalCv_;
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+
+    std::vector<std::thread> sourceThreads_;
+    std::vector<std::thread> workerThreads_;
+    std::vector<std::thread> dedicatedThreads_;
+    std::vector<std::thread> criticalThreads_;
+    std::unique_ptr<AsyncLoop> asyncLoop_;
+};
+
+} // namespace falconmind::sdk::core
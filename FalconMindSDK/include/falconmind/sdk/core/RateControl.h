@@ -0,0 +1,60 @@
+// FalconMindSDK - 源速率自适应：慢消费者经连接反馈上游降低采集帧率
+#pragma once
+
+#include "falconmind/sdk/core/Pad.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace falconmind::sdk::core {
+
+/**
+ * RateAdaptable - 可按下游请求降低输出帧率的源节点（如 CameraSourceNode）实现此接口
+ */
+class RateAdaptable {
+public:
+    virtual ~RateAdaptable() = default;
+    /**
+     * requester 标识发起请求的连接；fps <= 0 表示撤销该连接的限制。
+     * 多个请求时源取其中最大值，保证最快的消费者不被限速。可能在源自身的推送线程内调用。
+     */
+    virtual void requestMaxFrameRate(const std::string& requester, double fps) = 0;
+};
+
+/**
+ * LinkRateController - AdaptSourceRate 连接的速率控制器（由生产者线程在每次推送后驱动，无锁）
+ *
+ * 每个统计窗口比较入队/出队/丢弃计数：出现丢帧时把上游帧率压到消费速率的 1.1 倍（不低于 minFps）；
+ * 连续若干窗口无丢帧则逐步放宽 25%，超过限速前观测到的输入帧率后撤销限制。
+ */
+class LinkRateController {
+public:
+    using Feedback = std::function<void(double fps)>;
+
+    explicit LinkRateController(double minFps);
+
+    void setFeedback(Feedback feedback) { feedback_ = std::move(feedback); }
+    // 生产者线程在推送到该连接后调用
+    void onPush(const LinkQueue& queue, std::int64_t nowNs);
+    // 撤销限制（断开连接时调用）
+    void release();
+    // 当前反馈的帧率上限（0 为不限），可在其它线程读取
+    double limitFps() const noexcept { return limit_.load(std::memory_order_relaxed); }
+
+private:
+    void apply(double fps);
+
+    double minFps_;
+    Feedback feedback_;
+    std::atomic<double> limit_{0.0};
+    std::int64_t windowStartNs_{0};
+    std::uint64_t lastPushed_{0};
+    std::uint64_t lastPopped_{0};
+    std::uint64_t lastDropped_{0};
+    double peakInputFps_{0.0};  // 限速前观测到的输入帧率
+    int calmWindows_{0};
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,63 @@
+// FalconMindSDK - 无头回放运行：以虚拟时钟手动步进 Pipeline / Flow，录制数据不等待地以远快于实时的速度回放
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace falconmind::sdk::core {
+
+class FlowExecutor;
+class Pipeline;
+class PipelineScheduler;
+
+struct ReplayRunnerConfig {
+    std::int64_t startNs{0};          // 虚拟时钟起点；0 为当前系统时钟（与其他进程的时间戳同量级）
+    std::int64_t maxDurationNs{0};    // 虚拟时长上限；0 为直到全部 TimedSource 结束（没有 TimedSource 时直到 requestStop()）
+    std::int64_t pollNs{10'000'000};  // 周期为 0（连续调度）的 Source 在虚拟时间中的调用间隔
+};
+
+struct ReplayRunStats {
+    std::uint64_t steps{0};          // runOnce 次数（虚拟时钟推进次数 + 1）
+    std::uint64_t processCalls{0};   // 全部节点的 process() 次数
+    std::int64_t virtualNs{0};       // 虚拟时钟走过的时长
+    std::int64_t wallNs{0};          // 实际耗时
+    bool started{false};             // Pipeline / Flow 启动成功
+    bool completed{false};           // TimedSource 全部回放完毕（false 为达到 maxDurationNs 或 requestStop()）
+
+    double speedup() const noexcept {
+        return wallNs > 0 ? static_cast<double>(virtualNs) / static_cast<double>(wallNs) : 0.0;
+    }
+};
+
+/**
+ * ReplayRunner - 地面侧仿真 / 回归用的无头运行模式
+ *
+ * 调度器切换为手动步进（PipelineSchedulerConfig::manual），不创建任何调度线程；PipelineClock 切换为虚拟时钟。
+ * 每一步在调用线程中执行已到期的 Source 与其全部下游节点，然后把虚拟时钟直接跳到下一个 Source 到期时刻
+ *（TimedSource 如 ReplaySourceNode 的下一条记录，或周期性 Source 的下个周期），中间不睡眠：
+ * 节点看到的时间戳、周期与时延统计与按原速实时运行一致，墙钟耗时只取决于处理本身。
+ * 同一份录制在多个进程中各跑一个实例（虚拟时钟为进程内全局），即可在服务器多核上产生多机真实负载。
+ *
+ * 限制：直接读取 steady_clock / system_clock 的节点、异步节点（AsyncLoop 的定时器）与看门狗仍按墙钟运行。
+ */
+class ReplayRunner {
+public:
+    explicit ReplayRunner(ReplayRunnerConfig config = {});
+
+    // Pipeline 须未进入 Playing（或已按手动步进进入）：进入 Playing、步进到结束后回到 Ready
+    ReplayRunStats run(Pipeline& pipeline);
+    // Flow 须未启动：以手动步进的调度器配置 start()，步进到结束后 stop()
+    ReplayRunStats run(FlowExecutor& flow);
+
+    // 可在其他线程调用：当前步结束后 run() 返回
+    void requestStop() noexcept { stopRequested_.store(true, std::memory_order_relaxed); }
+    const ReplayRunnerConfig& config() const noexcept { return config_; }
+
+private:
+    void step(PipelineScheduler& scheduler, ReplayRunStats& stats);
+
+    ReplayRunnerConfig config_;
+    std::atomic<bool> stopRequested_{false};
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,57 @@
+// FalconMindSDK - SelectorNode：把输入数据流只转发到选中的一路输出（零拷贝），其余分支收不到数据
+#pragma once
+
+#include "falconmind/sdk/core/BranchSwitch.h"
+#include "falconmind/sdk/core/Node.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+/**
+ * SelectorNode - Sink Pad "in" 收到的缓冲只经当前选中的 Source Pad "out_<i>" 推送，-1 表示全部截断；
+ * 用于按任务阶段在几条互斥的感知分支间切换（如白天可见光检测 / 夜间热红外检测）。
+ * select() 可在任意线程调用；也可设置路由函数（如读取任务黑板，见 mission/BranchRouting.h），
+ * 每个缓冲到达时求值并覆盖 select() 的选择。被切走的输出通知 BranchSwitch 回调，其下游分支释放缓冲。
+ * 参数：outputs（输出数，默认 2，只能增加，须在建立连接前设置）、active（默认 0，none 或 -1 为全部截断）
+ */
+class SelectorNode : public Node, public BranchSwitch {
+public:
+    using Route = std::function<int()>;
+
+    explicit SelectorNode(std::size_t outputs = 2);
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+
+    // 超出输出数的下标视为 -1
+    void select(int index);
+    int selected() const noexcept { return selected_.load(std::memory_order_acquire); }
+    // 须在 Pipeline 进入 Playing 之前设置；路由函数在推送线程执行，应只做无锁读取
+    void setRoute(Route route) { route_ = std::move(route); }
+
+    std::size_t outputCount() const noexcept { return outputs_.size(); }
+    static std::string outputPadName(std::size_t index) { return "out_" + std::to_string(index); }
+
+    std::uint64_t passed() const noexcept { return passed_.load(std::memory_order_relaxed); }
+    std::uint64_t blocked() const noexcept { return blocked_.load(std::memory_order_relaxed); }
+
+private:
+    void addOutputs(std::size_t count);
+    int clampIndex(int index) const noexcept;
+    void switchFlowing(int index);
+
+    std::vector<Pad*> outputs_;
+    std::atomic<int> selected_{0};
+    std::atomic<int> flowing_{-1};  // 最近一次放行的输出（用于识别被切走的分支）
+    Route route_;
+    std::atomic<std::uint64_t> passed_{0};
+    std::atomic<std::uint64_t> blocked_{0};
+};
+
+} // namespace falconmind::sdk::core
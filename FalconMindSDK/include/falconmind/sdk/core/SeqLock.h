@@ -0,0 +1,132 @@
+// FalconMindSDK - 单写多读顺序锁（seqlock）：读者无锁、永不读到撕裂的值
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace falconmind::sdk::core {
+
+/**
+ * SeqLock<T> - 保存一个可平凡复制的 T，单线程写、任意线程读
+ *
+ * 写者先把序号置为奇数，写入数据后再置为下一个偶数；读者读取前后序号一致且为偶数时数据有效，
+ * 否则重试。数据按 64 位字存放在 std::atomic 中（relaxed 访问 + fence），读写均无数据竞争，
+ * 对象本身无锁、无指针，可直接放在进程间共享内存中。
+ * 写入期间读者自旋，写入只是几次内存写，重试通常在数十纳秒内结束。
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable type");
+
+public:
+    static constexpr std::size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    SeqLock() noexcept {
+        for (auto& w : words_) w.store(0, std::memory_order_relaxed);
+    }
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // 仅允许单一写者
+    void store(const T& value) noexcept {
+        std::uint64_t buf[kWords] = {};
+        std::memcpy(buf, &value, sizeof(T));
+        const std::uint64_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i) words_[i].store(buf[i], std::memory_order_relaxed);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    // 一次读取尝试：写入进行中或读取期间被改写时返回 false
+    bool tryLoad(T& out) const noexcept {
+        const std::uint64_t s0 = seq_.load(std::memory_order_acquire);
+        if (s0 & 1u) return false;
+        std::uint64_t buf[kWords];
+        for (std::size_t i = 0; i < kWords; ++i) buf[i] = words_[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) != s0) return false;
+        std::memcpy(&out, buf, sizeof(T));
+        return true;
+    }
+
+    T load() const noexcept {
+        T v;
+        while (!tryLoad(v)) {
+        }
+        return v;
+    }
+
+    // 已完成的写入次数（0 表示从未写入），可用于判断是否有新值
+    std::uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    std::atomic<std::uint64_t> seq_{0};
+    std::atomic<std::uint64_t> words_[kWords];
+};
+
+/**
+ * SeqLockRing<T> - 由 SeqLock<T> 槽位组成的定容量环（单写多读），不持有存储
+ *
+ * 槽位数组与 head 计数由调用方提供（堆上或共享内存中），容量须为 2 的幂。
+ * 写者先写完槽位再推进 head；读者读取期间槽位可能被绕圈覆盖，recent() 丢弃由此产生的乱序条目，
+ * 按 key（如时间戳）升序输出。
+ */
+template <typename T>
+class SeqLockRing {
+public:
+    SeqLockRing() = default;
+    SeqLockRing(SeqLock<T>* slots, std::atomic<std::uint64_t>* head, std::size_t capacity) noexcept
+        : slots_(slots), head_(head), mask_(capacity - 1) {}
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+    // 累计写入条数
+    std::uint64_t count() const noexcept { return head_->load(std::memory_order_acquire); }
+
+    // 仅允许单一写者
+    void push(const T& value) noexcept {
+        const std::uint64_t h = head_->load(std::memory_order_relaxed);
+        slots_[h & mask_].store(value);
+        head_->store(h + 1, std::memory_order_release);
+    }
+
+    bool latest(T& out) const noexcept {
+        for (;;) {
+            const std::uint64_t h = head_->load(std::memory_order_acquire);
+            if (h == 0) return false;
+            if (slots_[(h - 1) & mask_].tryLoad(out)) return true;
+        }
+    }
+
+    // 倒数第 back 条（0 为最新）；不存在或正被改写时返回 false
+    bool at(std::uint64_t head, std::size_t back, T& out) const noexcept {
+        if (back >= mask_ || back >= head) return false;
+        return slots_[(head - 1 - back) & mask_].tryLoad(out);
+    }
+
+    // 最多 maxCount 条最近的条目按 key 升序写入 out，返回条数；留一个槽位余量给正在写入的下一条
+    template <typename KeyFn>
+    std::size_t recent(T* out, std::size_t maxCount, KeyFn key) const noexcept {
+        const std::uint64_t h = head_->load(std::memory_order_acquire);
+        std::uint64_t n = h < mask_ ? h : mask_;
+        if (n > maxCount) n = maxCount;
+        std::size_t written = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            T v;
+            if (!slots_[(h - n + i) & mask_].tryLoad(v)) continue;
+            while (written > 0 && !(key(out[written - 1]) < key(v))) --written;
+            out[written++] = v;
+        }
+        return written;
+    }
+
+private:
+    SeqLock<T>* slots_{nullptr};
+    std::atomic<std::uint64_t>* head_{nullptr};
+    std::size_t mask_{0};
+};
+
+} // namespace falconmind::sdk::core
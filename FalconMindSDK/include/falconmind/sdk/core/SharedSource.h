@@ -0,0 +1,102 @@
+// FalconMindSDK - 进程内多 Flow 共享设备源节点（按设备去重、引用计数，单次打开设备）
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/Node.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+/**
+ * SharableSource - 打开独占设备的源节点实现此接口后可在多个 Flow 间共享
+ * deviceKey() 在 configure 之后调用：相同键表示同一设备且配置相同（由实现把尺寸、帧率、格式等计入键），
+ * 空串表示不共享（如无设备的测试图案）。配置不同的同一设备不会共享，第二次打开可能照常失败
+ */
+class SharableSource {
+public:
+    virtual ~SharableSource() = default;
+    virtual std::string deviceKey() const = 0;
+};
+
+class SharedSourceHub;
+
+/**
+ * SharedSourceNode - 共享源在某个 Flow 中的代理：Source Pad 与被共享节点同名、声明相同的 caps
+ *
+ * - start()：登记到共享源；第一个启动的代理按自身协商结果设置设备输出格式并启动设备，之后的代理协商
+ *   出的格式须与之一致（否则启动失败，应在 Flow 中经转换节点取用）
+ * - stop()：注销；最后一个代理停止时关闭设备
+ * - process()：等待至多 wait 取出共享源推来的帧，在本 Flow 的调度线程上零拷贝推送
+ * 每个代理至多缓存 queueDepth 帧，满时丢弃最旧的帧（某个 Flow 处理慢不影响其余 Flow）。
+ * 不转发下游的降速请求（RateAdaptable），配置与热更新重配参数不适用（configure 返回 false）
+ */
+class SharedSourceNode : public Node {
+public:
+    SharedSourceNode(std::shared_ptr<SharedSourceHub> hub, const std::string& id);
+    ~SharedSourceNode() override;
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void stop() override;
+    void process() override;
+
+    const std::string& deviceKey() const noexcept;
+    // 被共享的原始节点
+    const std::shared_ptr<Node>& source() const noexcept;
+    // 因本代理队列满而丢弃的帧数
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    void setWait(std::chrono::milliseconds wait) { wait_ = wait; }
+    void setQueueDepth(std::size_t depth) { queueDepth_ = depth > 0 ? depth : 1; }
+
+private:
+    friend class SharedSourceHub;
+    // 共享源的推送线程调用
+    void offer(std::size_t padIndex, const BufferRef& buffer);
+
+    std::shared_ptr<SharedSourceHub> hub_;
+    std::vector<Pad*> outPads_;  // 与被共享节点的 Source Pad 一一对应
+    std::chrono::milliseconds wait_{20};
+    std::size_t queueDepth_{2};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::pair<std::size_t, BufferRef>> queue_;
+    std::atomic<std::uint64_t> dropped_{0};
+    bool attached_{false};
+};
+
+/**
+ * SharedSourceRegistry - 按 SharableSource::deviceKey 去重的进程级共享源表
+ * share(node)：node 可共享时返回一个代理（键已存在时丢弃 node、复用已有设备；否则 node 成为该设备的实际节点），
+ * 不可共享时返回 nullptr。全部代理析构后设备从表中移除
+ */
+class SharedSourceRegistry {
+public:
+    static SharedSourceRegistry& instance();
+
+    std::shared_ptr<SharedSourceNode> share(const std::shared_ptr<Node>& node);
+
+    // 当前登记的设备数 / 指定设备上已启动的代理数（未登记返回 0）
+    std::size_t deviceCount() const;
+    std::size_t activeUsers(const std::string& deviceKey) const;
+
+private:
+    SharedSourceRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::weak_ptr<SharedSourceHub>> hubs_;
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,112 @@
+// FalconMindSDK - 跨进程共享内存连接（POSIX shm 环形槽位 + futex 通知），用于把 Pipeline 切分到多个进程/容器
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/Node.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace falconmind::sdk::core {
+
+struct ShmChannelConfig {
+    std::string name;                       // 通道名（对应 /dev/shm/<name>，不含 '/'）
+    std::uint32_t slotCount{4};             // 槽位数
+    std::size_t slotSize{4 * 1024 * 1024};  // 单帧最大字节数，超出的帧被丢弃
+};
+
+/**
+ * ShmChannel - 单生产者/单消费者的共享内存帧通道
+ *
+ * - 生产者 create() 创建并在析构时删除共享内存；消费者 open() 映射已有通道。两端可在不同进程/容器中，
+ *   容器间需共享 /dev/shm（如 docker --ipc=shareable / --ipc=container:<name>）
+ * - write() 把帧拷贝进下一个空闲槽位（唯一一次拷贝）；槽位未被消费或仍被读端持有时丢弃新帧并计数
+ * - read() 返回直接指向共享内存槽位的 BufferRef（零拷贝），最后一个引用释放时槽位归还给生产者
+ * - 通知使用共享内存中的 futex 字，不需要在进程间传递文件描述符；无读端等待时 write() 不发起系统调用
+ */
+class ShmChannel {
+public:
+    ~ShmChannel();
+    ShmChannel(const ShmChannel&) = delete;
+    ShmChannel& operator=(const ShmChannel&) = delete;
+
+    // 生产者：同名的残留通道会被替换；失败返回 nullptr
+    static std::shared_ptr<ShmChannel> create(const ShmChannelConfig& config);
+    // 消费者：通道不存在或格式不符时返回 nullptr（可稍后重试）
+    static std::shared_ptr<ShmChannel> open(const std::string& name);
+
+    bool write(const void* data, std::size_t size, const BufferMeta& meta = BufferMeta{});
+    bool write(const BufferRef& buffer) { return write(buffer.data(), buffer.size(), buffer.meta()); }
+    // 等待至多 timeout 取一帧；超时或通道已关闭时返回空 BufferRef
+    BufferRef read(std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+    // 生产者已关闭通道（消费者应重新 open）
+    bool closed() const noexcept;
+
+    const std::string& name() const noexcept { return name_; }
+    bool isProducer() const noexcept { return producer_; }
+    std::uint32_t slotCount() const noexcept;
+    std::size_t slotSize() const noexcept;
+    std::uint64_t written() const noexcept;  // 成功写入的帧数（两端可见）
+    std::uint64_t dropped() const noexcept;  // 生产者丢弃的帧数（两端可见）
+
+    struct Mapping;
+
+private:
+    ShmChannel(std::string name, bool producer, std::shared_ptr<Mapping> mapping);
+
+    std::string name_;
+    bool producer_;
+    std::shared_ptr<Mapping> mapping_;  // 由读出的 BufferRef 共享，通道对象先析构时映射仍有效
+};
+
+/**
+ * ShmSinkNode - 把 Sink Pad "in" 收到的帧写入共享内存通道（start 时创建，stop 时删除）
+ * 参数：channel、slots、slot_size
+ */
+class ShmSinkNode : public Node {
+public:
+    explicit ShmSinkNode(ShmChannelConfig config = {});
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void stop() override;
+
+    const ShmChannelConfig& channelConfig() const noexcept { return config_; }
+    std::uint64_t dropped() const noexcept;
+
+private:
+    ShmChannelConfig config_;
+    std::shared_ptr<ShmChannel> channel_;  // 仅在 start/stop 时替换；写入在投递线程
+};
+
+/**
+ * ShmSourceNode - 从共享内存通道读取帧并经 Source Pad "out" 零拷贝推送
+ * 生产者尚未启动或重启后，process() 自动（重新）打开通道。参数：channel、wait_ms
+ */
+class ShmSourceNode : public Node {
+public:
+    explicit ShmSourceNode(std::string channel = {});
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void stop() override;
+    void process() override;
+
+    const std::string& channelName() const noexcept { return channelName_; }
+    std::uint64_t received() const noexcept { return received_.load(std::memory_order_relaxed); }
+
+private:
+    Pad* outPad_{nullptr};
+    std::string channelName_;
+    std::chrono::milliseconds wait_{0};  // 每次 process() 等待新帧的时长
+    std::shared_ptr<ShmChannel> channel_;
+    std::atomic<std::uint64_t> received_{0};
+    bool started_{false};
+};
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,172 @@
+// FalconMindSDK - 崩溃安全的状态检查点：mmap 文件中的双槽、按版本区分布局的区段，进程重启后热恢复跟踪与任务状态
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+
+namespace falconmind::sdk::core {
+
+// 检查点负载的序列化：定长字段按本机字节序写入（检查点只在本机写入和读取）
+class CheckpointWriter {
+public:
+    template <typename T>
+    void pod(const T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "pod only");
+        buf_.append(reinterpret_cast<const char*>(&v), sizeof(v));
+    }
+    void str(const std::string& s) {
+        pod(static_cast<std::uint32_t>(s.size()));
+        buf_.append(s);
+    }
+    void bytes(const void* data, std::size_t size) { buf_.append(static_cast<const char*>(data), size); }
+    void clear() { buf_.clear(); }
+    const std::string& buffer() const noexcept { return buf_; }
+
+private:
+    std::string buf_;
+};
+
+class CheckpointReader {
+public:
+    CheckpointReader(const char* data, std::size_t size) : p_(data), end_(data + size) {}
+
+    template <typename T>
+    bool pod(T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "pod only");
+        return bytes(&v, sizeof(T));
+    }
+    bool str(std::string& s) {
+        std::uint32_t n = 0;
+        if (!pod(n) || remaining() < n) return false;
+        s.assign(p_, n);
+        p_ += n;
+        return true;
+    }
+    bool bytes(void* out, std::size_t size) {
+        if (remaining() < size) return false;
+        std::memcpy(out, p_, size);
+        p_ += size;
+        return true;
+    }
+    std::size_t remaining() const noexcept { return static_cast<std::size_t>(end_ - p_); }
+    bool done() const noexcept { return p_ == end_; }
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+/**
+ * CheckpointRegion - 一个区段文件的 mmap 映射（MAP_SHARED）
+ *
+ * 布局：文件头（magic、容器格式版本、槽容量）| 槽 0 | 槽 1；每个槽为 {序号, 负载版本, 长度, FNV-1a 校验} + 负载。
+ * write() 写入序号较小的槽，最后以 release 写入新序号作为提交点：进程在任何时刻崩溃，另一个槽仍是完整的上一版。
+ * 写入只是 memcpy 到页缓存，进程退出后内容仍在（目录在 tmpfs 上时重启后丢失，在磁盘上时可设置 sync 经 msync 落盘）。
+ * 负载超出槽容量时写成新文件（容量翻倍）后 rename 替换。read() 取序号最大、校验通过且负载版本相符的槽。
+ * 非线程安全。
+ */
+class CheckpointRegion {
+public:
+    ~CheckpointRegion();
+    CheckpointRegion(const CheckpointRegion&) = delete;
+    CheckpointRegion& operator=(const CheckpointRegion&) = delete;
+
+    // 打开（不存在或格式不符时新建）区段文件；失败返回 nullptr
+    static std::unique_ptr<CheckpointRegion> open(const std::string& path, std::size_t initialCapacity = 4096);
+
+    bool write(std::uint32_t version, const char* data, std::size_t size, bool sync = false);
+    // 最新的有效负载；没有版本为 version 的有效槽时返回 false
+    bool read(std::uint32_t version, std::string& out) const;
+
+    const std::string& path() const noexcept { return path_; }
+    std::size_t capacity() const noexcept;
+    // 最近一次提交的序号（0 为从未写入）
+    std::uint64_t sequence() const noexcept;
+
+    struct Mapping;
+
+private:
+    CheckpointRegion(std::string path, std::unique_ptr<Mapping> mapping);
+    bool grow(std::size_t size);
+
+    std::string path_;
+    std::unique_ptr<Mapping> mapping_;
+};
+
+struct StateCheckpointConfig {
+    std::string directory{"/dev/shm/falconmind_checkpoint"};  // 区段文件目录；断电后也要恢复时放到磁盘上并设置 sync
+    int periodMs{250};   // 同一区段两次写入的最小间隔
+    bool sync{false};    // 每次写入后 msync
+};
+
+/**
+ * CheckpointSection - 一个组件状态的检查点（<directory>/<name>.ckpt）
+ *
+ * 由状态所属的线程调用：save() 距上次写入不足 periodMs 时直接返回；否则序列化，内容与上次写入相同
+ * （FNV-1a 指纹）时跳过，只有变化的区段才写入（增量）。restore() 读取与 version 相符的最新负载交给回调；
+ * 负载布局变化时递增 version，旧检查点被忽略而不是按错误布局解析。
+ */
+class CheckpointSection {
+public:
+    using SaveFn = std::function<void(CheckpointWriter&)>;
+    using RestoreFn = std::function<bool(CheckpointReader&)>;
+
+    CheckpointSection(std::unique_ptr<CheckpointRegion> region, std::string name, std::uint32_t version,
+                      int periodMs, bool sync);
+
+    // nowNs 为单调时钟；force 忽略 periodMs。返回是否写入
+    bool save(std::int64_t nowNs, const SaveFn& fn, bool force = false);
+    // 有可用检查点且回调返回 true 时返回 true
+    bool restore(const RestoreFn& fn);
+
+    const std::string& name() const noexcept { return name_; }
+    std::uint32_t version() const noexcept { return version_; }
+    const CheckpointRegion& region() const noexcept { return *region_; }
+    std::uint64_t writes() const noexcept { return writes_; }
+    std::uint64_t unchangedSkips() const noexcept { return unchanged_; }
+    std::uint64_t bytesWritten() const noexcept { return bytes_; }
+
+private:
+    std::unique_ptr<CheckpointRegion> region_;
+    std::string name_;
+    std::uint32_t version_;
+    std::int64_t periodNs_;
+    bool sync_;
+    std::mutex mutex_;
+    CheckpointWriter writer_;
+    std::int64_t lastSaveNs_{0};
+    bool saved_{false};
+    std::uint64_t lastHash_{0};
+    std::uint64_t writes_{0};
+    std::uint64_t unchanged_{0};
+    std::uint64_t bytes_{0};
+};
+
+/**
+ * StateCheckpointer - 检查点目录：按名称创建区段，任务正常结束时 discard() 删除全部区段
+ *
+ * 热重启流程：重建 Flow 后先对各组件调用 restore（SortTrackerBackend 轨迹、SearchMissionAction 任务进度与覆盖位图），
+ * 再开始处理；恢复只是读取 mmap 页，与状态大小成正比，不涉及重新搜索或重新编号轨迹。
+ */
+class StateCheckpointer {
+public:
+    explicit StateCheckpointer(StateCheckpointConfig config = {});
+
+    // name 只能含字母、数字、'_'、'-'、'.'；目录不可写时返回 nullptr
+    std::shared_ptr<CheckpointSection> section(const std::string& name, std::uint32_t version);
+    // 删除目录中的全部区段文件
+    void discard();
+
+    const StateCheckpointConfig& config() const noexcept { return config_; }
+
+private:
+    StateCheckpointConfig config_;
+};
+
+} // namespace falconmind::sdk::core
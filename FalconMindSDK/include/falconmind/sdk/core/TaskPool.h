@@ -0,0 +1,139 @@
+// FalconMindSDK - TaskPool：SDK 内计算内核共享的工作窃取任务池（每线程双端队列、优先级、parallelFor）
+#pragma once
+
+#include "falconmind/sdk/core/NodePlacement.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+enum class TaskPriority : std::uint8_t {
+    High = 0,  // 时延敏感的内核（避障检测的前后处理等）
+    Normal,
+    Low,       // 后台批量工作（地图累积、日志压缩等）
+};
+
+struct TaskPoolConfig {
+    // 工作线程数；0 为 defaultThreads()。提交任务的线程在等待时也会执行任务，因此并行度为 threads + 1
+    std::size_t threads{0};
+    // 工作线程的放置（如只用 RK3588 大核 4-7；priority 通常保持 0，实时节点另有专用线程）
+    NodePlacement placement;
+};
+
+struct TaskPoolStats {
+    std::uint64_t submitted{0};
+    std::uint64_t executed{0};
+    std::uint64_t stolen{0};   // 从其它工作线程队列窃取执行的任务数
+    std::uint64_t helped{0};   // 等待方（TaskGroup::wait）代为执行的任务数
+};
+
+/**
+ * TaskPool - 工作窃取任务池
+ *
+ * 每个工作线程按优先级各有一个双端队列：本线程提交的任务压入自己队列尾部并从尾部取（LIFO，缓存友好），
+ * 空闲线程从其它线程队列头部窃取；非工作线程提交的任务进入共享注入队列。取任务时总是先看高优先级：
+ * 本线程队列 → 注入队列 → 其它线程队列，依次到低优先级。
+ *
+ * 进程内的计算内核（WorkerGroup、parallelFor）默认共用 shared()，不再各自常驻线程，8 核板上总线程数受控；
+ * 调度器工作线程调用 parallelFor 时自身也执行分块，等待期间不空占核心。
+ */
+class TaskPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit TaskPool(const TaskPoolConfig& config = {});
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /**
+     * 进程共享的任务池，首次调用时创建：线程数取 configureShared() 的设置，其次为环境变量
+     * FALCONMIND_TASK_THREADS，否则 defaultThreads()
+     */
+    static TaskPool& shared();
+    // 须在首次 shared() 之前调用（如 NodeAgent 按板型配置）；之后调用返回 false
+    static bool configureShared(const TaskPoolConfig& config);
+    // 硬件线程数 - 1（提交线程参与执行），至少 1
+    static std::size_t defaultThreads();
+
+    std::size_t threads() const noexcept { return workers_.size(); }
+    std::size_t concurrency() const noexcept { return workers_.size() + 1; }
+
+    void submit(Task task, TaskPriority priority = TaskPriority::Normal);
+    // 在调用线程执行一个待处理任务；没有可执行任务时返回 false
+    bool runOne();
+    // 调用线程是否为本池的工作线程
+    bool inWorker() const noexcept;
+
+    TaskPoolStats stats() const noexcept;
+
+private:
+    static constexpr std::size_t kPriorities = 3;
+    struct Queue;
+    struct Worker;
+
+    void workerLoop(std::size_t index);
+    bool takeTask(std::size_t self, Task& out, bool& stolen);
+
+    TaskPoolConfig config_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::unique_ptr<Queue[]> injected_;  // 长度 kPriorities
+    std::atomic<std::size_t> queued_{0};  // 全部队列中的任务数
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    std::size_t sleeping_{0};  // 受 sleepMutex_ 保护
+    std::atomic<bool> stop_{false};
+    std::atomic<std::uint64_t> submitted_{0};
+    std::atomic<std::uint64_t> executed_{0};
+    std::atomic<std::uint64_t> stolen_{0};
+    std::atomic<std::uint64_t> helped_{0};
+};
+
+/**
+ * TaskGroup - 一组任务的完成等待；wait() 期间调用线程执行池中的任务（可安全嵌套），
+ * 任务抛出的第一个异常在 wait() 中重新抛出。析构时等待全部任务完成
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskPool& pool = TaskPool::shared(), TaskPriority priority = TaskPriority::Normal)
+        : pool_(pool), priority_(priority) {}
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(TaskPool::Task task);
+    void wait();
+
+private:
+    struct State {
+        std::atomic<std::size_t> pending{0};
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+    };
+
+    TaskPool& pool_;
+    TaskPriority priority_;
+    std::shared_ptr<State> state_{std::make_shared<State>()};
+};
+
+/**
+ * parallelFor - 把 [begin, end) 切成至多 grain 个元素的分块，调用 body(chunkBegin, chunkEnd)
+ * 分块由调用线程与至多 concurrency() - 1 个池任务动态认领（负载不均时自动均衡）；只有一块时直接在调用线程执行
+ */
+void parallelFor(std::size_t begin, std::size_t end, std::size_t grain,
+                 const std::function<void(std::size_t, std::size_t)>& body,
+                 TaskPriority priority = TaskPriority::Normal, TaskPool& pool = TaskPool::shared());
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,105 @@
+// FalconMindSDK - 传感器时间同步：把各传感器自身时钟映射到 PipelineClock（CLOCK_MONOTONIC）统一时间轴
+#pragma once
+
+#include "falconmind/sdk/core/PipelineClock.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+struct ClockSyncConfig {
+    std::int64_t bucketNs{1'000'000'000};  // 每个时间桶只保留时延最小的观测
+    std::size_t buckets{16};               // 参与拟合的最近桶数（默认约 16 s 窗口）
+    std::int64_t maxJumpNs{500'000'000};   // 偏离拟合超过该值视为传感器时钟跳变，重新同步
+    double maxDriftPpm{500.};              // 晶振漂移上限，拟合结果超限时截断
+};
+
+struct ClockSyncStats {
+    std::uint64_t samples{0};
+    std::uint64_t resets{0};     // 时钟跳变 / 回退导致的重新同步次数
+    std::int64_t offsetNs{0};    // 当前 host − sensor
+    double driftPpm{0.};         // 传感器时钟相对 host 的频率偏差
+    double jitterNs{0.};         // 观测超出拟合下包络的平均时延（传输 + 调度抖动）
+    bool locked{false};          // 已有两个以上完成的时间桶，漂移估计有效
+};
+
+/**
+ * ClockSync - 单个传感器时钟到 PipelineClock 的在线映射 host = sensor + offset + drift·Δsensor
+ *
+ * 每次观测为（传感器时间戳，到达本机时刻）。到达时刻 = 真实时刻 + 非负的传输/调度时延，
+ * 因此按时间桶取最小时延点，对其下包络做最小二乘，得到偏移与漂移；传输抖动不会进入映射结果。
+ * 输出不晚于到达时刻，且保证严格递增（二者冲突时——仅在刚开始同步、估计尚未收敛时——以递增为准）。
+ * 传感器时钟回退或前跳超过 maxJumpNs 时自动重新同步。
+ * 线程安全；observe 通常由该传感器的采集线程调用，stats/toHost 可在任意线程调用。
+ */
+class ClockSync {
+public:
+    ClockSync() : ClockSync(ClockSyncConfig{}) {}
+    explicit ClockSync(const ClockSyncConfig& config);
+
+    // 记录一次观测并返回 sensorNs 映射到统一时间轴的时刻
+    std::int64_t observe(std::int64_t sensorNs, std::int64_t hostNs = PipelineClock::nowNs());
+    // 按当前估计映射（不更新估计）；尚无观测时返回 0
+    std::int64_t toHost(std::int64_t sensorNs) const;
+    ClockSyncStats stats() const;
+    void reset();
+
+private:
+    struct Bucket {
+        std::int64_t index;
+        double x;  // 相对参考点的传感器时间
+        double y;  // 相对参考点的时延
+    };
+
+    void restartLocked(std::int64_t sensorNs, std::int64_t hostNs);
+    void refitLocked();
+    double predictLocked(double x) const noexcept { return intercept_ + slope_ * x; }
+
+    const ClockSyncConfig config_;
+    mutable std::mutex mutex_;
+    bool hasReference_{false};
+    std::int64_t sensorRef_{0};
+    std::int64_t hostRef_{0};
+    double lastX_{0.};
+    std::int64_t lastOut_{0};
+    std::vector<Bucket> buckets_;  // 环形，容量 config_.buckets
+    std::size_t bucketHead_{0};    // 最新桶的位置
+    double intercept_{0.};
+    double slope_{0.};
+    int lateRun_{0};               // 连续大幅迟到的观测数
+    ClockSyncStats stats_;
+};
+
+using ClockSyncPtr = std::shared_ptr<ClockSync>;
+
+/**
+ * TimeSyncService - 按传感器 ID 管理 ClockSync，采集节点按节点 ID 取用，
+ * 融合/监控侧通过 snapshot() 查看各传感器的偏移、漂移与锁定状态。
+ * 已在 PipelineClock 时基下打戳的来源（V4L2 单调时间戳、流媒体 PTS 映射）无需注册。
+ */
+class TimeSyncService {
+public:
+    static TimeSyncService& instance();
+
+    // 取得（不存在则创建）sensorId 的时钟；创建后 config 不再改变
+    ClockSyncPtr clock(const std::string& sensorId, const ClockSyncConfig& config = {});
+    void remove(const std::string& sensorId);
+    std::vector<std::pair<std::string, ClockSyncStats>> snapshot() const;
+
+private:
+    TimeSyncService() = default;
+    TimeSyncService(const TimeSyncService&) = delete;
+    TimeSyncService& operator=(const TimeSyncService&) = delete;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, ClockSyncPtr> clocks_;
+};
+
+} // namespace falconmind::sdk::core
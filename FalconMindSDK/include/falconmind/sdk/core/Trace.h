@@ -0,0 +1,103 @@
+// FalconMindSDK - Trace：低开销的运行期区间追踪（每线程环形缓冲），导出 Chrome trace / Perfetto JSON
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// 编译期开关（CMake 选项 FALCONMINDSDK_ENABLE_TRACING）：为 0 时 FM_TRACE_* 不生成任何代码
+#ifndef FALCONMIND_TRACING
+#define FALCONMIND_TRACING 1
+#endif
+
+namespace falconmind::sdk::core {
+
+struct TraceStats {
+    std::size_t threads{0};        // 已登记缓冲的线程数（含已退出、尚未 clear() 的线程）
+    std::uint64_t recorded{0};     // 累计写入的事件数
+    std::uint64_t overwritten{0};  // 环形缓冲覆盖掉的最旧事件数
+};
+
+/**
+ * Tracer - 运行期追踪（进程内单例）
+ *
+ * 每个线程首次记录时登记一个固定容量的环形缓冲（kThreadEvents 条），写满后覆盖最旧事件，
+ * 相当于“飞行记录器”：随时导出的是各线程最近一段时间的区间。记录路径无锁、无分配：
+ * 事件只保存 name/category 指针与两个整数，因此 name 必须是字符串字面量或 intern() 返回的指针。
+ *
+ * 运行期默认关闭，关闭时 FM_TRACE_SCOPE 只读一次 relaxed 原子量。环境变量 FALCONMIND_TRACE=文件路径
+ * 时进程启动即开启，退出时写出 trace；也可由调用方 start()/stop() 后 writeChromeTrace()。
+ * 时基为 PipelineClock（CLOCK_MONOTONIC），与 BootProfiler 的 CLOCK_BOOTTIME 启动时间线相互独立。
+ */
+class Tracer {
+public:
+    static constexpr std::size_t kThreadEvents = 8192;  // 每线程容量，2 的幂
+
+    static Tracer& instance();
+
+    static bool enabled() noexcept;
+    void start();
+    void stop();
+    // 丢弃全部已记录事件，回收已退出线程的缓冲
+    void clear();
+
+    /**
+     * 返回与 name 内容相同、进程生命周期内有效的字符串指针；相同内容返回同一指针
+     * 供节点 id 等运行期名字使用，应在构造/配置时调用一次并缓存结果，不要放在记录路径上
+     */
+    static const char* intern(std::string_view name);
+
+    // 当前线程在 trace 中的显示名（字面量或 intern() 指针）
+    static void setThreadName(const char* name) noexcept;
+
+    static void complete(const char* category, const char* name, std::int64_t startNs, std::int64_t endNs) noexcept;
+    static void instant(const char* category, const char* name) noexcept;
+
+    TraceStats stats() const;
+    std::string toChromeTrace() const;
+    bool writeChromeTrace(const std::string& path) const;
+
+private:
+    Tracer();
+
+    struct State;
+    State* state_;
+};
+
+/**
+ * TraceScope - 作用域区间：构造到析构记为一条 "X" 事件；构造时未开启追踪则不计时
+ */
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name) noexcept;
+    ~TraceScope() {
+        if (startNs_ >= 0) finish();
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    void finish() noexcept;
+
+    const char* category_;
+    const char* name_;
+    std::int64_t startNs_{-1};
+};
+
+} // namespace falconmind::sdk::core
+
+#define FM_TRACE_CONCAT_INNER(a, b) a##b
+#define FM_TRACE_CONCAT(a, b) FM_TRACE_CONCAT_INNER(a, b)
+
+#if FALCONMIND_TRACING
+#define FM_TRACE_SCOPE(category, name) \
+    ::falconmind::sdk::core::TraceScope FM_TRACE_CONCAT(fmTraceScope_, __LINE__)((category), (name))
+#define FM_TRACE_INSTANT(category, name) ::falconmind::sdk::core::Tracer::instant((category), (name))
+#define FM_TRACE_THREAD_NAME(name) ::falconmind::sdk::core::Tracer::setThreadName((name))
+#else
+#define FM_TRACE_SCOPE(category, name) ((void)0)
+#define FM_TRACE_INSTANT(category, name) ((void)0)
+#define FM_TRACE_THREAD_NAME(name) ((void)0)
+#endif
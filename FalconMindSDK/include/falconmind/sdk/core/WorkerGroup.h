@@ -0,0 +1,34 @@
+// FalconMindSDK - 工作线程组：逐帧数据并行（点云滤波、图像前处理等）按固定分片数在共享 TaskPool 上执行
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace falconmind::sdk::core {
+
+class TaskPool;
+
+/**
+ * WorkerGroup - run(task) 对 index 0..count()-1 各执行一次 task(index) 并等待完成，调用线程承担 index 0
+ * 其余分片作为任务提交到 TaskPool::shared()（不再常驻自有线程），各组件共用同一组线程而不超额占用核心；
+ * 分片可能并行也可能先后执行，task 不应在分片之间同步等待。count 为 1 时直接在调用线程执行。
+ */
+class WorkerGroup {
+public:
+    explicit WorkerGroup(std::size_t count);
+    WorkerGroup(std::size_t count, TaskPool& pool);
+    WorkerGroup(const WorkerGroup&) = delete;
+    WorkerGroup& operator=(const WorkerGroup&) = delete;
+
+    std::size_t count() const noexcept { return count_; }
+    void run(const std::function<void(std::size_t)>& task);
+
+    // 未显式指定分片数时的默认值：min(硬件线程数, 4)，为采集与推理线程留出核心
+    static std::size_t defaultCount();
+
+private:
+    std::size_t count_;
+    TaskPool* pool_;
+};
+
+} // namespace falconmind::sdk::core
@@ -1,48 +1,207 @@
-// FalconMindSDK - FlightConnectionService (week2 skeleton, UDP-only)
+// FalconMindSDK - FlightConnectionService (UDP / 串口, MAVLink v1/v2，可选专用 I/O 线程)
 #pragma once
 
+#include "falconmind/sdk/core/SeqLock.h"
+#include "falconmind/sdk/flight/FlightEstimators.h"
 #include "falconmind/sdk/flight/FlightTypes.h"
+#include "falconmind/sdk/flight/Mavlink.h"
+#include "falconmind/sdk/flight/MissionUpload.h"
 
+#include <array>
 #include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
+#include <vector>
 #include <cstdint>
 
+#include <netinet/in.h>
+
+namespace falconmind::sdk::core {
+class FlightLogRecorder;
+}
+
 namespace falconmind::sdk::flight {
 
+class MavlinkRouter;
+
 class FlightConnectionService {
 public:
     FlightConnectionService();
     ~FlightConnectionService();
 
     bool connect(const FlightConnectionConfig& cfg);
+    // 路由模式：不自建 socket，挂接到共享的 MavlinkRouter 上只收发 targetSystem 这架飞机的帧。
+    // 接收由路由器线程驱动（等同于已启动 I/O 线程，pollState 只报告快照更新），其余 API 不变
+    bool connect(std::shared_ptr<MavlinkRouter> router, std::uint8_t targetSystem,
+                 MavlinkVersion version = MavlinkVersion::V2);
     void disconnect();
 
     bool isConnected() const noexcept { return connected_; }
 
-    // 发送高层飞控命令（内部先简单打印/占位，后续接入 MAVLink）
+    // SDK 作为地面站发送时使用的系统 / 组件 ID
+    static constexpr std::uint8_t kSysId = 255;
+    static constexpr std::uint8_t kCompId = 190;
+
+    // 发送高层飞控命令（编码为 COMMAND_LONG）
     bool sendCommand(const FlightCommand& cmd);
 
-    // 从链路中轮询最新状态（当前为占位，后续接入 MAVLink 解析）
+    // 发送命令并跟踪 COMMAND_ACK（按命令 ID 匹配），超时按 options 重发；最终结果经回调 / future 交付。
+    // 回调在解析线程（I/O 线程或 pollState 调用方）中执行，不要阻塞，也不要在其中调用 pollState()。
+    // 重发与超时判定由 I/O 线程驱动；未启动 I/O 线程时需持续调用 pollState()
+    using CommandCallback = std::function<void(const CommandAck& ack)>;
+    bool sendCommandAsync(const FlightCommand& cmd, const CommandOptions& options, CommandCallback callback);
+    std::future<CommandAck> sendCommandAsync(const FlightCommand& cmd, const CommandOptions& options = {});
+    std::size_t pendingCommands() const;
+
+    // 任务上传：按 MAVLink 任务协议把整条任务一次性交给飞控（MISSION_COUNT，逐项应答 MISSION_REQUEST_INT，
+    // 以 MISSION_ACK 结束），之后飞控自主执行（FlightCommandType::MissionStart），伴随计算机掉线也不中断；
+    // 执行进度见 FlightState::missionSeq / missionReached（FlightField::Mission）。同时只有一个上传，
+    // 新上传使进行中的上传以 Superseded 结束。回调线程与重发 / 超时的驱动方式同 sendCommandAsync
+    using MissionCallback = std::function<void(const MissionUploadAck& ack)>;
+    bool uploadMission(std::vector<MissionItem> items, const MissionUploadOptions& options, MissionCallback callback);
+    std::future<MissionUploadAck> uploadMission(std::vector<MissionItem> items, const MissionUploadOptions& options = {});
+    bool missionUploadActive() const;
+
+    // 发送已编码好的完整帧：不分配、不打日志，可在高频设定点线程中调用（与 sendCommand 并发安全）
+    bool sendFrame(const std::uint8_t* frame, std::size_t size);
+    // 本端发送帧的序号（所有发送者共用，保证对端看到连续序号）
+    std::uint8_t nextSequence() noexcept { return seq_.fetch_add(1, std::memory_order_relaxed); }
+    MavlinkVersion mavlinkVersion() const noexcept { return cfg_.mavlinkVersion; }
+    // 命令的 target_system（独立连接默认为 1，路由模式为挂接的 sysid）
+    std::uint8_t targetSystem() const noexcept { return targetSystem_; }
+    bool routed() const noexcept { return router_ != nullptr; }
+
+    // 未启动 I/O 线程时：非阻塞读完当前已到达的全部数据报，逐帧解析（每个数据报可含多帧）并合并遥测；
+    // I/O 线程运行时不再读 socket，只在快照自上次调用后有更新时返回它。无更新返回 empty
     std::optional<FlightState> pollState();
+
+    // 专用接收线程：epoll 等待 socket 可读，每次唤醒用 recvmmsg 批量读完积压数据报并解析，
+    // 状态写入 seqlock 快照后回调状态监听器；调用方无需轮询。需先 connect()，disconnect() 时自动停止
+    bool startIoThread();
+    void stopIoThread();
+    bool ioThreadRunning() const noexcept { return ioRunning_.load(std::memory_order_acquire); }
+
+    // 每个通过 CRC 校验的帧（含非遥测消息）在解析线程（pollState 调用方或 I/O 线程）中回调；
+    // frame.payload 只在回调期间有效
+    using MessageHandler = std::function<void(const mavlink::Frame& frame)>;
+    void setMessageHandler(MessageHandler handler);
+    // 每批数据报解析出状态更新后回调一次（快照已发布），典型用法是写入任务黑板；回调中不要阻塞
+    using StateListener = std::function<void(const FlightState& state)>;
+    void setStateListener(StateListener listener);
+    // 飞行日志：收到的原始数据（MavlinkRx，每个数据报 / 串口读批次一条）与发出的帧（MavlinkTx）写入 recorder。
+    // 需在 connect() / startIoThread() 之前设置；路由模式下接收侧由 MavlinkRouter::setLogRecorder 记录
+    void setLogRecorder(std::shared_ptr<core::FlightLogRecorder> recorder) { log_ = std::move(recorder); }
+    // 解析统计（帧数 / CRC 错误 / 丢帧等），解析线程外读取时可能是撕裂的近似值
+    mavlink::ParserStats parserStats() const;
+    // 接收到的数据报数（含被截断的；串口链路为合并后的读批次数）
+    std::uint64_t datagramsReceived() const noexcept { return datagrams_.load(std::memory_order_relaxed); }
     
-    // 获取最后缓存的飞行状态
+    // 获取最后缓存的飞行状态（seqlock 快照，不加锁，可在行为树 / 其它线程高频调用）
     FlightState getLastState() const;
+    // 已解析的状态更新次数，可用于判断是否有新状态（等于最新快照的 FlightState::seq）
+    std::uint64_t stateVersion() const noexcept { return stateSnapshot_.version(); }
+    // 快照序号 sinceSeq 之后更新过的字段组位图（fieldBit(FlightField)）；不复制快照，适合高频轮询“有没有我关心的变化”
+    std::uint32_t changedSince(std::uint64_t sinceSeq) const noexcept;
+
+    // 机载估计器：启用后在解析线程随快照发布 O(1) 更新（速度组 → 风矢量，电池组 → 能量 / 续航），
+    // 不另起线程；任务规划据此选扫描方向（WindEstimate::sweepAngleRad）与返航时机（returnMarginSec）。
+    // 可随时调用，重新调用时按新配置重置估计
+    void enableEstimators(const WindEstimatorConfig& wind = {}, const EnergyEstimatorConfig& energy = {});
+    WindEstimate windEstimate() const { return windSnapshot_.load(); }
+    EnergyEstimate energyEstimate() const { return energySnapshot_.load(); }
 
 private:
-    // 生成 MAVLink v1 COMMAND_LONG 帧（二进制），后续可替换为完整 MAVLink 库实现
-    bool encodeMavlinkCommand(const FlightCommand& cmd, std::string& out);
+    friend class MavlinkRouter;
+
+    bool linkOpen() const noexcept { return connected_ && (fd_ >= 0 || router_); }
+    // 路由模式：路由器线程分发来的本机帧（持 stateMutex_ 解析并发布快照）
+    void deliverRouted(const mavlink::Frame& frame);
+
+    // 按配置的 MAVLink 版本生成 COMMAND_LONG 帧（二进制）；confirmation 为重发计数
+    bool encodeMavlinkCommand(const FlightCommand& cmd, std::string& out, std::uint8_t confirmation = 0);
+    static std::uint16_t mavCommandId(FlightCommandType type) noexcept;
+
+    // 待确认命令表（同时在途的不同命令很少，定长线性表）
+    struct PendingCommand {
+        bool active{false};
+        FlightCommand cmd{};
+        std::uint16_t command{0};
+        CommandOptions options{};
+        CommandCallback callback;
+        int attempts{0};
+        std::uint8_t progress{0};
+        bool inProgress{false};  // 已收到 IN_PROGRESS：只等待最终结果，不再重发
+        std::int64_t firstSentNs{0};
+        std::int64_t deadlineNs{0};
+    };
+    static constexpr std::size_t kMaxPendingCommands = 8;
+    void handleCommandAck(const mavlink::Frame& frame);
+    // 任务协议消息（MISSION_REQUEST(_INT) / MISSION_ACK）交给上传状态机；返回 true 表示已处理
+    bool handleMissionFrame(const mavlink::Frame& frame);
+    // 按链路版本编码并发送一条任务协议消息（v1 截去扩展字段）
+    bool sendMissionMessage(std::uint32_t msgid, const std::uint8_t* payload, std::size_t length);
+    // 处理到期的命令与任务上传重发 / 超时，返回最近的截止时间（无待确认命令与上传时为 0）
+    std::int64_t serviceCommandTimeouts(std::int64_t nowNs);
+    void wakeIoThread();
 
-    // CRC-16/MCRF4XX 算法（MAVLink 使用）
-    std::uint16_t mavlinkCrcAccumulate(std::uint8_t data, std::uint16_t crc) const;
-    std::uint16_t mavlinkCrcCalculate(const std::uint8_t* buf, std::size_t len, std::uint8_t crcExtra) const;
+    bool openUdp();
+    // 串口：termios 原始模式 + 波特率 + 低延迟标志（驱动不支持时忽略）
+    bool openSerial();
+    // 按链路类型发送一帧（UDP sendto / 串口 write，后者处理部分写入）
+    bool transmit(const void* data, std::size_t size);
+    // 读完当前积压的数据（UDP：recvmmsg 批量数据报；串口：连续 read 合并成一段）并解析（调用方持有 stateMutex_）；
+    // 有状态更新时发布快照并返回 true
+    bool drainLocked();
+    // 给 lastState_ 填写快照元数据（seq / changed / 逐组序号与时间戳）后发布快照并回调监听器（持 stateMutex_）
+    void publishLocked(std::uint32_t changedMask);
+    void ioLoop();
 
-    int sock_{-1};
+    static constexpr std::size_t kDatagramBytes = 4096;  // 单个数据报上限（打包多帧的 UDP 数据报）
+    static constexpr std::size_t kRecvBatch = 16;        // 每次 recvmmsg 最多收取的数据报数
+    static constexpr int kMaxBatchesPerDrain = 16;       // 单次排空的批数上限，防止持续洪泛时饿死其它调用
+    static constexpr int kSerialWriteTimeoutMs = 50;     // 串口发送缓冲满时等待可写的上限
+
+    int fd_{-1};          // UDP socket 或串口设备
+    bool serial_{false};
+    sockaddr_in remoteAddr_{};  // connect 时解析一次
+    std::mutex txMutex_;        // 串口部分写入时防止多个发送者的帧交错
     FlightConnectionConfig cfg_{};
+    std::shared_ptr<MavlinkRouter> router_;
+    std::shared_ptr<core::FlightLogRecorder> log_;
+    std::uint8_t targetSystem_{1};
     std::atomic<bool> connected_{false};
-    mutable std::mutex stateMutex_;  // mutable 允许在 const 方法中锁定
-    FlightState lastState_{}; // 预留缓存，当前未真实填充
-    std::uint8_t seq_{0};     // MAVLink 序号
+    std::mutex stateMutex_;   // 串行化解析（解析器与 lastState_ 的唯一写者；读者只读 stateSnapshot_）
+    mavlink::StreamParser parser_;
+    std::vector<std::uint8_t> recvStorage_;  // kRecvBatch × kDatagramBytes，connect 时分配
+    MessageHandler messageHandler_;
+    StateListener stateListener_;
+    FlightState lastState_{};
+    core::SeqLock<FlightState> stateSnapshot_;
+    std::array<std::atomic<std::uint64_t>, kFlightFieldCount> fieldSeq_{};  // 与快照 fieldSeq 相同，供 changedSince 免复制读取
+    bool estimatorsEnabled_{false};  // 以下两个估计器由 stateMutex_ 保护
+    WindEstimator wind_;
+    EnergyEstimator energy_;
+    core::SeqLock<WindEstimate> windSnapshot_;
+    core::SeqLock<EnergyEstimate> energySnapshot_;
+    std::atomic<std::uint64_t> polledVersion_{0};  // I/O 线程模式下 pollState 已返回过的快照版本
+    std::atomic<std::uint64_t> datagrams_{0};
+
+    std::atomic<bool> ioRunning_{false};
+    int epollFd_{-1};
+    int wakeFd_{-1};  // eventfd：stopIoThread 时唤醒 I/O 线程
+    std::thread ioThread_;
+    std::atomic<std::uint8_t> seq_{0};  // MAVLink 序号
+
+    mutable std::mutex commandMutex_;
+    std::array<PendingCommand, kMaxPendingCommands> pending_{};
+
+    mutable std::mutex missionMutex_;
+    MissionUploader mission_;
+    MissionCallback missionCallback_;
 };
 
 } // namespace falconmind::sdk::flight
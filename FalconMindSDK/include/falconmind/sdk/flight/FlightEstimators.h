@@ -0,0 +1,113 @@
+// FalconMindSDK - 机载在线估计：风矢量（地速 vs 姿态 / 空速）与电池能量 / 续航，每个样本 O(1)、定长状态
+#pragma once
+
+#include "falconmind/sdk/flight/FlightTypes.h"
+
+#include <cstdint>
+
+namespace falconmind::sdk::flight {
+
+struct WindEstimatorConfig {
+    double timeConstantSec{8.0};   // 一阶低通时间常数：越大越平滑、对阵风越迟钝
+    double dragCoefficient{0.3};   // 多旋翼水平线性阻力系数（1/s）：空速 = 推力水平分量 / 系数
+    double minRelativeAltM{2.0};   // 低于此高度（地效、起降）不采样
+    double maxAccelMps2{1.5};      // 地速变化超过该加速度视为机动，阻力平衡假设不成立，跳过样本
+};
+
+// 风速矢量（NED，风吹向的方向，m/s）
+struct WindEstimate {
+    double north{0.0};
+    double east{0.0};
+    double speed{0.0};
+    double fromDeg{0.0};     // 气象风向：风的来向（0 = 北风，顺时针）
+    double sigma{0.0};       // 样本相对估计的离散程度（m/s，指数加权 RMS）
+    std::uint64_t samples{0};
+    double observedSec{0.0}; // 参与估计的样本覆盖时长
+    bool valid{false};       // observedSec 达到半个时间常数后为 true
+
+    // 与风向平行的扫描线角度（mission::sweepSegments 约定：与东向夹角、逆时针，[0, π)）：
+    // 顺风 / 逆风飞行每条航线，避免侧风偏航导致相机足迹歪斜
+    double sweepAngleRad() const noexcept;
+};
+
+/**
+ * WindEstimator
+ *
+ * 每个速度样本：空中相对速度 v_air 由空速与航向给出（固定翼），或由多旋翼姿态推力的水平分量按线性阻力
+ * 平衡换算（v_air = g·tilt / dragCoefficient），风 = 地速 − v_air，再按样本间隔做一阶低通。
+ * 机动中（地速加速度过大）与低空的样本被跳过。只保存上一样本与滤波状态，非线程安全，
+ * 通常由 FlightConnectionService 在解析线程中随快照发布更新。
+ */
+class WindEstimator {
+public:
+    explicit WindEstimator(const WindEstimatorConfig& config = {}) : config_(config) {}
+
+    // timestampNs 为样本时间（steady_clock 纳秒）；airspeedMps < 0 表示无空速计，使用姿态阻力模型。
+    // 返回样本是否被采用
+    bool update(const FlightState& state, std::int64_t timestampNs, double airspeedMps = -1.0) noexcept;
+    void reset() noexcept;
+
+    const WindEstimate& estimate() const noexcept { return estimate_; }
+    const WindEstimatorConfig& config() const noexcept { return config_; }
+
+private:
+    WindEstimatorConfig config_;
+    WindEstimate estimate_;
+    double meanSq_{0.0};
+    double lastVn_{0.0}, lastVe_{0.0};
+    std::int64_t lastNs_{0};
+};
+
+struct EnergyEstimatorConfig {
+    double capacityWh{0.0};           // 电池标称能量；0 为未知（只按剩余百分比的下降速率估计续航）
+    double reserveFraction{0.2};      // 落地时须保留的能量比例
+    double powerTimeConstantSec{5.0}; // 功率 / 掉电速率的低通时间常数
+};
+
+struct EnergyEstimate {
+    double powerW{0.0};           // 最近一次样本的瞬时功率
+    double avgPowerW{0.0};        // 低通平均功率
+    double usedWh{0.0};           // 自首个样本起积分的能量
+    double remainingWh{-1.0};     // 可用到保留线的剩余能量，-1 为未知
+    double drainPctPerSec{0.0};   // 剩余百分比的低通下降速率
+    double enduranceSec{-1.0};    // 按当前平均消耗到保留线的时间，-1 为未知
+    std::uint64_t samples{0};
+    bool valid{false};
+};
+
+/**
+ * EnergyEstimator
+ *
+ * 每个电池样本：功率 = 电压 × 电流（电流未知时只跟踪百分比），梯形积分累计用能，
+ * 平均功率与掉电速率按样本间隔低通。已知容量时续航 = (剩余能量 − 保留) / 平均功率；
+ * 否则 = (剩余百分比 − 保留百分比) / 掉电速率。非线程安全，与 WindEstimator 相同由解析线程更新。
+ */
+class EnergyEstimator {
+public:
+    explicit EnergyEstimator(const EnergyEstimatorConfig& config = {}) : config_(config) {}
+
+    bool update(const FlightState& state, std::int64_t timestampNs) noexcept;
+    void reset() noexcept;
+
+    const EnergyEstimate& estimate() const noexcept { return estimate_; }
+    const EnergyEstimatorConfig& config() const noexcept { return config_; }
+
+private:
+    EnergyEstimatorConfig config_;
+    EnergyEstimate estimate_;
+    double lastPowerW_{-1.0};
+    double lastPercent_{-1.0};
+    std::int64_t lastNs_{0};
+    std::int64_t lastPercentNs_{0};
+};
+
+// 空速 airspeedMps 沿航向 courseRad（NED，自北顺时针）飞行时的地速：侧风由偏航抵消，顺风分量叠加；
+// 侧风不小于空速（无法保持航迹）时返回 0
+double groundSpeedAlong(double courseRad, double airspeedMps, const WindEstimate& wind) noexcept;
+
+// 返航余量（秒）：续航减去按风修正地速飞完 distanceM 再加 landingSec 所需的时间。
+// 小于 0 即应立即返航；续航未知或无法逆风到达时返回 -1e9
+double returnMarginSec(const EnergyEstimate& energy, const WindEstimate& wind, double distanceM, double courseRad,
+                       double airspeedMps, double landingSec = 30.0) noexcept;
+
+} // namespace falconmind::sdk::flight
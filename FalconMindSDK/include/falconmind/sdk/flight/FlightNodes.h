@@ -6,7 +6,7 @@
 
 namespace falconmind::sdk::flight {
 
-// Source 节点：从 FlightConnectionService 轮询状态（当前为占位，后续接入 MAVLink）
+// Source 节点：从 FlightConnectionService 轮询状态，经 out 推送 FlightState（二进制布局）并发布 Telemetry
 class FlightStateSourceNode : public core::Node {
 public:
     FlightStateSourceNode(FlightConnectionService& svc);
@@ -15,6 +15,7 @@ public:
 
 private:
     FlightConnectionService& svc_;
+    core::Pad* outPad_{nullptr};
 };
 
 // Sink 节点：将高层命令发送到 FlightConnectionService
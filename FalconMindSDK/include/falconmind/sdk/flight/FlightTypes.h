@@ -1,6 +1,8 @@
 // FalconMindSDK - Flight related types (week2 skeleton)
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace falconmind::sdk::flight {
@@ -11,19 +13,46 @@ enum class MavlinkVersion {
 };
 
 struct FlightConnectionConfig {
-    std::string   linkType{"UDP"};    // 先支持 UDP，后续扩展串口
+    std::string   linkType{"UDP"};    // "UDP" 或 "SERIAL"（UART 直连飞控，不区分大小写）
     std::string   remoteAddress{"127.0.0.1"};
     int           remotePort{14540};  // PX4-SITL 默认端口之一
+    int           localPort{0};       // >0 时绑定本地端口接收遥测（飞控主动推送的场景）；0 为发送时的临时端口
+    std::string   serialDevice{"/dev/ttyS1"};  // SERIAL：串口设备
+    int           baudRate{921600};            // SERIAL：波特率（须为 termios 支持的标准值）
     MavlinkVersion mavlinkVersion{MavlinkVersion::V2}; // 默认使用 MAVLink v2
 };
 
-// FlightState 与 MAVLink 典型字段映射关系（未来在 FlightConnectionService 中实现）：
-// - lat/lon/alt  ← GLOBAL_POSITION_INT.lat/lon/alt（1e-7 deg → deg，mm → m）
-// - roll/pitch/yaw ← ATTITUDE.roll/pitch/yaw
-// - vx/vy/vz ← GLOBAL_POSITION_INT.vx/vy/vz
-// - batteryPercent/batteryVoltageMv ← BATTERY_STATUS
-// - gpsFixType/numSat ← GPS_RAW_INT 或 GLOBAL_POSITION_INT 相关字段
-struct FlightState {
+// FlightState 字段分组：每组对应一条遥测消息，作为变更位图的位与逐组时间戳 / 序号的下标
+enum class FlightField : std::uint8_t {
+    Position = 0,  // GLOBAL_POSITION_INT：lat/lon/alt/relativeAlt/heading
+    Velocity,      // GLOBAL_POSITION_INT：vx/vy/vz
+    Attitude,      // ATTITUDE：roll/pitch/yaw 及角速度
+    Battery,       // SYS_STATUS / BATTERY_STATUS：电量、电压、电流
+    Gps,           // GPS_RAW_INT：定位类型、卫星数、精度、地速
+    Heartbeat,     // HEARTBEAT：解锁状态、模式、系统状态
+    SysStatus,     // SYS_STATUS：传感器健康、负载、通信丢包
+    Mission,       // MISSION_CURRENT / MISSION_ITEM_REACHED：飞控执行中的任务进度
+    Count
+};
+constexpr std::size_t kFlightFieldCount = static_cast<std::size_t>(FlightField::Count);
+constexpr std::uint32_t fieldBit(FlightField f) noexcept { return 1u << static_cast<unsigned>(f); }
+constexpr std::uint32_t kAllFlightFields = (1u << kFlightFieldCount) - 1;
+
+// FlightState 与 MAVLink 字段映射关系（mavlink::applyTelemetry 实现）：
+// - lat/lon/alt/relativeAlt/heading ← GLOBAL_POSITION_INT（1e-7 deg → deg，mm → m，cdeg → deg）
+// - vx/vy/vz ← GLOBAL_POSITION_INT.vx/vy/vz（cm/s → m/s，NED）
+// - roll/pitch/yaw 及角速度 ← ATTITUDE
+// - batteryPercent/batteryVoltageMv/batteryCurrentA ← SYS_STATUS 与 BATTERY_STATUS（后者另有 consumedMah / 温度）
+// - gpsFixType/numSat/gpsEph/groundSpeed ← GPS_RAW_INT
+// - armed/baseMode/customMode/systemStatus/vehicleType ← HEARTBEAT（忽略地面站与非飞控组件的心跳）
+// - sensorsHealth/loadPermille/dropRateComm ← SYS_STATUS
+// - missionSeq/missionTotal/missionState ← MISSION_CURRENT，missionReached ← MISSION_ITEM_REACHED
+//
+// 快照元数据由 FlightConnectionService 在发布时填写：seq 为快照序号（等于 stateVersion()），
+// changed 为本次发布相对上一快照更新了的字段组，fieldSeq / fieldUpdatedNs 为各组最近一次更新的序号与时间
+// （steady_clock 纳秒，0 表示从未收到）。消费者记住上次处理的 seq，用 changedSince(seq) 取得其后更新过的组，
+// 无需整结构比较。按 64 字节对齐以免快照与相邻数据共享缓存行。
+struct alignas(64) FlightState {
     double lat{0.0};
     double lon{0.0};
     double alt{0.0};
@@ -37,6 +66,49 @@ struct FlightState {
     int    batteryVoltageMv{0};
     int    gpsFixType{0};
     int    numSat{0};
+
+    double relativeAlt{0.0};       // 相对起飞点高度（m）
+    double heading{0.0};           // 航向（deg，0–360；未知时保持上次值）
+    double rollRate{0.0};          // rad/s
+    double pitchRate{0.0};
+    double yawRate{0.0};
+    double batteryCurrentA{-1.0};  // -1 为未知
+    int    batteryConsumedMah{-1}; // -1 为未知
+    double batteryTemperatureC{0.0};
+    double gpsEph{-1.0};           // 水平精度因子（HDOP），-1 为未知
+    double groundSpeed{0.0};       // GPS 地速（m/s）
+    bool   armed{false};
+    std::uint8_t baseMode{0};      // MAV_MODE_FLAG
+    std::uint8_t systemStatus{0};  // MAV_STATE
+    std::uint8_t vehicleType{0};   // MAV_TYPE
+    std::uint32_t customMode{0};   // 飞控自定义模式（PX4：main_mode << 16 | sub_mode << 24）
+    std::uint32_t sensorsHealth{0};
+    std::uint16_t loadPermille{0}; // 主循环负载（0.1%）
+    std::uint16_t dropRateComm{0}; // 通信丢包率（0.01%）
+    int    missionSeq{-1};         // 飞控当前执行的任务项序号，-1 为未收到
+    int    missionTotal{-1};       // 任务项总数（MISSION_CURRENT 扩展字段，-1 为未知）
+    int    missionReached{-1};     // 最近到达的任务项序号
+    std::uint8_t missionState{0};  // MISSION_STATE（0 未知，2 未开始，3 执行中，4 暂停，5 完成）
+
+    std::uint64_t seq{0};
+    std::uint32_t changed{0};
+    std::uint64_t fieldSeq[kFlightFieldCount]{};
+    std::int64_t fieldUpdatedNs[kFlightFieldCount]{};
+
+    // seq 之后（不含）更新过的字段组位图
+    std::uint32_t changedSince(std::uint64_t sinceSeq) const noexcept {
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < kFlightFieldCount; ++i) {
+            if (fieldSeq[i] > sinceSeq) mask |= 1u << i;
+        }
+        return mask;
+    }
+    bool has(FlightField f) const noexcept { return fieldSeq[static_cast<std::size_t>(f)] != 0; }
+    // 距该组最近一次更新的时间（纳秒）；从未更新返回 -1
+    std::int64_t ageNs(FlightField f, std::int64_t nowNs) const noexcept {
+        const std::int64_t t = fieldUpdatedNs[static_cast<std::size_t>(f)];
+        return t == 0 ? -1 : nowNs - t;
+    }
 };
 
 // FlightCommand 与 MAVLink COMMAND_LONG 的典型映射（示意）：
@@ -45,12 +117,16 @@ struct FlightState {
 // - Takeoff       → MAV_CMD_NAV_TAKEOFF
 // - Land          → MAV_CMD_NAV_LAND
 // - ReturnToLaunch→ MAV_CMD_NAV_RETURN_TO_LAUNCH
+// - Offboard      → MAV_CMD_DO_SET_MODE（PX4 OFFBOARD；切换前须已在流式发送设定点，见 SetpointStreamer）
+// - MissionStart  → MAV_CMD_MISSION_START（从第 0 项执行已上传的任务，见 FlightConnectionService::uploadMission）
 enum class FlightCommandType {
     Arm,
     Disarm,
     Takeoff,
     Land,
-    ReturnToLaunch
+    ReturnToLaunch,
+    Offboard,
+    MissionStart
 };
 
 struct FlightCommand {
@@ -58,5 +134,32 @@ struct FlightCommand {
     double targetAlt{0.0};  // Takeoff/Land 时可用
 };
 
-} // namespace falconmind::sdk::flight
+// 命令结果：前 7 项与 MAV_RESULT 取值一致，其余为本端判定
+enum class CommandResult : std::uint8_t {
+    Accepted = 0,
+    TemporarilyRejected = 1,
+    Denied = 2,
+    Unsupported = 3,
+    Failed = 4,
+    InProgress = 5,   // 只作为中间进度出现，不是最终结果
+    Cancelled = 6,
+    Timeout = 100,    // 重发次数用尽仍未收到 COMMAND_ACK
+    SendFailed = 101, // 未连接或发送失败
+    Superseded = 102, // 同一命令 ID 在等待期间又被提交，旧请求作废
+};
+
+struct CommandAck {
+    CommandResult result{CommandResult::Timeout};
+    std::uint16_t command{0};     // MAV_CMD
+    std::uint8_t progress{0};     // 最近一次 IN_PROGRESS 的进度（%）
+    int attempts{0};              // 实际发送次数（含重发）
+    std::int64_t latencyNs{0};    // 首次发送到最终结果
+    bool accepted() const noexcept { return result == CommandResult::Accepted; }
+};
 
+struct CommandOptions {
+    int timeoutMs{500};   // 每次发送后等待 ACK 的时间；收到 IN_PROGRESS 时重新计时且不再重发
+    int maxAttempts{3};   // 含首次发送；重发时 COMMAND_LONG.confirmation 递增
+};
+
+} // namespace falconmind::sdk::flight
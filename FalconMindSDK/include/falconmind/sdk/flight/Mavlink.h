@@ -0,0 +1,149 @@
+// FalconMindSDK - MAVLink v1/v2 帧流式解析与编码（无外部依赖、解析路径零堆分配）
+#pragma once
+
+#include "falconmind/sdk/flight/FlightTypes.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace falconmind::sdk::flight::mavlink {
+
+constexpr std::uint8_t kStxV1 = 0xFE;
+constexpr std::uint8_t kStxV2 = 0xFD;
+constexpr std::size_t kHeaderV1 = 6;   // STX LEN SEQ SYSID COMPID MSGID
+constexpr std::size_t kHeaderV2 = 10;  // STX LEN INCOMPAT COMPAT SEQ SYSID COMPID MSGID[3]
+constexpr std::size_t kSignatureLen = 13;
+constexpr std::uint8_t kIncompatSigned = 0x01;
+constexpr std::size_t kMaxPayload = 255;
+constexpr std::size_t kMaxFrame = kHeaderV2 + kMaxPayload + 2 + kSignatureLen;
+
+// 常用消息 ID
+constexpr std::uint32_t kMsgHeartbeat = 0;
+constexpr std::uint32_t kMsgSysStatus = 1;
+constexpr std::uint32_t kMsgGpsRawInt = 24;
+constexpr std::uint32_t kMsgAttitude = 30;
+constexpr std::uint32_t kMsgGlobalPositionInt = 33;
+constexpr std::uint32_t kMsgMissionRequest = 40;
+constexpr std::uint32_t kMsgMissionCurrent = 42;
+constexpr std::uint32_t kMsgMissionCount = 44;
+constexpr std::uint32_t kMsgMissionItemReached = 46;
+constexpr std::uint32_t kMsgMissionAck = 47;
+constexpr std::uint32_t kMsgMissionRequestInt = 51;
+constexpr std::uint32_t kMsgMissionItemInt = 73;
+constexpr std::uint32_t kMsgCommandLong = 76;
+constexpr std::uint32_t kMsgCommandAck = 77;
+constexpr std::uint32_t kMsgSetPositionTargetLocalNed = 84;
+constexpr std::uint32_t kMsgBatteryStatus = 147;
+
+// CRC-16/MCRF4XX（X.25）
+constexpr std::uint16_t crcAccumulate(std::uint8_t data, std::uint16_t crc) noexcept {
+    std::uint8_t tmp = static_cast<std::uint8_t>(data ^ static_cast<std::uint8_t>(crc & 0xFFu));
+    tmp ^= static_cast<std::uint8_t>(tmp << 4);
+    return static_cast<std::uint16_t>((crc >> 8) ^ (static_cast<std::uint16_t>(tmp) << 8) ^
+                                      (static_cast<std::uint16_t>(tmp) << 3) ^ (static_cast<std::uint16_t>(tmp) >> 4));
+}
+
+constexpr std::uint16_t crcCalculate(const std::uint8_t* buf, std::size_t len, std::uint16_t crc = 0xFFFF) noexcept {
+    for (std::size_t i = 0; i < len; ++i) crc = crcAccumulate(buf[i], crc);
+    return crc;
+}
+
+struct MessageInfo {
+    std::uint32_t msgid;
+    std::uint8_t crcExtra;
+};
+
+// 已知消息的 CRC_EXTRA 表（common.xml，编译期常量）；未知消息无法校验，解析器丢弃
+const MessageInfo* findMessage(std::uint32_t msgid) noexcept;
+
+struct Frame {
+    std::uint8_t version{2};
+    std::uint8_t seq{0};
+    std::uint8_t sysid{0};
+    std::uint8_t compid{0};
+    std::uint32_t msgid{0};
+    std::uint8_t length{0};  // 线上载荷长度（v2 可能截断了末尾零字节）
+    bool signedFrame{false};
+    // 载荷（kMaxPayload 字节，length 之后已补零，截断的 v2 载荷可直接按完整布局解码）
+    const std::uint8_t* payload{nullptr};
+};
+
+struct ParserStats {
+    std::uint64_t frames{0};
+    std::uint64_t crcErrors{0};
+    std::uint64_t unknownMessages{0};  // 帧头完整但消息 ID 不在表中（按失步处理）
+    std::uint64_t skippedBytes{0};     // 为重新同步丢弃的字节数
+    std::uint64_t seqGaps{0};          // 按 (sysid, compid) 的序号跳变累计的丢帧数
+};
+
+/**
+ * StreamParser - 字节流 → 帧
+ *
+ * 输入先写入固定容量的环形缓冲，再从读位置扫描：找到 STX 后等待整帧到齐，
+ * 按表中 CRC_EXTRA 校验 CRC；校验失败或消息未知时只丢弃该 STX 字节继续搜索，
+ * 因此数据报内的多帧、跨数据报（串口分片）的帧以及夹杂的噪声都能正确切分。
+ * 每个有效帧同步回调 onFrame(const Frame&)；Frame::payload 指向解析器内部缓冲，只在回调期间有效。
+ * 非线程安全：单一 I/O 线程使用。
+ */
+class StreamParser {
+public:
+    static constexpr std::size_t kCapacity = 4096;  // 2 的幂，至少容纳一帧未完成的尾部与一批新数据
+
+    template <typename OnFrame>
+    std::size_t feed(const std::uint8_t* data, std::size_t size, OnFrame&& onFrame) {
+        std::size_t frames = 0;
+        while (size > 0) {
+            const std::size_t n = write(data, size);
+            data += n;
+            size -= n;
+            for (;;) {
+                const int r = next();
+                if (r == 0) break;
+                if (r > 0) {
+                    onFrame(static_cast<const Frame&>(frame_));
+                    consumeFrame();
+                    ++frames;
+                }
+            }
+        }
+        return frames;
+    }
+
+    void reset() noexcept;
+    std::size_t buffered() const noexcept { return static_cast<std::size_t>(w_ - r_); }
+    const ParserStats& stats() const noexcept { return stats_; }
+
+private:
+    std::size_t write(const std::uint8_t* data, std::size_t size) noexcept;
+    // 1：frame_ 就绪；-1：丢弃了字节，可继续；0：需要更多数据
+    int next() noexcept;
+    void consumeFrame() noexcept;
+    std::uint8_t at(std::size_t offset) const noexcept { return ring_[(r_ + offset) & (kCapacity - 1)]; }
+
+    std::array<std::uint8_t, kCapacity> ring_{};
+    std::uint64_t r_{0}, w_{0};
+    std::size_t frameTotal_{0};
+    Frame frame_;
+    std::array<std::uint8_t, kMaxPayload> payload_{};
+    ParserStats stats_;
+
+    // 各发送方（sysid, compid）最近的序号，用于统计丢帧；链路上的组件数很少，线性查找
+    struct SeqSlot {
+        std::uint8_t sysid, compid, seq;
+    };
+    static constexpr std::size_t kMaxSenders = 16;
+    std::array<SeqSlot, kMaxSenders> senders_{};
+    std::size_t senderCount_{0};
+};
+
+// 编码一帧到 out（容量至少 kMaxFrame），返回帧长；消息未知或载荷超长返回 0。v2 按规范截去载荷末尾零字节
+std::size_t encodeFrame(MavlinkVersion version, std::uint8_t seq, std::uint8_t sysid, std::uint8_t compid,
+                        std::uint32_t msgid, const std::uint8_t* payload, std::size_t length, std::uint8_t* out) noexcept;
+
+// 把遥测消息合并进飞行状态（HEARTBEAT / SYS_STATUS / GPS_RAW_INT / ATTITUDE / GLOBAL_POSITION_INT / BATTERY_STATUS /
+// MISSION_CURRENT / MISSION_ITEM_REACHED），
+// 返回更新了的字段组位图（fieldBit(FlightField)）；其它消息返回 0。不填写快照元数据（seq / fieldSeq 等）
+std::uint32_t applyTelemetry(const Frame& frame, FlightState& state) noexcept;
+
+} // namespace falconmind::sdk::flight::mavlink
@@ -0,0 +1,128 @@
+// FalconMindSDK - 多机 MAVLink 路由：少量 UDP socket + 单一 I/O 线程，按 sysid 分发到各机的 FlightConnectionService
+#pragma once
+
+#include "falconmind/sdk/core/SeqLock.h"
+#include "falconmind/sdk/flight/Mavlink.h"
+
+#include <netinet/in.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::core {
+class FlightLogRecorder;
+}
+
+namespace falconmind::sdk::flight {
+
+class FlightConnectionService;
+
+struct MavlinkRouterStats {
+    std::uint64_t datagrams{0};
+    std::uint64_t frames{0};
+    std::uint64_t unrouted{0};  // 没有挂接服务的 sysid 发来的帧
+    std::uint64_t crcErrors{0};
+};
+
+/**
+ * MavlinkRouter
+ *
+ * SITL 集群或地面中继中，多架飞机共用一个（或几个）UDP 端口：路由器统一 epoll 等待所有端点，
+ * recvmmsg 批量收包并按帧头 sysid 分发——挂接了 FlightConnectionService 的 sysid 直接在 I/O 线程中
+ * 更新该服务的状态快照 / 命令确认，未挂接的计入 unrouted 并可经发现回调通知上层。
+ * 每个 sysid 最近一次的来源地址被记录下来，服务发送命令 / 设定点时经 sendTo() 原路发回。
+ * 挂接的服务通过 FlightConnectionService::connect(router, sysid) 建立，对上层保持与独立连接相同的 API；
+ * 其命令重发 / 超时也由路由器线程驱动。回调在路由器线程中执行，不要在其中 connect / disconnect。
+ */
+class MavlinkRouter {
+public:
+    MavlinkRouter();
+    ~MavlinkRouter();
+
+    MavlinkRouter(const MavlinkRouter&) = delete;
+    MavlinkRouter& operator=(const MavlinkRouter&) = delete;
+
+    // 绑定一个本地 UDP 端点（port 为 0 时由系统分配，见 endpointPort）；需在 start() 之前调用
+    bool addEndpoint(int localPort, const std::string& bindAddress = "0.0.0.0");
+    std::size_t endpointCount() const noexcept { return endpoints_.size(); }
+    int endpointPort(std::size_t index) const;
+
+    bool start();
+    void stop();
+    bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+
+    // 把帧发往该 sysid 最近一次的来源地址；尚未收到过该机的数据时返回 false
+    bool sendTo(std::uint8_t sysid, const std::uint8_t* frame, std::size_t size);
+    // 已收到过数据的 sysid
+    std::vector<std::uint8_t> vehicles() const;
+    std::uint64_t framesFrom(std::uint8_t sysid) const noexcept;
+    // 按 sysid 的序号跳变累计的丢帧数
+    std::uint64_t seqGapsFrom(std::uint8_t sysid) const noexcept;
+    MavlinkRouterStats stats() const noexcept;
+
+    // 首次收到未挂接 sysid 的帧时回调（每个 sysid 一次），可据此为新飞机创建服务
+    using DiscoveryHandler = std::function<void(std::uint8_t sysid, std::uint8_t compid)>;
+    void setDiscoveryHandler(DiscoveryHandler handler);
+    // 把收到的每个数据报（MavlinkRx）与 sendTo 发出的帧（MavlinkTx）写入飞行日志；需在 start() 之前设置
+    void setLogRecorder(std::shared_ptr<core::FlightLogRecorder> recorder) { log_ = std::move(recorder); }
+
+private:
+    friend class FlightConnectionService;
+
+    // 由 FlightConnectionService::connect / disconnect 调用；detach 返回后路由器线程不再访问该服务
+    bool attach(std::uint8_t sysid, FlightConnectionService* svc);
+    void detach(std::uint8_t sysid, FlightConnectionService* svc);
+    void wake();
+
+    struct Endpoint {
+        int fd{-1};
+        mavlink::StreamParser parser;  // UDP 数据报总是完整帧，多机共享一个解析器即可
+    };
+    struct RemoteAddr {
+        sockaddr_in addr{};
+        int endpoint{-1};
+    };
+    struct Route {
+        FlightConnectionService* svc{nullptr};  // routeMutex_ 保护
+        core::SeqLock<RemoteAddr> remote;        // 路由器线程写，发送线程读
+        std::atomic<bool> heard{false};
+        std::atomic<std::uint64_t> frames{0};
+        std::atomic<std::uint64_t> seqGaps{0};
+        std::uint8_t lastSeq{0};
+        bool discovered{false};
+    };
+
+    void ioLoop();
+    void drainEndpoint(std::size_t index);
+
+    static constexpr std::size_t kDatagramBytes = 2048;
+    static constexpr std::size_t kRecvBatch = 32;
+
+    std::vector<std::unique_ptr<Endpoint>> endpoints_;
+    std::array<Route, 256> routes_{};
+    mutable std::mutex routeMutex_;  // 挂接 / 分发互斥：分发整批数据报期间持有
+    DiscoveryHandler discovery_;
+    std::shared_ptr<core::FlightLogRecorder> log_;
+
+    std::vector<std::uint8_t> recvStorage_;
+    std::array<sockaddr_in, kRecvBatch> recvAddrs_{};
+
+    std::atomic<std::uint64_t> datagrams_{0};
+    std::atomic<std::uint64_t> frames_{0};
+    std::atomic<std::uint64_t> unrouted_{0};
+
+    std::atomic<bool> running_{false};
+    int epollFd_{-1};
+    int wakeFd_{-1};
+    std::thread thread_;
+};
+
+} // namespace falconmind::sdk::flight
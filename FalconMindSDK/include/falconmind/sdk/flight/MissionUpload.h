@@ -0,0 +1,113 @@
+// FalconMindSDK - MAVLink 任务协议上传（MISSION_COUNT → MISSION_REQUEST_INT / MISSION_ITEM_INT → MISSION_ACK）
+#pragma once
+
+#include "falconmind/sdk/flight/Mavlink.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace falconmind::sdk::flight {
+
+// 一个任务项（MISSION_ITEM_INT，seq 按在列表中的下标填写）
+struct MissionItem {
+    std::uint16_t command{16};  // MAV_CMD，默认 MAV_CMD_NAV_WAYPOINT
+    std::uint8_t frame{6};      // MAV_FRAME，默认 MAV_FRAME_GLOBAL_RELATIVE_ALT_INT（高度相对起飞点）
+    double lat{0.0}, lon{0.0};  // deg，编码为 1e-7 deg 整数
+    float alt{0.f};             // m
+    float param1{0.f}, param2{0.f}, param3{0.f}, param4{0.f};
+    bool autocontinue{true};
+
+    // 航点：acceptRadiusM 为到达判定半径（0 使用飞控默认值），yaw 为 NaN 时保持飞控默认航向策略
+    static MissionItem waypoint(double lat, double lon, float relativeAlt, float acceptRadiusM = 0.f,
+                                float yawDeg = std::numeric_limits<float>::quiet_NaN()) noexcept;
+};
+
+// 上传结果：前 9 项与 MAV_MISSION_RESULT 取值一致（飞控在 MISSION_ACK 中给出，INVALID_PARAM* 归为 Invalid），其余为本端判定
+enum class MissionUploadResult : std::uint8_t {
+    Accepted = 0,
+    Error = 1,
+    UnsupportedFrame = 2,
+    Unsupported = 3,
+    NoSpace = 4,
+    Invalid = 5,
+    InvalidSequence = 13,
+    Denied = 14,
+    Cancelled = 15,
+    Timeout = 100,     // 重发次数用尽仍未收到请求 / ACK
+    SendFailed = 101,  // 未连接或发送失败
+    Superseded = 102,  // 等待期间提交了新的上传，旧上传作废
+};
+
+struct MissionUploadAck {
+    MissionUploadResult result{MissionUploadResult::Timeout};
+    std::uint16_t count{0};          // 任务项数
+    std::uint16_t itemsSent{0};      // 飞控请求过的不同任务项数
+    int resends{0};                  // 超时重发次数（MISSION_COUNT 与任务项合计）
+    std::int64_t latencyNs{0};       // 发出 MISSION_COUNT 到最终结果
+    bool accepted() const noexcept { return result == MissionUploadResult::Accepted; }
+};
+
+struct MissionUploadOptions {
+    int timeoutMs{1500};  // 每次发送后等待飞控下一条请求 / ACK 的时间
+    int maxAttempts{5};   // 同一步骤的发送次数上限（含首次）；收到新的请求即重新计数
+};
+
+/**
+ * MissionUploader - 任务上传状态机（与链路无关，FlightConnectionService 持有一个实例）
+ *
+ * 一次上传：发出 MISSION_COUNT，飞控按序号逐项请求（MISSION_REQUEST_INT，兼容旧飞控的 MISSION_REQUEST），
+ * 每个请求回复对应的 MISSION_ITEM_INT；飞控收齐后以 MISSION_ACK 给出结果。请求可重复或回退（飞控侧丢包），
+ * 按请求的序号应答即可。超时未收到下一条消息时重发最后一帧，同一步骤连续 maxAttempts 次无响应判定超时。
+ * 发送经 SendFn(msgid, payload, len)，由持有者编码成帧（MAVLink v1 链路截去扩展字段）；非线程安全，持有者加锁。
+ */
+class MissionUploader {
+public:
+    static constexpr std::size_t kCountLen = 5;     // count, target_system, target_component, mission_type
+    static constexpr std::size_t kItemIntLen = 38;  // 含扩展字段 mission_type
+    static constexpr std::size_t kCountLenV1 = 4;   // 不含扩展字段
+    static constexpr std::size_t kItemIntLenV1 = 37;
+    using SendFn = std::function<bool(std::uint32_t msgid, const std::uint8_t* payload, std::size_t length)>;
+
+    // 开始上传（覆盖进行中的上传，调用方负责通知其结果为 Superseded）；发送 MISSION_COUNT 失败返回 false
+    bool begin(std::vector<MissionItem> items, std::uint8_t targetSystem, std::uint8_t targetComponent,
+               const MissionUploadOptions& options, std::int64_t nowNs, const SendFn& send);
+    // 处理飞控的 MISSION_REQUEST(_INT) / MISSION_ACK；上传结束时填写 done 并返回 true
+    bool onFrame(const mavlink::Frame& frame, std::int64_t nowNs, const SendFn& send, MissionUploadAck& done);
+    // 处理到期的重发 / 超时；超时结束时填写 done 并返回 true
+    bool service(std::int64_t nowNs, const SendFn& send, MissionUploadAck& done);
+    // 放弃进行中的上传（不发送任何消息）
+    void cancel() noexcept { active_ = false; }
+
+    bool active() const noexcept { return active_; }
+    // 下一次重发 / 超时判定的时间（无上传时为 0）
+    std::int64_t deadlineNs() const noexcept { return active_ ? deadlineNs_ : 0; }
+    std::size_t count() const noexcept { return items_.size(); }
+
+    // 编码载荷（返回载荷长度），供测试 / 自定义发送路径使用
+    static std::size_t encodeCount(std::uint16_t count, std::uint8_t targetSystem, std::uint8_t targetComponent,
+                                   std::uint8_t* payload) noexcept;
+    static std::size_t encodeItem(const MissionItem& item, std::uint16_t seq, std::uint8_t targetSystem,
+                                  std::uint8_t targetComponent, std::uint8_t* payload) noexcept;
+
+private:
+    bool sendCount(const SendFn& send);
+    bool sendItem(std::uint16_t seq, const SendFn& send);
+    void finish(MissionUploadResult result, std::int64_t nowNs, MissionUploadAck& done);
+
+    std::vector<MissionItem> items_;
+    std::vector<bool> requested_;
+    MissionUploadOptions options_{};
+    std::uint8_t targetSystem_{1};
+    std::uint8_t targetComponent_{1};
+    bool active_{false};
+    int lastSent_{-1};  // 最后发送的任务项序号，-1 为 MISSION_COUNT
+    int attempts_{0};
+    MissionUploadAck ack_{};
+    std::int64_t startNs_{0};
+    std::int64_t deadlineNs_{0};
+};
+
+} // namespace falconmind::sdk::flight
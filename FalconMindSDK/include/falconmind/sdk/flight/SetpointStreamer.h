@@ -0,0 +1,103 @@
+// FalconMindSDK - Offboard 设定点流式发送：预编码 SET_POSITION_TARGET_LOCAL_NED 模板 + 专用定时线程
+#pragma once
+
+#include "falconmind/sdk/core/SeqLock.h"
+#include "falconmind/sdk/flight/FlightConnectionService.h"
+#include "falconmind/sdk/flight/Mavlink.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace falconmind::sdk::flight {
+
+enum class SetpointMode : std::uint8_t {
+    Position,          // 只控位置（速度作前馈忽略）
+    Velocity,          // 只控速度（目标跟随 / 精准降落的横向修正）
+    PositionVelocity,  // 位置 + 速度前馈（轨迹跟踪）
+};
+
+// 本地 NED 坐标系下的设定点（相对 EKF 原点，米 / 米每秒 / 弧度）
+struct OffboardSetpoint {
+    SetpointMode mode{SetpointMode::Position};
+    float x{0.f}, y{0.f}, z{0.f};     // 北、东、地
+    float vx{0.f}, vy{0.f}, vz{0.f};
+    float yaw{0.f};                   // 自北顺时针
+    float yawRate{0.f};
+    bool useYawRate{false};           // true 时控偏航速率而非偏航角
+
+    // 由 ENU（mission::LocalEnuFrame / TrajectorySetpoint 的约定）转换；航迹 yaw 已是自北顺时针
+    static OffboardSetpoint fromEnu(double east, double north, double up, double ve, double vn, double vu, double yaw,
+                                    SetpointMode mode = SetpointMode::PositionVelocity) noexcept;
+};
+
+/**
+ * SetpointStreamer
+ *
+ * PX4 要求 OFFBOARD 模式下以 > 2 Hz 持续收到设定点，目标跟随 / 精准降落通常需要 50–100 Hz。
+ * 帧头（STX、长度、标志、sysid / compid、msgid）在构造 / start() 时按链路的 MAVLink 版本预先编码，
+ * 每个周期只写入序号与载荷并续算 CRC，经 FlightConnectionService::sendFrame 发送（缓存的目标地址，无分配、无日志）。
+ * 设定点由任意线程经 setSetpoint() 写入 seqlock，定时线程按固定周期读取最新值；
+ * 从未写入设定点时不发送。载荷按完整 53 字节发送（v2 截断末尾零字节是可选的，接收方均能处理）。
+ */
+class SetpointStreamer {
+public:
+    static constexpr std::size_t kPayloadLen = 53;
+
+    explicit SetpointStreamer(FlightConnectionService& svc, std::uint8_t targetSystem = 1,
+                              std::uint8_t targetComponent = 1);
+    ~SetpointStreamer();
+
+    SetpointStreamer(const SetpointStreamer&) = delete;
+    SetpointStreamer& operator=(const SetpointStreamer&) = delete;
+
+    // 启动定时线程（rateHz 限制在 [1, 200]）；服务未连接返回 false
+    bool start(double rateHz = 50.0);
+    void stop();
+    bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+
+    void setSetpoint(const OffboardSetpoint& sp) noexcept { setpoint_.store(sp); }
+    bool hasSetpoint() const noexcept { return setpoint_.version() > 0; }
+
+    // 立即按当前设定点发送一帧（定时线程每周期调用，线程运行时外部不要再调用）；无设定点或发送失败返回 false
+    bool sendOnce();
+
+    // 把设定点编码进内部模板并返回帧长（帧内容见 frame()），供测试 / 自定义发送路径使用
+    std::size_t encode(const OffboardSetpoint& sp, std::uint32_t timeBootMs, std::uint8_t seq) noexcept;
+    const std::uint8_t* frame() const noexcept { return frame_.data(); }
+
+    std::uint64_t sent() const noexcept { return sent_.load(std::memory_order_relaxed); }
+    std::uint64_t sendFailures() const noexcept { return failures_.load(std::memory_order_relaxed); }
+    // 定时线程因调度延迟整周期错过的发送次数
+    std::uint64_t missedTicks() const noexcept { return missed_.load(std::memory_order_relaxed); }
+
+private:
+    void buildTemplate() noexcept;
+    void loop(std::int64_t periodNs);
+
+    FlightConnectionService& svc_;
+    std::uint8_t targetSystem_;
+    std::uint8_t targetComponent_;
+
+    std::array<std::uint8_t, mavlink::kHeaderV2 + kPayloadLen + 2> frame_{};
+    std::size_t header_{0};
+    std::size_t seqOffset_{0};
+    std::uint16_t crcPrefix_{0};  // STX 之后、序号之前的帧头字节的 CRC
+    std::uint8_t crcExtra_{0};
+
+    core::SeqLock<OffboardSetpoint> setpoint_;
+    std::int64_t startNs_{0};
+    std::atomic<bool> running_{false};
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;  // stop() 时立即唤醒定时线程
+    std::thread thread_;
+    std::atomic<std::uint64_t> sent_{0};
+    std::atomic<std::uint64_t> failures_{0};
+    std::atomic<std::uint64_t> missed_{0};
+};
+
+} // namespace falconmind::sdk::flight
@@ -1,7 +1,15 @@
-// FalconMindSDK - Minimal Behavior Tree implementation for Mission & Behavior
+// FalconMindSDK - Behavior Tree implementation for Mission & Behavior（事件驱动执行）
 #pragma once
 
+#include "falconmind/sdk/core/PipelineClock.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -13,39 +21,227 @@ enum class NodeStatus {
     Failure
 };
 
+// 行为树时钟：随 PipelineClock 切换虚拟时间（定时、超时与悬停在测试中按虚拟时刻到期，不占墙钟）
+using BtClock = core::PipelineSteadyClock;
+
+// 执行器的唤醒器：事件 notify 时置位并唤醒等待中的执行器线程
+class BehaviorWaker {
+public:
+    void wake();
+    // 等到被唤醒或到达 deadline；返回是否被唤醒（并清除唤醒标志）
+    bool waitUntil(BtClock::time_point deadline);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool pending_{false};
+};
+
+/**
+ * BehaviorEvent - 行为树可等待的变化源（黑板条目、外部事件、检测结果到达等）
+ *
+ * notify() 可在任意线程调用：版本号加一并唤醒所有等待过该事件的执行器。
+ */
+class BehaviorEvent {
+public:
+    void notify();
+    std::uint64_t version() const noexcept { return version_.load(std::memory_order_acquire); }
+
+    // 由执行器在节点等待该事件时登记
+    void attach(const std::shared_ptr<BehaviorWaker>& waker) const;
+
+private:
+    std::atomic<std::uint64_t> version_{0};
+    mutable std::mutex mutex_;
+    mutable std::vector<std::weak_ptr<BehaviorWaker>> wakers_;
+};
+
+/**
+ * BehaviorNode
+ *
+ * 节点在 tick() 中可调用 waitFor(event) / waitUntil(time) 声明“在此之前不必再 tick 我”：
+ * 组合节点通过 tickChild() 跳过仍在等待（Running 且所等事件未变化、定时未到）的子节点，
+ * 执行器据所有等待条件休眠，直到事件 notify 或最早的定时到期。
+ * 返回 Running 却未声明任何等待条件的叶子节点按执行器的轮询间隔 tick（兼容原有动作节点）。
+ */
 class BehaviorNode {
 public:
     virtual ~BehaviorNode() = default;
     virtual NodeStatus tick() = 0;
+    // 中止 / 复位：父节点放弃该分支（反应式重评估、超时、重试）时调用
+    virtual void halt() {}
+    virtual bool isComposite() const { return false; }
+
+    // Running 且等待条件尚未满足
+    bool awaiting(BtClock::time_point now) const;
+    NodeStatus lastStatus() const noexcept { return lastStatus_; }
+
+protected:
+    // 在读取事件对应的状态之前调用，保证读取之后的变化能唤醒执行器
+    void waitFor(const BehaviorEvent& event);
+    void waitUntil(BtClock::time_point deadline);
+
+    // 组合节点 tick 子节点的统一入口（含等待跳过与状态记录）
+    static NodeStatus tickChild(BehaviorNode& child);
+    static void haltChild(BehaviorNode& child);
+
+private:
+    friend class BehaviorTreeExecutor;
+
+    struct EventWait {
+        const BehaviorEvent* event;
+        std::uint64_t version;
+    };
+    std::vector<EventWait> waits_;
+    BtClock::time_point deadline_{BtClock::time_point::max()};
+    NodeStatus lastStatus_{NodeStatus::Failure};
+    bool hasRun_{false};
 };
 
 using BehaviorNodePtr = std::shared_ptr<BehaviorNode>;
 
-// 顺序节点：依次执行子节点，遇到 Running 或 Failure 时立即返回
-class SequenceNode : public BehaviorNode {
+class CompositeNode : public BehaviorNode {
 public:
     void addChild(const BehaviorNodePtr& child) { children_.push_back(child); }
+    const std::vector<BehaviorNodePtr>& children() const noexcept { return children_; }
+    bool isComposite() const override { return true; }
+    void halt() override;
+
+protected:
+    std::vector<BehaviorNodePtr> children_;
+};
 
+// 顺序节点：依次执行子节点，遇到 Running 或 Failure 时立即返回
+class SequenceNode : public CompositeNode {
+public:
     NodeStatus tick() override;
+    void halt() override;
 
 private:
-    std::vector<BehaviorNodePtr> children_;
     std::size_t currentIndex_{0};
 };
 
-// 最小执行器：每帧调用一次 root->tick()
+// 选择（回退）节点：依次尝试子节点，遇到 Running 或 Success 时立即返回，全部失败才失败
+class FallbackNode : public CompositeNode {
+public:
+    NodeStatus tick() override;
+    void halt() override;
+
+private:
+    std::size_t currentIndex_{0};
+};
+
+// 反应式顺序节点：每次 tick 都从第一个子节点重新评估（条件被打破时中止后面正在执行的分支）
+class ReactiveSequenceNode : public CompositeNode {
+public:
+    NodeStatus tick() override;
+};
+
+// 并行节点：同时执行全部子节点，successThreshold 个成功即成功，失败数使成功不可能达成时失败；
+// 结束时中止其余仍在执行的子节点。successThreshold 为 0 表示要求全部成功
+class ParallelNode : public CompositeNode {
+public:
+    explicit ParallelNode(std::size_t successThreshold = 0) : successThreshold_(successThreshold) {}
+    NodeStatus tick() override;
+    void halt() override;
+
+private:
+    std::size_t successThreshold_;
+    std::vector<NodeStatus> status_;
+};
+
+class DecoratorNode : public BehaviorNode {
+public:
+    explicit DecoratorNode(BehaviorNodePtr child) : child_(std::move(child)) {}
+    bool isComposite() const override { return true; }
+    void halt() override;
+
+protected:
+    BehaviorNodePtr child_;
+};
+
+// 超时：子节点在 timeout 内未结束则中止并返回 Failure
+class TimeoutNode : public DecoratorNode {
+public:
+    TimeoutNode(BehaviorNodePtr child, std::chrono::milliseconds timeout)
+        : DecoratorNode(std::move(child)), timeout_(timeout) {}
+    NodeStatus tick() override;
+    void halt() override;
+
+private:
+    std::chrono::milliseconds timeout_;
+    bool started_{false};
+    BtClock::time_point deadline_{};
+};
+
+// 重试：子节点失败时复位后重新执行，最多 maxAttempts 次（含首次）
+class RetryNode : public DecoratorNode {
+public:
+    RetryNode(BehaviorNodePtr child, int maxAttempts) : DecoratorNode(std::move(child)), maxAttempts_(maxAttempts) {}
+    NodeStatus tick() override;
+    void halt() override;
+
+private:
+    int maxAttempts_;
+    int attempts_{0};
+};
+
+// 条件节点：predicate 为真返回 Success，否则 Failure；inputs 变化时执行器重新评估
+class ConditionNode : public BehaviorNode {
+public:
+    ConditionNode(std::function<bool()> predicate, std::vector<const BehaviorEvent*> inputs = {})
+        : predicate_(std::move(predicate)), inputs_(std::move(inputs)) {}
+    NodeStatus tick() override;
+
+private:
+    std::function<bool()> predicate_;
+    std::vector<const BehaviorEvent*> inputs_;
+};
+
+/**
+ * 执行器
+ *
+ * tick() 无条件 tick 一次根节点（兼容逐帧调用）；spinOnce() 先休眠到有事件 notify、最早定时到期
+ * 或（存在未声明等待条件的 Running 叶子时）轮询间隔到期，再 tick，空闲时不占 CPU。
+ * notify() 可从任意线程调用以立即唤醒。
+ */
 class BehaviorTreeExecutor {
 public:
-    explicit BehaviorTreeExecutor(BehaviorNodePtr root) : root_(std::move(root)) {}
+    explicit BehaviorTreeExecutor(BehaviorNodePtr root);
 
-    NodeStatus tick() {
-        if (!root_) return NodeStatus::Failure;
-        return root_->tick();
-    }
+    NodeStatus tick();
+    NodeStatus spinOnce(std::chrono::milliseconds maxWait = std::chrono::milliseconds(1000));
+    // 反复 spinOnce 直到根节点结束或 keepRunning 返回 false
+    NodeStatus run(const std::function<bool()>& keepRunning);
+    void notify() { waker_->wake(); }
+
+    void setPollInterval(std::chrono::milliseconds interval) { pollInterval_ = interval; }
+    NodeStatus status() const noexcept { return status_; }
+    std::uint64_t ticks() const noexcept { return ticks_; }
+
+    // 当前线程正在 tick 的执行器（节点登记等待条件用）
+    static BehaviorTreeExecutor* current() noexcept;
+    void registerWait(const BehaviorEvent& event, std::uint64_t seenVersion);
+    void registerDeadline(BtClock::time_point deadline);
+    void requestPoll() { pollRequested_ = true; }
 
 private:
+    struct PendingWait {
+        const BehaviorEvent* event;
+        std::uint64_t version;
+    };
+    // 最近一次 tick 后是否已有等待的事件变化（登记到 notify 之间的变化不会丢失）
+    bool eventsChanged() const noexcept;
+
     BehaviorNodePtr root_;
+    std::shared_ptr<BehaviorWaker> waker_;
+    std::vector<PendingWait> pending_;
+    std::chrono::milliseconds pollInterval_{100};
+    NodeStatus status_{NodeStatus::Running};
+    std::uint64_t ticks_{0};
+    // 最近一次 tick 收集的唤醒条件
+    BtClock::time_point nextDeadline_{BtClock::time_point::max()};
+    bool pollRequested_{false};
 };
 
 } // namespace falconmind::sdk::mission
-
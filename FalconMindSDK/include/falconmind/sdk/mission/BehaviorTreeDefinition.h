@@ -0,0 +1,148 @@
+// FalconMindSDK - 行为树定义：JSON 一次编译为扁平、按下标链接的节点表，实例化时节点集中分配在单块内存池中
+#pragma once
+
+#include "falconmind/sdk/mission/Blackboard.h"
+#include "falconmind/sdk/mission/BehaviorTree.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace falconmind::sdk::flight {
+class FlightConnectionService;
+}
+
+namespace falconmind::sdk::mission {
+
+class GeofenceMonitorNode;
+
+// 节点参数（JSON params 中的标量；布尔按 0 / 1 记为数值）
+struct BtParam {
+    std::string key;
+    std::string text;
+    double number{0.0};
+    bool isNumber{false};
+};
+
+class BtNodeParams {
+public:
+    BtNodeParams(const BtParam* begin, std::size_t count) : begin_(begin), count_(count) {}
+
+    bool has(std::string_view key) const noexcept { return find(key) != nullptr; }
+    double number(std::string_view key, double def) const noexcept;
+    std::string text(std::string_view key, const std::string& def = {}) const;
+
+private:
+    const BtParam* find(std::string_view key) const noexcept;
+    const BtParam* begin_;
+    std::size_t count_;
+};
+
+/**
+ * 节点实例化上下文：提供飞控 / 黑板 / 围栏监视等依赖，并把节点对象分配到当前树实例的内存池中。
+ * 工厂出错时写 error 并返回 nullptr。
+ */
+class BtBuildContext {
+public:
+    flight::FlightConnectionService* flight{nullptr};
+    MissionBlackboardPtr blackboard;
+    std::shared_ptr<GeofenceMonitorNode> geofence;
+    std::string error;
+
+    template <typename T, typename... Args>
+    std::shared_ptr<T> make(Args&&... args) {
+        return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(arena_), std::forward<Args>(args)...);
+    }
+
+private:
+    friend class BehaviorTreeDefinition;
+    std::pmr::memory_resource* arena_{std::pmr::get_default_resource()};
+};
+
+enum class BtNodeKind {
+    Leaf,       // 无子节点
+    Composite,  // 任意个子节点
+    Decorator   // 恰好一个子节点
+};
+
+// children 为已实例化的子节点（按定义顺序）
+using BtNodeFactory =
+    std::function<BehaviorNodePtr(const BtNodeParams& params, const std::vector<BehaviorNodePtr>& children,
+                                  BtBuildContext& ctx)>;
+
+/**
+ * BehaviorNodeRegistry - 节点类型表（进程级单例，内置控制节点、飞行动作与黑板条件已注册）
+ *
+ * 类型名不区分大小写并忽略下划线（"ReactiveSequence" 与 "reactive_sequence" 等价）；
+ * 新的动作 / 条件类型注册后即可在下发的树定义中使用，无需修改编译器。
+ */
+class BehaviorNodeRegistry {
+public:
+    static BehaviorNodeRegistry& instance();
+
+    void registerType(const std::string& name, BtNodeKind kind, BtNodeFactory factory);
+    bool lookup(const std::string& name, BtNodeKind& kind, BtNodeFactory& factory) const;
+    static std::string normalize(std::string_view name);
+
+private:
+    BehaviorNodeRegistry();
+
+    struct Entry {
+        BtNodeKind kind;
+        BtNodeFactory factory;
+    };
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> types_;
+};
+
+/**
+ * BehaviorTreeDefinition - 编译后的行为树定义（不可变，可被多次任务共享）
+ *
+ * JSON 格式：{"type": "sequence", "params": {...}, "children": [...]}，递归嵌套。
+ * compile() 一次完成类型解析与结构校验，节点按层序存放，每个节点的子节点是表中连续的一段
+ * [firstChild, firstChild + childCount)；类型工厂与参数也在编译时拷入定义，实例化不再做字符串查找。
+ * instantiate() 自底向上构造节点，全部节点对象分配在该实例独占的单调内存池中（一次分配）；
+ * 返回的根节点持有整个实例，子节点不应脱离根节点单独保存。
+ */
+class BehaviorTreeDefinition {
+public:
+    static constexpr std::size_t kMaxNodes = 4096;
+
+    struct NodeDef {
+        std::uint32_t type{0};
+        std::uint32_t firstChild{0};
+        std::uint32_t childCount{0};
+        std::uint32_t paramBegin{0};
+        std::uint32_t paramCount{0};
+    };
+
+    static std::shared_ptr<const BehaviorTreeDefinition> compile(const std::string& json, std::string* error = nullptr);
+
+    BehaviorNodePtr instantiate(BtBuildContext& ctx) const;
+
+    std::size_t size() const noexcept { return nodes_.size(); }
+    const std::vector<NodeDef>& nodes() const noexcept { return nodes_; }
+    const std::string& typeName(std::size_t nodeIndex) const { return types_[nodes_[nodeIndex].type].name; }
+
+private:
+    struct TypeEntry {
+        std::string name;
+        BtNodeKind kind;
+        BtNodeFactory factory;
+    };
+
+    std::vector<NodeDef> nodes_;
+    std::vector<BtParam> params_;
+    std::vector<TypeEntry> types_;
+};
+
+using BehaviorTreeDefinitionPtr = std::shared_ptr<const BehaviorTreeDefinition>;
+
+} // namespace falconmind::sdk::mission
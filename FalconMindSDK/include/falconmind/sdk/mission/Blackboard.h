@@ -0,0 +1,148 @@
+// FalconMindSDK - 行为树类型化黑板：编译期键 + seqlock 槽位，流水线写入、行为树节点无锁读取
+#pragma once
+
+#include "falconmind/sdk/core/SeqLock.h"
+#include "falconmind/sdk/flight/FlightTypes.h"
+#include "falconmind/sdk/mission/BehaviorTree.h"
+#include "falconmind/sdk/mission/NavigationEkf.h"
+#include "falconmind/sdk/perception/DetectionResultPacket.h"
+#include "falconmind/sdk/perception/EnvironmentDetectionNode.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace falconmind::sdk::mission {
+
+/**
+ * BlackboardSlot<T> - 单个黑板条目
+ *
+ * 值存放在 core::SeqLock<T> 中：get() 不加锁、不分配，写入期间最多自旋数十纳秒；
+ * 每次 set() 后通知 changed()，等待该条目的行为树节点（waitFor / ConditionNode 输入）所在执行器被唤醒。
+ * 每个条目只允许单一写者（通常是流水线中产生该数据的节点回调）。
+ */
+template <typename T>
+class BlackboardSlot {
+public:
+    void set(const T& value) {
+        value_.store(value);
+        changed_.notify();
+    }
+    T get() const noexcept { return value_.load(); }
+    // 从未写入时返回 false
+    bool tryGet(T& out) const noexcept {
+        if (value_.version() == 0) return false;
+        out = value_.load();
+        return true;
+    }
+    bool has() const noexcept { return value_.version() > 0; }
+    std::uint64_t version() const noexcept { return value_.version(); }
+    const BehaviorEvent& changed() const noexcept { return changed_; }
+
+private:
+    core::SeqLock<T> value_;
+    BehaviorEvent changed_;
+};
+
+namespace detail {
+
+template <typename Key, typename... Keys>
+struct BlackboardKeyIndex;
+
+template <typename Key, typename... Rest>
+struct BlackboardKeyIndex<Key, Key, Rest...> : std::integral_constant<std::size_t, 0> {};
+
+template <typename Key, typename First, typename... Rest>
+struct BlackboardKeyIndex<Key, First, Rest...>
+    : std::integral_constant<std::size_t, 1 + BlackboardKeyIndex<Key, Rest...>::value> {};
+
+} // namespace detail
+
+/**
+ * Blackboard<Keys...> - 键集合在编译期确定的黑板
+ *
+ * 每个键是一个带 `using type = ...;` 的标签类型，值类型须可平凡复制；
+ * get<Key>() 等按键类型直接索引到槽位，没有字符串查找或类型擦除，使用未声明的键是编译错误。
+ */
+template <typename... Keys>
+class Blackboard {
+public:
+    template <typename Key>
+    using ValueType = typename Key::type;
+
+    template <typename Key>
+    BlackboardSlot<ValueType<Key>>& slot() noexcept {
+        return std::get<detail::BlackboardKeyIndex<Key, Keys...>::value>(slots_);
+    }
+    template <typename Key>
+    const BlackboardSlot<ValueType<Key>>& slot() const noexcept {
+        return std::get<detail::BlackboardKeyIndex<Key, Keys...>::value>(slots_);
+    }
+
+    template <typename Key>
+    void set(const ValueType<Key>& value) { slot<Key>().set(value); }
+    template <typename Key>
+    ValueType<Key> get() const noexcept { return slot<Key>().get(); }
+    template <typename Key>
+    bool tryGet(ValueType<Key>& out) const noexcept { return slot<Key>().tryGet(out); }
+    template <typename Key>
+    std::uint64_t version() const noexcept { return slot<Key>().version(); }
+    template <typename Key>
+    const BehaviorEvent& changed() const noexcept { return slot<Key>().changed(); }
+
+private:
+    std::tuple<BlackboardSlot<ValueType<Keys>>...> slots_;
+};
+
+// 最近一帧检测的定长快照（按得分降序保留前 kMaxItems 条），可放入 seqlock 槽位
+struct DetectionSnapshot {
+    static constexpr std::size_t kMaxItems = 16;
+
+    std::uint64_t timestampNs{0};
+    std::uint32_t frameIndex{0};
+    std::uint32_t total{0};   // 该帧检测总数
+    std::uint32_t count{0};   // items 中有效条数（min(total, kMaxItems)）
+    perception::DetectionResultPacketItemV2 items[kMaxItems]{};
+};
+
+// 任务黑板的标准键
+namespace bb {
+struct FlightState {
+    using type = flight::FlightState;
+};
+struct Detections {
+    using type = DetectionSnapshot;
+};
+struct Environment {
+    using type = perception::EnvironmentStatusPacket;
+};
+// 启用的感知分支位掩码（由行为树按任务阶段写入，见 mission/BranchRouting.h）
+struct PerceptionBranches {
+    using type = std::uint32_t;
+};
+// 机载融合导航（NavigationFilterNode 写入）
+struct Navigation {
+    using type = NavState;
+};
+} // namespace bb
+
+using MissionBlackboard =
+    Blackboard<bb::FlightState, bb::Detections, bb::Environment, bb::PerceptionBranches, bb::Navigation>;
+using MissionBlackboardPtr = std::shared_ptr<MissionBlackboard>;
+
+// 以黑板条目为输入的条件节点：条目每次写入时执行器重新评估 predicate(值)；条目从未写入时为 Failure
+template <typename Key, typename Board, typename Predicate>
+BehaviorNodePtr makeBlackboardCondition(std::shared_ptr<Board> board, Predicate predicate) {
+    const BehaviorEvent* input = &board->template changed<Key>();
+    return std::make_shared<ConditionNode>(
+        [board, predicate]() {
+            typename Key::type value;
+            return board->template tryGet<Key>(value) && predicate(value);
+        },
+        std::vector<const BehaviorEvent*>{input});
+}
+
+} // namespace falconmind::sdk::mission
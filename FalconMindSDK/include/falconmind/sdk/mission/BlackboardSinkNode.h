@@ -0,0 +1,41 @@
+// FalconMindSDK - 黑板写入节点：把流水线中的飞行状态 / 检测结果 / 环境状态写入任务黑板
+#pragma once
+
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/flight/FlightConnectionService.h"
+#include "falconmind/sdk/mission/Blackboard.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace falconmind::sdk::mission {
+
+/**
+ * BlackboardSinkNode
+ *
+ * 输入 Pad（均在推送线程中直接写入黑板，process() 无事可做）：
+ * - flight_state_in：flight::FlightState 二进制布局（FlightStateSourceNode::out）
+ * - detection_in：检测结果包（v1 / v2，经 DetectionResultView 零拷贝解析，按得分保留前 DetectionSnapshot::kMaxItems 条）
+ * - env_status_in：perception::EnvironmentStatusPacket（EnvironmentDetectionNode::env_status_out）
+ * 每个 Pad 对应单一黑板条目，满足槽位单写者要求；未传入黑板时节点自建一个，经 blackboard() 交给行为树。
+ */
+class BlackboardSinkNode : public core::Node {
+public:
+    explicit BlackboardSinkNode(MissionBlackboardPtr board = nullptr);
+
+    const MissionBlackboardPtr& blackboard() const noexcept { return board_; }
+    // 因长度或格式无效而丢弃的输入数
+    std::uint64_t rejected() const noexcept { return rejected_.load(std::memory_order_relaxed); }
+
+private:
+    void onDetections(const void* data, std::size_t size);
+
+    MissionBlackboardPtr board_;
+    std::atomic<std::uint64_t> rejected_{0};
+};
+
+// 由飞控连接的解析线程（通常是 I/O 线程）直接写 bb::FlightState，不经流水线；
+// 与 BlackboardSinkNode 的 flight_state_in 二选一，保持该条目单写者
+void attachFlightStateToBlackboard(flight::FlightConnectionService& svc, MissionBlackboardPtr board);
+
+} // namespace falconmind::sdk::mission
@@ -0,0 +1,66 @@
+// FalconMindSDK - 分支路由：按任务黑板条目启停流水线分支（GateNode / SelectorNode），空闲分支不耗算力
+#pragma once
+
+#include "falconmind/sdk/core/GateNode.h"
+#include "falconmind/sdk/core/SelectorNode.h"
+#include "falconmind/sdk/mission/BehaviorTree.h"
+#include "falconmind/sdk/mission/Blackboard.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace falconmind::sdk::mission {
+
+/**
+ * 用黑板条目控制 gate：每个缓冲到达时无锁读取条目，predicate(值) 为 true 才放行；条目从未写入时按 openWhenUnset。
+ * 条目变化后在下一个到达的缓冲处生效（截断时随即通知下游分支释放缓冲）。须在 Pipeline 进入 Playing 之前调用
+ */
+template <typename Key, typename Board, typename Predicate>
+void bindGateToBlackboard(core::GateNode& gate, std::shared_ptr<Board> board, Predicate predicate,
+                          bool openWhenUnset = true) {
+    gate.setCondition([board, predicate, openWhenUnset]() {
+        typename Key::type value;
+        return board->template tryGet<Key>(value) ? static_cast<bool>(predicate(value)) : openWhenUnset;
+    });
+}
+
+// 用黑板条目选择 selector 的输出：route(值) 返回输出下标（-1 为全部截断）；条目从未写入时为 unsetOutput
+template <typename Key, typename Board, typename Route>
+void bindSelectorToBlackboard(core::SelectorNode& selector, std::shared_ptr<Board> board, Route route,
+                              int unsetOutput = 0) {
+    selector.setRoute([board, route, unsetOutput]() {
+        typename Key::type value;
+        return board->template tryGet<Key>(value) ? static_cast<int>(route(value)) : unsetOutput;
+    });
+}
+
+// bb::PerceptionBranches 的第 bit 位置位时放行；行为树尚未写入时放行（默认全部分支启用）
+inline void bindGateToPerceptionBranch(core::GateNode& gate, MissionBlackboardPtr board, unsigned bit) {
+    const std::uint32_t mask = 1u << bit;
+    bindGateToBlackboard<bb::PerceptionBranches>(gate, std::move(board),
+                                                 [mask](std::uint32_t branches) { return (branches & mask) != 0; });
+}
+
+/**
+ * SetPerceptionBranchesAction - 行为树动作：写入 bb::PerceptionBranches 后返回 Success
+ * 放在任务阶段的序列开头（如夜间搜索阶段只启用热红外检测位），该条目应只由行为树写入
+ */
+class SetPerceptionBranchesAction : public BehaviorNode {
+public:
+    SetPerceptionBranchesAction(MissionBlackboardPtr board, std::uint32_t branches)
+        : board_(std::move(board)), branches_(branches) {}
+
+    NodeStatus tick() override {
+        if (!board_) return NodeStatus::Failure;
+        if (board_->version<bb::PerceptionBranches>() == 0 || board_->get<bb::PerceptionBranches>() != branches_) {
+            board_->set<bb::PerceptionBranches>(branches_);
+        }
+        return NodeStatus::Success;
+    }
+
+private:
+    MissionBlackboardPtr board_;
+    std::uint32_t branches_;
+};
+
+} // namespace falconmind::sdk::mission
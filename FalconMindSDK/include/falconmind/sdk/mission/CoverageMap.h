@@ -0,0 +1,95 @@
+// FalconMindSDK - 搜索覆盖统计：区域栅格化为分块位图，按相机地面足迹增量标记已覆盖单元
+#pragma once
+
+#include "falconmind/sdk/mission/CoverageSweep.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace falconmind::sdk::core {
+class CheckpointWriter;
+class CheckpointReader;
+} // namespace falconmind::sdk::core
+
+namespace falconmind::sdk::mission {
+
+/**
+ * CoverageMap - 局部平面（米）上的覆盖位图
+ *
+ * 区域（外边界 + 孔洞）边界框按 cellSize 划分单元，单元中心在区域内才计入面积；单元按 64 x 64 分块，
+ * 每块一行一个 64 位字。块在首次被足迹扫到时才分配（区域掩码 + 覆盖位，共 1 KB），整块覆盖完即释放，
+ * 只保留每块的面积 / 已覆盖计数（各 2 字节），因此常驻内存只与“覆盖前沿”上的块数有关：
+ * 100 km²、1 m 单元时计数表约 100 KB，位图只占正被扫过的条带。
+ *
+ * markPolygon 对凸多边形（相机足迹四边形）逐行求区间后按字批量置位，新覆盖数由 popcount 统计，
+ * coverage() 为 O(1)。uncoveredCells 跳过已完成的块，供重规划补扫。非线程安全。
+ */
+class CoverageMap {
+public:
+    static constexpr int kTileBits = 64;
+
+    CoverageMap(const std::vector<std::vector<PlanarPoint>>& rings, double cellSize);
+    ~CoverageMap();
+    CoverageMap(const CoverageMap&) = delete;
+    CoverageMap& operator=(const CoverageMap&) = delete;
+
+    double cellSize() const noexcept { return cell_; }
+    int width() const noexcept { return cols_; }
+    int height() const noexcept { return rows_; }
+
+    std::uint64_t areaCells() const noexcept { return areaCells_; }
+    std::uint64_t coveredCells() const noexcept { return coveredCells_; }
+    // 已覆盖比例（0.0 - 1.0）
+    double coverage() const noexcept {
+        return areaCells_ > 0 ? static_cast<double>(coveredCells_) / static_cast<double>(areaCells_) : 0.0;
+    }
+
+    // 标记凸多边形内（单元中心）的区域单元为已覆盖，返回新覆盖的单元数
+    std::uint64_t markPolygon(const PlanarPoint* vertices, std::size_t count);
+    bool isCovered(const PlanarPoint& p) const noexcept;
+
+    // 未覆盖的区域单元中心（块序、块内行序），最多 maxCount 个，返回写入个数
+    std::size_t uncoveredCells(std::vector<PlanarPoint>& out, std::size_t maxCount) const;
+
+    std::size_t allocatedTiles() const noexcept { return allocatedTiles_; }
+    void clear();
+
+    // 检查点：栅格尺寸 + 每块已覆盖计数 + 已分配块的覆盖位（已完成的块只有计数），大小与覆盖前沿成正比。
+    // 恢复时栅格尺寸须与本对象一致（同一区域与单元尺寸），否则返回 false 且不修改状态
+    void saveState(core::CheckpointWriter& out) const;
+    bool restoreState(core::CheckpointReader& in);
+
+private:
+    struct Tile {
+        std::uint64_t mask[kTileBits];     // 区域内单元
+        std::uint64_t covered[kTileBits];
+    };
+
+    Tile* tileAt(int tx, int ty);
+    // 计算块的区域掩码
+    void buildMask(int tx, int ty, std::uint64_t* mask) const;
+    // 第 cy 行单元中心所在水平线与区域的交点（升序），写入 xs_
+    void rowIntersections(int cy, std::vector<double>& xs) const;
+
+    std::vector<std::vector<PlanarPoint>> rings_;
+    double cell_;
+    double minX_{0.0}, minY_{0.0};
+    int cols_{0}, rows_{0};
+    int tilesX_{0}, tilesY_{0};
+    std::uint64_t areaCells_{0};
+    std::uint64_t coveredCells_{0};
+    std::vector<std::uint16_t> tileArea_;     // 每块区域单元数
+    std::vector<std::uint16_t> tileCovered_;  // 每块已覆盖单元数
+    std::vector<std::unique_ptr<Tile>> tiles_;
+    std::size_t allocatedTiles_{0};
+    std::vector<double> xs_;
+};
+
+// 垂直向下相机的地面足迹四角（逆时针）；yawRad 为航向（自北顺时针），hfov 对应横向、vfov 对应前向
+std::array<PlanarPoint, 4> nadirFootprint(const PlanarPoint& center, double heightAgl, double yawRad,
+                                          double hfovRad, double vfovRad);
+
+} // namespace falconmind::sdk::mission
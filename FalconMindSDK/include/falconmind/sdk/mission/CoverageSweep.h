@@ -0,0 +1,39 @@
+// FalconMindSDK - 覆盖扫描几何：多边形（含孔洞）与平行扫描线求交，生成蛇形航线
+#pragma once
+
+#include <vector>
+
+namespace falconmind::sdk::mission {
+
+// 任务局部平面坐标（米，x 向东、y 向北）
+struct PlanarPoint {
+    double x;
+    double y;
+};
+
+// 一条扫描线落在区域内的一段（端点为局部平面坐标，from 在扫描方向负侧）
+struct SweepSegment {
+    PlanarPoint from;
+    PlanarPoint to;
+    int row;  // 扫描线序号（自区域一侧起）
+};
+
+/**
+ * 扫描线与多边形求交：rings[0] 为外边界，其余为孔洞（顶点顺序任意，首尾不必重复）。
+ *
+ * 扫描线方向与 x 轴夹角 angleRad（逆时针，0 为东西向），间距 spacing，第一条线距区域边缘 spacing / 2。
+ * 每条线与所有边求交、排序后按奇偶规则配对为区域内线段，复杂度 O(行数 × 边数)，
+ * 凹多边形与孔洞使同一行产生多段；只输出线段端点，不生成中间网格点。
+ * 结果按行号、行内沿扫描方向递增排列。
+ */
+std::vector<SweepSegment> sweepSegments(const std::vector<std::vector<PlanarPoint>>& rings, double spacing,
+                                        double angleRad);
+
+/**
+ * 蛇形（boustrophedon）航线：逐行交替方向依次经过各线段端点。
+ * 行内多段之间直线转场（可能跨越孔洞 / 凹口上空）。
+ */
+std::vector<PlanarPoint> lawnMowerPath(const std::vector<std::vector<PlanarPoint>>& rings, double spacing,
+                                       double angleRad);
+
+} // namespace falconmind::sdk::mission
@@ -0,0 +1,131 @@
+// FalconMindSDK - 检测事件聚合：按轨迹与地理位置（geohash 分桶）在时间窗内聚类，每个真实目标只上报一次，置信度提升时再更新
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::mission {
+
+// 一次目标观测（单帧单个检测 / 轨迹的地面位置）
+struct DetectionSighting {
+    std::int64_t timestampNs{0};  // 单调时钟（PipelineClock 时基）
+    double lat{0.}, lon{0.}, alt{0.};
+    float confidence{0.f};
+    int trackId{-1};              // 未跟踪为 -1，只按位置聚类
+    std::string className;
+};
+
+// EventReporterNode "events" 输入 Pad 的包：DetectionSightingPacketHeader + count × DetectionSightingRecord（POD）。
+// 魔数不符的包（如误接的检测结果包）被忽略
+constexpr std::uint32_t kDetectionSightingMagic = 0x47534D46;  // "FMSG"
+
+struct DetectionSightingPacketHeader {
+    std::uint32_t magic{kDetectionSightingMagic};
+    std::uint32_t count{0};
+};
+
+struct DetectionSightingRecord {
+    std::int64_t timestampNs;
+    double lat, lon, alt;
+    float confidence;
+    std::int32_t trackId;
+    char className[32];  // 以 \0 结尾
+};
+
+struct AggregatedTarget {
+    std::uint64_t targetId{0};
+    std::string className;
+    double lat{0.}, lon{0.}, alt{0.};  // 最高置信度观测的位置
+    float bestConfidence{0.f};
+    std::int64_t firstSeenNs{0};
+    std::int64_t lastSeenNs{0};
+    std::uint32_t sightings{0};
+    std::vector<int> trackIds;         // 归入该目标的轨迹（跟踪断开重连时不止一个）
+};
+
+struct EventAggregatorConfig {
+    double radiusM{15.0};                        // 同类观测相距不超过此值视为同一目标
+    std::int64_t windowNs{30'000'000'000};       // 超过此时长未再观测到的目标过期，之后的观测视为新目标
+    float updateMargin{0.05f};                   // 置信度比已上报的最高值高出此值才产生更新
+    std::int64_t minUpdateIntervalNs{5'000'000'000};  // 同一目标两次上报的最小间隔；期间的提升在间隔到达或过期时补发
+    std::size_t maxTargets{1024};                // 超出时淘汰最久未观测的目标
+};
+
+struct EventAggregatorStats {
+    std::uint64_t sightings{0};
+    std::uint64_t newTargets{0};
+    std::uint64_t updates{0};
+    std::uint64_t suppressed{0};  // 归入已有目标且未产生事件的观测
+    std::uint64_t expired{0};
+};
+
+/**
+ * EventAggregator - 把逐帧检测聚合为逐目标事件
+ *
+ * 观测先按 trackId 归入其已绑定的目标（运动目标跟随轨迹）；否则在所在 geohash 格及相邻格中找
+ * 同类、在时间窗内且距离最近（不超过 radiusM）的目标；都没有时新建目标。格的边长不小于 radiusM
+ * （纬向固定，经向按纬度换算后扩大搜索的格数），因此查找只访问常数个桶。
+ * 只有两种观测会产生事件：新目标，以及置信度提升且距上次上报超过 minUpdateIntervalNs 的观测
+ * （位置取最高置信度的那次）。线程安全。
+ */
+class EventAggregator {
+public:
+    enum class Decision : std::uint8_t {
+        Suppressed,  // 已有目标的重复观测
+        NewTarget,
+        Updated,     // 已有目标的最高置信度提升
+    };
+    using EmitFn = std::function<void(const AggregatedTarget& target, Decision decision)>;
+
+    EventAggregator() : EventAggregator(EventAggregatorConfig{}) {}
+    explicit EventAggregator(const EventAggregatorConfig& cfg);
+
+    const EventAggregatorConfig& config() const noexcept { return cfg_; }
+
+    // 聚合一次观测；产生事件时以目标当前状态调用 emit（在内部锁内调用，emit 中不要回调本对象）
+    Decision add(const DetectionSighting& sighting, const EmitFn& emit);
+    // 过期超时的目标；被间隔压住、尚未上报的置信度提升在此以 Updated 补发
+    void expire(std::int64_t nowNs, const EmitFn& emit);
+    void reset();
+
+    std::size_t targetCount() const;
+    // 已绑定到目标的轨迹数
+    std::size_t trackCount() const;
+    EventAggregatorStats stats() const;
+
+    // 经纬度在每轴 bitsPerAxis 位量化后交织（经度在高位）得到的整数 geohash
+    static std::uint64_t geohash(double lat, double lon, int bitsPerAxis) noexcept;
+
+private:
+    struct Target {
+        AggregatedTarget info;
+        double lastLat{0.}, lastLon{0.};  // 最近一次观测的位置（用于匹配）
+        std::uint64_t cell{0};
+        std::int64_t lastEmitNs{0};
+        bool pendingUpdate{false};
+    };
+
+    std::uint64_t cellOf(double lat, double lon) const noexcept;
+    Target* findNearby(const DetectionSighting& s);
+    void index(Target& t);
+    void unindex(const Target& t);
+    void erase(std::uint64_t targetId);
+    void evictOldest();
+
+    EventAggregatorConfig cfg_;
+    int bits_{20};
+    double cellDeg_{0.};
+    mutable std::mutex mutex_;
+    std::uint64_t nextId_{1};
+    std::unordered_map<std::uint64_t, Target> targets_;
+    std::unordered_multimap<std::uint64_t, std::uint64_t> cells_;  // geohash → targetId
+    std::unordered_map<int, std::uint64_t> byTrack_;               // trackId → targetId
+    EventAggregatorStats stats_;
+};
+
+} // namespace falconmind::sdk::mission
@@ -1,11 +1,19 @@
 // FalconMindSDK - Event Reporter Node
 #pragma once
 
+#include "falconmind/sdk/cluster/SwarmTargetRegistry.h"
 #include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/mission/EventAggregator.h"
+#include "falconmind/sdk/mission/EventThumbnailer.h"
 #include "falconmind/sdk/mission/SearchTypes.h"
+#include "falconmind/sdk/perception/GeoProjection.h"
+#include "falconmind/sdk/perception/Tracker3D.h"
 #include "falconmind/sdk/telemetry/TelemetryPublisher.h"
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 
 namespace falconmind::sdk::mission {
@@ -13,6 +21,13 @@ namespace falconmind::sdk::mission {
 /**
  * 事件上报节点
  * 接收搜索事件和检测结果，通过 TelemetryPublisher 上报
+ * 检测结果先经 EventAggregator 聚合：每个真实目标上报一次 TARGET_DETECTED，之后只在最高置信度提升时
+ * 上报 TARGET_UPDATED（metadata 带 target_id），逐帧重复的检测不产生事件。
+ * "events" 输入 Pad 接收观测包（DetectionSightingPacketHeader + 记录），process() 过期目标并补发被间隔压住的更新。
+ * 设置 EventThumbnailer 后，带帧的检测上报附带目标缩略图（SearchEvent::thumbnailJpeg），
+ * 缩略图受其按轨迹去重与全局限速约束，被限制时事件照常上报、不带图。
+ * 设置集群目标表（setTargetRegistry / swarm_dedup=true）后，每次观测先查是否已被其他 UAV 认领：
+ * 已认领的目标只在本机聚合、不产生上行事件；否则登记为本机认领，经 SwarmLink 广播给相邻 UAV
  */
 class EventReporterNode : public core::Node {
 public:
@@ -28,6 +43,37 @@ public:
     // 上报检测结果（从 DetectionResult 转换）
     void reportDetection(const std::string& targetClass, double confidence,
                         double lat, double lon, double alt);
+    // 同上，并从 frame 裁剪 box 区域生成缩略图（trackId < 0 表示未跟踪）
+    void reportDetection(const std::string& targetClass, double confidence,
+                        double lat, double lon, double alt,
+                        const sensors::ImageSurface& frame, const perception::DetectionBBox& box, int trackId = -1);
+
+    // 上报地理投影后的轨迹（GeoProjector 输出）：有效地面位置作为观测聚合，新目标时上报，
+    // 位置直接取投影结果，无需调用方换算
+    void reportGeoTracks(const perception::GeoTrackingResult& geo);
+    // 同上；frame 为该结果对应的帧，产生事件的轨迹附带缩略图（GeoTrack::bbox 区域）
+    void reportGeoTracks(const perception::GeoTrackingResult& geo, const sensors::ImageSurface& frame);
+    // 上报三维轨迹（Tracker3D 输出）：按三维轨迹 ID 聚合，图像轨迹 ID 切换不产生新目标；位置为滤波后的物理位置，
+    // metadata 附带速度与位置标准差。与 reportGeoTracks 二选一（两者的轨迹 ID 不在同一命名空间）
+    void reportTracks3D(const perception::Tracking3DResult& tracks);
+    // 已归入目标的轨迹数
+    std::size_t reportedTrackCount() const { return aggregator_->trackCount(); }
+
+    // 替换聚合参数（清空已有目标）
+    void setAggregatorConfig(const EventAggregatorConfig& cfg);
+    const EventAggregator& aggregator() const noexcept { return *aggregator_; }
+    // events Pad 上格式不符而被忽略的包数
+    std::uint64_t rejectedPackets() const noexcept { return rejected_.load(std::memory_order_relaxed); }
+
+    void setThumbnailer(std::shared_ptr<EventThumbnailer> thumbnailer) { thumbnailer_ = std::move(thumbnailer); }
+    const std::shared_ptr<EventThumbnailer>& thumbnailer() const noexcept { return thumbnailer_; }
+    // 事件出口（遥测 / 地面站链路）；未设置时事件只在本地生成
+    void setEventSink(std::function<void(const SearchEvent&)> sink) { sink_ = std::move(sink); }
+    // 集群已确认目标表（通常为 SwarmStateRegistry::instance().targetRegistry()）；nullptr 关闭机间去重
+    void setTargetRegistry(std::shared_ptr<cluster::SwarmTargetRegistry> registry) { targets_ = std::move(registry); }
+    const std::shared_ptr<cluster::SwarmTargetRegistry>& targetRegistry() const noexcept { return targets_; }
+    // 因目标已被其他 UAV 认领而未上报的事件数
+    std::uint64_t swarmSuppressedEvents() const noexcept { return swarmSuppressed_.load(std::memory_order_relaxed); }
 
     // Node 接口实现
     bool configure(const std::unordered_map<std::string, std::string>& params) override;
@@ -36,8 +82,23 @@ public:
     void process() override;
 
 private:
+    void reportGeoTracks(const perception::GeoTrackingResult& geo, const sensors::ImageSurface* frame);
+    // 聚合一次观测，产生事件时构造并上报（eventTimeNs 为事件时间戳；frame 非空时附带 box 区域缩略图）
+    void reportSighting(const DetectionSighting& sighting, std::int64_t eventTimeNs, const std::string& extraJson,
+                        const sensors::ImageSurface* frame, const perception::DetectionBBox* box);
+    void onSightingRecords(const void* data, std::size_t size);
+    // 生成缩略图并写入 event（同时在 metadata JSON 末尾追加尺寸），失败时 event 不变
+    void attachThumbnail(SearchEvent& event, const sensors::ImageSurface& frame, const perception::DetectionBBox& box,
+                         int trackId, float score);
+
     std::string uavId_;
     std::string missionId_;
+    std::unique_ptr<EventAggregator> aggregator_;
+    std::shared_ptr<EventThumbnailer> thumbnailer_;
+    std::function<void(const SearchEvent&)> sink_;
+    std::shared_ptr<cluster::SwarmTargetRegistry> targets_;
+    std::atomic<std::uint64_t> rejected_{0};
+    std::atomic<std::uint64_t> swarmSuppressed_{0};
 };
 
 } // namespace falconmind::sdk::mission
@@ -0,0 +1,95 @@
+// FalconMindSDK - 检测事件缩略图：从帧中裁剪目标区域，硬件 JPEG 编码后随事件上报；按轨迹去重并全局限速
+#pragma once
+
+#include "falconmind/sdk/perception/DetectionTypes.h"
+#include "falconmind/sdk/sensors/ImageTransform.h"
+#include "falconmind/sdk/sensors/JpegEncoder.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::mission {
+
+struct EventThumbnailConfig {
+    int maxSide{128};             // 缩略图长边像素（目标框小于此值时不放大）
+    float contextRatio{0.25f};    // 裁剪区域在框四周各扩展框宽高的比例，保留周围环境便于判读
+    int quality{70};
+    int minQuality{30};
+    std::size_t maxBytes{4096};   // 超出时每次降 15 质量重新编码，降到 minQuality 仍超出则放弃
+    std::int64_t trackIntervalNs{10'000'000'000};  // 同一轨迹两张缩略图的最小间隔
+    float rescoreMargin{0.1f};    // 间隔已满足时，置信度须比该轨迹上一张高出此值才重发（目标更清晰）
+    double maxPerSecond{1.0};     // 全局令牌桶：平均速率与突发量，保证上行每目标只占几 KB
+    int burst{4};
+    std::size_t maxTracks{512};   // 去重记录上限，超出时淘汰最久未发送的轨迹
+};
+
+struct EventThumbnail {
+    int trackId{-1};
+    int width{0};
+    int height{0};
+    int quality{0};
+    std::vector<std::uint8_t> jpeg;
+};
+
+struct EventThumbnailStats {
+    std::uint64_t encoded{0};
+    std::uint64_t bytes{0};
+    std::uint64_t duplicates{0};   // 同一轨迹间隔未到或置信度未提升
+    std::uint64_t rateLimited{0};  // 令牌桶耗尽
+    std::uint64_t oversize{0};     // 最低质量仍超过 maxBytes
+    std::uint64_t failures{0};     // 裁剪 / 编码失败
+};
+
+/**
+ * EventThumbnailer - 检测事件缩略图
+ *
+ * make() 依次：按轨迹去重 → 取令牌 → IImageTransform 一趟完成裁剪、缩放与格式转换（RGA / VPI / CPU，
+ * 转为编码器的输入格式）→ IJpegEncoder 编码（MPP / NVJPEG / libjpeg-turbo）。帧为缓冲池中的原帧，
+ * 只读；缩略图在内部缓冲中生成，不复制整帧。去重检查在编码之前，重复目标不消耗编码器与令牌。
+ * 没有可用的 JPEG 编码器时 available() 为 false，make() 总是失败（事件照常上报，只是不带图）。线程安全。
+ */
+class EventThumbnailer {
+public:
+    explicit EventThumbnailer(const EventThumbnailConfig& cfg = {});
+    // 指定编码器与变换后端（测试或固定选择硬件时使用）；transform 为空时用 Auto
+    EventThumbnailer(const EventThumbnailConfig& cfg, sensors::JpegEncoderPtr encoder,
+                     sensors::ImageTransformPtr transform = nullptr);
+
+    bool available() const noexcept { return encoder_ != nullptr; }
+    const EventThumbnailConfig& config() const noexcept { return cfg_; }
+
+    /**
+     * frame 为完整帧，box 为像素坐标；trackId < 0 时不去重（只受全局限速）。
+     * nowNs 为单调时钟（PipelineClock 时基）。生成成功返回 true，out 被覆盖
+     */
+    bool make(const sensors::ImageSurface& frame, const perception::DetectionBBox& box, int trackId, float score,
+              std::int64_t nowNs, EventThumbnail& out);
+
+    // 任务切换时清除去重记录
+    void reset();
+    EventThumbnailStats stats() const;
+
+private:
+    struct TrackEntry {
+        std::int64_t lastNs{0};
+        float score{0.f};
+    };
+
+    bool takeToken(std::int64_t nowNs);
+    void remember(int trackId, std::int64_t nowNs, float score);
+
+    EventThumbnailConfig cfg_;
+    sensors::JpegEncoderPtr encoder_;
+    sensors::ImageTransformPtr transform_;
+    mutable std::mutex mutex_;
+    std::unordered_map<int, TrackEntry> tracks_;
+    double tokens_{0.0};
+    std::int64_t lastRefillNs_{-1};
+    std::vector<std::uint8_t> pixels_;  // 缩放后的编码器输入
+    EventThumbnailStats stats_;
+};
+
+} // namespace falconmind::sdk::mission
@@ -4,52 +4,65 @@
 #include "falconmind/sdk/mission/BehaviorTree.h"
 #include "falconmind/sdk/flight/FlightConnectionService.h"
 
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <optional>
 
 namespace falconmind::sdk::mission {
 
+using falconmind::sdk::flight::CommandAck;
+using falconmind::sdk::flight::CommandOptions;
 using falconmind::sdk::flight::FlightCommand;
 using falconmind::sdk::flight::FlightCommandType;
 using falconmind::sdk::flight::FlightConnectionService;
 
-class ArmAction : public BehaviorNode {
+/**
+ * FlightCommandAction - 发送一条飞控命令
+ *
+ * awaitAck = false：发送即返回 Success（只发一次，与早期行为一致）。
+ * awaitAck = true：经 sendCommandAsync 跟踪 COMMAND_ACK，等待期间返回 Running 并 waitFor 确认事件，
+ * 执行器在 ACK 到达（或重发耗尽超时）时立即被唤醒；ACCEPTED 为 Success，其它结果为 Failure（可由 retry 重试）。
+ */
+class FlightCommandAction : public BehaviorNode {
 public:
-    explicit ArmAction(FlightConnectionService& svc) : svc_(svc) {}
+    FlightCommandAction(FlightConnectionService& svc, const FlightCommand& cmd, bool awaitAck = false,
+                        const CommandOptions& options = {})
+        : svc_(svc), cmd_(cmd), awaitAck_(awaitAck), options_(options) {}
 
-    NodeStatus tick() override {
-        if (done_) return NodeStatus::Success;
-        FlightCommand cmd{};
-        cmd.type = FlightCommandType::Arm;
-        svc_.sendCommand(cmd);
-        done_ = true;
-        return NodeStatus::Success;
-    }
+    NodeStatus tick() override;
+    void halt() override { pending_.reset(); }
+
+    // 最近一次得到的确认结果（awaitAck 时有效）
+    const std::optional<CommandAck>& lastAck() const noexcept { return lastAck_; }
 
 private:
+    // 回调可能晚于节点中止 / 销毁到达，等待状态单独共享持有
+    struct AckWait {
+        std::atomic<bool> done{false};
+        CommandAck ack;
+        BehaviorEvent event;
+    };
+
     FlightConnectionService& svc_;
+    FlightCommand cmd_;
+    bool awaitAck_{false};
+    CommandOptions options_;
     bool done_{false};
+    std::shared_ptr<AckWait> pending_;
+    std::optional<CommandAck> lastAck_;
 };
 
-class TakeoffAction : public BehaviorNode {
+class ArmAction : public FlightCommandAction {
 public:
-    TakeoffAction(FlightConnectionService& svc, double targetAlt)
-        : svc_(svc), targetAlt_(targetAlt) {}
-
-    NodeStatus tick() override {
-        if (done_) return NodeStatus::Success;
-        FlightCommand cmd{};
-        cmd.type = FlightCommandType::Takeoff;
-        cmd.targetAlt = targetAlt_;
-        svc_.sendCommand(cmd);
-        done_ = true;
-        return NodeStatus::Success;
-    }
+    explicit ArmAction(FlightConnectionService& svc, bool awaitAck = false)
+        : FlightCommandAction(svc, FlightCommand{FlightCommandType::Arm, 0.0}, awaitAck) {}
+};
 
-private:
-    FlightConnectionService& svc_;
-    double targetAlt_{10.0};
-    bool done_{false};
+class TakeoffAction : public FlightCommandAction {
+public:
+    TakeoffAction(FlightConnectionService& svc, double targetAlt, bool awaitAck = false)
+        : FlightCommandAction(svc, FlightCommand{FlightCommandType::Takeoff, targetAlt}, awaitAck) {}
 };
 
 class HoverAction : public BehaviorNode {
@@ -58,40 +71,29 @@ public:
         : duration_(duration) {}
 
     NodeStatus tick() override {
-        using clock = std::chrono::steady_clock;
-        auto now = clock::now();
+        auto now = BtClock::now();
         if (!start_) {
             start_ = now;
-            return NodeStatus::Running;
         }
         if (now - *start_ < duration_) {
+            // 悬停期间不必轮询：到点前执行器不会再 tick 本节点
+            waitUntil(*start_ + duration_);
             return NodeStatus::Running;
         }
         return NodeStatus::Success;
     }
 
+    void halt() override { start_.reset(); }
+
 private:
     std::chrono::seconds duration_;
-    std::optional<std::chrono::steady_clock::time_point> start_;
+    std::optional<BtClock::time_point> start_;
 };
 
-class RtlAction : public BehaviorNode {
+class RtlAction : public FlightCommandAction {
 public:
-    explicit RtlAction(FlightConnectionService& svc) : svc_(svc) {}
-
-    NodeStatus tick() override {
-        if (done_) return NodeStatus::Success;
-        FlightCommand cmd{};
-        cmd.type = FlightCommandType::ReturnToLaunch;
-        svc_.sendCommand(cmd);
-        done_ = true;
-        return NodeStatus::Success;
-    }
-
-private:
-    FlightConnectionService& svc_;
-    bool done_{false};
+    explicit RtlAction(FlightConnectionService& svc, bool awaitAck = false)
+        : FlightCommandAction(svc, FlightCommand{FlightCommandType::ReturnToLaunch, 0.0}, awaitAck) {}
 };
 
 } // namespace falconmind::sdk::mission
-
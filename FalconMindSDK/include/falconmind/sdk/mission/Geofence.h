@@ -0,0 +1,95 @@
+// FalconMindSDK - 地理围栏空间索引：大量允许区 / 禁飞区多边形 + 高度限制的微秒级包含与边界距离查询
+#pragma once
+
+#include "falconmind/sdk/mission/CoverageSweep.h"
+#include "falconmind/sdk/mission/LocalEnuFrame.h"
+#include "falconmind/sdk/mission/SearchTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::mission {
+
+enum class GeofenceType : std::uint8_t {
+    KeepIn,   // 允许区：存在允许区时，必须位于至少一个允许区内（含高度带）
+    KeepOut   // 禁飞区：位于其多边形内且在高度带内即违规
+};
+
+struct GeofenceZone {
+    std::string name;
+    GeofenceType type{GeofenceType::KeepOut};
+    std::vector<std::vector<PlanarPoint>> rings;  // 任务局部 ENU 平面（米）：rings[0] 外边界，其余为孔洞
+    double floor{-std::numeric_limits<double>::infinity()};   // 高度带（米，与 EnuPoint::up 同基准）
+    double ceiling{std::numeric_limits<double>::infinity()};
+};
+
+// 由经纬度多边形构造区域（高度带取海拔，经 frame 换算为 up）
+GeofenceZone makeGeofenceZone(const LocalEnuFrame& frame, std::string name, GeofenceType type,
+                              const std::vector<GeoPoint>& outer, double floorAlt, double ceilingAlt,
+                              const std::vector<std::vector<GeoPoint>>& holes = {});
+
+struct GeofenceResult {
+    bool breach{false};
+    bool outsideKeepIn{false};  // 存在允许区且不在任何允许区内（水平或高度）
+    std::int32_t keepOutZone{-1};  // 所在的第一个禁飞区下标（无则为 -1）
+    std::int32_t nearestZone{-1};  // 最近边界所属区域
+    double boundaryDistance{std::numeric_limits<double>::infinity()};  // 到最近区域边界的水平距离（米）
+    // 水平包含本点的各区域高度带余量的最小值（米）：正值为安全余量，负值为越界深度
+    double verticalMargin{std::numeric_limits<double>::infinity()};
+};
+
+/**
+ * GeofenceIndex - 构建一次、只读查询（可多线程并发查询）
+ *
+ * 所有区域的边预先展开为连续数组，并栅格化到覆盖全部区域的均匀网格（单元数约为边数的 4 倍）：
+ * 每个单元按区域记录“单元中心是否在该区域内”及穿过该单元的边。包含查询只检查点所在单元：
+ * 中心状态异或“中心 → 点”线段与单元内该区域边的相交次数，代价与单元内局部边数相关，与区域总边数无关；
+ * 完全位于区域内部的单元没有边，直接得出结果。
+ * 边界距离按单元环逐层向外搜索，当前最近距离不大于已搜索环的内半径时停止；网格外的点退化为遍历全部边。
+ */
+class GeofenceIndex {
+public:
+    // 替换全部区域并重建索引；少于 3 个顶点的环被忽略，外边界无效的区域返回 false（其余区域仍被索引）
+    bool build(std::vector<GeofenceZone> zones, double cellSize = 0.0);
+
+    std::size_t zoneCount() const noexcept { return zones_.size(); }
+    const GeofenceZone& zone(std::size_t i) const { return zones_[i]; }
+    bool empty() const noexcept { return zones_.empty(); }
+    double cellSize() const noexcept { return cell_; }
+
+    // 点是否在第 zone 个区域的多边形内（仅水平，奇偶规则，孔洞内为 false）
+    bool contains(std::size_t zone, double east, double north) const noexcept;
+    // 到最近区域边界的水平距离；zone 非空时写入所属区域（无区域为 -1）
+    double boundaryDistance(double east, double north, std::int32_t* zone = nullptr) const noexcept;
+    // 围栏判定（位置为任务局部 ENU）
+    GeofenceResult check(const EnuPoint& p) const noexcept;
+
+private:
+    struct Edge {
+        double ax, ay, bx, by;
+        std::uint32_t zone;
+    };
+    struct CellZone {
+        std::uint32_t zone;
+        std::uint8_t centerInside;
+        std::uint32_t edgeBegin, edgeEnd;  // cellEdges_ 中的范围
+    };
+
+    bool cellOf(double east, double north, int& cx, int& cy) const noexcept;
+    bool insideCellZone(const CellZone& cz, int cx, int cy, double east, double north) const noexcept;
+    double edgeDistanceSq(const Edge& e, double east, double north) const noexcept;
+
+    std::vector<GeofenceZone> zones_;
+    bool hasKeepIn_{false};
+    std::vector<Edge> edges_;
+    double minX_{0.0}, minY_{0.0}, cell_{1.0};
+    int nx_{0}, ny_{0};
+    std::vector<std::uint32_t> cellStart_;  // nx × ny + 1，指向 cellZones_
+    std::vector<CellZone> cellZones_;
+    std::vector<std::uint32_t> cellEdges_;
+};
+
+} // namespace falconmind::sdk::mission
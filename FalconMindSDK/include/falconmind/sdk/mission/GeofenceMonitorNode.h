@@ -0,0 +1,55 @@
+// FalconMindSDK - 地理围栏监视节点：按遥测频率判定围栏，越界状态变化时以事件唤醒行为树
+#pragma once
+
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/SeqLock.h"
+#include "falconmind/sdk/mission/BehaviorTree.h"
+#include "falconmind/sdk/mission/Geofence.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace falconmind::sdk::mission {
+
+/**
+ * GeofenceMonitorNode
+ *
+ * 输入 Pad flight_state_in：flight::FlightState 二进制布局（FlightStateSourceNode::out），推送线程中直接判定；
+ * 带快照序号的状态按 changedSince() 只在位置组更新后重新判定（姿态 / 电池等更新不触发）。
+ * 位置经围栏所用的 LocalEnuFrame 换算为水平 ENU，高度取“海拔 − 原点海拔”（与 makeGeofenceZone 的高度带一致）。
+ * 最新结果存于 SeqLock，任意线程无锁读取；只有 breach 由假变真或由真变假时才 notify breachChanged()，
+ * 等待它的行为树条件不会被逐帧唤醒。update() 与 Pad 回调共用单一写者，不应从多个线程同时调用。
+ * setGeofence() 可在运行中替换围栏（索引以 shared_ptr 原子替换，进行中的判定继续使用旧索引）。
+ */
+class GeofenceMonitorNode : public core::Node {
+public:
+    GeofenceMonitorNode();
+
+    void setGeofence(std::shared_ptr<const GeofenceIndex> index, const LocalEnuFrame& frame);
+
+    GeofenceResult update(const GeoPoint& position);
+
+    GeofenceResult lastResult() const noexcept { return result_.load(); }
+    bool breached() const noexcept { return breached_.load(std::memory_order_acquire); }
+    const BehaviorEvent& breachChanged() const noexcept { return breachChanged_; }
+    std::uint64_t checks() const noexcept { return checks_.load(std::memory_order_relaxed); }
+
+private:
+    struct Fence {
+        std::shared_ptr<const GeofenceIndex> index;
+        LocalEnuFrame frame;
+    };
+
+    std::shared_ptr<const Fence> fence_;  // std::atomic_load / atomic_store
+    core::SeqLock<GeofenceResult> result_;
+    std::atomic<bool> breached_{false};
+    std::atomic<std::uint64_t> checks_{0};
+    std::uint64_t lastStateSeq_{0};  // Pad 回调中最近一次判定的快照序号
+    BehaviorEvent breachChanged_;
+};
+
+// 围栏未越界时为 Success 的条件节点；只在越界状态变化时被重新评估
+BehaviorNodePtr makeGeofenceCondition(std::shared_ptr<GeofenceMonitorNode> monitor);
+
+} // namespace falconmind::sdk::mission
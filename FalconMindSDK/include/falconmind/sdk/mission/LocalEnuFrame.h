@@ -0,0 +1,60 @@
+// FalconMindSDK - 任务局部 ENU 坐标系：WGS84 经纬高与以任务原点为中心的东-北-天（米）互转
+#pragma once
+
+#include "falconmind/sdk/mission/SearchTypes.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace falconmind::sdk::mission {
+
+// 局部 ENU 坐标（米）
+struct EnuPoint {
+    double east{0.0};
+    double north{0.0};
+    double up{0.0};
+};
+
+/**
+ * LocalEnuFrame - 每个任务一次投影：缓存原点的 ECEF 坐标与 ECEF → ENU 旋转
+ *
+ * toEnu 经 WGS84 椭球 ECEF 精确换算（每点一组 sin / cos，无 atan2），数十公里范围内仍保持米级以下精度，
+ * 不随纬度 / 区域大小产生平面近似（111 km/度 × cos 纬度）那样的间距畸变；
+ * toGeo 为逆变换（Bowring 闭式解，近地面亚毫米精度）。
+ * 规划、覆盖统计、到点判断等在 ENU 中做向量运算，只在输入输出边界换算一次。
+ * 批量接口逐点独立，可传入连续数组；float 平面接口（东、北分量分开存放）供栅格化等大批量计算使用。
+ */
+class LocalEnuFrame {
+public:
+    LocalEnuFrame();
+    explicit LocalEnuFrame(const GeoPoint& origin);
+
+    void setOrigin(const GeoPoint& origin);
+    const GeoPoint& origin() const noexcept { return origin_; }
+
+    EnuPoint toEnu(const GeoPoint& p) const noexcept;
+    GeoPoint toGeo(const EnuPoint& p) const noexcept;
+
+    void toEnu(const GeoPoint* in, std::size_t n, EnuPoint* out) const noexcept;
+    void toGeo(const EnuPoint* in, std::size_t n, GeoPoint* out) const noexcept;
+    void toEnu(const GeoPoint* in, std::size_t n, float* east, float* north) const noexcept;
+    std::vector<EnuPoint> toEnu(const std::vector<GeoPoint>& in) const;
+    std::vector<GeoPoint> toGeo(const std::vector<EnuPoint>& in) const;
+
+    // 多边形经纬度边界框中心（高度取 0），常用作任务原点
+    static GeoPoint boundsCenter(const std::vector<GeoPoint>& polygon) noexcept;
+
+private:
+    GeoPoint origin_{0.0, 0.0, 0.0};
+    double ox_{0.0}, oy_{0.0}, oz_{0.0};  // 原点 ECEF
+    double sinLat_{0.0}, cosLat_{1.0};
+    double sinLon_{0.0}, cosLon_{1.0};
+};
+
+inline double horizontalDistanceSq(const EnuPoint& a, const EnuPoint& b) noexcept {
+    const double de = a.east - b.east;
+    const double dn = a.north - b.north;
+    return de * de + dn * dn;
+}
+
+} // namespace falconmind::sdk::mission
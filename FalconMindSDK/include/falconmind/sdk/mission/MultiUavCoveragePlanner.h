@@ -0,0 +1,56 @@
+// FalconMindSDK - 多机协同覆盖规划：区域按面积均衡分割为条带，各机在自己的条带内蛇形扫描
+#pragma once
+
+#include "falconmind/sdk/mission/CoverageSweep.h"
+
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::mission {
+
+// 编队成员；weight 为相对分配比例（如按续航 / 速度折算），<= 0 视为 1
+struct CoverageMember {
+    std::string id;
+    double weight{1.0};
+};
+
+// 一架无人机分得的子区域与航线（局部平面坐标，米）
+struct CoverageAssignment {
+    std::string memberId;
+    std::vector<std::vector<PlanarPoint>> rings;  // 子区域外边界 + 孔洞
+    double areaM2{0.0};
+    std::vector<PlanarPoint> path;
+};
+
+/**
+ * MultiUavCoveragePlanner
+ *
+ * 沿扫描线法向把区域切成与成员数相同的条带，各条带面积按 weight 比例分配（在扫描线边界上取切分位置，
+ * 条带之间的扫描线与单机规划的全局扫描栅格一致，无缝无重叠）；条带用平行于扫描线的半平面裁剪外边界与孔洞得到，
+ * 支持凹多边形与孔洞。成员按 id 排序后依次分配条带，给定相同的区域、参数与成员列表，
+ * 每架无人机本地计算得到完全相同的分割——某架掉线时其余各机去掉该成员重新调用即可，无需经地面中心。
+ *
+ * plan() 为每个子区域开一个线程生成航线；planFor() 只计算本机的航线。
+ */
+class MultiUavCoveragePlanner {
+public:
+    MultiUavCoveragePlanner(double spacing, double angleRad) : spacing_(spacing), angleRad_(angleRad) {}
+
+    // 只做分割，不生成航线；成员为空或区域无效时返回空
+    std::vector<CoverageAssignment> partition(const std::vector<std::vector<PlanarPoint>>& rings,
+                                              const std::vector<CoverageMember>& team) const;
+    std::vector<CoverageAssignment> plan(const std::vector<std::vector<PlanarPoint>>& rings,
+                                         const std::vector<CoverageMember>& team) const;
+    // selfId 不在 team 中时返回空分配
+    CoverageAssignment planFor(const std::vector<std::vector<PlanarPoint>>& rings,
+                               const std::vector<CoverageMember>& team, const std::string& selfId) const;
+
+private:
+    double spacing_;
+    double angleRad_;
+};
+
+// 区域面积（外边界减孔洞，平方米）
+double regionArea(const std::vector<std::vector<PlanarPoint>>& rings);
+
+} // namespace falconmind::sdk::mission
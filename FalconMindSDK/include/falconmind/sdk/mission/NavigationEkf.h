@@ -0,0 +1,183 @@
+// FalconMindSDK - 机载误差状态卡尔曼滤波（IMU 传播 + GNSS / VIO 量测，定尺寸矩阵、无堆分配、量测延迟补偿）
+#pragma once
+
+#include "falconmind/sdk/core/FixedMatrix.h"
+#include "falconmind/sdk/sensors/ImuHistory.h"
+#include "falconmind/sdk/sensors/SensorTypes.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace falconmind::sdk::mission {
+
+// 融合导航输出（可平凡复制，放入黑板 bb::Navigation 与 nav_out Pad）。
+// 导航系为任务局部 ENU（米），机体系为前-左-上；姿态四元数为机体 → ENU
+struct NavState {
+    enum Status : std::uint32_t {
+        Initialized = 1u << 0,
+        OriginSet = 1u << 1,     // lat / lon / alt 有效
+        GnssFused = 1u << 2,     // 最近 fusionTimeoutNs 内融合过 GNSS
+        VioFused = 1u << 3,      // 最近 fusionTimeoutNs 内融合过 VIO
+    };
+
+    std::int64_t timestampNs{0};          // 最近一次 IMU 传播的时刻（PipelineClock 时基）
+    double east{0.}, north{0.}, up{0.};
+    double ve{0.}, vn{0.}, vu{0.};
+    double qw{1.}, qx{0.}, qy{0.}, qz{0.};
+    double roll{0.}, pitch{0.};           // rad，右翼下 / 抬头为正
+    double heading{0.};                   // rad，自北顺时针（与 FlightState::yaw 一致）
+    double lat{0.}, lon{0.}, alt{0.};     // 设置原点后有效
+    float posStd[3]{};                    // 东 / 北 / 天 1σ（m）
+    float velStd[3]{};
+    float attStd[3]{};                    // 姿态误差角 1σ（rad，导航系 x / y / z）
+    float gyroBias[3]{};
+    float accelBias[3]{};
+    std::uint32_t status{0};
+    std::uint64_t imuSamples{0};
+    std::uint64_t gnssUpdates{0};
+    std::uint64_t vioUpdates{0};
+
+    bool has(Status s) const noexcept { return (status & s) != 0; }
+};
+
+struct NavigationEkfConfig {
+    // IMU 噪声（连续时间谱密度）与零偏随机游走
+    double accelNoise{0.08};          // m/s²/√Hz
+    double gyroNoise{0.005};          // rad/s/√Hz
+    double accelBiasWalk{2e-3};       // m/s³/√Hz
+    double gyroBiasWalk{5e-5};        // rad/s²/√Hz
+    double gravity{9.80665};
+    // 初始化时的 1σ
+    double initPosSigma{5.0};
+    double initVelSigma{1.0};
+    double initTiltSigma{0.05};       // rad，横滚 / 俯仰（由加速度计调平）
+    double initYawSigma{3.14159};     // rad，航向未知时取 π，由运动中的 GNSS / VIO 姿态量测收敛
+    double initGyroBiasSigma{0.01};
+    double initAccelBiasSigma{0.2};
+    // 延迟补偿：每 snapshotIntervalNs 保存一次状态与协方差，晚到的量测回退到其时刻更新后重新传播；
+    // 早于 maxDelayNs（或快照窗口 kSnapshots × snapshotIntervalNs）的量测丢弃
+    std::int64_t snapshotIntervalNs{10'000'000};
+    std::int64_t maxDelayNs{500'000'000};
+    // 新息卡方门限（99.9%）；连续 maxRejects 次被拒后把该量测视为可信并重置对应状态（长时间中断后的重新收敛）
+    bool gating{true};
+    int maxRejects{10};
+};
+
+struct NavigationEkfStats {
+    std::uint64_t imuSamples{0};
+    std::uint64_t updates{0};
+    std::uint64_t delayedUpdates{0};   // 回退重放后更新的量测数
+    std::uint64_t replayedSamples{0};  // 重放传播的 IMU 采样数
+    std::uint64_t rejected{0};         // 新息门限拒绝
+    std::uint64_t tooOld{0};           // 超出延迟窗口
+    std::uint64_t resets{0};
+};
+
+/**
+ * NavigationEkf - 15 维误差状态 EKF（δp, δv, δθ, δbg, δba）
+ *
+ * 名义状态（位置、速度、姿态四元数、陀螺 / 加速度计零偏）按每个 IMU 采样中点积分传播，误差协方差同步传播；
+ * 所有矩阵为 core::Matrix 定尺寸值类型，每个采样的计算量固定（约 7k 次乘加），与量测频率无关。
+ * 量测（位置 / 速度 / 位姿）带采样时刻：早于当前状态时从不晚于该时刻的快照恢复，用 ImuHistory 中的采样传播到
+ * 量测时刻、更新后再传播回当前时刻（其间已融合的量测按时间重新应用），GNSS 接收机延迟与 VIO 处理延迟
+ * 不会把旧位置当成现在的位置。
+ * 重放缓冲在构造时预留，稳态运行不分配内存。非线程安全：由单一线程（NavigationFilterNode::process）驱动。
+ */
+class NavigationEkf {
+public:
+    static constexpr std::size_t kStates = 15;
+    static constexpr std::size_t kSnapshots = 64;
+    using Vec3 = core::Vector<double, 3>;
+    using Quat = std::array<double, 4>;  // w x y z
+    using Cov = core::Matrix<double, kStates, kStates>;
+
+    explicit NavigationEkf(const NavigationEkfConfig& cfg = {});
+
+    const NavigationEkfConfig& config() const noexcept { return cfg_; }
+    void reset();
+    bool initialized() const noexcept { return initialized_; }
+
+    // 以给定位置 / 速度 / 姿态初始化，协方差取配置中的初始 1σ（yawKnown 为 false 时航向取 initYawSigma）
+    void initialize(std::int64_t tNs, const Vec3& position, const Vec3& velocity, const Quat& attitude,
+                    bool yawKnown = false);
+    // 静止时加速度计（比力）读数调平：返回横滚 / 俯仰由重力方向确定、航向为 headingRad 的姿态
+    static Quat levelAttitude(const sensors::ImuSample& sample, double headingRad) noexcept;
+
+    // IMU 传播（时间戳须递增，否则丢弃）；未初始化时只记录最新采样
+    void propagate(const sensors::ImuSample& sample);
+
+    // 量测更新；imu 为重放所需的 IMU 历史（为空时不做延迟补偿，量测按当前时刻处理）。返回是否被采纳
+    bool fusePosition(std::int64_t tNs, const Vec3& position, const Vec3& sigma, const sensors::ImuHistory* imu);
+    bool fuseVelocity(std::int64_t tNs, const Vec3& velocity, const Vec3& sigma, const sensors::ImuHistory* imu);
+    // 位置 + 姿态（VIO / SLAM），attitude 为机体 → ENU
+    bool fusePose(std::int64_t tNs, const Vec3& position, const Quat& attitude, const Vec3& posSigma,
+                  const Vec3& attSigma, const sensors::ImuHistory* imu);
+
+    std::int64_t timestampNs() const noexcept { return t_; }
+    const Vec3& position() const noexcept { return x_.p; }
+    const Vec3& velocity() const noexcept { return x_.v; }
+    const Quat& attitude() const noexcept { return x_.q; }
+    const Vec3& gyroBias() const noexcept { return x_.bg; }
+    const Vec3& accelBias() const noexcept { return x_.ba; }
+    const Cov& covariance() const noexcept { return P_; }
+    const sensors::ImuSample& lastImu() const noexcept { return lastImu_; }
+    const NavigationEkfStats& stats() const noexcept { return stats_; }
+
+    // 填写 NavState 的导航字段（不含原点换算与融合状态位）
+    void fill(NavState& out) const noexcept;
+
+private:
+    struct Nominal {
+        Vec3 p{}, v{}, bg{}, ba{};
+        Quat q{{1., 0., 0., 0.}};
+    };
+    struct Snapshot {
+        std::int64_t t{0};
+        Nominal x;
+        Cov P;
+        sensors::ImuSample lastImu;
+    };
+    // 已采纳的量测：回退重放时与新量测一起按时间重新应用，晚到的量测不会抹掉其后已融合的量测
+    struct Measurement {
+        enum class Kind : std::uint8_t { Position, Velocity, Pose };
+        Kind kind{Kind::Position};
+        std::int64_t t{0};
+        std::array<double, 7> z{};      // 位置 / 速度 xyz；Pose 另带 w x y z
+        std::array<double, 6> sigma{};
+    };
+    static constexpr std::size_t kMeasurements = 32;
+
+    // 传播一个采样并按间隔保存快照
+    void step(const sensors::ImuSample& sample);
+    void saveSnapshot();
+    // 最新快照恰在当前时刻时以更新后的状态覆盖（快照须包含其时刻及之前的全部量测）
+    void refreshSnapshot();
+    // 用 imu 中 (t_, untilNs] 的采样传播，不足 untilNs 的尾段按插值补齐
+    void replayTo(const sensors::ImuHistory& imu, std::int64_t untilNs);
+    bool fuse(const Measurement& m, const sensors::ImuHistory* imu);
+    bool apply(const Measurement& m, bool replaying);
+    template <std::size_t M>
+    bool update(const core::Vector<double, M>& residual, const core::Matrix<double, M, kStates>& H,
+                const core::Matrix<double, M, M>& R, int& rejects, bool replaying);
+    void inject(const core::Vector<double, kStates>& dx);
+
+    NavigationEkfConfig cfg_;
+    bool initialized_{false};
+    std::int64_t t_{0};
+    Nominal x_;
+    Cov P_;
+    sensors::ImuSample lastImu_{};
+    bool hasImu_{false};
+
+    std::array<Snapshot, kSnapshots> snapshots_{};
+    std::uint64_t snapBegin_{0}, snapEnd_{0};  // 逻辑序号区间，槽位 = 序号 % kSnapshots
+    std::array<Measurement, kMeasurements> measurements_{};
+    std::uint64_t measCount_{0};
+    std::vector<sensors::ImuSample> replay_;   // 构造时预留
+    int posRejects_{0}, velRejects_{0}, poseRejects_{0};
+    NavigationEkfStats stats_;
+};
+
+} // namespace falconmind::sdk::mission
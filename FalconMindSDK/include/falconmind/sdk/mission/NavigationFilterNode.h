@@ -0,0 +1,108 @@
+// FalconMindSDK - 导航滤波节点：IMU 历史全速率传播，GNSS / VIO 量测延迟补偿融合，结果写入任务黑板
+#pragma once
+
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/mission/Blackboard.h"
+#include "falconmind/sdk/mission/LocalEnuFrame.h"
+#include "falconmind/sdk/mission/NavigationEkf.h"
+#include "falconmind/sdk/perception/PoseTypes.h"
+#include "falconmind/sdk/sensors/ImuHistory.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace falconmind::sdk::mission {
+
+/**
+ * NavigationFilterNode
+ *
+ * process() 先把 ImuHistory 中新到的全部采样送入 NavigationEkf 传播（与流水线调度频率无关，不丢采样），
+ * 再按量测时刻顺序融合 Pad 收到的量测，最后发布 NavState：写入黑板 bb::Navigation 并从 nav_out 推出。
+ * 输入 Pad（推送线程只把量测放入定长队列，滤波计算都在 process() 线程）：
+ * - gnss_in：sensors::GnssSample（GnssSourceNode::gnss_out）。时间戳为到达时刻，减去 gnss_delay_ms 作为定位时刻；
+ *   有 UBX 精度时按 hAcc / vAcc，否则按 DOP × gnss_uere_m 给出量测噪声；UBX 速度同时作为速度量测
+ * - vio_in：perception::Pose3D 或 PoseWithCovariance（VisualSlamNode / LidarSlamNode::pose_out），时间戳为图像 / 点云
+ *   采集时刻。VIO 坐标系在滤波航向收敛后的第一帧与导航系对齐（航向与平移），之后作为位置 + 姿态量测
+ * 滤波由第一个有效 GNSS 定位初始化（未配置原点时以该定位为原点）；配置了原点且无 GNSS 时由第一帧 VIO 初始化，
+ * 视原点为起飞点、VIO 航向为准。未传入黑板时节点自建一个，经 blackboard() 交给行为树。
+ *
+ * 参数：origin_lat / origin_lon / origin_alt、gnss_delay_ms（默认 80）、gnss_uere_m（默认 3）、max_delay_ms（默认 500）、
+ * vio_pos_sigma_m（默认 0.1）、vio_att_sigma_rad（默认 0.02）、accel_noise、gyro_noise、fusion_timeout_ms（默认 1000）
+ */
+class NavigationFilterNode : public core::Node {
+public:
+    static constexpr std::size_t kQueueCapacity = 32;
+
+    explicit NavigationFilterNode(sensors::ImuHistoryPtr imu, MissionBlackboardPtr board = nullptr);
+
+    const MissionBlackboardPtr& blackboard() const noexcept { return board_; }
+    const sensors::ImuHistoryPtr& imuHistory() const noexcept { return imu_; }
+    // 以下访问须在 process() 所在线程（或节点停止后）
+    const NavigationEkf& filter() const noexcept { return ekf_; }
+    const LocalEnuFrame& frame() const noexcept { return frame_; }
+    bool hasOrigin() const noexcept { return hasOrigin_; }
+    // 设置局部 ENU 原点（已初始化的滤波随之重置）
+    void setOrigin(const GeoPoint& origin);
+    // 替换滤波参数（重置滤波，原点保留）
+    void setFilterConfig(const NavigationEkfConfig& cfg);
+
+    // 队列已满而丢弃的量测数 / 长度或内容无效的输入数
+    std::uint64_t droppedMeasurements() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    std::uint64_t rejected() const noexcept { return rejected_.load(std::memory_order_relaxed); }
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    void process() override;
+
+private:
+    struct Pending {
+        enum class Kind : std::uint8_t { Gnss, Pose };
+        Kind kind{Kind::Gnss};
+        std::int64_t t{0};  // 量测时刻（已扣除已知延迟）
+        sensors::GnssSample gnss;
+        perception::PoseWithCovariance pose;
+        bool hasCovariance{false};
+    };
+
+    void enqueue(const Pending& m);
+    void fuseGnss(const Pending& m);
+    void fusePose(const Pending& m);
+    void publish();
+
+    sensors::ImuHistoryPtr imu_;
+    MissionBlackboardPtr board_;
+    core::Pad* navPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
+    NavigationEkf ekf_;
+    LocalEnuFrame frame_;
+    bool hasOrigin_{false};
+
+    std::int64_t gnssDelayNs_{80'000'000};
+    double gnssUereM_{3.0};
+    double vioPosSigma_{0.1};
+    double vioAttSigma_{0.02};
+    std::int64_t fusionTimeoutNs_{1'000'000'000};
+
+    std::mutex queueMutex_;
+    std::array<Pending, kQueueCapacity> queue_{};
+    std::size_t queued_{0};
+    std::array<Pending, kQueueCapacity> batch_{};  // process() 线程取出的一批
+
+    std::vector<sensors::ImuSample> imuBatch_;  // 构造时预留
+    std::uint64_t lastImuNs_{0};
+    // VIO 坐标系 → 导航系：绕天轴旋转 vioYaw_ 后平移 vioOffset_
+    bool vioAnchored_{false};
+    double vioYaw_{0.};
+    NavigationEkf::Vec3 vioOffset_{};
+    std::int64_t lastGnssNs_{0}, lastVioNs_{0};
+    std::uint64_t gnssUpdates_{0}, vioUpdates_{0};
+    std::int64_t publishedNs_{0};
+    std::uint64_t publishedUpdates_{0};
+
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> rejected_{0};
+};
+
+} // namespace falconmind::sdk::mission
@@ -1,11 +1,18 @@
 // FalconMindSDK - Search Mission Action Node for Behavior Tree
 #pragma once
 
+#include "falconmind/sdk/core/StateCheckpoint.h"
+#include "falconmind/sdk/flight/MissionUpload.h"
 #include "falconmind/sdk/mission/BehaviorTree.h"
+#include "falconmind/sdk/mission/Blackboard.h"
+#include "falconmind/sdk/mission/CoverageMap.h"
 #include "falconmind/sdk/mission/SearchTypes.h"
 #include "falconmind/sdk/mission/SearchPathPlannerNode.h"
 #include "falconmind/sdk/mission/EventReporterNode.h"
+#include "falconmind/sdk/planning/DStarLitePlanner.h"
+#include "falconmind/sdk/planning/ObstacleCloudNode.h"
 
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -33,9 +40,38 @@ public:
     void setSearchArea(const SearchArea& area);
     void setSearchParams(const SearchParams& params);
 
+    // 设置后从黑板无锁读取飞行状态，且搜索阶段只在状态更新时被重新 tick；未设置时读取 FlightConnectionService 缓存
+    void setBlackboard(MissionBlackboardPtr board) { blackboard_ = std::move(board); }
+
+    // 启用避障：每次 tick 把当前位姿交给点云节点、取走障碍点写入占据栅格（ENU 与规划器局部坐标系一致）；
+    // 到当前航点的直线被阻塞时用 D* Lite 规划绕行，地图变化时增量修复
+    void setObstacleAvoidance(std::shared_ptr<planning::ObstacleCloudNode> cloud,
+                              const planning::OccupancyGridConfig& config = {});
+    // 当前绕行的下一个中间点（沿规划路径且直线可达的最远单元中心）；无需绕行时返回 false
+    bool activeDetour(EnuPoint& next) const;
+    const planning::OccupancyGrid* occupancyGrid() const { return grid_.get(); }
+
+    // 任务上传模式：进入搜索阶段时把整条扫描航线经 MAVLink 任务协议一次性上传给飞控并以 MISSION_START 执行，
+    // 进度按 MISSION_CURRENT / MISSION_ITEM_REACHED 跟踪，免去逐航点的命令往返，伴随计算机卡顿时飞机照常飞完航线。
+    // 上传失败时退回逐航点引导；启用避障时（绕行需要逐点引导）不使用
+    void setMissionUpload(bool enabled, const flight::MissionUploadOptions& options = {});
+    bool missionUploaded() const noexcept { return uploadState_ == UploadState::Executing; }
+
+    // 热重启：首次 tick 前从 section 恢复任务阶段、航点序号、已发出的解锁 / 起飞命令、任务上传状态与覆盖位图，
+    // 之后每次 tick 结束时按区段的 periodMs 保存（内容不变时不写）。恢复后已完成的阶段不再重复：不重新解锁起飞，
+    // 从中断的航点继续，覆盖统计包含重启前扫过的区域。上传中（确认未到）的任务恢复为待上传，重新上传一次。
+    // 须在首次 tick 之前、setSearchArea / setSearchParams 之后设置
+    static constexpr std::uint32_t kStateVersion = 1;
+    void setCheckpoint(std::shared_ptr<core::CheckpointSection> section) { checkpoint_ = std::move(section); }
+    bool restoredFromCheckpoint() const noexcept { return restored_; }
+    int currentWaypointIndex() const noexcept { return currentWaypointIndex_; }
+
     // BehaviorNode 接口
     NodeStatus tick() override;
 
+    // 覆盖位图（进入搜索阶段后有效），可用于查询未覆盖单元做补扫
+    const CoverageMap* coverageMap() const { return coverage_.get(); }
+
 private:
     // 任务状态
     enum class MissionState {
@@ -48,11 +84,39 @@ private:
         COMPLETE
     };
 
+    enum class UploadState {
+        Off,        // 逐航点引导
+        Pending,    // 等待进入搜索阶段后上传
+        Uploading,
+        Executing,  // 飞控执行已上传的任务
+        Failed,     // 上传失败，已退回逐航点引导
+    };
+
+    // 按任务阶段推进一步（tick() 在其前后处理检查点）
+    NodeStatus advance();
+    void saveState(core::CheckpointWriter& out) const;
+    bool restoreState(core::CheckpointReader& in);
+    // 按规划器的区域创建覆盖位图（尚无区域时返回 false）
+    bool ensureCoverage();
+
+    // 读取当前飞行状态（黑板模式下登记等待下一次写入）；暂无状态返回 false
+    bool readFlightState(flight::FlightState& state);
     // 执行航点任务
     NodeStatus executeWaypointMission();
+    // 上传整条航线并跟踪飞控执行进度；返回 Failure 之外的状态，上传失败时转为逐航点引导
+    NodeStatus executeUploadedMission();
+    // 上报到达第 index 个航点的事件与搜索进度
+    void reportWaypointReached(std::size_t index, const GeoPoint& currentPos);
+    
+    // 按当前位置与航向的相机足迹更新覆盖位图（每次 tick 调用）
+    void updateCoverage(const GeoPoint& currentPos, double yaw);
     
-    // 检查是否到达航点
-    bool isWaypointReached(const GeoPoint& waypoint, const GeoPoint& currentPos, double tolerance = 5.0);
+    // 检查是否到达第 index 个航点：当前位置换算到规划器的局部 ENU 后与缓存的航点 ENU 比较水平距离平方，
+    // 高度直接比较海拔
+    bool isWaypointReached(std::size_t index, const GeoPoint& currentPos, double tolerance = 5.0) const;
+
+    // 更新占据栅格并按需规划 / 修复到第 index 个航点的绕行路径
+    void updateDetour(std::size_t index, const GeoPoint& currentPos, double yaw);
 
     flight::FlightConnectionService& flightSvc_;
     std::shared_ptr<SearchPathPlannerNode> pathPlanner_;
@@ -62,8 +126,34 @@ private:
     SearchParams searchParams_;
     MissionState state_{MissionState::IDLE};
     int currentWaypointIndex_{0};
+    std::unique_ptr<CoverageMap> coverage_;
+    MissionBlackboardPtr blackboard_;
+
+    // 避障（setObstacleAvoidance 后有效）
+    std::shared_ptr<planning::ObstacleCloudNode> obstacleCloud_;
+    std::unique_ptr<planning::OccupancyGrid> grid_;
+    std::unique_ptr<planning::DStarLitePlanner> dstar_;
+    std::vector<float> obstacleEast_, obstacleNorth_;
+    std::vector<std::uint32_t> changedCells_;
+    std::vector<planning::GridCell> detourCells_;
+    int detourWaypoint_{-1};
+    bool hasDetour_{false};
+    EnuPoint detourPoint_{};
     bool armingDone_{false};
     bool takeoffDone_{false};
+
+    // 任务上传模式
+    UploadState uploadState_{UploadState::Off};
+    flight::MissionUploadOptions uploadOptions_{};
+    std::future<flight::MissionUploadAck> upload_;
+    std::uint64_t uploadStateSeq_{0};  // 开始上传时的飞行状态序号：此前的任务进度属于旧任务
+
+    // 热重启
+    std::shared_ptr<core::CheckpointSection> checkpoint_;
+    bool checkpointChecked_{false};
+    bool restored_{false};
+    MissionState lastSavedState_{MissionState::IDLE};
+    int lastSavedWaypoint_{0};
 };
 
 } // namespace falconmind::sdk::mission
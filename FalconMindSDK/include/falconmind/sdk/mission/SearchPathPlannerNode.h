@@ -2,16 +2,29 @@
 #pragma once
 
 #include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/mission/CoverageSweep.h"
+#include "falconmind/sdk/mission/Geofence.h"
+#include "falconmind/sdk/mission/LocalEnuFrame.h"
+#include "falconmind/sdk/mission/MultiUavCoveragePlanner.h"
 #include "falconmind/sdk/mission/SearchTypes.h"
+#include "falconmind/sdk/mission/Trajectory.h"
+#include "falconmind/sdk/perception/TerrainTileCache.h"
 
-#include <vector>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace falconmind::sdk::mission {
 
 /**
  * 搜索路径规划节点
  * 根据搜索区域和参数生成搜索路径（航点列表）
+ * 以搜索区域边界框中心为原点建立局部 ENU 坐标系，规划全程以米为单位，最后一次性换算回经纬度
+ * 设置编队（setTeam，或 configure 参数 team = "uav1,uav2:1.5,..."、uav_id）后，网格搜索只规划本机分得的条带
+ * （MultiUavCoveragePlanner）；队友掉线时更新 team 重新 start() 即可本地重规划
+ * 挂接地形（setTerrain，或参数 terrain_file）后 start() 沿航线预取 DEM 瓦片；开启地形跟随时 SearchParams.altitude
+ * 视为离地高度：各航段按 terrain_spacing（米，默认 30）采样地形，航点高度 = 地形 + altitude，
+ * 与相邻保留点线性插值相差不超过 terrain_tolerance（米，默认 3）的采样点被剔除
  */
 class SearchPathPlannerNode : public core::Node {
 public:
@@ -21,9 +34,21 @@ public:
     // 配置搜索区域和参数
     void setSearchArea(const SearchArea& area);
     void setSearchParams(const SearchParams& params);
+    // 编队成员与本机 id；成员少于 2 个或本机不在其中时按单机规划
+    void setTeam(const std::vector<CoverageMember>& team, const std::string& selfId);
+    // 地形瓦片缓存（可与 GeoProjector 的 GroundElevationModel 共享）；follow 为地形跟随
+    void setTerrain(std::shared_ptr<const perception::TerrainTileCache> terrain, bool follow = true);
 
     // 获取生成的航点列表
     const std::vector<GeoPoint>& getWaypoints() const { return waypoints_; }
+    // 同一航点列表的局部 ENU 坐标（米，up 为 0）及所用坐标系，供到点判断 / 覆盖统计使用
+    const std::vector<EnuPoint>& getWaypointsEnu() const { return waypointsEnu_; }
+    const LocalEnuFrame& frame() const { return frame_; }
+    // 由航点生成的平滑、带速度剖面的轨迹（巡航速度取 SearchParams.speed，高度取 SearchParams.altitude），
+    // start() 后有效；trajectory().sample() 得到带时间戳的设定点
+    const TrajectoryGenerator& trajectory() const { return trajectory_; }
+    // 搜索区域（外边界 + 孔洞）在 ENU 平面中的坐标，start() 后有效
+    const std::vector<std::vector<PlanarPoint>>& getAreaRings() const { return rings_; }
 
     // Node 接口实现
     bool configure(const std::unordered_map<std::string, std::string>& params) override;
@@ -32,7 +57,7 @@ public:
     void process() override;
 
 private:
-    // 生成网格搜索路径（蛇形）
+    // 生成网格搜索路径（蛇形）：扫描线与多边形（含孔洞）求交，见 CoverageSweep
     void generateLawnMowerPath();
     
     // 生成螺旋搜索路径
@@ -44,28 +69,38 @@ private:
     // 生成扇形搜索路径
     void generateSectorPath();
     
-    // 计算多边形的边界框
-    void computeBoundingBox(const std::vector<GeoPoint>& polygon,
-                           double& minLat, double& maxLat,
-                           double& minLon, double& maxLon);
+    // 建立局部坐标系并把搜索区域（外边界 + 孔洞）换算到 ENU 平面
+    void projectArea();
     
-    // 检查点是否在多边形内（射线法）
-    bool isPointInPolygon(const GeoPoint& point, const std::vector<GeoPoint>& polygon);
+    // 计算区域外边界在 ENU 平面的边界框
+    void computeBoundingBox(double& minE, double& maxE, double& minN, double& maxN) const;
     
-    // 计算两点之间的距离（米）
-    double calculateDistance(const GeoPoint& p1, const GeoPoint& p2);
+    // 检查点是否在搜索区域内（GeofenceIndex 单元查询，奇偶规则，孔洞内返回 false）
+    bool isPointInArea(double east, double north) const;
     
     // 优化路径：移除重复点、优化航点顺序
     void optimizePath();
-    
-    // 在多边形内生成网格点
-    std::vector<GeoPoint> generateGridPoints(double minLat, double maxLat,
-                                             double minLon, double maxLon,
-                                             double latSpacing, double lonSpacing);
+
+    // 按搜索参数对航点做拐角平滑与时间参数化
+    void buildTrajectory();
+
+    // 地形跟随：加密航段、航点高度取地形 + 离地高度，再按容差精简
+    void applyTerrainFollowing();
 
     SearchArea searchArea_;
     SearchParams searchParams_;
     std::vector<GeoPoint> waypoints_;
+    LocalEnuFrame frame_;
+    std::vector<std::vector<PlanarPoint>> rings_;  // ENU 平面中的外边界与孔洞
+    GeofenceIndex areaIndex_;                       // rings_ 的包含查询索引
+    TrajectoryGenerator trajectory_;
+    std::vector<EnuPoint> waypointsEnu_;
+    std::vector<CoverageMember> team_;
+    std::string selfId_;
+    std::shared_ptr<const perception::TerrainTileCache> terrain_;
+    bool terrainFollowing_{false};
+    double terrainSpacing_{30.0};
+    double terrainTolerance_{3.0};
     bool configured_{false};
 };
 
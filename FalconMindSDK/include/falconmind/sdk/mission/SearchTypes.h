@@ -1,6 +1,7 @@
 // FalconMindSDK - Search Mission Types
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -27,6 +28,7 @@ struct SearchArea {
     std::vector<GeoPoint> polygon;  // 多边形顶点（至少3个点）
     double minAltitude;             // 最小飞行高度（米）
     double maxAltitude;             // 最大飞行高度（米）
+    std::vector<std::vector<GeoPoint>> holes;  // 禁飞 / 排除区（每个至少3个点，可为空）
 };
 
 // 搜索参数
@@ -38,6 +40,11 @@ struct SearchParams {
     double loiterTime;              // 每个航点悬停时间（秒）
     bool enableDetection;           // 是否启用目标检测
     std::vector<std::string> detectionClasses; // 关注的检测类别
+    double sweepAngle{0.0};         // 网格搜索扫描线方向（度，逆时针，0 为东西向）
+    double cameraHfov{0.0};         // 垂直向下相机横向 / 前向视场角（度），用于覆盖统计；0 表示足迹取 spacing 见方
+    double cameraVfov{0.0};
+    double maxAcceleration{2.0};    // 轨迹生成的切向 / 向心加速度上限（m/s²）
+    double cornerTolerance{5.0};    // 拐角圆弧离原航点的最大偏差（米，0 为不平滑）
 };
 
 // 搜索进度
@@ -54,7 +61,8 @@ enum class SearchEventType {
     INTEREST_POINT,     // 兴趣点
     ANOMALY,            // 异常
     WAYPOINT_REACHED,   // 到达航点
-    SEARCH_COMPLETE     // 搜索完成
+    SEARCH_COMPLETE,    // 搜索完成
+    TARGET_UPDATED      // 已上报目标的最高置信度提升（位置随之更新）
 };
 
 // 搜索事件
@@ -64,6 +72,7 @@ struct SearchEvent {
     GeoPoint position;
     int64_t timestampNs;           // 时间戳（纳秒）
     std::string metadata;           // 额外元数据（JSON 字符串）
+    std::vector<std::uint8_t> thumbnailJpeg;  // 目标缩略图（JPEG，见 EventThumbnailer），可为空
 };
 
 } // namespace falconmind::sdk::mission
@@ -0,0 +1,85 @@
+// FalconMindSDK - 航线平滑与时间参数化：拐角圆弧过渡 + 加速度受限速度剖面，输出带时间戳的设定点
+#pragma once
+
+#include "falconmind/sdk/mission/LocalEnuFrame.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace falconmind::sdk::mission {
+
+struct TrajectoryLimits {
+    double cruiseSpeed{5.0};      // 巡航速度（m/s，通常取 SearchParams.speed）
+    double maxAccel{2.0};         // 切向加 / 减速度上限（m/s²）
+    double maxLateralAccel{2.0};  // 圆弧上的向心加速度上限（m/s²）：v ≤ √(a · R)
+    double cornerTolerance{5.0};  // 圆弧离原拐点的最大偏差（米），0 为不做圆弧（拐点处减速到 0）
+    double sampleInterval{0.1};   // 设定点时间间隔（秒）
+};
+
+struct TrajectorySetpoint {
+    double t{0.0};  // 自起点的时间（秒）
+    double east{0.0};
+    double north{0.0};
+    double up{0.0};
+    double ve{0.0};  // 速度（m/s，ENU）
+    double vn{0.0};
+    double vu{0.0};
+    double yaw{0.0};  // 航迹方向（弧度，自北顺时针）
+};
+
+/**
+ * TrajectoryGenerator
+ *
+ * 每个内部拐点用与两段相切的圆弧替换：半径取“离拐点偏差 ≤ cornerTolerance”与“切点不超过相邻段
+ * 一半长度”两者允许的最大值；高度沿各段线性插值。路径由直线 / 圆弧基元组成，
+ * 速度上限为巡航速度（圆弧再受向心加速度限制），经前向 / 后向两遍扫描得到基元交界处的可行速度
+ * （起终点为 0），基元内为加速 - 匀速 - 减速梯形剖面，时间按解析式累加。
+ * 规划与采样都是对航点 / 设定点的单遍线性计算，结果缓冲在多次 generate() 间复用。
+ */
+class TrajectoryGenerator {
+public:
+    // 由航点生成轨迹；少于 1 个航点或限制无效返回 false
+    bool generate(const std::vector<EnuPoint>& waypoints, const TrajectoryLimits& limits);
+
+    // 按 sampleInterval 采样（含终点）；返回设定点数
+    std::size_t sample(std::vector<TrajectorySetpoint>& out) const;
+    // 任意时刻的设定点（t 截断到 [0, duration]）
+    TrajectorySetpoint at(double t) const noexcept;
+
+    double duration() const noexcept { return duration_; }
+    double length() const noexcept { return length_; }
+    std::size_t primitiveCount() const noexcept { return prims_.size(); }
+    std::size_t arcCount() const noexcept { return arcs_; }
+
+private:
+    struct Primitive {
+        // 直线：起点 (x0, y0)、水平增量 (dx, dy)；圆弧：圆心 (cx, cy)、半径、起始角、转角（逆时针为正）
+        bool arc{false};
+        double x0{0.0}, y0{0.0}, dx{0.0}, dy{0.0};
+        double cx{0.0}, cy{0.0}, radius{0.0}, angle0{0.0}, turn{0.0};
+        double up0{0.0}, up1{0.0};
+        double length{0.0};
+        double vmax{0.0};
+        double capIn{0.0};  // 入口速度上限（尖角处为 0）
+        // 速度剖面
+        double v0{0.0}, v1{0.0}, vpeak{0.0};
+        double tAcc{0.0}, tCruise{0.0}, tDec{0.0}, sAcc{0.0}, sCruise{0.0};
+        double tStart{0.0};
+    };
+
+    void addLine(double x0, double y0, double x1, double y1, double up0, double up1);
+    void profile();
+    void evaluate(const Primitive& p, double tau, TrajectorySetpoint& sp) const noexcept;
+
+    TrajectoryLimits limits_;
+    std::vector<Primitive> prims_;
+    std::vector<EnuPoint> points_;  // 去重后的航点
+    double pendingCap_{0.0};
+    double duration_{0.0};
+    double length_{0.0};
+    std::size_t arcs_{0};
+    EnuPoint single_{};
+};
+
+} // namespace falconmind::sdk::mission
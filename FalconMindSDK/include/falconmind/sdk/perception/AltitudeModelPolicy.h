@@ -0,0 +1,99 @@
+// FalconMindSDK - AltitudeModelPolicy：按离地高度与相机视场选择检测模型变体（输入尺寸 / 切片），使目标像素落在模型的有效区间
+#pragma once
+
+#include "falconmind/sdk/flight/FlightTypes.h"
+#include "falconmind/sdk/perception/DetectionTypes.h"
+#include "falconmind/sdk/perception/GeoProjection.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+// 一个可选的检测器（PerceptionPluginManager 中的 detectorId）及决定目标像素与开销的参数
+struct ModelVariant {
+    std::string detectorId;
+    int inputWidth{640};
+    int inputHeight{640};
+    int tileWidth{0};  // 0 为整帧推理
+    int tileHeight{0};  // 0 时取 tileWidth
+    float tileOverlap{0.2f};
+    bool tileFullFrame{true};
+
+    // 取 desc 的输入尺寸与 tile* 字段（与 TiledDetectorBackend 的默认规则一致）
+    static ModelVariant fromDescriptor(const DetectorDescriptor& desc);
+};
+
+struct AltitudeModelPolicyConfig {
+    double hfovDeg{70.};       // 相机水平视场角（度）
+    double targetSizeM{1.5};   // 典型目标尺寸（米），如行人 / 车辆的较短边
+    double minTargetPx{16.};   // 目标在模型输入上的像素下限：低于时漏检明显
+    double maxTargetPx{128.};  // 上限：超过时分辨率（算力）浪费
+    double hysteresis{0.15};   // 切换到其他变体须越过区间边界的相对余量，避免在边界附近反复切换
+    double minAglM{2.};        // 离地高度下限（起降阶段 relativeAlt 不可靠）
+};
+
+/**
+ * AltitudeModelPolicy - 高度自适应的模型选择
+ *
+ * 由飞行状态得到相机到地面的距离：离地高度取 relativeAlt（设置了 DEM 网格时为 alt 减去地面海拔），
+ * 给出云台姿态时按相机俯角换算为斜距（俯角下限 10°）。目标在模型输入上的像素数
+ *   targetSizeM × 帧宽 / (2 × 距离 × tan(hfov/2)) × 模型输入相对整帧（切片时相对切片）的缩放
+ * select() 在目标像素落入 [minTargetPx, maxTargetPx] 的变体中取开销最小者（输入像素 × 每帧推理次数）；
+ * 均不在区间内时取满足下限的最小开销者，仍没有则取目标像素最大者（高空时尽力而为）。
+ * 当前变体按放宽 hysteresis 的区间判断，其他变体按收紧的区间判断。
+ * setResourceCap() 设置资源上限（如 ThermalGovernor 过热降级）时只在不超上限的变体中选择，
+ * 全部超限时取开销最小者；尚无高度信息时当前变体超限也会换成上限内开销最小者。线程安全。
+ */
+class AltitudeModelPolicy {
+public:
+    explicit AltitudeModelPolicy(std::vector<ModelVariant> variants, AltitudeModelPolicyConfig config = {});
+
+    // 可选：DEM 网格（未设置网格时按 relativeAlt）
+    void setGroundElevation(std::shared_ptr<const GroundElevationModel> dem);
+    // 飞控线程调用；state 须带位置组（FlightField::Position），否则忽略。gimbal 为空时视为垂直向下
+    void updateFlightState(const flight::FlightState& state, const GimbalPose* gimbal = nullptr);
+    // 直接给出相机到地面的距离（米），用于无飞控的场景与仿真
+    void setRange(double rangeM);
+    // 相机到地面的距离；尚无高度信息时为 0
+    double rangeM() const;
+
+    // 资源上限：模型输入较长边不超过 maxInputSide、每帧推理次数（切片数 + 整帧）不超过 maxInferences；0 为不限。
+    // 下一次 select() 生效
+    void setResourceCap(int maxInputSide, std::size_t maxInferences);
+    int maxInputSide() const;
+    std::size_t maxInferences() const;
+
+    // 按当前距离为 imageWidth×imageHeight 的帧选择变体；尚无高度信息时保持当前变体（初始为第一个）
+    const ModelVariant& select(int imageWidth, int imageHeight);
+    const ModelVariant& current() const;
+    const std::vector<ModelVariant>& variants() const noexcept { return variants_; }
+    const AltitudeModelPolicyConfig& config() const noexcept { return config_; }
+    // select() 改变选择的次数
+    std::uint64_t switches() const;
+
+    // 目标在 variant 模型输入上的像素数（距离 rangeM，帧 imageWidth×imageHeight）
+    static double targetPixels(const ModelVariant& variant, double rangeM, double hfovDeg, double targetSizeM,
+                               int imageWidth, int imageHeight);
+    // 每帧推理次数：整帧为 1，切片时为切片数（tileFullFrame 时另加整帧一次）
+    static std::size_t inferenceRuns(const ModelVariant& variant, int imageWidth, int imageHeight);
+    // 每帧推理开销：模型输入像素 × 推理次数
+    static double frameCost(const ModelVariant& variant, int imageWidth, int imageHeight);
+
+private:
+    std::vector<ModelVariant> variants_;
+    AltitudeModelPolicyConfig config_;
+    mutable std::mutex mutex_;
+    std::shared_ptr<const GroundElevationModel> dem_;
+    double rangeM_{0.};
+    int maxInputSide_{0};
+    std::size_t maxInferences_{0};
+    std::size_t current_{0};
+    std::uint64_t switches_{0};
+};
+
+} // namespace falconmind::sdk::perception
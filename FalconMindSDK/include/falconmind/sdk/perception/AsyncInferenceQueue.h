@@ -0,0 +1,59 @@
+// FalconMindSDK - 异步推理队列：把阻塞的 run() 包装为在途深度有界的 submit() / 完成回调
+#pragma once
+
+#include "falconmind/sdk/perception/IDetectorBackend.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * AsyncInferenceQueue - IDetectorBackend::submit() 的公共实现
+ *
+ * workers 个常驻推理线程各自取任务调用 backend.run()，workers 应等于后端可并发的 run() 路数
+ * （RKNN 上下文数、TensorRT stream 数；ONNXRuntime 为 1），各路的拷贝 / 推理由后端自身的上下文 / stream 隔离。
+ * 在途（排队 + 执行中）上限 depth：达到时 submit() 阻塞，调用方因此获得背压而不会无限排队。
+ * 回调在推理线程上、任务计为完成之前调用。后端在 load() 成功后创建、unload() 时先于推理状态销毁。
+ */
+class AsyncInferenceQueue {
+public:
+    // depth 为 0 时取 2 × workers（每路一帧在跑、一帧排队）
+    AsyncInferenceQueue(IDetectorBackend& backend, std::size_t workers, std::size_t depth = 0);
+    ~AsyncInferenceQueue();  // 等待在途任务完成后结束线程
+    AsyncInferenceQueue(const AsyncInferenceQueue&) = delete;
+    AsyncInferenceQueue& operator=(const AsyncInferenceQueue&) = delete;
+
+    bool submit(const ImageView& image, DetectionResult& outResult, IDetectorBackend::DetectionCallback done);
+    // 阻塞到在途任务全部完成
+    void drain();
+
+    std::size_t workers() const noexcept { return threads_.size(); }
+    std::size_t depth() const noexcept { return depth_; }
+    std::size_t inFlight() const;
+
+private:
+    struct Job {
+        ImageView image;
+        DetectionResult* out{nullptr};
+        IDetectorBackend::DetectionCallback done;
+    };
+
+    void workerLoop();
+
+    IDetectorBackend& backend_;
+    std::size_t depth_;
+    mutable std::mutex mutex_;
+    std::condition_variable jobCv_;    // 有任务或停止
+    std::condition_variable spaceCv_;  // 有空位或全部完成
+    std::deque<Job> jobs_;
+    std::size_t inFlight_{0};
+    bool stopping_{false};
+    std::vector<std::thread> threads_;
+};
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,113 @@
+// FalconMindSDK - ByteTrack 风格跟踪后端
+// 匀速卡尔曼滤波（状态 cx, cy, a=w/h, h 及其速度，8×8 / 4×8 定尺寸矩阵）+ 高 / 低分两阶段 IoU 最优分配。
+#pragma once
+
+#include "falconmind/sdk/core/FixedMatrix.h"
+#include "falconmind/sdk/perception/ITrackerBackend.h"
+#include "falconmind/sdk/perception/LinearAssignment.h"
+#include "falconmind/sdk/perception/TrackingTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+using KalmanState = core::Vector<float, 8>;
+using KalmanCovariance = core::Matrix<float, 8, 8>;
+
+struct ByteTrackState {
+    int trackId{0};
+    KalmanState mean;            // cx, cy, a, h, vcx, vcy, va, vh（速度单位：每秒）
+    KalmanCovariance covariance;
+    std::uint64_t stateNs{0};    // mean 对应的时刻（最近一次预测 / 更新）
+    std::uint64_t lastUpdateNs{0};
+    int missedFrames{0};         // 连续未匹配的检测帧数（predict 外推帧不计）
+    int hits{0};
+    float score{0.f};
+    int classId{-1};
+    std::string className;
+    // 轨迹历史环形缓冲（创建时按容量一次分配）
+    std::vector<TrackHistoryPoint> history;
+    std::uint32_t historyOldest{0};
+    std::uint32_t historyCount{0};
+};
+
+/**
+ * ByteTrackerBackend
+ *
+ * 每帧先把所有轨迹按 timestampNs 差值预测到当前帧（时间戳缺失 / 不递增时按 framePeriodNs），
+ * 因此上游丢帧或 InferenceRateController 跳过检测时预测位置仍与真实时间对齐。
+ * 关联分两阶段：高分检测（>= highScoreThreshold）与全部轨迹匹配（IoU > firstMatchIou）；
+ * 剩余低分检测（>= lowScoreThreshold）只与上一帧仍在跟踪的轨迹匹配（IoU > secondMatchIou），
+ * 用于找回遮挡 / 模糊时分数下降的目标而不新建轨迹。未匹配的高分检测（>= newTrackThreshold）新建轨迹。
+ * 连续 maxMissedFrames 帧未匹配的轨迹输出 LOST，下一次 run / predict 时移除（保证 LOST 状态的 history 视图有效）。
+ * TrackingState::uncertainty 取位置协方差标准差 / 目标尺寸。
+ */
+class ByteTrackerBackend : public ITrackerBackend {
+public:
+    ByteTrackerBackend();
+    ~ByteTrackerBackend() override;
+
+    bool load() override;
+    void unload() override;
+    bool isLoaded() const override { return loaded_; }
+
+    bool run(DetectionResult& detections, TrackingResult& outTracks) override;
+    // 无检测帧：按时间戳预测到当前帧，不计漏检；状态为 PREDICTED，预测框写入 detections
+    bool predict(DetectionResult& detections, TrackingResult& outTracks) override;
+
+    void setHighScoreThreshold(float t) { highScoreThreshold_ = t; }
+    void setLowScoreThreshold(float t) { lowScoreThreshold_ = t; }
+    void setNewTrackThreshold(float t) { newTrackThreshold_ = t; }
+    void setFirstMatchIou(float t) { firstMatchIou_ = t; }
+    void setSecondMatchIou(float t) { secondMatchIou_ = t; }
+    void setMaxMissedFrames(int n) { maxMissedFrames_ = n; }
+    // 每条轨迹的历史容量（对之后新建的轨迹生效）
+    void setMaxTrajectoryPoints(int n) { maxTrajectoryPoints_ = n > 0 ? n : 1; }
+    // 时间戳不可用时的名义帧间隔；同时作为过程噪声的时间单位
+    void setFramePeriodNs(std::uint64_t ns) { framePeriodNs_ = ns > 0 ? ns : 1; }
+    // 位置 / 速度噪声相对目标高度的比例（每名义帧）
+    void setNoiseWeights(float position, float velocity) {
+        stdWeightPosition_ = position;
+        stdWeightVelocity_ = velocity;
+    }
+
+    const std::vector<ByteTrackState>& tracks() const noexcept { return tracks_; }
+
+private:
+    void initiate(ByteTrackState& t, const DetectionBBox& box) const;
+    void predictTo(ByteTrackState& t, std::uint64_t ts) const;
+    void update(ByteTrackState& t, const Detection& det, std::uint64_t ts);
+    DetectionBBox stateBox(const ByteTrackState& t) const;
+    float uncertaintyOf(const ByteTrackState& t) const;
+    void pushHistory(ByteTrackState& t, const TrackHistoryPoint& p) const;
+    void writeState(const ByteTrackState& t, const char* status, TrackingState& out) const;
+
+    bool loaded_{false};
+    int nextTrackId_{1};
+    float highScoreThreshold_{0.5f};
+    float lowScoreThreshold_{0.1f};
+    float newTrackThreshold_{0.6f};
+    float firstMatchIou_{0.2f};
+    float secondMatchIou_{0.5f};
+    int maxMissedFrames_{30};
+    int maxTrajectoryPoints_{100};
+    std::uint64_t framePeriodNs_{33333333};
+    float stdWeightPosition_{1.f / 20.f};
+    float stdWeightVelocity_{1.f / 160.f};
+    std::vector<ByteTrackState> tracks_;
+
+    // 每帧复用的关联缓冲
+    std::vector<DetectionBBox> detBoxes_;
+    std::vector<DetectionBBox> trackBoxes_;
+    std::vector<bool> trackEnabled_;
+    std::vector<bool> trackMatched_;
+    std::vector<std::size_t> highIdx_;
+    std::vector<std::size_t> lowIdx_;
+    std::vector<AssignmentCandidate> candidates_;
+    std::vector<int> assignment_;
+};
+
+} // namespace falconmind::sdk::perception
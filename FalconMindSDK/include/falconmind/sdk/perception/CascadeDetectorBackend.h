@@ -0,0 +1,72 @@
+// FalconMindSDK - 级联检测：小模型整帧低阈值筛选候选，大模型只在候选裁剪区域上确认（大模型精度、接近小模型的开销）
+#pragma once
+
+#include "falconmind/sdk/perception/IDetectorBackend.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * CascadeDetectorBackend - 两级检测后端
+ *
+ * - 筛选：screen（小模型）以 DetectorDescriptor::cascadeScreenThreshold 对整帧推理，得到候选框
+ * - 采纳：分数不低于 cascadeAcceptThreshold 的候选直接输出，不再确认
+ * - 裁剪：其余候选按框中心取 cascadeCropScale 倍框长、至少 cascadeMinCrop 的方形区域（贴合帧边界）；
+ *   已被某个裁剪区域完整包含的候选共用该区域。裁剪是原帧的子视图，不拷贝像素，大模型前处理直接读原帧缓冲
+ * - 确认：裁剪区域按 confirm（大模型）的 maxBatchSize() 分批 runBatch()；结果平移回整帧坐标，
+ *   低于 cascadeConfirmThreshold 或贴着裁剪内部边界（截断）的框丢弃，跨区域重复的框按同类 IoU 去重
+ * - 候选超过 cascadeMaxCrops 时大模型直接整帧推理；非 RGB8/BGR8 帧（无法取子视图）同样整帧交给大模型
+ * run() 须串行调用（maxConcurrentRuns() 为 1）
+ */
+class CascadeDetectorBackend : public IDetectorBackend {
+public:
+    // confirm 须已 load（PerceptionPluginManager 按 cascadeDetectorId 的描述加载）；screen 在 load() 时加载
+    CascadeDetectorBackend(DetectorBackendPtr screen, DetectorBackendPtr confirm);
+
+    DetectionBackendType backendType() const override;
+
+    // 以 desc（scoreThreshold 换为 cascadeScreenThreshold）加载 screen，并读取 desc 的 cascade* 字段
+    bool load(const DetectorDescriptor& desc) override;
+    void unload() override;
+    bool isLoaded() const override;
+
+    bool run(const ImageView& image, DetectionResult& outResult) override;
+
+    std::vector<core::PixelFormat> supportedPixelFormats() const override;
+    bool setNpuCoreMask(std::uint32_t mask) override;
+    bool setClassFilter(const std::vector<int>& classIds) override;
+
+    const DetectorBackendPtr& screen() const noexcept { return screen_; }
+    const DetectorBackendPtr& confirm() const noexcept { return confirm_; }
+    // 最近一帧的候选数、直接采纳数与送大模型的裁剪区域（整帧坐标）
+    std::size_t lastCandidates() const noexcept { return lastCandidates_; }
+    std::size_t lastAccepted() const noexcept { return lastAccepted_; }
+    const std::vector<DetectionBBox>& lastCrops() const noexcept { return crops_; }
+    // 因候选过多或帧格式而整帧确认的次数
+    std::uint64_t fullFrameConfirms() const noexcept { return fullFrameConfirms_; }
+
+private:
+    bool confirmFullFrame(const ImageView& image, DetectionResult& outResult);
+    void buildCrops(int width, int height);
+    bool touchesInnerEdge(const DetectionBBox& crop, const DetectionBBox& box, int width, int height) const;
+    void mergeDetections(std::vector<Detection>& detections) const;
+
+    DetectorBackendPtr screen_;
+    DetectorBackendPtr confirm_;
+    DetectorDescriptor desc_;
+    bool loaded_{false};
+
+    DetectionResult screenResult_;
+    std::vector<Detection> candidates_;  // 待确认的候选（整帧坐标）
+    std::vector<DetectionBBox> crops_;
+    std::vector<ImageView> views_;
+    std::vector<DetectionResult> results_;
+    std::size_t lastCandidates_{0};
+    std::size_t lastAccepted_{0};
+    std::uint64_t fullFrameConfirms_{0};
+};
+
+} // namespace falconmind::sdk::perception
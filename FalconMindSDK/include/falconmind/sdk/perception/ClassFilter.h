@@ -0,0 +1,37 @@
+// FalconMindSDK - 关注类别（任务 SearchParams::detectionClasses → 检测后端类别掩码）
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+// COCO-80 类别名（YOLO 系列默认标签，下标即类别 ID）
+const std::vector<std::string>& cocoClassLabels();
+
+// 读取标签文件（每行一个类别名，忽略空行与行尾空白）；打不开时返回空
+std::vector<std::string> loadClassLabels(const std::string& path);
+
+/**
+ * 类别名 → 类别 ID（升序、去重）。名称不区分大小写地与 labels 匹配，也可直接写数字 ID；
+ * "vehicle" 展开为 labels 中的 car / motorcycle / bus / truck。无法解析的名称写入 unknown（可为 nullptr）
+ */
+std::vector<int> resolveClassIds(const std::vector<std::string>& names, const std::vector<std::string>& labels,
+                                 std::vector<std::string>* unknown = nullptr);
+
+// 去掉负数并升序去重（YoloDecodeConfig::classes 的要求）
+std::vector<int> normalizeClassIds(std::vector<int> ids);
+
+/**
+ * ClassOfInterestSink - 接受任务关注类别的检测节点实现此接口
+ * FlowExecutor 在 start() / 热更新时把 Flow 中搜索规划节点 search_params.detection_classes 的并集下发给全部实现者，
+ * 节点在下一次 start() 时解析为类别 ID 并设置到后端（IDetectorBackend::setClassFilter）
+ */
+class ClassOfInterestSink {
+public:
+    virtual ~ClassOfInterestSink() = default;
+    // 空为不限类别；节点参数已显式给出 classes 时以节点参数为准
+    virtual void setClassesOfInterest(const std::vector<std::string>& names) = 0;
+};
+
+} // namespace falconmind::sdk::perception
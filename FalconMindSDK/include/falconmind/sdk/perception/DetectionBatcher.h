@@ -0,0 +1,78 @@
+// FalconMindSDK - 批推理汇聚：多路相机的帧攒成一个 batch 交给 backend->runBatch()
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/perception/IDetectorBackend.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * DetectionBatcher - 攒批执行检测（GPU 上 batch 4 的吞吐约为逐帧的 3 倍）
+ *
+ * - 任意线程（如各路相机的采集线程）submit 帧，标注来源 stream
+ * - 单个推理线程在凑满 maxBatch 帧、或最早一帧已等待 maxWait 时执行一次 runBatch()，
+ *   因此单帧延迟增加不超过 maxWait
+ * - 排队帧数达到 queueDepth 时 submit() 返回 false（实时流丢帧，避免延迟累积）
+ * - 结果在推理线程上按提交顺序回调（ok 为所在 batch 的 runBatch 返回值）；回调返回后释放该帧的 BufferRef
+ */
+class DetectionBatcher {
+public:
+    struct Config {
+        std::size_t maxBatch{0};  // 0 为 backend->maxBatchSize()
+        std::chrono::microseconds maxWait{5000};
+        std::size_t queueDepth{0};  // 0 为 2 × maxBatch
+    };
+
+    using ResultHandler = std::function<void(std::size_t stream, const ImageView& image,
+                                             DetectionResult& result, bool ok)>;
+
+    DetectionBatcher(DetectorBackendPtr backend, const Config& cfg, ResultHandler onResult);
+    ~DetectionBatcher();  // 已提交的帧执行完后退出
+    DetectionBatcher(const DetectionBatcher&) = delete;
+    DetectionBatcher& operator=(const DetectionBatcher&) = delete;
+
+    // frame 持有 image 指向的像素，直到该帧的结果回调完成
+    bool submit(std::size_t stream, const ImageView& image, core::BufferRef frame = {});
+
+    std::size_t maxBatch() const noexcept { return maxBatch_; }
+    std::size_t queueDepth() const noexcept { return queueDepth_; }
+    std::uint64_t batches() const;
+    std::uint64_t frames() const;
+    std::uint64_t drops() const;
+
+private:
+    struct Item {
+        std::size_t stream{0};
+        ImageView image;
+        core::BufferRef frame;
+        std::chrono::steady_clock::time_point arrival;
+    };
+
+    void workerLoop();
+
+    DetectorBackendPtr backend_;
+    ResultHandler onResult_;
+    std::size_t maxBatch_{1};
+    std::chrono::microseconds maxWait_;
+    std::size_t queueDepth_{2};
+    std::deque<Item> queue_;
+    std::uint64_t batches_{0};
+    std::uint64_t frames_{0};
+    std::uint64_t drops_{0};
+    bool stopping_{false};
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+};
+
+} // namespace falconmind::sdk::perception
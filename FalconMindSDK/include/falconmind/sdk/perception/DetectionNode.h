@@ -0,0 +1,201 @@
+// FalconMindSDK - DetectionNode：基于 IDetectorBackend 的流水线检测节点（前处理 / 推理 / 后处理相邻帧重叠）
+#pragma once
+
+#include "falconmind/sdk/core/AcceleratorArbiter.h"
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/NodeWatchdog.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/perception/ClassFilter.h"
+#include "falconmind/sdk/perception/IDetectorBackend.h"
+#include "falconmind/sdk/perception/InferenceRateController.h"
+#include "falconmind/sdk/perception/MotionGate.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+class AltitudeModelPolicy;
+class PerceptionPluginManager;
+class TiledDetectorBackend;
+
+// 由相机帧包（CameraFramePacket + 像素）构造 ImageView；negotiated 为 link 协商的格式（Any 时回退到缓冲元数据/帧头）。
+// 像素数据不完整时返回 false
+bool makeCameraImageView(const core::BufferRef& frame, core::PixelFormat negotiated, ImageView& imageView);
+
+/**
+ * DetectionNode - 检测节点：video_in 收相机帧，detection_out 输出 DetectionResultPacket
+ *
+ * 三级流水线，各级常驻线程，帧 N+1 前处理、帧 N 推理、帧 N−1 后处理并序列化输出同时进行：
+ * - 后端支持分阶段执行（prepareStages() > 0，如 RKNN）时三级分别调用 preprocessStage / inferStage / postprocessStage；
+ *   否则推理级整体调用 run()，前处理级只解析帧头，输出级负责序列化与推送
+ * - 推理级线程数为 backend->maxConcurrentRuns()（多 NPU 上下文 / CUDA stream 并发），输出级按提交顺序输出；
+ *   不分阶段且 backend->maxInFlight() > 1 时改为单个推理线程 submit()，完成回调标记帧，在途帧数由后端限定
+ * - 在途帧上限 queue_depth（默认 推理线程数 + 2，异步提交时为 maxInFlight() + 2）：满时 process() 丢弃新帧（实时流，避免时延累积）
+ * - 结果在输出级线程上推送到 detection_out；stop() 等待在途帧输出完毕
+ * 设置 InferenceRateController 时前处理级逐帧询问是否检测：跳过的帧不推理，按序输出 trackerPredicted 标记的空结果，
+ * 由下游 TrackingTransformNode 外推轨迹。
+ * 设置 MotionGate 时前处理级先做画面变化判断：Skip 的帧同样不推理（输出 trackerPredicted 空结果，不再询问 InferenceRateController）；
+ * Regions 的帧在 backend 为 TiledDetectorBackend 时只推理与变化区域相交的切片，其余切片复用上次结果。
+ * 未设置 backend 时每次 process() 直接输出一条空结果（与 DummyDetectionNode 一致）。
+ * 后端填写 DetectionResult::timing（DetectorDescriptor::profiling）时，输出级按阶段汇总到 StageProfiler
+ * （preprocess / infer / decode / nms / device），由 Pipeline::metrics() 随节点指标上报。
+ * 看门狗：pendingWorkAgeNs 为最早在途帧的等待时长；设置 fallback backend 时支持 FallbackBackend 动作，
+ * 切换后 process() 在调度线程上同步调用 fallback 的 run() 并直接输出，不再向流水线提交帧。
+ * 卡在驱动内的主 backend 无法中断，stop() 仍会等待其在途帧完成。
+ * 加速器仲裁：RKNN backend 登记到 "npu"、TensorRT 登记到 "gpu"；设置了 AcceleratorClient 时推理级每次
+ * run() / inferStage() 前获得一个时间片（多个 Flow 共用加速器时按 Flow 优先级分配）。
+ * 关注类别：start() 时把 classes 参数（或 FlowExecutor 下发的任务 detection_classes）按标签解析为类别 ID，
+ * 设置到 backend 的类别掩码，解码只读取这些类别；后端不支持时仍输出全部类别。
+ * 高度自适应（setModelPolicy）：process() 按帧尺寸询问 AltitudeModelPolicy，选择变化时由 PerceptionPluginManager
+ * 在后台预加载并预热新变体，期间仍用当前 backend 检测；常驻后排空在途帧、换用新 backend 并重建流水线。
+ *
+ * configure 参数：modelName（日志展示）、queue_depth、classes（逗号分隔的类别名或 ID）、
+ * label_path（标签文件，每行一个类别名；默认 COCO-80）
+ */
+class DetectionNode : public core::Node,
+                      public core::LatencySink,
+                      public core::StageProfileSink,
+                      public core::WatchdogTarget,
+                      public core::AcceleratorUser,
+                      public ClassOfInterestSink {
+public:
+    DetectionNode();
+    ~DetectionNode() override;
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void stop() override;
+    void process() override;
+
+    // 注入检测 backend（已 load）；video_in 随之声明 backend 支持的像素格式，须在 Pipeline::link 之前设置
+    void setBackend(DetectorBackendPtr backend);
+    const DetectorBackendPtr& backend() const noexcept { return backend_; }
+    // 检测频率控制（通常与 TrackingTransformNode 共享同一实例）；nullptr 为每帧检测。须在 start() 之前设置
+    void setRateController(std::shared_ptr<InferenceRateController> controller) { rateController_ = std::move(controller); }
+    // 画面变化门控；nullptr 为不门控。须在 start() 之前设置
+    void setMotionGate(std::shared_ptr<MotionGate> gate) { motionGate_ = std::move(gate); }
+    const std::shared_ptr<MotionGate>& motionGate() const noexcept { return motionGate_; }
+    // 看门狗 FallbackBackend 动作切换到的备用 backend（已 load，如 CPU 实现）；须在 start() 之前设置
+    void setFallbackBackend(DetectorBackendPtr backend) { fallbackBackend_ = std::move(backend); }
+    bool fallbackActive() const noexcept { return fallbackActive_.load(std::memory_order_acquire); }
+    // 高度自适应模型选择：backend 取自 manager 的常驻检测器（manager 须比节点存活更久）。立即 acquire 策略当前变体
+    // 并 setBackend，须在 Pipeline::link 之前设置；失败返回 false。policy 为 nullptr 时取消（保留当前 backend）
+    bool setModelPolicy(std::shared_ptr<AltitudeModelPolicy> policy, PerceptionPluginManager* manager);
+    const std::shared_ptr<AltitudeModelPolicy>& modelPolicy() const noexcept { return modelPolicy_; }
+    // 当前 backend 对应的检测器（未设置策略时为空）与运行中切换模型的次数
+    const std::string& activeDetectorId() const noexcept { return activeDetectorId_; }
+    std::uint64_t modelSwitches() const noexcept { return modelSwitches_.load(std::memory_order_relaxed); }
+
+    std::int64_t pendingWorkAgeNs(std::int64_t nowNs) const override;
+    bool applyWatchdogAction(core::WatchdogAction action) override;
+    std::string acceleratorDevice() const override;
+    void setClassesOfInterest(const std::vector<std::string>& names) override;
+
+    // 最近一次 start() 设置到 backend 的类别 ID（空为不限类别）
+    const std::vector<int>& activeClasses() const noexcept { return activeClasses_; }
+
+    // 后端以分阶段方式执行（否则推理级调用 run()）
+    bool staged() const noexcept { return staged_; }
+    // 推理级以 submit() 异步提交
+    bool asyncSubmit() const noexcept { return async_; }
+    std::size_t queueDepth() const noexcept { return slots_.size(); }
+    std::size_t inferWorkers() const noexcept { return inferWorkers_; }
+    std::size_t inFlight() const;
+    // 直连时 process() 来不及取走、被新帧覆盖的帧数
+    std::uint64_t overwrittenFrames() const noexcept { return overwrittenFrames_.load(std::memory_order_relaxed); }
+    // 在途帧已满而丢弃的帧数
+    std::uint64_t pipelineDrops() const noexcept { return pipelineDrops_.load(std::memory_order_relaxed); }
+    std::uint64_t emittedResults() const noexcept { return emittedResults_.load(std::memory_order_relaxed); }
+    // 其中由控制器跳过检测、输出 trackerPredicted 空结果的帧数
+    std::uint64_t predictedResults() const noexcept { return predictedResults_.load(std::memory_order_relaxed); }
+    // 其中由 MotionGate 判定画面未变化而跳过的帧数
+    std::uint64_t motionSkippedFrames() const noexcept { return motionSkipped_.load(std::memory_order_relaxed); }
+
+private:
+    enum class SlotState : std::uint8_t { Free, Submitted, Preprocessed, Inferring, Inferred };
+    struct Slot {
+        core::BufferRef frame;
+        ImageView image;
+        DetectionResult result;
+        SlotState state{SlotState::Free};
+        bool ok{false};
+        bool predicted{false};  // 控制器跳过检测
+        bool hasRegions{false};  // MotionGate 给出了变化区域（切片后端只推理这些区域）
+        std::vector<DetectionBBox> regions;
+        float shiftX{0.f};
+        float shiftY{0.f};
+        std::int64_t submittedNs{0};  // 提交时刻（steady_clock），供看门狗判定卡死
+    };
+
+    void preprocessLoop();
+    void inferLoop();
+    void outputLoop();
+    bool startStages();
+    void shutdownStages();
+    // 在调度线程上按策略预加载 / 切换 backend
+    void applyModelPolicy(const core::BufferRef& frame);
+    void markLatency(DetectionResult& result);
+    void recordTiming(const DetectionTiming& timing);
+    void emitResult(const DetectionResult& result);
+    void runFallback(const core::BufferRef& frame);
+
+    core::Pad* inPad_{nullptr};
+    core::Pad* outPad_{nullptr};
+    std::string modelName_{"detector"};
+    std::size_t configuredDepth_{0};  // 0 为推理线程数 + 2
+    std::vector<std::string> configuredClasses_;  // classes 参数，优先于任务类别
+    std::vector<std::string> missionClasses_;
+    std::vector<std::string> classLabels_;  // 空为 COCO-80
+    std::vector<int> activeClasses_;
+    DetectorBackendPtr backend_;
+    DetectorBackendPtr fallbackBackend_;
+    std::atomic<bool> fallbackActive_{false};
+    std::shared_ptr<InferenceRateController> rateController_;
+    std::shared_ptr<MotionGate> motionGate_;
+    TiledDetectorBackend* tiledBackend_{nullptr};  // backend_ 为切片后端时非空
+    std::shared_ptr<AltitudeModelPolicy> modelPolicy_;
+    PerceptionPluginManager* modelManager_{nullptr};
+    std::string activeDetectorId_;
+    std::string pendingDetectorId_;  // 已请求预加载、等待常驻的检测器
+    std::string failedDetectorId_;   // 加载失败或格式不符，不再尝试
+    std::atomic<std::uint64_t> modelSwitches_{0};
+    core::PixelFormat inputFormat_{core::PixelFormat::Any};
+
+    std::mutex frameMutex_;
+    core::BufferRef lastFrame_;  // 最近一帧（共享引用），process() 取走后清空
+    std::atomic<std::uint64_t> overwrittenFrames_{0};
+    std::atomic<std::uint64_t> pipelineDrops_{0};
+    std::atomic<std::uint64_t> emittedResults_{0};
+    std::atomic<std::uint64_t> predictedResults_{0};
+    std::atomic<std::uint64_t> motionSkipped_{0};
+
+    // 环形 slot：序号 seq 存于 slots_[seq % size]；各级按序号推进
+    bool staged_{false};
+    bool async_{false};
+    std::vector<Slot> slots_;
+    std::uint64_t submitted_{0};
+    std::uint64_t preprocessed_{0};  // 前处理级下一个序号
+    std::uint64_t inferNext_{0};     // 推理级下一个待领取的序号
+    std::uint64_t emitted_{0};       // 输出级下一个序号
+    bool stopping_{false};
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread preprocessThread_;
+    std::vector<std::thread> inferThreads_;
+    std::size_t inferWorkers_{0};  // 最近一次 start() 的推理线程数
+    std::thread outputThread_;
+    std::mutex emitMutex_;  // 切换 fallback 后输出级线程与 process() 可能同时输出
+    std::vector<std::uint8_t> resultPacketBuffer_;  // 由 emitMutex_ 保护
+};
+
+} // namespace falconmind::sdk::perception
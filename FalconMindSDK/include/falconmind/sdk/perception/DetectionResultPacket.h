@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <string_view>
 #include <vector>
 
 namespace falconmind::sdk::perception {
@@ -12,11 +13,16 @@ namespace falconmind::sdk::perception {
 /** 包魔数 "DRES" */
 constexpr std::uint32_t DETECTION_RESULT_PACKET_MAGIC = 0x53455244u; // "DRES" LE
 
-/** 包头：魔数 + 版本 + 预留 + frameIndex + timestampNs + numDetections */
+/** 包头标志位 */
+constexpr std::uint8_t DETECTION_RESULT_FLAG_OVER_LATENCY_BUDGET = 0x01u;
+constexpr std::uint8_t DETECTION_RESULT_FLAG_TRACKER_PREDICTED = 0x02u;  // 本帧未运行检测，由跟踪器外推
+
+/** 包头：魔数 + 版本 + 标志 + 预留 + frameIndex + timestampNs（源帧采集时间戳）+ numDetections */
 struct DetectionResultPacketHeader {
     std::uint32_t magic{DETECTION_RESULT_PACKET_MAGIC};
     std::uint8_t  version{1};
-    std::uint8_t  reserved[3]{0, 0, 0};
+    std::uint8_t  flags{0};  // DETECTION_RESULT_FLAG_*（原预留字节，旧数据为 0）
+    std::uint8_t  reserved[2]{0, 0};
     std::uint32_t frameIndex{0};
     std::uint64_t timestampNs{0};
     std::uint32_t numDetections{0};
@@ -43,7 +49,105 @@ inline std::size_t detectionResultPacketSize(std::size_t numDetections) {
     return sizeof(DetectionResultPacketHeader) + numDetections * sizeof(DetectionResultPacketItem);
 }
 
-/** 从 buffer 解析出 numDetections；若格式无效返回 0 */
+/** 从 buffer 解析出 numDetections（v1 / v2）；若格式无效返回 0 */
 std::uint32_t parseDetectionResultPacketNumDetections(const void* buffer, std::size_t size);
 
+/** 解析完整检测结果包（v1 / v2，v1 不含 className / trackId）；格式无效或长度不足返回 false */
+bool deserializeDetectionResult(const void* buffer, std::size_t size, DetectionResult& out);
+
+// ---- v2：带类别名表与 trackId 的扁平包，可原地只读访问（DetectionResultView），检测 / 跟踪节点默认输出 ----
+//
+// 布局（小端，各段 4 字节对齐）：
+//   DetectionResultPacketHeaderV2
+//   DetectionResultPacketItemV2[numDetections]
+//   std::uint32_t nameOffsets[numClassNames + 1]   // 各名称在字符串区的起始偏移，末项为字符串区长度
+//   char names[]                                   // 去重后的类别名，各以 '\0' 结尾
+
+constexpr std::uint8_t DETECTION_RESULT_PACKET_VERSION_2 = 2;
+constexpr std::uint16_t DETECTION_RESULT_NO_CLASS_NAME = 0xFFFFu;
+
+/** v2 包头（32 字节）：前 6 字节与 v1 相同，按 version 区分 */
+struct DetectionResultPacketHeaderV2 {
+    std::uint32_t magic{DETECTION_RESULT_PACKET_MAGIC};
+    std::uint8_t  version{DETECTION_RESULT_PACKET_VERSION_2};
+    std::uint8_t  flags{0};            // DETECTION_RESULT_FLAG_*
+    std::uint16_t headerBytes{32};     // sizeof(DetectionResultPacketHeaderV2)，供后续版本在包头追加字段
+    std::uint32_t frameIndex{0};
+    std::uint32_t numDetections{0};
+    std::uint64_t timestampNs{0};      // 源帧采集时间戳
+    std::uint32_t numClassNames{0};
+    std::uint32_t totalBytes{0};       // 整包字节数
+};
+
+/** v2 单条检测（32 字节） */
+struct DetectionResultPacketItemV2 {
+    float        x{0.f};
+    float        y{0.f};
+    float        width{0.f};
+    float        height{0.f};
+    float        score{0.f};
+    std::int32_t classId{-1};
+    std::int32_t trackId{-1};
+    std::uint16_t classNameIndex{DETECTION_RESULT_NO_CLASS_NAME};  // 类别名表下标
+    std::uint16_t reserved{0};
+};
+
+static_assert(sizeof(DetectionResultPacketHeaderV2) == 32, "DetectionResultPacketHeaderV2 layout");
+static_assert(sizeof(DetectionResultPacketItemV2) == 32, "DetectionResultPacketItemV2 layout");
+
+/** v2 序列化所需字节数（含去重后的类别名表） */
+std::size_t detectionResultPacketV2Size(const DetectionResult& result);
+
+/** 序列化为 v2 包，返回字节数；bufferSize 不足返回 0 */
+std::size_t serializeDetectionResultV2(const DetectionResult& result, std::uint8_t* buffer, std::size_t bufferSize);
+
+/**
+ * DetectionResultView - 检测结果包的零拷贝只读视图
+ *
+ * parse() 只校验边界，不复制数据；访问器直接读取包内字段，className() 返回指向包内字符串的 string_view。
+ * 视图不持有数据，包缓冲须在使用期间保持有效。v1 包同样可读（trackId 为 -1，className 为空）。
+ */
+class DetectionResultView {
+public:
+    DetectionResultView() = default;
+    DetectionResultView(const void* buffer, std::size_t size) { parse(buffer, size); }
+
+    bool parse(const void* buffer, std::size_t size);
+    bool valid() const noexcept { return data_ != nullptr; }
+
+    std::uint8_t version() const noexcept { return version_; }
+    std::uint32_t frameIndex() const noexcept { return frameIndex_; }
+    std::uint64_t timestampNs() const noexcept { return timestampNs_; }
+    bool overLatencyBudget() const noexcept { return (flags_ & DETECTION_RESULT_FLAG_OVER_LATENCY_BUDGET) != 0; }
+    bool trackerPredicted() const noexcept { return (flags_ & DETECTION_RESULT_FLAG_TRACKER_PREDICTED) != 0; }
+
+    std::size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+    DetectionBBox bbox(std::size_t i) const noexcept;
+    float score(std::size_t i) const noexcept;
+    int classId(std::size_t i) const noexcept;
+    int trackId(std::size_t i) const noexcept;
+    std::string_view className(std::size_t i) const noexcept;
+
+    // 类别名表（仅 v2）
+    std::size_t numClassNames() const noexcept { return numNames_; }
+    std::string_view classNameAt(std::size_t nameIndex) const noexcept;
+
+    // 展开为 DetectionResult（分配堆内存，仅在需要可修改副本时使用）
+    void toDetectionResult(DetectionResult& out) const;
+
+private:
+    const std::uint8_t* data_{nullptr};
+    const DetectionResultPacketItem* itemsV1_{nullptr};
+    const DetectionResultPacketItemV2* itemsV2_{nullptr};
+    const std::uint32_t* nameOffsets_{nullptr};
+    const char* names_{nullptr};
+    std::size_t count_{0};
+    std::size_t numNames_{0};
+    std::uint64_t timestampNs_{0};
+    std::uint32_t frameIndex_{0};
+    std::uint8_t version_{0};
+    std::uint8_t flags_{0};
+};
+
 } // namespace falconmind::sdk::perception
@@ -1,6 +1,8 @@
 // FalconMindSDK - Detection related basic types and descriptors
 #pragma once
 
+#include "falconmind/sdk/core/Caps.h"
+
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -31,6 +33,13 @@ enum class ModelPrecision {
     INT8
 };
 
+// NMS 方式：Hard 为经典贪心抑制；Soft（高斯 Soft-NMS）与 Matrix（Matrix NMS）按 IoU 衰减分数而不直接丢弃
+enum class NmsMethod {
+    Hard = 0,
+    Soft,
+    Matrix
+};
+
 struct DetectionBBox {
     float x{0.0f};
     float y{0.0f};
@@ -46,11 +55,25 @@ struct Detection {
     int   trackId{-1}; // 若只做检测，可保持为 -1
 };
 
+// 单帧检测各阶段耗时（微秒，0 为未测量），DetectorDescriptor::profiling 时由后端填写。
+// deviceUs 为运行时上报的设备侧推理耗时（RKNN perf_run / CUDA event），deviceUtilization = 设备耗时 / 推理墙钟（<0 为不可用）
+struct DetectionTiming {
+    std::uint32_t preprocessUs{0};
+    std::uint32_t inferUs{0};
+    std::uint32_t decodeUs{0};
+    std::uint32_t nmsUs{0};
+    std::uint32_t deviceUs{0};
+    float deviceUtilization{-1.f};
+};
+
 struct DetectionResult {
     std::string frameId;      // 可选：用于与 CameraFrameMeta 对齐
-    std::uint64_t timestampNs{0};
+    std::uint64_t timestampNs{0};  // 源帧采集时间戳（PipelineClock），用于端到端时延统计
     std::uint32_t frameIndex{0};
+    bool overLatencyBudget{false}; // 检测完成时已超出 Flow 时延预算
+    bool trackerPredicted{false};  // 本帧未运行检测（InferenceRateController 跳过），由跟踪器外推
     std::vector<Detection> detections;
+    DetectionTiming timing;
 };
 
 // 检测器描述信息：用于 Builder/NodeAgent/Center 侧能力发现与选择
@@ -72,6 +95,77 @@ struct DetectorDescriptor {
     // 预留若干通用超参数（阈值等），方便按需扩展
     float scoreThreshold{0.25f};
     float nmsThreshold{0.45f};
+
+    // NMS：按分数预选 nmsTopK 个候选、每帧最多输出 maxDetections 个（0 不限）；
+    // Soft/Matrix 以 exp(-iou²/nmsSigma) 衰减分数，衰减后低于 scoreThreshold 的框被抑制
+    NmsMethod nmsMethod{NmsMethod::Hard};
+    int   nmsTopK{0};
+    int   maxDetections{0};
+    float nmsSigma{0.5f};
+
+    // 前处理：等比缩放 + 填充（false 为拉伸）、填充灰度、行并行线程数（0 为默认）
+    bool letterbox{true};
+    int  letterboxPadValue{114};
+    int  preprocessThreads{0};
+    // 缩放/颜色转换卸载到 2D 硬件（sensors::ImageTransform）："none"（默认）/ "auto" / "rga" / "vpi"
+    std::string preprocessAccel{"none"};
+
+    // 量化模型输入：quantizedInput 时 INT8/UINT8 模型直接喂 uint8（false 强制 float）；
+    // inputPassThrough 时按模型量化参数查表为内部量化值并跳过运行时转换。
+    // inputMean/inputStd 为模型转换时的归一化参数（pixel − mean) / std，仅 pass_through 查表使用
+    bool  quantizedInput{true};
+    bool  inputPassThrough{true};
+    float inputMean{0.f};
+    float inputStd{255.f};
+
+    // 支持时使用运行时的零拷贝 IO（RKNN：rknn_create_mem/rknn_set_io_mem，模型尺寸的 DMABUF 帧直接导入）
+    bool zeroCopy{true};
+
+    // 推理上下文数（RKNN：rknn_dup_context 共享权重，各绑一个 NPU 核）；>1 时 run() 可并发调用
+    int npuContexts{1};
+
+    // 动态 batch 模型单次推理的最大帧数（ONNXRuntime / TensorRT）；固定 batch 的模型以模型为准
+    int maxBatch{1};
+
+    // TensorRT 在途推理路数（各自的执行上下文 + CUDA stream）；>1 时 run() 可并发调用，拷贝与推理相互重叠
+    int cudaStreams{2};
+
+    // ONNXRuntime 执行提供者，按偏好排序（cuda / tensorrt / acl / xnnpack / cpu），不可用的跳过，CPU 始终兜底；
+    // intraOpThreads 为算子内线程数（0 为 1）
+    std::vector<std::string> executionProviders;
+    int intraOpThreads{0};
+
+    // 切片推理（高分辨率航拍帧中的小目标）：tileWidth > 0 时 PerceptionPluginManager 以 TiledDetectorBackend 包装，
+    // 帧切成相互重叠 tileOverlap（比例）的 tileWidth×tileHeight 切片（tileHeight 为 0 时取 tileWidth）批量推理，
+    // 跨切片 NMS 合并；tileFullFrame 时另对整帧推理一次以兼顾大目标。
+    // tileMotionThreshold > 0 时，与上一帧平均亮度差低于该值（0~255）的切片复用上次结果，最多连续 tileMaxReuse 帧
+    int   tileWidth{0};
+    int   tileHeight{0};
+    float tileOverlap{0.2f};
+    bool  tileFullFrame{true};
+    float tileMotionThreshold{0.f};
+    int   tileMaxReuse{10};
+
+    // 级联检测：cascadeDetectorId 非空时 PerceptionPluginManager 以 CascadeDetectorBackend 包装，本检测器（小模型）以
+    // cascadeScreenThreshold 整帧筛选候选，候选框放大 cascadeCropScale 倍（边长至少 cascadeMinCrop 像素）裁出后
+    // 分批交给 cascadeDetectorId 指向的检测器（大模型）确认，确认结果按 cascadeConfirmThreshold 过滤；
+    // 小模型分数不低于 cascadeAcceptThreshold 的候选直接采纳（> 1 为全部确认），候选超过 cascadeMaxCrops（0 不限）时大模型整帧推理
+    std::string cascadeDetectorId;
+    float cascadeScreenThreshold{0.1f};
+    float cascadeConfirmThreshold{0.25f};
+    float cascadeAcceptThreshold{1.1f};
+    float cascadeCropScale{2.f};
+    int   cascadeMinCrop{96};
+    int   cascadeMaxCrops{16};
+
+    // 常驻管理（PerceptionPluginManager::acquireDetector）：加载后以模型输入尺寸的灰帧预热 warmupRuns 次，
+    // 消除首帧的冷启动（内存分配、内核编译、NPU 初始化）；memoryBytes 为常驻内存估算，0 时取模型文件大小
+    int warmupRuns{1};
+    std::uint64_t memoryBytes{0};
+
+    // 分阶段计时（DetectionResult::timing）；RKNN 另开启运行时性能采集（RKNN_FLAG_COLLECT_PERF_MASK，略增推理耗时），
+    // TensorRT 以 CUDA event 量取设备耗时
+    bool profiling{false};
 };
 
 // 对输入图像的一个轻量视图，避免在检测后端里直接依赖具体帧类型
@@ -81,6 +175,13 @@ struct ImageView {
     int height{0};
     int stride{0};
     std::string pixelFormat; // 如 "RGB8" / "BGR8" / "NV12"
+    core::PixelFormat format{core::PixelFormat::Any};  // 已协商的格式；Any 时后端回退到 pixelFormat 字符串
+    std::int64_t captureTimestampNs{0};  // 帧采集时间戳（PipelineClock），后端原样写入 DetectionResult
+    std::uint32_t frameIndex{0};
+    int dmabufFd{-1};  // 像素数据所在 DMABUF（来自 BufferMeta::dmabufFd），支持 fd 导入的后端可免 CPU 拷贝
+    // 图像在源全幅中的偏移（BufferMeta::region，跟踪 ROI 裁剪帧）；后端按图像自身坐标输出，DetectionNode 平移回全幅
+    int offsetX{0};
+    int offsetY{0};
 };
 
 } // namespace falconmind::sdk::perception
@@ -0,0 +1,99 @@
+// FalconMindSDK - 检测后端自动调优：在本板卡上实测候选配置（线程数 / NPU 上下文与核掩码 / batch / CUDA stream），按 (板卡, 模型指纹) 持久化最快者
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/perception/IDetectorBackend.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+// 一组可调的后端参数；applyTo 覆盖 DetectorDescriptor 的对应字段
+struct TunedBackendConfig {
+    int intraOpThreads{0};                    // ONNXRuntime
+    std::vector<std::string> executionProviders;
+    int npuContexts{1};                       // RKNN
+    std::uint32_t npuCoreMask{0};             // RKNN：load() 后 setNpuCoreMask，0 为自动
+    int cudaStreams{2};                       // TensorRT
+    int maxBatch{1};                          // ONNXRuntime / TensorRT 动态 batch
+    double framesPerSecond{0.};               // 实测吞吐
+
+    static TunedBackendConfig fromDescriptor(const DetectorDescriptor& desc);
+    void applyTo(DetectorDescriptor& desc) const;
+    // 紧凑的文本形式（日志与缓存文件），如 "intra_op_threads=4,max_batch=1"
+    std::string describe() const;
+};
+
+struct AutotuneOptions {
+    std::string cachePath;    // 调优结果文件；空为只在进程内缓存
+    std::string board;        // 板卡标识；空时由 boardIdentity() 探测
+    std::string capturePath;  // 录制的相机帧（CaptureWriter 文件）作为测试帧；空或不可读时用合成帧
+    int maxCaptureFrames{8};  // 从录制文件中均匀抽取的帧数
+    int warmupRuns{2};        // 每个候选计时前的预热次数
+    int measureFrames{30};    // 每个候选计时的帧数
+};
+
+/**
+ * DetectorAutotuner - PerceptionPluginManager 首次创建某个检测器时的实测调优
+ *
+ * candidates() 按后端枚举候选（第一个为描述中的原始配置）：
+ * - ONNXRuntime：intraOpThreads ∈ {1, 2, 4, 硬件线程数}，动态 batch 时另试 maxBatch = 1
+ * - RKNN：单上下文（自动 / 三核联合掩码）、2 与 3 个上下文（各绑一核）；不支持的掩码（setNpuCoreMask 失败）淘汰
+ * - TensorRT：cudaStreams ∈ {1, 2, 4} × maxBatch ∈ {1, 描述值}
+ * 每个候选以 factory 新建后端、加载、预热后计时 measureFrames 帧：maxBatchSize() > 1 时按 batch 调用 runBatch()，
+ * maxInFlight() > 1 时单线程 submit()，否则逐帧 run()；吞吐最高者胜出。
+ * 结果按 (板卡, 模型指纹) 保存；模型文件变化（指纹不同）或换板卡时重新调优。
+ * 精度与后端类型由模型文件决定，不在候选之内。线程安全：同一时刻只调优一个检测器。
+ */
+class DetectorAutotuner {
+public:
+    using BackendFactory = std::function<DetectorBackendPtr()>;
+
+    explicit DetectorAutotuner(AutotuneOptions options = {});
+    ~DetectorAutotuner();
+
+    // 取得 desc 的最佳配置：已有结果时直接返回，否则实测并持久化。全部候选失败返回 false
+    bool resolve(const DetectorDescriptor& desc, const BackendFactory& factory, TunedBackendConfig& out);
+    // 只查已有结果
+    bool lookup(const DetectorDescriptor& desc, TunedBackendConfig& out) const;
+
+    const std::string& board() const noexcept { return board_; }
+    const AutotuneOptions& options() const noexcept { return options_; }
+    // 实际执行过的调优次数（不含命中缓存）
+    std::uint64_t tuneRuns() const;
+
+    static std::vector<TunedBackendConfig> candidates(const DetectorDescriptor& desc);
+    // 吞吐（帧 / 秒）；推理失败返回 0
+    static double measure(IDetectorBackend& backend, const std::vector<ImageView>& frames, int warmupRuns,
+                          int measureFrames);
+    // /proc/device-tree/model（无则 /proc/cpuinfo 的 Hardware / model name）+ 逻辑核数
+    static std::string boardIdentity();
+    // 模型文件大小与首尾各 1 MiB 内容的 FNV-1a 指纹（十六进制）；文件不可读时按路径计算
+    static std::string modelFingerprint(const std::string& path);
+
+private:
+    std::string key(const DetectorDescriptor& desc) const;
+    void prepareFrames(const DetectorDescriptor& desc);
+    void loadCache();
+    bool saveCache() const;
+
+    AutotuneOptions options_;
+    std::string board_;
+    mutable std::mutex mutex_;
+    std::mutex tuneMutex_;  // 串行化调优：候选之间互不干扰，同一模型只调优一次
+    std::unordered_map<std::string, TunedBackendConfig> results_;  // 键为 "板卡\t指纹"
+    std::uint64_t tuneRuns_{0};
+
+    std::vector<ImageView> frames_;
+    std::vector<std::vector<std::uint8_t>> syntheticPixels_;
+    std::vector<core::BufferRef> captureFrames_;  // 录制帧（共享文件映射），frames_ 指向其中的像素
+};
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,69 @@
+// FalconMindSDK - 检测调度：多个推理上下文并发执行，结果按提交顺序输出
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/perception/IDetectorBackend.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * DetectorDispatcher - 把帧轮流分给 backend 的多个推理上下文（如 RK3588 的三个 NPU 核）
+ *
+ * - workers 个常驻线程并发调用 backend->run()（backend 须支持 maxConcurrentRuns() >= workers）
+ * - 在途帧上限为 2 × workers：每个上下文一帧在跑、一帧排队，上下文之间不空转；
+ *   达到上限时 submit() 返回 false，由调用方丢帧（实时流）或稍后重试
+ * - 结果按提交顺序取出：较晚的帧先完成时暂存，直到之前的帧都已取出
+ * submit/poll/wait 应由同一个线程调用
+ */
+class DetectorDispatcher {
+public:
+    // workers 为 0 时取 backend->maxConcurrentRuns()
+    explicit DetectorDispatcher(DetectorBackendPtr backend, std::size_t workers = 0);
+    ~DetectorDispatcher();  // 等待在途帧完成后退出
+    DetectorDispatcher(const DetectorDispatcher&) = delete;
+    DetectorDispatcher& operator=(const DetectorDispatcher&) = delete;
+
+    // frame 持有 image 指向的像素，直到该帧推理完成
+    bool submit(const ImageView& image, core::BufferRef frame = {});
+    // 取出下一条结果（ok 为 backend->run 的返回值）；最早提交的帧未完成时返回 false
+    bool poll(DetectionResult& out, bool* ok = nullptr);
+    // 阻塞到下一条结果可取；没有在途帧时返回 false
+    bool wait(DetectionResult& out, bool* ok = nullptr);
+
+    std::size_t workers() const noexcept { return threads_.size(); }
+    std::size_t capacity() const noexcept { return slots_.size(); }
+    std::size_t inFlight() const;
+
+private:
+    struct Slot {
+        ImageView image;
+        core::BufferRef frame;
+        DetectionResult result;
+        bool ok{false};
+        bool done{false};
+    };
+
+    void workerLoop();
+    bool takeLocked(DetectionResult& out, bool* ok);
+
+    DetectorBackendPtr backend_;
+    std::vector<Slot> slots_;   // 环形：序号 seq 存于 slots_[seq % capacity]
+    std::uint64_t submitted_{0};
+    std::uint64_t emitted_{0};
+    std::deque<std::uint64_t> pending_;  // 待执行的序号（FIFO，空闲线程取最早的）
+    bool stopping_{false};
+    mutable std::mutex mutex_;
+    std::condition_variable workCv_;
+    std::condition_variable doneCv_;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,66 @@
+// FalconMindSDK - 双光谱（可见光 + 热红外）配准与融合内核：预计算重映射表 + 逐行融合
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+// 融合方式：输出仍为三通道 8 位图，可直接送单个 RGB 检测器
+enum class SpectrumFusionMode {
+    Blend,        // 各通道 (1 - alpha) * 可见光 + alpha * 热红外
+    ReplaceBlue,  // 蓝色通道替换为热红外（R, G, T），保留大部分颜色信息
+    ThermalOnly   // 三通道均为热红外（全黑环境）
+};
+
+/**
+ * ThermalRemap - 热红外 → 可见光像素坐标的预计算重映射表
+ *
+ * homography 为行主序 3x3 矩阵，把可见光像素 (x, y, 1) 映射到热红外像素坐标（由标定离线求得）；
+ * build() 对输出尺寸的每个像素求一次对应的热红外整数坐标与 Q8 双线性权重，逐帧只查表、整数插值。
+ * 16 位热红外（GRAY16 / Y16）按上一帧在同一遍中统计的最小 / 最大值线性压缩到 8 位（首帧取满量程）。
+ */
+class ThermalRemap {
+public:
+    using Homography = std::array<double, 9>;
+    static constexpr Homography kIdentity{1., 0., 0., 0., 1., 0., 0., 0., 1.};
+
+    void setHomography(const Homography& h);
+    const Homography& homography() const noexcept { return h_; }
+
+    // 输出 / 热红外尺寸与上次不同时重建表
+    void build(int outWidth, int outHeight, int thermalWidth, int thermalHeight);
+    bool ready() const noexcept { return !taps_.empty(); }
+
+    // 输出第 y 行的配准热红外（8 位，width = outWidth）；超出热红外视场的像素为 0
+    void remapRow8(const std::uint8_t* thermal, int thermalStride, int y, std::uint8_t* out) const noexcept;
+    void remapRow16(const std::uint16_t* thermal, int thermalStride, int y, std::uint8_t* out) noexcept;
+    // 一帧 16 位数据处理完毕后调用：采用本帧统计的范围作为下一帧的压缩范围
+    void endFrame16() noexcept;
+
+private:
+    struct Tap {
+        std::uint16_t x{0xFFFF}, y{0};  // 左上角整数坐标；x == 0xFFFF 表示越界
+        std::uint8_t fx{0}, fy{0};
+    };
+
+    Homography h_{kIdentity};
+    int outWidth_{0}, outHeight_{0};
+    int thermalWidth_{0}, thermalHeight_{0};
+    std::vector<Tap> taps_;
+    std::uint16_t lo_{0}, hi_{65535};                  // 当前压缩范围
+    std::uint16_t frameLo_{65535}, frameHi_{0};        // 本帧统计
+};
+
+/**
+ * 把一行配准后的热红外与可见光行融合写入 out（三通道，可与 rgb 相同以原地融合）。
+ * blueIndex 为蓝色通道在像素内的下标（RGB8 为 2，BGR8 为 0）；alpha 为 Q8（0~256）。
+ * aarch64 上以 NEON 三通道解交织 / 交织加载存储，每次处理 16 像素。
+ */
+void fuseRow(const std::uint8_t* rgb, const std::uint8_t* thermal, std::uint8_t* out, int width,
+             SpectrumFusionMode mode, int blueIndex, std::uint32_t alpha) noexcept;
+const char* fusionKernelName() noexcept;
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,71 @@
+// FalconMindSDK - 双光谱融合节点：热红外按标定单应配准到可见光，融合为单路三通道图送检测器
+#pragma once
+
+#include "falconmind/sdk/core/BranchSwitch.h"
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/BufferPool.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/perception/DualSpectrumFusion.h"
+#include "falconmind/sdk/sensors/MultiCameraSourceNode.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * DualSpectrumFusionNode - rgb_in（RGB8/BGR8）与 thermal_in（GRAY8/Y8、GRAY16/Y16，或 RGB8/BGR8 取亮度）
+ * 按 BufferMeta::timestampNs 配对（sensors::FrameSynchronizer），融合结果从 video_out 推出，
+ * 尺寸与格式同可见光帧；夜间只需运行一个 RGB 检测器。
+ *
+ * 两路输入均零拷贝持有上游缓冲；输出缓冲取自节点内 BufferPool，逐行“查表重映射 → 融合”单趟写入。
+ *
+ * configure 参数：
+ *   homography    逗号分隔的 9 个数（行主序，可见光像素 → 热红外像素），默认单位阵
+ *   mode          blend（默认）/ replace_blue / thermal_only
+ *   alpha         blend 时热红外权重 0~1（默认 0.5）
+ *   max_skew_ms   两路时间戳最大允许差（默认 20）
+ */
+class DualSpectrumFusionNode : public core::Node, public core::BranchIdleSink {
+public:
+    DualSpectrumFusionNode();
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void stop() override;
+    void process() override;
+    void releaseIdleBuffers() override;
+
+    void setHomography(const ThermalRemap::Homography& h);
+    void setMode(SpectrumFusionMode mode) { mode_ = mode; }
+    void setAlpha(float alpha);
+
+    std::uint64_t fusedFrames() const noexcept { return fused_.load(std::memory_order_relaxed); }
+    std::uint64_t unmatchedDrops() const;
+    core::BufferPoolStats poolStats() const { return pool_.stats(); }
+
+private:
+    void fuse(const core::BufferRef& rgb, const core::BufferRef& thermal);
+
+    core::Pad* rgbPad_{nullptr};
+    core::Pad* thermalPad_{nullptr};
+    core::Pad* outPad_{nullptr};
+    core::PixelFormat rgbFormat_{core::PixelFormat::Any};  // link 协商的可见光格式
+
+    mutable std::mutex syncMutex_;
+    sensors::FrameSynchronizer sync_;
+    std::int64_t maxSkewNs_{20'000'000};
+
+    std::mutex remapMutex_;  // setHomography 可在运行中调用，与 process 互斥
+    ThermalRemap remap_;
+    SpectrumFusionMode mode_{SpectrumFusionMode::Blend};
+    std::uint32_t alpha_{128};  // Q8
+    std::vector<std::uint8_t> thermalRow_;   // 仅 process 线程访问
+    std::vector<std::uint8_t> thermalGray_;  // 三通道热红外源转灰度
+    core::BufferPool pool_;
+    std::atomic<std::uint64_t> fused_{0};
+};
+
+} // namespace falconmind::sdk::perception
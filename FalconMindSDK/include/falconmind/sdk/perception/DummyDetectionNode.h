@@ -3,31 +3,60 @@
 
 #include "falconmind/sdk/core/Node.h"
 #include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/perception/DetectorDispatcher.h"
 #include "falconmind/sdk/perception/IDetectorBackend.h"
 
+#include <atomic>
 #include <string>
 #include <memory>
+#include <mutex>
 
 namespace falconmind::sdk::perception {
 
 // 当前节点不做真实推理，仅模拟一条检测结果的生成，用于验证
 // Pipeline 连接与感知节点基本行为。后续可替换为真 YOLO/ONNXRuntime 实现。
-class DummyDetectionNode : public core::Node {
+// 检测完成时统计采集到检测的时延（LatencySink），超出 Flow 预算的结果在包头置标志。
+class DummyDetectionNode : public core::Node, public core::LatencySink {
 public:
     DummyDetectionNode();
 
     bool configure(const std::unordered_map<std::string, std::string>& params) override;
     bool start() override;
+    void stop() override;
     void process() override;
 
-    // 可注入真实的检测 backend（如 OnnxRuntimeDetectorBackend）
-    void setBackend(DetectorBackendPtr backend) { backend_ = std::move(backend); }
+    // 可注入真实的检测 backend（如 OnnxRuntimeDetectorBackend）；
+    // video_in 随之声明 backend 支持的像素格式，须在 Pipeline::link 之前设置
+    void setBackend(DetectorBackendPtr backend);
 
 private:
+public:
+    // 直连时 process() 来不及处理、被新帧覆盖的帧数（队列连接的丢帧见 Pipeline::metrics()）
+    std::uint64_t overwrittenFrames() const noexcept { return overwrittenFrames_.load(std::memory_order_relaxed); }
+    // 后端可并发推理时：所有上下文都忙、在途帧已满而丢弃的帧数
+    std::uint64_t dispatchDrops() const noexcept { return dispatchDrops_.load(std::memory_order_relaxed); }
+
+private:
+    // 记录端到端时延并按预算置 overLatencyBudget
+    void markLatency(DetectionResult& result);
+    // 由帧头与缓冲元数据构造 ImageView；像素数据不完整时返回 false
+    bool makeImageView(const core::BufferRef& frame, ImageView& imageView) const;
+    void emitResult(const DetectionResult& result);
+    // 并发推理路径：提交当前帧并按顺序输出已完成的结果
+    void dispatch(core::BufferRef frame);
+
+    core::Pad* inPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
+    core::Pad* outPad_{nullptr};
     std::string modelName_{"dummy-detector"};
     DetectorBackendPtr backend_;
-    std::vector<std::uint8_t> lastFrameBuffer_;
-    bool lastFrameValid_{false};
+    std::mutex frameMutex_;
+    std::atomic<std::uint64_t> overwrittenFrames_{0};
+    std::atomic<std::uint64_t> dispatchDrops_{0};
+    std::unique_ptr<DetectorDispatcher> dispatcher_;  // backend->maxConcurrentRuns() > 1 时于 start() 创建
+    core::BufferRef lastFrame_;  // 最近一帧（共享引用，不拷贝像素），process() 取走后清空
+    core::PixelFormat inputFormat_{core::PixelFormat::Any};  // link 协商的输入格式
     std::vector<std::uint8_t> resultPacketBuffer_;
 };
 
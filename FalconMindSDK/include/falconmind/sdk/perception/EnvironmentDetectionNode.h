@@ -1,11 +1,21 @@
 // FalconMindSDK - 环境状态检测节点
-// 输出环境状态（正常/GPS拒止/低照度等），供切换定位源或图像增强；可对接算法容器或外部传感器。
+// 由 GNSS 质量（gnss_in）与上游已计算的帧亮度（brightness_in）带迟滞地判定 GPS 拒止 / 低照度，
+// 输出环境状态（env_status_out），并在状态切换时开关视觉 SLAM、低照度增强等按需运行的分支。
 #pragma once
 
+#include "falconmind/sdk/core/GateNode.h"
 #include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/NodeParams.h"
+#include "falconmind/sdk/core/SelectorNode.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace falconmind::sdk::perception {
 
@@ -17,26 +27,131 @@ enum class EnvironmentState : int32_t {
     Unknown = 3
 };
 
+// EnvironmentStatusPacket::flags 位；两种条件可同时成立
+enum EnvironmentFlag : std::uint32_t {
+    kEnvGpsDenied = 1u << 0,
+    kEnvLowLight = 1u << 1,
+};
+
 struct EnvironmentStatusPacket {
-    int32_t state{static_cast<int32_t>(EnvironmentState::Normal)};
+    int32_t state{static_cast<int32_t>(EnvironmentState::Normal)};  // 主状态：GPS 拒止优先于低照度
     float confidence{1.0f};
+    std::uint32_t flags{0};
+    float hdop{0.f};            // 最近 GNSS 样本（未收到时为 0）
+    std::int32_t numSatellites{0};
+    float meanBrightness{-1.f}; // 最近帧亮度（未收到时为 -1）
+};
+
+enum class EnvironmentCondition { GpsDenied, LowLight };
+
+struct EnvironmentDetectionConfig {
+    // GPS 拒止：卫星数少于 minSatellites、HDOP 高于 maxHdop 或 gnssTimeoutNs 内无 GNSS 样本时进入；
+    // 卫星数不少于 recoverSatellites 且 HDOP 不高于 recoverHdop 时退出
+    int minSatellites{6};
+    float maxHdop{2.5f};
+    int recoverSatellites{8};
+    float recoverHdop{1.8f};
+    std::int64_t gnssTimeoutNs{2'000'000'000};
+    // 低照度：平均亮度低于 lowLightEnter 时进入，高于 lowLightExit 时退出；brightnessTimeoutNs 内无统计时保持
+    float lowLightEnter{50.f};
+    float lowLightExit{70.f};
+    std::int64_t brightnessTimeoutNs{2'000'000'000};
+    // 条件须连续保持的时长才切换（进入快、退出慢，避免在边界抖动时反复启停昂贵分支）
+    std::int64_t enterHoldNs{1'000'000'000};
+    std::int64_t exitHoldNs{3'000'000'000};
 };
 
+/**
+ * 带保持时间的迟滞开关：进入 / 退出条件须分别连续成立 enterHold / exitHold 才翻转
+ */
+class HysteresisLatch {
+public:
+    bool active() const noexcept { return active_; }
+    void reset(bool active = false) noexcept {
+        active_ = active;
+        pendingSinceNs_ = -1;
+    }
+    // 返回本次是否翻转
+    bool update(bool enter, bool exit, std::int64_t nowNs, std::int64_t enterHoldNs, std::int64_t exitHoldNs) noexcept;
+
+private:
+    bool active_{false};
+    std::int64_t pendingSinceNs_{-1};
+};
+
+/**
+ * EnvironmentDetectionNode
+ *
+ * - gnss_in：sensors::GnssSample（GnssSourceNode::gnss_out）；brightness_in：FrameBrightnessPacket
+ *   （LowLightAdaptationNode::brightness_out）。两者都只缓存最新值，判定在 process() 中进行，不触碰像素
+ * - 从未收到任何输入时按 default_state / setState 输出（兼容外部驱动）；收到输入后自动判定
+ * - onCondition / bindGate 注册的动作在 start() 时以当前状态调用一次，之后仅在迟滞开关翻转时调用
+ *
+ * configure 参数：default_state、confidence、min_satellites、max_hdop、recover_satellites、recover_hdop、
+ * gnss_timeout_ms、low_light_enter、low_light_exit、enter_hold_ms、exit_hold_ms（类型与范围见 paramSchema()）
+ */
 class EnvironmentDetectionNode : public core::Node {
 public:
     EnvironmentDetectionNode();
+    // 模板 environment_detection 的参数声明
+    static const core::ParamSchema& paramSchema();
     bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool applyParams(const core::NodeParams& params) override;
     bool start() override;
     void process() override;
 
     /// 可选：设置当前状态（无传感器时由上游或配置驱动）
     void setState(EnvironmentState s) { currentState_ = s; }
     void setConfidence(float c) { confidence_ = std::max(0.f, std::min(1.f, c)); }
+    void setConfig(const EnvironmentDetectionConfig& config) { config_ = config; }
+    const EnvironmentDetectionConfig& config() const noexcept { return config_; }
+
+    // 条件成立 / 解除时调用 action(active)；在 process() 线程调用，应只做开关切换等轻量操作
+    void onCondition(EnvironmentCondition condition, std::function<void(bool active)> action);
+    // 条件成立时打开 gate（openWhenActive=false 时反之），如 GPS 拒止时才向 VisualSlamNode 送帧
+    void bindGate(EnvironmentCondition condition, std::shared_ptr<core::GateNode> gate, bool openWhenActive = true);
+    // 条件成立时选中 activeOutput，解除时选中 inactiveOutput（-1 为全部截断），如夜间切到热红外检测分支
+    void bindSelector(EnvironmentCondition condition, std::shared_ptr<core::SelectorNode> selector, int activeOutput,
+                      int inactiveOutput);
+
+    bool gpsDenied() const noexcept { return gps_.active(); }
+    bool lowLight() const noexcept { return lowLight_.active(); }
+    EnvironmentStatusPacket lastStatus() const;
+
+    // 供测试注入时钟（PipelineClock 时基）；未设置时使用 PipelineClock::nowNs()
+    void setClock(std::function<std::int64_t()> clock) { clock_ = std::move(clock); }
 
 private:
+    struct Binding {
+        EnvironmentCondition condition;
+        std::function<void(bool)> action;
+    };
+
+    std::int64_t now() const;
+    void notify(EnvironmentCondition condition, bool active);
+
+    core::Pad* outPad_{nullptr};
     bool started_{false};
     EnvironmentState currentState_{EnvironmentState::Normal};
     float confidence_{1.0f};
+    EnvironmentDetectionConfig config_;
+    std::function<std::int64_t()> clock_;
+
+    // 输入回调（生产者线程）写、process() 读
+    mutable std::mutex inputMutex_;
+    bool hasGnss_{false};
+    float hdop_{0.f};
+    int numSatellites_{0};
+    std::int64_t gnssRxNs_{0};
+    bool hasBrightness_{false};
+    float brightness_{-1.f};
+    std::int64_t brightnessRxNs_{0};
+    EnvironmentStatusPacket last_;
+
+    // 仅 process() / start() 线程访问
+    HysteresisLatch gps_;
+    HysteresisLatch lowLight_;
+    std::vector<Binding> bindings_;
 };
 
 } // namespace falconmind::sdk::perception
@@ -0,0 +1,69 @@
+// FalconMindSDK - 精准降落标记检测节点：NV12 / YUYV 帧直接在亮度平面上检测 AprilTag / ArUco，输出目标角点与相对位姿
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/Caps.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/perception/FiducialDetector.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace falconmind::sdk::perception {
+
+// target_out 每帧一包（未找到时 found = 0）
+struct FiducialTargetPacket {
+    std::int64_t timestampNs{0};    // 图像采集时刻
+    std::uint64_t frameIndex{0};
+    std::int32_t id{-1};
+    std::uint8_t found{0};
+    std::uint8_t roiSearch{0};      // 本帧只搜索了预测 ROI
+    std::uint8_t hasPose{0};
+    std::uint8_t reserved{0};
+    float corners[4][2]{};          // 左上 / 右上 / 右下 / 左下，像素
+    float center[2]{};
+    float decisionMargin{0.f};
+    double position[3]{};           // 相机系（x 右 / y 下 / z 光轴），m
+    double yaw{0.};                 // 标记 x 轴在像平面内的转角，rad
+    std::uint32_t processingUs{0};  // 本帧检测耗时
+    std::uint32_t detections{0};    // 本帧检测到的标记数
+};
+
+/**
+ * FiducialDetectionNode
+ *
+ * video_in 只接收 NV12 / YUYV（协商阶段即拒绝 RGB，避免上游为本节点做色彩转换）；回调只保留最新一帧的引用，
+ * process() 检测并从 target_out 推出 FiducialTargetPacket。锁定后每帧只搜索预测 ROI（见 FiducialDetector）。
+ *
+ * 参数：family（tag16h5 / custom）、codes（custom 时逗号分隔的十六进制码，按行、高位在前、白格为 1）、code_side、
+ * min_hamming、target_id（默认 -1）、tag_size_m、fx / fy / cx / cy、min_contrast、min_tag_px、min_decision_margin、
+ * max_hamming、roi_tracking（默认 true）、roi_margin
+ */
+class FiducialDetectionNode : public core::Node {
+public:
+    FiducialDetectionNode();
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void process() override;
+
+    // 以下访问须在 process() 所在线程（或节点停止后）
+    const FiducialDetector& detector() const noexcept { return *detector_; }
+    const FiducialTargetPacket& lastTarget() const noexcept { return last_; }
+
+private:
+    core::Pad* inPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
+    core::Pad* outPad_{nullptr};
+    std::unique_ptr<FiducialDetector> detector_;
+    bool started_{false};
+    bool warnedFormat_{false};
+    std::mutex frameMutex_;
+    core::BufferRef lastFrame_;
+    core::PixelFormat inputFormat_{core::PixelFormat::Any};  // link 协商的输入格式
+    FiducialTargetPacket last_;
+};
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,152 @@
+// FalconMindSDK - 精准降落用方形基准标记（AprilTag / ArUco）检测：亮度平面自适应阈值 + 四边形拟合 + 解码，锁定后只搜预测 ROI
+#pragma once
+
+#include "falconmind/sdk/core/Caps.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * FiducialFamily - 标记编码表
+ *
+ * 标记由 1 格黑色边框包围 side×side 数据格组成（外侧须有白色静区）；数据按行、自左上起、高位在前读出，白格为 1
+ * （AprilTag 2 经典族与 ArUco 字典均为此布局）。内置 tag16h5（30 个码，最小汉明距离 5）；
+ * ArUco 等其他字典经 fromCodes 传入同一布局的码表。
+ */
+struct FiducialFamily {
+    std::string name;
+    int side{4};                       // 数据格边长（位数 = side²，≤ 8）
+    int minHamming{5};                 // 码表最小汉明距离，用于限制可纠正位数
+    std::vector<std::uint64_t> codes;
+
+    static FiducialFamily tag16h5();
+    static FiducialFamily fromCodes(std::string name, int side, int minHamming, std::vector<std::uint64_t> codes);
+    // 码旋转 90°（顺时针）：旋转后标记的读出值
+    std::uint64_t rotate90(std::uint64_t code) const noexcept;
+};
+
+struct FiducialDetectorConfig {
+    int minTagPx{12};              // 四边形最短边（像素），更小的候选不解码
+    int minContrast{20};           // 阈值分块内最大最小亮度差低于此值时不参与分割（无纹理区域）
+    int maxHammingCorrect{0};      // 允许纠正的位数（≤ (minHamming-1)/2；着陆场景默认不纠错以避免误检）
+    float minDecisionMargin{15.f}; // 数据格亮度与阈值的平均差（0~255）低于此值丢弃
+    float maxLineRms{1.2f};        // 四边直线拟合的均方根残差（像素）上限
+    int targetId{-1};              // ROI 跟踪的目标 ID（-1 为最先 / 最大的标记）
+    // ROI 跟踪：以上一次位置 + 像素速度预测本帧中心，半宽为标记外接半径 × (1 + roiMargin) + roiPaddingPx
+    bool roiTracking{true};
+    float roiMargin{0.75f};
+    int roiPaddingPx{16};
+    int maxContourPoints{8192};    // 单个轮廓点数上限（超出视为非标记的大块区域）
+    // 相机内参与标记外边框边长；fx > 0 且 tagSizeM > 0 时输出位姿
+    double fx{0.}, fy{0.}, cx{0.}, cy{0.};
+    double tagSizeM{0.};
+};
+
+struct FiducialDetection {
+    int id{-1};
+    int hamming{0};
+    float decisionMargin{0.f};
+    // 左上 / 右上 / 右下 / 左下（标记自身方向，整帧像素坐标）
+    std::array<std::array<float, 2>, 4> corners{};
+    std::array<float, 2> center{};
+    // 位姿（相机系 x 右 / y 下 / z 光轴）：标记中心位置（m）与标记 x 轴在像平面内的转角（rad）
+    bool hasPose{false};
+    std::array<double, 3> position{};
+    std::array<double, 9> rotation{};  // 标记系 → 相机系，行主序
+    double yaw{0.};
+};
+
+struct FiducialRoi {
+    int x{0}, y{0}, width{0}, height{0};
+};
+
+struct FiducialResult {
+    std::vector<FiducialDetection> detections;
+    int targetIndex{-1};       // detections 中被跟踪的目标
+    bool roiSearch{false};     // 本帧只在预测 ROI 内搜索并命中
+    FiducialRoi searched;      // 本帧最后一次搜索的区域
+    std::uint32_t candidates{0};  // 解码的四边形候选数
+};
+
+/**
+ * FiducialDetector - 亮度平面上的方形标记检测
+ *
+ * 1. 自适应阈值：4×4 分块求最小 / 最大亮度（SSE4.1 / AVX2 / NEON 向量内核，运行时按 CpuFeatures 选择），
+ *    取 3×3 邻域分块的极值中点为阈值，逐行向量比较得到黑 / 白 / 低对比三值图
+ * 2. 黑色连通域（8 邻接）外轮廓跟踪；轮廓取四个极点分为四段，每段最小二乘拟合直线（外移半像素到明暗边界），
+ *    相邻直线求交得到亚像素角点
+ * 3. 四角单应采样格中心亮度：边框须为黑，阈值取边框与外侧静区均值中点；数据位按四个旋转方向匹配码表
+ * 4. 跟踪：锁定后下一帧只处理预测 ROI（按上一帧位置与像素速度外推）；ROI 内未找到目标时同一帧回退整帧搜索
+ * 直接读取 NV12 / GRAY 的 Y 平面；YUYV 只把搜索区域的亮度抽到内部缓冲（向量解交错），不做色彩转换。
+ * 各缓冲在首帧按图像尺寸分配后复用。非线程安全：同一实例的 detect() 须串行调用。
+ */
+class FiducialDetector {
+public:
+    explicit FiducialDetector(FiducialFamily family = FiducialFamily::tag16h5(), FiducialDetectorConfig config = {});
+
+    const FiducialFamily& family() const noexcept { return family_; }
+    const FiducialDetectorConfig& config() const noexcept { return config_; }
+    void setConfig(const FiducialDetectorConfig& config);
+
+    // data 为 Y 平面（NV12 / Any 视为单通道亮度）或 YUYV 交错数据；stride 为行字节数（≤ 0 按紧凑排列）
+    const FiducialResult& detect(const std::uint8_t* data, int width, int height, int stride, core::PixelFormat format);
+    // 放弃锁定：下一帧整帧搜索
+    void resetTracking() noexcept { locked_ = false; }
+
+    bool locked() const noexcept { return locked_; }
+    const FiducialResult& lastResult() const noexcept { return result_; }
+    std::uint64_t roiFrames() const noexcept { return roiFrames_; }
+    std::uint64_t fullFrames() const noexcept { return fullFrames_; }
+    // 当前使用的向量内核（"avx2" / "sse4.1" / "neon" / "scalar"）
+    static const char* kernelName() noexcept;
+
+private:
+    struct Quad {
+        std::array<std::array<double, 2>, 4> c;
+    };
+
+    // 在 roi 内搜索；返回本次新增的检测数
+    int search(const FiducialRoi& roi);
+    bool loadLuma(const FiducialRoi& roi);
+    void threshold(int w, int h);
+    void segment(int w, int h);
+    bool traceContour(int sx, int sy, int w, int h);
+    bool fitQuad(Quad& quad, int w, int h) const;
+    bool decode(const Quad& quad, FiducialDetection& out) const;
+    void computePose(FiducialDetection& det) const;
+    FiducialRoi predictRoi() const;
+    int pickTarget() const;
+
+    FiducialFamily family_;
+    FiducialDetectorConfig config_;
+    std::vector<std::array<std::uint64_t, 4>> rotatedCodes_;
+
+    // 当前帧
+    const std::uint8_t* frame_{nullptr};
+    int width_{0}, height_{0}, stride_{0};
+    core::PixelFormat format_{core::PixelFormat::Any};
+    // 搜索区域的亮度（NV12 / 灰度时直接指向帧内，YUYV 时指向 lumaBuf_）
+    const std::uint8_t* luma_{nullptr};
+    int lumaStride_{0};
+    int originX_{0}, originY_{0};
+
+    std::vector<std::uint8_t> lumaBuf_;
+    std::vector<std::uint8_t> tileMin_, tileMax_, tileThr_, tileValid_;
+    std::vector<std::uint8_t> rowThr_, rowValid_;
+    std::vector<std::uint8_t> binary_;  // 0 黑 / 1 已访问的黑 / 127 低对比 / 255 白
+    std::vector<std::int32_t> stack_;
+    std::vector<std::array<int, 2>> contour_;
+
+    FiducialResult result_;
+    bool locked_{false};
+    FiducialDetection last_;
+    std::array<float, 2> velocity_{};
+    std::uint64_t roiFrames_{0};
+    std::uint64_t fullFrames_{0};
+};
+
+} // namespace falconmind::sdk::perception
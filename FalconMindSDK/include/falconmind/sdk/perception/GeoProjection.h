@@ -0,0 +1,162 @@
+// FalconMindSDK - 轨迹地理投影：按同步的飞行状态与云台姿态把像素框批量投影到地面经纬度
+#pragma once
+
+#include "falconmind/sdk/core/FixedMatrix.h"
+#include "falconmind/sdk/flight/FlightTypes.h"
+#include "falconmind/sdk/perception/TerrainTileCache.h"
+#include "falconmind/sdk/perception/TrackingTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+// 针孔相机内参（像素）；畸变须已在上游校正
+struct CameraIntrinsics {
+    double fx{0.}, fy{0.};
+    double cx{0.}, cy{0.};
+
+    // 由图像尺寸与水平视场角（度）构造，主点取图像中心、像素为方形
+    static CameraIntrinsics fromHorizontalFov(int width, int height, double hfovDeg);
+};
+
+// 云台（相机）相对机体 FRD 系的姿态，弧度；pitch = -π/2 为垂直向下
+struct GimbalPose {
+    double roll{0.};
+    double pitch{0.};
+    double yaw{0.};
+    std::uint64_t timestampNs{0};
+};
+
+/**
+ * GroundElevationModel - 地面高程（海拔，米）查询
+ *
+ * 默认为平地（flatHeight）；setGrid 载入预先计算的规则经纬度网格 DEM 后按双线性插值查询，
+ * 网格外回退到平地高度。网格为行主序，第 r 行对应纬度 originLat + r * latSpacingDeg。
+ * setTerrain 挂接 mmap 瓦片缓存（大范围 DEM，可与规划共享），优先于网格查询，瓦片无数据处回退到网格 / 平地。
+ */
+class GroundElevationModel {
+public:
+    explicit GroundElevationModel(double flatHeight = 0.) : flatHeight_(flatHeight) {}
+
+    void setFlatHeight(double h) { flatHeight_ = h; }
+    double flatHeight() const noexcept { return flatHeight_; }
+    bool setGrid(double originLat, double originLon, double latSpacingDeg, double lonSpacingDeg, int rows,
+                 int cols, std::vector<float> heights);
+    void setTerrain(std::shared_ptr<const TerrainTileCache> terrain) { terrain_ = std::move(terrain); }
+    const std::shared_ptr<const TerrainTileCache>& terrain() const noexcept { return terrain_; }
+    // 已载入网格或瓦片 DEM
+    bool hasGrid() const noexcept { return !grid_.empty() || terrain_; }
+
+    double heightAt(double lat, double lon) const;
+
+private:
+    double flatHeight_;
+    double originLat_{0.}, originLon_{0.};
+    double latSpacing_{0.}, lonSpacing_{0.};
+    int rows_{0}, cols_{0};
+    std::vector<float> grid_;
+    std::shared_ptr<const TerrainTileCache> terrain_;
+};
+
+struct GeoTrack {
+    int trackId{-1};
+    int classId{-1};
+    std::string className;
+    std::string status;
+    bool valid{false};       // false：无最新框、射线高于地平线或超出 maxRange
+    double lat{0.}, lon{0.};
+    double alt{0.};          // 投影点地面海拔
+    double rangeM{0.};       // 相机到投影点的斜距
+    DetectionBBox bbox;      // 最新框（像素），供裁剪事件缩略图
+};
+
+// 与 TrackingResult 一一对应（tracks 顺序相同）
+struct GeoTrackingResult {
+    std::string frameId;
+    std::uint64_t timestampNs{0};
+    std::uint32_t frameIndex{0};
+    flight::FlightState vehicle;   // 插值到帧时刻的飞行状态
+    GimbalPose gimbal;             // 插值到帧时刻的云台姿态
+    std::vector<GeoTrack> tracks;
+};
+
+/**
+ * GeoProjector
+ *
+ * 飞控线程 / 云台驱动分别 pushFlightState / pushGimbalPose（带时间戳，PipelineClock 时基），
+ * project() 按 TrackingResult::timestampNs 线性插值得到同步的位姿，每帧只构造一次相机 → NED 旋转，
+ * 再对全部轨迹框底边中点（目标接地点）以结构数组形式批量求射线并与地面求交：
+ * 平地一次求交；有 DEM 时以交点高程迭代修正（maxDemIterations 次）。
+ * 经纬度按无人机处的局部切平面换算（地球半径 6371 km，适用于数公里内的斜距）。
+ *
+ * 未设置云台姿态时使用固定安装姿态（setCameraMount，默认垂直向下）。
+ * FlightState 姿态为 MAVLink ATTITUDE 弧度值，alt 为海拔（与 DEM 同一基准）。线程安全。
+ */
+class GeoProjector {
+public:
+    GeoProjector() = default;
+    explicit GeoProjector(const CameraIntrinsics& intrinsics) : intrinsics_(intrinsics) {}
+
+    void setIntrinsics(const CameraIntrinsics& intrinsics);
+    void setCameraMount(const GimbalPose& mount);
+    void setGround(GroundElevationModel ground);
+    // 相邻两次位姿样本与帧时刻的最大允许间隔，超出视为未同步（默认 200 ms）
+    void setMaxSyncGapNs(std::uint64_t ns) { maxSyncGapNs_ = ns; }
+    void setMaxRangeM(double m) { maxRangeM_ = m; }
+    void setMaxDemIterations(int n) { maxDemIterations_ = n > 0 ? n : 1; }
+    void setHistoryCapacity(std::size_t n);
+
+    void pushFlightState(const flight::FlightState& state, std::uint64_t timestampNs);
+    void pushGimbalPose(const GimbalPose& pose);
+
+    // 按帧时刻插值位姿后投影；没有可用的同步飞行状态时返回 false（out.tracks 清空）
+    bool project(const TrackingResult& tracks, GeoTrackingResult& out);
+    // 使用给定位姿投影（调用方已完成同步）
+    bool project(const TrackingResult& tracks, const flight::FlightState& vehicle, const GimbalPose& gimbal,
+                 GeoTrackingResult& out);
+
+    // 单点投影（像素坐标），供测试 / 标定使用
+    bool projectPixel(double u, double v, const flight::FlightState& vehicle, const GimbalPose& gimbal,
+                      double& lat, double& lon, double& alt) const;
+    // 深度抬升：像素 (u, v) 处光轴深度 depthM（如 StereoDepthNode Z16 深度 / 1000）对应的三维点，不与地面求交，
+    // 适用于高于地面的目标（屋顶、其他飞行器）；depthM 非正时返回 false
+    bool liftPixel(double u, double v, double depthM, const flight::FlightState& vehicle, const GimbalPose& gimbal,
+                   double& lat, double& lon, double& alt) const;
+
+private:
+    struct TimedState {
+        std::uint64_t timestampNs;
+        flight::FlightState state;
+    };
+
+    using Mat3 = core::Matrix<double, 3, 3>;
+    static Mat3 cameraToNed(const flight::FlightState& vehicle, const GimbalPose& gimbal);
+    bool stateAt(std::uint64_t ts, flight::FlightState& out) const;
+    bool gimbalAt(std::uint64_t ts, GimbalPose& out) const;
+    // 对 u_/v_ 中的 n 个像素批量求交，结果写入 lat_/lon_/alt_/range_/ok_
+    void projectBatch(std::size_t n, const flight::FlightState& vehicle, const GimbalPose& gimbal);
+
+    mutable std::mutex mutex_;
+    CameraIntrinsics intrinsics_;
+    GimbalPose mount_{0., -1.5707963267948966, 0., 0};
+    GroundElevationModel ground_;
+    std::uint64_t maxSyncGapNs_{200'000'000};
+    double maxRangeM_{5000.};
+    int maxDemIterations_{4};
+    std::size_t historyCapacity_{64};
+    std::deque<TimedState> states_;
+    std::deque<GimbalPose> gimbals_;
+
+    // 每帧复用的批量缓冲（结构数组）
+    std::vector<double> u_, v_, rn_, re_, rd_, lat_, lon_, alt_, range_;
+    std::vector<std::uint8_t> ok_;
+    std::vector<int> trackOf_;
+};
+
+} // namespace falconmind::sdk::perception
@@ -3,7 +3,12 @@
 
 #include "falconmind/sdk/perception/DetectionTypes.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
+#include <vector>
 
 namespace falconmind::sdk::perception {
 
@@ -23,6 +28,99 @@ public:
 
     // 对单帧图像执行一次检测
     virtual bool run(const ImageView& image, DetectionResult& outResult) = 0;
+
+    // 一次推理 count 帧：results[i] 对应 images[i]，任一帧失败返回 false（其余结果仍有效）。
+    // 默认逐帧调用 run()；支持动态 batch 的后端把多帧合成一个 batch 执行，count 超过 maxBatchSize() 时分次执行
+    virtual bool runBatch(const ImageView* images, DetectionResult* results, std::size_t count) {
+        bool ok = true;
+        for (std::size_t i = 0; i < count; ++i) {
+            ok = run(images[i], results[i]) && ok;
+        }
+        return ok;
+    }
+
+    // 单次推理可合并的最大帧数（模型 batch 维上限）；1 表示 runBatch() 只是逐帧执行
+    virtual std::size_t maxBatchSize() const { return 1; }
+
+    // 可同时调用 run() 的线程数（如多个 NPU 上下文）；1 表示 run() 须串行调用。
+    // 大于 1 时 DetectorDispatcher 以同样多的线程并发推理并按提交顺序输出结果
+    virtual std::size_t maxConcurrentRuns() const { return 1; }
+
+    // 异步推理完成回调：ok 与 run() 的返回值含义相同；在后端的推理线程上调用（默认实现为 submit() 的调用线程），
+    // 应尽快返回，且不得在回调内向同一后端 submit()
+    using DetectionCallback = std::function<void(bool ok)>;
+
+    // 异步推理：提交一帧，完成后回调 done；image 的像素与 outResult 须保持有效直到回调返回。
+    // 在途帧达到 maxInFlight() 时阻塞至有空位；返回 false 表示未能提交（不会回调）。
+    // 默认实现在调用线程同步 run() 后回调；RKNN / TensorRT / ONNXRuntime 交给内部推理线程
+    // （AsyncInferenceQueue，每个 NPU 上下文 / CUDA stream 一个），单个提交线程即可让多帧重叠
+    virtual bool submit(const ImageView& image, DetectionResult& outResult, DetectionCallback done) {
+        const bool ok = run(image, outResult);
+        if (done) done(ok);
+        return true;
+    }
+
+    // submit() 可同时在途（排队 + 执行中）的帧数；1 表示 submit() 同步完成
+    virtual std::size_t maxInFlight() const { return 1; }
+
+    // submit() 的 future 形式：future 的值为推理是否成功
+    std::future<bool> runAsync(const ImageView& image, DetectionResult& outResult) {
+        auto promise = std::make_shared<std::promise<bool>>();
+        std::future<bool> future = promise->get_future();
+        if (!submit(image, outResult, [promise](bool ok) { promise->set_value(ok); })) promise->set_value(false);
+        return future;
+    }
+
+    // 分阶段执行（DetectionNode 流水线）：前处理、推理、后处理由不同线程对相邻帧并发执行。
+    // prepareStages(slots) 分配 slots 份中间缓冲并返回实际份数，0 表示不支持（调用方改用 run()），须在 load() 之后调用。
+    // 同一 slot 依次经过 preprocessStage → inferStage → postprocessStage 后才会被复用；
+    // preprocessStage 与 postprocessStage 各由单一线程按帧顺序调用，inferStage 可由 maxConcurrentRuns() 个线程对不同 slot 并发调用
+    virtual std::size_t prepareStages(std::size_t slots) {
+        (void)slots;
+        return 0;
+    }
+    virtual bool preprocessStage(std::size_t slot, const ImageView& image) {
+        (void)slot;
+        (void)image;
+        return false;
+    }
+    virtual bool inferStage(std::size_t slot) {
+        (void)slot;
+        return false;
+    }
+    virtual bool postprocessStage(std::size_t slot, DetectionResult& outResult) {
+        (void)slot;
+        (void)outResult;
+        return false;
+    }
+
+    // ReID 外观特征：加载了嵌入模型的后端返回特征维度（0 表示不支持）。
+    // runEmbeddings 对 count 个目标裁剪图执行一次批量推理，out 依次写入 count × embeddingDim() 个值（无需归一化）
+    virtual std::size_t embeddingDim() const { return 0; }
+    virtual bool runEmbeddings(const ImageView* crops, std::size_t count, std::vector<float>& out) {
+        (void)crops;
+        (void)count;
+        (void)out;
+        return false;
+    }
+
+    // 可直接接受的输入像素格式（按偏好排序），用于 Pipeline 连接时的格式协商
+    virtual std::vector<core::PixelFormat> supportedPixelFormats() const {
+        return {core::PixelFormat::RGB8, core::PixelFormat::BGR8};
+    }
+
+    // 把推理绑定到指定 NPU 核（bit0 = core0 ...，0 为自动）；加载前后均可调用，不支持的后端返回 false
+    virtual bool setNpuCoreMask(std::uint32_t mask) {
+        (void)mask;
+        return false;
+    }
+
+    // 类别掩码（任务关注的类别 ID，空为全部）：解码只读取这些类别行，其余类别不输出。
+    // 不得与 run() 并发调用（DetectionNode 在 start() 时设置）；不支持的后端返回 false
+    virtual bool setClassFilter(const std::vector<int>& classIds) {
+        (void)classIds;
+        return false;
+    }
 };
 
 using DetectorBackendPtr = std::shared_ptr<IDetectorBackend>;
@@ -1,5 +1,6 @@
 // FalconMindSDK - 算法容器 SLAM 服务客户端抽象（供 VisualSlamNode / LidarSlamNode 对接）
-// 已实现：Stub、FromFile（从文件读位姿）；可选 gRPC 客户端见 SlamServiceGrpcClient。
+// 已实现：Stub、FromFile（从文件读位姿）、StreamingSlamClient（订阅位姿流，gRPC 传输见 SlamServiceGrpcClient）、
+// SlamServiceClientFromShm（共享内存位姿通道，见 ShmPoseChannel）。
 #pragma once
 
 #include "falconmind/sdk/perception/PoseTypes.h"
@@ -30,7 +31,8 @@ public:
     bool isAvailable() const override { return false; }
 };
 
-/** 从文件读取位姿：算法容器将当前位姿写入指定文件（二进制 Pose3D 布局），SDK 周期性读取 */
+/** 从文件读取位姿：算法容器将当前位姿写入指定文件（二进制 Pose3D 布局），SDK 周期性读取。
+ *  每次读取都打开文件，且可能读到写入一半的位姿；同机部署优先使用 SlamServiceClientFromShm */
 class SlamServiceClientFromFile : public ISlamServiceClient {
 public:
     explicit SlamServiceClientFromFile(std::string path) : poseFilePath_(std::move(path)) {}
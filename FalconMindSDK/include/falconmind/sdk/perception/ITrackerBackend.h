@@ -6,6 +6,11 @@
 
 #include <memory>
 
+namespace falconmind::sdk::core {
+class CheckpointWriter;
+class CheckpointReader;
+} // namespace falconmind::sdk::core
+
 namespace falconmind::sdk::perception {
 
 class ITrackerBackend {
@@ -20,6 +25,25 @@ public:
     // - 可直接在 detections 中填充 trackId；
     // - 可在 outTracks 中输出更详细的轨迹。
     virtual bool run(DetectionResult& detections, TrackingResult& outTracks) = 0;
+
+    // 本帧未运行检测（detections.trackerPredicted）：仅按运动模型外推轨迹，不计为漏检；
+    // 外推的框写回 detections（带 trackId）。不支持预测的后端返回 false
+    virtual bool predict(DetectionResult& detections, TrackingResult& outTracks) {
+        (void)detections;
+        (void)outTracks;
+        return false;
+    }
+
+    // 热重启（core::CheckpointSection）：把轨迹状态写入检查点 / 在 load() 之后从检查点恢复，
+    // 恢复后轨迹 ID 与编号延续，不会重新发放。不支持的后端返回 false
+    virtual bool saveState(core::CheckpointWriter& out) const {
+        (void)out;
+        return false;
+    }
+    virtual bool restoreState(core::CheckpointReader& in) {
+        (void)in;
+        return false;
+    }
 };
 
 using TrackerBackendPtr = std::shared_ptr<ITrackerBackend>;
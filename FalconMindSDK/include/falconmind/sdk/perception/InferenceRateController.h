@@ -0,0 +1,89 @@
+// FalconMindSDK - InferenceRateController：按跟踪置信度自适应调整检测频率
+#pragma once
+
+#include "falconmind/sdk/perception/DetectionTypes.h"
+#include "falconmind/sdk/perception/TrackingTypes.h"
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+struct InferenceRateConfig {
+    int baseInterval{5};               // 无触发时每 baseInterval 帧完整检测一次；1 为每帧检测
+    float maxTrackUncertainty{0.5f};   // 任一轨迹预测不确定度（相对目标尺寸）超过时下一帧立即检测
+    float motionThreshold{12.f};       // 与上次检测帧的平均亮度差（0~255）超过时本帧立即检测；<= 0 关闭
+    bool detectOnTrackLost{true};      // 出现 LOST 轨迹时下一帧立即检测
+};
+
+// 本帧运行检测的原因
+enum class DetectTrigger : std::uint8_t {
+    None = 0,     // 未检测，由跟踪器预测
+    First,        // 首帧 / reset() 之后
+    Interval,     // 达到 baseInterval
+    Motion,       // 画面变化
+    Uncertainty,  // 轨迹预测不确定度过大
+    TrackLost,    // 轨迹丢失
+    Requested,    // requestDetection()
+    Count
+};
+
+/**
+ * InferenceRateController - 检测节点与跟踪节点共享的检测频率控制器
+ *
+ * 目标稳定跟踪时不必每帧运行检测：按 baseInterval 定期检测，间隔帧由跟踪器（SortTrackerBackend::predict）外推；
+ * 画面出现新运动、轨迹不确定度增大或轨迹丢失时立即恢复检测。
+ * - DetectionNode 前处理级对每帧调用 shouldDetect()；返回 false 的帧不推理，输出 trackerPredicted 标记的空结果
+ * - TrackingTransformNode 每次更新后调用 observeTracks()，不确定度 / 丢失触发在下一帧生效
+ * 线程安全：shouldDetect() 须串行调用，observeTracks() / requestDetection() 可在任意线程调用。
+ */
+class InferenceRateController {
+public:
+    explicit InferenceRateController(InferenceRateConfig config = {});
+
+    // 本帧是否运行检测；运动判断按 8 像素网格采样亮度（RGB8/BGR8/NV12/YUYV，其他格式不做运动判断）
+    bool shouldDetect(const ImageView& image);
+    // 根据最新跟踪结果（TrackingState::uncertainty / status）决定是否请求下一帧立即检测
+    void observeTracks(const TrackingResult& tracks);
+    // 外部强制下一帧检测（如任务阶段切换）
+    void requestDetection();
+    // 清空状态：下一帧视为首帧
+    void reset();
+
+    // 运行中调整定期检测间隔（如 ThermalGovernor 降频）；< 1 按 1，下一帧生效
+    void setBaseInterval(int interval);
+    int baseInterval() const;
+
+    const InferenceRateConfig& config() const noexcept { return config_; }
+    DetectTrigger lastTrigger() const;
+    std::uint64_t detectedFrames() const;
+    std::uint64_t predictedFrames() const;
+    std::uint64_t triggerCount(DetectTrigger trigger) const;
+    // 最近一帧与上次检测帧的平均亮度差
+    float lastMotion() const;
+
+private:
+    bool sampleLuma(const ImageView& image);
+    float motionScore() const;
+
+    InferenceRateConfig config_;
+    mutable std::mutex mutex_;
+    DetectTrigger pending_{DetectTrigger::First};  // 跟踪级请求的触发，下一帧生效
+    DetectTrigger lastTrigger_{DetectTrigger::None};
+    int sinceDetect_{0};
+    float lastMotion_{0.f};
+    std::uint64_t detected_{0};
+    std::uint64_t predicted_{0};
+    std::array<std::uint64_t, static_cast<std::size_t>(DetectTrigger::Count)> triggers_{};
+
+    // 亮度采样网格（仅 shouldDetect() 线程访问）：luma_ 为当前帧，refLuma_ 为上次检测帧
+    static constexpr int kMotionStep = 8;
+    int gridW_{0};
+    int gridH_{0};
+    std::vector<std::uint8_t> luma_;
+    std::vector<std::uint8_t> refLuma_;
+};
+
+} // namespace falconmind::sdk::perception
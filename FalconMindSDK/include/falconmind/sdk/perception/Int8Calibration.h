@@ -0,0 +1,122 @@
+// FalconMindSDK - INT8 校准：从任务录制文件抽取代表性帧，按 SDK 运行时的前处理生成 RKNN / TensorRT 校准数据集
+#pragma once
+
+#include "falconmind/sdk/perception/DetectionTypes.h"
+#include "falconmind/sdk/perception/YoloPrePostProcess.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::core {
+class CaptureReader;
+}
+
+namespace falconmind::sdk::perception {
+
+struct CalibrationOptions {
+    std::size_t maxFrames{300};       // 校准集帧数上限；候选更多时在时间上均匀抽取
+    // 与上一个保留帧的 16×16 亮度缩略图平均绝对差（0~255）低于此值视为重复帧（悬停、静止画面），0 为不去重
+    float minFrameDifference{4.f};
+};
+
+// 校准集中的一帧：来源录制文件与记录序号
+struct CalibrationFrame {
+    std::string source;
+    std::size_t record{0};
+    std::int64_t timestampNs{0};
+    float meanLuma{0.f};
+};
+
+/**
+ * Int8CalibrationDataset - 由录制的相机帧（CaptureRecorderNode 文件）生成 INT8 校准数据集
+ *
+ * 校准帧的张量由与检测后端相同的 YoloPreprocessor（yoloPreprocessConfig(desc)：letterbox / 填充灰度 / 缩放卸载）
+ * 生成，避免离线工具自行 resize 导致的量化参数失配：
+ * - RKNN：uint8 NHWC RGB（运行时喂给 rknn_inputs_set 的像素），归一化由模型转换时的 mean/std 完成，
+ *   须与 inputMean / inputStd 一致（写入 calibration.json）；write() 输出 rknn-toolkit2 的 dataset.txt + .npy
+ * - TensorRT / ONNXRuntime：float32 NCHW [0,1]，与推理输入逐位一致；由 Int8CalibrationStream 读回供
+ *   IInt8EntropyCalibrator2::getBatch 使用，构建得到的校准表写入 calibration.cache
+ * addCapture() 只记录候选帧及其亮度缩略图（录制文件保持映射），write() 时再对选中的帧做前处理。
+ */
+class Int8CalibrationDataset {
+public:
+    explicit Int8CalibrationDataset(const DetectorDescriptor& desc, CalibrationOptions options = {});
+    ~Int8CalibrationDataset();
+    Int8CalibrationDataset(const Int8CalibrationDataset&) = delete;
+    Int8CalibrationDataset& operator=(const Int8CalibrationDataset&) = delete;
+
+    // 后端对应的校准张量格式（模型输入尺寸，0 时取 640）
+    static InputTensorSpec calibrationTensorSpec(const DetectorDescriptor& desc);
+
+    // 读取录制文件中的相机帧作为候选；返回新增（去重后）的候选数，文件不可读或非捕获文件返回 0
+    std::size_t addCapture(const std::string& path);
+    std::size_t candidates() const noexcept { return candidates_.size(); }
+    // 按 maxFrames 在全部候选中均匀选出的校准帧
+    std::vector<CalibrationFrame> selectedFrames() const;
+
+    // 选中帧的校准张量（inputTensorBytes(spec()) 字节）；失败返回 false
+    bool tensor(std::size_t selectedIndex, void* dst);
+
+    /**
+     * 写出到 outputDir（不存在时创建；先清除上次的输出与校准表）：
+     *   calib_NNNN.npy    每帧一个（RKNN 为 (H, W, 3) uint8，TensorRT 为 (1, 3, H, W) float32）
+     *   dataset.txt       每行一个 .npy 绝对路径（rknn-toolkit2 build(dataset=...)）
+     *   calibration.json  检测器、张量格式、前处理参数、RKNN mean/std 与各帧来源
+     * 返回写出的帧数
+     */
+    std::size_t write(const std::string& outputDir);
+
+    const DetectorDescriptor& descriptor() const noexcept { return desc_; }
+    const InputTensorSpec& spec() const noexcept { return spec_; }
+
+private:
+    struct Candidate {
+        std::size_t capture{0};
+        std::size_t record{0};
+        float meanLuma{0.f};
+    };
+
+    std::vector<std::size_t> selection() const;
+
+    DetectorDescriptor desc_;
+    CalibrationOptions options_;
+    InputTensorSpec spec_;
+    std::unique_ptr<YoloPreprocessor> preprocessor_;
+    std::vector<std::shared_ptr<core::CaptureReader>> captures_;
+    std::vector<Candidate> candidates_;
+    std::array<std::uint8_t, 256> lastThumb_{};
+    bool haveThumb_{false};
+};
+
+/**
+ * Int8CalibrationStream - 读回 Int8CalibrationDataset::write() 的输出，供 engine 构建时的校准器使用：
+ * nextBatch() 对应 getBatch()（拷到 host 缓冲后由调用方上传），readCache()/writeCache() 对应
+ * readCalibrationCache()/writeCalibrationCache()，校准表保存为数据集目录下的 calibration.cache
+ */
+class Int8CalibrationStream {
+public:
+    bool open(const std::string& datasetDir);
+
+    std::size_t size() const noexcept { return files_.size(); }
+    const InputTensorSpec& spec() const noexcept { return spec_; }
+    // 依次读出至多 batchSize 帧到 dst（batchSize × inputTensorBytes(spec()) 字节）；返回帧数，读完返回 0
+    std::size_t nextBatch(void* dst, std::size_t batchSize);
+    void reset() noexcept { cursor_ = 0; }
+
+    std::string cachePath() const;
+    // 校准表不存在时返回空
+    std::vector<char> readCache() const;
+    bool writeCache(const void* data, std::size_t size) const;
+
+private:
+    std::string dir_;
+    InputTensorSpec spec_;
+    std::vector<std::string> files_;
+    std::size_t cursor_{0};
+};
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,109 @@
+// FalconMindSDK - 激光雷达-相机融合：点云经预计算投影矩阵批量投到图像，按网格分桶后为每个检测框取深度中位数
+#pragma once
+
+#include "falconmind/sdk/perception/DetectionTypes.h"
+#include "falconmind/sdk/perception/GeoProjection.h"
+#include "falconmind/sdk/sensors/PointCloudPacket.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * 雷达 → 相机标定：相机为光学系（x 右、y 下、z 沿光轴），内参为检测所用图像分辨率下的像素值。
+ * 点 p_cam = R · p_lidar + t；R 行主序。
+ */
+struct LidarCameraCalibration {
+    CameraIntrinsics intrinsics;
+    std::array<double, 9> R{1., 0., 0., 0., 1., 0., 0., 0., 1.};
+    std::array<double, 3> t{0., 0., 0.};
+    int imageWidth{0};
+    int imageHeight{0};
+
+    bool valid() const noexcept {
+        return intrinsics.fx > 0. && intrinsics.fy > 0. && imageWidth > 0 && imageHeight > 0;
+    }
+};
+
+struct LidarCameraFusionConfig {
+    int cellSize{8};             // 深度网格边长（像素）
+    float minDepthM{0.5f};       // 光轴深度有效范围
+    float maxDepthM{200.f};
+    float boxShrink{0.1f};       // 检测框每边内缩的比例，减少框边缘背景点
+    int minPoints{3};            // 框内点数少于此值时不给出深度
+};
+
+// 单个检测框的深度估计（与输入检测一一对应）
+struct DetectionDepth {
+    bool valid{false};
+    float depthM{0.f};           // 框内点光轴深度的中位数
+    float minDepthM{0.f};        // 框内最近点
+    float rangeM{0.f};           // 框中心沿视线方向、光轴深度 depthM 处的斜距
+    int points{0};               // 参与统计的点数
+};
+
+struct LidarCameraFusionStats {
+    std::uint64_t frames{0};
+    std::uint32_t lastInput{0};      // 最近一帧输入点数
+    std::uint32_t lastInImage{0};    // 最近一帧落在图像内且深度有效的点数
+    std::uint64_t boxesWithDepth{0};
+    std::uint64_t boxesWithoutDepth{0};
+};
+
+/**
+ * LidarCameraFusion - 为检测框补充激光雷达距离
+ *
+ * setCalibration 时把 K · [R | t] 预乘为 3×4 投影矩阵；每帧（调用方已按时间戳对齐点云与图像）：
+ * 1. 批量投影：结构数组 x / y / z 每次 8 / 4 个点做矩阵乘与透视除法（AVX2 / SSE4.1 / NEON，运行时按 CpuFeatures
+ *    选择，否则标量），输出像素坐标与光轴深度
+ * 2. 分桶：图像内、深度有效的点按 cellSize 像素网格计数排序，得到每格点区间（二维索引，两趟线性扫描、无堆分配）
+ * 3. 每个检测框只访问覆盖的网格，取内缩后框内点的光轴深度中位数（nth_element）
+ * 缓冲逐帧复用；10 Hz、数万点的降采样点云与数十个框在单核上为毫秒级。非线程安全。
+ */
+class LidarCameraFusion {
+public:
+    explicit LidarCameraFusion(LidarCameraFusionConfig config = {});
+
+    bool setCalibration(const LidarCameraCalibration& calib);
+    const LidarCameraCalibration& calibration() const noexcept { return calib_; }
+    const LidarCameraFusionConfig& config() const noexcept { return config_; }
+
+    // 投影并分桶一帧点云；未标定时返回 false
+    bool setPointCloud(const float* x, const float* y, const float* z, std::size_t count);
+    bool setPointCloud(const sensors::PointCloudView& cloud);
+
+    // 最近一帧点云下各检测框的深度（out 与 detections 等长）
+    void estimate(const std::vector<Detection>& detections, std::vector<DetectionDepth>& out);
+    DetectionDepth estimate(const DetectionBBox& bbox);
+
+    // 最近一帧落在图像内的点数
+    std::size_t pointsInImage() const noexcept { return binned_.size(); }
+    LidarCameraFusionStats stats() const noexcept { return stats_; }
+
+    // 当前使用的向量内核（"avx2" / "sse4.1" / "neon" / "scalar"）
+    static const char* kernelName() noexcept;
+
+private:
+    struct BinnedPoint {
+        float u, v, depth;
+    };
+
+    std::array<float, 12> P_{};  // K · [R | t]，行主序
+    LidarCameraCalibration calib_;
+    LidarCameraFusionConfig config_;
+    bool calibrated_{false};
+    int gridW_{0}, gridH_{0};
+
+    // 每帧复用
+    std::vector<float> u_, v_, depth_;
+    std::vector<std::uint32_t> cellOf_;
+    std::vector<std::uint32_t> cellStart_;  // gridW_ × gridH_ + 1 项
+    std::vector<BinnedPoint> binned_;       // 按网格排序
+    std::vector<float> scratch_;
+    LidarCameraFusionStats stats_;
+};
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,129 @@
+// FalconMindSDK - 机载激光雷达里程计：降采样扫描对增量体素哈希地图做点到面 ICP（容器不可用时的 GPS 拒止备份）
+#pragma once
+
+#include "falconmind/sdk/perception/PoseTypes.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::core {
+class WorkerGroup;
+}
+
+namespace falconmind::sdk::perception {
+
+struct LidarOdometryConfig {
+    float scanVoxel{0.5f};         // 输入扫描体素降采样边长（米），取体素内质心
+    float mapVoxel{1.0f};          // 地图哈希体素边长：近邻搜索在 mapVoxel / 2 半径内精确
+    float mapPointSpacing{0.3f};   // 同一地图体素内点的最小间距，体素满 16 点后不再加入
+    int neighbors{5};              // 拟合局部平面的近邻数（3~8）
+    float maxCorrespondence{1.0f}; // 近邻最远距离（米）
+    float planeThreshold{0.1f};    // 近邻到拟合平面的最大距离（米），超出视为非平面
+    int maxIterations{10};
+    double convergeTranslation{1e-3};  // 单次迭代增量低于此值（米 / 弧度）即收敛
+    double convergeRotation{1e-4};
+    float minRange{1.0f};          // 近于此距离的点视为机体自身回波
+    float maxRange{80.0f};
+    double mapRadius{100.0};       // 以当前位置为中心的地图保留半径（米）
+    std::size_t maxMapVoxels{200000};
+    std::size_t minCorrespondences{50};  // 少于此数视为退化，位姿按匀速外推且不更新地图
+    std::size_t threads{0};        // 对应点搜索分片数（0 为 WorkerGroup::defaultCount()）
+};
+
+struct LidarOdometryResult {
+    bool converged{false};
+    bool degenerate{false};
+    int iterations{0};
+    std::uint32_t inputPoints{0};      // 降采样后的点数
+    std::uint32_t correspondences{0};  // 末次迭代的有效点到面约束数
+    double rmse{0.};                   // 末次迭代点到面残差均方根（米）
+};
+
+/**
+ * LidarOdometry
+ *
+ * 每帧：体素质心降采样 → 以匀速模型预测位姿 → 迭代点到面 ICP（高斯牛顿 + Huber 权重）→ 配准后的点增量并入地图。
+ * 地图为 mapVoxel 边长的体素哈希，每个体素以 SoA 保存至多 16 个点（空位填远点）；近邻查询只查询点所在卦限的
+ * 2×2×2 个体素，每个体素 16 点的平方距离由一次向量内核算出（AVX2 / SSE4.1 / NEON，运行时按 CpuFeatures 选择）。
+ * ICP 每次迭代按点分片并行，各分片累加自己的 6×6 法方程后合并，无锁。远离当前位置 mapRadius 的体素被回收。
+ * 位姿为首帧雷达系下的 T_map_lidar；anchorTo() 可把该系对齐到外部位姿（容器 SLAM 最近一次输出）。
+ * 非线程安全：由单一线程调用。
+ */
+class LidarOdometry {
+public:
+    explicit LidarOdometry(const LidarOdometryConfig& cfg = {});
+    ~LidarOdometry();
+    LidarOdometry(const LidarOdometry&) = delete;
+    LidarOdometry& operator=(const LidarOdometry&) = delete;
+
+    const LidarOdometryConfig& config() const noexcept { return cfg_; }
+
+    // 一帧雷达系点云（SoA）；退化（对应点不足）时返回 false
+    bool addScan(const float* x, const float* y, const float* z, std::size_t count, std::uint64_t timestampNs);
+    void reset();
+
+    // 当前位姿（anchorTo 之后为外部坐标系）
+    Pose3D pose() const noexcept;
+    // 使当前位姿与 external 重合：之后的输出 = external · (当前位姿)^-1 · 后续位姿
+    void anchorTo(const Pose3D& external) noexcept;
+    const LidarOdometryResult& lastResult() const noexcept { return result_; }
+    std::uint64_t scans() const noexcept { return scans_; }
+
+    std::size_t mapVoxels() const noexcept { return voxelIndex_.size(); }
+    std::size_t mapPoints() const noexcept { return mapPoints_; }
+    // 地图系中 (x, y, z) 的至多 k 个近邻（按距离升序写入 out，每点 xyz），返回找到的个数
+    std::size_t nearest(float x, float y, float z, int k, float* out, float* sqDist = nullptr) const;
+    std::size_t threads() const noexcept;
+
+    // 当前使用的向量内核（"avx2" / "sse4.1" / "neon" / "scalar"）
+    static const char* kernelName() noexcept;
+
+    static constexpr int kVoxelPoints = 16;
+
+private:
+    struct MapVoxel {
+        alignas(32) float x[kVoxelPoints];
+        alignas(32) float y[kVoxelPoints];
+        alignas(32) float z[kVoxelPoints];
+        std::int32_t coord[3];
+        std::uint32_t count;
+    };
+    // 刚体变换：行主序旋转 + 平移
+    struct Transform {
+        std::array<double, 9> R{1., 0., 0., 0., 1., 0., 0., 0., 1.};
+        std::array<double, 3> t{0., 0., 0.};
+    };
+
+    void downsample(const float* x, const float* y, const float* z, std::size_t count);
+    void insertScan(const Transform& T);
+    void trimMap();
+    std::size_t knn(const float q[3], int k, float* dist, float* xyz) const;
+
+    static Transform compose(const Transform& a, const Transform& b) noexcept;
+    static Transform inverse(const Transform& a) noexcept;
+    static Pose3D toPose(const Transform& T, std::uint64_t timestampNs) noexcept;
+    static Transform fromPose(const Pose3D& p) noexcept;
+
+    LidarOdometryConfig cfg_;
+    std::unique_ptr<core::WorkerGroup> workers_;
+    std::unordered_map<std::uint64_t, std::uint32_t> voxelIndex_;
+    std::vector<MapVoxel> voxels_;
+    std::vector<std::uint32_t> freeVoxels_;
+    std::size_t mapPoints_{0};
+
+    std::unordered_map<std::uint64_t, std::uint32_t> scanIndex_;  // 降采样体素 → scan_ 下标（逐帧复用）
+    std::vector<std::array<float, 4>> scanSum_;                   // xyz 累加与点数
+    std::vector<std::array<float, 3>> scan_;
+
+    Transform pose_, prevPose_, anchor_;
+    std::array<double, 3> trimCenter_{0., 0., 0.};
+    std::uint64_t timestampNs_{0};
+    std::uint64_t scans_{0};
+    LidarOdometryResult result_;
+};
+
+} // namespace falconmind::sdk::perception
@@ -1,14 +1,35 @@
 // FalconMindSDK - LidarSlamNode 骨架
-// 输入点云，输出位姿；可注入 ISlamServiceClient 对接算法容器（如 SLAMService.GetPose）。
+// 输入点云，输出位姿；可注入 ISlamServiceClient 对接算法容器（推荐 StreamingSlamClient 订阅 SLAMService.SubscribePose，
+// 同机部署时可用 pose_shm 参数经共享内存位姿通道读取）。
+// local_odometry 参数启用机载 LidarOdometry：fallback 时容器不可用即由本进程内的扫描-地图 ICP 接续输出位姿，
+// always 时只用机载里程计。
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "falconmind/sdk/core/Buffer.h"
 #include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/perception/LidarOdometry.h"
 #include "falconmind/sdk/perception/PoseTypes.h"
 #include "falconmind/sdk/perception/ISlamServiceClient.h"
 
 namespace falconmind::sdk::perception {
 
+// 机载里程计参与方式
+enum class LocalOdometryMode : std::uint8_t {
+    Off = 0,   // 只用容器（默认）
+    Fallback,  // 每帧都跟踪以保持地图；容器可用时输出容器位姿并把里程计对齐到它，不可用时输出里程计位姿
+    Always     // 只用机载里程计
+};
+
+/**
+ * 参数：output_when_no_client、pose_shm、local_odometry（off / fallback / always），
+ * 以及 odom_scan_voxel、odom_map_voxel、odom_max_iterations、odom_map_radius、odom_threads（见 LidarOdometryConfig）。
+ * pointcloud_in 接收 PointCloudPacket 或 PointXYZI 数组（雷达系，建议接 PointCloudFilterNode 降采样后的输出），
+ * 回调只保留最新一帧的引用。
+ */
 class LidarSlamNode : public core::Node {
 public:
     LidarSlamNode();
@@ -19,11 +40,25 @@ public:
     void setSlamServiceClient(SlamServiceClientPtr client) { slamClient_ = std::move(client); }
     void setOutputWhenNoClient(bool v) { outputWhenNoClient_ = v; }
 
+    LocalOdometryMode localOdometryMode() const noexcept { return odomMode_; }
+    // 机载里程计（local_odometry 为 off 时为空）；须在 process() 所在线程访问
+    const LidarOdometry* odometry() const noexcept { return odometry_.get(); }
+
 private:
+    bool trackScan();
+
+    core::Pad* inPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
+    core::Pad* outPad_{nullptr};
     bool started_{false};
     bool outputWhenNoClient_{true};
     std::uint64_t defaultPoseTimestampNs_{0};
     SlamServiceClientPtr slamClient_;
+    LocalOdometryMode odomMode_{LocalOdometryMode::Off};
+    LidarOdometryConfig odomConfig_;
+    std::unique_ptr<LidarOdometry> odometry_;
+    std::mutex scanMutex_;
+    core::BufferRef lastScan_;
+    std::vector<float> transposed_;  // PointXYZI 输入转置为 SoA（逐帧复用）
 };
 
 } // namespace falconmind::sdk::perception
@@ -0,0 +1,43 @@
+// FalconMindSDK - 线性分配（Jonker-Volgenant 最短增广路）与空间门控候选生成
+// 供跟踪后端做检测 ↔ 轨迹最优匹配：先用均匀网格只挑出空间相邻的配对，再按连通分量分块求解。
+#pragma once
+
+#include "falconmind/sdk/perception/DetectionTypes.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+// 稀疏代价矩阵中的一个候选配对（row 行 ↔ col 列，代价越小越好）
+struct AssignmentCandidate {
+    int row{0};
+    int col{0};
+    float cost{0.f};
+};
+
+/**
+ * 稠密方阵最小代价完美匹配（JV 最短增广路 + 对偶势，O(n^3)）
+ * cost 为 n×n 行主序；rowToCol 输出每行分配到的列。
+ */
+void solveDenseAssignment(const std::vector<double>& cost, int n, std::vector<int>& rowToCol);
+
+/**
+ * 稀疏矩形分配：只有 candidates 中的配对可被选中，任一行 / 列都可以不分配，
+ * 每个未分配的行或列代价为 unassignedCost（应大于 候选最大代价 / 2，保证能匹配时优先匹配）。
+ * 候选图先按连通分量拆分，每个分量单独求解，拥挤场景下规模由局部密度而非总目标数决定。
+ * rowToCol 输出 rows 个元素，未分配为 -1。
+ */
+void solveSparseAssignment(int rows, int cols, const std::vector<AssignmentCandidate>& candidates,
+                           float unassignedCost, std::vector<int>& rowToCol);
+
+/**
+ * 均匀网格空间门控：返回 IoU > minIou 的 (rowBox, colBox) 配对，cost = 1 - IoU。
+ * colBoxes 按包围盒插入网格（格子边长取框平均尺寸），rowBoxes 只与覆盖相同格子的框计算 IoU；
+ * colEnabled 非空时仅考虑为 true 的列。
+ */
+void gateByIou(const std::vector<DetectionBBox>& rowBoxes, const std::vector<DetectionBBox>& colBoxes,
+               float minIou, std::vector<AssignmentCandidate>& out,
+               const std::vector<bool>* colEnabled = nullptr);
+
+} // namespace falconmind::sdk::perception
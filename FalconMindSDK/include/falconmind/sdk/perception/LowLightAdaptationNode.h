@@ -1,16 +1,29 @@
 // FalconMindSDK - 低照度增强节点
-// 输入图像，输出经 gamma/亮度增强后的图像；支持 RGB8/BGR8，可扩展红外融合或相机切换。
+// 输入图像，输出经 gamma / 自动增益 / CLAHE 增强后的图像；支持 RGB8/BGR8，可扩展红外融合或相机切换。
+// 查表增强与亮度统计在同一遍完成（见 LowLightEnhance）；亮度足够时原样零拷贝转发。
+// 每帧的亮度统计经 brightness_out 输出 FrameBrightnessPacket（供环境检测复用，无需再遍历像素）。
+// Gamma / AutoGain 模式可作为像素融合链的逐行查表阶段：融合时是否增强按上一帧在同一遍中统计的亮度决定。
 #pragma once
 
 #include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/Caps.h"
+#include "falconmind/sdk/perception/LowLightEnhance.h"
+#include "falconmind/sdk/sensors/PixelFusion.h"
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
-#include <vector>
 
 namespace falconmind::sdk::perception {
 
-class LowLightAdaptationNode : public core::Node {
+enum class LowLightMode {
+    Gamma,     // 固定 gamma 查找表
+    AutoGain,  // 按亮度均值自动增益（平滑后逐帧更新查找表）
+    Clahe      // 限制对比度的自适应直方图均衡
+};
+
+class LowLightAdaptationNode : public core::Node, public sensors::FusablePixelStage {
 public:
     LowLightAdaptationNode();
 
@@ -22,13 +35,60 @@ public:
     void setBrightnessThreshold(uint8_t t) { brightnessThreshold_ = t; }
     /// 增强 gamma（>1 提亮），典型 1.2~1.8
     void setGamma(float g) { gamma_ = (g > 0.1f && g < 4.f) ? g : 1.5f; }
+    void setMode(LowLightMode mode) { mode_ = mode; }
+    /// AutoGain：目标平均亮度与最大增益
+    void setTargetBrightness(float t) { targetBrightness_ = t > 1.f ? t : 1.f; }
+    void setMaxGain(float g) { maxGain_ = g >= 1.f ? g : 1.f; }
+    ClaheEnhancer& clahe() { return clahe_; }
+
+    /// 最近一次用于增强判断的平均亮度
+    float lastMeanBrightness() const noexcept { return lastMean_; }
+    float currentGain() const noexcept { return gain_; }
+
+    core::Pad* fusionInputPad() const noexcept override { return inPad_; }
+    core::Pad* fusionOutputPad() const noexcept override { return outPad_; }
+    bool canFuse() const noexcept override { return mode_ != LowLightMode::Clahe; }
+    bool planFusedFrame(const sensors::FusedImageInfo& in, sensors::FusedStagePlan& out) override;
+    void fusedRow(std::uint8_t* row, int width, int y) override;
+    void finishFusedFrame(const core::BufferRef& output) override;
 
 private:
+    void enhance(core::BufferRef& frame, int stride, bool bgr);
+    // Gamma / AutoGain：按平均亮度更新增益并在参数变化时重建查找表
+    void updateLut(float mean, std::uint8_t lut[256], LowLightMode& lutMode, float& lutParam);
+
+    core::Pad* inPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
+    core::Pad* outPad_{nullptr};
+    core::Pad* brightnessPad_{nullptr};
     bool started_{false};
-    std::vector<std::uint8_t> lastFrameBuffer_;
-    bool lastFrameValid_{false};
+    std::mutex frameMutex_;
+    core::BufferRef lastFrame_;  // 最近一帧（共享引用）；仅需增强时写时复制
+    core::PixelFormat inputFormat_{core::PixelFormat::Any};  // link 协商的输入格式
     uint8_t brightnessThreshold_{80};
     float gamma_{1.5f};
+    LowLightMode mode_{LowLightMode::Gamma};
+    float targetBrightness_{110.f};
+    float maxGain_{4.f};
+
+    // 以下仅在 process 线程访问
+    std::uint8_t lut_[256]{};
+    float lutGamma_{0.f};  // lut_ 对应的 gamma（Gamma 模式）或增益（AutoGain 模式）
+    LowLightMode lutMode_{LowLightMode::Clahe};
+    float gain_{1.f};
+    // 上一帧增强时在同一遍内累积的统计；未增强的帧清空，下一帧自行采样
+    BrightnessStats stats_;
+    ClaheEnhancer clahe_;
+    float lastMean_{0.f};
+
+    // 融合路径（由链首节点的 process 线程调用）；与逐节点路径分开保存，回退帧与融合帧互不干扰
+    std::uint8_t fusedLut_[256]{};
+    LowLightMode fusedLutMode_{LowLightMode::Clahe};
+    float fusedLutParam_{0.f};
+    BrightnessStats fusedStats_;
+    bool fusedMeasured_{false};  // fusedMean_ 有效（已融合处理过至少一帧）
+    float fusedMean_{0.f};
+    bool fusedEnhance_{false};
+    bool fusedBgr_{false};
 };
 
 } // namespace falconmind::sdk::perception
@@ -0,0 +1,83 @@
+// FalconMindSDK - 低照度增强内核：256 项查找表（gamma / 自动增益）、CLAHE，增强同一遍内累积亮度统计
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+// 帧亮度统计：LowLightAdaptationNode 经 brightness_out 推送（二进制布局），供 EnvironmentDetectionNode 等复用
+struct FrameBrightnessPacket {
+    float meanLuma{0.f};          // 0~255
+    std::uint32_t enhanced{0};    // 本帧是否做了增强
+    std::int64_t timestampNs{0};  // 帧采集时间戳（BufferMeta::timestampNs）
+    std::uint64_t frameIndex{0};
+};
+
+/**
+ * BrightnessStats - 三通道逐字节直方图（按内存中的通道顺序）
+ *
+ * 由 sampleBrightness（只读采样）或 applyLutRgb / ClaheEnhancer::apply（增强时在同一遍内对采样行累积）填充。
+ */
+struct BrightnessStats {
+    std::array<std::array<std::uint32_t, 256>, 3> hist{};
+    std::uint64_t samples{0};  // 统计的像素数
+
+    void reset() noexcept;
+    bool valid() const noexcept { return samples > 0; }
+    // 平均亮度（BT.601 权重，0~255）；bgr 为 true 时通道顺序为 B,G,R
+    float meanLuma(bool bgr) const noexcept;
+    // 通道合并后第 p（0~1）分位的像素值
+    std::uint8_t percentile(float p) const noexcept;
+};
+
+// out = 255 * (in/255)^(1/gamma)
+void buildGammaLut(float gamma, std::uint8_t lut[256]) noexcept;
+// out = min(255, in * gain)
+void buildGainLut(float gain, std::uint8_t lut[256]) noexcept;
+
+/**
+ * 对三通道 8 位图原地查表。stats 非空时，每 statsRowStep 行的像素在查表的同一遍中累积到 stats（增强前的值），
+ * 其余行走 SIMD 查表路径（aarch64 为 NEON TBL，其他平台为展开的标量循环）。1080p 查表约为一次内存读写的带宽开销。
+ */
+void applyLutRgb(std::uint8_t* data, int width, int height, int stride, const std::uint8_t lut[256],
+                 BrightnessStats* stats = nullptr, int statsRowStep = 4) noexcept;
+// 只读采样：每 step 行、每 step 列取一个像素
+void sampleBrightness(const std::uint8_t* data, int width, int height, int stride, int step,
+                      BrightnessStats& stats) noexcept;
+const char* lutKernelName() noexcept;
+
+/**
+ * ClaheEnhancer - 限制对比度的自适应直方图均衡（亮度通道，tilesX × tilesY 分块）
+ *
+ * 各块的映射由上一帧在同一遍中累积的分块亮度直方图构造（首帧或尺寸变化时先做一次采样统计），
+ * 像素亮度按相邻四块映射双线性插值，三通道按亮度增益等比缩放以保持色调。
+ */
+class ClaheEnhancer {
+public:
+    void setClipLimit(float clip) { clipLimit_ = clip > 1.f ? clip : 1.f; }
+    void setTiles(int tilesX, int tilesY);
+    void reset() { hasStats_ = false; }
+
+    void apply(std::uint8_t* data, int width, int height, int stride, bool bgr, BrightnessStats* stats = nullptr,
+               int statsRowStep = 4);
+
+private:
+    void resize(int width, int height);
+    void sampleTiles(const std::uint8_t* data, int stride, bool bgr);
+    void buildLuts();
+
+    float clipLimit_{2.f};
+    int tilesX_{8}, tilesY_{8};
+    int width_{0}, height_{0};
+    bool hasStats_{false};
+    std::vector<std::uint32_t> tileHist_;  // tilesX*tilesY*256，当前帧累积
+    std::vector<std::uint8_t> tileLut_;    // tilesX*tilesY*256
+    std::vector<int> colTile_;             // 每列左侧块索引（插值用）
+    std::vector<std::uint16_t> colWeight_; // 每列右侧块权重（Q8）
+    std::vector<int> colBin_;              // 每列所属块（统计用）
+};
+
+} // namespace falconmind::sdk::perception
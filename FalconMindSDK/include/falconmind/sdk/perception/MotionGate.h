@@ -0,0 +1,105 @@
+// FalconMindSDK - MotionGate：降采样帧差找出画面变化区域，按相机姿态变化补偿自身运动（悬停 / 慢速扫描时跳过静止帧与静止区域）
+#pragma once
+
+#include "falconmind/sdk/perception/DetectionTypes.h"
+#include "falconmind/sdk/perception/GeoProjection.h"
+#include "falconmind/sdk/sensors/ImuHistory.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+struct MotionGateConfig {
+    int step{8};                    // 降采样步长（像素），每 step×step 取一个亮度样本
+    int blockSamples{4};            // 变化块边长（样本数）；ROI 以块为单位聚合
+    int sampleThreshold{20};        // 样本亮度差超过时计为变化（0~255）
+    float blockFraction{0.15f};     // 块内变化样本占比超过时该块视为变化
+    int roiPadding{32};             // ROI 向外扩展（像素），覆盖运动目标边缘
+    float fullFrameFraction{0.4f};  // 变化块占比超过时整帧检测（大范围变化不值得拆 ROI）
+    int maxStaticFrames{30};        // 连续静止帧达到时强制整帧检测一次；0 为不强制
+    double hfovDeg{0.};             // 相机水平视场角（度）；> 0 时按相机旋转补偿画面平移 / 旋转
+};
+
+// 参考帧到当前帧的相机旋转（相机系 x 右 / y 下 / z 光轴，弧度）
+struct CameraRotationDelta {
+    double tilt{0.};  // 绕 x：画面垂直平移
+    double pan{0.};   // 绕 y：画面水平平移
+    double roll{0.};  // 绕光轴：画面旋转
+};
+
+// IMU 预积分的机体（FRD）旋转 dq 按云台姿态换算到相机系
+CameraRotationDelta cameraRotationFromImu(const sensors::ImuPreintegration& preint, const GimbalPose& gimbal);
+
+enum class MotionDecision : std::uint8_t {
+    Full,     // 整帧检测（首帧、大范围变化、无法判断或达到 maxStaticFrames）
+    Regions,  // 只有 regions 内发生变化
+    Skip      // 与参考帧相比没有变化，不必推理
+};
+
+struct MotionGateResult {
+    MotionDecision decision{MotionDecision::Full};
+    std::vector<DetectionBBox> regions;  // Regions 时的变化区域（整帧像素坐标，已外扩）
+    float changedFraction{1.f};          // 变化块占比
+    float shiftX{0.f};                   // 本帧使用的自身运动补偿平移（像素）
+    float shiftY{0.f};
+};
+
+/**
+ * MotionGate - 检测前的画面变化门控
+ *
+ * 每帧按 step 降采样亮度（RGB8/BGR8/NV12/YUYV，其他格式恒为 Full），与参考帧（上一次非 Skip 的帧）逐样本求差：
+ * - 相机旋转（evaluate 参数，或 setImuHistory 后按两帧时间戳积分 IMU）换算为画面平移 / 旋转，参考帧按此对齐后再求差；
+ *   无旋转或旋转只造成整样本平移时逐行 SIMD（SSE2 / NEON）求差，否则逐样本最近邻对齐
+ * - 对齐后落在参考帧之外的样本（新进入视野的区域）计为变化
+ * - 变化样本按 blockSamples 聚合为块，相连的变化块合并为 ROI
+ * 非 Skip 的帧成为新的参考帧；Skip 时参考帧不变，缓慢的累积变化最终仍会触发检测。
+ * 非线程安全：同一实例的 evaluate() 须串行调用（DetectionNode 在前处理级调用）。
+ */
+class MotionGate {
+public:
+    explicit MotionGate(MotionGateConfig config = {});
+
+    // 相机旋转来源：evaluate() 未给出 rotation 时按参考帧与本帧的 captureTimestampNs 积分；mount 为云台姿态
+    void setImuHistory(sensors::ImuHistoryPtr history, const GimbalPose& mount);
+
+    // rotation 为参考帧到本帧的相机旋转；nullptr 时使用 IMU（未设置则不补偿）
+    const MotionGateResult& evaluate(const ImageView& image, const CameraRotationDelta* rotation = nullptr);
+    // 清空参考帧：下一帧为 Full
+    void reset();
+
+    const MotionGateConfig& config() const noexcept { return config_; }
+    const MotionGateResult& lastResult() const noexcept { return result_; }
+    std::uint64_t skippedFrames() const noexcept { return skipped_; }
+    std::uint64_t regionFrames() const noexcept { return regionFrames_; }
+    std::uint64_t fullFrames() const noexcept { return fullFrames_; }
+
+private:
+    bool sampleLuma(const ImageView& image);
+    // 对齐参考帧并写出逐样本变化标记 changed_
+    void diffSamples(const CameraRotationDelta& rotation, int width);
+    void buildRegions(int width, int height);
+    const MotionGateResult& finish(MotionDecision decision, std::int64_t timestampNs);
+
+    MotionGateConfig config_;
+    sensors::ImuHistoryPtr imu_;
+    GimbalPose mount_;
+
+    int gridW_{0};
+    int gridH_{0};
+    int refW_{0};   // 参考帧图像尺寸
+    int refH_{0};
+    std::int64_t refTimestampNs_{0};
+    std::vector<std::uint8_t> luma_;
+    std::vector<std::uint8_t> refLuma_;
+    std::vector<std::uint8_t> changed_;  // 0 / 0xFF
+    std::vector<std::uint8_t> blocks_;   // 变化块标记，聚合 ROI 时复用为访问标记
+    std::vector<int> stack_;
+    int staticFrames_{0};
+    MotionGateResult result_;
+    std::uint64_t skipped_{0};
+    std::uint64_t regionFrames_{0};
+    std::uint64_t fullFrames_{0};
+};
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,130 @@
+// FalconMindSDK - 多路相机跟踪宿主：每路独立 ITrackerBackend，按路分派到工作线程池，并做跨相机轨迹融合
+#pragma once
+
+#include "falconmind/sdk/core/FixedMatrix.h"
+#include "falconmind/sdk/perception/ITrackerBackend.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+struct TrackerStreamConfig {
+    std::string id;                 // 流标识（相机 ID）
+    TrackerBackendPtr backend;      // 该路独占的跟踪后端（由宿主 load）
+    // 图像 → 公共地面坐标的单应矩阵（像素齐次坐标，取框底边中点）；未设置时该路不参与融合
+    bool hasGroundHomography{false};
+    core::Matrix<double, 3, 3> imageToGround = core::Matrix<double, 3, 3>::identity();
+    // TimeSyncService 中的传感器 ID：设置后融合前把该路时间戳映射到统一时间轴（空为已在 PipelineClock 时基）
+    std::string clockId;
+};
+
+struct TrackerStreamStats {
+    std::uint64_t processed{0};
+    std::uint64_t dropped{0};       // 队列满时丢弃的最旧帧
+    std::uint64_t busyNs{0};        // 跟踪 + 融合累计耗时
+};
+
+// 跨相机融合后的全局目标
+struct FusedTrack {
+    int globalId{0};
+    double x{0.}, y{0.};            // 公共地面坐标（最近一次观测）
+    std::int64_t timestampNs{0};    // 统一时间轴
+    std::vector<std::pair<std::size_t, int>> members;  // (流下标, 本地 trackId)
+};
+
+/**
+ * MultiStreamTrackerHost
+ *
+ * 每路的帧进入各自的有界队列；有待处理帧的流进入共享就绪队列，空闲工作线程取出后只处理该流一帧，
+ * 若还有积压则排回队尾。同一流任一时刻只在一个线程上运行（后端无需线程安全），
+ * 拥挤场景拖慢的只是该流自身，其余流由其他线程继续处理。
+ *
+ * 融合：参与融合的流把每条轨迹最新框的底边中点经单应矩阵投影到公共地面坐标，
+ * 时间戳经 TimeSyncService 对齐；新出现（或仍只被单路观测）的轨迹与其他流在 fusionWindowNs 内、
+ * 距离 fusionRadius 内最近的全局目标合并，否则分配新的 globalId。
+ */
+class MultiStreamTrackerHost {
+public:
+    // 回调在工作线程中调用；TrackingResult 中的 history 视图仅在回调内有效
+    using ResultCallback = std::function<void(std::size_t stream, const DetectionResult&, const TrackingResult&)>;
+
+    // workers 为 0 时使用 WorkerGroup::defaultCount()
+    explicit MultiStreamTrackerHost(std::size_t workers = 0);
+    ~MultiStreamTrackerHost();
+    MultiStreamTrackerHost(const MultiStreamTrackerHost&) = delete;
+    MultiStreamTrackerHost& operator=(const MultiStreamTrackerHost&) = delete;
+
+    // start() 之前添加；返回流下标，失败返回 -1
+    int addStream(TrackerStreamConfig config);
+    bool start();
+    void stop();
+    bool running() const noexcept { return running_; }
+
+    // 投递一帧检测结果（trackerPredicted 时调用后端 predict）；队列满时丢弃该流最旧的帧
+    bool submit(std::size_t stream, DetectionResult result);
+    // 等待所有已投递帧处理完毕
+    void waitIdle();
+
+    void setResultCallback(ResultCallback callback) { callback_ = std::move(callback); }
+    void setMaxQueuedFrames(std::size_t n) { maxQueued_ = n > 0 ? n : 1; }
+    void setFusionRadius(double r) { fusionRadius_ = r; }
+    void setFusionWindowNs(std::int64_t ns) { fusionWindowNs_ = ns; }
+
+    std::size_t streamCount() const noexcept { return streams_.size(); }
+    std::size_t workerCount() const noexcept { return workerCount_; }
+    TrackerStreamStats stats(std::size_t stream) const;
+    // 当前全局目标（按 globalId 升序）
+    std::vector<FusedTrack> fusedTracks() const;
+    // 流上本地轨迹对应的 globalId，未融合返回 -1
+    int globalIdOf(std::size_t stream, int localTrackId) const;
+
+private:
+    struct Stream {
+        TrackerStreamConfig config;
+        std::mutex mutex;
+        std::deque<DetectionResult> pending;
+        bool scheduled{false};
+        std::atomic<std::uint64_t> processed{0};
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<std::uint64_t> busyNs{0};
+    };
+
+    void workerLoop();
+    void process(std::size_t index, Stream& s);
+    void fuse(std::size_t index, const Stream& s, const TrackingResult& tracks);
+
+    std::size_t workerCount_;
+    std::vector<std::unique_ptr<Stream>> streams_;
+    std::vector<std::thread> workers_;
+    std::atomic<bool> running_{false};
+    std::size_t maxQueued_{4};
+    ResultCallback callback_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::deque<std::size_t> ready_;
+    std::size_t active_{0};
+    bool stop_{false};
+
+    mutable std::mutex fusionMutex_;
+    double fusionRadius_{2.0};
+    std::int64_t fusionWindowNs_{200'000'000};
+    int nextGlobalId_{1};
+    std::unordered_map<int, FusedTrack> globals_;
+    std::unordered_map<std::uint64_t, int> localToGlobal_;  // (流下标 << 32 | 本地 trackId) → globalId
+};
+
+} // namespace falconmind::sdk::perception
@@ -1,12 +1,16 @@
 // FalconMindSDK - ONNXRuntime-based detector backend (skeleton)
 #pragma once
 
+#include "falconmind/sdk/perception/AsyncInferenceQueue.h"
 #include "falconmind/sdk/perception/IDetectorBackend.h"
 
+#include <memory>
+
 namespace falconmind::sdk::perception {
 
-// 当前只提供接口骨架与日志输出，不真正链接 ONNXRuntime。
-// 未来在嵌入式/PC 环境中，可按需引入 ONNXRuntime 头文件并补全实现。
+// 启用 FALCONMINDSDK_BUILD_ONNXRUNTIME_BACKEND 时链接 ONNXRuntime：输入输出缓冲在 load() 时按 batch 上限分配，
+// 以 Ort::IoBinding 绑定，推理路径不再逐帧分配张量；执行提供者与线程数取自 DetectorDescriptor。
+// 未启用时为只输出日志的骨架
 class OnnxRuntimeDetectorBackend : public IDetectorBackend {
 public:
     OnnxRuntimeDetectorBackend() = default;
@@ -23,12 +27,29 @@ public:
 
     bool run(const ImageView& image, DetectionResult& outResult) override;
 
+    // 多帧合成一个 (N,3,H,W) 输入执行一次；batch 维动态时 N ≤ max_batch，固定时以模型为准
+    bool runBatch(const ImageView* images, DetectionResult* results, std::size_t count) override;
+    std::size_t maxBatchSize() const override;
+
+    // 异步推理：load() 后由 AsyncInferenceQueue 执行（IoBinding 缓冲只有一份，单个推理线程），在途上限为推理线程数的两倍
+    bool submit(const ImageView& image, DetectionResult& outResult, DetectionCallback done) override;
+    std::size_t maxInFlight() const override;
+
+    // 前处理直接消费 NV12/YUYV，相机无需先转 RGB
+    std::vector<core::PixelFormat> supportedPixelFormats() const override;
+
+    // 解码只读取 classFilter 列出的类别行（normalizeClassIds 之后保存）
+    bool setClassFilter(const std::vector<int>& classIds) override;
+    const std::vector<int>& classFilter() const noexcept { return classFilter_; }
+
 private:
     DetectorDescriptor desc_;
     bool loaded_{false};
+    std::vector<int> classFilter_;
 #if defined(FALCONMINDSDK_ONNXRUNTIME_BACKEND_ENABLED) && FALCONMINDSDK_ONNXRUNTIME_BACKEND_ENABLED
     void* onnxState_{nullptr};  // 实为 OnnxRuntimeState*，仅 .cpp 内使用
 #endif
+    std::unique_ptr<AsyncInferenceQueue> async_;  // 最后声明：先于其余成员销毁
 };
 
 } // namespace falconmind::sdk::perception
@@ -1,12 +1,20 @@
 // FalconMindSDK - PerceptionPluginManager
 #pragma once
 
+#include "falconmind/sdk/perception/DetectorAutotuner.h"
 #include "falconmind/sdk/perception/IDetectorBackend.h"
 
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace falconmind::sdk::perception {
 
@@ -15,6 +23,11 @@ class PerceptionPluginManager {
 public:
     using DetectorFactory = std::function<DetectorBackendPtr()>;
 
+    PerceptionPluginManager() = default;
+    ~PerceptionPluginManager();  // 等待后台预加载结束
+    PerceptionPluginManager(const PerceptionPluginManager&) = delete;
+    PerceptionPluginManager& operator=(const PerceptionPluginManager&) = delete;
+
     // 注册一个检测 backend 工厂，通常在模块初始化时调用。
     void registerDetectorBackend(const std::string& backendKey,
                                  DetectionBackendType type,
@@ -23,22 +36,70 @@ public:
     // 注册具体模型（YOLOv8/YOLO11 等）的描述，可从配置文件加载。
     void registerDetectorDescriptor(const DetectorDescriptor& desc);
 
-    // 根据 detectorId 创建并加载对应模型的 backend 实例。
+    // 根据 detectorId 创建并加载对应模型的 backend 实例（每次都是新实例，不预热、不缓存）。
     DetectorBackendPtr createDetector(const std::string& detectorId) const;
 
     // 查询当前已知的检测器列表（供 Builder/Viewer 能力展示使用）
     std::vector<DetectorDescriptor> listDetectors() const;
 
+    // ---- 常驻管理：按任务阶段切换检测器（日间模型 ↔ 红外/低照度模型）时免去加载与冷启动 ----
+    //
+    // 已加载并按 warmupRuns 预热的 backend 按 detectorId 常驻，总量超出内存预算时按 LRU 卸载未被使用的
+    // （仅管理器持有引用）；正在使用的 backend 不会被卸载，此时暂时超出预算。
+
+    // 取得常驻的 backend：已常驻时立即返回；正在预加载时等待其完成；否则在调用线程加载并预热。失败返回 nullptr
+    DetectorBackendPtr acquireDetector(const std::string& detectorId);
+    // 在后台线程加载并预热（如下一任务阶段的模型），不阻塞；已常驻或已在加载队列中时忽略
+    void preloadDetector(const std::string& detectorId);
+    // 常驻内存预算（字节），0 为不限；调低时立即按 LRU 卸载
+    void setResidentMemoryBudget(std::uint64_t bytes);
+    std::uint64_t residentMemoryBudget() const;
+    // 当前常驻（已加载完成）的检测器，最近使用的在前；及其内存估算总和
+    std::vector<std::string> residentDetectors() const;
+    std::uint64_t residentBytes() const;
+    // 卸载全部未被使用的常驻 backend
+    void releaseResidentDetectors();
+
+    // ---- 板上自动调优：启用后首次创建某个检测器时实测候选配置，此后（含重启）按 (板卡, 模型指纹) 复用最快者 ----
+    void setAutotuneOptions(AutotuneOptions options);
+    void disableAutotune();
+    // 未启用时返回 nullptr
+    std::shared_ptr<DetectorAutotuner> autotuner() const;
+
 private:
     struct BackendEntry {
         DetectionBackendType type{DetectionBackendType::Unknown};
         DetectorFactory      factory;
     };
 
+    struct ResidentEntry {
+        std::shared_future<DetectorBackendPtr> ready;
+        std::uint64_t bytes{0};
+        std::uint64_t lastUse{0};
+    };
+
+    // 查找描述与工厂并创建、加载（不持有 mutex_ 执行 load）；cascadeDepth 为级联确认链的深度，防止循环引用
+    DetectorBackendPtr instantiate(const std::string& detectorId, DetectorDescriptor* descOut,
+                                   int cascadeDepth = 0) const;
+    // 加载并预热，完成后兑现 promise；失败时移除常驻项
+    void loadResident(const std::string& detectorId, std::promise<DetectorBackendPtr>& promise);
+    // 调用方持有 residentMutex_；被卸载的 backend 移入 evicted，由调用方在锁外 unload()
+    void evictLocked(const std::string& keep, std::vector<DetectorBackendPtr>& evicted);
+    void loaderLoop();
+
     mutable std::mutex mutex_;
     std::unordered_map<std::string, BackendEntry> backendFactories_;
     std::unordered_map<std::string, DetectorDescriptor> detectorDescs_;
+    std::shared_ptr<DetectorAutotuner> autotuner_;
+
+    mutable std::mutex residentMutex_;
+    std::unordered_map<std::string, ResidentEntry> resident_;
+    std::uint64_t residentBudget_{0};
+    std::uint64_t useClock_{0};
+    std::deque<std::pair<std::string, std::shared_ptr<std::promise<DetectorBackendPtr>>>> preloadQueue_;
+    std::condition_variable preloadCv_;
+    bool stopping_{false};
+    std::thread loader_;  // 首次 preloadDetector 时启动
 };
 
 } // namespace falconmind::sdk::perception
-
@@ -0,0 +1,72 @@
+// FalconMindSDK - 位姿插值与按时刻查询（PoseHistoryBuffer 与共享内存位姿通道共用）
+#pragma once
+
+#include "falconmind/sdk/core/SeqLock.h"
+#include "falconmind/sdk/perception/PoseTypes.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace falconmind::sdk::perception {
+
+// 位置线性插值；四元数取最短弧后线性插值再归一化（相邻位姿间隔很小，与 slerp 差异可忽略）
+inline void interpolatePose(const Pose3D& a, const Pose3D& b, double w, Pose3D& out) noexcept {
+    out.x = a.x + (b.x - a.x) * w;
+    out.y = a.y + (b.y - a.y) * w;
+    out.z = a.z + (b.z - a.z) * w;
+    const double dot = a.qx * b.qx + a.qy * b.qy + a.qz * b.qz + a.qw * b.qw;
+    const double s = dot < 0. ? -1. : 1.;
+    double qx = a.qx + (s * b.qx - a.qx) * w;
+    double qy = a.qy + (s * b.qy - a.qy) * w;
+    double qz = a.qz + (s * b.qz - a.qz) * w;
+    double qw = a.qw + (s * b.qw - a.qw) * w;
+    const double n = std::sqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+    if (n > 0.) {
+        qx /= n;
+        qy /= n;
+        qz /= n;
+        qw /= n;
+    }
+    out.qx = qx;
+    out.qy = qy;
+    out.qz = qz;
+    out.qw = qw;
+}
+
+/**
+ * 在 ring 的最近历史中求时刻 timestampNs 的位姿：落在历史范围内时插值，
+ * 晚于最新位姿时返回最新位姿，早于最旧位姿时返回 false。poseOf 从槽位类型取出 Pose3D。
+ */
+template <typename T, typename PoseOf>
+bool poseAtInRing(const core::SeqLockRing<T>& ring, std::uint64_t timestampNs, Pose3D& pose, PoseOf poseOf) noexcept {
+    const std::uint64_t h = ring.count();
+    if (h == 0) return false;
+    const std::uint64_t usable = ring.capacity() - 1;
+    const std::size_t n = static_cast<std::size_t>(h < usable ? h : usable);
+    // 从最新往回找第一条不晚于 timestampNs 的位姿
+    Pose3D newer;
+    bool hasNewer = false;
+    for (std::size_t i = 0; i < n; ++i) {
+        T slot;
+        if (!ring.at(h, i, slot)) continue;
+        const Pose3D& p = poseOf(slot);
+        if (hasNewer && p.timestampNs >= newer.timestampNs) break;  // 已被覆盖为更新的数据
+        if (p.timestampNs <= timestampNs) {
+            if (!hasNewer || p.timestampNs == timestampNs) {
+                pose = p;
+                return true;
+            }
+            const double w = static_cast<double>(timestampNs - p.timestampNs) /
+                             static_cast<double>(newer.timestampNs - p.timestampNs);
+            interpolatePose(p, newer, w, pose);
+            pose.timestampNs = timestampNs;
+            return true;
+        }
+        newer = p;
+        hasNewer = true;
+    }
+    return false;
+}
+
+} // namespace falconmind::sdk::perception
@@ -12,4 +12,10 @@ struct Pose3D {
     std::uint64_t timestampNs{0};
 };
 
+// 带协方差的位姿：6x6 行主序，变量顺序 x y z roll pitch yaw（与 ROS PoseWithCovariance 一致）
+struct PoseWithCovariance {
+    Pose3D pose;
+    double covariance[36]{};
+};
+
 } // namespace falconmind::sdk::perception
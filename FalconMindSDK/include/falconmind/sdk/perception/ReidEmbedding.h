@@ -0,0 +1,79 @@
+// FalconMindSDK - ReID 外观特征提取：按检测框裁剪目标并批量计算 L2 归一化嵌入向量
+#pragma once
+
+#include "falconmind/sdk/perception/DetectionTypes.h"
+#include "falconmind/sdk/perception/IDetectorBackend.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+// 从整帧裁剪出 box 对应区域：零拷贝视图，只调整 data 指针与宽高，stride 沿用原帧。
+// 仅支持打包格式 RGB8 / BGR8；框先裁到图像范围内，面积为 0 或格式不支持时返回 false
+bool cropImageView(const ImageView& frame, const DetectionBBox& box, ImageView& out);
+
+// 原地 L2 归一化；零向量保持不变并返回 false
+bool normalizeEmbedding(float* v, std::size_t dim);
+
+/**
+ * IEmbeddingExtractor - 目标外观特征提取接口
+ *
+ * extract 为 frame 上的 count 个框批量计算特征：out 依次写入 count × dim() 个值，每行已 L2 归一化，
+ * 因此两行的点积即余弦相似度。valid[i] 为 false 表示该框无法裁剪 / 推理失败（对应行全 0）。
+ */
+class IEmbeddingExtractor {
+public:
+    virtual ~IEmbeddingExtractor() = default;
+    virtual std::size_t dim() const = 0;
+    virtual bool extract(const ImageView& frame, const DetectionBBox* boxes, std::size_t count,
+                         std::vector<float>& out, std::vector<bool>& valid) = 0;
+};
+
+using EmbeddingExtractorPtr = std::shared_ptr<IEmbeddingExtractor>;
+
+/**
+ * BackendEmbeddingExtractor - 复用检测后端上的嵌入模型（IDetectorBackend::runEmbeddings）
+ *
+ * 裁剪图为原帧上的零拷贝视图，按后端 maxBatchSize() 分批推理，缩放由后端前处理完成。
+ * 后端 embeddingDim() 为 0（未加载嵌入模型）时 extract 返回 false。
+ */
+class BackendEmbeddingExtractor : public IEmbeddingExtractor {
+public:
+    explicit BackendEmbeddingExtractor(DetectorBackendPtr backend);
+
+    std::size_t dim() const override;
+    bool extract(const ImageView& frame, const DetectionBBox* boxes, std::size_t count,
+                 std::vector<float>& out, std::vector<bool>& valid) override;
+
+private:
+    DetectorBackendPtr backend_;
+    std::vector<ImageView> crops_;
+    std::vector<std::size_t> cropIndex_;
+    std::vector<float> batchOut_;
+};
+
+/**
+ * ColorHistogramEmbeddingExtractor - 纯 CPU 回退特征
+ *
+ * 目标框上 / 下两半各统计 4×4×4 RGB 联合直方图（共 128 维），开方后 L2 归一化。
+ * 每个框最多采样 maxSamplesPerAxis × maxSamplesPerAxis 个像素，耗时与目标尺寸无关。
+ * 区分度远低于学习得到的嵌入，适用于没有嵌入模型的平台与测试。
+ */
+class ColorHistogramEmbeddingExtractor : public IEmbeddingExtractor {
+public:
+    static constexpr std::size_t kBinsPerChannel = 4;
+    static constexpr std::size_t kDim = 2 * kBinsPerChannel * kBinsPerChannel * kBinsPerChannel;
+
+    std::size_t dim() const override { return kDim; }
+    bool extract(const ImageView& frame, const DetectionBBox* boxes, std::size_t count,
+                 std::vector<float>& out, std::vector<bool>& valid) override;
+
+    void setMaxSamplesPerAxis(int n) { maxSamplesPerAxis_ = n > 0 ? n : 1; }
+
+private:
+    int maxSamplesPerAxis_{32};
+};
+
+} // namespace falconmind::sdk::perception
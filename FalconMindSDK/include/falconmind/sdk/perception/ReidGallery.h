@@ -0,0 +1,62 @@
+// FalconMindSDK - ReID 特征库：定容量、定维度的扁平向量索引，SIMD 余弦相似度检索
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+struct ReidMatch {
+    int id{-1};               // -1 为无满足条件的条目
+    float similarity{-1.f};   // 余弦相似度
+};
+
+/**
+ * ReidGallery
+ *
+ * 每个目标 ID 一行特征（L2 归一化，行宽按 8 个 float 对齐并补零），全部存储在构造时一次分配的连续内存中，
+ * 运行期不再分配；满时新 ID 覆盖 lastSeen 最早的条目。
+ * 查询对候选行做精确线性扫描（NEON / AVX2 点积），容量为数百行时单次查询仅需微秒级，无需近似图索引。
+ */
+class ReidGallery {
+public:
+    ReidGallery(std::size_t capacity, std::size_t dim);
+
+    std::size_t capacity() const noexcept { return ids_.size(); }
+    std::size_t dim() const noexcept { return dim_; }
+    std::size_t size() const noexcept { return slotOf_.size(); }
+    bool contains(int id) const { return slotOf_.count(id) > 0; }
+
+    // 写入 id 的特征（须已 L2 归一化）；已存在时按 momentum 做指数滑动平均后重新归一化
+    void update(int id, const float* embedding, std::int64_t timestampNs, float momentum = 0.9f);
+    // 仅刷新 lastSeen（目标本帧可见但未重新提取特征）
+    void touch(int id, std::int64_t timestampNs);
+    bool remove(int id);
+    void clear();
+
+    // lastSeen 不存在返回 0
+    std::int64_t lastSeenNs(int id) const;
+    const float* embedding(int id) const;
+
+    // 在 seenAfterNs <= lastSeen < seenBeforeNs 的条目中查找与 embedding 余弦相似度最高者，
+    // 低于 minSimilarity 时返回 id = -1
+    ReidMatch best(const float* embedding, float minSimilarity, std::int64_t seenAfterNs,
+                   std::int64_t seenBeforeNs) const;
+
+    // 当前使用的点积内核（"neon" / "avx512" / "avx2" / "scalar"）
+    static const char* kernelName() noexcept;
+    static float dot(const float* a, const float* b, std::size_t n) noexcept;
+
+private:
+    std::size_t dim_;
+    std::size_t rowStride_;
+    std::vector<float> rows_;
+    std::vector<int> ids_;                 // -1 为空槽
+    std::vector<std::int64_t> lastSeen_;
+    std::vector<std::uint32_t> freeSlots_;
+    std::unordered_map<int, std::uint32_t> slotOf_;
+};
+
+} // namespace falconmind::sdk::perception
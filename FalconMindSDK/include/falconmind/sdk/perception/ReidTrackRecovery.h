@@ -0,0 +1,79 @@
+// FalconMindSDK - 基于 ReID 外观特征的轨迹找回：遮挡后重新出现的目标沿用原 trackId
+#pragma once
+
+#include "falconmind/sdk/perception/DetectionTypes.h"
+#include "falconmind/sdk/perception/ReidEmbedding.h"
+#include "falconmind/sdk/perception/ReidGallery.h"
+#include "falconmind/sdk/perception/TrackingTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * ReidTrackRecovery - 跟踪后端之后的可选 ReID 阶段（与具体 ITrackerBackend 无关）
+ *
+ * 后端给出的本地 trackId 经别名表映射为对外的稳定 ID。每帧只为新出现的本地轨迹、
+ * 以及距上次提取已超过 refreshInterval 帧的轨迹裁剪目标并批量提取特征；
+ * 新轨迹在当前任务的特征库中查找本帧不可见、且 maxLostNs 内见过的目标，
+ * 余弦相似度 >= minSimilarity 时沿用其 ID（被找回的旧本地轨迹若仍在外推则不再输出），
+ * 否则以自身 ID 入库。无需整帧重检测即可跨遮挡保持 ID，下游（ClusterCenter 等）不会收到重复目标。
+ *
+ * 特征库按任务隔离：resetMission() 切换任务时清空特征库与别名表。
+ */
+class ReidTrackRecovery {
+public:
+    explicit ReidTrackRecovery(EmbeddingExtractorPtr extractor, std::size_t galleryCapacity = 256);
+
+    void setMinSimilarity(float s) { minSimilarity_ = s; }
+    void setMaxLostNs(std::int64_t ns) { maxLostNs_ = ns; }
+    // 已建立的轨迹每隔多少帧重新提取一次特征（>= 1）
+    void setRefreshInterval(int frames) { refreshInterval_ = frames > 0 ? frames : 1; }
+    // 特征库滑动平均系数
+    void setMomentum(float m) { momentum_ = m; }
+
+    void resetMission(const std::string& missionId);
+    const std::string& missionId() const noexcept { return missionId_; }
+
+    // frame 为检测所用的图像；detections 为跟踪后（trackId 已由后端写入）的检测结果，tracks 为同帧跟踪结果。
+    // 原地把 trackId 改写为稳定 ID。trackerPredicted 帧不提取特征，只做 ID 映射
+    bool process(const ImageView& frame, DetectionResult& detections, TrackingResult& tracks);
+
+    // 本地 trackId 当前映射到的稳定 ID，未知返回 -1
+    int stableIdOf(int localTrackId) const;
+    std::uint64_t recoveredCount() const noexcept { return recovered_; }
+    std::uint64_t extractedCount() const noexcept { return extracted_; }
+    const ReidGallery& gallery() const noexcept { return gallery_; }
+
+private:
+    struct Alias {
+        int stableId{-1};
+        std::uint64_t refreshedFrame{0};
+        std::uint64_t seenFrame{0};
+        bool retired{false};   // 已被新的本地轨迹接管，不再输出
+    };
+
+    EmbeddingExtractorPtr extractor_;
+    ReidGallery gallery_;
+    std::string missionId_;
+    float minSimilarity_{0.8f};
+    std::int64_t maxLostNs_{10'000'000'000};
+    int refreshInterval_{5};
+    float momentum_{0.9f};
+    std::uint64_t frame_{0};
+    std::uint64_t recovered_{0};
+    std::uint64_t extracted_{0};
+    std::unordered_map<int, Alias> aliases_;
+
+    // 每帧复用的缓冲
+    std::vector<DetectionBBox> boxes_;
+    std::vector<std::size_t> boxDet_;
+    std::vector<float> embeddings_;
+    std::vector<bool> valid_;
+};
+
+} // namespace falconmind::sdk::perception
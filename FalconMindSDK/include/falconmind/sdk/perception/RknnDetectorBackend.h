@@ -1,8 +1,11 @@
 // FalconMindSDK - RKNN-based detector backend (skeleton)
 #pragma once
 
+#include "falconmind/sdk/perception/AsyncInferenceQueue.h"
 #include "falconmind/sdk/perception/IDetectorBackend.h"
 
+#include <memory>
+
 namespace falconmind::sdk::perception {
 
 // 仅作为 RKNN 后端的接口骨架，实际集成时在此处引入 rknn_api.h 等头文件。
@@ -22,12 +25,40 @@ public:
 
     bool run(const ImageView& image, DetectionResult& outResult) override;
 
+    // 前处理直接消费 NV12/YUYV，相机无需先转 RGB
+    std::vector<core::PixelFormat> supportedPixelFormats() const override;
+
+    // rknn_set_core_mask；未加载时记录，load() 成功后应用。
+    // 多上下文（npu_contexts > 1）时各上下文依次绑定掩码中的一个核（掩码为 0 时依次为 core0/1/2）
+    bool setNpuCoreMask(std::uint32_t mask) override;
+    // 已加载的上下文数：npu_contexts > 1 时以 rknn_dup_context 复制（共享权重），run() 可并发调用
+    std::size_t maxConcurrentRuns() const override;
+
+    // 异步推理：load() 后由 AsyncInferenceQueue 执行（每个 NPU 上下文一个推理线程），在途上限为推理线程数的两倍
+    bool submit(const ImageView& image, DetectionResult& outResult, DetectionCallback done) override;
+    std::size_t maxInFlight() const override;
+    std::uint32_t npuCoreMask() const noexcept { return npuCoreMask_; }
+
+    // 分阶段执行：每个 slot 自带模型输入与输出的主机副本，前处理/后处理与 NPU 推理相互重叠；
+    // inferStage 取空闲上下文执行（多上下文时可并发）。未启用 RKNN 时不支持（返回 0）
+    std::size_t prepareStages(std::size_t slots) override;
+    bool preprocessStage(std::size_t slot, const ImageView& image) override;
+    bool inferStage(std::size_t slot) override;
+    bool postprocessStage(std::size_t slot, DetectionResult& outResult) override;
+
+    // 解码只读取 classFilter 列出的类别行（normalizeClassIds 之后保存）
+    bool setClassFilter(const std::vector<int>& classIds) override;
+    const std::vector<int>& classFilter() const noexcept { return classFilter_; }
+
 private:
     DetectorDescriptor desc_;
     bool loaded_{false};
+    std::uint32_t npuCoreMask_{0};
+    std::vector<int> classFilter_;
 #if defined(FALCONMINDSDK_RKNN_BACKEND_ENABLED) && FALCONMINDSDK_RKNN_BACKEND_ENABLED
     void* rknnState_{nullptr};  // 实为 RknnState*，仅 .cpp 内使用
 #endif
+    std::unique_ptr<AsyncInferenceQueue> async_;  // 最后声明：先于其余成员销毁
 };
 
 } // namespace falconmind::sdk::perception
@@ -0,0 +1,104 @@
+// FalconMindSDK - 共享内存位姿通道：算法容器写、SDK 无锁读取最新位姿与带协方差的位姿历史
+#pragma once
+
+#include "falconmind/sdk/perception/ISlamServiceClient.h"
+#include "falconmind/sdk/perception/PoseTypes.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * 共享内存布局（/dev/shm/<name>）：
+ *   header | latest: SeqLock<Pose3D> | head | ring: SeqLock<PoseWithCovariance>[ringCapacity]
+ * 所有字段为无锁原子对象、无指针，两端映射地址可不同；容器间需共享 /dev/shm（同 core::ShmChannel）。
+ * 算法容器可直接链接本类作为写端，或按 ShmPoseChannel.cpp 中的布局与魔数自行实现。
+ */
+class ShmPoseWriter {
+public:
+    ~ShmPoseWriter();
+    ShmPoseWriter(const ShmPoseWriter&) = delete;
+    ShmPoseWriter& operator=(const ShmPoseWriter&) = delete;
+
+    // 同名残留通道会被替换；ringCapacity 向上取整为 2 的幂；失败返回 nullptr
+    static std::shared_ptr<ShmPoseWriter> create(const std::string& name, std::size_t ringCapacity = 256);
+
+    // 单一写者；无协方差时环中条目协方差全为零。无系统调用，适合 200 Hz 以上的 VIO 输出
+    void publish(const Pose3D& pose) noexcept;
+    void publish(const PoseWithCovariance& sample) noexcept;
+
+    const std::string& name() const noexcept { return name_; }
+    std::uint64_t published() const noexcept;
+
+    struct Mapping;
+
+private:
+    ShmPoseWriter(std::string name, std::shared_ptr<Mapping> mapping);
+
+    std::string name_;
+    std::shared_ptr<Mapping> mapping_;
+};
+
+/**
+ * ShmPoseReader - 读端：open 后所有读取只访问映射内存（无系统调用、不加锁、不分配），
+ * 写入进行中时自旋重试，永远不会得到撕裂的位姿。
+ */
+class ShmPoseReader {
+public:
+    ShmPoseReader(const ShmPoseReader&) = delete;
+    ShmPoseReader& operator=(const ShmPoseReader&) = delete;
+
+    // 通道不存在或格式不符时返回 nullptr（可稍后重试）
+    static std::shared_ptr<ShmPoseReader> open(const std::string& name);
+
+    bool latest(Pose3D& pose) const noexcept;
+    bool latest(PoseWithCovariance& sample) const noexcept;
+    // 最多 maxCount 条最近的带协方差位姿，按时间升序写入 out，返回条数
+    std::size_t history(PoseWithCovariance* out, std::size_t maxCount) const noexcept;
+    // 时刻 timestampNs 的位姿（历史内插值；晚于最新时返回最新；早于最旧时返回 false）
+    bool poseAt(std::uint64_t timestampNs, Pose3D& pose) const noexcept;
+
+    // 写端已析构（应重新 open）
+    bool closed() const noexcept;
+    std::uint64_t published() const noexcept;
+    std::size_t ringCapacity() const noexcept;
+    const std::string& name() const noexcept { return name_; }
+
+private:
+    ShmPoseReader(std::string name, std::shared_ptr<ShmPoseWriter::Mapping> mapping);
+
+    std::string name_;
+    std::shared_ptr<ShmPoseWriter::Mapping> mapping_;
+};
+
+/**
+ * SlamServiceClientFromShm - 经共享内存位姿通道对接算法容器（替代按次打开文件的 SlamServiceClientFromFile）
+ *
+ * 通道尚未创建或写端已关闭时按 setReopenInterval（默认 500 ms）重试 open；已连接时 getPose / isAvailable
+ * 只读映射内存。应在同一线程（SLAM 节点 process 线程）调用。
+ */
+class SlamServiceClientFromShm : public ISlamServiceClient {
+public:
+    explicit SlamServiceClientFromShm(std::string name) : name_(std::move(name)) {}
+
+    bool getPose(Pose3D& pose) override;
+    bool isAvailable() const override;
+
+    bool poseAt(std::uint64_t timestampNs, Pose3D& pose);
+    void setReopenInterval(std::chrono::milliseconds interval) { reopenInterval_ = interval; }
+    const std::string& name() const noexcept { return name_; }
+
+private:
+    const ShmPoseReader* reader() const;
+
+    std::string name_;
+    std::chrono::milliseconds reopenInterval_{500};
+    mutable std::shared_ptr<ShmPoseReader> reader_;
+    mutable std::chrono::steady_clock::time_point lastOpenAttempt_{};
+};
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,42 @@
+// FalconMindSDK - gRPC SLAMService.SubscribePose 位姿流（FALCONMINDSDK_BUILD_GRPC_SLAM_CLIENT=ON 时启用）
+#pragma once
+
+#include "falconmind/sdk/perception/StreamingSlamClient.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * GrpcPoseStream - 以服务端流订阅算法容器位姿，配合 StreamingSlamClient 使用
+ *
+ * 未编译 gRPC 支持时 open() 始终返回 false（客户端保持不可用），可用 available() 判断。
+ */
+class GrpcPoseStream : public IPoseStream {
+public:
+    // target 如 "127.0.0.1:50051"；maxRateHz 为 0 时不限频
+    explicit GrpcPoseStream(std::string target, std::uint32_t maxRateHz = 0);
+    ~GrpcPoseStream() override;
+
+    bool open() override;
+    bool read(Pose3D& pose) override;
+    void cancel() override;
+    void reset() override;
+
+    const std::string& target() const noexcept { return target_; }
+    static bool available() noexcept;
+
+private:
+    struct Impl;
+    std::string target_;
+    std::uint32_t maxRateHz_;
+    std::unique_ptr<Impl> impl_;
+};
+
+// 便捷构造：GrpcPoseStream + StreamingSlamClient（未 start）
+std::shared_ptr<StreamingSlamClient> makeGrpcSlamClient(const std::string& target, std::uint32_t maxRateHz = 0,
+                                                        std::size_t historyCapacity = 64);
+
+} // namespace falconmind::sdk::perception
@@ -1,24 +1,64 @@
 // FalconMindSDK - SORT 风格跟踪后端
-// 卡尔曼式匀速预测 + IoU 匹配，与 SimpleTrackerBackend 并列可选。
+// 卡尔曼式匀速预测 + 网格门控 IoU 最优分配（JV），与 SimpleTrackerBackend 并列可选。
 #pragma once
 
 #include "falconmind/sdk/perception/ITrackerBackend.h"
+#include "falconmind/sdk/perception/LinearAssignment.h"
 #include "falconmind/sdk/perception/TrackingTypes.h"
 
-#include <map>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 namespace falconmind::sdk::perception {
 
-struct SortTrackState {
-    int trackId{0};
-    float cx{0.f}, cy{0.f}, w{0.f}, h{0.f};  // 中心 + 宽高
-    float vx{0.f}, vy{0.f};                   // 匀速速度
-    std::uint64_t lastTimestampNs{0};
-    int missedFrames{0};
-    int classId{-1};
-    std::string className;
-    std::vector<TrackHistoryPoint> trajectory;
+/**
+ * SortTrackTable - SORT 轨迹表（struct-of-arrays）
+ *
+ * 匹配 / 预测 / 输出只扫描连续的标量数组；按 trackId 升序排列（新轨迹追加在尾部，删除时保序压缩）。
+ * 轨迹历史存放在一块按 历史槽 × capacity 划分的环形缓冲中，追加 O(1)、删除轨迹只回收槽位，
+ * 压缩时不搬动历史点。类名在 classNames 中去重，每条轨迹只保存下标。
+ */
+struct SortTrackTable {
+    std::vector<int> trackId;
+    std::vector<float> cx, cy, w, h;  // 中心 + 宽高
+    std::vector<float> vx, vy;        // 匀速速度
+    std::vector<std::uint64_t> lastTimestampNs;
+    std::vector<int> missedFrames;
+    std::vector<float> uncertainty;   // 自上次匹配以来累积的预测不确定度（相对目标尺寸）
+    std::vector<float> score;         // 最近一次匹配的检测分数
+    std::vector<int> classId;
+    std::vector<std::uint16_t> classNameIndex;
+    std::vector<std::uint32_t> historySlot;
+
+    std::vector<std::string> classNames;
+
+    std::size_t size() const noexcept { return trackId.size(); }
+    bool empty() const noexcept { return trackId.empty(); }
+    void clear();
+
+    // 追加一条轨迹，返回其下标
+    std::size_t add(int id, const DetectionBBox& bbox, std::uint64_t ts, float score, int classId,
+                    const std::string& className);
+    // 删除 remove[i] 为 true 的轨迹，其余保持原顺序
+    void compact(const std::vector<bool>& remove);
+
+    std::uint16_t internClassName(const std::string& name);
+    const std::string& className(std::size_t i) const { return classNames[classNameIndex[i]]; }
+
+    // 历史环形缓冲：满时覆盖最旧点；修改 capacity 会保留每条轨迹最近的点
+    void setHistoryCapacity(std::size_t capacity);
+    std::size_t historyCapacity() const noexcept { return historyCapacity_; }
+    void pushHistory(std::size_t i, const TrackHistoryPoint& p);
+    TrajectoryView history(std::size_t i) const;
+
+private:
+    std::size_t historyCapacity_{100};
+    std::vector<TrackHistoryPoint> historyPoints_;   // 槽 s 占 [s * capacity, (s + 1) * capacity)
+    std::vector<std::uint32_t> historyOldest_;      // 按槽索引
+    std::vector<std::uint32_t> historyCount_;
+    std::vector<std::uint32_t> freeSlots_;
 };
 
 class SortTrackerBackend : public ITrackerBackend {
@@ -31,23 +71,48 @@ public:
     bool isLoaded() const override { return loaded_; }
 
     bool run(DetectionResult& detections, TrackingResult& outTracks) override;
+    // 无检测帧：按匀速模型外推一步，不增加漏检计数；轨迹状态为 PREDICTED，外推框写入 detections
+    bool predict(DetectionResult& detections, TrackingResult& outTracks) override;
+
+    // 检查点负载：下一个轨迹 ID + 每条轨迹的滤波状态、计数与历史点（布局变化时递增 kStateVersion）
+    static constexpr std::uint32_t kStateVersion = 1;
+    bool saveState(core::CheckpointWriter& out) const override;
+    bool restoreState(core::CheckpointReader& in) override;
 
     void setIouThreshold(float t) { iouThreshold_ = t; }
     void setMaxMissedFrames(int n) { maxMissedFrames_ = n; }
-    void setMaxTrajectoryPoints(int n) { maxTrajectoryPoints_ = n; }
+    // 每条轨迹保留的历史点数（环形缓冲容量）
+    void setMaxTrajectoryPoints(int n);
+    // 为 true 时额外把历史深拷贝到 TrackingState::trajectory（默认只提供 history 视图，每帧开销与历史长度无关）
+    void setCopyTrajectory(bool copy) { copyTrajectory_ = copy; }
+
+    const SortTrackTable& table() const noexcept { return tracks_; }
+    // 每帧未匹配（外推或漏检）时不确定度的基础增量；另按 速度 / 目标尺寸 增长，快速目标更早触发检测
+    void setProcessNoise(float n) { processNoise_ = n; }
 
 private:
     static float bboxIou(const DetectionBBox& a, const DetectionBBox& b);
     static void bboxToCenter(const DetectionBBox& b, float& cx, float& cy, float& w, float& h);
     static DetectionBBox centerToBbox(float cx, float cy, float w, float h);
-    void pruneTrajectory(std::vector<TrackHistoryPoint>& traj, int maxPoints);
+    void growUncertainty(std::size_t i);
+    void writeState(std::size_t i, const char* status, TrackingState& out) const;
 
     bool loaded_{false};
     int nextTrackId_{1};
     float iouThreshold_{0.3f};
     int maxMissedFrames_{5};
     int maxTrajectoryPoints_{100};
-    std::map<int, SortTrackState> tracks_;
+    float processNoise_{0.1f};
+    bool copyTrajectory_{false};
+    SortTrackTable tracks_;
+    // 每帧复用的预测框、门控候选与分配结果
+    std::vector<DetectionBBox> detBoxes_;
+    std::vector<DetectionBBox> predBoxes_;
+    std::vector<bool> predEnabled_;
+    std::vector<bool> detUsed_;
+    std::vector<bool> remove_;
+    std::vector<AssignmentCandidate> candidates_;
+    std::vector<int> assignment_;
 };
 
 } // namespace falconmind::sdk::perception
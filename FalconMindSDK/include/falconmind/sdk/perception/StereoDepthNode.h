@@ -0,0 +1,67 @@
+// FalconMindSDK - 双目深度节点：同步帧组 → SGM 视差 → 深度图 + 机体系障碍点云（供 ObstacleCloudNode / 占据栅格）
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/BufferPool.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/perception/StereoMatcher.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * StereoDepthNode
+ *
+ * frames_in 接收 MultiCameraSourceNode 的 frames_out 帧组包（各段 NV12 / YUYV），回调只保留最新一组的引用，
+ * process() 取 left_index / right_index 两段做 StereoMatcher 匹配，随后：
+ * - depth_out：CameraFramePacket（format "Z16"）+ 匹配分辨率的 uint16 深度（毫米，0 为无效）
+ * - pointcloud_out：PointCloudPacket，前视相机与机体对齐时的机体系点（x 前 = 深度，y 左，z 上），
+ *   每 point_step 像素取一点，只保留 [min_depth_m, max_depth_m] 内的点，intensity 为校正后亮度
+ * 两路输出均来自 BufferPool，逐帧复用。
+ *
+ * 参数：left_index（默认 0）、right_index（默认 1）、calibration（标定文件，见 loadStereoCalibration），
+ * 或上游已校正时直接给 fx / cx / cy / baseline_m；level、max_disparity、p1、p2、uniqueness、lr_check、threads
+ * （见 StereoMatcherConfig）；min_depth_m（默认 0.5）、max_depth_m（默认 20）、point_step（默认 2）
+ */
+class StereoDepthNode : public core::Node {
+public:
+    StereoDepthNode();
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void process() override;
+
+    // 以下访问须在 process() 所在线程（或节点停止后）
+    const StereoMatcher& matcher() const noexcept { return *matcher_; }
+    std::uint64_t frames() const noexcept { return frames_; }
+    std::uint32_t lastPoints() const noexcept { return lastPoints_; }
+    std::int64_t lastLatencyNs() const noexcept { return lastLatencyNs_; }
+
+private:
+    void emitDepth(std::int64_t timestampNs, std::uint64_t frameIndex);
+    void emitPoints(std::int64_t timestampNs, std::uint64_t frameIndex);
+
+    core::Pad* inPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
+    core::Pad* depthPad_{nullptr};
+    core::Pad* cloudPad_{nullptr};
+    std::unique_ptr<StereoMatcher> matcher_;
+    std::size_t leftIndex_{0}, rightIndex_{1};
+    float minDepthM_{0.5f}, maxDepthM_{20.0f};
+    int pointStep_{2};
+    bool started_{false};
+    bool warnedFormat_{false};
+    std::mutex frameMutex_;
+    core::BufferRef lastSet_;
+    core::BufferPool depthPool_;
+    core::BufferPool cloudPool_;
+    std::uint64_t frames_{0};
+    std::uint32_t lastPoints_{0};
+    std::int64_t lastLatencyNs_{0};
+};
+
+} // namespace falconmind::sdk::perception
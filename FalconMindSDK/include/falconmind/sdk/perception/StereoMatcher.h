@@ -0,0 +1,149 @@
+// FalconMindSDK - 双目立体匹配：查表校正 + 降采样、Census 代价、SGM 向量化路径聚合，输出视差 / 深度
+#pragma once
+
+#include "falconmind/sdk/core/Caps.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::core {
+class WorkerGroup;
+}
+
+namespace falconmind::sdk::perception {
+
+// 单个相机的标定（原始分辨率像素）：针孔内参、Brown-Conrady 畸变，R 为原始相机系 → 校正相机系的旋转（行主序）
+struct StereoCameraModel {
+    double fx{0.}, fy{0.}, cx{0.}, cy{0.};
+    double k1{0.}, k2{0.}, p1{0.}, p2{0.}, k3{0.};
+    std::array<double, 9> R{1., 0., 0., 0., 1., 0., 0., 0., 1.};
+};
+
+/**
+ * StereoCalibration - 立体校正参数（与 OpenCV stereoRectify 的 R1/R2/P1/P2 对应）
+ *
+ * 校正后两路共用针孔 (f, cx, cy)（原始分辨率像素），右相机位于左相机 +x 方向 baselineM 处。
+ * 上游已校正的相机只需给出 f / cx / cy / baselineM，畸变与旋转保持默认（查表退化为纯降采样）。
+ */
+struct StereoCalibration {
+    StereoCameraModel left, right;
+    double f{0.}, cx{0.}, cy{0.};
+    double baselineM{0.};
+
+    bool valid() const noexcept { return f > 0. && baselineM > 0.; }
+};
+
+// 标定文本：每行 "键 数值..."，# 起注释。键：left_K / right_K（fx fy cx cy）、left_D / right_D（k1 k2 p1 p2 [k3]）、
+// left_R / right_R（9 个数，行主序）、rectified（f cx cy）、baseline_m
+bool loadStereoCalibration(const std::string& path, StereoCalibration& out);
+
+// 校正 + 降采样查找表：输出像素 i 取源图 (x[i], y[i]) 起 2×2 邻域按 1/128 权重双线性插值；x < 0 表示落在源图外
+struct StereoRemapTable {
+    int width{0}, height{0};
+    std::vector<std::int16_t> x, y;
+    std::vector<std::uint8_t> wx, wy;
+
+    // level 级金字塔（边长缩小 2^level）：输出像素中心对应原始分辨率 ((u + 0.5)·2^level − 0.5)，
+    // 1 级时双线性权重恰为 2×2 均值，校正与降采样一次完成
+    static StereoRemapTable build(const StereoCameraModel& cam, const StereoCalibration& rect, int srcWidth,
+                                  int srcHeight, int level);
+};
+
+struct StereoMatcherConfig {
+    int level{1};             // 在第几级金字塔上匹配（0 为原始分辨率）
+    int maxDisparity{64};     // 该级分辨率下的视差搜索范围，16 的倍数
+    int p1{6};                // SGM 相邻视差变化 ±1 的惩罚（Census 代价 0~24）
+    int p2{40};               // 视差跳变惩罚
+    int uniquenessPercent{10};  // 最优代价须比次优（相差 > 1 的视差）低此百分比
+    bool lrCheck{true};       // 左右一致性检查（右图视差由同一代价体沿对角线取最小）
+    int lrMaxDiff{1};
+    std::size_t threads{0};   // 行 / 列分片数（0 为 WorkerGroup::defaultCount()）
+};
+
+// 一路输入图像（NV12 / Any 取首平面为亮度，YUYV 隔字节取亮度）
+struct StereoImage {
+    const std::uint8_t* data{nullptr};
+    int width{0}, height{0};
+    int stride{0};
+    core::PixelFormat format{core::PixelFormat::Any};
+};
+
+/**
+ * StereoMatcher - 半全局匹配（SGM）
+ *
+ * 1. 按预先计算的查找表把两路亮度校正并降到 level 级分辨率（行分片并行）
+ * 2. 5×5 Census 变换；匹配代价为左右 Census 的汉明距离，按 (y, x, d) 排列，
+ *    每个像素连续 8 / 4 个视差一次向量计算（AVX2 / SSE4.1 / NEON，运行时按 CpuFeatures 选择）
+ * 3. 四条路径（左右、上下）动态规划聚合：沿视差维向量化（饱和加法处理 d±1，向量内求最小），
+ *    水平路径按行分片、竖直路径按列分片并行，各分片只写自己的聚合和，无锁
+ * 4. 赢者通吃 + 唯一性检验 + 左右一致性 + 抛物线亚像素，无效视差为 -1
+ * 代价体（uint8）与聚合和（uint16）按 w·h·D 分配并逐帧复用。非线程安全：同一实例的 compute() 须串行调用。
+ */
+class StereoMatcher {
+public:
+    explicit StereoMatcher(const StereoMatcherConfig& cfg = {});
+    ~StereoMatcher();
+    StereoMatcher(const StereoMatcher&) = delete;
+    StereoMatcher& operator=(const StereoMatcher&) = delete;
+
+    const StereoMatcherConfig& config() const noexcept { return cfg_; }
+    // 替换标定（下一帧按输入尺寸重建查找表）
+    void setCalibration(const StereoCalibration& calib);
+    const StereoCalibration& calibration() const noexcept { return calib_; }
+
+    // 两路尺寸须一致；标定无效或格式不支持时返回 false
+    bool compute(const StereoImage& left, const StereoImage& right);
+
+    // 匹配分辨率下的结果（compute 成功后有效）
+    int width() const noexcept { return width_; }
+    int height() const noexcept { return height_; }
+    const std::vector<float>& disparity() const noexcept { return disparity_; }
+    const std::vector<std::uint8_t>& rectifiedLeft() const noexcept { return rectL_; }
+    // 匹配分辨率下的焦距 / 主点（像素）；深度 = focal · baseline / 视差
+    double focal() const noexcept { return focal_; }
+    double principalX() const noexcept { return principalX_; }
+    double principalY() const noexcept { return principalY_; }
+    float depthAt(int x, int y) const noexcept;
+    std::size_t threads() const noexcept;
+
+    // 当前使用的向量内核（"avx2" / "sse4.1" / "neon" / "scalar"）
+    static const char* kernelName() noexcept;
+
+private:
+    void prepare(int srcWidth, int srcHeight);
+    void remap(const StereoImage& img, const StereoRemapTable& table, std::vector<std::uint8_t>& out, int y0, int y1);
+    void census(const std::vector<std::uint8_t>& img, std::vector<std::uint32_t>& out, int y0, int y1);
+    void costRows(int y0, int y1);
+    void aggregateRows(int y0, int y1, std::size_t shard);
+    void aggregateColumns(int x0, int x1, std::size_t shard);
+    void selectRows(int y0, int y1, std::size_t shard);
+
+    StereoMatcherConfig cfg_;
+    StereoCalibration calib_;
+    std::unique_ptr<core::WorkerGroup> workers_;
+    int srcWidth_{0}, srcHeight_{0};
+    int width_{0}, height_{0};
+    int disparities_{0};
+    double focal_{0.}, principalX_{0.}, principalY_{0.};
+    StereoRemapTable mapL_, mapR_;
+
+    std::vector<std::uint8_t> rectL_, rectR_;
+    std::vector<std::uint8_t> validL_;  // 左图像素落在源图内
+    std::vector<std::uint32_t> censusL_, censusR_;  // 右图每行前置 disparities_ 个填充，代价内核可整段读取
+    std::vector<std::uint8_t> cost_;    // (y · w + x) · D + d
+    std::vector<std::uint16_t> sum_;
+    // 每个分片的路径缓冲（各 D + 2 个，首尾为哨兵），竖直路径每列一份
+    struct Scratch {
+        std::vector<std::uint16_t> prev, cur;
+        std::vector<std::uint16_t> prevMin;
+        std::vector<std::uint16_t> rightBest;
+        std::vector<std::int16_t> rightDisp;
+    };
+    std::vector<Scratch> scratch_;
+    std::vector<float> disparity_;
+};
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,116 @@
+// FalconMindSDK - 订阅式 SLAM 客户端：后台线程接收位姿流，节点以无锁方式读取最新位姿与短历史
+#pragma once
+
+#include "falconmind/sdk/core/SeqLock.h"
+#include "falconmind/sdk/perception/ISlamServiceClient.h"
+#include "falconmind/sdk/perception/PoseTypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * PoseHistoryBuffer - 定容量位姿环形缓冲（单写多读，无锁）
+ *
+ * 基于 core::SeqLockRing<Pose3D>，读者不加锁、不分配内存；历史始终按时间升序。
+ * 容量向上取整为 2 的幂。
+ */
+class PoseHistoryBuffer {
+public:
+    explicit PoseHistoryBuffer(std::size_t capacity = 64);
+
+    std::size_t capacity() const noexcept { return ring_.capacity(); }
+    // 累计写入条数
+    std::uint64_t count() const noexcept { return ring_.count(); }
+
+    // 仅允许单一写者
+    void push(const Pose3D& pose) noexcept { ring_.push(pose); }
+    void clear() noexcept { head_.store(0, std::memory_order_release); }
+
+    bool latest(Pose3D& pose) const noexcept { return ring_.latest(pose); }
+    // 最多 maxCount 条最近的位姿，按时间升序写入 out，返回条数
+    std::size_t history(Pose3D* out, std::size_t maxCount) const noexcept;
+    // 时刻 timestampNs 的位姿：落在历史范围内时位置线性插值、姿态四元数归一化插值；
+    // 晚于最新位姿时返回最新位姿，早于最旧位姿时返回 false
+    bool poseAt(std::uint64_t timestampNs, Pose3D& pose) const noexcept;
+
+private:
+    std::unique_ptr<core::SeqLock<Pose3D>[]> slots_;
+    std::atomic<std::uint64_t> head_{0};
+    core::SeqLockRing<Pose3D> ring_;
+};
+
+
+/**
+ * IPoseStream - 位姿流传输（gRPC SubscribePose、测试桩等）
+ *
+ * open / read 只在 StreamingSlamClient 的接收线程中调用；cancel 可从其他线程调用，使阻塞中的 read 尽快返回，
+ * 且此后的 open 返回 false，直到 reset()（客户端 start() 时调用）。
+ */
+class IPoseStream {
+public:
+    virtual ~IPoseStream() = default;
+    // 建立订阅；失败返回 false（客户端按退避间隔重试）
+    virtual bool open() = 0;
+    // 阻塞读取下一条位姿；流结束或出错返回 false（客户端重新 open）
+    virtual bool read(Pose3D& pose) = 0;
+    virtual void cancel() = 0;
+    virtual void reset() {}
+};
+
+using PoseStreamPtr = std::shared_ptr<IPoseStream>;
+
+struct StreamingSlamStats {
+    std::uint64_t received{0};
+    std::uint64_t reconnects{0};
+    bool connected{false};
+};
+
+/**
+ * StreamingSlamClient
+ *
+ * start() 后由后台线程持续读取 IPoseStream，写入 PoseHistoryBuffer；断流时以指数退避（100 ms 起，最长 2 s）重连。
+ * getPose / isAvailable / poseAt 只读原子变量与共享缓冲，不做系统调用或 RPC，
+ * VisualSlamNode / LidarSlamNode 可按自身节拍调用。
+ */
+class StreamingSlamClient : public ISlamServiceClient {
+public:
+    explicit StreamingSlamClient(PoseStreamPtr stream, std::size_t historyCapacity = 64);
+    ~StreamingSlamClient() override;
+    StreamingSlamClient(const StreamingSlamClient&) = delete;
+    StreamingSlamClient& operator=(const StreamingSlamClient&) = delete;
+
+    bool start();
+    void stop();
+    bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+
+    // 最新位姿（从未收到时返回 false）
+    bool getPose(Pose3D& pose) override;
+    // 流已连接且至少收到过一条位姿
+    bool isAvailable() const override;
+
+    bool poseAt(std::uint64_t timestampNs, Pose3D& pose) const noexcept { return buffer_.poseAt(timestampNs, pose); }
+    std::size_t history(Pose3D* out, std::size_t maxCount) const noexcept { return buffer_.history(out, maxCount); }
+    StreamingSlamStats stats() const noexcept;
+
+private:
+    void receiveLoop();
+
+    PoseStreamPtr stream_;
+    PoseHistoryBuffer buffer_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> connected_{false};
+    std::atomic<std::uint64_t> reconnects_{0};
+    std::mutex waitMutex_;
+    std::condition_variable waitCv_;
+    std::thread thread_;
+};
+
+} // namespace falconmind::sdk::perception
@@ -1,15 +1,23 @@
-// FalconMindSDK - TensorRT-based detector backend (skeleton)
+// FalconMindSDK - TensorRT-based detector backend
 #pragma once
 
+#include "falconmind/sdk/perception/AsyncInferenceQueue.h"
 #include "falconmind/sdk/perception/IDetectorBackend.h"
 
+#include <memory>
+
 namespace falconmind::sdk::perception {
 
-// TensorRT 推理后端骨架，未来在此文件中接入 NvInfer 等头文件与实现。
+// TensorRT 推理后端：反序列化 .engine（TensorRT 8.5+ 按名字绑定张量），FP32 输入 (N,3,H,W)。
+// 输出为原始 YOLO 头 (N,4+C,boxes) 时在 CPU 解码 + NMS；engine 末端带 EfficientNMS_TRT 插件时解码与 NMS
+// 在 GPU 上完成，只拷回最终检测框。
+// cuda_streams 路在途推理各有执行上下文、CUDA stream 与锁页缓冲，run() 可并发调用（配合 DetectorDispatcher），
+// 各路的 H2D 拷贝、推理与 D2H 拷贝相互重叠。
+// 未启用 FALCONMINDSDK_BUILD_TENSORRT_BACKEND 时为只输出日志的骨架
 class TensorRtDetectorBackend : public IDetectorBackend {
 public:
     TensorRtDetectorBackend() = default;
-    ~TensorRtDetectorBackend() override = default;
+    ~TensorRtDetectorBackend() override;
 
     DetectionBackendType backendType() const override {
         return DetectionBackendType::TensorRt;
@@ -22,10 +30,28 @@ public:
 
     bool run(const ImageView& image, DetectionResult& outResult) override;
 
+    // 动态 batch 的 engine 每次按实际帧数设置输入形状（上限为 max_batch 与优化 profile 的 kMAX 中较小者）；
+    // 固定 batch 的 engine 每次送满
+    bool runBatch(const ImageView* images, DetectionResult* results, std::size_t count) override;
+    std::size_t maxBatchSize() const override;
+    std::size_t maxConcurrentRuns() const override;
+
+    // 异步推理：load() 后由 AsyncInferenceQueue 执行（每个 CUDA stream 一个推理线程），在途上限为推理线程数的两倍
+    bool submit(const ImageView& image, DetectionResult& outResult, DetectionCallback done) override;
+    std::size_t maxInFlight() const override;
+
+    // 解码只读取 classFilter 列出的类别行（normalizeClassIds 之后保存）
+    bool setClassFilter(const std::vector<int>& classIds) override;
+    const std::vector<int>& classFilter() const noexcept { return classFilter_; }
+
 private:
     DetectorDescriptor desc_;
     bool loaded_{false};
+    std::vector<int> classFilter_;
+#if defined(FALCONMINDSDK_TENSORRT_BACKEND_ENABLED) && FALCONMINDSDK_TENSORRT_BACKEND_ENABLED
+    void* trtState_{nullptr};  // 实为 TensorRtState*，仅 .cpp 内使用
+#endif
+    std::unique_ptr<AsyncInferenceQueue> async_;  // 最后声明：先于其余成员销毁
 };
 
 } // namespace falconmind::sdk::perception
-
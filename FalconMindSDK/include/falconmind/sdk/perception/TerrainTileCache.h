@@ -0,0 +1,116 @@
+// FalconMindSDK - 地形高程瓦片缓存：mmap 分块 DEM 文件，LRU 驻留预算、双线性 / 批量高程查询与沿航线预取
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+struct TerrainCacheConfig {
+    std::size_t residentBudgetBytes{64u << 20};  // 同时驻留（已映射访问）的瓦片字节上限，超出按 LRU 释放
+};
+
+// 规则经纬度网格 DEM（行主序，第 r 行对应纬度 originLat + r * latSpacingDeg，即第 0 行在最南）；
+// 无数据的样本为 NaN
+struct DemGrid {
+    double originLat{0.}, originLon{0.};
+    double latSpacingDeg{0.}, lonSpacingDeg{0.};
+    int rows{0}, cols{0};
+    std::vector<float> heights;
+};
+
+/**
+ * TerrainTileCache
+ *
+ * 文件格式（.fmdt，由 writeTerrainTiles / convertSrtmHgt 从 DEM 网格 / SRTM .hgt 转换）：
+ * 文件头 + 按 tileSize × tileSize 个网格单元分块的瓦片，每块存 (tileSize + 1)² 个 float 样本（与北 / 东邻块
+ * 共享一行一列，双线性插值不跨块），按页对齐；瓦片偏移表中 0 表示该块全无数据（如海面）未写入。
+ *
+ * open() 只读 mmap 整个文件，不拷贝；首次访问某块时登记为驻留，驻留字节超出 residentBudgetBytes 时
+ * 释放最久未用的块（MADV_DONTNEED + POSIX_FADV_DONTNEED），之后再访问由内核缺页重新读入，与并发查询无竞争。
+ * 查询热路径无锁：块内偏移计算 + 四次读取 + 一次原子时间戳更新；只有块首次驻留时加锁。
+ * prefetchPath() 沿航线把邻近的块提前登记并 MADV_WILLNEED 异步预读，飞行中的投影 / 规划查询不再缺页。
+ * 线程安全。
+ */
+class TerrainTileCache {
+public:
+    ~TerrainTileCache();
+    TerrainTileCache(const TerrainTileCache&) = delete;
+    TerrainTileCache& operator=(const TerrainTileCache&) = delete;
+
+    // 文件不存在或格式不符时返回 nullptr
+    static std::shared_ptr<TerrainTileCache> open(const std::string& path, const TerrainCacheConfig& cfg = {});
+
+    // 双线性插值高程（米）；覆盖范围外或邻近样本无数据时返回 false
+    bool height(double lat, double lon, float& out) const noexcept;
+    // 批量查询：无数据处写 NaN，返回有效个数。连续落在同一块的点跳过块查找
+    std::size_t heights(const double* lat, const double* lon, std::size_t count, float* out) const noexcept;
+    // 沿航线（折线顶点）预取两侧 marginM 米内的瓦片，至多占满驻留预算；返回新登记的块数
+    std::size_t prefetchPath(const double* lat, const double* lon, std::size_t count, double marginM = 500.0) const;
+
+    // 覆盖范围（西南角 / 东北角样本）
+    double minLat() const noexcept { return originLat_; }
+    double minLon() const noexcept { return originLon_; }
+    double maxLat() const noexcept { return originLat_ + (rows_ - 1) * latSpacing_; }
+    double maxLon() const noexcept { return originLon_ + (cols_ - 1) * lonSpacing_; }
+    int tileSize() const noexcept { return tileSize_; }
+    std::size_t tileBytes() const noexcept { return tileBytes_; }
+    std::size_t tileCount() const noexcept { return static_cast<std::size_t>(tilesLat_) * tilesLon_; }
+    std::size_t residentTiles() const;
+    std::size_t residentBytes() const;
+    std::uint64_t tileLoads() const noexcept { return loads_.load(std::memory_order_relaxed); }
+    std::uint64_t evictions() const noexcept { return evictions_.load(std::memory_order_relaxed); }
+    const std::string& path() const noexcept { return path_; }
+
+private:
+    struct TileState {
+        std::atomic<std::uint32_t> lastUse{0};
+        std::atomic<bool> resident{false};
+    };
+
+    explicit TerrainTileCache(const TerrainCacheConfig& cfg) : cfg_(cfg) {}
+    bool load();
+    // 块数据指针（块不存在时为 nullptr），并更新其 LRU 时间戳
+    const float* tile(std::size_t index) const noexcept;
+    // 块首次驻留：登记并按预算释放最久未用的块；返回是否新登记
+    bool admit(std::size_t index, bool willNeed) const;
+    void release(std::size_t index) const;
+    // 网格坐标（行 / 列，浮点）是否在覆盖范围内，并截断到边缘
+    bool inRange(double& fr, double& fc) const noexcept;
+    // 块内双线性插值：(r0, c0) 为插值单元左下角的全局样本下标
+    float sample(const float* tile, int r0, int c0, double fr, double fc) const noexcept;
+
+    TerrainCacheConfig cfg_;
+    std::string path_;
+    int fd_{-1};
+    std::uint8_t* base_{nullptr};
+    std::size_t length_{0};
+    double originLat_{0.}, originLon_{0.};
+    double latSpacing_{0.}, lonSpacing_{0.};
+    double invLatSpacing_{0.}, invLonSpacing_{0.};
+    int rows_{0}, cols_{0};
+    int tileSize_{0};
+    int tilesLat_{0}, tilesLon_{0};
+    std::size_t tileBytes_{0};
+    const std::uint64_t* offsets_{nullptr};  // 指向映射内的瓦片偏移表
+
+    std::unique_ptr<TileState[]> states_;
+    mutable std::mutex mutex_;  // 保护 resident_ 与驻留登记 / 释放
+    mutable std::vector<std::uint32_t> resident_;
+    mutable std::atomic<std::uint32_t> epoch_{1};  // 每登记一块加一：LRU 时间戳的粒度
+    mutable std::atomic<std::uint64_t> loads_{0};
+    mutable std::atomic<std::uint64_t> evictions_{0};
+};
+
+// 把 DEM 网格转换为分块文件（tileSize 为每块网格单元数）
+bool writeTerrainTiles(const std::string& path, const DemGrid& grid, int tileSize = 256);
+// 读取 SRTM .hgt（大端 int16，1201² 或 3601²，-32768 为空洞）；西南角由文件名（如 N37W122.hgt）给出
+bool loadSrtmHgt(const std::string& path, DemGrid& grid);
+bool convertSrtmHgt(const std::string& hgtPath, const std::string& outPath, int tileSize = 256);
+
+} // namespace falconmind::sdk::perception
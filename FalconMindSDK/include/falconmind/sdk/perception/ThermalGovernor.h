@@ -0,0 +1,155 @@
+// FalconMindSDK - ThermalGovernor：按 SoC 温度、CPU/NPU 频率上限与电池续航提前降低感知负载，避免热降频导致推理时延突增
+#pragma once
+
+#include "falconmind/sdk/flight/FlightEstimators.h"
+#include "falconmind/sdk/perception/IDetectorBackend.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+class AltitudeModelPolicy;
+class InferenceRateController;
+
+// 负载等级：越高降得越多
+enum class ThermalLevel : std::uint8_t {
+    Nominal = 0,
+    Warm,
+    Hot,
+    Critical,
+    Count
+};
+
+const char* thermalLevelName(ThermalLevel level) noexcept;
+
+// 一次 sysfs 采样；不可读的项保持默认值（无温区时 hasTemp 为 false，频率为 -1）
+struct ThermalSample {
+    bool hasTemp{false};
+    double maxTempC{0.};          // 所选温区中的最高温度
+    std::string hottestZone;      // 对应温区的 type（如 "npu-thermal"）
+    double cpuFreqRatio{-1.};     // 各 cpufreq 策略 scaling_max_freq / cpuinfo_max_freq 的最小值（被温控压低时 < 1）
+    double npuFreqRatio{-1.};     // NPU devfreq max_freq / available_frequencies 最大值
+    double npuFreqMHz{-1.};       // NPU devfreq cur_freq
+};
+
+// 某一等级下的感知负载
+struct ThermalLevelActions {
+    int intervalScale{1};            // InferenceRateController 定期检测间隔 = 原始 baseInterval × intervalScale
+    int maxInputSide{0};             // AltitudeModelPolicy 模型输入较长边上限；0 为不限
+    std::size_t maxInferences{0};    // 每帧推理次数（切片数 + 整帧）上限；1 为禁止切片，0 为不限
+    std::uint32_t npuCoreMask{0};    // 登记的 NPU 后端的核掩码；0 为恢复登记时的掩码
+};
+
+struct ThermalGovernorConfig {
+    std::string sysfsRoot{"/"};      // 测试时指向伪造的 sysfs 目录
+    std::vector<std::string> zoneTypes;  // 参与判断的温区 type；空为全部温区
+    // 升到 Warm / Hot / Critical 的温度阈值（℃）；RK3588 内核在 85℃ 开始被动降频，阈值须低于它以提前降载
+    std::array<double, 3> levelTempC{65., 75., 82.};
+    double hysteresisC{5.};          // 降级须低于该等级阈值 hysteresisC
+    double lookaheadSec{20.};        // 升级按当前温度 + 升温速率 × lookaheadSec 的预测温度判断
+    double slopeAlpha{0.3};          // 升温速率低通系数
+    int cooldownMs{15000};           // 等级变化后至少保持该时长才允许再降一级（升级不受限）
+    double throttleRatio{0.9};       // CPU/NPU 频率上限被压低到该比例以下时至少为 Hot（内核已在降频）
+    double lowEnduranceSec{600.};    // 续航低于该值时至少为 Warm；<= 0 关闭
+    double criticalEnduranceSec{180.};  // 续航低于该值时至少为 Hot；<= 0 关闭
+    int pollMs{1000};                // start() 采样周期
+    // 各等级的负载，下标为 ThermalLevel
+    std::array<ThermalLevelActions, static_cast<std::size_t>(ThermalLevel::Count)> actions{{
+        {1, 0, 0, 0},
+        {2, 0, 4, 0},
+        {3, 640, 1, 0x3},
+        {6, 416, 1, 0x1},
+    }};
+};
+
+/**
+ * ThermalGovernor - 热 / 功耗感知的感知负载调节
+ *
+ * 每次采样读取 <sysfsRoot>/sys/class/thermal/thermal_zoneN/temp（毫摄氏度）、
+ * sys/devices/system/cpu/cpufreq/policyN/{scaling_max_freq,cpuinfo_max_freq}、
+ * sys/class/devfreq/（名称含 "npu"）/{cur_freq,max_freq,available_frequencies}，
+ * 连同 setEnergyEstimate() 给出的最新电池估计决定等级：
+ * - 升级：预测温度（当前温度 + 正的升温速率 × lookaheadSec）达到阈值、频率上限已被压低或续航不足时立即升到对应等级
+ * - 降级：当前温度低于当前等级阈值 hysteresisC、频率与续航条件也已解除，且距上次变化超过 cooldownMs 时降一级
+ * 等级变化时把 ThermalLevelActions 应用到登记的对象：InferenceRateController 的定期检测间隔、
+ * AltitudeModelPolicy 的资源上限（输入尺寸 / 切片数，由 DetectionNode 在后台预加载后切换变体）、NPU 后端的核掩码。
+ * 与其在内核降频后时延翻倍，不如提前以可预测的较低负载运行。线程安全；start() 在后台线程按 pollMs 采样。
+ */
+class ThermalGovernor {
+public:
+    explicit ThermalGovernor(ThermalGovernorConfig config = {});
+    ~ThermalGovernor();
+    ThermalGovernor(const ThermalGovernor&) = delete;
+    ThermalGovernor& operator=(const ThermalGovernor&) = delete;
+
+    // 登记受控对象；登记时按当前等级立即应用一次。controller 的原始间隔取登记时的 baseInterval
+    void addRateController(std::shared_ptr<InferenceRateController> controller);
+    void addModelPolicy(std::shared_ptr<AltitudeModelPolicy> policy);
+    // nominalMask 为 Nominal 等级（及 actions.npuCoreMask 为 0 时）使用的核掩码，0 为自动
+    void addNpuBackend(DetectorBackendPtr backend, std::uint32_t nominalMask = 0);
+
+    // 飞控线程调用（EnergyEstimator::estimate()）；valid 为 false 时不参与判断
+    void setEnergyEstimate(const flight::EnergyEstimate& energy);
+
+    // 读取 sysfs 并更新等级；返回新等级。nowNs 为单调时钟
+    ThermalLevel poll(std::int64_t nowNs);
+    // 以给定样本更新等级（poll() 的判断部分，供回放与测试）
+    ThermalLevel update(const ThermalSample& sample, std::int64_t nowNs);
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running_.load(); }
+
+    ThermalLevel level() const;
+    ThermalSample lastSample() const;
+    // 升温速率（℃/s，低通）
+    double tempSlopeCPerSec() const;
+    std::uint64_t levelChanges() const;
+    const ThermalGovernorConfig& config() const noexcept { return config_; }
+
+    // 读取一次 root 下的 sysfs；zoneTypes 为空时取全部温区
+    static ThermalSample readSysfs(const std::string& root, const std::vector<std::string>& zoneTypes = {});
+
+private:
+    struct RateTarget {
+        std::shared_ptr<InferenceRateController> controller;
+        int baseInterval{1};
+    };
+    struct NpuTarget {
+        DetectorBackendPtr backend;
+        std::uint32_t nominalMask{0};
+    };
+
+    ThermalLevel targetLevel(const ThermalSample& sample, double tempC) const;
+    void applyLocked();
+    void run();
+
+    ThermalGovernorConfig config_;
+    mutable std::mutex mutex_;
+    ThermalLevel level_{ThermalLevel::Nominal};
+    ThermalSample last_;
+    flight::EnergyEstimate energy_;
+    double slope_{0.};
+    std::int64_t lastSampleNs_{0};
+    std::int64_t changedNs_{0};
+    std::uint64_t changes_{0};
+    std::vector<RateTarget> rateTargets_;
+    std::vector<std::shared_ptr<AltitudeModelPolicy>> policies_;
+    std::vector<NpuTarget> npuTargets_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+} // namespace falconmind::sdk::perception
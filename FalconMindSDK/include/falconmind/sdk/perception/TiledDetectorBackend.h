@@ -0,0 +1,114 @@
+// FalconMindSDK - 切片推理：高分辨率帧切成重叠切片批量检测，跨切片合并结果（航拍小目标）
+#pragma once
+
+#include "falconmind/sdk/core/WorkerGroup.h"
+#include "falconmind/sdk/perception/IDetectorBackend.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * TiledDetectorBackend - 包装任意检测后端，对整帧做切片推理
+ *
+ * 4K 帧直接缩放到 640×640 时 100 m 高度的行人只剩几个像素；切片后每片按模型输入尺寸推理，小目标保持原始分辨率。
+ * - 切片布局：每个方向按 tileWidth/tileHeight 与 tileOverlap 均匀铺满整帧，首尾切片贴齐边缘
+ * - 切片以原帧 stride 构造子视图，不拷贝像素；仅支持 RGB8/BGR8（非紧凑格式退化为整帧单次推理）
+ * - 待推理切片（及可选的整帧）按内层 maxBatchSize() 分批，由 maxConcurrentRuns() 个线程并发 runBatch()，
+ *   吞吐随 NPU 上下文 / CUDA stream 数扩展
+ * - 合并：各切片结果平移回整帧坐标后按类别去重（IoU 超过 nmsThreshold，或交集超过较小框面积的 0.8）；
+ *   贴着切片内部边界的框可能是截断的残框，同类冲突时让位于完整框
+ * - 运动跳过：tileMotionThreshold > 0 时按 8 像素网格采样亮度，与该切片上次推理时的平均差异低于阈值的切片复用上次检测结果；
+ *   setRegionsOfInterest() 之外的切片直接跳过
+ * - 外部变化区域：setChangedRegions()（如 MotionGate 的结果）给出本帧变化区域后，不与之相交的切片复用上次结果，
+ *   复用的框按给出的画面平移对齐到本帧
+ * run() 须串行调用（maxConcurrentRuns() 为 1），并发由内部线程完成
+ */
+class TiledDetectorBackend : public IDetectorBackend {
+public:
+    explicit TiledDetectorBackend(DetectorBackendPtr inner);
+    ~TiledDetectorBackend() override;
+
+    DetectionBackendType backendType() const override;
+
+    // 加载内层后端并读取 desc 的 tile* 字段；tileWidth 为 0 时取 desc.inputWidth（仍为 0 时为 640）
+    bool load(const DetectorDescriptor& desc) override;
+    void unload() override;
+    bool isLoaded() const override;
+
+    bool run(const ImageView& image, DetectionResult& outResult) override;
+
+    std::vector<core::PixelFormat> supportedPixelFormats() const override;
+    bool setNpuCoreMask(std::uint32_t mask) override;
+    bool setClassFilter(const std::vector<int>& classIds) override;
+
+    // 感兴趣区域（整帧像素坐标），与任一区域不相交的切片不推理；空为整帧（默认）
+    void setRegionsOfInterest(std::vector<DetectionBBox> regions);
+    // 只对下一次 run() 生效：与 regions 不相交且已有结果的切片复用上次结果（受 tileMaxReuse 限制）；
+    // shiftX / shiftY 为相对上一次 run() 的画面平移（像素），复用的框随之平移
+    void setChangedRegions(std::vector<DetectionBBox> regions, float shiftX = 0.f, float shiftY = 0.f);
+
+    const DetectorBackendPtr& inner() const noexcept { return inner_; }
+    // 最近一帧的切片布局（整帧坐标）与本帧实际推理 / 复用的切片数
+    const std::vector<DetectionBBox>& tiles() const noexcept { return layout_; }
+    std::size_t lastInferredTiles() const noexcept { return lastInferred_; }
+    std::size_t lastReusedTiles() const noexcept { return lastReused_; }
+
+    // width×height 帧按 tileWidth×tileHeight（相互重叠 overlap）铺满时的切片数，与 run() 的布局一致
+    static std::size_t tileCount(int width, int height, int tileWidth, int tileHeight, float overlap);
+
+private:
+    struct Tile {
+        int x{0}, y{0}, w{0}, h{0};
+        std::vector<Detection> detections;  // 上次推理结果（整帧坐标）
+        std::vector<std::uint8_t> refLuma;  // 上次推理时切片内的亮度采样，运动判断的基准
+        int reused{0};                       // 连续复用帧数
+        bool valid{false};                   // 已有可复用的结果
+    };
+
+    void buildLayout(int width, int height);
+    void sampleLuma(const ImageView& image);
+    float tileMotion(const Tile& tile) const;
+    void storeReference(Tile& tile) const;
+    bool tileInRoi(const Tile& tile) const;
+    bool tileChanged(const Tile& tile) const;
+    bool inferViews(std::size_t count);
+    bool touchesInnerEdge(const Tile& tile, const DetectionBBox& box) const;
+    void merge(std::vector<Detection>& detections, const std::vector<bool>& truncated) const;
+
+    DetectorBackendPtr inner_;
+    DetectorDescriptor desc_;
+    bool loaded_{false};
+    int tileW_{640};
+    int tileH_{640};
+    std::unique_ptr<core::WorkerGroup> workers_;
+
+    int frameW_{0};
+    int frameH_{0};
+    std::vector<Tile> tiles_;
+    std::vector<DetectionBBox> layout_;
+    std::vector<DetectionBBox> regions_;
+    std::vector<DetectionBBox> changedRegions_;
+    bool changedRegionsSet_{false};
+    float shiftX_{0.f};
+    float shiftY_{0.f};
+
+    // 当前帧的亮度采样网格（每 kMotionStep 像素一个样本），用于运动判断
+    static constexpr int kMotionStep = 8;
+    int gridW_{0};
+    int gridH_{0};
+    std::vector<std::uint8_t> luma_;
+
+    // 本帧待推理的视图（切片，最后一项可能为整帧）与结果；tileOf_[i] 为对应切片下标，-1 为整帧
+    std::vector<ImageView> views_;
+    std::vector<DetectionResult> results_;
+    std::vector<int> tileOf_;
+    std::vector<bool> truncated_;  // 与合并前的检测逐项对应：框贴着切片内部边界
+    std::size_t lastInferred_{0};
+    std::size_t lastReused_{0};
+};
+
+} // namespace falconmind::sdk::perception
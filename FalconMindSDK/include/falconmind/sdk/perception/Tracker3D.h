@@ -0,0 +1,158 @@
+// FalconMindSDK - 三维多目标跟踪：地理投影 / 深度抬升的检测在局部 NED 系（米）中关联，输出带速度的物理位置轨迹
+#pragma once
+
+#include "falconmind/sdk/core/FixedMatrix.h"
+#include "falconmind/sdk/perception/GeoProjection.h"
+#include "falconmind/sdk/perception/LinearAssignment.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+// 一次三维观测，局部 NED（米，原点见 Tracker3D::setOrigin）
+struct Detection3D {
+    double north{0.}, east{0.}, down{0.};
+    float stdHorizontalM{2.f};   // 测量标准差：水平各轴
+    float stdVerticalM{2.f};     // 测量标准差：垂直
+    float score{1.f};
+    int classId{-1};
+    std::string className;
+    int sourceTrackId{-1};       // 产生该观测的图像轨迹（GeoTrack::trackId），-1 为无
+    DetectionBBox bbox;          // 源图像中的框（像素），供缩略图
+};
+
+struct Track3D {
+    int trackId{-1};
+    int classId{-1};
+    std::string className;
+    std::string status;              // ACTIVE / PREDICTED / LOST（与二维跟踪后端一致）
+    double north{0.}, east{0.}, down{0.};
+    double velNorth{0.}, velEast{0.}, velDown{0.};  // m/s
+    double lat{0.}, lon{0.}, alt{0.};               // 位置换算的经纬高
+    float posStdM{0.f};              // 水平位置标准差（协方差迹的均方根）
+    float score{0.f};
+    int hits{0};
+    int missedFrames{0};
+    int sourceTrackId{-1};           // 最近一次关联的图像轨迹
+    DetectionBBox bbox;
+    std::uint64_t lastUpdateNs{0};
+
+    double speed() const noexcept { return std::sqrt(velNorth * velNorth + velEast * velEast + velDown * velDown); }
+    double groundSpeed() const noexcept { return std::sqrt(velNorth * velNorth + velEast * velEast); }
+};
+
+struct Tracking3DResult {
+    std::string frameId;
+    std::uint64_t timestampNs{0};
+    std::uint32_t frameIndex{0};
+    std::vector<Track3D> tracks;     // 只含已确认（hits >= minHits）的轨迹
+};
+
+struct Tracker3DConfig {
+    float gateChi2{11.34f};          // 新息马氏距离平方门限（3 自由度 99%）
+    float maxGateDistanceM{30.f};    // 水平欧氏门限，同时为空间网格边长
+    float accelStd{3.f};             // 匀速模型过程噪声：加速度标准差（m/s²）
+    float initVelocityStd{8.f};      // 新轨迹速度标准差（m/s）
+    float sameSourceBonus{0.5f};     // 与上次关联同一图像轨迹时代价乘以该系数
+    int minHits{2};                  // 确认前不输出
+    int maxMissedFrames{15};         // 连续未匹配的观测帧数，超出后输出 LOST 并在下一帧移除
+    float newTrackScore{0.3f};       // 新建轨迹的最低分数
+    bool matchClass{true};           // 只关联同类（classId 均 >= 0 时）
+    std::uint64_t framePeriodNs{100'000'000};  // 时间戳缺失 / 不递增时的名义帧间隔
+    // GeoTrackingResult 输入的测量噪声：水平标准差 = max(geoMinStdM, 斜距 × geoAngularStdRad)
+    float geoAngularStdRad{0.01f};
+    float geoMinStdM{1.f};
+};
+
+/**
+ * Tracker3D - 世界坐标中的多目标跟踪
+ *
+ * 状态为局部 NED 位置与速度（6 维匀速卡尔曼滤波，core::Matrix 定尺寸、无堆分配），观测为三维位置。
+ * 每帧流程：
+ * - 预测：全部轨迹处于同一时刻，F、Q 每帧只构造一次，按块公式批量更新均值与协方差（连续数组，无逐轨迹分支）
+ * - 门控：轨迹预测位置按水平网格（边长 maxGateDistanceM）分桶，观测只与 3×3 邻格中的轨迹计算马氏距离，
+ *   拥挤场景下代价与局部密度而不是轨迹总数成正比
+ * - 分配：代价为马氏距离平方（同一图像轨迹再乘 sameSourceBonus），经 solveSparseAssignment 按连通分量最优求解
+ * - 更新 / 新建 / 丢失：未匹配且分数足够的观测新建轨迹；连续 maxMissedFrames 帧未匹配的轨迹输出 LOST 后移除
+ * 输出位置与速度为物理量（米、m/s），跟随目标与 EventReporterNode / ClusterCenter 去重可直接使用，
+ * 图像轨迹 ID 切换或多相机看到同一目标时仍为同一条三维轨迹。
+ *
+ * 经纬高与局部 NED 的换算为原点处的切平面近似（与 GeoProjector 相同，数公里内适用）。非线程安全。
+ */
+class Tracker3D {
+public:
+    explicit Tracker3D(Tracker3DConfig config = {});
+
+    void setOrigin(double lat, double lon, double alt);
+    bool hasOrigin() const noexcept { return hasOrigin_; }
+    void toLocal(double lat, double lon, double alt, double& north, double& east, double& down) const noexcept;
+    void toGeo(double north, double east, double down, double& lat, double& lon, double& alt) const noexcept;
+
+    // 一帧观测（时刻 timestampNs）：预测 → 门控 → 分配 → 更新；out 为更新后的已确认轨迹
+    void track(std::uint64_t timestampNs, const std::vector<Detection3D>& detections, Tracking3DResult& out);
+    // GeoTrackingResult 中有效的 ACTIVE 轨迹作为观测（未设置原点时以首个有效点为原点）；
+    // 全部为 PREDICTED（上游跳过检测）时只外推、不计漏检
+    void track(const GeoTrackingResult& geo, Tracking3DResult& out);
+    // 无观测帧：预测到 timestampNs，不计漏检，状态为 PREDICTED
+    void predict(std::uint64_t timestampNs, Tracking3DResult& out);
+    // 把一条轨迹外推到 timestampNs（不改变内部状态），供跟随控制取提前量；无该轨迹时返回 false
+    bool extrapolate(int trackId, std::uint64_t timestampNs, Track3D& out) const;
+
+    void reset();
+    // 内部轨迹数（含未确认）
+    std::size_t trackCount() const noexcept { return meta_.size(); }
+    const Tracker3DConfig& config() const noexcept { return config_; }
+
+private:
+    using State = core::Vector<float, 6>;        // n, e, d, vn, ve, vd（相对原点）
+    using Covariance = core::Matrix<float, 6, 6>;
+    using Mat3 = core::Matrix<float, 3, 3>;
+
+    struct TrackMeta {
+        int trackId{0};
+        int classId{-1};
+        std::string className;
+        float score{0.f};
+        int hits{0};
+        int missedFrames{0};
+        int sourceTrackId{-1};
+        DetectionBBox bbox;
+        std::uint64_t lastUpdateNs{0};
+    };
+
+    void predictAll(std::uint64_t timestampNs);
+    void gate(const std::vector<Detection3D>& detections);
+    void update(std::size_t i, const Detection3D& det, std::uint64_t timestampNs);
+    void initiate(const Detection3D& det, std::uint64_t timestampNs);
+    void removeLost();
+    void write(std::size_t i, const char* status, Track3D& out) const;
+    void emit(std::uint64_t timestampNs, bool predicted, Tracking3DResult& out) const;
+    std::int64_t cellKey(float north, float east) const noexcept;
+    static Mat3 measurementCovariance(const Detection3D& det) noexcept;
+
+    Tracker3DConfig config_;
+    bool hasOrigin_{false};
+    double originLat_{0.}, originLon_{0.}, originAlt_{0.};
+    double metersPerDegLon_{0.};
+    int nextTrackId_{1};
+    std::uint64_t stateNs_{0};       // 全部轨迹状态所处的时刻
+
+    // 结构数组：滤波状态与轨迹元数据分开存放，预测循环只访问前两者
+    std::vector<State> mean_;
+    std::vector<Covariance> cov_;
+    std::vector<TrackMeta> meta_;
+
+    // 每帧复用的门控 / 分配缓冲
+    std::vector<std::pair<std::int64_t, int>> cells_;  // (网格键, 轨迹下标)，按键排序
+    std::vector<AssignmentCandidate> candidates_;
+    std::vector<int> assignment_;
+    std::vector<bool> matched_;
+    std::vector<Detection3D> geoDetections_;
+};
+
+} // namespace falconmind::sdk::perception
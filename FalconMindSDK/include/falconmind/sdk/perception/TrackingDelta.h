@@ -0,0 +1,91 @@
+// FalconMindSDK - 增量跟踪输出：新增 / 更新（仅最新点）/ 移除，周期关键帧供中途加入的订阅方重建
+#pragma once
+
+#include "falconmind/sdk/perception/TrackingTypes.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+/**
+ * TrackingDelta - 相对上一帧的轨迹变化
+ *
+ * 普通帧：added 为新出现的轨迹（完整历史），updated 为本帧有新轨迹点或状态 / 类别变化的轨迹
+ * （trajectory 只含最新点，未新增点时为空），removed 为本帧 LOST 或消失的 trackId。
+ * 关键帧（keyframe）：added 为全部在册轨迹（完整历史），updated 为空，接收方应先清空本地状态。
+ * 只是外推、没有新点且状态不变的轨迹不出现在增量中，数据量随变化量而非目标总数增长。
+ */
+struct TrackingDelta {
+    std::string frameId;
+    std::uint64_t timestampNs{0};
+    std::uint32_t frameIndex{0};
+    std::uint64_t sequence{0};  // 编码器输出序号，接收方据此发现丢包并等待下一关键帧
+    bool keyframe{false};
+    std::vector<TrackingState> added;
+    std::vector<TrackingState> updated;
+    std::vector<int> removed;
+
+    bool empty() const noexcept { return !keyframe && added.empty() && updated.empty() && removed.empty(); }
+};
+
+/**
+ * TrackingDeltaEncoder - 把跟踪后端每帧的完整 TrackingResult 编码为 TrackingDelta
+ *
+ * 每条轨迹只记住最新轨迹点时间戳、状态与类别，编码 O(轨迹数)；输出中的 trajectory 均为拷贝，
+ * 可安全跨帧保存或交给其他线程。首帧、每 keyframeInterval 帧以及 requestKeyframe() 后输出关键帧。
+ */
+class TrackingDeltaEncoder {
+public:
+    // 0 表示只在首帧与 requestKeyframe() 后输出关键帧
+    void setKeyframeInterval(std::uint32_t frames) { keyframeInterval_ = frames; }
+    std::uint32_t keyframeInterval() const noexcept { return keyframeInterval_; }
+    // 新订阅方加入时调用：下一帧输出关键帧
+    void requestKeyframe() noexcept { forceKeyframe_ = true; }
+    void reset();
+
+    void encode(const TrackingResult& snapshot, TrackingDelta& out);
+
+private:
+    struct Known {
+        std::uint64_t lastPointNs{0};
+        std::string status;
+        int classId{-1};
+        std::uint64_t seenSequence{0};
+    };
+
+    std::uint32_t keyframeInterval_{30};
+    std::uint32_t sinceKeyframe_{0};
+    bool forceKeyframe_{true};
+    std::uint64_t sequence_{0};
+    std::unordered_map<int, Known> known_;
+};
+
+/**
+ * TrackingDeltaDecoder - 接收方按增量重建轨迹表（ClusterCenter / Viewer 侧或测试用）
+ *
+ * 每条轨迹的 trajectory 按 updated 中的最新点追加，保留最近 maxTrajectoryPoints 个点。
+ * 序号不连续时丢弃后续增量直到收到关键帧，apply() 返回 false。
+ */
+class TrackingDeltaDecoder {
+public:
+    void setMaxTrajectoryPoints(std::size_t n) { maxTrajectoryPoints_ = n; }
+    bool apply(const TrackingDelta& delta);
+    bool synced() const noexcept { return synced_; }
+
+    // 当前轨迹表（按 trackId 升序）
+    std::vector<TrackingState> tracks() const;
+    const std::unordered_map<int, TrackingState>& trackMap() const noexcept { return tracks_; }
+
+private:
+    void appendPoints(TrackingState& dst, const TrackingState& src);
+
+    std::size_t maxTrajectoryPoints_{100};
+    bool synced_{false};
+    std::uint64_t lastSequence_{0};
+    std::unordered_map<int, TrackingState> tracks_;
+};
+
+} // namespace falconmind::sdk::perception
@@ -4,11 +4,41 @@
 
 #include "falconmind/sdk/core/Node.h"
 #include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/core/StateCheckpoint.h"
+#include "falconmind/sdk/perception/GeoProjection.h"
 #include "falconmind/sdk/perception/ITrackerBackend.h"
+#include "falconmind/sdk/perception/InferenceRateController.h"
+#include "falconmind/sdk/perception/Tracker3D.h"
+#include "falconmind/sdk/perception/TrackingDelta.h"
+#include "falconmind/sdk/sensors/TrackedRoi.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace falconmind::sdk::perception {
 
-class TrackingTransformNode : public core::Node {
+// detection_in 收到检测结果包时按其源帧时间戳统计采集到跟踪的时延（LatencySink）；
+// 未连接上游时使用内部占位检测。
+// 收到 trackerPredicted 结果（上游跳过检测）时调用 backend 的 predict() 外推轨迹；
+// 设置 InferenceRateController 时每次更新后把跟踪结果反馈给它（轨迹不确定 / 丢失时请求立即检测）。
+// 设置 GeoProjector 时每次更新后把全部轨迹投影到地面经纬度（lastGeoTracks()），下游无需重复换算；
+// 同时设置 Tracker3D 时再以投影结果更新三维轨迹（lastTracks3D()，局部 NED 位置与速度）；
+// 设置 TrackedRoi 时每次更新后把跟随目标的中心与速度（源全幅坐标）写入，相机据此移动下一帧的裁剪窗口；
+// 跟随目标为 roi_track_id 指定的轨迹，未指定时沿用当前目标，目标丢失后改选框面积最大的轨迹。
+// 设置检查点区段（setCheckpoint）时 start() 加载后端后从区段恢复轨迹（热重启），每次更新后按区段周期保存。
+// 每次更新后在 tracking_out 输出带 trackId / className 的 v2 检测结果包（DetectionResultView 可零拷贝读取）
+//
+// configure 参数：
+//   tracker            simple / sort / bytetrack：创建对应后端（未通过 setBackend 注入时使用），start() 时加载
+//   output_mode        snapshot（默认）/ delta：delta 时把每帧轨迹编码为 TrackingDelta，
+//                      经 TelemetryPublisher::publishTracking 发布（上行数据量随变化量增长）
+//   keyframe_interval  delta 模式关键帧间隔（帧，默认 30；0 只在首帧与 requestKeyframe() 后）
+//   uav_id             发布消息中的 UAV 标识（默认 uav0）
+//   roi_track_id       跟踪 ROI 跟随的轨迹 ID（默认 -1 自动选择）
+class TrackingTransformNode : public core::Node, public core::LatencySink {
 public:
     TrackingTransformNode();
 
@@ -17,10 +47,59 @@ public:
     void process() override;
 
     void setBackend(TrackerBackendPtr backend) { backend_ = std::move(backend); }
+    void setRateController(std::shared_ptr<InferenceRateController> controller) { rateController_ = std::move(controller); }
+    void setGeoProjector(std::shared_ptr<GeoProjector> projector) { geoProjector_ = std::move(projector); }
+    // 须同时设置 GeoProjector
+    void setTracker3D(std::shared_ptr<Tracker3D> tracker) { tracker3d_ = std::move(tracker); }
+    void setRoiController(std::shared_ptr<sensors::TrackedRoi> roi) { roiController_ = std::move(roi); }
+    // 跟踪状态检查点；section 的 version 取后端的状态版本（如 SortTrackerBackend::kStateVersion）。须在 start() 之前设置
+    void setCheckpoint(std::shared_ptr<core::CheckpointSection> section) { checkpoint_ = std::move(section); }
+    // 最近一次 start() 是否从检查点恢复了轨迹
+    bool restoredFromCheckpoint() const noexcept { return restored_; }
+    // 当前跟踪 ROI 跟随的轨迹（-1 为无）
+    int roiTrackId() const noexcept { return roiFollowId_; }
+
+    // 最近一次处理的检测结果（供测试/诊断）
+    const DetectionResult& lastDetections() const noexcept { return lastDetections_; }
+    const TrackingResult& lastTracks() const noexcept { return lastTracks_; }
+    // 最近一次的地理投影结果（未设置 GeoProjector 或位姿未同步时 tracks 为空）
+    const GeoTrackingResult& lastGeoTracks() const noexcept { return lastGeoTracks_; }
+    // 最近一次的三维跟踪结果（未设置 Tracker3D 或投影失败时不更新）
+    const Tracking3DResult& lastTracks3D() const noexcept { return lastTracks3d_; }
+    // delta 模式最近一次输出的增量
+    const TrackingDelta& lastDelta() const noexcept { return lastDelta_; }
+    bool deltaOutput() const noexcept { return deltaOutput_; }
+    // 新订阅方加入时调用：下一帧输出关键帧
+    void requestKeyframe() { deltaEncoder_.requestKeyframe(); }
 
 private:
+    void steerRoi(const DetectionResult& dets, const TrackingResult& tracks);
+
+    core::Pad* inPad_{nullptr};
+    core::Pad* outPad_{nullptr};
     TrackerBackendPtr backend_;
+    std::shared_ptr<InferenceRateController> rateController_;
+    std::shared_ptr<GeoProjector> geoProjector_;
+    std::shared_ptr<Tracker3D> tracker3d_;
+    std::shared_ptr<sensors::TrackedRoi> roiController_;
+    int roiTrackId_{-1};   // 配置指定的跟随目标
+    int roiFollowId_{-1};  // 实际跟随的目标
+    bool warnedNoPredict_{false};
     std::uint32_t frameCounter_{0};
+    std::mutex inputMutex_;
+    DetectionResult pending_;
+    bool hasPending_{false};
+    DetectionResult lastDetections_;
+    TrackingResult lastTracks_;
+    GeoTrackingResult lastGeoTracks_;
+    Tracking3DResult lastTracks3d_;
+    bool deltaOutput_{false};
+    std::string uavId_{"uav0"};
+    TrackingDeltaEncoder deltaEncoder_;
+    TrackingDelta lastDelta_;
+    std::vector<std::uint8_t> packetBuffer_;
+    std::shared_ptr<core::CheckpointSection> checkpoint_;
+    bool restored_{false};
 };
 
 } // namespace falconmind::sdk::perception
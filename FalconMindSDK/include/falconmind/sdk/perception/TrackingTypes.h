@@ -3,6 +3,7 @@
 
 #include "falconmind/sdk/perception/DetectionTypes.h"
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -14,13 +15,43 @@ struct TrackHistoryPoint {
     DetectionBBox bbox;
 };
 
+// 轨迹环形缓冲的只读视图，按时间从旧到新访问；存储归跟踪后端所有，下一次 run / predict / unload 前有效
+class TrajectoryView {
+public:
+    TrajectoryView() = default;
+    // ring 为 capacity 个点的环形存储，oldest 为最旧点的下标，count 为有效点数
+    TrajectoryView(const TrackHistoryPoint* ring, std::size_t capacity, std::size_t oldest, std::size_t count)
+        : ring_(ring), capacity_(capacity), oldest_(oldest), size_(count) {}
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    const TrackHistoryPoint& operator[](std::size_t i) const noexcept { return ring_[(oldest_ + i) % capacity_]; }
+    const TrackHistoryPoint& back() const noexcept { return (*this)[size_ - 1]; }
+
+    // 需要跨帧保留时显式拷贝
+    std::vector<TrackHistoryPoint> toVector() const {
+        std::vector<TrackHistoryPoint> out;
+        out.reserve(size_);
+        for (std::size_t i = 0; i < size_; ++i) out.push_back((*this)[i]);
+        return out;
+    }
+
+private:
+    const TrackHistoryPoint* ring_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t oldest_{0};
+    std::size_t size_{0};
+};
+
 // 单个目标的跟踪状态
 struct TrackingState {
     int trackId{-1};
     int targetClassId{-1};
     std::string targetClassName;
-    std::string status; // ACTIVE/LOST/FINISHED 等
-    std::vector<TrackHistoryPoint> trajectory;
+    std::string status; // ACTIVE/PREDICTED/LOST/FINISHED 等
+    float uncertainty{0.f}; // 位置预测不确定度（相对目标尺寸），刚与检测匹配时为 0
+    std::vector<TrackHistoryPoint> trajectory;  // 深拷贝的历史（后端可能只填 history 视图，见各后端说明）
+    TrajectoryView history;                     // 零拷贝历史视图（SortTrackerBackend 提供）
 };
 
 // 跟踪结果（可与 DetectionResult 搭配使用）
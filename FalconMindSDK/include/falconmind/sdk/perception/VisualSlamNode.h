@@ -1,9 +1,15 @@
 // FalconMindSDK - VisualSlamNode 骨架
-// 输入图像，输出位姿；可注入 ISlamServiceClient 对接算法容器 gRPC（如 SLAMService.GetPose）。
+// 输入图像，输出位姿；video_in 收到的帧经共享内存通道（core::ShmChannel，参数 image_shm）转发给算法容器，
+// 与检测分支共享同一份采集缓冲（BufferRef 引用计数），相机只需打开一次。
+// 可注入 ISlamServiceClient 对接算法容器（推荐 StreamingSlamClient 订阅 SLAMService.SubscribePose，
+// 同机部署时可用 pose_shm 参数经共享内存位姿通道读取）。
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/ShmTransport.h"
 #include "falconmind/sdk/perception/PoseTypes.h"
 #include "falconmind/sdk/perception/ISlamServiceClient.h"
 
@@ -14,17 +20,29 @@ public:
     VisualSlamNode();
     bool configure(const std::unordered_map<std::string, std::string>& params) override;
     bool start() override;
+    void stop() override;
     void process() override;
 
     void setSlamServiceClient(SlamServiceClientPtr client) { slamClient_ = std::move(client); }
     /// 无 client 或不可用时是否输出默认位姿（单位阵），默认 true
     void setOutputWhenNoClient(bool v) { outputWhenNoClient_ = v; }
+    /// 图像转发通道（name 为空则不转发）；start 时创建，stop 时删除
+    void setImageChannel(core::ShmChannelConfig config) { imageChannelConfig_ = std::move(config); }
+
+    std::uint64_t forwardedFrames() const noexcept { return forwarded_.load(std::memory_order_relaxed); }
+    // 通道槽位仍被算法容器占用时丢弃的帧数
+    std::uint64_t droppedFrames() const noexcept { return dropped_.load(std::memory_order_relaxed); }
 
 private:
+    core::Pad* outPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
     bool started_{false};
     bool outputWhenNoClient_{true};
     std::uint64_t defaultPoseTimestampNs_{0};
     SlamServiceClientPtr slamClient_;
+    core::ShmChannelConfig imageChannelConfig_;
+    std::shared_ptr<core::ShmChannel> imageChannel_;  // 仅在 start/stop 时替换；写入在投递线程
+    std::atomic<std::uint64_t> forwarded_{0};
+    std::atomic<std::uint64_t> dropped_{0};
 };
 
 } // namespace falconmind::sdk::perception
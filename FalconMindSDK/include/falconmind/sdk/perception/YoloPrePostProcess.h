@@ -1,10 +1,15 @@
 // FalconMindSDK - 通用 YOLO 前处理/后处理，供 ONNXRuntime / RKNN 等检测后端复用
 #pragma once
 
+#include "falconmind/sdk/core/WorkerGroup.h"
 #include "falconmind/sdk/perception/DetectionTypes.h"
+#include "falconmind/sdk/sensors/ImageTransform.h"
 
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace falconmind::sdk::perception {
@@ -19,32 +24,233 @@ struct YoloRawDet {
     int   classId{-1};
 };
 
-/** 将图像 resize 并转为 NCHW float [0,1]，供模型输入 */
+/** 检测阶段计时：disabled 时不读时钟，lapUs() 恒为 0（DetectorDescriptor::profiling 关闭时零开销） */
+class StageTimer {
+public:
+    explicit StageTimer(bool enabled) : enabled_(enabled) {
+        if (enabled_) last_ = std::chrono::steady_clock::now();
+    }
+    // 距构造或上一次 lapUs() 的微秒数，并从此刻重新计时
+    std::uint32_t lapUs() noexcept {
+        if (!enabled_) return 0;
+        const auto now = std::chrono::steady_clock::now();
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(now - last_).count();
+        last_ = now;
+        return static_cast<std::uint32_t>(us);
+    }
+    bool enabled() const noexcept { return enabled_; }
+
+private:
+    bool enabled_;
+    std::chrono::steady_clock::time_point last_{};
+};
+
+/** 将图像拉伸 resize 并转为 NCHW float [0,1]（RGB 通道顺序），供模型输入；单线程，等价于 Stretch 模式的 YoloPreprocessor */
 void resizeImageToFloatNchw(
     const std::uint8_t* src, int srcW, int srcH, int srcStride,
     bool bgr,
     float* dst, int dstW, int dstH);
 
+enum class ResizeMode : std::uint8_t {
+    Stretch,    // 拉伸到模型输入尺寸（宽高比改变）
+    Letterbox,  // 等比缩放后居中，四周填充 padValue（与 Ultralytics 训练时的预处理一致）
+};
+
+/** 模型输入坐标 → 原图坐标：src = (model - pad) / scale */
+struct LetterboxTransform {
+    float scaleX{1.f};
+    float scaleY{1.f};
+    float padX{0.f};
+    float padY{0.f};
+};
+
+LetterboxTransform computeLetterbox(int srcW, int srcH, int dstW, int dstH, ResizeMode mode);
+
+struct YoloPreprocessConfig {
+    ResizeMode mode{ResizeMode::Letterbox};
+    std::uint8_t padValue{114};  // 填充灰度（三通道相同）
+    std::size_t threads{0};      // 行并行线程数；0 为 WorkerGroup::defaultCount()
+    // 非 Cpu 时 run(ImageView…) 先用 2D 硬件把源图缩放到内容区尺寸并转为 RGB8，再做归一化/填充；
+    // 后端不可用或不支持该源格式时使用软件路径
+    sensors::ImageTransformBackendType accel{sensors::ImageTransformBackendType::Cpu};
+};
+
+// 由检测器描述（letterbox / letterbox_pad_value / preprocess_threads / preprocess_accel）得到前处理配置
+YoloPreprocessConfig yoloPreprocessConfig(const DetectorDescriptor& desc);
+
+enum class TensorElementType : std::uint8_t {
+    Float32,  // [0,1]
+    Float16,  // [0,1]，IEEE 754 半精度
+    Uint8,    // [0,255]，量化模型的原始像素输入
+};
+
+enum class TensorLayout : std::uint8_t {
+    NCHW,
+    NHWC,
+};
+
+// 模型输入张量（batch 1，3 通道，RGB 顺序）
+struct InputTensorSpec {
+    int width{0};
+    int height{0};
+    TensorElementType type{TensorElementType::Float32};
+    TensorLayout layout{TensorLayout::NCHW};
+};
+
+std::size_t inputTensorBytes(const InputTensorSpec& spec) noexcept;
+
+/**
+ * 像素 → 模型内部量化值的查表（RKNN pass_through 等需直接提供量化输入的场景）：
+ * q = clamp(round((p − mean) / stdDev / scale) + zeroPoint)；int8Out 时按 int8 位模式存储
+ */
+std::array<std::uint8_t, 256> inputQuantTable(float mean, float stdDev, float scale, int zeroPoint, bool int8Out);
+// data[i] = table[data[i]]
+void applyByteTable(const std::array<std::uint8_t, 256>& table, std::uint8_t* data, std::size_t n) noexcept;
+
+/**
+ * YoloPreprocessor - 相机帧 → 模型输入张量，双线性缩放（半像素中心对齐，同 OpenCV INTER_LINEAR）
+ *
+ * - 源格式 RGB8/BGR8/NV12/YUYV：YUV 源只把被采样的源行逐行转换到线程私有的行缓冲（ColorConvert 内核），
+ *   不生成整帧 RGB 中间图，结果与“先 convertNv12ToRgb/convertYuyvToRgb 再缩放”逐位一致
+ * - 行列坐标与权重按（源尺寸, 目标尺寸, 模式）预计算并缓存，逐像素无除法/floor
+ * - 先水平插值出源行（相邻输出行共享源行时复用），再做纵向混合 + 归一化；纵向内核 AVX2/NEON 向量化，
+ *   fp16 输出用 F16C/NEON 转换
+ * - 输出行按线程切分，在常驻 WorkerGroup 上并行；小图自动退化为单线程
+ * 非线程安全：每个检测后端持有自己的实例
+ */
+class YoloPreprocessor {
+public:
+    YoloPreprocessor() : YoloPreprocessor(YoloPreprocessConfig{}) {}
+    explicit YoloPreprocessor(const YoloPreprocessConfig& config);
+    ~YoloPreprocessor();
+    YoloPreprocessor(const YoloPreprocessor&) = delete;
+    YoloPreprocessor& operator=(const YoloPreprocessor&) = delete;
+
+    /** RGB8/BGR8 → float NCHW：dst 为 3×dstH×dstW；返回把模型输出坐标映射回原图所需的变换 */
+    LetterboxTransform run(const std::uint8_t* src, int srcW, int srcH, int srcStride, bool bgr,
+                           float* dst, int dstW, int dstH);
+
+    /**
+     * 按 image.format（Any 时解析 pixelFormat 字符串）选择源内核，一趟写出 spec 描述的张量。
+     * dst 至少 inputTensorBytes(spec) 字节；格式不支持或参数无效时返回 false
+     */
+    bool run(const ImageView& image, const InputTensorSpec& spec, void* dst, LetterboxTransform& transform);
+
+    // 可直接处理的源格式（按偏好排序：NV12 数据量最小，且为解码器/ISP 原生输出），供后端声明 Caps
+    static std::vector<core::PixelFormat> pixelFormats();
+    static bool supportsPixelFormat(core::PixelFormat format) noexcept;
+
+    const YoloPreprocessConfig& config() const noexcept { return config_; }
+    std::size_t threads() const noexcept;
+    // 实际使用的缩放卸载后端（未配置或不可用时为 Cpu）
+    sensors::ImageTransformBackendType accelerator() const noexcept;
+    // 当前使用的纵向内核："avx512" / "avx2" / "neon" / "scalar"
+    static const char* kernelName() noexcept;
+
+private:
+    struct Tables;
+    struct Scratch;
+    struct Source {
+        const std::uint8_t* data{nullptr};
+        int stride{0};
+        int height{0};
+        core::PixelFormat format{core::PixelFormat::RGB8};
+    };
+
+    LetterboxTransform runTensor(const Source& src, int srcW, const InputTensorSpec& spec, std::uint8_t* dst);
+    void runRows(const Source& src, const InputTensorSpec& spec, std::uint8_t* dst, int dy0, int dy1,
+                 Scratch& scratch);
+
+    YoloPreprocessConfig config_;
+    std::unique_ptr<Tables> tables_;
+    std::vector<std::unique_ptr<Scratch>> scratch_;
+    std::unique_ptr<core::WorkerGroup> workers_;
+    sensors::ImageTransformPtr accel_;
+    std::vector<std::uint8_t> accelImage_;  // 硬件缩放输出（内容区尺寸 RGB8）
+};
+
 /**
  * 解码 YOLO 输出 (1, numChannels, numBoxes)，layout: outputData[c*numBoxes + j]。
  * 假定前 4 维为 cx,cy,w,h，随后 numClasses 维为类别 logits（内部做 sigmoid）。
+ * 等价于 decodeYoloOutput 的无锚框、通道优先、logits 配置（先清空 out）；classes 见 YoloDecodeConfig::classes
  */
 void decodeYoloOutput84xN(
     const float* outputData,
     std::size_t numChannels, std::size_t numBoxes,
     int numClasses, float scoreThr,
-    std::vector<YoloRawDet>& out);
+    std::vector<YoloRawDet>& out,
+    const std::vector<int>& classes = {});
+
+// YOLO 输出头的解码参数
+struct YoloDecodeConfig {
+    int   numClasses{80};
+    float scoreThreshold{0.25f};
+    bool  logits{true};       // 类别 / objectness 为 logits（内部 sigmoid）；false 表示导出时已含 sigmoid
+    bool  objectness{false};  // cx,cy,w,h 之后为 objectness（YOLOv5/v7），score = obj × cls
+    bool  boxMajor{false};    // false：(4+[1]+C, boxes) 通道优先（v8/v11）；true：(boxes, 4+[1]+C)（v5/v7 导出）
+    // 类别掩码（升序、不重复的类别 ID，见 normalizeClassIds）：非空时只读取并输出这些类别行，
+    // 每框取列出类别中的最大值；空为全部 numClasses 类
+    std::vector<int> classes;
+};
+
+/**
+ * 解码无锚框头（v8/v11）或已在图中解码锚框的输出（v5/v7 导出），结果追加到 out。
+ * 在 logit 域与 σ⁻¹(scoreThreshold) 比较，只对过阈值的框计算 sigmoid；通道优先布局下逐类别行单位步长读取，
+ * 跨框向量化求类别最大值（AVX2 / NEON），带 objectness 时先按 objectness 整块跳过
+ */
+void decodeYoloOutput(const float* outputData, std::size_t numChannels, std::size_t numBoxes,
+                      const YoloDecodeConfig& cfg, std::vector<YoloRawDet>& out);
+
+// 未在图中解码的锚框头（YOLOv5/v7 原始输出）：每个 stride 一个 (numAnchors·(5+C), gridH, gridW) 张量
+struct YoloAnchorHead {
+    const float* data{nullptr};
+    int gridW{0};
+    int gridH{0};
+    int stride{8};
+    int numAnchors{3};
+    std::array<float, 8> anchors{};  // 像素单位 w0,h0,w1,h1...，最多 4 个锚框
+};
 
-/** 按类别做 NMS，suppressed[i]==true 表示被抑制 */
+/** 按 xy = (2σ(t) − 0.5 + grid)·stride、wh = (2σ(t))²·anchor 解码一个锚框头，结果追加到 out（cfg.objectness 被忽略，恒带 objectness） */
+void decodeYoloAnchorHead(const YoloAnchorHead& head, const YoloDecodeConfig& cfg, std::vector<YoloRawDet>& out);
+
+/** 按类别做 NMS，suppressed[i]==true 表示被抑制（Hard、不限候选数的 NmsConfig） */
 void nmsYoloDetections(
     const std::vector<YoloRawDet>& raw, float nmsThr,
     std::vector<bool>& suppressed);
 
-/** 将 raw + suppressed 缩放回原图坐标并写入 DetectionResult */
+struct NmsConfig {
+    NmsMethod method{NmsMethod::Hard};
+    float iouThreshold{0.45f};     // Hard：与保留框 IoU 超过此值的框被抑制
+    std::size_t topK{0};           // 先按分数只保留前 topK 个候选（0 不限）
+    std::size_t maxDetections{0};  // 最多保留的框数（0 不限）
+    float sigma{0.5f};             // Soft/Matrix：衰减 exp(-iou²/sigma)
+    float scoreThreshold{0.f};     // Soft/Matrix：衰减后低于此分数的框被抑制
+    bool classAgnostic{false};     // true 时不分类别做 NMS
+};
+
+// 由检测器描述（nms_threshold / nms_method / nms_top_k / max_detections / nms_sigma / score_threshold）得到 NMS 配置
+NmsConfig nmsConfig(const DetectorDescriptor& desc);
+
+/**
+ * 快速 NMS：topK 预选后按类别分桶，桶内按分数降序以 SoA 排布，每个保留框对桶内其后各框批量计算 IoU（AVX2 / NEON），
+ * 比较次数从全体候选的 n² 降为各类别桶内的 n²。Soft/Matrix 把衰减后的分数写回 raw[i].score。
+ * 暂存按线程复用，逐帧不分配（suppressed 容量足够时）
+ */
+void nmsYoloDetections(std::vector<YoloRawDet>& raw, const NmsConfig& cfg, std::vector<bool>& suppressed);
+
+/** 将 raw + suppressed 缩放回原图坐标并写入 DetectionResult::detections（frameIndex/timestampNs 由调用方填写） */
 void fillDetectionResultFromYolo(
     const std::vector<YoloRawDet>& raw,
     const std::vector<bool>& suppressed,
     float scaleX, float scaleY,
     DetectionResult& outResult);
 
+/** 按前处理返回的变换映射回原图坐标，并裁剪到 [0, imageW] × [0, imageH]（完全落在填充区的框被丢弃） */
+void fillDetectionResultFromYolo(
+    const std::vector<YoloRawDet>& raw,
+    const std::vector<bool>& suppressed,
+    const LetterboxTransform& transform, int imageW, int imageH,
+    DetectionResult& outResult);
+
 } // namespace falconmind::sdk::perception
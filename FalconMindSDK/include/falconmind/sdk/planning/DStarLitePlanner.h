@@ -0,0 +1,84 @@
+// FalconMindSDK - 增量栅格路径规划（D* Lite）：地图变化只重新展开受影响的节点
+#pragma once
+
+#include "falconmind/sdk/planning/OccupancyGrid.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace falconmind::sdk::planning {
+
+/**
+ * DStarLitePlanner - 8 邻接栅格上的 D* Lite（Koenig & Likhachev，优化版）
+ *
+ * 从目标向起点反向搜索，起点随飞行移动时只累加 km，不重建；OccupancyGrid 报告的变化单元及其 8 邻域
+ * 重新计算 rhs 后继续 computeShortestPath，只扩展受影响的节点。
+ * 边代价：直行 1、对角 √2（单元为单位），端点阻塞或对角切角经过阻塞单元时为无穷。
+ * 节点状态按单元下标平铺存放（g / rhs 为 float，另有堆位置），开放表为带位置索引的二叉堆，
+ * 支持 O(log n) decrease-key / 删除。规划器引用的栅格须在其生命周期内有效。
+ */
+class DStarLitePlanner {
+public:
+    explicit DStarLitePlanner(const OccupancyGrid& grid);
+
+    // 以新的起点 / 目标重新初始化并求解；无可行路径返回 false
+    bool plan(const GridCell& start, const GridCell& goal);
+    // 起点移动与 / 或地图变化后的增量修复（changed 为 OccupancyGrid 报告的单元下标）
+    bool replan(const GridCell& start, const std::vector<std::uint32_t>& changed);
+
+    bool hasPlan() const noexcept { return initialized_; }
+    const GridCell& goal() const noexcept { return goal_; }
+    const GridCell& start() const noexcept { return start_; }
+    // 起点到目标的代价（单元为单位，无路径为无穷）
+    float pathCost() const noexcept;
+
+    // 从起点沿最小 c + g 的后继走到目标，最多 maxSteps 个单元（含起点与目标）；无路径返回 false
+    bool extractPath(std::vector<GridCell>& path, std::size_t maxSteps = 100000) const;
+
+    // 单次 computeShortestPath 的最大扩展数（防止地图被完全封死时长时间搜索）
+    void setMaxExpansions(std::size_t n) noexcept { maxExpansions_ = n; }
+    // 最近一次 plan / replan 扩展的节点数
+    std::size_t lastExpansions() const noexcept { return lastExpansions_; }
+
+private:
+    struct Key {
+        float k1, k2;
+        bool operator<(const Key& o) const noexcept { return k1 < o.k1 || (k1 == o.k1 && k2 < o.k2); }
+    };
+    struct HeapEntry {
+        Key key;
+        std::uint32_t cell;
+    };
+    static constexpr std::uint32_t kNotInHeap = 0xFFFFFFFFu;
+
+    float heuristic(std::uint32_t a, std::uint32_t b) const noexcept;
+    float cost(std::uint32_t from, int dx, int dy) const noexcept;
+    Key calculateKey(std::uint32_t s) const noexcept;
+    void updateVertex(std::uint32_t u);
+    float bestRhs(std::uint32_t u) const noexcept;
+    bool computeShortestPath();
+
+    // 二叉堆
+    void heapPush(std::uint32_t cell, const Key& key);
+    void heapUpdate(std::uint32_t cell, const Key& key);
+    void heapRemove(std::uint32_t cell);
+    void siftUp(std::size_t i);
+    void siftDown(std::size_t i);
+    void heapSwap(std::size_t a, std::size_t b);
+
+    const OccupancyGrid& grid_;
+    std::vector<float> g_;
+    std::vector<float> rhs_;
+    std::vector<std::uint32_t> heapPos_;
+    std::vector<HeapEntry> heap_;
+
+    GridCell start_{}, goal_{}, last_{};
+    std::uint32_t startIdx_{0}, goalIdx_{0};
+    float km_{0.f};
+    bool initialized_{false};
+    std::size_t maxExpansions_{2000000};
+    std::size_t lastExpansions_{0};
+};
+
+} // namespace falconmind::sdk::planning
@@ -0,0 +1,63 @@
+// FalconMindSDK - 障碍点云入口节点：把雷达点云按当前位姿转换到 ENU 水平坐标，缓存给占据栅格
+#pragma once
+
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/SeqLock.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace falconmind::sdk::planning {
+
+// 传感器位姿：ENU 位置（米，任务局部坐标系）与航向（弧度，自北顺时针）
+struct SensorPose {
+    double east{0.0};
+    double north{0.0};
+    double up{0.0};
+    double yaw{0.0};
+    bool valid{false};
+};
+
+struct ObstacleCloudConfig {
+    float minRange{1.0f};        // 近于此距离的点视为机体自身回波
+    float maxRange{60.0f};
+    float minRelHeight{-3.0f};   // 相对机体高度带（米）：滤掉地面与高空杂点
+    float maxRelHeight{3.0f};
+    std::size_t maxPending{200000};  // 未被取走的缓存点上限，超出丢弃并计数
+};
+
+/**
+ * ObstacleCloudNode
+ *
+ * 输入 Pad pointcloud_in：PointCloudPacket（SoA，机体坐标 x 前 / y 左 / z 上）。
+ * 回调在推送线程中按 SeqLock 中的最新位姿把高度带与距离范围内的点转换为 ENU 水平坐标，
+ * 追加到缓存；行为树线程用 takeObstaclePoints() 交换取走后批量写入 OccupancyGrid。
+ * 位姿由持有栅格的一方（SearchMissionAction）经 setPose() 单线程写入，位姿无效时丢弃整帧。
+ */
+class ObstacleCloudNode : public core::Node {
+public:
+    explicit ObstacleCloudNode(const ObstacleCloudConfig& cfg = {});
+
+    void setPose(const SensorPose& pose) noexcept { pose_.store(pose); }
+    SensorPose pose() const noexcept { return pose_.load(); }
+
+    // 交换取走缓存的障碍点（east / north 被清空后复用其容量）；返回取走的点数
+    std::size_t takeObstaclePoints(std::vector<float>& east, std::vector<float>& north);
+
+    std::uint64_t framesDropped() const noexcept { return framesDropped_.load(std::memory_order_relaxed); }
+    std::uint64_t pointsDropped() const noexcept { return pointsDropped_.load(std::memory_order_relaxed); }
+
+private:
+    void onPointCloud(const void* data, std::size_t size);
+
+    ObstacleCloudConfig cfg_;
+    core::SeqLock<SensorPose> pose_;
+    std::mutex pendingMutex_;
+    std::vector<float> pendingEast_, pendingNorth_;
+    std::atomic<std::uint64_t> framesDropped_{0};
+    std::atomic<std::uint64_t> pointsDropped_{0};
+};
+
+} // namespace falconmind::sdk::planning
@@ -0,0 +1,91 @@
+// FalconMindSDK - 二维占据栅格：障碍点批量入图（可多线程分箱）+ 增量膨胀，输出可通行性发生变化的单元
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace falconmind::sdk::core {
+class WorkerGroup;
+}
+
+namespace falconmind::sdk::planning {
+
+struct GridCell {
+    int x{0};
+    int y{0};
+    bool operator==(const GridCell& o) const noexcept { return x == o.x && y == o.y; }
+    bool operator!=(const GridCell& o) const noexcept { return !(*this == o); }
+};
+
+struct OccupancyGridConfig {
+    double resolution{2.0};     // 单元边长（米）
+    int width{512};
+    int height{512};
+    double originEast{-512.0};  // 单元 (0, 0) 左下角的 ENU 坐标（米）
+    double originNorth{-512.0};
+    double inflationRadius{4.0};  // 障碍膨胀半径（米，含机体半径与安全余量）
+    int hitThreshold{2};          // 单元累计命中点数达到阈值才视为占据（抑制孤立噪点）
+    std::size_t threads{1};       // 入图分箱线程数（0 为 WorkerGroup::defaultCount()）
+};
+
+/**
+ * OccupancyGrid
+ *
+ * 每个单元保存命中计数（uint8，饱和）与膨胀计数（uint16，覆盖该单元的占据单元数）；
+ * 单元首次达到 hitThreshold 时只对其膨胀圆盘内的单元计数加一，计数 0 → 1 的单元即“新阻塞”，
+ * 追加到 changed 交给增量规划器（D* Lite）只修复受影响的节点。clear() 为逆过程。
+ * 网格外视为阻塞。非线程安全：由单一所有者（如任务行为树线程）更新与查询。
+ */
+class OccupancyGrid {
+public:
+    explicit OccupancyGrid(const OccupancyGridConfig& cfg = {});
+    ~OccupancyGrid();
+    OccupancyGrid(const OccupancyGrid&) = delete;
+    OccupancyGrid& operator=(const OccupancyGrid&) = delete;
+
+    const OccupancyGridConfig& config() const noexcept { return cfg_; }
+    int width() const noexcept { return cfg_.width; }
+    int height() const noexcept { return cfg_.height; }
+    std::size_t cellCount() const noexcept { return inflated_.size(); }
+
+    bool inBounds(int x, int y) const noexcept { return x >= 0 && y >= 0 && x < cfg_.width && y < cfg_.height; }
+    std::uint32_t index(int x, int y) const noexcept { return static_cast<std::uint32_t>(y) * cfg_.width + x; }
+    GridCell cellOf(std::uint32_t index) const noexcept {
+        return {static_cast<int>(index % cfg_.width), static_cast<int>(index / cfg_.width)};
+    }
+
+    // ENU 水平坐标所在单元；超出网格返回 false
+    bool toCell(double east, double north, GridCell& cell) const noexcept;
+    void cellCenter(const GridCell& cell, double& east, double& north) const noexcept;
+
+    bool blocked(int x, int y) const noexcept { return !inBounds(x, y) || inflated_[index(x, y)] != 0; }
+    bool occupied(int x, int y) const noexcept {
+        return inBounds(x, y) && hits_[index(x, y)] >= cfg_.hitThreshold;
+    }
+
+    // 批量插入障碍点（ENU 水平坐标），返回可通行性发生变化的单元数；变化单元的下标追加到 changed
+    std::size_t insertObstacles(const float* east, const float* north, std::size_t count,
+                                std::vector<std::uint32_t>& changed);
+    // 清除单元的占据（如动态障碍离开），由阻塞变为可通行的单元追加到 changed
+    std::size_t clear(const GridCell& cell, std::vector<std::uint32_t>& changed);
+
+    // 线段（ENU）经过的单元中是否有阻塞单元
+    bool segmentBlocked(double e0, double n0, double e1, double n1) const noexcept;
+
+    std::size_t occupiedCells() const noexcept { return occupiedCount_; }
+
+private:
+    void occupy(std::uint32_t idx, std::vector<std::uint32_t>& changed);
+
+    OccupancyGridConfig cfg_;
+    std::vector<std::uint8_t> hits_;
+    std::vector<std::uint16_t> inflated_;
+    std::vector<std::int32_t> discDx_, discDy_;  // 膨胀圆盘偏移
+    std::size_t occupiedCount_{0};
+    std::unique_ptr<core::WorkerGroup> workers_;
+    std::vector<std::vector<std::uint32_t>> binned_;  // 每线程分箱结果（逐批复用）
+};
+
+} // namespace falconmind::sdk::planning
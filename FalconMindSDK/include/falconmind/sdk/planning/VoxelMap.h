@@ -0,0 +1,131 @@
+// FalconMindSDK - 三维体素占据地图：空间哈希体素块 + 并行射线插入 + 增量 ESDF（欧氏距离场），滑动窗口限定内存
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::core {
+class WorkerGroup;
+}
+
+namespace falconmind::sdk::planning {
+
+struct VoxelMapConfig {
+    double resolution{0.2};        // 体素边长（米）
+    float maxRange{30.0f};         // 射线长度上限：更远的点只清除射线上的空闲体素，不记命中
+    float minRange{0.5f};          // 近于此距离的点视为机体自身回波
+    float hitLogOdds{0.85f};       // 命中 / 穿过时的对数几率增量
+    float missLogOdds{-0.4f};
+    float minLogOdds{-2.0f};       // 饱和区间：动态障碍离开后数帧内即可清除
+    float maxLogOdds{3.5f};
+    float occupiedLogOdds{0.5f};   // 不低于此值视为占据
+    float maxDistance{2.0f};       // ESDF 截断距离（米）：更远处统一报告 maxDistance
+    double windowRadiusXY{40.0};   // 以机体为中心的滑动窗口（米），窗口外的体素块被回收
+    double windowRadiusZ{15.0};
+    std::size_t maxBlocks{4096};   // 体素块上限（每块 8³ 体素，16 字节 / 体素）；满后新块的更新丢弃并计数
+    std::size_t threads{0};        // 射线投射 / 更新线程数（0 为 WorkerGroup::defaultCount()）
+};
+
+enum class VoxelState : std::uint8_t { Unknown = 0, Free, Occupied };
+
+/**
+ * VoxelMap
+ *
+ * 体素按 8×8×8 分块，块坐标经哈希表映射到块池下标，只为观测到的空间分配内存。
+ * insertPointCloud() 一批点（地图系 ENU：x 东 / y 北 / z 上）分三步：
+ * 1. 按点分片并行三维 DDA 射线投射，各分片输出穿过 / 命中的体素键
+ * 2. 调用线程查找或分配体素块，键换成 (块, 体素) 槽位（射线连续经过同一块时跳过哈希查找）
+ * 3. 按块下标分片并行更新对数几率：每块只由一个分片写，无锁；同一批内命中优先、每个体素至多更新一次
+ * 占据状态变化的体素随后增量更新 ESDF（FIESTA 式）：每个体素记录最近障碍体素的相对偏移，新障碍沿 26 邻域
+ * 向外传播（lower），消失的障碍把以它为最近障碍的体素复位后由边界重新传播（raise）。
+ * distance() / gradient 只需一次哈希查找即由最近障碍偏移给出，O(1)。
+ * 每批插入前按射线原点（机体位置）回收滑动窗口外的块。非线程安全：由单一所有者更新与查询。
+ */
+class VoxelMap {
+public:
+    explicit VoxelMap(const VoxelMapConfig& cfg = {});
+    ~VoxelMap();
+    VoxelMap(const VoxelMap&) = delete;
+    VoxelMap& operator=(const VoxelMap&) = delete;
+
+    const VoxelMapConfig& config() const noexcept { return cfg_; }
+
+    // 一帧点云（地图系坐标，SoA）与其射线原点（传感器位置）；返回占据状态发生变化的体素数
+    std::size_t insertPointCloud(const float* x, const float* y, const float* z, std::size_t count,
+                                 const std::array<double, 3>& origin);
+    // 移动滑动窗口中心并回收窗口外的块（insertPointCloud 以原点自动调用）
+    void setCenter(const std::array<double, 3>& center);
+
+    VoxelState state(double x, double y, double z) const noexcept;
+    // 到最近占据体素中心的距离（米），截断于 maxDistance；未观测的空间报告 maxDistance。
+    // gradient 非空时写入距离增大方向的单位向量（远于截断距离或位于障碍内时为零）
+    float distance(double x, double y, double z, std::array<float, 3>* gradient = nullptr) const noexcept;
+
+    std::size_t blockCount() const noexcept { return blockIndex_.size(); }
+    std::size_t occupiedVoxels() const noexcept { return occupiedCount_; }
+    std::uint64_t evictedBlocks() const noexcept { return evictedBlocks_; }
+    std::uint64_t droppedUpdates() const noexcept { return droppedUpdates_; }
+    std::size_t threads() const noexcept;
+
+private:
+    static constexpr int kBlockBits = 3;
+    static constexpr int kBlockSide = 1 << kBlockBits;
+    static constexpr int kBlockVoxels = kBlockSide * kBlockSide * kBlockSide;
+    static constexpr std::int8_t kNoObstacle = -128;
+
+    struct Voxel {
+        float logOdds{0.f};
+        float distance{0.f};
+        std::int8_t obstacle[3]{kNoObstacle, 0, 0};  // 最近占据体素相对本体素的偏移（体素数）
+        std::uint8_t flags{0};
+        std::uint32_t batch{0};                       // 最近一次更新的批次号：同一批内只更新一次
+    };
+    struct Block {
+        std::array<std::int32_t, 3> coord{};
+        std::array<Voxel, kBlockVoxels> voxels;
+    };
+    using Index3 = std::array<std::int32_t, 3>;
+
+    static std::uint64_t packKey(const Index3& v) noexcept;
+    static Index3 unpackKey(std::uint64_t key) noexcept;
+    Index3 voxelOf(double x, double y, double z) const noexcept;
+    const Voxel* find(const Index3& v) const noexcept;
+    Voxel* find(const Index3& v) noexcept;
+    Index3 coordOf(std::uint32_t slot) const noexcept;
+    bool inWindow(const Index3& blockCoord) const noexcept;
+    std::uint32_t allocateBlock(const Index3& blockCoord);
+    void evictBlock(std::uint32_t block);
+    void castRays(std::size_t shard, const float* x, const float* y, const float* z, std::size_t count,
+                  const std::array<double, 3>& origin, std::size_t shards);
+    void resolveSlots(std::vector<std::uint64_t>& keys, std::vector<std::uint32_t>& slots);
+    void updateEsdf();
+    bool isObstacle(const Index3& v) const noexcept;
+
+    VoxelMapConfig cfg_;
+    std::unique_ptr<core::WorkerGroup> workers_;
+    std::unordered_map<std::uint64_t, std::uint32_t> blockIndex_;  // 块坐标键 → 块池下标
+    std::vector<Block> blocks_;
+    std::vector<std::uint32_t> freeBlocks_;
+    Index3 centerBlock_{};
+    std::int32_t windowBlocksXY_{0}, windowBlocksZ_{0};
+    std::uint32_t batch_{0};
+    std::size_t occupiedCount_{0};
+    std::uint64_t evictedBlocks_{0};
+    std::uint64_t droppedUpdates_{0};
+
+    // 每个分片的射线结果与更新结果（逐批复用）
+    struct Shard {
+        std::vector<std::uint64_t> hitKeys, missKeys;
+        std::vector<std::uint32_t> hitSlots, missSlots;
+        std::vector<std::uint32_t> becameOccupied, becameFree;
+    };
+    std::vector<Shard> shards_;
+    std::vector<std::uint32_t> newBlocks_;
+    std::vector<Index3> insertQueue_, deleteQueue_;  // ESDF 传播队列（逐批复用）
+};
+
+} // namespace falconmind::sdk::planning
@@ -12,6 +12,8 @@ struct CameraFramePacket {
     int32_t  height{0};
     int32_t  stride{0};   // 每行字节数，≥ width*bytesPerPixel
     char     format[16];  // "RGB8"/"BGR8"/"YUYV" 等，以 \0 结尾
+    int64_t  captureTimestampNs{0};  // 采集时间戳（PipelineClock 时基，优先取驱动时间戳；0 表示未知）
+    uint64_t frameIndex{0};          // 采集节点内单调递增帧序号
 };
 
 /** 整个包大小 = sizeof(CameraFramePacket) + 像素字节数 */
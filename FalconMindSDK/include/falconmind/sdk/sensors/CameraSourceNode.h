@@ -2,29 +2,140 @@
 #pragma once
 
 #include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/NodeParams.h"
 #include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/BufferPool.h"
+#include "falconmind/sdk/core/Caps.h"
+#include "falconmind/sdk/core/CaptureFile.h"
+#include "falconmind/sdk/core/MemoryBudget.h"
+#include "falconmind/sdk/core/RateControl.h"
+#include "falconmind/sdk/core/SharedSource.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+#include "falconmind/sdk/sensors/JpegDecoder.h"
+#include "falconmind/sdk/sensors/StreamIngest.h"
+#include "falconmind/sdk/sensors/TrackedRoi.h"
 #include "falconmind/sdk/sensors/VideoSourceConfig.h"
 
+#include <atomic>
 #include <cstdint>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace falconmind::sdk::sensors {
 
 // Linux 下可选用 V4L2 真实采集；uri 为 "file:/path" 时从原始 RGB 文件按帧读取；否则为骨架（不推帧）。
-class CameraSourceNode : public core::Node {
+// 文件为捕获文件（CaptureRecorderNode / Pipeline::tapToFile 录制的 video_out）时按记录循环回放，
+// 格式与输出一致的帧直接推送 mmap 内的数据（零拷贝），宽高取自录制的帧头。
+// video_out 声明可输出的格式（RGB8/BGR8/NV12/YUYV，受 pixel_format 参数限制）；start() 时按 link 协商结果
+// 请求设备原生输出该格式，设备不支持时在采集线程转换一次。
+// 下游 AdaptSourceRate 连接请求降速时，优先通过 VIDIOC_S_PARM 降低设备帧间隔（省 USB 带宽）；
+// 驱动不支持运行中修改时在出队后、格式转换前丢帧（省转换 CPU）。
+// zero_copy=true 且设备原生输出协商格式时，直接把出队的 V4L2 缓冲作为帧推送（帧头写在映射前的保留页中，
+// 不拷贝像素；BufferMeta::dmabufFd 为 VIDIOC_EXPBUF 导出的 DMABUF，可由 RGA/NPU 直接导入），
+// 下游释放最后一个引用时才 QBUF 归还驱动；在途缓冲只剩最后一个时退回拷贝，保证驱动始终有缓冲可填。
+// V4L2 默认由节点自有的采集线程以 poll() 等待设备就绪并在帧到达时立即推送（process() 不再阻塞调度线程，
+// 下游某次处理耗时较长也不会丢失采集节拍）；参数 buffers 设置驱动缓冲数，capture_thread=false 恢复
+// 在 process() 中阻塞 DQBUF。采集线程遵循节点 placement（CPU 亲和/实时优先级）。
+// sourceType 为 RtspStream/UdpStream 或 uri 为 rtsp:// udp:// 等网络地址时经 StreamIngest 取流：decoder 选择
+// RK_HW（MPP）/NVDEC/SW_FFMPEG，解码输出的 NV12 帧直接写入帧缓冲池并原样推送（协商为 RGB8/BGR8 时转换一次）；
+// 帧经 jitter_ms 抖动缓冲按流时间戳匀速推送，low_latency=true 时解码完成立即推送。参数 transport 为 RTSP 传输方式。
+// 多个 Flow 同时使用同一 device / uri 且尺寸、帧率相同时可经 SharedSourceRegistry 共享（只打开一次设备）。
+// roi_width/roi_height 非 0 时为跟踪 ROI 模式：video_out 只输出该尺寸的窗口，位置由 setRoiController() 的 TrackedRoi
+// 按跟踪预测逐帧给出（未设置时居中，即固定数字变焦），检测耗时随 ROI 尺寸而非传感器分辨率增长。V4L2 设备支持
+// VIDIOC_S_SELECTION 裁剪时由传感器/ISP 直接输出窗口（运行中移动窗口，出队时记录生效的位置）；否则在帧缓冲池的
+// 整帧上生成子视图：帧头写在窗口首像素之前、沿用整帧行宽，不拷贝像素（NV12 或无法对齐时拷贝窗口）。
+// 窗口在源图中的位置写入 BufferMeta::region，DetectionNode 据此把检测框换算回全幅坐标。
+// USB 相机的高分辨率通常只以 MJPEG 提供：mjpeg=auto 时原始格式达不到请求尺寸即改用 MJPEG 采集（prefer 总是优先，
+// off 不使用）。压缩帧由采集线程拷贝后立即归还驱动，在 MjpegDecodeStage 的解码线程中用 jpeg_decoder 选择的
+// MPP / NVJPEG / libjpeg-turbo 解码器直接解码到帧缓冲池的帧（MPP 输出 NV12，其余输出 RGB8/BGR8，与协商格式
+// 不同时再转换一次）；解码慢于采集时只解码最新一帧。没有可用的解码器时不使用 MJPEG。
+
+class CameraSourceNode : public core::Node,
+                         public core::RateAdaptable,
+                         public core::MemoryBudgetSink,
+                         public core::SharableSource {
 public:
     explicit CameraSourceNode(const VideoSourceConfig& cfg);
 
+    // 模板 camera_source 的参数声明（未给出的字段保持构造时的 VideoSourceConfig）
+    static const core::ParamSchema& paramSchema();
     bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool applyParams(const core::NodeParams& params) override;
     bool start() override;
     void stop() override;
+    // Playing -> Paused：采集线程停止推帧（返回时不再有帧在推送中），保持取流与 mmap 缓冲
+    void pause() override;
+    // Paused -> Playing：保持取流与 mmap 缓冲，下一帧前先丢弃暂停期间驱动积压的旧帧
+    void resume() override;
     void process() override;
 
+    // "camera:<uri 或 device>@<宽>x<高>@<fps>"；无设备（测试图案）时为空
+    std::string deviceKey() const override;
+
+    // start() 后实际输出的像素格式
+    core::PixelFormat outputFormat() const noexcept { return outputFormat_; }
+
+    // 帧缓冲池统计（复用/新分配次数、在途帧数）
+    core::BufferPoolStats framePoolStats() const { return framePool_.stats(); }
+
+    void requestMaxFrameRate(const std::string& requester, double fps) override;
+    // 当前生效的帧率上限（0 为不限）
+    double frameRateLimit() const noexcept { return rateLimitFps_.load(std::memory_order_relaxed); }
+    // 因帧率上限在转换前丢弃的帧数（设备级降速生效时为 0）
+    std::uint64_t rateLimitedFrames() const noexcept { return rateLimitedFrames_.load(std::memory_order_relaxed); }
+    // 驱动实际分配的 V4L2 缓冲数（未使用 V4L2 时为 0）
+    unsigned v4l2BufferCount() const noexcept;
+
+    // 帧缓冲池上限 + V4L2 缓冲数（使用设备时）各一帧；降分辨率仅对 V4L2 / 测试图案生效，文件与网络流尺寸由来源决定
+    std::size_t estimateMemoryBytes() const override;
+    bool degradeMemory(core::MemoryDegradation step) override;
+    // 零拷贝推送的帧数 / 零拷贝模式下因在途缓冲不足退回拷贝的帧数
+    std::uint64_t zeroCopyFrames() const noexcept { return zeroCopyFrames_.load(std::memory_order_relaxed); }
+    std::uint64_t zeroCopyFallbacks() const noexcept { return zeroCopyFallbacks_.load(std::memory_order_relaxed); }
+    // 跟踪 ROI 窗口位置来源（start() 前设置；可与 TrackingTransformNode::setRoiController 共用同一实例）
+    void setRoiController(std::shared_ptr<TrackedRoi> roi) { roi_ = std::move(roi); }
+    const std::shared_ptr<TrackedRoi>& roiController() const noexcept { return roi_; }
+    // ROI 窗口由设备裁剪输出（VIDIOC_S_SELECTION）
+    bool sensorCropActive() const noexcept { return sensorCrop_; }
+    // 软件裁剪时拷贝窗口（而非子视图）的帧数
+    std::uint64_t roiCopiedFrames() const noexcept { return roiCopiedFrames_.load(std::memory_order_relaxed); }
+    // V4L2 以 MJPEG 采集时为 true；解码器类型、解码帧数、因解码积压被覆盖的帧数、损坏/解码失败的帧数
+    bool mjpegCapture() const noexcept { return mjpeg_; }
+    JpegDecoderType jpegDecoderType() const noexcept {
+        return jpegDecoder_ ? jpegDecoder_->type() : JpegDecoderType::Auto;
+    }
+    std::uint64_t mjpegDecodedFrames() const noexcept { return mjpegDecoded_.load(std::memory_order_relaxed); }
+    std::uint64_t mjpegDroppedFrames() const noexcept { return mjpegStage_.droppedFrames(); }
+    std::uint64_t mjpegDecodeErrors() const noexcept { return mjpegErrors_.load(std::memory_order_relaxed); }
+    // 网络流模式是否在运行、实际使用的解码器与取流统计（非网络流模式下为默认值）
+    bool streaming() const noexcept { return stream_ != nullptr; }
+    StreamDecoder streamDecoder() const noexcept;
+    StreamIngestStats streamStats() const;
+
 private:
+    core::Pad* outPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
     bool initFileMode();
+    void updateCaps();
+    core::PixelFormat requestedFormat() const;
+    // 按 outputFormat_ 填写帧头；stride 为 0 时按紧凑排列计算
+    void setOutputHeader(int32_t width, int32_t height, int32_t stride);
+    // 从帧缓冲池取一块可写帧缓冲（key 为当前输出宽高与格式），头部按 frameHeader_ 填好
+    std::uint8_t* acquireFrame();
+    // captureNs：采集时间戳（PipelineClock 时基）；写入帧头与缓冲元数据
+    void pushFrame(std::int64_t captureNs);
     void shutdownFileMode();
+    // 捕获文件模式：推送下一条记录（到末尾后从头循环）
+    void pushCaptureRecord();
+    bool streamSource() const;
+    bool initStreamMode();
+    // 取流/输出线程回调：推送一帧解码得到的 NV12 帧（captureNs 为映射到本地的流时间戳）
+    void onStreamFrame(core::BufferRef frame, std::int64_t captureNs);
 
     VideoSourceConfig config_;
     bool started_{false};
@@ -35,17 +146,85 @@ private:
     unsigned fileWidth_{640};
     unsigned fileHeight_{480};
     size_t fileFrameBytes_{0};
+    std::shared_ptr<core::CaptureReader> fileReader_;  // 非空表示捕获文件模式
+    std::size_t fileRecord_{0};
+    std::unique_ptr<StreamIngest> stream_;  // 非空表示网络流模式
     int v4l2Fd_{-1};
-    std::vector<std::uint8_t> frameBuffer_;  // CameraFramePacket + RGB 像素，用于 pushToConnections
-    std::vector<void*> v4l2MapPtrs_;
-    std::vector<size_t> v4l2MapLens_;
-    unsigned v4l2NumBuffers_{0};
+    core::PixelFormat negotiatedFormat_{core::PixelFormat::Any};  // link 协商结果
+    core::PixelFormat captureFormat_{core::PixelFormat::RGB8};    // 设备/文件提供的格式
+    core::PixelFormat outputFormat_{core::PixelFormat::RGB8};     // 推送到下游的格式
+    std::vector<std::uint8_t> fileScratch_;  // 文件模式需转换时的读缓冲
+    CameraFramePacket frameHeader_{};  // 当前输出格式（每帧复制到缓冲头部）
+    size_t framePixelBytes_{0};
+    core::BufferPool framePool_;       // 下游释放最后一个引用后帧缓冲自动归还
+    core::BufferRef frame_;            // 正在填充的帧（CameraFramePacket + 像素），pushBuffer 后即释放
+    std::uint64_t frameIndex_{0};
+    // V4L2 fd 与映射缓冲；零拷贝帧各自持有一份引用，节点 stop 后待下游全部释放才关闭设备
+    struct V4L2Buffers;
+    std::shared_ptr<V4L2Buffers> v4l2Buffers_;
     int v4l2Width_{0};
     int v4l2Height_{0};
     int v4l2Stride_{0};
 
     bool initV4L2();
     void shutdownV4L2();
+    // 出队并立即归还所有已就绪的帧（不阻塞）
+    void flushV4L2Queue();
+    // 处理帧率上限变化与 resume 后的丢帧请求；返回是否需要先清空驱动队列
+    bool applyPendingControls();
+    // 按 roi_ 设置设备裁剪窗口并把输出格式改为窗口尺寸；驱动不支持时恢复整帧并返回 false
+    bool initSensorCrop(int sourceWidth, int sourceHeight);
+    // 设备裁剪：把窗口移到 targetNs 时刻的预测位置
+    void moveSensorCrop(std::int64_t targetNs);
+    // 软件裁剪：把 frame_（frameHeader_ 描述的整帧）替换为 ROI 窗口（子视图或拷贝）
+    bool cropToRoi(std::int64_t captureNs, core::FrameRegion& region);
+    // 按 jpeg_decoder 创建解码器并把设备格式设为 width×height 的 MJPEG；解码器不可用或设备不支持时返回 false
+    bool initMjpegCapture(int width, int height);
+    // 解码线程：把一帧 MJPEG 解码到帧缓冲池的帧并推送
+    void decodeMjpegFrame(const std::uint8_t* jpeg, std::size_t size, std::int64_t captureNs);
+    // 出队一帧并推送（无就绪帧时立即返回，阻塞模式下等待下一帧）
+    void captureV4L2Frame(bool flush);
+    bool startCaptureThread();
+    void stopCaptureThread();
+    void captureLoop();
+    // 零拷贝：把已出队的缓冲 index 包装为帧（frame_）；在途缓冲过多时返回 false，由调用方拷贝
+    bool wrapV4L2Frame(unsigned index, std::size_t bytesUsed);
+    // 采集线程：按最新上限调整设备帧间隔（失败时改为软件限速）
+    void applyRateLimit(double limit);
+    // 软件限速：captureNs 时刻的帧是否应丢弃
+    bool rateLimited(std::int64_t captureNs);
+
+    std::mutex rateMutex_;
+    std::unordered_map<std::string, double> rateRequests_;  // 各连接请求的上限
+    std::atomic<double> rateLimitFps_{0.0};
+    double appliedRateFps_{0.0};   // 采集线程最近一次处理的上限
+    bool deviceRateLimit_{false};  // 上限已由设备帧间隔实现
+    std::int64_t nextFrameDueNs_{0};
+    std::atomic<std::uint64_t> rateLimitedFrames_{0};
+    std::atomic<bool> flushPending_{false};  // resume() 置位，采集线程处理
+    std::thread captureThread_;
+    std::mutex captureMutex_;                // 采集线程推帧期间持有；pause() 借此等待在途帧推送完
+    std::atomic<bool> captureRunning_{false};
+    std::atomic<bool> capturePaused_{false};
+    int wakeFd_{-1};                         // eventfd：唤醒 poll 中的采集线程（停止/暂停/恢复）
+    std::atomic<std::uint64_t> zeroCopyFrames_{0};
+    std::atomic<std::uint64_t> zeroCopyFallbacks_{0};
+
+    std::shared_ptr<TrackedRoi> roi_;
+    bool roiActive_{false};                  // start() 时按 roi_width/roi_height 确定
+    bool sensorCrop_{false};
+    bool sensorCropMovable_{true};           // 驱动拒绝运行中移动窗口后不再尝试
+    ImageRect sensorCropRect_;               // 设备当前裁剪窗口
+    core::FrameRegion sensorRegion_;         // 正在推送的帧出队时生效的窗口
+    std::atomic<std::uint64_t> roiCopiedFrames_{0};
+
+    bool mjpeg_{false};                      // V4L2 设备输出 MJPEG（captureFormat_ 为解码器原生输出格式）
+    JpegDecoderPtr jpegDecoder_;             // 仅解码线程使用
+    std::vector<std::uint8_t> mjpegScratch_;  // 解码器不能直接输出协商格式时的中间帧
+    std::mutex mjpegMutex_;                  // 解码线程推帧期间持有；pause() 借此等待
+    MjpegDecodeStage mjpegStage_;
+    std::atomic<std::uint64_t> mjpegDecoded_{0};
+    std::atomic<std::uint64_t> mjpegErrors_{0};
 };
 
 } // namespace falconmind::sdk::sensors
@@ -0,0 +1,42 @@
+// FalconMindSDK - YUV→RGB 颜色转换内核（NEON / AVX2 / SSE4.1 / 标量，运行时按 CPU 选择）
+#pragma once
+
+#include <cstdint>
+
+namespace falconmind::sdk::sensors {
+
+/**
+ * 转换内核。所有内核使用同一套 BT.601 Q7 定点系数，输出逐字节一致（可用标量结果校验向量实现）：
+ *   R = Y + (179·(V-128) >> 7)
+ *   G = Y - ((44·(U-128) + 91·(V-128)) >> 7)
+ *   B = Y + (227·(U-128) >> 7)
+ */
+enum class ColorKernel : std::uint8_t {
+    Scalar,
+    Sse41,  // x86：SSE4.1（含 SSSE3 pshufb）
+    Avx2,   // x86：AVX2
+    Neon,   // arm64：NEON（基线指令集，总是可用）
+};
+
+const char* colorKernelName(ColorKernel kernel) noexcept;
+// 当前 CPU/编译目标是否支持该内核
+bool colorKernelSupported(ColorKernel kernel) noexcept;
+// 当前使用的内核；首次调用时选择 CPU 支持的最快内核
+ColorKernel activeColorKernel() noexcept;
+// 强制使用指定内核（基准测试/排查用）；不支持时返回 false 且不改变当前内核
+bool setColorKernel(ColorKernel kernel) noexcept;
+
+// YUYV（Y0 U Y1 V，每两个像素共享一组 UV）→ 紧凑 RGB8/BGR8；奇数宽度的末像素使用其所在像素对的 UV
+void convertYuyvToRgb(const std::uint8_t* src, std::int32_t srcStride, std::uint8_t* dst,
+                      std::int32_t width, std::int32_t height, bool bgr);
+// NV12（Y 平面 + 交错 UV 平面，行宽均为 srcStride，UV 平面紧随 Y 平面）→ 紧凑 RGB8/BGR8
+void convertNv12ToRgb(const std::uint8_t* src, std::int32_t srcStride, std::uint8_t* dst,
+                      std::int32_t width, std::int32_t height, bool bgr);
+
+// 单行转换（融合前处理按需逐行转换，不经过整帧 RGB 缓冲）；与整帧接口使用同一内核，结果逐字节一致
+void convertYuyvRowToRgb(const std::uint8_t* src, std::uint8_t* dst, std::int32_t width, bool bgr);
+// uvRow 为该行所属的交错 UV 行（NV12 中为第 y/2 行）
+void convertNv12RowToRgb(const std::uint8_t* yRow, const std::uint8_t* uvRow, std::uint8_t* dst,
+                         std::int32_t width, bool bgr);
+
+} // namespace falconmind::sdk::sensors
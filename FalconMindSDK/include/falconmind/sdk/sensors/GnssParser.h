@@ -0,0 +1,72 @@
+// FalconMindSDK - GNSS 流式解析：NMEA（GGA/RMC/GSA/VTG）与 u-blox UBX（NAV-PVT），逐字节、无分配
+#pragma once
+
+#include "falconmind/sdk/sensors/SensorTypes.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace falconmind::sdk::sensors {
+
+struct GnssParserStats {
+    std::uint64_t nmeaSentences{0};    // 校验通过的 NMEA 语句（含未使用的类型）
+    std::uint64_t ubxMessages{0};      // 校验通过的 UBX 消息（含未使用的类型）
+    std::uint64_t checksumErrors{0};   // NMEA 或 UBX 校验失败
+    std::uint64_t malformed{0};        // 超长、缺少校验和或字段无法解析
+    std::uint64_t fixes{0};
+};
+
+/**
+ * GnssParser - 从串口/文件字节流中解析定位
+ *
+ * - 状态机逐字节推进，语句/消息暂存在固定大小的内部缓冲，字段原地切分、数值就地解析，不分配内存
+ * - NMEA 支持任意 talker（GP/GN/GL/GA/BD...），校验和必须存在且正确。GSA/VTG/RMC 的字段并入
+ *   当前定位，GGA 到达时输出一帧（从未收到 GGA 时由 RMC 输出）
+ * - UBX NAV-PVT 自身即完整定位，到达即输出（NAV-PVT 不含 HDOP/VDOP，取最近一次 NAV-DOP）；
+ *   接收机同时输出 NMEA 与 UBX 时每个历元会得到两帧，建议只开启其一
+ * - 输出帧的 timestampNs 为 feed 传入的接收时刻
+ * 非线程安全：由单一读取线程调用
+ */
+class GnssParser {
+public:
+    // 消费 data 直到完成一帧定位（含）或耗尽；返回已消费字节数，完成时 fixReady() 为 true
+    std::size_t feed(const std::uint8_t* data, std::size_t size, std::uint64_t arrivalNs);
+    bool fixReady() const noexcept { return fixReady_; }
+    // 取走最近完成的定位（fixReady 复位）
+    const GnssSample& takeFix() noexcept {
+        fixReady_ = false;
+        return output_;
+    }
+    // 丢弃未完成的语句与已并入的字段（换源、回放循环）；统计保留
+    void reset() noexcept;
+
+    const GnssParserStats& stats() const noexcept { return stats_; }
+
+    static constexpr std::size_t kMaxNmeaLength = 96;   // 标准上限 82，NMEA 4.1 扩展字段留余量
+    static constexpr std::size_t kMaxUbxPayload = 512;  // 更长的 UBX 消息只做跳过
+
+private:
+    enum class State : std::uint8_t { Idle, Nmea, UbxSync, UbxHeader, UbxPayload, UbxSkip };
+
+    void handleNmea(std::uint64_t arrivalNs);
+    void handleUbx(std::uint64_t arrivalNs);
+    void emit(const GnssSample& fix, std::uint64_t arrivalNs);
+
+    State state_{State::Idle};
+    std::array<char, kMaxNmeaLength> nmea_{};
+    std::size_t nmeaLength_{0};
+    std::array<std::uint8_t, 4 + kMaxUbxPayload + 2> ubx_{};  // class id len(2) payload ck_a ck_b
+    std::size_t ubxLength_{0};
+    std::size_t ubxExpected_{0};  // UbxPayload：帧总长；UbxSkip：剩余待跳过字节
+    bool ggaSeen_{false};
+    std::int64_t utcDay_{-1};     // RMC 给出的 UTC 日期（纪元起天数），GGA 据此补全 utcTimeNs
+    float ubxHdop_{99.f};
+    float ubxVdop_{99.f};
+    GnssSample current_;  // NMEA 各语句逐步并入的当前定位
+    GnssSample output_;
+    bool fixReady_{false};
+    GnssParserStats stats_;
+};
+
+} // namespace falconmind::sdk::sensors
@@ -1,20 +1,36 @@
-// FalconMindSDK - GNSS 数据源：支持 NMEA 文件回放与模拟固定点
+// FalconMindSDK - GNSS 数据源：串口直读（NMEA/UBX）、录制文件回放与模拟固定点
 #pragma once
 
 #include <cstdint>
-#include <fstream>
+#include <vector>
 
 #include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/TimeSync.h"
+#include "falconmind/sdk/sensors/GnssParser.h"
 #include "falconmind/sdk/sensors/SensorTypes.h"
 #include <string>
 
 namespace falconmind::sdk::sensors {
 
+/**
+ * GnssSourceNode - 输出 GnssSample（gnss_out）
+ *
+ * 参数：
+ * - uri / device: "sim"（缺省）、串口设备（/dev/ttyACM0 等）或录制的原始字节流文件（NMEA 文本、UBX 或混合）
+ * - baud: 串口波特率，默认 115200（RTK 10~25 Hz NAV-PVT 建议 230400 以上）
+ * - time_sync: 串口定位的时间戳来源。sensor（默认）：定位 UTC 时刻经 TimeSyncService 映射到 PipelineClock；
+ *   arrival：读出时刻。回放与模拟始终按读出时刻
+ *
+ * 串口以原始非阻塞模式打开，process() 读空内核缓冲并推送其中的全部定位；
+ * 文件回放每次 process() 推送一帧，到达末尾后从头循环。
+ */
 class GnssSourceNode : public core::Node {
 public:
     GnssSourceNode();
+    ~GnssSourceNode() override;
     bool configure(const std::unordered_map<std::string, std::string>& params) override;
     bool start() override;
+    void stop() override;
     void process() override;
 
     /// 模拟模式下的固定位置（度）、高度(m)
@@ -22,15 +38,27 @@ public:
         simLat_ = lat; simLon_ = lon; simAlt_ = alt;
     }
 
+    const GnssParserStats& parserStats() const noexcept { return parser_.stats(); }
+
 private:
-    bool parseNmeaGga(const std::string& line, GnssSample& out);
+    enum class Mode { Sim, Serial, Replay };
+
+    core::Pad* outPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
+    bool openSerial();
+    void closeSource();
     void pushGnss(const GnssSample& s);
 
     std::string deviceOrUri_;
+    int baud_{115200};
+    bool sensorTimeSync_{true};
+    core::ClockSyncPtr clock_;
     bool started_{false};
-    std::ifstream nmeaFile_;
-    std::string nmeaLineBuffer_;
-    bool replayMode_{false};
+    Mode mode_{Mode::Sim};
+    int fd_{-1};
+    GnssParser parser_;
+    std::vector<std::uint8_t> readBuffer_;
+    std::size_t readPos_{0};   // 回放：readBuffer_ 中尚未送入解析器的位置
+    std::size_t readSize_{0};
     double simLat_{39.9042}, simLon_{116.4074}, simAlt_{50.0};
     std::uint64_t simTimestampNs_{0};
 };
@@ -0,0 +1,154 @@
+// FalconMindSDK - 2D 图像变换（裁剪 / 旋转 / 缩放 / 颜色转换）：RGA（Rockchip）、VPI（Jetson）、CPU 回退
+#pragma once
+
+#include "falconmind/sdk/core/Caps.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::sensors {
+
+enum class ImageTransformBackendType : std::uint8_t {
+    Auto = 0,  // 按 RGA → VPI → CPU 选择可用的后端
+    Cpu,
+    Rga,       // Rockchip RGA（librga im2d），可直接导入 DMABUF
+    Vpi,       // NVIDIA VPI（Jetson VIC/CUDA）
+};
+
+const char* imageTransformBackendName(ImageTransformBackendType type) noexcept;
+// "auto"/"cpu"/"rga"/"vpi"（大小写不敏感）；无法识别返回 false
+bool parseImageTransformBackend(const std::string& name, ImageTransformBackendType& out);
+
+// 顺时针旋转
+enum class ImageRotation : std::uint8_t { None = 0, Rot90, Rot180, Rot270 };
+
+struct ImageRect {
+    int x{0};
+    int y{0};
+    int width{0};   // 0 表示到源图右边缘
+    int height{0};  // 0 表示到源图下边缘
+};
+
+// 源图像（只读）。NV12 的 UV 平面紧随 Y 平面（行宽同 stride）
+struct ImageSurface {
+    const std::uint8_t* data{nullptr};
+    int width{0};
+    int height{0};
+    int stride{0};     // 0 为紧凑排列
+    core::PixelFormat format{core::PixelFormat::Any};
+    int dmabufFd{-1};  // 像素所在 DMABUF（来自 BufferMeta::dmabufFd），RGA 直接导入，免 CPU 访问
+};
+
+// 目标图像：尺寸与格式即变换的输出尺寸与格式
+struct WritableImageSurface {
+    std::uint8_t* data{nullptr};
+    int width{0};
+    int height{0};
+    int stride{0};
+    core::PixelFormat format{core::PixelFormat::Any};
+    int dmabufFd{-1};
+};
+
+struct ImageTransformOp {
+    ImageRect crop;                          // 源图裁剪区域（默认整图）
+    ImageRotation rotation{ImageRotation::None};
+};
+
+/**
+ * IImageTransform - 单趟完成 裁剪 → 旋转 → 缩放到目标尺寸 → 转换为目标格式
+ *
+ * 源格式 RGB8/BGR8/NV12/YUYV，目标格式 RGB8/BGR8/NV12（硬件后端另见 supports()）；缩放为双线性。
+ * NV12/YUYV 源的裁剪起点向下取偶数，与色度采样对齐。非线程安全：每个使用方持有自己的实例。
+ */
+class IImageTransform {
+public:
+    virtual ~IImageTransform() = default;
+
+    virtual ImageTransformBackendType type() const noexcept = 0;
+    const char* name() const noexcept { return imageTransformBackendName(type()); }
+
+    virtual bool supports(core::PixelFormat from, core::PixelFormat to, ImageRotation rotation) const noexcept = 0;
+    // 参数无效、组合不支持或硬件执行失败时返回 false（调用方可改用 CPU 后端）
+    virtual bool transform(const ImageSurface& src, const ImageTransformOp& op, WritableImageSurface& dst) = 0;
+};
+
+using ImageTransformPtr = std::unique_ptr<IImageTransform>;
+
+// 当前构建 / 设备上后端是否可用（RGA / VPI 需以对应选项编译并能打开设备）
+bool imageTransformAvailable(ImageTransformBackendType type);
+// 创建后端；Auto 总是成功（至少为 CPU），指定的后端不可用时返回 nullptr
+ImageTransformPtr createImageTransform(ImageTransformBackendType type);
+
+/**
+ * BilinearColumns - 三通道 8 位图双线性缩放的列映射：半像素中心对齐，11 位定点权重
+ * CpuImageTransform 与像素阶段融合（PixelFusion）共用同一套映射与行内核，两者输出逐字节一致
+ */
+struct BilinearColumns {
+    std::vector<std::int32_t> offset;  // 每个目标列左 / 右源像素的字节偏移（2 项）
+    std::vector<std::int16_t> weight;  // 每个目标列右侧源像素的权重
+
+    void build(int srcWidth, int dstWidth);
+};
+
+// 目标第 y 行取源行 row0 / row1（越界钳制到边缘）与 row1 的权重
+void bilinearSourceRows(int y, int srcHeight, int dstHeight, int& row0, int& row1, int& weight) noexcept;
+// 由两行源像素插值出一行目标像素（宽度为 cols 的目标列数）
+void bilinearResizeRow(const std::uint8_t* row0, const std::uint8_t* row1, int weight, const BilinearColumns& cols,
+                       std::uint8_t* out) noexcept;
+
+/**
+ * CpuImageTransform - CPU 实现：YUV 源用 ColorConvert 向量内核逐行转为 RGB，
+ * 缩放为 11 位定点双线性（半像素中心对齐），内层循环可被编译器向量化
+ */
+class CpuImageTransform : public IImageTransform {
+public:
+    ImageTransformBackendType type() const noexcept override { return ImageTransformBackendType::Cpu; }
+    bool supports(core::PixelFormat from, core::PixelFormat to, ImageRotation rotation) const noexcept override;
+    bool transform(const ImageSurface& src, const ImageTransformOp& op, WritableImageSurface& dst) override;
+
+private:
+    std::vector<std::uint8_t> rgb_;      // 裁剪区域转换后的 RGB
+    std::vector<std::uint8_t> rotated_;  // 旋转后的 RGB
+    std::vector<std::uint8_t> resized_;  // 目标为 NV12 / BGR 时的缩放结果
+    BilinearColumns columns_;
+};
+
+/**
+ * RgaImageTransform - Rockchip RGA2/RGA3 硬件实现（improcess 一次提交裁剪、旋转、缩放与颜色转换）。
+ * 源 / 目标带 dmabufFd 时以 fd 导入，否则包装虚拟地址。未以 FALCONMINDSDK_BUILD_RGA 编译时 transform() 返回 false
+ */
+class RgaImageTransform : public IImageTransform {
+public:
+    RgaImageTransform();
+    ~RgaImageTransform() override;
+
+    ImageTransformBackendType type() const noexcept override { return ImageTransformBackendType::Rga; }
+    bool supports(core::PixelFormat from, core::PixelFormat to, ImageRotation rotation) const noexcept override;
+    bool transform(const ImageSurface& src, const ImageTransformOp& op, WritableImageSurface& dst) override;
+
+    static bool available();
+};
+
+/**
+ * VpiImageTransform - NVIDIA VPI 实现（Jetson）：包装主机内存，VIC 缩放 + CUDA 颜色转换。
+ * 不支持旋转与 YUYV；未以 FALCONMINDSDK_BUILD_VPI 编译时 transform() 返回 false
+ */
+class VpiImageTransform : public IImageTransform {
+public:
+    VpiImageTransform();
+    ~VpiImageTransform() override;
+
+    ImageTransformBackendType type() const noexcept override { return ImageTransformBackendType::Vpi; }
+    bool supports(core::PixelFormat from, core::PixelFormat to, ImageRotation rotation) const noexcept override;
+    bool transform(const ImageSurface& src, const ImageTransformOp& op, WritableImageSurface& dst) override;
+
+    static bool available();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace falconmind::sdk::sensors
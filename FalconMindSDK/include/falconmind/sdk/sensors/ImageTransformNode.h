@@ -0,0 +1,101 @@
+// FalconMindSDK - ImageTransformNode：裁剪 / 旋转 / 缩放 / 颜色转换流水线节点（RGA / VPI 硬件加速，CPU 回退）
+#pragma once
+
+#include "falconmind/sdk/core/BranchSwitch.h"
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/BufferPool.h"
+#include "falconmind/sdk/core/MemoryBudget.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/NodeWatchdog.h"
+#include "falconmind/sdk/sensors/ImageTransform.h"
+#include "falconmind/sdk/sensors/PixelFusion.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace falconmind::sdk::sensors {
+
+/**
+ * ImageTransformNode - video_in 收 CameraFramePacket 帧，变换后从 video_out 推出
+ *
+ * 每帧按 裁剪 → 旋转 → 缩放 → 颜色转换 单趟执行。带 DMABUF 的源帧（BufferMeta::dmabufFd）由 RGA 直接导入，
+ * 像素不经 CPU。硬件后端不支持当前组合或执行失败时，该帧改由 CPU 后端处理（首次告警）。
+ * CPU 后端、无旋转且输出为 RGB8/BGR8 时可作为像素融合链的几何阶段（见 FusablePixelStage）。
+ *
+ * configure 参数：
+ *   width / height          输出尺寸（0 为裁剪、旋转后的尺寸，默认）
+ *   format                  输出格式 RGB8 / BGR8 / NV12（默认 RGB8）
+ *   crop_x / crop_y / crop_width / crop_height   源图裁剪区域（默认整图）
+ *   rotate                  顺时针旋转 0 / 90 / 180 / 270
+ *   backend                 auto（默认，RGA → VPI → CPU）/ rga / vpi / cpu
+ *
+ * 看门狗 LowerResolution 动作在下一次 process() 时将输出尺寸减半（最短边不低于 64），下游经 caps 感知新尺寸。
+ */
+class ImageTransformNode : public core::Node,
+                           public core::MemoryBudgetSink,
+                           public core::BranchIdleSink,
+                           public FusablePixelStage,
+                           public core::WatchdogTarget {
+public:
+    ImageTransformNode();
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void stop() override;
+    void releaseIdleBuffers() override;
+    void process() override;
+
+    // 当前使用的后端（start() 之后有效）
+    ImageTransformBackendType backendType() const noexcept;
+    const ImageTransformOp& op() const noexcept { return op_; }
+    // 由于硬件后端不支持 / 失败而改用 CPU 处理的帧数
+    std::uint64_t cpuFallbackFrames() const noexcept { return cpuFallbacks_.load(std::memory_order_relaxed); }
+    std::uint64_t transformedFrames() const noexcept { return transformed_.load(std::memory_order_relaxed); }
+
+    // 输出缓冲池上限各一帧（输出尺寸未知时按 640x480 估算）；降分辨率需输出尺寸可静态确定（width/height 或裁剪区域）
+    std::size_t estimateMemoryBytes() const override;
+    bool degradeMemory(core::MemoryDegradation step) override;
+
+    // 看门狗线程调用：仅登记请求，由 process() 所在线程修改输出尺寸
+    bool applyWatchdogAction(core::WatchdogAction action) override;
+
+    core::Pad* fusionInputPad() const noexcept override { return inPad_; }
+    core::Pad* fusionOutputPad() const noexcept override { return outPad_; }
+    bool canFuse() const noexcept override;
+    bool planFusedFrame(const FusedImageInfo& in, FusedStagePlan& out) override;
+    void finishFusedFrame(const core::BufferRef& output) override;
+
+private:
+    void updateOutputCaps();
+    // 不依赖输入帧即可确定的输出尺寸；无法确定时返回 false
+    bool staticOutputSize(int& width, int& height) const;
+    // 给定输入尺寸时的输出尺寸（缺省为裁剪、旋转后的尺寸）
+    void outputSize(int srcWidth, int srcHeight, int& width, int& height) const;
+    // 将输出尺寸设为 width x height 的一半；低于最短边下限时返回 false
+    bool halveOutputSize(int width, int height);
+
+    core::Pad* inPad_{nullptr};
+    core::Pad* outPad_{nullptr};
+    core::PixelFormat inputFormat_{core::PixelFormat::Any};
+    core::PixelFormat outputFormat_{core::PixelFormat::RGB8};
+    int outWidth_{0};
+    int outHeight_{0};
+    ImageTransformOp op_;
+    ImageTransformBackendType requested_{ImageTransformBackendType::Auto};
+
+    ImageTransformPtr backend_;
+    ImageTransformPtr cpu_;  // 回退（backend_ 为 CPU 时不创建）
+    bool warnedFallback_{false};
+
+    std::mutex frameMutex_;
+    core::BufferRef pending_;
+    core::BufferPool pool_;
+    std::atomic<std::uint64_t> cpuFallbacks_{0};
+    std::atomic<std::uint64_t> transformed_{0};
+    std::atomic<bool> lowerResolutionPending_{false};
+    std::atomic<int> lastOutWidth_{0};  // 最近一帧的输出尺寸（看门狗判断能否再降）
+    std::atomic<int> lastOutHeight_{0};
+};
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,90 @@
+// FalconMindSDK - IMU 历史环形缓冲：单写多读无锁，按时间戳 O(log n) 查询、插值与预积分
+#pragma once
+
+#include "falconmind/sdk/sensors/SensorTypes.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace falconmind::sdk::sensors {
+
+struct ImuBias {
+    std::array<double, 3> gyro{{0., 0., 0.}};   // rad/s
+    std::array<double, 3> accel{{0., 0., 0.}};  // m/s^2
+};
+
+/**
+ * [t0, t1] 区间的 IMU 预积分（t0 时刻机体系下的相对运动，不含重力补偿）：
+ * 旋转 dq（w x y z），速度增量 dv = ∫R·a dt，位置增量 dp = ∬R·a dt²。
+ * 消费者按自身状态补偿重力：Δp = v0·dt + ½g·dt² + R0·dp，Δv = g·dt + R0·dv
+ */
+struct ImuPreintegration {
+    std::uint64_t t0Ns{0};
+    std::uint64_t t1Ns{0};
+    double dt{0.};
+    std::array<double, 4> dq{{1., 0., 0., 0.}};
+    std::array<double, 3> dv{{0., 0., 0.}};
+    std::array<double, 3> dp{{0., 0., 0.}};
+    std::size_t samples{0};  // 参与积分的采样点数（含两端插值点）
+};
+
+/**
+ * ImuHistory - 最近 capacity 个 IMU 采样的共享历史
+ *
+ * - 单一写者（ImuSourceNode 采集路径）push，任意多个读者并发查询，双方均不加锁：
+ *   每个槽带序号（seqlock），读者读到正在被覆盖的槽时视为已过期
+ * - 时间戳须单调递增，不递增的采样被丢弃并计数
+ * - 查询按时间戳二分定位：samplesBetween/at/integrate 为 O(log n + 区间内点数)
+ * - 读者落后超过一圈时最旧的数据已被覆盖，查询相应返回 false / 更少的点
+ */
+class ImuHistory {
+public:
+    explicit ImuHistory(std::size_t capacity = 4096);  // 向上取 2 的幂，至少 16
+
+    void push(const ImuSample& sample);
+    // 时间轴重新开始（重启采集、回放循环）：之前的采样不再参与查询；仅写者调用
+    void restart();
+
+    std::size_t capacity() const noexcept { return slots_.size(); }
+    std::size_t size() const noexcept;
+    std::uint64_t pushed() const noexcept { return head_.load(std::memory_order_acquire); }
+    std::uint64_t outOfOrderDrops() const noexcept { return outOfOrder_.load(std::memory_order_relaxed); }
+
+    bool latest(ImuSample& out) const;
+    // 追加 [t0Ns, t1Ns] 内的采样到 out（按时间升序，不清空 out）；返回追加个数
+    std::size_t samplesBetween(std::uint64_t t0Ns, std::uint64_t t1Ns, std::vector<ImuSample>& out) const;
+    // 相邻两采样线性插值；t 超出已有范围返回 false（恰为端点时返回该采样）
+    bool at(std::uint64_t tNs, ImuSample& out) const;
+    // 两端按插值补齐后中点法积分；区间不在历史范围内或 t1 <= t0 时返回 false
+    bool integrate(std::uint64_t t0Ns, std::uint64_t t1Ns, ImuPreintegration& out, const ImuBias& bias = {}) const;
+
+private:
+    static constexpr std::size_t kWords = 7;  // ImuSample：6 个 double + 时间戳
+
+    struct Slot {
+        std::atomic<std::uint64_t> seq{0};  // 2i+1 写入中，2i+2 已写入逻辑序号 i
+        std::array<std::atomic<std::uint64_t>, kWords> words{};
+    };
+
+    bool read(std::uint64_t index, ImuSample& out) const;
+    bool readTimestamp(std::uint64_t index, std::uint64_t& ts) const;
+    // [first, head) 中第一个时间戳 >= t 的逻辑序号（first 为仍可读的最旧序号）
+    std::uint64_t lowerBound(std::uint64_t tNs, std::uint64_t first, std::uint64_t head) const;
+    // 仍可查询的最旧逻辑序号（不早于最近一次 restart）
+    std::uint64_t oldestIndex(std::uint64_t head) const noexcept;
+
+    std::vector<Slot> slots_;
+    std::size_t mask_;
+    std::atomic<std::uint64_t> head_{0};       // 已发布的采样数（下一个写入的逻辑序号）
+    std::atomic<std::uint64_t> base_{0};       // 最近一次 restart 时的 head
+    std::atomic<std::uint64_t> outOfOrder_{0};
+    std::uint64_t lastTimestampNs_{0};         // 仅写者访问
+};
+
+using ImuHistoryPtr = std::shared_ptr<ImuHistory>;
+
+} // namespace falconmind::sdk::sensors
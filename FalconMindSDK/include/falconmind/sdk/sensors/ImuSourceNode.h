@@ -1,4 +1,5 @@
-// FalconMindSDK - IMU 数据源：支持模拟与文件回放（每行: timestamp_ns gx gy gz ax ay az）
+// FalconMindSDK - IMU 数据源：支持模拟与文件回放（每行: timestamp_ns gx gy gz ax ay az）；输出时间戳为 PipelineClock 时基
+// 每个采样同时写入共享的 ImuHistory，供视觉/融合节点按时间戳查询，无需各自缓存 imu_out 流
 #pragma once
 
 #include <cstdint>
@@ -6,6 +7,7 @@
 #include <string>
 
 #include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/sensors/ImuHistory.h"
 #include "falconmind/sdk/sensors/SensorTypes.h"
 
 namespace falconmind::sdk::sensors {
@@ -17,7 +19,11 @@ public:
     bool start() override;
     void process() override;
 
+    // 参数 history_size 设置容量（默认 4096，1 kHz 下约 4 s）；启动后指针不变
+    const ImuHistoryPtr& history() const noexcept { return history_; }
+
 private:
+    core::Pad* outPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
     void pushImu(const ImuSample& s);
 
     std::string deviceOrUri_;
@@ -25,6 +31,10 @@ private:
     std::ifstream replayFile_;
     bool replayMode_{false};
     std::uint64_t simTimestampNs_{0};
+    bool replayAnchored_{false};
+    std::int64_t replayOffsetNs_{0};  // 回放文件时间 → PipelineClock
+    std::int64_t lastTimestampNs_{0};
+    ImuHistoryPtr history_;
 };
 
 } // namespace falconmind::sdk::sensors
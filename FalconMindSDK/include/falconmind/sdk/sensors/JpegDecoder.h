@@ -0,0 +1,169 @@
+// FalconMindSDK - JPEG 解码：MPP（Rockchip JPEG 解码器）、NVJPEG（Jetson NVJPG / CUDA）、libjpeg-turbo（SIMD 软件回退）
+#pragma once
+
+#include "falconmind/sdk/sensors/ImageTransform.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::sensors {
+
+enum class JpegDecoderType : std::uint8_t {
+    Auto = 0,  // 按 MPP → NVJPEG → libjpeg-turbo 选择可用的解码器
+    Mpp,       // Rockchip MPP（MJPEG 解码，NV12 输出）
+    Nvjpeg,    // NVIDIA nvJPEG（交织 RGB/BGR 输出，从显存下载）
+    Turbo,     // libjpeg-turbo（TurboJPEG API，NEON/AVX2 SIMD，RGB/BGR 输出）
+};
+
+const char* jpegDecoderName(JpegDecoderType type) noexcept;
+// "auto"/"mpp"/"nvjpeg"/"turbo"（大小写不敏感）；无法识别返回 false
+bool parseJpegDecoder(const std::string& name, JpegDecoderType& out);
+
+// 从 SOF 段读取图像尺寸（不解码）；不是有效的 JPEG 头时返回 false
+bool readJpegSize(const std::uint8_t* data, std::size_t size, int& width, int& height);
+
+/**
+ * IJpegDecoder - 把一张 baseline JPEG（含 UVC MJPEG 常见的省略 DHT 帧）解码到调用方提供的缓冲
+ *
+ * dst 的宽高须与图像一致，格式须为 supportsOutput() 之一：调用方直接传入帧缓冲池中的帧，解码器写入后不再拷贝。
+ * 非线程安全：每个使用方持有自己的实例。
+ */
+class IJpegDecoder {
+public:
+    virtual ~IJpegDecoder() = default;
+
+    virtual JpegDecoderType type() const noexcept = 0;
+    const char* name() const noexcept { return jpegDecoderName(type()); }
+
+    // 首选输出格式（硬件原生输出，无需额外转换）
+    virtual core::PixelFormat nativeFormat() const noexcept = 0;
+    virtual bool supportsOutput(core::PixelFormat format) const noexcept = 0;
+    // 尺寸不符、码流损坏（USB 传输丢包常见）或硬件执行失败时返回 false
+    virtual bool decode(const std::uint8_t* jpeg, std::size_t size, const WritableImageSurface& dst) = 0;
+};
+
+using JpegDecoderPtr = std::unique_ptr<IJpegDecoder>;
+
+// 当前构建 / 设备上解码器是否可用（与对应编码器共用编译选项）；Auto 表示至少一个可用
+bool jpegDecoderAvailable(JpegDecoderType type);
+// 创建解码器；不可用时返回 nullptr
+JpegDecoderPtr createJpegDecoder(JpegDecoderType type);
+
+/**
+ * MppJpegDecoder - Rockchip MPP MJPEG 解码（RK3588/RK3576 JPEG 解码器）。码流复制到 DRM 输入缓冲，
+ * 输出为 16 对齐的 NV12，逐行复制到 dst；尺寸变化时重新分配。未以 FALCONMINDSDK_BUILD_MPP_JPEG 编译时 decode() 返回 false
+ */
+class MppJpegDecoder : public IJpegDecoder {
+public:
+    MppJpegDecoder();
+    ~MppJpegDecoder() override;
+
+    JpegDecoderType type() const noexcept override { return JpegDecoderType::Mpp; }
+    core::PixelFormat nativeFormat() const noexcept override { return core::PixelFormat::NV12; }
+    bool supportsOutput(core::PixelFormat format) const noexcept override { return format == core::PixelFormat::NV12; }
+    bool decode(const std::uint8_t* jpeg, std::size_t size, const WritableImageSurface& dst) override;
+
+    static bool available();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * NvjpegDecoder - nvJPEG 解码（Jetson 上走 NVJPG 硬件后端，其余 GPU 为 CUDA 混合解码）。显存输出按最大尺寸复用；
+ * 未以 FALCONMINDSDK_BUILD_NVJPEG 编译时 decode() 返回 false
+ */
+class NvjpegDecoder : public IJpegDecoder {
+public:
+    NvjpegDecoder();
+    ~NvjpegDecoder() override;
+
+    JpegDecoderType type() const noexcept override { return JpegDecoderType::Nvjpeg; }
+    core::PixelFormat nativeFormat() const noexcept override { return core::PixelFormat::RGB8; }
+    bool supportsOutput(core::PixelFormat format) const noexcept override {
+        return format == core::PixelFormat::RGB8 || format == core::PixelFormat::BGR8;
+    }
+    bool decode(const std::uint8_t* jpeg, std::size_t size, const WritableImageSurface& dst) override;
+
+    static bool available();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * TurboJpegDecoder - libjpeg-turbo 软件解码（快速 IDCT + 快速上采样），直接写入 dst；
+ * 未以 FALCONMINDSDK_BUILD_TURBOJPEG 编译时 decode() 返回 false
+ */
+class TurboJpegDecoder : public IJpegDecoder {
+public:
+    TurboJpegDecoder();
+    ~TurboJpegDecoder() override;
+
+    JpegDecoderType type() const noexcept override { return JpegDecoderType::Turbo; }
+    core::PixelFormat nativeFormat() const noexcept override { return core::PixelFormat::RGB8; }
+    bool supportsOutput(core::PixelFormat format) const noexcept override {
+        return format == core::PixelFormat::RGB8 || format == core::PixelFormat::BGR8;
+    }
+    bool decode(const std::uint8_t* jpeg, std::size_t size, const WritableImageSurface& dst) override;
+
+    static bool available();
+
+private:
+    void* handle_{nullptr};  // tjhandle
+};
+
+/**
+ * MjpegDecodeStage - MJPEG 解码级：采集线程只拷贝压缩帧（几十到几百 KB）后立即归还驱动缓冲，
+ * 解码在本级自有的线程中完成，解码耗时再长也不会阻塞采集或让驱动队列耗尽。
+ *
+ * 只保留最新一帧：上一帧尚未被解码线程取走时被新帧覆盖（计入 dropped），输出延迟不随解码积压增长。
+ */
+class MjpegDecodeStage {
+public:
+    // 解码线程回调：jpeg 在回调返回前有效
+    using Handler = std::function<void(const std::uint8_t* jpeg, std::size_t size, std::int64_t captureNs)>;
+
+    MjpegDecodeStage() = default;
+    ~MjpegDecodeStage() { stop(); }
+    MjpegDecodeStage(const MjpegDecodeStage&) = delete;
+    MjpegDecodeStage& operator=(const MjpegDecodeStage&) = delete;
+
+    void start(Handler handler);
+    // 等待正在执行的回调返回；未取走的帧丢弃
+    void stop();
+    bool running() const noexcept { return thread_.joinable(); }
+
+    // 采集线程调用：拷贝一帧后立即返回
+    void submit(const std::uint8_t* jpeg, std::size_t size, std::int64_t captureNs);
+
+    std::uint64_t submittedFrames() const noexcept { return submitted_.load(std::memory_order_relaxed); }
+    std::uint64_t droppedFrames() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void loop();
+
+    Handler handler_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool running_{false};
+    bool pending_{false};
+    std::vector<std::uint8_t> inbox_;  // 采集线程写入
+    std::int64_t inboxNs_{0};
+    std::vector<std::uint8_t> work_;   // 解码线程与 inbox_ 交换后读取，两块缓冲轮换复用容量
+    std::atomic<std::uint64_t> submitted_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+};
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,108 @@
+// FalconMindSDK - JPEG 编码：MPP（Rockchip VEPU）、NVJPEG（Jetson/x86 CUDA）、libjpeg-turbo（SIMD 软件回退）
+#pragma once
+
+#include "falconmind/sdk/sensors/ImageTransform.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::sensors {
+
+enum class JpegEncoderType : std::uint8_t {
+    Auto = 0,  // 按 MPP → NVJPEG → libjpeg-turbo 选择可用的编码器
+    Mpp,       // Rockchip MPP（MJPEG 编码，NV12 输入）
+    Nvjpeg,    // NVIDIA nvJPEG（交织 RGB 输入，上传到显存后编码）
+    Turbo,     // libjpeg-turbo（TurboJPEG API，NEON/AVX2 SIMD）
+};
+
+const char* jpegEncoderName(JpegEncoderType type) noexcept;
+// "auto"/"mpp"/"nvjpeg"/"turbo"（大小写不敏感）；无法识别返回 false
+bool parseJpegEncoder(const std::string& name, JpegEncoderType& out);
+
+/**
+ * IJpegEncoder - 把一张图编码为 baseline JPEG（4:2:0）
+ *
+ * 源格式须为 inputFormat()：调用方先用 IImageTransform 一趟完成裁剪、缩放与格式转换，编码器不再做颜色转换。
+ * out 被覆盖（复用其容量）。非线程安全：每个使用方持有自己的实例。
+ */
+class IJpegEncoder {
+public:
+    virtual ~IJpegEncoder() = default;
+
+    virtual JpegEncoderType type() const noexcept = 0;
+    const char* name() const noexcept { return jpegEncoderName(type()); }
+
+    virtual core::PixelFormat inputFormat() const noexcept = 0;
+    // quality 1–100；参数无效或硬件执行失败时返回 false
+    virtual bool encode(const ImageSurface& src, int quality, std::vector<std::uint8_t>& out) = 0;
+};
+
+using JpegEncoderPtr = std::unique_ptr<IJpegEncoder>;
+
+// 当前构建 / 设备上编码器是否可用（均需以对应选项编译）；Auto 表示至少一个可用
+bool jpegEncoderAvailable(JpegEncoderType type);
+// 创建编码器；不可用时返回 nullptr（与 IImageTransform 不同，没有总能成功的内置实现）
+JpegEncoderPtr createJpegEncoder(JpegEncoderType type);
+
+/**
+ * MppJpegEncoder - Rockchip MPP MJPEG 编码（RK3588/RK3576 VEPU）。帧复制到 16 对齐的 DRM 缓冲后提交，
+ * 尺寸变化时重新配置；未以 FALCONMINDSDK_BUILD_MPP_JPEG 编译时 encode() 返回 false
+ */
+class MppJpegEncoder : public IJpegEncoder {
+public:
+    MppJpegEncoder();
+    ~MppJpegEncoder() override;
+
+    JpegEncoderType type() const noexcept override { return JpegEncoderType::Mpp; }
+    core::PixelFormat inputFormat() const noexcept override { return core::PixelFormat::NV12; }
+    bool encode(const ImageSurface& src, int quality, std::vector<std::uint8_t>& out) override;
+
+    static bool available();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * NvjpegEncoder - nvJPEG 硬件 / CUDA 编码。显存缓冲按最大尺寸复用；
+ * 未以 FALCONMINDSDK_BUILD_NVJPEG 编译时 encode() 返回 false
+ */
+class NvjpegEncoder : public IJpegEncoder {
+public:
+    NvjpegEncoder();
+    ~NvjpegEncoder() override;
+
+    JpegEncoderType type() const noexcept override { return JpegEncoderType::Nvjpeg; }
+    core::PixelFormat inputFormat() const noexcept override { return core::PixelFormat::RGB8; }
+    bool encode(const ImageSurface& src, int quality, std::vector<std::uint8_t>& out) override;
+
+    static bool available();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * TurboJpegEncoder - libjpeg-turbo 软件编码（快速 DCT），直接写入 out 的缓冲（不经 tjAlloc 重新分配）；
+ * 未以 FALCONMINDSDK_BUILD_TURBOJPEG 编译时 encode() 返回 false
+ */
+class TurboJpegEncoder : public IJpegEncoder {
+public:
+    TurboJpegEncoder();
+    ~TurboJpegEncoder() override;
+
+    JpegEncoderType type() const noexcept override { return JpegEncoderType::Turbo; }
+    core::PixelFormat inputFormat() const noexcept override { return core::PixelFormat::RGB8; }
+    bool encode(const ImageSurface& src, int quality, std::vector<std::uint8_t>& out) override;
+
+    static bool available();
+
+private:
+    void* handle_{nullptr};  // tjhandle
+};
+
+} // namespace falconmind::sdk::sensors
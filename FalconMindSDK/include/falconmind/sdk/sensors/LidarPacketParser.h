@@ -0,0 +1,92 @@
+// FalconMindSDK - 激光雷达 UDP 数据包解析：Velodyne VLP-16 / Livox（SDK1 协议）→ SoA 点云扫描帧
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/BufferPool.h"
+#include "falconmind/sdk/core/TimeSync.h"
+#include "falconmind/sdk/sensors/PointCloudPacket.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace falconmind::sdk::sensors {
+
+enum class LidarPacketFormat : std::uint8_t {
+    Unknown,
+    Velodyne16,  // VLP-16/Puck：1206 字节数据包，12 块 × 2 次发射 × 16 线，方位角回绕为一圈
+    Livox,       // Livox SDK1（Mid-40/Mid-70/Avia/Horizon）：笛卡尔坐标数据类型 0/2，按 frame_period 切帧
+};
+
+// "vlp16"/"velodyne"、"livox"（大小写不敏感）；无法识别时为 Unknown
+LidarPacketFormat parseLidarPacketFormat(const std::string& name) noexcept;
+const char* lidarPacketFormatName(LidarPacketFormat format) noexcept;
+
+struct LidarScanStats {
+    std::uint64_t packets{0};
+    std::uint64_t malformedPackets{0};
+    std::uint64_t points{0};
+    std::uint64_t truncatedPoints{0};  // 超出扫描帧容量而丢弃的点
+    std::uint64_t scans{0};
+};
+
+/**
+ * LidarScanAssembler - 把数据包逐个解码进当前扫描帧（从帧缓冲池获取、容量固定的 PointCloudPacket），
+ * 一帧完整（Velodyne 方位角回绕 / Livox 达到 frame_period）时回调并换下一块缓冲。
+ * 解码直接写入目标数组，不经过中间点容器；稳定运行时缓冲全部复用，不再分配。
+ * 非线程安全：由单一接收线程调用
+ */
+class LidarScanAssembler {
+public:
+    using ScanCallback = std::function<void(core::BufferRef scan)>;
+
+    LidarScanAssembler(LidarPacketFormat format, std::uint32_t capacity, core::BufferPool& pool, ScanCallback onScan,
+                       std::int64_t framePeriodNs = 100'000'000);
+
+    // 解码一个数据包；arrivalNs 为接收时刻（PipelineClock 时基）。未设置时钟同步时以它作为新扫描帧的时间戳。
+    // 格式不符返回 false
+    bool feed(const std::uint8_t* data, std::size_t size, std::int64_t arrivalNs);
+    // 立即输出当前未完成的扫描帧（无点时忽略）
+    void flush();
+    // 丢弃当前未完成的扫描帧（暂停恢复后，避免把暂停前后的点拼成一帧）
+    void reset();
+    // 以数据包内的传感器时间戳经 clock 映射到 PipelineClock 作为扫描帧时间戳（消除接收抖动）；nullptr 恢复按到达时刻
+    void setClockSync(core::ClockSyncPtr clock) { clock_ = std::move(clock); }
+
+    LidarPacketFormat format() const noexcept { return format_; }
+    std::uint32_t capacity() const noexcept { return capacity_; }
+    const LidarScanStats& stats() const noexcept { return stats_; }
+
+private:
+    bool feedVelodyne16(const std::uint8_t* data, std::size_t size, std::int64_t arrivalNs);
+    bool feedLivox(const std::uint8_t* data, std::size_t size, std::int64_t arrivalNs);
+    // 确保有正在填充的扫描帧；sensorTimeNs 为传感器时钟下的帧起点
+    void beginScan(std::int64_t arrivalNs, std::int64_t sensorTimeNs);
+    void finishScan();
+    // 数据包传感器时间 → 统一时间轴
+    std::int64_t toHostNs(std::int64_t sensorNs, std::int64_t arrivalNs) {
+        return clock_ ? clock_->observe(sensorNs, arrivalNs) : arrivalNs;
+    }
+    void appendPoint(float x, float y, float z, float intensity, std::int64_t sensorTimeNs, std::uint16_t ring);
+
+    LidarPacketFormat format_;
+    std::uint32_t capacity_;
+    core::BufferPool& pool_;
+    ScanCallback onScan_;
+    std::int64_t framePeriodNs_;
+    core::BufferRef scan_;
+    PointCloudWriter writer_;
+    std::int64_t scanSensorStartNs_{0};
+    std::uint64_t frameIndex_{0};
+    int lastAzimuth_{-1};  // Velodyne：上一块方位角（0.01°）
+    std::int64_t lastPacketNs_{-1};  // Velodyne：上一包整点后时间，用于展开整点回绕
+    std::int64_t hourBaseNs_{0};
+    core::ClockSyncPtr clock_;
+    std::array<float, 16> elevationSin_{};
+    std::array<float, 16> elevationCos_{};
+    LidarScanStats stats_;
+};
+
+} // namespace falconmind::sdk::sensors
@@ -1,28 +1,100 @@
-// FalconMindSDK - 点云数据源：支持 ASCII 点云文件回放（每行 x y z 或 x y z i）
+// FalconMindSDK - 点云数据源：
+//   - 二进制点云文件（KITTI .bin：float x y z i；二进制 .pcd），mmap 后每帧转置为 SoA PointCloudPacket
+//   - UDP 数据包（udp://[host]:port，format=vlp16|livox），接收线程批量收包、解码成扫描帧
+//   - ASCII 点云文件回放（每行 x y z 或 x y z i）与捕获文件回放（每条记录为一帧 PointXYZI 数组，mmap 零拷贝推送）
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
+#include <memory>
 #include <string>
+#include <thread>
 
+#include "falconmind/sdk/core/BufferPool.h"
+#include "falconmind/sdk/core/CaptureFile.h"
 #include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/sensors/LidarPacketParser.h"
 #include "falconmind/sdk/sensors/SensorTypes.h"
 
 namespace falconmind::sdk::sensors {
 
+/**
+ * 参数：device/uri、format（UDP 包格式：vlp16/livox）、max_points（UDP 扫描帧容量，默认 131072）、
+ * frame_period_ms（Livox 切帧周期，默认 100）、time_sync（UDP 扫描帧时间戳：sensor 按包内时间戳经
+ * TimeSyncService 映射到 PipelineClock（默认），arrival 按接收时刻）
+ * 二进制文件与 UDP 路径输出 PointCloudPacket（SoA，缓冲池复用）；ASCII 与捕获文件仍输出 PointXYZI 数组
+ */
 class LidarSourceNode : public core::Node {
 public:
     LidarSourceNode();
+    ~LidarSourceNode() override;
     bool configure(const std::unordered_map<std::string, std::string>& params) override;
     bool start() override;
+    void stop() override;
+    void pause() override;
+    void resume() override;
     void process() override;
 
+    bool udpMode() const noexcept { return udpFd_ >= 0; }
+    std::uint64_t scansPushed() const noexcept { return scansPushed_.load(std::memory_order_relaxed); }
+    std::uint64_t packetsReceived() const noexcept { return packetsReceived_.load(std::memory_order_relaxed); }
+    std::uint64_t malformedPackets() const noexcept { return malformedPackets_.load(std::memory_order_relaxed); }
+    std::uint64_t truncatedPoints() const noexcept { return truncatedPoints_.load(std::memory_order_relaxed); }
+
+    // 二进制点云文件在 mmap 内的布局（.bin 固定为 16 字节 float x y z i；.pcd 由文件头解析）
+    struct BinaryLayout {
+        std::size_t dataOffset{0};
+        std::size_t pointStep{0};
+        std::uint32_t points{0};
+        int xOff{-1}, yOff{-1}, zOff{-1};
+        int intensityOff{-1};
+        char intensityType{'F'};  // 'F'（4 字节）或 'U'（1/2 字节）
+        int intensitySize{4};
+        int ringOff{-1};          // uint16
+    };
+    // 解析二进制 PCD 文件头（DATA binary；x/y/z 须为 F4）；失败返回 false
+    static bool parsePcdHeader(const std::uint8_t* data, std::size_t size, BinaryLayout& layout);
+
 private:
+    struct MappedFile;
+
+    core::Pad* outPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
     void pushPointCloud(const PointCloud& cloud);
+    bool openBinaryFile(const std::string& path);
+    void pushBinaryScan();
+    bool startUdp(const std::string& uri);
+    void closeUdp();
+    void udpLoop();
 
     std::string deviceOrUri_;
     bool started_{false};
     std::ifstream replayFile_;
     bool replayMode_{false};
+    PointCloud asciiCloud_;  // ASCII 回放复用，避免逐帧重新分配
+    std::shared_ptr<core::CaptureReader> capture_;  // 非空表示捕获文件回放
+    std::size_t captureNext_{0};
+
+    std::shared_ptr<MappedFile> binary_;  // 非空表示二进制点云文件回放
+    BinaryLayout layout_;
+    std::uint64_t binaryFrames_{0};
+
+    LidarPacketFormat packetFormat_{LidarPacketFormat::Unknown};
+    std::uint32_t maxPoints_{131072};
+    std::int64_t framePeriodNs_{100'000'000};
+    bool sensorTimeSync_{true};
+    int udpFd_{-1};
+    int wakeFd_{-1};  // eventfd：stop 时唤醒接收线程
+    std::thread udpThread_;
+    std::atomic<bool> udpRunning_{false};
+    std::atomic<bool> paused_{false};
+    std::atomic<bool> resetScan_{false};
+    std::atomic<std::uint64_t> scansPushed_{0};
+    std::atomic<std::uint64_t> packetsReceived_{0};
+    std::atomic<std::uint64_t> malformedPackets_{0};
+    std::atomic<std::uint64_t> truncatedPoints_{0};
+    core::BufferPool scanPool_;
 };
 
 } // namespace falconmind::sdk::sensors
@@ -0,0 +1,146 @@
+// FalconMindSDK - 多相机同步采集：N 路相机各自采集线程 + 按驱动时间戳对齐的汇合阶段
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/BufferPool.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/sensors/CameraSourceNode.h"
+#include "falconmind/sdk/sensors/VideoSourceConfig.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::sensors {
+
+constexpr std::size_t kMaxSyncedCameras = 8;
+
+/**
+ * frames_out 上的帧组包：本头之后依次为 count 段 CameraFramePacket + 像素（与 video_out 帧相同），
+ * 第 i 段位于包起始 offsets[i] 处，长度 sizes[i]（各段 8 字节对齐）
+ */
+struct MultiCameraFramePacket {
+    std::uint32_t count{0};
+    std::uint32_t reserved{0};
+    std::uint64_t setIndex{0};
+    std::int64_t timestampNs{0};  // 组内最早的驱动时间戳（PipelineClock 时基）
+    std::int64_t skewNs{0};       // 组内最晚与最早时间戳之差
+    std::uint64_t offsets[kMaxSyncedCameras]{};
+    std::uint64_t sizes[kMaxSyncedCameras]{};
+};
+
+// 一组时间对齐的帧（frames[i] 来自第 i 路相机）
+struct FrameSet {
+    std::uint64_t index{0};
+    std::int64_t timestampNs{0};
+    std::int64_t skewNs{0};
+    std::vector<core::BufferRef> frames;
+};
+
+/**
+ * FrameSynchronizer - 按 BufferMeta::timestampNs 把 N 路帧对齐为帧组
+ *
+ * 每路保留最近 queueDepth 帧（超出丢弃最旧）。各路队首时间戳极差不超过 maxSkewNs 时组成一组；
+ * 否则最早的队首不可能再与其它路的后续帧对齐，丢弃后重试。某一路停帧时不产出帧组，
+ * 其余各路只保留最新的帧，该路恢复后立即继续对齐。
+ * 非线程安全：MultiCameraSourceNode 在汇合锁内使用
+ */
+class FrameSynchronizer {
+public:
+    struct Config {
+        std::size_t streams{2};
+        std::int64_t maxSkewNs{5'000'000};
+        std::size_t queueDepth{4};
+    };
+
+    FrameSynchronizer();
+    explicit FrameSynchronizer(const Config& cfg);
+
+    void push(std::size_t stream, core::BufferRef frame);
+    // 组出一组对齐的帧；暂无可对齐的帧时返回 false
+    bool pop(FrameSet& out);
+    void clear();
+
+    const Config& config() const noexcept { return cfg_; }
+    std::uint64_t sets() const noexcept { return sets_; }
+    // 未能对齐而丢弃的帧数 / 队列已满丢弃的帧数
+    std::uint64_t unmatchedDrops() const noexcept { return unmatchedDrops_; }
+    std::uint64_t overflowDrops() const noexcept { return overflowDrops_; }
+
+private:
+    Config cfg_;
+    std::vector<std::deque<core::BufferRef>> queues_;
+    std::uint64_t sets_{0};
+    std::uint64_t unmatchedDrops_{0};
+    std::uint64_t overflowDrops_{0};
+};
+
+/**
+ * MultiCameraSourceNode - 多相机同步采集源
+ *
+ * - 每路相机为一个内部 CameraSourceNode（V4L2 时各自的 poll 采集线程），帧到达时只入汇合队列，
+ *   某一路处理慢或停帧不会阻塞其它路的采集
+ * - 汇合线程按驱动时间戳对齐（FrameSynchronizer），每组依次从 video_out_<i> 零拷贝推送各路帧，
+ *   frames_out 已连接时另推送一个 MultiCameraFramePacket 帧组包（拷贝一次）
+ * - 外部硬件触发（同一触发信号）时各路时间戳相差微秒级；自由运行的相机由 max_skew_ms 约束
+ * 参数：devices（逗号分隔，如 "/dev/video0,/dev/video1"）、max_skew_ms、queue_depth，
+ * 其余参数（width/height/fps/pixel_format/zero_copy/buffers 等）原样转给每一路相机
+ */
+class MultiCameraSourceNode : public core::Node {
+public:
+    explicit MultiCameraSourceNode(const std::vector<VideoSourceConfig>& cameras = {},
+                                   std::int64_t maxSkewNs = 5'000'000);
+    ~MultiCameraSourceNode() override;
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void stop() override;
+    void pause() override;
+    void resume() override;
+    // 驱动不使用采集线程的相机（文件回放等）取一帧；V4L2 相机由各自线程采集
+    void process() override;
+
+    std::size_t cameraCount() const noexcept { return cameras_.size(); }
+    CameraSourceNode* camera(std::size_t index) const noexcept {
+        return index < cameras_.size() ? cameras_[index].get() : nullptr;
+    }
+    std::int64_t maxSkewNs() const noexcept { return maxSkewNs_; }
+
+    std::uint64_t frameSets() const noexcept { return frameSets_.load(std::memory_order_relaxed); }
+    std::uint64_t unmatchedDrops() const;
+    std::int64_t lastSkewNs() const noexcept { return lastSkewNs_.load(std::memory_order_relaxed); }
+
+private:
+    void setCameras(const std::vector<VideoSourceConfig>& cameras);
+    void onCameraFrame(std::size_t index, const core::BufferRef& frame);
+    void joinLoop();
+    void emit(const FrameSet& set);
+
+    std::vector<std::shared_ptr<CameraSourceNode>> cameras_;
+    std::vector<std::shared_ptr<core::Pad>> inputs_;  // 内部 Sink Pad：接收各路 video_out
+    std::vector<core::Pad*> outPads_;                 // video_out_<i>
+    core::Pad* setPad_{nullptr};                      // frames_out
+    std::int64_t maxSkewNs_;
+    std::size_t queueDepth_{4};
+
+    mutable std::mutex syncMutex_;
+    std::condition_variable syncCv_;
+    FrameSynchronizer sync_;
+    std::thread joinThread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> paused_{false};
+    std::atomic<std::uint64_t> frameSets_{0};
+    std::atomic<std::int64_t> lastSkewNs_{0};
+    core::BufferPool setPool_;  // frames_out 帧组包
+};
+
+} // namespace falconmind::sdk::sensors
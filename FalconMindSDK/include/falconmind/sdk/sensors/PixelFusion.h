@@ -0,0 +1,132 @@
+// FalconMindSDK - 像素阶段融合：相邻的逐像素节点（颜色转换 → 低照度查表 → 裁剪缩放）合并为单趟逐行内核
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/BufferPool.h"
+#include "falconmind/sdk/core/Caps.h"
+#include "falconmind/sdk/sensors/ImageTransform.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace falconmind::sdk::core {
+class Pad;
+}
+
+namespace falconmind::sdk::sensors {
+
+// 融合链中某一阶段的输入图像
+struct FusedImageInfo {
+    core::PixelFormat format{core::PixelFormat::Any};
+    int width{0};
+    int height{0};
+};
+
+// 阶段对当前帧的操作
+struct FusedStagePlan {
+    core::PixelFormat format{core::PixelFormat::Any};  // 输出格式，须为 RGB8 / BGR8
+    bool rowOp{false};     // 逐行原地处理：FusedPixelChain 对每一产出行调用 fusedRow()
+    bool geometry{false};  // 裁剪 + 双线性缩放（语义同 CpuImageTransform，不含旋转）；整链至多一个
+    ImageRect crop;
+    int width{0};   // 缩放目标尺寸，0 为裁剪后的尺寸
+    int height{0};
+};
+
+class FusedPixelChain;
+
+/**
+ * FusablePixelStage - 可参与像素阶段融合的节点实现此接口（VideoConvertNode、LowLightAdaptationNode、
+ * ImageTransformNode）
+ *
+ * Pipeline 进入 Playing 时查找由一对一连接串起的可融合节点（中间 Pad 只有这一条连接），把 FusedPixelChain
+ * 交给链首节点。链首 process() 取到帧后调用 FusedPixelChain::run()：源图逐行解码、经各阶段行处理后直接
+ * 插值写入输出缓冲，中间帧只以两行的行缓冲存在（留在 L1/L2），链尾从 fusionOutputPad() 推出结果；
+ * 链中其余节点收不到帧而空闲。任一阶段对当前帧 planFusedFrame() 返回 false 时整链回退为逐节点处理。
+ */
+class FusablePixelStage {
+public:
+    virtual ~FusablePixelStage() = default;
+
+    // 图像主通路的输入 / 输出 Pad
+    virtual core::Pad* fusionInputPad() const noexcept = 0;
+    virtual core::Pad* fusionOutputPad() const noexcept = 0;
+    // 按当前配置是否可以融合（Pipeline 建链时检查；如硬件后端、旋转、CLAHE 不可融合）
+    virtual bool canFuse() const noexcept = 0;
+    /**
+     * 为即将处理的一帧确定本阶段的操作
+     * @param in 本阶段输入（链首为源帧格式，其后为前一阶段的输出）
+     * @return false 表示这一帧不能融合
+     */
+    virtual bool planFusedFrame(const FusedImageInfo& in, FusedStagePlan& out) = 0;
+    /**
+     * plan.rowOp 时原地处理本阶段的一行（按 plan.format 排列，width 像素），只对实际产出的行调用，行号递增。
+     * 几何阶段之前 y 为源帧行号、width 为裁剪宽度；之后为输出行号
+     */
+    virtual void fusedRow(std::uint8_t* row, int width, int y) {
+        (void)row;
+        (void)width;
+        (void)y;
+    }
+    // 整链输出完成、推出之前调用（统计量、旁路输出）
+    virtual void finishFusedFrame(const core::BufferRef& output) { (void)output; }
+
+    const std::shared_ptr<FusedPixelChain>& pixelFusion() const noexcept { return fusion_; }
+    // 由 Pipeline 在调度器未运行时设置 / 清除
+    void setPixelFusion(std::shared_ptr<FusedPixelChain> chain) { fusion_ = std::move(chain); }
+
+protected:
+    std::shared_ptr<FusedPixelChain> fusion_;
+};
+
+/**
+ * FusedPixelChain - 一条融合链的执行器（链首节点持有；阶段指针由 Pipeline 保证在链存续期间有效）
+ * 输出缓冲取自自身的缓冲池，链尾节点实现 MemoryBudgetSink 时计入链尾的内存记账
+ */
+class FusedPixelChain {
+public:
+    explicit FusedPixelChain(std::vector<FusablePixelStage*> stages);
+
+    const std::vector<FusablePixelStage*>& stages() const noexcept { return stages_; }
+
+    /**
+     * 融合处理一帧 CameraFramePacket 并从链尾推出
+     * @param format 源帧像素格式（链首按自身的协商结果确定）
+     * @return false 表示本帧未处理（不可融合或帧不完整），调用方按单节点逻辑处理
+     */
+    bool run(const core::BufferRef& frame, core::PixelFormat format);
+
+    // 释放输出缓冲池的空闲缓冲与行缓冲（链首节点所在分支被截断时）；不与 run() 并发
+    void releaseBuffers();
+
+    std::uint64_t fusedFrames() const noexcept { return fused_.load(std::memory_order_relaxed); }
+    std::uint64_t fallbackFrames() const noexcept { return fallbacks_.load(std::memory_order_relaxed); }
+
+private:
+    // 产出几何阶段输入（裁剪区域内）的第 r 行：解码 + 几何之前各阶段的行处理
+    void produceRow(int r, std::uint8_t* out);
+    void applyStages(std::size_t begin, std::size_t end, std::uint8_t* row, int width, int y);
+
+    std::vector<FusablePixelStage*> stages_;
+    std::vector<FusedStagePlan> plans_;
+    std::vector<core::PixelFormat> formats_;  // formats_[i] 为第 i 阶段输入格式，末项为链输出格式
+    std::size_t geometryAt_{0};  // 几何阶段下标；无几何阶段时为 stages_.size()
+
+    // 当前帧
+    const std::uint8_t* src_{nullptr};
+    int srcStride_{0};
+    int srcHeight_{0};
+    int cropX_{0};
+    int cropY_{0};
+    int cropW_{0};
+
+    BilinearColumns columns_;
+    std::vector<std::uint8_t> rows_[2];  // 几何阶段的两行输入缓冲
+    int rowTag_[2]{-1, -1};
+    core::BufferPool pool_;
+    std::atomic<std::uint64_t> fused_{0};
+    std::atomic<std::uint64_t> fallbacks_{0};
+};
+
+} // namespace falconmind::sdk::sensors
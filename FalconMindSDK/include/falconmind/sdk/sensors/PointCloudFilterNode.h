@@ -0,0 +1,133 @@
+// FalconMindSDK - 点云预处理：距离/ROI 裁剪、栅格地面去除、体素降采样（SoA，多线程）
+#pragma once
+
+#include "falconmind/sdk/core/BranchSwitch.h"
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/BufferPool.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/WorkerGroup.h"
+#include "falconmind/sdk/sensors/PointCloudPacket.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace falconmind::sdk::sensors {
+
+struct PointCloudFilterConfig {
+    float voxelSize{0.2f};  // 体素边长（米）；0 关闭降采样
+    float minRange{0.0f};   // 到传感器原点的距离范围；maxRange 为 0 表示不限
+    float maxRange{0.0f};
+    std::array<float, 3> roiMin{{-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                                 -std::numeric_limits<float>::infinity()}};
+    std::array<float, 3> roiMax{{std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(),
+                                 std::numeric_limits<float>::infinity()}};
+    float groundCell{0.0f};     // 地面栅格边长（米）；0 关闭地面去除
+    float groundHeight{0.2f};   // 高于所在栅格最低点不超过此值的点视为地面
+    std::size_t threads{0};     // 0 表示 min(hardware_concurrency, 4)
+};
+
+struct PointCloudFilterStats {
+    std::uint64_t inputPoints{0};
+    std::uint64_t croppedPoints{0};  // 距离/ROI 裁剪掉的点
+    std::uint64_t groundPoints{0};
+    std::uint64_t outputPoints{0};
+};
+
+/**
+ * PointCloudFilter - 对一帧 SoA 点云依次做裁剪、地面去除与体素降采样
+ *
+ * - 裁剪逐字段顺序扫描、无分支（编译器可向量化），多线程按点分段
+ * - 栅格与体素用 64 位打包坐标作键、开放寻址哈希；按键哈希分片到各线程，
+ *   各线程只累加本片的键，无锁无共享写。体素输出点为质心（强度取均值，时间/线号取首点）
+ * - 输出顺序由线程数决定、与调度无关；哈希表与中间数组随帧复用，点数不增长时不再分配
+ * 非线程安全：同一实例由单一线程调用 apply
+ */
+class PointCloudFilter {
+public:
+    PointCloudFilter();
+    explicit PointCloudFilter(const PointCloudFilterConfig& cfg);
+    ~PointCloudFilter();
+    PointCloudFilter(const PointCloudFilter&) = delete;
+    PointCloudFilter& operator=(const PointCloudFilter&) = delete;
+
+    // out 须已 reset 且容量不小于 in.size()；返回输出点数（写入前清空 out）
+    std::uint32_t apply(const PointCloudView& in, PointCloudWriter& out);
+
+    const PointCloudFilterConfig& config() const noexcept { return cfg_; }
+    std::size_t threads() const noexcept;
+    const PointCloudFilterStats& stats() const noexcept { return stats_; }
+
+private:
+    struct Shard;
+
+    void markKept(const PointCloudView& in, std::size_t begin, std::size_t end, Shard& shard);
+    // 被保留点的栅格（withZ=false）或体素键及其哈希；丢弃点的键为空
+    void computeKeys(const PointCloudView& in, std::size_t begin, std::size_t end, float cell, bool withZ);
+    void removeGround(const PointCloudView& in, std::size_t shard);
+    void voxelize(const PointCloudView& in, std::size_t shard);
+    void writeVoxels(const PointCloudView& in, std::size_t shard, std::uint32_t base, PointCloudWriter& out);
+    void compact(const PointCloudView& in, PointCloudWriter& out);
+    std::size_t shardOf(std::uint64_t hash) const noexcept;
+
+    PointCloudFilterConfig cfg_;
+    std::unique_ptr<core::WorkerGroup> workers_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<std::uint8_t> keep_;  // 每点：1 保留 / 0 丢弃
+    std::vector<std::uint64_t> keys_;
+    std::vector<std::uint64_t> hashes_;
+    std::vector<std::uint32_t> slots_;  // 地面去除：每点所在栅格在其分片表中的下标
+    PointCloudFilterStats stats_;
+};
+
+/**
+ * PointCloudFilterNode - 接在 LidarSourceNode::pointcloud_out 之后
+ *
+ * 输入为 PointCloudPacket 或 PointXYZI 数组（后者先转置为 SoA），输出 PointCloudPacket（时间戳沿用输入）。
+ * 输出缓冲容量按输出点数取 2 的幂档位、从缓冲池复用，下游收到的字节数随降采样比例缩小。
+ * sink 只保留最新一帧、process() 处理：处理慢于输入时丢弃旧帧，每帧延迟有界。
+ * 参数：voxel_size、min_range、max_range、x_min/x_max/y_min/y_max/z_min/z_max、
+ * ground_cell、ground_height、threads
+ */
+class PointCloudFilterNode : public core::Node, public core::BranchIdleSink {
+public:
+    PointCloudFilterNode();
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void stop() override;
+    void process() override;
+    void releaseIdleBuffers() override;
+
+    const PointCloudFilterConfig& config() const noexcept { return cfg_; }
+    std::uint64_t scans() const noexcept { return scans_.load(std::memory_order_relaxed); }
+    std::uint64_t droppedScans() const noexcept { return droppedScans_.load(std::memory_order_relaxed); }
+    std::uint64_t inputPoints() const noexcept { return inputPoints_.load(std::memory_order_relaxed); }
+    std::uint64_t outputPoints() const noexcept { return outputPoints_.load(std::memory_order_relaxed); }
+    std::int64_t lastLatencyNs() const noexcept { return lastLatencyNs_.load(std::memory_order_relaxed); }
+
+private:
+    core::Pad* sinkPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
+    core::Pad* srcPad_{nullptr};
+    PointCloudFilterConfig cfg_;
+    std::unique_ptr<PointCloudFilter> filter_;
+    std::mutex pendingMutex_;
+    core::BufferRef pending_;
+    std::vector<std::uint8_t> transposed_;  // PointXYZI 输入转置后的 SoA 包
+    std::vector<std::uint8_t> scratch_;     // 滤波结果（容量为输入点数），按实际点数拷入输出缓冲
+    core::BufferPool pool_;
+    std::atomic<std::uint64_t> scans_{0};
+    std::atomic<std::uint64_t> droppedScans_{0};
+    std::atomic<std::uint64_t> inputPoints_{0};
+    std::atomic<std::uint64_t> outputPoints_{0};
+    std::atomic<std::int64_t> lastLatencyNs_{0};
+};
+
+} // namespace falconmind::sdk::sensors
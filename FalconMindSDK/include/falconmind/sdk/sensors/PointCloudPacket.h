@@ -0,0 +1,114 @@
+// FalconMindSDK - 点云在 Pad 上传递的结构数组（SoA）包格式（头 + 按字段连续排列的数组）
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace falconmind::sdk::sensors {
+
+/**
+ * 包头之后依次为 capacity 长度的字段数组（各数组起点 16 字节对齐，可直接做 SIMD 处理）：
+ *   float x[]、y[]、z[]、intensity[]；uint32 timeOffsetNs[]（相对扫描起始）；uint16 ring[]（线号，无则为 0）
+ * 前 count 个元素有效。capacity 在分配时确定，逐帧复用同一块缓冲，不随点数变化重新分配。
+ * LidarSourceNode 的二进制文件（.bin/.pcd）与 UDP 包解析路径输出此格式；ASCII/捕获文件回放仍为 PointXYZI 数组，
+ * 接收方以 isPointCloudPacket() 区分。
+ */
+struct PointCloudPacket {
+    char magic[4]{'F', 'M', 'P', 'C'};
+    std::uint32_t count{0};
+    std::uint32_t capacity{0};
+    std::uint32_t reserved{0};
+    std::int64_t timestampNs{0};  // 扫描起始时刻（PipelineClock 时基）
+    std::uint64_t frameIndex{0};
+};
+
+inline constexpr std::uint32_t pointCloudCapacityAligned(std::uint32_t capacity) {
+    return (capacity + 7u) & ~7u;  // 8 个元素对齐：float/uint32 数组 32 字节、uint16 数组 16 字节对齐
+}
+
+/** 整个包大小（capacity 按 pointCloudCapacityAligned 对齐后计算） */
+inline std::size_t pointCloudPacketSize(std::uint32_t capacity) {
+    std::size_t n = pointCloudCapacityAligned(capacity);
+    return sizeof(PointCloudPacket) + n * (5 * sizeof(float) + sizeof(std::uint16_t));
+}
+
+inline bool isPointCloudPacket(const void* data, std::size_t size) {
+    return data && size >= sizeof(PointCloudPacket) && std::memcmp(data, "FMPC", 4) == 0;
+}
+
+// 只读视图；包不完整时返回 false
+struct PointCloudView {
+    const PointCloudPacket* header{nullptr};
+    const float* x{nullptr};
+    const float* y{nullptr};
+    const float* z{nullptr};
+    const float* intensity{nullptr};
+    const std::uint32_t* timeOffsetNs{nullptr};
+    const std::uint16_t* ring{nullptr};
+
+    std::uint32_t size() const noexcept { return header ? header->count : 0; }
+
+    bool attach(const void* data, std::size_t size) noexcept {
+        if (!isPointCloudPacket(data, size)) return false;
+        auto* h = static_cast<const PointCloudPacket*>(data);
+        if (h->capacity != pointCloudCapacityAligned(h->capacity) || h->count > h->capacity ||
+            size < pointCloudPacketSize(h->capacity)) {
+            return false;
+        }
+        header = h;
+        auto* base = reinterpret_cast<const float*>(h + 1);
+        x = base;
+        y = base + h->capacity;
+        z = base + 2 * h->capacity;
+        intensity = base + 3 * h->capacity;
+        timeOffsetNs = reinterpret_cast<const std::uint32_t*>(base + 4 * h->capacity);
+        ring = reinterpret_cast<const std::uint16_t*>(timeOffsetNs + h->capacity);
+        return true;
+    }
+};
+
+// 在预分配的缓冲上就地写点；写满 capacity 后 append 返回 false（调用方计入截断）
+struct PointCloudWriter {
+    PointCloudPacket* header{nullptr};
+    float* x{nullptr};
+    float* y{nullptr};
+    float* z{nullptr};
+    float* intensity{nullptr};
+    std::uint32_t* timeOffsetNs{nullptr};
+    std::uint16_t* ring{nullptr};
+
+    // size 须不小于 pointCloudPacketSize(capacity)；写入包头（count 清零）
+    bool reset(void* data, std::size_t size, std::uint32_t capacity) noexcept {
+        capacity = pointCloudCapacityAligned(capacity);
+        if (!data || size < pointCloudPacketSize(capacity)) return false;
+        header = new (data) PointCloudPacket{};
+        header->capacity = capacity;
+        auto* base = reinterpret_cast<float*>(header + 1);
+        x = base;
+        y = base + capacity;
+        z = base + 2 * capacity;
+        intensity = base + 3 * capacity;
+        timeOffsetNs = reinterpret_cast<std::uint32_t*>(base + 4 * capacity);
+        ring = reinterpret_cast<std::uint16_t*>(timeOffsetNs + capacity);
+        return true;
+    }
+
+    bool full() const noexcept { return header->count >= header->capacity; }
+
+    bool append(float px, float py, float pz, float pi, std::uint32_t dtNs, std::uint16_t r) noexcept {
+        std::uint32_t n = header->count;
+        if (n >= header->capacity) return false;
+        x[n] = px;
+        y[n] = py;
+        z[n] = pz;
+        intensity[n] = pi;
+        timeOffsetNs[n] = dtNs;
+        ring[n] = r;
+        header->count = n + 1;
+        return true;
+    }
+};
+
+} // namespace falconmind::sdk::sensors
@@ -1,4 +1,6 @@
 // FalconMindSDK - 传感器通用类型（点云、IMU、GNSS 等）
+// 各类型的 timestampNs 均为 PipelineClock（CLOCK_MONOTONIC）时基：带硬件时钟的来源经 core::TimeSyncService 映射，
+// 不同传感器的采样可直接按时间戳比较、二分对齐
 #pragma once
 
 #include <cstdint>
@@ -28,6 +30,16 @@ struct GnssSample {
     float hdop{99.f};
     int numSatellites{0};
     std::uint64_t timestampNs{0};
+    // 以下字段由 NMEA RMC/GSA/VTG 或 UBX NAV-PVT 填写，未收到时保持默认值
+    std::uint8_t fixQuality{0};     // 同 GGA 定位质量：0 无效 1 单点 2 差分 4 RTK 固定 5 RTK 浮点
+    float pdop{99.f};
+    float vdop{99.f};
+    float speedMps{0.f};            // 地速
+    float courseDeg{0.f};           // 航迹向（真北）
+    float velNorth{0.f}, velEast{0.f}, velDown{0.f};  // m/s（UBX）
+    float horizontalAccuracyM{0.f}; // 接收机估计的精度（UBX hAcc/vAcc）；0 表示未知
+    float verticalAccuracyM{0.f};
+    std::int64_t utcTimeNs{0};      // 定位时刻 UTC（Unix 纪元起纳秒）；日期未知时为 0
 };
 
 } // namespace falconmind::sdk::sensors
@@ -0,0 +1,156 @@
+// FalconMindSDK - RTSP/UDP 网络视频取流：硬件解码（MPP / NVDEC）直出 NV12 帧 + 抖动缓冲
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/BufferPool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace falconmind::sdk::sensors {
+
+// VideoSourceConfig::decoder 的取值
+enum class StreamDecoder : std::uint8_t {
+    Auto,      // 依次尝试 RK_HW、NVDEC，均不可用时软件解码
+    RkHw,      // Rockchip MPP（FFmpeg *_rkmpp 解码器）
+    Nvdec,     // NVIDIA NVDEC（FFmpeg *_cuvid 解码器）
+    SwFfmpeg,  // FFmpeg 软件解码
+};
+
+// "RK_HW"/"NVDEC"/"SW_FFMPEG"（大小写不敏感）；空串或无法识别时为 Auto
+StreamDecoder parseStreamDecoder(const std::string& name) noexcept;
+const char* streamDecoderName(StreamDecoder decoder) noexcept;
+// 是否以 FALCONMINDSDK_BUILD_FFMPEG_INGEST 编译（否则 StreamIngest::start() 总是失败）
+bool streamIngestAvailable() noexcept;
+// uri 是否为网络流地址（rtsp:// rtsps:// udp:// rtp:// srt://）
+bool isStreamUri(const std::string& uri) noexcept;
+
+/**
+ * JitterBuffer - 按流时间戳（PTS）重排并平滑网络到达抖动
+ *
+ * - 流时间到本地时间的映射取观测到的最小 (到达时刻 - PTS)，即传输最快的一帧（缓慢上调以跟随发送端时钟漂移）；
+ *   每帧在 PTS + 映射 + delay 时出队，到达抖动不超过 delay 时输出间隔与 PTS 间隔一致
+ * - PTS 早于已出队帧的迟到帧直接丢弃；缓冲已满时丢弃最早一帧（优先保证实时性）
+ * - PTS 跳变超过 1 秒（流重连、编码器重启）时重建映射
+ * - delay 为 0 时即到即出（低延迟模式）
+ * 非线程安全：StreamIngest 在自身锁内使用
+ */
+class JitterBuffer {
+public:
+    struct Config {
+        std::int64_t delayNs{100'000'000};
+        std::size_t capacity{6};
+    };
+
+    JitterBuffer();
+    explicit JitterBuffer(const Config& cfg);
+
+    // arrivalNs 为到达（解码完成）时刻，PipelineClock 时基；返回 false 表示迟到被丢弃
+    bool push(core::BufferRef frame, std::int64_t ptsNs, std::int64_t arrivalNs);
+    // 取出一帧在 nowNs 前到期的帧（PTS 最小者），captureNs 为 PTS 映射到的本地时刻；无到期帧时返回 false
+    bool pop(std::int64_t nowNs, core::BufferRef& frame, std::int64_t& captureNs);
+    // 最早一帧的出队时刻；为空时返回 -1
+    std::int64_t nextDueNs() const noexcept;
+    void clear();
+
+    std::size_t size() const noexcept { return frames_.size(); }
+    std::uint64_t lateDrops() const noexcept { return lateDrops_; }
+    std::uint64_t overflowDrops() const noexcept { return overflowDrops_; }
+    const Config& config() const noexcept { return cfg_; }
+
+private:
+    struct Entry {
+        core::BufferRef frame;
+        std::int64_t ptsNs;
+    };
+
+    Config cfg_;
+    std::deque<Entry> frames_;  // 按 PTS 升序
+    bool mapped_{false};
+    std::int64_t offsetNs_{0};  // 本地时刻 = PTS + offsetNs_
+    bool released_{false};
+    std::int64_t lastReleasedPtsNs_{0};
+    std::uint64_t lateDrops_{0};
+    std::uint64_t overflowDrops_{0};
+};
+
+struct StreamIngestConfig {
+    std::string uri;
+    StreamDecoder decoder{StreamDecoder::Auto};
+    std::string transport{"tcp"};     // RTSP 传输方式：tcp/udp
+    std::int64_t jitterNs{100'000'000};
+    std::size_t jitterCapacity{6};
+    // 低延迟：关闭解复用缓冲与解码帧级多线程/重排，跳过抖动缓冲（解码完成即推送）
+    bool lowLatency{false};
+    int timeoutMs{5000};        // 打开/读取超时；超时后断开并重连
+    int reconnectDelayMs{1000};
+};
+
+struct StreamIngestStats {
+    std::uint64_t packets{0};
+    std::uint64_t decodedFrames{0};
+    std::uint64_t deliveredFrames{0};
+    std::uint64_t decodeErrors{0};
+    std::uint64_t reconnects{0};
+    std::uint64_t lateDrops{0};      // 抖动缓冲丢弃的迟到帧
+    std::uint64_t overflowDrops{0};  // 抖动缓冲已满丢弃的帧
+};
+
+/**
+ * StreamIngest - 网络视频取流
+ *
+ * 取流线程解复用并解码（需 FFmpeg；MPP/NVDEC 经 FFmpeg 的 h264_rkmpp/hevc_rkmpp、h264_cuvid/hevc_cuvid
+ * 解码器接入），解码输出直接写入调用方的帧缓冲池：缓冲布局为 CameraFramePacket + NV12（行宽为偶数对齐的宽度），
+ * 与 CameraSourceNode 的 NV12 帧一致，下游可直接消费。
+ * 非低延迟模式下帧先进入 JitterBuffer，由输出线程按到期时刻回调；低延迟模式下在取流线程直接回调。
+ * 回调的 captureNs 为 PTS 映射到的本地时刻（PipelineClock 时基）。连接断开或超时后按 reconnectDelayMs 自动重连。
+ */
+class StreamIngest {
+public:
+    using FrameCallback = std::function<void(core::BufferRef frame, std::int64_t captureNs)>;
+
+    StreamIngest(const StreamIngestConfig& cfg, core::BufferPool& pool);
+    ~StreamIngest();
+    StreamIngest(const StreamIngest&) = delete;
+    StreamIngest& operator=(const StreamIngest&) = delete;
+
+    // 同步打开流与解码器（失败返回 false），成功后启动取流线程
+    bool start(FrameCallback onFrame);
+    void stop();
+    bool running() const noexcept { return running_.load(std::memory_order_relaxed); }
+
+    // 实际使用的解码器（start 成功后有效）
+    StreamDecoder activeDecoder() const noexcept { return activeDecoder_.load(std::memory_order_relaxed); }
+    StreamIngestStats stats() const;
+
+private:
+    struct Backend;
+
+    void ingestLoop();
+    void outputLoop();
+    // 解码得到的一帧：低延迟模式直接回调，否则进入抖动缓冲
+    void enqueue(core::BufferRef frame, std::int64_t ptsNs, std::int64_t arrivalNs);
+
+    StreamIngestConfig cfg_;
+    core::BufferPool& pool_;
+    FrameCallback onFrame_;
+    std::unique_ptr<Backend> backend_;
+    std::atomic<bool> running_{false};
+    std::atomic<StreamDecoder> activeDecoder_{StreamDecoder::Auto};
+    std::thread ingestThread_;
+    std::thread outputThread_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    JitterBuffer jitter_;
+    StreamIngestStats stats_;  // mutex_ 保护
+};
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,52 @@
+// FalconMindSDK - 跟踪 ROI：按跟踪器预测的目标位置给出相机裁剪窗口
+#pragma once
+
+#include "falconmind/sdk/sensors/ImageTransform.h"
+
+#include <cstdint>
+#include <mutex>
+
+namespace falconmind::sdk::sensors {
+
+struct TrackedRoiConfig {
+    // 目标更新超过该时长未刷新视为丢失：窗口停在最后位置，再过同样时长后回到画面中心重新搜索
+    int lostTimeoutMs{1000};
+    // 速度外推的最长时长（跟踪结果相对采集滞后时补偿检测时延，超出部分不再外推）
+    int maxExtrapolationMs{200};
+};
+
+/**
+ * TrackedRoi - 相机节点与跟踪节点共享的 ROI 窗口控制器
+ *
+ * - TrackingTransformNode 每次更新后调用 setTarget()（源全幅像素坐标的目标中心与速度）
+ * - CameraSourceNode 对每帧调用 window() 取得该帧采集时刻的裁剪窗口：中心按速度外推到 captureNs，
+ *   窗口尺寸固定（下游 caps 不变），超出画面时贴边；无目标时居中
+ * 线程安全：各方法可在任意线程调用。
+ */
+class TrackedRoi {
+public:
+    explicit TrackedRoi(TrackedRoiConfig config = {});
+
+    // 目标中心 (cx, cy) 与速度（像素/秒），timestampNs 为对应源帧的采集时刻（PipelineClock）
+    void setTarget(float cx, float cy, float vxPerSec, float vyPerSec, std::int64_t timestampNs);
+    void clearTarget();
+    // captureNs 时刻是否仍有未超时的目标
+    bool tracking(std::int64_t captureNs) const;
+
+    // width×height 窗口在 sourceWidth×sourceHeight 源图中的位置（完全位于源图内）
+    ImageRect window(std::int64_t captureNs, int width, int height, int sourceWidth, int sourceHeight) const;
+
+    const TrackedRoiConfig& config() const noexcept { return config_; }
+
+private:
+    TrackedRoiConfig config_;
+    mutable std::mutex mutex_;
+    bool hasTarget_{false};
+    float cx_{0.f};
+    float cy_{0.f};
+    float vx_{0.f};
+    float vy_{0.f};
+    std::int64_t timestampNs_{0};
+};
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,60 @@
+// FalconMindSDK - 视频格式转换节点（Pipeline::link 协商失败时自动插入）
+#pragma once
+
+#include "falconmind/sdk/core/BranchSwitch.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/BufferPool.h"
+#include "falconmind/sdk/core/Caps.h"
+#include "falconmind/sdk/sensors/PixelFusion.h"
+
+#include <cstdint>
+#include <mutex>
+
+namespace falconmind::sdk::sensors {
+
+// 是否支持 from → to 的像素转换（相同格式视为支持）
+bool canConvertPixels(core::PixelFormat from, core::PixelFormat to) noexcept;
+
+/**
+ * 像素格式转换：src 为 from 格式、行宽 srcStride 字节（NV12 为 Y 平面行宽，UV 平面紧随 Y 平面）；
+ * dst 按 to 格式紧凑排列（大小见 core::pixelFormatFrameBytes）。不支持的组合返回 false。
+ */
+bool convertPixels(core::PixelFormat from, const std::uint8_t* src, std::int32_t srcStride,
+                   core::PixelFormat to, std::uint8_t* dst, std::int32_t width, std::int32_t height);
+
+/**
+ * VideoConvertNode - sink 收到 CameraFramePacket 帧，按协商的输出格式转换后从 src 推出。
+ * 输入格式取自 BufferMeta::video，未填写时使用 sink Pad 的协商结果；输入输出格式相同时直接转发。
+ * 输出为 RGB8/BGR8 时可作为像素融合链的解码阶段（见 FusablePixelStage）。
+ */
+class VideoConvertNode : public core::Node, public core::BranchIdleSink, public FusablePixelStage {
+public:
+    VideoConvertNode();
+
+    bool start() override;
+    void stop() override;
+    void process() override;
+
+    core::PixelFormat inputFormat() const noexcept { return inputFormat_; }
+    core::PixelFormat outputFormat() const noexcept { return outputFormat_; }
+
+    core::Pad* fusionInputPad() const noexcept override { return sinkPad_; }
+    core::Pad* fusionOutputPad() const noexcept override { return srcPad_; }
+    bool canFuse() const noexcept override;
+    bool planFusedFrame(const FusedImageInfo& in, FusedStagePlan& out) override;
+
+    void releaseIdleBuffers() override;
+
+private:
+    core::Pad* sinkPad_{nullptr};  // addPad 返回，避免逐帧按名称查找
+    core::Pad* srcPad_{nullptr};
+    std::mutex frameMutex_;
+    core::BufferRef pending_;
+    core::BufferPool pool_;
+    core::PixelFormat inputFormat_{core::PixelFormat::Any};
+    core::PixelFormat outputFormat_{core::PixelFormat::Any};
+    std::int32_t fps_{0};
+};
+
+} // namespace falconmind::sdk::sensors
@@ -22,7 +22,17 @@ struct VideoSourceConfig {
     unsigned int  height{0};
     double        fps{0.0};
     std::string   pixelFormat;  // NV12/RGB8/...
-    std::string   decoder;      // RK_HW/NVDEC/SW_FFMPEG/...
+    std::string   decoder;      // RK_HW/NVDEC/SW_FFMPEG/...（网络流解码器，空为自动选择，见 StreamIngest）
+    bool          zeroCopy{false};  // V4L2 原生格式直出时推送驱动缓冲本身（见 CameraSourceNode）
+    unsigned int  bufferCount{4};   // V4L2 采集缓冲数（2~32，驱动可能调整）
+    bool          captureThread{true};  // V4L2 由节点自有采集线程 poll 取帧；false 时在 process() 中阻塞 DQBUF
+    std::string   streamTransport{"tcp"};  // RTSP 传输方式：tcp/udp
+    unsigned int  jitterMs{100};           // 网络流抖动缓冲时长
+    bool          lowLatency{false};       // 网络流低延迟：关闭解复用/解码缓冲，跳过抖动缓冲
+    unsigned int  roiWidth{0};    // 跟踪 ROI 输出宽高：非 0 时只输出该尺寸的裁剪窗口（位置见 TrackedRoi）
+    unsigned int  roiHeight{0};
+    std::string   mjpeg{"auto"};       // V4L2 MJPEG 采集：auto（原始格式达不到请求尺寸时）/prefer/off
+    std::string   jpegDecoder{"auto"};  // MJPEG 解码器：auto/mpp/nvjpeg/turbo（见 JpegDecoder）
 };
 
 } // namespace falconmind::sdk::sensors
@@ -0,0 +1,194 @@
+// FalconMindSDK - 视频下传：硬件编码（MPP / NVENC）H.264/H.265 经 RTP/SRT 发送，检测框随帧写入 SEI
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/perception/DetectionResultPacket.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::sensors {
+
+enum class VideoCodec : std::uint8_t {
+    H264,
+    H265,
+};
+
+enum class VideoEncoder : std::uint8_t {
+    Auto,      // 依次尝试 RK_HW、NVENC，均不可用时软件编码
+    RkHw,      // Rockchip MPP（FFmpeg *_rkmpp 编码器），DMABUF 帧经 DRM PRIME 直接导入
+    Nvenc,     // NVIDIA NVENC（FFmpeg *_nvenc 编码器）
+    SwFfmpeg,  // libx264 / libx265
+};
+
+// "H264"/"H265"/"HEVC"（大小写不敏感）；无法识别时为 H264
+VideoCodec parseVideoCodec(const std::string& name) noexcept;
+const char* videoCodecName(VideoCodec codec) noexcept;
+// "RK_HW"/"NVENC"/"SW_FFMPEG"（大小写不敏感）；空串或无法识别时为 Auto
+VideoEncoder parseVideoEncoder(const std::string& name) noexcept;
+const char* videoEncoderName(VideoEncoder encoder) noexcept;
+// 是否以 FALCONMINDSDK_BUILD_VIDEO_UPLINK 编译（否则 VideoUplink::start() 总是失败）
+bool videoUplinkAvailable() noexcept;
+
+// ---------------------------------------------------------------------------
+// SEI 叠加元数据
+//
+// 每帧的检测 / 跟踪框写成一个 user_data_unregistered SEI（payloadType 5，H.264 NAL 6 / H.265 前缀 SEI NAL 39），
+// 以 kOverlaySeiUuid 标识。载荷（小端）：
+//   uuid[16] | version u8 | reserved u8 | count u16 | frameIndex u32 | captureNs i64 |
+//   count × { trackId i32 | classId i16 | score u8（×255）| reserved u8 | x y w h u16（按帧宽高归一化 ×65535）}
+// 坐标归一化后与地面端的显示分辨率无关；captureNs 为检测所属源帧的采集时刻，
+// 地面端据此把框对齐到同一采集时刻的画面（检测晚于画面到达时也能对齐）。
+
+struct OverlayBox {
+    std::int32_t trackId{-1};  // 未跟踪为 -1
+    std::int32_t classId{0};
+    float score{0.0f};
+    float x{0.0f};  // 左上角与宽高，归一化到 [0, 1]
+    float y{0.0f};
+    float width{0.0f};
+    float height{0.0f};
+};
+
+struct OverlayMetadata {
+    std::uint32_t frameIndex{0};
+    std::int64_t captureNs{0};
+    std::vector<OverlayBox> boxes;
+};
+
+extern const std::uint8_t kOverlaySeiUuid[16];
+constexpr std::uint8_t kOverlaySeiVersion = 1;
+
+// 追加一个 Annex B SEI NAL（起始码 + NAL 头 + 已加防竞争字节的 RBSP）到 out；返回追加的字节数
+std::size_t appendOverlaySei(VideoCodec codec, const OverlayMetadata& meta, std::vector<std::uint8_t>& out);
+// 在 Annex B 码流（一个访问单元）中查找带 kOverlaySeiUuid 的 SEI 并解析到 out；未找到或格式错误返回 false
+bool findOverlaySei(VideoCodec codec, const std::uint8_t* data, std::size_t size, OverlayMetadata& out);
+// 把检测结果转换为叠加元数据（按帧宽高归一化并裁剪到 [0, 1]），复用 out.boxes 的容量
+void overlayFromDetections(const perception::DetectionResultView& dets, int frameWidth, int frameHeight,
+                           OverlayMetadata& out);
+
+/**
+ * VideoBitrateController - 依链路质量与发送拥塞调整目标码率（AIMD）
+ *
+ * - 链路质量 q（0–1，>1 按百分比）决定上限：minKbps + (maxKbps - minKbps) × q；未知时上限为 maxKbps
+ * - 每个 interval 评估一次：期间发生过拥塞（发送阻塞 / 编码来不及丢帧）则乘以 backoff，
+ *   否则加 stepUpKbps；目标高于上限时直接降到上限（链路变差立即生效）
+ * 非线程安全：VideoUplink 在自身锁内使用
+ */
+class VideoBitrateController {
+public:
+    struct Config {
+        int minKbps{300};
+        int maxKbps{4000};
+        int startKbps{1500};
+        int stepUpKbps{100};
+        double backoff{0.7};
+        std::int64_t intervalNs{500'000'000};
+    };
+
+    VideoBitrateController();
+    explicit VideoBitrateController(const Config& cfg);
+
+    void setLinkQuality(double quality) noexcept;
+    void onCongestion() noexcept { congested_ = true; }
+    // 到达评估周期时更新目标码率；目标变化时返回 true
+    bool update(std::int64_t nowNs) noexcept;
+
+    int targetKbps() const noexcept { return targetKbps_; }
+    int ceilingKbps() const noexcept;
+    const Config& config() const noexcept { return cfg_; }
+
+private:
+    Config cfg_;
+    int targetKbps_;
+    double quality_{-1.0};  // <0 表示未知
+    bool congested_{false};
+    std::int64_t lastUpdateNs_{-1};
+};
+
+struct VideoUplinkConfig {
+    std::string uri;  // rtp://host:port（RTP 封装）或 srt://host:port（MPEG-TS over SRT）
+    VideoCodec codec{VideoCodec::H264};
+    VideoEncoder encoder{VideoEncoder::Auto};
+    int fps{30};
+    int gopFrames{30};  // 关键帧间隔；SPS/PPS 随关键帧在带内重复，地面端可随时加入
+    VideoBitrateController::Config bitrate;
+    bool overlaySei{true};
+    int srtLatencyMs{120};
+    int timeoutMs{2000};  // 单次发送超时：超时视为拥塞，丢弃该包
+};
+
+struct VideoUplinkStats {
+    std::uint64_t submittedFrames{0};
+    std::uint64_t encodedFrames{0};
+    std::uint64_t droppedFrames{0};   // 编码线程未及处理、被新帧替换的帧
+    std::uint64_t sentPackets{0};
+    std::uint64_t sentBytes{0};
+    std::uint64_t seiFrames{0};       // 携带检测框 SEI 的帧
+    std::uint64_t encodeErrors{0};
+    std::uint64_t sendErrors{0};
+    std::uint64_t bitrateChanges{0};
+    std::uint64_t encoderRestarts{0};  // 分辨率 / 内存类型变化导致的编码器重建
+    int targetKbps{0};
+};
+
+/**
+ * VideoUplink - 视频编码与发送
+ *
+ * submit() 只持有帧缓冲引用（CameraFramePacket + NV12，与 CameraSourceNode / StreamIngest 的帧一致），
+ * 像素不经 CPU 拷贝：带 DMABUF 的帧以 DRM PRIME 描述符交给 MPP 编码器，其余帧以 av_buffer_create
+ * 直接包装缓冲池内存交给编码器（NVENC 经驱动上传到显存，这一步由硬件 DMA 完成）。
+ * 编码线程只保留最新一帧：编码来不及时旧帧被替换并计为拥塞，延迟不累积。
+ * 编码器与输出在首帧（得知尺寸后）打开，尺寸变化时重建；目标码率变化时运行时重配置编码器。
+ * 检测框 SEI 插入在访问单元的 AUD 之后、首个 VCL NAL 之前，只复制编码后的码流。
+ */
+class VideoUplink {
+public:
+    explicit VideoUplink(const VideoUplinkConfig& cfg);
+    ~VideoUplink();
+    VideoUplink(const VideoUplink&) = delete;
+    VideoUplink& operator=(const VideoUplink&) = delete;
+
+    // 校验配置并启动编码线程；未以 FFmpeg 编译时返回 false
+    bool start();
+    void stop();
+    bool running() const noexcept { return running_.load(std::memory_order_relaxed); }
+
+    // 提交一帧待编码（overlay 可为空）；非阻塞
+    void submit(core::BufferRef frame, const OverlayMetadata* overlay);
+    // 链路质量（0–1 或百分比），来自遥测 linkQuality
+    void setLinkQuality(double quality);
+
+    VideoEncoder activeEncoder() const noexcept { return activeEncoder_.load(std::memory_order_relaxed); }
+    // RTP 输出的 SDP（首帧打开输出后有效），地面端据此接收
+    std::string sdp() const;
+    VideoUplinkStats stats() const;
+
+private:
+    struct Backend;
+
+    void encodeLoop();
+
+    VideoUplinkConfig cfg_;
+    std::unique_ptr<Backend> backend_;
+    std::atomic<bool> running_{false};
+    std::atomic<VideoEncoder> activeEncoder_{VideoEncoder::Auto};
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    core::BufferRef pending_;           // mutex_ 保护，下同
+    OverlayMetadata pendingOverlay_;
+    bool pendingHasOverlay_{false};
+    VideoBitrateController controller_;
+    VideoUplinkStats stats_;
+    std::string sdp_;
+};
+
+} // namespace falconmind::sdk::sensors
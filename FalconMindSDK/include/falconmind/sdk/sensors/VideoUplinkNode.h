@@ -0,0 +1,80 @@
+// FalconMindSDK - VideoUplinkNode：流水线帧硬件编码后经 RTP/SRT 下传地面，检测 / 跟踪框随帧写入 SEI
+#pragma once
+
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/sensors/VideoUplink.h"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace falconmind::sdk::sensors {
+
+/**
+ * VideoUplinkNode - video_in 收 NV12 CameraFramePacket 帧，detection_in 收 DetectionResultPacket（检测或跟踪输出）
+ *
+ * 帧以缓冲引用交给 VideoUplink 编码（零拷贝）；每帧的 SEI 携带与之最匹配的检测结果：
+ * 采集时刻相同的结果优先，否则取最近一次结果（SEI 内标注其所属帧的采集时刻，地面端据此对齐）。
+ * sync_window_ms > 0 时帧最多等待该时长以拿到本帧的检测结果，以少量延迟换取框与画面严格同步
+ * （等待期间只持有缓冲引用，最多 kMaxHeldFrames 帧）。
+ * 目标码率随 TelemetryPublisher 遥测中的 linkQuality 与发送拥塞自适应调整。
+ *
+ * configure 参数：
+ *   uri                       rtp://host:port 或 srt://host:port（必填）
+ *   codec                     h264（默认）/ h265
+ *   encoder                   auto（默认，RK_HW → NVENC → 软件）/ rk_hw / nvenc / sw_ffmpeg
+ *   fps / gop                 帧率（默认 30）与关键帧间隔（默认 30 帧）
+ *   bitrate_kbps / min_bitrate_kbps / max_bitrate_kbps   起始与上下限（默认 1500 / 300 / 4000）
+ *   overlay                   是否写入检测框 SEI（默认 true）
+ *   sync_window_ms            等待本帧检测结果的最长时间（默认 0：不等待）
+ *   uav_id                    只采用该 UAV 遥测的链路质量（默认采用全部遥测）
+ *   srt_latency_ms            SRT 接收端重传缓冲（默认 120）
+ */
+class VideoUplinkNode : public core::Node {
+public:
+    static constexpr std::size_t kMaxHeldFrames = 4;
+    static constexpr std::size_t kRecentDetections = 8;
+
+    VideoUplinkNode();
+    ~VideoUplinkNode() override;
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void stop() override;
+    void process() override;
+
+    const VideoUplinkConfig& config() const noexcept { return cfg_; }
+    // 编码与发送统计（start() 之前为全零）
+    VideoUplinkStats stats() const;
+    // RTP 输出的 SDP（首帧编码后有效）
+    std::string sdp() const;
+
+private:
+    // 检测结果的原始包（按采集时刻匹配帧时才解析）
+    struct DetectionPacket {
+        std::int64_t captureNs{0};
+        std::vector<std::uint8_t> bytes;
+    };
+
+    void submitFrame(core::BufferRef frame, const DetectionPacket* dets);
+
+    core::Pad* videoPad_{nullptr};
+    core::Pad* detectionPad_{nullptr};
+    VideoUplinkConfig cfg_;
+    std::int64_t syncWindowNs_{0};
+    std::string uavId_;
+    std::shared_ptr<VideoUplink> uplink_;  // 遥测订阅回调同样持有，取消订阅后仍可能有在途调用
+    int telemetrySubId_{0};
+
+    std::mutex mutex_;
+    std::deque<core::BufferRef> frames_;            // mutex_ 保护，下同
+    std::deque<DetectionPacket> detections_;         // 按到达顺序，最多 kRecentDetections 条
+    std::vector<std::vector<std::uint8_t>> spare_;  // 回收的检测包缓冲，避免每包分配
+    OverlayMetadata overlay_;                        // 仅 process 线程使用
+};
+
+} // namespace falconmind::sdk::sensors
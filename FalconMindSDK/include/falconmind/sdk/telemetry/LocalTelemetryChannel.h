@@ -0,0 +1,144 @@
+// FalconMindSDK - 本机遥测广播：共享内存单写多读通道，同机进程（云台控制、OSD、载荷计算机）无锁读取最新飞行状态与检测事件
+#pragma once
+
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/telemetry/TelemetryTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace falconmind::sdk::telemetry {
+
+// 飞行状态快照（TelemetryMessage 的定长平凡可复制版本，字符串截断到定长并以 '\0' 结尾）
+struct LocalFlightState {
+    std::int64_t timestampNs{0};
+    double lat{0.0}, lon{0.0}, alt{0.0};
+    double roll{0.0}, pitch{0.0}, yaw{0.0};
+    double vx{0.0}, vy{0.0}, vz{0.0};
+    double batteryPercent{0.0};
+    double linkQuality{0.0};
+    std::int32_t batteryVoltageMv{0};
+    std::int32_t gpsFixType{0};
+    std::int32_t numSat{0};
+    std::uint32_t reserved{0};
+    char flightMode[16]{};
+    char uavId[16]{};
+};
+
+// 单条检测事件；一帧检测结果展开为多条，同帧条目 frameIndex / timestampNs 相同
+struct LocalDetectionEvent {
+    std::uint64_t sequence{0};     // 写端序号（从 0 连续递增），读端据此识别被绕圈覆盖的槽位
+    std::uint64_t timestampNs{0};  // 源帧采集时间戳
+    std::uint32_t frameIndex{0};
+    std::int32_t classId{-1};
+    std::int32_t trackId{-1};
+    float score{0.f};
+    float x{0.f}, y{0.f}, width{0.f}, height{0.f};  // 像素框
+    std::uint32_t flags{0};        // 检测结果包 flags（超出时延预算 / 跟踪器外推）
+    std::uint32_t reserved{0};
+    char className[32]{};
+};
+
+LocalFlightState toLocalFlightState(const TelemetryMessage& msg) noexcept;
+
+/**
+ * 共享内存布局（/dev/shm/<name>），与 perception::ShmPoseWriter 相同的组织方式：
+ *   header | state: SeqLock<LocalFlightState> | head | events: SeqLock<LocalDetectionEvent>[eventCapacity]
+ * 全部为无锁原子对象、无指针；C 调用方经 falconmind_sdk_c_api.h 的 fm_local_telemetry_* 读取。
+ * 飞行状态与事件各自只允许一个写线程（两者可以不同）；发布只是几次内存写，无系统调用、不分配。
+ */
+class LocalTelemetryWriter {
+public:
+    ~LocalTelemetryWriter();
+    LocalTelemetryWriter(const LocalTelemetryWriter&) = delete;
+    LocalTelemetryWriter& operator=(const LocalTelemetryWriter&) = delete;
+
+    // 同名残留通道会被替换；eventCapacity 向上取整为 2 的幂；失败返回 nullptr
+    static std::shared_ptr<LocalTelemetryWriter> create(const std::string& name, std::size_t eventCapacity = 1024);
+
+    void publishState(const LocalFlightState& state) noexcept;
+    void publishState(const TelemetryMessage& msg) noexcept { publishState(toLocalFlightState(msg)); }
+    // sequence 由写端填写
+    void publishEvent(const LocalDetectionEvent& event) noexcept;
+    // 检测结果包（v1 / v2）展开为事件；返回写入条数，包无效时返回 0
+    std::size_t publishDetections(const void* packet, std::size_t size) noexcept;
+
+    const std::string& name() const noexcept { return name_; }
+    std::uint64_t statesPublished() const noexcept;
+    std::uint64_t eventsPublished() const noexcept;
+
+    struct Mapping;
+
+private:
+    LocalTelemetryWriter(std::string name, std::shared_ptr<Mapping> mapping);
+
+    std::string name_;
+    std::shared_ptr<Mapping> mapping_;
+};
+
+/**
+ * LocalTelemetryReader - 读端：open 后所有读取只访问映射内存（无系统调用、不加锁、不分配），
+ * 可在任意频率轮询；写入进行中时自旋重试，不会读到撕裂的状态。
+ */
+class LocalTelemetryReader {
+public:
+    LocalTelemetryReader(const LocalTelemetryReader&) = delete;
+    LocalTelemetryReader& operator=(const LocalTelemetryReader&) = delete;
+
+    // 通道不存在或格式不符时返回 nullptr（可稍后重试）
+    static std::shared_ptr<LocalTelemetryReader> open(const std::string& name);
+
+    // 最新飞行状态；尚未发布过返回 false
+    bool latestState(LocalFlightState& state) const noexcept;
+    // 已发布的状态次数：与上次读取时比较即可判断是否有新状态
+    std::uint64_t stateVersion() const noexcept;
+
+    // 从 cursor（上次返回的游标，首次传 0 或 eventsPublished() 只看新事件）起按序读取至多 maxCount 条事件，
+    // 推进 cursor 并返回条数；读端落后超过环容量而被覆盖的事件计入 dropped（可为空）
+    std::size_t pollEvents(std::uint64_t& cursor, LocalDetectionEvent* out, std::size_t maxCount,
+                           std::uint64_t* dropped = nullptr) const noexcept;
+
+    // 写端已析构（应重新 open）
+    bool closed() const noexcept;
+    std::uint64_t eventsPublished() const noexcept;
+    std::size_t eventCapacity() const noexcept;
+    const std::string& name() const noexcept { return name_; }
+
+private:
+    LocalTelemetryReader(std::string name, std::shared_ptr<LocalTelemetryWriter::Mapping> mapping);
+
+    std::string name_;
+    std::shared_ptr<LocalTelemetryWriter::Mapping> mapping_;
+};
+
+/**
+ * LocalTelemetryNode - 把本机遥测广播到共享内存通道
+ *
+ * start() 创建通道并订阅 TelemetryPublisher::instance()（飞行状态，同步订阅、只做一次 SeqLock 写入）；
+ * Sink Pad "detection_in" 收到的检测结果包在生产者线程直接展开为事件写入环。
+ * 参数：channel（通道名，默认 "falconmind_telemetry"）、event_capacity（默认 1024）、
+ * uav_id（非空时只广播该 UAV 的遥测）
+ */
+class LocalTelemetryNode : public core::Node {
+public:
+    LocalTelemetryNode();
+    ~LocalTelemetryNode() override;
+
+    bool configure(const std::unordered_map<std::string, std::string>& params) override;
+    bool start() override;
+    void stop() override;
+    void process() override {}
+
+    std::shared_ptr<LocalTelemetryWriter> writer() const { return std::atomic_load(&writer_); }
+
+private:
+    std::string channel_{"falconmind_telemetry"};
+    std::size_t eventCapacity_{1024};
+    std::string uavId_;
+    int telemetrySubId_{0};
+    std::shared_ptr<LocalTelemetryWriter> writer_;  // 通过 std::atomic_load/atomic_store 访问（检测回调在生产者线程）
+};
+
+} // namespace falconmind::sdk::telemetry
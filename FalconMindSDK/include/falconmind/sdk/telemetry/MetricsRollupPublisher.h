@@ -0,0 +1,61 @@
+// FalconMindSDK - 按固定窗口把 MetricsAggregator 的汇总发布到 TelemetryPublisher
+#pragma once
+
+#include "falconmind/sdk/core/MetricsAggregator.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace falconmind::sdk::telemetry {
+
+class TelemetryPublisher;
+
+struct MetricsRollupConfig {
+    int windowMs{10000};  // 汇总窗口；机群看板每架 UAV 每窗口只收到一条几百字节的汇总
+    core::MetricsRollupOptions options;
+};
+
+/**
+ * MetricsRollupPublisher - 汇总线程
+ *
+ * 每个窗口结束时调用 aggregator.rollup() 并以 MetricsRollupMessage 发布（窗口按起始时刻对齐累加，不随处理耗时漂移）；
+ * 窗口内没有任何指标活动时不发布。stop() 发布最后一个未满窗口，析构时自动 stop()。
+ */
+class MetricsRollupPublisher {
+public:
+    MetricsRollupPublisher(core::MetricsAggregator& aggregator, TelemetryPublisher& publisher, std::string uavId,
+                           MetricsRollupConfig config = {});
+    ~MetricsRollupPublisher();
+    MetricsRollupPublisher(const MetricsRollupPublisher&) = delete;
+    MetricsRollupPublisher& operator=(const MetricsRollupPublisher&) = delete;
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running_.load(); }
+
+    // 立即结束当前窗口并发布；返回是否发布了汇总
+    bool flush();
+
+    std::uint64_t published() const noexcept { return published_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    core::MetricsAggregator& aggregator_;
+    TelemetryPublisher& publisher_;
+    std::string uavId_;
+    MetricsRollupConfig config_;
+
+    std::mutex flushMutex_;  // 串行化 flush() 与汇总线程
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    std::atomic<std::uint64_t> published_{0};
+};
+
+} // namespace falconmind::sdk::telemetry
@@ -0,0 +1,60 @@
+// FalconMindSDK - 上行遥测二进制编码（proto/telemetry.proto 的 protobuf 线格式 + 定长帧头）
+#pragma once
+
+#include "falconmind/sdk/telemetry/TelemetryTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace falconmind::sdk::telemetry {
+
+// 协商时使用的编码名（与 ClusterCenter telemetry_codec.py 的 ENCODING_NAME / DELTA_ENCODING_NAME 一致）
+constexpr const char* kTelemetryBinaryEncoding = "proto1";
+constexpr const char* kTelemetryDeltaEncoding = "proto1-delta";  // 同一帧格式，另含字段组掩码的增量帧
+
+constexpr std::uint8_t kTelemetryFrameMagic = 0xFB;  // 不会出现在 JSON 行首，TCP 流中可与 JSON 行混合
+constexpr std::uint8_t kTelemetryFrameVersion = 1;
+constexpr std::size_t kTelemetryFrameHeaderBytes = 4;  // magic | version | body 长度（u16 小端）
+constexpr std::size_t kTelemetryMaxStringBytes = 128;  // uavId / flightMode 上限
+constexpr std::size_t kTelemetryFrameMaxBytes = 512;   // 任意合法消息的完整帧不超过该长度
+
+// 字段组：增量帧的掩码位，也是 NodeAgent 按组设置发送频率的单位
+enum TelemetryFieldGroup : std::uint32_t {
+    TelemetryGroupPosition = 1u << 0,  // lat / lon / alt
+    TelemetryGroupAttitude = 1u << 1,  // roll / pitch / yaw
+    TelemetryGroupVelocity = 1u << 2,  // vx / vy / vz
+    TelemetryGroupBattery = 1u << 3,   // batteryPercent / batteryVoltageMv
+    TelemetryGroupGps = 1u << 4,       // gpsFixType / numSat
+    TelemetryGroupLink = 1u << 5,      // linkQuality
+    TelemetryGroupMode = 1u << 6,      // flightMode
+};
+constexpr std::uint32_t kTelemetryAllGroups = 0x7F;
+constexpr std::size_t kTelemetryGroupCount = 7;
+
+struct TelemetryFrameInfo {
+    bool delta{false};                         // 是否为增量帧（带掩码）
+    std::uint32_t groups{kTelemetryAllGroups}; // 帧中携带的字段组；完整帧为全部
+    bool keyframe{false};                      // 关键帧携带全部字段组，接收端可以此重建状态；完整帧视为关键帧
+    std::uint32_t seq{0};                      // 发送端每机递增的帧序号（0 表示未填写），用于发现丢帧
+};
+
+// 编码一帧到 out；返回帧长度，capacity 不足或字符串超长时返回 0（调用方可回退到 JSON）。
+// 不分配内存，典型消息约 90 字节（同样内容的 JSON 约 400 字节）
+std::size_t encodeTelemetryFrame(const TelemetryMessage& msg, std::uint8_t* out, std::size_t capacity) noexcept;
+
+// 增量帧：uavId / timestampNs 总是编码，其余只编码 info.groups 中的字段组（含默认值）；返回规则同上
+std::size_t encodeTelemetryDeltaFrame(const TelemetryMessage& msg, const TelemetryFrameInfo& info, std::uint8_t* out,
+                                      std::size_t capacity) noexcept;
+
+// 流中以 data 开头的完整帧长度：数据不足一帧返回 0，帧头非法（magic / 版本不符）返回 SIZE_MAX
+std::size_t telemetryFrameLength(const std::uint8_t* data, std::size_t size) noexcept;
+
+// 解码一帧（size 需为完整帧长度）；未知字段按线格式跳过，缺省字段取 proto3 默认值（0 / 空字符串）。
+// info 非空时返回帧类型与掩码；增量帧中未选中的字段组在 out 中为默认值，需经 mergeTelemetryGroups 合入接收端状态
+bool decodeTelemetryFrame(const std::uint8_t* data, std::size_t size, TelemetryMessage& out,
+                          TelemetryFrameInfo* info = nullptr);
+
+// 把 delta 中 groups 选中的字段组（及 uavId / timestampNs）覆盖到 state
+void mergeTelemetryGroups(const TelemetryMessage& delta, std::uint32_t groups, TelemetryMessage& state);
+
+} // namespace falconmind::sdk::telemetry
@@ -3,40 +3,125 @@
 
 #include "falconmind/sdk/telemetry/TelemetryTypes.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <vector>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace falconmind::sdk::telemetry {
 
+// 异步订阅选项
+struct AsyncSubscribeOptions {
+    // 订阅者队列容量（向上取整为 2 的幂，至少为 2）
+    std::size_t queueDepth{16};
+    // 队列满时的处理：true 丢弃最旧的一条、保留最新（合并），false 丢弃新消息
+    bool conflate{true};
+};
+
+struct SubscriberStats {
+    std::uint64_t enqueued{0};   // 进入订阅者队列的消息
+    std::uint64_t delivered{0};  // 已交给处理函数的消息
+    std::uint64_t dropped{0};    // 因队列满被丢弃（合并掉的旧消息或未入队的新消息）
+};
+
 // SDK 内部 Telemetry 发布器
 // 用于节点（如 FlightStateSourceNode）发布遥测数据，供 NodeAgent 订阅
+//
+// - 订阅表写时复制，publish 路径不加锁；处理函数中可以 subscribe / unsubscribe
+// - subscribe*：在发布线程同步调用处理函数，适合只做内存操作的轻量处理
+// - subscribeAsync*：每个订阅者拥有有界无锁队列与专用分发线程，publish 只做一次入队；
+//   处理函数阻塞（如上行 socket 拥塞）只会让该订阅者的队列合并旧消息，不影响发布者与其它订阅者
+// - 带 uavId 的订阅只收到该 UAV 的 Telemetry：发布时按 msg.uavId 查表，同进程托管大量 UAV 时
+//   每条消息只分发给对应的订阅者（与不带 uavId 的订阅共存，后者仍收到全部消息）
+// - unsubscribe 返回后异步订阅的分发线程已退出（在其自身处理函数中取消时除外）；
+//   同步订阅与 Bus 相同，并发进行中的一次发布仍可能调用到该处理函数
 class TelemetryPublisher {
 public:
     using Handler = std::function<void(const TelemetryMessage&)>;
+    using MetricsHandler = std::function<void(const PipelineMetricsMessage&)>;
+    using TrackingHandler = std::function<void(const TrackingDeltaMessage&)>;
+    using RollupHandler = std::function<void(const MetricsRollupMessage&)>;
 
     // 订阅 Telemetry 消息
     // 返回订阅 ID，可用于后续取消订阅
     int subscribe(const Handler& handler);
+    // 只订阅 uavId 的 Telemetry
+    int subscribe(const std::string& uavId, const Handler& handler);
+
+    // 订阅 Pipeline 运行时指标；与 subscribe 共用 ID 空间，同样通过 unsubscribe 取消
+    int subscribeMetrics(const MetricsHandler& handler);
+
+    // 订阅增量跟踪结果；同样通过 unsubscribe 取消
+    int subscribeTracking(const TrackingHandler& handler);
+
+    // 订阅机载指标窗口汇总；同样通过 unsubscribe 取消
+    int subscribeRollup(const RollupHandler& handler);
+
+    // 异步订阅：处理函数在该订阅专有的分发线程中按发布顺序执行
+    int subscribeAsync(const Handler& handler, const AsyncSubscribeOptions& options = {});
+    int subscribeAsync(const std::string& uavId, const Handler& handler, const AsyncSubscribeOptions& options = {});
+    int subscribeMetricsAsync(const MetricsHandler& handler, const AsyncSubscribeOptions& options = {});
+    int subscribeTrackingAsync(const TrackingHandler& handler, const AsyncSubscribeOptions& options = {});
+    int subscribeRollupAsync(const RollupHandler& handler, const AsyncSubscribeOptions& options = {});
 
     // 取消订阅
     void unsubscribe(int id);
 
+    // 异步订阅的队列统计；id 不存在或为同步订阅时返回 false
+    bool subscriberStats(int id, SubscriberStats& out) const;
+
     // 发布一条 Telemetry 消息（通知所有订阅者）
     void publish(const TelemetryMessage& msg);
 
+    // 发布一次 Pipeline 指标快照（通常由上层按固定周期调用 Pipeline::metrics() 后发布）
+    void publishMetrics(const PipelineMetricsMessage& msg);
+
+    void publishTracking(const TrackingDeltaMessage& msg);
+    bool hasTrackingSubscribers();
+
+    void publishRollup(const MetricsRollupMessage& msg);
+
     // 获取全局单例（可选，也可以由上层显式创建实例）
     static TelemetryPublisher& instance();
 
 private:
-    TelemetryPublisher() = default;
-    ~TelemetryPublisher() = default;
+    TelemetryPublisher();
+    ~TelemetryPublisher();
     TelemetryPublisher(const TelemetryPublisher&) = delete;
     TelemetryPublisher& operator=(const TelemetryPublisher&) = delete;
 
+    template <typename Msg>
+    class AsyncChannel;
+
+    template <typename Msg>
+    struct Subscription {
+        int id;
+        std::function<void(const Msg&)> handler;
+        std::shared_ptr<AsyncChannel<Msg>> async;  // 为空表示同步订阅
+    };
+    struct Subscribers {
+        std::vector<Subscription<TelemetryMessage>> telemetry;
+        std::vector<Subscription<PipelineMetricsMessage>> metrics;
+        std::vector<Subscription<TrackingDeltaMessage>> tracking;
+        std::vector<Subscription<MetricsRollupMessage>> rollups;
+        std::unordered_map<std::string, std::vector<Subscription<TelemetryMessage>>> routedTelemetry;  // uavId -> 订阅
+    };
+
+    std::shared_ptr<const Subscribers> snapshot() const;
+    template <typename Msg>
+    int add(std::vector<Subscription<Msg>> Subscribers::*list, const std::function<void(const Msg&)>& handler,
+            const AsyncSubscribeOptions* async);
+    int addRouted(const std::string& uavId, const Handler& handler, const AsyncSubscribeOptions* async);
+    template <typename Msg>
+    static void dispatch(const std::vector<Subscription<Msg>>& list, const Msg& msg);
+
+    std::mutex subscribeMutex_;  // 仅串行化订阅表的修改
     int nextId_{1};
-    std::vector<std::pair<int, Handler>> handlers_;
-    std::mutex mutex_;
+    std::shared_ptr<const Subscribers> subscribers_;  // 通过 std::atomic_load/atomic_store 访问
 };
 
 } // namespace falconmind::sdk::telemetry
@@ -1,6 +1,10 @@
 // FalconMindSDK - Telemetry message types for SDK → NodeAgent communication
 #pragma once
 
+#include "falconmind/sdk/core/MetricsAggregator.h"
+#include "falconmind/sdk/core/PipelineMetrics.h"
+#include "falconmind/sdk/perception/TrackingDelta.h"
+
 #include <string>
 #include <cstdint>
 
@@ -44,4 +48,23 @@ struct TelemetryMessage {
     std::string flightMode{"UNKNOWN"};
 };
 
+// Pipeline 运行时指标（节点耗时、连接吞吐），供 NodeAgent 上报、Viewer 展示
+struct PipelineMetricsMessage {
+    std::string uavId{"uav0"};
+    core::PipelineMetrics metrics;
+};
+
+// 机载指标窗口汇总（MetricsRollupPublisher 按窗口发布），NodeAgent 以 "metrics_rollup" 消息上报
+struct MetricsRollupMessage {
+    std::string uavId{"uav0"};
+    core::MetricsRollup rollup;
+};
+
+// 增量跟踪结果（TrackingTransformNode output_mode=delta 时发布）；订阅方用 TrackingDeltaDecoder 重建，
+// 新订阅方加入后应请求关键帧
+struct TrackingDeltaMessage {
+    std::string uavId{"uav0"};
+    perception::TrackingDelta delta;
+};
+
 } // namespace falconmind::sdk::telemetry
@@ -4,21 +4,187 @@
 #include <pybind11/functional.h>
 #include <pybind11/numpy.h>
 #include <pybind11/chrono.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <optional>
 #include <sstream>
+#include <stdexcept>
 
+#include "falconmind/sdk/core/BatchCallbackNode.h"
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/core/Caps.h"
+#include "falconmind/sdk/core/PadTapNode.h"
 #include "falconmind/sdk/core/Pipeline.h"
 #include "falconmind/sdk/core/FlowExecutor.h"
 #include "falconmind/sdk/core/NodeFactory.h"
 #include "falconmind/sdk/mission/SearchPathPlannerNode.h"
 #include "falconmind/sdk/mission/EventReporterNode.h"
 #include "falconmind/sdk/mission/SearchTypes.h"
+#include "falconmind/sdk/perception/DetectionResultPacket.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
 
 namespace py = pybind11;
 using namespace falconmind::sdk;
 
+namespace {
+
+// 与检测结果包 v2 条目布局一致，作为 NumPy 结构化 dtype 直接视图包内数据
+struct PyDetection {
+    float x;
+    float y;
+    float width;
+    float height;
+    float score;
+    std::int32_t class_id;
+    std::int32_t track_id;
+    std::uint16_t class_name_index;
+    std::uint16_t reserved;
+};
+static_assert(sizeof(PyDetection) == sizeof(perception::DetectionResultPacketItemV2), "PyDetection layout");
+
+// Python 侧的 Pad 出口：出口回调只把 BufferRef 放入队列（不取 GIL），get() 等待期间释放 GIL
+struct PyPadTap {
+    std::shared_ptr<core::PadTapQueue> queue;
+};
+
+std::chrono::milliseconds toTimeout(const std::optional<double>& seconds) {
+    if (!seconds) return std::chrono::milliseconds(-1);
+    return std::chrono::milliseconds(static_cast<std::int64_t>(std::max(0.0, *seconds) * 1000.0));
+}
+
+std::shared_ptr<PyPadTap> makeTap(std::size_t capacity, core::Pad::BufferCallback& handler) {
+    auto tap = std::make_shared<PyPadTap>();
+    tap->queue = std::make_shared<core::PadTapQueue>(capacity);
+    handler = [queue = tap->queue](const core::BufferRef& buffer) { queue->push(buffer); };
+    return tap;
+}
+
+py::array readOnly(py::array array) {
+    array.attr("setflags")(py::arg("write") = false);
+    return array;
+}
+
+// 相机帧包 → 指向像素的 ndarray（RGB8/BGR8: HxWx3，YUYV: HxWx2，NV12: (H*3/2)xW，其它格式为一维字节）
+py::object frameArray(py::object self) {
+    const auto& ref = self.cast<const core::BufferRef&>();
+    if (ref.size() < sizeof(sensors::CameraFramePacket)) return py::none();
+    sensors::CameraFramePacket header;
+    std::memcpy(&header, ref.data(), sizeof(header));
+    if (header.width <= 0 || header.height <= 0 || header.stride <= 0 ||
+        std::memchr(header.format, '\0', sizeof(header.format)) == nullptr) {
+        return py::none();
+    }
+    const std::uint8_t* pixels = ref.data() + sizeof(header);
+    const std::size_t pixelBytes = ref.size() - sizeof(header);
+    const py::ssize_t h = header.height;
+    const py::ssize_t w = header.width;
+    const py::ssize_t stride = header.stride;
+    if (pixelBytes < static_cast<std::size_t>(stride * h)) return py::none();
+    const auto u8 = py::dtype::of<std::uint8_t>();
+    switch (core::parsePixelFormat(header.format)) {
+        case core::PixelFormat::RGB8:
+        case core::PixelFormat::BGR8:
+            return readOnly(py::array(u8, {h, w, py::ssize_t{3}}, {stride, py::ssize_t{3}, py::ssize_t{1}}, pixels, self));
+        case core::PixelFormat::YUYV:
+            return readOnly(py::array(u8, {h, w, py::ssize_t{2}}, {stride, py::ssize_t{2}, py::ssize_t{1}}, pixels, self));
+        case core::PixelFormat::NV12: {
+            const py::ssize_t rows = std::min<py::ssize_t>(h * 3 / 2, static_cast<py::ssize_t>(pixelBytes) / stride);
+            return readOnly(py::array(u8, {rows, w}, {stride, py::ssize_t{1}}, pixels, self));
+        }
+        default:
+            return readOnly(py::array(u8, {static_cast<py::ssize_t>(pixelBytes)}, {py::ssize_t{1}}, pixels, self));
+    }
+}
+
+// 检测结果包（v2）→ 结构化 ndarray 视图；不是 v2 检测包时返回 None
+py::object detectionArray(py::object self) {
+    const auto& ref = self.cast<const core::BufferRef&>();
+    perception::DetectionResultView view;
+    if (!view.parse(ref.data(), ref.size()) || view.version() != perception::DETECTION_RESULT_PACKET_VERSION_2) {
+        return py::none();
+    }
+    perception::DetectionResultPacketHeaderV2 header;
+    std::memcpy(&header, ref.data(), sizeof(header));
+    return readOnly(py::array(py::dtype::of<PyDetection>(), {static_cast<py::ssize_t>(view.size())},
+                              {static_cast<py::ssize_t>(sizeof(PyDetection))}, ref.data() + header.headerBytes, self));
+}
+
+py::list detectionClassNames(const core::BufferRef& ref) {
+    py::list names;
+    perception::DetectionResultView view;
+    if (!view.parse(ref.data(), ref.size())) return names;
+    for (std::size_t i = 0; i < view.numClassNames(); ++i) {
+        const auto name = view.classNameAt(i);
+        names.append(py::str(name.data(), name.size()));
+    }
+    return names;
+}
+
+// PythonNode 处理函数的返回值 → 输出缓冲：Buffer 原样转发（零拷贝），其它支持缓冲协议的对象拷贝一次
+void collectOutputs(const py::object& result, std::vector<core::BufferRef>& outputs) {
+    if (result.is_none()) return;
+    for (py::handle item : result) {
+        if (py::isinstance<core::BufferRef>(item)) {
+            outputs.push_back(item.cast<core::BufferRef>());
+            continue;
+        }
+        py::array array = py::array::ensure(item, py::array::c_style);
+        if (!array) throw py::type_error("PythonNode outputs must be Buffer or buffer-protocol objects");
+        outputs.push_back(core::BufferRef::copyFrom(array.data(), static_cast<std::size_t>(array.nbytes())));
+    }
+}
+
+} // namespace
+
 PYBIND11_MODULE(falconmind_sdk, m) {
     m.doc() = "FalconMind SDK Python Bindings";
 
+    PYBIND11_NUMPY_DTYPE(PyDetection, x, y, width, height, score, class_id, track_id, class_name_index, reserved);
+
+    // Buffer：引用计数的帧 / 检测结果缓冲；缓冲协议与 frame() / detections() 返回的 ndarray 均直接视图
+    // Pipeline 的池缓冲（只读，不拷贝），持有期间生产者不会复用该缓冲
+    py::class_<core::BufferRef>(m, "Buffer", py::buffer_protocol())
+        .def_buffer([](core::BufferRef& self) {
+            return py::buffer_info(const_cast<std::uint8_t*>(self.data()), 1,
+                                   py::format_descriptor<std::uint8_t>::format(), 1,
+                                   {static_cast<py::ssize_t>(self.size())}, {py::ssize_t{1}}, true);
+        })
+        .def("__len__", &core::BufferRef::size)
+        .def_property_readonly("size", &core::BufferRef::size)
+        .def_property_readonly("timestamp_ns", [](const core::BufferRef& self) { return self.meta().timestampNs; })
+        .def_property_readonly("frame_index", [](const core::BufferRef& self) { return self.meta().frameIndex; })
+        .def_property_readonly("dmabuf_fd", [](const core::BufferRef& self) { return self.meta().dmabufFd; })
+        .def("frame", &frameArray, "相机帧像素的 ndarray 视图；不是帧包时返回 None")
+        .def("detections", &detectionArray, "检测结果的结构化 ndarray 视图；不是 v2 检测结果包时返回 None")
+        .def("class_names", &detectionClassNames, "检测结果包的类别名表（与 class_name_index 对应）");
+
+    py::class_<PyPadTap, std::shared_ptr<PyPadTap>>(m, "PadTap")
+        .def("get", [](PyPadTap& self, std::optional<double> timeout) -> py::object {
+            core::BufferRef buffer;
+            bool ok = false;
+            {
+                py::gil_scoped_release release;
+                ok = self.queue->pop(buffer, toTimeout(timeout));
+            }
+            if (!ok) return py::none();
+            return py::cast(std::move(buffer));
+        }, py::arg("timeout") = py::none(), "等待下一个缓冲（timeout 秒，None 为一直等待）；超时或已关闭返回 None")
+        .def("get_batch", [](PyPadTap& self, std::size_t max, std::optional<double> timeout) {
+            std::vector<core::BufferRef> buffers;
+            {
+                py::gil_scoped_release release;
+                self.queue->popBatch(buffers, max, toTimeout(timeout));
+            }
+            py::list out;
+            for (auto& b : buffers) out.append(py::cast(std::move(b)));
+            return out;
+        }, py::arg("max") = 8, py::arg("timeout") = py::none())
+        .def("close", [](PyPadTap& self) { self.queue->close(); })
+        .def_property_readonly("pending", [](const PyPadTap& self) { return self.queue->size(); })
+        .def_property_readonly("dropped", [](const PyPadTap& self) { return self.queue->dropped(); });
+
     // PipelineState enum
     py::enum_<core::PipelineState>(m, "PipelineState")
         .value("Null", core::PipelineState::Null)
@@ -31,7 +197,8 @@ PYBIND11_MODULE(falconmind_sdk, m) {
         .def(py::init<>())
         .def_readwrite("pipeline_id", &core::PipelineConfig::pipelineId)
         .def_readwrite("name", &core::PipelineConfig::name)
-        .def_readwrite("description", &core::PipelineConfig::description);
+        .def_readwrite("description", &core::PipelineConfig::description)
+        .def_readwrite("start_threads", &core::PipelineConfig::startThreads);
 
     // Pipeline::LinkInfo
     py::class_<core::Pipeline::LinkInfo>(m, "LinkInfo")
@@ -40,6 +207,63 @@ PYBIND11_MODULE(falconmind_sdk, m) {
         .def_readwrite("dst_node_id", &core::Pipeline::LinkInfo::dstNodeId)
         .def_readwrite("dst_pad_name", &core::Pipeline::LinkInfo::dstPadName);
 
+    // Pipeline metrics
+    py::class_<core::StageMetrics>(m, "StageMetrics")
+        .def_readonly("name", &core::StageMetrics::name)
+        .def_readonly("count", &core::StageMetrics::count)
+        .def_readonly("mean_us", &core::StageMetrics::meanUs)
+        .def_readonly("p50_us", &core::StageMetrics::p50Us)
+        .def_readonly("p99_us", &core::StageMetrics::p99Us)
+        .def_readonly("max_us", &core::StageMetrics::maxUs);
+
+    py::class_<core::NodeMetrics>(m, "NodeMetrics")
+        .def_readonly("node_id", &core::NodeMetrics::nodeId)
+        .def_readonly("process_count", &core::NodeMetrics::processCount)
+        .def_readonly("p50_us", &core::NodeMetrics::p50Us)
+        .def_readonly("p99_us", &core::NodeMetrics::p99Us)
+        .def_readonly("max_us", &core::NodeMetrics::maxUs)
+        .def_readonly("cpu_ms", &core::NodeMetrics::cpuMs)
+        .def_readonly("queue_depth", &core::NodeMetrics::queueDepth)
+        .def_readonly("has_deadline", &core::NodeMetrics::hasDeadline)
+        .def_readonly("deadline_ms", &core::NodeMetrics::deadlineMs)
+        .def_readonly("deadline_misses", &core::NodeMetrics::deadlineMisses)
+        .def_readonly("max_lateness_ms", &core::NodeMetrics::maxLatenessMs)
+        .def_readonly("has_latency", &core::NodeMetrics::hasLatency)
+        .def_readonly("latency_p50_ms", &core::NodeMetrics::latencyP50Ms)
+        .def_readonly("latency_p99_ms", &core::NodeMetrics::latencyP99Ms)
+        .def_readonly("latency_max_ms", &core::NodeMetrics::latencyMaxMs)
+        .def_readonly("latency_budget_ms", &core::NodeMetrics::latencyBudgetMs)
+        .def_readonly("over_budget", &core::NodeMetrics::overBudget)
+        .def_readonly("stages", &core::NodeMetrics::stages)
+        .def_readonly("device_utilization", &core::NodeMetrics::deviceUtilization)
+        .def_readonly("has_memory", &core::NodeMetrics::hasMemory)
+        .def_readonly("memory_bytes", &core::NodeMetrics::memoryBytes)
+        .def_readonly("memory_peak_bytes", &core::NodeMetrics::memoryPeakBytes)
+        .def_readonly("memory_estimate_bytes", &core::NodeMetrics::memoryEstimateBytes);
+
+    py::class_<core::LinkMetrics>(m, "LinkMetrics")
+        .def_readonly("src_node_id", &core::LinkMetrics::srcNodeId)
+        .def_readonly("src_pad_name", &core::LinkMetrics::srcPadName)
+        .def_readonly("dst_node_id", &core::LinkMetrics::dstNodeId)
+        .def_readonly("dst_pad_name", &core::LinkMetrics::dstPadName)
+        .def_readonly("frames", &core::LinkMetrics::frames)
+        .def_readonly("bytes", &core::LinkMetrics::bytes)
+        .def_readonly("drops", &core::LinkMetrics::drops)
+        .def_readonly("skipped", &core::LinkMetrics::skipped)
+        .def_readonly("source_fps_limit", &core::LinkMetrics::sourceFpsLimit)
+        .def_readonly("queue_depth", &core::LinkMetrics::queueDepth)
+        .def_readonly("frames_per_sec", &core::LinkMetrics::framesPerSec)
+        .def_readonly("bytes_per_sec", &core::LinkMetrics::bytesPerSec);
+
+    py::class_<core::PipelineMetrics>(m, "PipelineMetrics")
+        .def_readonly("pipeline_id", &core::PipelineMetrics::pipelineId)
+        .def_readonly("timestamp_ns", &core::PipelineMetrics::timestampNs)
+        .def_readonly("nodes", &core::PipelineMetrics::nodes)
+        .def_readonly("links", &core::PipelineMetrics::links)
+        .def_readonly("memory_budget_bytes", &core::PipelineMetrics::memoryBudgetBytes)
+        .def_readonly("memory_bytes", &core::PipelineMetrics::memoryBytes)
+        .def("to_json", [](const core::PipelineMetrics& self) { return core::toJson(self); });
+
     // Pipeline
     py::class_<core::Pipeline, std::shared_ptr<core::Pipeline>>(m, "Pipeline")
         .def(py::init<const core::PipelineConfig&>())
@@ -47,10 +271,22 @@ PYBIND11_MODULE(falconmind_sdk, m) {
         .def("add_node", &core::Pipeline::addNode)
         .def("link", &core::Pipeline::link)
         .def("unlink", &core::Pipeline::unlink)
-        .def("set_state", &core::Pipeline::setState)
+        .def("set_state", &core::Pipeline::setState, py::call_guard<py::gil_scoped_release>())
+        .def("add_pad_tap", [](core::Pipeline& self, const std::string& node_id, const std::string& pad_name,
+                               std::size_t capacity) {
+            core::Pad::BufferCallback handler;
+            auto tap = makeTap(capacity, handler);
+            if (!self.addPadTap(node_id, pad_name, std::move(handler))) {
+                throw std::runtime_error("add_pad_tap failed: " + node_id + "." + pad_name);
+            }
+            return tap;
+        }, py::arg("node_id"), py::arg("pad_name"), py::arg("capacity") = 4,
+           "在 Source Pad 上挂接出口；队列满时丢弃最旧的缓冲")
+        .def("remove_pad_tap", &core::Pipeline::removePadTap)
         .def("state", &core::Pipeline::state)
         .def("get_node", &core::Pipeline::getNode)
-        .def("get_links", &core::Pipeline::getLinks);
+        .def("get_links", &core::Pipeline::getLinks)
+        .def("metrics", &core::Pipeline::metrics);
 
     // Node (base class)
     py::class_<core::Node, std::shared_ptr<core::Node>>(m, "Node")
@@ -61,6 +297,42 @@ PYBIND11_MODULE(falconmind_sdk, m) {
         .def("process", &core::Node::process)
         .def("configure", &core::Node::configure);
 
+    // PythonNode：fn(buffers: list[Buffer]) -> 可迭代的输出（Buffer 或支持缓冲协议的对象）或 None，
+    // 输出经 "out" 推送。fn 在节点专用线程中按批调用（每批获取一次 GIL），调度器线程不等待 GIL
+    py::class_<core::BatchCallbackNode, core::Node, std::shared_ptr<core::BatchCallbackNode>>(m, "PythonNode")
+        .def(py::init([](const std::string& node_id, py::function fn, std::size_t batch_size,
+                         std::size_t queue_capacity) {
+            core::BatchCallbackNode::Config config;
+            config.batchSize = batch_size;
+            config.queueCapacity = queue_capacity;
+            // 处理函数可能在节点线程中析构，释放 Python 对象前先取得 GIL
+            std::shared_ptr<py::function> callable(new py::function(std::move(fn)), [](py::function* f) {
+                py::gil_scoped_acquire gil;
+                delete f;
+            });
+            auto node = std::make_shared<core::BatchCallbackNode>(
+                [callable, node_id](std::vector<core::BufferRef>& inputs, std::vector<core::BufferRef>& outputs) {
+                    py::gil_scoped_acquire gil;
+                    try {
+                        py::list batch(inputs.size());
+                        for (std::size_t i = 0; i < inputs.size(); ++i) {
+                            batch[i] = py::cast(inputs[i]);
+                        }
+                        collectOutputs((*callable)(batch), outputs);
+                    } catch (py::error_already_set& e) {
+                        e.discard_as_unraisable(node_id.c_str());
+                    } catch (const std::exception& e) {
+                        std::cerr << "[PythonNode] " << node_id << ": " << e.what() << std::endl;
+                    }
+                },
+                config);
+            node->setId(node_id);
+            return node;
+        }), py::arg("node_id"), py::arg("fn"), py::arg("batch_size") = 8, py::arg("queue_capacity") = 16)
+        .def_property_readonly("batches", &core::BatchCallbackNode::batches)
+        .def_property_readonly("processed", &core::BatchCallbackNode::processed)
+        .def_property_readonly("dropped", &core::BatchCallbackNode::dropped);
+
     // NodeFactory
     py::class_<core::NodeFactory>(m, "NodeFactory")
         .def_static("register_node_type", &core::NodeFactory::registerNodeType,
@@ -79,13 +351,29 @@ PYBIND11_MODULE(falconmind_sdk, m) {
         .def("load_flow", &core::FlowExecutor::loadFlow)
         .def("load_flow_from_file", &core::FlowExecutor::loadFlowFromFile)
         .def("load_flow_from_builder", &core::FlowExecutor::loadFlowFromBuilder)
-        .def("start", &core::FlowExecutor::start)
-        .def("stop", &core::FlowExecutor::stop)
+        .def("set_plan_cache_directory", &core::FlowExecutor::setPlanCacheDirectory)
+        .def("load_flow_from_cache", &core::FlowExecutor::loadFlowFromCache)
+        .def("start", &core::FlowExecutor::start, py::call_guard<py::gil_scoped_release>())
+        .def("stop", &core::FlowExecutor::stop, py::call_guard<py::gil_scoped_release>())
         .def("is_running", &core::FlowExecutor::isRunning)
+        .def("pause", &core::FlowExecutor::pause, py::call_guard<py::gil_scoped_release>())
+        .def("resume", &core::FlowExecutor::resume, py::call_guard<py::gil_scoped_release>())
+        .def("is_paused", &core::FlowExecutor::isPaused)
         .def("get_pipeline", &core::FlowExecutor::getPipeline)
         .def("get_flow_id", &core::FlowExecutor::getFlowId)
         .def("get_flow_name", &core::FlowExecutor::getFlowName)
-        .def("update_flow", &core::FlowExecutor::updateFlow);
+        .def("update_flow", &core::FlowExecutor::updateFlow, py::call_guard<py::gil_scoped_release>())
+        .def("add_pad_tap", [](core::FlowExecutor& self, const std::string& node_id, const std::string& pad_name,
+                               std::size_t capacity) {
+            core::Pad::BufferCallback handler;
+            auto tap = makeTap(capacity, handler);
+            if (!self.addPadTap(node_id, pad_name, std::move(handler))) {
+                throw std::runtime_error("add_pad_tap failed: " + node_id + "." + pad_name);
+            }
+            return tap;
+        }, py::arg("node_id"), py::arg("pad_name"), py::arg("capacity") = 4,
+           "在 start() 创建的 Pipeline 上挂接出口（须在 start 之前调用）")
+        .def("remove_pad_tap", &core::FlowExecutor::removePadTap);
 
     // GeoPoint
     py::class_<mission::GeoPoint>(m, "GeoPoint")
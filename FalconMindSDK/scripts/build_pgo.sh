@@ -0,0 +1,69 @@
+#!/usr/bin/env bash
+# FalconMindSDK - LTO + PGO 发布构建
+#
+# 三个阶段在同一构建目录中完成（GCC 的 profile 按目标文件路径匹配）：
+#   1) FALCONMINDSDK_PGO=GENERATE 插桩构建
+#   2) 运行训练负载：pipeline benchmark（感知链路）+ 颜色转换 / Flow 加载基准
+#   3) FALCONMINDSDK_PGO=USE 按 profile 重编（默认同时开启 LTO）
+#
+# 用法: ./scripts/build_pgo.sh [build_dir] [--no-lto] [--train-ms 8000] [-- 额外 cmake 参数]
+# 示例: ./scripts/build_pgo.sh build-release -- -DFALCONMINDSDK_BUILD_PYTHON=OFF
+#
+# 只需 LTO 不做 PGO 时直接配置：cmake -DCMAKE_BUILD_TYPE=Release -DFALCONMINDSDK_ENABLE_LTO=ON
+# 交叉编译目标无法在本机训练：在目标板上运行第 2 步后把 profile 目录拷回，再执行第 3 步
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+SDK_ROOT="$(cd "$SCRIPT_DIR/.." && pwd)"
+BUILD_DIR="$SDK_ROOT/build-pgo"
+LTO="ON"
+TRAIN_MS=8000
+EXTRA_ARGS=()
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --no-lto) LTO="OFF"; shift ;;
+        --train-ms) TRAIN_MS="$2"; shift 2 ;;
+        --) shift; EXTRA_ARGS=("$@"); break ;;
+        -*) echo "Unknown option: $1"; exit 1 ;;
+        *) BUILD_DIR="$1"; shift ;;
+    esac
+done
+
+PROFILE_DIR="$BUILD_DIR/pgo-profiles"
+JOBS="$(nproc 2>/dev/null || echo 4)"
+
+configure() {
+    cmake -S "$SDK_ROOT" -B "$BUILD_DIR" \
+        -DCMAKE_BUILD_TYPE=Release \
+        -DFALCONMINDSDK_BUILD_TESTS=ON \
+        -DFALCONMINDSDK_ENABLE_LTO="$LTO" \
+        -DFALCONMINDSDK_PGO="$1" \
+        -DFALCONMINDSDK_PGO_DIR="$PROFILE_DIR" \
+        "${EXTRA_ARGS[@]}"
+}
+
+echo "[PGO] 1/3 instrumented build ($BUILD_DIR)"
+rm -rf "$PROFILE_DIR"
+configure GENERATE
+cmake --build "$BUILD_DIR" -j"$JOBS" --target falconmind_pipeline_benchmark \
+    falconmind_color_convert_benchmark falconmind_flow_parse_benchmark
+
+echo "[PGO] 2/3 training run"
+"$BUILD_DIR/falconmind_pipeline_benchmark" --width 640 --height 480 --fps 30 \
+    --duration-ms "$TRAIN_MS" --warmup-ms 500 --output "$BUILD_DIR/pgo-train-pipeline.json"
+"$BUILD_DIR/falconmind_pipeline_benchmark" --width 1280 --height 720 --fps 30 --queue \
+    --duration-ms "$((TRAIN_MS / 2))" --warmup-ms 500 --output "$BUILD_DIR/pgo-train-pipeline-720p.json"
+"$BUILD_DIR/falconmind_color_convert_benchmark" --width 1280 --height 720 --iterations 20
+"$BUILD_DIR/falconmind_flow_parse_benchmark" --nodes 100,1000 --iterations 3 --path "$BUILD_DIR/pgo-flow.json"
+
+if [[ "$(cmake -LA -N "$BUILD_DIR" | grep '^CMAKE_CXX_COMPILER:' | cut -d= -f2)" == *clang* ]]; then
+    llvm-profdata merge -output="$PROFILE_DIR/falconmind.profdata" "$PROFILE_DIR"/*.profraw
+fi
+
+echo "[PGO] 3/3 optimized build (LTO=$LTO)"
+configure USE
+cmake --build "$BUILD_DIR" -j"$JOBS"
+
+echo "[PGO] done: $BUILD_DIR (training reports: $BUILD_DIR/pgo-train-*.json)"
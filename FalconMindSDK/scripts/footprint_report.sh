@@ -0,0 +1,60 @@
+#!/usr/bin/env bash
+# FalconMindSDK - 构建档位占用对比
+#
+# 分别以 full 与 embedded 档位（同为 MinSizeRel）构建 falconmind_footprint_benchmark 并运行，
+# 汇总可执行文件体积（含 strip 后体积）、启动耗时与空闲 RSS；各档位的完整 JSON 留在构建目录。
+#
+# 用法: ./scripts/footprint_report.sh [work_dir] [--node-types LIST] [--idle-ms 1000] [-- 额外 cmake 参数]
+# 示例: ./scripts/footprint_report.sh /tmp/footprint --node-types camera_source,detection,tracking_transform
+#
+# 交叉编译时只做构建（加 -DCMAKE_TOOLCHAIN_FILE=...），在目标板上运行各构建目录中的基准程序
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+SDK_ROOT="$(cd "$SCRIPT_DIR/.." && pwd)"
+WORK_DIR="$SDK_ROOT/build-footprint"
+NODE_TYPES="camera_source,detection,tracking_transform,event_reporter"
+IDLE_MS=1000
+EXTRA_ARGS=()
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --node-types) NODE_TYPES="$2"; shift 2 ;;
+        --idle-ms) IDLE_MS="$2"; shift 2 ;;
+        --) shift; EXTRA_ARGS=("$@"); break ;;
+        -*) echo "Unknown option: $1"; exit 1 ;;
+        *) WORK_DIR="$1"; shift ;;
+    esac
+done
+
+JOBS="$(nproc 2>/dev/null || echo 4)"
+STRIP="${STRIP:-strip}"
+
+build_profile() {
+    local profile="$1" dir="$WORK_DIR/$1"
+    shift
+    echo "[footprint] building $profile profile ($dir)"
+    cmake -S "$SDK_ROOT" -B "$dir" -DCMAKE_BUILD_TYPE=MinSizeRel -DFALCONMINDSDK_PROFILE="$profile" \
+        -DFALCONMINDSDK_BUILD_TESTS=ON -DFALCONMINDSDK_BUILD_NODEAGENT=OFF "$@" "${EXTRA_ARGS[@]}" > "$dir.configure.log"
+    cmake --build "$dir" -j"$JOBS" --target falconmind_footprint_benchmark > "$dir.build.log"
+    "$dir/falconmind_footprint_benchmark" --idle-ms "$IDLE_MS" --output "$dir/footprint.json"
+    "$STRIP" -o "$dir/falconmind_footprint_benchmark.stripped" "$dir/falconmind_footprint_benchmark" 2>/dev/null || true
+}
+
+mkdir -p "$WORK_DIR"
+build_profile full -DFALCONMINDSDK_BUILD_PYTHON=OFF
+build_profile embedded -DFALCONMINDSDK_NODE_TYPES="$NODE_TYPES"
+
+printf '\n%-10s %12s %14s %11s %12s %12s %10s\n' profile "binary KiB" "stripped KiB" "node types" "startup ms" "idle RSS KiB" "peak KiB"
+for profile in full embedded; do
+    dir="$WORK_DIR/$profile"
+    stripped="$(stat -c %s "$dir/falconmind_footprint_benchmark.stripped" 2>/dev/null || echo 0)"
+    python3 - "$dir/footprint.json" "$profile" "$stripped" <<'EOF'
+import json, sys
+r = json.load(open(sys.argv[1]))["results"]
+print("%-10s %12.0f %14.0f %11d %12.2f %12d %10d" % (
+    sys.argv[2], r["binary_bytes"] / 1024.0, int(sys.argv[3]) / 1024.0, r["node_types"],
+    r["startup_ms"]["total"], r["rss_kb"]["idle"], r["rss_kb"]["peak"]))
+EOF
+done
@@ -2,7 +2,12 @@
 #include "falconmind/sdk/core/Pipeline.h"
 #include "falconmind/sdk/core/NodeFactory.h"
 #include "falconmind/sdk/core/FlowExecutor.h"
+#include "falconmind/sdk/core/Buffer.h"
+#include "falconmind/sdk/perception/DetectionResultPacket.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+#include "falconmind/sdk/telemetry/LocalTelemetryChannel.h"
 
+#include <cstddef>
 #include <cstring>
 #include <fstream>
 #include <sstream>
@@ -27,6 +32,61 @@ FMPipelineState fromState(falconmind::sdk::core::PipelineState s) {
     }
 }
 
+// FMBuffer 即 BufferRef：回调借出指向栈上 BufferRef 的指针，retain 在堆上复制一个（只增加引用计数）
+using falconmind::sdk::core::BufferRef;
+using falconmind::sdk::perception::DetectionResultPacketHeaderV2;
+using falconmind::sdk::perception::DetectionResultPacketItemV2;
+
+static_assert(sizeof(FMDetection) == sizeof(DetectionResultPacketItemV2), "FMDetection layout");
+static_assert(offsetof(FMDetection, track_id) == offsetof(DetectionResultPacketItemV2, trackId), "FMDetection layout");
+static_assert(offsetof(FMDetection, class_name_index) == offsetof(DetectionResultPacketItemV2, classNameIndex),
+              "FMDetection layout");
+
+using falconmind::sdk::telemetry::LocalDetectionEvent;
+using falconmind::sdk::telemetry::LocalFlightState;
+using falconmind::sdk::telemetry::LocalTelemetryReader;
+
+static_assert(sizeof(FMLocalFlightState) == sizeof(LocalFlightState), "FMLocalFlightState layout");
+static_assert(offsetof(FMLocalFlightState, battery_voltage_mv) == offsetof(LocalFlightState, batteryVoltageMv),
+              "FMLocalFlightState layout");
+static_assert(offsetof(FMLocalFlightState, uav_id) == offsetof(LocalFlightState, uavId), "FMLocalFlightState layout");
+static_assert(sizeof(FMLocalDetectionEvent) == sizeof(LocalDetectionEvent), "FMLocalDetectionEvent layout");
+static_assert(offsetof(FMLocalDetectionEvent, flags) == offsetof(LocalDetectionEvent, flags),
+              "FMLocalDetectionEvent layout");
+static_assert(offsetof(FMLocalDetectionEvent, class_name) == offsetof(LocalDetectionEvent, className),
+              "FMLocalDetectionEvent layout");
+
+// FMLocalTelemetryReader 即堆上的 shared_ptr<LocalTelemetryReader>
+const LocalTelemetryReader* toReader(const FMLocalTelemetryReader* r) {
+    return reinterpret_cast<const std::shared_ptr<LocalTelemetryReader>*>(r)->get();
+}
+
+const BufferRef* toRef(const FMBuffer* b) { return reinterpret_cast<const BufferRef*>(b); }
+
+falconmind::sdk::core::Pad::BufferCallback tapHandler(FMPadTapCallback callback, void* user_data) {
+    return [callback, user_data](const BufferRef& buffer) {
+        callback(reinterpret_cast<const FMBuffer*>(&buffer), user_data);
+    };
+}
+
+falconmind::sdk::core::LinkQueueConfig tapQueue(int queue_depth) {
+    falconmind::sdk::core::LinkQueueConfig queue;
+    if (queue_depth > 0) {
+        queue.enabled = true;
+        queue.capacity = static_cast<size_t>(queue_depth);
+    }
+    return queue;
+}
+
+size_t copyOut(const std::string& text, char* buf, size_t buf_size) {
+    if (buf && buf_size > 0) {
+        size_t n = text.size() < buf_size - 1 ? text.size() : buf_size - 1;
+        std::memcpy(buf, text.data(), n);
+        buf[n] = '\0';
+    }
+    return text.size();
+}
+
 } // namespace
 
 extern "C" {
@@ -77,6 +137,109 @@ FMPipelineState fm_pipeline_get_state(FMPipeline* p) {
     return fromState(pipe->state());
 }
 
+size_t fm_pipeline_get_metrics_json(FMPipeline* p, char* buf, size_t buf_size) {
+    if (!p) return 0;
+    auto* pipe = reinterpret_cast<falconmind::sdk::core::Pipeline*>(p);
+    return copyOut(falconmind::sdk::core::toJson(pipe->metrics()), buf, buf_size);
+}
+
+int fm_pipeline_add_pad_tap(FMPipeline* p, const char* node_id, const char* pad_name,
+    FMPadTapCallback callback, void* user_data, int queue_depth) {
+    if (!p || !node_id || !pad_name || !callback) return 0;
+    auto* pipe = reinterpret_cast<falconmind::sdk::core::Pipeline*>(p);
+    return pipe->addPadTap(node_id, pad_name, tapHandler(callback, user_data), tapQueue(queue_depth)) ? 1 : 0;
+}
+
+int fm_pipeline_remove_pad_tap(FMPipeline* p, const char* node_id, const char* pad_name) {
+    if (!p || !node_id || !pad_name) return 0;
+    auto* pipe = reinterpret_cast<falconmind::sdk::core::Pipeline*>(p);
+    return pipe->removePadTap(node_id, pad_name) ? 1 : 0;
+}
+
+FMBuffer* fm_buffer_retain(const FMBuffer* buffer) {
+    if (!buffer) return nullptr;
+    try {
+        return reinterpret_cast<FMBuffer*>(new BufferRef(*toRef(buffer)));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void fm_buffer_release(FMBuffer* buffer) {
+    delete reinterpret_cast<BufferRef*>(buffer);
+}
+
+const uint8_t* fm_buffer_data(const FMBuffer* buffer) {
+    return buffer ? toRef(buffer)->data() : nullptr;
+}
+
+size_t fm_buffer_size(const FMBuffer* buffer) {
+    return buffer ? toRef(buffer)->size() : 0;
+}
+
+int fm_buffer_get_meta(const FMBuffer* buffer, FMBufferMeta* out) {
+    if (!buffer || !out || !toRef(buffer)->valid()) return 0;
+    const auto& meta = toRef(buffer)->meta();
+    out->timestamp_ns = meta.timestampNs;
+    out->frame_index = meta.frameIndex;
+    out->dmabuf_fd = meta.dmabufFd;
+    return 1;
+}
+
+int fm_buffer_as_frame(const FMBuffer* buffer, FMFrameView* out) {
+    using falconmind::sdk::sensors::CameraFramePacket;
+    if (!buffer || !out) return 0;
+    const BufferRef& ref = *toRef(buffer);
+    if (ref.size() < sizeof(CameraFramePacket)) return 0;
+    // 帧包头在缓冲起始处按自然对齐存放（池缓冲与自有缓冲均满足）
+    const auto* header = reinterpret_cast<const CameraFramePacket*>(ref.data());
+    if (header->width <= 0 || header->height <= 0 || header->stride <= 0 ||
+        std::memchr(header->format, '\0', sizeof(header->format)) == nullptr) {
+        return 0;
+    }
+    const size_t pixels = static_cast<size_t>(header->stride) * static_cast<size_t>(header->height);
+    if (ref.size() - sizeof(CameraFramePacket) < pixels) return 0;
+    out->width = header->width;
+    out->height = header->height;
+    out->stride = header->stride;
+    out->format = header->format;
+    out->timestamp_ns = header->captureTimestampNs;
+    out->frame_index = header->frameIndex;
+    out->pixels = ref.data() + sizeof(CameraFramePacket);
+    out->pixels_size = ref.size() - sizeof(CameraFramePacket);
+    return 1;
+}
+
+int fm_buffer_as_detections(const FMBuffer* buffer, FMDetectionView* out) {
+    if (!buffer || !out) return 0;
+    const BufferRef& ref = *toRef(buffer);
+    falconmind::sdk::perception::DetectionResultView view;
+    if (!view.parse(ref.data(), ref.size()) ||
+        view.version() != falconmind::sdk::perception::DETECTION_RESULT_PACKET_VERSION_2) {
+        return 0;
+    }
+    // parse() 已校验长度与各段边界，这里按 v2 布局取段起始指针
+    const auto* header = reinterpret_cast<const DetectionResultPacketHeaderV2*>(ref.data());
+    const uint8_t* items = ref.data() + header->headerBytes;
+    const uint8_t* offsets = items + static_cast<size_t>(header->numDetections) * sizeof(DetectionResultPacketItemV2);
+    out->frame_index = header->frameIndex;
+    out->timestamp_ns = header->timestampNs;
+    out->flags = header->flags;
+    out->count = header->numDetections;
+    out->items = reinterpret_cast<const FMDetection*>(items);
+    out->num_class_names = header->numClassNames;
+    out->name_offsets = reinterpret_cast<const uint32_t*>(offsets);
+    out->names = reinterpret_cast<const char*>(offsets + (static_cast<size_t>(header->numClassNames) + 1) * sizeof(uint32_t));
+    return 1;
+}
+
+const char* fm_detection_class_name(const FMDetectionView* view, uint32_t i) {
+    if (!view || i >= view->count) return nullptr;
+    const uint16_t index = view->items[i].class_name_index;
+    if (index >= view->num_class_names) return nullptr;
+    return view->names + view->name_offsets[index];
+}
+
 FMFlowExecutor* fm_flow_executor_create(void) {
     try {
         auto* e = new falconmind::sdk::core::FlowExecutor();
@@ -118,4 +281,65 @@ int fm_flow_executor_is_running(FMFlowExecutor* e) {
     return reinterpret_cast<falconmind::sdk::core::FlowExecutor*>(e)->isRunning() ? 1 : 0;
 }
 
+int fm_flow_executor_add_pad_tap(FMFlowExecutor* e, const char* node_id, const char* pad_name,
+    FMPadTapCallback callback, void* user_data, int queue_depth) {
+    if (!e || !node_id || !pad_name || !callback) return 0;
+    auto* ex = reinterpret_cast<falconmind::sdk::core::FlowExecutor*>(e);
+    return ex->addPadTap(node_id, pad_name, tapHandler(callback, user_data), tapQueue(queue_depth)) ? 1 : 0;
+}
+
+int fm_flow_executor_remove_pad_tap(FMFlowExecutor* e, const char* node_id, const char* pad_name) {
+    if (!e || !node_id || !pad_name) return 0;
+    auto* ex = reinterpret_cast<falconmind::sdk::core::FlowExecutor*>(e);
+    return ex->removePadTap(node_id, pad_name) ? 1 : 0;
+}
+
+size_t fm_flow_executor_get_metrics_json(FMFlowExecutor* e, char* buf, size_t buf_size) {
+    if (!e) return 0;
+    auto pipeline = reinterpret_cast<falconmind::sdk::core::FlowExecutor*>(e)->getPipeline();
+    if (!pipeline) return 0;
+    return copyOut(falconmind::sdk::core::toJson(pipeline->metrics()), buf, buf_size);
+}
+
+FMLocalTelemetryReader* fm_local_telemetry_open(const char* channel) {
+    if (!channel) return nullptr;
+    try {
+        auto reader = LocalTelemetryReader::open(channel);
+        if (!reader) return nullptr;
+        return reinterpret_cast<FMLocalTelemetryReader*>(new std::shared_ptr<LocalTelemetryReader>(std::move(reader)));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void fm_local_telemetry_close(FMLocalTelemetryReader* r) {
+    delete reinterpret_cast<std::shared_ptr<LocalTelemetryReader>*>(r);
+}
+
+int fm_local_telemetry_latest_state(const FMLocalTelemetryReader* r, FMLocalFlightState* out) {
+    if (!r || !out) return 0;
+    LocalFlightState state;
+    if (!toReader(r)->latestState(state)) return 0;
+    std::memcpy(out, &state, sizeof(state));
+    return 1;
+}
+
+uint64_t fm_local_telemetry_state_version(const FMLocalTelemetryReader* r) {
+    return r ? toReader(r)->stateVersion() : 0;
+}
+
+size_t fm_local_telemetry_poll_events(const FMLocalTelemetryReader* r, uint64_t* cursor,
+    FMLocalDetectionEvent* out, size_t max_count, uint64_t* dropped) {
+    if (!r || !cursor || (!out && max_count > 0)) return 0;
+    return toReader(r)->pollEvents(*cursor, reinterpret_cast<LocalDetectionEvent*>(out), max_count, dropped);
+}
+
+uint64_t fm_local_telemetry_events_published(const FMLocalTelemetryReader* r) {
+    return r ? toReader(r)->eventsPublished() : 0;
+}
+
+int fm_local_telemetry_closed(const FMLocalTelemetryReader* r) {
+    return r && toReader(r)->closed() ? 1 : 0;
+}
+
 } // extern "C"
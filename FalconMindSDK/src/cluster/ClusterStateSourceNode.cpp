@@ -1,23 +1,31 @@
 #include "falconmind/sdk/cluster/ClusterStateSourceNode.h"
+#include "falconmind/sdk/cluster/SwarmState.h"
 #include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <iostream>
+#include <stdexcept>
 
 namespace falconmind::sdk::cluster {
 
 using namespace falconmind::sdk::core;
 
 ClusterStateSourceNode::ClusterStateSourceNode() : Node("cluster_state_source") {
-    addPad(std::make_shared<Pad>("cluster_state_out", PadType::Source));
+    outPad_ = addPad(std::make_shared<Pad>("cluster_state_out", PadType::Source));
+    peersPad_ = addPad(std::make_shared<Pad>("swarm_peers_out", PadType::Source));
 }
 
 bool ClusterStateSourceNode::configure(const std::unordered_map<std::string, std::string>& params) {
     auto it = params.find("self_id");
     if (it != params.end()) selfId_ = it->second;
     it = params.find("role");
-    if (it != params.end()) role_ = it->second;
+    if (it != params.end()) {
+        autoRole_ = it->second == "auto";
+        role_ = autoRole_ ? "standalone" : it->second;
+    }
     it = params.find("members");
     if (it != params.end()) {
         memberIds_.clear();
@@ -30,6 +38,26 @@ bool ClusterStateSourceNode::configure(const std::unordered_map<std::string, std
             pos = (next == std::string::npos) ? s.size() : next + 1;
         }
     }
+    it = params.find("members_source");
+    if (it != params.end()) {
+        if (it->second != "static" && it->second != "swarm") {
+            std::cerr << "[ClusterStateSourceNode] unknown members_source: " << it->second << std::endl;
+            return false;
+        }
+        fromSwarm_ = it->second == "swarm";
+    }
+    try {
+        it = params.find("peer_timeout_ms");
+        if (it != params.end()) peerTimeoutNs_ = std::max(1, std::stoi(it->second)) * 1000000ll;
+        it = params.find("rate_hz");
+        if (it != params.end()) {
+            const double hz = std::stod(it->second);
+            minIntervalNs_ = hz > 0.0 ? static_cast<int64_t>(1e9 / hz) : 0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[ClusterStateSourceNode] invalid parameter: " << e.what() << std::endl;
+        return false;
+    }
     return true;
 }
 
@@ -39,8 +67,10 @@ void ClusterStateSourceNode::setMemberIds(const std::vector<std::string>& ids) {
 
 bool ClusterStateSourceNode::start() {
     started_ = true;
+    lastPushNs_ = 0;
     std::cout << "[ClusterStateSourceNode] start() self_id=" << selfId_
-              << " role=" << role_ << " members=" << memberIds_.size() << std::endl;
+              << " role=" << (autoRole_ ? "auto" : role_)
+              << " members=" << (fromSwarm_ ? std::string("swarm") : std::to_string(memberIds_.size())) << std::endl;
     return true;
 }
 
@@ -55,15 +85,53 @@ void ClusterStateSourceNode::pushState() {
         std::strncpy(pkt.member_ids[i], memberIds_[i].c_str(), ClusterStatePacket::kMaxIdLen - 1);
         pkt.member_ids[i][ClusterStatePacket::kMaxIdLen - 1] = '\0';
     }
-    pkt.timestamp_ns = timestampNs_++;
+    pkt.timestamp_ns = PipelineClock::nowNs();
 
-    auto outPad = getPad("cluster_state_out");
-    if (outPad)
-        outPad->pushToConnections(&pkt, sizeof(pkt));
+    if (outPad_)
+        outPad_->pushToConnections(&pkt, sizeof(pkt));
+}
+
+void ClusterStateSourceNode::refreshFromSwarm() {
+    auto& registry = SwarmStateRegistry::instance();
+    const int64_t now = PipelineClock::nowNs();
+    const auto peers = registry.peers(peerTimeoutNs_);
+
+    memberIds_.clear();
+    memberIds_.push_back(selfId_);
+    for (const auto& p : peers) memberIds_.push_back(p.id);
+    std::sort(memberIds_.begin(), memberIds_.end());
+    if (autoRole_) {
+        role_ = memberIds_.size() == 1 ? "standalone" : (memberIds_.front() == selfId_ ? "leader" : "follower");
+    }
+    registry.setLocalRole(role_);
+
+    if (!peersPad_) return;
+    SwarmPeersPacket pkt{};
+    for (const auto& p : peers) {
+        if (pkt.num_peers >= SwarmPeersPacket::kMaxPeers) break;
+        auto& out = pkt.peers[pkt.num_peers++];
+        std::strncpy(out.id, p.id.c_str(), SwarmPeersPacket::kMaxIdLen - 1);
+        std::strncpy(out.role, p.role.c_str(), SwarmPeersPacket::kMaxIdLen - 1);
+        out.lat = p.lat;
+        out.lon = p.lon;
+        out.alt = p.alt;
+        out.vx = p.vx;
+        out.vy = p.vy;
+        out.vz = p.vz;
+        out.age_ms = static_cast<int32_t>((now - p.updatedNs) / 1000000);
+    }
+    pkt.timestamp_ns = now;
+    peersPad_->pushToConnections(&pkt, sizeof(pkt));
 }
 
 void ClusterStateSourceNode::process() {
     if (!started_) return;
+    if (minIntervalNs_ > 0) {
+        const int64_t now = PipelineClock::nowNs();
+        if (lastPushNs_ != 0 && now - lastPushNs_ < minIntervalNs_) return;
+        lastPushNs_ = now;
+    }
+    if (fromSwarm_) refreshFromSwarm();
     pushState();
 }
 
@@ -0,0 +1,122 @@
+#include "falconmind/sdk/cluster/SwarmState.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+
+#include <algorithm>
+
+namespace falconmind::sdk::cluster {
+
+using core::PipelineClock;
+
+SwarmStateRegistry& SwarmStateRegistry::instance() {
+    static SwarmStateRegistry registry;
+    return registry;
+}
+
+void SwarmStateRegistry::setLocalId(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    local_.id = id;
+    peers_.erase(id);
+    targets_->setLocalId(id);
+    ++version_;
+}
+
+void SwarmStateRegistry::setLocalRole(const std::string& role) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (local_.role == role) return;
+    local_.role = role;
+    ++version_;
+}
+
+void SwarmStateRegistry::setLocalPosition(double lat, double lon, double alt, float vx, float vy, float vz) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    local_.lat = lat;
+    local_.lon = lon;
+    local_.alt = alt;
+    local_.vx = vx;
+    local_.vy = vy;
+    local_.vz = vz;
+    local_.updatedNs = PipelineClock::nowNs();
+    ++version_;
+}
+
+void SwarmStateRegistry::setLocalClaims(const std::vector<SwarmTargetClaim>& claims) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    local_.claims = claims;
+    ++version_;
+}
+
+SwarmPeerState SwarmStateRegistry::localState() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return local_;
+}
+
+bool SwarmStateRegistry::updatePeer(SwarmPeerState state) {
+    if (state.id.empty()) return false;
+    const std::int64_t now = PipelineClock::nowNs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state.id == local_.id) return false;  // 组播回环收到自己发出的报文
+    auto it = peers_.find(state.id);
+    if (it != peers_.end()) {
+        // 序号按 32 位回绕比较；对端沉默超过 1 s 后序号可能已随重启归零，直接接受
+        const bool stale = static_cast<std::int32_t>(state.seq - it->second.seq) <= 0;
+        if (stale && now - it->second.updatedNs < 1000000000ll) return false;
+    }
+    state.updatedNs = now;
+    targets_->mergePeer(state.id, state.targets, now);
+    state.targets.clear();  // 记录已并入目标表，对端状态中不再保留
+    peers_[state.id] = std::move(state);
+    ++version_;
+    return true;
+}
+
+std::vector<SwarmPeerState> SwarmStateRegistry::peers(std::int64_t maxAgeNs) const {
+    const std::int64_t now = PipelineClock::nowNs();
+    std::vector<SwarmPeerState> out;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        out.reserve(peers_.size());
+        for (const auto& [id, peer] : peers_) {
+            if (now - peer.updatedNs <= maxAgeNs) out.push_back(peer);
+        }
+    }
+    std::sort(out.begin(), out.end(),
+              [](const SwarmPeerState& a, const SwarmPeerState& b) { return a.id < b.id; });
+    return out;
+}
+
+std::string SwarmStateRegistry::claimOwner(std::uint32_t targetId, std::int64_t maxAgeNs) const {
+    const std::int64_t now = PipelineClock::nowNs();
+    std::string owner;
+    float best = 0.0f;
+    auto consider = [&](const SwarmPeerState& s) {
+        for (const auto& c : s.claims) {
+            if (c.targetId != targetId) continue;
+            if (owner.empty() || c.score > best || (c.score == best && s.id < owner)) {
+                owner = s.id;
+                best = c.score;
+            }
+        }
+    };
+    std::lock_guard<std::mutex> lock(mutex_);
+    consider(local_);
+    for (const auto& [id, peer] : peers_) {
+        if (now - peer.updatedNs <= maxAgeNs) consider(peer);
+    }
+    return owner;
+}
+
+std::uint64_t SwarmStateRegistry::version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+}
+
+void SwarmStateRegistry::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    local_ = SwarmPeerState{};
+    peers_.clear();
+    targets_->clear();
+    targets_->setLocalId(std::string());
+    ++version_;
+}
+
+} // namespace falconmind::sdk::cluster
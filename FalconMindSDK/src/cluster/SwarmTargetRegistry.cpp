@@ -0,0 +1,271 @@
+#include "falconmind/sdk/cluster/SwarmTargetRegistry.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace falconmind::sdk::cluster {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+// 与 GeoProjector / EventAggregator 相同的球半径（6371 km）下每度弧长
+constexpr double kMetersPerDeg = 6371000.0 * kPi / 180.0;
+constexpr std::int64_t kMaxLonCells = 64;  // 极区经向格很窄，限制搜索范围
+constexpr std::int64_t kExpireIntervalNs = 1'000'000'000;
+
+std::int64_t cellIndex(double deg, double cellDeg) noexcept {
+    return static_cast<std::int64_t>(std::floor(deg / cellDeg));
+}
+
+std::uint64_t cellKey(std::int64_t y, std::int64_t x) noexcept {
+    return (static_cast<std::uint64_t>(y) << 32) ^ static_cast<std::uint32_t>(x);
+}
+
+double distanceM(double lat1, double lon1, double lat2, double lon2) noexcept {
+    const double dn = (lat1 - lat2) * kMetersPerDeg;
+    const double de = (lon1 - lon2) * kMetersPerDeg * std::cos((lat1 + lat2) * 0.5 * kPi / 180.0);
+    return std::sqrt(dn * dn + de * de);
+}
+
+bool sameClass(std::uint16_t a, std::uint16_t b) noexcept {
+    return a == 0 || b == 0 || a == b;
+}
+
+} // namespace
+
+SwarmTargetRegistry::SwarmTargetRegistry(const SwarmTargetRegistryConfig& cfg) {
+    setConfig(cfg);
+}
+
+void SwarmTargetRegistry::setConfig(const SwarmTargetRegistryConfig& cfg) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cfg_ = cfg;
+    if (!(cfg_.radiusM > 0.)) cfg_.radiusM = 1.0;
+    if (cfg_.maxTargets == 0) cfg_.maxTargets = 1;
+    // 纬向格高等于 radiusM：radiusM 内的认领只落在上下相邻格
+    cellDeg_ = cfg_.radiusM / kMetersPerDeg;
+    entries_.clear();
+    cells_.clear();
+    localOrder_.clear();
+    cursor_ = 0;
+}
+
+SwarmTargetRegistryConfig SwarmTargetRegistry::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cfg_;
+}
+
+void SwarmTargetRegistry::setLocalId(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    localId_ = id;
+}
+
+std::uint16_t SwarmTargetRegistry::classKey(const std::string& className) noexcept {
+    if (className.empty()) return 0;
+    std::uint32_t h = 2166136261u;
+    for (unsigned char c : className) {
+        h ^= c;
+        h *= 16777619u;
+    }
+    const auto folded = static_cast<std::uint16_t>((h >> 16) ^ (h & 0xFFFFu));
+    return folded != 0 ? folded : 1;  // 0 保留给"任意类别"
+}
+
+std::uint64_t SwarmTargetRegistry::cellOf(double lat, double lon) const noexcept {
+    return cellKey(cellIndex(lat, cellDeg_), cellIndex(lon, cellDeg_));
+}
+
+template <typename Accept>
+std::uint64_t SwarmTargetRegistry::findNearest(double lat, double lon, std::uint16_t key, Accept accept) const {
+    const std::int64_t iy = cellIndex(lat, cellDeg_);
+    const std::int64_t ix = cellIndex(lon, cellDeg_);
+    // 经向格宽 cellDeg_ × cos(lat)：高纬度时多搜几列
+    const double lonCellM = cfg_.radiusM * std::max(1e-3, std::cos(lat * kPi / 180.0));
+    const std::int64_t nx = std::min<std::int64_t>(kMaxLonCells, static_cast<std::int64_t>(std::ceil(cfg_.radiusM / lonCellM)));
+
+    std::uint64_t best = 0;
+    double bestDist = cfg_.radiusM;
+    for (std::int64_t dy = -1; dy <= 1; ++dy) {
+        for (std::int64_t dx = -nx; dx <= nx; ++dx) {
+            auto range = cells_.equal_range(cellKey(iy + dy, ix + dx));
+            for (auto it = range.first; it != range.second; ++it) {
+                const Entry& e = entries_.at(it->second);
+                if (!sameClass(e.record.classKey, key) || !accept(e)) continue;
+                const double d = distanceM(lat, lon, e.record.lat, e.record.lon);
+                if (d <= bestDist) {
+                    bestDist = d;
+                    best = it->second;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+std::uint64_t SwarmTargetRegistry::insert(const SwarmTargetRecord& record, const std::string& owner,
+                                          std::int64_t nowNs) {
+    if (entries_.size() >= cfg_.maxTargets) evictOldest();
+    const std::uint64_t id = nextId_++;
+    Entry& e = entries_[id];
+    e.record = record;
+    e.owner = owner;
+    e.updatedNs = nowNs;
+    e.cell = cellOf(record.lat, record.lon);
+    cells_.emplace(e.cell, id);
+    if (owner.empty()) localOrder_.push_back(id);
+    return id;
+}
+
+void SwarmTargetRegistry::move(Entry& e, std::uint64_t id, const SwarmTargetRecord& record) {
+    const std::uint64_t cell = cellOf(record.lat, record.lon);
+    e.record = record;
+    if (cell == e.cell) return;
+    auto range = cells_.equal_range(e.cell);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == id) {
+            cells_.erase(it);
+            break;
+        }
+    }
+    e.cell = cell;
+    cells_.emplace(cell, id);
+}
+
+void SwarmTargetRegistry::erase(std::uint64_t id) {
+    auto it = entries_.find(id);
+    if (it == entries_.end()) return;
+    auto range = cells_.equal_range(it->second.cell);
+    for (auto c = range.first; c != range.second; ++c) {
+        if (c->second == id) {
+            cells_.erase(c);
+            break;
+        }
+    }
+    if (it->second.owner.empty()) {
+        auto pos = std::find(localOrder_.begin(), localOrder_.end(), id);
+        if (pos != localOrder_.end()) {
+            if (static_cast<std::size_t>(pos - localOrder_.begin()) < cursor_) --cursor_;
+            localOrder_.erase(pos);
+        }
+    }
+    entries_.erase(it);
+}
+
+void SwarmTargetRegistry::evictOldest() {
+    auto oldest = std::min_element(entries_.begin(), entries_.end(), [](const auto& a, const auto& b) {
+        return a.second.updatedNs < b.second.updatedNs;
+    });
+    if (oldest != entries_.end()) erase(oldest->first);
+}
+
+void SwarmTargetRegistry::expireLocked(std::int64_t nowNs) {
+    if (nowNs - lastExpireNs_ < kExpireIntervalNs) return;
+    lastExpireNs_ = nowNs;
+    std::vector<std::uint64_t> stale;
+    for (const auto& [id, e] : entries_) {
+        if (nowNs - e.updatedNs > cfg_.ttlNs) stale.push_back(id);
+    }
+    for (std::uint64_t id : stale) erase(id);
+    stats_.expired += stale.size();
+}
+
+void SwarmTargetRegistry::expire(std::int64_t nowNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lastExpireNs_ = nowNs - kExpireIntervalNs;
+    expireLocked(nowNs);
+}
+
+bool SwarmTargetRegistry::claimLocal(double lat, double lon, const std::string& className, float confidence,
+                                     std::int64_t nowNs) {
+    const SwarmTargetRecord record{lat, lon, classKey(className), confidence};
+    std::lock_guard<std::mutex> lock(mutex_);
+    expireLocked(nowNs);
+    const std::uint64_t id =
+        findNearest(lat, lon, record.classKey, [](const Entry& e) { return e.owner.empty(); });
+    if (id != 0) {
+        Entry& e = entries_.at(id);
+        SwarmTargetRecord merged = record;
+        merged.confidence = std::max(confidence, e.record.confidence);
+        move(e, id, merged);
+        e.updatedNs = nowNs;
+        return false;
+    }
+    insert(record, std::string(), nowNs);
+    ++stats_.localClaims;
+    return true;
+}
+
+void SwarmTargetRegistry::mergePeer(const std::string& owner, const std::vector<SwarmTargetRecord>& records,
+                                    std::int64_t nowNs) {
+    if (owner.empty() || records.empty()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (owner == localId_) return;
+    expireLocked(nowNs);
+    for (const auto& r : records) {
+        const std::uint64_t id = findNearest(r.lat, r.lon, r.classKey, [&](const Entry& e) { return e.owner == owner; });
+        if (id != 0) {
+            Entry& e = entries_.at(id);
+            move(e, id, r);
+            e.updatedNs = nowNs;
+        } else {
+            insert(r, owner, nowNs);
+        }
+        ++stats_.peerRecords;
+    }
+}
+
+std::string SwarmTargetRegistry::peerOwner(double lat, double lon, const std::string& className, std::int64_t nowNs) {
+    const std::uint16_t key = classKey(className);
+    std::lock_guard<std::mutex> lock(mutex_);
+    expireLocked(nowNs);
+    const std::uint64_t peer = findNearest(lat, lon, key, [&](const Entry& e) {
+        return !e.owner.empty() && nowNs - e.updatedNs <= cfg_.ttlNs;
+    });
+    if (peer == 0) return {};
+    const std::string& owner = entries_.at(peer).owner;
+    // 本机已认领（同步前双方各自上报）：ID 较小者继续负责
+    const bool ownedHere =
+        findNearest(lat, lon, key, [](const Entry& e) { return e.owner.empty(); }) != 0;
+    if (ownedHere && !localId_.empty() && localId_ < owner) return {};
+    ++stats_.suppressed;
+    return owner;
+}
+
+std::vector<SwarmTargetRecord> SwarmTargetRegistry::nextBroadcast(std::size_t max) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<SwarmTargetRecord> out;
+    const std::size_t n = std::min(max, localOrder_.size());
+    out.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (cursor_ >= localOrder_.size()) cursor_ = 0;
+        out.push_back(entries_.at(localOrder_[cursor_++]).record);
+    }
+    return out;
+}
+
+void SwarmTargetRegistry::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    cells_.clear();
+    localOrder_.clear();
+    cursor_ = 0;
+    lastExpireNs_ = 0;
+    stats_ = SwarmTargetRegistryStats{};
+}
+
+std::size_t SwarmTargetRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+std::size_t SwarmTargetRegistry::localCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return localOrder_.size();
+}
+
+SwarmTargetRegistryStats SwarmTargetRegistry::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace falconmind::sdk::cluster
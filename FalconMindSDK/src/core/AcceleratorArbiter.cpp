@@ -0,0 +1,215 @@
+#include "falconmind/sdk/core/AcceleratorArbiter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+// 空闲客户端至多积累的份额（加速器占用时长）
+constexpr double kMaxIdleCreditNs = 20e6;
+// 刚归还时间片、份额更少的客户端通常紧接着再次请求（推理循环）：为其保留上下文的时长
+constexpr std::int64_t kAnticipateNs = 500'000;
+
+std::int64_t steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+struct AcceleratorClient::Device {
+    struct Waiter {
+        const AcceleratorClient* client;
+        std::uint64_t seq;
+    };
+
+    std::size_t contexts{1};
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<AcceleratorClient*> clients;
+    std::size_t inUse{0};
+    std::vector<Waiter> waiters;
+    std::uint64_t nextSeq{0};
+    double grantedVtime{0.0};  // 最近一次获得时间片者的虚拟时间
+
+    // 等待者中虚拟时间最小者（相同时先到先得）是否为 seq
+    bool isNext(std::uint64_t seq) const {
+        const Waiter* best = nullptr;
+        for (const auto& w : waiters) {
+            if (!best || w.client->vtime_ < best->client->vtime_ ||
+                (w.client->vtime_ == best->client->vtime_ && w.seq < best->seq)) {
+                best = &w;
+            }
+        }
+        return best && best->seq == seq;
+    }
+
+    // 是否须为刚归还、虚拟时间更小的客户端保留上下文；须保留时 until 为保留截止时刻
+    bool reservedForOther(const AcceleratorClient* self, std::int64_t now, std::int64_t& until) const {
+        until = 0;
+        for (const auto* c : clients) {
+            if (c == self || c->held_ > 0 || c->waiting_ > 0 || c->vtime_ >= self->vtime_) continue;
+            until = std::max(until, c->lastReleaseNs_ + kAnticipateNs);
+        }
+        return until > now;
+    }
+
+    double minVtime() const {
+        double v = std::numeric_limits<double>::max();
+        for (const auto* c : clients) v = std::min(v, c->vtime_);
+        return clients.empty() ? 0.0 : v;
+    }
+};
+
+AcceleratorLease::AcceleratorLease(AcceleratorLease&& other) noexcept
+    : client_(std::move(other.client_)), grantedNs_(other.grantedNs_) {}
+
+AcceleratorLease& AcceleratorLease::operator=(AcceleratorLease&& other) noexcept {
+    if (this != &other) {
+        release();
+        client_ = std::move(other.client_);
+        grantedNs_ = other.grantedNs_;
+    }
+    return *this;
+}
+
+void AcceleratorLease::release() {
+    if (!client_) return;
+    client_->release(grantedNs_);
+    client_.reset();
+}
+
+AcceleratorClient::AcceleratorClient(std::shared_ptr<Device> device, std::string name, std::string owner, int priority)
+    : dev_(std::move(device)), device_(std::move(name)), owner_(std::move(owner)),
+      priority_(std::clamp(priority, 0, 100)), weight_(static_cast<double>(priority_ + 1)) {}
+
+AcceleratorClient::~AcceleratorClient() {
+    {
+        std::lock_guard<std::mutex> lock(dev_->mutex);
+        dev_->clients.erase(std::remove(dev_->clients.begin(), dev_->clients.end(), this), dev_->clients.end());
+    }
+    dev_->cv.notify_all();
+}
+
+AcceleratorLease AcceleratorClient::acquire() {
+    const std::int64_t begin = steadyNs();
+    std::unique_lock<std::mutex> lock(dev_->mutex);
+    if (dev_->clients.size() > 1) {
+        const std::uint64_t seq = dev_->nextSeq++;
+        // 空闲期间至多积累 kMaxIdleCreditNs 的份额，回来时不会长时间连续占用
+        vtime_ = std::max(vtime_, dev_->grantedVtime - kMaxIdleCreditNs / weight_);
+        dev_->waiters.push_back({this, seq});
+        ++waiting_;
+        for (;;) {
+            if (dev_->inUse < dev_->contexts && dev_->isNext(seq)) {
+                std::int64_t until = 0;
+                if (!dev_->reservedForOther(this, steadyNs(), until)) break;
+                dev_->cv.wait_for(lock, std::chrono::nanoseconds(until - steadyNs()));
+            } else {
+                dev_->cv.wait(lock);
+            }
+        }
+        --waiting_;
+        auto& waiters = dev_->waiters;
+        waiters.erase(std::find_if(waiters.begin(), waiters.end(), [seq](const auto& w) { return w.seq == seq; }));
+        dev_->grantedVtime = vtime_;
+    }
+    ++dev_->inUse;
+    ++held_;
+    const std::int64_t now = steadyNs();
+    ++stats_.grants;
+    stats_.waitNs += static_cast<std::uint64_t>(now - begin);
+    const bool others = !dev_->waiters.empty() && dev_->inUse < dev_->contexts;
+    lock.unlock();
+    if (others) dev_->cv.notify_all();  // 仍有空闲上下文：下一个等待者可以继续
+    return AcceleratorLease(shared_from_this(), now);
+}
+
+void AcceleratorClient::release(std::int64_t grantedNs) {
+    const std::int64_t now = steadyNs();
+    const std::int64_t busy = std::max<std::int64_t>(0, now - grantedNs);
+    {
+        std::lock_guard<std::mutex> lock(dev_->mutex);
+        --dev_->inUse;
+        --held_;
+        lastReleaseNs_ = now;
+        stats_.busyNs += static_cast<std::uint64_t>(busy);
+        vtime_ += static_cast<double>(busy) / weight_;
+    }
+    dev_->cv.notify_all();
+}
+
+AcceleratorClientStats AcceleratorClient::stats() const {
+    std::lock_guard<std::mutex> lock(dev_->mutex);
+    return stats_;
+}
+
+AcceleratorArbiter& AcceleratorArbiter::instance() {
+    static AcceleratorArbiter arbiter;
+    return arbiter;
+}
+
+std::shared_ptr<AcceleratorClient::Device> AcceleratorArbiter::deviceFor(const std::string& device) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& dev = devices_[device];
+    if (!dev) dev = std::make_shared<AcceleratorClient::Device>();
+    return dev;
+}
+
+void AcceleratorArbiter::setContexts(const std::string& device, std::size_t contexts) {
+    auto dev = deviceFor(device);
+    {
+        std::lock_guard<std::mutex> lock(dev->mutex);
+        dev->contexts = std::max<std::size_t>(1, contexts);
+    }
+    dev->cv.notify_all();
+}
+
+std::size_t AcceleratorArbiter::contexts(const std::string& device) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = devices_.find(device);
+    if (it == devices_.end()) return 1;
+    std::lock_guard<std::mutex> devLock(it->second->mutex);
+    return it->second->contexts;
+}
+
+std::shared_ptr<AcceleratorClient> AcceleratorArbiter::client(const std::string& device, const std::string& owner,
+                                                              int priority) {
+    auto dev = deviceFor(device);
+    // 构造函数私有：不能用 make_shared
+    std::shared_ptr<AcceleratorClient> client(new AcceleratorClient(dev, device, owner, priority));
+    std::lock_guard<std::mutex> lock(dev->mutex);
+    client->vtime_ = dev->minVtime();
+    dev->clients.push_back(client.get());
+    return client;
+}
+
+std::size_t AcceleratorArbiter::clientCount(const std::string& device) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = devices_.find(device);
+    if (it == devices_.end()) return 0;
+    std::lock_guard<std::mutex> devLock(it->second->mutex);
+    return it->second->clients.size();
+}
+
+void AcceleratorUser::setAcceleratorClient(std::shared_ptr<AcceleratorClient> client) {
+    std::lock_guard<std::mutex> lock(clientMutex_);
+    client_ = std::move(client);
+}
+
+std::shared_ptr<AcceleratorClient> AcceleratorUser::acceleratorClient() const {
+    std::lock_guard<std::mutex> lock(clientMutex_);
+    return client_;
+}
+
+AcceleratorLease AcceleratorUser::acquireAccelerator() const {
+    auto client = acceleratorClient();
+    return client ? client->acquire() : AcceleratorLease{};
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,298 @@
+#include "falconmind/sdk/core/AsyncLoop.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/Trace.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F, typename... Args>
+void invoke(const F& callback, Args&&... args) noexcept {
+    try {
+        callback(std::forward<Args>(args)...);
+    } catch (const std::exception& e) {
+        FM_LOG_ERROR("AsyncLoop", "callback threw: ", e.what());
+    } catch (...) {
+        FM_LOG_ERROR("AsyncLoop", "callback threw unknown exception");
+    }
+}
+
+} // namespace
+
+struct AsyncLoop::State {
+    int epollFd{-1};
+    int wakeFd{-1};
+    std::atomic<bool> running{false};
+    std::thread thread;
+    std::atomic<std::thread::id> loopThread{};
+
+    mutable std::mutex mutex;
+    std::deque<Task> posted;
+    struct Timer {
+        std::multimap<Clock::time_point, TimerId>::iterator slot;
+        TimerCallback callback;
+    };
+    std::multimap<Clock::time_point, TimerId> deadlines;
+    std::unordered_map<TimerId, Timer> timers;
+    TimerId nextTimer{1};
+    std::unordered_map<int, FdCallback> watches;
+
+    void wake() const noexcept {
+        const std::uint64_t one = 1;
+        (void)::write(wakeFd, &one, sizeof(one));
+    }
+};
+
+AsyncLoop::AsyncLoop() : state_(new State()) {}
+
+AsyncLoop::~AsyncLoop() {
+    stop();
+}
+
+bool AsyncLoop::start(const char* threadName) {
+    State& s = *state_;
+    if (s.running) return true;
+    if (s.epollFd < 0) {
+        s.epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        s.wakeFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (s.epollFd < 0 || s.wakeFd < 0) {
+            FM_LOG_ERROR("AsyncLoop", "cannot create epoll/eventfd: ", std::strerror(errno));
+            if (s.epollFd >= 0) ::close(s.epollFd);
+            if (s.wakeFd >= 0) ::close(s.wakeFd);
+            s.epollFd = s.wakeFd = -1;
+            return false;
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = s.wakeFd;
+        ::epoll_ctl(s.epollFd, EPOLL_CTL_ADD, s.wakeFd, &ev);
+    }
+    s.running = true;
+    s.thread = std::thread([this, threadName] {
+        FM_TRACE_THREAD_NAME(threadName);
+        loop();
+    });
+    return true;
+}
+
+void AsyncLoop::stop() {
+    State& s = *state_;
+    if (inLoopThread()) {
+        FM_LOG_ERROR("AsyncLoop", "stop() called from the loop thread");
+        return;
+    }
+    if (s.running.exchange(false)) {
+        s.wake();
+        if (s.thread.joinable()) s.thread.join();
+    }
+    drainCancelled();
+    if (s.epollFd >= 0) {
+        ::close(s.epollFd);
+        ::close(s.wakeFd);
+        s.epollFd = s.wakeFd = -1;
+    }
+}
+
+bool AsyncLoop::running() const noexcept {
+    return state_->running.load(std::memory_order_acquire);
+}
+
+bool AsyncLoop::inLoopThread() const noexcept {
+    return state_->loopThread.load(std::memory_order_relaxed) == std::this_thread::get_id();
+}
+
+bool AsyncLoop::post(Task task) {
+    State& s = *state_;
+    if (!task) return false;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (!s.running) return false;
+        s.posted.push_back(std::move(task));
+    }
+    if (!inLoopThread()) s.wake();
+    return true;
+}
+
+AsyncLoop::TimerId AsyncLoop::after(std::chrono::nanoseconds delay, TimerCallback callback) {
+    State& s = *state_;
+    if (!callback) return 0;
+    const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(delay);
+    TimerId id = 0;
+    bool earliest = false;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (!s.running) return 0;
+        id = s.nextTimer++;
+        auto slot = s.deadlines.emplace(deadline, id);
+        earliest = slot == s.deadlines.begin();
+        s.timers.emplace(id, State::Timer{slot, std::move(callback)});
+    }
+    // 新定时器早于循环当前的等待截止时间时才需要唤醒
+    if (earliest && !inLoopThread()) s.wake();
+    return id;
+}
+
+bool AsyncLoop::cancel(TimerId id) {
+    State& s = *state_;
+    TimerCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto it = s.timers.find(id);
+        if (it == s.timers.end()) return false;
+        s.deadlines.erase(it->second.slot);
+        callback = std::move(it->second.callback);
+        s.timers.erase(it);
+    }
+    if (!post([callback = std::move(callback)] { invoke(callback, false); })) {
+        // 停止过程中：不会再有人执行投递任务，就地回调
+        invoke(callback, false);
+    }
+    return true;
+}
+
+bool AsyncLoop::watch(int fd, std::uint32_t events, FdCallback callback) {
+    State& s = *state_;
+    if (fd < 0 || !callback) return false;
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.running || s.watches.count(fd)) return false;
+    epoll_event ev{};
+    ev.events = events | EPOLLONESHOT;
+    ev.data.fd = fd;
+    if (::epoll_ctl(s.epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        FM_LOG_WARN("AsyncLoop", "cannot watch fd ", fd, ": ", std::strerror(errno));
+        return false;
+    }
+    s.watches.emplace(fd, std::move(callback));
+    return true;
+}
+
+bool AsyncLoop::unwatch(int fd) {
+    State& s = *state_;
+    FdCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto it = s.watches.find(fd);
+        if (it == s.watches.end()) return false;
+        ::epoll_ctl(s.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        callback = std::move(it->second);
+        s.watches.erase(it);
+    }
+    if (!post([callback = std::move(callback)] { invoke(callback, 0u); })) {
+        invoke(callback, 0u);
+    }
+    return true;
+}
+
+std::size_t AsyncLoop::pendingWaits() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->timers.size() + state_->watches.size();
+}
+
+void AsyncLoop::loop() {
+    State& s = *state_;
+    s.loopThread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    constexpr int kMaxEvents = 64;
+    epoll_event events[kMaxEvents];
+    std::deque<Task> tasks;
+    std::vector<TimerCallback> due;
+    while (s.running.load(std::memory_order_acquire)) {
+        int timeoutMs = -1;
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            if (!s.posted.empty()) {
+                timeoutMs = 0;
+            } else if (!s.deadlines.empty()) {
+                const auto wait = s.deadlines.begin()->first - Clock::now();
+                // 向上取整到毫秒，避免提前醒来后空转
+                timeoutMs = wait <= Clock::duration::zero()
+                    ? 0
+                    : static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(wait).count());
+            }
+        }
+        const int n = ::epoll_wait(s.epollFd, events, kMaxEvents, timeoutMs);
+        for (int i = 0; i < n; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == s.wakeFd) {
+                std::uint64_t value = 0;
+                (void)::read(s.wakeFd, &value, sizeof(value));
+                continue;
+            }
+            FdCallback callback;
+            {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                auto it = s.watches.find(fd);
+                if (it == s.watches.end()) continue;  // 已被 unwatch()
+                ::epoll_ctl(s.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+                callback = std::move(it->second);
+                s.watches.erase(it);
+            }
+            invoke(callback, static_cast<std::uint32_t>(events[i].events));
+        }
+
+        {
+            const auto now = Clock::now();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            while (!s.deadlines.empty() && s.deadlines.begin()->first <= now) {
+                auto it = s.timers.find(s.deadlines.begin()->second);
+                due.push_back(std::move(it->second.callback));
+                s.timers.erase(it);
+                s.deadlines.erase(s.deadlines.begin());
+            }
+            tasks.swap(s.posted);
+        }
+        for (auto& callback : due) invoke(callback, true);
+        due.clear();
+        for (auto& task : tasks) invoke(task);
+        tasks.clear();
+    }
+    s.loopThread.store(std::thread::id{}, std::memory_order_relaxed);
+}
+
+void AsyncLoop::drainCancelled() {
+    State& s = *state_;
+    // 取消回调可能让协程收尾并投递新任务或再次登记（均被拒绝），循环到不再有待处理项
+    for (;;) {
+        std::deque<Task> tasks;
+        std::vector<TimerCallback> timers;
+        std::vector<FdCallback> watches;
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            tasks.swap(s.posted);
+            for (auto& [id, timer] : s.timers) {
+                (void)id;
+                timers.push_back(std::move(timer.callback));
+            }
+            s.timers.clear();
+            s.deadlines.clear();
+            for (auto& [fd, callback] : s.watches) {
+                ::epoll_ctl(s.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+                watches.push_back(std::move(callback));
+            }
+            s.watches.clear();
+        }
+        if (tasks.empty() && timers.empty() && watches.empty()) return;
+        for (auto& task : tasks) invoke(task);
+        for (auto& callback : timers) invoke(callback, false);
+        for (auto& callback : watches) invoke(callback, 0u);
+    }
+}
+
+} // namespace falconmind::sdk::core
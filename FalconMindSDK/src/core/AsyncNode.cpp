@@ -0,0 +1,121 @@
+#include "falconmind/sdk/core/AsyncNode.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/Pad.h"
+
+namespace falconmind::sdk::core {
+
+AsyncContext::AsyncContext(AsyncLoop& loop, Node& node) : loop_(loop), node_(node) {
+    // 调度器在 Source 线程启动前构造，此时没有并发推送，可安全替换 Pad 回调
+    for (const auto& [name, pad] : node_.pads()) {
+        (void)name;
+        if (!pad || pad->type() == PadType::Source) continue;
+        auto box = std::make_unique<Inbox>();
+        box->pad = pad.get();
+        Inbox* raw = box.get();
+        pad->setBufferCallback([this, raw](const BufferRef& buffer) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closed_.load(std::memory_order_relaxed)) return;
+            if (raw->items.size() >= kReadBacklog) {
+                raw->items.pop_front();
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+            raw->items.push_back(buffer);
+        });
+        inboxes_.push_back(std::move(box));
+    }
+}
+
+AsyncContext::~AsyncContext() {
+    close();
+}
+
+bool AsyncContext::post(AsyncLoop::Task task) {
+    return !closed() && loop_.post(std::move(task));
+}
+
+AsyncLoop::TimerId AsyncContext::after(std::chrono::nanoseconds delay, AsyncLoop::TimerCallback callback) {
+    return closed() ? 0 : loop_.after(delay, std::move(callback));
+}
+
+bool AsyncContext::watch(int fd, std::uint32_t events, AsyncLoop::FdCallback callback) {
+    return !closed() && loop_.watch(fd, events, std::move(callback));
+}
+
+AsyncContext::Inbox* AsyncContext::inbox(const Pad& pad) {
+    for (auto& box : inboxes_) {
+        if (box->pad == &pad) return box.get();
+    }
+    return nullptr;
+}
+
+bool AsyncContext::tryRead(Pad& pad, BufferRef& out) {
+    Inbox* box = inbox(pad);
+    if (!box) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (box->items.empty()) return false;
+    out = std::move(box->items.front());
+    box->items.pop_front();
+    return true;
+}
+
+bool AsyncContext::read(Pad& pad, ReadCallback callback) {
+    Inbox* box = inbox(pad);
+    if (!box || !callback) return false;
+    bool ready = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_.load(std::memory_order_relaxed) || box->waiter) return false;
+        box->waiter = std::move(callback);
+        ready = !box->items.empty();
+    }
+    // 不在调用栈内回调：已有积压时交给下一轮循环
+    if (ready) notifyArrival();
+    return true;
+}
+
+void AsyncContext::notifyArrival() {
+    if (closed() || dispatchPosted_.exchange(true)) return;
+    if (!loop_.post([this] { drainAndDispatch(); })) dispatchPosted_.store(false);
+}
+
+void AsyncContext::drainAndDispatch() {
+    dispatchPosted_.store(false);
+    if (closed()) return;
+    // 队列连接在循环线程（唯一消费者）取出，经 BufferCallback 进入积压
+    bool more = false;
+    for (auto& box : inboxes_) {
+        box->pad->drainQueued(kReadBacklog);
+        more = more || box->pad->hasQueuedData();
+    }
+    for (auto& box : inboxes_) {
+        ReadCallback waiter;
+        BufferRef buffer;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!box->waiter || box->items.empty()) continue;
+            waiter = std::move(box->waiter);
+            box->waiter = nullptr;
+            buffer = std::move(box->items.front());
+            box->items.pop_front();
+        }
+        waiter(std::move(buffer));
+    }
+    if (more) notifyArrival();
+}
+
+void AsyncContext::close() {
+    std::vector<ReadCallback> waiters;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_.exchange(true)) return;
+        for (auto& box : inboxes_) {
+            box->pad->setBufferCallback(nullptr);
+            box->items.clear();
+            if (box->waiter) waiters.push_back(std::move(box->waiter));
+            box->waiter = nullptr;
+        }
+    }
+    for (auto& waiter : waiters) waiter(BufferRef{});
+}
+
+} // namespace falconmind::sdk::core
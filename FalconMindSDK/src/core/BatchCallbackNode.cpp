@@ -0,0 +1,63 @@
+#include "falconmind/sdk/core/BatchCallbackNode.h"
+#include "falconmind/sdk/core/Pad.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace falconmind::sdk::core {
+
+BatchCallbackNode::BatchCallbackNode(BatchHandler handler) : BatchCallbackNode(std::move(handler), Config{}) {}
+
+BatchCallbackNode::BatchCallbackNode(BatchHandler handler, const Config& config)
+    : Node("batch_callback")
+    , handler_(std::move(handler))
+    , config_(config)
+    , queue_(config.queueCapacity) {
+    config_.batchSize = std::max<std::size_t>(config_.batchSize, 1);
+    auto* in = addPad(std::make_shared<Pad>("in", PadType::Sink));
+    in->setBufferCallback([this](const BufferRef& buffer) {
+        if (running_.load(std::memory_order_relaxed)) queue_.push(buffer);
+    });
+    outPad_ = addPad(std::make_shared<Pad>("out", PadType::Source));
+}
+
+BatchCallbackNode::~BatchCallbackNode() {
+    stop();
+}
+
+bool BatchCallbackNode::start() {
+    if (running_) return true;
+    if (!handler_) {
+        std::cerr << "[BatchCallbackNode] No handler for " << id() << std::endl;
+        return false;
+    }
+    queue_.reopen();
+    running_ = true;
+    worker_ = std::thread(&BatchCallbackNode::workerLoop, this);
+    return true;
+}
+
+void BatchCallbackNode::stop() {
+    if (!running_.exchange(false)) return;
+    queue_.close();
+    if (worker_.joinable()) worker_.join();
+}
+
+void BatchCallbackNode::workerLoop() {
+    std::vector<BufferRef> inputs;
+    std::vector<BufferRef> outputs;
+    inputs.reserve(config_.batchSize);
+    while (running_) {
+        inputs.clear();
+        if (queue_.popBatch(inputs, config_.batchSize, std::chrono::milliseconds(-1)) == 0) continue;
+        outputs.clear();
+        handler_(inputs, outputs);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        processed_.fetch_add(inputs.size(), std::memory_order_relaxed);
+        for (const auto& out : outputs) {
+            if (out) outPad_->pushBuffer(out);
+        }
+    }
+}
+
+} // namespace falconmind::sdk::core
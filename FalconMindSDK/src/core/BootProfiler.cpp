@@ -0,0 +1,184 @@
+#include "falconmind/sdk/core/BootProfiler.h"
+#include "falconmind/sdk/core/Log.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+std::uint32_t currentThreadId() {
+    return static_cast<std::uint32_t>(::syscall(SYS_gettid));
+}
+
+// /proc/self/stat 第 22 个字段：进程创建时刻（自上电起的时钟滴答数）；读取失败返回 -1
+std::int64_t processStartNs() {
+    std::ifstream in("/proc/self/stat");
+    std::string stat((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    // comm 字段可能含空格，从右括号之后开始数（第 3 个字段起）
+    auto pos = stat.rfind(')');
+    if (pos == std::string::npos) return -1;
+    std::istringstream fields(stat.substr(pos + 2));
+    std::string field;
+    for (int i = 3; i <= 22 && fields >> field; ++i) {
+        if (i == 22) {
+            const long ticks = ::sysconf(_SC_CLK_TCK);
+            if (ticks <= 0) return -1;
+            return static_cast<std::int64_t>(std::stoll(field) * (1000000000LL / ticks));
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+BootProfiler& BootProfiler::instance() {
+    static BootProfiler profiler;
+    return profiler;
+}
+
+BootProfiler::BootProfiler() {
+    if (const char* path = std::getenv("FALCONMIND_BOOT_TRACE"); path && *path) {
+        enable(path);
+    }
+}
+
+void BootProfiler::enable(const std::string& outputPath) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!outputPath.empty()) outputPath_ = outputPath;
+    if (enabled_) return;
+    enabled_ = true;
+    finished_ = false;
+    const std::int64_t started = processStartNs();
+    if (started >= 0 && spans_.empty()) {
+        spans_.push_back(BootSpanRecord{"process_start", "boot", started, -1, currentThreadId()});
+    }
+}
+
+void BootProfiler::disable() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    enabled_ = false;
+}
+
+bool BootProfiler::enabled() const noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return enabled_;
+}
+
+void BootProfiler::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    spans_.clear();
+    finished_ = false;
+}
+
+std::int64_t BootProfiler::nowNs() noexcept {
+    timespec ts{};
+    ::clock_gettime(CLOCK_BOOTTIME, &ts);
+    return static_cast<std::int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+void BootProfiler::record(std::string name, const char* category, std::int64_t startNs, std::int64_t endNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_ || spans_.size() >= kMaxSpans) return;
+    spans_.push_back(BootSpanRecord{std::move(name), category ? category : "boot", startNs,
+                                    endNs >= startNs ? endNs - startNs : -1, currentThreadId()});
+}
+
+void BootProfiler::mark(std::string name, const char* category) {
+    const std::int64_t now = nowNs();
+    record(std::move(name), category, now, -1);
+}
+
+bool BootProfiler::finish(const std::string& readyName) {
+    const std::int64_t readyNs = nowNs();
+    std::string path;
+    std::size_t events = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!enabled_ || finished_) return false;
+        if (spans_.size() < kMaxSpans) {
+            spans_.push_back(BootSpanRecord{readyName, "boot", readyNs, -1, currentThreadId()});
+        }
+        finished_ = true;
+        enabled_ = false;
+        path = outputPath_;
+        events = spans_.size();
+    }
+    FM_LOG_INFO("BootProfiler", readyName, " at ", static_cast<double>(readyNs) / 1e6, " ms since power-on (",
+                events, " events)");
+    if (path.empty()) return false;
+    if (!writeChromeTrace(path)) {
+        FM_LOG_WARN("BootProfiler", "Cannot write boot trace to ", path);
+        return false;
+    }
+    return true;
+}
+
+std::vector<BootSpanRecord> BootProfiler::spans() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return spans_;
+}
+
+std::string BootProfiler::toChromeTrace() const {
+    const auto all = spans();
+    const auto pid = static_cast<std::int64_t>(::getpid());
+    nlohmann::json events = nlohmann::json::array();
+    events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", pid}, {"args", {{"name", "falconmind boot"}}}});
+    for (const auto& s : all) {
+        nlohmann::json e = {{"name", s.name},
+                            {"cat", s.category},
+                            {"pid", pid},
+                            {"tid", s.threadId},
+                            {"ts", static_cast<double>(s.startNs) / 1e3}};
+        if (s.durationNs >= 0) {
+            e["ph"] = "X";
+            e["dur"] = static_cast<double>(s.durationNs) / 1e3;
+        } else {
+            e["ph"] = "i";
+            e["s"] = "p";
+        }
+        events.push_back(std::move(e));
+    }
+    nlohmann::json trace = {{"traceEvents", std::move(events)},
+                            {"displayTimeUnit", "ms"},
+                            {"otherData", {{"clock", "CLOCK_BOOTTIME"}}}};
+    return trace.dump();
+}
+
+bool BootProfiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) return false;
+    out << toChromeTrace() << '\n';
+    return static_cast<bool>(out);
+}
+
+BootSpan::BootSpan(const char* name, const char* category) : category_(category) {
+    if (BootProfiler::instance().enabled()) {
+        name_ = name;
+        startNs_ = BootProfiler::nowNs();
+    }
+}
+
+BootSpan::BootSpan(std::string name, const char* category) : category_(category) {
+    if (BootProfiler::instance().enabled()) {
+        name_ = std::move(name);
+        startNs_ = BootProfiler::nowNs();
+    }
+}
+
+BootSpan::~BootSpan() {
+    if (startNs_ >= 0) {
+        BootProfiler::instance().record(std::move(name_), category_, startNs_, BootProfiler::nowNs());
+    }
+}
+
+} // namespace falconmind::sdk::core
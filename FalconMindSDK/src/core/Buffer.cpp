@@ -0,0 +1,226 @@
+#include "falconmind/sdk/core/Buffer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+namespace falconmind::sdk::core {
+
+// 设备缓冲的 host 视图与各域视图缓存，与存储同生命周期（只改元数据的视图存储共享同一份）
+struct BufferDomainState {
+    std::mutex hostMutex;
+    std::atomic<const std::uint8_t*> host{nullptr};
+    std::vector<std::uint8_t> hostCopy;  // download() 的目标；生成后不再改变
+    std::mutex viewMutex;
+    std::array<std::shared_ptr<DeviceMemory>, 4> views;  // 按 MemoryDomain 下标
+};
+
+namespace {
+
+const BufferMeta kEmptyMeta{};
+const std::shared_ptr<DeviceMemory> kNoDevice;
+
+std::atomic<std::uint64_t> gHostMaps{0};
+std::atomic<std::uint64_t> gHostDownloads{0};
+std::atomic<std::uint64_t> gDeviceImports{0};
+std::atomic<std::uint64_t> gViewCacheHits{0};
+
+// host 缓冲首次请求设备视图时才创建状态；多个持有者可能并发请求，以原子 shared_ptr 操作发布
+std::shared_ptr<BufferDomainState> domainState(BufferStorage& storage) {
+    auto state = std::atomic_load(&storage.domainState);
+    if (state) return state;
+    auto created = std::make_shared<BufferDomainState>();
+    if (std::atomic_compare_exchange_strong(&storage.domainState, &state, created)) return created;
+    return state;  // 被其它线程抢先创建
+}
+
+} // namespace
+
+MemoryDomainStats memoryDomainStats() noexcept {
+    MemoryDomainStats out;
+    out.hostMaps = gHostMaps.load(std::memory_order_relaxed);
+    out.hostDownloads = gHostDownloads.load(std::memory_order_relaxed);
+    out.deviceImports = gDeviceImports.load(std::memory_order_relaxed);
+    out.viewCacheHits = gViewCacheHits.load(std::memory_order_relaxed);
+    return out;
+}
+
+BufferRef BufferRef::allocate(std::size_t size) {
+    auto storage = std::make_shared<BufferStorage>();
+    storage->owned.resize(size);
+    storage->data = storage->owned.data();
+    storage->size = size;
+    return BufferRef(std::move(storage));
+}
+
+BufferRef BufferRef::copyFrom(const void* data, std::size_t size) {
+    auto storage = std::make_shared<BufferStorage>();
+    const auto* p = static_cast<const std::uint8_t*>(data);
+    if (p && size > 0) {
+        storage->owned.assign(p, p + size);
+    }
+    storage->data = storage->owned.data();
+    storage->size = storage->owned.size();
+    return BufferRef(std::move(storage));
+}
+
+BufferRef BufferRef::wrap(std::uint8_t* data, std::size_t size, std::shared_ptr<void> holder) {
+    auto storage = std::make_shared<BufferStorage>();
+    storage->data = data;
+    storage->size = size;
+    storage->external = std::move(holder);
+    return BufferRef(std::move(storage));
+}
+
+BufferRef BufferRef::wrapReadOnly(const std::uint8_t* data, std::size_t size, std::shared_ptr<void> holder) {
+    BufferRef ref = wrap(const_cast<std::uint8_t*>(data), size, std::move(holder));
+    ref.storage_->readOnly = true;
+    return ref;
+}
+
+BufferRef BufferRef::wrapDevice(std::shared_ptr<DeviceMemory> memory, const void* header, std::size_t headerSize) {
+    if (!memory) return {};
+    auto storage = std::make_shared<BufferStorage>();
+    const auto* h = static_cast<const std::uint8_t*>(header);
+    if (h && headerSize > 0) {
+        storage->owned.assign(h, h + headerSize);
+    }
+    storage->size = storage->owned.size() + memory->size();
+    storage->readOnly = true;
+    storage->meta.dmabufFd = memory->fd();
+    storage->device = std::move(memory);
+    storage->domainState = std::make_shared<BufferDomainState>();
+    return BufferRef(std::move(storage));
+}
+
+const BufferMeta& BufferRef::meta() const {
+    return storage_ ? storage_->meta : kEmptyMeta;
+}
+
+const std::uint8_t* BufferRef::hostView() const noexcept {
+    BufferStorage& s = *storage_;
+    if (!s.device || !s.domainState) return nullptr;
+    BufferDomainState& state = *s.domainState;
+    if (const std::uint8_t* p = state.host.load(std::memory_order_acquire)) return p;
+    std::lock_guard<std::mutex> lock(state.hostMutex);
+    if (const std::uint8_t* p = state.host.load(std::memory_order_relaxed)) return p;
+    const std::size_t headerSize = s.owned.size();
+    const std::uint8_t* mapped = s.device->mapHost();
+    const std::uint8_t* p = mapped;
+    if (!mapped || headerSize > 0) {
+        // 帧头与设备数据不连续（或不可映射）：拼成一份 host 副本
+        try {
+            state.hostCopy.resize(s.size);
+        } catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+        std::memcpy(state.hostCopy.data(), s.owned.data(), headerSize);
+        std::uint8_t* payload = state.hostCopy.data() + headerSize;
+        if (mapped) {
+            std::memcpy(payload, mapped, s.size - headerSize);
+        } else if (!s.device->download(payload)) {
+            state.hostCopy.clear();
+            return nullptr;
+        }
+        p = state.hostCopy.data();
+    }
+    (mapped ? gHostMaps : gHostDownloads).fetch_add(1, std::memory_order_relaxed);
+    state.host.store(p, std::memory_order_release);
+    return p;
+}
+
+const std::uint8_t* BufferRef::headerData(std::size_t bytes) const noexcept {
+    if (!storage_) return nullptr;
+    if (storage_->data) return storage_->data;
+    if (storage_->device && bytes <= storage_->owned.size()) return storage_->owned.data();
+    return data();
+}
+
+bool BufferRef::hostResident() const noexcept {
+    if (!storage_) return false;
+    if (storage_->data || !storage_->device) return true;
+    return storage_->domainState && storage_->domainState->host.load(std::memory_order_acquire) != nullptr;
+}
+
+const std::shared_ptr<DeviceMemory>& BufferRef::deviceMemory() const noexcept {
+    return storage_ ? storage_->device : kNoDevice;
+}
+
+int BufferRef::dmabufFd() const noexcept {
+    if (!storage_) return -1;
+    if (storage_->device && storage_->device->fd() >= 0) return storage_->device->fd();
+    return storage_->meta.dmabufFd;
+}
+
+std::shared_ptr<DeviceMemory> BufferRef::deviceView(MemoryDomain target, const DeviceImporter& import) const {
+    if (!storage_) return nullptr;
+    if (storage_->device && storage_->device->domain() == target) return storage_->device;
+    auto state = domainState(*storage_);
+    std::lock_guard<std::mutex> lock(state->viewMutex);
+    auto& slot = state->views[static_cast<std::size_t>(target)];
+    if (slot) {
+        gViewCacheHits.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+    if (target == MemoryDomain::DmaBuf && !storage_->device && storage_->meta.dmabufFd >= 0) {
+        // 数据本就在 DMABUF 中（如 V4L2 导出缓冲）：借用 fd，不导入；fd 在持有本缓冲期间有效
+        slot = std::make_shared<DmaBufMemory>(storage_->meta.dmabufFd, storage_->size, false);
+        return slot;
+    }
+    if (!import) return nullptr;
+    slot = import(*this);
+    if (slot) gDeviceImports.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+void BufferRef::makeUnique(bool writeData) {
+    const bool mustCopy = writeData && (storage_ && (storage_->readOnly || storage_->device));
+    if (!storage_ || (storage_.use_count() == 1 && !mustCopy)) {
+        return;
+    }
+    if ((storage_->readOnly || storage_->device) && !writeData) {
+        // 只改元数据：新建指向同一只读 / 设备数据的存储，原存储作为 holder 保持数据有效
+        auto view = std::make_shared<BufferStorage>();
+        view->data = storage_->data;
+        view->size = storage_->size;
+        view->readOnly = true;
+        view->meta = storage_->meta;
+        view->external = storage_;
+        view->device = storage_->device;
+        view->owned = storage_->owned;  // 设备缓冲的帧头副本
+        view->domainState = std::atomic_load(&storage_->domainState);
+        storage_ = std::move(view);
+        return;
+    }
+    // 设备缓冲在这里迁移到 host；迁移失败时副本为空
+    auto copy = std::make_shared<BufferStorage>();
+    const std::uint8_t* src = data();
+    if (src && storage_->size > 0) {
+        copy->owned.assign(src, src + storage_->size);
+    }
+    copy->data = copy->owned.data();
+    copy->size = copy->owned.size();
+    copy->meta = storage_->meta;
+    copy->meta.dmabufFd = -1;  // 副本不在原 DMABUF 中
+    storage_ = std::move(copy);
+}
+
+std::uint8_t* BufferRef::mutableData() {
+    makeUnique(true);
+    if (!storage_) return nullptr;
+    // 独占的 host 缓冲将被改写，之前导入的设备视图作废
+    if (std::atomic_load(&storage_->domainState)) std::atomic_store(&storage_->domainState, {});
+    return storage_->data;
+}
+
+BufferMeta& BufferRef::mutableMeta() {
+    if (!storage_) {
+        storage_ = std::make_shared<BufferStorage>();
+    }
+    makeUnique(false);
+    return storage_->meta;
+}
+
+} // namespace falconmind::sdk::core
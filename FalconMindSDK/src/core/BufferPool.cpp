@@ -0,0 +1,168 @@
+#include "falconmind/sdk/core/BufferPool.h"
+
+#include <functional>
+
+namespace falconmind::sdk::core {
+
+std::size_t BufferPoolKeyHash::operator()(const BufferPoolKey& key) const noexcept {
+    std::size_t h = std::hash<std::string>{}(key.format);
+    h ^= std::hash<std::int32_t>{}(key.width) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<std::int32_t>{}(key.height) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+struct BufferPool::Shared {
+    struct Slot {
+        std::vector<std::vector<std::uint8_t>> free;
+        std::size_t outstanding{0};
+    };
+
+    BufferPoolConfig config;
+    mutable std::mutex mutex;
+    std::unordered_map<BufferPoolKey, Slot, BufferPoolKeyHash> slots;
+    bool closed{false};
+    BufferPoolStats stats;
+    std::shared_ptr<MemoryAccount> account;
+
+    // 以下两个须持有 mutex
+    void charge(std::size_t bytes) {
+        stats.pooledBytes += bytes;
+        if (account) account->charge(bytes);
+    }
+    void discharge(std::size_t bytes) {
+        stats.pooledBytes -= bytes;
+        if (account) account->release(bytes);
+    }
+
+    void release(const BufferPoolKey& key, std::vector<std::uint8_t>&& memory) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = slots.find(key);
+        if (it == slots.end()) {
+            discharge(memory.size());
+            return;
+        }
+        if (it->second.outstanding > 0) {
+            --it->second.outstanding;
+            --stats.outstandingBuffers;
+        }
+        // 上限调低后多出的缓冲不再回到空闲列表
+        if (!closed && it->second.free.size() + it->second.outstanding < config.maxBuffersPerKey) {
+            it->second.free.push_back(std::move(memory));
+            ++stats.freeBuffers;
+        } else {
+            discharge(memory.size());
+        }
+    }
+};
+
+BufferPool::BufferPool(const BufferPoolConfig& cfg)
+    : shared_(std::make_shared<Shared>()) {
+    shared_->config = cfg;
+}
+
+BufferPool::~BufferPool() {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    shared_->closed = true;
+    // 在途缓冲之后直接释放、不再回调本池，一并从账户扣除
+    shared_->discharge(shared_->stats.pooledBytes);
+    shared_->slots.clear();
+}
+
+BufferRef BufferPool::acquire(const BufferPoolKey& key, std::size_t size) {
+    std::vector<std::uint8_t> memory;
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        auto& slot = shared_->slots[key];
+        // 同一 key 下尺寸变化（如 stride 改变）的旧缓冲直接丢弃
+        while (!slot.free.empty()) {
+            memory = std::move(slot.free.back());
+            slot.free.pop_back();
+            --shared_->stats.freeBuffers;
+            if (memory.size() == size) break;
+            shared_->discharge(memory.size());
+            memory = {};
+        }
+        if (memory.size() == size) {
+            ++shared_->stats.reuses;
+        } else if (slot.outstanding < shared_->config.maxBuffersPerKey) {
+            ++shared_->stats.allocations;
+            shared_->charge(size);
+        } else {
+            ++shared_->stats.overflowAllocations;
+            std::shared_ptr<MemoryAccount> account = shared_->account;
+            if (!account) {
+                return BufferRef::allocate(size);
+            }
+            // 临时分配同样记账，最后一个引用释放时扣除
+            account->charge(size);
+            auto* storage = new BufferStorage();
+            storage->owned.resize(size);
+            storage->data = storage->owned.data();
+            storage->size = size;
+            return BufferRef(std::shared_ptr<BufferStorage>(storage, [account, size](BufferStorage* s) {
+                account->release(size);
+                delete s;
+            }));
+        }
+        ++slot.outstanding;
+        ++shared_->stats.outstandingBuffers;
+    }
+    if (memory.size() != size) {
+        memory.resize(size);
+    }
+
+    std::weak_ptr<Shared> weak = shared_;
+    auto* storage = new BufferStorage();
+    storage->owned = std::move(memory);
+    storage->data = storage->owned.data();
+    storage->size = storage->owned.size();
+    storage->owner = this;
+    return BufferRef(std::shared_ptr<BufferStorage>(storage, [weak, key](BufferStorage* s) {
+        if (auto pool = weak.lock()) {
+            pool->release(key, std::move(s->owned));
+        }
+        delete s;
+    }));
+}
+
+void BufferPool::clear() {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    for (auto& [key, slot] : shared_->slots) {
+        (void)key;
+        shared_->stats.freeBuffers -= slot.free.size();
+        for (const auto& memory : slot.free) shared_->discharge(memory.size());
+        slot.free.clear();
+    }
+}
+
+void BufferPool::setMemoryAccount(std::shared_ptr<MemoryAccount> account) {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    if (shared_->account) shared_->account->release(shared_->stats.pooledBytes);
+    shared_->account = std::move(account);
+    if (shared_->account) shared_->account->charge(shared_->stats.pooledBytes);
+}
+
+void BufferPool::setMaxBuffersPerKey(std::size_t maxBuffers) {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    shared_->config.maxBuffersPerKey = maxBuffers;
+    for (auto& [key, slot] : shared_->slots) {
+        (void)key;
+        while (!slot.free.empty() && slot.free.size() + slot.outstanding > maxBuffers) {
+            shared_->discharge(slot.free.back().size());
+            slot.free.pop_back();
+            --shared_->stats.freeBuffers;
+        }
+    }
+}
+
+std::size_t BufferPool::maxBuffersPerKey() const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    return shared_->config.maxBuffersPerKey;
+}
+
+BufferPoolStats BufferPool::stats() const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    return shared_->stats;
+}
+
+} // namespace falconmind::sdk::core
@@ -1,23 +1,182 @@
 #include "falconmind/sdk/core/Bus.h"
 
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+
 namespace falconmind::sdk::core {
 
+namespace {
+
+// 全局类别驻留表：id 0 保留给空类别；名称存放在 deque 中保证引用稳定
+struct CategoryRegistry {
+    std::mutex mutex;
+    std::unordered_map<std::string, BusCategory::Id> ids;
+    std::deque<std::string> names{std::string()};
+
+    static CategoryRegistry& instance() {
+        static CategoryRegistry registry;
+        return registry;
+    }
+
+    BusCategory::Id intern(const std::string& name) {
+        if (name.empty()) return 0;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+        auto id = static_cast<BusCategory::Id>(names.size());
+        names.push_back(name);
+        ids.emplace(name, id);
+        return id;
+    }
+
+    const std::string& name(BusCategory::Id id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return id < names.size() ? names[id] : names.front();
+    }
+};
+
+} // namespace
+
+BusCategory::BusCategory(const char* name)
+    : id_(name ? CategoryRegistry::instance().intern(name) : 0) {}
+
+BusCategory::BusCategory(const std::string& name)
+    : id_(CategoryRegistry::instance().intern(name)) {}
+
+BusCategory BusCategory::fromId(Id id) noexcept {
+    BusCategory c;
+    c.id_ = id;
+    return c;
+}
+
+const std::string& BusCategory::name() const {
+    return CategoryRegistry::instance().name(id_);
+}
+
+Bus::Bus(const BusConfig& cfg)
+    : config_(cfg)
+    , subscribers_(std::make_shared<Subscribers>())
+    , queue_(cfg.asyncQueueCapacity > 0 ? cfg.asyncQueueCapacity : 1) {}
+
+Bus::~Bus() {
+    stopping_ = true;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+    }
+    wakeCv_.notify_all();
+    if (dispatcher_.joinable()) {
+        dispatcher_.join();
+    }
+}
+
+std::shared_ptr<const Bus::Subscribers> Bus::snapshot() const {
+    return std::atomic_load(&subscribers_);
+}
+
 int Bus::subscribe(const Handler& handler) {
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    auto next = std::make_shared<Subscribers>(*snapshot());
     int id = nextId_++;
-    handlers_.emplace(id, handler);
+    next->all.push_back({id, handler});
+    std::atomic_store(&subscribers_, std::shared_ptr<const Subscribers>(std::move(next)));
+    return id;
+}
+
+int Bus::subscribe(const BusCategory& category, const Handler& handler) {
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    auto next = std::make_shared<Subscribers>(*snapshot());
+    int id = nextId_++;
+    if (next->byCategory.size() <= category.id()) {
+        next->byCategory.resize(category.id() + 1);
+    }
+    next->byCategory[category.id()].push_back({id, handler});
+    std::atomic_store(&subscribers_, std::shared_ptr<const Subscribers>(std::move(next)));
     return id;
 }
 
 void Bus::unsubscribe(int id) {
-    handlers_.erase(id);
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    auto next = std::make_shared<Subscribers>(*snapshot());
+    auto matches = [id](const Subscription& s) { return s.id == id; };
+    next->all.erase(std::remove_if(next->all.begin(), next->all.end(), matches), next->all.end());
+    for (auto& list : next->byCategory) {
+        list.erase(std::remove_if(list.begin(), list.end(), matches), list.end());
+    }
+    std::atomic_store(&subscribers_, std::shared_ptr<const Subscribers>(std::move(next)));
+}
+
+void Bus::dispatch(const BusMessage& msg) const {
+    auto subs = snapshot();
+    for (const auto& s : subs->all) {
+        if (s.handler) s.handler(msg);
+    }
+    auto id = msg.category.id();
+    if (id < subs->byCategory.size()) {
+        for (const auto& s : subs->byCategory[id]) {
+            if (s.handler) s.handler(msg);
+        }
+    }
 }
 
 void Bus::post(const BusMessage& msg) {
-    for (auto& [id, h] : handlers_) {
-        (void)id;
-        if (h) h(msg);
+    dispatch(msg);
+}
+
+bool Bus::postAsync(BusMessage msg) {
+    ensureDispatcher();
+    if (!queue_.tryPush(std::move(msg))) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    enqueued_.fetch_add(1);  // 与 idle_ 的读写均为 seq_cst，保证与分发线程的休眠检查不会同时错过
+    // 分发线程忙时不加锁；仅在其准备休眠时唤醒
+    if (idle_.load()) {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        wakeCv_.notify_one();
     }
+    return true;
 }
 
-} // namespace falconmind::sdk::core
+bool Bus::flush(std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (dispatched_.load(std::memory_order_acquire) < enqueued_.load(std::memory_order_acquire)) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return true;
+}
 
+void Bus::ensureDispatcher() {
+    std::call_once(dispatcherOnce_, [this]() {
+        dispatcher_ = std::thread(&Bus::dispatchLoop, this);
+    });
+}
+
+void Bus::dispatchLoop() {
+    BusMessage msg;
+    for (;;) {
+        while (queue_.tryPop(msg)) {
+            dispatch(msg);
+            msg = BusMessage{};
+            dispatched_.fetch_add(1, std::memory_order_release);
+        }
+        if (stopping_) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        idle_.store(true);
+        // 设置 idle_ 后复查一次，避免与生产者的入队交错丢失唤醒
+        if (dispatched_.load() >= enqueued_.load()) {
+            wakeCv_.wait_for(lock, std::chrono::milliseconds(50), [this]() {
+                return stopping_.load() ||
+                       dispatched_.load(std::memory_order_acquire) < enqueued_.load(std::memory_order_acquire);
+            });
+        }
+        idle_.store(false, std::memory_order_relaxed);
+    }
+}
+
+} // namespace falconmind::sdk::core
@@ -1,10 +1,99 @@
 #include "falconmind/sdk/core/Caps.h"
 
+#include <algorithm>
+#include <cctype>
+
 namespace falconmind::sdk::core {
 
+PixelFormat parsePixelFormat(const std::string& name) {
+    std::string upper(name);
+    std::transform(upper.begin(), upper.end(), upper.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    if (upper == "RGB8" || upper == "RGB24" || upper == "RGB") return PixelFormat::RGB8;
+    if (upper == "BGR8" || upper == "BGR24" || upper == "BGR") return PixelFormat::BGR8;
+    if (upper == "NV12") return PixelFormat::NV12;
+    if (upper == "YUYV" || upper == "YUY2") return PixelFormat::YUYV;
+    return PixelFormat::Any;
+}
+
+const char* pixelFormatName(PixelFormat format) noexcept {
+    switch (format) {
+        case PixelFormat::RGB8: return "RGB8";
+        case PixelFormat::BGR8: return "BGR8";
+        case PixelFormat::NV12: return "NV12";
+        case PixelFormat::YUYV: return "YUYV";
+        case PixelFormat::Any: break;
+    }
+    return "ANY";
+}
+
+std::int32_t pixelFormatMinStride(PixelFormat format, std::int32_t width) noexcept {
+    switch (format) {
+        case PixelFormat::RGB8:
+        case PixelFormat::BGR8: return width * 3;
+        case PixelFormat::YUYV: return width * 2;
+        case PixelFormat::NV12: return width;
+        case PixelFormat::Any: break;
+    }
+    return 0;
+}
+
+std::size_t pixelFormatFrameBytes(PixelFormat format, std::int32_t width, std::int32_t height) noexcept {
+    if (width <= 0 || height <= 0) return 0;
+    auto stride = static_cast<std::size_t>(pixelFormatMinStride(format, width));
+    auto rows = static_cast<std::size_t>(height);
+    if (format == PixelFormat::NV12) {
+        return stride * rows + stride * ((rows + 1) / 2);  // Y 平面 + 交织 UV 平面
+    }
+    return stride * rows;
+}
+
+namespace {
+bool fieldMatches(std::int32_t a, std::int32_t b) noexcept {
+    return a == 0 || b == 0 || a == b;
+}
+} // namespace
+
+bool VideoCaps::intersects(const VideoCaps& other) const noexcept {
+    bool formatOk = format == PixelFormat::Any || other.format == PixelFormat::Any || format == other.format;
+    return formatOk && fieldMatches(width, other.width) && fieldMatches(height, other.height) &&
+           fieldMatches(fps, other.fps);
+}
+
+VideoCaps VideoCaps::intersect(const VideoCaps& other) const noexcept {
+    VideoCaps out;
+    out.format = format != PixelFormat::Any ? format : other.format;
+    out.width = width != 0 ? width : other.width;
+    out.height = height != 0 ? height : other.height;
+    out.fps = fps != 0 ? fps : other.fps;
+    return out;
+}
+
 void Caps::set(const std::string& key, const std::string& value) {
     props_[key] = value;
 }
 
-} // namespace falconmind::sdk::core
+bool negotiateVideoCaps(const Caps& upstream, const Caps& downstream, VideoCaps& out) {
+    if (!upstream.hasVideo() && !downstream.hasVideo()) {
+        return false;
+    }
+    if (!upstream.hasVideo()) {
+        out = downstream.video().front();
+        return true;
+    }
+    if (!downstream.hasVideo()) {
+        out = upstream.video().front();
+        return true;
+    }
+    for (const auto& want : downstream.video()) {
+        for (const auto& offer : upstream.video()) {
+            if (offer.intersects(want)) {
+                out = offer.intersect(want);
+                return true;
+            }
+        }
+    }
+    return false;
+}
 
+} // namespace falconmind::sdk::core
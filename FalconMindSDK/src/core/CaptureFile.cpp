@@ -0,0 +1,435 @@
+#include "falconmind/sdk/core/CaptureFile.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+constexpr char kFileMagic[4] = {'F', 'M', 'C', 'P'};
+constexpr char kIndexMagic[4] = {'F', 'M', 'C', 'I'};
+constexpr std::uint32_t kRecordMagic = 0x52434D46;  // "FMCR"
+constexpr std::uint32_t kCaptureVersion = 1;
+constexpr std::size_t kAlign = 8;
+
+struct FileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t reserved;
+};
+
+struct RecordHeader {
+    std::uint32_t magic;
+    std::uint32_t format;
+    std::uint64_t size;
+    std::int64_t timestampNs;
+    std::uint64_t frameIndex;
+    std::int32_t width;
+    std::int32_t height;
+    std::int32_t fps;
+    std::int32_t reserved;
+};
+
+struct Footer {
+    std::uint64_t indexOffset;
+    std::uint64_t count;
+    char magic[4];
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) % kAlign == 0, "capture header must keep records aligned");
+static_assert(sizeof(RecordHeader) % kAlign == 0, "capture record header must keep payload aligned");
+
+std::size_t padding(std::size_t size) {
+    return (kAlign - size % kAlign) % kAlign;
+}
+
+bool writeAll(int fd, const struct iovec* iov, int count, std::size_t total) {
+    ssize_t n = ::writev(fd, iov, count);
+    return n >= 0 && static_cast<std::size_t>(n) == total;
+}
+
+} // namespace
+
+CaptureWriter::CaptureWriter(std::string path, int fd)
+    : path_(std::move(path)), fd_(fd), offset_(sizeof(FileHeader)) {}
+
+CaptureWriter::~CaptureWriter() {
+    close();
+}
+
+std::unique_ptr<CaptureWriter> CaptureWriter::create(const std::string& path) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "[CaptureWriter] open " << path << " failed: " << std::strerror(errno) << std::endl;
+        return nullptr;
+    }
+    FileHeader header{};
+    std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.version = kCaptureVersion;
+    if (::write(fd, &header, sizeof(header)) != static_cast<ssize_t>(sizeof(header))) {
+        std::cerr << "[CaptureWriter] write header to " << path << " failed" << std::endl;
+        ::close(fd);
+        return nullptr;
+    }
+    return std::unique_ptr<CaptureWriter>(new CaptureWriter(path, fd));
+}
+
+bool CaptureWriter::append(const void* data, std::size_t size, const BufferMeta& meta) {
+    if (!data && size > 0) {
+        return false;
+    }
+    RecordHeader header{};
+    header.magic = kRecordMagic;
+    header.format = static_cast<std::uint32_t>(meta.video.format);
+    header.size = size;
+    header.timestampNs = meta.timestampNs;
+    header.frameIndex = meta.frameIndex;
+    header.width = meta.video.width;
+    header.height = meta.video.height;
+    header.fps = meta.video.fps;
+    static const std::uint8_t zeros[kAlign] = {};
+    std::size_t pad = padding(size);
+
+    struct iovec iov[3];
+    iov[0] = {&header, sizeof(header)};
+    iov[1] = {const_cast<void*>(data), size};
+    iov[2] = {const_cast<std::uint8_t*>(zeros), pad};
+    std::size_t total = sizeof(header) + size + pad;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) {
+        return false;
+    }
+    if (!writeAll(fd_, iov, 3, total)) {
+        std::cerr << "[CaptureWriter] write to " << path_ << " failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    index_.push_back(offset_);
+    offset_ += total;
+    records_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
+
+bool CaptureWriter::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) {
+        return true;
+    }
+    Footer footer{};
+    footer.indexOffset = offset_;
+    footer.count = index_.size();
+    std::memcpy(footer.magic, kIndexMagic, sizeof(kIndexMagic));
+    struct iovec iov[2];
+    iov[0] = {index_.data(), index_.size() * sizeof(std::uint64_t)};
+    iov[1] = {&footer, sizeof(footer)};
+    bool ok = writeAll(fd_, iov, 2, iov[0].iov_len + sizeof(footer));
+    if (!ok) {
+        std::cerr << "[CaptureWriter] write index to " << path_ << " failed" << std::endl;
+    }
+    ::close(fd_);
+    fd_ = -1;
+    return ok;
+}
+
+CaptureReader::~CaptureReader() {
+    if (base_) {
+        ::munmap(base_, length_);
+    }
+}
+
+bool CaptureReader::isCaptureFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    char magic[4] = {};
+    bool ok = ::read(fd, magic, sizeof(magic)) == static_cast<ssize_t>(sizeof(magic)) &&
+              std::memcmp(magic, kFileMagic, sizeof(kFileMagic)) == 0;
+    ::close(fd);
+    return ok;
+}
+
+std::shared_ptr<CaptureReader> CaptureReader::open(const std::string& path) {
+    std::shared_ptr<CaptureReader> reader(new CaptureReader());
+    reader->path_ = path;
+    if (!reader->load()) {
+        return nullptr;
+    }
+    return reader;
+}
+
+bool CaptureReader::load() {
+    int fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(FileHeader)) {
+        ::close(fd);
+        return false;
+    }
+    length_ = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        std::cerr << "[CaptureReader] mmap " << path_ << " failed: " << std::strerror(errno) << std::endl;
+        length_ = 0;
+        return false;
+    }
+    base_ = static_cast<std::uint8_t*>(p);
+    FileHeader header{};
+    std::memcpy(&header, base_, sizeof(header));
+    if (std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0 || header.version != kCaptureVersion) {
+        std::cerr << "[CaptureReader] " << path_ << " is not a capture file" << std::endl;
+        return false;
+    }
+    // 顺序读取为主：提示内核预读
+    ::madvise(base_, length_, MADV_SEQUENTIAL);
+    if (!loadIndex()) {
+        scan();
+    }
+    return true;
+}
+
+bool CaptureReader::loadIndex() {
+    if (length_ < sizeof(FileHeader) + sizeof(Footer)) {
+        return false;
+    }
+    Footer footer{};
+    std::memcpy(&footer, base_ + length_ - sizeof(Footer), sizeof(Footer));
+    if (std::memcmp(footer.magic, kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+        footer.count > (length_ - sizeof(Footer)) / sizeof(std::uint64_t) ||
+        footer.indexOffset + footer.count * sizeof(std::uint64_t) + sizeof(Footer) != length_) {
+        return false;
+    }
+    const auto* offsets = reinterpret_cast<const std::uint64_t*>(base_ + footer.indexOffset);
+    std::vector<CaptureRecord> records;
+    records.reserve(footer.count);
+    for (std::uint64_t i = 0; i < footer.count; ++i) {
+        std::uint64_t off = offsets[i];
+        if (off < sizeof(FileHeader) || off + sizeof(RecordHeader) > footer.indexOffset) {
+            return false;
+        }
+        const auto* rh = reinterpret_cast<const RecordHeader*>(base_ + off);
+        if (rh->magic != kRecordMagic || rh->size > footer.indexOffset - off - sizeof(RecordHeader)) {
+            return false;
+        }
+        CaptureRecord rec;
+        rec.data = base_ + off + sizeof(RecordHeader);
+        rec.size = static_cast<std::size_t>(rh->size);
+        rec.meta.timestampNs = rh->timestampNs;
+        rec.meta.frameIndex = rh->frameIndex;
+        rec.meta.video = VideoCaps{static_cast<PixelFormat>(rh->format), rh->width, rh->height, rh->fps};
+        records.push_back(rec);
+    }
+    records_ = std::move(records);
+    indexed_ = true;
+    return true;
+}
+
+void CaptureReader::scan() {
+    records_.clear();
+    std::size_t off = sizeof(FileHeader);
+    while (off + sizeof(RecordHeader) <= length_) {
+        const auto* rh = reinterpret_cast<const RecordHeader*>(base_ + off);
+        if (rh->magic != kRecordMagic || rh->size > length_ - off - sizeof(RecordHeader)) {
+            break;  // 索引区或写了一半的记录
+        }
+        CaptureRecord rec;
+        rec.data = base_ + off + sizeof(RecordHeader);
+        rec.size = static_cast<std::size_t>(rh->size);
+        rec.meta.timestampNs = rh->timestampNs;
+        rec.meta.frameIndex = rh->frameIndex;
+        rec.meta.video = VideoCaps{static_cast<PixelFormat>(rh->format), rh->width, rh->height, rh->fps};
+        records_.push_back(rec);
+        off += sizeof(RecordHeader) + rec.size + padding(rec.size);
+    }
+    std::cerr << "[CaptureReader] " << path_ << " has no index, recovered " << records_.size()
+              << " record(s) by scanning" << std::endl;
+}
+
+BufferRef CaptureReader::buffer(std::size_t index) const {
+    if (index >= records_.size()) {
+        return BufferRef();
+    }
+    const auto& rec = records_[index];
+    // 映射为只读：下游 mutableData() 先复制；缓冲持有 reader，映射在最后一个引用释放后才解除
+    auto self = std::const_pointer_cast<CaptureReader>(shared_from_this());
+    BufferRef buffer = BufferRef::wrapReadOnly(rec.data, rec.size, std::static_pointer_cast<void>(self));
+    buffer.mutableMeta() = rec.meta;
+    return buffer;
+}
+
+CaptureRecorderNode::CaptureRecorderNode(std::string path)
+    : Node("capture_recorder")
+    , path_(std::move(path)) {
+    auto* in = addPad(std::make_shared<Pad>("in", PadType::Sink));
+    in->setBufferCallback([this](const BufferRef& buffer) {
+        if (auto writer = std::atomic_load(&writer_)) {
+            writer->append(buffer);
+        }
+    });
+}
+
+bool CaptureRecorderNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    auto it = params.find("path");
+    if (it != params.end()) path_ = it->second;
+    return true;
+}
+
+bool CaptureRecorderNode::start() {
+    if (path_.empty()) {
+        std::cerr << "[CaptureRecorderNode] No path configured for " << id() << std::endl;
+        return false;
+    }
+    std::shared_ptr<CaptureWriter> writer = CaptureWriter::create(path_);
+    if (!writer) {
+        return false;
+    }
+    std::atomic_store(&writer_, std::move(writer));
+    std::cout << "[CaptureRecorderNode] recording to " << path_ << std::endl;
+    return true;
+}
+
+void CaptureRecorderNode::stop() {
+    auto writer = std::atomic_exchange(&writer_, std::shared_ptr<CaptureWriter>());
+    if (writer) {
+        writer->close();
+        lastRecorded_.store(writer->records(), std::memory_order_relaxed);
+        std::cout << "[CaptureRecorderNode] " << path_ << ": " << writer->records() << " record(s), "
+                  << writer->bytes() << " bytes" << std::endl;
+    }
+}
+
+std::uint64_t CaptureRecorderNode::recorded() const noexcept {
+    auto writer = std::atomic_load(&writer_);
+    return writer ? writer->records() : lastRecorded_.load(std::memory_order_relaxed);
+}
+
+ReplaySourceNode::ReplaySourceNode(std::string path)
+    : Node("replay_source")
+    , path_(std::move(path)) {
+    outPad_ = addPad(std::make_shared<Pad>("out", PadType::Source));
+}
+
+bool ReplaySourceNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    try {
+        auto it = params.find("path");
+        if (it != params.end()) path_ = it->second;
+        it = params.find("speed");
+        if (it != params.end()) {
+            if (it->second == "original") {
+                speed_ = 1.0;
+            } else if (it->second == "max") {
+                speed_ = 0.0;
+            } else {
+                speed_ = std::stod(it->second);
+                if (speed_ < 0.0) throw std::invalid_argument("speed");
+            }
+        }
+        it = params.find("loop");
+        if (it != params.end()) loop_ = it->second == "true" || it->second == "1";
+        it = params.find("batch");
+        if (it != params.end()) batch_ = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(std::stoul(it->second)));
+    } catch (const std::exception&) {
+        std::cerr << "[ReplaySourceNode] Invalid parameters for " << id() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ReplaySourceNode::start() {
+    reader_ = CaptureReader::open(path_);
+    if (!reader_) {
+        std::cerr << "[ReplaySourceNode] Failed to open capture file " << path_ << std::endl;
+        return false;
+    }
+    next_ = 0;
+    frameIndex_ = 0;
+    replayed_.store(0, std::memory_order_relaxed);
+    finished_.store(reader_->empty(), std::memory_order_relaxed);
+    restartClock(PipelineClock::nowNs());
+    started_ = true;
+    std::cout << "[ReplaySourceNode] replaying " << reader_->size() << " record(s) from " << path_
+              << (speed_ > 0.0 ? "" : " at max speed") << std::endl;
+    return true;
+}
+
+void ReplaySourceNode::stop() {
+    started_ = false;
+    reader_.reset();
+}
+
+void ReplaySourceNode::pause() {
+    pausedAtNs_ = PipelineClock::nowNs();
+}
+
+void ReplaySourceNode::resume() {
+    // 暂停时长不计入回放时钟，避免恢复后一次推送一大批
+    if (pausedAtNs_ != 0) {
+        replayStartNs_ += PipelineClock::nowNs() - pausedAtNs_;
+        pausedAtNs_ = 0;
+    }
+}
+
+void ReplaySourceNode::restartClock(std::int64_t nowNs) {
+    replayStartNs_ = nowNs;
+    recordStartNs_ = reader_ && next_ < reader_->size() ? reader_->record(next_).meta.timestampNs : 0;
+}
+
+std::int64_t ReplaySourceNode::nextDueNs() const {
+    if (!started_ || !reader_ || pausedAtNs_ != 0 || finished_.load(std::memory_order_relaxed) ||
+        next_ >= reader_->size()) {
+        return kNever;
+    }
+    if (speed_ <= 0.0) return 0;
+    return replayStartNs_ +
+           static_cast<std::int64_t>(static_cast<double>(reader_->record(next_).meta.timestampNs - recordStartNs_) / speed_);
+}
+
+void ReplaySourceNode::process() {
+    if (!started_ || !reader_ || finished_.load(std::memory_order_relaxed)) return;
+
+    std::int64_t now = PipelineClock::nowNs();
+    std::uint32_t pushed = 0;
+    while (next_ < reader_->size()) {
+        const auto& rec = reader_->record(next_);
+        std::int64_t due = now;
+        if (speed_ > 0.0) {
+            due = replayStartNs_ + static_cast<std::int64_t>(static_cast<double>(rec.meta.timestampNs - recordStartNs_) / speed_);
+            if (due > now) break;
+        } else if (pushed >= batch_) {
+            break;
+        }
+        BufferRef buffer = reader_->buffer(next_);
+        auto& meta = buffer.mutableMeta();
+        meta.timestampNs = due;  // 以回放时刻作为采集时刻
+        meta.frameIndex = frameIndex_++;
+        outPad_->pushBuffer(buffer);
+        replayed_.fetch_add(1, std::memory_order_relaxed);
+        ++pushed;
+        if (++next_ == reader_->size()) {
+            if (!loop_) {
+                finished_.store(true, std::memory_order_relaxed);
+                break;
+            }
+            next_ = 0;
+            restartClock(now);
+            if (speed_ > 0.0) break;  // 新一轮从下一次 process() 开始计时
+        }
+    }
+}
+
+} // namespace falconmind::sdk::core
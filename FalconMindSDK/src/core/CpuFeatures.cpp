@@ -0,0 +1,138 @@
+#include "falconmind/sdk/core/CpuFeatures.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <utility>
+
+#if defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_ASIMD
+#define HWCAP_ASIMD (1UL << 1)
+#endif
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1UL << 22)
+#endif
+#endif
+
+namespace falconmind::sdk::core {
+
+const char* cpuIsaName(CpuIsa isa) noexcept {
+    switch (isa) {
+        case CpuIsa::Scalar: return "scalar";
+        case CpuIsa::Sse41: return "sse4.1";
+        case CpuIsa::Avx2: return "avx2";
+        case CpuIsa::Avx512: return "avx512";
+        case CpuIsa::Neon: return "neon";
+        case CpuIsa::Sve: return "sve";
+    }
+    return "unknown";
+}
+
+bool parseCpuIsa(const std::string& name, CpuIsa& out) {
+    std::string s(name);
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (CpuIsa isa : {CpuIsa::Scalar, CpuIsa::Sse41, CpuIsa::Avx2, CpuIsa::Avx512, CpuIsa::Neon, CpuIsa::Sve}) {
+        if (s == cpuIsaName(isa)) {
+            out = isa;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CpuFeatures::supports(CpuIsa isa) const noexcept {
+    switch (isa) {
+        case CpuIsa::Scalar: return true;
+        case CpuIsa::Sse41: return sse41;
+        case CpuIsa::Avx2: return avx2 && fma && f16c;
+        case CpuIsa::Avx512: return supports(CpuIsa::Avx2) && avx512f && avx512bw && avx512vl;
+        case CpuIsa::Neon: return neon;
+        case CpuIsa::Sve: return neon && sve;
+    }
+    return false;
+}
+
+CpuIsa CpuFeatures::best() const noexcept {
+    for (CpuIsa isa : {CpuIsa::Sve, CpuIsa::Neon, CpuIsa::Avx512, CpuIsa::Avx2, CpuIsa::Sse41}) {
+        if (supports(isa)) return isa;
+    }
+    return CpuIsa::Scalar;
+}
+
+CpuFeatures detectCpuFeatures() noexcept {
+    CpuFeatures f;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    f.sse41 = __builtin_cpu_supports("sse4.1");
+    f.avx = __builtin_cpu_supports("avx");
+    f.avx2 = __builtin_cpu_supports("avx2");
+    f.fma = __builtin_cpu_supports("fma");
+    f.avx512f = __builtin_cpu_supports("avx512f");
+    f.avx512bw = __builtin_cpu_supports("avx512bw");
+    f.avx512vl = __builtin_cpu_supports("avx512vl");
+    f.f16c = __builtin_cpu_supports("f16c");
+#elif defined(__aarch64__)
+#if defined(__linux__)
+    const unsigned long hwcap = getauxval(AT_HWCAP);
+    f.neon = (hwcap & HWCAP_ASIMD) != 0;
+    f.sve = (hwcap & HWCAP_SVE) != 0;
+#else
+    f.neon = true;
+#endif
+#endif
+    return f;
+}
+
+namespace {
+
+// 只保留不高于 cap 级别的扩展
+CpuFeatures capFeatures(CpuFeatures f, CpuIsa cap) {
+    const bool x86Cap = cap == CpuIsa::Scalar || cap == CpuIsa::Sse41 || cap == CpuIsa::Avx2 || cap == CpuIsa::Avx512;
+    const bool armCap = cap == CpuIsa::Scalar || cap == CpuIsa::Neon || cap == CpuIsa::Sve;
+    if (x86Cap) {
+        if (cap < CpuIsa::Avx512) f.avx512f = f.avx512bw = f.avx512vl = false;
+        if (cap < CpuIsa::Avx2) f.avx = f.avx2 = f.fma = f.f16c = false;
+        if (cap < CpuIsa::Sse41) f.sse41 = false;
+    }
+    if (armCap) {
+        if (cap != CpuIsa::Sve) f.sve = false;
+        if (cap == CpuIsa::Scalar) f.neon = false;
+    }
+    return f;
+}
+
+CpuFeatures resolveFeatures() {
+    CpuFeatures f = detectCpuFeatures();
+    if (const char* env = std::getenv("FALCONMIND_CPU_ISA")) {
+        CpuIsa cap{};
+        if (parseCpuIsa(env, cap)) f = capFeatures(f, cap);
+    }
+    return f;
+}
+
+} // namespace
+
+const CpuFeatures& cpuFeatures() noexcept {
+    static const CpuFeatures features = resolveFeatures();
+    return features;
+}
+
+std::string cpuFeatureSummary() {
+    const CpuFeatures& f = cpuFeatures();
+    std::string out = cpuIsaName(f.best());
+    std::string list;
+    const std::pair<bool, const char*> flags[] = {
+        {f.sse41, "sse4.1"}, {f.avx, "avx"},           {f.avx2, "avx2"},         {f.fma, "fma"},
+        {f.f16c, "f16c"},    {f.avx512f, "avx512f"},   {f.avx512bw, "avx512bw"}, {f.avx512vl, "avx512vl"},
+        {f.neon, "neon"},    {f.sve, "sve"}};
+    for (const auto& [on, name] : flags) {
+        if (!on) continue;
+        list += list.empty() ? "" : " ";
+        list += name;
+    }
+    if (!list.empty()) out += " (" + list + ")";
+    return out;
+}
+
+} // namespace falconmind::sdk::core
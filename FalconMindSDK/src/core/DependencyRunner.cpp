@@ -0,0 +1,93 @@
+#include "falconmind/sdk/core/DependencyRunner.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace falconmind::sdk::core {
+
+std::vector<DependencyTaskState> runWithDependencies(
+    std::size_t count,
+    const std::vector<std::vector<std::size_t>>& prerequisites,
+    std::size_t maxThreads,
+    const std::function<bool(std::size_t)>& task) {
+    std::vector<DependencyTaskState> states(count, DependencyTaskState::NotRun);
+    if (count == 0) {
+        return states;
+    }
+
+    std::vector<std::size_t> remaining(count, 0);
+    std::vector<std::vector<std::size_t>> dependents(count);
+    for (std::size_t i = 0; i < count && i < prerequisites.size(); ++i) {
+        for (std::size_t pre : prerequisites[i]) {
+            if (pre >= count || pre == i) continue;
+            ++remaining[i];
+            dependents[pre].push_back(i);
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::size_t> ready;
+    std::size_t inflight = 0;
+    bool failed = false;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (remaining[i] == 0) ready.push_back(i);
+    }
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            cv.wait(lock, [&]() { return (!failed && !ready.empty()) || inflight == 0; });
+            if (failed || ready.empty()) {
+                // 无任务在执行且没有可执行任务：全部完成，或剩余任务因失败不再执行
+                cv.notify_all();
+                return;
+            }
+            std::size_t index = ready.front();
+            ready.pop_front();
+            ++inflight;
+            lock.unlock();
+
+            bool ok = false;
+            try {
+                ok = task(index);
+            } catch (const std::exception&) {
+                ok = false;
+            } catch (...) {
+                ok = false;
+            }
+
+            lock.lock();
+            --inflight;
+            states[index] = ok ? DependencyTaskState::Succeeded : DependencyTaskState::Failed;
+            if (ok) {
+                for (std::size_t d : dependents[index]) {
+                    if (--remaining[d] == 0) ready.push_back(d);
+                }
+            } else {
+                failed = true;
+            }
+            cv.notify_all();
+        }
+    };
+
+    // 启动/构造多为 I/O 等待（打开设备、加载模型），默认不按 CPU 核数限制
+    std::size_t threads = maxThreads == 0 ? count : std::min(maxThreads, count);
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();  // 调用线程也参与执行
+    for (auto& t : pool) {
+        t.join();
+    }
+    return states;
+}
+
+} // namespace falconmind::sdk::core
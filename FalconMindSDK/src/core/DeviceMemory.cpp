@@ -0,0 +1,89 @@
+#include "falconmind/sdk/core/DeviceMemory.h"
+#include "falconmind/sdk/core/Log.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <linux/dma-buf.h>
+#include <linux/dma-heap.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace falconmind::sdk::core {
+
+const char* memoryDomainName(MemoryDomain domain) noexcept {
+    switch (domain) {
+        case MemoryDomain::Host: return "host";
+        case MemoryDomain::DmaBuf: return "dmabuf";
+        case MemoryDomain::Cuda: return "cuda";
+        case MemoryDomain::Npu: return "npu";
+    }
+    return "unknown";
+}
+
+DmaBufMemory::DmaBufMemory(int fd, std::size_t size, bool ownsFd) : fd_(fd), size_(size), ownsFd_(ownsFd) {}
+
+DmaBufMemory::~DmaBufMemory() {
+    if (mapped_) {
+        // 非 dma-buf 的 fd（如测试中的 memfd）不支持同步 ioctl，忽略错误
+        dma_buf_sync sync{};
+        sync.flags = DMA_BUF_SYNC_END | (syncWrite_ ? DMA_BUF_SYNC_RW : DMA_BUF_SYNC_READ);
+        (void)::ioctl(fd_, DMA_BUF_IOCTL_SYNC, &sync);
+        ::munmap(mapped_, size_);
+    }
+    if (ownsFd_ && fd_ >= 0) ::close(fd_);
+}
+
+std::shared_ptr<DmaBufMemory> DmaBufMemory::allocate(std::size_t size, const char* heap) {
+    const int heapFd = ::open(heap, O_RDONLY | O_CLOEXEC);
+    if (heapFd < 0) return nullptr;
+    dma_heap_allocation_data alloc{};
+    alloc.len = size;
+    alloc.fd_flags = O_RDWR | O_CLOEXEC;
+    const int rc = ::ioctl(heapFd, DMA_HEAP_IOCTL_ALLOC, &alloc);
+    const int err = errno;
+    ::close(heapFd);
+    if (rc < 0) {
+        FM_LOG_WARN("DmaBufMemory", "DMA heap allocation of ", size, " bytes from ", heap, " failed: ",
+                    std::strerror(err));
+        return nullptr;
+    }
+    return std::make_shared<DmaBufMemory>(static_cast<int>(alloc.fd), size, true);
+}
+
+std::uint8_t* DmaBufMemory::map(bool write) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // 已发出的只读映射可能仍被缓冲的 host 视图引用，不重新映射
+    if (mapped_) return write && !syncWrite_ ? nullptr : mapped_;
+    if (fd_ < 0 || size_ == 0) return nullptr;
+    void* p = ::mmap(nullptr, size_, write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        FM_LOG_WARN("DmaBufMemory", "mmap of dma-buf fd ", fd_, " failed: ", std::strerror(errno));
+        return nullptr;
+    }
+    dma_buf_sync sync{};
+    sync.flags = DMA_BUF_SYNC_START | (write ? DMA_BUF_SYNC_RW : DMA_BUF_SYNC_READ);
+    (void)::ioctl(fd_, DMA_BUF_IOCTL_SYNC, &sync);
+    mapped_ = static_cast<std::uint8_t*>(p);
+    syncWrite_ = write;
+    return mapped_;
+}
+
+const std::uint8_t* DmaBufMemory::mapHost() {
+    return map(false);
+}
+
+std::uint8_t* DmaBufMemory::mapWritable() {
+    return map(true);
+}
+
+bool DmaBufMemory::download(std::uint8_t* dst) {
+    const std::uint8_t* src = mapHost();
+    if (!src || !dst) return false;
+    std::memcpy(dst, src, size_);
+    return true;
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,521 @@
+#include "falconmind/sdk/core/FlightLog.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+constexpr char kLogMagic[4] = {'F', 'M', 'F', 'L'};
+constexpr char kIndexMagic[4] = {'F', 'M', 'L', 'I'};
+constexpr std::uint32_t kLogVersion = 1;
+constexpr std::size_t kHeaderBytes = 4096;   // 文件头独占一页，数据区按页对齐
+constexpr std::size_t kAlign = 16;           // 记录对齐：环尾剩余空间总能放下一个 Padding 记录头
+constexpr std::size_t kMinCapacity = 64u << 10;
+
+struct RecordHeader {
+    std::uint16_t type;
+    std::uint16_t thread;
+    std::uint32_t size;
+    std::int64_t timestampNs;
+};
+static_assert(sizeof(RecordHeader) == FlightLogRecorder::kRecordHeaderBytes, "record header layout");
+
+struct IndexHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t count;
+};
+
+constexpr std::size_t alignUp(std::size_t n, std::size_t a) noexcept { return (n + a - 1) / a * a; }
+constexpr std::size_t recordBytes(std::size_t payload) noexcept { return alignUp(sizeof(RecordHeader) + payload, kAlign); }
+
+std::size_t roundUpPow2(std::size_t n) noexcept {
+    std::size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+inline void putHeader(std::uint8_t* dst, std::uint16_t type, std::uint16_t thread, std::uint32_t size,
+                      std::int64_t ts) noexcept {
+    const RecordHeader h{type, thread, size, ts};
+    std::memcpy(dst, &h, sizeof(h));
+}
+
+std::atomic<std::uint64_t> gRecorderGeneration{0};
+
+// 线程最近使用的 recorder 与其暂存区
+struct ThreadCache {
+    std::uint64_t generation{0};
+    void* staging{nullptr};
+};
+thread_local ThreadCache tlsCache;
+
+} // namespace
+
+// 映射在文件开头；head / tail / 计数为无锁原子，可放在共享映射中
+struct FlightLogFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t capacity;
+    std::uint64_t dataOffset;
+    std::int64_t createdWallNs;    // 系统时间，离线把 steady 时间戳换算为绝对时间
+    std::int64_t createdSteadyNs;
+    std::atomic<std::uint64_t> head;   // 逻辑写位置（单调递增，对 capacity 取模为数据区偏移）
+    std::atomic<std::uint64_t> tail;   // 最旧完整记录的逻辑位置
+    std::atomic<std::uint64_t> records;
+    std::atomic<std::uint64_t> overwritten;
+    std::atomic<std::uint32_t> clean;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(FlightLogFileHeader) <= kHeaderBytes, "file header must fit in the header page");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "file header atomics must be lock free");
+
+// 单生产者（记录线程）单消费者（写线程）字节环；记录不跨越环尾
+struct FlightLogRecorder::Staging {
+    Staging(std::size_t bytes, std::uint16_t idx) : storage(bytes / sizeof(std::uint64_t)), capacity(bytes), index(idx) {
+        buf = reinterpret_cast<std::uint8_t*>(storage.data());
+    }
+
+    std::vector<std::uint64_t> storage;  // 8 字节对齐
+    std::uint8_t* buf{nullptr};
+    std::size_t capacity;
+    std::uint16_t index;
+    std::thread::id owner;
+
+    alignas(64) std::atomic<std::uint64_t> head{0};  // 生产者发布
+    std::uint64_t cachedTail{0};                     // 生产者本地缓存的消费位置，减少跨核读取
+    alignas(64) std::atomic<std::uint64_t> tail{0};  // 消费者发布
+};
+
+const char* logRecordTypeName(LogRecordType type) noexcept {
+    switch (type) {
+        case LogRecordType::Padding: return "padding";
+        case LogRecordType::MavlinkRx: return "mavlink_rx";
+        case LogRecordType::MavlinkTx: return "mavlink_tx";
+        case LogRecordType::PipelineEvent: return "pipeline_event";
+        case LogRecordType::Detection: return "detection";
+        case LogRecordType::FlightState: return "flight_state";
+        case LogRecordType::Text: return "text";
+        default: return static_cast<std::uint16_t>(type) >= static_cast<std::uint16_t>(LogRecordType::User) ? "user"
+                                                                                                              : "unknown";
+    }
+}
+
+FlightLogRecorder::FlightLogRecorder(const FlightLogConfig& config) : config_(config) {
+    generation_ = gRecorderGeneration.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+FlightLogRecorder::~FlightLogRecorder() {
+    close();
+}
+
+std::unique_ptr<FlightLogRecorder> FlightLogRecorder::create(const FlightLogConfig& config) {
+    std::unique_ptr<FlightLogRecorder> recorder(new FlightLogRecorder(config));
+    if (!recorder->open()) {
+        return nullptr;
+    }
+    recorder->writer_ = std::thread([r = recorder.get()] { r->writerLoop(); });
+    return recorder;
+}
+
+bool FlightLogRecorder::open() {
+    const long page = ::sysconf(_SC_PAGESIZE);
+    capacity_ = alignUp(std::max(config_.fileBytes, kMinCapacity), page > 0 ? static_cast<std::size_t>(page) : 4096);
+    config_.stagingBytes = roundUpPow2(std::max<std::size_t>(config_.stagingBytes, 4096));
+    mapBytes_ = kHeaderBytes + capacity_;
+
+    fd_ = ::open(config_.path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        std::cerr << "[FlightLogRecorder] open " << config_.path << " failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    // 预分配：飞行中写满磁盘只会发生在创建时，而不是在映射页首次写入时（SIGBUS）
+    const int rc = ::posix_fallocate(fd_, 0, static_cast<off_t>(mapBytes_));
+    if (rc != 0 && ::ftruncate(fd_, static_cast<off_t>(mapBytes_)) != 0) {
+        std::cerr << "[FlightLogRecorder] preallocate " << mapBytes_ << " bytes failed: " << std::strerror(rc)
+                  << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    void* p = ::mmap(nullptr, mapBytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        std::cerr << "[FlightLogRecorder] mmap " << config_.path << " failed: " << std::strerror(errno) << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    map_ = static_cast<std::uint8_t*>(p);
+    ring_ = map_ + kHeaderBytes;
+
+    header_ = new (map_) FlightLogFileHeader{};
+    std::memcpy(header_->magic, kLogMagic, sizeof(kLogMagic));
+    header_->version = kLogVersion;
+    header_->capacity = capacity_;
+    header_->dataOffset = kHeaderBytes;
+    header_->createdWallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::system_clock::now().time_since_epoch())
+                                 .count();
+    header_->createdSteadyNs = PipelineClock::nowNs();
+    open_.store(true, std::memory_order_release);
+    return true;
+}
+
+FlightLogRecorder::Staging* FlightLogRecorder::registerThread() noexcept {
+    std::lock_guard<std::mutex> lock(registerMutex_);
+    if (!open_.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    const std::thread::id self = std::this_thread::get_id();
+    const std::size_t count = stagingCount_.load(std::memory_order_relaxed);
+    Staging* st = nullptr;
+    // 线程 ID 只在线程退出后才会复用，复用时接手已退出线程的暂存区（其中剩余记录会先被写线程取走）
+    for (std::size_t i = 0; i < count && !st; ++i) {
+        if (staging_[i]->owner == self) st = staging_[i].get();
+    }
+    if (!st) {
+        if (count == kMaxThreads) {
+            return nullptr;
+        }
+        try {
+            staging_[count] = std::make_unique<Staging>(config_.stagingBytes, static_cast<std::uint16_t>(count));
+        } catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+        st = staging_[count].get();
+        st->owner = self;
+        stagingCount_.store(count + 1, std::memory_order_release);
+    }
+    tlsCache.generation = generation_;
+    tlsCache.staging = st;
+    return st;
+}
+
+bool FlightLogRecorder::record(LogRecordType type, const void* data, std::size_t size) noexcept {
+    return record(type, data, size, PipelineClock::nowNs());
+}
+
+bool FlightLogRecorder::record(LogRecordType type, const void* data, std::size_t size,
+                               std::int64_t timestampNs) noexcept {
+    if (!open_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    Staging* st = tlsCache.generation == generation_ ? static_cast<Staging*>(tlsCache.staging) : registerThread();
+    const std::size_t total = recordBytes(size);
+    if (!st || total > st->capacity / 2) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::uint64_t h = st->head.load(std::memory_order_relaxed);
+    std::size_t pos = static_cast<std::size_t>(h & (st->capacity - 1));
+    const std::size_t contiguous = st->capacity - pos;
+    const std::size_t need = contiguous < total ? contiguous + total : total;
+    if (h + need - st->cachedTail > st->capacity) {
+        st->cachedTail = st->tail.load(std::memory_order_acquire);
+        if (h + need - st->cachedTail > st->capacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    if (contiguous < total) {
+        putHeader(st->buf + pos, static_cast<std::uint16_t>(LogRecordType::Padding), st->index,
+                  static_cast<std::uint32_t>(contiguous - sizeof(RecordHeader)), 0);
+        h += contiguous;
+        pos = 0;
+    }
+    putHeader(st->buf + pos, static_cast<std::uint16_t>(type), st->index, static_cast<std::uint32_t>(size),
+              timestampNs);
+    if (size > 0) {
+        std::memcpy(st->buf + pos + sizeof(RecordHeader), data, size);
+    }
+    st->head.store(h + total, std::memory_order_release);
+    return true;
+}
+
+void FlightLogRecorder::writeRecord(const std::uint8_t* header, const std::uint8_t* payload, std::size_t size) {
+    const std::size_t total = recordBytes(size);
+    if (total > capacity_ / 2) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::uint64_t head = header_->head.load(std::memory_order_relaxed);
+    std::uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+    std::size_t pos = static_cast<std::size_t>(head % capacity_);
+    const std::size_t contiguous = capacity_ - pos;
+    const std::size_t need = contiguous < total ? contiguous + total : total;
+
+    // 先越过将被覆盖的旧记录并发布 tail，再写入：任何时刻 [tail, head) 都是完整记录
+    if (head + need - tail > capacity_) {
+        std::uint64_t lost = 0;
+        while (head + need - tail > capacity_) {
+            RecordHeader old;
+            std::memcpy(&old, ring_ + tail % capacity_, sizeof(old));
+            tail += recordBytes(old.size);
+            if (old.type != static_cast<std::uint16_t>(LogRecordType::Padding)) ++lost;
+        }
+        header_->tail.store(tail, std::memory_order_release);
+        overwritten_.fetch_add(lost, std::memory_order_relaxed);
+        header_->overwritten.store(overwritten_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    if (contiguous < total) {
+        putHeader(ring_ + pos, static_cast<std::uint16_t>(LogRecordType::Padding), 0,
+                  static_cast<std::uint32_t>(contiguous - sizeof(RecordHeader)), 0);
+        head += contiguous;
+        pos = 0;
+    }
+    std::memcpy(ring_ + pos, header, sizeof(RecordHeader));
+    if (size > 0) {
+        std::memcpy(ring_ + pos + sizeof(RecordHeader), payload, size);
+    }
+    header_->head.store(head + total, std::memory_order_release);
+    records_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(size, std::memory_order_relaxed);
+}
+
+void FlightLogRecorder::drainAll() {
+    const std::size_t count = stagingCount_.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < count; ++i) {
+        Staging& st = *staging_[i];
+        std::uint64_t t = st.tail.load(std::memory_order_relaxed);
+        const std::uint64_t h = st.head.load(std::memory_order_acquire);
+        while (t < h) {
+            const std::uint8_t* rec = st.buf + (t & (st.capacity - 1));
+            RecordHeader rh;
+            std::memcpy(&rh, rec, sizeof(rh));
+            if (rh.type != static_cast<std::uint16_t>(LogRecordType::Padding)) {
+                writeRecord(rec, rec + sizeof(RecordHeader), rh.size);
+            }
+            t += recordBytes(rh.size);
+        }
+        st.tail.store(t, std::memory_order_release);
+    }
+    header_->records.store(records_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void FlightLogRecorder::writerLoop() {
+    const auto interval = std::chrono::milliseconds(std::max(1, config_.flushIntervalMs));
+    auto lastSync = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(writerMutex_);
+    for (;;) {
+        writerCv_.wait_for(lock, interval, [this] { return stopWriter_ || flushRequests_ != flushesDone_; });
+        const bool stop = stopWriter_;
+        const std::uint64_t requested = flushRequests_;
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> drain(drainMutex_);
+            drainAll();
+            const auto now = std::chrono::steady_clock::now();
+            if (config_.syncIntervalMs > 0 && now - lastSync >= std::chrono::milliseconds(config_.syncIntervalMs)) {
+                ::msync(map_, mapBytes_, MS_ASYNC);
+                lastSync = now;
+            }
+        }
+        lock.lock();
+        flushesDone_ = requested;
+        flushedCv_.notify_all();
+        if (stop) {
+            break;
+        }
+    }
+}
+
+void FlightLogRecorder::flush() {
+    std::unique_lock<std::mutex> lock(writerMutex_);
+    if (stopWriter_ || !writer_.joinable()) {
+        return;
+    }
+    const std::uint64_t ticket = ++flushRequests_;
+    writerCv_.notify_one();
+    flushedCv_.wait(lock, [&] { return flushesDone_ >= ticket || stopWriter_; });
+}
+
+void FlightLogRecorder::close() {
+    {
+        std::lock_guard<std::mutex> reg(registerMutex_);
+        open_.store(false, std::memory_order_release);
+    }
+    {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        stopWriter_ = true;
+    }
+    writerCv_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    std::lock_guard<std::mutex> drain(drainMutex_);
+    if (!map_) {
+        return;
+    }
+    drainAll();
+    header_->clean.store(1, std::memory_order_release);
+    if (::msync(map_, mapBytes_, MS_SYNC) != 0) {
+        std::cerr << "[FlightLogRecorder] msync " << config_.path << " failed: " << std::strerror(errno) << std::endl;
+    }
+    ::munmap(map_, mapBytes_);
+    ::close(fd_);
+    map_ = nullptr;
+    header_ = nullptr;
+    ring_ = nullptr;
+    fd_ = -1;
+}
+
+FlightLogStats FlightLogRecorder::stats() const noexcept {
+    FlightLogStats s;
+    s.records = records_.load(std::memory_order_relaxed);
+    s.bytes = bytes_.load(std::memory_order_relaxed);
+    s.dropped = dropped_.load(std::memory_order_relaxed);
+    s.overwritten = overwritten_.load(std::memory_order_relaxed);
+    s.threads = stagingCount_.load(std::memory_order_acquire);
+    return s;
+}
+
+FlightLogReader::~FlightLogReader() {
+    if (base_) {
+        ::munmap(base_, length_);
+    }
+}
+
+std::unique_ptr<FlightLogReader> FlightLogReader::open(const std::string& path) {
+    std::unique_ptr<FlightLogReader> reader(new FlightLogReader());
+    if (!reader->load(path)) {
+        return nullptr;
+    }
+    return reader;
+}
+
+bool FlightLogReader::load(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < kHeaderBytes) {
+        ::close(fd);
+        return false;
+    }
+    length_ = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        std::cerr << "[FlightLogReader] mmap " << path << " failed: " << std::strerror(errno) << std::endl;
+        length_ = 0;
+        return false;
+    }
+    base_ = static_cast<std::uint8_t*>(p);
+    const auto* header = reinterpret_cast<const FlightLogFileHeader*>(base_);
+    if (std::memcmp(header->magic, kLogMagic, sizeof(kLogMagic)) != 0 || header->version != kLogVersion ||
+        header->dataOffset < sizeof(FlightLogFileHeader) || header->capacity % kAlign != 0 ||
+        header->dataOffset + header->capacity > length_) {
+        std::cerr << "[FlightLogReader] " << path << " is not a flight log" << std::endl;
+        return false;
+    }
+    const std::uint64_t capacity = header->capacity;
+    const std::uint64_t head = header->head.load(std::memory_order_acquire);
+    std::uint64_t pos = header->tail.load(std::memory_order_acquire);
+    clean_ = header->clean.load(std::memory_order_relaxed) != 0;
+    overwritten_ = header->overwritten.load(std::memory_order_relaxed);
+    if (head < pos || head - pos > capacity) {
+        truncated_ = true;
+        return true;
+    }
+    const std::uint8_t* ring = base_ + header->dataOffset;
+    records_.reserve(static_cast<std::size_t>(header->records.load(std::memory_order_relaxed) -
+                                              std::min(header->records.load(std::memory_order_relaxed), overwritten_)));
+    while (pos < head) {
+        const std::size_t off = static_cast<std::size_t>(pos % capacity);
+        RecordHeader rh;
+        std::memcpy(&rh, ring + off, sizeof(rh));
+        const std::size_t total = recordBytes(rh.size);
+        if (off + total > capacity || pos + total > head) {
+            truncated_ = true;
+            break;
+        }
+        if (rh.type != static_cast<std::uint16_t>(LogRecordType::Padding)) {
+            LogRecordView view;
+            view.type = static_cast<LogRecordType>(rh.type);
+            view.thread = rh.thread;
+            view.timestampNs = rh.timestampNs;
+            view.fileOffset = header->dataOffset + off;
+            view.data = ring + off + sizeof(RecordHeader);
+            view.size = rh.size;
+            records_.push_back(view);
+        }
+        pos += total;
+    }
+    return true;
+}
+
+bool writeFlightLogIndex(const FlightLogReader& reader, const std::string& indexPath) {
+    std::vector<FlightLogIndexEntry> entries;
+    entries.reserve(reader.size());
+    for (const auto& r : reader.records()) {
+        entries.push_back({r.timestampNs, r.fileOffset, r.size, static_cast<std::uint16_t>(r.type), r.thread});
+    }
+    // 各线程的记录在文件中按搬运批次交错，索引按时间戳（同时间按文件位置）全局排序
+    std::stable_sort(entries.begin(), entries.end(), [](const FlightLogIndexEntry& a, const FlightLogIndexEntry& b) {
+        return a.timestampNs != b.timestampNs ? a.timestampNs < b.timestampNs : a.fileOffset < b.fileOffset;
+    });
+
+    const int fd = ::open(indexPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "[FlightLogIndex] open " << indexPath << " failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    IndexHeader header{};
+    std::memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+    header.version = kLogVersion;
+    header.count = entries.size();
+    const std::size_t bytes = entries.size() * sizeof(FlightLogIndexEntry);
+    const bool ok = ::write(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)) &&
+                    ::write(fd, entries.data(), bytes) == static_cast<ssize_t>(bytes);
+    ::close(fd);
+    if (!ok) {
+        std::cerr << "[FlightLogIndex] write " << indexPath << " failed" << std::endl;
+    }
+    return ok;
+}
+
+bool readFlightLogIndex(const std::string& indexPath, std::vector<FlightLogIndexEntry>& entries) {
+    const int fd = ::open(indexPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    IndexHeader header{};
+    bool ok = ::read(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)) &&
+              std::memcmp(header.magic, kIndexMagic, sizeof(kIndexMagic)) == 0 && header.version == kLogVersion;
+    struct stat st{};
+    ok = ok && ::fstat(fd, &st) == 0 &&
+         static_cast<std::uint64_t>(st.st_size) == sizeof(header) + header.count * sizeof(FlightLogIndexEntry);
+    if (ok) {
+        entries.resize(static_cast<std::size_t>(header.count));
+        const std::size_t bytes = entries.size() * sizeof(FlightLogIndexEntry);
+        ok = ::read(fd, entries.data(), bytes) == static_cast<ssize_t>(bytes);
+    }
+    ::close(fd);
+    return ok;
+}
+
+FlightLogNode::FlightLogNode(std::shared_ptr<FlightLogRecorder> recorder, LogRecordType type)
+    : Node("flight_log"), recorder_(std::move(recorder)), type_(type) {
+    addPad(std::make_shared<Pad>("in", PadType::Sink))->setDataCallback([this](const void* data, std::size_t size) {
+        if (recorder_ && recorder_->record(type_, data, size)) {
+            logged_.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+}
+
+} // namespace falconmind::sdk::core
@@ -1,11 +1,25 @@
 #include "falconmind/sdk/core/FlowExecutor.h"
+#include "falconmind/sdk/core/AcceleratorArbiter.h"
+#include "falconmind/sdk/core/BootProfiler.h"
+#include "falconmind/sdk/core/DependencyRunner.h"
+#include "falconmind/sdk/core/JsonCursor.h"
+#include "falconmind/sdk/core/PipelineClock.h"
 #include "falconmind/sdk/core/NodeFactory.h"
+#include "falconmind/sdk/core/NodeParams.h"
 #include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/SharedSource.h"
 #include "falconmind/sdk/mission/SearchPathPlannerNode.h"
 #include "falconmind/sdk/mission/SearchTypes.h"
+#include "falconmind/sdk/perception/ClassFilter.h"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <unordered_set>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // 使用cpp-httplib进行HTTP请求
 #ifdef CPPHTTPLIB_OPENSSL_SUPPORT
@@ -29,7 +43,72 @@ FlowExecutor::~FlowExecutor() {
     stop();
 }
 
+namespace {
+
+// 只读映射整个 Flow 文件（按需解析直接在映射上扫描，不经 iostream 拷贝）
+class MappedFlowFile {
+public:
+    explicit MappedFlowFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+        struct stat st{};
+        if (::fstat(fd, &st) == 0) {
+            opened_ = true;
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ > 0) {
+                void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) {
+                    opened_ = false;
+                    size_ = 0;
+                } else {
+                    data_ = p;
+                    ::madvise(p, size_, MADV_SEQUENTIAL);
+                }
+            }
+        }
+        ::close(fd);
+    }
+    ~MappedFlowFile() {
+        if (data_) ::munmap(data_, size_);
+    }
+    MappedFlowFile(const MappedFlowFile&) = delete;
+    MappedFlowFile& operator=(const MappedFlowFile&) = delete;
+
+    bool opened() const noexcept { return opened_; }
+    std::string_view view() const noexcept {
+        return data_ ? std::string_view(static_cast<const char*>(data_), size_) : std::string_view();
+    }
+
+private:
+    void* data_{nullptr};
+    std::size_t size_{0};
+    bool opened_{false};
+};
+
+// Flow 顶层 memory_budget_mb（MiB）→ 字节；负值忽略
+std::size_t memoryBudgetFromMb(double mb) {
+    if (mb < 0.0) {
+        std::cerr << "FlowExecutor: Ignoring negative memory_budget_mb" << std::endl;
+        return 0;
+    }
+    return static_cast<std::size_t>(mb * 1024.0 * 1024.0);
+}
+
+// Flow 顶层 priority → 0~100；超出范围时截断
+int flowPriorityFrom(double priority) {
+    if (priority < 0.0 || priority > 100.0) {
+        std::cerr << "FlowExecutor: Clamping priority " << priority << " to [0, 100]" << std::endl;
+    }
+    return static_cast<int>(std::clamp(priority, 0.0, 100.0));
+}
+
+} // namespace
+
 bool FlowExecutor::loadFlow(const std::string& flow_json) {
+    BootSpan span("FlowExecutor::loadFlow", "flow");
+    if (on_demand_parsing_) {
+        return parseFlowText(flow_json);
+    }
     try {
         // 只解析一次JSON，避免重复解析
         flow_definition_json_ = json::parse(flow_json);
@@ -41,6 +120,15 @@ bool FlowExecutor::loadFlow(const std::string& flow_json) {
 }
 
 bool FlowExecutor::loadFlowFromFile(const std::string& file_path) {
+    BootSpan span("FlowExecutor::loadFlowFromFile", "flow");
+    if (on_demand_parsing_) {
+        MappedFlowFile mapped(file_path);
+        if (!mapped.opened()) {
+            std::cerr << "FlowExecutor: Failed to open file: " << file_path << std::endl;
+            return false;
+        }
+        return parseFlowText(mapped.view());
+    }
     std::ifstream file(file_path);
     if (!file.is_open()) {
         std::cerr << "FlowExecutor: Failed to open file: " << file_path << std::endl;
@@ -132,7 +220,7 @@ bool FlowExecutor::loadFlowFromBuilder(const std::string& builder_url,
     std::cerr << "  Builder URL: " << builder_url << std::endl;
     std::cerr << "  Project ID: " << project_id << std::endl;
     std::cerr << "  Flow ID: " << flow_id << std::endl;
-    std::cerr << "  Please enable CPPHTTPLIB_OPENSSL_SUPPORT in CMakeLists.txt" << std::endl;
+    std::cerr << "  Please configure with -DFALCONMINDSDK_WITH_HTTP=ON (full profile)" << std::endl;
     return false;
 #endif
 }
@@ -152,6 +240,13 @@ bool FlowExecutor::parseFlowDefinition(const json& flow_json_obj) {
         flow_id_ = j["flow_id"].get<std::string>();
         flow_name_ = j.value("name", "");
         flow_version_ = j.value("version", "1.0");
+        latency_budget_ns_ = static_cast<std::int64_t>(j.value("latency_budget_ms", 0.0) * 1e6);
+        if (latency_budget_ns_ < 0) {
+            std::cerr << "FlowExecutor: Ignoring negative latency_budget_ms" << std::endl;
+            latency_budget_ns_ = 0;
+        }
+        memory_budget_bytes_ = memoryBudgetFromMb(j.value("memory_budget_mb", 0.0));
+        priority_ = flowPriorityFrom(j.value("priority", 50.0));
         
         // 解析节点定义
         if (!j.contains("nodes") || !j["nodes"].is_array()) {
@@ -196,16 +291,12 @@ bool FlowExecutor::parseFlowDefinition(const json& flow_json_obj) {
             edge_def.to_node_id = edge_json["to_node_id"].get<std::string>();
             edge_def.to_port = edge_json["to_port"].get<std::string>();
             
+            parseEdgeOptions(edge_json, edge_def);
+            
             edge_definitions_.push_back(std::move(edge_def));
         }
         
-        std::cout << "FlowExecutor: Parsed flow definition" << std::endl;
-        std::cout << "  Flow ID: " << flow_id_ << std::endl;
-        std::cout << "  Flow Name: " << flow_name_ << std::endl;
-        std::cout << "  Flow Version: " << flow_version_ << std::endl;
-        std::cout << "  Nodes: " << node_definitions_.size() << std::endl;
-        std::cout << "  Edges: " << edge_definitions_.size() << std::endl;
-        
+        finishFlowDefinition();
         return true;
     } catch (const json::exception& e) {
         std::cerr << "FlowExecutor: JSON parsing error: " << e.what() << std::endl;
@@ -216,37 +307,422 @@ bool FlowExecutor::parseFlowDefinition(const json& flow_json_obj) {
     }
 }
 
+bool FlowExecutor::parseFlowText(std::string_view text) {
+    // 先解析到局部变量，全部成功后才替换当前定义（与 DOM 路径一样，失败时由调用方决定是否保留旧 Flow）
+    JsonCursor cur(text);
+    std::string flow_id;
+    std::string flow_name;
+    std::string flow_version = "1.0";
+    double latency_budget_ms = 0.0;
+    double memory_budget_mb = 0.0;
+    double priority = 50.0;
+    bool has_flow_id = false;
+    bool has_nodes = false;
+    bool has_edges = false;
+    std::vector<NodeDefinition> nodes;
+    std::vector<EdgeDefinition> edges;
+    std::string key;
+    std::string missing;
+
+    auto parseNodes = [&]() {
+        if (!cur.beginArray()) return false;
+        while (cur.nextElement()) {
+            NodeDefinition def;
+            def.parameters_json = json::object();
+            bool has_id = false;
+            bool has_template = false;
+            if (!cur.beginObject()) return false;
+            while (cur.nextField(key)) {
+                if (key == "node_id") {
+                    has_id = cur.readString(def.node_id);
+                } else if (key == "template_id") {
+                    has_template = cur.readString(def.template_id);
+                } else if (key == "parameters") {
+                    std::string_view raw;
+                    if (!cur.rawValue(raw)) return false;
+                    // 大多数节点为空参数，不必交给 DOM 解析器
+                    def.parameters_json = raw == "{}" ? json::object() : json::parse(raw.begin(), raw.end());
+                    def.parameters_text.assign(raw.data(), raw.size());
+                } else {
+                    cur.skipValue();
+                }
+                if (cur.failed()) return false;
+            }
+            if (cur.failed()) return false;
+            if (!has_id || !has_template) {
+                missing = "node definition missing node_id or template_id";
+                return false;
+            }
+            nodes.push_back(std::move(def));
+        }
+        return !cur.failed();
+    };
+
+    auto parseEdges = [&]() {
+        if (!cur.beginArray()) return false;
+        while (cur.nextElement()) {
+            EdgeDefinition def;
+            int endpoints = 0;
+            json options;
+            if (!cur.beginObject()) return false;
+            while (cur.nextField(key)) {
+                if (key == "edge_id") {
+                    cur.readString(def.edge_id);
+                } else if (key == "from_node_id") {
+                    endpoints += cur.readString(def.from_node_id);
+                } else if (key == "from_port") {
+                    endpoints += cur.readString(def.from_port);
+                } else if (key == "to_node_id") {
+                    endpoints += cur.readString(def.to_node_id);
+                } else if (key == "to_port") {
+                    endpoints += cur.readString(def.to_port);
+                } else if (key == "queue" || key == "backpressure") {
+                    std::string_view raw;
+                    if (!cur.rawValue(raw)) return false;
+                    options[key] = json::parse(raw.begin(), raw.end());
+                } else {
+                    cur.skipValue();
+                }
+                if (cur.failed()) return false;
+            }
+            if (cur.failed()) return false;
+            if (endpoints != 4) {
+                missing = "edge definition missing from_node_id/from_port/to_node_id/to_port";
+                return false;
+            }
+            if (!options.is_null()) parseEdgeOptions(options, def);
+            edges.push_back(std::move(def));
+        }
+        return !cur.failed();
+    };
+
+    try {
+        if (cur.beginObject()) {
+            while (cur.nextField(key)) {
+                if (key == "flow_id") {
+                    has_flow_id = cur.readString(flow_id);
+                } else if (key == "name") {
+                    cur.readString(flow_name);
+                } else if (key == "version") {
+                    cur.readString(flow_version);
+                } else if (key == "latency_budget_ms") {
+                    cur.readNumber(latency_budget_ms);
+                } else if (key == "memory_budget_mb") {
+                    cur.readNumber(memory_budget_mb);
+                } else if (key == "priority") {
+                    cur.readNumber(priority);
+                } else if (key == "nodes" && cur.peek() == '[') {
+                    nodes.clear();
+                    has_nodes = parseNodes();
+                } else if (key == "edges" && cur.peek() == '[') {
+                    edges.clear();
+                    has_edges = parseEdges();
+                } else {
+                    cur.skipValue();
+                }
+                if (cur.failed() || !missing.empty()) break;
+            }
+        }
+    } catch (const json::exception& e) {
+        std::cerr << "FlowExecutor: JSON parsing error: " << e.what() << std::endl;
+        return false;
+    }
+    if (!missing.empty()) {
+        std::cerr << "FlowExecutor: Error parsing flow definition: " << missing << std::endl;
+        return false;
+    }
+    if (!cur.finish()) {
+        std::cerr << "FlowExecutor: Failed to parse JSON: " << cur.error() << std::endl;
+        return false;
+    }
+    if (!has_flow_id) {
+        std::cerr << "FlowExecutor: Flow definition missing flow_id" << std::endl;
+        return false;
+    }
+    if (!has_nodes) {
+        std::cerr << "FlowExecutor: Flow definition missing or invalid nodes array" << std::endl;
+        return false;
+    }
+    if (!has_edges) {
+        std::cerr << "FlowExecutor: Flow definition missing or invalid edges array" << std::endl;
+        return false;
+    }
+
+    flow_id_ = std::move(flow_id);
+    flow_name_ = std::move(flow_name);
+    flow_version_ = std::move(flow_version);
+    latency_budget_ns_ = static_cast<std::int64_t>(latency_budget_ms * 1e6);
+    if (latency_budget_ns_ < 0) {
+        std::cerr << "FlowExecutor: Ignoring negative latency_budget_ms" << std::endl;
+        latency_budget_ns_ = 0;
+    }
+    memory_budget_bytes_ = memoryBudgetFromMb(memory_budget_mb);
+    priority_ = flowPriorityFrom(priority);
+    node_definitions_ = std::move(nodes);
+    edge_definitions_ = std::move(edges);
+    // 整份 DOM 未建立：热更新比较差异只需 node/edge 定义
+    flow_definition_json_ = json();
+    finishFlowDefinition();
+    return true;
+}
+
+void FlowExecutor::parseEdgeOptions(const json& edge_json, EdgeDefinition& edge_def) {
+    // 可选：连接队列（异步投递）
+    if (edge_json.contains("queue") && edge_json["queue"].is_object()) {
+        const auto& q = edge_json["queue"];
+        edge_def.queue.enabled = q.value("enabled", true);
+        edge_def.queue.capacity = q.value("capacity", edge_def.queue.capacity);
+        edge_def.queue.blockTimeout = std::chrono::milliseconds(
+            q.value("block_timeout_ms", static_cast<int64_t>(edge_def.queue.blockTimeout.count())));
+        std::string policy = q.value("policy", "drop_oldest");
+        if (policy == "drop_newest") {
+            edge_def.queue.policy = LinkQueuePolicy::DropNewest;
+        } else if (policy == "block") {
+            edge_def.queue.policy = LinkQueuePolicy::Block;
+        } else if (policy == "drop_oldest") {
+            edge_def.queue.policy = LinkQueuePolicy::DropOldest;
+        } else {
+            std::cerr << "FlowExecutor: Unknown queue policy '" << policy << "' on edge "
+                      << edge_def.edge_id << ", using drop_oldest" << std::endl;
+        }
+    }
+    
+    // 可选：慢消费者背压策略 "backpressure": {"policy":"keep_latest|skip_n|adapt_source_fps",
+    //                                        "skip_frames":2,"min_source_fps":5}
+    if (edge_json.contains("backpressure") && edge_json["backpressure"].is_object()) {
+        const auto& b = edge_json["backpressure"];
+        std::string policy = b.value("policy", "none");
+        if (policy == "keep_latest") {
+            edge_def.queue.backpressure = LinkBackpressure::KeepLatest;
+        } else if (policy == "skip_n") {
+            edge_def.queue.backpressure = LinkBackpressure::SkipN;
+            edge_def.queue.skipFrames = b.value("skip_frames", 1u);
+        } else if (policy == "adapt_source_fps") {
+            edge_def.queue.backpressure = LinkBackpressure::AdaptSourceRate;
+            edge_def.queue.minSourceFps = b.value("min_source_fps", edge_def.queue.minSourceFps);
+        } else if (policy != "none") {
+            std::cerr << "FlowExecutor: Unknown backpressure policy '" << policy << "' on edge "
+                      << edge_def.edge_id << ", ignoring" << std::endl;
+        }
+    }
+}
+
+void FlowExecutor::finishFlowDefinition() {
+    std::cout << "FlowExecutor: Parsed flow definition" << std::endl;
+    std::cout << "  Flow ID: " << flow_id_ << std::endl;
+    std::cout << "  Flow Name: " << flow_name_ << std::endl;
+    std::cout << "  Flow Version: " << flow_version_ << std::endl;
+    std::cout << "  Nodes: " << node_definitions_.size() << std::endl;
+    std::cout << "  Edges: " << edge_definitions_.size() << std::endl;
+    
+    // 预编译执行计划；完整（模板均已注册、边两端均存在）时写入磁盘缓存
+    if (compilePlan() && plan_cache_) {
+        plan_cache_->store(plan_);
+    }
+}
+
+bool FlowExecutor::compilePlan() {
+    FlowPlan plan;
+    plan.flowId = flow_id_;
+    plan.flowName = flow_name_;
+    plan.version = flow_version_;
+    plan.latencyBudgetNs = latency_budget_ns_;
+    plan.memoryBudgetBytes = memory_budget_bytes_;
+    plan.priority = priority_;
+    plan.nodes.reserve(node_definitions_.size());
+    plan.edges.reserve(edge_definitions_.size());
+
+    bool complete = true;
+    std::unordered_map<std::string, std::uint32_t> index;
+    for (const auto& node_def : node_definitions_) {
+        FlowPlanNode node;
+        node.nodeId = node_def.node_id;
+        node.templateId = node_def.template_id;
+        node.creator = NodeFactory::findCreator(node_def.template_id);
+        complete = complete && static_cast<bool>(node.creator);
+        compileNodeParams(node_def.template_id, node_def.parameters_json, node);
+        node.parametersJson =
+            node_def.parameters_text.empty() ? node_def.parameters_json.dump() : node_def.parameters_text;
+        index.emplace(node.nodeId, static_cast<std::uint32_t>(plan.nodes.size()));
+        plan.nodes.push_back(std::move(node));
+    }
+    for (const auto& edge_def : edge_definitions_) {
+        FlowPlanEdge edge;
+        auto from_it = index.find(edge_def.from_node_id);
+        auto to_it = index.find(edge_def.to_node_id);
+        edge.from = from_it != index.end() ? from_it->second : kUnresolvedNode;
+        edge.to = to_it != index.end() ? to_it->second : kUnresolvedNode;
+        complete = complete && edge.from != kUnresolvedNode && edge.to != kUnresolvedNode;
+        edge.edgeId = edge_def.edge_id;
+        edge.fromPort = edge_def.from_port;
+        edge.toPort = edge_def.to_port;
+        edge.queue = edge_def.queue;
+        plan.edges.push_back(std::move(edge));
+    }
+    plan_ = std::move(plan);
+    return complete;
+}
+
+const FlowPlanNode* FlowExecutor::findPlanNode(const std::string& node_id) const {
+    for (const auto& node : plan_.nodes) {
+        if (node.nodeId == node_id) return &node;
+    }
+    return nullptr;
+}
+
+void FlowExecutor::restoreDefinitionsFromPlan() {
+    node_definitions_.clear();
+    edge_definitions_.clear();
+    for (const auto& node : plan_.nodes) {
+        NodeDefinition def;
+        def.node_id = node.nodeId;
+        def.template_id = node.templateId;
+        def.parameters_json = json::parse(node.parametersJson, nullptr, false);
+        if (def.parameters_json.is_discarded()) def.parameters_json = json::object();
+        node_definitions_.push_back(std::move(def));
+    }
+    for (const auto& edge : plan_.edges) {
+        EdgeDefinition def;
+        def.edge_id = edge.edgeId;
+        def.from_node_id = plan_.nodes[edge.from].nodeId;
+        def.from_port = edge.fromPort;
+        def.to_node_id = plan_.nodes[edge.to].nodeId;
+        def.to_port = edge.toPort;
+        def.queue = edge.queue;
+        edge_definitions_.push_back(std::move(def));
+    }
+}
+
+void FlowExecutor::setPlanCacheDirectory(const std::string& directory) {
+    if (directory.empty()) {
+        plan_cache_.reset();
+    } else {
+        plan_cache_ = std::make_unique<FlowPlanCache>(directory);
+    }
+}
+
+bool FlowExecutor::loadFlowFromCache(const std::string& flow_id, const std::string& version) {
+    BootSpan span("FlowExecutor::loadFlowFromCache", "flow");
+    if (!plan_cache_) {
+        std::cerr << "FlowExecutor: Plan cache directory not set" << std::endl;
+        return false;
+    }
+    FlowPlan plan;
+    if (!plan_cache_->load(flow_id, version, plan)) {
+        return false;
+    }
+    plan_ = std::move(plan);
+    flow_id_ = plan_.flowId;
+    flow_name_ = plan_.flowName;
+    flow_version_ = plan_.version;
+    latency_budget_ns_ = plan_.latencyBudgetNs;
+    memory_budget_bytes_ = static_cast<std::size_t>(plan_.memoryBudgetBytes);
+    priority_ = plan_.priority;
+    flow_definition_json_ = json();
+    // 原始定义仅在热更新比较差异时才需要，届时再由计划还原
+    node_definitions_.clear();
+    edge_definitions_.clear();
+    std::cout << "FlowExecutor: Loaded compiled plan for flow " << flow_id_ << " (version " << flow_version_
+              << ", " << plan_.nodes.size() << " nodes, " << plan_.edges.size() << " edges)" << std::endl;
+    return true;
+}
+
 bool FlowExecutor::createNodes() {
-    if (node_definitions_.empty()) {
+    if (plan_.nodes.empty()) {
         std::cerr << "FlowExecutor: No node definitions to create" << std::endl;
         return false;
     }
     
     nodes_.clear();
     
-    for (const auto& node_def : node_definitions_) {
-        // 创建Node实例
-        auto node = NodeFactory::createNode(node_def.template_id, node_def.node_id, nullptr);
-        if (!node) {
-            std::cerr << "FlowExecutor: Failed to create node: " << node_def.node_id 
-                      << " (template: " << node_def.template_id << ")" << std::endl;
-            return false;
+    // 节点构造互不依赖（模型加载等慢操作并行），全部尝试后汇总失败
+    std::vector<std::shared_ptr<Node>> built(plan_.nodes.size());
+    std::vector<std::string> logs(plan_.nodes.size());
+    runWithDependencies(plan_.nodes.size(), {}, 0, [this, &built, &logs](std::size_t i) {
+        built[i] = constructNode(plan_.nodes[i], logs[i]);
+        return true;
+    });
+    
+    std::vector<std::string> failed;
+    for (std::size_t i = 0; i < plan_.nodes.size(); ++i) {
+        std::cout << logs[i];
+        if (built[i]) {
+            nodes_[plan_.nodes[i].nodeId] = built[i];
+        } else {
+            failed.push_back(plan_.nodes[i].nodeId);
         }
-        
-        // 配置节点参数
-        if (!configureNodeParams(node, node_def.template_id, node_def.parameters_json)) {
-            std::cerr << "FlowExecutor: Failed to configure node parameters: " << node_def.node_id << std::endl;
-            // 继续执行，参数配置失败不影响节点创建
+    }
+    if (!failed.empty()) {
+        std::string list;
+        for (const auto& id : failed) {
+            list += (list.empty() ? "" : ", ") + id;
         }
-        
-        nodes_[node_def.node_id] = node;
-        std::cout << "FlowExecutor: Created and configured node: " << node_def.node_id 
-                  << " (template: " << node_def.template_id << ")" << std::endl;
+        std::cerr << "FlowExecutor: " << failed.size() << " node(s) failed to create: " << list << std::endl;
+        nodes_.clear();
+        return false;
     }
     
     return true;
 }
 
+bool FlowExecutor::createNode(const NodeDefinition& node_def) {
+    const FlowPlanNode* plan_node = findPlanNode(node_def.node_id);
+    if (plan_node && plan_node->templateId == node_def.template_id) {
+        return instantiateNode(*plan_node);
+    }
+    FlowPlanNode compiled;
+    compiled.nodeId = node_def.node_id;
+    compiled.templateId = node_def.template_id;
+    compiled.creator = NodeFactory::findCreator(node_def.template_id);
+    compileNodeParams(node_def.template_id, node_def.parameters_json, compiled);
+    return instantiateNode(compiled);
+}
+
+bool FlowExecutor::instantiateNode(const FlowPlanNode& plan_node) {
+    std::string log;
+    auto node = constructNode(plan_node, log);
+    std::cout << log;
+    if (!node) {
+        return false;
+    }
+    nodes_[plan_node.nodeId] = node;
+    return true;
+}
+
+std::shared_ptr<Node> FlowExecutor::constructNode(const FlowPlanNode& plan_node, std::string& log) {
+    // 可在工作线程并发调用：输出先写入 log，由调用方统一打印，避免多线程日志交错
+    std::ostringstream out;
+    std::shared_ptr<Node> node;
+    if (plan_node.creator) {
+        try {
+            node = plan_node.creator(plan_node.nodeId, nullptr);
+        } catch (const std::exception& e) {
+            out << "FlowExecutor: Node creator threw for " << plan_node.nodeId << ": " << e.what() << "\n";
+        }
+    } else {
+        out << "FlowExecutor: Unknown template_id: " << plan_node.templateId << "\n";
+    }
+    if (!node) {
+        out << "FlowExecutor: Failed to create node: " << plan_node.nodeId 
+            << " (template: " << plan_node.templateId << ")\n";
+        log = out.str();
+        return nullptr;
+    }
+    
+    // 应用预解析的参数
+    std::string error;
+    if (!applyNodeParams(node, plan_node, error)) {
+        out << "FlowExecutor: " << error << "\n";
+        out << "FlowExecutor: Failed to configure node parameters: " << plan_node.nodeId << "\n";
+        // 继续执行，参数配置失败不影响节点创建
+    }
+    
+    out << "FlowExecutor: Created and configured node: " << plan_node.nodeId 
+        << " (template: " << plan_node.templateId << ")\n";
+    log = out.str();
+    return node;
+}
+
 // 参数验证辅助函数
 namespace {
     // 验证地理坐标点
@@ -319,6 +795,28 @@ namespace {
             }
         }
         
+        // 验证孔洞（排除区）
+        if (area_json.contains("holes")) {
+            if (!area_json["holes"].is_array()) {
+                error_msg = "search_area.holes must be an array";
+                return false;
+            }
+            const auto& holes = area_json["holes"];
+            for (size_t h = 0; h < holes.size(); ++h) {
+                if (!holes[h].is_array() || holes[h].size() < 3) {
+                    error_msg = "search_area.holes[" + std::to_string(h) + "] must be an array of at least 3 points";
+                    return false;
+                }
+                for (size_t i = 0; i < holes[h].size(); ++i) {
+                    std::string point_error;
+                    if (!validateGeoPoint(holes[h][i], point_error)) {
+                        error_msg = "search_area.holes[" + std::to_string(h) + "][" + std::to_string(i) + "]: " + point_error;
+                        return false;
+                    }
+                }
+            }
+        }
+        
         // 验证高度范围
         if (area_json.contains("min_altitude")) {
             if (!area_json["min_altitude"].is_number()) {
@@ -417,6 +915,22 @@ namespace {
             }
         }
         
+        // 验证扫描线方向
+        if (params_json.contains("sweep_angle") && !params_json["sweep_angle"].is_number()) {
+            error_msg = "search_params.sweep_angle must be a number";
+            return false;
+        }
+        
+        // 验证相机视场角（覆盖统计）
+        for (const char* key : {"camera_hfov", "camera_vfov"}) {
+            if (!params_json.contains(key)) continue;
+            if (!params_json[key].is_number() || params_json[key].get<double>() < 0.0 ||
+                params_json[key].get<double>() >= 180.0) {
+                error_msg = std::string("search_params.") + key + " must be a number in [0, 180) degrees";
+                return false;
+            }
+        }
+        
         // 验证悬停时间
         if (params_json.contains("loiter_time")) {
             if (!params_json["loiter_time"].is_number()) {
@@ -438,33 +952,80 @@ namespace {
             }
         }
         
+        // 验证 detection_classes（类别名数组）
+        if (params_json.contains("detection_classes")) {
+            const auto& classes = params_json["detection_classes"];
+            if (!classes.is_array() ||
+                !std::all_of(classes.begin(), classes.end(), [](const json& c) { return c.is_string(); })) {
+                error_msg = "search_params.detection_classes must be an array of strings";
+                return false;
+            }
+        }
+        
         return true;
     }
 }
 
-bool FlowExecutor::configureNodeParams(std::shared_ptr<Node> node,
-                                      const std::string& template_id,
-                                      const json& params_json) {
+bool FlowExecutor::compileNodeParams(const std::string& template_id,
+                                     const json& params_json,
+                                     FlowPlanNode& out) {
+    out.paramsValid = true;
+    out.paramsError.clear();
+    out.planner = PlannerPlanParams{};
+    out.hasTypedParams = false;
+    out.typedParams = NodeParams{};
+    out.placement = NodePlacement{};
+    out.watchdog = WatchdogPolicy{};
     if (params_json.is_null() || params_json.empty()) {
         return true;  // 无参数需要配置
     }
     
     try {
-        // 根据模板ID配置不同类型的节点
-        if (template_id == "search_path_planner") {
-            auto planner = std::dynamic_pointer_cast<mission::SearchPathPlannerNode>(node);
-            if (!planner) {
-                std::cerr << "FlowExecutor: Node is not SearchPathPlannerNode" << std::endl;
+        // 放置提示对所有模板通用
+        if (params_json.is_object() && params_json.contains("placement")) {
+            std::string placement_error;
+            if (!parsePlacement(params_json["placement"], out.placement, placement_error)) {
+                out.paramsError = "Invalid placement: " + placement_error;
+                out.paramsValid = false;
+                out.placement = NodePlacement{};
                 return false;
             }
-            
+        }
+        if (params_json.is_object() && params_json.contains("watchdog")) {
+            std::string watchdog_error;
+            if (!parseWatchdog(params_json["watchdog"], out.watchdog, watchdog_error)) {
+                out.paramsError = "Invalid watchdog: " + watchdog_error;
+                out.paramsValid = false;
+                out.placement = NodePlacement{};
+                out.watchdog = WatchdogPolicy{};
+                return false;
+            }
+        }
+
+        // 声明了参数 Schema 的模板：类型、范围在此一次校验，节点创建时直接取类型化取值
+        if (auto schema = NodeParamRegistry::find(template_id)) {
+            std::string schema_error;
+            if (!schema->parse(params_json, out.typedParams, schema_error)) {
+                out.paramsError = "Invalid parameters: " + schema_error;
+                out.paramsValid = false;
+                out.typedParams = NodeParams{};
+                out.placement = NodePlacement{};
+                out.watchdog = WatchdogPolicy{};
+                return false;
+            }
+            out.hasTypedParams = true;
+        }
+
+        // 根据模板ID校验并预解析不同类型节点的参数
+        if (template_id == "search_path_planner") {
             // 参数格式和值范围验证
             std::string validation_error;
             
             // 验证搜索区域
             if (params_json.contains("search_area")) {
                 if (!validateSearchArea(params_json["search_area"], validation_error)) {
-                    std::cerr << "FlowExecutor: Invalid search_area: " << validation_error << std::endl;
+                    out.paramsError = "Invalid search_area: " + validation_error;
+                    out.paramsValid = false;
                     return false;
                 }
             }
@@ -472,7 +1033,8 @@ bool FlowExecutor::configureNodeParams(std::shared_ptr<Node> node,
             // 验证搜索参数
             if (params_json.contains("search_params")) {
                 if (!validateSearchParams(params_json["search_params"], validation_error)) {
-                    std::cerr << "FlowExecutor: Invalid search_params: " << validation_error << std::endl;
+                    out.paramsError = "Invalid search_params: " + validation_error;
+                    out.paramsValid = false;
                     return false;
                 }
             }
@@ -480,7 +1042,7 @@ bool FlowExecutor::configureNodeParams(std::shared_ptr<Node> node,
             // 解析搜索区域（验证通过后）
             // 使用引用避免重复访问JSON对象
             if (params_json.contains("search_area")) {
-                mission::SearchArea area;
+                mission::SearchArea& area = out.planner.area;
                 const auto& area_json = params_json["search_area"];  // 使用const引用
                 
                 // 解析多边形 - 预分配空间
@@ -496,16 +1058,27 @@ bool FlowExecutor::configureNodeParams(std::shared_ptr<Node> node,
                     }
                 }
                 
+                if (area_json.contains("holes") && area_json["holes"].is_array()) {
+                    for (const auto& hole_json : area_json["holes"]) {
+                        std::vector<mission::GeoPoint> hole;
+                        hole.reserve(hole_json.size());
+                        for (const auto& point_json : hole_json) {
+                            hole.push_back({point_json["lat"].get<double>(), point_json["lon"].get<double>(),
+                                            point_json.value("alt", 0.0)});
+                        }
+                        area.holes.push_back(std::move(hole));
+                    }
+                }
+                
                 area.minAltitude = area_json.value("min_altitude", 0.0);
                 area.maxAltitude = area_json.value("max_altitude", 100.0);
-                
-                planner->setSearchArea(area);
+                out.planner.hasArea = true;
             }
             
             // 解析搜索参数（验证通过后）
             // 使用引用避免重复访问JSON对象
             if (params_json.contains("search_params")) {
-                mission::SearchParams params;
+                mission::SearchParams& params = out.planner.params;
                 const auto& params_json_obj = params_json["search_params"];  // 使用const引用
                 
                 // 解析搜索模式 - 一次性获取并转换
@@ -530,22 +1103,222 @@ bool FlowExecutor::configureNodeParams(std::shared_ptr<Node> node,
                 params.spacing = params_json_obj.value("spacing", 20.0);
                 params.loiterTime = params_json_obj.value("loiter_time", 2.0);
                 params.enableDetection = params_json_obj.value("enable_detection", false);
-                
-                planner->setSearchParams(params);
+                params.sweepAngle = params_json_obj.value("sweep_angle", 0.0);
+                params.cameraHfov = params_json_obj.value("camera_hfov", 0.0);
+                params.cameraVfov = params_json_obj.value("camera_vfov", 0.0);
+                params.detectionClasses.clear();
+                if (params_json_obj.contains("detection_classes")) {
+                    params.detectionClasses = params_json_obj["detection_classes"].get<std::vector<std::string>>();
+                }
+                out.planner.hasParams = true;
             }
         }
-        // 其他节点类型的参数配置可以在这里添加
-        // else if (template_id == "event_reporter") { ... }
-        // else if (template_id == "camera_source") { ... }
+        // 其他节点类型：声明参数 Schema（NodeParamRegistry）即可在上面统一校验
         
         return true;
     } catch (const json::exception& e) {
-        std::cerr << "FlowExecutor: Error configuring node parameters: " << e.what() << std::endl;
-        return false;
+        out.paramsError = std::string("Error configuring node parameters: ") + e.what();
     } catch (const std::exception& e) {
-        std::cerr << "FlowExecutor: Error configuring node: " << e.what() << std::endl;
+        out.paramsError = std::string("Error configuring node: ") + e.what();
+    }
+    out.paramsValid = false;
+    out.planner = PlannerPlanParams{};
+    out.hasTypedParams = false;
+    out.typedParams = NodeParams{};
+    out.placement = NodePlacement{};
+    out.watchdog = WatchdogPolicy{};
+    return false;
+}
+
+bool FlowExecutor::validateFlowParameters(const std::string& flow_json, std::vector<std::string>& errors) {
+    NodeFactory::initializeDefaultTypes();  // 默认模板的 Schema 随默认类型注册
+    json j = json::parse(flow_json, nullptr, false);
+    if (j.is_discarded() || !j.is_object() || !j.contains("nodes") || !j["nodes"].is_array()) {
+        errors.push_back("Flow definition is not valid JSON or has no nodes array");
+        return false;
+    }
+    bool ok = true;
+    for (const auto& node_json : j["nodes"]) {
+        if (!node_json.is_object()) {
+            errors.push_back("node definition must be an object");
+            ok = false;
+            continue;
+        }
+        const std::string node_id = node_json.value("node_id", "");
+        FlowPlanNode compiled;
+        auto params = node_json.find("parameters");
+        if (!compileNodeParams(node_json.value("template_id", ""),
+                               params != node_json.end() ? *params : json::object(), compiled)) {
+            errors.push_back(node_id + ": " + compiled.paramsError);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool FlowExecutor::parsePlacement(const json& placement_json, NodePlacement& out, std::string& error) {
+    if (!placement_json.is_object()) {
+        error = "placement must be an object";
+        return false;
+    }
+    if (placement_json.contains("cpus")) {
+        const auto& cpus = placement_json["cpus"];
+        if (!cpus.is_array()) {
+            error = "cpus must be an array of cpu indices";
+            return false;
+        }
+        for (const auto& cpu : cpus) {
+            if (!cpu.is_number_integer()) {
+                error = "cpus must be an array of cpu indices";
+                return false;
+            }
+            out.cpus.push_back(cpu.get<int>());
+        }
+    }
+    if (placement_json.contains("priority")) {
+        if (!placement_json["priority"].is_number_integer()) {
+            error = "priority must be an integer";
+            return false;
+        }
+        out.priority = placement_json["priority"].get<int>();
+    }
+    if (placement_json.contains("npu_core_mask")) {
+        const auto& mask = placement_json["npu_core_mask"];
+        if (!mask.is_number_unsigned() && !(mask.is_number_integer() && mask.get<long long>() >= 0)) {
+            error = "npu_core_mask must be a non-negative integer";
+            return false;
+        }
+        out.npuCoreMask = mask.get<std::uint32_t>();
+    }
+    if (placement_json.contains("class")) {
+        const auto& cls = placement_json["class"];
+        if (cls == "critical") {
+            out.schedClass = SchedClass::Critical;
+        } else if (cls == "best_effort") {
+            out.schedClass = SchedClass::BestEffort;
+        } else {
+            error = "class must be \"critical\" or \"best_effort\"";
+            return false;
+        }
+    }
+    auto parseMs = [&](const char* key, std::chrono::microseconds& field) {
+        if (!placement_json.contains(key)) return true;
+        const auto& value = placement_json[key];
+        if (!value.is_number() || value.get<double>() < 0.0) {
+            error = std::string(key) + " must be a non-negative number";
+            return false;
+        }
+        field = std::chrono::microseconds(static_cast<std::int64_t>(value.get<double>() * 1000.0 + 0.5));
+        return true;
+    };
+    if (!parseMs("deadline_ms", out.deadline) || !parseMs("period_ms", out.period)) {
+        return false;
+    }
+    return out.validate(error);
+}
+
+bool FlowExecutor::parseWatchdog(const json& watchdog_json, WatchdogPolicy& out, std::string& error) {
+    if (!watchdog_json.is_object()) {
+        error = "watchdog must be an object";
+        return false;
+    }
+    for (const char* key : {"stall_ms", "slo_ms", "violations"}) {
+        if (watchdog_json.contains(key) && !watchdog_json[key].is_number_unsigned()) {
+            error = std::string(key) + " must be a non-negative integer";
+            return false;
+        }
+    }
+    out.stallTimeout = std::chrono::milliseconds(watchdog_json.value("stall_ms", 0u));
+    out.latencySlo = std::chrono::milliseconds(watchdog_json.value("slo_ms", 0u));
+    out.violations = watchdog_json.value("violations", out.violations);
+    if (watchdog_json.contains("ladder")) {
+        const auto& ladder = watchdog_json["ladder"];
+        if (!ladder.is_array()) {
+            error = "ladder must be an array of action names";
+            return false;
+        }
+        out.ladder.clear();
+        for (const auto& step : ladder) {
+            WatchdogAction action{};
+            if (!step.is_string() || !parseWatchdogAction(step.get<std::string>(), action)) {
+                error = "unknown ladder action " + step.dump();
+                return false;
+            }
+            out.ladder.push_back(action);
+        }
+    }
+    return out.validate(error);
+}
+
+bool FlowExecutor::applyNodeParams(const std::shared_ptr<Node>& node, const FlowPlanNode& plan_node,
+                                   std::string& error) {
+    if (!plan_node.paramsValid) {
+        error = plan_node.paramsError;
+        return false;
+    }
+    if (!plan_node.placement.empty() || !node->placement().empty()) {
+        node->setPlacement(plan_node.placement);
+    }
+    if (plan_node.templateId == "search_path_planner" &&
+        (plan_node.planner.hasArea || plan_node.planner.hasParams)) {
+        auto planner = std::dynamic_pointer_cast<mission::SearchPathPlannerNode>(node);
+        if (!planner) {
+            error = "Node is not SearchPathPlannerNode";
+            return false;
+        }
+        if (plan_node.planner.hasArea) {
+            planner->setSearchArea(plan_node.planner.area);
+        }
+        if (plan_node.planner.hasParams) {
+            planner->setSearchParams(plan_node.planner.params);
+        }
+    }
+    if (plan_node.hasTypedParams && !node->applyParams(plan_node.typedParams)) {
+        error = "Invalid parameters for node: " + plan_node.nodeId;
         return false;
     }
+    const auto& tid = plan_node.templateId;
+    if ((tid == "shm_sink" || tid == "shm_source" || tid == "capture_recorder" || tid == "replay_source" ||
+         tid == "multi_camera_source" || tid == "pointcloud_filter" || tid == "image_transform") &&
+        !plan_node.parametersJson.empty()) {
+        // 共享内存收发、录制/回放、多相机、点云预处理、图像变换节点：parameters 中的标量按字符串传给 configure
+        //（channel/slots/slot_size/wait_ms，path/speed/loop/batch，devices/max_skew_ms/queue_depth，voxel_size/...，
+        //  width/height/crop_*/rotate）
+        std::unordered_map<std::string, std::string> params;
+        json parsed = json::parse(plan_node.parametersJson, nullptr, false);
+        if (parsed.is_object()) {
+            for (auto it = parsed.begin(); it != parsed.end(); ++it) {
+                if (it.value().is_string()) {
+                    params[it.key()] = it.value().get<std::string>();
+                } else if (it.value().is_primitive() && !it.value().is_null()) {
+                    params[it.key()] = it.value().dump();
+                }
+            }
+        }
+        if (!node->configure(params)) {
+            error = "Invalid parameters for node: " + plan_node.nodeId;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FlowExecutor::applyNodeParams(const std::shared_ptr<Node>& node, const FlowPlanNode& plan_node) {
+    std::string error;
+    if (!applyNodeParams(node, plan_node, error)) {
+        std::cerr << "FlowExecutor: " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool FlowExecutor::configureNodeParams(std::shared_ptr<Node> node,
+                                      const std::string& template_id,
+                                      const json& params_json) {
+    FlowPlanNode plan_node;
+    plan_node.templateId = template_id;
+    compileNodeParams(template_id, params_json, plan_node);
+    return applyNodeParams(node, plan_node);
 }
 
 bool FlowExecutor::connectNodes() {
@@ -555,53 +1328,56 @@ bool FlowExecutor::connectNodes() {
     }
     
     // 如果没有边定义，直接返回成功（允许没有连接的Flow）
-    if (edge_definitions_.empty()) {
+    if (plan_.edges.empty()) {
         return true;
     }
     
-    for (const auto& edge_def : edge_definitions_) {
-        auto from_it = nodes_.find(edge_def.from_node_id);
-        auto to_it = nodes_.find(edge_def.to_node_id);
+    for (const auto& edge : plan_.edges) {
+        if (edge.from == kUnresolvedNode || edge.to == kUnresolvedNode) {
+            std::cerr << "FlowExecutor: Node not found for edge: " << edge.edgeId << std::endl;
+            return false;
+        }
+        const std::string& from_id = plan_.nodes[edge.from].nodeId;
+        const std::string& to_id = plan_.nodes[edge.to].nodeId;
+        auto from_it = nodes_.find(from_id);
+        auto to_it = nodes_.find(to_id);
         
         if (from_it == nodes_.end() || to_it == nodes_.end()) {
-            std::cerr << "FlowExecutor: Node not found for edge: " << edge_def.edge_id 
-                      << " (from: " << edge_def.from_node_id 
-                      << ", to: " << edge_def.to_node_id << ")" << std::endl;
+            std::cerr << "FlowExecutor: Node not found for edge: " << edge.edgeId 
+                      << " (from: " << from_id 
+                      << ", to: " << to_id << ")" << std::endl;
             return false;
         }
         
         // 验证Pad是否存在
-        auto from_node = from_it->second;
-        auto to_node = to_it->second;
-        auto from_pad = from_node->getPad(edge_def.from_port);
-        auto to_pad = to_node->getPad(edge_def.to_port);
+        auto from_pad = from_it->second->getPad(edge.fromPort);
+        auto to_pad = to_it->second->getPad(edge.toPort);
         
         if (!from_pad) {
-            std::cerr << "FlowExecutor: Source pad not found: " << edge_def.from_node_id 
-                      << ":" << edge_def.from_port << std::endl;
+            std::cerr << "FlowExecutor: Source pad not found: " << from_id 
+                      << ":" << edge.fromPort << std::endl;
             return false;
         }
         
         if (!to_pad) {
-            std::cerr << "FlowExecutor: Sink pad not found: " << edge_def.to_node_id 
-                      << ":" << edge_def.to_port << std::endl;
+            std::cerr << "FlowExecutor: Sink pad not found: " << to_id 
+                      << ":" << edge.toPort << std::endl;
             return false;
         }
         
-        bool success = pipeline_->link(edge_def.from_node_id, edge_def.from_port,
-                                      edge_def.to_node_id, edge_def.to_port);
+        bool success = pipeline_->link(from_id, edge.fromPort, to_id, edge.toPort, edge.queue);
         if (!success) {
             std::cerr << "FlowExecutor: Failed to connect nodes: " 
-                      << edge_def.from_node_id << ":" << edge_def.from_port 
-                      << " -> " << edge_def.to_node_id << ":" << edge_def.to_port << std::endl;
+                      << from_id << ":" << edge.fromPort 
+                      << " -> " << to_id << ":" << edge.toPort << std::endl;
             std::cerr << "  Source pad type: " << static_cast<int>(from_pad->type()) << std::endl;
             std::cerr << "  Sink pad type: " << static_cast<int>(to_pad->type()) << std::endl;
             return false;
         }
         
-        std::cout << "FlowExecutor: Connected " << edge_def.from_node_id 
-                  << ":" << edge_def.from_port << " -> " 
-                  << edge_def.to_node_id << ":" << edge_def.to_port << std::endl;
+        std::cout << "FlowExecutor: Connected " << from_id 
+                  << ":" << edge.fromPort << " -> " 
+                  << to_id << ":" << edge.toPort << std::endl;
     }
     
     return true;
@@ -612,54 +1388,144 @@ bool FlowExecutor::start() {
         std::cerr << "FlowExecutor: Flow is already running" << std::endl;
         return false;
     }
+    BootSpan span("FlowExecutor::start", "flow");
     
     // 创建Pipeline
     PipelineConfig config;
     config.pipelineId = flow_id_;
     config.name = flow_name_;
     config.description = "Flow: " + flow_name_;
+    config.memoryBudgetBytes = memory_budget_bytes_;
     
     pipeline_ = std::make_shared<Pipeline>(config);
+    pipeline_->scheduler().setConfig(scheduler_config_);
     
-    // 创建节点
-    if (!createNodes()) {
+    // 任一步失败都丢弃本次创建的 Pipeline 与节点（Pipeline 内部已回滚已启动的节点）
+    auto fail = [this]() {
+        pipeline_.reset();
+        nodes_.clear();
         return false;
+    };
+    
+    // 创建节点（并行构造）
+    {
+        BootSpan create("FlowExecutor::createNodes", "flow");
+        if (!createNodes()) {
+            return fail();
+        }
+    }
+    applyLatencyBudget();
+    applyDetectionClasses();
+    // 节点尚未 link / start：此时降级的缓冲上限与输出尺寸在协商和启动时生效
+    if (!enforceMemoryBudget()) {
+        return fail();
+    }
+    for (auto& entry : nodes_) {
+        entry.second = shareSource(entry.second);
     }
+    bindAccelerators();
     
-    // 添加节点到Pipeline
-    for (const auto& pair : nodes_) {
-        if (!pipeline_->addNode(pair.second)) {
-            std::cerr << "FlowExecutor: Failed to add node to pipeline: " << pair.first << std::endl;
-            return false;
+    // 添加节点到Pipeline（按计划顺序）
+    for (const auto& plan_node : plan_.nodes) {
+        if (!pipeline_->addNode(nodes_[plan_node.nodeId])) {
+            std::cerr << "FlowExecutor: Failed to add node to pipeline: " << plan_node.nodeId << std::endl;
+            return fail();
         }
     }
     
     // 连接节点
     if (!connectNodes()) {
-        return false;
+        return fail();
+    }
+    for (const auto& tap : pad_taps_) {
+        if (!pipeline_->addPadTap(tap.nodeId, tap.padName, tap.handler, tap.queue)) {
+            std::cerr << "FlowExecutor: Failed to tap " << tap.nodeId << "." << tap.padName << std::endl;
+            return fail();
+        }
     }
     
-    // 启动Pipeline
+    // 启动Pipeline（互不依赖的节点并行启动，全部成功或全部回滚）
+    BootSpan play("Pipeline::Playing", "flow");
     if (!pipeline_->setState(PipelineState::Playing)) {
         std::cerr << "FlowExecutor: Failed to start pipeline" << std::endl;
-        return false;
+        for (const auto& id : pipeline_->startFailures()) {
+            std::cerr << "  Node failed to start: " << id << std::endl;
+        }
+        return fail();
     }
     
     running_ = true;
+    armWatchdog();
     std::cout << "FlowExecutor: Flow started successfully" << std::endl;
     return true;
 }
 
+std::shared_ptr<Node> FlowExecutor::shareSource(const std::shared_ptr<Node>& node) const {
+    if (!resource_sharing_ || !node) {
+        return node;
+    }
+    auto proxy = SharedSourceRegistry::instance().share(node);
+    if (!proxy) {
+        return node;
+    }
+    std::cout << "FlowExecutor: Node " << node->id() << " uses shared device " << proxy->deviceKey() << std::endl;
+    return proxy;
+}
+
+void FlowExecutor::bindAccelerators() {
+    for (const auto& entry : nodes_) {
+        auto* user = dynamic_cast<AcceleratorUser*>(entry.second.get());
+        if (!user) continue;
+        const std::string device = user->acceleratorDevice();
+        if (device.empty()) continue;
+        auto current = user->acceleratorClient();
+        if (current && current->device() == device && current->owner() == flow_id_ && current->priority() == priority_) {
+            continue;
+        }
+        user->setAcceleratorClient(AcceleratorArbiter::instance().client(device, flow_id_, priority_));
+    }
+}
+
+void FlowExecutor::armWatchdog() {
+    watchdog_.reset();
+    if (!pipeline_) {
+        return;
+    }
+    auto watchdog = std::make_unique<NodeWatchdog>(pipeline_->scheduler());
+    for (const auto& plan_node : plan_.nodes) {
+        auto it = nodes_.find(plan_node.nodeId);
+        if (it != nodes_.end()) {
+            watchdog->watch(it->second, plan_node.watchdog);
+        }
+    }
+    if (watchdog->watchedCount() == 0) {
+        return;
+    }
+    watchdog->setEventCallback(watchdog_callback_);
+    watchdog->start();
+    std::cout << "FlowExecutor: Watchdog monitoring " << watchdog->watchedCount() << " node(s)" << std::endl;
+    watchdog_ = std::move(watchdog);
+}
+
 void FlowExecutor::stop() {
     if (!running_) {
         return;
     }
+    // 先停看门狗，避免停止过程中触发恢复动作
+    watchdog_.reset();
     
     if (pipeline_) {
         pipeline_->setState(PipelineState::Null);
     }
+    // 注销加速器客户端：已停止的 Flow 不再参与仲裁
+    for (const auto& entry : nodes_) {
+        if (auto* user = dynamic_cast<AcceleratorUser*>(entry.second.get())) {
+            user->setAcceleratorClient(nullptr);
+        }
+    }
     
     running_ = false;
+    paused_ = false;
     std::cout << "FlowExecutor: Flow stopped" << std::endl;
 }
 
@@ -667,23 +1533,316 @@ bool FlowExecutor::isRunning() const {
     return running_;
 }
 
-bool FlowExecutor::updateFlow(const std::string& flow_json) {
-    // 停止当前Flow
+bool FlowExecutor::addPadTap(const std::string& nodeId, const std::string& padName, Pad::BufferCallback handler,
+                             const LinkQueueConfig& queue) {
+    if (running_) {
+        std::cerr << "FlowExecutor: addPadTap requires a stopped flow" << std::endl;
+        return false;
+    }
+    for (const auto& tap : pad_taps_) {
+        if (tap.nodeId == nodeId && tap.padName == padName) {
+            std::cerr << "FlowExecutor: " << nodeId << "." << padName << " is already tapped" << std::endl;
+            return false;
+        }
+    }
+    pad_taps_.push_back({nodeId, padName, std::move(handler), queue});
+    return true;
+}
+
+bool FlowExecutor::removePadTap(const std::string& nodeId, const std::string& padName) {
+    if (running_) {
+        std::cerr << "FlowExecutor: removePadTap requires a stopped flow" << std::endl;
+        return false;
+    }
+    auto it = std::find_if(pad_taps_.begin(), pad_taps_.end(), [&](const PadTap& tap) {
+        return tap.nodeId == nodeId && tap.padName == padName;
+    });
+    if (it == pad_taps_.end()) {
+        return false;
+    }
+    pad_taps_.erase(it);
+    if (pipeline_) {
+        pipeline_->removePadTap(nodeId, padName);
+    }
+    return true;
+}
+
+bool FlowExecutor::pause() {
+    if (!running_ || !pipeline_) {
+        return false;
+    }
+    if (paused_) {
+        return true;
+    }
+    if (!pipeline_->setState(PipelineState::Paused)) {
+        std::cerr << "FlowExecutor: Failed to pause pipeline" << std::endl;
+        return false;
+    }
+    paused_ = true;
+    std::cout << "FlowExecutor: Flow paused" << std::endl;
+    return true;
+}
+
+bool FlowExecutor::resume() {
+    if (!running_ || !pipeline_) {
+        return false;
+    }
+    if (!paused_) {
+        return true;
+    }
+    if (!pipeline_->setState(PipelineState::Playing)) {
+        std::cerr << "FlowExecutor: Failed to resume pipeline" << std::endl;
+        return false;
+    }
+    paused_ = false;
+    std::cout << "FlowExecutor: Flow resumed" << std::endl;
+    return true;
+}
+
+bool FlowExecutor::rebuildFlow() {
+    bool was_paused = paused_;
     stop();
-    
-    // 清理
     pipeline_.reset();
     nodes_.clear();
-    node_definitions_.clear();
-    edge_definitions_.clear();
-    
-    // 加载新Flow
-    if (!loadFlow(flow_json)) {
+    if (!start()) {
         return false;
     }
-    
-    // 重新启动
-    return start();
+    return !was_paused || pause();
+}
+
+namespace {
+bool sameQueueConfig(const LinkQueueConfig& a, const LinkQueueConfig& b) {
+    return a.enabled == b.enabled && a.capacity == b.capacity && a.policy == b.policy &&
+           a.blockTimeout == b.blockTimeout && a.backpressure == b.backpressure &&
+           a.skipFrames == b.skipFrames && a.minSourceFps == b.minSourceFps;
+}
+} // namespace
+
+bool FlowExecutor::applyFlowDiff(const std::vector<NodeDefinition>& old_nodes,
+                                 const std::vector<EdgeDefinition>& old_edges) {
+    std::unordered_map<std::string, const NodeDefinition*> old_by_id;
+    for (const auto& def : old_nodes) {
+        old_by_id[def.node_id] = &def;
+    }
+    std::unordered_set<std::string> new_ids;
+    for (const auto& def : node_definitions_) {
+        new_ids.insert(def.node_id);
+    }
+
+    // 需要重建（删除后重新创建）或删除的节点
+    std::unordered_set<std::string> replaced;
+    std::vector<const NodeDefinition*> to_create;
+    std::size_t reconfigured = 0;
+    for (const auto& def : old_nodes) {
+        if (new_ids.count(def.node_id) == 0) replaced.insert(def.node_id);
+    }
+    for (const auto& def : node_definitions_) {
+        auto it = old_by_id.find(def.node_id);
+        if (it == old_by_id.end()) {
+            to_create.push_back(&def);
+        } else if (it->second->template_id != def.template_id) {
+            replaced.insert(def.node_id);
+            to_create.push_back(&def);
+        } else if (it->second->parameters_json != def.parameters_json) {
+            // 同模板仅参数变化：就地重新配置，失败再重建
+            auto node_it = nodes_.find(def.node_id);
+            const FlowPlanNode* plan_node = findPlanNode(def.node_id);
+            if (node_it != nodes_.end() && plan_node && applyNodeParams(node_it->second, *plan_node)) {
+                ++reconfigured;
+            } else {
+                replaced.insert(def.node_id);
+                to_create.push_back(&def);
+            }
+        }
+    }
+
+    auto edgeKey = [](const EdgeDefinition& e) {
+        return e.from_node_id + ":" + e.from_port + "->" + e.to_node_id + ":" + e.to_port;
+    };
+    std::unordered_map<std::string, const EdgeDefinition*> old_edge_by_key;
+    for (const auto& e : old_edges) {
+        old_edge_by_key[edgeKey(e)] = &e;
+    }
+    std::unordered_map<std::string, const EdgeDefinition*> new_edge_by_key;
+    for (const auto& e : edge_definitions_) {
+        new_edge_by_key[edgeKey(e)] = &e;
+    }
+    auto touchesReplaced = [&replaced](const EdgeDefinition& e) {
+        return replaced.count(e.from_node_id) > 0 || replaced.count(e.to_node_id) > 0;
+    };
+
+    // 暂停调度后修改拓扑；未变化的节点保持启动状态
+    if (!pipeline_->setState(PipelineState::Paused)) {
+        return false;
+    }
+
+    std::size_t unlinked = 0;
+    for (const auto& e : old_edges) {
+        auto it = new_edge_by_key.find(edgeKey(e));
+        bool unchanged = it != new_edge_by_key.end() && sameQueueConfig(it->second->queue, e.queue);
+        if (unchanged && !touchesReplaced(e)) continue;
+        // 连接被删除节点的边随 removeNode 一并断开
+        if (!touchesReplaced(e)) {
+            pipeline_->unlink(e.from_node_id, e.from_port, e.to_node_id, e.to_port);
+        }
+        ++unlinked;
+    }
+    for (const auto& id : replaced) {
+        pipeline_->removeNode(id);
+        nodes_.erase(id);
+    }
+
+    for (const auto* def : to_create) {
+        if (!createNode(*def)) {
+            std::cerr << "FlowExecutor: Hot update failed to add node: " << def->node_id << std::endl;
+            return false;
+        }
+        auto& node = nodes_[def->node_id];
+        node = shareSource(node);
+        if (!pipeline_->addNode(node)) {
+            std::cerr << "FlowExecutor: Hot update failed to add node: " << def->node_id << std::endl;
+            return false;
+        }
+    }
+
+    std::size_t linked = 0;
+    for (const auto& e : edge_definitions_) {
+        auto it = old_edge_by_key.find(edgeKey(e));
+        bool unchanged = it != old_edge_by_key.end() && sameQueueConfig(it->second->queue, e.queue);
+        if (unchanged && !touchesReplaced(e)) continue;
+        if (nodes_.count(e.from_node_id) == 0 || nodes_.count(e.to_node_id) == 0 ||
+            !pipeline_->link(e.from_node_id, e.from_port, e.to_node_id, e.to_port, e.queue)) {
+            std::cerr << "FlowExecutor: Hot update failed to connect: " << edgeKey(e) << std::endl;
+            return false;
+        }
+        ++linked;
+    }
+
+    // 外部暂停的 Flow 保持 Paused，新增节点在 resume() 时启动
+    if (!paused_ && !pipeline_->setState(PipelineState::Playing)) {
+        std::cerr << "FlowExecutor: Hot update failed to resume pipeline" << std::endl;
+        return false;
+    }
+
+    std::cout << "FlowExecutor: Hot-updated flow " << flow_id_ << ": "
+              << replaced.size() << " node(s) removed/replaced, "
+              << to_create.size() << " created, "
+              << reconfigured << " reconfigured in place, "
+              << unlinked << " edge(s) unlinked, "
+              << linked << " linked" << std::endl;
+    return true;
+}
+
+bool FlowExecutor::updateFlow(const std::string& flow_json) {
+    json new_json;
+    try {
+        new_json = json::parse(flow_json);
+    } catch (const json::exception& e) {
+        std::cerr << "FlowExecutor: Failed to parse JSON: " << e.what() << std::endl;
+        return false;
+    }
+
+    // 未运行时无需保留任何节点，直接按新定义加载
+    if (!running_ || !pipeline_) {
+        stop();
+        pipeline_.reset();
+        nodes_.clear();
+        flow_definition_json_ = std::move(new_json);
+        if (!parseFlowDefinition(flow_definition_json_)) {
+            return false;
+        }
+        return start();
+    }
+
+    // 从缓存计划启动时原始定义未保留，比较差异前先还原
+    if (node_definitions_.empty() && !plan_.nodes.empty()) {
+        restoreDefinitionsFromPlan();
+    }
+    std::string old_flow_id = flow_id_;
+    std::string old_flow_name = flow_name_;
+    std::string old_flow_version = flow_version_;
+    std::int64_t old_latency_budget = latency_budget_ns_;
+    std::size_t old_memory_budget = memory_budget_bytes_;
+    int old_priority = priority_;
+    auto old_nodes = node_definitions_;
+    auto old_edges = edge_definitions_;
+    FlowPlan old_plan = plan_;
+    if (!parseFlowDefinition(new_json)) {
+        // 新定义无效：保留当前运行的 Flow
+        flow_id_ = old_flow_id;
+        flow_name_ = old_flow_name;
+        flow_version_ = old_flow_version;
+        latency_budget_ns_ = old_latency_budget;
+        memory_budget_bytes_ = old_memory_budget;
+        priority_ = old_priority;
+        node_definitions_ = std::move(old_nodes);
+        edge_definitions_ = std::move(old_edges);
+        plan_ = std::move(old_plan);
+        return false;
+    }
+    flow_definition_json_ = std::move(new_json);
+
+    if (flow_id_ != old_flow_id) {
+        return rebuildFlow();
+    }
+    // 修改拓扑期间不做恢复动作；完成后按新定义重新监视
+    watchdog_.reset();
+    if (!applyFlowDiff(old_nodes, old_edges)) {
+        std::cerr << "FlowExecutor: Hot update failed, rebuilding flow" << std::endl;
+        return rebuildFlow();
+    }
+    applyLatencyBudget();
+    applyDetectionClasses();
+    bindAccelerators();
+    armWatchdog();
+    return true;
+}
+
+bool FlowExecutor::enforceMemoryBudget() {
+    std::vector<std::pair<std::string, MemoryBudgetSink*>> sinks;
+    for (const auto& plan_node : plan_.nodes) {
+        auto it = nodes_.find(plan_node.nodeId);
+        if (it == nodes_.end()) continue;
+        if (auto* sink = dynamic_cast<MemoryBudgetSink*>(it->second.get())) {
+            sinks.emplace_back(plan_node.nodeId, sink);
+        }
+    }
+    memory_report_ = fitMemoryBudget(memory_budget_bytes_, sinks);
+    if (memory_budget_bytes_ == 0) return true;
+    for (const auto& step : memory_report_.degradations) {
+        std::cerr << "FlowExecutor: Memory budget degradation: " << step << std::endl;
+    }
+    if (!memory_report_.withinBudget) {
+        std::cerr << "FlowExecutor: Flow needs " << memory_report_.plannedBytes / 1024
+                  << " KiB of frame buffers after degradation, over memory_budget_mb ("
+                  << memory_budget_bytes_ / 1024 << " KiB)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void FlowExecutor::applyLatencyBudget() {
+    for (const auto& entry : nodes_) {
+        if (auto* sink = dynamic_cast<LatencySink*>(entry.second.get())) {
+            sink->latencyTracker().setBudgetNs(latency_budget_ns_);
+        }
+    }
+}
+
+void FlowExecutor::applyDetectionClasses() {
+    // 多个搜索规划节点时取并集；没有任何节点给出类别时下发空（不限类别）
+    std::vector<std::string> classes;
+    for (const auto& plan_node : plan_.nodes) {
+        if (!plan_node.planner.hasParams) continue;
+        for (const auto& name : plan_node.planner.params.detectionClasses) {
+            if (std::find(classes.begin(), classes.end(), name) == classes.end()) classes.push_back(name);
+        }
+    }
+    for (const auto& entry : nodes_) {
+        if (auto* sink = dynamic_cast<perception::ClassOfInterestSink*>(entry.second.get())) {
+            sink->setClassesOfInterest(classes);
+        }
+    }
 }
 
 } // namespace falconmind::sdk::core
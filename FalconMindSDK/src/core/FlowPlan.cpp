@@ -0,0 +1,435 @@
+#include "falconmind/sdk/core/FlowPlan.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+constexpr char kMagic[4] = {'F', 'M', 'F', 'P'};
+constexpr std::uint32_t kFormatVersion = 9;  // v2: latencyBudgetNs；v3: 连接背压策略；v4: 节点放置提示；v5: 类型化参数；v6: 内存预算；v7: 调度类别与截止时间；v8: 看门狗；v9: Flow 优先级
+
+std::uint64_t fnv1a(const char* data, std::size_t size) {
+    std::uint64_t h = 1469598103934665603ull;
+    for (std::size_t i = 0; i < size; ++i) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// 定长字段按本机字节序写入：计划文件只在本机生成和读取
+class Writer {
+public:
+    template <typename T>
+    void pod(T v) {
+        static_assert(std::is_trivially_copyable<T>::value, "pod only");
+        buf_.append(reinterpret_cast<const char*>(&v), sizeof(v));
+    }
+    void str(const std::string& s) {
+        pod(static_cast<std::uint32_t>(s.size()));
+        buf_.append(s);
+    }
+    std::string& buffer() { return buf_; }
+
+private:
+    std::string buf_;
+};
+
+class Reader {
+public:
+    Reader(const char* data, std::size_t size) : p_(data), end_(data + size) {}
+
+    template <typename T>
+    bool pod(T& v) {
+        if (static_cast<std::size_t>(end_ - p_) < sizeof(T)) return false;
+        std::memcpy(&v, p_, sizeof(T));
+        p_ += sizeof(T);
+        return true;
+    }
+    bool str(std::string& s) {
+        std::uint32_t n = 0;
+        if (!pod(n) || static_cast<std::size_t>(end_ - p_) < n) return false;
+        s.assign(p_, n);
+        p_ += n;
+        return true;
+    }
+    bool done() const { return p_ == end_; }
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+void writeGeoPoint(Writer& w, const mission::GeoPoint& p) {
+    w.pod(p.lat);
+    w.pod(p.lon);
+    w.pod(p.alt);
+}
+
+bool readGeoPoint(Reader& r, mission::GeoPoint& p) {
+    return r.pod(p.lat) && r.pod(p.lon) && r.pod(p.alt);
+}
+
+// 类型化参数：名称 | 是否显式给出 | 类型下标（ParamValue::index）| 取值
+void writeParamEntry(Writer& w, const NodeParams::Entry& e) {
+    w.str(e.name);
+    w.pod(static_cast<std::uint8_t>(e.explicitlySet));
+    w.pod(static_cast<std::uint8_t>(e.value.index()));
+    if (const auto* b = std::get_if<bool>(&e.value)) w.pod(static_cast<std::uint8_t>(*b));
+    else if (const auto* i = std::get_if<std::int64_t>(&e.value)) w.pod(*i);
+    else if (const auto* d = std::get_if<double>(&e.value)) w.pod(*d);
+    else w.str(std::get<std::string>(e.value));
+}
+
+bool readParamEntry(Reader& r, NodeParams& out) {
+    std::string name;
+    std::uint8_t explicitlySet = 0;
+    std::uint8_t type = 0;
+    if (!r.str(name) || !r.pod(explicitlySet) || !r.pod(type)) return false;
+    ParamValue value;
+    switch (static_cast<ParamType>(type)) {
+        case ParamType::Bool: {
+            std::uint8_t b = 0;
+            if (!r.pod(b)) return false;
+            value = b != 0;
+            break;
+        }
+        case ParamType::Int: {
+            std::int64_t i = 0;
+            if (!r.pod(i)) return false;
+            value = i;
+            break;
+        }
+        case ParamType::Double: {
+            double d = 0.0;
+            if (!r.pod(d)) return false;
+            value = d;
+            break;
+        }
+        case ParamType::String: {
+            std::string s;
+            if (!r.str(s)) return false;
+            value = std::move(s);
+            break;
+        }
+        default:
+            return false;
+    }
+    out.set(name, std::move(value), explicitlySet != 0);
+    return true;
+}
+
+std::string sanitize(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                  c == '-' || c == '_' || c == '.';
+        out.push_back(ok ? c : '_');
+    }
+    return out;
+}
+
+} // namespace
+
+bool FlowPlan::resolveCreators() {
+    bool ok = true;
+    for (auto& node : nodes) {
+        node.creator = NodeFactory::findCreator(node.templateId);
+        if (!node.creator) {
+            std::cerr << "FlowPlan: Unknown template_id: " << node.templateId << std::endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+std::string FlowPlan::serialize() const {
+    Writer w;
+    w.buffer().append(kMagic, sizeof(kMagic));
+    w.pod(kFormatVersion);
+    w.str(flowId);
+    w.str(flowName);
+    w.str(version);
+    w.pod(latencyBudgetNs);
+    w.pod(memoryBudgetBytes);
+    w.pod(priority);
+
+    w.pod(static_cast<std::uint32_t>(nodes.size()));
+    for (const auto& n : nodes) {
+        w.str(n.nodeId);
+        w.str(n.templateId);
+        w.pod(static_cast<std::uint8_t>(n.paramsValid));
+        w.str(n.paramsError);
+        w.str(n.parametersJson);
+
+        const auto& pp = n.planner;
+        w.pod(static_cast<std::uint8_t>(pp.hasArea));
+        if (pp.hasArea) {
+            w.pod(static_cast<std::uint32_t>(pp.area.polygon.size()));
+            for (const auto& p : pp.area.polygon) writeGeoPoint(w, p);
+            w.pod(pp.area.minAltitude);
+            w.pod(pp.area.maxAltitude);
+        }
+        w.pod(static_cast<std::uint8_t>(pp.hasParams));
+        if (pp.hasParams) {
+            w.pod(static_cast<std::int32_t>(pp.params.pattern));
+            w.pod(pp.params.altitude);
+            w.pod(pp.params.speed);
+            w.pod(pp.params.spacing);
+            w.pod(pp.params.loiterTime);
+            w.pod(static_cast<std::uint8_t>(pp.params.enableDetection));
+            w.pod(static_cast<std::uint32_t>(pp.params.detectionClasses.size()));
+            for (const auto& c : pp.params.detectionClasses) w.str(c);
+        }
+
+        w.pod(static_cast<std::uint32_t>(n.placement.cpus.size()));
+        for (int cpu : n.placement.cpus) w.pod(static_cast<std::int32_t>(cpu));
+        w.pod(static_cast<std::int32_t>(n.placement.priority));
+        w.pod(n.placement.npuCoreMask);
+        w.pod(static_cast<std::uint8_t>(n.placement.schedClass));
+        w.pod(static_cast<std::int64_t>(n.placement.deadline.count()));
+        w.pod(static_cast<std::int64_t>(n.placement.period.count()));
+
+        w.pod(static_cast<std::int64_t>(n.watchdog.stallTimeout.count()));
+        w.pod(static_cast<std::int64_t>(n.watchdog.latencySlo.count()));
+        w.pod(n.watchdog.violations);
+        w.pod(static_cast<std::uint32_t>(n.watchdog.ladder.size()));
+        for (auto action : n.watchdog.ladder) w.pod(static_cast<std::uint8_t>(action));
+
+        w.pod(static_cast<std::uint8_t>(n.hasTypedParams));
+        if (n.hasTypedParams) {
+            const auto& entries = n.typedParams.entries();
+            w.pod(static_cast<std::uint32_t>(entries.size()));
+            for (const auto& e : entries) writeParamEntry(w, e);
+        }
+    }
+
+    w.pod(static_cast<std::uint32_t>(edges.size()));
+    for (const auto& e : edges) {
+        w.pod(e.from);
+        w.pod(e.to);
+        w.str(e.edgeId);
+        w.str(e.fromPort);
+        w.str(e.toPort);
+        w.pod(static_cast<std::uint8_t>(e.queue.enabled));
+        w.pod(static_cast<std::uint64_t>(e.queue.capacity));
+        w.pod(static_cast<std::int32_t>(e.queue.policy));
+        w.pod(static_cast<std::int64_t>(e.queue.blockTimeout.count()));
+        w.pod(static_cast<std::int32_t>(e.queue.backpressure));
+        w.pod(e.queue.skipFrames);
+        w.pod(e.queue.minSourceFps);
+    }
+
+    std::uint64_t checksum = fnv1a(w.buffer().data(), w.buffer().size());
+    w.pod(checksum);
+    return std::move(w.buffer());
+}
+
+bool FlowPlan::deserialize(const std::string& data, FlowPlan& out) {
+    constexpr std::size_t kChecksumSize = sizeof(std::uint64_t);
+    if (data.size() < sizeof(kMagic) + sizeof(kFormatVersion) + kChecksumSize ||
+        std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+    std::size_t body = data.size() - kChecksumSize;
+    std::uint64_t stored = 0;
+    std::memcpy(&stored, data.data() + body, kChecksumSize);
+    if (stored != fnv1a(data.data(), body)) {
+        return false;
+    }
+
+    Reader r(data.data() + sizeof(kMagic), body - sizeof(kMagic));
+    std::uint32_t format = 0;
+    if (!r.pod(format) || format != kFormatVersion) {
+        return false;
+    }
+
+    FlowPlan plan;
+    std::uint32_t count = 0;
+    if (!r.str(plan.flowId) || !r.str(plan.flowName) || !r.str(plan.version) || !r.pod(plan.latencyBudgetNs) ||
+        !r.pod(plan.memoryBudgetBytes) || !r.pod(plan.priority) || !r.pod(count)) {
+        return false;
+    }
+    plan.nodes.resize(count);
+    for (auto& n : plan.nodes) {
+        std::uint8_t valid = 0;
+        std::uint8_t hasArea = 0;
+        std::uint8_t hasParams = 0;
+        if (!r.str(n.nodeId) || !r.str(n.templateId) || !r.pod(valid) || !r.str(n.paramsError) ||
+            !r.str(n.parametersJson) || !r.pod(hasArea)) {
+            return false;
+        }
+        n.paramsValid = valid != 0;
+        auto& pp = n.planner;
+        pp.hasArea = hasArea != 0;
+        if (pp.hasArea) {
+            std::uint32_t points = 0;
+            if (!r.pod(points)) return false;
+            pp.area.polygon.resize(points);
+            for (auto& p : pp.area.polygon) {
+                if (!readGeoPoint(r, p)) return false;
+            }
+            if (!r.pod(pp.area.minAltitude) || !r.pod(pp.area.maxAltitude)) return false;
+        }
+        if (!r.pod(hasParams)) return false;
+        pp.hasParams = hasParams != 0;
+        if (pp.hasParams) {
+            std::int32_t pattern = 0;
+            std::uint8_t detection = 0;
+            std::uint32_t classes = 0;
+            if (!r.pod(pattern) || !r.pod(pp.params.altitude) || !r.pod(pp.params.speed) ||
+                !r.pod(pp.params.spacing) || !r.pod(pp.params.loiterTime) || !r.pod(detection) ||
+                !r.pod(classes)) {
+                return false;
+            }
+            pp.params.pattern = static_cast<mission::SearchPattern>(pattern);
+            pp.params.enableDetection = detection != 0;
+            pp.params.detectionClasses.resize(classes);
+            for (auto& c : pp.params.detectionClasses) {
+                if (!r.str(c)) return false;
+            }
+        }
+
+        std::uint32_t cpus = 0;
+        std::int32_t priority = 0;
+        if (!r.pod(cpus) || cpus > 4096) return false;
+        n.placement.cpus.resize(cpus);
+        for (auto& cpu : n.placement.cpus) {
+            std::int32_t v = 0;
+            if (!r.pod(v)) return false;
+            cpu = v;
+        }
+        std::uint8_t schedClass = 0;
+        std::int64_t deadlineUs = 0;
+        std::int64_t periodUs = 0;
+        if (!r.pod(priority) || !r.pod(n.placement.npuCoreMask) || !r.pod(schedClass) || !r.pod(deadlineUs) ||
+            !r.pod(periodUs) || schedClass > static_cast<std::uint8_t>(SchedClass::Critical)) {
+            return false;
+        }
+        n.placement.priority = priority;
+        n.placement.schedClass = static_cast<SchedClass>(schedClass);
+        n.placement.deadline = std::chrono::microseconds(deadlineUs);
+        n.placement.period = std::chrono::microseconds(periodUs);
+
+        std::int64_t stallMs = 0;
+        std::int64_t sloMs = 0;
+        std::uint32_t ladder = 0;
+        if (!r.pod(stallMs) || !r.pod(sloMs) || !r.pod(n.watchdog.violations) || !r.pod(ladder) || ladder > 64) {
+            return false;
+        }
+        n.watchdog.stallTimeout = std::chrono::milliseconds(stallMs);
+        n.watchdog.latencySlo = std::chrono::milliseconds(sloMs);
+        n.watchdog.ladder.resize(ladder);
+        for (auto& action : n.watchdog.ladder) {
+            std::uint8_t v = 0;
+            if (!r.pod(v) || v > static_cast<std::uint8_t>(WatchdogAction::LowerRate)) return false;
+            action = static_cast<WatchdogAction>(v);
+        }
+
+        std::uint8_t hasTyped = 0;
+        if (!r.pod(hasTyped)) return false;
+        n.hasTypedParams = hasTyped != 0;
+        if (n.hasTypedParams) {
+            std::uint32_t entries = 0;
+            if (!r.pod(entries) || entries > 4096) return false;
+            for (std::uint32_t i = 0; i < entries; ++i) {
+                if (!readParamEntry(r, n.typedParams)) return false;
+            }
+        }
+    }
+
+    if (!r.pod(count)) return false;
+    plan.edges.resize(count);
+    for (auto& e : plan.edges) {
+        std::uint8_t enabled = 0;
+        std::uint64_t capacity = 0;
+        std::int32_t policy = 0;
+        std::int64_t timeoutMs = 0;
+        std::int32_t backpressure = 0;
+        if (!r.pod(e.from) || !r.pod(e.to) || !r.str(e.edgeId) || !r.str(e.fromPort) || !r.str(e.toPort) ||
+            !r.pod(enabled) || !r.pod(capacity) || !r.pod(policy) || !r.pod(timeoutMs) ||
+            !r.pod(backpressure) || !r.pod(e.queue.skipFrames) || !r.pod(e.queue.minSourceFps)) {
+            return false;
+        }
+        e.queue.backpressure = static_cast<LinkBackpressure>(backpressure);
+        if (e.from >= plan.nodes.size() || e.to >= plan.nodes.size()) {
+            return false;
+        }
+        e.queue.enabled = enabled != 0;
+        e.queue.capacity = static_cast<std::size_t>(capacity);
+        e.queue.policy = static_cast<LinkQueuePolicy>(policy);
+        e.queue.blockTimeout = std::chrono::milliseconds(timeoutMs);
+    }
+    if (!r.done()) {
+        return false;
+    }
+    out = std::move(plan);
+    return true;
+}
+
+FlowPlanCache::FlowPlanCache(std::string directory)
+    : directory_(std::move(directory)) {}
+
+std::string FlowPlanCache::pathFor(const std::string& flowId, const std::string& version) const {
+    std::string dir = directory_;
+    if (!dir.empty() && dir.back() != '/') dir.push_back('/');
+    // 清洗后的名称可能冲突，附加原始 key 的哈希
+    std::string key = flowId + '\n' + version;
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(fnv1a(key.data(), key.size())));
+    return dir + sanitize(flowId) + "@" + sanitize(version) + "-" + std::string(hash, 8) + ".fmplan";
+}
+
+bool FlowPlanCache::load(const std::string& flowId, const std::string& version, FlowPlan& out) const {
+    std::ifstream file(pathFor(flowId, version), std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    FlowPlan plan;
+    if (!FlowPlan::deserialize(data, plan) || plan.flowId != flowId || plan.version != version) {
+        std::cerr << "FlowPlanCache: Ignoring invalid plan file: " << pathFor(flowId, version) << std::endl;
+        return false;
+    }
+    if (!plan.resolveCreators()) {
+        return false;
+    }
+    out = std::move(plan);
+    return true;
+}
+
+bool FlowPlanCache::store(const FlowPlan& plan) const {
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    std::string path = pathFor(plan.flowId, plan.version);
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "FlowPlanCache: Failed to open " << tmp << std::endl;
+            return false;
+        }
+        std::string data = plan.serialize();
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!file.good()) {
+            std::cerr << "FlowPlanCache: Failed to write " << tmp << std::endl;
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::cerr << "FlowPlanCache: Failed to rename " << tmp << " -> " << path << std::endl;
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,34 @@
+#include "falconmind/sdk/core/GateNode.h"
+#include "falconmind/sdk/core/Pad.h"
+
+namespace falconmind::sdk::core {
+
+GateNode::GateNode(bool open) : Node("gate"), open_(open), flowing_(open) {
+    outPad_ = addPad(std::make_shared<Pad>("out", PadType::Source));
+    auto* in = addPad(std::make_shared<Pad>("in", PadType::Sink));
+    in->setBufferCallback([this](const BufferRef& buffer) {
+        const bool open = open_.load(std::memory_order_acquire) && (!condition_ || condition_());
+        if (!open) {
+            blocked_.fetch_add(1, std::memory_order_relaxed);
+            if (flowing_.exchange(false, std::memory_order_acq_rel)) branchClosed(outPad_);
+            return;
+        }
+        flowing_.store(true, std::memory_order_release);
+        passed_.fetch_add(1, std::memory_order_relaxed);
+        outPad_->pushBuffer(buffer);
+    });
+}
+
+void GateNode::setOpen(bool open) {
+    open_.store(open, std::memory_order_release);
+    // 重新开启后由下一个放行的缓冲恢复 flowing_
+    if (!open && flowing_.exchange(false, std::memory_order_acq_rel)) branchClosed(outPad_);
+}
+
+bool GateNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    auto it = params.find("open");
+    if (it != params.end()) setOpen(it->second == "1" || it->second == "true" || it->second == "yes");
+    return true;
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,338 @@
+#include "falconmind/sdk/core/IntrospectionServer.h"
+#include "falconmind/sdk/core/Pipeline.h"
+#include "falconmind/sdk/core/PipelineMetrics.h"
+#include "falconmind/sdk/core/Trace.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef FALCONMINDSDK_HTTP_SERVER_ENABLED
+#include <httplib.h>
+#endif
+
+namespace falconmind::sdk::core {
+
+struct IntrospectionServer::Snapshot {
+    struct View {
+        std::string id;
+        std::string graphJson;
+        std::string graphDot;
+        std::string metricsJson;
+    };
+    std::vector<View> pipelines;
+    std::string pipelinesJson;
+    std::string memoryJson;
+};
+
+struct IntrospectionServer::Http {
+#ifdef FALCONMINDSDK_HTTP_SERVER_ENABLED
+    httplib::Server server;
+#endif
+};
+
+namespace {
+
+// 只影响调用线程（Linux 的 nice 值按线程生效，之后创建的线程继承）
+void lowerThreadPriority(int niceness) {
+#ifdef __linux__
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), niceness) != 0) {
+        std::cerr << "[IntrospectionServer] setpriority(" << niceness << ") failed" << std::endl;
+    }
+#else
+    (void)niceness;
+#endif
+}
+
+// /proc/self/status 中的 VmRSS / VmHWM（字节）；非 Linux 或读取失败为 0
+void readProcessMemory(std::uint64_t& rss, std::uint64_t& peak) {
+    rss = peak = 0;
+    std::ifstream in("/proc/self/status");
+    std::string line;
+    while (std::getline(in, line)) {
+        unsigned long long kb = 0;
+        if (std::sscanf(line.c_str(), "VmRSS: %llu kB", &kb) == 1) {
+            rss = kb * 1024;
+        } else if (std::sscanf(line.c_str(), "VmHWM: %llu kB", &kb) == 1) {
+            peak = kb * 1024;
+        }
+    }
+}
+
+std::string dotQuote(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+std::string formatFixed(double v, int decimals) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    return buf;
+}
+
+nlohmann::json graphJson(const PipelineMetrics& m) {
+    nlohmann::json nodes = nlohmann::json::array();
+    for (const auto& n : m.nodes) {
+        nodes.push_back({{"id", n.nodeId},
+                         {"process_count", n.processCount},
+                         {"p99_us", n.p99Us},
+                         {"queue_depth", n.queueDepth}});
+    }
+    nlohmann::json links = nlohmann::json::array();
+    for (const auto& l : m.links) {
+        links.push_back({{"src", l.srcNodeId + "." + l.srcPadName},
+                         {"dst", l.dstNodeId + "." + l.dstPadName},
+                         {"fps", l.framesPerSec},
+                         {"drops", l.drops},
+                         {"queue_depth", l.queueDepth}});
+    }
+    return {{"pipeline_id", m.pipelineId}, {"timestamp_ns", m.timestampNs}, {"nodes", nodes}, {"links", links}};
+}
+
+std::string graphDot(const PipelineMetrics& m) {
+    std::ostringstream os;
+    os << "digraph " << dotQuote(m.pipelineId) << " {\n  rankdir=LR;\n  node [shape=box];\n";
+    for (const auto& n : m.nodes) {
+        os << "  " << dotQuote(n.nodeId) << " [label=" << dotQuote(n.nodeId + "\\np99 " + formatFixed(n.p99Us / 1000.0, 2) +
+                                                                " ms, queue " + std::to_string(n.queueDepth))
+           << "];\n";
+    }
+    for (const auto& l : m.links) {
+        std::string label = l.srcPadName + " -> " + l.dstPadName + "\\n" + formatFixed(l.framesPerSec, 1) + " fps";
+        if (l.drops != 0) label += ", drops " + std::to_string(l.drops);
+        os << "  " << dotQuote(l.srcNodeId) << " -> " << dotQuote(l.dstNodeId) << " [label=" << dotQuote(label)
+           << (l.drops != 0 ? ", color=red" : "") << "];\n";
+    }
+    os << "}\n";
+    return os.str();
+}
+
+} // namespace
+
+IntrospectionServer::IntrospectionServer(IntrospectionServerConfig config)
+    : config_(std::move(config))
+    , snapshot_(std::make_shared<Snapshot>()) {}
+
+IntrospectionServer::~IntrospectionServer() {
+    stop();
+}
+
+bool IntrospectionServer::available() noexcept {
+#ifdef FALCONMINDSDK_HTTP_SERVER_ENABLED
+    return true;
+#else
+    return false;
+#endif
+}
+
+void IntrospectionServer::addPipeline(const std::shared_ptr<Pipeline>& pipeline) {
+    if (!pipeline) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(pipelinesMutex_);
+    removePipelineLocked(pipeline->id());
+    pipelines_.push_back(pipeline);
+}
+
+void IntrospectionServer::removePipeline(const std::string& pipelineId) {
+    std::lock_guard<std::mutex> lock(pipelinesMutex_);
+    removePipelineLocked(pipelineId);
+}
+
+void IntrospectionServer::removePipelineLocked(const std::string& pipelineId) {
+    pipelines_.erase(std::remove_if(pipelines_.begin(), pipelines_.end(),
+                                    [&](const std::weak_ptr<Pipeline>& weak) {
+                                        auto p = weak.lock();
+                                        return !p || p->id() == pipelineId;
+                                    }),
+                     pipelines_.end());
+}
+
+std::shared_ptr<const IntrospectionServer::Snapshot> IntrospectionServer::snapshot() const {
+    return std::atomic_load(&snapshot_);
+}
+
+void IntrospectionServer::sampleNow() {
+    std::lock_guard<std::mutex> sampleLock(sampleMutex_);
+    std::vector<std::shared_ptr<Pipeline>> live;
+    {
+        std::lock_guard<std::mutex> lock(pipelinesMutex_);
+        for (const auto& weak : pipelines_) {
+            if (auto p = weak.lock()) live.push_back(std::move(p));
+        }
+    }
+
+    auto next = std::make_shared<Snapshot>();
+    nlohmann::json list = nlohmann::json::array();
+    nlohmann::json memoryPipelines = nlohmann::json::array();
+    for (const auto& pipeline : live) {
+        const PipelineMetrics m = pipeline->metrics();
+        next->pipelines.push_back({m.pipelineId, graphJson(m).dump(), graphDot(m), toJson(m)});
+        list.push_back({{"id", m.pipelineId},
+                        {"nodes", m.nodes.size()},
+                        {"links", m.links.size()},
+                        {"timestamp_ns", m.timestampNs}});
+        nlohmann::json nodes = nlohmann::json::array();
+        for (const auto& n : m.nodes) {
+            if (n.hasMemory) {
+                nodes.push_back({{"id", n.nodeId},
+                                 {"bytes", n.memoryBytes},
+                                 {"peak_bytes", n.memoryPeakBytes},
+                                 {"estimate_bytes", n.memoryEstimateBytes}});
+            }
+        }
+        memoryPipelines.push_back({{"id", m.pipelineId},
+                                   {"budget_bytes", m.memoryBudgetBytes},
+                                   {"bytes", m.memoryBytes},
+                                   {"nodes", nodes}});
+    }
+    std::uint64_t rss = 0, peak = 0;
+    readProcessMemory(rss, peak);
+    next->pipelinesJson = nlohmann::json{{"pipelines", list}, {"samples", samples_.load() + 1}}.dump();
+    next->memoryJson =
+        nlohmann::json{{"rss_bytes", rss}, {"peak_rss_bytes", peak}, {"pipelines", memoryPipelines}}.dump();
+    std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(std::move(next)));
+    samples_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void IntrospectionServer::sampleLoop() {
+    lowerThreadPriority(config_.niceness);
+    const auto interval = std::chrono::milliseconds(std::max(config_.sampleIntervalMs, 10));
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    while (!wakeCv_.wait_for(lock, interval, [this]() { return !running_.load(); })) {
+        lock.unlock();
+        sampleNow();
+        lock.lock();
+    }
+}
+
+bool IntrospectionServer::start() {
+#ifdef FALCONMINDSDK_HTTP_SERVER_ENABLED
+    if (running_.exchange(true)) {
+        return false;
+    }
+    sampleNow();
+    http_ = std::make_unique<Http>();
+    httplib::Server& server = http_->server;
+    server.new_task_queue = []() { return new httplib::ThreadPool(1); };
+
+    auto json = [](httplib::Response& res, const std::string& body) {
+        res.set_content(body, "application/json");
+    };
+    auto notFound = [](httplib::Response& res) {
+        res.status = 404;
+        res.set_content(R"({"error":"unknown pipeline"})", "application/json");
+    };
+    auto findView = [this](const std::string& id, std::shared_ptr<const Snapshot>& snap) -> const Snapshot::View* {
+        snap = snapshot();
+        for (const auto& view : snap->pipelines) {
+            if (view.id == id) return &view;
+        }
+        return nullptr;
+    };
+
+    server.Get("/", [json](const httplib::Request&, httplib::Response& res) {
+        json(res, R"({"endpoints":["/pipelines","/pipelines/<id>/graph","/pipelines/<id>/graph?format=dot",)"
+                  R"("/pipelines/<id>/metrics","/memory","/trace","POST /trace/start","POST /trace/stop"]})");
+    });
+    server.Get("/pipelines", [this, json](const httplib::Request&, httplib::Response& res) {
+        json(res, snapshot()->pipelinesJson);
+    });
+    server.Get(R"(/pipelines/([^/]+)/graph)", [findView, json, notFound](const httplib::Request& req,
+                                                                          httplib::Response& res) {
+        std::shared_ptr<const Snapshot> snap;
+        const Snapshot::View* view = findView(req.matches[1], snap);
+        if (!view) return notFound(res);
+        if (req.get_param_value("format") == "dot") {
+            res.set_content(view->graphDot, "text/vnd.graphviz");
+        } else {
+            json(res, view->graphJson);
+        }
+    });
+    server.Get(R"(/pipelines/([^/]+)/metrics)", [findView, json, notFound](const httplib::Request& req,
+                                                                            httplib::Response& res) {
+        std::shared_ptr<const Snapshot> snap;
+        const Snapshot::View* view = findView(req.matches[1], snap);
+        if (!view) return notFound(res);
+        json(res, view->metricsJson);
+    });
+    server.Get("/memory", [this, json](const httplib::Request&, httplib::Response& res) {
+        json(res, snapshot()->memoryJson);
+    });
+    // trace 按请求在 HTTP 线程生成：只读各线程环形缓冲，不经过采样快照
+    server.Get("/trace", [json](const httplib::Request&, httplib::Response& res) {
+        json(res, Tracer::instance().toChromeTrace());
+    });
+    auto traceControl = [this, json](bool on) {
+        return [this, json, on](const httplib::Request&, httplib::Response& res) {
+            if (!config_.allowTraceControl) {
+                res.status = 403;
+                return json(res, R"({"error":"trace control disabled"})");
+            }
+            on ? Tracer::instance().start() : Tracer::instance().stop();
+            json(res, std::string(R"({"tracing":)") + (Tracer::enabled() ? "true" : "false") + "}");
+        };
+    };
+    server.Post("/trace/start", traceControl(true));
+    server.Post("/trace/stop", traceControl(false));
+
+    const int port = config_.port == 0 ? server.bind_to_any_port(config_.bindAddress)
+                                       : (server.bind_to_port(config_.bindAddress, config_.port) ? config_.port : -1);
+    if (port <= 0) {
+        std::cerr << "[IntrospectionServer] Failed to bind " << config_.bindAddress << ":" << config_.port << std::endl;
+        http_.reset();
+        running_.store(false);
+        return false;
+    }
+    boundPort_.store(port);
+    // 工作线程池在 listen 线程中创建，继承其 nice 值
+    httpThread_ = std::thread([this]() {
+        lowerThreadPriority(config_.niceness);
+        http_->server.listen_after_bind();
+    });
+    http_->server.wait_until_ready();  // 之后 stop() 才能中断 listen
+    sampleThread_ = std::thread(&IntrospectionServer::sampleLoop, this);
+    return true;
+#else
+    std::cerr << "[IntrospectionServer] Built without cpp-httplib (FALCONMINDSDK_WITH_HTTP=OFF)" << std::endl;
+    return false;
+#endif
+}
+
+void IntrospectionServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+#ifdef FALCONMINDSDK_HTTP_SERVER_ENABLED
+    http_->server.stop();
+#endif
+    if (httpThread_.joinable()) {
+        httpThread_.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+    }
+    wakeCv_.notify_all();
+    if (sampleThread_.joinable()) {
+        sampleThread_.join();
+    }
+    http_.reset();
+    boundPort_.store(0);
+}
+
+} // namespace falconmind::sdk::core
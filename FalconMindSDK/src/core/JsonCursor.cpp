@@ -0,0 +1,282 @@
+#include "falconmind/sdk/core/JsonCursor.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+bool isNumberChar(char c) {
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void appendUtf8(std::string& out, unsigned cp) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+} // namespace
+
+JsonCursor::JsonCursor(std::string_view text)
+    : begin_(text.data()), p_(text.data()), end_(text.data() + text.size()) {}
+
+bool JsonCursor::fail(const char* what) {
+    if (error_.empty()) {
+        error_ = std::string(what) + " at offset " + std::to_string(offset());
+    }
+    p_ = end_;
+    return false;
+}
+
+void JsonCursor::skipWhitespace() {
+    while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) ++p_;
+}
+
+bool JsonCursor::expect(char c) {
+    skipWhitespace();
+    if (p_ >= end_ || *p_ != c) {
+        const char msg[] = {'e', 'x', 'p', 'e', 'c', 't', 'e', 'd', ' ', '\'', c, '\'', '\0'};
+        return fail(msg);
+    }
+    ++p_;
+    return true;
+}
+
+char JsonCursor::peek() {
+    if (failed()) return '\0';
+    skipWhitespace();
+    return p_ < end_ ? *p_ : '\0';
+}
+
+bool JsonCursor::beginObject() {
+    if (!expect('{')) return false;
+    scopes_.push_back(Scope{'}', true});
+    return true;
+}
+
+bool JsonCursor::beginArray() {
+    if (!expect('[')) return false;
+    scopes_.push_back(Scope{']', true});
+    return true;
+}
+
+bool JsonCursor::nextField(std::string& key) {
+    if (failed() || scopes_.empty() || scopes_.back().closer != '}') return fail("not in an object");
+    skipWhitespace();
+    if (p_ < end_ && *p_ == '}') {
+        ++p_;
+        scopes_.pop_back();
+        return false;
+    }
+    if (!scopes_.back().first && !expect(',')) return false;
+    scopes_.back().first = false;
+    skipWhitespace();
+    return readString(key) && expect(':');
+}
+
+bool JsonCursor::nextElement() {
+    if (failed() || scopes_.empty() || scopes_.back().closer != ']') return fail("not in an array");
+    skipWhitespace();
+    if (p_ < end_ && *p_ == ']') {
+        ++p_;
+        scopes_.pop_back();
+        return false;
+    }
+    if (!scopes_.back().first && !expect(',')) return false;
+    scopes_.back().first = false;
+    return !failed();
+}
+
+bool JsonCursor::readString(std::string& out) {
+    if (!expect('"')) return false;
+    out.clear();
+    while (true) {
+        // 无转义的连续片段整体追加
+        const char* start = p_;
+        while (p_ < end_ && *p_ != '"' && *p_ != '\\') {
+            if (static_cast<unsigned char>(*p_) < 0x20) return fail("control character in string");
+            ++p_;
+        }
+        out.append(start, static_cast<std::size_t>(p_ - start));
+        if (p_ >= end_) return fail("unterminated string");
+        if (*p_ == '"') {
+            ++p_;
+            return true;
+        }
+        if (end_ - p_ < 2) return fail("unterminated escape");
+        const char e = p_[1];
+        p_ += 2;
+        switch (e) {
+            case '"': out.push_back('"'); break;
+            case '\\': out.push_back('\\'); break;
+            case '/': out.push_back('/'); break;
+            case 'b': out.push_back('\b'); break;
+            case 'f': out.push_back('\f'); break;
+            case 'n': out.push_back('\n'); break;
+            case 'r': out.push_back('\r'); break;
+            case 't': out.push_back('\t'); break;
+            case 'u': {
+                auto hex4 = [this](unsigned& v) {
+                    if (end_ - p_ < 4) return false;
+                    v = 0;
+                    for (int i = 0; i < 4; ++i) {
+                        const int h = hexValue(p_[i]);
+                        if (h < 0) return false;
+                        v = (v << 4) | static_cast<unsigned>(h);
+                    }
+                    p_ += 4;
+                    return true;
+                };
+                unsigned cp = 0;
+                if (!hex4(cp)) return fail("invalid \\u escape");
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    unsigned low = 0;
+                    if (end_ - p_ < 2 || p_[0] != '\\' || p_[1] != 'u') return fail("unpaired surrogate");
+                    p_ += 2;
+                    if (!hex4(low) || low < 0xDC00 || low > 0xDFFF) return fail("unpaired surrogate");
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                    return fail("unpaired surrogate");
+                }
+                appendUtf8(out, cp);
+                break;
+            }
+            default:
+                return fail("invalid escape");
+        }
+    }
+}
+
+bool JsonCursor::readNumber(double& out) {
+    skipWhitespace();
+    const char* start = p_;
+    if (!skipNumber()) return false;
+    // 映射的文件不以 '\0' 结尾：复制到本地缓冲再转换
+    char buf[64];
+    const std::size_t n = static_cast<std::size_t>(p_ - start);
+    if (n >= sizeof(buf)) return fail("number too long");
+    std::memcpy(buf, start, n);
+    buf[n] = '\0';
+    char* endp = nullptr;
+    out = std::strtod(buf, &endp);
+    if (endp != buf + n) return fail("invalid number");
+    return true;
+}
+
+bool JsonCursor::readBool(bool& out) {
+    const char c = peek();
+    if (c == 't' && skipLiteral("true", 4)) {
+        out = true;
+        return true;
+    }
+    if (c == 'f' && skipLiteral("false", 5)) {
+        out = false;
+        return true;
+    }
+    return fail("expected boolean");
+}
+
+bool JsonCursor::skipString() {
+    // p_ 指向起始引号
+    ++p_;
+    while (p_ < end_) {
+        const char* q = static_cast<const char*>(std::memchr(p_, '"', static_cast<std::size_t>(end_ - p_)));
+        if (!q) break;
+        // 引号前连续反斜杠为奇数个时是转义
+        const char* b = q;
+        while (b > p_ && b[-1] == '\\') --b;
+        p_ = q + 1;
+        if (((q - b) & 1) == 0) return true;
+    }
+    return fail("unterminated string");
+}
+
+bool JsonCursor::skipLiteral(const char* word, std::size_t length) {
+    if (static_cast<std::size_t>(end_ - p_) < length || std::memcmp(p_, word, length) != 0) {
+        return fail("invalid literal");
+    }
+    p_ += length;
+    return true;
+}
+
+bool JsonCursor::skipNumber() {
+    const char* start = p_;
+    while (p_ < end_ && isNumberChar(*p_)) ++p_;
+    if (p_ == start) return fail("expected value");
+    return true;
+}
+
+bool JsonCursor::skipValue() {
+    const char c = peek();
+    switch (c) {
+        case '"': return skipString();
+        case 't': return skipLiteral("true", 4);
+        case 'f': return skipLiteral("false", 5);
+        case 'n': return skipLiteral("null", 4);
+        case '{':
+        case '[': {
+            // 只跟踪括号配对：容器内部的逗号 / 冒号不逐一校验
+            std::string closers(1, c == '{' ? '}' : ']');
+            ++p_;
+            while (!closers.empty()) {
+                if (p_ >= end_) return fail("unterminated container");
+                const char ch = *p_;
+                if (ch == '"') {
+                    if (!skipString()) return false;
+                    continue;
+                }
+                if (ch == '{' || ch == '[') {
+                    closers.push_back(ch == '{' ? '}' : ']');
+                } else if (ch == '}' || ch == ']') {
+                    if (ch != closers.back()) return fail("mismatched bracket");
+                    closers.pop_back();
+                }
+                ++p_;
+            }
+            return true;
+        }
+        case '\0':
+            return failed() ? false : fail("unexpected end of input");
+        default:
+            return skipNumber();
+    }
+}
+
+bool JsonCursor::rawValue(std::string_view& out) {
+    skipWhitespace();
+    const char* start = p_;
+    if (!skipValue()) return false;
+    out = std::string_view(start, static_cast<std::size_t>(p_ - start));
+    return true;
+}
+
+bool JsonCursor::finish() {
+    if (failed()) return false;
+    if (!scopes_.empty()) return fail("unterminated container");
+    skipWhitespace();
+    if (p_ != end_) return fail("trailing characters");
+    return true;
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,374 @@
+#include "falconmind/sdk/core/Log.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+constexpr std::uint32_t kThreadRecords = 256;  // 每线程 64KB
+constexpr auto kIdleWait = std::chrono::milliseconds(20);
+
+std::int64_t wallNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+const char* severityName(LogSeverity severity) {
+    switch (severity) {
+        case LogSeverity::Debug: return "DEBUG";
+        case LogSeverity::Info: return "INFO ";
+        case LogSeverity::Warn: return "WARN ";
+        case LogSeverity::Error: return "ERROR";
+        case LogSeverity::Fatal: return "FATAL";
+    }
+    return "UNKNOWN";
+}
+
+// 行首 "[YYYY-mm-dd HH:MM:SS.mmm] [LEVEL] "；localtime_r 每秒只调用一次
+class LinePrefix {
+public:
+    void append(std::string& out, std::int64_t timestampNs, LogSeverity severity) {
+        const std::int64_t sec = timestampNs / 1000000000;
+        if (sec != cachedSec_) {
+            const std::time_t t = static_cast<std::time_t>(sec);
+            std::tm tm{};
+            localtime_r(&t, &tm);
+            cachedLen_ = std::strftime(cached_, sizeof(cached_), "%Y-%m-%d %H:%M:%S", &tm);
+            cachedSec_ = sec;
+        }
+        const int ms = static_cast<int>((timestampNs / 1000000) % 1000);
+        out += '[';
+        out.append(cached_, cachedLen_);
+        out += '.';
+        out += static_cast<char>('0' + ms / 100);
+        out += static_cast<char>('0' + ms / 10 % 10);
+        out += static_cast<char>('0' + ms % 10);
+        out += "] [";
+        out += severityName(severity);
+        out += "] ";
+    }
+
+private:
+    std::int64_t cachedSec_{-1};
+    char cached_[32] = {};
+    std::size_t cachedLen_{0};
+};
+
+} // namespace
+
+namespace logdetail {
+
+void appendFloat(std::string& out, double value) {
+    char buf[32];
+    const int n = std::snprintf(buf, sizeof(buf), "%g", value);
+    if (n > 0) out.append(buf, static_cast<std::size_t>(std::min<int>(n, sizeof(buf) - 1)));
+}
+
+} // namespace logdetail
+
+// 单生产者（所属线程）单消费者（写线程）环形缓冲
+struct AsyncLogger::ThreadBuffer {
+    alignas(64) std::atomic<std::uint32_t> head{0};
+    alignas(64) std::atomic<std::uint32_t> tail{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<bool> retired{false};  // 所属线程已退出，排空后由写线程回收
+    std::array<logdetail::Record, kThreadRecords> records;
+};
+
+struct AsyncLogger::State {
+    std::mutex registryMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCv;
+    std::condition_variable flushedCv;
+    bool wakeRequested{false};
+    std::uint64_t flushRequested{0};
+    std::uint64_t flushed{0};
+
+    std::mutex sinkMutex;  // 写线程与同步写出共用
+    Sink sink;
+    LinePrefix prefix;
+
+    std::atomic<bool> running{false};
+    std::atomic<bool> stopping{false};
+    std::atomic<std::uint64_t> written{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::thread writer;
+};
+
+namespace {
+
+// 线程局部状态均为平凡类型，线程析构顺序中任何时刻访问都安全
+struct ThreadSlot {
+    void* buffer{nullptr};
+    bool exited{false};
+};
+thread_local ThreadSlot tlsSlot;
+thread_local logdetail::Record tlsStage;  // 同步写出时的暂存槽位
+
+} // namespace
+
+AsyncLogger& AsyncLogger::instance() {
+    static AsyncLogger* logger = [] {
+        auto* created = new AsyncLogger();
+        std::atexit([] { AsyncLogger::instance().shutdown(); });
+        return created;
+    }();
+    return *logger;
+}
+
+AsyncLogger::AsyncLogger() : state_(std::make_unique<State>()) {
+    state_->running.store(true, std::memory_order_release);
+    state_->writer = std::thread([this] { run(); });
+}
+
+void AsyncLogger::setSink(Sink sink) {
+    std::lock_guard<std::mutex> lock(state_->sinkMutex);
+    state_->sink = std::move(sink);
+}
+
+void AsyncLogger::flush() {
+    State& s = *state_;
+    if (!s.running.load(std::memory_order_acquire) || std::this_thread::get_id() == s.writer.get_id()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(s.wakeMutex);
+    const std::uint64_t target = ++s.flushRequested;
+    s.wakeRequested = true;
+    s.wakeCv.notify_one();
+    s.flushedCv.wait(lock, [&] { return s.flushed >= target || !s.running.load(std::memory_order_acquire); });
+}
+
+void AsyncLogger::shutdown() {
+    State& s = *state_;
+    if (s.stopping.exchange(true)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(s.wakeMutex);
+        s.wakeRequested = true;
+    }
+    s.wakeCv.notify_one();
+    if (s.writer.joinable()) {
+        s.writer.join();
+    }
+}
+
+LogStats AsyncLogger::stats() const {
+    LogStats out;
+    out.written = state_->written.load(std::memory_order_relaxed);
+    out.dropped = state_->dropped.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(state_->registryMutex);
+    for (const auto& buffer : state_->buffers) {
+        out.dropped += buffer->dropped.load(std::memory_order_relaxed);  // 尚未汇总的部分
+    }
+    out.threads = state_->buffers.size();
+    return out;
+}
+
+logdetail::Record* AsyncLogger::acquire() noexcept {
+    State& s = *state_;
+    logdetail::Record* record = &tlsStage;
+    if (s.running.load(std::memory_order_acquire) && !tlsSlot.exited) {
+        auto* buffer = static_cast<ThreadBuffer*>(tlsSlot.buffer);
+        if (!buffer) {
+            // 首条日志：注册本线程缓冲，线程退出时标记 retired
+            try {
+                auto created = std::make_shared<ThreadBuffer>();
+                buffer = created.get();
+                {
+                    std::lock_guard<std::mutex> lock(s.registryMutex);
+                    s.buffers.push_back(std::move(created));
+                }
+                tlsSlot.buffer = buffer;
+                struct Retire {
+                    ~Retire() {
+                        if (auto* b = static_cast<ThreadBuffer*>(tlsSlot.buffer)) {
+                            b->retired.store(true, std::memory_order_release);
+                        }
+                        tlsSlot.buffer = nullptr;
+                        tlsSlot.exited = true;
+                    }
+                };
+                static thread_local Retire retire;
+                (void)retire;
+            } catch (...) {
+                return nullptr;
+            }
+        }
+        const std::uint32_t head = buffer->head.load(std::memory_order_relaxed);
+        if (head - buffer->tail.load(std::memory_order_acquire) >= kThreadRecords) {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        record = &buffer->records[head % kThreadRecords];
+    }
+    record->timestampNs = wallNowNs();
+    return record;
+}
+
+void AsyncLogger::commit(logdetail::Record* record) {
+    State& s = *state_;
+    if (record == &tlsStage) {
+        // 写线程已停止：在调用线程中格式化并写出
+        std::string line;
+        std::lock_guard<std::mutex> lock(s.sinkMutex);
+        s.prefix.append(line, record->timestampNs, record->severity);
+        record->format(record->args, line);
+        if (s.sink) {
+            s.sink(record->severity, line);
+        } else {
+            line += '\n';
+            std::FILE* out = record->severity >= LogSeverity::Error ? stderr : stdout;
+            std::fwrite(line.data(), 1, line.size(), out);
+            std::fflush(out);
+        }
+        s.written.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto* buffer = static_cast<ThreadBuffer*>(tlsSlot.buffer);
+    const std::uint32_t head = buffer->head.load(std::memory_order_relaxed) + 1;
+    buffer->head.store(head, std::memory_order_release);
+    const LogSeverity severity = record->severity;
+    if (severity == LogSeverity::Fatal) {
+        flush();
+    } else if (severity >= LogSeverity::Error ||
+               head - buffer->tail.load(std::memory_order_relaxed) == kThreadRecords / 2) {
+        // 不持锁通知：偶尔错过唤醒时写线程最多晚 kIdleWait 醒来
+        s.wakeCv.notify_one();
+    }
+}
+
+void AsyncLogger::run() {
+    State& s = *state_;
+    struct Pending {
+        std::int64_t timestampNs;
+        logdetail::Record* record;
+    };
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::vector<std::uint32_t> heads;
+    std::vector<Pending> batch;
+    std::string out;
+    std::string err;
+    std::string line;
+
+    for (;;) {
+        std::uint64_t flushTarget = 0;
+        bool stopping = false;
+        {
+            std::lock_guard<std::mutex> lock(s.wakeMutex);
+            flushTarget = s.flushRequested;
+            stopping = s.stopping.load(std::memory_order_acquire);
+            s.wakeRequested = false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(s.registryMutex);
+            buffers = s.buffers;
+        }
+        heads.resize(buffers.size());
+        batch.clear();
+        std::uint64_t dropped = 0;
+        for (std::size_t i = 0; i < buffers.size(); ++i) {
+            ThreadBuffer& buffer = *buffers[i];
+            const std::uint32_t tail = buffer.tail.load(std::memory_order_relaxed);
+            heads[i] = buffer.head.load(std::memory_order_acquire);
+            for (std::uint32_t seq = tail; seq != heads[i]; ++seq) {
+                logdetail::Record& record = buffer.records[seq % kThreadRecords];
+                batch.push_back({record.timestampNs, &record});
+            }
+            dropped += buffer.dropped.exchange(0, std::memory_order_relaxed);
+        }
+        // 各线程内已有序，稳定排序即得到按时间合并的输出
+        std::stable_sort(batch.begin(), batch.end(),
+                         [](const Pending& a, const Pending& b) { return a.timestampNs < b.timestampNs; });
+
+        if (!batch.empty() || dropped > 0) {
+            std::lock_guard<std::mutex> lock(s.sinkMutex);
+            out.clear();
+            err.clear();
+            for (const Pending& pending : batch) {
+                line.clear();
+                s.prefix.append(line, pending.timestampNs, pending.record->severity);
+                pending.record->format(pending.record->args, line);
+                if (s.sink) {
+                    s.sink(pending.record->severity, line);
+                } else {
+                    std::string& target = pending.record->severity >= LogSeverity::Error ? err : out;
+                    target += line;
+                    target += '\n';
+                }
+            }
+            if (dropped > 0) {
+                line.clear();
+                s.prefix.append(line, wallNowNs(), LogSeverity::Warn);
+                line += "[Log] dropped ";
+                logdetail::append(line, dropped);
+                line += " record(s): thread log buffer full";
+                if (s.sink) {
+                    s.sink(LogSeverity::Warn, line);
+                } else {
+                    out += line;
+                    out += '\n';
+                }
+            }
+            if (!out.empty()) {
+                std::fwrite(out.data(), 1, out.size(), stdout);
+                std::fflush(stdout);
+            }
+            if (!err.empty()) {
+                std::fwrite(err.data(), 1, err.size(), stderr);
+                std::fflush(stderr);
+            }
+            s.written.fetch_add(batch.size(), std::memory_order_relaxed);
+            s.dropped.fetch_add(dropped, std::memory_order_relaxed);
+        }
+
+        // 归还槽位；所属线程已退出且已排空的缓冲从注册表移除
+        bool anyRetired = false;
+        for (std::size_t i = 0; i < buffers.size(); ++i) {
+            buffers[i]->tail.store(heads[i], std::memory_order_release);
+            anyRetired = anyRetired || buffers[i]->retired.load(std::memory_order_acquire);
+        }
+        if (anyRetired) {
+            std::lock_guard<std::mutex> lock(s.registryMutex);
+            s.buffers.erase(std::remove_if(s.buffers.begin(), s.buffers.end(),
+                                           [](const std::shared_ptr<ThreadBuffer>& b) {
+                                               return b->retired.load(std::memory_order_acquire) &&
+                                                      b->head.load(std::memory_order_acquire) ==
+                                                          b->tail.load(std::memory_order_relaxed);
+                                           }),
+                            s.buffers.end());
+        }
+        buffers.clear();
+
+        std::unique_lock<std::mutex> lock(s.wakeMutex);
+        if (flushTarget > s.flushed) {
+            s.flushed = flushTarget;
+            s.flushedCv.notify_all();
+        }
+        if (stopping) {
+            s.running.store(false, std::memory_order_release);
+            s.flushedCv.notify_all();
+            return;
+        }
+        if (batch.empty() && !s.wakeRequested) {
+            s.wakeCv.wait_for(lock, kIdleWait);
+        }
+    }
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,74 @@
+#include "falconmind/sdk/core/MemoryBudget.h"
+
+#include <algorithm>
+
+namespace falconmind::sdk::core {
+
+void MemoryAccount::charge(std::size_t bytes) noexcept {
+    const std::int64_t now = bytes_.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed) +
+                             static_cast<std::int64_t>(bytes);
+    std::int64_t peak = peak_.load(std::memory_order_relaxed);
+    while (now > peak && !peak_.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryAccount::release(std::size_t bytes) noexcept {
+    bytes_.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+}
+
+std::size_t MemoryAccount::bytes() const noexcept {
+    return static_cast<std::size_t>(std::max<std::int64_t>(0, bytes_.load(std::memory_order_relaxed)));
+}
+
+std::size_t MemoryAccount::peakBytes() const noexcept {
+    return static_cast<std::size_t>(peak_.load(std::memory_order_relaxed));
+}
+
+const char* memoryDegradationName(MemoryDegradation step) noexcept {
+    switch (step) {
+        case MemoryDegradation::FewerInFlight: return "fewer_in_flight";
+        case MemoryDegradation::LowerResolution: return "lower_resolution";
+    }
+    return "unknown";
+}
+
+MemoryBudgetReport fitMemoryBudget(std::size_t budgetBytes,
+                                   const std::vector<std::pair<std::string, MemoryBudgetSink*>>& sinks) {
+    auto total = [&sinks]() {
+        std::size_t sum = 0;
+        for (const auto& [id, sink] : sinks) {
+            (void)id;
+            sum += sink->estimateMemoryBytes();
+        }
+        return sum;
+    };
+
+    MemoryBudgetReport report;
+    report.budgetBytes = budgetBytes;
+    report.requestedBytes = total();
+    report.plannedBytes = report.requestedBytes;
+    if (budgetBytes == 0) return report;
+
+    for (MemoryDegradation step : {MemoryDegradation::FewerInFlight, MemoryDegradation::LowerResolution}) {
+        bool progress = true;
+        while (report.plannedBytes > budgetBytes && progress) {
+            // 每轮从当前估算最大的节点开始，够用即停，尽量少降级
+            auto order = sinks;
+            std::stable_sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+                return a.second->estimateMemoryBytes() > b.second->estimateMemoryBytes();
+            });
+            progress = false;
+            for (const auto& [id, sink] : order) {
+                if (!sink->degradeMemory(step)) continue;
+                progress = true;
+                report.degradations.push_back(id + ": " + memoryDegradationName(step));
+                report.plannedBytes = total();
+                if (report.plannedBytes <= budgetBytes) break;
+            }
+        }
+    }
+    report.withinBudget = report.plannedBytes <= budgetBytes;
+    return report;
+}
+
+} // namespace falconmind::sdk::core
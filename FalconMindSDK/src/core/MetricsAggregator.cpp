@@ -0,0 +1,294 @@
+#include "falconmind/sdk/core/MetricsAggregator.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+// 汇总中的数值只保留 4 位有效数字：草图本身只有 α 精度，多余的位数只会增加上行字节
+double compact(double v) {
+    if (v == 0.0 || !std::isfinite(v)) {
+        return 0.0;
+    }
+    const double scale = std::pow(10.0, 3 - static_cast<int>(std::floor(std::log10(std::fabs(v)))));
+    return std::round(v * scale) / scale;
+}
+
+} // namespace
+
+QuantileSketch::QuantileSketch(double relativeAccuracy, std::size_t maxBins)
+    : relativeAccuracy_(std::clamp(relativeAccuracy, 1e-4, 0.5))
+    , gamma_((1.0 + relativeAccuracy_) / (1.0 - relativeAccuracy_))
+    , logGamma_(std::log(gamma_))
+    , maxBins_(std::max<std::size_t>(maxBins, 1)) {}
+
+std::size_t QuantileSketch::slotFor(std::int32_t index) {
+    if (bins_.empty()) {
+        minIndex_ = index;
+        bins_.assign(1, 0);
+        return 0;
+    }
+    const auto limit = static_cast<std::int32_t>(maxBins_);
+    const std::int32_t maxIndex = minIndex_ + static_cast<std::int32_t>(bins_.size()) - 1;
+    if (index < minIndex_) {
+        // 低端超出容量：并入允许的最低桶
+        index = std::max(index, maxIndex - limit + 1);
+        if (index < minIndex_) {
+            bins_.insert(bins_.begin(), static_cast<std::size_t>(minIndex_ - index), 0);
+            minIndex_ = index;
+        }
+    } else if (index > maxIndex) {
+        const std::int32_t newMin = std::max(minIndex_, index - limit + 1);
+        if (newMin > minIndex_) {
+            std::vector<std::uint64_t> next(static_cast<std::size_t>(index - newMin + 1), 0);
+            for (std::size_t k = 0; k < bins_.size(); ++k) {
+                const std::int32_t i = std::max(minIndex_ + static_cast<std::int32_t>(k), newMin);
+                next[static_cast<std::size_t>(i - newMin)] += bins_[k];
+            }
+            bins_.swap(next);
+            minIndex_ = newMin;
+        } else {
+            bins_.resize(static_cast<std::size_t>(index - minIndex_ + 1), 0);
+        }
+    }
+    return static_cast<std::size_t>(index - minIndex_);
+}
+
+double QuantileSketch::binValue(std::int32_t index) const noexcept {
+    return 2.0 * std::exp(static_cast<double>(index) * logGamma_) / (gamma_ + 1.0);
+}
+
+void QuantileSketch::add(double value) noexcept {
+    if (std::isnan(value)) {
+        return;
+    }
+    if (count_ == 0) {
+        min_ = max_ = value;
+    } else {
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+    ++count_;
+    sum_ += value;
+    if (value <= std::numeric_limits<double>::min()) {
+        ++zeroCount_;
+        return;
+    }
+    const auto index = static_cast<std::int32_t>(std::ceil(std::log(value) / logGamma_));
+    bins_[slotFor(index)] += 1;
+}
+
+bool QuantileSketch::merge(const QuantileSketch& other) {
+    if (std::fabs(other.gamma_ - gamma_) > 1e-12) {
+        return false;
+    }
+    if (other.count_ == 0) {
+        return true;
+    }
+    for (std::size_t k = 0; k < other.bins_.size(); ++k) {
+        if (other.bins_[k] != 0) {
+            bins_[slotFor(other.minIndex_ + static_cast<std::int32_t>(k))] += other.bins_[k];
+        }
+    }
+    min_ = count_ ? std::min(min_, other.min_) : other.min_;
+    max_ = count_ ? std::max(max_, other.max_) : other.max_;
+    count_ += other.count_;
+    zeroCount_ += other.zeroCount_;
+    sum_ += other.sum_;
+    return true;
+}
+
+double QuantileSketch::quantile(double q) const noexcept {
+    if (count_ == 0) {
+        return 0.0;
+    }
+    const double rank = std::clamp(q, 0.0, 1.0) * static_cast<double>(count_ - 1);
+    std::uint64_t seen = zeroCount_;
+    if (static_cast<double>(seen) > rank) {
+        return 0.0;
+    }
+    for (std::size_t k = 0; k < bins_.size(); ++k) {
+        seen += bins_[k];
+        if (static_cast<double>(seen) > rank) {
+            return std::clamp(binValue(minIndex_ + static_cast<std::int32_t>(k)), min_, max_);
+        }
+    }
+    return max_;
+}
+
+void QuantileSketch::clear() noexcept {
+    std::fill(bins_.begin(), bins_.end(), 0);
+    zeroCount_ = 0;
+    count_ = 0;
+    sum_ = 0.0;
+    min_ = max_ = 0.0;
+}
+
+void MetricsAggregator::Gauge::set(double value) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!setInWindow_) {
+        min_ = max_ = value;
+    } else {
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+    last_ = value;
+    everSet_ = true;
+    setInWindow_ = true;
+}
+
+double MetricsAggregator::Gauge::value() const noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_;
+}
+
+void MetricsAggregator::Summary::record(double value) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sketch_.add(value);
+}
+
+MetricsAggregator::MetricsAggregator(double relativeAccuracy, std::size_t maxBins)
+    : relativeAccuracy_(relativeAccuracy)
+    , maxBins_(maxBins)
+    , windowStartNs_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count()) {}
+
+MetricsAggregator::Counter& MetricsAggregator::counter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = counters_[name];
+    if (!slot) slot = std::make_unique<Counter>();
+    return *slot;
+}
+
+MetricsAggregator::Gauge& MetricsAggregator::gauge(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = gauges_[name];
+    if (!slot) slot = std::make_unique<Gauge>();
+    return *slot;
+}
+
+MetricsAggregator::Summary& MetricsAggregator::summary(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = summaries_[name];
+    if (!slot) slot = std::make_unique<Summary>(relativeAccuracy_, maxBins_);
+    return *slot;
+}
+
+MetricsRollup MetricsAggregator::rollup(std::int64_t nowNs, const MetricsRollupOptions& options) {
+    MetricsRollup out;
+    out.quantiles = options.quantiles;
+    std::lock_guard<std::mutex> lock(mutex_);
+    out.windowStartNs = windowStartNs_;
+    out.windowEndNs = nowNs;
+    windowStartNs_ = nowNs;
+
+    for (auto& [name, counter] : counters_) {
+        const std::uint64_t total = counter->total();
+        const std::uint64_t delta = total - counter->reported_;
+        counter->reported_ = total;
+        if (delta != 0 || !options.skipIdle) {
+            out.counters.push_back({name, delta});
+        }
+    }
+    for (auto& [name, gauge] : gauges_) {
+        std::lock_guard<std::mutex> gaugeLock(gauge->mutex_);
+        const bool active = gauge->setInWindow_;
+        gauge->setInWindow_ = false;
+        if (!gauge->everSet_ || (!active && options.skipIdle)) {
+            continue;
+        }
+        MetricsRollup::GaugeValue value{name, gauge->last_, gauge->last_, gauge->last_};
+        if (active) {
+            value.min = gauge->min_;
+            value.max = gauge->max_;
+        }
+        out.gauges.push_back(value);
+    }
+    for (auto& [name, summary] : summaries_) {
+        std::lock_guard<std::mutex> summaryLock(summary->mutex_);
+        const QuantileSketch& sketch = summary->sketch_;
+        if (sketch.empty() && options.skipIdle) {
+            continue;
+        }
+        MetricsRollup::SummaryValue value;
+        value.name = name;
+        value.count = sketch.count();
+        value.sum = sketch.sum();
+        value.min = sketch.min();
+        value.max = sketch.max();
+        value.values.reserve(options.quantiles.size());
+        for (double q : options.quantiles) {
+            value.values.push_back(sketch.quantile(q));
+        }
+        if (options.includeSketches) {
+            // 去掉两端的空桶
+            const auto& bins = sketch.bins();
+            std::size_t first = 0, last = bins.size();
+            while (first < last && bins[first] == 0) ++first;
+            while (last > first && bins[last - 1] == 0) --last;
+            value.sketchZeroCount = sketch.zeroCount();
+            value.sketchMinIndex = sketch.minIndex() + static_cast<std::int32_t>(first);
+            value.sketchBins.assign(bins.begin() + static_cast<std::ptrdiff_t>(first),
+                                    bins.begin() + static_cast<std::ptrdiff_t>(last));
+            out.relativeAccuracy = sketch.relativeAccuracy();
+        }
+        out.summaries.push_back(std::move(value));
+        summary->sketch_.clear();
+    }
+    return out;
+}
+
+MetricsAggregator& MetricsAggregator::instance() {
+    static MetricsAggregator inst;
+    return inst;
+}
+
+std::string toJson(const MetricsRollup& rollup, const std::string& uavId) {
+    nlohmann::json j;
+    j["type"] = "metrics_rollup";
+    j["uavId"] = uavId;
+    j["t0"] = rollup.windowStartNs;
+    j["t1"] = rollup.windowEndNs;
+    j["q"] = rollup.quantiles;
+    nlohmann::json counters = nlohmann::json::object();
+    for (const auto& c : rollup.counters) {
+        counters[c.name] = c.delta;
+    }
+    nlohmann::json gauges = nlohmann::json::object();
+    for (const auto& g : rollup.gauges) {
+        gauges[g.name] = {compact(g.last), compact(g.min), compact(g.max)};
+    }
+    nlohmann::json summaries = nlohmann::json::object();
+    nlohmann::json sketches = nlohmann::json::object();
+    for (const auto& s : rollup.summaries) {
+        nlohmann::json v = {s.count, compact(s.sum), compact(s.min), compact(s.max)};
+        for (double q : s.values) {
+            v.push_back(compact(q));
+        }
+        summaries[s.name] = std::move(v);
+        if (!s.sketchBins.empty() || s.sketchZeroCount != 0) {
+            nlohmann::json k = {s.sketchZeroCount, s.sketchMinIndex};
+            for (std::uint64_t b : s.sketchBins) {
+                k.push_back(b);
+            }
+            sketches[s.name] = std::move(k);
+        }
+    }
+    j["c"] = std::move(counters);
+    j["g"] = std::move(gauges);
+    j["s"] = std::move(summaries);
+    if (!sketches.empty()) {
+        j["a"] = rollup.relativeAccuracy;
+        j["k"] = std::move(sketches);
+    }
+    return j.dump();
+}
+
+} // namespace falconmind::sdk::core
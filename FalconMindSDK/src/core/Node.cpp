@@ -1,4 +1,5 @@
 #include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/NodeParams.h"
 #include "falconmind/sdk/core/Pad.h"
 
 namespace falconmind::sdk::core {
@@ -13,6 +14,10 @@ bool Node::configure(const std::unordered_map<std::string, std::string>&) {
     return true;
 }
 
+bool Node::applyParams(const NodeParams& params) {
+    return configure(params.toStringMap());
+}
+
 bool Node::start() {
     // Week1 skeleton: 默认成功
     return true;
@@ -22,6 +27,14 @@ void Node::stop() {
     // Week1 skeleton: 默认无动作
 }
 
+void Node::pause() {
+    // 默认无动作：资源保持，调度器不再调用 process()
+}
+
+void Node::resume() {
+    // 默认无动作
+}
+
 void Node::process() {
     // Week1 skeleton: 由具体节点实现
 }
@@ -34,9 +47,19 @@ std::shared_ptr<Pad> Node::getPad(const std::string& name) {
     return nullptr;
 }
 
-void Node::addPad(const std::shared_ptr<Pad>& pad) {
-    if (!pad) return;
-    pads_.emplace(pad->name(), pad);
+Node::PadIndex Node::padIndex(const std::string& name) const {
+    auto it = padIndices_.find(name);
+    return it != padIndices_.end() ? it->second : kInvalidPadIndex;
+}
+
+Pad* Node::addPad(const std::shared_ptr<Pad>& pad) {
+    if (!pad) return nullptr;
+    auto [it, inserted] = pads_.emplace(pad->name(), pad);
+    if (inserted) {
+        padIndices_.emplace(pad->name(), static_cast<PadIndex>(padList_.size()));
+        padList_.push_back(pad);
+    }
+    return it->second.get();
 }
 
 } // namespace falconmind::sdk::core
@@ -1,76 +1,127 @@
 #include "falconmind/sdk/core/NodeFactory.h"
+#include "falconmind/sdk/core/CaptureFile.h"
+#include "falconmind/sdk/core/GateNode.h"
+#include "falconmind/sdk/core/SelectorNode.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/NodeParams.h"
+#include "falconmind/sdk/core/ShmTransport.h"
 #include "falconmind/sdk/mission/SearchPathPlannerNode.h"
 #include "falconmind/sdk/mission/EventReporterNode.h"
+#include "falconmind/sdk/mission/BlackboardSinkNode.h"
+#include "falconmind/sdk/mission/GeofenceMonitorNode.h"
 #include "falconmind/sdk/flight/FlightNodes.h"
 #include "falconmind/sdk/flight/FlightConnectionService.h"
 #include "falconmind/sdk/sensors/CameraSourceNode.h"
+#include "falconmind/sdk/sensors/MultiCameraSourceNode.h"
+#include "falconmind/sdk/sensors/PointCloudFilterNode.h"
+#include "falconmind/sdk/sensors/ImageTransformNode.h"
+#include "falconmind/sdk/sensors/VideoUplinkNode.h"
 #include "falconmind/sdk/sensors/VideoSourceConfig.h"
-#include "falconmind/sdk/perception/DummyDetectionNode.h"
+#include "falconmind/sdk/perception/DetectionNode.h"
 #include "falconmind/sdk/perception/TrackingTransformNode.h"
 #include "falconmind/sdk/perception/EnvironmentDetectionNode.h"
 #include "falconmind/sdk/perception/LowLightAdaptationNode.h"
+#include "falconmind/sdk/perception/DualSpectrumFusionNode.h"
+#include "falconmind/sdk/perception/FiducialDetectionNode.h"
+#include "falconmind/sdk/perception/StereoDepthNode.h"
 #include "falconmind/sdk/perception/VisualSlamNode.h"
 #include "falconmind/sdk/perception/LidarSlamNode.h"
 #include "falconmind/sdk/cluster/ClusterStateSourceNode.h"
+#include "falconmind/sdk/planning/ObstacleCloudNode.h"
+#include "falconmind/sdk/telemetry/LocalTelemetryChannel.h"
 
-#include <iostream>
 #include <memory>
 #include <mutex>
 #include <atomic>
 
+// 内置节点裁剪（CMake FALCONMINDSDK_NODE_TYPES 为类型列表时定义 FALCONMIND_NODE_TYPES_SELECTED）：
+// 只注册定义了 FALCONMIND_NODE_TYPE_<ID> 的类型，未注册类型的实现不再被引用，静态链接时不进入可执行文件
+#ifdef FALCONMIND_NODE_TYPES_SELECTED
+#define FALCONMIND_WITH_NODE_TYPE(flag) (flag + 0)
+#else
+#define FALCONMIND_WITH_NODE_TYPE(flag) 1
+#endif
+
 namespace falconmind::sdk::core {
 
-// 静态成员变量定义
-std::unordered_map<std::string, NodeFactory::NodeCreator> NodeFactory::creators_;
+// 静态成员变量定义（均为常量初始化，不依赖编译单元间的动态初始化顺序）
+std::atomic<const NodeFactory::Registry*> NodeFactory::registry_{nullptr};
+std::mutex NodeFactory::write_mutex_;
 std::mutex NodeFactory::init_mutex_;
 std::atomic<bool> NodeFactory::initialized_{false};
 
+const NodeFactory::Registry* NodeFactory::snapshot() noexcept {
+    return registry_.load(std::memory_order_acquire);
+}
+
+void NodeFactory::publish(const Registry& additions, bool overwrite) {
+    // 被替换的旧快照：读端可能仍在使用，保留到进程退出（注册次数有限）
+    static std::vector<std::unique_ptr<const Registry>> retired;
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    const Registry* current = registry_.load(std::memory_order_relaxed);
+    auto next = current ? std::make_unique<Registry>(*current) : std::make_unique<Registry>();
+    next->reserve(next->size() + additions.size());
+    for (const auto& entry : additions) {
+        if (overwrite) {
+            (*next)[entry.first] = entry.second;
+        } else {
+            next->emplace(entry.first, entry.second);
+        }
+    }
+    registry_.store(next.release(), std::memory_order_release);
+    if (current) {
+        retired.emplace_back(current);
+    }
+}
+
+void NodeFactory::ensureInitialized() {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        initializeDefaultTypes();
+    }
+}
+
 void NodeFactory::registerNodeType(const std::string& template_id, NodeCreator creator) {
-    creators_[template_id] = creator;
+    publish(Registry{{template_id, std::move(creator)}}, true);
 }
 
 std::shared_ptr<Node> NodeFactory::createNode(const std::string& template_id,
                                               const std::string& node_id,
                                               const void* params) {
-    // 阶段4优化：确保已初始化（线程安全）
-    if (!initialized_.load(std::memory_order_acquire)) {
-        std::lock_guard<std::mutex> lock(init_mutex_);
-        if (!initialized_.load(std::memory_order_relaxed)) {
-            initializeDefaultTypes();
-            initialized_.store(true, std::memory_order_release);
-        }
-    }
-    
-    // 阶段4优化：使用find而不是count，减少一次查找
-    // unordered_map::find是O(1)，已经很快
-    // 阶段4优化：可以考虑使用string_view减少字符串拷贝（C++17）
-    // 但当前性能已经很好，暂时不引入C++17依赖
-    auto it = creators_.find(template_id);
-    if (it == creators_.end()) {
-        std::cerr << "NodeFactory: Unknown template_id: " << template_id << std::endl;
+    ensureInitialized();
+    const Registry* registry = snapshot();
+    auto it = registry->find(template_id);
+    if (it == registry->end()) {
+        FM_LOG_ERROR("NodeFactory", "Unknown template_id: ", template_id);
         return nullptr;
     }
     
     try {
-        // 直接调用创建函数，避免额外的查找
-        // 阶段4优化：对于频繁创建的同类型节点，可以考虑缓存创建函数指针
-        // 但当前性能已经很好（0.001ms/节点），暂时不需要进一步优化
         return it->second(node_id, params);
     } catch (const std::exception& e) {
-        std::cerr << "NodeFactory: Failed to create node " << template_id 
-                  << ": " << e.what() << std::endl;
+        FM_LOG_ERROR("NodeFactory", "Failed to create node ", template_id, ": ", e.what());
         return nullptr;
     }
 }
 
+NodeFactory::NodeCreator NodeFactory::findCreator(const std::string& template_id) {
+    ensureInitialized();
+    const Registry* registry = snapshot();
+    auto it = registry->find(template_id);
+    return it != registry->end() ? it->second : NodeCreator{};
+}
+
 bool NodeFactory::isRegistered(const std::string& template_id) {
-    return creators_.find(template_id) != creators_.end();
+    ensureInitialized();
+    const Registry* registry = snapshot();
+    return registry->find(template_id) != registry->end();
 }
 
 std::vector<std::string> NodeFactory::getRegisteredTypes() {
+    ensureInitialized();
+    const Registry* registry = snapshot();
     std::vector<std::string> types;
-    types.reserve(creators_.size());
-    for (const auto& pair : creators_) {
+    types.reserve(registry->size());
+    for (const auto& pair : *registry) {
         types.push_back(pair.first);
     }
     return types;
@@ -89,46 +140,94 @@ void NodeFactory::initializeDefaultTypes() {
         return;
     }
     
-    // 阶段4优化：预分配空间，减少重新分配
-    creators_.reserve(16);
+    // 默认类型先收集到一个快照中一次发布
+    Registry defaults;
+    [[maybe_unused]] auto registerDefault = [&defaults](const std::string& template_id, NodeCreator creator) {
+        defaults.emplace(template_id, std::move(creator));
+    };
     
     // 注册搜索路径规划节点
-    registerNodeType("search_path_planner", 
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_SEARCH_PATH_PLANNER)
+    registerDefault("search_path_planner", 
         [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
             auto node = std::make_shared<mission::SearchPathPlannerNode>();
             node->setId(node_id);
             return node;
         });
+#endif
     
     // 注册事件上报节点
-    registerNodeType("event_reporter",
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_EVENT_REPORTER)
+    registerDefault("event_reporter",
         [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
             auto node = std::make_shared<mission::EventReporterNode>();
             node->setId(node_id);
             return node;
         });
+#endif
+    
+    // 注册黑板写入节点（行为树经 blackboard() 取得其黑板）
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_BLACKBOARD_SINK)
+    registerDefault("blackboard_sink",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<mission::BlackboardSinkNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_GEOFENCE_MONITOR)
+    registerDefault("geofence_monitor",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<mission::GeofenceMonitorNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_OBSTACLE_CLOUD)
+    registerDefault("obstacle_cloud",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<planning::ObstacleCloudNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
     
     // 注册飞行状态源节点（需要FlightConnectionService）
     // 注意：这里创建一个默认的FlightConnectionService，实际使用时应该通过依赖注入提供
-    registerNodeType("flight_state_source",
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_FLIGHT_STATE_SOURCE)
+    registerDefault("flight_state_source",
         [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
             static std::shared_ptr<flight::FlightConnectionService> default_flight_service = 
                 std::make_shared<flight::FlightConnectionService>();
             return std::make_shared<flight::FlightStateSourceNode>(*default_flight_service);
         });
+#endif
     
     // 注册飞行命令接收节点（需要FlightConnectionService）
     // 注意：这里创建一个默认的FlightConnectionService，实际使用时应该通过依赖注入提供
-    registerNodeType("flight_command_sink",
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_FLIGHT_COMMAND_SINK)
+    registerDefault("flight_command_sink",
         [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
             static std::shared_ptr<flight::FlightConnectionService> default_flight_service = 
                 std::make_shared<flight::FlightConnectionService>();
             return std::make_shared<flight::FlightCommandSinkNode>(*default_flight_service);
         });
+#endif
+
+    // 注册本机遥测广播节点（共享内存通道，供同机云台控制 / OSD / 载荷计算机读取）
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_LOCAL_TELEMETRY)
+    registerDefault("local_telemetry",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<telemetry::LocalTelemetryNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
     
     // 注册相机源节点（需要VideoSourceConfig）
     // 注意：这里创建一个默认的VideoSourceConfig，实际使用时应该通过参数配置提供
-    registerNodeType("camera_source",
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_CAMERA_SOURCE)
+    registerDefault("camera_source",
         [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
             static sensors::VideoSourceConfig default_config;
             default_config.sensorId = "default_camera";
@@ -137,65 +236,224 @@ void NodeFactory::initializeDefaultTypes() {
             node->setId(node_id);
             return node;
         });
+#endif
+
+    // 注册多相机同步采集节点（设备列表通过 configure 参数 devices 指定）
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_MULTI_CAMERA_SOURCE)
+    registerDefault("multi_camera_source",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<sensors::MultiCameraSourceNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
+
+    // 注册点云预处理节点（体素/裁剪/地面去除参数通过 configure 指定）
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_POINTCLOUD_FILTER)
+    registerDefault("pointcloud_filter",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<sensors::PointCloudFilterNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
+
+    // 注册 2D 图像变换节点（裁剪/旋转/缩放/颜色转换，后端通过 configure 参数 backend 指定）
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_IMAGE_TRANSFORM)
+    registerDefault("image_transform",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<sensors::ImageTransformNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
 
-    // 注册检测节点
-    registerNodeType("dummy_detection",
+    // 注册视频下传节点（硬件编码 + RTP/SRT，检测框写入 SEI；需以 FALCONMINDSDK_BUILD_VIDEO_UPLINK 编译）
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_VIDEO_UPLINK)
+    registerDefault("video_uplink",
         [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
-            auto node = std::make_shared<perception::DummyDetectionNode>();
+            auto node = std::make_shared<sensors::VideoUplinkNode>();
             node->setId(node_id);
             return node;
         });
+#endif
+
+    // 注册检测节点（流水线 DetectionNode；dummy_detection 为旧 Flow 保留的别名，未注入 backend 时同样输出空结果）
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_DETECTION) || FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_DUMMY_DETECTION)
+    for (const char* key : {"detection", "dummy_detection"}) {
+        registerDefault(key,
+            [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+                auto node = std::make_shared<perception::DetectionNode>();
+                node->setId(node_id);
+                return node;
+            });
+    }
+#endif
     
     // 注册跟踪节点
-    registerNodeType("tracking_transform",
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_TRACKING_TRANSFORM)
+    registerDefault("tracking_transform",
         [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
             auto node = std::make_shared<perception::TrackingTransformNode>();
             node->setId(node_id);
             return node;
         });
+#endif
 
     // 注册环境检测节点
-    registerNodeType("environment_detection",
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_ENVIRONMENT_DETECTION)
+    registerDefault("environment_detection",
         [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
             auto node = std::make_shared<perception::EnvironmentDetectionNode>();
             node->setId(node_id);
             return node;
         });
+#endif
 
     // 注册低照度/相机切换节点
-    registerNodeType("low_light_adaptation",
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_LOW_LIGHT_ADAPTATION)
+    registerDefault("low_light_adaptation",
         [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
             auto node = std::make_shared<perception::LowLightAdaptationNode>();
             node->setId(node_id);
             return node;
         });
+#endif
+
+    // 注册双光谱（可见光 + 热红外）融合节点
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_DUAL_SPECTRUM_FUSION)
+    registerDefault("dual_spectrum_fusion",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<perception::DualSpectrumFusionNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
+
+    // 注册精准降落标记检测节点
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_FIDUCIAL_DETECTION)
+    registerDefault("fiducial_detection",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<perception::FiducialDetectionNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
+
+    // 注册双目 SGM 深度节点
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_STEREO_DEPTH)
+    registerDefault("stereo_depth",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<perception::StereoDepthNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
 
     // 注册视觉 SLAM 节点
-    registerNodeType("visual_slam",
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_VISUAL_SLAM)
+    registerDefault("visual_slam",
         [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
             auto node = std::make_shared<perception::VisualSlamNode>();
             node->setId(node_id);
             return node;
         });
+#endif
 
     // 注册激光 SLAM 节点
-    registerNodeType("lidar_slam",
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_LIDAR_SLAM)
+    registerDefault("lidar_slam",
         [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
             auto node = std::make_shared<perception::LidarSlamNode>();
             node->setId(node_id);
             return node;
         });
+#endif
 
     // 注册集群状态源节点（PRD 3.1.2.2 集群与协同模块）
-    registerNodeType("cluster_state_source",
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_CLUSTER_STATE_SOURCE)
+    registerDefault("cluster_state_source",
         [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
             auto node = std::make_shared<cluster::ClusterStateSourceNode>();
             node->setId(node_id);
             return node;
         });
+#endif
+
+    // 注册数据流开关节点（按环境状态等条件启停下游分支）
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_GATE)
+    registerDefault("gate",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<GateNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_SELECTOR)
+    registerDefault("selector",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<SelectorNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
+
+    // 注册跨进程共享内存收发节点（通道名等通过 configure 参数 channel 指定）
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_SHM_SINK)
+    registerDefault("shm_sink",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<ShmSinkNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
+
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_SHM_SOURCE)
+    registerDefault("shm_source",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<ShmSourceNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
+
+    // 注册录制/回放节点（文件路径通过 configure 参数 path 指定）
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_CAPTURE_RECORDER)
+    registerDefault("capture_recorder",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<CaptureRecorderNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
+
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_REPLAY_SOURCE)
+    registerDefault("replay_source",
+        [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+            auto node = std::make_shared<ReplaySourceNode>();
+            node->setId(node_id);
+            return node;
+        });
+#endif
+
+    publish(defaults, false);
+
+    // 参数 Schema：Flow 编译时据此校验并预解析 parameters（已由插件注册的不覆盖）
+    [[maybe_unused]] auto registerSchema = [](const std::string& template_id, const ParamSchema& schema) {
+        if (!NodeParamRegistry::find(template_id)) {
+            NodeParamRegistry::registerSchema(template_id,
+                                              std::shared_ptr<const ParamSchema>(&schema, [](const ParamSchema*) {}));
+        }
+    };
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_CAMERA_SOURCE)
+    registerSchema("camera_source", sensors::CameraSourceNode::paramSchema());
+#endif
+#if FALCONMIND_WITH_NODE_TYPE(FALCONMIND_NODE_TYPE_ENVIRONMENT_DETECTION)
+    registerSchema("environment_detection", perception::EnvironmentDetectionNode::paramSchema());
+#endif
 
     initialized_.store(true, std::memory_order_release);
-    std::cout << "NodeFactory: Initialized " << creators_.size() << " node types" << std::endl;
+    FM_LOG_INFO("NodeFactory", "Initialized ", snapshot()->size(), " node types");
 }
 
 } // namespace falconmind::sdk::core
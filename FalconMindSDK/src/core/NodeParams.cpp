@@ -0,0 +1,391 @@
+#include "falconmind/sdk/core/NodeParams.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <sstream>
+
+namespace falconmind::sdk::core {
+
+using json = nlohmann::json;
+
+const char* paramTypeName(ParamType type) noexcept {
+    switch (type) {
+        case ParamType::Bool: return "bool";
+        case ParamType::Int: return "int";
+        case ParamType::Double: return "double";
+        case ParamType::String: return "string";
+    }
+    return "unknown";
+}
+
+// ---- NodeParams ----
+
+const NodeParams::Entry* NodeParams::find(const std::string& name) const {
+    for (const auto& e : entries_) {
+        if (e.name == name) return &e;
+    }
+    return nullptr;
+}
+
+bool NodeParams::has(const std::string& name) const {
+    const Entry* e = find(name);
+    return e && e->explicitlySet;
+}
+
+bool NodeParams::getBool(const std::string& name, bool fallback) const {
+    const Entry* e = find(name);
+    const bool* v = e ? std::get_if<bool>(&e->value) : nullptr;
+    return v ? *v : fallback;
+}
+
+std::int64_t NodeParams::getInt(const std::string& name, std::int64_t fallback) const {
+    const Entry* e = find(name);
+    const std::int64_t* v = e ? std::get_if<std::int64_t>(&e->value) : nullptr;
+    return v ? *v : fallback;
+}
+
+double NodeParams::getDouble(const std::string& name, double fallback) const {
+    const Entry* e = find(name);
+    if (!e) return fallback;
+    if (const auto* d = std::get_if<double>(&e->value)) return *d;
+    if (const auto* i = std::get_if<std::int64_t>(&e->value)) return static_cast<double>(*i);
+    return fallback;
+}
+
+std::string NodeParams::getString(const std::string& name, const std::string& fallback) const {
+    const Entry* e = find(name);
+    const std::string* v = e ? std::get_if<std::string>(&e->value) : nullptr;
+    return v ? *v : fallback;
+}
+
+void NodeParams::set(const std::string& name, ParamValue value, bool explicitlySet) {
+    for (auto& e : entries_) {
+        if (e.name == name) {
+            e.value = std::move(value);
+            e.explicitlySet = explicitlySet;
+            return;
+        }
+    }
+    entries_.push_back(Entry{name, std::move(value), explicitlySet});
+}
+
+std::unordered_map<std::string, std::string> NodeParams::toStringMap() const {
+    std::unordered_map<std::string, std::string> out;
+    for (const auto& e : entries_) {
+        if (!e.explicitlySet) continue;
+        std::string text;
+        if (const auto* b = std::get_if<bool>(&e.value)) {
+            text = *b ? "true" : "false";
+        } else if (const auto* i = std::get_if<std::int64_t>(&e.value)) {
+            text = std::to_string(*i);
+        } else if (const auto* d = std::get_if<double>(&e.value)) {
+            std::ostringstream os;
+            os.precision(17);
+            os << *d;
+            text = os.str();
+        } else {
+            text = std::get<std::string>(e.value);
+        }
+        out.emplace(e.name, std::move(text));
+    }
+    return out;
+}
+
+// ---- ParamSchema ----
+
+namespace {
+
+bool parseBoolText(const std::string& text, bool& out) {
+    if (text == "true" || text == "1") { out = true; return true; }
+    if (text == "false" || text == "0") { out = false; return true; }
+    return false;
+}
+
+// 整个字符串须为一个数值（拒绝 "12abc"）
+bool parseIntText(const std::string& text, std::int64_t& out) {
+    try {
+        std::size_t pos = 0;
+        out = std::stoll(text, &pos);
+        return pos == text.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool parseDoubleText(const std::string& text, double& out) {
+    try {
+        std::size_t pos = 0;
+        out = std::stod(text, &pos);
+        return pos == text.size() && std::isfinite(out);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool checkValue(const ParamSpec& spec, const ParamValue& value, std::string& error) {
+    if (spec.hasRange) {
+        double v = 0.0;
+        if (const auto* i = std::get_if<std::int64_t>(&value)) v = static_cast<double>(*i);
+        else if (const auto* d = std::get_if<double>(&value)) v = *d;
+        if (v < spec.min || v > spec.max) {
+            std::ostringstream os;
+            os << spec.name << " out of range [" << spec.min << ", " << spec.max << "]";
+            error = os.str();
+            return false;
+        }
+    }
+    if (!spec.choices.empty()) {
+        const auto& s = std::get<std::string>(value);
+        if (std::find(spec.choices.begin(), spec.choices.end(), s) == spec.choices.end()) {
+            std::string list;
+            for (const auto& c : spec.choices) list += (list.empty() ? "" : "|") + c;
+            error = spec.name + " must be one of " + list;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parseText(const ParamSpec& spec, const std::string& text, ParamValue& out, std::string& error) {
+    bool ok = false;
+    switch (spec.type) {
+        case ParamType::Bool: {
+            bool b = false;
+            ok = parseBoolText(text, b);
+            out = b;
+            break;
+        }
+        case ParamType::Int: {
+            std::int64_t i = 0;
+            ok = parseIntText(text, i);
+            out = i;
+            break;
+        }
+        case ParamType::Double: {
+            double d = 0.0;
+            ok = parseDoubleText(text, d);
+            out = d;
+            break;
+        }
+        case ParamType::String:
+            out = text;
+            ok = true;
+            break;
+    }
+    if (!ok) {
+        error = spec.name + " must be " + paramTypeName(spec.type) + " (got \"" + text + "\")";
+        return false;
+    }
+    return checkValue(spec, out, error);
+}
+
+bool parseJsonValue(const ParamSpec& spec, const json& j, ParamValue& out, std::string& error) {
+    if (j.is_string()) {
+        return parseText(spec, j.get_ref<const std::string&>(), out, error);
+    }
+    bool ok = false;
+    switch (spec.type) {
+        case ParamType::Bool:
+            if (j.is_boolean()) {
+                out = j.get<bool>();
+                ok = true;
+            } else if (j.is_number_integer() && (j.get<std::int64_t>() == 0 || j.get<std::int64_t>() == 1)) {
+                out = j.get<std::int64_t>() == 1;
+                ok = true;
+            }
+            break;
+        case ParamType::Int:
+            if (j.is_number_integer()) {
+                out = j.get<std::int64_t>();
+                ok = true;
+            } else if (j.is_number_float()) {
+                // 640.0 之类的整数值浮点（部分前端只输出 double）
+                const double d = j.get<double>();
+                ok = std::isfinite(d) && std::floor(d) == d && std::fabs(d) < 9.0e15;
+                out = static_cast<std::int64_t>(d);
+            }
+            break;
+        case ParamType::Double:
+            if (j.is_number()) {
+                out = j.get<double>();
+                ok = true;
+            }
+            break;
+        case ParamType::String:
+            // 与旧的字符串参数通道一致：标量按 JSON 文本
+            if (j.is_primitive() && !j.is_null()) {
+                out = j.dump();
+                ok = true;
+            }
+            break;
+    }
+    if (!ok) {
+        error = spec.name + " must be " + paramTypeName(spec.type);
+        return false;
+    }
+    return checkValue(spec, out, error);
+}
+
+json valueToJson(const ParamValue& value) {
+    return std::visit([](const auto& v) { return json(v); }, value);
+}
+
+} // namespace
+
+ParamSchema& ParamSchema::boolean(const std::string& name, bool defaultValue, const std::string& description) {
+    ParamSpec spec;
+    spec.name = name;
+    spec.type = ParamType::Bool;
+    spec.defaultValue = defaultValue;
+    spec.description = description;
+    specs_.push_back(std::move(spec));
+    return *this;
+}
+
+ParamSchema& ParamSchema::integer(const std::string& name, std::int64_t defaultValue, std::int64_t min,
+                                  std::int64_t max, const std::string& description) {
+    ParamSpec spec;
+    spec.name = name;
+    spec.type = ParamType::Int;
+    spec.defaultValue = defaultValue;
+    spec.hasRange = true;
+    spec.min = static_cast<double>(min);
+    spec.max = static_cast<double>(max);
+    spec.description = description;
+    specs_.push_back(std::move(spec));
+    return *this;
+}
+
+ParamSchema& ParamSchema::number(const std::string& name, double defaultValue, double min, double max,
+                                 const std::string& description) {
+    ParamSpec spec;
+    spec.name = name;
+    spec.type = ParamType::Double;
+    spec.defaultValue = defaultValue;
+    spec.hasRange = true;
+    spec.min = min;
+    spec.max = max;
+    spec.description = description;
+    specs_.push_back(std::move(spec));
+    return *this;
+}
+
+ParamSchema& ParamSchema::string(const std::string& name, const std::string& defaultValue,
+                                 std::vector<std::string> choices, const std::string& description) {
+    ParamSpec spec;
+    spec.name = name;
+    spec.type = ParamType::String;
+    spec.defaultValue = defaultValue;
+    spec.choices = std::move(choices);
+    spec.description = description;
+    specs_.push_back(std::move(spec));
+    return *this;
+}
+
+const ParamSpec* ParamSchema::find(const std::string& name) const {
+    for (const auto& spec : specs_) {
+        if (spec.name == name) return &spec;
+    }
+    return nullptr;
+}
+
+NodeParams ParamSchema::defaults() const {
+    NodeParams out;
+    for (const auto& spec : specs_) {
+        out.set(spec.name, spec.defaultValue, false);
+    }
+    return out;
+}
+
+bool ParamSchema::parse(const json& params, NodeParams& out, std::string& error) const {
+    out = defaults();
+    if (params.is_null()) return true;
+    if (!params.is_object()) {
+        error = "parameters must be an object";
+        return false;
+    }
+    for (const auto& spec : specs_) {
+        auto it = params.find(spec.name);
+        if (it == params.end() || it->is_null()) continue;
+        ParamValue value;
+        if (!parseJsonValue(spec, *it, value, error)) return false;
+        out.set(spec.name, std::move(value), true);
+    }
+    return true;
+}
+
+bool ParamSchema::parse(const std::unordered_map<std::string, std::string>& params, NodeParams& out,
+                        std::string& error) const {
+    out = defaults();
+    for (const auto& spec : specs_) {
+        auto it = params.find(spec.name);
+        if (it == params.end()) continue;
+        ParamValue value;
+        if (!parseText(spec, it->second, value, error)) return false;
+        out.set(spec.name, std::move(value), true);
+    }
+    return true;
+}
+
+std::string ParamSchema::toJson() const {
+    json out = json::array();
+    for (const auto& spec : specs_) {
+        json field;
+        field["name"] = spec.name;
+        field["type"] = paramTypeName(spec.type);
+        field["default"] = valueToJson(spec.defaultValue);
+        if (spec.hasRange) {
+            field["min"] = spec.min;
+            field["max"] = spec.max;
+        }
+        if (!spec.choices.empty()) field["choices"] = spec.choices;
+        if (!spec.description.empty()) field["description"] = spec.description;
+        out.push_back(std::move(field));
+    }
+    return out.dump();
+}
+
+// ---- NodeParamRegistry ----
+
+namespace {
+
+std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unordered_map<std::string, std::shared_ptr<const ParamSchema>>& registryMap() {
+    static std::unordered_map<std::string, std::shared_ptr<const ParamSchema>> map;
+    return map;
+}
+
+} // namespace
+
+void NodeParamRegistry::registerSchema(const std::string& templateId, std::shared_ptr<const ParamSchema> schema) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    if (schema) {
+        registryMap()[templateId] = std::move(schema);
+    } else {
+        registryMap().erase(templateId);
+    }
+}
+
+std::shared_ptr<const ParamSchema> NodeParamRegistry::find(const std::string& templateId) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    auto it = registryMap().find(templateId);
+    return it != registryMap().end() ? it->second : nullptr;
+}
+
+std::vector<std::string> NodeParamRegistry::templates() {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    std::vector<std::string> out;
+    out.reserve(registryMap().size());
+    for (const auto& [id, schema] : registryMap()) out.push_back(id);
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,75 @@
+#include "falconmind/sdk/core/NodePlacement.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace falconmind::sdk::core {
+
+bool NodePlacement::validate(std::string& error) const {
+    for (int cpu : cpus) {
+#ifdef __linux__
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+#else
+        if (cpu < 0) {
+#endif
+            error = "invalid cpu index " + std::to_string(cpu);
+            return false;
+        }
+    }
+    if (priority < 0 || priority > 99) {
+        error = "priority must be in [0, 99], got " + std::to_string(priority);
+        return false;
+    }
+    if (deadline.count() < 0 || period.count() < 0) {
+        error = "deadline and period must not be negative";
+        return false;
+    }
+    if (critical() && effectiveDeadline().count() == 0) {
+        error = "critical nodes need a deadline or period";
+        return false;
+    }
+    return true;
+}
+
+bool applyThreadPlacement(const NodePlacement& placement, const std::string& owner) {
+    bool ok = true;
+#ifdef __linux__
+    if (!placement.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : placement.cpus) {
+            CPU_SET(cpu, &set);
+        }
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (rc != 0) {
+            std::cerr << "[NodePlacement] " << owner << ": pthread_setaffinity_np failed: " << std::strerror(rc)
+                      << std::endl;
+            ok = false;
+        }
+    }
+    if (placement.priority > 0) {
+        sched_param param{};
+        param.sched_priority = placement.priority;
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc != 0) {
+            std::cerr << "[NodePlacement] " << owner << ": SCHED_FIFO priority " << placement.priority
+                      << " failed: " << std::strerror(rc) << " (needs CAP_SYS_NICE)" << std::endl;
+            ok = false;
+        }
+    }
+#else
+    if (placement.pinsThread()) {
+        std::cerr << "[NodePlacement] " << owner << ": thread placement not supported on this platform" << std::endl;
+        ok = false;
+    }
+#endif
+    return ok;
+}
+
+} // namespace falconmind::sdk::core
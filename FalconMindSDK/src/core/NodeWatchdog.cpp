@@ -0,0 +1,249 @@
+#include "falconmind/sdk/core/NodeWatchdog.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/PipelineScheduler.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <exception>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+constexpr std::uint32_t kMaxRateDivisor = 8;
+constexpr std::chrono::milliseconds kRestartPauseTimeout{1000};
+
+std::int64_t steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+const char* watchdogActionName(WatchdogAction action) noexcept {
+    switch (action) {
+        case WatchdogAction::Restart: return "restart";
+        case WatchdogAction::FallbackBackend: return "fallback_backend";
+        case WatchdogAction::LowerResolution: return "lower_resolution";
+        case WatchdogAction::LowerRate: return "lower_rate";
+    }
+    return "unknown";
+}
+
+bool parseWatchdogAction(const std::string& name, WatchdogAction& out) noexcept {
+    for (WatchdogAction action : {WatchdogAction::Restart, WatchdogAction::FallbackBackend,
+                                  WatchdogAction::LowerResolution, WatchdogAction::LowerRate}) {
+        if (name == watchdogActionName(action)) {
+            out = action;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* watchdogEventKindName(WatchdogEventKind kind) noexcept {
+    switch (kind) {
+        case WatchdogEventKind::Stalled: return "stalled";
+        case WatchdogEventKind::SloViolated: return "slo_violated";
+        case WatchdogEventKind::ActionTaken: return "action_taken";
+        case WatchdogEventKind::Exhausted: return "exhausted";
+        case WatchdogEventKind::Recovered: return "recovered";
+    }
+    return "unknown";
+}
+
+bool WatchdogPolicy::validate(std::string& error) const {
+    if (stallTimeout.count() < 0 || latencySlo.count() < 0) {
+        error = "stall_ms and slo_ms must not be negative";
+        return false;
+    }
+    if (violations == 0) {
+        error = "violations must be at least 1";
+        return false;
+    }
+    return true;
+}
+
+std::string toJson(const WatchdogEvent& event) {
+    nlohmann::json j = {{"node_id", event.nodeId},
+                        {"kind", watchdogEventKindName(event.kind)},
+                        {"observed_ms", event.observedMs},
+                        {"level", event.level},
+                        {"timestamp_ns", event.timestampNs}};
+    if (event.kind == WatchdogEventKind::ActionTaken) j["action"] = watchdogActionName(event.action);
+    return j.dump();
+}
+
+NodeWatchdog::NodeWatchdog(PipelineScheduler& scheduler, const NodeWatchdogConfig& cfg)
+    : scheduler_(scheduler), config_(cfg) {}
+
+NodeWatchdog::~NodeWatchdog() {
+    stop();
+}
+
+void NodeWatchdog::watch(std::shared_ptr<Node> node, const WatchdogPolicy& policy) {
+    if (!node || !policy.enabled()) return;
+    Watched w;
+    w.target = dynamic_cast<WatchdogTarget*>(node.get());
+    w.node = std::move(node);
+    w.policy = policy;
+    std::lock_guard<std::mutex> lock(mutex_);
+    nodes_.push_back(std::move(w));
+}
+
+void NodeWatchdog::start() {
+    if (thread_.joinable() || nodes_.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        running_ = true;
+    }
+    thread_ = std::thread(&NodeWatchdog::loop, this);
+}
+
+void NodeWatchdog::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        running_ = false;
+    }
+    wakeCv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void NodeWatchdog::loop() {
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    while (running_) {
+        if (wakeCv_.wait_for(lock, config_.checkInterval, [this]() { return !running_; })) break;
+        lock.unlock();
+        check();
+        lock.lock();
+    }
+}
+
+std::size_t NodeWatchdog::level(const std::string& nodeId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& w : nodes_) {
+        if (w.node->id() == nodeId) return w.level;
+    }
+    return 0;
+}
+
+void NodeWatchdog::check() {
+    std::vector<WatchdogEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = &events;
+        for (auto& w : nodes_) {
+            NodeActivity activity;
+            if (!scheduler_.takeActivity(w.node->id(), activity)) continue;
+            const std::int64_t now = steadyNs();
+            const std::int64_t pendingNs = w.target ? w.target->pendingWorkAgeNs(now) : 0;
+            const std::int64_t stuckNs = std::max(activity.runningForNs, pendingNs);
+            const std::int64_t stallNs =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(w.policy.stallTimeout).count();
+            const double observedMs =
+                static_cast<double>(std::max<std::int64_t>(stuckNs, static_cast<std::int64_t>(activity.windowMaxNs))) /
+                1e6;
+
+            if (stallNs > 0 && stuckNs >= stallNs) {
+                if (!w.stalled) {
+                    w.stalled = true;
+                    w.unhealthy = true;
+                    emit(w, WatchdogEventKind::Stalled, observedMs);
+                    escalate(w, true, now, observedMs);
+                } else if (now - w.lastActionNs >= stallNs) {
+                    escalate(w, true, now, observedMs);  // 上一级动作后仍卡住
+                }
+                continue;
+            }
+            w.stalled = false;
+
+            const bool over = w.policy.latencySlo.count() > 0 && observedMs > static_cast<double>(w.policy.latencySlo.count());
+            if (over) {
+                if (++w.violations >= w.policy.violations) {
+                    w.violations = 0;
+                    w.unhealthy = true;
+                    emit(w, WatchdogEventKind::SloViolated, observedMs);
+                    escalate(w, false, now, observedMs);
+                }
+                continue;
+            }
+            w.violations = 0;
+            if (w.unhealthy && activity.processCount != w.lastProcessCount) {
+                w.unhealthy = false;
+                emit(w, WatchdogEventKind::Recovered, observedMs);
+            }
+            w.lastProcessCount = activity.processCount;
+        }
+        pending_ = nullptr;
+    }
+    if (callback_) {
+        for (const auto& event : events) callback_(event);
+    }
+}
+
+void NodeWatchdog::escalate(Watched& w, bool stuck, std::int64_t nowNs, double observedMs) {
+    w.lastActionNs = nowNs;
+    while (w.level < w.policy.ladder.size()) {
+        const WatchdogAction action = w.policy.ladder[w.level++];
+        if (apply(w, action, stuck)) {
+            FM_LOG_WARN("NodeWatchdog", "node ", w.node->id(), ": ", watchdogActionName(action), " (level ", w.level,
+                        ", observed ", observedMs, "ms)");
+            emit(w, WatchdogEventKind::ActionTaken, observedMs, action);
+            return;
+        }
+    }
+    if (!w.exhausted) {
+        w.exhausted = true;
+        FM_LOG_ERROR("NodeWatchdog", "node ", w.node->id(), ": recovery ladder exhausted (observed ", observedMs,
+                     "ms)");
+        emit(w, WatchdogEventKind::Exhausted, observedMs);
+    }
+}
+
+bool NodeWatchdog::apply(Watched& w, WatchdogAction action, bool stuck) {
+    if (w.target && w.target->applyWatchdogAction(action)) return true;
+    const std::string& id = w.node->id();
+    switch (action) {
+        case WatchdogAction::Restart: {
+            // stop() 会等待卡住的工作完成，此时只能改用后备手段
+            if (stuck) return false;
+            const bool wasPaused = scheduler_.isPaused();
+            if (!wasPaused && !scheduler_.pause(kRestartPauseTimeout)) {
+                scheduler_.resume();
+                return false;
+            }
+            bool ok = false;
+            try {
+                w.node->stop();
+                ok = w.node->start();
+            } catch (const std::exception& e) {
+                FM_LOG_ERROR("NodeWatchdog", "node ", id, " restart threw: ", e.what());
+            }
+            if (!wasPaused) scheduler_.resume();
+            return ok;
+        }
+        case WatchdogAction::LowerRate: {
+            const std::uint32_t divisor = scheduler_.rateDivisor(id);
+            return divisor < kMaxRateDivisor && scheduler_.setRateDivisor(id, divisor * 2);
+        }
+        default:
+            return false;
+    }
+}
+
+void NodeWatchdog::emit(const Watched& w, WatchdogEventKind kind, double observedMs, WatchdogAction action) {
+    if (!pending_) return;
+    WatchdogEvent event;
+    event.nodeId = w.node->id();
+    event.kind = kind;
+    event.action = action;
+    event.observedMs = observedMs;
+    event.level = w.level;
+    event.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch()).count();
+    pending_->push_back(std::move(event));
+}
+
+} // namespace falconmind::sdk::core
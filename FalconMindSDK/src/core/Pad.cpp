@@ -1,11 +1,111 @@
 #include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/core/RateControl.h"
+#include "falconmind/sdk/core/Trace.h"
+
+#include <algorithm>
+#include <thread>
 
 namespace falconmind::sdk::core {
 
+LinkQueueConfig effectiveQueueConfig(const LinkQueueConfig& cfg) {
+    LinkQueueConfig out = cfg;
+    if (cfg.backpressure == LinkBackpressure::KeepLatest || cfg.backpressure == LinkBackpressure::AdaptSourceRate) {
+        out.enabled = true;
+        out.capacity = 1;
+        out.policy = LinkQueuePolicy::DropOldest;
+    }
+    return out;
+}
+
+LinkQueue::LinkQueue(const LinkQueueConfig& cfg)
+    : config_(cfg)
+    , items_(cfg.capacity > 0 ? cfg.capacity : 1)
+    , spare_((cfg.capacity > 0 ? cfg.capacity : 1) + 2) {}
+
+void LinkQueue::recycle(BufferRef&& buffer) {
+    // 仅回收本队列分配且已无其它持有者的缓冲；回收池满则直接释放
+    if (buffer.unique() && buffer.storage()->owner == this) {
+        spare_.tryPush(std::move(buffer));
+    }
+}
+
+bool LinkQueue::push(const void* data, size_t size) {
+    BufferRef buffer;
+    if (spare_.tryPop(buffer) && buffer.unique()) {
+        auto& storage = *buffer.storage();
+        const auto* p = static_cast<const std::uint8_t*>(data);
+        storage.owned.assign(p, p + size);
+        storage.data = storage.owned.data();
+        storage.size = storage.owned.size();
+        storage.meta = BufferMeta{};
+        storage.domainState.reset();  // 上一帧缓存的设备视图
+    } else {
+        buffer = BufferRef::copyFrom(data, size);
+        buffer.storage()->owner = this;
+    }
+    return enqueue(std::move(buffer));
+}
+
+bool LinkQueue::push(const BufferRef& buffer) {
+    BufferRef ref = buffer;
+    return enqueue(std::move(ref));
+}
+
+bool LinkQueue::enqueue(BufferRef&& buffer) {
+    pushed_.fetch_add(1, std::memory_order_relaxed);
+    // 环形队列容量为 2 的幂，按配置容量判满（KeepLatest 需要严格的容量 1）
+    std::size_t capacity = config_.capacity > 0 ? config_.capacity : 1;
+    if (items_.sizeApprox() < capacity && items_.tryPush(std::move(buffer))) {
+        return true;
+    }
+
+    switch (config_.policy) {
+        case LinkQueuePolicy::DropNewest:
+            break;
+        case LinkQueuePolicy::DropOldest: {
+            // 与消费者竞争时可能需要多次尝试；挤出的旧数据计为丢弃
+            for (int attempt = 0; attempt < 8; ++attempt) {
+                BufferRef old;
+                if (items_.tryPop(old)) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    recycle(std::move(old));
+                }
+                if (items_.sizeApprox() < capacity && items_.tryPush(std::move(buffer))) {
+                    return false;
+                }
+            }
+            break;
+        }
+        case LinkQueuePolicy::Block: {
+            auto deadline = std::chrono::steady_clock::now() + config_.blockTimeout;
+            while (std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+                if (items_.sizeApprox() < capacity && items_.tryPush(std::move(buffer))) {
+                    return true;
+                }
+            }
+            break;
+        }
+    }
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    recycle(std::move(buffer));
+    return false;
+}
+
+bool LinkQueue::pop(BufferRef& out) {
+    if (!items_.tryPop(out)) {
+        return false;
+    }
+    popped_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
 Pad::Pad(std::string name, PadType type)
-    : name_(std::move(name)), type_(type) {}
+    : name_(std::move(name)), traceName_(Tracer::intern("push:" + name_)), type_(type) {}
 
-bool Pad::connectTo(std::shared_ptr<Pad> targetPad, const std::string& targetNodeId, const std::string& targetPadName) {
+bool Pad::connectTo(std::shared_ptr<Pad> targetPad, const std::string& targetNodeId, const std::string& targetPadName,
+                    const LinkQueueConfig& queue) {
     if (!targetPad) {
         return false;
     }
@@ -39,25 +139,194 @@ bool Pad::connectTo(std::shared_ptr<Pad> targetPad, const std::string& targetNod
     conn.targetPad = targetPad;
     conn.targetNodeId = targetNodeId;
     conn.targetPadName = targetPadName;
+    conn.counters = std::make_shared<LinkCounters>();
+    LinkQueueConfig effective = effectiveQueueConfig(queue);
+    if (effective.enabled) {
+        conn.queue = std::make_shared<LinkQueue>(effective);
+        targetPad->inboundQueues_.push_back(conn.queue);
+    }
+    if (queue.backpressure == LinkBackpressure::SkipN) {
+        conn.skipFrames = queue.skipFrames;
+    } else if (queue.backpressure == LinkBackpressure::AdaptSourceRate) {
+        conn.rate = std::make_shared<LinkRateController>(queue.minSourceFps);
+    }
     connections_.push_back(conn);
+    rebuildFanOut();
     
     return true;
 }
 
+void Pad::rebuildFanOut() {
+    auto fan = std::make_shared<FanOut>();
+    fan->targets.reserve(connections_.size());
+    for (const auto& conn : connections_) {
+        auto target = conn.targetPad.lock();
+        if (!target) continue;
+        fan->targets.push_back(FanOutTarget{conn, target.get()});
+        if (!conn.queue) ++fan->syncTargets;
+    }
+    std::shared_ptr<const FanOut> published = std::move(fan);
+    std::atomic_store(&fanOut_, published);
+}
+
+void Pad::setFanOutExecutor(FanOutExecutor executor, std::size_t minTargets) {
+    fanOutExecutor_ = std::move(executor);
+    fanOutMin_ = minTargets < 2 ? 2 : minTargets;
+}
+
+void Pad::setNegotiatedCaps(const VideoCaps& caps) {
+    negotiated_ = caps;
+    if (capsCallback_) {
+        capsCallback_(negotiated_);
+    }
+}
+
 bool Pad::disconnect() {
+    for (const auto& conn : connections_) {
+        if (conn.rate) conn.rate->release();
+        if (!conn.queue) continue;
+        if (auto target = conn.targetPad.lock()) {
+            auto& inbound = target->inboundQueues_;
+            inbound.erase(std::remove(inbound.begin(), inbound.end(), conn.queue), inbound.end());
+        }
+    }
     connections_.clear();
+    rebuildFanOut();
+    return true;
+}
+
+bool Pad::disconnect(const std::shared_ptr<Pad>& targetPad) {
+    auto it = std::find_if(connections_.begin(), connections_.end(), [&](const PadConnection& conn) {
+        return conn.targetPad.lock() == targetPad;
+    });
+    if (it == connections_.end()) {
+        return false;
+    }
+    if (it->rate) {
+        it->rate->release();
+    }
+    if (it->queue && targetPad) {
+        auto& inbound = targetPad->inboundQueues_;
+        inbound.erase(std::remove(inbound.begin(), inbound.end(), it->queue), inbound.end());
+    }
+    connections_.erase(it);
+    rebuildFanOut();
     return true;
 }
 
 void Pad::pushToConnections(const void* data, size_t size) const {
     // Source和Both Pad都可以推送数据
     if ((type_ != PadType::Source && type_ != PadType::Both) || !data) return;
-    for (const auto& conn : connections_) {
-        if (auto target = conn.targetPad.lock()) {
-            DataCallback cb = target->getDataCallback();
-            if (cb) cb(data, size);
+    dispatch(nullptr, data, size);
+}
+
+void Pad::pushBuffer(const BufferRef& buffer) const {
+    if ((type_ != PadType::Source && type_ != PadType::Both) || !buffer) return;
+    dispatch(&buffer, buffer.data(), buffer.size());
+}
+
+void Pad::dispatch(const BufferRef* buffer, const void* data, size_t size) const {
+    auto fan = std::atomic_load(&fanOut_);
+    if (!fan) return;
+    FM_TRACE_SCOPE("pad", traceName_);
+    const bool parallel = fanOutExecutor_ && fan->syncTargets >= fanOutMin_;
+    BufferRef copied;  // 仅当接收方需要持有 BufferRef 时拷贝一次，多个接收方共享
+    Pad* sync[kMaxParallelTargets];
+    std::size_t syncCount = 0;
+
+    // 抽帧、计数与入队在推送线程完成；同步直连目标在并行模式下先收集，最后一起投递
+    for (const auto& entry : fan->targets) {
+        const auto& conn = entry.conn;
+        Pad* target = entry.pad;
+        if (conn.targetPad.expired()) continue;
+        if (skipFrame(conn)) continue;
+        conn.counters->frames.fetch_add(1, std::memory_order_relaxed);
+        conn.counters->bytes.fetch_add(size, std::memory_order_relaxed);
+        if (conn.queue) {
+            if (buffer) {
+                conn.queue->push(*buffer);
+            } else {
+                conn.queue->push(data, size);
+            }
+            if (conn.rate) conn.rate->onPush(*conn.queue, PipelineClock::nowNs());
+        } else {
+            if (!buffer && target->bufferCallback_ && !copied) copied = BufferRef::copyFrom(data, size);
+            if (parallel && syncCount < kMaxParallelTargets) {
+                sync[syncCount++] = target;
+                continue;
+            }
+            if (buffer) {
+                target->deliver(*buffer);
+            } else if (target->bufferCallback_) {
+                target->bufferCallback_(copied);
+            } else if (target->dataCallback_) {
+                target->dataCallback_(data, size);
+            }
         }
+        if (target->arrivalCallback_) target->arrivalCallback_();
+    }
+
+    if (syncCount == 0) return;
+    const BufferRef& shared = buffer ? *buffer : copied;
+    fanOutExecutor_(syncCount, [&](std::size_t i) {
+        Pad* target = sync[i];
+        if (buffer || target->bufferCallback_) {
+            target->deliver(shared);
+        } else if (target->dataCallback_) {
+            target->dataCallback_(data, size);
+        }
+        if (target->arrivalCallback_) target->arrivalCallback_();
+    });
+}
+
+bool Pad::skipFrame(const PadConnection& conn) {
+    if (conn.skipFrames == 0) {
+        return false;
+    }
+    // 只由生产者线程修改，按已投递 + 已跳过的帧序号抽帧
+    auto offered = conn.counters->frames.load(std::memory_order_relaxed) +
+                   conn.counters->skipped.load(std::memory_order_relaxed);
+    if (offered % (static_cast<std::uint64_t>(conn.skipFrames) + 1) == 0) {
+        return false;
+    }
+    conn.counters->skipped.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void Pad::deliver(const BufferRef& buffer) const {
+    if (bufferCallback_) {
+        bufferCallback_(buffer);
+    } else if (dataCallback_) {
+        dataCallback_(buffer.data(), buffer.size());
+    }
+}
+
+size_t Pad::drainQueued(size_t maxPerQueue) {
+    size_t delivered = 0;
+    for (const auto& queue : inboundQueues_) {
+        BufferRef buffer;
+        for (size_t i = 0; i < maxPerQueue && queue->pop(buffer); ++i) {
+            deliver(buffer);
+            queue->recycle(std::move(buffer));
+            ++delivered;
+        }
+    }
+    return delivered;
+}
+
+bool Pad::hasQueuedData() const noexcept {
+    for (const auto& queue : inboundQueues_) {
+        if (queue->depth() > 0) return true;
+    }
+    return false;
+}
+
+size_t Pad::queuedDepth() const noexcept {
+    size_t depth = 0;
+    for (const auto& queue : inboundQueues_) {
+        depth += queue->depth();
     }
+    return depth;
 }
 
 } // namespace falconmind::sdk::core
@@ -0,0 +1,80 @@
+#include "falconmind/sdk/core/PadTapNode.h"
+
+#include <algorithm>
+
+namespace falconmind::sdk::core {
+
+PadTapNode::PadTapNode(Pad::BufferCallback handler)
+    : Node("pad_tap")
+    , handler_(std::move(handler)) {
+    auto* in = addPad(std::make_shared<Pad>("in", PadType::Sink));
+    in->setBufferCallback([this](const BufferRef& buffer) {
+        delivered_.fetch_add(1, std::memory_order_relaxed);
+        if (handler_) handler_(buffer);
+    });
+}
+
+PadTapQueue::PadTapQueue(std::size_t capacity) : capacity_(std::max<std::size_t>(capacity, 1)) {}
+
+void PadTapQueue::push(const BufferRef& buffer) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) return;
+        if (items_.size() >= capacity_) {
+            items_.pop_front();
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        items_.push_back(buffer);
+    }
+    cv_.notify_one();
+}
+
+bool PadTapQueue::waitLocked(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout) {
+    auto ready = [this]() { return closed_ || !items_.empty(); };
+    if (timeout.count() < 0) {
+        cv_.wait(lock, ready);
+    } else if (!cv_.wait_for(lock, timeout, ready)) {
+        return false;
+    }
+    return !items_.empty();
+}
+
+bool PadTapQueue::pop(BufferRef& out, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!waitLocked(lock, timeout)) return false;
+    out = std::move(items_.front());
+    items_.pop_front();
+    return true;
+}
+
+std::size_t PadTapQueue::popBatch(std::vector<BufferRef>& out, std::size_t max, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (max == 0 || !waitLocked(lock, timeout)) return 0;
+    const std::size_t n = std::min(max, items_.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        out.push_back(std::move(items_.front()));
+        items_.pop_front();
+    }
+    return n;
+}
+
+void PadTapQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        items_.clear();
+    }
+    cv_.notify_all();
+}
+
+void PadTapQueue::reopen() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = false;
+}
+
+std::size_t PadTapQueue::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return items_.size();
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,167 @@
+#include "falconmind/sdk/core/PerfCounters.h"
+
+#include <memory>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+constexpr std::size_t kCounters = static_cast<std::size_t>(PerfCounter::Count);
+
+#if defined(__linux__)
+
+// 每个计数器对应的 perf 事件
+struct EventSpec {
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+constexpr EventSpec kEvents[kCounters] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+};
+
+int openEvent(const EventSpec& spec, int groupFd) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = groupFd < 0 ? 1 : 0;  // 组长先停，全部加入后一起启动
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+
+#endif
+
+} // namespace
+
+const char* perfCounterName(PerfCounter counter) noexcept {
+    switch (counter) {
+        case PerfCounter::Cycles: return "cycles";
+        case PerfCounter::Instructions: return "instructions";
+        case PerfCounter::L1dMisses: return "l1d_misses";
+        case PerfCounter::LlcMisses: return "llc_misses";
+        case PerfCounter::BranchMisses: return "branch_misses";
+        case PerfCounter::ContextSwitches: return "context_switches";
+        case PerfCounter::Count: break;
+    }
+    return "unknown";
+}
+
+double PerfCounterValues::ipc() const noexcept {
+    if (!has(PerfCounter::Cycles) || !has(PerfCounter::Instructions) || (*this)[PerfCounter::Cycles] == 0) return -1.0;
+    return static_cast<double>((*this)[PerfCounter::Instructions]) / static_cast<double>((*this)[PerfCounter::Cycles]);
+}
+
+PerfCounterValues& PerfCounterValues::operator+=(const PerfCounterValues& other) noexcept {
+    for (std::size_t i = 0; i < kCounters; ++i) value[i] += other.value[i];
+    available |= other.available;
+    return *this;
+}
+
+PerfCounterValues PerfCounterValues::operator-(const PerfCounterValues& earlier) const noexcept {
+    PerfCounterValues out;
+    out.available = available & earlier.available;
+    for (std::size_t i = 0; i < kCounters; ++i) {
+        out.value[i] = value[i] >= earlier.value[i] ? value[i] - earlier.value[i] : 0;
+    }
+    return out;
+}
+
+PerfCounterGroup::~PerfCounterGroup() { close(); }
+
+#if defined(__linux__)
+
+bool PerfCounterGroup::open() {
+    close();
+    for (std::size_t i = 0; i < kCounters; ++i) {
+        int fd = openEvent(kEvents[i], leader_);
+        if (fd < 0) continue;
+        if (leader_ < 0) leader_ = fd;
+        fds_[i] = fd;
+        order_[opened_++] = static_cast<PerfCounter>(i);
+        available_ |= 1u << i;
+    }
+    if (leader_ < 0) return false;
+    ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+void PerfCounterGroup::close() {
+    for (int& fd : fds_) {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+    leader_ = -1;
+    opened_ = 0;
+    available_ = 0;
+}
+
+bool PerfCounterGroup::read(PerfCounterValues& out) const {
+    if (leader_ < 0) return false;
+    // PERF_FORMAT_GROUP 布局：nr, time_enabled, time_running, value[nr]
+    std::uint64_t buf[3 + kCounters];
+    const ssize_t expected = static_cast<ssize_t>((3 + opened_) * sizeof(std::uint64_t));
+    if (::read(leader_, buf, sizeof(buf)) < expected || buf[0] != opened_) return false;
+    const std::uint64_t enabled = buf[1];
+    const std::uint64_t running = buf[2];
+    out = PerfCounterValues{};
+    out.available = available_;
+    for (std::size_t i = 0; i < opened_; ++i) {
+        std::uint64_t v = buf[3 + i];
+        // 计数器被多路复用时按运行时间占比外推
+        if (running > 0 && running < enabled) {
+            v = static_cast<std::uint64_t>(static_cast<double>(v) * static_cast<double>(enabled) /
+                                           static_cast<double>(running));
+        }
+        out.value[static_cast<std::size_t>(order_[i])] = v;
+    }
+    return true;
+}
+
+#else
+
+bool PerfCounterGroup::open() { return false; }
+void PerfCounterGroup::close() {}
+bool PerfCounterGroup::read(PerfCounterValues&) const { return false; }
+
+#endif
+
+PerfCounterGroup* PerfCounterGroup::forCurrentThread() {
+    // 首次调用时尝试打开一次，失败后不再重试（避免每次 process() 都走一遍 perf_event_open）
+    thread_local std::unique_ptr<PerfCounterGroup> group = [] {
+        auto g = std::make_unique<PerfCounterGroup>();
+        if (!g->open()) g.reset();
+        return g;
+    }();
+    return group.get();
+}
+
+std::string perfCounterSummary() {
+    const PerfCounterGroup* group = PerfCounterGroup::forCurrentThread();
+    if (!group) return "none";
+    std::string out;
+    for (std::size_t i = 0; i < kCounters; ++i) {
+        if (!((group->available() >> i) & 1u)) continue;
+        if (!out.empty()) out += ' ';
+        out += perfCounterName(static_cast<PerfCounter>(i));
+    }
+    return out;
+}
+
+} // namespace falconmind::sdk::core
@@ -1,14 +1,33 @@
 #include "falconmind/sdk/core/Pipeline.h"
+#include "falconmind/sdk/core/BootProfiler.h"
+#include "falconmind/sdk/core/BranchSwitch.h"
+#include "falconmind/sdk/core/CaptureFile.h"
+#include "falconmind/sdk/core/DependencyRunner.h"
+#include "falconmind/sdk/core/MemoryBudget.h"
 #include "falconmind/sdk/core/Node.h"
 #include "falconmind/sdk/core/Pad.h"
-#include <unordered_set>
+#include "falconmind/sdk/core/PadTapNode.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/core/RateControl.h"
+#include "falconmind/sdk/core/ShmTransport.h"
+#include "falconmind/sdk/sensors/PixelFusion.h"
+#include "falconmind/sdk/sensors/VideoConvertNode.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <tuple>
 
 namespace falconmind::sdk::core {
 
 Pipeline::Pipeline(const PipelineConfig& cfg)
-    : config_(cfg) {}
+    : config_(cfg)
+    , scheduler_(std::make_unique<PipelineScheduler>()) {}
 
-Pipeline::~Pipeline() = default;
+Pipeline::~Pipeline() {
+    clearBranchSwitches();
+    scheduler_->stop();
+    stopNodes();
+}
 
 bool Pipeline::addNode(const std::shared_ptr<Node>& node) {
     if (!node) return false;
@@ -17,13 +36,50 @@ bool Pipeline::addNode(const std::shared_ptr<Node>& node) {
         return false;
     }
     nodes_.emplace(id, node);
+    invalidateTopology();
+    return true;
+}
+
+bool Pipeline::removeNode(const std::string& nodeId) {
+    auto it = nodes_.find(nodeId);
+    if (it == nodes_.end()) {
+        return false;
+    }
+    if (scheduler_->isRunning() && !scheduler_->isPaused()) {
+        std::cerr << "[Pipeline] " << config_.pipelineId << ": cannot remove node " << nodeId
+                  << " while playing" << std::endl;
+        return false;
+    }
+    clearPixelFusion();  // 融合链持有节点指针，恢复 Playing 时按新拓扑重建
+
+    std::vector<LinkKey> touching;
+    for (const auto& [key, convId] : converters_) {
+        (void)convId;
+        if (key.srcNodeId == nodeId || key.dstNodeId == nodeId) touching.push_back(key);
+    }
+    for (const auto& key : links_) {
+        if (key.srcNodeId == nodeId || key.dstNodeId == nodeId) touching.push_back(key);
+    }
+    for (const auto& key : touching) {
+        unlink(key.srcNodeId, key.srcPadName, key.dstNodeId, key.dstPadName);
+    }
+
+    auto node = it->second;
+    auto started = std::find(startedNodes_.begin(), startedNodes_.end(), node);
+    if (started != startedNodes_.end()) {
+        node->stop();
+        startedNodes_.erase(started);
+    }
+    nodes_.erase(nodeId);
+    invalidateTopology();
     return true;
 }
 
 bool Pipeline::link(const std::string& srcNodeId,
                     const std::string& srcPadName,
                     const std::string& dstNodeId,
-                    const std::string& dstPadName) {
+                    const std::string& dstPadName,
+                    const LinkQueueConfig& queue) {
     // 检查源节点和目标节点是否存在
     auto srcIt = nodes_.find(srcNodeId);
     auto dstIt = nodes_.find(dstNodeId);
@@ -53,21 +109,110 @@ bool Pipeline::link(const std::string& srcNodeId,
     key.dstNodeId = dstNodeId;
     key.dstPadName = dstPadName;
     
-    if (links_.count(key) > 0) {
+    if (links_.count(key) > 0 || converters_.count(key) > 0) {
         return true;  // 连接已存在
     }
+
+    // 格式协商：在 link 时确定格式，节点无需逐帧解析格式字符串
+    VideoCaps agreed;
+    bool typed = srcPad->caps().hasVideo() || dstPad->caps().hasVideo();
+    if (typed && !negotiateVideoCaps(srcPad->caps(), dstPad->caps(), agreed)) {
+        return linkWithConverter(key, srcPad, dstPad, queue);
+    }
     
     // 通过Pad的connectTo方法建立连接
-    if (!srcPad->connectTo(dstPad, dstNodeId, dstPadName)) {
+    if (!srcPad->connectTo(dstPad, dstNodeId, dstPadName, queue)) {
         return false;
     }
+    if (typed) {
+        srcPad->setNegotiatedCaps(agreed);
+        dstPad->setNegotiatedCaps(agreed);
+    }
+    if (queue.backpressure == LinkBackpressure::AdaptSourceRate) {
+        installRateFeedback(key, srcNode, *srcPad, dstPad);
+    }
     
     // 存储连接信息
     links_.insert(key);
+    invalidateTopology();
     
     return true;
 }
 
+bool Pipeline::linkRemote(const std::string& srcNodeId,
+                          const std::string& srcPadName,
+                          const ShmChannelConfig& channel,
+                          const LinkQueueConfig& queue) {
+    std::string sinkId = remoteSinkId(channel.name);
+    if (nodes_.count(sinkId) == 0) {
+        auto sink = std::make_shared<ShmSinkNode>(channel);
+        sink->setId(sinkId);
+        if (!addNode(sink)) {
+            return false;
+        }
+    }
+    if (!link(srcNodeId, srcPadName, sinkId, "in", queue)) {
+        std::cerr << "[Pipeline] linkRemote failed: " << srcNodeId << "." << srcPadName << " -> shm:" << channel.name
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Pipeline::tapToFile(const std::string& srcNodeId,
+                         const std::string& srcPadName,
+                         const std::string& path,
+                         const LinkQueueConfig& queue) {
+    std::string recorderId = tapId(srcNodeId, srcPadName);
+    if (nodes_.count(recorderId) > 0) {
+        std::cerr << "[Pipeline] tapToFile: " << srcNodeId << "." << srcPadName << " is already tapped" << std::endl;
+        return false;
+    }
+    auto recorder = std::make_shared<CaptureRecorderNode>(path);
+    recorder->setId(recorderId);
+    if (!addNode(recorder)) {
+        return false;
+    }
+    if (!link(srcNodeId, srcPadName, recorderId, "in", queue)) {
+        std::cerr << "[Pipeline] tapToFile failed: " << srcNodeId << "." << srcPadName << " -> " << path << std::endl;
+        removeNode(recorderId);
+        return false;
+    }
+    return true;
+}
+
+bool Pipeline::addPadTap(const std::string& srcNodeId,
+                         const std::string& srcPadName,
+                         Pad::BufferCallback handler,
+                         const LinkQueueConfig& queue) {
+    std::string tap = padTapId(srcNodeId, srcPadName);
+    if (nodes_.count(tap) > 0) {
+        std::cerr << "[Pipeline] addPadTap: " << srcNodeId << "." << srcPadName << " is already tapped" << std::endl;
+        return false;
+    }
+    auto node = std::make_shared<PadTapNode>(std::move(handler));
+    node->setId(tap);
+    if (!addNode(node)) {
+        return false;
+    }
+    if (!link(srcNodeId, srcPadName, tap, "in", queue)) {
+        std::cerr << "[Pipeline] addPadTap failed: " << srcNodeId << "." << srcPadName << std::endl;
+        removeNode(tap);
+        return false;
+    }
+    return true;
+}
+
+bool Pipeline::removePadTap(const std::string& srcNodeId, const std::string& srcPadName) {
+    return removeNode(padTapId(srcNodeId, srcPadName));
+}
+
+bool Pipeline::addRemoteSource(const std::string& nodeId, const std::string& channelName) {
+    auto source = std::make_shared<ShmSourceNode>(channelName);
+    source->setId(nodeId);
+    return addNode(source);
+}
+
 bool Pipeline::unlink(const std::string& srcNodeId,
                       const std::string& srcPadName,
                       const std::string& dstNodeId,
@@ -79,30 +224,119 @@ bool Pipeline::unlink(const std::string& srcNodeId,
     key.dstNodeId = dstNodeId;
     key.dstPadName = dstPadName;
     
+    auto convIt = converters_.find(key);
+    if (convIt != converters_.end()) {
+        std::string convId = convIt->second;
+        converters_.erase(convIt);
+        bool ok = unlink(srcNodeId, srcPadName, convId, "sink") && unlink(convId, "src", dstNodeId, dstPadName);
+        auto convNode = nodes_.find(convId);
+        if (convNode != nodes_.end()) {
+            stopNodes({convNode->second});
+            nodes_.erase(convNode);
+            invalidateTopology();
+        }
+        return ok;
+    }
+
     if (links_.count(key) == 0) {
         return false;  // 连接不存在
     }
     
     // 获取源节点和Pad
     auto srcIt = nodes_.find(srcNodeId);
-    if (srcIt == nodes_.end()) {
+    auto dstIt = nodes_.find(dstNodeId);
+    if (srcIt == nodes_.end() || dstIt == nodes_.end()) {
         return false;
     }
     
     auto srcPad = srcIt->second->getPad(srcPadName);
-    if (!srcPad) {
+    auto dstPad = dstIt->second->getPad(dstPadName);
+    if (!srcPad || !dstPad) {
         return false;
     }
     
-    // 断开Pad连接
-    srcPad->disconnect();
+    // 只断开这一条连接，同一 Source Pad 的其它连接保持
+    srcPad->disconnect(dstPad);
     
     // 从连接列表中移除
     links_.erase(key);
+    invalidateTopology();
     
     return true;
 }
 
+void Pipeline::installRateFeedback(const LinkKey& key, const std::shared_ptr<Node>& srcNode, const Pad& srcPad,
+                                   const std::shared_ptr<Pad>& dstPad) {
+    if (!dynamic_cast<RateAdaptable*>(srcNode.get())) {
+        std::cerr << "[Pipeline] " << key.srcNodeId << "." << key.srcPadName << " -> " << key.dstNodeId << "."
+                  << key.dstPadName << ": source cannot adapt its rate, using keep_latest" << std::endl;
+        return;
+    }
+    std::string requester = key.srcPadName + "->" + key.dstNodeId + "." + key.dstPadName;
+    std::weak_ptr<Node> weak = srcNode;
+    for (const auto& conn : srcPad.connections()) {
+        if (conn.rate && conn.targetPad.lock() == dstPad) {
+            conn.rate->setFeedback([weak, requester](double fps) {
+                if (auto node = weak.lock()) {
+                    dynamic_cast<RateAdaptable*>(node.get())->requestMaxFrameRate(requester, fps);
+                }
+            });
+        }
+    }
+}
+
+std::string Pipeline::converterId(const std::string& srcNodeId, const std::string& srcPadName,
+                                  const std::string& dstNodeId, const std::string& dstPadName) {
+    return "convert:" + srcNodeId + "." + srcPadName + "->" + dstNodeId + "." + dstPadName;
+}
+
+bool Pipeline::linkWithConverter(const LinkKey& key, const std::shared_ptr<Pad>& srcPad,
+                                 const std::shared_ptr<Pad>& dstPad, const LinkQueueConfig& queue) {
+    // 按下游偏好查找尺寸兼容、且像素格式可转换的 (上游, 下游) 组合
+    for (const auto& want : dstPad->caps().video()) {
+        for (const auto& offer : srcPad->caps().video()) {
+            VideoCaps a = offer;
+            VideoCaps b = want;
+            a.format = b.format = PixelFormat::Any;
+            if (!a.intersects(b) || !sensors::canConvertPixels(offer.format, want.format)) {
+                continue;
+            }
+            VideoCaps dims = a.intersect(b);
+            VideoCaps in = dims;
+            in.format = offer.format;
+            VideoCaps out = dims;
+            out.format = want.format;
+
+            auto converter = std::make_shared<sensors::VideoConvertNode>();
+            std::string convId = converterId(key.srcNodeId, key.srcPadName, key.dstNodeId, key.dstPadName);
+            converter->setId(convId);
+            if (!addNode(converter)) {
+                return false;
+            }
+            if (!link(key.srcNodeId, key.srcPadName, convId, "sink", queue) ||
+                !link(convId, "src", key.dstNodeId, key.dstPadName)) {
+                unlink(key.srcNodeId, key.srcPadName, convId, "sink");
+                nodes_.erase(convId);
+                invalidateTopology();
+                return false;
+            }
+            // 两段分别协商后固定为选定的组合
+            srcPad->setNegotiatedCaps(in);
+            converter->getPad("sink")->setNegotiatedCaps(in);
+            converter->getPad("src")->setNegotiatedCaps(out);
+            dstPad->setNegotiatedCaps(out);
+            converters_[key] = convId;
+            std::cout << "[Pipeline] " << key.srcNodeId << "." << key.srcPadName << " -> " << key.dstNodeId
+                      << "." << key.dstPadName << ": inserted converter " << pixelFormatName(in.format)
+                      << " -> " << pixelFormatName(out.format) << std::endl;
+            return true;
+        }
+    }
+    std::cerr << "[Pipeline] link " << key.srcNodeId << "." << key.srcPadName << " -> " << key.dstNodeId
+              << "." << key.dstPadName << ": no common or convertible video format" << std::endl;
+    return false;
+}
+
 std::shared_ptr<Node> Pipeline::getNode(const std::string& nodeId) {
     auto it = nodes_.find(nodeId);
     if (it != nodes_.end()) {
@@ -127,8 +361,500 @@ std::vector<Pipeline::LinkInfo> Pipeline::getLinks() const {
     return result;
 }
 
+PipelineMetrics Pipeline::metrics() {
+    PipelineMetrics out;
+    out.pipelineId = config_.pipelineId;
+    out.memoryBudgetBytes = config_.memoryBudgetBytes;
+    out.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::system_clock::now().time_since_epoch()).count();
+
+    auto topo = topology();
+    std::vector<std::uint32_t> order = topo->order;
+    if (!topo->acyclic) {
+        order.resize(topo->nodes.size());
+        for (std::uint32_t i = 0; i < order.size(); ++i) order[i] = i;  // 已按 ID 排序
+    }
+    for (auto i : order) {
+        const auto& id = topo->nodes[i]->id();
+        NodeMetrics nm;
+        if (!scheduler_->nodeMetrics(id, nm)) {
+            nm.nodeId = id;  // 尚未被调度
+        }
+        if (auto* sink = dynamic_cast<const LatencySink*>(topo->nodes[i].get())) {
+            auto ls = sink->latencyTracker().stats();
+            nm.hasLatency = true;
+            nm.latencyP50Ms = ls.p50Ms;
+            nm.latencyP99Ms = ls.p99Ms;
+            nm.latencyMaxMs = ls.maxMs;
+            nm.latencyBudgetMs = static_cast<double>(ls.budgetNs) / 1e6;
+            nm.overBudget = ls.overBudget;
+        }
+        if (auto* profiled = dynamic_cast<const StageProfileSink*>(topo->nodes[i].get())) {
+            nm.stages = profiled->stageProfiler().stats();
+            nm.deviceUtilization = profiled->stageProfiler().utilization();
+        }
+        if (auto* budgeted = dynamic_cast<const MemoryBudgetSink*>(topo->nodes[i].get())) {
+            nm.hasMemory = true;
+            nm.memoryBytes = budgeted->memoryAccount()->bytes();
+            nm.memoryPeakBytes = budgeted->memoryAccount()->peakBytes();
+            nm.memoryEstimateBytes = budgeted->estimateMemoryBytes();
+            out.memoryBytes += nm.memoryBytes;
+        }
+        out.nodes.push_back(std::move(nm));
+    }
+
+    std::lock_guard<std::mutex> lock(metricsMutex_);
+    auto now = std::chrono::steady_clock::now();
+    bool hasPrev = lastMetricsAt_ != std::chrono::steady_clock::time_point{};
+    double seconds = std::chrono::duration<double>(now - lastMetricsAt_).count();
+    std::unordered_map<LinkKey, LinkSample, LinkKeyHash> samples;
+
+    for (const auto& link : topo->links) {
+        const auto& key = *link.key;
+        LinkMetrics lm;
+        lm.srcNodeId = key.srcNodeId;
+        lm.srcPadName = key.srcPadName;
+        lm.dstNodeId = key.dstNodeId;
+        lm.dstPadName = key.dstPadName;
+        for (const auto& conn : link.srcPad->connections()) {
+            if (conn.targetPad.lock().get() != link.dstPad) continue;
+            if (conn.counters) {
+                lm.frames = conn.counters->frames.load(std::memory_order_relaxed);
+                lm.bytes = conn.counters->bytes.load(std::memory_order_relaxed);
+            }
+            if (conn.counters) {
+                lm.skipped = conn.counters->skipped.load(std::memory_order_relaxed);
+            }
+            if (conn.rate) {
+                lm.sourceFpsLimit = conn.rate->limitFps();
+            }
+            if (conn.queue) {
+                lm.drops = conn.queue->dropped();
+                lm.queueDepth = conn.queue->depth();
+            }
+            break;
+        }
+
+        auto prev = lastLinkSamples_.find(key);
+        // 连接重建后计数从 0 开始：按新连接处理
+        if (hasPrev && seconds > 0.0 && prev != lastLinkSamples_.end() && lm.frames >= prev->second.frames) {
+            lm.framesPerSec = static_cast<double>(lm.frames - prev->second.frames) / seconds;
+            lm.bytesPerSec = static_cast<double>(lm.bytes - prev->second.bytes) / seconds;
+        }
+        samples[key] = LinkSample{lm.frames, lm.bytes};
+        out.links.push_back(std::move(lm));
+    }
+    lastLinkSamples_ = std::move(samples);
+    lastMetricsAt_ = now;
+
+    std::sort(out.links.begin(), out.links.end(), [](const LinkMetrics& a, const LinkMetrics& b) {
+        return std::tie(a.srcNodeId, a.srcPadName, a.dstNodeId, a.dstPadName) <
+               std::tie(b.srcNodeId, b.srcPadName, b.dstNodeId, b.dstPadName);
+    });
+    return out;
+}
+
+void Pipeline::invalidateTopology() {
+    std::lock_guard<std::mutex> lock(topologyMutex_);
+    topology_.reset();
+    ++topologyVersion_;
+}
+
+std::shared_ptr<const Pipeline::Topology> Pipeline::topology() const {
+    std::lock_guard<std::mutex> lock(topologyMutex_);
+    if (topology_) {
+        return topology_;
+    }
+
+    auto topo = std::make_shared<Topology>();
+    topo->nodes.reserve(nodes_.size());
+    for (const auto& [id, node] : nodes_) {
+        (void)id;
+        topo->nodes.push_back(node);
+    }
+    std::sort(topo->nodes.begin(), topo->nodes.end(),
+              [](const std::shared_ptr<Node>& a, const std::shared_ptr<Node>& b) { return a->id() < b->id(); });
+    const auto count = static_cast<std::uint32_t>(topo->nodes.size());
+    std::unordered_map<std::string, std::uint32_t> indexById;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        topo->indexOf.emplace(topo->nodes[i].get(), i);
+        indexById.emplace(topo->nodes[i]->id(), i);
+    }
+
+    std::vector<std::vector<std::uint32_t>> outs(count);
+    topo->hasUpstream.assign(count, false);
+    for (const auto& key : links_) {
+        auto src = indexById.find(key.srcNodeId);
+        auto dst = indexById.find(key.dstNodeId);
+        if (src == indexById.end() || dst == indexById.end()) continue;
+        auto srcPad = topo->nodes[src->second]->getPad(key.srcPadName);
+        auto dstPad = topo->nodes[dst->second]->getPad(key.dstPadName);
+        if (!srcPad || !dstPad) continue;
+        topo->links.push_back({src->second, dst->second, srcPad.get(), dstPad.get(), &key});
+        topo->hasUpstream[dst->second] = true;
+        auto& o = outs[src->second];
+        // 同一对节点间的多条连接只计一次
+        if (std::find(o.begin(), o.end(), dst->second) == o.end()) o.push_back(dst->second);
+    }
+    topo->downstreamOffsets.reserve(count + 1);
+    topo->downstreamOffsets.push_back(0);
+    for (auto& o : outs) {
+        std::sort(o.begin(), o.end());
+        topo->downstream.insert(topo->downstream.end(), o.begin(), o.end());
+        topo->downstreamOffsets.push_back(static_cast<std::uint32_t>(topo->downstream.size()));
+    }
+
+    // Kahn 算法；节点下标即 ID 序，每层按下标排序保证顺序稳定
+    std::vector<std::uint32_t> inDegree(count, 0);
+    for (auto d : topo->downstream) ++inDegree[d];
+    std::vector<std::uint32_t> ready;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (inDegree[i] == 0) ready.push_back(i);
+    }
+    std::vector<std::uint32_t> next;
+    while (!ready.empty()) {
+        std::sort(ready.begin(), ready.end());
+        next.clear();
+        for (auto i : ready) {
+            topo->order.push_back(i);
+            for (auto k = topo->downstreamOffsets[i]; k < topo->downstreamOffsets[i + 1]; ++k) {
+                if (--inDegree[topo->downstream[k]] == 0) next.push_back(topo->downstream[k]);
+            }
+        }
+        ready.swap(next);
+    }
+    topo->acyclic = topo->order.size() == count;
+
+    topology_ = std::move(topo);
+    return topology_;
+}
+
+bool Pipeline::topologicalOrder(std::vector<std::string>& order) const {
+    auto topo = topology();
+    order.clear();
+    order.reserve(topo->order.size());
+    for (auto i : topo->order) {
+        order.push_back(topo->nodes[i]->id());
+    }
+    return topo->acyclic;
+}
+
+bool Pipeline::buildSchedule(std::vector<std::shared_ptr<Node>>& ordered,
+                             std::vector<bool>& isSource) const {
+    auto topo = topology();
+    if (!topo->acyclic) {
+        std::cerr << "[Pipeline] " << config_.pipelineId << ": link graph has a cycle" << std::endl;
+        return false;
+    }
+
+    ordered.clear();
+    isSource.clear();
+    ordered.reserve(topo->order.size());
+    isSource.reserve(topo->order.size());
+    for (auto i : topo->order) {
+        ordered.push_back(topo->nodes[i]);
+        isSource.push_back(!topo->hasUpstream[i]);
+    }
+    return true;
+}
+
+bool Pipeline::startNodes(const std::vector<std::shared_ptr<Node>>& ordered) {
+    // 下游先就绪（安装数据回调）再启动上游：节点依赖其全部下游节点，互不依赖的节点并行启动
+    auto topo = topology();
+    constexpr std::size_t kAbsent = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> position(topo->nodes.size(), kAbsent);  // 拓扑下标 → ordered 下标
+    for (std::size_t i = 0; i < ordered.size(); ++i) {
+        auto it = topo->indexOf.find(ordered[i].get());
+        if (it != topo->indexOf.end()) position[it->second] = i;
+    }
+    std::vector<std::vector<std::size_t>> prerequisites(ordered.size());
+    for (std::uint32_t n = 0; n < topo->nodes.size(); ++n) {
+        if (position[n] == kAbsent) continue;
+        for (auto k = topo->downstreamOffsets[n]; k < topo->downstreamOffsets[n + 1]; ++k) {
+            auto dst = position[topo->downstream[k]];
+            if (dst != kAbsent) prerequisites[position[n]].push_back(dst);
+        }
+    }
+
+    startFailures_.clear();
+    auto states = runWithDependencies(ordered.size(), prerequisites, config_.startThreads,
+                                      [&ordered](std::size_t i) {
+                                          // 节点 start（V4L2 打开与缓冲映射、backend 加载等）计入启动时间线
+                                          BootSpan span("start:" + ordered[i]->id(), "node");
+                                          return ordered[i]->start();
+                                      });
+
+    std::vector<std::shared_ptr<Node>> started;
+    std::size_t notRun = 0;
+    for (std::size_t i = 0; i < ordered.size(); ++i) {
+        if (states[i] == DependencyTaskState::Succeeded) {
+            started.push_back(ordered[i]);
+        } else if (states[i] == DependencyTaskState::Failed) {
+            startFailures_.push_back(ordered[i]->id());
+        } else {
+            ++notRun;
+        }
+    }
+    if (startFailures_.empty() && notRun == 0) {
+        startedNodes_.insert(startedNodes_.end(), started.begin(), started.end());
+        return true;
+    }
+
+    std::string failedList;
+    for (const auto& id : startFailures_) {
+        failedList += (failedList.empty() ? "" : ", ") + id;
+    }
+    std::cerr << "[Pipeline] " << config_.pipelineId << ": " << startFailures_.size()
+              << " node(s) failed to start (" << failedList << "), " << notRun
+              << " not started; rolling back " << started.size() << " started node(s)" << std::endl;
+    // 只回滚本次启动的节点，按拓扑序（上游先停）
+    for (const auto& node : started) {
+        node->stop();
+    }
+    return false;
+}
+
+void Pipeline::clearPixelFusion() {
+    for (const auto& [id, node] : nodes_) {
+        (void)id;
+        if (auto* stage = dynamic_cast<sensors::FusablePixelStage*>(node.get())) stage->setPixelFusion(nullptr);
+    }
+    fusedChains_.clear();
+}
+
+void Pipeline::planPixelFusion() {
+    clearPixelFusion();
+    if (!config_.fusePixelStages) return;
+    auto topo = topology();
+    auto stageOf = [](const std::shared_ptr<Node>& node) -> sensors::FusablePixelStage* {
+        auto* stage = dynamic_cast<sensors::FusablePixelStage*>(node.get());
+        return stage && stage->canFuse() ? stage : nullptr;
+    };
+    std::unordered_map<const Pad*, int> outgoing;
+    std::unordered_map<const Pad*, int> incoming;
+    for (const auto& link : topo->links) {
+        ++outgoing[link.srcPad];
+        ++incoming[link.dstPad];
+    }
+    // 可融合的连接：两端均为图像主通路 Pad，且上游输出与下游输入都只有这一条连接（无分支、无 Tap）
+    constexpr std::uint32_t kNone = ~0u;
+    std::vector<std::uint32_t> next(topo->nodes.size(), kNone);
+    std::vector<bool> fusedInput(topo->nodes.size(), false);
+    for (const auto& link : topo->links) {
+        auto* from = stageOf(topo->nodes[link.src]);
+        auto* to = stageOf(topo->nodes[link.dst]);
+        if (!from || !to || link.srcPad != from->fusionOutputPad() || link.dstPad != to->fusionInputPad() ||
+            outgoing[link.srcPad] != 1 || incoming[link.dstPad] != 1) {
+            continue;
+        }
+        next[link.src] = link.dst;
+        fusedInput[link.dst] = true;
+    }
+    for (std::uint32_t head : topo->order) {
+        if (next[head] == kNone || fusedInput[head]) continue;
+        std::vector<sensors::FusablePixelStage*> stages;
+        std::vector<std::string> ids;
+        for (std::uint32_t i = head; i != kNone; i = next[i]) {
+            stages.push_back(stageOf(topo->nodes[i]));
+            ids.push_back(topo->nodes[i]->id());
+        }
+        stages.front()->setPixelFusion(std::make_shared<sensors::FusedPixelChain>(std::move(stages)));
+        std::cout << "[Pipeline] " << config_.pipelineId << ": fused pixel stages";
+        for (std::size_t i = 0; i < ids.size(); ++i) std::cout << (i == 0 ? " " : " -> ") << ids[i];
+        std::cout << std::endl;
+        fusedChains_.push_back(std::move(ids));
+    }
+}
+
+void Pipeline::planBranchSwitches() {
+    auto topo = topology();
+    const std::size_t n = topo->nodes.size();
+    auto routes = std::make_shared<BranchRoutes>();
+    std::vector<std::uint32_t> switches;
+    for (std::uint32_t i = 0; i < n; ++i) {
+        if (dynamic_cast<BranchSwitch*>(topo->nodes[i].get())) switches.push_back(i);
+    }
+    for (std::uint32_t sw : switches) {
+        std::unordered_set<const Pad*> outputs;
+        for (const auto& link : topo->links) {
+            if (link.src == sw) outputs.insert(link.srcPad);
+        }
+        for (const Pad* output : outputs) {
+            // 从该输出的直连下游出发取可达节点，再逐轮剔除还有其他来源输入的节点，剩下的只经由该输出供数
+            std::vector<char> inBranch(n, 0);
+            std::vector<std::uint32_t> stack;
+            for (const auto& link : topo->links) {
+                if (link.srcPad == output && !inBranch[link.dst]) {
+                    inBranch[link.dst] = 1;
+                    stack.push_back(link.dst);
+                }
+            }
+            while (!stack.empty()) {
+                const std::uint32_t v = stack.back();
+                stack.pop_back();
+                for (std::uint32_t k = topo->downstreamOffsets[v]; k < topo->downstreamOffsets[v + 1]; ++k) {
+                    const std::uint32_t d = topo->downstream[k];
+                    if (!inBranch[d]) {
+                        inBranch[d] = 1;
+                        stack.push_back(d);
+                    }
+                }
+            }
+            for (bool changed = true; changed;) {
+                changed = false;
+                for (const auto& link : topo->links) {
+                    if (inBranch[link.dst] && link.srcPad != output && !inBranch[link.src]) {
+                        inBranch[link.dst] = 0;
+                        changed = true;
+                    }
+                }
+            }
+            std::vector<std::string> idle;
+            for (std::uint32_t i : topo->order) {
+                if (inBranch[i] && dynamic_cast<BranchIdleSink*>(topo->nodes[i].get())) {
+                    idle.push_back(topo->nodes[i]->id());
+                }
+            }
+            if (!idle.empty()) routes->idleNodes[output] = std::move(idle);
+        }
+    }
+    if (switches.empty()) return;
+    routes->scheduler = scheduler_.get();
+    branchRoutes_ = routes;
+    for (std::uint32_t sw : switches) {
+        auto* branchSwitch = dynamic_cast<BranchSwitch*>(topo->nodes[sw].get());
+        branchSwitch->setBranchClosedCallback([routes](Pad* output) {
+            std::lock_guard<std::mutex> lock(routes->mutex);
+            auto it = routes->idleNodes.find(output);
+            if (!routes->scheduler || it == routes->idleNodes.end()) return;
+            for (const auto& id : it->second) routes->scheduler->requestIdleRelease(id);
+        });
+    }
+}
+
+void Pipeline::clearBranchSwitches() {
+    if (!branchRoutes_) return;
+    {
+        // 先断开调度器再清除回调：正在执行的回调持有 routes->mutex，返回后不再访问调度器
+        std::lock_guard<std::mutex> lock(branchRoutes_->mutex);
+        branchRoutes_->scheduler = nullptr;
+    }
+    branchRoutes_.reset();
+    for (const auto& [id, node] : nodes_) {
+        (void)id;
+        if (auto* branchSwitch = dynamic_cast<BranchSwitch*>(node.get())) branchSwitch->setBranchClosedCallback(nullptr);
+    }
+}
+
+void Pipeline::stopNodes() {
+    clearPixelFusion();
+    // 拓扑序停止：上游先停，避免下游停止后仍收到数据
+    for (const auto& node : startedNodes_) {
+        node->stop();
+    }
+    startedNodes_.clear();
+}
+
+void Pipeline::stopNodes(const std::vector<std::shared_ptr<Node>>& nodes) {
+    for (const auto& node : nodes) {
+        auto it = std::find(startedNodes_.begin(), startedNodes_.end(), node);
+        if (it == startedNodes_.end()) continue;
+        node->stop();
+        startedNodes_.erase(it);
+    }
+}
+
+bool Pipeline::startPlaying() {
+    std::vector<std::shared_ptr<Node>> ordered;
+    std::vector<bool> isSource;
+    if (!buildSchedule(ordered, isSource)) {
+        return false;
+    }
+    // 已启动的节点保持运行，只启动尚未启动的（首次启动或 Paused 期间新增的）节点
+    std::vector<std::shared_ptr<Node>> pending;
+    for (const auto& node : ordered) {
+        if (std::find(startedNodes_.begin(), startedNodes_.end(), node) == startedNodes_.end()) {
+            pending.push_back(node);
+        }
+    }
+    if (!startNodes(pending)) {
+        return false;
+    }
+    // 保持 startedNodes_ 为拓扑序，供 stopNodes 使用
+    std::vector<std::shared_ptr<Node>> started;
+    for (const auto& node : ordered) {
+        if (std::find(startedNodes_.begin(), startedNodes_.end(), node) != startedNodes_.end()) {
+            started.push_back(node);
+        }
+    }
+    startedNodes_.swap(started);
+    {
+        std::lock_guard<std::mutex> lock(topologyMutex_);
+        scheduledVersion_ = topologyVersion_;
+    }
+    planPixelFusion();
+    if (!scheduler_->start(ordered, isSource)) {
+        clearPixelFusion();
+        stopNodes(pending);
+        return false;
+    }
+    planBranchSwitches();
+    return true;
+}
+
 bool Pipeline::setState(PipelineState newState) {
-    // Week1 skeleton: 不做复杂状态机，仅记录状态。
+    if (newState == state_) {
+        return true;
+    }
+    switch (newState) {
+        case PipelineState::Playing: {
+            bool resumed = state_ == PipelineState::Paused;
+            if (resumed && scheduler_->isPaused()) {
+                bool unchanged = false;
+                {
+                    std::lock_guard<std::mutex> lock(topologyMutex_);
+                    unchanged = scheduledVersion_ == topologyVersion_;
+                }
+                if (unchanged) {
+                    // 快速路径：节点与调度线程都在，只恢复数据产生
+                    for (const auto& node : startedNodes_) {
+                        node->resume();
+                    }
+                    scheduler_->resume();
+                    break;
+                }
+                // Paused 期间增删了节点或连接：按新拓扑重建调度（已启动的节点不重启）
+                clearBranchSwitches();
+                scheduler_->stop();
+            }
+            if (resumed) {
+                for (const auto& node : startedNodes_) {
+                    node->resume();
+                }
+            }
+            if (!startPlaying()) {
+                return false;
+            }
+            break;
+        }
+        case PipelineState::Paused:
+            if (scheduler_->isRunning()) {
+                if (!scheduler_->pause()) {
+                    scheduler_->resume();
+                    return false;
+                }
+                for (const auto& node : startedNodes_) {
+                    node->pause();
+                }
+            }
+            break;
+        case PipelineState::Ready:
+        case PipelineState::Null:
+            clearBranchSwitches();
+            scheduler_->stop();
+            stopNodes();
+            break;
+    }
     state_ = newState;
     return true;
 }
@@ -0,0 +1,116 @@
+#include "falconmind/sdk/core/PipelineClock.h"
+
+#include <algorithm>
+#include <chrono>
+#ifdef __linux__
+#include <time.h>
+#endif
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+// 虚拟时钟：nowNs() 热路径只读 g_virtual
+std::atomic<bool> g_virtual{false};
+std::atomic<std::int64_t> g_virtualNs{0};
+
+} // namespace
+
+void PipelineClock::enableVirtual(std::int64_t startNs) noexcept {
+    g_virtualNs.store(startNs, std::memory_order_relaxed);
+    g_virtual.store(true, std::memory_order_release);
+}
+
+void PipelineClock::disableVirtual() noexcept {
+    g_virtual.store(false, std::memory_order_release);
+}
+
+bool PipelineClock::isVirtual() noexcept {
+    return g_virtual.load(std::memory_order_acquire);
+}
+
+void PipelineClock::advanceVirtualTo(std::int64_t ns) noexcept {
+    std::int64_t cur = g_virtualNs.load(std::memory_order_relaxed);
+    while (ns > cur && !g_virtualNs.compare_exchange_weak(cur, ns, std::memory_order_relaxed)) {
+    }
+}
+
+std::int64_t PipelineClock::nowNs() noexcept {
+    if (g_virtual.load(std::memory_order_relaxed)) {
+        return g_virtualNs.load(std::memory_order_relaxed);
+    }
+#ifdef __linux__
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<std::int64_t>(ts.tv_sec) * 1000000000ll + ts.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+std::uint64_t LatencyTracker::record(std::int64_t captureNs, std::int64_t nowNs) noexcept {
+    if (captureNs <= 0) {
+        return 0;
+    }
+    std::int64_t latency = nowNs > captureNs ? nowNs - captureNs : 0;
+    histogram_.record(static_cast<std::uint64_t>(latency));
+    std::int64_t budget = budgetNs();
+    if (budget > 0 && latency > budget) {
+        return overBudget_.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    return 0;
+}
+
+LatencyStats LatencyTracker::stats() const noexcept {
+    LatencyStats s;
+    s.count = histogram_.count();
+    s.overBudget = overBudget_.load(std::memory_order_relaxed);
+    s.budgetNs = budgetNs();
+    s.p50Ms = static_cast<double>(histogram_.percentile(0.50)) / 1e6;
+    s.p99Ms = static_cast<double>(histogram_.percentile(0.99)) / 1e6;
+    s.maxMs = static_cast<double>(histogram_.max()) / 1e6;
+    return s;
+}
+
+StageProfiler::StageProfiler(std::vector<std::string> stages) : names_(std::move(stages)) {
+    if (names_.size() > kMaxStages) names_.resize(kMaxStages);
+}
+
+void StageProfiler::recordUs(std::size_t stage, std::uint64_t us) noexcept {
+    if (stage >= names_.size()) return;
+    histograms_[stage].record(us * 1000);
+    sumUs_[stage].fetch_add(us, std::memory_order_relaxed);
+}
+
+void StageProfiler::recordUtilization(double utilization) noexcept {
+    if (utilization < 0.0) return;
+    utilizationPpm_.fetch_add(static_cast<std::uint64_t>(std::min(utilization, 1.0) * 1e6),
+                              std::memory_order_relaxed);
+    utilizationSamples_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<StageMetrics> StageProfiler::stats() const {
+    std::vector<StageMetrics> out;
+    for (std::size_t i = 0; i < names_.size(); ++i) {
+        const auto& h = histograms_[i];
+        StageMetrics m;
+        m.count = h.count();
+        if (m.count == 0) continue;
+        m.name = names_[i];
+        m.meanUs = static_cast<double>(sumUs_[i].load(std::memory_order_relaxed)) / static_cast<double>(m.count);
+        m.p50Us = static_cast<double>(h.percentile(0.50)) / 1e3;
+        m.p99Us = static_cast<double>(h.percentile(0.99)) / 1e3;
+        m.maxUs = static_cast<double>(h.max()) / 1e3;
+        out.push_back(std::move(m));
+    }
+    return out;
+}
+
+double StageProfiler::utilization() const noexcept {
+    const std::uint64_t n = utilizationSamples_.load(std::memory_order_relaxed);
+    if (n == 0) return -1.0;
+    return static_cast<double>(utilizationPpm_.load(std::memory_order_relaxed)) / 1e6 / static_cast<double>(n);
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,142 @@
+#include "falconmind/sdk/core/PipelineMetrics.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace falconmind::sdk::core {
+
+std::size_t LatencyHistogram::bucketIndex(std::uint64_t ns) noexcept {
+    if (ns < kSubBuckets) {
+        return static_cast<std::size_t>(ns);
+    }
+    // msb >= 2：桶号 = (msb - 1) * 4 + 次高两位
+    std::size_t msb = 63 - static_cast<std::size_t>(__builtin_clzll(ns));
+    std::size_t sub = static_cast<std::size_t>(ns >> (msb - 2)) & (kSubBuckets - 1);
+    std::size_t index = (msb - 1) * kSubBuckets + sub;
+    return std::min(index, kBuckets - 1);
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t index) noexcept {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    std::size_t msb = index / kSubBuckets + 1;
+    std::uint64_t sub = index % kSubBuckets;
+    std::uint64_t width = std::uint64_t{1} << (msb - 2);
+    return ((kSubBuckets + sub) << (msb - 2)) + width - 1;
+}
+
+void LatencyHistogram::record(std::uint64_t ns) noexcept {
+    buckets_[bucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+    std::uint64_t prev = max_.load(std::memory_order_relaxed);
+    while (ns > prev && !max_.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {
+    }
+}
+
+std::uint64_t LatencyHistogram::count() const noexcept {
+    std::uint64_t total = 0;
+    for (const auto& b : buckets_) {
+        total += b.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::uint64_t LatencyHistogram::percentile(double q) const noexcept {
+    std::array<std::uint64_t, kBuckets> counts{};
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    q = std::clamp(q, 0.0, 1.0);
+    auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(total)));
+    if (rank == 0) rank = 1;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), max());
+        }
+    }
+    return max();
+}
+
+std::string toJson(const PipelineMetrics& metrics) {
+    nlohmann::json j;
+    j["pipeline_id"] = metrics.pipelineId;
+    j["timestamp_ns"] = metrics.timestampNs;
+    j["nodes"] = nlohmann::json::array();
+    for (const auto& n : metrics.nodes) {
+        nlohmann::json node = {{"node_id", n.nodeId},
+                               {"process_count", n.processCount},
+                               {"p50_us", n.p50Us},
+                               {"p99_us", n.p99Us},
+                               {"max_us", n.maxUs},
+                               {"cpu_ms", n.cpuMs},
+                               {"queue_depth", n.queueDepth}};
+        if (n.perf.available != 0) {
+            nlohmann::json perf = nlohmann::json::object();
+            for (std::size_t i = 0; i < static_cast<std::size_t>(PerfCounter::Count); ++i) {
+                const auto c = static_cast<PerfCounter>(i);
+                if (n.perf.has(c)) perf[perfCounterName(c)] = n.perf[c];
+            }
+            if (n.perf.ipc() >= 0.0) perf["ipc"] = n.perf.ipc();
+            node["perf"] = std::move(perf);
+        }
+        if (n.hasDeadline) {
+            node["deadline"] = {{"deadline_ms", n.deadlineMs},
+                                {"misses", n.deadlineMisses},
+                                {"max_lateness_ms", n.maxLatenessMs}};
+        }
+        if (n.hasLatency) {
+            node["latency"] = {{"p50_ms", n.latencyP50Ms},
+                               {"p99_ms", n.latencyP99Ms},
+                               {"max_ms", n.latencyMaxMs},
+                               {"budget_ms", n.latencyBudgetMs},
+                               {"over_budget", n.overBudget}};
+        }
+        if (!n.stages.empty()) {
+            node["stages"] = nlohmann::json::array();
+            for (const auto& st : n.stages) {
+                node["stages"].push_back({{"name", st.name},
+                                          {"count", st.count},
+                                          {"mean_us", st.meanUs},
+                                          {"p50_us", st.p50Us},
+                                          {"p99_us", st.p99Us},
+                                          {"max_us", st.maxUs}});
+            }
+        }
+        if (n.deviceUtilization >= 0.0) node["device_utilization"] = n.deviceUtilization;
+        if (n.hasMemory) {
+            node["memory"] = {{"bytes", n.memoryBytes},
+                              {"peak_bytes", n.memoryPeakBytes},
+                              {"estimate_bytes", n.memoryEstimateBytes}};
+        }
+        j["nodes"].push_back(std::move(node));
+    }
+    j["links"] = nlohmann::json::array();
+    for (const auto& l : metrics.links) {
+        j["links"].push_back({{"src_node_id", l.srcNodeId},
+                              {"src_pad_name", l.srcPadName},
+                              {"dst_node_id", l.dstNodeId},
+                              {"dst_pad_name", l.dstPadName},
+                              {"frames", l.frames},
+                              {"bytes", l.bytes},
+                              {"drops", l.drops},
+                              {"skipped", l.skipped},
+                              {"source_fps_limit", l.sourceFpsLimit},
+                              {"queue_depth", l.queueDepth},
+                              {"frames_per_sec", l.framesPerSec},
+                              {"bytes_per_sec", l.bytesPerSec}});
+    }
+    j["memory_bytes"] = metrics.memoryBytes;
+    if (metrics.memoryBudgetBytes > 0) j["memory_budget_bytes"] = metrics.memoryBudgetBytes;
+    return j.dump();
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,816 @@
+#include "falconmind/sdk/core/PipelineScheduler.h"
+#include "falconmind/sdk/core/AsyncNode.h"
+#include "falconmind/sdk/core/BranchSwitch.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/core/Trace.h"
+
+#include <algorithm>
+#include <ctime>
+#include <exception>
+#include <functional>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+std::uint64_t threadCpuNs() {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<std::uint64_t>(ts.tv_nsec);
+}
+
+std::int64_t steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+PipelineScheduler::PipelineScheduler(const PipelineSchedulerConfig& cfg)
+    : config_(cfg) {}
+
+PipelineScheduler::~PipelineScheduler() {
+    stop();
+}
+
+void PipelineScheduler::setNodePeriod(const std::string& nodeId, std::chrono::microseconds period) {
+    nodePeriods_[nodeId] = period;
+}
+
+bool PipelineScheduler::start(const std::vector<std::shared_ptr<Node>>& orderedNodes,
+                              const std::vector<bool>& isSource) {
+    if (running_) {
+        return true;
+    }
+    if (orderedNodes.size() != isSource.size()) {
+        FM_LOG_ERROR("PipelineScheduler", "node/source list size mismatch");
+        return false;
+    }
+
+    entries_.clear();
+    indexById_.clear();
+    entries_.reserve(orderedNodes.size());
+    for (std::size_t i = 0; i < orderedNodes.size(); ++i) {
+        if (!orderedNodes[i]) continue;
+        auto entry = std::make_unique<Entry>();
+        entry->node = orderedNodes[i];
+        entry->traceName = Tracer::intern(entry->node->id());
+        entry->isSource = isSource[i];
+        const NodePlacement& placement = entry->node->placement();
+        auto periodIt = nodePeriods_.find(entry->node->id());
+        entry->period = periodIt != nodePeriods_.end() ? periodIt->second
+                      : placement.period.count() > 0   ? placement.period
+                                                       : config_.sourcePeriod;
+        entry->dedicated = !entry->isSource && placement.pinsThread();
+        entry->critical = placement.critical();
+        entry->edf = entry->critical && !entry->isSource && !entry->dedicated && config_.criticalWorkers > 0;
+        entry->deadlineNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                placement.deadline.count() > 0 ? placement.deadline
+                                : entry->isSource              ? entry->period
+                                                               : placement.effectiveDeadline())
+                                .count();
+        entry->idleSink = dynamic_cast<BranchIdleSink*>(entry->node.get());
+        entry->async = dynamic_cast<AsyncNode*>(entry->node.get());
+        if (config_.manual) {
+            // 手动步进在调用方线程串行执行全部节点
+            entry->dedicated = false;
+            entry->critical = false;
+            entry->edf = false;
+            if (entry->isSource) entry->timed = dynamic_cast<TimedSource*>(entry->node.get());
+        }
+        for (const auto& [name, pad] : entry->node->pads()) {
+            (void)name;
+            if (pad && pad->type() != PadType::Source) entry->inputs.push_back(pad);
+        }
+        indexById_[entry->node->id()] = entries_.size();
+        entries_.push_back(std::move(entry));
+    }
+
+    std::size_t workers = config_.workerThreads;
+    if (workers == 0) {
+        workers = std::thread::hardware_concurrency();
+        if (workers == 0) workers = 1;
+    }
+    if (config_.manual) workers = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        readyQueue_.clear();
+        edfQueue_.clear();
+    }
+    std::size_t asyncNodes = 0;
+    for (auto& entry : entries_) {
+        if (!entry->async) continue;
+        if (!asyncLoop_) {
+            asyncLoop_ = std::make_unique<AsyncLoop>();
+            if (!asyncLoop_->start("async")) {
+                FM_LOG_ERROR("PipelineScheduler", "cannot start async loop");
+                asyncLoop_.reset();
+                entries_.clear();
+                indexById_.clear();
+                return false;
+            }
+        }
+        // 先于 Source 线程建立，接管输入 Pad 的回调
+        entry->asyncContext = std::make_unique<AsyncContext>(*asyncLoop_, *entry->node);
+        ++asyncNodes;
+    }
+    installArrivalHooks(true);
+    paused_ = false;
+    running_ = true;
+    if (!config_.manual) installFanOut(true);
+
+    // 预留了关键 CPU 时共享线程池绑定到其余 CPU
+    NodePlacement workerPlacement;
+    if (!config_.criticalCpus.empty()) {
+        unsigned cpus = std::thread::hardware_concurrency();
+        for (unsigned cpu = 0; cpu < cpus; ++cpu) {
+            if (std::find(config_.criticalCpus.begin(), config_.criticalCpus.end(), static_cast<int>(cpu)) ==
+                config_.criticalCpus.end()) {
+                workerPlacement.cpus.push_back(static_cast<int>(cpu));
+            }
+        }
+    }
+    for (std::size_t i = 0; i < workers; ++i) {
+        workerThreads_.emplace_back(&PipelineScheduler::workerLoop, this, workerPlacement);
+    }
+    std::size_t criticalWorkers = 0;
+    if (std::any_of(entries_.begin(), entries_.end(), [](const auto& e) { return e->edf; })) {
+        criticalWorkers = config_.criticalWorkers;
+        for (std::size_t i = 0; i < criticalWorkers; ++i) {
+            criticalThreads_.emplace_back(&PipelineScheduler::criticalLoop, this);
+        }
+    }
+    std::size_t dedicated = 0;
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+        if (Entry& entry = *entries_[i]; entry.async) {
+            AsyncNode* node = entry.async;
+            AsyncContext* ctx = entry.asyncContext.get();
+            const char* id = entry.traceName;
+            asyncLoop_->post([node, ctx, id] {
+                FM_TRACE_SCOPE("node", id);
+                try {
+                    node->startAsync(*ctx);
+                } catch (const std::exception& e) {
+                    FM_LOG_ERROR("PipelineScheduler", "node ", id, " startAsync() threw: ", e.what());
+                }
+            });
+        } else if (entries_[i]->isSource) {
+            if (!config_.manual) sourceThreads_.emplace_back(&PipelineScheduler::sourceLoop, this, i);
+        } else if (entries_[i]->dedicated) {
+            dedicatedThreads_.emplace_back(&PipelineScheduler::dedicatedLoop, this, i);
+            ++dedicated;
+        }
+    }
+
+    FM_LOG_INFO("PipelineScheduler", "started: ", sourceThreads_.size(), " source thread(s), ", workers,
+                " worker thread(s), ", criticalWorkers, " critical thread(s), ", dedicated, " pinned node thread(s), ",
+                asyncNodes, " async node(s)");
+    return true;
+}
+
+void PipelineScheduler::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    // 先停 Source，避免停止过程中继续产生新数据
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    sleepCv_.notify_all();
+    for (auto& t : sourceThreads_) {
+        if (t.joinable()) t.join();
+    }
+    sourceThreads_.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        readyQueue_.clear();
+        edfQueue_.clear();
+    }
+    queueCv_.notify_all();
+    criticalCv_.notify_all();
+    for (auto& t : workerThreads_) {
+        if (t.joinable()) t.join();
+    }
+    workerThreads_.clear();
+    for (auto& t : criticalThreads_) {
+        if (t.joinable()) t.join();
+    }
+    criticalThreads_.clear();
+    wakeDedicated();
+    for (auto& t : dedicatedThreads_) {
+        if (t.joinable()) t.join();
+    }
+    dedicatedThreads_.clear();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        fanOutQueue_.clear();
+    }
+
+    installFanOut(false);
+    installArrivalHooks(false);
+    stopAsync();
+    paused_ = false;
+    for (auto& entry : entries_) {
+        entry->state = 0;
+        entry->nextReleaseNs = 0;
+    }
+    FM_LOG_INFO("PipelineScheduler", "stopped");
+}
+
+bool PipelineScheduler::pause(std::chrono::milliseconds timeout) {
+    if (!running_) {
+        return false;
+    }
+    // 在两把调度锁下置位：Source/工作线程在同一把锁下检查暂停并登记 busy_，不会漏算即将开始的 process()
+    {
+        std::lock_guard<std::mutex> sleepLock(sleepMutex_);
+        std::lock_guard<std::mutex> queueLock(queueMutex_);
+        paused_ = true;
+    }
+    std::unique_lock<std::mutex> lock(idleMutex_);
+    if (!idleCv_.wait_for(lock, timeout, [this]() { return busy_.load() == 0; })) {
+        FM_LOG_WARN("PipelineScheduler", "pause: process() still running after ", timeout.count(), "ms");
+        return false;
+    }
+    return true;
+}
+
+void PipelineScheduler::resume() {
+    if (!running_ || !paused_.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    sleepCv_.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+    }
+    queueCv_.notify_all();
+    criticalCv_.notify_all();
+    wakeDedicated();
+    // 暂停期间工作线程未取空的队列不会再有到达通知，主动补调度
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+        if (!entries_[i]->isSource && hasQueuedInput(*entries_[i])) {
+            notify(i);
+        }
+    }
+}
+
+std::uint64_t PipelineScheduler::processCount(const std::string& nodeId) const {
+    auto it = indexById_.find(nodeId);
+    if (it == indexById_.end()) {
+        return 0;
+    }
+    return entries_[it->second]->processCount.load();
+}
+
+bool PipelineScheduler::nodeMetrics(const std::string& nodeId, NodeMetrics& out) const {
+    auto it = indexById_.find(nodeId);
+    if (it == indexById_.end()) {
+        return false;
+    }
+    const auto& entry = *entries_[it->second];
+    out.nodeId = nodeId;
+    out.processCount = entry.processCount.load(std::memory_order_relaxed);
+    out.p50Us = static_cast<double>(entry.latency.percentile(0.50)) / 1000.0;
+    out.p99Us = static_cast<double>(entry.latency.percentile(0.99)) / 1000.0;
+    out.maxUs = static_cast<double>(entry.latency.max()) / 1000.0;
+    out.cpuMs = static_cast<double>(entry.cpuNs.load(std::memory_order_relaxed)) / 1e6;
+    out.perf.available = entry.perfAvailable.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < entry.perf.size(); ++i) {
+        out.perf.value[i] = entry.perf[i].load(std::memory_order_relaxed);
+    }
+    out.queueDepth = 0;
+    for (const auto& pad : entry.inputs) {
+        out.queueDepth += pad->queuedDepth();
+    }
+    out.hasDeadline = entry.critical;
+    if (entry.critical) {
+        out.deadlineMs = static_cast<double>(entry.deadlineNs) / 1e6;
+        out.deadlineMisses = entry.deadlineMisses.load(std::memory_order_relaxed);
+        out.maxLatenessMs = static_cast<double>(entry.maxLatenessNs.load(std::memory_order_relaxed)) / 1e6;
+    }
+    return true;
+}
+
+bool PipelineScheduler::takeActivity(const std::string& nodeId, NodeActivity& out) {
+    auto it = indexById_.find(nodeId);
+    if (it == indexById_.end()) {
+        return false;
+    }
+    auto& entry = *entries_[it->second];
+    out.processCount = entry.processCount.load(std::memory_order_relaxed);
+    std::int64_t started = entry.processStartNs.load(std::memory_order_relaxed);
+    out.runningForNs = started != 0 ? std::max<std::int64_t>(0, steadyNs() - started) : 0;
+    out.windowMaxNs = entry.windowMaxNs.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+bool PipelineScheduler::setRateDivisor(const std::string& nodeId, std::uint32_t divisor) {
+    auto it = indexById_.find(nodeId);
+    if (it == indexById_.end() || entries_[it->second]->isSource) {
+        return false;
+    }
+    entries_[it->second]->rateDivisor.store(std::max<std::uint32_t>(1, divisor), std::memory_order_relaxed);
+    return true;
+}
+
+std::uint32_t PipelineScheduler::rateDivisor(const std::string& nodeId) const {
+    auto it = indexById_.find(nodeId);
+    return it == indexById_.end() ? 1 : entries_[it->second]->rateDivisor.load(std::memory_order_relaxed);
+}
+
+std::size_t PipelineScheduler::runOnce(std::int64_t nowNs) {
+    if (!running_ || paused_ || !config_.manual) {
+        return 0;
+    }
+    std::uint64_t before = 0;
+    for (const auto& entry : entries_) before += entry->processCount.load(std::memory_order_relaxed);
+
+    for (auto& entryPtr : entries_) {
+        Entry& entry = *entryPtr;
+        if (!entry.isSource || entry.async) continue;
+        if (entry.timed) {
+            if (entry.timed->nextDueNs() > nowNs) continue;
+        } else {
+            if (entry.nextDueNs > nowNs) continue;
+            const std::int64_t periodNs = std::chrono::duration_cast<std::chrono::nanoseconds>(entry.period).count();
+            if (periodNs > 0) {
+                entry.nextDueNs = (entry.nextDueNs == 0 ? nowNs : entry.nextDueNs) + periodNs;
+                if (entry.nextDueNs <= nowNs) entry.nextDueNs = nowNs + periodNs;  // 不追帧
+            }
+        }
+        busy_.fetch_add(1);
+        runNode(entry);
+    }
+    // 下游：到达回调已把收到数据的节点放入就绪队列，执行中产生的新数据继续入队
+    for (;;) {
+        std::size_t index = 0;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            if (readyQueue_.empty()) break;
+            index = readyQueue_.front();
+            readyQueue_.pop_front();
+            busy_.fetch_add(1);
+        }
+        runScheduled(index, true);
+    }
+
+    std::uint64_t after = 0;
+    for (const auto& entry : entries_) after += entry->processCount.load(std::memory_order_relaxed);
+    return static_cast<std::size_t>(after - before);
+}
+
+std::int64_t PipelineScheduler::nextSourceDueNs() const {
+    std::int64_t next = TimedSource::kNever;
+    for (const auto& entry : entries_) {
+        if (!entry->isSource || entry->async) continue;
+        next = std::min(next, entry->timed ? entry->timed->nextDueNs() : entry->nextDueNs);
+    }
+    return next;
+}
+
+bool PipelineScheduler::timedSourcesFinished() const {
+    bool any = false;
+    for (const auto& entry : entries_) {
+        if (!entry->timed) continue;
+        if (entry->timed->nextDueNs() != TimedSource::kNever) return false;
+        any = true;
+    }
+    return any;
+}
+
+void PipelineScheduler::stopAsync() {
+    if (!asyncLoop_) return;
+    // 停循环时以“已取消”结果回调未触发的等待，再关闭上下文唤醒挂起的 read()，最后通知节点
+    asyncLoop_->stop();
+    for (auto& entry : entries_) {
+        if (!entry->asyncContext) continue;
+        entry->asyncContext->close();
+        try {
+            entry->async->stopAsync();
+        } catch (const std::exception& e) {
+            FM_LOG_ERROR("PipelineScheduler", "node ", entry->node->id(), " stopAsync() threw: ", e.what());
+        }
+        entry->asyncContext.reset();
+    }
+    asyncLoop_.reset();
+}
+
+void PipelineScheduler::installArrivalHooks(bool install) {
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+        if (entries_[i]->isSource && !entries_[i]->async) continue;
+        for (const auto& pad : entries_[i]->inputs) {
+            if (install && entries_[i]->asyncContext) {
+                AsyncContext* ctx = entries_[i]->asyncContext.get();
+                pad->setArrivalCallback([ctx]() { ctx->notifyArrival(); });
+            } else if (install) {
+                pad->setArrivalCallback([this, i]() { notify(i); });
+            } else {
+                pad->setArrivalCallback(nullptr);
+            }
+        }
+    }
+}
+
+void PipelineScheduler::wakeDedicated() {
+    for (auto& entry : entries_) {
+        if (!entry->dedicated) continue;
+        {
+            std::lock_guard<std::mutex> lock(entry->wakeMutex);
+        }
+        entry->wakeCv.notify_all();
+    }
+}
+
+void PipelineScheduler::installFanOut(bool install) {
+    if (config_.parallelFanOutMin == 0) {
+        return;
+    }
+    for (const auto& entry : entries_) {
+        for (const auto& [name, pad] : entry->node->pads()) {
+            (void)name;
+            if (!pad || pad->type() == PadType::Sink) continue;
+            if (install) {
+                pad->setFanOutExecutor([this](std::size_t count, const std::function<void(std::size_t)>& task) {
+                    runFanOut(count, task);
+                }, config_.parallelFanOutMin);
+            } else {
+                pad->setFanOutExecutor(nullptr);
+            }
+        }
+    }
+}
+
+void PipelineScheduler::runFanOut(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (count <= 1 || !running_) {
+        for (std::size_t i = 0; i < count; ++i) task(i);
+        return;
+    }
+    auto job = std::make_shared<FanOutJob>();
+    job->count = count;
+    job->task = &task;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        fanOutQueue_.push_back(job);
+    }
+    for (std::size_t i = 1; i < count; ++i) {
+        queueCv_.notify_one();
+    }
+    // 推送线程同样认领：工作线程全忙时退化为依次投递，不会死等
+    helpFanOut(*job);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        auto it = std::find(fanOutQueue_.begin(), fanOutQueue_.end(), job);
+        if (it != fanOutQueue_.end()) fanOutQueue_.erase(it);
+    }
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->cv.wait(lock, [&job]() { return job->done.load() == job->count; });
+}
+
+void PipelineScheduler::helpFanOut(FanOutJob& job) {
+    for (;;) {
+        std::size_t i = job.next.fetch_add(1);
+        if (i >= job.count) {
+            return;
+        }
+        try {
+            (*job.task)(i);
+        } catch (const std::exception& e) {
+            FM_LOG_ERROR("PipelineScheduler", "fan-out delivery threw: ", e.what());
+        } catch (...) {
+            FM_LOG_ERROR("PipelineScheduler", "fan-out delivery threw unknown exception");
+        }
+        // 最后一个完成者唤醒推送线程；之后不再访问 task（其所在栈帧随推送返回失效）
+        if (job.done.fetch_add(1) + 1 == job.count) {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            job.cv.notify_all();
+        }
+    }
+}
+
+void PipelineScheduler::requestIdleRelease(const std::string& nodeId) {
+    if (!running_) return;
+    auto it = indexById_.find(nodeId);
+    if (it == indexById_.end() || !entries_[it->second]->idleSink || entries_[it->second]->isSource) return;
+    entries_[it->second]->idleRequested.store(true);
+    notify(it->second);
+}
+
+void PipelineScheduler::notify(std::size_t index) {
+    if (!running_ || index >= entries_.size()) {
+        return;
+    }
+    auto& entry = *entries_[index];
+    if (entry.async) return;
+    int s = entry.state.load();
+    for (;;) {
+        if (s == 0) {
+            if (entry.state.compare_exchange_weak(s, 1)) {
+                if (entry.critical) entry.releaseNs.store(PipelineClock::nowNs(), std::memory_order_relaxed);
+                if (entry.edf) {
+                    pushEdf(index);
+                    return;
+                }
+                if (entry.dedicated) {
+                    {
+                        std::lock_guard<std::mutex> lock(entry.wakeMutex);
+                        entry.wakeup = true;
+                    }
+                    entry.wakeCv.notify_one();
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex_);
+                    if (entry.critical) {
+                        readyQueue_.push_front(index);  // 无预留线程：插队
+                    } else {
+                        readyQueue_.push_back(index);
+                    }
+                }
+                queueCv_.notify_one();
+                return;
+            }
+        } else if (s == 1) {
+            if (entry.state.compare_exchange_weak(s, 2)) {
+                break;
+            }
+        } else {
+            break;  // 已标记补调度
+        }
+    }
+    if (entry.critical) {
+        // 执行期间首个新数据的到达时间，作为补调度的截止时间起点
+        std::int64_t expected = 0;
+        entry.nextReleaseNs.compare_exchange_strong(expected, PipelineClock::nowNs(), std::memory_order_relaxed);
+    }
+}
+
+void PipelineScheduler::pushEdf(std::size_t index) {
+    auto& entry = *entries_[index];
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        edfQueue_.push_back(
+            EdfItem{entry.releaseNs.load(std::memory_order_relaxed) + entry.deadlineNs, edfSeq_++, index});
+        std::push_heap(edfQueue_.begin(), edfQueue_.end(), std::greater<EdfItem>());
+    }
+    criticalCv_.notify_one();
+}
+
+void PipelineScheduler::releaseNext(Entry& entry) {
+    std::int64_t next = entry.nextReleaseNs.exchange(0, std::memory_order_relaxed);
+    entry.releaseNs.store(next != 0 ? next : PipelineClock::nowNs(), std::memory_order_relaxed);
+}
+
+void PipelineScheduler::recordDeadline(Entry& entry) {
+    if (entry.deadlineNs <= 0) return;
+    std::int64_t lateness = PipelineClock::nowNs() - entry.releaseNs.load(std::memory_order_relaxed) - entry.deadlineNs;
+    if (lateness <= 0) return;
+    entry.deadlineMisses.fetch_add(1, std::memory_order_relaxed);
+    std::int64_t prev = entry.maxLatenessNs.load(std::memory_order_relaxed);
+    while (lateness > prev && !entry.maxLatenessNs.compare_exchange_weak(prev, lateness, std::memory_order_relaxed)) {
+    }
+}
+
+NodePlacement PipelineScheduler::threadPlacement(const Entry& entry) const {
+    NodePlacement placement = entry.node->placement();
+    if (entry.critical) {
+        if (placement.priority == 0) placement.priority = config_.criticalPriority;
+        if (placement.cpus.empty()) placement.cpus = config_.criticalCpus;
+    }
+    return placement;
+}
+
+bool PipelineScheduler::hasQueuedInput(const Entry& entry) {
+    for (const auto& pad : entry.inputs) {
+        if (pad->hasQueuedData()) return true;
+    }
+    return false;
+}
+
+void PipelineScheduler::runNode(Entry& entry) {
+    // 调用方已登记 busy_
+    if (std::uint32_t divisor = entry.rateDivisor.load(std::memory_order_relaxed); divisor > 1) {
+        if (++entry.skipped < divisor) {
+            for (const auto& pad : entry.inputs) {
+                pad->drainQueued(1);
+            }
+            leaveProcess();
+            return;
+        }
+        entry.skipped = 0;
+    }
+    const bool cpu = config_.cpuAccounting;
+    std::uint64_t cpuBegin = cpu ? threadCpuNs() : 0;
+    PerfCounterGroup* perf = config_.perfCounters ? PerfCounterGroup::forCurrentThread() : nullptr;
+    PerfCounterValues perfBegin;
+    if (perf && !perf->read(perfBegin)) perf = nullptr;
+    auto begin = std::chrono::steady_clock::now();
+    entry.processStartNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(begin.time_since_epoch()).count(),
+                               std::memory_order_relaxed);
+    FM_TRACE_SCOPE("node", entry.traceName);
+    try {
+        for (const auto& pad : entry.inputs) {
+            pad->drainQueued(1);
+        }
+        entry.node->process();
+        if (entry.idleSink && entry.idleRequested.exchange(false)) entry.idleSink->releaseIdleBuffers();
+    } catch (const std::exception& e) {
+        FM_LOG_ERROR("PipelineScheduler", "node ", entry.node->id(), " process() threw: ", e.what());
+    } catch (...) {
+        FM_LOG_ERROR("PipelineScheduler", "node ", entry.node->id(), " process() threw unknown exception");
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+    entry.processStartNs.store(0, std::memory_order_relaxed);
+    std::uint64_t elapsedNs = static_cast<std::uint64_t>(elapsed.count());
+    entry.latency.record(elapsedNs);
+    std::uint64_t windowMax = entry.windowMaxNs.load(std::memory_order_relaxed);
+    while (elapsedNs > windowMax &&
+           !entry.windowMaxNs.compare_exchange_weak(windowMax, elapsedNs, std::memory_order_relaxed)) {
+    }
+    if (cpu) {
+        entry.cpuNs.fetch_add(threadCpuNs() - cpuBegin, std::memory_order_relaxed);
+    }
+    PerfCounterValues perfEnd;
+    if (perf && perf->read(perfEnd)) {
+        const PerfCounterValues delta = perfEnd - perfBegin;
+        for (std::size_t i = 0; i < entry.perf.size(); ++i) {
+            entry.perf[i].fetch_add(delta.value[i], std::memory_order_relaxed);
+        }
+        entry.perfAvailable.fetch_or(delta.available, std::memory_order_relaxed);
+    }
+    entry.processCount.fetch_add(1, std::memory_order_relaxed);
+    if (entry.critical) recordDeadline(entry);
+    leaveProcess();
+}
+
+void PipelineScheduler::leaveProcess() {
+    if (busy_.fetch_sub(1) == 1 && paused_) {
+        std::lock_guard<std::mutex> lock(idleMutex_);
+        idleCv_.notify_all();
+    }
+}
+
+void PipelineScheduler::sourceLoop(std::size_t index) {
+    auto& entry = *entries_[index];
+    const NodePlacement placement = threadPlacement(entry);
+    if (placement.pinsThread()) {
+        applyThreadPlacement(placement, entry.node->id());
+    }
+    FM_TRACE_THREAD_NAME(Tracer::intern("source:" + entry.node->id()));
+    // 周期按 PipelineClock 计：虚拟时钟下 Source 按虚拟时刻释放
+    std::int64_t next = PipelineClock::nowNs();
+    while (running_) {
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            if (paused_) {
+                sleepCv_.wait(lock, [this]() { return !running_ || !paused_; });
+                next = PipelineClock::nowNs();
+                continue;
+            }
+            busy_.fetch_add(1);
+        }
+        if (entry.critical) {
+            // 以周期起点为到达时间
+            entry.releaseNs.store(next, std::memory_order_relaxed);
+        }
+        runNode(entry);
+        if (entry.period.count() <= 0) {
+            next = PipelineClock::nowNs();
+            continue;
+        }
+        next += std::chrono::duration_cast<std::chrono::nanoseconds>(entry.period).count();
+        const std::int64_t now = PipelineClock::nowNs();
+        if (next < now) {
+            next = now;  // 处理超时，不追帧
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        PipelineClock::waitUntil(sleepCv_, lock, next, [this]() { return !running_ || paused_; });
+    }
+}
+
+void PipelineScheduler::workerLoop(NodePlacement placement) {
+    if (placement.pinsThread()) {
+        applyThreadPlacement(placement, "pipeline-worker");
+    }
+    FM_TRACE_THREAD_NAME("pipeline-worker");
+    for (;;) {
+        std::size_t index = 0;
+        std::shared_ptr<FanOutJob> job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCv_.wait(lock, [this]() {
+                return !running_ || !fanOutQueue_.empty() || (!paused_ && !readyQueue_.empty());
+            });
+            if (!running_) {
+                return;
+            }
+            if (!fanOutQueue_.empty()) {
+                job = fanOutQueue_.front();
+                if (job->next.load() >= job->count) {
+                    fanOutQueue_.pop_front();  // 已全部认领
+                    continue;
+                }
+            } else {
+                index = readyQueue_.front();
+                readyQueue_.pop_front();
+                busy_.fetch_add(1);  // 与 pause() 在同一把锁下，不会漏算
+            }
+        }
+        if (job) {
+            // 属于推送方 process() 的一部分（已计入 busy_），这里不再登记
+            helpFanOut(*job);
+            continue;
+        }
+
+        runScheduled(index, true);
+    }
+}
+
+void PipelineScheduler::criticalLoop() {
+    NodePlacement placement;
+    placement.cpus = config_.criticalCpus;
+    placement.priority = config_.criticalPriority;
+    if (placement.pinsThread()) {
+        applyThreadPlacement(placement, "pipeline-critical");
+    }
+    FM_TRACE_THREAD_NAME("pipeline-critical");
+    for (;;) {
+        std::size_t index = 0;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            criticalCv_.wait(lock, [this]() { return !running_ || (!paused_ && !edfQueue_.empty()); });
+            if (!running_) {
+                return;
+            }
+            std::pop_heap(edfQueue_.begin(), edfQueue_.end(), std::greater<EdfItem>());
+            index = edfQueue_.back().index;
+            edfQueue_.pop_back();
+            busy_.fetch_add(1);  // 与 pause() 在同一把锁下，不会漏算
+        }
+        runScheduled(index, true);
+    }
+}
+
+void PipelineScheduler::dedicatedLoop(std::size_t index) {
+    auto& entry = *entries_[index];
+    applyThreadPlacement(threadPlacement(entry), entry.node->id());
+    FM_TRACE_THREAD_NAME(Tracer::intern("dedicated:" + entry.node->id()));
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(entry.wakeMutex);
+            entry.wakeCv.wait(lock, [this, &entry]() { return !running_ || (!paused_ && entry.wakeup); });
+            if (!running_) {
+                return;
+            }
+            entry.wakeup = false;
+        }
+        runScheduled(index, false);
+    }
+}
+
+void PipelineScheduler::runScheduled(std::size_t index, bool registered) {
+    auto& entry = *entries_[index];
+    for (;;) {
+        if (!registered) {
+            // 先登记再复查暂停（均为 seq_cst，与 pause() 的置位/等待不会同时错过）
+            busy_.fetch_add(1);
+            if (paused_) {
+                leaveProcess();
+                entry.state.store(0);
+                notify(index);  // 暂停期间仅入队，resume 后处理
+                return;
+            }
+        }
+        registered = false;
+        runNode(entry);
+        // 队列中仍有数据：逐条处理
+        if (!running_ || !hasQueuedInput(entry)) {
+            int expected = 1;
+            if (entry.state.compare_exchange_strong(expected, 0)) {
+                return;
+            }
+            // 执行期间有新数据到达：清除标记后再处理一次
+            entry.state.store(1);
+            if (!running_) {
+                return;
+            }
+        }
+        if (entry.critical) releaseNext(entry);
+        if (entry.edf) {
+            pushEdf(index);  // 按新的截止时间重新排队，让更紧急的关键节点先执行
+            return;
+        }
+    }
+}
+
+} // namespace falconmind::sdk::core
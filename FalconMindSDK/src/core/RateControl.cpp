@@ -0,0 +1,74 @@
+#include "falconmind/sdk/core/RateControl.h"
+
+#include <algorithm>
+
+namespace falconmind::sdk::core {
+
+namespace {
+constexpr std::int64_t kWindowNs = 500000000;  // 统计窗口 500ms
+constexpr double kHeadroom = 1.1;              // 限速时为消费速率留的余量
+constexpr double kRaiseFactor = 1.25;
+constexpr int kCalmWindowsBeforeRaise = 4;
+} // namespace
+
+LinkRateController::LinkRateController(double minFps)
+    : minFps_(minFps > 0.0 ? minFps : 1.0) {}
+
+void LinkRateController::onPush(const LinkQueue& queue, std::int64_t nowNs) {
+    if (windowStartNs_ == 0) {
+        windowStartNs_ = nowNs;
+        lastPushed_ = queue.pushed();
+        lastPopped_ = queue.popped();
+        lastDropped_ = queue.dropped();
+        return;
+    }
+    std::int64_t elapsed = nowNs - windowStartNs_;
+    if (elapsed < kWindowNs) {
+        return;
+    }
+    double seconds = static_cast<double>(elapsed) / 1e9;
+    std::uint64_t pushed = queue.pushed();
+    std::uint64_t popped = queue.popped();
+    std::uint64_t dropped = queue.dropped();
+    double inputFps = static_cast<double>(pushed - lastPushed_) / seconds;
+    double consumeFps = static_cast<double>(popped - lastPopped_) / seconds;
+    bool dropping = dropped > lastDropped_;
+    windowStartNs_ = nowNs;
+    lastPushed_ = pushed;
+    lastPopped_ = popped;
+    lastDropped_ = dropped;
+
+    double limit = limitFps();
+    if (limit <= 0.0) {
+        peakInputFps_ = std::max(peakInputFps_, inputFps);
+    }
+    if (dropping) {
+        calmWindows_ = 0;
+        double target = std::max(minFps_, consumeFps * kHeadroom);
+        // 只在明显低于当前上限时下调，避免抖动
+        if (limit <= 0.0 || target < limit * 0.9) {
+            apply(target);
+        }
+        return;
+    }
+    if (limit > 0.0 && ++calmWindows_ >= kCalmWindowsBeforeRaise) {
+        calmWindows_ = 0;
+        double next = limit * kRaiseFactor;
+        apply(peakInputFps_ > 0.0 && next >= peakInputFps_ ? 0.0 : next);
+    }
+}
+
+void LinkRateController::release() {
+    if (limitFps() > 0.0) {
+        apply(0.0);
+    }
+}
+
+void LinkRateController::apply(double fps) {
+    limit_.store(fps, std::memory_order_relaxed);
+    if (feedback_) {
+        feedback_(fps);
+    }
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,109 @@
+#include "falconmind/sdk/core/ReplayRunner.h"
+#include "falconmind/sdk/core/FlowExecutor.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/Pipeline.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+// 未处于虚拟时钟时启用，返回是否由本次启用（结束时关闭）
+bool acquireVirtualClock(const ReplayRunnerConfig& config) {
+    if (PipelineClock::isVirtual()) return false;
+    PipelineClock::enableVirtual(config.startNs > 0 ? config.startNs : PipelineClock::nowNs());
+    return true;
+}
+
+} // namespace
+
+ReplayRunner::ReplayRunner(ReplayRunnerConfig config) : config_(config) {
+    config_.pollNs = std::max<std::int64_t>(1, config_.pollNs);
+}
+
+ReplayRunStats ReplayRunner::run(Pipeline& pipeline) {
+    ReplayRunStats stats;
+    PipelineScheduler& scheduler = pipeline.scheduler();
+    if (pipeline.state() != PipelineState::Null && pipeline.state() != PipelineState::Ready &&
+        !scheduler.config().manual) {
+        FM_LOG_ERROR("ReplayRunner", "pipeline ", pipeline.id(), " is already scheduled by threads");
+        return stats;
+    }
+    const bool ownClock = acquireVirtualClock(config_);
+    const bool ownState = pipeline.state() != PipelineState::Playing;
+    if (ownState) {
+        PipelineSchedulerConfig cfg = scheduler.config();
+        cfg.manual = true;
+        scheduler.setConfig(cfg);
+        if (!pipeline.setState(PipelineState::Playing)) {
+            if (ownClock) PipelineClock::disableVirtual();
+            return stats;
+        }
+    }
+    stats.started = true;
+    step(scheduler, stats);
+    if (ownState) pipeline.setState(PipelineState::Ready);
+    if (ownClock) PipelineClock::disableVirtual();
+    return stats;
+}
+
+ReplayRunStats ReplayRunner::run(FlowExecutor& flow) {
+    ReplayRunStats stats;
+    if (flow.isRunning()) {
+        FM_LOG_ERROR("ReplayRunner", "flow ", flow.getFlowId(), " is already running");
+        return stats;
+    }
+    PipelineSchedulerConfig cfg = flow.schedulerConfig();
+    cfg.manual = true;
+    flow.setSchedulerConfig(cfg);
+    // 节点在 start() 中读取的时刻（回放起点等）也须来自虚拟时钟
+    const bool ownClock = acquireVirtualClock(config_);
+    if (!flow.start()) {
+        if (ownClock) PipelineClock::disableVirtual();
+        return stats;
+    }
+    stats.started = true;
+    step(flow.getPipeline()->scheduler(), stats);
+    flow.stop();
+    if (ownClock) PipelineClock::disableVirtual();
+    return stats;
+}
+
+void ReplayRunner::step(PipelineScheduler& scheduler, ReplayRunStats& stats) {
+    stopRequested_.store(false, std::memory_order_relaxed);
+    const auto wallBegin = std::chrono::steady_clock::now();
+    const std::int64_t begin = PipelineClock::nowNs();
+    const std::int64_t end = config_.maxDurationNs > 0 ? begin + config_.maxDurationNs : TimedSource::kNever;
+    std::int64_t now = begin;
+    while (!stopRequested_.load(std::memory_order_relaxed)) {
+        stats.processCalls += scheduler.runOnce(now);
+        ++stats.steps;
+        if (scheduler.timedSourcesFinished()) {
+            stats.completed = true;
+            break;
+        }
+        std::int64_t next = scheduler.nextSourceDueNs();
+        if (next == TimedSource::kNever) {
+            stats.completed = true;  // 没有 Source：一次执行后即无事可做
+            break;
+        }
+        if (next <= now) next = now + config_.pollNs;
+        if (next > end) {
+            now = end;
+            break;
+        }
+        now = next;
+        PipelineClock::advanceVirtualTo(now);
+    }
+    stats.virtualNs = now - begin;
+    stats.wallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wallBegin)
+                       .count();
+    FM_LOG_INFO("ReplayRunner", stats.completed ? "completed: " : "stopped: ",
+                static_cast<double>(stats.virtualNs) / 1e9, " s virtual in ", static_cast<double>(stats.wallNs) / 1e6,
+                " ms (", stats.speedup(), "x), ", stats.steps, " step(s), ", stats.processCalls, " process() call(s)");
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,81 @@
+#include "falconmind/sdk/core/SelectorNode.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/Pad.h"
+
+namespace falconmind::sdk::core {
+
+SelectorNode::SelectorNode(std::size_t outputs) : Node("selector") {
+    addOutputs(outputs);
+    auto* in = addPad(std::make_shared<Pad>("in", PadType::Sink));
+    in->setBufferCallback([this](const BufferRef& buffer) {
+        const int index = route_ ? clampIndex(route_()) : selected_.load(std::memory_order_acquire);
+        switchFlowing(index);
+        if (index < 0) {
+            blocked_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        passed_.fetch_add(1, std::memory_order_relaxed);
+        outputs_[static_cast<std::size_t>(index)]->pushBuffer(buffer);
+    });
+}
+
+void SelectorNode::addOutputs(std::size_t count) {
+    for (std::size_t i = outputs_.size(); i < count; ++i) {
+        outputs_.push_back(addPad(std::make_shared<Pad>(outputPadName(i), PadType::Source)));
+    }
+}
+
+int SelectorNode::clampIndex(int index) const noexcept {
+    return index >= 0 && static_cast<std::size_t>(index) < outputs_.size() ? index : -1;
+}
+
+void SelectorNode::switchFlowing(int index) {
+    const int previous = flowing_.exchange(index, std::memory_order_acq_rel);
+    if (previous >= 0 && previous != index) branchClosed(outputs_[static_cast<std::size_t>(previous)]);
+}
+
+void SelectorNode::select(int index) {
+    index = clampIndex(index);
+    selected_.store(index, std::memory_order_release);
+    // 有路由函数时以其结果为准，由下一个缓冲判定
+    if (!route_) switchFlowing(index);
+}
+
+bool SelectorNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    auto it = params.find("outputs");
+    if (it != params.end()) {
+        int n = 0;
+        try {
+            n = std::stoi(it->second);
+        } catch (const std::exception&) {
+            n = 0;
+        }
+        if (n <= 0) {
+            FM_LOG_ERROR("SelectorNode", "invalid outputs: ", it->second);
+            return false;
+        }
+        addOutputs(static_cast<std::size_t>(n));
+    }
+    it = params.find("active");
+    if (it != params.end()) {
+        if (it->second == "none") {
+            select(-1);
+        } else {
+            int index = -1;
+            try {
+                index = std::stoi(it->second);
+            } catch (const std::exception&) {
+                FM_LOG_ERROR("SelectorNode", "invalid active: ", it->second);
+                return false;
+            }
+            if (clampIndex(index) != index) {
+                FM_LOG_ERROR("SelectorNode", "active out of range: ", it->second);
+                return false;
+            }
+            select(index);
+        }
+    }
+    return true;
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,236 @@
+#include "falconmind/sdk/core/SharedSource.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/Pipeline.h"
+
+#include <algorithm>
+
+namespace falconmind::sdk::core {
+
+/**
+ * SharedSourceHub - 一个设备的实际源节点：运行在自有 Pipeline 中（仅该节点与各 Source Pad 的出口），
+ * 出口回调在源节点的推送线程上把帧交给全部已启动的代理
+ */
+class SharedSourceHub {
+public:
+    SharedSourceHub(std::string key, std::shared_ptr<Node> source);
+    ~SharedSourceHub();
+
+    const std::string& key() const noexcept { return key_; }
+    const std::shared_ptr<Node>& source() const noexcept { return source_; }
+    const std::vector<std::size_t>& sourcePads() const noexcept { return sourcePads_; }
+    // 代理声明的 caps：设备运行中为其实际输出格式，否则为源节点声明的全部格式
+    Caps padCaps(std::size_t k) const;
+
+    bool attach(SharedSourceNode* proxy);
+    void detach(SharedSourceNode* proxy);
+    std::size_t users() const;
+
+private:
+    void deliver(std::size_t k, const BufferRef& buffer);
+
+    std::string key_;
+    std::shared_ptr<Node> source_;
+    std::vector<std::size_t> sourcePads_;  // 源节点 Source Pad 的下标
+    std::unique_ptr<Pipeline> pipeline_;
+    bool running_{false};
+    std::vector<VideoCaps> formats_;  // 运行中各 Source Pad 的协商结果
+    mutable std::mutex mutex_;        // attach/detach 与启动、停止设备
+    mutable std::mutex deliverMutex_;  // users_；推送线程持有期间代理不会注销
+    std::vector<SharedSourceNode*> users_;
+};
+
+SharedSourceHub::SharedSourceHub(std::string key, std::shared_ptr<Node> source)
+    : key_(std::move(key)), source_(std::move(source)) {
+    pipeline_ = std::make_unique<Pipeline>(PipelineConfig{"shared:" + key_, "Shared source " + key_, ""});
+    pipeline_->addNode(source_);
+    for (std::size_t i = 0; i < source_->padCount(); ++i) {
+        Pad* pad = source_->pad(static_cast<Node::PadIndex>(i));
+        if (!pad || pad->type() != PadType::Source) continue;
+        const std::size_t k = sourcePads_.size();
+        sourcePads_.push_back(i);
+        pipeline_->addPadTap(source_->id(), pad->name(), [this, k](const BufferRef& buffer) { deliver(k, buffer); });
+    }
+    formats_.resize(sourcePads_.size());
+}
+
+SharedSourceHub::~SharedSourceHub() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) pipeline_->setState(PipelineState::Null);
+}
+
+Caps SharedSourceHub::padCaps(std::size_t k) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) return source_->pad(static_cast<Node::PadIndex>(sourcePads_[k]))->caps();
+    Caps caps;
+    if (formats_[k].format != PixelFormat::Any) caps.addVideo(formats_[k]);
+    return caps;
+}
+
+std::size_t SharedSourceHub::users() const {
+    std::lock_guard<std::mutex> lock(deliverMutex_);
+    return users_.size();
+}
+
+bool SharedSourceHub::attach(SharedSourceNode* proxy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+        // 第一个使用者决定设备输出格式
+        for (std::size_t k = 0; k < sourcePads_.size(); ++k) {
+            const VideoCaps& wanted = proxy->outPads_[k]->negotiatedCaps();
+            if (wanted.format != PixelFormat::Any) {
+                source_->pad(static_cast<Node::PadIndex>(sourcePads_[k]))->setNegotiatedCaps(wanted);
+            }
+        }
+        if (!pipeline_->setState(PipelineState::Playing)) {
+            FM_LOG_ERROR("SharedSource", "failed to open shared device ", key_);
+            return false;
+        }
+        running_ = true;
+        for (std::size_t k = 0; k < sourcePads_.size(); ++k) {
+            formats_[k] = source_->pad(static_cast<Node::PadIndex>(sourcePads_[k]))->negotiatedCaps();
+        }
+        FM_LOG_INFO("SharedSource", "opened shared device ", key_);
+    } else {
+        for (std::size_t k = 0; k < sourcePads_.size(); ++k) {
+            const PixelFormat wanted = proxy->outPads_[k]->negotiatedCaps().format;
+            if (wanted != PixelFormat::Any && formats_[k].format != PixelFormat::Any && wanted != formats_[k].format) {
+                FM_LOG_ERROR("SharedSource", "node ", proxy->id(), " wants ", pixelFormatName(wanted), " but ", key_,
+                             " is already open as ", pixelFormatName(formats_[k].format));
+                return false;
+            }
+        }
+    }
+    std::lock_guard<std::mutex> deliverLock(deliverMutex_);
+    users_.push_back(proxy);
+    return true;
+}
+
+void SharedSourceHub::detach(SharedSourceNode* proxy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool last = false;
+    {
+        std::lock_guard<std::mutex> deliverLock(deliverMutex_);
+        users_.erase(std::remove(users_.begin(), users_.end(), proxy), users_.end());
+        last = users_.empty();
+    }
+    if (last && running_) {
+        pipeline_->setState(PipelineState::Null);
+        running_ = false;
+        FM_LOG_INFO("SharedSource", "closed shared device ", key_);
+    }
+}
+
+void SharedSourceHub::deliver(std::size_t k, const BufferRef& buffer) {
+    std::lock_guard<std::mutex> lock(deliverMutex_);
+    for (auto* proxy : users_) proxy->offer(k, buffer);
+}
+
+SharedSourceNode::SharedSourceNode(std::shared_ptr<SharedSourceHub> hub, const std::string& id)
+    : Node(id), hub_(std::move(hub)) {
+    for (std::size_t k = 0; k < hub_->sourcePads().size(); ++k) {
+        const Pad* src = hub_->source()->pad(static_cast<Node::PadIndex>(hub_->sourcePads()[k]));
+        auto pad = std::make_shared<Pad>(src->name(), PadType::Source);
+        pad->setCaps(hub_->padCaps(k));
+        outPads_.push_back(addPad(pad));
+    }
+}
+
+SharedSourceNode::~SharedSourceNode() {
+    stop();
+}
+
+const std::string& SharedSourceNode::deviceKey() const noexcept {
+    return hub_->key();
+}
+
+const std::shared_ptr<Node>& SharedSourceNode::source() const noexcept {
+    return hub_->source();
+}
+
+bool SharedSourceNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    if (params.empty()) return true;
+    FM_LOG_ERROR("SharedSource", "node ", id(), " shares ", hub_->key(), " and cannot be reconfigured");
+    return false;
+}
+
+bool SharedSourceNode::start() {
+    if (attached_) return true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.clear();
+    }
+    attached_ = hub_->attach(this);
+    return attached_;
+}
+
+void SharedSourceNode::stop() {
+    if (!attached_) return;
+    hub_->detach(this);
+    attached_ = false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.clear();
+}
+
+void SharedSourceNode::offer(std::size_t padIndex, const BufferRef& buffer) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= queueDepth_) {
+            queue_.pop_front();
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        queue_.emplace_back(padIndex, buffer);
+    }
+    cv_.notify_one();
+}
+
+void SharedSourceNode::process() {
+    std::deque<std::pair<std::size_t, BufferRef>> ready;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!cv_.wait_for(lock, wait_, [this] { return !queue_.empty(); })) return;
+        ready.swap(queue_);
+    }
+    for (const auto& [k, buffer] : ready) outPads_[k]->pushBuffer(buffer);
+}
+
+SharedSourceRegistry& SharedSourceRegistry::instance() {
+    static SharedSourceRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<SharedSourceNode> SharedSourceRegistry::share(const std::shared_ptr<Node>& node) {
+    auto* sharable = dynamic_cast<SharableSource*>(node.get());
+    if (!sharable) return nullptr;
+    const std::string key = sharable->deviceKey();
+    if (key.empty()) return nullptr;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = hubs_.begin(); it != hubs_.end();) {
+        it = it->second.expired() ? hubs_.erase(it) : std::next(it);
+    }
+    auto hub = hubs_[key].lock();
+    if (hub) {
+        FM_LOG_INFO("SharedSource", "node ", node->id(), " reuses shared device ", key);
+    } else {
+        hub = std::make_shared<SharedSourceHub>(key, node);
+        hubs_[key] = hub;
+    }
+    auto proxy = std::make_shared<SharedSourceNode>(hub, node->id());
+    proxy->setPlacement(node->placement());
+    return proxy;
+}
+
+std::size_t SharedSourceRegistry::deviceCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<std::size_t>(
+        std::count_if(hubs_.begin(), hubs_.end(), [](const auto& entry) { return !entry.second.expired(); }));
+}
+
+std::size_t SharedSourceRegistry::activeUsers(const std::string& deviceKey) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = hubs_.find(deviceKey);
+    auto hub = it != hubs_.end() ? it->second.lock() : nullptr;
+    return hub ? hub->users() : 0;
+}
+
+} // namespace falconmind::sdk::core
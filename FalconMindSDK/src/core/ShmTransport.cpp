@@ -0,0 +1,395 @@
+#include "falconmind/sdk/core/ShmTransport.h"
+#include "falconmind/sdk/core/Pad.h"
+
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <new>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+constexpr std::uint32_t kShmMagic = 0x484D4D46;  // "FMMH"
+constexpr std::uint32_t kShmVersion = 1;
+constexpr std::size_t kAlign = 64;
+
+enum SlotState : std::uint32_t {
+    kSlotFree = 0,     // 可写
+    kSlotReady = 1,    // 已写入，等待读取
+    kSlotReading = 2   // 读端持有 BufferRef
+};
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "shm atomics must be address-free");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shm atomics must be address-free");
+
+// 共享内存布局：ShmHeader | slot 0 | slot 1 | ...；每个槽位为 ShmSlot 头 + slotSize 字节数据
+struct alignas(kAlign) ShmHeader {
+    std::atomic<std::uint32_t> magic;  // 初始化完成后最后写入
+    std::uint32_t version;
+    std::uint32_t slotCount;
+    std::uint32_t reserved;
+    std::uint64_t slotSize;
+    std::uint64_t slotStride;
+    std::atomic<std::uint32_t> closed;
+
+    alignas(kAlign) std::atomic<std::uint32_t> sequence;  // futex 字：每写入一帧加一
+    std::atomic<std::uint32_t> waiters;                   // 阻塞在 futex 上的读端数
+    std::atomic<std::uint64_t> writeIndex;
+    std::atomic<std::uint64_t> written;
+    std::atomic<std::uint64_t> dropped;
+
+    alignas(kAlign) std::atomic<std::uint64_t> readIndex;  // 仅读端写
+};
+
+struct alignas(kAlign) ShmSlot {
+    std::atomic<std::uint32_t> state;
+    std::uint32_t format;
+    std::uint64_t size;
+    std::int64_t timestampNs;
+    std::uint64_t frameIndex;
+    std::int32_t width;
+    std::int32_t height;
+    std::int32_t fps;
+};
+
+std::size_t alignUp(std::size_t v) {
+    return (v + kAlign - 1) / kAlign * kAlign;
+}
+
+std::string shmPath(const std::string& name) {
+    return "/" + name;
+}
+
+bool validName(const std::string& name) {
+    return !name.empty() && name.size() < NAME_MAX && name.find('/') == std::string::npos;
+}
+
+long futexWait(std::atomic<std::uint32_t>* word, std::uint32_t expected, std::chrono::milliseconds timeout) {
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+    ts.tv_nsec = static_cast<long>((timeout.count() % 1000) * 1000000);
+    // 跨进程共享：不能使用 FUTEX_PRIVATE_FLAG
+    return syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void futexWakeAll(std::atomic<std::uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+} // namespace
+
+struct ShmChannel::Mapping {
+    void* base{MAP_FAILED};
+    std::size_t length{0};
+
+    ~Mapping() {
+        if (base != MAP_FAILED) munmap(base, length);
+    }
+
+    ShmHeader* header() const { return static_cast<ShmHeader*>(base); }
+    ShmSlot* slot(std::uint64_t index) const {
+        auto* h = header();
+        auto* p = static_cast<std::uint8_t*>(base) + alignUp(sizeof(ShmHeader)) +
+                  static_cast<std::size_t>(index % h->slotCount) * h->slotStride;
+        return reinterpret_cast<ShmSlot*>(p);
+    }
+    static std::uint8_t* payload(ShmSlot* s) {
+        return reinterpret_cast<std::uint8_t*>(s) + alignUp(sizeof(ShmSlot));
+    }
+};
+
+ShmChannel::ShmChannel(std::string name, bool producer, std::shared_ptr<Mapping> mapping)
+    : name_(std::move(name))
+    , producer_(producer)
+    , mapping_(std::move(mapping)) {}
+
+ShmChannel::~ShmChannel() {
+    if (producer_ && mapping_) {
+        auto* h = mapping_->header();
+        h->closed.store(1, std::memory_order_release);
+        h->sequence.fetch_add(1, std::memory_order_release);
+        futexWakeAll(&h->sequence);
+        shm_unlink(shmPath(name_).c_str());
+    }
+}
+
+std::shared_ptr<ShmChannel> ShmChannel::create(const ShmChannelConfig& config) {
+    if (!validName(config.name) || config.slotCount == 0 || config.slotSize == 0) {
+        std::cerr << "[ShmChannel] Invalid channel config: " << config.name << std::endl;
+        return nullptr;
+    }
+    std::string path = shmPath(config.name);
+    shm_unlink(path.c_str());  // 上次异常退出的残留
+    int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+    if (fd < 0) {
+        std::cerr << "[ShmChannel] shm_open failed: " << path << ": " << std::strerror(errno) << std::endl;
+        return nullptr;
+    }
+    std::size_t stride = alignUp(sizeof(ShmSlot)) + alignUp(config.slotSize);
+    std::size_t length = alignUp(sizeof(ShmHeader)) + stride * config.slotCount;
+    if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+        std::cerr << "[ShmChannel] ftruncate failed: " << path << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        shm_unlink(path.c_str());
+        return nullptr;
+    }
+    auto mapping = std::make_shared<Mapping>();
+    mapping->base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    mapping->length = length;
+    close(fd);
+    if (mapping->base == MAP_FAILED) {
+        std::cerr << "[ShmChannel] mmap failed: " << path << ": " << std::strerror(errno) << std::endl;
+        shm_unlink(path.c_str());
+        return nullptr;
+    }
+
+    // ftruncate 后内容为零；在映射上构造原子对象
+    auto* h = new (mapping->base) ShmHeader();
+    h->version = kShmVersion;
+    h->slotCount = config.slotCount;
+    h->slotSize = config.slotSize;
+    h->slotStride = stride;
+    for (std::uint32_t i = 0; i < config.slotCount; ++i) {
+        new (mapping->slot(i)) ShmSlot();
+    }
+    h->magic.store(kShmMagic, std::memory_order_release);
+    return std::shared_ptr<ShmChannel>(new ShmChannel(config.name, true, std::move(mapping)));
+}
+
+std::shared_ptr<ShmChannel> ShmChannel::open(const std::string& name) {
+    if (!validName(name)) {
+        return nullptr;
+    }
+    int fd = shm_open(shmPath(name).c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(ShmHeader)) {
+        close(fd);
+        return nullptr;
+    }
+    auto mapping = std::make_shared<Mapping>();
+    mapping->length = static_cast<std::size_t>(st.st_size);
+    mapping->base = mmap(nullptr, mapping->length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping->base == MAP_FAILED) {
+        return nullptr;
+    }
+    auto* h = mapping->header();
+    if (h->magic.load(std::memory_order_acquire) != kShmMagic || h->version != kShmVersion || h->slotCount == 0 ||
+        alignUp(sizeof(ShmHeader)) + h->slotStride * h->slotCount > mapping->length) {
+        std::cerr << "[ShmChannel] Channel not ready or incompatible: " << name << std::endl;
+        return nullptr;
+    }
+    // 单消费者：新打开的读端不持有任何槽位，回收上一个读端（可能已崩溃）遗留的占用
+    for (std::uint32_t i = 0; i < h->slotCount; ++i) {
+        std::uint32_t reading = kSlotReading;
+        mapping->slot(i)->state.compare_exchange_strong(reading, kSlotFree, std::memory_order_acq_rel);
+    }
+    return std::shared_ptr<ShmChannel>(new ShmChannel(name, false, std::move(mapping)));
+}
+
+bool ShmChannel::write(const void* data, std::size_t size, const BufferMeta& meta) {
+    auto* h = mapping_->header();
+    if (!producer_ || !data) {
+        return false;
+    }
+    std::uint64_t index = h->writeIndex.load(std::memory_order_relaxed);
+    ShmSlot* s = mapping_->slot(index);
+    if (size > h->slotSize || s->state.load(std::memory_order_acquire) != kSlotFree) {
+        h->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    std::memcpy(Mapping::payload(s), data, size);
+    s->size = size;
+    s->timestampNs = meta.timestampNs;
+    s->frameIndex = meta.frameIndex;
+    s->format = static_cast<std::uint32_t>(meta.video.format);
+    s->width = meta.video.width;
+    s->height = meta.video.height;
+    s->fps = meta.video.fps;
+    s->state.store(kSlotReady, std::memory_order_release);
+    h->writeIndex.store(index + 1, std::memory_order_relaxed);
+    h->written.fetch_add(1, std::memory_order_relaxed);
+    h->sequence.fetch_add(1, std::memory_order_seq_cst);
+    // 与读端 waiters++ 后复查 sequence 配对（均为 seq_cst），不会同时错过
+    if (h->waiters.load(std::memory_order_seq_cst) > 0) {
+        futexWakeAll(&h->sequence);
+    }
+    return true;
+}
+
+BufferRef ShmChannel::read(std::chrono::milliseconds timeout) {
+    auto* h = mapping_->header();
+    if (producer_) {
+        return {};
+    }
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        std::uint32_t seen = h->sequence.load(std::memory_order_acquire);
+        std::uint64_t index = h->readIndex.load(std::memory_order_relaxed);
+        ShmSlot* s = mapping_->slot(index);
+        // 生产者不会越过未归还的槽位，因此 readIndex 处为 Ready 即为下一帧
+        if (s->state.load(std::memory_order_acquire) == kSlotReady) {
+            s->state.store(kSlotReading, std::memory_order_relaxed);
+            h->readIndex.store(index + 1, std::memory_order_relaxed);
+            std::shared_ptr<void> holder(static_cast<void*>(s), [mapping = mapping_](void* p) {
+                static_cast<ShmSlot*>(p)->state.store(kSlotFree, std::memory_order_release);
+            });
+            BufferRef ref = BufferRef::wrap(Mapping::payload(s), static_cast<std::size_t>(s->size), std::move(holder));
+            auto& meta = ref.storage()->meta;
+            meta.timestampNs = s->timestampNs;
+            meta.frameIndex = s->frameIndex;
+            meta.video.format = static_cast<PixelFormat>(s->format);
+            meta.video.width = s->width;
+            meta.video.height = s->height;
+            meta.video.fps = s->fps;
+            return ref;
+        }
+        if (h->closed.load(std::memory_order_acquire) != 0) {
+            return {};
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return {};
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        h->waiters.fetch_add(1, std::memory_order_seq_cst);
+        if (h->sequence.load(std::memory_order_seq_cst) == seen) {
+            futexWait(&h->sequence, seen, remaining.count() > 0 ? remaining : std::chrono::milliseconds(1));
+        }
+        h->waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+bool ShmChannel::closed() const noexcept {
+    return mapping_->header()->closed.load(std::memory_order_acquire) != 0;
+}
+
+std::uint32_t ShmChannel::slotCount() const noexcept {
+    return mapping_->header()->slotCount;
+}
+
+std::size_t ShmChannel::slotSize() const noexcept {
+    return static_cast<std::size_t>(mapping_->header()->slotSize);
+}
+
+std::uint64_t ShmChannel::written() const noexcept {
+    return mapping_->header()->written.load(std::memory_order_relaxed);
+}
+
+std::uint64_t ShmChannel::dropped() const noexcept {
+    return mapping_->header()->dropped.load(std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+
+ShmSinkNode::ShmSinkNode(ShmChannelConfig config)
+    : Node("shm_sink")
+    , config_(std::move(config)) {
+    auto* in = addPad(std::make_shared<Pad>("in", PadType::Sink));
+    in->setBufferCallback([this](const BufferRef& buffer) {
+        if (auto channel = std::atomic_load(&channel_)) {
+            channel->write(buffer);
+        }
+    });
+}
+
+bool ShmSinkNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    try {
+        auto it = params.find("channel");
+        if (it != params.end()) config_.name = it->second;
+        it = params.find("slots");
+        if (it != params.end()) config_.slotCount = static_cast<std::uint32_t>(std::stoul(it->second));
+        it = params.find("slot_size");
+        if (it != params.end()) config_.slotSize = static_cast<std::size_t>(std::stoull(it->second));
+    } catch (const std::exception&) {
+        std::cerr << "[ShmSinkNode] Invalid parameters for " << id() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ShmSinkNode::start() {
+    auto channel = ShmChannel::create(config_);
+    if (!channel) {
+        std::cerr << "[ShmSinkNode] Failed to create channel " << config_.name << std::endl;
+        return false;
+    }
+    std::atomic_store(&channel_, std::move(channel));
+    return true;
+}
+
+void ShmSinkNode::stop() {
+    std::atomic_store(&channel_, std::shared_ptr<ShmChannel>());
+}
+
+std::uint64_t ShmSinkNode::dropped() const noexcept {
+    auto channel = std::atomic_load(&channel_);
+    return channel ? channel->dropped() : 0;
+}
+
+ShmSourceNode::ShmSourceNode(std::string channel)
+    : Node("shm_source")
+    , channelName_(std::move(channel)) {
+    outPad_ = addPad(std::make_shared<Pad>("out", PadType::Source));
+}
+
+bool ShmSourceNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    try {
+        auto it = params.find("channel");
+        if (it != params.end()) channelName_ = it->second;
+        it = params.find("wait_ms");
+        if (it != params.end()) wait_ = std::chrono::milliseconds(std::stol(it->second));
+    } catch (const std::exception&) {
+        std::cerr << "[ShmSourceNode] Invalid parameters for " << id() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ShmSourceNode::start() {
+    if (channelName_.empty()) {
+        std::cerr << "[ShmSourceNode] No channel configured for " << id() << std::endl;
+        return false;
+    }
+    // 生产者可能尚未启动：不视为失败，process() 中重试
+    channel_ = ShmChannel::open(channelName_);
+    started_ = true;
+    return true;
+}
+
+void ShmSourceNode::stop() {
+    started_ = false;
+    channel_.reset();
+}
+
+void ShmSourceNode::process() {
+    if (!started_) return;
+    if (!channel_ || channel_->closed()) {
+        channel_ = ShmChannel::open(channelName_);
+        if (!channel_) return;
+    }
+    // 每次最多转发当前积压的一轮，避免单次 process() 占用调度线程过久
+    std::uint32_t budget = channel_->slotCount();
+    auto wait = wait_;
+    while (budget-- > 0) {
+        BufferRef buffer = channel_->read(wait);
+        if (!buffer) break;
+        wait = std::chrono::milliseconds(0);
+        received_.fetch_add(1, std::memory_order_relaxed);
+        outPad_->pushBuffer(buffer);
+    }
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,283 @@
+#include "falconmind/sdk/core/StateCheckpoint.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+constexpr std::uint32_t kCheckpointMagic = 0x4B434D46;  // "FMCK"
+constexpr std::uint32_t kCheckpointFormat = 1;
+constexpr std::size_t kAlign = 64;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "checkpoint atomics must be address-free");
+
+// 文件布局：CheckpointFileHeader | slot 0 | slot 1；每个槽为 CheckpointSlot 头 + slotCapacity 字节负载
+struct alignas(kAlign) CheckpointFileHeader {
+    std::uint32_t magic;
+    std::uint32_t format;
+    std::uint64_t slotCapacity;
+};
+
+struct alignas(kAlign) CheckpointSlot {
+    std::atomic<std::uint64_t> sequence;  // 提交点：0 为空槽或正在写入
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t size;
+    std::uint64_t checksum;
+};
+
+std::size_t alignUp(std::size_t v) { return (v + kAlign - 1) / kAlign * kAlign; }
+
+std::size_t fileSize(std::size_t capacity) { return sizeof(CheckpointFileHeader) + 2 * (sizeof(CheckpointSlot) + capacity); }
+
+std::uint64_t fnv1a(std::uint64_t h, const void* data, std::size_t size) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+std::uint64_t payloadChecksum(std::uint32_t version, const char* data, std::size_t size) {
+    const std::uint64_t size64 = size;
+    std::uint64_t h = fnv1a(1469598103934665603ull, &version, sizeof(version));
+    h = fnv1a(h, &size64, sizeof(size64));
+    return fnv1a(h, data, size);
+}
+
+bool validName(const std::string& name) {
+    if (name.empty() || name.size() > 200) return false;
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-' ||
+               c == '.';
+    });
+}
+
+} // namespace
+
+struct CheckpointRegion::Mapping {
+    int fd{-1};
+    void* base{nullptr};
+    std::size_t bytes{0};
+
+    ~Mapping() {
+        if (base) ::munmap(base, bytes);
+        if (fd >= 0) ::close(fd);
+    }
+
+    CheckpointFileHeader* header() const { return static_cast<CheckpointFileHeader*>(base); }
+    std::size_t capacity() const { return static_cast<std::size_t>(header()->slotCapacity); }
+    CheckpointSlot* slot(int i) const {
+        auto* p = static_cast<char*>(base) + sizeof(CheckpointFileHeader) +
+                  static_cast<std::size_t>(i) * (sizeof(CheckpointSlot) + capacity());
+        return reinterpret_cast<CheckpointSlot*>(p);
+    }
+    char* payload(int i) const { return reinterpret_cast<char*>(slot(i)) + sizeof(CheckpointSlot); }
+
+    // 校验通过的槽中序号最大者；没有时返回 -1
+    int latestValid() const {
+        int best = -1;
+        std::uint64_t bestSeq = 0;
+        for (int i = 0; i < 2; ++i) {
+            const CheckpointSlot* s = slot(i);
+            const std::uint64_t seq = s->sequence.load(std::memory_order_acquire);
+            if (seq == 0 || seq <= bestSeq || s->size > capacity()) continue;
+            if (payloadChecksum(s->version, payload(i), static_cast<std::size_t>(s->size)) != s->checksum) continue;
+            best = i;
+            bestSeq = seq;
+        }
+        return best;
+    }
+
+    std::uint64_t maxSequence() const {
+        return std::max(slot(0)->sequence.load(std::memory_order_acquire),
+                        slot(1)->sequence.load(std::memory_order_acquire));
+    }
+
+    // 写入序号较小的槽：先清零序号，再写负载与校验，最后提交新序号
+    void commit(std::uint32_t version, const char* data, std::size_t size, std::uint64_t sequence) {
+        const int target = slot(0)->sequence.load(std::memory_order_acquire) <=
+                                   slot(1)->sequence.load(std::memory_order_acquire)
+                               ? 0
+                               : 1;
+        CheckpointSlot* s = slot(target);
+        s->sequence.store(0, std::memory_order_release);
+        if (size > 0) std::memcpy(payload(target), data, size);
+        s->version = version;
+        s->size = size;
+        s->checksum = payloadChecksum(version, data, size);
+        s->sequence.store(sequence, std::memory_order_release);
+    }
+
+    void sync() const { ::msync(base, bytes, MS_SYNC); }
+
+    // 打开已有文件；keep 为 false 或格式不符时按 capacity 重新初始化
+    static std::unique_ptr<Mapping> create(const std::string& path, std::size_t capacity, bool keep) {
+        auto m = std::make_unique<Mapping>();
+        m->fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (m->fd < 0) return nullptr;
+        struct stat st{};
+        if (::fstat(m->fd, &st) != 0) return nullptr;
+        CheckpointFileHeader existing{};
+        bool reuse = false;
+        if (keep && static_cast<std::size_t>(st.st_size) >= sizeof(existing) &&
+            ::pread(m->fd, &existing, sizeof(existing), 0) == static_cast<ssize_t>(sizeof(existing)) &&
+            existing.magic == kCheckpointMagic && existing.format == kCheckpointFormat &&
+            static_cast<std::size_t>(st.st_size) == fileSize(static_cast<std::size_t>(existing.slotCapacity))) {
+            capacity = static_cast<std::size_t>(existing.slotCapacity);
+            reuse = true;
+        }
+        m->bytes = fileSize(capacity);
+        if (!reuse) {
+            // 先截断为 0：旧内容（其他格式）不会残留在新槽中
+            if (::ftruncate(m->fd, 0) != 0 || ::ftruncate(m->fd, static_cast<off_t>(m->bytes)) != 0) return nullptr;
+        }
+        m->base = ::mmap(nullptr, m->bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m->fd, 0);
+        if (m->base == MAP_FAILED) {
+            m->base = nullptr;
+            return nullptr;
+        }
+        if (!reuse) {
+            CheckpointFileHeader* h = m->header();
+            h->magic = kCheckpointMagic;
+            h->format = kCheckpointFormat;
+            h->slotCapacity = capacity;
+            new (m->slot(0)) CheckpointSlot{};
+            new (m->slot(1)) CheckpointSlot{};
+        }
+        return m;
+    }
+};
+
+CheckpointRegion::CheckpointRegion(std::string path, std::unique_ptr<Mapping> mapping)
+    : path_(std::move(path)), mapping_(std::move(mapping)) {}
+
+CheckpointRegion::~CheckpointRegion() = default;
+
+std::unique_ptr<CheckpointRegion> CheckpointRegion::open(const std::string& path, std::size_t initialCapacity) {
+    auto mapping = Mapping::create(path, alignUp(std::max<std::size_t>(initialCapacity, kAlign)), true);
+    if (!mapping) {
+        std::cerr << "[StateCheckpoint] cannot map " << path << std::endl;
+        return nullptr;
+    }
+    return std::unique_ptr<CheckpointRegion>(new CheckpointRegion(path, std::move(mapping)));
+}
+
+std::size_t CheckpointRegion::capacity() const noexcept { return mapping_->capacity(); }
+
+std::uint64_t CheckpointRegion::sequence() const noexcept { return mapping_->maxSequence(); }
+
+bool CheckpointRegion::write(std::uint32_t version, const char* data, std::size_t size, bool sync) {
+    if (size > mapping_->capacity()) return grow(size) && write(version, data, size, sync);
+    mapping_->commit(version, data, size, mapping_->maxSequence() + 1);
+    if (sync) mapping_->sync();
+    return true;
+}
+
+bool CheckpointRegion::grow(std::size_t size) {
+    // 新容量的文件写入当前有效负载后 rename 替换：任何时刻崩溃，路径上都是一个完整的文件
+    const std::size_t capacity = alignUp(std::max(size, mapping_->capacity() * 2));
+    const std::string tmp = path_ + ".tmp";
+    auto bigger = Mapping::create(tmp, capacity, false);
+    if (!bigger) return false;
+    const int valid = mapping_->latestValid();
+    if (valid >= 0) {
+        const CheckpointSlot* s = mapping_->slot(valid);
+        bigger->commit(s->version, mapping_->payload(valid), static_cast<std::size_t>(s->size),
+                       s->sequence.load(std::memory_order_acquire));
+    }
+    if (std::rename(tmp.c_str(), path_.c_str()) != 0) {
+        ::unlink(tmp.c_str());
+        return false;
+    }
+    mapping_ = std::move(bigger);
+    return true;
+}
+
+bool CheckpointRegion::read(std::uint32_t version, std::string& out) const {
+    const int valid = mapping_->latestValid();
+    if (valid < 0) return false;
+    const CheckpointSlot* s = mapping_->slot(valid);
+    if (s->version != version) return false;
+    out.assign(mapping_->payload(valid), static_cast<std::size_t>(s->size));
+    return true;
+}
+
+CheckpointSection::CheckpointSection(std::unique_ptr<CheckpointRegion> region, std::string name,
+                                     std::uint32_t version, int periodMs, bool sync)
+    : region_(std::move(region))
+    , name_(std::move(name))
+    , version_(version)
+    , periodNs_(static_cast<std::int64_t>(std::max(periodMs, 0)) * 1000000)
+    , sync_(sync) {}
+
+bool CheckpointSection::save(std::int64_t nowNs, const SaveFn& fn, bool force) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!force && saved_ && nowNs - lastSaveNs_ < periodNs_) return false;
+    lastSaveNs_ = nowNs;
+    writer_.clear();
+    fn(writer_);
+    const std::string& payload = writer_.buffer();
+    const std::uint64_t hash = payloadChecksum(version_, payload.data(), payload.size());
+    if (saved_ && hash == lastHash_) {
+        ++unchanged_;
+        return false;
+    }
+    if (!region_->write(version_, payload.data(), payload.size(), sync_)) return false;
+    saved_ = true;
+    lastHash_ = hash;
+    ++writes_;
+    bytes_ += payload.size();
+    return true;
+}
+
+bool CheckpointSection::restore(const RestoreFn& fn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string payload;
+    if (!region_->read(version_, payload)) return false;
+    CheckpointReader reader(payload.data(), payload.size());
+    if (!fn(reader)) {
+        std::cerr << "[StateCheckpoint] section " << name_ << " v" << version_ << " rejected by restore" << std::endl;
+        return false;
+    }
+    // 恢复的内容即已写入的内容：状态未变化时下一次 save() 不必重写
+    saved_ = true;
+    lastHash_ = payloadChecksum(version_, payload.data(), payload.size());
+    return true;
+}
+
+StateCheckpointer::StateCheckpointer(StateCheckpointConfig config) : config_(std::move(config)) {}
+
+std::shared_ptr<CheckpointSection> StateCheckpointer::section(const std::string& name, std::uint32_t version) {
+    if (!validName(name)) {
+        std::cerr << "[StateCheckpoint] invalid section name: " << name << std::endl;
+        return nullptr;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(config_.directory, ec);
+    auto region = CheckpointRegion::open((std::filesystem::path(config_.directory) / (name + ".ckpt")).string());
+    if (!region) return nullptr;
+    return std::make_shared<CheckpointSection>(std::move(region), name, version, config_.periodMs, config_.sync);
+}
+
+void StateCheckpointer::discard() {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(config_.directory, ec)) {
+        if (entry.path().extension() == ".ckpt") std::filesystem::remove(entry.path(), ec);
+    }
+}
+
+} // namespace falconmind::sdk::core
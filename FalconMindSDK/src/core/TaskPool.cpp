@@ -0,0 +1,283 @@
+#include "falconmind/sdk/core/TaskPool.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <utility>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+constexpr std::size_t kNoWorker = std::numeric_limits<std::size_t>::max();
+
+struct WorkerSlot {
+    const TaskPool* pool{nullptr};
+    std::size_t index{kNoWorker};
+};
+thread_local WorkerSlot tlsWorker;
+
+std::mutex gSharedMutex;
+bool gSharedCreated{false};
+TaskPoolConfig gSharedConfig;
+bool gSharedConfigured{false};
+
+void runTask(const TaskPool::Task& task) noexcept {
+    try {
+        task();
+    } catch (const std::exception& e) {
+        FM_LOG_ERROR("TaskPool", "task threw: ", e.what());
+    } catch (...) {
+        FM_LOG_ERROR("TaskPool", "task threw unknown exception");
+    }
+}
+
+} // namespace
+
+struct TaskPool::Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+struct TaskPool::Worker {
+    Queue queues[kPriorities];
+    std::thread thread;
+};
+
+TaskPool::TaskPool(const TaskPoolConfig& config) : config_(config), injected_(new Queue[kPriorities]) {
+    const std::size_t count = config_.threads > 0 ? config_.threads : defaultThreads();
+    workers_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) workers_.push_back(std::make_unique<Worker>());
+    for (std::size_t i = 0; i < count; ++i) {
+        workers_[i]->thread = std::thread(&TaskPool::workerLoop, this, i);
+    }
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    sleepCv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+}
+
+TaskPool& TaskPool::shared() {
+    // 不析构：静态析构期间仍可能有内核提交任务
+    static TaskPool* pool = [] {
+        std::lock_guard<std::mutex> lock(gSharedMutex);
+        TaskPoolConfig cfg = gSharedConfig;
+        if (!gSharedConfigured) {
+            if (const char* env = std::getenv("FALCONMIND_TASK_THREADS"); env && *env) {
+                cfg.threads = static_cast<std::size_t>(std::strtoul(env, nullptr, 10));
+            }
+        }
+        gSharedCreated = true;
+        return new TaskPool(cfg);
+    }();
+    return *pool;
+}
+
+bool TaskPool::configureShared(const TaskPoolConfig& config) {
+    std::lock_guard<std::mutex> lock(gSharedMutex);
+    if (gSharedCreated) return false;
+    gSharedConfig = config;
+    gSharedConfigured = true;
+    return true;
+}
+
+std::size_t TaskPool::defaultThreads() {
+    const std::size_t hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 1;
+}
+
+bool TaskPool::inWorker() const noexcept {
+    return tlsWorker.pool == this;
+}
+
+void TaskPool::submit(Task task, TaskPriority priority) {
+    if (!task) return;
+    const auto p = static_cast<std::size_t>(priority);
+    Queue& queue = inWorker() ? workers_[tlsWorker.index]->queues[p] : injected_[p];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    queued_.fetch_add(1);
+    // 工作线程在 sleepMutex_ 下登记休眠并检查 queued_，这里先增加 queued_ 再在同一把锁下查看，不会漏唤醒
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        if (sleeping_ == 0) return;
+    }
+    sleepCv_.notify_one();
+}
+
+bool TaskPool::takeTask(std::size_t self, Task& out, bool& stolen) {
+    if (queued_.load() == 0) return false;
+    const std::size_t n = workers_.size();
+    for (std::size_t p = 0; p < kPriorities; ++p) {
+        if (self != kNoWorker) {
+            Queue& own = workers_[self]->queues[p];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                out = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                queued_.fetch_sub(1);
+                stolen = false;
+                return true;
+            }
+        }
+        {
+            Queue& shared = injected_[p];
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            if (!shared.tasks.empty()) {
+                out = std::move(shared.tasks.front());
+                shared.tasks.pop_front();
+                queued_.fetch_sub(1);
+                stolen = false;
+                return true;
+            }
+        }
+        const std::size_t start = self != kNoWorker ? self + 1 : 0;
+        for (std::size_t k = 0; k < n; ++k) {
+            const std::size_t victim = (start + k) % n;
+            if (victim == self) continue;
+            Queue& other = workers_[victim]->queues[p];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            if (!other.tasks.empty()) {
+                out = std::move(other.tasks.front());
+                other.tasks.pop_front();
+                queued_.fetch_sub(1);
+                stolen = true;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void TaskPool::workerLoop(std::size_t index) {
+    tlsWorker = WorkerSlot{this, index};
+    if (config_.placement.pinsThread()) {
+        applyThreadPlacement(config_.placement, "task-pool");
+    }
+    FM_TRACE_THREAD_NAME("task-pool");
+    Task task;
+    for (;;) {
+        bool stolen = false;
+        if (takeTask(index, task, stolen)) {
+            runTask(task);
+            task = nullptr;
+            executed_.fetch_add(1, std::memory_order_relaxed);
+            if (stolen) stolen_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        ++sleeping_;
+        sleepCv_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+        --sleeping_;
+        if (stop_ && queued_.load() == 0) return;
+    }
+}
+
+bool TaskPool::runOne() {
+    Task task;
+    bool stolen = false;
+    if (!takeTask(inWorker() ? tlsWorker.index : kNoWorker, task, stolen)) return false;
+    runTask(task);
+    executed_.fetch_add(1, std::memory_order_relaxed);
+    helped_.fetch_add(1, std::memory_order_relaxed);
+    if (stolen) stolen_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+TaskPoolStats TaskPool::stats() const noexcept {
+    TaskPoolStats out;
+    out.submitted = submitted_.load(std::memory_order_relaxed);
+    out.executed = executed_.load(std::memory_order_relaxed);
+    out.stolen = stolen_.load(std::memory_order_relaxed);
+    out.helped = helped_.load(std::memory_order_relaxed);
+    return out;
+}
+
+TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+        // 未被 wait() 取走的异常在析构时丢弃
+    }
+}
+
+void TaskGroup::run(TaskPool::Task task) {
+    state_->pending.fetch_add(1);
+    pool_.submit([state = state_, task = std::move(task)] {
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (!state->error) state->error = std::current_exception();
+        }
+        if (state->pending.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->done.notify_all();
+        }
+    }, priority_);
+}
+
+void TaskGroup::wait() {
+    State& s = *state_;
+    while (s.pending.load() > 0) {
+        if (pool_.runOne()) continue;
+        // 剩余任务正在其它线程执行：短暂等待后再看是否有新任务可帮忙执行
+        std::unique_lock<std::mutex> lock(s.mutex);
+        s.done.wait_for(lock, std::chrono::microseconds(200), [&s] { return s.pending.load() == 0; });
+    }
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        error = std::exchange(s.error, nullptr);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void parallelFor(std::size_t begin, std::size_t end, std::size_t grain,
+                 const std::function<void(std::size_t, std::size_t)>& body, TaskPriority priority, TaskPool& pool) {
+    if (end <= begin) return;
+    grain = std::max<std::size_t>(1, grain);
+    const std::size_t chunks = (end - begin + grain - 1) / grain;
+    if (chunks == 1 || pool.concurrency() == 1) {
+        body(begin, end);
+        return;
+    }
+    std::atomic<std::size_t> next{0};
+    auto claim = [&] {
+        for (std::size_t c = next.fetch_add(1); c < chunks; c = next.fetch_add(1)) {
+            const std::size_t first = begin + c * grain;
+            body(first, std::min(end, first + grain));
+        }
+    };
+    TaskGroup group(pool, priority);
+    const std::size_t helpers = std::min(chunks, pool.concurrency()) - 1;
+    for (std::size_t i = 0; i < helpers; ++i) group.run(claim);
+    try {
+        claim();
+    } catch (...) {
+        // 其余分块不再认领；等辅助任务退出后（它们引用本栈帧）再抛出调用线程的异常
+        next.store(chunks);
+        try {
+            group.wait();
+        } catch (...) {
+        }
+        throw;
+    }
+    group.wait();
+}
+
+} // namespace falconmind::sdk::core
@@ -0,0 +1,161 @@
+#include "falconmind/sdk/core/TimeSync.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace falconmind::sdk::core {
+
+ClockSync::ClockSync(const ClockSyncConfig& config) : config_(config) {
+    buckets_.reserve(std::max<std::size_t>(config_.buckets, 1));
+}
+
+void ClockSync::restartLocked(std::int64_t sensorNs, std::int64_t hostNs) {
+    hasReference_ = true;
+    sensorRef_ = sensorNs;
+    hostRef_ = hostNs;
+    lastX_ = 0.;
+    buckets_.clear();
+    bucketHead_ = 0;
+    intercept_ = 0.;
+    slope_ = 0.;
+    lateRun_ = 0;
+}
+
+void ClockSync::refitLocked() {
+    // 正在填充的桶样本少、最小值偏高：有已完成的桶时只用已完成的桶拟合
+    const std::size_t n = buckets_.size();
+    const bool skipHead = n >= 2;
+    const std::size_t used = skipHead ? n - 1 : n;
+    double mx = 0., my = 0.;
+    for (std::size_t k = 0; k < n; ++k) {
+        if (skipHead && k == bucketHead_) continue;
+        mx += buckets_[k].x;
+        my += buckets_[k].y;
+    }
+    mx /= static_cast<double>(used);
+    my /= static_cast<double>(used);
+    double sxx = 0., sxy = 0.;
+    for (std::size_t k = 0; k < n; ++k) {
+        if (skipHead && k == bucketHead_) continue;
+        sxx += (buckets_[k].x - mx) * (buckets_[k].x - mx);
+        sxy += (buckets_[k].x - mx) * (buckets_[k].y - my);
+    }
+    const double limit = config_.maxDriftPpm * 1e-6;
+    slope_ = sxx > 0. ? std::clamp(sxy / sxx, -limit, limit) : 0.;
+    intercept_ = my - slope_ * mx;
+    // 下包络不应高于最新的最小时延点（时延变小或漂移变化时及时跟随）
+    const Bucket& head = buckets_[bucketHead_];
+    const double excess = predictLocked(head.x) - head.y;
+    if (excess > 0.) intercept_ -= excess;
+}
+
+std::int64_t ClockSync::observe(std::int64_t sensorNs, std::int64_t hostNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!hasReference_) restartLocked(sensorNs, hostNs);
+    double x = static_cast<double>(sensorNs - sensorRef_);
+    double y = static_cast<double>(hostNs - hostRef_) - x;
+    if (!buckets_.empty()) {
+        const double residual = y - predictLocked(x);
+        lateRun_ = residual > static_cast<double>(config_.maxJumpNs) ? lateRun_ + 1 : 0;
+        // 回退、前跳、或持续大幅滞后（传感器时钟变慢/暂停）：旧估计失效
+        if (x < lastX_ || residual < -static_cast<double>(config_.maxJumpNs) || lateRun_ >= 8) {
+            restartLocked(sensorNs, hostNs);
+            ++stats_.resets;
+            x = 0.;
+            y = 0.;
+        }
+    }
+    ++stats_.samples;
+
+    const auto index = static_cast<std::int64_t>(std::floor(x / static_cast<double>(config_.bucketNs)));
+    bool changed = false;
+    if (buckets_.empty() || buckets_[bucketHead_].index != index) {
+        const Bucket b{index, x, y};
+        if (buckets_.size() < buckets_.capacity()) {
+            buckets_.push_back(b);
+            bucketHead_ = buckets_.size() - 1;
+        } else {
+            bucketHead_ = (bucketHead_ + 1) % buckets_.size();
+            buckets_[bucketHead_] = b;
+        }
+        changed = true;
+    } else if (y < buckets_[bucketHead_].y) {
+        buckets_[bucketHead_].x = x;
+        buckets_[bucketHead_].y = y;
+        changed = true;
+    }
+    if (changed) refitLocked();
+
+    const double latency = y - predictLocked(x);
+    stats_.jitterNs += (std::max(latency, 0.) - stats_.jitterNs) * (1.0 / 64.0);
+    lastX_ = x;
+
+    std::int64_t out = hostRef_ + (sensorNs - sensorRef_) + std::llround(predictLocked(x));
+    out = std::min(out, hostNs);  // 不可能晚于到达时刻
+    if (stats_.samples > 1 && out <= lastOut_) out = lastOut_ + 1;
+    lastOut_ = out;
+    return out;
+}
+
+std::int64_t ClockSync::toHost(std::int64_t sensorNs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!hasReference_) return 0;
+    const double x = static_cast<double>(sensorNs - sensorRef_);
+    return hostRef_ + (sensorNs - sensorRef_) + std::llround(predictLocked(x));
+}
+
+ClockSyncStats ClockSync::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ClockSyncStats s = stats_;
+    s.offsetNs = hasReference_ ? hostRef_ - sensorRef_ + std::llround(predictLocked(lastX_)) : 0;
+    s.driftPpm = slope_ * 1e6;
+    s.locked = buckets_.size() >= 3;
+    return s;
+}
+
+void ClockSync::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    hasReference_ = false;
+    buckets_.clear();
+    bucketHead_ = 0;
+    intercept_ = 0.;
+    slope_ = 0.;
+    lateRun_ = 0;
+    lastOut_ = 0;
+    stats_ = ClockSyncStats{};
+}
+
+TimeSyncService& TimeSyncService::instance() {
+    static TimeSyncService inst;
+    return inst;
+}
+
+ClockSyncPtr TimeSyncService::clock(const std::string& sensorId, const ClockSyncConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = clocks_[sensorId];
+    if (!slot) slot = std::make_shared<ClockSync>(config);
+    return slot;
+}
+
+void TimeSyncService::remove(const std::string& sensorId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    clocks_.erase(sensorId);
+}
+
+std::vector<std::pair<std::string, ClockSyncStats>> TimeSyncService::snapshot() const {
+    std::vector<ClockSyncPtr> clocks;
+    std::vector<std::pair<std::string, ClockSyncStats>> out;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        out.reserve(clocks_.size());
+        for (const auto& [id, clock] : clocks_) {
+            out.emplace_back(id, ClockSyncStats{});
+            clocks.push_back(clock);
+        }
+    }
+    for (std::size_t i = 0; i < out.size(); ++i) out[i].second = clocks[i]->stats();
+    std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    return out;
+}
+
+} // namespace falconmind::sdk::core
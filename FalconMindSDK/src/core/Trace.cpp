@@ -0,0 +1,290 @@
+#include "falconmind/sdk/core/Trace.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace falconmind::sdk::core {
+
+namespace {
+
+static_assert((Tracer::kThreadEvents & (Tracer::kThreadEvents - 1)) == 0, "kThreadEvents must be a power of two");
+
+std::atomic<bool> gEnabled{false};
+
+// 事件字段均为 relaxed 原子量：导出线程与写入线程并发访问时无数据竞争，撕裂的槽位按序号丢弃
+struct Slot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<const char*> category{nullptr};
+    std::atomic<std::int64_t> startNs{0};
+    std::atomic<std::int64_t> durNs{-1};  // < 0 为瞬时事件
+};
+
+/**
+ * 单写者（所属线程）环形缓冲，按 seqlock 方式发布：
+ * 写者先推进 claimed 再写槽位、最后推进 committed；导出方读 committed 之前的槽位后再读 claimed，
+ * 序号不大于 claimed - kThreadEvents 的槽位可能已被覆盖，丢弃
+ */
+struct ThreadBuffer {
+    alignas(64) std::atomic<std::uint64_t> claimed{0};
+    std::atomic<std::uint64_t> committed{0};
+    std::atomic<std::uint64_t> clearedBefore{0};  // clear() 之前的事件不再导出
+    std::atomic<const char*> threadName{nullptr};
+    std::atomic<bool> retired{false};
+    std::uint32_t tid{0};
+    std::array<Slot, Tracer::kThreadEvents> slots;
+};
+
+// 线程局部状态均为平凡类型，线程析构顺序中任何时刻访问都安全
+struct ThreadSlot {
+    ThreadBuffer* buffer{nullptr};
+    const char* name{nullptr};
+    bool exited{false};
+};
+thread_local ThreadSlot tlsSlot;
+
+struct CopiedEvent {
+    const char* name;
+    const char* category;
+    std::int64_t startNs;
+    std::int64_t durNs;
+};
+
+} // namespace
+
+struct Tracer::State {
+    std::mutex registryMutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::string exitPath;  // FALCONMIND_TRACE
+};
+
+namespace {
+
+ThreadBuffer* threadBuffer(std::mutex& registryMutex, std::vector<std::shared_ptr<ThreadBuffer>>& registry) noexcept {
+    if (tlsSlot.buffer) return tlsSlot.buffer;
+    if (tlsSlot.exited) return nullptr;
+    // 首个事件：注册本线程缓冲，线程退出时标记 retired（缓冲保留到 clear()，退出线程的事件仍可导出）
+    try {
+        auto created = std::make_shared<ThreadBuffer>();
+        created->tid = static_cast<std::uint32_t>(::syscall(SYS_gettid));
+        created->threadName.store(tlsSlot.name, std::memory_order_relaxed);
+        ThreadBuffer* buffer = created.get();
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            registry.push_back(std::move(created));
+        }
+        tlsSlot.buffer = buffer;
+        struct Retire {
+            ~Retire() {
+                if (tlsSlot.buffer) tlsSlot.buffer->retired.store(true, std::memory_order_release);
+                tlsSlot.buffer = nullptr;
+                tlsSlot.exited = true;
+            }
+        };
+        static thread_local Retire retire;
+        (void)retire;
+        return buffer;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void push(ThreadBuffer& b, const char* category, const char* name, std::int64_t startNs, std::int64_t durNs) noexcept {
+    const std::uint64_t seq = b.claimed.load(std::memory_order_relaxed);
+    b.claimed.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Slot& slot = b.slots[seq & (Tracer::kThreadEvents - 1)];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.durNs.store(durNs, std::memory_order_relaxed);
+    b.committed.store(seq + 1, std::memory_order_release);
+}
+
+std::vector<CopiedEvent> copyEvents(const ThreadBuffer& b) {
+    const std::uint64_t end = b.committed.load(std::memory_order_acquire);
+    const std::uint64_t floor = b.clearedBefore.load(std::memory_order_relaxed);
+    std::uint64_t begin = end > Tracer::kThreadEvents ? end - Tracer::kThreadEvents : 0;
+    begin = std::max(begin, floor);
+    std::vector<CopiedEvent> out;
+    out.reserve(static_cast<std::size_t>(end > begin ? end - begin : 0));
+    for (std::uint64_t seq = begin; seq < end; ++seq) {
+        const Slot& slot = b.slots[seq & (Tracer::kThreadEvents - 1)];
+        out.push_back(CopiedEvent{slot.name.load(std::memory_order_relaxed),
+                                  slot.category.load(std::memory_order_relaxed),
+                                  slot.startNs.load(std::memory_order_relaxed),
+                                  slot.durNs.load(std::memory_order_relaxed)});
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // 复制期间写者继续前进时，最前面的一段可能已被新事件覆盖
+    const std::uint64_t claimed = b.claimed.load(std::memory_order_relaxed);
+    if (claimed > Tracer::kThreadEvents) {
+        const std::uint64_t firstValid = claimed - Tracer::kThreadEvents;
+        if (firstValid > begin) {
+            const auto skip = static_cast<std::size_t>(std::min<std::uint64_t>(firstValid - begin, out.size()));
+            out.erase(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(skip));
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+Tracer& Tracer::instance() {
+    // 不析构：线程退出与静态析构期间仍可能有事件写入
+    static Tracer* tracer = new Tracer();
+    return *tracer;
+}
+
+Tracer::Tracer() : state_(new State()) {
+    if (const char* path = std::getenv("FALCONMIND_TRACE"); path && *path) {
+        state_->exitPath = path;
+        gEnabled.store(true, std::memory_order_release);
+        std::atexit([] {
+            Tracer& tracer = Tracer::instance();
+            tracer.stop();
+            if (!tracer.writeChromeTrace(tracer.state_->exitPath)) {
+                FM_LOG_WARN("Trace", "Cannot write trace to ", tracer.state_->exitPath);
+            }
+        });
+    }
+}
+
+namespace {
+// 使 FALCONMIND_TRACE 在进程启动时即生效，而不是等到第一次 instance()
+const bool kTracerEnvInit = (Tracer::instance(), true);
+} // namespace
+
+bool Tracer::enabled() noexcept {
+    return gEnabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::start() {
+    gEnabled.store(true, std::memory_order_release);
+}
+
+void Tracer::stop() {
+    gEnabled.store(false, std::memory_order_release);
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(state_->registryMutex);
+    auto& buffers = state_->buffers;
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [](const std::shared_ptr<ThreadBuffer>& b) {
+                                     return b->retired.load(std::memory_order_acquire);
+                                 }),
+                  buffers.end());
+    for (auto& b : buffers) {
+        b->clearedBefore.store(b->committed.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+const char* Tracer::intern(std::string_view name) {
+    static std::mutex* mutex = new std::mutex();
+    static auto* names = new std::unordered_set<std::string>();  // 节点式容器，元素地址不变；永不释放
+    std::lock_guard<std::mutex> lock(*mutex);
+    return names->emplace(name).first->c_str();
+}
+
+void Tracer::setThreadName(const char* name) noexcept {
+    tlsSlot.name = name;
+    if (tlsSlot.buffer) tlsSlot.buffer->threadName.store(name, std::memory_order_relaxed);
+}
+
+void Tracer::complete(const char* category, const char* name, std::int64_t startNs, std::int64_t endNs) noexcept {
+    if (!enabled()) return;
+    State& s = *instance().state_;
+    if (ThreadBuffer* b = threadBuffer(s.registryMutex, s.buffers)) {
+        push(*b, category, name, startNs, std::max<std::int64_t>(0, endNs - startNs));
+    }
+}
+
+void Tracer::instant(const char* category, const char* name) noexcept {
+    if (!enabled()) return;
+    State& s = *instance().state_;
+    if (ThreadBuffer* b = threadBuffer(s.registryMutex, s.buffers)) {
+        push(*b, category, name, PipelineClock::nowNs(), -1);
+    }
+}
+
+TraceStats Tracer::stats() const {
+    TraceStats out;
+    std::lock_guard<std::mutex> lock(state_->registryMutex);
+    out.threads = state_->buffers.size();
+    for (const auto& b : state_->buffers) {
+        const std::uint64_t committed = b->committed.load(std::memory_order_acquire);
+        out.recorded += committed;
+        if (committed > kThreadEvents) out.overwritten += committed - kThreadEvents;
+    }
+    return out;
+}
+
+std::string Tracer::toChromeTrace() const {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(state_->registryMutex);
+        buffers = state_->buffers;
+    }
+    const auto pid = static_cast<std::int64_t>(::getpid());
+    nlohmann::json events = nlohmann::json::array();
+    events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", pid}, {"args", {{"name", "falconmind"}}}});
+    for (const auto& b : buffers) {
+        if (const char* threadName = b->threadName.load(std::memory_order_relaxed)) {
+            events.push_back({{"name", "thread_name"},
+                              {"ph", "M"},
+                              {"pid", pid},
+                              {"tid", b->tid},
+                              {"args", {{"name", threadName}}}});
+        }
+        for (const auto& ev : copyEvents(*b)) {
+            nlohmann::json e = {{"name", ev.name ? ev.name : "?"},
+                                {"cat", ev.category ? ev.category : "default"},
+                                {"pid", pid},
+                                {"tid", b->tid},
+                                {"ts", static_cast<double>(ev.startNs) / 1e3}};
+            if (ev.durNs >= 0) {
+                e["ph"] = "X";
+                e["dur"] = static_cast<double>(ev.durNs) / 1e3;
+            } else {
+                e["ph"] = "i";
+                e["s"] = "t";
+            }
+            events.push_back(std::move(e));
+        }
+    }
+    nlohmann::json trace = {{"traceEvents", std::move(events)},
+                            {"displayTimeUnit", "ms"},
+                            {"otherData", {{"clock", "CLOCK_MONOTONIC"}}}};
+    return trace.dump();
+}
+
+bool Tracer::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) return false;
+    out << toChromeTrace() << '\n';
+    return static_cast<bool>(out);
+}
+
+TraceScope::TraceScope(const char* category, const char* name) noexcept : category_(category), name_(name) {
+    if (Tracer::enabled()) startNs_ = PipelineClock::nowNs();
+}
+
+void TraceScope::finish() noexcept {
+    Tracer::complete(category_, name_, startNs_, PipelineClock::nowNs());
+}
+
+} // namespace falconmind::sdk::core
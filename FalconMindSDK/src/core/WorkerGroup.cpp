@@ -0,0 +1,40 @@
+#include "falconmind/sdk/core/WorkerGroup.h"
+#include "falconmind/sdk/core/TaskPool.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace falconmind::sdk::core {
+
+WorkerGroup::WorkerGroup(std::size_t count) : WorkerGroup(count, TaskPool::shared()) {}
+
+WorkerGroup::WorkerGroup(std::size_t count, TaskPool& pool) : count_(std::max<std::size_t>(1, count)), pool_(&pool) {}
+
+std::size_t WorkerGroup::defaultCount() {
+    std::size_t hw = std::thread::hardware_concurrency();
+    return std::max<std::size_t>(1, std::min<std::size_t>(hw, 4));
+}
+
+void WorkerGroup::run(const std::function<void(std::size_t)>& task) {
+    if (count_ == 1) {
+        task(0);
+        return;
+    }
+    TaskGroup group(*pool_);
+    for (std::size_t i = 1; i < count_; ++i) {
+        group.run([&task, i] { task(i); });
+    }
+    try {
+        task(0);
+    } catch (...) {
+        // 分片引用调用方的栈帧，先等其余分片结束
+        try {
+            group.wait();
+        } catch (...) {
+        }
+        throw;
+    }
+    group.wait();
+}
+
+} // namespace falconmind::sdk::core
@@ -1,16 +1,81 @@
 #include "falconmind/sdk/flight/FlightConnectionService.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/flight/MavlinkRouter.h"
+#include "falconmind/sdk/core/FlightLog.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/core/Trace.h"
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
 #include <unistd.h>
-
+#include <errno.h>
+#ifdef __linux__
+#include <linux/serial.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <cstring>
 #include <iostream>
 
 namespace falconmind::sdk::flight {
 
+namespace {
+
+bool isSerialLink(const std::string& linkType) {
+    std::string t = linkType;
+    std::transform(t.begin(), t.end(), t.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    return t == "SERIAL" || t == "UART";
+}
+
+bool baudToSpeed(int baud, speed_t& speed) {
+    switch (baud) {
+        case 9600: speed = B9600; return true;
+        case 19200: speed = B19200; return true;
+        case 38400: speed = B38400; return true;
+        case 57600: speed = B57600; return true;
+        case 115200: speed = B115200; return true;
+        case 230400: speed = B230400; return true;
+#ifdef B460800
+        case 460800: speed = B460800; return true;
+#endif
+#ifdef B500000
+        case 500000: speed = B500000; return true;
+#endif
+#ifdef B921600
+        case 921600: speed = B921600; return true;
+#endif
+#ifdef B1000000
+        case 1000000: speed = B1000000; return true;
+#endif
+#ifdef B1500000
+        case 1500000: speed = B1500000; return true;
+#endif
+#ifdef B2000000
+        case 2000000: speed = B2000000; return true;
+#endif
+#ifdef B3000000
+        case 3000000: speed = B3000000; return true;
+#endif
+        default: return false;
+    }
+}
+
+// ACK 超时、任务上传重传等定时随 PipelineClock（虚拟时钟下按虚拟时刻到期）
+std::int64_t steadyNowNs() noexcept {
+    return core::PipelineClock::nowNs();
+}
+
+} // namespace
+
 FlightConnectionService::FlightConnectionService() = default;
 
 FlightConnectionService::~FlightConnectionService() {
@@ -22,34 +87,148 @@ bool FlightConnectionService::connect(const FlightConnectionConfig& cfg) {
         return true;
     }
 
-    sock_ = ::socket(AF_INET, SOCK_DGRAM, 0);
-    if (sock_ < 0) {
-        std::perror("socket");
+    cfg_ = cfg;
+    targetSystem_ = 1;
+    serial_ = isSerialLink(cfg_.linkType);
+    if (!(serial_ ? openSerial() : openUdp())) {
         return false;
     }
+    parser_.reset();
+    recvStorage_.assign(kRecvBatch * kDatagramBytes, 0);
+    polledVersion_.store(stateSnapshot_.version(), std::memory_order_relaxed);
+    connected_ = true;
+    if (serial_) {
+        std::cout << "[FlightConnectionService] serial connect to " << cfg_.serialDevice << " @ " << cfg_.baudRate
+                  << std::endl;
+    } else {
+        std::cout << "[FlightConnectionService] UDP connect to "
+                  << cfg_.remoteAddress << ":" << cfg_.remotePort << std::endl;
+    }
+    return true;
+}
 
-    cfg_ = cfg;
+bool FlightConnectionService::connect(std::shared_ptr<MavlinkRouter> router, std::uint8_t targetSystem,
+                                      MavlinkVersion version) {
+    if (connected_) {
+        return true;
+    }
+    if (!router) {
+        std::cerr << "[FlightConnectionService] connect: null router" << std::endl;
+        return false;
+    }
+    cfg_ = FlightConnectionConfig{};
+    cfg_.linkType = "ROUTER";
+    cfg_.mavlinkVersion = version;
+    serial_ = false;
+    targetSystem_ = targetSystem;
+    polledVersion_.store(stateSnapshot_.version(), std::memory_order_relaxed);
+    if (!router->attach(targetSystem, this)) {
+        return false;
+    }
+    router_ = std::move(router);
+    connected_ = true;
+    std::cout << "[FlightConnectionService] routed connect to sysid " << static_cast<int>(targetSystem) << std::endl;
+    return true;
+}
+
+bool FlightConnectionService::openUdp() {
+    remoteAddr_ = sockaddr_in{};
+    remoteAddr_.sin_family = AF_INET;
+    remoteAddr_.sin_port = htons(static_cast<uint16_t>(cfg_.remotePort));
+    if (::inet_pton(AF_INET, cfg_.remoteAddress.c_str(), &remoteAddr_.sin_addr) != 1) {
+        std::cerr << "[FlightConnectionService] invalid remote address: " << cfg_.remoteAddress << std::endl;
+        return false;
+    }
+    fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd_ < 0) {
+        std::perror("socket");
+        return false;
+    }
     // 设置为非阻塞，用于 pollState() 非阻塞读取
-    int flags = fcntl(sock_, F_GETFL, 0);
+    int flags = fcntl(fd_, F_GETFL, 0);
     if (flags >= 0) {
-        fcntl(sock_, F_SETFL, flags | O_NONBLOCK);
+        fcntl(fd_, F_SETFL, flags | O_NONBLOCK);
     }
-    connected_ = true;
-    std::cout << "[FlightConnectionService] UDP connect to "
-              << cfg_.remoteAddress << ":" << cfg_.remotePort << std::endl;
+    if (cfg_.localPort > 0) {
+        sockaddr_in local{};
+        local.sin_family = AF_INET;
+        local.sin_addr.s_addr = htonl(INADDR_ANY);
+        local.sin_port = htons(static_cast<uint16_t>(cfg_.localPort));
+        if (::bind(fd_, reinterpret_cast<sockaddr*>(&local), sizeof(local)) < 0) {
+            std::perror("[FlightConnectionService] bind");
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FlightConnectionService::openSerial() {
+    speed_t speed;
+    if (!baudToSpeed(cfg_.baudRate, speed)) {
+        std::cerr << "[FlightConnectionService] unsupported baud rate: " << cfg_.baudRate << std::endl;
+        return false;
+    }
+    fd_ = ::open(cfg_.serialDevice.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd_ < 0) {
+        std::cerr << "[FlightConnectionService] open " << cfg_.serialDevice << " failed: " << std::strerror(errno)
+                  << std::endl;
+        return false;
+    }
+
+    // 原始模式 8N1，无流控；VMIN = VTIME = 0 配合非阻塞读，由 poll / epoll 等待数据
+    termios tio{};
+    if (::tcgetattr(fd_, &tio) != 0) {
+        std::cerr << "[FlightConnectionService] tcgetattr failed: " << std::strerror(errno) << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    ::cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | PARENB);
+#ifdef CRTSCTS
+    tio.c_cflag &= ~CRTSCTS;
+#endif
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    ::cfsetispeed(&tio, speed);
+    ::cfsetospeed(&tio, speed);
+    if (::tcsetattr(fd_, TCSANOW, &tio) != 0) {
+        std::cerr << "[FlightConnectionService] tcsetattr failed: " << std::strerror(errno) << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    ::tcflush(fd_, TCIOFLUSH);
+
+#ifdef __linux__
+    // 低延迟：关闭 UART 驱动的接收合并定时器（USB 转串口 / 部分驱动不支持，忽略失败）
+    serial_struct ser{};
+    if (::ioctl(fd_, TIOCGSERIAL, &ser) == 0) {
+        ser.flags |= ASYNC_LOW_LATENCY;
+        (void)::ioctl(fd_, TIOCSSERIAL, &ser);
+    }
+#endif
     return true;
 }
 
 void FlightConnectionService::disconnect() {
-    if (sock_ >= 0) {
-        ::close(sock_);
-        sock_ = -1;
+    stopIoThread();
+    if (router_) {
+        router_->detach(targetSystem_, this);
+        router_.reset();
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
     }
     connected_ = false;
 }
 
 bool FlightConnectionService::sendCommand(const FlightCommand& cmd) {
-    if (!connected_ || sock_ < 0) {
+    if (!linkOpen()) {
         std::cerr << "[FlightConnectionService] sendCommand: not connected" << std::endl;
         return false;
     }
@@ -58,130 +237,655 @@ bool FlightConnectionService::sendCommand(const FlightCommand& cmd) {
     if (!encodeMavlinkCommand(cmd, payload)) {
         return false;
     }
-    sockaddr_in addr{};
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(static_cast<uint16_t>(cfg_.remotePort));
-    ::inet_pton(AF_INET, cfg_.remoteAddress.c_str(), &addr.sin_addr);
-
-    auto ret = ::sendto(sock_, payload.data(), payload.size(), 0,
-                        reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
-    if (ret < 0) {
-        std::perror("[FlightConnectionService] sendto");
+    if (!transmit(payload.data(), payload.size())) {
         return false;
     }
     // 为避免在日志中出现二进制乱码，这里只输出简单摘要信息
-    std::cout << "[FlightConnectionService] sendCommand: msgid=76, len="
-              << payload.size() << " bytes" << std::endl;
+    FM_LOG_DEBUG("FlightConnectionService", "sendCommand: msgid=76, len=", payload.size(), " bytes");
     return true;
 }
 
-std::optional<FlightState> FlightConnectionService::pollState() {
-    if (!connected_ || sock_ < 0) {
-        return std::nullopt;
+bool FlightConnectionService::sendCommandAsync(const FlightCommand& cmd, const CommandOptions& options,
+                                               CommandCallback callback) {
+    const std::uint16_t id = mavCommandId(cmd.type);
+    CommandAck ack;
+    ack.command = id;
+    if (!linkOpen()) {
+        std::cerr << "[FlightConnectionService] sendCommandAsync: not connected" << std::endl;
+        ack.result = CommandResult::SendFailed;
+        if (callback) callback(ack);
+        return false;
     }
 
-    // 尝试一次非阻塞读取（若无数据直接返回 empty）
-    std::uint8_t buf[256];
-    ssize_t n = ::recv(sock_, buf, sizeof(buf), MSG_DONTWAIT);
-    if (n <= 0) {
-        return std::nullopt;
+    // 先登记再发送，避免 ACK 先于登记到达
+    const std::int64_t now = steadyNowNs();
+    CommandCallback superseded;
+    {
+        std::lock_guard<std::mutex> lk(commandMutex_);
+        PendingCommand* slot = nullptr;
+        for (auto& p : pending_) {
+            if (p.active && p.command == id) {
+                superseded = std::move(p.callback);  // ACK 只带命令 ID，同一命令不能并行等待
+                slot = &p;
+                break;
+            }
+        }
+        for (std::size_t i = 0; !slot && i < pending_.size(); ++i) {
+            if (!pending_[i].active) slot = &pending_[i];
+        }
+        if (!slot) {
+            std::cerr << "[FlightConnectionService] sendCommandAsync: too many pending commands" << std::endl;
+            ack.result = CommandResult::SendFailed;
+            if (callback) callback(ack);
+            return false;
+        }
+        *slot = PendingCommand{};
+        slot->active = true;
+        slot->cmd = cmd;
+        slot->command = id;
+        slot->options = options;
+        slot->options.maxAttempts = std::max(1, options.maxAttempts);
+        slot->options.timeoutMs = std::max(1, options.timeoutMs);
+        slot->callback = std::move(callback);
+        slot->attempts = 1;
+        slot->firstSentNs = now;
+        slot->deadlineNs = now + static_cast<std::int64_t>(slot->options.timeoutMs) * 1'000'000;
+    }
+    if (superseded) {
+        CommandAck old;
+        old.command = id;
+        old.result = CommandResult::Superseded;
+        superseded(old);
+    }
+
+    std::string frame;
+    if (!encodeMavlinkCommand(cmd, frame, 0) || !transmit(frame.data(), frame.size())) {
+        CommandCallback failed;
+        {
+            std::lock_guard<std::mutex> lk(commandMutex_);
+            for (auto& p : pending_) {
+                if (p.active && p.command == id && p.firstSentNs == now) {
+                    failed = std::move(p.callback);
+                    p = PendingCommand{};
+                }
+            }
+        }
+        ack.result = CommandResult::SendFailed;
+        ack.attempts = 1;
+        if (failed) failed(ack);
+        return false;
+    }
+    wakeIoThread();  // 让 I/O 线程按新的截止时间等待
+    return true;
+}
+
+std::future<CommandAck> FlightConnectionService::sendCommandAsync(const FlightCommand& cmd,
+                                                                  const CommandOptions& options) {
+    auto promise = std::make_shared<std::promise<CommandAck>>();
+    auto future = promise->get_future();
+    sendCommandAsync(cmd, options, [promise](const CommandAck& ack) { promise->set_value(ack); });
+    return future;
+}
+
+std::size_t FlightConnectionService::pendingCommands() const {
+    std::lock_guard<std::mutex> lk(commandMutex_);
+    return static_cast<std::size_t>(
+        std::count_if(pending_.begin(), pending_.end(), [](const PendingCommand& p) { return p.active; }));
+}
+
+bool FlightConnectionService::sendMissionMessage(std::uint32_t msgid, const std::uint8_t* payload, std::size_t length) {
+    if (cfg_.mavlinkVersion == MavlinkVersion::V1) {
+        length = std::min(length, msgid == mavlink::kMsgMissionCount ? MissionUploader::kCountLenV1
+                                                                      : MissionUploader::kItemIntLenV1);
+    }
+    std::uint8_t frame[mavlink::kMaxFrame];
+    const std::size_t size =
+        mavlink::encodeFrame(cfg_.mavlinkVersion, nextSequence(), kSysId, kCompId, msgid, payload, length, frame);
+    return size > 0 && transmit(frame, size);
+}
+
+bool FlightConnectionService::uploadMission(std::vector<MissionItem> items, const MissionUploadOptions& options,
+                                            MissionCallback callback) {
+    MissionUploadAck ack;
+    ack.count = static_cast<std::uint16_t>(std::min<std::size_t>(items.size(), 0xFFFF));
+    if (!linkOpen()) {
+        std::cerr << "[FlightConnectionService] uploadMission: not connected" << std::endl;
+        ack.result = MissionUploadResult::SendFailed;
+        if (callback) callback(ack);
+        return false;
+    }
+
+    // 持锁发送 MISSION_COUNT：飞控的第一个请求可能先于 begin() 返回到达，解析线程须等登记完成
+    MissionCallback superseded;
+    bool sent = false;
+    {
+        std::lock_guard<std::mutex> lk(missionMutex_);
+        if (mission_.active()) {
+            mission_.cancel();
+            superseded = std::move(missionCallback_);
+        }
+        missionCallback_ = std::move(callback);
+        sent = mission_.begin(std::move(items), targetSystem_, 1, options, steadyNowNs(),
+                              [this](std::uint32_t msgid, const std::uint8_t* payload, std::size_t length) {
+                                  return sendMissionMessage(msgid, payload, length);
+                              });
+        if (!sent) callback = std::move(missionCallback_);
+    }
+    if (superseded) {
+        MissionUploadAck old;
+        old.result = MissionUploadResult::Superseded;
+        superseded(old);
+    }
+    if (!sent) {
+        ack.result = MissionUploadResult::SendFailed;
+        if (callback) callback(ack);
+        return false;
+    }
+    FM_LOG_DEBUG("FlightConnectionService", "uploadMission: count=", ack.count);
+    wakeIoThread();
+    return true;
+}
+
+std::future<MissionUploadAck> FlightConnectionService::uploadMission(std::vector<MissionItem> items,
+                                                                     const MissionUploadOptions& options) {
+    auto promise = std::make_shared<std::promise<MissionUploadAck>>();
+    auto future = promise->get_future();
+    uploadMission(std::move(items), options, [promise](const MissionUploadAck& ack) { promise->set_value(ack); });
+    return future;
+}
+
+bool FlightConnectionService::missionUploadActive() const {
+    std::lock_guard<std::mutex> lk(missionMutex_);
+    return mission_.active();
+}
+
+bool FlightConnectionService::handleMissionFrame(const mavlink::Frame& frame) {
+    if (frame.msgid != mavlink::kMsgMissionRequestInt && frame.msgid != mavlink::kMsgMissionRequest &&
+        frame.msgid != mavlink::kMsgMissionAck) {
+        return false;
+    }
+    MissionCallback callback;
+    MissionUploadAck ack;
+    {
+        std::lock_guard<std::mutex> lk(missionMutex_);
+        const auto send = [this](std::uint32_t msgid, const std::uint8_t* payload, std::size_t length) {
+            return sendMissionMessage(msgid, payload, length);
+        };
+        if (!mission_.onFrame(frame, steadyNowNs(), send, ack)) return true;
+        callback = std::move(missionCallback_);
+    }
+    if (callback) callback(ack);
+    return true;
+}
+
+void FlightConnectionService::handleCommandAck(const mavlink::Frame& frame) {
+    // COMMAND_ACK：command(u16) result(u8) progress(u8) result_param2(i32) target_system target_component
+    std::uint16_t command;
+    std::memcpy(&command, frame.payload, sizeof(command));
+    const std::uint8_t result = frame.payload[2];
+    const std::int64_t now = steadyNowNs();
+
+    CommandCallback callback;
+    CommandAck ack;
+    {
+        std::lock_guard<std::mutex> lk(commandMutex_);
+        auto it = std::find_if(pending_.begin(), pending_.end(),
+                               [command](const PendingCommand& p) { return p.active && p.command == command; });
+        if (it == pending_.end()) {
+            return;  // 非本端请求或已超时
+        }
+        if (result == static_cast<std::uint8_t>(CommandResult::InProgress)) {
+            it->inProgress = true;
+            it->progress = frame.payload[3];
+            it->deadlineNs = now + static_cast<std::int64_t>(it->options.timeoutMs) * 1'000'000;
+            return;
+        }
+        ack.result = result <= static_cast<std::uint8_t>(CommandResult::Cancelled) ? static_cast<CommandResult>(result)
+                                                                                  : CommandResult::Failed;
+        ack.command = command;
+        ack.progress = it->progress;
+        ack.attempts = it->attempts;
+        ack.latencyNs = now - it->firstSentNs;
+        callback = std::move(it->callback);
+        *it = PendingCommand{};
+    }
+    if (callback) callback(ack);
+}
+
+std::int64_t FlightConnectionService::serviceCommandTimeouts(std::int64_t nowNs) {
+    struct Due {
+        bool resend{false};
+        FlightCommand cmd{};
+        std::uint8_t confirmation{0};
+        CommandCallback callback;
+        CommandAck ack;
+    };
+    std::array<Due, kMaxPendingCommands> due{};
+    std::size_t dueCount = 0;
+    std::int64_t next = 0;
+    {
+        std::lock_guard<std::mutex> lk(commandMutex_);
+        for (auto& p : pending_) {
+            if (!p.active) continue;
+            if (p.deadlineNs <= nowNs) {
+                Due& d = due[dueCount++];
+                if (!p.inProgress && p.attempts < p.options.maxAttempts) {
+                    d.resend = true;
+                    d.cmd = p.cmd;
+                    d.confirmation = static_cast<std::uint8_t>(p.attempts);
+                    ++p.attempts;
+                    p.deadlineNs = nowNs + static_cast<std::int64_t>(p.options.timeoutMs) * 1'000'000;
+                } else {
+                    d.ack.result = CommandResult::Timeout;
+                    d.ack.command = p.command;
+                    d.ack.progress = p.progress;
+                    d.ack.attempts = p.attempts;
+                    d.ack.latencyNs = nowNs - p.firstSentNs;
+                    d.callback = std::move(p.callback);
+                    p = PendingCommand{};
+                    continue;
+                }
+            }
+            if (next == 0 || p.deadlineNs < next) next = p.deadlineNs;
+        }
+    }
+    for (std::size_t i = 0; i < dueCount; ++i) {
+        Due& d = due[i];
+        if (d.resend) {
+            std::string frame;
+            if (encodeMavlinkCommand(d.cmd, frame, d.confirmation)) {
+                transmit(frame.data(), frame.size());  // 发送失败留给下一次超时重发 / 判定
+            }
+        } else if (d.callback) {
+            d.callback(d.ack);
+        }
+    }
+
+    MissionCallback missionCallback;
+    MissionUploadAck missionAck;
+    {
+        std::lock_guard<std::mutex> lk(missionMutex_);
+        const auto send = [this](std::uint32_t msgid, const std::uint8_t* payload, std::size_t length) {
+            return sendMissionMessage(msgid, payload, length);
+        };
+        if (mission_.service(nowNs, send, missionAck)) missionCallback = std::move(missionCallback_);
+        const std::int64_t missionNext = mission_.deadlineNs();
+        if (missionNext > 0 && (next == 0 || missionNext < next)) next = missionNext;
+    }
+    if (missionCallback) missionCallback(missionAck);
+    return next;
+}
+
+void FlightConnectionService::wakeIoThread() {
+    if (router_) {
+        router_->wake();
+        return;
     }
+#ifdef __linux__
+    if (ioRunning_.load(std::memory_order_acquire) && wakeFd_ >= 0) {
+        std::uint64_t one = 1;
+        (void)!::write(wakeFd_, &one, sizeof(one));
+    }
+#endif
+}
+
+bool FlightConnectionService::sendFrame(const std::uint8_t* frame, std::size_t size) {
+    if (!linkOpen()) {
+        return false;
+    }
+    if (router_) {
+        return router_->sendTo(targetSystem_, frame, size);
+    }
+    if (!serial_) {
+        if (::sendto(fd_, frame, size, 0, reinterpret_cast<const sockaddr*>(&remoteAddr_), sizeof(remoteAddr_)) !=
+            static_cast<ssize_t>(size)) {
+            return false;
+        }
+        if (log_) log_->record(core::LogRecordType::MavlinkTx, frame, size);
+        return true;
+    }
+    return transmit(frame, size);
+}
 
-    if (n < 12) { // 最小 MAVLink 帧长度检查
+bool FlightConnectionService::transmit(const void* data, std::size_t size) {
+    if (router_) {
+        if (!router_->sendTo(targetSystem_, static_cast<const std::uint8_t*>(data), size)) {
+            std::cerr << "[FlightConnectionService] router send to sysid " << static_cast<int>(targetSystem_)
+                      << " failed (vehicle not heard yet?)" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    if (!serial_) {
+        auto ret = ::sendto(fd_, data, size, 0,
+                            reinterpret_cast<const sockaddr*>(&remoteAddr_), sizeof(remoteAddr_));
+        if (ret < 0) {
+            std::perror("[FlightConnectionService] sendto");
+            return false;
+        }
+        if (log_) log_->record(core::LogRecordType::MavlinkTx, data, size);
+        return true;
+    }
+
+    // 串口为字节流：非阻塞 write 可能只写入一部分，发送缓冲满时短暂等待可写
+    std::lock_guard<std::mutex> lk(txMutex_);
+    const auto* p = static_cast<const std::uint8_t*>(data);
+    const std::size_t total = size;
+    while (size > 0) {
+        const ssize_t n = ::write(fd_, p, size);
+        if (n > 0) {
+            p += n;
+            size -= static_cast<std::size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            pollfd pfd{fd_, POLLOUT, 0};
+            if (::poll(&pfd, 1, kSerialWriteTimeoutMs) > 0) continue;
+        }
+        std::cerr << "[FlightConnectionService] serial write failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (log_) log_->record(core::LogRecordType::MavlinkTx, data, total);
+    return true;
+}
+
+std::optional<FlightState> FlightConnectionService::pollState() {
+    if (!linkOpen()) {
         return std::nullopt;
     }
 
-    std::uint8_t stx = buf[0];
-    if (stx != 0xFE && stx != 0xFD) {
+    if (router_ || ioRunning_.load(std::memory_order_acquire)) {
+        // I/O 线程 / 路由器负责接收；这里只报告快照是否前进过
+        const std::uint64_t version = stateSnapshot_.version();
+        if (version == polledVersion_.exchange(version, std::memory_order_acq_rel)) {
+            return std::nullopt;
+        }
+        return stateSnapshot_.load();
+    }
+
+    serviceCommandTimeouts(steadyNowNs());
+    std::lock_guard<std::mutex> lk(stateMutex_);
+    if (!drainLocked()) {
         return std::nullopt;
     }
+    polledVersion_.store(stateSnapshot_.version(), std::memory_order_relaxed);
+    return lastState_;
+}
 
-    std::uint8_t len = buf[1];
-    std::uint8_t msgid = 0;
-    const std::uint8_t* payload = nullptr;
+bool FlightConnectionService::drainLocked() {
+    FM_TRACE_SCOPE("mavlink", "mavlink.drain");
+    std::uint32_t changed = 0;
+    auto onFrame = [&](const mavlink::Frame& frame) {
+        if (messageHandler_) messageHandler_(frame);
+        if (frame.msgid == mavlink::kMsgCommandAck) {
+            handleCommandAck(frame);
+            return;
+        }
+        if (handleMissionFrame(frame)) return;
+        changed |= mavlink::applyTelemetry(frame, lastState_);
+    };
 
-    if (stx == 0xFE) {
-        // MAVLink v1: STX LEN SEQ SYSID COMPID MSGID PAYLOAD CRC
-        if (n < 6 + len + 2) return std::nullopt;
-        msgid = buf[5];
-        payload = &buf[6];
+    if (serial_) {
+        // 字节流：连续 read 直到无数据或缓冲填满，合并成一段后一次喂给解析器，减少高波特率下的小块解析
+        for (int batch = 0; batch < kMaxBatchesPerDrain; ++batch) {
+            std::size_t filled = 0;
+            while (filled < recvStorage_.size()) {
+                const ssize_t n = ::read(fd_, recvStorage_.data() + filled, recvStorage_.size() - filled);
+                if (n > 0) {
+                    filled += static_cast<std::size_t>(n);
+                    continue;
+                }
+                if (n < 0 && errno == EINTR) continue;
+                break;
+            }
+            if (filled == 0) break;
+            datagrams_.fetch_add(1, std::memory_order_relaxed);
+            if (log_) log_->record(core::LogRecordType::MavlinkRx, recvStorage_.data(), filled);
+            parser_.feed(recvStorage_.data(), filled, onFrame);
+            if (filled < recvStorage_.size()) break;
+        }
     } else {
-        // MAVLink v2: STX LEN incompatFlags compatFlags SEQ SYSID COMPID MSGID[3] PAYLOAD CRC
-        if (n < 10 + len + 2) return std::nullopt;
-        msgid = buf[7]; // 我们当前只关心低 8 位
-        payload = &buf[10];
+#ifdef __linux__
+        // 读到 EAGAIN（或不足一整批）为止：一次唤醒消费全部积压数据报，每个数据报内的多帧逐一分发
+        iovec iovs[kRecvBatch];
+        mmsghdr msgs[kRecvBatch];
+        for (std::size_t i = 0; i < kRecvBatch; ++i) {
+            iovs[i].iov_base = recvStorage_.data() + i * kDatagramBytes;
+            iovs[i].iov_len = kDatagramBytes;
+            msgs[i].msg_hdr = msghdr{};
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        for (int batch = 0; batch < kMaxBatchesPerDrain; ++batch) {
+            const int received = ::recvmmsg(fd_, msgs, static_cast<unsigned>(kRecvBatch), MSG_DONTWAIT, nullptr);
+            if (received <= 0) {
+                break;
+            }
+            datagrams_.fetch_add(static_cast<std::uint64_t>(received), std::memory_order_relaxed);
+            for (int i = 0; i < received; ++i) {
+                if (log_) log_->record(core::LogRecordType::MavlinkRx, iovs[i].iov_base, msgs[i].msg_len);
+                parser_.feed(static_cast<const std::uint8_t*>(iovs[i].iov_base), msgs[i].msg_len, onFrame);
+            }
+            if (static_cast<std::size_t>(received) < kRecvBatch) {
+                break;
+            }
+        }
+#else
+        for (std::size_t i = 0; i < kRecvBatch * kMaxBatchesPerDrain; ++i) {
+            const ssize_t n = ::recv(fd_, recvStorage_.data(), kDatagramBytes, MSG_DONTWAIT);
+            if (n <= 0) {
+                break;
+            }
+            datagrams_.fetch_add(1, std::memory_order_relaxed);
+            parser_.feed(recvStorage_.data(), static_cast<std::size_t>(n), onFrame);
+        }
+#endif
+    }
+
+    if (changed == 0) {
+        return false;
+    }
+    publishLocked(changed);
+    return true;
+}
+
+void FlightConnectionService::publishLocked(std::uint32_t changedMask) {
+    const std::uint64_t seq = stateSnapshot_.version() + 1;
+    const std::int64_t now = steadyNowNs();
+    lastState_.seq = seq;
+    lastState_.changed = changedMask;
+    for (std::size_t i = 0; i < kFlightFieldCount; ++i) {
+        if (changedMask & (1u << i)) {
+            lastState_.fieldSeq[i] = seq;
+            lastState_.fieldUpdatedNs[i] = now;
+        }
     }
+    stateSnapshot_.store(lastState_);
+    // 快照先发布再推进逐组序号：changedSince 报告变化时读者一定能读到对应快照
+    for (std::size_t i = 0; i < kFlightFieldCount; ++i) {
+        if (changedMask & (1u << i)) fieldSeq_[i].store(seq, std::memory_order_release);
+    }
+    if (estimatorsEnabled_) {
+        if ((changedMask & fieldBit(FlightField::Velocity)) && wind_.update(lastState_, now)) {
+            windSnapshot_.store(wind_.estimate());
+        }
+        if ((changedMask & fieldBit(FlightField::Battery)) && energy_.update(lastState_, now)) {
+            energySnapshot_.store(energy_.estimate());
+        }
+    }
+    if (stateListener_) stateListener_(lastState_);
+}
+
+std::uint32_t FlightConnectionService::changedSince(std::uint64_t sinceSeq) const noexcept {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kFlightFieldCount; ++i) {
+        if (fieldSeq_[i].load(std::memory_order_acquire) > sinceSeq) mask |= 1u << i;
+    }
+    return mask;
+}
 
-    // 解析 MAVLink v1 GLOBAL_POSITION_INT (msgid 33) 和 ATTITUDE (msgid 30)
+bool FlightConnectionService::startIoThread() {
+#ifdef __linux__
+    if (ioRunning_.load(std::memory_order_acquire)) {
+        return true;
+    }
+    if (!linkOpen()) {
+        std::cerr << "[FlightConnectionService] startIoThread: not connected" << std::endl;
+        return false;
+    }
+    if (router_) {
+        return true;  // 路由模式下接收由路由器线程负责
+    }
+    epollFd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epollFd_ < 0 || wakeFd_ < 0) {
+        std::cerr << "[FlightConnectionService] epoll/eventfd failed: " << errno << std::endl;
+        stopIoThread();
+        return false;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = wakeFd_;
+    bool ok = ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &ev) == 0;
+    ev.data.fd = fd_;
+    ok = ok && ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd_, &ev) == 0;
+    if (!ok) {
+        std::cerr << "[FlightConnectionService] epoll_ctl failed: " << errno << std::endl;
+        stopIoThread();
+        return false;
+    }
+    polledVersion_.store(stateSnapshot_.version(), std::memory_order_relaxed);
+    ioRunning_.store(true, std::memory_order_release);
+    ioThread_ = std::thread([this] { ioLoop(); });
+    return true;
+#else
+    std::cerr << "[FlightConnectionService] startIoThread: not supported on this platform" << std::endl;
+    return false;
+#endif
+}
+
+void FlightConnectionService::stopIoThread() {
+#ifdef __linux__
+    ioRunning_.store(false, std::memory_order_release);
+    if (ioThread_.joinable()) {
+        std::uint64_t one = 1;
+        (void)!::write(wakeFd_, &one, sizeof(one));
+        ioThread_.join();
+    }
+    if (epollFd_ >= 0) ::close(epollFd_);
+    if (wakeFd_ >= 0) ::close(wakeFd_);
+    epollFd_ = -1;
+    wakeFd_ = -1;
+#endif
+}
+
+void FlightConnectionService::ioLoop() {
+#ifdef __linux__
+    FM_TRACE_THREAD_NAME("mavlink-io");
+    epoll_event events[2];
+    while (ioRunning_.load(std::memory_order_acquire)) {
+        // 有待确认命令时按最近的重发 / 超时截止时间醒来
+        const std::int64_t now = steadyNowNs();
+        const std::int64_t next = serviceCommandTimeouts(now);
+        int timeoutMs = next > 0 ? static_cast<int>(std::max<std::int64_t>(0, (next - now + 999'999) / 1'000'000)) : -1;
+        if (timeoutMs > 0 && core::PipelineClock::isVirtual()) {
+            // 虚拟时钟下截止时间由驱动方推进，按墙钟切片复查
+            timeoutMs = static_cast<int>(core::PipelineClock::kVirtualWaitSlice.count());
+        }
+        const int n = ::epoll_wait(epollFd_, events, 2, timeoutMs);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[FlightConnectionService] epoll_wait failed: " << errno << std::endl;
+            break;
+        }
+        bool readable = false;
+        for (int i = 0; i < n; ++i) {
+            if (events[i].data.fd == fd_) {
+                readable = true;
+            } else if (events[i].data.fd == wakeFd_) {
+                std::uint64_t value = 0;
+                (void)!::read(wakeFd_, &value, sizeof(value));
+            }
+        }
+        if (!readable) continue;  // 唤醒 / 超时：重新检查 running 与命令截止时间
+        std::lock_guard<std::mutex> lk(stateMutex_);
+        drainLocked();
+    }
+#endif
+}
+
+void FlightConnectionService::setMessageHandler(MessageHandler handler) {
     std::lock_guard<std::mutex> lk(stateMutex_);
+    messageHandler_ = std::move(handler);
+}
 
-    if (msgid == 33 && len >= 28) { // GLOBAL_POSITION_INT
-        // payload 布局（小端）：
-        // uint32 time_boot_ms
-        // int32  lat
-        // int32  lon
-        // int32  alt
-        // int32  relative_alt
-        // int16  vx
-        // int16  vy
-        // int16  vz
-        // uint16 hdg
-        std::int32_t lat_i = 0, lon_i = 0, alt_i = 0;
-        std::int16_t vx_i = 0, vy_i = 0, vz_i = 0;
-
-        std::size_t off = 4; // 跳过 time_boot_ms
-        std::memcpy(&lat_i, payload + off, 4); off += 4;
-        std::memcpy(&lon_i, payload + off, 4); off += 4;
-        std::memcpy(&alt_i, payload + off, 4); off += 4;
-        off += 4; // relative_alt
-        std::memcpy(&vx_i, payload + off, 2); off += 2;
-        std::memcpy(&vy_i, payload + off, 2); off += 2;
-        std::memcpy(&vz_i, payload + off, 2); off += 2;
-
-        lastState_.lat = static_cast<double>(lat_i) / 1e7;
-        lastState_.lon = static_cast<double>(lon_i) / 1e7;
-        lastState_.alt = static_cast<double>(alt_i) / 1000.0; // mm → m
-        lastState_.vx  = static_cast<double>(vx_i) / 100.0;   // cm/s → m/s
-        lastState_.vy  = static_cast<double>(vy_i) / 100.0;
-        lastState_.vz  = static_cast<double>(vz_i) / 100.0;
-
-        return lastState_;
-    } else if (msgid == 30 && len >= 28) { // ATTITUDE
-        // payload 布局（小端）：
-        // uint32 time_boot_ms
-        // float roll, pitch, yaw, rollspeed, pitchspeed, yawspeed
-        float roll = 0.f, pitch = 0.f, yaw = 0.f;
-        std::size_t off = 4;
-        std::memcpy(&roll,  payload + off, 4); off += 4;
-        std::memcpy(&pitch, payload + off, 4); off += 4;
-        std::memcpy(&yaw,   payload + off, 4); off += 4;
-
-        lastState_.roll  = static_cast<double>(roll);
-        lastState_.pitch = static_cast<double>(pitch);
-        lastState_.yaw   = static_cast<double>(yaw);
-
-        return lastState_;
-    }
-
-    return std::nullopt;
+void FlightConnectionService::enableEstimators(const WindEstimatorConfig& wind, const EnergyEstimatorConfig& energy) {
+    std::lock_guard<std::mutex> lk(stateMutex_);
+    wind_ = WindEstimator(wind);
+    energy_ = EnergyEstimator(energy);
+    windSnapshot_.store(WindEstimate{});
+    energySnapshot_.store(EnergyEstimate{});
+    estimatorsEnabled_ = true;
 }
 
-FlightState FlightConnectionService::getLastState() const {
+void FlightConnectionService::setStateListener(StateListener listener) {
     std::lock_guard<std::mutex> lk(stateMutex_);
-    return lastState_;
+    stateListener_ = std::move(listener);
+}
+
+void FlightConnectionService::deliverRouted(const mavlink::Frame& frame) {
+    std::lock_guard<std::mutex> lk(stateMutex_);
+    if (messageHandler_) messageHandler_(frame);
+    if (frame.msgid == mavlink::kMsgCommandAck) {
+        handleCommandAck(frame);
+        return;
+    }
+    if (handleMissionFrame(frame)) return;
+    if (const std::uint32_t changed = mavlink::applyTelemetry(frame, lastState_)) {
+        publishLocked(changed);
+    }
+}
+
+mavlink::ParserStats FlightConnectionService::parserStats() const {
+    return parser_.stats();
+}
+
+FlightState FlightConnectionService::getLastState() const {
+    return stateSnapshot_.load();
 }
 
 // MAVLink v1/v2 COMMAND_LONG 编码（不依赖外部库的精简实现）
-bool FlightConnectionService::encodeMavlinkCommand(const FlightCommand& cmd, std::string& out) {
+std::uint16_t FlightConnectionService::mavCommandId(FlightCommandType type) noexcept {
+    switch (type) {
+        case FlightCommandType::Arm:
+        case FlightCommandType::Disarm:
+            return 400;  // MAV_CMD_COMPONENT_ARM_DISARM
+        case FlightCommandType::Takeoff:
+            return 22;   // MAV_CMD_NAV_TAKEOFF
+        case FlightCommandType::Land:
+            return 21;   // MAV_CMD_NAV_LAND
+        case FlightCommandType::ReturnToLaunch:
+            return 20;   // MAV_CMD_NAV_RETURN_TO_LAUNCH
+        case FlightCommandType::Offboard:
+            return 176;  // MAV_CMD_DO_SET_MODE
+        case FlightCommandType::MissionStart:
+            return 300;  // MAV_CMD_MISSION_START
+    }
+    return 0;
+}
+
+bool FlightConnectionService::encodeMavlinkCommand(const FlightCommand& cmd, std::string& out,
+                                                   std::uint8_t confirmation) {
     // 参考 MAVLink v1 帧格式：STX(0xFE) LEN SEQ SYSID COMPID MSGID PAYLOAD CRC
     // 以及 MAVLink v2 帧格式：STX(0xFD) LEN incompatFlags compatFlags SEQ SYSID COMPID MSGID[3] PAYLOAD CRC
+    // CRC 覆盖 STX 之后的帧头与载荷并累加 CRC_EXTRA，由 mavlink::encodeFrame 完成
     constexpr std::uint8_t LEN    = 33;   // COMMAND_LONG payload 长度
-    constexpr std::uint8_t MSG_ID = 76;   // COMMAND_LONG
-    constexpr std::uint8_t CRC_EXTRA = 152; // COMMAND_LONG 对应 extra CRC（来自 MAVLink 规范）
+    constexpr std::uint32_t MSG_ID = mavlink::kMsgCommandLong;
 
     // 默认将 SDK 视作地面站：SYSID=255, COMPID=190
-    const std::uint8_t sysid  = 255;
-    const std::uint8_t compid = 190;
+    const std::uint8_t sysid  = kSysId;
+    const std::uint8_t compid = kCompId;
 
     // COMMAND_LONG payload 布局（小端）：
     // float param1..7 (7 * 4) + uint16_t command + uint8_t target_system
@@ -189,26 +893,25 @@ bool FlightConnectionService::encodeMavlinkCommand(const FlightCommand& cmd, std
     std::uint8_t payload[LEN]{};
 
     float p1 = 0.f, p2 = 0.f, p3 = 0.f, p4 = 0.f, p5 = 0.f, p6 = 0.f, p7 = 0.f;
-    std::uint16_t command = 0;
+    const std::uint16_t command = mavCommandId(cmd.type);
 
     switch (cmd.type) {
         case FlightCommandType::Arm:
-            command = 400; // MAV_CMD_COMPONENT_ARM_DISARM
             p1 = 1.f;
             break;
         case FlightCommandType::Disarm:
-            command = 400;
             p1 = 0.f;
             break;
         case FlightCommandType::Takeoff:
-            command = 22;  // MAV_CMD_NAV_TAKEOFF
             p7 = static_cast<float>(cmd.targetAlt);
             break;
         case FlightCommandType::Land:
-            command = 21;  // MAV_CMD_NAV_LAND
-            break;
         case FlightCommandType::ReturnToLaunch:
-            command = 20;  // MAV_CMD_NAV_RETURN_TO_LAUNCH
+        case FlightCommandType::MissionStart:  // first_item = last_item = 0：从头执行整个任务
+            break;
+        case FlightCommandType::Offboard:
+            p1 = 1.f;      // MAV_MODE_FLAG_CUSTOM_MODE_ENABLED
+            p2 = 6.f;      // PX4_CUSTOM_MAIN_MODE_OFFBOARD
             break;
     }
 
@@ -229,75 +932,21 @@ bool FlightConnectionService::encodeMavlinkCommand(const FlightCommand& cmd, std
     payload[offset++] = static_cast<std::uint8_t>((command >> 8) & 0xFF);
 
     // target_system & target_component & confirmation
-    std::uint8_t target_system    = 1; // 通常为 PX4 的 SYSID
+    std::uint8_t target_system    = targetSystem_; // 通常为 PX4 的 SYSID
     std::uint8_t target_component = 1; // Autopilot
-    std::uint8_t confirmation     = 0;
     payload[offset++] = target_system;
     payload[offset++] = target_component;
     payload[offset++] = confirmation;
 
-    // 计算 CRC：payload + msgId + CRC_EXTRA
-    std::uint16_t crc = mavlinkCrcCalculate(payload, LEN, CRC_EXTRA);
-
-    if (cfg_.mavlinkVersion == MavlinkVersion::V1) {
-        constexpr std::uint8_t STX_V1 = 0xFE;
-        std::uint8_t frame[6 + LEN + 2];
-        frame[0] = STX_V1;
-        frame[1] = LEN;
-        frame[2] = seq_++;
-        frame[3] = sysid;
-        frame[4] = compid;
-        frame[5] = MSG_ID;
-        std::memcpy(&frame[6], payload, LEN);
-        frame[6 + LEN]     = static_cast<std::uint8_t>(crc & 0xFF);
-        frame[6 + LEN + 1] = static_cast<std::uint8_t>((crc >> 8) & 0xFF);
-        out.assign(reinterpret_cast<char*>(frame), sizeof(frame));
-    } else {
-        // MAVLink v2 帧
-        constexpr std::uint8_t STX_V2        = 0xFD;
-        constexpr std::uint8_t incompatFlags = 0x00;
-        constexpr std::uint8_t compatFlags   = 0x00;
-
-        std::uint8_t frame[10 + LEN + 2];
-        frame[0] = STX_V2;
-        frame[1] = LEN;
-        frame[2] = incompatFlags;
-        frame[3] = compatFlags;
-        frame[4] = seq_++;
-        frame[5] = sysid;
-        frame[6] = compid;
-        // msgid 3 字节小端
-        frame[7] = MSG_ID & 0xFF;
-        frame[8] = 0;
-        frame[9] = 0;
-        std::memcpy(&frame[10], payload, LEN);
-        frame[10 + LEN]     = static_cast<std::uint8_t>(crc & 0xFF);
-        frame[10 + LEN + 1] = static_cast<std::uint8_t>((crc >> 8) & 0xFF);
-        out.assign(reinterpret_cast<char*>(frame), sizeof(frame));
+    std::uint8_t frame[mavlink::kMaxFrame];
+    const std::size_t size = mavlink::encodeFrame(cfg_.mavlinkVersion, nextSequence(), sysid, compid, MSG_ID, payload, LEN, frame);
+    if (size == 0) {
+        std::cerr << "[FlightConnectionService] encodeMavlinkCommand: encode failed" << std::endl;
+        return false;
     }
-
+    out.assign(reinterpret_cast<char*>(frame), size);
     return true;
 }
 
-std::uint16_t FlightConnectionService::mavlinkCrcAccumulate(std::uint8_t data, std::uint16_t crc) const {
-    // 标准 MAVLink CRC-16/MCRF4XX 累加实现
-    data ^= static_cast<std::uint8_t>(crc & 0xFFu);
-    data ^= static_cast<std::uint8_t>(data << 4);
-
-    return static_cast<std::uint16_t>(
-        (crc >> 8) ^ (static_cast<std::uint16_t>(data) << 8)
-        ^ (static_cast<std::uint16_t>(data) << 3)
-        ^ (static_cast<std::uint16_t>(data) >> 4));
-}
-
-std::uint16_t FlightConnectionService::mavlinkCrcCalculate(const std::uint8_t* buf, std::size_t len, std::uint8_t crcExtra) const {
-    std::uint16_t crc = 0xFFFF;
-    for (std::size_t i = 0; i < len; ++i) {
-        crc = mavlinkCrcAccumulate(buf[i], crc);
-    }
-    crc = mavlinkCrcAccumulate(crcExtra, crc);
-    return crc;
-}
-
 } // namespace falconmind::sdk::flight
 
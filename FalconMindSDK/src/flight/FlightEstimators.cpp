@@ -0,0 +1,177 @@
+// FalconMindSDK - Wind / energy estimators implementation
+#include "falconmind/sdk/flight/FlightEstimators.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace falconmind::sdk::flight {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kGravity = 9.80665;
+constexpr double kMaxSampleGapSec = 2.0;  // 样本间隔超过该值视为链路中断，重新起算
+
+// 按样本间隔换算的一阶低通系数（间隔不固定时保持同一时间常数）
+double lowPassAlpha(double dtSec, double tauSec) noexcept {
+    if (tauSec <= 0.0) return 1.0;
+    return 1.0 - std::exp(-dtSec / tauSec);
+}
+
+} // namespace
+
+double WindEstimate::sweepAngleRad() const noexcept {
+    double angle = std::atan2(north, east);  // ENU：x 东、y 北
+    if (angle < 0.0) angle += kPi;
+    if (angle >= kPi) angle -= kPi;
+    return angle;
+}
+
+void WindEstimator::reset() noexcept {
+    estimate_ = WindEstimate{};
+    meanSq_ = 0.0;
+    lastVn_ = lastVe_ = 0.0;
+    lastNs_ = 0;
+}
+
+bool WindEstimator::update(const FlightState& state, std::int64_t timestampNs, double airspeedMps) noexcept {
+    const double vn = state.vx;
+    const double ve = state.vy;
+    if (lastNs_ != 0 && timestampNs <= lastNs_) return false;  // 重复或乱序样本
+    const double dt = lastNs_ != 0 ? (timestampNs - lastNs_) * 1e-9 : 0.0;
+    const double accel = dt > 0.0 ? std::hypot(vn - lastVn_, ve - lastVe_) / dt : 0.0;
+    lastVn_ = vn;
+    lastVe_ = ve;
+    lastNs_ = timestampNs;
+    // 首个样本（或中断后）只用作加速度判定的基准
+    if (dt <= 0.0 || dt > kMaxSampleGapSec) return false;
+    if (state.relativeAlt < config_.minRelativeAltM || accel > config_.maxAccelMps2) return false;
+
+    double airN = 0.0;
+    double airE = 0.0;
+    if (airspeedMps >= 0.0) {
+        airN = airspeedMps * std::cos(state.yaw);
+        airE = airspeedMps * std::sin(state.yaw);
+    } else {
+        // 机体 z 轴（推力反方向）在 NED 中的水平分量；垂直方向按悬停平衡 T·cosφ·cosθ = g 归一化
+        const double cr = std::cos(state.roll), sr = std::sin(state.roll);
+        const double cp = std::cos(state.pitch), sp = std::sin(state.pitch);
+        const double cy = std::cos(state.yaw), sy = std::sin(state.yaw);
+        const double cosTilt = cr * cp;
+        if (cosTilt < 0.5 || config_.dragCoefficient <= 0.0) return false;  // 倾斜超过 60° 不再是稳态平飞
+        const double thrust = kGravity / cosTilt;
+        const double fn = -thrust * (cy * sp * cr + sy * sr);
+        const double fe = -thrust * (sy * sp * cr - cy * sr);
+        airN = fn / config_.dragCoefficient;
+        airE = fe / config_.dragCoefficient;
+    }
+    const double wn = vn - airN;
+    const double we = ve - airE;
+
+    WindEstimate& w = estimate_;
+    if (w.samples == 0) {
+        w.north = wn;
+        w.east = we;
+    } else {
+        const double alpha = lowPassAlpha(dt, config_.timeConstantSec);
+        const double dn = wn - w.north;
+        const double de = we - w.east;
+        w.north += alpha * dn;
+        w.east += alpha * de;
+        meanSq_ += alpha * (dn * dn + de * de - meanSq_);
+    }
+    ++w.samples;
+    w.observedSec += dt;
+    w.speed = std::hypot(w.north, w.east);
+    double from = std::atan2(-w.east, -w.north) * 180.0 / kPi;
+    if (from < 0.0) from += 360.0;
+    w.fromDeg = from;
+    w.sigma = std::sqrt(meanSq_);
+    w.valid = w.observedSec >= 0.5 * config_.timeConstantSec;
+    return true;
+}
+
+void EnergyEstimator::reset() noexcept {
+    estimate_ = EnergyEstimate{};
+    lastPowerW_ = -1.0;
+    lastPercent_ = -1.0;
+    lastNs_ = 0;
+    lastPercentNs_ = 0;
+}
+
+bool EnergyEstimator::update(const FlightState& state, std::int64_t timestampNs) noexcept {
+    if (state.batteryVoltageMv <= 0) return false;
+    if (lastNs_ != 0 && timestampNs <= lastNs_) return false;
+    const double dt = lastNs_ != 0 ? (timestampNs - lastNs_) * 1e-9 : 0.0;
+    lastNs_ = timestampNs;
+    EnergyEstimate& e = estimate_;
+
+    if (state.batteryCurrentA >= 0.0) {
+        const double power = state.batteryVoltageMv / 1000.0 * state.batteryCurrentA;
+        if (lastPowerW_ < 0.0) {
+            e.avgPowerW = power;
+        } else if (dt > 0.0 && dt <= kMaxSampleGapSec) {
+            e.usedWh += 0.5 * (power + lastPowerW_) * dt / 3600.0;
+            e.avgPowerW += lowPassAlpha(dt, config_.powerTimeConstantSec) * (power - e.avgPowerW);
+        }
+        e.powerW = power;
+        lastPowerW_ = power;
+    }
+
+    // 百分比按整数跳变：在两次跳变之间计算下降速率（首次跳变前的区间不完整，只用作起点）
+    const double percent = state.batteryPercent;
+    if (percent > 0.0) {
+        if (lastPercent_ < 0.0) {
+            lastPercent_ = percent;
+        } else if (percent != lastPercent_) {
+            if (lastPercentNs_ != 0 && percent < lastPercent_) {
+                const double interval = (timestampNs - lastPercentNs_) * 1e-9;
+                if (interval > 0.0) {
+                    const double rate = (lastPercent_ - percent) / interval;
+                    e.drainPctPerSec = e.drainPctPerSec <= 0.0
+                                           ? rate
+                                           : e.drainPctPerSec +
+                                                 lowPassAlpha(interval, config_.powerTimeConstantSec * 6.0) *
+                                                     (rate - e.drainPctPerSec);
+                }
+            }
+            lastPercent_ = percent;
+            lastPercentNs_ = timestampNs;
+        }
+    }
+
+    const double reservePct = 100.0 * config_.reserveFraction;
+    if (config_.capacityWh > 0.0) {
+        e.remainingWh = percent > 0.0 ? config_.capacityWh * (percent - reservePct) / 100.0
+                                      : config_.capacityWh * (1.0 - config_.reserveFraction) - e.usedWh;
+        e.remainingWh = std::max(0.0, e.remainingWh);
+    }
+    if (e.remainingWh >= 0.0 && e.avgPowerW > 1.0) {
+        e.enduranceSec = e.remainingWh * 3600.0 / e.avgPowerW;
+    } else if (percent > 0.0 && e.drainPctPerSec > 0.0) {
+        e.enduranceSec = std::max(0.0, percent - reservePct) / e.drainPctPerSec;
+    }
+    ++e.samples;
+    e.valid = e.enduranceSec >= 0.0;
+    return true;
+}
+
+double groundSpeedAlong(double courseRad, double airspeedMps, const WindEstimate& wind) noexcept {
+    const double c = std::cos(courseRad);
+    const double s = std::sin(courseRad);
+    const double tail = wind.north * c + wind.east * s;
+    const double cross = -wind.north * s + wind.east * c;
+    if (std::fabs(cross) >= airspeedMps) return 0.0;
+    return std::max(0.0, std::sqrt(airspeedMps * airspeedMps - cross * cross) + tail);
+}
+
+double returnMarginSec(const EnergyEstimate& energy, const WindEstimate& wind, double distanceM, double courseRad,
+                       double airspeedMps, double landingSec) noexcept {
+    constexpr double kUnreachable = -1e9;
+    if (!energy.valid || energy.enduranceSec < 0.0) return kUnreachable;
+    const double gs = groundSpeedAlong(courseRad, airspeedMps, wind.valid ? wind : WindEstimate{});
+    if (gs < 0.1) return kUnreachable;
+    return energy.enduranceSec - (distanceM / gs + landingSec);
+}
+
+} // namespace falconmind::sdk::flight
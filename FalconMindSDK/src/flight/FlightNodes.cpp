@@ -1,4 +1,5 @@
 #include "falconmind/sdk/flight/FlightNodes.h"
+#include "falconmind/sdk/core/Log.h"
 #include "falconmind/sdk/core/Pad.h"
 #include "falconmind/sdk/telemetry/TelemetryPublisher.h"
 
@@ -10,9 +11,28 @@ namespace falconmind::sdk::flight {
 using namespace falconmind::sdk::core;
 using namespace falconmind::sdk::telemetry;
 
+namespace {
+
+// PX4 custom_mode：main_mode 位于 bits 16–23
+const char* px4ModeName(std::uint32_t customMode) {
+    switch ((customMode >> 16) & 0xFF) {
+        case 1: return "MANUAL";
+        case 2: return "ALTCTL";
+        case 3: return "POSCTL";
+        case 4: return "AUTO";
+        case 5: return "ACRO";
+        case 6: return "OFFBOARD";
+        case 7: return "STABILIZED";
+        case 8: return "RATTITUDE";
+        default: return "UNKNOWN";
+    }
+}
+
+} // namespace
+
 FlightStateSourceNode::FlightStateSourceNode(FlightConnectionService& svc)
     : Node("flight_state_source"), svc_(svc) {
-    addPad(std::make_shared<Pad>("out", PadType::Source));
+    outPad_ = addPad(std::make_shared<Pad>("out", PadType::Source));
 }
 
 bool FlightStateSourceNode::start() {
@@ -24,8 +44,10 @@ void FlightStateSourceNode::process() {
     auto stateOpt = svc_.pollState();
     if (stateOpt) {
         const auto& s = *stateOpt;
-        std::cout << "[FlightStateSourceNode] lat=" << s.lat
-                  << " lon=" << s.lon << " alt=" << s.alt << std::endl;
+        FM_LOG_DEBUG("FlightStateSourceNode", "lat=", s.lat, " lon=", s.lon, " alt=", s.alt);
+
+        // 下游（如 BlackboardSinkNode）直接按 FlightState 布局读取
+        outPad_->pushToConnections(&s, sizeof(s));
 
         // 发布 Telemetry 消息（供 NodeAgent 订阅）
         TelemetryMessage msg;
@@ -48,8 +70,9 @@ void FlightStateSourceNode::process() {
         msg.batteryVoltageMv = s.batteryVoltageMv;
         msg.gpsFixType = s.gpsFixType;
         msg.numSat = s.numSat;
-        msg.linkQuality = 100.0;  // 占位，后续从 MAVLink 读取
-        msg.flightMode = "OFFBOARD";  // 占位，后续从 MAVLink 读取
+        // SYS_STATUS.drop_rate_comm 为 0.01% 单位；未收到时按满值
+        msg.linkQuality = s.has(FlightField::SysStatus) ? 100.0 - s.dropRateComm / 100.0 : 100.0;
+        msg.flightMode = s.has(FlightField::Heartbeat) ? px4ModeName(s.customMode) : "UNKNOWN";
 
         TelemetryPublisher::instance().publish(msg);
     } else {
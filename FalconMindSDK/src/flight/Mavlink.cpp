@@ -0,0 +1,336 @@
+// FalconMindSDK - MAVLink Stream Parser Implementation
+#include "falconmind/sdk/flight/Mavlink.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace falconmind::sdk::flight::mavlink {
+
+namespace {
+
+// common.xml 中的常用消息：{msgid, CRC_EXTRA}，按 msgid 升序
+constexpr MessageInfo kMessages[] = {
+    {0, 50},     // HEARTBEAT
+    {1, 124},    // SYS_STATUS
+    {2, 137},    // SYSTEM_TIME
+    {4, 237},    // PING
+    {22, 220},   // PARAM_VALUE
+    {24, 24},    // GPS_RAW_INT
+    {27, 144},   // RAW_IMU
+    {29, 115},   // SCALED_PRESSURE
+    {30, 39},    // ATTITUDE
+    {31, 246},   // ATTITUDE_QUATERNION
+    {32, 185},   // LOCAL_POSITION_NED
+    {33, 104},   // GLOBAL_POSITION_INT
+    {36, 222},   // SERVO_OUTPUT_RAW
+    {40, 230},   // MISSION_REQUEST
+    {42, 28},    // MISSION_CURRENT
+    {44, 221},   // MISSION_COUNT
+    {46, 11},    // MISSION_ITEM_REACHED
+    {47, 153},   // MISSION_ACK
+    {51, 196},   // MISSION_REQUEST_INT
+    {65, 118},   // RC_CHANNELS
+    {73, 38},    // MISSION_ITEM_INT
+    {74, 20},    // VFR_HUD
+    {76, 152},   // COMMAND_LONG
+    {77, 143},   // COMMAND_ACK
+    {83, 22},    // ATTITUDE_TARGET
+    {84, 143},   // SET_POSITION_TARGET_LOCAL_NED
+    {85, 140},   // POSITION_TARGET_LOCAL_NED
+    {87, 150},   // POSITION_TARGET_GLOBAL_INT
+    {105, 93},   // HIGHRES_IMU
+    {111, 34},   // TIMESYNC
+    {141, 47},   // ALTITUDE
+    {147, 154},  // BATTERY_STATUS
+    {148, 178},  // AUTOPILOT_VERSION
+    {230, 163},  // ESTIMATOR_STATUS
+    {241, 90},   // VIBRATION
+    {242, 104},  // HOME_POSITION
+    {245, 130},  // EXTENDED_SYS_STATE
+    {253, 83},   // STATUSTEXT
+    {331, 91},   // ODOMETRY
+};
+
+constexpr bool sortedById() {
+    for (std::size_t i = 1; i < sizeof(kMessages) / sizeof(kMessages[0]); ++i) {
+        if (kMessages[i - 1].msgid >= kMessages[i].msgid) return false;
+    }
+    return true;
+}
+static_assert(sortedById(), "MAVLink message table must be sorted by msgid");
+
+// msgid < 256 的消息直接按下标查表（编译期构造，0xFF 为未知）
+constexpr std::array<std::uint8_t, 256> makeDenseIndex() {
+    std::array<std::uint8_t, 256> idx{};
+    for (auto& v : idx) v = 0xFF;
+    for (std::size_t i = 0; i < sizeof(kMessages) / sizeof(kMessages[0]); ++i) {
+        if (kMessages[i].msgid < 256) idx[kMessages[i].msgid] = static_cast<std::uint8_t>(i);
+    }
+    return idx;
+}
+constexpr std::array<std::uint8_t, 256> kDenseIndex = makeDenseIndex();
+
+template <typename T>
+T readLe(const std::uint8_t* p) noexcept {
+    T v;
+    std::memcpy(&v, p, sizeof(T));  // MAVLink 为小端，目标平台（x86 / arm64）同为小端
+    return v;
+}
+
+} // namespace
+
+const MessageInfo* findMessage(std::uint32_t msgid) noexcept {
+    if (msgid < 256) {
+        const std::uint8_t i = kDenseIndex[msgid];
+        return i == 0xFF ? nullptr : &kMessages[i];
+    }
+    const auto* end = kMessages + sizeof(kMessages) / sizeof(kMessages[0]);
+    const auto* it = std::lower_bound(kMessages, end, msgid,
+                                      [](const MessageInfo& m, std::uint32_t id) { return m.msgid < id; });
+    return (it != end && it->msgid == msgid) ? it : nullptr;
+}
+
+void StreamParser::reset() noexcept {
+    r_ = w_ = 0;
+    frameTotal_ = 0;
+    senderCount_ = 0;
+    stats_ = ParserStats{};
+}
+
+std::size_t StreamParser::write(const std::uint8_t* data, std::size_t size) noexcept {
+    const std::size_t n = std::min(size, kCapacity - buffered());
+    const std::size_t pos = static_cast<std::size_t>(w_ & (kCapacity - 1));
+    const std::size_t first = std::min(n, kCapacity - pos);
+    std::memcpy(ring_.data() + pos, data, first);
+    std::memcpy(ring_.data(), data + first, n - first);
+    w_ += n;
+    return n;
+}
+
+int StreamParser::next() noexcept {
+    const std::size_t avail = buffered();
+    if (avail == 0) return 0;
+
+    const std::uint8_t stx = at(0);
+    if (stx != kStxV1 && stx != kStxV2) {
+        ++r_;
+        ++stats_.skippedBytes;
+        return -1;
+    }
+    const bool v2 = stx == kStxV2;
+    const std::size_t header = v2 ? kHeaderV2 : kHeaderV1;
+    if (avail < header) return 0;
+
+    const std::uint8_t len = at(1);
+    bool signedFrame = false;
+    if (v2) {
+        const std::uint8_t incompat = at(2);
+        if (incompat & ~kIncompatSigned) {  // 不认识的不兼容标志：按规范丢弃
+            ++r_;
+            ++stats_.skippedBytes;
+            return -1;
+        }
+        signedFrame = (incompat & kIncompatSigned) != 0;
+    }
+    const std::size_t total = header + len + 2 + (signedFrame ? kSignatureLen : 0);
+    if (avail < total) return 0;
+
+    const std::uint32_t msgid = v2 ? (static_cast<std::uint32_t>(at(7)) | (static_cast<std::uint32_t>(at(8)) << 8) |
+                                      (static_cast<std::uint32_t>(at(9)) << 16))
+                                   : at(5);
+    const MessageInfo* info = findMessage(msgid);
+    if (!info) {
+        ++r_;
+        ++stats_.unknownMessages;
+        ++stats_.skippedBytes;
+        return -1;
+    }
+
+    // CRC 覆盖 STX 之后的帧头与载荷，再累加 CRC_EXTRA
+    std::uint16_t crc = 0xFFFF;
+    for (std::size_t i = 1; i < header; ++i) crc = crcAccumulate(at(i), crc);
+    for (std::size_t i = 0; i < len; ++i) {
+        const std::uint8_t b = at(header + i);
+        payload_[i] = b;
+        crc = crcAccumulate(b, crc);
+    }
+    crc = crcAccumulate(info->crcExtra, crc);
+    const std::uint16_t wire = static_cast<std::uint16_t>(at(header + len) | (at(header + len + 1) << 8));
+    if (crc != wire) {
+        ++r_;
+        ++stats_.crcErrors;
+        ++stats_.skippedBytes;
+        return -1;
+    }
+    std::memset(payload_.data() + len, 0, kMaxPayload - len);
+
+    frame_.version = v2 ? 2 : 1;
+    frame_.seq = at(v2 ? 4 : 2);
+    frame_.sysid = at(v2 ? 5 : 3);
+    frame_.compid = at(v2 ? 6 : 4);
+    frame_.msgid = msgid;
+    frame_.length = len;
+    frame_.signedFrame = signedFrame;
+    frame_.payload = payload_.data();
+    frameTotal_ = total;
+
+    std::size_t s = 0;
+    while (s < senderCount_ && (senders_[s].sysid != frame_.sysid || senders_[s].compid != frame_.compid)) ++s;
+    if (s < senderCount_) {
+        stats_.seqGaps += static_cast<std::uint8_t>(frame_.seq - senders_[s].seq - 1);
+        senders_[s].seq = frame_.seq;
+    } else if (senderCount_ < kMaxSenders) {
+        senders_[senderCount_++] = {frame_.sysid, frame_.compid, frame_.seq};
+    }
+    ++stats_.frames;
+    return 1;
+}
+
+void StreamParser::consumeFrame() noexcept {
+    r_ += frameTotal_;
+    frameTotal_ = 0;
+}
+
+std::size_t encodeFrame(MavlinkVersion version, std::uint8_t seq, std::uint8_t sysid, std::uint8_t compid,
+                        std::uint32_t msgid, const std::uint8_t* payload, std::size_t length, std::uint8_t* out) noexcept {
+    const MessageInfo* info = findMessage(msgid);
+    if (!info || length > kMaxPayload) return 0;
+
+    std::size_t header;
+    if (version == MavlinkVersion::V1) {
+        if (msgid > 0xFF) return 0;
+        header = kHeaderV1;
+        out[0] = kStxV1;
+        out[2] = seq;
+        out[3] = sysid;
+        out[4] = compid;
+        out[5] = static_cast<std::uint8_t>(msgid);
+    } else {
+        while (length > 1 && payload[length - 1] == 0) --length;  // 截去末尾零字节（至少保留 1 字节）
+        header = kHeaderV2;
+        out[0] = kStxV2;
+        out[2] = 0;  // incompat flags
+        out[3] = 0;  // compat flags
+        out[4] = seq;
+        out[5] = sysid;
+        out[6] = compid;
+        out[7] = static_cast<std::uint8_t>(msgid & 0xFF);
+        out[8] = static_cast<std::uint8_t>((msgid >> 8) & 0xFF);
+        out[9] = static_cast<std::uint8_t>((msgid >> 16) & 0xFF);
+    }
+    out[1] = static_cast<std::uint8_t>(length);
+    std::memcpy(out + header, payload, length);
+    std::uint16_t crc = crcCalculate(out + 1, header - 1 + length);
+    crc = crcAccumulate(info->crcExtra, crc);
+    out[header + length] = static_cast<std::uint8_t>(crc & 0xFF);
+    out[header + length + 1] = static_cast<std::uint8_t>(crc >> 8);
+    return header + length + 2;
+}
+
+std::uint32_t applyTelemetry(const Frame& frame, FlightState& state) noexcept {
+    const std::uint8_t* p = frame.payload;
+    switch (frame.msgid) {
+        case kMsgGlobalPositionInt: {
+            // time_boot_ms, lat, lon, alt(mm), relative_alt(mm), vx, vy, vz(cm/s), hdg(cdeg)
+            state.lat = readLe<std::int32_t>(p + 4) / 1e7;
+            state.lon = readLe<std::int32_t>(p + 8) / 1e7;
+            state.alt = readLe<std::int32_t>(p + 12) / 1000.0;
+            state.relativeAlt = readLe<std::int32_t>(p + 16) / 1000.0;
+            state.vx = readLe<std::int16_t>(p + 20) / 100.0;
+            state.vy = readLe<std::int16_t>(p + 22) / 100.0;
+            state.vz = readLe<std::int16_t>(p + 24) / 100.0;
+            const auto hdg = readLe<std::uint16_t>(p + 26);
+            if (hdg != 0xFFFF) state.heading = hdg / 100.0;
+            return fieldBit(FlightField::Position) | fieldBit(FlightField::Velocity);
+        }
+        case kMsgAttitude:
+            // time_boot_ms, roll, pitch, yaw, rollspeed, pitchspeed, yawspeed
+            state.roll = readLe<float>(p + 4);
+            state.pitch = readLe<float>(p + 8);
+            state.yaw = readLe<float>(p + 12);
+            state.rollRate = readLe<float>(p + 16);
+            state.pitchRate = readLe<float>(p + 20);
+            state.yawRate = readLe<float>(p + 24);
+            return fieldBit(FlightField::Attitude);
+        case kMsgHeartbeat: {
+            // custom_mode(u32), type, autopilot, base_mode, system_status, mavlink_version
+            const std::uint8_t type = p[4];
+            const std::uint8_t autopilot = p[5];
+            if (type == 6 || autopilot == 8) {  // MAV_TYPE_GCS / MAV_AUTOPILOT_INVALID：地面站、云台等非飞控组件
+                return 0;
+            }
+            state.customMode = readLe<std::uint32_t>(p);
+            state.vehicleType = type;
+            state.baseMode = p[6];
+            state.systemStatus = p[7];
+            state.armed = (p[6] & 0x80) != 0;  // MAV_MODE_FLAG_SAFETY_ARMED
+            return fieldBit(FlightField::Heartbeat);
+        }
+        case kMsgSysStatus: {
+            // sensors_present, sensors_enabled, sensors_health(u32 ×3), load(u16 0.1%), voltage_battery(u16 mV),
+            // current_battery(i16 cA，-1 为未知), drop_rate_comm(u16 0.01%), ..., battery_remaining(int8 %, 偏移 30)
+            state.sensorsHealth = readLe<std::uint32_t>(p + 8);
+            state.loadPermille = readLe<std::uint16_t>(p + 12);
+            state.dropRateComm = readLe<std::uint16_t>(p + 18);
+            std::uint32_t mask = fieldBit(FlightField::SysStatus);
+            const auto voltage = readLe<std::uint16_t>(p + 14);
+            if (voltage != 0xFFFF) {
+                state.batteryVoltageMv = voltage;
+                mask |= fieldBit(FlightField::Battery);
+            }
+            const auto current = readLe<std::int16_t>(p + 16);
+            if (current >= 0) state.batteryCurrentA = current / 100.0;
+            const auto remaining = static_cast<std::int8_t>(p[30]);
+            if (remaining >= 0) state.batteryPercent = remaining;
+            return mask;
+        }
+        case kMsgBatteryStatus: {
+            // current_consumed(i32 mAh), energy_consumed, temperature(i16 cdegC), voltages[10](u16 mV),
+            // current_battery(i16 cA, 偏移 30), id, function, type, battery_remaining(int8 %, 偏移 35)
+            const auto consumed = readLe<std::int32_t>(p);
+            if (consumed >= 0) state.batteryConsumedMah = consumed;
+            const auto temperature = readLe<std::int16_t>(p + 8);
+            if (temperature != 0x7FFF) state.batteryTemperatureC = temperature / 100.0;
+            // 各节电压求和（UINT16_MAX 为未使用的槽位）；只有总电压时放在第一格
+            int voltageMv = 0;
+            for (int i = 0; i < 10; ++i) {
+                const auto cell = readLe<std::uint16_t>(p + 10 + 2 * i);
+                if (cell == 0xFFFF) break;
+                voltageMv += cell;
+            }
+            if (voltageMv > 0) state.batteryVoltageMv = voltageMv;
+            const auto current = readLe<std::int16_t>(p + 30);
+            if (current >= 0) state.batteryCurrentA = current / 100.0;
+            const auto remaining = static_cast<std::int8_t>(p[35]);
+            if (remaining >= 0) state.batteryPercent = remaining;
+            return fieldBit(FlightField::Battery);
+        }
+        case kMsgGpsRawInt: {
+            // time_usec, lat, lon, alt, eph(u16 cm, 偏移 20), epv, vel(u16 cm/s, 偏移 24), cog,
+            // fix_type(偏移 28), satellites_visible(偏移 29)
+            const auto eph = readLe<std::uint16_t>(p + 20);
+            state.gpsEph = eph == 0xFFFF ? -1.0 : eph / 100.0;
+            const auto vel = readLe<std::uint16_t>(p + 24);
+            if (vel != 0xFFFF) state.groundSpeed = vel / 100.0;
+            state.gpsFixType = p[28];
+            state.numSat = p[29] == 0xFF ? 0 : p[29];
+            return fieldBit(FlightField::Gps);
+        }
+        case kMsgMissionCurrent: {
+            // seq(u16)，扩展：total(u16，UINT16_MAX 为未知), mission_state(u8)；v1 与截断的 v2 载荷中扩展字段读作 0
+            state.missionSeq = readLe<std::uint16_t>(p);
+            const auto total = readLe<std::uint16_t>(p + 2);
+            if (total != 0 && total != 0xFFFF) state.missionTotal = total;
+            if (p[4] != 0) state.missionState = p[4];
+            return fieldBit(FlightField::Mission);
+        }
+        case kMsgMissionItemReached:
+            // seq(u16)
+            state.missionReached = readLe<std::uint16_t>(p);
+            return fieldBit(FlightField::Mission);
+        default:
+            return 0;
+    }
+}
+
+} // namespace falconmind::sdk::flight::mavlink
@@ -0,0 +1,294 @@
+// FalconMindSDK - MAVLink Router Implementation
+#include "falconmind/sdk/flight/MavlinkRouter.h"
+#include "falconmind/sdk/core/FlightLog.h"
+#include "falconmind/sdk/core/Trace.h"
+#include "falconmind/sdk/flight/FlightConnectionService.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace falconmind::sdk::flight {
+
+namespace {
+
+std::int64_t steadyNowNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+MavlinkRouter::MavlinkRouter() = default;
+
+MavlinkRouter::~MavlinkRouter() {
+    stop();
+    for (auto& ep : endpoints_) {
+        if (ep->fd >= 0) ::close(ep->fd);
+    }
+}
+
+bool MavlinkRouter::addEndpoint(int localPort, const std::string& bindAddress) {
+    if (running()) {
+        std::cerr << "[MavlinkRouter] addEndpoint: router already running" << std::endl;
+        return false;
+    }
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(static_cast<uint16_t>(localPort));
+    if (::inet_pton(AF_INET, bindAddress.c_str(), &local.sin_addr) != 1) {
+        std::cerr << "[MavlinkRouter] invalid bind address: " << bindAddress << std::endl;
+        return false;
+    }
+    const int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        std::perror("[MavlinkRouter] socket");
+        return false;
+    }
+    // 多机汇聚时突发量大，放大接收缓冲（受 net.core.rmem_max 限制）
+    int rcvbuf = 4 * 1024 * 1024;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) < 0) {
+        std::perror("[MavlinkRouter] bind");
+        ::close(fd);
+        return false;
+    }
+    auto ep = std::make_unique<Endpoint>();
+    ep->fd = fd;
+    endpoints_.push_back(std::move(ep));
+    return true;
+}
+
+int MavlinkRouter::endpointPort(std::size_t index) const {
+    if (index >= endpoints_.size()) return -1;
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (::getsockname(endpoints_[index]->fd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) return -1;
+    return ntohs(addr.sin_port);
+}
+
+bool MavlinkRouter::start() {
+#ifdef __linux__
+    if (running()) return true;
+    if (endpoints_.empty()) {
+        std::cerr << "[MavlinkRouter] start: no endpoints" << std::endl;
+        return false;
+    }
+    epollFd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epollFd_ < 0 || wakeFd_ < 0) {
+        std::cerr << "[MavlinkRouter] epoll/eventfd failed: " << errno << std::endl;
+        stop();
+        return false;
+    }
+    // data.u64：端点下标，wakeFd_ 用 UINT64_MAX
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = UINT64_MAX;
+    bool ok = ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &ev) == 0;
+    for (std::size_t i = 0; ok && i < endpoints_.size(); ++i) {
+        ev.data.u64 = i;
+        ok = ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, endpoints_[i]->fd, &ev) == 0;
+    }
+    if (!ok) {
+        std::cerr << "[MavlinkRouter] epoll_ctl failed: " << errno << std::endl;
+        stop();
+        return false;
+    }
+    recvStorage_.assign(kRecvBatch * kDatagramBytes, 0);
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this] { ioLoop(); });
+    return true;
+#else
+    std::cerr << "[MavlinkRouter] start: not supported on this platform" << std::endl;
+    return false;
+#endif
+}
+
+void MavlinkRouter::stop() {
+#ifdef __linux__
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        wake();
+        thread_.join();
+    }
+    if (epollFd_ >= 0) ::close(epollFd_);
+    if (wakeFd_ >= 0) ::close(wakeFd_);
+    epollFd_ = -1;
+    wakeFd_ = -1;
+#endif
+}
+
+void MavlinkRouter::wake() {
+    if (wakeFd_ >= 0) {
+        std::uint64_t one = 1;
+        (void)!::write(wakeFd_, &one, sizeof(one));
+    }
+}
+
+bool MavlinkRouter::attach(std::uint8_t sysid, FlightConnectionService* svc) {
+    std::lock_guard<std::mutex> lk(routeMutex_);
+    Route& r = routes_[sysid];
+    if (r.svc && r.svc != svc) {
+        std::cerr << "[MavlinkRouter] sysid " << static_cast<int>(sysid) << " already attached" << std::endl;
+        return false;
+    }
+    r.svc = svc;
+    return true;
+}
+
+void MavlinkRouter::detach(std::uint8_t sysid, FlightConnectionService* svc) {
+    std::lock_guard<std::mutex> lk(routeMutex_);
+    if (routes_[sysid].svc == svc) routes_[sysid].svc = nullptr;
+}
+
+void MavlinkRouter::setDiscoveryHandler(DiscoveryHandler handler) {
+    std::lock_guard<std::mutex> lk(routeMutex_);
+    discovery_ = std::move(handler);
+}
+
+bool MavlinkRouter::sendTo(std::uint8_t sysid, const std::uint8_t* frame, std::size_t size) {
+    const Route& r = routes_[sysid];
+    if (!r.heard.load(std::memory_order_acquire)) return false;
+    const RemoteAddr remote = r.remote.load();
+    if (remote.endpoint < 0 || static_cast<std::size_t>(remote.endpoint) >= endpoints_.size()) return false;
+    if (::sendto(endpoints_[remote.endpoint]->fd, frame, size, 0, reinterpret_cast<const sockaddr*>(&remote.addr),
+                 sizeof(remote.addr)) != static_cast<ssize_t>(size)) {
+        return false;
+    }
+    if (log_) log_->record(core::LogRecordType::MavlinkTx, frame, size);
+    return true;
+}
+
+std::vector<std::uint8_t> MavlinkRouter::vehicles() const {
+    std::vector<std::uint8_t> out;
+    for (std::size_t i = 0; i < routes_.size(); ++i) {
+        if (routes_[i].heard.load(std::memory_order_acquire)) out.push_back(static_cast<std::uint8_t>(i));
+    }
+    return out;
+}
+
+std::uint64_t MavlinkRouter::framesFrom(std::uint8_t sysid) const noexcept {
+    return routes_[sysid].frames.load(std::memory_order_relaxed);
+}
+
+std::uint64_t MavlinkRouter::seqGapsFrom(std::uint8_t sysid) const noexcept {
+    return routes_[sysid].seqGaps.load(std::memory_order_relaxed);
+}
+
+MavlinkRouterStats MavlinkRouter::stats() const noexcept {
+    MavlinkRouterStats s;
+    s.datagrams = datagrams_.load(std::memory_order_relaxed);
+    s.frames = frames_.load(std::memory_order_relaxed);
+    s.unrouted = unrouted_.load(std::memory_order_relaxed);
+    for (const auto& ep : endpoints_) s.crcErrors += ep->parser.stats().crcErrors;  // 近似值
+    return s;
+}
+
+void MavlinkRouter::drainEndpoint(std::size_t index) {
+#ifdef __linux__
+    Endpoint& ep = *endpoints_[index];
+    FM_TRACE_SCOPE("mavlink", "router.drain");
+    iovec iovs[kRecvBatch];
+    mmsghdr msgs[kRecvBatch];
+    for (std::size_t i = 0; i < kRecvBatch; ++i) {
+        iovs[i].iov_base = recvStorage_.data() + i * kDatagramBytes;
+        iovs[i].iov_len = kDatagramBytes;
+        msgs[i].msg_hdr = msghdr{};
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &recvAddrs_[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    }
+    const int received = ::recvmmsg(ep.fd, msgs, static_cast<unsigned>(kRecvBatch), MSG_DONTWAIT, nullptr);
+    if (received <= 0) return;
+    datagrams_.fetch_add(static_cast<std::uint64_t>(received), std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lk(routeMutex_);
+    for (int i = 0; i < received; ++i) {
+        const sockaddr_in& from = recvAddrs_[i];
+        if (log_) log_->record(core::LogRecordType::MavlinkRx, iovs[i].iov_base, msgs[i].msg_len);
+        ep.parser.feed(static_cast<const std::uint8_t*>(iovs[i].iov_base), msgs[i].msg_len,
+                       [&](const mavlink::Frame& frame) {
+            frames_.fetch_add(1, std::memory_order_relaxed);
+            Route& r = routes_[frame.sysid];
+            // 记录来源地址（变化时才写 seqlock）
+            const bool heard = r.heard.load(std::memory_order_relaxed);
+            if (!heard) {
+                r.remote.store(RemoteAddr{from, static_cast<int>(index)});
+                r.heard.store(true, std::memory_order_release);
+            } else {
+                const RemoteAddr cur = r.remote.load();
+                if (cur.endpoint != static_cast<int>(index) || cur.addr.sin_port != from.sin_port ||
+                    cur.addr.sin_addr.s_addr != from.sin_addr.s_addr) {
+                    r.remote.store(RemoteAddr{from, static_cast<int>(index)});
+                }
+                r.seqGaps.fetch_add(static_cast<std::uint8_t>(frame.seq - r.lastSeq - 1), std::memory_order_relaxed);
+            }
+            r.lastSeq = frame.seq;
+            r.frames.fetch_add(1, std::memory_order_relaxed);
+
+            if (r.svc) {
+                r.svc->deliverRouted(frame);
+                return;
+            }
+            unrouted_.fetch_add(1, std::memory_order_relaxed);
+            if (!r.discovered) {
+                r.discovered = true;
+                if (discovery_) discovery_(frame.sysid, frame.compid);
+            }
+        });
+    }
+#else
+    (void)index;
+#endif
+}
+
+void MavlinkRouter::ioLoop() {
+#ifdef __linux__
+    FM_TRACE_THREAD_NAME("mavlink-router");
+    std::vector<epoll_event> events(endpoints_.size() + 1);
+    while (running_.load(std::memory_order_acquire)) {
+        // 挂接服务的命令重发 / 超时：按最近的截止时间醒来
+        const std::int64_t now = steadyNowNs();
+        std::int64_t next = 0;
+        {
+            std::lock_guard<std::mutex> lk(routeMutex_);
+            for (auto& r : routes_) {
+                if (!r.svc) continue;
+                const std::int64_t d = r.svc->serviceCommandTimeouts(now);
+                if (d > 0 && (next == 0 || d < next)) next = d;
+            }
+        }
+        const int timeoutMs = next > 0 ? static_cast<int>(std::max<std::int64_t>(0, (next - now + 999'999) / 1'000'000)) : -1;
+        const int n = ::epoll_wait(epollFd_, events.data(), static_cast<int>(events.size()), timeoutMs);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[MavlinkRouter] epoll_wait failed: " << errno << std::endl;
+            break;
+        }
+        for (int i = 0; i < n; ++i) {
+            if (events[i].data.u64 == UINT64_MAX) {
+                std::uint64_t value = 0;
+                (void)!::read(wakeFd_, &value, sizeof(value));
+                continue;
+            }
+            drainEndpoint(static_cast<std::size_t>(events[i].data.u64));
+        }
+    }
+#endif
+}
+
+} // namespace falconmind::sdk::flight
@@ -0,0 +1,177 @@
+// FalconMindSDK - MAVLink Mission Upload Implementation
+#include "falconmind/sdk/flight/MissionUpload.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace falconmind::sdk::flight {
+
+namespace {
+
+constexpr std::uint8_t kMissionTypeMission = 0;  // MAV_MISSION_TYPE_MISSION
+
+template <typename T>
+void putLe(std::uint8_t* p, T v) noexcept {
+    std::memcpy(p, &v, sizeof(T));  // MAVLink 为小端，目标平台同为小端
+}
+
+template <typename T>
+T readLe(const std::uint8_t* p) noexcept {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+} // namespace
+
+MissionItem MissionItem::waypoint(double lat, double lon, float relativeAlt, float acceptRadiusM, float yawDeg) noexcept {
+    MissionItem item;
+    item.lat = lat;
+    item.lon = lon;
+    item.alt = relativeAlt;
+    item.param2 = acceptRadiusM;
+    item.param4 = yawDeg;
+    return item;
+}
+
+std::size_t MissionUploader::encodeCount(std::uint16_t count, std::uint8_t targetSystem, std::uint8_t targetComponent,
+                                         std::uint8_t* payload) noexcept {
+    // count(u16), target_system, target_component, 扩展：mission_type
+    putLe(payload, count);
+    payload[2] = targetSystem;
+    payload[3] = targetComponent;
+    payload[4] = kMissionTypeMission;
+    return kCountLen;
+}
+
+std::size_t MissionUploader::encodeItem(const MissionItem& item, std::uint16_t seq, std::uint8_t targetSystem,
+                                        std::uint8_t targetComponent, std::uint8_t* payload) noexcept {
+    // param1..4(f32), x(i32 1e-7 deg), y(i32), z(f32), seq(u16), command(u16), target_system, target_component,
+    // frame, current, autocontinue, 扩展：mission_type
+    putLe(payload, item.param1);
+    putLe(payload + 4, item.param2);
+    putLe(payload + 8, item.param3);
+    putLe(payload + 12, item.param4);
+    putLe(payload + 16, static_cast<std::int32_t>(std::lround(item.lat * 1e7)));
+    putLe(payload + 20, static_cast<std::int32_t>(std::lround(item.lon * 1e7)));
+    putLe(payload + 24, item.alt);
+    putLe(payload + 28, seq);
+    putLe(payload + 30, item.command);
+    payload[32] = targetSystem;
+    payload[33] = targetComponent;
+    payload[34] = item.frame;
+    payload[35] = seq == 0 ? 1 : 0;
+    payload[36] = item.autocontinue ? 1 : 0;
+    payload[37] = kMissionTypeMission;
+    return kItemIntLen;
+}
+
+bool MissionUploader::sendCount(const SendFn& send) {
+    std::uint8_t payload[kCountLen];
+    const std::size_t len = encodeCount(static_cast<std::uint16_t>(items_.size()), targetSystem_, targetComponent_, payload);
+    return send(mavlink::kMsgMissionCount, payload, len);
+}
+
+bool MissionUploader::sendItem(std::uint16_t seq, const SendFn& send) {
+    std::uint8_t payload[kItemIntLen];
+    const std::size_t len = encodeItem(items_[seq], seq, targetSystem_, targetComponent_, payload);
+    return send(mavlink::kMsgMissionItemInt, payload, len);
+}
+
+bool MissionUploader::begin(std::vector<MissionItem> items, std::uint8_t targetSystem, std::uint8_t targetComponent,
+                            const MissionUploadOptions& options, std::int64_t nowNs, const SendFn& send) {
+    items_ = std::move(items);
+    if (items_.size() > 0xFFFF) items_.resize(0xFFFF);
+    requested_.assign(items_.size(), false);
+    options_ = options;
+    options_.timeoutMs = std::max(1, options.timeoutMs);
+    options_.maxAttempts = std::max(1, options.maxAttempts);
+    targetSystem_ = targetSystem;
+    targetComponent_ = targetComponent;
+    ack_ = MissionUploadAck{};
+    ack_.count = static_cast<std::uint16_t>(items_.size());
+    startNs_ = nowNs;
+    lastSent_ = -1;
+    attempts_ = 1;
+    deadlineNs_ = nowNs + static_cast<std::int64_t>(options_.timeoutMs) * 1'000'000;
+    active_ = sendCount(send);
+    return active_;
+}
+
+void MissionUploader::finish(MissionUploadResult result, std::int64_t nowNs, MissionUploadAck& done) {
+    ack_.result = result;
+    ack_.latencyNs = nowNs - startNs_;
+    done = ack_;
+    active_ = false;
+}
+
+bool MissionUploader::onFrame(const mavlink::Frame& frame, std::int64_t nowNs, const SendFn& send,
+                              MissionUploadAck& done) {
+    if (!active_) return false;
+    const std::uint8_t* p = frame.payload;
+    switch (frame.msgid) {
+        case mavlink::kMsgMissionRequestInt:
+        case mavlink::kMsgMissionRequest: {
+            // seq(u16), target_system, target_component, 扩展：mission_type
+            if (p[4] != kMissionTypeMission) return false;
+            const auto seq = readLe<std::uint16_t>(p);
+            if (seq >= items_.size()) return false;
+            if (!requested_[seq]) {
+                requested_[seq] = true;
+                ++ack_.itemsSent;
+            }
+            lastSent_ = seq;
+            attempts_ = 1;
+            deadlineNs_ = nowNs + static_cast<std::int64_t>(options_.timeoutMs) * 1'000'000;
+            if (!sendItem(seq, send)) {
+                finish(MissionUploadResult::SendFailed, nowNs, done);
+                return true;
+            }
+            return false;
+        }
+        case mavlink::kMsgMissionAck: {
+            // target_system, target_component, type(MAV_MISSION_RESULT), 扩展：mission_type
+            if (p[3] != kMissionTypeMission) return false;
+            const std::uint8_t type = p[2];
+            if (type == 0) {
+                // 未请求完的“接受”是上一次上传迟到的 ACK
+                if (ack_.itemsSent != items_.size()) return false;
+                finish(MissionUploadResult::Accepted, nowNs, done);
+                return true;
+            }
+            MissionUploadResult result = MissionUploadResult::Error;
+            if (type <= static_cast<std::uint8_t>(MissionUploadResult::Invalid) ||
+                (type >= static_cast<std::uint8_t>(MissionUploadResult::InvalidSequence) &&
+                 type <= static_cast<std::uint8_t>(MissionUploadResult::Cancelled))) {
+                result = static_cast<MissionUploadResult>(type);
+            } else if (type < static_cast<std::uint8_t>(MissionUploadResult::InvalidSequence)) {
+                result = MissionUploadResult::Invalid;  // MAV_MISSION_INVALID_PARAM1..7 / X / Y
+            }
+            finish(result, nowNs, done);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+bool MissionUploader::service(std::int64_t nowNs, const SendFn& send, MissionUploadAck& done) {
+    if (!active_ || nowNs < deadlineNs_) return false;
+    if (attempts_ >= options_.maxAttempts) {
+        finish(MissionUploadResult::Timeout, nowNs, done);
+        return true;
+    }
+    ++attempts_;
+    ++ack_.resends;
+    deadlineNs_ = nowNs + static_cast<std::int64_t>(options_.timeoutMs) * 1'000'000;
+    // 发送失败留给下一次超时重发 / 判定
+    if (lastSent_ < 0) {
+        sendCount(send);
+    } else {
+        sendItem(static_cast<std::uint16_t>(lastSent_), send);
+    }
+    return false;
+}
+
+} // namespace falconmind::sdk::flight
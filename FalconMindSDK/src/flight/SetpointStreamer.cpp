@@ -0,0 +1,182 @@
+// FalconMindSDK - Setpoint Streamer Implementation
+#include "falconmind/sdk/flight/SetpointStreamer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace falconmind::sdk::flight {
+
+namespace {
+
+// POSITION_TARGET_TYPEMASK：置位表示忽略对应分量
+constexpr std::uint16_t kIgnorePosition = 0x0007;
+constexpr std::uint16_t kIgnoreVelocity = 0x0038;
+constexpr std::uint16_t kIgnoreAccel = 0x01C0;
+constexpr std::uint16_t kIgnoreYaw = 0x0400;
+constexpr std::uint16_t kIgnoreYawRate = 0x0800;
+constexpr std::uint8_t kFrameLocalNed = 1;  // MAV_FRAME_LOCAL_NED
+
+std::int64_t steadyNowNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+inline void putFloat(std::uint8_t* p, float v) noexcept { std::memcpy(p, &v, sizeof(v)); }
+
+} // namespace
+
+OffboardSetpoint OffboardSetpoint::fromEnu(double east, double north, double up, double ve, double vn, double vu,
+                                           double yaw, SetpointMode mode) noexcept {
+    OffboardSetpoint sp;
+    sp.mode = mode;
+    sp.x = static_cast<float>(north);
+    sp.y = static_cast<float>(east);
+    sp.z = static_cast<float>(-up);
+    sp.vx = static_cast<float>(vn);
+    sp.vy = static_cast<float>(ve);
+    sp.vz = static_cast<float>(-vu);
+    sp.yaw = static_cast<float>(yaw);
+    return sp;
+}
+
+SetpointStreamer::SetpointStreamer(FlightConnectionService& svc, std::uint8_t targetSystem,
+                                   std::uint8_t targetComponent)
+    : svc_(svc), targetSystem_(targetSystem), targetComponent_(targetComponent) {
+    const mavlink::MessageInfo* info = mavlink::findMessage(mavlink::kMsgSetPositionTargetLocalNed);
+    crcExtra_ = info ? info->crcExtra : 0;
+    startNs_ = steadyNowNs();
+    buildTemplate();
+}
+
+SetpointStreamer::~SetpointStreamer() {
+    stop();
+}
+
+void SetpointStreamer::buildTemplate() noexcept {
+    frame_.fill(0);
+    std::uint32_t msgid = mavlink::kMsgSetPositionTargetLocalNed;
+    if (svc_.mavlinkVersion() == MavlinkVersion::V1) {
+        header_ = mavlink::kHeaderV1;
+        seqOffset_ = 2;
+        frame_[0] = mavlink::kStxV1;
+        frame_[3] = FlightConnectionService::kSysId;
+        frame_[4] = FlightConnectionService::kCompId;
+        frame_[5] = static_cast<std::uint8_t>(msgid);
+    } else {
+        header_ = mavlink::kHeaderV2;
+        seqOffset_ = 4;
+        frame_[0] = mavlink::kStxV2;
+        frame_[2] = 0;  // incompat flags
+        frame_[3] = 0;  // compat flags
+        frame_[5] = FlightConnectionService::kSysId;
+        frame_[6] = FlightConnectionService::kCompId;
+        frame_[7] = static_cast<std::uint8_t>(msgid & 0xFF);
+        frame_[8] = static_cast<std::uint8_t>((msgid >> 8) & 0xFF);
+        frame_[9] = static_cast<std::uint8_t>((msgid >> 16) & 0xFF);
+    }
+    frame_[1] = static_cast<std::uint8_t>(kPayloadLen);
+    // 载荷中不随设定点变化的字段
+    std::uint8_t* p = frame_.data() + header_;
+    p[50] = targetSystem_;
+    p[51] = targetComponent_;
+    p[52] = kFrameLocalNed;
+    crcPrefix_ = mavlink::crcCalculate(frame_.data() + 1, seqOffset_ - 1);
+}
+
+std::size_t SetpointStreamer::encode(const OffboardSetpoint& sp, std::uint32_t timeBootMs,
+                                     std::uint8_t seq) noexcept {
+    frame_[seqOffset_] = seq;
+
+    // 载荷布局（按字段大小排序）：time_boot_ms, x, y, z, vx, vy, vz, afx, afy, afz, yaw, yaw_rate,
+    // type_mask(u16), target_system, target_component, coordinate_frame
+    std::uint8_t* p = frame_.data() + header_;
+    std::memcpy(p, &timeBootMs, sizeof(timeBootMs));
+    putFloat(p + 4, sp.x);
+    putFloat(p + 8, sp.y);
+    putFloat(p + 12, sp.z);
+    putFloat(p + 16, sp.vx);
+    putFloat(p + 20, sp.vy);
+    putFloat(p + 24, sp.vz);
+    putFloat(p + 40, sp.yaw);
+    putFloat(p + 44, sp.yawRate);
+    std::uint16_t mask = kIgnoreAccel;
+    if (sp.mode == SetpointMode::Position) mask |= kIgnoreVelocity;
+    if (sp.mode == SetpointMode::Velocity) mask |= kIgnorePosition;
+    mask |= sp.useYawRate ? kIgnoreYaw : kIgnoreYawRate;
+    std::memcpy(p + 48, &mask, sizeof(mask));
+
+    std::uint16_t crc = mavlink::crcCalculate(frame_.data() + seqOffset_, header_ - seqOffset_ + kPayloadLen, crcPrefix_);
+    crc = mavlink::crcAccumulate(crcExtra_, crc);
+    frame_[header_ + kPayloadLen] = static_cast<std::uint8_t>(crc & 0xFF);
+    frame_[header_ + kPayloadLen + 1] = static_cast<std::uint8_t>(crc >> 8);
+    return header_ + kPayloadLen + 2;
+}
+
+bool SetpointStreamer::sendOnce() {
+    if (setpoint_.version() == 0) {
+        return false;
+    }
+    const OffboardSetpoint sp = setpoint_.load();
+    const auto timeBootMs = static_cast<std::uint32_t>((steadyNowNs() - startNs_) / 1'000'000);
+    const std::size_t size = encode(sp, timeBootMs, svc_.nextSequence());
+    if (!svc_.sendFrame(frame_.data(), size)) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    sent_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool SetpointStreamer::start(double rateHz) {
+    if (running()) {
+        return true;
+    }
+    if (!svc_.isConnected()) {
+        std::cerr << "[SetpointStreamer] start: flight link not connected" << std::endl;
+        return false;
+    }
+    rateHz = std::clamp(rateHz, 1.0, 200.0);
+    buildTemplate();  // 链路版本在 connect 后才确定
+    running_.store(true, std::memory_order_release);
+    const auto periodNs = static_cast<std::int64_t>(1e9 / rateHz);
+    thread_ = std::thread([this, periodNs] { loop(periodNs); });
+    return true;
+}
+
+void SetpointStreamer::stop() {
+    {
+        std::lock_guard<std::mutex> lk(wakeMutex_);
+        running_.store(false, std::memory_order_release);
+    }
+    wakeCv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void SetpointStreamer::loop(std::int64_t periodNs) {
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::nanoseconds(periodNs);
+    auto next = Clock::now();
+    std::unique_lock<std::mutex> lk(wakeMutex_);
+    while (running_.load(std::memory_order_acquire)) {
+        lk.unlock();
+        sendOnce();
+        lk.lock();
+
+        // 固定节拍：调度延迟超过整周期时跳过错过的节拍，不补发（补发的旧设定点没有意义）
+        next += period;
+        const auto now = Clock::now();
+        if (now >= next) {
+            const auto behind = (now - next) / period + 1;
+            missed_.fetch_add(static_cast<std::uint64_t>(behind), std::memory_order_relaxed);
+            next += period * behind;
+        }
+        wakeCv_.wait_until(lk, next, [this] { return !running_.load(std::memory_order_acquire); });
+    }
+}
+
+} // namespace falconmind::sdk::flight
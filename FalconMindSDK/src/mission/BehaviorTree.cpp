@@ -1,10 +1,116 @@
 #include "falconmind/sdk/mission/BehaviorTree.h"
 
+#include <algorithm>
+
 namespace falconmind::sdk::mission {
 
+namespace {
+
+thread_local BehaviorTreeExecutor* tlsExecutor = nullptr;
+
+constexpr BtClock::time_point kNever = BtClock::time_point::max();
+
+} // namespace
+
+void BehaviorWaker::wake() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = true;
+    }
+    cv_.notify_all();
+}
+
+bool BehaviorWaker::waitUntil(BtClock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool woken;
+    if (deadline == kNever) {
+        cv_.wait(lock, [this] { return pending_; });
+        woken = true;
+    } else {
+        woken = core::PipelineClock::waitUntil(cv_, lock, BtClock::toNs(deadline), [this] { return pending_; });
+    }
+    pending_ = false;
+    return woken;
+}
+
+void BehaviorEvent::notify() {
+    version_.fetch_add(1, std::memory_order_acq_rel);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& weak : wakers_) {
+        if (auto waker = weak.lock()) waker->wake();
+    }
+}
+
+void BehaviorEvent::attach(const std::shared_ptr<BehaviorWaker>& waker) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wakers_.erase(std::remove_if(wakers_.begin(), wakers_.end(),
+                                 [](const std::weak_ptr<BehaviorWaker>& w) { return w.expired(); }),
+                  wakers_.end());
+    for (const auto& weak : wakers_) {
+        if (weak.lock() == waker) return;
+    }
+    wakers_.push_back(waker);
+}
+
+bool BehaviorNode::awaiting(BtClock::time_point now) const {
+    if (!hasRun_ || lastStatus_ != NodeStatus::Running) return false;
+    if (waits_.empty() && deadline_ == kNever) return false;
+    if (now >= deadline_) return false;
+    for (const auto& w : waits_) {
+        if (w.event->version() != w.version) return false;
+    }
+    return true;
+}
+
+void BehaviorNode::waitFor(const BehaviorEvent& event) {
+    const auto version = event.version();
+    waits_.push_back({&event, version});
+    if (auto* exec = BehaviorTreeExecutor::current()) exec->registerWait(event, version);
+}
+
+void BehaviorNode::waitUntil(BtClock::time_point deadline) {
+    deadline_ = std::min(deadline_, deadline);
+    if (auto* exec = BehaviorTreeExecutor::current()) exec->registerDeadline(deadline);
+}
+
+NodeStatus BehaviorNode::tickChild(BehaviorNode& child) {
+    auto* exec = BehaviorTreeExecutor::current();
+    // 组合 / 装饰节点登记的等待只用于唤醒执行器，自身总要重新 tick 以便子节点按各自条件运行
+    if (!child.isComposite() && child.awaiting(BtClock::now())) {
+        if (exec) {
+            for (const auto& w : child.waits_) exec->registerWait(*w.event, w.version);
+            if (child.deadline_ != kNever) exec->registerDeadline(child.deadline_);
+        }
+        return NodeStatus::Running;
+    }
+
+    child.waits_.clear();
+    child.deadline_ = kNever;
+    const auto status = child.tick();
+    child.lastStatus_ = status;
+    child.hasRun_ = true;
+    if (status == NodeStatus::Running && !child.isComposite() && child.waits_.empty() &&
+        child.deadline_ == kNever && exec) {
+        exec->requestPoll();
+    }
+    return status;
+}
+
+void BehaviorNode::haltChild(BehaviorNode& child) {
+    child.halt();
+    child.waits_.clear();
+    child.deadline_ = kNever;
+    child.lastStatus_ = NodeStatus::Failure;
+    child.hasRun_ = false;
+}
+
+void CompositeNode::halt() {
+    for (auto& child : children_) haltChild(*child);
+}
+
 NodeStatus SequenceNode::tick() {
     while (currentIndex_ < children_.size()) {
-        auto status = children_[currentIndex_]->tick();
+        auto status = tickChild(*children_[currentIndex_]);
         if (status == NodeStatus::Running) {
             return NodeStatus::Running;
         }
@@ -17,5 +123,181 @@ NodeStatus SequenceNode::tick() {
     return NodeStatus::Success;
 }
 
-} // namespace falconmind::sdk::mission
+void SequenceNode::halt() {
+    CompositeNode::halt();
+    currentIndex_ = 0;
+}
+
+NodeStatus FallbackNode::tick() {
+    while (currentIndex_ < children_.size()) {
+        auto status = tickChild(*children_[currentIndex_]);
+        if (status == NodeStatus::Running) {
+            return NodeStatus::Running;
+        }
+        if (status == NodeStatus::Success) {
+            return NodeStatus::Success;
+        }
+        // Failure，尝试下一个子节点
+        ++currentIndex_;
+    }
+    return NodeStatus::Failure;
+}
+
+void FallbackNode::halt() {
+    CompositeNode::halt();
+    currentIndex_ = 0;
+}
 
+NodeStatus ReactiveSequenceNode::tick() {
+    for (std::size_t i = 0; i < children_.size(); ++i) {
+        auto status = tickChild(*children_[i]);
+        if (status == NodeStatus::Success) continue;
+        // 前面的条件 / 动作未完成或被打破：中止之后仍在执行的分支
+        for (std::size_t j = i + 1; j < children_.size(); ++j) {
+            if (children_[j]->lastStatus() == NodeStatus::Running) haltChild(*children_[j]);
+        }
+        return status;
+    }
+    return NodeStatus::Success;
+}
+
+NodeStatus ParallelNode::tick() {
+    const std::size_t n = children_.size();
+    if (status_.size() != n) status_.assign(n, NodeStatus::Running);
+    const std::size_t threshold = successThreshold_ == 0 ? n : std::min(successThreshold_, n);
+
+    std::size_t succeeded = 0, failed = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (status_[i] == NodeStatus::Running) status_[i] = tickChild(*children_[i]);
+        if (status_[i] == NodeStatus::Success) ++succeeded;
+        else if (status_[i] == NodeStatus::Failure) ++failed;
+    }
+
+    NodeStatus result = NodeStatus::Running;
+    if (succeeded >= threshold) result = NodeStatus::Success;
+    else if (failed > n - threshold) result = NodeStatus::Failure;
+    if (result != NodeStatus::Running) halt();
+    return result;
+}
+
+void ParallelNode::halt() {
+    for (std::size_t i = 0; i < children_.size(); ++i) {
+        if (i >= status_.size() || status_[i] == NodeStatus::Running) haltChild(*children_[i]);
+    }
+    status_.clear();
+}
+
+void DecoratorNode::halt() {
+    if (child_) haltChild(*child_);
+}
+
+NodeStatus TimeoutNode::tick() {
+    if (!child_) return NodeStatus::Failure;
+    const auto now = BtClock::now();
+    if (!started_) {
+        started_ = true;
+        deadline_ = now + timeout_;
+    }
+    if (now >= deadline_) {
+        haltChild(*child_);
+        started_ = false;
+        return NodeStatus::Failure;
+    }
+    const auto status = tickChild(*child_);
+    if (status != NodeStatus::Running) {
+        started_ = false;
+        return status;
+    }
+    waitUntil(deadline_);
+    return NodeStatus::Running;
+}
+
+void TimeoutNode::halt() {
+    DecoratorNode::halt();
+    started_ = false;
+}
+
+NodeStatus RetryNode::tick() {
+    if (!child_) return NodeStatus::Failure;
+    for (;;) {
+        const auto status = tickChild(*child_);
+        if (status == NodeStatus::Failure && ++attempts_ < maxAttempts_) {
+            haltChild(*child_);
+            continue;
+        }
+        if (status != NodeStatus::Running) attempts_ = 0;
+        return status;
+    }
+}
+
+void RetryNode::halt() {
+    DecoratorNode::halt();
+    attempts_ = 0;
+}
+
+NodeStatus ConditionNode::tick() {
+    // 先登记再求值：求值之后发生的变化一定会唤醒执行器
+    for (const auto* input : inputs_) waitFor(*input);
+    return predicate_ && predicate_() ? NodeStatus::Success : NodeStatus::Failure;
+}
+
+BehaviorTreeExecutor::BehaviorTreeExecutor(BehaviorNodePtr root)
+    : root_(std::move(root)), waker_(std::make_shared<BehaviorWaker>()) {}
+
+BehaviorTreeExecutor* BehaviorTreeExecutor::current() noexcept {
+    return tlsExecutor;
+}
+
+void BehaviorTreeExecutor::registerWait(const BehaviorEvent& event, std::uint64_t seenVersion) {
+    pending_.push_back({&event, seenVersion});
+    event.attach(waker_);
+}
+
+void BehaviorTreeExecutor::registerDeadline(BtClock::time_point deadline) {
+    nextDeadline_ = std::min(nextDeadline_, deadline);
+}
+
+bool BehaviorTreeExecutor::eventsChanged() const noexcept {
+    for (const auto& w : pending_) {
+        if (w.event->version() != w.version) return true;
+    }
+    return false;
+}
+
+NodeStatus BehaviorTreeExecutor::tick() {
+    if (!root_) return NodeStatus::Failure;
+    auto* previous = tlsExecutor;
+    tlsExecutor = this;
+    pending_.clear();
+    nextDeadline_ = kNever;
+    pollRequested_ = false;
+    status_ = BehaviorNode::tickChild(*root_);
+    tlsExecutor = previous;
+    ++ticks_;
+    return status_;
+}
+
+NodeStatus BehaviorTreeExecutor::spinOnce(std::chrono::milliseconds maxWait) {
+    if (!root_) return NodeStatus::Failure;
+    if (ticks_ == 0) return tick();
+    if (status_ != NodeStatus::Running) return status_;
+
+    const auto now = BtClock::now();
+    auto due = nextDeadline_;
+    if (pollRequested_) due = std::min(due, now + pollInterval_);
+    const auto wakeAt = std::min(due, now + maxWait);
+
+    bool woken = eventsChanged() || now >= wakeAt;
+    if (!woken) woken = waker_->waitUntil(wakeAt);
+    if (!woken && BtClock::now() < due) return status_;
+    return tick();
+}
+
+NodeStatus BehaviorTreeExecutor::run(const std::function<bool()>& keepRunning) {
+    while (keepRunning()) {
+        if (spinOnce() != NodeStatus::Running) break;
+    }
+    return status_;
+}
+
+} // namespace falconmind::sdk::mission
@@ -0,0 +1,295 @@
+// FalconMindSDK - Behavior Tree Definition Implementation
+#include "falconmind/sdk/mission/BehaviorTreeDefinition.h"
+#include "falconmind/sdk/mission/FlightActions.h"
+#include "falconmind/sdk/mission/GeofenceMonitorNode.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iostream>
+
+namespace falconmind::sdk::mission {
+
+namespace {
+
+// 每个节点对象（含 shared_ptr 控制块）的典型大小，用于一次性预留实例内存池
+constexpr std::size_t kArenaBytesPerNode = 256;
+
+bool requireFlight(BtBuildContext& ctx, const char* type) {
+    if (ctx.flight) return true;
+    ctx.error = std::string(type) + " requires a FlightConnectionService";
+    return false;
+}
+
+bool requireBlackboard(BtBuildContext& ctx, const char* type) {
+    if (ctx.blackboard) return true;
+    ctx.error = std::string(type) + " requires a blackboard";
+    return false;
+}
+
+void registerBuiltins(BehaviorNodeRegistry& r) {
+    // 控制节点
+    r.registerType("sequence", BtNodeKind::Composite, [](const BtNodeParams&, const auto& children, BtBuildContext& ctx) {
+        auto node = ctx.make<SequenceNode>();
+        for (const auto& c : children) node->addChild(c);
+        return BehaviorNodePtr(node);
+    });
+    auto fallback = [](const BtNodeParams&, const std::vector<BehaviorNodePtr>& children, BtBuildContext& ctx) {
+        auto node = ctx.make<FallbackNode>();
+        for (const auto& c : children) node->addChild(c);
+        return BehaviorNodePtr(node);
+    };
+    r.registerType("fallback", BtNodeKind::Composite, fallback);
+    r.registerType("selector", BtNodeKind::Composite, fallback);
+    r.registerType("reactive_sequence", BtNodeKind::Composite,
+                   [](const BtNodeParams&, const auto& children, BtBuildContext& ctx) {
+                       auto node = ctx.make<ReactiveSequenceNode>();
+                       for (const auto& c : children) node->addChild(c);
+                       return BehaviorNodePtr(node);
+                   });
+    r.registerType("parallel", BtNodeKind::Composite, [](const BtNodeParams& p, const auto& children, BtBuildContext& ctx) {
+        const double threshold = p.number("success_threshold", 0.0);
+        auto node = ctx.make<ParallelNode>(static_cast<std::size_t>(std::max(0.0, threshold)));
+        for (const auto& c : children) node->addChild(c);
+        return BehaviorNodePtr(node);
+    });
+    r.registerType("timeout", BtNodeKind::Decorator, [](const BtNodeParams& p, const auto& children, BtBuildContext& ctx) {
+        const auto ms = std::chrono::milliseconds(static_cast<long long>(p.number("timeout_ms", 0.0)));
+        if (ms.count() <= 0) {
+            ctx.error = "timeout requires positive timeout_ms";
+            return BehaviorNodePtr();
+        }
+        return BehaviorNodePtr(ctx.make<TimeoutNode>(children[0], ms));
+    });
+    r.registerType("retry", BtNodeKind::Decorator, [](const BtNodeParams& p, const auto& children, BtBuildContext& ctx) {
+        const int attempts = static_cast<int>(p.number("attempts", 3.0));
+        return BehaviorNodePtr(ctx.make<RetryNode>(children[0], std::max(1, attempts)));
+    });
+
+    // 飞行动作
+    // await_ack: true 时等待飞控 COMMAND_ACK，拒绝 / 超时为 Failure
+    r.registerType("arm", BtNodeKind::Leaf, [](const BtNodeParams& p, const auto&, BtBuildContext& ctx) {
+        if (!requireFlight(ctx, "arm")) return BehaviorNodePtr();
+        return BehaviorNodePtr(ctx.make<ArmAction>(*ctx.flight, p.number("await_ack", 0.0) != 0.0));
+    });
+    r.registerType("takeoff", BtNodeKind::Leaf, [](const BtNodeParams& p, const auto&, BtBuildContext& ctx) {
+        if (!requireFlight(ctx, "takeoff")) return BehaviorNodePtr();
+        return BehaviorNodePtr(
+            ctx.make<TakeoffAction>(*ctx.flight, p.number("alt", 10.0), p.number("await_ack", 0.0) != 0.0));
+    });
+    r.registerType("hover", BtNodeKind::Leaf, [](const BtNodeParams& p, const auto&, BtBuildContext& ctx) {
+        const auto seconds = std::chrono::seconds(static_cast<long long>(p.number("seconds", 5.0)));
+        return BehaviorNodePtr(ctx.make<HoverAction>(seconds));
+    });
+    r.registerType("rtl", BtNodeKind::Leaf, [](const BtNodeParams& p, const auto&, BtBuildContext& ctx) {
+        if (!requireFlight(ctx, "rtl")) return BehaviorNodePtr();
+        return BehaviorNodePtr(ctx.make<RtlAction>(*ctx.flight, p.number("await_ack", 0.0) != 0.0));
+    });
+
+    // 黑板条件
+    r.registerType("environment_flag", BtNodeKind::Leaf, [](const BtNodeParams& p, const auto&, BtBuildContext& ctx) {
+        if (!requireBlackboard(ctx, "environment_flag")) return BehaviorNodePtr();
+        const std::string flag = p.text("flag");
+        std::uint32_t mask = 0;
+        if (flag == "gps_denied") mask = perception::kEnvGpsDenied;
+        else if (flag == "low_light") mask = perception::kEnvLowLight;
+        else {
+            ctx.error = "environment_flag: unknown flag '" + flag + "'";
+            return BehaviorNodePtr();
+        }
+        const bool expected = p.number("expect", 1.0) != 0.0;
+        return makeBlackboardCondition<bb::Environment>(
+            ctx.blackboard, [mask, expected](const perception::EnvironmentStatusPacket& e) {
+                return ((e.flags & mask) != 0) == expected;
+            });
+    });
+    r.registerType("altitude_above", BtNodeKind::Leaf, [](const BtNodeParams& p, const auto&, BtBuildContext& ctx) {
+        if (!requireBlackboard(ctx, "altitude_above")) return BehaviorNodePtr();
+        const double alt = p.number("alt", 0.0);
+        return makeBlackboardCondition<bb::FlightState>(
+            ctx.blackboard, [alt](const flight::FlightState& s) { return s.alt >= alt; });
+    });
+
+    // 围栏条件：未越界为 Success，越界状态变化时才重新评估
+    r.registerType("geofence_clear", BtNodeKind::Leaf, [](const BtNodeParams&, const auto&, BtBuildContext& ctx) {
+        if (!ctx.geofence) {
+            ctx.error = "geofence_clear requires a GeofenceMonitorNode";
+            return BehaviorNodePtr();
+        }
+        return makeGeofenceCondition(ctx.geofence);
+    });
+}
+
+} // namespace
+
+const BtParam* BtNodeParams::find(std::string_view key) const noexcept {
+    for (std::size_t i = 0; i < count_; ++i) {
+        if (begin_[i].key == key) return &begin_[i];
+    }
+    return nullptr;
+}
+
+double BtNodeParams::number(std::string_view key, double def) const noexcept {
+    const auto* p = find(key);
+    return p && p->isNumber ? p->number : def;
+}
+
+std::string BtNodeParams::text(std::string_view key, const std::string& def) const {
+    const auto* p = find(key);
+    return p ? p->text : def;
+}
+
+BehaviorNodeRegistry::BehaviorNodeRegistry() {
+    registerBuiltins(*this);
+}
+
+BehaviorNodeRegistry& BehaviorNodeRegistry::instance() {
+    static BehaviorNodeRegistry registry;
+    return registry;
+}
+
+std::string BehaviorNodeRegistry::normalize(std::string_view name) {
+    std::string out;
+    out.reserve(name.size());
+    for (char c : name) {
+        if (c == '_') continue;
+        out.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+    }
+    return out;
+}
+
+void BehaviorNodeRegistry::registerType(const std::string& name, BtNodeKind kind, BtNodeFactory factory) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    types_[normalize(name)] = Entry{kind, std::move(factory)};
+}
+
+bool BehaviorNodeRegistry::lookup(const std::string& name, BtNodeKind& kind, BtNodeFactory& factory) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = types_.find(normalize(name));
+    if (it == types_.end()) return false;
+    kind = it->second.kind;
+    factory = it->second.factory;
+    return true;
+}
+
+std::shared_ptr<const BehaviorTreeDefinition> BehaviorTreeDefinition::compile(const std::string& json,
+                                                                              std::string* error) {
+    auto fail = [error](const std::string& msg) -> std::shared_ptr<const BehaviorTreeDefinition> {
+        if (error) *error = msg;
+        std::cerr << "[BehaviorTreeDefinition] " << msg << std::endl;
+        return nullptr;
+    };
+
+    nlohmann::json root;
+    try {
+        root = nlohmann::json::parse(json);
+    } catch (const nlohmann::json::exception& e) {
+        return fail(std::string("JSON parse error: ") + e.what());
+    }
+
+    auto def = std::make_shared<BehaviorTreeDefinition>();
+    auto& registry = BehaviorNodeRegistry::instance();
+    std::unordered_map<std::string, std::uint32_t> typeIndex;
+
+    // 层序遍历：queue[i] 对应 nodes_[i]，子节点入队时占用连续下标
+    std::vector<const nlohmann::json*> queue{&root};
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        const auto& j = *queue[i];
+        if (!j.is_object() || !j.contains("type") || !j["type"].is_string()) {
+            return fail("node " + std::to_string(i) + ": missing or invalid 'type'");
+        }
+        const std::string typeName = j["type"].get<std::string>();
+        const std::string key = BehaviorNodeRegistry::normalize(typeName);
+
+        NodeDef node;
+        auto it = typeIndex.find(key);
+        if (it == typeIndex.end()) {
+            TypeEntry entry{typeName, BtNodeKind::Leaf, {}};
+            if (!registry.lookup(typeName, entry.kind, entry.factory)) {
+                return fail("unknown node type '" + typeName + "'");
+            }
+            it = typeIndex.emplace(key, static_cast<std::uint32_t>(def->types_.size())).first;
+            def->types_.push_back(std::move(entry));
+        }
+        node.type = it->second;
+
+        node.paramBegin = static_cast<std::uint32_t>(def->params_.size());
+        if (j.contains("params")) {
+            if (!j["params"].is_object()) return fail(typeName + ": 'params' must be an object");
+            for (const auto& [k, v] : j["params"].items()) {
+                BtParam p;
+                p.key = k;
+                if (v.is_number()) {
+                    p.isNumber = true;
+                    p.number = v.get<double>();
+                    p.text = v.dump();
+                } else if (v.is_boolean()) {
+                    p.isNumber = true;
+                    p.number = v.get<bool>() ? 1.0 : 0.0;
+                    p.text = v.get<bool>() ? "true" : "false";
+                } else if (v.is_string()) {
+                    p.text = v.get<std::string>();
+                } else {
+                    return fail(typeName + ": param '" + k + "' must be a scalar");
+                }
+                def->params_.push_back(std::move(p));
+            }
+        }
+        node.paramCount = static_cast<std::uint32_t>(def->params_.size()) - node.paramBegin;
+
+        node.firstChild = static_cast<std::uint32_t>(queue.size());
+        if (j.contains("children")) {
+            if (!j["children"].is_array()) return fail(typeName + ": 'children' must be an array");
+            for (const auto& c : j["children"]) queue.push_back(&c);
+        }
+        node.childCount = static_cast<std::uint32_t>(queue.size()) - node.firstChild;
+        if (queue.size() > kMaxNodes) return fail("tree exceeds " + std::to_string(kMaxNodes) + " nodes");
+
+        const auto kind = def->types_[node.type].kind;
+        if (kind == BtNodeKind::Leaf && node.childCount != 0) return fail(typeName + ": leaf node cannot have children");
+        if (kind == BtNodeKind::Decorator && node.childCount != 1) return fail(typeName + ": decorator needs exactly one child");
+        if (kind == BtNodeKind::Composite && node.childCount == 0) return fail(typeName + ": composite node has no children");
+        def->nodes_.push_back(node);
+    }
+    return def;
+}
+
+BehaviorNodePtr BehaviorTreeDefinition::instantiate(BtBuildContext& ctx) const {
+    // 实例独占的内存池；根节点别名指针持有它，执行器释放根节点时整棵树与内存池一起回收
+    struct Instance {
+        explicit Instance(std::size_t bytes) : arena(bytes) {}
+        std::pmr::monotonic_buffer_resource arena;
+        BehaviorNodePtr root;  // 先于 arena 析构
+    };
+    auto instance = std::make_shared<Instance>(nodes_.size() * kArenaBytesPerNode);
+    ctx.arena_ = &instance->arena;
+    ctx.error.clear();
+
+    // 层序的逆序构造：处理某节点时其子节点均已构造
+    std::vector<BehaviorNodePtr> built(nodes_.size());
+    std::vector<BehaviorNodePtr> children;
+    for (std::size_t i = nodes_.size(); i-- > 0;) {
+        const auto& n = nodes_[i];
+        children.assign(built.begin() + n.firstChild, built.begin() + n.firstChild + n.childCount);
+        const BtNodeParams params(params_.data() + n.paramBegin, n.paramCount);
+        built[i] = types_[n.type].factory(params, children, ctx);
+        if (!built[i]) {
+            if (ctx.error.empty()) ctx.error = types_[n.type].name + ": factory failed";
+            std::cerr << "[BehaviorTreeDefinition] instantiate failed: " << ctx.error << std::endl;
+            ctx.arena_ = std::pmr::get_default_resource();
+            built.clear();
+            children.clear();
+            return nullptr;
+        }
+        // 子节点已由父节点持有
+        for (std::size_t c = n.firstChild; c < n.firstChild + n.childCount; ++c) built[c].reset();
+    }
+    ctx.arena_ = std::pmr::get_default_resource();
+    instance->root = std::move(built[0]);
+    BehaviorNode* root = instance->root.get();
+    return BehaviorNodePtr(instance, root);
+}
+
+} // namespace falconmind::sdk::mission
@@ -0,0 +1,82 @@
+// FalconMindSDK - Blackboard Sink Node Implementation
+#include "falconmind/sdk/mission/BlackboardSinkNode.h"
+#include "falconmind/sdk/core/Pad.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace falconmind::sdk::mission {
+
+BlackboardSinkNode::BlackboardSinkNode(MissionBlackboardPtr board)
+    : core::Node("blackboard_sink"), board_(board ? std::move(board) : std::make_shared<MissionBlackboard>()) {
+    addPad(std::make_shared<core::Pad>("flight_state_in", core::PadType::Sink))
+        ->setDataCallback([this](const void* data, std::size_t size) {
+            if (size < sizeof(flight::FlightState)) {
+                rejected_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            flight::FlightState state;
+            std::memcpy(&state, data, sizeof(state));
+            board_->set<bb::FlightState>(state);
+        });
+    addPad(std::make_shared<core::Pad>("detection_in", core::PadType::Sink))
+        ->setDataCallback([this](const void* data, std::size_t size) { onDetections(data, size); });
+    addPad(std::make_shared<core::Pad>("env_status_in", core::PadType::Sink))
+        ->setDataCallback([this](const void* data, std::size_t size) {
+            if (size < sizeof(perception::EnvironmentStatusPacket)) {
+                rejected_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            perception::EnvironmentStatusPacket status;
+            std::memcpy(&status, data, sizeof(status));
+            board_->set<bb::Environment>(status);
+        });
+}
+
+void BlackboardSinkNode::onDetections(const void* data, std::size_t size) {
+    perception::DetectionResultView view;
+    if (!view.parse(data, size)) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    DetectionSnapshot snap;
+    snap.timestampNs = view.timestampNs();
+    snap.frameIndex = view.frameIndex();
+    snap.total = static_cast<std::uint32_t>(view.size());
+
+    // 下标按得分部分排序，只取前 kMaxItems 条（单帧超过 256 条时只在前 256 条中挑选）
+    std::uint32_t order[256];
+    const std::size_t n = std::min<std::size_t>(view.size(), 256);
+    for (std::size_t i = 0; i < n; ++i) order[i] = static_cast<std::uint32_t>(i);
+    const std::size_t keep = std::min(n, DetectionSnapshot::kMaxItems);
+    std::partial_sort(order, order + keep, order + n,
+                      [&view](std::uint32_t a, std::uint32_t b) { return view.score(a) > view.score(b); });
+
+    for (std::size_t k = 0; k < keep; ++k) {
+        const std::uint32_t i = order[k];
+        const auto box = view.bbox(i);
+        auto& item = snap.items[k];
+        item.x = box.x;
+        item.y = box.y;
+        item.width = box.width;
+        item.height = box.height;
+        item.score = view.score(i);
+        item.classId = view.classId(i);
+        item.trackId = view.trackId(i);
+    }
+    snap.count = static_cast<std::uint32_t>(keep);
+    board_->set<bb::Detections>(snap);
+}
+
+void attachFlightStateToBlackboard(flight::FlightConnectionService& svc, MissionBlackboardPtr board) {
+    if (!board) {
+        svc.setStateListener(nullptr);
+        return;
+    }
+    svc.setStateListener([board = std::move(board)](const flight::FlightState& state) {
+        board->set<bb::FlightState>(state);
+    });
+}
+
+} // namespace falconmind::sdk::mission
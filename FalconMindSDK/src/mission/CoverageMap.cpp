@@ -0,0 +1,261 @@
+// FalconMindSDK - Coverage map
+#include "falconmind/sdk/mission/CoverageMap.h"
+#include "falconmind/sdk/core/StateCheckpoint.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace falconmind::sdk::mission {
+
+namespace {
+
+// [a, b] 位为 1 的掩码（0 <= a <= b <= 63）
+inline std::uint64_t bitRange(int a, int b) noexcept {
+    const std::uint64_t hi = b >= 63 ? ~0ull : ((1ull << (b + 1)) - 1);
+    return hi & ~((1ull << a) - 1);
+}
+
+inline int popcount64(std::uint64_t v) noexcept {
+    return __builtin_popcountll(v);
+}
+
+} // namespace
+
+CoverageMap::CoverageMap(const std::vector<std::vector<PlanarPoint>>& rings, double cellSize)
+    : cell_(cellSize > 0.0 ? cellSize : 1.0) {
+    for (const auto& r : rings) {
+        if (r.size() >= 3) rings_.push_back(r);
+    }
+    if (rings_.empty()) return;
+    double maxX = std::numeric_limits<double>::lowest(), maxY = maxX;
+    minX_ = minY_ = std::numeric_limits<double>::max();
+    for (const auto& p : rings_[0]) {
+        minX_ = std::min(minX_, p.x);
+        minY_ = std::min(minY_, p.y);
+        maxX = std::max(maxX, p.x);
+        maxY = std::max(maxY, p.y);
+    }
+    cols_ = std::max(1, static_cast<int>(std::ceil((maxX - minX_) / cell_)));
+    rows_ = std::max(1, static_cast<int>(std::ceil((maxY - minY_) / cell_)));
+    tilesX_ = (cols_ + kTileBits - 1) / kTileBits;
+    tilesY_ = (rows_ + kTileBits - 1) / kTileBits;
+    const std::size_t tileCount = static_cast<std::size_t>(tilesX_) * tilesY_;
+    tileArea_.assign(tileCount, 0);
+    tileCovered_.assign(tileCount, 0);
+    tiles_.resize(tileCount);
+
+    // 逐行扫描线求区域内单元数，按块累计
+    for (int cy = 0; cy < rows_; ++cy) {
+        rowIntersections(cy, xs_);
+        const std::size_t rowTile = static_cast<std::size_t>(cy / kTileBits) * tilesX_;
+        for (std::size_t i = 0; i + 1 < xs_.size(); i += 2) {
+            const int c0 = std::max(0, static_cast<int>(std::ceil((xs_[i] - minX_) / cell_ - 0.5)));
+            const int c1 = std::min(cols_ - 1, static_cast<int>(std::floor((xs_[i + 1] - minX_) / cell_ - 0.5)));
+            for (int c = c0; c <= c1;) {
+                const int tx = c / kTileBits;
+                const int end = std::min(c1, tx * kTileBits + kTileBits - 1);
+                tileArea_[rowTile + tx] = static_cast<std::uint16_t>(tileArea_[rowTile + tx] + (end - c + 1));
+                areaCells_ += static_cast<std::uint64_t>(end - c + 1);
+                c = end + 1;
+            }
+        }
+    }
+}
+
+CoverageMap::~CoverageMap() = default;
+
+void CoverageMap::rowIntersections(int cy, std::vector<double>& xs) const {
+    xs.clear();
+    const double y = minY_ + (cy + 0.5) * cell_;
+    for (const auto& ring : rings_) {
+        for (std::size_t i = 0, n = ring.size(); i < n; ++i) {
+            const PlanarPoint& a = ring[i];
+            const PlanarPoint& b = ring[(i + 1) % n];
+            if ((a.y > y) != (b.y > y)) xs.push_back(a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y));
+        }
+    }
+    std::sort(xs.begin(), xs.end());
+}
+
+void CoverageMap::buildMask(int tx, int ty, std::uint64_t* mask) const {
+    std::vector<double> xs;
+    const int base = tx * kTileBits;
+    for (int r = 0; r < kTileBits; ++r) {
+        mask[r] = 0;
+        const int cy = ty * kTileBits + r;
+        if (cy >= rows_) continue;
+        rowIntersections(cy, xs);
+        for (std::size_t i = 0; i + 1 < xs.size(); i += 2) {
+            const int c0 = std::max(base, static_cast<int>(std::ceil((xs[i] - minX_) / cell_ - 0.5)));
+            const int c1 = std::min({cols_ - 1, base + kTileBits - 1,
+                                     static_cast<int>(std::floor((xs[i + 1] - minX_) / cell_ - 0.5))});
+            if (c0 <= c1) mask[r] |= bitRange(c0 - base, c1 - base);
+        }
+    }
+}
+
+CoverageMap::Tile* CoverageMap::tileAt(int tx, int ty) {
+    auto& tile = tiles_[static_cast<std::size_t>(ty) * tilesX_ + tx];
+    if (!tile) {
+        tile = std::make_unique<Tile>();
+        buildMask(tx, ty, tile->mask);
+        std::fill(std::begin(tile->covered), std::end(tile->covered), 0ull);
+        ++allocatedTiles_;
+    }
+    return tile.get();
+}
+
+std::uint64_t CoverageMap::markPolygon(const PlanarPoint* vertices, std::size_t count) {
+    if (count < 3 || areaCells_ == 0) return 0;
+    double lo = vertices[0].y, hi = lo;
+    for (std::size_t i = 1; i < count; ++i) {
+        lo = std::min(lo, vertices[i].y);
+        hi = std::max(hi, vertices[i].y);
+    }
+    const int cy0 = std::max(0, static_cast<int>(std::ceil((lo - minY_) / cell_ - 0.5)));
+    const int cy1 = std::min(rows_ - 1, static_cast<int>(std::floor((hi - minY_) / cell_ - 0.5)));
+    std::uint64_t added = 0;
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        // 凸多边形与水平线的交集为一个区间
+        const double y = minY_ + (cy + 0.5) * cell_;
+        double x0 = std::numeric_limits<double>::max(), x1 = std::numeric_limits<double>::lowest();
+        for (std::size_t i = 0; i < count; ++i) {
+            const PlanarPoint& a = vertices[i];
+            const PlanarPoint& b = vertices[(i + 1) % count];
+            if ((a.y > y) == (b.y > y)) continue;
+            const double x = a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+            x0 = std::min(x0, x);
+            x1 = std::max(x1, x);
+        }
+        if (x0 > x1) continue;
+        const int c0 = std::max(0, static_cast<int>(std::ceil((x0 - minX_) / cell_ - 0.5)));
+        const int c1 = std::min(cols_ - 1, static_cast<int>(std::floor((x1 - minX_) / cell_ - 0.5)));
+        const int ty = cy / kTileBits;
+        const int r = cy % kTileBits;
+        for (int c = c0; c <= c1;) {
+            const int tx = c / kTileBits;
+            const int end = std::min(c1, tx * kTileBits + kTileBits - 1);
+            const std::size_t idx = static_cast<std::size_t>(ty) * tilesX_ + tx;
+            if (tileArea_[idx] != 0 && tileCovered_[idx] != tileArea_[idx]) {
+                Tile* tile = tileAt(tx, ty);
+                const std::uint64_t bits =
+                    bitRange(c - tx * kTileBits, end - tx * kTileBits) & tile->mask[r] & ~tile->covered[r];
+                if (bits) {
+                    tile->covered[r] |= bits;
+                    const int n = popcount64(bits);
+                    tileCovered_[idx] = static_cast<std::uint16_t>(tileCovered_[idx] + n);
+                    added += static_cast<std::uint64_t>(n);
+                    // 整块覆盖完：只保留计数
+                    if (tileCovered_[idx] == tileArea_[idx]) {
+                        tiles_[idx].reset();
+                        --allocatedTiles_;
+                    }
+                }
+            }
+            c = end + 1;
+        }
+    }
+    coveredCells_ += added;
+    return added;
+}
+
+bool CoverageMap::isCovered(const PlanarPoint& p) const noexcept {
+    const int cx = static_cast<int>(std::floor((p.x - minX_) / cell_));
+    const int cy = static_cast<int>(std::floor((p.y - minY_) / cell_));
+    if (cx < 0 || cy < 0 || cx >= cols_ || cy >= rows_) return false;
+    const std::size_t idx = static_cast<std::size_t>(cy / kTileBits) * tilesX_ + cx / kTileBits;
+    const std::uint64_t bit = 1ull << (cx % kTileBits);
+    if (const Tile* tile = tiles_[idx].get()) return (tile->covered[cy % kTileBits] & bit) != 0;
+    if (tileArea_[idx] == 0 || tileCovered_[idx] != tileArea_[idx]) return false;
+    // 已完成的块：单元在区域内即已覆盖
+    std::uint64_t mask[kTileBits];
+    buildMask(cx / kTileBits, cy / kTileBits, mask);
+    return (mask[cy % kTileBits] & bit) != 0;
+}
+
+std::size_t CoverageMap::uncoveredCells(std::vector<PlanarPoint>& out, std::size_t maxCount) const {
+    std::size_t written = 0;
+    std::uint64_t mask[kTileBits];
+    for (int ty = 0; ty < tilesY_ && written < maxCount; ++ty) {
+        for (int tx = 0; tx < tilesX_ && written < maxCount; ++tx) {
+            const std::size_t idx = static_cast<std::size_t>(ty) * tilesX_ + tx;
+            if (tileArea_[idx] == 0 || tileCovered_[idx] == tileArea_[idx]) continue;
+            const Tile* tile = tiles_[idx].get();
+            if (!tile) buildMask(tx, ty, mask);
+            for (int r = 0; r < kTileBits && written < maxCount; ++r) {
+                std::uint64_t bits = tile ? (tile->mask[r] & ~tile->covered[r]) : mask[r];
+                while (bits && written < maxCount) {
+                    const int b = __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    out.push_back({minX_ + (tx * kTileBits + b + 0.5) * cell_, minY_ + (ty * kTileBits + r + 0.5) * cell_});
+                    ++written;
+                }
+            }
+        }
+    }
+    return written;
+}
+
+void CoverageMap::clear() {
+    for (auto& t : tiles_) t.reset();
+    std::fill(tileCovered_.begin(), tileCovered_.end(), 0);
+    allocatedTiles_ = 0;
+    coveredCells_ = 0;
+}
+
+void CoverageMap::saveState(core::CheckpointWriter& out) const {
+    out.pod(static_cast<std::int32_t>(cols_));
+    out.pod(static_cast<std::int32_t>(rows_));
+    out.pod(cell_);
+    out.pod(coveredCells_);
+    out.bytes(tileCovered_.data(), tileCovered_.size() * sizeof(std::uint16_t));
+    out.pod(static_cast<std::uint32_t>(allocatedTiles_));
+    for (std::size_t idx = 0; idx < tiles_.size(); ++idx) {
+        if (!tiles_[idx]) continue;
+        out.pod(static_cast<std::uint32_t>(idx));
+        out.bytes(tiles_[idx]->covered, sizeof(tiles_[idx]->covered));
+    }
+}
+
+bool CoverageMap::restoreState(core::CheckpointReader& in) {
+    std::int32_t cols = 0, rows = 0;
+    double cell = 0.0;
+    std::uint64_t covered = 0;
+    if (!in.pod(cols) || !in.pod(rows) || !in.pod(cell) || !in.pod(covered)) return false;
+    if (cols != cols_ || rows != rows_ || cell != cell_) return false;
+    std::vector<std::uint16_t> tileCovered(tileCovered_.size());
+    std::uint32_t allocated = 0;
+    if (!in.bytes(tileCovered.data(), tileCovered.size() * sizeof(std::uint16_t)) || !in.pod(allocated)) return false;
+    std::vector<std::pair<std::uint32_t, std::unique_ptr<Tile>>> partial;
+    for (std::uint32_t k = 0; k < allocated; ++k) {
+        std::uint32_t idx = 0;
+        auto tile = std::make_unique<Tile>();
+        if (!in.pod(idx) || idx >= tiles_.size() || !in.bytes(tile->covered, sizeof(tile->covered))) return false;
+        buildMask(static_cast<int>(idx % static_cast<std::uint32_t>(tilesX_)),
+                  static_cast<int>(idx / static_cast<std::uint32_t>(tilesX_)), tile->mask);
+        partial.emplace_back(idx, std::move(tile));
+    }
+    clear();
+    tileCovered_ = std::move(tileCovered);
+    coveredCells_ = covered;
+    for (auto& [idx, tile] : partial) tiles_[idx] = std::move(tile);
+    allocatedTiles_ = partial.size();
+    return true;
+}
+
+std::array<PlanarPoint, 4> nadirFootprint(const PlanarPoint& center, double heightAgl, double yawRad,
+                                          double hfovRad, double vfovRad) {
+    const double halfW = heightAgl * std::tan(hfovRad / 2.0);  // 横向
+    const double halfL = heightAgl * std::tan(vfovRad / 2.0);  // 前向
+    // 航向自北顺时针：前向单位向量 (sin, cos)，右向 (cos, -sin)
+    const double fx = std::sin(yawRad), fy = std::cos(yawRad);
+    const double rx = fy, ry = -fx;
+    return {{{center.x - rx * halfW - fx * halfL, center.y - ry * halfW - fy * halfL},
+             {center.x + rx * halfW - fx * halfL, center.y + ry * halfW - fy * halfL},
+             {center.x + rx * halfW + fx * halfL, center.y + ry * halfW + fy * halfL},
+             {center.x - rx * halfW + fx * halfL, center.y - ry * halfW + fy * halfL}}};
+}
+
+} // namespace falconmind::sdk::mission
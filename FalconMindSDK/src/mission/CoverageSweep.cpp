@@ -0,0 +1,90 @@
+// FalconMindSDK - Coverage sweep geometry
+#include "falconmind/sdk/mission/CoverageSweep.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace falconmind::sdk::mission {
+
+std::vector<SweepSegment> sweepSegments(const std::vector<std::vector<PlanarPoint>>& rings, double spacing,
+                                        double angleRad) {
+    std::vector<SweepSegment> segments;
+    if (rings.empty() || rings[0].size() < 3 || !(spacing > 0.0)) {
+        return segments;
+    }
+
+    // 旋转到扫描线为水平方向的坐标系：u 沿扫描线，v 垂直于扫描线
+    const double c = std::cos(angleRad);
+    const double s = std::sin(angleRad);
+    struct Edge {
+        double v0, v1;  // v0 < v1
+        double u0;      // v0 处的 u
+        double dudv;
+    };
+    std::vector<Edge> edges;
+    double minV = std::numeric_limits<double>::max();
+    double maxV = std::numeric_limits<double>::lowest();
+    for (const auto& ring : rings) {
+        if (ring.size() < 3) continue;
+        for (std::size_t i = 0; i < ring.size(); ++i) {
+            const PlanarPoint& a = ring[i];
+            const PlanarPoint& b = ring[(i + 1) % ring.size()];
+            const double ua = a.x * c + a.y * s, va = -a.x * s + a.y * c;
+            const double ub = b.x * c + b.y * s, vb = -b.x * s + b.y * c;
+            minV = std::min(minV, va);
+            maxV = std::max(maxV, va);
+            if (va == vb) continue;  // 与扫描线平行的边不产生交点
+            if (va < vb) edges.push_back({va, vb, ua, (ub - ua) / (vb - va)});
+            else edges.push_back({vb, va, ub, (ua - ub) / (va - vb)});
+        }
+    }
+    if (edges.empty()) return segments;
+
+    std::vector<double> xs;
+    const int rows = static_cast<int>(std::ceil((maxV - minV) / spacing - 0.5));
+    for (int row = 0; row < std::max(rows, 1); ++row) {
+        // 区域窄于一个间距时取中线
+        const double v = rows > 0 ? minV + spacing * (row + 0.5) : (minV + maxV) * 0.5;
+        xs.clear();
+        for (const Edge& e : edges) {
+            // 半开区间 [v0, v1)：经过顶点的扫描线对相邻两边只计一次
+            if (v >= e.v0 && v < e.v1) xs.push_back(e.u0 + (v - e.v0) * e.dudv);
+        }
+        std::sort(xs.begin(), xs.end());
+        for (std::size_t i = 0; i + 1 < xs.size(); i += 2) {
+            const double u0 = xs[i], u1 = xs[i + 1];
+            segments.push_back({{u0 * c - v * s, u0 * s + v * c}, {u1 * c - v * s, u1 * s + v * c}, row});
+        }
+    }
+    return segments;
+}
+
+std::vector<PlanarPoint> lawnMowerPath(const std::vector<std::vector<PlanarPoint>>& rings, double spacing,
+                                       double angleRad) {
+    const std::vector<SweepSegment> segments = sweepSegments(rings, spacing, angleRad);
+    std::vector<PlanarPoint> path;
+    path.reserve(segments.size() * 2);
+    std::size_t begin = 0;
+    bool forward = true;
+    while (begin < segments.size()) {
+        std::size_t end = begin;
+        while (end < segments.size() && segments[end].row == segments[begin].row) ++end;
+        if (forward) {
+            for (std::size_t i = begin; i < end; ++i) {
+                path.push_back(segments[i].from);
+                path.push_back(segments[i].to);
+            }
+        } else {
+            for (std::size_t i = end; i > begin; --i) {
+                path.push_back(segments[i - 1].to);
+                path.push_back(segments[i - 1].from);
+            }
+        }
+        forward = !forward;
+        begin = end;
+    }
+    return path;
+}
+
+} // namespace falconmind::sdk::mission
@@ -0,0 +1,234 @@
+#include "falconmind/sdk/mission/EventAggregator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace falconmind::sdk::mission {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+// 与 GeoProjector 相同的球半径（6371 km）下每度弧长
+constexpr double kMetersPerDeg = 6371000.0 * kPi / 180.0;
+constexpr int kMaxBits = 31;
+constexpr std::int64_t kMaxLonCells = 64;  // 极区经向格很窄，限制搜索范围
+
+std::uint32_t quantize(double v, double lo, double span, int bits) noexcept {
+    const double cells = std::ldexp(1.0, bits);
+    const double q = std::floor((v - lo) / span * cells);
+    return static_cast<std::uint32_t>(std::clamp(q, 0.0, cells - 1.0));
+}
+
+std::uint64_t interleave(std::uint32_t ix, std::uint32_t iy, int bits) noexcept {
+    std::uint64_t h = 0;
+    for (int i = bits - 1; i >= 0; --i) {
+        h = (h << 1) | ((ix >> i) & 1u);
+        h = (h << 1) | ((iy >> i) & 1u);
+    }
+    return h;
+}
+
+double distanceM(double lat1, double lon1, double lat2, double lon2) noexcept {
+    const double dn = (lat1 - lat2) * kMetersPerDeg;
+    const double de = (lon1 - lon2) * kMetersPerDeg * std::cos((lat1 + lat2) * 0.5 * kPi / 180.0);
+    return std::sqrt(dn * dn + de * de);
+}
+
+} // namespace
+
+EventAggregator::EventAggregator(const EventAggregatorConfig& cfg) : cfg_(cfg) {
+    if (!(cfg_.radiusM > 0.)) cfg_.radiusM = 1.0;
+    // 纬向格高 180°/2^bits 不小于 radiusM：同一目标的观测最多落在相邻格
+    bits_ = std::clamp(static_cast<int>(std::floor(std::log2(180.0 * kMetersPerDeg / cfg_.radiusM))), 1, kMaxBits);
+    cellDeg_ = 180.0 / std::ldexp(1.0, bits_);
+}
+
+std::uint64_t EventAggregator::geohash(double lat, double lon, int bitsPerAxis) noexcept {
+    bitsPerAxis = std::clamp(bitsPerAxis, 1, kMaxBits);
+    return interleave(quantize(lon, -180.0, 360.0, bitsPerAxis), quantize(lat, -90.0, 180.0, bitsPerAxis), bitsPerAxis);
+}
+
+std::uint64_t EventAggregator::cellOf(double lat, double lon) const noexcept {
+    return geohash(lat, lon, bits_);
+}
+
+void EventAggregator::index(Target& t) {
+    t.cell = cellOf(t.lastLat, t.lastLon);
+    cells_.emplace(t.cell, t.info.targetId);
+}
+
+void EventAggregator::unindex(const Target& t) {
+    auto range = cells_.equal_range(t.cell);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == t.info.targetId) {
+            cells_.erase(it);
+            return;
+        }
+    }
+}
+
+void EventAggregator::erase(std::uint64_t targetId) {
+    auto it = targets_.find(targetId);
+    if (it == targets_.end()) return;
+    unindex(it->second);
+    for (int track : it->second.info.trackIds) {
+        auto bound = byTrack_.find(track);
+        if (bound != byTrack_.end() && bound->second == targetId) byTrack_.erase(bound);
+    }
+    targets_.erase(it);
+}
+
+void EventAggregator::evictOldest() {
+    auto oldest = std::min_element(targets_.begin(), targets_.end(), [](const auto& a, const auto& b) {
+        return a.second.info.lastSeenNs < b.second.info.lastSeenNs;
+    });
+    if (oldest != targets_.end()) erase(oldest->first);
+}
+
+EventAggregator::Target* EventAggregator::findNearby(const DetectionSighting& s) {
+    const std::uint32_t ix = quantize(s.lon, -180.0, 360.0, bits_);
+    const std::uint32_t iy = quantize(s.lat, -90.0, 180.0, bits_);
+    const std::uint32_t mask = static_cast<std::uint32_t>((std::uint64_t{1} << bits_) - 1);
+    // 经向格宽 2 × cellDeg_ × cos(lat)：高纬度时多搜几列
+    const double lonCellM = 2.0 * cellDeg_ * kMetersPerDeg * std::max(1e-3, std::cos(s.lat * kPi / 180.0));
+    const std::int64_t nx = std::min<std::int64_t>(kMaxLonCells, static_cast<std::int64_t>(std::ceil(cfg_.radiusM / lonCellM)));
+
+    Target* best = nullptr;
+    double bestDist = cfg_.radiusM;
+    for (std::int64_t dy = -1; dy <= 1; ++dy) {
+        const std::int64_t y = static_cast<std::int64_t>(iy) + dy;
+        if (y < 0 || y > static_cast<std::int64_t>(mask)) continue;
+        for (std::int64_t dx = -nx; dx <= nx; ++dx) {
+            // 经度跨 ±180° 时回绕
+            const auto x = static_cast<std::uint32_t>(static_cast<std::int64_t>(ix) + dx) & mask;
+            auto range = cells_.equal_range(interleave(x, static_cast<std::uint32_t>(y), bits_));
+            for (auto it = range.first; it != range.second; ++it) {
+                Target& t = targets_.at(it->second);
+                if (t.info.className != s.className || s.timestampNs - t.info.lastSeenNs > cfg_.windowNs) continue;
+                const double d = distanceM(s.lat, s.lon, t.lastLat, t.lastLon);
+                if (d <= bestDist) {
+                    bestDist = d;
+                    best = &t;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+EventAggregator::Decision EventAggregator::add(const DetectionSighting& s, const EmitFn& emit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.sightings;
+
+    Target* t = nullptr;
+    if (s.trackId >= 0) {
+        auto bound = byTrack_.find(s.trackId);
+        if (bound != byTrack_.end()) {
+            Target& candidate = targets_.at(bound->second);
+            if (s.timestampNs - candidate.info.lastSeenNs <= cfg_.windowNs) t = &candidate;
+        }
+    }
+    if (!t) t = findNearby(s);
+
+    if (!t) {
+        if (targets_.size() >= cfg_.maxTargets) evictOldest();
+        const std::uint64_t id = nextId_++;
+        Target& created = targets_[id];
+        created.info.targetId = id;
+        created.info.className = s.className;
+        created.info.lat = s.lat;
+        created.info.lon = s.lon;
+        created.info.alt = s.alt;
+        created.info.bestConfidence = s.confidence;
+        created.info.firstSeenNs = s.timestampNs;
+        created.info.lastSeenNs = s.timestampNs;
+        created.info.sightings = 1;
+        if (s.trackId >= 0) {
+            created.info.trackIds.push_back(s.trackId);
+            byTrack_[s.trackId] = id;
+        }
+        created.lastLat = s.lat;
+        created.lastLon = s.lon;
+        created.lastEmitNs = s.timestampNs;
+        index(created);
+        ++stats_.newTargets;
+        if (emit) emit(created.info, Decision::NewTarget);
+        return Decision::NewTarget;
+    }
+
+    AggregatedTarget& info = t->info;
+    info.lastSeenNs = std::max(info.lastSeenNs, s.timestampNs);
+    ++info.sightings;
+    t->lastLat = s.lat;
+    t->lastLon = s.lon;
+    if (cellOf(s.lat, s.lon) != t->cell) {
+        unindex(*t);
+        index(*t);
+    }
+    if (s.trackId >= 0) {
+        auto& bound = byTrack_[s.trackId];
+        if (bound != info.targetId) {
+            bound = info.targetId;
+            if (std::find(info.trackIds.begin(), info.trackIds.end(), s.trackId) == info.trackIds.end()) {
+                info.trackIds.push_back(s.trackId);
+            }
+        }
+    }
+    if (s.confidence >= info.bestConfidence + cfg_.updateMargin) {
+        info.bestConfidence = s.confidence;
+        info.lat = s.lat;
+        info.lon = s.lon;
+        info.alt = s.alt;
+        t->pendingUpdate = true;
+    }
+    if (t->pendingUpdate && s.timestampNs - t->lastEmitNs >= cfg_.minUpdateIntervalNs) {
+        t->pendingUpdate = false;
+        t->lastEmitNs = s.timestampNs;
+        ++stats_.updates;
+        if (emit) emit(info, Decision::Updated);
+        return Decision::Updated;
+    }
+    ++stats_.suppressed;
+    return Decision::Suppressed;
+}
+
+void EventAggregator::expire(std::int64_t nowNs, const EmitFn& emit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::uint64_t> stale;
+    for (const auto& [id, t] : targets_) {
+        if (nowNs - t.info.lastSeenNs > cfg_.windowNs) stale.push_back(id);
+    }
+    for (std::uint64_t id : stale) {
+        const Target& t = targets_.at(id);
+        if (t.pendingUpdate) {
+            ++stats_.updates;
+            if (emit) emit(t.info, Decision::Updated);
+        }
+        erase(id);
+        ++stats_.expired;
+    }
+}
+
+void EventAggregator::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    targets_.clear();
+    cells_.clear();
+    byTrack_.clear();
+}
+
+std::size_t EventAggregator::targetCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return targets_.size();
+}
+
+std::size_t EventAggregator::trackCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return byTrack_.size();
+}
+
+EventAggregatorStats EventAggregator::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace falconmind::sdk::mission
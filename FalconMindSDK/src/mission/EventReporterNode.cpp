@@ -1,22 +1,39 @@
 // FalconMindSDK - Event Reporter Node Implementation
 #include "falconmind/sdk/mission/EventReporterNode.h"
+#include "falconmind/sdk/cluster/SwarmState.h"
 #include "falconmind/sdk/core/Pad.h"
 #include "falconmind/sdk/core/Caps.h"
+#include "falconmind/sdk/core/PipelineClock.h"
 #include "falconmind/sdk/telemetry/TelemetryPublisher.h"
 
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include <sstream>
 #include <unordered_map>
+#include <vector>
 
 namespace falconmind::sdk::mission {
 
+namespace {
+
+std::int64_t systemTimeNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
 EventReporterNode::EventReporterNode() : core::Node("event_reporter") {
     // 添加输入端口：接收事件数据（使用 Sink 类型表示输入）
-    addPad(std::make_shared<core::Pad>("events", core::PadType::Sink));
+    addPad(std::make_shared<core::Pad>("events", core::PadType::Sink))
+        ->setDataCallback([this](const void* data, std::size_t size) { onSightingRecords(data, size); });
     
     // 默认 UAV ID 和 Mission ID
     uavId_ = "uav_001";
     missionId_ = "mission_unknown";
+    aggregator_ = std::make_unique<EventAggregator>();
 }
 
 bool EventReporterNode::configure(const std::unordered_map<std::string, std::string>& params) {
@@ -27,6 +44,51 @@ bool EventReporterNode::configure(const std::unordered_map<std::string, std::str
     }
     if (params.find("mission_id") != params.end()) {
         missionId_ = params.at("mission_id");
+        aggregator_->reset();
+        if (thumbnailer_) thumbnailer_->reset();
+    }
+    // event_radius_m / event_window_s / event_update_interval_s：目标聚合参数（清空已有目标）
+    auto radius = params.find("event_radius_m");
+    auto window = params.find("event_window_s");
+    auto interval = params.find("event_update_interval_s");
+    if (radius != params.end() || window != params.end() || interval != params.end()) {
+        EventAggregatorConfig cfg = aggregator_->config();
+        if (radius != params.end()) cfg.radiusM = std::strtod(radius->second.c_str(), nullptr);
+        if (window != params.end()) {
+            cfg.windowNs = static_cast<std::int64_t>(std::strtod(window->second.c_str(), nullptr) * 1e9);
+        }
+        if (interval != params.end()) {
+            cfg.minUpdateIntervalNs = static_cast<std::int64_t>(std::strtod(interval->second.c_str(), nullptr) * 1e9);
+        }
+        setAggregatorConfig(cfg);
+    }
+    // swarm_dedup：true 时使用 SwarmStateRegistry 的集群目标表抑制其他 UAV 已认领的目标，false 关闭
+    auto dedup = params.find("swarm_dedup");
+    if (dedup != params.end()) {
+        if (dedup->second == "true" || dedup->second == "1") {
+            targets_ = cluster::SwarmStateRegistry::instance().targetRegistry();
+        } else {
+            targets_.reset();
+        }
+    }
+    // thumbnail_encoder：auto/mpp/nvjpeg/turbo 启用事件缩略图，off 关闭；thumbnail_max_bytes 为单张上限
+    auto encoder = params.find("thumbnail_encoder");
+    if (encoder != params.end()) {
+        sensors::JpegEncoderType type = sensors::JpegEncoderType::Auto;
+        if (encoder->second == "off") {
+            thumbnailer_.reset();
+        } else if (sensors::parseJpegEncoder(encoder->second, type)) {
+            EventThumbnailConfig cfg;
+            auto maxBytes = params.find("thumbnail_max_bytes");
+            if (maxBytes != params.end()) {
+                const unsigned long v = std::strtoul(maxBytes->second.c_str(), nullptr, 10);
+                if (v > 0) cfg.maxBytes = v;
+            }
+            thumbnailer_ = std::make_shared<EventThumbnailer>(cfg, sensors::createJpegEncoder(type));
+        } else {
+            std::cerr << "[EventReporter] unknown thumbnail_encoder: " << encoder->second << std::endl;
+            return false;
+        }
     }
     return true;
 }
@@ -41,8 +103,28 @@ void EventReporterNode::stop() {
 }
 
 void EventReporterNode::process() {
-    // process 方法可以处理来自输入端口的事件数据
-    // 当前实现主要通过直接调用 reportSearchEvent 等方法
+    // 观测经 events Pad 回调或 report* 直接聚合；这里过期长时间未再观测到的目标，
+    // 并补发被最小间隔压住的置信度提升
+    std::vector<SearchEvent> pending;
+    const std::int64_t nowNs = core::PipelineClock::nowNs();
+    aggregator_->expire(nowNs, [&](const AggregatedTarget& target, EventAggregator::Decision) {
+        if (targets_ && !targets_->peerOwner(target.lat, target.lon, target.className, nowNs).empty()) {
+            swarmSuppressed_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        SearchEvent event;
+        event.type = SearchEventType::TARGET_UPDATED;
+        event.description = "Target updated: " + target.className +
+                            " (confidence: " + std::to_string(target.bestConfidence) + ")";
+        event.position = {target.lat, target.lon, target.alt};
+        event.timestampNs = systemTimeNs();
+        std::stringstream metadata;
+        metadata << "{\"class\":\"" << target.className << "\",\"confidence\":" << target.bestConfidence
+                 << ",\"target_id\":" << target.targetId << ",\"sightings\":" << target.sightings << "}";
+        event.metadata = metadata.str();
+        pending.push_back(std::move(event));
+    });
+    for (const auto& event : pending) reportSearchEvent(event);
 }
 
 void EventReporterNode::reportSearchEvent(const SearchEvent& event) {
@@ -58,6 +140,7 @@ void EventReporterNode::reportSearchEvent(const SearchEvent& event) {
     // TODO: 通过 TelemetryPublisher 或 Bus 发布事件
     // 当前先输出日志
     // TelemetryPublisher::instance().publish(...);
+    if (sink_) sink_(event);
 }
 
 void EventReporterNode::reportSearchProgress(const SearchProgress& progress) {
@@ -68,23 +151,160 @@ void EventReporterNode::reportSearchProgress(const SearchProgress& progress) {
     // TODO: 通过 TelemetryPublisher 发布进度
 }
 
-void EventReporterNode::reportDetection(const std::string& targetClass, double confidence,
-                                        double lat, double lon, double alt) {
+void EventReporterNode::attachThumbnail(SearchEvent& event, const sensors::ImageSurface& frame,
+                                        const perception::DetectionBBox& box, int trackId, float score) {
+    EventThumbnail thumb;
+    if (!thumbnailer_ || !thumbnailer_->make(frame, box, trackId, score, core::PipelineClock::nowNs(), thumb)) return;
+    if (!event.metadata.empty() && event.metadata.back() == '}') {
+        event.metadata.pop_back();
+        std::stringstream extra;
+        extra << ",\"thumbnail\":{\"width\":" << thumb.width << ",\"height\":" << thumb.height
+              << ",\"bytes\":" << thumb.jpeg.size() << "}}";
+        event.metadata += extra.str();
+    }
+    event.thumbnailJpeg = std::move(thumb.jpeg);
+}
+
+void EventReporterNode::reportSighting(const DetectionSighting& sighting, std::int64_t eventTimeNs,
+                                       const std::string& extraJson, const sensors::ImageSurface* frame,
+                                       const perception::DetectionBBox* box) {
+    // 其他 UAV 已认领的目标照常在本机聚合（保持轨迹与目标的绑定），只是不上报；否则登记 / 刷新本机认领
+    bool peerClaimed = false;
+    if (targets_) {
+        const std::int64_t nowNs = core::PipelineClock::nowNs();
+        peerClaimed = !targets_->peerOwner(sighting.lat, sighting.lon, sighting.className, nowNs).empty();
+        if (!peerClaimed) {
+            targets_->claimLocal(sighting.lat, sighting.lon, sighting.className, sighting.confidence, nowNs);
+        }
+    }
+    // emit 在聚合器锁内调用：只构造事件，缩略图与上报在锁外进行
     SearchEvent event;
-    event.type = SearchEventType::TARGET_DETECTED;
-    event.description = "Target detected: " + targetClass + " (confidence: " + 
-                       std::to_string(confidence) + ")";
-    event.position = {lat, lon, alt};
-    
-    auto now = std::chrono::system_clock::now();
-    auto duration = now.time_since_epoch();
-    event.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
-    
-    std::stringstream metadata;
-    metadata << "{\"class\":\"" << targetClass << "\",\"confidence\":" << confidence << "}";
-    event.metadata = metadata.str();
-    
+    bool produced = false;
+    aggregator_->add(sighting, [&](const AggregatedTarget& target, EventAggregator::Decision decision) {
+        const bool fresh = decision == EventAggregator::Decision::NewTarget;
+        event.type = fresh ? SearchEventType::TARGET_DETECTED : SearchEventType::TARGET_UPDATED;
+        event.description = std::string(fresh ? "Target detected: " : "Target updated: ") + target.className +
+                            " (confidence: " + std::to_string(target.bestConfidence) + ")";
+        event.position = {target.lat, target.lon, target.alt};
+        event.timestampNs = eventTimeNs;
+
+        std::stringstream metadata;
+        metadata << "{\"class\":\"" << target.className << "\",\"confidence\":" << target.bestConfidence
+                 << ",\"target_id\":" << target.targetId << ",\"sightings\":" << target.sightings;
+        if (sighting.trackId >= 0) metadata << ",\"track_id\":" << sighting.trackId;
+        metadata << extraJson << "}";
+        event.metadata = metadata.str();
+        produced = true;
+    });
+    if (!produced) return;
+    if (peerClaimed) {
+        swarmSuppressed_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (frame && box) attachThumbnail(event, *frame, *box, sighting.trackId, sighting.confidence);
     reportSearchEvent(event);
 }
 
+void EventReporterNode::onSightingRecords(const void* data, std::size_t size) {
+    DetectionSightingPacketHeader header;
+    if (size < sizeof(header)) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kDetectionSightingMagic ||
+        size < sizeof(header) + static_cast<std::size_t>(header.count) * sizeof(DetectionSightingRecord)) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const auto* records = static_cast<const std::uint8_t*>(data) + sizeof(header);
+    for (std::uint32_t i = 0; i < header.count; ++i) {
+        DetectionSightingRecord rec;
+        std::memcpy(&rec, records + static_cast<std::size_t>(i) * sizeof(rec), sizeof(rec));
+        DetectionSighting s;
+        s.timestampNs = rec.timestampNs;
+        s.lat = rec.lat;
+        s.lon = rec.lon;
+        s.alt = rec.alt;
+        s.confidence = rec.confidence;
+        s.trackId = rec.trackId;
+        s.className.assign(rec.className, strnlen(rec.className, sizeof(rec.className)));
+        reportSighting(s, systemTimeNs(), "", nullptr, nullptr);
+    }
+}
+
+void EventReporterNode::setAggregatorConfig(const EventAggregatorConfig& cfg) {
+    aggregator_ = std::make_unique<EventAggregator>(cfg);
+}
+
+void EventReporterNode::reportDetection(const std::string& targetClass, double confidence,
+                                        double lat, double lon, double alt) {
+    DetectionSighting s;
+    s.timestampNs = core::PipelineClock::nowNs();
+    s.lat = lat;
+    s.lon = lon;
+    s.alt = alt;
+    s.confidence = static_cast<float>(confidence);
+    s.className = targetClass;
+    reportSighting(s, systemTimeNs(), "", nullptr, nullptr);
+}
+
+void EventReporterNode::reportDetection(const std::string& targetClass, double confidence,
+                                        double lat, double lon, double alt,
+                                        const sensors::ImageSurface& frame, const perception::DetectionBBox& box,
+                                        int trackId) {
+    DetectionSighting s;
+    s.timestampNs = core::PipelineClock::nowNs();
+    s.lat = lat;
+    s.lon = lon;
+    s.alt = alt;
+    s.confidence = static_cast<float>(confidence);
+    s.trackId = trackId;
+    s.className = targetClass;
+    reportSighting(s, systemTimeNs(), "", &frame, &box);
+}
+
+void EventReporterNode::reportGeoTracks(const perception::GeoTrackingResult& geo) {
+    reportGeoTracks(geo, nullptr);
+}
+
+void EventReporterNode::reportGeoTracks(const perception::GeoTrackingResult& geo, const sensors::ImageSurface& frame) {
+    reportGeoTracks(geo, &frame);
+}
+
+void EventReporterNode::reportGeoTracks(const perception::GeoTrackingResult& geo, const sensors::ImageSurface* frame) {
+    for (const auto& t : geo.tracks) {
+        if (!t.valid || t.status == "LOST") continue;
+        // 轨迹无逐框置信度：只在新目标时上报，不产生置信度更新
+        DetectionSighting s;
+        s.timestampNs = static_cast<std::int64_t>(geo.timestampNs);
+        s.lat = t.lat;
+        s.lon = t.lon;
+        s.alt = t.alt;
+        s.trackId = t.trackId;
+        s.className = t.className;
+        std::stringstream extra;
+        extra << ",\"range_m\":" << t.rangeM;
+        reportSighting(s, static_cast<std::int64_t>(geo.timestampNs), extra.str(), frame, &t.bbox);
+    }
+}
+
+void EventReporterNode::reportTracks3D(const perception::Tracking3DResult& tracks) {
+    for (const auto& t : tracks.tracks) {
+        if (t.status == "LOST") continue;
+        DetectionSighting s;
+        s.timestampNs = static_cast<std::int64_t>(tracks.timestampNs);
+        s.lat = t.lat;
+        s.lon = t.lon;
+        s.alt = t.alt;
+        s.confidence = t.score;
+        s.trackId = t.trackId;
+        s.className = t.className;
+        std::stringstream extra;
+        extra << ",\"vel_n\":" << t.velNorth << ",\"vel_e\":" << t.velEast << ",\"vel_d\":" << t.velDown
+              << ",\"pos_std_m\":" << t.posStdM;
+        reportSighting(s, static_cast<std::int64_t>(tracks.timestampNs), extra.str(), nullptr, nullptr);
+    }
+}
+
 } // namespace falconmind::sdk::mission
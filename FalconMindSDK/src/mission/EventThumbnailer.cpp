@@ -0,0 +1,144 @@
+#include "falconmind/sdk/mission/EventThumbnailer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace falconmind::sdk::mission {
+
+using core::PixelFormat;
+
+EventThumbnailer::EventThumbnailer(const EventThumbnailConfig& cfg)
+    : EventThumbnailer(cfg, sensors::createJpegEncoder(sensors::JpegEncoderType::Auto)) {}
+
+EventThumbnailer::EventThumbnailer(const EventThumbnailConfig& cfg, sensors::JpegEncoderPtr encoder,
+                                   sensors::ImageTransformPtr transform)
+    : cfg_(cfg), encoder_(std::move(encoder)), transform_(std::move(transform)) {
+    if (!transform_) transform_ = sensors::createImageTransform(sensors::ImageTransformBackendType::Auto);
+    tokens_ = std::max(1, cfg_.burst);
+    if (!encoder_) std::cerr << "[EventThumbnailer] no JPEG encoder available, events carry no thumbnail" << std::endl;
+}
+
+bool EventThumbnailer::takeToken(std::int64_t nowNs) {
+    const double burst = std::max(1, cfg_.burst);
+    if (lastRefillNs_ >= 0 && nowNs > lastRefillNs_) {
+        tokens_ = std::min(burst, tokens_ + static_cast<double>(nowNs - lastRefillNs_) * 1e-9 * cfg_.maxPerSecond);
+    }
+    lastRefillNs_ = lastRefillNs_ < 0 ? nowNs : std::max(lastRefillNs_, nowNs);
+    if (tokens_ < 1.0) return false;
+    tokens_ -= 1.0;
+    return true;
+}
+
+void EventThumbnailer::remember(int trackId, std::int64_t nowNs, float score) {
+    if (trackId < 0) return;
+    if (tracks_.size() >= cfg_.maxTracks && tracks_.find(trackId) == tracks_.end()) {
+        auto oldest = std::min_element(tracks_.begin(), tracks_.end(),
+                                       [](const auto& a, const auto& b) { return a.second.lastNs < b.second.lastNs; });
+        if (oldest != tracks_.end()) tracks_.erase(oldest);
+    }
+    tracks_[trackId] = TrackEntry{nowNs, score};
+}
+
+bool EventThumbnailer::make(const sensors::ImageSurface& frame, const perception::DetectionBBox& box, int trackId,
+                            float score, std::int64_t nowNs, EventThumbnail& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!encoder_ || !frame.data || frame.width <= 0 || frame.height <= 0 || !(box.width > 0.f) ||
+        !(box.height > 0.f)) {
+        ++stats_.failures;
+        return false;
+    }
+    if (trackId >= 0) {
+        auto it = tracks_.find(trackId);
+        if (it != tracks_.end() &&
+            (nowNs - it->second.lastNs < cfg_.trackIntervalNs || score < it->second.score + cfg_.rescoreMargin)) {
+            ++stats_.duplicates;
+            return false;
+        }
+    }
+    if (!takeToken(nowNs)) {
+        ++stats_.rateLimited;
+        return false;
+    }
+
+    // 框向四周扩展后裁剪到帧内；YUV 源按色度采样取偶数
+    const float padX = box.width * cfg_.contextRatio;
+    const float padY = box.height * cfg_.contextRatio;
+    int x0 = std::max(0, static_cast<int>(std::floor(box.x - padX)));
+    int y0 = std::max(0, static_cast<int>(std::floor(box.y - padY)));
+    const int x1 = std::min(frame.width, static_cast<int>(std::ceil(box.x + box.width + padX)));
+    const int y1 = std::min(frame.height, static_cast<int>(std::ceil(box.y + box.height + padY)));
+    if (frame.format == PixelFormat::NV12 || frame.format == PixelFormat::YUYV) {
+        x0 &= ~1;
+        if (frame.format == PixelFormat::NV12) y0 &= ~1;
+    }
+    if (x1 - x0 < 2 || y1 - y0 < 2) {
+        ++stats_.failures;
+        return false;
+    }
+    sensors::ImageTransformOp op;
+    op.crop = sensors::ImageRect{x0, y0, x1 - x0, y1 - y0};
+
+    // 长边缩到 maxSide（不放大），宽高取偶数以满足 4:2:0 编码
+    const int longSide = std::max(op.crop.width, op.crop.height);
+    const double scale = longSide > cfg_.maxSide ? static_cast<double>(cfg_.maxSide) / longSide : 1.0;
+    const int width = std::max(2, static_cast<int>(op.crop.width * scale) & ~1);
+    const int height = std::max(2, static_cast<int>(op.crop.height * scale) & ~1);
+
+    const PixelFormat format = encoder_->inputFormat();
+    const std::size_t bytes = format == PixelFormat::NV12 ? static_cast<std::size_t>(width) * height * 3 / 2
+                                                          : static_cast<std::size_t>(width) * height * 3;
+    pixels_.resize(bytes);
+    sensors::WritableImageSurface dst;
+    dst.data = pixels_.data();
+    dst.width = width;
+    dst.height = height;
+    dst.format = format;
+    if (!transform_->transform(frame, op, dst)) {
+        ++stats_.failures;
+        return false;
+    }
+
+    sensors::ImageSurface scaled;
+    scaled.data = pixels_.data();
+    scaled.width = width;
+    scaled.height = height;
+    scaled.format = format;
+    int quality = std::clamp(cfg_.quality, 1, 100);
+    const int minQuality = std::clamp(cfg_.minQuality, 1, quality);
+    while (true) {
+        if (!encoder_->encode(scaled, quality, out.jpeg)) {
+            ++stats_.failures;
+            return false;
+        }
+        if (out.jpeg.size() <= cfg_.maxBytes) break;
+        if (quality == minQuality) {
+            // 记为已发送：同一目标在间隔内不再反复尝试
+            remember(trackId, nowNs, score);
+            ++stats_.oversize;
+            out.jpeg.clear();
+            return false;
+        }
+        quality = std::max(minQuality, quality - 15);
+    }
+    out.trackId = trackId;
+    out.width = width;
+    out.height = height;
+    out.quality = quality;
+    remember(trackId, nowNs, score);
+    ++stats_.encoded;
+    stats_.bytes += out.jpeg.size();
+    return true;
+}
+
+void EventThumbnailer::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tracks_.clear();
+}
+
+EventThumbnailStats EventThumbnailer::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace falconmind::sdk::mission
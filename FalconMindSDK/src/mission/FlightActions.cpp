@@ -0,0 +1,38 @@
+// FalconMindSDK - Flight BehaviorTree Actions Implementation
+#include "falconmind/sdk/mission/FlightActions.h"
+
+namespace falconmind::sdk::mission {
+
+NodeStatus FlightCommandAction::tick() {
+    if (done_) return NodeStatus::Success;
+    if (!awaitAck_) {
+        svc_.sendCommand(cmd_);
+        done_ = true;
+        return NodeStatus::Success;
+    }
+
+    if (!pending_) {
+        pending_ = std::make_shared<AckWait>();
+        waitFor(pending_->event);
+        svc_.sendCommandAsync(cmd_, options_, [wait = pending_](const CommandAck& ack) {
+            wait->ack = ack;
+            wait->done.store(true, std::memory_order_release);
+            wait->event.notify();
+        });
+        // 未连接 / 发送失败时回调已同步执行，落到下面直接给出结果
+    } else {
+        waitFor(pending_->event);
+    }
+    if (!pending_->done.load(std::memory_order_acquire)) {
+        return NodeStatus::Running;
+    }
+    lastAck_ = pending_->ack;
+    pending_.reset();
+    if (!lastAck_->accepted()) {
+        return NodeStatus::Failure;
+    }
+    done_ = true;
+    return NodeStatus::Success;
+}
+
+} // namespace falconmind::sdk::mission
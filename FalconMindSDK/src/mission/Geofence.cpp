@@ -0,0 +1,292 @@
+// FalconMindSDK - Geofence Index Implementation
+#include "falconmind/sdk/mission/Geofence.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace falconmind::sdk::mission {
+
+namespace {
+
+constexpr int kMaxCellsPerAxis = 2048;
+constexpr std::uint32_t kInsideMarker = 0xFFFFFFFFu;
+
+// 栅格化记录：某单元内某区域的一条边，或（edge 为 kInsideMarker）该单元中心在区域内
+struct CellRecord {
+    std::uint32_t cell;
+    std::uint32_t zone;
+    std::uint32_t edge;
+    bool operator<(const CellRecord& o) const noexcept {
+        if (cell != o.cell) return cell < o.cell;
+        if (zone != o.zone) return zone < o.zone;
+        return edge < o.edge;
+    }
+};
+
+// 点 q 是否严格位于有向线段 a → b 左侧；共线归为右侧，使退化情形的奇偶判定保持一致
+inline bool leftOf(double ax, double ay, double bx, double by, double qx, double qy) noexcept {
+    return (bx - ax) * (qy - ay) - (by - ay) * (qx - ax) > 0.0;
+}
+
+} // namespace
+
+GeofenceZone makeGeofenceZone(const LocalEnuFrame& frame, std::string name, GeofenceType type,
+                              const std::vector<GeoPoint>& outer, double floorAlt, double ceilingAlt,
+                              const std::vector<std::vector<GeoPoint>>& holes) {
+    GeofenceZone zone;
+    zone.name = std::move(name);
+    zone.type = type;
+    zone.floor = floorAlt - frame.origin().alt;
+    zone.ceiling = ceilingAlt - frame.origin().alt;
+    auto project = [&frame](const std::vector<GeoPoint>& ring) {
+        std::vector<PlanarPoint> out;
+        out.reserve(ring.size());
+        for (const auto& g : ring) {
+            const EnuPoint p = frame.toEnu({g.lat, g.lon, frame.origin().alt});
+            out.push_back({p.east, p.north});
+        }
+        return out;
+    };
+    zone.rings.push_back(project(outer));
+    for (const auto& h : holes) zone.rings.push_back(project(h));
+    return zone;
+}
+
+bool GeofenceIndex::build(std::vector<GeofenceZone> zones, double cellSize) {
+    zones_ = std::move(zones);
+    edges_.clear();
+    cellStart_.clear();
+    cellZones_.clear();
+    cellEdges_.clear();
+    hasKeepIn_ = false;
+    nx_ = ny_ = 0;
+
+    bool ok = true;
+    for (std::size_t z = 0; z < zones_.size(); ++z) {
+        auto& rings = zones_[z].rings;
+        if (rings.empty() || rings[0].size() < 3) {
+            std::cerr << "[GeofenceIndex] zone '" << zones_[z].name << "' has no valid outer ring" << std::endl;
+            rings.clear();
+            ok = false;
+            continue;
+        }
+        rings.erase(std::remove_if(rings.begin() + 1, rings.end(),
+                                   [](const std::vector<PlanarPoint>& r) { return r.size() < 3; }),
+                    rings.end());
+        if (zones_[z].type == GeofenceType::KeepIn) hasKeepIn_ = true;
+        for (const auto& ring : rings) {
+            for (std::size_t i = 0; i < ring.size(); ++i) {
+                const PlanarPoint& a = ring[i];
+                const PlanarPoint& b = ring[(i + 1) % ring.size()];
+                edges_.push_back({a.x, a.y, b.x, b.y, static_cast<std::uint32_t>(z)});
+            }
+        }
+    }
+    if (edges_.empty()) return ok;
+
+    double maxX = edges_[0].ax, maxY = edges_[0].ay;
+    minX_ = maxX;
+    minY_ = maxY;
+    for (const auto& e : edges_) {
+        minX_ = std::min({minX_, e.ax, e.bx});
+        minY_ = std::min({minY_, e.ay, e.by});
+        maxX = std::max({maxX, e.ax, e.bx});
+        maxY = std::max({maxY, e.ay, e.by});
+    }
+    const double w = std::max(maxX - minX_, 1e-6), h = std::max(maxY - minY_, 1e-6);
+    cell_ = cellSize > 0.0 ? cellSize : std::sqrt(w * h / (4.0 * edges_.size()));
+    cell_ = std::max({cell_, w / kMaxCellsPerAxis, h / kMaxCellsPerAxis, 1e-3});
+    nx_ = static_cast<int>(w / cell_) + 1;
+    ny_ = static_cast<int>(h / cell_) + 1;
+
+    auto colOf = [this](double x) { return std::clamp(static_cast<int>(std::floor((x - minX_) / cell_)), 0, nx_ - 1); };
+    auto rowOf = [this](double y) { return std::clamp(static_cast<int>(std::floor((y - minY_) / cell_)), 0, ny_ - 1); };
+
+    std::vector<CellRecord> records;
+    records.reserve(edges_.size() * 4);
+
+    // 边的精确栅格化：逐行取线段落在该行 y 范围内的部分，其 x 范围覆盖的单元
+    for (std::uint32_t i = 0; i < edges_.size(); ++i) {
+        const Edge& e = edges_[i];
+        const double y0 = std::min(e.ay, e.by), y1 = std::max(e.ay, e.by);
+        const int r0 = rowOf(y0), r1 = rowOf(y1);
+        for (int r = r0; r <= r1; ++r) {
+            double xa = e.ax, xb = e.bx;
+            if (e.ay != e.by) {
+                const double lo = std::max(y0, minY_ + r * cell_), hi = std::min(y1, minY_ + (r + 1) * cell_);
+                const double inv = (e.bx - e.ax) / (e.by - e.ay);
+                xa = e.ax + (lo - e.ay) * inv;
+                xb = e.ax + (hi - e.ay) * inv;
+            }
+            const int c0 = colOf(std::min(xa, xb)), c1 = colOf(std::max(xa, xb));
+            for (int c = c0; c <= c1; ++c) {
+                records.push_back({static_cast<std::uint32_t>(r * nx_ + c), e.zone, i});
+            }
+        }
+    }
+
+    // 单元中心是否在区域内：按行做扫描线求交（半开规则），中心落在交点对之间的单元标记为内部
+    std::vector<double> xs;
+    std::size_t edgeBegin = 0;
+    for (std::uint32_t z = 0; z < zones_.size(); ++z) {
+        std::size_t edgeEnd = edgeBegin;
+        while (edgeEnd < edges_.size() && edges_[edgeEnd].zone == z) ++edgeEnd;
+        if (edgeEnd == edgeBegin) continue;
+
+        double zy0 = edges_[edgeBegin].ay, zy1 = zy0;
+        for (std::size_t i = edgeBegin; i < edgeEnd; ++i) {
+            zy0 = std::min(zy0, edges_[i].ay);
+            zy1 = std::max(zy1, edges_[i].ay);
+        }
+        for (int r = rowOf(zy0); r <= rowOf(zy1); ++r) {
+            const double cy = minY_ + (r + 0.5) * cell_;
+            xs.clear();
+            for (std::size_t i = edgeBegin; i < edgeEnd; ++i) {
+                const Edge& e = edges_[i];
+                if ((e.ay > cy) != (e.by > cy)) xs.push_back(e.ax + (cy - e.ay) * (e.bx - e.ax) / (e.by - e.ay));
+            }
+            std::sort(xs.begin(), xs.end());
+            for (std::size_t k = 0; k + 1 < xs.size(); k += 2) {
+                const int c0 = std::max(0, static_cast<int>(std::ceil((xs[k] - minX_) / cell_ - 0.5)));
+                const int c1 = std::min(nx_ - 1, static_cast<int>(std::ceil((xs[k + 1] - minX_) / cell_ - 0.5)) - 1);
+                for (int c = c0; c <= c1; ++c) {
+                    records.push_back({static_cast<std::uint32_t>(r * nx_ + c), z, kInsideMarker});
+                }
+            }
+        }
+        edgeBegin = edgeEnd;
+    }
+
+    std::sort(records.begin(), records.end());
+    const std::size_t cells = static_cast<std::size_t>(nx_) * ny_;
+    cellStart_.assign(cells + 1, 0);
+    cellEdges_.reserve(records.size());
+    for (std::size_t i = 0; i < records.size();) {
+        const std::uint32_t cell = records[i].cell, zone = records[i].zone;
+        CellZone cz{zone, 0, static_cast<std::uint32_t>(cellEdges_.size()), 0};
+        for (; i < records.size() && records[i].cell == cell && records[i].zone == zone; ++i) {
+            if (records[i].edge == kInsideMarker) cz.centerInside = 1;
+            else cellEdges_.push_back(records[i].edge);
+        }
+        cz.edgeEnd = static_cast<std::uint32_t>(cellEdges_.size());
+        cellZones_.push_back(cz);
+        ++cellStart_[cell + 1];
+    }
+    for (std::size_t c = 0; c < cells; ++c) cellStart_[c + 1] += cellStart_[c];
+    return ok;
+}
+
+bool GeofenceIndex::cellOf(double east, double north, int& cx, int& cy) const noexcept {
+    if (nx_ == 0) return false;
+    const double fx = std::floor((east - minX_) / cell_), fy = std::floor((north - minY_) / cell_);
+    if (!(fx >= 0.0 && fy >= 0.0 && fx < nx_ && fy < ny_)) return false;
+    cx = static_cast<int>(fx);
+    cy = static_cast<int>(fy);
+    return true;
+}
+
+bool GeofenceIndex::insideCellZone(const CellZone& cz, int cx, int cy, double east, double north) const noexcept {
+    // 中心的内外状态沿“中心 → 点”线段每跨过一条边翻转一次
+    const double ox = minX_ + (cx + 0.5) * cell_, oy = minY_ + (cy + 0.5) * cell_;
+    bool inside = cz.centerInside != 0;
+    for (std::uint32_t k = cz.edgeBegin; k < cz.edgeEnd; ++k) {
+        const Edge& e = edges_[cellEdges_[k]];
+        if (leftOf(e.ax, e.ay, e.bx, e.by, ox, oy) != leftOf(e.ax, e.ay, e.bx, e.by, east, north) &&
+            leftOf(ox, oy, east, north, e.ax, e.ay) != leftOf(ox, oy, east, north, e.bx, e.by)) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+bool GeofenceIndex::contains(std::size_t zone, double east, double north) const noexcept {
+    int cx, cy;
+    if (!cellOf(east, north, cx, cy)) return false;
+    const std::size_t cell = static_cast<std::size_t>(cy) * nx_ + cx;
+    for (std::uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i) {
+        if (cellZones_[i].zone == zone) return insideCellZone(cellZones_[i], cx, cy, east, north);
+    }
+    return false;
+}
+
+double GeofenceIndex::edgeDistanceSq(const Edge& e, double east, double north) const noexcept {
+    const double dx = e.bx - e.ax, dy = e.by - e.ay;
+    const double len2 = dx * dx + dy * dy;
+    double t = len2 > 0.0 ? ((east - e.ax) * dx + (north - e.ay) * dy) / len2 : 0.0;
+    t = std::clamp(t, 0.0, 1.0);
+    const double px = e.ax + t * dx - east, py = e.ay + t * dy - north;
+    return px * px + py * py;
+}
+
+double GeofenceIndex::boundaryDistance(double east, double north, std::int32_t* zone) const noexcept {
+    double best = std::numeric_limits<double>::infinity();
+    std::int32_t bestZone = -1;
+    auto consider = [&](const Edge& e) {
+        const double d = edgeDistanceSq(e, east, north);
+        if (d < best) {
+            best = d;
+            bestZone = static_cast<std::int32_t>(e.zone);
+        }
+    };
+
+    int cx, cy;
+    if (!cellOf(east, north, cx, cy)) {
+        // 网格外（远离所有区域）：直接遍历
+        for (const auto& e : edges_) consider(e);
+    } else {
+        // 第 r 环外的单元距本点至少 r × cell
+        const int maxRing = std::max(nx_, ny_);
+        for (int r = 0; r <= maxRing; ++r) {
+            for (int y = cy - r; y <= cy + r; ++y) {
+                if (y < 0 || y >= ny_) continue;
+                const bool edgeRow = (y == cy - r || y == cy + r);
+                for (int x = cx - r; x <= cx + r; x += (edgeRow || r == 0) ? 1 : 2 * r) {
+                    if (x < 0 || x >= nx_) continue;
+                    const std::size_t cell = static_cast<std::size_t>(y) * nx_ + x;
+                    for (std::uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i) {
+                        const CellZone& cz = cellZones_[i];
+                        for (std::uint32_t k = cz.edgeBegin; k < cz.edgeEnd; ++k) consider(edges_[cellEdges_[k]]);
+                    }
+                }
+            }
+            if (best <= static_cast<double>(r) * r * cell_ * cell_) break;
+        }
+    }
+    if (zone) *zone = bestZone;
+    return std::sqrt(best);
+}
+
+GeofenceResult GeofenceIndex::check(const EnuPoint& p) const noexcept {
+    GeofenceResult res;
+    res.boundaryDistance = boundaryDistance(p.east, p.north, &res.nearestZone);
+
+    bool inKeepIn = false;
+    bool keepInContains = false;
+    double keepInMargin = -std::numeric_limits<double>::infinity();
+    int cx, cy;
+    if (cellOf(p.east, p.north, cx, cy)) {
+        const std::size_t cell = static_cast<std::size_t>(cy) * nx_ + cx;
+        for (std::uint32_t i = cellStart_[cell]; i < cellStart_[cell + 1]; ++i) {
+            const CellZone& cz = cellZones_[i];
+            if (!insideCellZone(cz, cx, cy, p.east, p.north)) continue;
+            const GeofenceZone& zone = zones_[cz.zone];
+            const double band = std::min(p.up - zone.floor, zone.ceiling - p.up);  // 高度带内为正
+            if (zone.type == GeofenceType::KeepIn) {
+                keepInContains = true;
+                keepInMargin = std::max(keepInMargin, band);
+                if (band >= 0.0) inKeepIn = true;
+            } else {
+                res.verticalMargin = std::min(res.verticalMargin, -band);
+                if (band >= 0.0 && res.keepOutZone < 0) res.keepOutZone = static_cast<std::int32_t>(cz.zone);
+            }
+        }
+    }
+    // 多个允许区重叠时取余量最大者（留在任意一个内即可）
+    if (keepInContains) res.verticalMargin = std::min(res.verticalMargin, keepInMargin);
+    res.outsideKeepIn = hasKeepIn_ && !inKeepIn;
+    res.breach = res.outsideKeepIn || res.keepOutZone >= 0;
+    return res;
+}
+
+} // namespace falconmind::sdk::mission
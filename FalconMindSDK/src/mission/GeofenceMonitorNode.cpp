@@ -0,0 +1,57 @@
+// FalconMindSDK - Geofence Monitor Node Implementation
+#include "falconmind/sdk/mission/GeofenceMonitorNode.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/flight/FlightTypes.h"
+
+#include <cstring>
+
+namespace falconmind::sdk::mission {
+
+GeofenceMonitorNode::GeofenceMonitorNode() : core::Node("geofence_monitor") {
+    addPad(std::make_shared<core::Pad>("flight_state_in", core::PadType::Sink))
+        ->setDataCallback([this](const void* data, std::size_t size) {
+            if (size < sizeof(flight::FlightState)) return;
+            flight::FlightState state;
+            std::memcpy(&state, data, sizeof(state));
+            if (state.seq != 0) {
+                if (state.seq > lastStateSeq_ &&
+                    !(state.changedSince(lastStateSeq_) & flight::fieldBit(flight::FlightField::Position))) {
+                    lastStateSeq_ = state.seq;
+                    return;
+                }
+                lastStateSeq_ = state.seq;
+            }
+            update({state.lat, state.lon, state.alt});
+        });
+}
+
+void GeofenceMonitorNode::setGeofence(std::shared_ptr<const GeofenceIndex> index, const LocalEnuFrame& frame) {
+    std::shared_ptr<const Fence> fence;
+    if (index) fence = std::make_shared<const Fence>(Fence{std::move(index), frame});
+    std::atomic_store(&fence_, std::move(fence));
+}
+
+GeofenceResult GeofenceMonitorNode::update(const GeoPoint& position) {
+    const auto fence = std::atomic_load(&fence_);
+    GeofenceResult res;
+    if (fence) {
+        const double originAlt = fence->frame.origin().alt;
+        EnuPoint p = fence->frame.toEnu({position.lat, position.lon, originAlt});
+        p.up = position.alt - originAlt;
+        res = fence->index->check(p);
+    }
+    result_.store(res);
+    checks_.fetch_add(1, std::memory_order_relaxed);
+    if (breached_.exchange(res.breach, std::memory_order_acq_rel) != res.breach) {
+        breachChanged_.notify();
+    }
+    return res;
+}
+
+BehaviorNodePtr makeGeofenceCondition(std::shared_ptr<GeofenceMonitorNode> monitor) {
+    const BehaviorEvent* input = &monitor->breachChanged();
+    return std::make_shared<ConditionNode>([monitor]() { return !monitor->breached(); },
+                                           std::vector<const BehaviorEvent*>{input});
+}
+
+} // namespace falconmind::sdk::mission
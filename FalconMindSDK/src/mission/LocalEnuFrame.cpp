@@ -0,0 +1,120 @@
+// FalconMindSDK - Local ENU frame
+#include "falconmind/sdk/mission/LocalEnuFrame.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace falconmind::sdk::mission {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kDegToRad = kPi / 180.0;
+constexpr double kRadToDeg = 180.0 / kPi;
+// WGS84
+constexpr double kA = 6378137.0;
+constexpr double kF = 1.0 / 298.257223563;
+constexpr double kB = kA * (1.0 - kF);
+constexpr double kE2 = kF * (2.0 - kF);          // 第一偏心率平方
+constexpr double kEp2 = kE2 / (1.0 - kE2);       // 第二偏心率平方
+
+void geodeticToEcef(double sinLat, double cosLat, double sinLon, double cosLon, double h, double& x, double& y,
+                    double& z) noexcept {
+    const double n = kA / std::sqrt(1.0 - kE2 * sinLat * sinLat);
+    x = (n + h) * cosLat * cosLon;
+    y = (n + h) * cosLat * sinLon;
+    z = (n * (1.0 - kE2) + h) * sinLat;
+}
+
+} // namespace
+
+LocalEnuFrame::LocalEnuFrame() {
+    setOrigin(origin_);
+}
+
+LocalEnuFrame::LocalEnuFrame(const GeoPoint& origin) {
+    setOrigin(origin);
+}
+
+void LocalEnuFrame::setOrigin(const GeoPoint& origin) {
+    origin_ = origin;
+    sinLat_ = std::sin(origin.lat * kDegToRad);
+    cosLat_ = std::cos(origin.lat * kDegToRad);
+    sinLon_ = std::sin(origin.lon * kDegToRad);
+    cosLon_ = std::cos(origin.lon * kDegToRad);
+    geodeticToEcef(sinLat_, cosLat_, sinLon_, cosLon_, origin.alt, ox_, oy_, oz_);
+}
+
+EnuPoint LocalEnuFrame::toEnu(const GeoPoint& p) const noexcept {
+    const double lat = p.lat * kDegToRad;
+    const double lon = p.lon * kDegToRad;
+    double x, y, z;
+    geodeticToEcef(std::sin(lat), std::cos(lat), std::sin(lon), std::cos(lon), p.alt, x, y, z);
+    const double dx = x - ox_, dy = y - oy_, dz = z - oz_;
+    EnuPoint e;
+    e.east = -sinLon_ * dx + cosLon_ * dy;
+    e.north = -sinLat_ * cosLon_ * dx - sinLat_ * sinLon_ * dy + cosLat_ * dz;
+    e.up = cosLat_ * cosLon_ * dx + cosLat_ * sinLon_ * dy + sinLat_ * dz;
+    return e;
+}
+
+GeoPoint LocalEnuFrame::toGeo(const EnuPoint& p) const noexcept {
+    const double x = ox_ - sinLon_ * p.east - sinLat_ * cosLon_ * p.north + cosLat_ * cosLon_ * p.up;
+    const double y = oy_ + cosLon_ * p.east - sinLat_ * sinLon_ * p.north + cosLat_ * sinLon_ * p.up;
+    const double z = oz_ + cosLat_ * p.north + sinLat_ * p.up;
+    // Bowring 闭式解
+    const double r = std::sqrt(x * x + y * y);
+    const double theta = std::atan2(z * kA, r * kB);
+    const double st = std::sin(theta), ct = std::cos(theta);
+    const double lat = std::atan2(z + kEp2 * kB * st * st * st, r - kE2 * kA * ct * ct * ct);
+    const double sl = std::sin(lat), cl = std::cos(lat);
+    const double n = kA / std::sqrt(1.0 - kE2 * sl * sl);
+    GeoPoint g;
+    g.lat = lat * kRadToDeg;
+    g.lon = std::atan2(y, x) * kRadToDeg;
+    // 高纬处 r / cos(lat) 病态，改用 z 分量
+    g.alt = std::abs(cl) > 1e-3 ? r / cl - n : z / sl - n * (1.0 - kE2);
+    return g;
+}
+
+void LocalEnuFrame::toEnu(const GeoPoint* in, std::size_t n, EnuPoint* out) const noexcept {
+    for (std::size_t i = 0; i < n; ++i) out[i] = toEnu(in[i]);
+}
+
+void LocalEnuFrame::toGeo(const EnuPoint* in, std::size_t n, GeoPoint* out) const noexcept {
+    for (std::size_t i = 0; i < n; ++i) out[i] = toGeo(in[i]);
+}
+
+void LocalEnuFrame::toEnu(const GeoPoint* in, std::size_t n, float* east, float* north) const noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        const EnuPoint e = toEnu(in[i]);
+        east[i] = static_cast<float>(e.east);
+        north[i] = static_cast<float>(e.north);
+    }
+}
+
+std::vector<EnuPoint> LocalEnuFrame::toEnu(const std::vector<GeoPoint>& in) const {
+    std::vector<EnuPoint> out(in.size());
+    toEnu(in.data(), in.size(), out.data());
+    return out;
+}
+
+std::vector<GeoPoint> LocalEnuFrame::toGeo(const std::vector<EnuPoint>& in) const {
+    std::vector<GeoPoint> out(in.size());
+    toGeo(in.data(), in.size(), out.data());
+    return out;
+}
+
+GeoPoint LocalEnuFrame::boundsCenter(const std::vector<GeoPoint>& polygon) noexcept {
+    if (polygon.empty()) return {0.0, 0.0, 0.0};
+    double minLat = polygon[0].lat, maxLat = minLat, minLon = polygon[0].lon, maxLon = minLon;
+    for (const auto& p : polygon) {
+        minLat = std::min(minLat, p.lat);
+        maxLat = std::max(maxLat, p.lat);
+        minLon = std::min(minLon, p.lon);
+        maxLon = std::max(maxLon, p.lon);
+    }
+    return {(minLat + maxLat) / 2.0, (minLon + maxLon) / 2.0, 0.0};
+}
+
+} // namespace falconmind::sdk::mission
@@ -0,0 +1,182 @@
+// FalconMindSDK - Multi-UAV coverage planner
+#include "falconmind/sdk/mission/MultiUavCoveragePlanner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace falconmind::sdk::mission {
+
+namespace {
+
+using Ring = std::vector<PlanarPoint>;
+using Rings = std::vector<Ring>;
+
+double ringArea(const Ring& ring) {
+    double a = 0.0;
+    for (std::size_t i = 0, n = ring.size(); i < n; ++i) {
+        const PlanarPoint& p = ring[i];
+        const PlanarPoint& q = ring[(i + 1) % n];
+        a += p.x * q.y - q.x * p.y;
+    }
+    return std::abs(a) * 0.5;
+}
+
+// Sutherland–Hodgman：保留 sign * (y - bound) >= 0 的部分（裁剪窗口为半平面，凹多边形同样适用）
+Ring clipHalfPlane(const Ring& ring, double bound, double sign) {
+    Ring out;
+    if (ring.empty()) return out;
+    out.reserve(ring.size() + 4);
+    for (std::size_t i = 0, n = ring.size(); i < n; ++i) {
+        const PlanarPoint& a = ring[i];
+        const PlanarPoint& b = ring[(i + 1) % n];
+        const double da = sign * (a.y - bound);
+        const double db = sign * (b.y - bound);
+        if (da >= 0.0) out.push_back(a);
+        if ((da >= 0.0) != (db >= 0.0)) {
+            const double t = da / (da - db);
+            out.push_back({a.x + (b.x - a.x) * t, bound});
+        }
+    }
+    if (out.size() < 3) out.clear();
+    return out;
+}
+
+// 旋转后的区域落在 [lo, hi] 条带内的部分
+Rings clipSlab(const Rings& rotated, double lo, double hi) {
+    Rings out;
+    for (std::size_t i = 0; i < rotated.size(); ++i) {
+        Ring r = clipHalfPlane(clipHalfPlane(rotated[i], lo, 1.0), hi, -1.0);
+        if (r.empty()) {
+            if (i == 0) return {};  // 外边界不在条带内
+            continue;
+        }
+        out.push_back(std::move(r));
+    }
+    return out;
+}
+
+Rings rotate(const Rings& rings, double c, double s) {
+    Rings out(rings.size());
+    for (std::size_t i = 0; i < rings.size(); ++i) {
+        out[i].reserve(rings[i].size());
+        for (const PlanarPoint& p : rings[i]) out[i].push_back({p.x * c + p.y * s, -p.x * s + p.y * c});
+    }
+    return out;
+}
+
+} // namespace
+
+double regionArea(const std::vector<std::vector<PlanarPoint>>& rings) {
+    if (rings.empty()) return 0.0;
+    double a = ringArea(rings[0]);
+    for (std::size_t i = 1; i < rings.size(); ++i) a -= ringArea(rings[i]);
+    return std::max(a, 0.0);
+}
+
+std::vector<CoverageAssignment> MultiUavCoveragePlanner::partition(const std::vector<std::vector<PlanarPoint>>& rings,
+                                                                   const std::vector<CoverageMember>& team) const {
+    std::vector<CoverageAssignment> out;
+    if (team.empty() || rings.empty() || rings[0].size() < 3 || !(spacing_ > 0.0)) {
+        return out;
+    }
+
+    // 成员按 id 排序：各机本地计算得到相同的条带顺序
+    std::vector<CoverageMember> members = team;
+    std::sort(members.begin(), members.end(),
+              [](const CoverageMember& a, const CoverageMember& b) { return a.id < b.id; });
+    double totalWeight = 0.0;
+    for (auto& m : members) {
+        if (!(m.weight > 0.0)) m.weight = 1.0;
+        totalWeight += m.weight;
+    }
+
+    // 旋转到扫描线水平的坐标系（与 sweepSegments 相同），条带沿 v 方向排列
+    const double c = std::cos(angleRad_);
+    const double s = std::sin(angleRad_);
+    const Rings rotated = rotate(rings, c, s);
+    double minV = std::numeric_limits<double>::max();
+    double maxV = std::numeric_limits<double>::lowest();
+    for (const auto& ring : rotated) {
+        for (const auto& p : ring) {
+            minV = std::min(minV, p.y);
+            maxV = std::max(maxV, p.y);
+        }
+    }
+    const int rows = std::max(1, static_cast<int>(std::ceil((maxV - minV) / spacing_ - 0.5)));
+
+    // 各扫描线边界以下的累计面积：切分位置只取边界，条带内扫描线与全局栅格对齐
+    std::vector<double> cumulative(static_cast<std::size_t>(rows) + 1, 0.0);
+    for (int j = 1; j < rows; ++j) {
+        cumulative[j] = regionArea(clipSlab(rotated, minV, minV + spacing_ * j));
+    }
+    const double total = regionArea(rotated);
+    cumulative[rows] = total;
+
+    // 按权重比例依次选切分边界；行数足够时每个成员至少一行
+    const int k = static_cast<int>(members.size());
+    std::vector<int> cuts(static_cast<std::size_t>(k) + 1, rows);
+    cuts[0] = 0;
+    double acc = 0.0;
+    for (int i = 1; i < k; ++i) {
+        acc += members[i - 1].weight;
+        const double target = total * acc / totalWeight;
+        const int lo = std::min(rows, cuts[i - 1] + (rows >= k ? 1 : 0));
+        const int hi = rows >= k ? rows - (k - i) : rows;
+        int best = lo;
+        for (int j = lo; j <= hi; ++j) {
+            if (std::abs(cumulative[j] - target) < std::abs(cumulative[best] - target)) best = j;
+        }
+        cuts[i] = best;
+    }
+
+    out.reserve(members.size());
+    for (int i = 0; i < k; ++i) {
+        CoverageAssignment a;
+        a.memberId = members[i].id;
+        if (cuts[i + 1] > cuts[i]) {
+            // 首尾条带不裁剪外侧，避免边界上的浮点误差丢掉顶点
+            const double lo = i == 0 ? minV - 1.0 : minV + spacing_ * cuts[i];
+            const double hi = i == k - 1 ? maxV + 1.0 : minV + spacing_ * cuts[i + 1];
+            const Rings slab = clipSlab(rotated, lo, hi);
+            a.areaM2 = regionArea(slab);
+            a.rings = rotate(slab, c, -s);
+        }
+        out.push_back(std::move(a));
+    }
+    return out;
+}
+
+std::vector<CoverageAssignment> MultiUavCoveragePlanner::plan(const std::vector<std::vector<PlanarPoint>>& rings,
+                                                              const std::vector<CoverageMember>& team) const {
+    std::vector<CoverageAssignment> out = partition(rings, team);
+    if (out.size() == 1) {
+        out[0].path = lawnMowerPath(out[0].rings, spacing_, angleRad_);
+        return out;
+    }
+    // 每个子区域一个线程；子区域互不重叠，各线程只写各自的 path
+    std::vector<std::thread> workers;
+    workers.reserve(out.size());
+    for (auto& a : out) {
+        workers.emplace_back([this, &a] { a.path = lawnMowerPath(a.rings, spacing_, angleRad_); });
+    }
+    for (auto& t : workers) t.join();
+    return out;
+}
+
+CoverageAssignment MultiUavCoveragePlanner::planFor(const std::vector<std::vector<PlanarPoint>>& rings,
+                                                    const std::vector<CoverageMember>& team,
+                                                    const std::string& selfId) const {
+    for (auto& a : partition(rings, team)) {
+        if (a.memberId == selfId) {
+            a.path = lawnMowerPath(a.rings, spacing_, angleRad_);
+            return a;
+        }
+    }
+    CoverageAssignment none;
+    none.memberId = selfId;
+    return none;
+}
+
+} // namespace falconmind::sdk::mission
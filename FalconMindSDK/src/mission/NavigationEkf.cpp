@@ -0,0 +1,474 @@
+// FalconMindSDK - Navigation EKF Implementation
+#include "falconmind/sdk/mission/NavigationEkf.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace falconmind::sdk::mission {
+
+namespace {
+
+using Vec3 = NavigationEkf::Vec3;
+using Quat = NavigationEkf::Quat;
+using Mat3 = core::Matrix<double, 3, 3>;
+constexpr std::size_t kP = 0, kV = 3, kTheta = 6, kBg = 9, kBa = 12;
+
+// 99.9% 卡方分位数（自由度 1..6）
+constexpr double kChi2[6] = {10.83, 13.82, 16.27, 18.47, 20.52, 22.46};
+
+Vec3 vec3(double x, double y, double z) noexcept {
+    Vec3 v;
+    v[0] = x;
+    v[1] = y;
+    v[2] = z;
+    return v;
+}
+
+Quat quatMul(const Quat& a, const Quat& b) noexcept {
+    return {{a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3],
+             a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2],
+             a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1],
+             a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0]}};
+}
+
+Quat quatConj(const Quat& q) noexcept { return {{q[0], -q[1], -q[2], -q[3]}}; }
+
+void quatNormalize(Quat& q) noexcept {
+    const double n = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    if (!(n > 0.)) {
+        q = {{1., 0., 0., 0.}};
+        return;
+    }
+    for (auto& c : q) c /= n;
+}
+
+// 旋转向量 → 四元数
+Quat quatExp(const Vec3& r) noexcept {
+    const double angle = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+    if (angle < 1e-9) return {{1., 0.5 * r[0], 0.5 * r[1], 0.5 * r[2]}};
+    const double s = std::sin(0.5 * angle) / angle;
+    return {{std::cos(0.5 * angle), r[0] * s, r[1] * s, r[2] * s}};
+}
+
+// 四元数 → 旋转向量（取最短旋转）
+Vec3 quatLog(Quat q) noexcept {
+    if (q[0] < 0.) {
+        for (auto& c : q) c = -c;
+    }
+    const double vn = std::sqrt(q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    if (vn < 1e-9) return vec3(2. * q[1], 2. * q[2], 2. * q[3]);
+    const double k = 2. * std::atan2(vn, q[0]) / vn;
+    return vec3(q[1] * k, q[2] * k, q[3] * k);
+}
+
+Mat3 quatToRot(const Quat& q) noexcept {
+    const double w = q[0], x = q[1], y = q[2], z = q[3];
+    Mat3 r;
+    r(0, 0) = 1. - 2. * (y * y + z * z);
+    r(0, 1) = 2. * (x * y - w * z);
+    r(0, 2) = 2. * (x * z + w * y);
+    r(1, 0) = 2. * (x * y + w * z);
+    r(1, 1) = 1. - 2. * (x * x + z * z);
+    r(1, 2) = 2. * (y * z - w * x);
+    r(2, 0) = 2. * (x * z - w * y);
+    r(2, 1) = 2. * (y * z + w * x);
+    r(2, 2) = 1. - 2. * (x * x + y * y);
+    return r;
+}
+
+Mat3 skew(const Vec3& v) noexcept {
+    Mat3 m;
+    m(0, 1) = -v[2];
+    m(0, 2) = v[1];
+    m(1, 0) = v[2];
+    m(1, 2) = -v[0];
+    m(2, 0) = -v[1];
+    m(2, 1) = v[0];
+    return m;
+}
+
+Quat axisQuat(int axis, double angle) noexcept {
+    Quat q{{std::cos(0.5 * angle), 0., 0., 0.}};
+    q[1 + axis] = std::sin(0.5 * angle);
+    return q;
+}
+
+void symmetrize(NavigationEkf::Cov& P) noexcept {
+    for (std::size_t r = 0; r < NavigationEkf::kStates; ++r) {
+        for (std::size_t c = r + 1; c < NavigationEkf::kStates; ++c) {
+            const double v = 0.5 * (P(r, c) + P(c, r));
+            P(r, c) = v;
+            P(c, r) = v;
+        }
+    }
+}
+
+} // namespace
+
+NavigationEkf::NavigationEkf(const NavigationEkfConfig& cfg) : cfg_(cfg) {
+    cfg_.snapshotIntervalNs = std::max<std::int64_t>(1'000'000, cfg_.snapshotIntervalNs);
+    cfg_.maxRejects = std::max(1, cfg_.maxRejects);
+    // 快照窗口内的 IMU 采样（按 1 kHz 估计）一次预留，重放不再分配
+    replay_.reserve(static_cast<std::size_t>(
+        std::max<std::int64_t>(256, kSnapshots * cfg_.snapshotIntervalNs / 1'000'000 + 64)));
+}
+
+void NavigationEkf::reset() {
+    initialized_ = false;
+    hasImu_ = false;
+    t_ = 0;
+    x_ = Nominal{};
+    P_ = Cov{};
+    snapBegin_ = snapEnd_ = 0;
+    measCount_ = 0;
+    posRejects_ = velRejects_ = poseRejects_ = 0;
+    stats_ = NavigationEkfStats{};
+}
+
+NavigationEkf::Quat NavigationEkf::levelAttitude(const sensors::ImuSample& sample, double headingRad) noexcept {
+    // 静止时比力指向天（机体系前-左-上）：右翼下时 fy > 0，抬头时 fx > 0
+    const double roll = std::atan2(sample.ay, sample.az);
+    const double pitch = std::atan2(sample.ax, std::sqrt(sample.ay * sample.ay + sample.az * sample.az));
+    const double yawEnu = M_PI / 2. - headingRad;  // 自北顺时针 → 自东逆时针
+    Quat q = quatMul(quatMul(axisQuat(2, yawEnu), axisQuat(1, -pitch)), axisQuat(0, roll));
+    quatNormalize(q);
+    return q;
+}
+
+void NavigationEkf::initialize(std::int64_t tNs, const Vec3& position, const Vec3& velocity, const Quat& attitude,
+                               bool yawKnown) {
+    x_ = Nominal{};
+    x_.p = position;
+    x_.v = velocity;
+    x_.q = attitude;
+    quatNormalize(x_.q);
+    const double pos = cfg_.initPosSigma * cfg_.initPosSigma;
+    const double vel = cfg_.initVelSigma * cfg_.initVelSigma;
+    const double tilt = cfg_.initTiltSigma * cfg_.initTiltSigma;
+    const double yaw = yawKnown ? tilt : cfg_.initYawSigma * cfg_.initYawSigma;
+    const double bg = cfg_.initGyroBiasSigma * cfg_.initGyroBiasSigma;
+    const double ba = cfg_.initAccelBiasSigma * cfg_.initAccelBiasSigma;
+    P_ = Cov::diagonal({pos, pos, pos, vel, vel, vel, tilt, tilt, yaw, bg, bg, bg, ba, ba, ba});
+    t_ = tNs;
+    initialized_ = true;
+    snapBegin_ = snapEnd_ = 0;
+    measCount_ = 0;
+    posRejects_ = velRejects_ = poseRejects_ = 0;
+    saveSnapshot();
+}
+
+void NavigationEkf::propagate(const sensors::ImuSample& sample) {
+    if (hasImu_ && sample.timestampNs <= lastImu_.timestampNs) return;
+    if (!initialized_) {
+        lastImu_ = sample;
+        hasImu_ = true;
+        return;
+    }
+    step(sample);
+    ++stats_.imuSamples;
+}
+
+void NavigationEkf::step(const sensors::ImuSample& sample) {
+    const auto tNs = static_cast<std::int64_t>(sample.timestampNs);
+    if (!hasImu_ || tNs <= t_) {
+        // 初始化时刻之前的采样只作为下一次中点积分的起点
+        lastImu_ = sample;
+        hasImu_ = true;
+        return;
+    }
+    const double dt = static_cast<double>(tNs - t_) * 1e-9;
+
+    // 中点法：相邻两采样的平均角速度 / 比力（扣除零偏）
+    const Vec3 w = vec3(0.5 * (lastImu_.gx + sample.gx) - x_.bg[0], 0.5 * (lastImu_.gy + sample.gy) - x_.bg[1],
+                        0.5 * (lastImu_.gz + sample.gz) - x_.bg[2]);
+    const Vec3 a = vec3(0.5 * (lastImu_.ax + sample.ax) - x_.ba[0], 0.5 * (lastImu_.ay + sample.ay) - x_.ba[1],
+                        0.5 * (lastImu_.az + sample.az) - x_.ba[2]);
+    const Mat3 R = quatToRot(x_.q);
+    Vec3 acc = R * a;
+    acc[2] -= cfg_.gravity;
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        x_.p[i] += x_.v[i] * dt + 0.5 * acc[i] * dt * dt;
+        x_.v[i] += acc[i] * dt;
+    }
+    const Vec3 dTheta = w * dt;
+    const Quat dq = quatExp(dTheta);
+    x_.q = quatMul(x_.q, dq);
+    quatNormalize(x_.q);
+
+    // 误差状态转移（姿态误差定义在机体系：q_true = q ⊗ Exp(δθ)）
+    Cov F = Cov::identity();
+    const Mat3 I3 = Mat3::identity();
+    F.setBlock(kP, kV, I3 * dt);
+    F.setBlock(kV, kTheta, (R * skew(a)) * -dt);
+    F.setBlock(kV, kBa, R * -dt);
+    F.setBlock(kTheta, kTheta, quatToRot(dq).transpose());
+    F.setBlock(kTheta, kBg, I3 * -dt);
+
+    P_ = F * P_ * F.transpose();
+    const double qa = cfg_.accelNoise * cfg_.accelNoise * dt;
+    const double qg = cfg_.gyroNoise * cfg_.gyroNoise * dt;
+    const double qbg = cfg_.gyroBiasWalk * cfg_.gyroBiasWalk * dt;
+    const double qba = cfg_.accelBiasWalk * cfg_.accelBiasWalk * dt;
+    for (std::size_t i = 0; i < 3; ++i) {
+        P_(kV + i, kV + i) += qa;
+        P_(kTheta + i, kTheta + i) += qg;
+        P_(kBg + i, kBg + i) += qbg;
+        P_(kBa + i, kBa + i) += qba;
+    }
+    symmetrize(P_);
+
+    t_ = tNs;
+    lastImu_ = sample;
+    if (snapEnd_ == snapBegin_ || t_ - snapshots_[(snapEnd_ - 1) % kSnapshots].t >= cfg_.snapshotIntervalNs) {
+        saveSnapshot();
+    }
+}
+
+void NavigationEkf::saveSnapshot() {
+    auto& s = snapshots_[snapEnd_ % kSnapshots];
+    s.t = t_;
+    s.x = x_;
+    s.P = P_;
+    s.lastImu = lastImu_;
+    ++snapEnd_;
+    if (snapEnd_ - snapBegin_ > kSnapshots) ++snapBegin_;
+}
+
+void NavigationEkf::refreshSnapshot() {
+    if (snapEnd_ == snapBegin_) return;
+    auto& s = snapshots_[(snapEnd_ - 1) % kSnapshots];
+    if (s.t != t_) return;
+    s.x = x_;
+    s.P = P_;
+    s.lastImu = lastImu_;
+}
+
+void NavigationEkf::replayTo(const sensors::ImuHistory& imu, std::int64_t untilNs) {
+    if (untilNs <= t_) return;
+    replay_.clear();
+    imu.samplesBetween(static_cast<std::uint64_t>(t_) + 1, static_cast<std::uint64_t>(untilNs), replay_);
+    for (const auto& s : replay_) step(s);
+    stats_.replayedSamples += replay_.size();
+    sensors::ImuSample tail;
+    if (t_ < untilNs && imu.at(static_cast<std::uint64_t>(untilNs), tail)) step(tail);
+}
+
+bool NavigationEkf::fusePosition(std::int64_t tNs, const Vec3& position, const Vec3& sigma,
+                                 const sensors::ImuHistory* imu) {
+    Measurement m;
+    m.kind = Measurement::Kind::Position;
+    m.t = tNs;
+    for (std::size_t i = 0; i < 3; ++i) {
+        m.z[i] = position[i];
+        m.sigma[i] = sigma[i];
+    }
+    return fuse(m, imu);
+}
+
+bool NavigationEkf::fuseVelocity(std::int64_t tNs, const Vec3& velocity, const Vec3& sigma,
+                                 const sensors::ImuHistory* imu) {
+    Measurement m;
+    m.kind = Measurement::Kind::Velocity;
+    m.t = tNs;
+    for (std::size_t i = 0; i < 3; ++i) {
+        m.z[i] = velocity[i];
+        m.sigma[i] = sigma[i];
+    }
+    return fuse(m, imu);
+}
+
+bool NavigationEkf::fusePose(std::int64_t tNs, const Vec3& position, const Quat& attitude, const Vec3& posSigma,
+                             const Vec3& attSigma, const sensors::ImuHistory* imu) {
+    Measurement m;
+    m.kind = Measurement::Kind::Pose;
+    m.t = tNs;
+    for (std::size_t i = 0; i < 3; ++i) {
+        m.z[i] = position[i];
+        m.sigma[i] = posSigma[i];
+        m.sigma[3 + i] = attSigma[i];
+    }
+    for (std::size_t i = 0; i < 4; ++i) m.z[3 + i] = attitude[i];
+    return fuse(m, imu);
+}
+
+bool NavigationEkf::fuse(const Measurement& m, const sensors::ImuHistory* imu) {
+    if (!initialized_) return false;
+
+    if (!imu || m.t >= t_) {
+        const bool ok = apply(m, false);
+        if (ok) {
+            measurements_[measCount_++ % kMeasurements] = m;
+            refreshSnapshot();
+        }
+        return ok;
+    }
+
+    if (t_ - m.t > cfg_.maxDelayNs) {
+        ++stats_.tooOld;
+        return false;
+    }
+    // 不晚于量测时刻的最新快照
+    std::uint64_t idx = snapEnd_;
+    while (idx > snapBegin_ && snapshots_[(idx - 1) % kSnapshots].t > m.t) --idx;
+    if (idx == snapBegin_) {
+        ++stats_.tooOld;
+        return false;
+    }
+    --idx;
+
+    // 快照之后已融合的量测，与新量测一起按时间排序（量测环很小，插入排序）
+    std::array<const Measurement*, kMeasurements + 1> pending{};
+    std::size_t n = 0;
+    const Snapshot& snap = snapshots_[idx % kSnapshots];
+    const std::uint64_t first = measCount_ > kMeasurements ? measCount_ - kMeasurements : 0;
+    for (std::uint64_t i = first; i < measCount_; ++i) {
+        const Measurement& old = measurements_[i % kMeasurements];
+        if (old.t > snap.t) pending[n++] = &old;
+    }
+    pending[n++] = &m;
+    for (std::size_t i = 1; i < n; ++i) {
+        for (std::size_t j = i; j > 0 && pending[j - 1]->t > pending[j]->t; --j) std::swap(pending[j - 1], pending[j]);
+    }
+
+    const std::int64_t headNs = t_;
+    t_ = snap.t;
+    x_ = snap.x;
+    P_ = snap.P;
+    lastImu_ = snap.lastImu;
+    snapEnd_ = idx + 1;  // 更新后的轨迹由重放重新保存快照
+
+    bool accepted = false;
+    for (std::size_t i = 0; i < n; ++i) {
+        replayTo(*imu, pending[i]->t);
+        const bool isNew = pending[i] == &m;
+        const bool ok = apply(*pending[i], !isNew);
+        if (isNew) accepted = ok;
+        refreshSnapshot();
+    }
+    replayTo(*imu, headNs);
+
+    if (accepted) {
+        measurements_[measCount_++ % kMeasurements] = m;
+        ++stats_.delayedUpdates;
+    }
+    return accepted;
+}
+
+bool NavigationEkf::apply(const Measurement& m, bool replaying) {
+    switch (m.kind) {
+        case Measurement::Kind::Position:
+        case Measurement::Kind::Velocity: {
+            const std::size_t block = m.kind == Measurement::Kind::Position ? kP : kV;
+            const Vec3& state = block == kP ? x_.p : x_.v;
+            core::Vector<double, 3> r;
+            core::Matrix<double, 3, kStates> H;
+            core::Matrix<double, 3, 3> R;
+            for (std::size_t i = 0; i < 3; ++i) {
+                r[i] = m.z[i] - state[i];
+                H(i, block + i) = 1.;
+                R(i, i) = m.sigma[i] * m.sigma[i];
+            }
+            return update(r, H, R, block == kP ? posRejects_ : velRejects_, replaying);
+        }
+        case Measurement::Kind::Pose: {
+            core::Vector<double, 6> r;
+            core::Matrix<double, 6, kStates> H;
+            core::Matrix<double, 6, 6> R;
+            const Quat zq{{m.z[3], m.z[4], m.z[5], m.z[6]}};
+            const Vec3 dTheta = quatLog(quatMul(quatConj(x_.q), zq));
+            for (std::size_t i = 0; i < 3; ++i) {
+                r[i] = m.z[i] - x_.p[i];
+                r[3 + i] = dTheta[i];
+                H(i, kP + i) = 1.;
+                H(3 + i, kTheta + i) = 1.;
+            }
+            for (std::size_t i = 0; i < 6; ++i) R(i, i) = m.sigma[i] * m.sigma[i];
+            return update(r, H, R, poseRejects_, replaying);
+        }
+    }
+    return false;
+}
+
+template <std::size_t M>
+bool NavigationEkf::update(const core::Vector<double, M>& residual, const core::Matrix<double, M, kStates>& H,
+                           const core::Matrix<double, M, M>& R, int& rejects, bool replaying) {
+    static_assert(M >= 1 && M <= 6, "measurement dimension out of range");
+    const auto Ht = H.transpose();
+    auto S = H * P_ * Ht + R;
+    core::Matrix<double, M, M> Sinv;
+    if (!choleskyInverse(S, Sinv)) return false;
+
+    if (cfg_.gating && !replaying) {
+        const double d2 = (residual.transpose() * Sinv * residual)[0];
+        if (!(d2 <= kChi2[M - 1])) {
+            ++stats_.rejected;
+            if (++rejects < cfg_.maxRejects) return false;
+            // 连续被拒：估计已发散（或长时间无量测），放开被量测状态的协方差后按量测重置
+            for (std::size_t i = 0; i < M; ++i) {
+                for (std::size_t j = 0; j < kStates; ++j) {
+                    if (H(i, j) == 0.) continue;
+                    for (std::size_t k = 0; k < kStates; ++k) P_(j, k) = P_(k, j) = 0.;
+                    P_(j, j) = 1e6;
+                }
+            }
+            ++stats_.resets;
+            S = H * P_ * Ht + R;
+            if (!choleskyInverse(S, Sinv)) return false;
+        }
+    }
+    rejects = 0;
+
+    const auto K = P_ * Ht * Sinv;
+    inject(K * residual);
+    // Joseph 形式保持协方差对称正定
+    const Cov IKH = Cov::identity() - K * H;
+    P_ = IKH * P_ * IKH.transpose() + K * R * K.transpose();
+    symmetrize(P_);
+    if (!replaying) ++stats_.updates;
+    return true;
+}
+
+void NavigationEkf::inject(const core::Vector<double, kStates>& dx) {
+    for (std::size_t i = 0; i < 3; ++i) {
+        x_.p[i] += dx[kP + i];
+        x_.v[i] += dx[kV + i];
+        x_.bg[i] += dx[kBg + i];
+        x_.ba[i] += dx[kBa + i];
+    }
+    x_.q = quatMul(x_.q, quatExp(dx.block<3, 1>(kTheta, 0)));
+    quatNormalize(x_.q);
+}
+
+void NavigationEkf::fill(NavState& out) const noexcept {
+    out.timestampNs = t_;
+    out.east = x_.p[0];
+    out.north = x_.p[1];
+    out.up = x_.p[2];
+    out.ve = x_.v[0];
+    out.vn = x_.v[1];
+    out.vu = x_.v[2];
+    out.qw = x_.q[0];
+    out.qx = x_.q[1];
+    out.qy = x_.q[2];
+    out.qz = x_.q[3];
+    const Mat3 R = quatToRot(x_.q);
+    out.roll = std::atan2(R(2, 1), R(2, 2));
+    out.pitch = std::asin(std::clamp(R(2, 0), -1., 1.));
+    double heading = std::atan2(R(0, 0), R(1, 0));
+    if (heading < 0.) heading += 2. * M_PI;
+    out.heading = heading;
+    // 机体系姿态误差换到导航系
+    const Mat3 attCov = R * P_.block<3, 3>(kTheta, kTheta) * R.transpose();
+    for (std::size_t i = 0; i < 3; ++i) {
+        out.posStd[i] = static_cast<float>(std::sqrt(std::max(0., P_(kP + i, kP + i))));
+        out.velStd[i] = static_cast<float>(std::sqrt(std::max(0., P_(kV + i, kV + i))));
+        out.attStd[i] = static_cast<float>(std::sqrt(std::max(0., attCov(i, i))));
+        out.gyroBias[i] = static_cast<float>(x_.bg[i]);
+        out.accelBias[i] = static_cast<float>(x_.ba[i]);
+    }
+    if (initialized_) out.status |= NavState::Initialized;
+    out.imuSamples = stats_.imuSamples;
+}
+
+} // namespace falconmind::sdk::mission
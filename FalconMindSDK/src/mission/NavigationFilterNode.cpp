@@ -0,0 +1,291 @@
+// FalconMindSDK - Navigation Filter Node Implementation
+#include "falconmind/sdk/mission/NavigationFilterNode.h"
+#include "falconmind/sdk/core/Pad.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace falconmind::sdk::mission {
+
+namespace {
+
+using Vec3 = NavigationEkf::Vec3;
+using Quat = NavigationEkf::Quat;
+
+constexpr double kGnssVelSigma = 0.3;        // UBX 速度量测 1σ（m/s）
+constexpr double kVioAnchorYawSigma = 0.2;   // 滤波航向 1σ 低于此值才对齐 VIO 坐标系（rad）
+
+Vec3 vec3(double x, double y, double z) noexcept {
+    Vec3 v;
+    v[0] = x;
+    v[1] = y;
+    v[2] = z;
+    return v;
+}
+
+// 四元数（w x y z）的 ENU 航向角：机体前轴投影自东逆时针
+double yawOf(const Quat& q) noexcept {
+    return std::atan2(2. * (q[0] * q[3] + q[1] * q[2]), 1. - 2. * (q[2] * q[2] + q[3] * q[3]));
+}
+
+// 左乘绕天轴旋转 yaw
+Quat rotateYaw(const Quat& q, double yaw) noexcept {
+    const double c = std::cos(0.5 * yaw), s = std::sin(0.5 * yaw);
+    return {{c * q[0] - s * q[3], c * q[1] - s * q[2], c * q[2] + s * q[1], c * q[3] + s * q[0]}};
+}
+
+double sigmaOr(double variance, double fallback) noexcept {
+    return variance > 0. && std::isfinite(variance) ? std::sqrt(variance) : fallback;
+}
+
+} // namespace
+
+NavigationFilterNode::NavigationFilterNode(sensors::ImuHistoryPtr imu, MissionBlackboardPtr board)
+    : core::Node("navigation_filter"),
+      imu_(std::move(imu)),
+      board_(board ? std::move(board) : std::make_shared<MissionBlackboard>()) {
+    imuBatch_.reserve(imu_ ? imu_->capacity() : 0);
+    addPad(std::make_shared<core::Pad>("gnss_in", core::PadType::Sink))
+        ->setDataCallback([this](const void* data, std::size_t size) {
+            if (size < sizeof(sensors::GnssSample)) {
+                rejected_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            Pending m;
+            m.kind = Pending::Kind::Gnss;
+            std::memcpy(&m.gnss, data, sizeof(m.gnss));
+            m.t = static_cast<std::int64_t>(m.gnss.timestampNs) - gnssDelayNs_;
+            enqueue(m);
+        });
+    addPad(std::make_shared<core::Pad>("vio_in", core::PadType::Sink))
+        ->setDataCallback([this](const void* data, std::size_t size) {
+            Pending m;
+            m.kind = Pending::Kind::Pose;
+            if (size >= sizeof(perception::PoseWithCovariance)) {
+                std::memcpy(&m.pose, data, sizeof(m.pose));
+                m.hasCovariance = true;
+            } else if (size >= sizeof(perception::Pose3D)) {
+                std::memcpy(&m.pose.pose, data, sizeof(m.pose.pose));
+            } else {
+                rejected_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            m.t = static_cast<std::int64_t>(m.pose.pose.timestampNs);
+            enqueue(m);
+        });
+    navPad_ = addPad(std::make_shared<core::Pad>("nav_out", core::PadType::Source));
+}
+
+void NavigationFilterNode::setOrigin(const GeoPoint& origin) {
+    frame_.setOrigin(origin);
+    hasOrigin_ = true;
+    // 已有的局部坐标随原点失效
+    if (ekf_.initialized()) ekf_.reset();
+    vioAnchored_ = false;
+}
+
+void NavigationFilterNode::setFilterConfig(const NavigationEkfConfig& cfg) {
+    ekf_ = NavigationEkf(cfg);
+    vioAnchored_ = false;
+}
+
+bool NavigationFilterNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    core::Node::configure(params);
+    auto number = [&params](const char* key, double& out) {
+        auto it = params.find(key);
+        if (it == params.end()) return false;
+        out = std::strtod(it->second.c_str(), nullptr);
+        return true;
+    };
+    double v = 0.;
+    GeoPoint origin{0., 0., 0.};
+    const bool hasLat = number("origin_lat", origin.lat);
+    const bool hasLon = number("origin_lon", origin.lon);
+    if (hasLat && hasLon) {
+        number("origin_alt", origin.alt);
+        setOrigin(origin);
+    }
+    if (number("gnss_delay_ms", v)) gnssDelayNs_ = static_cast<std::int64_t>(v * 1e6);
+    if (number("gnss_uere_m", v) && v > 0.) gnssUereM_ = v;
+    if (number("vio_pos_sigma_m", v) && v > 0.) vioPosSigma_ = v;
+    if (number("vio_att_sigma_rad", v) && v > 0.) vioAttSigma_ = v;
+    if (number("fusion_timeout_ms", v) && v > 0.) fusionTimeoutNs_ = static_cast<std::int64_t>(v * 1e6);
+
+    NavigationEkfConfig cfg = ekf_.config();
+    bool filterChanged = false;
+    if (number("max_delay_ms", v) && v >= 0.) {
+        cfg.maxDelayNs = static_cast<std::int64_t>(v * 1e6);
+        filterChanged = true;
+    }
+    if (number("accel_noise", v) && v > 0.) {
+        cfg.accelNoise = v;
+        filterChanged = true;
+    }
+    if (number("gyro_noise", v) && v > 0.) {
+        cfg.gyroNoise = v;
+        filterChanged = true;
+    }
+    if (filterChanged) setFilterConfig(cfg);
+    return true;
+}
+
+void NavigationFilterNode::enqueue(const Pending& m) {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    if (queued_ == kQueueCapacity) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    queue_[queued_++] = m;
+}
+
+void NavigationFilterNode::process() {
+    if (!imu_) return;
+
+    // 1. 新到的 IMU 采样全部传播
+    imuBatch_.clear();
+    imu_->samplesBetween(lastImuNs_ + 1, std::numeric_limits<std::uint64_t>::max(), imuBatch_);
+    if (imuBatch_.empty()) {
+        sensors::ImuSample latest;
+        if (imu_->latest(latest) && latest.timestampNs < lastImuNs_) {
+            // 时间轴重新开始（ImuHistory::restart）：旧状态不再可传播
+            ekf_.reset();
+            vioAnchored_ = false;
+            lastImuNs_ = 0;
+        }
+    }
+    for (const auto& s : imuBatch_) ekf_.propagate(s);
+    if (!imuBatch_.empty()) lastImuNs_ = imuBatch_.back().timestampNs;
+
+    // 2. 按量测时刻融合本轮收到的量测
+    std::size_t n = 0;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        n = queued_;
+        std::copy(queue_.begin(), queue_.begin() + static_cast<std::ptrdiff_t>(n), batch_.begin());
+        queued_ = 0;
+    }
+    std::sort(batch_.begin(), batch_.begin() + static_cast<std::ptrdiff_t>(n),
+              [](const Pending& a, const Pending& b) { return a.t < b.t; });
+    for (std::size_t i = 0; i < n; ++i) {
+        if (batch_[i].kind == Pending::Kind::Gnss) {
+            fuseGnss(batch_[i]);
+        } else {
+            fusePose(batch_[i]);
+        }
+    }
+
+    publish();
+}
+
+void NavigationFilterNode::fuseGnss(const Pending& m) {
+    const sensors::GnssSample& g = m.gnss;
+    if (g.fixQuality == 0 || !std::isfinite(g.latitude) || !std::isfinite(g.longitude) || !std::isfinite(g.altitude)) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const GeoPoint geo{g.latitude, g.longitude, g.altitude};
+    if (!hasOrigin_) setOrigin(geo);
+    const EnuPoint enu = frame_.toEnu(geo);
+    const Vec3 position = vec3(enu.east, enu.north, enu.up);
+
+    const double h = g.horizontalAccuracyM > 0.f ? g.horizontalAccuracyM : std::max(0.5f, g.hdop) * gnssUereM_;
+    const double vert = g.verticalAccuracyM > 0.f ? g.verticalAccuracyM
+                        : g.vdop < 50.f        ? std::max(0.5f, g.vdop) * gnssUereM_
+                                               : 1.5 * h;
+    // UBX NAV-PVT 同时给出精度与 NED 速度
+    const bool hasVelocity = g.horizontalAccuracyM > 0.f;
+    const Vec3 velocity = hasVelocity ? vec3(g.velEast, g.velNorth, -g.velDown) : Vec3{};
+
+    if (!ekf_.initialized()) {
+        const sensors::ImuSample& imu = ekf_.lastImu();
+        if (imu.timestampNs == 0) return;  // 等待 IMU 调平
+        ekf_.initialize(static_cast<std::int64_t>(imu.timestampNs), position, velocity,
+                        NavigationEkf::levelAttitude(imu, 0.), false);
+        lastGnssNs_ = m.t;
+        return;
+    }
+    if (ekf_.fusePosition(m.t, position, vec3(h, h, vert), imu_.get())) {
+        ++gnssUpdates_;
+        lastGnssNs_ = m.t;
+    }
+    if (hasVelocity) {
+        ekf_.fuseVelocity(m.t, velocity, vec3(kGnssVelSigma, kGnssVelSigma, kGnssVelSigma), imu_.get());
+    }
+}
+
+void NavigationFilterNode::fusePose(const Pending& m) {
+    const perception::Pose3D& pose = m.pose.pose;
+    const Quat q{{pose.qw, pose.qx, pose.qy, pose.qz}};
+    const double qn = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+    if (!std::isfinite(pose.x) || !std::isfinite(pose.y) || !std::isfinite(pose.z) || !(qn > 0.5 && qn < 1.5)) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (!ekf_.initialized()) {
+        // 无 GNSS：原点视为起飞点，航向取 VIO
+        const sensors::ImuSample& imu = ekf_.lastImu();
+        if (!hasOrigin_ || imu.timestampNs == 0) return;
+        ekf_.initialize(static_cast<std::int64_t>(imu.timestampNs), Vec3{}, Vec3{},
+                        NavigationEkf::levelAttitude(imu, M_PI / 2. - yawOf(q)), true);
+    }
+    if (!vioAnchored_) {
+        // 航向未收敛（GNSS 初始化后尚未机动）时对齐会把错误航向固化进 VIO 坐标变换，先等待
+        NavState st;
+        ekf_.fill(st);
+        if (st.attStd[2] > kVioAnchorYawSigma) return;
+        vioYaw_ = yawOf(ekf_.attitude()) - yawOf(q);
+        const double c = std::cos(vioYaw_), s = std::sin(vioYaw_);
+        vioOffset_[0] = ekf_.position()[0] - (c * pose.x - s * pose.y);
+        vioOffset_[1] = ekf_.position()[1] - (s * pose.x + c * pose.y);
+        vioOffset_[2] = ekf_.position()[2] - pose.z;
+        vioAnchored_ = true;
+        return;
+    }
+
+    const double c = std::cos(vioYaw_), s = std::sin(vioYaw_);
+    const Vec3 position = vec3(c * pose.x - s * pose.y + vioOffset_[0], s * pose.x + c * pose.y + vioOffset_[1],
+                               pose.z + vioOffset_[2]);
+    const Quat attitude = rotateYaw(q, vioYaw_);
+    const double* cov = m.pose.covariance;
+    const Vec3 posSigma = m.hasCovariance ? vec3(sigmaOr(cov[0], vioPosSigma_), sigmaOr(cov[7], vioPosSigma_),
+                                                 sigmaOr(cov[14], vioPosSigma_))
+                                          : vec3(vioPosSigma_, vioPosSigma_, vioPosSigma_);
+    const Vec3 attSigma = m.hasCovariance ? vec3(sigmaOr(cov[21], vioAttSigma_), sigmaOr(cov[28], vioAttSigma_),
+                                                 sigmaOr(cov[35], vioAttSigma_))
+                                          : vec3(vioAttSigma_, vioAttSigma_, vioAttSigma_);
+    if (ekf_.fusePose(m.t, position, attitude, posSigma, attSigma, imu_.get())) {
+        ++vioUpdates_;
+        lastVioNs_ = m.t;
+    }
+}
+
+void NavigationFilterNode::publish() {
+    if (!ekf_.initialized()) return;
+    const std::uint64_t updates = ekf_.stats().updates;
+    if (ekf_.timestampNs() == publishedNs_ && updates == publishedUpdates_) return;
+    publishedNs_ = ekf_.timestampNs();
+    publishedUpdates_ = updates;
+
+    NavState st;
+    ekf_.fill(st);
+    if (hasOrigin_) {
+        const GeoPoint geo = frame_.toGeo(EnuPoint{st.east, st.north, st.up});
+        st.lat = geo.lat;
+        st.lon = geo.lon;
+        st.alt = geo.alt;
+        st.status |= NavState::OriginSet;
+    }
+    if (lastGnssNs_ != 0 && st.timestampNs - lastGnssNs_ <= fusionTimeoutNs_) st.status |= NavState::GnssFused;
+    if (lastVioNs_ != 0 && st.timestampNs - lastVioNs_ <= fusionTimeoutNs_) st.status |= NavState::VioFused;
+    st.gnssUpdates = gnssUpdates_;
+    st.vioUpdates = vioUpdates_;
+
+    board_->set<bb::Navigation>(st);
+    navPad_->pushToConnections(&st, sizeof(st));
+}
+
+} // namespace falconmind::sdk::mission
@@ -3,8 +3,11 @@
 #include "falconmind/sdk/flight/FlightTypes.h"
 #include "falconmind/sdk/flight/FlightConnectionService.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <chrono>
+#include <iostream>
 
 namespace falconmind::sdk::mission {
 
@@ -31,29 +34,170 @@ void SearchMissionAction::setSearchParams(const SearchParams& params) {
     }
 }
 
-bool SearchMissionAction::isWaypointReached(const GeoPoint& waypoint, 
-                                            const GeoPoint& currentPos, 
-                                            double tolerance) {
-    // 计算两点之间的距离（使用 Haversine 公式的简化版本）
-    const double lat1 = waypoint.lat * M_PI / 180.0;
-    const double lat2 = currentPos.lat * M_PI / 180.0;
-    const double dLat = (currentPos.lat - waypoint.lat) * M_PI / 180.0;
-    const double dLon = (currentPos.lon - waypoint.lon) * M_PI / 180.0;
-    
-    const double a = std::sin(dLat / 2) * std::sin(dLat / 2) +
-                     std::cos(lat1) * std::cos(lat2) *
-                     std::sin(dLon / 2) * std::sin(dLon / 2);
-    const double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
-    const double distance = 6371000.0 * c; // 地球半径（米）
+bool SearchMissionAction::isWaypointReached(std::size_t index, const GeoPoint& currentPos, double tolerance) const {
+    const auto& waypoints = pathPlanner_->getWaypoints();
+    const auto& waypointsEnu = pathPlanner_->getWaypointsEnu();
+    if (index >= waypoints.size() || index >= waypointsEnu.size()) {
+        return false;
+    }
     
-    const double altDiff = std::abs(currentPos.alt - waypoint.alt);
+    const EnuPoint current = pathPlanner_->frame().toEnu({currentPos.lat, currentPos.lon, 0.0});
+    const double altDiff = std::abs(currentPos.alt - waypoints[index].alt);
     
-    return distance < tolerance && altDiff < tolerance;
+    return horizontalDistanceSq(waypointsEnu[index], current) < tolerance * tolerance && altDiff < tolerance;
+}
+
+void SearchMissionAction::setObstacleAvoidance(std::shared_ptr<planning::ObstacleCloudNode> cloud,
+                                               const planning::OccupancyGridConfig& config) {
+    obstacleCloud_ = std::move(cloud);
+    if (!obstacleCloud_) {
+        grid_.reset();
+        dstar_.reset();
+        hasDetour_ = false;
+        return;
+    }
+    grid_ = std::make_unique<planning::OccupancyGrid>(config);
+    dstar_ = std::make_unique<planning::DStarLitePlanner>(*grid_);
+    detourWaypoint_ = -1;
+    hasDetour_ = false;
+}
+
+bool SearchMissionAction::activeDetour(EnuPoint& next) const {
+    if (!hasDetour_) return false;
+    next = detourPoint_;
+    return true;
+}
+
+void SearchMissionAction::updateDetour(std::size_t index, const GeoPoint& currentPos, double yaw) {
+    const auto& waypointsEnu = pathPlanner_->getWaypointsEnu();
+    if (!grid_ || index >= waypointsEnu.size()) {
+        hasDetour_ = false;
+        return;
+    }
+
+    const EnuPoint p = pathPlanner_->frame().toEnu({currentPos.lat, currentPos.lon, currentPos.alt});
+    obstacleCloud_->setPose({p.east, p.north, p.up, yaw, true});
+    changedCells_.clear();
+    if (obstacleCloud_->takeObstaclePoints(obstacleEast_, obstacleNorth_) > 0) {
+        grid_->insertObstacles(obstacleEast_.data(), obstacleNorth_.data(), obstacleEast_.size(), changedCells_);
+    }
+
+    // 直线可达则直接飞向航点（障碍已绕过或消失时同样退出绕行）
+    const EnuPoint& target = waypointsEnu[index];
+    if (!grid_->segmentBlocked(p.east, p.north, target.east, target.north)) {
+        hasDetour_ = false;
+        return;
+    }
+
+    planning::GridCell start, goal;
+    if (!grid_->toCell(p.east, p.north, start) || !grid_->toCell(target.east, target.north, goal)) {
+        hasDetour_ = false;
+        return;
+    }
+    // 同一航点只做增量修复：起点移动累加 km，仅变化单元附近重新展开
+    const bool ok = (detourWaypoint_ == static_cast<int>(index) && dstar_->hasPlan() && dstar_->goal() == goal)
+                        ? dstar_->replan(start, changedCells_)
+                        : dstar_->plan(start, goal);
+    detourWaypoint_ = static_cast<int>(index);
+    if (!ok || !dstar_->extractPath(detourCells_)) {
+        hasDetour_ = false;
+        return;
+    }
+
+    // 沿路径取直线可达的最远单元作为下一个中间点（路径的前缀总是可达）
+    std::size_t far = std::min<std::size_t>(1, detourCells_.size() - 1);
+    for (std::size_t i = far + 1; i < detourCells_.size(); ++i) {
+        double e, n;
+        grid_->cellCenter(detourCells_[i], e, n);
+        if (grid_->segmentBlocked(p.east, p.north, e, n)) break;
+        far = i;
+    }
+    grid_->cellCenter(detourCells_[far], detourPoint_.east, detourPoint_.north);
+    detourPoint_.up = target.up;
+    hasDetour_ = true;
+}
+
+bool SearchMissionAction::ensureCoverage() {
+    if (coverage_) {
+        return true;
+    }
+    const auto& rings = pathPlanner_->getAreaRings();
+    if (rings.empty()) {
+        return false;
+    }
+    // 单元取扫描间距的 1/8（不小于 1 m）
+    const double spacing = searchParams_.spacing > 0 ? searchParams_.spacing : 50.0;
+    coverage_ = std::make_unique<CoverageMap>(rings, std::max(1.0, spacing / 8.0));
+    return true;
+}
+
+void SearchMissionAction::updateCoverage(const GeoPoint& currentPos, double yaw) {
+    const double spacing = searchParams_.spacing > 0 ? searchParams_.spacing : 50.0;
+    if (!ensureCoverage()) {
+        return;
+    }
+
+    const EnuPoint p = pathPlanner_->frame().toEnu({currentPos.lat, currentPos.lon, 0.0});
+    std::array<PlanarPoint, 4> quad;
+    if (searchParams_.cameraHfov > 0 && searchParams_.cameraVfov > 0) {
+        // 以规划高度作为离地高度
+        quad = nadirFootprint({p.east, p.north}, searchParams_.altitude, yaw,
+                              searchParams_.cameraHfov * M_PI / 180.0, searchParams_.cameraVfov * M_PI / 180.0);
+    } else {
+        const double half = spacing / 2.0;
+        quad = {{{p.east - half, p.north - half}, {p.east + half, p.north - half},
+                 {p.east + half, p.north + half}, {p.east - half, p.north + half}}};
+    }
+    coverage_->markPolygon(quad.data(), quad.size());
+}
+
+void SearchMissionAction::setMissionUpload(bool enabled, const flight::MissionUploadOptions& options) {
+    uploadOptions_ = options;
+    uploadState_ = enabled ? UploadState::Pending : UploadState::Off;
+}
+
+bool SearchMissionAction::readFlightState(flight::FlightState& state) {
+    // 黑板上先登记等待再读取，下一次状态写入时执行器才会再次 tick 本节点
+    if (blackboard_) {
+        waitFor(blackboard_->changed<bb::FlightState>());
+        return blackboard_->tryGet<bb::FlightState>(state);
+    }
+    state = flightSvc_.getLastState();
+    return true;
+}
+
+void SearchMissionAction::reportWaypointReached(std::size_t index, const GeoPoint& currentPos) {
+    const auto& waypoints = pathPlanner_->getWaypoints();
+    SearchEvent event;
+    event.type = SearchEventType::WAYPOINT_REACHED;
+    event.description = "Reached waypoint " + std::to_string(index);
+    event.position = waypoints[index];
+    auto now = std::chrono::system_clock::now();
+    auto duration = now.time_since_epoch();
+    event.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+
+    if (eventReporter_) {
+        eventReporter_->reportSearchEvent(event);
+    }
+
+    // 更新搜索进度
+    SearchProgress progress;
+    progress.coveragePercent = coverage_ ? coverage_->coverage()
+                                         : static_cast<double>(index + 1) / waypoints.size();
+    progress.waypointIndex = static_cast<int>(index + 1);
+    progress.totalWaypoints = waypoints.size();
+    progress.currentPosition = currentPos;
+
+    if (eventReporter_) {
+        eventReporter_->reportSearchProgress(progress);
+    }
 }
 
 NodeStatus SearchMissionAction::executeWaypointMission() {
-    // 获取当前飞行状态
-    flight::FlightState currentState = flightSvc_.getLastState();
+    flight::FlightState currentState;
+    if (!readFlightState(currentState)) {
+        return NodeStatus::Running;
+    }
     
     // 获取航点列表
     const auto& waypoints = pathPlanner_->getWaypoints();
@@ -66,45 +210,152 @@ NodeStatus SearchMissionAction::executeWaypointMission() {
         return NodeStatus::Success;
     }
     
-    const auto& targetWaypoint = waypoints[currentWaypointIndex_];
-    
-    // TODO: 发送航点命令到 PX4
-    // 这里简化处理，实际应该使用 MAVLink MISSION_ITEM_INT
-    
     // 检查是否到达航点
     GeoPoint currentPos{currentState.lat, currentState.lon, currentState.alt};
-    if (isWaypointReached(targetWaypoint, currentPos)) {
+    updateCoverage(currentPos, currentState.yaw);
+    updateDetour(static_cast<std::size_t>(currentWaypointIndex_), currentPos, currentState.yaw);
+
+    // TODO: 发送航点命令到 PX4（有绕行时先飞 activeDetour() 给出的中间点）
+    // 无需绕行的整条航线可用 setMissionUpload 一次性上传（见 executeUploadedMission）
+
+    if (isWaypointReached(static_cast<std::size_t>(currentWaypointIndex_), currentPos)) {
         // 到达航点，上报事件
-        SearchEvent event;
-        event.type = SearchEventType::WAYPOINT_REACHED;
-        event.description = "Reached waypoint " + std::to_string(currentWaypointIndex_);
-        event.position = targetWaypoint;
-        auto now = std::chrono::system_clock::now();
-        auto duration = now.time_since_epoch();
-        event.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
-        
-        if (eventReporter_) {
-            eventReporter_->reportSearchEvent(event);
-        }
-        
+        reportWaypointReached(static_cast<std::size_t>(currentWaypointIndex_), currentPos);
         currentWaypointIndex_++;
-        
-        // 更新搜索进度
-        SearchProgress progress;
-        progress.coveragePercent = static_cast<double>(currentWaypointIndex_) / waypoints.size();
-        progress.waypointIndex = currentWaypointIndex_;
-        progress.totalWaypoints = waypoints.size();
-        progress.currentPosition = currentPos;
-        
-        if (eventReporter_) {
-            eventReporter_->reportSearchProgress(progress);
-        }
     }
     
     return NodeStatus::Running;
 }
 
+NodeStatus SearchMissionAction::executeUploadedMission() {
+    const auto& waypoints = pathPlanner_->getWaypoints();
+    if (waypoints.empty()) {
+        return NodeStatus::Failure;
+    }
+
+    if (uploadState_ == UploadState::Pending) {
+        // 航点高度即规划的飞行高度（相对起飞点），到达半径与逐航点引导的判定一致
+        std::vector<flight::MissionItem> items;
+        items.reserve(waypoints.size());
+        for (const auto& wp : waypoints) {
+            items.push_back(flight::MissionItem::waypoint(wp.lat, wp.lon, static_cast<float>(wp.alt), 5.f));
+        }
+        uploadStateSeq_ = flightSvc_.stateVersion();
+        upload_ = flightSvc_.uploadMission(std::move(items), uploadOptions_);
+        uploadState_ = UploadState::Uploading;
+        return NodeStatus::Running;
+    }
+
+    if (uploadState_ == UploadState::Uploading) {
+        if (upload_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return NodeStatus::Running;
+        }
+        const flight::MissionUploadAck ack = upload_.get();
+        if (!ack.accepted()) {
+            std::cerr << "[SearchMissionAction] mission upload failed (result " << static_cast<int>(ack.result)
+                      << "), falling back to per-waypoint guidance" << std::endl;
+            uploadState_ = UploadState::Failed;
+            return NodeStatus::Running;
+        }
+        flight::FlightCommand cmd;
+        cmd.type = flight::FlightCommandType::MissionStart;
+        flightSvc_.sendCommand(cmd);
+        uploadState_ = UploadState::Executing;
+        return NodeStatus::Running;
+    }
+
+    flight::FlightState currentState;
+    if (!readFlightState(currentState)) {
+        return NodeStatus::Running;
+    }
+    GeoPoint currentPos{currentState.lat, currentState.lon, currentState.alt};
+    updateCoverage(currentPos, currentState.yaw);
+
+    // 飞控报告的进度：已到达的最大序号（MISSION_ITEM_REACHED，或 MISSION_CURRENT 已前进到下一项）
+    const std::size_t mission = static_cast<std::size_t>(flight::FlightField::Mission);
+    if (currentState.fieldSeq[mission] > uploadStateSeq_) {
+        const int total = static_cast<int>(waypoints.size());
+        int reached = std::max(currentState.missionReached, currentState.missionSeq - 1);
+        if (currentState.missionState == 5) reached = total - 1;  // MISSION_STATE_COMPLETE
+        reached = std::min(reached, total - 1);
+        while (currentWaypointIndex_ <= reached) {
+            reportWaypointReached(static_cast<std::size_t>(currentWaypointIndex_), currentPos);
+            currentWaypointIndex_++;
+        }
+    }
+    return currentWaypointIndex_ >= static_cast<int>(waypoints.size()) ? NodeStatus::Success : NodeStatus::Running;
+}
+
+void SearchMissionAction::saveState(core::CheckpointWriter& out) const {
+    out.pod(static_cast<std::uint8_t>(state_));
+    out.pod(static_cast<std::int32_t>(currentWaypointIndex_));
+    out.pod(static_cast<std::uint8_t>(armingDone_));
+    out.pod(static_cast<std::uint8_t>(takeoffDone_));
+    out.pod(static_cast<std::uint8_t>(uploadState_));
+    out.pod(static_cast<std::uint32_t>(pathPlanner_ ? pathPlanner_->getWaypoints().size() : 0));
+    out.pod(static_cast<std::uint8_t>(coverage_ != nullptr));
+    if (coverage_) {
+        coverage_->saveState(out);
+    }
+}
+
+bool SearchMissionAction::restoreState(core::CheckpointReader& in) {
+    std::uint8_t state = 0, arming = 0, takeoff = 0, upload = 0, hasCoverage = 0;
+    std::int32_t waypoint = 0;
+    std::uint32_t waypointCount = 0;
+    if (!in.pod(state) || !in.pod(waypoint) || !in.pod(arming) || !in.pod(takeoff) || !in.pod(upload) ||
+        !in.pod(waypointCount) || !in.pod(hasCoverage)) {
+        return false;
+    }
+    if (state > static_cast<std::uint8_t>(MissionState::COMPLETE) ||
+        upload > static_cast<std::uint8_t>(UploadState::Failed)) {
+        return false;
+    }
+    // 航线须与检查点时一致（同一区域与参数），否则航点序号没有意义
+    if (!pathPlanner_ || pathPlanner_->getWaypoints().size() != waypointCount) {
+        return false;
+    }
+    if (hasCoverage && (!ensureCoverage() || !coverage_->restoreState(in))) {
+        coverage_.reset();
+        return false;
+    }
+    state_ = static_cast<MissionState>(state);
+    currentWaypointIndex_ = waypoint;
+    armingDone_ = arming != 0;
+    takeoffDone_ = takeoff != 0;
+    uploadState_ = static_cast<UploadState>(upload);
+    if (uploadState_ == UploadState::Uploading) {
+        // 上传确认随进程丢失：重新上传
+        uploadState_ = UploadState::Pending;
+    }
+    uploadStateSeq_ = 0;
+    return true;
+}
+
 NodeStatus SearchMissionAction::tick() {
+    if (checkpoint_ && !checkpointChecked_) {
+        checkpointChecked_ = true;
+        restored_ = checkpoint_->restore([this](core::CheckpointReader& in) { return restoreState(in); });
+        if (restored_) {
+            std::cout << "[SearchMissionAction] resumed from checkpoint: waypoint " << currentWaypointIndex_
+                      << (coverage_ ? ", coverage " + std::to_string(coverage_->coverage() * 100.0) + "%" : "")
+                      << std::endl;
+        }
+    }
+    const NodeStatus status = advance();
+    if (checkpoint_) {
+        const std::int64_t nowNs = core::PipelineClock::nowNs();
+        // 阶段或航点变化（如解锁、起飞命令已发出）立即写入，覆盖位图的变化按区段周期写入
+        const bool force = status != NodeStatus::Running || lastSavedState_ != state_ ||
+                           lastSavedWaypoint_ != currentWaypointIndex_;
+        checkpoint_->save(nowNs, [this](core::CheckpointWriter& out) { saveState(out); }, force);
+        lastSavedState_ = state_;
+        lastSavedWaypoint_ = currentWaypointIndex_;
+    }
+    return status;
+}
+
+NodeStatus SearchMissionAction::advance() {
     switch (state_) {
         case MissionState::IDLE:
             // 配置路径规划器
@@ -144,7 +395,8 @@ NodeStatus SearchMissionAction::tick() {
             return NodeStatus::Running;
             
         case MissionState::SEARCHING: {
-            NodeStatus status = executeWaypointMission();
+            const bool uploaded = uploadState_ != UploadState::Off && uploadState_ != UploadState::Failed && !grid_;
+            NodeStatus status = uploaded ? executeUploadedMission() : executeWaypointMission();
             if (status == NodeStatus::Success) {
                 // 搜索完成
                 SearchEvent event;
@@ -5,7 +5,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <iostream>
 #include <limits>
+#include <sstream>
 
 namespace falconmind::sdk::mission {
 
@@ -16,13 +19,63 @@ SearchPathPlannerNode::SearchPathPlannerNode() : core::Node("search_path_planner
 
 bool SearchPathPlannerNode::configure(const std::unordered_map<std::string, std::string>& params) {
     core::Node::configure(params);
+    auto idIt = params.find("uav_id");
+    if (idIt != params.end()) {
+        selfId_ = idIt->second;
+    }
+    auto teamIt = params.find("team");
+    if (teamIt != params.end()) {
+        // "id[:weight],id[:weight],..."
+        std::vector<CoverageMember> team;
+        std::stringstream ss(teamIt->second);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            item.erase(0, item.find_first_not_of(" \t"));
+            item.erase(item.find_last_not_of(" \t") + 1);
+            if (item.empty()) continue;
+            CoverageMember m;
+            const auto colon = item.find(':');
+            m.id = item.substr(0, colon);
+            if (colon != std::string::npos) {
+                try {
+                    m.weight = std::stod(item.substr(colon + 1));
+                } catch (const std::exception&) {
+                    std::cerr << "[SearchPathPlannerNode] invalid team weight: " << item << std::endl;
+                    return false;
+                }
+            }
+            team.push_back(std::move(m));
+        }
+        team_ = std::move(team);
+    }
+    auto number = [&params](const char* key, double& out) {
+        auto it = params.find(key);
+        if (it != params.end()) out = std::strtod(it->second.c_str(), nullptr);
+    };
+    number("terrain_spacing", terrainSpacing_);
+    number("terrain_tolerance", terrainTolerance_);
+    auto followIt = params.find("terrain_following");
+    if (followIt != params.end()) {
+        terrainFollowing_ = followIt->second == "1" || followIt->second == "true" || followIt->second == "yes";
+    }
+    auto terrainIt = params.find("terrain_file");
+    if (terrainIt != params.end() && !terrainIt->second.empty()) {
+        perception::TerrainCacheConfig cfg;
+        double budgetMb = static_cast<double>(cfg.residentBudgetBytes >> 20);
+        number("terrain_budget_mb", budgetMb);
+        cfg.residentBudgetBytes = static_cast<std::size_t>(std::max(1.0, budgetMb) * (1u << 20));
+        terrain_ = perception::TerrainTileCache::open(terrainIt->second, cfg);
+        if (!terrain_) return false;
+    }
     configured_ = true;
     return true;
 }
 
 bool SearchPathPlannerNode::start() {
     core::Node::start();
-    // 生成路径
+    projectArea();
+    // 生成路径（ENU 平面，米）
+    waypointsEnu_.clear();
     switch (searchParams_.pattern) {
         case SearchPattern::LAWN_MOWER:
             generateLawnMowerPath();
@@ -38,10 +91,26 @@ bool SearchPathPlannerNode::start() {
             break;
         case SearchPattern::WAYPOINT_LIST:
             // WAYPOINT_LIST 模式直接使用提供的航点，不需要生成
+            waypointsEnu_ = frame_.toEnu(waypoints_);
+            for (auto& p : waypointsEnu_) p.up = 0.0;
             break;
     }
+    if (searchParams_.pattern != SearchPattern::WAYPOINT_LIST) {
+        waypoints_ = frame_.toGeo(waypointsEnu_);
+        for (auto& p : waypoints_) p.alt = searchParams_.altitude;
+    }
     // 优化路径：移除重复点、优化航点顺序
     optimizePath();
+    if (terrain_ && terrainFollowing_) applyTerrainFollowing();
+    if (terrain_ && !waypoints_.empty()) {
+        std::vector<double> lat(waypoints_.size()), lon(waypoints_.size());
+        for (std::size_t i = 0; i < waypoints_.size(); ++i) {
+            lat[i] = waypoints_[i].lat;
+            lon[i] = waypoints_[i].lon;
+        }
+        terrain_->prefetchPath(lat.data(), lon.data(), lat.size());
+    }
+    buildTrajectory();
     return true;
 }
 
@@ -62,162 +131,149 @@ void SearchPathPlannerNode::setSearchParams(const SearchParams& params) {
     searchParams_ = params;
 }
 
-void SearchPathPlannerNode::computeBoundingBox(const std::vector<GeoPoint>& polygon,
-                                              double& minLat, double& maxLat,
-                                              double& minLon, double& maxLon) {
-    if (polygon.empty()) {
-        minLat = maxLat = minLon = maxLon = 0.0;
+void SearchPathPlannerNode::setTeam(const std::vector<CoverageMember>& team, const std::string& selfId) {
+    team_ = team;
+    selfId_ = selfId;
+}
+
+void SearchPathPlannerNode::setTerrain(std::shared_ptr<const perception::TerrainTileCache> terrain, bool follow) {
+    terrain_ = std::move(terrain);
+    terrainFollowing_ = follow;
+}
+
+void SearchPathPlannerNode::projectArea() {
+    frame_.setOrigin(LocalEnuFrame::boundsCenter(searchArea_.polygon));
+    rings_.clear();
+    areaIndex_.build({});
+    if (searchArea_.polygon.size() < 3) {
         return;
     }
-    
-    minLat = maxLat = polygon[0].lat;
-    minLon = maxLon = polygon[0].lon;
-    
-    for (const auto& point : polygon) {
-        minLat = std::min(minLat, point.lat);
-        maxLat = std::max(maxLat, point.lat);
-        minLon = std::min(minLon, point.lon);
-        maxLon = std::max(maxLon, point.lon);
+    auto toPlanar = [this](const std::vector<GeoPoint>& ring) {
+        std::vector<PlanarPoint> out;
+        out.reserve(ring.size());
+        for (const auto& p : ring) {
+            // 区域顶点按地表（高度 0）投影，避免顶点高度差引起水平偏移
+            const EnuPoint e = frame_.toEnu({p.lat, p.lon, 0.0});
+            out.push_back({e.east, e.north});
+        }
+        return out;
+    };
+    rings_.reserve(1 + searchArea_.holes.size());
+    rings_.push_back(toPlanar(searchArea_.polygon));
+    for (const auto& hole : searchArea_.holes) {
+        if (hole.size() >= 3) rings_.push_back(toPlanar(hole));
+    }
+    // 外边界 + 孔洞作为单个允许区建立索引，供扇形 / 螺旋 / Z 字形航点裁剪
+    GeofenceZone area;
+    area.type = GeofenceType::KeepIn;
+    area.rings = rings_;
+    areaIndex_.build({std::move(area)});
+}
+
+void SearchPathPlannerNode::computeBoundingBox(double& minE, double& maxE, double& minN, double& maxN) const {
+    if (rings_.empty()) {
+        minE = maxE = minN = maxN = 0.0;
+        return;
+    }
+    const auto& outer = rings_[0];
+    minE = maxE = outer[0].x;
+    minN = maxN = outer[0].y;
+    for (const auto& point : outer) {
+        minE = std::min(minE, point.x);
+        maxE = std::max(maxE, point.x);
+        minN = std::min(minN, point.y);
+        maxN = std::max(maxN, point.y);
     }
 }
 
 void SearchPathPlannerNode::generateLawnMowerPath() {
-    waypoints_.clear();
-    
-    if (searchArea_.polygon.size() < 3) {
+    if (rings_.empty()) {
         return; // 无效的多边形
     }
     
-    // 计算边界框
-    double minLat, maxLat, minLon, maxLon;
-    computeBoundingBox(searchArea_.polygon, minLat, maxLat, minLon, maxLon);
-    
-    // 优化的网格搜索：使用多边形裁剪，只保留在多边形内的航点
     const double spacing = searchParams_.spacing > 0 ? searchParams_.spacing : 50.0; // 默认50米
     
-    // 将间距从米转换为度数（近似）
-    // 1度纬度 ≈ 111km，1度经度 ≈ 111km * cos(纬度)
-    const double latCenter = (minLat + maxLat) / 2.0;
-    const double latSpacing = spacing / 111000.0; // 转换为度数
-    const double lonSpacing = spacing / (111000.0 * std::cos(latCenter * M_PI / 180.0));
-    
-    // 生成网格点
-    std::vector<GeoPoint> gridPoints = generateGridPoints(minLat, maxLat, minLon, maxLon, latSpacing, lonSpacing);
-    
-    // 按行组织网格点，生成蛇形路径
-    bool leftToRight = true;
-    double currentLat = minLat;
-    std::vector<GeoPoint> rowPoints;
-    
-    while (currentLat <= maxLat) {
-        rowPoints.clear();
-        // 收集当前行的点
-        for (const auto& point : gridPoints) {
-            if (std::abs(point.lat - currentLat) < latSpacing / 2.0) {
-                if (isPointInPolygon(point, searchArea_.polygon)) {
-                    rowPoints.push_back(point);
-                }
-            }
-        }
-        
-        // 按经度排序
-        std::sort(rowPoints.begin(), rowPoints.end(),
-                  [](const GeoPoint& a, const GeoPoint& b) { return a.lon < b.lon; });
-        
-        // 根据方向添加航点
-        if (!rowPoints.empty()) {
-            if (leftToRight) {
-                waypoints_.insert(waypoints_.end(), rowPoints.begin(), rowPoints.end());
-            } else {
-                waypoints_.insert(waypoints_.end(), rowPoints.rbegin(), rowPoints.rend());
-            }
-        }
-        
-        leftToRight = !leftToRight;
-        currentLat += latSpacing;
+    const double angle = searchParams_.sweepAngle * M_PI / 180.0;
+    const bool inTeam = team_.size() > 1 &&
+        std::any_of(team_.begin(), team_.end(), [this](const CoverageMember& m) { return m.id == selfId_; });
+    // 扫描线与多边形边求交，只输出区域内线段的端点；编队时只扫描本机条带
+    const std::vector<PlanarPoint> path = inTeam
+        ? MultiUavCoveragePlanner(spacing, angle).planFor(rings_, team_, selfId_).path
+        : lawnMowerPath(rings_, spacing, angle);
+    waypointsEnu_.reserve(path.size());
+    for (const auto& p : path) {
+        waypointsEnu_.push_back({p.x, p.y, 0.0});
     }
 }
 
 void SearchPathPlannerNode::generateSpiralPath() {
-    waypoints_.clear();
-    
-    if (searchArea_.polygon.size() < 3) {
+    if (rings_.empty()) {
         return;
     }
     
     // 计算边界框和中心点
-    double minLat, maxLat, minLon, maxLon;
-    computeBoundingBox(searchArea_.polygon, minLat, maxLat, minLon, maxLon);
+    double minE, maxE, minN, maxN;
+    computeBoundingBox(minE, maxE, minN, maxN);
     
-    const double centerLat = (minLat + maxLat) / 2.0;
-    const double centerLon = (minLon + maxLon) / 2.0;
-    const double radiusLat = (maxLat - minLat) / 2.0;
-    const double radiusLon = (maxLon - minLon) / 2.0;
-    const double maxRadius = std::max(radiusLat, radiusLon);
+    const double centerE = (minE + maxE) / 2.0;
+    const double centerN = (minN + maxN) / 2.0;
+    const double maxRadius = std::max((maxE - minE) / 2.0, (maxN - minN) / 2.0);
     
-    // 生成螺旋路径（优化：使用多边形裁剪）
+    // 生成螺旋路径（优化：使用多边形裁剪）：每圈半径增加一个间距
     const double spacing = searchParams_.spacing > 0 ? searchParams_.spacing : 50.0;
-    const double latSpacing = spacing / 111000.0;
-    const int numTurns = static_cast<int>(maxRadius / latSpacing);
+    const int numTurns = static_cast<int>(maxRadius / spacing);
     
     for (int i = 0; i <= numTurns * 16; ++i) {
         const double angle = i * M_PI / 8.0; // 每22.5度一个点，更平滑
-        const double radius = (i / 16.0) * latSpacing;
+        const double radius = (i / 16.0) * spacing;
         
         if (radius > maxRadius) {
             break;
         }
         
-        const double lat = centerLat + radius * std::cos(angle);
-        const double lon = centerLon + radius * std::sin(angle);
+        const double north = centerN + radius * std::cos(angle);
+        const double east = centerE + radius * std::sin(angle);
         
-        GeoPoint point = {lat, lon, searchParams_.altitude};
         // 使用多边形裁剪，只保留在多边形内的点
-        if (isPointInPolygon(point, searchArea_.polygon)) {
-            waypoints_.push_back(point);
+        if (isPointInArea(east, north)) {
+            waypointsEnu_.push_back({east, north, 0.0});
         }
     }
 }
 
 void SearchPathPlannerNode::generateZigzagPath() {
-    waypoints_.clear();
-    
-    if (searchArea_.polygon.size() < 3) {
+    if (rings_.empty()) {
         return;
     }
     
     // 计算边界框
-    double minLat, maxLat, minLon, maxLon;
-    computeBoundingBox(searchArea_.polygon, minLat, maxLat, minLon, maxLon);
+    double minE, maxE, minN, maxN;
+    computeBoundingBox(minE, maxE, minN, maxN);
     
     const double spacing = searchParams_.spacing > 0 ? searchParams_.spacing : 50.0;
-    const double latCenter = (minLat + maxLat) / 2.0;
-    const double latSpacing = spacing / 111000.0;
-    const double lonSpacing = spacing / (111000.0 * std::cos(latCenter * M_PI / 180.0));
     
     // Z字形路径：对角线方向
     bool up = true;
-    double currentLat = minLat;
-    double currentLon = minLon;
+    double currentN = minN;
+    double currentE = minE;
     
-    while (currentLat <= maxLat && currentLon <= maxLon) {
-        GeoPoint point = {currentLat, currentLon, searchParams_.altitude};
-        if (isPointInPolygon(point, searchArea_.polygon)) {
-            waypoints_.push_back(point);
+    while (currentN <= maxN && currentE <= maxE) {
+        if (isPointInArea(currentE, currentN)) {
+            waypointsEnu_.push_back({currentE, currentN, 0.0});
         }
         
         if (up) {
-            currentLat += latSpacing;
-            currentLon += lonSpacing;
-            if (currentLon > maxLon) {
-                currentLon = maxLon;
+            currentN += spacing;
+            currentE += spacing;
+            if (currentE > maxE) {
+                currentE = maxE;
                 up = false;
             }
         } else {
-            currentLat += latSpacing;
-            currentLon -= lonSpacing;
-            if (currentLon < minLon) {
-                currentLon = minLon;
+            currentN += spacing;
+            currentE -= spacing;
+            if (currentE < minE) {
+                currentE = minE;
                 up = true;
             }
         }
@@ -225,22 +281,18 @@ void SearchPathPlannerNode::generateZigzagPath() {
 }
 
 void SearchPathPlannerNode::generateSectorPath() {
-    waypoints_.clear();
-    
-    if (searchArea_.polygon.size() < 3) {
+    if (rings_.empty()) {
         return;
     }
     
     // 计算边界框和中心点
-    double minLat, maxLat, minLon, maxLon;
-    computeBoundingBox(searchArea_.polygon, minLat, maxLat, minLon, maxLon);
+    double minE, maxE, minN, maxN;
+    computeBoundingBox(minE, maxE, minN, maxN);
     
-    const double centerLat = (minLat + maxLat) / 2.0;
-    const double centerLon = (minLon + maxLon) / 2.0;
-    const double maxRadius = std::max((maxLat - minLat) / 2.0, (maxLon - minLon) / 2.0);
+    const double centerE = (minE + maxE) / 2.0;
+    const double centerN = (minN + maxN) / 2.0;
+    const double maxRadius = std::max((maxE - minE) / 2.0, (maxN - minN) / 2.0);
     
-    const double spacing = searchParams_.spacing > 0 ? searchParams_.spacing : 50.0;
-    const double latSpacing = spacing / 111000.0;
     const int numSectors = 8; // 8个扇形
     const int pointsPerSector = 10;
     
@@ -253,85 +305,129 @@ void SearchPathPlannerNode::generateSectorPath() {
             const double radius = (i / static_cast<double>(pointsPerSector)) * maxRadius;
             const double angle = startAngle + (endAngle - startAngle) * (i / static_cast<double>(pointsPerSector));
             
-            const double lat = centerLat + radius * std::cos(angle);
-            const double lon = centerLon + radius * std::sin(angle);
+            const double north = centerN + radius * std::cos(angle);
+            const double east = centerE + radius * std::sin(angle);
             
-            GeoPoint point = {lat, lon, searchParams_.altitude};
-            if (isPointInPolygon(point, searchArea_.polygon)) {
-                waypoints_.push_back(point);
+            if (isPointInArea(east, north)) {
+                waypointsEnu_.push_back({east, north, 0.0});
             }
         }
     }
 }
 
-bool SearchPathPlannerNode::isPointInPolygon(const GeoPoint& point, const std::vector<GeoPoint>& polygon) {
-    if (polygon.size() < 3) {
-        return false;
+bool SearchPathPlannerNode::isPointInArea(double east, double north) const {
+    return !areaIndex_.empty() && areaIndex_.contains(0, east, north);
+}
+
+void SearchPathPlannerNode::optimizePath() {
+    if (waypointsEnu_.size() < 2 || waypointsEnu_.size() != waypoints_.size()) {
+        return;
     }
     
-    // 射线法：从点向右发射一条射线，计算与多边形边的交点数量
-    // 奇数个交点表示点在多边形内
-    int intersections = 0;
-    const size_t n = polygon.size();
-    
-    for (size_t i = 0; i < n; ++i) {
-        const GeoPoint& p1 = polygon[i];
-        const GeoPoint& p2 = polygon[(i + 1) % n];
-        
-        // 检查射线是否与边相交
-        if (((p1.lat > point.lat) != (p2.lat > point.lat)) &&
-            (point.lon < (p2.lon - p1.lon) * (point.lat - p1.lat) / (p2.lat - p1.lat) + p1.lon)) {
-            intersections++;
+    // 移除重复点和距离过近的点（ENU 平面距离平方比较）
+    const double minDistance = 5.0; // 最小距离5米
+    const double minDistanceSq = minDistance * minDistance;
+    size_t kept = 1;
+    
+    for (size_t i = 1; i < waypointsEnu_.size(); ++i) {
+        if (horizontalDistanceSq(waypointsEnu_[kept - 1], waypointsEnu_[i]) >= minDistanceSq) {
+            waypointsEnu_[kept] = waypointsEnu_[i];
+            waypoints_[kept] = waypoints_[i];
+            ++kept;
         }
     }
     
-    return (intersections % 2) == 1;
+    waypointsEnu_.resize(kept);
+    waypoints_.resize(kept);
 }
 
-double SearchPathPlannerNode::calculateDistance(const GeoPoint& p1, const GeoPoint& p2) {
-    // 使用 Haversine 公式计算两点间的大圆距离
-    const double R = 6371000.0; // 地球半径（米）
-    const double dLat = (p2.lat - p1.lat) * M_PI / 180.0;
-    const double dLon = (p2.lon - p1.lon) * M_PI / 180.0;
-    const double a = std::sin(dLat / 2.0) * std::sin(dLat / 2.0) +
-                    std::cos(p1.lat * M_PI / 180.0) * std::cos(p2.lat * M_PI / 180.0) *
-                    std::sin(dLon / 2.0) * std::sin(dLon / 2.0);
-    const double c = 2.0 * std::atan2(std::sqrt(a), std::sqrt(1.0 - a));
-    return R * c;
+void SearchPathPlannerNode::buildTrajectory() {
+    if (waypointsEnu_.empty()) {
+        trajectory_ = TrajectoryGenerator();
+        return;
+    }
+    TrajectoryLimits limits;
+    if (searchParams_.speed > 0) limits.cruiseSpeed = searchParams_.speed;
+    if (searchParams_.maxAcceleration > 0) {
+        limits.maxAccel = searchParams_.maxAcceleration;
+        limits.maxLateralAccel = searchParams_.maxAcceleration;
+    }
+    limits.cornerTolerance = std::max(0.0, searchParams_.cornerTolerance);
+
+    // ENU 原点高度为 0，设定点高度取规划高度（地形跟随时为各航点的地形 + 离地高度）
+    std::vector<EnuPoint> points = waypointsEnu_;
+    const bool follow = terrain_ && terrainFollowing_ && waypoints_.size() == points.size();
+    for (std::size_t i = 0; i < points.size(); ++i) points[i].up = follow ? waypoints_[i].alt : searchParams_.altitude;
+    trajectory_.generate(points, limits);
 }
 
-void SearchPathPlannerNode::optimizePath() {
-    if (waypoints_.size() < 2) {
+void SearchPathPlannerNode::applyTerrainFollowing() {
+    if (waypointsEnu_.empty() || waypointsEnu_.size() != waypoints_.size()) {
         return;
     }
-    
-    // 移除重复点和距离过近的点
-    const double minDistance = 5.0; // 最小距离5米
-    std::vector<GeoPoint> optimized;
-    optimized.push_back(waypoints_[0]);
-    
-    for (size_t i = 1; i < waypoints_.size(); ++i) {
-        const double dist = calculateDistance(optimized.back(), waypoints_[i]);
-        if (dist >= minDistance) {
-            optimized.push_back(waypoints_[i]);
+    // 加密：原航点之间按 terrainSpacing_ 插入采样点，记录沿航线距离
+    const double spacing = std::max(1.0, terrainSpacing_);
+    std::vector<EnuPoint> dense;
+    std::vector<double> along;
+    std::vector<std::uint8_t> original;
+    dense.push_back(waypointsEnu_[0]);
+    along.push_back(0.0);
+    original.push_back(1);
+    for (std::size_t i = 1; i < waypointsEnu_.size(); ++i) {
+        const EnuPoint& a = waypointsEnu_[i - 1];
+        const EnuPoint& b = waypointsEnu_[i];
+        const double length = std::sqrt(horizontalDistanceSq(a, b));
+        const int steps = std::max(1, static_cast<int>(std::ceil(length / spacing)));
+        for (int s = 1; s <= steps; ++s) {
+            const double f = static_cast<double>(s) / steps;
+            dense.push_back({a.east + (b.east - a.east) * f, a.north + (b.north - a.north) * f, 0.0});
+            along.push_back(along.back() + length / steps);
+            original.push_back(s == steps ? 1 : 0);
         }
     }
-    
-    waypoints_ = optimized;
-}
+    std::vector<GeoPoint> geo = frame_.toGeo(dense);
+    std::vector<double> lat(geo.size()), lon(geo.size());
+    for (std::size_t i = 0; i < geo.size(); ++i) {
+        lat[i] = geo[i].lat;
+        lon[i] = geo[i].lon;
+    }
+    std::vector<float> ground(geo.size());
+    terrain_->heights(lat.data(), lon.data(), geo.size(), ground.data());
+    // 无数据处沿用上一个有效地形高度（起始段无数据时取首个有效值）
+    double lastGround = 0.0;
+    for (float h : ground) {
+        if (!std::isnan(h)) {
+            lastGround = h;
+            break;
+        }
+    }
+    for (std::size_t i = 0; i < geo.size(); ++i) {
+        if (!std::isnan(ground[i])) lastGround = ground[i];
+        geo[i].alt = lastGround + searchParams_.altitude;
+    }
 
-std::vector<GeoPoint> SearchPathPlannerNode::generateGridPoints(double minLat, double maxLat,
-                                                                double minLon, double maxLon,
-                                                                double latSpacing, double lonSpacing) {
-    std::vector<GeoPoint> points;
-    
-    for (double lat = minLat; lat <= maxLat; lat += latSpacing) {
-        for (double lon = minLon; lon <= maxLon; lon += lonSpacing) {
-            points.push_back({lat, lon, searchParams_.altitude});
+    // 精简：保留原航点；采样点只在去掉后线性插值误差超出容差时保留
+    auto fits = [&](std::size_t from, std::size_t to) {
+        const double span = along[to] - along[from];
+        for (std::size_t k = from + 1; k < to; ++k) {
+            const double f = span > 0.0 ? (along[k] - along[from]) / span : 0.0;
+            const double alt = geo[from].alt + (geo[to].alt - geo[from].alt) * f;
+            if (std::abs(alt - geo[k].alt) > terrainTolerance_) return false;
         }
+        return true;
+    };
+    waypointsEnu_.clear();
+    waypoints_.clear();
+    std::size_t anchor = 0;
+    waypointsEnu_.push_back(dense[0]);
+    waypoints_.push_back(geo[0]);
+    for (std::size_t k = 1; k < dense.size(); ++k) {
+        const bool last = k + 1 == dense.size();
+        if (!original[k] && !last && fits(anchor, k + 1)) continue;
+        waypointsEnu_.push_back(dense[k]);
+        waypoints_.push_back(geo[k]);
+        anchor = k;
     }
-    
-    return points;
 }
 
 } // namespace falconmind::sdk::mission
@@ -0,0 +1,262 @@
+// FalconMindSDK - Trajectory Generator Implementation
+#include "falconmind/sdk/mission/Trajectory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace falconmind::sdk::mission {
+
+namespace {
+
+constexpr double kMinLength = 1e-6;
+constexpr double kMinTurn = 1e-6;
+// 接近掉头的拐角不做圆弧（切线长趋于无穷），按尖角处理
+constexpr double kMaxTurn = M_PI - 1e-3;
+
+} // namespace
+
+void TrajectoryGenerator::addLine(double x0, double y0, double x1, double y1, double up0, double up1) {
+    Primitive p;
+    p.x0 = x0;
+    p.y0 = y0;
+    p.dx = x1 - x0;
+    p.dy = y1 - y0;
+    p.up0 = up0;
+    p.up1 = up1;
+    p.length = std::sqrt(p.dx * p.dx + p.dy * p.dy + (up1 - up0) * (up1 - up0));
+    if (p.length < kMinLength) return;
+    p.vmax = limits_.cruiseSpeed;
+    p.capIn = pendingCap_;
+    pendingCap_ = std::numeric_limits<double>::infinity();
+    prims_.push_back(p);
+}
+
+bool TrajectoryGenerator::generate(const std::vector<EnuPoint>& waypoints, const TrajectoryLimits& limits) {
+    prims_.clear();
+    points_.clear();
+    duration_ = length_ = 0.0;
+    arcs_ = 0;
+    if (waypoints.empty() || !(limits.cruiseSpeed > 0.0) || !(limits.maxAccel > 0.0) ||
+        !(limits.sampleInterval > 0.0) || (limits.cornerTolerance > 0.0 && !(limits.maxLateralAccel > 0.0))) {
+        std::cerr << "[TrajectoryGenerator] invalid waypoints or limits" << std::endl;
+        return false;
+    }
+    limits_ = limits;
+
+    // 去掉重合点
+    points_.reserve(waypoints.size());
+    for (const auto& p : waypoints) {
+        if (!points_.empty()) {
+            const EnuPoint& q = points_.back();
+            if (std::abs(p.east - q.east) < kMinLength && std::abs(p.north - q.north) < kMinLength &&
+                std::abs(p.up - q.up) < kMinLength) {
+                continue;
+            }
+        }
+        points_.push_back(p);
+    }
+    single_ = points_.front();
+    const std::size_t n = points_.size();
+    if (n == 1) return true;
+
+    prims_.reserve(2 * n);
+    pendingCap_ = 0.0;  // 起点速度为 0
+
+    double cx = points_[0].east, cy = points_[0].north, cup = points_[0].up;
+    for (std::size_t i = 1; i + 1 < n; ++i) {
+        const EnuPoint& a = points_[i - 1];
+        const EnuPoint& b = points_[i];
+        const EnuPoint& c = points_[i + 1];
+        const double l1 = std::hypot(b.east - a.east, b.north - a.north);
+        const double l2 = std::hypot(c.east - b.east, c.north - b.north);
+
+        double d = 0.0, radius = 0.0, turn = 0.0;
+        double u1x = 0.0, u1y = 0.0, u2x = 0.0, u2y = 0.0;
+        if (l1 > kMinLength && l2 > kMinLength) {
+            u1x = (b.east - a.east) / l1;
+            u1y = (b.north - a.north) / l1;
+            u2x = (c.east - b.east) / l2;
+            u2y = (c.north - b.north) / l2;
+            turn = std::atan2(u1x * u2y - u1y * u2x, u1x * u2x + u1y * u2y);
+            const double half = std::abs(turn) / 2.0;
+            if (limits_.cornerTolerance > 0.0 && std::abs(turn) > kMinTurn && std::abs(turn) < kMaxTurn) {
+                // 顶点到圆弧中点的偏差 e = R (1 / cos(θ/2) − 1)，切线长 d = R tan(θ/2)；相邻拐角各用一半段长
+                const double rTol = limits_.cornerTolerance / (1.0 / std::cos(half) - 1.0);
+                d = std::min({rTol * std::tan(half), 0.5 * l1, 0.5 * l2});
+                radius = d / std::tan(half);
+            }
+        }
+
+        const bool collinear = l1 > kMinLength && l2 > kMinLength && std::abs(turn) <= kMinTurn;
+        if (radius <= kMinLength) {
+            // 尖角：直线段直达拐点，拐点处速度为 0（共线点不限速）
+            addLine(cx, cy, b.east, b.north, cup, b.up);
+            cx = b.east;
+            cy = b.north;
+            cup = b.up;
+            if (!collinear) pendingCap_ = 0.0;
+            continue;
+        }
+
+        const double t1x = b.east - u1x * d, t1y = b.north - u1y * d;
+        const double t2x = b.east + u2x * d, t2y = b.north + u2y * d;
+        const double t1up = a.up + (b.up - a.up) * (l1 - d) / l1;
+        const double t2up = b.up + (c.up - b.up) * d / l2;
+        addLine(cx, cy, t1x, t1y, cup, t1up);
+
+        Primitive arc;
+        arc.arc = true;
+        const double side = turn > 0.0 ? 1.0 : -1.0;  // 左转（逆时针）圆心在航向左侧
+        arc.cx = t1x - u1y * radius * side;
+        arc.cy = t1y + u1x * radius * side;
+        arc.radius = radius;
+        arc.angle0 = std::atan2(t1y - arc.cy, t1x - arc.cx);
+        arc.turn = turn;
+        arc.up0 = t1up;
+        arc.up1 = t2up;
+        const double horiz = radius * std::abs(turn);
+        arc.length = std::sqrt(horiz * horiz + (t2up - t1up) * (t2up - t1up));
+        arc.vmax = std::min(limits_.cruiseSpeed, std::sqrt(limits_.maxLateralAccel * radius));
+        arc.capIn = pendingCap_;
+        pendingCap_ = std::numeric_limits<double>::infinity();
+        prims_.push_back(arc);
+        ++arcs_;
+
+        cx = t2x;
+        cy = t2y;
+        cup = t2up;
+    }
+    addLine(cx, cy, points_[n - 1].east, points_[n - 1].north, cup, points_[n - 1].up);
+    profile();
+    return true;
+}
+
+void TrajectoryGenerator::profile() {
+    const std::size_t n = prims_.size();
+    if (n == 0) return;
+    const double a = limits_.maxAccel;
+
+    // 交界速度：vb[k] 为第 k 个基元的入口速度，vb[n] 为终点（0）
+    std::vector<double> vb(n + 1);
+    vb[0] = 0.0;
+    vb[n] = 0.0;
+    for (std::size_t k = 1; k < n; ++k) vb[k] = std::min({prims_[k].capIn, prims_[k - 1].vmax, prims_[k].vmax});
+    for (std::size_t k = 1; k <= n; ++k) {
+        vb[k] = std::min(vb[k], std::sqrt(vb[k - 1] * vb[k - 1] + 2.0 * a * prims_[k - 1].length));
+    }
+    for (std::size_t k = n; k-- > 0;) {
+        vb[k] = std::min(vb[k], std::sqrt(vb[k + 1] * vb[k + 1] + 2.0 * a * prims_[k].length));
+    }
+
+    double t = 0.0;
+    length_ = 0.0;
+    for (std::size_t k = 0; k < n; ++k) {
+        Primitive& p = prims_[k];
+        p.v0 = vb[k];
+        p.v1 = vb[k + 1];
+        p.vpeak = std::min(p.vmax, std::sqrt((2.0 * a * p.length + p.v0 * p.v0 + p.v1 * p.v1) / 2.0));
+        p.vpeak = std::max({p.vpeak, p.v0, p.v1});
+        p.sAcc = (p.vpeak * p.vpeak - p.v0 * p.v0) / (2.0 * a);
+        const double sDec = (p.vpeak * p.vpeak - p.v1 * p.v1) / (2.0 * a);
+        p.sCruise = std::max(0.0, p.length - p.sAcc - sDec);
+        p.tAcc = (p.vpeak - p.v0) / a;
+        p.tDec = (p.vpeak - p.v1) / a;
+        p.tCruise = p.vpeak > 0.0 ? p.sCruise / p.vpeak : 0.0;
+        p.tStart = t;
+        t += p.tAcc + p.tCruise + p.tDec;
+        length_ += p.length;
+    }
+    duration_ = t;
+}
+
+void TrajectoryGenerator::evaluate(const Primitive& p, double tau, TrajectorySetpoint& sp) const noexcept {
+    const double a = limits_.maxAccel;
+    double s, v;
+    if (tau <= p.tAcc) {
+        s = p.v0 * tau + 0.5 * a * tau * tau;
+        v = p.v0 + a * tau;
+    } else if (tau <= p.tAcc + p.tCruise) {
+        s = p.sAcc + p.vpeak * (tau - p.tAcc);
+        v = p.vpeak;
+    } else {
+        const double td = std::min(tau - p.tAcc - p.tCruise, p.tDec);
+        s = p.sAcc + p.sCruise + p.vpeak * td - 0.5 * a * td * td;
+        v = p.vpeak - a * td;
+    }
+    const double f = std::clamp(s / p.length, 0.0, 1.0);
+    const double dz = p.up1 - p.up0;
+    sp.up = p.up0 + f * dz;
+    sp.vu = v * dz / p.length;
+
+    double dirE, dirN;
+    if (p.arc) {
+        const double ang = p.angle0 + f * p.turn;
+        const double c = std::cos(ang), sn = std::sin(ang);
+        sp.east = p.cx + p.radius * c;
+        sp.north = p.cy + p.radius * sn;
+        const double side = p.turn > 0.0 ? 1.0 : -1.0;
+        dirE = -sn * side;
+        dirN = c * side;
+        const double hv = v * p.radius * std::abs(p.turn) / p.length;
+        sp.ve = dirE * hv;
+        sp.vn = dirN * hv;
+    } else {
+        sp.east = p.x0 + f * p.dx;
+        sp.north = p.y0 + f * p.dy;
+        dirE = p.dx;
+        dirN = p.dy;
+        sp.ve = v * p.dx / p.length;
+        sp.vn = v * p.dy / p.length;
+    }
+    sp.yaw = (dirE != 0.0 || dirN != 0.0) ? std::atan2(dirE, dirN) : 0.0;
+}
+
+TrajectorySetpoint TrajectoryGenerator::at(double t) const noexcept {
+    TrajectorySetpoint sp;
+    if (prims_.empty()) {
+        sp.east = single_.east;
+        sp.north = single_.north;
+        sp.up = single_.up;
+        return sp;
+    }
+    t = std::clamp(t, 0.0, duration_);
+    auto it = std::upper_bound(prims_.begin(), prims_.end(), t,
+                               [](double value, const Primitive& p) { return value < p.tStart; });
+    const Primitive& p = *(it == prims_.begin() ? it : it - 1);
+    evaluate(p, t - p.tStart, sp);
+    sp.t = t;
+    return sp;
+}
+
+std::size_t TrajectoryGenerator::sample(std::vector<TrajectorySetpoint>& out) const {
+    out.clear();
+    if (prims_.empty()) {
+        if (!points_.empty()) out.push_back(at(0.0));
+        return out.size();
+    }
+    const double dt = limits_.sampleInterval;
+    const auto steps = static_cast<std::size_t>(std::floor(duration_ / dt));
+    out.reserve(steps + 2);
+
+    // 时间单调递增，基元下标只前进
+    std::size_t k = 0;
+    for (std::size_t i = 0; i <= steps; ++i) {
+        const double t = std::min(duration_, i * dt);
+        while (k + 1 < prims_.size() && prims_[k + 1].tStart <= t) ++k;
+        TrajectorySetpoint sp;
+        evaluate(prims_[k], t - prims_[k].tStart, sp);
+        sp.t = t;
+        out.push_back(sp);
+    }
+    if (out.back().t < duration_) {
+        TrajectorySetpoint sp;
+        evaluate(prims_.back(), duration_ - prims_.back().tStart, sp);
+        sp.t = duration_;
+        out.push_back(sp);
+    }
+    return out.size();
+}
+
+} // namespace falconmind::sdk::mission
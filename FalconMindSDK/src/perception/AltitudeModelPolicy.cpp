@@ -0,0 +1,203 @@
+#include "falconmind/sdk/perception/AltitudeModelPolicy.h"
+#include "falconmind/sdk/perception/TiledDetectorBackend.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kMinDepressionRad = 10. * kPi / 180.;
+
+} // namespace
+
+ModelVariant ModelVariant::fromDescriptor(const DetectorDescriptor& desc) {
+    ModelVariant v;
+    v.detectorId = desc.detectorId;
+    v.inputWidth = desc.inputWidth > 0 ? desc.inputWidth : 640;
+    v.inputHeight = desc.inputHeight > 0 ? desc.inputHeight : v.inputWidth;
+    v.tileWidth = desc.tileWidth;
+    v.tileHeight = desc.tileHeight;
+    v.tileOverlap = desc.tileOverlap;
+    v.tileFullFrame = desc.tileFullFrame;
+    return v;
+}
+
+AltitudeModelPolicy::AltitudeModelPolicy(std::vector<ModelVariant> variants, AltitudeModelPolicyConfig config)
+    : variants_(std::move(variants)), config_(config) {}
+
+void AltitudeModelPolicy::setGroundElevation(std::shared_ptr<const GroundElevationModel> dem) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dem_ = std::move(dem);
+}
+
+void AltitudeModelPolicy::updateFlightState(const flight::FlightState& state, const GimbalPose* gimbal) {
+    if (!state.has(flight::FlightField::Position)) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    double agl = dem_ && dem_->hasGrid() ? state.alt - dem_->heightAt(state.lat, state.lon) : state.relativeAlt;
+    agl = std::max(agl, config_.minAglM);
+    double range = agl;
+    if (gimbal) {
+        // 相机光轴的俯角：云台俯仰（-π/2 垂直向下）叠加机体俯仰
+        const double depression = std::clamp(-(gimbal->pitch + state.pitch), kMinDepressionRad, kPi / 2.);
+        range = agl / std::sin(depression);
+    }
+    rangeM_ = range;
+}
+
+void AltitudeModelPolicy::setRange(double rangeM) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rangeM_ = std::max(rangeM, 0.);
+}
+
+double AltitudeModelPolicy::rangeM() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rangeM_;
+}
+
+double AltitudeModelPolicy::targetPixels(const ModelVariant& variant, double rangeM, double hfovDeg,
+                                         double targetSizeM, int imageWidth, int imageHeight) {
+    if (rangeM <= 0. || hfovDeg <= 0. || imageWidth <= 0 || imageHeight <= 0) return 0.;
+    const double footprintM = 2. * rangeM * std::tan(0.5 * hfovDeg * kPi / 180.);
+    const double imagePx = targetSizeM * static_cast<double>(imageWidth) / footprintM;
+    int regionW = imageWidth;
+    int regionH = imageHeight;
+    if (variant.tileWidth > 0) {
+        regionW = std::min(variant.tileWidth, imageWidth);
+        regionH = std::min(variant.tileHeight > 0 ? variant.tileHeight : variant.tileWidth, imageHeight);
+    }
+    // letterbox：按较小的缩放比适配模型输入
+    const double scale = std::min(static_cast<double>(variant.inputWidth) / regionW,
+                                  static_cast<double>(variant.inputHeight) / regionH);
+    return imagePx * scale;
+}
+
+std::size_t AltitudeModelPolicy::inferenceRuns(const ModelVariant& variant, int imageWidth, int imageHeight) {
+    std::size_t runs = 1;
+    if (variant.tileWidth > 0) {
+        runs = TiledDetectorBackend::tileCount(imageWidth, imageHeight, variant.tileWidth,
+                                               variant.tileHeight > 0 ? variant.tileHeight : variant.tileWidth,
+                                               variant.tileOverlap);
+        if (variant.tileFullFrame && runs > 1) ++runs;
+    }
+    return runs;
+}
+
+double AltitudeModelPolicy::frameCost(const ModelVariant& variant, int imageWidth, int imageHeight) {
+    return static_cast<double>(variant.inputWidth) * variant.inputHeight *
+           static_cast<double>(inferenceRuns(variant, imageWidth, imageHeight));
+}
+
+void AltitudeModelPolicy::setResourceCap(int maxInputSide, std::size_t maxInferences) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxInputSide_ = std::max(maxInputSide, 0);
+    maxInferences_ = maxInferences;
+}
+
+int AltitudeModelPolicy::maxInputSide() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return maxInputSide_;
+}
+
+std::size_t AltitudeModelPolicy::maxInferences() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return maxInferences_;
+}
+
+const ModelVariant& AltitudeModelPolicy::select(int imageWidth, int imageHeight) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (variants_.empty()) {
+        static const ModelVariant kNone;
+        return kNone;
+    }
+    if (variants_.size() == 1) return variants_[current_];
+
+    // 资源上限：超限的变体不参与选择；全部超限时只保留开销最小者
+    std::vector<char> allowed(variants_.size(), 1);
+    if (maxInputSide_ > 0 || maxInferences_ > 0) {
+        std::size_t cheapest = 0, fitting = 0;
+        double cheapestCost = -1.;
+        for (std::size_t i = 0; i < variants_.size(); ++i) {
+            const auto& v = variants_[i];
+            const double cost = frameCost(v, imageWidth, imageHeight);
+            if (cheapestCost < 0. || cost < cheapestCost) {
+                cheapest = i;
+                cheapestCost = cost;
+            }
+            const bool fits = (maxInputSide_ <= 0 || std::max(v.inputWidth, v.inputHeight) <= maxInputSide_) &&
+                              (maxInferences_ == 0 || inferenceRuns(v, imageWidth, imageHeight) <= maxInferences_);
+            allowed[i] = fits ? 1 : 0;
+            if (fits) ++fitting;
+        }
+        if (fitting == 0) allowed[cheapest] = 1;
+    }
+    auto choose = [&](std::size_t chosen) -> const ModelVariant& {
+        if (chosen != current_) {
+            current_ = chosen;
+            ++switches_;
+        }
+        return variants_[current_];
+    };
+    if (rangeM_ <= 0.) {
+        if (allowed[current_]) return variants_[current_];
+        std::size_t best = variants_.size();
+        double bestCost = 0.;
+        for (std::size_t i = 0; i < variants_.size(); ++i) {
+            const double cost = frameCost(variants_[i], imageWidth, imageHeight);
+            if (allowed[i] && (best == variants_.size() || cost < bestCost)) {
+                best = i;
+                bestCost = cost;
+            }
+        }
+        return choose(best);
+    }
+
+    const double h = std::max(0., config_.hysteresis);
+    std::size_t inRange = variants_.size(), aboveMin = variants_.size(), sharpest = variants_.size();
+    double inRangeCost = 0., aboveMinCost = 0., sharpestPx = -1.;
+    for (std::size_t i = 0; i < variants_.size(); ++i) {
+        if (!allowed[i]) continue;
+        const auto& v = variants_[i];
+        const double px = targetPixels(v, rangeM_, config_.hfovDeg, config_.targetSizeM, imageWidth, imageHeight);
+        const double cost = frameCost(v, imageWidth, imageHeight);
+        const bool cur = i == current_;
+        const double lo = config_.minTargetPx * (cur ? 1. - h : 1. + h);
+        const double hi = config_.maxTargetPx * (cur ? 1. + h : 1. - h);
+        // 同等开销时优先保持当前变体
+        auto better = [&](std::size_t best, double bestCost) {
+            return best == variants_.size() || cost < bestCost || (cost == bestCost && cur);
+        };
+        if (px >= lo && px <= hi && better(inRange, inRangeCost)) {
+            inRange = i;
+            inRangeCost = cost;
+        }
+        if (px >= lo && better(aboveMin, aboveMinCost)) {
+            aboveMin = i;
+            aboveMinCost = cost;
+        }
+        if (px > sharpestPx || (px == sharpestPx && cur)) {
+            sharpest = i;
+            sharpestPx = px;
+        }
+    }
+    return choose(inRange < variants_.size() ? inRange : aboveMin < variants_.size() ? aboveMin : sharpest);
+}
+
+const ModelVariant& AltitudeModelPolicy::current() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (variants_.empty()) {
+        static const ModelVariant kNone;
+        return kNone;
+    }
+    return variants_[current_];
+}
+
+std::uint64_t AltitudeModelPolicy::switches() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return switches_;
+}
+
+} // namespace falconmind::sdk::perception
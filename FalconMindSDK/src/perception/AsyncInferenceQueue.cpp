@@ -0,0 +1,76 @@
+#include "falconmind/sdk/perception/AsyncInferenceQueue.h"
+#include "falconmind/sdk/core/Trace.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace falconmind::sdk::perception {
+
+AsyncInferenceQueue::AsyncInferenceQueue(IDetectorBackend& backend, std::size_t workers, std::size_t depth)
+    : backend_(backend) {
+    workers = std::max<std::size_t>(1, workers);
+    depth_ = std::max(depth > 0 ? depth : 2 * workers, workers);
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        threads_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+AsyncInferenceQueue::~AsyncInferenceQueue() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        spaceCv_.wait(lock, [this] { return inFlight_ == 0; });
+        stopping_ = true;
+    }
+    jobCv_.notify_all();
+    spaceCv_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+bool AsyncInferenceQueue::submit(const ImageView& image, DetectionResult& outResult,
+                                 IDetectorBackend::DetectionCallback done) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        spaceCv_.wait(lock, [this] { return stopping_ || inFlight_ < depth_; });
+        if (stopping_) return false;
+        ++inFlight_;
+        jobs_.push_back(Job{image, &outResult, std::move(done)});
+    }
+    jobCv_.notify_one();
+    return true;
+}
+
+void AsyncInferenceQueue::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    spaceCv_.wait(lock, [this] { return inFlight_ == 0; });
+}
+
+std::size_t AsyncInferenceQueue::inFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return inFlight_;
+}
+
+void AsyncInferenceQueue::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        jobCv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty()) return;  // stopping_
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        lock.unlock();
+
+        bool ok;
+        {
+            FM_TRACE_SCOPE("perception", "async.run");
+            ok = backend_.run(job.image, *job.out);
+        }
+        if (job.done) job.done(ok);
+        job.done = nullptr;  // 回调捕获的资源（如加速器时间片）在计为完成之前释放
+
+        lock.lock();
+        --inFlight_;
+        spaceCv_.notify_all();
+    }
+}
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,282 @@
+#include "falconmind/sdk/perception/ByteTrackerBackend.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+using Mat4 = core::Matrix<float, 4, 4>;
+using Mat84 = core::Matrix<float, 8, 4>;
+using Vec4 = core::Vector<float, 4>;
+
+constexpr float kMinHeight = 1e-3f;
+
+Vec4 measurementOf(const DetectionBBox& b) {
+    Vec4 z;
+    const float h = std::max(b.height, kMinHeight);
+    z[0] = b.x + b.width * 0.5f;
+    z[1] = b.y + b.height * 0.5f;
+    z[2] = b.width / h;
+    z[3] = h;
+    return z;
+}
+
+} // namespace
+
+ByteTrackerBackend::ByteTrackerBackend() = default;
+
+ByteTrackerBackend::~ByteTrackerBackend() = default;
+
+bool ByteTrackerBackend::load() {
+    loaded_ = true;
+    tracks_.clear();
+    nextTrackId_ = 1;
+    std::cout << "[ByteTrackerBackend] load() Kalman + two-stage association high=" << highScoreThreshold_
+              << " low=" << lowScoreThreshold_ << " max_missed=" << maxMissedFrames_ << std::endl;
+    return true;
+}
+
+void ByteTrackerBackend::unload() {
+    if (loaded_) std::cout << "[ByteTrackerBackend] unload()" << std::endl;
+    loaded_ = false;
+    tracks_.clear();
+}
+
+void ByteTrackerBackend::initiate(ByteTrackState& t, const DetectionBBox& box) const {
+    const Vec4 z = measurementOf(box);
+    t.mean = KalmanState::zero();
+    t.mean.setBlock(0, 0, z);
+    const float h = z[3];
+    const float period = static_cast<float>(framePeriodNs_) * 1e-9f;
+    const float pos = 2.f * stdWeightPosition_ * h;
+    const float vel = 10.f * stdWeightVelocity_ * h / period;
+    t.covariance = KalmanCovariance::diagonal({pos * pos, pos * pos, 1e-4f, pos * pos, vel * vel, vel * vel,
+                                               (1e-5f / period) * (1e-5f / period), vel * vel});
+}
+
+void ByteTrackerBackend::predictTo(ByteTrackState& t, std::uint64_t ts) const {
+    // 有时间戳时按真实间隔预测（跳帧 / 丢帧时自动多走几步），否则按名义帧间隔
+    std::uint64_t dtNs = framePeriodNs_;
+    if (ts > 0 && t.stateNs > 0) dtNs = ts > t.stateNs ? ts - t.stateNs : 0;
+    if (ts > 0) t.stateNs = ts;
+    if (dtNs == 0) return;
+
+    const float dt = static_cast<float>(dtNs) * 1e-9f;
+    const float frames = static_cast<float>(dtNs) / static_cast<float>(framePeriodNs_);
+    const float period = static_cast<float>(framePeriodNs_) * 1e-9f;
+
+    KalmanCovariance f = KalmanCovariance::identity();
+    for (std::size_t i = 0; i < 4; ++i) f(i, i + 4) = dt;
+
+    // 过程噪声按名义帧数线性累积（随机游走），尺度取目标高度
+    const float h = std::max(t.mean[3], kMinHeight);
+    const float pos = stdWeightPosition_ * h;
+    const float vel = stdWeightVelocity_ * h / period;
+    const float va = 1e-5f / period;
+    const KalmanCovariance q = KalmanCovariance::diagonal(
+        {pos * pos * frames, pos * pos * frames, 1e-4f * frames, pos * pos * frames, vel * vel * frames,
+         vel * vel * frames, va * va * frames, vel * vel * frames});
+
+    t.mean = f * t.mean;
+    t.covariance = f * t.covariance * f.transpose() + q;
+}
+
+void ByteTrackerBackend::update(ByteTrackState& t, const Detection& det, std::uint64_t ts) {
+    const Vec4 z = measurementOf(det.bbox);
+    const float h = std::max(t.mean[3], kMinHeight);
+    const float pos = stdWeightPosition_ * h;
+    const Mat4 r = Mat4::diagonal({pos * pos, pos * pos, 1e-2f, pos * pos});
+
+    // H = [I4 0]：H P H^T 与 P H^T 直接取子块
+    const Mat4 s = t.covariance.block<4, 4>(0, 0) + r;
+    const Mat84 pht = t.covariance.block<8, 4>(0, 0);
+    Mat4 sInv;
+    if (core::choleskyInverse(s, sInv)) {
+        const Mat84 k = pht * sInv;
+        const Vec4 innovation = z - t.mean.block<4, 1>(0, 0);
+        t.mean += k * innovation;
+        t.covariance -= k * pht.transpose();
+    } else {
+        // 协方差退化（数值异常）：以观测重新初始化
+        initiate(t, det.bbox);
+    }
+    t.lastUpdateNs = ts;
+    t.missedFrames = 0;
+    ++t.hits;
+    t.score = det.score;
+    t.classId = det.classId;
+    t.className = det.className;
+    pushHistory(t, TrackHistoryPoint{ts, det.bbox});
+}
+
+DetectionBBox ByteTrackerBackend::stateBox(const ByteTrackState& t) const {
+    const float h = std::max(t.mean[3], kMinHeight);
+    const float w = t.mean[2] * h;
+    DetectionBBox b;
+    b.x = t.mean[0] - w * 0.5f;
+    b.y = t.mean[1] - h * 0.5f;
+    b.width = w;
+    b.height = h;
+    return b;
+}
+
+float ByteTrackerBackend::uncertaintyOf(const ByteTrackState& t) const {
+    const float size = std::max(1.f, std::max(t.mean[3], t.mean[2] * t.mean[3]));
+    return std::sqrt(std::max(0.f, t.covariance(0, 0) + t.covariance(1, 1))) / size;
+}
+
+void ByteTrackerBackend::pushHistory(ByteTrackState& t, const TrackHistoryPoint& p) const {
+    const std::uint32_t cap = static_cast<std::uint32_t>(t.history.size());
+    if (cap == 0) return;
+    if (t.historyCount < cap) {
+        t.history[(t.historyOldest + t.historyCount) % cap] = p;
+        ++t.historyCount;
+    } else {
+        t.history[t.historyOldest] = p;
+        t.historyOldest = (t.historyOldest + 1) % cap;
+    }
+}
+
+void ByteTrackerBackend::writeState(const ByteTrackState& t, const char* status, TrackingState& out) const {
+    out.trackId = t.trackId;
+    out.targetClassId = t.classId;
+    out.targetClassName = t.className;
+    out.status = status;
+    out.uncertainty = uncertaintyOf(t);
+    out.history = TrajectoryView(t.history.data(), t.history.size(), t.historyOldest, t.historyCount);
+}
+
+bool ByteTrackerBackend::run(DetectionResult& detections, TrackingResult& outTracks) {
+    if (!loaded_) {
+        std::cerr << "[ByteTrackerBackend] run() called before load()" << std::endl;
+        return false;
+    }
+
+    outTracks.frameId = detections.frameId;
+    outTracks.timestampNs = detections.timestampNs;
+    outTracks.frameIndex = detections.frameIndex;
+    outTracks.tracks.clear();
+
+    const std::uint64_t ts = detections.timestampNs;
+
+    // 上一帧已输出 LOST 的轨迹此时才释放（其 history 视图在上一帧结果中保持有效）
+    tracks_.erase(std::remove_if(tracks_.begin(), tracks_.end(),
+                                 [this](const ByteTrackState& t) { return t.missedFrames > maxMissedFrames_; }),
+                  tracks_.end());
+
+    // 1) 全部轨迹预测到当前帧时刻
+    const std::size_t numTracks = tracks_.size();
+    trackBoxes_.resize(numTracks);
+    for (std::size_t i = 0; i < numTracks; ++i) {
+        predictTo(tracks_[i], ts);
+        tracks_[i].missedFrames++;
+        trackBoxes_[i] = stateBox(tracks_[i]);
+    }
+    trackMatched_.assign(numTracks, false);
+
+    highIdx_.clear();
+    lowIdx_.clear();
+    for (std::size_t d = 0; d < detections.detections.size(); ++d) {
+        const float s = detections.detections[d].score;
+        if (s >= highScoreThreshold_) highIdx_.push_back(d);
+        else if (s >= lowScoreThreshold_) lowIdx_.push_back(d);
+    }
+
+    // 关联一组检测与可用轨迹：门控 + JV 最优分配，匹配成功即更新滤波器
+    auto associate = [&](const std::vector<std::size_t>& detIdx, float minIou, std::vector<bool>* detMatched) {
+        if (detIdx.empty() || numTracks == 0) return;
+        detBoxes_.resize(detIdx.size());
+        for (std::size_t k = 0; k < detIdx.size(); ++k) detBoxes_[k] = detections.detections[detIdx[k]].bbox;
+        gateByIou(detBoxes_, trackBoxes_, minIou, candidates_, &trackEnabled_);
+        solveSparseAssignment(static_cast<int>(detIdx.size()), static_cast<int>(numTracks), candidates_, 0.5f,
+                              assignment_);
+        for (std::size_t k = 0; k < detIdx.size(); ++k) {
+            const int ti = assignment_[k];
+            if (ti < 0) continue;
+            Detection& det = detections.detections[detIdx[k]];
+            ByteTrackState& t = tracks_[static_cast<std::size_t>(ti)];
+            update(t, det, ts);
+            det.trackId = t.trackId;
+            trackMatched_[static_cast<std::size_t>(ti)] = true;
+            if (detMatched) (*detMatched)[k] = true;
+        }
+    };
+
+    // 2) 第一阶段：高分检测 ↔ 全部轨迹（含短暂丢失的轨迹）
+    trackEnabled_.assign(numTracks, true);
+    std::vector<bool> highMatched(highIdx_.size(), false);
+    associate(highIdx_, firstMatchIou_, &highMatched);
+
+    // 3) 第二阶段：低分检测 ↔ 上一帧仍在跟踪且本帧未匹配的轨迹
+    for (std::size_t i = 0; i < numTracks; ++i) {
+        trackEnabled_[i] = !trackMatched_[i] && tracks_[i].missedFrames == 1;
+    }
+    associate(lowIdx_, secondMatchIou_, nullptr);
+
+    // 4) 未匹配的高分检测 -> 新轨迹
+    for (std::size_t k = 0; k < highIdx_.size(); ++k) {
+        if (highMatched[k]) continue;
+        Detection& det = detections.detections[highIdx_[k]];
+        if (det.score < newTrackThreshold_) continue;
+        ByteTrackState t;
+        t.trackId = nextTrackId_++;
+        initiate(t, det.bbox);
+        t.stateNs = ts;
+        t.lastUpdateNs = ts;
+        t.hits = 1;
+        t.score = det.score;
+        t.classId = det.classId;
+        t.className = det.className;
+        t.history.resize(static_cast<std::size_t>(maxTrajectoryPoints_));
+        pushHistory(t, TrackHistoryPoint{ts, det.bbox});
+        det.trackId = t.trackId;
+        tracks_.push_back(std::move(t));
+    }
+
+    // 5) 输出 ACTIVE / LOST
+    outTracks.tracks.resize(tracks_.size());
+    for (std::size_t i = 0; i < tracks_.size(); ++i) {
+        const bool lost = tracks_[i].missedFrames > maxMissedFrames_;
+        writeState(tracks_[i], lost ? "LOST" : "ACTIVE", outTracks.tracks[i]);
+    }
+    return true;
+}
+
+bool ByteTrackerBackend::predict(DetectionResult& detections, TrackingResult& outTracks) {
+    if (!loaded_) {
+        std::cerr << "[ByteTrackerBackend] predict() called before load()" << std::endl;
+        return false;
+    }
+
+    outTracks.frameId = detections.frameId;
+    outTracks.timestampNs = detections.timestampNs;
+    outTracks.frameIndex = detections.frameIndex;
+    outTracks.tracks.clear();
+    detections.detections.clear();
+
+    tracks_.erase(std::remove_if(tracks_.begin(), tracks_.end(),
+                                 [this](const ByteTrackState& t) { return t.missedFrames > maxMissedFrames_; }),
+                  tracks_.end());
+
+    outTracks.tracks.resize(tracks_.size());
+    detections.detections.resize(tracks_.size());
+    for (std::size_t i = 0; i < tracks_.size(); ++i) {
+        ByteTrackState& t = tracks_[i];
+        predictTo(t, detections.timestampNs);
+
+        Detection& det = detections.detections[i];
+        det.bbox = stateBox(t);
+        det.score = t.score;
+        det.classId = t.classId;
+        det.className = t.className;
+        det.trackId = t.trackId;
+
+        writeState(t, "PREDICTED", outTracks.tracks[i]);
+    }
+    return true;
+}
+
+} // namespace falconmind::sdk::perception
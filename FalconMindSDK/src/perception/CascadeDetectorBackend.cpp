@@ -0,0 +1,256 @@
+#include "falconmind/sdk/perception/CascadeDetectorBackend.h"
+#include "falconmind/sdk/perception/YoloPrePostProcess.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+float iou(const DetectionBBox& a, const DetectionBBox& b) {
+    const float w = std::min(a.x + a.width, b.x + b.width) - std::max(a.x, b.x);
+    const float h = std::min(a.y + a.height, b.y + b.height) - std::max(a.y, b.y);
+    if (w <= 0.f || h <= 0.f) return 0.f;
+    const float inter = w * h;
+    return inter / (a.width * a.height + b.width * b.height - inter);
+}
+
+bool contains(const DetectionBBox& outer, const DetectionBBox& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.width <= outer.x + outer.width &&
+           inner.y + inner.height <= outer.y + outer.height;
+}
+
+void addTiming(DetectionTiming& total, const DetectionTiming& t) {
+    total.preprocessUs += t.preprocessUs;
+    total.inferUs += t.inferUs;
+    total.decodeUs += t.decodeUs;
+    total.nmsUs += t.nmsUs;
+    total.deviceUs += t.deviceUs;
+}
+
+// 贴着裁剪内部边界的容差（像素）
+constexpr float kEdgeMargin = 2.f;
+
+} // namespace
+
+CascadeDetectorBackend::CascadeDetectorBackend(DetectorBackendPtr screen, DetectorBackendPtr confirm)
+    : screen_(std::move(screen)), confirm_(std::move(confirm)) {}
+
+DetectionBackendType CascadeDetectorBackend::backendType() const {
+    return screen_ ? screen_->backendType() : DetectionBackendType::Unknown;
+}
+
+bool CascadeDetectorBackend::load(const DetectorDescriptor& desc) {
+    if (!screen_ || !confirm_) {
+        std::cerr << "[CascadeDetectorBackend] screen and confirm backends are required" << std::endl;
+        return false;
+    }
+    if (!confirm_->isLoaded()) {
+        std::cerr << "[CascadeDetectorBackend] confirm backend is not loaded" << std::endl;
+        return false;
+    }
+    DetectorDescriptor screenDesc = desc;
+    screenDesc.scoreThreshold = desc.cascadeScreenThreshold;
+    if (!screen_->load(screenDesc)) return false;
+    desc_ = desc;
+    desc_.cascadeCropScale = std::max(1.f, desc.cascadeCropScale);
+    desc_.cascadeMinCrop = std::max(1, desc.cascadeMinCrop);
+    loaded_ = true;
+    std::cout << "[CascadeDetectorBackend] screen threshold " << desc_.cascadeScreenThreshold << ", confirm threshold "
+              << desc_.cascadeConfirmThreshold << ", crop x" << desc_.cascadeCropScale << " (min "
+              << desc_.cascadeMinCrop << " px), max " << desc_.cascadeMaxCrops << " crops, confirm batch "
+              << confirm_->maxBatchSize() << std::endl;
+    return true;
+}
+
+void CascadeDetectorBackend::unload() {
+    if (screen_) screen_->unload();
+    if (confirm_) confirm_->unload();
+    loaded_ = false;
+}
+
+bool CascadeDetectorBackend::isLoaded() const {
+    return loaded_ && screen_ && screen_->isLoaded() && confirm_ && confirm_->isLoaded();
+}
+
+std::vector<core::PixelFormat> CascadeDetectorBackend::supportedPixelFormats() const {
+    // 裁剪是原帧的子视图：只声明两级都支持的单平面紧凑格式
+    std::vector<core::PixelFormat> formats;
+    if (screen_ && confirm_) {
+        const auto confirmFormats = confirm_->supportedPixelFormats();
+        for (auto f : screen_->supportedPixelFormats()) {
+            if ((f == core::PixelFormat::RGB8 || f == core::PixelFormat::BGR8) &&
+                std::find(confirmFormats.begin(), confirmFormats.end(), f) != confirmFormats.end()) {
+                formats.push_back(f);
+            }
+        }
+    }
+    if (formats.empty()) formats = {core::PixelFormat::RGB8, core::PixelFormat::BGR8};
+    return formats;
+}
+
+bool CascadeDetectorBackend::setNpuCoreMask(std::uint32_t mask) {
+    const bool a = screen_ && screen_->setNpuCoreMask(mask);
+    const bool b = confirm_ && confirm_->setNpuCoreMask(mask);
+    return a && b;
+}
+
+bool CascadeDetectorBackend::setClassFilter(const std::vector<int>& classIds) {
+    const bool a = screen_ && screen_->setClassFilter(classIds);
+    const bool b = confirm_ && confirm_->setClassFilter(classIds);
+    return a && b;
+}
+
+bool CascadeDetectorBackend::confirmFullFrame(const ImageView& image, DetectionResult& outResult) {
+    ++fullFrameConfirms_;
+    crops_.assign(1, DetectionBBox{0.f, 0.f, static_cast<float>(image.width), static_cast<float>(image.height)});
+    const DetectionTiming screenTiming = outResult.timing;
+    if (!confirm_->run(image, outResult)) return false;
+    auto& dets = outResult.detections;
+    dets.erase(std::remove_if(dets.begin(), dets.end(),
+                              [this](const Detection& d) { return d.score < desc_.cascadeConfirmThreshold; }),
+               dets.end());
+    addTiming(outResult.timing, screenTiming);
+    return true;
+}
+
+// 按分数从高到低为候选分配裁剪区域：被已有区域包含的候选共用该区域
+void CascadeDetectorBackend::buildCrops(int width, int height) {
+    crops_.clear();
+    std::stable_sort(candidates_.begin(), candidates_.end(),
+                     [](const Detection& a, const Detection& b) { return a.score > b.score; });
+    for (const auto& c : candidates_) {
+        const DetectionBBox& b = c.bbox;
+        bool covered = false;
+        for (const auto& crop : crops_) {
+            if (contains(crop, b)) {
+                covered = true;
+                break;
+            }
+        }
+        if (covered) continue;
+        const float side = std::max(static_cast<float>(desc_.cascadeMinCrop),
+                                    desc_.cascadeCropScale * std::max(b.width, b.height));
+        const int cw = std::min(width, static_cast<int>(std::lround(side)));
+        const int ch = std::min(height, static_cast<int>(std::lround(side)));
+        const int cx = static_cast<int>(std::lround(b.x + 0.5f * b.width)) - cw / 2;
+        const int cy = static_cast<int>(std::lround(b.y + 0.5f * b.height)) - ch / 2;
+        const int x = std::clamp(cx, 0, width - cw);
+        const int y = std::clamp(cy, 0, height - ch);
+        crops_.push_back(DetectionBBox{static_cast<float>(x), static_cast<float>(y), static_cast<float>(cw),
+                                       static_cast<float>(ch)});
+    }
+}
+
+bool CascadeDetectorBackend::touchesInnerEdge(const DetectionBBox& crop, const DetectionBBox& box, int width,
+                                              int height) const {
+    const float x1 = crop.x + crop.width;
+    const float y1 = crop.y + crop.height;
+    return (crop.x > 0.f && box.x <= crop.x + kEdgeMargin) || (crop.y > 0.f && box.y <= crop.y + kEdgeMargin) ||
+           (x1 < static_cast<float>(width) && box.x + box.width >= x1 - kEdgeMargin) ||
+           (y1 < static_cast<float>(height) && box.y + box.height >= y1 - kEdgeMargin);
+}
+
+// 重叠裁剪区域与直接采纳的候选可能给出同一目标：同类内按分数贪心保留
+void CascadeDetectorBackend::mergeDetections(std::vector<Detection>& detections) const {
+    std::stable_sort(detections.begin(), detections.end(),
+                     [](const Detection& a, const Detection& b) { return a.score > b.score; });
+    std::vector<Detection> kept;
+    kept.reserve(detections.size());
+    for (auto& d : detections) {
+        bool duplicate = false;
+        for (const auto& k : kept) {
+            if (k.classId == d.classId && iou(k.bbox, d.bbox) > desc_.nmsThreshold) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate) kept.push_back(std::move(d));
+    }
+    if (desc_.maxDetections > 0 && kept.size() > static_cast<std::size_t>(desc_.maxDetections)) {
+        kept.resize(static_cast<std::size_t>(desc_.maxDetections));
+    }
+    detections.swap(kept);
+}
+
+bool CascadeDetectorBackend::run(const ImageView& image, DetectionResult& outResult) {
+    if (!isLoaded()) {
+        std::cerr << "[CascadeDetectorBackend] run() called before load()" << std::endl;
+        return false;
+    }
+    outResult.frameId.clear();
+    outResult.frameIndex = image.frameIndex;
+    outResult.timestampNs = static_cast<std::uint64_t>(image.captureTimestampNs);
+    outResult.timing = DetectionTiming{};
+    lastCandidates_ = lastAccepted_ = 0;
+    const core::PixelFormat format =
+        image.format != core::PixelFormat::Any ? image.format : core::parsePixelFormat(image.pixelFormat);
+    if (!image.data || image.width <= 0 || image.height <= 0 ||
+        (format != core::PixelFormat::RGB8 && format != core::PixelFormat::BGR8)) {
+        return confirmFullFrame(image, outResult);
+    }
+
+    if (!screen_->run(image, screenResult_)) return false;
+    outResult.timing = screenResult_.timing;
+    outResult.detections.clear();
+    candidates_.clear();
+    for (auto& d : screenResult_.detections) {
+        if (d.score < desc_.cascadeScreenThreshold || d.bbox.width <= 0.f || d.bbox.height <= 0.f) continue;
+        if (d.score >= desc_.cascadeAcceptThreshold) {
+            outResult.detections.push_back(d);
+            ++lastAccepted_;
+        } else {
+            candidates_.push_back(d);
+        }
+    }
+    lastCandidates_ = candidates_.size() + lastAccepted_;
+    if (desc_.cascadeMaxCrops > 0 && candidates_.size() > static_cast<std::size_t>(desc_.cascadeMaxCrops)) {
+        return confirmFullFrame(image, outResult);
+    }
+    buildCrops(image.width, image.height);
+    if (crops_.empty()) return true;
+
+    const int stride = image.stride > 0 ? image.stride : image.width * 3;
+    views_.resize(crops_.size());
+    results_.resize(crops_.size());
+    for (std::size_t i = 0; i < crops_.size(); ++i) {
+        const auto& c = crops_[i];
+        ImageView& view = views_[i];
+        view = image;
+        view.data = image.data + static_cast<std::size_t>(c.y) * stride + static_cast<std::size_t>(c.x) * 3;
+        view.width = static_cast<int>(c.width);
+        view.height = static_cast<int>(c.height);
+        view.stride = stride;
+        view.format = format;
+        view.dmabufFd = -1;  // 子视图不是整块 DMABUF
+        results_[i].detections.clear();
+        results_[i].timing = DetectionTiming{};
+    }
+    const std::size_t chunk = std::max<std::size_t>(1, confirm_->maxBatchSize());
+    bool ok = true;
+    for (std::size_t begin = 0; begin < views_.size(); begin += chunk) {
+        const std::size_t n = std::min(chunk, views_.size() - begin);
+        if (!confirm_->runBatch(&views_[begin], &results_[begin], n)) ok = false;
+    }
+
+    StageTimer timer(desc_.profiling);
+    for (std::size_t i = 0; i < crops_.size(); ++i) {
+        const auto& c = crops_[i];
+        addTiming(outResult.timing, results_[i].timing);
+        for (auto& d : results_[i].detections) {
+            if (d.score < desc_.cascadeConfirmThreshold) continue;
+            d.bbox.x += c.x;
+            d.bbox.y += c.y;
+            if (touchesInnerEdge(c, d.bbox, image.width, image.height)) continue;
+            outResult.detections.push_back(d);
+        }
+    }
+    mergeDetections(outResult.detections);
+    outResult.timing.nmsUs += timer.lapUs();
+    return ok;
+}
+
+} // namespace falconmind::sdk::perception
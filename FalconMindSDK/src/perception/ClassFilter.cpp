@@ -0,0 +1,104 @@
+#include "falconmind/sdk/perception/ClassFilter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+std::string lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+std::string trim(const std::string& s) {
+    const auto begin = s.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return {};
+    const auto end = s.find_last_not_of(" \t\r\n");
+    return s.substr(begin, end - begin + 1);
+}
+
+// 任务里常用的类别组
+const std::vector<std::string>& expandAlias(const std::string& name) {
+    static const std::vector<std::string> kVehicle{"car", "motorcycle", "bus", "truck"};
+    static const std::vector<std::string> kNone;
+    return name == "vehicle" ? kVehicle : kNone;
+}
+
+} // namespace
+
+const std::vector<std::string>& cocoClassLabels() {
+    static const std::vector<std::string> labels{
+        "person",        "bicycle",      "car",           "motorcycle",    "airplane",     "bus",
+        "train",         "truck",        "boat",          "traffic light", "fire hydrant", "stop sign",
+        "parking meter", "bench",        "bird",          "cat",           "dog",          "horse",
+        "sheep",         "cow",          "elephant",      "bear",          "zebra",        "giraffe",
+        "backpack",      "umbrella",     "handbag",       "tie",           "suitcase",     "frisbee",
+        "skis",          "snowboard",    "sports ball",   "kite",          "baseball bat", "baseball glove",
+        "skateboard",    "surfboard",    "tennis racket", "bottle",        "wine glass",   "cup",
+        "fork",          "knife",        "spoon",         "bowl",          "banana",       "apple",
+        "sandwich",      "orange",       "broccoli",      "carrot",        "hot dog",      "pizza",
+        "donut",         "cake",         "chair",         "couch",         "potted plant", "bed",
+        "dining table",  "toilet",       "tv",            "laptop",        "mouse",        "remote",
+        "keyboard",      "cell phone",   "microwave",     "oven",          "toaster",      "sink",
+        "refrigerator",  "book",         "clock",         "vase",          "scissors",     "teddy bear",
+        "hair drier",    "toothbrush"};
+    return labels;
+}
+
+std::vector<std::string> loadClassLabels(const std::string& path) {
+    std::vector<std::string> labels;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        line = trim(line);
+        if (!line.empty()) labels.push_back(line);
+    }
+    return labels;
+}
+
+std::vector<int> resolveClassIds(const std::vector<std::string>& names, const std::vector<std::string>& labels,
+                                 std::vector<std::string>* unknown) {
+    auto find = [&labels](const std::string& name) {
+        for (std::size_t i = 0; i < labels.size(); ++i) {
+            if (lower(labels[i]) == name) return static_cast<int>(i);
+        }
+        return -1;
+    };
+    std::vector<int> ids;
+    for (const auto& raw : names) {
+        const std::string name = lower(trim(raw));
+        if (name.empty()) continue;
+        if (name.size() <= 6 &&
+            std::all_of(name.begin(), name.end(), [](unsigned char c) { return std::isdigit(c) != 0; })) {
+            ids.push_back(std::stoi(name));
+            continue;
+        }
+        const int id = find(name);
+        if (id >= 0) {
+            ids.push_back(id);
+            continue;
+        }
+        bool expanded = false;
+        for (const auto& member : expandAlias(name)) {
+            const int memberId = find(member);
+            if (memberId >= 0) {
+                ids.push_back(memberId);
+                expanded = true;
+            }
+        }
+        if (!expanded && unknown) unknown->push_back(raw);
+    }
+    return normalizeClassIds(std::move(ids));
+}
+
+std::vector<int> normalizeClassIds(std::vector<int> ids) {
+    ids.erase(std::remove_if(ids.begin(), ids.end(), [](int id) { return id < 0; }), ids.end());
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,94 @@
+#include "falconmind/sdk/perception/DetectionBatcher.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace falconmind::sdk::perception {
+
+DetectionBatcher::DetectionBatcher(DetectorBackendPtr backend, const Config& cfg, ResultHandler onResult)
+    : backend_(std::move(backend)), onResult_(std::move(onResult)), maxWait_(cfg.maxWait) {
+    maxBatch_ = cfg.maxBatch > 0 ? cfg.maxBatch : (backend_ ? std::max<std::size_t>(1, backend_->maxBatchSize()) : 1);
+    queueDepth_ = std::max(cfg.queueDepth > 0 ? cfg.queueDepth : 2 * maxBatch_, maxBatch_);
+    thread_ = std::thread([this] { workerLoop(); });
+}
+
+DetectionBatcher::~DetectionBatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+bool DetectionBatcher::submit(std::size_t stream, const ImageView& image, core::BufferRef frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!backend_ || stopping_ || queue_.size() >= queueDepth_) {
+            ++drops_;
+            return false;
+        }
+        Item item;
+        item.stream = stream;
+        item.image = image;
+        item.frame = std::move(frame);
+        item.arrival = std::chrono::steady_clock::now();
+        queue_.push_back(std::move(item));
+        if (queue_.size() < maxBatch_ && queue_.size() > 1) return true;  // 推理线程已在等待截止时刻
+    }
+    cv_.notify_one();
+    return true;
+}
+
+std::uint64_t DetectionBatcher::batches() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batches_;
+}
+
+std::uint64_t DetectionBatcher::frames() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return frames_;
+}
+
+std::uint64_t DetectionBatcher::drops() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return drops_;
+}
+
+void DetectionBatcher::workerLoop() {
+    std::vector<Item> batch;
+    std::vector<ImageView> images;
+    std::vector<DetectionResult> results;
+    batch.reserve(maxBatch_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) return;  // stopping_
+        // 凑批：满 maxBatch、最早一帧到期或正在退出时立即执行
+        const auto deadline = queue_.front().arrival + maxWait_;
+        cv_.wait_until(lock, deadline, [this] { return stopping_ || queue_.size() >= maxBatch_; });
+
+        const std::size_t n = std::min(maxBatch_, queue_.size());
+        batch.clear();
+        for (std::size_t i = 0; i < n; ++i) {
+            batch.push_back(std::move(queue_.front()));
+            queue_.pop_front();
+        }
+        ++batches_;
+        frames_ += n;
+        lock.unlock();
+
+        images.resize(n);
+        results.assign(n, DetectionResult{});
+        for (std::size_t i = 0; i < n; ++i) images[i] = batch[i].image;
+        const bool ok = backend_->runBatch(images.data(), results.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (onResult_) onResult_(batch[i].stream, images[i], results[i], ok);
+        }
+        batch.clear();  // 回调完成后释放帧
+
+        lock.lock();
+    }
+}
+
+} // namespace falconmind::sdk::perception
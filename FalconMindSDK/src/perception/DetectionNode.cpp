@@ -0,0 +1,499 @@
+#include "falconmind/sdk/perception/DetectionNode.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/Trace.h"
+#include "falconmind/sdk/perception/AltitudeModelPolicy.h"
+#include "falconmind/sdk/perception/DetectionResultPacket.h"
+#include "falconmind/sdk/perception/PerceptionPluginManager.h"
+#include "falconmind/sdk/perception/TiledDetectorBackend.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace falconmind::sdk::perception {
+
+using namespace falconmind::sdk::core;
+using namespace falconmind::sdk::sensors;
+
+bool makeCameraImageView(const BufferRef& frame, PixelFormat negotiated, ImageView& imageView) {
+    if (frame.size() < sizeof(CameraFramePacket)) return false;
+    // 设备缓冲：帧头不迁移；像素仍需 host 地址（预处理 / 非 fd 后端），由 data() 按需映射或复制一次
+    const auto* h = reinterpret_cast<const CameraFramePacket*>(frame.headerData(sizeof(CameraFramePacket)));
+    const std::uint8_t* host = frame.data();
+    if (!h || !host) return false;
+    imageView = ImageView{};
+    imageView.data = cameraFramePacketData(reinterpret_cast<const CameraFramePacket*>(host));
+    imageView.width = h->width;
+    imageView.height = h->height;
+    // 格式取自缓冲元数据或 link 协商结果；仅对未协商的原始包回退解析帧头字符串
+    PixelFormat fmt = frame.meta().video.format != PixelFormat::Any ? frame.meta().video.format : negotiated;
+    if (fmt == PixelFormat::Any) {
+        fmt = h->format[0] != '\0' ? parsePixelFormat(h->format) : PixelFormat::RGB8;
+    }
+    imageView.format = fmt;
+    imageView.stride = h->stride > 0 ? h->stride
+        : pixelFormatMinStride(fmt != PixelFormat::Any ? fmt : PixelFormat::RGB8, h->width);
+    imageView.pixelFormat = fmt != PixelFormat::Any ? pixelFormatName(fmt) : h->format;
+    imageView.captureTimestampNs = frame.meta().timestampNs != 0 ? frame.meta().timestampNs
+                                                                 : h->captureTimestampNs;
+    imageView.frameIndex = static_cast<std::uint32_t>(frame.meta().frameIndex);
+    imageView.dmabufFd = frame.dmabufFd();
+    if (frame.meta().region.cropped()) {
+        imageView.offsetX = frame.meta().region.x;
+        imageView.offsetY = frame.meta().region.y;
+    }
+    size_t rows = static_cast<size_t>(h->height);
+    if (fmt == PixelFormat::NV12) rows += (rows + 1) / 2;
+    size_t expectedPixels = static_cast<size_t>(imageView.stride) * rows;
+    return frame.size() >= sizeof(CameraFramePacket) + expectedPixels;
+}
+
+namespace {
+
+// 裁剪帧（跟踪 ROI）上的检测框平移回源全幅坐标，跟踪器在全幅坐标下关联，不受窗口移动影响
+void toSourceCoordinates(DetectionResult& result, const ImageView& image) {
+    if (image.offsetX == 0 && image.offsetY == 0) return;
+    for (auto& det : result.detections) {
+        det.bbox.x += static_cast<float>(image.offsetX);
+        det.bbox.y += static_cast<float>(image.offsetY);
+    }
+}
+
+} // namespace
+
+DetectionNode::DetectionNode()
+    : Node("detection"), StageProfileSink({"preprocess", "infer", "decode", "nms", "device"}) {
+    auto in = std::make_shared<Pad>("video_in", PadType::Sink);
+    in->setCapsCallback([this](const VideoCaps& caps) { inputFormat_ = caps.format; });
+    inPad_ = addPad(in);
+    outPad_ = addPad(std::make_shared<Pad>("detection_out", PadType::Source));
+}
+
+DetectionNode::~DetectionNode() {
+    shutdownStages();
+}
+
+void DetectionNode::setBackend(DetectorBackendPtr backend) {
+    backend_ = std::move(backend);
+    tiledBackend_ = dynamic_cast<TiledDetectorBackend*>(backend_.get());
+    Caps caps;
+    if (backend_) {
+        for (auto f : backend_->supportedPixelFormats()) {
+            caps.addVideo(VideoCaps{f, 0, 0, 0});
+        }
+    }
+    if (inPad_) inPad_->setCaps(caps);
+}
+
+bool DetectionNode::setModelPolicy(std::shared_ptr<AltitudeModelPolicy> policy, PerceptionPluginManager* manager) {
+    modelPolicy_.reset();
+    modelManager_ = nullptr;
+    activeDetectorId_.clear();
+    pendingDetectorId_.clear();
+    failedDetectorId_.clear();
+    if (!policy || !manager) return true;
+    const std::string id = policy->current().detectorId;
+    auto backend = manager->acquireDetector(id);
+    if (!backend) {
+        FM_LOG_ERROR("DetectionNode", "cannot acquire detector '", id, "' for model policy");
+        return false;
+    }
+    setBackend(std::move(backend));
+    modelPolicy_ = std::move(policy);
+    modelManager_ = manager;
+    activeDetectorId_ = id;
+    return true;
+}
+
+bool DetectionNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    auto it = params.find("modelName");
+    if (it != params.end()) modelName_ = it->second;
+    it = params.find("queue_depth");
+    if (it != params.end()) {
+        try {
+            const long depth = std::stol(it->second);
+            if (depth < 1) throw std::invalid_argument("queue_depth");
+            configuredDepth_ = static_cast<std::size_t>(depth);
+        } catch (const std::exception&) {
+            FM_LOG_ERROR("DetectionNode", "invalid queue_depth: ", it->second);
+            return false;
+        }
+    }
+    it = params.find("label_path");
+    if (it != params.end() && !it->second.empty()) {
+        classLabels_ = loadClassLabels(it->second);
+        if (classLabels_.empty()) {
+            FM_LOG_ERROR("DetectionNode", "cannot read labels from label_path: ", it->second);
+            return false;
+        }
+    }
+    it = params.find("classes");
+    if (it != params.end()) {
+        configuredClasses_.clear();
+        std::stringstream ss(it->second);
+        std::string name;
+        while (std::getline(ss, name, ',')) {
+            if (name.find_first_not_of(" \t") != std::string::npos) configuredClasses_.push_back(name);
+        }
+    }
+    return true;
+}
+
+void DetectionNode::setClassesOfInterest(const std::vector<std::string>& names) {
+    missionClasses_ = names;
+}
+
+bool DetectionNode::start() {
+    if (inPad_) {
+        inPad_->setBufferCallback([this](const BufferRef& frame) {
+            if (frame.size() < sizeof(CameraFramePacket)) return;
+            std::lock_guard<std::mutex> lock(frameMutex_);
+            if (lastFrame_) overwrittenFrames_.fetch_add(1, std::memory_order_relaxed);
+            lastFrame_ = frame;
+        });
+    }
+    shutdownStages();
+    if (!backend_) {
+        FM_LOG_INFO("DetectionNode", "start with model=", modelName_, " (no backend, empty results)");
+        return true;
+    }
+    return startStages();
+}
+
+bool DetectionNode::startStages() {
+    if (placement().npuCoreMask != 0 && !backend_->setNpuCoreMask(placement().npuCoreMask)) {
+        FM_LOG_WARN("DetectionNode", "backend ignores npu_core_mask=", placement().npuCoreMask);
+    }
+    const auto& names = configuredClasses_.empty() ? missionClasses_ : configuredClasses_;
+    std::vector<std::string> unknown;
+    activeClasses_ = resolveClassIds(names, classLabels_.empty() ? cocoClassLabels() : classLabels_, &unknown);
+    for (const auto& name : unknown) {
+        FM_LOG_WARN("DetectionNode", "unknown detection class '", name, "' ignored");
+    }
+    if (!names.empty() && activeClasses_.empty()) {
+        FM_LOG_WARN("DetectionNode", "no known detection class in filter, decoding all classes");
+    }
+    if (!backend_->setClassFilter(activeClasses_) && !activeClasses_.empty()) {
+        FM_LOG_WARN("DetectionNode", "backend ignores class filter, decoding all classes");
+        activeClasses_.clear();
+    }
+    if (fallbackBackend_) fallbackBackend_->setClassFilter(activeClasses_);
+
+    const std::size_t workers = std::max<std::size_t>(1, backend_->maxConcurrentRuns());
+    std::size_t depth = configuredDepth_ > 0 ? configuredDepth_ : workers + 2;
+    staged_ = backend_->prepareStages(depth) >= depth;
+    // 不分阶段且后端支持异步提交：单个推理线程 submit()，在途帧由后端的推理线程重叠执行
+    const std::size_t asyncDepth = staged_ ? 1 : backend_->maxInFlight();
+    async_ = asyncDepth > 1;
+    if (async_ && configuredDepth_ == 0) depth = asyncDepth + 2;
+    slots_.assign(depth, Slot{});
+    submitted_ = preprocessed_ = inferNext_ = emitted_ = 0;
+    stopping_ = false;
+    preprocessThread_ = std::thread([this] { preprocessLoop(); });
+    for (std::size_t i = 0; i < (async_ ? 1 : std::min(workers, depth)); ++i) {
+        inferThreads_.emplace_back([this] { inferLoop(); });
+    }
+    inferWorkers_ = inferThreads_.size();
+    outputThread_ = std::thread([this] { outputLoop(); });
+    FM_LOG_INFO("DetectionNode", "start with model=", modelName_, " (", staged_ ? "staged" : async_ ? "submit()" : "run()",
+                ", ", inferWorkers_, " infer worker(s), queue_depth=", depth, rateController_ ? ", adaptive rate" : "",
+                activeDetectorId_.empty() ? "" : ", detector=", activeDetectorId_, ")");
+    return true;
+}
+
+void DetectionNode::stop() {
+    // 在途帧照常完成并输出
+    shutdownStages();
+    Node::stop();
+}
+
+void DetectionNode::shutdownStages() {
+    if (!outputThread_.joinable()) return;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return emitted_ == submitted_; });
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    preprocessThread_.join();
+    for (auto& t : inferThreads_) t.join();
+    inferThreads_.clear();
+    outputThread_.join();
+}
+
+std::size_t DetectionNode::inFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<std::size_t>(submitted_ - emitted_);
+}
+
+std::string DetectionNode::acceleratorDevice() const {
+    if (!backend_) return {};
+    switch (backend_->backendType()) {
+        case DetectionBackendType::Rknn: return "npu";
+        case DetectionBackendType::TensorRt: return "gpu";
+        default: return {};
+    }
+}
+
+std::int64_t DetectionNode::pendingWorkAgeNs(std::int64_t nowNs) const {
+    // 已切换到 fallback：主 backend 上残留的在途帧不再代表当前处理
+    if (fallbackActive()) return 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (emitted_ >= submitted_ || slots_.empty()) return 0;
+    return std::max<std::int64_t>(0, nowNs - slots_[emitted_ % slots_.size()].submittedNs);
+}
+
+bool DetectionNode::applyWatchdogAction(WatchdogAction action) {
+    if (action != WatchdogAction::FallbackBackend || !fallbackBackend_ || fallbackActive()) return false;
+    fallbackActive_.store(true, std::memory_order_release);
+    FM_LOG_WARN("DetectionNode", modelName_, ": switching to fallback backend");
+    return true;
+}
+
+void DetectionNode::process() {
+    BufferRef frame;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        frame = std::move(lastFrame_);
+        lastFrame_.reset();
+    }
+    if (!backend_) {
+        emitResult(DetectionResult{});
+        return;
+    }
+    if (frame && fallbackActive()) {
+        runFallback(frame);
+        return;
+    }
+    if (!frame || !outputThread_.joinable()) return;
+    if (modelPolicy_) {
+        applyModelPolicy(frame);
+        if (!outputThread_.joinable()) return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (submitted_ - emitted_ >= slots_.size()) {
+            // 每级都有帧在处理：丢弃新帧，避免时延堆积
+            pipelineDrops_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        Slot& slot = slots_[submitted_ % slots_.size()];
+        slot.frame = std::move(frame);
+        slot.state = SlotState::Submitted;
+        slot.submittedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch()).count();
+        ++submitted_;
+    }
+    cv_.notify_all();
+}
+
+void DetectionNode::applyModelPolicy(const BufferRef& frame) {
+    const auto* h = reinterpret_cast<const CameraFramePacket*>(frame.headerData(sizeof(CameraFramePacket)));
+    if (!h) return;
+    const std::string wanted = modelPolicy_->select(h->width, h->height).detectorId;
+    if (wanted.empty() || wanted == activeDetectorId_ || wanted == failedDetectorId_) {
+        pendingDetectorId_.clear();
+        return;
+    }
+    if (wanted != pendingDetectorId_) {
+        pendingDetectorId_ = wanted;
+        modelManager_->preloadDetector(wanted);
+    }
+    // 加载与预热在管理器的后台线程进行，常驻之前继续使用当前 backend
+    const auto resident = modelManager_->residentDetectors();
+    if (std::find(resident.begin(), resident.end(), wanted) == resident.end()) return;
+    auto next = modelManager_->acquireDetector(wanted);
+    pendingDetectorId_.clear();
+    if (!next) {
+        FM_LOG_WARN("DetectionNode", modelName_, ": cannot acquire detector '", wanted, "', keeping ", activeDetectorId_);
+        failedDetectorId_ = wanted;
+        return;
+    }
+    if (inputFormat_ != PixelFormat::Any) {
+        const auto formats = next->supportedPixelFormats();
+        if (std::find(formats.begin(), formats.end(), inputFormat_) == formats.end()) {
+            FM_LOG_WARN("DetectionNode", modelName_, ": detector '", wanted, "' does not accept negotiated format ",
+                        pixelFormatName(inputFormat_), ", keeping ", activeDetectorId_);
+            failedDetectorId_ = wanted;
+            return;
+        }
+    }
+    // 在途帧在旧 backend 上完成并按序输出后再换用新 backend
+    shutdownStages();
+    FM_LOG_INFO("DetectionNode", modelName_, ": switching detector ", activeDetectorId_, " -> ", wanted,
+                " (range ", modelPolicy_->rangeM(), " m)");
+    backend_ = std::move(next);
+    tiledBackend_ = dynamic_cast<TiledDetectorBackend*>(backend_.get());
+    activeDetectorId_ = wanted;
+    failedDetectorId_.clear();
+    modelSwitches_.fetch_add(1, std::memory_order_relaxed);
+    startStages();
+}
+
+void DetectionNode::preprocessLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return stopping_ || preprocessed_ < submitted_; });
+        if (preprocessed_ == submitted_) return;  // stopping_
+        const std::uint64_t seq = preprocessed_;
+        Slot& slot = slots_[seq % slots_.size()];
+        lock.unlock();
+
+        slot.ok = makeCameraImageView(slot.frame, inputFormat_, slot.image);
+        slot.result.timing = DetectionTiming{};
+        slot.predicted = false;
+        slot.hasRegions = false;
+        if (slot.ok && motionGate_) {
+            const MotionGateResult& gate = motionGate_->evaluate(slot.image);
+            if (gate.decision == MotionDecision::Skip) {
+                slot.predicted = true;
+                motionSkipped_.fetch_add(1, std::memory_order_relaxed);
+            } else if (gate.decision == MotionDecision::Regions && tiledBackend_) {
+                slot.hasRegions = true;
+                slot.regions = gate.regions;
+                slot.shiftX = gate.shiftX;
+                slot.shiftY = gate.shiftY;
+            }
+        }
+        if (slot.ok && !slot.predicted && rateController_) slot.predicted = !rateController_->shouldDetect(slot.image);
+        if (slot.ok && !slot.predicted && staged_) slot.ok = backend_->preprocessStage(seq % slots_.size(), slot.image);
+
+        lock.lock();
+        slot.state = SlotState::Preprocessed;
+        ++preprocessed_;
+        cv_.notify_all();
+    }
+}
+
+void DetectionNode::inferLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return stopping_ || inferNext_ < preprocessed_; });
+        if (inferNext_ == preprocessed_) return;  // stopping_
+        const std::uint64_t seq = inferNext_++;
+        Slot& slot = slots_[seq % slots_.size()];
+        slot.state = SlotState::Inferring;
+        lock.unlock();
+
+        if (slot.ok && !slot.predicted && async_) {
+            FM_TRACE_SCOPE("perception", "backend.submit");
+            // 时间片持有到推理完成；回调在后端线程上把 slot 标记为 Inferred
+            auto lease = std::make_shared<AcceleratorLease>(acquireAccelerator());
+            const bool submitted = backend_->submit(slot.image, slot.result, [this, &slot, lease](bool ok) {
+                lease->release();
+                {
+                    std::lock_guard<std::mutex> guard(mutex_);
+                    slot.ok = ok;
+                    slot.state = SlotState::Inferred;
+                }
+                cv_.notify_all();
+            });
+            lock.lock();
+            if (submitted) continue;
+            slot.ok = false;
+            slot.state = SlotState::Inferred;
+            cv_.notify_all();
+            continue;
+        }
+        if (slot.ok && !slot.predicted) {
+            FM_TRACE_SCOPE("perception", "backend.run");
+            AcceleratorLease lease = acquireAccelerator();
+            // 切片后端不分阶段且 maxConcurrentRuns() 为 1，变化区域在推理线程上紧挨 run() 设置
+            if (slot.hasRegions && !staged_) tiledBackend_->setChangedRegions(slot.regions, slot.shiftX, slot.shiftY);
+            slot.ok = staged_ ? backend_->inferStage(seq % slots_.size()) : backend_->run(slot.image, slot.result);
+        }
+
+        lock.lock();
+        slot.state = SlotState::Inferred;
+        cv_.notify_all();
+    }
+}
+
+void DetectionNode::outputLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] {
+            return (emitted_ < submitted_ && slots_[emitted_ % slots_.size()].state == SlotState::Inferred) ||
+                   (stopping_ && emitted_ == submitted_);
+        });
+        if (emitted_ == submitted_) return;  // stopping_
+        const std::uint64_t seq = emitted_;
+        Slot& slot = slots_[seq % slots_.size()];
+        lock.unlock();
+
+        if (slot.predicted) {
+            slot.result = DetectionResult{};
+            slot.result.trackerPredicted = true;
+            predictedResults_.fetch_add(1, std::memory_order_relaxed);
+        } else if (slot.ok && staged_) {
+            slot.ok = backend_->postprocessStage(seq % slots_.size(), slot.result);
+        }
+        if (slot.ok) {
+            // 以源帧为准（后端可能未填写）
+            slot.result.timestampNs = static_cast<std::uint64_t>(slot.image.captureTimestampNs);
+            slot.result.frameIndex = slot.image.frameIndex;
+            toSourceCoordinates(slot.result, slot.image);
+            markLatency(slot.result);
+            if (!slot.predicted) recordTiming(slot.result.timing);
+            emitResult(slot.result);
+            emittedResults_.fetch_add(1, std::memory_order_relaxed);
+        }
+        slot.frame.reset();
+
+        lock.lock();
+        slot.state = SlotState::Free;
+        ++emitted_;
+        cv_.notify_all();
+    }
+}
+
+void DetectionNode::runFallback(const BufferRef& frame) {
+    ImageView image;
+    if (!makeCameraImageView(frame, inputFormat_, image)) return;
+    DetectionResult result;
+    {
+        FM_TRACE_SCOPE("perception", "fallback.run");
+        if (!fallbackBackend_->run(image, result)) return;
+    }
+    result.timestampNs = static_cast<std::uint64_t>(image.captureTimestampNs);
+    result.frameIndex = image.frameIndex;
+    toSourceCoordinates(result, image);
+    markLatency(result);
+    emitResult(result);
+    emittedResults_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DetectionNode::emitResult(const DetectionResult& result) {
+    std::lock_guard<std::mutex> lock(emitMutex_);
+    resultPacketBuffer_.resize(detectionResultPacketV2Size(result));
+    size_t written = serializeDetectionResultV2(result, resultPacketBuffer_.data(), resultPacketBuffer_.size());
+    if (written > 0 && outPad_) outPad_->pushToConnections(resultPacketBuffer_.data(), written);
+}
+
+void DetectionNode::markLatency(DetectionResult& result) {
+    std::int64_t now = PipelineClock::nowNs();
+    std::uint64_t over = latencyTracker_.record(static_cast<std::int64_t>(result.timestampNs), now);
+    result.overLatencyBudget = over > 0;
+    // 首次及此后每 100 次超限告警一次，避免逐帧刷屏
+    if (over == 1 || (over > 0 && over % 100 == 0)) {
+        FM_LOG_WARN("DetectionNode", "frame ", result.frameIndex, " glass-to-detection latency ",
+                    (now - static_cast<std::int64_t>(result.timestampNs)) / 1000000, "ms exceeds budget ",
+                    latencyTracker_.budgetNs() / 1000000, "ms (", over, " frame(s) over budget)");
+    }
+}
+
+void DetectionNode::recordTiming(const DetectionTiming& timing) {
+    // 后端未开启 profiling 时各项均为 0，不计入
+    if (timing.preprocessUs == 0 && timing.inferUs == 0 && timing.decodeUs == 0 && timing.nmsUs == 0) return;
+    stageProfiler_.recordUs(0, timing.preprocessUs);
+    stageProfiler_.recordUs(1, timing.inferUs);
+    stageProfiler_.recordUs(2, timing.decodeUs);
+    stageProfiler_.recordUs(3, timing.nmsUs);
+    if (timing.deviceUs > 0) stageProfiler_.recordUs(4, timing.deviceUs);
+    stageProfiler_.recordUtilization(timing.deviceUtilization);
+}
+
+} // namespace falconmind::sdk::perception
@@ -5,6 +5,32 @@
 
 namespace falconmind::sdk::perception {
 
+namespace {
+
+constexpr std::size_t kMaxClassNames = DETECTION_RESULT_NO_CLASS_NAME;  // 下标 0xFFFF 保留为"无名称"
+
+// 按首次出现顺序去重类别名（空名不入表）；返回 name 在表中的下标，未入表返回 DETECTION_RESULT_NO_CLASS_NAME
+std::uint16_t internName(std::vector<std::string_view>& names, const std::string& name) {
+    if (name.empty()) return DETECTION_RESULT_NO_CLASS_NAME;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) return static_cast<std::uint16_t>(i);
+    }
+    if (names.size() >= kMaxClassNames) return DETECTION_RESULT_NO_CLASS_NAME;
+    names.push_back(name);
+    return static_cast<std::uint16_t>(names.size() - 1);
+}
+
+std::size_t alignUp4(std::size_t n) { return (n + 3u) & ~static_cast<std::size_t>(3u); }
+
+std::size_t v2Size(std::size_t numDetections, const std::vector<std::string_view>& names) {
+    std::size_t stringBytes = 0;
+    for (const auto& n : names) stringBytes += n.size() + 1;
+    return alignUp4(sizeof(DetectionResultPacketHeaderV2) + numDetections * sizeof(DetectionResultPacketItemV2) +
+                    (names.size() + 1) * sizeof(std::uint32_t) + stringBytes);
+}
+
+} // namespace
+
 std::size_t serializeDetectionResult(
     const DetectionResult& result,
     std::uint8_t* buffer,
@@ -19,6 +45,9 @@ std::size_t serializeDetectionResult(
     DetectionResultPacketHeader* h = reinterpret_cast<DetectionResultPacketHeader*>(buffer);
     h->magic = DETECTION_RESULT_PACKET_MAGIC;
     h->version = 1;
+    h->flags = static_cast<std::uint8_t>((result.overLatencyBudget ? DETECTION_RESULT_FLAG_OVER_LATENCY_BUDGET : 0) |
+                                         (result.trackerPredicted ? DETECTION_RESULT_FLAG_TRACKER_PREDICTED : 0));
+    h->reserved[0] = h->reserved[1] = 0;
     h->frameIndex = result.frameIndex;
     h->timestampNs = result.timestampNs;
     h->numDetections = static_cast<std::uint32_t>(n);
@@ -37,10 +66,156 @@ std::size_t serializeDetectionResult(
 }
 
 std::uint32_t parseDetectionResultPacketNumDetections(const void* buffer, std::size_t size) {
-    if (!buffer || size < sizeof(DetectionResultPacketHeader)) return 0;
-    const auto* h = static_cast<const DetectionResultPacketHeader*>(buffer);
-    if (h->magic != DETECTION_RESULT_PACKET_MAGIC || h->version != 1) return 0;
-    return h->numDetections;
+    DetectionResultView view;
+    return view.parse(buffer, size) ? static_cast<std::uint32_t>(view.size()) : 0;
+}
+
+bool deserializeDetectionResult(const void* buffer, std::size_t size, DetectionResult& out) {
+    DetectionResultView view;
+    if (!view.parse(buffer, size)) return false;
+    view.toDetectionResult(out);
+    return true;
+}
+
+std::size_t detectionResultPacketV2Size(const DetectionResult& result) {
+    std::vector<std::string_view> names;
+    for (const auto& d : result.detections) internName(names, d.className);
+    return v2Size(result.detections.size(), names);
+}
+
+std::size_t serializeDetectionResultV2(const DetectionResult& result, std::uint8_t* buffer, std::size_t bufferSize) {
+    const std::size_t n = result.detections.size();
+    std::vector<std::string_view> names;
+    std::vector<std::uint16_t> nameIndex(n);
+    for (std::size_t i = 0; i < n; ++i) nameIndex[i] = internName(names, result.detections[i].className);
+    const std::size_t total = v2Size(n, names);
+    if (!buffer || bufferSize < total) return 0;
+
+    auto* h = reinterpret_cast<DetectionResultPacketHeaderV2*>(buffer);
+    *h = DetectionResultPacketHeaderV2{};
+    h->flags = static_cast<std::uint8_t>((result.overLatencyBudget ? DETECTION_RESULT_FLAG_OVER_LATENCY_BUDGET : 0) |
+                                         (result.trackerPredicted ? DETECTION_RESULT_FLAG_TRACKER_PREDICTED : 0));
+    h->frameIndex = result.frameIndex;
+    h->numDetections = static_cast<std::uint32_t>(n);
+    h->timestampNs = result.timestampNs;
+    h->numClassNames = static_cast<std::uint32_t>(names.size());
+    h->totalBytes = static_cast<std::uint32_t>(total);
+
+    auto* items = reinterpret_cast<DetectionResultPacketItemV2*>(buffer + sizeof(DetectionResultPacketHeaderV2));
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& d = result.detections[i];
+        items[i] = DetectionResultPacketItemV2{};
+        items[i].x = d.bbox.x;
+        items[i].y = d.bbox.y;
+        items[i].width = d.bbox.width;
+        items[i].height = d.bbox.height;
+        items[i].score = d.score;
+        items[i].classId = static_cast<std::int32_t>(d.classId);
+        items[i].trackId = static_cast<std::int32_t>(d.trackId);
+        items[i].classNameIndex = nameIndex[i];
+    }
+
+    auto* offsets = reinterpret_cast<std::uint32_t*>(items + n);
+    char* strings = reinterpret_cast<char*>(offsets + names.size() + 1);
+    std::uint32_t off = 0;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        offsets[i] = off;
+        std::memcpy(strings + off, names[i].data(), names[i].size());
+        off += static_cast<std::uint32_t>(names[i].size());
+        strings[off++] = '\0';
+    }
+    offsets[names.size()] = off;
+    std::memset(strings + off, 0, static_cast<std::size_t>(buffer + total - reinterpret_cast<std::uint8_t*>(strings + off)));
+    return total;
+}
+
+bool DetectionResultView::parse(const void* buffer, std::size_t size) {
+    *this = DetectionResultView{};
+    if (!buffer || size < sizeof(DetectionResultPacketHeader)) return false;
+    const auto* bytes = static_cast<const std::uint8_t*>(buffer);
+    const auto* h1 = static_cast<const DetectionResultPacketHeader*>(buffer);
+    if (h1->magic != DETECTION_RESULT_PACKET_MAGIC) return false;
+
+    if (h1->version == 1) {
+        if (size < detectionResultPacketSize(h1->numDetections)) return false;
+        itemsV1_ = reinterpret_cast<const DetectionResultPacketItem*>(bytes + sizeof(DetectionResultPacketHeader));
+        count_ = h1->numDetections;
+        frameIndex_ = h1->frameIndex;
+        timestampNs_ = h1->timestampNs;
+        flags_ = h1->flags;
+    } else if (h1->version == DETECTION_RESULT_PACKET_VERSION_2) {
+        const auto* h = static_cast<const DetectionResultPacketHeaderV2*>(buffer);
+        if (h->headerBytes < sizeof(DetectionResultPacketHeaderV2) || h->headerBytes % 4 != 0) return false;
+        if (h->totalBytes > size || h->numClassNames >= kMaxClassNames + 1) return false;
+        // 各段边界按 64 位计算，避免畸形计数溢出
+        const std::uint64_t itemsEnd = h->headerBytes + std::uint64_t{h->numDetections} * sizeof(DetectionResultPacketItemV2);
+        const std::uint64_t stringsBegin = itemsEnd + (std::uint64_t{h->numClassNames} + 1) * sizeof(std::uint32_t);
+        if (stringsBegin > h->totalBytes) return false;
+        const auto* offsets = reinterpret_cast<const std::uint32_t*>(bytes + itemsEnd);
+        const std::uint64_t stringBytes = h->totalBytes - stringsBegin;
+        // 偏移单调且每个名称以 '\0' 结尾，访问器无需再做边界检查
+        if (offsets[0] != 0 || offsets[h->numClassNames] > stringBytes) return false;
+        const char* strings = reinterpret_cast<const char*>(bytes + stringsBegin);
+        for (std::uint32_t i = 0; i < h->numClassNames; ++i) {
+            if (offsets[i] >= offsets[i + 1] || strings[offsets[i + 1] - 1] != '\0') return false;
+        }
+        itemsV2_ = reinterpret_cast<const DetectionResultPacketItemV2*>(bytes + h->headerBytes);
+        nameOffsets_ = offsets;
+        names_ = strings;
+        numNames_ = h->numClassNames;
+        count_ = h->numDetections;
+        frameIndex_ = h->frameIndex;
+        timestampNs_ = h->timestampNs;
+        flags_ = h->flags;
+    } else {
+        return false;
+    }
+    version_ = h1->version;
+    data_ = bytes;
+    return true;
+}
+
+DetectionBBox DetectionResultView::bbox(std::size_t i) const noexcept {
+    if (itemsV2_) return {itemsV2_[i].x, itemsV2_[i].y, itemsV2_[i].width, itemsV2_[i].height};
+    return {itemsV1_[i].x, itemsV1_[i].y, itemsV1_[i].width, itemsV1_[i].height};
+}
+
+float DetectionResultView::score(std::size_t i) const noexcept {
+    return itemsV2_ ? itemsV2_[i].score : itemsV1_[i].score;
+}
+
+int DetectionResultView::classId(std::size_t i) const noexcept {
+    return itemsV2_ ? itemsV2_[i].classId : itemsV1_[i].classId;
+}
+
+int DetectionResultView::trackId(std::size_t i) const noexcept {
+    return itemsV2_ ? itemsV2_[i].trackId : -1;
+}
+
+std::string_view DetectionResultView::className(std::size_t i) const noexcept {
+    return itemsV2_ ? classNameAt(itemsV2_[i].classNameIndex) : std::string_view{};
+}
+
+std::string_view DetectionResultView::classNameAt(std::size_t nameIndex) const noexcept {
+    if (nameIndex >= numNames_) return {};
+    return std::string_view(names_ + nameOffsets_[nameIndex], nameOffsets_[nameIndex + 1] - nameOffsets_[nameIndex] - 1);
+}
+
+void DetectionResultView::toDetectionResult(DetectionResult& out) const {
+    out.frameId.clear();
+    out.frameIndex = frameIndex_;
+    out.timestampNs = timestampNs_;
+    out.overLatencyBudget = overLatencyBudget();
+    out.trackerPredicted = trackerPredicted();
+    out.detections.resize(count_);
+    for (std::size_t i = 0; i < count_; ++i) {
+        auto& d = out.detections[i];
+        d.bbox = bbox(i);
+        d.score = score(i);
+        d.classId = classId(i);
+        d.trackId = trackId(i);
+        d.className.assign(className(i));
+    }
 }
 
 } // namespace falconmind::sdk::perception
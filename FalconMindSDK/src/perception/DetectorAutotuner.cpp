@@ -0,0 +1,415 @@
+#include "falconmind/sdk/perception/DetectorAutotuner.h"
+#include "falconmind/sdk/core/CaptureFile.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/perception/DetectionNode.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+std::uint64_t fnv1a(std::uint64_t h, const char* data, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+constexpr std::uint64_t kFnvOffset = 1469598103934665603ull;
+constexpr std::size_t kFingerprintChunk = 1 << 20;
+
+std::string sanitize(std::string s) {
+    for (auto& c : s) {
+        if (c == '\t' || c == '\n' || c == '\r' || c == '\0') c = ' ';
+    }
+    const auto begin = s.find_first_not_of(' ');
+    const auto end = s.find_last_not_of(' ');
+    return begin == std::string::npos ? std::string{} : s.substr(begin, end - begin + 1);
+}
+
+bool sameConfig(const TunedBackendConfig& a, const TunedBackendConfig& b) {
+    return a.intraOpThreads == b.intraOpThreads && a.executionProviders == b.executionProviders &&
+           a.npuContexts == b.npuContexts && a.npuCoreMask == b.npuCoreMask && a.cudaStreams == b.cudaStreams &&
+           a.maxBatch == b.maxBatch;
+}
+
+void addCandidate(std::vector<TunedBackendConfig>& list, const TunedBackendConfig& c) {
+    for (const auto& existing : list) {
+        if (sameConfig(existing, c)) return;
+    }
+    list.push_back(c);
+}
+
+bool parseConfig(const std::string& text, TunedBackendConfig& out) {
+    std::stringstream ss(text);
+    std::string item;
+    try {
+        while (std::getline(ss, item, ',')) {
+            const auto eq = item.find('=');
+            if (eq == std::string::npos) continue;
+            const std::string key = item.substr(0, eq);
+            const std::string value = item.substr(eq + 1);
+            if (key == "intra_op_threads") {
+                out.intraOpThreads = std::stoi(value);
+            } else if (key == "providers") {
+                out.executionProviders.clear();
+                std::stringstream eps(value);
+                std::string ep;
+                while (std::getline(eps, ep, '|')) {
+                    if (!ep.empty()) out.executionProviders.push_back(ep);
+                }
+            } else if (key == "npu_contexts") {
+                out.npuContexts = std::stoi(value);
+            } else if (key == "npu_core_mask") {
+                out.npuCoreMask = static_cast<std::uint32_t>(std::stoul(value, nullptr, 16));
+            } else if (key == "cuda_streams") {
+                out.cudaStreams = std::stoi(value);
+            } else if (key == "max_batch") {
+                out.maxBatch = std::stoi(value);
+            }
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+TunedBackendConfig TunedBackendConfig::fromDescriptor(const DetectorDescriptor& desc) {
+    TunedBackendConfig c;
+    c.intraOpThreads = desc.intraOpThreads;
+    c.executionProviders = desc.executionProviders;
+    c.npuContexts = desc.npuContexts;
+    c.cudaStreams = desc.cudaStreams;
+    c.maxBatch = desc.maxBatch;
+    return c;
+}
+
+void TunedBackendConfig::applyTo(DetectorDescriptor& desc) const {
+    desc.intraOpThreads = intraOpThreads;
+    desc.executionProviders = executionProviders;
+    desc.npuContexts = npuContexts;
+    desc.cudaStreams = cudaStreams;
+    desc.maxBatch = maxBatch;
+}
+
+std::string TunedBackendConfig::describe() const {
+    std::ostringstream os;
+    os << "intra_op_threads=" << intraOpThreads << ",providers=";
+    for (std::size_t i = 0; i < executionProviders.size(); ++i) {
+        os << (i ? "|" : "") << executionProviders[i];
+    }
+    os << ",npu_contexts=" << npuContexts << ",npu_core_mask=" << std::hex << npuCoreMask << std::dec
+       << ",cuda_streams=" << cudaStreams << ",max_batch=" << maxBatch;
+    return os.str();
+}
+
+DetectorAutotuner::DetectorAutotuner(AutotuneOptions options) : options_(std::move(options)) {
+    board_ = sanitize(options_.board.empty() ? boardIdentity() : options_.board);
+    loadCache();
+}
+
+DetectorAutotuner::~DetectorAutotuner() = default;
+
+std::vector<TunedBackendConfig> DetectorAutotuner::candidates(const DetectorDescriptor& desc) {
+    std::vector<TunedBackendConfig> list;
+    const TunedBackendConfig base = TunedBackendConfig::fromDescriptor(desc);
+    list.push_back(base);
+    switch (desc.backendType) {
+    case DetectionBackendType::OnnxRuntime: {
+        const int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int threads : {1, 2, 4, hw}) {
+            TunedBackendConfig c = base;
+            c.intraOpThreads = threads;
+            addCandidate(list, c);
+            if (base.maxBatch > 1) {
+                c.maxBatch = 1;
+                addCandidate(list, c);
+            }
+        }
+        break;
+    }
+    case DetectionBackendType::Rknn: {
+        TunedBackendConfig c = base;
+        for (auto [contexts, mask] : {std::pair<int, std::uint32_t>{1, 0u}, {1, 0x7u}, {2, 0u}, {3, 0u}}) {
+            c.npuContexts = contexts;
+            c.npuCoreMask = mask;
+            addCandidate(list, c);
+        }
+        break;
+    }
+    case DetectionBackendType::TensorRt: {
+        TunedBackendConfig c = base;
+        for (int streams : {1, 2, 4}) {
+            for (int batch : {1, std::max(1, base.maxBatch)}) {
+                c.cudaStreams = streams;
+                c.maxBatch = batch;
+                addCandidate(list, c);
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return list;
+}
+
+double DetectorAutotuner::measure(IDetectorBackend& backend, const std::vector<ImageView>& frames, int warmupRuns,
+                                  int measureFrames) {
+    if (frames.empty() || measureFrames <= 0) return 0.;
+    DetectionResult warm;
+    for (int i = 0; i < warmupRuns; ++i) {
+        if (!backend.run(frames[static_cast<std::size_t>(i) % frames.size()], warm)) return 0.;
+    }
+    const std::size_t n = static_cast<std::size_t>(measureFrames);
+    std::vector<ImageView> views(n);
+    for (std::size_t i = 0; i < n; ++i) views[i] = frames[i % frames.size()];
+    std::vector<DetectionResult> results(n);
+    bool ok = true;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const std::size_t batch = backend.maxBatchSize();
+    if (batch > 1) {
+        for (std::size_t begin = 0; begin < n && ok; begin += batch) {
+            ok = backend.runBatch(&views[begin], &results[begin], std::min(batch, n - begin));
+        }
+    } else if (backend.maxInFlight() > 1) {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t done = 0;
+        bool failed = false;
+        std::size_t submitted = 0;
+        for (; submitted < n; ++submitted) {
+            const bool accepted = backend.submit(views[submitted], results[submitted], [&](bool runOk) {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++done;
+                failed = failed || !runOk;
+                cv.notify_all();
+            });
+            if (!accepted) break;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return done == submitted; });
+        ok = !failed && submitted == n;
+    } else {
+        for (std::size_t i = 0; i < n && ok; ++i) ok = backend.run(views[i], results[i]);
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    if (!ok) return 0.;
+    return static_cast<double>(n) / std::max(seconds, 1e-9);
+}
+
+std::string DetectorAutotuner::boardIdentity() {
+    std::string model;
+    {
+        std::ifstream in("/proc/device-tree/model", std::ios::binary);
+        std::getline(in, model, '\0');
+    }
+    if (model.empty()) {
+        std::ifstream in("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.rfind("Hardware", 0) == 0 || line.rfind("model name", 0) == 0) {
+                const auto colon = line.find(':');
+                if (colon != std::string::npos) model = line.substr(colon + 1);
+                if (line.rfind("Hardware", 0) == 0) break;  // ARM 板卡名优先于 CPU 型号
+            }
+        }
+    }
+    model = sanitize(model);
+    if (model.empty()) model = "unknown";
+    return model + " x" + std::to_string(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+std::string DetectorAutotuner::modelFingerprint(const std::string& path) {
+    std::uint64_t h = kFnvOffset;
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        h = fnv1a(h, path.data(), path.size());
+    } else {
+        const auto size = static_cast<std::uint64_t>(in.tellg());
+        h = fnv1a(h, reinterpret_cast<const char*>(&size), sizeof(size));
+        std::vector<char> chunk(static_cast<std::size_t>(std::min<std::uint64_t>(size, kFingerprintChunk)));
+        in.seekg(0);
+        in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        h = fnv1a(h, chunk.data(), static_cast<std::size_t>(in.gcount()));
+        if (size > kFingerprintChunk) {
+            in.clear();
+            in.seekg(static_cast<std::streamoff>(size - chunk.size()));
+            in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            h = fnv1a(h, chunk.data(), static_cast<std::size_t>(in.gcount()));
+        }
+    }
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(h));
+    return hex;
+}
+
+std::string DetectorAutotuner::key(const DetectorDescriptor& desc) const {
+    return board_ + "\t" + modelFingerprint(desc.modelPath);
+}
+
+bool DetectorAutotuner::lookup(const DetectorDescriptor& desc, TunedBackendConfig& out) const {
+    const std::string k = key(desc);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = results_.find(k);
+    if (it == results_.end()) return false;
+    out = it->second;
+    return true;
+}
+
+std::uint64_t DetectorAutotuner::tuneRuns() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tuneRuns_;
+}
+
+void DetectorAutotuner::prepareFrames(const DetectorDescriptor& desc) {
+    frames_.clear();
+    if (!options_.capturePath.empty() && captureFrames_.empty()) {
+        if (auto reader = core::CaptureReader::open(options_.capturePath)) {
+            const std::size_t want = static_cast<std::size_t>(std::max(1, options_.maxCaptureFrames));
+            const std::size_t step = std::max<std::size_t>(1, reader->size() / want);
+            for (std::size_t i = 0; i < reader->size() && captureFrames_.size() < want; i += step) {
+                captureFrames_.push_back(reader->buffer(i));
+            }
+        } else {
+            FM_LOG_WARN("DetectorAutotuner", "cannot open capture ", options_.capturePath, ", using synthetic frames");
+        }
+    }
+    for (const auto& buffer : captureFrames_) {
+        ImageView view;
+        if (makeCameraImageView(buffer, core::PixelFormat::Any, view)) frames_.push_back(view);
+    }
+    if (!frames_.empty()) return;
+
+    // 合成帧：模型输入尺寸的渐变 + 方块纹理（避免纯色帧走特殊快路径）
+    const int w = desc.inputWidth > 0 ? desc.inputWidth : 640;
+    const int h = desc.inputHeight > 0 ? desc.inputHeight : 640;
+    syntheticPixels_.assign(2, std::vector<std::uint8_t>(static_cast<std::size_t>(w) * h * 3));
+    for (std::size_t f = 0; f < syntheticPixels_.size(); ++f) {
+        auto& px = syntheticPixels_[f];
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                std::uint8_t* p = &px[(static_cast<std::size_t>(y) * w + x) * 3];
+                const bool checker = ((x / 32 + y / 32 + static_cast<int>(f)) & 1) != 0;
+                p[0] = static_cast<std::uint8_t>(x * 255 / std::max(1, w - 1));
+                p[1] = static_cast<std::uint8_t>(y * 255 / std::max(1, h - 1));
+                p[2] = checker ? 200 : 40;
+            }
+        }
+        ImageView view;
+        view.data = px.data();
+        view.width = w;
+        view.height = h;
+        view.stride = w * 3;
+        view.format = core::PixelFormat::RGB8;
+        view.pixelFormat = "RGB8";
+        view.frameIndex = static_cast<std::uint32_t>(f);
+        frames_.push_back(view);
+    }
+}
+
+bool DetectorAutotuner::resolve(const DetectorDescriptor& desc, const BackendFactory& factory,
+                                TunedBackendConfig& out) {
+    if (lookup(desc, out)) return true;
+    std::lock_guard<std::mutex> tuneLock(tuneMutex_);
+    if (lookup(desc, out)) return true;  // 等待期间已由其他线程调优
+    if (!factory) return false;
+
+    prepareFrames(desc);
+    const auto list = candidates(desc);
+    bool found = false;
+    TunedBackendConfig best;
+    for (const auto& candidate : list) {
+        DetectorDescriptor trial = desc;
+        candidate.applyTo(trial);
+        trial.profiling = false;
+        DetectorBackendPtr backend = factory();
+        if (!backend || !backend->load(trial)) {
+            FM_LOG_WARN("DetectorAutotuner", desc.detectorId, ": candidate ", candidate.describe(), " failed to load");
+            continue;
+        }
+        double fps = 0.;
+        if (candidate.npuCoreMask == 0 || backend->setNpuCoreMask(candidate.npuCoreMask)) {
+            fps = measure(*backend, frames_, options_.warmupRuns, options_.measureFrames);
+        }
+        backend->unload();
+        FM_LOG_INFO("DetectorAutotuner", desc.detectorId, ": ", candidate.describe(), " -> ", fps, " fps");
+        if (fps > 0. && (!found || fps > best.framesPerSecond)) {
+            best = candidate;
+            best.framesPerSecond = fps;
+            found = true;
+        }
+    }
+    frames_.clear();
+    syntheticPixels_.clear();
+    if (!found) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        results_[key(desc)] = best;
+        ++tuneRuns_;
+    }
+    if (!options_.cachePath.empty() && !saveCache()) {
+        FM_LOG_WARN("DetectorAutotuner", "cannot write autotune cache ", options_.cachePath);
+    }
+    FM_LOG_INFO("DetectorAutotuner", desc.detectorId, " on '", board_, "': ", best.describe(), " (",
+                best.framesPerSecond, " fps)");
+    out = best;
+    return true;
+}
+
+void DetectorAutotuner::loadCache() {
+    if (options_.cachePath.empty()) return;
+    std::ifstream in(options_.cachePath);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        // 板卡 \t 模型指纹 \t 吞吐 \t 配置
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, '\t')) fields.push_back(field);
+        if (fields.size() != 4) continue;
+        TunedBackendConfig config;
+        if (!parseConfig(fields[3], config)) continue;
+        try {
+            config.framesPerSecond = std::stod(fields[2]);
+        } catch (const std::exception&) {
+            continue;
+        }
+        results_[fields[0] + "\t" + fields[1]] = config;
+    }
+}
+
+bool DetectorAutotuner::saveCache() const {
+    std::ostringstream os;
+    os << "# FalconMindSDK detector autotune: board\tmodel_fingerprint\tfps\tconfig\n";
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& kv : results_) {
+            os << kv.first << "\t" << kv.second.framesPerSecond << "\t" << kv.second.describe() << "\n";
+        }
+    }
+    // 先写临时文件再改名，断电时不留下半个文件
+    const std::string tmp = options_.cachePath + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) return false;
+        out << os.str();
+        if (!out.flush()) return false;
+    }
+    return std::rename(tmp.c_str(), options_.cachePath.c_str()) == 0;
+}
+
+} // namespace falconmind::sdk::perception
@@ -46,6 +46,14 @@ DeviceType parseDevice(const std::string& v) {
     return DeviceType::Auto;
 }
 
+NmsMethod parseNmsMethod(const std::string& v) {
+    std::string s = v;
+    for (auto& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    if (s == "soft") return NmsMethod::Soft;
+    if (s == "matrix") return NmsMethod::Matrix;
+    return NmsMethod::Hard;
+}
+
 ModelPrecision parsePrecision(const std::string& v) {
     std::string s = v;
     for (auto& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
@@ -72,6 +80,21 @@ bool parseFloat(const std::string& s, float& out) {
     }
 }
 
+// "a, b" 或 "[a, b]" → 小写的列表
+std::vector<std::string> parseList(const std::string& v) {
+    std::string s = v;
+    if (s.size() >= 2 && s.front() == '[' && s.back() == ']') s = s.substr(1, s.size() - 2);
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item = stripQuotes(trim(item));
+        for (auto& c : item) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
 } // namespace
 
 bool loadDetectorsFromYamlFile(const std::string& path, PerceptionPluginManager& manager) {
@@ -168,6 +191,98 @@ bool loadDetectorsFromYamlFile(const std::string& path, PerceptionPluginManager&
         } else if (key == "nms_threshold") {
             float v{};
             if (parseFloat(value, v)) current.nmsThreshold = v;
+        } else if (key == "nms_method") {
+            current.nmsMethod = parseNmsMethod(value);
+        } else if (key == "nms_top_k") {
+            int v{};
+            if (parseInt(value, v)) current.nmsTopK = v;
+        } else if (key == "max_detections") {
+            int v{};
+            if (parseInt(value, v)) current.maxDetections = v;
+        } else if (key == "nms_sigma") {
+            float v{};
+            if (parseFloat(value, v) && v > 0.f) current.nmsSigma = v;
+        } else if (key == "letterbox") {
+            current.letterbox = !(value == "false" || value == "0" || value == "no");
+        } else if (key == "letterbox_pad_value") {
+            int v{};
+            if (parseInt(value, v)) current.letterboxPadValue = v;
+        } else if (key == "preprocess_threads") {
+            int v{};
+            if (parseInt(value, v)) current.preprocessThreads = v;
+        } else if (key == "preprocess_accel") {
+            current.preprocessAccel = value;
+        } else if (key == "quantized_input") {
+            current.quantizedInput = !(value == "false" || value == "0" || value == "no");
+        } else if (key == "input_pass_through") {
+            current.inputPassThrough = !(value == "false" || value == "0" || value == "no");
+        } else if (key == "input_mean") {
+            float v{};
+            if (parseFloat(value, v)) current.inputMean = v;
+        } else if (key == "input_std") {
+            float v{};
+            if (parseFloat(value, v) && v != 0.f) current.inputStd = v;
+        } else if (key == "zero_copy") {
+            current.zeroCopy = !(value == "false" || value == "0" || value == "no");
+        } else if (key == "npu_contexts") {
+            int v{};
+            if (parseInt(value, v)) current.npuContexts = v;
+        } else if (key == "max_batch") {
+            int v{};
+            if (parseInt(value, v)) current.maxBatch = v;
+        } else if (key == "cuda_streams") {
+            int v{};
+            if (parseInt(value, v)) current.cudaStreams = v;
+        } else if (key == "execution_providers") {
+            current.executionProviders = parseList(value);
+        } else if (key == "intra_op_threads") {
+            int v{};
+            if (parseInt(value, v)) current.intraOpThreads = v;
+        } else if (key == "tile_width") {
+            int v{};
+            if (parseInt(value, v)) current.tileWidth = v;
+        } else if (key == "tile_height") {
+            int v{};
+            if (parseInt(value, v)) current.tileHeight = v;
+        } else if (key == "tile_overlap") {
+            float v{};
+            if (parseFloat(value, v) && v >= 0.f && v < 1.f) current.tileOverlap = v;
+        } else if (key == "tile_full_frame") {
+            current.tileFullFrame = !(value == "false" || value == "0" || value == "no");
+        } else if (key == "tile_motion_threshold") {
+            float v{};
+            if (parseFloat(value, v)) current.tileMotionThreshold = v;
+        } else if (key == "tile_max_reuse") {
+            int v{};
+            if (parseInt(value, v)) current.tileMaxReuse = v;
+        } else if (key == "cascade_detector") {
+            current.cascadeDetectorId = value;
+        } else if (key == "cascade_screen_threshold") {
+            float v{};
+            if (parseFloat(value, v)) current.cascadeScreenThreshold = v;
+        } else if (key == "cascade_confirm_threshold") {
+            float v{};
+            if (parseFloat(value, v)) current.cascadeConfirmThreshold = v;
+        } else if (key == "cascade_accept_threshold") {
+            float v{};
+            if (parseFloat(value, v)) current.cascadeAcceptThreshold = v;
+        } else if (key == "cascade_crop_scale") {
+            float v{};
+            if (parseFloat(value, v) && v >= 1.f) current.cascadeCropScale = v;
+        } else if (key == "cascade_min_crop") {
+            int v{};
+            if (parseInt(value, v) && v > 0) current.cascadeMinCrop = v;
+        } else if (key == "cascade_max_crops") {
+            int v{};
+            if (parseInt(value, v) && v >= 0) current.cascadeMaxCrops = v;
+        } else if (key == "warmup_runs") {
+            int v{};
+            if (parseInt(value, v) && v >= 0) current.warmupRuns = v;
+        } else if (key == "memory_mb") {
+            float v{};
+            if (parseFloat(value, v) && v >= 0.f) current.memoryBytes = static_cast<std::uint64_t>(v * 1024.f * 1024.f);
+        } else if (key == "profiling") {
+            current.profiling = !(value == "false" || value == "0" || value == "no");
         }
     }
 
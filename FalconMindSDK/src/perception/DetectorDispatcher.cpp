@@ -0,0 +1,92 @@
+#include "falconmind/sdk/perception/DetectorDispatcher.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace falconmind::sdk::perception {
+
+DetectorDispatcher::DetectorDispatcher(DetectorBackendPtr backend, std::size_t workers)
+    : backend_(std::move(backend)) {
+    if (workers == 0) workers = backend_ ? std::max<std::size_t>(1, backend_->maxConcurrentRuns()) : 1;
+    slots_.resize(workers * 2);
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) threads_.emplace_back([this] { workerLoop(); });
+}
+
+DetectorDispatcher::~DetectorDispatcher() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        workCv_.wait(lock, [this] { return pending_.empty(); });  // 已提交的帧仍执行完
+        stopping_ = true;
+    }
+    workCv_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+std::size_t DetectorDispatcher::inFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<std::size_t>(submitted_ - emitted_);
+}
+
+bool DetectorDispatcher::submit(const ImageView& image, core::BufferRef frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!backend_ || submitted_ - emitted_ >= slots_.size()) return false;
+        const std::uint64_t seq = submitted_++;
+        Slot& slot = slots_[seq % slots_.size()];
+        slot.image = image;
+        slot.frame = std::move(frame);
+        slot.done = false;
+        pending_.push_back(seq);
+    }
+    workCv_.notify_one();
+    return true;
+}
+
+bool DetectorDispatcher::takeLocked(DetectionResult& out, bool* ok) {
+    if (emitted_ == submitted_) return false;
+    Slot& slot = slots_[emitted_ % slots_.size()];
+    if (!slot.done) return false;
+    out = std::move(slot.result);
+    if (ok) *ok = slot.ok;
+    slot.result = DetectionResult{};
+    slot.frame.reset();
+    slot.done = false;
+    ++emitted_;
+    return true;
+}
+
+bool DetectorDispatcher::poll(DetectionResult& out, bool* ok) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return takeLocked(out, ok);
+}
+
+bool DetectorDispatcher::wait(DetectionResult& out, bool* ok) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (emitted_ == submitted_) return false;
+    doneCv_.wait(lock, [this] { return slots_[emitted_ % slots_.size()].done; });
+    return takeLocked(out, ok);
+}
+
+void DetectorDispatcher::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        workCv_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+        if (pending_.empty()) return;  // stopping_
+        const std::uint64_t seq = pending_.front();
+        pending_.pop_front();
+        if (pending_.empty()) workCv_.notify_all();  // 唤醒等待队列排空的析构
+        Slot& slot = slots_[seq % slots_.size()];
+        // 槽位在完成并取出之前不会被复用，执行期间无需持锁
+        lock.unlock();
+        DetectionResult result;
+        const bool ok = backend_->run(slot.image, result);
+        lock.lock();
+        slot.result = std::move(result);
+        slot.ok = ok;
+        slot.done = true;
+        if (seq == emitted_) doneCv_.notify_all();
+    }
+}
+
+} // namespace falconmind::sdk::perception
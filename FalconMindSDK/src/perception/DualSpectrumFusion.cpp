@@ -0,0 +1,186 @@
+#include "falconmind/sdk/perception/DualSpectrumFusion.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace falconmind::sdk::perception {
+
+void ThermalRemap::setHomography(const Homography& h) {
+    h_ = h;
+    taps_.clear();
+    outWidth_ = outHeight_ = 0;
+}
+
+void ThermalRemap::build(int outWidth, int outHeight, int thermalWidth, int thermalHeight) {
+    if (outWidth == outWidth_ && outHeight == outHeight_ && thermalWidth == thermalWidth_ &&
+        thermalHeight == thermalHeight_ && !taps_.empty()) {
+        return;
+    }
+    outWidth_ = outWidth;
+    outHeight_ = outHeight;
+    thermalWidth_ = thermalWidth;
+    thermalHeight_ = thermalHeight;
+    taps_.assign(static_cast<std::size_t>(std::max(outWidth, 0)) * std::max(outHeight, 0), Tap{});
+    if (thermalWidth < 2 || thermalHeight < 2 || thermalWidth > 0xFFFE || thermalHeight > 0xFFFE) return;
+    const auto& h = h_;
+    for (int y = 0; y < outHeight; ++y) {
+        Tap* row = taps_.data() + static_cast<std::size_t>(y) * outWidth;
+        for (int x = 0; x < outWidth; ++x) {
+            const double w = h[6] * x + h[7] * y + h[8];
+            if (std::fabs(w) < 1e-12) continue;
+            const double u = (h[0] * x + h[1] * y + h[2]) / w;
+            const double v = (h[3] * x + h[4] * y + h[5]) / w;
+            if (u < 0. || v < 0. || u > thermalWidth - 1 || v > thermalHeight - 1) continue;
+            // 右 / 下边界上的点落在最后一个完整格内，权重取 1
+            int x0 = std::min(static_cast<int>(u), thermalWidth - 2);
+            int y0 = std::min(static_cast<int>(v), thermalHeight - 2);
+            Tap& t = row[x];
+            t.x = static_cast<std::uint16_t>(x0);
+            t.y = static_cast<std::uint16_t>(y0);
+            t.fx = static_cast<std::uint8_t>(std::min(255., (u - x0) * 256. + 0.5));
+            t.fy = static_cast<std::uint8_t>(std::min(255., (v - y0) * 256. + 0.5));
+        }
+    }
+}
+
+void ThermalRemap::remapRow8(const std::uint8_t* thermal, int thermalStride, int y, std::uint8_t* out) const noexcept {
+    const Tap* row = taps_.data() + static_cast<std::size_t>(y) * outWidth_;
+    for (int x = 0; x < outWidth_; ++x) {
+        const Tap t = row[x];
+        if (t.x == 0xFFFF) {
+            out[x] = 0;
+            continue;
+        }
+        const std::uint8_t* p = thermal + static_cast<std::size_t>(t.y) * thermalStride + t.x;
+        const std::uint32_t fx = t.fx, fy = t.fy;
+        const std::uint32_t top = p[0] * (256 - fx) + p[1] * fx;
+        const std::uint32_t bot = p[thermalStride] * (256 - fx) + p[thermalStride + 1] * fx;
+        out[x] = static_cast<std::uint8_t>((top * (256 - fy) + bot * fy + (1u << 15)) >> 16);
+    }
+}
+
+void ThermalRemap::remapRow16(const std::uint16_t* thermal, int thermalStride, int y, std::uint8_t* out) noexcept {
+    // thermalStride 为字节数
+    const Tap* row = taps_.data() + static_cast<std::size_t>(y) * outWidth_;
+    const std::size_t pitch = static_cast<std::size_t>(thermalStride) / sizeof(std::uint16_t);
+    const std::uint32_t lo = lo_;
+    const std::uint32_t range = hi_ > lo_ ? static_cast<std::uint32_t>(hi_ - lo_) : 1u;
+    const std::uint32_t scale = ((255u << 16) + range - 1) / range;  // Q16，向上取整使范围上限映射到 255
+    std::uint16_t frameLo = frameLo_, frameHi = frameHi_;
+    for (int x = 0; x < outWidth_; ++x) {
+        const Tap t = row[x];
+        if (t.x == 0xFFFF) {
+            out[x] = 0;
+            continue;
+        }
+        const std::uint16_t* p = thermal + t.y * pitch + t.x;
+        const std::uint32_t fx = t.fx, fy = t.fy;
+        const std::uint32_t top = p[0] * (256 - fx) + p[1] * fx;
+        const std::uint32_t bot = p[pitch] * (256 - fx) + p[pitch + 1] * fx;
+        const std::uint32_t v = (top * (256 - fy) + bot * fy + (1u << 15)) >> 16;
+        frameLo = std::min<std::uint16_t>(frameLo, static_cast<std::uint16_t>(v));
+        frameHi = std::max<std::uint16_t>(frameHi, static_cast<std::uint16_t>(v));
+        const std::uint32_t d = v > lo ? v - lo : 0u;
+        out[x] = static_cast<std::uint8_t>(std::min<std::uint64_t>(255u, (static_cast<std::uint64_t>(d) * scale) >> 16));
+    }
+    frameLo_ = frameLo;
+    frameHi_ = frameHi;
+}
+
+void ThermalRemap::endFrame16() noexcept {
+    if (frameHi_ >= frameLo_) {
+        lo_ = frameLo_;
+        hi_ = frameHi_;
+    }
+    frameLo_ = 65535;
+    frameHi_ = 0;
+}
+
+namespace {
+
+void fuseRowScalar(const std::uint8_t* rgb, const std::uint8_t* thermal, std::uint8_t* out, int width,
+                   SpectrumFusionMode mode, int blueIndex, std::uint32_t alpha) {
+    switch (mode) {
+    case SpectrumFusionMode::Blend: {
+        const std::uint32_t keep = 256 - alpha;
+        for (int x = 0; x < width; ++x) {
+            const std::uint32_t t = thermal[x] * alpha + 128;
+            out[3 * x] = static_cast<std::uint8_t>((rgb[3 * x] * keep + t) >> 8);
+            out[3 * x + 1] = static_cast<std::uint8_t>((rgb[3 * x + 1] * keep + t) >> 8);
+            out[3 * x + 2] = static_cast<std::uint8_t>((rgb[3 * x + 2] * keep + t) >> 8);
+        }
+        break;
+    }
+    case SpectrumFusionMode::ReplaceBlue:
+        for (int x = 0; x < width; ++x) {
+            out[3 * x] = rgb[3 * x];
+            out[3 * x + 1] = rgb[3 * x + 1];
+            out[3 * x + 2] = rgb[3 * x + 2];
+            out[3 * x + blueIndex] = thermal[x];
+        }
+        break;
+    case SpectrumFusionMode::ThermalOnly:
+        for (int x = 0; x < width; ++x) out[3 * x] = out[3 * x + 1] = out[3 * x + 2] = thermal[x];
+        break;
+    }
+}
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FALCONMIND_FUSION_NEON 1
+void fuseRowNeon(const std::uint8_t* rgb, const std::uint8_t* thermal, std::uint8_t* out, int width,
+                 SpectrumFusionMode mode, int blueIndex, std::uint32_t alpha) {
+    int x = 0;
+    const uint8x8_t a8 = vdup_n_u8(static_cast<std::uint8_t>(std::min<std::uint32_t>(alpha, 255)));
+    const uint8x8_t k8 = vdup_n_u8(static_cast<std::uint8_t>(255 - std::min<std::uint32_t>(alpha, 255)));
+    for (; x + 16 <= width; x += 16) {
+        const uint8x16_t t = vld1q_u8(thermal + x);
+        uint8x16x3_t px;
+        if (mode == SpectrumFusionMode::ThermalOnly) {
+            px.val[0] = px.val[1] = px.val[2] = t;
+        } else {
+            px = vld3q_u8(rgb + 3 * x);
+            if (mode == SpectrumFusionMode::ReplaceBlue) {
+                px.val[blueIndex] = t;
+            } else {
+                // Q8 近似：alpha 按 255 截断，结果与标量路径至多相差 1
+                for (int c = 0; c < 3; ++c) {
+                    uint16x8_t lo = vmull_u8(vget_low_u8(px.val[c]), k8);
+                    uint16x8_t hi = vmull_u8(vget_high_u8(px.val[c]), k8);
+                    lo = vmlal_u8(lo, vget_low_u8(t), a8);
+                    hi = vmlal_u8(hi, vget_high_u8(t), a8);
+                    px.val[c] = vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8));
+                }
+            }
+        }
+        vst3q_u8(out + 3 * x, px);
+    }
+    fuseRowScalar(rgb + 3 * x, thermal + x, out + 3 * x, width - x, mode, blueIndex, alpha);
+}
+#endif
+
+} // namespace
+
+void fuseRow(const std::uint8_t* rgb, const std::uint8_t* thermal, std::uint8_t* out, int width,
+             SpectrumFusionMode mode, int blueIndex, std::uint32_t alpha) noexcept {
+    alpha = std::min<std::uint32_t>(alpha, 256);
+    blueIndex = blueIndex == 0 ? 0 : 2;
+#if defined(FALCONMIND_FUSION_NEON)
+    fuseRowNeon(rgb, thermal, out, width, mode, blueIndex, alpha);
+#else
+    fuseRowScalar(rgb, thermal, out, width, mode, blueIndex, alpha);
+#endif
+}
+
+const char* fusionKernelName() noexcept {
+#if defined(FALCONMIND_FUSION_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace falconmind::sdk::perception
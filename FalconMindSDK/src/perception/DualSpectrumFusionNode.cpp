@@ -0,0 +1,239 @@
+#include "falconmind/sdk/perception/DualSpectrumFusionNode.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+#include "falconmind/sdk/core/Pad.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <strings.h>
+
+namespace falconmind::sdk::perception {
+
+using namespace falconmind::sdk::core;
+using namespace falconmind::sdk::sensors;
+
+namespace {
+
+constexpr std::size_t kRgbStream = 0;
+constexpr std::size_t kThermalStream = 1;
+
+// 热红外帧像素类型：PixelFormat 不含灰度格式，按帧头格式字符串识别
+enum class ThermalPixel { Gray8, Gray16, Rgb, Bgr, Unknown };
+
+ThermalPixel thermalPixel(const BufferRef& frame, const CameraFramePacket* header) {
+    if (frame.meta().video.format == PixelFormat::RGB8) return ThermalPixel::Rgb;
+    if (frame.meta().video.format == PixelFormat::BGR8) return ThermalPixel::Bgr;
+    const char* f = header->format;
+    if (strcasecmp(f, "GRAY8") == 0 || strcasecmp(f, "Y8") == 0 || strcasecmp(f, "GREY") == 0) return ThermalPixel::Gray8;
+    if (strcasecmp(f, "GRAY16") == 0 || strcasecmp(f, "Y16") == 0) return ThermalPixel::Gray16;
+    if (strcasecmp(f, "RGB8") == 0) return ThermalPixel::Rgb;
+    if (strcasecmp(f, "BGR8") == 0) return ThermalPixel::Bgr;
+    return ThermalPixel::Unknown;
+}
+
+int thermalBytesPerPixel(ThermalPixel p) {
+    switch (p) {
+    case ThermalPixel::Gray8: return 1;
+    case ThermalPixel::Gray16: return 2;
+    case ThermalPixel::Rgb:
+    case ThermalPixel::Bgr: return 3;
+    default: return 0;
+    }
+}
+
+} // namespace
+
+DualSpectrumFusionNode::DualSpectrumFusionNode()
+    : Node("dual_spectrum_fusion"), sync_(FrameSynchronizer::Config{2, 20'000'000, 4}) {
+    Caps caps;
+    caps.addVideo(VideoCaps{PixelFormat::RGB8, 0, 0, 0});
+    caps.addVideo(VideoCaps{PixelFormat::BGR8, 0, 0, 0});
+    auto rgb = std::make_shared<Pad>("rgb_in", PadType::Sink);
+    rgb->setCaps(caps);
+    rgb->setCapsCallback([this](const VideoCaps& c) { rgbFormat_ = c.format; });
+    auto out = std::make_shared<Pad>("video_out", PadType::Source);
+    out->setCaps(caps);
+    rgbPad_ = addPad(rgb);
+    thermalPad_ = addPad(std::make_shared<Pad>("thermal_in", PadType::Sink));
+    outPad_ = addPad(out);
+}
+
+void DualSpectrumFusionNode::setHomography(const ThermalRemap::Homography& h) {
+    std::lock_guard<std::mutex> lock(remapMutex_);
+    remap_.setHomography(h);
+}
+
+void DualSpectrumFusionNode::setAlpha(float alpha) {
+    alpha_ = static_cast<std::uint32_t>(std::clamp(alpha, 0.f, 1.f) * 256.f + 0.5f);
+}
+
+bool DualSpectrumFusionNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    try {
+        auto it = params.find("homography");
+        if (it != params.end()) {
+            ThermalRemap::Homography h{};
+            std::stringstream ss(it->second);
+            std::string item;
+            std::size_t n = 0;
+            while (std::getline(ss, item, ',')) {
+                if (n >= h.size()) break;
+                h[n++] = std::stod(item);
+            }
+            if (n != h.size() || std::getline(ss, item, ',')) {
+                std::cerr << "[DualSpectrumFusionNode] homography needs 9 values: " << it->second << std::endl;
+                return false;
+            }
+            setHomography(h);
+        }
+        it = params.find("mode");
+        if (it != params.end()) {
+            if (it->second == "blend") mode_ = SpectrumFusionMode::Blend;
+            else if (it->second == "replace_blue") mode_ = SpectrumFusionMode::ReplaceBlue;
+            else if (it->second == "thermal_only") mode_ = SpectrumFusionMode::ThermalOnly;
+            else {
+                std::cerr << "[DualSpectrumFusionNode] Unknown mode: " << it->second << std::endl;
+                return false;
+            }
+        }
+        it = params.find("alpha");
+        if (it != params.end()) setAlpha(std::stof(it->second));
+        it = params.find("max_skew_ms");
+        if (it != params.end()) maxSkewNs_ = static_cast<std::int64_t>(std::stod(it->second) * 1e6);
+    } catch (const std::exception& e) {
+        std::cerr << "[DualSpectrumFusionNode] invalid parameter: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool DualSpectrumFusionNode::start() {
+    {
+        std::lock_guard<std::mutex> lock(syncMutex_);
+        sync_ = FrameSynchronizer(FrameSynchronizer::Config{2, maxSkewNs_, 4});
+    }
+    auto bind = [this](Pad* pad, std::size_t stream) {
+        if (!pad) return;
+        pad->setBufferCallback([this, stream](const BufferRef& frame) {
+            if (frame.size() < sizeof(CameraFramePacket)) return;
+            std::lock_guard<std::mutex> lock(syncMutex_);
+            sync_.push(stream, frame);
+        });
+    };
+    bind(rgbPad_, kRgbStream);
+    bind(thermalPad_, kThermalStream);
+    std::cout << "[DualSpectrumFusionNode] start() kernel=" << fusionKernelName()
+              << " max_skew_ms=" << maxSkewNs_ / 1e6 << std::endl;
+    return true;
+}
+
+void DualSpectrumFusionNode::stop() {
+    std::lock_guard<std::mutex> lock(syncMutex_);
+    sync_.clear();
+    pool_.clear();
+}
+
+void DualSpectrumFusionNode::releaseIdleBuffers() {
+    {
+        std::lock_guard<std::mutex> lock(syncMutex_);
+        sync_.clear();
+        pool_.clear();
+    }
+    std::vector<std::uint8_t>().swap(thermalRow_);
+    std::vector<std::uint8_t>().swap(thermalGray_);
+}
+
+std::uint64_t DualSpectrumFusionNode::unmatchedDrops() const {
+    std::lock_guard<std::mutex> lock(syncMutex_);
+    return sync_.unmatchedDrops();
+}
+
+void DualSpectrumFusionNode::process() {
+    FrameSet set;
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(syncMutex_);
+            if (!sync_.pop(set)) return;
+        }
+        if (set.frames.size() == 2) fuse(set.frames[kRgbStream], set.frames[kThermalStream]);
+    }
+}
+
+void DualSpectrumFusionNode::fuse(const BufferRef& rgb, const BufferRef& thermal) {
+    if (!outPad_) return;
+    const auto* rgbHeader = reinterpret_cast<const CameraFramePacket*>(rgb.data());
+    const auto* thHeader = reinterpret_cast<const CameraFramePacket*>(thermal.data());
+
+    PixelFormat fmt = rgb.meta().video.format != PixelFormat::Any ? rgb.meta().video.format : rgbFormat_;
+    if (fmt == PixelFormat::Any) fmt = parsePixelFormat(rgbHeader->format);
+    if (fmt != PixelFormat::RGB8 && fmt != PixelFormat::BGR8) return;
+    const int w = rgbHeader->width;
+    const int h = rgbHeader->height;
+    const int rgbStride = rgbHeader->stride > 0 ? rgbHeader->stride : w * 3;
+    if (w <= 0 || h <= 0 || rgb.size() < sizeof(CameraFramePacket) + static_cast<std::size_t>(rgbStride) * h) return;
+
+    const ThermalPixel tp = thermalPixel(thermal, thHeader);
+    const int tbpp = thermalBytesPerPixel(tp);
+    const int tw = thHeader->width;
+    const int th = thHeader->height;
+    const int thStride = thHeader->stride > 0 ? thHeader->stride : tw * tbpp;
+    if (tbpp == 0 || tw < 2 || th < 2 ||
+        thermal.size() < sizeof(CameraFramePacket) + static_cast<std::size_t>(thStride) * th) {
+        return;
+    }
+
+    const std::size_t outStride = static_cast<std::size_t>(w) * 3;
+    BufferRef out = pool_.acquire(BufferPoolKey{w, h, pixelFormatName(fmt)}, sizeof(CameraFramePacket) + outStride * h);
+    auto* outHeader = reinterpret_cast<CameraFramePacket*>(out.mutableData());
+    *outHeader = *rgbHeader;
+    outHeader->stride = static_cast<std::int32_t>(outStride);
+    std::strncpy(outHeader->format, pixelFormatName(fmt), sizeof(outHeader->format) - 1);
+    outHeader->format[sizeof(outHeader->format) - 1] = '\0';
+
+    const std::uint8_t* src = cameraFramePacketData(rgbHeader);
+    const std::uint8_t* tsrc = cameraFramePacketData(thHeader);
+    std::uint8_t* dst = cameraFramePacketDataWritable(outHeader);
+    const int blueIndex = fmt == PixelFormat::RGB8 ? 2 : 0;
+
+    // 三通道热红外源先按 BT.601 转为灰度（少见：部分热像仪以伪彩 / 灰度 RGB 输出）
+    std::vector<std::uint8_t>& gray = thermalGray_;
+    if (tp == ThermalPixel::Rgb || tp == ThermalPixel::Bgr) {
+        gray.resize(static_cast<std::size_t>(tw) * th);
+        const int ri = tp == ThermalPixel::Rgb ? 0 : 2;
+        for (int y = 0; y < th; ++y) {
+            const std::uint8_t* row = tsrc + static_cast<std::size_t>(y) * thStride;
+            std::uint8_t* g = gray.data() + static_cast<std::size_t>(y) * tw;
+            for (int x = 0; x < tw; ++x) {
+                const std::uint8_t* p = row + 3 * x;
+                g[x] = static_cast<std::uint8_t>((77 * p[ri] + 150 * p[1] + 29 * p[2 - ri] + 128) >> 8);
+            }
+        }
+    }
+
+    thermalRow_.resize(static_cast<std::size_t>(w));
+    {
+        std::lock_guard<std::mutex> lock(remapMutex_);
+        remap_.build(w, h, tw, th);
+        for (int y = 0; y < h; ++y) {
+            if (tp == ThermalPixel::Gray16) {
+                remap_.remapRow16(reinterpret_cast<const std::uint16_t*>(tsrc), thStride, y, thermalRow_.data());
+            } else if (tp == ThermalPixel::Gray8) {
+                remap_.remapRow8(tsrc, thStride, y, thermalRow_.data());
+            } else {
+                remap_.remapRow8(gray.data(), tw, y, thermalRow_.data());
+            }
+            fuseRow(src + static_cast<std::size_t>(y) * rgbStride, thermalRow_.data(), dst + y * outStride, w, mode_,
+                    blueIndex, alpha_);
+        }
+        if (tp == ThermalPixel::Gray16) remap_.endFrame16();
+    }
+
+    auto& meta = out.mutableMeta();
+    meta = rgb.meta();
+    meta.video = VideoCaps{fmt, w, h, rgb.meta().video.fps};
+    meta.dmabufFd = -1;
+    fused_.fetch_add(1, std::memory_order_relaxed);
+    outPad_->pushBuffer(out);
+}
+
+} // namespace falconmind::sdk::perception
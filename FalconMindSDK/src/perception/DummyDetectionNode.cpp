@@ -1,8 +1,9 @@
 #include "falconmind/sdk/perception/DummyDetectionNode.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/perception/DetectionNode.h"
 #include "falconmind/sdk/perception/DetectionResultPacket.h"
 #include "falconmind/sdk/sensors/CameraFramePacket.h"
 
-#include <iostream>
 #include <cstring>
 
 namespace falconmind::sdk::perception {
@@ -12,8 +13,23 @@ using namespace falconmind::sdk::sensors;
 
 DummyDetectionNode::DummyDetectionNode()
     : Node("detection_transform") {
-    addPad(std::make_shared<Pad>("video_in", PadType::Sink));
-    addPad(std::make_shared<Pad>("detection_out", PadType::Source));
+    auto in = std::make_shared<Pad>("video_in", PadType::Sink);
+    in->setCapsCallback([this](const VideoCaps& caps) { inputFormat_ = caps.format; });
+    inPad_ = addPad(in);
+    outPad_ = addPad(std::make_shared<Pad>("detection_out", PadType::Source));
+}
+
+void DummyDetectionNode::setBackend(DetectorBackendPtr backend) {
+    backend_ = std::move(backend);
+    Caps caps;
+    if (backend_) {
+        for (auto f : backend_->supportedPixelFormats()) {
+            caps.addVideo(VideoCaps{f, 0, 0, 0});
+        }
+    }
+    if (auto* pad = inPad_) {
+        pad->setCaps(caps);
+    }
 }
 
 bool DummyDetectionNode::configure(const std::unordered_map<std::string, std::string>& params) {
@@ -25,43 +41,104 @@ bool DummyDetectionNode::configure(const std::unordered_map<std::string, std::st
 }
 
 bool DummyDetectionNode::start() {
-    auto pad = getPad("video_in");
+    auto* pad = inPad_;
     if (pad) {
-        pad->setDataCallback([this](const void* data, size_t size) {
-            if (data && size >= sizeof(CameraFramePacket)) {
-                const auto* p = static_cast<const std::uint8_t*>(data);
-                lastFrameBuffer_.assign(p, p + size);
-                lastFrameValid_ = true;
+        pad->setBufferCallback([this](const BufferRef& frame) {
+            if (frame.size() >= sizeof(CameraFramePacket)) {
+                std::lock_guard<std::mutex> lock(frameMutex_);
+                if (lastFrame_) {
+                    overwrittenFrames_.fetch_add(1, std::memory_order_relaxed);
+                }
+                lastFrame_ = frame;
             }
         });
     }
-    std::cout << "[DummyDetectionNode] start with model=" << modelName_;
-    if (backend_) {
-        std::cout << " (backend attached)";
+    if (backend_ && placement().npuCoreMask != 0 && !backend_->setNpuCoreMask(placement().npuCoreMask)) {
+        FM_LOG_WARN("DummyDetectionNode", "backend ignores npu_core_mask=", placement().npuCoreMask);
+    }
+    // 后端可并发推理（多 NPU 上下文）时经调度器流水执行，结果仍按帧顺序输出
+    dispatcher_.reset();
+    if (backend_ && backend_->maxConcurrentRuns() > 1) {
+        dispatcher_ = std::make_unique<DetectorDispatcher>(backend_);
+    }
+    if (dispatcher_) {
+        FM_LOG_INFO("DummyDetectionNode", "start with model=", modelName_, " (backend attached) (",
+                    dispatcher_->workers(), " concurrent contexts)");
+    } else {
+        FM_LOG_INFO("DummyDetectionNode", "start with model=", modelName_, backend_ ? " (backend attached)" : "");
     }
-    std::cout << std::endl;
     return true;
 }
 
+void DummyDetectionNode::stop() {
+    if (dispatcher_) {
+        // 在途帧的结果仍按顺序输出
+        DetectionResult result;
+        bool ok = false;
+        while (dispatcher_->wait(result, &ok)) {
+            if (!ok) continue;
+            markLatency(result);
+            emitResult(result);
+        }
+        dispatcher_.reset();
+    }
+    Node::stop();
+}
+
+bool DummyDetectionNode::makeImageView(const BufferRef& frame, ImageView& imageView) const {
+    return makeCameraImageView(frame, inputFormat_, imageView);
+}
+
+void DummyDetectionNode::emitResult(const DetectionResult& result) {
+    resultPacketBuffer_.resize(detectionResultPacketV2Size(result));
+    size_t written = serializeDetectionResultV2(result, resultPacketBuffer_.data(), resultPacketBuffer_.size());
+    if (written > 0) {
+        if (outPad_)
+            outPad_->pushToConnections(resultPacketBuffer_.data(), written);
+    }
+}
+
+void DummyDetectionNode::dispatch(BufferRef frame) {
+    ImageView imageView{};
+    if (frame.size() >= sizeof(CameraFramePacket) && makeImageView(frame, imageView)) {
+        // 在途帧已满：所有上下文都在忙，丢弃该帧以免时延堆积
+        if (!dispatcher_->submit(imageView, std::move(frame))) {
+            dispatchDrops_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    DetectionResult result;
+    bool ok = false;
+    while (dispatcher_->poll(result, &ok)) {
+        if (!ok) continue;
+        markLatency(result);
+        emitResult(result);
+    }
+}
+
 void DummyDetectionNode::process() {
+    BufferRef frame;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        frame = std::move(lastFrame_);
+        lastFrame_.reset();
+    }
+    if (dispatcher_) {
+        dispatch(std::move(frame));
+        return;
+    }
     if (backend_) {
         DetectionResult result;
-        if (lastFrameValid_ && lastFrameBuffer_.size() >= sizeof(CameraFramePacket)) {
-            const auto* h = reinterpret_cast<const CameraFramePacket*>(lastFrameBuffer_.data());
+        if (frame.size() >= sizeof(CameraFramePacket)) {
             ImageView imageView{};
-            imageView.data = cameraFramePacketData(h);
-            imageView.width = h->width;
-            imageView.height = h->height;
-            imageView.stride = h->stride > 0 ? h->stride : (h->width * 3);
-            imageView.pixelFormat = h->format[0] != '\0' ? h->format : "RGB8";
-            size_t expectedPixels = static_cast<size_t>(imageView.stride) * static_cast<size_t>(h->height);
-            if (lastFrameBuffer_.size() >= sizeof(CameraFramePacket) + expectedPixels) {
+            if (makeImageView(frame, imageView)) {
                 backend_->run(imageView, result);
-                std::cout << "[DummyDetectionNode] process: backend run() on frame "
-                          << imageView.width << "x" << imageView.height << ", detections="
-                          << result.detections.size() << std::endl;
+                // 以源帧为准（后端可能未填写）
+                result.timestampNs = static_cast<std::uint64_t>(imageView.captureTimestampNs);
+                result.frameIndex = imageView.frameIndex;
+                markLatency(result);
+                FM_LOG_DEBUG("DummyDetectionNode", "process: backend run() on frame ", imageView.width, "x",
+                             imageView.height, ", detections=", result.detections.size());
             }
-            lastFrameValid_ = false;
         } else {
             ImageView dummyImage{};
             dummyImage.width = 0;
@@ -69,27 +146,25 @@ void DummyDetectionNode::process() {
             dummyImage.stride = 0;
             dummyImage.pixelFormat = "UNKNOWN";
             backend_->run(dummyImage, result);
-            std::cout << "[DummyDetectionNode] process: backend run() (no frame), detections="
-                      << result.detections.size() << std::endl;
-        }
-        resultPacketBuffer_.resize(detectionResultPacketSize(result.detections.size()));
-        size_t written = serializeDetectionResult(result, resultPacketBuffer_.data(), resultPacketBuffer_.size());
-        if (written > 0) {
-            auto outPad = getPad("detection_out");
-            if (outPad)
-                outPad->pushToConnections(resultPacketBuffer_.data(), written);
+            FM_LOG_DEBUG("DummyDetectionNode", "process: backend run() (no frame), detections=",
+                         result.detections.size());
         }
+        emitResult(result);
     } else {
-        std::cout << "[DummyDetectionNode] process: emit dummy detection from model="
-                  << modelName_ << std::endl;
-        DetectionResult emptyResult;
-        resultPacketBuffer_.resize(detectionResultPacketSize(0));
-        size_t written = serializeDetectionResult(emptyResult, resultPacketBuffer_.data(), resultPacketBuffer_.size());
-        if (written > 0) {
-            auto outPad = getPad("detection_out");
-            if (outPad)
-                outPad->pushToConnections(resultPacketBuffer_.data(), written);
-        }
+        FM_LOG_DEBUG("DummyDetectionNode", "process: emit dummy detection from model=", modelName_);
+        emitResult(DetectionResult{});
+    }
+}
+
+void DummyDetectionNode::markLatency(DetectionResult& result) {
+    std::int64_t now = PipelineClock::nowNs();
+    std::uint64_t over = latencyTracker_.record(static_cast<std::int64_t>(result.timestampNs), now);
+    result.overLatencyBudget = over > 0;
+    // 首次及此后每 100 次超限告警一次，避免逐帧刷屏
+    if (over == 1 || (over > 0 && over % 100 == 0)) {
+        FM_LOG_WARN("DummyDetectionNode", "frame ", result.frameIndex, " glass-to-detection latency ",
+                    (now - static_cast<std::int64_t>(result.timestampNs)) / 1000000, "ms exceeds budget ",
+                    latencyTracker_.budgetNs() / 1000000, "ms (", over, " frame(s) over budget)");
     }
 }
 
@@ -1,46 +1,207 @@
 #include "falconmind/sdk/perception/EnvironmentDetectionNode.h"
 #include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/perception/LowLightEnhance.h"
+#include "falconmind/sdk/sensors/SensorTypes.h"
 
 #include <iostream>
+#include <type_traits>
 
 namespace falconmind::sdk::perception {
 
 using namespace falconmind::sdk::core;
 
+bool HysteresisLatch::update(bool enter, bool exit, std::int64_t nowNs, std::int64_t enterHoldNs,
+                             std::int64_t exitHoldNs) noexcept {
+    const bool want = active_ ? exit : enter;
+    if (!want) {
+        pendingSinceNs_ = -1;
+        return false;
+    }
+    if (pendingSinceNs_ < 0) pendingSinceNs_ = nowNs;
+    if (nowNs - pendingSinceNs_ < (active_ ? exitHoldNs : enterHoldNs)) return false;
+    active_ = !active_;
+    pendingSinceNs_ = -1;
+    return true;
+}
+
 EnvironmentDetectionNode::EnvironmentDetectionNode() : Node("environment_detection") {
-    addPad(std::make_shared<Pad>("env_status_out", PadType::Source));
+    outPad_ = addPad(std::make_shared<Pad>("env_status_out", PadType::Source));
+    auto* gnssIn = addPad(std::make_shared<Pad>("gnss_in", PadType::Sink));
+    gnssIn->setDataCallback([this](const void* data, size_t size) {
+        if (size < sizeof(sensors::GnssSample)) return;
+        const auto* s = static_cast<const sensors::GnssSample*>(data);
+        const std::int64_t t = now();
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        hasGnss_ = true;
+        hdop_ = s->hdop;
+        numSatellites_ = s->numSatellites;
+        gnssRxNs_ = t;
+    });
+    auto* brightnessIn = addPad(std::make_shared<Pad>("brightness_in", PadType::Sink));
+    brightnessIn->setDataCallback([this](const void* data, size_t size) {
+        if (size < sizeof(FrameBrightnessPacket)) return;
+        const auto* p = static_cast<const FrameBrightnessPacket*>(data);
+        const std::int64_t t = now();
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        hasBrightness_ = true;
+        brightness_ = p->meanLuma;
+        brightnessRxNs_ = t;
+    });
+}
+
+const core::ParamSchema& EnvironmentDetectionNode::paramSchema() {
+    static const core::ParamSchema schema = [] {
+        const EnvironmentDetectionConfig d;
+        core::ParamSchema s;
+        s.string("default_state", "normal", {"normal", "gps_denied", "low_light", "unknown"},
+                 "未收到任何输入时输出的状态")
+            .number("confidence", 1.0, 0.0, 1.0)
+            .integer("min_satellites", d.minSatellites, 0, 64)
+            .number("max_hdop", d.maxHdop, 0.0, 100.0)
+            .integer("recover_satellites", d.recoverSatellites, 0, 64)
+            .number("recover_hdop", d.recoverHdop, 0.0, 100.0)
+            .integer("gnss_timeout_ms", d.gnssTimeoutNs / 1'000'000, 0, 600'000)
+            .number("low_light_enter", d.lowLightEnter, 0.0, 255.0, "平均亮度（0-255）")
+            .number("low_light_exit", d.lowLightExit, 0.0, 255.0)
+            .integer("enter_hold_ms", d.enterHoldNs / 1'000'000, 0, 600'000)
+            .integer("exit_hold_ms", d.exitHoldNs / 1'000'000, 0, 600'000);
+        return s;
+    }();
+    return schema;
 }
 
 bool EnvironmentDetectionNode::configure(const std::unordered_map<std::string, std::string>& params) {
-    auto it = params.find("default_state");
-    if (it != params.end()) {
-        if (it->second == "gps_denied") currentState_ = EnvironmentState::GpsDenied;
-        else if (it->second == "low_light") currentState_ = EnvironmentState::LowLight;
-        else if (it->second == "unknown") currentState_ = EnvironmentState::Unknown;
+    core::NodeParams typed;
+    std::string error;
+    if (!paramSchema().parse(params, typed, error)) {
+        std::cerr << "[EnvironmentDetectionNode] Invalid parameters for " << id() << ": " << error << std::endl;
+        return false;
     }
-    auto cit = params.find("confidence");
-    if (cit != params.end()) {
-        float c = std::stof(cit->second);
-        setConfidence(c);
+    return applyParams(typed);
+}
+
+bool EnvironmentDetectionNode::applyParams(const core::NodeParams& params) {
+    std::string state;
+    if (params.assign("default_state", state)) {
+        if (state == "gps_denied") currentState_ = EnvironmentState::GpsDenied;
+        else if (state == "low_light") currentState_ = EnvironmentState::LowLight;
+        else if (state == "unknown") currentState_ = EnvironmentState::Unknown;
+        else currentState_ = EnvironmentState::Normal;
     }
+    if (params.has("confidence")) setConfidence(static_cast<float>(params.getDouble("confidence")));
+    auto ms = [&params](const char* key, std::int64_t& field) {
+        if (params.has(key)) field = params.getInt(key) * 1'000'000;
+    };
+    params.assign("min_satellites", config_.minSatellites);
+    params.assign("max_hdop", config_.maxHdop);
+    params.assign("recover_satellites", config_.recoverSatellites);
+    params.assign("recover_hdop", config_.recoverHdop);
+    ms("gnss_timeout_ms", config_.gnssTimeoutNs);
+    params.assign("low_light_enter", config_.lowLightEnter);
+    params.assign("low_light_exit", config_.lowLightExit);
+    ms("enter_hold_ms", config_.enterHoldNs);
+    ms("exit_hold_ms", config_.exitHoldNs);
     return true;
 }
 
 bool EnvironmentDetectionNode::start() {
+    // 无输入时以配置的状态作为初始判定，已注册的动作据此对齐
+    gps_.reset(currentState_ == EnvironmentState::GpsDenied);
+    lowLight_.reset(currentState_ == EnvironmentState::LowLight);
+    for (const auto& b : bindings_) {
+        b.action(b.condition == EnvironmentCondition::GpsDenied ? gps_.active() : lowLight_.active());
+    }
     started_ = true;
     std::cout << "[EnvironmentDetectionNode] start() output env_status (state="
               << static_cast<int>(currentState_) << " confidence=" << confidence_ << ")" << std::endl;
     return true;
 }
 
+void EnvironmentDetectionNode::onCondition(EnvironmentCondition condition, std::function<void(bool)> action) {
+    if (action) bindings_.push_back(Binding{condition, std::move(action)});
+}
+
+void EnvironmentDetectionNode::bindGate(EnvironmentCondition condition, std::shared_ptr<GateNode> gate,
+                                        bool openWhenActive) {
+    if (!gate) return;
+    onCondition(condition, [gate, openWhenActive](bool active) { gate->setOpen(active == openWhenActive); });
+}
+
+void EnvironmentDetectionNode::bindSelector(EnvironmentCondition condition, std::shared_ptr<SelectorNode> selector,
+                                            int activeOutput, int inactiveOutput) {
+    if (!selector) return;
+    onCondition(condition, [selector, activeOutput, inactiveOutput](bool active) {
+        selector->select(active ? activeOutput : inactiveOutput);
+    });
+}
+
+std::int64_t EnvironmentDetectionNode::now() const {
+    return clock_ ? clock_() : PipelineClock::nowNs();
+}
+
+void EnvironmentDetectionNode::notify(EnvironmentCondition condition, bool active) {
+    for (const auto& b : bindings_) {
+        if (b.condition == condition) b.action(active);
+    }
+}
+
+EnvironmentStatusPacket EnvironmentDetectionNode::lastStatus() const {
+    std::lock_guard<std::mutex> lock(inputMutex_);
+    return last_;
+}
+
 void EnvironmentDetectionNode::process() {
     if (!started_) return;
     EnvironmentStatusPacket pkt;
-    pkt.state = static_cast<int32_t>(currentState_);
-    pkt.confidence = confidence_;
-    auto outPad = getPad("env_status_out");
-    if (outPad)
-        outPad->pushToConnections(&pkt, sizeof(pkt));
+    bool hasGnss, hasBrightness;
+    std::int64_t gnssRx, brightnessRx;
+    {
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        hasGnss = hasGnss_;
+        hasBrightness = hasBrightness_;
+        gnssRx = gnssRxNs_;
+        brightnessRx = brightnessRxNs_;
+        pkt.hdop = hdop_;
+        pkt.numSatellites = numSatellites_;
+        pkt.meanBrightness = brightness_;
+    }
+
+    if (!hasGnss && !hasBrightness) {
+        pkt.state = static_cast<int32_t>(currentState_);
+        pkt.confidence = confidence_;
+        pkt.flags = currentState_ == EnvironmentState::GpsDenied  ? kEnvGpsDenied
+                    : currentState_ == EnvironmentState::LowLight ? kEnvLowLight
+                                                                  : 0u;
+    } else {
+        const std::int64_t t = now();
+        const auto& c = config_;
+        if (hasGnss) {
+            // GNSS 中断（拒止 / 干扰）同样视为进入条件；恢复须收到新样本且质量达标
+            const bool stale = t - gnssRx > c.gnssTimeoutNs;
+            const bool poor = stale || pkt.numSatellites < c.minSatellites || pkt.hdop > c.maxHdop;
+            const bool good = !stale && pkt.numSatellites >= c.recoverSatellites && pkt.hdop <= c.recoverHdop;
+            if (gps_.update(poor, good, t, c.enterHoldNs, c.exitHoldNs)) notify(EnvironmentCondition::GpsDenied, gps_.active());
+        }
+        if (hasBrightness && t - brightnessRx <= c.brightnessTimeoutNs) {
+            const bool dark = pkt.meanBrightness < c.lowLightEnter;
+            const bool light = pkt.meanBrightness > c.lowLightExit;
+            if (lowLight_.update(dark, light, t, c.enterHoldNs, c.exitHoldNs))
+                notify(EnvironmentCondition::LowLight, lowLight_.active());
+        }
+        pkt.flags = (gps_.active() ? kEnvGpsDenied : 0u) | (lowLight_.active() ? kEnvLowLight : 0u);
+        pkt.state = static_cast<int32_t>(gps_.active()      ? EnvironmentState::GpsDenied
+                                         : lowLight_.active() ? EnvironmentState::LowLight
+                                                              : EnvironmentState::Normal);
+        // 只有一路输入时另一条件无法判定，置信度减半
+        pkt.confidence = (hasGnss && hasBrightness) ? 1.f : 0.5f;
+    }
+    {
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        last_ = pkt;
+    }
+    if (outPad_)
+        outPad_->pushToConnections(&pkt, sizeof(pkt));
 }
 
 } // namespace falconmind::sdk::perception
@@ -0,0 +1,191 @@
+#include "falconmind/sdk/perception/FiducialDetectionNode.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+
+#include "falconmind/sdk/core/Pad.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace falconmind::sdk::perception {
+
+using namespace falconmind::sdk::core;
+using namespace falconmind::sdk::sensors;
+
+FiducialDetectionNode::FiducialDetectionNode()
+    : Node("fiducial_detection"), detector_(std::make_unique<FiducialDetector>()) {
+    // 只在亮度平面上检测：NV12 / YUYV
+    Caps caps;
+    caps.addVideo(VideoCaps{PixelFormat::NV12, 0, 0, 0});
+    caps.addVideo(VideoCaps{PixelFormat::YUYV, 0, 0, 0});
+    auto in = std::make_shared<Pad>("video_in", PadType::Sink);
+    in->setCaps(caps);
+    in->setCapsCallback([this](const VideoCaps& c) { inputFormat_ = c.format; });
+    inPad_ = addPad(in);
+    outPad_ = addPad(std::make_shared<Pad>("target_out", PadType::Source));
+}
+
+bool FiducialDetectionNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    core::Node::configure(params);
+    auto number = [&](const char* key, double& out) {
+        auto it = params.find(key);
+        if (it == params.end()) return;
+        out = std::strtod(it->second.c_str(), nullptr);
+    };
+
+    FiducialFamily family = detector_->family();
+    bool familyChanged = false;
+    auto fam = params.find("family");
+    if (fam != params.end()) {
+        if (fam->second == "tag16h5") {
+            family = FiducialFamily::tag16h5();
+        } else if (fam->second == "custom") {
+            // ArUco 等字典：同一布局的码表（见 FiducialFamily）
+            auto codes = params.find("codes");
+            if (codes == params.end()) {
+                std::cerr << "[FiducialDetectionNode] family=custom requires codes" << std::endl;
+                return false;
+            }
+            std::vector<std::uint64_t> list;
+            std::stringstream ss(codes->second);
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                if (item.find_first_not_of(" \t") == std::string::npos) continue;
+                list.push_back(std::strtoull(item.c_str(), nullptr, 16));
+            }
+            double side = 4., minHamming = 3.;
+            number("code_side", side);
+            number("min_hamming", minHamming);
+            if (list.empty() || side < 2. || side > 8.) {
+                std::cerr << "[FiducialDetectionNode] invalid custom dictionary (codes=" << list.size()
+                          << ", code_side=" << side << ")" << std::endl;
+                return false;
+            }
+            family = FiducialFamily::fromCodes("custom", static_cast<int>(side), static_cast<int>(minHamming),
+                                               std::move(list));
+        } else {
+            std::cerr << "[FiducialDetectionNode] Unknown family: " << fam->second << std::endl;
+            return false;
+        }
+        familyChanged = true;
+    }
+
+    FiducialDetectorConfig cfg = detector_->config();
+    double v = cfg.targetId;
+    number("target_id", v);
+    cfg.targetId = static_cast<int>(v);
+    number("tag_size_m", cfg.tagSizeM);
+    number("fx", cfg.fx);
+    number("fy", cfg.fy);
+    number("cx", cfg.cx);
+    number("cy", cfg.cy);
+    if (cfg.fy <= 0.) cfg.fy = cfg.fx;
+    v = cfg.minContrast;
+    number("min_contrast", v);
+    cfg.minContrast = static_cast<int>(v);
+    v = cfg.minTagPx;
+    number("min_tag_px", v);
+    cfg.minTagPx = static_cast<int>(v);
+    v = cfg.minDecisionMargin;
+    number("min_decision_margin", v);
+    cfg.minDecisionMargin = static_cast<float>(v);
+    v = cfg.maxHammingCorrect;
+    number("max_hamming", v);
+    cfg.maxHammingCorrect = static_cast<int>(v);
+    v = cfg.roiMargin;
+    number("roi_margin", v);
+    cfg.roiMargin = static_cast<float>(v);
+    auto roi = params.find("roi_tracking");
+    if (roi != params.end()) cfg.roiTracking = (roi->second == "1" || roi->second == "true" || roi->second == "yes");
+
+    if (familyChanged) {
+        detector_ = std::make_unique<FiducialDetector>(std::move(family), cfg);
+    } else {
+        detector_->setConfig(cfg);
+    }
+    return true;
+}
+
+bool FiducialDetectionNode::start() {
+    if (inPad_) {
+        inPad_->setBufferCallback([this](const BufferRef& frame) {
+            if (frame.size() >= sizeof(CameraFramePacket)) {
+                std::lock_guard<std::mutex> lock(frameMutex_);
+                lastFrame_ = frame;
+            }
+        });
+    }
+    detector_->resetTracking();
+    started_ = true;
+    std::cout << "[FiducialDetectionNode] start() family=" << detector_->family().name
+              << " kernel=" << FiducialDetector::kernelName() << " target_id=" << detector_->config().targetId
+              << std::endl;
+    return true;
+}
+
+void FiducialDetectionNode::process() {
+    if (!started_) return;
+    BufferRef frame;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        frame = std::move(lastFrame_);
+        lastFrame_.reset();
+    }
+    if (frame.size() < sizeof(CameraFramePacket)) {
+        return;
+    }
+
+    const auto* header = reinterpret_cast<const CameraFramePacket*>(frame.data());
+    PixelFormat fmt = frame.meta().video.format != PixelFormat::Any ? frame.meta().video.format : inputFormat_;
+    if (fmt == PixelFormat::Any) fmt = parsePixelFormat(header->format);
+    if (fmt != PixelFormat::NV12 && fmt != PixelFormat::YUYV) {
+        if (!warnedFormat_) {
+            std::cerr << "[FiducialDetectionNode] unsupported pixel format " << header->format
+                      << ", expected NV12 or YUYV" << std::endl;
+            warnedFormat_ = true;
+        }
+        return;
+    }
+    const int bpp = fmt == PixelFormat::YUYV ? 2 : 1;
+    const int stride = header->stride > 0 ? header->stride : header->width * bpp;
+    // 只读 Y 平面（NV12）或交错行（YUYV）
+    const std::size_t needed = static_cast<std::size_t>(stride) * static_cast<std::size_t>(header->height);
+    if (header->width <= 0 || header->height <= 0 || frame.size() < sizeof(CameraFramePacket) + needed) {
+        return;
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const FiducialResult& result =
+        detector_->detect(cameraFramePacketData(header), header->width, header->height, stride, fmt);
+    const auto elapsed = std::chrono::steady_clock::now() - t0;
+
+    FiducialTargetPacket pkt;
+    pkt.timestampNs = frame.meta().timestampNs != 0 ? frame.meta().timestampNs
+                                                   : static_cast<std::int64_t>(header->captureTimestampNs);
+    pkt.frameIndex = frame.meta().frameIndex != 0 ? frame.meta().frameIndex : header->frameIndex;
+    pkt.detections = static_cast<std::uint32_t>(result.detections.size());
+    pkt.processingUs = static_cast<std::uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    if (result.targetIndex >= 0) {
+        const FiducialDetection& d = result.detections[result.targetIndex];
+        pkt.found = 1;
+        pkt.id = d.id;
+        pkt.roiSearch = result.roiSearch ? 1 : 0;
+        for (int k = 0; k < 4; ++k) {
+            pkt.corners[k][0] = d.corners[k][0];
+            pkt.corners[k][1] = d.corners[k][1];
+        }
+        pkt.center[0] = d.center[0];
+        pkt.center[1] = d.center[1];
+        pkt.decisionMargin = d.decisionMargin;
+        pkt.hasPose = d.hasPose ? 1 : 0;
+        for (int i = 0; i < 3; ++i) pkt.position[i] = d.position[i];
+        pkt.yaw = d.yaw;
+    }
+    last_ = pkt;
+    if (outPad_) outPad_->pushToConnections(&pkt, sizeof(pkt));
+}
+
+} // namespace falconmind::sdk::perception
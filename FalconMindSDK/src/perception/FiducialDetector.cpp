@@ -0,0 +1,880 @@
+#include "falconmind/sdk/perception/FiducialDetector.h"
+#include "falconmind/sdk/core/CpuFeatures.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+constexpr int kTile = 4;
+constexpr std::uint8_t kBlack = 0;
+constexpr std::uint8_t kVisited = 1;
+constexpr std::uint8_t kUnknown = 127;
+
+// 4 行 × tiles 个 4 像素宽分块的最小 / 最大亮度
+using TileRowFn = void (*)(const std::uint8_t* src, int stride, int tiles, std::uint8_t* mn, std::uint8_t* mx);
+// dst = valid ? (src > thr ? 255 : 0) : 127
+using BinarizeRowFn = void (*)(const std::uint8_t* src, const std::uint8_t* thr, const std::uint8_t* valid,
+                               std::uint8_t* dst, int n);
+// YUYV 行取亮度
+using LumaRowFn = void (*)(const std::uint8_t* yuyv, std::uint8_t* y, int n);
+
+void tileRowScalar(const std::uint8_t* src, int stride, int tiles, std::uint8_t* mn, std::uint8_t* mx) {
+    for (int t = 0; t < tiles; ++t) {
+        std::uint8_t lo = 255, hi = 0;
+        for (int r = 0; r < kTile; ++r) {
+            const std::uint8_t* p = src + r * stride + t * kTile;
+            for (int c = 0; c < kTile; ++c) {
+                lo = std::min(lo, p[c]);
+                hi = std::max(hi, p[c]);
+            }
+        }
+        mn[t] = lo;
+        mx[t] = hi;
+    }
+}
+
+void binarizeRowScalar(const std::uint8_t* src, const std::uint8_t* thr, const std::uint8_t* valid,
+                       std::uint8_t* dst, int n) {
+    for (int i = 0; i < n; ++i) dst[i] = valid[i] ? (src[i] > thr[i] ? 255 : kBlack) : kUnknown;
+}
+
+void lumaRowScalar(const std::uint8_t* yuyv, std::uint8_t* y, int n) {
+    for (int i = 0; i < n; ++i) y[i] = yuyv[2 * i];
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FALCONMIND_FIDUCIAL_X86 1
+// 4 行纵向取极值后在每个 32 位字内移位归约，字的最低字节即该分块结果，再用字节重排收拢
+__attribute__((target("sse4.1"))) void tileRowSse41(const std::uint8_t* src, int stride, int tiles,
+                                                      std::uint8_t* mn, std::uint8_t* mx) {
+    const __m128i gather = _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    int t = 0;
+    for (; t + 4 <= tiles; t += 4) {
+        const std::uint8_t* p = src + t * kTile;
+        const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + stride));
+        const __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 2 * stride));
+        const __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 3 * stride));
+        __m128i lo = _mm_min_epu8(_mm_min_epu8(r0, r1), _mm_min_epu8(r2, r3));
+        __m128i hi = _mm_max_epu8(_mm_max_epu8(r0, r1), _mm_max_epu8(r2, r3));
+        lo = _mm_min_epu8(lo, _mm_srli_epi32(lo, 8));
+        lo = _mm_min_epu8(lo, _mm_srli_epi32(lo, 16));
+        hi = _mm_max_epu8(hi, _mm_srli_epi32(hi, 8));
+        hi = _mm_max_epu8(hi, _mm_srli_epi32(hi, 16));
+        const int l = _mm_cvtsi128_si32(_mm_shuffle_epi8(lo, gather));
+        const int h = _mm_cvtsi128_si32(_mm_shuffle_epi8(hi, gather));
+        std::memcpy(mn + t, &l, 4);
+        std::memcpy(mx + t, &h, 4);
+    }
+    tileRowScalar(src + t * kTile, stride, tiles - t, mn + t, mx + t);
+}
+
+__attribute__((target("avx2"))) void tileRowAvx2(const std::uint8_t* src, int stride, int tiles,
+                                                   std::uint8_t* mn, std::uint8_t* mx) {
+    const __m256i gather = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                            0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i pack = _mm256_setr_epi32(0, 4, 1, 1, 1, 1, 1, 1);
+    int t = 0;
+    for (; t + 8 <= tiles; t += 8) {
+        const std::uint8_t* p = src + t * kTile;
+        const __m256i r0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i r1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + stride));
+        const __m256i r2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 2 * stride));
+        const __m256i r3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 3 * stride));
+        __m256i lo = _mm256_min_epu8(_mm256_min_epu8(r0, r1), _mm256_min_epu8(r2, r3));
+        __m256i hi = _mm256_max_epu8(_mm256_max_epu8(r0, r1), _mm256_max_epu8(r2, r3));
+        lo = _mm256_min_epu8(lo, _mm256_srli_epi32(lo, 8));
+        lo = _mm256_min_epu8(lo, _mm256_srli_epi32(lo, 16));
+        hi = _mm256_max_epu8(hi, _mm256_srli_epi32(hi, 8));
+        hi = _mm256_max_epu8(hi, _mm256_srli_epi32(hi, 16));
+        // 每个 128 位通道的 4 个结果在其首字，跨通道收拢到低 8 字节
+        lo = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(lo, gather), pack);
+        hi = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(hi, gather), pack);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(mn + t), _mm256_castsi256_si128(lo));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(mx + t), _mm256_castsi256_si128(hi));
+    }
+    tileRowSse41(src + t * kTile, stride, tiles - t, mn + t, mx + t);
+}
+
+// 无符号 src > thr 即饱和减法非零；低对比像素以 valid 掩码混合为 127
+__attribute__((target("sse4.1"))) void binarizeRowSse41(const std::uint8_t* src, const std::uint8_t* thr,
+                                                          const std::uint8_t* valid, std::uint8_t* dst, int n) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi8(-1);
+    const __m128i unknown = _mm_set1_epi8(static_cast<char>(kUnknown));
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i th = _mm_loadu_si128(reinterpret_cast<const __m128i*>(thr + i));
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(valid + i));
+        const __m128i black = _mm_cmpeq_epi8(_mm_subs_epu8(s, th), zero);
+        const __m128i white = _mm_andnot_si128(black, ones);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_blendv_epi8(unknown, white, v));
+    }
+    binarizeRowScalar(src + i, thr + i, valid + i, dst + i, n - i);
+}
+
+__attribute__((target("avx2"))) void binarizeRowAvx2(const std::uint8_t* src, const std::uint8_t* thr,
+                                                       const std::uint8_t* valid, std::uint8_t* dst, int n) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi8(-1);
+    const __m256i unknown = _mm256_set1_epi8(static_cast<char>(kUnknown));
+    int i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i th = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(thr + i));
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(valid + i));
+        const __m256i black = _mm256_cmpeq_epi8(_mm256_subs_epu8(s, th), zero);
+        const __m256i white = _mm256_andnot_si256(black, ones);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_blendv_epi8(unknown, white, v));
+    }
+    binarizeRowSse41(src + i, thr + i, valid + i, dst + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) void lumaRowSse41(const std::uint8_t* yuyv, std::uint8_t* y, int n) {
+    const __m128i mask = _mm_set1_epi16(0x00ff);
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(yuyv + 2 * i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(yuyv + 2 * i + 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(y + i),
+                         _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+    }
+    lumaRowScalar(yuyv + 2 * i, y + i, n - i);
+}
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FALCONMIND_FIDUCIAL_NEON 1
+// 纵向取极值后两次成对归约：第一次得到相邻 2 像素，第二次得到 4 像素分块
+void tileRowNeon(const std::uint8_t* src, int stride, int tiles, std::uint8_t* mn, std::uint8_t* mx) {
+    int t = 0;
+    for (; t + 4 <= tiles; t += 4) {
+        const std::uint8_t* p = src + t * kTile;
+        const uint8x16_t r0 = vld1q_u8(p);
+        const uint8x16_t r1 = vld1q_u8(p + stride);
+        const uint8x16_t r2 = vld1q_u8(p + 2 * stride);
+        const uint8x16_t r3 = vld1q_u8(p + 3 * stride);
+        const uint8x16_t lo = vminq_u8(vminq_u8(r0, r1), vminq_u8(r2, r3));
+        const uint8x16_t hi = vmaxq_u8(vmaxq_u8(r0, r1), vmaxq_u8(r2, r3));
+        uint8x8_t l = vpmin_u8(vget_low_u8(lo), vget_high_u8(lo));
+        uint8x8_t h = vpmax_u8(vget_low_u8(hi), vget_high_u8(hi));
+        l = vpmin_u8(l, l);
+        h = vpmax_u8(h, h);
+        const std::uint32_t lw = vget_lane_u32(vreinterpret_u32_u8(l), 0);
+        const std::uint32_t hw = vget_lane_u32(vreinterpret_u32_u8(h), 0);
+        std::memcpy(mn + t, &lw, 4);
+        std::memcpy(mx + t, &hw, 4);
+    }
+    tileRowScalar(src + t * kTile, stride, tiles - t, mn + t, mx + t);
+}
+
+void binarizeRowNeon(const std::uint8_t* src, const std::uint8_t* thr, const std::uint8_t* valid,
+                     std::uint8_t* dst, int n) {
+    const uint8x16_t unknown = vdupq_n_u8(kUnknown);
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const uint8x16_t white = vcgtq_u8(vld1q_u8(src + i), vld1q_u8(thr + i));
+        vst1q_u8(dst + i, vbslq_u8(vld1q_u8(valid + i), white, unknown));
+    }
+    binarizeRowScalar(src + i, thr + i, valid + i, dst + i, n - i);
+}
+
+void lumaRowNeon(const std::uint8_t* yuyv, std::uint8_t* y, int n) {
+    int i = 0;
+    for (; i + 16 <= n; i += 16) vst1q_u8(y + i, vld2q_u8(yuyv + 2 * i).val[0]);
+    lumaRowScalar(yuyv + 2 * i, y + i, n - i);
+}
+#endif
+
+struct Kernels {
+    TileRowFn tile;
+    BinarizeRowFn binarize;
+    LumaRowFn luma;
+    const char* name;
+};
+
+Kernels selectKernels() {
+#if defined(FALCONMIND_FIDUCIAL_NEON)
+    return {tileRowNeon, binarizeRowNeon, lumaRowNeon, "neon"};
+#else
+    Kernels k{tileRowScalar, binarizeRowScalar, lumaRowScalar, "scalar"};
+#if defined(FALCONMIND_FIDUCIAL_X86)
+    const core::CpuFeatures& cpu = core::cpuFeatures();
+    if (cpu.avx2) {
+        k = {tileRowAvx2, binarizeRowAvx2, lumaRowSse41, "avx2"};
+    } else if (cpu.sse41) {
+        k = {tileRowSse41, binarizeRowSse41, lumaRowSse41, "sse4.1"};
+    }
+#endif
+    return k;
+#endif
+}
+
+const Kernels& kernels() {
+    static const Kernels k = selectKernels();
+    return k;
+}
+
+// 8 邻域按顺时针排列（图像坐标 y 向下）：E, SE, S, SW, W, NW, N, NE
+constexpr int kDx[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+constexpr int kDy[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+// 4 点单应（h33 = 1）：src[i] → dst[i]，8×8 列主元消元
+bool solveHomography(const double src[4][2], const double dst[4][2], double H[9]) {
+    double A[8][9];
+    for (int i = 0; i < 4; ++i) {
+        const double x = src[i][0], y = src[i][1], u = dst[i][0], v = dst[i][1];
+        double* r0 = A[2 * i];
+        double* r1 = A[2 * i + 1];
+        r0[0] = x; r0[1] = y; r0[2] = 1; r0[3] = 0; r0[4] = 0; r0[5] = 0; r0[6] = -u * x; r0[7] = -u * y; r0[8] = u;
+        r1[0] = 0; r1[1] = 0; r1[2] = 0; r1[3] = x; r1[4] = y; r1[5] = 1; r1[6] = -v * x; r1[7] = -v * y; r1[8] = v;
+    }
+    for (int c = 0; c < 8; ++c) {
+        int pivot = c;
+        for (int r = c + 1; r < 8; ++r) {
+            if (std::fabs(A[r][c]) > std::fabs(A[pivot][c])) pivot = r;
+        }
+        if (std::fabs(A[pivot][c]) < 1e-12) return false;
+        if (pivot != c) std::swap(A[pivot], A[c]);
+        for (int r = 0; r < 8; ++r) {
+            if (r == c) continue;
+            const double f = A[r][c] / A[c][c];
+            if (f == 0.) continue;
+            for (int k = c; k < 9; ++k) A[r][k] -= f * A[c][k];
+        }
+    }
+    for (int i = 0; i < 8; ++i) H[i] = A[i][8] / A[i][i];
+    H[8] = 1.;
+    return true;
+}
+
+inline void applyHomography(const double H[9], double x, double y, double& u, double& v) {
+    const double w = H[6] * x + H[7] * y + H[8];
+    u = (H[0] * x + H[1] * y + H[2]) / w;
+    v = (H[3] * x + H[4] * y + H[5]) / w;
+}
+
+// 双线性采样，像素中心位于整数坐标，越界取边缘
+float sampleBilinear(const std::uint8_t* img, int stride, int w, int h, double x, double y) {
+    x = std::clamp(x, 0., static_cast<double>(w - 1));
+    y = std::clamp(y, 0., static_cast<double>(h - 1));
+    const int x0 = std::min(static_cast<int>(x), w - 2 < 0 ? 0 : w - 2);
+    const int y0 = std::min(static_cast<int>(y), h - 2 < 0 ? 0 : h - 2);
+    const int x1 = std::min(x0 + 1, w - 1);
+    const int y1 = std::min(y0 + 1, h - 1);
+    const double fx = x - x0, fy = y - y0;
+    const std::uint8_t* r0 = img + static_cast<std::size_t>(y0) * stride;
+    const std::uint8_t* r1 = img + static_cast<std::size_t>(y1) * stride;
+    const double top = r0[x0] + fx * (r0[x1] - r0[x0]);
+    const double bottom = r1[x0] + fx * (r1[x1] - r1[x0]);
+    return static_cast<float>(top + fy * (bottom - top));
+}
+
+// 点集的主方向直线 n·p = c（n 为单位法向）；返回垂向残差的均方根
+double fitLine(const std::vector<std::array<int, 2>>& pts, std::size_t begin, std::size_t count,
+               double& nx, double& ny, double& c) {
+    const std::size_t n = pts.size();
+    double mx = 0., my = 0.;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& p = pts[(begin + i) % n];
+        mx += p[0];
+        my += p[1];
+    }
+    mx /= static_cast<double>(count);
+    my /= static_cast<double>(count);
+    double sxx = 0., sxy = 0., syy = 0.;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& p = pts[(begin + i) % n];
+        const double dx = p[0] - mx, dy = p[1] - my;
+        sxx += dx * dx;
+        sxy += dx * dy;
+        syy += dy * dy;
+    }
+    // 2×2 协方差的较小特征值对应法向
+    const double half = 0.5 * (sxx + syy);
+    const double diff = 0.5 * (sxx - syy);
+    const double root = std::sqrt(diff * diff + sxy * sxy);
+    const double lmin = half - root;
+    const double theta = 0.5 * std::atan2(2. * sxy, sxx - syy);  // 主方向
+    nx = -std::sin(theta);
+    ny = std::cos(theta);
+    c = nx * mx + ny * my;
+    return std::sqrt(std::max(lmin, 0.) / static_cast<double>(count));
+}
+
+int popcount64(std::uint64_t v) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(v);
+#else
+    int n = 0;
+    for (; v; v &= v - 1) ++n;
+    return n;
+#endif
+}
+
+} // namespace
+
+FiducialFamily FiducialFamily::tag16h5() {
+    return fromCodes("tag16h5", 4, 5,
+                     {0x231bULL, 0x2ea5ULL, 0x346aULL, 0x45b9ULL, 0x79a6ULL, 0x7f6bULL, 0xb358ULL, 0xe745ULL,
+                      0xfe59ULL, 0x156dULL, 0x380bULL, 0xf0abULL, 0x0d84ULL, 0x4736ULL, 0x8c72ULL, 0xaf10ULL,
+                      0x093cULL, 0x93b4ULL, 0xa503ULL, 0x468fULL, 0xe137ULL, 0x5795ULL, 0xdf42ULL, 0x1c1dULL,
+                      0xe9dcULL, 0x73adULL, 0xad5fULL, 0xd530ULL, 0x07caULL, 0xaf2eULL});
+}
+
+FiducialFamily FiducialFamily::fromCodes(std::string name, int side, int minHamming, std::vector<std::uint64_t> codes) {
+    FiducialFamily f;
+    f.name = std::move(name);
+    f.side = side;
+    f.minHamming = minHamming;
+    f.codes = std::move(codes);
+    return f;
+}
+
+std::uint64_t FiducialFamily::rotate90(std::uint64_t code) const noexcept {
+    // 顺时针旋转后 (r, c) 处的格来自旋转前 (side-1-c, r)
+    const int n = side;
+    std::uint64_t out = 0;
+    for (int r = 0; r < n; ++r) {
+        for (int c = 0; c < n; ++c) {
+            const int src = (n - 1 - c) * n + r;
+            const std::uint64_t bit = (code >> (n * n - 1 - src)) & 1ULL;
+            out = (out << 1) | bit;
+        }
+    }
+    return out;
+}
+
+FiducialDetector::FiducialDetector(FiducialFamily family, FiducialDetectorConfig config)
+    : family_(std::move(family)) {
+    if (family_.side < 2 || family_.side > 8) {
+        std::cerr << "[FiducialDetector] Unsupported family side " << family_.side << " (" << family_.name
+                  << "), expected 2..8" << std::endl;
+        family_.codes.clear();
+        family_.side = 4;
+    }
+    const int bits = family_.side * family_.side;
+    const std::uint64_t mask = bits >= 64 ? ~0ULL : ((1ULL << bits) - 1ULL);
+    rotatedCodes_.reserve(family_.codes.size());
+    for (std::uint64_t code : family_.codes) {
+        std::array<std::uint64_t, 4> rot{};
+        rot[0] = code & mask;
+        for (int k = 1; k < 4; ++k) rot[k] = family_.rotate90(rot[k - 1]);
+        rotatedCodes_.push_back(rot);
+    }
+    setConfig(config);
+    result_.detections.reserve(8);
+}
+
+void FiducialDetector::setConfig(const FiducialDetectorConfig& config) {
+    config_ = config;
+    config_.minTagPx = std::max(config_.minTagPx, 4);
+    config_.minContrast = std::clamp(config_.minContrast, 1, 255);
+    config_.maxHammingCorrect = std::clamp(config_.maxHammingCorrect, 0, std::max((family_.minHamming - 1) / 2, 0));
+    config_.roiMargin = std::max(config_.roiMargin, 0.f);
+    config_.roiPaddingPx = std::max(config_.roiPaddingPx, 0);
+    config_.maxContourPoints = std::max(config_.maxContourPoints, 16);
+}
+
+const char* FiducialDetector::kernelName() noexcept { return kernels().name; }
+
+const FiducialResult& FiducialDetector::detect(const std::uint8_t* data, int width, int height, int stride,
+                                               core::PixelFormat format) {
+    result_.detections.clear();
+    result_.targetIndex = -1;
+    result_.roiSearch = false;
+    result_.searched = {};
+    result_.candidates = 0;
+    const bool yuyv = format == core::PixelFormat::YUYV;
+    if (!data || width < 2 * kTile || height < 2 * kTile ||
+        (format != core::PixelFormat::NV12 && format != core::PixelFormat::Any && !yuyv)) {
+        locked_ = false;
+        return result_;
+    }
+    frame_ = data;
+    width_ = width;
+    height_ = height;
+    stride_ = stride > 0 ? stride : (yuyv ? width * 2 : width);
+    format_ = format;
+
+    bool found = false;
+    if (locked_ && config_.roiTracking) {
+        const FiducialRoi roi = predictRoi();
+        if (roi.width < width_ || roi.height < height_) {
+            search(roi);
+            result_.targetIndex = pickTarget();
+            // ROI 内只接受原目标：换成其他标记时按整帧重新选择
+            found = result_.targetIndex >= 0 &&
+                    (config_.targetId < 0 ? result_.detections[result_.targetIndex].id == last_.id
+                                          : result_.detections[result_.targetIndex].id == config_.targetId);
+            if (found) {
+                result_.roiSearch = true;
+                ++roiFrames_;
+            } else {
+                result_.detections.clear();
+            }
+        }
+    }
+    if (!found) {
+        search(FiducialRoi{0, 0, width_, height_});
+        ++fullFrames_;
+        result_.targetIndex = pickTarget();
+        if (result_.targetIndex < 0 && config_.targetId < 0 && !result_.detections.empty()) {
+            // 原目标已不在画面：改为锁定面积最大的标记
+            locked_ = false;
+            result_.targetIndex = pickTarget();
+        }
+        found = result_.targetIndex >= 0;
+    }
+
+    if (found) {
+        const FiducialDetection& t = result_.detections[result_.targetIndex];
+        if (locked_ && t.id == last_.id) {
+            velocity_ = {t.center[0] - last_.center[0], t.center[1] - last_.center[1]};
+        } else {
+            velocity_ = {0.f, 0.f};
+        }
+        last_ = t;
+        locked_ = true;
+    } else {
+        locked_ = false;
+    }
+    return result_;
+}
+
+FiducialRoi FiducialDetector::predictRoi() const {
+    const float px = last_.center[0] + velocity_[0];
+    const float py = last_.center[1] + velocity_[1];
+    float radius = 0.f;
+    for (const auto& c : last_.corners) {
+        radius = std::max(radius, std::hypot(c[0] - last_.center[0], c[1] - last_.center[1]));
+    }
+    // 预测位移本身的不确定度按速度大小计入
+    const float half = radius * (1.f + config_.roiMargin) + static_cast<float>(config_.roiPaddingPx) +
+                       0.5f * std::hypot(velocity_[0], velocity_[1]);
+    // 分块对齐到 4 像素，阈值分块与整帧一致
+    int x0 = static_cast<int>(std::floor((px - half) / kTile)) * kTile;
+    int y0 = static_cast<int>(std::floor((py - half) / kTile)) * kTile;
+    int x1 = static_cast<int>(std::ceil((px + half) / kTile)) * kTile;
+    int y1 = static_cast<int>(std::ceil((py + half) / kTile)) * kTile;
+    x0 = std::clamp(x0, 0, width_);
+    y0 = std::clamp(y0, 0, height_);
+    x1 = std::clamp(x1, 0, width_);
+    y1 = std::clamp(y1, 0, height_);
+    return FiducialRoi{x0, y0, x1 - x0, y1 - y0};
+}
+
+int FiducialDetector::pickTarget() const {
+    const int want = config_.targetId >= 0 ? config_.targetId : (locked_ ? last_.id : -1);
+    int best = -1;
+    double bestArea = 0.;
+    for (std::size_t i = 0; i < result_.detections.size(); ++i) {
+        const FiducialDetection& d = result_.detections[i];
+        if (want >= 0 && d.id != want) continue;
+        double area = 0.;
+        for (int k = 0; k < 4; ++k) {
+            const auto& a = d.corners[k];
+            const auto& b = d.corners[(k + 1) % 4];
+            area += static_cast<double>(a[0]) * b[1] - static_cast<double>(b[0]) * a[1];
+        }
+        area = std::fabs(area);
+        if (best < 0 || area > bestArea) {
+            best = static_cast<int>(i);
+            bestArea = area;
+        }
+    }
+    return best;
+}
+
+int FiducialDetector::search(const FiducialRoi& roi) {
+    result_.searched = roi;
+    const std::size_t before = result_.detections.size();
+    if (roi.width < 2 * kTile || roi.height < 2 * kTile || !loadLuma(roi)) return 0;
+    threshold(roi.width, roi.height);
+    segment(roi.width, roi.height);
+    return static_cast<int>(result_.detections.size() - before);
+}
+
+bool FiducialDetector::loadLuma(const FiducialRoi& roi) {
+    originX_ = roi.x;
+    originY_ = roi.y;
+    if (format_ != core::PixelFormat::YUYV) {
+        // NV12 / 灰度：Y 平面零拷贝
+        luma_ = frame_ + static_cast<std::size_t>(roi.y) * stride_ + roi.x;
+        lumaStride_ = stride_;
+        return true;
+    }
+    // YUYV：仅抽取搜索区域的亮度
+    lumaBuf_.resize(static_cast<std::size_t>(roi.width) * roi.height);
+    const LumaRowFn luma = kernels().luma;
+    for (int y = 0; y < roi.height; ++y) {
+        luma(frame_ + static_cast<std::size_t>(roi.y + y) * stride_ + 2 * roi.x,
+             lumaBuf_.data() + static_cast<std::size_t>(y) * roi.width, roi.width);
+    }
+    luma_ = lumaBuf_.data();
+    lumaStride_ = roi.width;
+    return true;
+}
+
+void FiducialDetector::threshold(int w, int h) {
+    const Kernels& k = kernels();
+    const int tw = w / kTile, th = h / kTile;
+    const std::size_t tiles = static_cast<std::size_t>(tw) * th;
+    tileMin_.resize(tiles);
+    tileMax_.resize(tiles);
+    tileThr_.resize(tiles);
+    tileValid_.resize(tiles);
+    for (int ty = 0; ty < th; ++ty) {
+        k.tile(luma_ + static_cast<std::size_t>(ty) * kTile * lumaStride_, lumaStride_, tw,
+               tileMin_.data() + static_cast<std::size_t>(ty) * tw, tileMax_.data() + static_cast<std::size_t>(ty) * tw);
+    }
+    // 3×3 邻域分块的极值：分块边界处的边缘两侧使用同一阈值
+    for (int ty = 0; ty < th; ++ty) {
+        for (int tx = 0; tx < tw; ++tx) {
+            std::uint8_t lo = 255, hi = 0;
+            for (int y = std::max(ty - 1, 0); y <= std::min(ty + 1, th - 1); ++y) {
+                const std::size_t row = static_cast<std::size_t>(y) * tw;
+                for (int x = std::max(tx - 1, 0); x <= std::min(tx + 1, tw - 1); ++x) {
+                    lo = std::min(lo, tileMin_[row + x]);
+                    hi = std::max(hi, tileMax_[row + x]);
+                }
+            }
+            const std::size_t i = static_cast<std::size_t>(ty) * tw + tx;
+            tileThr_[i] = static_cast<std::uint8_t>(lo + (hi - lo) / 2);
+            tileValid_[i] = hi - lo >= config_.minContrast ? 0xff : 0x00;
+        }
+    }
+
+    binary_.resize(static_cast<std::size_t>(w) * h);
+    rowThr_.assign(static_cast<std::size_t>(w), 0);
+    rowValid_.assign(static_cast<std::size_t>(w), 0);  // 不足一个分块的右侧列保持低对比
+    for (int ty = 0; ty < th; ++ty) {
+        const std::size_t tr = static_cast<std::size_t>(ty) * tw;
+        for (int tx = 0; tx < tw; ++tx) {
+            std::memset(rowThr_.data() + tx * kTile, tileThr_[tr + tx], kTile);
+            std::memset(rowValid_.data() + tx * kTile, tileValid_[tr + tx], kTile);
+        }
+        for (int r = 0; r < kTile; ++r) {
+            const int y = ty * kTile + r;
+            k.binarize(luma_ + static_cast<std::size_t>(y) * lumaStride_, rowThr_.data(), rowValid_.data(),
+                       binary_.data() + static_cast<std::size_t>(y) * w, w);
+        }
+    }
+    if (th * kTile < h) {
+        std::memset(binary_.data() + static_cast<std::size_t>(th) * kTile * w, kUnknown,
+                    static_cast<std::size_t>(h - th * kTile) * w);
+    }
+}
+
+void FiducialDetector::segment(int w, int h) {
+    std::uint8_t* bin = binary_.data();
+    const int minSide = config_.minTagPx;
+    for (int sy = 0; sy < h; ++sy) {
+        for (int sx = 0; sx < w; ++sx) {
+            if (bin[static_cast<std::size_t>(sy) * w + sx] != kBlack) continue;
+            // 8 邻接填充黑色连通域（标记为已访问），统计外接框
+            int x0 = sx, x1 = sx, y0 = sy, y1 = sy;
+            std::size_t area = 0;
+            stack_.clear();
+            stack_.push_back(sy * w + sx);
+            bin[static_cast<std::size_t>(sy) * w + sx] = kVisited;
+            while (!stack_.empty()) {
+                const int idx = stack_.back();
+                stack_.pop_back();
+                ++area;
+                const int x = idx % w, y = idx / w;
+                x0 = std::min(x0, x);
+                x1 = std::max(x1, x);
+                y0 = std::min(y0, y);
+                y1 = std::max(y1, y);
+                for (int d = 0; d < 8; ++d) {
+                    const int nx = x + kDx[d], ny = y + kDy[d];
+                    if (nx < 0 || ny < 0 || nx >= w || ny >= h) continue;
+                    std::uint8_t& v = bin[static_cast<std::size_t>(ny) * w + nx];
+                    if (v != kBlack) continue;
+                    v = kVisited;
+                    stack_.push_back(ny * w + nx);
+                }
+            }
+            // 贴搜索区域边界的连通域可能被截断，不作为候选
+            if (x0 == 0 || y0 == 0 || x1 == w - 1 || y1 == h - 1) continue;
+            if (x1 - x0 + 1 < minSide || y1 - y0 + 1 < minSide) continue;
+            if (area < static_cast<std::size_t>(2 * minSide)) continue;
+            // 种子是光栅序首个像素（最上行最左），外轮廓从此开始
+            if (!traceContour(sx, sy, w, h)) continue;
+            Quad quad;
+            if (!fitQuad(quad, w, h)) continue;
+            ++result_.candidates;
+            FiducialDetection det;
+            if (!decode(quad, det)) continue;
+            result_.detections.push_back(det);
+        }
+    }
+}
+
+bool FiducialDetector::traceContour(int sx, int sy, int w, int h) {
+    const std::uint8_t* bin = binary_.data();
+    auto dark = [&](int x, int y) {
+        return x >= 0 && y >= 0 && x < w && y < h && bin[static_cast<std::size_t>(y) * w + x] <= kVisited;
+    };
+    contour_.clear();
+    contour_.push_back({sx, sy});
+    int px = sx, py = sy;
+    int dir = 0;  // 视作自左侧向右进入起点（起点左侧与上方均非本连通域）
+    const std::size_t maxPoints = static_cast<std::size_t>(config_.maxContourPoints);
+    for (;;) {
+        // 从来向的下一个邻点起顺时针扫描
+        int nd = -1;
+        for (int k = 0; k < 8; ++k) {
+            const int d = (dir + 5 + k) & 7;
+            if (dark(px + kDx[d], py + kDy[d])) {
+                nd = d;
+                break;
+            }
+        }
+        if (nd < 0) return false;  // 孤立像素
+        const int qx = px + kDx[nd], qy = py + kDy[nd];
+        // 回到起点且下一步与首步相同时闭合（起点为割点时会多次经过）
+        if (px == sx && py == sy && contour_.size() > 1 && qx == contour_[1][0] && qy == contour_[1][1]) break;
+        px = qx;
+        py = qy;
+        dir = nd;
+        contour_.push_back({px, py});
+        if (contour_.size() > maxPoints) return false;
+    }
+    contour_.pop_back();  // 末点即起点
+    return contour_.size() >= static_cast<std::size_t>(4 * config_.minTagPx / 2);
+}
+
+bool FiducialDetector::fitQuad(Quad& quad, int w, int h) const {
+    const std::vector<std::array<int, 2>>& pts = contour_;
+    const std::size_t n = pts.size();
+    double cx = 0., cy = 0.;
+    for (const auto& p : pts) {
+        cx += p[0];
+        cy += p[1];
+    }
+    cx /= static_cast<double>(n);
+    cy /= static_cast<double>(n);
+
+    // 四个角：离质心最远点、离它最远点（对角），再在两段弧上各取离对角线最远的点
+    auto dist2 = [&](std::size_t i, double x, double y) {
+        const double dx = pts[i][0] - x, dy = pts[i][1] - y;
+        return dx * dx + dy * dy;
+    };
+    std::size_t i0 = 0;
+    for (std::size_t i = 1; i < n; ++i) {
+        if (dist2(i, cx, cy) > dist2(i0, cx, cy)) i0 = i;
+    }
+    std::size_t i2 = i0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (dist2(i, pts[i0][0], pts[i0][1]) > dist2(i2, pts[i0][0], pts[i0][1])) i2 = i;
+    }
+    if (i2 == i0) return false;
+    const double ax = pts[i0][0], ay = pts[i0][1];
+    const double bx = pts[i2][0] - ax, by = pts[i2][1] - ay;
+    auto farthest = [&](std::size_t from, std::size_t to) {
+        std::size_t best = from;
+        double bestD = -1.;
+        for (std::size_t i = (from + 1) % n; i != to; i = (i + 1) % n) {
+            const double d = std::fabs(bx * (pts[i][1] - ay) - by * (pts[i][0] - ax));
+            if (d > bestD) {
+                bestD = d;
+                best = i;
+            }
+        }
+        return best;
+    };
+    const std::size_t i1 = farthest(i0, i2);
+    const std::size_t i3 = farthest(i2, i0);
+    if (i1 == i0 || i3 == i2) return false;
+    const std::size_t idx[4] = {i0, i1, i2, i3};
+
+    // 每条边去掉靠近角点的 1/8 后拟合直线，沿外法向外移半像素（轮廓点为暗侧像素中心）
+    double lines[4][3];
+    for (int k = 0; k < 4; ++k) {
+        const std::size_t a = idx[k], b = idx[(k + 1) % 4];
+        const std::size_t len = (b + n - a) % n;
+        const std::size_t trim = std::max<std::size_t>(1, len / 8);
+        if (len < 2 * trim + 3) return false;
+        double nx, ny, c;
+        const double rms = fitLine(pts, (a + trim) % n, len - 2 * trim + 1, nx, ny, c);
+        if (rms > config_.maxLineRms) return false;
+        if (nx * cx + ny * cy > c) {
+            nx = -nx;
+            ny = -ny;
+            c = -c;
+        }
+        lines[k][0] = nx;
+        lines[k][1] = ny;
+        lines[k][2] = c + 0.5;
+    }
+    // 角 k 为边 k-1 与边 k 的交点
+    for (int k = 0; k < 4; ++k) {
+        const double* l0 = lines[(k + 3) % 4];
+        const double* l1 = lines[k];
+        const double det = l0[0] * l1[1] - l0[1] * l1[0];
+        if (std::fabs(det) < 1e-6) return false;
+        quad.c[k][0] = (l0[2] * l1[1] - l0[1] * l1[2]) / det;
+        quad.c[k][1] = (l0[0] * l1[2] - l0[2] * l1[0]) / det;
+        if (quad.c[k][0] < -1. || quad.c[k][1] < -1. || quad.c[k][0] > w || quad.c[k][1] > h) return false;
+    }
+    // 凸且各边不短于 minTagPx
+    const double minSide2 = static_cast<double>(config_.minTagPx) * config_.minTagPx;
+    for (int k = 0; k < 4; ++k) {
+        const auto& p0 = quad.c[k];
+        const auto& p1 = quad.c[(k + 1) % 4];
+        const auto& p2 = quad.c[(k + 2) % 4];
+        const double ex = p1[0] - p0[0], ey = p1[1] - p0[1];
+        if (ex * ex + ey * ey < minSide2) return false;
+        if (ex * (p2[1] - p1[1]) - ey * (p2[0] - p1[0]) <= 0.) return false;
+    }
+    return true;
+}
+
+bool FiducialDetector::decode(const Quad& quad, FiducialDetection& out) const {
+    if (rotatedCodes_.empty()) return false;
+    const int side = family_.side;
+    const int cells = side + 2;
+    const double tag[4][2] = {{0., 0.}, {double(cells), 0.}, {double(cells), double(cells)}, {0., double(cells)}};
+    const double img[4][2] = {{quad.c[0][0], quad.c[0][1]}, {quad.c[1][0], quad.c[1][1]},
+                              {quad.c[2][0], quad.c[2][1]}, {quad.c[3][0], quad.c[3][1]}};
+    double H[9];
+    if (!solveHomography(tag, img, H)) return false;
+    const int w = result_.searched.width, h = result_.searched.height;
+    auto sample = [&](double tx, double ty) {
+        double u, v;
+        applyHomography(H, tx, ty, u, v);
+        return sampleBilinear(luma_, lumaStride_, w, h, u, v);
+    };
+
+    // 边框格与外侧半格处的静区，取两者均值中点为阈值
+    float border[4 * 9];
+    int nb = 0;
+    double black = 0., white = 0.;
+    for (int i = 0; i < cells; ++i) {
+        for (int j = 0; j < cells; ++j) {
+            if (i != 0 && j != 0 && i != cells - 1 && j != cells - 1) continue;
+            const float v = sample(j + 0.5, i + 0.5);
+            border[nb++] = v;
+            black += v;
+        }
+    }
+    for (int k = 0; k < cells; ++k) {
+        white += sample(k + 0.5, -0.5) + sample(k + 0.5, cells + 0.5) + sample(-0.5, k + 0.5) +
+                 sample(cells + 0.5, k + 0.5);
+    }
+    black /= nb;
+    white /= 4. * cells;
+    if (white - black < config_.minContrast) return false;
+    const float thr = static_cast<float>(0.5 * (black + white));
+    int borderErrors = 0;
+    for (int i = 0; i < nb; ++i) borderErrors += border[i] > thr ? 1 : 0;
+    if (borderErrors > 1) return false;
+
+    std::uint64_t code = 0;
+    double margin = 0.;
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            const float v = sample(c + 1.5, r + 1.5);
+            code = (code << 1) | (v > thr ? 1ULL : 0ULL);
+            margin += std::fabs(v - thr);
+        }
+    }
+    margin /= side * side;
+    if (margin < config_.minDecisionMargin) return false;
+
+    int bestId = -1, bestRot = 0, bestHam = side * side + 1;
+    for (std::size_t id = 0; id < rotatedCodes_.size(); ++id) {
+        for (int rot = 0; rot < 4; ++rot) {
+            const int ham = popcount64(code ^ rotatedCodes_[id][rot]);
+            if (ham < bestHam) {
+                bestHam = ham;
+                bestId = static_cast<int>(id);
+                bestRot = rot;
+            }
+        }
+    }
+    if (bestId < 0 || bestHam > config_.maxHammingCorrect) return false;
+
+    // 观察到的是标记顺时针旋转 bestRot 次的样子：标记自身第 j 个角位于观察序的 (j + bestRot) % 4
+    out.id = bestId;
+    out.hamming = bestHam;
+    out.decisionMargin = static_cast<float>(margin);
+    for (int j = 0; j < 4; ++j) {
+        const auto& c = quad.c[(j + bestRot) % 4];
+        out.corners[j] = {static_cast<float>(c[0] + originX_), static_cast<float>(c[1] + originY_)};
+    }
+    double u, v;
+    applyHomography(H, 0.5 * cells, 0.5 * cells, u, v);
+    out.center = {static_cast<float>(u + originX_), static_cast<float>(v + originY_)};
+    computePose(out);
+    return true;
+}
+
+void FiducialDetector::computePose(FiducialDetection& det) const {
+    det.hasPose = false;
+    const double s = 0.5 * config_.tagSizeM;
+    if (config_.fx <= 0. || config_.fy <= 0. || s <= 0.) return;
+    // 标记系：原点在中心，x 右、y 下，z 指向标记背面（正对相机时与相机系同向）
+    const double obj[4][2] = {{-s, -s}, {s, -s}, {s, s}, {-s, s}};
+    double img[4][2];
+    for (int k = 0; k < 4; ++k) {
+        img[k][0] = det.corners[k][0];
+        img[k][1] = det.corners[k][1];
+    }
+    double H[9];
+    if (!solveHomography(obj, img, H)) return;
+    // K⁻¹H 的三列为 λ(r1, r2, t)
+    double m[3][3];
+    for (int j = 0; j < 3; ++j) {
+        m[0][j] = (H[j] - config_.cx * H[6 + j]) / config_.fx;
+        m[1][j] = (H[3 + j] - config_.cy * H[6 + j]) / config_.fy;
+        m[2][j] = H[6 + j];
+    }
+    const double n1 = std::sqrt(m[0][0] * m[0][0] + m[1][0] * m[1][0] + m[2][0] * m[2][0]);
+    const double n2 = std::sqrt(m[0][1] * m[0][1] + m[1][1] * m[1][1] + m[2][1] * m[2][1]);
+    if (n1 < 1e-12 || n2 < 1e-12) return;
+    double lambda = 2. / (n1 + n2);
+    if (m[2][2] < 0.) lambda = -lambda;  // 标记在相机前方
+    double r1[3], r2[3], r3[3];
+    for (int i = 0; i < 3; ++i) {
+        r1[i] = m[i][0] * lambda;
+        r2[i] = m[i][1] * lambda;
+        det.position[i] = m[i][2] * lambda;
+    }
+    // Gram-Schmidt 正交化
+    const double l1 = std::sqrt(r1[0] * r1[0] + r1[1] * r1[1] + r1[2] * r1[2]);
+    for (double& v : r1) v /= l1;
+    const double d = r1[0] * r2[0] + r1[1] * r2[1] + r1[2] * r2[2];
+    for (int i = 0; i < 3; ++i) r2[i] -= d * r1[i];
+    const double l2 = std::sqrt(r2[0] * r2[0] + r2[1] * r2[1] + r2[2] * r2[2]);
+    if (l2 < 1e-12) return;
+    for (double& v : r2) v /= l2;
+    r3[0] = r1[1] * r2[2] - r1[2] * r2[1];
+    r3[1] = r1[2] * r2[0] - r1[0] * r2[2];
+    r3[2] = r1[0] * r2[1] - r1[1] * r2[0];
+    for (int i = 0; i < 3; ++i) {
+        det.rotation[i * 3 + 0] = r1[i];
+        det.rotation[i * 3 + 1] = r2[i];
+        det.rotation[i * 3 + 2] = r3[i];
+    }
+    det.yaw = std::atan2(r1[1], r1[0]);
+    det.hasPose = true;
+}
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,355 @@
+#include "falconmind/sdk/perception/GeoProjection.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+using Mat3 = core::Matrix<double, 3, 3>;
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kEarthRadiusM = 6371000.0;
+constexpr double kDegPerM = 180.0 / (kPi * kEarthRadiusM);
+// 射线向下分量下限：低于该值视为指向地平线以上
+constexpr double kMinDown = 1e-6;
+// DEM 迭代收敛阈值（米）
+constexpr double kDemTolerance = 0.1;
+
+// ZYX 欧拉角（yaw-pitch-roll）→ 旋转矩阵
+Mat3 eulerZyx(double roll, double pitch, double yaw) {
+    const double cr = std::cos(roll), sr = std::sin(roll);
+    const double cp = std::cos(pitch), sp = std::sin(pitch);
+    const double cy = std::cos(yaw), sy = std::sin(yaw);
+    Mat3 r;
+    r(0, 0) = cy * cp;
+    r(0, 1) = cy * sp * sr - sy * cr;
+    r(0, 2) = cy * sp * cr + sy * sr;
+    r(1, 0) = sy * cp;
+    r(1, 1) = sy * sp * sr + cy * cr;
+    r(1, 2) = sy * sp * cr - cy * sr;
+    r(2, 0) = -sp;
+    r(2, 1) = cp * sr;
+    r(2, 2) = cp * cr;
+    return r;
+}
+
+double wrapAngle(double a) {
+    while (a > kPi) a -= 2. * kPi;
+    while (a < -kPi) a += 2. * kPi;
+    return a;
+}
+
+double lerp(double a, double b, double w) {
+    return a + (b - a) * w;
+}
+
+double lerpAngle(double a, double b, double w) {
+    return wrapAngle(a + wrapAngle(b - a) * w);
+}
+
+// 在按时间戳升序的缓冲中找 ts 两侧的样本；gap 超限返回 false
+template <typename Buffer, typename TsOf>
+bool bracket(const Buffer& buf, std::uint64_t ts, std::uint64_t maxGap, TsOf tsOf, std::size_t& i0,
+             std::size_t& i1, double& w) {
+    if (buf.empty()) return false;
+    auto it = std::lower_bound(buf.begin(), buf.end(), ts,
+                               [&](const auto& e, std::uint64_t t) { return tsOf(e) < t; });
+    if (it == buf.end()) {
+        i0 = i1 = buf.size() - 1;
+        w = 0.;
+        return ts - tsOf(buf.back()) <= maxGap;
+    }
+    i1 = static_cast<std::size_t>(it - buf.begin());
+    if (tsOf(*it) == ts || i1 == 0) {
+        i0 = i1;
+        w = 0.;
+        return tsOf(*it) - ts <= maxGap;
+    }
+    i0 = i1 - 1;
+    const std::uint64_t t0 = tsOf(buf[i0]);
+    const std::uint64_t t1 = tsOf(buf[i1]);
+    if (t1 - t0 > maxGap) return false;
+    w = static_cast<double>(ts - t0) / static_cast<double>(t1 - t0);
+    return true;
+}
+
+// 单条射线（NED，不要求归一化）与地面求交
+bool intersectGround(double rn, double re, double rd, const flight::FlightState& vehicle, double cosLat,
+                     double nadirHeight, const GroundElevationModel& ground, int maxIterations, double maxRange,
+                     double& lat, double& lon, double& alt, double& range) {
+    if (rd <= kMinDown) return false;
+    double h = nadirHeight;
+    double t = 0.;
+    for (int it = 0; it < maxIterations; ++it) {
+        t = (vehicle.alt - h) / rd;
+        if (t <= 0.) return false;
+        lat = vehicle.lat + t * rn * kDegPerM;
+        lon = vehicle.lon + t * re * kDegPerM / cosLat;
+        alt = h;
+        if (!ground.hasGrid()) break;
+        const double next = ground.heightAt(lat, lon);
+        if (std::fabs(next - h) < kDemTolerance) break;
+        h = next;
+    }
+    range = t * std::sqrt(rn * rn + re * re + rd * rd);
+    return range <= maxRange;
+}
+
+} // namespace
+
+CameraIntrinsics CameraIntrinsics::fromHorizontalFov(int width, int height, double hfovDeg) {
+    CameraIntrinsics k;
+    k.fx = k.fy = 0.5 * width / std::tan(0.5 * hfovDeg * kPi / 180.0);
+    k.cx = 0.5 * width;
+    k.cy = 0.5 * height;
+    return k;
+}
+
+bool GroundElevationModel::setGrid(double originLat, double originLon, double latSpacingDeg, double lonSpacingDeg,
+                                   int rows, int cols, std::vector<float> heights) {
+    if (rows < 2 || cols < 2 || !(latSpacingDeg > 0.) || !(lonSpacingDeg > 0.) ||
+        heights.size() != static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols)) {
+        std::cerr << "[GroundElevationModel] invalid DEM grid " << rows << "x" << cols << std::endl;
+        return false;
+    }
+    originLat_ = originLat;
+    originLon_ = originLon;
+    latSpacing_ = latSpacingDeg;
+    lonSpacing_ = lonSpacingDeg;
+    rows_ = rows;
+    cols_ = cols;
+    grid_ = std::move(heights);
+    return true;
+}
+
+double GroundElevationModel::heightAt(double lat, double lon) const {
+    float h = 0.f;
+    if (terrain_ && terrain_->height(lat, lon, h)) return h;
+    if (grid_.empty()) return flatHeight_;
+    const double fr = (lat - originLat_) / latSpacing_;
+    const double fc = (lon - originLon_) / lonSpacing_;
+    if (!(fr >= 0.) || !(fc >= 0.) || fr > rows_ - 1 || fc > cols_ - 1) return flatHeight_;
+    const int r0 = std::min(static_cast<int>(fr), rows_ - 2);
+    const int c0 = std::min(static_cast<int>(fc), cols_ - 2);
+    const double wr = fr - r0;
+    const double wc = fc - c0;
+    const float* p = grid_.data() + static_cast<std::size_t>(r0) * cols_ + c0;
+    const double top = lerp(p[0], p[1], wc);
+    const double bottom = lerp(p[cols_], p[cols_ + 1], wc);
+    return lerp(top, bottom, wr);
+}
+
+void GeoProjector::setIntrinsics(const CameraIntrinsics& intrinsics) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    intrinsics_ = intrinsics;
+}
+
+void GeoProjector::setCameraMount(const GimbalPose& mount) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    mount_ = mount;
+}
+
+void GeoProjector::setGround(GroundElevationModel ground) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ground_ = std::move(ground);
+}
+
+void GeoProjector::setHistoryCapacity(std::size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    historyCapacity_ = n > 0 ? n : 1;
+    while (states_.size() > historyCapacity_) states_.pop_front();
+    while (gimbals_.size() > historyCapacity_) gimbals_.pop_front();
+}
+
+void GeoProjector::pushFlightState(const flight::FlightState& state, std::uint64_t timestampNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // 乱序样本直接丢弃，保证缓冲按时间戳升序
+    if (!states_.empty() && timestampNs <= states_.back().timestampNs) return;
+    states_.push_back(TimedState{timestampNs, state});
+    if (states_.size() > historyCapacity_) states_.pop_front();
+}
+
+void GeoProjector::pushGimbalPose(const GimbalPose& pose) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!gimbals_.empty() && pose.timestampNs <= gimbals_.back().timestampNs) return;
+    gimbals_.push_back(pose);
+    if (gimbals_.size() > historyCapacity_) gimbals_.pop_front();
+}
+
+bool GeoProjector::stateAt(std::uint64_t ts, flight::FlightState& out) const {
+    std::size_t i0 = 0, i1 = 0;
+    double w = 0.;
+    if (!bracket(states_, ts, maxSyncGapNs_, [](const TimedState& s) { return s.timestampNs; }, i0, i1, w)) {
+        return false;
+    }
+    const flight::FlightState& a = states_[i0].state;
+    const flight::FlightState& b = states_[i1].state;
+    out = w < 0.5 ? a : b;  // 非位姿字段取最近样本
+    out.lat = lerp(a.lat, b.lat, w);
+    out.lon = lerp(a.lon, b.lon, w);
+    out.alt = lerp(a.alt, b.alt, w);
+    out.roll = lerpAngle(a.roll, b.roll, w);
+    out.pitch = lerpAngle(a.pitch, b.pitch, w);
+    out.yaw = lerpAngle(a.yaw, b.yaw, w);
+    out.vx = lerp(a.vx, b.vx, w);
+    out.vy = lerp(a.vy, b.vy, w);
+    out.vz = lerp(a.vz, b.vz, w);
+    return true;
+}
+
+bool GeoProjector::gimbalAt(std::uint64_t ts, GimbalPose& out) const {
+    std::size_t i0 = 0, i1 = 0;
+    double w = 0.;
+    if (!bracket(gimbals_, ts, maxSyncGapNs_, [](const GimbalPose& g) { return g.timestampNs; }, i0, i1, w)) {
+        return false;
+    }
+    const GimbalPose& a = gimbals_[i0];
+    const GimbalPose& b = gimbals_[i1];
+    out.roll = lerpAngle(a.roll, b.roll, w);
+    out.pitch = lerpAngle(a.pitch, b.pitch, w);
+    out.yaw = lerpAngle(a.yaw, b.yaw, w);
+    out.timestampNs = ts;
+    return true;
+}
+
+GeoProjector::Mat3 GeoProjector::cameraToNed(const flight::FlightState& vehicle, const GimbalPose& gimbal) {
+    // 相机光学系（x 右、y 下、z 前）→ 云台 FRD 系
+    Mat3 opticalToGimbal = Mat3::zero();
+    opticalToGimbal(0, 2) = 1.;
+    opticalToGimbal(1, 0) = 1.;
+    opticalToGimbal(2, 1) = 1.;
+    return eulerZyx(vehicle.roll, vehicle.pitch, vehicle.yaw) * eulerZyx(gimbal.roll, gimbal.pitch, gimbal.yaw) *
+           opticalToGimbal;
+}
+
+void GeoProjector::projectBatch(std::size_t n, const flight::FlightState& vehicle, const GimbalPose& gimbal) {
+    const Mat3 r = cameraToNed(vehicle, gimbal);
+    rn_.resize(n);
+    re_.resize(n);
+    rd_.resize(n);
+    lat_.resize(n);
+    lon_.resize(n);
+    alt_.resize(n);
+    range_.resize(n);
+    ok_.resize(n);
+
+    // 归一化像素坐标 → NED 射线：固定系数的结构数组循环，编译器可向量化
+    const double ifx = 1. / intrinsics_.fx;
+    const double ify = 1. / intrinsics_.fy;
+    const double cx = intrinsics_.cx, cy = intrinsics_.cy;
+    for (std::size_t i = 0; i < n; ++i) {
+        const double x = (u_[i] - cx) * ifx;
+        const double y = (v_[i] - cy) * ify;
+        rn_[i] = r(0, 0) * x + r(0, 1) * y + r(0, 2);
+        re_[i] = r(1, 0) * x + r(1, 1) * y + r(1, 2);
+        rd_[i] = r(2, 0) * x + r(2, 1) * y + r(2, 2);
+    }
+
+    const double cosLat = std::max(1e-6, std::cos(vehicle.lat * kPi / 180.0));
+    const double nadirHeight = ground_.heightAt(vehicle.lat, vehicle.lon);
+    for (std::size_t i = 0; i < n; ++i) {
+        ok_[i] = intersectGround(rn_[i], re_[i], rd_[i], vehicle, cosLat, nadirHeight, ground_, maxDemIterations_,
+                                 maxRangeM_, lat_[i], lon_[i], alt_[i], range_[i]);
+    }
+}
+
+bool GeoProjector::projectPixel(double u, double v, const flight::FlightState& vehicle, const GimbalPose& gimbal,
+                                double& lat, double& lon, double& alt) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!(intrinsics_.fx > 0.) || !(intrinsics_.fy > 0.)) return false;
+    const Mat3 r = cameraToNed(vehicle, gimbal);
+    const double x = (u - intrinsics_.cx) / intrinsics_.fx;
+    const double y = (v - intrinsics_.cy) / intrinsics_.fy;
+    const double cosLat = std::max(1e-6, std::cos(vehicle.lat * kPi / 180.0));
+    double range = 0.;
+    return intersectGround(r(0, 0) * x + r(0, 1) * y + r(0, 2), r(1, 0) * x + r(1, 1) * y + r(1, 2),
+                           r(2, 0) * x + r(2, 1) * y + r(2, 2), vehicle, cosLat,
+                           ground_.heightAt(vehicle.lat, vehicle.lon), ground_, maxDemIterations_, maxRangeM_, lat,
+                           lon, alt, range);
+}
+
+bool GeoProjector::liftPixel(double u, double v, double depthM, const flight::FlightState& vehicle,
+                             const GimbalPose& gimbal, double& lat, double& lon, double& alt) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!(intrinsics_.fx > 0.) || !(intrinsics_.fy > 0.) || !(depthM > 0.)) return false;
+    const Mat3 r = cameraToNed(vehicle, gimbal);
+    // 光学系中的点为 depth × (x, y, 1)
+    const double x = (u - intrinsics_.cx) / intrinsics_.fx;
+    const double y = (v - intrinsics_.cy) / intrinsics_.fy;
+    const double n = depthM * (r(0, 0) * x + r(0, 1) * y + r(0, 2));
+    const double e = depthM * (r(1, 0) * x + r(1, 1) * y + r(1, 2));
+    const double d = depthM * (r(2, 0) * x + r(2, 1) * y + r(2, 2));
+    const double cosLat = std::max(1e-6, std::cos(vehicle.lat * kPi / 180.0));
+    lat = vehicle.lat + n * kDegPerM;
+    lon = vehicle.lon + e * kDegPerM / cosLat;
+    alt = vehicle.alt - d;
+    return std::sqrt(n * n + e * e + d * d) <= maxRangeM_;
+}
+
+bool GeoProjector::project(const TrackingResult& tracks, GeoTrackingResult& out) {
+    flight::FlightState vehicle;
+    GimbalPose gimbal;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stateAt(tracks.timestampNs, vehicle)) {
+            out.tracks.clear();
+            return false;
+        }
+        if (!gimbalAt(tracks.timestampNs, gimbal)) gimbal = mount_;
+    }
+    return project(tracks, vehicle, gimbal, out);
+}
+
+bool GeoProjector::project(const TrackingResult& tracks, const flight::FlightState& vehicle,
+                           const GimbalPose& gimbal, GeoTrackingResult& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    out.frameId = tracks.frameId;
+    out.timestampNs = tracks.timestampNs;
+    out.frameIndex = tracks.frameIndex;
+    out.vehicle = vehicle;
+    out.gimbal = gimbal;
+    out.tracks.resize(tracks.tracks.size());
+    if (!(intrinsics_.fx > 0.) || !(intrinsics_.fy > 0.)) {
+        std::cerr << "[GeoProjector] camera intrinsics not set" << std::endl;
+        for (auto& g : out.tracks) g.valid = false;
+        return false;
+    }
+
+    // 收集各轨迹最新框的底边中点
+    u_.clear();
+    v_.clear();
+    trackOf_.clear();
+    for (std::size_t i = 0; i < tracks.tracks.size(); ++i) {
+        const TrackingState& t = tracks.tracks[i];
+        GeoTrack& g = out.tracks[i];
+        g.trackId = t.trackId;
+        g.classId = t.targetClassId;
+        g.className = t.targetClassName;
+        g.status = t.status;
+        g.valid = false;
+        const TrackHistoryPoint* p = !t.history.empty() ? &t.history.back()
+                                     : !t.trajectory.empty() ? &t.trajectory.back() : nullptr;
+        if (!p) continue;
+        g.bbox = p->bbox;
+        u_.push_back(p->bbox.x + p->bbox.width * 0.5);
+        v_.push_back(p->bbox.y + p->bbox.height);
+        trackOf_.push_back(static_cast<int>(i));
+    }
+
+    projectBatch(u_.size(), vehicle, gimbal);
+    for (std::size_t k = 0; k < trackOf_.size(); ++k) {
+        GeoTrack& g = out.tracks[static_cast<std::size_t>(trackOf_[k])];
+        g.valid = ok_[k] != 0;
+        if (!g.valid) continue;
+        g.lat = lat_[k];
+        g.lon = lon_[k];
+        g.alt = alt_[k];
+        g.rangeM = range_[k];
+    }
+    return true;
+}
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,140 @@
+#include "falconmind/sdk/perception/InferenceRateController.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+namespace falconmind::sdk::perception {
+
+using core::PixelFormat;
+
+InferenceRateController::InferenceRateController(InferenceRateConfig config) : config_(std::move(config)) {
+    config_.baseInterval = std::max(1, config_.baseInterval);
+}
+
+void InferenceRateController::setBaseInterval(int interval) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_.baseInterval = std::max(1, interval);
+}
+
+int InferenceRateController::baseInterval() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_.baseInterval;
+}
+
+bool InferenceRateController::sampleLuma(const ImageView& image) {
+    int bpp = 0;  // 每像素字节数；RGB/BGR 取三通道加权和，NV12/YUYV 直接取 Y
+    switch (image.format) {
+        case PixelFormat::RGB8:
+        case PixelFormat::BGR8: bpp = 3; break;
+        case PixelFormat::NV12: bpp = 1; break;  // Y 平面在前
+        case PixelFormat::YUYV: bpp = 2; break;  // Y0 U Y1 V
+        default: return false;
+    }
+    if (!image.data || image.width <= 0 || image.height <= 0) return false;
+    const int stride = image.stride > 0 ? image.stride : image.width * bpp;
+    gridW_ = (image.width + kMotionStep - 1) / kMotionStep;
+    gridH_ = (image.height + kMotionStep - 1) / kMotionStep;
+    luma_.resize(static_cast<std::size_t>(gridW_) * gridH_);
+    for (int gy = 0; gy < gridH_; ++gy) {
+        const std::uint8_t* row = image.data + static_cast<std::size_t>(gy) * kMotionStep * stride;
+        std::uint8_t* dst = &luma_[static_cast<std::size_t>(gy) * gridW_];
+        for (int gx = 0; gx < gridW_; ++gx) {
+            const std::uint8_t* p = row + static_cast<std::size_t>(gx) * kMotionStep * bpp;
+            dst[gx] = bpp == 3 ? static_cast<std::uint8_t>((p[0] + 2 * p[1] + p[2]) >> 2) : p[0];
+        }
+    }
+    return true;
+}
+
+float InferenceRateController::motionScore() const {
+    if (refLuma_.size() != luma_.size() || luma_.empty()) return 255.f;  // 尺寸变化视为全画面变化
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < luma_.size(); ++i) {
+        sum += static_cast<std::uint64_t>(std::abs(static_cast<int>(luma_[i]) - refLuma_[i]));
+    }
+    return static_cast<float>(sum) / static_cast<float>(luma_.size());
+}
+
+bool InferenceRateController::shouldDetect(const ImageView& image) {
+    const bool sampled = config_.motionThreshold > 0.f && sampleLuma(image);
+    const float motion = sampled ? motionScore() : 0.f;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    lastMotion_ = motion;
+    DetectTrigger trigger = std::exchange(pending_, DetectTrigger::None);
+    if (trigger == DetectTrigger::None) {
+        if (sinceDetect_ + 1 >= config_.baseInterval) {
+            trigger = DetectTrigger::Interval;
+        } else if (sampled && motion > config_.motionThreshold) {
+            trigger = DetectTrigger::Motion;
+        }
+    }
+    lastTrigger_ = trigger;
+    if (trigger == DetectTrigger::None) {
+        ++sinceDetect_;
+        ++predicted_;
+        return false;
+    }
+    sinceDetect_ = 0;
+    ++detected_;
+    ++triggers_[static_cast<std::size_t>(trigger)];
+    if (sampled) refLuma_ = luma_;
+    return true;
+}
+
+void InferenceRateController::observeTracks(const TrackingResult& tracks) {
+    DetectTrigger trigger = DetectTrigger::None;
+    for (const auto& t : tracks.tracks) {
+        if (t.status == "LOST") {
+            if (config_.detectOnTrackLost) {
+                trigger = DetectTrigger::TrackLost;
+                break;
+            }
+        } else if (t.uncertainty > config_.maxTrackUncertainty) {
+            trigger = DetectTrigger::Uncertainty;
+        }
+    }
+    if (trigger == DetectTrigger::None) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_ == DetectTrigger::None) pending_ = trigger;
+}
+
+void InferenceRateController::requestDetection() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ = DetectTrigger::Requested;
+}
+
+void InferenceRateController::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ = DetectTrigger::First;
+    sinceDetect_ = 0;
+}
+
+DetectTrigger InferenceRateController::lastTrigger() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastTrigger_;
+}
+
+std::uint64_t InferenceRateController::detectedFrames() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return detected_;
+}
+
+std::uint64_t InferenceRateController::predictedFrames() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return predicted_;
+}
+
+std::uint64_t InferenceRateController::triggerCount(DetectTrigger trigger) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto i = static_cast<std::size_t>(trigger);
+    return i < triggers_.size() ? triggers_[i] : 0;
+}
+
+float InferenceRateController::lastMotion() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastMotion_;
+}
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,324 @@
+#include "falconmind/sdk/perception/Int8Calibration.h"
+#include "falconmind/sdk/core/CaptureFile.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/perception/DetectionNode.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr int kThumbSide = 16;
+constexpr const char* kManifest = "calibration.json";
+constexpr const char* kDatasetList = "dataset.txt";
+constexpr const char* kCache = "calibration.cache";
+
+// 16×16 网格采样的亮度缩略图（RGB/BGR 取三通道均值，NV12/YUYV 取 Y），只用于去重与统计
+bool lumaThumbnail(const ImageView& image, std::array<std::uint8_t, 256>& thumb) {
+    const core::PixelFormat format =
+        image.format != core::PixelFormat::Any ? image.format : core::parsePixelFormat(image.pixelFormat);
+    if (!image.data || image.width <= 0 || image.height <= 0) return false;
+    const int stride = image.stride > 0 ? image.stride : core::pixelFormatMinStride(format, image.width);
+    for (int ty = 0; ty < kThumbSide; ++ty) {
+        const int y = (2 * ty + 1) * image.height / (2 * kThumbSide);
+        const std::uint8_t* row = image.data + static_cast<std::size_t>(y) * stride;
+        for (int tx = 0; tx < kThumbSide; ++tx) {
+            const int x = (2 * tx + 1) * image.width / (2 * kThumbSide);
+            int v;
+            switch (format) {
+            case core::PixelFormat::RGB8:
+            case core::PixelFormat::BGR8:
+                v = (row[3 * x] + row[3 * x + 1] + row[3 * x + 2]) / 3;
+                break;
+            case core::PixelFormat::NV12: v = row[x]; break;
+            case core::PixelFormat::YUYV: v = row[2 * x]; break;
+            default: return false;
+            }
+            thumb[static_cast<std::size_t>(ty * kThumbSide + tx)] = static_cast<std::uint8_t>(v);
+        }
+    }
+    return true;
+}
+
+float thumbDifference(const std::array<std::uint8_t, 256>& a, const std::array<std::uint8_t, 256>& b) {
+    int sum = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) sum += std::abs(int(a[i]) - int(b[i]));
+    return static_cast<float>(sum) / static_cast<float>(a.size());
+}
+
+std::vector<std::size_t> tensorShape(const InputTensorSpec& spec) {
+    const auto w = static_cast<std::size_t>(spec.width);
+    const auto h = static_cast<std::size_t>(spec.height);
+    if (spec.layout == TensorLayout::NHWC) return {h, w, 3};
+    return {1, 3, h, w};
+}
+
+// NumPy .npy v1.0：魔数 + 头长度（小端 uint16）+ 以换行结尾、补齐到 64 字节的字典
+bool writeNpy(const std::string& path, const InputTensorSpec& spec, const void* data, std::size_t bytes) {
+    std::ostringstream dict;
+    dict << "{'descr': '" << (spec.type == TensorElementType::Uint8 ? "|u1" : "<f4")
+         << "', 'fortran_order': False, 'shape': (";
+    for (std::size_t d : tensorShape(spec)) dict << d << ", ";
+    dict << "), }";
+    std::string header = dict.str();
+    const std::size_t unpadded = 10 + header.size() + 1;
+    header.append((64 - unpadded % 64) % 64, ' ');
+    header.push_back('\n');
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    const std::uint16_t len = static_cast<std::uint16_t>(header.size());
+    const char prefix[8] = {'\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0};
+    out.write(prefix, sizeof(prefix));
+    const char lenBytes[2] = {static_cast<char>(len & 0xff), static_cast<char>(len >> 8)};
+    out.write(lenBytes, 2);
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    return static_cast<bool>(out);
+}
+
+// 读取 writeNpy 写出的文件的数据部分（只校验魔数与长度）
+bool readNpy(const std::string& path, void* dst, std::size_t bytes) {
+    std::ifstream in(path, std::ios::binary);
+    char prefix[10];
+    if (!in.read(prefix, sizeof(prefix)) || prefix[0] != '\x93' || prefix[1] != 'N' || prefix[6] != 1) return false;
+    const std::size_t headerLen = static_cast<unsigned char>(prefix[8]) | (static_cast<unsigned char>(prefix[9]) << 8);
+    in.seekg(static_cast<std::streamoff>(sizeof(prefix) + headerLen));
+    return static_cast<bool>(in.read(static_cast<char*>(dst), static_cast<std::streamsize>(bytes)));
+}
+
+const char* backendName(DetectionBackendType type) {
+    switch (type) {
+    case DetectionBackendType::OnnxRuntime: return "onnxruntime";
+    case DetectionBackendType::Rknn:        return "rknn";
+    case DetectionBackendType::TensorRt:    return "tensorrt";
+    case DetectionBackendType::CpuReference:return "cpu";
+    default:                                return "unknown";
+    }
+}
+
+} // namespace
+
+Int8CalibrationDataset::Int8CalibrationDataset(const DetectorDescriptor& desc, CalibrationOptions options)
+    : desc_(desc), options_(options), spec_(calibrationTensorSpec(desc)),
+      preprocessor_(std::make_unique<YoloPreprocessor>(yoloPreprocessConfig(desc))) {}
+
+Int8CalibrationDataset::~Int8CalibrationDataset() = default;
+
+InputTensorSpec Int8CalibrationDataset::calibrationTensorSpec(const DetectorDescriptor& desc) {
+    InputTensorSpec spec;
+    spec.width = desc.inputWidth > 0 ? desc.inputWidth : 640;
+    spec.height = desc.inputHeight > 0 ? desc.inputHeight : 640;
+    if (desc.backendType == DetectionBackendType::Rknn) {
+        spec.type = TensorElementType::Uint8;
+        spec.layout = TensorLayout::NHWC;
+    } else {
+        spec.type = TensorElementType::Float32;
+        spec.layout = TensorLayout::NCHW;
+    }
+    return spec;
+}
+
+std::size_t Int8CalibrationDataset::addCapture(const std::string& path) {
+    auto reader = core::CaptureReader::open(path);
+    if (!reader) {
+        FM_LOG_WARN("Int8Calibration", "cannot open capture file ", path);
+        return 0;
+    }
+    const std::size_t captureIndex = captures_.size();
+    std::size_t added = 0;
+    std::size_t skipped = 0;
+    std::array<std::uint8_t, 256> thumb{};
+    for (std::size_t i = 0; i < reader->size(); ++i) {
+        ImageView view;
+        if (!makeCameraImageView(reader->buffer(i), core::PixelFormat::Any, view) ||
+            !YoloPreprocessor::supportsPixelFormat(view.format) || !lumaThumbnail(view, thumb)) {
+            ++skipped;
+            continue;
+        }
+        if (haveThumb_ && options_.minFrameDifference > 0.f &&
+            thumbDifference(thumb, lastThumb_) < options_.minFrameDifference) {
+            continue;
+        }
+        int sum = 0;
+        for (std::uint8_t v : thumb) sum += v;
+        candidates_.push_back(Candidate{captureIndex, i, static_cast<float>(sum) / static_cast<float>(thumb.size())});
+        lastThumb_ = thumb;
+        haveThumb_ = true;
+        ++added;
+    }
+    if (skipped > 0) {
+        FM_LOG_INFO("Int8Calibration", path, ": ", skipped, " record(s) are not supported camera frames, skipped");
+    }
+    if (added > 0) captures_.push_back(std::move(reader));
+    return added;
+}
+
+std::vector<std::size_t> Int8CalibrationDataset::selection() const {
+    std::vector<std::size_t> picked;
+    const std::size_t n = candidates_.size();
+    const std::size_t want = options_.maxFrames > 0 ? std::min(options_.maxFrames, n) : n;
+    picked.reserve(want);
+    // 在去重后的候选中按时间均匀抽取：覆盖起飞、巡航、不同高度与光照的各任务阶段
+    for (std::size_t k = 0; k < want; ++k) picked.push_back(k * n / want);
+    return picked;
+}
+
+std::vector<CalibrationFrame> Int8CalibrationDataset::selectedFrames() const {
+    std::vector<CalibrationFrame> frames;
+    for (std::size_t index : selection()) {
+        const Candidate& c = candidates_[index];
+        const auto& reader = captures_[c.capture];
+        CalibrationFrame f;
+        f.source = reader->path();
+        f.record = c.record;
+        f.timestampNs = reader->record(c.record).meta.timestampNs;
+        f.meanLuma = c.meanLuma;
+        frames.push_back(std::move(f));
+    }
+    return frames;
+}
+
+bool Int8CalibrationDataset::tensor(std::size_t selectedIndex, void* dst) {
+    const auto picked = selection();
+    if (selectedIndex >= picked.size() || !dst) return false;
+    const Candidate& c = candidates_[picked[selectedIndex]];
+    // BufferRef 持有映射，前处理期间像素有效
+    const core::BufferRef buffer = captures_[c.capture]->buffer(c.record);
+    ImageView view;
+    LetterboxTransform transform;
+    return makeCameraImageView(buffer, core::PixelFormat::Any, view) &&
+           preprocessor_->run(view, spec_, dst, transform);
+}
+
+std::size_t Int8CalibrationDataset::write(const std::string& outputDir) {
+    std::error_code ec;
+    fs::create_directories(outputDir, ec);
+    if (!fs::is_directory(outputDir, ec)) {
+        FM_LOG_ERROR("Int8Calibration", "cannot create output directory ", outputDir);
+        return 0;
+    }
+    const fs::path dir = fs::absolute(outputDir, ec);
+    // 旧的帧与校准表对应旧的数据集，一并清除
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        const std::string name = entry.path().filename().string();
+        if ((name.rfind("calib_", 0) == 0 && entry.path().extension() == ".npy") || name == kDatasetList ||
+            name == kManifest || name == kCache) {
+            fs::remove(entry.path(), ec);
+        }
+    }
+
+    const auto frames = selectedFrames();
+    std::vector<std::uint8_t> buffer(inputTensorBytes(spec_));
+    std::ofstream list(dir / kDatasetList, std::ios::trunc);
+    nlohmann::json manifest;
+    manifest["detector_id"] = desc_.detectorId;
+    manifest["backend"] = backendName(desc_.backendType);
+    manifest["model_path"] = desc_.modelPath;
+    manifest["input_width"] = spec_.width;
+    manifest["input_height"] = spec_.height;
+    manifest["layout"] = spec_.layout == TensorLayout::NHWC ? "nhwc" : "nchw";
+    manifest["dtype"] = spec_.type == TensorElementType::Uint8 ? "uint8" : "float32";
+    manifest["letterbox"] = desc_.letterbox;
+    manifest["letterbox_pad_value"] = desc_.letterboxPadValue;
+    if (desc_.backendType == DetectionBackendType::Rknn) {
+        // rknn.config(mean_values=..., std_values=...) 须与运行时查表使用的参数一致
+        manifest["rknn_mean_values"] = {desc_.inputMean, desc_.inputMean, desc_.inputMean};
+        manifest["rknn_std_values"] = {desc_.inputStd, desc_.inputStd, desc_.inputStd};
+    }
+    manifest["frames"] = nlohmann::json::array();
+
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        if (!tensor(i, buffer.data())) {
+            FM_LOG_WARN("Int8Calibration", "preprocess failed: ", frames[i].source, " #", frames[i].record);
+            continue;
+        }
+        char name[32];
+        std::snprintf(name, sizeof(name), "calib_%04zu.npy", written);
+        const fs::path file = dir / name;
+        if (!writeNpy(file.string(), spec_, buffer.data(), buffer.size())) {
+            FM_LOG_ERROR("Int8Calibration", "cannot write ", file.string());
+            break;
+        }
+        list << file.string() << "\n";
+        manifest["frames"].push_back({{"file", name},
+                                      {"source", frames[i].source},
+                                      {"record", frames[i].record},
+                                      {"timestamp_ns", frames[i].timestampNs},
+                                      {"mean_luma", frames[i].meanLuma}});
+        ++written;
+    }
+    list.close();
+    std::ofstream(dir / kManifest, std::ios::trunc) << manifest.dump(2) << "\n";
+    FM_LOG_INFO("Int8Calibration", desc_.detectorId, ": wrote ", written, " calibration frame(s) of ",
+                candidates_.size(), " candidate(s) to ", dir.string());
+    return written;
+}
+
+bool Int8CalibrationStream::open(const std::string& datasetDir) {
+    dir_ = datasetDir;
+    files_.clear();
+    cursor_ = 0;
+    std::ifstream in(fs::path(datasetDir) / kManifest);
+    if (!in) return false;
+    nlohmann::json manifest;
+    try {
+        in >> manifest;
+        spec_.width = manifest.at("input_width").get<int>();
+        spec_.height = manifest.at("input_height").get<int>();
+        spec_.layout = manifest.at("layout").get<std::string>() == "nhwc" ? TensorLayout::NHWC : TensorLayout::NCHW;
+        spec_.type = manifest.at("dtype").get<std::string>() == "uint8" ? TensorElementType::Uint8
+                                                                          : TensorElementType::Float32;
+        for (const auto& frame : manifest.at("frames")) {
+            files_.push_back((fs::path(datasetDir) / frame.at("file").get<std::string>()).string());
+        }
+    } catch (const std::exception& e) {
+        FM_LOG_ERROR("Int8Calibration", "invalid ", kManifest, " in ", datasetDir, ": ", e.what());
+        files_.clear();
+        return false;
+    }
+    return spec_.width > 0 && spec_.height > 0;
+}
+
+std::size_t Int8CalibrationStream::nextBatch(void* dst, std::size_t batchSize) {
+    const std::size_t bytes = inputTensorBytes(spec_);
+    std::size_t n = 0;
+    while (n < batchSize && cursor_ < files_.size()) {
+        const std::string& file = files_[cursor_++];
+        if (!readNpy(file, static_cast<std::uint8_t*>(dst) + n * bytes, bytes)) {
+            FM_LOG_WARN("Int8Calibration", "cannot read ", file);
+            continue;
+        }
+        ++n;
+    }
+    return n;
+}
+
+std::string Int8CalibrationStream::cachePath() const {
+    return (fs::path(dir_) / kCache).string();
+}
+
+std::vector<char> Int8CalibrationStream::readCache() const {
+    std::ifstream in(cachePath(), std::ios::binary);
+    return std::vector<char>((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+bool Int8CalibrationStream::writeCache(const void* data, std::size_t size) const {
+    std::ofstream out(cachePath(), std::ios::binary | std::ios::trunc);
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    return static_cast<bool>(out);
+}
+
+} // namespace falconmind::sdk::perception
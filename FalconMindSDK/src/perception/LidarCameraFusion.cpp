@@ -0,0 +1,269 @@
+#include "falconmind/sdk/perception/LidarCameraFusion.h"
+#include "falconmind/sdk/core/CpuFeatures.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+// n 个点经 3×4 投影矩阵 P：u = (P0·p) / w，v = (P1·p) / w，w = P2·p（光轴深度）；w ≤ 0 时 u / v 无意义，由调用方按深度剔除
+using ProjectFn = void (*)(const float* x, const float* y, const float* z, std::size_t n, const float* P, float* u,
+                           float* v, float* w);
+
+void projectScalar(const float* x, const float* y, const float* z, std::size_t n, const float* P, float* u, float* v,
+                   float* w) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const float pu = P[0] * x[i] + P[1] * y[i] + P[2] * z[i] + P[3];
+        const float pv = P[4] * x[i] + P[5] * y[i] + P[6] * z[i] + P[7];
+        const float pw = P[8] * x[i] + P[9] * y[i] + P[10] * z[i] + P[11];
+        const float inv = pw != 0.f ? 1.f / pw : 0.f;
+        u[i] = pu * inv;
+        v[i] = pv * inv;
+        w[i] = pw;
+    }
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FALCONMIND_LIDAR_CAMERA_X86 1
+__attribute__((target("sse4.1"))) void projectSse41(const float* x, const float* y, const float* z, std::size_t n,
+                                                      const float* P, float* u, float* v, float* w) {
+    __m128 m[12];
+    for (int k = 0; k < 12; ++k) m[k] = _mm_set1_ps(P[k]);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 px = _mm_loadu_ps(x + i), py = _mm_loadu_ps(y + i), pz = _mm_loadu_ps(z + i);
+        const __m128 pu = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0], px), _mm_mul_ps(m[1], py)),
+                                     _mm_add_ps(_mm_mul_ps(m[2], pz), m[3]));
+        const __m128 pv = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[4], px), _mm_mul_ps(m[5], py)),
+                                     _mm_add_ps(_mm_mul_ps(m[6], pz), m[7]));
+        const __m128 pw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[8], px), _mm_mul_ps(m[9], py)),
+                                     _mm_add_ps(_mm_mul_ps(m[10], pz), m[11]));
+        _mm_storeu_ps(u + i, _mm_div_ps(pu, pw));
+        _mm_storeu_ps(v + i, _mm_div_ps(pv, pw));
+        _mm_storeu_ps(w + i, pw);
+    }
+    projectScalar(x + i, y + i, z + i, n - i, P, u + i, v + i, w + i);
+}
+
+__attribute__((target("avx2,fma"))) void projectAvx2(const float* x, const float* y, const float* z, std::size_t n,
+                                                       const float* P, float* u, float* v, float* w) {
+    __m256 m[12];
+    for (int k = 0; k < 12; ++k) m[k] = _mm256_set1_ps(P[k]);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 px = _mm256_loadu_ps(x + i), py = _mm256_loadu_ps(y + i), pz = _mm256_loadu_ps(z + i);
+        const __m256 pu = _mm256_fmadd_ps(m[0], px, _mm256_fmadd_ps(m[1], py, _mm256_fmadd_ps(m[2], pz, m[3])));
+        const __m256 pv = _mm256_fmadd_ps(m[4], px, _mm256_fmadd_ps(m[5], py, _mm256_fmadd_ps(m[6], pz, m[7])));
+        const __m256 pw = _mm256_fmadd_ps(m[8], px, _mm256_fmadd_ps(m[9], py, _mm256_fmadd_ps(m[10], pz, m[11])));
+        _mm256_storeu_ps(u + i, _mm256_div_ps(pu, pw));
+        _mm256_storeu_ps(v + i, _mm256_div_ps(pv, pw));
+        _mm256_storeu_ps(w + i, pw);
+    }
+    projectScalar(x + i, y + i, z + i, n - i, P, u + i, v + i, w + i);
+}
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FALCONMIND_LIDAR_CAMERA_NEON 1
+void projectNeon(const float* x, const float* y, const float* z, std::size_t n, const float* P, float* u, float* v,
+                 float* w) {
+    float32x4_t m[12];
+    for (int k = 0; k < 12; ++k) m[k] = vdupq_n_f32(P[k]);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t px = vld1q_f32(x + i), py = vld1q_f32(y + i), pz = vld1q_f32(z + i);
+        const float32x4_t pu = vfmaq_f32(vfmaq_f32(vfmaq_f32(m[3], m[2], pz), m[1], py), m[0], px);
+        const float32x4_t pv = vfmaq_f32(vfmaq_f32(vfmaq_f32(m[7], m[6], pz), m[5], py), m[4], px);
+        const float32x4_t pw = vfmaq_f32(vfmaq_f32(vfmaq_f32(m[11], m[10], pz), m[9], py), m[8], px);
+        vst1q_f32(u + i, vdivq_f32(pu, pw));
+        vst1q_f32(v + i, vdivq_f32(pv, pw));
+        vst1q_f32(w + i, pw);
+    }
+    projectScalar(x + i, y + i, z + i, n - i, P, u + i, v + i, w + i);
+}
+#endif
+
+struct Kernels {
+    ProjectFn project;
+    const char* name;
+};
+
+Kernels selectKernels() {
+#if defined(FALCONMIND_LIDAR_CAMERA_NEON)
+    return {projectNeon, "neon"};
+#else
+    Kernels k{projectScalar, "scalar"};
+#if defined(FALCONMIND_LIDAR_CAMERA_X86)
+    const core::CpuFeatures& cpu = core::cpuFeatures();
+    if (cpu.avx2 && cpu.fma) {
+        k = {projectAvx2, "avx2"};
+    } else if (cpu.sse41) {
+        k = {projectSse41, "sse4.1"};
+    }
+#endif
+    return k;
+#endif
+}
+
+const Kernels& kernels() {
+    static const Kernels k = selectKernels();
+    return k;
+}
+
+} // namespace
+
+LidarCameraFusion::LidarCameraFusion(LidarCameraFusionConfig config) : config_(config) {
+    config_.cellSize = std::max(1, config_.cellSize);
+    config_.minPoints = std::max(1, config_.minPoints);
+    config_.boxShrink = std::clamp(config_.boxShrink, 0.f, 0.45f);
+}
+
+const char* LidarCameraFusion::kernelName() noexcept {
+    return kernels().name;
+}
+
+bool LidarCameraFusion::setCalibration(const LidarCameraCalibration& calib) {
+    if (!calib.valid()) return false;
+    calib_ = calib;
+    const CameraIntrinsics& k = calib.intrinsics;
+    const double K[9] = {k.fx, 0., k.cx, 0., k.fy, k.cy, 0., 0., 1.};
+    // P = K · [R | t]（双精度预乘后转单精度）
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 4; ++c) {
+            double s = 0.;
+            for (int j = 0; j < 3; ++j) s += K[r * 3 + j] * (c < 3 ? calib.R[j * 3 + c] : calib.t[j]);
+            P_[r * 4 + c] = static_cast<float>(s);
+        }
+    }
+    gridW_ = (calib.imageWidth + config_.cellSize - 1) / config_.cellSize;
+    gridH_ = (calib.imageHeight + config_.cellSize - 1) / config_.cellSize;
+    cellStart_.assign(static_cast<std::size_t>(gridW_) * gridH_ + 1, 0);
+    binned_.clear();
+    calibrated_ = true;
+    return true;
+}
+
+bool LidarCameraFusion::setPointCloud(const sensors::PointCloudView& cloud) {
+    return setPointCloud(cloud.x, cloud.y, cloud.z, cloud.size());
+}
+
+bool LidarCameraFusion::setPointCloud(const float* x, const float* y, const float* z, std::size_t count) {
+    if (!calibrated_) return false;
+    binned_.clear();
+    std::fill(cellStart_.begin(), cellStart_.end(), 0u);
+    ++stats_.frames;
+    stats_.lastInput = static_cast<std::uint32_t>(count);
+    stats_.lastInImage = 0;
+    if (count == 0 || !x || !y || !z) return true;
+
+    if (u_.size() < count) {
+        u_.resize(count);
+        v_.resize(count);
+        depth_.resize(count);
+        cellOf_.resize(count);
+    }
+    kernels().project(x, y, z, count, P_.data(), u_.data(), v_.data(), depth_.data());
+
+    // 计数排序：第一趟统计每格点数（cellStart_[c + 1]），前缀和后第二趟按格写入
+    const float width = static_cast<float>(calib_.imageWidth);
+    const float height = static_cast<float>(calib_.imageHeight);
+    const float invCell = 1.f / static_cast<float>(config_.cellSize);
+    const std::uint32_t kOutside = ~0u;
+    std::size_t inImage = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const float d = depth_[i], u = u_[i], v = v_[i];
+        // 取反比较使 NaN 一并剔除
+        if (!(d >= config_.minDepthM && d <= config_.maxDepthM && u >= 0.f && u < width && v >= 0.f && v < height)) {
+            cellOf_[i] = kOutside;
+            continue;
+        }
+        const auto cx = static_cast<std::uint32_t>(u * invCell);
+        const auto cy = static_cast<std::uint32_t>(v * invCell);
+        const std::uint32_t cell = cy * static_cast<std::uint32_t>(gridW_) + cx;
+        cellOf_[i] = cell;
+        ++cellStart_[cell + 1];
+        ++inImage;
+    }
+    for (std::size_t c = 1; c < cellStart_.size(); ++c) cellStart_[c] += cellStart_[c - 1];
+    binned_.resize(inImage);
+    scratch_.reserve(inImage);
+    // 以 cellStart_[c] 为写指针，写完后恰好前移一格；最后整体回退一格恢复区间起点
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint32_t cell = cellOf_[i];
+        if (cell == kOutside) continue;
+        binned_[cellStart_[cell]++] = BinnedPoint{u_[i], v_[i], depth_[i]};
+    }
+    for (std::size_t c = cellStart_.size() - 1; c > 0; --c) cellStart_[c] = cellStart_[c - 1];
+    cellStart_[0] = 0;
+    stats_.lastInImage = static_cast<std::uint32_t>(inImage);
+    return true;
+}
+
+DetectionDepth LidarCameraFusion::estimate(const DetectionBBox& bbox) {
+    DetectionDepth out;
+    if (!calibrated_ || binned_.empty() || !(bbox.width > 0.f) || !(bbox.height > 0.f)) return out;
+
+    const float x0 = bbox.x + bbox.width * config_.boxShrink;
+    const float x1 = bbox.x + bbox.width * (1.f - config_.boxShrink);
+    const float y0 = bbox.y + bbox.height * config_.boxShrink;
+    const float y1 = bbox.y + bbox.height * (1.f - config_.boxShrink);
+    const float cell = static_cast<float>(config_.cellSize);
+    const int cx0 = std::clamp(static_cast<int>(std::floor(x0 / cell)), 0, gridW_ - 1);
+    const int cx1 = std::clamp(static_cast<int>(std::floor(x1 / cell)), 0, gridW_ - 1);
+    const int cy0 = std::clamp(static_cast<int>(std::floor(y0 / cell)), 0, gridH_ - 1);
+    const int cy1 = std::clamp(static_cast<int>(std::floor(y1 / cell)), 0, gridH_ - 1);
+    if (x1 < 0.f || y1 < 0.f || x0 >= static_cast<float>(calib_.imageWidth) ||
+        y0 >= static_cast<float>(calib_.imageHeight)) {
+        return out;
+    }
+
+    scratch_.clear();
+    for (int gy = cy0; gy <= cy1; ++gy) {
+        const std::size_t row = static_cast<std::size_t>(gy) * gridW_;
+        // 一行内相邻格的点在 binned_ 中连续
+        const std::uint32_t begin = cellStart_[row + cx0];
+        const std::uint32_t end = cellStart_[row + cx1 + 1];
+        const bool inner = gy > cy0 && gy < cy1;
+        for (std::uint32_t i = begin; i < end; ++i) {
+            const BinnedPoint& p = binned_[i];
+            if (!inner && (p.v < y0 || p.v > y1)) continue;
+            if (p.u < x0 || p.u > x1) continue;
+            scratch_.push_back(p.depth);
+        }
+    }
+    out.points = static_cast<int>(scratch_.size());
+    if (out.points < config_.minPoints) return out;
+
+    auto mid = scratch_.begin() + scratch_.size() / 2;
+    std::nth_element(scratch_.begin(), mid, scratch_.end());
+    out.depthM = *mid;
+    out.minDepthM = *std::min_element(scratch_.begin(), mid + 1);
+    const double rx = (bbox.x + 0.5 * bbox.width - calib_.intrinsics.cx) / calib_.intrinsics.fx;
+    const double ry = (bbox.y + 0.5 * bbox.height - calib_.intrinsics.cy) / calib_.intrinsics.fy;
+    out.rangeM = static_cast<float>(out.depthM * std::sqrt(1. + rx * rx + ry * ry));
+    out.valid = true;
+    return out;
+}
+
+void LidarCameraFusion::estimate(const std::vector<Detection>& detections, std::vector<DetectionDepth>& out) {
+    out.resize(detections.size());
+    for (std::size_t i = 0; i < detections.size(); ++i) {
+        out[i] = estimate(detections[i].bbox);
+        if (out[i].valid) {
+            ++stats_.boxesWithDepth;
+        } else {
+            ++stats_.boxesWithoutDepth;
+        }
+    }
+}
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,523 @@
+#include "falconmind/sdk/perception/LidarOdometry.h"
+#include "falconmind/sdk/core/CpuFeatures.h"
+#include "falconmind/sdk/core/FixedMatrix.h"
+#include "falconmind/sdk/core/WorkerGroup.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+constexpr float kFar = 1e9f;  // 地图体素空位的坐标：平方距离远大于任何有效近邻
+constexpr int kMaxNeighbors = 8;
+constexpr std::int32_t kKeyBias = 1 << 20;
+
+using Mat3 = core::Matrix<double, 3, 3>;
+using Mat6 = core::Matrix<double, 6, 6>;
+using Vec6 = core::Vector<double, 6>;
+
+// 一个地图体素 16 个点到查询点的平方距离
+using SqDistFn = void (*)(const float* x, const float* y, const float* z, const float* q, float* out);
+
+void sqDistScalar(const float* x, const float* y, const float* z, const float* q, float* out) {
+    for (int i = 0; i < LidarOdometry::kVoxelPoints; ++i) {
+        const float dx = x[i] - q[0], dy = y[i] - q[1], dz = z[i] - q[2];
+        out[i] = dx * dx + dy * dy + dz * dz;
+    }
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FALCONMIND_LIDAR_ODOM_X86 1
+__attribute__((target("sse4.1"))) void sqDistSse41(const float* x, const float* y, const float* z, const float* q,
+                                                     float* out) {
+    const __m128 qx = _mm_set1_ps(q[0]), qy = _mm_set1_ps(q[1]), qz = _mm_set1_ps(q[2]);
+    for (int i = 0; i < LidarOdometry::kVoxelPoints; i += 4) {
+        const __m128 dx = _mm_sub_ps(_mm_load_ps(x + i), qx);
+        const __m128 dy = _mm_sub_ps(_mm_load_ps(y + i), qy);
+        const __m128 dz = _mm_sub_ps(_mm_load_ps(z + i), qz);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+    }
+}
+
+__attribute__((target("avx2,fma"))) void sqDistAvx2(const float* x, const float* y, const float* z, const float* q,
+                                                      float* out) {
+    const __m256 qx = _mm256_set1_ps(q[0]), qy = _mm256_set1_ps(q[1]), qz = _mm256_set1_ps(q[2]);
+    for (int i = 0; i < LidarOdometry::kVoxelPoints; i += 8) {
+        const __m256 dx = _mm256_sub_ps(_mm256_load_ps(x + i), qx);
+        const __m256 dy = _mm256_sub_ps(_mm256_load_ps(y + i), qy);
+        const __m256 dz = _mm256_sub_ps(_mm256_load_ps(z + i), qz);
+        _mm256_storeu_ps(out + i, _mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx))));
+    }
+}
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FALCONMIND_LIDAR_ODOM_NEON 1
+void sqDistNeon(const float* x, const float* y, const float* z, const float* q, float* out) {
+    const float32x4_t qx = vdupq_n_f32(q[0]), qy = vdupq_n_f32(q[1]), qz = vdupq_n_f32(q[2]);
+    for (int i = 0; i < LidarOdometry::kVoxelPoints; i += 4) {
+        const float32x4_t dx = vsubq_f32(vld1q_f32(x + i), qx);
+        const float32x4_t dy = vsubq_f32(vld1q_f32(y + i), qy);
+        const float32x4_t dz = vsubq_f32(vld1q_f32(z + i), qz);
+        vst1q_f32(out + i, vfmaq_f32(vfmaq_f32(vmulq_f32(dx, dx), dy, dy), dz, dz));
+    }
+}
+#endif
+
+struct Kernels {
+    SqDistFn sqDist;
+    const char* name;
+};
+
+Kernels selectKernels() {
+#if defined(FALCONMIND_LIDAR_ODOM_NEON)
+    return {sqDistNeon, "neon"};
+#else
+    Kernels k{sqDistScalar, "scalar"};
+#if defined(FALCONMIND_LIDAR_ODOM_X86)
+    const core::CpuFeatures& cpu = core::cpuFeatures();
+    if (cpu.avx2 && cpu.fma) {
+        k = {sqDistAvx2, "avx2"};
+    } else if (cpu.sse41) {
+        k = {sqDistSse41, "sse4.1"};
+    }
+#endif
+    return k;
+#endif
+}
+
+const Kernels& kernels() {
+    static const Kernels k = selectKernels();
+    return k;
+}
+
+std::uint64_t packKey(std::int32_t x, std::int32_t y, std::int32_t z) noexcept {
+    return static_cast<std::uint64_t>((x + kKeyBias) & 0x1fffff) |
+           static_cast<std::uint64_t>((y + kKeyBias) & 0x1fffff) << 21 |
+           static_cast<std::uint64_t>((z + kKeyBias) & 0x1fffff) << 42;
+}
+
+// Rodrigues：旋转向量 → 旋转矩阵（行主序）
+std::array<double, 9> expSo3(double wx, double wy, double wz) noexcept {
+    const double th = std::sqrt(wx * wx + wy * wy + wz * wz);
+    const double a = th > 1e-12 ? std::sin(th) / th : 1.0;
+    const double b = th > 1e-12 ? (1.0 - std::cos(th)) / (th * th) : 0.5;
+    return {1. - b * (wy * wy + wz * wz), -a * wz + b * wx * wy,      a * wy + b * wx * wz,
+            a * wz + b * wx * wy,      1. - b * (wx * wx + wz * wz), -a * wx + b * wy * wz,
+            -a * wy + b * wx * wz,     a * wx + b * wy * wz,      1. - b * (wx * wx + wy * wy)};
+}
+
+// 3×3 对称矩阵最小特征值对应的特征向量（Jacobi 旋转）
+void smallestEigenvector(Mat3 a, double n[3]) noexcept {
+    Mat3 v = Mat3::identity();
+    for (int sweep = 0; sweep < 8; ++sweep) {
+        const double off = a(0, 1) * a(0, 1) + a(0, 2) * a(0, 2) + a(1, 2) * a(1, 2);
+        if (off < 1e-18) break;
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                if (std::abs(a(p, q)) < 1e-15) continue;
+                const double theta = (a(q, q) - a(p, p)) / (2.0 * a(p, q));
+                const double t = (theta >= 0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0), s = t * c;
+                for (int k = 0; k < 3; ++k) {
+                    const double akp = a(k, p), akq = a(k, q);
+                    a(k, p) = c * akp - s * akq;
+                    a(k, q) = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const double apk = a(p, k), aqk = a(q, k);
+                    a(p, k) = c * apk - s * aqk;
+                    a(q, k) = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const double vkp = v(k, p), vkq = v(k, q);
+                    v(k, p) = c * vkp - s * vkq;
+                    v(k, q) = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    int m = 0;
+    for (int i = 1; i < 3; ++i) {
+        if (a(i, i) < a(m, m)) m = i;
+    }
+    for (int k = 0; k < 3; ++k) n[k] = v(k, m);
+}
+
+// 每个分片一次迭代的法方程
+struct Normal {
+    Mat6 H;
+    Vec6 g;
+    std::uint32_t count{0};
+    double sq{0.};
+};
+
+} // namespace
+
+LidarOdometry::LidarOdometry(const LidarOdometryConfig& cfg) : cfg_(cfg) {
+    cfg_.scanVoxel = std::max(cfg_.scanVoxel, 0.01f);
+    cfg_.mapVoxel = std::max(cfg_.mapVoxel, 0.05f);
+    cfg_.neighbors = std::clamp(cfg_.neighbors, 3, kMaxNeighbors);
+    cfg_.maxIterations = std::max(cfg_.maxIterations, 1);
+    workers_ = std::make_unique<core::WorkerGroup>(cfg_.threads > 0 ? cfg_.threads : core::WorkerGroup::defaultCount());
+}
+
+LidarOdometry::~LidarOdometry() = default;
+
+std::size_t LidarOdometry::threads() const noexcept { return workers_->count(); }
+
+const char* LidarOdometry::kernelName() noexcept { return kernels().name; }
+
+void LidarOdometry::reset() {
+    voxelIndex_.clear();
+    voxels_.clear();
+    freeVoxels_.clear();
+    mapPoints_ = 0;
+    pose_ = prevPose_ = anchor_ = Transform{};
+    trimCenter_ = {0., 0., 0.};
+    scans_ = 0;
+    result_ = LidarOdometryResult{};
+}
+
+LidarOdometry::Transform LidarOdometry::compose(const Transform& a, const Transform& b) noexcept {
+    Transform r;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            r.R[i * 3 + j] = a.R[i * 3] * b.R[j] + a.R[i * 3 + 1] * b.R[3 + j] + a.R[i * 3 + 2] * b.R[6 + j];
+        }
+        r.t[i] = a.R[i * 3] * b.t[0] + a.R[i * 3 + 1] * b.t[1] + a.R[i * 3 + 2] * b.t[2] + a.t[i];
+    }
+    return r;
+}
+
+LidarOdometry::Transform LidarOdometry::inverse(const Transform& a) noexcept {
+    Transform r;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) r.R[i * 3 + j] = a.R[j * 3 + i];
+    }
+    for (int i = 0; i < 3; ++i) r.t[i] = -(r.R[i * 3] * a.t[0] + r.R[i * 3 + 1] * a.t[1] + r.R[i * 3 + 2] * a.t[2]);
+    return r;
+}
+
+Pose3D LidarOdometry::toPose(const Transform& T, std::uint64_t timestampNs) noexcept {
+    Pose3D p;
+    p.x = T.t[0];
+    p.y = T.t[1];
+    p.z = T.t[2];
+    const auto& R = T.R;
+    const double tr = R[0] + R[4] + R[8];
+    if (tr > 0.) {
+        const double s = std::sqrt(tr + 1.0) * 2.0;
+        p.qw = 0.25 * s;
+        p.qx = (R[7] - R[5]) / s;
+        p.qy = (R[2] - R[6]) / s;
+        p.qz = (R[3] - R[1]) / s;
+    } else if (R[0] > R[4] && R[0] > R[8]) {
+        const double s = std::sqrt(1.0 + R[0] - R[4] - R[8]) * 2.0;
+        p.qw = (R[7] - R[5]) / s;
+        p.qx = 0.25 * s;
+        p.qy = (R[1] + R[3]) / s;
+        p.qz = (R[2] + R[6]) / s;
+    } else if (R[4] > R[8]) {
+        const double s = std::sqrt(1.0 + R[4] - R[0] - R[8]) * 2.0;
+        p.qw = (R[2] - R[6]) / s;
+        p.qx = (R[1] + R[3]) / s;
+        p.qy = 0.25 * s;
+        p.qz = (R[5] + R[7]) / s;
+    } else {
+        const double s = std::sqrt(1.0 + R[8] - R[0] - R[4]) * 2.0;
+        p.qw = (R[3] - R[1]) / s;
+        p.qx = (R[2] + R[6]) / s;
+        p.qy = (R[5] + R[7]) / s;
+        p.qz = 0.25 * s;
+    }
+    p.timestampNs = timestampNs;
+    return p;
+}
+
+LidarOdometry::Transform LidarOdometry::fromPose(const Pose3D& p) noexcept {
+    double n = std::sqrt(p.qw * p.qw + p.qx * p.qx + p.qy * p.qy + p.qz * p.qz);
+    if (n < 1e-12) n = 1.0;
+    const double w = p.qw / n, x = p.qx / n, y = p.qy / n, z = p.qz / n;
+    Transform T;
+    T.R = {1. - 2. * (y * y + z * z), 2. * (x * y - w * z),      2. * (x * z + w * y),
+           2. * (x * y + w * z),      1. - 2. * (x * x + z * z), 2. * (y * z - w * x),
+           2. * (x * z - w * y),      2. * (y * z + w * x),      1. - 2. * (x * x + y * y)};
+    T.t = {p.x, p.y, p.z};
+    return T;
+}
+
+Pose3D LidarOdometry::pose() const noexcept { return toPose(compose(anchor_, pose_), timestampNs_); }
+
+void LidarOdometry::anchorTo(const Pose3D& external) noexcept { anchor_ = compose(fromPose(external), inverse(pose_)); }
+
+void LidarOdometry::downsample(const float* x, const float* y, const float* z, std::size_t count) {
+    scanIndex_.clear();
+    scanSum_.clear();
+    const float inv = 1.0f / cfg_.scanVoxel;
+    const float min2 = cfg_.minRange * cfg_.minRange, max2 = cfg_.maxRange * cfg_.maxRange;
+    for (std::size_t i = 0; i < count; ++i) {
+        const float r2 = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+        if (!(r2 >= min2 && r2 <= max2)) continue;  // 含 NaN
+        const std::uint64_t key = packKey(static_cast<std::int32_t>(std::floor(x[i] * inv)),
+                                          static_cast<std::int32_t>(std::floor(y[i] * inv)),
+                                          static_cast<std::int32_t>(std::floor(z[i] * inv)));
+        auto [it, inserted] = scanIndex_.emplace(key, static_cast<std::uint32_t>(scanSum_.size()));
+        if (inserted) scanSum_.push_back({0.f, 0.f, 0.f, 0.f});
+        auto& s = scanSum_[it->second];
+        s[0] += x[i];
+        s[1] += y[i];
+        s[2] += z[i];
+        s[3] += 1.f;
+    }
+    scan_.resize(scanSum_.size());
+    for (std::size_t i = 0; i < scanSum_.size(); ++i) {
+        const auto& s = scanSum_[i];
+        scan_[i] = {s[0] / s[3], s[1] / s[3], s[2] / s[3]};
+    }
+}
+
+std::size_t LidarOdometry::knn(const float q[3], int k, float* dist, float* xyz) const {
+    const float v = cfg_.mapVoxel;
+    std::int32_t c[3], o[3];
+    for (int a = 0; a < 3; ++a) {
+        const float f = std::floor(q[a] / v);
+        c[a] = static_cast<std::int32_t>(f);
+        o[a] = q[a] - (f + 0.5f) * v >= 0.f ? 1 : -1;  // 查询点所在卦限一侧的相邻体素
+    }
+    const SqDistFn sqDist = kernels().sqDist;
+    alignas(32) float d[kVoxelPoints];
+    std::size_t found = 0;
+    for (int m = 0; m < 8; ++m) {
+        auto it = voxelIndex_.find(
+            packKey(c[0] + ((m & 1) ? o[0] : 0), c[1] + ((m & 2) ? o[1] : 0), c[2] + ((m & 4) ? o[2] : 0)));
+        if (it == voxelIndex_.end()) continue;
+        const MapVoxel& vx = voxels_[it->second];
+        sqDist(vx.x, vx.y, vx.z, q, d);
+        for (std::uint32_t i = 0; i < vx.count; ++i) {
+            if (found == static_cast<std::size_t>(k) && d[i] >= dist[k - 1]) continue;
+            // 插入排序：k ≤ 8
+            std::size_t j = found < static_cast<std::size_t>(k) ? found++ : static_cast<std::size_t>(k - 1);
+            for (; j > 0 && dist[j - 1] > d[i]; --j) {
+                dist[j] = dist[j - 1];
+                xyz[j * 3] = xyz[(j - 1) * 3];
+                xyz[j * 3 + 1] = xyz[(j - 1) * 3 + 1];
+                xyz[j * 3 + 2] = xyz[(j - 1) * 3 + 2];
+            }
+            dist[j] = d[i];
+            xyz[j * 3] = vx.x[i];
+            xyz[j * 3 + 1] = vx.y[i];
+            xyz[j * 3 + 2] = vx.z[i];
+        }
+    }
+    return found;
+}
+
+std::size_t LidarOdometry::nearest(float x, float y, float z, int k, float* out, float* sqDist) const {
+    k = std::clamp(k, 1, kMaxNeighbors);
+    const float q[3] = {x, y, z};
+    float d[kMaxNeighbors];
+    const std::size_t n = knn(q, k, d, out);
+    if (sqDist) std::copy(d, d + n, sqDist);
+    return n;
+}
+
+void LidarOdometry::insertScan(const Transform& T) {
+    const SqDistFn sqDist = kernels().sqDist;
+    const float v = cfg_.mapVoxel;
+    const float spacing2 = cfg_.mapPointSpacing * cfg_.mapPointSpacing;
+    alignas(32) float d[kVoxelPoints];
+    for (const auto& p : scan_) {
+        float q[3];
+        for (int i = 0; i < 3; ++i) {
+            q[i] = static_cast<float>(T.R[i * 3] * p[0] + T.R[i * 3 + 1] * p[1] + T.R[i * 3 + 2] * p[2] + T.t[i]);
+        }
+        const std::int32_t c[3] = {static_cast<std::int32_t>(std::floor(q[0] / v)),
+                                   static_cast<std::int32_t>(std::floor(q[1] / v)),
+                                   static_cast<std::int32_t>(std::floor(q[2] / v))};
+        const std::uint64_t key = packKey(c[0], c[1], c[2]);
+        auto it = voxelIndex_.find(key);
+        std::uint32_t idx;
+        if (it != voxelIndex_.end()) {
+            idx = it->second;
+        } else {
+            if (voxelIndex_.size() >= cfg_.maxMapVoxels) continue;
+            if (!freeVoxels_.empty()) {
+                idx = freeVoxels_.back();
+                freeVoxels_.pop_back();
+            } else {
+                idx = static_cast<std::uint32_t>(voxels_.size());
+                voxels_.emplace_back();
+            }
+            MapVoxel& nv = voxels_[idx];
+            std::fill(nv.x, nv.x + kVoxelPoints, kFar);
+            std::fill(nv.y, nv.y + kVoxelPoints, kFar);
+            std::fill(nv.z, nv.z + kVoxelPoints, kFar);
+            std::copy(c, c + 3, nv.coord);
+            nv.count = 0;
+            voxelIndex_.emplace(key, idx);
+        }
+        MapVoxel& vx = voxels_[idx];
+        if (vx.count >= static_cast<std::uint32_t>(kVoxelPoints)) continue;
+        sqDist(vx.x, vx.y, vx.z, q, d);
+        if (vx.count > 0 && *std::min_element(d, d + vx.count) < spacing2) continue;
+        vx.x[vx.count] = q[0];
+        vx.y[vx.count] = q[1];
+        vx.z[vx.count] = q[2];
+        ++vx.count;
+        ++mapPoints_;
+    }
+}
+
+void LidarOdometry::trimMap() {
+    const auto& t = pose_.t;
+    const double moved = std::hypot(t[0] - trimCenter_[0], t[1] - trimCenter_[1], t[2] - trimCenter_[2]);
+    if (moved < 0.1 * cfg_.mapRadius) return;
+    trimCenter_ = t;
+    const double r2 = cfg_.mapRadius * cfg_.mapRadius;
+    for (auto it = voxelIndex_.begin(); it != voxelIndex_.end();) {
+        const MapVoxel& vx = voxels_[it->second];
+        double d2 = 0.;
+        for (int a = 0; a < 3; ++a) {
+            const double c = (vx.coord[a] + 0.5) * cfg_.mapVoxel - t[a];
+            d2 += c * c;
+        }
+        if (d2 > r2) {
+            mapPoints_ -= vx.count;
+            freeVoxels_.push_back(it->second);
+            it = voxelIndex_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool LidarOdometry::addScan(const float* x, const float* y, const float* z, std::size_t count,
+                            std::uint64_t timestampNs) {
+    downsample(x, y, z, count);
+    timestampNs_ = timestampNs;
+    ++scans_;
+    result_ = LidarOdometryResult{};
+    result_.inputPoints = static_cast<std::uint32_t>(scan_.size());
+    if (voxelIndex_.empty()) {  // 首帧定义地图系
+        insertScan(pose_);
+        result_.converged = true;
+        return true;
+    }
+
+    // 匀速模型预测
+    const Transform predicted = compose(pose_, compose(inverse(prevPose_), pose_));
+    Transform T = predicted;
+    const std::size_t shards = std::min(workers_->count(), std::max<std::size_t>(1, scan_.size() / 256));
+    std::vector<Normal> normals(workers_->count());
+    const int k = cfg_.neighbors;
+    const float maxD2 = cfg_.maxCorrespondence * cfg_.maxCorrespondence;
+    const double huber = std::max(0.05, static_cast<double>(cfg_.planeThreshold));
+    Normal total;
+    for (int iter = 0; iter < cfg_.maxIterations; ++iter) {
+        auto solve = [&](std::size_t s) {
+            Normal& nm = normals[s];
+            nm = Normal{};
+            if (s >= shards) return;
+            const std::size_t begin = scan_.size() * s / shards, end = scan_.size() * (s + 1) / shards;
+            float dist[kMaxNeighbors], nb[kMaxNeighbors * 3];
+            for (std::size_t i = begin; i < end; ++i) {
+                const auto& p = scan_[i];
+                double pw[3];
+                for (int a = 0; a < 3; ++a) {
+                    pw[a] = T.R[a * 3] * p[0] + T.R[a * 3 + 1] * p[1] + T.R[a * 3 + 2] * p[2] + T.t[a];
+                }
+                const float q[3] = {static_cast<float>(pw[0]), static_cast<float>(pw[1]), static_cast<float>(pw[2])};
+                if (knn(q, k, dist, nb) < static_cast<std::size_t>(k) || dist[k - 1] > maxD2) continue;
+                // 近邻质心与协方差最小特征向量即局部平面
+                double m[3] = {0., 0., 0.};
+                for (int j = 0; j < k; ++j) {
+                    for (int a = 0; a < 3; ++a) m[a] += nb[j * 3 + a];
+                }
+                for (double& v : m) v /= k;
+                Mat3 cov{};
+                for (int j = 0; j < k; ++j) {
+                    const double e[3] = {nb[j * 3] - m[0], nb[j * 3 + 1] - m[1], nb[j * 3 + 2] - m[2]};
+                    for (int r = 0; r < 3; ++r) {
+                        for (int c = 0; c < 3; ++c) cov(r, c) += e[r] * e[c];
+                    }
+                }
+                double n[3];
+                smallestEigenvector(cov, n);
+                bool planar = true;
+                for (int j = 0; j < k && planar; ++j) {
+                    const double e = n[0] * (nb[j * 3] - m[0]) + n[1] * (nb[j * 3 + 1] - m[1]) +
+                                     n[2] * (nb[j * 3 + 2] - m[2]);
+                    planar = std::abs(e) <= cfg_.planeThreshold;
+                }
+                if (!planar) continue;
+                const double r = n[0] * (pw[0] - m[0]) + n[1] * (pw[1] - m[1]) + n[2] * (pw[2] - m[2]);
+                const double w = std::abs(r) <= huber ? 1.0 : huber / std::abs(r);
+                // 左乘扰动 p' = p + δθ × p + δt：∂r/∂δθ = p × n，∂r/∂δt = n
+                const double J[6] = {pw[1] * n[2] - pw[2] * n[1], pw[2] * n[0] - pw[0] * n[2],
+                                     pw[0] * n[1] - pw[1] * n[0], n[0], n[1], n[2]};
+                for (int a = 0; a < 6; ++a) {
+                    for (int b = a; b < 6; ++b) nm.H(a, b) += w * J[a] * J[b];
+                    nm.g[a] += w * J[a] * r;
+                }
+                ++nm.count;
+                nm.sq += r * r;
+            }
+        };
+        if (shards > 1) {
+            workers_->run(solve);
+        } else {
+            solve(0);
+        }
+        total = Normal{};
+        for (const Normal& nm : normals) {
+            total.H += nm.H;
+            total.g += nm.g;
+            total.count += nm.count;
+            total.sq += nm.sq;
+        }
+        result_.iterations = iter + 1;
+        result_.correspondences = total.count;
+        result_.rmse = total.count ? std::sqrt(total.sq / total.count) : 0.;
+        if (total.count < cfg_.minCorrespondences) break;
+        for (int a = 0; a < 6; ++a) {
+            for (int b = 0; b < a; ++b) total.H(a, b) = total.H(b, a);
+            total.H(a, a) += 1e-6;
+        }
+        Mat6 Hinv;
+        if (!core::choleskyInverse(total.H, Hinv)) break;
+        const Vec6 delta = Hinv * total.g * -1.0;
+        Transform step;
+        step.R = expSo3(delta[0], delta[1], delta[2]);
+        step.t = {delta[3], delta[4], delta[5]};
+        T = compose(step, T);
+        const double rot = std::sqrt(delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2]);
+        const double trans = std::sqrt(delta[3] * delta[3] + delta[4] * delta[4] + delta[5] * delta[5]);
+        if (rot < cfg_.convergeRotation && trans < cfg_.convergeTranslation) {
+            result_.converged = true;
+            break;
+        }
+    }
+
+    prevPose_ = pose_;
+    if (result_.correspondences < cfg_.minCorrespondences) {
+        result_.degenerate = true;  // 保留匀速外推，不以未配准的点污染地图
+        pose_ = predicted;
+        return false;
+    }
+    pose_ = T;
+    insertScan(pose_);
+    trimMap();
+    return true;
+}
+
+} // namespace falconmind::sdk::perception
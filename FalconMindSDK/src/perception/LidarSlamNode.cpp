@@ -1,44 +1,141 @@
 #include "falconmind/sdk/perception/LidarSlamNode.h"
+#include "falconmind/sdk/perception/ShmPoseChannel.h"
+#include "falconmind/sdk/sensors/PointCloudPacket.h"
+#include "falconmind/sdk/sensors/SensorTypes.h"
 #include "falconmind/sdk/core/Pad.h"
 
+#include <cstdlib>
 #include <iostream>
 
 namespace falconmind::sdk::perception {
 
 using namespace falconmind::sdk::core;
+using namespace falconmind::sdk::sensors;
 
 LidarSlamNode::LidarSlamNode() : Node("lidar_slam") {
-    addPad(std::make_shared<Pad>("pointcloud_in", PadType::Sink));
-    addPad(std::make_shared<Pad>("pose_out", PadType::Source));
+    inPad_ = addPad(std::make_shared<Pad>("pointcloud_in", PadType::Sink));
+    outPad_ = addPad(std::make_shared<Pad>("pose_out", PadType::Source));
 }
 
 bool LidarSlamNode::configure(const std::unordered_map<std::string, std::string>& params) {
     auto it = params.find("output_when_no_client");
     if (it != params.end())
         outputWhenNoClient_ = (it->second == "1" || it->second == "true" || it->second == "yes");
+    // pose_shm：算法容器创建的共享内存位姿通道名（ShmPoseWriter），替换已注入的 client
+    it = params.find("pose_shm");
+    if (it != params.end() && !it->second.empty())
+        slamClient_ = std::make_shared<SlamServiceClientFromShm>(it->second);
+
+    it = params.find("local_odometry");
+    if (it != params.end()) {
+        if (it->second == "off" || it->second.empty()) {
+            odomMode_ = LocalOdometryMode::Off;
+        } else if (it->second == "fallback") {
+            odomMode_ = LocalOdometryMode::Fallback;
+        } else if (it->second == "always") {
+            odomMode_ = LocalOdometryMode::Always;
+        } else {
+            std::cerr << "[LidarSlamNode] Unknown local_odometry: " << it->second << std::endl;
+            return false;
+        }
+    }
+    auto number = [&](const char* key, double& out) {
+        auto found = params.find(key);
+        if (found != params.end()) out = std::strtod(found->second.c_str(), nullptr);
+    };
+    double v = odomConfig_.scanVoxel;
+    number("odom_scan_voxel", v);
+    odomConfig_.scanVoxel = static_cast<float>(v);
+    v = odomConfig_.mapVoxel;
+    number("odom_map_voxel", v);
+    odomConfig_.mapVoxel = static_cast<float>(v);
+    v = odomConfig_.maxIterations;
+    number("odom_max_iterations", v);
+    odomConfig_.maxIterations = static_cast<int>(v);
+    number("odom_map_radius", odomConfig_.mapRadius);
+    v = static_cast<double>(odomConfig_.threads);
+    number("odom_threads", v);
+    odomConfig_.threads = v > 0. ? static_cast<std::size_t>(v) : 0;
+    odometry_.reset();
+    if (odomMode_ != LocalOdometryMode::Off) odometry_ = std::make_unique<LidarOdometry>(odomConfig_);
     return true;
 }
 
 bool LidarSlamNode::start() {
+    if (inPad_ && odometry_) {
+        inPad_->setBufferCallback([this](const BufferRef& scan) {
+            std::lock_guard<std::mutex> lock(scanMutex_);
+            lastScan_ = scan;
+        });
+    }
+    if (odometry_) odometry_->reset();
     started_ = true;
     defaultPoseTimestampNs_ = 0;
-    std::cout << "[LidarSlamNode] start() output_when_no_client=" << outputWhenNoClient_ << std::endl;
+    std::cout << "[LidarSlamNode] start() output_when_no_client=" << outputWhenNoClient_
+              << " local_odometry=" << static_cast<int>(odomMode_);
+    if (odometry_) std::cout << " kernel=" << LidarOdometry::kernelName() << " threads=" << odometry_->threads();
+    std::cout << std::endl;
+    return true;
+}
+
+bool LidarSlamNode::trackScan() {
+    BufferRef scan;
+    {
+        std::lock_guard<std::mutex> lock(scanMutex_);
+        scan = std::move(lastScan_);
+        lastScan_.reset();
+    }
+    if (!scan) return false;
+
+    PointCloudView view;
+    std::uint64_t ts = static_cast<std::uint64_t>(scan.meta().timestampNs);
+    if (view.attach(scan.data(), scan.size())) {
+        if (view.header->timestampNs != 0) ts = static_cast<std::uint64_t>(view.header->timestampNs);
+        odometry_->addScan(view.x, view.y, view.z, view.size(), ts);
+        return true;
+    }
+    if (isPointCloudPacket(scan.data(), scan.size()) || scan.size() % sizeof(PointXYZI) != 0) {
+        std::cerr << "[LidarSlamNode] malformed point cloud (" << scan.size() << " bytes)" << std::endl;
+        return false;
+    }
+    // PointXYZI 数组：转置为 SoA
+    const std::size_t count = scan.size() / sizeof(PointXYZI);
+    const auto* pts = reinterpret_cast<const PointXYZI*>(scan.data());
+    transposed_.resize(count * 3);
+    for (std::size_t i = 0; i < count; ++i) {
+        transposed_[i] = pts[i].x;
+        transposed_[count + i] = pts[i].y;
+        transposed_[2 * count + i] = pts[i].z;
+    }
+    odometry_->addScan(transposed_.data(), transposed_.data() + count, transposed_.data() + 2 * count, count, ts);
     return true;
 }
 
 void LidarSlamNode::process() {
     if (!started_) return;
-    auto outPad = getPad("pose_out");
+    auto* outPad = outPad_;
     if (!outPad) return;
 
-    if (slamClient_ && slamClient_->isAvailable()) {
+    // 容器可用与否都先跟踪本帧，切换到机载里程计时地图与速度模型已就绪
+    const bool tracked = odometry_ && trackScan();
+
+    if (odomMode_ != LocalOdometryMode::Always && slamClient_ && slamClient_->isAvailable()) {
         Pose3D pose;
         if (slamClient_->getPose(pose)) {
+            if (odometry_) odometry_->anchorTo(pose);  // 容器失联后从其最后位姿平滑接续
             outPad->pushToConnections(&pose, sizeof(pose));
             return;
         }
     }
 
+    if (odometry_) {
+        if (tracked) {
+            const Pose3D pose = odometry_->pose();
+            outPad->pushToConnections(&pose, sizeof(pose));
+        }
+        return;
+    }
+
     if (outputWhenNoClient_) {
         Pose3D pose;
         pose.x = pose.y = pose.z = 0.;
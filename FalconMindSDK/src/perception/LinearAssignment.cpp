@@ -0,0 +1,230 @@
+#include "falconmind/sdk/perception/LinearAssignment.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+// 不可选配对的代价：足够大以保证不会被选中，同时避免 inf 参与势的加减
+constexpr double kForbidden = 1e9;
+
+float boxIou(const DetectionBBox& a, const DetectionBBox& b) {
+    float ix1 = std::max(a.x, b.x);
+    float iy1 = std::max(a.y, b.y);
+    float ix2 = std::min(a.x + a.width, b.x + b.width);
+    float iy2 = std::min(a.y + a.height, b.y + b.height);
+    float iw = std::max(0.f, ix2 - ix1);
+    float ih = std::max(0.f, iy2 - iy1);
+    float inter = iw * ih;
+    float u = a.width * a.height + b.width * b.height - inter;
+    return (u > 0.f) ? (inter / u) : 0.f;
+}
+
+int findRoot(std::vector<int>& parent, int x) {
+    while (parent[static_cast<std::size_t>(x)] != x) {
+        parent[static_cast<std::size_t>(x)] = parent[static_cast<std::size_t>(parent[static_cast<std::size_t>(x)])];
+        x = parent[static_cast<std::size_t>(x)];
+    }
+    return x;
+}
+
+std::int64_t cellKey(int gx, int gy) {
+    return (static_cast<std::int64_t>(gx) << 32) ^ static_cast<std::uint32_t>(gy);
+}
+
+} // namespace
+
+void solveDenseAssignment(const std::vector<double>& cost, int n, std::vector<int>& rowToCol) {
+    rowToCol.assign(static_cast<std::size_t>(std::max(n, 0)), -1);
+    if (n <= 0) return;
+    const double inf = std::numeric_limits<double>::infinity();
+    const std::size_t N = static_cast<std::size_t>(n);
+    // 1 起始下标：u/v 为行/列对偶势，colRow[j] 为列 j 当前匹配的行（0 为未匹配），way 记录增广路前驱列
+    std::vector<double> u(N + 1, 0.0), v(N + 1, 0.0), minv(N + 1);
+    std::vector<std::size_t> colRow(N + 1, 0), way(N + 1, 0);
+    std::vector<char> used(N + 1);
+    for (std::size_t i = 1; i <= N; ++i) {
+        colRow[0] = i;
+        std::size_t j0 = 0;
+        std::fill(minv.begin(), minv.end(), inf);
+        std::fill(used.begin(), used.end(), 0);
+        // Dijkstra 式最短增广路：每轮把约化代价最小的列加入树，直到到达未匹配列
+        do {
+            used[j0] = 1;
+            const std::size_t i0 = colRow[j0];
+            const double* row = &cost[(i0 - 1) * N];
+            double delta = inf;
+            std::size_t j1 = 0;
+            for (std::size_t j = 1; j <= N; ++j) {
+                if (used[j]) continue;
+                const double cur = row[j - 1] - u[i0] - v[j];
+                if (cur < minv[j]) {
+                    minv[j] = cur;
+                    way[j] = j0;
+                }
+                if (minv[j] < delta) {
+                    delta = minv[j];
+                    j1 = j;
+                }
+            }
+            for (std::size_t j = 0; j <= N; ++j) {
+                if (used[j]) {
+                    u[colRow[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (colRow[j0] != 0);
+        // 沿前驱翻转增广路
+        do {
+            const std::size_t j1 = way[j0];
+            colRow[j0] = colRow[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+    for (std::size_t j = 1; j <= N; ++j) rowToCol[colRow[j] - 1] = static_cast<int>(j - 1);
+}
+
+void solveSparseAssignment(int rows, int cols, const std::vector<AssignmentCandidate>& candidates,
+                           float unassignedCost, std::vector<int>& rowToCol) {
+    rowToCol.assign(static_cast<std::size_t>(std::max(rows, 0)), -1);
+    if (rows <= 0 || cols <= 0 || candidates.empty()) return;
+
+    // 1) 并查集：行 [0, rows)、列 [rows, rows + cols) 按候选边合并为连通分量
+    std::vector<int> parent(static_cast<std::size_t>(rows + cols));
+    std::iota(parent.begin(), parent.end(), 0);
+    for (const auto& c : candidates) {
+        if (c.row < 0 || c.row >= rows || c.col < 0 || c.col >= cols) continue;
+        const int a = findRoot(parent, c.row);
+        const int b = findRoot(parent, rows + c.col);
+        if (a != b) parent[static_cast<std::size_t>(a)] = b;
+    }
+
+    // 2) 按分量分组候选边，并为每个分量内的行 / 列编局部下标
+    std::unordered_map<int, std::vector<const AssignmentCandidate*>> groups;
+    for (const auto& c : candidates) {
+        if (c.row < 0 || c.row >= rows || c.col < 0 || c.col >= cols) continue;
+        groups[findRoot(parent, c.row)].push_back(&c);
+    }
+    std::vector<int> localIndex(static_cast<std::size_t>(rows + cols), -1);
+    std::vector<int> compRows, compCols;
+    std::vector<double> cost;
+    std::vector<int> local;
+    for (auto& kv : groups) {
+        compRows.clear();
+        compCols.clear();
+        for (const auto* c : kv.second) {
+            int& ri = localIndex[static_cast<std::size_t>(c->row)];
+            if (ri < 0) {
+                ri = static_cast<int>(compRows.size());
+                compRows.push_back(c->row);
+            }
+            int& ci = localIndex[static_cast<std::size_t>(rows + c->col)];
+            if (ci < 0) {
+                ci = static_cast<int>(compCols.size());
+                compCols.push_back(c->col);
+            }
+        }
+        const int nr = static_cast<int>(compRows.size());
+        const int nc = static_cast<int>(compCols.size());
+        if (nr == 1 && nc == 1) {
+            // 孤立配对：匹配代价 <= 两端各自落空的代价时直接配对
+            const double best = kv.second.size() == 1
+                ? kv.second.front()->cost
+                : (*std::min_element(kv.second.begin(), kv.second.end(),
+                                     [](const AssignmentCandidate* a, const AssignmentCandidate* b) {
+                                         return a->cost < b->cost;
+                                     }))->cost;
+            if (best <= 2.0 * unassignedCost) rowToCol[static_cast<std::size_t>(compRows[0])] = compCols[0];
+        } else {
+            // 3) 扩展为 (nr + nc) 方阵：右上 / 左下为“落空”虚拟行列，右下虚拟 ↔ 虚拟代价 0
+            const int n = nr + nc;
+            cost.assign(static_cast<std::size_t>(n) * static_cast<std::size_t>(n), 0.0);
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    double& c = cost[static_cast<std::size_t>(i) * static_cast<std::size_t>(n) + static_cast<std::size_t>(j)];
+                    if (i < nr && j < nc) c = kForbidden;
+                    else if (i < nr || j < nc) c = unassignedCost;
+                }
+            }
+            for (const auto* c : kv.second) {
+                const std::size_t idx = static_cast<std::size_t>(localIndex[static_cast<std::size_t>(c->row)]) * n +
+                                        static_cast<std::size_t>(localIndex[static_cast<std::size_t>(rows + c->col)]);
+                cost[idx] = std::min(cost[idx], static_cast<double>(c->cost));
+            }
+            solveDenseAssignment(cost, n, local);
+            for (int i = 0; i < nr; ++i) {
+                const int j = local[static_cast<std::size_t>(i)];
+                if (j >= 0 && j < nc &&
+                    cost[static_cast<std::size_t>(i) * static_cast<std::size_t>(n) + static_cast<std::size_t>(j)] < kForbidden) {
+                    rowToCol[static_cast<std::size_t>(compRows[static_cast<std::size_t>(i)])] = compCols[static_cast<std::size_t>(j)];
+                }
+            }
+        }
+        for (int r : compRows) localIndex[static_cast<std::size_t>(r)] = -1;
+        for (int c : compCols) localIndex[static_cast<std::size_t>(rows + c)] = -1;
+    }
+}
+
+void gateByIou(const std::vector<DetectionBBox>& rowBoxes, const std::vector<DetectionBBox>& colBoxes,
+               float minIou, std::vector<AssignmentCandidate>& out, const std::vector<bool>* colEnabled) {
+    out.clear();
+    if (rowBoxes.empty() || colBoxes.empty()) return;
+
+    // 格子边长取列框的平均尺寸：IoU > 0 的两框必然覆盖至少一个公共格子
+    double sum = 0.0;
+    std::size_t n = 0;
+    for (std::size_t j = 0; j < colBoxes.size(); ++j) {
+        if (colEnabled && !(*colEnabled)[j]) continue;
+        sum += std::max(colBoxes[j].width, colBoxes[j].height);
+        ++n;
+    }
+    if (n == 0) return;
+    const float cell = std::max(1.f, static_cast<float>(sum / static_cast<double>(n)));
+    const float inv = 1.f / cell;
+    auto cellRange = [inv](const DetectionBBox& b, int& x0, int& y0, int& x1, int& y1) {
+        x0 = static_cast<int>(std::floor(b.x * inv));
+        y0 = static_cast<int>(std::floor(b.y * inv));
+        x1 = static_cast<int>(std::floor((b.x + std::max(0.f, b.width)) * inv));
+        y1 = static_cast<int>(std::floor((b.y + std::max(0.f, b.height)) * inv));
+    };
+
+    std::unordered_map<std::int64_t, std::vector<int>> grid;
+    grid.reserve(n * 2);
+    int x0, y0, x1, y1;
+    for (std::size_t j = 0; j < colBoxes.size(); ++j) {
+        if (colEnabled && !(*colEnabled)[j]) continue;
+        cellRange(colBoxes[j], x0, y0, x1, y1);
+        for (int gy = y0; gy <= y1; ++gy)
+            for (int gx = x0; gx <= x1; ++gx) grid[cellKey(gx, gy)].push_back(static_cast<int>(j));
+    }
+
+    // seen[j] 记录最近一次访问列 j 的行号 + 1，避免跨格子重复计算
+    std::vector<int> seen(colBoxes.size(), 0);
+    for (std::size_t i = 0; i < rowBoxes.size(); ++i) {
+        const int stamp = static_cast<int>(i) + 1;
+        cellRange(rowBoxes[i], x0, y0, x1, y1);
+        for (int gy = y0; gy <= y1; ++gy) {
+            for (int gx = x0; gx <= x1; ++gx) {
+                auto it = grid.find(cellKey(gx, gy));
+                if (it == grid.end()) continue;
+                for (int j : it->second) {
+                    if (seen[static_cast<std::size_t>(j)] == stamp) continue;
+                    seen[static_cast<std::size_t>(j)] = stamp;
+                    const float v = boxIou(rowBoxes[i], colBoxes[static_cast<std::size_t>(j)]);
+                    if (v > minIou) out.push_back(AssignmentCandidate{static_cast<int>(i), j, 1.f - v});
+                }
+            }
+        }
+    }
+}
+
+} // namespace falconmind::sdk::perception
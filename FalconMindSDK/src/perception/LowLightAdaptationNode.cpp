@@ -3,6 +3,7 @@
 
 #include "falconmind/sdk/core/Pad.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <iostream>
@@ -13,8 +14,18 @@ using namespace falconmind::sdk::core;
 using namespace falconmind::sdk::sensors;
 
 LowLightAdaptationNode::LowLightAdaptationNode() : Node("low_light_adaptation") {
-    addPad(std::make_shared<Pad>("image_in", PadType::Sink));
-    addPad(std::make_shared<Pad>("image_out", PadType::Source));
+    // 仅对 RGB8/BGR8 做增强，输出格式与输入一致
+    Caps caps;
+    caps.addVideo(VideoCaps{PixelFormat::RGB8, 0, 0, 0});
+    caps.addVideo(VideoCaps{PixelFormat::BGR8, 0, 0, 0});
+    auto in = std::make_shared<Pad>("image_in", PadType::Sink);
+    auto out = std::make_shared<Pad>("image_out", PadType::Source);
+    in->setCaps(caps);
+    out->setCaps(caps);
+    in->setCapsCallback([this](const VideoCaps& c) { inputFormat_ = c.format; });
+    inPad_ = addPad(in);
+    outPad_ = addPad(out);
+    brightnessPad_ = addPad(std::make_shared<Pad>("brightness_out", PadType::Source));
 }
 
 bool LowLightAdaptationNode::configure(const std::unordered_map<std::string, std::string>& params) {
@@ -22,99 +33,176 @@ bool LowLightAdaptationNode::configure(const std::unordered_map<std::string, std
     if (gt != params.end()) setGamma(std::stof(gt->second));
     auto bt = params.find("brightness_threshold");
     if (bt != params.end()) brightnessThreshold_ = static_cast<uint8_t>(std::stoi(bt->second));
+    auto mt = params.find("mode");
+    if (mt != params.end()) {
+        if (mt->second == "gamma") mode_ = LowLightMode::Gamma;
+        else if (mt->second == "auto_gain") mode_ = LowLightMode::AutoGain;
+        else if (mt->second == "clahe") mode_ = LowLightMode::Clahe;
+        else {
+            std::cerr << "[LowLightAdaptationNode] Unknown mode: " << mt->second << std::endl;
+            return false;
+        }
+    }
+    auto tb = params.find("target_brightness");
+    if (tb != params.end()) setTargetBrightness(std::stof(tb->second));
+    auto mg = params.find("max_gain");
+    if (mg != params.end()) setMaxGain(std::stof(mg->second));
+    auto cc = params.find("clahe_clip");
+    if (cc != params.end()) clahe_.setClipLimit(std::stof(cc->second));
+    auto ct = params.find("clahe_tiles");
+    if (ct != params.end()) {
+        int tiles = std::stoi(ct->second);
+        clahe_.setTiles(tiles, tiles);
+    }
     return true;
 }
 
 bool LowLightAdaptationNode::start() {
-    auto pad = getPad("image_in");
+    auto* pad = inPad_;
     if (pad) {
-        pad->setDataCallback([this](const void* data, size_t size) {
-            if (data && size >= sizeof(CameraFramePacket)) {
-                const auto* p = static_cast<const std::uint8_t*>(data);
-                lastFrameBuffer_.assign(p, p + size);
-                lastFrameValid_ = true;
+        pad->setBufferCallback([this](const BufferRef& frame) {
+            if (frame.size() >= sizeof(CameraFramePacket)) {
+                std::lock_guard<std::mutex> lock(frameMutex_);
+                lastFrame_ = frame;
             }
         });
     }
+    stats_.reset();
+    clahe_.reset();
+    gain_ = 1.f;
+    fusedMeasured_ = false;
     started_ = true;
-    std::cout << "[LowLightAdaptationNode] start() gamma=" << gamma_
+    std::cout << "[LowLightAdaptationNode] start() gamma=" << gamma_ << " lut_kernel=" << lutKernelName()
               << " brightness_threshold=" << static_cast<int>(brightnessThreshold_) << std::endl;
     return true;
 }
 
-namespace {
-
-int bytesPerPixel(const char format[16]) {
-    if (std::strstr(format, "RGB") || std::strstr(format, "BGR")) return 3;
-    if (std::strstr(format, "YUYV") || std::strstr(format, "UYVY")) return 2;
-    return 3;
-}
-
-bool isRgbOrBgr(const char format[16]) {
-    return (std::strncmp(format, "RGB", 3) == 0) || (std::strncmp(format, "BGR", 3) == 0);
-}
+void LowLightAdaptationNode::process() {
+    if (!started_) return;
+    BufferRef frame;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        frame = std::move(lastFrame_);
+        lastFrame_.reset();
+    }
+    if (frame.size() < sizeof(CameraFramePacket)) {
+        return;
+    }
 
-// 对 RGB/BGR 三通道图做 gamma 增强：out = 255 * (in/255)^(1/gamma)
-void applyGammaRgb(std::uint8_t* data, size_t numPixels, int channels, float gamma) {
-    if (gamma <= 0.f || gamma > 4.f) return;
-    float invGamma = 1.f / gamma;
-    for (size_t i = 0; i < numPixels * static_cast<size_t>(channels); ++i) {
-        float v = data[i] / 255.f;
-        v = std::pow(v, invGamma);
-        data[i] = static_cast<std::uint8_t>(std::min(255.f, v * 255.f + 0.5f));
+    const auto* header = reinterpret_cast<const CameraFramePacket*>(frame.data());
+    // 格式取自缓冲元数据或 link 协商结果；仅对未协商的原始包回退解析帧头字符串
+    PixelFormat fmt = frame.meta().video.format != PixelFormat::Any ? frame.meta().video.format : inputFormat_;
+    if (fmt == PixelFormat::Any) fmt = parsePixelFormat(header->format);
+    if (fusion_ && fusion_->run(frame, fmt)) {
+        return;
+    }
+    bool rgbLike = (fmt == PixelFormat::RGB8 || fmt == PixelFormat::BGR8);
+    int bpp = (fmt == PixelFormat::YUYV) ? 2 : 3;
+    size_t pixelBytes = (header->stride > 0 && header->height > 0)
+        ? static_cast<size_t>(header->stride) * static_cast<size_t>(header->height)
+        : static_cast<size_t>(header->width) * static_cast<size_t>(header->height) * bpp;
+    if (frame.size() < sizeof(CameraFramePacket) + pixelBytes) {
+        return;
     }
-}
 
-// 采样估计亮度（均值），避免全图遍历两遍时用同一遍既算均值又做 gamma
-float meanBrightnessRgb(const std::uint8_t* data, int width, int height, int stride, int step) {
-    double sum = 0;
-    int n = 0;
-    for (int y = 0; y < height; y += step) {
-        const std::uint8_t* row = data + static_cast<size_t>(y) * stride;
-        for (int x = 0; x < width; x += step) {
-            size_t o = static_cast<size_t>(x) * 3;
-            sum += (0.299f * row[o] + 0.587f * row[o + 1] + 0.114f * row[o + 2]);
-            n++;
+    if (rgbLike) {
+        const int stride = (header->stride > 0) ? header->stride : (header->width * 3);
+        const bool bgr = fmt == PixelFormat::BGR8;
+        // 上一帧增强时已在查表的同一遍中统计亮度；否则对本帧做一次 1/16 采样的只读统计
+        if (!stats_.valid()) {
+            sampleBrightness(cameraFramePacketData(header), header->width, header->height, stride, 4, stats_);
         }
+        lastMean_ = stats_.meanLuma(bgr);
+        const bool doEnhance = lastMean_ < static_cast<float>(brightnessThreshold_);
+        FrameBrightnessPacket stats;
+        stats.meanLuma = lastMean_;
+        stats.enhanced = doEnhance ? 1u : 0u;
+        stats.timestampNs = frame.meta().timestampNs;
+        stats.frameIndex = frame.meta().frameIndex;
+        if (doEnhance) {
+            enhance(frame, stride, bgr);
+        } else {
+            stats_.reset();
+        }
+        if (brightnessPad_) brightnessPad_->pushToConnections(&stats, sizeof(stats));
     }
-    return (n > 0) ? static_cast<float>(sum / n) : 0.f;
-}
 
-} // namespace
+    // 未增强时原样转发同一缓冲（零拷贝）
+    if (outPad_)
+        outPad_->pushBuffer(frame);
+}
 
-void LowLightAdaptationNode::process() {
-    if (!started_) return;
-    if (!lastFrameValid_ || lastFrameBuffer_.size() < sizeof(CameraFramePacket)) {
-        lastFrameValid_ = false;
+void LowLightAdaptationNode::updateLut(float mean, std::uint8_t lut[256], LowLightMode& lutMode, float& lutParam) {
+    if (mode_ == LowLightMode::Gamma) {
+        if (lutMode != LowLightMode::Gamma || lutParam != gamma_) {
+            buildGammaLut(gamma_, lut);
+            lutMode = LowLightMode::Gamma;
+            lutParam = gamma_;
+        }
         return;
     }
+    const float target = std::clamp(targetBrightness_ / std::max(mean, 1.f), 1.f, maxGain_);
+    gain_ += 0.5f * (target - gain_);  // 帧间平滑，避免闪烁
+    if (lutMode != LowLightMode::AutoGain || std::fabs(lutParam - gain_) > 0.01f) {
+        buildGainLut(gain_, lut);
+        lutMode = LowLightMode::AutoGain;
+        lutParam = gain_;
+    }
+}
 
-    auto* header = reinterpret_cast<CameraFramePacket*>(lastFrameBuffer_.data());
-    int bpp = bytesPerPixel(header->format);
-    size_t pixelBytes = (header->stride > 0 && header->height > 0)
-        ? static_cast<size_t>(header->stride) * static_cast<size_t>(header->height)
-        : static_cast<size_t>(header->width) * static_cast<size_t>(header->height) * bpp;
-    if (lastFrameBuffer_.size() < sizeof(CameraFramePacket) + pixelBytes) {
-        lastFrameValid_ = false;
-        return;
+bool LowLightAdaptationNode::planFusedFrame(const sensors::FusedImageInfo& in, sensors::FusedStagePlan& out) {
+    if (!started_ || !canFuse() || (in.format != PixelFormat::RGB8 && in.format != PixelFormat::BGR8)) {
+        return false;
     }
+    // 本帧像素尚未产出：按上一帧的亮度决定是否增强（首帧只统计不增强），统计在查表的同一遍中累积
+    fusedBgr_ = in.format == PixelFormat::BGR8;
+    fusedEnhance_ = fusedMeasured_ && fusedMean_ < static_cast<float>(brightnessThreshold_);
+    if (fusedEnhance_) updateLut(fusedMean_, fusedLut_, fusedLutMode_, fusedLutParam_);
+    fusedStats_.reset();
+    out.format = in.format;
+    out.rowOp = true;
+    return true;
+}
 
-    std::uint8_t* pixels = cameraFramePacketDataWritable(header);
-    bool doEnhance = false;
-    if (isRgbOrBgr(header->format) && bpp == 3) {
-        int stride = (header->stride > 0) ? header->stride : (header->width * 3);
-        float mean = meanBrightnessRgb(pixels, header->width, header->height, stride, 4);
-        if (mean < static_cast<float>(brightnessThreshold_))
-            doEnhance = true;
+void LowLightAdaptationNode::fusedRow(std::uint8_t* row, int width, int y) {
+    const bool sample = y % 4 == 0;
+    if (fusedEnhance_) {
+        applyLutRgb(row, width, 1, 0, fusedLut_, sample ? &fusedStats_ : nullptr, 1);
+    } else if (sample) {
+        sampleBrightness(row, width, 1, 0, 4, fusedStats_);
     }
+}
 
-    if (doEnhance)
-        applyGammaRgb(pixels, static_cast<size_t>(header->width) * static_cast<size_t>(header->height), bpp, gamma_);
+void LowLightAdaptationNode::finishFusedFrame(const BufferRef& output) {
+    if (fusedStats_.valid()) {
+        fusedMean_ = fusedStats_.meanLuma(fusedBgr_);
+        fusedMeasured_ = true;
+    }
+    lastMean_ = fusedMean_;
+    FrameBrightnessPacket stats;
+    stats.meanLuma = fusedMean_;
+    stats.enhanced = fusedEnhance_ ? 1u : 0u;
+    stats.timestampNs = output.meta().timestampNs;
+    stats.frameIndex = output.meta().frameIndex;
+    if (brightnessPad_) brightnessPad_->pushToConnections(&stats, sizeof(stats));
+}
 
-    auto outPad = getPad("image_out");
-    if (outPad)
-        outPad->pushToConnections(lastFrameBuffer_.data(), lastFrameBuffer_.size());
-    lastFrameValid_ = false;
+void LowLightAdaptationNode::enhance(BufferRef& frame, int stride, bool bgr) {
+    const float mean = lastMean_;
+    // 写时复制：上游或其他下游仍持有该帧时先复制，不影响它们看到的原始像素
+    auto* writable = reinterpret_cast<CameraFramePacket*>(frame.mutableData());
+    std::uint8_t* pixels = cameraFramePacketDataWritable(writable);
+    stats_.reset();
+    switch (mode_) {
+    case LowLightMode::Gamma:
+    case LowLightMode::AutoGain:
+        updateLut(mean, lut_, lutMode_, lutGamma_);
+        applyLutRgb(pixels, writable->width, writable->height, stride, lut_, &stats_, 4);
+        break;
+    case LowLightMode::Clahe:
+        clahe_.apply(pixels, writable->width, writable->height, stride, bgr, &stats_, 4);
+        break;
+    }
 }
 
 } // namespace falconmind::sdk::perception
@@ -0,0 +1,345 @@
+#include "falconmind/sdk/perception/LowLightEnhance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+// BT.601 亮度，Q8 定点；w0 对应内存中的第一个通道
+struct LumaWeights {
+    std::uint32_t w0, w1, w2;
+};
+
+LumaWeights lumaWeights(bool bgr) {
+    return bgr ? LumaWeights{29, 150, 77} : LumaWeights{77, 150, 29};
+}
+
+inline std::uint32_t luma(const std::uint8_t* p, const LumaWeights& w) {
+    return (w.w0 * p[0] + w.w1 * p[1] + w.w2 * p[2]) >> 8;
+}
+
+void lutRowWithStats(std::uint8_t* row, std::size_t pixels, const std::uint8_t* lut, BrightnessStats& stats) {
+    auto& h0 = stats.hist[0];
+    auto& h1 = stats.hist[1];
+    auto& h2 = stats.hist[2];
+    for (std::size_t i = 0; i < pixels; ++i, row += 3) {
+        const std::uint8_t a = row[0], b = row[1], c = row[2];
+        ++h0[a];
+        ++h1[b];
+        ++h2[c];
+        row[0] = lut[a];
+        row[1] = lut[b];
+        row[2] = lut[c];
+    }
+    stats.samples += pixels;
+}
+
+void lutBytesScalar(std::uint8_t* p, std::size_t n, const std::uint8_t* lut) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const std::uint8_t a0 = p[i], a1 = p[i + 1], a2 = p[i + 2], a3 = p[i + 3];
+        const std::uint8_t a4 = p[i + 4], a5 = p[i + 5], a6 = p[i + 6], a7 = p[i + 7];
+        p[i] = lut[a0];
+        p[i + 1] = lut[a1];
+        p[i + 2] = lut[a2];
+        p[i + 3] = lut[a3];
+        p[i + 4] = lut[a4];
+        p[i + 5] = lut[a5];
+        p[i + 6] = lut[a6];
+        p[i + 7] = lut[a7];
+    }
+    for (; i < n; ++i) p[i] = lut[p[i]];
+}
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FALCONMIND_LUT_NEON 1
+// 256 项表拆成 4 段 64 项：TBL 处理首段，TBX 对越界索引保持原值，依次叠加其余三段
+void lutBytesNeon(std::uint8_t* p, std::size_t n, const std::uint8_t* lut) {
+    const uint8x16x4_t t0 = vld1q_u8_x4(lut);
+    const uint8x16x4_t t1 = vld1q_u8_x4(lut + 64);
+    const uint8x16x4_t t2 = vld1q_u8_x4(lut + 128);
+    const uint8x16x4_t t3 = vld1q_u8_x4(lut + 192);
+    const uint8x16_t k64 = vdupq_n_u8(64);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const uint8x16_t v = vld1q_u8(p + i);
+        uint8x16_t r = vqtbl4q_u8(t0, v);
+        uint8x16_t idx = vsubq_u8(v, k64);
+        r = vqtbx4q_u8(r, t1, idx);
+        idx = vsubq_u8(idx, k64);
+        r = vqtbx4q_u8(r, t2, idx);
+        idx = vsubq_u8(idx, k64);
+        r = vqtbx4q_u8(r, t3, idx);
+        vst1q_u8(p + i, r);
+    }
+    lutBytesScalar(p + i, n - i, lut);
+}
+#endif
+
+using LutFn = void (*)(std::uint8_t* p, std::size_t n, const std::uint8_t* lut);
+
+struct LutKernel {
+    LutFn fn;
+    const char* name;
+};
+
+LutKernel selectLut() {
+#if defined(FALCONMIND_LUT_NEON)
+    return {lutBytesNeon, "neon"};
+#else
+    // x86 没有 256 项字节查表指令，PSHUFB 分段拼接实测慢于展开的标量查表
+    return {lutBytesScalar, "scalar"};
+#endif
+}
+
+const LutKernel& lutKernel() {
+    static const LutKernel k = selectLut();
+    return k;
+}
+
+void lutBytes(std::uint8_t* p, std::size_t n, const std::uint8_t* lut) {
+    lutKernel().fn(p, n, lut);
+}
+
+} // namespace
+
+void BrightnessStats::reset() noexcept {
+    for (auto& h : hist) h.fill(0);
+    samples = 0;
+}
+
+float BrightnessStats::meanLuma(bool bgr) const noexcept {
+    if (samples == 0) return 0.f;
+    double mean[3];
+    for (int c = 0; c < 3; ++c) {
+        double s = 0.;
+        for (int v = 0; v < 256; ++v) s += static_cast<double>(hist[c][v]) * v;
+        mean[c] = s / static_cast<double>(samples);
+    }
+    // 亮度对通道线性：均值的加权和即亮度均值
+    const double r = bgr ? mean[2] : mean[0];
+    const double b = bgr ? mean[0] : mean[2];
+    return static_cast<float>(0.299 * r + 0.587 * mean[1] + 0.114 * b);
+}
+
+std::uint8_t BrightnessStats::percentile(float p) const noexcept {
+    if (samples == 0) return 0;
+    const double target = std::clamp(p, 0.f, 1.f) * static_cast<double>(samples) * 3.;
+    double acc = 0.;
+    for (int v = 0; v < 256; ++v) {
+        acc += static_cast<double>(hist[0][v]) + hist[1][v] + hist[2][v];
+        if (acc >= target) return static_cast<std::uint8_t>(v);
+    }
+    return 255;
+}
+
+void buildGammaLut(float gamma, std::uint8_t lut[256]) noexcept {
+    const float invGamma = gamma > 0.f ? 1.f / gamma : 1.f;
+    for (int i = 0; i < 256; ++i) {
+        const float v = std::pow(static_cast<float>(i) / 255.f, invGamma);
+        lut[i] = static_cast<std::uint8_t>(std::min(255.f, v * 255.f + 0.5f));
+    }
+}
+
+void buildGainLut(float gain, std::uint8_t lut[256]) noexcept {
+    for (int i = 0; i < 256; ++i) {
+        lut[i] = static_cast<std::uint8_t>(std::min(255.f, static_cast<float>(i) * gain + 0.5f));
+    }
+}
+
+void applyLutRgb(std::uint8_t* data, int width, int height, int stride, const std::uint8_t lut[256],
+                 BrightnessStats* stats, int statsRowStep) noexcept {
+    if (!data || width <= 0 || height <= 0) return;
+    if (stride <= 0) stride = width * 3;
+    const std::size_t pixels = static_cast<std::size_t>(width);
+    // 行间无填充时整块查表
+    if (!stats && stride == width * 3) {
+        lutBytes(data, pixels * 3 * static_cast<std::size_t>(height), lut);
+        return;
+    }
+    if (statsRowStep <= 0) statsRowStep = 1;
+    for (int y = 0; y < height; ++y) {
+        std::uint8_t* row = data + static_cast<std::size_t>(y) * stride;
+        if (stats && y % statsRowStep == 0) {
+            lutRowWithStats(row, pixels, lut, *stats);
+        } else {
+            lutBytes(row, pixels * 3, lut);
+        }
+    }
+}
+
+void sampleBrightness(const std::uint8_t* data, int width, int height, int stride, int step,
+                      BrightnessStats& stats) noexcept {
+    if (!data || width <= 0 || height <= 0) return;
+    if (stride <= 0) stride = width * 3;
+    if (step <= 0) step = 1;
+    for (int y = 0; y < height; y += step) {
+        const std::uint8_t* row = data + static_cast<std::size_t>(y) * stride;
+        for (int x = 0; x < width; x += step) {
+            const std::uint8_t* p = row + static_cast<std::size_t>(x) * 3;
+            ++stats.hist[0][p[0]];
+            ++stats.hist[1][p[1]];
+            ++stats.hist[2][p[2]];
+            ++stats.samples;
+        }
+    }
+}
+
+const char* lutKernelName() noexcept {
+    return lutKernel().name;
+}
+
+void ClaheEnhancer::setTiles(int tilesX, int tilesY) {
+    tilesX_ = std::clamp(tilesX, 1, 64);
+    tilesY_ = std::clamp(tilesY, 1, 64);
+    hasStats_ = false;
+    width_ = height_ = 0;
+}
+
+void ClaheEnhancer::resize(int width, int height) {
+    width_ = width;
+    height_ = height;
+    const std::size_t tiles = static_cast<std::size_t>(tilesX_) * tilesY_;
+    tileHist_.assign(tiles * 256, 0);
+    tileLut_.assign(tiles * 256, 0);
+    colTile_.resize(width);
+    colWeight_.resize(width);
+    colBin_.resize(width);
+    const double tw = static_cast<double>(width) / tilesX_;
+    for (int x = 0; x < width; ++x) {
+        colBin_[x] = std::min(static_cast<int>(x / tw), tilesX_ - 1);
+        // 以块中心为插值节点
+        const double fx = (x + 0.5) / tw - 0.5;
+        int t0 = static_cast<int>(std::floor(fx));
+        double w = fx - t0;
+        if (t0 < 0) {
+            t0 = 0;
+            w = 0.;
+        } else if (t0 >= tilesX_ - 1) {
+            t0 = tilesX_ - 1;
+            w = 0.;
+        }
+        colTile_[x] = t0;
+        colWeight_[x] = static_cast<std::uint16_t>(w * 256. + 0.5);
+    }
+}
+
+void ClaheEnhancer::sampleTiles(const std::uint8_t* data, int stride, bool bgr) {
+    const LumaWeights w = lumaWeights(bgr);
+    const double th = static_cast<double>(height_) / tilesY_;
+    for (int y = 0; y < height_; y += 2) {
+        const int ty = std::min(static_cast<int>(y / th), tilesY_ - 1);
+        const std::uint8_t* row = data + static_cast<std::size_t>(y) * stride;
+        std::uint32_t* base = tileHist_.data() + static_cast<std::size_t>(ty) * tilesX_ * 256;
+        for (int x = 0; x < width_; x += 2) {
+            ++base[colBin_[x] * 256 + luma(row + static_cast<std::size_t>(x) * 3, w)];
+        }
+    }
+}
+
+void ClaheEnhancer::buildLuts() {
+    const std::size_t tiles = static_cast<std::size_t>(tilesX_) * tilesY_;
+    for (std::size_t t = 0; t < tiles; ++t) {
+        std::uint32_t* h = tileHist_.data() + t * 256;
+        std::uint8_t* lut = tileLut_.data() + t * 256;
+        std::uint64_t n = 0;
+        for (int v = 0; v < 256; ++v) n += h[v];
+        if (n == 0) {
+            for (int v = 0; v < 256; ++v) lut[v] = static_cast<std::uint8_t>(v);
+            continue;
+        }
+        // 截断超出 clip 的计数并均匀重新分配，限制局部对比度放大倍数
+        const double clip = std::max(1., clipLimit_ * static_cast<double>(n) / 256.);
+        double excess = 0.;
+        for (int v = 0; v < 256; ++v) {
+            if (h[v] > clip) excess += h[v] - clip;
+        }
+        const double bonus = excess / 256.;
+        double cdf = 0.;
+        const double scale = 255. / static_cast<double>(n);
+        for (int v = 0; v < 256; ++v) {
+            cdf += std::min(static_cast<double>(h[v]), clip) + bonus;
+            lut[v] = static_cast<std::uint8_t>(std::min(255., cdf * scale + 0.5));
+        }
+    }
+}
+
+void ClaheEnhancer::apply(std::uint8_t* data, int width, int height, int stride, bool bgr, BrightnessStats* stats,
+                          int statsRowStep) {
+    if (!data || width <= 0 || height <= 0) return;
+    if (stride <= 0) stride = width * 3;
+    if (statsRowStep <= 0) statsRowStep = 1;
+    if (!hasStats_ || width != width_ || height != height_) {
+        resize(width, height);
+        sampleTiles(data, stride, bgr);
+    }
+    buildLuts();
+    std::fill(tileHist_.begin(), tileHist_.end(), 0u);
+
+    // 亮度增益 yy / y 以 Q16 倒数表计算
+    std::uint32_t recip[256];
+    recip[0] = 0;
+    for (int v = 1; v < 256; ++v) recip[v] = (1u << 16) / static_cast<std::uint32_t>(v);
+
+    const LumaWeights w = lumaWeights(bgr);
+    const double th = static_cast<double>(height) / tilesY_;
+    const std::size_t rowTiles = static_cast<std::size_t>(tilesX_) * 256;
+    for (int y = 0; y < height; ++y) {
+        const double fy = (y + 0.5) / th - 0.5;
+        int ty0 = static_cast<int>(std::floor(fy));
+        double wyf = fy - ty0;
+        if (ty0 < 0) {
+            ty0 = 0;
+            wyf = 0.;
+        } else if (ty0 >= tilesY_ - 1) {
+            ty0 = tilesY_ - 1;
+            wyf = 0.;
+        }
+        const int ty1 = std::min(ty0 + 1, tilesY_ - 1);
+        const std::uint32_t wy = static_cast<std::uint32_t>(wyf * 256. + 0.5);
+        const std::uint8_t* lutTop = tileLut_.data() + static_cast<std::size_t>(ty0) * rowTiles;
+        const std::uint8_t* lutBot = tileLut_.data() + static_cast<std::size_t>(ty1) * rowTiles;
+        const bool statsRow = y % statsRowStep == 0;
+        std::uint32_t* histRow =
+            tileHist_.data() + static_cast<std::size_t>(std::min(static_cast<int>(y / th), tilesY_ - 1)) * rowTiles;
+
+        std::uint8_t* row = data + static_cast<std::size_t>(y) * stride;
+        for (int x = 0; x < width; ++x) {
+            std::uint8_t* p = row + static_cast<std::size_t>(x) * 3;
+            const std::uint32_t l = luma(p, w);
+            if (statsRow) {
+                ++histRow[colBin_[x] * 256 + l];
+                if (stats) {
+                    ++stats->hist[0][p[0]];
+                    ++stats->hist[1][p[1]];
+                    ++stats->hist[2][p[2]];
+                }
+            }
+            const std::size_t t0 = static_cast<std::size_t>(colTile_[x]) * 256 + l;
+            const std::size_t t1 = static_cast<std::size_t>(std::min(colTile_[x] + 1, tilesX_ - 1)) * 256 + l;
+            const std::uint32_t wx = colWeight_[x];
+            const std::uint32_t top = lutTop[t0] * (256 - wx) + lutTop[t1] * wx;
+            const std::uint32_t bot = lutBot[t0] * (256 - wx) + lutBot[t1] * wx;
+            const std::uint32_t mapped = (top * (256 - wy) + bot * wy + (1u << 15)) >> 16;
+            if (l == 0) {
+                p[0] = p[1] = p[2] = static_cast<std::uint8_t>(mapped);
+                continue;
+            }
+            const std::uint32_t gain = mapped * recip[l];  // Q16
+            p[0] = static_cast<std::uint8_t>(std::min<std::uint32_t>(255, (p[0] * gain + (1u << 15)) >> 16));
+            p[1] = static_cast<std::uint8_t>(std::min<std::uint32_t>(255, (p[1] * gain + (1u << 15)) >> 16));
+            p[2] = static_cast<std::uint8_t>(std::min<std::uint32_t>(255, (p[2] * gain + (1u << 15)) >> 16));
+        }
+        if (stats && statsRow) stats->samples += static_cast<std::uint64_t>(width);
+    }
+    hasStats_ = true;
+}
+
+} // namespace falconmind::sdk::perception
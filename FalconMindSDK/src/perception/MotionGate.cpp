@@ -0,0 +1,280 @@
+#include "falconmind/sdk/perception/MotionGate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace falconmind::sdk::perception {
+
+using core::PixelFormat;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// out[i] = |a[i] − b[i]| > thr ? 0xFF : 0
+void diffMaskRow(const std::uint8_t* a, const std::uint8_t* b, int n, std::uint8_t thr, std::uint8_t* out) {
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i t = _mm_set1_epi8(static_cast<char>(thr));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi8(-1);
+    for (; i + 16 <= n; i += 16) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        const __m128i d = _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+        const __m128i within = _mm_cmpeq_epi8(_mm_subs_epu8(d, t), zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_andnot_si128(within, ones));
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    const uint8x16_t t = vdupq_n_u8(thr);
+    for (; i + 16 <= n; i += 16) vst1q_u8(out + i, vcgtq_u8(vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i)), t));
+#endif
+    for (; i < n; ++i) out[i] = std::abs(static_cast<int>(a[i]) - b[i]) > thr ? 0xFF : 0;
+}
+
+} // namespace
+
+CameraRotationDelta cameraRotationFromImu(const sensors::ImuPreintegration& preint, const GimbalPose& gimbal) {
+    // dq → 旋转向量（t0 机体系）
+    const double qw = preint.dq[0];
+    const double v[3] = {preint.dq[1], preint.dq[2], preint.dq[3]};
+    const double s = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    const double k = s < 1e-12 ? 2.0 : 2.0 * std::atan2(s, qw) / s;
+    const double w[3] = {v[0] * k, v[1] * k, v[2] * k};
+
+    // 转到云台系：R = Rz(yaw)·Ry(pitch)·Rx(roll)，ω_g = Rᵀ·ω_b
+    const double cy = std::cos(gimbal.yaw), sy = std::sin(gimbal.yaw);
+    const double cp = std::cos(gimbal.pitch), sp = std::sin(gimbal.pitch);
+    const double cr = std::cos(gimbal.roll), sr = std::sin(gimbal.roll);
+    const double r[3][3] = {{cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr},
+                            {sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr},
+                            {-sp, cp * sr, cp * cr}};
+    double g[3];
+    for (int i = 0; i < 3; ++i) g[i] = r[0][i] * w[0] + r[1][i] * w[1] + r[2][i] * w[2];
+
+    // 云台系 x 前 / y 右 / z 下 → 相机系 x 右 / y 下 / z 光轴
+    CameraRotationDelta out;
+    out.tilt = g[1];
+    out.pan = g[2];
+    out.roll = g[0];
+    return out;
+}
+
+MotionGate::MotionGate(MotionGateConfig config) : config_(std::move(config)) {
+    config_.step = std::max(1, config_.step);
+    config_.blockSamples = std::max(1, config_.blockSamples);
+    config_.sampleThreshold = std::clamp(config_.sampleThreshold, 0, 255);
+    config_.roiPadding = std::max(0, config_.roiPadding);
+}
+
+void MotionGate::setImuHistory(sensors::ImuHistoryPtr history, const GimbalPose& mount) {
+    imu_ = std::move(history);
+    mount_ = mount;
+}
+
+void MotionGate::reset() {
+    refLuma_.clear();
+    refTimestampNs_ = 0;
+    staticFrames_ = 0;
+}
+
+bool MotionGate::sampleLuma(const ImageView& image) {
+    int bpp = 0;  // 每像素字节数；RGB/BGR 取三通道加权和，NV12/YUYV 直接取 Y
+    switch (image.format) {
+        case PixelFormat::RGB8:
+        case PixelFormat::BGR8: bpp = 3; break;
+        case PixelFormat::NV12: bpp = 1; break;
+        case PixelFormat::YUYV: bpp = 2; break;
+        default: return false;
+    }
+    if (!image.data || image.width <= 0 || image.height <= 0) return false;
+    const int step = config_.step;
+    const int stride = image.stride > 0 ? image.stride : image.width * bpp;
+    gridW_ = (image.width + step - 1) / step;
+    gridH_ = (image.height + step - 1) / step;
+    luma_.resize(static_cast<std::size_t>(gridW_) * gridH_);
+    for (int gy = 0; gy < gridH_; ++gy) {
+        const std::uint8_t* row = image.data + static_cast<std::size_t>(gy) * step * stride;
+        std::uint8_t* dst = &luma_[static_cast<std::size_t>(gy) * gridW_];
+        for (int gx = 0; gx < gridW_; ++gx) {
+            const std::uint8_t* p = row + static_cast<std::size_t>(gx) * step * bpp;
+            dst[gx] = bpp == 3 ? static_cast<std::uint8_t>((p[0] + 2 * p[1] + p[2]) >> 2) : p[0];
+        }
+    }
+    return true;
+}
+
+void MotionGate::diffSamples(const CameraRotationDelta& rotation, int width) {
+    const auto thr = static_cast<std::uint8_t>(config_.sampleThreshold);
+    const double step = config_.step;
+    changed_.assign(luma_.size(), 0xFF);
+
+    // 画面平移（像素）与旋转：参考帧样本 q = R(roll)·(p − c − d) + c
+    double dx = 0., dy = 0., roll = 0.;
+    if (config_.hfovDeg > 0.) {
+        const double fx = 0.5 * width / std::tan(config_.hfovDeg * kPi / 360.);
+        dx = -fx * std::tan(rotation.pan);
+        dy = fx * std::tan(rotation.tilt);
+        roll = rotation.roll;
+    }
+    result_.shiftX = static_cast<float>(dx);
+    result_.shiftY = static_cast<float>(dy);
+    const double cxs = 0.5 * (gridW_ - 1);
+    const double cys = 0.5 * (gridH_ - 1);
+
+    if (std::abs(roll) * std::hypot(cxs, cys) < 0.5) {
+        // 整样本平移：逐行向量化求差
+        const int sx = static_cast<int>(std::lround(dx / step));
+        const int sy = static_cast<int>(std::lround(dy / step));
+        const int x0 = std::max(0, sx);
+        const int x1 = std::min(gridW_, gridW_ + sx);
+        for (int gy = 0; gy < gridH_; ++gy) {
+            const int ry = gy - sy;
+            if (ry < 0 || ry >= gridH_ || x1 <= x0) continue;
+            const std::size_t row = static_cast<std::size_t>(gy) * gridW_;
+            const std::size_t refRow = static_cast<std::size_t>(ry) * gridW_;
+            diffMaskRow(&luma_[row + x0], &refLuma_[refRow + x0 - sx], x1 - x0, thr, &changed_[row + x0]);
+        }
+        return;
+    }
+
+    const double c = std::cos(roll), s = std::sin(roll);
+    const double ox = cxs + dx / step;
+    const double oy = cys + dy / step;
+    for (int gy = 0; gy < gridH_; ++gy) {
+        for (int gx = 0; gx < gridW_; ++gx) {
+            const double px = gx - ox;
+            const double py = gy - oy;
+            const long rx = std::lround(c * px - s * py + cxs);
+            const long ry = std::lround(s * px + c * py + cys);
+            if (rx < 0 || ry < 0 || rx >= gridW_ || ry >= gridH_) continue;
+            const std::size_t i = static_cast<std::size_t>(gy) * gridW_ + gx;
+            const int ref = refLuma_[static_cast<std::size_t>(ry) * gridW_ + rx];
+            changed_[i] = std::abs(static_cast<int>(luma_[i]) - ref) > thr ? 0xFF : 0;
+        }
+    }
+}
+
+void MotionGate::buildRegions(int width, int height) {
+    const int bs = config_.blockSamples;
+    const int bw = (gridW_ + bs - 1) / bs;
+    const int bh = (gridH_ + bs - 1) / bs;
+    std::vector<int> counts(static_cast<std::size_t>(bw) * bh, 0);
+    for (int gy = 0; gy < gridH_; ++gy) {
+        const std::uint8_t* row = &changed_[static_cast<std::size_t>(gy) * gridW_];
+        int* blockRow = &counts[static_cast<std::size_t>(gy / bs) * bw];
+        for (int gx = 0; gx < gridW_; ++gx) blockRow[gx / bs] += row[gx] & 1;
+    }
+    blocks_.assign(counts.size(), 0);
+    std::size_t changedBlocks = 0;
+    for (int by = 0; by < bh; ++by) {
+        const int rows = std::min(bs, gridH_ - by * bs);
+        for (int bx = 0; bx < bw; ++bx) {
+            const int cols = std::min(bs, gridW_ - bx * bs);
+            const std::size_t i = static_cast<std::size_t>(by) * bw + bx;
+            if (counts[i] > 0 && counts[i] > config_.blockFraction * rows * cols) {
+                blocks_[i] = 1;
+                ++changedBlocks;
+            }
+        }
+    }
+    result_.changedFraction = static_cast<float>(changedBlocks) / static_cast<float>(blocks_.size());
+    result_.regions.clear();
+    if (changedBlocks == 0 || result_.changedFraction > config_.fullFrameFraction) return;
+
+    // 8 邻接的变化块合并为一个 ROI；访问过的块标记为 2
+    const int blockPx = bs * config_.step;
+    for (std::size_t seed = 0; seed < blocks_.size(); ++seed) {
+        if (blocks_[seed] != 1) continue;
+        int minX = bw, minY = bh, maxX = -1, maxY = -1;
+        stack_.assign(1, static_cast<int>(seed));
+        blocks_[seed] = 2;
+        while (!stack_.empty()) {
+            const int cur = stack_.back();
+            stack_.pop_back();
+            const int cx = cur % bw, cy = cur / bw;
+            minX = std::min(minX, cx);
+            maxX = std::max(maxX, cx);
+            minY = std::min(minY, cy);
+            maxY = std::max(maxY, cy);
+            for (int ny = std::max(0, cy - 1); ny <= std::min(bh - 1, cy + 1); ++ny) {
+                for (int nx = std::max(0, cx - 1); nx <= std::min(bw - 1, cx + 1); ++nx) {
+                    const std::size_t n = static_cast<std::size_t>(ny) * bw + nx;
+                    if (blocks_[n] != 1) continue;
+                    blocks_[n] = 2;
+                    stack_.push_back(static_cast<int>(n));
+                }
+            }
+        }
+        const int x0 = std::max(0, minX * blockPx - config_.roiPadding);
+        const int y0 = std::max(0, minY * blockPx - config_.roiPadding);
+        const int x1 = std::min(width, (maxX + 1) * blockPx + config_.roiPadding);
+        const int y1 = std::min(height, (maxY + 1) * blockPx + config_.roiPadding);
+        result_.regions.push_back(DetectionBBox{static_cast<float>(x0), static_cast<float>(y0),
+                                                static_cast<float>(x1 - x0), static_cast<float>(y1 - y0)});
+    }
+}
+
+const MotionGateResult& MotionGate::finish(MotionDecision decision, std::int64_t timestampNs) {
+    result_.decision = decision;
+    if (decision == MotionDecision::Skip) {
+        ++staticFrames_;
+        ++skipped_;
+        return result_;
+    }
+    if (decision == MotionDecision::Full) {
+        result_.regions.clear();
+        ++fullFrames_;
+    } else {
+        ++regionFrames_;
+    }
+    staticFrames_ = 0;
+    refLuma_.swap(luma_);
+    refTimestampNs_ = timestampNs;
+    return result_;
+}
+
+const MotionGateResult& MotionGate::evaluate(const ImageView& image, const CameraRotationDelta* rotation) {
+    result_.changedFraction = 1.f;
+    result_.shiftX = result_.shiftY = 0.f;
+    if (!sampleLuma(image)) {
+        finish(MotionDecision::Full, image.captureTimestampNs);
+        refLuma_.clear();  // 无法判断的格式不留参考帧
+        return result_;
+    }
+    if (refLuma_.size() != luma_.size() || refW_ != image.width || refH_ != image.height) {
+        refW_ = image.width;
+        refH_ = image.height;
+        return finish(MotionDecision::Full, image.captureTimestampNs);
+    }
+
+    CameraRotationDelta rot;
+    if (rotation) {
+        rot = *rotation;
+    } else if (imu_ && config_.hfovDeg > 0. && refTimestampNs_ > 0 && image.captureTimestampNs > refTimestampNs_) {
+        sensors::ImuPreintegration preint;
+        if (imu_->integrate(static_cast<std::uint64_t>(refTimestampNs_),
+                            static_cast<std::uint64_t>(image.captureTimestampNs), preint)) {
+            rot = cameraRotationFromImu(preint, mount_);
+        }
+    }
+    diffSamples(rot, image.width);
+    buildRegions(image.width, image.height);
+
+    if (result_.regions.empty() && result_.changedFraction == 0.f) {
+        const bool refresh = config_.maxStaticFrames > 0 && staticFrames_ + 1 >= config_.maxStaticFrames;
+        return finish(refresh ? MotionDecision::Full : MotionDecision::Skip, image.captureTimestampNs);
+    }
+    return finish(result_.regions.empty() ? MotionDecision::Full : MotionDecision::Regions, image.captureTimestampNs);
+}
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,279 @@
+#include "falconmind/sdk/perception/MultiStreamTrackerHost.h"
+#include "falconmind/sdk/core/BootProfiler.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/core/TimeSync.h"
+#include "falconmind/sdk/core/WorkerGroup.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace falconmind::sdk::perception {
+
+using core::PipelineClock;
+
+namespace {
+
+std::uint64_t localKey(std::size_t stream, int trackId) {
+    return (static_cast<std::uint64_t>(stream) << 32) | static_cast<std::uint32_t>(trackId);
+}
+
+bool hasMemberFrom(const FusedTrack& g, std::size_t stream) {
+    for (const auto& m : g.members) {
+        if (m.first == stream) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+MultiStreamTrackerHost::MultiStreamTrackerHost(std::size_t workers)
+    : workerCount_(workers > 0 ? workers : core::WorkerGroup::defaultCount()) {}
+
+MultiStreamTrackerHost::~MultiStreamTrackerHost() {
+    stop();
+}
+
+int MultiStreamTrackerHost::addStream(TrackerStreamConfig config) {
+    if (running_) {
+        std::cerr << "[MultiStreamTrackerHost] addStream() after start()" << std::endl;
+        return -1;
+    }
+    if (!config.backend) {
+        std::cerr << "[MultiStreamTrackerHost] stream " << config.id << " has no tracker backend" << std::endl;
+        return -1;
+    }
+    auto s = std::make_unique<Stream>();
+    s->config = std::move(config);
+    streams_.push_back(std::move(s));
+    return static_cast<int>(streams_.size() - 1);
+}
+
+bool MultiStreamTrackerHost::start() {
+    if (running_) return true;
+    for (auto& s : streams_) {
+        if (s->config.backend->isLoaded()) continue;
+        core::BootSpan span("load:tracker:" + s->config.id, "model");
+        if (!s->config.backend->load()) {
+            std::cerr << "[MultiStreamTrackerHost] tracker load failed for stream " << s->config.id << std::endl;
+            return false;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = false;
+    }
+    const std::size_t n = std::max<std::size_t>(1, std::min(workerCount_, std::max<std::size_t>(1, streams_.size())));
+    for (std::size_t i = 0; i < n; ++i) workers_.emplace_back([this] { workerLoop(); });
+    running_ = true;
+    std::cout << "[MultiStreamTrackerHost] start streams=" << streams_.size() << " workers=" << n << std::endl;
+    return true;
+}
+
+void MultiStreamTrackerHost::stop() {
+    if (!running_) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : workers_) t.join();
+    workers_.clear();
+    running_ = false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    ready_.clear();
+    active_ = 0;
+    for (auto& s : streams_) {
+        std::lock_guard<std::mutex> sl(s->mutex);
+        s->pending.clear();
+        s->scheduled = false;
+    }
+    idle_.notify_all();
+}
+
+bool MultiStreamTrackerHost::submit(std::size_t stream, DetectionResult result) {
+    if (!running_ || stream >= streams_.size()) return false;
+    Stream& s = *streams_[stream];
+    std::lock_guard<std::mutex> sl(s.mutex);
+    if (s.pending.size() >= maxQueued_) {
+        s.pending.pop_front();
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    s.pending.push_back(std::move(result));
+    if (!s.scheduled) {
+        s.scheduled = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_.push_back(stream);
+        }
+        wake_.notify_one();
+    }
+    return true;
+}
+
+void MultiStreamTrackerHost::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return stop_ || (ready_.empty() && active_ == 0); });
+}
+
+void MultiStreamTrackerHost::workerLoop() {
+    for (;;) {
+        std::size_t index;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stop_ || !ready_.empty(); });
+            if (stop_) return;
+            index = ready_.front();
+            ready_.pop_front();
+            ++active_;
+        }
+        process(index, *streams_[index]);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--active_ == 0 && ready_.empty()) idle_.notify_all();
+    }
+}
+
+void MultiStreamTrackerHost::process(std::size_t index, Stream& s) {
+    DetectionResult frame;
+    {
+        std::lock_guard<std::mutex> sl(s.mutex);
+        if (s.pending.empty()) {
+            s.scheduled = false;
+            return;
+        }
+        frame = std::move(s.pending.front());
+        s.pending.pop_front();
+    }
+
+    const std::int64_t t0 = PipelineClock::nowNs();
+    TrackingResult tracks;
+    bool ok = frame.trackerPredicted ? s.config.backend->predict(frame, tracks) : s.config.backend->run(frame, tracks);
+    if (ok) {
+        if (s.config.hasGroundHomography) fuse(index, s, tracks);
+        if (callback_) callback_(index, frame, tracks);
+    }
+    s.processed.fetch_add(1, std::memory_order_relaxed);
+    s.busyNs.fetch_add(static_cast<std::uint64_t>(PipelineClock::nowNs() - t0), std::memory_order_relaxed);
+
+    // 每次只处理一帧：仍有积压时排到就绪队列尾部，让其他流先行
+    std::lock_guard<std::mutex> sl(s.mutex);
+    if (s.pending.empty()) {
+        s.scheduled = false;
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready_.push_back(index);
+    }
+    wake_.notify_one();
+}
+
+void MultiStreamTrackerHost::fuse(std::size_t index, const Stream& s, const TrackingResult& tracks) {
+    core::ClockSyncPtr clock;
+    if (!s.config.clockId.empty()) clock = core::TimeSyncService::instance().clock(s.config.clockId);
+    const auto& hmat = s.config.imageToGround;
+    const double r2 = fusionRadius_ * fusionRadius_;
+
+    std::lock_guard<std::mutex> lock(fusionMutex_);
+    for (const auto& t : tracks.tracks) {
+        const std::uint64_t key = localKey(index, t.trackId);
+        auto mapped = localToGlobal_.find(key);
+        if (t.status == "LOST") {
+            if (mapped == localToGlobal_.end()) continue;
+            auto g = globals_.find(mapped->second);
+            if (g != globals_.end()) {
+                auto& m = g->second.members;
+                m.erase(std::remove(m.begin(), m.end(), std::make_pair(index, t.trackId)), m.end());
+                if (m.empty()) globals_.erase(g);
+            }
+            localToGlobal_.erase(mapped);
+            continue;
+        }
+        const TrackHistoryPoint* p = !t.history.empty() ? &t.history.back()
+                                     : !t.trajectory.empty() ? &t.trajectory.back() : nullptr;
+        if (!p) continue;
+
+        // 框底边中点（目标接地点）投影到地面坐标
+        const double u = p->bbox.x + p->bbox.width * 0.5;
+        const double v = p->bbox.y + p->bbox.height;
+        const double w = hmat(2, 0) * u + hmat(2, 1) * v + hmat(2, 2);
+        if (std::fabs(w) < 1e-12) continue;
+        const double gx = (hmat(0, 0) * u + hmat(0, 1) * v + hmat(0, 2)) / w;
+        const double gy = (hmat(1, 0) * u + hmat(1, 1) * v + hmat(1, 2)) / w;
+        std::int64_t ts = static_cast<std::int64_t>(p->timestampNs);
+        if (clock) {
+            const std::int64_t host = clock->toHost(ts);
+            if (host != 0) ts = host;
+        }
+
+        // 仅被本路观测的目标尝试与其他流最近的全局目标合并
+        const int current = mapped != localToGlobal_.end() ? mapped->second : 0;
+        FusedTrack* self = nullptr;
+        if (current != 0) {
+            auto it = globals_.find(current);
+            if (it != globals_.end()) self = &it->second;
+        }
+        if (!self || self->members.size() == 1) {
+            FusedTrack* best = nullptr;
+            double bestD2 = r2;
+            for (auto& kv : globals_) {
+                FusedTrack& g = kv.second;
+                if (g.globalId == current || hasMemberFrom(g, index)) continue;
+                if (std::llabs(g.timestampNs - ts) > fusionWindowNs_) continue;
+                const double dx = g.x - gx;
+                const double dy = g.y - gy;
+                const double d2 = dx * dx + dy * dy;
+                if (d2 <= bestD2) {
+                    bestD2 = d2;
+                    best = &g;
+                }
+            }
+            if (best) {
+                if (self) globals_.erase(current);
+                best->members.emplace_back(index, t.trackId);
+                localToGlobal_[key] = best->globalId;
+                self = best;
+            }
+        }
+        if (!self) {
+            FusedTrack g;
+            g.globalId = nextGlobalId_++;
+            g.members.emplace_back(index, t.trackId);
+            self = &(globals_[g.globalId] = std::move(g));
+            localToGlobal_[key] = self->globalId;
+        }
+        if (ts >= self->timestampNs) {
+            self->x = gx;
+            self->y = gy;
+            self->timestampNs = ts;
+        }
+    }
+}
+
+TrackerStreamStats MultiStreamTrackerHost::stats(std::size_t stream) const {
+    TrackerStreamStats st;
+    if (stream >= streams_.size()) return st;
+    const Stream& s = *streams_[stream];
+    st.processed = s.processed.load(std::memory_order_relaxed);
+    st.dropped = s.dropped.load(std::memory_order_relaxed);
+    st.busyNs = s.busyNs.load(std::memory_order_relaxed);
+    return st;
+}
+
+std::vector<FusedTrack> MultiStreamTrackerHost::fusedTracks() const {
+    std::lock_guard<std::mutex> lock(fusionMutex_);
+    std::vector<FusedTrack> out;
+    out.reserve(globals_.size());
+    for (const auto& kv : globals_) out.push_back(kv.second);
+    std::sort(out.begin(), out.end(), [](const FusedTrack& a, const FusedTrack& b) { return a.globalId < b.globalId; });
+    return out;
+}
+
+int MultiStreamTrackerHost::globalIdOf(std::size_t stream, int localTrackId) const {
+    std::lock_guard<std::mutex> lock(fusionMutex_);
+    auto it = localToGlobal_.find(localKey(stream, localTrackId));
+    return it != localToGlobal_.end() ? it->second : -1;
+}
+
+} // namespace falconmind::sdk::perception
@@ -1,11 +1,22 @@
 #include "falconmind/sdk/perception/OnnxRuntimeDetectorBackend.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/perception/ClassFilter.h"
 #include "falconmind/sdk/perception/YoloPrePostProcess.h"
 
+#include <algorithm>
 #include <iostream>
+#include <utility>
+#include <memory>
 #include <vector>
 
 #if defined(FALCONMINDSDK_ONNXRUNTIME_BACKEND_ENABLED) && FALCONMINDSDK_ONNXRUNTIME_BACKEND_ENABLED
 #include <onnxruntime_cxx_api.h>
+#if __has_include(<acl_provider_factory.h>)
+#include <acl_provider_factory.h>
+#define FALCONMINDSDK_ORT_HAS_ACL 1
+#endif
+
+#include <string>
 #endif
 
 namespace falconmind::sdk::perception {
@@ -21,8 +32,123 @@ struct OnnxRuntimeState {
     std::string outputName;
     int inputW{0};
     int inputH{0};
+    std::size_t maxBatch{1};
+    bool fixedBatch{true};  // 模型 batch 维为常数时每次必须送满 maxBatch 帧
+    std::unique_ptr<YoloPreprocessor> preprocessor;
+    std::vector<LetterboxTransform> transforms;
+    std::vector<std::string> providers;  // 实际启用的执行提供者
+    std::string trtCachePath;            // TensorRT EP 的 engine 缓存目录（ORT 只保存指针）
+
+    // 输入输出缓冲在 load() 时按 maxBatch 分配，inputValues/outputValues[b-1] 是 batch=b 时的张量视图；
+    // 模型输出形状含动态维（无法预分配）时 outputValues 为空，由 ORT 分配输出
+    std::vector<float> input;
+    std::vector<float> output;
+    std::size_t outputChannels{0};
+    std::size_t outputBoxes{0};
+    std::vector<Ort::Value> inputValues;
+    std::vector<Ort::Value> outputValues;
+    std::unique_ptr<Ort::IoBinding> binding;
+    std::size_t boundBatch{0};
+    Ort::RunOptions runOptions;
+    // 后处理复用的暂存
+    std::vector<char> valid;
+    std::vector<YoloRawDet> raw;
+    std::vector<bool> suppressed;
 };
 
+int intraOpThreads(const DetectorDescriptor& desc) {
+    return desc.intraOpThreads > 0 ? desc.intraOpThreads : 1;
+}
+
+// 按 executionProviders 顺序追加执行提供者；不可用（未编译进 ORT、缺驱动）的记录告警并跳过，CPU 始终兜底
+void appendExecutionProviders(Ort::SessionOptions& options, const DetectorDescriptor& desc, OnnxRuntimeState& state) {
+    std::vector<std::string>& applied = state.providers;
+    for (const std::string& ep : desc.executionProviders) {
+        if (ep == "cpu") break;  // 其后的提供者不会被用到
+        try {
+            if (ep == "cuda") {
+                OrtCUDAProviderOptions cuda{};
+                cuda.device_id = desc.deviceIndex;
+                options.AppendExecutionProvider_CUDA(cuda);
+            } else if (ep == "tensorrt" || ep == "trt") {
+                OrtTensorRTProviderOptions trt{};
+                trt.device_id = desc.deviceIndex;
+                trt.trt_max_partition_iterations = 1000;
+                trt.trt_min_subgraph_size = 1;
+                trt.trt_max_workspace_size = static_cast<size_t>(1) << 30;
+                trt.trt_fp16_enable = desc.precision == ModelPrecision::FP16 ? 1 : 0;
+                trt.trt_int8_enable = desc.precision == ModelPrecision::INT8 ? 1 : 0;
+                trt.trt_engine_cache_enable = 1;  // 首次构建 engine 耗时数分钟，缓存到模型所在目录
+                const auto slash = desc.modelPath.find_last_of('/');
+                state.trtCachePath = slash == std::string::npos ? "." : desc.modelPath.substr(0, slash);
+                trt.trt_engine_cache_path = state.trtCachePath.c_str();
+                options.AppendExecutionProvider_TensorRT(trt);
+            } else if (ep == "xnnpack") {
+                // XNNPACK 自带线程池：ORT 线程不自旋，避免两套线程争抢核
+                options.AppendExecutionProvider("XNNPACK", {{"intra_op_num_threads", std::to_string(intraOpThreads(desc))}});
+                options.AddConfigEntry("session.intra_op.allow_spinning", "0");
+            } else if (ep == "acl") {
+#if defined(FALCONMINDSDK_ORT_HAS_ACL)
+                Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_ACL(options, 1));
+#else
+                std::cerr << "[OnnxRuntimeDetectorBackend] execution provider acl not available in this build, skipped"
+                          << std::endl;
+                continue;
+#endif
+            } else {
+                std::cerr << "[OnnxRuntimeDetectorBackend] unknown execution provider: " << ep << std::endl;
+                continue;
+            }
+            applied.push_back(ep);
+        } catch (const Ort::Exception& e) {
+            std::cerr << "[OnnxRuntimeDetectorBackend] execution provider " << ep << " unavailable, skipped: "
+                      << e.what() << std::endl;
+        }
+    }
+    applied.push_back("cpu");
+}
+
+// 预分配输入输出并为每个可能的 batch 建好张量视图
+void allocateTensors(OnnxRuntimeState& state) {
+    const std::size_t plane = static_cast<std::size_t>(3) * state.inputH * state.inputW;
+    state.input.assign(state.maxBatch * plane, 0.f);
+    auto outShape = state.session->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+    const bool outputKnown = outShape.size() == 3 && outShape[1] > 0 && outShape[2] > 0;
+    if (outputKnown) {
+        state.outputChannels = static_cast<std::size_t>(outShape[1]);
+        state.outputBoxes = static_cast<std::size_t>(outShape[2]);
+        state.output.assign(state.maxBatch * state.outputChannels * state.outputBoxes, 0.f);
+    }
+    const std::size_t first = state.fixedBatch ? state.maxBatch : 1;
+    for (std::size_t b = first; b <= state.maxBatch; ++b) {
+        const std::int64_t inShape[4] = {static_cast<std::int64_t>(b), 3, state.inputH, state.inputW};
+        state.inputValues.push_back(Ort::Value::CreateTensor<float>(state.memoryInfo, state.input.data(), b * plane,
+                                                                    inShape, 4));
+        if (outputKnown) {
+            const std::int64_t shape[3] = {static_cast<std::int64_t>(b), static_cast<std::int64_t>(state.outputChannels),
+                                           static_cast<std::int64_t>(state.outputBoxes)};
+            state.outputValues.push_back(Ort::Value::CreateTensor<float>(
+                state.memoryInfo, state.output.data(), b * state.outputChannels * state.outputBoxes, shape, 3));
+        }
+    }
+    state.binding = std::make_unique<Ort::IoBinding>(*state.session);
+    state.valid.assign(state.maxBatch, 0);
+    state.raw.reserve(256);
+}
+
+// batch 变化时才重新绑定（固定 batch 的模型只绑定一次）
+void bindBatch(OnnxRuntimeState& state, std::size_t batch) {
+    if (state.boundBatch == batch) return;
+    const std::size_t index = state.fixedBatch ? 0 : batch - 1;
+    state.binding->BindInput(state.inputName.c_str(), state.inputValues[index]);
+    if (!state.outputValues.empty()) {
+        state.binding->BindOutput(state.outputName.c_str(), state.outputValues[index]);
+    } else {
+        state.binding->BindOutput(state.outputName.c_str(), state.memoryInfo);
+    }
+    state.boundBatch = batch;
+}
+
 } // namespace
 #endif
 
@@ -35,10 +161,12 @@ bool OnnxRuntimeDetectorBackend::load(const DetectorDescriptor& desc) {
     auto* state = new OnnxRuntimeState();
     state->inputW = desc_.inputWidth > 0 ? desc_.inputWidth : 640;
     state->inputH = desc_.inputHeight > 0 ? desc_.inputHeight : 640;
+    state->preprocessor = std::make_unique<YoloPreprocessor>(yoloPreprocessConfig(desc_));
 
     Ort::SessionOptions options;
-    options.SetIntraOpNumThreads(1);
+    options.SetIntraOpNumThreads(intraOpThreads(desc_));
     options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+    appendExecutionProviders(options, desc_, *state);
     try {
         state->session = new Ort::Session(state->env, desc_.modelPath.c_str(), options);
     } catch (const Ort::Exception& e) {
@@ -50,15 +178,35 @@ bool OnnxRuntimeDetectorBackend::load(const DetectorDescriptor& desc) {
     Ort::AllocatorWithDefaultOptions allocator;
     state->inputName = state->session->GetInputNameAllocated(0, allocator).get();
     state->outputName = state->session->GetOutputNameAllocated(0, allocator).get();
+    // batch 维：导出为动态（-1）时最多合并 max_batch 帧，否则以模型为准
+    auto modelShape = state->session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+    state->fixedBatch = !modelShape.empty() && modelShape[0] > 0;
+    state->maxBatch = state->fixedBatch ? static_cast<std::size_t>(modelShape[0])
+                                        : static_cast<std::size_t>(std::max(1, desc_.maxBatch));
+    state->transforms.resize(state->maxBatch);
+    try {
+        allocateTensors(*state);
+    } catch (const Ort::Exception& e) {
+        std::cerr << "[OnnxRuntimeDetectorBackend] tensor allocation failed: " << e.what() << std::endl;
+        delete state->session;
+        delete state;
+        return false;
+    }
 
     onnxState_ = state;
     loaded_ = true;
+    async_ = std::make_unique<AsyncInferenceQueue>(*this, 1);
+    std::string providers;
+    for (const auto& ep : state->providers) providers += (providers.empty() ? "" : ",") + ep;
     std::cout << "[OnnxRuntimeDetectorBackend] loaded: " << desc_.modelPath
               << " input=" << state->inputName << " output=" << state->outputName
-              << " " << state->inputW << "x" << state->inputH << std::endl;
+              << " " << state->inputW << "x" << state->inputH
+              << " batch=" << state->maxBatch << (state->fixedBatch ? "" : " (dynamic)")
+              << " providers=" << providers << " threads=" << intraOpThreads(desc_) << std::endl;
     return true;
 #else
     loaded_ = true;
+    async_ = std::make_unique<AsyncInferenceQueue>(*this, 1);
     std::cout << "[OnnxRuntimeDetectorBackend] load (stub): " << desc_.modelPath
               << " (id=" << desc_.detectorId << ")" << std::endl;
     return true;
@@ -66,9 +214,14 @@ bool OnnxRuntimeDetectorBackend::load(const DetectorDescriptor& desc) {
 }
 
 void OnnxRuntimeDetectorBackend::unload() {
+    async_.reset();  // 等待在途的异步推理完成
 #if defined(FALCONMINDSDK_ONNXRUNTIME_BACKEND_ENABLED) && FALCONMINDSDK_ONNXRUNTIME_BACKEND_ENABLED
     if (onnxState_) {
         auto* state = static_cast<OnnxRuntimeState*>(onnxState_);
+        // IoBinding 与张量视图引用 session/缓冲，先于 session 释放
+        state->binding.reset();
+        state->inputValues.clear();
+        state->outputValues.clear();
         if (state->session) {
             delete state->session;
             state->session = nullptr;
@@ -83,7 +236,36 @@ void OnnxRuntimeDetectorBackend::unload() {
     loaded_ = false;
 }
 
+bool OnnxRuntimeDetectorBackend::submit(const ImageView& image, DetectionResult& outResult, DetectionCallback done) {
+    if (!async_) return IDetectorBackend::submit(image, outResult, std::move(done));
+    return async_->submit(image, outResult, std::move(done));
+}
+
+std::size_t OnnxRuntimeDetectorBackend::maxInFlight() const {
+    return async_ ? async_->depth() : 1;
+}
+
+std::vector<core::PixelFormat> OnnxRuntimeDetectorBackend::supportedPixelFormats() const {
+    return YoloPreprocessor::pixelFormats();
+}
+
+bool OnnxRuntimeDetectorBackend::setClassFilter(const std::vector<int>& classIds) {
+    classFilter_ = normalizeClassIds(classIds);
+    return true;
+}
+
+std::size_t OnnxRuntimeDetectorBackend::maxBatchSize() const {
+#if defined(FALCONMINDSDK_ONNXRUNTIME_BACKEND_ENABLED) && FALCONMINDSDK_ONNXRUNTIME_BACKEND_ENABLED
+    if (onnxState_) return static_cast<OnnxRuntimeState*>(onnxState_)->maxBatch;
+#endif
+    return 1;
+}
+
 bool OnnxRuntimeDetectorBackend::run(const ImageView& image, DetectionResult& outResult) {
+    return runBatch(&image, &outResult, 1);
+}
+
+bool OnnxRuntimeDetectorBackend::runBatch(const ImageView* images, DetectionResult* results, std::size_t count) {
     if (!loaded_) {
         std::cerr << "[OnnxRuntimeDetectorBackend] run() called before load()" << std::endl;
         return false;
@@ -97,50 +279,91 @@ bool OnnxRuntimeDetectorBackend::run(const ImageView& image, DetectionResult& ou
     const int inputH = state->inputH;
     const int numClasses = desc_.numClasses > 0 ? desc_.numClasses : 80;
     const float scoreThr = desc_.scoreThreshold > 0 ? desc_.scoreThreshold : 0.25f;
-    const float nmsThr = desc_.nmsThreshold >= 0 ? desc_.nmsThreshold : 0.45f;
-
-    std::vector<float> inputTensor(1 * 3 * inputH * inputW);
-    int srcStride = image.stride > 0 ? image.stride : (image.width * 3);
-    bool bgr = (image.pixelFormat == "BGR8" || image.pixelFormat == "bgr8");
-    resizeImageToFloatNchw(image.data, image.width, image.height, srcStride, bgr,
-                           inputTensor.data(), inputW, inputH);
-
-    std::vector<int64_t> inputShape = {1, 3, inputH, inputW};
-    Ort::Value inputOrt = Ort::Value::CreateTensor<float>(
-        state->memoryInfo, inputTensor.data(), inputTensor.size(),
-        inputShape.data(), inputShape.size());
-
-    auto outputTensors = state->session->Run(Ort::RunOptions{nullptr},
-        state->inputName.c_str(), &inputOrt, 1,
-        state->outputName.c_str(), 1);
-
-    float* outputData = outputTensors[0].GetTensorMutableData<float>();
-    auto outputShape = outputTensors[0].GetTensorTypeAndShapeInfo().GetShape();
-    // YOLOv8/v11: (1, 84, 8400) 或 (1, 4+numClasses, numBoxes)
-    size_t numChannels = outputShape.size() >= 2 ? static_cast<size_t>(outputShape[1]) : 84;
-    size_t numBoxes = outputShape.size() >= 3 ? static_cast<size_t>(outputShape[2]) : 8400;
-    std::vector<YoloRawDet> raw;
-    decodeYoloOutput84xN(outputData, numChannels, numBoxes, numClasses, scoreThr, raw);
-    if (raw.empty()) {
-        outResult.detections.clear();
-        outResult.frameIndex = 0;
-        outResult.timestampNs = 0;
-        return true;
-    }
+    const NmsConfig nmsCfg = nmsConfig(desc_);
+    const std::size_t plane = static_cast<std::size_t>(3) * inputH * inputW;
 
-    std::vector<bool> suppressed;
-    nmsYoloDetections(raw, nmsThr, suppressed);
-    float scaleX = (image.width > 0 && inputW > 0) ? (image.width / static_cast<float>(inputW)) : 1.0f;
-    float scaleY = (image.height > 0 && inputH > 0) ? (image.height / static_cast<float>(inputH)) : 1.0f;
-    fillDetectionResultFromYolo(raw, suppressed, scaleX, scaleY, outResult);
-    return true;
+    bool allOk = true;
+    std::vector<char>& valid = state->valid;
+    std::vector<YoloRawDet>& raw = state->raw;
+    std::vector<bool>& suppressed = state->suppressed;
+    for (std::size_t first = 0; first < count; first += state->maxBatch) {
+        const std::size_t n = std::min(state->maxBatch, count - first);
+        // 按帧格式（RGB8/BGR8/NV12/YUYV）一趟完成颜色转换、缩放与归一化，写入 batch 中各自的切片
+        InputTensorSpec spec;
+        spec.width = inputW;
+        spec.height = inputH;
+        StageTimer timer(desc_.profiling);
+        for (std::size_t b = 0; b < n; ++b) {
+            const ImageView& image = images[first + b];
+            results[first + b].detections.clear();
+            results[first + b].frameIndex = image.frameIndex;
+            results[first + b].timestampNs = static_cast<std::uint64_t>(image.captureTimestampNs);
+            results[first + b].timing = DetectionTiming{};
+            valid[b] = state->preprocessor->run(image, spec, state->input.data() + b * plane, state->transforms[b]);
+            results[first + b].timing.preprocessUs = timer.lapUs();
+            if (!valid[b]) {
+                std::cerr << "[OnnxRuntimeDetectorBackend] unsupported input " << image.width << "x" << image.height
+                          << " format=" << image.pixelFormat << std::endl;
+                allOk = false;
+            }
+        }
+        if (std::find(valid.begin(), valid.begin() + n, 1) == valid.begin() + n) continue;
+
+        // 固定 batch 的模型送满 maxBatch 帧，多出的切片沿用上一次的内容，结果丢弃
+        const std::size_t batch = state->fixedBatch ? state->maxBatch : n;
+        // 输入输出已绑定到预分配缓冲，推理直接读写，逐帧不再分配张量
+        std::vector<Ort::Value> dynamicOutputs;
+        try {
+            bindBatch(*state, batch);
+            state->session->Run(state->runOptions, *state->binding);
+            if (state->outputValues.empty()) dynamicOutputs = state->binding->GetOutputValues();
+        } catch (const Ort::Exception& e) {
+            std::cerr << "[OnnxRuntimeDetectorBackend] Run failed (batch=" << batch << "): " << e.what() << std::endl;
+            state->boundBatch = 0;
+            allOk = false;
+            continue;
+        }
+        // batch 内各帧等待的是同一次推理：推理耗时记为整个 batch 的墙钟
+        const std::uint32_t inferUs = timer.lapUs();
+
+        // YOLOv8/v11: (batch, 84, 8400) 或 (batch, 4+numClasses, numBoxes)
+        const float* outputData = state->output.data();
+        size_t numChannels = state->outputChannels;
+        size_t numBoxes = state->outputBoxes;
+        if (!dynamicOutputs.empty()) {
+            outputData = dynamicOutputs[0].GetTensorData<float>();
+            auto outputShape = dynamicOutputs[0].GetTensorTypeAndShapeInfo().GetShape();
+            numChannels = outputShape.size() >= 2 ? static_cast<size_t>(outputShape[1]) : 84;
+            numBoxes = outputShape.size() >= 3 ? static_cast<size_t>(outputShape[2]) : 8400;
+        }
+        for (std::size_t b = 0; b < n; ++b) {
+            if (!valid[b]) continue;
+            const ImageView& image = images[first + b];
+            DetectionTiming& timing = results[first + b].timing;
+            timing.inferUs = inferUs;
+            timer.lapUs();
+            raw.clear();
+            decodeYoloOutput84xN(outputData + b * numChannels * numBoxes, numChannels, numBoxes, numClasses,
+                                 scoreThr, raw, classFilter_);
+            timing.decodeUs = timer.lapUs();
+            if (raw.empty()) continue;
+            nmsYoloDetections(raw, nmsCfg, suppressed);
+            fillDetectionResultFromYolo(raw, suppressed, state->transforms[b], image.width, image.height,
+                                        results[first + b]);
+            results[first + b].timing.nmsUs = timer.lapUs();
+        }
+    }
+    return allOk;
 #else
-    std::cout << "[OnnxRuntimeDetectorBackend] run() (stub): " << image.width << "x" << image.height
-              << " format=" << image.pixelFormat << " model=" << desc_.modelPath << std::endl;
-    outResult.detections.clear();
-    outResult.frameId.clear();
-    outResult.frameIndex = 0;
-    outResult.timestampNs = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const ImageView& image = images[i];
+        FM_LOG_DEBUG("OnnxRuntimeDetectorBackend", "run() (stub): ", image.width, "x", image.height,
+                     " format=", image.pixelFormat, " model=", desc_.modelPath);
+        results[i].detections.clear();
+        results[i].frameId.clear();
+        results[i].frameIndex = image.frameIndex;
+        results[i].timestampNs = static_cast<std::uint64_t>(image.captureTimestampNs);
+    }
     return true;
 #endif
 }
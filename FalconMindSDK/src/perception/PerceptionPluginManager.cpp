@@ -1,9 +1,55 @@
 #include "falconmind/sdk/perception/PerceptionPluginManager.h"
+#include "falconmind/sdk/core/BootProfiler.h"
+#include "falconmind/sdk/perception/CascadeDetectorBackend.h"
+#include "falconmind/sdk/perception/TiledDetectorBackend.h"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
+#include <system_error>
 
 namespace falconmind::sdk::perception {
 
+namespace {
+
+// 以模型输入尺寸的灰帧（letterbox 填充色）推理 runs 次，触发首帧的内存分配、内核选择与 NPU 初始化
+void warmUp(IDetectorBackend& backend, const DetectorDescriptor& desc) {
+    if (desc.warmupRuns <= 0) return;
+    const int w = desc.inputWidth > 0 ? desc.inputWidth : 640;
+    const int h = desc.inputHeight > 0 ? desc.inputHeight : 640;
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(w) * h * 3, 114);
+    ImageView view;
+    view.data = pixels.data();
+    view.width = w;
+    view.height = h;
+    view.stride = w * 3;
+    view.format = core::PixelFormat::RGB8;
+    view.pixelFormat = "RGB8";
+    DetectionResult result;
+    for (int i = 0; i < desc.warmupRuns; ++i) {
+        backend.run(view, result);
+    }
+}
+
+std::uint64_t estimateBytes(const DetectorDescriptor& desc) {
+    if (desc.memoryBytes > 0) return desc.memoryBytes;
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(desc.modelPath, ec);
+    return ec ? 0 : static_cast<std::uint64_t>(size);
+}
+
+} // namespace
+
+PerceptionPluginManager::~PerceptionPluginManager() {
+    {
+        std::lock_guard<std::mutex> lock(residentMutex_);
+        stopping_ = true;
+    }
+    preloadCv_.notify_all();
+    if (loader_.joinable()) loader_.join();
+}
+
 void PerceptionPluginManager::registerDetectorBackend(const std::string& backendKey,
                                                       DetectionBackendType type,
                                                       DetectorFactory factory) {
@@ -17,48 +63,109 @@ void PerceptionPluginManager::registerDetectorDescriptor(const DetectorDescripto
 }
 
 DetectorBackendPtr PerceptionPluginManager::createDetector(const std::string& detectorId) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    return instantiate(detectorId, nullptr);
+}
 
-    auto it = detectorDescs_.find(detectorId);
-    if (it == detectorDescs_.end()) {
-        std::cerr << "[PerceptionPluginManager] detectorId not found: " << detectorId << std::endl;
-        return nullptr;
-    }
-    const DetectorDescriptor& desc = it->second;
+DetectorBackendPtr PerceptionPluginManager::instantiate(const std::string& detectorId,
+                                                        DetectorDescriptor* descOut, int cascadeDepth) const {
+    DetectorDescriptor desc;
+    DetectorFactory factory;
+    std::shared_ptr<DetectorAutotuner> autotuner;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = detectorDescs_.find(detectorId);
+        if (it == detectorDescs_.end()) {
+            std::cerr << "[PerceptionPluginManager] detectorId not found: " << detectorId << std::endl;
+            return nullptr;
+        }
+        desc = it->second;
 
-    // backendKey 目前简单使用 backendType 名称，后续可结合 deviceType/硬件平台细分
-    std::string backendKey;
-    switch (desc.backendType) {
-    case DetectionBackendType::OnnxRuntime: backendKey = "onnxruntime"; break;
-    case DetectionBackendType::Rknn:        backendKey = "rknn"; break;
-    case DetectionBackendType::TensorRt:    backendKey = "tensorrt"; break;
-    case DetectionBackendType::CpuReference:backendKey = "cpu"; break;
-    default:                                backendKey = "unknown"; break;
-    }
+        // backendKey 目前简单使用 backendType 名称，后续可结合 deviceType/硬件平台细分
+        std::string backendKey;
+        switch (desc.backendType) {
+        case DetectionBackendType::OnnxRuntime: backendKey = "onnxruntime"; break;
+        case DetectionBackendType::Rknn:        backendKey = "rknn"; break;
+        case DetectionBackendType::TensorRt:    backendKey = "tensorrt"; break;
+        case DetectionBackendType::CpuReference:backendKey = "cpu"; break;
+        default:                                backendKey = "unknown"; break;
+        }
 
-    auto itBackend = backendFactories_.find(backendKey);
-    if (itBackend == backendFactories_.end() || !itBackend->second.factory) {
-        std::cerr << "[PerceptionPluginManager] backend factory not found for key: "
-                  << backendKey << std::endl;
-        return nullptr;
+        auto itBackend = backendFactories_.find(backendKey);
+        if (itBackend == backendFactories_.end() || !itBackend->second.factory) {
+            std::cerr << "[PerceptionPluginManager] backend factory not found for key: "
+                      << backendKey << std::endl;
+            return nullptr;
+        }
+        factory = itBackend->second.factory;
+        autotuner = autotuner_;
     }
 
-    DetectorBackendPtr backend = itBackend->second.factory();
+    // 调优结果覆盖描述中的线程数 / 上下文数 / batch 等；首次遇到该模型时在此实测（不持锁）
+    TunedBackendConfig tuned;
+    const bool haveTuned = autotuner && autotuner->resolve(desc, factory, tuned);
+    if (haveTuned) tuned.applyTo(desc);
+
+    // 模型加载可能耗时数秒：不持锁，预加载期间仍可查询与创建其他检测器
+    DetectorBackendPtr backend = factory();
     if (!backend) {
-        std::cerr << "[PerceptionPluginManager] backend factory returned nullptr for key: "
-                  << backendKey << std::endl;
+        std::cerr << "[PerceptionPluginManager] backend factory returned nullptr for detectorId: "
+                  << detectorId << std::endl;
         return nullptr;
     }
+    // 配置了切片尺寸时由 TiledDetectorBackend 包装，load() 一并加载内层后端
+    if (desc.tileWidth > 0) {
+        backend = std::make_shared<TiledDetectorBackend>(std::move(backend));
+    }
+    // 配置了确认检测器时由 CascadeDetectorBackend 包装：确认检测器先按自身描述加载
+    if (!desc.cascadeDetectorId.empty()) {
+        constexpr int kMaxCascadeDepth = 4;
+        if (desc.cascadeDetectorId == detectorId || cascadeDepth >= kMaxCascadeDepth) {
+            std::cerr << "[PerceptionPluginManager] cascade_detector loop for detectorId: " << detectorId << std::endl;
+            return nullptr;
+        }
+        DetectorBackendPtr confirm = instantiate(desc.cascadeDetectorId, nullptr, cascadeDepth + 1);
+        if (!confirm) {
+            std::cerr << "[PerceptionPluginManager] cascade_detector " << desc.cascadeDetectorId
+                      << " unavailable for detectorId: " << detectorId << std::endl;
+            return nullptr;
+        }
+        backend = std::make_shared<CascadeDetectorBackend>(std::move(backend), std::move(confirm));
+    }
 
-    if (!backend->load(desc)) {
+    bool loaded = false;
+    {
+        core::BootSpan span("load:" + detectorId, "model");
+        loaded = backend->load(desc);
+    }
+    if (!loaded) {
         std::cerr << "[PerceptionPluginManager] backend load() failed for detectorId: "
                   << detectorId << std::endl;
         return nullptr;
     }
-
+    if (haveTuned && tuned.npuCoreMask != 0 && !backend->setNpuCoreMask(tuned.npuCoreMask)) {
+        std::cerr << "[PerceptionPluginManager] tuned npu_core_mask not applied for detectorId: " << detectorId
+                  << std::endl;
+    }
+    if (descOut) *descOut = desc;
     return backend;
 }
 
+void PerceptionPluginManager::setAutotuneOptions(AutotuneOptions options) {
+    auto tuner = std::make_shared<DetectorAutotuner>(std::move(options));
+    std::lock_guard<std::mutex> lock(mutex_);
+    autotuner_ = std::move(tuner);
+}
+
+void PerceptionPluginManager::disableAutotune() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    autotuner_.reset();
+}
+
+std::shared_ptr<DetectorAutotuner> PerceptionPluginManager::autotuner() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return autotuner_;
+}
+
 std::vector<DetectorDescriptor> PerceptionPluginManager::listDetectors() const {
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<DetectorDescriptor> result;
@@ -69,5 +176,178 @@ std::vector<DetectorDescriptor> PerceptionPluginManager::listDetectors() const {
     return result;
 }
 
+void PerceptionPluginManager::loadResident(const std::string& detectorId,
+                                           std::promise<DetectorBackendPtr>& promise) {
+    const auto t0 = std::chrono::steady_clock::now();
+    DetectorDescriptor desc;
+    DetectorBackendPtr backend = instantiate(detectorId, &desc);
+    if (backend) {
+        core::BootSpan span("warmup:" + detectorId, "model");
+        warmUp(*backend, desc);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+
+    std::vector<DetectorBackendPtr> evicted;
+    {
+        std::lock_guard<std::mutex> lock(residentMutex_);
+        auto it = resident_.find(detectorId);
+        if (!backend) {
+            if (it != resident_.end()) resident_.erase(it);
+        } else if (it != resident_.end()) {
+            it->second.bytes = estimateBytes(desc);
+            it->second.lastUse = ++useClock_;
+        }
+        // 先兑现再淘汰：淘汰只考虑已就绪的项
+        promise.set_value(backend);
+        if (backend) evictLocked(detectorId, evicted);
+    }
+    for (auto& b : evicted) b->unload();
+    if (backend) {
+        std::cout << "[PerceptionPluginManager] resident: " << detectorId << " loaded + " << desc.warmupRuns
+                  << " warm-up run(s) in " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms"
+                  << std::endl;
+    }
+}
+
+void PerceptionPluginManager::evictLocked(const std::string& keep, std::vector<DetectorBackendPtr>& evicted) {
+    if (residentBudget_ == 0) return;
+    for (;;) {
+        std::uint64_t total = 0;
+        auto victim = resident_.end();
+        for (auto it = resident_.begin(); it != resident_.end(); ++it) {
+            if (it->second.ready.wait_for(std::chrono::seconds(0)) != std::future_status::ready) continue;
+            total += it->second.bytes;
+            // 只淘汰管理器是唯一持有者的 backend（future 内一份）
+            if (it->first == keep || it->second.ready.get().use_count() > 1) continue;
+            if (victim == resident_.end() || it->second.lastUse < victim->second.lastUse) victim = it;
+        }
+        if (total <= residentBudget_) return;
+        if (victim == resident_.end()) {
+            std::cerr << "[PerceptionPluginManager] resident detectors use " << total << " bytes, over budget "
+                      << residentBudget_ << " (all in use)" << std::endl;
+            return;
+        }
+        std::cout << "[PerceptionPluginManager] evict resident detector: " << victim->first << std::endl;
+        evicted.push_back(victim->second.ready.get());
+        resident_.erase(victim);
+    }
+}
+
+DetectorBackendPtr PerceptionPluginManager::acquireDetector(const std::string& detectorId) {
+    for (;;) {
+        std::shared_future<DetectorBackendPtr> ready;
+        std::promise<DetectorBackendPtr> promise;
+        bool loadHere = false;
+        {
+            std::lock_guard<std::mutex> lock(residentMutex_);
+            auto it = resident_.find(detectorId);
+            if (it == resident_.end()) {
+                ResidentEntry entry;
+                entry.ready = promise.get_future().share();
+                it = resident_.emplace(detectorId, std::move(entry)).first;
+                loadHere = true;
+            }
+            it->second.lastUse = ++useClock_;
+            ready = it->second.ready;
+            // 已就绪：锁内取得引用，之后不会被淘汰
+            if (!loadHere && ready.wait_for(std::chrono::seconds(0)) == std::future_status::ready) return ready.get();
+        }
+        if (loadHere) loadResident(detectorId, promise);
+        DetectorBackendPtr backend = ready.get();  // 预加载中时在此等待
+        if (!backend) return nullptr;
+        // 就绪到取得引用之间可能已被淘汰（并已卸载）：确认仍常驻，否则重新加载
+        std::lock_guard<std::mutex> lock(residentMutex_);
+        auto it = resident_.find(detectorId);
+        if (it != resident_.end() && it->second.ready.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+            it->second.ready.get() == backend) {
+            return backend;
+        }
+    }
+}
+
+void PerceptionPluginManager::preloadDetector(const std::string& detectorId) {
+    {
+        std::lock_guard<std::mutex> lock(residentMutex_);
+        if (stopping_ || resident_.count(detectorId)) return;
+        auto promise = std::make_shared<std::promise<DetectorBackendPtr>>();
+        ResidentEntry entry;
+        entry.ready = promise->get_future().share();
+        resident_.emplace(detectorId, std::move(entry));
+        preloadQueue_.emplace_back(detectorId, std::move(promise));
+        if (!loader_.joinable()) loader_ = std::thread([this] { loaderLoop(); });
+    }
+    preloadCv_.notify_one();
+}
+
+void PerceptionPluginManager::loaderLoop() {
+    std::unique_lock<std::mutex> lock(residentMutex_);
+    for (;;) {
+        preloadCv_.wait(lock, [this] { return stopping_ || !preloadQueue_.empty(); });
+        if (preloadQueue_.empty()) return;  // stopping_
+        auto job = std::move(preloadQueue_.front());
+        preloadQueue_.pop_front();
+        lock.unlock();
+        loadResident(job.first, *job.second);
+        lock.lock();
+    }
+}
+
+void PerceptionPluginManager::setResidentMemoryBudget(std::uint64_t bytes) {
+    std::vector<DetectorBackendPtr> evicted;
+    {
+        std::lock_guard<std::mutex> lock(residentMutex_);
+        residentBudget_ = bytes;
+        evictLocked(std::string(), evicted);
+    }
+    for (auto& b : evicted) b->unload();
+}
+
+std::uint64_t PerceptionPluginManager::residentMemoryBudget() const {
+    std::lock_guard<std::mutex> lock(residentMutex_);
+    return residentBudget_;
+}
+
+std::vector<std::string> PerceptionPluginManager::residentDetectors() const {
+    std::vector<std::pair<std::uint64_t, std::string>> ready;
+    {
+        std::lock_guard<std::mutex> lock(residentMutex_);
+        for (const auto& kv : resident_) {
+            if (kv.second.ready.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                ready.emplace_back(kv.second.lastUse, kv.first);
+            }
+        }
+    }
+    std::sort(ready.begin(), ready.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::vector<std::string> ids;
+    for (auto& r : ready) ids.push_back(std::move(r.second));
+    return ids;
+}
+
+std::uint64_t PerceptionPluginManager::residentBytes() const {
+    std::lock_guard<std::mutex> lock(residentMutex_);
+    std::uint64_t total = 0;
+    for (const auto& kv : resident_) {
+        if (kv.second.ready.wait_for(std::chrono::seconds(0)) == std::future_status::ready) total += kv.second.bytes;
+    }
+    return total;
+}
+
+void PerceptionPluginManager::releaseResidentDetectors() {
+    std::vector<DetectorBackendPtr> evicted;
+    {
+        std::lock_guard<std::mutex> lock(residentMutex_);
+        for (auto it = resident_.begin(); it != resident_.end();) {
+            if (it->second.ready.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+                it->second.ready.get().use_count() == 1) {
+                evicted.push_back(it->second.ready.get());
+                it = resident_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto& b : evicted) b->unload();
+}
+
 } // namespace falconmind::sdk::perception
 
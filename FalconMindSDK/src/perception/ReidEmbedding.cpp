@@ -0,0 +1,125 @@
+#include "falconmind/sdk/perception/ReidEmbedding.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace falconmind::sdk::perception {
+
+bool cropImageView(const ImageView& frame, const DetectionBBox& box, ImageView& out) {
+    const core::PixelFormat format =
+        frame.format != core::PixelFormat::Any ? frame.format : core::parsePixelFormat(frame.pixelFormat);
+    if (!frame.data || frame.width <= 0 || frame.height <= 0 ||
+        (format != core::PixelFormat::RGB8 && format != core::PixelFormat::BGR8)) {
+        return false;
+    }
+    const int x0 = std::max(0, static_cast<int>(std::floor(box.x)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(box.y)));
+    const int x1 = std::min(frame.width, static_cast<int>(std::ceil(box.x + box.width)));
+    const int y1 = std::min(frame.height, static_cast<int>(std::ceil(box.y + box.height)));
+    if (x1 <= x0 || y1 <= y0) return false;
+
+    const int stride = frame.stride > 0 ? frame.stride : frame.width * 3;
+    out = frame;
+    out.data = frame.data + static_cast<std::size_t>(y0) * stride + static_cast<std::size_t>(x0) * 3;
+    out.width = x1 - x0;
+    out.height = y1 - y0;
+    out.stride = stride;
+    out.format = format;
+    out.dmabufFd = -1;  // 子视图不是整块 DMABUF
+    return true;
+}
+
+bool normalizeEmbedding(float* v, std::size_t dim) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < dim; ++i) sum += static_cast<double>(v[i]) * v[i];
+    if (!(sum > 0.0)) return false;
+    const float inv = static_cast<float>(1.0 / std::sqrt(sum));
+    for (std::size_t i = 0; i < dim; ++i) v[i] *= inv;
+    return true;
+}
+
+BackendEmbeddingExtractor::BackendEmbeddingExtractor(DetectorBackendPtr backend) : backend_(std::move(backend)) {}
+
+std::size_t BackendEmbeddingExtractor::dim() const {
+    return backend_ ? backend_->embeddingDim() : 0;
+}
+
+bool BackendEmbeddingExtractor::extract(const ImageView& frame, const DetectionBBox* boxes, std::size_t count,
+                                        std::vector<float>& out, std::vector<bool>& valid) {
+    const std::size_t d = dim();
+    valid.assign(count, false);
+    if (d == 0) {
+        out.clear();
+        std::cerr << "[BackendEmbeddingExtractor] backend has no embedding model" << std::endl;
+        return false;
+    }
+    out.assign(count * d, 0.f);
+
+    crops_.clear();
+    cropIndex_.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        ImageView crop;
+        if (!cropImageView(frame, boxes[i], crop)) continue;
+        crops_.push_back(crop);
+        cropIndex_.push_back(i);
+    }
+
+    const std::size_t batch = std::max<std::size_t>(1, backend_->maxBatchSize());
+    bool ok = true;
+    for (std::size_t begin = 0; begin < crops_.size(); begin += batch) {
+        const std::size_t n = std::min(batch, crops_.size() - begin);
+        if (!backend_->runEmbeddings(crops_.data() + begin, n, batchOut_) || batchOut_.size() < n * d) {
+            ok = false;
+            continue;
+        }
+        for (std::size_t k = 0; k < n; ++k) {
+            const std::size_t i = cropIndex_[begin + k];
+            float* row = out.data() + i * d;
+            std::copy_n(batchOut_.data() + k * d, d, row);
+            valid[i] = normalizeEmbedding(row, d);
+            if (!valid[i]) std::fill_n(row, d, 0.f);
+        }
+    }
+    return ok;
+}
+
+bool ColorHistogramEmbeddingExtractor::extract(const ImageView& frame, const DetectionBBox* boxes,
+                                               std::size_t count, std::vector<float>& out,
+                                               std::vector<bool>& valid) {
+    constexpr std::size_t kHalf = kDim / 2;
+    constexpr int kShift = 6;  // 256 / kBinsPerChannel = 64
+    out.assign(count * kDim, 0.f);
+    valid.assign(count, false);
+    const core::PixelFormat format =
+        frame.format != core::PixelFormat::Any ? frame.format : core::parsePixelFormat(frame.pixelFormat);
+    // 通道按 RGB 顺序入桶，同一目标在 RGB / BGR 帧上得到相同特征
+    const int rIdx = format == core::PixelFormat::BGR8 ? 2 : 0;
+    const int bIdx = 2 - rIdx;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        ImageView crop;
+        if (!cropImageView(frame, boxes[i], crop)) continue;
+        float* row = out.data() + i * kDim;
+        const int sx = std::max(1, crop.width / maxSamplesPerAxis_);
+        const int sy = std::max(1, crop.height / maxSamplesPerAxis_);
+        const int mid = crop.height / 2;
+        for (int y = 0; y < crop.height; y += sy) {
+            const std::uint8_t* line = crop.data + static_cast<std::size_t>(y) * crop.stride;
+            float* hist = row + (y < mid ? 0 : kHalf);
+            for (int x = 0; x < crop.width; x += sx) {
+                const std::uint8_t* p = line + static_cast<std::size_t>(x) * 3;
+                const std::size_t bin = (static_cast<std::size_t>(p[rIdx] >> kShift) * kBinsPerChannel +
+                                         static_cast<std::size_t>(p[1] >> kShift)) * kBinsPerChannel +
+                                        static_cast<std::size_t>(p[bIdx] >> kShift);
+                hist[bin] += 1.f;
+            }
+        }
+        // 开方（Hellinger 核）压低大面积背景色的权重
+        for (std::size_t k = 0; k < kDim; ++k) row[k] = std::sqrt(row[k]);
+        valid[i] = normalizeEmbedding(row, kDim);
+    }
+    return true;
+}
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,201 @@
+#include "falconmind/sdk/perception/ReidGallery.h"
+#include "falconmind/sdk/perception/ReidEmbedding.h"
+#include "falconmind/sdk/core/CpuFeatures.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+using DotFn = float (*)(const float* a, const float* b, std::size_t n);
+
+float dotScalar(const float* a, const float* b, std::size_t n) {
+    float s = 0.f;
+    for (std::size_t i = 0; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FALCONMIND_REID_X86 1
+__attribute__((target("avx2,fma"))) float dotAvx2(const float* a, const float* b, std::size_t n) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    for (; i + 8 <= n; i += 8) acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    const __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s) + dotScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx512f"))) float dotAvx512(const float* a, const float* b, std::size_t n) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+    }
+    for (; i + 16 <= n; i += 16) acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+    if (i < n) {
+        const __mmask16 m = static_cast<__mmask16>((1u << (n - i)) - 1u);
+        acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i), acc1);
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FALCONMIND_REID_NEON 1
+float dotNeon(const float* a, const float* b, std::size_t n) {
+    float32x4_t acc0 = vdupq_n_f32(0.f);
+    float32x4_t acc1 = vdupq_n_f32(0.f);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    for (; i + 4 <= n; i += 4) acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+    return vaddvq_f32(vaddq_f32(acc0, acc1)) + dotScalar(a + i, b + i, n - i);
+}
+#endif
+
+struct DotKernel {
+    DotFn fn;
+    const char* name;
+};
+
+DotKernel selectDot() {
+#if defined(FALCONMIND_REID_NEON)
+    return {dotNeon, "neon"};
+#else
+#if defined(FALCONMIND_REID_X86)
+    const core::CpuFeatures& cpu = core::cpuFeatures();
+    if (cpu.supports(core::CpuIsa::Avx512)) return {dotAvx512, "avx512"};
+    if (cpu.avx2 && cpu.fma) return {dotAvx2, "avx2"};
+#endif
+    return {dotScalar, "scalar"};
+#endif
+}
+
+const DotKernel& dotKernel() {
+    static const DotKernel k = selectDot();
+    return k;
+}
+
+} // namespace
+
+ReidGallery::ReidGallery(std::size_t capacity, std::size_t dim)
+    : dim_(dim),
+      rowStride_((dim + 7) & ~static_cast<std::size_t>(7)),
+      rows_(std::max<std::size_t>(1, capacity) * rowStride_, 0.f),
+      ids_(std::max<std::size_t>(1, capacity), -1),
+      lastSeen_(ids_.size(), 0) {
+    freeSlots_.reserve(ids_.size());
+    for (std::size_t i = ids_.size(); i-- > 0;) freeSlots_.push_back(static_cast<std::uint32_t>(i));
+    slotOf_.reserve(ids_.size());
+}
+
+void ReidGallery::update(int id, const float* embedding, std::int64_t timestampNs, float momentum) {
+    auto it = slotOf_.find(id);
+    if (it != slotOf_.end()) {
+        float* row = rows_.data() + it->second * rowStride_;
+        const float m = std::min(std::max(momentum, 0.f), 1.f);
+        for (std::size_t k = 0; k < dim_; ++k) row[k] = m * row[k] + (1.f - m) * embedding[k];
+        if (!normalizeEmbedding(row, dim_)) std::copy_n(embedding, dim_, row);
+        lastSeen_[it->second] = std::max(lastSeen_[it->second], timestampNs);
+        return;
+    }
+
+    std::uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        // 满：覆盖最久未见的条目
+        slot = 0;
+        for (std::uint32_t i = 1; i < ids_.size(); ++i) {
+            if (lastSeen_[i] < lastSeen_[slot]) slot = i;
+        }
+        slotOf_.erase(ids_[slot]);
+    }
+    ids_[slot] = id;
+    lastSeen_[slot] = timestampNs;
+    std::copy_n(embedding, dim_, rows_.data() + slot * rowStride_);
+    slotOf_[id] = slot;
+}
+
+void ReidGallery::touch(int id, std::int64_t timestampNs) {
+    auto it = slotOf_.find(id);
+    if (it != slotOf_.end()) lastSeen_[it->second] = std::max(lastSeen_[it->second], timestampNs);
+}
+
+bool ReidGallery::remove(int id) {
+    auto it = slotOf_.find(id);
+    if (it == slotOf_.end()) return false;
+    ids_[it->second] = -1;
+    lastSeen_[it->second] = 0;
+    freeSlots_.push_back(it->second);
+    slotOf_.erase(it);
+    return true;
+}
+
+void ReidGallery::clear() {
+    slotOf_.clear();
+    freeSlots_.clear();
+    std::fill(ids_.begin(), ids_.end(), -1);
+    std::fill(lastSeen_.begin(), lastSeen_.end(), 0);
+    for (std::size_t i = ids_.size(); i-- > 0;) freeSlots_.push_back(static_cast<std::uint32_t>(i));
+}
+
+std::int64_t ReidGallery::lastSeenNs(int id) const {
+    auto it = slotOf_.find(id);
+    return it != slotOf_.end() ? lastSeen_[it->second] : 0;
+}
+
+const float* ReidGallery::embedding(int id) const {
+    auto it = slotOf_.find(id);
+    return it != slotOf_.end() ? rows_.data() + it->second * rowStride_ : nullptr;
+}
+
+ReidMatch ReidGallery::best(const float* embedding, float minSimilarity, std::int64_t seenAfterNs,
+                            std::int64_t seenBeforeNs) const {
+    ReidMatch m;
+    const DotFn fn = dotKernel().fn;
+    float bestSim = -std::numeric_limits<float>::infinity();
+    for (std::size_t i = 0; i < ids_.size(); ++i) {
+        if (ids_[i] < 0 || lastSeen_[i] < seenAfterNs || lastSeen_[i] >= seenBeforeNs) continue;
+        const float s = fn(embedding, rows_.data() + i * rowStride_, dim_);
+        if (s > bestSim) {
+            bestSim = s;
+            m.id = ids_[i];
+        }
+    }
+    if (m.id < 0 || bestSim < minSimilarity) return ReidMatch{};
+    m.similarity = bestSim;
+    return m;
+}
+
+const char* ReidGallery::kernelName() noexcept {
+    return dotKernel().name;
+}
+
+float ReidGallery::dot(const float* a, const float* b, std::size_t n) noexcept {
+    return dotKernel().fn(a, b, n);
+}
+
+} // namespace falconmind::sdk::perception
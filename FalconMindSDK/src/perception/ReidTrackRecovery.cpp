@@ -0,0 +1,127 @@
+#include "falconmind/sdk/perception/ReidTrackRecovery.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+// 无时间戳时按名义 30 fps 推算特征库时间
+constexpr std::int64_t kNominalFrameNs = 33'333'333;
+
+} // namespace
+
+ReidTrackRecovery::ReidTrackRecovery(EmbeddingExtractorPtr extractor, std::size_t galleryCapacity)
+    : extractor_(std::move(extractor)), gallery_(galleryCapacity, extractor_ ? extractor_->dim() : 0) {
+    if (gallery_.dim() == 0) {
+        std::cerr << "[ReidTrackRecovery] extractor has no embedding dim, re-identification disabled" << std::endl;
+    }
+}
+
+void ReidTrackRecovery::resetMission(const std::string& missionId) {
+    missionId_ = missionId;
+    gallery_.clear();
+    aliases_.clear();
+}
+
+int ReidTrackRecovery::stableIdOf(int localTrackId) const {
+    auto it = aliases_.find(localTrackId);
+    return it != aliases_.end() && !it->second.retired ? it->second.stableId : -1;
+}
+
+bool ReidTrackRecovery::process(const ImageView& frame, DetectionResult& detections, TrackingResult& tracks) {
+    ++frame_;
+    const std::int64_t now = detections.timestampNs > 0 ? static_cast<std::int64_t>(detections.timestampNs)
+                                                        : static_cast<std::int64_t>(frame_) * kNominalFrameNs;
+    const std::size_t dim = gallery_.dim();
+    const bool canExtract = !detections.trackerPredicted && extractor_ && dim > 0 && extractor_->dim() == dim;
+
+    // 1) 已知轨迹先刷新 lastSeen，使其不会被本帧的新轨迹找回；收集需要提取特征的检测
+    boxes_.clear();
+    boxDet_.clear();
+    for (std::size_t d = 0; d < detections.detections.size(); ++d) {
+        const int local = detections.detections[d].trackId;
+        if (local < 0) continue;
+        auto it = aliases_.find(local);
+        if (it != aliases_.end()) {
+            if (it->second.retired) continue;
+            gallery_.touch(it->second.stableId, now);
+            if (!canExtract || frame_ - it->second.refreshedFrame < static_cast<std::uint64_t>(refreshInterval_)) continue;
+        } else if (!canExtract) {
+            aliases_[local] = Alias{local, frame_, frame_, false};
+            continue;
+        }
+        boxes_.push_back(detections.detections[d].bbox);
+        boxDet_.push_back(d);
+    }
+
+    if (!boxes_.empty()) {
+        extractor_->extract(frame, boxes_.data(), boxes_.size(), embeddings_, valid_);
+        extracted_ += boxes_.size();
+    }
+
+    // 2) 已知轨迹更新特征，再为新轨迹检索
+    for (int pass = 0; pass < 2; ++pass) {
+        for (std::size_t k = 0; k < boxDet_.size(); ++k) {
+            const int local = detections.detections[boxDet_[k]].trackId;
+            auto it = aliases_.find(local);
+            const bool known = it != aliases_.end();
+            if (known != (pass == 0)) continue;
+            const bool ok = k < valid_.size() && valid_[k];
+            const float* emb = ok ? embeddings_.data() + k * dim : nullptr;
+            if (known) {
+                it->second.refreshedFrame = frame_;
+                if (ok) gallery_.update(it->second.stableId, emb, now, momentum_);
+                continue;
+            }
+            Alias alias{local, frame_, frame_, false};
+            if (ok) {
+                const ReidMatch m = gallery_.best(emb, minSimilarity_, now - maxLostNs_, now);
+                if (m.id >= 0) {
+                    // 找回：仍在外推的旧本地轨迹由新轨迹接管
+                    for (auto& kv : aliases_) {
+                        if (kv.second.stableId == m.id) kv.second.retired = true;
+                    }
+                    alias.stableId = m.id;
+                    ++recovered_;
+                }
+                gallery_.update(alias.stableId, emb, now, momentum_);
+            }
+            aliases_[local] = alias;
+        }
+    }
+
+    // 3) 改写为稳定 ID；被接管的旧轨迹不再输出
+    for (auto& det : detections.detections) {
+        if (det.trackId < 0) continue;
+        auto it = aliases_.find(det.trackId);
+        if (it != aliases_.end()) det.trackId = it->second.retired ? -1 : it->second.stableId;
+    }
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < tracks.tracks.size(); ++i) {
+        TrackingState& t = tracks.tracks[i];
+        auto it = aliases_.find(t.trackId);
+        if (it == aliases_.end()) {
+            // 未经过本阶段建立别名的轨迹（如 predict 帧前即存在）按自身 ID 登记
+            it = aliases_.emplace(t.trackId, Alias{t.trackId, frame_, frame_, false}).first;
+        }
+        it->second.seenFrame = frame_;
+        if (it->second.retired) continue;
+        const bool lost = t.status == "LOST";
+        t.trackId = it->second.stableId;
+        if (lost) it->second.seenFrame = 0;  // 后端已结束该轨迹，别名随后释放（特征保留在库中等待找回）
+        if (kept != i) tracks.tracks[kept] = std::move(t);
+        ++kept;
+    }
+    tracks.tracks.resize(kept);
+
+    // 4) 释放后端已不再输出的本地轨迹别名
+    for (auto it = aliases_.begin(); it != aliases_.end();) {
+        if (it->second.seenFrame != frame_) it = aliases_.erase(it);
+        else ++it;
+    }
+    return true;
+}
+
+} // namespace falconmind::sdk::perception
@@ -1,7 +1,18 @@
 #include "falconmind/sdk/perception/RknnDetectorBackend.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/perception/ClassFilter.h"
 #include "falconmind/sdk/perception/YoloPrePostProcess.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <condition_variable>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <cstring>
 
@@ -14,15 +25,534 @@ namespace falconmind::sdk::perception {
 #if defined(FALCONMINDSDK_RKNN_BACKEND_ENABLED) && FALCONMINDSDK_RKNN_BACKEND_ENABLED
 namespace {
 
-struct RknnState {
+// 单个 rknn_context 及其专属的前处理器与 IO 内存
+struct RknnContext {
     rknn_context ctx{0};
     int inputW{0};
     int inputH{0};
     uint32_t inputSize{0};
-    rknn_tensor_format inputFmt{RKNN_TENSOR_NCHW};
+    rknn_tensor_format inputFmt{RKNN_TENSOR_NCHW};   // 模型输入张量属性
     rknn_tensor_type inputType{RKNN_TENSOR_FLOAT32};
+    rknn_tensor_format feedFmt{RKNN_TENSOR_NCHW};    // 实际提供给 rknn_inputs_set 的数据
+    rknn_tensor_type feedType{RKNN_TENSOR_FLOAT32};
+    bool passThrough{false};
+    bool quantTableIdentity{true};
+    std::array<std::uint8_t, 256> quantTable{};      // pass_through：像素 → 模型内部量化值
+    InputTensorSpec spec;
+    std::unique_ptr<YoloPreprocessor> preprocessor;
+    std::vector<std::uint8_t> input;  // 逐帧复用的模型输入（按 spec 的元素类型解释）
+    std::uint32_t numOutputs{0};
+    bool profiling{false};  // 以 RKNN_FLAG_COLLECT_PERF_MASK 初始化，可查询 RKNN_QUERY_PERF_RUN
+
+    // 零拷贝（rknn_create_mem + rknn_set_io_mem）：输入/输出内存在 load() 时分配并绑定一次，
+    // 前处理直接写入输入内存，推理结果直接落在输出内存，不经过 rknn_inputs_set/rknn_outputs_get 的拷贝
+    bool zeroCopy{false};
+    rknn_tensor_attr ioInputAttr{};              // 绑定输入时使用的属性（NHWC uint8）
+    rknn_tensor_mem* inputMem{nullptr};
+    rknn_tensor_mem* boundInput{nullptr};        // 当前绑定的输入（自有内存或导入的 DMABUF）
+    std::vector<rknn_tensor_attr> outputAttrs;
+    std::vector<rknn_tensor_mem*> outputMems;
+    std::array<float, 256> dequantTable{};       // 输出 0 为 int8/uint8 时的反量化表
+    std::vector<float> output;                   // 输出 0 的 float 副本（非 float32 输出时）
+    struct ImportedInput {
+        void* virtAddr{nullptr};
+        rknn_tensor_mem* mem{nullptr};
+    };
+    std::unordered_map<int, ImportedInput> importedInputs;  // DMABUF fd → 导入的输入内存
 };
 
+const char* tensorTypeName(rknn_tensor_type type) {
+    switch (type) {
+        case RKNN_TENSOR_FLOAT32: return "float32";
+        case RKNN_TENSOR_FLOAT16: return "float16";
+        case RKNN_TENSOR_INT8: return "int8";
+        case RKNN_TENSOR_UINT8: return "uint8";
+        default: return "other";
+    }
+}
+
+// 按模型输入属性选择喂入方式：
+// - 量化模型（INT8/UINT8）：前处理直接输出 uint8。量化参数为非对称仿射且允许 pass_through 时，
+//   按模型布局查表为内部量化值，运行时不再做归一化/量化；否则以 uint8 NHWC 交给运行时转换
+// - 浮点模型：float32 NCHW，由运行时转换为内部类型
+void chooseInputPath(RknnContext& state, const rknn_tensor_attr& attr, const DetectorDescriptor& desc) {
+    state.spec.width = state.inputW;
+    state.spec.height = state.inputH;
+    const bool quantized = attr.type == RKNN_TENSOR_INT8 || attr.type == RKNN_TENSOR_UINT8;
+    if (!desc.quantizedInput || !quantized) {
+        state.spec.type = TensorElementType::Float32;
+        state.spec.layout = TensorLayout::NCHW;
+        state.feedType = RKNN_TENSOR_FLOAT32;
+        state.feedFmt = RKNN_TENSOR_NCHW;
+        return;
+    }
+    state.spec.type = TensorElementType::Uint8;
+    state.passThrough = desc.inputPassThrough && attr.qnt_type == RKNN_TENSOR_QNT_AFFINE_ASYMMETRIC &&
+                        (attr.fmt == RKNN_TENSOR_NHWC || attr.fmt == RKNN_TENSOR_NCHW);
+    if (state.passThrough) {
+        state.spec.layout = attr.fmt == RKNN_TENSOR_NCHW ? TensorLayout::NCHW : TensorLayout::NHWC;
+        state.feedType = attr.type;
+        state.feedFmt = attr.fmt;
+        state.quantTable = inputQuantTable(desc.inputMean, desc.inputStd, attr.scale, attr.zp,
+                                           attr.type == RKNN_TENSOR_INT8);
+        state.quantTableIdentity = true;
+        for (int p = 0; p < 256; ++p) {
+            if (state.quantTable[p] != p) state.quantTableIdentity = false;
+        }
+    } else {
+        state.spec.layout = TensorLayout::NHWC;
+        state.feedType = RKNN_TENSOR_UINT8;
+        state.feedFmt = RKNN_TENSOR_NHWC;
+    }
+}
+
+
+float halfToFloat(std::uint16_t h) {
+    const int exp = (h >> 10) & 0x1f;
+    const int mant = h & 0x3ff;
+    float v;
+    if (exp == 0) {
+        v = std::ldexp(static_cast<float>(mant), -24);
+    } else if (exp == 31) {
+        v = mant ? std::numeric_limits<float>::quiet_NaN() : std::numeric_limits<float>::infinity();
+    } else {
+        v = std::ldexp(static_cast<float>(mant | 0x400), exp - 25);
+    }
+    return (h & 0x8000) ? -v : v;
+}
+
+void releaseZeroCopy(RknnContext& state) {
+    for (auto& entry : state.importedInputs) rknn_destroy_mem(state.ctx, entry.second.mem);
+    state.importedInputs.clear();
+    for (rknn_tensor_mem* mem : state.outputMems) {
+        if (mem) rknn_destroy_mem(state.ctx, mem);
+    }
+    state.outputMems.clear();
+    if (state.inputMem) rknn_destroy_mem(state.ctx, state.inputMem);
+    state.inputMem = nullptr;
+    state.boundInput = nullptr;
+    state.zeroCopy = false;
+}
+
+// 量化模型的零拷贝：输入按 NPU 原生属性绑定为 uint8 NHWC（归一化/量化由 NPU 完成），
+// 输出按标准 NCHW 属性绑定（运行时负责原生布局 → NCHW）；任一步失败则回退到拷贝接口
+bool setupZeroCopy(RknnContext& state) {
+    rknn_tensor_attr& in = state.ioInputAttr;
+    memset(&in, 0, sizeof(in));
+    in.index = 0;
+    if (rknn_query(state.ctx, RKNN_QUERY_NATIVE_INPUT_ATTR, &in, sizeof(in)) != RKNN_SUCC) return false;
+    in.type = RKNN_TENSOR_UINT8;
+    in.fmt = RKNN_TENSOR_NHWC;
+    // 前处理按紧凑行写入：NPU 要求行对齐填充时不走零拷贝
+    if (in.w_stride != 0 && static_cast<int>(in.w_stride) != state.inputW) return false;
+    const std::uint32_t inputBytes = static_cast<std::uint32_t>(state.inputW) * state.inputH * 3;
+    state.inputMem = rknn_create_mem(state.ctx, std::max(in.size_with_stride, inputBytes));
+    if (!state.inputMem || rknn_set_io_mem(state.ctx, state.inputMem, &in) != RKNN_SUCC) {
+        releaseZeroCopy(state);
+        return false;
+    }
+    state.boundInput = state.inputMem;
+
+    state.outputAttrs.assign(state.numOutputs, rknn_tensor_attr{});
+    state.outputMems.assign(state.numOutputs, nullptr);
+    for (std::uint32_t i = 0; i < state.numOutputs; ++i) {
+        rknn_tensor_attr& out = state.outputAttrs[i];
+        out.index = i;
+        if (rknn_query(state.ctx, RKNN_QUERY_OUTPUT_ATTR, &out, sizeof(out)) != RKNN_SUCC) {
+            releaseZeroCopy(state);
+            return false;
+        }
+        state.outputMems[i] = rknn_create_mem(state.ctx, out.size);
+        if (!state.outputMems[i] || rknn_set_io_mem(state.ctx, state.outputMems[i], &out) != RKNN_SUCC) {
+            releaseZeroCopy(state);
+            return false;
+        }
+    }
+    const rknn_tensor_attr& first = state.outputAttrs[0];
+    for (int q = 0; q < 256; ++q) {
+        const int value = first.type == RKNN_TENSOR_INT8 ? static_cast<std::int8_t>(q) : q;
+        state.dequantTable[q] = (value - first.zp) * first.scale;
+    }
+    state.spec.type = TensorElementType::Uint8;
+    state.spec.layout = TensorLayout::NHWC;
+    state.passThrough = false;
+    state.zeroCopy = true;
+    return true;
+}
+
+// 模型输入尺寸的 RGB8 DMABUF（如 RGA 缩放后的帧）直接导入并绑定为输入；按 fd 缓存导入结果
+rknn_tensor_mem* importInput(RknnContext& state, const ImageView& image) {
+    if (image.dmabufFd < 0 || !image.data || image.width != state.inputW || image.height != state.inputH) {
+        return nullptr;
+    }
+    const core::PixelFormat fmt = image.format != core::PixelFormat::Any ? image.format
+                                                                         : core::parsePixelFormat(image.pixelFormat);
+    if (fmt != core::PixelFormat::RGB8 || (image.stride > 0 && image.stride != image.width * 3)) return nullptr;
+    void* virt = const_cast<std::uint8_t*>(image.data);
+    auto it = state.importedInputs.find(image.dmabufFd);
+    if (it != state.importedInputs.end() && it->second.virtAddr != virt) {
+        // fd 号被复用到另一块缓冲
+        if (state.boundInput == it->second.mem) state.boundInput = nullptr;
+        rknn_destroy_mem(state.ctx, it->second.mem);
+        state.importedInputs.erase(it);
+        it = state.importedInputs.end();
+    }
+    if (it == state.importedInputs.end()) {
+        const auto size = static_cast<std::uint32_t>(state.inputW) * state.inputH * 3;
+        rknn_tensor_mem* mem = rknn_create_mem_from_fd(state.ctx, image.dmabufFd, virt, size, 0);
+        if (!mem) return nullptr;
+        it = state.importedInputs.emplace(image.dmabufFd, RknnContext::ImportedInput{virt, mem}).first;
+    }
+    return it->second.mem;
+}
+
+bool bindInput(RknnContext& state, rknn_tensor_mem* mem) {
+    if (state.boundInput == mem) return true;
+    int ret = rknn_set_io_mem(state.ctx, mem, &state.ioInputAttr);
+    if (ret != RKNN_SUCC) {
+        std::cerr << "[RknnDetectorBackend] rknn_set_io_mem(input) failed: " << ret << std::endl;
+        return false;
+    }
+    state.boundInput = mem;
+    return true;
+}
+
+// 输出 0 的 float 视图：float32 直接使用输出内存，int8/uint8 查表反量化，float16 逐元素转换
+const float* outputAsFloat(RknnContext& state, std::size_t& count) {
+    const rknn_tensor_attr& attr = state.outputAttrs[0];
+    rknn_tensor_mem* mem = state.outputMems[0];
+    rknn_mem_sync(state.ctx, mem, RKNN_MEMORY_SYNC_FROM_DEVICE);
+    count = attr.n_elems;
+    switch (attr.type) {
+        case RKNN_TENSOR_FLOAT32:
+            return static_cast<const float*>(mem->virt_addr);
+        case RKNN_TENSOR_INT8:
+        case RKNN_TENSOR_UINT8: {
+            state.output.resize(count);
+            const auto* q = static_cast<const std::uint8_t*>(mem->virt_addr);
+            for (std::size_t i = 0; i < count; ++i) state.output[i] = state.dequantTable[q[i]];
+            return state.output.data();
+        }
+        case RKNN_TENSOR_FLOAT16: {
+            state.output.resize(count);
+            const auto* h = static_cast<const std::uint16_t*>(mem->virt_addr);
+            for (std::size_t i = 0; i < count; ++i) state.output[i] = halfToFloat(h[i]);
+            return state.output.data();
+        }
+        default:
+            return nullptr;
+    }
+}
+
+
+// 开启性能采集时读取最近一次 rknn_run 的 NPU 耗时；利用率为 NPU 耗时占推理墙钟的比例
+void queryDevicePerf(const RknnContext& state, DetectionTiming& timing) {
+    if (!state.profiling) return;
+    rknn_perf_run perf;
+    memset(&perf, 0, sizeof(perf));
+    if (rknn_query(state.ctx, RKNN_QUERY_PERF_RUN, &perf, sizeof(perf)) != RKNN_SUCC || perf.run_duration <= 0) return;
+    timing.deviceUs = static_cast<std::uint32_t>(perf.run_duration);
+    if (timing.inferUs > 0) {
+        timing.deviceUtilization = std::min(1.f, static_cast<float>(perf.run_duration) / static_cast<float>(timing.inferUs));
+    }
+}
+
+// 对单个上下文执行一帧：前处理 → 推理 → 解码 → NMS
+bool runContext(RknnContext& state, const DetectorDescriptor& desc, const std::vector<int>& classes,
+                const ImageView& image, DetectionResult& outResult) {
+    const int numClasses = desc.numClasses > 0 ? desc.numClasses : 80;
+    const float scoreThr = desc.scoreThreshold > 0 ? desc.scoreThreshold : 0.25f;
+    const NmsConfig nmsCfg = nmsConfig(desc);
+    StageTimer timer(desc.profiling);
+    DetectionTiming timing;
+
+    LetterboxTransform transform;
+    std::vector<YoloRawDet> raw;
+    if (state.zeroCopy) {
+        // 模型尺寸的 RGB8 DMABUF 直接作为输入；否则前处理写入预分配的输入内存
+        rknn_tensor_mem* input = importInput(state, image);
+        if (!input) {
+            input = state.inputMem;
+            if (!state.preprocessor->run(image, state.spec, input->virt_addr, transform)) {
+                std::cerr << "[RknnDetectorBackend] unsupported input " << image.width << "x" << image.height
+                          << " format=" << image.pixelFormat << std::endl;
+                return false;
+            }
+            rknn_mem_sync(state.ctx, input, RKNN_MEMORY_SYNC_TO_DEVICE);
+        }
+        timing.preprocessUs = timer.lapUs();
+        if (!bindInput(state, input)) return false;
+        int ret = rknn_run(state.ctx, nullptr);
+        if (ret != RKNN_SUCC) {
+            std::cerr << "[RknnDetectorBackend] rknn_run failed: " << ret << std::endl;
+            return false;
+        }
+        timing.inferUs = timer.lapUs();
+        queryDevicePerf(state, timing);
+        std::size_t count = 0;
+        const float* outputData = outputAsFloat(state, count);
+        const rknn_tensor_attr& outAttr = state.outputAttrs[0];
+        size_t numChannels = (outAttr.n_dims >= 2) ? static_cast<size_t>(outAttr.dims[1]) : 84;
+        size_t numBoxes = (outAttr.n_dims >= 3) ? static_cast<size_t>(outAttr.dims[2]) : 8400;
+        if (outputData && count >= numChannels * numBoxes) {
+            decodeYoloOutput84xN(outputData, numChannels, numBoxes, numClasses, scoreThr, raw, classes);
+        }
+        timing.decodeUs = timer.lapUs();
+    } else {
+        std::vector<std::uint8_t>& inputBuf = state.input;
+        // 按帧格式（RGB8/BGR8/NV12/YUYV）一趟完成颜色转换、缩放，并直接输出 load() 选定的类型/布局
+        if (!state.preprocessor->run(image, state.spec, inputBuf.data(), transform)) {
+            std::cerr << "[RknnDetectorBackend] unsupported input " << image.width << "x" << image.height
+                      << " format=" << image.pixelFormat << std::endl;
+            return false;
+        }
+        if (state.passThrough && !state.quantTableIdentity) {
+            applyByteTable(state.quantTable, inputBuf.data(), inputBuf.size());
+        }
+        timing.preprocessUs = timer.lapUs();
+
+        rknn_input inputs[1];
+        memset(inputs, 0, sizeof(inputs));
+        inputs[0].index = 0;
+        inputs[0].buf = inputBuf.data();
+        inputs[0].size = state.inputSize;
+        inputs[0].pass_through = state.passThrough ? 1 : 0;
+        inputs[0].type = state.feedType;
+        inputs[0].fmt = state.feedFmt;
+
+        int ret = rknn_inputs_set(state.ctx, 1, inputs);
+        if (ret != RKNN_SUCC) {
+            std::cerr << "[RknnDetectorBackend] rknn_inputs_set failed: " << ret << std::endl;
+            return false;
+        }
+        ret = rknn_run(state.ctx, nullptr);
+        if (ret != RKNN_SUCC) {
+            std::cerr << "[RknnDetectorBackend] rknn_run failed: " << ret << std::endl;
+            return false;
+        }
+
+        rknn_input_output_num num;
+        ret = rknn_query(state.ctx, RKNN_QUERY_IN_OUT_NUM, &num, sizeof(num));
+        if (ret != RKNN_SUCC || num.n_output < 1) {
+            outResult.detections.clear();
+            return true;
+        }
+
+        std::vector<rknn_output> outputs(num.n_output);
+        for (uint32_t i = 0; i < num.n_output; ++i) {
+            outputs[i].want_float = 1;
+            outputs[i].is_prealloc = 0;
+            outputs[i].index = i;
+            outputs[i].buf = nullptr;
+            outputs[i].size = 0;
+        }
+        ret = rknn_outputs_get(state.ctx, num.n_output, outputs.data(), nullptr);
+        if (ret != RKNN_SUCC) {
+            std::cerr << "[RknnDetectorBackend] rknn_outputs_get failed: " << ret << std::endl;
+            return false;
+        }
+        timing.inferUs = timer.lapUs();
+        queryDevicePerf(state, timing);
+
+        float* outputData = static_cast<float*>(outputs[0].buf);
+        uint32_t outputSize = outputs[0].size;
+        if (!outputData || outputSize < 4 * sizeof(float)) {
+            rknn_outputs_release(state.ctx, num.n_output, outputs.data());
+            outResult.detections.clear();
+            return true;
+        }
+
+        rknn_tensor_attr outAttr;
+        memset(&outAttr, 0, sizeof(outAttr));
+        outAttr.index = 0;
+        rknn_query(state.ctx, RKNN_QUERY_OUTPUT_ATTR, &outAttr, sizeof(outAttr));
+        size_t numChannels = (outAttr.n_dims >= 2) ? static_cast<size_t>(outAttr.dims[1]) : 84;
+        size_t numBoxes = (outAttr.n_dims >= 3) ? static_cast<size_t>(outAttr.dims[2]) : 8400;
+
+        decodeYoloOutput84xN(outputData, numChannels, numBoxes, numClasses, scoreThr, raw, classes);
+        rknn_outputs_release(state.ctx, num.n_output, outputs.data());
+        timing.decodeUs = timer.lapUs();
+    }
+
+    if (raw.empty()) {
+        outResult.detections.clear();
+        outResult.frameIndex = image.frameIndex;
+        outResult.timestampNs = static_cast<std::uint64_t>(image.captureTimestampNs);
+        outResult.timing = timing;
+        return true;
+    }
+
+    std::vector<bool> suppressed;
+    nmsYoloDetections(raw, nmsCfg, suppressed);
+    fillDetectionResultFromYolo(raw, suppressed, transform, image.width, image.height, outResult);
+    timing.nmsUs = timer.lapUs();
+    outResult.timing = timing;
+    outResult.frameIndex = image.frameIndex;
+    outResult.timestampNs = static_cast<std::uint64_t>(image.captureTimestampNs);
+    return true;
+}
+
+// 分阶段执行的一份中间结果：模型输入与输出 0 的主机副本，不占用上下文的 IO 内存
+struct RknnStagedSlot {
+    std::vector<std::uint8_t> input;  // 按主上下文的 spec 排布
+    LetterboxTransform transform;
+    int imageWidth{0};
+    int imageHeight{0};
+    std::uint32_t frameIndex{0};
+    std::int64_t timestampNs{0};
+    std::vector<float> output;
+    std::size_t numChannels{0};
+    std::size_t numBoxes{0};
+    DetectionTiming timing;  // 前处理、推理阶段写入，后处理阶段补全后随结果输出
+};
+
+// 上下文池：run() 取一个空闲上下文执行，多上下文时可被多个线程并发调用
+struct RknnState {
+    std::vector<std::unique_ptr<RknnContext>> contexts;
+    std::mutex mutex;
+    std::condition_variable idleCv;
+    std::vector<RknnContext*> idle;
+
+    std::vector<RknnStagedSlot> stagedSlots;
+    std::unique_ptr<YoloPreprocessor> stagedPreprocessor;  // 仅前处理阶段线程使用
+};
+
+RknnContext* acquireContext(RknnState& pool) {
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    pool.idleCv.wait(lock, [&pool] { return !pool.idle.empty(); });
+    RknnContext* context = pool.idle.back();
+    pool.idle.pop_back();
+    return context;
+}
+
+void releaseContext(RknnState& pool, RknnContext* context) {
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.idle.push_back(context);
+    }
+    pool.idleCv.notify_all();
+}
+
+// 分阶段推理：slot 的输入喂给上下文（零拷贝上下文拷入其输入内存），输出 0 以 float 拷回 slot
+bool inferStaged(RknnContext& state, RknnStagedSlot& slot) {
+    if (state.zeroCopy) {
+        std::memcpy(state.inputMem->virt_addr, slot.input.data(), slot.input.size());
+        rknn_mem_sync(state.ctx, state.inputMem, RKNN_MEMORY_SYNC_TO_DEVICE);
+        if (!bindInput(state, state.inputMem)) return false;
+        int ret = rknn_run(state.ctx, nullptr);
+        if (ret != RKNN_SUCC) {
+            std::cerr << "[RknnDetectorBackend] rknn_run failed: " << ret << std::endl;
+            return false;
+        }
+        std::size_t count = 0;
+        const float* data = outputAsFloat(state, count);
+        if (!data) return false;
+        const rknn_tensor_attr& attr = state.outputAttrs[0];
+        slot.output.assign(data, data + count);
+        slot.numChannels = attr.n_dims >= 2 ? static_cast<std::size_t>(attr.dims[1]) : 84;
+        slot.numBoxes = attr.n_dims >= 3 ? static_cast<std::size_t>(attr.dims[2]) : 8400;
+        return true;
+    }
+
+    rknn_input inputs[1];
+    memset(inputs, 0, sizeof(inputs));
+    inputs[0].index = 0;
+    inputs[0].buf = slot.input.data();
+    inputs[0].size = static_cast<uint32_t>(slot.input.size());
+    inputs[0].pass_through = state.passThrough ? 1 : 0;
+    inputs[0].type = state.feedType;
+    inputs[0].fmt = state.feedFmt;
+    int ret = rknn_inputs_set(state.ctx, 1, inputs);
+    if (ret == RKNN_SUCC) ret = rknn_run(state.ctx, nullptr);
+    if (ret != RKNN_SUCC) {
+        std::cerr << "[RknnDetectorBackend] rknn_inputs_set/rknn_run failed: " << ret << std::endl;
+        return false;
+    }
+    std::vector<rknn_output> outputs(std::max<std::uint32_t>(1, state.numOutputs));
+    for (uint32_t i = 0; i < outputs.size(); ++i) {
+        memset(&outputs[i], 0, sizeof(rknn_output));
+        outputs[i].want_float = 1;
+        outputs[i].index = i;
+    }
+    ret = rknn_outputs_get(state.ctx, static_cast<uint32_t>(outputs.size()), outputs.data(), nullptr);
+    if (ret != RKNN_SUCC) {
+        std::cerr << "[RknnDetectorBackend] rknn_outputs_get failed: " << ret << std::endl;
+        return false;
+    }
+    const auto* data = static_cast<const float*>(outputs[0].buf);
+    slot.output.assign(data, data + (data ? outputs[0].size / sizeof(float) : 0));
+    rknn_outputs_release(state.ctx, static_cast<uint32_t>(outputs.size()), outputs.data());
+
+    rknn_tensor_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.index = 0;
+    rknn_query(state.ctx, RKNN_QUERY_OUTPUT_ATTR, &attr, sizeof(attr));
+    slot.numChannels = attr.n_dims >= 2 ? static_cast<std::size_t>(attr.dims[1]) : 84;
+    slot.numBoxes = attr.n_dims >= 3 ? static_cast<std::size_t>(attr.dims[2]) : 8400;
+    return true;
+}
+
+// npu_contexts > 1 时第 i 个上下文的核掩码：用户掩码的第 i 个置位核（循环使用），未指定时依次为 core0/1/2
+std::uint32_t contextCoreMask(std::uint32_t userMask, std::size_t index, std::size_t contexts) {
+    if (contexts <= 1) return userMask;
+    std::vector<std::uint32_t> cores;
+    for (std::uint32_t bit = 0; bit < 32; ++bit) {
+        if (userMask & (1u << bit)) cores.push_back(1u << bit);
+    }
+    if (cores.empty()) {
+        for (std::uint32_t bit = 0; bit < 3; ++bit) cores.push_back(1u << bit);  // RK3588：RKNN_NPU_CORE_0/1/2
+    }
+    return cores[index % cores.size()];
+}
+
+bool applyCoreMask(RknnContext& context, std::uint32_t mask) {
+    // rknn_core_mask 取值即核位掩码（RKNN_NPU_CORE_0 = 1, RKNN_NPU_CORE_0_1 = 3, ...）
+    int ret = rknn_set_core_mask(context.ctx, static_cast<rknn_core_mask>(mask));
+    if (ret != RKNN_SUCC) {
+        std::cerr << "[RknnDetectorBackend] rknn_set_core_mask(" << mask << ") failed: " << ret << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// 复制出的上下文共享权重，沿用主上下文已确定的输入路径，只分配自己的 IO 内存
+bool duplicateContext(RknnContext& primary, RknnContext& dup, const YoloPreprocessConfig& preprocess) {
+    int ret = rknn_dup_context(&primary.ctx, &dup.ctx);
+    if (ret != RKNN_SUCC) {
+        std::cerr << "[RknnDetectorBackend] rknn_dup_context failed: " << ret << std::endl;
+        return false;
+    }
+    dup.inputW = primary.inputW;
+    dup.inputH = primary.inputH;
+    dup.inputFmt = primary.inputFmt;
+    dup.inputType = primary.inputType;
+    dup.feedFmt = primary.feedFmt;
+    dup.feedType = primary.feedType;
+    dup.passThrough = primary.passThrough;
+    dup.quantTableIdentity = primary.quantTableIdentity;
+    dup.quantTable = primary.quantTable;
+    dup.spec = primary.spec;
+    dup.numOutputs = primary.numOutputs;
+    dup.profiling = primary.profiling;  // 复制的上下文沿用 rknn_init 标志
+    dup.preprocessor = std::make_unique<YoloPreprocessor>(preprocess);
+    if (primary.zeroCopy && !setupZeroCopy(dup)) {
+        // 主上下文已按零拷贝改为 uint8 NHWC 输入：本上下文改用拷贝接口喂同样的数据
+        std::cerr << "[RknnDetectorBackend] zero-copy io unavailable on duplicated context" << std::endl;
+        dup.feedType = RKNN_TENSOR_UINT8;
+        dup.feedFmt = RKNN_TENSOR_NHWC;
+    }
+    dup.inputSize = static_cast<uint32_t>(inputTensorBytes(dup.spec));
+    if (!dup.zeroCopy) dup.input.resize(dup.inputSize);
+    return true;
+}
+
+void destroyContext(RknnContext& context) {
+    if (!context.ctx) return;
+    releaseZeroCopy(context);
+    rknn_destroy(context.ctx);
+    context.ctx = 0;
+}
+
 } // namespace
 #endif
 
@@ -32,16 +562,23 @@ bool RknnDetectorBackend::load(const DetectorDescriptor& desc) {
     if (rknnState_) {
         unload();
     }
-    auto* state = new RknnState();
+    const std::size_t contexts = desc_.npuContexts > 1 ? static_cast<std::size_t>(desc_.npuContexts) : 1;
+    YoloPreprocessConfig preprocess = yoloPreprocessConfig(desc_);
+    // 多上下文时并行度来自同时在跑的帧，每帧前处理单线程即可
+    if (contexts > 1 && desc_.preprocessThreads <= 0) preprocess.threads = 1;
+
+    auto owner = std::make_unique<RknnContext>();
+    RknnContext* state = owner.get();
     state->inputW = desc_.inputWidth > 0 ? desc_.inputWidth : 640;
     state->inputH = desc_.inputHeight > 0 ? desc_.inputHeight : 640;
-    state->inputSize = 1 * 3 * static_cast<uint32_t>(state->inputH) * static_cast<uint32_t>(state->inputW) * sizeof(float);
+    state->preprocessor = std::make_unique<YoloPreprocessor>(preprocess);
 
     // rknn_init: size=0 表示 model 为文件路径
-    int ret = rknn_init(&state->ctx, (void*)desc_.modelPath.c_str(), 0, 0, nullptr);
+    state->profiling = desc_.profiling;
+    int ret = rknn_init(&state->ctx, (void*)desc_.modelPath.c_str(), 0,
+                        desc_.profiling ? RKNN_FLAG_COLLECT_PERF_MASK : 0, nullptr);
     if (ret != RKNN_SUCC) {
         std::cerr << "[RknnDetectorBackend] rknn_init failed: " << ret << " path=" << desc_.modelPath << std::endl;
-        delete state;
         return false;
     }
 
@@ -50,7 +587,6 @@ bool RknnDetectorBackend::load(const DetectorDescriptor& desc) {
     if (ret != RKNN_SUCC || num.n_input < 1) {
         std::cerr << "[RknnDetectorBackend] rknn_query IN_OUT_NUM failed or no input" << std::endl;
         rknn_destroy(state->ctx);
-        delete state;
         return false;
     }
 
@@ -69,34 +605,93 @@ bool RknnDetectorBackend::load(const DetectorDescriptor& desc) {
         }
         state->inputFmt = attr.fmt;
         state->inputType = attr.type;
-        state->inputSize = attr.size;
+    } else {
+        memset(&attr, 0, sizeof(attr));
+        attr.type = RKNN_TENSOR_FLOAT32;
+    }
+    chooseInputPath(*state, attr, desc_);
+    state->numOutputs = num.n_output;
+    if (desc_.zeroCopy && state->spec.type == TensorElementType::Uint8 && num.n_output >= 1 &&
+        !setupZeroCopy(*state)) {
+        std::cerr << "[RknnDetectorBackend] zero-copy io unavailable, using rknn_inputs_set" << std::endl;
+    }
+    state->inputSize = static_cast<uint32_t>(inputTensorBytes(state->spec));
+    if (!state->zeroCopy) state->input.resize(state->inputSize);
+
+    auto* pool = new RknnState();
+    pool->contexts.push_back(std::move(owner));
+    for (std::size_t i = 1; i < contexts; ++i) {
+        auto dup = std::make_unique<RknnContext>();
+        if (!duplicateContext(*state, *dup, preprocess)) break;  // 已复制出的上下文照常使用
+        pool->contexts.push_back(std::move(dup));
     }
-    if (state->inputSize == 0)
-        state->inputSize = 1 * 3 * static_cast<uint32_t>(state->inputH) * static_cast<uint32_t>(state->inputW) * sizeof(float);
+    for (auto& context : pool->contexts) pool->idle.push_back(context.get());
 
-    rknnState_ = state;
+    rknnState_ = pool;
     loaded_ = true;
+    async_ = std::make_unique<AsyncInferenceQueue>(*this, maxConcurrentRuns());
+    if (npuCoreMask_ != 0 || pool->contexts.size() > 1) {
+        setNpuCoreMask(npuCoreMask_);
+    }
     std::cout << "[RknnDetectorBackend] loaded: " << desc_.modelPath
               << " " << state->inputW << "x" << state->inputH
-              << " fmt=" << (state->inputFmt == RKNN_TENSOR_NCHW ? "NCHW" : "NHWC") << std::endl;
+              << " fmt=" << (state->inputFmt == RKNN_TENSOR_NCHW ? "NCHW" : "NHWC")
+              << " type=" << tensorTypeName(state->inputType) << " feed=" << tensorTypeName(state->feedType)
+              << (state->feedFmt == RKNN_TENSOR_NCHW ? "/NCHW" : "/NHWC")
+              << (state->passThrough ? " pass_through" : "") << (state->zeroCopy ? " zero_copy" : "")
+              << " contexts=" << pool->contexts.size() << std::endl;
     return true;
 #else
     loaded_ = true;
+    async_ = std::make_unique<AsyncInferenceQueue>(*this, maxConcurrentRuns());
     std::cout << "[RknnDetectorBackend] load (stub): " << desc_.modelPath
               << " (id=" << desc_.detectorId << ")" << std::endl;
     return true;
 #endif
 }
 
+bool RknnDetectorBackend::setClassFilter(const std::vector<int>& classIds) {
+    classFilter_ = normalizeClassIds(classIds);
+    return true;
+}
+
+bool RknnDetectorBackend::setNpuCoreMask(std::uint32_t mask) {
+    npuCoreMask_ = mask;
+#if defined(FALCONMINDSDK_RKNN_BACKEND_ENABLED) && FALCONMINDSDK_RKNN_BACKEND_ENABLED
+    if (!rknnState_) {
+        return true;  // load() 时应用
+    }
+    auto* pool = static_cast<RknnState*>(rknnState_);
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    const std::size_t n = pool->contexts.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!applyCoreMask(*pool->contexts[i], contextCoreMask(mask, i, n))) return false;
+    }
+#endif
+    std::cout << "[RknnDetectorBackend] NPU core mask " << mask << std::endl;
+    return true;
+}
+
+std::size_t RknnDetectorBackend::maxConcurrentRuns() const {
+#if defined(FALCONMINDSDK_RKNN_BACKEND_ENABLED) && FALCONMINDSDK_RKNN_BACKEND_ENABLED
+    if (rknnState_) return static_cast<RknnState*>(rknnState_)->contexts.size();
+#endif
+    return 1;
+}
+
 void RknnDetectorBackend::unload() {
+    async_.reset();  // 等待在途的异步推理完成
 #if defined(FALCONMINDSDK_RKNN_BACKEND_ENABLED) && FALCONMINDSDK_RKNN_BACKEND_ENABLED
     if (rknnState_) {
-        auto* state = static_cast<RknnState*>(rknnState_);
-        if (state->ctx) {
-            rknn_destroy(state->ctx);
-            state->ctx = 0;
+        auto* pool = static_cast<RknnState*>(rknnState_);
+        {
+            // 等待在途的 run() 全部归还上下文
+            std::unique_lock<std::mutex> lock(pool->mutex);
+            pool->idleCv.wait(lock, [pool] { return pool->idle.size() == pool->contexts.size(); });
         }
-        delete state;
+        // 复制出的上下文先于主上下文销毁
+        for (auto it = pool->contexts.rbegin(); it != pool->contexts.rend(); ++it) destroyContext(**it);
+        delete pool;
         rknnState_ = nullptr;
     }
 #endif
@@ -106,6 +701,19 @@ void RknnDetectorBackend::unload() {
     loaded_ = false;
 }
 
+bool RknnDetectorBackend::submit(const ImageView& image, DetectionResult& outResult, DetectionCallback done) {
+    if (!async_) return IDetectorBackend::submit(image, outResult, std::move(done));
+    return async_->submit(image, outResult, std::move(done));
+}
+
+std::size_t RknnDetectorBackend::maxInFlight() const {
+    return async_ ? async_->depth() : 1;
+}
+
+std::vector<core::PixelFormat> RknnDetectorBackend::supportedPixelFormats() const {
+    return YoloPreprocessor::pixelFormats();
+}
+
 bool RknnDetectorBackend::run(const ImageView& image, DetectionResult& outResult) {
     if (!loaded_) {
         std::cerr << "[RknnDetectorBackend] run() called before load()" << std::endl;
@@ -113,102 +721,117 @@ bool RknnDetectorBackend::run(const ImageView& image, DetectionResult& outResult
     }
 
 #if defined(FALCONMINDSDK_RKNN_BACKEND_ENABLED) && FALCONMINDSDK_RKNN_BACKEND_ENABLED
-    auto* state = static_cast<RknnState*>(rknnState_);
-    if (!state || !state->ctx) return false;
-
-    const int inputW = state->inputW;
-    const int inputH = state->inputH;
-    const int numClasses = desc_.numClasses > 0 ? desc_.numClasses : 80;
-    const float scoreThr = desc_.scoreThreshold > 0 ? desc_.scoreThreshold : 0.25f;
-    const float nmsThr = desc_.nmsThreshold >= 0 ? desc_.nmsThreshold : 0.45f;
-
-    std::vector<float> inputBuf(1 * 3 * inputH * inputW);
-    int srcStride = image.stride > 0 ? image.stride : (image.width * 3);
-    bool bgr = (image.pixelFormat == "BGR8" || image.pixelFormat == "bgr8");
-    resizeImageToFloatNchw(image.data, image.width, image.height, srcStride, bgr,
-                           inputBuf.data(), inputW, inputH);
-
-    rknn_input inputs[1];
-    memset(inputs, 0, sizeof(inputs));
-    inputs[0].index = 0;
-    inputs[0].buf = inputBuf.data();
-    inputs[0].size = static_cast<uint32_t>(inputBuf.size() * sizeof(float));
-    inputs[0].pass_through = 0;
-    inputs[0].type = RKNN_TENSOR_FLOAT32;
-    inputs[0].fmt = RKNN_TENSOR_NCHW;
-
-    int ret = rknn_inputs_set(state->ctx, 1, inputs);
-    if (ret != RKNN_SUCC) {
-        std::cerr << "[RknnDetectorBackend] rknn_inputs_set failed: " << ret << std::endl;
-        return false;
-    }
-    ret = rknn_run(state->ctx, nullptr);
-    if (ret != RKNN_SUCC) {
-        std::cerr << "[RknnDetectorBackend] rknn_run failed: " << ret << std::endl;
-        return false;
-    }
+    auto* pool = static_cast<RknnState*>(rknnState_);
+    if (!pool) return false;
+    RknnContext* context = acquireContext(*pool);
+    const bool ok = context->ctx && runContext(*context, desc_, classFilter_, image, outResult);
+    releaseContext(*pool, context);
+    return ok;
+#else
+    FM_LOG_DEBUG("RknnDetectorBackend", "run() (stub): ", image.width, "x", image.height,
+                 " format=", image.pixelFormat, " model=", desc_.modelPath);
+    outResult.detections.clear();
+    outResult.frameId.clear();
+    outResult.frameIndex = image.frameIndex;
+    outResult.timestampNs = static_cast<std::uint64_t>(image.captureTimestampNs);
+    return true;
+#endif
+}
 
-    rknn_input_output_num num;
-    ret = rknn_query(state->ctx, RKNN_QUERY_IN_OUT_NUM, &num, sizeof(num));
-    if (ret != RKNN_SUCC || num.n_output < 1) {
-        outResult.detections.clear();
-        return true;
-    }
+std::size_t RknnDetectorBackend::prepareStages(std::size_t slots) {
+#if defined(FALCONMINDSDK_RKNN_BACKEND_ENABLED) && FALCONMINDSDK_RKNN_BACKEND_ENABLED
+    auto* pool = static_cast<RknnState*>(rknnState_);
+    if (!pool || slots == 0) return 0;
+    const RknnContext& primary = *pool->contexts.front();
+    YoloPreprocessConfig preprocess = yoloPreprocessConfig(desc_);
+    if (desc_.preprocessThreads <= 0) preprocess.threads = 1;  // 与推理重叠后前处理不在关键路径上
+    pool->stagedPreprocessor = std::make_unique<YoloPreprocessor>(preprocess);
+    pool->stagedSlots.assign(slots, RknnStagedSlot{});
+    for (auto& slot : pool->stagedSlots) slot.input.resize(inputTensorBytes(primary.spec));
+    return slots;
+#else
+    (void)slots;
+    return 0;
+#endif
+}
 
-    std::vector<rknn_output> outputs(num.n_output);
-    for (uint32_t i = 0; i < num.n_output; ++i) {
-        outputs[i].want_float = 1;
-        outputs[i].is_prealloc = 0;
-        outputs[i].index = i;
-        outputs[i].buf = nullptr;
-        outputs[i].size = 0;
-    }
-    ret = rknn_outputs_get(state->ctx, num.n_output, outputs.data(), nullptr);
-    if (ret != RKNN_SUCC) {
-        std::cerr << "[RknnDetectorBackend] rknn_outputs_get failed: " << ret << std::endl;
+bool RknnDetectorBackend::preprocessStage(std::size_t slotIndex, const ImageView& image) {
+#if defined(FALCONMINDSDK_RKNN_BACKEND_ENABLED) && FALCONMINDSDK_RKNN_BACKEND_ENABLED
+    auto* pool = static_cast<RknnState*>(rknnState_);
+    if (!pool || slotIndex >= pool->stagedSlots.size()) return false;
+    const RknnContext& primary = *pool->contexts.front();
+    RknnStagedSlot& slot = pool->stagedSlots[slotIndex];
+    StageTimer timer(desc_.profiling);
+    if (!pool->stagedPreprocessor->run(image, primary.spec, slot.input.data(), slot.transform)) {
+        std::cerr << "[RknnDetectorBackend] unsupported input " << image.width << "x" << image.height
+                  << " format=" << image.pixelFormat << std::endl;
         return false;
     }
-
-    float* outputData = static_cast<float*>(outputs[0].buf);
-    uint32_t outputSize = outputs[0].size;
-    if (!outputData || outputSize < 4 * sizeof(float)) {
-        rknn_outputs_release(state->ctx, num.n_output, outputs.data());
-        outResult.detections.clear();
-        return true;
+    if (primary.passThrough && !primary.quantTableIdentity) {
+        applyByteTable(primary.quantTable, slot.input.data(), slot.input.size());
     }
+    slot.imageWidth = image.width;
+    slot.imageHeight = image.height;
+    slot.frameIndex = image.frameIndex;
+    slot.timestampNs = image.captureTimestampNs;
+    slot.timing = DetectionTiming{};
+    slot.timing.preprocessUs = timer.lapUs();
+    return true;
+#else
+    (void)slotIndex;
+    (void)image;
+    return false;
+#endif
+}
 
-    rknn_tensor_attr outAttr;
-    memset(&outAttr, 0, sizeof(outAttr));
-    outAttr.index = 0;
-    rknn_query(state->ctx, RKNN_QUERY_OUTPUT_ATTR, &outAttr, sizeof(outAttr));
-    size_t numChannels = (outAttr.n_dims >= 2) ? static_cast<size_t>(outAttr.dims[1]) : 84;
-    size_t numBoxes = (outAttr.n_dims >= 3) ? static_cast<size_t>(outAttr.dims[2]) : 8400;
+bool RknnDetectorBackend::inferStage(std::size_t slotIndex) {
+#if defined(FALCONMINDSDK_RKNN_BACKEND_ENABLED) && FALCONMINDSDK_RKNN_BACKEND_ENABLED
+    auto* pool = static_cast<RknnState*>(rknnState_);
+    if (!pool || slotIndex >= pool->stagedSlots.size()) return false;
+    RknnStagedSlot& slot = pool->stagedSlots[slotIndex];
+    RknnContext* context = acquireContext(*pool);
+    StageTimer timer(desc_.profiling);
+    const bool ok = context->ctx && inferStaged(*context, slot);
+    slot.timing.inferUs = timer.lapUs();
+    if (ok) queryDevicePerf(*context, slot.timing);
+    releaseContext(*pool, context);
+    return ok;
+#else
+    (void)slotIndex;
+    return false;
+#endif
+}
 
+bool RknnDetectorBackend::postprocessStage(std::size_t slotIndex, DetectionResult& outResult) {
+#if defined(FALCONMINDSDK_RKNN_BACKEND_ENABLED) && FALCONMINDSDK_RKNN_BACKEND_ENABLED
+    auto* pool = static_cast<RknnState*>(rknnState_);
+    if (!pool || slotIndex >= pool->stagedSlots.size()) return false;
+    RknnStagedSlot& slot = pool->stagedSlots[slotIndex];
+    const int numClasses = desc_.numClasses > 0 ? desc_.numClasses : 80;
+    const float scoreThr = desc_.scoreThreshold > 0 ? desc_.scoreThreshold : 0.25f;
+    StageTimer timer(desc_.profiling);
     std::vector<YoloRawDet> raw;
-    decodeYoloOutput84xN(outputData, numChannels, numBoxes, numClasses, scoreThr, raw);
-    rknn_outputs_release(state->ctx, num.n_output, outputs.data());
-
-    if (raw.empty()) {
-        outResult.detections.clear();
-        outResult.frameIndex = 0;
-        outResult.timestampNs = 0;
-        return true;
+    if (slot.output.size() >= slot.numChannels * slot.numBoxes) {
+        decodeYoloOutput84xN(slot.output.data(), slot.numChannels, slot.numBoxes, numClasses, scoreThr, raw,
+                             classFilter_);
     }
-
-    std::vector<bool> suppressed;
-    nmsYoloDetections(raw, nmsThr, suppressed);
-    float scaleX = (image.width > 0 && inputW > 0) ? (image.width / static_cast<float>(inputW)) : 1.0f;
-    float scaleY = (image.height > 0 && inputH > 0) ? (image.height / static_cast<float>(inputH)) : 1.0f;
-    fillDetectionResultFromYolo(raw, suppressed, scaleX, scaleY, outResult);
-    return true;
-#else
-    std::cout << "[RknnDetectorBackend] run() (stub): " << image.width << "x" << image.height
-              << " format=" << image.pixelFormat << " model=" << desc_.modelPath << std::endl;
+    slot.timing.decodeUs = timer.lapUs();
     outResult.detections.clear();
+    if (!raw.empty()) {
+        std::vector<bool> suppressed;
+        nmsYoloDetections(raw, nmsConfig(desc_), suppressed);
+        fillDetectionResultFromYolo(raw, suppressed, slot.transform, slot.imageWidth, slot.imageHeight, outResult);
+    }
+    slot.timing.nmsUs = timer.lapUs();
+    outResult.timing = slot.timing;
     outResult.frameId.clear();
-    outResult.frameIndex = 0;
-    outResult.timestampNs = 0;
+    outResult.frameIndex = slot.frameIndex;
+    outResult.timestampNs = static_cast<std::uint64_t>(slot.timestampNs);
     return true;
+#else
+    (void)slotIndex;
+    (void)outResult;
+    return false;
 #endif
 }
 
@@ -0,0 +1,242 @@
+#include "falconmind/sdk/perception/ShmPoseChannel.h"
+#include "falconmind/sdk/core/SeqLock.h"
+#include "falconmind/sdk/perception/PoseInterpolation.h"
+
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+constexpr std::uint32_t kPoseShmMagic = 0x50534D46;  // "FMSP"
+constexpr std::uint32_t kPoseShmVersion = 1;
+constexpr std::size_t kAlign = 64;
+
+using PoseSlot = core::SeqLock<PoseWithCovariance>;
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "shm atomics must be address-free");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shm atomics must be address-free");
+
+// 写端与读端各占不同缓存行：latest 与 head 由写端更新，读端只读
+struct alignas(kAlign) PoseShmHeader {
+    std::atomic<std::uint32_t> magic;  // 初始化完成后最后写入
+    std::uint32_t version;
+    std::uint32_t ringCapacity;
+    std::uint32_t slotStride;
+    std::atomic<std::uint32_t> closed;
+
+    alignas(kAlign) core::SeqLock<Pose3D> latest;
+    alignas(kAlign) std::atomic<std::uint64_t> head;
+};
+
+std::size_t alignUp(std::size_t v) {
+    return (v + kAlign - 1) / kAlign * kAlign;
+}
+
+std::size_t roundUpPow2(std::size_t n) {
+    std::size_t p = 2;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+std::string shmPath(const std::string& name) {
+    return "/" + name;
+}
+
+bool validName(const std::string& name) {
+    return !name.empty() && name.size() < NAME_MAX && name.find('/') == std::string::npos;
+}
+
+} // namespace
+
+struct ShmPoseWriter::Mapping {
+    void* base{MAP_FAILED};
+    std::size_t length{0};
+    core::SeqLockRing<PoseWithCovariance> ring;
+
+    ~Mapping() {
+        if (base != MAP_FAILED) munmap(base, length);
+    }
+
+    PoseShmHeader* header() const { return static_cast<PoseShmHeader*>(base); }
+    PoseSlot* slots() const {
+        return reinterpret_cast<PoseSlot*>(static_cast<std::uint8_t*>(base) + alignUp(sizeof(PoseShmHeader)));
+    }
+    void bindRing() { ring = core::SeqLockRing<PoseWithCovariance>(slots(), &header()->head, header()->ringCapacity); }
+};
+
+ShmPoseWriter::ShmPoseWriter(std::string name, std::shared_ptr<Mapping> mapping)
+    : name_(std::move(name)), mapping_(std::move(mapping)) {}
+
+ShmPoseWriter::~ShmPoseWriter() {
+    if (mapping_) {
+        mapping_->header()->closed.store(1, std::memory_order_release);
+        shm_unlink(shmPath(name_).c_str());
+    }
+}
+
+std::shared_ptr<ShmPoseWriter> ShmPoseWriter::create(const std::string& name, std::size_t ringCapacity) {
+    if (!validName(name) || ringCapacity == 0 || ringCapacity > (1u << 20)) {
+        std::cerr << "[ShmPoseWriter] Invalid channel config: " << name << std::endl;
+        return nullptr;
+    }
+    const std::size_t capacity = roundUpPow2(ringCapacity);
+    std::string path = shmPath(name);
+    shm_unlink(path.c_str());  // 上次异常退出的残留
+    int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+    if (fd < 0) {
+        std::cerr << "[ShmPoseWriter] shm_open failed: " << path << ": " << std::strerror(errno) << std::endl;
+        return nullptr;
+    }
+    const std::size_t length = alignUp(sizeof(PoseShmHeader)) + sizeof(PoseSlot) * capacity;
+    if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+        std::cerr << "[ShmPoseWriter] ftruncate failed: " << path << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        shm_unlink(path.c_str());
+        return nullptr;
+    }
+    auto mapping = std::make_shared<Mapping>();
+    mapping->base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    mapping->length = length;
+    close(fd);
+    if (mapping->base == MAP_FAILED) {
+        std::cerr << "[ShmPoseWriter] mmap failed: " << path << ": " << std::strerror(errno) << std::endl;
+        shm_unlink(path.c_str());
+        return nullptr;
+    }
+
+    // ftruncate 后内容为零；在映射上构造原子对象
+    auto* h = new (mapping->base) PoseShmHeader();
+    h->version = kPoseShmVersion;
+    h->ringCapacity = static_cast<std::uint32_t>(capacity);
+    h->slotStride = static_cast<std::uint32_t>(sizeof(PoseSlot));
+    h->head.store(0, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < capacity; ++i) {
+        new (mapping->slots() + i) PoseSlot();
+    }
+    mapping->bindRing();
+    h->magic.store(kPoseShmMagic, std::memory_order_release);
+    return std::shared_ptr<ShmPoseWriter>(new ShmPoseWriter(name, std::move(mapping)));
+}
+
+void ShmPoseWriter::publish(const Pose3D& pose) noexcept {
+    PoseWithCovariance sample;
+    sample.pose = pose;
+    publish(sample);
+}
+
+void ShmPoseWriter::publish(const PoseWithCovariance& sample) noexcept {
+    // 先写历史再写 latest：读端看到的最新位姿总能在历史中找到
+    mapping_->ring.push(sample);
+    mapping_->header()->latest.store(sample.pose);
+}
+
+std::uint64_t ShmPoseWriter::published() const noexcept {
+    return mapping_->ring.count();
+}
+
+ShmPoseReader::ShmPoseReader(std::string name, std::shared_ptr<ShmPoseWriter::Mapping> mapping)
+    : name_(std::move(name)), mapping_(std::move(mapping)) {}
+
+std::shared_ptr<ShmPoseReader> ShmPoseReader::open(const std::string& name) {
+    if (!validName(name)) {
+        return nullptr;
+    }
+    int fd = shm_open(shmPath(name).c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(PoseShmHeader)) {
+        close(fd);
+        return nullptr;
+    }
+    auto mapping = std::make_shared<ShmPoseWriter::Mapping>();
+    mapping->length = static_cast<std::size_t>(st.st_size);
+    // 读端也映射为可写：SeqLock 读取只做 load，但 std::atomic 不保证只读页上的语义
+    mapping->base = mmap(nullptr, mapping->length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping->base == MAP_FAILED) {
+        return nullptr;
+    }
+    auto* h = mapping->header();
+    const std::uint32_t cap = h->ringCapacity;
+    if (h->magic.load(std::memory_order_acquire) != kPoseShmMagic || h->version != kPoseShmVersion || cap < 2 ||
+        (cap & (cap - 1)) != 0 || h->slotStride != sizeof(PoseSlot) ||
+        alignUp(sizeof(PoseShmHeader)) + sizeof(PoseSlot) * cap > mapping->length) {
+        std::cerr << "[ShmPoseReader] Channel not ready or incompatible: " << name << std::endl;
+        return nullptr;
+    }
+    mapping->bindRing();
+    return std::shared_ptr<ShmPoseReader>(new ShmPoseReader(name, std::move(mapping)));
+}
+
+bool ShmPoseReader::latest(Pose3D& pose) const noexcept {
+    const auto& slot = mapping_->header()->latest;
+    if (slot.version() == 0) return false;
+    pose = slot.load();
+    return true;
+}
+
+bool ShmPoseReader::latest(PoseWithCovariance& sample) const noexcept {
+    return mapping_->ring.latest(sample);
+}
+
+std::size_t ShmPoseReader::history(PoseWithCovariance* out, std::size_t maxCount) const noexcept {
+    return mapping_->ring.recent(out, maxCount, [](const PoseWithCovariance& s) { return s.pose.timestampNs; });
+}
+
+bool ShmPoseReader::poseAt(std::uint64_t timestampNs, Pose3D& pose) const noexcept {
+    return poseAtInRing(mapping_->ring, timestampNs, pose,
+                        [](const PoseWithCovariance& s) -> const Pose3D& { return s.pose; });
+}
+
+bool ShmPoseReader::closed() const noexcept {
+    return mapping_->header()->closed.load(std::memory_order_acquire) != 0;
+}
+
+std::uint64_t ShmPoseReader::published() const noexcept {
+    return mapping_->ring.count();
+}
+
+std::size_t ShmPoseReader::ringCapacity() const noexcept {
+    return mapping_->ring.capacity();
+}
+
+const ShmPoseReader* SlamServiceClientFromShm::reader() const {
+    if (reader_ && !reader_->closed()) return reader_.get();
+    reader_.reset();
+    const auto now = std::chrono::steady_clock::now();
+    if (lastOpenAttempt_ != std::chrono::steady_clock::time_point{} && now - lastOpenAttempt_ < reopenInterval_) {
+        return nullptr;
+    }
+    lastOpenAttempt_ = now;
+    reader_ = ShmPoseReader::open(name_);
+    return reader_.get();
+}
+
+bool SlamServiceClientFromShm::getPose(Pose3D& pose) {
+    const auto* r = reader();
+    return r && r->latest(pose);
+}
+
+bool SlamServiceClientFromShm::isAvailable() const {
+    const auto* r = reader();
+    return r && r->published() > 0;
+}
+
+bool SlamServiceClientFromShm::poseAt(std::uint64_t timestampNs, Pose3D& pose) {
+    const auto* r = reader();
+    return r && r->poseAt(timestampNs, pose);
+}
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,127 @@
+#include "falconmind/sdk/perception/SlamServiceGrpcClient.h"
+
+#include <iostream>
+#include <mutex>
+
+#if defined(FALCONMINDSDK_GRPC_SLAM_ENABLED) && FALCONMINDSDK_GRPC_SLAM_ENABLED
+#include <grpcpp/grpcpp.h>
+
+#include "slam_service.grpc.pb.h"
+#endif
+
+namespace falconmind::sdk::perception {
+
+#if defined(FALCONMINDSDK_GRPC_SLAM_ENABLED) && FALCONMINDSDK_GRPC_SLAM_ENABLED
+
+struct GrpcPoseStream::Impl {
+    std::shared_ptr<grpc::Channel> channel;
+    std::unique_ptr<falconmind::slam::SLAMService::Stub> stub;
+    std::mutex mutex;  // 保护 context / cancelled（cancel 来自其他线程）
+    std::unique_ptr<grpc::ClientContext> context;
+    std::unique_ptr<grpc::ClientReader<falconmind::slam::GetPoseResponse>> reader;
+    falconmind::slam::GetPoseResponse response;
+    bool cancelled{false};
+};
+
+GrpcPoseStream::GrpcPoseStream(std::string target, std::uint32_t maxRateHz)
+    : target_(std::move(target)), maxRateHz_(maxRateHz), impl_(std::make_unique<Impl>()) {
+    impl_->channel = grpc::CreateChannel(target_, grpc::InsecureChannelCredentials());
+    impl_->stub = falconmind::slam::SLAMService::NewStub(impl_->channel);
+}
+
+GrpcPoseStream::~GrpcPoseStream() {
+    cancel();
+}
+
+bool GrpcPoseStream::available() noexcept {
+    return true;
+}
+
+bool GrpcPoseStream::open() {
+    falconmind::slam::SubscribePoseRequest request;
+    request.set_max_rate_hz(maxRateHz_);
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    if (impl_->cancelled) return false;
+    impl_->reader.reset();
+    impl_->context = std::make_unique<grpc::ClientContext>();
+    // 服务端不可达时快速失败，交给客户端退避重连
+    impl_->context->set_wait_for_ready(false);
+    impl_->reader = impl_->stub->SubscribePose(impl_->context.get(), request);
+    return impl_->reader != nullptr;
+}
+
+bool GrpcPoseStream::read(Pose3D& pose) {
+    auto& r = impl_->response;
+    if (!impl_->reader || !impl_->reader->Read(&r)) {
+        if (impl_->reader) {
+            const grpc::Status status = impl_->reader->Finish();
+            if (!status.ok() && status.error_code() != grpc::StatusCode::CANCELLED) {
+                std::cerr << "[GrpcPoseStream] SubscribePose " << target_ << " ended: " << status.error_message()
+                          << std::endl;
+            }
+        }
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->reader.reset();
+        return false;
+    }
+    pose.x = r.x();
+    pose.y = r.y();
+    pose.z = r.z();
+    pose.qx = r.qx();
+    pose.qy = r.qy();
+    pose.qz = r.qz();
+    pose.qw = r.qw();
+    pose.timestampNs = r.timestamp_ns();
+    return true;
+}
+
+void GrpcPoseStream::cancel() {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->cancelled = true;
+    if (impl_->context) impl_->context->TryCancel();
+}
+
+void GrpcPoseStream::reset() {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->cancelled = false;
+}
+
+#else
+
+struct GrpcPoseStream::Impl {};
+
+GrpcPoseStream::GrpcPoseStream(std::string target, std::uint32_t maxRateHz)
+    : target_(std::move(target)), maxRateHz_(maxRateHz) {}
+
+GrpcPoseStream::~GrpcPoseStream() = default;
+
+bool GrpcPoseStream::available() noexcept {
+    return false;
+}
+
+bool GrpcPoseStream::open() {
+    static std::once_flag warned;
+    std::call_once(warned, [this] {
+        std::cerr << "[GrpcPoseStream] built without gRPC support (FALCONMINDSDK_BUILD_GRPC_SLAM_CLIENT=OFF), "
+                  << target_ << " unavailable" << std::endl;
+    });
+    return false;
+}
+
+bool GrpcPoseStream::read(Pose3D&) {
+    return false;
+}
+
+void GrpcPoseStream::cancel() {}
+
+void GrpcPoseStream::reset() {}
+
+#endif
+
+std::shared_ptr<StreamingSlamClient> makeGrpcSlamClient(const std::string& target, std::uint32_t maxRateHz,
+                                                        std::size_t historyCapacity) {
+    return std::make_shared<StreamingSlamClient>(std::make_shared<GrpcPoseStream>(target, maxRateHz),
+                                                 historyCapacity);
+}
+
+} // namespace falconmind::sdk::perception
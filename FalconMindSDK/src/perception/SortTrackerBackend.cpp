@@ -1,5 +1,6 @@
 #include "falconmind/sdk/perception/SortTrackerBackend.h"
 #include "falconmind/sdk/perception/DetectionTypes.h"
+#include "falconmind/sdk/core/StateCheckpoint.h"
 
 #include <algorithm>
 #include <cmath>
@@ -29,6 +30,138 @@ float iou(const DetectionBBox& a, const DetectionBBox& b) {
 
 } // namespace
 
+void SortTrackTable::clear() {
+    trackId.clear();
+    cx.clear(); cy.clear(); w.clear(); h.clear();
+    vx.clear(); vy.clear();
+    lastTimestampNs.clear();
+    missedFrames.clear();
+    uncertainty.clear();
+    score.clear();
+    classId.clear();
+    classNameIndex.clear();
+    historySlot.clear();
+    classNames.clear();
+    historyPoints_.clear();
+    historyOldest_.clear();
+    historyCount_.clear();
+    freeSlots_.clear();
+}
+
+std::uint16_t SortTrackTable::internClassName(const std::string& name) {
+    for (std::size_t i = 0; i < classNames.size(); ++i) {
+        if (classNames[i] == name) return static_cast<std::uint16_t>(i);
+    }
+    if (classNames.size() >= 0xffff) return 0;
+    classNames.push_back(name);
+    return static_cast<std::uint16_t>(classNames.size() - 1);
+}
+
+std::size_t SortTrackTable::add(int id, const DetectionBBox& bbox, std::uint64_t ts, float s, int cls,
+                                const std::string& name) {
+    trackId.push_back(id);
+    cx.push_back(bbox.x + bbox.width * 0.5f);
+    cy.push_back(bbox.y + bbox.height * 0.5f);
+    w.push_back(bbox.width);
+    h.push_back(bbox.height);
+    vx.push_back(0.f);
+    vy.push_back(0.f);
+    lastTimestampNs.push_back(ts);
+    missedFrames.push_back(0);
+    uncertainty.push_back(0.f);
+    score.push_back(s);
+    classId.push_back(cls);
+    classNameIndex.push_back(internClassName(name));
+
+    std::uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = static_cast<std::uint32_t>(historyCount_.size());
+        historyOldest_.push_back(0);
+        historyCount_.push_back(0);
+        historyPoints_.resize(historyPoints_.size() + historyCapacity_);
+    }
+    historyOldest_[slot] = 0;
+    historyCount_[slot] = 0;
+    historySlot.push_back(slot);
+    return size() - 1;
+}
+
+void SortTrackTable::compact(const std::vector<bool>& remove) {
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < size(); ++i) {
+        if (remove[i]) {
+            freeSlots_.push_back(historySlot[i]);
+            continue;
+        }
+        if (out != i) {
+            trackId[out] = trackId[i];
+            cx[out] = cx[i]; cy[out] = cy[i]; w[out] = w[i]; h[out] = h[i];
+            vx[out] = vx[i]; vy[out] = vy[i];
+            lastTimestampNs[out] = lastTimestampNs[i];
+            missedFrames[out] = missedFrames[i];
+            uncertainty[out] = uncertainty[i];
+            score[out] = score[i];
+            classId[out] = classId[i];
+            classNameIndex[out] = classNameIndex[i];
+            historySlot[out] = historySlot[i];
+        }
+        ++out;
+    }
+    if (out == size()) return;
+    trackId.resize(out);
+    cx.resize(out); cy.resize(out); w.resize(out); h.resize(out);
+    vx.resize(out); vy.resize(out);
+    lastTimestampNs.resize(out);
+    missedFrames.resize(out);
+    uncertainty.resize(out);
+    score.resize(out);
+    classId.resize(out);
+    classNameIndex.resize(out);
+    historySlot.resize(out);
+}
+
+void SortTrackTable::setHistoryCapacity(std::size_t capacity) {
+    capacity = std::max<std::size_t>(1, capacity);
+    if (capacity == historyCapacity_) return;
+    // 重新分布历史：每个槽保留最近 min(count, capacity) 个点，从下标 0 开始
+    std::vector<TrackHistoryPoint> points(historyCount_.size() * capacity);
+    for (std::size_t slot = 0; slot < historyCount_.size(); ++slot) {
+        const std::size_t count = historyCount_[slot];
+        const std::size_t keep = std::min(count, capacity);
+        const TrackHistoryPoint* ring = &historyPoints_[slot * historyCapacity_];
+        for (std::size_t k = 0; k < keep; ++k) {
+            points[slot * capacity + k] = ring[(historyOldest_[slot] + count - keep + k) % historyCapacity_];
+        }
+        historyOldest_[slot] = 0;
+        historyCount_[slot] = static_cast<std::uint32_t>(keep);
+    }
+    historyPoints_ = std::move(points);
+    historyCapacity_ = capacity;
+}
+
+void SortTrackTable::pushHistory(std::size_t i, const TrackHistoryPoint& p) {
+    const std::uint32_t slot = historySlot[i];
+    TrackHistoryPoint* ring = &historyPoints_[static_cast<std::size_t>(slot) * historyCapacity_];
+    std::uint32_t& oldest = historyOldest_[slot];
+    std::uint32_t& count = historyCount_[slot];
+    if (count < historyCapacity_) {
+        ring[(oldest + count) % historyCapacity_] = p;
+        ++count;
+    } else {
+        ring[oldest] = p;
+        oldest = static_cast<std::uint32_t>((oldest + 1) % historyCapacity_);
+    }
+}
+
+TrajectoryView SortTrackTable::history(std::size_t i) const {
+    const std::uint32_t slot = historySlot[i];
+    return TrajectoryView(&historyPoints_[static_cast<std::size_t>(slot) * historyCapacity_], historyCapacity_,
+                          historyOldest_[slot], historyCount_[slot]);
+}
+
 SortTrackerBackend::SortTrackerBackend() = default;
 
 SortTrackerBackend::~SortTrackerBackend() = default;
@@ -53,16 +186,34 @@ DetectionBBox SortTrackerBackend::centerToBbox(float cx, float cy, float w, floa
     return b;
 }
 
-void SortTrackerBackend::pruneTrajectory(std::vector<TrackHistoryPoint>& traj, int maxPoints) {
-    if (static_cast<int>(traj.size()) <= maxPoints) return;
-    traj.erase(traj.begin(), traj.end() - maxPoints);
+void SortTrackerBackend::setMaxTrajectoryPoints(int n) {
+    maxTrajectoryPoints_ = std::max(1, n);
+    tracks_.setHistoryCapacity(static_cast<std::size_t>(maxTrajectoryPoints_));
+}
+
+void SortTrackerBackend::growUncertainty(std::size_t i) {
+    const float size = std::max(1.f, std::max(tracks_.w[i], tracks_.h[i]));
+    const float vx = tracks_.vx[i];
+    const float vy = tracks_.vy[i];
+    tracks_.uncertainty[i] += processNoise_ + std::sqrt(vx * vx + vy * vy) / size;
+}
+
+void SortTrackerBackend::writeState(std::size_t i, const char* status, TrackingState& out) const {
+    out.trackId = tracks_.trackId[i];
+    out.targetClassId = tracks_.classId[i];
+    out.targetClassName = tracks_.className(i);
+    out.status = status;
+    out.uncertainty = tracks_.uncertainty[i];
+    out.history = tracks_.history(i);
+    if (copyTrajectory_) out.trajectory = out.history.toVector();
 }
 
 bool SortTrackerBackend::load() {
     loaded_ = true;
     tracks_.clear();
+    tracks_.setHistoryCapacity(static_cast<std::size_t>(std::max(1, maxTrajectoryPoints_)));
     nextTrackId_ = 1;
-    std::cout << "[SortTrackerBackend] load() SORT (predict+IoU match) iou_thr=" << iouThreshold_
+    std::cout << "[SortTrackerBackend] load() SORT (predict+JV IoU assignment) iou_thr=" << iouThreshold_
               << " max_missed=" << maxMissedFrames_ << std::endl;
     return true;
 }
@@ -73,6 +224,62 @@ void SortTrackerBackend::unload() {
     tracks_.clear();
 }
 
+bool SortTrackerBackend::saveState(core::CheckpointWriter& out) const {
+    out.pod(static_cast<std::int32_t>(nextTrackId_));
+    out.pod(static_cast<std::uint32_t>(tracks_.size()));
+    for (std::size_t i = 0; i < tracks_.size(); ++i) {
+        out.pod(static_cast<std::int32_t>(tracks_.trackId[i]));
+        const float state[8] = {tracks_.cx[i], tracks_.cy[i], tracks_.w[i], tracks_.h[i],
+                                tracks_.vx[i], tracks_.vy[i], tracks_.uncertainty[i], tracks_.score[i]};
+        out.bytes(state, sizeof(state));
+        out.pod(tracks_.lastTimestampNs[i]);
+        out.pod(static_cast<std::int32_t>(tracks_.missedFrames[i]));
+        out.pod(static_cast<std::int32_t>(tracks_.classId[i]));
+        out.str(tracks_.className(i));
+        const TrajectoryView history = tracks_.history(i);
+        out.pod(static_cast<std::uint32_t>(history.size()));
+        for (std::size_t k = 0; k < history.size(); ++k) out.pod(history[k]);
+    }
+    return true;
+}
+
+bool SortTrackerBackend::restoreState(core::CheckpointReader& in) {
+    if (!loaded_) return false;
+    std::int32_t nextId = 0;
+    std::uint32_t count = 0;
+    if (!in.pod(nextId) || !in.pod(count)) return false;
+    SortTrackTable restored;
+    restored.setHistoryCapacity(tracks_.historyCapacity());
+    for (std::uint32_t t = 0; t < count; ++t) {
+        std::int32_t id = 0, missed = 0, cls = 0;
+        float state[8];
+        std::uint64_t ts = 0;
+        std::string name;
+        std::uint32_t points = 0;
+        if (!in.pod(id) || !in.bytes(state, sizeof(state)) || !in.pod(ts) || !in.pod(missed) || !in.pod(cls) ||
+            !in.str(name) || !in.pod(points)) {
+            return false;
+        }
+        const std::size_t i = restored.add(id, centerToBbox(state[0], state[1], state[2], state[3]), ts, state[7],
+                                           cls, name);
+        restored.cx[i] = state[0];  // 不经 bbox 往返，保持原值
+        restored.cy[i] = state[1];
+        restored.vx[i] = state[4];
+        restored.vy[i] = state[5];
+        restored.uncertainty[i] = state[6];
+        restored.missedFrames[i] = missed;
+        for (std::uint32_t k = 0; k < points; ++k) {
+            TrackHistoryPoint p;
+            if (!in.pod(p)) return false;
+            restored.pushHistory(i, p);
+        }
+    }
+    if (!in.done()) return false;
+    tracks_ = std::move(restored);
+    nextTrackId_ = nextId;
+    return true;
+}
+
 bool SortTrackerBackend::run(DetectionResult& detections, TrackingResult& outTracks) {
     if (!loaded_) {
         std::cerr << "[SortTrackerBackend] run() called before load()" << std::endl;
@@ -85,99 +292,116 @@ bool SortTrackerBackend::run(DetectionResult& detections, TrackingResult& outTra
     outTracks.tracks.clear();
 
     const std::uint64_t ts = detections.timestampNs;
+    const std::size_t numTracks = tracks_.size();
+    const std::size_t numDets = detections.detections.size();
 
     // 1) 预测：对每条 track 用匀速模型得到预测 bbox，并增加 missed 计数
-    struct PredEntry { int id; DetectionBBox predBbox; SortTrackState* rec; };
-    std::vector<PredEntry> predictions;
-    for (auto& kv : tracks_) {
-        kv.second.missedFrames++;
-        SortTrackState& s = kv.second;
-        float px = s.cx + s.vx;
-        float py = s.cy + s.vy;
-        predictions.push_back({ kv.first, centerToBbox(px, py, s.w, s.h), &s });
+    predBoxes_.resize(numTracks);
+    predEnabled_.resize(numTracks);
+    for (std::size_t i = 0; i < numTracks; ++i) {
+        tracks_.missedFrames[i]++;
+        predBoxes_[i] = centerToBbox(tracks_.cx[i] + tracks_.vx[i], tracks_.cy[i] + tracks_.vy[i], tracks_.w[i],
+                                     tracks_.h[i]);
+        predEnabled_[i] = tracks_.missedFrames[i] <= maxMissedFrames_;
     }
 
-    // 2) 贪心 IoU 匹配：按检测分数降序，每个检测找最大 IoU 的预测（且 > threshold）
-    std::vector<bool> detUsed(detections.detections.size(), false);
-    std::vector<bool> predUsed(predictions.size(), false);
-
-    std::vector<size_t> detOrder(detections.detections.size());
-    for (size_t i = 0; i < detOrder.size(); ++i) detOrder[i] = i;
-    std::sort(detOrder.begin(), detOrder.end(), [&detections](size_t a, size_t b) {
-        return detections.detections[a].score > detections.detections[b].score;
-    });
+    // 2) 最优分配：网格门控只对空间相邻的 (检测, 预测) 计算 IoU，再以 1 - IoU 为代价做 JV 分配；
+    //    拥挤场景下不会像按分数贪心那样抢走相邻目标的轨迹
+    detBoxes_.resize(numDets);
+    for (std::size_t d = 0; d < numDets; ++d) detBoxes_[d] = detections.detections[d].bbox;
+    gateByIou(detBoxes_, predBoxes_, iouThreshold_, candidates_, &predEnabled_);
+    // 匹配代价 1 - IoU < 1，单侧落空代价 0.5：只要存在门控内配对，匹配总优于两端都落空
+    solveSparseAssignment(static_cast<int>(numDets), static_cast<int>(numTracks), candidates_, 0.5f, assignment_);
 
-    for (size_t ii = 0; ii < detOrder.size(); ++ii) {
-        size_t di = detOrder[ii];
-        if (detUsed[di]) continue;
+    detUsed_.assign(numDets, false);
+    for (std::size_t di = 0; di < numDets; ++di) {
+        const int pi = assignment_[di];
+        if (pi < 0) continue;
+        detUsed_[di] = true;
         Detection& det = detections.detections[di];
-        float bestIou = iouThreshold_;
-        int bestPi = -1;
-        for (size_t p = 0; p < predictions.size(); ++p) {
-            if (predUsed[p]) continue;
-            SortTrackState* rec = predictions[p].rec;
-            if (rec->missedFrames > maxMissedFrames_) continue;
-            float v = iou(predictions[p].predBbox, det.bbox);
-            if (v > bestIou) { bestIou = v; bestPi = static_cast<int>(p); }
-        }
-        if (bestPi >= 0) {
-            predUsed[static_cast<size_t>(bestPi)] = true;
-            detUsed[di] = true;
-            SortTrackState* rec = predictions[static_cast<size_t>(bestPi)].rec;
-            det.trackId = rec->trackId;
-            float nc, ny, nw, nh;
-            bboxToCenter(det.bbox, nc, ny, nw, nh);
-            rec->vx = 0.3f * rec->vx + 0.7f * (nc - rec->cx);
-            rec->vy = 0.3f * rec->vy + 0.7f * (ny - rec->cy);
-            rec->cx = nc;
-            rec->cy = ny;
-            rec->w = nw;
-            rec->h = nh;
-            rec->lastTimestampNs = ts;
-            rec->missedFrames = 0;
-            rec->classId = det.classId;
-            rec->className = det.className;
-            rec->trajectory.push_back(TrackHistoryPoint{ts, det.bbox});
-            pruneTrajectory(rec->trajectory, maxTrajectoryPoints_);
-        }
+        const std::size_t i = static_cast<std::size_t>(pi);
+        det.trackId = tracks_.trackId[i];
+        float nc, ny, nw, nh;
+        bboxToCenter(det.bbox, nc, ny, nw, nh);
+        tracks_.vx[i] = 0.3f * tracks_.vx[i] + 0.7f * (nc - tracks_.cx[i]);
+        tracks_.vy[i] = 0.3f * tracks_.vy[i] + 0.7f * (ny - tracks_.cy[i]);
+        tracks_.cx[i] = nc;
+        tracks_.cy[i] = ny;
+        tracks_.w[i] = nw;
+        tracks_.h[i] = nh;
+        tracks_.lastTimestampNs[i] = ts;
+        tracks_.missedFrames[i] = 0;
+        tracks_.uncertainty[i] = 0.f;
+        tracks_.score[i] = det.score;
+        tracks_.classId[i] = det.classId;
+        tracks_.classNameIndex[i] = tracks_.internClassName(det.className);
+        tracks_.pushHistory(i, TrackHistoryPoint{ts, det.bbox});
     }
 
-    // 3) 未匹配的检测 -> 新 track
-    for (size_t i = 0; i < detections.detections.size(); ++i) {
-        if (detUsed[i]) continue;
-        Detection& det = detections.detections[i];
-        int id = nextTrackId_++;
+    // 3) 已有 track 中本帧未匹配的：位置以预测为准
+    for (std::size_t i = 0; i < numTracks; ++i) {
+        if (tracks_.missedFrames[i] == 0) continue;
+        tracks_.cx[i] += tracks_.vx[i];
+        tracks_.cy[i] += tracks_.vy[i];
+        growUncertainty(i);
+    }
+
+    // 4) 未匹配的检测 -> 新 track（追加在尾部，trackId 保持升序）
+    for (std::size_t di = 0; di < numDets; ++di) {
+        if (detUsed_[di]) continue;
+        Detection& det = detections.detections[di];
+        const int id = nextTrackId_++;
         det.trackId = id;
-        SortTrackState s;
-        s.trackId = id;
-        bboxToCenter(det.bbox, s.cx, s.cy, s.w, s.h);
-        s.lastTimestampNs = ts;
-        s.missedFrames = 0;
-        s.classId = det.classId;
-        s.className = det.className;
-        s.trajectory.push_back(TrackHistoryPoint{ts, det.bbox});
-        tracks_[id] = std::move(s);
+        const std::size_t i = tracks_.add(id, det.bbox, ts, det.score, det.classId, det.className);
+        tracks_.pushHistory(i, TrackHistoryPoint{ts, det.bbox});
     }
 
-    // 4) 移除超时 track，写出 ACTIVE / LOST
-    std::vector<int> toRemove;
-    for (auto& kv : tracks_) {
-        TrackingState state;
-        state.trackId = kv.second.trackId;
-        state.targetClassId = kv.second.classId;
-        state.targetClassName = kv.second.className;
-        state.trajectory = kv.second.trajectory;
-        if (kv.second.missedFrames > maxMissedFrames_) {
-            state.status = "LOST";
-            toRemove.push_back(kv.first);
-        } else {
-            state.status = "ACTIVE";
+    // 5) 写出 ACTIVE / LOST（历史为视图，不拷贝），再移除超时 track
+    outTracks.tracks.resize(tracks_.size());
+    remove_.assign(tracks_.size(), false);
+    bool anyRemoved = false;
+    for (std::size_t i = 0; i < tracks_.size(); ++i) {
+        const bool lost = tracks_.missedFrames[i] > maxMissedFrames_;
+        writeState(i, lost ? "LOST" : "ACTIVE", outTracks.tracks[i]);
+        if (lost) {
+            remove_[i] = true;
+            anyRemoved = true;
         }
-        outTracks.tracks.push_back(std::move(state));
     }
-    for (int id : toRemove)
-        tracks_.erase(id);
+    // LOST 轨迹的历史槽在下一次 add 前不会被复用，本帧输出的视图保持有效
+    if (anyRemoved) tracks_.compact(remove_);
+
+    return true;
+}
+
+bool SortTrackerBackend::predict(DetectionResult& detections, TrackingResult& outTracks) {
+    if (!loaded_) {
+        std::cerr << "[SortTrackerBackend] predict() called before load()" << std::endl;
+        return false;
+    }
 
+    outTracks.frameId = detections.frameId;
+    outTracks.timestampNs = detections.timestampNs;
+    outTracks.frameIndex = detections.frameIndex;
+    outTracks.tracks.clear();
+    detections.detections.clear();
+
+    outTracks.tracks.resize(tracks_.size());
+    detections.detections.resize(tracks_.size());
+    for (std::size_t i = 0; i < tracks_.size(); ++i) {
+        tracks_.cx[i] += tracks_.vx[i];
+        tracks_.cy[i] += tracks_.vy[i];
+        growUncertainty(i);
+
+        Detection& det = detections.detections[i];
+        det.bbox = centerToBbox(tracks_.cx[i], tracks_.cy[i], tracks_.w[i], tracks_.h[i]);
+        det.score = tracks_.score[i];
+        det.classId = tracks_.classId[i];
+        det.className = tracks_.className(i);
+        det.trackId = tracks_.trackId[i];
+
+        writeState(i, "PREDICTED", outTracks.tracks[i]);
+    }
     return true;
 }
 
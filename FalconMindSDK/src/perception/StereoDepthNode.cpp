@@ -0,0 +1,224 @@
+#include "falconmind/sdk/perception/StereoDepthNode.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+#include "falconmind/sdk/sensors/MultiCameraSourceNode.h"
+#include "falconmind/sdk/sensors/PointCloudPacket.h"
+
+#include "falconmind/sdk/core/Pad.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace falconmind::sdk::perception {
+
+using namespace falconmind::sdk::core;
+using namespace falconmind::sdk::sensors;
+
+StereoDepthNode::StereoDepthNode() : Node("stereo_depth"), matcher_(std::make_unique<StereoMatcher>()) {
+    inPad_ = addPad(std::make_shared<Pad>("frames_in", PadType::Sink));
+    depthPad_ = addPad(std::make_shared<Pad>("depth_out", PadType::Source));
+    cloudPad_ = addPad(std::make_shared<Pad>("pointcloud_out", PadType::Source));
+}
+
+bool StereoDepthNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    core::Node::configure(params);
+    auto number = [&](const char* key, double& out) {
+        auto it = params.find(key);
+        if (it == params.end()) return false;
+        out = std::strtod(it->second.c_str(), nullptr);
+        return true;
+    };
+
+    StereoCalibration calib = matcher_->calibration();
+    auto file = params.find("calibration");
+    if (file != params.end() && !loadStereoCalibration(file->second, calib)) return false;
+    // 上游已校正：只需校正后针孔与基线
+    bool rectified = false;
+    rectified |= number("fx", calib.f);
+    rectified |= number("cx", calib.cx);
+    rectified |= number("cy", calib.cy);
+    number("baseline_m", calib.baselineM);
+    if (rectified && file == params.end()) calib.left = calib.right = StereoCameraModel{};
+
+    StereoMatcherConfig cfg = matcher_->config();
+    double v = cfg.level;
+    number("level", v);
+    cfg.level = static_cast<int>(v);
+    v = cfg.maxDisparity;
+    number("max_disparity", v);
+    cfg.maxDisparity = static_cast<int>(v);
+    v = cfg.p1;
+    number("p1", v);
+    cfg.p1 = static_cast<int>(v);
+    v = cfg.p2;
+    number("p2", v);
+    cfg.p2 = static_cast<int>(v);
+    v = cfg.uniquenessPercent;
+    number("uniqueness", v);
+    cfg.uniquenessPercent = static_cast<int>(v);
+    v = static_cast<double>(cfg.threads);
+    number("threads", v);
+    cfg.threads = v > 0. ? static_cast<std::size_t>(v) : 0;
+    auto lr = params.find("lr_check");
+    if (lr != params.end()) cfg.lrCheck = (lr->second == "1" || lr->second == "true" || lr->second == "yes");
+
+    v = static_cast<double>(leftIndex_);
+    number("left_index", v);
+    const double left = v;
+    v = static_cast<double>(rightIndex_);
+    number("right_index", v);
+    const double right = v;
+    if (left < 0. || right < 0. || left >= kMaxSyncedCameras || right >= kMaxSyncedCameras || left == right) {
+        std::cerr << "[StereoDepthNode] invalid left_index / right_index: " << left << " / " << right << std::endl;
+        return false;
+    }
+    double minDepth = minDepthM_, maxDepth = maxDepthM_, step = pointStep_;
+    number("min_depth_m", minDepth);
+    number("max_depth_m", maxDepth);
+    number("point_step", step);
+    if (minDepth < 0. || maxDepth <= minDepth || step < 1.) {
+        std::cerr << "[StereoDepthNode] invalid depth range [" << minDepth << ", " << maxDepth
+                  << "] or point_step " << step << std::endl;
+        return false;
+    }
+    leftIndex_ = static_cast<std::size_t>(left);
+    rightIndex_ = static_cast<std::size_t>(right);
+    minDepthM_ = static_cast<float>(minDepth);
+    maxDepthM_ = static_cast<float>(maxDepth);
+    pointStep_ = static_cast<int>(step);
+
+    matcher_ = std::make_unique<StereoMatcher>(cfg);
+    matcher_->setCalibration(calib);
+    return true;
+}
+
+bool StereoDepthNode::start() {
+    if (!matcher_->calibration().valid()) {
+        std::cerr << "[StereoDepthNode] calibration or fx / cx / cy / baseline_m required" << std::endl;
+        return false;
+    }
+    if (inPad_) {
+        inPad_->setBufferCallback([this](const BufferRef& set) {
+            if (set.size() >= sizeof(MultiCameraFramePacket)) {
+                std::lock_guard<std::mutex> lock(frameMutex_);
+                lastSet_ = set;
+            }
+        });
+    }
+    started_ = true;
+    std::cout << "[StereoDepthNode] start() kernel=" << StereoMatcher::kernelName()
+              << " level=" << matcher_->config().level << " max_disparity=" << matcher_->config().maxDisparity
+              << " threads=" << matcher_->threads() << std::endl;
+    return true;
+}
+
+void StereoDepthNode::process() {
+    if (!started_) return;
+    BufferRef set;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        set = std::move(lastSet_);
+        lastSet_.reset();
+    }
+    if (set.size() < sizeof(MultiCameraFramePacket)) return;
+
+    MultiCameraFramePacket bundle;
+    std::memcpy(&bundle, set.data(), sizeof(bundle));
+    StereoImage images[2];
+    const std::size_t indices[2] = {leftIndex_, rightIndex_};
+    for (int k = 0; k < 2; ++k) {
+        const std::size_t i = indices[k];
+        if (i >= bundle.count || bundle.offsets[i] + bundle.sizes[i] > set.size() ||
+            bundle.sizes[i] < sizeof(CameraFramePacket)) {
+            return;
+        }
+        const auto* header = reinterpret_cast<const CameraFramePacket*>(set.data() + bundle.offsets[i]);
+        const PixelFormat fmt = parsePixelFormat(header->format);
+        if (fmt != PixelFormat::NV12 && fmt != PixelFormat::YUYV) {
+            if (!warnedFormat_) {
+                std::cerr << "[StereoDepthNode] unsupported pixel format " << header->format
+                          << ", expected NV12 or YUYV" << std::endl;
+                warnedFormat_ = true;
+            }
+            return;
+        }
+        const int stride = header->stride > 0 ? header->stride : header->width * (fmt == PixelFormat::YUYV ? 2 : 1);
+        const std::size_t needed = static_cast<std::size_t>(stride) * static_cast<std::size_t>(header->height);
+        if (header->width <= 0 || header->height <= 0 || bundle.sizes[i] < sizeof(CameraFramePacket) + needed) {
+            return;
+        }
+        images[k] = StereoImage{cameraFramePacketData(header), header->width, header->height, stride, fmt};
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    if (!matcher_->compute(images[0], images[1])) return;
+    const std::int64_t ts = set.meta().timestampNs != 0 ? set.meta().timestampNs : bundle.timestampNs;
+    const std::uint64_t index = set.meta().frameIndex != 0 ? set.meta().frameIndex : bundle.setIndex;
+    if (depthPad_ && depthPad_->isConnected()) emitDepth(ts, index);
+    if (cloudPad_ && cloudPad_->isConnected()) emitPoints(ts, index);
+    lastLatencyNs_ = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    ++frames_;
+}
+
+void StereoDepthNode::emitDepth(std::int64_t timestampNs, std::uint64_t frameIndex) {
+    const int w = matcher_->width(), h = matcher_->height();
+    BufferRef out = depthPool_.acquire(BufferPoolKey{w, h, "Z16"},
+                                       sizeof(CameraFramePacket) + static_cast<std::size_t>(w) * h * 2);
+    auto* header = reinterpret_cast<CameraFramePacket*>(out.mutableData());
+    *header = CameraFramePacket{};
+    header->width = w;
+    header->height = h;
+    header->stride = w * 2;
+    std::strncpy(header->format, "Z16", sizeof(header->format) - 1);
+    header->captureTimestampNs = timestampNs;
+    header->frameIndex = frameIndex;
+    auto* depth = reinterpret_cast<std::uint16_t*>(cameraFramePacketDataWritable(header));
+    const std::vector<float>& disparity = matcher_->disparity();
+    const double fb = matcher_->focal() * matcher_->calibration().baselineM * 1000.0;
+    for (std::size_t i = 0; i < disparity.size(); ++i) {
+        const float d = disparity[i];
+        depth[i] = d > 0.f ? static_cast<std::uint16_t>(std::min(fb / d, 65535.0)) : 0;
+    }
+    out.mutableMeta().timestampNs = timestampNs;
+    out.mutableMeta().frameIndex = frameIndex;
+    depthPad_->pushBuffer(out);
+}
+
+void StereoDepthNode::emitPoints(std::int64_t timestampNs, std::uint64_t frameIndex) {
+    const int w = matcher_->width(), h = matcher_->height(), step = pointStep_;
+    const auto capacity = pointCloudCapacityAligned(
+        static_cast<std::uint32_t>(((w + step - 1) / step) * ((h + step - 1) / step)));
+    BufferRef out = cloudPool_.acquire(BufferPoolKey{static_cast<std::int32_t>(capacity), 0, "FMPC"},
+                                       pointCloudPacketSize(capacity));
+    PointCloudWriter writer;
+    if (!writer.reset(out.mutableData(), out.size(), capacity)) return;
+    writer.header->timestampNs = timestampNs;
+    writer.header->frameIndex = frameIndex;
+
+    // 相机系（x 右 / y 下 / z 光轴）→ 机体系（x 前 / y 左 / z 上）
+    const std::vector<float>& disparity = matcher_->disparity();
+    const std::vector<std::uint8_t>& luma = matcher_->rectifiedLeft();
+    const float fb = static_cast<float>(matcher_->focal() * matcher_->calibration().baselineM);
+    const float invF = static_cast<float>(1.0 / matcher_->focal());
+    const float cx = static_cast<float>(matcher_->principalX()), cy = static_cast<float>(matcher_->principalY());
+    for (int y = 0; y < h; y += step) {
+        const std::size_t row = static_cast<std::size_t>(y) * w;
+        const float ny = (y - cy) * invF;
+        for (int x = 0; x < w; x += step) {
+            const float d = disparity[row + x];
+            if (d <= 0.f) continue;
+            const float z = fb / d;
+            if (z < minDepthM_ || z > maxDepthM_) continue;
+            writer.append(z, -(x - cx) * invF * z, -ny * z, luma[row + x], 0u, 0);
+        }
+    }
+    lastPoints_ = writer.header->count;
+    out.mutableMeta().timestampNs = timestampNs;
+    out.mutableMeta().frameIndex = frameIndex;
+    cloudPad_->pushBuffer(out);
+}
+
+} // namespace falconmind::sdk::perception
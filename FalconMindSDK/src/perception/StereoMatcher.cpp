@@ -0,0 +1,635 @@
+#include "falconmind/sdk/perception/StereoMatcher.h"
+#include "falconmind/sdk/core/CpuFeatures.h"
+#include "falconmind/sdk/core/WorkerGroup.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+constexpr std::uint8_t kMaxCost = 24;  // 5×5 Census 的位数
+constexpr std::uint16_t kSentinel = 0xffff;
+
+// 一行的匹配代价：out[x · D + d] = popcount(cl[x] ^ cr[x - d])，cr 前有 D 个填充
+using CostRowFn = void (*)(const std::uint32_t* cl, const std::uint32_t* cr, int w, int D, std::uint8_t* out);
+// SGM 单步：cur[d] = cost[d] + min(prev[d], prev[d±1] + P1, prevMin + P2) − prevMin，累加到 sum；返回 min(cur)
+// prev / cur 的 [-1] 与 [D] 为哨兵
+using AggregateFn = std::uint16_t (*)(const std::uint8_t* cost, const std::uint16_t* prev, std::uint16_t prevMin,
+                                      std::uint16_t* cur, std::uint16_t* sum, int D, std::uint16_t p1,
+                                      std::uint16_t p2);
+
+int popcount32(std::uint32_t v) {
+#if defined(__GNUC__)
+    return __builtin_popcount(v);
+#else
+    int n = 0;
+    for (; v; v &= v - 1) ++n;
+    return n;
+#endif
+}
+
+void costRowScalar(const std::uint32_t* cl, const std::uint32_t* cr, int w, int D, std::uint8_t* out) {
+    for (int x = 0; x < w; ++x) {
+        const std::uint32_t l = cl[x];
+        std::uint8_t* o = out + static_cast<std::size_t>(x) * D;
+        for (int d = 0; d < D; ++d) o[d] = static_cast<std::uint8_t>(popcount32(l ^ cr[D + x - d]));
+    }
+}
+
+std::uint16_t aggregateScalar(const std::uint8_t* cost, const std::uint16_t* prev, std::uint16_t prevMin,
+                              std::uint16_t* cur, std::uint16_t* sum, int D, std::uint16_t p1, std::uint16_t p2) {
+    const std::uint32_t jump = static_cast<std::uint32_t>(prevMin) + p2;
+    std::uint16_t best = kSentinel;
+    for (int d = 0; d < D; ++d) {
+        const std::uint32_t near = std::min<std::uint32_t>(prev[d - 1], prev[d + 1]) + p1;
+        const std::uint32_t m = std::min(std::min<std::uint32_t>(prev[d], near), jump);
+        const auto l = static_cast<std::uint16_t>(cost[d] + m - prevMin);
+        cur[d] = l;
+        sum[d] = static_cast<std::uint16_t>(sum[d] + l);
+        best = std::min(best, l);
+    }
+    return best;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FALCONMIND_STEREO_X86 1
+// 连续 4 / 8 个视差对应右图 x-d 递减的一段：整段读入后反序，异或后用半字节查表计数，
+// 每个 32 位字内的字节和由乘 0x01010101 取最高字节得到
+__attribute__((target("sse4.1"))) void costRowSse41(const std::uint32_t* cl, const std::uint32_t* cr, int w, int D,
+                                                      std::uint8_t* out) {
+    const __m128i lut = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m128i low = _mm_set1_epi8(0x0f);
+    const __m128i ones = _mm_set1_epi32(0x01010101);
+    for (int x = 0; x < w; ++x) {
+        const __m128i l = _mm_set1_epi32(static_cast<int>(cl[x]));
+        std::uint8_t* o = out + static_cast<std::size_t>(x) * D;
+        for (int d = 0; d < D; d += 4) {
+            __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cr + D + x - d - 3));
+            r = _mm_shuffle_epi32(r, 0x1b);
+            const __m128i v = _mm_xor_si128(l, r);
+            __m128i cnt = _mm_add_epi8(_mm_shuffle_epi8(lut, _mm_and_si128(v, low)),
+                                       _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), low)));
+            cnt = _mm_srli_epi32(_mm_mullo_epi32(cnt, ones), 24);
+            cnt = _mm_packus_epi16(_mm_packus_epi32(cnt, cnt), cnt);
+            const int packed = _mm_cvtsi128_si32(cnt);
+            std::memcpy(o + d, &packed, 4);
+        }
+    }
+}
+
+__attribute__((target("avx2"))) void costRowAvx2(const std::uint32_t* cl, const std::uint32_t* cr, int w, int D,
+                                                   std::uint8_t* out) {
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    const __m256i ones = _mm256_set1_epi32(0x01010101);
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    for (int x = 0; x < w; ++x) {
+        const __m256i l = _mm256_set1_epi32(static_cast<int>(cl[x]));
+        std::uint8_t* o = out + static_cast<std::size_t>(x) * D;
+        for (int d = 0; d < D; d += 8) {
+            __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cr + D + x - d - 7));
+            r = _mm256_permutevar8x32_epi32(r, reverse);
+            const __m256i v = _mm256_xor_si256(l, r);
+            __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, _mm256_and_si256(v, low)),
+                                          _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+            cnt = _mm256_srli_epi32(_mm256_mullo_epi32(cnt, ones), 24);
+            const __m128i p16 = _mm_packus_epi32(_mm256_castsi256_si128(cnt), _mm256_extracti128_si256(cnt, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(o + d), _mm_packus_epi16(p16, p16));
+        }
+    }
+}
+
+// d±1 直接从哨兵填充的缓冲错位读取，饱和加法使哨兵不参与最小值
+__attribute__((target("sse4.1"))) std::uint16_t aggregateSse41(const std::uint8_t* cost, const std::uint16_t* prev,
+                                                                 std::uint16_t prevMin, std::uint16_t* cur,
+                                                                 std::uint16_t* sum, int D, std::uint16_t p1,
+                                                                 std::uint16_t p2) {
+    const __m128i vp1 = _mm_set1_epi16(static_cast<short>(p1));
+    const __m128i vjump = _mm_set1_epi16(static_cast<short>(prevMin + p2));
+    const __m128i vmin = _mm_set1_epi16(static_cast<short>(prevMin));
+    __m128i best = _mm_set1_epi16(-1);
+    for (int d = 0; d < D; d += 8) {
+        const __m128i c = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(cost + d)));
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + d));
+        const __m128i b = _mm_adds_epu16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + d - 1)), vp1);
+        const __m128i e = _mm_adds_epu16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + d + 1)), vp1);
+        const __m128i m = _mm_min_epu16(_mm_min_epu16(a, b), _mm_min_epu16(e, vjump));
+        const __m128i l = _mm_add_epi16(c, _mm_sub_epi16(m, vmin));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(cur + d), l);
+        __m128i* s = reinterpret_cast<__m128i*>(sum + d);
+        _mm_storeu_si128(s, _mm_add_epi16(_mm_loadu_si128(s), l));
+        best = _mm_min_epu16(best, l);
+    }
+    return static_cast<std::uint16_t>(_mm_cvtsi128_si32(_mm_minpos_epu16(best)));
+}
+
+__attribute__((target("avx2"))) std::uint16_t aggregateAvx2(const std::uint8_t* cost, const std::uint16_t* prev,
+                                                              std::uint16_t prevMin, std::uint16_t* cur,
+                                                              std::uint16_t* sum, int D, std::uint16_t p1,
+                                                              std::uint16_t p2) {
+    const __m256i vp1 = _mm256_set1_epi16(static_cast<short>(p1));
+    const __m256i vjump = _mm256_set1_epi16(static_cast<short>(prevMin + p2));
+    const __m256i vmin = _mm256_set1_epi16(static_cast<short>(prevMin));
+    __m256i best = _mm256_set1_epi16(-1);
+    for (int d = 0; d < D; d += 16) {
+        const __m256i c = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cost + d)));
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + d));
+        const __m256i b = _mm256_adds_epu16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + d - 1)), vp1);
+        const __m256i e = _mm256_adds_epu16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + d + 1)), vp1);
+        const __m256i m = _mm256_min_epu16(_mm256_min_epu16(a, b), _mm256_min_epu16(e, vjump));
+        const __m256i l = _mm256_add_epi16(c, _mm256_sub_epi16(m, vmin));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(cur + d), l);
+        __m256i* s = reinterpret_cast<__m256i*>(sum + d);
+        _mm256_storeu_si256(s, _mm256_add_epi16(_mm256_loadu_si256(s), l));
+        best = _mm256_min_epu16(best, l);
+    }
+    const __m128i half = _mm_min_epu16(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+    return static_cast<std::uint16_t>(_mm_cvtsi128_si32(_mm_minpos_epu16(half)));
+}
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FALCONMIND_STEREO_NEON 1
+void costRowNeon(const std::uint32_t* cl, const std::uint32_t* cr, int w, int D, std::uint8_t* out) {
+    for (int x = 0; x < w; ++x) {
+        const uint32x4_t l = vdupq_n_u32(cl[x]);
+        std::uint8_t* o = out + static_cast<std::size_t>(x) * D;
+        for (int d = 0; d < D; d += 4) {
+            uint32x4_t r = vld1q_u32(cr + D + x - d - 3);
+            r = vrev64q_u32(r);
+            r = vextq_u32(r, r, 2);
+            const uint8x16_t cnt = vcntq_u8(vreinterpretq_u8_u32(veorq_u32(l, r)));
+            const uint16x4_t s16 = vmovn_u32(vpaddlq_u16(vpaddlq_u8(cnt)));
+            const uint8x8_t s8 = vmovn_u16(vcombine_u16(s16, s16));
+            const std::uint32_t packed = vget_lane_u32(vreinterpret_u32_u8(s8), 0);
+            std::memcpy(o + d, &packed, 4);
+        }
+    }
+}
+
+std::uint16_t aggregateNeon(const std::uint8_t* cost, const std::uint16_t* prev, std::uint16_t prevMin,
+                            std::uint16_t* cur, std::uint16_t* sum, int D, std::uint16_t p1, std::uint16_t p2) {
+    const uint16x8_t vp1 = vdupq_n_u16(p1);
+    const uint16x8_t vjump = vdupq_n_u16(static_cast<std::uint16_t>(prevMin + p2));
+    const uint16x8_t vmin = vdupq_n_u16(prevMin);
+    uint16x8_t best = vdupq_n_u16(kSentinel);
+    for (int d = 0; d < D; d += 8) {
+        const uint16x8_t c = vmovl_u8(vld1_u8(cost + d));
+        const uint16x8_t a = vld1q_u16(prev + d);
+        const uint16x8_t b = vqaddq_u16(vld1q_u16(prev + d - 1), vp1);
+        const uint16x8_t e = vqaddq_u16(vld1q_u16(prev + d + 1), vp1);
+        const uint16x8_t m = vminq_u16(vminq_u16(a, b), vminq_u16(e, vjump));
+        const uint16x8_t l = vaddq_u16(c, vsubq_u16(m, vmin));
+        vst1q_u16(cur + d, l);
+        vst1q_u16(sum + d, vaddq_u16(vld1q_u16(sum + d), l));
+        best = vminq_u16(best, l);
+    }
+    return vminvq_u16(best);
+}
+#endif
+
+struct Kernels {
+    CostRowFn cost;
+    AggregateFn aggregate;
+    const char* name;
+};
+
+Kernels selectKernels() {
+#if defined(FALCONMIND_STEREO_NEON)
+    return {costRowNeon, aggregateNeon, "neon"};
+#else
+    Kernels k{costRowScalar, aggregateScalar, "scalar"};
+#if defined(FALCONMIND_STEREO_X86)
+    const core::CpuFeatures& cpu = core::cpuFeatures();
+    if (cpu.avx2) {
+        k = {costRowAvx2, aggregateAvx2, "avx2"};
+    } else if (cpu.sse41) {
+        k = {costRowSse41, aggregateSse41, "sse4.1"};
+    }
+#endif
+    return k;
+#endif
+}
+
+const Kernels& kernels() {
+    static const Kernels k = selectKernels();
+    return k;
+}
+
+// [begin, end) 均分为 parts 段中的第 index 段
+std::pair<int, int> band(int begin, int end, std::size_t parts, std::size_t index) {
+    const int n = end - begin;
+    const int chunk = static_cast<int>((static_cast<std::size_t>(n) + parts - 1) / parts);
+    const int b = std::min(end, begin + static_cast<int>(index) * chunk);
+    return {b, std::min(end, b + chunk)};
+}
+
+bool readNumbers(std::istringstream& in, double* out, int count, int required) {
+    int n = 0;
+    for (; n < count && (in >> out[n]); ++n) {}
+    return n >= required;
+}
+
+} // namespace
+
+bool loadStereoCalibration(const std::string& path, StereoCalibration& out) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "[StereoMatcher] cannot open calibration " << path << std::endl;
+        return false;
+    }
+    StereoCalibration calib;
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(file, line)) {
+        ++lineNo;
+        const auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        std::istringstream in(line);
+        std::string key;
+        if (!(in >> key)) continue;
+        bool ok = true;
+        if (key == "left_K" || key == "right_K") {
+            StereoCameraModel& cam = key[0] == 'l' ? calib.left : calib.right;
+            double v[4];
+            ok = readNumbers(in, v, 4, 4);
+            if (ok) {
+                cam.fx = v[0];
+                cam.fy = v[1];
+                cam.cx = v[2];
+                cam.cy = v[3];
+            }
+        } else if (key == "left_D" || key == "right_D") {
+            StereoCameraModel& cam = key[0] == 'l' ? calib.left : calib.right;
+            double v[5] = {0., 0., 0., 0., 0.};
+            ok = readNumbers(in, v, 5, 4);
+            if (ok) {
+                cam.k1 = v[0];
+                cam.k2 = v[1];
+                cam.p1 = v[2];
+                cam.p2 = v[3];
+                cam.k3 = v[4];
+            }
+        } else if (key == "left_R" || key == "right_R") {
+            StereoCameraModel& cam = key[0] == 'l' ? calib.left : calib.right;
+            ok = readNumbers(in, cam.R.data(), 9, 9);
+        } else if (key == "rectified") {
+            double v[3];
+            ok = readNumbers(in, v, 3, 3);
+            if (ok) {
+                calib.f = v[0];
+                calib.cx = v[1];
+                calib.cy = v[2];
+            }
+        } else if (key == "baseline_m") {
+            ok = readNumbers(in, &calib.baselineM, 1, 1);
+        } else {
+            std::cerr << "[StereoMatcher] " << path << ":" << lineNo << " unknown key " << key << std::endl;
+            return false;
+        }
+        if (!ok) {
+            std::cerr << "[StereoMatcher] " << path << ":" << lineNo << " malformed " << key << std::endl;
+            return false;
+        }
+    }
+    if (!calib.valid() || calib.left.fx <= 0. || calib.right.fx <= 0.) {
+        std::cerr << "[StereoMatcher] " << path << " lacks rectified / baseline_m / left_K / right_K" << std::endl;
+        return false;
+    }
+    out = calib;
+    return true;
+}
+
+StereoRemapTable StereoRemapTable::build(const StereoCameraModel& cam, const StereoCalibration& rect, int srcWidth,
+                                         int srcHeight, int level) {
+    StereoRemapTable t;
+    t.width = srcWidth >> level;
+    t.height = srcHeight >> level;
+    const std::size_t n = static_cast<std::size_t>(t.width) * t.height;
+    t.x.assign(n, -1);
+    t.y.assign(n, 0);
+    t.wx.assign(n, 0);
+    t.wy.assign(n, 0);
+    // 未给出原始内参时视为已校正：原始相机与校正后针孔一致
+    const double fx = cam.fx > 0. ? cam.fx : rect.f, fy = cam.fy > 0. ? cam.fy : rect.f;
+    const double cx = cam.fx > 0. ? cam.cx : rect.cx, cy = cam.fx > 0. ? cam.cy : rect.cy;
+    const double scale = static_cast<double>(1 << level);
+    const auto& R = cam.R;
+    for (int v = 0; v < t.height; ++v) {
+        for (int u = 0; u < t.width; ++u) {
+            // 校正相机系射线 → 原始相机系（R 的转置），再加畸变投影到原始像素
+            const double xr = ((u + 0.5) * scale - 0.5 - rect.cx) / rect.f;
+            const double yr = ((v + 0.5) * scale - 0.5 - rect.cy) / rect.f;
+            const double X = R[0] * xr + R[3] * yr + R[6];
+            const double Y = R[1] * xr + R[4] * yr + R[7];
+            const double Z = R[2] * xr + R[5] * yr + R[8];
+            if (Z <= 1e-9) continue;
+            const double x = X / Z, y = Y / Z;
+            const double r2 = x * x + y * y;
+            const double radial = 1. + r2 * (cam.k1 + r2 * (cam.k2 + r2 * cam.k3));
+            const double xd = x * radial + 2. * cam.p1 * x * y + cam.p2 * (r2 + 2. * x * x);
+            const double yd = y * radial + cam.p1 * (r2 + 2. * y * y) + 2. * cam.p2 * x * y;
+            const double sx = fx * xd + cx, sy = fy * yd + cy;
+            if (!(sx >= 0. && sy >= 0. && sx <= srcWidth - 1 && sy <= srcHeight - 1)) continue;
+            int ix = std::min(static_cast<int>(sx), srcWidth - 2);
+            int iy = std::min(static_cast<int>(sy), srcHeight - 2);
+            const std::size_t i = static_cast<std::size_t>(v) * t.width + u;
+            t.x[i] = static_cast<std::int16_t>(ix);
+            t.y[i] = static_cast<std::int16_t>(iy);
+            t.wx[i] = static_cast<std::uint8_t>(std::lround((sx - ix) * 128.));
+            t.wy[i] = static_cast<std::uint8_t>(std::lround((sy - iy) * 128.));
+        }
+    }
+    return t;
+}
+
+StereoMatcher::StereoMatcher(const StereoMatcherConfig& cfg)
+    : cfg_(cfg),
+      workers_(std::make_unique<core::WorkerGroup>(cfg.threads > 0 ? cfg.threads : core::WorkerGroup::defaultCount())) {
+    cfg_.level = std::clamp(cfg_.level, 0, 3);
+    cfg_.maxDisparity = std::clamp((cfg_.maxDisparity + 15) / 16 * 16, 16, 256);
+    cfg_.p1 = std::clamp(cfg_.p1, 1, 255);
+    cfg_.p2 = std::clamp(cfg_.p2, cfg_.p1 + 1, 1024);
+    cfg_.uniquenessPercent = std::clamp(cfg_.uniquenessPercent, 0, 100);
+    scratch_.resize(workers_->count());
+}
+
+StereoMatcher::~StereoMatcher() = default;
+
+std::size_t StereoMatcher::threads() const noexcept { return workers_->count(); }
+
+const char* StereoMatcher::kernelName() noexcept { return kernels().name; }
+
+void StereoMatcher::setCalibration(const StereoCalibration& calib) {
+    calib_ = calib;
+    srcWidth_ = srcHeight_ = 0;
+}
+
+float StereoMatcher::depthAt(int x, int y) const noexcept {
+    if (x < 0 || y < 0 || x >= width_ || y >= height_) return 0.f;
+    const float d = disparity_[static_cast<std::size_t>(y) * width_ + x];
+    return d > 0.f ? static_cast<float>(focal_ * calib_.baselineM / d) : 0.f;
+}
+
+void StereoMatcher::prepare(int srcWidth, int srcHeight) {
+    srcWidth_ = srcWidth;
+    srcHeight_ = srcHeight;
+    const double scale = static_cast<double>(1 << cfg_.level);
+    mapL_ = StereoRemapTable::build(calib_.left, calib_, srcWidth, srcHeight, cfg_.level);
+    mapR_ = StereoRemapTable::build(calib_.right, calib_, srcWidth, srcHeight, cfg_.level);
+    width_ = mapL_.width;
+    height_ = mapL_.height;
+    disparities_ = cfg_.maxDisparity;
+    focal_ = calib_.f / scale;
+    principalX_ = (calib_.cx + 0.5) / scale - 0.5;
+    principalY_ = (calib_.cy + 0.5) / scale - 0.5;
+
+    const std::size_t pixels = static_cast<std::size_t>(width_) * height_;
+    const std::size_t D = static_cast<std::size_t>(disparities_);
+    rectL_.assign(pixels, 0);
+    rectR_.assign(pixels, 0);
+    validL_.assign(pixels, 0);
+    censusL_.assign(pixels, 0);
+    censusR_.assign(static_cast<std::size_t>(width_ + disparities_) * height_, 0);
+    cost_.assign(pixels * D, 0);
+    sum_.assign(pixels * D, 0);
+    disparity_.assign(pixels, -1.f);
+    const std::size_t columns = (static_cast<std::size_t>(width_) + scratch_.size() - 1) / scratch_.size();
+    for (Scratch& s : scratch_) {
+        s.prev.assign(std::max<std::size_t>(columns, 1) * (D + 2), kSentinel);
+        s.cur.assign(s.prev.size(), kSentinel);
+        s.prevMin.assign(std::max<std::size_t>(columns, 1), 0);
+        s.rightBest.assign(static_cast<std::size_t>(width_), kSentinel);
+        s.rightDisp.assign(static_cast<std::size_t>(width_), -1);
+    }
+}
+
+bool StereoMatcher::compute(const StereoImage& left, const StereoImage& right) {
+    if (!calib_.valid()) {
+        std::cerr << "[StereoMatcher] calibration not set" << std::endl;
+        return false;
+    }
+    auto supported = [](const StereoImage& img) {
+        return img.data && (img.format == core::PixelFormat::NV12 || img.format == core::PixelFormat::YUYV ||
+                            img.format == core::PixelFormat::Any);
+    };
+    if (!supported(left) || !supported(right) || left.width != right.width || left.height != right.height ||
+        (left.width >> cfg_.level) < 2 * cfg_.maxDisparity || (left.height >> cfg_.level) < 8) {
+        return false;
+    }
+    if (left.width != srcWidth_ || left.height != srcHeight_) prepare(left.width, left.height);
+
+    const std::size_t parts = workers_->count();
+    workers_->run([&](std::size_t t) {
+        const auto [y0, y1] = band(0, height_, parts, t);
+        remap(left, mapL_, rectL_, y0, y1);
+        remap(right, mapR_, rectR_, y0, y1);
+        for (int y = y0; y < y1; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                const std::size_t i = static_cast<std::size_t>(y) * width_ + x;
+                validL_[i] = mapL_.x[i] >= 0 ? 1 : 0;
+            }
+        }
+    });
+    // Census 读上下 2 行：须在全部行校正完成后
+    workers_->run([&](std::size_t t) {
+        const auto [y0, y1] = band(0, height_, parts, t);
+        census(rectL_, censusL_, y0, y1);
+        census(rectR_, censusR_, y0, y1);
+        costRows(y0, y1);
+    });
+    workers_->run([&](std::size_t t) {
+        const auto [y0, y1] = band(0, height_, parts, t);
+        aggregateRows(y0, y1, t);
+    });
+    workers_->run([&](std::size_t t) {
+        const auto [x0, x1] = band(0, width_, parts, t);
+        aggregateColumns(x0, x1, t);
+    });
+    workers_->run([&](std::size_t t) {
+        const auto [y0, y1] = band(0, height_, parts, t);
+        selectRows(y0, y1, t);
+    });
+    return true;
+}
+
+void StereoMatcher::remap(const StereoImage& img, const StereoRemapTable& table, std::vector<std::uint8_t>& out,
+                          int y0, int y1) {
+    const int step = img.format == core::PixelFormat::YUYV ? 2 : 1;
+    const int stride = img.stride > 0 ? img.stride : img.width * step;
+    for (int v = y0; v < y1; ++v) {
+        const std::size_t row = static_cast<std::size_t>(v) * table.width;
+        for (int u = 0; u < table.width; ++u) {
+            const std::size_t i = row + u;
+            const int sx = table.x[i];
+            if (sx < 0) {
+                out[i] = 0;
+                continue;
+            }
+            const std::uint8_t* p = img.data + static_cast<std::size_t>(table.y[i]) * stride + sx * step;
+            const std::uint32_t wx = table.wx[i], wy = table.wy[i];
+            const std::uint32_t top = p[0] * (128u - wx) + p[step] * wx;
+            const std::uint32_t bottom = p[stride] * (128u - wx) + p[stride + step] * wx;
+            out[i] = static_cast<std::uint8_t>((top * (128u - wy) + bottom * wy + 8192u) >> 14);
+        }
+    }
+}
+
+void StereoMatcher::census(const std::vector<std::uint8_t>& img, std::vector<std::uint32_t>& out, int y0, int y1) {
+    const int w = width_, h = height_;
+    // 右图每行前置 disparities_ 个填充（保持 0）
+    const bool padded = out.size() != img.size();
+    const int rowStride = padded ? w + disparities_ : w;
+    const int offset = padded ? disparities_ : 0;
+    for (int y = y0; y < y1; ++y) {
+        std::uint32_t* o = out.data() + static_cast<std::size_t>(y) * rowStride + offset;
+        if (y < 2 || y >= h - 2) {
+            std::fill(o, o + w, 0u);
+            continue;
+        }
+        o[0] = o[1] = o[w - 2] = o[w - 1] = 0;
+        for (int x = 2; x < w - 2; ++x) {
+            const std::uint8_t c = img[static_cast<std::size_t>(y) * w + x];
+            std::uint32_t bits = 0;
+            for (int dy = -2; dy <= 2; ++dy) {
+                const std::uint8_t* r = img.data() + static_cast<std::size_t>(y + dy) * w + x;
+                for (int dx = -2; dx <= 2; ++dx) {
+                    if (dx == 0 && dy == 0) continue;
+                    bits = (bits << 1) | (r[dx] < c ? 1u : 0u);
+                }
+            }
+            o[x] = bits;
+        }
+    }
+}
+
+void StereoMatcher::costRows(int y0, int y1) {
+    const CostRowFn cost = kernels().cost;
+    const int w = width_, D = disparities_;
+    for (int y = y0; y < y1; ++y) {
+        std::uint8_t* out = cost_.data() + static_cast<std::size_t>(y) * w * D;
+        cost(censusL_.data() + static_cast<std::size_t>(y) * w,
+             censusR_.data() + static_cast<std::size_t>(y) * (w + D), w, D, out);
+        // x < d 时右图无对应像素
+        for (int x = 0; x < std::min(w, D - 1); ++x) {
+            std::memset(out + static_cast<std::size_t>(x) * D + x + 1, kMaxCost, static_cast<std::size_t>(D - 1 - x));
+        }
+    }
+}
+
+void StereoMatcher::aggregateRows(int y0, int y1, std::size_t shard) {
+    const AggregateFn aggregate = kernels().aggregate;
+    const int w = width_, D = disparities_;
+    const auto p1 = static_cast<std::uint16_t>(cfg_.p1), p2 = static_cast<std::uint16_t>(cfg_.p2);
+    Scratch& s = scratch_[shard];
+    std::uint16_t* prev = s.prev.data() + 1;
+    std::uint16_t* cur = s.cur.data() + 1;
+    for (int y = y0; y < y1; ++y) {
+        const std::uint8_t* C = cost_.data() + static_cast<std::size_t>(y) * w * D;
+        std::uint16_t* S = sum_.data() + static_cast<std::size_t>(y) * w * D;
+        std::fill(S, S + static_cast<std::size_t>(w) * D, std::uint16_t{0});
+        for (int dir = 0; dir < 2; ++dir) {  // 左 → 右，右 → 左
+            std::fill(prev, prev + D, std::uint16_t{0});
+            std::uint16_t prevMin = 0;
+            for (int i = 0; i < w; ++i) {
+                const int x = dir == 0 ? i : w - 1 - i;
+                const std::size_t o = static_cast<std::size_t>(x) * D;
+                prevMin = aggregate(C + o, prev, prevMin, cur, S + o, D, p1, p2);
+                std::swap(prev, cur);
+            }
+        }
+    }
+}
+
+void StereoMatcher::aggregateColumns(int x0, int x1, std::size_t shard) {
+    if (x0 >= x1) return;
+    const AggregateFn aggregate = kernels().aggregate;
+    const int w = width_, h = height_, D = disparities_;
+    const auto p1 = static_cast<std::uint16_t>(cfg_.p1), p2 = static_cast<std::uint16_t>(cfg_.p2);
+    const std::size_t slot = static_cast<std::size_t>(D) + 2;
+    Scratch& s = scratch_[shard];
+    std::uint16_t* prev = s.prev.data();
+    std::uint16_t* cur = s.cur.data();
+    for (int dir = 0; dir < 2; ++dir) {  // 上 → 下，下 → 上；列内各自一条路径
+        for (int x = x0; x < x1; ++x) {
+            std::uint16_t* p = prev + static_cast<std::size_t>(x - x0) * slot + 1;
+            std::fill(p, p + D, std::uint16_t{0});
+            s.prevMin[x - x0] = 0;
+        }
+        for (int i = 0; i < h; ++i) {
+            const int y = dir == 0 ? i : h - 1 - i;
+            const std::size_t row = static_cast<std::size_t>(y) * w;
+            for (int x = x0; x < x1; ++x) {
+                const std::size_t o = (row + x) * D;
+                const std::size_t k = static_cast<std::size_t>(x - x0);
+                s.prevMin[k] = aggregate(cost_.data() + o, prev + k * slot + 1, s.prevMin[k], cur + k * slot + 1,
+                                         sum_.data() + o, D, p1, p2);
+            }
+            std::swap(prev, cur);
+        }
+    }
+}
+
+void StereoMatcher::selectRows(int y0, int y1, std::size_t shard) {
+    const int w = width_, D = disparities_;
+    Scratch& s = scratch_[shard];
+    const int uniq = cfg_.uniquenessPercent;
+    for (int y = y0; y < y1; ++y) {
+        const std::uint16_t* S = sum_.data() + static_cast<std::size_t>(y) * w * D;
+        float* out = disparity_.data() + static_cast<std::size_t>(y) * w;
+        if (cfg_.lrCheck) {
+            // 右图像素 xr 的视差：同一代价体沿 (xr + d, d) 取最小
+            std::fill(s.rightBest.begin(), s.rightBest.end(), kSentinel);
+            for (int x = 0; x < w; ++x) {
+                const std::uint16_t* c = S + static_cast<std::size_t>(x) * D;
+                for (int d = 0, dm = std::min(x, D - 1); d <= dm; ++d) {
+                    if (c[d] < s.rightBest[x - d]) {
+                        s.rightBest[x - d] = c[d];
+                        s.rightDisp[x - d] = static_cast<std::int16_t>(d);
+                    }
+                }
+            }
+        }
+        for (int x = 0; x < w; ++x) {
+            out[x] = -1.f;
+            if (!validL_[static_cast<std::size_t>(y) * w + x]) continue;
+            const std::uint16_t* c = S + static_cast<std::size_t>(x) * D;
+            const int dm = std::min(x, D - 1);
+            int best = 0;
+            for (int d = 1; d <= dm; ++d) {
+                if (c[d] < c[best]) best = d;
+            }
+            if (best == 0) continue;  // 无穷远或无法匹配
+            std::uint32_t second = 0xffffffffu;
+            for (int d = 0; d <= dm; ++d) {
+                if (d < best - 1 || d > best + 1) second = std::min<std::uint32_t>(second, c[d]);
+            }
+            if (static_cast<std::uint32_t>(c[best]) * (100 + uniq) >= second * 100u) continue;
+            if (cfg_.lrCheck && std::abs(s.rightDisp[x - best] - best) > cfg_.lrMaxDiff) continue;
+            float d = static_cast<float>(best);
+            if (best < dm) {
+                const int c0 = c[best - 1], c1 = c[best], c2 = c[best + 1];
+                const int denom = c0 + c2 - 2 * c1;
+                if (denom > 0) d += 0.5f * static_cast<float>(c0 - c2) / static_cast<float>(denom);
+            }
+            out[x] = d;
+        }
+    }
+}
+
+} // namespace falconmind::sdk::perception
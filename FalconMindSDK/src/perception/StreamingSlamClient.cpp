@@ -0,0 +1,111 @@
+#include "falconmind/sdk/perception/StreamingSlamClient.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/perception/PoseInterpolation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+constexpr auto kInitialBackoff = std::chrono::milliseconds(100);
+constexpr auto kMaxBackoff = std::chrono::milliseconds(2000);
+
+std::size_t roundUpPow2(std::size_t n) {
+    std::size_t p = 2;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+PoseHistoryBuffer::PoseHistoryBuffer(std::size_t capacity)
+    : slots_(new core::SeqLock<Pose3D>[roundUpPow2(capacity)]), ring_(slots_.get(), &head_, roundUpPow2(capacity)) {}
+
+std::size_t PoseHistoryBuffer::history(Pose3D* out, std::size_t maxCount) const noexcept {
+    return ring_.recent(out, maxCount, [](const Pose3D& p) { return p.timestampNs; });
+}
+
+bool PoseHistoryBuffer::poseAt(std::uint64_t timestampNs, Pose3D& pose) const noexcept {
+    return poseAtInRing(ring_, timestampNs, pose, [](const Pose3D& p) -> const Pose3D& { return p; });
+}
+
+StreamingSlamClient::StreamingSlamClient(PoseStreamPtr stream, std::size_t historyCapacity)
+    : stream_(std::move(stream)), buffer_(historyCapacity) {}
+
+StreamingSlamClient::~StreamingSlamClient() {
+    stop();
+}
+
+bool StreamingSlamClient::start() {
+    if (running_) return true;
+    if (!stream_) {
+        std::cerr << "[StreamingSlamClient] start() without pose stream" << std::endl;
+        return false;
+    }
+    stream_->reset();
+    running_ = true;
+    thread_ = std::thread([this] { receiveLoop(); });
+    return true;
+}
+
+void StreamingSlamClient::stop() {
+    if (!running_.exchange(false)) return;
+    stream_->cancel();
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+    }
+    waitCv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+    connected_ = false;
+}
+
+bool StreamingSlamClient::getPose(Pose3D& pose) {
+    return buffer_.latest(pose);
+}
+
+bool StreamingSlamClient::isAvailable() const {
+    return connected_.load(std::memory_order_acquire) && buffer_.count() > 0;
+}
+
+StreamingSlamStats StreamingSlamClient::stats() const noexcept {
+    StreamingSlamStats s;
+    s.received = buffer_.count();
+    s.reconnects = reconnects_.load(std::memory_order_relaxed);
+    s.connected = connected_.load(std::memory_order_acquire);
+    return s;
+}
+
+void StreamingSlamClient::receiveLoop() {
+    auto backoff = kInitialBackoff;
+    bool everReceived = false;
+    while (running_) {
+        // 一次会话：open 成功且至少收到一条位姿才算连上（gRPC 流在服务端不可达时也可能 open 成功）
+        std::uint64_t received = 0;
+        if (stream_->open()) {
+            Pose3D pose;
+            while (running_ && stream_->read(pose)) {
+                buffer_.push(pose);
+                if (received++ == 0) {
+                    if (everReceived) reconnects_.fetch_add(1, std::memory_order_relaxed);
+                    everReceived = true;
+                    connected_.store(true, std::memory_order_release);
+                }
+            }
+            connected_.store(false, std::memory_order_release);
+        }
+        if (received > 0) {
+            backoff = kInitialBackoff;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(waitMutex_);
+        core::PipelineClock::waitUntil(
+            waitCv_, lock, core::PipelineClock::nowNs() + std::chrono::nanoseconds(backoff).count(),
+            [this] { return !running_; });
+        backoff = std::min(backoff * 2, kMaxBackoff);
+    }
+}
+
+} // namespace falconmind::sdk::perception
@@ -1,42 +1,520 @@
 #include "falconmind/sdk/perception/TensorRtDetectorBackend.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/perception/ClassFilter.h"
+#include "falconmind/sdk/perception/YoloPrePostProcess.h"
 
+#include <algorithm>
 #include <iostream>
+#include <utility>
+
+#if defined(FALCONMINDSDK_TENSORRT_BACKEND_ENABLED) && FALCONMINDSDK_TENSORRT_BACKEND_ENABLED
+#include <NvInfer.h>
+#include <NvInferPlugin.h>
+#include <cuda_runtime_api.h>
+
+#include <condition_variable>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#endif
 
 namespace falconmind::sdk::perception {
 
+#if defined(FALCONMINDSDK_TENSORRT_BACKEND_ENABLED) && FALCONMINDSDK_TENSORRT_BACKEND_ENABLED
+namespace {
+
+class TensorRtLogger : public nvinfer1::ILogger {
+public:
+    void log(Severity severity, const char* msg) noexcept override {
+        if (severity <= Severity::kWARNING) std::cerr << "[TensorRtDetectorBackend] TensorRT: " << msg << std::endl;
+    }
+};
+
+// 输出形式：原始 YOLO 头 (N, 4+C, boxes) 由 CPU 解码 + NMS；
+// EfficientNMS_TRT 插件的四个输出（num_dets / det_boxes / det_scores / det_classes）已在 GPU 上完成解码与 NMS
+enum class OutputKind { Raw, EfficientNms };
+
+struct IoTensor {
+    std::string name;
+    std::size_t frameBytes{0};  // 每帧字节数
+};
+
+// 一路在途推理：独立的执行上下文、CUDA stream 与按 maxBatch 分配的设备 / 锁页主机缓冲
+struct TensorRtStream {
+    std::unique_ptr<nvinfer1::IExecutionContext> context;
+    cudaStream_t stream{nullptr};
+    int currentBatch{0};  // 上次设置的输入 batch，相同时不再调用 setInputShape
+    void* deviceInput{nullptr};
+    float* hostInput{nullptr};
+    std::vector<void*> deviceOutputs;
+    std::vector<void*> hostOutputs;
+    std::unique_ptr<YoloPreprocessor> preprocessor;
+    std::vector<LetterboxTransform> transforms;
+    std::vector<char> valid;
+    std::vector<YoloRawDet> raw;
+    std::vector<bool> suppressed;
+    // profiling：包住 enqueueV3 的事件对，量取 GPU 上的推理耗时（不含 H2D / D2H）
+    cudaEvent_t inferBegin{nullptr};
+    cudaEvent_t inferEnd{nullptr};
+
+    ~TensorRtStream() {
+        if (stream) cudaStreamSynchronize(stream);
+        context.reset();
+        if (inferBegin) cudaEventDestroy(inferBegin);
+        if (inferEnd) cudaEventDestroy(inferEnd);
+        if (deviceInput) cudaFree(deviceInput);
+        if (hostInput) cudaFreeHost(hostInput);
+        for (void* p : deviceOutputs) if (p) cudaFree(p);
+        for (void* p : hostOutputs) if (p) cudaFreeHost(p);
+        if (stream) cudaStreamDestroy(stream);
+    }
+};
+
+struct TensorRtState {
+    TensorRtLogger logger;
+    std::unique_ptr<nvinfer1::IRuntime> runtime;
+    std::unique_ptr<nvinfer1::ICudaEngine> engine;
+    IoTensor input;
+    std::vector<IoTensor> outputs;
+    OutputKind kind{OutputKind::Raw};
+    int inputW{0};
+    int inputH{0};
+    std::size_t maxBatch{1};
+    bool fixedBatch{true};
+    std::size_t outputChannels{0};  // Raw
+    std::size_t outputBoxes{0};
+    std::size_t maxDetections{0};   // EfficientNms：每帧最多保留的框数
+    int nmsCount{-1};               // EfficientNms：各输出在 outputs 中的下标
+    int nmsBoxes{-1};
+    int nmsScores{-1};
+    int nmsClasses{-1};
+
+    std::vector<std::unique_ptr<TensorRtStream>> streams;
+    std::mutex mutex;
+    std::condition_variable idleCv;
+    std::vector<TensorRtStream*> idle;
+
+    ~TensorRtState() {
+        streams.clear();  // 执行上下文先于 engine / runtime 释放
+        engine.reset();
+        runtime.reset();
+    }
+};
+
+bool checkCuda(cudaError_t err, const char* what) {
+    if (err == cudaSuccess) return true;
+    std::cerr << "[TensorRtDetectorBackend] " << what << " failed: " << cudaGetErrorString(err) << std::endl;
+    return false;
+}
+
+std::size_t elementSize(nvinfer1::DataType type) {
+    switch (type) {
+    case nvinfer1::DataType::kFLOAT:
+    case nvinfer1::DataType::kINT32: return 4;
+    case nvinfer1::DataType::kHALF: return 2;
+    default: return 1;
+    }
+}
+
+// 每帧字节数：去掉 batch 维后各维之积
+std::size_t frameBytes(const nvinfer1::Dims& dims, nvinfer1::DataType type) {
+    std::size_t n = elementSize(type);
+    for (int i = 1; i < dims.nbDims; ++i) n *= static_cast<std::size_t>(dims.d[i]);
+    return n;
+}
+
+bool setBatch(const TensorRtState& state, TensorRtStream& s, int batch) {
+    if (s.currentBatch == batch) return true;
+    if (!s.context->setInputShape(state.input.name.c_str(), nvinfer1::Dims4{batch, 3, state.inputH, state.inputW})) {
+        std::cerr << "[TensorRtDetectorBackend] setInputShape(batch=" << batch << ") rejected" << std::endl;
+        return false;
+    }
+    s.currentBatch = batch;
+    return true;
+}
+
+int findOutput(const TensorRtState& state, const char* name) {
+    for (std::size_t i = 0; i < state.outputs.size(); ++i) {
+        if (state.outputs[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+// 反序列化 engine 并解析输入输出张量（形状按 maxBatch 解析）；失败时由调用方释放 state
+bool setupEngine(TensorRtState& state, const DetectorDescriptor& desc) {
+    std::ifstream file(desc.modelPath, std::ios::binary);
+    if (!file) {
+        std::cerr << "[TensorRtDetectorBackend] cannot open engine: " << desc.modelPath << std::endl;
+        return false;
+    }
+    std::vector<char> blob((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    initLibNvInferPlugins(&state.logger, "");  // EfficientNMS_TRT 等内置插件
+    state.runtime.reset(nvinfer1::createInferRuntime(state.logger));
+    if (!state.runtime) return false;
+    state.engine.reset(state.runtime->deserializeCudaEngine(blob.data(), blob.size()));
+    if (!state.engine) {
+        std::cerr << "[TensorRtDetectorBackend] deserializeCudaEngine failed: " << desc.modelPath << std::endl;
+        return false;
+    }
+
+    std::vector<nvinfer1::DataType> outputTypes;
+    for (int i = 0; i < state.engine->getNbIOTensors(); ++i) {
+        const char* name = state.engine->getIOTensorName(i);
+        if (state.engine->getTensorIOMode(name) == nvinfer1::TensorIOMode::kINPUT) {
+            if (state.input.name.empty()) state.input.name = name;
+        } else {
+            state.outputs.push_back({name, 0});
+            outputTypes.push_back(state.engine->getTensorDataType(name));
+        }
+    }
+    if (state.input.name.empty() || state.outputs.empty()) {
+        std::cerr << "[TensorRtDetectorBackend] engine has no input/output tensor" << std::endl;
+        return false;
+    }
+    if (state.engine->getTensorDataType(state.input.name.c_str()) != nvinfer1::DataType::kFLOAT) {
+        std::cerr << "[TensorRtDetectorBackend] only FP32 input is supported (build engine with FP32 IO)" << std::endl;
+        return false;
+    }
+
+    const nvinfer1::Dims in = state.engine->getTensorShape(state.input.name.c_str());
+    if (in.nbDims != 4) {
+        std::cerr << "[TensorRtDetectorBackend] expected NCHW input, got " << in.nbDims << " dims" << std::endl;
+        return false;
+    }
+    state.inputH = in.d[2] > 0 ? static_cast<int>(in.d[2]) : (desc.inputHeight > 0 ? desc.inputHeight : 640);
+    state.inputW = in.d[3] > 0 ? static_cast<int>(in.d[3]) : (desc.inputWidth > 0 ? desc.inputWidth : 640);
+    state.input.frameBytes = static_cast<std::size_t>(3) * state.inputH * state.inputW * sizeof(float);
+    state.fixedBatch = in.d[0] > 0;
+    if (state.fixedBatch) {
+        state.maxBatch = static_cast<std::size_t>(in.d[0]);
+    } else {
+        // 动态 batch：不超过优化 profile 0 的上限
+        const nvinfer1::Dims maxDims =
+            state.engine->getProfileShape(state.input.name.c_str(), 0, nvinfer1::OptProfileSelector::kMAX);
+        const int profileMax = maxDims.nbDims > 0 && maxDims.d[0] > 0 ? static_cast<int>(maxDims.d[0]) : 1;
+        state.maxBatch = static_cast<std::size_t>(std::clamp(desc.maxBatch, 1, profileMax));
+    }
+
+    // 输入形状确定后才能解析输出形状（batch 维可能随输入变化）
+    std::unique_ptr<nvinfer1::IExecutionContext> probe(state.engine->createExecutionContext());
+    if (!probe || !probe->setInputShape(state.input.name.c_str(),
+                                        nvinfer1::Dims4{static_cast<int>(state.maxBatch), 3, state.inputH, state.inputW})) {
+        std::cerr << "[TensorRtDetectorBackend] cannot resolve shapes for batch " << state.maxBatch << std::endl;
+        return false;
+    }
+    for (std::size_t i = 0; i < state.outputs.size(); ++i) {
+        state.outputs[i].frameBytes = frameBytes(probe->getTensorShape(state.outputs[i].name.c_str()), outputTypes[i]);
+    }
+
+    state.nmsCount = findOutput(state, "num_dets");
+    state.nmsBoxes = findOutput(state, "det_boxes");
+    state.nmsScores = findOutput(state, "det_scores");
+    state.nmsClasses = findOutput(state, "det_classes");
+    if (state.nmsCount >= 0 && state.nmsBoxes >= 0 && state.nmsScores >= 0 && state.nmsClasses >= 0) {
+        state.kind = OutputKind::EfficientNms;
+        state.maxDetections = state.outputs[state.nmsScores].frameBytes / sizeof(float);
+        return true;
+    }
+    state.kind = OutputKind::Raw;
+    if (outputTypes[0] != nvinfer1::DataType::kFLOAT) {
+        std::cerr << "[TensorRtDetectorBackend] only FP32 raw output is supported" << std::endl;
+        return false;
+    }
+    const nvinfer1::Dims out = probe->getTensorShape(state.outputs[0].name.c_str());
+    if (out.nbDims != 3 || out.d[1] <= 0 || out.d[2] <= 0) {
+        std::cerr << "[TensorRtDetectorBackend] unexpected output shape (" << out.nbDims << " dims)" << std::endl;
+        return false;
+    }
+    state.outputChannels = static_cast<std::size_t>(out.d[1]);
+    state.outputBoxes = static_cast<std::size_t>(out.d[2]);
+    state.outputs.resize(1);  // 其余输出（如辅助头）不拷回
+    return true;
+}
+
+// 建立一路在途推理：执行上下文（有足够多优化 profile 时各用其一）、stream 与缓冲，并一次绑定张量地址
+bool setupStream(TensorRtState& state, TensorRtStream& s, std::size_t index, const DetectorDescriptor& desc) {
+    s.context.reset(state.engine->createExecutionContext());
+    if (!s.context || !checkCuda(cudaStreamCreateWithFlags(&s.stream, cudaStreamNonBlocking), "cudaStreamCreate")) {
+        return false;
+    }
+    if (!state.fixedBatch && state.engine->getNbOptimizationProfiles() > static_cast<int>(index) && index > 0 &&
+        !s.context->setOptimizationProfileAsync(static_cast<int>(index), s.stream)) {
+        std::cerr << "[TensorRtDetectorBackend] setOptimizationProfileAsync(" << index << ") failed" << std::endl;
+        return false;
+    }
+    if (!setBatch(state, s, static_cast<int>(state.maxBatch))) return false;
+
+    const std::size_t inputBytes = state.maxBatch * state.input.frameBytes;
+    if (!checkCuda(cudaMalloc(&s.deviceInput, inputBytes), "cudaMalloc(input)") ||
+        !checkCuda(cudaMallocHost(reinterpret_cast<void**>(&s.hostInput), inputBytes), "cudaMallocHost(input)") ||
+        !s.context->setTensorAddress(state.input.name.c_str(), s.deviceInput)) {
+        return false;
+    }
+    s.deviceOutputs.assign(state.outputs.size(), nullptr);
+    s.hostOutputs.assign(state.outputs.size(), nullptr);
+    for (std::size_t i = 0; i < state.outputs.size(); ++i) {
+        const std::size_t bytes = state.maxBatch * state.outputs[i].frameBytes;
+        if (!checkCuda(cudaMalloc(&s.deviceOutputs[i], bytes), "cudaMalloc(output)") ||
+            !checkCuda(cudaMallocHost(&s.hostOutputs[i], bytes), "cudaMallocHost(output)") ||
+            !s.context->setTensorAddress(state.outputs[i].name.c_str(), s.deviceOutputs[i])) {
+            return false;
+        }
+    }
+    if (desc.profiling && (!checkCuda(cudaEventCreate(&s.inferBegin), "cudaEventCreate") ||
+                           !checkCuda(cudaEventCreate(&s.inferEnd), "cudaEventCreate"))) {
+        return false;
+    }
+    s.preprocessor = std::make_unique<YoloPreprocessor>(yoloPreprocessConfig(desc));
+    s.transforms.resize(state.maxBatch);
+    s.valid.assign(state.maxBatch, 0);
+    s.raw.reserve(256);
+    return true;
+}
+
+// EfficientNMS 输出（网络输入坐标系下的 x1,y1,x2,y2）转为 YoloRawDet 后按前处理变换映射回原图
+void fillFromEfficientNms(const TensorRtState& state, TensorRtStream& s, std::size_t b, const ImageView& image,
+                          DetectionResult& out) {
+    const auto* count = static_cast<const std::int32_t*>(s.hostOutputs[state.nmsCount]) + b;
+    const auto* boxes = static_cast<const float*>(s.hostOutputs[state.nmsBoxes]) + b * state.maxDetections * 4;
+    const auto* scores = static_cast<const float*>(s.hostOutputs[state.nmsScores]) + b * state.maxDetections;
+    const auto* classes = static_cast<const std::int32_t*>(s.hostOutputs[state.nmsClasses]) + b * state.maxDetections;
+    const std::size_t n = std::min<std::size_t>(static_cast<std::size_t>(std::max(0, *count)), state.maxDetections);
+    s.raw.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        YoloRawDet& r = s.raw[i];
+        r.x = boxes[i * 4];
+        r.y = boxes[i * 4 + 1];
+        r.w = boxes[i * 4 + 2] - boxes[i * 4];
+        r.h = boxes[i * 4 + 3] - boxes[i * 4 + 1];
+        r.score = scores[i];
+        r.classId = classes[i];
+    }
+    s.suppressed.assign(n, false);
+    fillDetectionResultFromYolo(s.raw, s.suppressed, s.transforms[b], image.width, image.height, out);
+}
+
+} // namespace
+#endif
+
+TensorRtDetectorBackend::~TensorRtDetectorBackend() {
+    unload();
+}
+
 bool TensorRtDetectorBackend::load(const DetectorDescriptor& desc) {
     desc_ = desc;
+#if defined(FALCONMINDSDK_TENSORRT_BACKEND_ENABLED) && FALCONMINDSDK_TENSORRT_BACKEND_ENABLED
+    if (trtState_) {
+        unload();
+    }
+    auto* state = new TensorRtState();
+    if (!setupEngine(*state, desc_)) {
+        delete state;
+        return false;
+    }
+    const std::size_t streams = desc_.cudaStreams > 1 ? static_cast<std::size_t>(desc_.cudaStreams) : 1;
+    for (std::size_t i = 0; i < streams; ++i) {
+        auto s = std::make_unique<TensorRtStream>();
+        if (!setupStream(*state, *s, i, desc_)) {
+            delete state;
+            return false;
+        }
+        state->idle.push_back(s.get());
+        state->streams.push_back(std::move(s));
+    }
+    trtState_ = state;
     loaded_ = true;
+    async_ = std::make_unique<AsyncInferenceQueue>(*this, maxConcurrentRuns());
+    std::cout << "[TensorRtDetectorBackend] loaded: " << desc_.modelPath
+              << " input=" << state->input.name << " " << state->inputW << "x" << state->inputH
+              << " batch=" << state->maxBatch << (state->fixedBatch ? "" : " (dynamic)")
+              << " output=" << (state->kind == OutputKind::EfficientNms ? "EfficientNMS" : state->outputs[0].name)
+              << " streams=" << streams << std::endl;
+    return true;
+#else
+    loaded_ = true;
+    async_ = std::make_unique<AsyncInferenceQueue>(*this, maxConcurrentRuns());
     std::cout << "[TensorRtDetectorBackend] load model: " << desc_.modelPath
               << " (id=" << desc_.detectorId << ")" << std::endl;
-    // 未来可在此处接入 TensorRT engine 反序列化与 context 构建逻辑。
     return true;
+#endif
 }
 
 void TensorRtDetectorBackend::unload() {
+    async_.reset();  // 等待在途的异步推理完成
+#if defined(FALCONMINDSDK_TENSORRT_BACKEND_ENABLED) && FALCONMINDSDK_TENSORRT_BACKEND_ENABLED
+    if (trtState_) {
+        auto* state = static_cast<TensorRtState*>(trtState_);
+        {
+            // 等所有在途推理归还 stream
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->idleCv.wait(lock, [state] { return state->idle.size() == state->streams.size(); });
+        }
+        delete state;
+        trtState_ = nullptr;
+    }
+#endif
     if (loaded_) {
         std::cout << "[TensorRtDetectorBackend] unload model: " << desc_.modelPath << std::endl;
     }
     loaded_ = false;
 }
 
+bool TensorRtDetectorBackend::submit(const ImageView& image, DetectionResult& outResult, DetectionCallback done) {
+    if (!async_) return IDetectorBackend::submit(image, outResult, std::move(done));
+    return async_->submit(image, outResult, std::move(done));
+}
+
+std::size_t TensorRtDetectorBackend::maxInFlight() const {
+    return async_ ? async_->depth() : 1;
+}
+
+bool TensorRtDetectorBackend::setClassFilter(const std::vector<int>& classIds) {
+    // EfficientNMS engine 在设备端完成类别打分，掩码只对原始 YOLO 输出生效
+    classFilter_ = normalizeClassIds(classIds);
+    return true;
+}
+
+std::size_t TensorRtDetectorBackend::maxBatchSize() const {
+#if defined(FALCONMINDSDK_TENSORRT_BACKEND_ENABLED) && FALCONMINDSDK_TENSORRT_BACKEND_ENABLED
+    if (trtState_) return static_cast<TensorRtState*>(trtState_)->maxBatch;
+#endif
+    return 1;
+}
+
+std::size_t TensorRtDetectorBackend::maxConcurrentRuns() const {
+#if defined(FALCONMINDSDK_TENSORRT_BACKEND_ENABLED) && FALCONMINDSDK_TENSORRT_BACKEND_ENABLED
+    if (trtState_) return static_cast<TensorRtState*>(trtState_)->streams.size();
+#endif
+    return 1;
+}
+
 bool TensorRtDetectorBackend::run(const ImageView& image, DetectionResult& outResult) {
+    return runBatch(&image, &outResult, 1);
+}
+
+bool TensorRtDetectorBackend::runBatch(const ImageView* images, DetectionResult* results, std::size_t count) {
     if (!loaded_) {
         std::cerr << "[TensorRtDetectorBackend] run() called before load()" << std::endl;
         return false;
     }
 
-    std::cout << "[TensorRtDetectorBackend] run(): image "
-              << image.width << "x" << image.height
-              << " format=" << image.pixelFormat
-              << " using model=" << desc_.modelPath << std::endl;
+#if defined(FALCONMINDSDK_TENSORRT_BACKEND_ENABLED) && FALCONMINDSDK_TENSORRT_BACKEND_ENABLED
+    auto* state = static_cast<TensorRtState*>(trtState_);
+    if (!state) return false;
+
+    TensorRtStream* s = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->idleCv.wait(lock, [state] { return !state->idle.empty(); });
+        s = state->idle.back();
+        state->idle.pop_back();
+    }
+
+    const int numClasses = desc_.numClasses > 0 ? desc_.numClasses : 80;
+    const float scoreThr = desc_.scoreThreshold > 0 ? desc_.scoreThreshold : 0.25f;
+    const NmsConfig nmsCfg = nmsConfig(desc_);
+    const std::size_t inPlane = state->input.frameBytes / sizeof(float);
+
+    bool allOk = true;
+    for (std::size_t first = 0; first < count; first += state->maxBatch) {
+        const std::size_t n = std::min(state->maxBatch, count - first);
+        InputTensorSpec spec;
+        spec.width = state->inputW;
+        spec.height = state->inputH;
+        StageTimer timer(desc_.profiling);
+        for (std::size_t b = 0; b < n; ++b) {
+            const ImageView& image = images[first + b];
+            results[first + b].detections.clear();
+            results[first + b].frameIndex = image.frameIndex;
+            results[first + b].timestampNs = static_cast<std::uint64_t>(image.captureTimestampNs);
+            results[first + b].timing = DetectionTiming{};
+            s->valid[b] = s->preprocessor->run(image, spec, s->hostInput + b * inPlane, s->transforms[b]);
+            results[first + b].timing.preprocessUs = timer.lapUs();
+            if (!s->valid[b]) {
+                std::cerr << "[TensorRtDetectorBackend] unsupported input " << image.width << "x" << image.height
+                          << " format=" << image.pixelFormat << std::endl;
+                allOk = false;
+            }
+        }
+        if (std::find(s->valid.begin(), s->valid.begin() + n, 1) == s->valid.begin() + n) continue;
 
-    outResult.detections.clear();
-    outResult.frameId.clear();
-    outResult.frameIndex = 0;
-    outResult.timestampNs = 0;
+        // 本 stream 上依次排队 H2D → 推理 → D2H，只在末尾同步；其它在途 stream 的拷贝与计算与之重叠。
+        // 固定 batch 的 engine 送满 maxBatch 帧，多出的切片沿用上一次的内容，结果丢弃
+        const std::size_t batch = state->fixedBatch ? state->maxBatch : n;
+        bool ok = setBatch(*state, *s, static_cast<int>(batch)) &&
+                  checkCuda(cudaMemcpyAsync(s->deviceInput, s->hostInput, batch * state->input.frameBytes,
+                                            cudaMemcpyHostToDevice, s->stream), "cudaMemcpyAsync(input)");
+        if (ok && s->inferBegin) cudaEventRecord(s->inferBegin, s->stream);
+        if (ok && !s->context->enqueueV3(s->stream)) {
+            std::cerr << "[TensorRtDetectorBackend] enqueueV3 failed (batch=" << batch << ")" << std::endl;
+            ok = false;
+        }
+        if (ok && s->inferEnd) cudaEventRecord(s->inferEnd, s->stream);
+        // EfficientNMS 只拷回每帧最终的 maxDetections 个框，原始头拷回整个 (4+C, boxes) 平面
+        for (std::size_t i = 0; ok && i < state->outputs.size(); ++i) {
+            ok = checkCuda(cudaMemcpyAsync(s->hostOutputs[i], s->deviceOutputs[i], n * state->outputs[i].frameBytes,
+                                           cudaMemcpyDeviceToHost, s->stream), "cudaMemcpyAsync(output)");
+        }
+        if (!ok || !checkCuda(cudaStreamSynchronize(s->stream), "cudaStreamSynchronize")) {
+            allOk = false;
+            continue;
+        }
+        // 推理墙钟含 H2D / D2H 与排队等待，batch 内各帧共用；设备耗时取事件间隔
+        const std::uint32_t inferUs = timer.lapUs();
+        float deviceMs = 0.f;
+        if (s->inferBegin && cudaEventElapsedTime(&deviceMs, s->inferBegin, s->inferEnd) != cudaSuccess) deviceMs = 0.f;
+
+        for (std::size_t b = 0; b < n; ++b) {
+            if (!s->valid[b]) continue;
+            const ImageView& image = images[first + b];
+            DetectionTiming& timing = results[first + b].timing;
+            timing.inferUs = inferUs;
+            if (deviceMs > 0.f) {
+                timing.deviceUs = static_cast<std::uint32_t>(deviceMs * 1000.f);
+                if (inferUs > 0) timing.deviceUtilization = std::min(1.f, deviceMs * 1000.f / static_cast<float>(inferUs));
+            }
+            timer.lapUs();
+            if (state->kind == OutputKind::EfficientNms) {
+                // NMS 已在 engine 内完成，这里只有框的解码与映射
+                fillFromEfficientNms(*state, *s, b, image, results[first + b]);
+                timing.decodeUs = timer.lapUs();
+                continue;
+            }
+            const auto* output = static_cast<const float*>(s->hostOutputs[0]);
+            s->raw.clear();
+            decodeYoloOutput84xN(output + b * state->outputChannels * state->outputBoxes, state->outputChannels,
+                                 state->outputBoxes, numClasses, scoreThr, s->raw, classFilter_);
+            timing.decodeUs = timer.lapUs();
+            if (s->raw.empty()) continue;
+            nmsYoloDetections(s->raw, nmsCfg, s->suppressed);
+            fillDetectionResultFromYolo(s->raw, s->suppressed, s->transforms[b], image.width, image.height,
+                                        results[first + b]);
+            timing.nmsUs = timer.lapUs();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->idle.push_back(s);
+    }
+    state->idleCv.notify_all();
+    return allOk;
+#else
+    for (std::size_t i = 0; i < count; ++i) {
+        const ImageView& image = images[i];
+        FM_LOG_DEBUG("TensorRtDetectorBackend", "run(): image ", image.width, "x", image.height,
+                     " format=", image.pixelFormat, " using model=", desc_.modelPath);
+        results[i].detections.clear();
+        results[i].frameId.clear();
+        results[i].frameIndex = image.frameIndex;
+        results[i].timestampNs = static_cast<std::uint64_t>(image.captureTimestampNs);
+    }
     return true;
+#endif
 }
 
 } // namespace falconmind::sdk::perception
-
@@ -0,0 +1,388 @@
+#include "falconmind/sdk/perception/TerrainTileCache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+constexpr char kFileMagic[4] = {'F', 'M', 'D', 'T'};
+constexpr std::uint32_t kTerrainVersion = 1;
+constexpr std::size_t kPage = 4096;
+constexpr double kMetersPerDegree = 111320.0;
+constexpr double kPi = 3.14159265358979323846;
+
+struct FileHeader {
+    char magic[4];
+    std::uint32_t version;
+    double originLat, originLon;
+    double latSpacing, lonSpacing;
+    std::int32_t rows, cols;
+    std::int32_t tileSize;
+    std::int32_t tilesLat, tilesLon;
+    std::uint32_t reserved;
+    std::uint64_t indexOffset;
+};
+
+static_assert(sizeof(FileHeader) % 8 == 0, "terrain header must keep the tile index aligned");
+
+std::size_t tileBytesFor(int tileSize) {
+    const std::size_t raw = static_cast<std::size_t>(tileSize + 1) * (tileSize + 1) * sizeof(float);
+    return (raw + kPage - 1) / kPage * kPage;
+}
+
+int tilesFor(int samples, int tileSize) {
+    return (samples - 1 + tileSize - 1) / tileSize;
+}
+
+bool writeAt(int fd, const void* data, std::size_t size, std::uint64_t offset) {
+    const auto* p = static_cast<const std::uint8_t*>(data);
+    while (size > 0) {
+        const ssize_t n = ::pwrite(fd, p, size, static_cast<off_t>(offset));
+        if (n <= 0) return false;
+        p += n;
+        size -= static_cast<std::size_t>(n);
+        offset += static_cast<std::uint64_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+TerrainTileCache::~TerrainTileCache() {
+    if (base_) ::munmap(base_, length_);
+    if (fd_ >= 0) ::close(fd_);
+}
+
+std::shared_ptr<TerrainTileCache> TerrainTileCache::open(const std::string& path, const TerrainCacheConfig& cfg) {
+    std::shared_ptr<TerrainTileCache> cache(new TerrainTileCache(cfg));
+    cache->path_ = path;
+    if (!cache->load()) return nullptr;
+    return cache;
+}
+
+bool TerrainTileCache::load() {
+    fd_ = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        std::cerr << "[TerrainTileCache] open " << path_ << " failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat st{};
+    if (::fstat(fd_, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(FileHeader)) {
+        std::cerr << "[TerrainTileCache] " << path_ << " is too short" << std::endl;
+        return false;
+    }
+    length_ = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (p == MAP_FAILED) {
+        std::cerr << "[TerrainTileCache] mmap " << path_ << " failed: " << std::strerror(errno) << std::endl;
+        length_ = 0;
+        return false;
+    }
+    base_ = static_cast<std::uint8_t*>(p);
+    FileHeader header{};
+    std::memcpy(&header, base_, sizeof(header));
+    const bool shapeOk = std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) == 0 &&
+                         header.version == kTerrainVersion && header.rows >= 2 && header.cols >= 2 &&
+                         header.tileSize >= 1 && header.latSpacing > 0. && header.lonSpacing > 0. &&
+                         header.tilesLat == tilesFor(header.rows, header.tileSize) &&
+                         header.tilesLon == tilesFor(header.cols, header.tileSize);
+    const std::size_t tiles = shapeOk ? static_cast<std::size_t>(header.tilesLat) * header.tilesLon : 0;
+    if (!shapeOk || header.indexOffset % 8 != 0 || header.indexOffset > length_ ||
+        (length_ - header.indexOffset) / sizeof(std::uint64_t) < tiles) {
+        std::cerr << "[TerrainTileCache] " << path_ << " is not a terrain tile file" << std::endl;
+        return false;
+    }
+    originLat_ = header.originLat;
+    originLon_ = header.originLon;
+    latSpacing_ = header.latSpacing;
+    lonSpacing_ = header.lonSpacing;
+    invLatSpacing_ = 1.0 / latSpacing_;
+    invLonSpacing_ = 1.0 / lonSpacing_;
+    rows_ = header.rows;
+    cols_ = header.cols;
+    tileSize_ = header.tileSize;
+    tilesLat_ = header.tilesLat;
+    tilesLon_ = header.tilesLon;
+    tileBytes_ = tileBytesFor(tileSize_);
+    offsets_ = reinterpret_cast<const std::uint64_t*>(base_ + header.indexOffset);
+    for (std::size_t i = 0; i < tiles; ++i) {
+        const std::uint64_t off = offsets_[i];
+        if (off != 0 && (off % kPage != 0 || off > length_ || length_ - off < tileBytes_)) {
+            std::cerr << "[TerrainTileCache] " << path_ << " tile " << i << " out of range" << std::endl;
+            return false;
+        }
+    }
+    states_ = std::make_unique<TileState[]>(tiles);
+    // 访问模式为随机块，关闭内核顺序预读；需要时由 prefetchPath 显式 WILLNEED
+    ::madvise(base_, length_, MADV_RANDOM);
+    return true;
+}
+
+const float* TerrainTileCache::tile(std::size_t index) const noexcept {
+    const std::uint64_t off = offsets_[index];
+    if (off == 0) return nullptr;
+    TileState& s = states_[index];
+    if (!s.resident.load(std::memory_order_acquire)) admit(index, false);
+    const std::uint32_t e = epoch_.load(std::memory_order_relaxed);
+    if (s.lastUse.load(std::memory_order_relaxed) != e) s.lastUse.store(e, std::memory_order_relaxed);
+    return reinterpret_cast<const float*>(base_ + off);
+}
+
+bool TerrainTileCache::admit(std::size_t index, bool willNeed) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TileState& s = states_[index];
+    if (s.resident.load(std::memory_order_relaxed)) return false;
+    if (willNeed) ::madvise(base_ + offsets_[index], tileBytes_, MADV_WILLNEED);
+    s.lastUse.store(epoch_.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    s.resident.store(true, std::memory_order_release);
+    resident_.push_back(static_cast<std::uint32_t>(index));
+    loads_.fetch_add(1, std::memory_order_relaxed);
+    // 超出预算：释放最久未用的块（至少保留刚登记的这一块）
+    while (resident_.size() > 1 && resident_.size() * tileBytes_ > cfg_.residentBudgetBytes) {
+        std::size_t oldest = resident_.size();
+        std::uint32_t oldestUse = std::numeric_limits<std::uint32_t>::max();
+        for (std::size_t i = 0; i < resident_.size(); ++i) {
+            if (resident_[i] == index) continue;
+            const std::uint32_t use = states_[resident_[i]].lastUse.load(std::memory_order_relaxed);
+            if (use < oldestUse) {
+                oldestUse = use;
+                oldest = i;
+            }
+        }
+        release(resident_[oldest]);
+        resident_[oldest] = resident_.back();
+        resident_.pop_back();
+    }
+    return true;
+}
+
+void TerrainTileCache::release(std::size_t index) const {
+    states_[index].resident.store(false, std::memory_order_relaxed);
+    // 只读文件映射：丢弃页表项后再访问由缺页重新读入，并发读者不受影响
+    const std::uint64_t off = offsets_[index];
+    ::madvise(base_ + off, tileBytes_, MADV_DONTNEED);
+    ::posix_fadvise(fd_, static_cast<off_t>(off), static_cast<off_t>(tileBytes_), POSIX_FADV_DONTNEED);
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool TerrainTileCache::inRange(double& fr, double& fc) const noexcept {
+    // 边缘样本的经纬度换算回网格坐标可能略超出末行 / 末列，容许 1e-6 个网格并截断
+    constexpr double kEdge = 1e-6;
+    if (!(fr >= -kEdge) || !(fc >= -kEdge) || fr > rows_ - 1 + kEdge || fc > cols_ - 1 + kEdge) return false;
+    fr = std::clamp(fr, 0.0, static_cast<double>(rows_ - 1));
+    fc = std::clamp(fc, 0.0, static_cast<double>(cols_ - 1));
+    return true;
+}
+
+float TerrainTileCache::sample(const float* t, int r0, int c0, double fr, double fc) const noexcept {
+    const double wr = fr - r0, wc = fc - c0;
+    const float* p = t + static_cast<std::size_t>(r0 % tileSize_) * (tileSize_ + 1) + c0 % tileSize_;
+    const double south = p[0] + (p[1] - p[0]) * wc;
+    const double north = p[tileSize_ + 1] + (p[tileSize_ + 2] - p[tileSize_ + 1]) * wc;
+    return static_cast<float>(south + (north - south) * wr);
+}
+
+bool TerrainTileCache::height(double lat, double lon, float& out) const noexcept {
+    double fr = (lat - originLat_) * invLatSpacing_;
+    double fc = (lon - originLon_) * invLonSpacing_;
+    if (!inRange(fr, fc)) return false;
+    // 插值单元左下角样本（末行 / 末列归入前一单元，保证四个样本都在网格内）
+    const int r0 = std::min(static_cast<int>(fr), rows_ - 2);
+    const int c0 = std::min(static_cast<int>(fc), cols_ - 2);
+    const float* t = tile(static_cast<std::size_t>(r0 / tileSize_) * tilesLon_ + c0 / tileSize_);
+    if (!t) return false;
+    const float h = sample(t, r0, c0, fr, fc);
+    if (std::isnan(h)) return false;
+    out = h;
+    return true;
+}
+
+std::size_t TerrainTileCache::heights(const double* lat, const double* lon, std::size_t count,
+                                      float* out) const noexcept {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::size_t lastIndex = std::numeric_limits<std::size_t>::max();
+    const float* last = nullptr;
+    std::size_t valid = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        double fr = (lat[i] - originLat_) * invLatSpacing_;
+        double fc = (lon[i] - originLon_) * invLonSpacing_;
+        out[i] = nan;
+        if (!inRange(fr, fc)) continue;
+        const int r0 = std::min(static_cast<int>(fr), rows_ - 2);
+        const int c0 = std::min(static_cast<int>(fc), cols_ - 2);
+        const std::size_t index = static_cast<std::size_t>(r0 / tileSize_) * tilesLon_ + c0 / tileSize_;
+        if (index != lastIndex) {
+            last = tile(index);
+            lastIndex = index;
+        }
+        if (!last) continue;
+        out[i] = sample(last, r0, c0, fr, fc);
+        if (!std::isnan(out[i])) ++valid;
+    }
+    return valid;
+}
+
+std::size_t TerrainTileCache::prefetchPath(const double* lat, const double* lon, std::size_t count,
+                                           double marginM) const {
+    if (count == 0) return 0;
+    const std::size_t budgetTiles = std::max<std::size_t>(1, cfg_.residentBudgetBytes / tileBytes_);
+    const double tileLat = tileSize_ * latSpacing_, tileLon = tileSize_ * lonSpacing_;
+    std::size_t added = 0;
+    auto visit = [&](double la, double lo) {
+        const double dLat = marginM / kMetersPerDegree;
+        const double dLon = marginM / (kMetersPerDegree * std::max(0.01, std::cos(la * kPi / 180.0)));
+        const int r0 = std::max(0, static_cast<int>(std::floor((la - dLat - originLat_) / tileLat)));
+        const int r1 = std::min(tilesLat_ - 1, static_cast<int>(std::floor((la + dLat - originLat_) / tileLat)));
+        const int c0 = std::max(0, static_cast<int>(std::floor((lo - dLon - originLon_) / tileLon)));
+        const int c1 = std::min(tilesLon_ - 1, static_cast<int>(std::floor((lo + dLon - originLon_) / tileLon)));
+        for (int r = r0; r <= r1 && added < budgetTiles; ++r) {
+            for (int c = c0; c <= c1 && added < budgetTiles; ++c) {
+                const std::size_t index = static_cast<std::size_t>(r) * tilesLon_ + c;
+                if (offsets_[index] != 0 && !states_[index].resident.load(std::memory_order_acquire) &&
+                    admit(index, true)) {
+                    ++added;
+                }
+            }
+        }
+    };
+    visit(lat[0], lon[0]);
+    // 每段按半块步长采样，保证不漏掉途经的块
+    for (std::size_t i = 1; i < count && added < budgetTiles; ++i) {
+        const double dla = lat[i] - lat[i - 1], dlo = lon[i] - lon[i - 1];
+        const int steps = 1 + static_cast<int>(2.0 * std::max(std::abs(dla) / tileLat, std::abs(dlo) / tileLon));
+        for (int s = 1; s <= steps && added < budgetTiles; ++s) {
+            const double f = static_cast<double>(s) / steps;
+            visit(lat[i - 1] + dla * f, lon[i - 1] + dlo * f);
+        }
+    }
+    return added;
+}
+
+std::size_t TerrainTileCache::residentTiles() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return resident_.size();
+}
+
+std::size_t TerrainTileCache::residentBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return resident_.size() * tileBytes_;
+}
+
+bool writeTerrainTiles(const std::string& path, const DemGrid& grid, int tileSize) {
+    if (grid.rows < 2 || grid.cols < 2 || tileSize < 1 || !(grid.latSpacingDeg > 0.) ||
+        !(grid.lonSpacingDeg > 0.) ||
+        grid.heights.size() != static_cast<std::size_t>(grid.rows) * static_cast<std::size_t>(grid.cols)) {
+        std::cerr << "[TerrainTileCache] invalid DEM grid " << grid.rows << "x" << grid.cols << std::endl;
+        return false;
+    }
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "[TerrainTileCache] create " << path << " failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    FileHeader header{};
+    std::memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.version = kTerrainVersion;
+    header.originLat = grid.originLat;
+    header.originLon = grid.originLon;
+    header.latSpacing = grid.latSpacingDeg;
+    header.lonSpacing = grid.lonSpacingDeg;
+    header.rows = grid.rows;
+    header.cols = grid.cols;
+    header.tileSize = tileSize;
+    header.tilesLat = tilesFor(grid.rows, tileSize);
+    header.tilesLon = tilesFor(grid.cols, tileSize);
+    header.indexOffset = sizeof(FileHeader);
+
+    const std::size_t tiles = static_cast<std::size_t>(header.tilesLat) * header.tilesLon;
+    const std::size_t tileBytes = tileBytesFor(tileSize);
+    std::vector<std::uint64_t> offsets(tiles, 0);
+    std::uint64_t cursor = (sizeof(FileHeader) + tiles * sizeof(std::uint64_t) + kPage - 1) / kPage * kPage;
+    const int side = tileSize + 1;
+    std::vector<float> data(tileBytes / sizeof(float));
+    bool ok = true;
+    for (int tr = 0; tr < header.tilesLat && ok; ++tr) {
+        for (int tc = 0; tc < header.tilesLon && ok; ++tc) {
+            std::fill(data.begin(), data.end(), std::numeric_limits<float>::quiet_NaN());
+            bool any = false;
+            for (int r = 0; r < side; ++r) {
+                const int gr = tr * tileSize + r;
+                if (gr >= grid.rows) break;
+                for (int c = 0; c < side; ++c) {
+                    const int gc = tc * tileSize + c;
+                    if (gc >= grid.cols) break;
+                    const float h = grid.heights[static_cast<std::size_t>(gr) * grid.cols + gc];
+                    data[static_cast<std::size_t>(r) * side + c] = h;
+                    any = any || !std::isnan(h);
+                }
+            }
+            if (!any) continue;  // 全无数据的块不写入
+            offsets[static_cast<std::size_t>(tr) * header.tilesLon + tc] = cursor;
+            ok = writeAt(fd, data.data(), tileBytes, cursor);
+            cursor += tileBytes;
+        }
+    }
+    ok = ok && writeAt(fd, &header, sizeof(header), 0) &&
+         writeAt(fd, offsets.data(), offsets.size() * sizeof(std::uint64_t), header.indexOffset) &&
+         ::ftruncate(fd, static_cast<off_t>(cursor)) == 0;
+    if (!ok) std::cerr << "[TerrainTileCache] write " << path << " failed: " << std::strerror(errno) << std::endl;
+    ::close(fd);
+    return ok;
+}
+
+bool loadSrtmHgt(const std::string& path, DemGrid& grid) {
+    // 文件名 [NS]dd[EW]ddd.hgt 给出西南角
+    const auto slash = path.find_last_of('/');
+    const std::string name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    int latDeg = 0, lonDeg = 0;
+    char ns = 0, ew = 0;
+    if (std::sscanf(name.c_str(), "%c%2d%c%3d", &ns, &latDeg, &ew, &lonDeg) != 4 || (ns != 'N' && ns != 'S') ||
+        (ew != 'E' && ew != 'W')) {
+        std::cerr << "[TerrainTileCache] cannot parse SRTM tile name " << name << std::endl;
+        return false;
+    }
+    std::ifstream in(path, std::ios::binary);
+    std::vector<std::uint8_t> raw;
+    if (in) raw.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    const int n = static_cast<int>(std::lround(std::sqrt(static_cast<double>(raw.size() / 2))));
+    if (n < 2 || static_cast<std::size_t>(n) * n * 2 != raw.size()) {
+        std::cerr << "[TerrainTileCache] " << path << " is not an SRTM .hgt file" << std::endl;
+        return false;
+    }
+    grid.originLat = ns == 'N' ? latDeg : -latDeg;
+    grid.originLon = ew == 'E' ? lonDeg : -lonDeg;
+    grid.latSpacingDeg = grid.lonSpacingDeg = 1.0 / (n - 1);
+    grid.rows = grid.cols = n;
+    grid.heights.resize(static_cast<std::size_t>(n) * n);
+    for (int r = 0; r < n; ++r) {
+        // 文件第 0 行在最北
+        const std::uint8_t* src = raw.data() + static_cast<std::size_t>(n - 1 - r) * n * 2;
+        float* dst = grid.heights.data() + static_cast<std::size_t>(r) * n;
+        for (int c = 0; c < n; ++c) {
+            const auto v = static_cast<std::int16_t>(static_cast<std::uint16_t>(src[2 * c] << 8 | src[2 * c + 1]));
+            dst[c] = v == -32768 ? std::numeric_limits<float>::quiet_NaN() : static_cast<float>(v);
+        }
+    }
+    return true;
+}
+
+bool convertSrtmHgt(const std::string& hgtPath, const std::string& outPath, int tileSize) {
+    DemGrid grid;
+    return loadSrtmHgt(hgtPath, grid) && writeTerrainTiles(outPath, grid, tileSize);
+}
+
+} // namespace falconmind::sdk::perception
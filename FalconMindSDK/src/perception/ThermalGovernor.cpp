@@ -0,0 +1,247 @@
+#include "falconmind/sdk/perception/ThermalGovernor.h"
+#include "falconmind/sdk/perception/AltitudeModelPolicy.h"
+#include "falconmind/sdk/perception/InferenceRateController.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+namespace falconmind::sdk::perception {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 读取 sysfs 文件的第一个整数；不可读时返回 false
+bool readInt(const fs::path& path, long long& out) {
+    std::ifstream in(path);
+    return static_cast<bool>(in >> out);
+}
+
+std::string readLine(const fs::path& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+std::size_t levelIndex(ThermalLevel level) { return static_cast<std::size_t>(level); }
+
+std::int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+const char* thermalLevelName(ThermalLevel level) noexcept {
+    switch (level) {
+        case ThermalLevel::Nominal: return "nominal";
+        case ThermalLevel::Warm: return "warm";
+        case ThermalLevel::Hot: return "hot";
+        case ThermalLevel::Critical: return "critical";
+        case ThermalLevel::Count: break;
+    }
+    return "unknown";
+}
+
+ThermalSample ThermalGovernor::readSysfs(const std::string& root, const std::vector<std::string>& zoneTypes) {
+    ThermalSample s;
+    const fs::path base = root.empty() ? fs::path("/") : fs::path(root);
+    std::error_code ec;
+
+    for (const auto& entry : fs::directory_iterator(base / "sys/class/thermal", ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("thermal_zone", 0) != 0) continue;
+        const std::string type = readLine(entry.path() / "type");
+        if (!zoneTypes.empty() && std::find(zoneTypes.begin(), zoneTypes.end(), type) == zoneTypes.end()) continue;
+        long long milliC = 0;
+        if (!readInt(entry.path() / "temp", milliC)) continue;
+        const double c = static_cast<double>(milliC) / 1000.;
+        if (!s.hasTemp || c > s.maxTempC) {
+            s.hasTemp = true;
+            s.maxTempC = c;
+            s.hottestZone = type.empty() ? name : type;
+        }
+    }
+
+    for (const auto& entry : fs::directory_iterator(base / "sys/devices/system/cpu/cpufreq", ec)) {
+        if (entry.path().filename().string().rfind("policy", 0) != 0) continue;
+        long long cap = 0, hw = 0;
+        if (!readInt(entry.path() / "scaling_max_freq", cap) || !readInt(entry.path() / "cpuinfo_max_freq", hw) ||
+            hw <= 0) {
+            continue;
+        }
+        const double ratio = static_cast<double>(cap) / static_cast<double>(hw);
+        s.cpuFreqRatio = s.cpuFreqRatio < 0. ? ratio : std::min(s.cpuFreqRatio, ratio);
+    }
+
+    for (const auto& entry : fs::directory_iterator(base / "sys/class/devfreq", ec)) {
+        if (entry.path().filename().string().find("npu") == std::string::npos) continue;
+        long long cur = 0, cap = 0;
+        if (readInt(entry.path() / "cur_freq", cur)) s.npuFreqMHz = static_cast<double>(cur) / 1e6;
+        long long hw = 0;
+        std::istringstream freqs(readLine(entry.path() / "available_frequencies"));
+        for (long long f = 0; freqs >> f;) hw = std::max(hw, f);
+        if (hw > 0 && readInt(entry.path() / "max_freq", cap)) {
+            s.npuFreqRatio = static_cast<double>(cap) / static_cast<double>(hw);
+        }
+        break;
+    }
+    return s;
+}
+
+ThermalGovernor::ThermalGovernor(ThermalGovernorConfig config) : config_(std::move(config)) {
+    config_.pollMs = std::max(config_.pollMs, 10);
+    config_.slopeAlpha = std::clamp(config_.slopeAlpha, 0.01, 1.);
+    for (auto& a : config_.actions) a.intervalScale = std::max(a.intervalScale, 1);
+}
+
+ThermalGovernor::~ThermalGovernor() { stop(); }
+
+void ThermalGovernor::addRateController(std::shared_ptr<InferenceRateController> controller) {
+    if (!controller) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    rateTargets_.push_back({controller, controller->baseInterval()});
+    applyLocked();
+}
+
+void ThermalGovernor::addModelPolicy(std::shared_ptr<AltitudeModelPolicy> policy) {
+    if (!policy) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    policies_.push_back(std::move(policy));
+    applyLocked();
+}
+
+void ThermalGovernor::addNpuBackend(DetectorBackendPtr backend, std::uint32_t nominalMask) {
+    if (!backend) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    npuTargets_.push_back({std::move(backend), nominalMask});
+    applyLocked();
+}
+
+void ThermalGovernor::setEnergyEstimate(const flight::EnergyEstimate& energy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    energy_ = energy;
+}
+
+ThermalLevel ThermalGovernor::targetLevel(const ThermalSample& sample, double tempC) const {
+    ThermalLevel target = ThermalLevel::Nominal;
+    if (sample.hasTemp) {
+        for (std::size_t i = 0; i < config_.levelTempC.size(); ++i) {
+            if (tempC >= config_.levelTempC[i]) target = static_cast<ThermalLevel>(i + 1);
+        }
+    }
+    // 内核已在压低频率上限：推理时延已经在变长
+    const bool throttled = (sample.cpuFreqRatio >= 0. && sample.cpuFreqRatio < config_.throttleRatio) ||
+                           (sample.npuFreqRatio >= 0. && sample.npuFreqRatio < config_.throttleRatio);
+    if (throttled) target = std::max(target, ThermalLevel::Hot);
+    if (energy_.valid && energy_.enduranceSec >= 0.) {
+        if (config_.criticalEnduranceSec > 0. && energy_.enduranceSec < config_.criticalEnduranceSec) {
+            target = std::max(target, ThermalLevel::Hot);
+        } else if (config_.lowEnduranceSec > 0. && energy_.enduranceSec < config_.lowEnduranceSec) {
+            target = std::max(target, ThermalLevel::Warm);
+        }
+    }
+    return target;
+}
+
+ThermalLevel ThermalGovernor::update(const ThermalSample& sample, std::int64_t nowNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (sample.hasTemp && last_.hasTemp && nowNs > lastSampleNs_) {
+        const double dt = static_cast<double>(nowNs - lastSampleNs_) * 1e-9;
+        const double rate = (sample.maxTempC - last_.maxTempC) / dt;
+        slope_ += config_.slopeAlpha * (rate - slope_);
+    }
+    last_ = sample;
+    lastSampleNs_ = nowNs;
+
+    const double predicted = sample.maxTempC + std::max(slope_, 0.) * config_.lookaheadSec;
+    const ThermalLevel up = targetLevel(sample, predicted);
+    ThermalLevel next = level_;
+    if (up > level_) {
+        next = up;
+    } else if (level_ > ThermalLevel::Nominal &&
+               nowNs - changedNs_ >= static_cast<std::int64_t>(config_.cooldownMs) * 1000000) {
+        // 当前温度加上回差仍低于当前等级阈值时才降一级
+        if (targetLevel(sample, sample.maxTempC + config_.hysteresisC) < level_) {
+            next = static_cast<ThermalLevel>(levelIndex(level_) - 1);
+        }
+    }
+    if (next != level_) {
+        std::cout << "[ThermalGovernor] " << thermalLevelName(level_) << " -> " << thermalLevelName(next)
+                  << " temp=" << sample.maxTempC << "C (" << sample.hottestZone << ") slope=" << slope_
+                  << "C/s cpu_freq=" << sample.cpuFreqRatio << " npu_freq=" << sample.npuFreqRatio << std::endl;
+        level_ = next;
+        changedNs_ = nowNs;
+        ++changes_;
+        applyLocked();
+    }
+    return level_;
+}
+
+ThermalLevel ThermalGovernor::poll(std::int64_t nowNs) {
+    return update(readSysfs(config_.sysfsRoot, config_.zoneTypes), nowNs);
+}
+
+void ThermalGovernor::applyLocked() {
+    const ThermalLevelActions& a = config_.actions[levelIndex(level_)];
+    for (const auto& t : rateTargets_) t.controller->setBaseInterval(t.baseInterval * a.intervalScale);
+    for (const auto& p : policies_) p->setResourceCap(a.maxInputSide, a.maxInferences);
+    for (const auto& t : npuTargets_) {
+        const std::uint32_t mask = a.npuCoreMask != 0 ? a.npuCoreMask : t.nominalMask;
+        if (!t.backend->setNpuCoreMask(mask)) {
+            std::cerr << "[ThermalGovernor] setNpuCoreMask(" << mask << ") failed" << std::endl;
+        }
+    }
+}
+
+bool ThermalGovernor::start() {
+    if (running_.exchange(true)) return false;
+    thread_ = std::thread(&ThermalGovernor::run, this);
+    return true;
+}
+
+void ThermalGovernor::stop() {
+    if (!running_.exchange(false)) return;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+    }
+    wakeCv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void ThermalGovernor::run() {
+    while (running_.load()) {
+        poll(steadyNowNs());
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wakeCv_.wait_for(lock, std::chrono::milliseconds(config_.pollMs), [this] { return !running_.load(); });
+    }
+}
+
+ThermalLevel ThermalGovernor::level() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return level_;
+}
+
+ThermalSample ThermalGovernor::lastSample() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_;
+}
+
+double ThermalGovernor::tempSlopeCPerSec() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slope_;
+}
+
+std::uint64_t ThermalGovernor::levelChanges() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return changes_;
+}
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,396 @@
+#include "falconmind/sdk/perception/TiledDetectorBackend.h"
+#include "falconmind/sdk/perception/YoloPrePostProcess.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+// 单个方向上的切片起点：len ≤ tile 时一片覆盖全长，否则均匀分布、首尾贴边，相邻切片至少重叠 overlap
+std::vector<int> tileStarts(int len, int tile, float overlap) {
+    if (len <= tile) return {0};
+    const float step = std::max(1.f, static_cast<float>(tile) * (1.f - overlap));
+    const int n = static_cast<int>(std::ceil(static_cast<float>(len - tile) / step)) + 1;
+    std::vector<int> starts(static_cast<std::size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        starts[static_cast<std::size_t>(i)] =
+            static_cast<int>(std::lround(static_cast<double>(i) * (len - tile) / (n - 1)));
+    }
+    return starts;
+}
+
+bool intersects(const DetectionBBox& a, int x, int y, int w, int h) {
+    return a.x < static_cast<float>(x + w) && a.x + a.width > static_cast<float>(x) &&
+           a.y < static_cast<float>(y + h) && a.y + a.height > static_cast<float>(y);
+}
+
+// 截断残框：交集占较小框面积的比例超过该值时视为同一目标
+constexpr float kContainmentThreshold = 0.8f;
+
+} // namespace
+
+TiledDetectorBackend::TiledDetectorBackend(DetectorBackendPtr inner) : inner_(std::move(inner)) {}
+
+TiledDetectorBackend::~TiledDetectorBackend() = default;
+
+DetectionBackendType TiledDetectorBackend::backendType() const {
+    return inner_ ? inner_->backendType() : DetectionBackendType::Unknown;
+}
+
+bool TiledDetectorBackend::load(const DetectorDescriptor& desc) {
+    if (!inner_) {
+        std::cerr << "[TiledDetectorBackend] no inner backend" << std::endl;
+        return false;
+    }
+    if (!inner_->load(desc)) return false;
+    desc_ = desc;
+    tileW_ = desc.tileWidth > 0 ? desc.tileWidth : (desc.inputWidth > 0 ? desc.inputWidth : 640);
+    if (desc.tileHeight > 0) {
+        tileH_ = desc.tileHeight;
+    } else {
+        tileH_ = desc.tileWidth <= 0 && desc.inputHeight > 0 ? desc.inputHeight : tileW_;
+    }
+    desc_.tileOverlap = std::min(std::max(desc.tileOverlap, 0.f), 0.9f);
+    workers_ = std::make_unique<core::WorkerGroup>(std::max<std::size_t>(1, inner_->maxConcurrentRuns()));
+    frameW_ = frameH_ = 0;
+    tiles_.clear();
+    layout_.clear();
+    loaded_ = true;
+    std::cout << "[TiledDetectorBackend] tiles " << tileW_ << "x" << tileH_ << ", overlap " << desc_.tileOverlap
+              << ", " << workers_->count() << " concurrent runs, batch " << inner_->maxBatchSize() << std::endl;
+    return true;
+}
+
+void TiledDetectorBackend::unload() {
+    if (inner_) inner_->unload();
+    workers_.reset();
+    tiles_.clear();
+    layout_.clear();
+    frameW_ = frameH_ = 0;
+    loaded_ = false;
+}
+
+bool TiledDetectorBackend::isLoaded() const {
+    return loaded_ && inner_ && inner_->isLoaded();
+}
+
+std::vector<core::PixelFormat> TiledDetectorBackend::supportedPixelFormats() const {
+    // 切片是原帧的子视图，只适用于单平面紧凑格式
+    std::vector<core::PixelFormat> formats;
+    if (inner_) {
+        for (auto f : inner_->supportedPixelFormats()) {
+            if (f == core::PixelFormat::RGB8 || f == core::PixelFormat::BGR8) formats.push_back(f);
+        }
+    }
+    if (formats.empty()) formats = {core::PixelFormat::RGB8, core::PixelFormat::BGR8};
+    return formats;
+}
+
+bool TiledDetectorBackend::setClassFilter(const std::vector<int>& classIds) {
+    return inner_ && inner_->setClassFilter(classIds);
+}
+
+bool TiledDetectorBackend::setNpuCoreMask(std::uint32_t mask) {
+    return inner_ && inner_->setNpuCoreMask(mask);
+}
+
+void TiledDetectorBackend::setRegionsOfInterest(std::vector<DetectionBBox> regions) {
+    regions_ = std::move(regions);
+}
+
+void TiledDetectorBackend::setChangedRegions(std::vector<DetectionBBox> regions, float shiftX, float shiftY) {
+    changedRegions_ = std::move(regions);
+    changedRegionsSet_ = true;
+    shiftX_ = shiftX;
+    shiftY_ = shiftY;
+}
+
+std::size_t TiledDetectorBackend::tileCount(int width, int height, int tileWidth, int tileHeight, float overlap) {
+    if (width <= 0 || height <= 0 || tileWidth <= 0 || tileHeight <= 0) return 1;
+    return tileStarts(width, std::min(tileWidth, width), overlap).size() *
+           tileStarts(height, std::min(tileHeight, height), overlap).size();
+}
+
+void TiledDetectorBackend::buildLayout(int width, int height) {
+    frameW_ = width;
+    frameH_ = height;
+    tiles_.clear();
+    layout_.clear();
+    const int tw = std::min(tileW_, width);
+    const int th = std::min(tileH_, height);
+    for (int y : tileStarts(height, th, desc_.tileOverlap)) {
+        for (int x : tileStarts(width, tw, desc_.tileOverlap)) {
+            Tile tile;
+            tile.x = x;
+            tile.y = y;
+            tile.w = tw;
+            tile.h = th;
+            tiles_.push_back(std::move(tile));
+            layout_.push_back(DetectionBBox{static_cast<float>(x), static_cast<float>(y), static_cast<float>(tw),
+                                            static_cast<float>(th)});
+        }
+    }
+    gridW_ = (width + kMotionStep - 1) / kMotionStep;
+    gridH_ = (height + kMotionStep - 1) / kMotionStep;
+}
+
+void TiledDetectorBackend::sampleLuma(const ImageView& image) {
+    luma_.resize(static_cast<std::size_t>(gridW_) * gridH_);
+    const int stride = image.stride > 0 ? image.stride : image.width * 3;
+    for (int gy = 0; gy < gridH_; ++gy) {
+        const std::uint8_t* row = image.data + static_cast<std::size_t>(gy) * kMotionStep * stride;
+        std::uint8_t* dst = &luma_[static_cast<std::size_t>(gy) * gridW_];
+        for (int gx = 0; gx < gridW_; ++gx) {
+            const std::uint8_t* p = row + static_cast<std::size_t>(gx) * kMotionStep * 3;
+            dst[gx] = static_cast<std::uint8_t>((p[0] + 2 * p[1] + p[2]) >> 2);  // RGB/BGR 对称，无需区分
+        }
+    }
+}
+
+// 切片覆盖的采样点：起点向上取整到网格，保证每个样本都落在切片内
+float TiledDetectorBackend::tileMotion(const Tile& tile) const {
+    const int gx0 = (tile.x + kMotionStep - 1) / kMotionStep;
+    const int gy0 = (tile.y + kMotionStep - 1) / kMotionStep;
+    const int gx1 = std::min(gridW_, (tile.x + tile.w + kMotionStep - 1) / kMotionStep);
+    const int gy1 = std::min(gridH_, (tile.y + tile.h + kMotionStep - 1) / kMotionStep);
+    const std::size_t count = static_cast<std::size_t>(std::max(0, gx1 - gx0)) * std::max(0, gy1 - gy0);
+    if (count == 0 || tile.refLuma.size() != count) return 255.f;
+    std::uint64_t sum = 0;
+    std::size_t k = 0;
+    for (int gy = gy0; gy < gy1; ++gy) {
+        const std::uint8_t* row = &luma_[static_cast<std::size_t>(gy) * gridW_];
+        for (int gx = gx0; gx < gx1; ++gx) {
+            sum += static_cast<std::uint64_t>(std::abs(static_cast<int>(row[gx]) - tile.refLuma[k++]));
+        }
+    }
+    return static_cast<float>(sum) / static_cast<float>(count);
+}
+
+void TiledDetectorBackend::storeReference(Tile& tile) const {
+    const int gx0 = (tile.x + kMotionStep - 1) / kMotionStep;
+    const int gy0 = (tile.y + kMotionStep - 1) / kMotionStep;
+    const int gx1 = std::min(gridW_, (tile.x + tile.w + kMotionStep - 1) / kMotionStep);
+    const int gy1 = std::min(gridH_, (tile.y + tile.h + kMotionStep - 1) / kMotionStep);
+    tile.refLuma.clear();
+    for (int gy = gy0; gy < gy1; ++gy) {
+        const std::uint8_t* row = &luma_[static_cast<std::size_t>(gy) * gridW_];
+        tile.refLuma.insert(tile.refLuma.end(), row + gx0, row + std::max(gx0, gx1));
+    }
+}
+
+// 框贴着切片的内部边界（不是整帧边界）时，目标可能被切片截断
+bool TiledDetectorBackend::touchesInnerEdge(const Tile& tile, const DetectionBBox& box) const {
+    constexpr float kMargin = 2.f;
+    const float x0 = static_cast<float>(tile.x), y0 = static_cast<float>(tile.y);
+    const float x1 = static_cast<float>(tile.x + tile.w), y1 = static_cast<float>(tile.y + tile.h);
+    return (tile.x > 0 && box.x <= x0 + kMargin) || (tile.y > 0 && box.y <= y0 + kMargin) ||
+           (tile.x + tile.w < frameW_ && box.x + box.width >= x1 - kMargin) ||
+           (tile.y + tile.h < frameH_ && box.y + box.height >= y1 - kMargin);
+}
+
+bool TiledDetectorBackend::tileChanged(const Tile& tile) const {
+    for (const auto& r : changedRegions_) {
+        if (intersects(r, tile.x, tile.y, tile.w, tile.h)) return true;
+    }
+    return false;
+}
+
+bool TiledDetectorBackend::tileInRoi(const Tile& tile) const {
+    if (regions_.empty()) return true;
+    for (const auto& r : regions_) {
+        if (intersects(r, tile.x, tile.y, tile.w, tile.h)) return true;
+    }
+    return false;
+}
+
+// 视图分块：每块不超过内层 maxBatchSize()，并尽量让每个推理上下文都分到一块
+bool TiledDetectorBackend::inferViews(std::size_t count) {
+    if (count == 0) return true;
+    const std::size_t contexts = workers_->count();
+    const std::size_t perContext = (count + contexts - 1) / contexts;
+    const std::size_t chunk = std::max<std::size_t>(1, std::min(inner_->maxBatchSize(), perContext));
+    const std::size_t chunks = (count + chunk - 1) / chunk;
+    std::atomic<bool> ok{true};
+    auto runChunks = [&](std::size_t first, std::size_t stepChunks) {
+        for (std::size_t c = first; c < chunks; c += stepChunks) {
+            const std::size_t begin = c * chunk;
+            const std::size_t n = std::min(chunk, count - begin);
+            if (!inner_->runBatch(&views_[begin], &results_[begin], n)) ok = false;
+        }
+    };
+    if (chunks == 1 || contexts == 1) {
+        runChunks(0, 1);
+    } else {
+        workers_->run([&](std::size_t index) { runChunks(index, contexts); });
+    }
+    return ok;
+}
+
+// 切片重叠处同一目标出现多次：同类内按（完整框优先、分数降序）贪心保留，
+// 与已保留框 IoU 超过 nmsThreshold、或大部分落在已保留框内（边缘截断的残框）的被去掉
+void TiledDetectorBackend::merge(std::vector<Detection>& detections, const std::vector<bool>& truncated) const {
+    if (detections.size() < 2) return;
+    std::vector<std::size_t> order(detections.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        const auto& da = detections[a];
+        const auto& db = detections[b];
+        if (da.classId != db.classId) return da.classId < db.classId;
+        if (truncated[a] != truncated[b]) return !truncated[a];
+        if (da.score != db.score) return da.score > db.score;
+        return a < b;
+    });
+    std::vector<Detection> merged;
+    merged.reserve(detections.size());
+    std::size_t classBegin = 0;  // merged 中当前类别的起点
+    for (std::size_t k = 0; k < order.size(); ++k) {
+        Detection& d = detections[order[k]];
+        if (k > 0 && d.classId != detections[order[k - 1]].classId) classBegin = merged.size();
+        const float area = d.bbox.width * d.bbox.height;
+        bool duplicate = false;
+        for (std::size_t m = classBegin; m < merged.size() && !duplicate; ++m) {
+            const auto& kb = merged[m].bbox;
+            const float w = std::min(kb.x + kb.width, d.bbox.x + d.bbox.width) - std::max(kb.x, d.bbox.x);
+            const float h = std::min(kb.y + kb.height, d.bbox.y + d.bbox.height) - std::max(kb.y, d.bbox.y);
+            if (w <= 0.f || h <= 0.f) continue;
+            const float inter = w * h;
+            const float keptArea = kb.width * kb.height;
+            const float smaller = std::min(area, keptArea);
+            duplicate = inter > desc_.nmsThreshold * (area + keptArea - inter) ||
+                        (smaller > 0.f && inter > kContainmentThreshold * smaller);
+        }
+        if (!duplicate) merged.push_back(std::move(d));
+    }
+    std::stable_sort(merged.begin(), merged.end(), [](const Detection& a, const Detection& b) { return a.score > b.score; });
+    if (desc_.maxDetections > 0 && merged.size() > static_cast<std::size_t>(desc_.maxDetections)) {
+        merged.resize(static_cast<std::size_t>(desc_.maxDetections));
+    }
+    detections.swap(merged);
+}
+
+bool TiledDetectorBackend::run(const ImageView& image, DetectionResult& outResult) {
+    if (!isLoaded()) {
+        std::cerr << "[TiledDetectorBackend] run() called before load()" << std::endl;
+        return false;
+    }
+    const core::PixelFormat format =
+        image.format != core::PixelFormat::Any ? image.format : core::parsePixelFormat(image.pixelFormat);
+    if (!image.data || image.width <= 0 || image.height <= 0 ||
+        (format != core::PixelFormat::RGB8 && format != core::PixelFormat::BGR8)) {
+        return inner_->run(image, outResult);
+    }
+    if (image.width != frameW_ || image.height != frameH_) buildLayout(image.width, image.height);
+
+    const bool external = std::exchange(changedRegionsSet_, false);
+    if (external && (shiftX_ != 0.f || shiftY_ != 0.f)) {
+        for (auto& tile : tiles_) {
+            for (auto& d : tile.detections) {
+                d.bbox.x += shiftX_;
+                d.bbox.y += shiftY_;
+            }
+        }
+    }
+    const bool motion = desc_.tileMotionThreshold > 0.f;
+    if (motion) sampleLuma(image);
+    const int stride = image.stride > 0 ? image.stride : image.width * 3;
+
+    views_.clear();
+    tileOf_.clear();
+    lastInferred_ = 0;
+    lastReused_ = 0;
+    for (std::size_t i = 0; i < tiles_.size(); ++i) {
+        Tile& tile = tiles_[i];
+        if (!tileInRoi(tile)) {
+            tile.detections.clear();
+            tile.valid = false;
+            continue;
+        }
+        if (tile.valid && tile.reused < desc_.tileMaxReuse &&
+            ((external && !tileChanged(tile)) || (motion && tileMotion(tile) < desc_.tileMotionThreshold))) {
+            ++tile.reused;
+            ++lastReused_;
+            continue;
+        }
+        ImageView view = image;
+        view.data = image.data + static_cast<std::size_t>(tile.y) * stride + static_cast<std::size_t>(tile.x) * 3;
+        view.width = tile.w;
+        view.height = tile.h;
+        view.stride = stride;
+        view.format = format;
+        view.dmabufFd = -1;  // 子视图不是整块 DMABUF
+        views_.push_back(view);
+        tileOf_.push_back(static_cast<int>(i));
+    }
+    lastInferred_ = views_.size();
+    if (desc_.tileFullFrame && tiles_.size() > 1) {
+        views_.push_back(image);
+        tileOf_.push_back(-1);
+    }
+
+    results_.resize(views_.size());
+    for (auto& r : results_) {
+        r.detections.clear();
+        r.timing = DetectionTiming{};
+    }
+    StageTimer timer(desc_.profiling);
+    const bool ok = inferViews(views_.size());
+    const std::uint32_t inferWallUs = timer.lapUs();
+
+    outResult.frameId.clear();
+    outResult.frameIndex = image.frameIndex;
+    outResult.timestampNs = static_cast<std::uint64_t>(image.captureTimestampNs);
+    outResult.detections.clear();
+    truncated_.clear();
+    for (std::size_t k = 0; k < views_.size(); ++k) {
+        auto& dets = results_[k].detections;
+        if (tileOf_[k] < 0) {
+            outResult.detections.insert(outResult.detections.end(), dets.begin(), dets.end());
+            truncated_.resize(outResult.detections.size(), false);
+            continue;
+        }
+        Tile& tile = tiles_[static_cast<std::size_t>(tileOf_[k])];
+        for (auto& d : dets) {
+            d.bbox.x += static_cast<float>(tile.x);
+            d.bbox.y += static_cast<float>(tile.y);
+        }
+        tile.detections.swap(dets);
+        tile.reused = 0;
+        tile.valid = ok;
+        if (motion) storeReference(tile);
+    }
+    for (const auto& tile : tiles_) {
+        for (const auto& d : tile.detections) {
+            outResult.detections.push_back(d);
+            truncated_.push_back(touchesInnerEdge(tile, d.bbox));
+        }
+    }
+    merge(outResult.detections, truncated_);
+
+    // 各切片的 CPU 阶段累加（跨切片合并计入 nms）；推理取整批切片的墙钟，设备耗时累加、利用率取平均
+    DetectionTiming timing;
+    timing.inferUs = inferWallUs;
+    float utilization = 0.f;
+    int utilizationSamples = 0;
+    for (const auto& r : results_) {
+        timing.preprocessUs += r.timing.preprocessUs;
+        timing.decodeUs += r.timing.decodeUs;
+        timing.nmsUs += r.timing.nmsUs;
+        timing.deviceUs += r.timing.deviceUs;
+        if (r.timing.deviceUtilization >= 0.f) {
+            utilization += r.timing.deviceUtilization;
+            ++utilizationSamples;
+        }
+    }
+    timing.nmsUs += timer.lapUs();
+    if (utilizationSamples > 0) timing.deviceUtilization = utilization / static_cast<float>(utilizationSamples);
+    outResult.timing = timing;
+    return ok;
+}
+
+} // namespace falconmind::sdk::perception
@@ -0,0 +1,326 @@
+#include "falconmind/sdk/perception/Tracker3D.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+// 与 GeoProjector 相同的球面近似
+constexpr double kEarthRadiusM = 6371000.0;
+constexpr double kMetersPerDeg = kPi * kEarthRadiusM / 180.0;
+
+std::uint64_t frameDt(std::uint64_t fromNs, std::uint64_t toNs, std::uint64_t periodNs) {
+    return fromNs > 0 && toNs > fromNs ? toNs - fromNs : periodNs;
+}
+
+} // namespace
+
+Tracker3D::Tracker3D(Tracker3DConfig config) : config_(std::move(config)) {
+    config_.maxGateDistanceM = std::max(config_.maxGateDistanceM, 0.1f);
+    config_.minHits = std::max(config_.minHits, 1);
+    if (config_.framePeriodNs == 0) config_.framePeriodNs = 1;
+}
+
+void Tracker3D::setOrigin(double lat, double lon, double alt) {
+    originLat_ = lat;
+    originLon_ = lon;
+    originAlt_ = alt;
+    metersPerDegLon_ = kMetersPerDeg * std::max(1e-6, std::cos(lat * kPi / 180.0));
+    hasOrigin_ = true;
+}
+
+void Tracker3D::toLocal(double lat, double lon, double alt, double& north, double& east,
+                        double& down) const noexcept {
+    north = (lat - originLat_) * kMetersPerDeg;
+    east = (lon - originLon_) * metersPerDegLon_;
+    down = originAlt_ - alt;
+}
+
+void Tracker3D::toGeo(double north, double east, double down, double& lat, double& lon, double& alt) const noexcept {
+    lat = originLat_ + north / kMetersPerDeg;
+    lon = originLon_ + (metersPerDegLon_ > 0. ? east / metersPerDegLon_ : 0.);
+    alt = originAlt_ - down;
+}
+
+void Tracker3D::reset() {
+    mean_.clear();
+    cov_.clear();
+    meta_.clear();
+    stateNs_ = 0;
+}
+
+std::int64_t Tracker3D::cellKey(float north, float east) const noexcept {
+    const auto cn = static_cast<std::int64_t>(std::floor(north / config_.maxGateDistanceM));
+    const auto ce = static_cast<std::int64_t>(std::floor(east / config_.maxGateDistanceM));
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(cn) << 32) ^
+           static_cast<std::int64_t>(static_cast<std::uint32_t>(ce));
+}
+
+Tracker3D::Mat3 Tracker3D::measurementCovariance(const Detection3D& det) noexcept {
+    const float h = std::max(det.stdHorizontalM, 0.01f);
+    const float v = std::max(det.stdVerticalM, 0.01f);
+    return Mat3::diagonal({h * h, h * h, v * v});
+}
+
+void Tracker3D::predictAll(std::uint64_t timestampNs) {
+    const float dt = static_cast<float>(frameDt(stateNs_, timestampNs, config_.framePeriodNs)) * 1e-9f;
+    stateNs_ = std::max(stateNs_, timestampNs);
+    if (mean_.empty()) return;
+
+    // F = [I dt·I; 0 I]，离散白噪声加速度模型 Q 的三个对角块；全部轨迹共用
+    const float q = config_.accelStd * config_.accelStd;
+    const float qpp = 0.25f * dt * dt * dt * dt * q;
+    const float qpv = 0.5f * dt * dt * dt * q;
+    const float qvv = dt * dt * q;
+    const float dt2 = dt * dt;
+    const std::size_t n = mean_.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        State& x = mean_[i];
+        for (std::size_t k = 0; k < 3; ++k) x[k] += dt * x[k + 3];
+    }
+    // P' = F P F^T + Q 按 3×3 块展开：[A B; B^T C] → [A + dt(B + B^T) + dt²C, B + dtC; B^T + dtC, C]
+    for (std::size_t i = 0; i < n; ++i) {
+        Covariance& p = cov_[i];
+        for (std::size_t r = 0; r < 3; ++r) {
+            for (std::size_t c = 0; c < 3; ++c) {
+                const float a = p(r, c);
+                const float b = p(r, c + 3);
+                const float bt = p(r + 3, c);
+                const float cc = p(r + 3, c + 3);
+                const float diag = r == c ? 1.f : 0.f;
+                p(r, c) = a + dt * (b + bt) + dt2 * cc + diag * qpp;
+                p(r, c + 3) = b + dt * cc + diag * qpv;
+                p(r + 3, c) = bt + dt * cc + diag * qpv;
+                p(r + 3, c + 3) = cc + diag * qvv;
+            }
+        }
+    }
+}
+
+void Tracker3D::gate(const std::vector<Detection3D>& detections) {
+    candidates_.clear();
+    cells_.resize(mean_.size());
+    for (std::size_t i = 0; i < mean_.size(); ++i) {
+        cells_[i] = {cellKey(mean_[i][0], mean_[i][1]), static_cast<int>(i)};
+    }
+    std::sort(cells_.begin(), cells_.end());
+
+    const float maxDistSq = config_.maxGateDistanceM * config_.maxGateDistanceM;
+    for (std::size_t j = 0; j < detections.size(); ++j) {
+        const Detection3D& det = detections[j];
+        const auto dn = static_cast<float>(det.north);
+        const auto de = static_cast<float>(det.east);
+        const Mat3 r = measurementCovariance(det);
+        // 格边长等于水平门限：门限内的轨迹必在 3×3 邻格中
+        for (int on = -1; on <= 1; ++on) {
+            for (int oe = -1; oe <= 1; ++oe) {
+                const std::int64_t key = cellKey(dn + static_cast<float>(on) * config_.maxGateDistanceM,
+                                                 de + static_cast<float>(oe) * config_.maxGateDistanceM);
+                auto it = std::lower_bound(cells_.begin(), cells_.end(), std::make_pair(key, -1));
+                for (; it != cells_.end() && it->first == key; ++it) {
+                    const auto i = static_cast<std::size_t>(it->second);
+                    const TrackMeta& m = meta_[i];
+                    if (config_.matchClass && det.classId >= 0 && m.classId >= 0 && det.classId != m.classId) continue;
+                    const State& x = mean_[i];
+                    core::Vector<float, 3> y;
+                    y[0] = static_cast<float>(det.north) - x[0];
+                    y[1] = static_cast<float>(det.east) - x[1];
+                    y[2] = static_cast<float>(det.down) - x[2];
+                    if (y[0] * y[0] + y[1] * y[1] > maxDistSq) continue;
+                    Mat3 sInv;
+                    if (!core::choleskyInverse(cov_[i].block<3, 3>(0, 0) + r, sInv)) continue;
+                    float d2 = 0.f;
+                    for (std::size_t a = 0; a < 3; ++a)
+                        for (std::size_t b = 0; b < 3; ++b) d2 += y[a] * sInv(a, b) * y[b];
+                    if (!(d2 < config_.gateChi2)) continue;
+                    if (det.sourceTrackId >= 0 && det.sourceTrackId == m.sourceTrackId) d2 *= config_.sameSourceBonus;
+                    candidates_.push_back({static_cast<int>(j), static_cast<int>(i), d2});
+                }
+            }
+        }
+    }
+}
+
+void Tracker3D::update(std::size_t i, const Detection3D& det, std::uint64_t timestampNs) {
+    State& x = mean_[i];
+    Covariance& p = cov_[i];
+    // H = [I 0]：P H^T 为 P 的前三列，S = P 左上块 + R
+    const core::Matrix<float, 6, 3> pht = p.block<6, 3>(0, 0);
+    Mat3 sInv;
+    if (core::choleskyInverse(pht.block<3, 3>(0, 0) + measurementCovariance(det), sInv)) {
+        const core::Matrix<float, 6, 3> k = pht * sInv;
+        core::Vector<float, 3> y;
+        y[0] = static_cast<float>(det.north) - x[0];
+        y[1] = static_cast<float>(det.east) - x[1];
+        y[2] = static_cast<float>(det.down) - x[2];
+        x += k * y;
+        p -= k * pht.transpose();
+        for (std::size_t r = 0; r < 6; ++r) {
+            for (std::size_t c = r + 1; c < 6; ++c) {
+                const float s = 0.5f * (p(r, c) + p(c, r));
+                p(r, c) = s;
+                p(c, r) = s;
+            }
+        }
+    }
+    TrackMeta& m = meta_[i];
+    ++m.hits;
+    m.missedFrames = 0;
+    m.score = det.score;
+    if (det.classId >= 0) m.classId = det.classId;
+    if (!det.className.empty()) m.className = det.className;
+    m.sourceTrackId = det.sourceTrackId;
+    m.bbox = det.bbox;
+    m.lastUpdateNs = timestampNs;
+}
+
+void Tracker3D::initiate(const Detection3D& det, std::uint64_t timestampNs) {
+    State x;
+    x[0] = static_cast<float>(det.north);
+    x[1] = static_cast<float>(det.east);
+    x[2] = static_cast<float>(det.down);
+    const Mat3 r = measurementCovariance(det);
+    const float v = config_.initVelocityStd * config_.initVelocityStd;
+    Covariance p = Covariance::diagonal({r(0, 0), r(1, 1), r(2, 2), v, v, v});
+    mean_.push_back(x);
+    cov_.push_back(p);
+    TrackMeta m;
+    m.trackId = nextTrackId_++;
+    m.classId = det.classId;
+    m.className = det.className;
+    m.score = det.score;
+    m.hits = 1;
+    m.sourceTrackId = det.sourceTrackId;
+    m.bbox = det.bbox;
+    m.lastUpdateNs = timestampNs;
+    meta_.push_back(std::move(m));
+}
+
+void Tracker3D::removeLost() {
+    std::size_t keep = 0;
+    for (std::size_t i = 0; i < meta_.size(); ++i) {
+        const TrackMeta& m = meta_[i];
+        // 已输出 LOST 的轨迹，以及确认前就漏检的轨迹
+        if (m.missedFrames > config_.maxMissedFrames || (m.hits < config_.minHits && m.missedFrames > 0)) continue;
+        if (keep != i) {
+            mean_[keep] = mean_[i];
+            cov_[keep] = cov_[i];
+            meta_[keep] = std::move(meta_[i]);
+        }
+        ++keep;
+    }
+    mean_.resize(keep);
+    cov_.resize(keep);
+    meta_.resize(keep);
+}
+
+void Tracker3D::write(std::size_t i, const char* status, Track3D& out) const {
+    const State& x = mean_[i];
+    const Covariance& p = cov_[i];
+    const TrackMeta& m = meta_[i];
+    out.trackId = m.trackId;
+    out.classId = m.classId;
+    out.className = m.className;
+    out.status = status;
+    out.north = x[0];
+    out.east = x[1];
+    out.down = x[2];
+    out.velNorth = x[3];
+    out.velEast = x[4];
+    out.velDown = x[5];
+    toGeo(out.north, out.east, out.down, out.lat, out.lon, out.alt);
+    out.posStdM = std::sqrt(std::max(0.f, 0.5f * (p(0, 0) + p(1, 1))));
+    out.score = m.score;
+    out.hits = m.hits;
+    out.missedFrames = m.missedFrames;
+    out.sourceTrackId = m.sourceTrackId;
+    out.bbox = m.bbox;
+    out.lastUpdateNs = m.lastUpdateNs;
+}
+
+void Tracker3D::emit(std::uint64_t timestampNs, bool predicted, Tracking3DResult& out) const {
+    out.timestampNs = timestampNs;
+    out.tracks.clear();
+    for (std::size_t i = 0; i < meta_.size(); ++i) {
+        const TrackMeta& m = meta_[i];
+        if (m.hits < config_.minHits) continue;
+        const char* status = m.missedFrames > config_.maxMissedFrames ? "LOST" : predicted ? "PREDICTED" : "ACTIVE";
+        out.tracks.emplace_back();
+        write(i, status, out.tracks.back());
+    }
+}
+
+void Tracker3D::track(std::uint64_t timestampNs, const std::vector<Detection3D>& detections, Tracking3DResult& out) {
+    removeLost();
+    predictAll(timestampNs);
+    gate(detections);
+    const std::size_t tracks = mean_.size();
+    solveSparseAssignment(static_cast<int>(detections.size()), static_cast<int>(tracks), candidates_,
+                          config_.gateChi2, assignment_);
+
+    matched_.assign(tracks, false);
+    for (std::size_t j = 0; j < detections.size(); ++j) {
+        const int i = assignment_[j];
+        if (i < 0) continue;
+        update(static_cast<std::size_t>(i), detections[j], timestampNs);
+        matched_[static_cast<std::size_t>(i)] = true;
+    }
+    for (std::size_t i = 0; i < tracks; ++i) {
+        if (!matched_[i]) ++meta_[i].missedFrames;
+    }
+    for (std::size_t j = 0; j < detections.size(); ++j) {
+        if (assignment_[j] < 0 && detections[j].score >= config_.newTrackScore) initiate(detections[j], timestampNs);
+    }
+    emit(timestampNs, false, out);
+}
+
+void Tracker3D::predict(std::uint64_t timestampNs, Tracking3DResult& out) {
+    removeLost();
+    predictAll(timestampNs);
+    emit(timestampNs, true, out);
+}
+
+void Tracker3D::track(const GeoTrackingResult& geo, Tracking3DResult& out) {
+    geoDetections_.clear();
+    bool predictedFrame = false;
+    for (const auto& g : geo.tracks) {
+        if (g.status == "PREDICTED") predictedFrame = true;
+        if (!g.valid || g.status == "LOST" || g.status == "PREDICTED") continue;
+        if (!hasOrigin_) setOrigin(g.lat, g.lon, g.alt);
+        Detection3D d;
+        toLocal(g.lat, g.lon, g.alt, d.north, d.east, d.down);
+        d.stdHorizontalM = std::max(config_.geoMinStdM, static_cast<float>(g.rangeM) * config_.geoAngularStdRad);
+        d.stdVerticalM = d.stdHorizontalM;
+        d.classId = g.classId;
+        d.className = g.className;
+        d.sourceTrackId = g.trackId;
+        d.bbox = g.bbox;
+        geoDetections_.push_back(std::move(d));
+    }
+    if (predictedFrame && geoDetections_.empty()) {
+        predict(geo.timestampNs, out);
+    } else {
+        track(geo.timestampNs, geoDetections_, out);
+    }
+    out.frameId = geo.frameId;
+    out.frameIndex = geo.frameIndex;
+}
+
+bool Tracker3D::extrapolate(int trackId, std::uint64_t timestampNs, Track3D& out) const {
+    for (std::size_t i = 0; i < meta_.size(); ++i) {
+        if (meta_[i].trackId != trackId) continue;
+        write(i, meta_[i].missedFrames > config_.maxMissedFrames ? "LOST" : "PREDICTED", out);
+        const double dt = timestampNs > stateNs_ ? static_cast<double>(timestampNs - stateNs_) * 1e-9 : 0.;
+        out.north += out.velNorth * dt;
+        out.east += out.velEast * dt;
+        out.down += out.velDown * dt;
+        toGeo(out.north, out.east, out.down, out.lat, out.lon, out.alt);
+        return true;
+    }
+    return false;
+}
+
+} // namespace falconmind::sdk::perception
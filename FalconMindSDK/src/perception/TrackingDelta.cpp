@@ -0,0 +1,153 @@
+#include "falconmind/sdk/perception/TrackingDelta.h"
+
+#include <algorithm>
+
+namespace falconmind::sdk::perception {
+
+namespace {
+
+// 最新轨迹点：优先 history 视图，其次深拷贝的 trajectory
+const TrackHistoryPoint* lastPoint(const TrackingState& t) {
+    if (!t.history.empty()) return &t.history.back();
+    if (!t.trajectory.empty()) return &t.trajectory.back();
+    return nullptr;
+}
+
+TrackingState copyState(const TrackingState& t, bool fullHistory) {
+    TrackingState s;
+    s.trackId = t.trackId;
+    s.targetClassId = t.targetClassId;
+    s.targetClassName = t.targetClassName;
+    s.status = t.status;
+    s.uncertainty = t.uncertainty;
+    if (fullHistory) {
+        s.trajectory = !t.history.empty() ? t.history.toVector() : t.trajectory;
+    } else if (const TrackHistoryPoint* p = lastPoint(t)) {
+        s.trajectory.push_back(*p);
+    }
+    return s;
+}
+
+} // namespace
+
+void TrackingDeltaEncoder::reset() {
+    known_.clear();
+    sinceKeyframe_ = 0;
+    forceKeyframe_ = true;
+}
+
+void TrackingDeltaEncoder::encode(const TrackingResult& snapshot, TrackingDelta& out) {
+    out.frameId = snapshot.frameId;
+    out.timestampNs = snapshot.timestampNs;
+    out.frameIndex = snapshot.frameIndex;
+    out.sequence = ++sequence_;
+    out.added.clear();
+    out.updated.clear();
+    out.removed.clear();
+
+    const bool keyframe = forceKeyframe_ || (keyframeInterval_ > 0 && sinceKeyframe_ + 1 >= keyframeInterval_);
+    out.keyframe = keyframe;
+    if (keyframe) {
+        forceKeyframe_ = false;
+        sinceKeyframe_ = 0;
+    } else {
+        ++sinceKeyframe_;
+    }
+
+    for (const auto& t : snapshot.tracks) {
+        const bool lost = t.status == "LOST";
+        auto it = known_.find(t.trackId);
+        if (lost) {
+            if (it != known_.end()) {
+                known_.erase(it);
+                if (!keyframe) out.removed.push_back(t.trackId);
+            }
+            continue;
+        }
+        const TrackHistoryPoint* p = lastPoint(t);
+        const std::uint64_t pointNs = p ? p->timestampNs : 0;
+        if (keyframe || it == known_.end()) {
+            out.added.push_back(copyState(t, true));
+            Known& k = known_[t.trackId];
+            k.lastPointNs = pointNs;
+            k.status = t.status;
+            k.classId = t.targetClassId;
+            k.seenSequence = sequence_;
+            continue;
+        }
+        Known& k = it->second;
+        k.seenSequence = sequence_;
+        const bool newPoint = p && pointNs != k.lastPointNs;
+        if (newPoint || k.status != t.status || k.classId != t.targetClassId) {
+            TrackingState s = copyState(t, false);
+            if (!newPoint) s.trajectory.clear();
+            out.updated.push_back(std::move(s));
+            k.lastPointNs = pointNs;
+            k.status = t.status;
+            k.classId = t.targetClassId;
+        }
+    }
+
+    // 未出现在快照中的已知轨迹（后端直接删除而未输出 LOST）同样视为移除
+    for (auto it = known_.begin(); it != known_.end();) {
+        if (it->second.seenSequence != sequence_) {
+            if (!keyframe) out.removed.push_back(it->first);
+            it = known_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TrackingDeltaDecoder::appendPoints(TrackingState& dst, const TrackingState& src) {
+    dst.trajectory.insert(dst.trajectory.end(), src.trajectory.begin(), src.trajectory.end());
+    if (dst.trajectory.size() > maxTrajectoryPoints_) {
+        dst.trajectory.erase(dst.trajectory.begin(),
+                             dst.trajectory.end() - static_cast<std::ptrdiff_t>(maxTrajectoryPoints_));
+    }
+}
+
+bool TrackingDeltaDecoder::apply(const TrackingDelta& delta) {
+    if (delta.keyframe) {
+        tracks_.clear();
+        synced_ = true;
+    } else if (!synced_ || delta.sequence != lastSequence_ + 1) {
+        // 丢失增量后本地状态不再可信，等待下一关键帧
+        synced_ = false;
+        lastSequence_ = delta.sequence;
+        return false;
+    }
+    lastSequence_ = delta.sequence;
+
+    for (const auto& t : delta.added) {
+        TrackingState& dst = tracks_[t.trackId];
+        dst = t;
+        dst.history = TrajectoryView();
+        if (dst.trajectory.size() > maxTrajectoryPoints_) {
+            dst.trajectory.erase(dst.trajectory.begin(),
+                                 dst.trajectory.end() - static_cast<std::ptrdiff_t>(maxTrajectoryPoints_));
+        }
+    }
+    for (const auto& t : delta.updated) {
+        TrackingState& dst = tracks_[t.trackId];
+        dst.trackId = t.trackId;
+        dst.targetClassId = t.targetClassId;
+        dst.targetClassName = t.targetClassName;
+        dst.status = t.status;
+        dst.uncertainty = t.uncertainty;
+        appendPoints(dst, t);
+    }
+    for (int id : delta.removed) tracks_.erase(id);
+    return true;
+}
+
+std::vector<TrackingState> TrackingDeltaDecoder::tracks() const {
+    std::vector<TrackingState> out;
+    out.reserve(tracks_.size());
+    for (const auto& kv : tracks_) out.push_back(kv.second);
+    std::sort(out.begin(), out.end(),
+              [](const TrackingState& a, const TrackingState& b) { return a.trackId < b.trackId; });
+    return out;
+}
+
+} // namespace falconmind::sdk::perception
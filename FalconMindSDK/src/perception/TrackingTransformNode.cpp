@@ -1,6 +1,15 @@
 #include "falconmind/sdk/perception/TrackingTransformNode.h"
+#include "falconmind/sdk/core/BootProfiler.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/Trace.h"
+#include "falconmind/sdk/perception/ByteTrackerBackend.h"
+#include "falconmind/sdk/perception/DetectionResultPacket.h"
+#include "falconmind/sdk/perception/SimpleTrackerBackend.h"
+#include "falconmind/sdk/perception/SortTrackerBackend.h"
+#include "falconmind/sdk/telemetry/TelemetryPublisher.h"
 
-#include <iostream>
+#include <chrono>
+#include <stdexcept>
 
 namespace falconmind::sdk::perception {
 
@@ -8,21 +17,84 @@ using namespace falconmind::sdk::core;
 
 TrackingTransformNode::TrackingTransformNode()
     : Node("tracking_transform") {
-    addPad(std::make_shared<Pad>("detection_in", PadType::Sink));
-    addPad(std::make_shared<Pad>("tracking_out", PadType::Source));
+    inPad_ = addPad(std::make_shared<Pad>("detection_in", PadType::Sink));
+    outPad_ = addPad(std::make_shared<Pad>("tracking_out", PadType::Source));
 }
 
-bool TrackingTransformNode::configure(const std::unordered_map<std::string, std::string>& /*params*/) {
-    // 当前未使用配置参数，预留扩展
+bool TrackingTransformNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    auto it = params.find("tracker");
+    if (it != params.end()) {
+        if (it->second == "simple") {
+            backend_ = std::make_shared<SimpleTrackerBackend>();
+        } else if (it->second == "sort") {
+            backend_ = std::make_shared<SortTrackerBackend>();
+        } else if (it->second == "bytetrack") {
+            backend_ = std::make_shared<ByteTrackerBackend>();
+        } else {
+            FM_LOG_ERROR("TrackingTransformNode", "unknown tracker: ", it->second);
+            return false;
+        }
+    }
+    it = params.find("output_mode");
+    if (it != params.end()) {
+        if (it->second == "delta") {
+            deltaOutput_ = true;
+        } else if (it->second == "snapshot") {
+            deltaOutput_ = false;
+        } else {
+            FM_LOG_ERROR("TrackingTransformNode", "output_mode must be snapshot or delta: ", it->second);
+            return false;
+        }
+    }
+    it = params.find("keyframe_interval");
+    if (it != params.end()) {
+        try {
+            const long v = std::stol(it->second);
+            if (v < 0) throw std::invalid_argument("keyframe_interval");
+            deltaEncoder_.setKeyframeInterval(static_cast<std::uint32_t>(v));
+        } catch (const std::exception&) {
+            FM_LOG_ERROR("TrackingTransformNode", "invalid keyframe_interval: ", it->second);
+            return false;
+        }
+    }
+    it = params.find("uav_id");
+    if (it != params.end()) uavId_ = it->second;
+    it = params.find("roi_track_id");
+    if (it != params.end()) {
+        try {
+            roiTrackId_ = std::stoi(it->second);
+        } catch (const std::exception&) {
+            FM_LOG_ERROR("TrackingTransformNode", "invalid roi_track_id: ", it->second);
+            return false;
+        }
+    }
     return true;
 }
 
 bool TrackingTransformNode::start() {
-    std::cout << "[TrackingTransformNode] start";
-    if (backend_) {
-        std::cout << " (backend attached)";
+    if (inPad_) {
+        inPad_->setDataCallback([this](const void* data, size_t size) {
+            DetectionResult result;
+            if (!deserializeDetectionResult(data, size, result)) return;
+            std::lock_guard<std::mutex> lock(inputMutex_);
+            pending_ = std::move(result);
+            hasPending_ = true;
+        });
+    }
+    if (backend_ && !backend_->isLoaded()) {
+        core::BootSpan span("load:tracker:" + id(), "model");
+        if (!backend_->load()) {
+            FM_LOG_ERROR("TrackingTransformNode", "tracker backend load failed");
+            return false;
+        }
     }
-    std::cout << std::endl;
+    restored_ = false;
+    if (backend_ && checkpoint_) {
+        restored_ = checkpoint_->restore([this](core::CheckpointReader& in) { return backend_->restoreState(in); });
+        if (restored_) FM_LOG_INFO("TrackingTransformNode", "tracks restored from checkpoint ", checkpoint_->name());
+    }
+    deltaEncoder_.reset();
+    FM_LOG_INFO("TrackingTransformNode", "start", backend_ ? " (backend attached)" : "");
     return true;
 }
 
@@ -30,30 +102,133 @@ void TrackingTransformNode::process() {
     ++frameCounter_;
 
     if (!backend_) {
-        std::cout << "[TrackingTransformNode] process: no backend, skip (frame "
-                  << frameCounter_ << ")" << std::endl;
+        FM_LOG_DEBUG("TrackingTransformNode", "process: no backend, skip (frame ", frameCounter_, ")");
         return;
     }
 
     DetectionResult dets;
-    dets.frameIndex = frameCounter_;
-    dets.timestampNs = 0;
-    dets.frameId = "demo_frame";
-
-    // 构造一个占位检测，模拟 tracker 输入
-    Detection d;
-    d.bbox = {0.0f, 0.0f, 100.0f, 100.0f};
-    d.score = 0.9f;
-    d.classId = 0;
-    d.className = "demo";
-    dets.detections.push_back(d);
+    bool received = false;
+    {
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        if (hasPending_) {
+            dets = std::move(pending_);
+            hasPending_ = false;
+            received = true;
+        }
+    }
+    if (received) {
+        std::uint64_t over = latencyTracker_.record(static_cast<std::int64_t>(dets.timestampNs));
+        if (over > 0) dets.overLatencyBudget = true;
+        if (over == 1 || (over > 0 && over % 100 == 0)) {
+            FM_LOG_WARN("TrackingTransformNode", "frame ", dets.frameIndex, " exceeds latency budget ",
+                        latencyTracker_.budgetNs() / 1000000, "ms (", over, " frame(s) over budget)");
+        }
+    } else {
+        dets.frameIndex = frameCounter_;
+        dets.timestampNs = 0;
+        dets.frameId = "demo_frame";
+
+        // 构造一个占位检测，模拟 tracker 输入
+        Detection d;
+        d.bbox = {0.0f, 0.0f, 100.0f, 100.0f};
+        d.score = 0.9f;
+        d.classId = 0;
+        d.className = "demo";
+        dets.detections.push_back(d);
+    }
 
     TrackingResult tracks;
-    backend_->run(dets, tracks);
+    if (dets.trackerPredicted) {
+        if (!backend_->predict(dets, tracks)) {
+            // 不支持外推：跳过本帧，保留轨迹状态（不计漏检）
+            if (!warnedNoPredict_) {
+                FM_LOG_WARN("TrackingTransformNode",
+                            "tracker backend does not support predict(), skipping frames without detection");
+                warnedNoPredict_ = true;
+            }
+            return;
+        }
+    } else {
+        FM_TRACE_SCOPE("perception", "tracker.run");
+        backend_->run(dets, tracks);
+    }
+    if (rateController_) rateController_->observeTracks(tracks);
+    if (checkpoint_) {
+        const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch())
+                               .count();
+        checkpoint_->save(nowNs, [this](core::CheckpointWriter& out) { backend_->saveState(out); });
+    }
+    if (geoProjector_ && geoProjector_->project(tracks, lastGeoTracks_) && tracker3d_) {
+        tracker3d_->track(lastGeoTracks_, lastTracks3d_);
+    }
+    if (roiController_) steerRoi(dets, tracks);
+    if (deltaOutput_) {
+        deltaEncoder_.encode(tracks, lastDelta_);
+        auto& publisher = telemetry::TelemetryPublisher::instance();
+        // 空增量同样发布：接收方依赖连续的 sequence 判断是否丢包
+        if (publisher.hasTrackingSubscribers()) {
+            telemetry::TrackingDeltaMessage msg;
+            msg.uavId = uavId_;
+            msg.delta = lastDelta_;
+            publisher.publishTracking(msg);
+        }
+    }
 
-    std::cout << "[TrackingTransformNode] process: frame=" << dets.frameIndex
-              << ", detections=" << dets.detections.size()
-              << ", tracks=" << tracks.tracks.size() << std::endl;
+    FM_LOG_DEBUG("TrackingTransformNode", "process: frame=", dets.frameIndex, ", detections=",
+                 dets.detections.size(), ", tracks=", tracks.tracks.size());
+    if (outPad_) {
+        packetBuffer_.resize(detectionResultPacketV2Size(dets));
+        const size_t written = serializeDetectionResultV2(dets, packetBuffer_.data(), packetBuffer_.size());
+        if (written > 0) outPad_->pushToConnections(packetBuffer_.data(), written);
+    }
+    lastDetections_ = std::move(dets);
+    lastTracks_ = std::move(tracks);
+}
+
+void TrackingTransformNode::steerRoi(const DetectionResult& dets, const TrackingResult& tracks) {
+    // 轨迹最新的两个点：历史视图（SORT / ByteTrack）或深拷贝的 trajectory
+    auto latest = [](const TrackingState& t, TrackHistoryPoint& last, TrackHistoryPoint& prev) {
+        const std::size_t n = !t.history.empty() ? t.history.size() : t.trajectory.size();
+        if (n == 0) return false;
+        auto at = [&t](std::size_t i) { return !t.history.empty() ? t.history[i] : t.trajectory[i]; };
+        last = at(n - 1);
+        prev = n > 1 ? at(n - 2) : last;
+        return true;
+    };
+    const TrackingState* target = nullptr;
+    float bestArea = -1.f;
+    TrackHistoryPoint last, prev;
+    for (const auto& t : tracks.tracks) {
+        TrackHistoryPoint l, p;
+        if (t.status == "LOST" || t.status == "FINISHED" || !latest(t, l, p)) continue;
+        const int wanted = roiTrackId_ >= 0 ? roiTrackId_ : roiFollowId_;
+        const float area = l.bbox.width * l.bbox.height;
+        if (t.trackId == wanted) {
+            target = &t;
+            last = l;
+            prev = p;
+            break;
+        }
+        if (roiTrackId_ < 0 && area > bestArea) {
+            bestArea = area;
+            target = &t;
+            last = l;
+            prev = p;
+        }
+    }
+    if (!target) return;  // 无可跟随目标：窗口由 TrackedRoi 按超时停留 / 回到中心
+    roiFollowId_ = target->trackId;
+
+    float vx = 0.f, vy = 0.f;
+    if (last.timestampNs > prev.timestampNs) {
+        const float dt = static_cast<float>(last.timestampNs - prev.timestampNs) * 1e-9f;
+        vx = (last.bbox.x + last.bbox.width * 0.5f - prev.bbox.x - prev.bbox.width * 0.5f) / dt;
+        vy = (last.bbox.y + last.bbox.height * 0.5f - prev.bbox.y - prev.bbox.height * 0.5f) / dt;
+    }
+    const std::uint64_t stamp = dets.timestampNs != 0 ? dets.timestampNs : last.timestampNs;
+    roiController_->setTarget(last.bbox.x + last.bbox.width * 0.5f, last.bbox.y + last.bbox.height * 0.5f, vx, vy,
+                              static_cast<std::int64_t>(stamp));
 }
 
 } // namespace falconmind::sdk::perception
@@ -1,4 +1,5 @@
 #include "falconmind/sdk/perception/VisualSlamNode.h"
+#include "falconmind/sdk/perception/ShmPoseChannel.h"
 #include "falconmind/sdk/core/Pad.h"
 
 #include <chrono>
@@ -9,27 +10,68 @@ namespace falconmind::sdk::perception {
 using namespace falconmind::sdk::core;
 
 VisualSlamNode::VisualSlamNode() : Node("visual_slam") {
-    addPad(std::make_shared<Pad>("image_in", PadType::Sink));
-    addPad(std::make_shared<Pad>("pose_out", PadType::Source));
+    // video_in 与兼容旧名的 image_in 行为相同：接收方持有上游 BufferRef，仅写入共享内存时拷贝一次
+    auto forward = [this](const BufferRef& buffer) {
+        auto channel = std::atomic_load(&imageChannel_);
+        if (!channel) return;
+        if (channel->write(buffer)) {
+            forwarded_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+    addPad(std::make_shared<Pad>("video_in", PadType::Sink))->setBufferCallback(forward);
+    addPad(std::make_shared<Pad>("image_in", PadType::Sink))->setBufferCallback(forward);
+    outPad_ = addPad(std::make_shared<Pad>("pose_out", PadType::Source));
 }
 
 bool VisualSlamNode::configure(const std::unordered_map<std::string, std::string>& params) {
     auto it = params.find("output_when_no_client");
     if (it != params.end())
         outputWhenNoClient_ = (it->second == "1" || it->second == "true" || it->second == "yes");
+    // image_shm / image_slots / image_slot_size：转发给算法容器的图像通道
+    try {
+        it = params.find("image_shm");
+        if (it != params.end()) imageChannelConfig_.name = it->second;
+        it = params.find("image_slots");
+        if (it != params.end()) imageChannelConfig_.slotCount = static_cast<std::uint32_t>(std::stoul(it->second));
+        it = params.find("image_slot_size");
+        if (it != params.end()) imageChannelConfig_.slotSize = static_cast<std::size_t>(std::stoull(it->second));
+    } catch (const std::exception&) {
+        std::cerr << "[VisualSlamNode] Invalid image channel parameters for " << id() << std::endl;
+        return false;
+    }
+    // pose_shm：算法容器创建的共享内存位姿通道名（ShmPoseWriter），替换已注入的 client
+    it = params.find("pose_shm");
+    if (it != params.end() && !it->second.empty())
+        slamClient_ = std::make_shared<SlamServiceClientFromShm>(it->second);
     return true;
 }
 
 bool VisualSlamNode::start() {
+    if (!imageChannelConfig_.name.empty()) {
+        auto channel = ShmChannel::create(imageChannelConfig_);
+        if (!channel) {
+            std::cerr << "[VisualSlamNode] Failed to create image channel " << imageChannelConfig_.name << std::endl;
+            return false;
+        }
+        std::atomic_store(&imageChannel_, std::move(channel));
+    }
     started_ = true;
     defaultPoseTimestampNs_ = 0;
     std::cout << "[VisualSlamNode] start() output_when_no_client=" << outputWhenNoClient_ << std::endl;
     return true;
 }
 
+void VisualSlamNode::stop() {
+    std::atomic_store(&imageChannel_, std::shared_ptr<ShmChannel>());
+    started_ = false;
+    Node::stop();
+}
+
 void VisualSlamNode::process() {
     if (!started_) return;
-    auto outPad = getPad("pose_out");
+    auto* outPad = outPad_;
     if (!outPad) return;
 
     if (slamClient_ && slamClient_->isAvailable()) {
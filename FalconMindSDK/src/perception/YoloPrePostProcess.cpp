@@ -1,7 +1,20 @@
 #include "falconmind/sdk/perception/YoloPrePostProcess.h"
+#include "falconmind/sdk/sensors/ColorConvert.h"
+#include "falconmind/sdk/core/CpuFeatures.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace falconmind::sdk::perception {
 
@@ -11,17 +24,6 @@ float sigmoid(float x) {
     return 1.0f / (1.0f + std::exp(-x));
 }
 
-float boxIou(float x1, float y1, float w1, float h1, float x2, float y2, float w2, float h2) {
-    float xa = std::max(x1, x2);
-    float ya = std::max(y1, y2);
-    float xb = std::min(x1 + w1, x2 + w2);
-    float yb = std::min(y1 + h1, y2 + h2);
-    float inter = std::max(0.0f, xb - xa) * std::max(0.0f, yb - ya);
-    float a1 = w1 * h1;
-    float a2 = w2 * h2;
-    return (a1 > 0 && a2 > 0) ? (inter / (a1 + a2 - inter)) : 0.0f;
-}
-
 } // namespace
 
 void resizeImageToFloatNchw(
@@ -29,92 +31,1107 @@ void resizeImageToFloatNchw(
     bool bgr,
     float* dst, int dstW, int dstH)
 {
-    const int C = 3;
-    for (int dy = 0; dy < dstH; ++dy) {
-        float sy = (srcH > 1) ? (dy * (srcH - 1) / static_cast<float>(dstH - 1)) : 0;
-        int iy0 = static_cast<int>(std::floor(sy));
-        int iy1 = std::min(iy0 + 1, srcH - 1);
-        float fy = sy - iy0;
-        for (int dx = 0; dx < dstW; ++dx) {
-            float sx = (srcW > 1) ? (dx * (srcW - 1) / static_cast<float>(dstW - 1)) : 0;
-            int ix0 = static_cast<int>(std::floor(sx));
-            int ix1 = std::min(ix0 + 1, srcW - 1);
-            float fx = sx - ix0;
-            for (int c = 0; c < C; ++c) {
-                int ch = bgr ? (2 - c) : c;
-                float v00 = src[iy0 * srcStride + ix0 * C + ch];
-                float v10 = src[iy0 * srcStride + ix1 * C + ch];
-                float v01 = src[iy1 * srcStride + ix0 * C + ch];
-                float v11 = src[iy1 * srcStride + ix1 * C + ch];
-                float v = (1 - fx) * (1 - fy) * v00 + fx * (1 - fy) * v10
-                       + (1 - fx) * fy * v01 + fx * fy * v11;
-                dst[c * (dstH * dstW) + dy * dstW + dx] = v / 255.0f;
+    YoloPreprocessConfig config;
+    config.mode = ResizeMode::Stretch;
+    config.threads = 1;
+    YoloPreprocessor(config).run(src, srcW, srcH, srcStride, bgr, dst, dstW, dstH);
+}
+
+LetterboxTransform computeLetterbox(int srcW, int srcH, int dstW, int dstH, ResizeMode mode) {
+    LetterboxTransform t;
+    if (srcW <= 0 || srcH <= 0 || dstW <= 0 || dstH <= 0) return t;
+    if (mode == ResizeMode::Stretch) {
+        t.scaleX = dstW / static_cast<float>(srcW);
+        t.scaleY = dstH / static_cast<float>(srcH);
+        return t;
+    }
+    const float scale = std::min(dstW / static_cast<float>(srcW), dstH / static_cast<float>(srcH));
+    const int newW = std::clamp(static_cast<int>(std::lround(srcW * scale)), 1, dstW);
+    const int newH = std::clamp(static_cast<int>(std::lround(srcH * scale)), 1, dstH);
+    t.scaleX = newW / static_cast<float>(srcW);
+    t.scaleY = newH / static_cast<float>(srcH);
+    t.padX = static_cast<float>((dstW - newW) / 2);
+    t.padY = static_cast<float>((dstH - newH) / 2);
+    return t;
+}
+
+YoloPreprocessConfig yoloPreprocessConfig(const DetectorDescriptor& desc) {
+    YoloPreprocessConfig config;
+    config.mode = desc.letterbox ? ResizeMode::Letterbox : ResizeMode::Stretch;
+    config.padValue = static_cast<std::uint8_t>(std::clamp(desc.letterboxPadValue, 0, 255));
+    config.threads = desc.preprocessThreads > 0 ? static_cast<std::size_t>(desc.preprocessThreads) : 0;
+    if (!desc.preprocessAccel.empty() && desc.preprocessAccel != "none" &&
+        !sensors::parseImageTransformBackend(desc.preprocessAccel, config.accel)) {
+        std::cerr << "[YoloPreprocessor] unknown preprocess_accel: " << desc.preprocessAccel << std::endl;
+    }
+    return config;
+}
+
+struct YoloPreprocessor::Tables {
+    int srcW{0}, srcH{0}, dstW{0}, dstH{0};
+    ResizeMode mode{ResizeMode::Stretch};
+    LetterboxTransform transform;
+    int x0{0}, x1{0};  // 内容区列 [x0, x1)，其余为填充
+    int y0{0}, y1{0};  // 内容区行 [y0, y1)
+    std::vector<std::int32_t> colOffset0;  // 内容区每列：左右源像素的字节偏移与右侧权重
+    std::vector<std::int32_t> colOffset1;
+    std::vector<float> colWeight;
+    std::vector<std::int32_t> row0;  // 内容区每行：上下源行与下侧权重
+    std::vector<std::int32_t> row1;
+    std::vector<float> rowWeight;
+
+    void build(int sw, int sh, int dw, int dh, ResizeMode m) {
+        srcW = sw; srcH = sh; dstW = dw; dstH = dh; mode = m;
+        transform = computeLetterbox(sw, sh, dw, dh, m);
+        x0 = static_cast<int>(transform.padX);
+        y0 = static_cast<int>(transform.padY);
+        x1 = x0 + static_cast<int>(std::lround(sw * transform.scaleX));
+        y1 = y0 + static_cast<int>(std::lround(sh * transform.scaleY));
+        axis(x1 - x0, sw, 3, colOffset0, colOffset1, colWeight);
+        axis(y1 - y0, sh, 1, row0, row1, rowWeight);
+    }
+
+    // 半像素中心对齐：s = (d + 0.5)·src/dst − 0.5，越界钳制到边缘像素
+    static void axis(int dst, int src, int stride, std::vector<std::int32_t>& i0, std::vector<std::int32_t>& i1,
+                     std::vector<float>& w) {
+        i0.resize(dst);
+        i1.resize(dst);
+        w.resize(dst);
+        const double ratio = src / static_cast<double>(dst);
+        for (int d = 0; d < dst; ++d) {
+            const double sc = std::clamp((d + 0.5) * ratio - 0.5, 0.0, static_cast<double>(src - 1));
+            const int a = static_cast<int>(sc);
+            i0[d] = a * stride;
+            i1[d] = std::min(a + 1, src - 1) * stride;
+            w[d] = static_cast<float>(sc - a);
+        }
+    }
+};
+
+// 每线程的行缓冲：两条已水平插值的源行（平面排列 c·contentW + x）、YUV 源的单行 RGB、非 float NCHW 输出的暂存行
+struct YoloPreprocessor::Scratch {
+    std::vector<float> upper, lower;
+    int upperRow{-1}, lowerRow{-1};
+    std::vector<std::uint8_t> rgbRow;
+    std::vector<float> blended;
+    std::vector<float> staging;
+};
+
+namespace {
+
+using BlendRowFn = void (*)(const float* a, const float* b, float w, float scale, float* out, int n);
+using HalfRowFn = void (*)(const float* in, std::uint16_t* out, int n);
+
+// out = (a + w·(b − a))·scale
+void blendRowScalar(const float* a, const float* b, float w, float scale, float* out, int n) {
+    for (int i = 0; i < n; ++i) out[i] = (a[i] + w * (b[i] - a[i])) * scale;
+}
+
+// IEEE 754 binary32 → binary16，就近舍入到偶数；溢出为 inf，NaN 保持 NaN
+std::uint16_t floatToHalf(float f) {
+    std::uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    const std::uint32_t sign = (x >> 16) & 0x8000u;
+    const std::uint32_t mag = x & 0x7fffffffu;
+    if (mag >= 0x47800000u) return static_cast<std::uint16_t>(sign | (mag > 0x7f800000u ? 0x7e00u : 0x7c00u));
+    if (mag < 0x38800000u) {  // 半精度非规格化数：以 2^-24 为单位取整
+        float v;
+        std::memcpy(&v, &mag, sizeof(v));
+        return static_cast<std::uint16_t>(sign | static_cast<std::uint32_t>(std::lrint(v * 16777216.0f)));
+    }
+    // 指数减去 112（127 − 15），低 13 位就近舍入到偶数
+    return static_cast<std::uint16_t>(sign | ((mag + 0xc8000fffu + ((mag >> 13) & 1u)) >> 13));
+}
+
+void halfRowScalar(const float* in, std::uint16_t* out, int n) {
+    for (int i = 0; i < n; ++i) out[i] = floatToHalf(in[i]);
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FALCONMIND_PREPROCESS_X86 1
+__attribute__((target("avx2,fma"))) void blendRowAvx2(const float* a, const float* b, float w, float scale,
+                                                       float* out, int n) {
+    const __m256 vw = _mm256_set1_ps(w);
+    const __m256 vs = _mm256_set1_ps(scale);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 va = _mm256_loadu_ps(a + i);
+        const __m256 vb = _mm256_loadu_ps(b + i);
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_fmadd_ps(vw, _mm256_sub_ps(vb, va), va), vs));
+    }
+    blendRowScalar(a + i, b + i, w, scale, out + i, n - i);
+}
+
+// 行尾用掩码读写，整行都走同一条 FMA 路径
+__attribute__((target("avx512f,fma"))) void blendRowAvx512(const float* a, const float* b, float w, float scale,
+                                                            float* out, int n) {
+    const __m512 vw = _mm512_set1_ps(w);
+    const __m512 vs = _mm512_set1_ps(scale);
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512 va = _mm512_loadu_ps(a + i);
+        const __m512 vb = _mm512_loadu_ps(b + i);
+        _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_fmadd_ps(vw, _mm512_sub_ps(vb, va), va), vs));
+    }
+    if (i < n) {
+        const __mmask16 m = static_cast<__mmask16>((1u << (n - i)) - 1u);
+        const __m512 va = _mm512_maskz_loadu_ps(m, a + i);
+        const __m512 vb = _mm512_maskz_loadu_ps(m, b + i);
+        _mm512_mask_storeu_ps(out + i, m, _mm512_mul_ps(_mm512_fmadd_ps(vw, _mm512_sub_ps(vb, va), va), vs));
+    }
+}
+
+__attribute__((target("avx,f16c"))) void halfRowF16c(const float* in, std::uint16_t* out, int n) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+    }
+    halfRowScalar(in + i, out + i, n - i);
+}
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FALCONMIND_PREPROCESS_NEON 1
+void blendRowNeon(const float* a, const float* b, float w, float scale, float* out, int n) {
+    const float32x4_t vs = vdupq_n_f32(scale);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t va = vld1q_f32(a + i);
+        const float32x4_t vb = vld1q_f32(b + i);
+        vst1q_f32(out + i, vmulq_f32(vfmaq_n_f32(va, vsubq_f32(vb, va), w), vs));
+    }
+    blendRowScalar(a + i, b + i, w, scale, out + i, n - i);
+}
+
+void halfRowNeon(const float* in, std::uint16_t* out, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) vst1_u16(out + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(in + i))));
+    halfRowScalar(in + i, out + i, n - i);
+}
+#endif
+
+struct Kernels {
+    BlendRowFn blend;
+    HalfRowFn half;
+    const char* name;
+};
+
+Kernels selectKernels() {
+#if defined(FALCONMIND_PREPROCESS_NEON)
+    return {blendRowNeon, halfRowNeon, "neon"};
+#else
+    Kernels k{blendRowScalar, halfRowScalar, "scalar"};
+#if defined(FALCONMIND_PREPROCESS_X86)
+    const core::CpuFeatures& cpu = core::cpuFeatures();
+    if (cpu.supports(core::CpuIsa::Avx512)) {
+        k.blend = blendRowAvx512;
+        k.name = "avx512";
+    } else if (cpu.avx2 && cpu.fma) {
+        k.blend = blendRowAvx2;
+        k.name = "avx2";
+    }
+    if (cpu.avx && cpu.f16c) k.half = halfRowF16c;
+#endif
+    return k;
+#endif
+}
+
+const Kernels& kernels() {
+    static const Kernels k = selectKernels();
+    return k;
+}
+
+// 源行水平插值到 R/G/B 三个平面；源通道顺序为模板参数（RGB8 / BGR8），通道下标均为常量
+template <core::PixelFormat F>
+void horizontalRow(const std::uint8_t* row, const std::int32_t* off0, const std::int32_t* off1, const float* w,
+                   float* out, int n) {
+    using T = core::PixelFormatTraits<F>;
+    static_assert(T::rgbLike, "horizontalRow expects a packed RGB source");
+    float* r = out;
+    float* g = out + n;
+    float* b = out + 2 * n;
+    for (int x = 0; x < n; ++x) {
+        const std::uint8_t* p = row + off0[x];
+        const std::uint8_t* q = row + off1[x];
+        const float k = w[x];
+        r[x] = p[T::rIndex] + k * (q[T::rIndex] - p[T::rIndex]);
+        g[x] = p[1] + k * (q[1] - p[1]);
+        b[x] = p[T::bIndex] + k * (q[T::bIndex] - p[T::bIndex]);
+    }
+}
+
+// 取一条源行并水平插值；YUV 源先经 ColorConvert 转为 rgbRow 中的 RGB8
+struct SourceRowArgs {
+    const std::uint8_t* data;
+    int stride;
+    int height;
+    int width;
+    const std::int32_t* off0;
+    const std::int32_t* off1;
+    const float* weight;
+    std::uint8_t* rgbRow;
+    int n;
+};
+
+using SourceRowFn = void (*)(const SourceRowArgs& a, int r, float* out);
+
+template <core::PixelFormat F>
+void sourceRow(const SourceRowArgs& a, int r, float* out) {
+    const std::uint8_t* row = a.data + static_cast<std::size_t>(r) * a.stride;
+    if constexpr (F == core::PixelFormat::NV12) {
+        const std::uint8_t* uv = a.data + static_cast<std::size_t>(a.stride) * a.height +
+                                 static_cast<std::size_t>(r / 2) * a.stride;
+        sensors::convertNv12RowToRgb(row, uv, a.rgbRow, a.width, false);
+        horizontalRow<core::PixelFormat::RGB8>(a.rgbRow, a.off0, a.off1, a.weight, out, a.n);
+    } else if constexpr (F == core::PixelFormat::YUYV) {
+        sensors::convertYuyvRowToRgb(row, a.rgbRow, a.width, false);
+        horizontalRow<core::PixelFormat::RGB8>(a.rgbRow, a.off0, a.off1, a.weight, out, a.n);
+    } else {
+        horizontalRow<F>(row, a.off0, a.off1, a.weight, out, a.n);
+    }
+}
+
+// 每帧按源格式选择一次实例（调用方已用 supportsPixelFormat 过滤）
+SourceRowFn sourceRowFor(core::PixelFormat format) {
+    switch (format) {
+        case core::PixelFormat::BGR8: return sourceRow<core::PixelFormat::BGR8>;
+        case core::PixelFormat::NV12: return sourceRow<core::PixelFormat::NV12>;
+        case core::PixelFormat::YUYV: return sourceRow<core::PixelFormat::YUYV>;
+        default: return sourceRow<core::PixelFormat::RGB8>;
+    }
+}
+
+std::size_t elementBytes(TensorElementType type) {
+    switch (type) {
+        case TensorElementType::Float16: return 2;
+        case TensorElementType::Uint8: return 1;
+        case TensorElementType::Float32: break;
+    }
+    return 4;
+}
+
+// 连续 n 个已缩放的 float 写为目标元素类型
+void storeElements(const float* in, std::uint8_t* out, int n, TensorElementType type) {
+    switch (type) {
+        case TensorElementType::Float32:
+            std::memcpy(out, in, static_cast<std::size_t>(n) * sizeof(float));
+            break;
+        case TensorElementType::Float16:
+            kernels().half(in, reinterpret_cast<std::uint16_t*>(out), n);
+            break;
+        case TensorElementType::Uint8:
+            // 输入为插值后的 [0,255]，+0.5 截断即四舍五入
+            for (int i = 0; i < n; ++i) out[i] = static_cast<std::uint8_t>(std::min(in[i] + 0.5f, 255.0f));
+            break;
+    }
+}
+
+// 填充值按元素类型编码后重复写 n 个
+void fillElements(std::uint8_t* out, int n, TensorElementType type, std::uint8_t padValue) {
+    switch (type) {
+        case TensorElementType::Float32:
+            std::fill_n(reinterpret_cast<float*>(out), n, padValue / 255.0f);
+            break;
+        case TensorElementType::Float16:
+            std::fill_n(reinterpret_cast<std::uint16_t*>(out), n, floatToHalf(padValue / 255.0f));
+            break;
+        case TensorElementType::Uint8:
+            std::memset(out, padValue, static_cast<std::size_t>(n));
+            break;
+    }
+}
+
+// 小于该输出像素数时单线程执行，唤醒线程的开销超过收益
+constexpr int kParallelMinPixels = 160 * 160;
+
+} // namespace
+
+std::size_t inputTensorBytes(const InputTensorSpec& spec) noexcept {
+    if (spec.width <= 0 || spec.height <= 0) return 0;
+    return static_cast<std::size_t>(spec.width) * spec.height * 3 * elementBytes(spec.type);
+}
+
+std::array<std::uint8_t, 256> inputQuantTable(float mean, float stdDev, float scale, int zeroPoint, bool int8Out) {
+    std::array<std::uint8_t, 256> table{};
+    const int lo = int8Out ? -128 : 0;
+    const int hi = int8Out ? 127 : 255;
+    for (int p = 0; p < 256; ++p) {
+        const double real = (p - static_cast<double>(mean)) / stdDev;
+        const long q = scale > 0.f ? std::lround(real / scale) + zeroPoint : zeroPoint;
+        table[p] = static_cast<std::uint8_t>(std::clamp<long>(q, lo, hi));
+    }
+    return table;
+}
+
+void applyByteTable(const std::array<std::uint8_t, 256>& table, std::uint8_t* data, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) data[i] = table[data[i]];
+}
+
+YoloPreprocessor::YoloPreprocessor(const YoloPreprocessConfig& config)
+    : config_(config), tables_(std::make_unique<Tables>()),
+      workers_(std::make_unique<core::WorkerGroup>(config.threads > 0 ? config.threads
+                                                                        : core::WorkerGroup::defaultCount())) {
+    for (std::size_t i = 0; i < workers_->count(); ++i) scratch_.push_back(std::make_unique<Scratch>());
+    if (config_.accel != sensors::ImageTransformBackendType::Cpu) {
+        accel_ = sensors::createImageTransform(config_.accel);
+        // Auto 无硬件时得到 CPU 实现：软件路径本身已是单趟缩放，不再经过中间图
+        if (accel_ && accel_->type() == sensors::ImageTransformBackendType::Cpu) accel_.reset();
+        if (!accel_) {
+            std::cerr << "[YoloPreprocessor] preprocess accelerator " << sensors::imageTransformBackendName(config_.accel)
+                      << " unavailable, using software path" << std::endl;
+        }
+    }
+}
+
+YoloPreprocessor::~YoloPreprocessor() = default;
+
+std::size_t YoloPreprocessor::threads() const noexcept { return workers_->count(); }
+
+const char* YoloPreprocessor::kernelName() noexcept { return kernels().name; }
+
+sensors::ImageTransformBackendType YoloPreprocessor::accelerator() const noexcept {
+    return accel_ ? accel_->type() : sensors::ImageTransformBackendType::Cpu;
+}
+
+std::vector<core::PixelFormat> YoloPreprocessor::pixelFormats() {
+    return {core::PixelFormat::NV12, core::PixelFormat::YUYV, core::PixelFormat::RGB8, core::PixelFormat::BGR8};
+}
+
+bool YoloPreprocessor::supportsPixelFormat(core::PixelFormat format) noexcept {
+    return format == core::PixelFormat::RGB8 || format == core::PixelFormat::BGR8 ||
+           format == core::PixelFormat::NV12 || format == core::PixelFormat::YUYV;
+}
+
+void YoloPreprocessor::runRows(const Source& src, const InputTensorSpec& spec, std::uint8_t* dst, int dy0, int dy1,
+                               Scratch& scratch) {
+    const Tables& t = *tables_;
+    const std::size_t elem = elementBytes(spec.type);
+    const std::size_t plane = static_cast<std::size_t>(t.dstW) * t.dstH;
+    const bool nhwc = spec.layout == TensorLayout::NHWC;
+    const int contentW = t.x1 - t.x0;
+    // float NCHW 由纵向内核直接写入张量；其余组合先写暂存行再按布局/类型落盘
+    const bool direct = spec.type == TensorElementType::Float32 && !nhwc;
+    const float scale = spec.type == TensorElementType::Uint8 ? 1.0f : 1.0f / 255.0f;
+    const bool yuv = src.format == core::PixelFormat::NV12 || src.format == core::PixelFormat::YUYV;
+    const BlendRowFn blend = kernels().blend;
+    scratch.upper.resize(static_cast<std::size_t>(contentW) * 3);
+    scratch.lower.resize(static_cast<std::size_t>(contentW) * 3);
+    scratch.upperRow = scratch.lowerRow = -1;
+    if (yuv) scratch.rgbRow.resize(static_cast<std::size_t>(t.srcW) * 3);
+    if (!direct) scratch.blended.resize(static_cast<std::size_t>(contentW) * 3);
+    if (nhwc) scratch.staging.resize(static_cast<std::size_t>(contentW) * 3);
+
+    const SourceRowFn readRow = sourceRowFor(src.format);
+    const SourceRowArgs rowArgs{src.data, src.stride, src.height, t.srcW, t.colOffset0.data(), t.colOffset1.data(),
+                                t.colWeight.data(), scratch.rgbRow.data(), contentW};
+
+    for (int dy = dy0; dy < dy1; ++dy) {
+        const std::size_t rowElems = static_cast<std::size_t>(dy) * t.dstW;
+        std::uint8_t* rows[3];
+        for (int c = 0; c < 3; ++c) rows[c] = dst + (c * plane + rowElems) * elem;
+        std::uint8_t* packed = dst + rowElems * 3 * elem;
+        if (dy < t.y0 || dy >= t.y1) {
+            if (nhwc) {
+                fillElements(packed, t.dstW * 3, spec.type, config_.padValue);
+            } else {
+                for (int c = 0; c < 3; ++c) fillElements(rows[c], t.dstW, spec.type, config_.padValue);
             }
+            continue;
+        }
+        const int k = dy - t.y0;
+        const int r0 = t.row0[k];
+        const int r1 = t.row1[k];
+        // 下采样或放大时相邻输出行常共用源行：已插值的行直接复用
+        if (scratch.upperRow != r0) {
+            if (scratch.lowerRow == r0) {
+                scratch.upper.swap(scratch.lower);
+                std::swap(scratch.upperRow, scratch.lowerRow);
+            } else {
+                readRow(rowArgs, r0, scratch.upper.data());
+                scratch.upperRow = r0;
+            }
+        }
+        if (scratch.lowerRow != r1) {
+            if (r1 == r0) {
+                scratch.lower = scratch.upper;
+            } else {
+                readRow(rowArgs, r1, scratch.lower.data());
+            }
+            scratch.lowerRow = r1;
+        }
+        for (int c = 0; c < 3; ++c) {
+            float* out = direct ? reinterpret_cast<float*>(rows[c]) + t.x0 : scratch.blended.data() + c * contentW;
+            blend(scratch.upper.data() + c * contentW, scratch.lower.data() + c * contentW, t.rowWeight[k], scale,
+                  out, contentW);
+        }
+        if (nhwc) {
+            float* inter = scratch.staging.data();
+            const float* planes = scratch.blended.data();
+            for (int x = 0; x < contentW; ++x) {
+                inter[3 * x + 0] = planes[x];
+                inter[3 * x + 1] = planes[contentW + x];
+                inter[3 * x + 2] = planes[2 * contentW + x];
+            }
+            fillElements(packed, t.x0 * 3, spec.type, config_.padValue);
+            storeElements(inter, packed + static_cast<std::size_t>(t.x0) * 3 * elem, contentW * 3, spec.type);
+            fillElements(packed + static_cast<std::size_t>(t.x1) * 3 * elem, (t.dstW - t.x1) * 3, spec.type,
+                         config_.padValue);
+            continue;
+        }
+        for (int c = 0; c < 3; ++c) {
+            fillElements(rows[c], t.x0, spec.type, config_.padValue);
+            if (!direct) {
+                storeElements(scratch.blended.data() + c * contentW, rows[c] + t.x0 * elem, contentW, spec.type);
+            }
+            fillElements(rows[c] + t.x1 * elem, t.dstW - t.x1, spec.type, config_.padValue);
         }
     }
 }
 
-void decodeYoloOutput84xN(
-    const float* outputData,
-    std::size_t numChannels, std::size_t numBoxes,
-    int numClasses, float scoreThr,
-    std::vector<YoloRawDet>& out)
-{
-    out.clear();
-    out.reserve(256);
-    if (numChannels < 4u + static_cast<std::size_t>(numClasses) || numBoxes == 0)
+LetterboxTransform YoloPreprocessor::runTensor(const Source& src, int srcW, const InputTensorSpec& spec,
+                                               std::uint8_t* dst) {
+    const int dstW = spec.width;
+    const int dstH = spec.height;
+    Tables& t = *tables_;
+    if (t.srcW != srcW || t.srcH != src.height || t.dstW != dstW || t.dstH != dstH || t.mode != config_.mode) {
+        t.build(srcW, src.height, dstW, dstH, config_.mode);
+    }
+    const std::size_t n = workers_->count();
+    if (n == 1 || dstW * dstH < kParallelMinPixels) {
+        runRows(src, spec, dst, 0, dstH, *scratch_[0]);
+        return t.transform;
+    }
+    const int chunk = static_cast<int>((dstH + n - 1) / n);
+    workers_->run([&](std::size_t i) {
+        const int begin = static_cast<int>(i) * chunk;
+        const int end = std::min(dstH, begin + chunk);
+        if (begin < end) runRows(src, spec, dst, begin, end, *scratch_[i]);
+    });
+    return t.transform;
+}
+
+LetterboxTransform YoloPreprocessor::run(const std::uint8_t* src, int srcW, int srcH, int srcStride, bool bgr,
+                                         float* dst, int dstW, int dstH) {
+    if (!src || !dst || srcW <= 0 || srcH <= 0 || dstW <= 0 || dstH <= 0) return LetterboxTransform{};
+    Source source;
+    source.data = src;
+    source.stride = srcStride;
+    source.height = srcH;
+    source.format = bgr ? core::PixelFormat::BGR8 : core::PixelFormat::RGB8;
+    InputTensorSpec spec;
+    spec.width = dstW;
+    spec.height = dstH;
+    return runTensor(source, srcW, spec, reinterpret_cast<std::uint8_t*>(dst));
+}
+
+bool YoloPreprocessor::run(const ImageView& image, const InputTensorSpec& spec, void* dst,
+                           LetterboxTransform& transform) {
+    Source source;
+    source.format = image.format != core::PixelFormat::Any ? image.format : core::parsePixelFormat(image.pixelFormat);
+    if (!supportsPixelFormat(source.format) || !image.data || !dst || image.width <= 0 || image.height <= 0 ||
+        spec.width <= 0 || spec.height <= 0) {
+        return false;
+    }
+    source.data = image.data;
+    source.height = image.height;
+    source.stride = image.stride > 0 ? image.stride : core::pixelFormatMinStride(source.format, image.width);
+
+    // 硬件缩放到内容区尺寸（只在缩小时有意义），软件路径在其输出上做 1:1 的归一化与填充
+    if (accel_ && accel_->supports(source.format, core::PixelFormat::RGB8, sensors::ImageRotation::None)) {
+        const LetterboxTransform full = computeLetterbox(image.width, image.height, spec.width, spec.height, config_.mode);
+        const int newW = config_.mode == ResizeMode::Stretch ? spec.width
+                                                             : static_cast<int>(std::lround(image.width * full.scaleX));
+        const int newH = config_.mode == ResizeMode::Stretch ? spec.height
+                                                             : static_cast<int>(std::lround(image.height * full.scaleY));
+        if (newW < image.width && newH < image.height) {
+            accelImage_.resize(static_cast<std::size_t>(newW) * newH * 3);
+            sensors::ImageSurface in;
+            in.data = image.data;
+            in.width = image.width;
+            in.height = image.height;
+            in.stride = source.stride;
+            in.format = source.format;
+            in.dmabufFd = image.dmabufFd;
+            sensors::WritableImageSurface out;
+            out.data = accelImage_.data();
+            out.width = newW;
+            out.height = newH;
+            out.stride = newW * 3;
+            out.format = core::PixelFormat::RGB8;
+            if (accel_->transform(in, sensors::ImageTransformOp{}, out)) {
+                Source scaled;
+                scaled.data = accelImage_.data();
+                scaled.stride = out.stride;
+                scaled.height = newH;
+                scaled.format = core::PixelFormat::RGB8;
+                transform = runTensor(scaled, newW, spec, static_cast<std::uint8_t*>(dst));
+                transform.scaleX *= newW / static_cast<float>(image.width);
+                transform.scaleY *= newH / static_cast<float>(image.height);
+                return true;
+            }
+        }
+    }
+    transform = runTensor(source, image.width, spec, static_cast<std::uint8_t*>(dst));
+    return true;
+}
+
+namespace {
+
+constexpr std::size_t kDecodeBlock = 16;  // 每块框数：通道优先布局下每个类别行读 64 字节（一条缓存行）
+
+// 类别最大值：cls 指向本块第一个框的第 0 类，相邻类别行相隔 stride；n ≤ kDecodeBlock
+using ClassMaxFn = void (*)(const float* cls, std::size_t stride, int numClasses, std::size_t n, float* best,
+                            std::int32_t* index);
+
+void classMaxScalar(const float* cls, std::size_t stride, int numClasses, std::size_t n, float* best,
+                    std::int32_t* index) {
+    for (std::size_t k = 0; k < n; ++k) {
+        best[k] = cls[k];
+        index[k] = 0;
+    }
+    for (int c = 1; c < numClasses; ++c) {
+        const float* row = cls + static_cast<std::size_t>(c) * stride;
+        for (std::size_t k = 0; k < n; ++k) {
+            if (row[k] > best[k]) {
+                best[k] = row[k];
+                index[k] = c;
+            }
+        }
+    }
+}
+
+#if defined(FALCONMIND_PREPROCESS_X86)
+__attribute__((target("avx2"))) void classMaxAvx2(const float* cls, std::size_t stride, int numClasses, std::size_t n,
+                                                   float* best, std::int32_t* index) {
+    if (n != kDecodeBlock) {
+        classMaxScalar(cls, stride, numClasses, n, best, index);
         return;
-    for (std::size_t j = 0; j < numBoxes; ++j) {
-        float cx = outputData[0 * numBoxes + j];
-        float cy = outputData[1 * numBoxes + j];
-        float w = outputData[2 * numBoxes + j];
-        float h = outputData[3 * numBoxes + j];
-        int bestClass = 0;
-        float bestScore = 0;
-        for (int c = 0; c < numClasses; ++c) {
-            float s = sigmoid(outputData[(4 + c) * numBoxes + j]);
-            if (s > bestScore) {
-                bestScore = s;
-                bestClass = c;
+    }
+    __m256 b0 = _mm256_loadu_ps(cls);
+    __m256 b1 = _mm256_loadu_ps(cls + 8);
+    __m256i i0 = _mm256_setzero_si256();
+    __m256i i1 = _mm256_setzero_si256();
+    for (int c = 1; c < numClasses; ++c) {
+        const float* row = cls + static_cast<std::size_t>(c) * stride;
+        const __m256 v0 = _mm256_loadu_ps(row);
+        const __m256 v1 = _mm256_loadu_ps(row + 8);
+        const __m256 m0 = _mm256_cmp_ps(v0, b0, _CMP_GT_OQ);
+        const __m256 m1 = _mm256_cmp_ps(v1, b1, _CMP_GT_OQ);
+        const __m256i vc = _mm256_set1_epi32(c);
+        b0 = _mm256_blendv_ps(b0, v0, m0);
+        b1 = _mm256_blendv_ps(b1, v1, m1);
+        i0 = _mm256_blendv_epi8(i0, vc, _mm256_castps_si256(m0));
+        i1 = _mm256_blendv_epi8(i1, vc, _mm256_castps_si256(m1));
+    }
+    _mm256_storeu_ps(best, b0);
+    _mm256_storeu_ps(best + 8, b1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(index), i0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(index + 8), i1);
+}
+#endif
+
+#if defined(FALCONMIND_PREPROCESS_NEON)
+void classMaxNeon(const float* cls, std::size_t stride, int numClasses, std::size_t n, float* best,
+                  std::int32_t* index) {
+    if (n != kDecodeBlock) {
+        classMaxScalar(cls, stride, numClasses, n, best, index);
+        return;
+    }
+    float32x4_t b[4];
+    int32x4_t idx[4];
+    for (int q = 0; q < 4; ++q) {
+        b[q] = vld1q_f32(cls + 4 * q);
+        idx[q] = vdupq_n_s32(0);
+    }
+    for (int c = 1; c < numClasses; ++c) {
+        const float* row = cls + static_cast<std::size_t>(c) * stride;
+        const int32x4_t vc = vdupq_n_s32(c);
+        for (int q = 0; q < 4; ++q) {
+            const float32x4_t v = vld1q_f32(row + 4 * q);
+            const uint32x4_t m = vcgtq_f32(v, b[q]);
+            b[q] = vbslq_f32(m, v, b[q]);
+            idx[q] = vbslq_s32(m, vc, idx[q]);
+        }
+    }
+    for (int q = 0; q < 4; ++q) {
+        vst1q_f32(best + 4 * q, b[q]);
+        vst1q_s32(index + 4 * q, idx[q]);
+    }
+}
+#endif
+
+// 只比较类别掩码列出的 count 个类别行（ids 升序），其余类别行不读取
+void classMaxSelected(const float* cls, std::size_t stride, const int* ids, std::size_t count, std::size_t n,
+                      float* best, std::int32_t* index) {
+    const float* first = cls + static_cast<std::size_t>(ids[0]) * stride;
+    for (std::size_t k = 0; k < n; ++k) {
+        best[k] = first[k];
+        index[k] = ids[0];
+    }
+    for (std::size_t c = 1; c < count; ++c) {
+        const float* row = cls + static_cast<std::size_t>(ids[c]) * stride;
+        for (std::size_t k = 0; k < n; ++k) {
+            if (row[k] > best[k]) {
+                best[k] = row[k];
+                index[k] = ids[c];
+            }
+        }
+    }
+}
+
+// 类别掩码中小于 numClasses 的个数（classes 升序，超出范围的 ID 忽略）
+std::size_t selectedClassCount(const std::vector<int>& classes, int numClasses) {
+    return static_cast<std::size_t>(std::lower_bound(classes.begin(), classes.end(), numClasses) - classes.begin());
+}
+
+ClassMaxFn selectClassMax() {
+#if defined(FALCONMIND_PREPROCESS_NEON)
+    return classMaxNeon;
+#else
+#if defined(FALCONMIND_PREPROCESS_X86)
+    if (core::cpuFeatures().avx2) return classMaxAvx2;
+#endif
+    return classMaxScalar;
+#endif
+}
+
+ClassMaxFn classMax() {
+    static const ClassMaxFn fn = selectClassMax();
+    return fn;
+}
+
+// 与分数阈值等价的原始值阈值：logits 时为 σ⁻¹(thr)，σ 单调，故 σ(x) ≥ thr ⇔ x ≥ σ⁻¹(thr)
+float rawThreshold(float thr, bool logits) {
+    if (!logits) return thr;
+    if (thr <= 0.f) return -std::numeric_limits<float>::infinity();
+    if (thr >= 1.f) return std::numeric_limits<float>::infinity();
+    return std::log(thr / (1.f - thr));
+}
+
+float activate(float x, bool logits) {
+    return logits ? sigmoid(x) : x;
+}
+
+// 通道优先布局下逐块解码：obj 为空表示无 objectness；classes 为类别掩码（代替 cfg.classes，空为全部类别）；
+// emit(j, score, classId) 输出通过阈值的框
+template <typename Emit>
+void decodeChannelMajor(const float* obj, const float* cls, std::size_t numBoxes, const YoloDecodeConfig& cfg,
+                        const std::vector<int>& classes, Emit&& emit) {
+    const float rawThr = rawThreshold(cfg.scoreThreshold, cfg.logits);
+    const ClassMaxFn maxFn = classMax();
+    const std::size_t selected = selectedClassCount(classes, cfg.numClasses);
+    if (!classes.empty() && selected == 0) return;  // 关注的类别都不在模型输出中
+    float best[kDecodeBlock];
+    std::int32_t index[kDecodeBlock];
+    for (std::size_t j = 0; j < numBoxes; j += kDecodeBlock) {
+        const std::size_t n = std::min(kDecodeBlock, numBoxes - j);
+        if (obj) {
+            // score = obj × cls ≤ obj：整块 objectness 都不过阈值时不读类别通道
+            bool any = false;
+            for (std::size_t k = 0; k < n; ++k) any |= obj[j + k] >= rawThr;
+            if (!any) continue;
+        }
+        if (selected > 0) {
+            classMaxSelected(cls + j, numBoxes, classes.data(), selected, n, best, index);
+        } else {
+            maxFn(cls + j, numBoxes, cfg.numClasses, n, best, index);
+        }
+        for (std::size_t k = 0; k < n; ++k) {
+            if (!(best[k] >= rawThr)) continue;
+            float score = activate(best[k], cfg.logits);
+            if (obj) {
+                if (!(obj[j + k] >= rawThr)) continue;
+                score *= activate(obj[j + k], cfg.logits);
             }
+            if (score < cfg.scoreThreshold) continue;
+            emit(j + k, score, index[k]);
         }
-        if (bestScore < scoreThr) continue;
+    }
+}
+
+// decodeYoloOutput 的实现：classes 代替 cfg.classes（每帧调用时不复制类别掩码）
+void decodeAnchorFree(const float* outputData, std::size_t numChannels, std::size_t numBoxes,
+                      const YoloDecodeConfig& cfg, const std::vector<int>& classes, std::vector<YoloRawDet>& out) {
+    const std::size_t clsOffset = cfg.objectness ? 5 : 4;
+    if (!outputData || cfg.numClasses <= 0 || numBoxes == 0 ||
+        numChannels < clsOffset + static_cast<std::size_t>(cfg.numClasses)) {
+        return;
+    }
+    auto push = [&out](float cx, float cy, float w, float h, float score, int classId) {
         YoloRawDet d;
         d.x = cx - w / 2;
         d.y = cy - h / 2;
         d.w = w;
         d.h = h;
-        d.score = bestScore;
-        d.classId = bestClass;
+        d.score = score;
+        d.classId = classId;
         out.push_back(d);
+    };
+
+    if (!cfg.boxMajor) {
+        const float* obj = cfg.objectness ? outputData + 4 * numBoxes : nullptr;
+        decodeChannelMajor(obj, outputData + clsOffset * numBoxes, numBoxes, cfg, classes,
+                           [&](std::size_t j, float score, int classId) {
+                               push(outputData[j], outputData[numBoxes + j], outputData[2 * numBoxes + j],
+                                    outputData[3 * numBoxes + j], score, classId);
+                           });
+        return;
+    }
+
+    // 框优先：每框一行连续存放，先看 objectness 再扫类别（有类别掩码时只看列出的类别）
+    const float rawThr = rawThreshold(cfg.scoreThreshold, cfg.logits);
+    const std::size_t selected = selectedClassCount(classes, cfg.numClasses);
+    if (!classes.empty() && selected == 0) return;
+    for (std::size_t j = 0; j < numBoxes; ++j) {
+        const float* row = outputData + j * numChannels;
+        if (cfg.objectness && !(row[4] >= rawThr)) continue;
+        const float* cls = row + clsOffset;
+        int bestClass = selected > 0 ? classes[0] : 0;
+        float best = cls[bestClass];
+        if (selected > 0) {
+            for (std::size_t c = 1; c < selected; ++c) {
+                if (cls[classes[c]] > best) {
+                    best = cls[classes[c]];
+                    bestClass = classes[c];
+                }
+            }
+        } else {
+            for (int c = 1; c < cfg.numClasses; ++c) {
+                if (cls[c] > best) {
+                    best = cls[c];
+                    bestClass = c;
+                }
+            }
+        }
+        if (!(best >= rawThr)) continue;
+        float score = activate(best, cfg.logits);
+        if (cfg.objectness) score *= activate(row[4], cfg.logits);
+        if (score < cfg.scoreThreshold) continue;
+        push(row[0], row[1], row[2], row[3], score, bestClass);
     }
 }
 
-void nmsYoloDetections(
-    const std::vector<YoloRawDet>& raw, float nmsThr,
-    std::vector<bool>& suppressed)
+} // namespace
+
+void decodeYoloOutput84xN(
+    const float* outputData,
+    std::size_t numChannels, std::size_t numBoxes,
+    int numClasses, float scoreThr,
+    std::vector<YoloRawDet>& out,
+    const std::vector<int>& classes)
 {
-    suppressed.assign(raw.size(), false);
-    std::vector<size_t> order(raw.size());
-    for (size_t i = 0; i < raw.size(); ++i) order[i] = i;
-    std::sort(order.begin(), order.end(), [&raw](size_t a, size_t b) {
-        return raw[a].score > raw[b].score;
+    out.clear();
+    out.reserve(std::min<std::size_t>(numBoxes, 1024));  // 复用的 out 容量保持，低阈值拥挤场景不反复扩容
+    YoloDecodeConfig cfg;
+    cfg.numClasses = numClasses;
+    cfg.scoreThreshold = scoreThr;
+    decodeAnchorFree(outputData, numChannels, numBoxes, cfg, classes, out);
+}
+
+void decodeYoloOutput(const float* outputData, std::size_t numChannels, std::size_t numBoxes,
+                      const YoloDecodeConfig& cfg, std::vector<YoloRawDet>& out) {
+    decodeAnchorFree(outputData, numChannels, numBoxes, cfg, cfg.classes, out);
+}
+
+void decodeYoloAnchorHead(const YoloAnchorHead& head, const YoloDecodeConfig& cfg, std::vector<YoloRawDet>& out) {
+    if (!head.data || head.gridW <= 0 || head.gridH <= 0 || cfg.numClasses <= 0 || head.numAnchors <= 0 ||
+        head.numAnchors > static_cast<int>(head.anchors.size() / 2)) {
+        return;
+    }
+    const std::size_t cells = static_cast<std::size_t>(head.gridW) * head.gridH;
+    const std::size_t perAnchor = (5 + static_cast<std::size_t>(cfg.numClasses)) * cells;
+    const float stride = static_cast<float>(head.stride);
+    for (int a = 0; a < head.numAnchors; ++a) {
+        const float* base = head.data + a * perAnchor;
+        const float anchorW = head.anchors[2 * a];
+        const float anchorH = head.anchors[2 * a + 1];
+        decodeChannelMajor(base + 4 * cells, base + 5 * cells, cells, cfg, cfg.classes,
+                           [&](std::size_t cell, float score, int classId) {
+                               const float gx = static_cast<float>(cell % head.gridW);
+                               const float gy = static_cast<float>(cell / head.gridW);
+                               const float sx = activate(base[cell], cfg.logits);
+                               const float sy = activate(base[cells + cell], cfg.logits);
+                               const float sw = 2.f * activate(base[2 * cells + cell], cfg.logits);
+                               const float sh = 2.f * activate(base[3 * cells + cell], cfg.logits);
+                               const float w = sw * sw * anchorW;
+                               const float h = sh * sh * anchorH;
+                               YoloRawDet d;
+                               d.x = (2.f * sx - 0.5f + gx) * stride - w / 2;
+                               d.y = (2.f * sy - 0.5f + gy) * stride - h / 2;
+                               d.w = w;
+                               d.h = h;
+                               d.score = score;
+                               d.classId = classId;
+                               out.push_back(d);
+                           });
+    }
+}
+
+namespace {
+
+// 框 i 与 [begin, end) 各框的 IoU 写入 out[j]（SoA：x1/y1/x2/y2/area 下标相同）；任一方面积为 0 时 IoU 为 0
+struct BoxSoA {
+    std::vector<float> x1, y1, x2, y2, area;
+
+    void resize(std::size_t n) {
+        x1.resize(n);
+        y1.resize(n);
+        x2.resize(n);
+        y2.resize(n);
+        area.resize(n);
+    }
+};
+
+using IouRowFn = void (*)(const BoxSoA& b, std::size_t i, std::size_t begin, std::size_t end, float* out);
+
+void iouRowScalar(const BoxSoA& b, std::size_t i, std::size_t begin, std::size_t end, float* out) {
+    const float ai = b.area[i];
+    for (std::size_t j = begin; j < end; ++j) {
+        const float w = std::max(0.0f, std::min(b.x2[i], b.x2[j]) - std::max(b.x1[i], b.x1[j]));
+        const float h = std::max(0.0f, std::min(b.y2[i], b.y2[j]) - std::max(b.y1[i], b.y1[j]));
+        const float inter = w * h;
+        out[j] = (ai > 0 && b.area[j] > 0) ? inter / (ai + b.area[j] - inter) : 0.0f;
+    }
+}
+
+#if defined(FALCONMIND_PREPROCESS_X86)
+__attribute__((target("avx2"))) void iouRowAvx2(const BoxSoA& b, std::size_t i, std::size_t begin, std::size_t end,
+                                                 float* out) {
+    const float ai = b.area[i];
+    if (!(ai > 0)) {
+        std::fill(out + begin, out + end, 0.0f);
+        return;
+    }
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 vx1 = _mm256_set1_ps(b.x1[i]);
+    const __m256 vy1 = _mm256_set1_ps(b.y1[i]);
+    const __m256 vx2 = _mm256_set1_ps(b.x2[i]);
+    const __m256 vy2 = _mm256_set1_ps(b.y2[i]);
+    const __m256 vai = _mm256_set1_ps(ai);
+    std::size_t j = begin;
+    for (; j + 8 <= end; j += 8) {
+        const __m256 w = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(vx2, _mm256_loadu_ps(&b.x2[j])),
+                                                           _mm256_max_ps(vx1, _mm256_loadu_ps(&b.x1[j]))));
+        const __m256 h = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(vy2, _mm256_loadu_ps(&b.y2[j])),
+                                                           _mm256_max_ps(vy1, _mm256_loadu_ps(&b.y1[j]))));
+        const __m256 inter = _mm256_mul_ps(w, h);
+        const __m256 aj = _mm256_loadu_ps(&b.area[j]);
+        const __m256 iou = _mm256_div_ps(inter, _mm256_sub_ps(_mm256_add_ps(vai, aj), inter));
+        _mm256_storeu_ps(out + j, _mm256_and_ps(iou, _mm256_cmp_ps(aj, zero, _CMP_GT_OQ)));
+    }
+    iouRowScalar(b, i, j, end, out);
+}
+#endif
+
+#if defined(FALCONMIND_PREPROCESS_NEON)
+void iouRowNeon(const BoxSoA& b, std::size_t i, std::size_t begin, std::size_t end, float* out) {
+    const float ai = b.area[i];
+    if (!(ai > 0)) {
+        std::fill(out + begin, out + end, 0.0f);
+        return;
+    }
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t vx1 = vdupq_n_f32(b.x1[i]);
+    const float32x4_t vy1 = vdupq_n_f32(b.y1[i]);
+    const float32x4_t vx2 = vdupq_n_f32(b.x2[i]);
+    const float32x4_t vy2 = vdupq_n_f32(b.y2[i]);
+    const float32x4_t vai = vdupq_n_f32(ai);
+    std::size_t j = begin;
+    for (; j + 4 <= end; j += 4) {
+        const float32x4_t w = vmaxq_f32(zero, vsubq_f32(vminq_f32(vx2, vld1q_f32(&b.x2[j])),
+                                                        vmaxq_f32(vx1, vld1q_f32(&b.x1[j]))));
+        const float32x4_t h = vmaxq_f32(zero, vsubq_f32(vminq_f32(vy2, vld1q_f32(&b.y2[j])),
+                                                        vmaxq_f32(vy1, vld1q_f32(&b.y1[j]))));
+        const float32x4_t inter = vmulq_f32(w, h);
+        const float32x4_t aj = vld1q_f32(&b.area[j]);
+        const float32x4_t iou = vdivq_f32(inter, vsubq_f32(vaddq_f32(vai, aj), inter));
+        vst1q_f32(out + j, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(iou), vcgtq_f32(aj, zero))));
+    }
+    iouRowScalar(b, i, j, end, out);
+}
+#endif
+
+IouRowFn selectIouRow() {
+#if defined(FALCONMIND_PREPROCESS_NEON)
+    return iouRowNeon;
+#else
+#if defined(FALCONMIND_PREPROCESS_X86)
+    if (core::cpuFeatures().avx2) return iouRowAvx2;
+#endif
+    return iouRowScalar;
+#endif
+}
+
+IouRowFn iouRow() {
+    static const IouRowFn fn = selectIouRow();
+    return fn;
+}
+
+struct NmsScratch {
+    std::vector<std::uint32_t> order;
+    BoxSoA boxes;
+    std::vector<float> score;
+    std::vector<float> iou;
+    std::vector<float> aux;    // Soft：已选出标记；Matrix：各框与更高分框的最大 IoU
+    std::vector<float> decay;  // Matrix：衰减因子
+    std::vector<std::uint8_t> alive;
+    std::vector<std::uint32_t> kept;
+};
+
+NmsScratch& nmsScratch() {
+    thread_local NmsScratch scratch;
+    return scratch;
+}
+
+// 桶内 [0, m) 的框已按分数降序排好，alive[j] 置 0 表示抑制；score 为（衰减后的）分数
+void nmsBucket(const NmsConfig& cfg, std::size_t m, NmsScratch& s) {
+    const IouRowFn iouFn = iouRow();
+    float* iou = s.iou.data();
+    switch (cfg.method) {
+    case NmsMethod::Hard:
+        for (std::size_t i = 0; i < m; ++i) {
+            if (!s.alive[i]) continue;
+            iouFn(s.boxes, i, i + 1, m, iou);
+            for (std::size_t j = i + 1; j < m; ++j) {
+                if (iou[j] > cfg.iouThreshold) s.alive[j] = 0;
+            }
+        }
+        break;
+    case NmsMethod::Soft: {
+        // 高斯 Soft-NMS：每轮取剩余最高分框，其余框按 IoU 衰减；衰减会改变次序，故逐轮选最大
+        std::fill(s.aux.begin(), s.aux.begin() + m, 0.0f);  // aux[j] = 1 表示已选出
+        for (std::size_t step = 0; step < m; ++step) {
+            std::size_t p = m;
+            for (std::size_t j = 0; j < m; ++j) {
+                if (s.alive[j] && s.aux[j] == 0.0f && (p == m || s.score[j] > s.score[p])) p = j;
+            }
+            if (p == m) break;
+            s.aux[p] = 1.0f;
+            iouFn(s.boxes, p, 0, m, iou);
+            for (std::size_t j = 0; j < m; ++j) {
+                if (!s.alive[j] || s.aux[j] != 0.0f || iou[j] <= 0.0f) continue;
+                s.score[j] *= std::exp(-iou[j] * iou[j] / cfg.sigma);
+                if (s.score[j] < cfg.scoreThreshold) s.alive[j] = 0;
+            }
+        }
+        break;
+    }
+    case NmsMethod::Matrix: {
+        // Matrix NMS：decay_j = min_{i<j} exp(-(iou_ij² − comp_i²)/sigma)，comp_i = max_{k<i} iou_ki。
+        // 两趟逐行计算上三角，不保存 m×m 矩阵
+        float* comp = s.aux.data();
+        std::fill(comp, comp + m, 0.0f);
+        for (std::size_t i = 0; i < m; ++i) {
+            iouFn(s.boxes, i, i + 1, m, iou);
+            for (std::size_t j = i + 1; j < m; ++j) comp[j] = std::max(comp[j], iou[j]);
+        }
+        float* decay = s.decay.data();
+        std::fill(decay, decay + m, 1.0f);
+        for (std::size_t i = 0; i < m; ++i) {
+            iouFn(s.boxes, i, i + 1, m, iou);
+            const float ci = comp[i] * comp[i];
+            for (std::size_t j = i + 1; j < m; ++j) {
+                if (iou[j] * iou[j] <= ci) continue;  // 衰减因子 ≥ 1，不影响最小值
+                decay[j] = std::min(decay[j], std::exp(-(iou[j] * iou[j] - ci) / cfg.sigma));
+            }
+        }
+        for (std::size_t j = 0; j < m; ++j) {
+            s.score[j] *= decay[j];
+            if (s.score[j] < cfg.scoreThreshold) s.alive[j] = 0;
+        }
+        break;
+    }
+    }
+}
+
+void runNms(const std::vector<YoloRawDet>& raw, const NmsConfig& cfg, std::vector<bool>& suppressed,
+            std::vector<YoloRawDet>* decayed) {
+    const std::size_t n = raw.size();
+    suppressed.assign(n, true);
+    if (n == 0) return;
+    NmsScratch& s = nmsScratch();
+    s.order.resize(n);
+    for (std::size_t i = 0; i < n; ++i) s.order[i] = static_cast<std::uint32_t>(i);
+    auto byScore = [&raw](std::uint32_t a, std::uint32_t b) {
+        return raw[a].score > raw[b].score || (raw[a].score == raw[b].score && a < b);
+    };
+    if (cfg.topK > 0 && n > cfg.topK) {
+        std::nth_element(s.order.begin(), s.order.begin() + cfg.topK, s.order.end(), byScore);
+        s.order.resize(cfg.topK);
+    }
+    // 类别分桶：同类连续、桶内分数降序
+    std::sort(s.order.begin(), s.order.end(), [&](std::uint32_t a, std::uint32_t b) {
+        if (!cfg.classAgnostic && raw[a].classId != raw[b].classId) return raw[a].classId < raw[b].classId;
+        return byScore(a, b);
     });
-    for (size_t ii = 0; ii < order.size(); ++ii) {
-        size_t i = order[ii];
-        if (suppressed[i]) continue;
-        const auto& ri = raw[i];
-        for (size_t kk = ii + 1; kk < order.size(); ++kk) {
-            size_t k = order[kk];
-            if (suppressed[k]) continue;
-            if (raw[k].classId != ri.classId) continue;
-            float iou = boxIou(ri.x, ri.y, ri.w, ri.h,
-                              raw[k].x, raw[k].y, raw[k].w, raw[k].h);
-            if (iou > nmsThr) suppressed[k] = true;
+
+    const std::size_t total = s.order.size();
+    s.kept.clear();
+    for (std::size_t b0 = 0; b0 < total;) {
+        std::size_t b1 = b0 + 1;
+        while (b1 < total && (cfg.classAgnostic || raw[s.order[b1]].classId == raw[s.order[b0]].classId)) ++b1;
+        const std::size_t m = b1 - b0;
+        s.boxes.resize(m);
+        s.score.resize(m);
+        s.iou.resize(m);
+        s.aux.resize(m);
+        s.decay.resize(m);
+        s.alive.assign(m, 1);
+        for (std::size_t k = 0; k < m; ++k) {
+            const YoloRawDet& r = raw[s.order[b0 + k]];
+            s.boxes.x1[k] = r.x;
+            s.boxes.y1[k] = r.y;
+            s.boxes.x2[k] = r.x + r.w;
+            s.boxes.y2[k] = r.y + r.h;
+            s.boxes.area[k] = r.w * r.h;
+            s.score[k] = r.score;
+        }
+        nmsBucket(cfg, m, s);
+        for (std::size_t k = 0; k < m; ++k) {
+            if (!s.alive[k]) continue;
+            const std::uint32_t idx = s.order[b0 + k];
+            suppressed[idx] = false;
+            if (decayed) (*decayed)[idx].score = s.score[k];
+            s.kept.push_back(idx);
         }
+        b0 = b1;
+    }
+
+    if (cfg.maxDetections > 0 && s.kept.size() > cfg.maxDetections) {
+        const std::vector<YoloRawDet>& scored = decayed ? *decayed : raw;
+        std::nth_element(s.kept.begin(), s.kept.begin() + cfg.maxDetections, s.kept.end(),
+                         [&scored](std::uint32_t a, std::uint32_t b) { return scored[a].score > scored[b].score; });
+        for (std::size_t k = cfg.maxDetections; k < s.kept.size(); ++k) suppressed[s.kept[k]] = true;
     }
 }
 
+} // namespace
+
+NmsConfig nmsConfig(const DetectorDescriptor& desc) {
+    NmsConfig cfg;
+    cfg.method = desc.nmsMethod;
+    cfg.iouThreshold = desc.nmsThreshold >= 0 ? desc.nmsThreshold : 0.45f;
+    cfg.topK = desc.nmsTopK > 0 ? static_cast<std::size_t>(desc.nmsTopK) : 0;
+    cfg.maxDetections = desc.maxDetections > 0 ? static_cast<std::size_t>(desc.maxDetections) : 0;
+    cfg.sigma = desc.nmsSigma > 0 ? desc.nmsSigma : 0.5f;
+    cfg.scoreThreshold = desc.scoreThreshold > 0 ? desc.scoreThreshold : 0.25f;
+    return cfg;
+}
+
+void nmsYoloDetections(
+    const std::vector<YoloRawDet>& raw, float nmsThr,
+    std::vector<bool>& suppressed)
+{
+    NmsConfig cfg;
+    cfg.iouThreshold = nmsThr;
+    runNms(raw, cfg, suppressed, nullptr);
+}
+
+void nmsYoloDetections(std::vector<YoloRawDet>& raw, const NmsConfig& cfg, std::vector<bool>& suppressed) {
+    runNms(raw, cfg, suppressed, cfg.method == NmsMethod::Hard ? nullptr : &raw);
+}
+
 void fillDetectionResultFromYolo(
     const std::vector<YoloRawDet>& raw,
     const std::vector<bool>& suppressed,
@@ -134,8 +1151,35 @@ void fillDetectionResultFromYolo(
         d.classId = r.classId;
         outResult.detections.push_back(d);
     }
-    outResult.frameIndex = 0;
-    outResult.timestampNs = 0;
+    // frameIndex / timestampNs 由调用方按输入帧（ImageView）填写，此处不覆盖
+}
+
+void fillDetectionResultFromYolo(
+    const std::vector<YoloRawDet>& raw,
+    const std::vector<bool>& suppressed,
+    const LetterboxTransform& transform, int imageW, int imageH,
+    DetectionResult& outResult)
+{
+    outResult.detections.clear();
+    const float maxX = imageW > 0 ? static_cast<float>(imageW) : std::numeric_limits<float>::max();
+    const float maxY = imageH > 0 ? static_cast<float>(imageH) : std::numeric_limits<float>::max();
+    for (size_t i = 0; i < raw.size(); ++i) {
+        if (suppressed[i]) continue;
+        const auto& r = raw[i];
+        const float x0 = std::clamp((r.x - transform.padX) / transform.scaleX, 0.0f, maxX);
+        const float y0 = std::clamp((r.y - transform.padY) / transform.scaleY, 0.0f, maxY);
+        const float x1 = std::clamp((r.x + r.w - transform.padX) / transform.scaleX, 0.0f, maxX);
+        const float y1 = std::clamp((r.y + r.h - transform.padY) / transform.scaleY, 0.0f, maxY);
+        if (x1 <= x0 || y1 <= y0) continue;
+        Detection d;
+        d.bbox.x = x0;
+        d.bbox.y = y0;
+        d.bbox.width = x1 - x0;
+        d.bbox.height = y1 - y0;
+        d.score = r.score;
+        d.classId = r.classId;
+        outResult.detections.push_back(d);
+    }
 }
 
 } // namespace falconmind::sdk::perception
@@ -0,0 +1,253 @@
+// FalconMindSDK - D* Lite Planner Implementation
+#include "falconmind/sdk/planning/DStarLitePlanner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace falconmind::sdk::planning {
+
+namespace {
+
+constexpr float kInf = std::numeric_limits<float>::infinity();
+constexpr float kSqrt2 = 1.41421356f;
+constexpr int kDx[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+constexpr int kDy[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+} // namespace
+
+DStarLitePlanner::DStarLitePlanner(const OccupancyGrid& grid) : grid_(grid) {}
+
+float DStarLitePlanner::heuristic(std::uint32_t a, std::uint32_t b) const noexcept {
+    const GridCell ca = grid_.cellOf(a), cb = grid_.cellOf(b);
+    const int dx = std::abs(ca.x - cb.x), dy = std::abs(ca.y - cb.y);
+    const int lo = std::min(dx, dy), hi = std::max(dx, dy);
+    return static_cast<float>(hi - lo) + kSqrt2 * static_cast<float>(lo);
+}
+
+float DStarLitePlanner::cost(std::uint32_t from, int dx, int dy) const noexcept {
+    const GridCell c = grid_.cellOf(from);
+    if (grid_.blocked(c.x, c.y) || grid_.blocked(c.x + dx, c.y + dy)) return kInf;
+    if (dx != 0 && dy != 0) {
+        // 对角移动不允许切过阻塞单元的角
+        if (grid_.blocked(c.x + dx, c.y) || grid_.blocked(c.x, c.y + dy)) return kInf;
+        return kSqrt2;
+    }
+    return 1.0f;
+}
+
+DStarLitePlanner::Key DStarLitePlanner::calculateKey(std::uint32_t s) const noexcept {
+    const float m = std::min(g_[s], rhs_[s]);
+    return {m + heuristic(startIdx_, s) + km_, m};
+}
+
+float DStarLitePlanner::bestRhs(std::uint32_t u) const noexcept {
+    const GridCell c = grid_.cellOf(u);
+    float best = kInf;
+    for (int k = 0; k < 8; ++k) {
+        const int x = c.x + kDx[k], y = c.y + kDy[k];
+        if (!grid_.inBounds(x, y)) continue;
+        best = std::min(best, cost(u, kDx[k], kDy[k]) + g_[grid_.index(x, y)]);
+    }
+    return best;
+}
+
+void DStarLitePlanner::updateVertex(std::uint32_t u) {
+    const bool inHeap = heapPos_[u] != kNotInHeap;
+    if (g_[u] != rhs_[u]) {
+        const Key key = calculateKey(u);
+        if (inHeap) heapUpdate(u, key);
+        else heapPush(u, key);
+    } else if (inHeap) {
+        heapRemove(u);
+    }
+}
+
+bool DStarLitePlanner::computeShortestPath() {
+    std::size_t expansions = 0;
+    while (!heap_.empty()) {
+        const Key startKey = calculateKey(startIdx_);
+        if (!(heap_[0].key < startKey) && rhs_[startIdx_] == g_[startIdx_]) break;
+        if (++expansions > maxExpansions_) break;
+
+        const std::uint32_t u = heap_[0].cell;
+        const Key oldKey = heap_[0].key;
+        const Key newKey = calculateKey(u);
+        const GridCell c = grid_.cellOf(u);
+
+        if (oldKey < newKey) {
+            heapUpdate(u, newKey);
+        } else if (g_[u] > rhs_[u]) {
+            // 变为局部一致：把更小的 g 传播给前驱（栅格边代价对称，前驱即邻居）
+            g_[u] = rhs_[u];
+            heapRemove(u);
+            for (int k = 0; k < 8; ++k) {
+                const int x = c.x + kDx[k], y = c.y + kDy[k];
+                if (!grid_.inBounds(x, y)) continue;
+                const std::uint32_t s = grid_.index(x, y);
+                if (s == goalIdx_) continue;
+                rhs_[s] = std::min(rhs_[s], cost(s, -kDx[k], -kDy[k]) + g_[u]);
+                updateVertex(s);
+            }
+        } else {
+            // 局部欠一致：g 置为无穷，依赖旧 g 的前驱（及自身）重新计算 rhs
+            const float oldG = g_[u];
+            g_[u] = kInf;
+            for (int k = 0; k < 8; ++k) {
+                const int x = c.x + kDx[k], y = c.y + kDy[k];
+                if (!grid_.inBounds(x, y)) continue;
+                const std::uint32_t s = grid_.index(x, y);
+                if (s == goalIdx_) continue;
+                if (rhs_[s] == cost(s, -kDx[k], -kDy[k]) + oldG) rhs_[s] = bestRhs(s);
+                updateVertex(s);
+            }
+            if (u != goalIdx_) rhs_[u] = bestRhs(u);
+            updateVertex(u);
+        }
+    }
+    lastExpansions_ = expansions;
+    return g_[startIdx_] < kInf;
+}
+
+bool DStarLitePlanner::plan(const GridCell& start, const GridCell& goal) {
+    if (!grid_.inBounds(start.x, start.y) || !grid_.inBounds(goal.x, goal.y)) {
+        initialized_ = false;
+        return false;
+    }
+    const std::size_t n = grid_.cellCount();
+    g_.assign(n, kInf);
+    rhs_.assign(n, kInf);
+    heapPos_.assign(n, kNotInHeap);
+    heap_.clear();
+
+    start_ = last_ = start;
+    goal_ = goal;
+    startIdx_ = grid_.index(start.x, start.y);
+    goalIdx_ = grid_.index(goal.x, goal.y);
+    km_ = 0.f;
+    rhs_[goalIdx_] = 0.f;
+    heapPush(goalIdx_, {heuristic(startIdx_, goalIdx_), 0.f});
+    initialized_ = true;
+    return computeShortestPath();
+}
+
+bool DStarLitePlanner::replan(const GridCell& start, const std::vector<std::uint32_t>& changed) {
+    if (!initialized_ || !grid_.inBounds(start.x, start.y)) return false;
+
+    if (start != start_) {
+        const std::uint32_t idx = grid_.index(start.x, start.y);
+        km_ += heuristic(grid_.index(last_.x, last_.y), idx);
+        last_ = start_ = start;
+        startIdx_ = idx;
+    }
+
+    if (!changed.empty()) {
+        // 代价变化的边两端都落在变化单元及其 8 邻域内：只重算这些节点的 rhs
+        std::vector<std::uint32_t> affected;
+        affected.reserve(changed.size() * 9);
+        for (std::uint32_t v : changed) {
+            const GridCell c = grid_.cellOf(v);
+            affected.push_back(v);
+            for (int k = 0; k < 8; ++k) {
+                const int x = c.x + kDx[k], y = c.y + kDy[k];
+                if (grid_.inBounds(x, y)) affected.push_back(grid_.index(x, y));
+            }
+        }
+        std::sort(affected.begin(), affected.end());
+        affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+        for (std::uint32_t u : affected) {
+            if (u != goalIdx_) rhs_[u] = bestRhs(u);
+            updateVertex(u);
+        }
+    }
+    return computeShortestPath();
+}
+
+float DStarLitePlanner::pathCost() const noexcept {
+    return initialized_ ? g_[startIdx_] : kInf;
+}
+
+bool DStarLitePlanner::extractPath(std::vector<GridCell>& path, std::size_t maxSteps) const {
+    path.clear();
+    if (!initialized_ || !(g_[startIdx_] < kInf)) return false;
+
+    std::uint32_t cur = startIdx_;
+    path.push_back(start_);
+    while (cur != goalIdx_) {
+        if (path.size() >= maxSteps) return false;
+        const GridCell c = grid_.cellOf(cur);
+        float best = kInf;
+        std::uint32_t next = cur;
+        for (int k = 0; k < 8; ++k) {
+            const int x = c.x + kDx[k], y = c.y + kDy[k];
+            if (!grid_.inBounds(x, y)) continue;
+            const std::uint32_t s = grid_.index(x, y);
+            const float v = cost(cur, kDx[k], kDy[k]) + g_[s];
+            if (v < best) {
+                best = v;
+                next = s;
+            }
+        }
+        if (!(best < kInf)) return false;
+        cur = next;
+        path.push_back(grid_.cellOf(cur));
+    }
+    return true;
+}
+
+void DStarLitePlanner::heapSwap(std::size_t a, std::size_t b) {
+    std::swap(heap_[a], heap_[b]);
+    heapPos_[heap_[a].cell] = static_cast<std::uint32_t>(a);
+    heapPos_[heap_[b].cell] = static_cast<std::uint32_t>(b);
+}
+
+void DStarLitePlanner::siftUp(std::size_t i) {
+    while (i > 0) {
+        const std::size_t parent = (i - 1) / 2;
+        if (!(heap_[i].key < heap_[parent].key)) break;
+        heapSwap(i, parent);
+        i = parent;
+    }
+}
+
+void DStarLitePlanner::siftDown(std::size_t i) {
+    const std::size_t n = heap_.size();
+    for (;;) {
+        const std::size_t l = 2 * i + 1, r = l + 1;
+        std::size_t smallest = i;
+        if (l < n && heap_[l].key < heap_[smallest].key) smallest = l;
+        if (r < n && heap_[r].key < heap_[smallest].key) smallest = r;
+        if (smallest == i) break;
+        heapSwap(i, smallest);
+        i = smallest;
+    }
+}
+
+void DStarLitePlanner::heapPush(std::uint32_t cell, const Key& key) {
+    heap_.push_back({key, cell});
+    heapPos_[cell] = static_cast<std::uint32_t>(heap_.size() - 1);
+    siftUp(heap_.size() - 1);
+}
+
+void DStarLitePlanner::heapUpdate(std::uint32_t cell, const Key& key) {
+    const std::size_t i = heapPos_[cell];
+    const Key old = heap_[i].key;
+    heap_[i].key = key;
+    if (key < old) siftUp(i);
+    else siftDown(i);
+}
+
+void DStarLitePlanner::heapRemove(std::uint32_t cell) {
+    const std::size_t i = heapPos_[cell];
+    const std::size_t last = heap_.size() - 1;
+    if (i != last) heapSwap(i, last);
+    heap_.pop_back();
+    heapPos_[cell] = kNotInHeap;
+    if (i < heap_.size()) {
+        const std::uint32_t moved = heap_[i].cell;
+        siftUp(i);
+        siftDown(heapPos_[moved]);
+    }
+}
+
+} // namespace falconmind::sdk::planning
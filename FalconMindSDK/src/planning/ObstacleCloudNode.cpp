@@ -0,0 +1,59 @@
+// FalconMindSDK - Obstacle Cloud Node Implementation
+#include "falconmind/sdk/planning/ObstacleCloudNode.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/sensors/PointCloudPacket.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace falconmind::sdk::planning {
+
+ObstacleCloudNode::ObstacleCloudNode(const ObstacleCloudConfig& cfg) : core::Node("obstacle_cloud"), cfg_(cfg) {
+    addPad(std::make_shared<core::Pad>("pointcloud_in", core::PadType::Sink))
+        ->setDataCallback([this](const void* data, std::size_t size) { onPointCloud(data, size); });
+}
+
+void ObstacleCloudNode::onPointCloud(const void* data, std::size_t size) {
+    sensors::PointCloudView view;
+    const SensorPose pose = pose_.load();
+    if (!view.attach(data, size) || !pose.valid) {
+        framesDropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // 机体前向 (sin ψ, cos ψ)、左向 (-cos ψ, sin ψ)（ENU）
+    const float s = static_cast<float>(std::sin(pose.yaw));
+    const float c = static_cast<float>(std::cos(pose.yaw));
+    const float minR2 = cfg_.minRange * cfg_.minRange, maxR2 = cfg_.maxRange * cfg_.maxRange;
+    const auto pe = static_cast<float>(pose.east), pn = static_cast<float>(pose.north);
+
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    const std::size_t n = view.size();
+    const std::size_t room = cfg_.maxPending > pendingEast_.size() ? cfg_.maxPending - pendingEast_.size() : 0;
+    std::size_t kept = 0, dropped = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const float x = view.x[i], y = view.y[i], z = view.z[i];
+        if (!(z >= cfg_.minRelHeight && z <= cfg_.maxRelHeight)) continue;
+        const float r2 = x * x + y * y;
+        if (r2 < minR2 || r2 > maxR2) continue;
+        if (kept == room) {
+            ++dropped;
+            continue;
+        }
+        pendingEast_.push_back(pe + x * s - y * c);
+        pendingNorth_.push_back(pn + x * c + y * s);
+        ++kept;
+    }
+    if (dropped) pointsDropped_.fetch_add(dropped, std::memory_order_relaxed);
+}
+
+std::size_t ObstacleCloudNode::takeObstaclePoints(std::vector<float>& east, std::vector<float>& north) {
+    east.clear();
+    north.clear();
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    east.swap(pendingEast_);
+    north.swap(pendingNorth_);
+    return east.size();
+}
+
+} // namespace falconmind::sdk::planning
@@ -0,0 +1,142 @@
+// FalconMindSDK - Occupancy Grid Implementation
+#include "falconmind/sdk/planning/OccupancyGrid.h"
+#include "falconmind/sdk/core/WorkerGroup.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace falconmind::sdk::planning {
+
+namespace {
+
+// 每线程至少处理的点数：点数较少时多线程分箱得不偿失
+constexpr std::size_t kMinPointsPerWorker = 4096;
+
+} // namespace
+
+OccupancyGrid::OccupancyGrid(const OccupancyGridConfig& cfg) : cfg_(cfg) {
+    cfg_.width = std::max(1, cfg_.width);
+    cfg_.height = std::max(1, cfg_.height);
+    if (cfg_.resolution <= 0.0) cfg_.resolution = 1.0;
+    cfg_.hitThreshold = std::clamp(cfg_.hitThreshold, 1, 255);
+
+    const std::size_t n = static_cast<std::size_t>(cfg_.width) * cfg_.height;
+    hits_.assign(n, 0);
+    inflated_.assign(n, 0);
+
+    const int r = static_cast<int>(std::ceil(std::max(0.0, cfg_.inflationRadius) / cfg_.resolution));
+    const double r2 = std::pow(std::max(0.0, cfg_.inflationRadius) / cfg_.resolution, 2.0) + 1e-9;
+    for (int dy = -r; dy <= r; ++dy) {
+        for (int dx = -r; dx <= r; ++dx) {
+            if (dx * dx + dy * dy <= r2) {
+                discDx_.push_back(dx);
+                discDy_.push_back(dy);
+            }
+        }
+    }
+
+    workers_ = std::make_unique<core::WorkerGroup>(cfg_.threads > 0 ? cfg_.threads : core::WorkerGroup::defaultCount());
+    binned_.resize(workers_->count());
+}
+
+OccupancyGrid::~OccupancyGrid() = default;
+
+bool OccupancyGrid::toCell(double east, double north, GridCell& cell) const noexcept {
+    const double fx = std::floor((east - cfg_.originEast) / cfg_.resolution);
+    const double fy = std::floor((north - cfg_.originNorth) / cfg_.resolution);
+    if (!(fx >= 0.0 && fy >= 0.0 && fx < cfg_.width && fy < cfg_.height)) return false;
+    cell = {static_cast<int>(fx), static_cast<int>(fy)};
+    return true;
+}
+
+void OccupancyGrid::cellCenter(const GridCell& cell, double& east, double& north) const noexcept {
+    east = cfg_.originEast + (cell.x + 0.5) * cfg_.resolution;
+    north = cfg_.originNorth + (cell.y + 0.5) * cfg_.resolution;
+}
+
+void OccupancyGrid::occupy(std::uint32_t idx, std::vector<std::uint32_t>& changed) {
+    ++occupiedCount_;
+    const GridCell c = cellOf(idx);
+    for (std::size_t k = 0; k < discDx_.size(); ++k) {
+        const int x = c.x + discDx_[k], y = c.y + discDy_[k];
+        if (!inBounds(x, y)) continue;
+        const std::uint32_t j = index(x, y);
+        if (inflated_[j]++ == 0) changed.push_back(j);
+    }
+}
+
+std::size_t OccupancyGrid::insertObstacles(const float* east, const float* north, std::size_t count,
+                                           std::vector<std::uint32_t>& changed) {
+    const std::size_t before = changed.size();
+    if (count == 0) return 0;
+
+    // 分箱（坐标 → 单元下标）可并行；计数与膨胀修改共享状态，在调用线程串行完成
+    const std::size_t workers =
+        std::min(workers_->count(), std::max<std::size_t>(1, count / kMinPointsPerWorker));
+    const double inv = 1.0 / cfg_.resolution;
+    auto bin = [&](std::size_t w) {
+        auto& out = binned_[w];
+        out.clear();
+        if (w >= workers) return;
+        const std::size_t begin = count * w / workers, end = count * (w + 1) / workers;
+        for (std::size_t i = begin; i < end; ++i) {
+            const double fx = std::floor((east[i] - cfg_.originEast) * inv);
+            const double fy = std::floor((north[i] - cfg_.originNorth) * inv);
+            if (fx >= 0.0 && fy >= 0.0 && fx < cfg_.width && fy < cfg_.height) {
+                out.push_back(static_cast<std::uint32_t>(fy) * cfg_.width + static_cast<std::uint32_t>(fx));
+            }
+        }
+    };
+    if (workers > 1) {
+        workers_->run(bin);
+    } else {
+        bin(0);
+        for (std::size_t w = 1; w < binned_.size(); ++w) binned_[w].clear();
+    }
+
+    const auto threshold = static_cast<std::uint8_t>(cfg_.hitThreshold);
+    for (const auto& cells : binned_) {
+        for (std::uint32_t idx : cells) {
+            std::uint8_t& h = hits_[idx];
+            if (h == 255) continue;
+            if (++h == threshold) occupy(idx, changed);
+        }
+    }
+    return changed.size() - before;
+}
+
+std::size_t OccupancyGrid::clear(const GridCell& cell, std::vector<std::uint32_t>& changed) {
+    if (!inBounds(cell.x, cell.y)) return 0;
+    const std::uint32_t idx = index(cell.x, cell.y);
+    const bool wasOccupied = hits_[idx] >= cfg_.hitThreshold;
+    hits_[idx] = 0;
+    if (!wasOccupied) return 0;
+
+    --occupiedCount_;
+    const std::size_t before = changed.size();
+    for (std::size_t k = 0; k < discDx_.size(); ++k) {
+        const int x = cell.x + discDx_[k], y = cell.y + discDy_[k];
+        if (!inBounds(x, y)) continue;
+        const std::uint32_t j = index(x, y);
+        if (--inflated_[j] == 0) changed.push_back(j);
+    }
+    return changed.size() - before;
+}
+
+bool OccupancyGrid::segmentBlocked(double e0, double n0, double e1, double n1) const noexcept {
+    // 按半个单元步长采样线段（膨胀后的障碍至少一个单元宽，不会漏检）
+    const double len = std::hypot(e1 - e0, n1 - n0);
+    const int steps = std::max(1, static_cast<int>(std::ceil(len / (0.5 * cfg_.resolution))));
+    const double inv = 1.0 / cfg_.resolution;
+    for (int i = 0; i <= steps; ++i) {
+        const double t = static_cast<double>(i) / steps;
+        const double fx = std::floor((e0 + (e1 - e0) * t - cfg_.originEast) * inv);
+        const double fy = std::floor((n0 + (n1 - n0) * t - cfg_.originNorth) * inv);
+        // 网格外不视为阻塞：只检查有观测的范围
+        if (!(fx >= 0.0 && fy >= 0.0 && fx < cfg_.width && fy < cfg_.height)) continue;
+        if (inflated_[static_cast<std::size_t>(fy) * cfg_.width + static_cast<std::size_t>(fx)] != 0) return true;
+    }
+    return false;
+}
+
+} // namespace falconmind::sdk::planning
@@ -0,0 +1,395 @@
+// FalconMindSDK - Voxel Map Implementation
+#include "falconmind/sdk/planning/VoxelMap.h"
+#include "falconmind/sdk/core/WorkerGroup.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace falconmind::sdk::planning {
+
+namespace {
+
+// 每线程至少处理的射线数：射线较少时多线程投射得不偿失
+constexpr std::size_t kMinRaysPerWorker = 512;
+constexpr std::uint32_t kNoSlot = 0xffffffffu;
+constexpr std::uint8_t kObserved = 1;
+constexpr std::uint8_t kOccupied = 2;
+constexpr std::int32_t kKeyBias = 1 << 20;  // 每轴 21 位：±2^20 个体素
+
+struct Neighbors {
+    std::array<std::array<std::int32_t, 3>, 26> offsets{};
+    std::array<float, 26> length{};
+    Neighbors() {
+        int n = 0;
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (dx == 0 && dy == 0 && dz == 0) continue;
+                    offsets[n] = {dx, dy, dz};
+                    length[n] = std::sqrt(static_cast<float>(dx * dx + dy * dy + dz * dz));
+                    ++n;
+                }
+            }
+        }
+    }
+};
+
+const Neighbors& neighbors() {
+    static const Neighbors n;
+    return n;
+}
+
+} // namespace
+
+VoxelMap::VoxelMap(const VoxelMapConfig& cfg) : cfg_(cfg) {
+    if (cfg_.resolution <= 0.0) cfg_.resolution = 0.2;
+    // 最近障碍偏移以 int8 保存
+    cfg_.maxDistance = std::clamp(cfg_.maxDistance, static_cast<float>(cfg_.resolution),
+                                  static_cast<float>(100.0 * cfg_.resolution));
+    cfg_.maxBlocks = std::max<std::size_t>(cfg_.maxBlocks, 1);
+    const double blockM = cfg_.resolution * kBlockSide;
+    windowBlocksXY_ = static_cast<std::int32_t>(std::ceil(std::max(0.0, cfg_.windowRadiusXY) / blockM));
+    windowBlocksZ_ = static_cast<std::int32_t>(std::ceil(std::max(0.0, cfg_.windowRadiusZ) / blockM));
+    workers_ = std::make_unique<core::WorkerGroup>(cfg_.threads > 0 ? cfg_.threads : core::WorkerGroup::defaultCount());
+    shards_.resize(workers_->count());
+}
+
+VoxelMap::~VoxelMap() = default;
+
+std::size_t VoxelMap::threads() const noexcept { return workers_->count(); }
+
+std::uint64_t VoxelMap::packKey(const Index3& v) noexcept {
+    return static_cast<std::uint64_t>((v[0] + kKeyBias) & 0x1fffff) |
+           static_cast<std::uint64_t>((v[1] + kKeyBias) & 0x1fffff) << 21 |
+           static_cast<std::uint64_t>((v[2] + kKeyBias) & 0x1fffff) << 42;
+}
+
+VoxelMap::Index3 VoxelMap::unpackKey(std::uint64_t key) noexcept {
+    return {static_cast<std::int32_t>(key & 0x1fffff) - kKeyBias,
+            static_cast<std::int32_t>((key >> 21) & 0x1fffff) - kKeyBias,
+            static_cast<std::int32_t>((key >> 42) & 0x1fffff) - kKeyBias};
+}
+
+VoxelMap::Index3 VoxelMap::voxelOf(double x, double y, double z) const noexcept {
+    const double inv = 1.0 / cfg_.resolution;
+    return {static_cast<std::int32_t>(std::floor(x * inv)), static_cast<std::int32_t>(std::floor(y * inv)),
+            static_cast<std::int32_t>(std::floor(z * inv))};
+}
+
+const VoxelMap::Voxel* VoxelMap::find(const Index3& v) const noexcept {
+    auto it = blockIndex_.find(packKey({v[0] >> kBlockBits, v[1] >> kBlockBits, v[2] >> kBlockBits}));
+    if (it == blockIndex_.end()) return nullptr;
+    const int local = ((v[2] & (kBlockSide - 1)) * kBlockSide + (v[1] & (kBlockSide - 1))) * kBlockSide +
+                      (v[0] & (kBlockSide - 1));
+    return &blocks_[it->second].voxels[local];
+}
+
+VoxelMap::Voxel* VoxelMap::find(const Index3& v) noexcept {
+    return const_cast<Voxel*>(static_cast<const VoxelMap*>(this)->find(v));
+}
+
+VoxelMap::Index3 VoxelMap::coordOf(std::uint32_t slot) const noexcept {
+    const Index3& b = blocks_[slot / kBlockVoxels].coord;
+    const int local = static_cast<int>(slot % kBlockVoxels);
+    return {b[0] * kBlockSide + local % kBlockSide, b[1] * kBlockSide + (local / kBlockSide) % kBlockSide,
+            b[2] * kBlockSide + local / (kBlockSide * kBlockSide)};
+}
+
+bool VoxelMap::inWindow(const Index3& b) const noexcept {
+    return std::abs(b[0] - centerBlock_[0]) <= windowBlocksXY_ && std::abs(b[1] - centerBlock_[1]) <= windowBlocksXY_ &&
+           std::abs(b[2] - centerBlock_[2]) <= windowBlocksZ_;
+}
+
+bool VoxelMap::isObstacle(const Index3& v) const noexcept {
+    const Voxel* p = find(v);
+    return p && (p->flags & kOccupied);
+}
+
+std::uint32_t VoxelMap::allocateBlock(const Index3& coord) {
+    if (blockIndex_.size() >= cfg_.maxBlocks || !inWindow(coord)) return kNoSlot;
+    std::uint32_t idx;
+    if (!freeBlocks_.empty()) {
+        idx = freeBlocks_.back();
+        freeBlocks_.pop_back();
+    } else {
+        idx = static_cast<std::uint32_t>(blocks_.size());
+        blocks_.emplace_back();
+    }
+    Block& b = blocks_[idx];
+    b.coord = coord;
+    for (Voxel& v : b.voxels) v = Voxel{0.f, cfg_.maxDistance, {kNoObstacle, 0, 0}, 0, 0};
+    blockIndex_.emplace(packKey(coord), idx);
+    newBlocks_.push_back(idx);
+    return idx;
+}
+
+void VoxelMap::evictBlock(std::uint32_t idx) {
+    for (const Voxel& v : blocks_[idx].voxels) {
+        if (v.flags & kOccupied) --occupiedCount_;
+    }
+    blockIndex_.erase(packKey(blocks_[idx].coord));
+    freeBlocks_.push_back(idx);
+    ++evictedBlocks_;
+}
+
+void VoxelMap::setCenter(const std::array<double, 3>& center) {
+    const Index3 v = voxelOf(center[0], center[1], center[2]);
+    const Index3 c{v[0] >> kBlockBits, v[1] >> kBlockBits, v[2] >> kBlockBits};
+    if (c == centerBlock_ && !blockIndex_.empty()) return;
+    centerBlock_ = c;
+
+    std::vector<std::uint32_t> evict;
+    for (const auto& [key, idx] : blockIndex_) {
+        if (!inWindow(blocks_[idx].coord)) evict.push_back(idx);
+    }
+    if (evict.empty()) return;
+    for (std::uint32_t idx : evict) evictBlock(idx);
+
+    // 最近障碍随块回收的体素只可能位于窗口边界 reach 个块以内：复位后作为 raise 起点
+    const std::int32_t reach =
+        static_cast<std::int32_t>(std::ceil(cfg_.maxDistance / (cfg_.resolution * kBlockSide)));
+    for (const auto& [key, idx] : blockIndex_) {
+        const Block& b = blocks_[idx];
+        if (std::abs(b.coord[0] - c[0]) < windowBlocksXY_ - reach && std::abs(b.coord[1] - c[1]) < windowBlocksXY_ - reach &&
+            std::abs(b.coord[2] - c[2]) < windowBlocksZ_ - reach) {
+            continue;
+        }
+        for (int i = 0; i < kBlockVoxels; ++i) {
+            Voxel& vx = blocks_[idx].voxels[i];
+            if (vx.obstacle[0] == kNoObstacle) continue;
+            const Index3 p = coordOf(idx * kBlockVoxels + i);
+            const Index3 o{p[0] + vx.obstacle[0], p[1] + vx.obstacle[1], p[2] + vx.obstacle[2]};
+            if (find(o)) continue;
+            vx.obstacle[0] = kNoObstacle;
+            vx.distance = cfg_.maxDistance;
+            deleteQueue_.push_back(p);
+        }
+    }
+    updateEsdf();
+}
+
+void VoxelMap::castRays(std::size_t shard, const float* x, const float* y, const float* z, std::size_t count,
+                        const std::array<double, 3>& origin, std::size_t shards) {
+    Shard& s = shards_[shard];
+    s.hitKeys.clear();
+    s.missKeys.clear();
+    if (shard >= shards) return;
+    const double res = cfg_.resolution;
+    const Index3 start = voxelOf(origin[0], origin[1], origin[2]);
+    const std::size_t begin = count * shard / shards, end = count * (shard + 1) / shards;
+    for (std::size_t i = begin; i < end; ++i) {
+        double d[3] = {x[i] - origin[0], y[i] - origin[1], z[i] - origin[2]};
+        const double len = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        if (!(len >= cfg_.minRange)) continue;  // 含 NaN
+        const bool hit = len <= cfg_.maxRange;
+        const double scale = hit ? 1.0 : cfg_.maxRange / len;
+        for (double& c : d) c *= scale;
+        const Index3 stop = voxelOf(origin[0] + d[0], origin[1] + d[1], origin[2] + d[2]);
+
+        // 三维 DDA（Amanatides-Woo）：逐个经过射线穿过的体素，终点体素之前均记为穿过
+        Index3 cur = start;
+        std::int32_t step[3];
+        double tMax[3], tDelta[3];
+        for (int a = 0; a < 3; ++a) {
+            step[a] = d[a] > 0. ? 1 : (d[a] < 0. ? -1 : 0);
+            if (step[a] == 0) {
+                tMax[a] = tDelta[a] = INFINITY;
+                continue;
+            }
+            const double boundary = (cur[a] + (step[a] > 0 ? 1 : 0)) * res;
+            tMax[a] = (boundary - origin[a]) / d[a];
+            tDelta[a] = res / std::abs(d[a]);
+        }
+        int remaining = std::abs(stop[0] - start[0]) + std::abs(stop[1] - start[1]) + std::abs(stop[2] - start[2]);
+        while (remaining-- > 0) {
+            s.missKeys.push_back(packKey(cur));
+            const int a = tMax[0] < tMax[1] ? (tMax[0] < tMax[2] ? 0 : 2) : (tMax[1] < tMax[2] ? 1 : 2);
+            cur[a] += step[a];
+            tMax[a] += tDelta[a];
+        }
+        (hit ? s.hitKeys : s.missKeys).push_back(packKey(stop));
+    }
+}
+
+void VoxelMap::resolveSlots(std::vector<std::uint64_t>& keys, std::vector<std::uint32_t>& slots) {
+    slots.clear();
+    std::uint64_t lastBlockKey = ~std::uint64_t{0};
+    std::uint32_t lastBlock = kNoSlot;
+    for (std::uint64_t key : keys) {
+        const Index3 v = unpackKey(key);
+        const Index3 b{v[0] >> kBlockBits, v[1] >> kBlockBits, v[2] >> kBlockBits};
+        const std::uint64_t bk = packKey(b);
+        if (bk != lastBlockKey) {
+            lastBlockKey = bk;
+            auto it = blockIndex_.find(bk);
+            lastBlock = it != blockIndex_.end() ? it->second : allocateBlock(b);
+        }
+        if (lastBlock == kNoSlot) {
+            ++droppedUpdates_;
+            continue;
+        }
+        const int local = ((v[2] & (kBlockSide - 1)) * kBlockSide + (v[1] & (kBlockSide - 1))) * kBlockSide +
+                          (v[0] & (kBlockSide - 1));
+        slots.push_back(lastBlock * kBlockVoxels + static_cast<std::uint32_t>(local));
+    }
+}
+
+std::size_t VoxelMap::insertPointCloud(const float* x, const float* y, const float* z, std::size_t count,
+                                       const std::array<double, 3>& origin) {
+    setCenter(origin);
+    if (count == 0) return 0;
+    if (++batch_ == 0) batch_ = 1;  // 0 保留给从未更新的体素
+
+    const std::size_t shards = std::min(workers_->count(), std::max<std::size_t>(1, count / kMinRaysPerWorker));
+    auto cast = [&](std::size_t w) { castRays(w, x, y, z, count, origin, shards); };
+    if (shards > 1) {
+        workers_->run(cast);
+    } else {
+        for (std::size_t w = 0; w < shards_.size(); ++w) cast(w);
+    }
+
+    // 块的查找与分配修改哈希表，在调用线程完成
+    newBlocks_.clear();
+    for (Shard& s : shards_) {
+        resolveSlots(s.hitKeys, s.hitSlots);
+        resolveSlots(s.missKeys, s.missSlots);
+    }
+
+    // 按块下标分片：各分片只写自己的块；先命中后穿过，批次号保证每个体素一批内只更新一次
+    const std::size_t owners = workers_->count();
+    workers_->run([&](std::size_t w) {
+        Shard& out = shards_[w];
+        out.becameOccupied.clear();
+        out.becameFree.clear();
+        auto apply = [&](std::uint32_t slot, float delta) {
+            if ((slot / kBlockVoxels) % owners != w) return;
+            Voxel& v = blocks_[slot / kBlockVoxels].voxels[slot % kBlockVoxels];
+            if (v.batch == batch_) return;
+            v.batch = batch_;
+            v.logOdds = std::clamp(v.logOdds + delta, cfg_.minLogOdds, cfg_.maxLogOdds);
+            const bool was = (v.flags & kOccupied) != 0, now = v.logOdds >= cfg_.occupiedLogOdds;
+            v.flags = static_cast<std::uint8_t>(kObserved | (now ? kOccupied : 0));
+            if (was != now) (now ? out.becameOccupied : out.becameFree).push_back(slot);
+        };
+        for (const Shard& s : shards_) {
+            for (std::uint32_t slot : s.hitSlots) apply(slot, cfg_.hitLogOdds);
+        }
+        for (const Shard& s : shards_) {
+            for (std::uint32_t slot : s.missSlots) apply(slot, cfg_.missLogOdds);
+        }
+    });
+
+    std::size_t changed = 0;
+    for (const Shard& s : shards_) {
+        changed += s.becameOccupied.size() + s.becameFree.size();
+        occupiedCount_ += s.becameOccupied.size();
+        occupiedCount_ -= s.becameFree.size();
+    }
+    updateEsdf();
+    return changed;
+}
+
+void VoxelMap::updateEsdf() {
+    const Neighbors& nb = neighbors();
+    const double res = cfg_.resolution;
+    const float maxD = cfg_.maxDistance;
+
+    // raise：消失的障碍本身及以其为最近障碍的体素复位，邻域中最近障碍仍有效的体素重新传播
+    for (const Shard& s : shards_) {
+        for (std::uint32_t slot : s.becameFree) {
+            Voxel& v = blocks_[slot / kBlockVoxels].voxels[slot % kBlockVoxels];
+            v.obstacle[0] = kNoObstacle;
+            v.distance = maxD;
+            deleteQueue_.push_back(coordOf(slot));
+        }
+    }
+    for (std::size_t i = 0; i < deleteQueue_.size(); ++i) {
+        const Index3 c = deleteQueue_[i];
+        for (const auto& o : nb.offsets) {
+            const Index3 n{c[0] + o[0], c[1] + o[1], c[2] + o[2]};
+            Voxel* nv = find(n);
+            if (!nv || nv->obstacle[0] == kNoObstacle) continue;
+            if (isObstacle({n[0] + nv->obstacle[0], n[1] + nv->obstacle[1], n[2] + nv->obstacle[2]})) {
+                insertQueue_.push_back(n);
+            } else {
+                nv->obstacle[0] = kNoObstacle;
+                nv->distance = maxD;
+                deleteQueue_.push_back(n);
+            }
+        }
+    }
+    deleteQueue_.clear();
+
+    // lower 起点：新障碍，以及新分配块周围已有距离信息的体素（向新块传播）
+    for (const Shard& s : shards_) {
+        for (std::uint32_t slot : s.becameOccupied) {
+            Voxel& v = blocks_[slot / kBlockVoxels].voxels[slot % kBlockVoxels];
+            v.obstacle[0] = v.obstacle[1] = v.obstacle[2] = 0;
+            v.distance = 0.f;
+            insertQueue_.push_back(coordOf(slot));
+        }
+    }
+    for (std::uint32_t idx : newBlocks_) {
+        const Index3 b = blocks_[idx].coord;
+        for (const auto& o : nb.offsets) {
+            auto it = blockIndex_.find(packKey({b[0] + o[0], b[1] + o[1], b[2] + o[2]}));
+            if (it == blockIndex_.end()) continue;
+            const Block& other = blocks_[it->second];
+            for (int i = 0; i < kBlockVoxels; ++i) {
+                if (other.voxels[i].obstacle[0] != kNoObstacle) {
+                    insertQueue_.push_back(coordOf(it->second * kBlockVoxels + static_cast<std::uint32_t>(i)));
+                }
+            }
+        }
+    }
+    newBlocks_.clear();
+
+    // lower：沿 26 邻域传播最近障碍，距离为到障碍体素中心的欧氏距离
+    for (std::size_t i = 0; i < insertQueue_.size(); ++i) {
+        const Index3 c = insertQueue_[i];
+        const Voxel* cv = find(c);
+        if (!cv || cv->obstacle[0] == kNoObstacle) continue;
+        const Index3 p{c[0] + cv->obstacle[0], c[1] + cv->obstacle[1], c[2] + cv->obstacle[2]};
+        if (!isObstacle(p)) continue;
+        for (const auto& o : nb.offsets) {
+            const Index3 n{c[0] + o[0], c[1] + o[1], c[2] + o[2]};
+            const std::int32_t dx = p[0] - n[0], dy = p[1] - n[1], dz = p[2] - n[2];
+            const auto d = static_cast<float>(std::sqrt(static_cast<double>(dx * dx + dy * dy + dz * dz)) * res);
+            if (d > maxD) continue;
+            Voxel* nv = find(n);
+            if (!nv || (nv->obstacle[0] != kNoObstacle && d >= nv->distance)) continue;
+            nv->obstacle[0] = static_cast<std::int8_t>(dx);
+            nv->obstacle[1] = static_cast<std::int8_t>(dy);
+            nv->obstacle[2] = static_cast<std::int8_t>(dz);
+            nv->distance = d;
+            insertQueue_.push_back(n);
+        }
+    }
+    insertQueue_.clear();
+}
+
+VoxelState VoxelMap::state(double x, double y, double z) const noexcept {
+    const Voxel* v = find(voxelOf(x, y, z));
+    if (!v || !(v->flags & kObserved)) return VoxelState::Unknown;
+    return (v->flags & kOccupied) ? VoxelState::Occupied : VoxelState::Free;
+}
+
+float VoxelMap::distance(double x, double y, double z, std::array<float, 3>* gradient) const noexcept {
+    if (gradient) *gradient = {0.f, 0.f, 0.f};
+    const Index3 c = voxelOf(x, y, z);
+    const Voxel* v = find(c);
+    if (!v || v->obstacle[0] == kNoObstacle) return cfg_.maxDistance;
+    if (v->flags & kOccupied) return 0.f;
+    // 查询点到最近障碍体素中心：亚体素精度，梯度即其单位方向
+    const double res = cfg_.resolution;
+    const double g[3] = {x - (c[0] + v->obstacle[0] + 0.5) * res, y - (c[1] + v->obstacle[1] + 0.5) * res,
+                         z - (c[2] + v->obstacle[2] + 0.5) * res};
+    const double len = std::sqrt(g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
+    if (len >= cfg_.maxDistance) return cfg_.maxDistance;
+    if (gradient && len > 1e-9) {
+        *gradient = {static_cast<float>(g[0] / len), static_cast<float>(g[1] / len), static_cast<float>(g[2] / len)};
+    }
+    return static_cast<float>(len);
+}
+
+} // namespace falconmind::sdk::planning
@@ -1,16 +1,23 @@
 #include "falconmind/sdk/sensors/CameraSourceNode.h"
+#include "falconmind/sdk/core/Log.h"
 #include "falconmind/sdk/sensors/CameraFramePacket.h"
+#include "falconmind/sdk/sensors/VideoConvertNode.h"
+#include "falconmind/sdk/core/NodePlacement.h"
+#include "falconmind/sdk/core/PipelineClock.h"
 
-#include <iostream>
+#include <cmath>
 #include <cstring>
 #include <algorithm>
 #include <fstream>
+#include <sstream>
 
 #ifdef __linux__
 #include <linux/videodev2.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 #include <errno.h>
 #endif
@@ -21,102 +28,449 @@ using namespace falconmind::sdk::core;
 
 CameraSourceNode::CameraSourceNode(const VideoSourceConfig& cfg)
     : Node("camera_source"), config_(cfg) {
-    addPad(std::make_shared<Pad>("video_out", PadType::Source));
+    auto pad = std::make_shared<Pad>("video_out", PadType::Source);
+    pad->setCapsCallback([this](const VideoCaps& caps) { negotiatedFormat_ = caps.format; });
+    outPad_ = addPad(pad);
+    framePool_.setMemoryAccount(memoryAccount_);
+    updateCaps();
+}
+
+const core::ParamSchema& CameraSourceNode::paramSchema() {
+    static const core::ParamSchema schema = [] {
+        const VideoSourceConfig d;
+        core::ParamSchema s;
+        s.string("device", d.device, {}, "V4L2 设备路径")
+            .string("uri", d.uri, {}, "file:/path 或 rtsp:// udp:// 等网络地址")
+            .integer("width", d.width, 0, 16384, "0 表示使用设备默认")
+            .integer("height", d.height, 0, 16384)
+            .number("fps", d.fps, 0.0, 1000.0)
+            .string("pixel_format", d.pixelFormat, {}, "RGB8/BGR8/NV12/YUYV，空为自动协商")
+            .boolean("zero_copy", d.zeroCopy)
+            .integer("buffers", d.bufferCount, 2, 32, "V4L2 驱动缓冲数")
+            .boolean("capture_thread", d.captureThread)
+            .string("decoder", d.decoder, {}, "网络流解码器：RK_HW/NVDEC/SW_FFMPEG")
+            .string("transport", d.streamTransport, {"tcp", "udp"}, "RTSP 传输方式")
+            .integer("jitter_ms", d.jitterMs, 0, 10000)
+            .boolean("low_latency", d.lowLatency)
+            .integer("roi_width", d.roiWidth, 0, 16384, "跟踪 ROI 输出宽度，0 为整帧")
+            .integer("roi_height", d.roiHeight, 0, 16384)
+            .string("mjpeg", d.mjpeg, {"auto", "prefer", "off"}, "V4L2 MJPEG 采集（auto：原始格式达不到请求尺寸时）")
+            .string("jpeg_decoder", d.jpegDecoder, {"auto", "mpp", "nvjpeg", "turbo"}, "MJPEG 解码器");
+        return s;
+    }();
+    return schema;
 }
 
 bool CameraSourceNode::configure(const std::unordered_map<std::string, std::string>& params) {
-    auto itDev = params.find("device");
-    if (itDev != params.end()) config_.device = itDev->second;
-    auto itUri = params.find("uri");
-    if (itUri != params.end()) config_.uri = itUri->second;
-    auto itW = params.find("width");
-    if (itW != params.end()) config_.width = static_cast<unsigned>(std::stoul(itW->second));
-    auto itH = params.find("height");
-    if (itH != params.end()) config_.height = static_cast<unsigned>(std::stoul(itH->second));
+    core::NodeParams typed;
+    std::string error;
+    if (!paramSchema().parse(params, typed, error)) {
+        FM_LOG_ERROR("CameraSourceNode", "Invalid parameters for ", id(), ": ", error);
+        return false;
+    }
+    return applyParams(typed);
+}
+
+bool CameraSourceNode::applyParams(const core::NodeParams& params) {
+    params.assign("device", config_.device);
+    params.assign("uri", config_.uri);
+    params.assign("width", config_.width);
+    params.assign("height", config_.height);
+    params.assign("fps", config_.fps);
+    params.assign("pixel_format", config_.pixelFormat);
+    params.assign("zero_copy", config_.zeroCopy);
+    params.assign("buffers", config_.bufferCount);
+    params.assign("capture_thread", config_.captureThread);
+    params.assign("decoder", config_.decoder);
+    params.assign("transport", config_.streamTransport);
+    params.assign("jitter_ms", config_.jitterMs);
+    params.assign("low_latency", config_.lowLatency);
+    params.assign("roi_width", config_.roiWidth);
+    params.assign("roi_height", config_.roiHeight);
+    params.assign("mjpeg", config_.mjpeg);
+    params.assign("jpeg_decoder", config_.jpegDecoder);
+    updateCaps();
     return true;
 }
 
-#ifdef __linux__
-static bool trySetFormat(int fd, int width, int height, uint32_t* outPixelFormat, int* outStride) {
-    v4l2_format fmt{};
-    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    fmt.fmt.pix.width = width;
-    fmt.fmt.pix.height = height;
-    fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_RGB24;
-    if (ioctl(fd, VIDIOC_S_FMT, &fmt) == 0) {
-        *outPixelFormat = fmt.fmt.pix.pixelformat;
-        *outStride = static_cast<int>(fmt.fmt.pix.bytesperline);
+void CameraSourceNode::updateCaps() {
+    bool fileUri = config_.uri.size() >= 5 && config_.uri.substr(0, 5) == "file:";
+    VideoCaps base;
+    base.width = config_.width > 0 ? static_cast<int32_t>(config_.width) : 640;
+    base.height = config_.height > 0 ? static_cast<int32_t>(config_.height) : 480;
+    base.fps = static_cast<int32_t>(std::lround(config_.fps));
+    if (config_.roiWidth > 0 && config_.roiHeight > 0) {
+        // 跟踪 ROI：窗口尺寸固定，下游按窗口协商（偶数宽高，NV12/YUYV 按 2x2 / 2x1 采样）
+        base.width = std::min(base.width, static_cast<int32_t>(config_.roiWidth)) & ~1;
+        base.height = std::min(base.height, static_cast<int32_t>(config_.roiHeight)) & ~1;
+    }
+
+    Caps caps;
+    PixelFormat fixed = parsePixelFormat(config_.pixelFormat);
+    std::vector<PixelFormat> offers;
+    if (fixed != PixelFormat::Any) {
+        offers = {fixed};
+    } else if (streamSource()) {
+        // 解码器原生输出 NV12
+        offers = {PixelFormat::NV12, PixelFormat::RGB8, PixelFormat::BGR8};
+    } else if (fileUri || config_.device.empty()) {
+        offers = {PixelFormat::RGB8, PixelFormat::BGR8, PixelFormat::NV12};
+    } else {
+        // V4L2：设备原生提供或由 convertPixels 转换
+        offers = {PixelFormat::RGB8, PixelFormat::NV12, PixelFormat::YUYV, PixelFormat::BGR8};
+    }
+    for (auto f : offers) {
+        VideoCaps c = base;
+        c.format = f;
+        caps.addVideo(c);
+    }
+    if (auto* pad = outPad_) {
+        pad->setCaps(caps);
+    }
+}
+
+std::string CameraSourceNode::deviceKey() const {
+    const std::string& source = !config_.uri.empty() ? config_.uri : config_.device;
+    if (source.empty()) return {};
+    std::ostringstream key;
+    key << "camera:" << source << "@" << config_.width << "x" << config_.height << "@" << config_.fps;
+    if (config_.roiWidth > 0 && config_.roiHeight > 0) key << "@roi" << config_.roiWidth << "x" << config_.roiHeight;
+    return key.str();
+}
+
+bool CameraSourceNode::streamSource() const {
+    return config_.sourceType == VideoSourceType::RtspStream || config_.sourceType == VideoSourceType::UdpStream ||
+           isStreamUri(config_.uri);
+}
+
+PixelFormat CameraSourceNode::requestedFormat() const {
+    if (negotiatedFormat_ != PixelFormat::Any) return negotiatedFormat_;
+    PixelFormat fixed = parsePixelFormat(config_.pixelFormat);
+    return fixed != PixelFormat::Any ? fixed : PixelFormat::RGB8;
+}
+
+std::size_t CameraSourceNode::estimateMemoryBytes() const {
+    const auto width = static_cast<std::int32_t>(config_.width > 0 ? config_.width : 640);
+    const auto height = static_cast<std::int32_t>(config_.height > 0 ? config_.height : 480);
+    const std::size_t frameBytes = sizeof(CameraFramePacket) + pixelFormatFrameBytes(requestedFormat(), width, height);
+    std::size_t frames = framePool_.maxBuffersPerKey();
+    if (!config_.device.empty() && config_.uri.empty()) frames += config_.bufferCount;
+    return frameBytes * frames;
+}
+
+bool CameraSourceNode::degradeMemory(core::MemoryDegradation step) {
+    constexpr unsigned kMinFrames = 2;
+    constexpr unsigned kMinEdge = 120;
+    if (step == core::MemoryDegradation::FewerInFlight) {
+        const std::size_t poolMax = framePool_.maxBuffersPerKey();
+        const bool v4l2 = !config_.device.empty() && config_.uri.empty();
+        if (poolMax <= kMinFrames && (!v4l2 || config_.bufferCount <= kMinFrames)) return false;
+        framePool_.setMaxBuffersPerKey(std::max<std::size_t>(kMinFrames, poolMax / 2));
+        if (v4l2) config_.bufferCount = std::max(kMinFrames, config_.bufferCount / 2);
         return true;
     }
-    fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_YUYV;
-    if (ioctl(fd, VIDIOC_S_FMT, &fmt) == 0) {
-        *outPixelFormat = fmt.fmt.pix.pixelformat;
+    if (!config_.uri.empty()) return false;
+    const unsigned width = config_.width > 0 ? config_.width : 640;
+    const unsigned height = config_.height > 0 ? config_.height : 480;
+    if (width / 2 < kMinEdge || height / 2 < kMinEdge) return false;
+    // 保持偶数宽高，NV12/YUYV 按 2x2 / 2x1 采样
+    config_.width = (width / 2) & ~1u;
+    config_.height = (height / 2) & ~1u;
+    updateCaps();
+    return true;
+}
+
+void CameraSourceNode::setOutputHeader(int32_t width, int32_t height, int32_t stride) {
+    frameHeader_ = CameraFramePacket{};
+    frameHeader_.width = width;
+    frameHeader_.height = height;
+    frameHeader_.stride = stride > 0 ? stride : pixelFormatMinStride(outputFormat_, width);
+    std::strncpy(frameHeader_.format, pixelFormatName(outputFormat_), sizeof(frameHeader_.format) - 1);
+    frameHeader_.format[sizeof(frameHeader_.format) - 1] = '\0';
+    size_t rows = static_cast<size_t>(height);
+    if (outputFormat_ == PixelFormat::NV12) rows += (rows + 1) / 2;
+    framePixelBytes_ = static_cast<size_t>(frameHeader_.stride) * rows;
+}
+
+#ifdef __linux__
+static uint32_t toV4l2Fourcc(PixelFormat f) {
+    switch (f) {
+        case PixelFormat::RGB8: return V4L2_PIX_FMT_RGB24;
+        case PixelFormat::BGR8: return V4L2_PIX_FMT_BGR24;
+        case PixelFormat::NV12: return V4L2_PIX_FMT_NV12;
+        case PixelFormat::YUYV: return V4L2_PIX_FMT_YUYV;
+        case PixelFormat::Any: break;
+    }
+    return 0;
+}
+
+static PixelFormat fromV4l2Fourcc(uint32_t fourcc) {
+    switch (fourcc) {
+        case V4L2_PIX_FMT_RGB24: return PixelFormat::RGB8;
+        case V4L2_PIX_FMT_BGR24: return PixelFormat::BGR8;
+        case V4L2_PIX_FMT_NV12: return PixelFormat::NV12;
+        case V4L2_PIX_FMT_YUYV: return PixelFormat::YUYV;
+        default: break;
+    }
+    return PixelFormat::Any;
+}
+
+// 按候选顺序设置采集格式；驱动可能改写 pixelformat，仅接受可识别的结果
+static bool trySetFormat(int fd, int width, int height, const std::vector<PixelFormat>& candidates,
+                         PixelFormat* outFormat, int* outStride) {
+    for (auto candidate : candidates) {
+        v4l2_format fmt{};
+        fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        fmt.fmt.pix.width = width;
+        fmt.fmt.pix.height = height;
+        fmt.fmt.pix.pixelformat = toV4l2Fourcc(candidate);
+        if (ioctl(fd, VIDIOC_S_FMT, &fmt) != 0) continue;
+        PixelFormat got = fromV4l2Fourcc(fmt.fmt.pix.pixelformat);
+        if (got == PixelFormat::Any) continue;
+        *outFormat = got;
         *outStride = static_cast<int>(fmt.fmt.pix.bytesperline);
         return true;
     }
     return false;
 }
 
+// 当前设备格式的宽高是否与请求一致（S_FMT 会把不支持的尺寸改为最接近的可用尺寸）
+static bool formatSizeIs(int fd, int width, int height) {
+    v4l2_format fmt{};
+    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    return ioctl(fd, VIDIOC_G_FMT, &fmt) == 0 && static_cast<int>(fmt.fmt.pix.width) == width &&
+           static_cast<int>(fmt.fmt.pix.height) == height;
+}
+
+// 采集缓冲集合：持有设备 fd 与各缓冲映射。每块映射前保留一页匿名内存，帧头写在像素数据之前，
+// 使驱动缓冲本身即为完整的 CameraFramePacket 帧（零拷贝推送）
+struct CameraSourceNode::V4L2Buffers {
+    struct Slot {
+        std::uint8_t* region{nullptr};  // 保留页 + 驱动映射
+        std::size_t regionLength{0};
+        std::uint8_t* pixels{nullptr};  // 驱动映射起点（region + 一页）
+        std::size_t length{0};
+        int dmabufFd{-1};
+    };
+
+    explicit V4L2Buffers(int deviceFd) : fd(deviceFd) {}
+    ~V4L2Buffers() {
+        for (auto& slot : slots) {
+            if (slot.dmabufFd >= 0) close(slot.dmabufFd);
+            if (slot.region) munmap(slot.region, slot.regionLength);
+        }
+        if (fd >= 0) close(fd);
+    }
+
+    bool map(unsigned index, std::size_t length, off_t offset) {
+        auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        Slot& slot = slots[index];
+        void* region = mmap(nullptr, page + length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region == MAP_FAILED) return false;
+        slot.region = static_cast<std::uint8_t*>(region);
+        slot.regionLength = page + length;
+        void* pixels = mmap(slot.region + page, length, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, offset);
+        if (pixels == MAP_FAILED) return false;
+        slot.pixels = static_cast<std::uint8_t*>(pixels);
+        slot.length = length;
+        return true;
+    }
+
+    // 下游释放零拷贝帧时调用（任意线程）；已停止取流时不再入队
+    void requeue(unsigned index) {
+        if (streaming.load(std::memory_order_acquire)) {
+            v4l2_buffer buf{};
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            buf.index = index;
+            ioctl(fd, VIDIOC_QBUF, &buf);
+        }
+        outstanding.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    int fd{-1};
+    std::vector<Slot> slots;
+    std::atomic<bool> streaming{false};
+    std::atomic<unsigned> outstanding{0};  // 下游持有中的零拷贝缓冲数
+};
+
+bool CameraSourceNode::initSensorCrop(int sourceWidth, int sourceHeight) {
+    const int width = std::min(static_cast<int>(config_.roiWidth), sourceWidth) & ~1;
+    const int height = std::min(static_cast<int>(config_.roiHeight), sourceHeight) & ~1;
+    if (width >= sourceWidth && height >= sourceHeight) return false;
+    ImageRect rect = roi_->window(core::PipelineClock::nowNs(), width, height, sourceWidth, sourceHeight);
+    v4l2_selection sel{};
+    sel.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    sel.target = V4L2_SEL_TGT_CROP;
+    sel.r.left = rect.x & ~1;
+    sel.r.top = rect.y & ~1;
+    sel.r.width = static_cast<unsigned>(width);
+    sel.r.height = static_cast<unsigned>(height);
+    if (ioctl(v4l2Fd_, VIDIOC_S_SELECTION, &sel) != 0) {
+        FM_LOG_INFO("CameraSourceNode", "VIDIOC_S_SELECTION unsupported (errno=", errno, "), cropping ROI in software");
+        return false;
+    }
+    // 输出尺寸同窗口（1:1，不经 ISP 缩放）；驱动改写格式或裁剪窗口时放弃设备裁剪
+    v4l2_format fmt{};
+    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    fmt.fmt.pix.width = static_cast<unsigned>(width);
+    fmt.fmt.pix.height = static_cast<unsigned>(height);
+    fmt.fmt.pix.pixelformat = toV4l2Fourcc(captureFormat_);
+    v4l2_selection got{};
+    got.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    got.target = V4L2_SEL_TGT_CROP;
+    const bool ok = ioctl(v4l2Fd_, VIDIOC_S_FMT, &fmt) == 0 && static_cast<int>(fmt.fmt.pix.width) == width &&
+                    static_cast<int>(fmt.fmt.pix.height) == height &&
+                    fromV4l2Fourcc(fmt.fmt.pix.pixelformat) == captureFormat_ &&
+                    ioctl(v4l2Fd_, VIDIOC_G_SELECTION, &got) == 0 && static_cast<int>(got.r.width) == width &&
+                    static_cast<int>(got.r.height) == height;
+    if (!ok) {
+        sel.target = V4L2_SEL_TGT_CROP_DEFAULT;
+        if (ioctl(v4l2Fd_, VIDIOC_G_SELECTION, &sel) == 0) {
+            sel.target = V4L2_SEL_TGT_CROP;
+            ioctl(v4l2Fd_, VIDIOC_S_SELECTION, &sel);
+        }
+        trySetFormat(v4l2Fd_, sourceWidth, sourceHeight, {captureFormat_}, &captureFormat_, &v4l2Stride_);
+        if (v4l2Stride_ <= 0) v4l2Stride_ = pixelFormatMinStride(captureFormat_, sourceWidth);
+        FM_LOG_INFO("CameraSourceNode", "device cannot output a ", width, "x", height, " crop, cropping ROI in software");
+        return false;
+    }
+    v4l2Width_ = width;
+    v4l2Height_ = height;
+    v4l2Stride_ = fmt.fmt.pix.bytesperline > 0 ? static_cast<int>(fmt.fmt.pix.bytesperline)
+                                               : pixelFormatMinStride(captureFormat_, width);
+    sensorCropRect_ = ImageRect{got.r.left, got.r.top, width, height};
+    sensorRegion_ = FrameRegion{got.r.left, got.r.top, sourceWidth, sourceHeight};
+    sensorCropMovable_ = true;
+    return true;
+}
+
+void CameraSourceNode::moveSensorCrop(std::int64_t targetNs) {
+    if (!sensorCropMovable_) return;
+    ImageRect next = roi_->window(targetNs, sensorCropRect_.width, sensorCropRect_.height, sensorRegion_.sourceWidth,
+                                  sensorRegion_.sourceHeight);
+    next.x &= ~1;
+    next.y &= ~1;
+    if (next.x == sensorCropRect_.x && next.y == sensorCropRect_.y) return;
+    v4l2_selection sel{};
+    sel.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    sel.target = V4L2_SEL_TGT_CROP;
+    sel.r.left = next.x;
+    sel.r.top = next.y;
+    sel.r.width = static_cast<unsigned>(sensorCropRect_.width);
+    sel.r.height = static_cast<unsigned>(sensorCropRect_.height);
+    if (ioctl(v4l2Fd_, VIDIOC_S_SELECTION, &sel) != 0 || static_cast<int>(sel.r.width) != sensorCropRect_.width ||
+        static_cast<int>(sel.r.height) != sensorCropRect_.height) {
+        FM_LOG_WARN("CameraSourceNode", "cannot move crop window while streaming (errno=", errno,
+                    "), ROI stays at ", sensorCropRect_.x, ",", sensorCropRect_.y);
+        sensorCropMovable_ = false;
+        return;
+    }
+    sensorCropRect_.x = sel.r.left;  // 驱动可能按对齐要求调整
+    sensorCropRect_.y = sel.r.top;
+}
+
+bool CameraSourceNode::initMjpegCapture(int width, int height) {
+    JpegDecoderType type = JpegDecoderType::Auto;
+    if (!parseJpegDecoder(config_.jpegDecoder, type)) {
+        FM_LOG_WARN("CameraSourceNode", "unknown jpeg_decoder ", config_.jpegDecoder, ", using auto");
+    }
+    jpegDecoder_ = createJpegDecoder(type);
+    if (!jpegDecoder_) {
+        FM_LOG_WARN("CameraSourceNode", "no ", jpegDecoderName(type), " JPEG decoder in this build, MJPEG capture "
+                    "unavailable (FALCONMINDSDK_BUILD_MPP_JPEG / NVJPEG / TURBOJPEG)");
+        return false;
+    }
+    v4l2_format fmt{};
+    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    fmt.fmt.pix.width = static_cast<unsigned>(width);
+    fmt.fmt.pix.height = static_cast<unsigned>(height);
+    fmt.fmt.pix.pixelformat = V4L2_PIX_FMT_MJPEG;
+    if (ioctl(v4l2Fd_, VIDIOC_S_FMT, &fmt) != 0 || fmt.fmt.pix.pixelformat != V4L2_PIX_FMT_MJPEG ||
+        static_cast<int>(fmt.fmt.pix.width) != width || static_cast<int>(fmt.fmt.pix.height) != height) {
+        FM_LOG_INFO("CameraSourceNode", "device has no ", width, "x", height, " MJPEG mode");
+        jpegDecoder_.reset();
+        return false;
+    }
+    // 驱动缓冲里是压缩码流；captureFormat_ 记为解码器的输出格式，转换按紧凑排列的解码结果进行
+    captureFormat_ = jpegDecoder_->nativeFormat();
+    v4l2Stride_ = pixelFormatMinStride(captureFormat_, width);
+    return true;
+}
+
 bool CameraSourceNode::initV4L2() {
     if (config_.device.empty()) return false;
-    v4l2Fd_ = open(config_.device.c_str(), O_RDWR);
-    if (v4l2Fd_ < 0) {
-        std::cerr << "[CameraSourceNode] open " << config_.device << " failed: " << errno << std::endl;
+    // 采集线程以 poll() 等待就绪，DQBUF 需非阻塞
+    int fd = open(config_.device.c_str(), config_.captureThread ? (O_RDWR | O_NONBLOCK) : O_RDWR);
+    if (fd < 0) {
+        FM_LOG_ERROR("CameraSourceNode", "open ", config_.device, " failed: ", errno);
         return false;
     }
+    v4l2Buffers_ = std::make_shared<V4L2Buffers>(fd);
+    v4l2Fd_ = fd;
     v4l2_capability cap{};
     if (ioctl(v4l2Fd_, VIDIOC_QUERYCAP, &cap) != 0 ||
         !(cap.capabilities & V4L2_CAP_VIDEO_CAPTURE) ||
         !(cap.capabilities & V4L2_CAP_STREAMING)) {
-        std::cerr << "[CameraSourceNode] device not a capture/streaming device" << std::endl;
-        close(v4l2Fd_);
-        v4l2Fd_ = -1;
+        FM_LOG_ERROR("CameraSourceNode", "device not a capture/streaming device");
+        shutdownV4L2();
         return false;
     }
     int w = config_.width > 0 ? static_cast<int>(config_.width) : 640;
     int h = config_.height > 0 ? static_cast<int>(config_.height) : 480;
-    uint32_t pixFmt = 0;
-    if (!trySetFormat(v4l2Fd_, w, h, &pixFmt, &v4l2Stride_)) {
-        std::cerr << "[CameraSourceNode] SET_FMT failed" << std::endl;
-        close(v4l2Fd_);
-        v4l2Fd_ = -1;
+    // 优先请求协商格式，使设备直接输出（如 NV12），无需逐帧转换
+    PixelFormat wanted = requestedFormat();
+    std::vector<PixelFormat> candidates{wanted};
+    for (auto f : {PixelFormat::RGB8, PixelFormat::YUYV, PixelFormat::NV12}) {
+        if (f != wanted) candidates.push_back(f);
+    }
+    const bool rawSet = trySetFormat(v4l2Fd_, w, h, candidates, &captureFormat_, &v4l2Stride_);
+    // USB 相机的高分辨率通常只以 MJPEG 提供：原始格式被驱动改小（USB 带宽不足）时改用 MJPEG
+    mjpeg_ = false;
+    if (config_.mjpeg != "off" && (!rawSet || config_.mjpeg == "prefer" || !formatSizeIs(v4l2Fd_, w, h))) {
+        mjpeg_ = initMjpegCapture(w, h);
+        if (!mjpeg_ && rawSet) trySetFormat(v4l2Fd_, w, h, {captureFormat_}, &captureFormat_, &v4l2Stride_);
+    }
+    if (!rawSet && !mjpeg_) {
+        FM_LOG_ERROR("CameraSourceNode", "SET_FMT failed");
+        shutdownV4L2();
         return false;
     }
     v4l2Width_ = w;
     v4l2Height_ = h;
-    if (v4l2Stride_ <= 0) v4l2Stride_ = (pixFmt == V4L2_PIX_FMT_RGB24) ? (w * 3) : (w * 2);
+    if (v4l2Stride_ <= 0) v4l2Stride_ = pixelFormatMinStride(captureFormat_, w);
+    // 裁剪与格式须在分配缓冲前确定；MJPEG 在解码后软件裁剪
+    sensorCrop_ = roiActive_ && !mjpeg_ && initSensorCrop(w, h);
 
     v4l2_requestbuffers req{};
-    req.count = 4;
+    req.count = std::clamp(config_.bufferCount, 2u, 32u);
     req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
     req.memory = V4L2_MEMORY_MMAP;
     if (ioctl(v4l2Fd_, VIDIOC_REQBUFS, &req) != 0 || req.count == 0) {
-        std::cerr << "[CameraSourceNode] REQBUFS failed" << std::endl;
-        close(v4l2Fd_);
-        v4l2Fd_ = -1;
+        FM_LOG_ERROR("CameraSourceNode", "REQBUFS failed");
+        shutdownV4L2();
         return false;
     }
-    v4l2NumBuffers_ = req.count;
-    v4l2MapPtrs_.resize(v4l2NumBuffers_, nullptr);
-    v4l2MapLens_.resize(v4l2NumBuffers_, 0);
-    for (unsigned i = 0; i < v4l2NumBuffers_; ++i) {
+    v4l2Buffers_->slots.resize(req.count);
+    for (unsigned i = 0; i < req.count; ++i) {
         v4l2_buffer buf{};
         buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
         buf.memory = V4L2_MEMORY_MMAP;
         buf.index = i;
-        if (ioctl(v4l2Fd_, VIDIOC_QUERYBUF, &buf) != 0) {
+        if (ioctl(v4l2Fd_, VIDIOC_QUERYBUF, &buf) != 0 || !v4l2Buffers_->map(i, buf.length, buf.m.offset)) {
             shutdownV4L2();
             return false;
         }
-        void* ptr = mmap(nullptr, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, v4l2Fd_, buf.m.offset);
-        if (ptr == MAP_FAILED) {
-            shutdownV4L2();
-            return false;
+        if (config_.zeroCopy) {
+            v4l2_exportbuffer exp{};
+            exp.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            exp.index = i;
+            exp.flags = O_RDONLY | O_CLOEXEC;
+            // 驱动不支持导出时仍可零拷贝推送映射，只是没有 DMABUF
+            if (ioctl(v4l2Fd_, VIDIOC_EXPBUF, &exp) == 0) v4l2Buffers_->slots[i].dmabufFd = exp.fd;
         }
-        v4l2MapPtrs_[i] = ptr;
-        v4l2MapLens_[i] = buf.length;
     }
-    for (unsigned i = 0; i < v4l2NumBuffers_; ++i) {
+    for (unsigned i = 0; i < req.count; ++i) {
         v4l2_buffer buf{};
         buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
         buf.memory = V4L2_MEMORY_MMAP;
@@ -131,154 +485,633 @@ bool CameraSourceNode::initV4L2() {
         shutdownV4L2();
         return false;
     }
+    v4l2Buffers_->streaming.store(true, std::memory_order_release);
 
-    size_t pixelSize = static_cast<size_t>(v4l2Stride_) * static_cast<size_t>(v4l2Height_);
-    size_t rgbSize = static_cast<size_t>(v4l2Width_) * static_cast<size_t>(v4l2Height_) * 3u;
-    frameBuffer_.resize(sizeof(CameraFramePacket) + std::max(pixelSize, rgbSize));
-    CameraFramePacket* header = reinterpret_cast<CameraFramePacket*>(frameBuffer_.data());
-    header->width = v4l2Width_;
-    header->height = v4l2Height_;
-    header->stride = v4l2Stride_;
-    std::strncpy(header->format, (pixFmt == V4L2_PIX_FMT_RGB24) ? "RGB8" : "YUYV", sizeof(header->format) - 1);
-    header->format[sizeof(header->format) - 1] = '\0';
+    outputFormat_ = wanted;
+    if (!canConvertPixels(captureFormat_, outputFormat_)) {
+        FM_LOG_WARN("CameraSourceNode", "cannot convert ", pixelFormatName(captureFormat_), " to ",
+                    pixelFormatName(outputFormat_), ", emitting native format");
+        outputFormat_ = captureFormat_;
+    }
+    // 原生格式直出时保留驱动行宽，否则输出紧凑排列
+    setOutputHeader(v4l2Width_, v4l2Height_, outputFormat_ == captureFormat_ ? v4l2Stride_ : 0);
     return true;
 }
-
 void CameraSourceNode::shutdownV4L2() {
-    if (v4l2Fd_ >= 0) {
+    if (v4l2Buffers_) {
+        // 先停止入队，再 STREAMOFF；下游仍持有的零拷贝帧保持映射有效，全部释放后关闭设备
+        v4l2Buffers_->streaming.store(false, std::memory_order_release);
         enum v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
         ioctl(v4l2Fd_, VIDIOC_STREAMOFF, &type);
-        for (unsigned i = 0; i < v4l2MapPtrs_.size(); ++i) {
-            if (v4l2MapPtrs_[i])
-                munmap(v4l2MapPtrs_[i], v4l2MapLens_[i]);
-        }
-        v4l2MapPtrs_.clear();
-        v4l2MapLens_.clear();
-        close(v4l2Fd_);
-        v4l2Fd_ = -1;
+        v4l2Buffers_.reset();
     }
-    v4l2NumBuffers_ = 0;
+    v4l2Fd_ = -1;
     v4l2Ready_ = false;
 }
+unsigned CameraSourceNode::v4l2BufferCount() const noexcept {
+    return v4l2Buffers_ ? static_cast<unsigned>(v4l2Buffers_->slots.size()) : 0;
+}
+bool CameraSourceNode::startCaptureThread() {
+    wakeFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd_ < 0) {
+        FM_LOG_WARN("CameraSourceNode", "eventfd failed: ", errno, ", capturing in process()");
+        return false;
+    }
+    captureRunning_.store(true, std::memory_order_release);
+    captureThread_ = std::thread([this] { captureLoop(); });
+    return true;
+}
+void CameraSourceNode::stopCaptureThread() {
+    if (!captureThread_.joinable()) return;
+    captureRunning_.store(false, std::memory_order_release);
+    std::uint64_t one = 1;
+    (void)!write(wakeFd_, &one, sizeof(one));
+    captureThread_.join();
+    close(wakeFd_);
+    wakeFd_ = -1;
+}
+void CameraSourceNode::captureLoop() {
+    if (placement().pinsThread()) {
+        applyThreadPlacement(placement(), id());
+    }
+    while (captureRunning_.load(std::memory_order_acquire)) {
+        // 暂停时只等待唤醒，不取帧：驱动队列填满后停止覆盖，resume 时丢弃积压的旧帧
+        bool paused = capturePaused_.load(std::memory_order_acquire);
+        pollfd fds[2] = {{wakeFd_, POLLIN, 0}, {v4l2Fd_, POLLIN, 0}};
+        int n = poll(fds, paused ? 1 : 2, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            FM_LOG_ERROR("CameraSourceNode", "capture poll failed: ", errno);
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            std::uint64_t value = 0;
+            (void)!read(wakeFd_, &value, sizeof(value));
+            continue;  // 重新检查 running/paused
+        }
+        if (paused) continue;
+        if (fds[1].revents & POLLIN) {
+            std::lock_guard<std::mutex> lock(captureMutex_);
+            if (!capturePaused_.load(std::memory_order_acquire)) {
+                captureV4L2Frame(applyPendingControls());
+            }
+        } else if (fds[1].revents & (POLLERR | POLLHUP)) {
+            // 驱动队列为空（所有缓冲都在下游）或设备异常：等待唤醒或短暂退避后重试
+            pollfd wake{wakeFd_, POLLIN, 0};
+            poll(&wake, 1, 10);
+        }
+    }
+}
+void CameraSourceNode::captureV4L2Frame(bool flush) {
+    if (flush) {
+        flushV4L2Queue();
+    }
+    v4l2_buffer buf{};
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    if (ioctl(v4l2Fd_, VIDIOC_DQBUF, &buf) != 0)
+        return;
+    // 驱动单调时间戳即曝光/入队时刻，与 PipelineClock 同一时基；其它时基时退回出队时刻
+    std::int64_t captureNs = (buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC
+        ? core::PipelineClock::fromTimeval(buf.timestamp.tv_sec, buf.timestamp.tv_usec)
+        : core::PipelineClock::nowNs();
+    if (sensorCrop_) {
+        // 本帧按出队时已生效的窗口记录（驱动通常在下一帧起应用新窗口），随后把窗口移到下一帧的预测位置
+        sensorRegion_.x = sensorCropRect_.x;
+        sensorRegion_.y = sensorCropRect_.y;
+        const std::int64_t periodNs = config_.fps > 0.0 ? static_cast<std::int64_t>(1e9 / config_.fps) : 0;
+        moveSensorCrop(captureNs + periodNs);
+    }
+    if (rateLimited(captureNs)) {
+        ioctl(v4l2Fd_, VIDIOC_QBUF, &buf);  // 直接归还，不做格式转换
+        return;
+    }
+    if (mjpeg_) {
+        // 只拷贝压缩帧即归还驱动，解码在解码线程进行
+        const auto& slot = v4l2Buffers_->slots[buf.index];
+        if (buf.bytesused > 0 && !(buf.flags & V4L2_BUF_FLAG_ERROR)) {
+            mjpegStage_.submit(slot.pixels, std::min<std::size_t>(buf.bytesused, slot.length), captureNs);
+        } else {
+            mjpegErrors_.fetch_add(1, std::memory_order_relaxed);
+        }
+        ioctl(v4l2Fd_, VIDIOC_QBUF, &buf);
+        return;
+    }
+    if (config_.zeroCopy && captureFormat_ == outputFormat_) {
+        if (wrapV4L2Frame(buf.index, buf.bytesused)) {
+            zeroCopyFrames_.fetch_add(1, std::memory_order_relaxed);
+            pushFrame(captureNs);  // 下游释放最后一个引用时 QBUF
+            return;
+        }
+        zeroCopyFallbacks_.fetch_add(1, std::memory_order_relaxed);
+    }
+    const auto& slot = v4l2Buffers_->slots[buf.index];
+    const std::uint8_t* src = slot.pixels;
+    std::uint8_t* dst = acquireFrame();
+    if (captureFormat_ == outputFormat_) {
+        size_t available = buf.bytesused > 0 ? buf.bytesused : slot.length;
+        std::memcpy(dst, src, std::min(framePixelBytes_, std::min(available, slot.length)));
+    } else {
+        convertPixels(captureFormat_, src, v4l2Stride_, outputFormat_, dst, v4l2Width_, v4l2Height_);
+    }
+    ioctl(v4l2Fd_, VIDIOC_QBUF, &buf);
+
+    pushFrame(captureNs);
+}
+bool CameraSourceNode::wrapV4L2Frame(unsigned index, std::size_t bytesUsed) {
+    auto buffers = v4l2Buffers_;
+    // 至少留一块缓冲在驱动队列中，否则下游持帧期间采集会停住
+    if (buffers->outstanding.load(std::memory_order_acquire) + 1 >= buffers->slots.size()) {
+        return false;
+    }
+    const auto& slot = buffers->slots[index];
+    std::uint8_t* base = slot.pixels - sizeof(CameraFramePacket);
+    std::memcpy(base, &frameHeader_, sizeof(CameraFramePacket));
+    buffers->outstanding.fetch_add(1, std::memory_order_acq_rel);
+    std::shared_ptr<void> holder(buffers.get(), [buffers, index](void*) { buffers->requeue(index); });
+    std::size_t pixels = std::min(framePixelBytes_, bytesUsed > 0 ? std::min(bytesUsed, slot.length) : slot.length);
+    frame_ = BufferRef::wrap(base, sizeof(CameraFramePacket) + pixels, std::move(holder));
+    frame_.mutableMeta().dmabufFd = slot.dmabufFd;
+    return true;
+}
 #else
+struct CameraSourceNode::V4L2Buffers {};
+bool CameraSourceNode::initSensorCrop(int, int) { return false; }
+bool CameraSourceNode::initMjpegCapture(int, int) { return false; }
+void CameraSourceNode::moveSensorCrop(std::int64_t) {}
 bool CameraSourceNode::initV4L2() { (void)config_; return false; }
 void CameraSourceNode::shutdownV4L2() {}
+bool CameraSourceNode::wrapV4L2Frame(unsigned, std::size_t) { return false; }
+unsigned CameraSourceNode::v4l2BufferCount() const noexcept { return 0; }
+bool CameraSourceNode::startCaptureThread() { return false; }
+void CameraSourceNode::stopCaptureThread() {}
+void CameraSourceNode::captureLoop() {}
+void CameraSourceNode::captureV4L2Frame(bool) {}
 #endif
 
+void CameraSourceNode::decodeMjpegFrame(const std::uint8_t* jpeg, std::size_t size, std::int64_t captureNs) {
+    if (capturePaused_.load(std::memory_order_acquire)) return;
+    // 不持有 captureMutex_：采集线程出队、拷贝压缩帧不等待解码
+    std::lock_guard<std::mutex> lock(mjpegMutex_);
+    if (capturePaused_.load(std::memory_order_acquire)) return;
+
+    std::uint8_t* dst = acquireFrame();
+    const bool direct = jpegDecoder_->supportsOutput(outputFormat_);
+    WritableImageSurface surface;
+    surface.width = v4l2Width_;
+    surface.height = v4l2Height_;
+    if (direct) {
+        surface.data = dst;
+        surface.stride = frameHeader_.stride;
+        surface.format = outputFormat_;
+    } else {
+        mjpegScratch_.resize(pixelFormatFrameBytes(captureFormat_, v4l2Width_, v4l2Height_));
+        surface.data = mjpegScratch_.data();
+        surface.stride = v4l2Stride_;
+        surface.format = captureFormat_;
+    }
+    if (!jpegDecoder_->decode(jpeg, size, surface)) {
+        mjpegErrors_.fetch_add(1, std::memory_order_relaxed);
+        frame_.reset();
+        return;
+    }
+    if (!direct) {
+        convertPixels(captureFormat_, mjpegScratch_.data(), v4l2Stride_, outputFormat_, dst, v4l2Width_, v4l2Height_);
+    }
+    mjpegDecoded_.fetch_add(1, std::memory_order_relaxed);
+    pushFrame(captureNs);
+}
+
 bool CameraSourceNode::initFileMode() {
     if (filePath_.empty()) return false;
+    if (CaptureReader::isCaptureFile(filePath_)) {
+        fileReader_ = CaptureReader::open(filePath_);
+        CameraFramePacket header{};
+        if (fileReader_ && !fileReader_->empty() && fileReader_->record(0).size >= sizeof(CameraFramePacket)) {
+            std::memcpy(&header, fileReader_->record(0).data, sizeof(CameraFramePacket));
+            captureFormat_ = parsePixelFormat(header.format);
+        }
+        if (!fileReader_ || captureFormat_ == PixelFormat::Any || header.width <= 0 || header.height <= 0) {
+            FM_LOG_ERROR("CameraSourceNode", "capture file has no camera frames: ", filePath_);
+            fileReader_.reset();
+            captureFormat_ = PixelFormat::RGB8;
+            return false;
+        }
+        fileWidth_ = static_cast<unsigned>(header.width);
+        fileHeight_ = static_cast<unsigned>(header.height);
+        outputFormat_ = requestedFormat();
+        if (!canConvertPixels(captureFormat_, outputFormat_)) outputFormat_ = captureFormat_;
+        // 格式一致时沿用录制的行跨度，使记录可原样零拷贝推送
+        setOutputHeader(header.width, header.height, outputFormat_ == captureFormat_ ? header.stride : 0);
+        fileRecord_ = 0;
+        FM_LOG_INFO("CameraSourceNode", "capture file mode: ", filePath_, " ", fileWidth_, "x", fileHeight_,
+                    " records=", fileReader_->size());
+        return true;
+    }
     fileStream_.open(filePath_, std::ios::binary);
     if (!fileStream_.is_open()) {
-        std::cerr << "[CameraSourceNode] file open failed: " << filePath_ << std::endl;
+        FM_LOG_ERROR("CameraSourceNode", "file open failed: ", filePath_);
         return false;
     }
     fileWidth_ = config_.width > 0 ? config_.width : 640;
     fileHeight_ = config_.height > 0 ? config_.height : 480;
     fileFrameBytes_ = static_cast<size_t>(fileWidth_) * static_cast<size_t>(fileHeight_) * 3u;
-    frameBuffer_.resize(sizeof(CameraFramePacket) + fileFrameBytes_);
-    CameraFramePacket* header = reinterpret_cast<CameraFramePacket*>(frameBuffer_.data());
-    header->width = static_cast<int32_t>(fileWidth_);
-    header->height = static_cast<int32_t>(fileHeight_);
-    header->stride = static_cast<int32_t>(fileWidth_ * 3);
-    std::strncpy(header->format, "RGB8", sizeof(header->format) - 1);
-    header->format[sizeof(header->format) - 1] = '\0';
-    std::cout << "[CameraSourceNode] file mode: " << filePath_ << " " << fileWidth_ << "x" << fileHeight_ << std::endl;
+    captureFormat_ = PixelFormat::RGB8;  // 文件为紧凑 RGB8 原始帧
+    outputFormat_ = requestedFormat();
+    if (!canConvertPixels(captureFormat_, outputFormat_)) outputFormat_ = captureFormat_;
+    setOutputHeader(static_cast<int32_t>(fileWidth_), static_cast<int32_t>(fileHeight_), 0);
+    if (outputFormat_ != captureFormat_) fileScratch_.resize(fileFrameBytes_);
+    FM_LOG_INFO("CameraSourceNode", "file mode: ", filePath_, " ", fileWidth_, "x", fileHeight_);
     return true;
 }
 
 void CameraSourceNode::shutdownFileMode() {
     if (fileStream_.is_open()) fileStream_.close();
+    fileReader_.reset();  // 已推送的记录各自持有映射，下游释放后才解除
+    fileScratch_.clear();
     fileMode_ = false;
 }
 
 bool CameraSourceNode::start() {
     started_ = true;
+    appliedRateFps_ = 0.0;  // 设备重新打开，首个 process() 重新应用当前上限
+    deviceRateLimit_ = false;
+    roiActive_ = config_.roiWidth > 0 && config_.roiHeight > 0;
+    sensorCrop_ = false;
+    if (roiActive_ && !roi_) roi_ = std::make_shared<TrackedRoi>();  // 无跟踪输入：居中窗口
 #ifdef __linux__
     if (!config_.device.empty()) {
         v4l2Ready_ = initV4L2();
-        if (v4l2Ready_ && !frameBuffer_.empty()) {
-            auto* hp = reinterpret_cast<CameraFramePacket*>(frameBuffer_.data());
-            std::cout << "[CameraSourceNode] V4L2 started: " << config_.device
-                      << " " << v4l2Width_ << "x" << v4l2Height_ << " " << hp->format << std::endl;
+        if (v4l2Ready_) {
+            if (mjpeg_) {
+                mjpegStage_.start([this](const std::uint8_t* jpeg, std::size_t size, std::int64_t captureNs) {
+                    decodeMjpegFrame(jpeg, size, captureNs);
+                });
+            }
+            bool threaded = config_.captureThread && startCaptureThread();
+            FM_LOG_INFO("CameraSourceNode", "V4L2 started: ", config_.device, " ", v4l2Width_, "x", v4l2Height_,
+                        " capture=", pixelFormatName(captureFormat_), " output=", pixelFormatName(outputFormat_),
+                        " buffers=", v4l2BufferCount(), threaded ? " (capture thread)" : "",
+                        sensorCrop_ ? " (sensor crop)" : "",
+                        mjpeg_ ? std::string(" (MJPEG, ") + jpegDecoder_->name() + " decoder)" : std::string());
         }
     }
 #endif
-    if (!v4l2Ready_) {
+    if (!v4l2Ready_ && streamSource() && !config_.uri.empty()) {
+        initStreamMode();
+    }
+    if (!v4l2Ready_ && !stream_) {
         if (config_.uri.size() >= 5 && config_.uri.substr(0, 5) == "file:") {
             filePath_ = config_.uri.substr(5);
             fileMode_ = initFileMode();
         }
         if (!fileMode_)
-            std::cout << "[CameraSourceNode] start (stub): device=" << config_.device
-                      << " uri=" << config_.uri << " width=" << config_.width
-                      << " height=" << config_.height << " fps=" << config_.fps << std::endl;
+            FM_LOG_INFO("CameraSourceNode", "start (stub): device=", config_.device, " uri=", config_.uri,
+                        " width=", config_.width, " height=", config_.height, " fps=", config_.fps);
     }
     return true;
 }
 
 void CameraSourceNode::stop() {
+    if (stream_) {
+        stream_->stop();  // 返回后不再有回调
+        stream_.reset();
+    }
 #ifdef __linux__
+    stopCaptureThread();
+    mjpegStage_.stop();  // 采集线程已停止，不再有新帧提交
+    capturePaused_.store(false, std::memory_order_relaxed);
     shutdownV4L2();
 #endif
+    jpegDecoder_.reset();
+    mjpeg_ = false;
     shutdownFileMode();
+    frame_.reset();
+    framePool_.clear();
     started_ = false;
 }
 
-void CameraSourceNode::process() {
-    if (!started_) return;
+void CameraSourceNode::pause() {
+    capturePaused_.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(captureMutex_);  // 等待正在推送的帧完成
+    std::lock_guard<std::mutex> decodeLock(mjpegMutex_);
+}
+void CameraSourceNode::resume() {
+    flushPending_.store(true, std::memory_order_relaxed);
+    capturePaused_.store(false, std::memory_order_release);
+#ifdef __linux__
+    if (wakeFd_ >= 0) {
+        std::uint64_t one = 1;
+        (void)!write(wakeFd_, &one, sizeof(one));
+    }
+#endif
+}
 
 #ifdef __linux__
-    if (v4l2Ready_ && v4l2Fd_ >= 0) {
+void CameraSourceNode::flushV4L2Queue() {
+    unsigned flushed = 0;
+    // 最多出队一轮缓冲：驱动在此期间继续填充时不追赶
+    for (std::size_t i = 0; i < v4l2Buffers_->slots.size(); ++i) {
+        pollfd pfd{v4l2Fd_, POLLIN, 0};
+        if (poll(&pfd, 1, 0) <= 0 || !(pfd.revents & POLLIN)) {
+            break;
+        }
         v4l2_buffer buf{};
         buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
         buf.memory = V4L2_MEMORY_MMAP;
-        if (ioctl(v4l2Fd_, VIDIOC_DQBUF, &buf) != 0)
+        if (ioctl(v4l2Fd_, VIDIOC_DQBUF, &buf) != 0) {
+            break;
+        }
+        ioctl(v4l2Fd_, VIDIOC_QBUF, &buf);
+        ++flushed;
+    }
+    if (flushed > 0) {
+        FM_LOG_INFO("CameraSourceNode", "resume: dropped ", flushed, " stale frame(s)");
+    }
+}
+#endif
+
+std::uint8_t* CameraSourceNode::acquireFrame() {
+    core::BufferPoolKey key{frameHeader_.width, frameHeader_.height, frameHeader_.format};
+    frame_ = framePool_.acquire(key, sizeof(CameraFramePacket) + framePixelBytes_);
+    std::uint8_t* base = frame_.mutableData();
+    std::memcpy(base, &frameHeader_, sizeof(CameraFramePacket));
+    return base + sizeof(CameraFramePacket);
+}
+
+void CameraSourceNode::pushCaptureRecord() {
+    std::int64_t captureNs = PipelineClock::nowNs();  // 回放：以读出时刻作为采集时刻
+    int32_t width = frameHeader_.width;
+    int32_t height = frameHeader_.height;
+    // 最多扫一圈：分辨率与首帧不同或数据不足的记录跳过
+    for (std::size_t tried = 0; tried < fileReader_->size(); ++tried) {
+        std::size_t index = fileRecord_;
+        fileRecord_ = (fileRecord_ + 1) % fileReader_->size();
+        const CaptureRecord& record = fileReader_->record(index);
+        if (record.size < sizeof(CameraFramePacket)) continue;
+        CameraFramePacket header{};
+        std::memcpy(&header, record.data, sizeof(CameraFramePacket));
+        PixelFormat format = parsePixelFormat(header.format);
+        if (header.width != width || header.height != height || !canConvertPixels(format, outputFormat_)) continue;
+        int32_t stride = header.stride > 0 ? header.stride : pixelFormatMinStride(format, width);
+        size_t rows = static_cast<size_t>(height);
+        if (format == PixelFormat::NV12) rows += (rows + 1) / 2;
+        if (record.size - sizeof(CameraFramePacket) < static_cast<size_t>(stride) * rows) continue;
+
+        if (format == outputFormat_ && stride == frameHeader_.stride && !roiActive_) {
+            // 零拷贝：直接推送映射内的记录；帧头中的时间戳/帧序号保持录制值，以缓冲元数据为准
+            BufferRef buffer = fileReader_->buffer(index);
+            auto& meta = buffer.mutableMeta();
+            meta.frameIndex = frameIndex_++;
+            meta.video = VideoCaps{outputFormat_, width, height, static_cast<int32_t>(std::lround(config_.fps))};
+            meta.timestampNs = captureNs;
+            if (outPad_) outPad_->pushBuffer(buffer);
             return;
-        CameraFramePacket* header = reinterpret_cast<CameraFramePacket*>(frameBuffer_.data());
-        std::uint8_t* dst = frameBuffer_.data() + sizeof(CameraFramePacket);
-        const std::uint8_t* src = static_cast<const std::uint8_t*>(v4l2MapPtrs_[buf.index]);
-        size_t srcStride = static_cast<size_t>(v4l2Stride_);
-        int w = v4l2Width_, hh = v4l2Height_;
-        bool isYuyv = (std::strcmp(header->format, "YUYV") == 0);
-        if (isYuyv && srcStride >= static_cast<size_t>(w * 2)) {
-            for (int y = 0; y < hh; ++y) {
-                const std::uint8_t* row = src + y * srcStride;
-                for (int x = 0; x < w; ++x) {
-                    int u = row[x << 1];
-                    int y0 = row[x << 1 | 1];
-                    int v = (x + 1) < w ? row[(x + 1) << 1] : u;
-                    int r = y0 + (351 * (v - 128)) / 256;
-                    int g = y0 - (179 * (v - 128) + 86 * (u - 128)) / 256;
-                    int b = y0 + (443 * (u - 128)) / 256;
-                    dst[(y * w + x) * 3 + 0] = static_cast<std::uint8_t>(std::max(0, std::min(255, r)));
-                    dst[(y * w + x) * 3 + 1] = static_cast<std::uint8_t>(std::max(0, std::min(255, g)));
-                    dst[(y * w + x) * 3 + 2] = static_cast<std::uint8_t>(std::max(0, std::min(255, b)));
-                }
+        }
+        std::uint8_t* dst = acquireFrame();
+        convertPixels(format, record.data + sizeof(CameraFramePacket), stride, outputFormat_, dst, width, height);
+        pushFrame(captureNs);
+        return;
+    }
+}
+bool CameraSourceNode::initStreamMode() {
+    PixelFormat wanted = requestedFormat();
+    outputFormat_ = canConvertPixels(PixelFormat::NV12, wanted) ? wanted : PixelFormat::NV12;
+    captureFormat_ = PixelFormat::NV12;
+    frameHeader_ = CameraFramePacket{};  // 首帧到达时按解码尺寸设置
+
+    StreamIngestConfig cfg;
+    cfg.uri = config_.uri;
+    cfg.decoder = parseStreamDecoder(config_.decoder);
+    cfg.transport = config_.streamTransport;
+    cfg.jitterNs = static_cast<std::int64_t>(config_.jitterMs) * 1'000'000;
+    cfg.lowLatency = config_.lowLatency;
+    stream_ = std::make_unique<StreamIngest>(cfg, framePool_);
+    if (!stream_->start([this](BufferRef frame, std::int64_t captureNs) {
+            onStreamFrame(std::move(frame), captureNs);
+        })) {
+        stream_.reset();
+        return false;
+    }
+    FM_LOG_INFO("CameraSourceNode", "stream started: ", config_.uri, " decoder=",
+                streamDecoderName(stream_->activeDecoder()), " output=", pixelFormatName(outputFormat_),
+                config_.lowLatency ? std::string(" (low latency)") : " jitter=" + std::to_string(config_.jitterMs) + "ms");
+    return true;
+}
+
+void CameraSourceNode::onStreamFrame(BufferRef frame, std::int64_t captureNs) {
+    if (capturePaused_.load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> lock(captureMutex_);
+    if (capturePaused_.load(std::memory_order_acquire)) return;
+    applyPendingControls();
+    if (rateLimited(captureNs)) return;
+
+    CameraFramePacket header{};
+    std::memcpy(&header, frame.data(), sizeof(CameraFramePacket));
+    if (header.width != frameHeader_.width || header.height != frameHeader_.height) {
+        setOutputHeader(header.width, header.height, outputFormat_ == PixelFormat::NV12 ? header.stride : 0);
+    }
+    if (outputFormat_ == PixelFormat::NV12) {
+        frame_ = std::move(frame);  // 解码输出已是完整的 NV12 帧，直接推送
+    } else {
+        std::uint8_t* dst = acquireFrame();
+        convertPixels(PixelFormat::NV12, frame.data() + sizeof(CameraFramePacket), header.stride, outputFormat_, dst,
+                      header.width, header.height);
+    }
+    pushFrame(captureNs);
+}
+
+StreamDecoder CameraSourceNode::streamDecoder() const noexcept {
+    return stream_ ? stream_->activeDecoder() : StreamDecoder::Auto;
+}
+
+StreamIngestStats CameraSourceNode::streamStats() const {
+    return stream_ ? stream_->stats() : StreamIngestStats{};
+}
+
+bool CameraSourceNode::cropToRoi(std::int64_t captureNs, FrameRegion& region) {
+    const int32_t sourceWidth = frameHeader_.width;
+    const int32_t sourceHeight = frameHeader_.height;
+    const int32_t width = std::min(static_cast<int32_t>(config_.roiWidth), sourceWidth) & ~1;
+    const int32_t height = std::min(static_cast<int32_t>(config_.roiHeight), sourceHeight) & ~1;
+    if (!frame_ || width <= 0 || height <= 0) return false;
+    if (width >= sourceWidth && height >= sourceHeight) return true;  // 窗口不小于整帧：原样推送
+
+    ImageRect rect = roi_->window(captureNs, width, height, sourceWidth, sourceHeight);
+    // x 按 8 像素、y 按 2 行对齐：子视图帧头 8 字节对齐，NV12 色度与 YUYV 宏像素不被拆开
+    rect.x &= ~7;
+    rect.y &= ~1;
+    region = FrameRegion{rect.x, rect.y, sourceWidth, sourceHeight};
+
+    const std::size_t stride = static_cast<std::size_t>(frameHeader_.stride);
+    const std::size_t rowBytes = static_cast<std::size_t>(pixelFormatMinStride(outputFormat_, width));
+    const std::size_t offset = static_cast<std::size_t>(rect.y) * stride +
+                               static_cast<std::size_t>(pixelFormatMinStride(outputFormat_, rect.x));
+    CameraFramePacket header = frameHeader_;
+    header.width = width;
+    header.height = height;
+
+    if (outputFormat_ != PixelFormat::NV12 && stride % 8 == 0 &&
+        sizeof(CameraFramePacket) + offset + stride * static_cast<std::size_t>(height) <= frame_.size()) {
+        // 子视图：帧头写在窗口首像素之前（覆盖的是窗口外的像素或原帧头），沿用整帧行宽；持有整帧直到下游释放
+        std::uint8_t* base = frame_.mutableData();
+        std::memcpy(base + offset, &header, sizeof(CameraFramePacket));
+        auto parent = std::make_shared<BufferRef>(std::move(frame_));
+        frame_ = BufferRef::wrap(base + offset, sizeof(CameraFramePacket) + stride * static_cast<std::size_t>(height),
+                                 std::move(parent));
+        return true;
+    }
+
+    // NV12（色度平面位于整帧之后）或无法对齐：只拷贝窗口
+    const BufferRef full = std::move(frame_);
+    const std::uint8_t* src = full.data() + sizeof(CameraFramePacket);
+    header.stride = static_cast<int32_t>(rowBytes);
+    const std::size_t rows = outputFormat_ == PixelFormat::NV12 ? static_cast<std::size_t>(height) * 3 / 2
+                                                                : static_cast<std::size_t>(height);
+    frame_ = framePool_.acquire(core::BufferPoolKey{width, height, header.format},
+                                sizeof(CameraFramePacket) + rowBytes * rows);
+    std::uint8_t* dst = frame_.mutableData();
+    std::memcpy(dst, &header, sizeof(CameraFramePacket));
+    dst += sizeof(CameraFramePacket);
+    for (int32_t r = 0; r < height; ++r) {
+        std::memcpy(dst + static_cast<std::size_t>(r) * rowBytes, src + offset + static_cast<std::size_t>(r) * stride,
+                    rowBytes);
+    }
+    if (outputFormat_ == PixelFormat::NV12) {
+        const std::uint8_t* uv = src + stride * static_cast<std::size_t>(sourceHeight) +
+                                 static_cast<std::size_t>(rect.y / 2) * stride + static_cast<std::size_t>(rect.x);
+        std::uint8_t* dstUv = dst + rowBytes * static_cast<std::size_t>(height);
+        for (int32_t r = 0; r < height / 2; ++r) {
+            std::memcpy(dstUv + static_cast<std::size_t>(r) * rowBytes, uv + static_cast<std::size_t>(r) * stride,
+                        rowBytes);
+        }
+    }
+    roiCopiedFrames_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void CameraSourceNode::pushFrame(std::int64_t captureNs) {
+    FrameRegion region;
+    if (sensorCrop_) {
+        region = sensorRegion_;
+    } else if (roiActive_ && !cropToRoi(captureNs, region)) {
+        frame_.reset();
+        return;
+    }
+    auto* header = reinterpret_cast<CameraFramePacket*>(frame_.mutableData());
+    header->captureTimestampNs = captureNs;
+    header->frameIndex = frameIndex_;
+    const int32_t width = header->width;
+    const int32_t height = header->height;
+    auto& meta = frame_.mutableMeta();
+    meta.frameIndex = frameIndex_++;
+    meta.video = VideoCaps{outputFormat_, width, height, static_cast<int32_t>(std::lround(config_.fps))};
+    meta.timestampNs = captureNs;
+    meta.region = region;
+    if (outPad_)
+        outPad_->pushBuffer(frame_);
+    frame_.reset();  // 不再持有：下游全部释放后归还缓冲池
+}
+
+void CameraSourceNode::requestMaxFrameRate(const std::string& requester, double fps) {
+    std::lock_guard<std::mutex> lock(rateMutex_);
+    if (fps > 0.0) {
+        rateRequests_[requester] = fps;
+    } else {
+        rateRequests_.erase(requester);
+    }
+    double limit = 0.0;
+    for (const auto& entry : rateRequests_) {
+        limit = std::max(limit, entry.second);
+    }
+    if (limit > 0.0 && config_.fps > 0.0 && limit >= config_.fps) {
+        limit = 0.0;  // 不低于配置帧率即不限
+    }
+    rateLimitFps_.store(limit, std::memory_order_relaxed);
+}
+
+void CameraSourceNode::applyRateLimit(double limit) {
+    appliedRateFps_ = limit;
+    deviceRateLimit_ = false;
+    nextFrameDueNs_ = 0;
+#ifdef __linux__
+    if (v4l2Ready_ && v4l2Fd_ >= 0) {
+        double fps = limit > 0.0 ? limit : config_.fps;
+        if (fps > 0.0) {
+            v4l2_streamparm parm{};
+            parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            parm.parm.capture.timeperframe.numerator = 1000;
+            parm.parm.capture.timeperframe.denominator = static_cast<unsigned>(std::lround(fps * 1000.0));
+            if (ioctl(v4l2Fd_, VIDIOC_S_PARM, &parm) == 0) {
+                deviceRateLimit_ = limit > 0.0;
+            } else if (limit > 0.0) {
+                FM_LOG_WARN("CameraSourceNode", "VIDIOC_S_PARM failed (errno=", errno,
+                            "), dropping frames before conversion instead");
             }
-            header->stride = w * 3;
-            std::strncpy(header->format, "RGB8", sizeof(header->format) - 1);
-            header->format[sizeof(header->format) - 1] = '\0';
-        } else {
-            size_t pixelSize = srcStride * static_cast<size_t>(hh);
-            std::memcpy(dst, src, std::min(pixelSize, v4l2MapLens_[buf.index]));
         }
-        size_t pixelSize = static_cast<size_t>(header->stride) * static_cast<size_t>(header->height);
-        ioctl(v4l2Fd_, VIDIOC_QBUF, &buf);
+    }
+#endif
+    FM_LOG_INFO("CameraSourceNode", "frame rate limit ",
+                limit > 0.0 ? std::to_string(limit) + " fps" : std::string("cleared"), deviceRateLimit_ ? " (device)" : "");
+}
+
+bool CameraSourceNode::rateLimited(std::int64_t captureNs) {
+    if (appliedRateFps_ <= 0.0 || deviceRateLimit_) {
+        return false;
+    }
+    if (captureNs < nextFrameDueNs_) {
+        rateLimitedFrames_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    // 预留 10% 容差，避免采集抖动导致按整数倍丢帧
+    auto period = static_cast<std::int64_t>(1e9 / appliedRateFps_);
+    nextFrameDueNs_ = captureNs + period * 9 / 10;
+    return false;
+}
 
-        auto pad = getPad("video_out");
-        if (pad)
-            pad->pushToConnections(frameBuffer_.data(), sizeof(CameraFramePacket) + pixelSize);
+bool CameraSourceNode::applyPendingControls() {
+    double limit = rateLimitFps_.load(std::memory_order_relaxed);
+    if (limit != appliedRateFps_) {
+        applyRateLimit(limit);
+    }
+    bool flush = flushPending_.exchange(false, std::memory_order_relaxed);
+    if (flush) {
+        nextFrameDueNs_ = 0;
+    }
+    return flush;
+}
+void CameraSourceNode::process() {
+    if (!started_ || captureThread_.joinable() || stream_) return;  // 采集/取流线程在帧到达时自行推送
+
+    bool flush = applyPendingControls();
+#ifdef __linux__
+    if (v4l2Ready_ && v4l2Fd_ >= 0) {
+        captureV4L2Frame(flush);
         return;
     }
+#else
+    (void)flush;
 #endif
 
+    if (fileMode_ && fileReader_) {
+        if (!rateLimited(core::PipelineClock::nowNs())) pushCaptureRecord();
+        return;
+    }
     if (fileMode_ && fileStream_.is_open()) {
-        std::uint8_t* dst = frameBuffer_.data() + sizeof(CameraFramePacket);
-        fileStream_.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(fileFrameBytes_));
+        if (rateLimited(core::PipelineClock::nowNs())) {
+            return;
+        }
+        std::uint8_t* dst = acquireFrame();
+        bool direct = (captureFormat_ == outputFormat_);
+        std::uint8_t* readTo = direct ? dst : fileScratch_.data();
+        fileStream_.read(reinterpret_cast<char*>(readTo), static_cast<std::streamsize>(fileFrameBytes_));
+        std::int64_t captureNs = core::PipelineClock::nowNs();  // 回放：以读出时刻作为采集时刻
         if (fileStream_.gcount() == static_cast<std::streamsize>(fileFrameBytes_)) {
-            auto pad = getPad("video_out");
-            if (pad)
-                pad->pushToConnections(frameBuffer_.data(), sizeof(CameraFramePacket) + fileFrameBytes_);
+            if (!direct) {
+                convertPixels(captureFormat_, readTo, static_cast<int32_t>(fileWidth_ * 3), outputFormat_, dst,
+                              static_cast<int32_t>(fileWidth_), static_cast<int32_t>(fileHeight_));
+            }
+            pushFrame(captureNs);
         }
         if (fileStream_.eof()) {
             fileStream_.clear();
@@ -287,8 +1120,8 @@ void CameraSourceNode::process() {
         return;
     }
 
-    std::cout << "[CameraSourceNode] process: stub (no frame) from "
-              << (config_.device.empty() ? config_.uri : config_.device) << std::endl;
+    FM_LOG_DEBUG("CameraSourceNode", "process: stub (no frame) from ",
+                 config_.device.empty() ? config_.uri : config_.device);
 }
 
 } // namespace falconmind::sdk::sensors
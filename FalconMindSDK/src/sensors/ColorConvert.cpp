@@ -0,0 +1,387 @@
+#include "falconmind/sdk/sensors/ColorConvert.h"
+#include "falconmind/sdk/core/Caps.h"
+#include "falconmind/sdk/core/CpuFeatures.h"
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FALCONMIND_COLOR_X86 1
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define FALCONMIND_COLOR_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace falconmind::sdk::sensors {
+
+namespace {
+
+// Q7 定点系数（见 ColorConvert.h）；|系数·128| < 32768，向量实现可全程使用 int16
+constexpr int kRv = 179;
+constexpr int kGu = 44;
+constexpr int kGv = 91;
+constexpr int kBu = 227;
+
+// 无分支饱和（编译为 cmov），随机色度下不产生分支预测失败
+inline std::uint8_t saturate(int v) {
+    v = v < 0 ? 0 : v;
+    return static_cast<std::uint8_t>(v > 255 ? 255 : v);
+}
+
+// 输出通道顺序为模板参数：通道下标是常量，标量循环无顺序分支
+template <core::PixelFormat Out>
+inline void yuvPixel(int y, int d, int e, std::uint8_t* out) {
+    using T = core::PixelFormatTraits<Out>;
+    out[T::rIndex] = saturate(y + ((kRv * e) >> 7));
+    out[1] = saturate(y - ((kGu * d + kGv * e) >> 7));
+    out[T::bIndex] = saturate(y + ((kBu * d) >> 7));
+}
+
+// 行内核：从像素 x0（偶数）起转换到行尾；向量内核处理整块后把余下像素交给标量内核
+using YuyvRowFn = void (*)(const std::uint8_t* src, std::uint8_t* dst, std::int32_t x0, std::int32_t w, bool bgr);
+using Nv12RowFn = void (*)(const std::uint8_t* yRow, const std::uint8_t* uvRow, std::uint8_t* dst,
+                           std::int32_t x0, std::int32_t w, bool bgr);
+
+// 成对像素在循环内处理，奇数宽度的末像素在循环外单独处理
+template <core::PixelFormat Out>
+void yuyvRowScalarT(const std::uint8_t* src, std::uint8_t* dst, std::int32_t x0, std::int32_t w) {
+    std::int32_t x = x0;
+    for (; x + 1 < w; x += 2) {
+        const std::uint8_t* pair = src + static_cast<std::size_t>(x) * 2;
+        const int d = pair[1] - 128;
+        const int e = pair[3] - 128;
+        yuvPixel<Out>(pair[0], d, e, dst + static_cast<std::size_t>(x) * 3);
+        yuvPixel<Out>(pair[2], d, e, dst + static_cast<std::size_t>(x + 1) * 3);
+    }
+    if (x < w) {
+        const std::uint8_t* pair = src + static_cast<std::size_t>(x) * 2;
+        yuvPixel<Out>(pair[0], pair[1] - 128, pair[3] - 128, dst + static_cast<std::size_t>(x) * 3);
+    }
+}
+
+template <core::PixelFormat Out>
+void nv12RowScalarT(const std::uint8_t* yRow, const std::uint8_t* uvRow, std::uint8_t* dst,
+                    std::int32_t x0, std::int32_t w) {
+    std::int32_t x = x0;
+    for (; x + 1 < w; x += 2) {
+        const int d = uvRow[x] - 128;
+        const int e = uvRow[x + 1] - 128;
+        yuvPixel<Out>(yRow[x], d, e, dst + static_cast<std::size_t>(x) * 3);
+        yuvPixel<Out>(yRow[x + 1], d, e, dst + static_cast<std::size_t>(x + 1) * 3);
+    }
+    if (x < w) {
+        // 奇数宽度：紧凑 UV 行没有末像素的 V
+        yuvPixel<Out>(yRow[x], uvRow[x] - 128, 0, dst + static_cast<std::size_t>(x) * 3);
+    }
+}
+
+void yuyvRowScalar(const std::uint8_t* src, std::uint8_t* dst, std::int32_t x0, std::int32_t w, bool bgr) {
+    if (bgr) {
+        yuyvRowScalarT<core::PixelFormat::BGR8>(src, dst, x0, w);
+    } else {
+        yuyvRowScalarT<core::PixelFormat::RGB8>(src, dst, x0, w);
+    }
+}
+
+void nv12RowScalar(const std::uint8_t* yRow, const std::uint8_t* uvRow, std::uint8_t* dst,
+                   std::int32_t x0, std::int32_t w, bool bgr) {
+    if (bgr) {
+        nv12RowScalarT<core::PixelFormat::BGR8>(yRow, uvRow, dst, x0, w);
+    } else {
+        nv12RowScalarT<core::PixelFormat::RGB8>(yRow, uvRow, dst, x0, w);
+    }
+}
+
+#ifdef FALCONMIND_COLOR_X86
+
+// 16 个 R/G/B 字节交错为 48 字节 RGB：每个 16 字节输出块由三个 pshufb 结果按位或得到
+struct InterleaveMasks {
+    alignas(16) std::uint8_t m[3][3][16];  // [输出块][通道][字节]
+};
+
+const InterleaveMasks& interleaveMasks() {
+    static const InterleaveMasks masks = [] {
+        InterleaveMasks t{};
+        for (int k = 0; k < 3; ++k) {
+            for (int j = 0; j < 16; ++j) {
+                int pos = k * 16 + j;
+                for (int ch = 0; ch < 3; ++ch) {
+                    t.m[k][ch][j] = (pos % 3 == ch) ? static_cast<std::uint8_t>(pos / 3) : 0x80;
+                }
+            }
+        }
+        return t;
+    }();
+    return masks;
+}
+
+__attribute__((target("sse4.1"))) inline void store48(std::uint8_t* dst, __m128i r, __m128i g, __m128i b,
+                                                       const InterleaveMasks& masks) {
+    for (int k = 0; k < 3; ++k) {
+        __m128i out = _mm_or_si128(
+            _mm_or_si128(_mm_shuffle_epi8(r, _mm_load_si128(reinterpret_cast<const __m128i*>(masks.m[k][0]))),
+                         _mm_shuffle_epi8(g, _mm_load_si128(reinterpret_cast<const __m128i*>(masks.m[k][1])))),
+            _mm_shuffle_epi8(b, _mm_load_si128(reinterpret_cast<const __m128i*>(masks.m[k][2]))));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k * 16), out);
+    }
+}
+
+// 8 像素：y 为 int16 亮度，uv 为交错的 4 组 U/V（int16）；每组 UV 复制给相邻两个像素
+__attribute__((target("sse4.1"))) inline void yuv8(__m128i y, __m128i uv, __m128i& r, __m128i& g, __m128i& b) {
+    const __m128i dupU = _mm_setr_epi8(0, 1, 0, 1, 4, 5, 4, 5, 8, 9, 8, 9, 12, 13, 12, 13);
+    const __m128i dupV = _mm_setr_epi8(2, 3, 2, 3, 6, 7, 6, 7, 10, 11, 10, 11, 14, 15, 14, 15);
+    const __m128i bias = _mm_set1_epi16(128);
+    __m128i d = _mm_sub_epi16(_mm_shuffle_epi8(uv, dupU), bias);
+    __m128i e = _mm_sub_epi16(_mm_shuffle_epi8(uv, dupV), bias);
+    r = _mm_add_epi16(y, _mm_srai_epi16(_mm_mullo_epi16(e, _mm_set1_epi16(kRv)), 7));
+    g = _mm_sub_epi16(y, _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(d, _mm_set1_epi16(kGu)),
+                                                      _mm_mullo_epi16(e, _mm_set1_epi16(kGv))), 7));
+    b = _mm_add_epi16(y, _mm_srai_epi16(_mm_mullo_epi16(d, _mm_set1_epi16(kBu)), 7));
+}
+
+__attribute__((target("sse4.1"))) void yuyvRowSse41(const std::uint8_t* src, std::uint8_t* dst, std::int32_t x0,
+                                                     std::int32_t w, bool bgr) {
+    const InterleaveMasks& masks = interleaveMasks();
+    const __m128i lumaMask = _mm_set1_epi16(0x00FF);
+    std::int32_t x = x0;
+    for (; x + 16 <= w; x += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + static_cast<std::size_t>(x) * 2));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + static_cast<std::size_t>(x) * 2 + 16));
+        __m128i ra, ga, ba, rc, gc, bc;
+        yuv8(_mm_and_si128(a, lumaMask), _mm_srli_epi16(a, 8), ra, ga, ba);
+        yuv8(_mm_and_si128(c, lumaMask), _mm_srli_epi16(c, 8), rc, gc, bc);
+        __m128i r = _mm_packus_epi16(ra, rc);
+        __m128i g = _mm_packus_epi16(ga, gc);
+        __m128i b = _mm_packus_epi16(ba, bc);
+        store48(dst + static_cast<std::size_t>(x) * 3, bgr ? b : r, g, bgr ? r : b, masks);
+    }
+    yuyvRowScalar(src, dst, x, w, bgr);
+}
+
+__attribute__((target("sse4.1"))) void nv12RowSse41(const std::uint8_t* yRow, const std::uint8_t* uvRow,
+                                                     std::uint8_t* dst, std::int32_t x0, std::int32_t w, bool bgr) {
+    const InterleaveMasks& masks = interleaveMasks();
+    std::int32_t x = x0;
+    for (; x + 16 <= w; x += 16) {
+        __m128i yv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(yRow + x));
+        __m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uvRow + x));
+        __m128i ra, ga, ba, rc, gc, bc;
+        yuv8(_mm_cvtepu8_epi16(yv), _mm_cvtepu8_epi16(uv), ra, ga, ba);
+        yuv8(_mm_cvtepu8_epi16(_mm_srli_si128(yv, 8)), _mm_cvtepu8_epi16(_mm_srli_si128(uv, 8)), rc, gc, bc);
+        __m128i r = _mm_packus_epi16(ra, rc);
+        __m128i g = _mm_packus_epi16(ga, gc);
+        __m128i b = _mm_packus_epi16(ba, bc);
+        store48(dst + static_cast<std::size_t>(x) * 3, bgr ? b : r, g, bgr ? r : b, masks);
+    }
+    nv12RowScalar(yRow, uvRow, dst, x, w, bgr);
+}
+
+// AVX2：每 128 位 lane 内与 yuv8 相同（pshufb 不跨 lane）
+__attribute__((target("avx2"))) inline void yuv16(__m256i y, __m256i uv, __m256i& r, __m256i& g, __m256i& b) {
+    const __m256i dupU = _mm256_setr_epi8(0, 1, 0, 1, 4, 5, 4, 5, 8, 9, 8, 9, 12, 13, 12, 13,
+                                          0, 1, 0, 1, 4, 5, 4, 5, 8, 9, 8, 9, 12, 13, 12, 13);
+    const __m256i dupV = _mm256_setr_epi8(2, 3, 2, 3, 6, 7, 6, 7, 10, 11, 10, 11, 14, 15, 14, 15,
+                                          2, 3, 2, 3, 6, 7, 6, 7, 10, 11, 10, 11, 14, 15, 14, 15);
+    const __m256i bias = _mm256_set1_epi16(128);
+    __m256i d = _mm256_sub_epi16(_mm256_shuffle_epi8(uv, dupU), bias);
+    __m256i e = _mm256_sub_epi16(_mm256_shuffle_epi8(uv, dupV), bias);
+    r = _mm256_add_epi16(y, _mm256_srai_epi16(_mm256_mullo_epi16(e, _mm256_set1_epi16(kRv)), 7));
+    g = _mm256_sub_epi16(y, _mm256_srai_epi16(_mm256_add_epi16(_mm256_mullo_epi16(d, _mm256_set1_epi16(kGu)),
+                                                               _mm256_mullo_epi16(e, _mm256_set1_epi16(kGv))), 7));
+    b = _mm256_add_epi16(y, _mm256_srai_epi16(_mm256_mullo_epi16(d, _mm256_set1_epi16(kBu)), 7));
+}
+
+// 两组 16 像素的 int16 结果 → 32 个连续像素的 uint8（packus 按 lane 交织，permute 恢复顺序）
+__attribute__((target("avx2"))) inline __m256i pack32(__m256i lo, __m256i hi) {
+    return _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+}
+
+__attribute__((target("avx2"))) inline void store96(std::uint8_t* dst, __m256i r, __m256i g, __m256i b,
+                                                     const InterleaveMasks& masks) {
+    store48(dst, _mm256_castsi256_si128(r), _mm256_castsi256_si128(g), _mm256_castsi256_si128(b), masks);
+    store48(dst + 48, _mm256_extracti128_si256(r, 1), _mm256_extracti128_si256(g, 1),
+            _mm256_extracti128_si256(b, 1), masks);
+}
+
+__attribute__((target("avx2"))) void yuyvRowAvx2(const std::uint8_t* src, std::uint8_t* dst, std::int32_t x0,
+                                                  std::int32_t w, bool bgr) {
+    const InterleaveMasks& masks = interleaveMasks();
+    const __m256i lumaMask = _mm256_set1_epi16(0x00FF);
+    std::int32_t x = x0;
+    for (; x + 32 <= w; x += 32) {
+        const std::uint8_t* p = src + static_cast<std::size_t>(x) * 2;
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+        __m256i ra, ga, ba, rc, gc, bc;
+        yuv16(_mm256_and_si256(a, lumaMask), _mm256_srli_epi16(a, 8), ra, ga, ba);
+        yuv16(_mm256_and_si256(c, lumaMask), _mm256_srli_epi16(c, 8), rc, gc, bc);
+        __m256i r = pack32(ra, rc);
+        __m256i g = pack32(ga, gc);
+        __m256i b = pack32(ba, bc);
+        store96(dst + static_cast<std::size_t>(x) * 3, bgr ? b : r, g, bgr ? r : b, masks);
+    }
+    yuyvRowSse41(src, dst, x, w, bgr);
+}
+
+__attribute__((target("avx2"))) void nv12RowAvx2(const std::uint8_t* yRow, const std::uint8_t* uvRow,
+                                                  std::uint8_t* dst, std::int32_t x0, std::int32_t w, bool bgr) {
+    const InterleaveMasks& masks = interleaveMasks();
+    std::int32_t x = x0;
+    for (; x + 32 <= w; x += 32) {
+        __m256i yv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(yRow + x));
+        __m256i uv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(uvRow + x));
+        __m256i ra, ga, ba, rc, gc, bc;
+        yuv16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(yv)), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(uv)),
+              ra, ga, ba);
+        yuv16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(yv, 1)),
+              _mm256_cvtepu8_epi16(_mm256_extracti128_si256(uv, 1)), rc, gc, bc);
+        __m256i r = pack32(ra, rc);
+        __m256i g = pack32(ga, gc);
+        __m256i b = pack32(ba, bc);
+        store96(dst + static_cast<std::size_t>(x) * 3, bgr ? b : r, g, bgr ? r : b, masks);
+    }
+    nv12RowSse41(yRow, uvRow, dst, x, w, bgr);
+}
+
+#endif // FALCONMIND_COLOR_X86
+
+#ifdef FALCONMIND_COLOR_NEON
+
+// 16 像素：ye/yo 为偶/奇像素亮度，u/v 为 8 组色度；偶奇结果经 zip 恢复像素顺序后 vst3 交错写出
+inline void neonStore16(uint8x8_t ye, uint8x8_t yo, uint8x8_t u, uint8x8_t v, std::uint8_t* dst, bool bgr) {
+    int16x8_t d = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u)), vdupq_n_s16(128));
+    int16x8_t e = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), vdupq_n_s16(128));
+    int16x8_t rt = vshrq_n_s16(vmulq_n_s16(e, kRv), 7);
+    int16x8_t gt = vshrq_n_s16(vaddq_s16(vmulq_n_s16(d, kGu), vmulq_n_s16(e, kGv)), 7);
+    int16x8_t bt = vshrq_n_s16(vmulq_n_s16(d, kBu), 7);
+    int16x8_t y0 = vreinterpretq_s16_u16(vmovl_u8(ye));
+    int16x8_t y1 = vreinterpretq_s16_u16(vmovl_u8(yo));
+    uint8x8x2_t r = vzip_u8(vqmovun_s16(vaddq_s16(y0, rt)), vqmovun_s16(vaddq_s16(y1, rt)));
+    uint8x8x2_t g = vzip_u8(vqmovun_s16(vsubq_s16(y0, gt)), vqmovun_s16(vsubq_s16(y1, gt)));
+    uint8x8x2_t b = vzip_u8(vqmovun_s16(vaddq_s16(y0, bt)), vqmovun_s16(vaddq_s16(y1, bt)));
+    uint8x16x3_t out;
+    out.val[bgr ? 2 : 0] = vcombine_u8(r.val[0], r.val[1]);
+    out.val[1] = vcombine_u8(g.val[0], g.val[1]);
+    out.val[bgr ? 0 : 2] = vcombine_u8(b.val[0], b.val[1]);
+    vst3q_u8(dst, out);
+}
+
+void yuyvRowNeon(const std::uint8_t* src, std::uint8_t* dst, std::int32_t x0, std::int32_t w, bool bgr) {
+    std::int32_t x = x0;
+    for (; x + 16 <= w; x += 16) {
+        uint8x8x4_t q = vld4_u8(src + static_cast<std::size_t>(x) * 2);  // Y0 U Y1 V 解交错
+        neonStore16(q.val[0], q.val[2], q.val[1], q.val[3], dst + static_cast<std::size_t>(x) * 3, bgr);
+    }
+    yuyvRowScalar(src, dst, x, w, bgr);
+}
+
+void nv12RowNeon(const std::uint8_t* yRow, const std::uint8_t* uvRow, std::uint8_t* dst,
+                 std::int32_t x0, std::int32_t w, bool bgr) {
+    std::int32_t x = x0;
+    for (; x + 16 <= w; x += 16) {
+        uint8x8x2_t y = vld2_u8(yRow + x);
+        uint8x8x2_t uv = vld2_u8(uvRow + x);
+        neonStore16(y.val[0], y.val[1], uv.val[0], uv.val[1], dst + static_cast<std::size_t>(x) * 3, bgr);
+    }
+    nv12RowScalar(yRow, uvRow, dst, x, w, bgr);
+}
+
+#endif // FALCONMIND_COLOR_NEON
+
+struct KernelRows {
+    YuyvRowFn yuyv;
+    Nv12RowFn nv12;
+};
+
+KernelRows rowsFor(ColorKernel kernel) {
+    switch (kernel) {
+#ifdef FALCONMIND_COLOR_X86
+        case ColorKernel::Sse41: return {yuyvRowSse41, nv12RowSse41};
+        case ColorKernel::Avx2: return {yuyvRowAvx2, nv12RowAvx2};
+#endif
+#ifdef FALCONMIND_COLOR_NEON
+        case ColorKernel::Neon: return {yuyvRowNeon, nv12RowNeon};
+#endif
+        default: return {yuyvRowScalar, nv12RowScalar};
+    }
+}
+
+ColorKernel detectKernel() {
+    for (ColorKernel k : {ColorKernel::Neon, ColorKernel::Avx2, ColorKernel::Sse41}) {
+        if (colorKernelSupported(k)) return k;
+    }
+    return ColorKernel::Scalar;
+}
+
+std::atomic<ColorKernel>& kernelSlot() {
+    static std::atomic<ColorKernel> slot{detectKernel()};
+    return slot;
+}
+
+} // namespace
+
+const char* colorKernelName(ColorKernel kernel) noexcept {
+    switch (kernel) {
+        case ColorKernel::Scalar: return "scalar";
+        case ColorKernel::Sse41: return "sse4.1";
+        case ColorKernel::Avx2: return "avx2";
+        case ColorKernel::Neon: return "neon";
+    }
+    return "unknown";
+}
+
+bool colorKernelSupported(ColorKernel kernel) noexcept {
+    switch (kernel) {
+        case ColorKernel::Scalar: return true;
+#ifdef FALCONMIND_COLOR_X86
+        case ColorKernel::Sse41: return core::cpuFeatures().sse41;
+        case ColorKernel::Avx2: return core::cpuFeatures().avx2;
+#endif
+#ifdef FALCONMIND_COLOR_NEON
+        case ColorKernel::Neon: return true;
+#endif
+        default: return false;
+    }
+}
+
+ColorKernel activeColorKernel() noexcept {
+    return kernelSlot().load(std::memory_order_relaxed);
+}
+
+bool setColorKernel(ColorKernel kernel) noexcept {
+    if (!colorKernelSupported(kernel)) return false;
+    kernelSlot().store(kernel, std::memory_order_relaxed);
+    return true;
+}
+
+void convertYuyvToRgb(const std::uint8_t* src, std::int32_t srcStride, std::uint8_t* dst,
+                      std::int32_t width, std::int32_t height, bool bgr) {
+    YuyvRowFn row = rowsFor(activeColorKernel()).yuyv;
+    for (std::int32_t y = 0; y < height; ++y) {
+        row(src + static_cast<std::size_t>(y) * srcStride, dst + static_cast<std::size_t>(y) * width * 3, 0, width, bgr);
+    }
+}
+
+void convertNv12ToRgb(const std::uint8_t* src, std::int32_t srcStride, std::uint8_t* dst,
+                      std::int32_t width, std::int32_t height, bool bgr) {
+    Nv12RowFn row = rowsFor(activeColorKernel()).nv12;
+    const std::uint8_t* uvPlane = src + static_cast<std::size_t>(srcStride) * height;
+    for (std::int32_t y = 0; y < height; ++y) {
+        row(src + static_cast<std::size_t>(y) * srcStride, uvPlane + static_cast<std::size_t>(y / 2) * srcStride,
+            dst + static_cast<std::size_t>(y) * width * 3, 0, width, bgr);
+    }
+}
+
+void convertYuyvRowToRgb(const std::uint8_t* src, std::uint8_t* dst, std::int32_t width, bool bgr) {
+    rowsFor(activeColorKernel()).yuyv(src, dst, 0, width, bgr);
+}
+
+void convertNv12RowToRgb(const std::uint8_t* yRow, const std::uint8_t* uvRow, std::uint8_t* dst,
+                         std::int32_t width, bool bgr) {
+    rowsFor(activeColorKernel()).nv12(yRow, uvRow, dst, 0, width, bgr);
+}
+
+} // namespace falconmind::sdk::sensors
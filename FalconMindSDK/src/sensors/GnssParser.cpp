@@ -0,0 +1,334 @@
+#include "falconmind/sdk/sensors/GnssParser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace falconmind::sdk::sensors {
+
+namespace {
+
+constexpr std::uint8_t kUbxSync1 = 0xB5;
+constexpr std::uint8_t kUbxSync2 = 0x62;
+constexpr std::size_t kMaxFields = 24;
+constexpr std::int64_t kNsPerSecond = 1'000'000'000;
+constexpr std::int64_t kNsPerDay = 86'400 * kNsPerSecond;
+
+struct Field {
+    const char* data{nullptr};
+    std::size_t size{0};
+    bool empty() const noexcept { return size == 0; }
+};
+
+bool toDouble(const Field& f, double& out) {
+    if (f.empty()) return false;
+    auto res = std::from_chars(f.data, f.data + f.size, out);
+    return res.ec == std::errc() && res.ptr == f.data + f.size;
+}
+
+bool toInt(const Field& f, int& out) {
+    if (f.empty()) return false;
+    auto res = std::from_chars(f.data, f.data + f.size, out);
+    return res.ec == std::errc() && res.ptr == f.data + f.size;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// 公历日期 → 1970-01-01 起天数（Howard Hinnant days_from_civil）
+std::int64_t daysFromCivil(int y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return static_cast<std::int64_t>(era) * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+// ddmm.mmmm + 半球 → 十进制度
+bool toDegrees(const Field& value, const Field& hemisphere, double& out) {
+    double raw = 0.;
+    if (!toDouble(value, raw)) return false;
+    const double deg = std::floor(raw / 100.);
+    out = deg + (raw - deg * 100.) / 60.;
+    if (!hemisphere.empty() && (hemisphere.data[0] == 'S' || hemisphere.data[0] == 'W')) out = -out;
+    return true;
+}
+
+// hhmmss.sss → 当日纳秒
+bool toTimeOfDayNs(const Field& f, std::int64_t& out) {
+    double raw = 0.;
+    if (f.size < 6 || !toDouble(f, raw)) return false;
+    const int hh = (f.data[0] - '0') * 10 + (f.data[1] - '0');
+    const int mm = (f.data[2] - '0') * 10 + (f.data[3] - '0');
+    const double ss = raw - std::floor(raw / 100.) * 100.;
+    out = (static_cast<std::int64_t>(hh) * 3600 + mm * 60) * kNsPerSecond + std::llround(ss * 1e9);
+    return true;
+}
+
+template <typename T>
+T readLe(const std::uint8_t* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));  // UBX 为小端，与目标平台一致
+    return v;
+}
+
+constexpr double kKnotsToMps = 1852.0 / 3600.0;
+
+} // namespace
+
+void GnssParser::reset() noexcept {
+    state_ = State::Idle;
+    nmeaLength_ = 0;
+    ubxLength_ = 0;
+    ubxExpected_ = 0;
+    ggaSeen_ = false;
+    utcDay_ = -1;
+    ubxHdop_ = 99.f;
+    ubxVdop_ = 99.f;
+    current_ = GnssSample{};
+    fixReady_ = false;
+}
+
+std::size_t GnssParser::feed(const std::uint8_t* data, std::size_t size, std::uint64_t arrivalNs) {
+    std::size_t i = 0;
+    while (i < size && !fixReady_) {
+        const std::uint8_t b = data[i++];
+        switch (state_) {
+        case State::Idle:
+            if (b == '$') {
+                nmeaLength_ = 0;
+                state_ = State::Nmea;
+            } else if (b == kUbxSync1) {
+                state_ = State::UbxSync;
+            }
+            break;
+        case State::Nmea:
+            if (b == '\r' || b == '\n') {
+                handleNmea(arrivalNs);
+                state_ = State::Idle;
+            } else if (b == '$') {
+                ++stats_.malformed;  // 语句被截断，从新的 '$' 重新开始
+                nmeaLength_ = 0;
+            } else if (nmeaLength_ == nmea_.size()) {
+                ++stats_.malformed;
+                state_ = State::Idle;
+            } else {
+                nmea_[nmeaLength_++] = static_cast<char>(b);
+            }
+            break;
+        case State::UbxSync:
+            if (b == kUbxSync2) {
+                ubxLength_ = 0;
+                state_ = State::UbxHeader;
+            } else {
+                state_ = b == '$' ? State::Nmea : State::Idle;
+                nmeaLength_ = 0;
+            }
+            break;
+        case State::UbxHeader:
+            ubx_[ubxLength_++] = b;
+            if (ubxLength_ == 4) {
+                const std::size_t payload = readLe<std::uint16_t>(&ubx_[2]);
+                if (payload > kMaxUbxPayload) {
+                    ++stats_.malformed;
+                    ubxExpected_ = payload + 2;
+                    state_ = State::UbxSkip;
+                } else {
+                    ubxExpected_ = 4 + payload + 2;
+                    state_ = State::UbxPayload;
+                }
+            }
+            break;
+        case State::UbxPayload: {
+            // 整段拷贝，避免逐字节状态分派
+            --i;
+            const std::size_t n = std::min(ubxExpected_ - ubxLength_, size - i);
+            std::memcpy(&ubx_[ubxLength_], data + i, n);
+            ubxLength_ += n;
+            i += n;
+            if (ubxLength_ == ubxExpected_) {
+                handleUbx(arrivalNs);
+                state_ = State::Idle;
+            }
+            break;
+        }
+        case State::UbxSkip: {
+            --i;
+            const std::size_t n = std::min(ubxExpected_, size - i);
+            ubxExpected_ -= n;
+            i += n;
+            if (ubxExpected_ == 0) state_ = State::Idle;
+            break;
+        }
+        }
+    }
+    return i;
+}
+
+void GnssParser::handleNmea(std::uint64_t arrivalNs) {
+    // nmea_ 内容为 '$' 之后、行尾之前：BODY*HH
+    const std::size_t len = nmeaLength_;
+    if (len < 4 || nmea_[len - 3] != '*') {
+        ++stats_.malformed;
+        return;
+    }
+    const int hi = hexValue(nmea_[len - 2]);
+    const int lo = hexValue(nmea_[len - 1]);
+    if (hi < 0 || lo < 0) {
+        ++stats_.malformed;
+        return;
+    }
+    const std::size_t bodyLength = len - 3;
+    std::uint8_t sum = 0;
+    for (std::size_t k = 0; k < bodyLength; ++k) sum ^= static_cast<std::uint8_t>(nmea_[k]);
+    if (sum != static_cast<std::uint8_t>(hi * 16 + lo)) {
+        ++stats_.checksumErrors;
+        return;
+    }
+    ++stats_.nmeaSentences;
+
+    Field fields[kMaxFields];
+    std::size_t count = 0;
+    const char* begin = nmea_.data();
+    const char* end = begin + bodyLength;
+    for (const char* p = begin; count < kMaxFields; ++p) {
+        if (p == end || *p == ',') {
+            fields[count++] = Field{begin, static_cast<std::size_t>(p - begin)};
+            if (p == end) break;
+            begin = p + 1;
+        }
+    }
+    // 地址字段为 talker(2) + 类型(3)；专有语句（$P...）不处理
+    if (fields[0].size != 5 || fields[0].data[0] == 'P') return;
+    const char* type = fields[0].data + 2;
+    auto field = [&](std::size_t k) { return k < count ? fields[k] : Field{}; };
+
+    if (std::memcmp(type, "GGA", 3) == 0) {
+        if (count < 10) {
+            ++stats_.malformed;
+            return;
+        }
+        int quality = 0;
+        toInt(field(6), quality);
+        current_.fixQuality = static_cast<std::uint8_t>(quality);
+        toDegrees(field(2), field(3), current_.latitude);
+        toDegrees(field(4), field(5), current_.longitude);
+        if (!toInt(field(7), current_.numSatellites)) current_.numSatellites = 0;
+        double v = 0.;
+        current_.hdop = toDouble(field(8), v) ? static_cast<float>(v) : 99.f;
+        if (toDouble(field(9), v)) current_.altitude = v;
+        std::int64_t tod = 0;
+        if (utcDay_ >= 0 && toTimeOfDayNs(field(1), tod)) current_.utcTimeNs = utcDay_ * kNsPerDay + tod;
+        ggaSeen_ = true;
+        emit(current_, arrivalNs);
+    } else if (std::memcmp(type, "RMC", 3) == 0) {
+        if (count < 10) {
+            ++stats_.malformed;
+            return;
+        }
+        const bool valid = !field(2).empty() && field(2).data[0] == 'A';
+        double v = 0.;
+        if (toDouble(field(7), v)) current_.speedMps = static_cast<float>(v * kKnotsToMps);
+        if (toDouble(field(8), v)) current_.courseDeg = static_cast<float>(v);
+        const Field date = field(9);
+        std::int64_t tod = 0;
+        if (date.size == 6 && toTimeOfDayNs(field(1), tod)) {
+            const unsigned dd = (date.data[0] - '0') * 10 + (date.data[1] - '0');
+            const unsigned mo = (date.data[2] - '0') * 10 + (date.data[3] - '0');
+            const int yy = (date.data[4] - '0') * 10 + (date.data[5] - '0');
+            utcDay_ = daysFromCivil(yy < 80 ? 2000 + yy : 1900 + yy, mo, dd);  // 两位年份以 1980 为界
+            current_.utcTimeNs = utcDay_ * kNsPerDay + tod;
+        }
+        if (!ggaSeen_) {
+            // 只输出 RMC 的接收机：RMC 即为定位主语句
+            current_.fixQuality = valid ? 1 : 0;
+            toDegrees(field(3), field(4), current_.latitude);
+            toDegrees(field(5), field(6), current_.longitude);
+            emit(current_, arrivalNs);
+        }
+    } else if (std::memcmp(type, "GSA", 3) == 0) {
+        double v = 0.;
+        if (toDouble(field(15), v)) current_.pdop = static_cast<float>(v);
+        if (!ggaSeen_ && toDouble(field(16), v)) current_.hdop = static_cast<float>(v);
+        if (toDouble(field(17), v)) current_.vdop = static_cast<float>(v);
+    } else if (std::memcmp(type, "VTG", 3) == 0) {
+        double v = 0.;
+        if (toDouble(field(1), v)) current_.courseDeg = static_cast<float>(v);
+        if (toDouble(field(7), v)) {
+            current_.speedMps = static_cast<float>(v / 3.6);
+        } else if (toDouble(field(5), v)) {
+            current_.speedMps = static_cast<float>(v * kKnotsToMps);
+        }
+    }
+}
+
+void GnssParser::handleUbx(std::uint64_t arrivalNs) {
+    const std::size_t payloadLength = ubxExpected_ - 6;
+    std::uint8_t ckA = 0;
+    std::uint8_t ckB = 0;
+    for (std::size_t k = 0; k < 4 + payloadLength; ++k) {
+        ckA = static_cast<std::uint8_t>(ckA + ubx_[k]);
+        ckB = static_cast<std::uint8_t>(ckB + ckA);
+    }
+    if (ckA != ubx_[4 + payloadLength] || ckB != ubx_[5 + payloadLength]) {
+        ++stats_.checksumErrors;
+        return;
+    }
+    ++stats_.ubxMessages;
+    const std::uint8_t cls = ubx_[0];
+    const std::uint8_t id = ubx_[1];
+    const std::uint8_t* p = &ubx_[4];
+
+    if (cls == 0x01 && id == 0x04 && payloadLength >= 18) {  // NAV-DOP
+        ubxVdop_ = readLe<std::uint16_t>(p + 10) * 0.01f;
+        ubxHdop_ = readLe<std::uint16_t>(p + 12) * 0.01f;
+        return;
+    }
+    if (cls != 0x01 || id != 0x07) return;  // 仅 NAV-PVT 形成定位
+    if (payloadLength < 92) {
+        ++stats_.malformed;
+        return;
+    }
+    GnssSample fix;
+    const std::uint8_t valid = p[11];
+    const std::uint8_t fixType = p[20];
+    const std::uint8_t flags = p[21];
+    const bool fixOk = (flags & 0x01) != 0 && fixType >= 2 && fixType <= 4;
+    const unsigned carrier = (flags >> 6) & 0x03;
+    fix.fixQuality = !fixOk ? 0 : carrier == 2 ? 4 : carrier == 1 ? 5 : (flags & 0x02) ? 2 : 1;
+    fix.numSatellites = p[23];
+    fix.longitude = readLe<std::int32_t>(p + 24) * 1e-7;
+    fix.latitude = readLe<std::int32_t>(p + 28) * 1e-7;
+    fix.altitude = readLe<std::int32_t>(p + 36) * 1e-3;  // hMSL，与 GGA 一致
+    fix.horizontalAccuracyM = readLe<std::uint32_t>(p + 40) * 1e-3f;
+    fix.verticalAccuracyM = readLe<std::uint32_t>(p + 44) * 1e-3f;
+    fix.velNorth = readLe<std::int32_t>(p + 48) * 1e-3f;
+    fix.velEast = readLe<std::int32_t>(p + 52) * 1e-3f;
+    fix.velDown = readLe<std::int32_t>(p + 56) * 1e-3f;
+    fix.speedMps = readLe<std::int32_t>(p + 60) * 1e-3f;
+    fix.courseDeg = readLe<std::int32_t>(p + 64) * 1e-5f;
+    fix.pdop = readLe<std::uint16_t>(p + 76) * 0.01f;
+    fix.hdop = ubxHdop_;
+    fix.vdop = ubxVdop_;
+    if ((valid & 0x03) == 0x03) {  // validDate && validTime
+        const std::int64_t day = daysFromCivil(readLe<std::uint16_t>(p + 4), p[6], p[7]);
+        fix.utcTimeNs = day * kNsPerDay + (static_cast<std::int64_t>(p[8]) * 3600 + p[9] * 60 + p[10]) * kNsPerSecond +
+                        readLe<std::int32_t>(p + 16);
+    }
+    emit(fix, arrivalNs);
+}
+
+void GnssParser::emit(const GnssSample& fix, std::uint64_t arrivalNs) {
+    output_ = fix;
+    output_.timestampNs = arrivalNs;
+    fixReady_ = true;
+    ++stats_.fixes;
+}
+
+} // namespace falconmind::sdk::sensors
@@ -1,17 +1,45 @@
 #include "falconmind/sdk/sensors/GnssSourceNode.h"
 #include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/core/TimeSync.h"
 
-#include <chrono>
-#include <cmath>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
 #include <iostream>
-#include <sstream>
+#include <termios.h>
+#include <unistd.h>
 
 namespace falconmind::sdk::sensors {
 
 using namespace falconmind::sdk::core;
 
+namespace {
+
+constexpr std::size_t kReadChunk = 4096;
+
+bool toSpeed(int baud, speed_t& out) {
+    switch (baud) {
+    case 9600: out = B9600; return true;
+    case 19200: out = B19200; return true;
+    case 38400: out = B38400; return true;
+    case 57600: out = B57600; return true;
+    case 115200: out = B115200; return true;
+    case 230400: out = B230400; return true;
+    case 460800: out = B460800; return true;
+    case 921600: out = B921600; return true;
+    default: return false;
+    }
+}
+
+} // namespace
+
 GnssSourceNode::GnssSourceNode() : Node("gnss_source") {
-    addPad(std::make_shared<Pad>("gnss_out", PadType::Source));
+    outPad_ = addPad(std::make_shared<Pad>("gnss_out", PadType::Source));
+}
+
+GnssSourceNode::~GnssSourceNode() {
+    closeSource();
 }
 
 bool GnssSourceNode::configure(const std::unordered_map<std::string, std::string>& params) {
@@ -19,56 +47,74 @@ bool GnssSourceNode::configure(const std::unordered_map<std::string, std::string
     if (it != params.end()) deviceOrUri_ = it->second;
     auto itUri = params.find("uri");
     if (itUri != params.end()) deviceOrUri_ = itUri->second;
+    auto itBaud = params.find("baud");
+    if (itBaud != params.end()) {
+        speed_t speed;
+        try { baud_ = std::stoi(itBaud->second); } catch (...) { baud_ = 0; }
+        if (!toSpeed(baud_, speed)) {
+            std::cerr << "[GnssSourceNode] configure: unsupported baud " << itBaud->second << std::endl;
+            return false;
+        }
+    }
+    auto itSync = params.find("time_sync");
+    if (itSync != params.end()) {
+        if (itSync->second != "sensor" && itSync->second != "arrival") {
+            std::cerr << "[GnssSourceNode] configure: unknown time_sync " << itSync->second << std::endl;
+            return false;
+        }
+        sensorTimeSync_ = itSync->second == "sensor";
+    }
     return true;
 }
 
-bool GnssSourceNode::parseNmeaGga(const std::string& line, GnssSample& out) {
-    if (line.size() < 7 || line.substr(0, 7) != "$GPGGA,") return false;
-    std::istringstream ss(line);
-    std::string tok;
-    std::getline(ss, tok, ','); // $GPGGA
-    if (!std::getline(ss, tok, ',')) return false; // time
-    if (!std::getline(ss, tok, ',')) return false; // lat
-    double latDeg = 0;
-    try { latDeg = std::stod(tok); } catch (...) { return false; }
-    if (!std::getline(ss, tok, ',')) return false; // N/S
-    if (tok == "S") latDeg = -latDeg;
-    int latDegInt = static_cast<int>(latDeg / 100);
-    double latMin = latDeg - latDegInt * 100;
-    out.latitude = latDegInt + latMin / 60.0;
-    if (!std::getline(ss, tok, ',')) return false; // lon
-    double lonDeg = 0;
-    try { lonDeg = std::stod(tok); } catch (...) { return false; }
-    if (!std::getline(ss, tok, ',')) return false; // E/W
-    if (tok == "W") lonDeg = -lonDeg;
-    int lonDegInt = static_cast<int>(lonDeg / 100);
-    double lonMin = lonDeg - lonDegInt * 100;
-    out.longitude = lonDegInt + lonMin / 60.0;
-    if (!std::getline(ss, tok, ',')) return false; // quality
-    if (!std::getline(ss, tok, ',')) return false; // num sats
-    try { out.numSatellites = std::stoi(tok); } catch (...) { out.numSatellites = 0; }
-    if (!std::getline(ss, tok, ',')) return false; // hdop
-    try { out.hdop = std::stof(tok); } catch (...) { out.hdop = 99.f; }
-    if (!std::getline(ss, tok, ',')) return false; // alt
-    try { out.altitude = std::stod(tok); } catch (...) { out.altitude = 0; }
-    out.timestampNs = simTimestampNs_++;
+bool GnssSourceNode::openSerial() {
+    fd_ = ::open(deviceOrUri_.c_str(), O_RDONLY | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd_ < 0) return false;
+    termios tio{};
+    speed_t speed = B115200;
+    toSpeed(baud_, speed);
+    if (tcgetattr(fd_, &tio) == 0) {
+        cfmakeraw(&tio);
+        tio.c_cflag |= CLOCAL | CREAD;
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+        cfsetispeed(&tio, speed);
+        cfsetospeed(&tio, speed);
+        if (tcsetattr(fd_, TCSANOW, &tio) != 0) {
+            std::cerr << "[GnssSourceNode] tcsetattr failed: " << std::strerror(errno) << std::endl;
+        }
+        tcflush(fd_, TCIFLUSH);  // 丢弃打开前积压的半截语句
+    }
     return true;
 }
 
+void GnssSourceNode::closeSource() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
 void GnssSourceNode::pushGnss(const GnssSample& s) {
-    auto outPad = getPad("gnss_out");
-    if (outPad)
-        outPad->pushToConnections(&s, sizeof(s));
+    if (outPad_)
+        outPad_->pushToConnections(&s, sizeof(s));
 }
 
 bool GnssSourceNode::start() {
+    closeSource();
     started_ = true;
-    replayMode_ = false;
-    nmeaFile_.close();
+    mode_ = Mode::Sim;
+    parser_.reset();
+    readBuffer_.resize(kReadChunk);
+    readPos_ = readSize_ = 0;
     if (!deviceOrUri_.empty() && deviceOrUri_ != "sim") {
-        nmeaFile_.open(deviceOrUri_);
-        if (nmeaFile_.is_open()) {
-            replayMode_ = true;
+        const bool serial = deviceOrUri_.compare(0, 5, "/dev/") == 0;
+        if (serial && openSerial()) {
+            mode_ = Mode::Serial;
+            clock_ = sensorTimeSync_ ? TimeSyncService::instance().clock(id()) : nullptr;
+            std::cout << "[GnssSourceNode] start serial: " << deviceOrUri_ << " @" << baud_ << std::endl;
+        } else if (!serial && (fd_ = ::open(deviceOrUri_.c_str(), O_RDONLY | O_CLOEXEC)) >= 0) {
+            mode_ = Mode::Replay;
             std::cout << "[GnssSourceNode] start replay from file: " << deviceOrUri_ << std::endl;
         } else {
             std::cout << "[GnssSourceNode] start: open failed, fallback to sim: " << deviceOrUri_ << std::endl;
@@ -80,22 +126,62 @@ bool GnssSourceNode::start() {
     return true;
 }
 
+void GnssSourceNode::stop() {
+    started_ = false;
+    closeSource();
+    Node::stop();
+}
+
 void GnssSourceNode::process() {
     if (!started_) return;
 
-    if (replayMode_ && nmeaFile_.is_open()) {
-        std::string line;
-        while (std::getline(nmeaFile_, line)) {
-            if (line.empty()) continue;
-            GnssSample s;
-            if (parseNmeaGga(line, s)) {
-                pushGnss(s);
+    if (mode_ == Mode::Serial) {
+        // 读空内核缓冲，期间完成的每一帧都推送（高频 RTK 下一次轮询可能积压多帧）
+        for (;;) {
+            const ssize_t n = ::read(fd_, readBuffer_.data(), readBuffer_.size());
+            if (n <= 0) {
+                if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    std::cerr << "[GnssSourceNode] read failed: " << std::strerror(errno) << std::endl;
+                }
+                return;
+            }
+            const auto arrivalNs = static_cast<std::uint64_t>(PipelineClock::nowNs());
+            for (std::size_t pos = 0; pos < static_cast<std::size_t>(n);) {
+                pos += parser_.feed(readBuffer_.data() + pos, static_cast<std::size_t>(n) - pos, arrivalNs);
+                if (!parser_.fixReady()) continue;
+                GnssSample fix = parser_.takeFix();
+                // 定位时刻（UTC）经时钟同步映射为 PipelineClock，去掉串口缓冲与轮询引入的延迟
+                if (clock_ && fix.utcTimeNs != 0) {
+                    fix.timestampNs = static_cast<std::uint64_t>(
+                        clock_->observe(fix.utcTimeNs, static_cast<std::int64_t>(arrivalNs)));
+                }
+                pushGnss(fix);
+            }
+        }
+    }
+
+    if (mode_ == Mode::Replay) {
+        // 每次推送一帧；缓冲耗尽则续读，文件末尾回到开头
+        bool rewound = false;
+        for (;;) {
+            if (readPos_ == readSize_) {
+                const ssize_t n = ::read(fd_, readBuffer_.data(), readBuffer_.size());
+                if (n <= 0) {
+                    if (rewound || ::lseek(fd_, 0, SEEK_SET) != 0) return;  // 文件中没有任何定位
+                    parser_.reset();
+                    rewound = true;
+                    continue;
+                }
+                readPos_ = 0;
+                readSize_ = static_cast<std::size_t>(n);
+            }
+            readPos_ += parser_.feed(readBuffer_.data() + readPos_, readSize_ - readPos_,
+                                     static_cast<std::uint64_t>(PipelineClock::nowNs()));
+            if (parser_.fixReady()) {
+                pushGnss(parser_.takeFix());
                 return;
             }
         }
-        nmeaFile_.clear();
-        nmeaFile_.seekg(0);
-        return;
     }
 
     GnssSample s;
@@ -104,6 +190,7 @@ void GnssSourceNode::process() {
     s.altitude = simAlt_;
     s.hdop = 0.8f;
     s.numSatellites = 12;
+    s.fixQuality = 1;
     s.timestampNs = simTimestampNs_++;
     pushGnss(s);
 }
@@ -0,0 +1,243 @@
+#include "falconmind/sdk/sensors/ImageTransform.h"
+#include "falconmind/sdk/sensors/ColorConvert.h"
+#include "falconmind/sdk/sensors/VideoConvertNode.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace falconmind::sdk::sensors {
+
+using core::PixelFormat;
+
+const char* imageTransformBackendName(ImageTransformBackendType type) noexcept {
+    switch (type) {
+        case ImageTransformBackendType::Auto: return "auto";
+        case ImageTransformBackendType::Cpu: return "cpu";
+        case ImageTransformBackendType::Rga: return "rga";
+        case ImageTransformBackendType::Vpi: return "vpi";
+    }
+    return "unknown";
+}
+
+bool parseImageTransformBackend(const std::string& name, ImageTransformBackendType& out) {
+    std::string s(name);
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (auto t : {ImageTransformBackendType::Auto, ImageTransformBackendType::Cpu, ImageTransformBackendType::Rga,
+                   ImageTransformBackendType::Vpi}) {
+        if (s == imageTransformBackendName(t)) {
+            out = t;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool imageTransformAvailable(ImageTransformBackendType type) {
+    switch (type) {
+        case ImageTransformBackendType::Auto:
+        case ImageTransformBackendType::Cpu: return true;
+        case ImageTransformBackendType::Rga: return RgaImageTransform::available();
+        case ImageTransformBackendType::Vpi: return VpiImageTransform::available();
+    }
+    return false;
+}
+
+ImageTransformPtr createImageTransform(ImageTransformBackendType type) {
+    switch (type) {
+        case ImageTransformBackendType::Auto:
+            if (RgaImageTransform::available()) return std::make_unique<RgaImageTransform>();
+            if (VpiImageTransform::available()) return std::make_unique<VpiImageTransform>();
+            return std::make_unique<CpuImageTransform>();
+        case ImageTransformBackendType::Cpu: return std::make_unique<CpuImageTransform>();
+        case ImageTransformBackendType::Rga:
+            return RgaImageTransform::available() ? std::make_unique<RgaImageTransform>() : nullptr;
+        case ImageTransformBackendType::Vpi:
+            return VpiImageTransform::available() ? std::make_unique<VpiImageTransform>() : nullptr;
+    }
+    return nullptr;
+}
+
+namespace {
+
+constexpr int kWeightBits = 11;
+constexpr int kWeightOne = 1 << kWeightBits;
+
+bool isRgbLike(PixelFormat f) { return f == PixelFormat::RGB8 || f == PixelFormat::BGR8; }
+
+bool isSourceFormat(PixelFormat f) { return isRgbLike(f) || f == PixelFormat::NV12 || f == PixelFormat::YUYV; }
+
+bool quarterTurn(ImageRotation r) { return r == ImageRotation::Rot90 || r == ImageRotation::Rot270; }
+
+// 源 (sw×sh, RGB) 旋转到 dst；90/270 时 dst 为 sh×sw。旋转方向为模板参数，逐像素循环内只剩地址计算
+template <ImageRotation R>
+void rotateRgbT(const std::uint8_t* src, int srcStride, int sw, int sh, std::uint8_t* dst) {
+    constexpr bool quarter = R == ImageRotation::Rot90 || R == ImageRotation::Rot270;
+    const int dw = quarter ? sh : sw;
+    for (int y = 0; y < sh; ++y) {
+        const std::uint8_t* row = src + static_cast<std::size_t>(y) * srcStride;
+        for (int x = 0; x < sw; ++x) {
+            int dx = x, dy = y;
+            if constexpr (R == ImageRotation::Rot90) {
+                dx = sh - 1 - y;
+                dy = x;
+            } else if constexpr (R == ImageRotation::Rot180) {
+                dx = sw - 1 - x;
+                dy = sh - 1 - y;
+            } else if constexpr (R == ImageRotation::Rot270) {
+                dx = y;
+                dy = sw - 1 - x;
+            }
+            std::memcpy(dst + (static_cast<std::size_t>(dy) * dw + dx) * 3, row + static_cast<std::size_t>(x) * 3, 3);
+        }
+    }
+}
+
+void rotateRgb(const std::uint8_t* src, int srcStride, int sw, int sh, ImageRotation rotation, std::uint8_t* dst) {
+    switch (rotation) {
+        case ImageRotation::Rot90: rotateRgbT<ImageRotation::Rot90>(src, srcStride, sw, sh, dst); break;
+        case ImageRotation::Rot180: rotateRgbT<ImageRotation::Rot180>(src, srcStride, sw, sh, dst); break;
+        case ImageRotation::Rot270: rotateRgbT<ImageRotation::Rot270>(src, srcStride, sw, sh, dst); break;
+        case ImageRotation::None: rotateRgbT<ImageRotation::None>(src, srcStride, sw, sh, dst); break;
+    }
+}
+
+} // namespace
+
+void BilinearColumns::build(int srcWidth, int dstWidth) {
+    // 半像素中心对齐：s = (d + 0.5)·src/dst − 0.5，越界钳制到边缘像素
+    offset.resize(static_cast<std::size_t>(dstWidth) * 2);
+    weight.resize(static_cast<std::size_t>(dstWidth));
+    const double rx = srcWidth / static_cast<double>(dstWidth);
+    for (int x = 0; x < dstWidth; ++x) {
+        const double s = std::clamp((x + 0.5) * rx - 0.5, 0.0, static_cast<double>(srcWidth - 1));
+        const int a = static_cast<int>(s);
+        offset[2 * x] = a * 3;
+        offset[2 * x + 1] = std::min(a + 1, srcWidth - 1) * 3;
+        weight[x] = static_cast<std::int16_t>((s - a) * kWeightOne);
+    }
+}
+
+void bilinearSourceRows(int y, int srcHeight, int dstHeight, int& row0, int& row1, int& weight) noexcept {
+    const double ry = srcHeight / static_cast<double>(dstHeight);
+    const double s = std::clamp((y + 0.5) * ry - 0.5, 0.0, static_cast<double>(srcHeight - 1));
+    row0 = static_cast<int>(s);
+    row1 = std::min(row0 + 1, srcHeight - 1);
+    weight = static_cast<int>((s - row0) * kWeightOne);
+}
+
+void bilinearResizeRow(const std::uint8_t* r0, const std::uint8_t* r1, int wy, const BilinearColumns& cols,
+                       std::uint8_t* o) noexcept {
+    const int width = static_cast<int>(cols.weight.size());
+    for (int x = 0; x < width; ++x) {
+        const int i0 = cols.offset[2 * x];
+        const int i1 = cols.offset[2 * x + 1];
+        const int wx = cols.weight[x];
+        for (int c = 0; c < 3; ++c) {
+            const int top = r0[i0 + c] * (kWeightOne - wx) + r0[i1 + c] * wx;
+            const int bottom = r1[i0 + c] * (kWeightOne - wx) + r1[i1 + c] * wx;
+            o[x * 3 + c] = static_cast<std::uint8_t>(
+                (top * (kWeightOne - wy) + bottom * wy + (1 << (2 * kWeightBits - 1))) >> (2 * kWeightBits));
+        }
+    }
+}
+
+bool CpuImageTransform::supports(PixelFormat from, PixelFormat to, ImageRotation) const noexcept {
+    return isSourceFormat(from) && (isRgbLike(to) || to == PixelFormat::NV12);
+}
+
+bool CpuImageTransform::transform(const ImageSurface& src, const ImageTransformOp& op, WritableImageSurface& dst) {
+    if (!src.data || !dst.data || src.width <= 0 || src.height <= 0 || dst.width <= 0 || dst.height <= 0 ||
+        !supports(src.format, dst.format, op.rotation)) {
+        return false;
+    }
+    const int srcStride = src.stride > 0 ? src.stride : core::pixelFormatMinStride(src.format, src.width);
+
+    // 1) 裁剪区域；YUV 源起点对齐到色度采样
+    int cx = std::clamp(op.crop.x, 0, src.width - 1);
+    int cy = std::clamp(op.crop.y, 0, src.height - 1);
+    if (src.format == PixelFormat::NV12) cy &= ~1;
+    if (!isRgbLike(src.format)) cx &= ~1;
+    const int cw = std::min(op.crop.width > 0 ? op.crop.width : src.width - cx, src.width - cx);
+    const int ch = std::min(op.crop.height > 0 ? op.crop.height : src.height - cy, src.height - cy);
+    if (cw <= 0 || ch <= 0) return false;
+
+    // 2) 转为 RGB 排列的中间图（RGB/BGR 源不复制）；YUV 源按目标选择通道顺序，省去后面的交换
+    const bool yuv = !isRgbLike(src.format);
+    const bool bgr = yuv ? dst.format == PixelFormat::BGR8 : src.format == PixelFormat::BGR8;
+    const std::uint8_t* rgb = src.data + static_cast<std::size_t>(cy) * srcStride + static_cast<std::size_t>(cx) * 3;
+    int rgbStride = srcStride;
+    if (yuv) {
+        rgb_.resize(static_cast<std::size_t>(cw) * ch * 3);
+        rgbStride = cw * 3;
+        for (int y = 0; y < ch; ++y) {
+            std::uint8_t* out = rgb_.data() + static_cast<std::size_t>(y) * rgbStride;
+            const std::uint8_t* row = src.data + static_cast<std::size_t>(cy + y) * srcStride;
+            if (src.format == PixelFormat::NV12) {
+                const std::uint8_t* uv = src.data + static_cast<std::size_t>(srcStride) * src.height +
+                                         static_cast<std::size_t>((cy + y) / 2) * srcStride;
+                convertNv12RowToRgb(row + cx, uv + cx, out, cw, bgr);
+            } else {
+                convertYuyvRowToRgb(row + static_cast<std::size_t>(cx) * 2, out, cw, bgr);
+            }
+        }
+        rgb = rgb_.data();
+    }
+
+    // 3) 旋转
+    int rw = cw, rh = ch;
+    if (op.rotation != ImageRotation::None) {
+        if (quarterTurn(op.rotation)) std::swap(rw, rh);
+        rotated_.resize(static_cast<std::size_t>(rw) * rh * 3);
+        rotateRgb(rgb, rgbStride, cw, ch, op.rotation, rotated_.data());
+        rgb = rotated_.data();
+        rgbStride = rw * 3;
+    }
+
+    // 4) 缩放（目标为同序 RGB 时直接写入目标，否则写入暂存后转换）
+    const bool swap = isRgbLike(dst.format) && (dst.format == PixelFormat::BGR8) != bgr;
+    const bool direct = isRgbLike(dst.format) && !swap;
+    std::uint8_t* out = dst.data;
+    int outStride = dst.stride > 0 ? dst.stride : dst.width * 3;
+    if (!direct) {
+        if (dst.format == PixelFormat::NV12 && dst.stride > 0 && dst.stride != dst.width) return false;
+        resized_.resize(static_cast<std::size_t>(dst.width) * dst.height * 3);
+        out = resized_.data();
+        outStride = dst.width * 3;
+    }
+
+    if (rw == dst.width && rh == dst.height) {
+        for (int y = 0; y < rh; ++y) {
+            std::memcpy(out + static_cast<std::size_t>(y) * outStride, rgb + static_cast<std::size_t>(y) * rgbStride,
+                        static_cast<std::size_t>(rw) * 3);
+        }
+    } else {
+        columns_.build(rw, dst.width);
+        for (int y = 0; y < dst.height; ++y) {
+            int a = 0, b = 0, wy = 0;
+            bilinearSourceRows(y, rh, dst.height, a, b, wy);
+            bilinearResizeRow(rgb + static_cast<std::size_t>(a) * rgbStride, rgb + static_cast<std::size_t>(b) * rgbStride,
+                              wy, columns_, out + static_cast<std::size_t>(y) * outStride);
+        }
+    }
+    if (direct) return true;
+
+    // 5) 转换为目标格式
+    const PixelFormat interim = bgr ? PixelFormat::BGR8 : PixelFormat::RGB8;
+    if (dst.format == PixelFormat::NV12) {
+        return convertPixels(interim, out, outStride, PixelFormat::NV12, dst.data, dst.width, dst.height);
+    }
+    const int dstStride = dst.stride > 0 ? dst.stride : dst.width * 3;
+    for (int y = 0; y < dst.height; ++y) {
+        const std::uint8_t* s = out + static_cast<std::size_t>(y) * outStride;
+        std::uint8_t* d = dst.data + static_cast<std::size_t>(y) * dstStride;
+        for (int x = 0; x < dst.width; ++x) {
+            d[x * 3 + 0] = s[x * 3 + 2];
+            d[x * 3 + 1] = s[x * 3 + 1];
+            d[x * 3 + 2] = s[x * 3 + 0];
+        }
+    }
+    return true;
+}
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,296 @@
+#include "falconmind/sdk/sensors/ImageTransformNode.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/Pad.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace falconmind::sdk::sensors {
+
+using namespace falconmind::sdk::core;
+
+namespace {
+constexpr int kMinEdge = 64;
+} // namespace
+
+ImageTransformNode::ImageTransformNode() : Node("image_transform") {
+    auto in = std::make_shared<Pad>("video_in", PadType::Sink);
+    Caps caps;
+    for (auto f : {PixelFormat::NV12, PixelFormat::YUYV, PixelFormat::RGB8, PixelFormat::BGR8}) {
+        caps.addVideo(VideoCaps{f, 0, 0, 0});
+    }
+    in->setCaps(caps);
+    in->setCapsCallback([this](const VideoCaps& c) { inputFormat_ = c.format; });
+    inPad_ = addPad(in);
+    outPad_ = addPad(std::make_shared<Pad>("video_out", PadType::Source));
+    pool_.setMemoryAccount(memoryAccount_);
+    updateOutputCaps();
+}
+
+void ImageTransformNode::updateOutputCaps() {
+    Caps caps;
+    caps.addVideo(VideoCaps{outputFormat_, outWidth_, outHeight_, 0});
+    if (outPad_) outPad_->setCaps(caps);
+}
+
+bool ImageTransformNode::staticOutputSize(int& width, int& height) const {
+    int cw = op_.crop.width;
+    int ch = op_.crop.height;
+    if (op_.rotation == ImageRotation::Rot90 || op_.rotation == ImageRotation::Rot270) std::swap(cw, ch);
+    width = outWidth_ > 0 ? outWidth_ : cw;
+    height = outHeight_ > 0 ? outHeight_ : ch;
+    return width > 0 && height > 0;
+}
+
+std::size_t ImageTransformNode::estimateMemoryBytes() const {
+    int w = 0;
+    int h = 0;
+    if (!staticOutputSize(w, h)) {
+        w = 640;
+        h = 480;
+    }
+    return (sizeof(CameraFramePacket) + pixelFormatFrameBytes(outputFormat_, w, h)) * pool_.maxBuffersPerKey();
+}
+
+bool ImageTransformNode::degradeMemory(MemoryDegradation step) {
+    constexpr std::size_t kMinFrames = 2;
+    if (step == MemoryDegradation::FewerInFlight) {
+        const std::size_t poolMax = pool_.maxBuffersPerKey();
+        if (poolMax <= kMinFrames) return false;
+        pool_.setMaxBuffersPerKey(std::max(kMinFrames, poolMax / 2));
+        return true;
+    }
+    int w = 0;
+    int h = 0;
+    return staticOutputSize(w, h) && halveOutputSize(w, h);
+}
+
+bool ImageTransformNode::halveOutputSize(int w, int h) {
+    if (w / 2 < kMinEdge || h / 2 < kMinEdge) return false;
+    outWidth_ = (w / 2) & ~1;
+    outHeight_ = (h / 2) & ~1;
+    updateOutputCaps();
+    return true;
+}
+
+bool ImageTransformNode::applyWatchdogAction(WatchdogAction action) {
+    if (action != WatchdogAction::LowerResolution || lowerResolutionPending_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    // 尚未输出过帧时无从判断能否再降，交给下一级
+    const int w = lastOutWidth_.load(std::memory_order_relaxed);
+    const int h = lastOutHeight_.load(std::memory_order_relaxed);
+    if (w / 2 < kMinEdge || h / 2 < kMinEdge) return false;
+    lowerResolutionPending_.store(true, std::memory_order_release);
+    return true;
+}
+
+void ImageTransformNode::outputSize(int srcWidth, int srcHeight, int& w, int& h) const {
+    w = outWidth_;
+    h = outHeight_;
+    if (w == 0 || h == 0) {
+        int cw = op_.crop.width > 0 ? op_.crop.width : srcWidth - op_.crop.x;
+        int ch = op_.crop.height > 0 ? op_.crop.height : srcHeight - op_.crop.y;
+        if (op_.rotation == ImageRotation::Rot90 || op_.rotation == ImageRotation::Rot270) std::swap(cw, ch);
+        if (w == 0) w = cw;
+        if (h == 0) h = ch;
+    }
+}
+
+bool ImageTransformNode::canFuse() const noexcept {
+    return backend_ && backend_->type() == ImageTransformBackendType::Cpu && op_.rotation == ImageRotation::None &&
+           (outputFormat_ == PixelFormat::RGB8 || outputFormat_ == PixelFormat::BGR8);
+}
+
+bool ImageTransformNode::planFusedFrame(const FusedImageInfo& in, FusedStagePlan& out) {
+    if (!canFuse()) return false;
+    int w = 0;
+    int h = 0;
+    outputSize(in.width, in.height, w, h);
+    if (w <= 0 || h <= 0) return false;
+    out.format = outputFormat_;
+    out.geometry = true;
+    out.crop = op_.crop;
+    out.width = w;
+    out.height = h;
+    return true;
+}
+
+void ImageTransformNode::finishFusedFrame(const BufferRef&) {
+    transformed_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool ImageTransformNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    auto intParam = [&](const char* key, int& out) {
+        auto it = params.find(key);
+        if (it == params.end()) return true;
+        try {
+            const int v = std::stoi(it->second);
+            if (v < 0) throw std::invalid_argument(key);
+            out = v;
+            return true;
+        } catch (const std::exception&) {
+            FM_LOG_ERROR("ImageTransformNode", "invalid ", key, ": ", it->second);
+            return false;
+        }
+    };
+    int rotate = 0;
+    if (!intParam("width", outWidth_) || !intParam("height", outHeight_) || !intParam("crop_x", op_.crop.x) ||
+        !intParam("crop_y", op_.crop.y) || !intParam("crop_width", op_.crop.width) ||
+        !intParam("crop_height", op_.crop.height) || !intParam("rotate", rotate)) {
+        return false;
+    }
+    switch (rotate) {
+        case 0: op_.rotation = ImageRotation::None; break;
+        case 90: op_.rotation = ImageRotation::Rot90; break;
+        case 180: op_.rotation = ImageRotation::Rot180; break;
+        case 270: op_.rotation = ImageRotation::Rot270; break;
+        default:
+            FM_LOG_ERROR("ImageTransformNode", "rotate must be 0/90/180/270: ", rotate);
+            return false;
+    }
+    auto it = params.find("format");
+    if (it != params.end()) {
+        const PixelFormat f = parsePixelFormat(it->second);
+        if (f != PixelFormat::RGB8 && f != PixelFormat::BGR8 && f != PixelFormat::NV12) {
+            FM_LOG_ERROR("ImageTransformNode", "unsupported output format: ", it->second);
+            return false;
+        }
+        outputFormat_ = f;
+    }
+    it = params.find("backend");
+    if (it != params.end() && !parseImageTransformBackend(it->second, requested_)) {
+        FM_LOG_ERROR("ImageTransformNode", "unknown backend: ", it->second);
+        return false;
+    }
+    updateOutputCaps();
+    return true;
+}
+
+bool ImageTransformNode::start() {
+    backend_ = createImageTransform(requested_);
+    if (!backend_) {
+        FM_LOG_WARN("ImageTransformNode", "backend ", imageTransformBackendName(requested_), " unavailable, using cpu");
+        backend_ = createImageTransform(ImageTransformBackendType::Cpu);
+    }
+    cpu_.reset();
+    if (backend_->type() != ImageTransformBackendType::Cpu) cpu_ = createImageTransform(ImageTransformBackendType::Cpu);
+    warnedFallback_ = false;
+    if (inPad_) {
+        inPad_->setBufferCallback([this](const BufferRef& frame) {
+            if (frame.size() < sizeof(CameraFramePacket)) return;
+            std::lock_guard<std::mutex> lock(frameMutex_);
+            pending_ = frame;
+        });
+    }
+    FM_LOG_INFO("ImageTransformNode", "start backend=", backend_->name(), " -> ", pixelFormatName(outputFormat_), " ",
+                outWidth_, "x", outHeight_);
+    return true;
+}
+
+void ImageTransformNode::stop() {
+    std::lock_guard<std::mutex> lock(frameMutex_);
+    pending_.reset();
+    pool_.clear();
+}
+
+void ImageTransformNode::releaseIdleBuffers() {
+    std::lock_guard<std::mutex> lock(frameMutex_);
+    pending_.reset();
+    pool_.clear();
+}
+
+ImageTransformBackendType ImageTransformNode::backendType() const noexcept {
+    return backend_ ? backend_->type() : requested_;
+}
+
+void ImageTransformNode::process() {
+    BufferRef frame;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        frame = std::move(pending_);
+        pending_.reset();
+    }
+    if (frame.size() < sizeof(CameraFramePacket) || !backend_ || !outPad_) return;
+
+    // 帧头取 host 副本，设备缓冲（wrapDevice）的像素只在需要 host 访问时才迁移
+    const auto* header = reinterpret_cast<const CameraFramePacket*>(frame.headerData(sizeof(CameraFramePacket)));
+    if (!header) return;
+    auto hostPixels = [&frame]() -> const std::uint8_t* {
+        const std::uint8_t* host = frame.data();
+        return host ? cameraFramePacketData(reinterpret_cast<const CameraFramePacket*>(host)) : nullptr;
+    };
+    ImageSurface src;
+    src.width = header->width;
+    src.height = header->height;
+    src.format = frame.meta().video.format != PixelFormat::Any ? frame.meta().video.format : inputFormat_;
+    if (src.format == PixelFormat::Any) src.format = header->format[0] != '\0' ? parsePixelFormat(header->format)
+                                                                               : PixelFormat::RGB8;
+    src.stride = header->stride > 0 ? header->stride : pixelFormatMinStride(src.format, src.width);
+    src.dmabufFd = frame.dmabufFd();
+    if (fusion_ && fusion_->run(frame, src.format)) return;
+    // RGA 以 fd 导入源图，不需要 host 地址
+    if (src.dmabufFd < 0 || backend_->type() != ImageTransformBackendType::Rga) src.data = hostPixels();
+    std::size_t rows = src.height > 0 ? static_cast<std::size_t>(src.height) : 0;
+    if (src.format == PixelFormat::NV12) rows += (rows + 1) / 2;
+    if (src.width <= 0 || frame.size() < sizeof(CameraFramePacket) + static_cast<std::size_t>(src.stride) * rows) {
+        return;
+    }
+
+    int w = 0;
+    int h = 0;
+    outputSize(src.width, src.height, w, h);
+    if (lowerResolutionPending_.exchange(false, std::memory_order_acq_rel) && halveOutputSize(w, h)) {
+        FM_LOG_WARN("ImageTransformNode", "watchdog: output ", w, "x", h, " -> ", outWidth_, "x", outHeight_);
+        w = outWidth_;
+        h = outHeight_;
+    }
+    lastOutWidth_.store(w, std::memory_order_relaxed);
+    lastOutHeight_.store(h, std::memory_order_relaxed);
+    const std::size_t outBytes = pixelFormatFrameBytes(outputFormat_, w, h);
+    if (outBytes == 0) return;
+
+    BufferRef out = pool_.acquire(BufferPoolKey{w, h, pixelFormatName(outputFormat_)}, sizeof(CameraFramePacket) + outBytes);
+    auto* outHeader = reinterpret_cast<CameraFramePacket*>(out.mutableData());
+    *outHeader = *header;
+    outHeader->width = w;
+    outHeader->height = h;
+    outHeader->stride = pixelFormatMinStride(outputFormat_, w);
+    std::strncpy(outHeader->format, pixelFormatName(outputFormat_), sizeof(outHeader->format) - 1);
+    outHeader->format[sizeof(outHeader->format) - 1] = '\0';
+
+    WritableImageSurface dst;
+    dst.data = cameraFramePacketDataWritable(outHeader);
+    dst.width = w;
+    dst.height = h;
+    dst.stride = outHeader->stride;
+    dst.format = outputFormat_;
+
+    bool ok = backend_->supports(src.format, dst.format, op_.rotation) && backend_->transform(src, op_, dst);
+    if (!ok && cpu_) {
+        if (!warnedFallback_) {
+            FM_LOG_WARN("ImageTransformNode", backend_->name(), " cannot handle ", pixelFormatName(src.format), " -> ",
+                        pixelFormatName(dst.format), ", falling back to cpu");
+            warnedFallback_ = true;
+        }
+        src.dmabufFd = -1;
+        if (!src.data) src.data = hostPixels();
+        ok = src.data && cpu_->transform(src, op_, dst);
+        if (ok) cpuFallbacks_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (!ok) {
+        FM_LOG_ERROR("ImageTransformNode", "transform failed for frame ", header->frameIndex);
+        return;
+    }
+    auto& meta = out.mutableMeta();
+    meta = frame.meta();
+    meta.video = VideoCaps{outputFormat_, w, h, frame.meta().video.fps};
+    meta.dmabufFd = -1;
+    transformed_.fetch_add(1, std::memory_order_relaxed);
+    outPad_->pushBuffer(out);
+}
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,237 @@
+#include "falconmind/sdk/sensors/ImuHistory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace falconmind::sdk::sensors {
+
+namespace {
+
+using Quat = std::array<double, 4>;  // w x y z
+using Vec3 = std::array<double, 3>;
+
+std::uint64_t toWord(double v) {
+    std::uint64_t w;
+    std::memcpy(&w, &v, sizeof(w));
+    return w;
+}
+
+double fromWord(std::uint64_t w) {
+    double v;
+    std::memcpy(&v, &w, sizeof(v));
+    return v;
+}
+
+Quat multiply(const Quat& a, const Quat& b) {
+    return {a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3],
+            a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2],
+            a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1],
+            a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0]};
+}
+
+void normalize(Quat& q) {
+    double n = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (double& c : q) c /= n;
+}
+
+// 旋转向量 → 四元数
+Quat expMap(const Vec3& theta) {
+    double angle = std::sqrt(theta[0] * theta[0] + theta[1] * theta[1] + theta[2] * theta[2]);
+    if (angle < 1e-12) {
+        Quat q{1., theta[0] * 0.5, theta[1] * 0.5, theta[2] * 0.5};
+        normalize(q);
+        return q;
+    }
+    double s = std::sin(angle * 0.5) / angle;
+    return {std::cos(angle * 0.5), theta[0] * s, theta[1] * s, theta[2] * s};
+}
+
+// v' = q·v·q*
+Vec3 rotate(const Quat& q, const Vec3& v) {
+    const Vec3 u{q[1], q[2], q[3]};
+    const Vec3 t{2. * (u[1] * v[2] - u[2] * v[1]), 2. * (u[2] * v[0] - u[0] * v[2]), 2. * (u[0] * v[1] - u[1] * v[0])};
+    return {v[0] + q[0] * t[0] + (u[1] * t[2] - u[2] * t[1]),
+            v[1] + q[0] * t[1] + (u[2] * t[0] - u[0] * t[2]),
+            v[2] + q[0] * t[2] + (u[0] * t[1] - u[1] * t[0])};
+}
+
+ImuSample lerp(const ImuSample& a, const ImuSample& b, std::uint64_t tNs) {
+    const double w = static_cast<double>(tNs - a.timestampNs) / static_cast<double>(b.timestampNs - a.timestampNs);
+    ImuSample s;
+    s.gx = a.gx + (b.gx - a.gx) * w;
+    s.gy = a.gy + (b.gy - a.gy) * w;
+    s.gz = a.gz + (b.gz - a.gz) * w;
+    s.ax = a.ax + (b.ax - a.ax) * w;
+    s.ay = a.ay + (b.ay - a.ay) * w;
+    s.az = a.az + (b.az - a.az) * w;
+    s.timestampNs = tNs;
+    return s;
+}
+
+// 中点法：角速度取两端均值，加速度取两端在积分系下的均值
+void integrateStep(const ImuSample& prev, const ImuSample& cur, const ImuBias& bias, ImuPreintegration& acc) {
+    const double dt = static_cast<double>(cur.timestampNs - prev.timestampNs) * 1e-9;
+    const Vec3 omega{0.5 * (prev.gx + cur.gx) - bias.gyro[0], 0.5 * (prev.gy + cur.gy) - bias.gyro[1],
+                     0.5 * (prev.gz + cur.gz) - bias.gyro[2]};
+    Quat next = multiply(acc.dq, expMap({omega[0] * dt, omega[1] * dt, omega[2] * dt}));
+    normalize(next);
+    const Vec3 a0 = rotate(acc.dq, {prev.ax - bias.accel[0], prev.ay - bias.accel[1], prev.az - bias.accel[2]});
+    const Vec3 a1 = rotate(next, {cur.ax - bias.accel[0], cur.ay - bias.accel[1], cur.az - bias.accel[2]});
+    for (int k = 0; k < 3; ++k) {
+        const double a = 0.5 * (a0[k] + a1[k]);
+        acc.dp[k] += acc.dv[k] * dt + 0.5 * a * dt * dt;
+        acc.dv[k] += a * dt;
+    }
+    acc.dq = next;
+    acc.dt += dt;
+}
+
+} // namespace
+
+ImuHistory::ImuHistory(std::size_t capacity)
+    : slots_([capacity] {
+          std::size_t n = 16;
+          while (n < capacity) n <<= 1;
+          return n;
+      }()),
+      mask_(slots_.size() - 1) {}
+
+void ImuHistory::push(const ImuSample& sample) {
+    const std::uint64_t index = head_.load(std::memory_order_relaxed);
+    if (index > base_.load(std::memory_order_relaxed) && sample.timestampNs <= lastTimestampNs_) {
+        outOfOrder_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Slot& slot = slots_[index & mask_];
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);  // 读者先看到“写入中”，再看到新数据
+    const std::uint64_t words[kWords] = {toWord(sample.gx), toWord(sample.gy), toWord(sample.gz), toWord(sample.ax),
+                                         toWord(sample.ay), toWord(sample.az), sample.timestampNs};
+    for (std::size_t k = 0; k < kWords; ++k) slot.words[k].store(words[k], std::memory_order_relaxed);
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+    head_.store(index + 1, std::memory_order_release);
+    lastTimestampNs_ = sample.timestampNs;
+}
+
+void ImuHistory::restart() {
+    base_.store(head_.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+std::size_t ImuHistory::size() const noexcept {
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+    return static_cast<std::size_t>(head - oldestIndex(head));
+}
+
+std::uint64_t ImuHistory::oldestIndex(std::uint64_t head) const noexcept {
+    const std::uint64_t base = base_.load(std::memory_order_acquire);
+    const std::uint64_t ring = head > slots_.size() ? head - slots_.size() : 0;
+    return std::min(head, std::max(base, ring));
+}
+
+bool ImuHistory::read(std::uint64_t index, ImuSample& out) const {
+    const Slot& slot = slots_[index & mask_];
+    const std::uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    if (seq != 2 * index + 2) return false;  // 尚未写入或已被覆盖
+    std::uint64_t words[kWords];
+    for (std::size_t k = 0; k < kWords; ++k) words[k] = slot.words[k].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != seq) return false;  // 读取期间被覆盖
+    out.gx = fromWord(words[0]);
+    out.gy = fromWord(words[1]);
+    out.gz = fromWord(words[2]);
+    out.ax = fromWord(words[3]);
+    out.ay = fromWord(words[4]);
+    out.az = fromWord(words[5]);
+    out.timestampNs = words[6];
+    return true;
+}
+
+bool ImuHistory::readTimestamp(std::uint64_t index, std::uint64_t& ts) const {
+    const Slot& slot = slots_[index & mask_];
+    const std::uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    if (seq != 2 * index + 2) return false;
+    ts = slot.words[kWords - 1].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.seq.load(std::memory_order_relaxed) == seq;
+}
+
+std::uint64_t ImuHistory::lowerBound(std::uint64_t tNs, std::uint64_t first, std::uint64_t head) const {
+    std::uint64_t lo = first;
+    std::uint64_t hi = head;
+    while (lo < hi) {
+        const std::uint64_t mid = lo + (hi - lo) / 2;
+        std::uint64_t ts = 0;
+        // 读不到的槽已被覆盖，逻辑上早于所有仍有效的采样
+        if (!readTimestamp(mid, ts) || ts < tNs) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+bool ImuHistory::latest(ImuSample& out) const {
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+    return head > oldestIndex(head) && read(head - 1, out);
+}
+
+std::size_t ImuHistory::samplesBetween(std::uint64_t t0Ns, std::uint64_t t1Ns, std::vector<ImuSample>& out) const {
+    if (t1Ns < t0Ns) return 0;
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+    std::size_t appended = 0;
+    ImuSample s;
+    for (std::uint64_t i = lowerBound(t0Ns, oldestIndex(head), head); i < head; ++i) {
+        if (!read(i, s)) continue;
+        if (s.timestampNs > t1Ns) break;
+        out.push_back(s);
+        ++appended;
+    }
+    return appended;
+}
+
+bool ImuHistory::at(std::uint64_t tNs, ImuSample& out) const {
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+    const std::uint64_t first = oldestIndex(head);
+    const std::uint64_t i = lowerBound(tNs, first, head);
+    if (i >= head) return false;
+    ImuSample after;
+    if (!read(i, after)) return false;
+    if (after.timestampNs == tNs) {
+        out = after;
+        return true;
+    }
+    ImuSample before;
+    if (i == first || !read(i - 1, before)) return false;
+    out = lerp(before, after, tNs);
+    return true;
+}
+
+bool ImuHistory::integrate(std::uint64_t t0Ns, std::uint64_t t1Ns, ImuPreintegration& out,
+                           const ImuBias& bias) const {
+    if (t1Ns <= t0Ns) return false;
+    ImuSample start;
+    ImuSample end;
+    if (!at(t0Ns, start) || !at(t1Ns, end)) return false;
+    ImuPreintegration acc;
+    acc.t0Ns = t0Ns;
+    acc.t1Ns = t1Ns;
+    acc.samples = 1;
+    ImuSample prev = start;
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+    ImuSample s;
+    for (std::uint64_t i = lowerBound(t0Ns + 1, oldestIndex(head), head); i < head; ++i) {
+        if (!read(i, s)) return false;  // 积分区间内的数据在计算中被覆盖
+        if (s.timestampNs >= t1Ns) break;
+        integrateStep(prev, s, bias, acc);
+        prev = s;
+        ++acc.samples;
+    }
+    integrateStep(prev, end, bias, acc);
+    ++acc.samples;
+    out = acc;
+    return true;
+}
+
+} // namespace falconmind::sdk::sensors
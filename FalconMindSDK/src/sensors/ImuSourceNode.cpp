@@ -1,6 +1,8 @@
 #include "falconmind/sdk/sensors/ImuSourceNode.h"
 #include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <sstream>
@@ -9,8 +11,8 @@ namespace falconmind::sdk::sensors {
 
 using namespace falconmind::sdk::core;
 
-ImuSourceNode::ImuSourceNode() : Node("imu_source") {
-    addPad(std::make_shared<Pad>("imu_out", PadType::Source));
+ImuSourceNode::ImuSourceNode() : Node("imu_source"), history_(std::make_shared<ImuHistory>()) {
+    outPad_ = addPad(std::make_shared<Pad>("imu_out", PadType::Source));
 }
 
 bool ImuSourceNode::configure(const std::unordered_map<std::string, std::string>& params) {
@@ -18,13 +20,22 @@ bool ImuSourceNode::configure(const std::unordered_map<std::string, std::string>
     if (it != params.end()) deviceOrUri_ = it->second;
     auto itUri = params.find("uri");
     if (itUri != params.end()) deviceOrUri_ = itUri->second;
+    auto itHistory = params.find("history_size");
+    if (itHistory != params.end()) {
+        if (started_) {
+            std::cerr << "[ImuSourceNode] history_size ignored while running" << std::endl;
+        } else {
+            history_ = std::make_shared<ImuHistory>(std::stoul(itHistory->second));
+        }
+    }
     return true;
 }
 
 void ImuSourceNode::pushImu(const ImuSample& s) {
-    auto outPad = getPad("imu_out");
-    if (outPad)
-        outPad->pushToConnections(&s, sizeof(s));
+    lastTimestampNs_ = static_cast<std::int64_t>(s.timestampNs);
+    history_->push(s);
+    if (outPad_)
+        outPad_->pushToConnections(&s, sizeof(s));
 }
 
 bool ImuSourceNode::start() {
@@ -42,7 +53,10 @@ bool ImuSourceNode::start() {
     } else {
         std::cout << "[ImuSourceNode] start sim mode" << std::endl;
     }
-    simTimestampNs_ = 0;
+    // 模拟与回放没有硬件时钟：以启动时刻为起点排布到 PipelineClock 时间轴，与其它传感器可直接对齐
+    simTimestampNs_ = static_cast<std::uint64_t>(PipelineClock::nowNs());
+    replayAnchored_ = false;
+    history_->restart();
     return true;
 }
 
@@ -55,18 +69,27 @@ void ImuSourceNode::process() {
             std::istringstream ss(line);
             ImuSample s;
             if (ss >> s.timestampNs >> s.gx >> s.gy >> s.gz >> s.ax >> s.ay >> s.az) {
+                if (!replayAnchored_) {
+                    // 回放速度取决于 process() 调用频率，可能快于实时：锚点不早于上一条输出
+                    const std::int64_t anchor = std::max<std::int64_t>(PipelineClock::nowNs(), lastTimestampNs_ + 1);
+                    replayOffsetNs_ = anchor - static_cast<std::int64_t>(s.timestampNs);
+                    replayAnchored_ = true;
+                }
+                s.timestampNs = static_cast<std::uint64_t>(static_cast<std::int64_t>(s.timestampNs) + replayOffsetNs_);
                 pushImu(s);
                 return;
             }
         }
         replayFile_.clear();
         replayFile_.seekg(0);
+        replayAnchored_ = false;  // 循环回放：下一条记录重新锚定，时间轴保持递增
+        history_->restart();      // 不跨越回放接缝做查询
         return;
     }
 
     ImuSample s;
     s.gx = 0.01 * std::sin(simTimestampNs_ * 1e-9);
-    s.gy = 0.02 * std::cos(simTimestampNs_ * 1e-9);
+    s.gy = 0.02 * std::cos(simTimestampNs_ * 1e-9);  // 相位随起始时刻不同，对模拟数据无影响
     s.gz = 0.0;
     s.ax = 0.0;
     s.ay = 0.0;
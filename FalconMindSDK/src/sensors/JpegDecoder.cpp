@@ -0,0 +1,187 @@
+#include "falconmind/sdk/sensors/JpegDecoder.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+#if defined(FALCONMINDSDK_TURBOJPEG_ENABLED)
+#include <turbojpeg.h>
+#endif
+
+namespace falconmind::sdk::sensors {
+
+using core::PixelFormat;
+
+const char* jpegDecoderName(JpegDecoderType type) noexcept {
+    switch (type) {
+        case JpegDecoderType::Auto: return "auto";
+        case JpegDecoderType::Mpp: return "mpp";
+        case JpegDecoderType::Nvjpeg: return "nvjpeg";
+        case JpegDecoderType::Turbo: return "turbo";
+    }
+    return "unknown";
+}
+
+bool parseJpegDecoder(const std::string& name, JpegDecoderType& out) {
+    std::string s(name);
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (auto t : {JpegDecoderType::Auto, JpegDecoderType::Mpp, JpegDecoderType::Nvjpeg, JpegDecoderType::Turbo}) {
+        if (s == jpegDecoderName(t)) {
+            out = t;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool readJpegSize(const std::uint8_t* data, std::size_t size, int& width, int& height) {
+    if (!data || size < 4 || data[0] != 0xFF || data[1] != 0xD8) return false;
+    std::size_t pos = 2;
+    while (pos + 4 <= size) {
+        if (data[pos] != 0xFF) return false;
+        const std::uint8_t marker = data[pos + 1];
+        if (marker == 0xFF) {  // 填充字节
+            ++pos;
+            continue;
+        }
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) {  // 无长度的独立标记
+            pos += 2;
+            continue;
+        }
+        if (marker == 0xDA || marker == 0xD9) return false;  // 扫描开始 / 图像结束前没有 SOF
+        const std::size_t length = (static_cast<std::size_t>(data[pos + 2]) << 8) | data[pos + 3];
+        if (length < 2 || pos + 2 + length > size) return false;
+        // SOF0–SOF15，排除 DHT(C4)/JPG(C8)/DAC(CC)：精度 1 字节，其后高、宽各 2 字节
+        if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+            if (length < 7) return false;
+            height = (data[pos + 5] << 8) | data[pos + 6];
+            width = (data[pos + 7] << 8) | data[pos + 8];
+            return width > 0 && height > 0;
+        }
+        pos += 2 + length;
+    }
+    return false;
+}
+
+bool jpegDecoderAvailable(JpegDecoderType type) {
+    switch (type) {
+        case JpegDecoderType::Auto:
+            return MppJpegDecoder::available() || NvjpegDecoder::available() || TurboJpegDecoder::available();
+        case JpegDecoderType::Mpp: return MppJpegDecoder::available();
+        case JpegDecoderType::Nvjpeg: return NvjpegDecoder::available();
+        case JpegDecoderType::Turbo: return TurboJpegDecoder::available();
+    }
+    return false;
+}
+
+JpegDecoderPtr createJpegDecoder(JpegDecoderType type) {
+    switch (type) {
+        case JpegDecoderType::Auto:
+            if (MppJpegDecoder::available()) return std::make_unique<MppJpegDecoder>();
+            if (NvjpegDecoder::available()) return std::make_unique<NvjpegDecoder>();
+            if (TurboJpegDecoder::available()) return std::make_unique<TurboJpegDecoder>();
+            return nullptr;
+        case JpegDecoderType::Mpp:
+            return MppJpegDecoder::available() ? std::make_unique<MppJpegDecoder>() : nullptr;
+        case JpegDecoderType::Nvjpeg:
+            return NvjpegDecoder::available() ? std::make_unique<NvjpegDecoder>() : nullptr;
+        case JpegDecoderType::Turbo:
+            return TurboJpegDecoder::available() ? std::make_unique<TurboJpegDecoder>() : nullptr;
+    }
+    return nullptr;
+}
+
+void MjpegDecodeStage::start(Handler handler) {
+    stop();
+    handler_ = std::move(handler);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = true;
+        pending_ = false;
+    }
+    thread_ = std::thread([this] { loop(); });
+}
+
+void MjpegDecodeStage::stop() {
+    if (!thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_one();
+    thread_.join();
+    pending_ = false;
+}
+
+void MjpegDecodeStage::submit(const std::uint8_t* jpeg, std::size_t size, std::int64_t captureNs) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) return;
+        if (pending_) dropped_.fetch_add(1, std::memory_order_relaxed);
+        inbox_.assign(jpeg, jpeg + size);
+        inboxNs_ = captureNs;
+        pending_ = true;
+    }
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    cv_.notify_one();
+}
+
+void MjpegDecodeStage::loop() {
+    for (;;) {
+        std::int64_t captureNs = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return !running_ || pending_; });
+            if (!running_) return;
+            work_.swap(inbox_);
+            captureNs = inboxNs_;
+            pending_ = false;
+        }
+        handler_(work_.data(), work_.size(), captureNs);
+    }
+}
+
+#if defined(FALCONMINDSDK_TURBOJPEG_ENABLED)
+
+TurboJpegDecoder::TurboJpegDecoder() : handle_(tjInitDecompress()) {
+    if (!handle_) std::cerr << "[TurboJpegDecoder] tjInitDecompress: " << tjGetErrorStr() << std::endl;
+}
+
+TurboJpegDecoder::~TurboJpegDecoder() {
+    if (handle_) tjDestroy(static_cast<tjhandle>(handle_));
+}
+
+bool TurboJpegDecoder::available() { return true; }
+
+bool TurboJpegDecoder::decode(const std::uint8_t* jpeg, std::size_t size, const WritableImageSurface& dst) {
+    if (!handle_ || !jpeg || size == 0 || !dst.data || !supportsOutput(dst.format)) return false;
+    int width = 0, height = 0, subsamp = 0, colorspace = 0;
+    auto* tj = static_cast<tjhandle>(handle_);
+    if (tjDecompressHeader3(tj, jpeg, static_cast<unsigned long>(size), &width, &height, &subsamp, &colorspace) != 0 ||
+        width != dst.width || height != dst.height) {
+        return false;
+    }
+    const int pixelFormat = dst.format == PixelFormat::BGR8 ? TJPF_BGR : TJPF_RGB;
+    // 损坏的帧（USB 丢包）libjpeg-turbo 仍会输出并报告警告；以错误返回，由调用方丢弃
+    if (tjDecompress2(tj, jpeg, static_cast<unsigned long>(size), dst.data, dst.width, dst.stride, dst.height,
+                      pixelFormat, TJFLAG_FASTDCT | TJFLAG_FASTUPSAMPLE) != 0) {
+        return false;
+    }
+    return true;
+}
+
+#else
+
+TurboJpegDecoder::TurboJpegDecoder() = default;
+TurboJpegDecoder::~TurboJpegDecoder() = default;
+
+bool TurboJpegDecoder::available() { return false; }
+
+bool TurboJpegDecoder::decode(const std::uint8_t*, std::size_t, const WritableImageSurface&) {
+    std::cerr << "[TurboJpegDecoder] built without FALCONMINDSDK_BUILD_TURBOJPEG" << std::endl;
+    return false;
+}
+
+#endif
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,111 @@
+#include "falconmind/sdk/sensors/JpegEncoder.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+#if defined(FALCONMINDSDK_TURBOJPEG_ENABLED)
+#include <turbojpeg.h>
+#endif
+
+namespace falconmind::sdk::sensors {
+
+using core::PixelFormat;
+
+const char* jpegEncoderName(JpegEncoderType type) noexcept {
+    switch (type) {
+        case JpegEncoderType::Auto: return "auto";
+        case JpegEncoderType::Mpp: return "mpp";
+        case JpegEncoderType::Nvjpeg: return "nvjpeg";
+        case JpegEncoderType::Turbo: return "turbo";
+    }
+    return "unknown";
+}
+
+bool parseJpegEncoder(const std::string& name, JpegEncoderType& out) {
+    std::string s(name);
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (auto t : {JpegEncoderType::Auto, JpegEncoderType::Mpp, JpegEncoderType::Nvjpeg, JpegEncoderType::Turbo}) {
+        if (s == jpegEncoderName(t)) {
+            out = t;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool jpegEncoderAvailable(JpegEncoderType type) {
+    switch (type) {
+        case JpegEncoderType::Auto:
+            return MppJpegEncoder::available() || NvjpegEncoder::available() || TurboJpegEncoder::available();
+        case JpegEncoderType::Mpp: return MppJpegEncoder::available();
+        case JpegEncoderType::Nvjpeg: return NvjpegEncoder::available();
+        case JpegEncoderType::Turbo: return TurboJpegEncoder::available();
+    }
+    return false;
+}
+
+JpegEncoderPtr createJpegEncoder(JpegEncoderType type) {
+    switch (type) {
+        case JpegEncoderType::Auto:
+            if (MppJpegEncoder::available()) return std::make_unique<MppJpegEncoder>();
+            if (NvjpegEncoder::available()) return std::make_unique<NvjpegEncoder>();
+            if (TurboJpegEncoder::available()) return std::make_unique<TurboJpegEncoder>();
+            return nullptr;
+        case JpegEncoderType::Mpp:
+            return MppJpegEncoder::available() ? std::make_unique<MppJpegEncoder>() : nullptr;
+        case JpegEncoderType::Nvjpeg:
+            return NvjpegEncoder::available() ? std::make_unique<NvjpegEncoder>() : nullptr;
+        case JpegEncoderType::Turbo:
+            return TurboJpegEncoder::available() ? std::make_unique<TurboJpegEncoder>() : nullptr;
+    }
+    return nullptr;
+}
+
+#if defined(FALCONMINDSDK_TURBOJPEG_ENABLED)
+
+TurboJpegEncoder::TurboJpegEncoder() : handle_(tjInitCompress()) {
+    if (!handle_) std::cerr << "[TurboJpegEncoder] tjInitCompress: " << tjGetErrorStr() << std::endl;
+}
+
+TurboJpegEncoder::~TurboJpegEncoder() {
+    if (handle_) tjDestroy(static_cast<tjhandle>(handle_));
+}
+
+bool TurboJpegEncoder::available() { return true; }
+
+bool TurboJpegEncoder::encode(const ImageSurface& src, int quality, std::vector<std::uint8_t>& out) {
+    if (!handle_ || !src.data || src.width <= 0 || src.height <= 0 ||
+        (src.format != PixelFormat::RGB8 && src.format != PixelFormat::BGR8)) {
+        return false;
+    }
+    // 以最坏情况大小预留 out，TJFLAG_NOREALLOC 让 libjpeg-turbo 直接写入，不另行分配
+    out.resize(tjBufSize(src.width, src.height, TJSAMP_420));
+    unsigned char* dst = out.data();
+    unsigned long size = static_cast<unsigned long>(out.size());
+    const int pixelFormat = src.format == PixelFormat::BGR8 ? TJPF_BGR : TJPF_RGB;
+    if (tjCompress2(static_cast<tjhandle>(handle_), src.data, src.width, src.stride, src.height, pixelFormat, &dst,
+                    &size, TJSAMP_420, std::clamp(quality, 1, 100), TJFLAG_FASTDCT | TJFLAG_NOREALLOC) != 0) {
+        std::cerr << "[TurboJpegEncoder] tjCompress2: " << tjGetErrorStr2(static_cast<tjhandle>(handle_)) << std::endl;
+        out.clear();
+        return false;
+    }
+    out.resize(size);
+    return true;
+}
+
+#else
+
+TurboJpegEncoder::TurboJpegEncoder() = default;
+TurboJpegEncoder::~TurboJpegEncoder() = default;
+
+bool TurboJpegEncoder::available() { return false; }
+
+bool TurboJpegEncoder::encode(const ImageSurface&, int, std::vector<std::uint8_t>&) {
+    std::cerr << "[TurboJpegEncoder] built without FALCONMINDSDK_BUILD_TURBOJPEG" << std::endl;
+    return false;
+}
+
+#endif
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,209 @@
+#include "falconmind/sdk/sensors/LidarPacketParser.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace falconmind::sdk::sensors {
+
+using namespace falconmind::sdk::core;
+
+namespace {
+
+// 数据包为小端序；支持的平台（x86-64 / arm64）均为小端，直接按字节拷贝
+template <typename T>
+T loadLe(const std::uint8_t* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+constexpr double kPi = 3.14159265358979323846;
+
+// VLP-16
+constexpr std::size_t kVelodynePacketBytes = 1206;
+constexpr std::size_t kVelodyneBlocks = 12;
+constexpr std::size_t kVelodyneBlockBytes = 100;
+constexpr std::int64_t kVelodyneFiringNs = 55'296;  // 一次 16 线发射周期
+constexpr std::int64_t kVelodyneLaserNs = 2'304;    // 相邻两线的发射间隔
+constexpr float kVelodyneDistanceUnit = 0.002f;     // 距离 LSB（米）
+constexpr int kVelodyneElevationDeg[16] = {-15, 1, -13, 3, -11, 5, -9, 7, -7, 9, -5, 11, -3, 13, -1, 15};
+constexpr std::int64_t kHourNs = 3'600'000'000'000;
+
+// Livox SDK1
+constexpr std::size_t kLivoxHeaderBytes = 18;
+
+} // namespace
+
+LidarPacketFormat parseLidarPacketFormat(const std::string& name) noexcept {
+    std::string lower;
+    lower.reserve(name.size());
+    for (char c : name) lower.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+    if (lower == "vlp16" || lower == "vlp-16" || lower == "velodyne") return LidarPacketFormat::Velodyne16;
+    if (lower == "livox") return LidarPacketFormat::Livox;
+    return LidarPacketFormat::Unknown;
+}
+
+const char* lidarPacketFormatName(LidarPacketFormat format) noexcept {
+    switch (format) {
+        case LidarPacketFormat::Velodyne16: return "vlp16";
+        case LidarPacketFormat::Livox: return "livox";
+        case LidarPacketFormat::Unknown: break;
+    }
+    return "unknown";
+}
+
+LidarScanAssembler::LidarScanAssembler(LidarPacketFormat format, std::uint32_t capacity, BufferPool& pool,
+                                       ScanCallback onScan, std::int64_t framePeriodNs)
+    : format_(format),
+      capacity_(pointCloudCapacityAligned(capacity > 0 ? capacity : 1)),
+      pool_(pool),
+      onScan_(std::move(onScan)),
+      framePeriodNs_(framePeriodNs > 0 ? framePeriodNs : 100'000'000) {
+    for (std::size_t i = 0; i < 16; ++i) {
+        double rad = kVelodyneElevationDeg[i] * kPi / 180.0;
+        elevationSin_[i] = static_cast<float>(std::sin(rad));
+        elevationCos_[i] = static_cast<float>(std::cos(rad));
+    }
+}
+
+bool LidarScanAssembler::feed(const std::uint8_t* data, std::size_t size, std::int64_t arrivalNs) {
+    ++stats_.packets;
+    bool ok = false;
+    switch (format_) {
+        case LidarPacketFormat::Velodyne16: ok = feedVelodyne16(data, size, arrivalNs); break;
+        case LidarPacketFormat::Livox: ok = feedLivox(data, size, arrivalNs); break;
+        case LidarPacketFormat::Unknown: break;
+    }
+    if (!ok) ++stats_.malformedPackets;
+    return ok;
+}
+
+void LidarScanAssembler::flush() { finishScan(); }
+
+void LidarScanAssembler::reset() {
+    scan_.reset();
+    lastAzimuth_ = -1;
+}
+
+void LidarScanAssembler::beginScan(std::int64_t arrivalNs, std::int64_t sensorTimeNs) {
+    scan_ = pool_.acquire(BufferPoolKey{static_cast<std::int32_t>(capacity_), 0, "FMPC"},
+                          pointCloudPacketSize(capacity_));
+    writer_.reset(scan_.mutableData(), scan_.size(), capacity_);
+    writer_.header->timestampNs = arrivalNs;
+    writer_.header->frameIndex = frameIndex_++;
+    scan_.mutableMeta().timestampNs = arrivalNs;
+    scanSensorStartNs_ = sensorTimeNs;
+}
+
+void LidarScanAssembler::finishScan() {
+    if (!scan_) return;
+    if (writer_.header->count == 0) {
+        scan_.reset();
+        return;
+    }
+    ++stats_.scans;
+    BufferRef done = std::move(scan_);
+    scan_.reset();
+    if (onScan_) onScan_(std::move(done));
+}
+
+void LidarScanAssembler::appendPoint(float x, float y, float z, float intensity, std::int64_t sensorTimeNs,
+                                     std::uint16_t ring) {
+    std::int64_t dt = sensorTimeNs - scanSensorStartNs_;
+    if (dt < 0) dt += kHourNs;  // VLP-16 时间戳为整点后微秒数，跨整点回绕
+    auto dtNs = static_cast<std::uint32_t>(
+        std::min<std::int64_t>(std::max<std::int64_t>(dt, 0), std::numeric_limits<std::uint32_t>::max()));
+    if (writer_.append(x, y, z, intensity, dtNs, ring)) {
+        ++stats_.points;
+    } else {
+        ++stats_.truncatedPoints;
+    }
+}
+
+bool LidarScanAssembler::feedVelodyne16(const std::uint8_t* data, std::size_t size, std::int64_t arrivalNs) {
+    if (size < kVelodynePacketBytes) return false;
+    const std::int64_t packetNs = static_cast<std::int64_t>(loadLe<std::uint32_t>(data + 1200)) * 1000;
+    for (std::size_t b = 0; b < kVelodyneBlocks; ++b) {
+        const std::uint8_t* block = data + b * kVelodyneBlockBytes;
+        if (block[0] != 0xFF || block[1] != 0xEE) return false;
+    }
+    if (lastPacketNs_ >= 0 && packetNs < lastPacketNs_ - kHourNs / 2) hourBaseNs_ += kHourNs;  // 跨整点
+    lastPacketNs_ = packetNs;
+    const std::int64_t hostPacketNs = toHostNs(hourBaseNs_ + packetNs, arrivalNs);
+    int lastDelta = 20;  // 600 RPM 时相邻块约 0.2°
+    for (std::size_t b = 0; b < kVelodyneBlocks; ++b) {
+        const std::uint8_t* block = data + b * kVelodyneBlockBytes;
+        const int azimuth = loadLe<std::uint16_t>(block + 2) % 36000;
+        if (lastAzimuth_ >= 0 && azimuth < lastAzimuth_) {
+            finishScan();  // 方位角回绕：上一圈结束
+        }
+        lastAzimuth_ = azimuth;
+        // 每块两次发射，第二次的方位角按相邻块插值
+        int delta = lastDelta;
+        if (b + 1 < kVelodyneBlocks) {
+            int next = loadLe<std::uint16_t>(block + kVelodyneBlockBytes + 2) % 36000;
+            delta = (next - azimuth + 36000) % 36000;
+            lastDelta = delta;
+        }
+        for (int firing = 0; firing < 2; ++firing) {
+            double azRad = ((azimuth + delta * firing / 2) % 36000) * (kPi / 18000.0);
+            const float sa = static_cast<float>(std::sin(azRad));
+            const float ca = static_cast<float>(std::cos(azRad));
+            const std::int64_t firingNs = packetNs + static_cast<std::int64_t>(b * 2 + firing) * kVelodyneFiringNs;
+            const std::uint8_t* returns = block + 4 + firing * 16 * 3;
+            for (int laser = 0; laser < 16; ++laser) {
+                const std::uint8_t* r = returns + laser * 3;
+                std::uint16_t raw = loadLe<std::uint16_t>(r);
+                if (raw == 0) continue;  // 无回波
+                const std::int64_t pointNs = firingNs + laser * kVelodyneLaserNs;
+                if (!scan_) beginScan(hostPacketNs + (pointNs - packetNs), pointNs);
+                const float range = raw * kVelodyneDistanceUnit;
+                const float xy = range * elevationCos_[laser];
+                appendPoint(xy * sa, xy * ca, range * elevationSin_[laser], static_cast<float>(r[2]), pointNs,
+                            static_cast<std::uint16_t>(laser));
+            }
+        }
+    }
+    return true;
+}
+
+bool LidarScanAssembler::feedLivox(const std::uint8_t* data, std::size_t size, std::int64_t arrivalNs) {
+    if (size < kLivoxHeaderBytes) return false;
+    const std::uint8_t dataType = data[9];
+    std::size_t points = 0;
+    std::size_t stride = 0;
+    std::int64_t intervalNs = 0;
+    if (dataType == 0) {         // 笛卡尔坐标 int32 mm ×3 + 反射率
+        points = 100;
+        stride = 13;
+        intervalNs = 10'000;     // Mid-40/70：100k 点/秒
+    } else if (dataType == 2) {  // 扩展笛卡尔坐标：+ tag
+        points = 96;
+        stride = 14;
+        intervalNs = 4'167;      // Horizon/Avia：240k 点/秒
+    } else {
+        return false;
+    }
+    if (size < kLivoxHeaderBytes + points * stride) return false;
+    const auto packetNs = static_cast<std::int64_t>(loadLe<std::uint64_t>(data + 10));
+    if (scan_ && (packetNs - scanSensorStartNs_ >= framePeriodNs_ || packetNs < scanSensorStartNs_)) {
+        finishScan();  // 达到帧周期（或传感器时钟重置）
+    }
+    const std::int64_t hostPacketNs = toHostNs(packetNs, arrivalNs);
+    const std::uint8_t* p = data + kLivoxHeaderBytes;
+    for (std::size_t i = 0; i < points; ++i, p += stride) {
+        std::int32_t x = loadLe<std::int32_t>(p);
+        std::int32_t y = loadLe<std::int32_t>(p + 4);
+        std::int32_t z = loadLe<std::int32_t>(p + 8);
+        if (x == 0 && y == 0 && z == 0) continue;  // 无效点
+        const std::int64_t pointNs = packetNs + static_cast<std::int64_t>(i) * intervalNs;
+        if (!scan_) beginScan(hostPacketNs, packetNs);
+        appendPoint(x * 0.001f, y * 0.001f, z * 0.001f, static_cast<float>(p[12]), pointNs, 0);
+    }
+    return true;
+}
+
+} // namespace falconmind::sdk::sensors
@@ -1,36 +1,439 @@
 #include "falconmind/sdk/sensors/LidarSourceNode.h"
+#include "falconmind/sdk/sensors/PointCloudPacket.h"
+#include "falconmind/sdk/core/NodePlacement.h"
 #include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <iostream>
 #include <sstream>
+#include <vector>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace falconmind::sdk::sensors {
 
 using namespace falconmind::sdk::core;
 
+namespace {
+
+constexpr std::size_t kUdpBatch = 32;          // 每次 recvmmsg 最多收取的包数
+constexpr std::size_t kUdpPacketBytes = 2048;  // 单包上限（VLP-16 1206 / Livox ≤1362）
+constexpr int kUdpRecvBuffer = 8 << 20;        // 内核接收缓冲：10 Hz 扫描间隙的突发不丢包
+
+bool endsWith(const std::string& s, const char* suffix) {
+    std::size_t n = std::strlen(suffix);
+    if (s.size() < n) return false;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::tolower(static_cast<unsigned char>(s[s.size() - n + i])) != suffix[i]) return false;
+    }
+    return true;
+}
+
+float loadFloat(const std::uint8_t* p) {
+    float v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+} // namespace
+
+// 只读映射整个文件；最后一个引用释放时解除映射
+struct LidarSourceNode::MappedFile {
+    const std::uint8_t* data{nullptr};
+    std::size_t size{0};
+
+    ~MappedFile() {
+#ifdef __linux__
+        if (data) munmap(const_cast<std::uint8_t*>(data), size);
+#endif
+    }
+
+    static std::shared_ptr<MappedFile> open(const std::string& path) {
+#ifdef __linux__
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return nullptr;
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            close(fd);
+            return nullptr;
+        }
+        void* p = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) return nullptr;
+        madvise(p, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+        auto file = std::make_shared<MappedFile>();
+        file->data = static_cast<const std::uint8_t*>(p);
+        file->size = static_cast<std::size_t>(st.st_size);
+        return file;
+#else
+        (void)path;
+        return nullptr;
+#endif
+    }
+};
+
 LidarSourceNode::LidarSourceNode() : Node("lidar_source") {
-    addPad(std::make_shared<Pad>("pointcloud_out", PadType::Source));
+    outPad_ = addPad(std::make_shared<Pad>("pointcloud_out", PadType::Source));
 }
 
+LidarSourceNode::~LidarSourceNode() { closeUdp(); }
+
 bool LidarSourceNode::configure(const std::unordered_map<std::string, std::string>& params) {
     auto it = params.find("device");
     if (it != params.end()) deviceOrUri_ = it->second;
     auto itUri = params.find("uri");
     if (itUri != params.end()) deviceOrUri_ = itUri->second;
+    auto itFormat = params.find("format");
+    if (itFormat != params.end()) {
+        packetFormat_ = parseLidarPacketFormat(itFormat->second);
+        if (packetFormat_ == LidarPacketFormat::Unknown) {
+            std::cerr << "[LidarSourceNode] unknown packet format: " << itFormat->second << std::endl;
+            return false;
+        }
+    }
+    auto itMax = params.find("max_points");
+    if (itMax != params.end()) {
+        maxPoints_ = static_cast<std::uint32_t>(std::max(1ul, std::stoul(itMax->second)));
+    }
+    auto itPeriod = params.find("frame_period_ms");
+    if (itPeriod != params.end()) {
+        framePeriodNs_ = std::max<std::int64_t>(1'000'000, static_cast<std::int64_t>(std::stod(itPeriod->second) * 1e6));
+    }
+    auto itSync = params.find("time_sync");
+    if (itSync != params.end()) {
+        if (itSync->second != "sensor" && itSync->second != "arrival") {
+            std::cerr << "[LidarSourceNode] unknown time_sync: " << itSync->second << std::endl;
+            return false;
+        }
+        sensorTimeSync_ = itSync->second == "sensor";
+    }
     return true;
 }
 
 void LidarSourceNode::pushPointCloud(const PointCloud& cloud) {
-    auto outPad = getPad("pointcloud_out");
+    auto* outPad = outPad_;
     if (!outPad || cloud.empty()) return;
     outPad->pushToConnections(cloud.data(), cloud.size() * sizeof(PointXYZI));
 }
 
+bool LidarSourceNode::parsePcdHeader(const std::uint8_t* data, std::size_t size, BinaryLayout& layout) {
+    // 文件头为若干文本行，以 "DATA ..." 行结束；其后紧跟按 SIZE 紧凑排列的点记录
+    std::vector<std::string> fields;
+    std::vector<int> sizes;
+    std::vector<char> types;
+    std::vector<int> counts;
+    std::uint64_t points = 0;
+    std::uint64_t width = 0;
+    std::uint64_t height = 1;
+    std::size_t pos = 0;
+    bool binary = false;
+    while (pos < size) {
+        const auto* nl = static_cast<const std::uint8_t*>(std::memchr(data + pos, '\n', size - pos));
+        if (!nl) return false;
+        std::string line(reinterpret_cast<const char*>(data + pos), static_cast<std::size_t>(nl - (data + pos)));
+        pos = static_cast<std::size_t>(nl - data) + 1;
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ss(line);
+        std::string key;
+        ss >> key;
+        if (key == "FIELDS") {
+            for (std::string f; ss >> f;) fields.push_back(f);
+        } else if (key == "SIZE") {
+            for (int v; ss >> v;) sizes.push_back(v);
+        } else if (key == "TYPE") {
+            for (char t; ss >> t;) types.push_back(t);
+        } else if (key == "COUNT") {
+            for (int v; ss >> v;) counts.push_back(v);
+        } else if (key == "WIDTH") {
+            ss >> width;
+        } else if (key == "HEIGHT") {
+            ss >> height;
+        } else if (key == "POINTS") {
+            ss >> points;
+        } else if (key == "DATA") {
+            std::string mode;
+            ss >> mode;
+            binary = mode == "binary";  // ascii 走文本回放路径；binary_compressed 暂不支持
+            break;
+        }
+    }
+    if (!binary || fields.empty() || sizes.size() != fields.size() || types.size() != fields.size()) return false;
+    if (counts.empty()) counts.assign(fields.size(), 1);
+    if (counts.size() != fields.size()) return false;
+    if (points == 0) points = width * height;
+
+    BinaryLayout out;
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        const std::string& f = fields[i];
+        const int off = static_cast<int>(offset);
+        const bool f4 = types[i] == 'F' && sizes[i] == 4 && counts[i] == 1;
+        if (f == "x" && f4) out.xOff = off;
+        else if (f == "y" && f4) out.yOff = off;
+        else if (f == "z" && f4) out.zOff = off;
+        else if ((f == "intensity" || f == "i") && counts[i] == 1 &&
+                 (f4 || (types[i] == 'U' && (sizes[i] == 1 || sizes[i] == 2)))) {
+            out.intensityOff = off;
+            out.intensityType = types[i];
+            out.intensitySize = sizes[i];
+        } else if (f == "ring" && types[i] == 'U' && sizes[i] == 2 && counts[i] == 1) {
+            out.ringOff = off;
+        }
+        offset += static_cast<std::size_t>(sizes[i]) * static_cast<std::size_t>(counts[i]);
+    }
+    if (out.xOff < 0 || out.yOff < 0 || out.zOff < 0 || offset == 0) return false;
+    out.dataOffset = pos;
+    out.pointStep = offset;
+    // 文件被截断时只取完整的点
+    std::uint64_t available = (size - pos) / offset;
+    out.points = static_cast<std::uint32_t>(std::min<std::uint64_t>({points, available, 0xFFFFFFF0u}));
+    layout = out;
+    return true;
+}
+
+bool LidarSourceNode::openBinaryFile(const std::string& path) {
+    auto file = MappedFile::open(path);
+    if (!file) return false;
+    BinaryLayout layout;
+    if (endsWith(path, ".bin")) {
+        // KITTI velodyne：每点 float x y z reflectance
+        layout.pointStep = 4 * sizeof(float);
+        layout.points = static_cast<std::uint32_t>(std::min<std::size_t>(file->size / layout.pointStep, 0xFFFFFFF0u));
+        layout.xOff = 0;
+        layout.yOff = 4;
+        layout.zOff = 8;
+        layout.intensityOff = 12;
+    } else if (!parsePcdHeader(file->data, file->size, layout)) {
+        return false;
+    }
+    if (layout.points == 0) return false;
+    binary_ = std::move(file);
+    layout_ = layout;
+    return true;
+}
+
+void LidarSourceNode::pushBinaryScan() {
+    if (!outPad_) return;
+    const std::uint32_t capacity = pointCloudCapacityAligned(layout_.points);
+    BufferRef scan = scanPool_.acquire(BufferPoolKey{static_cast<std::int32_t>(capacity), 0, "FMPC"},
+                                      pointCloudPacketSize(capacity));
+    PointCloudWriter writer;
+    if (!writer.reset(scan.mutableData(), scan.size(), capacity)) return;
+    const std::int64_t now = PipelineClock::nowNs();
+    writer.header->timestampNs = now;
+    writer.header->frameIndex = binaryFrames_++;
+
+    // 按字段转置：每个目标数组顺序写，源记录定长步进，无逐点分支与分配
+    const std::uint8_t* src = binary_->data + layout_.dataOffset;
+    const std::size_t step = layout_.pointStep;
+    const std::uint32_t n = layout_.points;
+    for (std::uint32_t i = 0; i < n; ++i) {
+        const std::uint8_t* p = src + i * step;
+        writer.x[i] = loadFloat(p + layout_.xOff);
+        writer.y[i] = loadFloat(p + layout_.yOff);
+        writer.z[i] = loadFloat(p + layout_.zOff);
+    }
+    if (layout_.intensityOff < 0) {
+        std::fill(writer.intensity, writer.intensity + n, 0.0f);
+    } else if (layout_.intensityType == 'F') {
+        for (std::uint32_t i = 0; i < n; ++i) writer.intensity[i] = loadFloat(src + i * step + layout_.intensityOff);
+    } else if (layout_.intensitySize == 1) {
+        for (std::uint32_t i = 0; i < n; ++i) writer.intensity[i] = src[i * step + layout_.intensityOff];
+    } else {
+        for (std::uint32_t i = 0; i < n; ++i) {
+            std::uint16_t v;
+            std::memcpy(&v, src + i * step + layout_.intensityOff, sizeof(v));
+            writer.intensity[i] = v;
+        }
+    }
+    std::fill(writer.timeOffsetNs, writer.timeOffsetNs + n, 0u);  // 文件不含逐点时间
+    if (layout_.ringOff < 0) {
+        std::fill(writer.ring, writer.ring + n, std::uint16_t{0});
+    } else {
+        for (std::uint32_t i = 0; i < n; ++i) std::memcpy(&writer.ring[i], src + i * step + layout_.ringOff, 2);
+    }
+    writer.header->count = n;
+    scan.mutableMeta().timestampNs = now;
+    outPad_->pushBuffer(scan);
+    scansPushed_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool LidarSourceNode::startUdp(const std::string& uri) {
+#ifdef __linux__
+    if (packetFormat_ == LidarPacketFormat::Unknown) {
+        std::cerr << "[LidarSourceNode] udp source requires format=vlp16|livox" << std::endl;
+        return false;
+    }
+    // udp://[host]:port；host 为空或 0.0.0.0 时监听所有地址
+    std::string rest = uri.substr(6);
+    auto colon = rest.rfind(':');
+    std::string host = colon == std::string::npos ? std::string() : rest.substr(0, colon);
+    std::string portText = colon == std::string::npos ? rest : rest.substr(colon + 1);
+    int port = 0;
+    try {
+        port = std::stoi(portText);
+    } catch (...) {
+        port = 0;
+    }
+    if (port <= 0 || port > 65535) {
+        std::cerr << "[LidarSourceNode] invalid udp uri: " << uri << std::endl;
+        return false;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<std::uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (!host.empty() && host != "0.0.0.0" && inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+        std::cerr << "[LidarSourceNode] invalid udp host: " << host << std::endl;
+        return false;
+    }
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0) {
+        std::cerr << "[LidarSourceNode] socket failed: " << errno << std::endl;
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    int rcvbuf = kUdpRecvBuffer;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));  // 受 rmem_max 限制，失败不影响接收
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::cerr << "[LidarSourceNode] bind udp port " << port << " failed: " << errno << std::endl;
+        close(fd);
+        return false;
+    }
+    wakeFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd_ < 0) {
+        std::cerr << "[LidarSourceNode] eventfd failed: " << errno << std::endl;
+        close(fd);
+        return false;
+    }
+    udpFd_ = fd;
+    udpRunning_.store(true, std::memory_order_release);
+    udpThread_ = std::thread([this] { udpLoop(); });
+    std::cout << "[LidarSourceNode] receiving " << lidarPacketFormatName(packetFormat_) << " packets on udp port "
+              << port << ", scan capacity " << pointCloudCapacityAligned(maxPoints_) << std::endl;
+    return true;
+#else
+    std::cerr << "[LidarSourceNode] udp source not supported on this platform: " << uri << std::endl;
+    return false;
+#endif
+}
+
+void LidarSourceNode::closeUdp() {
+#ifdef __linux__
+    if (udpThread_.joinable()) {
+        udpRunning_.store(false, std::memory_order_release);
+        std::uint64_t one = 1;
+        (void)!write(wakeFd_, &one, sizeof(one));
+        udpThread_.join();
+    }
+    if (udpFd_ >= 0) close(udpFd_);
+    if (wakeFd_ >= 0) close(wakeFd_);
+#endif
+    udpFd_ = -1;
+    wakeFd_ = -1;
+}
+
+void LidarSourceNode::udpLoop() {
+#ifdef __linux__
+    if (placement().pinsThread()) {
+        applyThreadPlacement(placement(), id());
+    }
+    // 扫描帧完成后在接收线程直接推送；缓冲来自 scanPool_，稳态下无分配
+    LidarScanAssembler assembler(packetFormat_, maxPoints_, scanPool_, [this](BufferRef scan) {
+        if (outPad_) outPad_->pushBuffer(scan);
+        scansPushed_.fetch_add(1, std::memory_order_relaxed);
+    }, framePeriodNs_);
+    // 扫描帧时间戳取自包内传感器时钟（经 TimeSyncService 映射），不受 recvmmsg 批量与调度抖动影响
+    if (sensorTimeSync_) assembler.setClockSync(core::TimeSyncService::instance().clock(id()));
+
+    std::vector<std::uint8_t> storage(kUdpBatch * kUdpPacketBytes);
+    std::vector<iovec> iovs(kUdpBatch);
+    std::vector<mmsghdr> msgs(kUdpBatch);
+    for (std::size_t i = 0; i < kUdpBatch; ++i) {
+        iovs[i].iov_base = storage.data() + i * kUdpPacketBytes;
+        iovs[i].iov_len = kUdpPacketBytes;
+        msgs[i].msg_hdr = msghdr{};
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    while (udpRunning_.load(std::memory_order_acquire)) {
+        pollfd fds[2] = {{wakeFd_, POLLIN, 0}, {udpFd_, POLLIN, 0}};
+        int n = poll(fds, 2, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[LidarSourceNode] udp poll failed: " << errno << std::endl;
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            std::uint64_t value = 0;
+            (void)!read(wakeFd_, &value, sizeof(value));
+            continue;  // 重新检查 running
+        }
+        if (!(fds[1].revents & POLLIN)) continue;
+        int received = recvmmsg(udpFd_, msgs.data(), static_cast<unsigned>(kUdpBatch), MSG_DONTWAIT, nullptr);
+        if (received <= 0) continue;
+        // 暂停时照常收包（避免内核缓冲积压旧数据），但不解码
+        if (paused_.load(std::memory_order_acquire)) continue;
+        if (resetScan_.exchange(false, std::memory_order_acq_rel)) assembler.reset();
+        const std::int64_t now = PipelineClock::nowNs();
+        for (int i = 0; i < received; ++i) {
+            assembler.feed(static_cast<const std::uint8_t*>(iovs[i].iov_base), msgs[i].msg_len, now);
+        }
+        const auto& stats = assembler.stats();
+        packetsReceived_.store(stats.packets, std::memory_order_relaxed);
+        malformedPackets_.store(stats.malformedPackets, std::memory_order_relaxed);
+        truncatedPoints_.store(stats.truncatedPoints, std::memory_order_relaxed);
+    }
+#endif
+}
+
 bool LidarSourceNode::start() {
+    closeUdp();
     started_ = true;
     replayMode_ = false;
     replayFile_.close();
-    if (!deviceOrUri_.empty() && deviceOrUri_ != "sim") {
+    capture_.reset();
+    captureNext_ = 0;
+    binary_.reset();
+    binaryFrames_ = 0;
+    paused_.store(false);
+    resetScan_.store(false);
+    if (deviceOrUri_.rfind("udp://", 0) == 0) {
+        return startUdp(deviceOrUri_);
+    }
+    if (!deviceOrUri_.empty() && deviceOrUri_ != "sim" && CaptureReader::isCaptureFile(deviceOrUri_)) {
+        capture_ = CaptureReader::open(deviceOrUri_);
+        if (capture_ && !capture_->empty()) {
+            replayMode_ = true;
+            std::cout << "[LidarSourceNode] start replay from capture file: " << deviceOrUri_
+                      << " records=" << capture_->size() << std::endl;
+        } else {
+            capture_.reset();
+            std::cout << "[LidarSourceNode] start: capture file has no records" << std::endl;
+        }
+    } else if (!deviceOrUri_.empty() && deviceOrUri_ != "sim" &&
+               (endsWith(deviceOrUri_, ".bin") || endsWith(deviceOrUri_, ".pcd")) && openBinaryFile(deviceOrUri_)) {
+        replayMode_ = true;
+        std::cout << "[LidarSourceNode] start replay from binary point cloud: " << deviceOrUri_
+                  << " points=" << layout_.points << std::endl;
+    } else if (!deviceOrUri_.empty() && deviceOrUri_ != "sim") {
+        // 文本格式（含 DATA ascii 的 .pcd：文件头行不能解析为坐标，被跳过）
         replayFile_.open(deviceOrUri_);
         if (replayFile_.is_open()) {
             replayMode_ = true;
@@ -44,10 +447,42 @@ bool LidarSourceNode::start() {
     return true;
 }
 
+void LidarSourceNode::stop() {
+    closeUdp();
+    started_ = false;
+    replayMode_ = false;
+    replayFile_.close();
+    binary_.reset();
+    capture_.reset();
+}
+
+void LidarSourceNode::pause() {
+    paused_.store(true, std::memory_order_release);
+}
+
+void LidarSourceNode::resume() {
+    resetScan_.store(true, std::memory_order_release);
+    paused_.store(false, std::memory_order_release);
+}
+
 void LidarSourceNode::process() {
-    if (!started_ || !replayMode_ || !replayFile_.is_open()) return;
+    if (!started_ || !replayMode_) return;  // UDP 模式由接收线程推送
+    if (binary_) {
+        pushBinaryScan();  // 单帧文件：每次推送整帧，循环回放
+        return;
+    }
+    if (capture_) {
+        // 每次推送一条记录，到末尾后循环；时间戳改写为回放时刻
+        BufferRef buffer = capture_->buffer(captureNext_);
+        captureNext_ = (captureNext_ + 1) % capture_->size();
+        if (buffer.size() < sizeof(PointXYZI) || !outPad_) return;
+        buffer.mutableMeta().timestampNs = PipelineClock::nowNs();
+        outPad_->pushBuffer(buffer);
+        return;
+    }
+    if (!replayFile_.is_open()) return;
 
-    PointCloud cloud;
+    asciiCloud_.clear();
     std::string line;
     while (std::getline(replayFile_, line)) {
         if (line.empty() || line[0] == '#') continue;
@@ -55,12 +490,12 @@ void LidarSourceNode::process() {
         PointXYZI pt;
         if (ss >> pt.x >> pt.y >> pt.z) {
             ss >> pt.intensity;
-            cloud.push_back(pt);
+            asciiCloud_.push_back(pt);
         }
-        if (cloud.size() >= 100000) break;
+        if (asciiCloud_.size() >= 100000) break;
     }
-    if (!cloud.empty()) {
-        pushPointCloud(cloud);
+    if (!asciiCloud_.empty()) {
+        pushPointCloud(asciiCloud_);
     }
     if (replayFile_.eof()) {
         replayFile_.clear();
@@ -0,0 +1,176 @@
+#include "falconmind/sdk/sensors/JpegDecoder.h"
+
+#include <cstring>
+#include <iostream>
+
+#if defined(FALCONMINDSDK_MPP_JPEG_ENABLED)
+#include <rockchip/mpp_buffer.h>
+#include <rockchip/mpp_frame.h>
+#include <rockchip/mpp_meta.h>
+#include <rockchip/mpp_packet.h>
+#include <rockchip/mpp_task.h>
+#include <rockchip/rk_mpi.h>
+#endif
+
+namespace falconmind::sdk::sensors {
+
+using core::PixelFormat;
+
+#if defined(FALCONMINDSDK_MPP_JPEG_ENABLED)
+
+namespace {
+
+int align16(int v) { return (v + 15) & ~15; }
+
+} // namespace
+
+struct MppJpegDecoder::Impl {
+    MppCtx ctx{nullptr};
+    MppApi* mpi{nullptr};
+    MppBufferGroup group{nullptr};
+    MppBuffer frameBuf{nullptr};
+    MppBuffer packetBuf{nullptr};
+    std::size_t packetBytes{0};
+    int width{0}, height{0};
+    bool warnedFormat{false};
+
+    ~Impl() { close(); }
+
+    void close() {
+        if (packetBuf) mpp_buffer_put(packetBuf);
+        if (frameBuf) mpp_buffer_put(frameBuf);
+        if (group) mpp_buffer_group_put(group);
+        if (ctx) mpp_destroy(ctx);
+        packetBuf = frameBuf = nullptr;
+        group = nullptr;
+        ctx = nullptr;
+        mpi = nullptr;
+        packetBytes = 0;
+        width = height = 0;
+    }
+
+    // 按尺寸打开解码器（任务模式：每帧输入 packetBuf、输出 frameBuf，均为预分配的 DRM 缓冲）
+    bool open(int w, int h) {
+        close();
+        MppFrameFormat format = MPP_FMT_YUV420SP;
+        RK_S64 timeout = MPP_POLL_BLOCK;
+        if (mpp_create(&ctx, &mpi) != MPP_OK || mpi->control(ctx, MPP_SET_INPUT_TIMEOUT, &timeout) != MPP_OK ||
+            mpi->control(ctx, MPP_SET_OUTPUT_TIMEOUT, &timeout) != MPP_OK ||
+            mpp_init(ctx, MPP_CTX_DEC, MPP_VIDEO_CodingMJPEG) != MPP_OK ||
+            mpi->control(ctx, MPP_DEC_SET_OUTPUT_FORMAT, &format) != MPP_OK) {
+            std::cerr << "[MppJpegDecoder] mpp init failed" << std::endl;
+            close();
+            return false;
+        }
+        // 输出按 4:2:2 预留，驱动不支持色度下采样时仍能写下
+        const std::size_t frameBytes = static_cast<std::size_t>(align16(w)) * align16(h) * 2;
+        if (mpp_buffer_group_get_internal(&group, MPP_BUFFER_TYPE_DRM) != MPP_OK ||
+            mpp_buffer_get(group, &frameBuf, frameBytes) != MPP_OK) {
+            std::cerr << "[MppJpegDecoder] buffer allocation failed" << std::endl;
+            close();
+            return false;
+        }
+        width = w;
+        height = h;
+        return true;
+    }
+
+    bool reservePacket(std::size_t size) {
+        if (size <= packetBytes) return true;
+        if (packetBuf) mpp_buffer_put(packetBuf);
+        packetBuf = nullptr;
+        packetBytes = 0;
+        const std::size_t bytes = (size + 4095) & ~std::size_t{4095};
+        if (mpp_buffer_get(group, &packetBuf, bytes) != MPP_OK) return false;
+        packetBytes = bytes;
+        return true;
+    }
+};
+
+MppJpegDecoder::MppJpegDecoder() : impl_(std::make_unique<Impl>()) {}
+MppJpegDecoder::~MppJpegDecoder() = default;
+
+bool MppJpegDecoder::available() {
+    return mpp_check_support_format(MPP_CTX_DEC, MPP_VIDEO_CodingMJPEG) == MPP_OK;
+}
+
+bool MppJpegDecoder::decode(const std::uint8_t* jpeg, std::size_t size, const WritableImageSurface& dst) {
+    int width = 0, height = 0;
+    if (!dst.data || dst.format != PixelFormat::NV12 || !readJpegSize(jpeg, size, width, height) ||
+        width != dst.width || height != dst.height) {
+        return false;
+    }
+    Impl& m = *impl_;
+    if ((m.width != width || m.height != height) && !m.open(width, height)) return false;
+    if (!m.reservePacket(size)) return false;
+    std::memcpy(mpp_buffer_get_ptr(m.packetBuf), jpeg, size);
+
+    MppPacket packet = nullptr;
+    MppFrame frame = nullptr;
+    mpp_packet_init_with_buffer(&packet, m.packetBuf);
+    mpp_packet_set_length(packet, size);
+    if (mpp_frame_init(&frame) != MPP_OK) {
+        mpp_packet_deinit(&packet);
+        return false;
+    }
+    mpp_frame_set_buffer(frame, m.frameBuf);
+
+    MppTask task = nullptr;
+    bool ok = m.mpi->poll(m.ctx, MPP_PORT_INPUT, MPP_POLL_BLOCK) == MPP_OK &&
+              m.mpi->dequeue(m.ctx, MPP_PORT_INPUT, &task) == MPP_OK && task != nullptr;
+    if (ok) {
+        mpp_task_meta_set_packet(task, KEY_INPUT_PACKET, packet);
+        mpp_task_meta_set_frame(task, KEY_OUTPUT_FRAME, frame);
+        ok = m.mpi->enqueue(m.ctx, MPP_PORT_INPUT, task) == MPP_OK;
+    }
+    MppFrame out = nullptr;
+    task = nullptr;
+    ok = ok && m.mpi->poll(m.ctx, MPP_PORT_OUTPUT, MPP_POLL_BLOCK) == MPP_OK &&
+         m.mpi->dequeue(m.ctx, MPP_PORT_OUTPUT, &task) == MPP_OK && task != nullptr;
+    if (ok) {
+        mpp_task_meta_get_frame(task, KEY_OUTPUT_FRAME, &out);
+        m.mpi->enqueue(m.ctx, MPP_PORT_OUTPUT, task);
+        ok = out != nullptr && !mpp_frame_get_errinfo(out) && !mpp_frame_get_discard(out);
+    }
+    if (ok && mpp_frame_get_fmt(out) != MPP_FMT_YUV420SP) {
+        if (!m.warnedFormat) std::cerr << "[MppJpegDecoder] decoder did not output NV12" << std::endl;
+        m.warnedFormat = true;
+        ok = false;
+    }
+    if (ok) {
+        // 解码输出为 16 对齐行宽，逐行复制到帧缓冲
+        const std::size_t horStride = mpp_frame_get_hor_stride(out);
+        const std::size_t verStride = mpp_frame_get_ver_stride(out);
+        const std::size_t dstStride = dst.stride > 0 ? static_cast<std::size_t>(dst.stride) : dst.width;
+        const auto* src = static_cast<const std::uint8_t*>(mpp_buffer_get_ptr(mpp_frame_get_buffer(out)));
+        for (int y = 0; y < height; ++y) {
+            std::memcpy(dst.data + y * dstStride, src + y * horStride, static_cast<std::size_t>(width));
+        }
+        const std::uint8_t* srcUv = src + horStride * verStride;
+        std::uint8_t* dstUv = dst.data + dstStride * height;
+        for (int y = 0; y < height / 2; ++y) {
+            std::memcpy(dstUv + y * dstStride, srcUv + y * horStride, static_cast<std::size_t>(width));
+        }
+    }
+    mpp_packet_deinit(&packet);
+    mpp_frame_deinit(&frame);
+    return ok;
+}
+
+#else
+
+struct MppJpegDecoder::Impl {};
+
+MppJpegDecoder::MppJpegDecoder() : impl_(std::make_unique<Impl>()) {}
+MppJpegDecoder::~MppJpegDecoder() = default;
+
+bool MppJpegDecoder::available() { return false; }
+
+bool MppJpegDecoder::decode(const std::uint8_t*, std::size_t, const WritableImageSurface&) {
+    std::cerr << "[MppJpegDecoder] built without FALCONMINDSDK_BUILD_MPP_JPEG" << std::endl;
+    return false;
+}
+
+#endif
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,174 @@
+#include "falconmind/sdk/sensors/JpegEncoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#if defined(FALCONMINDSDK_MPP_JPEG_ENABLED)
+#include <rockchip/mpp_buffer.h>
+#include <rockchip/mpp_frame.h>
+#include <rockchip/mpp_meta.h>
+#include <rockchip/mpp_packet.h>
+#include <rockchip/rk_mpi.h>
+#include <rockchip/rk_venc_cfg.h>
+#endif
+
+namespace falconmind::sdk::sensors {
+
+using core::PixelFormat;
+
+#if defined(FALCONMINDSDK_MPP_JPEG_ENABLED)
+
+namespace {
+
+int align16(int v) { return (v + 15) & ~15; }
+
+} // namespace
+
+struct MppJpegEncoder::Impl {
+    MppCtx ctx{nullptr};
+    MppApi* mpi{nullptr};
+    MppEncCfg cfg{nullptr};
+    MppBufferGroup group{nullptr};
+    MppBuffer frameBuf{nullptr};
+    MppBuffer packetBuf{nullptr};
+    int width{0}, height{0};
+    int horStride{0}, verStride{0};
+    int quality{-1};
+
+    ~Impl() { close(); }
+
+    void close() {
+        if (packetBuf) mpp_buffer_put(packetBuf);
+        if (frameBuf) mpp_buffer_put(frameBuf);
+        if (group) mpp_buffer_group_put(group);
+        if (cfg) mpp_enc_cfg_deinit(cfg);
+        if (ctx) mpp_destroy(ctx);
+        packetBuf = frameBuf = nullptr;
+        group = nullptr;
+        cfg = nullptr;
+        ctx = nullptr;
+        mpi = nullptr;
+        width = height = 0;
+        quality = -1;
+    }
+
+    // 按尺寸打开编码器；MJPEG 的每帧输出写入预分配的 packetBuf（KEY_OUTPUT_PACKET）
+    bool open(int w, int h) {
+        close();
+        horStride = align16(w);
+        verStride = align16(h);
+        if (mpp_create(&ctx, &mpi) != MPP_OK || mpp_init(ctx, MPP_CTX_ENC, MPP_VIDEO_CodingMJPEG) != MPP_OK ||
+            mpp_enc_cfg_init(&cfg) != MPP_OK || mpi->control(ctx, MPP_ENC_GET_CFG, cfg) != MPP_OK) {
+            std::cerr << "[MppJpegEncoder] mpp init failed" << std::endl;
+            close();
+            return false;
+        }
+        mpp_enc_cfg_set_s32(cfg, "prep:width", w);
+        mpp_enc_cfg_set_s32(cfg, "prep:height", h);
+        mpp_enc_cfg_set_s32(cfg, "prep:hor_stride", horStride);
+        mpp_enc_cfg_set_s32(cfg, "prep:ver_stride", verStride);
+        mpp_enc_cfg_set_s32(cfg, "prep:format", MPP_FMT_YUV420SP);
+        mpp_enc_cfg_set_s32(cfg, "rc:mode", MPP_ENC_RC_MODE_FIXQP);
+        const std::size_t frameBytes = static_cast<std::size_t>(horStride) * verStride * 3 / 2;
+        if (mpp_buffer_group_get_internal(&group, MPP_BUFFER_TYPE_DRM) != MPP_OK ||
+            mpp_buffer_get(group, &frameBuf, frameBytes) != MPP_OK ||
+            mpp_buffer_get(group, &packetBuf, frameBytes) != MPP_OK) {
+            std::cerr << "[MppJpegEncoder] buffer allocation failed" << std::endl;
+            close();
+            return false;
+        }
+        width = w;
+        height = h;
+        return true;
+    }
+
+    bool setQuality(int q) {
+        if (q == quality) return true;
+        mpp_enc_cfg_set_s32(cfg, "jpeg:q_factor", q);
+        mpp_enc_cfg_set_s32(cfg, "jpeg:qf_min", q);
+        mpp_enc_cfg_set_s32(cfg, "jpeg:qf_max", q);
+        if (mpi->control(ctx, MPP_ENC_SET_CFG, cfg) != MPP_OK) {
+            std::cerr << "[MppJpegEncoder] MPP_ENC_SET_CFG failed" << std::endl;
+            return false;
+        }
+        quality = q;
+        return true;
+    }
+};
+
+MppJpegEncoder::MppJpegEncoder() : impl_(std::make_unique<Impl>()) {}
+MppJpegEncoder::~MppJpegEncoder() = default;
+
+bool MppJpegEncoder::available() {
+    return mpp_check_support_format(MPP_CTX_ENC, MPP_VIDEO_CodingMJPEG) == MPP_OK;
+}
+
+bool MppJpegEncoder::encode(const ImageSurface& src, int quality, std::vector<std::uint8_t>& out) {
+    if (!src.data || src.width <= 0 || src.height <= 0 || src.format != PixelFormat::NV12 || (src.width & 1) ||
+        (src.height & 1)) {
+        return false;
+    }
+    Impl& m = *impl_;
+    if ((m.width != src.width || m.height != src.height) && !m.open(src.width, src.height)) return false;
+    if (!m.setQuality(std::clamp(quality, 1, 99))) return false;
+
+    // 复制到 16 对齐的 DRM 缓冲（缩略图只有几十 KB，复制远比重新导入 fd 便宜）
+    const int srcStride = src.stride > 0 ? src.stride : src.width;
+    auto* dst = static_cast<std::uint8_t*>(mpp_buffer_get_ptr(m.frameBuf));
+    for (int y = 0; y < src.height; ++y) {
+        std::memcpy(dst + static_cast<std::size_t>(y) * m.horStride, src.data + static_cast<std::size_t>(y) * srcStride,
+                    static_cast<std::size_t>(src.width));
+    }
+    const std::uint8_t* srcUv = src.data + static_cast<std::size_t>(srcStride) * src.height;
+    std::uint8_t* dstUv = dst + static_cast<std::size_t>(m.horStride) * m.verStride;
+    for (int y = 0; y < src.height / 2; ++y) {
+        std::memcpy(dstUv + static_cast<std::size_t>(y) * m.horStride, srcUv + static_cast<std::size_t>(y) * srcStride,
+                    static_cast<std::size_t>(src.width));
+    }
+
+    MppFrame frame = nullptr;
+    MppPacket packet = nullptr;
+    if (mpp_frame_init(&frame) != MPP_OK) return false;
+    mpp_frame_set_width(frame, src.width);
+    mpp_frame_set_height(frame, src.height);
+    mpp_frame_set_hor_stride(frame, m.horStride);
+    mpp_frame_set_ver_stride(frame, m.verStride);
+    mpp_frame_set_fmt(frame, MPP_FMT_YUV420SP);
+    mpp_frame_set_buffer(frame, m.frameBuf);
+    mpp_packet_init_with_buffer(&packet, m.packetBuf);
+    mpp_packet_set_length(packet, 0);
+    mpp_meta_set_packet(mpp_frame_get_meta(frame), KEY_OUTPUT_PACKET, packet);
+
+    bool ok = m.mpi->encode_put_frame(m.ctx, frame) == MPP_OK;
+    MppPacket result = nullptr;
+    ok = ok && m.mpi->encode_get_packet(m.ctx, &result) == MPP_OK && result != nullptr;
+    if (ok) {
+        const auto* data = static_cast<const std::uint8_t*>(mpp_packet_get_pos(result));
+        out.assign(data, data + mpp_packet_get_length(result));
+        if (result != packet) mpp_packet_deinit(&result);
+    } else {
+        std::cerr << "[MppJpegEncoder] encode failed" << std::endl;
+    }
+    mpp_packet_deinit(&packet);
+    mpp_frame_deinit(&frame);
+    return ok;
+}
+
+#else
+
+struct MppJpegEncoder::Impl {};
+
+MppJpegEncoder::MppJpegEncoder() : impl_(std::make_unique<Impl>()) {}
+MppJpegEncoder::~MppJpegEncoder() = default;
+
+bool MppJpegEncoder::available() { return false; }
+
+bool MppJpegEncoder::encode(const ImageSurface&, int, std::vector<std::uint8_t>&) {
+    std::cerr << "[MppJpegEncoder] built without FALCONMINDSDK_BUILD_MPP_JPEG" << std::endl;
+    return false;
+}
+
+#endif
+
+} // namespace falconmind::sdk::sensors
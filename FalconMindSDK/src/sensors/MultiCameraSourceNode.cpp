@@ -0,0 +1,284 @@
+#include "falconmind/sdk/sensors/MultiCameraSourceNode.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+#include "falconmind/sdk/core/NodePlacement.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+namespace falconmind::sdk::sensors {
+
+using namespace falconmind::sdk::core;
+
+namespace {
+
+constexpr std::size_t alignUp8(std::size_t n) { return (n + 7) & ~static_cast<std::size_t>(7); }
+
+} // namespace
+
+FrameSynchronizer::FrameSynchronizer() : FrameSynchronizer(Config{}) {}
+
+FrameSynchronizer::FrameSynchronizer(const Config& cfg) : cfg_(cfg), queues_(cfg.streams) {
+    if (cfg_.queueDepth == 0) cfg_.queueDepth = 1;
+}
+
+void FrameSynchronizer::push(std::size_t stream, BufferRef frame) {
+    if (stream >= queues_.size() || !frame) return;
+    auto& queue = queues_[stream];
+    if (queue.size() >= cfg_.queueDepth) {
+        queue.pop_front();
+        ++overflowDrops_;
+    }
+    queue.push_back(std::move(frame));
+}
+
+bool FrameSynchronizer::pop(FrameSet& out) {
+    if (queues_.empty()) return false;
+    for (;;) {
+        std::size_t oldest = 0;
+        std::int64_t minTs = 0;
+        std::int64_t maxTs = 0;
+        for (std::size_t i = 0; i < queues_.size(); ++i) {
+            if (queues_[i].empty()) return false;
+            std::int64_t ts = queues_[i].front().meta().timestampNs;
+            if (i == 0 || ts < minTs) {
+                minTs = ts;
+                oldest = i;
+            }
+            if (i == 0 || ts > maxTs) maxTs = ts;
+        }
+        if (maxTs - minTs > cfg_.maxSkewNs) {
+            // 其它路队首都晚于它且各路时间戳单调，该帧已无法成组
+            queues_[oldest].pop_front();
+            ++unmatchedDrops_;
+            continue;
+        }
+        out.index = sets_++;
+        out.timestampNs = minTs;
+        out.skewNs = maxTs - minTs;
+        out.frames.resize(queues_.size());
+        for (std::size_t i = 0; i < queues_.size(); ++i) {
+            out.frames[i] = std::move(queues_[i].front());
+            queues_[i].pop_front();
+        }
+        return true;
+    }
+}
+
+void FrameSynchronizer::clear() {
+    for (auto& queue : queues_) queue.clear();
+}
+
+MultiCameraSourceNode::MultiCameraSourceNode(const std::vector<VideoSourceConfig>& cameras, std::int64_t maxSkewNs)
+    : Node("multi_camera_source"), maxSkewNs_(maxSkewNs) {
+    setPad_ = addPad(std::make_shared<Pad>("frames_out", PadType::Source));
+    setCameras(cameras);
+}
+
+MultiCameraSourceNode::~MultiCameraSourceNode() { stop(); }
+
+void MultiCameraSourceNode::setCameras(const std::vector<VideoSourceConfig>& cameras) {
+    for (std::size_t i = 0; i < cameras_.size(); ++i) cameras_[i]->getPad("video_out")->disconnect();
+    cameras_.clear();
+    inputs_.clear();
+    outPads_.clear();
+    for (std::size_t i = 0; i < cameras.size(); ++i) {
+        VideoSourceConfig cfg = cameras[i];
+        cfg.captureThread = true;  // 各路独立采集线程，互不阻塞
+        auto cam = std::make_shared<CameraSourceNode>(cfg);
+        cam->setId(id() + ".cam" + std::to_string(i));
+        auto camPad = cam->getPad("video_out");
+
+        auto input = std::make_shared<Pad>("in" + std::to_string(i), PadType::Sink);
+        input->setBufferCallback([this, i](const BufferRef& frame) { onCameraFrame(i, frame); });
+        camPad->connectTo(input, id(), input->name());
+
+        // 对外 Pad 声明该路相机的能力；协商结果转给该路相机，使其请求设备原生输出协商格式
+        Pad* out = addPad(std::make_shared<Pad>("video_out_" + std::to_string(i), PadType::Source));
+        out->setCaps(camPad->caps());
+        std::weak_ptr<Pad> weakCamPad = camPad;
+        out->setCapsCallback([weakCamPad](const VideoCaps& caps) {
+            if (auto pad = weakCamPad.lock()) pad->setNegotiatedCaps(caps);
+        });
+        cameras_.push_back(std::move(cam));
+        inputs_.push_back(std::move(input));
+        outPads_.push_back(out);
+    }
+    std::lock_guard<std::mutex> lock(syncMutex_);
+    sync_ = FrameSynchronizer(FrameSynchronizer::Config{cameras_.size(), maxSkewNs_, queueDepth_});
+}
+
+bool MultiCameraSourceNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    if (running_.load()) {
+        std::cerr << "[MultiCameraSourceNode] configure ignored while running" << std::endl;
+        return false;
+    }
+    std::unordered_map<std::string, std::string> cameraParams;
+    std::vector<std::string> devices;
+    bool syncChanged = false;
+    for (const auto& [key, value] : params) {
+        if (key == "devices") {
+            std::stringstream ss(value);
+            std::string device;
+            while (std::getline(ss, device, ',')) {
+                device.erase(0, device.find_first_not_of(" \t"));
+                device.erase(device.find_last_not_of(" \t") + 1);
+                if (!device.empty()) devices.push_back(device);
+            }
+        } else if (key == "max_skew_ms") {
+            maxSkewNs_ = static_cast<std::int64_t>(std::stod(value) * 1e6);
+            syncChanged = true;
+        } else if (key == "queue_depth") {
+            queueDepth_ = std::max<std::size_t>(1, std::stoul(value));
+            syncChanged = true;
+        } else {
+            cameraParams[key] = value;
+        }
+    }
+    if (devices.size() > kMaxSyncedCameras) {
+        std::cerr << "[MultiCameraSourceNode] at most " << kMaxSyncedCameras << " cameras, got " << devices.size()
+                  << std::endl;
+        return false;
+    }
+    if (params.count("devices")) {
+        std::vector<VideoSourceConfig> configs(devices.size());
+        for (std::size_t i = 0; i < devices.size(); ++i) {
+            configs[i].sensorId = id() + ".cam" + std::to_string(i);
+            configs[i].device = devices[i];
+        }
+        setCameras(configs);
+    } else if (syncChanged) {
+        std::lock_guard<std::mutex> lock(syncMutex_);
+        sync_ = FrameSynchronizer(FrameSynchronizer::Config{cameras_.size(), maxSkewNs_, queueDepth_});
+    }
+    for (std::size_t i = 0; i < cameras_.size(); ++i) {
+        if (!cameraParams.empty() && !cameras_[i]->configure(cameraParams)) return false;
+        outPads_[i]->setCaps(cameras_[i]->getPad("video_out")->caps());  // 相机参数可能改变可输出的格式
+    }
+    return true;
+}
+
+bool MultiCameraSourceNode::start() {
+    if (cameras_.empty()) {
+        std::cerr << "[MultiCameraSourceNode] no cameras configured (set devices)" << std::endl;
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(syncMutex_);
+        sync_.clear();
+    }
+    paused_.store(false);
+    running_.store(true);
+    joinThread_ = std::thread([this] { joinLoop(); });
+    for (std::size_t i = 0; i < cameras_.size(); ++i) {
+        cameras_[i]->setId(id() + ".cam" + std::to_string(i));
+        cameras_[i]->setPlacement(placement());
+        if (!cameras_[i]->start()) {
+            std::cerr << "[MultiCameraSourceNode] camera " << i << " failed to start" << std::endl;
+            stop();
+            return false;
+        }
+    }
+    std::cout << "[MultiCameraSourceNode] started " << cameras_.size() << " cameras, max skew "
+              << maxSkewNs_ / 1000 << "us" << std::endl;
+    return true;
+}
+
+void MultiCameraSourceNode::stop() {
+    // 先停各路采集（之后不再有帧进入汇合队列），再停汇合线程
+    for (auto& cam : cameras_) cam->stop();
+    {
+        std::lock_guard<std::mutex> lock(syncMutex_);  // 与汇合线程的 wait 互斥，避免丢失唤醒
+        running_.store(false);
+    }
+    syncCv_.notify_all();
+    if (joinThread_.joinable()) joinThread_.join();
+    std::lock_guard<std::mutex> lock(syncMutex_);
+    sync_.clear();
+}
+
+void MultiCameraSourceNode::pause() {
+    paused_.store(true, std::memory_order_release);
+    for (auto& cam : cameras_) cam->pause();
+}
+
+void MultiCameraSourceNode::resume() {
+    {
+        // 暂停前残留的帧与恢复后的新帧相隔过久，不参与对齐
+        std::lock_guard<std::mutex> lock(syncMutex_);
+        sync_.clear();
+    }
+    paused_.store(false, std::memory_order_release);
+    for (auto& cam : cameras_) cam->resume();
+}
+
+void MultiCameraSourceNode::process() {
+    if (!running_.load(std::memory_order_relaxed)) return;
+    for (auto& cam : cameras_) cam->process();  // 有采集线程的相机立即返回
+}
+
+std::uint64_t MultiCameraSourceNode::unmatchedDrops() const {
+    std::lock_guard<std::mutex> lock(syncMutex_);
+    return sync_.unmatchedDrops() + sync_.overflowDrops();
+}
+
+void MultiCameraSourceNode::onCameraFrame(std::size_t index, const BufferRef& frame) {
+    if (paused_.load(std::memory_order_acquire)) return;
+    {
+        std::lock_guard<std::mutex> lock(syncMutex_);
+        sync_.push(index, frame);
+    }
+    syncCv_.notify_one();
+}
+
+void MultiCameraSourceNode::joinLoop() {
+    if (placement().pinsThread()) {
+        applyThreadPlacement(placement(), id());
+    }
+    std::unique_lock<std::mutex> lock(syncMutex_);
+    while (running_.load(std::memory_order_acquire)) {
+        FrameSet set;
+        if (!sync_.pop(set)) {
+            syncCv_.wait(lock);
+            continue;
+        }
+        lock.unlock();
+        emit(set);
+        lock.lock();
+    }
+}
+
+void MultiCameraSourceNode::emit(const FrameSet& set) {
+    for (std::size_t i = 0; i < set.frames.size() && i < outPads_.size(); ++i) {
+        outPads_[i]->pushBuffer(set.frames[i]);
+    }
+    if (setPad_ && setPad_->isConnected()) {
+        MultiCameraFramePacket header{};
+        header.count = static_cast<std::uint32_t>(set.frames.size());
+        header.setIndex = set.index;
+        header.timestampNs = set.timestampNs;
+        header.skewNs = set.skewNs;
+        std::size_t total = alignUp8(sizeof(MultiCameraFramePacket));
+        for (std::size_t i = 0; i < set.frames.size(); ++i) {
+            header.offsets[i] = total;
+            header.sizes[i] = set.frames[i].size();
+            total += alignUp8(set.frames[i].size());
+        }
+        BufferRef packed = setPool_.acquire(BufferPoolKey{static_cast<std::int32_t>(header.count), 0, "frameset"},
+                                            total);
+        std::uint8_t* dst = packed.mutableData();
+        std::memcpy(dst, &header, sizeof(header));
+        for (std::size_t i = 0; i < set.frames.size(); ++i) {
+            std::memcpy(dst + header.offsets[i], set.frames[i].data(), set.frames[i].size());
+        }
+        auto& meta = packed.mutableMeta();
+        meta.timestampNs = set.timestampNs;
+        meta.frameIndex = set.index;
+        setPad_->pushBuffer(packed);
+    }
+    frameSets_.fetch_add(1, std::memory_order_relaxed);
+    lastSkewNs_.store(set.skewNs, std::memory_order_relaxed);
+}
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,93 @@
+#include "falconmind/sdk/sensors/JpegDecoder.h"
+
+#include <iostream>
+
+#if defined(FALCONMINDSDK_NVJPEG_ENABLED)
+#include <cuda_runtime.h>
+#include <nvjpeg.h>
+#endif
+
+namespace falconmind::sdk::sensors {
+
+using core::PixelFormat;
+
+#if defined(FALCONMINDSDK_NVJPEG_ENABLED)
+
+struct NvjpegDecoder::Impl {
+    nvjpegHandle_t handle{nullptr};
+    nvjpegJpegState_t state{nullptr};
+    cudaStream_t stream{nullptr};
+    void* device{nullptr};
+    std::size_t deviceBytes{0};
+    bool ready{false};
+
+    ~Impl() {
+        if (device) cudaFree(device);
+        if (state) nvjpegJpegStateDestroy(state);
+        if (handle) nvjpegDestroy(handle);
+        if (stream) cudaStreamDestroy(stream);
+    }
+};
+
+NvjpegDecoder::NvjpegDecoder() : impl_(std::make_unique<Impl>()) {
+    Impl& n = *impl_;
+    // 优先硬件后端（Jetson NVJPG / A100 等），不支持时退回默认的 CUDA 混合解码
+    n.ready = cudaStreamCreateWithFlags(&n.stream, cudaStreamNonBlocking) == cudaSuccess &&
+              (nvjpegCreateEx(NVJPEG_BACKEND_HARDWARE, nullptr, nullptr, 0, &n.handle) == NVJPEG_STATUS_SUCCESS ||
+               nvjpegCreateSimple(&n.handle) == NVJPEG_STATUS_SUCCESS) &&
+              nvjpegJpegStateCreate(n.handle, &n.state) == NVJPEG_STATUS_SUCCESS;
+    if (!n.ready) std::cerr << "[NvjpegDecoder] nvjpeg init failed" << std::endl;
+}
+
+NvjpegDecoder::~NvjpegDecoder() = default;
+
+bool NvjpegDecoder::available() {
+    int devices = 0;
+    return cudaGetDeviceCount(&devices) == cudaSuccess && devices > 0;
+}
+
+bool NvjpegDecoder::decode(const std::uint8_t* jpeg, std::size_t size, const WritableImageSurface& dst) {
+    Impl& n = *impl_;
+    int width = 0, height = 0;
+    if (!n.ready || !dst.data || !supportsOutput(dst.format) || !readJpegSize(jpeg, size, width, height) ||
+        width != dst.width || height != dst.height) {
+        return false;
+    }
+    const std::size_t pitch = static_cast<std::size_t>(width) * 3;
+    const std::size_t bytes = pitch * height;
+    if (bytes > n.deviceBytes) {
+        if (n.device) cudaFree(n.device);
+        n.device = nullptr;
+        n.deviceBytes = 0;
+        if (cudaMalloc(&n.device, bytes) != cudaSuccess) return false;
+        n.deviceBytes = bytes;
+    }
+    nvjpegImage_t image{};
+    image.channel[0] = static_cast<unsigned char*>(n.device);
+    image.pitch[0] = pitch;
+    const nvjpegOutputFormat_t output = dst.format == PixelFormat::BGR8 ? NVJPEG_OUTPUT_BGRI : NVJPEG_OUTPUT_RGBI;
+    const std::size_t dstPitch = dst.stride > 0 ? static_cast<std::size_t>(dst.stride) : pitch;
+    const bool ok = nvjpegDecode(n.handle, n.state, jpeg, size, output, &image, n.stream) == NVJPEG_STATUS_SUCCESS &&
+                    cudaMemcpy2DAsync(dst.data, dstPitch, n.device, pitch, pitch, static_cast<std::size_t>(height),
+                                      cudaMemcpyDeviceToHost, n.stream) == cudaSuccess &&
+                    cudaStreamSynchronize(n.stream) == cudaSuccess;
+    return ok;
+}
+
+#else
+
+struct NvjpegDecoder::Impl {};
+
+NvjpegDecoder::NvjpegDecoder() : impl_(std::make_unique<Impl>()) {}
+NvjpegDecoder::~NvjpegDecoder() = default;
+
+bool NvjpegDecoder::available() { return false; }
+
+bool NvjpegDecoder::decode(const std::uint8_t*, std::size_t, const WritableImageSurface&) {
+    std::cerr << "[NvjpegDecoder] built without FALCONMINDSDK_BUILD_NVJPEG" << std::endl;
+    return false;
+}
+
+#endif
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,109 @@
+#include "falconmind/sdk/sensors/JpegEncoder.h"
+
+#include <algorithm>
+#include <iostream>
+
+#if defined(FALCONMINDSDK_NVJPEG_ENABLED)
+#include <cuda_runtime.h>
+#include <nvjpeg.h>
+#endif
+
+namespace falconmind::sdk::sensors {
+
+using core::PixelFormat;
+
+#if defined(FALCONMINDSDK_NVJPEG_ENABLED)
+
+struct NvjpegEncoder::Impl {
+    nvjpegHandle_t handle{nullptr};
+    nvjpegEncoderState_t state{nullptr};
+    nvjpegEncoderParams_t params{nullptr};
+    cudaStream_t stream{nullptr};
+    void* device{nullptr};
+    std::size_t deviceBytes{0};
+    bool ready{false};
+
+    ~Impl() {
+        if (device) cudaFree(device);
+        if (params) nvjpegEncoderParamsDestroy(params);
+        if (state) nvjpegEncoderStateDestroy(state);
+        if (handle) nvjpegDestroy(handle);
+        if (stream) cudaStreamDestroy(stream);
+    }
+};
+
+NvjpegEncoder::NvjpegEncoder() : impl_(std::make_unique<Impl>()) {
+    Impl& n = *impl_;
+    n.ready = cudaStreamCreateWithFlags(&n.stream, cudaStreamNonBlocking) == cudaSuccess &&
+              nvjpegCreateSimple(&n.handle) == NVJPEG_STATUS_SUCCESS &&
+              nvjpegEncoderStateCreate(n.handle, &n.state, n.stream) == NVJPEG_STATUS_SUCCESS &&
+              nvjpegEncoderParamsCreate(n.handle, &n.params, n.stream) == NVJPEG_STATUS_SUCCESS &&
+              nvjpegEncoderParamsSetSamplingFactors(n.params, NVJPEG_CSS_420, n.stream) == NVJPEG_STATUS_SUCCESS;
+    if (!n.ready) std::cerr << "[NvjpegEncoder] nvjpeg init failed" << std::endl;
+}
+
+NvjpegEncoder::~NvjpegEncoder() = default;
+
+bool NvjpegEncoder::available() {
+    int devices = 0;
+    return cudaGetDeviceCount(&devices) == cudaSuccess && devices > 0;
+}
+
+bool NvjpegEncoder::encode(const ImageSurface& src, int quality, std::vector<std::uint8_t>& out) {
+    Impl& n = *impl_;
+    if (!n.ready || !src.data || src.width <= 0 || src.height <= 0 ||
+        (src.format != PixelFormat::RGB8 && src.format != PixelFormat::BGR8)) {
+        return false;
+    }
+    const std::size_t pitch = static_cast<std::size_t>(src.width) * 3;
+    const std::size_t bytes = pitch * src.height;
+    if (bytes > n.deviceBytes) {
+        if (n.device) cudaFree(n.device);
+        n.device = nullptr;
+        n.deviceBytes = 0;
+        if (cudaMalloc(&n.device, bytes) != cudaSuccess) return false;
+        n.deviceBytes = bytes;
+    }
+    const std::size_t srcPitch = src.stride > 0 ? static_cast<std::size_t>(src.stride) : pitch;
+    nvjpegImage_t image{};
+    image.channel[0] = static_cast<unsigned char*>(n.device);
+    image.pitch[0] = pitch;
+    const nvjpegInputFormat_t input = src.format == PixelFormat::BGR8 ? NVJPEG_INPUT_BGRI : NVJPEG_INPUT_RGBI;
+    std::size_t length = 0;
+    bool ok = cudaMemcpy2DAsync(n.device, pitch, src.data, srcPitch, pitch, static_cast<std::size_t>(src.height),
+                                cudaMemcpyHostToDevice, n.stream) == cudaSuccess &&
+              nvjpegEncoderParamsSetQuality(n.params, std::clamp(quality, 1, 100), n.stream) == NVJPEG_STATUS_SUCCESS &&
+              nvjpegEncodeImage(n.handle, n.state, n.params, &image, input, src.width, src.height, n.stream) ==
+                  NVJPEG_STATUS_SUCCESS &&
+              nvjpegEncodeRetrieveBitstream(n.handle, n.state, nullptr, &length, n.stream) == NVJPEG_STATUS_SUCCESS;
+    if (ok) {
+        out.resize(length);
+        ok = nvjpegEncodeRetrieveBitstream(n.handle, n.state, out.data(), &length, n.stream) ==
+                 NVJPEG_STATUS_SUCCESS &&
+             cudaStreamSynchronize(n.stream) == cudaSuccess;
+        out.resize(length);
+    }
+    if (!ok) {
+        std::cerr << "[NvjpegEncoder] encode failed" << std::endl;
+        out.clear();
+    }
+    return ok;
+}
+
+#else
+
+struct NvjpegEncoder::Impl {};
+
+NvjpegEncoder::NvjpegEncoder() : impl_(std::make_unique<Impl>()) {}
+NvjpegEncoder::~NvjpegEncoder() = default;
+
+bool NvjpegEncoder::available() { return false; }
+
+bool NvjpegEncoder::encode(const ImageSurface&, int, std::vector<std::uint8_t>&) {
+    std::cerr << "[NvjpegEncoder] built without FALCONMINDSDK_BUILD_NVJPEG" << std::endl;
+    return false;
+}
+
+#endif
+
+} // namespace falconmind::sdk::sensors
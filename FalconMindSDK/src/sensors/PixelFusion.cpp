@@ -0,0 +1,179 @@
+#include "falconmind/sdk/sensors/PixelFusion.h"
+#include "falconmind/sdk/core/MemoryBudget.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+#include "falconmind/sdk/sensors/ColorConvert.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace falconmind::sdk::sensors {
+
+using namespace falconmind::sdk::core;
+
+namespace {
+
+bool isRgbLike(PixelFormat f) { return f == PixelFormat::RGB8 || f == PixelFormat::BGR8; }
+
+void swapRedBlue(std::uint8_t* row, int width) noexcept {
+    for (int x = 0; x < width; ++x) std::swap(row[x * 3], row[x * 3 + 2]);
+}
+
+} // namespace
+
+FusedPixelChain::FusedPixelChain(std::vector<FusablePixelStage*> stages) : stages_(std::move(stages)) {
+    if (!stages_.empty()) {
+        if (auto* sink = dynamic_cast<MemoryBudgetSink*>(stages_.back())) pool_.setMemoryAccount(sink->memoryAccount());
+    }
+}
+
+void FusedPixelChain::applyStages(std::size_t begin, std::size_t end, std::uint8_t* row, int width, int y) {
+    for (std::size_t i = begin; i < end; ++i) {
+        // 第 0 阶段的格式变换在解码时完成
+        if (i > 0 && formats_[i] != formats_[i + 1]) swapRedBlue(row, width);
+        if (plans_[i].rowOp) stages_[i]->fusedRow(row, width, y);
+    }
+}
+
+void FusedPixelChain::produceRow(int r, std::uint8_t* out) {
+    const int sr = cropY_ + r;
+    const PixelFormat from = formats_[0];
+    const bool bgr = formats_[1] == PixelFormat::BGR8;
+    const std::uint8_t* row = src_ + static_cast<std::size_t>(sr) * srcStride_;
+    if (from == PixelFormat::YUYV) {
+        convertYuyvRowToRgb(row + static_cast<std::size_t>(cropX_) * 2, out, cropW_, bgr);
+    } else if (from == PixelFormat::NV12) {
+        const std::uint8_t* uv = src_ + static_cast<std::size_t>(srcStride_) * srcHeight_ +
+                                 static_cast<std::size_t>(sr / 2) * srcStride_;
+        convertNv12RowToRgb(row + cropX_, uv + cropX_, out, cropW_, bgr);
+    } else {
+        std::memcpy(out, row + static_cast<std::size_t>(cropX_) * 3, static_cast<std::size_t>(cropW_) * 3);
+        if (from != formats_[1]) swapRedBlue(out, cropW_);
+    }
+    applyStages(0, geometryAt_, out, cropW_, sr);
+}
+
+void FusedPixelChain::releaseBuffers() {
+    pool_.clear();
+    for (auto& row : rows_) std::vector<std::uint8_t>().swap(row);
+    rowTag_[0] = rowTag_[1] = -1;
+}
+
+bool FusedPixelChain::run(const BufferRef& frame, PixelFormat format) {
+    if (frame.size() < sizeof(CameraFramePacket) || stages_.empty()) return false;
+    auto* tailPad = stages_.back()->fusionOutputPad();
+    if (!tailPad) return false;
+    const auto* header = reinterpret_cast<const CameraFramePacket*>(frame.data());
+    if (format == PixelFormat::Any) {
+        format = header->format[0] != '\0' ? parsePixelFormat(header->format) : PixelFormat::RGB8;
+    }
+    const int w = header->width;
+    const int h = header->height;
+    if (w <= 0 || h <= 0 || !(isRgbLike(format) || format == PixelFormat::YUYV || format == PixelFormat::NV12)) {
+        return false;
+    }
+    const int stride = header->stride > 0 ? header->stride : pixelFormatMinStride(format, w);
+    std::size_t rows = static_cast<std::size_t>(h);
+    if (format == PixelFormat::NV12) rows += (rows + 1) / 2;
+    if (frame.size() < sizeof(CameraFramePacket) + static_cast<std::size_t>(stride) * rows) return false;
+
+    // 逐阶段确定本帧的操作：几何阶段之前尺寸不变，之后为缩放目标尺寸
+    const std::size_t n = stages_.size();
+    plans_.assign(n, FusedStagePlan{});
+    formats_.assign(1, format);
+    geometryAt_ = n;
+    FusedImageInfo info{format, w, h};
+    int cx = 0, cy = 0, cw = w, ch = h;
+    for (std::size_t i = 0; i < n; ++i) {
+        FusedStagePlan& plan = plans_[i];
+        if (!stages_[i]->planFusedFrame(info, plan) || !isRgbLike(plan.format) ||
+            (plan.geometry && geometryAt_ != n)) {
+            fallbacks_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (plan.geometry) {
+            // 裁剪区域与 CpuImageTransform 一致：YUV 源起点对齐到色度采样
+            geometryAt_ = i;
+            cx = std::clamp(plan.crop.x, 0, info.width - 1);
+            cy = std::clamp(plan.crop.y, 0, info.height - 1);
+            if (info.format == PixelFormat::NV12) cy &= ~1;
+            if (!isRgbLike(info.format)) cx &= ~1;
+            cw = std::min(plan.crop.width > 0 ? plan.crop.width : info.width - cx, info.width - cx);
+            ch = std::min(plan.crop.height > 0 ? plan.crop.height : info.height - cy, info.height - cy);
+            if (cw <= 0 || ch <= 0) {
+                fallbacks_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            info.width = plan.width > 0 ? plan.width : cw;
+            info.height = plan.height > 0 ? plan.height : ch;
+        }
+        info.format = plan.format;
+        formats_.push_back(plan.format);
+    }
+
+    const PixelFormat outFormat = formats_.back();
+    const int outW = info.width;
+    const int outH = info.height;
+    const std::size_t outStride = static_cast<std::size_t>(outW) * 3;
+    BufferRef out = pool_.acquire(BufferPoolKey{outW, outH, pixelFormatName(outFormat)},
+                                  sizeof(CameraFramePacket) + outStride * static_cast<std::size_t>(outH));
+    auto* outHeader = reinterpret_cast<CameraFramePacket*>(out.mutableData());
+    *outHeader = *header;
+    outHeader->width = outW;
+    outHeader->height = outH;
+    outHeader->stride = static_cast<std::int32_t>(outStride);
+    std::strncpy(outHeader->format, pixelFormatName(outFormat), sizeof(outHeader->format) - 1);
+    outHeader->format[sizeof(outHeader->format) - 1] = '\0';
+    std::uint8_t* dst = cameraFramePacketDataWritable(outHeader);
+
+    src_ = cameraFramePacketData(header);
+    srcStride_ = stride;
+    srcHeight_ = h;
+    cropX_ = cx;
+    cropY_ = cy;
+    cropW_ = cw;
+    if (cw == outW && ch == outH) {
+        // 不缩放：源行直接产出到输出缓冲
+        for (int y = 0; y < outH; ++y) {
+            std::uint8_t* row = dst + static_cast<std::size_t>(y) * outStride;
+            produceRow(y, row);
+            applyStages(geometryAt_, n, row, outW, y);
+        }
+    } else {
+        // 输出行递增时所需源行单调不减：两行缓冲按行号缓存，每个源行最多产出一次
+        columns_.build(cw, outW);
+        for (auto& buf : rows_) buf.resize(static_cast<std::size_t>(cw) * 3);
+        rowTag_[0] = rowTag_[1] = -1;
+        auto fetch = [this](int r, int keep) -> const std::uint8_t* {
+            for (int i = 0; i < 2; ++i) {
+                if (rowTag_[i] == r) return rows_[i].data();
+            }
+            const int slot = rowTag_[0] == keep ? 1 : 0;
+            produceRow(r, rows_[slot].data());
+            rowTag_[slot] = r;
+            return rows_[slot].data();
+        };
+        for (int y = 0; y < outH; ++y) {
+            int a = 0, b = 0, wy = 0;
+            bilinearSourceRows(y, ch, outH, a, b, wy);
+            const std::uint8_t* r0 = fetch(a, -1);
+            const std::uint8_t* r1 = fetch(b, a);
+            std::uint8_t* row = dst + static_cast<std::size_t>(y) * outStride;
+            bilinearResizeRow(r0, r1, wy, columns_, row);
+            applyStages(geometryAt_, n, row, outW, y);
+        }
+    }
+    src_ = nullptr;
+
+    auto& meta = out.mutableMeta();
+    meta = frame.meta();
+    meta.video = VideoCaps{outFormat, outW, outH, frame.meta().video.fps};
+    meta.dmabufFd = -1;
+    for (auto* stage : stages_) stage->finishFusedFrame(out);
+    fused_.fetch_add(1, std::memory_order_relaxed);
+    tailPad->pushBuffer(out);
+    return true;
+}
+
+} // namespace falconmind::sdk::sensors
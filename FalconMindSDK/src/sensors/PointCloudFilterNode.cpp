@@ -0,0 +1,450 @@
+#include "falconmind/sdk/sensors/PointCloudFilterNode.h"
+#include "falconmind/sdk/sensors/SensorTypes.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/core/WorkerGroup.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace falconmind::sdk::sensors {
+
+using namespace falconmind::sdk::core;
+
+namespace {
+
+constexpr std::uint64_t kEmptyKey = ~0ull;  // 打包键只用低 63 位，不会与之冲突
+constexpr std::int64_t kKeyOffset = 1 << 20;
+constexpr std::uint64_t kKeyMask = (1u << 21) - 1;
+
+// 每轴 21 位（±2^20 格）；超出范围的坐标回绕，只影响极远处点的归并
+inline std::uint64_t packKey(std::int64_t ix, std::int64_t iy, std::int64_t iz) {
+    return ((static_cast<std::uint64_t>(ix + kKeyOffset) & kKeyMask) << 42) |
+           ((static_cast<std::uint64_t>(iy + kKeyOffset) & kKeyMask) << 21) |
+           (static_cast<std::uint64_t>(iz + kKeyOffset) & kKeyMask);
+}
+
+// splitmix64 终混：低位用于表内寻址，高位用于分片
+inline std::uint64_t mixKey(std::uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+
+std::size_t nextPow2(std::size_t n) {
+    std::size_t p = 64;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+bool parseFloat(const std::string& text, float& out) {
+    try {
+        out = std::stof(text);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+} // namespace
+
+// 一个线程独占的哈希分片：键 → 累加槽，槽数组按插入顺序排列
+struct PointCloudFilter::Shard {
+    std::vector<std::uint64_t> tableKeys;
+    std::vector<std::uint32_t> tableSlots;
+    std::size_t mask{0};
+    std::uint32_t used{0};
+
+    std::vector<float> sumX, sumY, sumZ, sumI;
+    std::vector<std::uint32_t> count;
+    std::vector<std::uint32_t> first;  // 体素内首点下标
+    std::vector<float> minZ;           // 地面栅格最低点
+
+    std::uint64_t cropped{0};
+    std::uint64_t ground{0};
+
+    void reset(std::size_t expected) {
+        std::size_t cap = nextPow2(expected * 2);
+        if (tableKeys.size() < cap) {
+            tableKeys.resize(cap);
+            tableSlots.resize(cap);
+        }
+        std::fill(tableKeys.begin(), tableKeys.begin() + static_cast<std::ptrdiff_t>(cap), kEmptyKey);
+        mask = cap - 1;
+        used = 0;
+        sumX.clear();
+        sumY.clear();
+        sumZ.clear();
+        sumI.clear();
+        count.clear();
+        first.clear();
+        minZ.clear();
+        ground = 0;
+    }
+
+    // 返回键对应的槽；新键时 inserted 为 true，调用方负责追加槽数据
+    std::uint32_t findOrInsert(std::uint64_t key, std::uint64_t hash, bool& inserted) {
+        if ((static_cast<std::size_t>(used) + 1) * 2 > mask + 1) grow();
+        std::size_t i = hash & mask;
+        for (;;) {
+            std::uint64_t k = tableKeys[i];
+            if (k == key) {
+                inserted = false;
+                return tableSlots[i];
+            }
+            if (k == kEmptyKey) {
+                tableKeys[i] = key;
+                tableSlots[i] = used;
+                inserted = true;
+                return used++;
+            }
+            i = (i + 1) & mask;
+        }
+    }
+
+    // 分片键数超出预估（哈希分布不均）时扩容重排
+    void grow() {
+        std::size_t cap = (mask + 1) * 2;
+        std::vector<std::uint64_t> keys(cap, kEmptyKey);
+        std::vector<std::uint32_t> slots(cap);
+        for (std::size_t j = 0; j <= mask; ++j) {
+            if (tableKeys[j] == kEmptyKey) continue;
+            std::size_t i = mixKey(tableKeys[j]) & (cap - 1);
+            while (keys[i] != kEmptyKey) i = (i + 1) & (cap - 1);
+            keys[i] = tableKeys[j];
+            slots[i] = tableSlots[j];
+        }
+        tableKeys.swap(keys);
+        tableSlots.swap(slots);
+        mask = cap - 1;
+    }
+};
+
+PointCloudFilter::PointCloudFilter() : PointCloudFilter(PointCloudFilterConfig{}) {}
+
+PointCloudFilter::PointCloudFilter(const PointCloudFilterConfig& cfg)
+    : cfg_(cfg), workers_(std::make_unique<WorkerGroup>(cfg.threads > 0 ? cfg.threads : WorkerGroup::defaultCount())) {
+    for (std::size_t i = 0; i < workers_->count(); ++i) shards_.push_back(std::make_unique<Shard>());
+}
+
+PointCloudFilter::~PointCloudFilter() = default;
+
+std::size_t PointCloudFilter::threads() const noexcept { return workers_->count(); }
+
+std::size_t PointCloudFilter::shardOf(std::uint64_t hash) const noexcept {
+    return shards_.size() == 1 ? 0 : static_cast<std::size_t>((hash >> 40) % shards_.size());
+}
+
+void PointCloudFilter::markKept(const PointCloudView& in, std::size_t begin, std::size_t end, Shard& shard) {
+    const float minR2 = cfg_.minRange * cfg_.minRange;
+    const float maxR2 = cfg_.maxRange > 0.0f ? cfg_.maxRange * cfg_.maxRange : std::numeric_limits<float>::infinity();
+    const float x0 = cfg_.roiMin[0], y0 = cfg_.roiMin[1], z0 = cfg_.roiMin[2];
+    const float x1 = cfg_.roiMax[0], y1 = cfg_.roiMax[1], z1 = cfg_.roiMax[2];
+    const float* xs = in.x;
+    const float* ys = in.y;
+    const float* zs = in.z;
+    std::uint8_t* keep = keep_.data();
+    std::uint64_t kept = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+        const float x = xs[i], y = ys[i], z = zs[i];
+        const float r2 = x * x + y * y + z * z;
+        // 按位与而非短路：循环体无分支；NaN 比较均为假，被一并剔除
+        const bool k = (r2 >= minR2) & (r2 <= maxR2) & (x >= x0) & (x <= x1) & (y >= y0) & (y <= y1) & (z >= z0) &
+                       (z <= z1);
+        keep[i] = static_cast<std::uint8_t>(k);
+        kept += k;
+    }
+    shard.cropped = (end - begin) - kept;
+}
+
+void PointCloudFilter::computeKeys(const PointCloudView& in, std::size_t begin, std::size_t end, float cell,
+                                   bool withZ) {
+    const float inv = 1.0f / cell;
+    for (std::size_t i = begin; i < end; ++i) {
+        if (!keep_[i]) {
+            keys_[i] = kEmptyKey;
+            continue;
+        }
+        auto ix = static_cast<std::int64_t>(std::floor(in.x[i] * inv));
+        auto iy = static_cast<std::int64_t>(std::floor(in.y[i] * inv));
+        auto iz = withZ ? static_cast<std::int64_t>(std::floor(in.z[i] * inv)) : 0;
+        keys_[i] = packKey(ix, iy, iz);
+        hashes_[i] = mixKey(keys_[i]);
+    }
+}
+
+void PointCloudFilter::removeGround(const PointCloudView& in, std::size_t index) {
+    Shard& shard = *shards_[index];
+    const std::size_t n = in.size();
+    // 第一遍：本分片各栅格最低点
+    for (std::size_t i = 0; i < n; ++i) {
+        if (keys_[i] == kEmptyKey || shardOf(hashes_[i]) != index) continue;
+        bool inserted = false;
+        std::uint32_t slot = shard.findOrInsert(keys_[i], hashes_[i], inserted);
+        if (inserted) {
+            shard.minZ.push_back(in.z[i]);
+        } else {
+            shard.minZ[slot] = std::min(shard.minZ[slot], in.z[i]);
+        }
+        slots_[i] = slot;
+    }
+    // 第二遍：贴近栅格最低点的视为地面
+    for (std::size_t i = 0; i < n; ++i) {
+        if (keys_[i] == kEmptyKey || shardOf(hashes_[i]) != index) continue;
+        if (in.z[i] <= shard.minZ[slots_[i]] + cfg_.groundHeight) {
+            keep_[i] = 0;
+            ++shard.ground;
+        }
+    }
+}
+
+void PointCloudFilter::voxelize(const PointCloudView& in, std::size_t index) {
+    Shard& shard = *shards_[index];
+    const std::size_t n = in.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (keys_[i] == kEmptyKey || shardOf(hashes_[i]) != index) continue;
+        bool inserted = false;
+        std::uint32_t slot = shard.findOrInsert(keys_[i], hashes_[i], inserted);
+        if (inserted) {
+            shard.sumX.push_back(in.x[i]);
+            shard.sumY.push_back(in.y[i]);
+            shard.sumZ.push_back(in.z[i]);
+            shard.sumI.push_back(in.intensity[i]);
+            shard.count.push_back(1);
+            shard.first.push_back(static_cast<std::uint32_t>(i));
+        } else {
+            shard.sumX[slot] += in.x[i];
+            shard.sumY[slot] += in.y[i];
+            shard.sumZ[slot] += in.z[i];
+            shard.sumI[slot] += in.intensity[i];
+            ++shard.count[slot];
+        }
+    }
+}
+
+void PointCloudFilter::writeVoxels(const PointCloudView& in, std::size_t index, std::uint32_t base,
+                                   PointCloudWriter& out) {
+    const Shard& shard = *shards_[index];
+    for (std::uint32_t s = 0; s < shard.used; ++s) {
+        const float inv = 1.0f / static_cast<float>(shard.count[s]);
+        const std::uint32_t o = base + s;
+        out.x[o] = shard.sumX[s] * inv;
+        out.y[o] = shard.sumY[s] * inv;
+        out.z[o] = shard.sumZ[s] * inv;
+        out.intensity[o] = shard.sumI[s] * inv;
+        out.timeOffsetNs[o] = in.timeOffsetNs[shard.first[s]];
+        out.ring[o] = in.ring[shard.first[s]];
+    }
+}
+
+void PointCloudFilter::compact(const PointCloudView& in, PointCloudWriter& out) {
+    std::uint32_t o = 0;
+    const std::size_t n = in.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!keep_[i]) continue;
+        out.x[o] = in.x[i];
+        out.y[o] = in.y[i];
+        out.z[o] = in.z[i];
+        out.intensity[o] = in.intensity[i];
+        out.timeOffsetNs[o] = in.timeOffsetNs[i];
+        out.ring[o] = in.ring[i];
+        ++o;
+    }
+    out.header->count = o;
+}
+
+std::uint32_t PointCloudFilter::apply(const PointCloudView& in, PointCloudWriter& out) {
+    stats_ = PointCloudFilterStats{};
+    out.header->count = 0;
+    const std::size_t n = in.size();
+    stats_.inputPoints = n;
+    if (n == 0 || out.header->capacity < n) {
+        if (n > 0) std::cerr << "[PointCloudFilter] output capacity " << out.header->capacity << " < " << n << std::endl;
+        return 0;
+    }
+    keep_.resize(n);
+    keys_.resize(n);
+    hashes_.resize(n);
+    slots_.resize(n);
+
+    const std::size_t workers = workers_->count();
+    const std::size_t chunk = (n + workers - 1) / workers;
+    auto range = [&](std::size_t t) {
+        return std::make_pair(std::min(n, t * chunk), std::min(n, (t + 1) * chunk));
+    };
+
+    workers_->run([&](std::size_t t) {
+        auto [begin, end] = range(t);
+        markKept(in, begin, end, *shards_[t]);
+    });
+    std::uint64_t kept = n;
+    for (auto& shard : shards_) {
+        stats_.croppedPoints += shard->cropped;
+        kept -= shard->cropped;
+    }
+
+    if (cfg_.groundCell > 0.0f && kept > 0) {
+        for (auto& shard : shards_) shard->reset(kept / workers + 16);
+        workers_->run([&](std::size_t t) {
+            auto [begin, end] = range(t);
+            computeKeys(in, begin, end, cfg_.groundCell, false);
+        });
+        workers_->run([&](std::size_t t) { removeGround(in, t); });
+        for (auto& shard : shards_) stats_.groundPoints += shard->ground;
+        kept -= stats_.groundPoints;
+    }
+
+    if (cfg_.voxelSize > 0.0f && kept > 0) {
+        for (auto& shard : shards_) shard->reset(kept / workers + 16);
+        workers_->run([&](std::size_t t) {
+            auto [begin, end] = range(t);
+            computeKeys(in, begin, end, cfg_.voxelSize, true);
+        });
+        workers_->run([&](std::size_t t) { voxelize(in, t); });
+        std::vector<std::uint32_t> bases(workers, 0);
+        std::uint32_t total = 0;
+        for (std::size_t t = 0; t < workers; ++t) {
+            bases[t] = total;
+            total += shards_[t]->used;
+        }
+        workers_->run([&](std::size_t t) { writeVoxels(in, t, bases[t], out); });
+        out.header->count = total;
+    } else {
+        compact(in, out);
+    }
+    stats_.outputPoints = out.header->count;
+    return out.header->count;
+}
+
+PointCloudFilterNode::PointCloudFilterNode() : Node("pointcloud_filter") {
+    sinkPad_ = addPad(std::make_shared<Pad>("pointcloud_in", PadType::Sink));
+    srcPad_ = addPad(std::make_shared<Pad>("pointcloud_out", PadType::Source));
+}
+
+bool PointCloudFilterNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    PointCloudFilterConfig cfg = cfg_;
+    const std::pair<const char*, float*> floats[] = {
+        {"voxel_size", &cfg.voxelSize},     {"min_range", &cfg.minRange},   {"max_range", &cfg.maxRange},
+        {"x_min", &cfg.roiMin[0]},          {"y_min", &cfg.roiMin[1]},      {"z_min", &cfg.roiMin[2]},
+        {"x_max", &cfg.roiMax[0]},          {"y_max", &cfg.roiMax[1]},      {"z_max", &cfg.roiMax[2]},
+        {"ground_cell", &cfg.groundCell},   {"ground_height", &cfg.groundHeight},
+    };
+    for (const auto& [name, field] : floats) {
+        auto it = params.find(name);
+        if (it != params.end() && !parseFloat(it->second, *field)) {
+            std::cerr << "[PointCloudFilterNode] invalid " << name << ": " << it->second << std::endl;
+            return false;
+        }
+    }
+    auto it = params.find("threads");
+    if (it != params.end()) cfg.threads = std::stoul(it->second);
+    if (cfg.voxelSize < 0.0f || cfg.groundCell < 0.0f || cfg.minRange < 0.0f || cfg.maxRange < 0.0f) {
+        std::cerr << "[PointCloudFilterNode] sizes and ranges must be non-negative" << std::endl;
+        return false;
+    }
+    cfg_ = cfg;
+    filter_.reset();  // start() 按新配置重建（线程数可能变化）
+    return true;
+}
+
+bool PointCloudFilterNode::start() {
+    if (!filter_) filter_ = std::make_unique<PointCloudFilter>(cfg_);
+    sinkPad_->setBufferCallback([this](const BufferRef& scan) {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        if (pending_) droppedScans_.fetch_add(1, std::memory_order_relaxed);
+        pending_ = scan;
+    });
+    std::cout << "[PointCloudFilterNode] start voxel=" << cfg_.voxelSize << "m ground_cell=" << cfg_.groundCell
+              << "m threads=" << filter_->threads() << std::endl;
+    return true;
+}
+
+void PointCloudFilterNode::stop() {
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    pending_.reset();
+    pool_.clear();
+}
+
+void PointCloudFilterNode::releaseIdleBuffers() {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pending_.reset();
+        pool_.clear();
+    }
+    std::vector<std::uint8_t>().swap(transposed_);
+    std::vector<std::uint8_t>().swap(scratch_);
+}
+
+void PointCloudFilterNode::process() {
+    BufferRef scan;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        scan = std::move(pending_);
+        pending_.reset();
+    }
+    if (!scan || !filter_ || !srcPad_) return;
+    const std::int64_t startNs = PipelineClock::nowNs();
+
+    PointCloudView in;
+    if (!in.attach(scan.data(), scan.size())) {
+        if (isPointCloudPacket(scan.data(), scan.size()) || scan.size() % sizeof(PointXYZI) != 0) {
+            std::cerr << "[PointCloudFilterNode] malformed point cloud (" << scan.size() << " bytes)" << std::endl;
+            return;
+        }
+        // PointXYZI 数组：转置为 SoA（时间偏移与线号为 0）
+        const auto count = static_cast<std::uint32_t>(scan.size() / sizeof(PointXYZI));
+        transposed_.resize(pointCloudPacketSize(count));
+        PointCloudWriter w;
+        w.reset(transposed_.data(), transposed_.size(), count);
+        const auto* pts = reinterpret_cast<const PointXYZI*>(scan.data());
+        for (std::uint32_t i = 0; i < count; ++i) {
+            w.x[i] = pts[i].x;
+            w.y[i] = pts[i].y;
+            w.z[i] = pts[i].z;
+            w.intensity[i] = pts[i].intensity;
+        }
+        std::fill(w.timeOffsetNs, w.timeOffsetNs + count, 0u);
+        std::fill(w.ring, w.ring + count, std::uint16_t{0});
+        w.header->count = count;
+        w.header->timestampNs = scan.meta().timestampNs;
+        in.attach(transposed_.data(), transposed_.size());
+    }
+
+    const std::uint32_t inputCount = in.size();
+    scratch_.resize(std::max(scratch_.size(), pointCloudPacketSize(inputCount)));
+    PointCloudWriter result;
+    result.reset(scratch_.data(), scratch_.size(), inputCount);
+    const std::uint32_t count = filter_->apply(in, result);
+
+    // 按输出点数取容量档位，下游收到的包大小与输出点数成比例
+    const auto capacity = static_cast<std::uint32_t>(nextPow2(count));
+    BufferRef out = pool_.acquire(BufferPoolKey{static_cast<std::int32_t>(capacity), 0, "FMPC"},
+                                  pointCloudPacketSize(capacity));
+    PointCloudWriter w;
+    w.reset(out.mutableData(), out.size(), capacity);
+    std::memcpy(w.x, result.x, count * sizeof(float));
+    std::memcpy(w.y, result.y, count * sizeof(float));
+    std::memcpy(w.z, result.z, count * sizeof(float));
+    std::memcpy(w.intensity, result.intensity, count * sizeof(float));
+    std::memcpy(w.timeOffsetNs, result.timeOffsetNs, count * sizeof(std::uint32_t));
+    std::memcpy(w.ring, result.ring, count * sizeof(std::uint16_t));
+    w.header->count = count;
+    w.header->timestampNs = in.header->timestampNs;
+    w.header->frameIndex = in.header->frameIndex;
+    auto& meta = out.mutableMeta();
+    meta.timestampNs = scan.meta().timestampNs;
+    meta.frameIndex = scan.meta().frameIndex;
+    srcPad_->pushBuffer(out);
+
+    scans_.fetch_add(1, std::memory_order_relaxed);
+    inputPoints_.fetch_add(inputCount, std::memory_order_relaxed);
+    outputPoints_.fetch_add(count, std::memory_order_relaxed);
+    lastLatencyNs_.store(PipelineClock::nowNs() - startNs, std::memory_order_relaxed);
+}
+
+} // namespace falconmind::sdk::sensors
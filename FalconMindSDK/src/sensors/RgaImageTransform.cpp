@@ -0,0 +1,138 @@
+#include "falconmind/sdk/sensors/ImageTransform.h"
+
+#include <iostream>
+#include <string>
+
+#if defined(FALCONMINDSDK_RGA_ENABLED)
+#include <im2d.h>
+#include <rga.h>
+#endif
+
+namespace falconmind::sdk::sensors {
+
+using core::PixelFormat;
+
+RgaImageTransform::RgaImageTransform() = default;
+RgaImageTransform::~RgaImageTransform() = default;
+
+bool RgaImageTransform::supports(PixelFormat from, PixelFormat to, ImageRotation) const noexcept {
+    const bool src = from == PixelFormat::RGB8 || from == PixelFormat::BGR8 || from == PixelFormat::NV12 ||
+                     from == PixelFormat::YUYV;
+    const bool dst = to == PixelFormat::RGB8 || to == PixelFormat::BGR8 || to == PixelFormat::NV12;
+    return src && dst;
+}
+
+#if defined(FALCONMINDSDK_RGA_ENABLED)
+
+namespace {
+
+int rgaFormat(PixelFormat f) {
+    switch (f) {
+        case PixelFormat::RGB8: return RK_FORMAT_RGB_888;
+        case PixelFormat::BGR8: return RK_FORMAT_BGR_888;
+        case PixelFormat::NV12: return RK_FORMAT_YCbCr_420_SP;
+        case PixelFormat::YUYV: return RK_FORMAT_YUYV_422;
+        default: return -1;
+    }
+}
+
+int bytesPerPixel(PixelFormat f) {
+    switch (f) {
+        case PixelFormat::RGB8:
+        case PixelFormat::BGR8: return 3;
+        case PixelFormat::YUYV: return 2;
+        default: return 1;  // NV12 按 Y 平面计
+    }
+}
+
+int rgaRotation(ImageRotation r) {
+    switch (r) {
+        case ImageRotation::Rot90: return IM_HAL_TRANSFORM_ROT_90;
+        case ImageRotation::Rot180: return IM_HAL_TRANSFORM_ROT_180;
+        case ImageRotation::Rot270: return IM_HAL_TRANSFORM_ROT_270;
+        case ImageRotation::None: break;
+    }
+    return 0;
+}
+
+// 一次变换内导入的 buffer；析构时释放 fd / 虚拟地址导入的 handle
+struct ImportedBuffer {
+    rga_buffer_handle_t handle{0};
+    rga_buffer_t buffer{};
+
+    bool import(const void* data, int fd, int width, int height, int stride, PixelFormat format) {
+        const int bpp = bytesPerPixel(format);
+        const int wstride = stride > 0 ? stride / bpp : width;
+        const std::size_t rows = format == PixelFormat::NV12 ? static_cast<std::size_t>(height) * 3 / 2 : height;
+        const std::size_t bytes = static_cast<std::size_t>(wstride) * bpp * rows;
+        handle = fd >= 0 ? importbuffer_fd(fd, static_cast<int>(bytes))
+                         : importbuffer_virtualaddr(const_cast<void*>(data), static_cast<int>(bytes));
+        if (handle == 0) return false;
+        buffer = wrapbuffer_handle(handle, width, height, rgaFormat(format), wstride, height);
+        return true;
+    }
+    ~ImportedBuffer() {
+        if (handle != 0) releasebuffer_handle(handle);
+    }
+};
+
+} // namespace
+
+bool RgaImageTransform::available() {
+    // querystring 在 RGA 驱动不可用时返回错误信息
+    const char* info = querystring(RGA_VERSION);
+    return info != nullptr && std::string(info).find("error") == std::string::npos;
+}
+
+bool RgaImageTransform::transform(const ImageSurface& src, const ImageTransformOp& op, WritableImageSurface& dst) {
+    if ((!src.data && src.dmabufFd < 0) || (!dst.data && dst.dmabufFd < 0) || src.width <= 0 || src.height <= 0 ||
+        dst.width <= 0 || dst.height <= 0 || !supports(src.format, dst.format, op.rotation)) {
+        return false;
+    }
+    ImportedBuffer in;
+    ImportedBuffer out;
+    if (!in.import(src.data, src.dmabufFd, src.width, src.height, src.stride, src.format) ||
+        !out.import(dst.data, dst.dmabufFd, dst.width, dst.height, dst.stride, dst.format)) {
+        std::cerr << "[RgaImageTransform] importbuffer failed" << std::endl;
+        return false;
+    }
+
+    im_rect srect{};
+    srect.x = op.crop.x;
+    srect.y = op.crop.y;
+    if (src.format != PixelFormat::RGB8 && src.format != PixelFormat::BGR8) {
+        srect.x &= ~1;
+        if (src.format == PixelFormat::NV12) srect.y &= ~1;
+    }
+    srect.width = op.crop.width > 0 ? op.crop.width : src.width - srect.x;
+    srect.height = op.crop.height > 0 ? op.crop.height : src.height - srect.y;
+    im_rect drect{0, 0, dst.width, dst.height};
+    im_rect prect{};
+    rga_buffer_t pat{};
+    const int usage = rgaRotation(op.rotation) | IM_SYNC;
+
+    IM_STATUS status = imcheck(in.buffer, out.buffer, srect, drect, usage);
+    if (status != IM_STATUS_NOERROR) {
+        std::cerr << "[RgaImageTransform] imcheck: " << imStrError(status) << std::endl;
+        return false;
+    }
+    status = improcess(in.buffer, out.buffer, pat, srect, drect, prect, usage);
+    if (status != IM_STATUS_SUCCESS) {
+        std::cerr << "[RgaImageTransform] improcess: " << imStrError(status) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#else
+
+bool RgaImageTransform::available() { return false; }
+
+bool RgaImageTransform::transform(const ImageSurface&, const ImageTransformOp&, WritableImageSurface&) {
+    std::cerr << "[RgaImageTransform] built without FALCONMINDSDK_BUILD_RGA" << std::endl;
+    return false;
+}
+
+#endif
+
+} // namespace falconmind::sdk::sensors
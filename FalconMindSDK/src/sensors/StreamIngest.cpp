@@ -0,0 +1,501 @@
+#include "falconmind/sdk/sensors/StreamIngest.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#ifdef FALCONMINDSDK_FFMPEG_INGEST_ENABLED
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/mathematics.h>
+}
+#endif
+
+namespace falconmind::sdk::sensors {
+
+using namespace falconmind::sdk::core;
+
+namespace {
+
+constexpr std::int64_t kDiscontinuityNs = 1'000'000'000;
+
+bool startsWith(const std::string& s, const char* prefix) {
+    return s.compare(0, std::strlen(prefix), prefix) == 0;
+}
+
+} // namespace
+
+StreamDecoder parseStreamDecoder(const std::string& name) noexcept {
+    std::string upper;
+    upper.reserve(name.size());
+    for (char c : name) upper.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+    if (upper == "RK_HW" || upper == "MPP") return StreamDecoder::RkHw;
+    if (upper == "NVDEC" || upper == "CUVID") return StreamDecoder::Nvdec;
+    if (upper == "SW_FFMPEG" || upper == "SW") return StreamDecoder::SwFfmpeg;
+    return StreamDecoder::Auto;
+}
+
+const char* streamDecoderName(StreamDecoder decoder) noexcept {
+    switch (decoder) {
+        case StreamDecoder::Auto: return "AUTO";
+        case StreamDecoder::RkHw: return "RK_HW";
+        case StreamDecoder::Nvdec: return "NVDEC";
+        case StreamDecoder::SwFfmpeg: return "SW_FFMPEG";
+    }
+    return "AUTO";
+}
+
+bool streamIngestAvailable() noexcept {
+#ifdef FALCONMINDSDK_FFMPEG_INGEST_ENABLED
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool isStreamUri(const std::string& uri) noexcept {
+    for (const char* scheme : {"rtsp://", "rtsps://", "udp://", "rtp://", "srt://"}) {
+        if (startsWith(uri, scheme)) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// JitterBuffer
+
+JitterBuffer::JitterBuffer() : JitterBuffer(Config{}) {}
+
+JitterBuffer::JitterBuffer(const Config& cfg) : cfg_(cfg) {
+    if (cfg_.capacity == 0) cfg_.capacity = 1;
+    if (cfg_.delayNs < 0) cfg_.delayNs = 0;
+}
+
+bool JitterBuffer::push(BufferRef frame, std::int64_t ptsNs, std::int64_t arrivalNs) {
+    std::int64_t sample = arrivalNs - ptsNs;
+    if (mapped_ && std::llabs(sample - offsetNs_) > kDiscontinuityNs) {
+        // 时间戳跳变：丢弃旧映射与已缓冲帧的顺序约束，按新时基重新开始
+        mapped_ = false;
+        released_ = false;
+    }
+    if (!mapped_) {
+        offsetNs_ = sample;
+        mapped_ = true;
+    } else if (sample < offsetNs_) {
+        offsetNs_ = sample;
+    } else {
+        // 慢速上调：发送端时钟偏慢时映射随之后移，避免延迟无限累积；单次抖动峰值影响很小
+        offsetNs_ += (sample - offsetNs_) / 256;
+    }
+    if (released_ && ptsNs <= lastReleasedPtsNs_) {
+        ++lateDrops_;
+        return false;
+    }
+    auto pos = frames_.end();
+    while (pos != frames_.begin() && std::prev(pos)->ptsNs > ptsNs) --pos;
+    frames_.insert(pos, Entry{std::move(frame), ptsNs});
+    if (frames_.size() > cfg_.capacity) {
+        released_ = true;
+        lastReleasedPtsNs_ = frames_.front().ptsNs;
+        frames_.pop_front();
+        ++overflowDrops_;
+    }
+    return true;
+}
+
+bool JitterBuffer::pop(std::int64_t nowNs, BufferRef& frame, std::int64_t& captureNs) {
+    if (frames_.empty()) return false;
+    Entry& front = frames_.front();
+    captureNs = front.ptsNs + offsetNs_;
+    if (nowNs < captureNs + cfg_.delayNs) return false;
+    frame = std::move(front.frame);
+    released_ = true;
+    lastReleasedPtsNs_ = front.ptsNs;
+    frames_.pop_front();
+    return true;
+}
+
+std::int64_t JitterBuffer::nextDueNs() const noexcept {
+    if (frames_.empty()) return -1;
+    return frames_.front().ptsNs + offsetNs_ + cfg_.delayNs;
+}
+
+void JitterBuffer::clear() {
+    frames_.clear();
+    mapped_ = false;
+    released_ = false;
+}
+
+// ---------------------------------------------------------------------------
+// StreamIngest 后端
+
+#ifdef FALCONMINDSDK_FFMPEG_INGEST_ENABLED
+
+namespace {
+
+std::string avError(int err) {
+    char buf[AV_ERROR_MAX_STRING_SIZE] = {0};
+    av_strerror(err, buf, sizeof(buf));
+    return buf;
+}
+
+const char* hardwareDecoderName(AVCodecID codec, StreamDecoder kind) {
+    if (kind == StreamDecoder::RkHw) {
+        if (codec == AV_CODEC_ID_H264) return "h264_rkmpp";
+        if (codec == AV_CODEC_ID_HEVC) return "hevc_rkmpp";
+    } else if (kind == StreamDecoder::Nvdec) {
+        if (codec == AV_CODEC_ID_H264) return "h264_cuvid";
+        if (codec == AV_CODEC_ID_HEVC) return "hevc_cuvid";
+    }
+    return nullptr;
+}
+
+// 硬件解码器同时提供设备内存与系统内存输出时选 NV12（系统内存），直接拷入帧缓冲池
+AVPixelFormat preferNv12(AVCodecContext*, const AVPixelFormat* formats) {
+    for (const AVPixelFormat* p = formats; *p != AV_PIX_FMT_NONE; ++p) {
+        if (*p == AV_PIX_FMT_NV12) return *p;
+    }
+    return formats[0];
+}
+
+} // namespace
+
+struct StreamIngest::Backend {
+    AVFormatContext* format{nullptr};
+    AVCodecContext* codec{nullptr};
+    AVPacket* packet{nullptr};
+    AVFrame* frame{nullptr};
+    int streamIndex{-1};
+    AVRational timeBase{1, 90000};
+    const std::atomic<bool>* running{nullptr};
+    std::int64_t deadlineNs{0};
+    bool warnedFormat{false};
+
+    ~Backend() { close(); }
+
+    // 阻塞的 FFmpeg 调用（打开、读包）在停止或超时时返回
+    static int interrupt(void* opaque) {
+        auto* self = static_cast<Backend*>(opaque);
+        if (!self->running->load(std::memory_order_relaxed)) return 1;
+        return PipelineClock::nowNs() > self->deadlineNs ? 1 : 0;
+    }
+
+    void armTimeout(int timeoutMs) {
+        deadlineNs = PipelineClock::nowNs() + static_cast<std::int64_t>(timeoutMs) * 1'000'000;
+    }
+
+    bool openCodec(const AVCodec* decoder, const AVCodecParameters* params, bool lowLatency) {
+        codec = avcodec_alloc_context3(decoder);
+        if (!codec) return false;
+        if (avcodec_parameters_to_context(codec, params) < 0) {
+            avcodec_free_context(&codec);
+            return false;
+        }
+        codec->pkt_timebase = timeBase;
+        codec->get_format = preferNv12;
+        if (lowLatency) {
+            // 帧级多线程会引入数帧延迟，仅保留片级多线程
+            codec->flags |= AV_CODEC_FLAG_LOW_DELAY;
+            codec->flags2 |= AV_CODEC_FLAG2_FAST;
+            codec->thread_type = FF_THREAD_SLICE;
+        }
+        int err = avcodec_open2(codec, decoder, nullptr);
+        if (err < 0) {
+            std::cerr << "[StreamIngest] avcodec_open2(" << decoder->name << ") failed: " << avError(err) << std::endl;
+            avcodec_free_context(&codec);
+            return false;
+        }
+        return true;
+    }
+
+    bool open(const StreamIngestConfig& cfg, StreamDecoder* used) {
+        AVDictionary* opts = nullptr;
+        if (startsWith(cfg.uri, "rtsp")) {
+            av_dict_set(&opts, "rtsp_transport", cfg.transport.c_str(), 0);
+        }
+        if (cfg.lowLatency) {
+            av_dict_set(&opts, "fflags", "nobuffer", 0);
+            av_dict_set(&opts, "flags", "low_delay", 0);
+            av_dict_set(&opts, "max_delay", "0", 0);
+            av_dict_set(&opts, "reorder_queue_size", "0", 0);
+            av_dict_set(&opts, "probesize", "32768", 0);
+            av_dict_set(&opts, "analyzeduration", "200000", 0);
+        }
+        format = avformat_alloc_context();
+        format->interrupt_callback.callback = &Backend::interrupt;
+        format->interrupt_callback.opaque = this;
+        armTimeout(cfg.timeoutMs);
+        int err = avformat_open_input(&format, cfg.uri.c_str(), nullptr, &opts);
+        av_dict_free(&opts);
+        if (err < 0) {
+            std::cerr << "[StreamIngest] open " << cfg.uri << " failed: " << avError(err) << std::endl;
+            format = nullptr;  // 失败时 avformat_open_input 已释放上下文
+            return false;
+        }
+        armTimeout(cfg.timeoutMs);
+        if ((err = avformat_find_stream_info(format, nullptr)) < 0) {
+            std::cerr << "[StreamIngest] no stream info in " << cfg.uri << ": " << avError(err) << std::endl;
+            close();
+            return false;
+        }
+        streamIndex = av_find_best_stream(format, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+        if (streamIndex < 0) {
+            std::cerr << "[StreamIngest] no video stream in " << cfg.uri << std::endl;
+            close();
+            return false;
+        }
+        const AVStream* stream = format->streams[streamIndex];
+        timeBase = stream->time_base;
+
+        std::vector<StreamDecoder> candidates;
+        if (cfg.decoder == StreamDecoder::Auto) candidates = {StreamDecoder::RkHw, StreamDecoder::Nvdec};
+        else if (cfg.decoder != StreamDecoder::SwFfmpeg) candidates = {cfg.decoder};
+        for (StreamDecoder kind : candidates) {
+            const char* name = hardwareDecoderName(stream->codecpar->codec_id, kind);
+            const AVCodec* decoder = name ? avcodec_find_decoder_by_name(name) : nullptr;
+            if (decoder && openCodec(decoder, stream->codecpar, cfg.lowLatency)) {
+                *used = kind;
+                break;
+            }
+        }
+        if (!codec) {
+            if (cfg.decoder == StreamDecoder::RkHw || cfg.decoder == StreamDecoder::Nvdec) {
+                std::cerr << "[StreamIngest] " << streamDecoderName(cfg.decoder)
+                          << " decoder unavailable for this stream, falling back to software decode" << std::endl;
+            }
+            const AVCodec* decoder = avcodec_find_decoder(stream->codecpar->codec_id);
+            if (!decoder || !openCodec(decoder, stream->codecpar, cfg.lowLatency)) {
+                std::cerr << "[StreamIngest] no decoder for " << avcodec_get_name(stream->codecpar->codec_id)
+                          << std::endl;
+                close();
+                return false;
+            }
+            *used = StreamDecoder::SwFfmpeg;
+        }
+        packet = av_packet_alloc();
+        frame = av_frame_alloc();
+        return true;
+    }
+
+    void close() {
+        if (frame) av_frame_free(&frame);
+        if (packet) av_packet_free(&packet);
+        if (codec) avcodec_free_context(&codec);
+        if (format) avformat_close_input(&format);
+        streamIndex = -1;
+    }
+
+    bool opened() const noexcept { return format != nullptr && codec != nullptr; }
+
+    // 把解码帧拷入帧缓冲池：CameraFramePacket + NV12；软件解码的 I420 在拷贝时交错 UV
+    BufferRef toBuffer(BufferPool& pool) {
+        const int width = frame->width;
+        const int height = frame->height;
+        const auto pixFmt = static_cast<AVPixelFormat>(frame->format);
+        bool planar = pixFmt == AV_PIX_FMT_YUV420P || pixFmt == AV_PIX_FMT_YUVJ420P;
+        if (width <= 0 || height <= 0 || (pixFmt != AV_PIX_FMT_NV12 && !planar)) {
+            if (!warnedFormat) {
+                warnedFormat = true;
+                std::cerr << "[StreamIngest] unsupported decoder output format " << pixFmt << std::endl;
+            }
+            return {};
+        }
+        const int stride = (width + 1) & ~1;
+        const int chromaRows = (height + 1) / 2;
+        BufferPoolKey key{width, height, "NV12"};
+        BufferRef buffer = pool.acquire(key, sizeof(CameraFramePacket) + static_cast<std::size_t>(stride) *
+                                                                             (height + chromaRows));
+        std::uint8_t* base = buffer.mutableData();
+        CameraFramePacket header{};
+        header.width = width;
+        header.height = height;
+        header.stride = stride;
+        std::strncpy(header.format, "NV12", sizeof(header.format) - 1);
+        std::memcpy(base, &header, sizeof(header));
+        std::uint8_t* y = base + sizeof(CameraFramePacket);
+        for (int row = 0; row < height; ++row) {
+            std::memcpy(y + static_cast<std::size_t>(row) * stride, frame->data[0] + row * frame->linesize[0],
+                        static_cast<std::size_t>(width));
+        }
+        std::uint8_t* uv = y + static_cast<std::size_t>(stride) * height;
+        for (int row = 0; row < chromaRows; ++row) {
+            std::uint8_t* dst = uv + static_cast<std::size_t>(row) * stride;
+            if (!planar) {
+                std::memcpy(dst, frame->data[1] + row * frame->linesize[1], static_cast<std::size_t>(stride));
+                continue;
+            }
+            const std::uint8_t* u = frame->data[1] + row * frame->linesize[1];
+            const std::uint8_t* v = frame->data[2] + row * frame->linesize[2];
+            for (int x = 0; x < stride / 2; ++x) {
+                dst[2 * x] = u[x];
+                dst[2 * x + 1] = v[x];
+            }
+        }
+        return buffer;
+    }
+
+    std::int64_t framePtsNs(std::int64_t arrivalNs) const {
+        std::int64_t ts = frame->best_effort_timestamp;
+        if (ts == AV_NOPTS_VALUE) return arrivalNs;
+        return av_rescale_q(ts, timeBase, AVRational{1, 1'000'000'000});
+    }
+};
+
+#else
+
+struct StreamIngest::Backend {};
+
+#endif
+
+// ---------------------------------------------------------------------------
+// StreamIngest
+
+StreamIngest::StreamIngest(const StreamIngestConfig& cfg, BufferPool& pool)
+    : cfg_(cfg), pool_(pool), jitter_(JitterBuffer::Config{cfg.jitterNs, cfg.jitterCapacity}) {}
+
+StreamIngest::~StreamIngest() { stop(); }
+
+bool StreamIngest::start(FrameCallback onFrame) {
+    if (running_.load()) return true;
+#ifdef FALCONMINDSDK_FFMPEG_INGEST_ENABLED
+    onFrame_ = std::move(onFrame);
+    backend_ = std::make_unique<Backend>();
+    backend_->running = &running_;
+    running_.store(true);
+    StreamDecoder used = StreamDecoder::SwFfmpeg;
+    if (!backend_->open(cfg_, &used)) {
+        running_.store(false);
+        backend_.reset();
+        return false;
+    }
+    activeDecoder_.store(used, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_ = StreamIngestStats{};
+        jitter_.clear();
+    }
+    std::cout << "[StreamIngest] " << cfg_.uri << " opened: decoder=" << streamDecoderName(used)
+              << (cfg_.lowLatency ? " (low latency)" : "") << std::endl;
+    ingestThread_ = std::thread(&StreamIngest::ingestLoop, this);
+    if (!cfg_.lowLatency) outputThread_ = std::thread(&StreamIngest::outputLoop, this);
+    return true;
+#else
+    (void)onFrame;
+    std::cerr << "[StreamIngest] " << cfg_.uri
+              << ": built without FFmpeg (enable FALCONMINDSDK_BUILD_FFMPEG_INGEST)" << std::endl;
+    return false;
+#endif
+}
+
+void StreamIngest::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);  // 与输出线程的 wait 互斥，避免丢失唤醒
+        if (!running_.exchange(false)) return;
+    }
+    cv_.notify_all();
+    if (ingestThread_.joinable()) ingestThread_.join();
+    if (outputThread_.joinable()) outputThread_.join();
+    backend_.reset();
+    std::lock_guard<std::mutex> lock(mutex_);
+    jitter_.clear();  // 未输出的帧归还缓冲池
+}
+
+StreamIngestStats StreamIngest::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    StreamIngestStats s = stats_;
+    s.lateDrops = jitter_.lateDrops();
+    s.overflowDrops = jitter_.overflowDrops();
+    return s;
+}
+
+void StreamIngest::enqueue(BufferRef frame, std::int64_t ptsNs, std::int64_t arrivalNs) {
+    if (cfg_.lowLatency) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++stats_.decodedFrames;
+            ++stats_.deliveredFrames;
+        }
+        onFrame_(std::move(frame), arrivalNs);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.decodedFrames;
+        jitter_.push(std::move(frame), ptsNs, arrivalNs);
+    }
+    cv_.notify_one();
+}
+
+void StreamIngest::outputLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_.load(std::memory_order_relaxed)) {
+        std::int64_t due = jitter_.nextDueNs();
+        std::int64_t now = PipelineClock::nowNs();
+        if (due < 0) {
+            cv_.wait(lock);
+            continue;
+        }
+        if (now < due) {
+            cv_.wait_for(lock, std::chrono::nanoseconds(due - now));
+            continue;
+        }
+        BufferRef frame;
+        std::int64_t captureNs = 0;
+        if (!jitter_.pop(now, frame, captureNs)) continue;
+        ++stats_.deliveredFrames;
+        lock.unlock();
+        onFrame_(std::move(frame), captureNs);
+        lock.lock();
+    }
+}
+
+void StreamIngest::ingestLoop() {
+#ifdef FALCONMINDSDK_FFMPEG_INGEST_ENABLED
+    Backend& b = *backend_;
+    while (running_.load(std::memory_order_relaxed)) {
+        if (!b.opened()) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_for(lock, std::chrono::milliseconds(cfg_.reconnectDelayMs),
+                         [this] { return !running_.load(std::memory_order_relaxed); });
+            if (!running_.load(std::memory_order_relaxed)) break;
+            ++stats_.reconnects;
+            lock.unlock();
+            StreamDecoder used = StreamDecoder::SwFfmpeg;
+            if (b.open(cfg_, &used)) activeDecoder_.store(used, std::memory_order_relaxed);
+            continue;
+        }
+        b.armTimeout(cfg_.timeoutMs);
+        int err = av_read_frame(b.format, b.packet);
+        if (err < 0) {
+            if (running_.load(std::memory_order_relaxed)) {
+                std::cerr << "[StreamIngest] " << cfg_.uri << " read failed: " << avError(err) << ", reconnecting"
+                          << std::endl;
+            }
+            b.close();
+            continue;
+        }
+        if (b.packet->stream_index == b.streamIndex) {
+            bool failed = avcodec_send_packet(b.codec, b.packet) < 0;
+            while (avcodec_receive_frame(b.codec, b.frame) == 0) {
+                std::int64_t arrivalNs = PipelineClock::nowNs();
+                BufferRef frame = b.toBuffer(pool_);
+                if (frame) enqueue(std::move(frame), b.framePtsNs(arrivalNs), arrivalNs);
+                av_frame_unref(b.frame);
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++stats_.packets;
+            if (failed) ++stats_.decodeErrors;
+        }
+        av_packet_unref(b.packet);
+    }
+#endif
+}
+
+} // namespace falconmind::sdk::sensors
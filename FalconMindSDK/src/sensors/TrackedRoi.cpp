@@ -0,0 +1,64 @@
+#include "falconmind/sdk/sensors/TrackedRoi.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace falconmind::sdk::sensors {
+
+TrackedRoi::TrackedRoi(TrackedRoiConfig config) : config_(config) {
+    config_.lostTimeoutMs = std::max(config_.lostTimeoutMs, 1);
+    config_.maxExtrapolationMs = std::max(config_.maxExtrapolationMs, 0);
+}
+
+void TrackedRoi::setTarget(float cx, float cy, float vxPerSec, float vyPerSec, std::int64_t timestampNs) {
+    if (!std::isfinite(cx) || !std::isfinite(cy)) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    hasTarget_ = true;
+    cx_ = cx;
+    cy_ = cy;
+    vx_ = std::isfinite(vxPerSec) ? vxPerSec : 0.f;
+    vy_ = std::isfinite(vyPerSec) ? vyPerSec : 0.f;
+    timestampNs_ = timestampNs;
+}
+
+void TrackedRoi::clearTarget() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    hasTarget_ = false;
+}
+
+bool TrackedRoi::tracking(std::int64_t captureNs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hasTarget_ && captureNs - timestampNs_ <= std::int64_t{config_.lostTimeoutMs} * 1'000'000;
+}
+
+ImageRect TrackedRoi::window(std::int64_t captureNs, int width, int height, int sourceWidth, int sourceHeight) const {
+    if (sourceWidth <= 0 || sourceHeight <= 0) return {};
+    width = std::clamp(width, 1, sourceWidth);
+    height = std::clamp(height, 1, sourceHeight);
+    float cx = static_cast<float>(sourceWidth) * 0.5f;
+    float cy = static_cast<float>(sourceHeight) * 0.5f;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::int64_t age = captureNs - timestampNs_;
+        const std::int64_t timeoutNs = std::int64_t{config_.lostTimeoutMs} * 1'000'000;
+        if (hasTarget_ && age <= 2 * timeoutNs) {
+            cx = cx_;
+            cy = cy_;
+            if (age <= timeoutNs) {
+                const std::int64_t horizon =
+                    std::clamp<std::int64_t>(age, 0, std::int64_t{config_.maxExtrapolationMs} * 1'000'000);
+                const float dt = static_cast<float>(horizon) * 1e-9f;
+                cx += vx_ * dt;
+                cy += vy_ * dt;
+            }
+        }
+    }
+    ImageRect rect;
+    rect.width = width;
+    rect.height = height;
+    rect.x = std::clamp(static_cast<int>(std::lround(cx - width * 0.5f)), 0, sourceWidth - width);
+    rect.y = std::clamp(static_cast<int>(std::lround(cy - height * 0.5f)), 0, sourceHeight - height);
+    return rect;
+}
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,256 @@
+#include "falconmind/sdk/sensors/VideoConvertNode.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+#include "falconmind/sdk/sensors/ColorConvert.h"
+#include "falconmind/sdk/core/Pad.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace falconmind::sdk::sensors {
+
+using namespace falconmind::sdk::core;
+
+namespace {
+
+inline std::uint8_t clamp255(int v) {
+    return static_cast<std::uint8_t>(std::max(0, std::min(255, v)));
+}
+
+bool isRgbLike(PixelFormat f) {
+    return f == PixelFormat::RGB8 || f == PixelFormat::BGR8;
+}
+
+void copyRows(const std::uint8_t* src, std::int32_t srcStride, std::uint8_t* dst,
+              std::size_t rowBytes, std::int32_t rows) {
+    for (std::int32_t y = 0; y < rows; ++y) {
+        std::memcpy(dst + static_cast<std::size_t>(y) * rowBytes,
+                    src + static_cast<std::size_t>(y) * srcStride, rowBytes);
+    }
+}
+
+void swapRedBlue(const std::uint8_t* src, std::int32_t srcStride, std::uint8_t* dst,
+                 std::int32_t w, std::int32_t h) {
+    for (std::int32_t y = 0; y < h; ++y) {
+        const std::uint8_t* s = src + static_cast<std::size_t>(y) * srcStride;
+        std::uint8_t* d = dst + static_cast<std::size_t>(y) * w * 3;
+        for (std::int32_t x = 0; x < w; ++x) {
+            d[x * 3 + 0] = s[x * 3 + 2];
+            d[x * 3 + 1] = s[x * 3 + 1];
+            d[x * 3 + 2] = s[x * 3 + 0];
+        }
+    }
+}
+
+void yuyvToNv12(const std::uint8_t* src, std::int32_t srcStride, std::uint8_t* dst,
+                std::int32_t w, std::int32_t h) {
+    std::uint8_t* yPlane = dst;
+    std::uint8_t* uvPlane = dst + static_cast<std::size_t>(w) * h;
+    for (std::int32_t y = 0; y < h; ++y) {
+        const std::uint8_t* row = src + static_cast<std::size_t>(y) * srcStride;
+        std::uint8_t* yRow = yPlane + static_cast<std::size_t>(y) * w;
+        for (std::int32_t x = 0; x < w; ++x) {
+            yRow[x] = row[(x >> 1) * 4 + ((x & 1) ? 2 : 0)];
+        }
+        if ((y & 1) == 0) {
+            std::uint8_t* uvRow = uvPlane + static_cast<std::size_t>(y / 2) * w;
+            for (std::int32_t x = 0; x < w; x += 2) {
+                uvRow[x] = row[(x >> 1) * 4 + 1];
+                if (x + 1 < w) uvRow[x + 1] = row[(x >> 1) * 4 + 3];
+            }
+        }
+    }
+}
+
+// RGB/BGR → NV12：Y 逐像素，UV 取 2x2 块左上像素；源通道顺序为模板参数，Y 与 UV 分两趟，内层循环无分支
+template <PixelFormat From>
+void rgbToNv12(const std::uint8_t* src, std::int32_t srcStride, std::uint8_t* dst,
+               std::int32_t w, std::int32_t h) {
+    using T = PixelFormatTraits<From>;
+    std::uint8_t* uvPlane = dst + static_cast<std::size_t>(w) * h;
+    for (std::int32_t y = 0; y < h; ++y) {
+        const std::uint8_t* row = src + static_cast<std::size_t>(y) * srcStride;
+        std::uint8_t* yRow = dst + static_cast<std::size_t>(y) * w;
+        for (std::int32_t x = 0; x < w; ++x) {
+            const std::uint8_t* px = row + x * 3;
+            yRow[x] = clamp255((77 * px[T::rIndex] + 150 * px[1] + 29 * px[T::bIndex]) >> 8);
+        }
+        if (y & 1) continue;
+        std::uint8_t* uvRow = uvPlane + static_cast<std::size_t>(y / 2) * w;
+        std::int32_t x = 0;
+        for (; x + 1 < w; x += 2) {
+            const std::uint8_t* px = row + x * 3;
+            const int r = px[T::rIndex], g = px[1], b = px[T::bIndex];
+            uvRow[x] = clamp255(((-43 * r - 85 * g + 128 * b) >> 8) + 128);
+            uvRow[x + 1] = clamp255(((128 * r - 107 * g - 21 * b) >> 8) + 128);
+        }
+        if (x < w) {
+            const std::uint8_t* px = row + x * 3;
+            uvRow[x] = clamp255(((-43 * px[T::rIndex] - 85 * px[1] + 128 * px[T::bIndex]) >> 8) + 128);
+        }
+    }
+}
+
+} // namespace
+
+bool canConvertPixels(PixelFormat from, PixelFormat to) noexcept {
+    if (from == PixelFormat::Any || to == PixelFormat::Any) return false;
+    if (from == to) return true;
+    if (isRgbLike(from)) return isRgbLike(to) || to == PixelFormat::NV12;
+    if (from == PixelFormat::YUYV) return isRgbLike(to) || to == PixelFormat::NV12;
+    if (from == PixelFormat::NV12) return isRgbLike(to);
+    return false;
+}
+
+bool convertPixels(PixelFormat from, const std::uint8_t* src, std::int32_t srcStride,
+                   PixelFormat to, std::uint8_t* dst, std::int32_t width, std::int32_t height) {
+    if (!src || !dst || width <= 0 || height <= 0 || !canConvertPixels(from, to)) {
+        return false;
+    }
+    if (srcStride <= 0) srcStride = pixelFormatMinStride(from, width);
+
+    if (from == to) {
+        auto rowBytes = static_cast<std::size_t>(pixelFormatMinStride(to, width));
+        copyRows(src, srcStride, dst, rowBytes, height);
+        if (to == PixelFormat::NV12) {
+            copyRows(src + static_cast<std::size_t>(srcStride) * height, srcStride,
+                     dst + rowBytes * height, rowBytes, (height + 1) / 2);
+        }
+        return true;
+    }
+    if (isRgbLike(from) && isRgbLike(to)) {
+        swapRedBlue(src, srcStride, dst, width, height);
+    } else if (isRgbLike(from)) {
+        if (from == PixelFormat::BGR8) {
+            rgbToNv12<PixelFormat::BGR8>(src, srcStride, dst, width, height);
+        } else {
+            rgbToNv12<PixelFormat::RGB8>(src, srcStride, dst, width, height);
+        }
+    } else if (from == PixelFormat::YUYV && to == PixelFormat::NV12) {
+        yuyvToNv12(src, srcStride, dst, width, height);
+    } else if (from == PixelFormat::YUYV) {
+        convertYuyvToRgb(src, srcStride, dst, width, height, to == PixelFormat::BGR8);
+    } else {
+        convertNv12ToRgb(src, srcStride, dst, width, height, to == PixelFormat::BGR8);
+    }
+    return true;
+}
+
+VideoConvertNode::VideoConvertNode() : Node("video_convert") {
+    auto sink = std::make_shared<Pad>("sink", PadType::Sink);
+    auto src = std::make_shared<Pad>("src", PadType::Source);
+    Caps in;
+    for (auto f : {PixelFormat::YUYV, PixelFormat::NV12, PixelFormat::RGB8, PixelFormat::BGR8}) {
+        in.addVideo(VideoCaps{f, 0, 0, 0});
+    }
+    Caps out;
+    for (auto f : {PixelFormat::RGB8, PixelFormat::BGR8, PixelFormat::NV12}) {
+        out.addVideo(VideoCaps{f, 0, 0, 0});
+    }
+    sink->setCaps(in);
+    src->setCaps(out);
+    sink->setCapsCallback([this](const VideoCaps& caps) { inputFormat_ = caps.format; });
+    src->setCapsCallback([this](const VideoCaps& caps) {
+        outputFormat_ = caps.format;
+        fps_ = caps.fps;
+    });
+    sinkPad_ = addPad(sink);
+    srcPad_ = addPad(src);
+}
+
+bool VideoConvertNode::canFuse() const noexcept {
+    return outputFormat_ == PixelFormat::RGB8 || outputFormat_ == PixelFormat::BGR8;
+}
+
+bool VideoConvertNode::planFusedFrame(const FusedImageInfo& in, FusedStagePlan& out) {
+    if (!canFuse() || !canConvertPixels(in.format, outputFormat_)) return false;
+    out.format = outputFormat_;
+    return true;
+}
+
+bool VideoConvertNode::start() {
+    auto* sink = sinkPad_;
+    if (sink) {
+        sink->setBufferCallback([this](const BufferRef& frame) {
+            if (frame.size() >= sizeof(CameraFramePacket)) {
+                std::lock_guard<std::mutex> lock(frameMutex_);
+                pending_ = frame;
+            }
+        });
+    }
+    std::cout << "[VideoConvertNode] start " << pixelFormatName(inputFormat_) << " -> "
+              << pixelFormatName(outputFormat_) << std::endl;
+    return true;
+}
+
+void VideoConvertNode::stop() {
+    std::lock_guard<std::mutex> lock(frameMutex_);
+    pending_.reset();
+    pool_.clear();
+}
+
+void VideoConvertNode::releaseIdleBuffers() {
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        pending_.reset();
+        pool_.clear();
+    }
+    if (fusion_) fusion_->releaseBuffers();
+}
+
+void VideoConvertNode::process() {
+    BufferRef frame;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        frame = std::move(pending_);
+        pending_.reset();
+    }
+    if (frame.size() < sizeof(CameraFramePacket)) {
+        return;
+    }
+    auto* outPad = srcPad_;
+    if (!outPad) return;
+
+    const auto* header = reinterpret_cast<const CameraFramePacket*>(frame.data());
+    PixelFormat from = frame.meta().video.format != PixelFormat::Any ? frame.meta().video.format : inputFormat_;
+    PixelFormat to = outputFormat_ != PixelFormat::Any ? outputFormat_ : from;
+    if (fusion_ && fusion_->run(frame, from)) {
+        return;
+    }
+    if (from == to) {
+        outPad->pushBuffer(frame);
+        return;
+    }
+
+    std::int32_t w = header->width;
+    std::int32_t h = header->height;
+    std::int32_t srcStride = header->stride > 0 ? header->stride : pixelFormatMinStride(from, w);
+    // NV12 的 UV 平面紧随 Y 平面，行数为 (h + 1) / 2
+    std::size_t rows = h > 0 ? static_cast<std::size_t>(h) : 0;
+    if (from == PixelFormat::NV12) rows += (rows + 1) / 2;
+    std::size_t inBytes = static_cast<std::size_t>(srcStride) * rows;
+    std::size_t outBytes = pixelFormatFrameBytes(to, w, h);
+    if (outBytes == 0 || frame.size() < sizeof(CameraFramePacket) + inBytes) {
+        return;
+    }
+
+    BufferRef out = pool_.acquire(BufferPoolKey{w, h, pixelFormatName(to)}, sizeof(CameraFramePacket) + outBytes);
+    std::uint8_t* base = out.mutableData();
+    auto* outHeader = reinterpret_cast<CameraFramePacket*>(base);
+    *outHeader = *header;
+    outHeader->stride = pixelFormatMinStride(to, w);
+    std::strncpy(outHeader->format, pixelFormatName(to), sizeof(outHeader->format) - 1);
+    outHeader->format[sizeof(outHeader->format) - 1] = '\0';
+    if (!convertPixels(from, cameraFramePacketData(header), srcStride, to,
+                       cameraFramePacketDataWritable(outHeader), w, h)) {
+        std::cerr << "[VideoConvertNode] unsupported conversion " << pixelFormatName(from)
+                  << " -> " << pixelFormatName(to) << std::endl;
+        return;
+    }
+    auto& meta = out.mutableMeta();
+    meta = frame.meta();
+    meta.video = VideoCaps{to, w, h, fps_};
+    outPad->pushBuffer(out);
+}
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,875 @@
+#include "falconmind/sdk/sensors/VideoUplink.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#ifdef FALCONMINDSDK_VIDEO_UPLINK_ENABLED
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/hwcontext.h>
+#include <libavutil/hwcontext_drm.h>
+#include <libavutil/opt.h>
+}
+#endif
+
+namespace falconmind::sdk::sensors {
+
+using namespace falconmind::sdk::core;
+
+const std::uint8_t kOverlaySeiUuid[16] = {0x46, 0x4d, 0x44, 0x45, 0x54, 0x4f, 0x56, 0x4c,   // "FMDETOVL"
+                                          0x9c, 0x3b, 0x52, 0x0e, 0x8a, 0x61, 0x4f, 0xd7};
+
+namespace {
+
+constexpr std::uint8_t kSeiUserDataUnregistered = 5;
+constexpr std::uint8_t kH264NalSei = 6;
+constexpr std::uint8_t kH264NalAud = 9;
+constexpr std::uint8_t kH265NalAud = 35;
+constexpr std::uint8_t kH265NalPrefixSei = 39;
+constexpr std::size_t kOverlayHeaderBytes = 16 + 16;  // uuid + 固定头
+constexpr std::size_t kOverlayBoxBytes = 16;
+
+bool startsWith(const std::string& s, const char* prefix) {
+    return s.compare(0, std::strlen(prefix), prefix) == 0;
+}
+
+std::string toUpper(const std::string& s) {
+    std::string upper;
+    upper.reserve(s.size());
+    for (char c : s) upper.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+    return upper;
+}
+
+void putLe(std::vector<std::uint8_t>& out, std::uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+
+std::uint64_t getLe(const std::uint8_t* p, int bytes) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+    return v;
+}
+
+float clamp01(float v) {
+    return std::isfinite(v) ? std::min(1.0f, std::max(0.0f, v)) : 0.0f;
+}
+
+std::uint16_t quantize16(float v) {
+    return static_cast<std::uint16_t>(std::lround(clamp01(v) * 65535.0f));
+}
+
+// 从 from 起查找下一个起始码 00 00 01；返回起始码首字节位置（前面紧邻的 00 一并算作 4 字节起始码），未找到返回 size
+std::size_t findStartCode(const std::uint8_t* data, std::size_t size, std::size_t from, std::size_t* codeLen) {
+    for (std::size_t i = from; i + 3 <= size; ++i) {
+        if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1) {
+            const bool four = i > from && data[i - 1] == 0;
+            if (codeLen) *codeLen = four ? 4 : 3;
+            return four ? i - 1 : i;
+        }
+    }
+    if (codeLen) *codeLen = 0;
+    return size;
+}
+
+int nalType(VideoCodec codec, std::uint8_t header) {
+    return codec == VideoCodec::H265 ? (header >> 1) & 0x3F : header & 0x1F;
+}
+
+// RBSP → NAL 载荷：连续两个 00 之后的 00..03 前插入 03
+void appendEscaped(const std::vector<std::uint8_t>& rbsp, std::vector<std::uint8_t>& out) {
+    int zeros = 0;
+    for (std::uint8_t b : rbsp) {
+        if (zeros >= 2 && b <= 3) {
+            out.push_back(3);
+            zeros = 0;
+        }
+        out.push_back(b);
+        zeros = b == 0 ? zeros + 1 : 0;
+    }
+}
+
+void unescape(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& out) {
+    out.clear();
+    int zeros = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        if (zeros >= 2 && data[i] == 3) {
+            zeros = 0;
+            continue;
+        }
+        out.push_back(data[i]);
+        zeros = data[i] == 0 ? zeros + 1 : 0;
+    }
+}
+
+bool parseOverlayPayload(const std::uint8_t* p, std::size_t size, OverlayMetadata& out) {
+    if (size < kOverlayHeaderBytes || std::memcmp(p, kOverlaySeiUuid, 16) != 0) return false;
+    if (p[16] != kOverlaySeiVersion) return false;
+    const std::size_t count = static_cast<std::size_t>(getLe(p + 18, 2));
+    if (size < kOverlayHeaderBytes + count * kOverlayBoxBytes) return false;
+    out.frameIndex = static_cast<std::uint32_t>(getLe(p + 20, 4));
+    out.captureNs = static_cast<std::int64_t>(getLe(p + 24, 8));
+    out.boxes.resize(count);
+    const std::uint8_t* item = p + kOverlayHeaderBytes;
+    for (OverlayBox& box : out.boxes) {
+        box.trackId = static_cast<std::int32_t>(static_cast<std::uint32_t>(getLe(item, 4)));
+        box.classId = static_cast<std::int16_t>(static_cast<std::uint16_t>(getLe(item + 4, 2)));
+        box.score = static_cast<float>(item[6]) / 255.0f;
+        box.x = static_cast<float>(getLe(item + 8, 2)) / 65535.0f;
+        box.y = static_cast<float>(getLe(item + 10, 2)) / 65535.0f;
+        box.width = static_cast<float>(getLe(item + 12, 2)) / 65535.0f;
+        box.height = static_cast<float>(getLe(item + 14, 2)) / 65535.0f;
+        item += kOverlayBoxBytes;
+    }
+    return true;
+}
+
+} // namespace
+
+VideoCodec parseVideoCodec(const std::string& name) noexcept {
+    const std::string upper = toUpper(name);
+    if (upper == "H265" || upper == "HEVC" || upper == "H.265") return VideoCodec::H265;
+    return VideoCodec::H264;
+}
+
+const char* videoCodecName(VideoCodec codec) noexcept {
+    return codec == VideoCodec::H265 ? "H265" : "H264";
+}
+
+VideoEncoder parseVideoEncoder(const std::string& name) noexcept {
+    const std::string upper = toUpper(name);
+    if (upper == "RK_HW" || upper == "MPP") return VideoEncoder::RkHw;
+    if (upper == "NVENC") return VideoEncoder::Nvenc;
+    if (upper == "SW_FFMPEG" || upper == "SW") return VideoEncoder::SwFfmpeg;
+    return VideoEncoder::Auto;
+}
+
+const char* videoEncoderName(VideoEncoder encoder) noexcept {
+    switch (encoder) {
+        case VideoEncoder::Auto: return "AUTO";
+        case VideoEncoder::RkHw: return "RK_HW";
+        case VideoEncoder::Nvenc: return "NVENC";
+        case VideoEncoder::SwFfmpeg: return "SW_FFMPEG";
+    }
+    return "AUTO";
+}
+
+bool videoUplinkAvailable() noexcept {
+#ifdef FALCONMINDSDK_VIDEO_UPLINK_ENABLED
+    return true;
+#else
+    return false;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// SEI 叠加元数据
+
+std::size_t appendOverlaySei(VideoCodec codec, const OverlayMetadata& meta, std::vector<std::uint8_t>& out) {
+    const std::size_t count = std::min<std::size_t>(meta.boxes.size(), 0xFFFF);
+    const std::size_t payloadSize = kOverlayHeaderBytes + count * kOverlayBoxBytes;
+
+    std::vector<std::uint8_t> rbsp;
+    rbsp.reserve(payloadSize + payloadSize / 255 + 4);
+    rbsp.push_back(kSeiUserDataUnregistered);
+    std::size_t sizeLeft = payloadSize;
+    for (; sizeLeft >= 255; sizeLeft -= 255) rbsp.push_back(0xFF);
+    rbsp.push_back(static_cast<std::uint8_t>(sizeLeft));
+    rbsp.insert(rbsp.end(), kOverlaySeiUuid, kOverlaySeiUuid + 16);
+    rbsp.push_back(kOverlaySeiVersion);
+    rbsp.push_back(0);
+    putLe(rbsp, count, 2);
+    putLe(rbsp, meta.frameIndex, 4);
+    putLe(rbsp, static_cast<std::uint64_t>(meta.captureNs), 8);
+    for (std::size_t i = 0; i < count; ++i) {
+        const OverlayBox& box = meta.boxes[i];
+        putLe(rbsp, static_cast<std::uint32_t>(box.trackId), 4);
+        putLe(rbsp, static_cast<std::uint16_t>(static_cast<std::int16_t>(box.classId)), 2);
+        rbsp.push_back(static_cast<std::uint8_t>(std::lround(clamp01(box.score) * 255.0f)));
+        rbsp.push_back(0);
+        putLe(rbsp, quantize16(box.x), 2);
+        putLe(rbsp, quantize16(box.y), 2);
+        putLe(rbsp, quantize16(box.width), 2);
+        putLe(rbsp, quantize16(box.height), 2);
+    }
+    rbsp.push_back(0x80);  // rbsp_trailing_bits
+
+    const std::size_t before = out.size();
+    out.insert(out.end(), {0, 0, 0, 1});
+    if (codec == VideoCodec::H265) {
+        out.push_back(static_cast<std::uint8_t>(kH265NalPrefixSei << 1));
+        out.push_back(1);  // nuh_layer_id 0, nuh_temporal_id_plus1 1
+    } else {
+        out.push_back(kH264NalSei);
+    }
+    appendEscaped(rbsp, out);
+    return out.size() - before;
+}
+
+bool findOverlaySei(VideoCodec codec, const std::uint8_t* data, std::size_t size, OverlayMetadata& out) {
+    const std::size_t headerBytes = codec == VideoCodec::H265 ? 2 : 1;
+    const int seiType = codec == VideoCodec::H265 ? kH265NalPrefixSei : kH264NalSei;
+    std::vector<std::uint8_t> rbsp;
+    std::size_t codeLen = 0;
+    std::size_t pos = findStartCode(data, size, 0, &codeLen);
+    while (pos < size) {
+        const std::size_t nal = pos + codeLen;
+        const std::size_t end = findStartCode(data, size, nal, &codeLen);
+        if (end > nal + headerBytes && nalType(codec, data[nal]) == seiType) {
+            unescape(data + nal + headerBytes, end - nal - headerBytes, rbsp);
+            // 逐条解析 SEI 消息，末尾为 rbsp_trailing_bits
+            std::size_t i = 0;
+            while (i + 1 < rbsp.size()) {
+                std::size_t type = 0;
+                while (i < rbsp.size() && rbsp[i] == 0xFF) type += rbsp[i++];
+                if (i >= rbsp.size()) break;
+                type += rbsp[i++];
+                std::size_t payload = 0;
+                while (i < rbsp.size() && rbsp[i] == 0xFF) payload += rbsp[i++];
+                if (i >= rbsp.size()) break;
+                payload += rbsp[i++];
+                if (payload > rbsp.size() - i) break;
+                if (type == kSeiUserDataUnregistered && parseOverlayPayload(rbsp.data() + i, payload, out)) {
+                    return true;
+                }
+                i += payload;
+            }
+        }
+        pos = end;
+    }
+    return false;
+}
+
+void overlayFromDetections(const perception::DetectionResultView& dets, int frameWidth, int frameHeight,
+                           OverlayMetadata& out) {
+    out.frameIndex = dets.frameIndex();
+    out.captureNs = static_cast<std::int64_t>(dets.timestampNs());
+    out.boxes.resize(dets.size());
+    const float sx = frameWidth > 0 ? 1.0f / static_cast<float>(frameWidth) : 0.0f;
+    const float sy = frameHeight > 0 ? 1.0f / static_cast<float>(frameHeight) : 0.0f;
+    for (std::size_t i = 0; i < dets.size(); ++i) {
+        const perception::DetectionBBox bbox = dets.bbox(i);
+        OverlayBox& box = out.boxes[i];
+        box.trackId = dets.trackId(i);
+        box.classId = dets.classId(i);
+        box.score = dets.score(i);
+        const float x0 = clamp01(bbox.x * sx);
+        const float y0 = clamp01(bbox.y * sy);
+        box.x = x0;
+        box.y = y0;
+        box.width = clamp01((bbox.x + bbox.width) * sx) - x0;
+        box.height = clamp01((bbox.y + bbox.height) * sy) - y0;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// VideoBitrateController
+
+VideoBitrateController::VideoBitrateController() : VideoBitrateController(Config{}) {}
+
+VideoBitrateController::VideoBitrateController(const Config& cfg) : cfg_(cfg) {
+    cfg_.minKbps = std::max(1, cfg_.minKbps);
+    cfg_.maxKbps = std::max(cfg_.minKbps, cfg_.maxKbps);
+    cfg_.stepUpKbps = std::max(1, cfg_.stepUpKbps);
+    if (!(cfg_.backoff > 0.0 && cfg_.backoff < 1.0)) cfg_.backoff = 0.7;
+    if (cfg_.intervalNs <= 0) cfg_.intervalNs = 500'000'000;
+    targetKbps_ = std::min(cfg_.maxKbps, std::max(cfg_.minKbps, cfg_.startKbps));
+}
+
+void VideoBitrateController::setLinkQuality(double quality) noexcept {
+    if (!(quality > 0.0)) return;  // 0 / NaN：遥测未给出链路质量
+    if (quality > 1.0) quality /= 100.0;
+    quality_ = std::min(1.0, quality);
+}
+
+int VideoBitrateController::ceilingKbps() const noexcept {
+    if (quality_ < 0.0) return cfg_.maxKbps;
+    return cfg_.minKbps + static_cast<int>(std::lround((cfg_.maxKbps - cfg_.minKbps) * quality_));
+}
+
+bool VideoBitrateController::update(std::int64_t nowNs) noexcept {
+    const int ceiling = ceilingKbps();
+    const int previous = targetKbps_;
+    if (targetKbps_ > ceiling) {
+        // 链路变差：不等评估周期，立即降到上限
+        targetKbps_ = ceiling;
+        congested_ = false;
+        lastUpdateNs_ = nowNs;
+        return true;
+    }
+    if (lastUpdateNs_ < 0) {
+        lastUpdateNs_ = nowNs;
+        return false;
+    }
+    if (nowNs - lastUpdateNs_ < cfg_.intervalNs) return false;
+    lastUpdateNs_ = nowNs;
+    if (congested_) {
+        targetKbps_ = static_cast<int>(targetKbps_ * cfg_.backoff);
+    } else {
+        targetKbps_ += cfg_.stepUpKbps;
+    }
+    congested_ = false;
+    targetKbps_ = std::max(cfg_.minKbps, std::min(targetKbps_, ceiling));
+    return targetKbps_ != previous;
+}
+
+// ---------------------------------------------------------------------------
+// VideoUplink 后端
+
+#ifdef FALCONMINDSDK_VIDEO_UPLINK_ENABLED
+
+namespace {
+
+constexpr std::uint32_t kDrmFormatNv12 = 0x3231564E;  // DRM_FORMAT_NV12 ('N' 'V' '1' '2')
+constexpr AVRational kStreamTimeBase{1, 90000};
+
+std::string avError(int err) {
+    char buf[AV_ERROR_MAX_STRING_SIZE] = {0};
+    av_strerror(err, buf, sizeof(buf));
+    return buf;
+}
+
+const char* encoderName(VideoCodec codec, VideoEncoder kind) {
+    const bool hevc = codec == VideoCodec::H265;
+    switch (kind) {
+        case VideoEncoder::RkHw: return hevc ? "hevc_rkmpp" : "h264_rkmpp";
+        case VideoEncoder::Nvenc: return hevc ? "hevc_nvenc" : "h264_nvenc";
+        case VideoEncoder::SwFfmpeg: return hevc ? "libx265" : "libx264";
+        case VideoEncoder::Auto: break;
+    }
+    return nullptr;
+}
+
+// 低延迟参数：无 B 帧、CBR、零延迟；各编码器私有选项名不同，不支持的选项 av_opt_set 返回错误，忽略即可
+void applyLowLatency(AVCodecContext* codec, VideoEncoder kind) {
+    void* priv = codec->priv_data;
+    switch (kind) {
+        case VideoEncoder::Nvenc:
+            av_opt_set(priv, "preset", "p1", 0);
+            av_opt_set(priv, "tune", "ull", 0);
+            av_opt_set(priv, "rc", "cbr", 0);
+            av_opt_set(priv, "zerolatency", "1", 0);
+            av_opt_set(priv, "delay", "0", 0);
+            break;
+        case VideoEncoder::RkHw:
+            av_opt_set(priv, "rc_mode", "CBR", 0);
+            break;
+        case VideoEncoder::SwFfmpeg:
+            av_opt_set(priv, "preset", "ultrafast", 0);
+            av_opt_set(priv, "tune", "zerolatency", 0);
+            break;
+        case VideoEncoder::Auto:
+            break;
+    }
+}
+
+// 码率与 VBV：缓冲约两帧，限制单帧码流峰值以控制排队延迟
+void applyBitrate(AVCodecContext* codec, int kbps, int fps) {
+    const std::int64_t bps = static_cast<std::int64_t>(kbps) * 1000;
+    codec->bit_rate = bps;
+    codec->rc_max_rate = bps;
+    codec->rc_buffer_size = static_cast<int>(std::min<std::int64_t>(bps * 2 / std::max(1, fps), INT32_MAX));
+}
+
+void releaseFrameRef(void* opaque, std::uint8_t*) {
+    delete static_cast<BufferRef*>(opaque);
+}
+
+// DRM PRIME 帧：描述符与其引用的帧缓冲一起释放
+struct DrmFrameHolder {
+    AVDRMFrameDescriptor desc{};
+    BufferRef frame;
+};
+
+void releaseDrmFrame(void* opaque, std::uint8_t*) {
+    delete static_cast<DrmFrameHolder*>(opaque);
+}
+
+} // namespace
+
+struct VideoUplink::Backend {
+    AVFormatContext* output{nullptr};
+    AVStream* stream{nullptr};
+    AVCodecContext* codec{nullptr};
+    AVPacket* packet{nullptr};
+    AVBufferRef* hwDevice{nullptr};
+    AVBufferRef* hwFrames{nullptr};
+    VideoEncoder kind{VideoEncoder::SwFfmpeg};
+    int width{0};
+    int height{0};
+    int stride{0};
+    bool dmabufInput{false};  // 打开时的输入是否带 DMABUF
+    bool drmPrime{false};     // 编码器以 DRM PRIME 导入 DMABUF
+    bool headerWritten{false};
+    std::int64_t firstCaptureNs{-1};
+    std::int64_t lastPts{-1};
+    std::int64_t retryAfterNs{0};
+    std::vector<std::uint8_t> sei;
+    const std::atomic<bool>* running{nullptr};
+    std::int64_t deadlineNs{0};
+
+    struct EncodeResult {
+        std::uint64_t encoded{0};
+        std::uint64_t packets{0};
+        std::uint64_t bytes{0};
+        std::uint64_t seiFrames{0};
+        bool encodeError{false};
+        bool sendError{false};
+        bool congested{false};
+    };
+
+    ~Backend() { close(); }
+
+    // 发送阻塞（SRT / UDP 缓冲满）时按超时返回，避免编码线程卡住
+    static int interrupt(void* opaque) {
+        auto* self = static_cast<Backend*>(opaque);
+        if (!self->running->load(std::memory_order_relaxed)) return 1;
+        return PipelineClock::nowNs() > self->deadlineNs ? 1 : 0;
+    }
+
+    void armTimeout(int timeoutMs) {
+        deadlineNs = PipelineClock::nowNs() + static_cast<std::int64_t>(timeoutMs) * 1'000'000;
+    }
+
+    bool matches(int w, int h, int s, bool dmabuf) const noexcept {
+        return codec && w == width && h == height && s == stride && dmabuf == dmabufInput;
+    }
+
+    bool createDrmFrames() {
+        int err = av_hwdevice_ctx_create(&hwDevice, AV_HWDEVICE_TYPE_DRM, nullptr, nullptr, 0);
+        if (err < 0) {
+            FM_LOG_WARN("VideoUplink", "DRM device unavailable: ", avError(err));
+            return false;
+        }
+        hwFrames = av_hwframe_ctx_alloc(hwDevice);
+        if (!hwFrames) return false;
+        auto* frames = reinterpret_cast<AVHWFramesContext*>(hwFrames->data);
+        frames->format = AV_PIX_FMT_DRM_PRIME;
+        frames->sw_format = AV_PIX_FMT_NV12;
+        frames->width = width;
+        frames->height = height;
+        if ((err = av_hwframe_ctx_init(hwFrames)) < 0) {
+            FM_LOG_WARN("VideoUplink", "DRM frames context init failed: ", avError(err));
+            av_buffer_unref(&hwFrames);
+            return false;
+        }
+        return true;
+    }
+
+    bool openEncoder(const AVCodec* encoder, VideoEncoder k, const VideoUplinkConfig& cfg, int kbps, bool drm) {
+        if (drm && !hwFrames && !createDrmFrames()) return false;
+        codec = avcodec_alloc_context3(encoder);
+        if (!codec) return false;
+        codec->width = width;
+        codec->height = height;
+        codec->time_base = kStreamTimeBase;
+        codec->framerate = AVRational{cfg.fps, 1};
+        codec->gop_size = cfg.gopFrames;
+        codec->max_b_frames = 0;
+        codec->flags |= AV_CODEC_FLAG_LOW_DELAY;
+        codec->pix_fmt = drm ? AV_PIX_FMT_DRM_PRIME : AV_PIX_FMT_NV12;
+        if (drm) codec->hw_frames_ctx = av_buffer_ref(hwFrames);
+        applyBitrate(codec, kbps, cfg.fps);
+        applyLowLatency(codec, k);
+        int err = avcodec_open2(codec, encoder, nullptr);
+        if (err < 0) {
+            FM_LOG_WARN("VideoUplink", "avcodec_open2(", encoder->name, ") failed: ", avError(err));
+            avcodec_free_context(&codec);
+            return false;
+        }
+        kind = k;
+        drmPrime = drm;
+        return true;
+    }
+
+    bool openOutput(const VideoUplinkConfig& cfg, std::string* sdp) {
+        const bool srt = startsWith(cfg.uri, "srt://");
+        int err = avformat_alloc_output_context2(&output, nullptr, srt ? "mpegts" : "rtp", cfg.uri.c_str());
+        if (err < 0 || !output) {
+            FM_LOG_ERROR("VideoUplink", "no muxer for ", cfg.uri, ": ", avError(err));
+            output = nullptr;
+            return false;
+        }
+        output->interrupt_callback.callback = &Backend::interrupt;
+        output->interrupt_callback.opaque = this;
+        output->flush_packets = 1;  // 每包立即写出，不在 AVIO 缓冲中攒包
+        output->max_delay = 0;
+        stream = avformat_new_stream(output, nullptr);
+        if (!stream || avcodec_parameters_from_context(stream->codecpar, codec) < 0) return false;
+        stream->time_base = kStreamTimeBase;
+
+        if (!(output->oformat->flags & AVFMT_NOFILE)) {
+            AVDictionary* opts = nullptr;
+            if (srt) {
+                av_dict_set(&opts, "transtype", "live", 0);
+                av_dict_set(&opts, "latency", std::to_string(static_cast<std::int64_t>(cfg.srtLatencyMs) * 1000).c_str(), 0);
+            }
+            armTimeout(cfg.timeoutMs);
+            err = avio_open2(&output->pb, cfg.uri.c_str(), AVIO_FLAG_WRITE, &output->interrupt_callback, &opts);
+            av_dict_free(&opts);
+            if (err < 0) {
+                FM_LOG_ERROR("VideoUplink", "open ", cfg.uri, " failed: ", avError(err));
+                return false;
+            }
+        }
+        armTimeout(cfg.timeoutMs);
+        if ((err = avformat_write_header(output, nullptr)) < 0) {
+            FM_LOG_ERROR("VideoUplink", "write header to ", cfg.uri, " failed: ", avError(err));
+            return false;
+        }
+        headerWritten = true;
+        if (!srt && sdp) {
+            char buf[2048] = {0};
+            if (av_sdp_create(&output, 1, buf, sizeof(buf)) == 0) *sdp = buf;
+        }
+        return true;
+    }
+
+    bool open(const VideoUplinkConfig& cfg, int w, int h, int s, bool dmabuf, int kbps, VideoEncoder* used,
+              std::string* sdp) {
+        width = w;
+        height = h;
+        stride = s;
+        dmabufInput = dmabuf;
+
+        std::vector<VideoEncoder> candidates;
+        if (cfg.encoder == VideoEncoder::Auto) {
+            candidates = {VideoEncoder::RkHw, VideoEncoder::Nvenc, VideoEncoder::SwFfmpeg};
+        } else {
+            candidates = {cfg.encoder};
+            if (cfg.encoder != VideoEncoder::SwFfmpeg) candidates.push_back(VideoEncoder::SwFfmpeg);
+        }
+        for (VideoEncoder k : candidates) {
+            const AVCodec* encoder = avcodec_find_encoder_by_name(encoderName(cfg.codec, k));
+            if (!encoder && k == VideoEncoder::SwFfmpeg) {
+                encoder = avcodec_find_encoder(cfg.codec == VideoCodec::H265 ? AV_CODEC_ID_HEVC : AV_CODEC_ID_H264);
+            }
+            if (!encoder) continue;
+            // 只有 MPP 直接导入 DMABUF；NVENC / 软件编码读取缓冲池的系统内存
+            if (k == VideoEncoder::RkHw && dmabuf && openEncoder(encoder, k, cfg, kbps, true)) break;
+            if (openEncoder(encoder, k, cfg, kbps, false)) break;
+        }
+        if (!codec) {
+            FM_LOG_ERROR("VideoUplink", "no ", videoCodecName(cfg.codec), " encoder available");
+            close();
+            return false;
+        }
+        if (cfg.encoder != VideoEncoder::Auto && kind != cfg.encoder) {
+            FM_LOG_WARN("VideoUplink", videoEncoderName(cfg.encoder), " encoder unavailable, using ",
+                        videoEncoderName(kind));
+        }
+        packet = av_packet_alloc();
+        if (!packet || !openOutput(cfg, sdp)) {
+            close();
+            return false;
+        }
+        firstCaptureNs = -1;
+        lastPts = -1;
+        *used = kind;
+        return true;
+    }
+
+    void close() {
+        if (output) {
+            if (headerWritten) av_write_trailer(output);
+            if (!(output->oformat->flags & AVFMT_NOFILE)) avio_closep(&output->pb);
+            avformat_free_context(output);
+            output = nullptr;
+        }
+        stream = nullptr;
+        headerWritten = false;
+        if (packet) av_packet_free(&packet);
+        if (codec) avcodec_free_context(&codec);
+        if (hwFrames) av_buffer_unref(&hwFrames);
+        if (hwDevice) av_buffer_unref(&hwDevice);
+        drmPrime = false;
+    }
+
+    void setBitrate(int kbps, int fps) {
+        // libx264 / NVENC 在下一帧按新码率重配置（无需重建编码器）
+        if (codec) applyBitrate(codec, kbps, fps);
+    }
+
+    // 帧缓冲直接作为 AVFrame 的数据：AVBufferRef 持有一份 BufferRef，编码器用完后归还缓冲池
+    AVFrame* wrap(const BufferRef& buffer, std::int64_t captureNs) {
+        AVFrame* frame = av_frame_alloc();
+        if (!frame) return nullptr;
+        frame->width = width;
+        frame->height = height;
+        if (firstCaptureNs < 0) firstCaptureNs = captureNs;
+        std::int64_t pts = av_rescale_q(captureNs - firstCaptureNs, AVRational{1, 1'000'000'000}, kStreamTimeBase);
+        if (pts <= lastPts) pts = lastPts + 1;
+        frame->pts = lastPts = pts;
+
+        if (drmPrime) {
+            auto* holder = new DrmFrameHolder();
+            holder->frame = buffer;
+            AVDRMFrameDescriptor& desc = holder->desc;
+            desc.nb_objects = 1;
+            desc.objects[0].fd = buffer.meta().dmabufFd;
+            desc.objects[0].size = static_cast<std::size_t>(stride) * (height + (height + 1) / 2);
+            desc.objects[0].format_modifier = 0;  // DRM_FORMAT_MOD_LINEAR
+            desc.nb_layers = 1;
+            desc.layers[0].format = kDrmFormatNv12;
+            desc.layers[0].nb_planes = 2;
+            desc.layers[0].planes[0] = {0, 0, stride};
+            desc.layers[0].planes[1] = {0, static_cast<std::ptrdiff_t>(stride) * height, stride};
+            frame->format = AV_PIX_FMT_DRM_PRIME;
+            frame->data[0] = reinterpret_cast<std::uint8_t*>(&desc);
+            frame->buf[0] = av_buffer_create(reinterpret_cast<std::uint8_t*>(&desc), sizeof(desc), releaseDrmFrame,
+                                             holder, 0);
+            frame->hw_frames_ctx = av_buffer_ref(hwFrames);
+            if (!frame->buf[0]) delete holder;
+        } else {
+            auto* holder = new BufferRef(buffer);
+            auto* y = const_cast<std::uint8_t*>(buffer.data()) + sizeof(CameraFramePacket);
+            frame->format = AV_PIX_FMT_NV12;
+            frame->data[0] = y;
+            frame->data[1] = y + static_cast<std::size_t>(stride) * height;
+            frame->linesize[0] = stride;
+            frame->linesize[1] = stride;
+            frame->buf[0] = av_buffer_create(const_cast<std::uint8_t*>(buffer.data()), buffer.size(), releaseFrameRef,
+                                             holder, AV_BUFFER_FLAG_READONLY);
+            if (!frame->buf[0]) delete holder;
+        }
+        if (!frame->buf[0]) av_frame_free(&frame);
+        return frame;
+    }
+
+    // 在访问单元开头的 AUD 之后（无 AUD 时在最前）插入 SEI：只移动编码后的码流
+    void injectSei(VideoCodec codecType, const OverlayMetadata& overlay) {
+        sei.clear();
+        appendOverlaySei(codecType, overlay, sei);
+        std::size_t codeLen = 0;
+        std::size_t insertAt = 0;
+        const std::size_t first = findStartCode(packet->data, static_cast<std::size_t>(packet->size), 0, &codeLen);
+        const int aud = codecType == VideoCodec::H265 ? kH265NalAud : kH264NalAud;
+        if (first == 0 && codeLen > 0 && static_cast<std::size_t>(packet->size) > codeLen &&
+            nalType(codecType, packet->data[codeLen]) == aud) {
+            insertAt = findStartCode(packet->data, static_cast<std::size_t>(packet->size), codeLen, nullptr);
+        }
+        const std::size_t tail = static_cast<std::size_t>(packet->size) - insertAt;
+        if (av_grow_packet(packet, static_cast<int>(sei.size())) < 0) return;
+        std::memmove(packet->data + insertAt + sei.size(), packet->data + insertAt, tail);
+        std::memcpy(packet->data + insertAt, sei.data(), sei.size());
+    }
+
+    // 编码一帧（取得 frame 的所有权）并写出全部输出包
+    EncodeResult encode(AVFrame* frame, const VideoUplinkConfig& cfg, const OverlayMetadata* overlay) {
+        EncodeResult result;
+        int err = avcodec_send_frame(codec, frame);
+        av_frame_free(&frame);
+        if (err < 0) {
+            result.encodeError = true;
+            return result;
+        }
+        const std::int64_t frameNs = 1'000'000'000LL / std::max(1, cfg.fps);
+        while ((err = avcodec_receive_packet(codec, packet)) == 0) {
+            ++result.encoded;
+            if (overlay) {
+                injectSei(cfg.codec, *overlay);
+                ++result.seiFrames;
+            }
+            av_packet_rescale_ts(packet, codec->time_base, stream->time_base);
+            packet->stream_index = stream->index;
+            const std::uint64_t bytes = static_cast<std::uint64_t>(packet->size);
+            const std::int64_t t0 = PipelineClock::nowNs();
+            armTimeout(cfg.timeoutMs);
+            err = av_write_frame(output, packet);
+            av_packet_unref(packet);
+            if (err < 0) {
+                result.sendError = true;
+                result.congested = true;
+                continue;
+            }
+            ++result.packets;
+            result.bytes += bytes;
+            // 发送耗时超过一帧间隔说明套接字缓冲已满，链路跟不上当前码率
+            if (PipelineClock::nowNs() - t0 > frameNs) result.congested = true;
+        }
+        if (err != AVERROR(EAGAIN) && err != AVERROR_EOF) result.encodeError = true;
+        return result;
+    }
+};
+
+#else
+
+struct VideoUplink::Backend {};
+
+#endif
+
+// ---------------------------------------------------------------------------
+// VideoUplink
+
+VideoUplink::VideoUplink(const VideoUplinkConfig& cfg) : cfg_(cfg), controller_(cfg.bitrate) {
+    cfg_.fps = std::max(1, cfg_.fps);
+    cfg_.gopFrames = std::max(1, cfg_.gopFrames);
+}
+
+VideoUplink::~VideoUplink() {
+    stop();
+}
+
+bool VideoUplink::start() {
+    if (running_.load()) return true;
+    if (!startsWith(cfg_.uri, "rtp://") && !startsWith(cfg_.uri, "srt://")) {
+        FM_LOG_ERROR("VideoUplink", "uri must be rtp:// or srt://: ", cfg_.uri);
+        return false;
+    }
+#ifdef FALCONMINDSDK_VIDEO_UPLINK_ENABLED
+    backend_ = std::make_unique<Backend>();
+    backend_->running = &running_;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_ = VideoUplinkStats{};
+        controller_ = VideoBitrateController(cfg_.bitrate);
+        sdp_.clear();
+    }
+    running_.store(true);
+    thread_ = std::thread(&VideoUplink::encodeLoop, this);
+    FM_LOG_INFO("VideoUplink", cfg_.uri, " started: ", videoCodecName(cfg_.codec), " encoder=",
+                videoEncoderName(cfg_.encoder), " ", controller_.targetKbps(), " kbps");
+    return true;
+#else
+    FM_LOG_ERROR("VideoUplink", cfg_.uri, ": built without FFmpeg (enable FALCONMINDSDK_BUILD_VIDEO_UPLINK)");
+    return false;
+#endif
+}
+
+void VideoUplink::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_.exchange(false)) return;
+        pending_.reset();
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+    backend_.reset();
+}
+
+void VideoUplink::submit(BufferRef frame, const OverlayMetadata* overlay) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_.load(std::memory_order_relaxed)) return;
+        ++stats_.submittedFrames;
+        if (pending_) {
+            // 编码跟不上输入：只保留最新一帧，并让码率控制退避
+            ++stats_.droppedFrames;
+            controller_.onCongestion();
+        }
+        pending_ = std::move(frame);
+        pendingHasOverlay_ = overlay != nullptr;
+        if (overlay) {
+            pendingOverlay_.frameIndex = overlay->frameIndex;
+            pendingOverlay_.captureNs = overlay->captureNs;
+            pendingOverlay_.boxes.assign(overlay->boxes.begin(), overlay->boxes.end());
+        }
+    }
+    cv_.notify_one();
+}
+
+void VideoUplink::setLinkQuality(double quality) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    controller_.setLinkQuality(quality);
+}
+
+std::string VideoUplink::sdp() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sdp_;
+}
+
+VideoUplinkStats VideoUplink::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    VideoUplinkStats s = stats_;
+    s.targetKbps = controller_.targetKbps();
+    return s;
+}
+
+void VideoUplink::encodeLoop() {
+#ifdef FALCONMINDSDK_VIDEO_UPLINK_ENABLED
+    Backend& b = *backend_;
+    OverlayMetadata overlay;
+    while (true) {
+        BufferRef frame;
+        bool hasOverlay = false;
+        bool bitrateChanged = false;
+        int kbps = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return !running_.load(std::memory_order_relaxed) || pending_; });
+            if (!running_.load(std::memory_order_relaxed)) break;
+            frame = std::move(pending_);
+            pending_.reset();
+            hasOverlay = pendingHasOverlay_ && cfg_.overlaySei;
+            if (hasOverlay) std::swap(overlay, pendingOverlay_);
+            pendingHasOverlay_ = false;
+            bitrateChanged = controller_.update(PipelineClock::nowNs());
+            if (bitrateChanged) ++stats_.bitrateChanges;
+            kbps = controller_.targetKbps();
+        }
+
+        if (frame.size() < sizeof(CameraFramePacket)) continue;
+        const auto* header = reinterpret_cast<const CameraFramePacket*>(frame.data());
+        const PixelFormat format = frame.meta().video.format != PixelFormat::Any ? frame.meta().video.format
+                                                                                 : parsePixelFormat(header->format);
+        const int w = header->width & ~1;  // 4:2:0 编码要求偶数尺寸
+        const int h = header->height & ~1;
+        const int stride = header->stride > 0 ? header->stride : header->width;
+        const std::size_t rows = static_cast<std::size_t>(header->height) + (header->height + 1) / 2;
+        if (format != PixelFormat::NV12 || w <= 0 || h <= 0 ||
+            frame.size() < sizeof(CameraFramePacket) + static_cast<std::size_t>(stride) * rows) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stats_.encodeErrors++ == 0) FM_LOG_WARN("VideoUplink", "frames must be NV12 CameraFramePacket");
+            continue;
+        }
+        const bool dmabuf = frame.meta().dmabufFd >= 0;
+        const std::int64_t now = PipelineClock::nowNs();
+        if (!b.matches(w, h, stride, dmabuf)) {
+            if (now < b.retryAfterNs) continue;  // 上次打开失败：限速重试
+            const bool restart = b.codec != nullptr;
+            b.close();
+            VideoEncoder used = VideoEncoder::SwFfmpeg;
+            std::string sdp;
+            if (!b.open(cfg_, w, h, stride, dmabuf, kbps, &used, &sdp)) {
+                b.retryAfterNs = now + 1'000'000'000LL;
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.encodeErrors;
+                continue;
+            }
+            activeEncoder_.store(used, std::memory_order_relaxed);
+            FM_LOG_INFO("VideoUplink", cfg_.uri, " encoding ", w, "x", h, " with ", videoEncoderName(used),
+                        b.drmPrime ? " (DMABUF import)" : "", ", ", kbps, " kbps");
+            std::lock_guard<std::mutex> lock(mutex_);
+            sdp_ = std::move(sdp);
+            if (restart) ++stats_.encoderRestarts;
+        } else if (bitrateChanged) {
+            b.setBitrate(kbps, cfg_.fps);
+        }
+
+        const std::int64_t captureNs = header->captureTimestampNs != 0 ? header->captureTimestampNs
+                                       : frame.meta().timestampNs != 0 ? frame.meta().timestampNs
+                                                                       : now;
+        AVFrame* avFrame = b.wrap(frame, captureNs);
+        frame.reset();
+        if (!avFrame) continue;
+        const Backend::EncodeResult r = b.encode(avFrame, cfg_, hasOverlay ? &overlay : nullptr);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.encodedFrames += r.encoded;
+        stats_.sentPackets += r.packets;
+        stats_.sentBytes += r.bytes;
+        stats_.seiFrames += r.seiFrames;
+        if (r.encodeError) ++stats_.encodeErrors;
+        if (r.sendError) ++stats_.sendErrors;
+        if (r.congested) controller_.onCongestion();
+    }
+#endif
+}
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,173 @@
+#include "falconmind/sdk/sensors/VideoUplinkNode.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/telemetry/TelemetryPublisher.h"
+
+#include <stdexcept>
+
+namespace falconmind::sdk::sensors {
+
+using namespace falconmind::sdk::core;
+
+namespace {
+
+// 超过该时长未更新的检测结果不再写入 SEI（检测停止后地面端不再显示残留框）
+constexpr std::int64_t kStaleDetectionNs = 1'000'000'000;
+
+std::int64_t frameCaptureNs(const BufferRef& frame) {
+    const auto* header = reinterpret_cast<const CameraFramePacket*>(frame.data());
+    return header->captureTimestampNs != 0 ? header->captureTimestampNs : frame.meta().timestampNs;
+}
+
+} // namespace
+
+VideoUplinkNode::VideoUplinkNode() : Node("video_uplink") {
+    auto in = std::make_shared<Pad>("video_in", PadType::Sink);
+    Caps caps;
+    caps.addVideo(VideoCaps{PixelFormat::NV12, 0, 0, 0});
+    in->setCaps(caps);
+    videoPad_ = addPad(in);
+    detectionPad_ = addPad(std::make_shared<Pad>("detection_in", PadType::Sink));
+}
+
+VideoUplinkNode::~VideoUplinkNode() {
+    stop();
+}
+
+bool VideoUplinkNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    auto intParam = [&](const char* key, int& out) {
+        auto it = params.find(key);
+        if (it == params.end()) return true;
+        try {
+            const int v = std::stoi(it->second);
+            if (v < 0) throw std::invalid_argument(key);
+            out = v;
+            return true;
+        } catch (const std::exception&) {
+            FM_LOG_ERROR("VideoUplinkNode", "invalid ", key, ": ", it->second);
+            return false;
+        }
+    };
+    int syncWindowMs = static_cast<int>(syncWindowNs_ / 1'000'000);
+    if (!intParam("fps", cfg_.fps) || !intParam("gop", cfg_.gopFrames) ||
+        !intParam("bitrate_kbps", cfg_.bitrate.startKbps) || !intParam("min_bitrate_kbps", cfg_.bitrate.minKbps) ||
+        !intParam("max_bitrate_kbps", cfg_.bitrate.maxKbps) || !intParam("sync_window_ms", syncWindowMs) ||
+        !intParam("srt_latency_ms", cfg_.srtLatencyMs)) {
+        return false;
+    }
+    syncWindowNs_ = static_cast<std::int64_t>(syncWindowMs) * 1'000'000;
+    auto it = params.find("uri");
+    if (it != params.end()) cfg_.uri = it->second;
+    it = params.find("codec");
+    if (it != params.end()) cfg_.codec = parseVideoCodec(it->second);
+    it = params.find("encoder");
+    if (it != params.end()) cfg_.encoder = parseVideoEncoder(it->second);
+    it = params.find("overlay");
+    if (it != params.end()) cfg_.overlaySei = !(it->second == "false" || it->second == "0" || it->second == "off");
+    it = params.find("uav_id");
+    if (it != params.end()) uavId_ = it->second;
+    return true;
+}
+
+bool VideoUplinkNode::start() {
+    stop();
+    auto uplink = std::make_shared<VideoUplink>(cfg_);
+    if (!uplink->start()) return false;
+    uplink_ = uplink;
+
+    if (videoPad_) {
+        videoPad_->setBufferCallback([this](const BufferRef& frame) {
+            if (frame.size() < sizeof(CameraFramePacket)) return;
+            std::lock_guard<std::mutex> lock(mutex_);
+            frames_.push_back(frame);
+            if (frames_.size() > kMaxHeldFrames) frames_.pop_front();  // process 跟不上：丢最旧帧
+        });
+    }
+    if (detectionPad_) {
+        detectionPad_->setDataCallback([this](const void* data, std::size_t size) {
+            perception::DetectionResultView view(data, size);
+            if (!view.valid()) return;
+            const auto* bytes = static_cast<const std::uint8_t*>(data);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (detections_.size() >= kRecentDetections) {
+                spare_.push_back(std::move(detections_.front().bytes));
+                detections_.pop_front();
+            }
+            DetectionPacket packet;
+            packet.captureNs = static_cast<std::int64_t>(view.timestampNs());
+            if (!spare_.empty()) {
+                packet.bytes = std::move(spare_.back());
+                spare_.pop_back();
+            }
+            packet.bytes.assign(bytes, bytes + size);
+            detections_.push_back(std::move(packet));
+        });
+    }
+    auto onTelemetry = [uplink](const telemetry::TelemetryMessage& msg) { uplink->setLinkQuality(msg.linkQuality); };
+    auto& publisher = telemetry::TelemetryPublisher::instance();
+    telemetrySubId_ = uavId_.empty() ? publisher.subscribe(onTelemetry) : publisher.subscribe(uavId_, onTelemetry);
+    return true;
+}
+
+void VideoUplinkNode::stop() {
+    if (telemetrySubId_ > 0) {
+        telemetry::TelemetryPublisher::instance().unsubscribe(telemetrySubId_);
+        telemetrySubId_ = 0;
+    }
+    if (uplink_) {
+        uplink_->stop();
+        uplink_.reset();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    frames_.clear();
+    detections_.clear();
+}
+
+VideoUplinkStats VideoUplinkNode::stats() const {
+    return uplink_ ? uplink_->stats() : VideoUplinkStats{};
+}
+
+std::string VideoUplinkNode::sdp() const {
+    return uplink_ ? uplink_->sdp() : std::string();
+}
+
+void VideoUplinkNode::process() {
+    if (!uplink_) return;
+    const std::int64_t now = PipelineClock::nowNs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!frames_.empty()) {
+        const std::int64_t captureNs = frameCaptureNs(frames_.front());
+        const DetectionPacket* match = nullptr;
+        for (auto it = detections_.rbegin(); it != detections_.rend(); ++it) {
+            if (captureNs != 0 && it->captureNs == captureNs) {
+                match = &*it;
+                break;
+            }
+        }
+        const bool expired = syncWindowNs_ <= 0 || captureNs == 0 || now - captureNs >= syncWindowNs_ ||
+                             frames_.size() >= kMaxHeldFrames;
+        if (!match && !expired) break;  // 继续等待本帧的检测结果
+        if (!match && !detections_.empty() && captureNs - detections_.back().captureNs < kStaleDetectionNs) {
+            match = &detections_.back();
+        }
+        submitFrame(std::move(frames_.front()), match);
+        frames_.pop_front();
+    }
+}
+
+void VideoUplinkNode::submitFrame(BufferRef frame, const DetectionPacket* dets) {
+    if (dets && cfg_.overlaySei) {
+        perception::DetectionResultView view(dets->bytes.data(), dets->bytes.size());
+        if (view.valid()) {
+            const auto* header = reinterpret_cast<const CameraFramePacket*>(frame.data());
+            overlayFromDetections(view, header->width, header->height, overlay_);
+            uplink_->submit(std::move(frame), &overlay_);
+            return;
+        }
+    }
+    uplink_->submit(std::move(frame), nullptr);
+}
+
+} // namespace falconmind::sdk::sensors
@@ -0,0 +1,181 @@
+#include "falconmind/sdk/sensors/ImageTransform.h"
+
+#include <algorithm>
+#include <iostream>
+
+#if defined(FALCONMINDSDK_VPI_ENABLED)
+#include <vpi/Image.h>
+#include <vpi/Status.h>
+#include <vpi/Stream.h>
+#include <vpi/algo/ConvertImageFormat.h>
+#include <vpi/algo/Rescale.h>
+#endif
+
+namespace falconmind::sdk::sensors {
+
+using core::PixelFormat;
+
+bool VpiImageTransform::supports(PixelFormat from, PixelFormat to, ImageRotation rotation) const noexcept {
+    const bool src = from == PixelFormat::RGB8 || from == PixelFormat::BGR8 || from == PixelFormat::NV12;
+    const bool dst = to == PixelFormat::RGB8 || to == PixelFormat::BGR8 || to == PixelFormat::NV12;
+    return src && dst && rotation == ImageRotation::None;
+}
+
+#if defined(FALCONMINDSDK_VPI_ENABLED)
+
+namespace {
+
+VPIImageFormat vpiFormat(PixelFormat f) {
+    switch (f) {
+        case PixelFormat::RGB8: return VPI_IMAGE_FORMAT_RGB8;
+        case PixelFormat::BGR8: return VPI_IMAGE_FORMAT_BGR8;
+        case PixelFormat::NV12: return VPI_IMAGE_FORMAT_NV12_ER;
+        default: return VPI_IMAGE_FORMAT_INVALID;
+    }
+}
+
+// 主机内存（pitch linear）描述；NV12 的 UV 平面紧随 Y 平面
+VPIImageData hostImageData(std::uint8_t* data, int width, int height, int stride, PixelFormat format) {
+    VPIImageData d{};
+    d.bufferType = VPI_IMAGE_BUFFER_HOST_PITCH_LINEAR;
+    d.buffer.pitch.format = vpiFormat(format);
+    const int pitch = stride > 0 ? stride : core::pixelFormatMinStride(format, width);
+    if (format == PixelFormat::NV12) {
+        d.buffer.pitch.numPlanes = 2;
+        d.buffer.pitch.planes[0].pixelType = VPI_PIXEL_TYPE_U8;
+        d.buffer.pitch.planes[0].width = width;
+        d.buffer.pitch.planes[0].height = height;
+        d.buffer.pitch.planes[0].pitchBytes = pitch;
+        d.buffer.pitch.planes[0].data = data;
+        d.buffer.pitch.planes[1].pixelType = VPI_PIXEL_TYPE_2U8;
+        d.buffer.pitch.planes[1].width = (width + 1) / 2;
+        d.buffer.pitch.planes[1].height = (height + 1) / 2;
+        d.buffer.pitch.planes[1].pitchBytes = pitch;
+        d.buffer.pitch.planes[1].data = data + static_cast<std::size_t>(pitch) * height;
+    } else {
+        d.buffer.pitch.numPlanes = 1;
+        d.buffer.pitch.planes[0].pixelType = VPI_PIXEL_TYPE_3U8;
+        d.buffer.pitch.planes[0].width = width;
+        d.buffer.pitch.planes[0].height = height;
+        d.buffer.pitch.planes[0].pitchBytes = pitch;
+        d.buffer.pitch.planes[0].data = data;
+    }
+    return d;
+}
+
+constexpr std::uint64_t kBackends = VPI_BACKEND_CUDA | VPI_BACKEND_VIC | VPI_BACKEND_CPU;
+
+} // namespace
+
+struct VpiImageTransform::Impl {
+    VPIStream stream{nullptr};
+    VPIImage scaled{nullptr};  // 源格式、目标尺寸的中间图（格式与目标不同时使用）
+    int scaledW{0}, scaledH{0};
+    PixelFormat scaledFormat{PixelFormat::Any};
+
+    ~Impl() {
+        if (scaled) vpiImageDestroy(scaled);
+        if (stream) vpiStreamDestroy(stream);
+    }
+};
+
+VpiImageTransform::VpiImageTransform() : impl_(std::make_unique<Impl>()) {
+    if (vpiStreamCreate(kBackends, &impl_->stream) != VPI_SUCCESS) {
+        std::cerr << "[VpiImageTransform] vpiStreamCreate failed" << std::endl;
+        impl_->stream = nullptr;
+    }
+}
+
+VpiImageTransform::~VpiImageTransform() = default;
+
+bool VpiImageTransform::available() {
+    VPIStream stream = nullptr;
+    if (vpiStreamCreate(kBackends, &stream) != VPI_SUCCESS) return false;
+    vpiStreamDestroy(stream);
+    return true;
+}
+
+bool VpiImageTransform::transform(const ImageSurface& src, const ImageTransformOp& op, WritableImageSurface& dst) {
+    if (!impl_->stream || !src.data || !dst.data || src.width <= 0 || src.height <= 0 || dst.width <= 0 ||
+        dst.height <= 0 || !supports(src.format, dst.format, op.rotation)) {
+        return false;
+    }
+    // 裁剪：pitch linear 主机内存直接偏移起点（NV12 对齐到偶数，两个平面同步偏移）
+    const int srcStride = src.stride > 0 ? src.stride : core::pixelFormatMinStride(src.format, src.width);
+    int cx = std::clamp(op.crop.x, 0, src.width - 1);
+    int cy = std::clamp(op.crop.y, 0, src.height - 1);
+    const bool nv12 = src.format == PixelFormat::NV12;
+    if (nv12) {
+        cx &= ~1;
+        cy &= ~1;
+    }
+    const int cw = std::min(op.crop.width > 0 ? op.crop.width : src.width - cx, src.width - cx);
+    const int ch = std::min(op.crop.height > 0 ? op.crop.height : src.height - cy, src.height - cy);
+    auto* base = const_cast<std::uint8_t*>(src.data);
+    VPIImageData inData = hostImageData(base + static_cast<std::size_t>(cy) * srcStride +
+                                            static_cast<std::size_t>(cx) * (nv12 ? 1 : 3),
+                                        cw, ch, srcStride, src.format);
+    if (nv12) {
+        inData.buffer.pitch.planes[1].data = base + static_cast<std::size_t>(srcStride) * src.height +
+                                             static_cast<std::size_t>(cy / 2) * srcStride + cx;
+    }
+    VPIImageData outData = hostImageData(dst.data, dst.width, dst.height, dst.stride, dst.format);
+
+    VPIImage in = nullptr;
+    VPIImage out = nullptr;
+    VPIStatus st = vpiImageCreateWrapper(&inData, nullptr, kBackends, &in);
+    if (st == VPI_SUCCESS) st = vpiImageCreateWrapper(&outData, nullptr, kBackends, &out);
+
+    const bool sameSize = cw == dst.width && ch == dst.height;
+    const bool sameFormat = src.format == dst.format;
+    if (st == VPI_SUCCESS && !sameSize && !sameFormat &&
+        (!impl_->scaled || impl_->scaledW != dst.width || impl_->scaledH != dst.height ||
+         impl_->scaledFormat != src.format)) {
+        if (impl_->scaled) vpiImageDestroy(impl_->scaled);
+        impl_->scaled = nullptr;
+        st = vpiImageCreate(dst.width, dst.height, vpiFormat(src.format), kBackends, &impl_->scaled);
+        impl_->scaledW = dst.width;
+        impl_->scaledH = dst.height;
+        impl_->scaledFormat = src.format;
+    }
+    if (st == VPI_SUCCESS) {
+        if (sameFormat) {
+            st = vpiSubmitRescale(impl_->stream, VPI_BACKEND_VIC, in, out, VPI_INTERP_LINEAR, VPI_BORDER_CLAMP, 0);
+        } else if (sameSize) {
+            st = vpiSubmitConvertImageFormat(impl_->stream, VPI_BACKEND_CUDA, in, out, nullptr);
+        } else {
+            // VIC 缩放保持源格式，CUDA 再转换到目标格式
+            st = vpiSubmitRescale(impl_->stream, VPI_BACKEND_VIC, in, impl_->scaled, VPI_INTERP_LINEAR,
+                                  VPI_BORDER_CLAMP, 0);
+            if (st == VPI_SUCCESS) {
+                st = vpiSubmitConvertImageFormat(impl_->stream, VPI_BACKEND_CUDA, impl_->scaled, out, nullptr);
+            }
+        }
+    }
+    if (st == VPI_SUCCESS) st = vpiStreamSync(impl_->stream);
+    if (in) vpiImageDestroy(in);
+    if (out) vpiImageDestroy(out);
+    if (st != VPI_SUCCESS) {
+        std::cerr << "[VpiImageTransform] " << vpiStatusGetName(st) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#else
+
+struct VpiImageTransform::Impl {};
+
+VpiImageTransform::VpiImageTransform() : impl_(std::make_unique<Impl>()) {}
+VpiImageTransform::~VpiImageTransform() = default;
+
+bool VpiImageTransform::available() { return false; }
+
+bool VpiImageTransform::transform(const ImageSurface&, const ImageTransformOp&, WritableImageSurface&) {
+    std::cerr << "[VpiImageTransform] built without FALCONMINDSDK_BUILD_VPI" << std::endl;
+    return false;
+}
+
+#endif
+
+} // namespace falconmind::sdk::sensors
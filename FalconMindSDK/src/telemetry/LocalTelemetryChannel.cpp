@@ -0,0 +1,357 @@
+#include "falconmind/sdk/telemetry/LocalTelemetryChannel.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/SeqLock.h"
+#include "falconmind/sdk/perception/DetectionResultPacket.h"
+#include "falconmind/sdk/telemetry/TelemetryPublisher.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace falconmind::sdk::telemetry {
+
+namespace {
+
+constexpr std::uint32_t kTelemetryShmMagic = 0x544C4D46;  // "FMLT"
+constexpr std::uint32_t kTelemetryShmVersion = 1;
+constexpr std::size_t kAlign = 64;
+
+using EventSlot = core::SeqLock<LocalDetectionEvent>;
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "shm atomics must be address-free");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shm atomics must be address-free");
+
+// 写端与读端各占不同缓存行：state 由遥测线程更新，head 由检测线程更新，读端只读
+struct alignas(kAlign) TelemetryShmHeader {
+    std::atomic<std::uint32_t> magic;  // 初始化完成后最后写入
+    std::uint32_t version;
+    std::uint32_t eventCapacity;
+    std::uint32_t stateSize;
+    std::uint32_t eventStride;
+    std::atomic<std::uint32_t> closed;
+
+    alignas(kAlign) core::SeqLock<LocalFlightState> state;
+    alignas(kAlign) std::atomic<std::uint64_t> head;
+};
+
+std::size_t alignUp(std::size_t v) {
+    return (v + kAlign - 1) / kAlign * kAlign;
+}
+
+std::size_t roundUpPow2(std::size_t n) {
+    std::size_t p = 2;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+std::string shmPath(const std::string& name) {
+    return "/" + name;
+}
+
+bool validName(const std::string& name) {
+    return !name.empty() && name.size() < NAME_MAX && name.find('/') == std::string::npos;
+}
+
+template <std::size_t N>
+void copyText(char (&dst)[N], const char* src, std::size_t len) noexcept {
+    const std::size_t n = std::min(len, N - 1);
+    std::memcpy(dst, src, n);
+    std::memset(dst + n, 0, N - n);
+}
+
+} // namespace
+
+LocalFlightState toLocalFlightState(const TelemetryMessage& msg) noexcept {
+    LocalFlightState s;
+    s.timestampNs = msg.timestampNs;
+    s.lat = msg.lat;
+    s.lon = msg.lon;
+    s.alt = msg.alt;
+    s.roll = msg.roll;
+    s.pitch = msg.pitch;
+    s.yaw = msg.yaw;
+    s.vx = msg.vx;
+    s.vy = msg.vy;
+    s.vz = msg.vz;
+    s.batteryPercent = msg.batteryPercent;
+    s.linkQuality = msg.linkQuality;
+    s.batteryVoltageMv = msg.batteryVoltageMv;
+    s.gpsFixType = msg.gpsFixType;
+    s.numSat = msg.numSat;
+    copyText(s.flightMode, msg.flightMode.data(), msg.flightMode.size());
+    copyText(s.uavId, msg.uavId.data(), msg.uavId.size());
+    return s;
+}
+
+struct LocalTelemetryWriter::Mapping {
+    void* base{MAP_FAILED};
+    std::size_t length{0};
+    core::SeqLockRing<LocalDetectionEvent> ring;
+
+    ~Mapping() {
+        if (base != MAP_FAILED) munmap(base, length);
+    }
+
+    TelemetryShmHeader* header() const { return static_cast<TelemetryShmHeader*>(base); }
+    EventSlot* slots() const {
+        return reinterpret_cast<EventSlot*>(static_cast<std::uint8_t*>(base) + alignUp(sizeof(TelemetryShmHeader)));
+    }
+    void bindRing() {
+        ring = core::SeqLockRing<LocalDetectionEvent>(slots(), &header()->head, header()->eventCapacity);
+    }
+};
+
+LocalTelemetryWriter::LocalTelemetryWriter(std::string name, std::shared_ptr<Mapping> mapping)
+    : name_(std::move(name)), mapping_(std::move(mapping)) {}
+
+LocalTelemetryWriter::~LocalTelemetryWriter() {
+    if (mapping_) {
+        mapping_->header()->closed.store(1, std::memory_order_release);
+        shm_unlink(shmPath(name_).c_str());
+    }
+}
+
+std::shared_ptr<LocalTelemetryWriter> LocalTelemetryWriter::create(const std::string& name,
+                                                                   std::size_t eventCapacity) {
+    if (!validName(name) || eventCapacity == 0 || eventCapacity > (1u << 20)) {
+        std::cerr << "[LocalTelemetryWriter] Invalid channel config: " << name << std::endl;
+        return nullptr;
+    }
+    const std::size_t capacity = roundUpPow2(eventCapacity);
+    std::string path = shmPath(name);
+    shm_unlink(path.c_str());  // 上次异常退出的残留
+    int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+    if (fd < 0) {
+        std::cerr << "[LocalTelemetryWriter] shm_open failed: " << path << ": " << std::strerror(errno) << std::endl;
+        return nullptr;
+    }
+    const std::size_t length = alignUp(sizeof(TelemetryShmHeader)) + sizeof(EventSlot) * capacity;
+    if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+        std::cerr << "[LocalTelemetryWriter] ftruncate failed: " << path << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        shm_unlink(path.c_str());
+        return nullptr;
+    }
+    auto mapping = std::make_shared<Mapping>();
+    mapping->base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    mapping->length = length;
+    close(fd);
+    if (mapping->base == MAP_FAILED) {
+        std::cerr << "[LocalTelemetryWriter] mmap failed: " << path << ": " << std::strerror(errno) << std::endl;
+        shm_unlink(path.c_str());
+        return nullptr;
+    }
+
+    // ftruncate 后内容为零；在映射上构造原子对象
+    auto* h = new (mapping->base) TelemetryShmHeader();
+    h->version = kTelemetryShmVersion;
+    h->eventCapacity = static_cast<std::uint32_t>(capacity);
+    h->stateSize = static_cast<std::uint32_t>(sizeof(LocalFlightState));
+    h->eventStride = static_cast<std::uint32_t>(sizeof(EventSlot));
+    h->head.store(0, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < capacity; ++i) {
+        new (mapping->slots() + i) EventSlot();
+    }
+    mapping->bindRing();
+    h->magic.store(kTelemetryShmMagic, std::memory_order_release);
+    return std::shared_ptr<LocalTelemetryWriter>(new LocalTelemetryWriter(name, std::move(mapping)));
+}
+
+void LocalTelemetryWriter::publishState(const LocalFlightState& state) noexcept {
+    mapping_->header()->state.store(state);
+}
+
+void LocalTelemetryWriter::publishEvent(const LocalDetectionEvent& event) noexcept {
+    LocalDetectionEvent e = event;
+    e.sequence = mapping_->ring.count();
+    mapping_->ring.push(e);
+}
+
+std::size_t LocalTelemetryWriter::publishDetections(const void* packet, std::size_t size) noexcept {
+    perception::DetectionResultView view;
+    if (!view.parse(packet, size)) return 0;
+    std::uint32_t flags = 0;
+    if (view.overLatencyBudget()) flags |= perception::DETECTION_RESULT_FLAG_OVER_LATENCY_BUDGET;
+    if (view.trackerPredicted()) flags |= perception::DETECTION_RESULT_FLAG_TRACKER_PREDICTED;
+    LocalDetectionEvent e;
+    e.timestampNs = view.timestampNs();
+    e.frameIndex = view.frameIndex();
+    e.flags = flags;
+    for (std::size_t i = 0; i < view.size(); ++i) {
+        const auto box = view.bbox(i);
+        e.classId = view.classId(i);
+        e.trackId = view.trackId(i);
+        e.score = view.score(i);
+        e.x = box.x;
+        e.y = box.y;
+        e.width = box.width;
+        e.height = box.height;
+        const std::string_view name = view.className(i);
+        copyText(e.className, name.data(), name.size());
+        publishEvent(e);
+    }
+    return view.size();
+}
+
+std::uint64_t LocalTelemetryWriter::statesPublished() const noexcept {
+    return mapping_->header()->state.version();
+}
+
+std::uint64_t LocalTelemetryWriter::eventsPublished() const noexcept {
+    return mapping_->ring.count();
+}
+
+LocalTelemetryReader::LocalTelemetryReader(std::string name, std::shared_ptr<LocalTelemetryWriter::Mapping> mapping)
+    : name_(std::move(name)), mapping_(std::move(mapping)) {}
+
+std::shared_ptr<LocalTelemetryReader> LocalTelemetryReader::open(const std::string& name) {
+    if (!validName(name)) {
+        return nullptr;
+    }
+    int fd = shm_open(shmPath(name).c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(TelemetryShmHeader)) {
+        close(fd);
+        return nullptr;
+    }
+    auto mapping = std::make_shared<LocalTelemetryWriter::Mapping>();
+    mapping->length = static_cast<std::size_t>(st.st_size);
+    // 读端也映射为可写：SeqLock 读取只做 load，但 std::atomic 不保证只读页上的语义
+    mapping->base = mmap(nullptr, mapping->length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping->base == MAP_FAILED) {
+        return nullptr;
+    }
+    auto* h = mapping->header();
+    const std::uint32_t cap = h->eventCapacity;
+    if (h->magic.load(std::memory_order_acquire) != kTelemetryShmMagic || h->version != kTelemetryShmVersion ||
+        cap < 2 || (cap & (cap - 1)) != 0 || h->stateSize != sizeof(LocalFlightState) ||
+        h->eventStride != sizeof(EventSlot) ||
+        alignUp(sizeof(TelemetryShmHeader)) + sizeof(EventSlot) * cap > mapping->length) {
+        std::cerr << "[LocalTelemetryReader] Channel not ready or incompatible: " << name << std::endl;
+        return nullptr;
+    }
+    mapping->bindRing();
+    return std::shared_ptr<LocalTelemetryReader>(new LocalTelemetryReader(name, std::move(mapping)));
+}
+
+bool LocalTelemetryReader::latestState(LocalFlightState& state) const noexcept {
+    const auto& slot = mapping_->header()->state;
+    if (slot.version() == 0) return false;
+    state = slot.load();
+    return true;
+}
+
+std::uint64_t LocalTelemetryReader::stateVersion() const noexcept {
+    return mapping_->header()->state.version();
+}
+
+std::size_t LocalTelemetryReader::pollEvents(std::uint64_t& cursor, LocalDetectionEvent* out, std::size_t maxCount,
+                                             std::uint64_t* dropped) const noexcept {
+    const auto& ring = mapping_->ring;
+    const std::uint64_t h = ring.count();
+    // 留一个槽位余量给正在写入的下一条（同 SeqLockRing::recent）
+    const std::uint64_t window = ring.capacity() - 1;
+    const std::uint64_t oldest = h > window ? h - window : 0;
+    std::uint64_t lost = 0;
+    if (cursor > h) cursor = h;  // 写端重建了通道
+    if (cursor < oldest) {
+        lost += oldest - cursor;
+        cursor = oldest;
+    }
+    std::size_t n = 0;
+    while (cursor < h && n < maxCount) {
+        LocalDetectionEvent e;
+        // 读取期间被绕圈覆盖的槽位序号不符，视为丢失
+        if (ring.at(h, static_cast<std::size_t>(h - 1 - cursor), e) && e.sequence == cursor) {
+            out[n++] = e;
+        } else {
+            ++lost;
+        }
+        ++cursor;
+    }
+    if (dropped) *dropped += lost;
+    return n;
+}
+
+bool LocalTelemetryReader::closed() const noexcept {
+    return mapping_->header()->closed.load(std::memory_order_acquire) != 0;
+}
+
+std::uint64_t LocalTelemetryReader::eventsPublished() const noexcept {
+    return mapping_->ring.count();
+}
+
+std::size_t LocalTelemetryReader::eventCapacity() const noexcept {
+    return mapping_->ring.capacity();
+}
+
+LocalTelemetryNode::LocalTelemetryNode() : core::Node("local_telemetry") {
+    addPad(std::make_shared<core::Pad>("detection_in", core::PadType::Sink))
+        ->setDataCallback([this](const void* data, std::size_t size) {
+            if (auto writer = std::atomic_load(&writer_)) writer->publishDetections(data, size);
+        });
+}
+
+LocalTelemetryNode::~LocalTelemetryNode() {
+    stop();
+}
+
+bool LocalTelemetryNode::configure(const std::unordered_map<std::string, std::string>& params) {
+    core::Node::configure(params);
+    auto it = params.find("channel");
+    if (it != params.end()) {
+        if (!validName(it->second)) {
+            std::cerr << "[LocalTelemetryNode] Invalid channel name: " << it->second << std::endl;
+            return false;
+        }
+        channel_ = it->second;
+    }
+    it = params.find("event_capacity");
+    if (it != params.end()) {
+        const long capacity = std::strtol(it->second.c_str(), nullptr, 10);
+        if (capacity <= 0) {
+            std::cerr << "[LocalTelemetryNode] Invalid event_capacity: " << it->second << std::endl;
+            return false;
+        }
+        eventCapacity_ = static_cast<std::size_t>(capacity);
+    }
+    it = params.find("uav_id");
+    if (it != params.end()) uavId_ = it->second;
+    return true;
+}
+
+bool LocalTelemetryNode::start() {
+    core::Node::start();
+    auto writer = LocalTelemetryWriter::create(channel_, eventCapacity_);
+    if (!writer) return false;
+    std::atomic_store(&writer_, writer);
+    auto onTelemetry = [writer](const TelemetryMessage& msg) { writer->publishState(msg); };
+    auto& publisher = TelemetryPublisher::instance();
+    telemetrySubId_ = uavId_.empty() ? publisher.subscribe(onTelemetry) : publisher.subscribe(uavId_, onTelemetry);
+    return true;
+}
+
+void LocalTelemetryNode::stop() {
+    if (telemetrySubId_ > 0) {
+        TelemetryPublisher::instance().unsubscribe(telemetrySubId_);
+        telemetrySubId_ = 0;
+    }
+    std::atomic_store(&writer_, std::shared_ptr<LocalTelemetryWriter>());
+    core::Node::stop();
+}
+
+} // namespace falconmind::sdk::telemetry
@@ -0,0 +1,81 @@
+#include "falconmind/sdk/telemetry/MetricsRollupPublisher.h"
+#include "falconmind/sdk/telemetry/TelemetryPublisher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace falconmind::sdk::telemetry {
+
+MetricsRollupPublisher::MetricsRollupPublisher(core::MetricsAggregator& aggregator, TelemetryPublisher& publisher,
+                                               std::string uavId, MetricsRollupConfig config)
+    : aggregator_(aggregator)
+    , publisher_(publisher)
+    , uavId_(std::move(uavId))
+    , config_(std::move(config)) {
+    config_.windowMs = std::max(config_.windowMs, 1);
+}
+
+MetricsRollupPublisher::~MetricsRollupPublisher() {
+    stop();
+}
+
+bool MetricsRollupPublisher::start() {
+    if (running_.exchange(true)) {
+        return false;
+    }
+    thread_ = std::thread(&MetricsRollupPublisher::run, this);
+    return true;
+}
+
+void MetricsRollupPublisher::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+    }
+    wakeCv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    flush();
+}
+
+bool MetricsRollupPublisher::flush() {
+    std::lock_guard<std::mutex> lock(flushMutex_);
+    const auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+    MetricsRollupMessage msg;
+    msg.uavId = uavId_;
+    msg.rollup = aggregator_.rollup(nowNs, config_.options);
+    if (msg.rollup.empty()) {
+        return false;
+    }
+    publisher_.publishRollup(msg);
+    published_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void MetricsRollupPublisher::run() {
+    const auto window = std::chrono::milliseconds(config_.windowMs);
+    auto deadline = std::chrono::steady_clock::now() + window;
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    while (running_.load()) {
+        if (wakeCv_.wait_until(lock, deadline, [this]() { return !running_.load(); })) {
+            break;
+        }
+        lock.unlock();
+        flush();
+        lock.lock();
+        deadline += window;
+        // 长时间挂起（如调试暂停）后不补发空窗口
+        const auto now = std::chrono::steady_clock::now();
+        if (deadline <= now) {
+            deadline = now + window;
+        }
+    }
+}
+
+} // namespace falconmind::sdk::telemetry
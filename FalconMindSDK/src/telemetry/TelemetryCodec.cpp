@@ -0,0 +1,407 @@
+#include "falconmind/sdk/telemetry/TelemetryCodec.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace falconmind::sdk::telemetry {
+
+namespace {
+
+// protobuf 线类型
+constexpr std::uint32_t kVarint = 0;
+constexpr std::uint32_t kFixed64 = 1;
+constexpr std::uint32_t kLengthDelimited = 2;
+constexpr std::uint32_t kFixed32 = 5;
+
+// 字段编号（proto/telemetry.proto）
+enum Field : std::uint32_t {
+    kUavId = 1,
+    kTimestampNs = 2,
+    kLat = 3,
+    kLon = 4,
+    kAlt = 5,
+    kRoll = 6,
+    kPitch = 7,
+    kYaw = 8,
+    kVx = 9,
+    kVy = 10,
+    kVz = 11,
+    kBatteryPercent = 12,
+    kBatteryVoltageMv = 13,
+    kGpsFixType = 14,
+    kNumSat = 15,
+    kLinkQuality = 16,
+    kFlightMode = 17,
+    kGroupMask = 18,
+    kKeyframe = 19,
+    kSeq = 20,
+};
+
+// 定长缓冲区写入器：越界只置位 overflow，最后统一检查
+class Writer {
+public:
+    Writer(std::uint8_t* out, std::size_t capacity) : p_(out), end_(out + capacity) {}
+
+    bool overflow() const noexcept { return overflow_; }
+    std::uint8_t* position() const noexcept { return p_; }
+    // 增量帧中被掩码选中的字段组即使为默认值也要编码（接收端据掩码覆盖旧值）
+    void setExplicit(bool on) noexcept { explicit_ = on; }
+
+    void byte(std::uint8_t b) noexcept {
+        if (p_ == end_) {
+            overflow_ = true;
+            return;
+        }
+        *p_++ = b;
+    }
+    void varint(std::uint64_t v) noexcept {
+        while (v >= 0x80) {
+            byte(static_cast<std::uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        byte(static_cast<std::uint8_t>(v));
+    }
+    void tag(std::uint32_t field, std::uint32_t wire) noexcept { varint((field << 3) | wire); }
+    void fixed32(std::uint32_t v) noexcept {
+        for (int i = 0; i < 4; ++i) byte(static_cast<std::uint8_t>(v >> (8 * i)));
+    }
+    void fixed64(std::uint64_t v) noexcept {
+        for (int i = 0; i < 8; ++i) byte(static_cast<std::uint8_t>(v >> (8 * i)));
+    }
+
+    // proto3：默认值不编码
+    void doubleField(std::uint32_t field, double v) noexcept {
+        if (v == 0.0 && !explicit_) return;
+        std::uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        tag(field, kFixed64);
+        fixed64(bits);
+    }
+    void floatField(std::uint32_t field, double v) noexcept {
+        const float f = static_cast<float>(v);
+        if (f == 0.0f && !explicit_) return;
+        std::uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        tag(field, kFixed32);
+        fixed32(bits);
+    }
+    void int32Field(std::uint32_t field, std::int32_t v) noexcept {
+        if (v == 0 && !explicit_) return;
+        tag(field, kVarint);
+        varint(static_cast<std::uint64_t>(static_cast<std::int64_t>(v)));  // 负数按 protobuf 约定符号扩展为 10 字节
+    }
+    void stringField(std::uint32_t field, const std::string& s) noexcept {
+        if (s.empty() && !explicit_) return;
+        tag(field, kLengthDelimited);
+        varint(s.size());
+        if (static_cast<std::size_t>(end_ - p_) < s.size()) {
+            overflow_ = true;
+            return;
+        }
+        std::memcpy(p_, s.data(), s.size());
+        p_ += s.size();
+    }
+
+private:
+    std::uint8_t* p_;
+    std::uint8_t* end_;
+    bool overflow_{false};
+    bool explicit_{false};
+};
+
+class Reader {
+public:
+    Reader(const std::uint8_t* data, std::size_t size) : p_(data), end_(data + size) {}
+
+    bool done() const noexcept { return p_ == end_; }
+
+    bool varint(std::uint64_t& v) noexcept {
+        v = 0;
+        for (int shift = 0; shift < 64 && p_ != end_; shift += 7) {
+            const std::uint8_t b = *p_++;
+            v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) return true;
+        }
+        return false;
+    }
+    bool fixed32(std::uint32_t& v) noexcept {
+        if (end_ - p_ < 4) return false;
+        v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(p_[i]) << (8 * i);
+        p_ += 4;
+        return true;
+    }
+    bool fixed64(std::uint64_t& v) noexcept {
+        if (end_ - p_ < 8) return false;
+        v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<std::uint64_t>(p_[i]) << (8 * i);
+        p_ += 8;
+        return true;
+    }
+    bool bytes(const std::uint8_t*& data, std::size_t& size) noexcept {
+        std::uint64_t len = 0;
+        if (!varint(len) || len > static_cast<std::uint64_t>(end_ - p_)) return false;
+        data = p_;
+        size = static_cast<std::size_t>(len);
+        p_ += size;
+        return true;
+    }
+
+private:
+    const std::uint8_t* p_;
+    const std::uint8_t* end_;
+};
+
+double asDouble(std::uint64_t bits) noexcept {
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+double asFloat(std::uint32_t bits) noexcept {
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// delta 为空时编码完整帧（proto3 默认值省略）；否则只编码 delta->groups 选中的字段组并附带掩码
+std::size_t encodeFrame(const TelemetryMessage& msg, const TelemetryFrameInfo* delta, std::uint8_t* out,
+                        std::size_t capacity) noexcept {
+    if (capacity < kTelemetryFrameHeaderBytes || msg.uavId.size() > kTelemetryMaxStringBytes ||
+        msg.flightMode.size() > kTelemetryMaxStringBytes) {
+        return 0;
+    }
+    const std::uint32_t groups = delta ? delta->groups : kTelemetryAllGroups;
+    Writer w(out + kTelemetryFrameHeaderBytes, capacity - kTelemetryFrameHeaderBytes);
+    w.stringField(kUavId, msg.uavId);
+    if (msg.timestampNs != 0) {
+        w.tag(kTimestampNs, kFixed64);
+        w.fixed64(static_cast<std::uint64_t>(msg.timestampNs));
+    }
+    w.setExplicit(delta != nullptr);
+    if (groups & TelemetryGroupPosition) {
+        w.doubleField(kLat, msg.lat);
+        w.doubleField(kLon, msg.lon);
+        w.floatField(kAlt, msg.alt);
+    }
+    if (groups & TelemetryGroupAttitude) {
+        w.floatField(kRoll, msg.roll);
+        w.floatField(kPitch, msg.pitch);
+        w.floatField(kYaw, msg.yaw);
+    }
+    if (groups & TelemetryGroupVelocity) {
+        w.floatField(kVx, msg.vx);
+        w.floatField(kVy, msg.vy);
+        w.floatField(kVz, msg.vz);
+    }
+    if (groups & TelemetryGroupBattery) {
+        w.floatField(kBatteryPercent, msg.batteryPercent);
+        w.int32Field(kBatteryVoltageMv, msg.batteryVoltageMv);
+    }
+    if (groups & TelemetryGroupGps) {
+        w.int32Field(kGpsFixType, msg.gpsFixType);
+        w.int32Field(kNumSat, msg.numSat);
+    }
+    if (groups & TelemetryGroupLink) {
+        w.floatField(kLinkQuality, msg.linkQuality);
+    }
+    if (groups & TelemetryGroupMode) {
+        w.stringField(kFlightMode, msg.flightMode);
+    }
+    if (delta) {
+        w.tag(kGroupMask, kVarint);  // 掩码总是编码：为 0 时即仅含时间戳的心跳帧
+        w.varint(groups);
+        w.setExplicit(false);
+        if (delta->keyframe) {
+            w.tag(kKeyframe, kVarint);
+            w.varint(1);
+        }
+        if (delta->seq != 0) {
+            w.tag(kSeq, kVarint);
+            w.varint(delta->seq);
+        }
+    }
+    if (w.overflow()) {
+        return 0;
+    }
+    const std::size_t body = static_cast<std::size_t>(w.position() - (out + kTelemetryFrameHeaderBytes));
+    out[0] = kTelemetryFrameMagic;
+    out[1] = kTelemetryFrameVersion;
+    out[2] = static_cast<std::uint8_t>(body & 0xFF);
+    out[3] = static_cast<std::uint8_t>(body >> 8);
+    return kTelemetryFrameHeaderBytes + body;
+}
+
+} // namespace
+
+std::size_t encodeTelemetryFrame(const TelemetryMessage& msg, std::uint8_t* out, std::size_t capacity) noexcept {
+    return encodeFrame(msg, nullptr, out, capacity);
+}
+
+std::size_t encodeTelemetryDeltaFrame(const TelemetryMessage& msg, const TelemetryFrameInfo& info, std::uint8_t* out,
+                                      std::size_t capacity) noexcept {
+    TelemetryFrameInfo delta = info;
+    delta.groups &= kTelemetryAllGroups;
+    return encodeFrame(msg, &delta, out, capacity);
+}
+
+std::size_t telemetryFrameLength(const std::uint8_t* data, std::size_t size) noexcept {
+    if (size >= 1 && data[0] != kTelemetryFrameMagic) return std::numeric_limits<std::size_t>::max();
+    if (size >= 2 && data[1] != kTelemetryFrameVersion) return std::numeric_limits<std::size_t>::max();
+    if (size < kTelemetryFrameHeaderBytes) return 0;
+    const std::size_t total = kTelemetryFrameHeaderBytes + (data[2] | (static_cast<std::size_t>(data[3]) << 8));
+    return size >= total ? total : 0;
+}
+
+bool decodeTelemetryFrame(const std::uint8_t* data, std::size_t size, TelemetryMessage& out, TelemetryFrameInfo* info) {
+    const std::size_t frame = telemetryFrameLength(data, size);
+    if (frame == 0 || frame != size) {
+        return false;
+    }
+    out = TelemetryMessage{};
+    out.uavId.clear();
+    out.flightMode.clear();
+    TelemetryFrameInfo frameInfo;
+
+    Reader r(data + kTelemetryFrameHeaderBytes, size - kTelemetryFrameHeaderBytes);
+    while (!r.done()) {
+        std::uint64_t key = 0;
+        if (!r.varint(key)) return false;
+        const auto field = static_cast<std::uint32_t>(key >> 3);
+        const auto wire = static_cast<std::uint32_t>(key & 0x7);
+        std::uint64_t v64 = 0;
+        std::uint32_t v32 = 0;
+        const std::uint8_t* bytes = nullptr;
+        std::size_t len = 0;
+        switch (wire) {
+        case kVarint:
+            if (!r.varint(v64)) return false;
+            break;
+        case kFixed64:
+            if (!r.fixed64(v64)) return false;
+            break;
+        case kFixed32:
+            if (!r.fixed32(v32)) return false;
+            break;
+        case kLengthDelimited:
+            if (!r.bytes(bytes, len)) return false;
+            break;
+        default:
+            return false;  // group 等已废弃的线类型
+        }
+
+        // 字段编号与线类型均匹配时才取值，其余视为未知字段跳过
+        switch (field) {
+        case kUavId:
+            if (wire == kLengthDelimited) out.uavId.assign(reinterpret_cast<const char*>(bytes), len);
+            break;
+        case kTimestampNs:
+            if (wire == kFixed64) out.timestampNs = static_cast<std::int64_t>(v64);
+            break;
+        case kLat:
+            if (wire == kFixed64) out.lat = asDouble(v64);
+            break;
+        case kLon:
+            if (wire == kFixed64) out.lon = asDouble(v64);
+            break;
+        case kAlt:
+            if (wire == kFixed32) out.alt = asFloat(v32);
+            break;
+        case kRoll:
+            if (wire == kFixed32) out.roll = asFloat(v32);
+            break;
+        case kPitch:
+            if (wire == kFixed32) out.pitch = asFloat(v32);
+            break;
+        case kYaw:
+            if (wire == kFixed32) out.yaw = asFloat(v32);
+            break;
+        case kVx:
+            if (wire == kFixed32) out.vx = asFloat(v32);
+            break;
+        case kVy:
+            if (wire == kFixed32) out.vy = asFloat(v32);
+            break;
+        case kVz:
+            if (wire == kFixed32) out.vz = asFloat(v32);
+            break;
+        case kBatteryPercent:
+            if (wire == kFixed32) out.batteryPercent = asFloat(v32);
+            break;
+        case kBatteryVoltageMv:
+            if (wire == kVarint) out.batteryVoltageMv = static_cast<std::int32_t>(v64);
+            break;
+        case kGpsFixType:
+            if (wire == kVarint) out.gpsFixType = static_cast<std::int32_t>(v64);
+            break;
+        case kNumSat:
+            if (wire == kVarint) out.numSat = static_cast<std::int32_t>(v64);
+            break;
+        case kLinkQuality:
+            if (wire == kFixed32) out.linkQuality = asFloat(v32);
+            break;
+        case kFlightMode:
+            if (wire == kLengthDelimited) out.flightMode.assign(reinterpret_cast<const char*>(bytes), len);
+            break;
+        case kGroupMask:
+            if (wire == kVarint) {
+                frameInfo.delta = true;
+                frameInfo.groups = static_cast<std::uint32_t>(v64) & kTelemetryAllGroups;
+            }
+            break;
+        case kKeyframe:
+            if (wire == kVarint) frameInfo.keyframe = v64 != 0;
+            break;
+        case kSeq:
+            if (wire == kVarint) frameInfo.seq = static_cast<std::uint32_t>(v64);
+            break;
+        default:
+            break;
+        }
+    }
+    if (!frameInfo.delta) {
+        frameInfo.keyframe = true;  // 完整帧等同关键帧
+    }
+    if (info) {
+        *info = frameInfo;
+    }
+    return true;
+}
+
+void mergeTelemetryGroups(const TelemetryMessage& delta, std::uint32_t groups, TelemetryMessage& state) {
+    state.uavId = delta.uavId;
+    state.timestampNs = delta.timestampNs;
+    if (groups & TelemetryGroupPosition) {
+        state.lat = delta.lat;
+        state.lon = delta.lon;
+        state.alt = delta.alt;
+    }
+    if (groups & TelemetryGroupAttitude) {
+        state.roll = delta.roll;
+        state.pitch = delta.pitch;
+        state.yaw = delta.yaw;
+    }
+    if (groups & TelemetryGroupVelocity) {
+        state.vx = delta.vx;
+        state.vy = delta.vy;
+        state.vz = delta.vz;
+    }
+    if (groups & TelemetryGroupBattery) {
+        state.batteryPercent = delta.batteryPercent;
+        state.batteryVoltageMv = delta.batteryVoltageMv;
+    }
+    if (groups & TelemetryGroupGps) {
+        state.gpsFixType = delta.gpsFixType;
+        state.numSat = delta.numSat;
+    }
+    if (groups & TelemetryGroupLink) {
+        state.linkQuality = delta.linkQuality;
+    }
+    if (groups & TelemetryGroupMode) {
+        state.flightMode = delta.flightMode;
+    }
+}
+
+} // namespace falconmind::sdk::telemetry
@@ -1,31 +1,291 @@
 #include "falconmind/sdk/telemetry/TelemetryPublisher.h"
 
+#include "falconmind/sdk/core/BoundedQueue.h"
+
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <thread>
+#include <utility>
 
 namespace falconmind::sdk::telemetry {
 
-int TelemetryPublisher::subscribe(const Handler& handler) {
-    std::lock_guard<std::mutex> lock(mutex_);
+// 单个异步订阅者：有界无锁队列 + 专用分发线程（唤醒方式与 Bus::postAsync 相同：仅在分发线程准备休眠时加锁通知）
+template <typename Msg>
+class TelemetryPublisher::AsyncChannel {
+public:
+    AsyncChannel(std::function<void(const Msg&)> handler, const AsyncSubscribeOptions& options)
+        : handler_(std::move(handler))
+        , conflate_(options.conflate)
+        , queue_(options.queueDepth > 0 ? options.queueDepth : 1) {}
+
+    // 分发线程持有 self，自身处理函数中取消订阅（detach）时通道随线程退出释放
+    static void start(const std::shared_ptr<AsyncChannel>& self) {
+        self->thread_ = std::thread([self]() { self->run(); });
+    }
+
+    void stop() {
+        stopping_.store(true);
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+        }
+        wakeCv_.notify_all();
+        if (!thread_.joinable()) return;
+        if (thread_.get_id() == std::this_thread::get_id()) {
+            thread_.detach();
+        } else {
+            thread_.join();
+        }
+    }
+
+    // 发布线程调用：不阻塞、不加锁（除分发线程休眠时的一次通知）
+    void push(const Msg& msg) {
+        Msg copy(msg);
+        bool ok = queue_.tryPush(std::move(copy));  // 失败时 copy 保持不变
+        // 合并：弹出最旧的一条腾出空间；与分发线程竞争时有限次重试
+        for (int attempt = 0; !ok && conflate_ && attempt < 4; ++attempt) {
+            Msg stale;
+            if (queue_.tryPop(stale)) {
+                popped_.fetch_add(1);
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+            ok = queue_.tryPush(std::move(copy));
+        }
+        if (!ok) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        pushed_.fetch_add(1);  // 与 idle_ 的读写均为 seq_cst，保证与分发线程的休眠检查不会同时错过
+        if (idle_.load()) {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            wakeCv_.notify_one();
+        }
+    }
+
+    SubscriberStats stats() const noexcept {
+        SubscriberStats s;
+        s.enqueued = pushed_.load(std::memory_order_relaxed);
+        s.delivered = delivered_.load(std::memory_order_relaxed);
+        s.dropped = dropped_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    void run() {
+        Msg msg;
+        for (;;) {
+            while (!stopping_.load(std::memory_order_acquire) && queue_.tryPop(msg)) {
+                popped_.fetch_add(1);
+                handler_(msg);
+                delivered_.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (stopping_) {
+                return;
+            }
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            idle_.store(true);
+            // 设置 idle_ 后复查一次，避免与发布线程的入队交错丢失唤醒
+            if (popped_.load() >= pushed_.load()) {
+                wakeCv_.wait_for(lock, std::chrono::milliseconds(50), [this]() {
+                    return stopping_.load() || popped_.load() < pushed_.load();
+                });
+            }
+            idle_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    std::function<void(const Msg&)> handler_;
+    const bool conflate_;
+    core::BoundedQueue<Msg> queue_;
+    std::atomic<std::uint64_t> pushed_{0};
+    std::atomic<std::uint64_t> popped_{0};  // 分发线程取出 + 合并丢弃
+    std::atomic<std::uint64_t> delivered_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    std::thread thread_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> idle_{false};
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+};
+
+TelemetryPublisher::TelemetryPublisher() : subscribers_(std::make_shared<Subscribers>()) {}
+
+TelemetryPublisher::~TelemetryPublisher() {
+    auto subs = snapshot();
+    for (const auto& s : subs->telemetry) if (s.async) s.async->stop();
+    for (const auto& s : subs->metrics) if (s.async) s.async->stop();
+    for (const auto& s : subs->tracking) if (s.async) s.async->stop();
+    for (const auto& s : subs->rollups) if (s.async) s.async->stop();
+    for (const auto& route : subs->routedTelemetry) {
+        for (const auto& s : route.second) if (s.async) s.async->stop();
+    }
+}
+
+std::shared_ptr<const TelemetryPublisher::Subscribers> TelemetryPublisher::snapshot() const {
+    return std::atomic_load(&subscribers_);
+}
+
+template <typename Msg>
+int TelemetryPublisher::add(std::vector<Subscription<Msg>> Subscribers::*list,
+                            const std::function<void(const Msg&)>& handler, const AsyncSubscribeOptions* async) {
+    std::shared_ptr<AsyncChannel<Msg>> channel;
+    if (async && handler) {
+        channel = std::make_shared<AsyncChannel<Msg>>(handler, *async);
+        AsyncChannel<Msg>::start(channel);
+    }
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    auto next = std::make_shared<Subscribers>(*snapshot());
+    int id = nextId_++;
+    ((*next).*list).push_back({id, handler, std::move(channel)});
+    std::atomic_store(&subscribers_, std::shared_ptr<const Subscribers>(std::move(next)));
+    return id;
+}
+
+int TelemetryPublisher::addRouted(const std::string& uavId, const Handler& handler,
+                                  const AsyncSubscribeOptions* async) {
+    std::shared_ptr<AsyncChannel<TelemetryMessage>> channel;
+    if (async && handler) {
+        channel = std::make_shared<AsyncChannel<TelemetryMessage>>(handler, *async);
+        AsyncChannel<TelemetryMessage>::start(channel);
+    }
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    auto next = std::make_shared<Subscribers>(*snapshot());
     int id = nextId_++;
-    handlers_.emplace_back(id, handler);
+    next->routedTelemetry[uavId].push_back({id, handler, std::move(channel)});
+    std::atomic_store(&subscribers_, std::shared_ptr<const Subscribers>(std::move(next)));
     return id;
 }
 
+template <typename Msg>
+void TelemetryPublisher::dispatch(const std::vector<Subscription<Msg>>& list, const Msg& msg) {
+    for (const auto& s : list) {
+        if (s.async) {
+            s.async->push(msg);
+        } else if (s.handler) {
+            s.handler(msg);
+        }
+    }
+}
+
+int TelemetryPublisher::subscribe(const Handler& handler) {
+    return add(&Subscribers::telemetry, handler, nullptr);
+}
+
+int TelemetryPublisher::subscribe(const std::string& uavId, const Handler& handler) {
+    return addRouted(uavId, handler, nullptr);
+}
+
+int TelemetryPublisher::subscribeMetrics(const MetricsHandler& handler) {
+    return add(&Subscribers::metrics, handler, nullptr);
+}
+
+int TelemetryPublisher::subscribeTracking(const TrackingHandler& handler) {
+    return add(&Subscribers::tracking, handler, nullptr);
+}
+
+int TelemetryPublisher::subscribeRollup(const RollupHandler& handler) {
+    return add(&Subscribers::rollups, handler, nullptr);
+}
+
+int TelemetryPublisher::subscribeAsync(const Handler& handler, const AsyncSubscribeOptions& options) {
+    return add(&Subscribers::telemetry, handler, &options);
+}
+
+int TelemetryPublisher::subscribeAsync(const std::string& uavId, const Handler& handler,
+                                       const AsyncSubscribeOptions& options) {
+    return addRouted(uavId, handler, &options);
+}
+
+int TelemetryPublisher::subscribeMetricsAsync(const MetricsHandler& handler, const AsyncSubscribeOptions& options) {
+    return add(&Subscribers::metrics, handler, &options);
+}
+
+int TelemetryPublisher::subscribeTrackingAsync(const TrackingHandler& handler, const AsyncSubscribeOptions& options) {
+    return add(&Subscribers::tracking, handler, &options);
+}
+
+int TelemetryPublisher::subscribeRollupAsync(const RollupHandler& handler, const AsyncSubscribeOptions& options) {
+    return add(&Subscribers::rollups, handler, &options);
+}
+
 void TelemetryPublisher::unsubscribe(int id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    handlers_.erase(
-        std::remove_if(handlers_.begin(), handlers_.end(),
-                       [id](const auto& p) { return p.first == id; }),
-        handlers_.end());
+    std::vector<std::function<void()>> stops;
+    {
+        std::lock_guard<std::mutex> lock(subscribeMutex_);
+        auto next = std::make_shared<Subscribers>(*snapshot());
+        auto removeFrom = [id, &stops](auto& list) {
+            auto it = std::remove_if(list.begin(), list.end(), [id](const auto& s) { return s.id == id; });
+            for (auto r = it; r != list.end(); ++r) {
+                if (r->async) stops.emplace_back([channel = r->async]() { channel->stop(); });
+            }
+            list.erase(it, list.end());
+        };
+        removeFrom(next->telemetry);
+        removeFrom(next->metrics);
+        removeFrom(next->tracking);
+        removeFrom(next->rollups);
+        for (auto it = next->routedTelemetry.begin(); it != next->routedTelemetry.end();) {
+            removeFrom(it->second);
+            it = it->second.empty() ? next->routedTelemetry.erase(it) : std::next(it);
+        }
+        std::atomic_store(&subscribers_, std::shared_ptr<const Subscribers>(std::move(next)));
+    }
+    // 在锁外等待分发线程退出：其处理函数中的 subscribe / unsubscribe 不会与此处互锁
+    for (auto& stop : stops) stop();
+}
+
+bool TelemetryPublisher::subscriberStats(int id, SubscriberStats& out) const {
+    auto subs = snapshot();
+    auto find = [id, &out](const auto& list) {
+        for (const auto& s : list) {
+            if (s.id == id && s.async) {
+                out = s.async->stats();
+                return true;
+            }
+        }
+        return false;
+    };
+    if (find(subs->telemetry) || find(subs->metrics) || find(subs->tracking) || find(subs->rollups)) {
+        return true;
+    }
+    for (const auto& route : subs->routedTelemetry) {
+        if (find(route.second)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void TelemetryPublisher::publish(const TelemetryMessage& msg) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    for (const auto& [id, handler] : handlers_) {
-        handler(msg);
+    auto subs = snapshot();
+    dispatch(subs->telemetry, msg);
+    if (!subs->routedTelemetry.empty()) {
+        auto route = subs->routedTelemetry.find(msg.uavId);
+        if (route != subs->routedTelemetry.end()) {
+            dispatch(route->second, msg);
+        }
     }
 }
 
+void TelemetryPublisher::publishMetrics(const PipelineMetricsMessage& msg) {
+    dispatch(snapshot()->metrics, msg);
+}
+
+void TelemetryPublisher::publishTracking(const TrackingDeltaMessage& msg) {
+    dispatch(snapshot()->tracking, msg);
+}
+
+bool TelemetryPublisher::hasTrackingSubscribers() {
+    return !snapshot()->tracking.empty();
+}
+
+void TelemetryPublisher::publishRollup(const MetricsRollupMessage& msg) {
+    dispatch(snapshot()->rollups, msg);
+}
+
 TelemetryPublisher& TelemetryPublisher::instance() {
     static TelemetryPublisher inst;
     return inst;
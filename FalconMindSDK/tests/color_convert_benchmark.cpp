@@ -0,0 +1,104 @@
+// Color conversion microbenchmark: YUYV/NV12 -> RGB8 per kernel (scalar / SSE4.1 / AVX2 / NEON)
+//
+// 对每个当前 CPU 支持的内核测量单帧转换耗时（取多轮中位数），并与标量结果逐字节比对。
+//
+// 用法: falconmind_color_convert_benchmark [--width 1920] [--height 1080] [--iterations 50]
+// 退出码: 0 正常；1 参数错误或内核输出与标量不一致
+
+#include "falconmind/sdk/sensors/ColorConvert.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace falconmind::sdk::sensors;
+
+namespace {
+
+struct Options {
+    int width{1920};
+    int height{1080};
+    int iterations{50};
+};
+
+bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        int value = std::stoi(argv[++i]);
+        if (arg == "--width") opt.width = value;
+        else if (arg == "--height") opt.height = value;
+        else if (arg == "--iterations") opt.iterations = value;
+        else return false;
+    }
+    return opt.width > 0 && opt.height > 0 && opt.iterations > 0;
+}
+
+template <typename Fn>
+double medianMs(int iterations, Fn&& fn) {
+    std::vector<double> samples;
+    samples.reserve(static_cast<std::size_t>(iterations));
+    for (int i = 0; i < iterations; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        std::cerr << "Usage: " << argv[0] << " [--width 1920] [--height 1080] [--iterations 50]" << std::endl;
+        return 1;
+    }
+    const int w = opt.width;
+    const int h = opt.height;
+    const int yuyvStride = ((w + 1) / 2) * 4;
+    std::vector<std::uint8_t> yuyv(static_cast<std::size_t>(yuyvStride) * h);
+    std::vector<std::uint8_t> nv12(static_cast<std::size_t>(w) * (h + (h + 1) / 2));
+    std::uint32_t seed = 1;
+    for (auto* buf : {&yuyv, &nv12}) {
+        for (auto& b : *buf) {
+            seed = seed * 1664525u + 1013904223u;
+            b = static_cast<std::uint8_t>(seed >> 24);
+        }
+    }
+    const std::size_t rgbBytes = static_cast<std::size_t>(w) * h * 3;
+    std::vector<std::uint8_t> refYuyv(rgbBytes), refNv12(rgbBytes), out(rgbBytes);
+
+    const ColorKernel initial = activeColorKernel();
+    setColorKernel(ColorKernel::Scalar);
+    convertYuyvToRgb(yuyv.data(), yuyvStride, refYuyv.data(), w, h, false);
+    convertNv12ToRgb(nv12.data(), w, refNv12.data(), w, h, false);
+
+    std::printf("%dx%d, %d iterations, default kernel: %s\n", w, h, opt.iterations, colorKernelName(initial));
+    std::printf("%-8s %14s %14s %10s\n", "kernel", "yuyv->rgb ms", "nv12->rgb ms", "speedup");
+    double scalarMs = 0.0;
+    bool ok = true;
+    for (ColorKernel k : {ColorKernel::Scalar, ColorKernel::Sse41, ColorKernel::Avx2, ColorKernel::Neon}) {
+        if (!setColorKernel(k)) continue;
+        double yuyvMs = medianMs(opt.iterations, [&] {
+            convertYuyvToRgb(yuyv.data(), yuyvStride, out.data(), w, h, false);
+        });
+        bool match = out == refYuyv;
+        double nv12Ms = medianMs(opt.iterations, [&] {
+            convertNv12ToRgb(nv12.data(), w, out.data(), w, h, false);
+        });
+        match = match && out == refNv12;
+        if (k == ColorKernel::Scalar) scalarMs = yuyvMs;
+        std::printf("%-8s %14.3f %14.3f %9.2fx%s\n", colorKernelName(k), yuyvMs, nv12Ms,
+                    yuyvMs > 0.0 ? scalarMs / yuyvMs : 0.0, match ? "" : "  MISMATCH");
+        ok = ok && match;
+    }
+    setColorKernel(initial);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,917 @@
+// Flight-stack load benchmark: 合成 / 回放 MAVLink 流 -> MavlinkRouter / FlightConnectionService -> 行为树执行器
+//
+// 模拟飞控（本地 UDP socket）以给定总速率为多架飞机（sysid 1..N）发送遥测混合流（ATTITUDE / GLOBAL_POSITION_INT /
+// GPS_RAW_INT / SYS_STATUS / BATTERY_STATUS / HEARTBEAT），或按原始时间回放飞行日志中的 MavlinkRx 记录；
+// 并对收到的 COMMAND_LONG 以对应 sysid 回复 COMMAND_ACK。SDK 侧与 NodeAgent MultiUavManager 相同：一个路由器 +
+// 每机一个路由模式服务（--direct 时为单机独立连接 + I/O 线程），任务线程以固定频率 tick 读取全机队快照的行为树，
+// 并轮流向各机发送带确认跟踪的命令。统计：
+//   - decode：离线 StreamParser + applyTelemetry 吞吐（无 socket，衡量纯解析开销）
+//   - 链路吞吐与丢帧：发送帧数 vs 路由器 / 服务解析帧数
+//   - state_latency：ATTITUDE 发出到状态快照发布（状态监听器回调）的时延
+//   - command_rtt：sendCommandAsync 首次发送到收到 ACK
+//   - bt_tick：行为树单次 tick 耗时
+//   - CPU：进程 CPU，扣除模拟器线程后为 SDK 占用
+// 输出 JSON 供发布流水线在 x86 / arm64（examples/run-qemu-test.sh --flight-load）间对比。
+//
+// 用法: falconmind_flight_load_benchmark [--vehicles 8] [--rate 4000] [--frames-per-datagram 1]
+//         [--duration-ms 5000] [--warmup-ms 500] [--command-hz 20] [--tick-hz 50] [--direct]
+//         [--replay flight.fmlog] [--speed 1.0] [--record out.fmlog] [--decode-frames 200000]
+//         [--label name] [--output result.json|-] [--baseline base.json] [--max-regression-pct 10] [--verbose]
+// 退出码: 0 正常；1 参数/运行错误（含没有解析到任何帧、命令全部无确认）；2 相对 baseline 回归超限
+
+#include "falconmind/sdk/core/FlightLog.h"
+#include "falconmind/sdk/core/PipelineMetrics.h"
+#include "falconmind/sdk/flight/FlightConnectionService.h"
+#include "falconmind/sdk/flight/Mavlink.h"
+#include "falconmind/sdk/flight/MavlinkRouter.h"
+#include "falconmind/sdk/mission/BehaviorTree.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace falconmind::sdk;
+using namespace falconmind::sdk::flight;
+namespace mv = falconmind::sdk::flight::mavlink;
+using core::LatencyHistogram;
+using nlohmann::json;
+
+namespace {
+
+struct Options {
+    int vehicles{8};
+    double rate{4000.0};          // 所有飞机合计的帧 / 秒
+    int framesPerDatagram{1};     // PX4 按 MTU 合并时每个数据报可含多帧
+    int durationMs{5000};
+    int warmupMs{500};
+    double commandHz{20.0};       // 0 关闭命令往返测量
+    double tickHz{50.0};
+    bool direct{false};           // 单机独立连接（不经路由器）
+    std::string replay;           // 回放飞行日志中的 MavlinkRx 记录（代替合成流）
+    double speed{1.0};            // 回放倍速，0 为尽快发送
+    std::string record;           // 把 SDK 收发的 MAVLink 写入飞行日志（可作为之后的 --replay 输入）
+    std::size_t decodeFrames{200000};
+    std::string label{"default"};
+    std::string output{"-"};
+    std::string baseline;
+    double maxRegressionPct{10.0};
+    bool verbose{false};
+};
+
+bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        auto eq = arg.find('=');
+        if (eq != std::string::npos) {
+            value = arg.substr(eq + 1);
+            arg = arg.substr(0, eq);
+        }
+        auto next = [&](std::string& out) {
+            if (!value.empty()) {
+                out = value;
+                return true;
+            }
+            if (i + 1 >= argc) return false;
+            out = argv[++i];
+            return true;
+        };
+        std::string v;
+        try {
+            if (arg == "--direct") {
+                opt.direct = true;
+            } else if (arg == "--verbose") {
+                opt.verbose = true;
+            } else if (arg == "--vehicles" && next(v)) {
+                opt.vehicles = std::stoi(v);
+            } else if (arg == "--rate" && next(v)) {
+                opt.rate = std::stod(v);
+            } else if (arg == "--frames-per-datagram" && next(v)) {
+                opt.framesPerDatagram = std::stoi(v);
+            } else if (arg == "--duration-ms" && next(v)) {
+                opt.durationMs = std::stoi(v);
+            } else if (arg == "--warmup-ms" && next(v)) {
+                opt.warmupMs = std::stoi(v);
+            } else if (arg == "--command-hz" && next(v)) {
+                opt.commandHz = std::stod(v);
+            } else if (arg == "--tick-hz" && next(v)) {
+                opt.tickHz = std::stod(v);
+            } else if (arg == "--replay" && next(v)) {
+                opt.replay = v;
+            } else if (arg == "--record" && next(v)) {
+                opt.record = v;
+            } else if (arg == "--speed" && next(v)) {
+                opt.speed = std::stod(v);
+            } else if (arg == "--decode-frames" && next(v)) {
+                opt.decodeFrames = static_cast<std::size_t>(std::stoull(v));
+            } else if (arg == "--label" && next(v)) {
+                opt.label = v;
+            } else if (arg == "--output" && next(v)) {
+                opt.output = v;
+            } else if (arg == "--baseline" && next(v)) {
+                opt.baseline = v;
+            } else if (arg == "--max-regression-pct" && next(v)) {
+                opt.maxRegressionPct = std::stod(v);
+            } else {
+                std::cerr << "Unknown or incomplete option: " << argv[i] << std::endl;
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << v << std::endl;
+            return false;
+        }
+    }
+    if (opt.direct && opt.replay.empty()) opt.vehicles = 1;
+    return opt.vehicles >= 1 && opt.vehicles <= 250 && opt.rate > 0.0 && opt.framesPerDatagram >= 1 &&
+           opt.framesPerDatagram <= 8 && opt.durationMs > 0 && opt.warmupMs >= 0 && opt.tickHz > 0.0 &&
+           opt.commandHz >= 0.0 && opt.speed >= 0.0;
+}
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+double processCpuMs() {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1e3 + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e3;
+}
+
+double threadCpuMs(std::thread& t) {
+    clockid_t cid;
+    timespec ts{};
+    if (pthread_getcpuclockid(t.native_handle(), &cid) != 0 || clock_gettime(cid, &ts) != 0) return 0.0;
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+std::size_t peakRssKb() {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return static_cast<std::size_t>(ru.ru_maxrss);
+}
+
+const char* architecture() {
+#if defined(__aarch64__)
+    return "arm64";
+#elif defined(__x86_64__)
+    return "x86_64";
+#else
+    return "unknown";
+#endif
+}
+
+template <typename T>
+void put(std::uint8_t* p, T v) {
+    std::memcpy(p, &v, sizeof(v));
+}
+
+// 每架模拟飞机的发送状态；ATTITUDE 的 rollspeed 携带递增编号，发送时刻按编号记入 stamp 表供接收侧计算时延
+struct SimVehicle {
+    static constexpr std::size_t kStamps = 1024;
+
+    std::uint8_t sysid{1};
+    std::uint8_t seq{0};
+    std::uint32_t slot{0};
+    std::uint32_t attitudeId{0};
+    std::array<std::atomic<std::uint32_t>, kStamps> stampId{};
+    std::array<std::atomic<std::int64_t>, kStamps> stampNs{};
+    std::uint32_t lastSeenId{0};  // 接收侧（路由器 / I/O 线程）私有
+};
+
+// 一个 20 帧周期内的消息配比，接近 PX4 默认 UDP 流：姿态为主，位置次之，低频状态 / 电池 / 心跳
+constexpr std::uint32_t kPattern[20] = {
+    mv::kMsgAttitude, mv::kMsgGlobalPositionInt, mv::kMsgAttitude, mv::kMsgAttitude, mv::kMsgGpsRawInt,
+    mv::kMsgAttitude, mv::kMsgGlobalPositionInt, mv::kMsgAttitude, mv::kMsgAttitude, mv::kMsgSysStatus,
+    mv::kMsgAttitude, mv::kMsgGlobalPositionInt, mv::kMsgAttitude, mv::kMsgAttitude, mv::kMsgGpsRawInt,
+    mv::kMsgAttitude, mv::kMsgGlobalPositionInt, mv::kMsgAttitude, mv::kMsgBatteryStatus, mv::kMsgHeartbeat,
+};
+
+// 编码该机的下一帧遥测到 out，返回帧长；stamp 为 false 时不记录发送时刻（离线解析基准）
+std::size_t nextTelemetryFrame(SimVehicle& v, std::uint8_t* out, bool stamp) {
+    const std::uint32_t msgid = kPattern[v.slot % 20];
+    const std::uint32_t t = v.slot * 10;  // time_boot_ms
+    ++v.slot;
+    std::uint8_t p[40]{};
+    std::size_t len = 0;
+    const std::int32_t lat = 300000000 + v.sysid * 10000 + static_cast<std::int32_t>(v.slot % 1000);
+    const std::int32_t lon = 1200000000 + v.sysid * 10000;
+    switch (msgid) {
+        case mv::kMsgAttitude: {
+            const std::uint32_t id = ++v.attitudeId & 0xFFFFFF;  // float 可精确表示的范围
+            put(p, t);
+            put(p + 4, 0.01f);
+            put(p + 8, -0.02f);
+            put(p + 12, 1.57f);
+            put(p + 16, static_cast<float>(id));
+            len = 28;
+            if (stamp) {
+                auto& slotNs = v.stampNs[id % SimVehicle::kStamps];
+                slotNs.store(nowNs(), std::memory_order_relaxed);
+                v.stampId[id % SimVehicle::kStamps].store(id, std::memory_order_release);
+            }
+            break;
+        }
+        case mv::kMsgGlobalPositionInt:
+            put(p, t);
+            put(p + 4, lat);
+            put(p + 8, lon);
+            put(p + 12, std::int32_t{52000});
+            put(p + 16, std::int32_t{50000});
+            put(p + 20, std::int16_t{310});
+            put(p + 22, std::int16_t{-120});
+            put(p + 26, std::uint16_t{9000});
+            len = 28;
+            break;
+        case mv::kMsgGpsRawInt:
+            put(p, static_cast<std::uint64_t>(t) * 1000);
+            put(p + 8, lat);
+            put(p + 12, lon);
+            put(p + 20, std::uint16_t{90});
+            put(p + 24, std::uint16_t{330});
+            p[28] = 3;
+            p[29] = 14;
+            len = 30;
+            break;
+        case mv::kMsgSysStatus:
+            put(p + 8, std::uint32_t{0x3FFFFF});
+            put(p + 12, std::uint16_t{420});
+            put(p + 14, std::uint16_t{15800});
+            put(p + 16, std::int16_t{1250});
+            p[30] = 81;
+            len = 31;
+            break;
+        case mv::kMsgBatteryStatus:
+            put(p, std::int32_t{1800});
+            put(p + 8, std::int16_t{3100});
+            for (int i = 0; i < 4; ++i) put(p + 10 + 2 * i, std::uint16_t{3950});
+            for (int i = 4; i < 10; ++i) put(p + 10 + 2 * i, std::uint16_t{0xFFFF});
+            put(p + 30, std::int16_t{1250});
+            p[35] = 81;
+            len = 36;
+            break;
+        default:  // HEARTBEAT：四旋翼、PX4、已解锁、OFFBOARD 自定义模式
+            put(p, std::uint32_t{6u << 16});
+            p[4] = 2;
+            p[5] = 12;
+            p[6] = 0x80 | 0x01;
+            p[7] = 4;
+            p[8] = 3;
+            len = 9;
+            break;
+    }
+    return mv::encodeFrame(MavlinkVersion::V2, v.seq++, v.sysid, 1, msgid, p, len, out);
+}
+
+// 离线解析基准：预编码混合帧串，反复喂给 StreamParser 并合并遥测
+json runDecodeBenchmark(std::size_t targetFrames, int vehicles) {
+    std::vector<std::unique_ptr<SimVehicle>> sims;
+    for (int i = 0; i < vehicles; ++i) {
+        sims.push_back(std::make_unique<SimVehicle>());
+        sims.back()->sysid = static_cast<std::uint8_t>(i + 1);
+    }
+    std::vector<std::uint8_t> stream;
+    constexpr std::size_t kStreamFrames = 4000;  // 每机 20 帧周期的整数倍
+    std::uint8_t frame[mv::kMaxFrame];
+    for (std::size_t i = 0; i < kStreamFrames; ++i) {
+        const std::size_t n = nextTelemetryFrame(*sims[i % sims.size()], frame, false);
+        stream.insert(stream.end(), frame, frame + n);
+    }
+    mv::StreamParser parser;
+    std::vector<FlightState> states(256);
+    std::uint64_t frames = 0;
+    std::uint64_t updates = 0;
+    const std::int64_t t0 = nowNs();
+    while (frames < targetFrames) {
+        // 按 1 KB 左右的块喂入，相当于串口读批次 / 合并数据报
+        for (std::size_t off = 0; off < stream.size(); off += 1024) {
+            const std::size_t n = std::min<std::size_t>(1024, stream.size() - off);
+            frames += parser.feed(stream.data() + off, n, [&](const mv::Frame& f) {
+                updates += mv::applyTelemetry(f, states[f.sysid]) != 0;
+            });
+        }
+    }
+    const double ns = static_cast<double>(nowNs() - t0);
+    return {{"frames", frames},
+            {"state_updates", updates},
+            {"crc_errors", parser.stats().crcErrors},
+            {"ns_per_frame", frames > 0 ? ns / static_cast<double>(frames) : 0.0},
+            {"frames_per_s", ns > 0.0 ? frames * 1e9 / ns : 0.0},
+            {"mb_per_s", ns > 0.0 ? stream.size() * (frames / static_cast<double>(kStreamFrames)) * 1e3 / ns : 0.0}};
+}
+
+struct ReplayRecord {
+    std::int64_t offsetNs;
+    std::vector<std::uint8_t> data;
+};
+
+// 读取飞行日志里收到的原始数据报，并找出其中的飞机 sysid（排除地面站 255）
+bool loadReplay(const std::string& path, std::vector<ReplayRecord>& out, std::vector<std::uint8_t>& sysids) {
+    auto reader = core::FlightLogReader::open(path);
+    if (!reader) {
+        std::cerr << "Cannot open flight log: " << path << std::endl;
+        return false;
+    }
+    mv::StreamParser parser;
+    std::set<std::uint8_t> seen;
+    std::int64_t first = 0;
+    for (const auto& r : reader->records()) {
+        if (r.type != core::LogRecordType::MavlinkRx || r.size == 0) continue;
+        if (out.empty()) first = r.timestampNs;
+        out.push_back({r.timestampNs - first, std::vector<std::uint8_t>(r.data, r.data + r.size)});
+        parser.feed(r.data, r.size, [&](const mv::Frame& f) {
+            if (f.sysid != 0 && f.sysid != FlightConnectionService::kSysId) seen.insert(f.sysid);
+        });
+    }
+    sysids.assign(seen.begin(), seen.end());
+    if (out.empty() || sysids.empty()) {
+        std::cerr << "Flight log has no MAVLink rx records: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * 模拟飞控：sender 线程按速率发送遥测（或回放），responder 线程对 COMMAND_LONG 回 ACCEPTED。
+ * 两者共用一个 socket：路由模式发往路由器端点；独立连接模式发往第一个来包的地址（服务先发起）。
+ */
+class FlightSimulator {
+public:
+    FlightSimulator(const Options& opt, std::vector<std::unique_ptr<SimVehicle>>& vehicles,
+                    const std::vector<ReplayRecord>* replay)
+        : opt_(opt), vehicles_(vehicles), replay_(replay) {}
+
+    ~FlightSimulator() {
+        stop();
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    bool open() {
+        fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd_ < 0) return false;
+        const int buf = 4 << 20;
+        ::setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &buf, sizeof(buf));
+        ::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &buf, sizeof(buf));
+        timeval tv{0, 20000};
+        ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) return false;
+        socklen_t len = sizeof(addr);
+        ::getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        return true;
+    }
+
+    int port() const noexcept { return port_; }
+
+    void setTarget(int port) {
+        target_.sin_family = AF_INET;
+        target_.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        target_.sin_port = htons(static_cast<std::uint16_t>(port));
+        hasTarget_.store(true, std::memory_order_release);
+    }
+
+    void start() {
+        running_ = true;
+        responder_ = std::thread([this] { respondLoop(); });
+        sender_ = std::thread([this] { replay_ ? replayLoop() : sendLoop(); });
+    }
+
+    void stop() {
+        running_ = false;
+        if (sender_.joinable()) sender_.join();
+        if (responder_.joinable()) responder_.join();
+    }
+
+    bool waitTarget(int timeoutMs) const {
+        for (int i = 0; i < timeoutMs && !hasTarget_.load(std::memory_order_acquire); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return hasTarget_.load(std::memory_order_acquire);
+    }
+
+    double cpuMs() { return threadCpuMs(sender_) + threadCpuMs(responder_); }
+    std::uint64_t framesSent() const noexcept { return framesSent_.load(std::memory_order_relaxed); }
+    std::uint64_t datagramsSent() const noexcept { return datagramsSent_.load(std::memory_order_relaxed); }
+    std::uint64_t sendErrors() const noexcept { return sendErrors_.load(std::memory_order_relaxed); }
+    std::uint64_t commandsReceived() const noexcept { return commands_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t kBatch = 64;
+
+    void flush(std::vector<iovec>& iov, std::vector<mmsghdr>& msgs, std::size_t count, std::uint64_t frames) {
+        for (std::size_t i = 0; i < count; ++i) {
+            msgs[i].msg_hdr.msg_name = &target_;
+            msgs[i].msg_hdr.msg_namelen = sizeof(target_);
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        std::size_t done = 0;
+        while (done < count) {
+            const int n = ::sendmmsg(fd_, msgs.data() + done, static_cast<unsigned>(count - done), 0);
+            if (n <= 0) {
+                sendErrors_.fetch_add(count - done, std::memory_order_relaxed);
+                break;
+            }
+            done += static_cast<std::size_t>(n);
+        }
+        datagramsSent_.fetch_add(done, std::memory_order_relaxed);
+        framesSent_.fetch_add(done == count ? frames : frames * done / count, std::memory_order_relaxed);
+    }
+
+    void sendLoop() {
+        if (!waitTarget(2000)) return;
+        std::vector<std::array<std::uint8_t, mv::kMaxFrame * 8>> bufs(kBatch);
+        std::vector<iovec> iov(kBatch);
+        std::vector<mmsghdr> msgs(kBatch);
+        const std::int64_t start = nowNs();
+        std::uint64_t queued = 0;  // 已编码的帧（含本批未发出的）
+        std::size_t vehicle = 0;
+        while (running_) {
+            const auto due = static_cast<std::uint64_t>((nowNs() - start) * 1e-9 * opt_.rate);
+            std::size_t count = 0;
+            std::uint64_t frames = 0;
+            while (queued < due) {
+                std::size_t bytes = 0;
+                auto& buf = bufs[count];
+                const int fpd = opt_.framesPerDatagram;
+                // 一个数据报内的帧来自同一架飞机（与真实链路一致）
+                SimVehicle& v = *vehicles_[vehicle];
+                vehicle = (vehicle + 1) % vehicles_.size();
+                for (int f = 0; f < fpd && queued < due; ++f, ++queued, ++frames) {
+                    bytes += nextTelemetryFrame(v, buf.data() + bytes, true);
+                }
+                iov[count].iov_base = buf.data();
+                iov[count].iov_len = bytes;
+                if (++count == kBatch) {
+                    flush(iov, msgs, count, frames);
+                    count = 0;
+                    frames = 0;
+                }
+            }
+            if (count > 0) flush(iov, msgs, count, frames);
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    }
+
+    void replayLoop() {
+        if (!waitTarget(2000)) return;
+        std::vector<iovec> iov(1);
+        std::vector<mmsghdr> msgs(1);
+        mv::StreamParser counter;
+        while (running_) {
+            const std::int64_t start = nowNs();
+            for (const auto& r : *replay_) {
+                if (!running_) return;
+                if (opt_.speed > 0.0) {
+                    const auto at = start + static_cast<std::int64_t>(r.offsetNs / opt_.speed);
+                    const std::int64_t wait = at - nowNs();
+                    if (wait > 0) std::this_thread::sleep_for(std::chrono::nanoseconds(wait));
+                }
+                const std::size_t frames = counter.feed(r.data.data(), r.data.size(), [](const mv::Frame&) {});
+                iov[0].iov_base = const_cast<std::uint8_t*>(r.data.data());
+                iov[0].iov_len = r.data.size();
+                flush(iov, msgs, 1, frames);
+            }
+        }
+    }
+
+    void respondLoop() {
+        mv::StreamParser parser;
+        std::uint8_t rx[2048];
+        std::uint8_t seq = 0;
+        while (running_) {
+            sockaddr_in from{};
+            socklen_t fromLen = sizeof(from);
+            const ssize_t n = ::recvfrom(fd_, rx, sizeof(rx), 0, reinterpret_cast<sockaddr*>(&from), &fromLen);
+            if (n <= 0) continue;
+            if (!hasTarget_.load(std::memory_order_acquire)) {
+                target_ = from;
+                hasTarget_.store(true, std::memory_order_release);
+            }
+            parser.feed(rx, static_cast<std::size_t>(n), [&](const mv::Frame& f) {
+                if (f.msgid != mv::kMsgCommandLong) return;
+                commands_.fetch_add(1, std::memory_order_relaxed);
+                std::uint8_t payload[10]{};
+                std::memcpy(payload, f.payload + 28, 2);  // command
+                payload[2] = 0;                           // MAV_RESULT_ACCEPTED
+                std::uint8_t out[mv::kMaxFrame];
+                const std::uint8_t sysid = f.payload[30] != 0 ? f.payload[30] : 1;
+                const std::size_t len =
+                    mv::encodeFrame(MavlinkVersion::V2, seq++, sysid, 1, mv::kMsgCommandAck, payload, sizeof(payload), out);
+                ::sendto(fd_, out, len, 0, reinterpret_cast<sockaddr*>(&from), fromLen);
+            });
+        }
+    }
+
+    const Options& opt_;
+    std::vector<std::unique_ptr<SimVehicle>>& vehicles_;
+    const std::vector<ReplayRecord>* replay_;
+    int fd_{-1};
+    int port_{0};
+    sockaddr_in target_{};
+    std::atomic<bool> hasTarget_{false};
+    std::atomic<bool> running_{false};
+    std::thread sender_;
+    std::thread responder_;
+    std::atomic<std::uint64_t> framesSent_{0};
+    std::atomic<std::uint64_t> datagramsSent_{0};
+    std::atomic<std::uint64_t> sendErrors_{0};
+    std::atomic<std::uint64_t> commands_{0};
+};
+
+// 行为树负载：每次 tick 检查全机队有无位置 / 电量更新并读取快照（任务监控条件的典型访问模式）
+class FleetMonitorNode : public mission::BehaviorNode {
+public:
+    explicit FleetMonitorNode(std::vector<FlightConnectionService*> services)
+        : services_(std::move(services)), lastSeq_(services_.size(), 0) {}
+
+    mission::NodeStatus tick() override {
+        for (std::size_t i = 0; i < services_.size(); ++i) {
+            if ((services_[i]->changedSince(lastSeq_[i]) &
+                 (fieldBit(FlightField::Position) | fieldBit(FlightField::Battery))) == 0) {
+                continue;
+            }
+            const FlightState s = services_[i]->getLastState();
+            lastSeq_[i] = s.seq;
+            checksum_ += s.lat + s.batteryPercent;
+            ++snapshots_;
+        }
+        return mission::NodeStatus::Running;
+    }
+
+    std::uint64_t snapshots() const noexcept { return snapshots_; }
+
+private:
+    std::vector<FlightConnectionService*> services_;
+    std::vector<std::uint64_t> lastSeq_;
+    double checksum_{0.0};
+    std::uint64_t snapshots_{0};
+};
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+json histogramUs(const LatencyHistogram& h) {
+    return {{"count", h.count()},
+            {"p50_us", h.percentile(0.50) / 1e3},
+            {"p90_us", h.percentile(0.90) / 1e3},
+            {"p99_us", h.percentile(0.99) / 1e3},
+            {"max_us", h.max() / 1e3}};
+}
+
+// 与 baseline 比较：解析吞吐下降，或时延 p99 / SDK CPU / 丢帧率上升超过阈值即判为回归
+int compareWithBaseline(const json& current, const std::string& path, double maxPct) {
+    std::ifstream file(path);
+    json base = json::parse(file, nullptr, false);
+    if (!file.is_open() || base.is_discarded() || !base.contains("results")) {
+        std::cerr << "Cannot read baseline: " << path << std::endl;
+        return 1;
+    }
+    const json& b = base["results"];
+    const json& c = current["results"];
+    double factor = maxPct / 100.0;
+    int regressions = 0;
+    auto fail = [&regressions](const std::string& what, double baseValue, double value) {
+        std::cerr << "REGRESSION " << what << ": baseline=" << baseValue << " current=" << value << std::endl;
+        ++regressions;
+    };
+    auto value = [](const json& j, const char* group, const char* key) {
+        return j.contains(group) ? j[group].value(key, 0.0) : 0.0;
+    };
+    double baseDecode = value(b, "decode", "frames_per_s");
+    double decode = value(c, "decode", "frames_per_s");
+    if (baseDecode > 0.0 && decode < baseDecode * (1.0 - factor)) fail("decode frames_per_s", baseDecode, decode);
+    for (const char* group : {"state_latency", "command_rtt", "bt_tick"}) {
+        double baseP99 = value(b, group, "p99_us");
+        double p99 = value(c, group, "p99_us");
+        if (baseP99 > 0.0 && p99 > baseP99 * (1.0 + factor)) fail(std::string(group) + " p99_us", baseP99, p99);
+    }
+    double baseCpu = b.value("sdk_cpu_pct", 0.0);
+    double cpu = c.value("sdk_cpu_pct", 0.0);
+    if (baseCpu > 0.0 && cpu > baseCpu * (1.0 + factor)) fail("sdk_cpu_pct", baseCpu, cpu);
+    // 丢帧率基线通常接近 0，按百分点比较
+    double baseLoss = b.value("frame_loss_pct", 0.0);
+    double loss = c.value("frame_loss_pct", 0.0);
+    if (loss > baseLoss + maxPct / 10.0) fail("frame_loss_pct", baseLoss, loss);
+    return regressions > 0 ? 2 : 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--vehicles N] [--rate F] [--frames-per-datagram N] [--duration-ms N] [--warmup-ms N]"
+                     " [--command-hz F] [--tick-hz F] [--direct] [--replay FILE] [--speed F] [--record FILE] [--decode-frames N]"
+                     " [--label S] [--output FILE|-] [--baseline FILE] [--max-regression-pct P] [--verbose]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::vector<ReplayRecord> replay;
+    std::vector<std::uint8_t> sysids;
+    if (!opt.replay.empty()) {
+        if (!loadReplay(opt.replay, replay, sysids)) return 1;
+        if (opt.direct) sysids.resize(1);
+    } else {
+        for (int i = 1; i <= opt.vehicles; ++i) sysids.push_back(static_cast<std::uint8_t>(i));
+    }
+
+    // 服务的连接 / 命令日志写 stdout，默认静默以免混入 JSON（错误仍走 stderr），结束后恢复
+    NullBuffer nullBuffer;
+    struct CoutGuard {
+        std::streambuf* saved;
+        void restore() {
+            if (saved) std::cout.rdbuf(saved);
+            saved = nullptr;
+        }
+        ~CoutGuard() { restore(); }
+    } quiet{opt.verbose ? nullptr : std::cout.rdbuf(&nullBuffer)};
+
+    json decode = runDecodeBenchmark(std::max<std::size_t>(opt.decodeFrames, 1), static_cast<int>(sysids.size()));
+
+    std::vector<std::unique_ptr<SimVehicle>> sims;
+    std::array<SimVehicle*, 256> simBySysid{};
+    for (auto id : sysids) {
+        sims.push_back(std::make_unique<SimVehicle>());
+        sims.back()->sysid = id;
+        simBySysid[id] = sims.back().get();
+    }
+    FlightSimulator sim(opt, sims, replay.empty() ? nullptr : &replay);
+    if (!sim.open()) {
+        std::cerr << "Cannot open simulator socket" << std::endl;
+        return 1;
+    }
+
+    // SDK 侧：路由器 + 每机路由服务（或单机独立连接）
+    std::atomic<bool> measuring{false};
+    LatencyHistogram stateLatency;
+    LatencyHistogram commandRtt;
+    LatencyHistogram btTick;
+    std::shared_ptr<MavlinkRouter> router;
+    std::vector<std::unique_ptr<FlightConnectionService>> services;
+    std::shared_ptr<core::FlightLogRecorder> recorder;
+    if (!opt.record.empty()) {
+        core::FlightLogConfig logCfg;
+        logCfg.path = opt.record;
+        recorder = core::FlightLogRecorder::create(logCfg);
+        if (!recorder) return 1;
+    }
+    auto listenerFor = [&](std::uint8_t sysid) {
+        return [&, sysid](const FlightState& s) {
+            SimVehicle* v = simBySysid[sysid];
+            if (!v || (s.changed & fieldBit(FlightField::Attitude)) == 0) return;
+            const auto id = static_cast<std::uint32_t>(s.rollRate);
+            if (id == v->lastSeenId) return;
+            v->lastSeenId = id;
+            const std::size_t slot = id % SimVehicle::kStamps;
+            if (!measuring.load(std::memory_order_relaxed) || v->stampId[slot].load(std::memory_order_acquire) != id) {
+                return;
+            }
+            const std::int64_t dt = nowNs() - v->stampNs[slot].load(std::memory_order_relaxed);
+            if (dt >= 0) stateLatency.record(static_cast<std::uint64_t>(dt));
+        };
+    };
+    if (opt.direct) {
+        auto svc = std::make_unique<FlightConnectionService>();
+        FlightConnectionConfig cfg;
+        cfg.remoteAddress = "127.0.0.1";
+        cfg.remotePort = sim.port();
+        svc->setStateListener(listenerFor(sysids.front()));
+        svc->setLogRecorder(recorder);
+        if (!svc->connect(cfg) || !svc->startIoThread()) {
+            std::cerr << "Cannot connect flight service" << std::endl;
+            return 1;
+        }
+        services.push_back(std::move(svc));
+    } else {
+        router = std::make_shared<MavlinkRouter>();
+        router->setLogRecorder(recorder);
+        if (!router->addEndpoint(0, "127.0.0.1")) {
+            std::cerr << "Cannot bind router endpoint" << std::endl;
+            return 1;
+        }
+        for (auto id : sysids) {
+            auto svc = std::make_unique<FlightConnectionService>();
+            svc->setStateListener(listenerFor(id));
+            svc->setLogRecorder(recorder);
+            if (!svc->connect(router, id)) {
+                std::cerr << "Cannot attach sysid " << static_cast<int>(id) << std::endl;
+                return 1;
+            }
+            services.push_back(std::move(svc));
+        }
+        if (!router->start()) {
+            std::cerr << "Cannot start router" << std::endl;
+            return 1;
+        }
+        sim.setTarget(router->endpointPort(0));
+    }
+
+    sim.start();
+    if (opt.direct) {
+        // 独立连接：服务先发一帧，模拟飞控据此得知回包地址（与 SITL 先等地面站心跳一致）
+        services.front()->sendCommand(FlightCommand{FlightCommandType::Arm, 0.0});
+        if (!sim.waitTarget(2000)) {
+            std::cerr << "Simulator never heard from the flight service" << std::endl;
+            return 1;
+        }
+    }
+
+    // 任务线程：定频 tick 行为树，并按 --command-hz 轮流向各机发送带确认跟踪的命令
+    std::vector<FlightConnectionService*> raw;
+    for (auto& s : services) raw.push_back(s.get());
+    auto monitor = std::make_shared<FleetMonitorNode>(raw);
+    mission::BehaviorTreeExecutor executor(monitor);
+    std::atomic<bool> missionRunning{true};
+    std::atomic<bool> issueCommands{false};
+    std::atomic<std::uint64_t> commandsSent{0}, commandsAcked{0}, commandsFailed{0};
+    std::thread mission([&] {
+        using clock = std::chrono::steady_clock;
+        const auto tickPeriod = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / opt.tickHz));
+        const auto cmdPeriod = opt.commandHz > 0.0
+                                   ? std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / opt.commandHz))
+                                   : clock::duration::max();
+        auto nextTick = clock::now();
+        auto nextCmd = nextTick;
+        std::size_t target = 0;
+        CommandOptions cmdOptions;
+        cmdOptions.timeoutMs = 500;
+        cmdOptions.maxAttempts = 1;
+        while (missionRunning.load(std::memory_order_relaxed)) {
+            auto now = clock::now();
+            if (now >= nextTick) {
+                const std::int64_t t0 = nowNs();
+                executor.tick();
+                if (measuring.load(std::memory_order_relaxed)) btTick.record(static_cast<std::uint64_t>(nowNs() - t0));
+                nextTick += tickPeriod;
+                if (nextTick < now) nextTick = now + tickPeriod;
+            }
+            if (opt.commandHz > 0.0 && now >= nextCmd) {
+                nextCmd += cmdPeriod;
+                if (nextCmd < now) nextCmd = now + cmdPeriod;
+                if (issueCommands.load(std::memory_order_relaxed)) {
+                    FlightConnectionService* svc = raw[target++ % raw.size()];
+                    commandsSent.fetch_add(1, std::memory_order_relaxed);
+                    svc->sendCommandAsync(FlightCommand{FlightCommandType::Arm, 0.0}, cmdOptions,
+                                          [&](const CommandAck& ack) {
+                                              if (ack.accepted()) {
+                                                  commandRtt.record(static_cast<std::uint64_t>(ack.latencyNs));
+                                                  commandsAcked.fetch_add(1, std::memory_order_relaxed);
+                                              } else {
+                                                  commandsFailed.fetch_add(1, std::memory_order_relaxed);
+                                              }
+                                          });
+                }
+            }
+            std::this_thread::sleep_until(std::min(nextTick, opt.commandHz > 0.0 ? nextCmd : nextTick));
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(opt.warmupMs));
+
+    // 测量窗口：计数取差值，时延只在窗口内记录
+    auto rxFrames = [&] {
+        if (router) return router->stats().frames;
+        std::uint64_t total = 0;
+        for (auto& s : services) total += s->parserStats().frames;
+        return total;
+    };
+    const std::uint64_t sentStart = sim.framesSent();
+    const std::uint64_t datagramsStart = sim.datagramsSent();
+    const std::uint64_t rxStart = rxFrames();
+    const double cpuStart = processCpuMs();
+    const double simCpuStart = sim.cpuMs();
+    const auto begin = std::chrono::steady_clock::now();
+    measuring = true;
+    issueCommands = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(opt.durationMs));
+    issueCommands = false;
+    measuring = false;
+    const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    const double cpu = processCpuMs() - cpuStart;
+    const double simCpu = sim.cpuMs() - simCpuStart;
+    const std::uint64_t sent = sim.framesSent() - sentStart;
+    const std::uint64_t datagrams = sim.datagramsSent() - datagramsStart;
+    // 在途帧在短暂排空后计入（接收侧滞后于发送侧）
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const std::uint64_t rxEnd = rxFrames();
+
+    // 等待窗口内发出的命令全部有结果（每条最多 timeoutMs）
+    for (int i = 0; i < 100; ++i) {
+        std::size_t pending = 0;
+        for (auto& s : services) pending += s->pendingCommands();
+        if (pending == 0) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    missionRunning = false;
+    mission.join();
+    sim.stop();
+    const std::uint64_t received = std::min(rxEnd - rxStart, sent);
+
+    MavlinkRouterStats routerStats;
+    if (router) routerStats = router->stats();
+    std::uint64_t crcErrors = router ? routerStats.crcErrors : 0;
+    if (!router) {
+        for (auto& s : services) crcErrors += s->parserStats().crcErrors;
+    }
+    for (auto& s : services) s->disconnect();
+    if (router) router->stop();
+    if (recorder) recorder->close();
+    quiet.restore();
+
+    const double seconds = wallMs / 1000.0;
+    const double lossPct = sent > 0 ? (sent > received ? (sent - received) * 100.0 / sent : 0.0) : 0.0;
+    json rtt = histogramUs(commandRtt);
+    rtt["sent"] = commandsSent.load();
+    rtt["acked"] = commandsAcked.load();
+    rtt["failed"] = commandsFailed.load();
+    rtt["simulator_received"] = sim.commandsReceived();
+    json report = {
+        {"benchmark", "flight_load"},
+        {"label", opt.label},
+        {"toolchain", {{"arch", architecture()}, {"compiler", __VERSION__}}},
+        {"config",
+         {{"mode", opt.direct ? "direct" : "router"},
+          {"source", opt.replay.empty() ? "synthetic" : opt.replay},
+          {"vehicles", sysids.size()},
+          {"rate", opt.replay.empty() ? opt.rate : 0.0},
+          {"speed", opt.replay.empty() ? 0.0 : opt.speed},
+          {"frames_per_datagram", opt.framesPerDatagram},
+          {"duration_ms", opt.durationMs},
+          {"warmup_ms", opt.warmupMs},
+          {"command_hz", opt.commandHz},
+          {"tick_hz", opt.tickHz}}},
+        {"results",
+         {{"decode", decode},
+          {"frames_sent", sent},
+          {"datagrams_sent", datagrams},
+          {"frames_parsed", received},
+          {"send_errors", sim.sendErrors()},
+          {"crc_errors", crcErrors},
+          {"unrouted_frames", routerStats.unrouted},
+          {"offered_frames_per_s", seconds > 0.0 ? sent / seconds : 0.0},
+          {"parsed_frames_per_s", seconds > 0.0 ? received / seconds : 0.0},
+          {"frame_loss_pct", lossPct},
+          {"state_latency", histogramUs(stateLatency)},
+          {"command_rtt", rtt},
+          {"bt_tick", histogramUs(btTick)},
+          {"bt_snapshots_read", monitor->snapshots()},
+          {"process_cpu_pct", wallMs > 0.0 ? cpu / wallMs * 100.0 : 0.0},
+          {"simulator_cpu_pct", wallMs > 0.0 ? simCpu / wallMs * 100.0 : 0.0},
+          {"sdk_cpu_pct", wallMs > 0.0 ? std::max(0.0, cpu - simCpu) / wallMs * 100.0 : 0.0},
+          {"peak_rss_kb", peakRssKb()}}}};
+
+    std::string text = report.dump(2);
+    if (opt.output == "-") {
+        std::cout << text << std::endl;
+    } else {
+        std::ofstream out(opt.output);
+        if (!out.is_open()) {
+            std::cerr << "Cannot write " << opt.output << std::endl;
+            return 1;
+        }
+        out << text << std::endl;
+        std::cerr << "parsed_frames_per_s=" << report["results"]["parsed_frames_per_s"] << " written to "
+                  << opt.output << std::endl;
+    }
+
+    if (received == 0) {
+        std::cerr << "No frames reached the flight service" << std::endl;
+        return 1;
+    }
+    if (commandsSent.load() > 0 && commandsAcked.load() == 0) {
+        std::cerr << "No command was acknowledged" << std::endl;
+        return 1;
+    }
+    if (!opt.baseline.empty()) {
+        return compareWithBaseline(report, opt.baseline, opt.maxRegressionPct);
+    }
+    return 0;
+}
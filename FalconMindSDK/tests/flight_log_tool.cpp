@@ -0,0 +1,230 @@
+// 飞行日志工具：解析环形日志文件生成时间排序索引与摘要，或用合成负载测量 record() 热路径开销
+//
+// 用法:
+//   falconmind_flight_log_tool index <log> [--output <log>.idx]
+//       解析日志（含未正常关闭的文件），写索引并输出 JSON 摘要（各类型条数 / 字节、时间跨度、覆盖 / 截断情况）
+//   falconmind_flight_log_tool bench [--threads 4] [--records 200000] [--payload 64] [--rate 200000]
+//                                    [--path /tmp/fm_flight_log_bench.fmlog] [--max-ns 0]
+//       多线程同时写合成记录（每线程 --rate 条/秒，0 为不限速以测试暂存区满时的丢弃），
+//       输出每条记录的平均 / p99（按 64 条一批计时）耗时，关闭后读回并核对条数
+// 退出码: 0 正常；1 参数错误、文件无法解析、条数不一致或平均耗时超过 --max-ns
+
+#include "falconmind/sdk/core/FlightLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace falconmind::sdk::core;
+
+namespace {
+
+struct BenchOptions {
+    int threads{4};
+    std::uint64_t records{200000};
+    std::size_t payload{64};
+    double rate{200000.0};
+    std::string path{"/tmp/fm_flight_log_bench.fmlog"};
+    double maxNs{0.0};
+};
+
+constexpr std::uint64_t kBatch = 64;
+
+int runIndex(const std::string& logPath, std::string indexPath) {
+    if (indexPath.empty()) indexPath = logPath + ".idx";
+    auto reader = FlightLogReader::open(logPath);
+    if (!reader) {
+        std::cerr << "cannot open flight log: " << logPath << std::endl;
+        return 1;
+    }
+    if (!writeFlightLogIndex(*reader, indexPath)) {
+        return 1;
+    }
+    std::vector<FlightLogIndexEntry> entries;
+    if (!readFlightLogIndex(indexPath, entries) || entries.size() != reader->size()) {
+        std::cerr << "index verification failed: " << indexPath << std::endl;
+        return 1;
+    }
+
+    struct TypeSummary {
+        std::uint64_t count{0};
+        std::uint64_t bytes{0};
+    };
+    std::map<std::uint16_t, TypeSummary> types;
+    std::map<std::uint16_t, std::uint64_t> threads;
+    for (const auto& e : entries) {
+        types[e.type].count++;
+        types[e.type].bytes += e.size;
+        threads[e.thread]++;
+    }
+    const double spanMs =
+        entries.empty() ? 0.0 : (entries.back().timestampNs - entries.front().timestampNs) / 1e6;
+
+    std::printf("{\n  \"log\": \"%s\",\n  \"index\": \"%s\",\n", logPath.c_str(), indexPath.c_str());
+    std::printf("  \"records\": %zu,\n  \"clean\": %s,\n  \"truncated\": %s,\n  \"overwritten\": %llu,\n",
+                entries.size(), reader->clean() ? "true" : "false", reader->truncated() ? "true" : "false",
+                static_cast<unsigned long long>(reader->overwritten()));
+    std::printf("  \"span_ms\": %.3f,\n  \"threads\": %zu,\n  \"types\": {", spanMs, threads.size());
+    bool first = true;
+    for (const auto& [type, s] : types) {
+        std::printf("%s\n    \"%s(%u)\": {\"count\": %llu, \"bytes\": %llu}", first ? "" : ",",
+                    logRecordTypeName(static_cast<LogRecordType>(type)), type,
+                    static_cast<unsigned long long>(s.count), static_cast<unsigned long long>(s.bytes));
+        first = false;
+    }
+    std::printf("\n  }\n}\n");
+    return 0;
+}
+
+bool parseBench(int argc, char** argv, BenchOptions& opt) {
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if (arg == "--threads") {
+            opt.threads = std::stoi(value);
+        } else if (arg == "--records") {
+            opt.records = std::stoull(value);
+        } else if (arg == "--payload") {
+            opt.payload = static_cast<std::size_t>(std::stoul(value));
+        } else if (arg == "--rate") {
+            opt.rate = std::stod(value);
+        } else if (arg == "--path") {
+            opt.path = value;
+        } else if (arg == "--max-ns") {
+            opt.maxNs = std::stod(value);
+        } else {
+            return false;
+        }
+    }
+    return opt.threads > 0 && opt.threads <= static_cast<int>(FlightLogRecorder::kMaxThreads) && opt.records > 0;
+}
+
+int runBench(const BenchOptions& opt) {
+    FlightLogConfig cfg;
+    cfg.path = opt.path;
+    cfg.fileBytes = 32u << 20;
+    cfg.stagingBytes = 1u << 20;
+    auto recorder = FlightLogRecorder::create(cfg);
+    if (!recorder) {
+        return 1;
+    }
+
+    std::vector<std::uint8_t> payload(opt.payload);
+    for (std::size_t i = 0; i < payload.size(); ++i) payload[i] = static_cast<std::uint8_t>(i);
+    std::vector<std::vector<double>> batchNs(static_cast<std::size_t>(opt.threads));
+    std::vector<double> totalNs(static_cast<std::size_t>(opt.threads), 0.0);
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < opt.threads; ++t) {
+        workers.emplace_back([&, t] {
+            auto& samples = batchNs[static_cast<std::size_t>(t)];
+            samples.reserve(static_cast<std::size_t>(opt.records / kBatch + 1));
+            recorder->record(LogRecordType::Text, "start", 5);  // 注册暂存区，不计入耗时
+            ++ready;
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            const auto start = std::chrono::steady_clock::now();
+            for (std::uint64_t done = 0; done < opt.records;) {
+                const std::uint64_t n = std::min(kBatch, opt.records - done);
+                const auto t0 = std::chrono::steady_clock::now();
+                for (std::uint64_t i = 0; i < n; ++i) {
+                    recorder->record(LogRecordType::User, payload.data(), payload.size());
+                }
+                const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+                samples.push_back(ns / static_cast<double>(n));
+                totalNs[static_cast<std::size_t>(t)] += ns;
+                done += n;
+                // 按目标速率节拍发送（模拟实时线程的周期性记录）；计时只覆盖 record() 本身
+                if (opt.rate > 0.0) {
+                    std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                              std::chrono::duration<double>(done / opt.rate)));
+                }
+            }
+        });
+    }
+    while (ready.load() < opt.threads) std::this_thread::yield();
+    go.store(true, std::memory_order_release);
+    for (auto& w : workers) w.join();
+    recorder->close();
+    const FlightLogStats stats = recorder->stats();
+
+    std::vector<double> all;
+    double sum = 0.0;
+    for (int t = 0; t < opt.threads; ++t) {
+        all.insert(all.end(), batchNs[static_cast<std::size_t>(t)].begin(), batchNs[static_cast<std::size_t>(t)].end());
+        sum += totalNs[static_cast<std::size_t>(t)];
+    }
+    std::sort(all.begin(), all.end());
+    const std::uint64_t expected = opt.records * static_cast<std::uint64_t>(opt.threads) + static_cast<std::uint64_t>(opt.threads);
+    const double meanNs = sum / static_cast<double>(opt.records * static_cast<std::uint64_t>(opt.threads));
+    const double p99Ns = all.empty() ? 0.0 : all[std::min(all.size() - 1, all.size() * 99 / 100)];
+
+    auto reader = FlightLogReader::open(opt.path);
+    const bool consistent = reader && reader->clean() && !reader->truncated() &&
+                            reader->size() + stats.overwritten + stats.dropped == expected &&
+                            stats.records + stats.dropped == expected;
+
+    std::printf("{\n  \"threads\": %d,\n  \"records_per_thread\": %llu,\n  \"payload_bytes\": %zu,\n", opt.threads,
+                static_cast<unsigned long long>(opt.records), opt.payload);
+    std::printf("  \"rate_per_thread\": %.0f,\n", opt.rate);
+    std::printf("  \"mean_ns_per_record\": %.1f,\n  \"p99_batch_ns_per_record\": %.1f,\n", meanNs, p99Ns);
+    std::printf("  \"written\": %llu,\n  \"dropped\": %llu,\n  \"overwritten\": %llu,\n  \"read_back\": %zu,\n",
+                static_cast<unsigned long long>(stats.records), static_cast<unsigned long long>(stats.dropped),
+                static_cast<unsigned long long>(stats.overwritten), reader ? reader->size() : 0);
+    std::printf("  \"consistent\": %s\n}\n", consistent ? "true" : "false");
+
+    if (!consistent) {
+        std::cerr << "record counts do not add up" << std::endl;
+        return 1;
+    }
+    if (runIndex(opt.path, {}) != 0) {
+        return 1;
+    }
+    if (opt.maxNs > 0.0 && meanNs > opt.maxNs) {
+        std::cerr << "mean record cost " << meanNs << " ns exceeds limit " << opt.maxNs << " ns" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+void usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0 << " index <log> [--output <index>]\n"
+              << "       " << argv0
+              << " bench [--threads 4] [--records 200000] [--payload 64] [--rate 200000] [--path <log>] [--max-ns 0]"
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+    const std::string mode = argv[1];
+    if (mode == "index") {
+        if (argc != 3 && !(argc == 5 && std::string(argv[3]) == "--output")) {
+            usage(argv[0]);
+            return 1;
+        }
+        return runIndex(argv[2], argc == 5 ? argv[4] : std::string{});
+    }
+    if (mode == "bench") {
+        BenchOptions opt;
+        if (!parseBench(argc, argv, opt)) {
+            usage(argv[0]);
+            return 1;
+        }
+        return runBench(opt);
+    }
+    usage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,176 @@
+// Flow 加载基准：整份 nlohmann::json DOM（iostream 读文件）vs 按需解析（mmap + JsonCursor）
+//
+// 生成与 Builder 导出相近的大 Flow（search_path_planner 带多边形搜索区域、event_reporter、节点 UI 布局与说明等
+// 执行时不需要的字段），写入临时文件后分别以两种方式执行 loadFlowFromFile（含参数预解析与计划编译），
+// 取多轮中位数，并校验两种方式编译出的执行计划一致。
+//
+// 用法: falconmind_flow_parse_benchmark [--nodes 100,500,1000] [--polygon 64] [--iterations 10] [--path FILE]
+// 退出码: 0 正常；1 参数错误、加载失败或两种方式的计划不一致
+
+#include "falconmind/sdk/core/FlowExecutor.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace falconmind::sdk::core;
+
+namespace {
+
+struct Options {
+    std::vector<int> nodes{100, 500, 1000};
+    int polygon{64};
+    int iterations{10};
+    std::string path{"/tmp/falconmind_flow_parse_benchmark.json"};
+};
+
+bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if (arg == "--nodes") {
+            opt.nodes.clear();
+            std::stringstream ss(value);
+            for (std::string item; std::getline(ss, item, ',');) {
+                if (!item.empty()) opt.nodes.push_back(std::stoi(item));
+            }
+        } else if (arg == "--polygon") {
+            opt.polygon = std::stoi(value);
+        } else if (arg == "--iterations") {
+            opt.iterations = std::stoi(value);
+        } else if (arg == "--path") {
+            opt.path = value;
+        } else {
+            return false;
+        }
+    }
+    return !opt.nodes.empty() && opt.polygon >= 3 && opt.iterations > 0;
+}
+
+// numNodes 个节点：planner 与 reporter 各半，planner → reporter 连边
+std::string makeFlow(int numNodes, int polygon) {
+    std::ostringstream os;
+    os.precision(9);
+    os << "{\n  \"flow_id\": \"flow_parse_benchmark\",\n  \"name\": \"Flow Parse Benchmark\",\n"
+       << "  \"version\": \"1.0\",\n  \"latency_budget_ms\": 120,\n"
+       << "  \"metadata\": {\"author\": \"builder\", \"tags\": [\"search\", \"benchmark\"], \"notes\": \"\\u751f\\u6210\"},\n"
+       << "  \"nodes\": [";
+    const int pairs = std::max(1, numNodes / 2);
+    for (int i = 0; i < pairs; ++i) {
+        os << (i ? "," : "") << "\n    {\"node_id\": \"planner_" << i << "\", \"template_id\": \"search_path_planner\","
+           << " \"ui\": {\"x\": " << i * 40 << ", \"y\": 120, \"collapsed\": false, \"color\": \"#3366ff\"},"
+           << " \"description\": \"Search sector " << i << " \\\"auto\\\" generated\","
+           << " \"parameters\": {\"search_area\": {\"polygon\": [";
+        for (int k = 0; k < polygon; ++k) {
+            const double angle = 6.283185307 * k / polygon;
+            os << (k ? ", " : "") << "{\"lat\": " << 31.2 + 0.01 * i + 0.005 * std::cos(angle)
+               << ", \"lon\": " << 121.4 + 0.005 * std::sin(angle) << ", \"alt\": 0}";
+        }
+        os << "], \"min_altitude\": 10.0, \"max_altitude\": 120.0},"
+           << " \"search_params\": {\"pattern\": \"LAWN_MOWER\", \"altitude\": 60.0, \"speed\": 8.0, \"spacing\": 25.0}}},"
+           << "\n    {\"node_id\": \"reporter_" << i << "\", \"template_id\": \"event_reporter\","
+           << " \"ui\": {\"x\": " << i * 40 << ", \"y\": 240}, \"parameters\": {}}";
+    }
+    os << "\n  ],\n  \"edges\": [";
+    for (int i = 0; i < pairs; ++i) {
+        os << (i ? "," : "") << "\n    {\"edge_id\": \"edge_" << i << "\", \"from_node_id\": \"planner_" << i
+           << "\", \"from_port\": \"waypoints\", \"to_node_id\": \"reporter_" << i << "\", \"to_port\": \"events\","
+           << " \"ui\": {\"curve\": [0, 1, 2, 3]}"
+           << (i % 4 == 0 ? ", \"queue\": {\"capacity\": 8, \"policy\": \"drop_newest\"}" : "") << "}";
+    }
+    os << "\n  ]\n}\n";
+    return os.str();
+}
+
+bool samePlan(const FlowPlan& a, const FlowPlan& b) {
+    if (a.flowId != b.flowId || a.version != b.version || a.latencyBudgetNs != b.latencyBudgetNs ||
+        a.nodes.size() != b.nodes.size() || a.edges.size() != b.edges.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.nodes.size(); ++i) {
+        const auto& x = a.nodes[i];
+        const auto& y = b.nodes[i];
+        if (x.nodeId != y.nodeId || x.templateId != y.templateId || x.paramsValid != y.paramsValid ||
+            nlohmann::json::parse(x.parametersJson) != nlohmann::json::parse(y.parametersJson) ||
+            x.planner.area.polygon.size() != y.planner.area.polygon.size()) {
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i < a.edges.size(); ++i) {
+        const auto& x = a.edges[i];
+        const auto& y = b.edges[i];
+        if (x.from != y.from || x.to != y.to || x.edgeId != y.edgeId || x.fromPort != y.fromPort ||
+            x.toPort != y.toPort || x.queue.enabled != y.queue.enabled || x.queue.capacity != y.queue.capacity ||
+            x.queue.policy != y.queue.policy) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 加载期间屏蔽 FlowExecutor 的摘要输出
+bool loadQuietly(FlowExecutor& executor, const std::string& path) {
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    const bool ok = executor.loadFlowFromFile(path);
+    std::cout.rdbuf(saved);
+    return ok;
+}
+
+double medianMs(std::vector<double> samples) {
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        std::cerr << "Usage: " << argv[0] << " [--nodes 100,500,1000] [--polygon 64] [--iterations 10] [--path FILE]"
+                  << std::endl;
+        return 1;
+    }
+    std::printf("%d polygon vertices per planner, %d iterations\n", opt.polygon, opt.iterations);
+    std::printf("%8s %10s %12s %14s %10s\n", "nodes", "file KiB", "dom ms", "on-demand ms", "speedup");
+    bool ok = true;
+    for (int n : opt.nodes) {
+        const std::string flow = makeFlow(n, opt.polygon);
+        {
+            std::ofstream out(opt.path, std::ios::binary | std::ios::trunc);
+            out << flow;
+        }
+        std::vector<double> domSamples, onDemandSamples;
+        FlowPlan domPlan, onDemandPlan;
+        bool loaded = true;
+        for (int it = 0; it < opt.iterations && loaded; ++it) {
+            for (bool onDemand : {false, true}) {
+                FlowExecutor executor;
+                executor.setOnDemandParsing(onDemand);
+                auto t0 = std::chrono::steady_clock::now();
+                loaded = loadQuietly(executor, opt.path) && loaded;
+                auto t1 = std::chrono::steady_clock::now();
+                (onDemand ? onDemandSamples : domSamples)
+                    .push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+                if (it == 0) (onDemand ? onDemandPlan : domPlan) = executor.getPlan();
+            }
+        }
+        const bool match = loaded && samePlan(domPlan, onDemandPlan);
+        const double domMs = loaded ? medianMs(domSamples) : 0.0;
+        const double onDemandMs = loaded ? medianMs(onDemandSamples) : 0.0;
+        std::printf("%8d %10.1f %12.3f %14.3f %9.2fx%s\n", static_cast<int>(domPlan.nodes.size()),
+                    static_cast<double>(flow.size()) / 1024.0, domMs, onDemandMs,
+                    onDemandMs > 0.0 ? domMs / onDemandMs : 0.0, match ? "" : (loaded ? "  MISMATCH" : "  LOAD FAILED"));
+        ok = ok && match;
+    }
+    std::remove(opt.path.c_str());
+    return ok ? 0 : 1;
+}
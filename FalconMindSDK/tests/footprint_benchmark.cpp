@@ -0,0 +1,183 @@
+// 占用基准：可执行文件体积、启动耗时与空闲 RSS，用于对比 full / embedded 构建档位
+//
+// 启动分三段计时：内置节点注册（NodeFactory::initializeDefaultTypes）、Flow 加载（含计划编译）、
+// Flow 启动（建 Pipeline、节点 start）；启动后空闲 --idle-ms 再取 RSS。默认 Flow 为
+// camera_source(stub) -> detection(无 backend) -> tracking_transform，embedded 档位须选入这三类节点，
+// 或用 --flow 指定与所选节点类型匹配的 Flow。各档位对比见 scripts/footprint_report.sh。
+//
+// 用法: falconmind_footprint_benchmark [--idle-ms 1000] [--flow FILE] [--path FILE] [--label name] [--output FILE|-]
+// 退出码: 0 正常；1 参数错误或 Flow 加载 / 启动失败
+
+#include "falconmind/sdk/core/FlowExecutor.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/NodeFactory.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+#include <sys/stat.h>
+
+#ifndef FALCONMINDSDK_PROFILE_NAME
+#define FALCONMINDSDK_PROFILE_NAME "unknown"
+#endif
+
+using namespace falconmind::sdk::core;
+using nlohmann::json;
+
+namespace {
+
+struct Options {
+    int idleMs{1000};
+    std::string flow;  // 空则写出并加载默认 Flow
+    std::string path{"/tmp/falconmind_footprint_benchmark.json"};
+    std::string label{FALCONMINDSDK_PROFILE_NAME};
+    std::string output{"-"};
+};
+
+bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if (arg == "--idle-ms") {
+            opt.idleMs = std::stoi(value);
+        } else if (arg == "--flow") {
+            opt.flow = value;
+        } else if (arg == "--path") {
+            opt.path = value;
+        } else if (arg == "--label") {
+            opt.label = value;
+        } else if (arg == "--output") {
+            opt.output = value;
+        } else {
+            return false;
+        }
+    }
+    return opt.idleMs >= 0;
+}
+
+const char* kDefaultFlow = R"({
+    "flow_id": "footprint_benchmark",
+    "version": "1.0",
+    "nodes": [
+        {"node_id": "camera", "template_id": "camera_source", "parameters": {"device": "", "width": 640, "height": 480}},
+        {"node_id": "detector", "template_id": "detection", "parameters": {}},
+        {"node_id": "tracker", "template_id": "tracking_transform", "parameters": {}}
+    ],
+    "edges": [
+        {"edge_id": "e1", "from_node_id": "camera", "from_port": "video_out", "to_node_id": "detector", "to_port": "video_in"},
+        {"edge_id": "e2", "from_node_id": "detector", "from_port": "detection_out", "to_node_id": "tracker", "to_port": "detection_in"}
+    ]
+})";
+
+// /proc/self/status 中的 kB 字段（VmRSS / VmHWM）
+std::size_t statusKb(const char* field) {
+    std::ifstream status("/proc/self/status");
+    const std::string prefix = std::string(field) + ":";
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, prefix.size(), prefix) == 0) {
+            return static_cast<std::size_t>(std::stoull(line.substr(line.find_first_of("0123456789"))));
+        }
+    }
+    return 0;
+}
+
+long long fileSize(const char* path) {
+    struct stat st {};
+    return stat(path, &st) == 0 ? static_cast<long long>(st.st_size) : -1;
+}
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--idle-ms 1000] [--flow FILE] [--path FILE] [--label name] [--output FILE|-]" << std::endl;
+        return 1;
+    }
+    const std::size_t rssAtMainKb = statusKb("VmRSS");
+    if (opt.flow.empty()) {
+        std::ofstream out(opt.path, std::ios::binary | std::ios::trunc);
+        out << kDefaultFlow;
+        opt.flow = opt.path;
+    }
+
+    // 节点的启动摘要不计入结果输出；警告及以上仍然打印
+    AsyncLogger::instance().setLevel(LogSeverity::Warn);
+    NullBuffer nullBuffer;
+    std::streambuf* savedCout = std::cout.rdbuf(&nullBuffer);
+
+    auto t0 = std::chrono::steady_clock::now();
+    NodeFactory::initializeDefaultTypes();
+    const double registryMs = msSince(t0);
+    const std::size_t nodeTypes = NodeFactory::getRegisteredTypes().size();
+
+    FlowExecutor executor;
+    auto t1 = std::chrono::steady_clock::now();
+    const bool loaded = executor.loadFlowFromFile(opt.flow);
+    const double loadMs = msSince(t1);
+    auto t2 = std::chrono::steady_clock::now();
+    const bool started = loaded && executor.start();
+    const double startMs = msSince(t2);
+    const std::size_t rssStartedKb = statusKb("VmRSS");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(opt.idleMs));
+    const std::size_t rssIdleKb = statusKb("VmRSS");
+    const std::size_t peakRssKb = statusKb("VmHWM");
+    if (started) executor.stop();
+    std::cout.rdbuf(savedCout);
+    if (opt.flow == opt.path) std::remove(opt.path.c_str());
+
+    if (!started) {
+        std::cerr << "Flow " << (loaded ? "start" : "load") << " failed (" << nodeTypes
+                  << " node types registered; use --flow for flows matching FALCONMINDSDK_NODE_TYPES)" << std::endl;
+        return 1;
+    }
+
+    json report = {
+        {"benchmark", "footprint"},
+        {"label", opt.label},
+        {"profile", FALCONMINDSDK_PROFILE_NAME},
+        {"toolchain", {{"compiler", __VERSION__}}},
+        {"results",
+         {{"binary_bytes", fileSize("/proc/self/exe")},
+          {"node_types", nodeTypes},
+          {"startup_ms",
+           {{"node_registry", registryMs},
+            {"flow_load", loadMs},
+            {"flow_start", startMs},
+            {"total", registryMs + loadMs + startMs}}},
+          {"rss_kb",
+           {{"at_main", rssAtMainKb}, {"started", rssStartedKb}, {"idle", rssIdleKb}, {"peak", peakRssKb}}}}}};
+
+    std::string text = report.dump(2);
+    if (opt.output == "-") {
+        std::cout << text << std::endl;
+    } else {
+        std::ofstream out(opt.output);
+        if (!out.is_open()) {
+            std::cerr << "Cannot write " << opt.output << std::endl;
+            return 1;
+        }
+        out << text << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,500 @@
+// Kernel microbenchmark: 感知与核心原语的单次调用耗时、cycles/byte 与每次调用的堆分配次数
+//
+// 覆盖 resizeImageToFloatNchw、decodeYoloOutput84xN、nmsYoloDetections、YUYV→RGB、gamma 查表、
+// SORT / Simple 跟踪器 run（按目标数）、Pad::pushToConnections 扇出与 serializeDetectionResult。
+// 字节数为内核读写的数据量（原地查表计读写两次）。每个样本连续调用 batch 次（按首次耗时凑满约 200µs，
+// 避免计时 / 读计数器开销淹没微秒级内核），取样本中位数。
+//
+// 周期来源依次为：perf_event CPU 周期（真实板卡，同时输出每次调用的指令数 / IPC、L1D / LLC 缺失、分支预测失败与
+// 上下文切换，见 core/PerfCounters.h）；x86 TSC（QEMU TCG、容器禁用 perf 时，为标称频率周期）；
+// --cpu-ghz 按耗时换算；都不可用时不输出 cycles。分配次数由本程序替换的全局 operator new 统计，
+// 稳态热路径应为 0。在 examples/qemu 虚拟机或 arm64 板卡上直接运行，JSON 可与 x86 结果逐项对比。
+//
+// 用法: falconmind_kernel_benchmark [--width 1920] [--height 1080] [--boxes 8400] [--candidates 1000]
+//       [--targets 10,100,500] [--fanout 1,4,16] [--iterations 30] [--filter SUBSTR] [--cpu-ghz GHZ]
+//       [--output FILE|-]
+// 退出码: 0 正常；1 参数错误或内核输出校验失败
+
+#include "falconmind/sdk/core/CpuFeatures.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PerfCounters.h"
+#include "falconmind/sdk/perception/DetectionResultPacket.h"
+#include "falconmind/sdk/perception/LowLightEnhance.h"
+#include "falconmind/sdk/perception/SimpleTrackerBackend.h"
+#include "falconmind/sdk/perception/SortTrackerBackend.h"
+#include "falconmind/sdk/perception/YoloPrePostProcess.h"
+#include "falconmind/sdk/sensors/ColorConvert.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace falconmind::sdk;
+using nlohmann::json;
+
+// 全局分配计数：基准只关心调用次数，释放直接转给 free
+namespace {
+std::atomic<std::uint64_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Options {
+    int width{1920};
+    int height{1080};
+    std::size_t boxes{8400};
+    std::size_t candidates{1000};
+    std::vector<std::size_t> targets{10, 100, 500};
+    std::vector<std::size_t> fanout{1, 4, 16};
+    int iterations{30};
+    std::string filter;
+    double cpuGhz{0.0};
+    std::string output;  // 空则只打印表格
+};
+
+bool parseList(const std::string& value, std::vector<std::size_t>& out) {
+    out.clear();
+    std::stringstream ss(value);
+    for (std::string item; std::getline(ss, item, ',');) {
+        if (!item.empty()) out.push_back(static_cast<std::size_t>(std::stoul(item)));
+    }
+    return !out.empty() && std::find(out.begin(), out.end(), std::size_t{0}) == out.end();
+}
+
+bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if (arg == "--width") {
+            opt.width = std::stoi(value);
+        } else if (arg == "--height") {
+            opt.height = std::stoi(value);
+        } else if (arg == "--boxes") {
+            opt.boxes = static_cast<std::size_t>(std::stoul(value));
+        } else if (arg == "--candidates") {
+            opt.candidates = static_cast<std::size_t>(std::stoul(value));
+        } else if (arg == "--targets") {
+            if (!parseList(value, opt.targets)) return false;
+        } else if (arg == "--fanout") {
+            if (!parseList(value, opt.fanout)) return false;
+        } else if (arg == "--iterations") {
+            opt.iterations = std::stoi(value);
+        } else if (arg == "--filter") {
+            opt.filter = value;
+        } else if (arg == "--cpu-ghz") {
+            opt.cpuGhz = std::stod(value);
+        } else if (arg == "--output") {
+            opt.output = value;
+        } else {
+            return false;
+        }
+    }
+    return opt.width >= 2 && opt.height >= 2 && opt.boxes > 0 && opt.candidates > 0 && opt.iterations > 0 &&
+           opt.cpuGhz >= 0.0;
+}
+
+// 周期来源：perf_event 计数器组（同时给出指令、缓存 / 分支缺失）→ x86 TSC → 无
+class CycleCounter {
+public:
+    CycleCounter() { perf_.open(); }
+
+    const char* source() const noexcept {
+        if (perfCycles()) return "perf";
+#if defined(__x86_64__) || defined(__i386__)
+        return "tsc";
+#else
+        return "none";
+#endif
+    }
+    bool available() const noexcept { return std::string(source()) != "none"; }
+    bool perfCycles() const noexcept { return (perf_.available() >> static_cast<unsigned>(core::PerfCounter::Cycles)) & 1u; }
+    const core::PerfCounterGroup& perf() const noexcept { return perf_; }
+
+    // 采样：perf 计数（不可用时全 0）与周期值
+    void sample(core::PerfCounterValues& values, std::uint64_t& cycles) const noexcept {
+        if (!perf_.read(values)) values = core::PerfCounterValues{};
+        if (perfCycles()) {
+            cycles = values[core::PerfCounter::Cycles];
+            return;
+        }
+#if defined(__x86_64__) || defined(__i386__)
+        cycles = __rdtsc();
+#else
+        cycles = 0;
+#endif
+    }
+
+private:
+    core::PerfCounterGroup perf_;
+};
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+struct KernelResult {
+    std::string name;
+    std::size_t bytesPerCall{0};
+    std::size_t items{0};  // 每次调用处理的框 / 目标 / 接收方数，无意义时为 0
+    std::size_t batch{1};
+    double nsPerCall{0.0};
+    double cyclesPerCall{-1.0};  // <0 为不可用
+    double allocsPerCall{0.0};
+    core::PerfCounterValues perf;  // 全部样本的累计计数
+    double calls{0.0};             // perf 对应的调用次数
+};
+
+class Runner {
+public:
+    Runner(const Options& opt, const CycleCounter& cycles) : opt_(opt), cycles_(cycles) {}
+
+    bool selected(const std::string& name) const {
+        return opt_.filter.empty() || name.find(opt_.filter) != std::string::npos;
+    }
+
+    // 先调用一次预热并按其耗时确定 batch，之后每个样本计时 batch 次调用
+    void run(const std::string& name, std::size_t bytesPerCall, std::size_t items, const std::function<void()>& fn) {
+        if (!selected(name)) return;
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        const double firstNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        const std::size_t batch =
+            static_cast<std::size_t>(std::clamp(200000.0 / std::max(firstNs, 1.0), 1.0, 100000.0));
+
+        std::vector<double> ns, cyc;
+        ns.reserve(static_cast<std::size_t>(opt_.iterations));
+        cyc.reserve(static_cast<std::size_t>(opt_.iterations));
+        core::PerfCounterValues perfTotal, p0, p1;
+        std::uint64_t c0 = 0, c1 = 0;
+        const std::uint64_t allocs0 = g_allocations.load(std::memory_order_relaxed);
+        for (int i = 0; i < opt_.iterations; ++i) {
+            cycles_.sample(p0, c0);
+            auto s0 = std::chrono::steady_clock::now();
+            for (std::size_t b = 0; b < batch; ++b) fn();
+            auto s1 = std::chrono::steady_clock::now();
+            cycles_.sample(p1, c1);
+            ns.push_back(std::chrono::duration<double, std::nano>(s1 - s0).count() / static_cast<double>(batch));
+            cyc.push_back(static_cast<double>(c1 - c0) / static_cast<double>(batch));
+            perfTotal += p1 - p0;
+        }
+        // ns / cyc 已预留，循环内的 push_back 不产生分配
+        const std::uint64_t allocs = g_allocations.load(std::memory_order_relaxed) - allocs0;
+
+        KernelResult r;
+        r.name = name;
+        r.bytesPerCall = bytesPerCall;
+        r.items = items;
+        r.batch = batch;
+        r.nsPerCall = median(ns);
+        if (cycles_.available()) {
+            r.cyclesPerCall = median(cyc);
+        } else if (opt_.cpuGhz > 0.0) {
+            r.cyclesPerCall = r.nsPerCall * opt_.cpuGhz;
+        }
+        r.calls = static_cast<double>(batch) * opt_.iterations;
+        r.allocsPerCall = static_cast<double>(allocs) / r.calls;
+        r.perf = perfTotal;
+        results_.push_back(std::move(r));
+    }
+
+    const std::vector<KernelResult>& results() const noexcept { return results_; }
+
+private:
+    static double median(std::vector<double>& v) {
+        std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+        return v[v.size() / 2];
+    }
+
+    const Options& opt_;
+    const CycleCounter& cycles_;
+    std::vector<KernelResult> results_;
+};
+
+std::uint32_t nextRandom(std::uint32_t& seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+float nextUnit(std::uint32_t& seed) { return static_cast<float>(nextRandom(seed)) / 16777216.0f; }
+
+// 与 nms_benchmark 相同的聚簇候选：每 6 个候选围绕同一目标抖动
+std::vector<perception::YoloRawDet> makeCandidates(std::size_t n, std::uint32_t seed) {
+    std::vector<perception::YoloRawDet> raw(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t cluster = i / 6;
+        raw[i].x = static_cast<float>(cluster % 40) * 16.f + nextUnit(seed) * 5.f;
+        raw[i].y = static_cast<float>((cluster / 40) % 40) * 16.f + nextUnit(seed) * 5.f;
+        raw[i].w = 8.f + nextUnit(seed) * 12.f;
+        raw[i].h = 8.f + nextUnit(seed) * 12.f;
+        raw[i].score = 0.25f + nextUnit(seed) * 0.75f;
+        raw[i].classId = static_cast<int>(nextUnit(seed) * 4.f) % 4;
+    }
+    return raw;
+}
+
+// 目标数 n 的匀速运动序列：frames 帧，目标在 1920x1080 网格上互不重叠，逐帧平移
+std::vector<perception::DetectionResult> makeTrackFrames(std::size_t n, std::size_t frames) {
+    const std::size_t cols = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(n) * 16.0 / 9.0)));
+    const float cell = 1920.f / static_cast<float>(cols);
+    std::vector<perception::DetectionResult> out(frames);
+    for (std::size_t f = 0; f < frames; ++f) {
+        auto& r = out[f];
+        r.frameIndex = static_cast<std::uint32_t>(f);
+        r.timestampNs = static_cast<std::uint64_t>(f) * 33333333ull;
+        r.detections.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            auto& d = r.detections[i];
+            d.bbox.x = static_cast<float>(i % cols) * cell + static_cast<float>(f) * 0.5f;
+            d.bbox.y = static_cast<float>(i / cols) * cell + static_cast<float>(f) * 0.25f;
+            d.bbox.width = cell * 0.5f;
+            d.bbox.height = cell * 0.5f;
+            d.score = 0.9f;
+            d.classId = static_cast<int>(i % 4);
+        }
+    }
+    return out;
+}
+
+template <typename Tracker>
+bool benchTracker(Runner& runner, const std::string& prefix, std::size_t n) {
+    const std::string name = prefix + "_run_" + std::to_string(n);
+    if (!runner.selected(name)) return true;
+    // 循环播放 16 帧：回到第 0 帧时跳变较大，相当于周期性的重新关联，两种跟踪器都按此计入
+    auto frames = makeTrackFrames(n, 16);
+    Tracker tracker;
+    if (!tracker.load()) return false;
+    perception::TrackingResult tracks;
+    std::size_t f = 0;
+    for (std::size_t i = 0; i < frames.size(); ++i) tracker.run(frames[i], tracks);
+    const bool tracked = !tracks.tracks.empty();
+    runner.run(name, n * sizeof(perception::DetectionBBox), n, [&] {
+        tracker.run(frames[f], tracks);
+        f = (f + 1) % frames.size();
+    });
+    return tracked;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--width 1920] [--height 1080] [--boxes 8400] [--candidates 1000] [--targets 10,100,500]"
+                     " [--fanout 1,4,16] [--iterations 30] [--filter SUBSTR] [--cpu-ghz GHZ] [--output FILE|-]"
+                  << std::endl;
+        return 1;
+    }
+    CycleCounter cycles;
+    Runner runner(opt, cycles);
+    // 跟踪器 load() 等日志写 stdout，测量期间屏蔽，避免混入 --output - 的 JSON
+    NullBuffer nullBuffer;
+    std::streambuf* savedCout = std::cout.rdbuf(&nullBuffer);
+    bool ok = true;
+    auto check = [&ok](bool cond, const char* what) {
+        if (!cond) {
+            std::cerr << "Check failed: " << what << std::endl;
+            ok = false;
+        }
+    };
+
+    const int w = opt.width & ~1;  // YUYV 按像素对
+    const int h = opt.height;
+    const std::size_t pixels = static_cast<std::size_t>(w) * h;
+    std::uint32_t seed = 12345u;
+
+    // 前处理：RGB → 640x640 NCHW float
+    std::vector<std::uint8_t> rgb(pixels * 3);
+    for (auto& v : rgb) v = static_cast<std::uint8_t>(nextRandom(seed));
+    std::vector<float> tensor(3 * 640 * 640);
+    runner.run("resize_nchw_" + std::to_string(w) + "x" + std::to_string(h),
+               rgb.size() + tensor.size() * sizeof(float), 0, [&] {
+        perception::resizeImageToFloatNchw(rgb.data(), w, h, w * 3, false, tensor.data(), 640, 640);
+    });
+    if (runner.selected("resize_nchw")) {
+        check(std::all_of(tensor.begin(), tensor.end(), [](float v) { return v >= 0.f && v <= 1.f; }),
+              "resize_nchw output in [0,1]");
+    }
+
+    // 后处理：84 x boxes 输出头，每 16 个框一个过阈值目标
+    const std::size_t channels = 84;
+    std::vector<float> head(channels * opt.boxes, -8.f);
+    for (std::size_t j = 0; j < opt.boxes; ++j) {
+        head[0 * opt.boxes + j] = static_cast<float>(j % 80) * 8.f;
+        head[1 * opt.boxes + j] = static_cast<float>(j / 80 % 80) * 8.f;
+        head[2 * opt.boxes + j] = 12.f;
+        head[3 * opt.boxes + j] = 12.f;
+        if (j % 16 == 0) head[(4 + j % 80) * opt.boxes + j] = 2.f;
+    }
+    std::vector<perception::YoloRawDet> decoded;
+    decoded.reserve(opt.boxes);
+    runner.run("decode_yolo_84x" + std::to_string(opt.boxes), head.size() * sizeof(float), opt.boxes, [&] {
+        perception::decodeYoloOutput84xN(head.data(), channels, opt.boxes, 80, 0.25f, decoded);
+    });
+    if (runner.selected("decode_yolo")) {
+        check(decoded.size() == (opt.boxes + 15) / 16, "decode_yolo candidate count");
+    }
+
+    const auto candidates = makeCandidates(opt.candidates, static_cast<std::uint32_t>(opt.candidates) + 1u);
+    std::vector<perception::YoloRawDet> raw;
+    std::vector<bool> suppressed;
+    perception::NmsConfig nmsCfg;
+    runner.run("nms_hard_" + std::to_string(opt.candidates), candidates.size() * sizeof(perception::YoloRawDet),
+               opt.candidates, [&] {
+                   raw = candidates;
+                   perception::nmsYoloDetections(raw, nmsCfg, suppressed);
+               });
+    if (runner.selected("nms_hard")) {
+        check(suppressed.size() == candidates.size() &&
+                  std::find(suppressed.begin(), suppressed.end(), false) != suppressed.end(),
+              "nms_hard keeps at least one box");
+    }
+
+    // 颜色转换与低照度查表
+    std::vector<std::uint8_t> yuyv(pixels * 2);
+    for (auto& v : yuyv) v = static_cast<std::uint8_t>(nextRandom(seed));
+    std::vector<std::uint8_t> converted(pixels * 3);
+    runner.run(std::string("yuyv_to_rgb_") + sensors::colorKernelName(sensors::activeColorKernel()),
+               yuyv.size() + converted.size(), 0,
+               [&] { sensors::convertYuyvToRgb(yuyv.data(), w * 2, converted.data(), w, h, false); });
+
+    std::uint8_t lut[256];
+    perception::buildGammaLut(1.8f, lut);
+    std::vector<std::uint8_t> image(rgb);
+    runner.run(std::string("gamma_lut_") + perception::lutKernelName(), image.size() * 2, 0,
+               [&] { perception::applyLutRgb(image.data(), w, h, w * 3, lut); });
+
+    // 跟踪器：不同目标数
+    for (std::size_t n : opt.targets) {
+        check(benchTracker<perception::SortTrackerBackend>(runner, "sort", n), "sort tracker produced tracks");
+        check(benchTracker<perception::SimpleTrackerBackend>(runner, "simple", n), "simple tracker produced tracks");
+    }
+
+    // Pad 扇出：一个 Source 推送 4 KiB 到 k 个同步 Sink
+    std::vector<std::uint8_t> payload(4096, 0x5a);
+    for (std::size_t k : opt.fanout) {
+        const std::string name = "pad_fanout_" + std::to_string(k);
+        if (!runner.selected(name)) continue;
+        auto src = std::make_shared<core::Pad>("out", core::PadType::Source);
+        std::vector<std::shared_ptr<core::Pad>> sinks;
+        std::uint64_t received = 0;
+        for (std::size_t i = 0; i < k; ++i) {
+            auto sink = std::make_shared<core::Pad>("in", core::PadType::Sink);
+            sink->setDataCallback([&received](const void*, size_t size) { received += size; });
+            src->connectTo(sink, "sink" + std::to_string(i), "in");
+            sinks.push_back(std::move(sink));
+        }
+        runner.run(name, payload.size() * k, k, [&] { src->pushToConnections(payload.data(), payload.size()); });
+        check(received > 0 && received % (payload.size() * k) == 0, "pad_fanout delivered to every sink");
+    }
+
+    // 检测结果序列化：100 个目标
+    perception::DetectionResult result = makeTrackFrames(100, 1).front();
+    std::vector<std::uint8_t> packet(perception::detectionResultPacketSize(result.detections.size()));
+    std::size_t written = 0;
+    runner.run("serialize_detections_100", packet.size(), result.detections.size(),
+               [&] { written = perception::serializeDetectionResult(result, packet.data(), packet.size()); });
+    if (runner.selected("serialize_detections")) check(written == packet.size(), "serialize_detections size");
+
+    std::cout.rdbuf(savedCout);
+
+    std::FILE* table = opt.output == "-" ? stderr : stdout;
+    const std::string perfEvents = core::perfCounterSummary();
+    std::fprintf(table, "cpu: %s, cycles: %s, perf: %s, %d iterations\n", core::cpuFeatureSummary().c_str(),
+                 cycles.source(), perfEvents.c_str(), opt.iterations);
+    std::fprintf(table, "%-28s %12s %10s %12s %12s %6s %12s\n", "kernel", "ns/call", "MB/s", "cycles/call",
+                 "cycles/byte", "IPC", "allocs/call");
+    json kernels = json::array();
+    for (const auto& r : runner.results()) {
+        const double mbps = r.nsPerCall > 0.0 ? static_cast<double>(r.bytesPerCall) / r.nsPerCall * 1e3 : 0.0;
+        const double cpb = r.cyclesPerCall >= 0.0 && r.bytesPerCall > 0
+                               ? r.cyclesPerCall / static_cast<double>(r.bytesPerCall)
+                               : -1.0;
+        std::fprintf(table, "%-28s %12.0f %10.1f %12.0f %12.3f %6.2f %12.2f\n", r.name.c_str(), r.nsPerCall, mbps,
+                     r.cyclesPerCall, cpb, r.perf.ipc(), r.allocsPerCall);
+        json k = {{"name", r.name},
+                  {"bytes_per_call", r.bytesPerCall},
+                  {"items", r.items},
+                  {"batch", r.batch},
+                  {"ns_per_call", r.nsPerCall},
+                  {"mb_per_s", mbps},
+                  {"allocs_per_call", r.allocsPerCall}};
+        k["cycles_per_call"] = r.cyclesPerCall >= 0.0 ? json(r.cyclesPerCall) : json(nullptr);
+        k["cycles_per_byte"] = cpb >= 0.0 ? json(cpb) : json(nullptr);
+        // 其余计数按全部样本平均到每次调用（周期取中位数，二者口径不同）
+        if (r.perf.available != 0 && r.calls > 0.0) {
+            json perf = json::object();
+            for (std::size_t i = 0; i < static_cast<std::size_t>(core::PerfCounter::Count); ++i) {
+                const auto c = static_cast<core::PerfCounter>(i);
+                if (r.perf.has(c)) perf[core::perfCounterName(c)] = static_cast<double>(r.perf[c]) / r.calls;
+            }
+            if (r.perf.ipc() >= 0.0) perf["ipc"] = r.perf.ipc();
+            k["perf_per_call"] = std::move(perf);
+        }
+        kernels.push_back(std::move(k));
+    }
+
+    if (!opt.output.empty()) {
+#if defined(__aarch64__)
+        const char* arch = "aarch64";
+#elif defined(__x86_64__)
+        const char* arch = "x86_64";
+#else
+        const char* arch = "other";
+#endif
+        json report = {{"benchmark", "kernel"},
+                       {"arch", arch},
+                       {"cpu", core::cpuFeatureSummary()},
+                       {"perf_events", perfEvents},
+                       {"cycles_source", cycles.available() ? cycles.source() : (opt.cpuGhz > 0.0 ? "cpu_ghz" : "none")},
+                       {"toolchain", {{"compiler", __VERSION__}}},
+                       {"config",
+                        {{"width", w},
+                         {"height", h},
+                         {"boxes", opt.boxes},
+                         {"candidates", opt.candidates},
+                         {"iterations", opt.iterations}}},
+                       {"results", kernels}};
+        std::string text = report.dump(2);
+        if (opt.output == "-") {
+            std::cout << text << std::endl;
+        } else {
+            std::ofstream out(opt.output);
+            if (!out.is_open()) {
+                std::cerr << "Cannot write " << opt.output << std::endl;
+                return 1;
+            }
+            out << text << std::endl;
+        }
+    }
+    return ok ? 0 : 1;
+}
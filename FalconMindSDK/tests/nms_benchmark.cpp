@@ -0,0 +1,160 @@
+// NMS microbenchmark: 原始两两比较 vs 类别分桶/SIMD IoU 的 Hard/TopK/Soft/Matrix NMS
+//
+// 对每个候选数生成聚簇的随机框（模拟拥挤航拍场景），测量单次 NMS 耗时（取多轮中位数），
+// 并校验分桶 Hard NMS 的保留集合与原始实现完全一致。
+//
+// 用法: falconmind_nms_benchmark [--counts 100,500,1000,2000,5000] [--classes 4] [--iterations 30]
+// 退出码: 0 正常；1 参数错误或 Hard NMS 结果与原始实现不一致
+
+#include "falconmind/sdk/perception/YoloPrePostProcess.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace falconmind::sdk::perception;
+
+namespace {
+
+struct Options {
+    std::vector<std::size_t> counts{100, 500, 1000, 2000, 5000};
+    int classes{4};
+    int iterations{30};
+};
+
+bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if (arg == "--counts") {
+            opt.counts.clear();
+            std::stringstream ss(value);
+            for (std::string item; std::getline(ss, item, ',');) {
+                if (!item.empty()) opt.counts.push_back(static_cast<std::size_t>(std::stoul(item)));
+            }
+        } else if (arg == "--classes") {
+            opt.classes = std::stoi(value);
+        } else if (arg == "--iterations") {
+            opt.iterations = std::stoi(value);
+        } else {
+            return false;
+        }
+    }
+    return !opt.counts.empty() && opt.classes > 0 && opt.iterations > 0;
+}
+
+template <typename Fn>
+double medianMs(int iterations, Fn&& fn) {
+    std::vector<double> samples;
+    samples.reserve(static_cast<std::size_t>(iterations));
+    for (int i = 0; i < iterations; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    return samples[samples.size() / 2];
+}
+
+std::vector<YoloRawDet> makeCandidates(std::size_t n, int classes, std::uint32_t seed) {
+    auto next = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / 16777216.0f;
+    };
+    std::vector<YoloRawDet> raw(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        // 每 6 个候选围绕同一目标抖动；目标网格铺满 640x640
+        const std::size_t cluster = i / 6;
+        raw[i].x = static_cast<float>(cluster % 40) * 16.f + next() * 5.f;
+        raw[i].y = static_cast<float>((cluster / 40) % 40) * 16.f + next() * 5.f;
+        raw[i].w = 8.f + next() * 12.f;
+        raw[i].h = 8.f + next() * 12.f;
+        raw[i].score = 0.25f + next() * 0.75f;
+        raw[i].classId = static_cast<int>(next() * static_cast<float>(classes)) % classes;
+    }
+    return raw;
+}
+
+// 优化前的实现：全体候选按分数排序后两两比较，逐对计算 IoU
+void referenceNms(const std::vector<YoloRawDet>& raw, float thr, std::vector<bool>& suppressed) {
+    suppressed.assign(raw.size(), false);
+    std::vector<std::size_t> order(raw.size());
+    for (std::size_t i = 0; i < raw.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&raw](std::size_t a, std::size_t b) { return raw[a].score > raw[b].score; });
+    for (std::size_t ii = 0; ii < order.size(); ++ii) {
+        if (suppressed[order[ii]]) continue;
+        const auto& a = raw[order[ii]];
+        for (std::size_t kk = ii + 1; kk < order.size(); ++kk) {
+            if (suppressed[order[kk]]) continue;
+            const auto& b = raw[order[kk]];
+            if (a.classId != b.classId) continue;
+            const float w = std::max(0.f, std::min(a.x + a.w, b.x + b.w) - std::max(a.x, b.x));
+            const float h = std::max(0.f, std::min(a.y + a.h, b.y + b.h) - std::max(a.y, b.y));
+            const float inter = w * h;
+            if (inter / (a.w * a.h + b.w * b.h - inter) > thr) suppressed[order[kk]] = true;
+        }
+    }
+}
+
+std::size_t kept(const std::vector<bool>& suppressed) {
+    return static_cast<std::size_t>(std::count(suppressed.begin(), suppressed.end(), false));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        std::cerr << "Usage: " << argv[0] << " [--counts 100,500,1000,2000,5000] [--classes 4] [--iterations 30]"
+                  << std::endl;
+        return 1;
+    }
+    std::printf("%d classes, %d iterations, IoU 0.45\n", opt.classes, opt.iterations);
+    std::printf("%8s %12s %10s %10s %10s %10s %10s %8s\n", "boxes", "reference ms", "hard ms", "top300 ms", "soft ms",
+                "matrix ms", "speedup", "kept");
+    bool ok = true;
+    for (std::size_t n : opt.counts) {
+        const auto candidates = makeCandidates(n, opt.classes, static_cast<std::uint32_t>(n) + 1u);
+        std::vector<bool> refSuppressed, suppressed;
+        const double refMs = medianMs(opt.iterations, [&] { referenceNms(candidates, 0.45f, refSuppressed); });
+
+        NmsConfig cfg;
+        std::vector<YoloRawDet> raw;
+        const double hardMs = medianMs(opt.iterations, [&] {
+            raw = candidates;
+            nmsYoloDetections(raw, cfg, suppressed);
+        });
+        const bool match = suppressed == refSuppressed;
+        const std::size_t hardKept = kept(suppressed);
+
+        cfg.topK = 300;
+        const double topKMs = medianMs(opt.iterations, [&] {
+            raw = candidates;
+            nmsYoloDetections(raw, cfg, suppressed);
+        });
+        cfg.topK = 0;
+        cfg.scoreThreshold = 0.25f;
+        cfg.method = NmsMethod::Soft;
+        const double softMs = medianMs(opt.iterations, [&] {
+            raw = candidates;
+            nmsYoloDetections(raw, cfg, suppressed);
+        });
+        cfg.method = NmsMethod::Matrix;
+        const double matrixMs = medianMs(opt.iterations, [&] {
+            raw = candidates;
+            nmsYoloDetections(raw, cfg, suppressed);
+        });
+
+        std::printf("%8zu %12.3f %10.3f %10.3f %10.3f %10.3f %9.2fx %8zu%s\n", n, refMs, hardMs, topKMs, softMs, matrixMs,
+                    hardMs > 0.0 ? refMs / hardMs : 0.0, hardKept, match ? "" : "  MISMATCH");
+        ok = ok && match;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,533 @@
+// Pipeline benchmark: synthetic camera -> low_light_adaptation -> detector -> tracker -> event_reporter
+//
+// 以合成帧源驱动代表性感知链路，统计持续帧率、逐跳端到端时延分位数、各节点 CPU 占用与 RSS 曲线，
+// 输出 JSON 供发布流水线做回归门禁（x86 / arm64 交叉编译产物均可运行）。
+// 每个节点另给出每帧入 / 出字节数；--perf 时按节点累计 process() 期间的硬件计数（周期、指令、L1D/LLC 缺失、
+// 分支预测失败、上下文切换），输出 IPC 与每帧计数，用于区分访存型与计算型节点（如 A76 / A55 核上的差异）。
+//
+// 用法: falconmind_pipeline_benchmark [--width 640] [--height 480] [--fps 30] [--duration-ms 10000]
+//         [--warmup-ms 1000] [--sample-ms 1000] [--brightness 40] [--workers 0] [--queue] [--perf]
+//         [--label name] [--output result.json|-] [--baseline base.json] [--max-regression-pct 10] [--verbose]
+// 退出码: 0 正常；1 参数/运行错误；2 相对 baseline 回归超限
+
+#include "falconmind/sdk/core/BufferPool.h"
+#include "falconmind/sdk/core/CpuFeatures.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/Pad.h"
+#include "falconmind/sdk/core/PerfCounters.h"
+#include "falconmind/sdk/core/Pipeline.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/core/PipelineMetrics.h"
+#include "falconmind/sdk/mission/EventReporterNode.h"
+#include "falconmind/sdk/perception/DetectionResultPacket.h"
+#include "falconmind/sdk/perception/DummyDetectionNode.h"
+#include "falconmind/sdk/perception/IDetectorBackend.h"
+#include "falconmind/sdk/perception/LowLightAdaptationNode.h"
+#include "falconmind/sdk/perception/SimpleTrackerBackend.h"
+#include "falconmind/sdk/perception/TrackingTransformNode.h"
+#include "falconmind/sdk/sensors/CameraFramePacket.h"
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+using namespace falconmind::sdk;
+using namespace falconmind::sdk::core;
+using falconmind::sdk::sensors::CameraFramePacket;
+using nlohmann::json;
+
+namespace {
+
+struct Options {
+    int width{640};
+    int height{480};
+    double fps{30.0};
+    int durationMs{10000};
+    int warmupMs{1000};
+    int sampleMs{1000};
+    int brightness{40};          // 合成帧平均亮度，低于 low_light_adaptation 阈值时走增强路径
+    std::size_t workers{0};
+    bool queue{false};           // 链路使用 keep-latest 队列（默认直连）
+    bool perf{false};            // 按节点统计 perf_event 硬件计数
+    std::string label{"default"};
+    std::string output{"-"};
+    std::string baseline;
+    double maxRegressionPct{10.0};
+    bool verbose{false};
+};
+
+bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        auto eq = arg.find('=');
+        if (eq != std::string::npos) {
+            value = arg.substr(eq + 1);
+            arg = arg.substr(0, eq);
+        }
+        auto next = [&](std::string& out) {
+            if (!value.empty()) {
+                out = value;
+                return true;
+            }
+            if (i + 1 >= argc) return false;
+            out = argv[++i];
+            return true;
+        };
+        std::string v;
+        try {
+            if (arg == "--queue") {
+                opt.queue = true;
+            } else if (arg == "--perf") {
+                opt.perf = true;
+            } else if (arg == "--verbose") {
+                opt.verbose = true;
+            } else if (arg == "--width" && next(v)) {
+                opt.width = std::stoi(v);
+            } else if (arg == "--height" && next(v)) {
+                opt.height = std::stoi(v);
+            } else if (arg == "--fps" && next(v)) {
+                opt.fps = std::stod(v);
+            } else if (arg == "--duration-ms" && next(v)) {
+                opt.durationMs = std::stoi(v);
+            } else if (arg == "--warmup-ms" && next(v)) {
+                opt.warmupMs = std::stoi(v);
+            } else if (arg == "--sample-ms" && next(v)) {
+                opt.sampleMs = std::stoi(v);
+            } else if (arg == "--brightness" && next(v)) {
+                opt.brightness = std::stoi(v);
+            } else if (arg == "--workers" && next(v)) {
+                opt.workers = static_cast<std::size_t>(std::stoul(v));
+            } else if (arg == "--label" && next(v)) {
+                opt.label = v;
+            } else if (arg == "--output" && next(v)) {
+                opt.output = v;
+            } else if (arg == "--baseline" && next(v)) {
+                opt.baseline = v;
+            } else if (arg == "--max-regression-pct" && next(v)) {
+                opt.maxRegressionPct = std::stod(v);
+            } else {
+                std::cerr << "Unknown or incomplete option: " << argv[i] << std::endl;
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << v << std::endl;
+            return false;
+        }
+    }
+    return opt.width > 0 && opt.height > 0 && opt.fps > 0.0 && opt.durationMs > 0 && opt.sampleMs > 0;
+}
+
+std::size_t currentRssKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmRSS:") == 0) {
+            return static_cast<std::size_t>(std::stoull(line.substr(line.find_first_of("0123456789"))));
+        }
+    }
+    return 0;
+}
+
+double processCpuMs() {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1e3 + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e3;
+}
+
+// 合成相机：RGB8 帧，按调度周期逐帧推送；像素从预生成的模板拷贝（模拟驱动出帧的一次拷贝）
+class SyntheticFrameSource : public Node {
+public:
+    SyntheticFrameSource(int width, int height, int fps, int brightness)
+        : Node("synthetic_frame_source")
+        , caps_{PixelFormat::RGB8, width, height, fps} {
+        Caps caps;
+        caps.addVideo(caps_);
+        auto pad = std::make_shared<Pad>("video_out", PadType::Source);
+        pad->setCaps(caps);
+        out_ = addPad(pad);
+
+        std::size_t stride = static_cast<std::size_t>(width) * 3;
+        pixels_.resize(stride * static_cast<std::size_t>(height));
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                auto* p = &pixels_[static_cast<std::size_t>(y) * stride + static_cast<std::size_t>(x) * 3];
+                int v = brightness + ((x ^ y) & 0x1f) - 16;
+                p[0] = p[1] = p[2] = static_cast<std::uint8_t>(std::min(255, std::max(0, v)));
+            }
+        }
+    }
+
+    void process() override {
+        CameraFramePacket header{};
+        header.width = caps_.width;
+        header.height = caps_.height;
+        header.stride = caps_.width * 3;
+        std::strncpy(header.format, "RGB8", sizeof(header.format) - 1);
+        header.captureTimestampNs = PipelineClock::nowNs();
+        header.frameIndex = ++frameIndex_;
+
+        BufferRef frame = pool_.acquire(BufferPoolKey{caps_.width, caps_.height, "RGB8"},
+                                        sizeof(CameraFramePacket) + pixels_.size());
+        std::uint8_t* dst = frame.mutableData();
+        std::memcpy(dst, &header, sizeof(header));
+        std::memcpy(dst + sizeof(header), pixels_.data(), pixels_.size());
+        auto& meta = frame.mutableMeta();
+        meta.timestampNs = header.captureTimestampNs;
+        meta.frameIndex = header.frameIndex;
+        meta.video = caps_;
+        out_->pushBuffer(frame);
+        generated_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::uint64_t generated() const noexcept { return generated_.load(std::memory_order_relaxed); }
+
+private:
+    VideoCaps caps_;
+    Pad* out_{nullptr};
+    BufferPool pool_;
+    std::vector<std::uint8_t> pixels_;
+    std::uint64_t frameIndex_{0};
+    std::atomic<std::uint64_t> generated_{0};
+};
+
+// 合成检测后端：按网格采样亮度（计算量随分辨率增长），输出两个随帧移动的目标
+class SyntheticDetectorBackend : public perception::IDetectorBackend {
+public:
+    perception::DetectionBackendType backendType() const override {
+        return perception::DetectionBackendType::CpuReference;
+    }
+    bool load(const perception::DetectorDescriptor&) override { return true; }
+    void unload() override {}
+    bool isLoaded() const override { return true; }
+
+    bool run(const perception::ImageView& image, perception::DetectionResult& out) override {
+        std::uint64_t sum = 0;
+        for (int y = 0; y < image.height; y += 4) {
+            const std::uint8_t* row = image.data + static_cast<std::size_t>(y) * image.stride;
+            for (int x = 0; x < image.width; x += 4) sum += row[static_cast<std::size_t>(x) * 3];
+        }
+        out.detections.clear();
+        for (int i = 0; i < 2; ++i) {
+            perception::Detection d;
+            float offset = static_cast<float>((image.frameIndex * 2 + i * 50) % 200);
+            d.bbox = {offset, offset, 40.0f, 40.0f};
+            d.score = 0.5f + static_cast<float>(sum % 50) / 100.0f;
+            d.classId = i;
+            d.className = i == 0 ? "person" : "vehicle";
+            out.detections.push_back(d);
+        }
+        return true;
+    }
+};
+
+// 空 Sink：记录采集时间戳到到达时刻的时延（帧缓冲取元数据，检测结果取包头）
+class LatencyProbeNode : public Node {
+public:
+    explicit LatencyProbeNode(bool detections) : Node("latency_probe") {
+        auto* in = addPad(std::make_shared<Pad>("in", PadType::Sink));
+        if (detections) {
+            in->setDataCallback([this](const void* data, size_t size) {
+                perception::DetectionResultView view;
+                if (view.parse(data, size)) record(static_cast<std::int64_t>(view.timestampNs()));
+            });
+        } else {
+            in->setBufferCallback([this](const BufferRef& buffer) { record(buffer.meta().timestampNs); });
+        }
+    }
+
+    const LatencyHistogram& histogram() const noexcept { return histogram_; }
+    std::uint64_t received() const noexcept { return received_.load(std::memory_order_relaxed); }
+
+private:
+    void record(std::int64_t captureNs) {
+        if (captureNs <= 0) return;  // 无源帧的占位结果
+        std::int64_t now = PipelineClock::nowNs();
+        histogram_.record(now > captureNs ? static_cast<std::uint64_t>(now - captureNs) : 0);
+        received_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    LatencyHistogram histogram_;
+    std::atomic<std::uint64_t> received_{0};
+};
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+json hopJson(const std::string& name, const LatencyHistogram& h) {
+    return {{"name", name},
+            {"count", h.count()},
+            {"p50_ms", h.percentile(0.50) / 1e6},
+            {"p90_ms", h.percentile(0.90) / 1e6},
+            {"p99_ms", h.percentile(0.99) / 1e6},
+            {"max_ms", h.max() / 1e6}};
+}
+
+const char* architecture() {
+#if defined(__aarch64__)
+    return "arm64";
+#elif defined(__x86_64__)
+    return "x86_64";
+#else
+    return "unknown";
+#endif
+}
+
+// 与 baseline 比较：帧率下降、逐跳 p99 或峰值 RSS 上升超过阈值即判为回归
+int compareWithBaseline(const json& current, const std::string& path, double maxPct) {
+    std::ifstream file(path);
+    json base = json::parse(file, nullptr, false);
+    if (!file.is_open() || base.is_discarded() || !base.contains("results")) {
+        std::cerr << "Cannot read baseline: " << path << std::endl;
+        return 1;
+    }
+    const json& b = base["results"];
+    const json& c = current["results"];
+    double factor = maxPct / 100.0;
+    int regressions = 0;
+    auto fail = [&regressions](const std::string& what, double baseValue, double value) {
+        std::cerr << "REGRESSION " << what << ": baseline=" << baseValue << " current=" << value << std::endl;
+        ++regressions;
+    };
+    double baseFps = b.value("sustained_fps", 0.0);
+    double fps = c.value("sustained_fps", 0.0);
+    if (baseFps > 0.0 && fps < baseFps * (1.0 - factor)) fail("sustained_fps", baseFps, fps);
+    double baseRss = b.value("peak_rss_kb", 0.0);
+    double rss = c.value("peak_rss_kb", 0.0);
+    if (baseRss > 0.0 && rss > baseRss * (1.0 + factor)) fail("peak_rss_kb", baseRss, rss);
+    for (const auto& hop : c.value("hops", json::array())) {
+        for (const auto& baseHop : b.value("hops", json::array())) {
+            if (baseHop.value("name", "") != hop.value("name", "")) continue;
+            double baseP99 = baseHop.value("p99_ms", 0.0);
+            double p99 = hop.value("p99_ms", 0.0);
+            if (baseP99 > 0.0 && p99 > baseP99 * (1.0 + factor)) fail("hop " + hop.value("name", "") + " p99_ms", baseP99, p99);
+        }
+    }
+    return regressions > 0 ? 2 : 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--width N] [--height N] [--fps F] [--duration-ms N] [--warmup-ms N] [--sample-ms N]"
+                     " [--brightness N] [--workers N] [--queue] [--perf] [--label S] [--output FILE|-]"
+                     " [--baseline FILE] [--max-regression-pct P] [--verbose]"
+                  << std::endl;
+        return 1;
+    }
+
+    // 节点逐帧日志会主导耗时，默认静默，结束后恢复
+    NullBuffer nullBuffer;
+    std::streambuf* savedCout = opt.verbose ? nullptr : std::cout.rdbuf(&nullBuffer);
+    const LogSeverity savedLogLevel = AsyncLogger::instance().level();
+    if (!opt.verbose) AsyncLogger::instance().setLevel(LogSeverity::Warn);
+
+    Pipeline pipeline(PipelineConfig{"pipeline_benchmark", "Pipeline benchmark", opt.label, 0});
+    auto camera = std::make_shared<SyntheticFrameSource>(opt.width, opt.height, static_cast<int>(opt.fps + 0.5),
+                                                         opt.brightness);
+    camera->setId("camera");
+    auto lowLight = std::make_shared<perception::LowLightAdaptationNode>();
+    lowLight->setId("low_light");
+    auto detector = std::make_shared<perception::DummyDetectionNode>();
+    detector->setId("detector");
+    detector->setBackend(std::make_shared<SyntheticDetectorBackend>());
+    auto tracker = std::make_shared<perception::TrackingTransformNode>();
+    tracker->setId("tracker");
+    auto trackerBackend = std::make_shared<perception::SimpleTrackerBackend>();
+    trackerBackend->load();
+    tracker->setBackend(trackerBackend);
+    auto reporter = std::make_shared<mission::EventReporterNode>();
+    reporter->setId("event_reporter");
+    auto frameProbe = std::make_shared<LatencyProbeNode>(false);
+    frameProbe->setId("probe_low_light");
+    auto detectionProbe = std::make_shared<LatencyProbeNode>(true);
+    detectionProbe->setId("probe_detector");
+
+    for (const auto& node : std::vector<std::shared_ptr<Node>>{camera, lowLight, detector, tracker, reporter,
+                                                               frameProbe, detectionProbe}) {
+        pipeline.addNode(node);
+    }
+    LinkQueueConfig queue;
+    if (opt.queue) queue.backpressure = LinkBackpressure::KeepLatest;
+    bool linked = pipeline.link("camera", "video_out", "low_light", "image_in", queue) &&
+                  pipeline.link("low_light", "image_out", "detector", "video_in", queue) &&
+                  pipeline.link("low_light", "image_out", "probe_low_light", "in") &&
+                  pipeline.link("detector", "detection_out", "tracker", "detection_in", queue) &&
+                  pipeline.link("detector", "detection_out", "probe_detector", "in") &&
+                  pipeline.link("tracker", "tracking_out", "event_reporter", "events");
+    if (!linked) {
+        if (savedCout) std::cout.rdbuf(savedCout);
+        std::cerr << "Failed to build benchmark pipeline" << std::endl;
+        return 1;
+    }
+
+    PipelineSchedulerConfig sched;
+    sched.workerThreads = opt.workers;
+    sched.sourcePeriod = std::chrono::microseconds(static_cast<std::int64_t>(1e6 / opt.fps));
+    sched.cpuAccounting = true;
+    sched.perfCounters = opt.perf;
+    pipeline.scheduler().setConfig(sched);
+    if (!pipeline.setState(PipelineState::Playing)) {
+        if (savedCout) std::cout.rdbuf(savedCout);
+        std::cerr << "Failed to start benchmark pipeline" << std::endl;
+        return 1;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(opt.warmupMs));
+    // 测量窗口起点：计数取差值；时延直方图自启动累计（含预热，影响可忽略）
+    std::uint64_t generatedStart = camera->generated();
+    std::uint64_t detectedStart = detectionProbe->received();
+    std::unordered_map<std::string, double> cpuStart;
+    std::unordered_map<std::string, std::uint64_t> processStart;
+    std::unordered_map<std::string, PerfCounterValues> perfStart;
+    const PipelineMetrics startMetrics = pipeline.metrics();
+    for (const auto& n : startMetrics.nodes) {
+        cpuStart[n.nodeId] = n.cpuMs;
+        processStart[n.nodeId] = n.processCount;
+        perfStart[n.nodeId] = n.perf;
+    }
+    double processCpuStart = processCpuMs();
+    auto begin = std::chrono::steady_clock::now();
+
+    json rssSamples = json::array();
+    std::size_t peakRss = 0;
+    for (;;) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+        std::size_t rss = currentRssKb();
+        peakRss = std::max(peakRss, rss);
+        rssSamples.push_back({{"t_ms", elapsed.count()}, {"rss_kb", rss}});
+        if (elapsed.count() >= opt.durationMs) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::min<long>(opt.sampleMs, opt.durationMs - elapsed.count())));
+    }
+    double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    PipelineMetrics metrics = pipeline.metrics();
+    std::uint64_t generated = camera->generated() - generatedStart;
+    std::uint64_t detected = detectionProbe->received() - detectedStart;
+    double processCpu = processCpuMs() - processCpuStart;
+    pipeline.setState(PipelineState::Null);
+    if (savedCout) std::cout.rdbuf(savedCout);
+    AsyncLogger::instance().setLevel(savedLogLevel);
+
+    // 测量窗口内各节点的入 / 出连接字节数（连接计数为累计值，按起点快照取差）
+    std::unordered_map<std::string, std::uint64_t> inBytes, outBytes;
+    for (const auto& l : metrics.links) {
+        std::uint64_t bytes = l.bytes;
+        for (const auto& s : startMetrics.links) {
+            if (s.srcNodeId == l.srcNodeId && s.srcPadName == l.srcPadName && s.dstNodeId == l.dstNodeId &&
+                s.dstPadName == l.dstPadName) {
+                bytes -= std::min(bytes, s.bytes);
+            }
+        }
+        inBytes[l.dstNodeId] += bytes;
+        outBytes[l.srcNodeId] += bytes;
+    }
+
+    json nodes = json::array();
+    for (const auto& n : metrics.nodes) {
+        double cpu = n.cpuMs - cpuStart[n.nodeId];
+        const std::uint64_t processed = n.processCount - processStart[n.nodeId];
+        const double perCall = processed > 0 ? 1.0 / static_cast<double>(processed) : 0.0;
+        json node = {{"node_id", n.nodeId},
+                     {"process_count", n.processCount},
+                     {"process_p50_us", n.p50Us},
+                     {"process_p99_us", n.p99Us},
+                     {"cpu_ms", cpu},
+                     {"cpu_pct", wallMs > 0.0 ? cpu / wallMs * 100.0 : 0.0},
+                     {"in_bytes_per_frame", static_cast<double>(inBytes[n.nodeId]) * perCall},
+                     {"out_bytes_per_frame", static_cast<double>(outBytes[n.nodeId]) * perCall}};
+        const PerfCounterValues perf = n.perf - perfStart[n.nodeId];
+        if (perf.available != 0) {
+            // 每帧计数按 process() 次数平均；cycles_per_byte 以入 + 出字节计，衡量布局转换 / SIMD 内核的访存效率
+            json counters = json::object();
+            json perFrame = json::object();
+            for (std::size_t i = 0; i < static_cast<std::size_t>(PerfCounter::Count); ++i) {
+                const auto c = static_cast<PerfCounter>(i);
+                if (!perf.has(c)) continue;
+                counters[perfCounterName(c)] = perf[c];
+                perFrame[perfCounterName(c)] = static_cast<double>(perf[c]) * perCall;
+            }
+            counters["per_frame"] = std::move(perFrame);
+            if (perf.ipc() >= 0.0) counters["ipc"] = perf.ipc();
+            const std::uint64_t bytes = inBytes[n.nodeId] + outBytes[n.nodeId];
+            if (perf.has(PerfCounter::Cycles) && bytes > 0) {
+                counters["cycles_per_byte"] = static_cast<double>(perf[PerfCounter::Cycles]) / static_cast<double>(bytes);
+            }
+            node["perf"] = std::move(counters);
+        }
+        nodes.push_back(std::move(node));
+    }
+    json hops = json::array();
+    hops.push_back(hopJson("camera->low_light", frameProbe->histogram()));
+    hops.push_back(hopJson("camera->detector", detectionProbe->histogram()));
+    for (const auto& n : metrics.nodes) {
+        if (n.nodeId == "tracker" && n.hasLatency) {
+            hops.push_back({{"name", "camera->tracker"},
+                            {"count", tracker->latencyTracker().stats().count},
+                            {"p50_ms", n.latencyP50Ms},
+                            {"p99_ms", n.latencyP99Ms},
+                            {"max_ms", n.latencyMaxMs}});
+        }
+    }
+
+    double seconds = wallMs / 1000.0;
+    json report = {
+        {"benchmark", "pipeline"},
+        {"label", opt.label},
+        {"toolchain", {{"arch", architecture()}, {"compiler", __VERSION__}, {"cpu_isa", cpuFeatureSummary()}}},
+        {"config",
+         {{"width", opt.width},
+          {"height", opt.height},
+          {"fps", opt.fps},
+          {"duration_ms", opt.durationMs},
+          {"warmup_ms", opt.warmupMs},
+          {"workers", opt.workers},
+          {"queue", opt.queue ? "keep_latest" : "direct"},
+          {"perf_events", opt.perf ? perfCounterSummary() : "off"}}},
+        {"results",
+         {{"frames_generated", generated},
+          {"frames_detected", detected},
+          {"source_fps", seconds > 0.0 ? generated / seconds : 0.0},
+          {"sustained_fps", seconds > 0.0 ? detected / seconds : 0.0},
+          {"detector_overwritten_frames", detector->overwrittenFrames()},
+          {"process_cpu_pct", wallMs > 0.0 ? processCpu / wallMs * 100.0 : 0.0},
+          {"peak_rss_kb", peakRss},
+          {"hops", hops},
+          {"nodes", nodes},
+          {"rss_kb", rssSamples},
+          {"pipeline_metrics", json::parse(toJson(metrics), nullptr, false)}}}};
+
+    std::string text = report.dump(2);
+    if (opt.output == "-") {
+        std::cout << text << std::endl;
+    } else {
+        std::ofstream out(opt.output);
+        if (!out.is_open()) {
+            std::cerr << "Cannot write " << opt.output << std::endl;
+            return 1;
+        }
+        out << text << std::endl;
+        std::cerr << "sustained_fps=" << report["results"]["sustained_fps"] << " written to " << opt.output
+                  << std::endl;
+    }
+
+    if (!opt.baseline.empty()) {
+        return compareWithBaseline(report, opt.baseline, opt.maxRegressionPct);
+    }
+    return 0;
+}
@@ -0,0 +1,273 @@
+// 无头回放仿真：在地面服务器上以虚拟时钟并行运行多架 UAV 的真实管线，为 ClusterCenter 的调度 / 负载均衡改动提供
+// 与机上行为一致的遥测与事件负载。
+//
+// 每个实例一个子进程（PipelineClock 的虚拟时钟为进程内全局），由 ReplayRunner 手动步进：录制数据按原始间隔回放，
+// 时间戳、节点周期与时延统计与实时运行一致，但不睡眠，墙钟耗时只取决于处理本身。--jobs 控制同时运行的进程数。
+//
+// 输入（三选一）：
+//   --flow FILE：Flow 定义（JSON）；文本中的 ${instance} 替换为实例序号（0 起），用于区分各机 ID、录制路径与上行端口，
+//                Flow 中的 replay_source 等 TimedSource 回放完毕即结束（或达到 --duration-s）
+//   --capture FILE：捕获文件（CaptureRecorderNode 录制），ReplaySourceNode → 计数汇点，衡量回放本身的开销
+//   --synthetic：生成 --frames 条、间隔 1/--fps 秒、每条 --payload 字节的捕获文件后按 --capture 运行
+//
+// 用法: falconmind_replay_sim (--flow FILE | --capture FILE | --synthetic [--frames 600] [--fps 30] [--payload 4096])
+//         [--instances 4] [--jobs 0] [--duration-s 0] [--path DIR] [--output FILE|-]
+// 退出码: 0 正常；1 参数错误或任一实例启动失败 / 未产生任何数据
+
+#include "falconmind/sdk/core/CaptureFile.h"
+#include "falconmind/sdk/core/FlowExecutor.h"
+#include "falconmind/sdk/core/Log.h"
+#include "falconmind/sdk/core/NodeFactory.h"
+#include "falconmind/sdk/core/Pipeline.h"
+#include "falconmind/sdk/core/ReplayRunner.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace falconmind::sdk;
+using nlohmann::json;
+
+namespace {
+
+struct Options {
+    std::string flow;
+    std::string capture;
+    bool synthetic{false};
+    std::size_t frames{600};
+    double fps{30.0};
+    std::size_t payload{4096};
+    int instances{4};
+    int jobs{0};               // 0 为 CPU 核数
+    double durationS{0.0};     // 0 为直到回放结束
+    std::string path{"/tmp"};  // --synthetic 捕获文件目录
+    std::string output{"-"};
+};
+
+bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--synthetic") {
+            opt.synthetic = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if (arg == "--flow") {
+            opt.flow = value;
+        } else if (arg == "--capture") {
+            opt.capture = value;
+        } else if (arg == "--frames") {
+            opt.frames = static_cast<std::size_t>(std::stoul(value));
+        } else if (arg == "--fps") {
+            opt.fps = std::stod(value);
+        } else if (arg == "--payload") {
+            opt.payload = static_cast<std::size_t>(std::stoul(value));
+        } else if (arg == "--instances") {
+            opt.instances = std::stoi(value);
+        } else if (arg == "--jobs") {
+            opt.jobs = std::stoi(value);
+        } else if (arg == "--duration-s") {
+            opt.durationS = std::stod(value);
+        } else if (arg == "--path") {
+            opt.path = value;
+        } else if (arg == "--output") {
+            opt.output = value;
+        } else {
+            return false;
+        }
+    }
+    const int inputs = (opt.flow.empty() ? 0 : 1) + (opt.capture.empty() ? 0 : 1) + (opt.synthetic ? 1 : 0);
+    return inputs == 1 && opt.instances > 0 && opt.jobs >= 0 && opt.durationS >= 0.0 &&
+           (!opt.synthetic || (opt.frames > 0 && opt.fps > 0.0 && opt.payload >= sizeof(std::uint64_t)));
+}
+
+bool writeSynthetic(const Options& opt, const std::string& path) {
+    auto writer = core::CaptureWriter::create(path);
+    if (!writer) return false;
+    std::vector<std::uint8_t> payload(opt.payload);
+    const auto intervalNs = static_cast<std::int64_t>(1e9 / opt.fps);
+    for (std::size_t i = 0; i < opt.frames; ++i) {
+        std::fill(payload.begin(), payload.end(), static_cast<std::uint8_t>(i));
+        core::BufferMeta meta;
+        meta.timestampNs = 1'000'000'000 + static_cast<std::int64_t>(i) * intervalNs;
+        meta.frameIndex = i;
+        if (!writer->append(payload.data(), payload.size(), meta)) return false;
+    }
+    return writer->close();
+}
+
+std::string replaceAll(std::string text, const std::string& from, const std::string& to) {
+    for (std::size_t pos = text.find(from); pos != std::string::npos; pos = text.find(from, pos + to.size())) {
+        text.replace(pos, from.size(), to);
+    }
+    return text;
+}
+
+// 子进程：运行一个实例，结果以一行 JSON 返回
+json runInstance(const Options& opt, const std::string& capture, int instance) {
+    core::ReplayRunnerConfig cfg;
+    cfg.maxDurationNs = static_cast<std::int64_t>(opt.durationS * 1e9);
+    core::ReplayRunner runner(cfg);
+    core::ReplayRunStats stats;
+    std::uint64_t delivered = 0;
+    std::uint64_t bytes = 0;
+
+    if (!opt.flow.empty()) {
+        core::NodeFactory::initializeDefaultTypes();
+        std::ifstream in(opt.flow);
+        std::stringstream text;
+        text << in.rdbuf();
+        core::FlowExecutor flow;
+        if (in.is_open() && flow.loadFlow(replaceAll(text.str(), "${instance}", std::to_string(instance)))) {
+            stats = runner.run(flow);
+        }
+    } else {
+        core::Pipeline pipeline(core::PipelineConfig{"replay_sim_" + std::to_string(instance), "replay_sim", "", 0});
+        auto replay = std::make_shared<core::ReplaySourceNode>(capture);
+        replay->setId("replay");
+        if (pipeline.addNode(replay) &&
+            pipeline.addPadTap("replay", "out", [&](const core::BufferRef& buffer) {
+                ++delivered;
+                bytes += buffer.size();
+            })) {
+            stats = runner.run(pipeline);
+        }
+    }
+    const bool ok = stats.started && (opt.flow.empty() ? delivered > 0 : stats.processCalls > 0);
+    return {{"instance", instance},
+            {"ok", ok},
+            {"completed", stats.completed},
+            {"virtual_s", static_cast<double>(stats.virtualNs) / 1e9},
+            {"wall_ms", static_cast<double>(stats.wallNs) / 1e6},
+            {"speedup", stats.speedup()},
+            {"steps", stats.steps},
+            {"process_calls", stats.processCalls},
+            {"buffers", delivered},
+            {"bytes", bytes}};
+}
+
+struct Child {
+    pid_t pid{-1};
+    int fd{-1};
+    int instance{0};
+};
+
+json collect(Child& child) {
+    std::string text;
+    char buf[4096];
+    for (ssize_t n; (n = ::read(child.fd, buf, sizeof(buf))) > 0;) text.append(buf, static_cast<std::size_t>(n));
+    ::close(child.fd);
+    int status = 0;
+    ::waitpid(child.pid, &status, 0);
+    json result = json::parse(text, nullptr, false);
+    if (result.is_discarded() || !WIFEXITED(status)) {
+        result = {{"instance", child.instance}, {"ok", false}};
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " (--flow FILE | --capture FILE | --synthetic [--frames 600] [--fps 30] [--payload 4096])"
+                     " [--instances 4] [--jobs 0] [--duration-s 0] [--path DIR] [--output FILE|-]"
+                  << std::endl;
+        return 1;
+    }
+    if (opt.jobs == 0) opt.jobs = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::string capture = opt.capture;
+    if (opt.synthetic) {
+        capture = opt.path + "/replay_sim_" + std::to_string(::getpid()) + ".fmcap";
+        if (!writeSynthetic(opt, capture)) {
+            std::cerr << "Cannot write " << capture << std::endl;
+            return 1;
+        }
+    }
+    // 父进程在 fork 前不初始化节点工厂、不写日志：日志写线程与节点注册都在子进程内建立
+    const auto wallBegin = std::chrono::steady_clock::now();
+    std::vector<Child> running;
+    std::vector<json> results;
+    for (int next = 0; next < opt.instances || !running.empty();) {
+        if (next < opt.instances && static_cast<int>(running.size()) < opt.jobs) {
+            int fds[2];
+            if (::pipe(fds) != 0) {
+                std::cerr << "pipe() failed" << std::endl;
+                return 1;
+            }
+            std::cout.flush();
+            const pid_t pid = ::fork();
+            if (pid == 0) {
+                // 子进程的节点日志转到 stderr，stdout 只留给父进程的报告；结果经管道返回
+                ::close(fds[0]);
+                ::dup2(STDERR_FILENO, STDOUT_FILENO);
+                const std::string line = runInstance(opt, capture, next).dump();
+                const ssize_t written = ::write(fds[1], line.data(), line.size());
+                std::cout.flush();
+                core::AsyncLogger::instance().flush();
+                ::_exit(written == static_cast<ssize_t>(line.size()) ? 0 : 1);
+            }
+            ::close(fds[1]);
+            if (pid < 0) {
+                ::close(fds[0]);
+                std::cerr << "fork() failed" << std::endl;
+                return 1;
+            }
+            running.push_back(Child{pid, fds[0], next++});
+            continue;
+        }
+        results.push_back(collect(running.front()));
+        running.erase(running.begin());
+    }
+    const double wallMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallBegin).count();
+    if (opt.synthetic) std::remove(capture.c_str());
+
+    std::sort(results.begin(), results.end(),
+              [](const json& a, const json& b) { return a.value("instance", 0) < b.value("instance", 0); });
+    double virtualS = 0.0;
+    int failed = 0;
+    for (const auto& r : results) {
+        virtualS += r.value("virtual_s", 0.0);
+        if (!r.value("ok", false)) ++failed;
+    }
+    json report = {{"benchmark", "replay_sim"},
+                   {"config",
+                    {{"source", !opt.flow.empty() ? "flow" : opt.synthetic ? "synthetic" : "capture"},
+                     {"instances", opt.instances},
+                     {"jobs", opt.jobs},
+                     {"duration_s", opt.durationS}}},
+                   {"instances", results},
+                   {"aggregate",
+                    {{"virtual_s", virtualS},
+                     {"wall_ms", wallMs},
+                     {"uav_seconds_per_second", wallMs > 0.0 ? virtualS / (wallMs / 1e3) : 0.0},
+                     {"failed", failed}}}};
+    const std::string text = report.dump(2);
+    if (opt.output == "-") {
+        std::cout << text << std::endl;
+    } else {
+        std::ofstream out(opt.output);
+        if (!out.is_open()) {
+            std::cerr << "Cannot write " << opt.output << std::endl;
+            return 1;
+        }
+        out << text << std::endl;
+    }
+    return failed == 0 ? 0 : 1;
+}
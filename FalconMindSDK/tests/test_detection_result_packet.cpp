@@ -80,12 +80,81 @@ static void test_parse_invalid() {
     std::cout << "  test_parse_invalid passed\n";
 }
 
+static void test_v2_roundtrip_and_view() {
+    DetectionResult result;
+    result.frameIndex = 9;
+    result.timestampNs = 9000;
+    result.trackerPredicted = true;
+    const char* names[] = {"person", "car", "person", ""};
+    for (int i = 0; i < 4; ++i) {
+        Detection d;
+        d.bbox = {static_cast<float>(i), 1.f, 2.f, 3.f};
+        d.score = 0.5f;
+        d.classId = i;
+        d.className = names[i];
+        d.trackId = 100 + i;
+        result.detections.push_back(d);
+    }
+    const std::size_t cap = detectionResultPacketV2Size(result);
+    std::vector<std::uint8_t> buf(cap);
+    assert(serializeDetectionResultV2(result, buf.data(), cap - 1) == 0);
+    std::size_t written = serializeDetectionResultV2(result, buf.data(), buf.size());
+    assert(written == cap && written % 4 == 0);
+
+    DetectionResultView view(buf.data(), written);
+    assert(view.valid() && view.version() == 2 && view.size() == 4);
+    assert(view.frameIndex() == 9 && view.timestampNs() == 9000 && view.trackerPredicted() && !view.overLatencyBudget());
+    assert(view.numClassNames() == 2);  // "person" 只存一次，空名不入表
+    assert(view.className(0) == "person" && view.className(1) == "car" && view.className(2) == "person");
+    assert(view.className(3).empty());
+    // 名称直接指向包内存
+    assert(view.className(0).data() == view.className(2).data());
+    assert(reinterpret_cast<const std::uint8_t*>(view.className(1).data()) > buf.data());
+    assert(view.trackId(3) == 103 && view.classId(1) == 1 && view.bbox(2).x == 2.f);
+    assert(parseDetectionResultPacketNumDetections(buf.data(), written) == 4);
+
+    DetectionResult parsed;
+    assert(deserializeDetectionResult(buf.data(), written, parsed));
+    assert(parsed.detections.size() == 4 && parsed.detections[1].className == "car");
+    assert(parsed.detections[2].trackId == 102 && parsed.trackerPredicted);
+
+    // 截断 / 名称未以 '\0' 结尾的包被拒绝
+    assert(!view.parse(buf.data(), written - 1) && !view.valid());
+    std::vector<std::uint8_t> bad(buf);
+    const auto* h = reinterpret_cast<const DetectionResultPacketHeaderV2*>(bad.data());
+    const auto* offsets = reinterpret_cast<const std::uint32_t*>(
+        bad.data() + sizeof(DetectionResultPacketHeaderV2) + 4 * sizeof(DetectionResultPacketItemV2));
+    const std::size_t stringsBegin = sizeof(DetectionResultPacketHeaderV2) + 4 * sizeof(DetectionResultPacketItemV2) +
+                                     (h->numClassNames + 1) * sizeof(std::uint32_t);
+    bad[stringsBegin + offsets[h->numClassNames] - 1] = 'x';  // 最后一个名称的 '\0'
+    assert(!view.parse(bad.data(), written));
+    std::cout << "  test_v2_roundtrip_and_view passed\n";
+}
+
+static void test_view_reads_v1() {
+    DetectionResult result;
+    result.frameIndex = 4;
+    Detection d;
+    d.classId = 3;
+    d.trackId = 7;  // v1 不携带
+    result.detections.push_back(d);
+    std::vector<std::uint8_t> buf(detectionResultPacketSize(1));
+    std::size_t written = serializeDetectionResult(result, buf.data(), buf.size());
+    DetectionResultView view(buf.data(), written);
+    assert(view.valid() && view.version() == 1 && view.size() == 1);
+    assert(view.classId(0) == 3 && view.trackId(0) == -1 && view.className(0).empty());
+    assert(view.numClassNames() == 0);
+    std::cout << "  test_view_reads_v1 passed\n";
+}
+
 int main() {
     std::cout << "Running DetectionResultPacket tests...\n";
     test_empty_result();
     test_single_detection();
     test_multiple_detections();
     test_parse_invalid();
+    test_v2_roundtrip_and_view();
+    test_view_reads_v1();
     std::cout << "All DetectionResultPacket tests passed.\n";
     return 0;
 }
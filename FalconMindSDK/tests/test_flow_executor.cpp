@@ -1,6 +1,8 @@
 // Unit tests for FlowExecutor
 #include "falconmind/sdk/core/FlowExecutor.h"
 #include "falconmind/sdk/core/NodeFactory.h"
+#include "falconmind/sdk/core/NodeParams.h"
+#include "falconmind/sdk/perception/EnvironmentDetectionNode.h"
 #include <nlohmann/json.hpp>
 #include <cassert>
 #include <iostream>
@@ -157,7 +159,447 @@ void test_update_flow() {
     std::cout << "✅ test_update_flow passed" << std::endl;
 }
 
+// 测试热更新只替换变化的节点，未变化节点与 Pipeline 保持不变
+void test_hot_update_keeps_unchanged_nodes() {
+    FlowExecutor executor;
+
+    auto make_flow = [](const std::string& version, double altitude, const std::string& reporter_template,
+                        bool with_edge) {
+        std::string json = R"({
+        "flow_id": "test_flow_hot",
+        "name": "Hot Update Flow",
+        "version": ")" + version + R"(",
+        "nodes": [
+            {
+                "node_id": "node_planner",
+                "template_id": "search_path_planner",
+                "parameters": { "search_params": { "altitude": )" + std::to_string(altitude) + R"( } }
+            },
+            {
+                "node_id": "node_reporter",
+                "template_id": ")" + reporter_template + R"(",
+                "parameters": {}
+            }
+        ],
+        "edges": [)";
+        if (with_edge) {
+            json += R"({
+                "edge_id": "edge_001",
+                "from_node_id": "node_planner",
+                "from_port": "waypoints",
+                "to_node_id": "node_reporter",
+                "to_port": "events"
+            })";
+        }
+        json += "]}";
+        return json;
+    };
+
+    assert(executor.loadFlow(make_flow("1.0", 30.0, "event_reporter", true)));
+    assert(executor.start());
+    auto pipeline = executor.getPipeline();
+    auto planner = pipeline->getNode("node_planner");
+    auto reporter = pipeline->getNode("node_reporter");
+    assert(planner && reporter);
+
+    // 仅修改参数：两个节点都原地保留
+    assert(executor.updateFlow(make_flow("2.0", 40.0, "event_reporter", true)));
+    assert(executor.isRunning());
+    assert(executor.getPipeline() == pipeline);
+    assert(pipeline->getNode("node_planner") == planner);
+    assert(pipeline->getNode("node_reporter") == reporter);
+
+    // 移除连线：节点保留，planner 输出 Pad 不再有连接
+    assert(executor.updateFlow(make_flow("3.0", 40.0, "event_reporter", false)));
+    assert(pipeline->getNode("node_reporter") == reporter);
+    assert(planner->getPad("waypoints")->connections().empty());
+
+    // 模板变化：只重建该节点，并重新连线
+    assert(executor.updateFlow(make_flow("4.0", 40.0, "search_path_planner", false)));
+    assert(executor.isRunning());
+    assert(executor.getPipeline() == pipeline);
+    assert(pipeline->getNode("node_planner") == planner);
+    auto replaced = pipeline->getNode("node_reporter");
+    assert(replaced && replaced != reporter);
+
+    executor.stop();
+    std::cout << "✅ test_hot_update_keeps_unchanged_nodes passed" << std::endl;
+}
+
+// 测试执行计划缓存：首次加载编译并写盘，再次启动直接从缓存加载
+void test_plan_cache_roundtrip() {
+    const std::string cache_dir = "/tmp/falconmind_flow_plan_cache_test";
+    std::string flow_json = R"({
+        "flow_id": "test_flow_plan",
+        "name": "Plan Cache Flow",
+        "version": "3.1",
+        "nodes": [
+            {
+                "node_id": "node_planner",
+                "template_id": "search_path_planner",
+                "parameters": {
+                    "search_area": {
+                        "polygon": [
+                            {"lat": 40.0, "lon": 116.0, "alt": 0},
+                            {"lat": 40.1, "lon": 116.0, "alt": 0},
+                            {"lat": 40.1, "lon": 116.1, "alt": 0}
+                        ],
+                        "min_altitude": 10.0,
+                        "max_altitude": 80.0
+                    },
+                    "search_params": { "pattern": "SPIRAL", "altitude": 42.0,
+                                       "detection_classes": ["person", "vehicle"] }
+                }
+            },
+            {
+                "node_id": "node_reporter",
+                "template_id": "event_reporter",
+                "parameters": { "placement": { "cpus": [0], "npu_core_mask": 2 } }
+            }
+        ],
+        "edges": [
+            {
+                "edge_id": "edge_001",
+                "from_node_id": "node_planner",
+                "from_port": "waypoints",
+                "to_node_id": "node_reporter",
+                "to_port": "events",
+                "queue": { "capacity": 8, "policy": "drop_newest" }
+            }
+        ]
+    })";
+
+    {
+        FlowExecutor executor;
+        executor.setPlanCacheDirectory(cache_dir);
+        assert(executor.loadFlow(flow_json));
+    }
+
+    FlowPlanCache cache(cache_dir);
+    FlowPlan plan;
+    assert(cache.load("test_flow_plan", "3.1", plan));
+    assert(plan.flowName == "Plan Cache Flow");
+    assert(plan.nodes.size() == 2 && plan.edges.size() == 1);
+    assert(plan.nodes[0].creator);
+    assert(plan.nodes[0].paramsValid && plan.nodes[0].planner.hasArea && plan.nodes[0].planner.hasParams);
+    assert(plan.nodes[0].planner.area.polygon.size() == 3);
+    assert(plan.nodes[0].planner.params.pattern == falconmind::sdk::mission::SearchPattern::SPIRAL);
+    assert(plan.nodes[0].planner.params.altitude == 42.0);
+    assert((plan.nodes[0].planner.params.detectionClasses == std::vector<std::string>{"person", "vehicle"}));
+    assert(plan.edges[0].from == 0 && plan.edges[0].to == 1);
+    assert(plan.edges[0].queue.enabled && plan.edges[0].queue.capacity == 8);
+    assert(plan.edges[0].queue.policy == LinkQueuePolicy::DropNewest);
+    assert(plan.nodes[1].placement.cpus == std::vector<int>({0}));
+    assert(plan.nodes[1].placement.npuCoreMask == 2 && plan.nodes[1].placement.priority == 0);
+    assert(!cache.load("test_flow_plan", "3.2", plan));  // 版本不同不命中
+
+    // 损坏的计划文件被忽略
+    std::string corrupt_path = cache.pathFor("test_flow_plan", "corrupt");
+    {
+        std::ofstream out(corrupt_path, std::ios::binary);
+        out << "FMFPgarbage";
+    }
+    assert(!cache.load("test_flow_plan", "corrupt", plan));
+    std::remove(corrupt_path.c_str());
+
+    // 从缓存启动，无需 JSON
+    FlowExecutor executor;
+    executor.setPlanCacheDirectory(cache_dir);
+    assert(executor.loadFlowFromCache("test_flow_plan", "3.1"));
+    assert(executor.getFlowId() == "test_flow_plan");
+    assert(executor.start());
+    assert(executor.getPipeline()->getNode("node_planner"));
+    assert(executor.getPipeline()->getLinks().size() == 1);
+    assert(executor.getPipeline()->getNode("node_reporter")->placement().cpus == std::vector<int>({0}));
+
+    // 从缓存启动后仍可热更新
+    std::string updated = flow_json;
+    updated.replace(updated.find("42.0"), 4, "45.0");
+    auto reporter = executor.getPipeline()->getNode("node_reporter");
+    assert(executor.updateFlow(updated));
+    assert(executor.getPipeline()->getNode("node_reporter") == reporter);
+
+    executor.stop();
+    std::remove(cache.pathFor("test_flow_plan", "3.1").c_str());
+    std::cout << "✅ test_plan_cache_roundtrip passed" << std::endl;
+}
+
+// 测试节点放置提示的解析与校验
+void test_node_placement_params() {
+    auto flowWith = [](const std::string& placement) {
+        return std::string(R"({"flow_id": "test_placement", "name": "Placement", "nodes": [
+            {"node_id": "node_reporter", "template_id": "event_reporter",
+             "parameters": { "placement": )") + placement + R"( }}], "edges": []})";
+    };
+
+    FlowExecutor executor;
+    assert(executor.loadFlow(flowWith(R"({"cpus": [0], "priority": 10, "npu_core_mask": 3})")));
+    const auto& node = executor.getPlan().nodes[0];
+    assert(node.paramsValid);
+    assert(node.placement.cpus == std::vector<int>({0}));
+    assert(node.placement.priority == 10 && node.placement.npuCoreMask == 3);
+    assert(node.placement.pinsThread());
+
+    FlowExecutor critical;
+    assert(critical.loadFlow(flowWith(R"({"class": "critical", "period_ms": 33.3, "deadline_ms": 20})")));
+    const auto& cnode = critical.getPlan().nodes[0];
+    assert(cnode.paramsValid && cnode.placement.critical() && !cnode.placement.pinsThread());
+    assert(cnode.placement.period == std::chrono::microseconds(33300));
+    assert(cnode.placement.effectiveDeadline() == std::chrono::milliseconds(20));
+    FlowPlan restored;
+    assert(FlowPlan::deserialize(critical.getPlan().serialize(), restored));
+    assert(restored.nodes[0].placement.critical() && restored.nodes[0].placement.period == cnode.placement.period);
+    assert(restored.nodes[0].placement.deadline == cnode.placement.deadline);
+
+    // 取值非法：参数标记为无效（节点照常创建但不应用参数）
+    for (const char* bad : {R"({"priority": 150})", R"({"cpus": [-1]})", R"({"cpus": "4-7"})",
+                            R"({"npu_core_mask": -2})", R"([1, 2])", R"({"class": "realtime"})",
+                            R"({"class": "critical"})", R"({"deadline_ms": -1})"}) {
+        FlowExecutor invalid;
+        assert(invalid.loadFlow(flowWith(bad)));
+        assert(!invalid.getPlan().nodes[0].paramsValid);
+        assert(invalid.getPlan().nodes[0].placement.empty());
+    }
+    std::cout << "✅ test_node_placement_params passed" << std::endl;
+}
+
+// 测试节点看门狗策略的解析、校验与计划缓存
+void test_node_watchdog_params() {
+    auto flowWith = [](const std::string& watchdog) {
+        return std::string(R"({"flow_id": "test_watchdog", "name": "Watchdog", "nodes": [
+            {"node_id": "node_reporter", "template_id": "event_reporter",
+             "parameters": { "watchdog": )") + watchdog + R"( }}], "edges": []})";
+    };
+
+    FlowExecutor executor;
+    assert(executor.loadFlow(flowWith(R"({"stall_ms": 500, "slo_ms": 80, "violations": 2,
+                                         "ladder": ["fallback_backend", "lower_rate"]})")));
+    const auto& node = executor.getPlan().nodes[0];
+    assert(node.paramsValid && node.watchdog.enabled());
+    assert(node.watchdog.stallTimeout == std::chrono::milliseconds(500));
+    assert(node.watchdog.latencySlo == std::chrono::milliseconds(80) && node.watchdog.violations == 2);
+    assert(node.watchdog.ladder ==
+           std::vector<WatchdogAction>({WatchdogAction::FallbackBackend, WatchdogAction::LowerRate}));
+    FlowPlan restored;
+    assert(FlowPlan::deserialize(executor.getPlan().serialize(), restored));
+    assert(restored.nodes[0].watchdog.stallTimeout == node.watchdog.stallTimeout);
+    assert(restored.nodes[0].watchdog.ladder == node.watchdog.ladder);
+
+    // 运行时启用看门狗；stop() 后释放
+    assert(executor.start());
+    assert(executor.watchdog() && executor.watchdog()->watchedCount() == 1);
+    executor.stop();
+    assert(!executor.watchdog());
+
+    for (const char* bad : {R"({"stall_ms": -1})", R"({"slo_ms": "80"})", R"({"violations": 0, "slo_ms": 10})",
+                            R"({"ladder": ["reboot"]})", R"({"ladder": "restart"})", R"(true)"}) {
+        FlowExecutor invalid;
+        assert(invalid.loadFlow(flowWith(bad)));
+        assert(!invalid.getPlan().nodes[0].paramsValid);
+        assert(!invalid.getPlan().nodes[0].watchdog.enabled());
+    }
+    std::cout << "✅ test_node_watchdog_params passed" << std::endl;
+}
+
+// 测试 Flow 优先级：两种解析方式一致、截断到 0~100、随计划缓存保留
+void test_flow_priority() {
+    auto flowWith = [](const std::string& priority) {
+        return std::string(R"({"flow_id": "test_priority", "name": "Priority", )") + priority +
+               R"( "nodes": [{"node_id": "node_reporter", "template_id": "event_reporter", "parameters": {}}],
+                  "edges": []})";
+    };
+    for (bool on_demand : {true, false}) {
+        FlowExecutor executor;
+        executor.setOnDemandParsing(on_demand);
+        assert(executor.loadFlow(flowWith("")) && executor.getPriority() == 50);
+        assert(executor.loadFlow(flowWith(R"("priority": 80,)")) && executor.getPriority() == 80);
+        assert(executor.getPlan().priority == 80);
+        FlowPlan restored;
+        assert(FlowPlan::deserialize(executor.getPlan().serialize(), restored) && restored.priority == 80);
+        assert(executor.loadFlow(flowWith(R"("priority": 250,)")) && executor.getPriority() == 100);
+        assert(executor.loadFlow(flowWith(R"("priority": -3,)")) && executor.getPriority() == 0);
+    }
+    FlowExecutor executor;
+    assert(!executor.resourceSharing());
+    executor.setResourceSharing(true);
+    assert(executor.loadFlow(flowWith(R"("priority": 10,)")) && executor.start());
+    executor.stop();
+    std::cout << "✅ test_flow_priority passed" << std::endl;
+}
+
+// 测试按模板参数 Schema 校验的类型化参数
+void test_typed_node_params() {
+    auto flowWith = [](const std::string& params) {
+        return std::string(R"({"flow_id": "test_typed", "name": "Typed", "version": "1", "nodes": [
+            {"node_id": "env", "template_id": "environment_detection", "parameters": )") + params +
+               R"( }], "edges": []})";
+    };
+
+    FlowExecutor executor;
+    assert(executor.loadFlow(flowWith(R"({"min_satellites": 4, "max_hdop": "3.5", "enter_hold_ms": 200,
+                                           "default_state": "low_light"})")));
+    const auto& plan_node = executor.getPlan().nodes[0];
+    assert(plan_node.paramsValid && plan_node.hasTypedParams);
+    assert(plan_node.typedParams.getInt("min_satellites") == 4);
+    assert(plan_node.typedParams.getDouble("max_hdop") == 3.5);
+    assert(!plan_node.typedParams.has("recover_satellites"));
+    assert(plan_node.typedParams.getInt("recover_satellites") == 8);  // 未给出时取默认值
+
+    // 计划缓存保留类型化取值
+    FlowPlan restored;
+    assert(FlowPlan::deserialize(executor.getPlan().serialize(), restored));
+    assert(restored.nodes[0].hasTypedParams && restored.nodes[0].typedParams.getInt("enter_hold_ms") == 200);
+    assert(restored.nodes[0].typedParams.has("default_state"));
+
+    assert(executor.start());
+    auto env = std::dynamic_pointer_cast<falconmind::sdk::perception::EnvironmentDetectionNode>(
+        executor.getPipeline()->getNode("env"));
+    assert(env);
+    assert(env->config().minSatellites == 4 && env->config().maxHdop == 3.5f);
+    assert(env->config().enterHoldNs == 200'000'000);
+    assert(env->config().recoverSatellites == 8);
+    executor.stop();
+
+    // 类型 / 范围 / 枚举不符：加载时即标记为无效
+    for (const char* bad : {R"({"min_satellites": 100})", R"({"max_hdop": "abc"})", R"({"default_state": "dark"})",
+                            R"({"min_satellites": 4.5})", R"({"confidence": true})"}) {
+        FlowExecutor invalid;
+        assert(invalid.loadFlow(flowWith(bad)));
+        assert(!invalid.getPlan().nodes[0].paramsValid);
+        assert(!invalid.getPlan().nodes[0].hasTypedParams);
+    }
+
+    // 部署前校验：逐节点给出原因
+    std::vector<std::string> errors;
+    assert(FlowExecutor::validateFlowParameters(flowWith(R"({"min_satellites": 6})"), errors) && errors.empty());
+    assert(!FlowExecutor::validateFlowParameters(flowWith(R"({"min_satellites": -1})"), errors));
+    assert(errors.size() == 1 && errors[0].find("env: ") == 0 && errors[0].find("min_satellites") != std::string::npos);
+
+    // 节点直接 configure 走同一 Schema
+    falconmind::sdk::perception::EnvironmentDetectionNode direct;
+    assert(direct.configure({{"low_light_enter", "30"}}) && direct.config().lowLightEnter == 30.f);
+    assert(!direct.configure({{"low_light_enter", "30lux"}}));
+
+    auto schema = NodeParamRegistry::find("camera_source");
+    assert(schema && schema->find("jitter_ms") && schema->find("jitter_ms")->type == ParamType::Int);
+    auto described = nlohmann::json::parse(schema->toJson());
+    assert(described.is_array() && described.size() == schema->specs().size());
+    std::cout << "✅ test_typed_node_params passed" << std::endl;
+}
+
+// 测试按需解析与 DOM 解析结果一致，以及按需解析对畸形输入的处理
+void test_on_demand_flow_parsing() {
+    const std::string flow_json = R"({
+        "metadata": {"layout": [[1, 2], {"nested": "}]\\\"{"}], "empty": {}},
+        "version": "2.0",
+        "flow_id": "test_on_demand",
+        "name": "On Demand \"quoted\"",
+        "latency_budget_ms": 12.5,
+        "nodes": [
+            {"ui": {"x": 1}, "node_id": "node_planner", "template_id": "search_path_planner",
+             "parameters": {"search_params": {"pattern": "SPIRAL", "altitude": 42.0}}},
+            {"node_id": "node_reporter", "template_id": "event_reporter"}
+        ],
+        "edges": [
+            {"from_node_id": "node_planner", "from_port": "waypoints", "to_node_id": "node_reporter",
+             "to_port": "events", "edge_id": "edge_001", "queue": {"capacity": 8, "policy": "drop_newest"}}
+        ]
+    })";
+
+    FlowExecutor dom;
+    dom.setOnDemandParsing(false);
+    assert(dom.loadFlow(flow_json));
+    FlowExecutor on_demand;
+    assert(on_demand.onDemandParsing());
+    assert(on_demand.loadFlow(flow_json));
+    const auto& a = dom.getPlan();
+    const auto& b = on_demand.getPlan();
+    assert(b.flowId == "test_on_demand" && b.version == "2.0" && b.flowName == "On Demand \"quoted\"");
+    assert(a.flowName == b.flowName && a.latencyBudgetNs == b.latencyBudgetNs && b.latencyBudgetNs == 12'500'000);
+    assert(a.nodes.size() == 2 && b.nodes.size() == 2);
+    for (std::size_t i = 0; i < 2; ++i) {
+        // 按需路径保留 parameters 原文（空白可能不同），按 JSON 语义比较
+        assert(a.nodes[i].nodeId == b.nodes[i].nodeId &&
+               nlohmann::json::parse(a.nodes[i].parametersJson) == nlohmann::json::parse(b.nodes[i].parametersJson));
+    }
+    assert(b.nodes[0].planner.hasParams && b.nodes[0].planner.params.altitude == 42.0);
+    assert(b.edges.size() == 1 && b.edges[0].queue.capacity == 8);
+    assert(b.edges[0].queue.policy == LinkQueuePolicy::DropNewest);
+
+    // 文件路径经 mmap 读取
+    const std::string path = "/tmp/falconmind_on_demand_flow.json";
+    {
+        std::ofstream out(path);
+        out << flow_json;
+    }
+    FlowExecutor from_file;
+    assert(from_file.loadFlowFromFile(path));
+    assert(from_file.getPlan().nodes.size() == 2 && from_file.getPlan().edges.size() == 1);
+    std::remove(path.c_str());
+    assert(!from_file.loadFlowFromFile("/tmp/falconmind_no_such_flow.json"));
+
+    for (const char* bad : {
+             R"({"flow_id": "x", "nodes": [], "edges": []} trailing)",
+             R"({"flow_id": "x", "nodes": [{"node_id": "a", "template_id": "gate"}], "edges": [)",
+             R"({"flow_id": "x", "nodes": [{"template_id": "gate"}], "edges": []})",
+             R"({"flow_id": "x", "nodes": [], "edges": [{"from_node_id": "a"}]})",
+             R"({"flow_id": "x", "nodes": {}, "edges": []})",
+             R"({"flow_id": "x", "extra": [1, 2}, "nodes": [], "edges": []})",
+             R"({"flow_id": 7, "nodes": [], "edges": []})",
+             R"({"flow_id": "x", "nodes": [{"node_id": "a", "template_id": "gate", "parameters": {"k": }}], "edges": []})",
+             ""}) {
+        FlowExecutor invalid;
+        assert(!invalid.loadFlow(bad));
+    }
+    std::cout << "✅ test_on_demand_flow_parsing passed" << std::endl;
+}
+
 // 测试无效Flow定义
+// 测试 Flow 内存预算：按需/DOM 解析一致，进入计划缓存；超出时启动前降级，降到下限仍超出则启动失败
+void test_memory_budget_flow() {
+    auto flowWithBudget = [](double mb) {
+        return std::string(R"({"flow_id": "test_memory_budget", "version": "1.0", "memory_budget_mb": )") +
+               std::to_string(mb) + R"(,
+            "nodes": [
+                {"node_id": "camera", "template_id": "camera_source",
+                 "parameters": {"device": "", "width": 640, "height": 480, "fps": 30}},
+                {"node_id": "resize", "template_id": "image_transform", "parameters": {"width": 640, "height": 480}}
+            ],
+            "edges": [
+                {"edge_id": "e1", "from_node_id": "camera", "from_port": "video_out",
+                 "to_node_id": "resize", "to_port": "video_in"}
+            ]})";
+    };
+
+    FlowExecutor dom;
+    dom.setOnDemandParsing(false);
+    assert(dom.loadFlow(flowWithBudget(4.0)));
+    FlowExecutor executor;
+    assert(executor.loadFlow(flowWithBudget(4.0)));
+    assert(dom.getMemoryBudgetBytes() == 4u << 20 && executor.getMemoryBudgetBytes() == 4u << 20);
+    FlowPlan restored;
+    assert(FlowPlan::deserialize(executor.getPlan().serialize(), restored));
+    assert(restored.memoryBudgetBytes == 4u << 20);
+
+    // 两个节点各 8 帧 640x480 RGB8 约 14 MB：减在途帧后满足 4 MB
+    assert(executor.start());
+    const auto& report = executor.memoryBudgetReport();
+    assert(report.withinBudget && report.requestedBytes > report.budgetBytes);
+    assert(!report.degradations.empty() && report.plannedBytes <= report.budgetBytes);
+    auto metrics = executor.getPipeline()->metrics();
+    assert(metrics.memoryBudgetBytes == 4u << 20);
+    for (const auto& node : metrics.nodes) {
+        assert(node.hasMemory && node.memoryEstimateBytes <= report.budgetBytes);
+    }
+    executor.stop();
+
+    FlowExecutor tight;
+    assert(tight.loadFlow(flowWithBudget(0.01)));
+    assert(!tight.start());
+    assert(!tight.isRunning() && !tight.memoryBudgetReport().withinBudget);
+    std::cout << "✅ test_memory_budget_flow passed" << std::endl;
+}
+
 void test_invalid_flow_definition() {
     FlowExecutor executor;
     
@@ -393,6 +835,14 @@ int main() {
     test_load_flow_from_file();
     test_start_and_stop_flow();
     test_update_flow();
+    test_hot_update_keeps_unchanged_nodes();
+    test_plan_cache_roundtrip();
+    test_node_placement_params();
+    test_node_watchdog_params();
+    test_flow_priority();
+    test_typed_node_params();
+    test_on_demand_flow_parsing();
+    test_memory_budget_flow();
     test_invalid_flow_definition();
     test_parameter_format_validation();
     test_parameter_range_validation();
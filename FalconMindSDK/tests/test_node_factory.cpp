@@ -1,15 +1,28 @@
 // Unit tests for NodeFactory
 #include "falconmind/sdk/core/NodeFactory.h"
 #include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/perception/DetectionNode.h"
 #include <memory>
 #include <cassert>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace falconmind::sdk::core;
 
 namespace {
 
+class StaticRegisteredNode : public Node {
+public:
+    StaticRegisteredNode() : Node("static_registered") {}
+};
+
+// 静态初始化阶段自注册（先于 main 与 initializeDefaultTypes 执行）
+FALCONMIND_REGISTER_NODE("static_registered_node", StaticRegisteredNode);
+
 // 测试Node类型注册
 void test_register_node_type() {
     // 确保NodeFactory已初始化
@@ -24,8 +37,15 @@ void test_register_node_type() {
     assert(NodeFactory::isRegistered("flight_command_sink"));
     assert(NodeFactory::isRegistered("camera_source"));
     assert(NodeFactory::isRegistered("dummy_detection"));
+    assert(NodeFactory::isRegistered("detection"));
+    // dummy_detection 保留为别名，创建的是流水线检测节点
+    assert(std::dynamic_pointer_cast<falconmind::sdk::perception::DetectionNode>(
+        NodeFactory::createNode("dummy_detection", "det")));
     assert(NodeFactory::isRegistered("tracking_transform"));
     assert(NodeFactory::isRegistered("environment_detection"));
+    assert(NodeFactory::isRegistered("blackboard_sink"));
+    assert(NodeFactory::isRegistered("geofence_monitor"));
+    assert(NodeFactory::isRegistered("obstacle_cloud"));
     assert(NodeFactory::isRegistered("low_light_adaptation"));
     assert(NodeFactory::isRegistered("visual_slam"));
     assert(NodeFactory::isRegistered("lidar_slam"));
@@ -122,6 +142,44 @@ void test_multiple_initialization() {
     std::cout << "✅ test_multiple_initialization passed" << std::endl;
 }
 
+// 静态自注册的类型可直接创建
+void test_static_registration() {
+    assert(NodeFactory::isRegistered("static_registered_node"));
+    auto node = NodeFactory::createNode("static_registered_node", "static_001");
+    assert(node != nullptr && node->id() == "static_001");
+    assert(std::dynamic_pointer_cast<StaticRegisteredNode>(node) != nullptr);
+    std::cout << "✅ test_static_registration passed" << std::endl;
+}
+
+// 并发：插件注册与 Flow 加载（createNode/findCreator）同时进行
+void test_concurrent_register_and_create() {
+    std::atomic<bool> failed{false};
+    std::thread registrar([]() {
+        for (int i = 0; i < 200; ++i) {
+            NodeFactory::registerNodeType("concurrent_" + std::to_string(i),
+                [](const std::string& node_id, const void* /*params*/) -> std::shared_ptr<Node> {
+                    return std::make_shared<Node>(node_id);
+                });
+        }
+    });
+    std::vector<std::thread> loaders;
+    for (int t = 0; t < 3; ++t) {
+        loaders.emplace_back([&failed]() {
+            for (int i = 0; i < 500; ++i) {
+                auto node = NodeFactory::createNode("dummy_detection", "det");
+                if (!node || !NodeFactory::findCreator("search_path_planner")) failed = true;
+            }
+        });
+    }
+    registrar.join();
+    for (auto& t : loaders) t.join();
+    assert(!failed);
+    for (int i = 0; i < 200; ++i) {
+        assert(NodeFactory::isRegistered("concurrent_" + std::to_string(i)));
+    }
+    std::cout << "✅ test_concurrent_register_and_create passed" << std::endl;
+}
+
 } // namespace
 
 // 主函数
@@ -139,6 +197,8 @@ int main() {
     test_get_registered_types();
     test_register_custom_node_type();
     test_multiple_initialization();
+    test_static_registration();
+    test_concurrent_register_and_create();
     
     std::cout << "All NodeFactory tests passed!" << std::endl;
     return 0;
@@ -3,8 +3,18 @@
 #include "falconmind/sdk/core/Node.h"
 #include "falconmind/sdk/core/Pad.h"
 #include "falconmind/sdk/core/NodeFactory.h"
+#include "falconmind/sdk/core/ShmTransport.h"
+#include "falconmind/sdk/core/CaptureFile.h"
+#include "falconmind/sdk/core/PipelineClock.h"
+#include "falconmind/sdk/core/ReplayRunner.h"
 #include <cassert>
+#include <cstdio>
 #include <iostream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 using namespace falconmind::sdk::core;
 
@@ -135,6 +145,357 @@ void test_pipeline_link_type_check() {
     std::cout << "✅ test_pipeline_link_type_check passed" << std::endl;
 }
 
+std::string uniqueChannel(const char* tag) {
+    return std::string("fm_test_") + tag + "_" + std::to_string(getpid());
+}
+
+// 共享内存通道：零拷贝读取、元数据透传、槽位占满时丢帧、释放后复用
+void test_shm_channel_roundtrip() {
+    ShmChannelConfig cfg;
+    cfg.name = uniqueChannel("roundtrip");
+    cfg.slotCount = 2;
+    cfg.slotSize = 64;
+    auto producer = ShmChannel::create(cfg);
+    assert(producer != nullptr);
+    auto consumer = ShmChannel::open(cfg.name);
+    assert(consumer != nullptr);
+    assert(consumer->slotCount() == 2 && consumer->slotSize() == 64);
+    assert(!consumer->read());
+
+    BufferMeta meta;
+    meta.timestampNs = 42;
+    meta.frameIndex = 7;
+    meta.video.width = 4;
+    int values[3] = {1, 2, 3};
+    assert(producer->write(&values[0], sizeof(int), meta));
+    assert(producer->write(&values[1], sizeof(int)));
+    assert(!producer->write(&values[2], sizeof(int)));  // 两个槽位均未消费
+    assert(producer->dropped() == 1);
+    std::vector<char> big(65);
+    assert(!producer->write(big.data(), big.size()));    // 超过 slotSize
+
+    BufferRef first = consumer->read();
+    assert(first && first.size() == sizeof(int) && *reinterpret_cast<const int*>(first.data()) == 1);
+    assert(first.meta().timestampNs == 42 && first.meta().frameIndex == 7 && first.meta().video.width == 4);
+    BufferRef second = consumer->read();
+    assert(second && *reinterpret_cast<const int*>(second.data()) == 2);
+    // 读端仍持有两帧：生产者不能覆盖
+    assert(!producer->write(&values[2], sizeof(int)));
+    first.reset();
+    assert(producer->write(&values[2], sizeof(int)));
+    BufferRef third = consumer->read();
+    assert(third && *reinterpret_cast<const int*>(third.data()) == 3);
+    assert(producer->written() == 3);
+
+    producer.reset();
+    assert(consumer->closed());
+    assert(!ShmChannel::open(cfg.name));
+    // 通道关闭后已读出的缓冲仍然有效
+    assert(*reinterpret_cast<const int*>(second.data()) == 2);
+    std::cout << "✅ test_shm_channel_roundtrip passed" << std::endl;
+}
+
+// 跨进程：子进程阻塞等待并读取父进程写入的帧
+void test_shm_channel_cross_process() {
+    ShmChannelConfig cfg;
+    cfg.name = uniqueChannel("fork");
+    cfg.slotCount = 4;
+    cfg.slotSize = sizeof(int);
+    auto producer = ShmChannel::create(cfg);
+    assert(producer != nullptr);
+
+    constexpr int kFrames = 20;
+    pid_t child = fork();
+    assert(child >= 0);
+    if (child == 0) {
+        auto consumer = ShmChannel::open(cfg.name);
+        int expected = 0;
+        while (consumer && expected < kFrames) {
+            BufferRef b = consumer->read(std::chrono::milliseconds(2000));
+            if (!b || *reinterpret_cast<const int*>(b.data()) != expected) break;
+            ++expected;
+        }
+        _exit(expected == kFrames ? 0 : 1);
+    }
+    for (int i = 0; i < kFrames; ++i) {
+        // 读端来不及消费时重试，保证每帧都送达
+        while (!producer->write(&i, sizeof(i))) {
+            usleep(1000);
+        }
+    }
+    int status = 0;
+    assert(waitpid(child, &status, 0) == child);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    std::cout << "✅ test_shm_channel_cross_process passed" << std::endl;
+}
+
+class IntSourceNode : public Node {
+public:
+    IntSourceNode() : Node("int_source") { out_ = addPad(std::make_shared<Pad>("out", PadType::Source)); }
+    void emit(int v) { out_->pushToConnections(&v, sizeof(v)); }
+
+private:
+    Pad* out_;
+};
+
+class IntSinkNode : public Node {
+public:
+    IntSinkNode() : Node("int_sink") {
+        auto* in = addPad(std::make_shared<Pad>("in", PadType::Sink));
+        in->setDataCallback([this](const void* data, size_t) { values.push_back(*static_cast<const int*>(data)); });
+    }
+    std::vector<int> values;
+};
+
+// Pipeline 切分：A 的输出经 linkRemote 写入通道，B 以 addRemoteSource 接收后连接下游
+void test_pipeline_link_remote() {
+    std::string channel = uniqueChannel("pipeline");
+    ShmChannelConfig cfg;
+    cfg.name = channel;
+    cfg.slotSize = 1024;
+
+    Pipeline sender(PipelineConfig{"sender", "sender", "", 0});
+    auto source = std::make_shared<IntSourceNode>();
+    source->setId("src");
+    assert(sender.addNode(source));
+    assert(sender.linkRemote("src", "out", cfg));
+    assert(!sender.linkRemote("missing", "out", cfg));
+    auto shmSink = sender.getNode(Pipeline::remoteSinkId(channel));
+    assert(shmSink != nullptr);
+
+    Pipeline receiver(PipelineConfig{"receiver", "receiver", "", 0});
+    assert(receiver.addRemoteSource("rx", channel));
+    auto sink = std::make_shared<IntSinkNode>();
+    sink->setId("sink");
+    assert(receiver.addNode(sink));
+    assert(receiver.link("rx", "out", "sink", "in"));
+    auto rx = receiver.getNode("rx");
+
+    assert(rx->start());         // 生产者未启动：process() 中重试打开
+    rx->process();
+    assert(shmSink->start());
+    source->emit(5);
+    source->emit(6);
+    rx->process();
+    assert((sink->values == std::vector<int>{5, 6}));
+
+    // 生产者重启后读端自动重新打开
+    shmSink->stop();
+    assert(shmSink->start());
+    source->emit(7);
+    rx->process();
+    rx->process();
+    assert((sink->values == std::vector<int>{5, 6, 7}));
+    rx->stop();
+    shmSink->stop();
+    std::cout << "✅ test_pipeline_link_remote passed" << std::endl;
+}
+
+std::string uniqueCapturePath(const char* tag) {
+    return std::string("/tmp/fm_test_") + tag + "_" + std::to_string(getpid()) + ".fmcap";
+}
+
+// 捕获文件：带索引读取、元数据保留、零拷贝（修改元数据不复制数据，写数据时复制出私有副本）
+void test_capture_file_roundtrip() {
+    std::string path = uniqueCapturePath("roundtrip");
+    {
+        auto writer = CaptureWriter::create(path);
+        assert(writer != nullptr);
+        for (std::int64_t i = 0; i < 3; ++i) {
+            BufferMeta meta;
+            meta.timestampNs = 1000 + i;
+            meta.frameIndex = static_cast<std::uint64_t>(i);
+            meta.video = VideoCaps{PixelFormat::RGB8, 2, 1, 30};
+            std::int64_t value = i * 11;
+            assert(writer->append(&value, sizeof(value), meta));
+        }
+        assert(writer->records() == 3);
+        assert(writer->close());
+    }
+    assert(CaptureReader::isCaptureFile(path));
+    auto reader = CaptureReader::open(path);
+    assert(reader && reader->indexed() && reader->size() == 3);
+    for (std::size_t i = 0; i < 3; ++i) {
+        const CaptureRecord& rec = reader->record(i);
+        assert(rec.size == sizeof(std::int64_t));
+        assert(*reinterpret_cast<const std::int64_t*>(rec.data) == static_cast<std::int64_t>(i) * 11);
+        assert(rec.meta.timestampNs == 1000 + static_cast<std::int64_t>(i) && rec.meta.frameIndex == i);
+        assert(rec.meta.video.format == PixelFormat::RGB8 && rec.meta.video.width == 2 && rec.meta.video.fps == 30);
+    }
+
+    BufferRef buffer = reader->buffer(1);
+    assert(buffer.data() == reader->record(1).data);  // 指向映射
+    buffer.mutableMeta().timestampNs = 5;
+    assert(buffer.data() == reader->record(1).data && buffer.meta().timestampNs == 5);
+    assert(reader->record(1).meta.timestampNs == 1001);
+    std::uint8_t* priv = buffer.mutableData();
+    assert(priv != reader->record(1).data);
+    priv[0] = 0xFF;
+    assert(*reinterpret_cast<const std::int64_t*>(reader->record(1).data) == 11);
+
+    // 缓冲持有映射：reader 释放后仍可读
+    BufferRef held = reader->buffer(2);
+    reader.reset();
+    assert(*reinterpret_cast<const std::int64_t*>(held.data()) == 22);
+    std::remove(path.c_str());
+    std::cout << "✅ test_capture_file_roundtrip passed" << std::endl;
+}
+
+// 无索引（进程崩溃）文件：顺序扫描恢复完整记录，末尾残缺记录被忽略
+void test_capture_file_scan_recovery() {
+    std::string path = uniqueCapturePath("scan");
+    {
+        auto writer = CaptureWriter::create(path);
+        std::int64_t value = 7;
+        for (int i = 0; i < 3; ++i) assert(writer->append(&value, sizeof(value), BufferMeta{}));
+    }
+    struct stat st{};
+    assert(::stat(path.c_str(), &st) == 0);
+    assert(::truncate(path.c_str(), st.st_size - 4) == 0);  // 破坏 footer
+    auto reader = CaptureReader::open(path);
+    assert(reader && !reader->indexed() && reader->size() == 3);
+    reader.reset();
+
+    // 文件头 16 字节 + 每条记录（48 字节记录头 + 8 字节负载）；截断在第三条负载中间
+    assert(::truncate(path.c_str(), 16 + 2 * 56 + 48 + 4) == 0);
+    reader = CaptureReader::open(path);
+    assert(reader && !reader->indexed() && reader->size() == 2);
+    assert(*reinterpret_cast<const std::int64_t*>(reader->record(1).data) == 7);
+    reader.reset();
+
+    assert(!CaptureReader::open("/tmp/fm_test_capture_missing.fmcap"));
+    std::remove(path.c_str());
+    std::cout << "✅ test_capture_file_scan_recovery passed" << std::endl;
+}
+
+// Pipeline::tapToFile 录制，ReplaySourceNode 尽快回放（loop）
+void test_pipeline_tap_and_replay() {
+    std::string path = uniqueCapturePath("tap");
+    Pipeline recorder(PipelineConfig{"rec", "rec", "", 0});
+    auto source = std::make_shared<IntSourceNode>();
+    source->setId("src");
+    assert(recorder.addNode(source));
+    assert(recorder.tapToFile("src", "out", path));
+    assert(!recorder.tapToFile("src", "out", path));      // 重复录制
+    assert(!recorder.tapToFile("src", "missing", path));  // 失败时不留下录制节点
+    assert(!recorder.getNode(Pipeline::tapId("src", "missing")));
+    auto tap = std::dynamic_pointer_cast<CaptureRecorderNode>(recorder.getNode(Pipeline::tapId("src", "out")));
+    assert(tap && tap->start());
+    for (int v = 1; v <= 3; ++v) source->emit(v);
+    assert(tap->recorded() == 3);
+    tap->stop();
+
+    Pipeline player(PipelineConfig{"play", "play", "", 0});
+    auto replay = std::make_shared<ReplaySourceNode>();
+    replay->setId("replay");
+    assert(replay->configure({{"path", path}, {"speed", "max"}, {"batch", "2"}, {"loop", "true"}}));
+    auto sink = std::make_shared<IntSinkNode>();
+    sink->setId("sink");
+    assert(player.addNode(replay) && player.addNode(sink));
+    assert(player.link("replay", "out", "sink", "in"));
+    assert(replay->start());
+    replay->process();
+    assert((sink->values == std::vector<int>{1, 2}));
+    replay->process();
+    replay->process();
+    assert((sink->values == std::vector<int>{1, 2, 3, 1, 2, 3}));
+    assert(replay->replayed() == 6 && !replay->finished());
+    replay->stop();
+
+    // 不循环：回放完一轮后结束
+    assert(replay->configure({{"loop", "false"}, {"batch", "8"}}));
+    assert(replay->start());
+    replay->process();
+    assert(replay->finished() && sink->values.size() == 9);
+    replay->process();
+    assert(sink->values.size() == 9);
+    replay->stop();
+    std::remove(path.c_str());
+    std::cout << "✅ test_pipeline_tap_and_replay passed" << std::endl;
+}
+
+class TickNode : public Node {
+public:
+    TickNode() : Node("tick") {}
+    void process() override { ticks.push_back(PipelineClock::nowNs()); }
+    std::vector<std::int64_t> ticks;
+};
+
+// ReplayRunner：虚拟时钟下按录制间隔回放（时间戳与原速一致、不等待），周期性 Source 按虚拟周期调度
+void test_replay_runner_virtual_clock() {
+    std::string path = uniqueCapturePath("runner");
+    constexpr std::int64_t kInterval = 200'000'000;
+    constexpr int kRecords = 50;  // 录制跨度 9.8 s
+    {
+        auto writer = CaptureWriter::create(path);
+        for (int i = 0; i < kRecords; ++i) {
+            BufferMeta meta;
+            meta.timestampNs = 1'000'000'000 + i * kInterval;
+            assert(writer->append(&i, sizeof(i), meta));
+        }
+    }
+
+    constexpr std::int64_t kStart = 5'000'000'000;
+    struct Delivery {
+        int value;
+        std::int64_t timestampNs;
+        std::int64_t nowNs;
+    };
+    auto build = [&](Pipeline& pipeline, std::vector<Delivery>& out, std::shared_ptr<TickNode>& tick) {
+        auto replay = std::make_shared<ReplaySourceNode>(path);
+        replay->setId("replay");
+        tick = std::make_shared<TickNode>();
+        tick->setId("tick");
+        assert(pipeline.addNode(replay) && pipeline.addNode(tick));
+        assert(pipeline.addPadTap("replay", "out", [&out](const BufferRef& buffer) {
+            out.push_back({*reinterpret_cast<const int*>(buffer.data()), buffer.meta().timestampNs, PipelineClock::nowNs()});
+        }));
+        pipeline.scheduler().setNodePeriod("tick", std::chrono::milliseconds(100));
+    };
+
+    Pipeline pipeline(PipelineConfig{"runner", "runner", "", 0});
+    std::vector<Delivery> delivered;
+    std::shared_ptr<TickNode> tick;
+    build(pipeline, delivered, tick);
+    ReplayRunnerConfig cfg;
+    cfg.startNs = kStart;
+    ReplayRunner runner(cfg);
+    const ReplayRunStats stats = runner.run(pipeline);
+    assert(stats.started && stats.completed);
+    assert(stats.virtualNs == (kRecords - 1) * kInterval);
+    assert(stats.wallNs < stats.virtualNs);  // 不等待
+    assert(!PipelineClock::isVirtual() && pipeline.state() == PipelineState::Ready);
+    assert(delivered.size() == static_cast<std::size_t>(kRecords));
+    for (int i = 0; i < kRecords; ++i) {
+        assert(delivered[i].value == i);
+        assert(delivered[i].timestampNs == kStart + i * kInterval);
+        assert(delivered[i].nowNs == delivered[i].timestampNs);  // 在到期时刻投递
+    }
+    // 周期 100 ms：5.0 s ~ 14.8 s
+    assert(tick->ticks.size() == 99 && tick->ticks.front() == kStart);
+    for (std::size_t i = 1; i < tick->ticks.size(); ++i) assert(tick->ticks[i] - tick->ticks[i - 1] == 100'000'000);
+    assert(stats.processCalls >= static_cast<std::uint64_t>(kRecords) + tick->ticks.size());
+
+    // 虚拟时长上限：只回放前 1 s 的记录
+    Pipeline limited(PipelineConfig{"limited", "limited", "", 0});
+    std::vector<Delivery> partial;
+    build(limited, partial, tick);
+    cfg.maxDurationNs = 1'000'000'000;
+    const ReplayRunStats cut = ReplayRunner(cfg).run(limited);
+    assert(cut.started && !cut.completed && cut.virtualNs == cfg.maxDurationNs);
+    assert(partial.size() == 6 && tick->ticks.size() == 11);  // 含上限时刻
+
+    // 已由线程调度的 Pipeline 不接管
+    Pipeline threaded(PipelineConfig{"threaded", "threaded", "", 0});
+    std::vector<Delivery> ignored;
+    build(threaded, ignored, tick);
+    assert(threaded.setState(PipelineState::Playing));
+    assert(!ReplayRunner(cfg).run(threaded).started);
+    threaded.setState(PipelineState::Null);
+    std::remove(path.c_str());
+    std::cout << "✅ test_replay_runner_virtual_clock passed (" << stats.speedup() << "x real time)" << std::endl;
+}
+
 } // namespace
 
 // 主函数
@@ -150,6 +511,13 @@ int main() {
     test_pipeline_link_errors();
     test_pipeline_unlink();
     test_pipeline_link_type_check();
+    test_shm_channel_roundtrip();
+    test_shm_channel_cross_process();
+    test_pipeline_link_remote();
+    test_capture_file_roundtrip();
+    test_capture_file_scan_recovery();
+    test_pipeline_tap_and_replay();
+    test_replay_runner_virtual_clock();
     
     std::cout << "All Pipeline::link tests passed!" << std::endl;
     return 0;
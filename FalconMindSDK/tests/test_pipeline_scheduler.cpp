@@ -0,0 +1,784 @@
+// Unit tests for Pipeline scheduling (PipelineScheduler)
+#include "falconmind/sdk/core/AsyncNode.h"
+#include "falconmind/sdk/core/NodeWatchdog.h"
+#include "falconmind/sdk/core/Pipeline.h"
+#include "falconmind/sdk/core/PipelineScheduler.h"
+#include "falconmind/sdk/core/Node.h"
+#include "falconmind/sdk/core/Pad.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+using namespace falconmind::sdk::core;
+
+namespace {
+
+// 源节点：每次 process() 推送一个递增计数
+class CounterSourceNode : public Node {
+public:
+    explicit CounterSourceNode(const std::string& id) : Node(id) {
+        addPad(std::make_shared<Pad>("out", PadType::Source));
+    }
+    bool start() override { started = true; return true; }
+    void stop() override { started = false; }
+    void process() override {
+        std::uint32_t v = ++produced;
+        getPad("out")->pushToConnections(&v, sizeof(v));
+    }
+    std::atomic<bool> started{false};
+    std::atomic<std::uint32_t> produced{0};
+};
+
+// 中间/末端节点：收到数据后由调度器调用 process()，并检查同一节点 process() 不会并发
+class RelayNode : public Node {
+public:
+    explicit RelayNode(const std::string& id) : Node(id) {
+        addPad(std::make_shared<Pad>("in", PadType::Sink));
+        addPad(std::make_shared<Pad>("out", PadType::Source));
+    }
+    bool start() override {
+        getPad("in")->setDataCallback([this](const void* data, size_t size) {
+            if (data && size == sizeof(std::uint32_t)) {
+                last = *static_cast<const std::uint32_t*>(data);
+            }
+        });
+        started = true;
+        return true;
+    }
+    void stop() override { started = false; }
+    void process() override {
+        if (inFlight.fetch_add(1) != 0) concurrent = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        std::uint32_t v = last.load();
+        getPad("out")->pushToConnections(&v, sizeof(v));
+        ++processed;
+        inFlight.fetch_sub(1);
+    }
+    std::atomic<bool> started{false};
+    std::atomic<std::uint32_t> last{0};
+    std::atomic<int> inFlight{0};
+    std::atomic<bool> concurrent{false};
+    std::atomic<int> processed{0};
+};
+
+// 启动耗时的节点（模拟模型加载/相机打开），可配置为启动失败
+class SlowStartNode : public Node {
+public:
+    SlowStartNode(const std::string& id, int startMs, bool fail = false)
+        : Node(id), startMs_(startMs), fail_(fail) {}
+    bool start() override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(startMs_));
+        if (fail_) return false;
+        started = true;
+        return true;
+    }
+    void stop() override { started = false; ++stops; }
+    void process() override {}
+    std::atomic<bool> started{false};
+    std::atomic<int> stops{0};
+
+private:
+    int startMs_;
+    bool fail_;
+};
+
+// 异步中继：经 AsyncContext 读入、延迟 1ms 后转发；同时等待一个 pipe 可读
+class AsyncRelayNode : public Node, public AsyncNode {
+public:
+    explicit AsyncRelayNode(const std::string& id, int fd) : Node(id), fd_(fd) {
+        addPad(std::make_shared<Pad>("in", PadType::Sink));
+        addPad(std::make_shared<Pad>("out", PadType::Source));
+    }
+    void process() override { ++processCalls; }
+    void startAsync(AsyncContext& ctx) override {
+        loopThread = std::this_thread::get_id();
+        ctx.watch(fd_, EPOLLIN, [this](std::uint32_t revents) { readable = (revents & EPOLLIN) != 0; });
+        readNext(ctx);
+    }
+    void stopAsync() override { stopped = true; }
+
+    std::atomic<int> processCalls{0};
+    std::atomic<int> forwarded{0};
+    std::atomic<bool> readable{false};
+    std::atomic<bool> offLoopThread{false};
+    std::atomic<bool> readCancelled{false};
+    std::atomic<bool> stopped{false};
+    std::thread::id loopThread;
+
+private:
+    void readNext(AsyncContext& ctx) {
+        ctx.read(*getPad("in"), [this, &ctx](BufferRef buffer) {
+            if (!buffer) {
+                readCancelled = true;
+                return;
+            }
+            if (std::this_thread::get_id() != loopThread) offLoopThread = true;
+            ctx.after(std::chrono::milliseconds(1), [this, &ctx, buffer](bool fired) {
+                if (!fired) return;
+                getPad("out")->pushBuffer(buffer);
+                ++forwarded;
+                readNext(ctx);
+            });
+        });
+    }
+    int fd_;
+};
+
+#if FALCONMIND_HAS_COROUTINES
+// 协程版中继，另起大量并发休眠的协程验证它们共享同一事件循环线程
+class CoroutineRelayNode : public Node, public AsyncNode {
+public:
+    explicit CoroutineRelayNode(const std::string& id) : Node(id) {
+        addPad(std::make_shared<Pad>("in", PadType::Sink));
+        addPad(std::make_shared<Pad>("out", PadType::Source));
+    }
+    void process() override {}
+    void startAsync(AsyncContext& ctx) override {
+        relay(ctx);
+        for (int i = 0; i < kSleepers; ++i) sleeper(ctx);
+    }
+
+    static constexpr int kSleepers = 1000;
+    std::atomic<int> forwarded{0};
+    std::atomic<int> woke{0};
+    std::atomic<bool> relayFinished{false};
+    std::mutex threadsMutex;
+    std::set<std::thread::id> threads;
+
+private:
+    AsyncTask relay(AsyncContext& ctx) {
+        while (BufferRef frame = co_await nextBuffer(ctx, *getPad("in"))) {
+            if (!co_await sleepFor(ctx, std::chrono::microseconds(200))) break;
+            getPad("out")->pushBuffer(frame);
+            ++forwarded;
+        }
+        relayFinished = true;
+    }
+    AsyncTask sleeper(AsyncContext& ctx) {
+        if (co_await sleepFor(ctx, std::chrono::milliseconds(5))) {
+            std::lock_guard<std::mutex> lock(threadsMutex);
+            threads.insert(std::this_thread::get_id());
+            ++woke;
+        }
+    }
+};
+#endif
+
+void test_topological_order() {
+    Pipeline p(PipelineConfig{"topo", "", ""});
+    auto src = std::make_shared<CounterSourceNode>("a_src");
+    auto mid = std::make_shared<RelayNode>("b_mid");
+    auto sink = std::make_shared<RelayNode>("c_sink");
+    // 故意乱序添加
+    assert(p.addNode(sink));
+    assert(p.addNode(mid));
+    assert(p.addNode(src));
+    assert(p.link("b_mid", "out", "c_sink", "in"));
+    assert(p.link("a_src", "out", "b_mid", "in"));
+
+    std::vector<std::string> order;
+    assert(p.topologicalOrder(order));
+    assert(order.size() == 3);
+    assert(order[0] == "a_src");
+    assert(order[1] == "b_mid");
+    assert(order[2] == "c_sink");
+    std::cout << "✅ test_topological_order passed" << std::endl;
+}
+
+void test_cycle_rejected() {
+    Pipeline p(PipelineConfig{"cycle", "", ""});
+    auto n1 = std::make_shared<RelayNode>("n1");
+    auto n2 = std::make_shared<RelayNode>("n2");
+    assert(p.addNode(n1));
+    assert(p.addNode(n2));
+    assert(p.link("n1", "out", "n2", "in"));
+    assert(p.link("n2", "out", "n1", "in"));
+
+    std::vector<std::string> order;
+    assert(!p.topologicalOrder(order));
+    assert(!p.setState(PipelineState::Playing));
+    assert(p.state() != PipelineState::Playing);
+    assert(!n1->started && !n2->started);
+    std::cout << "✅ test_cycle_rejected passed" << std::endl;
+}
+
+void test_scheduler_drives_chain() {
+    Pipeline p(PipelineConfig{"chain", "", ""});
+    auto src = std::make_shared<CounterSourceNode>("src");
+    auto mid = std::make_shared<RelayNode>("mid");
+    auto sink = std::make_shared<RelayNode>("sink");
+    assert(p.addNode(src) && p.addNode(mid) && p.addNode(sink));
+    assert(p.link("src", "out", "mid", "in"));
+    assert(p.link("mid", "out", "sink", "in"));
+
+    PipelineSchedulerConfig cfg;
+    cfg.workerThreads = 4;
+    p.scheduler().setConfig(cfg);
+    p.scheduler().setNodePeriod("src", std::chrono::milliseconds(5));
+
+    assert(p.setState(PipelineState::Playing));
+    assert(src->started && mid->started && sink->started);
+    assert(p.scheduler().isRunning());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    assert(p.setState(PipelineState::Null));
+    assert(!p.scheduler().isRunning());
+    assert(!src->started && !mid->started && !sink->started);
+
+    // 源节点按周期运行，下游节点由数据到达驱动
+    assert(src->produced > 10);
+    assert(mid->processed > 0);
+    assert(sink->processed > 0);
+    assert(!mid->concurrent && !sink->concurrent);
+    assert(p.scheduler().processCount("src") == src->produced);
+    std::cout << "✅ test_scheduler_drives_chain passed (src=" << src->produced
+              << ", mid=" << mid->processed << ", sink=" << sink->processed << ")" << std::endl;
+}
+
+void test_pause_keeps_nodes_started() {
+    Pipeline p(PipelineConfig{"pause", "", ""});
+    auto src = std::make_shared<CounterSourceNode>("src");
+    auto sink = std::make_shared<RelayNode>("sink");
+    assert(p.addNode(src) && p.addNode(sink));
+    assert(p.link("src", "out", "sink", "in"));
+    p.scheduler().setNodePeriod("src", std::chrono::milliseconds(5));
+
+    assert(p.setState(PipelineState::Playing));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    assert(p.setState(PipelineState::Paused));
+    assert(src->started && sink->started);
+    std::uint32_t producedAtPause = src->produced;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    assert(src->produced == producedAtPause);
+
+    assert(p.setState(PipelineState::Playing));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    assert(src->produced > producedAtPause);
+    assert(p.setState(PipelineState::Null));
+    assert(!src->started && !sink->started);
+    std::cout << "✅ test_pause_keeps_nodes_started passed" << std::endl;
+}
+
+// 记录 start/pause/resume 调用次数的源节点
+class HookCountingSourceNode : public CounterSourceNode {
+public:
+    using CounterSourceNode::CounterSourceNode;
+    bool start() override { ++starts; return CounterSourceNode::start(); }
+    void pause() override { ++pauses; }
+    void resume() override { ++resumes; }
+    std::atomic<int> starts{0};
+    std::atomic<int> pauses{0};
+    std::atomic<int> resumes{0};
+};
+
+// Paused 不拆除调度：恢复只唤醒线程，不重启节点；Paused 期间改拓扑则按新拓扑重建
+void test_pause_resume_fast_path() {
+    Pipeline p(PipelineConfig{"pause_fast", "", ""});
+    auto src = std::make_shared<HookCountingSourceNode>("src");
+    auto sink = std::make_shared<RelayNode>("sink");
+    assert(p.addNode(src) && p.addNode(sink));
+    LinkQueueConfig queue;
+    queue.enabled = true;
+    queue.capacity = 8;
+    assert(p.link("src", "out", "sink", "in", queue));
+    p.scheduler().setNodePeriod("src", std::chrono::milliseconds(2));
+
+    assert(p.setState(PipelineState::Playing));
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    assert(p.setState(PipelineState::Paused));
+    assert(p.scheduler().isRunning() && p.scheduler().isPaused());
+    assert(src->pauses == 1);
+    std::uint64_t srcCount = p.scheduler().processCount("src");
+    std::uint64_t sinkCount = p.scheduler().processCount("sink");
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    assert(p.scheduler().processCount("src") == srcCount);
+    assert(p.scheduler().processCount("sink") == sinkCount);
+
+    for (int i = 0; i < 5; ++i) {
+        auto begin = std::chrono::steady_clock::now();
+        assert(p.setState(PipelineState::Playing));
+        auto elapsed = std::chrono::steady_clock::now() - begin;
+        assert(elapsed < std::chrono::milliseconds(20));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert(p.setState(PipelineState::Paused));
+    }
+    assert(src->starts == 1);
+    assert(src->resumes == 5 && src->pauses == 6);
+    assert(p.scheduler().processCount("src") > srcCount);
+
+    // Paused 期间可移除节点；恢复时按新拓扑重建调度，已启动的节点不重启
+    assert(p.removeNode("sink"));
+    assert(!sink->started);
+    assert(p.setState(PipelineState::Playing));
+    assert(src->starts == 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(p.scheduler().processCount("sink") == 0);
+    assert(p.scheduler().processCount("src") > 0);
+    assert(p.setState(PipelineState::Null));
+    assert(!src->started);
+    std::cout << "✅ test_pause_resume_fast_path passed" << std::endl;
+}
+
+// 回调耗时的同步直连下游：记录同时执行回调的最大数量
+class SlowCallbackSinkNode : public Node {
+public:
+    SlowCallbackSinkNode(const std::string& id, std::atomic<int>& inFlight, std::atomic<int>& peak)
+        : Node(id), inFlight_(inFlight), peak_(peak) {
+        addPad(std::make_shared<Pad>("in", PadType::Sink));
+    }
+    bool start() override {
+        getPad("in")->setDataCallback([this](const void*, size_t) {
+            int now = inFlight_.fetch_add(1) + 1;
+            int seen = peak_.load();
+            while (now > seen && !peak_.compare_exchange_weak(seen, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            inFlight_.fetch_sub(1);
+            ++received;
+        });
+        return true;
+    }
+    std::atomic<int> received{0};
+
+private:
+    std::atomic<int>& inFlight_;
+    std::atomic<int>& peak_;
+};
+
+// parallelFanOutMin：一个 Source Pad 的多个同步下游在线程池并行投递，推送返回前全部完成
+void test_parallel_fan_out() {
+    Pipeline p(PipelineConfig{"fanout", "", ""});
+    auto src = std::make_shared<CounterSourceNode>("src");
+    assert(p.addNode(src));
+    std::atomic<int> inFlight{0};
+    std::atomic<int> peak{0};
+    std::vector<std::shared_ptr<SlowCallbackSinkNode>> sinks;
+    for (int i = 0; i < 4; ++i) {
+        auto sink = std::make_shared<SlowCallbackSinkNode>("sink" + std::to_string(i), inFlight, peak);
+        assert(p.addNode(sink));
+        assert(p.link("src", "out", sink->id(), "in"));
+        sinks.push_back(sink);
+    }
+    PipelineSchedulerConfig cfg;
+    cfg.workerThreads = 4;
+    cfg.parallelFanOutMin = 2;
+    p.scheduler().setConfig(cfg);
+    p.scheduler().setNodePeriod("src", std::chrono::milliseconds(20));
+
+    assert(p.setState(PipelineState::Playing));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    assert(p.setState(PipelineState::Null));
+
+    assert(src->produced > 3);
+    for (const auto& sink : sinks) {
+        assert(sink->received == static_cast<int>(src->produced.load()));
+    }
+    assert(peak >= 2);
+    std::cout << "✅ test_parallel_fan_out passed (frames=" << src->produced << ", peak=" << peak << ")"
+              << std::endl;
+}
+
+// 记录 process() 所在线程及其 CPU 亲和性
+class AffinityProbeNode : public RelayNode {
+public:
+    using RelayNode::RelayNode;
+    void process() override {
+        RelayNode::process();
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+            cpuCount = CPU_COUNT(&set);
+            onCpu0 = CPU_ISSET(0, &set);
+        }
+    }
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    int cpuCount{0};
+    bool onCpu0{false};
+};
+
+// 设置了 cpus 的下游节点在绑核的专用线程上执行
+void test_pinned_node_placement() {
+    Pipeline p(PipelineConfig{"placement", "", ""});
+    auto src = std::make_shared<CounterSourceNode>("src");
+    auto pinned = std::make_shared<AffinityProbeNode>("pinned");
+    auto pooled = std::make_shared<RelayNode>("pooled");
+    NodePlacement placement;
+    placement.cpus = {0};
+    pinned->setPlacement(placement);
+    assert(p.addNode(src) && p.addNode(pinned) && p.addNode(pooled));
+    assert(p.link("src", "out", "pinned", "in"));
+    assert(p.link("pinned", "out", "pooled", "in"));
+    PipelineSchedulerConfig cfg;
+    cfg.workerThreads = 2;
+    p.scheduler().setConfig(cfg);
+    p.scheduler().setNodePeriod("src", std::chrono::milliseconds(5));
+
+    assert(p.setState(PipelineState::Playing));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert(p.setState(PipelineState::Paused));
+    std::uint64_t pausedAt = p.scheduler().processCount("pinned");
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    assert(p.scheduler().processCount("pinned") == pausedAt);
+    assert(p.setState(PipelineState::Playing));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    assert(p.setState(PipelineState::Null));
+
+    assert(pinned->processed > 0 && pooled->processed > 0);
+    assert(p.scheduler().processCount("pinned") > pausedAt);
+    assert(pinned->threads.size() == 1);
+    assert(pinned->cpuCount == 1 && pinned->onCpu0);
+    assert(!pinned->concurrent);
+    std::cout << "✅ test_pinned_node_placement passed" << std::endl;
+}
+
+// 占满共享线程池的尽力而为节点
+class HogNode : public AffinityProbeNode {
+public:
+    using AffinityProbeNode::AffinityProbeNode;
+    void process() override {
+        AffinityProbeNode::process();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+};
+
+// 关键节点由预留线程按截止时间执行，不被尽力而为节点阻塞；超时完成计入 deadlineMisses
+void test_critical_node_edf() {
+    Pipeline p(PipelineConfig{"critical", "", ""});
+    auto src = std::make_shared<CounterSourceNode>("src");
+    auto hog = std::make_shared<HogNode>("hog");
+    auto critical = std::make_shared<AffinityProbeNode>("critical");
+    auto late = std::make_shared<AffinityProbeNode>("late");
+    NodePlacement placement;
+    placement.schedClass = SchedClass::Critical;
+    placement.deadline = std::chrono::milliseconds(200);
+    critical->setPlacement(placement);
+    placement.deadline = std::chrono::microseconds(500);  // process() 至少 2ms，每次都超时
+    late->setPlacement(placement);
+    assert(p.addNode(src) && p.addNode(hog) && p.addNode(critical) && p.addNode(late));
+    assert(p.link("src", "out", "hog", "in"));
+    assert(p.link("src", "out", "critical", "in"));
+    assert(p.link("src", "out", "late", "in"));
+    PipelineSchedulerConfig cfg;
+    cfg.workerThreads = 1;
+    cfg.criticalWorkers = 1;
+    cfg.criticalPriority = 0;  // 测试环境不一定有 CAP_SYS_NICE
+    p.scheduler().setConfig(cfg);
+    p.scheduler().setNodePeriod("src", std::chrono::milliseconds(10));
+
+    assert(p.setState(PipelineState::Playing));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    assert(p.setState(PipelineState::Null));
+
+    // 共享线程每 20ms 才空出一次，关键节点仍逐帧跟上 10ms 的源
+    assert(critical->processed + 2 >= static_cast<int>(src->produced.load()));
+    assert(hog->processed < critical->processed);
+    for (const auto& id : critical->threads) assert(hog->threads.count(id) == 0);
+    assert(!critical->concurrent && !late->concurrent);
+
+    NodeMetrics m;
+    assert(p.scheduler().nodeMetrics("late", m));
+    assert(m.hasDeadline && m.processCount > 0 && m.deadlineMisses == m.processCount && m.maxLatenessMs > 1.0);
+    assert(p.scheduler().nodeMetrics("hog", m) && !m.hasDeadline);
+    std::cout << "✅ test_critical_node_edf passed (critical=" << critical->processed << ", hog=" << hog->processed
+              << ")" << std::endl;
+}
+
+// 慢速下游通过队列连接：源节点不被阻塞，下游逐条处理且总数不超过队列允许范围
+void test_queued_link_does_not_stall_source() {
+    Pipeline p(PipelineConfig{"queued", "", ""});
+    auto src = std::make_shared<CounterSourceNode>("src");
+    auto slow = std::make_shared<RelayNode>("slow");
+    assert(p.addNode(src) && p.addNode(slow));
+    LinkQueueConfig qc;
+    qc.enabled = true;
+    qc.capacity = 2;
+    qc.policy = LinkQueuePolicy::DropOldest;
+    assert(p.link("src", "out", "slow", "in", qc));
+    p.scheduler().setNodePeriod("src", std::chrono::microseconds(0));  // 连续推送
+
+    assert(p.setState(PipelineState::Playing));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert(p.setState(PipelineState::Null));
+
+    auto queue = src->getPad("out")->connections()[0].queue;
+    assert(queue);
+    // 下游每次 process() 约 2ms，源节点远快于下游
+    assert(src->produced > static_cast<std::uint32_t>(slow->processed) * 10);
+    assert(queue->dropped() > 0);
+    assert(slow->processed > 0);
+    assert(!slow->concurrent);
+    std::cout << "✅ test_queued_link_does_not_stall_source passed (produced=" << src->produced
+              << ", processed=" << slow->processed << ", dropped=" << queue->dropped() << ")" << std::endl;
+}
+
+} // namespace
+
+void test_latency_histogram_percentiles() {
+    LatencyHistogram h;
+    assert(h.percentile(0.5) == 0);
+    for (std::uint64_t i = 1; i <= 100; ++i) {
+        h.record(i * 1000);  // 1us ~ 100us
+    }
+    assert(h.count() == 100);
+    assert(h.max() == 100000);
+    // 每个桶的相对误差 < 25%
+    auto p50 = h.percentile(0.5);
+    auto p99 = h.percentile(0.99);
+    assert(p50 >= 50000 && p50 < 50000 * 5 / 4);
+    assert(p99 >= 99000 && p99 <= 100000);
+    std::cout << "✅ test_latency_histogram_percentiles passed" << std::endl;
+}
+
+void test_pipeline_metrics() {
+    Pipeline p(PipelineConfig{"metrics", "", ""});
+    auto src = std::make_shared<CounterSourceNode>("src");
+    auto sink = std::make_shared<RelayNode>("sink");
+    assert(p.addNode(src) && p.addNode(sink));
+    LinkQueueConfig q;
+    q.enabled = true;
+    q.capacity = 2;
+    q.policy = LinkQueuePolicy::DropNewest;
+    assert(p.link("src", "out", "sink", "in", q));
+
+    // 未调度时：节点计数为 0，连接可手动推送计数
+    auto before = p.metrics();
+    assert(before.pipelineId == "metrics");
+    assert(before.nodes.size() == 2 && before.nodes[0].nodeId == "src");
+    assert(before.nodes[0].processCount == 0);
+    assert(before.links.size() == 1 && before.links[0].frames == 0);
+
+    p.scheduler().setNodePeriod("src", std::chrono::milliseconds(2));
+    assert(p.setState(PipelineState::Playing));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    assert(p.setState(PipelineState::Null));
+
+    auto m = p.metrics();
+    const auto& srcMetrics = m.nodes[0];
+    const auto& sinkMetrics = m.nodes[1];
+    assert(srcMetrics.processCount == src->produced);
+    assert(sinkMetrics.processCount > 0);
+    // RelayNode::process() 固定休眠 2ms
+    assert(sinkMetrics.p50Us >= 1500.0 && sinkMetrics.p99Us >= sinkMetrics.p50Us);
+    assert(sinkMetrics.maxUs >= sinkMetrics.p99Us);
+
+    const auto& link = m.links[0];
+    assert(link.srcNodeId == "src" && link.dstNodeId == "sink");
+    assert(link.frames == src->produced);
+    assert(link.bytes == link.frames * sizeof(std::uint32_t));
+    assert(link.framesPerSec > 0.0 && link.bytesPerSec > 0.0);
+    assert(toJson(m).find("\"frames_per_sec\"") != std::string::npos);
+    std::cout << "✅ test_pipeline_metrics passed (frames=" << link.frames << ", drops=" << link.drops
+              << ", sink p50=" << sinkMetrics.p50Us << "us)" << std::endl;
+}
+
+void test_parallel_start_independent_nodes() {
+    Pipeline p(PipelineConfig{"parallel_start", "", ""});
+    std::vector<std::shared_ptr<SlowStartNode>> nodes;
+    for (int i = 0; i < 4; ++i) {
+        nodes.push_back(std::make_shared<SlowStartNode>("slow_" + std::to_string(i), 100));
+        assert(p.addNode(nodes.back()));
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    assert(p.setState(PipelineState::Playing));
+    auto elapsed = std::chrono::steady_clock::now() - t0;
+    for (auto& n : nodes) assert(n->started);
+    // 串行需 400ms；并行应接近单个节点的启动耗时
+    assert(elapsed < std::chrono::milliseconds(300));
+    assert(p.startFailures().empty());
+    p.setState(PipelineState::Null);
+    std::cout << "✅ test_parallel_start_independent_nodes passed" << std::endl;
+}
+
+void test_start_failure_rolls_back() {
+    Pipeline p(PipelineConfig{"rollback", "", ""});
+    auto ok1 = std::make_shared<SlowStartNode>("ok1", 10);
+    auto ok2 = std::make_shared<SlowStartNode>("ok2", 10);
+    auto bad = std::make_shared<SlowStartNode>("bad", 30, true);
+    assert(p.addNode(ok1));
+    assert(p.addNode(ok2));
+    assert(p.addNode(bad));
+    assert(!p.setState(PipelineState::Playing));
+    assert(p.state() == PipelineState::Null);
+    assert(!ok1->started && !ok2->started);
+    assert(p.startFailures().size() == 1 && p.startFailures()[0] == "bad");
+    assert(bad->stops == 0);
+    std::cout << "✅ test_start_failure_rolls_back passed" << std::endl;
+}
+
+void test_async_node_event_loop() {
+    int pipeFds[2];
+    assert(::pipe(pipeFds) == 0);
+    Pipeline p(PipelineConfig{"async", "", ""});
+    auto src = std::make_shared<CounterSourceNode>("src");
+    auto relay = std::make_shared<AsyncRelayNode>("relay", pipeFds[0]);
+    auto sink = std::make_shared<RelayNode>("sink");
+    assert(p.addNode(src) && p.addNode(relay) && p.addNode(sink));
+    assert(p.link("src", "out", "relay", "in"));
+    assert(p.link("relay", "out", "sink", "in"));
+    p.scheduler().setNodePeriod("src", std::chrono::milliseconds(5));
+
+    assert(p.setState(PipelineState::Playing));
+    assert(p.scheduler().asyncLoop() && p.scheduler().asyncLoop()->running());
+    const char byte = 1;
+    assert(::write(pipeFds[1], &byte, 1) == 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    assert(relay->readable);
+    assert(relay->forwarded > 10 && sink->last > 0);
+    // 调度器不调用异步节点的 process()，回调都在事件循环线程
+    assert(relay->processCalls == 0 && p.scheduler().processCount("relay") == 0);
+    assert(!relay->offLoopThread);
+
+    assert(p.setState(PipelineState::Null));
+    assert(!p.scheduler().asyncLoop());
+    assert(relay->readCancelled && relay->stopped);
+    ::close(pipeFds[0]);
+    ::close(pipeFds[1]);
+    std::cout << "✅ test_async_node_event_loop passed (forwarded=" << relay->forwarded << ")" << std::endl;
+
+#if FALCONMIND_HAS_COROUTINES
+    Pipeline q(PipelineConfig{"coroutine", "", ""});
+    auto src2 = std::make_shared<CounterSourceNode>("src");
+    auto coro = std::make_shared<CoroutineRelayNode>("coro");
+    auto sink2 = std::make_shared<RelayNode>("sink");
+    assert(q.addNode(src2) && q.addNode(coro) && q.addNode(sink2));
+    assert(q.link("src", "out", "coro", "in"));
+    assert(q.link("coro", "out", "sink", "in"));
+    q.scheduler().setNodePeriod("src", std::chrono::milliseconds(5));
+    assert(q.setState(PipelineState::Playing));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    assert(coro->woke == CoroutineRelayNode::kSleepers && coro->threads.size() == 1);
+    assert(coro->forwarded > 10 && sink2->last > 0);
+    assert(!coro->relayFinished);
+    // 停止时挂起的 co_await 以“已取消”恢复，协程自然结束
+    assert(q.setState(PipelineState::Null));
+    assert(coro->relayFinished);
+    std::cout << "✅ test_async_node_event_loop coroutines passed (forwarded=" << coro->forwarded << ")" << std::endl;
+#endif
+}
+
+// 模拟内部推理线程卡住的节点：process() 立即返回，卡住与否由 pendingWorkAgeNs 报告；支持切换备用后端
+class StallableRelayNode : public RelayNode, public WatchdogTarget {
+public:
+    explicit StallableRelayNode(const std::string& id) : RelayNode(id) {}
+    std::int64_t pendingWorkAgeNs(std::int64_t nowNs) const override {
+        std::int64_t since = stuckSinceNs.load();
+        return since != 0 ? nowNs - since : 0;
+    }
+    bool applyWatchdogAction(WatchdogAction action) override {
+        if (action != WatchdogAction::FallbackBackend || fallback) return false;
+        fallback = true;
+        stuckSinceNs = 0;
+        return true;
+    }
+    std::atomic<std::int64_t> stuckSinceNs{0};
+    std::atomic<bool> fallback{false};
+};
+
+void test_node_watchdog() {
+    Pipeline p(PipelineConfig{"watchdog", "", ""});
+    auto src = std::make_shared<CounterSourceNode>("src");
+    auto det = std::make_shared<StallableRelayNode>("det");
+    auto slow = std::make_shared<RelayNode>("slow");
+    assert(p.addNode(src) && p.addNode(det) && p.addNode(slow));
+    assert(p.link("src", "out", "det", "in"));
+    assert(p.link("src", "out", "slow", "in"));
+    p.scheduler().setNodePeriod("src", std::chrono::milliseconds(5));
+    assert(!p.scheduler().setRateDivisor("src", 2));
+
+    NodeWatchdog watchdog(p.scheduler());
+    std::vector<WatchdogEvent> events;
+    watchdog.setEventCallback([&events](const WatchdogEvent& e) { events.push_back(e); });
+    WatchdogPolicy stall;
+    stall.stallTimeout = std::chrono::milliseconds(40);
+    stall.ladder = {WatchdogAction::Restart, WatchdogAction::FallbackBackend};
+    watchdog.watch(det, stall);
+    WatchdogPolicy slo;  // RelayNode 每次 process() 约 2ms
+    slo.latencySlo = std::chrono::milliseconds(1);
+    slo.violations = 2;
+    slo.ladder = {WatchdogAction::LowerResolution, WatchdogAction::LowerRate, WatchdogAction::LowerRate,
+                  WatchdogAction::LowerRate};
+    watchdog.watch(slow, slo);
+    watchdog.watch(src, WatchdogPolicy{});  // 未启用，忽略
+    assert(watchdog.watchedCount() == 2);
+
+    assert(p.setState(PipelineState::Playing));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    watchdog.check();
+    assert(events.empty());
+
+    // 内部工作卡住：Restart 因卡住不可用，改走 fallback
+    det->stuckSinceNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch()).count();
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    watchdog.check();
+    auto count = [&events](const std::string& id, WatchdogEventKind kind) {
+        int n = 0;
+        for (const auto& e : events) n += e.nodeId == id && e.kind == kind;
+        return n;
+    };
+    assert(count("det", WatchdogEventKind::Stalled) == 1);
+    assert(count("det", WatchdogEventKind::ActionTaken) == 1);
+    assert(det->fallback && det->started);
+    assert(watchdog.level("det") == 2);
+    // 第二个周期的违约触发 slow 降频（LowerResolution 不支持，跳过）
+    assert(count("slow", WatchdogEventKind::ActionTaken) == 1);
+    assert(p.scheduler().rateDivisor("slow") == 2);
+    for (const auto& e : events) {
+        if (e.kind != WatchdogEventKind::ActionTaken) continue;
+        assert(e.action == (e.nodeId == "det" ? WatchdogAction::FallbackBackend : WatchdogAction::LowerRate));
+        assert(toJson(e).find("\"action\"") != std::string::npos);
+    }
+
+    events.clear();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    watchdog.check();
+    assert(count("det", WatchdogEventKind::Recovered) == 1);
+    // 降频后仍超 SLO：逐级降到 1/8 后用尽 ladder，只上报一次 Exhausted（周期长于降频后的处理间隔 40ms）
+    for (int i = 0; i < 8; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        watchdog.check();
+    }
+    assert(count("slow", WatchdogEventKind::Exhausted) == 1);
+    assert(p.scheduler().rateDivisor("slow") == 8);
+    const std::uint64_t srcCount = p.scheduler().processCount("src");
+    assert(p.setState(PipelineState::Null));
+    assert(static_cast<std::uint64_t>(slow->processed) < srcCount / 2);
+    std::cout << "✅ test_node_watchdog passed (slow=" << slow->processed << "/" << srcCount << ")" << std::endl;
+}
+
+int main() {
+    std::cout << "Running PipelineScheduler tests..." << std::endl;
+
+    test_topological_order();
+    test_cycle_rejected();
+    test_scheduler_drives_chain();
+    test_pause_keeps_nodes_started();
+    test_pause_resume_fast_path();
+    test_parallel_fan_out();
+    test_pinned_node_placement();
+    test_critical_node_edf();
+    test_queued_link_does_not_stall_source();
+    test_latency_histogram_percentiles();
+    test_pipeline_metrics();
+    test_parallel_start_independent_nodes();
+    test_start_failure_rolls_back();
+    test_async_node_event_loop();
+    test_node_watchdog();
+
+    std::cout << "All PipelineScheduler tests passed!" << std::endl;
+    return 0;
+}
@@ -1,10 +1,21 @@
 // FalconMindSDK - SimpleTrackerBackend 与 SortTrackerBackend 单元测试
+#include "falconmind/sdk/core/FixedMatrix.h"
+#include "falconmind/sdk/perception/ByteTrackerBackend.h"
+#include "falconmind/sdk/perception/LinearAssignment.h"
+#include "falconmind/sdk/perception/MultiStreamTrackerHost.h"
+#include "falconmind/sdk/perception/ReidGallery.h"
+#include "falconmind/sdk/perception/ReidTrackRecovery.h"
 #include "falconmind/sdk/perception/SimpleTrackerBackend.h"
 #include "falconmind/sdk/perception/SortTrackerBackend.h"
+#include "falconmind/sdk/perception/TrackingDelta.h"
 #include "falconmind/sdk/perception/DetectionTypes.h"
 #include "falconmind/sdk/perception/TrackingTypes.h"
 
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 
 using namespace falconmind::sdk::perception;
@@ -141,6 +152,453 @@ static void test_sort_tracker_backend_delegate() {
     assert(!backend.isLoaded());
 }
 
+// 无检测帧按匀速外推：不计漏检、trackId 不变、不确定度递增，重新匹配后清零
+static void test_sort_tracker_predict_coasts_between_detections() {
+    SortTrackerBackend backend;
+    backend.setMaxMissedFrames(1);
+    assert(backend.load());
+    TrackingResult out;
+    DetectionResult det = makeDetections(0, 0, {{0, 0, 20, 20}});
+    assert(backend.run(det, out));
+    det = makeDetections(1, 1, {{10, 0, 20, 20}});
+    assert(backend.run(det, out));
+    const int id = det.detections[0].trackId;
+    assert(out.tracks.size() == 1 && out.tracks[0].uncertainty == 0.f);
+
+    float lastX = 10.f;
+    float lastUncertainty = 0.f;
+    for (std::uint32_t f = 2; f < 5; ++f) {
+        DetectionResult pred = makeDetections(f, f, {});
+        pred.trackerPredicted = true;
+        assert(backend.predict(pred, out));
+        assert(pred.detections.size() == 1 && pred.detections[0].trackId == id);
+        assert(pred.detections[0].bbox.x > lastX);
+        assert(out.tracks.size() == 1 && out.tracks[0].status == "PREDICTED");
+        assert(out.tracks[0].uncertainty > lastUncertainty);
+        lastX = pred.detections[0].bbox.x;
+        lastUncertainty = out.tracks[0].uncertainty;
+    }
+
+    det = makeDetections(5, 5, {{lastX + 7.f, 0, 20, 20}});
+    assert(backend.run(det, out));
+    assert(det.detections[0].trackId == id);
+    assert(out.tracks.size() == 1 && out.tracks[0].status == "ACTIVE" && out.tracks[0].uncertainty == 0.f);
+
+    SimpleTrackerBackend simple;
+    assert(simple.load());
+    assert(!simple.predict(det, out));
+}
+
+// JV 方阵分配与稀疏分配：对偶势求得全局最优，门控外的配对不会被选中
+static void test_linear_assignment_optimal() {
+    // 贪心按行取最小会得到 (0,0)+(1,1)=1+5，最优为 (0,1)+(1,0)=2+2
+    std::vector<double> cost{1, 2, 2, 5};
+    std::vector<int> rowToCol;
+    solveDenseAssignment(cost, 2, rowToCol);
+    assert(rowToCol.size() == 2 && rowToCol[0] == 1 && rowToCol[1] == 0);
+
+    // 3 行 2 列，行 2 没有候选；行 0 的两个候选中选择让行 1 也能匹配的那个
+    std::vector<AssignmentCandidate> cands{{0, 0, 0.2f}, {0, 1, 0.1f}, {1, 1, 0.3f}};
+    solveSparseAssignment(3, 2, cands, 0.5f, rowToCol);
+    assert(rowToCol.size() == 3 && rowToCol[0] == 0 && rowToCol[1] == 1 && rowToCol[2] == -1);
+
+    std::vector<AssignmentCandidate> gated;
+    gateByIou({DetectionBBox{0, 0, 10, 10}, DetectionBBox{500, 500, 10, 10}},
+              {DetectionBBox{1, 0, 10, 10}, DetectionBBox{200, 0, 10, 10}}, 0.3f, gated);
+    assert(gated.size() == 1 && gated[0].row == 0 && gated[0].col == 0);
+}
+
+// 拥挤场景：高分检测与两条轨迹都重叠，按分数贪心会抢走 B，导致 A 漏检、B 的真实检测新建轨迹
+static void test_sort_tracker_crowded_optimal_assignment() {
+    SortTrackerBackend backend;
+    assert(backend.load());
+    TrackingResult out;
+    DetectionResult det = makeDetections(0, 0, {{0, 0, 10, 10}, {6, 0, 10, 10}});
+    assert(backend.run(det, out));
+    const int idA = det.detections[0].trackId;
+    const int idB = det.detections[1].trackId;
+    assert(idA != idB);
+
+    det = makeDetections(1, 1, {{3.5f, 0, 10, 10}, {9, 0, 10, 10}});
+    det.detections[0].score = 0.95f;  // IoU(A)=0.48，IoU(B)=0.6
+    assert(backend.run(det, out));
+    assert(det.detections[0].trackId == idA);
+    assert(det.detections[1].trackId == idB);
+    assert(out.tracks.size() == 2);
+}
+
+// 广域搜索规模：600 个目标匀速平移，所有轨迹保持 ID，不产生新轨迹
+static void test_sort_tracker_many_targets_keep_ids() {
+    SortTrackerBackend backend;
+    assert(backend.load());
+    const int cols = 30;
+    const int count = 600;
+    auto frame = [&](std::uint32_t f) {
+        std::vector<std::array<float, 4>> boxes;
+        for (int i = 0; i < count; ++i) {
+            const float x = static_cast<float>(i % cols) * 24.f + static_cast<float>(f) * 2.f;
+            const float y = static_cast<float>(i / cols) * 24.f + static_cast<float>(f);
+            boxes.push_back({x, y, 16.f, 16.f});
+        }
+        return makeDetections(f, f, boxes);
+    };
+    TrackingResult out;
+    DetectionResult det = frame(0);
+    assert(backend.run(det, out));
+    std::vector<int> ids;
+    for (const auto& d : det.detections) ids.push_back(d.trackId);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const std::uint32_t frames = 20;
+    for (std::uint32_t f = 1; f <= frames; ++f) {
+        det = frame(f);
+        assert(backend.run(det, out));
+        for (int i = 0; i < count; ++i) assert(det.detections[static_cast<std::size_t>(i)].trackId == ids[static_cast<std::size_t>(i)]);
+        assert(out.tracks.size() == static_cast<std::size_t>(count));
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "[simple_tracker_backend_tests] " << count << " targets: " << ms / frames << " ms/frame" << std::endl;
+}
+
+// 历史环形缓冲：容量满后覆盖最旧点，history 视图按时间从旧到新；深拷贝按需开启
+static void test_sort_tracker_history_ring_buffer() {
+    SortTrackerBackend backend;
+    backend.setMaxTrajectoryPoints(4);
+    assert(backend.load());
+    TrackingResult out;
+    for (std::uint32_t f = 0; f < 10; ++f) {
+        DetectionResult det = makeDetections(f, f, {{static_cast<float>(f), 0, 20, 20}});
+        assert(backend.run(det, out));
+    }
+    assert(out.tracks.size() == 1);
+    const TrajectoryView& h = out.tracks[0].history;
+    assert(h.size() == 4);
+    for (std::size_t i = 0; i < h.size(); ++i) assert(h[i].timestampNs == 6 + i);
+    assert(h.back().bbox.x == 9.f);
+    assert(out.tracks[0].trajectory.empty());
+
+    // 缩小容量保留最近的点；开启拷贝后 trajectory 与视图一致
+    backend.setMaxTrajectoryPoints(2);
+    backend.setCopyTrajectory(true);
+    DetectionResult det = makeDetections(10, 10, {{10, 0, 20, 20}});
+    assert(backend.run(det, out));
+    assert(out.tracks[0].history.size() == 2);
+    assert(out.tracks[0].history[0].timestampNs == 9 && out.tracks[0].history[1].timestampNs == 10);
+    assert(out.tracks[0].trajectory.size() == 2 && out.tracks[0].trajectory[1].timestampNs == 10);
+
+    // 删除轨迹后槽位复用，新轨迹的历史从空开始
+    backend.setMaxMissedFrames(0);
+    det = makeDetections(11, 11, {{500, 500, 20, 20}});
+    assert(backend.run(det, out));
+    assert(out.tracks.size() == 2 && out.tracks[0].status == "LOST" && out.tracks[1].history.size() == 1);
+    det = makeDetections(12, 12, {{900, 900, 20, 20}});
+    assert(backend.run(det, out));
+    assert(backend.table().size() == 1);
+    assert(out.tracks.back().history.size() == 1 && out.tracks.back().history[0].timestampNs == 12);
+}
+
+// 增量输出：只有新增 / 有新点 / 丢失的轨迹进入增量；解码端重建结果与快照一致，丢包后等待关键帧
+static void test_tracking_delta_round_trip() {
+    SortTrackerBackend backend;
+    backend.setMaxMissedFrames(1);
+    assert(backend.load());
+    TrackingDeltaEncoder encoder;
+    encoder.setKeyframeInterval(0);
+    TrackingDeltaDecoder decoder;
+    TrackingResult out;
+    TrackingDelta delta;
+
+    DetectionResult det = makeDetections(1, 0, {{0, 0, 20, 20}, {100, 0, 20, 20}, {200, 0, 20, 20}});
+    assert(backend.run(det, out));
+    encoder.encode(out, delta);
+    assert(delta.keyframe && delta.added.size() == 3 && delta.sequence == 1);
+    assert(decoder.apply(delta));
+
+    // 第 2 帧只检测到前两个目标：第三个外推、无新点，不进入增量
+    det = makeDetections(2, 1, {{1, 0, 20, 20}, {101, 0, 20, 20}});
+    assert(backend.run(det, out));
+    encoder.encode(out, delta);
+    assert(!delta.keyframe && delta.added.empty() && delta.updated.size() == 2 && delta.removed.empty());
+    assert(delta.updated[0].trajectory.size() == 1 && delta.updated[0].trajectory[0].timestampNs == 2);
+    assert(decoder.apply(delta));
+
+    // 第 3 帧：第三个目标超过漏检上限 -> removed；新目标 -> added
+    det = makeDetections(3, 2, {{2, 0, 20, 20}, {102, 0, 20, 20}, {400, 400, 20, 20}});
+    assert(backend.run(det, out));
+    encoder.encode(out, delta);
+    assert(delta.removed.size() == 1 && delta.added.size() == 1 && delta.updated.size() == 2);
+    assert(decoder.apply(delta));
+
+    const auto rebuilt = decoder.tracks();
+    std::size_t active = 0;
+    for (const auto& t : out.tracks) {
+        if (t.status == "LOST") continue;
+        assert(rebuilt[active].trackId == t.trackId);
+        assert(rebuilt[active].trajectory.size() == t.history.size());
+        assert(rebuilt[active].trajectory.back().timestampNs == t.history.back().timestampNs);
+        ++active;
+    }
+    assert(rebuilt.size() == active && active == 3);
+
+    // 丢失一帧增量：解码端失步，直到关键帧恢复
+    det = makeDetections(4, 3, {{3, 0, 20, 20}});
+    assert(backend.run(det, out));
+    encoder.encode(out, delta);
+    det = makeDetections(5, 4, {{4, 0, 20, 20}});
+    assert(backend.run(det, out));
+    encoder.encode(out, delta);
+    assert(!decoder.apply(delta) && !decoder.synced());
+    encoder.requestKeyframe();
+    det = makeDetections(6, 5, {{5, 0, 20, 20}});
+    assert(backend.run(det, out));
+    encoder.encode(out, delta);
+    assert(delta.keyframe && decoder.apply(delta) && decoder.synced());
+    assert(decoder.tracks().size() == 1 && decoder.tracks()[0].trajectory.size() == 6);
+}
+
+// 定尺寸矩阵：乘法 / 转置 / Cholesky 求逆
+static void test_fixed_matrix_cholesky_inverse() {
+    using falconmind::sdk::core::Matrix;
+    Matrix<float, 3, 3> a;
+    a.data = {4, 2, 0.6f, 2, 2, 0.4f, 0.6f, 0.4f, 3};
+    Matrix<float, 3, 3> inv;
+    assert(falconmind::sdk::core::choleskyInverse(a, inv));
+    const auto id = a * inv;
+    for (std::size_t r = 0; r < 3; ++r)
+        for (std::size_t c = 0; c < 3; ++c) assert(std::fabs(id(r, c) - (r == c ? 1.f : 0.f)) < 1e-4f);
+    Matrix<float, 2, 3> b;
+    b.data = {1, 2, 3, 4, 5, 6};
+    const auto bt = b.transpose();
+    assert(bt(2, 1) == 6.f && (b * bt)(0, 0) == 14.f);
+    Matrix<float, 2, 2> notSpd;
+    notSpd.data = {1, 2, 2, 1};
+    Matrix<float, 2, 2> inv2;
+    assert(!falconmind::sdk::core::choleskyInverse(notSpd, inv2));
+}
+
+// 按真实时间戳预测：检测每 5 帧才运行一次（中间 predict 或整帧丢失），轨迹 ID 与位置保持
+static void test_bytetrack_predicts_on_timestamps() {
+    ByteTrackerBackend backend;
+    assert(backend.load());
+    const std::uint64_t period = 33333333;
+    const float speed = 300.f;  // px/s，每帧 10px，超过间隔 5 帧后框已不重叠
+    auto boxAt = [&](std::uint32_t f) {
+        const float x = 100.f + speed * static_cast<float>(f) * static_cast<float>(period) * 1e-9f;
+        return std::array<float, 4>{x, 100.f, 20.f, 40.f};
+    };
+    TrackingResult out;
+    int id = -1;
+    for (std::uint32_t f = 0; f < 6; ++f) {
+        DetectionResult det = makeDetections(f * period + 1, f, {boxAt(f)});
+        assert(backend.run(det, out));
+        if (id < 0) id = det.detections[0].trackId;
+        assert(det.detections[0].trackId == id);
+    }
+    for (std::uint32_t f = 6; f < 60; ++f) {
+        DetectionResult det = makeDetections(f * period + 1, f, {boxAt(f)});
+        if (f % 5 == 0) {
+            assert(backend.run(det, out));
+            assert(det.detections[0].trackId == id);
+            assert(out.tracks.size() == 1 && out.tracks[0].status == "ACTIVE");
+        } else if (f % 5 == 1) {
+            // 整帧丢失：不调用跟踪器
+        } else {
+            DetectionResult pred = makeDetections(f * period + 1, f, {});
+            assert(backend.predict(pred, out));
+            assert(pred.detections.size() == 1 && pred.detections[0].trackId == id);
+            // 速度估计收敛后外推误差在 1px 以内（均匀 dt 假设下丢帧会累积成数十像素）
+            const float err = std::fabs(pred.detections[0].bbox.x - boxAt(f)[0]);
+            assert(err < (f < 20 ? 15.f : 1.f));
+            assert(out.tracks[0].status == "PREDICTED");
+        }
+    }
+    assert(backend.tracks().size() == 1);
+}
+
+// 两阶段关联：低分检测只延续已有轨迹，不新建轨迹
+static void test_bytetrack_low_score_second_stage() {
+    ByteTrackerBackend backend;
+    assert(backend.load());
+    TrackingResult out;
+    DetectionResult det = makeDetections(1, 0, {{0, 0, 20, 40}});
+    assert(backend.run(det, out));
+    const int id = det.detections[0].trackId;
+
+    // 目标变模糊（分数 0.3）：第二阶段匹配原轨迹；远处的低分检测被忽略
+    det = makeDetections(33333334, 1, {{1, 0, 20, 40}, {300, 300, 20, 40}});
+    det.detections[0].score = 0.3f;
+    det.detections[1].score = 0.3f;
+    assert(backend.run(det, out));
+    assert(det.detections[0].trackId == id);
+    assert(det.detections[1].trackId == -1);
+    assert(out.tracks.size() == 1 && out.tracks[0].history.size() == 2);
+
+    // 0.05 低于 lowScoreThreshold，直接忽略；轨迹记一次漏检
+    det = makeDetections(66666667, 2, {{2, 0, 20, 40}});
+    det.detections[0].score = 0.05f;
+    assert(backend.run(det, out));
+    assert(det.detections[0].trackId == -1 && out.tracks.size() == 1 && backend.tracks()[0].missedFrames == 1);
+}
+
+// 多路宿主：各流在工作线程上按序处理、互不阻塞；重叠相机的同一目标融合为同一 globalId
+static void test_multi_stream_tracker_host() {
+    MultiStreamTrackerHost host(3);
+    host.setMaxQueuedFrames(64);
+    host.setFusionRadius(5.0);
+    const int streams = 4;
+    for (int i = 0; i < streams; ++i) {
+        TrackerStreamConfig cfg;
+        cfg.id = "cam" + std::to_string(i);
+        cfg.backend = std::make_shared<SortTrackerBackend>();
+        if (i < 3) {
+            // cam1 相对 cam0 右移 1000 像素拍摄同一地面
+            cfg.hasGroundHomography = true;
+            if (i == 1) cfg.imageToGround(0, 2) = -1000.0;
+        }
+        assert(host.addStream(std::move(cfg)) == i);
+    }
+    assert(host.start());
+    assert(host.addStream(TrackerStreamConfig{}) == -1);
+
+    std::array<std::atomic<int>, streams> calls{};
+    std::array<std::atomic<std::uint32_t>, streams> lastFrame{};
+    std::atomic<bool> ordered{true};
+    host.setResultCallback([&](std::size_t s, const DetectionResult& det, const TrackingResult&) {
+        if (calls[s]++ > 0 && det.frameIndex != lastFrame[s] + 1) ordered = false;
+        lastFrame[s] = det.frameIndex;
+    });
+    const std::uint32_t frames = 30;
+    for (std::uint32_t f = 0; f < frames; ++f) {
+        const float x = 100.f + static_cast<float>(f);
+        assert(host.submit(0, makeDetections(1000 + f, f, {{x, 50, 20, 20}})));
+        assert(host.submit(1, makeDetections(1000 + f, f, {{x + 1000.f, 50, 20, 20}})));
+        assert(host.submit(2, makeDetections(1000 + f, f, {{600, 400, 20, 20}})));
+        assert(host.submit(3, makeDetections(1000 + f, f, {{10, 10, 20, 20}})));
+    }
+    host.waitIdle();
+    assert(ordered);
+    for (int i = 0; i < streams; ++i) {
+        assert(calls[static_cast<std::size_t>(i)] == static_cast<int>(frames));
+        assert(host.stats(static_cast<std::size_t>(i)).processed == frames);
+        assert(host.stats(static_cast<std::size_t>(i)).dropped == 0);
+    }
+    // cam0 / cam1 各自的 trackId 1 融合为同一目标；cam2 独立；cam3 未配置单应不参与融合
+    const int g0 = host.globalIdOf(0, 1);
+    assert(g0 > 0 && g0 == host.globalIdOf(1, 1));
+    assert(host.globalIdOf(2, 1) > 0 && host.globalIdOf(2, 1) != g0);
+    assert(host.globalIdOf(3, 1) == -1);
+    const auto fused = host.fusedTracks();
+    assert(fused.size() == 2);
+    host.stop();
+    assert(!host.submit(0, makeDetections(0, 0, {})));
+}
+
+// ReID 特征库：SIMD 点积与标量一致；满容量时淘汰最久未见条目；时间窗过滤
+static void test_reid_gallery() {
+    const std::size_t dim = 37;  // 非 8 的倍数，覆盖尾部处理
+    std::vector<float> a(dim), b(dim);
+    float ref = 0.f;
+    for (std::size_t i = 0; i < dim; ++i) {
+        a[i] = std::sin(static_cast<float>(i));
+        b[i] = std::cos(static_cast<float>(i) * 0.7f);
+        ref += a[i] * b[i];
+    }
+    assert(std::fabs(ReidGallery::dot(a.data(), b.data(), dim) - ref) < 1e-4f);
+    normalizeEmbedding(a.data(), dim);
+    normalizeEmbedding(b.data(), dim);
+
+    ReidGallery g(2, dim);
+    g.update(1, a.data(), 100);
+    g.update(2, b.data(), 200);
+    ReidMatch m = g.best(a.data(), 0.9f, 0, 1000);
+    assert(m.id == 1 && std::fabs(m.similarity - 1.f) < 1e-4f);
+    // 时间窗外的条目不参与检索
+    assert(g.best(a.data(), 0.9f, 150, 1000).id == -1);
+    // 满：新 ID 覆盖 lastSeen 最早的 1
+    g.update(3, a.data(), 300);
+    assert(g.size() == 2 && !g.contains(1) && g.contains(2) && g.contains(3));
+    assert(g.best(a.data(), 0.9f, 0, 1000).id == 3);
+    assert(g.remove(3) && g.size() == 1);
+    std::cout << "  reid dot kernel: " << ReidGallery::kernelName() << std::endl;
+}
+
+// 合成帧：灰色背景上绘制纯色目标
+static void paintTarget(std::vector<std::uint8_t>& img, int width, const std::array<float, 4>& box,
+                        std::uint8_t r, std::uint8_t g, std::uint8_t b) {
+    for (int y = static_cast<int>(box[1]); y < static_cast<int>(box[1] + box[3]); ++y) {
+        for (int x = static_cast<int>(box[0]); x < static_cast<int>(box[0] + box[2]); ++x) {
+            std::uint8_t* p = &img[(static_cast<std::size_t>(y) * width + x) * 3];
+            p[0] = r;
+            p[1] = g;
+            p[2] = b;
+        }
+    }
+}
+
+// ReID 找回：目标被遮挡至轨迹 LOST 后在别处重新出现，ByteTrack 新建本地轨迹，对外仍沿用原 ID
+static void test_reid_recovers_lost_track() {
+    const int w = 320, h = 240;
+    auto backend = std::make_shared<ByteTrackerBackend>();
+    backend->setMaxMissedFrames(5);
+    assert(backend->load());
+    ReidTrackRecovery reid(std::make_shared<ColorHistogramEmbeddingExtractor>(), 16);
+    reid.resetMission("mission-a");
+
+    std::vector<std::uint8_t> img(static_cast<std::size_t>(w) * h * 3);
+    ImageView view;
+    view.data = img.data();
+    view.width = w;
+    view.height = h;
+    view.stride = w * 3;
+    view.format = falconmind::sdk::core::PixelFormat::RGB8;
+
+    const std::array<float, 4> redBefore{40, 100, 30, 60};
+    const std::array<float, 4> redAfter{120, 100, 30, 60};
+    const std::array<float, 4> blue{220, 100, 30, 60};
+    const std::array<float, 4> green{40, 20, 30, 40};
+    int redId = -1, blueId = -1, greenId = -1;
+    for (std::uint32_t f = 0; f < 40; ++f) {
+        std::fill(img.begin(), img.end(), std::uint8_t{128});
+        std::vector<std::array<float, 4>> boxes{blue};
+        paintTarget(img, w, blue, 20, 40, 230);
+        if (f < 10) {
+            boxes.push_back(redBefore);
+            paintTarget(img, w, redBefore, 230, 30, 20);
+        } else if (f >= 20) {
+            boxes.push_back(redAfter);
+            paintTarget(img, w, redAfter, 230, 30, 20);
+        }
+        if (f >= 30) {
+            boxes.push_back(green);
+            paintTarget(img, w, green, 30, 220, 40);
+        }
+        DetectionResult det = makeDetections(1'000'000'000ull + f * 33'333'333ull, f, boxes);
+        TrackingResult tracks;
+        assert(backend->run(det, tracks));
+        assert(reid.process(view, det, tracks));
+
+        const int blueOut = det.detections[0].trackId;
+        if (f == 0) {
+            blueId = blueOut;
+            redId = det.detections[1].trackId;
+            assert(blueId > 0 && redId > 0 && blueId != redId);
+        }
+        assert(blueOut == blueId);
+        if (f >= 20) assert(det.detections[1].trackId == redId);
+        if (f == 30) greenId = det.detections[2].trackId;
+        if (f >= 30) assert(det.detections[2].trackId == greenId && greenId != redId && greenId != blueId);
+        // 对外轨迹 ID 不重复
+        for (std::size_t i = 0; i < tracks.tracks.size(); ++i)
+            for (std::size_t j = i + 1; j < tracks.tracks.size(); ++j)
+                assert(tracks.tracks[i].trackId != tracks.tracks[j].trackId);
+    }
+    assert(reid.recoveredCount() == 1);
+    assert(reid.stableIdOf(redId) == -1);  // 原本地轨迹已结束，由新本地轨迹映射到 redId
+    // 切换任务清空特征库
+    reid.resetMission("mission-b");
+    assert(reid.gallery().size() == 0);
+}
+
 int main() {
     std::cout << "[simple_tracker_backend_tests] Running..." << std::endl;
     test_load_unload();
@@ -151,6 +609,18 @@ int main() {
     test_two_distant_boxes_two_tracks();
     test_output_frame_metadata();
     test_sort_tracker_backend_delegate();
+    test_sort_tracker_predict_coasts_between_detections();
+    test_linear_assignment_optimal();
+    test_sort_tracker_crowded_optimal_assignment();
+    test_sort_tracker_many_targets_keep_ids();
+    test_sort_tracker_history_ring_buffer();
+    test_tracking_delta_round_trip();
+    test_fixed_matrix_cholesky_inverse();
+    test_bytetrack_predicts_on_timestamps();
+    test_bytetrack_low_score_second_stage();
+    test_multi_stream_tracker_host();
+    test_reid_gallery();
+    test_reid_recovers_lost_track();
     std::cout << "[simple_tracker_backend_tests] All passed." << std::endl;
     return 0;
 }
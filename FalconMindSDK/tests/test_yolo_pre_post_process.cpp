@@ -1,12 +1,18 @@
-// FalconMindSDK - YoloPrePostProcess 单元测试（decode / NMS / fill）
+// FalconMindSDK - YoloPrePostProcess 单元测试（前处理 / decode / NMS / fill）
 #include "falconmind/sdk/perception/YoloPrePostProcess.h"
+#include "falconmind/sdk/perception/ClassFilter.h"
 #include "falconmind/sdk/perception/DetectionTypes.h"
+#include "falconmind/sdk/sensors/ColorConvert.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <vector>
 
+using namespace falconmind::sdk;
 using namespace falconmind::sdk::perception;
 
 static void test_decode_empty_and_threshold() {
@@ -117,6 +123,530 @@ static void test_resize_image_to_float_nchw() {
     assert(dst[0 * 4 + 3] < 0.01f);
 }
 
+// 参考实现：逐像素半像素中心双线性（与 OpenCV INTER_LINEAR 相同的坐标映射）
+static float referenceSample(const std::vector<std::uint8_t>& img, int w, int h, int c, float sx, float sy) {
+    sx = std::min(std::max(sx, 0.0f), static_cast<float>(w - 1));
+    sy = std::min(std::max(sy, 0.0f), static_cast<float>(h - 1));
+    int x0 = static_cast<int>(sx), y0 = static_cast<int>(sy);
+    int x1 = std::min(x0 + 1, w - 1), y1 = std::min(y0 + 1, h - 1);
+    float fx = sx - x0, fy = sy - y0;
+    auto at = [&](int x, int y) { return static_cast<float>(img[(y * w + x) * 3 + c]); };
+    float top = at(x0, y0) + fx * (at(x1, y0) - at(x0, y0));
+    float bottom = at(x0, y1) + fx * (at(x1, y1) - at(x0, y1));
+    return (top + fy * (bottom - top)) / 255.0f;
+}
+
+static void test_letterbox_transform_and_padding() {
+    LetterboxTransform t = computeLetterbox(1280, 720, 640, 640, ResizeMode::Letterbox);
+    assert(std::abs(t.scaleX - 0.5f) < 1e-6f && std::abs(t.scaleY - 0.5f) < 1e-6f);
+    assert(t.padX == 0.0f && t.padY == 140.0f);
+    LetterboxTransform s = computeLetterbox(1280, 720, 640, 640, ResizeMode::Stretch);
+    assert(s.padY == 0.0f && std::abs(s.scaleY - 640.0f / 720.0f) < 1e-6f);
+
+    // 纯色 BGR 图：内容区为该颜色（RGB 顺序输出），上下填充 114
+    const int w = 64, h = 36;
+    std::vector<std::uint8_t> img(w * h * 3);
+    for (int i = 0; i < w * h; ++i) {
+        img[i * 3 + 0] = 10;   // B
+        img[i * 3 + 1] = 20;   // G
+        img[i * 3 + 2] = 200;  // R
+    }
+    YoloPreprocessConfig cfg;
+    cfg.threads = 1;
+    YoloPreprocessor pre(cfg);
+    std::vector<float> dst(3 * 32 * 32, -1.0f);
+    LetterboxTransform lt = pre.run(img.data(), w, h, w * 3, true, dst.data(), 32, 32);
+    assert(lt.padY == 7.0f && std::abs(lt.scaleX - 0.5f) < 1e-6f);
+    const float pad = 114.0f / 255.0f;
+    for (int c = 0; c < 3; ++c) {
+        const float expect = (c == 0 ? 200 : c == 1 ? 20 : 10) / 255.0f;
+        for (int y = 0; y < 32; ++y) {
+            for (int x = 0; x < 32; ++x) {
+                float v = dst[c * 1024 + y * 32 + x];
+                bool content = y >= 7 && y < 25;
+                assert(std::abs(v - (content ? expect : pad)) < 1e-6f);
+            }
+        }
+    }
+}
+
+static void test_preprocessor_matches_reference_and_threads() {
+    const int w = 333, h = 187;
+    std::vector<std::uint8_t> img(w * h * 3);
+    std::uint32_t seed = 12345;
+    for (auto& v : img) {
+        seed = seed * 1664525u + 1013904223u;
+        v = static_cast<std::uint8_t>(seed >> 24);
+    }
+    for (ResizeMode mode : {ResizeMode::Letterbox, ResizeMode::Stretch}) {
+        const int dw = 320, dh = 256;
+        YoloPreprocessConfig single;
+        single.mode = mode;
+        single.threads = 1;
+        YoloPreprocessConfig multi = single;
+        multi.threads = 4;
+        YoloPreprocessor a(single), b(multi);
+        assert(b.threads() == 4);
+        std::vector<float> outA(3 * dw * dh), outB(3 * dw * dh);
+        LetterboxTransform ta = a.run(img.data(), w, h, w * 3, false, outA.data(), dw, dh);
+        b.run(img.data(), w, h, w * 3, false, outB.data(), dw, dh);
+        b.run(img.data(), w, h, w * 3, false, outB.data(), dw, dh);  // 复用缓存的坐标表
+        assert(std::memcmp(outA.data(), outB.data(), outA.size() * sizeof(float)) == 0);
+
+        const int contentW = static_cast<int>(std::lround(w * ta.scaleX));
+        const int contentH = static_cast<int>(std::lround(h * ta.scaleY));
+        float worst = 0.0f;
+        for (int c = 0; c < 3; ++c) {
+            for (int y = 0; y < contentH; ++y) {
+                for (int x = 0; x < contentW; ++x) {
+                    float sx = (x + 0.5f) * w / contentW - 0.5f;
+                    float sy = (y + 0.5f) * h / contentH - 0.5f;
+                    float ref = referenceSample(img, w, h, c, sx, sy);
+                    float v = outA[c * dw * dh + (y + static_cast<int>(ta.padY)) * dw + x + static_cast<int>(ta.padX)];
+                    worst = std::max(worst, std::abs(v - ref));
+                }
+            }
+        }
+        assert(worst < 1e-4f);
+    }
+    std::cout << "  preprocess kernel: " << YoloPreprocessor::kernelName() << std::endl;
+}
+
+static void test_fill_with_letterbox_transform() {
+    // 1280x720 → 640x640：scale 0.5，padY 140
+    LetterboxTransform t = computeLetterbox(1280, 720, 640, 640, ResizeMode::Letterbox);
+    std::vector<YoloRawDet> raw = {
+        {100, 200, 50, 40, 0.9f, 1},   // 内容区内
+        {600, 480, 100, 40, 0.8f, 2},  // 越过右下边界：裁剪
+        {10, 10, 50, 50, 0.7f, 3},     // 完全在上方填充区：丢弃
+    };
+    std::vector<bool> suppressed(raw.size(), false);
+    DetectionResult result;
+    fillDetectionResultFromYolo(raw, suppressed, t, 1280, 720, result);
+    assert(result.detections.size() == 2);
+    const auto& a = result.detections[0].bbox;
+    assert(std::abs(a.x - 200) < 1e-4f && std::abs(a.y - 120) < 1e-4f);
+    assert(std::abs(a.width - 100) < 1e-4f && std::abs(a.height - 80) < 1e-4f);
+    const auto& b = result.detections[1].bbox;
+    assert(std::abs(b.x - 1200) < 1e-4f && std::abs(b.width - 80) < 1e-4f);
+    assert(std::abs(b.y - 680) < 1e-4f && std::abs(b.height - 40) < 1e-4f);
+    assert(result.detections[1].classId == 2);
+}
+
+static float halfToFloat(std::uint16_t h) {
+    const int exp = (h >> 10) & 0x1f;
+    const int mant = h & 0x3ff;
+    float v = exp == 0 ? std::ldexp(static_cast<float>(mant), -24)
+                       : std::ldexp(static_cast<float>(mant | 0x400), exp - 25);
+    return (h & 0x8000) ? -v : v;
+}
+
+static std::vector<std::uint8_t> randomBytes(std::size_t n, std::uint32_t seed) {
+    std::vector<std::uint8_t> out(n);
+    for (auto& v : out) {
+        seed = seed * 1664525u + 1013904223u;
+        v = static_cast<std::uint8_t>(seed >> 24);
+    }
+    return out;
+}
+
+// NV12/YUYV 融合路径与“先整帧转 RGB 再缩放”逐位一致
+static void test_fused_yuv_matches_convert_then_resize() {
+    const int w = 322, h = 180, stride = 336;  // 行尾带填充
+    YoloPreprocessConfig cfg;
+    cfg.threads = 3;
+    YoloPreprocessor pre(cfg);
+    InputTensorSpec spec;
+    spec.width = 256;
+    spec.height = 256;
+
+    std::vector<std::uint8_t> nv12 = randomBytes(static_cast<std::size_t>(stride) * (h + h / 2), 7);
+    std::vector<std::uint8_t> yuyv = randomBytes(static_cast<std::size_t>(stride * 2) * h, 11);
+    struct Case {
+        core::PixelFormat format;
+        const std::vector<std::uint8_t>* data;
+        int stride;
+    };
+    for (const Case& c : {Case{core::PixelFormat::NV12, &nv12, stride}, Case{core::PixelFormat::YUYV, &yuyv, stride * 2}}) {
+        std::vector<std::uint8_t> rgb(static_cast<std::size_t>(w) * h * 3);
+        if (c.format == core::PixelFormat::NV12) {
+            sensors::convertNv12ToRgb(c.data->data(), c.stride, rgb.data(), w, h, false);
+        } else {
+            sensors::convertYuyvToRgb(c.data->data(), c.stride, rgb.data(), w, h, false);
+        }
+        std::vector<float> expect(3 * 256 * 256), fused(3 * 256 * 256);
+        LetterboxTransform te = pre.run(rgb.data(), w, h, w * 3, false, expect.data(), 256, 256);
+
+        ImageView view;
+        view.data = c.data->data();
+        view.width = w;
+        view.height = h;
+        view.stride = c.stride;
+        view.pixelFormat = core::pixelFormatName(c.format);  // format 为 Any 时按字符串选择内核
+        LetterboxTransform tf;
+        assert(pre.run(view, spec, fused.data(), tf));
+        assert(tf.padY == te.padY && tf.scaleX == te.scaleX);
+        assert(std::memcmp(expect.data(), fused.data(), expect.size() * sizeof(float)) == 0);
+    }
+
+    ImageView unknown;
+    unknown.data = nv12.data();
+    unknown.width = w;
+    unknown.height = h;
+    unknown.pixelFormat = "GRAY8";
+    LetterboxTransform t;
+    std::vector<float> out(3 * 256 * 256);
+    assert(!pre.run(unknown, spec, out.data(), t));
+}
+
+// NHWC / fp16 / uint8 输出与 float NCHW 结果一致（填充区按类型编码）
+static void test_preprocess_tensor_types_and_layouts() {
+    const int w = 200, h = 120, dw = 96, dh = 96;
+    std::vector<std::uint8_t> nv12 = randomBytes(static_cast<std::size_t>(w) * (h + h / 2), 23);
+    ImageView view;
+    view.data = nv12.data();
+    view.width = w;
+    view.height = h;
+    view.format = core::PixelFormat::NV12;
+    YoloPreprocessor pre;
+    LetterboxTransform t;
+
+    InputTensorSpec base;
+    base.width = dw;
+    base.height = dh;
+    assert(inputTensorBytes(base) == static_cast<std::size_t>(dw) * dh * 3 * 4);
+    std::vector<float> ref(3 * dw * dh);
+    assert(pre.run(view, base, ref.data(), t));
+    assert(t.padY > 0);
+    auto refAt = [&](int c, int y, int x) { return ref[(c * dh + y) * dw + x]; };
+
+    for (TensorLayout layout : {TensorLayout::NCHW, TensorLayout::NHWC}) {
+        auto index = [&](int c, int y, int x) {
+            return layout == TensorLayout::NCHW ? (c * dh + y) * dw + x : (y * dw + x) * 3 + c;
+        };
+        InputTensorSpec f32 = base, f16 = base, u8 = base;
+        f32.layout = f16.layout = u8.layout = layout;
+        f16.type = TensorElementType::Float16;
+        u8.type = TensorElementType::Uint8;
+        assert(inputTensorBytes(f16) == static_cast<std::size_t>(dw) * dh * 3 * 2);
+        assert(inputTensorBytes(u8) == static_cast<std::size_t>(dw) * dh * 3);
+        std::vector<float> outF32(3 * dw * dh);
+        std::vector<std::uint16_t> outF16(3 * dw * dh);
+        std::vector<std::uint8_t> outU8(3 * dw * dh);
+        assert(pre.run(view, f32, outF32.data(), t));
+        assert(pre.run(view, f16, outF16.data(), t));
+        assert(pre.run(view, u8, outU8.data(), t));
+        for (int c = 0; c < 3; ++c) {
+            for (int y = 0; y < dh; ++y) {
+                for (int x = 0; x < dw; ++x) {
+                    const float r = refAt(c, y, x);
+                    const int i = index(c, y, x);
+                    assert(outF32[i] == r);
+                    assert(std::abs(halfToFloat(outF16[i]) - r) <= 1.0f / 2048.0f);
+                    assert(std::abs(outU8[i] - r * 255.0f) <= 0.5f + 1e-3f);
+                }
+            }
+        }
+        assert(outU8[index(0, 0, 0)] == 114);
+        assert(halfToFloat(outF16[index(2, 0, 0)]) == halfToFloat(0x3727));  // 114/255 ≈ 0.4470
+    }
+}
+
+// preprocess_accel：描述 → 配置；无 2D 硬件时 YoloPreprocessor 使用软件路径，结果与未配置时一致
+static void test_preprocess_accel_falls_back_to_software() {
+    DetectorDescriptor desc;
+    assert(yoloPreprocessConfig(desc).accel == sensors::ImageTransformBackendType::Cpu);
+    desc.preprocessAccel = "auto";
+    const YoloPreprocessConfig config = yoloPreprocessConfig(desc);
+    assert(config.accel == sensors::ImageTransformBackendType::Auto);
+
+    const int w = 160, h = 90, dw = 64, dh = 64;
+    std::vector<std::uint8_t> nv12 = randomBytes(static_cast<std::size_t>(w) * (h + h / 2), 31);
+    ImageView view;
+    view.data = nv12.data();
+    view.width = w;
+    view.height = h;
+    view.format = core::PixelFormat::NV12;
+    InputTensorSpec spec;
+    spec.width = dw;
+    spec.height = dh;
+    YoloPreprocessor accel(config);
+    YoloPreprocessor software;
+    if (accel.accelerator() != sensors::ImageTransformBackendType::Cpu) return;  // 有 RGA/VPI 的板端不比较逐位结果
+    std::vector<float> a(3 * dw * dh), b(3 * dw * dh);
+    LetterboxTransform ta, tb;
+    assert(accel.run(view, spec, a.data(), ta) && software.run(view, spec, b.data(), tb));
+    assert(a == b && ta.scaleX == tb.scaleX && ta.padY == tb.padY);
+}
+
+static void test_input_quant_table() {
+    // 典型 RKNN YOLO：mean 0 / std 255，int8 scale 1/255、zp −128 → q = p − 128
+    auto int8 = inputQuantTable(0.f, 255.f, 1.0f / 255.0f, -128, true);
+    for (int p = 0; p < 256; ++p) assert(static_cast<std::int8_t>(int8[p]) == p - 128);
+    // uint8 zp 0 同参数为恒等映射
+    auto u8 = inputQuantTable(0.f, 255.f, 1.0f / 255.0f, 0, false);
+    for (int p = 0; p < 256; ++p) assert(u8[p] == p);
+    // 更粗的量化步长会饱和
+    auto coarse = inputQuantTable(0.f, 1.f, 1.0f, 0, true);
+    assert(static_cast<std::int8_t>(coarse[100]) == 100 && static_cast<std::int8_t>(coarse[200]) == 127);
+
+    std::vector<std::uint8_t> data = {0, 114, 255};
+    applyByteTable(int8, data.data(), data.size());
+    assert(static_cast<std::int8_t>(data[0]) == -128 && static_cast<std::int8_t>(data[1]) == -14 && data[2] == 127);
+}
+
+// 逐框计算全部 sigmoid 的参考实现
+static std::vector<YoloRawDet> referenceDecode(const std::vector<float>& data, std::size_t numBoxes, int numClasses,
+                                               float thr, const std::vector<int>& classes = {}) {
+    std::vector<YoloRawDet> ref;
+    for (std::size_t j = 0; j < numBoxes; ++j) {
+        int bestClass = 0;
+        float bestScore = 0;
+        for (int c = 0; c < numClasses; ++c) {
+            if (!classes.empty() && !std::binary_search(classes.begin(), classes.end(), c)) continue;
+            float s = 1.0f / (1.0f + std::exp(-data[(4 + c) * numBoxes + j]));
+            if (s > bestScore) {
+                bestScore = s;
+                bestClass = c;
+            }
+        }
+        if (bestScore < thr) continue;
+        YoloRawDet d;
+        d.x = data[j] - data[2 * numBoxes + j] / 2;
+        d.score = bestScore;
+        d.classId = bestClass;
+        ref.push_back(d);
+    }
+    return ref;
+}
+
+static void test_decode_vectorized_matches_reference() {
+    // 80 类，框数不是块大小的整数倍（覆盖尾块）；logits 集中在负值，少量框过阈值
+    const int numClasses = 80;
+    const std::size_t numBoxes = 1000 + 7;
+    std::vector<float> data((4 + numClasses) * numBoxes);
+    std::uint32_t seed = 12345;
+    for (auto& v : data) {
+        seed = seed * 1664525u + 1013904223u;
+        v = static_cast<float>(seed >> 8) / 16777216.0f * 12.0f - 9.0f;  // [-9, 3)
+    }
+    for (float thr : {0.05f, 0.25f, 0.6f, 0.9f}) {
+        auto ref = referenceDecode(data, numBoxes, numClasses, thr);
+        std::vector<YoloRawDet> out;
+        decodeYoloOutput84xN(data.data(), 4 + numClasses, numBoxes, numClasses, thr, out);
+        assert(out.size() == ref.size());
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            assert(out[i].classId == ref[i].classId);
+            assert(std::abs(out[i].score - ref[i].score) < 1e-6f);
+            assert(std::abs(out[i].x - ref[i].x) < 1e-5f);
+        }
+    }
+}
+
+static void test_decode_class_mask() {
+    // 只读取掩码中的类别行：未选类别即使分数更高也不输出，类别 ID 仍为模型中的原始下标
+    const int numClasses = 80;
+    const std::size_t numBoxes = 256 + 3;
+    std::vector<float> data((4 + numClasses) * numBoxes);
+    std::uint32_t seed = 777;
+    for (auto& v : data) {
+        seed = seed * 1664525u + 1013904223u;
+        v = static_cast<float>(seed >> 8) / 16777216.0f * 12.0f - 9.0f;
+    }
+    const std::vector<int> classes{0, 2, 3, 5, 7};
+    auto ref = referenceDecode(data, numBoxes, numClasses, 0.25f, classes);
+    assert(!ref.empty());
+    std::vector<YoloRawDet> out;
+    decodeYoloOutput84xN(data.data(), 4 + numClasses, numBoxes, numClasses, 0.25f, out, classes);
+    assert(out.size() == ref.size());
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        assert(std::binary_search(classes.begin(), classes.end(), out[i].classId));
+        assert(out[i].classId == ref[i].classId);
+        assert(std::abs(out[i].score - ref[i].score) < 1e-6f);
+    }
+
+    // 超出 numClasses 的 ID 被忽略；全部无效时不输出
+    out.clear();
+    decodeYoloOutput84xN(data.data(), 4 + numClasses, numBoxes, numClasses, 0.25f, out, {0, 2, 3, 5, 7, 80, 200});
+    assert(out.size() == ref.size());
+    out.clear();
+    decodeYoloOutput84xN(data.data(), 4 + numClasses, numBoxes, numClasses, 0.25f, out, {80, 200});
+    assert(out.empty());
+
+    // 框优先布局同样按掩码解码
+    std::vector<float> bm(data.size());
+    for (std::size_t j = 0; j < numBoxes; ++j)
+        for (int c = 0; c < 4 + numClasses; ++c) bm[j * (4 + numClasses) + c] = data[c * numBoxes + j];
+    YoloDecodeConfig cfg;
+    cfg.numClasses = numClasses;
+    cfg.boxMajor = true;
+    cfg.classes = classes;
+    out.clear();
+    decodeYoloOutput(bm.data(), 4 + numClasses, numBoxes, cfg, out);
+    assert(out.size() == ref.size());
+    for (std::size_t i = 0; i < out.size(); ++i) assert(out[i].classId == ref[i].classId);
+}
+
+static void test_resolve_class_ids() {
+    std::vector<std::string> unknown;
+    auto ids = resolveClassIds({"Person", "vehicle", " 7 ", "dragon"}, cocoClassLabels(), &unknown);
+    assert((ids == std::vector<int>{0, 2, 3, 5, 7}));
+    assert(unknown.size() == 1 && unknown[0] == "dragon");
+    const std::vector<std::string> labels{"boat", "person", "buoy"};
+    assert((resolveClassIds({"buoy", "person"}, labels) == std::vector<int>{1, 2}));
+    assert(resolveClassIds({"vehicle"}, labels).empty());
+    assert((normalizeClassIds({5, -1, 2, 5}) == std::vector<int>{2, 5}));
+}
+
+static void test_decode_objectness_layouts() {
+    // v5 导出 (boxes, 5+C)，已含 sigmoid：score = obj × cls
+    const float rows[3][7] = {
+        {10, 20, 4, 6, 0.9f, 0.2f, 0.8f},  // 0.72 → 保留，类别 1
+        {30, 30, 4, 4, 0.4f, 0.9f, 0.1f},  // objectness 0.4 < 0.5 直接跳过
+        {50, 50, 2, 2, 0.9f, 0.5f, 0.3f},  // 0.45 < 0.5
+    };
+    YoloDecodeConfig cfg;
+    cfg.numClasses = 2;
+    cfg.scoreThreshold = 0.5f;
+    cfg.logits = false;
+    cfg.objectness = true;
+    cfg.boxMajor = true;
+    std::vector<YoloRawDet> out;
+    decodeYoloOutput(&rows[0][0], 7, 3, cfg, out);
+    assert(out.size() == 1 && out[0].classId == 1);
+    assert(std::abs(out[0].score - 0.72f) < 1e-6f && std::abs(out[0].x - 8) < 1e-6f && std::abs(out[0].y - 17) < 1e-6f);
+
+    // 同样的数据转置为通道优先，结果一致（追加到 out）
+    std::vector<float> cm(7 * 3);
+    for (int j = 0; j < 3; ++j)
+        for (int c = 0; c < 7; ++c) cm[c * 3 + j] = rows[j][c];
+    cfg.boxMajor = false;
+    decodeYoloOutput(cm.data(), 7, 3, cfg, out);
+    assert(out.size() == 2 && out[1].classId == 1 && std::abs(out[1].score - 0.72f) < 1e-6f);
+}
+
+static void test_decode_anchor_head() {
+    // 2×2 网格、stride 8、单锚框 (10, 13)；只有格子 (1, 0) 的 objectness 过阈值
+    const int cells = 4, numClasses = 2;
+    std::vector<float> head((5 + numClasses) * cells, 0.f);
+    for (int i = 0; i < cells; ++i) head[4 * cells + i] = -10.f;
+    head[4 * cells + 1] = 5.f;
+    head[6 * cells + 1] = 3.f;  // 类别 1
+    YoloAnchorHead h;
+    h.data = head.data();
+    h.gridW = 2;
+    h.gridH = 2;
+    h.stride = 8;
+    h.numAnchors = 1;
+    h.anchors = {10.f, 13.f};
+    YoloDecodeConfig cfg;
+    cfg.numClasses = numClasses;
+    cfg.scoreThreshold = 0.5f;
+    std::vector<YoloRawDet> out;
+    decodeYoloAnchorHead(h, cfg, out);
+    assert(out.size() == 1 && out[0].classId == 1);
+    // t = 0：xy = (2·0.5 − 0.5 + grid)·8 = (12, 4)，wh = (2·0.5)²·anchor = (10, 13)
+    assert(std::abs(out[0].x - 7.f) < 1e-5f && std::abs(out[0].y + 2.5f) < 1e-5f);
+    assert(std::abs(out[0].w - 10.f) < 1e-5f && std::abs(out[0].h - 13.f) < 1e-5f);
+    const float expected = 1.f / (1.f + std::exp(-5.f)) / (1.f + std::exp(-3.f));
+    assert(std::abs(out[0].score - expected) < 1e-6f);
+}
+
+// 聚簇的随机候选框（拥挤航拍场景：每簇多框高度重叠）
+static std::vector<YoloRawDet> clusteredBoxes(std::size_t n, int numClasses, std::uint32_t seed) {
+    auto next = [&seed] {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / 16777216.0f;
+    };
+    std::vector<YoloRawDet> raw(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const float cx = static_cast<float>((i / 8) % 40) * 16.f;  // 每 8 个候选一簇
+        const float cy = static_cast<float>((i / 8) / 40) * 16.f;
+        raw[i].x = cx + next() * 6.f;
+        raw[i].y = cy + next() * 6.f;
+        raw[i].w = 10.f + next() * 8.f;
+        raw[i].h = 10.f + next() * 8.f;
+        raw[i].score = 0.05f + next() * 0.9f;
+        raw[i].classId = static_cast<int>(next() * numClasses) % numClasses;
+    }
+    return raw;
+}
+
+// 全体候选两两比较的原始实现
+static std::vector<bool> referenceNms(const std::vector<YoloRawDet>& raw, float thr) {
+    std::vector<bool> suppressed(raw.size(), false);
+    std::vector<std::size_t> order(raw.size());
+    for (std::size_t i = 0; i < raw.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&raw](std::size_t a, std::size_t b) { return raw[a].score > raw[b].score; });
+    for (std::size_t ii = 0; ii < order.size(); ++ii) {
+        const auto& a = raw[order[ii]];
+        if (suppressed[order[ii]]) continue;
+        for (std::size_t kk = ii + 1; kk < order.size(); ++kk) {
+            const auto& b = raw[order[kk]];
+            if (suppressed[order[kk]] || a.classId != b.classId) continue;
+            const float w = std::max(0.f, std::min(a.x + a.w, b.x + b.w) - std::max(a.x, b.x));
+            const float h = std::max(0.f, std::min(a.y + a.h, b.y + b.h) - std::max(a.y, b.y));
+            const float inter = w * h;
+            if (inter / (a.w * a.h + b.w * b.h - inter) > thr) suppressed[order[kk]] = true;
+        }
+    }
+    return suppressed;
+}
+
+static void test_nms_bucketed_matches_reference() {
+    for (std::size_t n : {std::size_t{1}, std::size_t{37}, std::size_t{1500}}) {
+        auto raw = clusteredBoxes(n, 3, static_cast<std::uint32_t>(n));
+        std::vector<bool> fast;
+        nmsYoloDetections(raw, 0.45f, fast);
+        assert(fast == referenceNms(raw, 0.45f));
+    }
+
+    // topK 只在最高分的候选中做 NMS；maxDetections 截断保留数（按分数）
+    auto raw = clusteredBoxes(400, 2, 7);
+    NmsConfig cfg;
+    cfg.topK = 50;
+    std::vector<bool> suppressed;
+    nmsYoloDetections(raw, cfg, suppressed);
+    std::vector<float> scores;
+    for (const auto& r : raw) scores.push_back(r.score);
+    std::sort(scores.begin(), scores.end(), std::greater<float>());
+    for (std::size_t i = 0; i < raw.size(); ++i) {
+        if (!suppressed[i]) assert(raw[i].score >= scores[49]);
+    }
+    cfg.topK = 0;
+    cfg.maxDetections = 5;
+    nmsYoloDetections(raw, cfg, suppressed);
+    assert(std::count(suppressed.begin(), suppressed.end(), false) == 5);
+}
+
+static void test_soft_and_matrix_nms_decay() {
+    // 同类两框 IoU = 0.6：Hard 丢弃低分框，Soft/Matrix 衰减其分数
+    auto make = [] {
+        std::vector<YoloRawDet> raw(3);
+        raw[0] = {0, 0, 10, 10, 0.9f, 0};
+        raw[1] = {2.5f, 0, 10, 10, 0.8f, 0};  // 与 raw[0] 交 75、并 125
+        raw[2] = {100, 100, 10, 10, 0.7f, 0};
+        return raw;
+    };
+    const float expected = 0.8f * std::exp(-0.36f / 0.5f);
+    for (NmsMethod method : {NmsMethod::Soft, NmsMethod::Matrix}) {
+        auto raw = make();
+        NmsConfig cfg;
+        cfg.method = method;
+        cfg.scoreThreshold = 0.1f;
+        std::vector<bool> suppressed;
+        nmsYoloDetections(raw, cfg, suppressed);
+        assert(!suppressed[0] && !suppressed[1] && !suppressed[2]);
+        assert(std::abs(raw[0].score - 0.9f) < 1e-6f && std::abs(raw[2].score - 0.7f) < 1e-6f);
+        assert(std::abs(raw[1].score - expected) < 1e-5f);
+        // 衰减后低于分数阈值即抑制
+        raw = make();
+        cfg.scoreThreshold = 0.5f;
+        nmsYoloDetections(raw, cfg, suppressed);
+        assert(!suppressed[0] && suppressed[1] && !suppressed[2]);
+    }
+}
+
 int main() {
     std::cout << "[yolo_pre_post_process_tests] Running..." << std::endl;
     test_decode_empty_and_threshold();
@@ -127,6 +657,20 @@ int main() {
     test_fill_detection_result();
     test_fill_skips_suppressed();
     test_resize_image_to_float_nchw();
+    test_letterbox_transform_and_padding();
+    test_preprocessor_matches_reference_and_threads();
+    test_fill_with_letterbox_transform();
+    test_fused_yuv_matches_convert_then_resize();
+    test_preprocess_tensor_types_and_layouts();
+    test_preprocess_accel_falls_back_to_software();
+    test_input_quant_table();
+    test_decode_vectorized_matches_reference();
+    test_decode_class_mask();
+    test_resolve_class_ids();
+    test_decode_objectness_layouts();
+    test_decode_anchor_head();
+    test_nms_bucketed_matches_reference();
+    test_soft_and_matrix_nms_decay();
     std::cout << "[yolo_pre_post_process_tests] All passed." << std::endl;
     return 0;
 }
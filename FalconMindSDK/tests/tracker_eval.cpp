@@ -0,0 +1,578 @@
+// 跟踪器评估工具：把检测序列逐帧回放给各 ITrackerBackend，计算 CLEAR-MOT（MOTA/MOTP/ID 切换）与 IDF1，
+// 同时统计每帧 run() 时延、每帧堆分配次数与跟踪器堆内存峰值，用于在替换跟踪后端前量化精度 / 开销的取舍。
+//
+// 序列来源：
+//   --synthetic：按 --targets 的每个目标密度生成匀速运动、互相穿越、出入画面的真值轨迹，
+//                检测按漏检率 / 误检率 / 位置噪声从真值派生；--export DIR 把各序列写成捕获文件供回放
+//   --detections / --gt：捕获文件（core/CaptureFile.h，CaptureRecorderNode 录制），每条记录为检测结果包；
+//                真值文件同格式，trackId 为真值身份，按包内 frameIndex 与检测对齐
+// 假设框取 run() 之后被跟踪器赋予 trackId 的检测框；真值与假设 IoU ≥ --iou 视为匹配，
+// 上一帧的对应关系仍满足阈值时沿用，其余按最优分配（JV）匹配。IDF1 为全序列真值身份 ↔ 假设身份的最优一对一匹配。
+//
+// 用法: falconmind_tracker_eval [--trackers simple,sort,bytetrack] [--iou 0.5] [--output FILE|-]
+//         (--synthetic [--targets 10,50,200] [--frames 300] [--miss 0.1] [--fp 0.05] [--noise 2] [--seed 1]
+//          [--export DIR] | --detections FILE --gt FILE)
+// 退出码: 0 正常；1 参数错误、捕获文件无法读取或跟踪器加载失败
+
+#include "falconmind/sdk/core/CaptureFile.h"
+#include "falconmind/sdk/perception/ByteTrackerBackend.h"
+#include "falconmind/sdk/perception/DetectionResultPacket.h"
+#include "falconmind/sdk/perception/LinearAssignment.h"
+#include "falconmind/sdk/perception/SimpleTrackerBackend.h"
+#include "falconmind/sdk/perception/SortTrackerBackend.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace falconmind::sdk;
+using namespace falconmind::sdk::perception;
+using nlohmann::json;
+
+// 堆统计：每块前置 16 字节记录大小，累计分配次数、当前占用与峰值（评估单线程运行，峰值用 relaxed 更新即可）
+namespace {
+std::atomic<std::uint64_t> g_allocations{0};
+std::atomic<std::size_t> g_liveBytes{0};
+std::atomic<std::size_t> g_peakBytes{0};
+constexpr std::size_t kHeader = 16;
+}
+
+void* operator new(std::size_t size) {
+    auto* p = static_cast<unsigned char*>(std::malloc(size + kHeader));
+    if (!p) throw std::bad_alloc();
+    *reinterpret_cast<std::size_t*>(p) = size;
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t live = g_liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    if (live > g_peakBytes.load(std::memory_order_relaxed)) g_peakBytes.store(live, std::memory_order_relaxed);
+    return p + kHeader;
+}
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    auto* p = static_cast<unsigned char*>(ptr) - kHeader;
+    g_liveBytes.fetch_sub(*reinterpret_cast<std::size_t*>(p), std::memory_order_relaxed);
+    std::free(p);
+}
+void operator delete(void* ptr, std::size_t) noexcept { operator delete(ptr); }
+
+namespace {
+
+struct Options {
+    std::vector<std::string> trackers{"simple", "sort", "bytetrack"};
+    float iou{0.5f};
+    std::string output;
+    bool synthetic{false};
+    std::vector<std::size_t> targets{10, 50, 200};
+    std::size_t frames{300};
+    double miss{0.1};
+    double fp{0.05};
+    double noise{2.0};
+    std::uint32_t seed{1};
+    std::string exportDir;
+    std::string detections;
+    std::string gt;
+};
+
+bool parseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--synthetic") {
+            opt.synthetic = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+        if (arg == "--trackers" || arg == "--targets") {
+            std::stringstream ss(value);
+            if (arg == "--trackers") opt.trackers.clear();
+            else opt.targets.clear();
+            for (std::string item; std::getline(ss, item, ',');) {
+                if (item.empty()) continue;
+                if (arg == "--trackers") opt.trackers.push_back(item);
+                else opt.targets.push_back(static_cast<std::size_t>(std::stoul(item)));
+            }
+        } else if (arg == "--iou") {
+            opt.iou = std::stof(value);
+        } else if (arg == "--output") {
+            opt.output = value;
+        } else if (arg == "--frames") {
+            opt.frames = static_cast<std::size_t>(std::stoul(value));
+        } else if (arg == "--miss") {
+            opt.miss = std::stod(value);
+        } else if (arg == "--fp") {
+            opt.fp = std::stod(value);
+        } else if (arg == "--noise") {
+            opt.noise = std::stod(value);
+        } else if (arg == "--seed") {
+            opt.seed = static_cast<std::uint32_t>(std::stoul(value));
+        } else if (arg == "--export") {
+            opt.exportDir = value;
+        } else if (arg == "--detections") {
+            opt.detections = value;
+        } else if (arg == "--gt") {
+            opt.gt = value;
+        } else {
+            return false;
+        }
+    }
+    const bool replay = !opt.detections.empty() && !opt.gt.empty();
+    return !opt.trackers.empty() && opt.iou > 0.f && opt.iou < 1.f && (opt.synthetic != replay) &&
+           (!opt.synthetic || (!opt.targets.empty() && opt.frames > 0));
+}
+
+std::shared_ptr<ITrackerBackend> makeTracker(const std::string& name) {
+    // 与 TrackingTransformNode 的 tracker 参数一致
+    if (name == "simple") return std::make_shared<SimpleTrackerBackend>();
+    if (name == "sort") return std::make_shared<SortTrackerBackend>();
+    if (name == "bytetrack") return std::make_shared<ByteTrackerBackend>();
+    return nullptr;
+}
+
+struct GtBox {
+    int id{-1};
+    DetectionBBox bbox;
+};
+
+struct Sequence {
+    std::string name;
+    std::size_t density{0};  // 单帧最大真值目标数
+    std::vector<DetectionResult> detections;
+    std::vector<std::vector<GtBox>> gt;  // 与 detections 逐帧对应
+};
+
+class Random {
+public:
+    explicit Random(std::uint32_t seed) : state_(seed * 2654435761u + 1u) {}
+    double uniform() {
+        state_ = state_ * 1664525u + 1013904223u;
+        return static_cast<double>(state_ >> 8) / 16777216.0;
+    }
+    double uniform(double lo, double hi) { return lo + (hi - lo) * uniform(); }
+    // Box-Muller
+    double normal(double sigma) {
+        const double u1 = std::max(uniform(), 1e-12);
+        return sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * uniform());
+    }
+
+private:
+    std::uint32_t state_;
+};
+
+Sequence makeSynthetic(const Options& opt, std::size_t targets) {
+    constexpr float kWidth = 1920.f, kHeight = 1080.f;
+    Random rng(opt.seed + static_cast<std::uint32_t>(targets));
+    struct Target {
+        float x, y, vx, vy, w, h;
+        std::size_t born, dies;
+        int classId;
+    };
+    std::vector<Target> all(targets);
+    for (auto& t : all) {
+        t.w = static_cast<float>(rng.uniform(20.0, 60.0));
+        t.h = static_cast<float>(rng.uniform(20.0, 60.0));
+        t.x = static_cast<float>(rng.uniform(0.0, kWidth - t.w));
+        t.y = static_cast<float>(rng.uniform(0.0, kHeight - t.h));
+        t.vx = static_cast<float>(rng.uniform(-4.0, 4.0));
+        t.vy = static_cast<float>(rng.uniform(-4.0, 4.0));
+        // 约三成目标中途进入、三成提前离开
+        t.born = rng.uniform() < 0.3 ? static_cast<std::size_t>(rng.uniform(0.0, 0.5) * opt.frames) : 0;
+        t.dies = rng.uniform() < 0.3 ? static_cast<std::size_t>(rng.uniform(0.5, 1.0) * opt.frames) : opt.frames;
+        t.classId = static_cast<int>(rng.uniform(0.0, 4.0)) % 4;
+    }
+    Sequence seq;
+    seq.name = "synthetic_" + std::to_string(targets);
+    seq.detections.resize(opt.frames);
+    seq.gt.resize(opt.frames);
+    for (std::size_t f = 0; f < opt.frames; ++f) {
+        auto& det = seq.detections[f];
+        det.frameIndex = static_cast<std::uint32_t>(f);
+        det.timestampNs = static_cast<std::uint64_t>(f) * 33333333ull;
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            auto& t = all[i];
+            if (f > 0) {
+                t.x += t.vx;
+                t.y += t.vy;
+                if (t.x < 0.f || t.x + t.w > kWidth) t.vx = -t.vx;
+                if (t.y < 0.f || t.y + t.h > kHeight) t.vy = -t.vy;
+            }
+            if (f < t.born || f >= t.dies) continue;
+            seq.gt[f].push_back({static_cast<int>(i) + 1, {t.x, t.y, t.w, t.h}});
+            if (rng.uniform() < opt.miss) continue;
+            Detection d;
+            d.bbox = {t.x + static_cast<float>(rng.normal(opt.noise)), t.y + static_cast<float>(rng.normal(opt.noise)),
+                      t.w + static_cast<float>(rng.normal(opt.noise)), t.h + static_cast<float>(rng.normal(opt.noise))};
+            // 少量低分检测（遮挡 / 模糊），覆盖 ByteTrack 的二次关联
+            d.score = static_cast<float>(rng.uniform() < 0.15 ? rng.uniform(0.15, 0.45) : rng.uniform(0.5, 0.95));
+            d.classId = t.classId;
+            det.detections.push_back(std::move(d));
+        }
+        const auto fps = static_cast<std::size_t>(opt.fp * static_cast<double>(targets) + rng.uniform());
+        for (std::size_t k = 0; k < fps; ++k) {
+            Detection d;
+            d.bbox = {static_cast<float>(rng.uniform(0.0, kWidth - 40.0)), static_cast<float>(rng.uniform(0.0, kHeight - 40.0)),
+                      static_cast<float>(rng.uniform(15.0, 40.0)), static_cast<float>(rng.uniform(15.0, 40.0))};
+            d.score = static_cast<float>(rng.uniform(0.3, 0.6));
+            d.classId = static_cast<int>(rng.uniform(0.0, 4.0)) % 4;
+            det.detections.push_back(std::move(d));
+        }
+        seq.density = std::max(seq.density, seq.gt[f].size());
+    }
+    return seq;
+}
+
+bool writeCapture(const std::string& path, const std::vector<DetectionResult>& frames) {
+    auto writer = core::CaptureWriter::create(path);
+    if (!writer) return false;
+    std::vector<std::uint8_t> packet;
+    for (const auto& r : frames) {
+        std::size_t size = 0;
+        for (std::size_t cap = 256 + r.detections.size() * 64; size == 0; cap *= 2) {
+            packet.resize(cap);
+            size = serializeDetectionResultV2(r, packet.data(), packet.size());
+        }
+        core::BufferMeta meta;
+        meta.timestampNs = static_cast<std::int64_t>(r.timestampNs);
+        meta.frameIndex = r.frameIndex;
+        if (!writer->append(packet.data(), size, meta)) return false;
+    }
+    return writer->close();
+}
+
+bool exportSequence(const std::string& dir, const Sequence& seq) {
+    std::vector<DetectionResult> gtFrames(seq.gt.size());
+    for (std::size_t f = 0; f < seq.gt.size(); ++f) {
+        gtFrames[f].frameIndex = seq.detections[f].frameIndex;
+        gtFrames[f].timestampNs = seq.detections[f].timestampNs;
+        for (const auto& g : seq.gt[f]) {
+            Detection d;
+            d.bbox = g.bbox;
+            d.score = 1.f;
+            d.trackId = g.id;
+            gtFrames[f].detections.push_back(std::move(d));
+        }
+    }
+    return writeCapture(dir + "/" + seq.name + "_detections.fmcap", seq.detections) &&
+           writeCapture(dir + "/" + seq.name + "_gt.fmcap", gtFrames);
+}
+
+bool readCapture(const std::string& path, std::vector<DetectionResult>& out) {
+    auto reader = core::CaptureReader::open(path);
+    if (!reader) return false;
+    out.clear();
+    out.reserve(reader->size());
+    for (std::size_t i = 0; i < reader->size(); ++i) {
+        const auto& rec = reader->record(i);
+        DetectionResultView view;
+        if (!view.parse(rec.data, rec.size)) return false;
+        out.emplace_back();
+        view.toDetectionResult(out.back());
+    }
+    return true;
+}
+
+bool loadReplay(const Options& opt, Sequence& seq) {
+    std::vector<DetectionResult> gtFrames;
+    if (!readCapture(opt.detections, seq.detections) || !readCapture(opt.gt, gtFrames)) return false;
+    std::unordered_map<std::uint32_t, const DetectionResult*> gtByFrame;
+    for (const auto& g : gtFrames) gtByFrame[g.frameIndex] = &g;
+    seq.name = opt.detections.substr(opt.detections.find_last_of('/') + 1);
+    seq.gt.assign(seq.detections.size(), {});
+    for (std::size_t f = 0; f < seq.detections.size(); ++f) {
+        // 录制的可能是跟踪器输出，清掉已有的 trackId
+        for (auto& d : seq.detections[f].detections) d.trackId = -1;
+        auto it = gtByFrame.find(seq.detections[f].frameIndex);
+        if (it == gtByFrame.end()) continue;
+        for (const auto& d : it->second->detections) seq.gt[f].push_back({d.trackId, d.bbox});
+        seq.density = std::max(seq.density, seq.gt[f].size());
+    }
+    return true;
+}
+
+struct EvalResult {
+    std::string tracker;
+    std::string sequence;
+    std::size_t density{0};
+    std::size_t frames{0};
+    std::uint64_t gt{0}, hyp{0}, matches{0}, fp{0}, fn{0}, idsw{0};
+    double iouSum{0.0};
+    double idf1{0.0}, idp{0.0}, idr{0.0};
+    std::vector<double> latencyUs;
+    double allocsPerFrame{0.0};
+    std::size_t peakHeapBytes{0};
+
+    double mota() const { return gt > 0 ? 1.0 - static_cast<double>(fn + fp + idsw) / static_cast<double>(gt) : 0.0; }
+    double motp() const { return matches > 0 ? iouSum / static_cast<double>(matches) : 0.0; }
+};
+
+float iouOf(const DetectionBBox& a, const DetectionBBox& b) {
+    const float w = std::max(0.f, std::min(a.x + a.width, b.x + b.width) - std::max(a.x, b.x));
+    const float h = std::max(0.f, std::min(a.y + a.height, b.y + b.height) - std::max(a.y, b.y));
+    const float inter = w * h;
+    const float uni = a.width * a.height + b.width * b.height - inter;
+    return uni > 0.f ? inter / uni : 0.f;
+}
+
+double percentile(std::vector<double> v, double q) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, static_cast<std::size_t>(q * static_cast<double>(v.size())))];
+}
+
+bool evaluate(const std::string& trackerName, const Sequence& seq, float iouThr, EvalResult& r) {
+    auto tracker = makeTracker(trackerName);
+    if (!tracker || !tracker->load()) return false;
+    r.tracker = trackerName;
+    r.sequence = seq.name;
+    r.density = seq.density;
+    r.frames = seq.detections.size();
+    r.latencyUs.reserve(r.frames);
+
+    std::unordered_map<int, int> lastMatch;  // 真值 id → 最近一次匹配的假设 id
+    std::map<std::pair<int, int>, std::uint64_t> pairFrames;  // (真值 id, 假设 id) → IoU 过阈值的帧数
+    std::unordered_map<int, std::uint64_t> gtFrames, hypFrames;
+    std::vector<DetectionBBox> gtBoxes, hypBoxes;
+    std::vector<int> hypIds, rowToCol;
+    std::vector<AssignmentCandidate> candidates, open;
+    std::vector<bool> gtTaken, hypTaken;
+    TrackingResult tracks;
+
+    const std::size_t heap0 = g_liveBytes.load(std::memory_order_relaxed);
+    g_peakBytes.store(heap0, std::memory_order_relaxed);
+    std::uint64_t allocsInRun = 0;
+    std::size_t peak = heap0;
+
+    for (std::size_t f = 0; f < seq.detections.size(); ++f) {
+        DetectionResult frame = seq.detections[f];
+        // 只把 run() 本身计入时延 / 分配 / 峰值；帧拷贝与评估自身的分配排除在外
+        g_peakBytes.store(g_liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        const std::uint64_t a0 = g_allocations.load(std::memory_order_relaxed);
+        const auto t0 = std::chrono::steady_clock::now();
+        tracker->run(frame, tracks);
+        const auto t1 = std::chrono::steady_clock::now();
+        allocsInRun += g_allocations.load(std::memory_order_relaxed) - a0;
+        peak = std::max(peak, g_peakBytes.load(std::memory_order_relaxed));
+        r.latencyUs.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+
+        const auto& gt = seq.gt[f];
+        gtBoxes.clear();
+        for (const auto& g : gt) {
+            gtBoxes.push_back(g.bbox);
+            ++gtFrames[g.id];
+        }
+        hypBoxes.clear();
+        hypIds.clear();
+        for (const auto& d : frame.detections) {
+            if (d.trackId < 0) continue;
+            hypBoxes.push_back(d.bbox);
+            hypIds.push_back(d.trackId);
+            ++hypFrames[d.trackId];
+        }
+        r.gt += gt.size();
+        r.hyp += hypBoxes.size();
+
+        candidates.clear();
+        if (!gtBoxes.empty() && !hypBoxes.empty()) gateByIou(gtBoxes, hypBoxes, iouThr, candidates);
+        for (const auto& c : candidates) ++pairFrames[{gt[c.row].id, hypIds[c.col]}];
+
+        // CLEAR-MOT：先沿用上一帧仍满足阈值的对应关系，其余做最优分配
+        gtTaken.assign(gt.size(), false);
+        hypTaken.assign(hypBoxes.size(), false);
+        std::uint64_t matched = 0;
+        for (std::size_t i = 0; i < gt.size(); ++i) {
+            auto it = lastMatch.find(gt[i].id);
+            if (it == lastMatch.end()) continue;
+            for (std::size_t j = 0; j < hypIds.size(); ++j) {
+                if (hypTaken[j] || hypIds[j] != it->second) continue;
+                const float iou = iouOf(gtBoxes[i], hypBoxes[j]);
+                if (iou >= iouThr) {
+                    gtTaken[i] = hypTaken[j] = true;
+                    r.iouSum += iou;
+                    ++matched;
+                }
+                break;
+            }
+        }
+        open.clear();
+        for (const auto& c : candidates) {
+            if (!gtTaken[c.row] && !hypTaken[c.col]) open.push_back(c);
+        }
+        if (!open.empty()) {
+            solveSparseAssignment(static_cast<int>(gt.size()), static_cast<int>(hypBoxes.size()), open, 1.f, rowToCol);
+            for (std::size_t i = 0; i < rowToCol.size(); ++i) {
+                const int j = rowToCol[i];
+                if (j < 0 || gtTaken[i]) continue;
+                auto it = lastMatch.find(gt[i].id);
+                if (it != lastMatch.end() && it->second != hypIds[j]) ++r.idsw;
+                lastMatch[gt[i].id] = hypIds[j];
+                r.iouSum += iouOf(gtBoxes[i], hypBoxes[j]);
+                ++matched;
+            }
+        }
+        r.matches += matched;
+        r.fn += gt.size() - matched;
+        r.fp += hypBoxes.size() - matched;
+    }
+    r.allocsPerFrame = r.frames > 0 ? static_cast<double>(allocsInRun) / static_cast<double>(r.frames) : 0.0;
+    r.peakHeapBytes = peak - std::min(peak, heap0);
+
+    // IDF1：真值身份 ↔ 假设身份一对一、最大化共同出现帧数（IDTP）
+    std::unordered_map<int, int> gtIndex, hypIndex;
+    for (const auto& kv : gtFrames) gtIndex.emplace(kv.first, static_cast<int>(gtIndex.size()));
+    for (const auto& kv : hypFrames) hypIndex.emplace(kv.first, static_cast<int>(hypIndex.size()));
+    std::uint64_t maxCount = 0;
+    for (const auto& kv : pairFrames) maxCount = std::max(maxCount, kv.second);
+    // 代价 C - count、未分配代价 C/2：匹配一对相对两者都不分配的代价变化恰为 -count，最小代价即最大 IDTP
+    const float c = static_cast<float>(maxCount + 1);
+    std::vector<AssignmentCandidate> idPairs;
+    for (const auto& kv : pairFrames) {
+        idPairs.push_back({gtIndex[kv.first.first], hypIndex[kv.first.second], c - static_cast<float>(kv.second)});
+    }
+    std::uint64_t idtp = 0;
+    if (!idPairs.empty()) {
+        solveSparseAssignment(static_cast<int>(gtIndex.size()), static_cast<int>(hypIndex.size()), idPairs, c / 2.f,
+                              rowToCol);
+        for (const auto& p : idPairs) {
+            if (rowToCol[p.row] == p.col) idtp += static_cast<std::uint64_t>(c - p.cost + 0.5f);
+        }
+    }
+    r.idp = r.hyp > 0 ? static_cast<double>(idtp) / static_cast<double>(r.hyp) : 0.0;
+    r.idr = r.gt > 0 ? static_cast<double>(idtp) / static_cast<double>(r.gt) : 0.0;
+    r.idf1 = r.gt + r.hyp > 0 ? 2.0 * static_cast<double>(idtp) / static_cast<double>(r.gt + r.hyp) : 0.0;
+    tracker->unload();
+    return true;
+}
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--trackers simple,sort,bytetrack] [--iou 0.5] [--output FILE|-]"
+                     " (--synthetic [--targets 10,50,200] [--frames 300] [--miss 0.1] [--fp 0.05] [--noise 2]"
+                     " [--seed 1] [--export DIR] | --detections FILE --gt FILE)"
+                  << std::endl;
+        return 1;
+    }
+    for (const auto& name : opt.trackers) {
+        if (!makeTracker(name)) {
+            std::cerr << "Unknown tracker: " << name << " (simple / sort / bytetrack)" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<Sequence> sequences;
+    if (opt.synthetic) {
+        for (std::size_t n : opt.targets) {
+            sequences.push_back(makeSynthetic(opt, n));
+            if (!opt.exportDir.empty() && !exportSequence(opt.exportDir, sequences.back())) {
+                std::cerr << "Cannot write captures to " << opt.exportDir << std::endl;
+                return 1;
+            }
+        }
+    } else {
+        sequences.emplace_back();
+        if (!loadReplay(opt, sequences.back())) {
+            std::cerr << "Cannot read captures " << opt.detections << " / " << opt.gt << std::endl;
+            return 1;
+        }
+    }
+
+    // 跟踪器 load() 日志写 stdout，评估期间屏蔽，避免混入 --output - 的 JSON
+    NullBuffer nullBuffer;
+    std::streambuf* savedCout = std::cout.rdbuf(&nullBuffer);
+    std::vector<EvalResult> results;
+    bool ok = true;
+    for (const auto& seq : sequences) {
+        for (const auto& name : opt.trackers) {
+            EvalResult r;
+            if (!evaluate(name, seq, opt.iou, r)) {
+                ok = false;
+                break;
+            }
+            results.push_back(std::move(r));
+        }
+    }
+    std::cout.rdbuf(savedCout);
+    if (!ok) {
+        std::cerr << "Tracker load failed" << std::endl;
+        return 1;
+    }
+
+    std::FILE* table = opt.output == "-" ? stderr : stdout;
+    std::fprintf(table, "%-10s %-22s %7s %7s %7s %7s %6s %7s %7s %9s %9s %10s %9s\n", "tracker", "sequence", "targets",
+                 "MOTA", "MOTP", "IDF1", "IDSW", "FP", "FN", "p50 us", "p99 us", "allocs/fr", "heap KiB");
+    json items = json::array();
+    for (const auto& r : results) {
+        const double p50 = percentile(r.latencyUs, 0.50);
+        const double p99 = percentile(r.latencyUs, 0.99);
+        const double maxUs = r.latencyUs.empty() ? 0.0 : *std::max_element(r.latencyUs.begin(), r.latencyUs.end());
+        std::fprintf(table, "%-10s %-22s %7zu %7.3f %7.3f %7.3f %6llu %7llu %7llu %9.1f %9.1f %10.1f %9.1f\n",
+                     r.tracker.c_str(), r.sequence.substr(r.sequence.size() > 22 ? r.sequence.size() - 22 : 0).c_str(),
+                     r.density, r.mota(), r.motp(), r.idf1, static_cast<unsigned long long>(r.idsw),
+                     static_cast<unsigned long long>(r.fp), static_cast<unsigned long long>(r.fn), p50, p99,
+                     r.allocsPerFrame, static_cast<double>(r.peakHeapBytes) / 1024.0);
+        items.push_back({{"tracker", r.tracker},
+                         {"sequence", r.sequence},
+                         {"targets", r.density},
+                         {"frames", r.frames},
+                         {"accuracy",
+                          {{"mota", r.mota()},
+                           {"motp", r.motp()},
+                           {"idf1", r.idf1},
+                           {"idp", r.idp},
+                           {"idr", r.idr},
+                           {"id_switches", r.idsw},
+                           {"false_positives", r.fp},
+                           {"misses", r.fn},
+                           {"gt_boxes", r.gt},
+                           {"hyp_boxes", r.hyp}}},
+                         {"latency_us", {{"p50", p50}, {"p99", p99}, {"max", maxUs}}},
+                         {"memory", {{"allocs_per_frame", r.allocsPerFrame}, {"peak_heap_bytes", r.peakHeapBytes}}}});
+    }
+
+    if (!opt.output.empty()) {
+        json report = {{"benchmark", "tracker_eval"},
+                       {"config",
+                        {{"iou", opt.iou},
+                         {"source", opt.synthetic ? "synthetic" : "capture"},
+                         {"frames", opt.synthetic ? opt.frames : sequences.front().detections.size()},
+                         {"miss", opt.miss},
+                         {"fp", opt.fp},
+                         {"noise", opt.noise},
+                         {"seed", opt.seed}}},
+                       {"results", items}};
+        std::string text = report.dump(2);
+        if (opt.output == "-") {
+            std::cout << text << std::endl;
+        } else {
+            std::ofstream out(opt.output);
+            if (!out.is_open()) {
+                std::cerr << "Cannot write " << opt.output << std::endl;
+                return 1;
+            }
+            out << text << std::endl;
+        }
+    }
+    return 0;
+}